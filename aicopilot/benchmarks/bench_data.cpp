@@ -0,0 +1,348 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "bench_data.hpp"
+#include "navdata_database.hpp"
+#include "navdata_pack.hpp"
+#include "runway_database_prod.hpp"
+#include "srtm_loader.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <set>
+
+namespace AICopilot {
+namespace Bench {
+
+namespace {
+
+constexpr uint32_t SEED = 20250101;
+constexpr size_t QUERY_POINTS = 4096;
+constexpr size_t ROUTE_PAIRS = 64;
+constexpr size_t SYNTHETIC_METARS = 10000;
+constexpr size_t MAX_REAL_TILES = 16;
+
+// Synthetic navdata: a GRID_ROWS x GRID_COLS lattice over the continental
+// US, every row and column a high airway
+constexpr int GRID_ROWS = 40;
+constexpr int GRID_COLS = 80;
+constexpr double GRID_SOUTH = 25.0, GRID_NORTH = 49.0;
+constexpr double GRID_WEST = -125.0, GRID_EAST = -67.0;
+
+std::filesystem::path scratchDirectory() {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_bench";
+    std::filesystem::create_directories(dir);
+    return dir;
+}
+
+std::string gridName(int row, int col) {
+    char name[8];
+    std::snprintf(name, sizeof(name), "G%02d%02d", row, col);
+    return name;
+}
+
+std::string writeSyntheticNavdata() {
+    NavdataPackBuilder builder;
+    for (int row = 0; row < GRID_ROWS; ++row) {
+        for (int col = 0; col < GRID_COLS; ++col) {
+            double lat = GRID_SOUTH + (GRID_NORTH - GRID_SOUTH) * row / (GRID_ROWS - 1);
+            double lon = GRID_WEST + (GRID_EAST - GRID_WEST) * col / (GRID_COLS - 1);
+            builder.putWaypoint(NavdataWaypoint(gridName(row, col), lat, lon, NavaidType::FIX));
+        }
+    }
+    for (int row = 0; row < GRID_ROWS; ++row) {
+        Airway airway("J" + std::to_string(row + 1), 18000, 45000, AirwayLevel::HIGH);
+        for (int col = 0; col < GRID_COLS; ++col) airway.waypointSequence.push_back(gridName(row, col));
+        builder.putAirway(airway);
+    }
+    for (int col = 0; col < GRID_COLS; ++col) {
+        Airway airway("Q" + std::to_string(col + 1), 18000, 45000, AirwayLevel::HIGH);
+        for (int row = 0; row < GRID_ROWS; ++row) airway.waypointSequence.push_back(gridName(row, col));
+        builder.putAirway(airway);
+    }
+
+    std::string path = (scratchDirectory() / "synthetic.anp").string();
+    if (!builder.write(path)) {
+        std::cerr << "Could not write " << path << std::endl;
+    }
+    return path;
+}
+
+// Gentle hills with a ridge, in meters
+int16_t syntheticHeight(int lat, int lon, int row, int col) {
+    double y = lat + 1.0 - row / 1200.0;
+    double x = lon + col / 1200.0;
+    double height = 1800.0 + 600.0 * std::sin(x * 3.1) * std::cos(y * 2.3) + 900.0 * std::exp(-std::abs(x + 105.0) * 4.0);
+    return static_cast<int16_t>(height);
+}
+
+void writeSyntheticTile(const std::filesystem::path& dir, int lat, int lon) {
+    const int n = SRTMTile::SRTM3_SIZE;
+    std::vector<uint8_t> bytes(static_cast<size_t>(n) * n * 2);
+    for (int row = 0; row < n; ++row) {
+        for (int col = 0; col < n; ++col) {
+            uint16_t value = static_cast<uint16_t>(syntheticHeight(lat, lon, row, col));
+            size_t i = (static_cast<size_t>(row) * n + col) * 2;
+            bytes[i] = static_cast<uint8_t>(value >> 8);
+            bytes[i + 1] = static_cast<uint8_t>(value & 0xFF);
+        }
+    }
+    std::ofstream out(dir / SRTMTile::GetFileName(lat, lon), std::ios::binary);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+// South-west corners of the tiles a terrain run queries
+std::vector<std::pair<int, int>>& terrainTiles() {
+    static std::vector<std::pair<int, int>> tiles;
+    return tiles;
+}
+
+std::string makeMetar(std::mt19937& rng, const std::string& station) {
+    auto pick = [&](int n) { return std::uniform_int_distribution<int>(0, n - 1)(rng); };
+    static const char* const WEATHER[] = {"", "", "", "-RA ", "RA ", "BR ", "-SN ", "+TSRA ", "FG ", "HZ "};
+    static const char* const COVER[] = {"FEW", "SCT", "BKN", "OVC"};
+
+    char report[160];
+    int temperature = pick(40) - 10;
+    int dewpoint = temperature - pick(12);
+    constexpr size_t kCelsiusSize = 16;   // any int, so the compiler can see it fits
+    auto celsius = [](int value, char* out) {
+        std::snprintf(out, kCelsiusSize, "%s%02d", value < 0 ? "M" : "", std::abs(value));
+    };
+    char temp[kCelsiusSize], dew[kCelsiusSize];
+    celsius(temperature, temp);
+    celsius(dewpoint, dew);
+    std::snprintf(report, sizeof(report), "%s %02d%02d%02dZ %03d%02dKT %dSM %s%s%03d %s%03d %s/%s A%04d",
+                  station.c_str(), 1 + pick(28), pick(24), pick(60), pick(36) * 10, pick(30),
+                  1 + pick(10), WEATHER[pick(10)], COVER[pick(4)], 5 + pick(200), COVER[pick(4)],
+                  50 + pick(200), temp, dew, 2950 + pick(100));
+    return report;
+}
+
+} // namespace
+
+DatasetPaths& datasetPaths() {
+    static DatasetPaths paths;
+    return paths;
+}
+
+std::string datasetName(const std::string& path) {
+    return path.empty() ? "synthetic" : path;
+}
+
+// ============================================================================
+// Navigation
+// ============================================================================
+
+const NavigationDatabase& navigationDatabase() {
+    static const std::unique_ptr<NavigationDatabase> database = [] {
+        auto created = std::make_unique<NavigationDatabase>();
+        std::string path = datasetPaths().navdata.empty() ? writeSyntheticNavdata() : datasetPaths().navdata;
+        if (!created->LoadSnapshot(path)) {
+            std::cerr << "Could not load navdata pack " << path << "; using the built-in data" << std::endl;
+        }
+        return created;
+    }();
+    return *database;
+}
+
+const std::vector<std::string>& waypointNames() {
+    static const std::vector<std::string> names = [] {
+        std::vector<std::string> collected;
+        for (NavaidType type : {NavaidType::VOR, NavaidType::NDB, NavaidType::DME, NavaidType::TACAN,
+                                NavaidType::FIX, NavaidType::AIRPORT, NavaidType::INTERSECTION}) {
+            for (const NavdataWaypoint& waypoint : navigationDatabase().GetWaypointsByType(type)) {
+                collected.push_back(waypoint.name);
+            }
+        }
+        std::shuffle(collected.begin(), collected.end(), std::mt19937(SEED));
+        return collected;
+    }();
+    return names;
+}
+
+const std::vector<std::pair<std::string, std::string>>& routePairs() {
+    static const std::vector<std::pair<std::string, std::string>> pairs = [] {
+        // Endpoints on high airways, so the router has a graph to search
+        std::set<std::string> onAirways;
+        for (const Airway& airway : navigationDatabase().GetAirwaysByAltitude(35000)) {
+            onAirways.insert(airway.waypointSequence.begin(), airway.waypointSequence.end());
+        }
+        std::vector<std::string> candidates(onAirways.begin(), onAirways.end());
+        std::vector<std::pair<std::string, std::string>> chosen;
+        if (candidates.size() < 2) {
+            return chosen;
+        }
+        std::mt19937 rng(SEED);
+        std::uniform_int_distribution<size_t> index(0, candidates.size() - 1);
+        while (chosen.size() < ROUTE_PAIRS) {
+            size_t from = index(rng), to = index(rng);
+            if (from != to) chosen.emplace_back(candidates[from], candidates[to]);
+        }
+        return chosen;
+    }();
+    return pairs;
+}
+
+const std::vector<LatLon>& navdataQueryPoints() {
+    static const std::vector<LatLon> points = [] {
+        double south = 90.0, north = -90.0, west = 180.0, east = -180.0;
+        for (const std::string& name : waypointNames()) {
+            if (auto waypoint = navigationDatabase().GetWaypoint(name)) {
+                south = std::min(south, waypoint->latitude);
+                north = std::max(north, waypoint->latitude);
+                west = std::min(west, waypoint->longitude);
+                east = std::max(east, waypoint->longitude);
+            }
+        }
+        if (south > north) {
+            south = GRID_SOUTH; north = GRID_NORTH; west = GRID_WEST; east = GRID_EAST;
+        }
+        std::mt19937 rng(SEED);
+        std::uniform_real_distribution<double> lat(south, north), lon(west, east);
+        std::vector<LatLon> generated(QUERY_POINTS);
+        for (LatLon& point : generated) {
+            point.latitude = lat(rng);
+            point.longitude = lon(rng);
+        }
+        return generated;
+    }();
+    return points;
+}
+
+// ============================================================================
+// Terrain
+// ============================================================================
+
+SRTMLoader& srtmLoader() {
+    static const std::unique_ptr<SRTMLoader> loader = [] {
+        std::string dir = datasetPaths().srtm;
+        auto& tiles = terrainTiles();
+        if (dir.empty()) {
+            auto synthetic = scratchDirectory() / "srtm";
+            std::filesystem::create_directories(synthetic);
+            for (int lat = 39; lat <= 40; ++lat) {
+                for (int lon = -106; lon <= -105; ++lon) {
+                    if (!std::filesystem::exists(synthetic / SRTMTile::GetFileName(lat, lon))) {
+                        writeSyntheticTile(synthetic, lat, lon);
+                    }
+                    tiles.emplace_back(lat, lon);
+                }
+            }
+            dir = synthetic.string();
+        } else {
+            std::error_code error;
+            for (const auto& entry : std::filesystem::directory_iterator(dir, error)) {
+                int lat = 0, lon = 0;
+                if (tiles.size() < MAX_REAL_TILES &&
+                    SRTMTile::ParseFileName(entry.path().filename().string(), lat, lon)) {
+                    tiles.emplace_back(lat, lon);
+                }
+            }
+            if (tiles.empty()) {
+                std::cerr << "No .hgt tiles in " << dir << std::endl;
+            }
+        }
+        return std::make_unique<SRTMLoader>(dir);
+    }();
+    return *loader;
+}
+
+const std::vector<LatLon>& terrainQueryPoints() {
+    static const std::vector<LatLon> points = [] {
+        srtmLoader();
+        const auto& tiles = terrainTiles();
+        std::vector<LatLon> generated;
+        if (tiles.empty()) {
+            return generated;
+        }
+        std::mt19937 rng(SEED);
+        std::uniform_int_distribution<size_t> tile(0, tiles.size() - 1);
+        std::uniform_real_distribution<double> offset(0.001, 0.999);
+        generated.resize(QUERY_POINTS);
+        for (LatLon& point : generated) {
+            const auto& corner = tiles[tile(rng)];
+            point.latitude = corner.first + offset(rng);
+            point.longitude = corner.second + offset(rng);
+        }
+        return generated;
+    }();
+    return points;
+}
+
+// ============================================================================
+// Runways
+// ============================================================================
+
+const RunwayDatabase& runwayDatabase() {
+    static const std::unique_ptr<RunwayDatabase> database = [] {
+        auto created = std::make_unique<RunwayDatabase>();
+        const std::string& path = datasetPaths().runways;
+        if (path.empty() || !created->LoadPack(path)) {
+            if (!path.empty()) {
+                std::cerr << "Could not load runway pack " << path << "; using the built-in data" << std::endl;
+            }
+            created->Initialize();
+        }
+        return created;
+    }();
+    return *database;
+}
+
+const std::vector<std::string>& runwayAirports() {
+    static const std::vector<std::string> airports = [] {
+        std::vector<std::string> codes = runwayDatabase().GetAirportCodes();
+        std::shuffle(codes.begin(), codes.end(), std::mt19937(SEED));
+        return codes;
+    }();
+    return airports;
+}
+
+// ============================================================================
+// Weather
+// ============================================================================
+
+const std::vector<std::string>& metarReports() {
+    static const std::vector<std::string> reports = [] {
+        std::vector<std::string> loaded;
+        const std::string& path = datasetPaths().metars;
+        if (!path.empty()) {
+            std::ifstream in(path);
+            std::string line;
+            while (std::getline(in, line)) {
+                // NOAA cache CSV: raw_text is the first column
+                size_t comma = line.find(',');
+                if (comma != std::string::npos) line.resize(comma);
+                if (line.empty() || line == "raw_text" || line[0] == '#') continue;
+                loaded.push_back(line);
+            }
+            if (loaded.empty()) {
+                std::cerr << "No reports in " << path << "; using synthetic reports" << std::endl;
+            }
+        }
+        if (loaded.empty()) {
+            static const char* const STATIONS[] = {"KJFK", "KLAX", "KORD", "KDEN", "KSEA", "EGLL",
+                                                   "LFPG", "EDDF", "RJTT", "YSSY", "CYYZ", "KATL"};
+            std::mt19937 rng(SEED);
+            for (size_t i = 0; i < SYNTHETIC_METARS; ++i) {
+                loaded.push_back(makeMetar(rng, STATIONS[i % (sizeof(STATIONS) / sizeof(STATIONS[0]))]));
+            }
+        }
+        return loaded;
+    }();
+    return reports;
+}
+
+} // namespace Bench
+} // namespace AICopilot
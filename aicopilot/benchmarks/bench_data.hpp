@@ -0,0 +1,61 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Benchmark datasets - synthetic or real inputs shared by aicopilot_bench
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef BENCH_DATA_HPP
+#define BENCH_DATA_HPP
+
+#include "tile_cache.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace AICopilot {
+
+class NavigationDatabase;
+class RunwayDatabase;
+class SRTMLoader;
+
+namespace Bench {
+
+/**
+ * Real datasets named on the command line; empty means synthetic
+ */
+struct DatasetPaths {
+    std::string navdata;   // navdata pack (navdata_compiler)
+    std::string srtm;      // directory of .hgt tiles
+    std::string runways;   // runway pack (runway_compiler)
+    std::string metars;    // one METAR per line, or NOAA metars.cache.csv
+};
+
+DatasetPaths& datasetPaths();
+
+// "synthetic" or the path, for the benchmark context
+std::string datasetName(const std::string& path);
+
+// Built on first use and kept for the whole run. Random inputs are drawn
+// from a fixed seed so runs are comparable.
+const NavigationDatabase& navigationDatabase();
+const std::vector<std::string>& waypointNames();
+const std::vector<std::pair<std::string, std::string>>& routePairs();
+const std::vector<LatLon>& navdataQueryPoints();
+
+SRTMLoader& srtmLoader();
+const std::vector<LatLon>& terrainQueryPoints();   // inside the loaded tiles
+
+const RunwayDatabase& runwayDatabase();
+const std::vector<std::string>& runwayAirports();
+
+const std::vector<std::string>& metarReports();
+
+} // namespace Bench
+} // namespace AICopilot
+
+#endif // BENCH_DATA_HPP
@@ -0,0 +1,63 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Microbenchmarks for the databases, the router, the METAR parser and ML
+* scoring. Each subject runs on a seeded synthetic dataset unless a real
+* one is named; the datasets used are recorded in the benchmark context.
+*
+* Usage: aicopilot_bench [--navdata=pack] [--srtm=dir] [--runways=pack]
+*                        [--metars=file] [Google Benchmark flags]
+*   --navdata   Navdata pack from navdata_compiler
+*   --srtm      Directory of .hgt tiles (up to 16 are queried)
+*   --runways   Runway pack from runway_compiler
+*   --metars    One METAR per line, or NOAA metars.cache.csv
+*
+* Machine-readable results come from Google Benchmark itself, e.g.
+*   aicopilot_bench --benchmark_out=results.json --benchmark_out_format=json
+*****************************************************************************/
+
+#include "bench_data.hpp"
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// Take --name=value out of argv
+bool takeFlag(const char* arg, const char* name, std::string& value) {
+    size_t length = std::strlen(name);
+    if (std::strncmp(arg, name, length) != 0 || arg[length] != '=') {
+        return false;
+    }
+    value = arg + length + 1;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Bench::DatasetPaths& paths = Bench::datasetPaths();
+    std::vector<char*> remaining;
+    for (int i = 0; i < argc; ++i) {
+        if (i > 0 && (takeFlag(argv[i], "--navdata", paths.navdata) || takeFlag(argv[i], "--srtm", paths.srtm) ||
+                      takeFlag(argv[i], "--runways", paths.runways) || takeFlag(argv[i], "--metars", paths.metars))) {
+            continue;
+        }
+        remaining.push_back(argv[i]);
+    }
+    int remainingCount = static_cast<int>(remaining.size());
+
+    benchmark::Initialize(&remainingCount, remaining.data());
+    if (benchmark::ReportUnrecognizedArguments(remainingCount, remaining.data())) {
+        return 1;
+    }
+    benchmark::AddCustomContext("navdata", Bench::datasetName(paths.navdata));
+    benchmark::AddCustomContext("srtm", Bench::datasetName(paths.srtm));
+    benchmark::AddCustomContext("runways", paths.runways.empty() ? "built-in" : paths.runways);
+    benchmark::AddCustomContext("metars", Bench::datasetName(paths.metars));
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,39 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "bench_data.hpp"
+#include "allocation_tracker.hpp"
+#include "metar_parser.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace AICopilot;
+
+namespace {
+
+void BM_METARParser_Parse(benchmark::State& state) {
+    const auto& reports = Bench::metarReports();
+    METARObservation observation;
+    size_t i = 0, accepted = 0, bytes = 0;
+    AllocationScope allocations;
+    for (auto _ : state) {
+        const std::string& report = reports[i++ % reports.size()];
+        accepted += METARParser::parse(report, observation) ? 1 : 0;
+        bytes += report.size();
+        benchmark::DoNotOptimize(observation);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.counters["accepted_ratio"] = benchmark::Counter(
+        static_cast<double>(accepted) / static_cast<double>(state.iterations()));
+    state.counters["allocs_per_iter"] = benchmark::Counter(
+        static_cast<double>(allocations.allocations()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_METARParser_Parse);
+
+} // namespace
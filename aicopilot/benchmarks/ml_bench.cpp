@@ -0,0 +1,69 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "ml_decision_engine.hpp"
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+
+using namespace AICopilot;
+using namespace AICopilot::ML;
+
+namespace {
+
+constexpr uint32_t SEED = 20250101;
+
+std::vector<EnvironmentalInput> makeInputs(size_t count) {
+    std::mt19937 rng(SEED);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<EnvironmentalInput> inputs(count);
+    for (EnvironmentalInput& input : inputs) {
+        input.pressure = 980.0 + 60.0 * unit(rng);
+        input.wind_speed = 40.0 * unit(rng);
+        input.wind_direction = 360.0 * unit(rng);
+        input.visibility = 200.0 + 9800.0 * unit(rng);
+        input.temperature = -20.0 + 55.0 * unit(rng);
+        input.runway_length = 3000.0 + 9000.0 * unit(rng);
+        input.ils_available = unit(rng) < 0.6;
+        input.elevation = 5000.0 * unit(rng);
+        input.route_complexity = 10.0 * unit(rng);
+    }
+    return inputs;
+}
+
+void BM_MLDecisionEngine_ScoreDecision(benchmark::State& state) {
+    MLDecisionEngine engine;
+    engine.initialize();
+    std::vector<EnvironmentalInput> inputs = makeInputs(1024);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.scoreDecision(inputs[i++ % inputs.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MLDecisionEngine_ScoreDecision);
+
+// Arg: candidates per batch
+void BM_MLDecisionEngine_ScoreDecisions(benchmark::State& state) {
+    MLDecisionEngine engine;
+    engine.initialize();
+    std::vector<EnvironmentalInput> inputs = makeInputs(256);
+    std::vector<WeatherVariant> candidates(static_cast<size_t>(state.range(0)));
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        candidates[c] = {5.0 + c % 30, 1000.0 + 300.0 * c, 990.0 + c % 40};
+    }
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.scoreDecisions(inputs[i++ % inputs.size()], candidates));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MLDecisionEngine_ScoreDecisions)->Arg(8)->Arg(64);
+
+} // namespace
@@ -0,0 +1,90 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "bench_data.hpp"
+#include "airway_router.hpp"
+#include "allocation_tracker.hpp"
+#include "navdata_database.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace AICopilot;
+
+namespace {
+
+void BM_NavigationDatabase_GetWaypoint(benchmark::State& state) {
+    const NavigationDatabase& database = Bench::navigationDatabase();
+    const auto& names = Bench::waypointNames();
+    if (names.empty()) {
+        state.SkipWithError("no waypoints");
+        return;
+    }
+    size_t i = 0;
+    AllocationScope allocations;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(database.GetWaypoint(names[i++ % names.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["allocs_per_iter"] = benchmark::Counter(
+        static_cast<double>(allocations.allocations()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_NavigationDatabase_GetWaypoint);
+
+// Arg: search radius in nautical miles
+void BM_NavigationDatabase_GetWaypointsNearby(benchmark::State& state) {
+    const NavigationDatabase& database = Bench::navigationDatabase();
+    const auto& points = Bench::navdataQueryPoints();
+    double radius = static_cast<double>(state.range(0));
+    size_t i = 0, found = 0;
+    for (auto _ : state) {
+        const LatLon& point = points[i++ % points.size()];
+        auto nearby = database.GetWaypointsNearby(point.latitude, point.longitude, radius);
+        found += nearby.size();
+        benchmark::DoNotOptimize(nearby.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["results_per_query"] = benchmark::Counter(
+        static_cast<double>(found) / static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_NavigationDatabase_GetWaypointsNearby)->Arg(25)->Arg(100)->Arg(250);
+
+// Arg: number of waypoints requested
+void BM_NavigationDatabase_GetNearestWaypoints(benchmark::State& state) {
+    const NavigationDatabase& database = Bench::navigationDatabase();
+    const auto& points = Bench::navdataQueryPoints();
+    size_t count = static_cast<size_t>(state.range(0));
+    size_t i = 0;
+    for (auto _ : state) {
+        const LatLon& point = points[i++ % points.size()];
+        benchmark::DoNotOptimize(database.GetNearestWaypoints(point.latitude, point.longitude, count));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_NavigationDatabase_GetNearestWaypoints)->Arg(1)->Arg(10);
+
+void BM_AirwayRouter_FindOptimalRoute(benchmark::State& state) {
+    AirwayRouter router(Bench::navigationDatabase());
+    const auto& pairs = Bench::routePairs();
+    if (pairs.empty()) {
+        state.SkipWithError("no airway endpoints at FL350");
+        return;
+    }
+    size_t i = 0, segments = 0;
+    for (auto _ : state) {
+        const auto& pair = pairs[i++ % pairs.size()];
+        auto route = router.FindOptimalRoute(pair.first, pair.second, 35000);
+        segments += route.size();
+        benchmark::DoNotOptimize(route.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["segments_per_route"] = benchmark::Counter(
+        static_cast<double>(segments) / static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_AirwayRouter_FindOptimalRoute)->Unit(benchmark::kMicrosecond);
+
+} // namespace
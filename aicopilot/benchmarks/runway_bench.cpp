@@ -0,0 +1,68 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "bench_data.hpp"
+#include "allocation_tracker.hpp"
+#include "runway_database_prod.hpp"
+#include <benchmark/benchmark.h>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr size_t BATCH_QUERIES = 64;
+
+// Winds step through 36 directions and 8 speeds, so repeated queries are
+// memo hits the way a pilot re-asking every tick would be
+void BM_RunwayDatabase_GetBestRunwayForLanding(benchmark::State& state) {
+    const RunwayDatabase& database = Bench::runwayDatabase();
+    const auto& airports = Bench::runwayAirports();
+    if (airports.empty()) {
+        state.SkipWithError("no airports");
+        return;
+    }
+    size_t i = 0;
+    AllocationScope allocations;
+    for (auto _ : state) {
+        int wind = static_cast<int>(i % 288);
+        benchmark::DoNotOptimize(database.GetBestRunwayForLanding(
+            airports[i % airports.size()], (wind % 36) * 10, (wind / 36) * 4, 20.0));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+    StripedCacheStats cache = database.GetSelectionCacheStats();
+    uint64_t lookups = cache.hits + cache.misses;
+    state.counters["memo_hit_rate"] = lookups ? static_cast<double>(cache.hits) / lookups : 0.0;
+    state.counters["allocs_per_iter"] = benchmark::Counter(
+        static_cast<double>(allocations.allocations()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_RunwayDatabase_GetBestRunwayForLanding);
+
+void BM_RunwayDatabase_ScoreBestRunways(benchmark::State& state) {
+    const RunwayDatabase& database = Bench::runwayDatabase();
+    const auto& airports = Bench::runwayAirports();
+    if (airports.empty()) {
+        state.SkipWithError("no airports");
+        return;
+    }
+    std::vector<RunwayWindQuery> queries(BATCH_QUERIES);
+    for (size_t q = 0; q < queries.size(); ++q) {
+        queries[q].icao = airports[q % airports.size()];
+        queries[q].windDirection = static_cast<int>(q * 37 % 360);
+        queries[q].windSpeed = static_cast<int>(q % 25);
+    }
+    RunwaySelectionCriteria criteria;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(database.ScoreBestRunways(queries, criteria));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+BENCHMARK(BM_RunwayDatabase_ScoreBestRunways)->Unit(benchmark::kMicrosecond);
+
+} // namespace
@@ -0,0 +1,96 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "bench_data.hpp"
+#include "allocation_tracker.hpp"
+#include "elevation_data.h"
+#include "srtm_loader.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr size_t BATCH_POINTS = 256;
+
+void BM_SRTMLoader_GetElevation(benchmark::State& state) {
+    SRTMLoader& loader = Bench::srtmLoader();
+    const auto& points = Bench::terrainQueryPoints();
+    if (points.empty()) {
+        state.SkipWithError("no SRTM tiles");
+        return;
+    }
+    for (const LatLon& point : points) {
+        loader.GetElevation(point.latitude, point.longitude);   // tiles resident before timing
+    }
+    size_t i = 0;
+    AllocationScope allocations;
+    for (auto _ : state) {
+        const LatLon& point = points[i++ % points.size()];
+        benchmark::DoNotOptimize(loader.GetElevation(point.latitude, point.longitude));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["allocs_per_iter"] = benchmark::Counter(
+        static_cast<double>(allocations.allocations()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SRTMLoader_GetElevation);
+
+void BM_SRTMLoader_GetElevations(benchmark::State& state) {
+    SRTMLoader& loader = Bench::srtmLoader();
+    const auto& points = Bench::terrainQueryPoints();
+    if (points.size() < BATCH_POINTS) {
+        state.SkipWithError("no SRTM tiles");
+        return;
+    }
+    double out[BATCH_POINTS];
+    size_t offset = 0;
+    for (auto _ : state) {
+        loader.GetElevations(points.data() + offset, BATCH_POINTS, out);
+        benchmark::DoNotOptimize(out);
+        offset = (offset + BATCH_POINTS) % (points.size() - BATCH_POINTS + 1);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BATCH_POINTS));
+}
+BENCHMARK(BM_SRTMLoader_GetElevations);
+
+// Arg: 1 to repeat the same points (cache hits), 0 for fresh cells
+void BM_ElevationDatabase_GetElevationAt(benchmark::State& state) {
+    ElevationDatabase database;
+    const auto& points = Bench::navdataQueryPoints();
+    bool warm = state.range(0) != 0;
+    size_t span = warm ? 64 : points.size();
+    size_t i = 0;
+    for (auto _ : state) {
+        const LatLon& point = points[i++ % span];
+        // Each pass over the points moves them one cache cell north
+        double shift = warm ? 0.0 : std::fmod(ElevationDatabase::CACHE_PRECISION * (i / span), 20.0);
+        double elevation = database.GetElevationAt(point.latitude + shift, point.longitude);
+        benchmark::DoNotOptimize(elevation);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(warm ? "cached" : "uncached");
+}
+BENCHMARK(BM_ElevationDatabase_GetElevationAt)->Arg(1)->Arg(0);
+
+void BM_ElevationDatabase_GetTerrainProfile(benchmark::State& state) {
+    ElevationDatabase database;
+    const auto& points = Bench::navdataQueryPoints();
+    size_t i = 0;
+    for (auto _ : state) {
+        const LatLon& from = points[i++ % points.size()];
+        const LatLon& to = points[i++ % points.size()];
+        benchmark::DoNotOptimize(database.GetTerrainProfile(from.latitude, from.longitude,
+                                                            to.latitude, to.longitude, 50));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ElevationDatabase_GetTerrainProfile)->Unit(benchmark::kMicrosecond);
+
+} // namespace
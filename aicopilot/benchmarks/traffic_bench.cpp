@@ -0,0 +1,60 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "closest_approach.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// Converging and diverging targets within 20 nm, every seventh hovering
+ClosestApproach::Tracks makeTracks(size_t count) {
+    ClosestApproach::Tracks tracks;
+    tracks.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        double k = static_cast<double>(i);
+        tracks.north[i] = std::sin(k * 0.7) * 20.0;
+        tracks.east[i] = std::cos(k * 1.3) * 20.0;
+        tracks.up[i] = std::sin(k * 0.3) * 4000.0;
+        tracks.vn[i] = (i % 7 == 0) ? 0.0 : std::cos(k * 0.9) * 450.0;
+        tracks.ve[i] = (i % 7 == 0) ? 0.0 : std::sin(k * 1.1) * 450.0;
+        tracks.vz[i] = std::cos(k * 0.5) * 1500.0;
+    }
+    return tracks;
+}
+
+template <void (*Kernel)(const ClosestApproach::Tracks&, double*, double*, double*, double*)>
+void runBatch(benchmark::State& state, const char* label) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    ClosestApproach::Tracks tracks = makeTracks(count);
+    std::vector<double> time(count), distance(count), vertical(count), tau(count);
+    for (auto _ : state) {
+        Kernel(tracks, time.data(), distance.data(), vertical.data(), tau.data());
+        benchmark::DoNotOptimize(tau.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(count));
+    state.SetLabel(label);
+}
+
+// The kernel TrafficSystem runs: AVX2 when built with ENABLE_AVX2 on a CPU that has it
+void BM_ClosestApproach_Batch(benchmark::State& state) {
+    runBatch<ClosestApproach::computeBatch>(state, ClosestApproach::batchKernel());
+}
+BENCHMARK(BM_ClosestApproach_Batch)->Arg(64)->Arg(1024)->Arg(8192);
+
+void BM_ClosestApproach_BatchScalar(benchmark::State& state) {
+    runBatch<ClosestApproach::computeBatchScalar>(state, "scalar");
+}
+BENCHMARK(BM_ClosestApproach_BatchScalar)->Arg(64)->Arg(1024)->Arg(8192);
+
+} // namespace
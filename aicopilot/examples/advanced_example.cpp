@@ -232,10 +232,12 @@ int main(int argc, char* argv[]) {
     
     // Main update loop
     int updateCount = 0;
-    int statusInterval = verbose ? 20 : 40; // More frequent updates in verbose mode
+    const int rate = static_cast<int>(pilot.getUpdateRateHz());
+    int statusInterval = verbose ? rate : 2 * rate; // More frequent updates in verbose mode
+    const auto updatePeriod = std::chrono::milliseconds(1000 / rate);
     
     while (pilot.isActive()) {
-        // Update at 20 Hz
+        // Tick at the pilot's update rate; slower subsystems are scheduled internally
         pilot.update();
         
         // Print status periodically
@@ -245,7 +247,7 @@ int main(int argc, char* argv[]) {
         }
         
         updateCount++;
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        std::this_thread::sleep_for(updatePeriod);
     }
     
     std::cout << "\n[STOP] AI Copilot has stopped autonomous operations" << std::endl;
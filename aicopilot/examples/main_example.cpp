@@ -43,6 +43,15 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    // Record the SimConnect stream for offline replay (if requested)
+    if (argc > 3) {
+        std::cout << "\nRecording SimConnect capture: " << argv[3] << std::endl;
+        if (!pilot.startRecording(argv[3])) {
+            std::cerr << "Failed to start recording" << std::endl;
+            return 1;
+        }
+    }
+    
     // Start autonomous flight
     std::cout << "\nStarting autonomous flight..." << std::endl;
     pilot.startAutonomousFlight();
@@ -51,18 +60,27 @@ int main(int argc, char* argv[]) {
     std::cout << "\nAI Pilot is active. Press Ctrl+C to stop." << std::endl;
     std::cout << "==========================================" << std::endl;
     
+    // SimConnect is pumped by its own dispatch thread, so the loop ticks the
+    // pilot's scheduler at its update rate independent of message arrival
+    // (faster for helicopters, whose hover loop runs at ROTORCRAFT_RATE_HZ)
+    const double updateRate = pilot.getUpdateRateHz();
+    const auto updatePeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / updateRate));
+    const int statusInterval = static_cast<int>(2.0 * updateRate);
+    auto nextUpdate = std::chrono::steady_clock::now();
+    
     int updateCount = 0;
     while (pilot.isActive()) {
-        // Update at 20 Hz
         pilot.update();
         
         // Print status every 2 seconds
-        if (updateCount % 40 == 0) {
+        if (updateCount % statusInterval == 0) {
             std::cout << "\n" << pilot.getStatusReport() << std::endl;
         }
         
         updateCount++;
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        nextUpdate += updatePeriod;
+        std::this_thread::sleep_until(nextUpdate);
     }
     
     std::cout << "\nAI Pilot stopped." << std::endl;
@@ -23,13 +23,19 @@
 #include "weather_system.h"
 #include "terrain_awareness.h"
 #include "navigation.h"
+#include "approach_system.h"
 #include <vector>
 #include <memory>
 #include <chrono>
 #include <functional>
+#include <string>
 
 namespace AICopilot {
 
+class INavdataProvider;
+class WeatherStationStore;
+class WorkStealingPool;
+
 /**
  * Advanced Flight Procedures System
  * 
@@ -111,6 +117,7 @@ struct EngineFailureProcedure {
     std::vector<std::string> subsequentActions;  // Follow-up steps
     std::vector<Waypoint> preferredAirports;    // For divert
     double estimatedGlideRange;          // nautical miles
+    std::vector<double> clearClimbHeadings;  // engine-out climb headings that clear terrain (degrees)
 };
 
 // Fuel emergency procedures
@@ -135,6 +142,43 @@ struct WeatherDivertParameters {
     std::string weatherReasoning;   // Explanation
 };
 
+// What a diversion must satisfy
+struct DiversionRequest {
+    Position position;
+    double fuelRemaining = 0.0;        // gallons
+    double fuelReserveMinutes = 45.0;  // to be left on landing
+    double maxDistance = 100.0;        // nautical miles, e.g. glide range after an engine failure
+    double minRunwayLength = 0.0;      // feet; 0 uses the category's
+    double maxCrosswind = 0.0;         // knots; 0 uses getProcedureLimits()
+    double maxTailwind = 10.0;         // knots
+    std::vector<std::string> airports; // candidates by ICAO; empty searches within maxDistance
+    size_t maxOptions = 5;
+};
+
+// One airport, runway and approach that satisfies a DiversionRequest
+struct DiversionOption {
+    std::string icao;
+    std::string runway;
+    ApproachType approach = ApproachType::UNKNOWN;
+    Position position{};
+    double distance = 0.0;          // nautical miles
+    double fuelRequired = 0.0;      // gallons including reserve
+    double headwind = 0.0;          // knots, negative for tailwind
+    double crosswind = 0.0;         // knots, absolute
+    bool weatherReported = false;   // a current METAR was found
+    double cost = 0.0;              // lower is better; distance plus penalties, in nautical miles
+};
+
+// Ranked diversion options, best first
+struct DiversionPlan {
+    std::vector<DiversionOption> options;
+    size_t airportsConsidered = 0;  // in range (or requested) when planning started
+    size_t airportsEvaluated = 0;   // fully scored before the deadline
+    size_t candidatesScored = 0;    // airport x runway x approach combinations
+    bool complete = false;          // every airport was evaluated in time
+    double elapsedMs = 0.0;
+};
+
 // Procedure step (for structured procedure execution)
 struct ProcedureStep {
     uint32_t stepNumber;
@@ -346,6 +390,49 @@ public:
         double currentFuel,
         const WeatherConditions& currentWeather);
     
+    // ============================================================
+    // DIVERSION PLANNING
+    // ============================================================
+    
+    /**
+     * Data and threads for diversion planning
+     * @param navdata Airports and runway layouts; must be safe for
+     *                concurrent const calls
+     * @param weather Current METARs; may be null (weather is then unknown)
+     * @param pool Scores airports in parallel; null scores on the caller
+     *
+     * All three must outlive planning calls.
+     */
+    void setDiversionSources(std::shared_ptr<const INavdataProvider> navdata,
+                             std::shared_ptr<const WeatherStationStore> weather,
+                             WorkStealingPool* pool = nullptr);
+    
+    /**
+     * Score every airport x runway x approach that satisfies the request
+     *
+     * Each airport is one job: one layout and one weather lookup serve
+     * all of its runways and approaches. Returns by the deadline with the
+     * best options found so far; jobs still running are abandoned.
+     */
+    DiversionPlan planDiversion(const DiversionRequest& request,
+                                std::chrono::steady_clock::duration deadline);
+    
+    static constexpr std::chrono::milliseconds DEFAULT_DIVERSION_DEADLINE{250};
+    
+    /**
+     * Terrain for engine-out escape paths; may be null (none are checked).
+     * Must outlive procedure calls.
+     */
+    void setTerrain(std::shared_ptr<const TerrainAwareness> terrain) { terrain_ = std::move(terrain); }
+    
+    // Engine-out climb paths: ENGINE_OUT_PATH_NM long, fanned out every
+    // ENGINE_OUT_TURN_STEP_DEG up to ENGINE_OUT_MAX_TURN_DEG either side of
+    // the heading, and required to clear terrain by ENGINE_OUT_CLEARANCE_FT
+    static constexpr double ENGINE_OUT_PATH_NM = 10.0;
+    static constexpr double ENGINE_OUT_TURN_STEP_DEG = 15.0;
+    static constexpr double ENGINE_OUT_MAX_TURN_DEG = 90.0;
+    static constexpr double ENGINE_OUT_CLEARANCE_FT = 35.0;
+    
     /**
      * Calculate fuel required for alternate airport
      */
@@ -419,7 +506,17 @@ private:
     std::vector<Waypoint> findNearestAirports(
         const Position& pos,
         size_t count,
-        double maxDistance = 100.0);
+        double maxDistance = 100.0,
+        double fuelRemaining = 0.0);
+    double defaultMinRunwayLength() const;
+    std::vector<double> findClearClimbHeadings(const AircraftState& state, double altitude,
+                                               double climbRateFpm) const;
+    
+    // Diversion sources
+    std::shared_ptr<const INavdataProvider> navdata_;
+    std::shared_ptr<const WeatherStationStore> weatherStations_;
+    WorkStealingPool* pool_ = nullptr;
+    std::shared_ptr<const TerrainAwareness> terrain_;
     
     // Procedure-specific helpers
     struct CrosswindComponents {
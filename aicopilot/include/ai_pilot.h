@@ -12,29 +12,128 @@
 
 #include "aicopilot_types.h"
 #include "simconnect_wrapper.h"
+#include "headless_sim.hpp"
 #include "aircraft_systems.h"
 #include "atc_controller.h"
 #include "navigation.h"
 #include "aircraft_config.h"
+#include "aircraft_profile.h"
 #include "navdata_provider.h"
 #include "weather_system.h"
+#include "weather_subscriptions.hpp"
 #include "airport_integration.hpp"
+#include "helicopter_operations.h"
+#include "hdr_histogram.hpp"
+#include "task_scheduler.hpp"
+#include "subsystem_initializer.hpp"
+#include "pilot_checkpoint.hpp"
+#include "tick_watchdog.hpp"
+#include "flight_phase_table.hpp"
+#include "flight_data_recorder.hpp"
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace AICopilot {
 
+/**
+ * Threads an AIPilot may start for itself
+ * Hosts running many pilots (PilotHost) disable both and pump every
+ * instance from a shared pool instead.
+ */
+struct AIPilotThreading {
+    bool dispatchThread = true;    // SimConnect dispatch thread; otherwise polled in update()
+    size_t schedulerWorkers = 2;   // 0 runs slow scheduler tasks inline in update()
+};
+
+/**
+ * Rotorcraft fast-path timing and hover quality
+ */
+struct RotorcraftLoopStats {
+    uint64_t iterations = 0;        // runs with a hover, hover taxi or autorotation mode active
+    double periodMeanMs = 0.0;      // time between runs
+    double periodP99Ms = 0.0;
+    double periodMaxMs = 0.0;
+    double computeMeanMs = 0.0;     // time spent in a run
+    double computeP99Ms = 0.0;
+    double computeMaxMs = 0.0;
+    HoverQualityStats hover;
+};
+
 /**
  * Autonomous AI Pilot
  * Main controller that coordinates all systems for autonomous flight
  */
 class AIPilot {
 public:
+    // Subsystem rates driven by the task scheduler
+    static constexpr double CONTROL_RATE_HZ = 30.0;   // state, control laws, phase logic
+    static constexpr double TAWS_RATE_HZ = 10.0;      // terrain clearance
+    static constexpr double SLOW_RATE_HZ = 1.0;       // weather, ATC, terrain lookups
+    static constexpr double ROTORCRAFT_RATE_HZ = 100.0;  // hover and autorotation control, helicopters only
+    
+    // update() budget; sustained overruns shed load (see TickWatchdog)
+    static constexpr double TICK_BUDGET_MS = 25.0;    // of the 33 ms control period
+    static constexpr double DEGRADED_TAWS_RATE_HZ = 5.0;
+    static constexpr double DEGRADED_WEATHER_RATE_HZ = 0.2;
+    
+    // Stations this close to the flight plan are watched for weather changes
+    static constexpr double ROUTE_WEATHER_CORRIDOR_NM = 25.0;
+    
     AIPilot();
     ~AIPilot();
     
-    // Initialize the AI pilot
-    bool initialize(SimulatorType simType);
+    // Configure before initialize()/startAutonomousFlight()
+    void setThreading(const AIPilotThreading& threading) { threading_ = threading; }
+    
+    // Use an already initialized, shared navdata provider instead of loading a private copy
+    void setSharedNavdata(std::shared_ptr<const INavdataProvider> navdata) { navdataProvider_ = std::move(navdata); }
+    
+    // Send ATC menu selections through an Ollama gateway shared with other pilots
+    void setSharedOllamaGateway(std::shared_ptr<OllamaGateway> gateway, uint32_t pilotId) {
+        ollamaGateway_ = std::move(gateway);
+        ollamaGatewayPilotId_ = pilotId;
+    }
+    
+    // Create and initialize the default navdata provider
+    static std::shared_ptr<const INavdataProvider> createNavdataProvider();
+    
+    // Non-critical startup step a host owns (ML model load, TTS pre-synthesis).
+    // It runs alongside initialize() after the named steps ("navdata",
+    // "weather" or earlier host steps) and never delays readiness. Register
+    // before initialize(); false for an unknown dependency or duplicate name.
+    bool addStartupTask(const std::string& name, SubsystemInitializer::InitFunction task,
+                        const std::vector<std::string>& after = {});
+    
+    // Initialize the AI pilot; returns once the pilot is ready for preflight.
+    // configIndex picks the SimConnect.cfg entry, for a second instance or
+    // a sim on another host.
+    bool initialize(SimulatorType simType, int configIndex = 0);
+    
+    // Initialize against a recorded SimConnect capture instead of a simulator
+    bool initializeReplay(const std::string& capturePath,
+                          ReplayPacing pacing = ReplayPacing::WALL_CLOCK);
+    
+    // Initialize against the headless flight model; like a fast replay,
+    // each update() advances sim time by one control period however long
+    // it takes, so a loop of update() calls runs in fast time
+    bool initializeHeadless(const HeadlessSimConfig& config);
+    
+    // Record the live SimConnect stream for later replay
+    bool startRecording(const std::string& capturePath);
+    void stopRecording();
+    
+    // Record each control cycle's state, autopilot and phase as columnar
+    // flight data; timestamps are microseconds since the start, in capture
+    // time for a fast replay or headless run. Stopping
+    // waits for the recorder to write the last chunk.
+    bool startFlightDataRecording(const std::string& path,
+                                  std::shared_ptr<FlightDataRecorder> recorder = FlightDataRecorder::shared());
+    void stopFlightDataRecording();
+    bool isFlightDataRecording() const { return flightData_ != nullptr; }
     
     // Load aircraft configuration
     bool loadAircraftConfig(const std::string& configPath);
@@ -42,24 +141,83 @@ public:
     // Load flight plan
     bool loadFlightPlan(const std::string& planPath);
     
+    // Watch reported weather along the flight plan; a material change
+    // there triggers a weather re-evaluation on the next weather tick
+    void setWeatherSubscriptions(std::shared_ptr<WeatherSubscriptions> subscriptions);
+    
     // Start autonomous flight
     void startAutonomousFlight();
     
     // Stop autonomous flight
     void stopAutonomousFlight();
     
+    // Flight so far: phase and progress flags, the route and active
+    // waypoint, ATC clearances, and the airports to warm. A host adds its
+    // own warm-set entries and ML state before writing the checkpoint.
+    void captureCheckpoint(PilotCheckpointBuilder& builder) const;
+    
+    // Start autonomous flight at a checkpoint instead of preflight; needs
+    // what startAutonomousFlight() needs (a connection, aircraft config)
+    bool resumeFromCheckpoint(const PilotCheckpoint& checkpoint);
+    
     // Check if pilot is active
     bool isActive() const { return active_; }
     
-    // Main update loop (call regularly, e.g., 10-20 Hz)
+    // Check if the simulator (or replay) session is still connected
+    bool isConnected() const { return simConnect_ && simConnect_->isConnected(); }
+    
+    // Capture seconds replayed so far (0 when connected to a simulator)
+    double getReplayTime() const { return simConnect_ ? simConnect_->getReplayTime() : 0.0; }
+    
+    // Main update loop; runs whichever subsystems are due, so call it at
+    // least at getUpdateRateHz(). A fast replay advances one period of
+    // that rate in capture time per call.
     void update();
     
+    // CONTROL_RATE_HZ, or ROTORCRAFT_RATE_HZ for a helicopter
+    double getUpdateRateHz() const { return helicopter_ ? ROTORCRAFT_RATE_HZ : CONTROL_RATE_HZ; }
+    
+    // Helicopter modes (hover, hover taxi, autorotation); nullptr unless the
+    // loaded aircraft is a helicopter
+    HelicopterOperations* getHelicopterOperations() { return helicopter_.get(); }
+    
+    // Rotorcraft loop statistics; read from the thread calling update()
+    RotorcraftLoopStats getRotorcraftLoopStats() const;
+    
+    // Per-subsystem run counts, durations and deadline misses
+    std::vector<ScheduledTaskStats> getSchedulerStats() const;
+    
+    // Extra load-shedding step for a subsystem the host owns (ML inference,
+    // voice), applied after TAWS resolution and before weather checks are
+    // slowed. Register before startAutonomousFlight().
+    void addDegradationStep(const std::string& name, TickWatchdog::DegradationStep step);
+    
+    // Report load-shedding changes to a system monitor
+    void setSystemMonitor(SystemMonitor* monitor) { systemMonitor_ = monitor; }
+    
+    TickWatchdogStats getWatchdogStats() const;
+    
+    // Per-step timing of the last initialize(); host steps may still be running
+    std::vector<SubsystemInitStats> getInitStats() const;
+    double getTimeToReadyMs() const;
+    
+    // Block until host startup steps still running after initialize() finish
+    void waitForStartupTasks();
+    
     // Get current status
     std::string getStatusReport() const;
     
     // Get current flight phase
     FlightPhase getCurrentPhase() const { return currentPhase_; }
     
+    // Fire counts and source-phase dwell times per PHASE_TRANSITIONS row
+    const std::array<PhaseTransitionStats, PHASE_TRANSITION_COUNT>& getPhaseTransitionStats() const {
+        return phaseMachine_.getTransitionStats();
+    }
+    void setPhaseTransitionObserver(FlightPhaseMachine::TransitionObserver observer) {
+        phaseMachine_.setTransitionObserver(std::move(observer));
+    }
+    
     // Emergency handling
     void handleEmergency(const std::string& emergencyType);
     
@@ -73,6 +231,18 @@ public:
     bool isOllamaEnabled() const;
     
 private:
+    // Shared setup once a simulator or replay session is connected; false
+    // if a critical step failed
+    bool initializeServices();
+    
+    // Register subsystems with the scheduler for an autonomous flight
+    void configureScheduler();
+    void runControlCycle();
+    void recordFlightData();
+    int64_t flightDataClockUs() const;
+    void runRotorcraftCycle();
+    void runTerrainLookup();
+    
     // Core components
     std::shared_ptr<SimConnectWrapper> simConnect_;
     std::unique_ptr<AircraftSystems> systems_;
@@ -81,14 +251,40 @@ private:
     std::unique_ptr<Integration::AirportOperationSystem> airportOps_;
     std::shared_ptr<Integration::SimConnectBridge> simBridge_;
     std::unique_ptr<Navigation> navigation_;
-    std::shared_ptr<INavdataProvider> navdataProvider_;
+    std::shared_ptr<const INavdataProvider> navdataProvider_;
+    std::shared_ptr<OllamaGateway> ollamaGateway_;
+    uint32_t ollamaGatewayPilotId_ = 0;
     std::unique_ptr<WeatherSystem> weatherSystem_;
     AircraftConfig aircraftConfig_;
+    PhaseSchedule phaseSchedule_;   // control law targets for aircraftConfig_
+    
+    // Rotorcraft fast path: reads the state snapshot and writes the batched
+    // controls itself, so hover never waits on the control cycle
+    std::unique_ptr<HelicopterOperations> helicopter_;
+    HdrHistogram rotorcraftPeriod_;
+    HdrHistogram rotorcraftCompute_;
+    TaskScheduler::Clock::time_point lastRotorcraftRun_{};
+    uint64_t rotorcraftIterations_ = 0;
+    
+    // Route weather changes, queued by the subscription callback; shared so
+    // a delivery already under way never outlives the pilot
+    struct RouteWeatherInbox {
+        std::mutex mutex;
+        std::vector<WeatherChange> changes;
+    };
+    std::shared_ptr<WeatherSubscriptions> weatherSubscriptions_;
+    WeatherSubscriptions::SubscriptionId routeWeatherSubscription_;
+    std::shared_ptr<RouteWeatherInbox> routeWeather_;
+    
+    // Conditions last acted on
+    WeatherConditions lastWeather_;
+    bool weatherAssessed_;
     
     // State
     bool active_;
     bool manualOverride_;
     FlightPhase currentPhase_;
+    FlightPhaseMachine phaseMachine_;
     AircraftState currentState_;
     
     // Fuel warning flags
@@ -96,11 +292,57 @@ private:
     bool fuelWarning10Shown_;
     bool airportOpsInitialized_;
     AirportInfo cachedAirportInfo_;
+    
+    // Per-flight progress (instance state, so hosted pilots never share it)
+    bool preflightComplete_;
+    bool shutdownComplete_;
+    std::chrono::steady_clock::time_point lastControlUpdate_;
+    AIPilotThreading threading_;
+    
+    // Fast replay ticks the scheduler on capture time, one control period
+    // per update(), instead of the wall clock
+    bool fastReplay_ = false;
+    TaskScheduler::Clock::time_point replayNow_{};
+    
+    // Columnar flight data, recorded once per control cycle
+    std::shared_ptr<FlightDataRecorder> flightDataRecorder_;
+    std::shared_ptr<FlightDataStream> flightData_;
+    int64_t flightDataStartUs_ = 0;     // capture time in a fast replay
+    
+    // Terrain elevation from the latest background lookup (ft MSL)
+    std::atomic<double> terrainElevation_;
+    std::atomic<bool> terrainElevationValid_;
+    uint64_t terrainStateVersion_ = 0;  // core version of the lookup (terrain task only)
+    
+    // Tick budget watchdog, rebuilt with the scheduler's tasks
+    struct HostDegradationStep {
+        std::string name;
+        TickWatchdog::DegradationStep step;
+    };
+    std::vector<HostDegradationStep> hostDegradationSteps_;
+    SystemMonitor* systemMonitor_ = nullptr;
+    std::unique_ptr<TickWatchdog> watchdog_;
+    
+    // Startup graph; host steps registered ahead of initialize(). Declared
+    // after the systems its steps build so those outlive a step still running
+    struct StartupTask {
+        std::string name;
+        SubsystemInitializer::InitFunction task;
+        std::vector<std::string> after;
+    };
+    std::vector<StartupTask> startupTasks_;
+    std::unique_ptr<SubsystemInitializer> initializer_;
+    
+    // Declared last so worker tasks stop before the systems they use are destroyed
+    std::unique_ptr<TaskScheduler> scheduler_;
 
     // Phase management
     void updateFlightPhase();
     void executePhase();
     
+    using PhaseAction = void (AIPilot::*)();
+    static const PhaseAction PHASE_ACTIONS[FLIGHT_PHASE_COUNT];  // indexed by FlightPhase
+    
     // Phase-specific logic
     void executePreflight();
     void executeTaxiOut();
@@ -114,10 +356,7 @@ private:
     void executeShutdown();
     
     // Decision making
-    bool shouldStartTakeoff();
-    bool shouldStartClimb();
     bool shouldStartDescent();
-    bool shouldStartApproach();
     
     // Flight control logic
     void controlHeading();
@@ -127,7 +366,7 @@ private:
     // Safety checks
     bool performSafetyChecks();
     void handleLowFuel();
-    void handleBadWeather();
+    void handleBadWeather(const WeatherConditions& weather);
     void handleEngineFailure();
     void handleFire();
     void handleLossOfControl();
@@ -136,9 +375,13 @@ private:
     bool checkTerrainClearance();
     double getTerrainElevation(const Position& pos);
     
-    // Weather assessment
+    // Weather assessment; the scheduled check acts only when conditions,
+    // or reported weather along the route, change materially
+    void runWeatherCheck();
+    void subscribeRouteWeather();
     WeatherConditions assessWeather();
-    bool isWeatherSuitable();
+    static bool weatherChanged(const WeatherConditions& before, const WeatherConditions& after);
+    static bool isWeatherSuitable(const WeatherConditions& weather);
     
     // Logging
     void log(const std::string& message);
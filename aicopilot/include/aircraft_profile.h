@@ -19,6 +19,8 @@
 #define AIRCRAFT_PROFILE_H
 
 #include "aicopilot_types.h"
+#include "flight_phase_table.hpp"
+#include <array>
 #include <string>
 #include <map>
 
@@ -117,6 +119,133 @@ struct HelicopterData {
     bool hasSAS;               // Stability Augmentation System
 };
 
+/**
+ * Control targets for one flight phase
+ */
+struct PhaseTargets {
+    double speed = 0.0;      // knots IAS; rotation speed for TAKEOFF
+    double throttle = 0.0;   // 0.0 to 1.0; takeoff power, flare entry power for LANDING
+    int flaps = 0;           // 0 to 100%
+};
+
+/**
+ * Per-phase control targets, resolved once from an aircraft's category and
+ * performance so the control loop only indexes by phase
+ */
+struct PhaseSchedule {
+    AircraftCategory category = AircraftCategory::UNKNOWN;
+    std::array<PhaseTargets, FLIGHT_PHASE_COUNT> phases{};
+    double rotationPitch = 0.0;            // -1.0 to 1.0
+    double approachConfigAltitude = 0.0;   // feet; gear and approach flaps below
+    double flareHeight = 0.0;              // feet
+
+    const PhaseTargets& operator[](FlightPhase phase) const { return phases[static_cast<size_t>(phase)]; }
+    PhaseTargets& operator[](FlightPhase phase) { return phases[static_cast<size_t>(phase)]; }
+};
+
+/**
+ * Control law constants per aircraft category, specialized below
+ * The primary template is the piston law (single and multi engine).
+ */
+template <AircraftCategory Category>
+struct ControlLaw {
+    static constexpr double ROTATION_FACTOR = 1.3;    // x clean stall speed
+    static constexpr double CLIMB_FACTOR = 0.75;      // x cruise speed
+    static constexpr double DESCENT_FACTOR = 1.0;     // x cruise speed
+    static constexpr double APPROACH_FACTOR = 1.5;    // x clean stall speed
+    static constexpr double LANDING_FACTOR = 1.3;     // x clean stall speed
+    static constexpr double FLARE_THROTTLE = 0.3;
+    static constexpr int TAKEOFF_FLAPS = 0;
+    static constexpr int APPROACH_FLAPS = 50;
+    static constexpr int LANDING_FLAPS = 100;
+    static constexpr double ROTATION_PITCH = 0.15;
+    static constexpr double APPROACH_CONFIG_ALTITUDE = 3000.0;
+    static constexpr double FLARE_HEIGHT = 50.0;
+};
+
+template <>
+struct ControlLaw<AircraftCategory::TURBOPROP> {
+    static constexpr double ROTATION_FACTOR = 1.25;
+    static constexpr double CLIMB_FACTOR = 0.7;
+    static constexpr double DESCENT_FACTOR = 0.95;
+    static constexpr double APPROACH_FACTOR = 1.45;
+    static constexpr double LANDING_FACTOR = 1.3;
+    static constexpr double FLARE_THROTTLE = 0.25;
+    static constexpr int TAKEOFF_FLAPS = 10;
+    static constexpr int APPROACH_FLAPS = 50;
+    static constexpr int LANDING_FLAPS = 100;
+    static constexpr double ROTATION_PITCH = 0.15;
+    static constexpr double APPROACH_CONFIG_ALTITUDE = 3000.0;
+    static constexpr double FLARE_HEIGHT = 40.0;
+};
+
+template <>
+struct ControlLaw<AircraftCategory::JET_TRANSPORT> {
+    static constexpr double ROTATION_FACTOR = 1.2;
+    static constexpr double CLIMB_FACTOR = 0.6;
+    static constexpr double DESCENT_FACTOR = 0.65;
+    static constexpr double APPROACH_FACTOR = 1.4;
+    static constexpr double LANDING_FACTOR = 1.3;
+    static constexpr double FLARE_THROTTLE = 0.0;   // thrust idle in the flare
+    static constexpr int TAKEOFF_FLAPS = 20;
+    static constexpr int APPROACH_FLAPS = 60;
+    static constexpr int LANDING_FLAPS = 100;
+    static constexpr double ROTATION_PITCH = 0.2;
+    static constexpr double APPROACH_CONFIG_ALTITUDE = 5000.0;
+    static constexpr double FLARE_HEIGHT = 30.0;
+};
+
+template <>
+struct ControlLaw<AircraftCategory::BUSINESS_JET> : ControlLaw<AircraftCategory::JET_TRANSPORT> {};
+
+template <>
+struct ControlLaw<AircraftCategory::HELICOPTER> {
+    static constexpr double ROTATION_FACTOR = 0.0;   // lifts off at any airspeed
+    static constexpr double CLIMB_FACTOR = 0.6;
+    static constexpr double DESCENT_FACTOR = 0.8;
+    static constexpr double APPROACH_FACTOR = 0.0;   // vs1 is not meaningful; see makePhaseSchedule
+    static constexpr double LANDING_FACTOR = 0.0;
+    static constexpr double FLARE_THROTTLE = 0.5;    // collective held for the hover
+    static constexpr int TAKEOFF_FLAPS = 0;
+    static constexpr int APPROACH_FLAPS = 0;
+    static constexpr int LANDING_FLAPS = 0;
+    static constexpr double ROTATION_PITCH = 0.05;
+    static constexpr double APPROACH_CONFIG_ALTITUDE = 1000.0;
+    static constexpr double FLARE_HEIGHT = 20.0;
+};
+
+/**
+ * Phase schedule for one category's control law
+ * Approach and landing speeds with a zero factor fall back to a fraction
+ * of cruise (helicopters).
+ */
+template <AircraftCategory Category>
+PhaseSchedule makePhaseSchedule(double stallSpeed, double cruiseSpeed) {
+    using Law = ControlLaw<Category>;
+    PhaseSchedule schedule;
+    schedule.category = Category;
+    schedule.rotationPitch = Law::ROTATION_PITCH;
+    schedule.approachConfigAltitude = Law::APPROACH_CONFIG_ALTITUDE;
+    schedule.flareHeight = Law::FLARE_HEIGHT;
+
+    double approachSpeed = Law::APPROACH_FACTOR > 0.0 ? stallSpeed * Law::APPROACH_FACTOR : cruiseSpeed * 0.4;
+    double landingSpeed = Law::LANDING_FACTOR > 0.0 ? stallSpeed * Law::LANDING_FACTOR : cruiseSpeed * 0.2;
+
+    schedule[FlightPhase::TAKEOFF] = {stallSpeed * Law::ROTATION_FACTOR, 1.0, Law::TAKEOFF_FLAPS};
+    schedule[FlightPhase::CLIMB] = {cruiseSpeed * Law::CLIMB_FACTOR, 0.0, 0};
+    schedule[FlightPhase::CRUISE] = {cruiseSpeed, 0.0, 0};
+    schedule[FlightPhase::DESCENT] = {cruiseSpeed * Law::DESCENT_FACTOR, 0.0, 0};
+    schedule[FlightPhase::APPROACH] = {approachSpeed, 0.0, Law::APPROACH_FLAPS};
+    schedule[FlightPhase::LANDING] = {landingSpeed, Law::FLARE_THROTTLE, Law::LANDING_FLAPS};
+    return schedule;
+}
+
+// Selects the control law once; UNKNOWN and GLIDER use the piston law
+PhaseSchedule makePhaseSchedule(AircraftCategory category, double stallSpeed, double cruiseSpeed);
+
+// Category for an aircraft.cfg type
+AircraftCategory categoryForType(AircraftType type);
+
 /**
  * Complete Aircraft Profile from Configuration Files
  */
@@ -154,6 +283,9 @@ struct AircraftProfile {
     
     // Get recommended flaps for phase
     double getFlapsForPhase(FlightPhase phase) const;
+    
+    // Category control law with the procedure speeds and power applied
+    PhaseSchedule buildPhaseSchedule() const;
 };
 
 /**
@@ -184,6 +316,11 @@ public:
     // Get profile by ICAO designator
     AircraftProfile getProfile(const std::string& icaoDesignator) const;
     
+    // Loaded profile and its phase schedule, or nullptr; valid until the
+    // designator is loaded again
+    const AircraftProfile* findProfile(const std::string& icaoDesignator) const;
+    const PhaseSchedule* findPhaseSchedule(const std::string& icaoDesignator) const;
+    
     // Parse performance data from aircraft.cfg
     PerformanceProfile parsePerformanceData(const std::string& configPath) const;
     
@@ -199,6 +336,7 @@ public:
 private:
     AircraftProfile currentProfile_;
     std::map<std::string, AircraftProfile> profiles_;
+    std::map<std::string, PhaseSchedule> schedules_;
     
     // Helper methods
     void setDefaultPerformance(AircraftType type, PerformanceProfile& perf) const;
@@ -0,0 +1,221 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef AIRCRAFT_STATE_CORE_HPP
+#define AIRCRAFT_STATE_CORE_HPP
+
+#include "aicopilot_types.h"
+#include "state_snapshot.hpp"
+#include <cstdint>
+#include <cstring>
+
+namespace AICopilot {
+
+/**
+ * Hot part of AircraftState: position, attitude and velocities
+ *
+ * What the per-tick consumers (terrain look-ahead, traffic geometry, the
+ * systems monitor) read. Every field keeps the sim's double, so the wide
+ * state rebuilt from the halves is exact; with the seqlock word in front
+ * a published core is 104 bytes, two cache lines where the wide struct
+ * with its sequence word spans three.
+ */
+struct AircraftStateCore {
+    static constexpr uint32_t ON_GROUND = 1u << 0;
+    static constexpr uint32_t GEAR_DOWN = 1u << 1;
+    static constexpr uint32_t PARKING_BRAKE_SET = 1u << 2;
+
+    double latitude = 0.0;
+    double longitude = 0.0;
+    double altitude = 0.0;          // feet
+    double positionHeading = 0.0;   // Position::heading, degrees
+    double heading = 0.0;           // degrees
+    double pitch = 0.0;             // degrees
+    double bank = 0.0;              // degrees
+    double indicatedAirspeed = 0.0; // knots
+    double trueAirspeed = 0.0;      // knots
+    double groundSpeed = 0.0;       // knots
+    double verticalSpeed = 0.0;     // feet per minute
+    uint32_t flags = 0;
+    uint32_t reserved = 0;          // keeps the struct free of padding for change detection
+
+    bool onGround() const { return (flags & ON_GROUND) != 0; }
+    bool gearDown() const { return (flags & GEAR_DOWN) != 0; }
+    bool parkingBrakeSet() const { return (flags & PARKING_BRAKE_SET) != 0; }
+
+    static AircraftStateCore fromAircraftState(const AircraftState& state) {
+        AircraftStateCore core;
+        core.latitude = state.position.latitude;
+        core.longitude = state.position.longitude;
+        core.altitude = state.position.altitude;
+        core.positionHeading = state.position.heading;
+        core.heading = state.heading;
+        core.pitch = state.pitch;
+        core.bank = state.bank;
+        core.indicatedAirspeed = state.indicatedAirspeed;
+        core.trueAirspeed = state.trueAirspeed;
+        core.groundSpeed = state.groundSpeed;
+        core.verticalSpeed = state.verticalSpeed;
+        core.flags = (state.onGround ? ON_GROUND : 0u) |
+                     (state.gearDown ? GEAR_DOWN : 0u) |
+                     (state.parkingBrakeSet ? PARKING_BRAKE_SET : 0u);
+        return core;
+    }
+
+    // Overwrite the hot fields of state; its cold fields are left as they are
+    void applyTo(AircraftState& state) const {
+        state.position.latitude = latitude;
+        state.position.longitude = longitude;
+        state.position.altitude = altitude;
+        state.position.heading = positionHeading;
+        state.heading = heading;
+        state.pitch = pitch;
+        state.bank = bank;
+        state.indicatedAirspeed = indicatedAirspeed;
+        state.trueAirspeed = trueAirspeed;
+        state.groundSpeed = groundSpeed;
+        state.verticalSpeed = verticalSpeed;
+        state.onGround = onGround();
+        state.gearDown = gearDown();
+        state.parkingBrakeSet = parkingBrakeSet();
+    }
+
+    Position position() const {
+        Position p{};
+        p.latitude = latitude;
+        p.longitude = longitude;
+        p.altitude = altitude;
+        p.heading = positionHeading;
+        return p;
+    }
+};
+
+static_assert(sizeof(AircraftStateCore) + sizeof(uint64_t) <= 128,
+              "AircraftStateCore and its seqlock word must fit two cache lines");
+
+/**
+ * Cold part of AircraftState: altimeter setting, fuel, engine, flaps and
+ * electrical. Changes at the rate of switches and gauges; read on demand.
+ */
+struct AircraftStateCold {
+    double altimeter = 0.0;         // inHg
+    double fuelQuantity = 0.0;      // gallons
+    double engineRPM = 0.0;
+    double batteryVoltage = 0.0;
+    double batteryLoad = 0.0;
+    double generatorVoltage = 0.0;
+    double generatorLoad = 0.0;
+    int32_t flapsPosition = 0;      // 0-100%
+    uint8_t masterBattery = 0;
+    uint8_t masterAlternator = 0;
+    uint16_t reserved = 0;          // keeps the struct free of padding for change detection
+
+    static AircraftStateCold fromAircraftState(const AircraftState& state) {
+        AircraftStateCold cold;
+        cold.altimeter = state.altimeter;
+        cold.fuelQuantity = state.fuelQuantity;
+        cold.engineRPM = state.engineRPM;
+        cold.batteryVoltage = state.batteryVoltage;
+        cold.batteryLoad = state.batteryLoad;
+        cold.generatorVoltage = state.generatorVoltage;
+        cold.generatorLoad = state.generatorLoad;
+        cold.flapsPosition = state.flapsPosition;
+        cold.masterBattery = state.masterBattery ? 1 : 0;
+        cold.masterAlternator = state.masterAlternator ? 1 : 0;
+        return cold;
+    }
+
+    void applyTo(AircraftState& state) const {
+        state.altimeter = altimeter;
+        state.fuelQuantity = fuelQuantity;
+        state.engineRPM = engineRPM;
+        state.batteryVoltage = batteryVoltage;
+        state.batteryLoad = batteryLoad;
+        state.generatorVoltage = generatorVoltage;
+        state.generatorLoad = generatorLoad;
+        state.flapsPosition = flapsPosition;
+        state.masterBattery = masterBattery != 0;
+        state.masterAlternator = masterAlternator != 0;
+    }
+};
+
+/**
+ * Versioned hot/cold AircraftState publication
+ *
+ * The writer publishes whole AircraftStates; the store splits each into
+ * a core and a cold snapshot and republishes a half only when it changed,
+ * so a steady aircraft costs readers no cache-line transfers at all. Each
+ * half carries its own version, starting at 1 with the first publish:
+ * a consumer remembers the version it last read and skips the snapshot
+ * while it is unchanged, and reads cold fields only when it needs them.
+ * No wide copy is kept: load() rebuilds the state from the two halves,
+ * each consistent in itself and exact as published.
+ *
+ * Version 0 means nothing was published; sources that do not track
+ * versions report 0 always, so consumers read them every time.
+ */
+class AircraftStateStore {
+public:
+    AircraftStateStore() = default;
+    AircraftStateStore(const AircraftStateStore&) = delete;
+    AircraftStateStore& operator=(const AircraftStateStore&) = delete;
+
+    // Publish a new state (single writer only); returns true if either half changed
+    bool publish(const AircraftState& state) {
+        bool changed = false;
+        AircraftStateCore core = AircraftStateCore::fromAircraftState(state);
+        if (!published_ || std::memcmp(&core, &lastCore_, sizeof(core)) != 0) {
+            core_.store(core);
+            lastCore_ = core;
+            changed = true;
+        }
+        AircraftStateCold cold = AircraftStateCold::fromAircraftState(state);
+        if (!published_ || std::memcmp(&cold, &lastCold_, sizeof(cold)) != 0) {
+            cold_.store(cold);
+            lastCold_ = cold;
+            changed = true;
+        }
+        published_ = true;
+        return changed;
+    }
+
+    // version is the version of the half the value belongs to
+    AircraftStateCore loadCore() const { return core_.load(); }
+    AircraftStateCore loadCore(uint64_t& version) const { return core_.load(version); }
+
+    AircraftStateCold loadCold() const { return cold_.load(); }
+    AircraftStateCold loadCold(uint64_t& version) const { return cold_.load(version); }
+
+    // The wide struct, merged from the latest core and cold halves
+    AircraftState load() const {
+        AircraftState state{};
+        core_.load().applyTo(state);
+        cold_.load().applyTo(state);
+        return state;
+    }
+
+    uint64_t coreVersion() const { return core_.version(); }
+    uint64_t coldVersion() const { return cold_.version(); }
+
+private:
+    alignas(64) StateSnapshot<AircraftStateCore> core_;
+    alignas(64) StateSnapshot<AircraftStateCold> cold_;
+
+    // Writer-side copies of the last published halves
+    AircraftStateCore lastCore_;
+    AircraftStateCold lastCold_;
+    bool published_ = false;
+};
+
+static_assert(sizeof(StateSnapshot<AircraftStateCore>) <= 128,
+              "a published core must fit two cache lines");
+
+} // namespace AICopilot
+
+#endif // AIRCRAFT_STATE_CORE_HPP
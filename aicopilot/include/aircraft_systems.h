@@ -13,10 +13,54 @@
 #include "aicopilot_types.h"
 #include "simconnect_wrapper.h"
 #include "aircraft_config.h"
+#include <cstdint>
 #include <memory>
 
 namespace AICopilot {
 
+// Systems whose inputs changed, one bit each
+enum SystemsDirty : uint32_t {
+    SYSTEMS_NONE = 0,
+    SYSTEMS_FUEL = 1u << 0,
+    SYSTEMS_ENGINE = 1u << 1,
+    SYSTEMS_ELECTRICAL = 1u << 2,
+    SYSTEMS_CONFIGURATION = 1u << 3,   // gear, flaps, parking brake
+    SYSTEMS_ALL = (1u << 4) - 1
+};
+
+// Smallest change that counts for each analog input
+struct SystemsDeadbands {
+    double fuelQuantity = 0.1;   // gallons
+    double engineRPM = 10.0;
+    double voltage = 0.05;       // volts
+    double load = 0.5;           // amperes
+};
+
+/**
+ * Diffs aircraft state snapshots into per-system dirty bits
+ *
+ * Each field is compared with the value last reported, not the previous
+ * snapshot, so a slow drift is reported once it adds up to the deadband.
+ * Switches report any change. The first update after construction or
+ * reset() reports every system.
+ */
+class SystemsStateTracker {
+public:
+    explicit SystemsStateTracker(const SystemsDeadbands& deadbands = SystemsDeadbands())
+        : deadbands_(deadbands) {}
+    
+    // Dirty bits for `state`; the fields that moved become the new reference
+    uint32_t update(const AircraftState& state);
+    void reset() { primed_ = false; }
+    
+    const AircraftState& getReportedState() const { return reported_; }
+    
+private:
+    SystemsDeadbands deadbands_;
+    AircraftState reported_{};
+    bool primed_ = false;
+};
+
 /**
  * Controller for all aircraft systems
  * Manages autopilot, flight controls, engines, and other systems
@@ -27,9 +71,16 @@ public:
                    const AircraftConfig& config);
     ~AircraftSystems();
     
-    // Update system state (call regularly)
+    // Update system state (call regularly); checks run only for systems whose inputs changed
     void update();
     
+    // Systems changed by the last update(), SystemsDirty bits
+    uint32_t getDirtyMask() const { return dirtyMask_; }
+    bool isDirty(uint32_t systems) const { return (dirtyMask_ & systems) != 0; }
+    
+    // Whether the last update() changed the warning list
+    bool warningsChanged() const { return warningsChanged_; }
+    
     // Autopilot control
     void enableAutopilot(bool enable);
     void setHeading(double heading);
@@ -74,18 +125,31 @@ public:
     AircraftState getCurrentState() const;
     AutopilotState getAutopilotState() const;
     
-    // Check system health
+    // Re-check every system now, regardless of the dirty mask
     bool checkSystems();
-    std::vector<std::string> getSystemWarnings();
+    const std::vector<std::string>& getSystemWarnings() const { return warnings_; }
+    bool hasWarnings() const { return !warnings_.empty(); }
     
 private:
     std::shared_ptr<SimConnectWrapper> simConnect_;
     AircraftConfig config_;
     AircraftState currentState_;
+    uint64_t coreVersion_ = 0;      // state versions at the last read of currentState_
+    uint64_t coldVersion_ = 0;
     AutopilotState autopilotState_;
     std::vector<std::string> warnings_;
     
+    // Warnings per system, so a check replaces only its own
+    std::vector<std::string> fuelWarnings_;
+    std::vector<std::string> engineWarnings_;
+    std::vector<std::string> electricalWarnings_;
+    
+    SystemsStateTracker tracker_;
+    uint32_t dirtyMask_ = SYSTEMS_NONE;
+    bool warningsChanged_ = false;
+    
     void updateState();
+    bool runChecks(uint32_t systems);
     void checkFuel();
     void checkEngines();
     void checkElectrical();
@@ -0,0 +1,415 @@
+#pragma once
+
+#include "collision_avoidance.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// PART 3.1b: Airport Geometry Index
+// ============================================================================
+
+namespace AICopilot {
+namespace Collision {
+
+struct AABB {
+    Vector2D min;
+    Vector2D max;
+
+    AABB() : min(1e300, 1e300), max(-1e300, -1e300) {}
+
+    void expand(const Vector2D& p) {
+        min.x = std::min(min.x, p.x);
+        min.y = std::min(min.y, p.y);
+        max.x = std::max(max.x, p.x);
+        max.y = std::max(max.y, p.y);
+    }
+
+    void expand(const AABB& box) {
+        expand(box.min);
+        expand(box.max);
+    }
+
+    bool overlaps(const AABB& other) const {
+        return min.x <= other.max.x && other.min.x <= max.x &&
+               min.y <= other.max.y && other.min.y <= max.y;
+    }
+
+    bool contains(const Vector2D& p) const {
+        return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y;
+    }
+
+    Vector2D center() const {
+        return (min + max) * 0.5;
+    }
+};
+
+// Static airport polygons (aprons, taxiways, buildings) prepared for ground
+// collision queries. Each polygon is split into convex pieces (ear clipping,
+// then merging neighbours while they stay convex); each piece caches its
+// bounds and outward unit edge normals, and a bounding volume hierarchy over
+// the pieces limits a query to the few whose bounds it touches.
+//
+// Footprints passed to the polygon queries must be convex, as aircraft
+// outlines are. Queries allocate nothing unless they return a hit list.
+class AirportCollisionIndex {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    struct QueryStats {
+        size_t nodes_visited = 0;
+        size_t pieces_tested = 0;
+    };
+
+    // Replace the indexed polygons; polygon IDs are indices into this vector
+    void build(const std::vector<Polygon>& polygons) {
+        pieces.clear();
+        nodes.clear();
+        polygon_count = polygons.size();
+
+        for (size_t id = 0; id < polygons.size(); ++id) {
+            add_convex_pieces(id, polygons[id].vertices);
+        }
+        if (!pieces.empty()) {
+            build_node(0, pieces.size());
+        }
+    }
+
+    size_t get_polygon_count() const { return polygon_count; }
+    size_t get_piece_count() const { return pieces.size(); }
+
+    // True if the convex footprint overlaps any indexed polygon
+    bool intersects_polygon(const Polygon& footprint, QueryStats* stats = nullptr) const {
+        if (footprint.vertices.size() < 3) return false;
+        bool hit = false;
+        traverse(bounds_of(footprint.vertices), stats, [&](const Piece& piece) {
+            hit = overlaps(piece, footprint.vertices);
+            return hit;
+        });
+        return hit;
+    }
+
+    // IDs of every polygon the convex footprint overlaps, ascending
+    void query_polygon(const Polygon& footprint, std::vector<size_t>& hits, QueryStats* stats = nullptr) const {
+        hits.clear();
+        if (footprint.vertices.size() < 3) return;
+        traverse(bounds_of(footprint.vertices), stats, [&](const Piece& piece) {
+            if (overlaps(piece, footprint.vertices)) hits.push_back(piece.polygon_id);
+            return false;
+        });
+        std::sort(hits.begin(), hits.end());
+        hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+    }
+
+    // ID of a polygon containing the point, or npos
+    size_t find_containing(const Vector2D& point, QueryStats* stats = nullptr) const {
+        AABB box;
+        box.expand(point);
+        size_t found = npos;
+        traverse(box, stats, [&](const Piece& piece) {
+            if (contains(piece, point)) found = piece.polygon_id;
+            return found != npos;
+        });
+        return found;
+    }
+
+    bool intersects_circle(const Circle& circle, QueryStats* stats = nullptr) const {
+        AABB box;
+        box.expand(circle.center - Vector2D(circle.radius, circle.radius));
+        box.expand(circle.center + Vector2D(circle.radius, circle.radius));
+        bool hit = false;
+        traverse(box, stats, [&](const Piece& piece) {
+            hit = distance_to(piece, circle.center) <= circle.radius;
+            return hit;
+        });
+        return hit;
+    }
+
+private:
+    // Convex, counter-clockwise
+    struct Piece {
+        std::vector<Vector2D> vertices;
+        std::vector<Vector2D> normals;  // outward unit normal of edge i -> i + 1
+        AABB bounds;
+        size_t polygon_id;
+    };
+
+    // Leaves hold [first, first + count) of pieces; an interior node's left
+    // child follows it and right_child indexes the other
+    struct Node {
+        AABB bounds;
+        uint32_t first;
+        uint32_t count;
+        uint32_t right_child;
+    };
+
+    static constexpr size_t LEAF_SIZE = 4;
+    static constexpr size_t MAX_DEPTH = 64;
+    static constexpr double CONVEX_EPSILON = 1e-9;
+
+    std::vector<Piece> pieces;
+    std::vector<Node> nodes;
+    size_t polygon_count = 0;
+
+    static AABB bounds_of(const std::vector<Vector2D>& vertices) {
+        AABB box;
+        for (const auto& v : vertices) box.expand(v);
+        return box;
+    }
+
+    static double turn(const Vector2D& a, const Vector2D& b, const Vector2D& c) {
+        return (b - a).cross(c - b);
+    }
+
+    // Visit pieces whose bounds overlap box until visit() returns true
+    template <typename Visit>
+    void traverse(const AABB& box, QueryStats* stats, Visit visit) const {
+        if (nodes.empty()) return;
+        uint32_t stack[MAX_DEPTH];
+        size_t top = 0;
+        stack[top++] = 0;
+
+        while (top > 0) {
+            const Node& node = nodes[stack[--top]];
+            if (stats) stats->nodes_visited++;
+            if (!node.bounds.overlaps(box)) continue;
+
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    if (!pieces[i].bounds.overlaps(box)) continue;
+                    if (stats) stats->pieces_tested++;
+                    if (visit(pieces[i])) return;
+                }
+            } else {
+                uint32_t self = static_cast<uint32_t>(&node - nodes.data());
+                stack[top++] = node.right_child;
+                stack[top++] = self + 1;
+            }
+        }
+    }
+
+    // Separating axis test against the piece's cached normals and the
+    // footprint's edge perpendiculars (unnormalized: only gaps matter)
+    static bool overlaps(const Piece& piece, const std::vector<Vector2D>& footprint) {
+        for (const auto& axis : piece.normals) {
+            if (separated(piece.vertices, footprint, axis)) return false;
+        }
+        for (size_t i = 0; i < footprint.size(); ++i) {
+            Vector2D edge = footprint[(i + 1) % footprint.size()] - footprint[i];
+            if (separated(piece.vertices, footprint, Vector2D(-edge.y, edge.x))) return false;
+        }
+        return true;
+    }
+
+    static bool separated(const std::vector<Vector2D>& a, const std::vector<Vector2D>& b, const Vector2D& axis) {
+        double min_a = a[0].dot(axis), max_a = min_a;
+        for (const auto& v : a) {
+            double p = v.dot(axis);
+            min_a = std::min(min_a, p);
+            max_a = std::max(max_a, p);
+        }
+        double min_b = b[0].dot(axis), max_b = min_b;
+        for (const auto& v : b) {
+            double p = v.dot(axis);
+            min_b = std::min(min_b, p);
+            max_b = std::max(max_b, p);
+        }
+        return max_a < min_b || max_b < min_a;
+    }
+
+    static bool contains(const Piece& piece, const Vector2D& point) {
+        for (size_t i = 0; i < piece.vertices.size(); ++i) {
+            if ((point - piece.vertices[i]).dot(piece.normals[i]) > 0.0) return false;
+        }
+        return true;
+    }
+
+    static double distance_to(const Piece& piece, const Vector2D& point) {
+        if (contains(piece, point)) return 0.0;
+        double best = 1e300;
+        for (size_t i = 0; i < piece.vertices.size(); ++i) {
+            const Vector2D& a = piece.vertices[i];
+            Vector2D ab = piece.vertices[(i + 1) % piece.vertices.size()] - a;
+            double len_sq = ab.dot(ab);
+            double h = len_sq > 0.0 ? std::max(0.0, std::min(1.0, (point - a).dot(ab) / len_sq)) : 0.0;
+            best = std::min(best, (point - a - ab * h).magnitude());
+        }
+        return best;
+    }
+
+    void add_convex_pieces(size_t polygon_id, const std::vector<Vector2D>& input) {
+        if (input.size() < 3) return;
+
+        // Counter-clockwise working copy
+        std::vector<Vector2D> ring = input;
+        double area = 0.0;
+        for (size_t i = 0; i < ring.size(); ++i) {
+            area += ring[i].cross(ring[(i + 1) % ring.size()]);
+        }
+        if (std::abs(area) < CONVEX_EPSILON) return;
+        if (area < 0.0) std::reverse(ring.begin(), ring.end());
+
+        // Collinear vertices would give ear clipping zero-area ears
+        for (size_t i = 0; i < ring.size() && ring.size() > 3;) {
+            const Vector2D& prev = ring[(i + ring.size() - 1) % ring.size()];
+            const Vector2D& next = ring[(i + 1) % ring.size()];
+            if (std::abs(turn(prev, ring[i], next)) <= CONVEX_EPSILON) {
+                ring.erase(ring.begin() + i);
+            } else {
+                ++i;
+            }
+        }
+
+        std::vector<std::vector<size_t>> parts = decompose(ring);
+        for (const auto& part : parts) {
+            Piece piece;
+            piece.polygon_id = polygon_id;
+            for (size_t index : part) {
+                piece.vertices.push_back(ring[index]);
+                piece.bounds.expand(ring[index]);
+            }
+            for (size_t i = 0; i < piece.vertices.size(); ++i) {
+                Vector2D edge = piece.vertices[(i + 1) % piece.vertices.size()] - piece.vertices[i];
+                piece.normals.push_back(Vector2D(edge.y, -edge.x).normalize());
+            }
+            pieces.push_back(std::move(piece));
+        }
+    }
+
+    // Convex parts of a counter-clockwise ring, as vertex indices
+    static std::vector<std::vector<size_t>> decompose(const std::vector<Vector2D>& ring) {
+        const size_t n = ring.size();
+        bool convex = true;
+        for (size_t i = 0; i < n && convex; ++i) {
+            convex = turn(ring[i], ring[(i + 1) % n], ring[(i + 2) % n]) >= -CONVEX_EPSILON;
+        }
+        if (convex) {
+            std::vector<size_t> all(n);
+            for (size_t i = 0; i < n; ++i) all[i] = i;
+            return {all};
+        }
+
+        // Ear clipping
+        std::vector<std::vector<size_t>> parts;
+        std::vector<size_t> remaining(n);
+        for (size_t i = 0; i < n; ++i) remaining[i] = i;
+        while (remaining.size() > 3) {
+            bool clipped = false;
+            for (size_t k = 0; k < remaining.size(); ++k) {
+                size_t prev = remaining[(k + remaining.size() - 1) % remaining.size()];
+                size_t cur = remaining[k];
+                size_t next = remaining[(k + 1) % remaining.size()];
+                if (turn(ring[prev], ring[cur], ring[next]) <= CONVEX_EPSILON) continue;
+
+                // Only reflex vertices can lie inside an ear
+                bool empty = true;
+                for (size_t m = 0; m < remaining.size(); ++m) {
+                    size_t other = remaining[m];
+                    if (other == prev || other == cur || other == next) continue;
+                    size_t before = remaining[(m + remaining.size() - 1) % remaining.size()];
+                    size_t after = remaining[(m + 1) % remaining.size()];
+                    if (turn(ring[before], ring[other], ring[after]) > CONVEX_EPSILON) continue;
+                    if (turn(ring[prev], ring[cur], ring[other]) >= 0.0 &&
+                        turn(ring[cur], ring[next], ring[other]) >= 0.0 &&
+                        turn(ring[next], ring[prev], ring[other]) >= 0.0) {
+                        empty = false;
+                        break;
+                    }
+                }
+                if (!empty) continue;
+
+                parts.push_back({prev, cur, next});
+                remaining.erase(remaining.begin() + k);
+                clipped = true;
+                break;
+            }
+            // Self-intersecting or degenerate input: keep what is left whole
+            if (!clipped) break;
+        }
+        parts.push_back(remaining);
+
+        // Merge neighbours across shared diagonals while the result stays convex
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (size_t a = 0; a < parts.size() && !merged; ++a) {
+                for (size_t b = a + 1; b < parts.size() && !merged; ++b) {
+                    std::vector<size_t> joined;
+                    if (join_if_convex(ring, parts[a], parts[b], joined)) {
+                        parts[a] = std::move(joined);
+                        parts.erase(parts.begin() + b);
+                        merged = true;
+                    }
+                }
+            }
+        }
+        return parts;
+    }
+
+    // Join two parts sharing an edge (u -> v in one, v -> u in the other)
+    static bool join_if_convex(const std::vector<Vector2D>& ring, const std::vector<size_t>& p,
+                               const std::vector<size_t>& q, std::vector<size_t>& joined) {
+        for (size_t i = 0; i < p.size(); ++i) {
+            size_t u = p[i];
+            size_t v = p[(i + 1) % p.size()];
+            for (size_t j = 0; j < q.size(); ++j) {
+                if (q[j] != v || q[(j + 1) % q.size()] != u) continue;
+
+                // p from v round to u, then q from after u round to before v
+                joined.clear();
+                for (size_t k = 0; k < p.size(); ++k) joined.push_back(p[(i + 1 + k) % p.size()]);
+                for (size_t k = 2; k < q.size(); ++k) joined.push_back(q[(j + k) % q.size()]);
+
+                for (size_t k = 0; k < joined.size(); ++k) {
+                    if (turn(ring[joined[k]], ring[joined[(k + 1) % joined.size()]],
+                             ring[joined[(k + 2) % joined.size()]]) < -CONVEX_EPSILON) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Median split on the longer axis of the piece centres
+    uint32_t build_node(size_t first, size_t count) {
+        uint32_t index = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(Node{});
+
+        AABB bounds, centres;
+        for (size_t i = first; i < first + count; ++i) {
+            bounds.expand(pieces[i].bounds);
+            centres.expand(pieces[i].bounds.center());
+        }
+        nodes[index].bounds = bounds;
+
+        if (count <= LEAF_SIZE) {
+            nodes[index].first = static_cast<uint32_t>(first);
+            nodes[index].count = static_cast<uint32_t>(count);
+            return index;
+        }
+
+        bool split_x = centres.max.x - centres.min.x >= centres.max.y - centres.min.y;
+        size_t half = count / 2;
+        std::nth_element(
+            pieces.begin() + first,
+            pieces.begin() + first + half,
+            pieces.begin() + first + count,
+            [split_x](const Piece& a, const Piece& b) {
+                return split_x ? a.bounds.center().x < b.bounds.center().x
+                               : a.bounds.center().y < b.bounds.center().y;
+            });
+
+        nodes[index].count = 0;
+        build_node(first, half);
+        uint32_t right = build_node(first + half, count - half);
+        nodes[index].right_child = right;
+        return index;
+    }
+};
+
+} // namespace Collision
+} // namespace AICopilot
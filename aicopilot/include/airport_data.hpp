@@ -1,12 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <cstdint>
 #include <memory>
 #include <cmath>
 #include <queue>
 #include <limits>
 #include <string>
+#include <string_view>
 
 // ============================================================================
 // PART 1: AIRPORT DATA STRUCTURES
@@ -21,6 +28,7 @@ struct Taxiway;
 struct ParkingPosition;
 struct SIDSTARProcedure;
 class TaxiwayNetwork;
+class AirportLayoutData;
 class AirportMaster;
 
 // Constants
@@ -253,34 +261,170 @@ struct TaxiwayEdge {
 // PART 1.3: Taxiway Network Class
 // ============================================================================
 
+// Read-only view of a contiguous run of records
+template <typename T>
+class ConstSpan {
+public:
+    ConstSpan() = default;
+    ConstSpan(const T* data, size_t size) : data_(data), size_(size) {}
+    
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    
+private:
+    const T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * Taxiway graph with a mutable build form and an immutable compact form
+ *
+ * add_node/add_edge build the network in maps. compact() then moves it
+ * into one shared, immutable block of contiguous arrays: nodes and edges
+ * sorted by ID, adjacency and routing arcs as CSR rows over the dense
+ * node indices. Copies of a compacted network share that block, so one
+ * layout serves every pilot at the airport; the first change made through
+ * a copy expands that copy back into maps (copy-on-write). Queries give
+ * the same answers in either form.
+ */
 class TaxiwayNetwork {
+public:
+    // Outgoing edge in the dense routing view
+    struct Arc {
+        int to_index;
+        int edge_id;
+        double length_feet;
+        double max_speed_knots;
+    };
+    
 private:
+    // Compact form; never modified once built
+    struct Graph {
+        // By dense index; row i of arcs and adjacency is [row_offsets[i], row_offsets[i + 1])
+        std::vector<int> index_node_ids;
+        std::vector<LatLonAlt> index_positions;
+        std::vector<uint8_t> index_present;
+        std::vector<uint32_t> row_offsets;
+        std::vector<Arc> arcs;
+        std::vector<int> adjacency;         // edge IDs, parallel to arcs
+        
+        // By ID
+        std::vector<int> sorted_ids;        // every ID with a dense index, ascending
+        std::vector<int> sorted_index;      // dense index of sorted_ids[i]
+        std::vector<int> node_ids;          // IDs added with add_node, ascending
+        std::vector<TaxiwayNode> nodes;     // parallel to node_ids
+        std::vector<int> edge_ids;          // ascending
+        std::vector<TaxiwayEdge> edges;     // parallel to edge_ids
+        
+        int find_index(int node_id) const {
+            auto it = std::lower_bound(sorted_ids.begin(), sorted_ids.end(), node_id);
+            if (it == sorted_ids.end() || *it != node_id) return -1;
+            return sorted_index[it - sorted_ids.begin()];
+        }
+        
+        template <typename T>
+        const T* find(const std::vector<int>& ids, const std::vector<T>& records, int id) const {
+            auto it = std::lower_bound(ids.begin(), ids.end(), id);
+            return (it != ids.end() && *it == id) ? &records[it - ids.begin()] : nullptr;
+        }
+    };
+    
+    std::shared_ptr<const Graph> graph;     // set while compacted; the maps below are then empty
+    
     std::map<int, TaxiwayNode> nodes;
     std::map<int, TaxiwayEdge> edges;
     std::map<int, std::vector<int>> adjacency_list;  // node_id -> [edge_ids]
+    std::vector<int> node_ids;              // keys of nodes, ascending
+    
+    // Dense routing view, kept in step with the maps: every node ID seen by
+    // add_node or add_edge gets the next index, so searches can use arrays
+    std::unordered_map<int, int> node_index;
+    std::vector<int> index_node_ids;
+    std::vector<LatLonAlt> index_positions;
+    std::vector<uint8_t> index_present;     // 1 once add_node has seen the ID
+    std::vector<std::vector<Arc>> index_arcs;
+    uint64_t revision = 0;                  // bumped by every change
+    
+    int intern_node(int node_id) {
+        auto inserted = node_index.emplace(node_id, static_cast<int>(index_node_ids.size()));
+        if (inserted.second) {
+            index_node_ids.push_back(node_id);
+            index_positions.emplace_back();
+            index_present.push_back(0);
+            index_arcs.emplace_back();
+        }
+        return inserted.first->second;
+    }
+    
+    void add_arc(const TaxiwayEdge& edge) {
+        int from = intern_node(edge.from_node_id);
+        int to = intern_node(edge.to_node_id);
+        index_arcs[from].push_back({to, edge.edge_id, edge.length_feet, edge.max_speed_knots});
+    }
+    
+    // Back to the build form before a change; dense indices are kept
+    void thaw() {
+        if (!graph) return;
+        std::shared_ptr<const Graph> frozen = std::move(graph);
+        graph.reset();
+        
+        const size_t count = frozen->index_node_ids.size();
+        node_index.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            int index = intern_node(frozen->index_node_ids[i]);
+            index_positions[index] = frozen->index_positions[i];
+            index_present[index] = frozen->index_present[i];
+            uint32_t begin = frozen->row_offsets[i];
+            uint32_t end = frozen->row_offsets[i + 1];
+            if (begin == end) continue;
+            index_arcs[index].assign(frozen->arcs.begin() + begin, frozen->arcs.begin() + end);
+            adjacency_list[frozen->index_node_ids[i]].assign(frozen->adjacency.begin() + begin,
+                                                             frozen->adjacency.begin() + end);
+        }
+        node_ids = frozen->node_ids;
+        for (size_t i = 0; i < frozen->nodes.size(); ++i) nodes.emplace_hint(nodes.end(), node_ids[i], frozen->nodes[i]);
+        for (const auto& edge : frozen->edges) edges.emplace_hint(edges.end(), edge.edge_id, edge);
+    }
     
 public:
     TaxiwayNetwork() = default;
     
     // Node operations
     void add_node(const TaxiwayNode& node) {
+        thaw();
+        if (nodes.find(node.node_id) == nodes.end()) {
+            node_ids.insert(std::lower_bound(node_ids.begin(), node_ids.end(), node.node_id), node.node_id);
+        }
         nodes[node.node_id] = node;
+        int index = intern_node(node.node_id);
+        index_positions[index] = node.position;
+        index_present[index] = 1;
+        revision++;
     }
     
+    // Edits through the pointer are not seen by the routing view; use
+    // add_node to move a node. Expands a compacted network.
     TaxiwayNode* get_node(int node_id) {
+        thaw();
         auto it = nodes.find(node_id);
         return (it != nodes.end()) ? &it->second : nullptr;
     }
     
     const TaxiwayNode* get_node_const(int node_id) const {
+        if (graph) return graph->find(graph->node_ids, graph->nodes, node_id);
         auto it = nodes.find(node_id);
         return (it != nodes.end()) ? &it->second : nullptr;
     }
     
     // Edge operations
     void add_edge(const TaxiwayEdge& edge) {
+        thaw();
         edges[edge.edge_id] = edge;
         adjacency_list[edge.from_node_id].push_back(edge.edge_id);
+        add_arc(edge);
         if (edge.is_bidirectional) {
             // Create reverse edge
             TaxiwayEdge reverse_edge = edge;
@@ -289,30 +433,132 @@ public:
             reverse_edge.to_node_id = edge.from_node_id;
             edges[reverse_edge.edge_id] = reverse_edge;
             adjacency_list[edge.to_node_id].push_back(reverse_edge.edge_id);
+            add_arc(reverse_edge);
         }
+        revision++;
     }
     
-    TaxiwayEdge* get_edge(int edge_id) const {
+    const TaxiwayEdge* get_edge(int edge_id) const {
+        if (graph) return graph->find(graph->edge_ids, graph->edges, edge_id);
         auto it = edges.find(edge_id);
-        return (it != edges.end()) ? const_cast<TaxiwayEdge*>(&it->second) : nullptr;
+        return (it != edges.end()) ? &it->second : nullptr;
     }
     
-    const std::vector<int>& get_adjacent_edges(int node_id) const {
-        static const std::vector<int> empty;
+    ConstSpan<int> get_adjacent_edges(int node_id) const {
+        if (graph) {
+            int index = graph->find_index(node_id);
+            if (index < 0) return {};
+            uint32_t begin = graph->row_offsets[index];
+            return {graph->adjacency.data() + begin, graph->row_offsets[index + 1] - begin};
+        }
         auto it = adjacency_list.find(node_id);
-        return (it != adjacency_list.end()) ? it->second : empty;
+        return (it != adjacency_list.end()) ? ConstSpan<int>(it->second.data(), it->second.size()) : ConstSpan<int>();
     }
     
     // Query operations
-    size_t get_node_count() const { return nodes.size(); }
-    size_t get_edge_count() const { return edges.size(); }
+    size_t get_node_count() const { return graph ? graph->nodes.size() : nodes.size(); }
+    size_t get_edge_count() const { return graph ? graph->edges.size() : edges.size(); }
+    
+    // Ascending
+    const std::vector<int>& get_all_node_ids() const { return graph ? graph->node_ids : node_ids; }
+    
+    /**
+     * Move the network into its compact, shareable form
+     * 
+     * Call once building is done; later copies share the arrays. Does not
+     * change the revision, since no query answer changes.
+     */
+    void compact() {
+        if (graph) return;
+        auto g = std::make_shared<Graph>();
+        const size_t count = index_node_ids.size();
+        g->index_node_ids = std::move(index_node_ids);
+        g->index_positions = std::move(index_positions);
+        g->index_present = std::move(index_present);
+        
+        g->row_offsets.reserve(count + 1);
+        g->row_offsets.push_back(0);
+        size_t arc_count = 0;
+        for (const auto& row : index_arcs) arc_count += row.size();
+        g->arcs.reserve(arc_count);
+        g->adjacency.reserve(arc_count);
+        for (const auto& row : index_arcs) {
+            for (const Arc& arc : row) {
+                g->arcs.push_back(arc);
+                g->adjacency.push_back(arc.edge_id);
+            }
+            g->row_offsets.push_back(static_cast<uint32_t>(g->arcs.size()));
+        }
+        
+        std::vector<std::pair<int, int>> ids(node_index.begin(), node_index.end());
+        std::sort(ids.begin(), ids.end());
+        g->sorted_ids.reserve(ids.size());
+        g->sorted_index.reserve(ids.size());
+        for (const auto& id : ids) {
+            g->sorted_ids.push_back(id.first);
+            g->sorted_index.push_back(id.second);
+        }
+        
+        g->node_ids = std::move(node_ids);
+        g->nodes.reserve(nodes.size());
+        for (auto& pair : nodes) g->nodes.push_back(std::move(pair.second));
+        g->edge_ids.reserve(edges.size());
+        g->edges.reserve(edges.size());
+        for (const auto& pair : edges) {
+            g->edge_ids.push_back(pair.first);
+            g->edges.push_back(pair.second);
+        }
+        
+        nodes.clear();
+        edges.clear();
+        adjacency_list.clear();
+        node_index = {};
+        index_node_ids = {};
+        index_positions = {};
+        index_present = {};
+        index_arcs = {};
+        node_ids = {};
+        graph = std::move(g);
+    }
+    
+    bool is_compact() const { return graph != nullptr; }
     
-    std::vector<int> get_all_node_ids() const {
-        std::vector<int> ids;
-        for (const auto& pair : nodes) {
-            ids.push_back(pair.first);
+    // True when both networks are copies of one compacted network
+    bool shares_storage_with(const TaxiwayNetwork& other) const {
+        return graph && graph == other.graph;
+    }
+    
+    // Approximate heap bytes of the compact arrays; 0 before compact()
+    size_t get_memory_bytes() const {
+        if (!graph) return 0;
+        const Graph& g = *graph;
+        return g.index_node_ids.capacity() * sizeof(int) + g.index_positions.capacity() * sizeof(LatLonAlt) +
+               g.index_present.capacity() + g.row_offsets.capacity() * sizeof(uint32_t) +
+               g.arcs.capacity() * sizeof(Arc) + g.adjacency.capacity() * sizeof(int) +
+               (g.sorted_ids.capacity() + g.sorted_index.capacity() + g.node_ids.capacity() +
+                g.edge_ids.capacity()) * sizeof(int) +
+               g.nodes.capacity() * sizeof(TaxiwayNode) + g.edges.capacity() * sizeof(TaxiwayEdge);
+    }
+    
+    // Dense routing view; indices run from 0 to get_index_count() - 1
+    uint64_t get_revision() const { return revision; }
+    size_t get_index_count() const { return graph ? graph->index_node_ids.size() : index_node_ids.size(); }
+    int get_node_index(int node_id) const {
+        if (graph) return graph->find_index(node_id);
+        auto it = node_index.find(node_id);
+        return (it != node_index.end()) ? it->second : -1;
+    }
+    int get_node_id_at(int index) const { return graph ? graph->index_node_ids[index] : index_node_ids[index]; }
+    bool has_node_at(int index) const { return (graph ? graph->index_present[index] : index_present[index]) != 0; }
+    const LatLonAlt& get_position_at(int index) const {
+        return graph ? graph->index_positions[index] : index_positions[index];
+    }
+    ConstSpan<Arc> get_arcs_at(int index) const {
+        if (graph) {
+            uint32_t begin = graph->row_offsets[index];
+            return {graph->arcs.data() + begin, graph->row_offsets[index + 1] - begin};
         }
-        return ids;
+        return {index_arcs[index].data(), index_arcs[index].size()};
     }
 };
 
@@ -436,7 +682,392 @@ struct SIDSTARProcedure {
 };
 
 // ============================================================================
-// PART 1.6: Airport Master Class
+// PART 1.6: Shared Airport Layout
+// ============================================================================
+
+/**
+ * Immutable, flattened layout of one airport
+ *
+ * Built once per airport and handed out as shared_ptr<const>, so every
+ * pilot at the airport reads the same copy. The layout is four parts,
+ * each held by its own shared_ptr: runways, the compacted taxiway
+ * network, parking and procedures. Parking and procedures are contiguous
+ * records whose strings live in the part's string table, and procedure
+ * waypoints are stored back to back with each procedure owning a run of
+ * them. Runways stay Runway structs: there are a handful per airport and
+ * callers take them by reference.
+ *
+ * build_lazy() takes a loader per part instead of the data; a part is
+ * built on the first call that reads it, once, whichever thread gets
+ * there first. The with_*() functions return a copy with one part
+ * replaced and the others shared, so changing the parking list does not
+ * rebuild the taxiway network.
+ */
+class AirportLayoutData {
+public:
+    enum class Part { Runways, TaxiwayNetwork, Parking, Procedures };
+    
+    // [offset, offset + length) in the owning part's string table
+    struct StringRef {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+    
+    // ParkingPosition without its occupancy state
+    struct ParkingRecord {
+        LatLonAlt location;
+        double jetway_offset_feet;
+        double aircraft_type_width_feet;
+        double max_wingspan_feet;
+        StringRef gate_name;
+        int parking_id;
+        int num_parking_spaces;
+        ParkingPosition::Type type;
+        ParkingPosition::Pushback pushback_direction;
+        bool has_jetway;
+        bool has_electrical;
+        bool has_water;
+        bool has_lavatory_service;
+        bool has_catering;
+        bool has_fueling;
+    };
+    
+    struct ProcedureWaypointRecord {
+        LatLonAlt position;
+        double altitude_feet;
+        double speed_knots;
+        StringRef name;
+        int sequence_number;
+        ProcedureWaypoint::TurnDirection turn_at_waypoint;
+    };
+    
+    // Procedures are grouped by runway ident in ascending order
+    struct ProcedureRecord {
+        StringRef procedure_name;
+        StringRef runway_ident;
+        uint32_t first_waypoint;
+        uint32_t waypoint_count;
+        SIDSTARProcedure::Type procedure_type;
+        SIDSTARProcedure::TransitionType transition_type;
+    };
+    
+    using ProcedureMap = std::map<std::string, std::vector<SIDSTARProcedure>>;
+    
+    // Part loaders for build_lazy(); an empty loader gives an empty part
+    struct Sources {
+        std::function<std::vector<Runway>()> runways;
+        std::function<TaxiwayNetwork()> taxiway_network;
+        std::function<std::vector<ParkingPosition>()> parking;
+        std::function<ProcedureMap()> procedures;
+    };
+    
+    static std::shared_ptr<const AirportLayoutData> build(
+        std::vector<Runway> runways, TaxiwayNetwork network,
+        const std::vector<ParkingPosition>& parking_positions,
+        const ProcedureMap& procedures) {
+        auto layout = std::make_shared<AirportLayoutData>();
+        layout->runways = LazyPart<std::vector<Runway>>::loaded(std::move(runways));
+        network.compact();
+        layout->taxiway_network = LazyPart<TaxiwayNetwork>::loaded(std::move(network));
+        layout->parking = LazyPart<ParkingPart>::loaded(ParkingPart::from(parking_positions));
+        layout->procedures = LazyPart<ProcedurePart>::loaded(ProcedurePart::from(procedures));
+        return layout;
+    }
+    
+    static std::shared_ptr<const AirportLayoutData> build_lazy(Sources sources) {
+        auto layout = std::make_shared<AirportLayoutData>();
+        layout->runways = LazyPart<std::vector<Runway>>::deferred(std::move(sources.runways));
+        layout->taxiway_network = LazyPart<TaxiwayNetwork>::deferred(
+            [load = std::move(sources.taxiway_network)]() {
+                TaxiwayNetwork network = load ? load() : TaxiwayNetwork();
+                network.compact();
+                return network;
+            });
+        layout->parking = LazyPart<ParkingPart>::deferred([load = std::move(sources.parking)]() {
+            return load ? ParkingPart::from(load()) : ParkingPart();
+        });
+        layout->procedures = LazyPart<ProcedurePart>::deferred([load = std::move(sources.procedures)]() {
+            return load ? ProcedurePart::from(load()) : ProcedurePart();
+        });
+        return layout;
+    }
+    
+    // Shared layout with nothing in it
+    static const std::shared_ptr<const AirportLayoutData>& empty() {
+        static const std::shared_ptr<const AirportLayoutData> layout = build({}, TaxiwayNetwork(), {}, {});
+        return layout;
+    }
+    
+    // Copies with one part replaced; the other parts are shared, loaded or not
+    std::shared_ptr<const AirportLayoutData> with_runways(std::vector<Runway> value) const {
+        auto layout = std::make_shared<AirportLayoutData>(*this);
+        layout->runways = LazyPart<std::vector<Runway>>::loaded(std::move(value));
+        return layout;
+    }
+    
+    std::shared_ptr<const AirportLayoutData> with_taxiway_network(TaxiwayNetwork value) const {
+        auto layout = std::make_shared<AirportLayoutData>(*this);
+        value.compact();
+        layout->taxiway_network = LazyPart<TaxiwayNetwork>::loaded(std::move(value));
+        return layout;
+    }
+    
+    std::shared_ptr<const AirportLayoutData> with_parking(const std::vector<ParkingPosition>& value) const {
+        auto layout = std::make_shared<AirportLayoutData>(*this);
+        layout->parking = LazyPart<ParkingPart>::loaded(ParkingPart::from(value));
+        return layout;
+    }
+    
+    std::shared_ptr<const AirportLayoutData> with_procedures(const ProcedureMap& value) const {
+        auto layout = std::make_shared<AirportLayoutData>(*this);
+        layout->procedures = LazyPart<ProcedurePart>::loaded(ProcedurePart::from(value));
+        return layout;
+    }
+    
+    bool is_loaded(Part part) const {
+        switch (part) {
+            case Part::Runways: return runways->is_loaded();
+            case Part::TaxiwayNetwork: return taxiway_network->is_loaded();
+            case Part::Parking: return parking->is_loaded();
+            case Part::Procedures: return procedures->is_loaded();
+        }
+        return false;
+    }
+    
+    // True when both layouts hold the same instance of the part
+    bool shares_part_with(const AirportLayoutData& other, Part part) const {
+        switch (part) {
+            case Part::Runways: return runways == other.runways;
+            case Part::TaxiwayNetwork: return taxiway_network == other.taxiway_network;
+            case Part::Parking: return parking == other.parking;
+            case Part::Procedures: return procedures == other.procedures;
+        }
+        return false;
+    }
+    
+    // Approximate heap bytes of the parts loaded so far
+    size_t get_memory_bytes() const {
+        size_t bytes = sizeof(AirportLayoutData);
+        if (runways->is_loaded()) bytes += runways->get().capacity() * sizeof(Runway);
+        if (taxiway_network->is_loaded()) bytes += taxiway_network->get().get_memory_bytes();
+        if (parking->is_loaded()) bytes += parking->get().memory_bytes();
+        if (procedures->is_loaded()) bytes += procedures->get().memory_bytes();
+        return bytes;
+    }
+    
+    // Runways and taxiways
+    const std::vector<Runway>& get_runways() const { return runways->get(); }
+    const TaxiwayNetwork& get_taxiway_network() const { return taxiway_network->get(); }
+    
+    // Parking, in the order given to build()
+    std::string_view get_parking_string(StringRef ref) const { return parking->get().string(ref); }
+    size_t get_parking_count() const { return parking->get().records.size(); }
+    const ParkingRecord& get_parking_record(size_t index) const { return parking->get().records[index]; }
+    
+    ParkingPosition get_parking_at(size_t index) const {
+        const ParkingPart& part = parking->get();
+        const ParkingRecord& r = part.records[index];
+        ParkingPosition p(r.parking_id, r.location);
+        p.type = r.type;
+        p.pushback_direction = r.pushback_direction;
+        p.gate_name = std::string(part.string(r.gate_name));
+        p.has_jetway = r.has_jetway;
+        p.jetway_offset_feet = r.jetway_offset_feet;
+        p.aircraft_type_width_feet = r.aircraft_type_width_feet;
+        p.max_wingspan_feet = r.max_wingspan_feet;
+        p.num_parking_spaces = r.num_parking_spaces;
+        p.has_electrical = r.has_electrical;
+        p.has_water = r.has_water;
+        p.has_lavatory_service = r.has_lavatory_service;
+        p.has_catering = r.has_catering;
+        p.has_fueling = r.has_fueling;
+        return p;
+    }
+    
+    // Index of the parking position, or -1
+    int find_parking(int parking_id) const {
+        const auto& records = parking->get().records;
+        for (size_t i = 0; i < records.size(); ++i) {
+            if (records[i].parking_id == parking_id) return static_cast<int>(i);
+        }
+        return -1;
+    }
+    
+    std::vector<ParkingPosition> get_parking_positions() const {
+        std::vector<ParkingPosition> result;
+        result.reserve(get_parking_count());
+        for (size_t i = 0; i < get_parking_count(); ++i) result.push_back(get_parking_at(i));
+        return result;
+    }
+    
+    // Procedures
+    std::string_view get_procedure_string(StringRef ref) const { return procedures->get().string(ref); }
+    size_t get_procedure_count() const { return procedures->get().records.size(); }
+    const ProcedureRecord& get_procedure_record(size_t index) const { return procedures->get().records[index]; }
+    
+    ConstSpan<ProcedureWaypointRecord> get_procedure_waypoints(size_t index) const {
+        const ProcedurePart& part = procedures->get();
+        const ProcedureRecord& r = part.records[index];
+        return {part.waypoints.data() + r.first_waypoint, r.waypoint_count};
+    }
+    
+    // [first, last) of the procedures for one runway ident ("" for all-runway procedures)
+    std::pair<size_t, size_t> get_procedure_range(std::string_view runway_ident) const {
+        const ProcedurePart& part = procedures->get();
+        auto less = [&part](const ProcedureRecord& r, std::string_view ident) {
+            return part.string(r.runway_ident) < ident;
+        };
+        auto first = std::lower_bound(part.records.begin(), part.records.end(), runway_ident, less);
+        auto last = first;
+        while (last != part.records.end() && part.string(last->runway_ident) == runway_ident) ++last;
+        return {static_cast<size_t>(first - part.records.begin()), static_cast<size_t>(last - part.records.begin())};
+    }
+    
+    SIDSTARProcedure get_procedure_at(size_t index) const {
+        const ProcedurePart& part = procedures->get();
+        const ProcedureRecord& r = part.records[index];
+        SIDSTARProcedure proc{std::string(part.string(r.procedure_name))};
+        proc.runway_ident = std::string(part.string(r.runway_ident));
+        proc.procedure_type = r.procedure_type;
+        proc.transition_type = r.transition_type;
+        proc.waypoints.reserve(r.waypoint_count);
+        for (const auto& w : get_procedure_waypoints(index)) {
+            ProcedureWaypoint wp(std::string(part.string(w.name)), w.position);
+            wp.altitude_feet = w.altitude_feet;
+            wp.speed_knots = w.speed_knots;
+            wp.turn_at_waypoint = w.turn_at_waypoint;
+            wp.sequence_number = w.sequence_number;
+            proc.waypoints.push_back(std::move(wp));
+        }
+        return proc;
+    }
+    
+    // Keyed by runway ident, as they are passed to build()
+    ProcedureMap get_procedures() const {
+        ProcedureMap result;
+        const ProcedurePart& part = procedures->get();
+        for (size_t i = 0; i < part.records.size(); ++i) {
+            result[std::string(part.string(part.records[i].runway_ident))].push_back(get_procedure_at(i));
+        }
+        return result;
+    }
+
+private:
+    /**
+     * One part, either given or built by its loader on first get()
+     *
+     * The loader is dropped once it has run, so whatever it captured (a
+     * fetched source layout, say) is freed with it. A loader that throws
+     * leaves the part unloaded and the next get() tries again.
+     */
+    template <typename T>
+    class LazyPart {
+    public:
+        static std::shared_ptr<const LazyPart> loaded(T value) {
+            auto part = std::make_shared<LazyPart>();
+            part->value_ = std::move(value);
+            part->loaded_.store(true, std::memory_order_release);
+            return part;
+        }
+        
+        static std::shared_ptr<const LazyPart> deferred(std::function<T()> loader) {
+            auto part = std::make_shared<LazyPart>();
+            part->loader_ = std::move(loader);
+            return part;
+        }
+        
+        const T& get() const {
+            if (!loaded_.load(std::memory_order_acquire)) {
+                std::call_once(once_, [this]() {
+                    if (loader_) value_ = loader_();
+                    loader_ = nullptr;
+                    loaded_.store(true, std::memory_order_release);
+                });
+            }
+            return value_;
+        }
+        
+        bool is_loaded() const { return loaded_.load(std::memory_order_acquire); }
+    
+    private:
+        mutable std::once_flag once_;
+        mutable std::function<T()> loader_;
+        mutable T value_{};
+        mutable std::atomic<bool> loaded_{false};
+    };
+    
+    // Appends s to table and returns where it went
+    static StringRef intern(std::vector<char>& table, const std::string& s) {
+        StringRef ref{static_cast<uint32_t>(table.size()), static_cast<uint32_t>(s.size())};
+        table.insert(table.end(), s.begin(), s.end());
+        return ref;
+    }
+    
+    struct ParkingPart {
+        std::vector<ParkingRecord> records;
+        std::vector<char> strings;
+        
+        static ParkingPart from(const std::vector<ParkingPosition>& positions) {
+            ParkingPart part;
+            part.records.reserve(positions.size());
+            for (const auto& p : positions) {
+                part.records.push_back({p.location, p.jetway_offset_feet, p.aircraft_type_width_feet,
+                                        p.max_wingspan_feet, intern(part.strings, p.gate_name), p.parking_id,
+                                        p.num_parking_spaces, p.type, p.pushback_direction, p.has_jetway,
+                                        p.has_electrical, p.has_water, p.has_lavatory_service, p.has_catering,
+                                        p.has_fueling});
+            }
+            part.strings.shrink_to_fit();
+            return part;
+        }
+        
+        std::string_view string(StringRef ref) const { return std::string_view(strings.data() + ref.offset, ref.length); }
+        size_t memory_bytes() const { return records.capacity() * sizeof(ParkingRecord) + strings.capacity(); }
+    };
+    
+    struct ProcedurePart {
+        std::vector<ProcedureRecord> records;
+        std::vector<ProcedureWaypointRecord> waypoints;
+        std::vector<char> strings;
+        
+        static ProcedurePart from(const ProcedureMap& procedures) {
+            ProcedurePart part;
+            for (const auto& [runway_ident, list] : procedures) {
+                StringRef runway = intern(part.strings, runway_ident);
+                for (const auto& proc : list) {
+                    ProcedureRecord record{intern(part.strings, proc.procedure_name), runway,
+                                           static_cast<uint32_t>(part.waypoints.size()),
+                                           static_cast<uint32_t>(proc.waypoints.size()), proc.procedure_type,
+                                           proc.transition_type};
+                    for (const auto& wp : proc.waypoints) {
+                        part.waypoints.push_back({wp.position, wp.altitude_feet, wp.speed_knots,
+                                                  intern(part.strings, wp.name), wp.sequence_number,
+                                                  wp.turn_at_waypoint});
+                    }
+                    part.records.push_back(record);
+                }
+            }
+            part.strings.shrink_to_fit();
+            part.waypoints.shrink_to_fit();
+            part.records.shrink_to_fit();
+            return part;
+        }
+        
+        std::string_view string(StringRef ref) const { return std::string_view(strings.data() + ref.offset, ref.length); }
+        size_t memory_bytes() const {
+            return records.capacity() * sizeof(ProcedureRecord) +
+                   waypoints.capacity() * sizeof(ProcedureWaypointRecord) + strings.capacity();
+        }
+    };
+    
+    std::shared_ptr<const LazyPart<std::vector<Runway>>> runways;
+    std::shared_ptr<const LazyPart<TaxiwayNetwork>> taxiway_network;
+    std::shared_ptr<const LazyPart<ParkingPart>> parking;
+    std::shared_ptr<const LazyPart<ProcedurePart>> procedures;
+};
+
+// ============================================================================
+// PART 1.7: Airport Master Class
 // ============================================================================
 
 class AirportMaster {
@@ -451,11 +1082,9 @@ private:
     LatLonAlt reference_point;          // Phase reference for local coordinates
     double elevation_feet;
     
-    // Operational data
-    std::vector<Runway> runways;
-    TaxiwayNetwork taxiway_network;
-    std::vector<ParkingPosition> parking_positions;
-    std::map<std::string, std::vector<SIDSTARProcedure>> procedures;
+    // Operational data: runways, taxiways, parking and procedures, shared
+    // with every other AirportMaster of the same airport
+    std::shared_ptr<const AirportLayoutData> layout;
     
     // Traffic management
     bool is_controlled;
@@ -464,7 +1093,7 @@ private:
 public:
     AirportMaster(int id = 0, const std::string& icao = "")
         : airport_id(id), icao_code(icao), elevation_feet(0.0),
-          is_controlled(false), number_of_towers(1) {}
+          layout(AirportLayoutData::empty()), is_controlled(false), number_of_towers(1) {}
     
     // Move semantics for std::optional compatibility
     AirportMaster(AirportMaster&&) = default;
@@ -474,60 +1103,52 @@ public:
     void set_reference_point(const LatLonAlt& ref) { reference_point = ref; }
     void set_elevation(double elev_ft) { elevation_feet = elev_ft; }
     void set_controlled(bool controlled) { is_controlled = controlled; }
-    
-    // Runway management
-    void add_runway(const Runway& runway) {
-        runways.push_back(runway);
+    void set_layout(std::shared_ptr<const AirportLayoutData> data) {
+        layout = data ? std::move(data) : AirportLayoutData::empty();
     }
     
+    const AirportLayoutData& get_layout() const { return *layout; }
+    const std::shared_ptr<const AirportLayoutData>& get_shared_layout() const { return layout; }
+    
+    // Runways
     const std::vector<Runway>& get_runways() const {
-        return runways;
+        return layout->get_runways();
     }
     
-    Runway* get_runway(const std::string& ident) {
-        for (auto& rwy : runways) {
+    const Runway* get_runway(const std::string& ident) const {
+        for (const auto& rwy : layout->get_runways()) {
             if (rwy.runway_ident == ident) return &rwy;
         }
         return nullptr;
     }
     
     // Taxiway network
-    TaxiwayNetwork& get_taxiway_network() {
-        return taxiway_network;
-    }
-    
     const TaxiwayNetwork& get_taxiway_network() const {
-        return taxiway_network;
+        return layout->get_taxiway_network();
     }
 
     const TaxiwayNetwork& get_taxiway_network_const() const {
-        return taxiway_network;
+        return layout->get_taxiway_network();
     }
     
     // Parking positions
-    void add_parking(const ParkingPosition& parking) {
-        parking_positions.push_back(parking);
-    }
-    
-    const std::vector<ParkingPosition>& get_parking_positions() const {
-        return parking_positions;
-    }
-    
-    ParkingPosition* get_parking(int parking_id) {
-        for (auto& parking : parking_positions) {
-            if (parking.parking_id == parking_id) return &parking;
-        }
-        return nullptr;
+    std::vector<ParkingPosition> get_parking_positions() const {
+        return layout->get_parking_positions();
     }
     
-    // SID/STAR procedures
-    void add_procedure(const SIDSTARProcedure& proc) {
-        procedures[proc.runway_ident].push_back(proc);
+    bool get_parking(int parking_id, ParkingPosition& parking) const {
+        int index = layout->find_parking(parking_id);
+        if (index < 0) return false;
+        parking = layout->get_parking_at(index);
+        return true;
     }
     
-    std::vector<SIDSTARProcedure>* get_procedures(const std::string& runway_ident) {
-        auto it = procedures.find(runway_ident);
-        return (it != procedures.end()) ? &it->second : nullptr;
+    // SID/STAR procedures for one runway ident; empty if there are none
+    std::vector<SIDSTARProcedure> get_procedures(const std::string& runway_ident) const {
+        std::vector<SIDSTARProcedure> result;
+        auto range = layout->get_procedure_range(runway_ident);
+        for (size_t i = range.first; i < range.second; ++i) result.push_back(layout->get_procedure_at(i));
+        return result;
     }
     
     // Accessors
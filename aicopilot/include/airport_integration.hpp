@@ -4,7 +4,9 @@
 #include "airport_manager.h"
 #include "atc_routing.hpp"
 #include "collision_avoidance.hpp"
+#include "mpsc_queue.hpp"
 #include "simconnect_wrapper.h"
+#include "state_snapshot.hpp"
 #include <memory>
 #include <chrono>
 #include <functional>
@@ -41,6 +43,14 @@ using namespace Collision;
  * - VELOCITY WORLD X,Y,Z  : World velocity vector (feet/second)
  * - WING SPAN             : Aircraft wing span (feet)
  * - FUSELAGE LENGTH        : Aircraft length (feet)
+ *
+ * The SimConnect dispatch thread and the airport layer never wait for each
+ * other: the user aircraft state is published through a seqlock snapshot,
+ * and transmit_*() push onto a lock-free queue that the dispatch thread
+ * drains into the per-aircraft command map on each state update. The
+ * dispatch thread is the only consumer; readers see the map it last
+ * published. While the sim is paused nothing drains, so once the queue is
+ * full transmit_*() return false and the caller keeps the clearance.
  */
 
 class SimConnectBridge {
@@ -82,25 +92,49 @@ public:
         std::chrono::system_clock::time_point timestamp;
     };
 
-    void transmit_taxi_clearance(int aircraft_object_id,
+    // false when the command was not queued (no simulator, empty route or a
+    // full queue); nothing is recorded then and the caller should retry
+    bool transmit_taxi_clearance(int aircraft_object_id,
                                  const std::vector<int>& taxiway_node_sequence);
 
-    void transmit_altitude_clearance(int aircraft_object_id, double altitude_feet);
+    bool transmit_altitude_clearance(int aircraft_object_id, double altitude_feet);
 
-    void transmit_heading_instruction(int aircraft_object_id, double heading_true);
+    bool transmit_heading_instruction(int aircraft_object_id, double heading_true);
 
     std::shared_ptr<SimConnectWrapper> get_simconnect() const { return simconnect_; }
+    // As of the last state update; a transmit_*() shows up after the next one
     std::optional<AICommand> get_last_ai_command(int aircraft_id) const;
 
+    // transmit_*() calls refused because the queue was full
+    uint64_t get_dropped_command_count() const { return outgoing_.dropped(); }
+
 private:
     static constexpr int kUserAircraftId = 0;
+    static constexpr size_t kCommandQueueCapacity = 256;
+
+    // One transmit_*() call; only its own field is applied to the command
+    struct CommandUpdate {
+        enum class Kind { TaxiRoute, Altitude, Heading };
+
+        int aircraft_id = 0;
+        Kind kind = Kind::TaxiRoute;
+        std::vector<int> taxiway_route;
+        double value = 0.0;
+        std::chrono::system_clock::time_point timestamp;
+    };
 
     std::shared_ptr<SimConnectWrapper> simconnect_;
-    AircraftStateCallback state_callback_;
-    SimConnectData last_user_state_;
-    mutable std::mutex data_mutex_;
-    std::map<int, AICommand> ai_commands_;
+    std::shared_ptr<const AircraftStateCallback> state_callback_;   // atomic_load / atomic_store
+    StateSnapshot<SimConnectData> user_state_;                      // written by the dispatch thread only
+    uint64_t user_state_version_ = 0;                               // core version user_state_ was built from
+    MpscQueue<CommandUpdate> outgoing_;
+
+    using CommandMap = std::map<int, AICommand>;
+    CommandMap ai_commands_;                                        // dispatch thread only
+    std::shared_ptr<const CommandMap> published_commands_;         // atomic_load / atomic_store
 
+    bool enqueue(CommandUpdate update);
+    size_t drain_commands();
     static SimConnectData convert_state(const AircraftState& state);
 };
 
@@ -123,6 +157,9 @@ public:
     void update(double delta_time_seconds);
 
     void set_collision_update_interval(double milliseconds);
+    
+    // Run the collision pass in spatial partitions on a task pool
+    void set_thread_pool(std::shared_ptr<WorkStealingPool> pool);
     void set_sequencing_update_interval(double milliseconds);
 
     void update_aircraft_state(const SimConnectBridge::SimConnectData& data);
@@ -132,6 +169,16 @@ public:
                                                  int end_node_id,
                                                  double max_speed_knots = 15.0);
 
+    // Conflict-free taxi plans against the shared reservation table
+    std::vector<CooperativeTaxiPlanner::TaxiPlan> plan_taxi_batch(
+        const std::vector<CooperativeTaxiPlanner::TaxiRequest>& requests);
+    CooperativeTaxiPlanner::TaxiPlan replan_taxi(const CooperativeTaxiPlanner::TaxiRequest& request);
+
+    // Arrival sequencing; eta_seconds is on the system clock, like the sequencing pass
+    bool sequence_arrival(int aircraft_id, int runway_number, double eta_seconds);
+    bool update_arrival_eta(int aircraft_id, double eta_seconds);
+    const SequencedAircraft* get_sequence_info(int aircraft_id) const;
+
     RunwayAssignment::RunwayCandidate assign_runway(double wind_direction,
                                                     double wind_speed,
                                                     bool is_departure);
@@ -151,11 +198,13 @@ private:
     std::shared_ptr<SimConnectBridge> simconnect_bridge_;
 
     std::unique_ptr<GroundRouter> ground_router_;
+    std::unique_ptr<CooperativeTaxiPlanner> taxi_planner_;
     std::unique_ptr<ATCSequencer> atc_sequencer_;
     std::unique_ptr<RunwayAssignment> runway_assigner_;
     std::unique_ptr<ConflictPredictor> conflict_predictor_;
     std::unique_ptr<ConflictResolver> conflict_resolver_;
     std::unique_ptr<ManeuverSelector> maneuver_selector_;
+    std::unique_ptr<CoordinatedManeuverSolver> maneuver_solver_;
     std::unique_ptr<HoldingPatternGenerator> holding_pattern_gen_;
 
     std::map<int, SimConnectBridge::SimConnectData> aircraft_states_;
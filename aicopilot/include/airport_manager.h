@@ -2,9 +2,12 @@
 
 #include "airport_data.hpp"
 #include "navdata_provider.h"
+#include "tile_cache.hpp"
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace AICopilot {
@@ -14,20 +17,50 @@ namespace Integration {
  * AirportManager is responsible for owning airport infrastructure data
  * (runways, taxiways, parking, procedures) and synchronising it with
  * optional navigation data providers.
+ *
+ * Layouts taken from the provider are kept in a byte-budgeted LRU of
+ * recently used airports, so switching back to an airport does not fetch
+ * it again. prefetch() fetches airports needed soon (origin, destination,
+ * alternates) on background tasks; the layout parts themselves are only
+ * flattened when first read. Not thread-safe, like the rest of the class.
  */
 class AirportManager {
 public:
     AirportManager();
-    explicit AirportManager(std::shared_ptr<INavdataProvider> provider);
+    explicit AirportManager(std::shared_ptr<const INavdataProvider> provider);
 
-    void set_navdata_provider(std::shared_ptr<INavdataProvider> provider);
+    static constexpr size_t DEFAULT_LAYOUT_CACHE_BYTES = 32 * 1024 * 1024;
+
+    void set_navdata_provider(std::shared_ptr<const INavdataProvider> provider);
 
     bool initialize(const std::string& icao_code, const Airport::LatLonAlt& reference_point);
 
     bool is_initialized() const { return airport_.has_value(); }
 
+    /**
+     * Refresh the airport from the navdata provider
+     * 
+     * Takes the provider's shared layout for the airport, so pilots at the
+     * same airport on one provider hold one copy of it.
+     */
     bool load_from_navdata();
 
+    /**
+     * Start fetching layouts for airports needed soon
+     * 
+     * Airports already cached or in flight are skipped. A later initialize()
+     * or load_from_navdata() for one of them waits for its fetch instead of
+     * starting another.
+     */
+    void prefetch(const std::vector<std::string>& icao_codes);
+
+    // Cached, or found by a prefetch() that has finished
+    bool is_layout_ready(const std::string& icao_code) const;
+
+    // Shrinking the budget evicts immediately; the current airport's layout stays held regardless
+    void set_layout_cache_budget(size_t bytes);
+    TileCacheStats get_layout_cache_stats() const { return layout_cache_.getStats(); }
+
     void set_name(const std::string& name);
     void set_elevation(double elevation_feet);
     void set_controlled(bool controlled);
@@ -39,6 +72,10 @@ public:
     void set_parking_positions(const std::vector<Airport::ParkingPosition>& parking_positions);
     void set_procedures(const std::map<std::string, std::vector<Airport::SIDSTARProcedure>>& procedures);
 
+    // Replace runways, taxiways, parking and procedures at once; null clears them
+    void set_layout(std::shared_ptr<const Airport::AirportLayoutData> layout);
+    const std::shared_ptr<const Airport::AirportLayoutData>& get_layout() const { return layout_; }
+
     Airport::AirportMaster* get_airport();
     const Airport::AirportMaster* get_airport_const() const;
 
@@ -48,21 +85,28 @@ public:
     bool is_controlled() const { return controlled_; }
 
 private:
+    using LayoutPtr = std::shared_ptr<const Airport::AirportLayoutData>;
+
     void rebuild_airport();
+    LayoutPtr acquire_layout(const std::string& icao_code);
+    void collect_prefetched();
 
-    std::shared_ptr<INavdataProvider> provider_;
+    std::shared_ptr<const INavdataProvider> provider_;
     std::string icao_code_;
     std::string name_;
     Airport::LatLonAlt reference_point_;
     double elevation_feet_;
     bool controlled_;
 
-    std::vector<Airport::Runway> runways_;
-    Airport::TaxiwayNetwork taxiway_network_;
-    std::vector<Airport::ParkingPosition> parking_positions_;
-    std::map<std::string, std::vector<Airport::SIDSTARProcedure>> procedures_;
+    std::shared_ptr<const Airport::AirportLayoutData> layout_;
 
     std::optional<Airport::AirportMaster> airport_;
+
+    // By upper-case ICAO; charged at each layout's loaded size when last used
+    TileCache<const Airport::AirportLayoutData, std::string> layout_cache_;
+
+    // Last, so destruction waits for fetches before anything else goes
+    std::unordered_map<std::string, std::shared_future<LayoutPtr>> pending_;
 };
 
 } // namespace Integration
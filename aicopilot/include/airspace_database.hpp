@@ -0,0 +1,181 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Airspace Database - controlled and special-use volumes with an R-tree
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef AIRSPACE_DATABASE_HPP
+#define AIRSPACE_DATABASE_HPP
+
+#include "aicopilot_types.h"
+#include "tile_cache.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+
+enum class AirspaceClass : uint8_t {
+    CLASS_A,
+    CLASS_B,
+    CLASS_C,
+    CLASS_D,
+    CLASS_E,
+    RESTRICTED,
+    PROHIBITED,
+    DANGER,
+    MOA,
+    TFR
+};
+
+constexpr size_t AIRSPACE_CLASS_COUNT = 10;
+
+constexpr uint32_t airspaceClassBit(AirspaceClass type) {
+    return 1u << static_cast<uint32_t>(type);
+}
+
+// One lateral boundary between a floor and a ceiling
+struct AirspaceVolume {
+    std::string name;
+    AirspaceClass type = AirspaceClass::CLASS_E;
+    std::vector<LatLon> boundary;    // closed implicitly; either winding
+    double floorFt = 0.0;            // feet MSL
+    double ceilingFt = 0.0;          // feet MSL
+};
+
+// Where a segment is inside one volume, as fractions of the segment
+struct AirspaceCrossing {
+    uint32_t id;
+    double entry;                    // first point inside
+    double exit;                     // last point inside
+    double insideNM;                 // total length inside
+};
+
+// Cost per nautical mile flown inside each class; 0 ignores the class,
+// infinity closes it
+struct AirspaceCostWeights {
+    std::array<double, AIRSPACE_CLASS_COUNT> perNM{};
+
+    AirspaceCostWeights& set(AirspaceClass type, double costPerNM) {
+        perNM[static_cast<size_t>(type)] = costPerNM;
+        return *this;
+    }
+    double get(AirspaceClass type) const { return perNM[static_cast<size_t>(type)]; }
+    bool any() const;
+};
+
+/**
+ * Airspace volumes indexed for containment and route segment queries
+ *
+ * Volume bounds go into a packed R-tree (sort-tile-recursive, NODE_SIZE
+ * entries per node), so a query only visits the volumes whose bounds it
+ * touches. Each volume keeps its edges with the ray-cast slope
+ * precomputed and is cut into latitude bands listing the edges crossing
+ * each band, so a containment test casts against the few edges of one
+ * band and a segment tests only the edges of the bands it spans.
+ *
+ * A segment is inside a volume vertically when the altitude is within
+ * [floor, ceiling]. Latitude and longitude are treated as planar, which
+ * keeps containment and crossing fractions exact for the boundary as
+ * drawn; lengths are flat-earth. Longitudes are not wrapped at the
+ * antimeridian.
+ *
+ * Immutable after build(); concurrent queries are safe and allocate
+ * nothing once a thread's scratch buffer has grown.
+ */
+class AirspaceDatabase {
+public:
+    static constexpr size_t NODE_SIZE = 8;
+    static constexpr size_t EDGES_PER_BAND = 4;    // band count aims for this many edges per band
+    static constexpr size_t MAX_BANDS = 64;
+
+    // Replace the volumes; ids are indices into this vector. Volumes with
+    // fewer than three vertices are kept but never match.
+    void build(std::vector<AirspaceVolume> volumes);
+    void clear();
+
+    size_t size() const { return volumes_.size(); }
+    bool empty() const { return volumes_.empty(); }
+    const AirspaceVolume& getVolume(uint32_t id) const { return volumes_[id].volume; }
+
+    // True if the point is inside the volume's lateral boundary
+    bool contains(uint32_t id, double latitude, double longitude) const;
+
+    // Ids of the volumes holding a point at an altitude (feet MSL), ascending
+    void findContaining(double latitude, double longitude, double altitudeFt,
+                        std::vector<uint32_t>& out) const;
+
+    // Every volume the segment from -> to passes through at altitudeFt, by id
+    void querySegment(const Position& from, const Position& to, double altitudeFt,
+                      std::vector<AirspaceCrossing>& out) const;
+
+    // Weighted miles inside the volumes the segment passes through; the
+    // cost term routers add to a leg. Infinite when it enters a closed class.
+    double segmentCost(const Position& from, const Position& to, double altitudeFt,
+                       const AirspaceCostWeights& weights) const;
+
+private:
+    struct Bounds {
+        double south = std::numeric_limits<double>::infinity();
+        double west = std::numeric_limits<double>::infinity();
+        double north = -std::numeric_limits<double>::infinity();
+        double east = -std::numeric_limits<double>::infinity();
+
+        void expand(double latitude, double longitude);
+        void expand(const Bounds& other);
+        bool overlaps(const Bounds& other) const {
+            return south <= other.north && other.south <= north && west <= other.east && other.west <= east;
+        }
+    };
+
+    // a -> b in (latitude, longitude); slope is dLon/dLat, 0 for an east-west edge
+    struct Edge {
+        double aLat, aLon;
+        double bLat, bLon;
+        double slope;
+        uint32_t firstBand;
+    };
+
+    struct Prepared {
+        AirspaceVolume volume;
+        Bounds bounds;
+        std::vector<Edge> edges;
+        std::vector<uint32_t> bandStart;   // bandCount + 1 offsets into bandEdges
+        std::vector<uint32_t> bandEdges;
+        double bandHeight = 0.0;
+    };
+
+    // Children are nodes_[first, first + count), or entries_ for a leaf
+    struct Node {
+        Bounds bounds;
+        uint32_t first;
+        uint32_t count;
+        bool leaf;
+    };
+
+    static void prepare(Prepared& prepared);
+    static uint32_t bandOf(const Prepared& prepared, double latitude);
+    bool containsPrepared(const Prepared& prepared, double latitude, double longitude) const;
+    bool crossVolume(const Prepared& prepared, const Position& from, const Position& to,
+                     AirspaceCrossing& crossing) const;
+
+    // fn(id) for every volume whose bounds overlap box
+    template <typename Fn>
+    void forEachCandidate(const Bounds& box, Fn&& fn) const;
+
+    std::vector<Prepared> volumes_;
+    std::vector<uint32_t> entries_;        // volume ids in leaf order
+    std::vector<Node> nodes_;              // root last
+};
+
+} // namespace AICopilot
+
+#endif // AIRSPACE_DATABASE_HPP
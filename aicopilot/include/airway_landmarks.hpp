@@ -0,0 +1,106 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Airway Landmarks - ALT lower bounds for repeated airway route searches
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef AIRWAY_LANDMARKS_HPP
+#define AIRWAY_LANDMARKS_HPP
+
+#include "navdata_pack.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+
+/*
+ * On-disk layout (little-endian): the header, then per band the altitude
+ * range, the landmark nodes and the distance table, then an FNV-1a 64
+ * checksum of everything before it. The file belongs to one pack and is
+ * rejected for any other.
+ */
+struct AirwayLandmarksHeader {
+    char magic[4];                 // "ANLM"
+    uint16_t version;
+    uint16_t landmarkCount;        // per band
+    uint32_t bandCount;
+    uint32_t waypointCount;
+    uint64_t packChecksum;         // NavdataPack::getChecksum() of the pack it was built for
+};
+
+static_assert(sizeof(AirwayLandmarksHeader) == 24, "AirwayLandmarksHeader layout");
+
+/**
+ * Landmark distance tables for A* over a navdata pack (ALT)
+ *
+ * For a few landmark fixes the exact airway distance to every node is
+ * precomputed, once per pack, and the triangle inequality then bounds the
+ * remaining distance of a search far more tightly than the great circle,
+ * so point-to-point queries settle a small part of the graph. The airways
+ * usable at an altitude differ, so each altitude band gets its own tables;
+ * a band covers every altitude at which exactly the same airways are
+ * valid. Immutable once built or loaded; concurrent searches are safe.
+ */
+class AirwayLandmarks {
+public:
+    static constexpr char MAGIC[4] = {'A', 'N', 'L', 'M'};
+    static constexpr uint16_t VERSION = 1;
+    static constexpr size_t DEFAULT_LANDMARK_COUNT = 8;
+    static constexpr size_t MAX_LANDMARK_COUNT = 32;
+
+    struct Band {
+        int32_t lowAltitude;
+        int32_t highAltitude;
+        std::vector<uint32_t> landmarks;
+        std::vector<float> distances;   // [node * landmarkCount + landmark], infinity if unreachable
+    };
+
+    // Landmark file stored next to a pack file
+    static std::string pathFor(const std::string& packPath) { return packPath + ".alt"; }
+
+    /**
+     * Build tables for the bands containing the given altitudes
+     * @param pack Navdata pack to preprocess
+     * @param altitudes One altitude per band; altitudes in the same band share it
+     * @param landmarkCount Landmarks per band, at most MAX_LANDMARK_COUNT
+     * @return true if at least one band was built
+     */
+    bool build(const NavdataPack& pack, const std::vector<int>& altitudes,
+               size_t landmarkCount = DEFAULT_LANDMARK_COUNT);
+
+    bool save(const std::string& path) const;
+
+    /**
+     * Load tables and check that they were built for this pack
+     * @param path Landmark file
+     * @param pack Pack the tables will be used with
+     * @return true if the file is intact and matches the pack
+     */
+    bool load(const std::string& path, const NavdataPack& pack);
+
+    bool matches(const NavdataPack& pack) const;
+    size_t getLandmarkCount() const { return landmarkCount_; }
+    size_t getBandCount() const { return bands_.size(); }
+
+    // Band containing an altitude, nullptr if none was built
+    const Band* findBand(int altitude) const;
+
+private:
+    void buildBand(const NavdataPack& pack, Band& band) const;
+
+    uint64_t packChecksum_ = 0;
+    uint32_t waypointCount_ = 0;
+    size_t landmarkCount_ = 0;
+    std::vector<Band> bands_;
+};
+
+} // namespace AICopilot
+
+#endif // AIRWAY_LANDMARKS_HPP
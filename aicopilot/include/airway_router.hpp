@@ -25,6 +25,7 @@
 #ifndef AIRWAY_ROUTER_HPP
 #define AIRWAY_ROUTER_HPP
 
+#include "airspace_database.hpp"
 #include "navdata.h"
 #include <vector>
 #include <string>
@@ -154,7 +155,8 @@ public:
                                  const std::string& destination) const;
     
     /**
-     * Find all available routes between two waypoints
+     * Find the optimal route and distinct alternates between two waypoints,
+     * best first; a direct route fills a remaining slot
      * @param origin Starting waypoint
      * @param destination Destination waypoint
      * @param maxResults Maximum number of results to return
@@ -171,7 +173,7 @@ public:
      * @param destination Destination waypoint
      * @param preferredAirways List of preferred airways
      * @param cruiseAltitude Cruise altitude
-     * @return Route using preferred airways if possible
+     * @return Route using the preferred airways open at cruiseAltitude, if possible
      */
     std::vector<RouteSegment> FindPreferredRoute(
         const std::string& origin,
@@ -208,6 +210,22 @@ public:
      */
     void SetCruiseSpeed(double cruiseSpeedKts);
     
+    /**
+     * Set how different alternate routes must be
+     * @param minDissimilarity Fraction of its length (0-1) an alternate may not
+     *        share with a better route; default 0.3
+     */
+    void SetAlternateDissimilarity(double minDissimilarity);
+    
+    /**
+     * Price airway and direct legs through airspace
+     * @param airspace Volumes checked at the cruise altitude; nullptr ignores airspace
+     * @param weights Cost per NM inside each class, added to the leg length;
+     *        an infinite weight keeps routes out of the class
+     */
+    void SetAirspace(std::shared_ptr<const AirspaceDatabase> airspace,
+                     const AirspaceCostWeights& weights);
+    
     // ========================================================================
     // ROUTE ANALYSIS AND METRICS
     // ========================================================================
@@ -271,6 +289,9 @@ private:
     int minAltitudeConstraint_;
     int maxAltitudeConstraint_;
     double cruiseSpeedKts_;
+    double alternateDissimilarity_;
+    std::shared_ptr<const AirspaceDatabase> airspace_;
+    AirspaceCostWeights airspaceWeights_;
     
     // Pathfinding helpers
     std::vector<std::string> GetAdjacentWaypoints(const std::string& waypoint,
@@ -0,0 +1,158 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Airway Search - A* over a navdata pack's airway graph
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef AIRWAY_SEARCH_HPP
+#define AIRWAY_SEARCH_HPP
+
+#include "airspace_database.hpp"
+#include "airway_landmarks.hpp"
+#include "navdata_pack.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AICopilot {
+
+// Direct (off-airway) leg joining the origin or destination to the airway network
+struct AirwayDirectLeg {
+    uint32_t node;
+    double distanceNM;
+};
+
+struct AirwaySearchRequest {
+    uint32_t origin = NavdataPack::NO_INDEX;
+    uint32_t destination = NavdataPack::NO_INDEX;
+    int cruiseAltitude = 0;              // airways not valid at this altitude are skipped
+    std::vector<AirwayDirectLeg> entries;  // origin -> fix
+    std::vector<AirwayDirectLeg> exits;    // fix -> destination
+    double directRadiusNM = 0.0;         // if > 0, also direct legs to any usable waypoint this close
+    double directPenalty = 1.0;          // cost multiplier for direct legs, >= 1
+    const AirwayLandmarks* landmarks = nullptr;  // tighter bounds, if built for this pack
+    const AirspaceDatabase* airspace = nullptr;  // adds segmentCost() at cruiseAltitude to every leg
+    AirspaceCostWeights airspaceWeights;
+};
+
+// One fix of a found path, with the leg that reached it
+struct AirwayPathStep {
+    uint32_t node;
+    uint32_t airway;                     // NO_INDEX for the origin and for direct legs
+    double distanceNM;                   // leg length; 0 for the origin
+};
+
+/**
+ * Reusable search state
+ *
+ * Per-node records are stamped with a search generation, so starting a
+ * search clears nothing; the arrays only grow when a larger pack is
+ * searched. The open set is an indexed 4-ary heap with decrease-key.
+ * One workspace serves one search at a time; forThisThread() hands each
+ * thread its own.
+ */
+class AirwaySearchWorkspace {
+public:
+    static AirwaySearchWorkspace& forThisThread();
+
+private:
+    friend class AirwaySearch;
+
+    static constexpr uint32_t NOT_QUEUED = 0xFFFFFFFFu;
+
+    struct NodeState {
+        uint32_t stamp = 0;
+        uint32_t exitStamp = 0;
+        uint32_t heapPosition = NOT_QUEUED;
+        uint32_t parent = NavdataPack::NO_INDEX;
+        uint32_t airway = NavdataPack::NO_INDEX;
+        double g = 0.0;
+        double legNM = 0.0;
+        double exitNM = 0.0;         // direct leg to the destination, when exitStamp is current
+    };
+    struct HeapEntry {
+        double f;
+        uint32_t node;
+    };
+
+    void begin(size_t nodeCount);
+    NodeState& touch(uint32_t node);  // resets the record on first use this search
+
+    void push(uint32_t node, double f);
+    void decrease(uint32_t node, double f);
+    uint32_t pop();
+    void siftUp(size_t position);
+    void siftDown(size_t position);
+
+    std::vector<NodeState> nodes_;
+    std::vector<HeapEntry> heap_;
+    std::vector<WaypointIndex::Match> nearby_;  // direct leg candidates
+    std::vector<double> landmarkLow_;            // per landmark, see AirwaySearch::findPath
+    std::vector<double> landmarkHigh_;
+    std::vector<float> edgePenalty_;             // cost multiplier per pack edge, alternatives only
+    std::vector<uint32_t> penalizedEdges_;       // entries of edgePenalty_ not at 1
+    uint32_t generation_ = 0;
+};
+
+/**
+ * A* over the CSR airway graph of a navdata pack
+ *
+ * Nodes and edges are the pack's integer waypoint and edge records, and the
+ * heuristic is the great-circle distance to the destination, which never
+ * overestimates because every leg costs at least its great-circle length.
+ * With landmark tables for the cruise altitude band the heuristic also
+ * takes the ALT bound, unless direct legs between arbitrary waypoints are
+ * allowed, since those are not part of the precomputed graph. Airspace
+ * costs only add to legs, so both bounds stay admissible; legs with an
+ * infinite airspace cost are never taken.
+ * No strings are touched during the search.
+ */
+class AirwaySearch {
+public:
+    /**
+     * Find the cheapest path
+     * @param pack Navdata pack to search
+     * @param request Endpoints, altitude and direct legs
+     * @param path Output, origin first
+     * @param workspace Search state to reuse
+     * @return true if a path was found
+     */
+    static bool findPath(const NavdataPack& pack, const AirwaySearchRequest& request,
+                         std::vector<AirwayPathStep>& path,
+                         AirwaySearchWorkspace& workspace = AirwaySearchWorkspace::forThisThread());
+
+    /**
+     * Find distinct routes, cheapest first, by the penalty method: after each
+     * search the airway legs of the route found cost more, so the next search
+     * on the same workspace moves off them. A route is kept only if enough
+     * of its length is new compared to every route kept before it.
+     * @param pack Navdata pack to search
+     * @param request Endpoints, altitude and direct legs
+     * @param count Maximum number of routes
+     * @param minDissimilarity Fraction of its length, 0..1, a route may not share with a kept route
+     * @param paths Output routes, the optimal one first
+     * @param workspace Search state to reuse
+     * @return Number of routes found
+     */
+    static size_t findAlternatives(const NavdataPack& pack, const AirwaySearchRequest& request,
+                                   size_t count, double minDissimilarity,
+                                   std::vector<std::vector<AirwayPathStep>>& paths,
+                                   AirwaySearchWorkspace& workspace = AirwaySearchWorkspace::forThisThread());
+
+    // Great-circle distance between two pack nodes
+    static double distanceNM(const NavdataPack& pack, uint32_t from, uint32_t to);
+
+private:
+    static bool search(const NavdataPack& pack, const AirwaySearchRequest& request,
+                       std::vector<AirwayPathStep>& path, AirwaySearchWorkspace& workspace,
+                       bool penalized);
+};
+
+} // namespace AICopilot
+
+#endif // AIRWAY_SEARCH_HPP
@@ -0,0 +1,73 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Allocation Tracker - per-thread heap allocation counters for tests and
+* benchmarks
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef ALLOCATION_TRACKER_HPP
+#define ALLOCATION_TRACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace AICopilot {
+
+struct AllocationCounts {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t bytes = 0;          // requested by allocations
+};
+
+/**
+ * Heap allocation counters, per thread and for the whole process
+ *
+ * The library only keeps the counters. An executable that links
+ * allocation_hooks.cpp replaces the global operator new and delete with
+ * versions that bump them, so a test or benchmark can assert that a hot
+ * path allocates nothing in steady state. Production binaries do not link
+ * the hooks: the counters stay zero and isInstalled() reports false.
+ */
+class AllocationTracker {
+public:
+    static bool isInstalled();
+
+    static AllocationCounts thisThread();
+    static AllocationCounts process();
+
+    // Called by the hooks only; must not allocate
+    static void markInstalled();
+    static void recordAllocation(size_t bytes);
+    static void recordDeallocation();
+};
+
+/**
+ * Counts the calling thread's allocations from construction on
+ *
+ *   AllocationScope scope;
+ *   traffic.checkTrafficConflicts(&arena);
+ *   EXPECT_EQ(scope.allocations(), 0u);
+ */
+class AllocationScope {
+public:
+    AllocationScope() : start_(AllocationTracker::thisThread()) {}
+
+    AllocationCounts counts() const;
+    uint64_t allocations() const { return counts().allocations; }
+    uint64_t bytes() const { return counts().bytes; }
+
+    // Start counting again from now
+    void restart() { start_ = AllocationTracker::thisThread(); }
+
+private:
+    AllocationCounts start_;
+};
+
+} // namespace AICopilot
+
+#endif // ALLOCATION_TRACKER_HPP
@@ -90,6 +90,49 @@ struct ApproachStatus {
     bool stabilized;
 };
 
+/**
+ * Approach geometry precomputed by loadApproach
+ *
+ * Everything sits in a flat-earth frame centred on the runway threshold,
+ * east and north in nautical miles; an approach stays well inside
+ * Geodesy::FLAT_EARTH_MAX_NM of it. A tick projects the aircraft into the
+ * frame once, after which along-track distance, cross-track error and the
+ * glidepath height are dot products and multiply-adds.
+ */
+struct ApproachGeometry {
+    // Leg i ends at waypoint i; leg 0 is flown direct from wherever the aircraft is
+    struct Leg {
+        double startEast = 0.0;        // nautical miles from the threshold
+        double startNorth = 0.0;
+        double unitEast = 0.0;         // course unit vector; zero for leg 0
+        double unitNorth = 0.0;
+        double endEast = 0.0;
+        double endNorth = 0.0;
+        double length = 0.0;           // nautical miles; the along-track distance that sequences the leg
+        double distanceAfter = 0.0;    // nautical miles from the leg's end to the threshold along the route
+        double course = 0.0;           // degrees true
+        double startAltitude = 0.0;    // feet MSL on the vertical path at the leg start
+        double gradient = 0.0;         // feet per nautical mile along the leg
+    };
+
+    double originLatitude = 0.0;
+    double originLongitude = 0.0;
+    double eastPerDegree = 0.0;        // nautical miles per degree of longitude at the threshold
+    double thresholdAltitude = 0.0;    // feet MSL
+
+    // Final approach course, inbound
+    double courseEast = 0.0;
+    double courseNorth = 1.0;
+
+    // Glidepath plane: altitude = thresholdAltitude + glidepathGradient * distance
+    double glidepathGradient = 0.0;    // feet per nautical mile
+
+    std::vector<Leg> legs;
+
+    bool hasMissedApproachPoint = false;
+    double missedApproachDistance = 0.0;  // nautical miles before the threshold
+};
+
 /**
  * Advanced Approach Procedures System
  */
@@ -97,11 +140,14 @@ class ApproachSystem {
 public:
     ApproachSystem() = default;
     
-    // Load approach procedure
+    // Load approach procedure and precompute its geometry
     bool loadApproach(const ApproachProcedure& approach);
     
     // Get current approach
-    ApproachProcedure getCurrentApproach() const { return currentApproach_; }
+    const ApproachProcedure& getCurrentApproach() const { return currentApproach_; }
+    
+    // Geometry built from the current approach
+    const ApproachGeometry& getGeometry() const { return geometry_; }
     
     // Activate approach
     void activateApproach();
@@ -124,7 +170,7 @@ public:
     // Check if approach is stabilized
     bool isStabilized(const AircraftState& state) const;
     
-    // Calculate ILS deviation
+    // Calculate ILS deviation from position; dots are positive right of course and above the glidepath
     void calculateILSDeviation(
         const Position& pos,
         double heading,
@@ -144,6 +190,9 @@ public:
     // Get next waypoint
     RNAVWaypoint getNextWaypoint() const;
     
+    // Index of the waypoint being flown to
+    size_t getActiveWaypointIndex() const { return activeWaypointIndex_; }
+    
     // Advance to next waypoint
     void advanceWaypoint();
     
@@ -156,7 +205,7 @@ public:
     // Calculate vertical path for RNP
     double calculateVerticalPath(const Position& pos) const;
     
-    // Get distance to threshold
+    // Get distance to threshold along the approach, nautical miles
     double getDistanceToThreshold(const Position& pos) const;
     
     // Get height above threshold
@@ -169,8 +218,9 @@ private:
     ApproachProcedure currentApproach_;
     bool approachActive_ = false;
     ApproachPhase currentPhase_ = ApproachPhase::INITIAL;
-    ApproachStatus status_;
+    ApproachStatus status_{};
     size_t activeWaypointIndex_ = 0;
+    ApproachGeometry geometry_;
     
     // Stabilized approach criteria
     static constexpr double MAX_LOCALIZER_DEVIATION = 1.0;  // dots
@@ -178,11 +228,24 @@ private:
     static constexpr double MAX_AIRSPEED_DEVIATION = 10.0;   // knots
     static constexpr double MAX_SINK_RATE = 1000.0;          // fpm
     
+    static constexpr double LOCALIZER_DEGREES_PER_DOT = 1.0;
+    static constexpr double GLIDESLOPE_FEET_PER_DOT = 100.0;
+    
+    // Position in the threshold frame, nautical miles
+    struct FramePoint {
+        double east;
+        double north;
+    };
+    
     // Helper methods
-    void updatePhase(const Position& pos);
-    double calculateLocalizerDeviation(const Position& pos, double heading) const;
-    double calculateGlideslopeDeviation(const Position& pos, double altitude) const;
-    bool isWithinLimits(const AircraftState& state) const;
+    void buildGeometry();
+    FramePoint toFrame(const Position& pos) const;
+    double distanceToThreshold(const FramePoint& point) const;
+    double alongTrack(size_t leg, const FramePoint& point) const;
+    void sequenceWaypoints(const FramePoint& point);
+    void updatePhase(double distance);
+    double calculateLocalizerDeviation(const FramePoint& point, double distance) const;
+    double calculateGlideslopeDeviation(double distance, double altitude) const;
 };
 
 } // namespace AICopilot
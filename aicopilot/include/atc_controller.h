@@ -13,7 +13,15 @@
 #include "aicopilot_types.h"
 #include "simconnect_wrapper.h"
 #include "ollama_client.h"
+#include "ollama_gateway.hpp"
+#include "atc_decision_cache.hpp"
+#include "atc_phraseology.hpp"
+#include "clearance_log.hpp"
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <queue>
 
@@ -30,11 +38,7 @@ class AirportOperationSystem;
  */
 class ATCController {
 public:
-    struct ParsedInstruction {
-        std::optional<double> target_altitude_feet;
-        std::optional<double> target_heading_degrees;
-        std::optional<double> target_speed_knots;
-    };
+    using ParsedInstruction = ParsedClearance;
 
     ATCController(std::shared_ptr<SimConnectWrapper> simConnect);
     ~ATCController();
@@ -63,6 +67,15 @@ public:
     // Get pending instructions
     std::vector<std::string> getPendingInstructions() const;
     
+    // Every clearance received, as compact events, and the state they add up to
+    const ClearanceLog& getClearanceLog() const { return clearanceLog_; }
+    ClearanceSnapshot getClearanceState() const { return clearanceLog_.current(); }
+    
+    // Resume from a checkpoint: clearances so far (see ClearanceLog::restore),
+    // the last clearance text and the instructions still pending
+    bool restoreClearances(const ClearanceSnapshot& base, const ClearanceEvent* events, size_t eventCount,
+                           const std::string& lastClearance, std::vector<std::string> pendingInstructions);
+    
     // Check if waiting for ATC response
     bool isWaitingForATC() const;
     
@@ -81,20 +94,59 @@ public:
     // Set Ollama API key (optional, for enterprise/cloud deployments)
     void setOllamaApiKey(const std::string& apiKey);
     
+    // How long a menu waits for Ollama before the rule-based choice is sent
+    void setOllamaDeadline(std::chrono::milliseconds deadline) { ollamaDeadline_ = deadline; }
+    std::chrono::milliseconds getOllamaDeadline() const { return ollamaDeadline_; }
+    
+    // Menus waiting for an Ollama selection
+    size_t getPendingSelectionCount() const { return pendingSelections_.size(); }
+    
+    // Ollama choices reused for repeated situations instead of asking again
+    ATCDecisionCacheStats getDecisionCacheStats() const { return decisionCache_.getStats(); }
+    
+    // Also reuse choices from similar situations (0 < threshold <= 1; 0 = exact matches only)
+    void setDecisionSimilarityThreshold(double threshold) { decisionCache_.setSimilarityThreshold(threshold); }
+    
+    // Route Ollama selections through a gateway shared with other pilots
+    // instead of this controller's own client; nullptr reverts to the client
+    void setOllamaGateway(std::shared_ptr<OllamaGateway> gateway, uint32_t pilotId);
+    
 private:
     std::shared_ptr<SimConnectWrapper> simConnect_;
     std::unique_ptr<OllamaClient> ollamaClient_;
-    FlightPhase currentPhase_;
+    std::shared_ptr<OllamaGateway> ollamaGateway_;
+    uint32_t gatewayPilotId_ = 0;
+    std::atomic<FlightPhase> currentPhase_;  // set by the control loop, read by update()
     FlightPlan flightPlan_;
-    std::queue<ATCMessage> messageQueue_;
+    std::queue<ATCMessage> messageQueue_;  // filled from the SimConnect dispatch thread
+    std::mutex messageQueueMutex_;
     std::vector<std::string> pendingInstructions_;
     std::string lastClearance_;
-    bool waitingForResponse_;
+    ClearanceLog clearanceLog_;
+    std::chrono::steady_clock::time_point clearanceLogStart_ = std::chrono::steady_clock::now();
+    int lastGroundState_ = -1;
+    std::atomic<bool> waitingForResponse_;
     bool ollamaEnabled_;
     Integration::AirportOperationSystem* airportOps_;
     
-    // AI decision making for ATC menu selection
-    int selectBestMenuOption(const ATCMessage& message);
+    // Menus answered in arrival order; update() never waits on Ollama
+    struct PendingSelection {
+        ATCMessage message;
+        std::shared_ptr<OllamaSelection> selection;
+        std::string phase;          // flight phase when the menu arrived
+        bool fromCache = false;
+    };
+    std::deque<PendingSelection> pendingSelections_;
+    std::chrono::milliseconds ollamaDeadline_{2000};
+    ATCDecisionCache decisionCache_;
+    
+    // Start an Ollama selection for a menu
+    std::shared_ptr<OllamaSelection> requestOllamaSelection(const ATCMessage& message);
+    static LLMPriority selectionPriority(const ATCMessage& message);
+    
+    // Send the menus at the front whose selection is done or overdue
+    void resolvePendingSelections();
+    void sendMenuSelection(const ATCMessage& message, int option);
     
     // Rule-based menu selection (fallback)
     int selectBestMenuOptionRuleBased(const ATCMessage& message);
@@ -103,6 +155,7 @@ private:
     void parseInstruction(const std::string& instruction);
     void handleInstruction(const std::string& instruction);
     void applyParsedInstruction(const ParsedInstruction& instruction, const std::string& originalText);
+    void logClearance(ClearanceEventType type, int32_t value = 0);
     
     // Context analysis
     bool isRelevantForPhase(const std::string& option, FlightPhase phase);
@@ -0,0 +1,111 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef ATC_DECISION_CACHE_HPP
+#define ATC_DECISION_CACHE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AICopilot {
+
+struct ATCDecisionCacheStats {
+    uint64_t exactHits = 0;
+    uint64_t similarHits = 0;
+    uint64_t misses = 0;
+    size_t entries = 0;
+
+    double hitRate() const {
+        uint64_t lookups = exactHits + similarHits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(exactHits + similarHits) / lookups;
+    }
+};
+
+/**
+ * LRU cache of LLM menu choices, so a repeated ATC situation skips Ollama
+ *
+ * A situation is the flight phase, the ATC message and the menu options,
+ * each normalized: lower case, punctuation dropped, whitespace collapsed
+ * and every number replaced by '#', since "taxi to runway 04" and "taxi
+ * to runway 22" call for the same choice. The cached answer is the option
+ * index, which carries over to any menu of the same shape.
+ *
+ * The exact tier matches the normalized key. The optional similarity tier
+ * (setSimilarityThreshold) falls back to the closest cached situation in
+ * the same phase with the same number of options, comparing the message
+ * and each option position by cosine similarity of hashed character
+ * trigram vectors; the weakest of those similarities must reach the
+ * threshold. It scans every candidate, which is cheap at the capacities
+ * used here next to an LLM round trip.
+ *
+ * Not thread-safe; ATCController uses it from update() only.
+ */
+class ATCDecisionCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+    static constexpr size_t EMBEDDING_DIMENSIONS = 64;
+
+    explicit ATCDecisionCache(size_t capacity = DEFAULT_CAPACITY) : capacity_(capacity) {}
+
+    // Minimum similarity for the similarity tier, 0 < threshold <= 1; 0 disables it
+    void setSimilarityThreshold(double threshold) { similarityThreshold_ = threshold; }
+    double getSimilarityThreshold() const { return similarityThreshold_; }
+
+    // Cached option index for the situation; counts a hit or miss
+    std::optional<int> lookup(const std::string& phase, const std::string& message,
+                              const std::vector<std::string>& options);
+
+    // Remember the option chosen for a situation
+    void store(const std::string& phase, const std::string& message,
+               const std::vector<std::string>& options, int option);
+
+    void clear();
+    size_t size() const { return entries_.size(); }
+
+    ATCDecisionCacheStats getStats() const;
+    void resetStats();
+
+    static std::string normalize(const std::string& text);
+
+private:
+    using Embedding = std::array<float, EMBEDDING_DIMENSIONS>;
+
+    struct Entry {
+        std::string key;
+        std::string phase;
+        std::vector<Embedding> embeddings;   // message, then each option
+        int option = -1;
+    };
+
+    static std::string makeKey(const std::string& phase, const std::string& message,
+                               const std::vector<std::string>& options);
+    static std::vector<Embedding> embedSituation(const std::string& message,
+                                                 const std::vector<std::string>& options);
+    static Embedding embed(const std::string& normalized);
+    static float cosine(const Embedding& a, const Embedding& b);
+
+    std::list<Entry> entries_;   // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    size_t capacity_;
+    double similarityThreshold_ = 0.0;
+
+    uint64_t exactHits_ = 0;
+    uint64_t similarHits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+} // namespace AICopilot
+
+#endif // ATC_DECISION_CACHE_HPP
@@ -0,0 +1,50 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* ATC Phraseology Parser - single-pass extraction of clearance values
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef ATC_PHRASEOLOGY_HPP
+#define ATC_PHRASEOLOGY_HPP
+
+#include <optional>
+#include <string_view>
+
+namespace AICopilot {
+
+// Values an ATC transmission assigns; anything not assigned stays empty
+struct ParsedClearance {
+    std::optional<double> target_altitude_feet;
+    std::optional<double> target_heading_degrees;
+    std::optional<double> target_speed_knots;
+    std::optional<double> frequency_mhz;
+    std::optional<int> squawk_code;     // four octal digits read as decimal, e.g. 7500
+};
+
+/**
+ * Table-driven parser for assigned altitude, heading, speed, frequency
+ * and squawk in ATC phraseology
+ *
+ * The lexer walks the text once, case-insensitively, classifying words
+ * against a fixed keyword table and folding numbers as controllers say
+ * them: written ("FL180", "118.3"), spoken digit by digit ("one two
+ * four point five", "niner", "tree", "fife") or grouped ("five thousand
+ * five hundred"). The parser is a state machine whose transitions come
+ * from a (state, keyword) table; a number arriving in an expecting state
+ * fills that state's slot when it is in range for it. "Maintain 250
+ * knots" is recognized by looking one token past the number.
+ *
+ * Works on string_view and allocates nothing, so it is cheap enough for
+ * every line of ATC text, including other aircraft's. The first value of
+ * each kind wins.
+ */
+ParsedClearance parseClearance(std::string_view text);
+
+} // namespace AICopilot
+
+#endif // ATC_PHRASEOLOGY_HPP
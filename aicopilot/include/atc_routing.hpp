@@ -10,6 +10,9 @@
 #include <vector>
 #include <limits>
 #include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
 
 // ============================================================================
 // PART 2: ATC GROUND ROUTING SYSTEMS
@@ -39,10 +42,25 @@ struct PathNode {
     }
 };
 
+// Edge lengths are declared, not derived from node positions, so an edge
+// may be shorter than the straight line between its ends. Scaling the
+// straight-line distance by the smallest length/straight-line ratio of the
+// network keeps distance-based A* heuristics admissible.
+inline double straight_line_scale(const TaxiwayNetwork& network) {
+    double scale = 1.0;
+    const int count = static_cast<int>(network.get_index_count());
+    for (int from = 0; from < count; ++from) {
+        if (!network.has_node_at(from)) continue;
+        for (const auto& arc : network.get_arcs_at(from)) {
+            if (!network.has_node_at(arc.to_index)) continue;
+            double straight = network.get_position_at(from).distance_to(network.get_position_at(arc.to_index));
+            if (straight > 0.0) scale = std::min(scale, std::max(arc.length_feet, 0.0) / straight);
+        }
+    }
+    return scale;
+}
+
 class GroundRouter {
-private:
-    const TaxiwayNetwork* taxiway_network;
-    
 public:
     struct RouteResult {
         bool success;
@@ -56,6 +74,122 @@ public:
                         estimated_time_seconds(0.0) {}
     };
     
+    // Reusable search state: per-node records over the network's dense
+    // indices, stamped with a search generation so nothing is cleared
+    // between searches, and an indexed binary heap keyed by f-score with
+    // decrease-key. One search at a time; for_this_thread() gives each
+    // thread its own.
+    class SearchWorkspace {
+    public:
+        static SearchWorkspace& for_this_thread() {
+            static thread_local SearchWorkspace workspace;
+            return workspace;
+        }
+        
+    private:
+        friend class GroundRouter;
+        
+        static constexpr int NOT_QUEUED = -1;
+        
+        struct NodeState {
+            uint32_t stamp = 0;
+            int heap_position = NOT_QUEUED;
+            int parent = -1;
+            int parent_edge = -1;
+            bool closed = false;
+            double g = 0.0;
+        };
+        struct HeapEntry {
+            double f;
+            int node;
+        };
+        
+        std::vector<NodeState> nodes;
+        std::vector<HeapEntry> heap;
+        uint32_t generation = 0;
+        
+        // Heuristic scale for the network last searched; see heuristic_scale()
+        const TaxiwayNetwork* scaled_network = nullptr;
+        uint64_t scaled_revision = 0;
+        double scale = 1.0;
+        
+        void begin(size_t node_count) {
+            if (nodes.size() < node_count) nodes.resize(node_count);
+            heap.clear();
+            if (++generation == 0) {
+                for (auto& node : nodes) node.stamp = 0;
+                generation = 1;
+            }
+        }
+        
+        NodeState& touch(int node) {
+            NodeState& state = nodes[node];
+            if (state.stamp != generation) {
+                state.stamp = generation;
+                state.heap_position = NOT_QUEUED;
+                state.parent = -1;
+                state.parent_edge = -1;
+                state.closed = false;
+                state.g = std::numeric_limits<double>::infinity();
+            }
+            return state;
+        }
+        
+        void push_or_decrease(int node, double f) {
+            NodeState& state = nodes[node];
+            if (state.heap_position == NOT_QUEUED) {
+                heap.push_back({f, node});
+                state.heap_position = static_cast<int>(heap.size() - 1);
+            } else {
+                heap[state.heap_position].f = f;
+            }
+            sift_up(static_cast<size_t>(state.heap_position));
+        }
+        
+        int pop() {
+            int top = heap.front().node;
+            nodes[top].heap_position = NOT_QUEUED;
+            HeapEntry last = heap.back();
+            heap.pop_back();
+            if (!heap.empty()) {
+                heap.front() = last;
+                nodes[last.node].heap_position = 0;
+                sift_down(0);
+            }
+            return top;
+        }
+        
+        void place(size_t position, const HeapEntry& entry) {
+            heap[position] = entry;
+            nodes[entry.node].heap_position = static_cast<int>(position);
+        }
+        
+        void sift_up(size_t position) {
+            HeapEntry entry = heap[position];
+            while (position > 0) {
+                size_t parent = (position - 1) / 2;
+                if (heap[parent].f <= entry.f) break;
+                place(position, heap[parent]);
+                position = parent;
+            }
+            place(position, entry);
+        }
+        
+        void sift_down(size_t position) {
+            HeapEntry entry = heap[position];
+            const size_t size = heap.size();
+            while (true) {
+                size_t child = position * 2 + 1;
+                if (child >= size) break;
+                if (child + 1 < size && heap[child + 1].f < heap[child].f) child++;
+                if (heap[child].f >= entry.f) break;
+                place(position, heap[child]);
+                position = child;
+            }
+            place(position, entry);
+        }
+    };
+    
     GroundRouter() : taxiway_network(nullptr) {}
     
     void set_taxiway_network(const TaxiwayNetwork* network) {
@@ -66,7 +200,46 @@ public:
     RouteResult find_shortest_path(
         int start_node_id,
         int end_node_id,
-        double max_aircraft_speed_knots = 15.0) const
+        double max_aircraft_speed_knots = 15.0,
+        SearchWorkspace& workspace = SearchWorkspace::for_this_thread()) const
+    {
+        return search(start_node_id, end_node_id, max_aircraft_speed_knots, false, workspace);
+    }
+    
+    // A* search for the quickest path at the given speed; the heuristic is
+    // the straight-line distance at that speed
+    RouteResult find_fastest_path(
+        int start_node_id,
+        int end_node_id,
+        const LatLonAlt& reference_point,
+        double max_aircraft_speed_knots = 15.0,
+        SearchWorkspace& workspace = SearchWorkspace::for_this_thread()) const
+    {
+        (void)reference_point;
+        return search(start_node_id, end_node_id, max_aircraft_speed_knots, true, workspace);
+    }
+    
+private:
+    const TaxiwayNetwork* taxiway_network;
+    
+    static constexpr double KNOTS_TO_FEET_PER_SECOND = 1.6878;
+    
+    // Recomputed only when the network changes
+    double heuristic_scale(SearchWorkspace& workspace) const {
+        if (workspace.scaled_network == taxiway_network &&
+            workspace.scaled_revision == taxiway_network->get_revision()) {
+            return workspace.scale;
+        }
+        workspace.scaled_network = taxiway_network;
+        workspace.scaled_revision = taxiway_network->get_revision();
+        workspace.scale = straight_line_scale(*taxiway_network);
+        return workspace.scale;
+    }
+    
+    // Shortest path by length (timed == false, plain Dijkstra) or by
+    // traversal time with an A* heuristic (timed == true)
+    RouteResult search(int start_node_id, int end_node_id, double max_aircraft_speed_knots,
+                       bool timed, SearchWorkspace& workspace) const
     {
         RouteResult result;
         
@@ -76,202 +249,84 @@ public:
         }
         
         // Validate start and end nodes
-        if (!taxiway_network->get_node_const(start_node_id) ||
-            !taxiway_network->get_node_const(end_node_id)) {
+        const int start = taxiway_network->get_node_index(start_node_id);
+        const int end = taxiway_network->get_node_index(end_node_id);
+        if (start < 0 || end < 0 || !taxiway_network->has_node_at(start) || !taxiway_network->has_node_at(end)) {
             result.error_message = "Invalid start or end node";
             return result;
         }
         
-        // Initialize distances and visited set
-        std::map<int, double> distances;
-        std::map<int, int> previous_node;
-        std::map<int, int> previous_edge;
-        std::set<int> visited;
+        using NodeState = SearchWorkspace::NodeState;
+        workspace.begin(taxiway_network->get_index_count());
         
-        // Get all nodes
-        auto all_node_ids = taxiway_network->get_all_node_ids();
-        for (int node_id : all_node_ids) {
-            distances[node_id] = std::numeric_limits<double>::infinity();
+        const LatLonAlt& goal = taxiway_network->get_position_at(end);
+        double seconds_per_foot = 0.0;
+        if (timed) {
+            double speed = max_aircraft_speed_knots * KNOTS_TO_FEET_PER_SECOND;
+            seconds_per_foot = speed > 0.0 ? heuristic_scale(workspace) / speed : 0.0;
         }
-        distances[start_node_id] = 0.0;
+        auto heuristic = [&](int node) {
+            if (!timed || !taxiway_network->has_node_at(node)) return 0.0;
+            return taxiway_network->get_position_at(node).distance_to(goal) * seconds_per_foot;
+        };
         
-        // Priority queue: (distance, node_id)
-        std::priority_queue<PathNode, std::vector<PathNode>, std::greater<PathNode>> pq;
-        pq.push(PathNode(start_node_id, 0.0));
+        NodeState& origin = workspace.touch(start);
+        origin.g = 0.0;
+        workspace.push_or_decrease(start, heuristic(start));
         
-        // Dijkstra main loop
-        while (!pq.empty()) {
-            PathNode current = pq.top();
-            pq.pop();
-            
-            if (visited.count(current.node_id)) continue;
-            visited.insert(current.node_id);
-            
-            if (current.node_id == end_node_id) {
-                // Reconstruct path
-                result.success = true;
-                int node = end_node_id;
-                double total_time = 0.0;
-                
-                while (node != start_node_id) {
-                    result.path_node_ids.push_back(node);
-                    int edge_id = previous_edge[node];
-                    result.path_edge_ids.push_back(edge_id);
-                    
-                    const TaxiwayEdge* edge = taxiway_network->get_edge(edge_id);
-                    if (edge) {
-                        result.total_distance_feet += edge->length_feet;
-                        total_time += edge->calculate_traversal_time_seconds(max_aircraft_speed_knots);
-                    }
-                    
-                    node = previous_node[node];
-                }
-                result.path_node_ids.push_back(start_node_id);
-                result.estimated_time_seconds = total_time;
-                
-                // Reverse to get correct order
-                std::reverse(result.path_node_ids.begin(), result.path_node_ids.end());
-                std::reverse(result.path_edge_ids.begin(), result.path_edge_ids.end());
-                
-                return result;
+        bool found = false;
+        while (!workspace.heap.empty()) {
+            const int current = workspace.pop();
+            if (current == end) {
+                found = true;
+                break;
             }
+            NodeState& state = workspace.nodes[current];
+            state.closed = true;
             
-            // Explore neighbors
-            const auto& adjacent_edges = taxiway_network->get_adjacent_edges(current.node_id);
-            
-            for (int edge_id : adjacent_edges) {
-                const TaxiwayEdge* edge = taxiway_network->get_edge(edge_id);
-                if (!edge) continue;
-                
-                int neighbor_id = edge->to_node_id;
-                if (visited.count(neighbor_id)) continue;
-                
-                double new_distance = distances[current.node_id] + edge->length_feet;
-                
-                if (new_distance < distances[neighbor_id]) {
-                    distances[neighbor_id] = new_distance;
-                    previous_node[neighbor_id] = current.node_id;
-                    previous_edge[neighbor_id] = edge_id;
-                    
-                    pq.push(PathNode(neighbor_id, new_distance));
+            for (const auto& arc : taxiway_network->get_arcs_at(current)) {
+                double cost = arc.length_feet;
+                if (timed) {
+                    double speed = std::min(arc.max_speed_knots, max_aircraft_speed_knots);
+                    if (speed < 1.0) continue;  // impassable at this speed
+                    cost = arc.length_feet / (speed * KNOTS_TO_FEET_PER_SECOND);
                 }
+                
+                NodeState& next = workspace.touch(arc.to_index);
+                if (next.closed) continue;
+                double tentative_g = state.g + cost;
+                if (tentative_g >= next.g) continue;
+                next.g = tentative_g;
+                next.parent = current;
+                next.parent_edge = arc.edge_id;
+                workspace.push_or_decrease(arc.to_index, tentative_g + heuristic(arc.to_index));
             }
         }
         
-        result.error_message = "No path found between nodes";
-        return result;
-    }
-    
-    // A* search (optimized for when destination is known)
-    RouteResult find_fastest_path(
-        int start_node_id,
-        int end_node_id,
-        const LatLonAlt& reference_point,
-        double max_aircraft_speed_knots = 15.0) const
-    {
-        // Similar to Dijkstra but with heuristic function
-        // h(n) = straight-line distance to goal / max_speed
-        
-        const TaxiwayNode* end_node = taxiway_network->get_node_const(end_node_id);
-        if (!end_node) {
-            RouteResult result;
-            result.error_message = "End node not found";
+        if (!found) {
+            result.error_message = timed ? "No path found (A*)" : "No path found between nodes";
             return result;
         }
         
-        auto heuristic = [&](int node_id) -> double {
-            const TaxiwayNode* node = taxiway_network->get_node_const(node_id);
-            if (!node) return 0.0;
-            double dist = node->position.distance_to(end_node->position);
-            double max_speed_ft_per_s = max_aircraft_speed_knots * 1.6878;
-            return dist / max_speed_ft_per_s;
-        };
-        
-        // A* implementation similar to Dijkstra with f(n) = g(n) + h(n)
-        std::map<int, double> g_scores;  // Cost from start
-        std::map<int, double> f_scores;  // g + h
-        
-        auto all_node_ids = taxiway_network->get_all_node_ids();
-        for (int node_id : all_node_ids) {
-            g_scores[node_id] = std::numeric_limits<double>::infinity();
-            f_scores[node_id] = std::numeric_limits<double>::infinity();
-        }
-        
-        g_scores[start_node_id] = 0.0;
-        f_scores[start_node_id] = heuristic(start_node_id);
-        
-        std::map<int, int> came_from;
-        std::map<int, int> came_from_edge;
-        std::set<int> open_set, closed_set;
-        open_set.insert(start_node_id);
-        
-        while (!open_set.empty()) {
-            // Find node with lowest f_score
-            int current = *open_set.begin();
-            double min_f = f_scores[current];
-            
-            for (int node : open_set) {
-                if (f_scores[node] < min_f) {
-                    min_f = f_scores[node];
-                    current = node;
-                }
-            }
+        // Reconstruct path
+        result.success = true;
+        for (int node = end; node != start; node = workspace.nodes[node].parent) {
+            result.path_node_ids.push_back(taxiway_network->get_node_id_at(node));
+            int edge_id = workspace.nodes[node].parent_edge;
+            result.path_edge_ids.push_back(edge_id);
             
-            if (current == end_node_id) {
-                // Reconstruct path
-                RouteResult result;
-                result.success = true;
-                
-                int node = end_node_id;
-                while (came_from.count(node)) {
-                    result.path_node_ids.push_back(node);
-                    int edge_id = came_from_edge[node];
-                    result.path_edge_ids.push_back(edge_id);
-                    
-                    const TaxiwayEdge* edge = taxiway_network->get_edge(edge_id);
-                    if (edge) {
-                        result.total_distance_feet += edge->length_feet;
-                        result.estimated_time_seconds += edge->calculate_traversal_time_seconds(max_aircraft_speed_knots);
-                    }
-                    
-                    node = came_from[node];
-                }
-                result.path_node_ids.push_back(start_node_id);
-                
-                std::reverse(result.path_node_ids.begin(), result.path_node_ids.end());
-                std::reverse(result.path_edge_ids.begin(), result.path_edge_ids.end());
-                
-                return result;
-            }
-            
-            open_set.erase(current);
-            closed_set.insert(current);
-            
-            const auto& neighbors = taxiway_network->get_adjacent_edges(current);
-            for (int edge_id : neighbors) {
-                const TaxiwayEdge* edge = taxiway_network->get_edge(edge_id);
-                if (!edge) continue;
-                
-                int neighbor = edge->to_node_id;
-                if (closed_set.count(neighbor)) continue;
-                
-                double tentative_g = g_scores[current] + edge->length_feet;
-                
-                if (tentative_g < g_scores[neighbor]) {
-                    came_from[neighbor] = current;
-                    came_from_edge[neighbor] = edge_id;
-                    g_scores[neighbor] = tentative_g;
-                    f_scores[neighbor] = g_scores[neighbor] + heuristic(neighbor);
-                    
-                    if (!open_set.count(neighbor)) {
-                        open_set.insert(neighbor);
-                    }
-                }
+            const TaxiwayEdge* edge = taxiway_network->get_edge(edge_id);
+            if (edge) {
+                result.total_distance_feet += edge->length_feet;
+                result.estimated_time_seconds += edge->calculate_traversal_time_seconds(max_aircraft_speed_knots);
             }
         }
+        result.path_node_ids.push_back(start_node_id);
+        
+        // Reverse to get correct order
+        std::reverse(result.path_node_ids.begin(), result.path_node_ids.end());
+        std::reverse(result.path_edge_ids.begin(), result.path_edge_ids.end());
         
-        RouteResult result;
-        result.error_message = "No path found (A*)";
         return result;
     }
 };
@@ -677,12 +732,21 @@ struct SequencedAircraft {
           state(ClearanceStateMachine::ClearanceState::Idle) {}
 };
 
+// Departures leave in request order. Arrivals are ordered by ETA (ties in
+// request order) and each holds a landing slot: the later of its ETA and
+// the slot ahead plus the runway's separation, the first slot counting
+// from the last landing. Slots are kept in that order and never closer
+// than the separation by construction. A new, changed or removed ETA
+// re-slots only from its place in the order until a slot comes out
+// unchanged, since every later slot depends only on the one before it.
 class ATCSequencer {
 private:
+    using ArrivalKey = std::pair<double, int>;     // ETA, sequence number
+    
     struct RunwayQueue {
         int runway_id;
         std::deque<int> departure_queue;    // Aircraft IDs
-        std::deque<int> arrival_queue;
+        std::map<ArrivalKey, SequencedAircraft*> arrival_order;
         double last_departure_time;
         double last_arrival_time;
         double minimum_separation_seconds;
@@ -692,22 +756,55 @@ private:
               minimum_separation_seconds(60.0) {}
     };
     
+    struct Arrival {
+        int runway_id;
+        ArrivalKey key;
+    };
+    
     std::map<int, RunwayQueue> runway_queues;
     std::map<int, ClearanceStateMachine> aircraft_clearances;
     std::map<int, SequencedAircraft> sequence_table;
+    std::map<int, Arrival> arrivals;                // queued arrivals by aircraft ID
     int next_sequence_number;
     
+    // Re-slot arrivals from the first key >= from; stop at the first unchanged slot past through
+    static void reslot_arrivals(RunwayQueue& queue, const ArrivalKey& from, const ArrivalKey& through) {
+        auto it = queue.arrival_order.lower_bound(from);
+        double previous = queue.last_arrival_time;
+        if (it != queue.arrival_order.begin()) {
+            previous = std::prev(it)->second->estimated_execution_time;
+        }
+        for (; it != queue.arrival_order.end(); ++it) {
+            SequencedAircraft& aircraft = *it->second;
+            double slot = std::max(it->first.first, previous + queue.minimum_separation_seconds);
+            if (slot == aircraft.estimated_execution_time && through < it->first) break;
+            aircraft.estimated_execution_time = slot;
+            previous = slot;
+        }
+    }
+    
 public:
     ATCSequencer() : next_sequence_number(1) {}
     
+    // Registering a runway again empties its queues
     void register_runway(int runway_id) {
+        auto it = runway_queues.find(runway_id);
+        if (it != runway_queues.end()) {
+            while (!it->second.arrival_order.empty()) {
+                cancel_arrival(it->second.arrival_order.begin()->second->aircraft_id);
+            }
+        }
         runway_queues[runway_id] = RunwayQueue(runway_id);
     }
     
     void set_minimum_separation(int runway_id, double separation_seconds) {
         auto it = runway_queues.find(runway_id);
         if (it != runway_queues.end()) {
-            it->second.minimum_separation_seconds = separation_seconds;
+            RunwayQueue& queue = it->second;
+            queue.minimum_separation_seconds = separation_seconds;
+            if (!queue.arrival_order.empty()) {
+                reslot_arrivals(queue, queue.arrival_order.begin()->first, queue.arrival_order.rbegin()->first);
+            }
         }
     }
     
@@ -715,6 +812,7 @@ public:
     bool request_departure_slot(int aircraft_id, int runway_id, double current_time) {
         auto queue_it = runway_queues.find(runway_id);
         if (queue_it == runway_queues.end()) return false;
+        cancel_arrival(aircraft_id);
         
         queue_it->second.departure_queue.push_back(aircraft_id);
         
@@ -751,25 +849,106 @@ public:
         return aircraft_id;
     }
     
-    // Get next aircraft to clear for landing
+    // Queue an arrival, or move one already queued; its slot is in get_sequence_info()
+    bool request_arrival_slot(int aircraft_id, int runway_id, double eta, double current_time) {
+        auto queue_it = runway_queues.find(runway_id);
+        if (queue_it == runway_queues.end()) return false;
+        
+        auto arrival_it = arrivals.find(aircraft_id);
+        if (arrival_it != arrivals.end()) {
+            if (arrival_it->second.runway_id == runway_id) return update_arrival_eta(aircraft_id, eta);
+            cancel_arrival(aircraft_id);
+        }
+        
+        SequencedAircraft& seq = sequence_table[aircraft_id];
+        seq = SequencedAircraft();
+        seq.aircraft_id = aircraft_id;
+        seq.sequence_number = next_sequence_number++;
+        seq.timestamp_queued = current_time;
+        seq.estimated_ready_time = eta;
+        seq.state = ClearanceStateMachine::ClearanceState::Airborne;
+        
+        ArrivalKey key(eta, seq.sequence_number);
+        queue_it->second.arrival_order.emplace(key, &seq);
+        arrivals[aircraft_id] = Arrival{runway_id, key};
+        reslot_arrivals(queue_it->second, key, key);
+        return true;
+    }
+    
+    // New ETA for a queued arrival; false if it is not queued
+    bool update_arrival_eta(int aircraft_id, double eta) {
+        auto arrival_it = arrivals.find(aircraft_id);
+        if (arrival_it == arrivals.end()) return false;
+        
+        RunwayQueue& queue = runway_queues[arrival_it->second.runway_id];
+        ArrivalKey old_key = arrival_it->second.key;
+        if (old_key.first == eta) return true;
+        
+        auto node = queue.arrival_order.extract(old_key);
+        ArrivalKey new_key(eta, old_key.second);
+        node.key() = new_key;
+        node.mapped()->estimated_ready_time = eta;
+        queue.arrival_order.insert(std::move(node));
+        arrival_it->second.key = new_key;
+        reslot_arrivals(queue, std::min(old_key, new_key), std::max(old_key, new_key));
+        return true;
+    }
+    
+    bool cancel_arrival(int aircraft_id) {
+        auto arrival_it = arrivals.find(aircraft_id);
+        if (arrival_it == arrivals.end()) return false;
+        
+        RunwayQueue& queue = runway_queues[arrival_it->second.runway_id];
+        ArrivalKey key = arrival_it->second.key;
+        queue.arrival_order.erase(key);
+        arrivals.erase(arrival_it);
+        sequence_table.erase(aircraft_id);
+        reslot_arrivals(queue, key, key);
+        return true;
+    }
+    
+    // Get next aircraft to clear for landing: the earliest slot, once it is due
     int get_next_arrival_clearance(int runway_id, double current_time) {
         auto queue_it = runway_queues.find(runway_id);
-        if (queue_it == runway_queues.end() || queue_it->second.arrival_queue.empty()) {
+        if (queue_it == runway_queues.end() || queue_it->second.arrival_order.empty()) {
             return -1;
         }
+        RunwayQueue& queue = queue_it->second;
         
-        double time_since_last = current_time - queue_it->second.last_arrival_time;
-        if (time_since_last < queue_it->second.minimum_separation_seconds) {
+        double time_since_last = current_time - queue.last_arrival_time;
+        if (time_since_last < queue.minimum_separation_seconds) {
             return -1;
         }
         
-        int aircraft_id = queue_it->second.arrival_queue.front();
-        queue_it->second.arrival_queue.pop_front();
-        queue_it->second.last_arrival_time = current_time;
+        auto first = queue.arrival_order.begin();
+        if (first->second->estimated_execution_time > current_time) {
+            return -1;  // Slot not reached
+        }
+        ArrivalKey key = first->first;
+        int aircraft_id = first->second->aircraft_id;
+        queue.arrival_order.erase(first);
+        arrivals.erase(aircraft_id);
+        queue.last_arrival_time = current_time;
+        reslot_arrivals(queue, key, key);
         
         return aircraft_id;
     }
     
+    size_t get_arrival_queue_length(int runway_id) const {
+        auto it = runway_queues.find(runway_id);
+        return (it != runway_queues.end()) ? it->second.arrival_order.size() : 0;
+    }
+    
+    // Queued arrivals for the runway in landing order
+    std::vector<int> get_arrival_sequence(int runway_id) const {
+        std::vector<int> result;
+        auto it = runway_queues.find(runway_id);
+        if (it == runway_queues.end()) return result;
+        result.reserve(it->second.arrival_order.size());
+        for (const auto& entry : it->second.arrival_order) result.push_back(entry.second->aircraft_id);
+        return result;
+    }
+    
     ClearanceStateMachine* get_aircraft_clearance(int aircraft_id) {
         auto it = aircraft_clearances.find(aircraft_id);
         return (it != aircraft_clearances.end()) ? &it->second : nullptr;
@@ -786,5 +965,354 @@ public:
     }
 };
 
+// ============================================================================
+// PART 2.6: Cooperative Taxi Planning
+// ============================================================================
+
+// Plans taxi routes for many aircraft against a shared reservation table,
+// using safe-interval path planning (space-time A* in continuous time):
+// every planned aircraft reserves the nodes it occupies, padded by the
+// separation time, and the edges it traverses, and later aircraft route
+// and time themselves around those reservations, holding at a node when
+// that is quicker than a detour. Head-on use of an edge and overtaking on
+// it are never planned. A batch is planned in request order, so earlier
+// requests have priority; plan() for one aircraft releases only its own
+// reservations, so a changed clearance replans that aircraft alone.
+class CooperativeTaxiPlanner {
+public:
+    struct TaxiRequest {
+        int aircraft_id;
+        int start_node_id;
+        int end_node_id;
+        double start_time_seconds;       // earliest time at the start node; later if it is reserved
+        double max_speed_knots;
+        double hold_seconds;             // time kept at the end node after arrival
+        
+        TaxiRequest(int aircraft = 0, int start = 0, int end = 0, double start_time = 0.0,
+                    double speed = 15.0, double hold = 60.0)
+            : aircraft_id(aircraft), start_node_id(start), end_node_id(end),
+              start_time_seconds(start_time), max_speed_knots(speed), hold_seconds(hold) {}
+    };
+    
+    struct TaxiStep {
+        int node_id;
+        int edge_id;                     // edge used to reach the node; -1 for the start
+        double arrival_time_seconds;
+        double departure_time_seconds;   // end of the hold for the last step
+    };
+    
+    struct TaxiPlan {
+        int aircraft_id;
+        bool success;
+        std::vector<TaxiStep> steps;
+        double total_distance_feet;
+        double total_wait_seconds;       // holding at the start and at nodes along the way
+        std::string error_message;
+        
+        TaxiPlan() : aircraft_id(-1), success(false), total_distance_feet(0.0),
+                     total_wait_seconds(0.0) {}
+    };
+    
+    CooperativeTaxiPlanner() : taxiway_network(nullptr), separation_seconds(15.0) {}
+    
+    // Replaces the network and drops every reservation
+    void set_taxiway_network(const TaxiwayNetwork* network) {
+        taxiway_network = network;
+        clear();
+    }
+    
+    // Minimum time between two aircraft at the same node or on the same edge
+    void set_separation_seconds(double seconds) { separation_seconds = std::max(0.0, seconds); }
+    
+    std::vector<TaxiPlan> plan_batch(const std::vector<TaxiRequest>& requests) {
+        std::vector<TaxiPlan> result;
+        result.reserve(requests.size());
+        for (const auto& request : requests) {
+            result.push_back(plan(request));
+        }
+        return result;
+    }
+    
+    // Plan or replan one aircraft; on failure its previous plan stays reserved
+    TaxiPlan plan(const TaxiRequest& request) {
+        std::optional<TaxiPlan> previous;
+        auto it = plans.find(request.aircraft_id);
+        if (it != plans.end()) {
+            previous = it->second;
+            release(request.aircraft_id);
+        }
+        
+        TaxiPlan result = search(request);
+        if (result.success) {
+            reserve(result);
+            plans[request.aircraft_id] = result;
+        } else if (previous) {
+            reserve(*previous);
+            plans[request.aircraft_id] = *previous;
+        }
+        return result;
+    }
+    
+    void release(int aircraft_id) {
+        auto it = plans.find(aircraft_id);
+        if (it == plans.end()) return;
+        auto owned = [aircraft_id](const auto& reservation) { return reservation.aircraft_id == aircraft_id; };
+        int previous = -1;
+        for (const auto& step : it->second.steps) {
+            int node = taxiway_network->get_node_index(step.node_id);
+            if (node < 0) continue;
+            auto& at_node = node_reservations[node];
+            at_node.erase(std::remove_if(at_node.begin(), at_node.end(), owned), at_node.end());
+            if (previous >= 0) {
+                auto edge = edge_reservations.find(edge_key(previous, node));
+                if (edge != edge_reservations.end()) {
+                    edge->second.erase(std::remove_if(edge->second.begin(), edge->second.end(), owned),
+                                       edge->second.end());
+                }
+            }
+            previous = node;
+        }
+        plans.erase(it);
+    }
+    
+    // Forget reservations, and plans, that ended before a time
+    void release_before(double time_seconds) {
+        auto ended = [time_seconds](const auto& reservation) { return reservation.end < time_seconds; };
+        for (auto& at_node : node_reservations) {
+            at_node.erase(std::remove_if(at_node.begin(), at_node.end(), ended), at_node.end());
+        }
+        for (auto& edge : edge_reservations) {
+            edge.second.erase(std::remove_if(edge.second.begin(), edge.second.end(), ended), edge.second.end());
+        }
+        for (auto it = plans.begin(); it != plans.end();) {
+            if (it->second.steps.back().departure_time_seconds + separation_seconds < time_seconds) {
+                it = plans.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    
+    void clear() {
+        node_reservations.clear();
+        edge_reservations.clear();
+        plans.clear();
+    }
+    
+    const TaxiPlan* get_plan(int aircraft_id) const {
+        auto it = plans.find(aircraft_id);
+        return (it != plans.end()) ? &it->second : nullptr;
+    }
+    
+    size_t get_plan_count() const { return plans.size(); }
+    
+private:
+    // Occupied span, already padded by the separation time for nodes
+    struct Reservation {
+        double start;
+        double end;
+        int aircraft_id;
+    };
+    struct EdgeReservation {
+        double start;                    // departure from from_index
+        double end;                      // arrival at the other end
+        int aircraft_id;
+        int from_index;
+    };
+    struct Interval {
+        double low;
+        double high;
+    };
+    struct State {
+        int node;
+        int interval;
+        double arrival;                  // earliest arrival within the interval
+        int parent;                      // state index, -1 for the start
+        int edge_id;
+        double parent_departure;         // when the parent node was left
+        double length_feet;              // of the edge from the parent
+    };
+    
+    static constexpr double KNOTS_TO_FEET_PER_SECOND = 1.6878;
+    
+    const TaxiwayNetwork* taxiway_network;
+    double separation_seconds;
+    std::vector<std::vector<Reservation>> node_reservations;  // by node index, sorted by start
+    std::unordered_map<uint64_t, std::vector<EdgeReservation>> edge_reservations;  // by undirected edge
+    std::map<int, TaxiPlan> plans;
+    
+    static uint64_t edge_key(int a, int b) {
+        uint32_t low = static_cast<uint32_t>(std::min(a, b));
+        uint32_t high = static_cast<uint32_t>(std::max(a, b));
+        return (uint64_t(low) << 32) | high;
+    }
+    
+    // Gaps between the reservations of a node
+    void safe_intervals(int node, std::vector<Interval>& out) const {
+        out.clear();
+        double low = -std::numeric_limits<double>::infinity();
+        if (node < static_cast<int>(node_reservations.size())) {
+            for (const auto& reservation : node_reservations[node]) {
+                if (reservation.start > low) out.push_back({low, reservation.start});
+                low = std::max(low, reservation.end);
+            }
+        }
+        out.push_back({low, std::numeric_limits<double>::infinity()});
+    }
+    
+    // Earliest departure at or after `depart` that keeps the edge free of
+    // head-on traffic and of overtaking either way
+    double clear_edge_departure(int from, int to, double depart, double duration) const {
+        auto it = edge_reservations.find(edge_key(from, to));
+        if (it == edge_reservations.end()) return depart;
+        bool moved = true;
+        while (moved) {
+            moved = false;
+            for (const auto& other : it->second) {
+                double arrive = depart + duration;
+                if (other.from_index != from) {
+                    if (depart < other.end + separation_seconds && arrive > other.start - separation_seconds) {
+                        depart = other.end + separation_seconds;
+                        moved = true;
+                    }
+                } else if (depart < other.start + separation_seconds ||
+                           arrive < other.end + separation_seconds) {
+                    // Entering before the other aircraft is fine only if we also leave first
+                    bool ahead = depart + separation_seconds <= other.start &&
+                                 arrive + separation_seconds <= other.end;
+                    if (!ahead) {
+                        depart = std::max(other.start + separation_seconds,
+                                          other.end + separation_seconds - duration);
+                        moved = true;
+                    }
+                }
+            }
+        }
+        return depart;
+    }
+    
+    TaxiPlan search(const TaxiRequest& request) const {
+        TaxiPlan result;
+        result.aircraft_id = request.aircraft_id;
+        
+        if (!taxiway_network) {
+            result.error_message = "Taxiway network not set";
+            return result;
+        }
+        const int start = taxiway_network->get_node_index(request.start_node_id);
+        const int goal = taxiway_network->get_node_index(request.end_node_id);
+        if (start < 0 || goal < 0 || !taxiway_network->has_node_at(start) || !taxiway_network->has_node_at(goal)) {
+            result.error_message = "Invalid start or end node";
+            return result;
+        }
+        
+        const double speed_fps = request.max_speed_knots * KNOTS_TO_FEET_PER_SECOND;
+        const double seconds_per_foot = speed_fps > 0.0 ? straight_line_scale(*taxiway_network) / speed_fps : 0.0;
+        const LatLonAlt& goal_position = taxiway_network->get_position_at(goal);
+        auto heuristic = [&](int node) {
+            if (!taxiway_network->has_node_at(node)) return 0.0;
+            return taxiway_network->get_position_at(node).distance_to(goal_position) * seconds_per_foot;
+        };
+        
+        std::vector<Interval> intervals;
+        safe_intervals(start, intervals);
+        // If another aircraft holds the start node, this one enters it once it is clear
+        int start_interval = 0;
+        while (intervals[start_interval].high < request.start_time_seconds) start_interval++;
+        const double start_time = std::max(request.start_time_seconds, intervals[start_interval].low);
+        
+        std::vector<State> states;
+        std::unordered_map<uint64_t, int> best;  // (node, interval) -> state
+        using Entry = std::pair<double, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+        auto state_key = [](int node, int interval) { return (uint64_t(uint32_t(node)) << 32) | uint32_t(interval); };
+        
+        states.push_back({start, start_interval, start_time, -1, -1, 0.0, 0.0});
+        best[state_key(start, start_interval)] = 0;
+        open.push({start_time + heuristic(start), 0});
+        
+        std::vector<Interval> next_intervals;
+        int found = -1;
+        while (!open.empty()) {
+            const int index = open.top().second;
+            open.pop();
+            const State current = states[index];
+            if (best[state_key(current.node, current.interval)] != index) continue;  // superseded
+            
+            safe_intervals(current.node, intervals);
+            const Interval here = intervals[current.interval];
+            if (current.node == goal && here.high - separation_seconds >= current.arrival + request.hold_seconds) {
+                found = index;
+                break;
+            }
+            
+            for (const auto& arc : taxiway_network->get_arcs_at(current.node)) {
+                double speed = std::min(arc.max_speed_knots, request.max_speed_knots);
+                if (speed < 1.0) continue;  // impassable at this speed
+                const double duration = arc.length_feet / (speed * KNOTS_TO_FEET_PER_SECOND);
+                
+                safe_intervals(arc.to_index, next_intervals);
+                for (size_t j = 0; j < next_intervals.size(); ++j) {
+                    const Interval& there = next_intervals[j];
+                    double depart = std::max(current.arrival, there.low - duration);
+                    if (depart > here.high) break;  // would have to leave a node already reserved
+                    depart = clear_edge_departure(current.node, arc.to_index, depart, duration);
+                    const double arrive = depart + duration;
+                    if (depart > here.high || arrive < there.low || arrive > there.high) continue;
+                    
+                    uint64_t key = state_key(arc.to_index, static_cast<int>(j));
+                    auto known = best.find(key);
+                    if (known != best.end() && states[known->second].arrival <= arrive) continue;
+                    states.push_back({arc.to_index, static_cast<int>(j), arrive, index, arc.edge_id,
+                                      depart, arc.length_feet});
+                    best[key] = static_cast<int>(states.size() - 1);
+                    open.push({arrive + heuristic(arc.to_index), static_cast<int>(states.size() - 1)});
+                }
+            }
+        }
+        
+        if (found < 0) {
+            result.error_message = "No conflict-free path found";
+            return result;
+        }
+        
+        // Reconstruct, filling each node's departure from the next leg
+        double departure = states[found].arrival + request.hold_seconds;
+        for (int index = found; index >= 0; index = states[index].parent) {
+            const State& state = states[index];
+            result.steps.push_back({taxiway_network->get_node_id_at(state.node), state.edge_id,
+                                    state.arrival, departure});
+            result.total_distance_feet += state.length_feet;
+            if (index != found) result.total_wait_seconds += departure - state.arrival;
+            departure = state.parent_departure;
+        }
+        std::reverse(result.steps.begin(), result.steps.end());
+        result.total_wait_seconds += start_time - request.start_time_seconds;
+        result.success = true;
+        return result;
+    }
+    
+    void reserve(const TaxiPlan& plan) {
+        node_reservations.resize(taxiway_network->get_index_count());
+        int previous = -1;
+        double previous_departure = 0.0;
+        for (const auto& step : plan.steps) {
+            int node = taxiway_network->get_node_index(step.node_id);
+            auto& at_node = node_reservations[node];
+            Reservation reservation{step.arrival_time_seconds - separation_seconds,
+                                    step.departure_time_seconds + separation_seconds, plan.aircraft_id};
+            at_node.insert(std::upper_bound(at_node.begin(), at_node.end(), reservation,
+                                            [](const Reservation& a, const Reservation& b) { return a.start < b.start; }),
+                           reservation);
+            if (previous >= 0) {
+                edge_reservations[edge_key(previous, node)].push_back(
+                    {previous_departure, step.arrival_time_seconds, plan.aircraft_id, previous});
+            }
+            previous = node;
+            previous_departure = step.departure_time_seconds;
+        }
+    }
+};
+
 } // namespace ATC
 } // namespace AICopilot
@@ -0,0 +1,113 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef ATC_TEXT_RING_HPP
+#define ATC_TEXT_RING_HPP
+
+#include "aicopilot_types.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace AICopilot {
+
+/**
+ * Non-owning view of one decoded ATC transmission
+ * The views point into an ATCTextRing slot and stay valid until that slot
+ * is reused (ATCTextRing::SLOT_COUNT - 1 publishes later).
+ */
+struct ATCTextView {
+    static constexpr size_t MAX_OPTIONS = 10;  // ATC menus offer keys 0-9
+
+    ATCMessageType type = ATCMessageType::OTHER;
+    uint64_t sequence = 0;
+    std::string_view message;
+    std::array<std::string_view, MAX_OPTIONS> options{};
+    size_t optionCount = 0;
+    bool truncated = false;  // text or option list did not fit the slot
+};
+
+/**
+ * Fixed-capacity ring of ATC text buffers
+ *
+ * publish() copies an incoming multi-string ("message\0option1\0option2\0...")
+ * into the next preallocated slot and splits it into views, so decoding a
+ * transmission on the dispatch thread never allocates. Single writer.
+ */
+class ATCTextRing {
+public:
+    static constexpr size_t SLOT_COUNT = 8;
+    static constexpr size_t SLOT_CAPACITY = 1024;
+
+    const ATCTextView& publish(ATCMessageType type, const char* text, size_t length) {
+        Slot& slot = slots_[next_];
+        next_ = (next_ + 1) % SLOT_COUNT;
+
+        ATCTextView& view = slot.view;
+        view.type = type;
+        view.sequence = ++published_;
+        view.optionCount = 0;
+        view.truncated = length > SLOT_CAPACITY;
+
+        size_t used = view.truncated ? SLOT_CAPACITY : length;
+        if (used > 0) {
+            std::memcpy(slot.text.data(), text, used);
+        }
+
+        // First string is the message, every following one a menu option
+        size_t pos = 0;
+        bool first = true;
+        while (pos < used) {
+            const char* start = slot.text.data() + pos;
+            const void* nul = std::memchr(start, '\0', used - pos);
+            size_t len = nul ? static_cast<size_t>(static_cast<const char*>(nul) - start) : used - pos;
+
+            if (first) {
+                view.message = std::string_view(start, len);
+                first = false;
+            } else if (len > 0) {
+                if (view.optionCount == ATCTextView::MAX_OPTIONS) {
+                    view.truncated = true;
+                    break;
+                }
+                view.options[view.optionCount++] = std::string_view(start, len);
+            }
+            pos += len + 1;
+        }
+        if (first) {
+            view.message = std::string_view();
+        }
+
+        return view;
+    }
+
+    // Most recent transmission, or nullptr before the first publish
+    const ATCTextView* latest() const {
+        if (published_ == 0) return nullptr;
+        return &slots_[(next_ + SLOT_COUNT - 1) % SLOT_COUNT].view;
+    }
+
+    uint64_t publishedCount() const { return published_; }
+
+private:
+    struct Slot {
+        std::array<char, SLOT_CAPACITY> text{};
+        ATCTextView view;
+    };
+
+    std::array<Slot, SLOT_COUNT> slots_{};
+    size_t next_ = 0;
+    uint64_t published_ = 0;
+};
+
+} // namespace AICopilot
+
+#endif // ATC_TEXT_RING_HPP
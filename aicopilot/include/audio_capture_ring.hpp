@@ -0,0 +1,128 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Audio Capture Ring - lock-free hand-off of audio frames between threads
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef AUDIO_CAPTURE_RING_HPP
+#define AUDIO_CAPTURE_RING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * Single-producer / single-consumer ring of fixed-size audio frames
+ *
+ * The audio callback write()s samples of any length; they fill the frame
+ * at the head of the ring in place, and a full frame is published with one
+ * release store. The recognition thread reads front() in place and pop()s
+ * it. All storage is allocated by the constructor, so neither side
+ * allocates, locks or waits: when the consumer falls a whole ring behind,
+ * write() drops the samples that do not fit and counts them instead of
+ * blocking the capture thread.
+ *
+ * write() may only be called from one thread and front()/pop() from one
+ * other; the statistics can be read from anywhere.
+ */
+class AudioCaptureRing {
+public:
+    struct Stats {
+        uint64_t frames_written = 0;
+        uint64_t samples_dropped = 0;   // ring was full
+    };
+
+    // frame_count is rounded up to a power of two
+    AudioCaptureRing(size_t frame_size, size_t frame_count)
+        : frame_size_(frame_size), frame_count_(roundUpPowerOfTwo(frame_count)),
+          mask_(frame_count_ - 1), storage_(frame_size_ * frame_count_) {}
+
+    AudioCaptureRing(const AudioCaptureRing&) = delete;
+    AudioCaptureRing& operator=(const AudioCaptureRing&) = delete;
+
+    size_t getFrameSize() const { return frame_size_; }
+    size_t getFrameCount() const { return frame_count_; }
+
+    // Producer: append samples; returns how many were accepted
+    size_t write(const int16_t* samples, size_t count) {
+        size_t accepted = 0;
+        size_t head = head_.load(std::memory_order_relaxed);
+        while (accepted < count) {
+            // Starting a frame needs a free slot; a partial one already owns its slot
+            if (fill_ == 0 && head - tail_.load(std::memory_order_acquire) == frame_count_) {
+                samples_dropped_.fetch_add(count - accepted, std::memory_order_relaxed);
+                break;
+            }
+
+            int16_t* slot = &storage_[(head & mask_) * frame_size_];
+            size_t take = std::min(frame_size_ - fill_, count - accepted);
+            std::memcpy(slot + fill_, samples + accepted, take * sizeof(int16_t));
+            fill_ += take;
+            accepted += take;
+
+            if (fill_ == frame_size_) {
+                fill_ = 0;
+                head_.store(++head, std::memory_order_release);
+                frames_written_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        return accepted;
+    }
+
+    // Consumer: the oldest complete frame, frame_size samples, or nullptr
+    const int16_t* front() const {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return nullptr;
+        return &storage_[(tail & mask_) * frame_size_];
+    }
+
+    // Consumer: release the frame front() returned
+    void pop() {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Complete frames waiting for the consumer
+    size_t available() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    Stats getStats() const {
+        Stats stats;
+        stats.frames_written = frames_written_.load(std::memory_order_relaxed);
+        stats.samples_dropped = samples_dropped_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    static size_t roundUpPowerOfTwo(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    const size_t frame_size_;
+    const size_t frame_count_;
+    const size_t mask_;
+    std::vector<int16_t> storage_;
+
+    // Each index on its own cache line so the two sides do not false-share
+    alignas(64) std::atomic<size_t> head_{0};   // frames published, producer-owned
+    size_t fill_ = 0;                           // samples in the head frame, producer-owned
+    alignas(64) std::atomic<size_t> tail_{0};   // frames consumed, consumer-owned
+    alignas(64) std::atomic<uint64_t> frames_written_{0};
+    std::atomic<uint64_t> samples_dropped_{0};
+};
+
+} // namespace AICopilot
+
+#endif // AUDIO_CAPTURE_RING_HPP
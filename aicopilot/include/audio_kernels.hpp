@@ -0,0 +1,134 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Audio Kernels - in-place sample kernels for the voice front end
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef AUDIO_KERNELS_HPP
+#define AUDIO_KERNELS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace AICopilot {
+
+/**
+ * 16-bit PCM kernels over count samples at samples[0..count)
+ *
+ * Each is a branch-free loop over one contiguous buffer, reading and
+ * writing in place, that the compiler vectorizes: integer reductions
+ * widen to 32 or 64 bits so a frame of full-scale samples cannot
+ * overflow, and float results saturate to int16 with min/max rather than
+ * a branch. Nothing allocates, so the voice front end runs every frame
+ * out of buffers it sized once.
+ */
+namespace AudioKernels {
+
+inline int16_t saturate(float value) {
+    return static_cast<int16_t>(std::max(-32768.0f, std::min(32767.0f, value)));
+}
+
+// Sum of squared samples
+inline int64_t sumOfSquares(const int16_t* samples, size_t count) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        int32_t s = samples[i];
+        sum += s * s;
+    }
+    return sum;
+}
+
+// RMS amplitude, 0 for an empty buffer
+inline double rmsEnergy(const int16_t* samples, size_t count) {
+    if (count == 0) return 0.0;
+    return std::sqrt(static_cast<double>(sumOfSquares(samples, count)) / count);
+}
+
+// Largest |sample|, up to 32768
+inline int32_t peakMagnitude(const int16_t* samples, size_t count) {
+    int32_t peak = 0;
+    for (size_t i = 0; i < count; ++i) {
+        int32_t s = samples[i];
+        peak = std::max(peak, s < 0 ? -s : s);
+    }
+    return peak;
+}
+
+/**
+ * First-order pre-emphasis y[n] = x[n] - coefficient * x[n-1], a FIR
+ * high-pass that removes DC and boosts the speech band. previous is the
+ * last input sample of the preceding frame; returns this frame's last
+ * input sample for the next call. Runs back to front so it can overwrite
+ * each sample after its successor has read it.
+ */
+inline int16_t preEmphasis(int16_t* samples, size_t count, float coefficient, int16_t previous) {
+    if (count == 0) return previous;
+    int16_t last = samples[count - 1];
+    for (size_t i = count - 1; i > 0; --i) {
+        samples[i] = saturate(samples[i] - coefficient * samples[i - 1]);
+    }
+    samples[0] = saturate(samples[0] - coefficient * previous);
+    return last;
+}
+
+// Zero every sample quieter than threshold
+inline void noiseGate(int16_t* samples, size_t count, int32_t threshold) {
+    for (size_t i = 0; i < count; ++i) {
+        int32_t s = samples[i];
+        samples[i] = (s < 0 ? -s : s) < threshold ? int16_t(0) : samples[i];
+    }
+}
+
+// Multiply by gain, saturating
+inline void applyGain(int16_t* samples, size_t count, float gain) {
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = saturate(samples[i] * gain);
+    }
+}
+
+/**
+ * Goertzel power at BANDS frequencies in one pass. coefficients[b] is
+ * 2cos(2 pi f_b / sample rate) in Q14; power[b] is |X(f_b)|^2 of the
+ * buffer. The bands run side by side in the inner loop, so it vectorizes
+ * across them rather than along the recurrence. State stays in 64 bits:
+ * at resonance it grows with count, about 2^23 for a full-scale frame.
+ */
+template <size_t BANDS>
+inline void goertzelPowers(const int16_t* samples, size_t count, const int32_t* coefficients, uint64_t* power) {
+    int64_t s1[BANDS] = {};
+    int64_t s2[BANDS] = {};
+    for (size_t i = 0; i < count; ++i) {
+        int64_t x = samples[i];
+        for (size_t b = 0; b < BANDS; ++b) {
+            int64_t s0 = x + ((coefficients[b] * s1[b]) >> 14) - s2[b];
+            s2[b] = s1[b];
+            s1[b] = s0;
+        }
+    }
+    for (size_t b = 0; b < BANDS; ++b) {
+        int64_t p = s1[b] * s1[b] + s2[b] * s2[b] - ((coefficients[b] * s1[b]) >> 14) * s2[b];
+        power[b] = static_cast<uint64_t>(std::max<int64_t>(0, p));
+    }
+}
+
+// log2(value) in Q8, mantissa linear between powers of two; 0 for 0 and 1
+inline int32_t log2Q8(uint64_t value) {
+    if (value < 2) return 0;
+    int32_t msb = 0;
+    while ((value >> msb) > 1) ++msb;
+    uint64_t fraction = msb >= 8 ? (value >> (msb - 8)) & 0xFF : (value << (8 - msb)) & 0xFF;
+    return msb * 256 + static_cast<int32_t>(fraction);
+}
+
+} // namespace AudioKernels
+
+} // namespace AICopilot
+
+#endif // AUDIO_KERNELS_HPP
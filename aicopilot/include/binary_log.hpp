@@ -0,0 +1,237 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Binary Log - asynchronous structured logging with an offline decoder
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef BINARY_LOG_HPP
+#define BINARY_LOG_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Sites below this level compile to nothing: 0 DEBUG, 1 INFO, 2 WARNING,
+// 3 ERROR, 4 CRITICAL. Set by the LOG_MIN_LEVEL CMake cache variable.
+#ifndef AICOPILOT_LOG_MIN_LEVEL
+#define AICOPILOT_LOG_MIN_LEVEL 1
+#endif
+
+namespace AICopilot {
+
+enum class LogLevel : uint8_t {
+    DEBUG = 0,
+    INFO = 1,
+    WARNING = 2,
+    ERROR = 3,
+    CRITICAL = 4
+};
+
+const char* logLevelName(LogLevel level);
+
+/**
+ * One log statement. Lives in static storage at the call site, so records
+ * carry its address and the format string is written to the file once.
+ */
+struct LogSite {
+    LogLevel level;
+    const char* file;
+    uint32_t line;
+    const char* format;   // "{}" per argument, "{:x}" for hex, "{{" for "{"
+};
+
+// Placeholders in a format string; checked against the argument count at compile time
+constexpr size_t countLogPlaceholders(const char* format) {
+    size_t count = 0;
+    for (size_t i = 0; format[i] != '\0'; ++i) {
+        if (format[i] == '{') {
+            if (format[i + 1] == '{') { ++i; continue; }
+            ++count;
+            while (format[i] != '\0' && format[i] != '}') ++i;
+            if (format[i] == '\0') break;
+        }
+    }
+    return count;
+}
+
+/**
+ * Arguments of one record, tagged and packed into a fixed stack buffer
+ *
+ * Numbers are widened to 64 bits; strings are copied, truncated so that
+ * the whole record fits in MAX_PAYLOAD_BYTES.
+ */
+class LogPayload {
+public:
+    static constexpr size_t MAX_PAYLOAD_BYTES = 1024;
+
+    enum Tag : uint8_t { TAG_I64 = 1, TAG_U64 = 2, TAG_F64 = 3, TAG_BOOL = 4, TAG_STR = 5 };
+
+    void add(bool value) { putTagged(TAG_BOOL, &value, 1); }
+    void add(char value) { int64_t v = value; putTagged(TAG_I64, &v, sizeof(v)); }
+    void add(float value) { add(static_cast<double>(value)); }
+    void add(double value) { putTagged(TAG_F64, &value, sizeof(value)); }
+    void add(const char* value) { addString(value ? value : "(null)", value ? std::strlen(value) : 6); }
+    void add(const std::string& value) { addString(value.data(), value.size()); }
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type add(T value) {
+        int64_t v = value;
+        putTagged(TAG_I64, &v, sizeof(v));
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type add(T value) {
+        uint64_t v = value;
+        putTagged(TAG_U64, &v, sizeof(v));
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type add(T value) {
+        add(static_cast<typename std::underlying_type<T>::type>(value));
+    }
+
+    const uint8_t* data() const { return bytes_; }
+    size_t size() const { return size_; }
+
+private:
+    uint8_t bytes_[MAX_PAYLOAD_BYTES];
+    size_t size_ = 0;
+
+    void putTagged(uint8_t tag, const void* value, size_t length) {
+        if (size_ + 1 + length > MAX_PAYLOAD_BYTES) {
+            return;
+        }
+        bytes_[size_++] = tag;
+        std::memcpy(bytes_ + size_, value, length);
+        size_ += length;
+    }
+
+    void addString(const char* text, size_t length) {
+        if (size_ + 3 > MAX_PAYLOAD_BYTES) {
+            return;
+        }
+        uint16_t stored = static_cast<uint16_t>(std::min(length, MAX_PAYLOAD_BYTES - size_ - 3));
+        bytes_[size_++] = TAG_STR;
+        std::memcpy(bytes_ + size_, &stored, sizeof(stored));
+        size_ += sizeof(stored);
+        std::memcpy(bytes_ + size_, text, stored);
+        size_ += stored;
+    }
+};
+
+// Render a format string against a packed payload
+std::string formatLogPayload(const char* format, const uint8_t* payload, size_t size);
+
+/**
+ * Process-wide asynchronous logger
+ *
+ * Each logging thread owns a single-producer/single-consumer byte ring of
+ * RING_BYTES; a log statement packs its arguments on the stack and copies
+ * one record into the ring, never blocking, allocating or formatting.
+ * If the ring is full the record is dropped and counted. A background
+ * writer drains every ring each WRITER_INTERVAL_MS into a binary file
+ * (read back with BinaryLogReader or tools/log_decoder) and, optionally,
+ * formats records to the console as well.
+ *
+ * Until start() is called, records are formatted and printed on the
+ * calling thread, so tools and tests keep their console output.
+ */
+class BinaryLogger {
+public:
+    static constexpr size_t RING_BYTES = 64 * 1024;
+    static constexpr int WRITER_INTERVAL_MS = 5;
+
+    static bool start(const std::string& path, bool echoToConsole = false);
+    static void stop();
+    static bool isRunning();
+
+    // Block until every record written before the call is in the file
+    static void flush();
+
+    static uint64_t droppedRecords();
+
+    static void write(const LogSite& site, const LogPayload& payload);
+
+    template<typename... Args>
+    static void log(const LogSite& site, const Args&... args) {
+        LogPayload payload;
+        (void)std::initializer_list<int>{(payload.add(args), 0)...};
+        write(site, payload);
+    }
+};
+
+/**
+ * One decoded record
+ */
+struct LogLine {
+    uint64_t wallTimeNs = 0;   // Unix epoch
+    LogLevel level = LogLevel::INFO;
+    uint32_t threadId = 0;
+    std::string file;
+    uint32_t line = 0;
+    std::string message;
+};
+
+// "2025-01-01 12:00:00.123456 [INFO] t1 file.cpp:42 message"
+std::string formatLogLine(const LogLine& line);
+
+/**
+ * Sequential reader for files written by BinaryLogger
+ */
+class BinaryLogReader {
+public:
+    bool open(const std::string& path);
+
+    // Next record; false at end of file or on a truncated record
+    bool next(LogLine& line);
+
+    // Records the writer reported as dropped so far
+    uint64_t droppedRecords() const { return dropped_; }
+
+private:
+    struct Site {
+        LogLevel level;
+        std::string file;
+        uint32_t line;
+        std::string format;
+    };
+
+    std::ifstream file_;
+    uint64_t epochWallNs_ = 0;
+    std::unordered_map<uint32_t, Site> sites_;
+    uint64_t dropped_ = 0;
+};
+
+} // namespace AICopilot
+
+#define AICOPILOT_LOG_AT(levelValue, format, ...)                                                     \
+    do {                                                                                              \
+        if constexpr (levelValue >= AICOPILOT_LOG_MIN_LEVEL) {                                        \
+            static_assert(::AICopilot::countLogPlaceholders(format) ==                                \
+                              std::tuple_size<decltype(std::make_tuple(__VA_ARGS__))>::value,         \
+                          "log format placeholders do not match the arguments");                      \
+            static constexpr ::AICopilot::LogSite aicopilotLogSite{                                   \
+                static_cast<::AICopilot::LogLevel>(levelValue), __FILE__, __LINE__, format};          \
+            ::AICopilot::BinaryLogger::log(aicopilotLogSite, ##__VA_ARGS__);                          \
+        }                                                                                             \
+    } while (0)
+
+#define AICOPILOT_LOG_DEBUG(format, ...) AICOPILOT_LOG_AT(0, format, ##__VA_ARGS__)
+#define AICOPILOT_LOG_INFO(format, ...) AICOPILOT_LOG_AT(1, format, ##__VA_ARGS__)
+#define AICOPILOT_LOG_WARNING(format, ...) AICOPILOT_LOG_AT(2, format, ##__VA_ARGS__)
+#define AICOPILOT_LOG_ERROR(format, ...) AICOPILOT_LOG_AT(3, format, ##__VA_ARGS__)
+#define AICOPILOT_LOG_CRITICAL(format, ...) AICOPILOT_LOG_AT(4, format, ##__VA_ARGS__)
+
+#endif // BINARY_LOG_HPP
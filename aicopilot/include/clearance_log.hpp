@@ -0,0 +1,148 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Clearance Log - event-sourced record of ATC clearances
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef CLEARANCE_LOG_HPP
+#define CLEARANCE_LOG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace AICopilot {
+
+enum class ClearanceEventType : uint8_t {
+    ALTITUDE,           // value: feet
+    HEADING,            // value: degrees
+    SPEED,              // value: knots
+    FREQUENCY,          // value: kHz
+    SQUAWK,             // value: code, e.g. 7500
+    CLEARED_TAKEOFF,
+    CLEARED_TO_LAND,
+    CLEARED_APPROACH,
+    CLEARED_OTHER,
+    HOLD,
+    GROUND_STATE        // value: ClearanceStateMachine::ClearanceState
+};
+
+// One clearance, fixed size so logs are compact and trivially serialized
+struct ClearanceEvent {
+    uint32_t sequence = 0;      // position in the log, from 0
+    uint32_t timeMs = 0;        // milliseconds since the log started
+    int32_t value = 0;
+    ClearanceEventType type = ClearanceEventType::CLEARED_OTHER;
+    uint8_t reserved[3] = {0, 0, 0};
+};
+static_assert(sizeof(ClearanceEvent) == 16, "ClearanceEvent must stay 16 bytes");
+
+/**
+ * Clearance state after a prefix of the log
+ *
+ * Plain data: copying one is a snapshot, and apply() advances it by one
+ * event, so any point of a flight is a snapshot plus the events after it.
+ */
+struct ClearanceSnapshot {
+    uint32_t eventCount = 0;          // events applied so far
+    uint32_t timeMs = 0;              // time of the last applied event
+    int32_t altitudeFeet = 0;
+    int32_t headingDegrees = 0;
+    int32_t speedKnots = 0;
+    int32_t frequencyKHz = 0;
+    int32_t squawk = 0;
+    int32_t groundState = 0;
+    uint16_t assigned = 0;            // bit per ClearanceEventType seen
+    uint16_t reserved = 0;
+
+    bool has(ClearanceEventType type) const {
+        return (assigned & bit(type)) != 0;
+    }
+
+    bool clearedForTakeoff() const { return has(ClearanceEventType::CLEARED_TAKEOFF); }
+    bool clearedToLand() const { return has(ClearanceEventType::CLEARED_TO_LAND); }
+    bool clearedForApproach() const { return has(ClearanceEventType::CLEARED_APPROACH); }
+    bool holding() const { return has(ClearanceEventType::HOLD); }
+
+    void apply(const ClearanceEvent& event);
+
+    static uint16_t bit(ClearanceEventType type) {
+        return static_cast<uint16_t>(1u << static_cast<unsigned>(type));
+    }
+};
+static_assert(std::is_trivially_copyable<ClearanceSnapshot>::value,
+              "ClearanceSnapshot must be trivially copyable");
+
+/**
+ * Append-only clearance event log with an incrementally applied state
+ *
+ * append() records the event and applies it to the current state. A
+ * checkpoint snapshot is kept every checkpointInterval events, so the
+ * state at any earlier point is rebuilt by replaying at most that many
+ * events. compact() folds old events into the base snapshot to bound
+ * memory on long sessions; save()/load() write the base snapshot and the
+ * remaining events as a small binary file for post-flight replay and
+ * audit (host byte order):
+ *
+ *   char     magic[8]     "AICPCLRL"
+ *   uint32_t version      FILE_VERSION
+ *   uint32_t eventCount   events following the snapshot
+ *   ClearanceSnapshot     base state
+ *   ClearanceEvent        events[eventCount]
+ *
+ * Not thread-safe; ATCController appends from update() only.
+ */
+class ClearanceLog {
+public:
+    static constexpr size_t DEFAULT_CHECKPOINT_INTERVAL = 64;
+    static constexpr uint32_t FILE_VERSION = 1;
+
+    explicit ClearanceLog(size_t checkpointInterval = DEFAULT_CHECKPOINT_INTERVAL);
+
+    const ClearanceEvent& append(ClearanceEventType type, int32_t value, uint32_t timeMs);
+
+    const ClearanceSnapshot& current() const { return current_; }
+
+    // State after eventCount events; clamped to the retained range
+    ClearanceSnapshot stateAt(uint32_t eventCount) const;
+
+    // Apply the events after from.eventCount to a copy of from
+    static ClearanceSnapshot replay(const ClearanceSnapshot& from,
+                                    const std::vector<ClearanceEvent>& events);
+
+    // Retained events, oldest first; the first follows base()
+    const std::vector<ClearanceEvent>& events() const { return events_; }
+    const ClearanceSnapshot& base() const { return base_; }
+    uint32_t size() const { return current_.eventCount; }
+
+    // Fold all but the newest keepEvents events into the base snapshot
+    void compact(size_t keepEvents = 0);
+    void clear();
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+    
+    // Replace the log with a base snapshot and the events after it, e.g.
+    // from a pilot checkpoint; false (log unchanged) on a sequence gap
+    bool restore(const ClearanceSnapshot& base, const ClearanceEvent* events, size_t eventCount);
+
+private:
+    size_t checkpointInterval_;
+    ClearanceSnapshot base_;
+    ClearanceSnapshot current_;
+    std::vector<ClearanceEvent> events_;
+    std::vector<ClearanceSnapshot> checkpoints_;   // checkpoints_[i] after (i+1)*interval retained events
+
+    void rebuildCheckpoints();
+};
+
+} // namespace AICopilot
+
+#endif // CLEARANCE_LOG_HPP
@@ -1,9 +1,18 @@
 #pragma once
 
 #include "airport_data.hpp"
+#include "work_stealing_pool.hpp"
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 // ============================================================================
 // PART 3: COLLISION AVOIDANCE SYSTEMS
@@ -118,8 +127,7 @@ public:
         // Check all edges of poly1
         for (size_t i = 0; i < poly1.vertices.size(); ++i) {
             Vector2D edge = poly1.vertices[(i + 1) % poly1.vertices.size()] - poly1.vertices[i];
-            Vector2D axis(-edge.y, edge.x);  // Perpendicular
-            axis = axis.normalize();
+            Vector2D axis(-edge.y, edge.x);  // Perpendicular; the gap test needs no normalizing
             
             if (is_separating_axis(poly1, poly2, axis)) {
                 return false;  // No collision
@@ -130,7 +138,6 @@ public:
         for (size_t i = 0; i < poly2.vertices.size(); ++i) {
             Vector2D edge = poly2.vertices[(i + 1) % poly2.vertices.size()] - poly2.vertices[i];
             Vector2D axis(-edge.y, edge.x);
-            axis = axis.normalize();
             
             if (is_separating_axis(poly1, poly2, axis)) {
                 return false;
@@ -252,6 +259,14 @@ public:
         low_altitude_vertical_sep = vertical;
     }
     
+    double get_lateral_separation_minimum() const {
+        return lateral_separation_minimum;
+    }
+    
+    double get_vertical_separation_minimum() const {
+        return vertical_separation_minimum;
+    }
+    
     // Check if two aircraft violate separation standards
     ConflictType check_separation_conflict(
         const AircraftState& aircraft1,
@@ -371,6 +386,266 @@ public:
     }
 };
 
+// ============================================================================
+// PART 3.2.1: Probabilistic Conflict Estimation (Monte-Carlo)
+// ============================================================================
+
+class ConflictProbabilityEstimator {
+public:
+    // One-sigma errors applied to each aircraft's straight-line projection
+    struct UncertaintyModel {
+        double speed_sigma_fps;              // groundspeed error
+        double heading_sigma_deg;            // track error at the start
+        double turn_rate_sigma_deg_per_sec;  // unknown intent: a constant turn over the horizon
+        
+        UncertaintyModel()
+            : speed_sigma_fps(3.0), heading_sigma_deg(3.0), turn_rate_sigma_deg_per_sec(0.5) {}
+    };
+    
+    struct Options {
+        size_t max_samples;            // trajectory pairs per estimate at most
+        size_t batch_size;             // samples propagated together
+        double time_step_seconds;      // propagation step; each step is swept exactly
+        double confidence_half_width;  // stop once the 95% interval is this narrow
+        uint64_t seed;
+        
+        Options()
+            : max_samples(4096), batch_size(256), time_step_seconds(1.0),
+              confidence_half_width(0.02), seed(0x5eed5eed5eed5eedULL) {}
+    };
+    
+    struct Estimate {
+        int aircraft1_id;
+        int aircraft2_id;
+        double probability;                     // sampled fraction that lose separation
+        double half_width;                      // of the 95% Wilson interval
+        size_t samples;
+        double mean_time_to_conflict_seconds;   // over sampled conflicts, -1 if none
+        
+        Estimate()
+            : aircraft1_id(-1), aircraft2_id(-1), probability(0.0), half_width(1.0),
+              samples(0), mean_time_to_conflict_seconds(-1.0) {}
+    };
+    
+    // Aircraft slower than this are holding and are not perturbed
+    static constexpr double MIN_MOVING_SPEED_FPS = 0.1;
+    
+    ConflictProbabilityEstimator(
+        const UncertaintyModel& uncertainty = UncertaintyModel(),
+        const Options& opts = Options())
+        : model(uncertainty), options(opts) {}
+    
+    void set_uncertainty_model(const UncertaintyModel& uncertainty) { model = uncertainty; }
+    void set_options(const Options& opts) { options = opts; }
+    const UncertaintyModel& get_uncertainty_model() const { return model; }
+    const Options& get_options() const { return options; }
+    
+    // Three-sigma drift of an aircraft moving at speed_fps from its nominal
+    // track after horizon_seconds, for padding a broad phase
+    double position_uncertainty_feet(double speed_fps, double horizon_seconds) const {
+        double heading_rad = model.heading_sigma_deg * DEG_TO_RAD;
+        double turn_rad = model.turn_rate_sigma_deg_per_sec * DEG_TO_RAD;
+        double drift = model.speed_sigma_fps * horizon_seconds +
+                       speed_fps * heading_rad * horizon_seconds +
+                       0.5 * speed_fps * turn_rad * horizon_seconds * horizon_seconds;
+        double reach = 2.0 * (speed_fps + 3.0 * model.speed_sigma_fps) * horizon_seconds;
+        return std::min(3.0 * drift, reach);
+    }
+    
+    // Probability that the pair comes within separation_feet inside the
+    // horizon. Samples are drawn in batches from a counter-keyed generator,
+    // so a given sample index always yields the same trajectories, and
+    // sampling stops as soon as the confidence interval is narrow enough.
+    Estimate estimate(
+        const SeparationStandards::AircraftState& aircraft1,
+        const SeparationStandards::AircraftState& aircraft2,
+        double horizon_seconds,
+        double separation_feet)
+    {
+        Estimate result;
+        result.aircraft1_id = aircraft1.aircraft_id;
+        result.aircraft2_id = aircraft2.aircraft_id;
+        
+        size_t batch = std::max<size_t>(options.batch_size, 1);
+        double step = options.time_step_seconds > 0.0 ? options.time_step_seconds : 1.0;
+        size_t steps = static_cast<size_t>(std::ceil(std::max(horizon_seconds, 0.0) / step));
+        uint64_t key = mix(options.seed ^ mix(
+            (static_cast<uint64_t>(static_cast<uint32_t>(aircraft1.aircraft_id)) << 32) |
+            static_cast<uint32_t>(aircraft2.aircraft_id)));
+        
+        resize_scratch(batch);
+        size_t hits = 0;
+        double hit_time_sum = 0.0;
+        while (result.samples < options.max_samples) {
+            size_t count = std::min(batch, options.max_samples - result.samples);
+            sample_batch(aircraft1, aircraft2, key, result.samples, count, step);
+            propagate_batch(count, steps, step, horizon_seconds, separation_feet * separation_feet);
+            
+            for (size_t j = 0; j < count; ++j) {
+                bool hit = hit_time[j] >= 0.0;
+                hits += hit ? 1 : 0;
+                hit_time_sum += hit ? hit_time[j] : 0.0;
+            }
+            result.samples += count;
+            result.half_width = wilson_half_width(hits, result.samples);
+            if (result.half_width <= options.confidence_half_width) break;
+        }
+        
+        if (result.samples > 0) {
+            result.probability = static_cast<double>(hits) / result.samples;
+        }
+        if (hits > 0) {
+            result.mean_time_to_conflict_seconds = hit_time_sum / hits;
+        }
+        return result;
+    }
+    
+private:
+    UncertaintyModel model;
+    Options options;
+    
+    // Per-batch sample state, one column per component: relative position
+    // (aircraft 2 minus 1), each velocity, each per-step turn rotation, and
+    // the first time separation is lost (negative until then)
+    std::vector<double> rel_x, rel_y;
+    std::vector<double> vel1_x, vel1_y, vel2_x, vel2_y;
+    std::vector<double> turn1_cos, turn1_sin, turn2_cos, turn2_sin;
+    std::vector<double> hit_time;
+    
+    static constexpr double Z_95 = 1.959963984540054;
+    static constexpr uint64_t GOLDEN_GAMMA = 0x9e3779b97f4a7c15ULL;
+    static constexpr int UNIFORMS_PER_SAMPLE = 6;
+    
+    // SplitMix64 finalizer; hashing a counter gives a stateless generator
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+    
+    // Uniform in (0, 1), never zero so it is safe under log()
+    static double to_unit(uint64_t bits) {
+        return (static_cast<double>(bits >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+    }
+    
+    static double wilson_half_width(size_t hits, size_t samples) {
+        double n = static_cast<double>(samples);
+        double p = hits / n;
+        double z2 = Z_95 * Z_95;
+        return Z_95 / (1.0 + z2 / n) * std::sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n));
+    }
+    
+    void resize_scratch(size_t batch) {
+        for (auto* column : {&rel_x, &rel_y, &vel1_x, &vel1_y, &vel2_x, &vel2_y,
+                             &turn1_cos, &turn1_sin, &turn2_cos, &turn2_sin, &hit_time}) {
+            column->resize(batch);
+        }
+    }
+    
+    // Draw count trajectory pairs starting at sample index first
+    void sample_batch(
+        const SeparationStandards::AircraftState& aircraft1,
+        const SeparationStandards::AircraftState& aircraft2,
+        uint64_t key,
+        size_t first,
+        size_t count,
+        double step)
+    {
+        double speed1 = aircraft1.velocity.magnitude();
+        double speed2 = aircraft2.velocity.magnitude();
+        bool moving1 = speed1 >= MIN_MOVING_SPEED_FPS;
+        bool moving2 = speed2 >= MIN_MOVING_SPEED_FPS;
+        double dir1_x = moving1 ? aircraft1.velocity.x / speed1 : 0.0;
+        double dir1_y = moving1 ? aircraft1.velocity.y / speed1 : 0.0;
+        double dir2_x = moving2 ? aircraft2.velocity.x / speed2 : 0.0;
+        double dir2_y = moving2 ? aircraft2.velocity.y / speed2 : 0.0;
+        double speed_sigma1 = moving1 ? model.speed_sigma_fps : 0.0;
+        double speed_sigma2 = moving2 ? model.speed_sigma_fps : 0.0;
+        double heading_sigma = model.heading_sigma_deg * DEG_TO_RAD;
+        double turn_sigma = model.turn_rate_sigma_deg_per_sec * DEG_TO_RAD * step;
+        Vector2D start = aircraft2.position_local - aircraft1.position_local;
+        
+        for (size_t j = 0; j < count; ++j) {
+            // Three Box-Muller pairs give six standard normals per sample
+            uint64_t counter = key + (first + j) * UNIFORMS_PER_SAMPLE * GOLDEN_GAMMA;
+            double normal[UNIFORMS_PER_SAMPLE];
+            for (int k = 0; k < UNIFORMS_PER_SAMPLE; k += 2) {
+                double u1 = to_unit(mix(counter + k * GOLDEN_GAMMA));
+                double u2 = to_unit(mix(counter + (k + 1) * GOLDEN_GAMMA));
+                double radius = std::sqrt(-2.0 * std::log(u1));
+                normal[k] = radius * std::cos(2.0 * PI * u2);
+                normal[k + 1] = radius * std::sin(2.0 * PI * u2);
+            }
+            
+            double s1 = std::max(speed1 + speed_sigma1 * normal[0], 0.0);
+            double s2 = std::max(speed2 + speed_sigma2 * normal[1], 0.0);
+            double h1 = heading_sigma * normal[2];
+            double h2 = heading_sigma * normal[3];
+            double c1 = std::cos(h1), n1 = std::sin(h1);
+            double c2 = std::cos(h2), n2 = std::sin(h2);
+            
+            rel_x[j] = start.x;
+            rel_y[j] = start.y;
+            vel1_x[j] = (dir1_x * c1 - dir1_y * n1) * s1;
+            vel1_y[j] = (dir1_x * n1 + dir1_y * c1) * s1;
+            vel2_x[j] = (dir2_x * c2 - dir2_y * n2) * s2;
+            vel2_y[j] = (dir2_x * n2 + dir2_y * c2) * s2;
+            turn1_cos[j] = std::cos(turn_sigma * normal[4]);
+            turn1_sin[j] = std::sin(turn_sigma * normal[4]);
+            turn2_cos[j] = std::cos(turn_sigma * normal[5]);
+            turn2_sin[j] = std::sin(turn_sigma * normal[5]);
+            hit_time[j] = -1.0;
+        }
+    }
+    
+    // Step every sample through the horizon. Velocities are constant within
+    // a step, so each step's closest approach is exact; the inner loop is
+    // branch-free over the columns so the compiler can vectorize it. A batch
+    // stops early once every sample has lost separation.
+    void propagate_batch(size_t count, size_t steps, double step, double horizon_seconds, double separation_sq) {
+        double* rx = rel_x.data();
+        double* ry = rel_y.data();
+        double* v1x = vel1_x.data();
+        double* v1y = vel1_y.data();
+        double* v2x = vel2_x.data();
+        double* v2y = vel2_y.data();
+        const double* c1 = turn1_cos.data();
+        const double* n1 = turn1_sin.data();
+        const double* c2 = turn2_cos.data();
+        const double* n2 = turn2_sin.data();
+        double* hit = hit_time.data();
+        
+        for (size_t k = 0; k < steps; ++k) {
+            double t0 = k * step;
+            double dt = std::min(step, horizon_seconds - t0);
+            size_t clear = 0;
+            
+            for (size_t j = 0; j < count; ++j) {
+                double wx = v2x[j] - v1x[j];
+                double wy = v2y[j] - v1y[j];
+                double closing = -(rx[j] * wx + ry[j] * wy) / (wx * wx + wy * wy + 1e-12);
+                double t = std::min(std::max(closing, 0.0), dt);
+                double mx = rx[j] + wx * t;
+                double my = ry[j] + wy * t;
+                bool lost = mx * mx + my * my < separation_sq;
+                hit[j] = (lost && hit[j] < 0.0) ? t0 + t : hit[j];
+                clear += hit[j] < 0.0 ? 1 : 0;
+                
+                rx[j] += wx * dt;
+                ry[j] += wy * dt;
+                double x1 = v1x[j] * c1[j] - v1y[j] * n1[j];
+                v1y[j] = v1x[j] * n1[j] + v1y[j] * c1[j];
+                v1x[j] = x1;
+                double x2 = v2x[j] * c2[j] - v2y[j] * n2[j];
+                v2y[j] = v2x[j] * n2[j] + v2y[j] * c2[j];
+                v2x[j] = x2;
+            }
+            
+            if (clear == 0) break;
+        }
+    }
+};
+
 // ============================================================================
 // PART 3.3: Conflict Prediction (30 second lookahead)
 // ============================================================================
@@ -395,9 +670,28 @@ public:
               conflict_type(SeparationStandards::ConflictType::None) {}
     };
     
+    // Incremental tracking: an aircraft is steady while it stays within these
+    // of the straight line it was on when last snapshotted
+    static constexpr double STEADY_POSITION_TOLERANCE_FEET = 50.0;
+    static constexpr double STEADY_VELOCITY_TOLERANCE_FPS = 2.0;
+    static constexpr double STEADY_ALTITUDE_TOLERANCE_FEET = 50.0;
+    
+    // Hysteresis: an active conflict clears only beyond these
+    static constexpr double EXIT_SEPARATION_FACTOR = 1.2;
+    static constexpr double EXIT_HORIZON_MARGIN_SECONDS = 5.0;
+    
+    // Below this many aircraft the collision pass stays on the caller's thread
+    static constexpr size_t PARALLEL_MIN_AIRCRAFT = 64;
+    
     ConflictPredictor(double horizon_seconds = 30.0)
         : prediction_horizon_seconds(horizon_seconds) {}
     
+    // Run the broad phase and pair evaluation on a task pool; partition
+    // results go to per-partition slots and are merged without locking
+    void set_thread_pool(std::shared_ptr<WorkStealingPool> thread_pool) {
+        pool = std::move(thread_pool);
+    }
+    
     void set_prediction_horizon(double seconds) {
         prediction_horizon_seconds = seconds;
     }
@@ -427,6 +721,77 @@ public:
                     return s.aircraft_id == aircraft_id;
                 }),
             aircraft_states.end());
+        snapshots.erase(aircraft_id);
+        uint32_t id = static_cast<uint32_t>(aircraft_id);
+        for (auto it = pair_cache.begin(); it != pair_cache.end();) {
+            if (static_cast<uint32_t>(it->first >> 32) == id || static_cast<uint32_t>(it->first) == id) {
+                it = pair_cache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    
+    // Broad phase: index pairs (i < j, ascending) whose swept paths over the
+    // prediction horizon, each padded by half of separation_feet, overlap.
+    // Any pair that comes within separation_feet inside the horizon is included.
+    std::vector<std::pair<size_t, size_t>> find_candidate_pairs(double separation_feet) const {
+        return find_candidate_pairs(separation_feet, prediction_horizon_seconds);
+    }
+    
+    std::vector<std::pair<size_t, size_t>> find_candidate_pairs(
+        double separation_feet,
+        double horizon_seconds) const
+    {
+        struct SweptBox {
+            double min_x, max_x, min_y, max_y;
+            size_t index;
+        };
+        
+        double pad = separation_feet * 0.5;
+        std::vector<SweptBox> boxes;
+        boxes.reserve(aircraft_states.size());
+        for (size_t i = 0; i < aircraft_states.size(); ++i) {
+            const auto& ac = aircraft_states[i];
+            Vector2D end = ac.position_local + ac.velocity * horizon_seconds;
+            boxes.push_back({
+                std::min(ac.position_local.x, end.x) - pad, std::max(ac.position_local.x, end.x) + pad,
+                std::min(ac.position_local.y, end.y) - pad, std::max(ac.position_local.y, end.y) + pad,
+                i});
+        }
+        
+        // Sweep and prune along X: each box pairs with the later boxes that
+        // start before it ends, then Y overlap is tested. Boxes are independent,
+        // so contiguous runs of them form partitions that can run in parallel.
+        std::sort(boxes.begin(), boxes.end(), [](const SweptBox& a, const SweptBox& b) {
+            return a.min_x < b.min_x;
+        });
+        
+        size_t partitions = partition_count(boxes.size());
+        std::vector<std::vector<std::pair<size_t, size_t>>> found(partitions);
+        for_each_partition(partitions, [&](size_t part) {
+            size_t begin = boxes.size() * part / partitions;
+            size_t end = boxes.size() * (part + 1) / partitions;
+            auto& out = found[part];
+            for (size_t k = begin; k < end; ++k) {
+                const SweptBox& box = boxes[k];
+                for (size_t j = k + 1; j < boxes.size() && boxes[j].min_x <= box.max_x; ++j) {
+                    const SweptBox& other = boxes[j];
+                    if (other.min_y <= box.max_y && box.min_y <= other.max_y) {
+                        out.emplace_back(std::min(box.index, other.index), std::max(box.index, other.index));
+                    }
+                }
+            }
+        });
+        
+        std::vector<std::pair<size_t, size_t>> pairs;
+        for (auto& part : found) {
+            pairs.insert(pairs.end(), part.begin(), part.end());
+        }
+        
+        // Same pair order as a full i < j scan
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
     }
     
     // Predict conflicts for all aircraft pairs
@@ -434,30 +799,29 @@ public:
         std::vector<ConflictAlert> alerts;
         SeparationStandards sep_standards;
         
-        for (size_t i = 0; i < aircraft_states.size(); ++i) {
-            for (size_t j = i + 1; j < aircraft_states.size(); ++j) {
-                const auto& ac1 = aircraft_states[i];
-                const auto& ac2 = aircraft_states[j];
+        // Only pairs the broad phase keeps can reach the CPA separation limit
+        for (const auto& pair : find_candidate_pairs(sep_standards.get_lateral_separation_minimum())) {
+            const auto& ac1 = aircraft_states[pair.first];
+            const auto& ac2 = aircraft_states[pair.second];
+            
+            double time_to_conflict;
+            bool conflict = sep_standards.predict_collision(
+                ac1, ac2, prediction_horizon_seconds, time_to_conflict);
+            
+            if (conflict) {
+                ConflictAlert alert;
+                alert.aircraft1_id = ac1.aircraft_id;
+                alert.aircraft2_id = ac2.aircraft_id;
+                alert.time_to_conflict_seconds = time_to_conflict;
+                alert.conflict_type = sep_standards.check_separation_conflict(ac1, ac2);
                 
-                double time_to_conflict;
-                bool conflict = sep_standards.predict_collision(
-                    ac1, ac2, prediction_horizon_seconds, time_to_conflict);
+                // Predict position at conflict
+                double t = time_to_conflict;
+                Vector2D pos1_pred = ac1.position_local + ac1.velocity * t;
+                Vector2D pos2_pred = ac2.position_local + ac2.velocity * t;
+                alert.predicted_conflict_position = (pos1_pred + pos2_pred) * 0.5;
                 
-                if (conflict) {
-                    ConflictAlert alert;
-                    alert.aircraft1_id = ac1.aircraft_id;
-                    alert.aircraft2_id = ac2.aircraft_id;
-                    alert.time_to_conflict_seconds = time_to_conflict;
-                    alert.conflict_type = sep_standards.check_separation_conflict(ac1, ac2);
-                    
-                    // Predict position at conflict
-                    double t = time_to_conflict;
-                    Vector2D pos1_pred = ac1.position_local + ac1.velocity * t;
-                    Vector2D pos2_pred = ac2.position_local + ac2.velocity * t;
-                    alert.predicted_conflict_position = (pos1_pred + pos2_pred) * 0.5;
-                    
-                    alerts.push_back(alert);
-                }
+                alerts.push_back(alert);
             }
         }
         
@@ -472,9 +836,280 @@ public:
         return alerts;
     }
     
+    // Incremental prediction, called once per collision update with the time
+    // since the previous call. Conflicts persist across calls: a pair's CPA is
+    // only recomputed when either aircraft has left its dead-reckoned track
+    // (see the STEADY_* tolerances), the pair is new, or its CPA has passed.
+    // A conflict is raised like predict_conflicts() but only clears once the
+    // CPA distance exceeds EXIT_SEPARATION_FACTOR times the minimum or the CPA
+    // moves EXIT_HORIZON_MARGIN_SECONDS beyond the horizon, so it does not
+    // flicker at the boundary. Alerts are sorted most urgent first.
+    const std::vector<ConflictAlert>& update_conflicts(double elapsed_seconds) {
+        clock_seconds += elapsed_seconds;
+        ++update_count;
+        
+        // Re-snapshot any aircraft that has left its straight-line reference
+        for (const auto& ac : aircraft_states) {
+            auto it = snapshots.find(ac.aircraft_id);
+            if (it == snapshots.end()) {
+                snapshots[ac.aircraft_id] = {ac.position_local, ac.velocity, ac.altitude_feet, clock_seconds, 0};
+                continue;
+            }
+            
+            TrackSnapshot& snap = it->second;
+            Vector2D predicted = snap.position + snap.velocity * (clock_seconds - snap.time_seconds);
+            bool steady =
+                (ac.position_local - predicted).magnitude() <= STEADY_POSITION_TOLERANCE_FEET &&
+                (ac.velocity - snap.velocity).magnitude() <= STEADY_VELOCITY_TOLERANCE_FPS &&
+                std::abs(ac.altitude_feet - snap.altitude_feet) <= STEADY_ALTITUDE_TOLERANCE_FEET;
+            if (!steady) {
+                snap = {ac.position_local, ac.velocity, ac.altitude_feet, clock_seconds, snap.epoch + 1};
+            }
+        }
+        
+        SeparationStandards sep_standards;
+        double lat_sep = sep_standards.get_lateral_separation_minimum();
+        double exit_sep = lat_sep * EXIT_SEPARATION_FACTOR;
+        double exit_horizon = prediction_horizon_seconds + EXIT_HORIZON_MARGIN_SECONDS;
+        
+        active_alerts.clear();
+        last_evaluated_pairs = 0;
+        
+        // The broad phase covers the exit limits so active pairs stay visible.
+        // Entries are created serially; unordered_map keeps references stable,
+        // so each partition then updates its own entries without locking.
+        auto candidates = find_candidate_pairs(exit_sep, exit_horizon);
+        std::vector<PairEntry*> entries(candidates.size());
+        std::vector<uint32_t> epochs(aircraft_states.size());
+        for (size_t i = 0; i < aircraft_states.size(); ++i) {
+            epochs[i] = snapshots[aircraft_states[i].aircraft_id].epoch;
+        }
+        for (size_t k = 0; k < candidates.size(); ++k) {
+            int id1 = aircraft_states[candidates[k].first].aircraft_id;
+            int id2 = aircraft_states[candidates[k].second].aircraft_id;
+            PairEntry& entry = pair_cache[pair_key(id1, id2)];
+            entry.seen_update = update_count;
+            entries[k] = &entry;
+        }
+        
+        size_t partitions = partition_count(aircraft_states.size());
+        std::vector<std::vector<ConflictAlert>> found(partitions);
+        std::vector<size_t> evaluated(partitions, 0);
+        for_each_partition(partitions, [&](size_t part) {
+            size_t begin = candidates.size() * part / partitions;
+            size_t end = candidates.size() * (part + 1) / partitions;
+            for (size_t k = begin; k < end; ++k) {
+                const auto& ac1 = aircraft_states[candidates[k].first];
+                const auto& ac2 = aircraft_states[candidates[k].second];
+                uint32_t epoch1 = epochs[candidates[k].first];
+                uint32_t epoch2 = epochs[candidates[k].second];
+                PairEntry& entry = *entries[k];
+                
+                bool fresh = entry.evaluated_seconds < 0.0;
+                double time_to_cpa = entry.time_to_cpa_seconds - (clock_seconds - entry.evaluated_seconds);
+                if (fresh || entry.epoch1 != epoch1 || entry.epoch2 != epoch2 ||
+                    entry.time_to_cpa_seconds <= 0.0 || time_to_cpa <= 0.0)
+                {
+                    entry.distance_at_cpa_feet = sep_standards.calculate_closest_point_of_approach(
+                        ac1, ac2, entry.time_to_cpa_seconds);
+                    entry.evaluated_seconds = clock_seconds;
+                    entry.epoch1 = epoch1;
+                    entry.epoch2 = epoch2;
+                    
+                    double t = entry.time_to_cpa_seconds;
+                    Vector2D pos1_pred = ac1.position_local + ac1.velocity * t;
+                    Vector2D pos2_pred = ac2.position_local + ac2.velocity * t;
+                    entry.conflict_position = (pos1_pred + pos2_pred) * 0.5;
+                    
+                    time_to_cpa = t;
+                    ++evaluated[part];
+                }
+                
+                bool enter = time_to_cpa <= prediction_horizon_seconds && entry.distance_at_cpa_feet < lat_sep;
+                bool hold = entry.active && time_to_cpa <= exit_horizon && entry.distance_at_cpa_feet < exit_sep;
+                entry.active = enter || hold;
+                if (!entry.active) continue;
+                
+                ConflictAlert alert;
+                alert.aircraft1_id = ac1.aircraft_id;
+                alert.aircraft2_id = ac2.aircraft_id;
+                alert.time_to_conflict_seconds = time_to_cpa;
+                alert.minimum_separation_at_conflict_feet = entry.distance_at_cpa_feet;
+                alert.conflict_type = sep_standards.check_separation_conflict(ac1, ac2);
+                alert.predicted_conflict_position = entry.conflict_position;
+                found[part].push_back(alert);
+            }
+        });
+        
+        for (size_t part = 0; part < partitions; ++part) {
+            active_alerts.insert(active_alerts.end(), found[part].begin(), found[part].end());
+            last_evaluated_pairs += evaluated[part];
+        }
+        
+        // Pairs the broad phase no longer keeps cannot be in conflict
+        for (auto it = pair_cache.begin(); it != pair_cache.end();) {
+            if (it->second.seen_update != update_count) {
+                it = pair_cache.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        
+        // Ties broken by pair so the order does not depend on partitioning
+        std::sort(
+            active_alerts.begin(),
+            active_alerts.end(),
+            [](const ConflictAlert& a, const ConflictAlert& b) {
+                if (a.time_to_conflict_seconds != b.time_to_conflict_seconds) {
+                    return a.time_to_conflict_seconds < b.time_to_conflict_seconds;
+                }
+                if (a.aircraft1_id != b.aircraft1_id) return a.aircraft1_id < b.aircraft1_id;
+                return a.aircraft2_id < b.aircraft2_id;
+            });
+        
+        return active_alerts;
+    }
+    
+    // Alerts from the last update_conflicts() call
+    const std::vector<ConflictAlert>& get_active_alerts() const {
+        return active_alerts;
+    }
+    
+    // Pairs whose CPA update_conflicts() recomputed on its last call
+    size_t get_last_evaluated_pair_count() const {
+        return last_evaluated_pairs;
+    }
+    
     size_t get_tracked_aircraft_count() const {
         return aircraft_states.size();
     }
+    
+    // Probabilistic mode: conflict probabilities for the max_pairs pairs whose
+    // nominal tracks come closest inside the horizon, most likely first. The
+    // broad phase is padded by the estimator's three-sigma drift so pairs
+    // only uncertainty can bring together are still ranked.
+    std::vector<ConflictProbabilityEstimator::Estimate> estimate_conflict_probabilities(
+        size_t max_pairs,
+        ConflictProbabilityEstimator& estimator) const
+    {
+        SeparationStandards sep_standards;
+        double lat_sep = sep_standards.get_lateral_separation_minimum();
+        
+        double max_speed = 0.0;
+        for (const auto& ac : aircraft_states) {
+            max_speed = std::max(max_speed, ac.velocity.magnitude());
+        }
+        double reach = lat_sep + 2.0 * estimator.position_uncertainty_feet(max_speed, prediction_horizon_seconds);
+        
+        struct Threat {
+            size_t first, second;
+            double distance;
+        };
+        std::vector<Threat> threats;
+        for (const auto& pair : find_candidate_pairs(reach)) {
+            const auto& ac1 = aircraft_states[pair.first];
+            const auto& ac2 = aircraft_states[pair.second];
+            double time_to_cpa;
+            double distance = sep_standards.calculate_closest_point_of_approach(ac1, ac2, time_to_cpa);
+            if (time_to_cpa > prediction_horizon_seconds) {
+                Vector2D delta_pos = ac2.position_local - ac1.position_local;
+                Vector2D delta_vel = ac2.velocity - ac1.velocity;
+                distance = (delta_pos + delta_vel * prediction_horizon_seconds).magnitude();
+            }
+            if (distance < reach) {
+                threats.push_back({pair.first, pair.second, distance});
+            }
+        }
+        
+        size_t count = std::min(max_pairs, threats.size());
+        std::partial_sort(
+            threats.begin(),
+            threats.begin() + count,
+            threats.end(),
+            [](const Threat& a, const Threat& b) {
+                if (a.distance != b.distance) return a.distance < b.distance;
+                return std::make_pair(a.first, a.second) < std::make_pair(b.first, b.second);
+            });
+        
+        std::vector<ConflictProbabilityEstimator::Estimate> estimates;
+        estimates.reserve(count);
+        for (size_t k = 0; k < count; ++k) {
+            estimates.push_back(estimator.estimate(
+                aircraft_states[threats[k].first],
+                aircraft_states[threats[k].second],
+                prediction_horizon_seconds,
+                lat_sep));
+        }
+        
+        std::stable_sort(
+            estimates.begin(),
+            estimates.end(),
+            [](const ConflictProbabilityEstimator::Estimate& a, const ConflictProbabilityEstimator::Estimate& b) {
+                return a.probability > b.probability;
+            });
+        return estimates;
+    }
+    
+private:
+    // Straight-line reference for each aircraft; epoch bumps on each re-snapshot
+    struct TrackSnapshot {
+        Vector2D position;
+        Vector2D velocity;
+        double altitude_feet;
+        double time_seconds;
+        uint32_t epoch;
+    };
+    
+    // Cached CPA of one pair, valid while both snapshots keep their epochs
+    struct PairEntry {
+        uint32_t epoch1 = 0;
+        uint32_t epoch2 = 0;
+        double evaluated_seconds = -1.0;  // negative until first evaluated
+        double time_to_cpa_seconds = 0.0;
+        double distance_at_cpa_feet = 0.0;
+        Vector2D conflict_position;
+        bool active = false;
+        uint64_t seen_update = 0;
+    };
+    
+    std::unordered_map<int, TrackSnapshot> snapshots;
+    std::unordered_map<uint64_t, PairEntry> pair_cache;
+    std::vector<ConflictAlert> active_alerts;
+    double clock_seconds = 0.0;
+    uint64_t update_count = 0;
+    size_t last_evaluated_pairs = 0;
+    
+    std::shared_ptr<WorkStealingPool> pool;
+    
+    static uint64_t pair_key(int id1, int id2) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(id1)) << 32) | static_cast<uint32_t>(id2);
+    }
+    
+    size_t partition_count(size_t items) const {
+        if (!pool || aircraft_states.size() < PARALLEL_MIN_AIRCRAFT || items == 0) return 1;
+        return std::min(items, pool->getThreadCount() * 4);
+    }
+    
+    // Run job(part) for every partition and wait for just those; the pool
+    // may be shared, so its own wait() is not used
+    void for_each_partition(size_t partitions, const std::function<void(size_t)>& job) const {
+        if (partitions <= 1) {
+            job(0);
+            return;
+        }
+        std::mutex mutex;
+        std::condition_variable done;
+        size_t remaining = partitions;
+        for (size_t part = 0; part < partitions; ++part) {
+            pool->submit([&, part] {
+                job(part);
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--remaining == 0) done.notify_one();
+            });
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return remaining == 0; });
+    }
 };
 
 // ============================================================================
@@ -501,11 +1136,14 @@ public:
     double new_speed_knots;             // For speed changes
     double duration_seconds;            // How long to maintain maneuver
     double pilot_workload;              // 0-100, higher is more demanding
+    double heading_change_degrees;      // Positive right; set by the coordinated solver
+    double vertical_rate_fpm;           // Positive climb; set by the coordinated solver
     std::string description;
     
     AvoidanceManeuver(ManeuverType type = ManeuverType::None)
         : maneuver_type(type), new_heading_true(0.0), new_altitude_feet(0.0),
-          new_speed_knots(0.0), duration_seconds(60.0), pilot_workload(50.0) {}
+          new_speed_knots(0.0), duration_seconds(60.0), pilot_workload(50.0),
+          heading_change_degrees(0.0), vertical_rate_fpm(0.0) {}
 };
 
 class ManeuverSelector {
@@ -693,6 +1331,336 @@ private:
     }
 };
 
+// ============================================================================
+// PART 3.4.1: Coordinated Multi-Threat Maneuver Solver
+// ============================================================================
+
+class CoordinatedManeuverSolver {
+public:
+    // A resolved option: heading change (positive right) and vertical rate
+    struct Resolution {
+        AvoidanceManeuver maneuver;
+        double heading_change_degrees;
+        double vertical_rate_fpm;
+        double minimum_margin;          // worst threat, in separation minimums; >= 1 resolves
+        bool resolves_all_threats;
+        bool from_cache;                // sense kept from the previous solve
+        size_t options_evaluated;
+        
+        Resolution()
+            : heading_change_degrees(0.0), vertical_rate_fpm(0.0), minimum_margin(0.0),
+              resolves_all_threats(false), from_cache(false), options_evaluated(0) {}
+    };
+    
+    // Options grid, smallest first; equal scores go to the earlier option, so
+    // ties favor turning right and climbing
+    static constexpr double HEADING_CHANGES_DEG[] = {0.0, 15.0, -15.0, 30.0, -30.0, 45.0, -45.0};
+    static constexpr double VERTICAL_RATE_FRACTIONS[] = {0.0, 0.5, -0.5, 1.0, -1.0};
+    
+    // Threats considered per solve, nearest first
+    static constexpr size_t MAX_THREATS = 8;
+    static constexpr double EVALUATION_STEP_SECONDS = 1.0;
+    
+    // Vertical options are only offered above this altitude
+    static constexpr double MIN_VERTICAL_MANEUVER_ALTITUDE_FEET = 500.0;
+    
+    // Scoring: margin above one minimum earns nothing, so among resolving
+    // options the cheapest wins; a change of sense must pay for itself
+    static constexpr double HEADING_COST_PER_DEGREE = 0.004;
+    static constexpr double VERTICAL_COST = 0.15;
+    static constexpr double REVERSAL_PENALTY = 0.25;
+    
+    CoordinatedManeuverSolver(double horizon_seconds = 30.0)
+        : horizon_seconds(horizon_seconds),
+          max_climb_rate_fpm(1500.0),
+          max_descent_rate_fpm(1000.0) {}
+    
+    void set_prediction_horizon(double seconds) { horizon_seconds = seconds; }
+    
+    void set_vertical_limits(double climb_rate_fpm, double descent_rate_fpm) {
+        max_climb_rate_fpm = climb_rate_fpm;
+        max_descent_rate_fpm = descent_rate_fpm;
+    }
+    
+    void set_separation_standards(const SeparationStandards& standards) {
+        separation = standards;
+    }
+    
+    // Drop the cached sense of an aircraft (e.g. once its conflicts clear)
+    void clear_cache(int aircraft_id) { cache.erase(aircraft_id); }
+    void clear_cache() { cache.clear(); }
+    
+    // Pick one heading change and vertical rate that keeps the ownship
+    // separated from every threat at once. Threats with an entry in planned
+    // (their own resolutions) are projected along it, so aircraft solved
+    // later coordinate with those solved earlier. The nearest MAX_THREATS
+    // threats are considered, so the work per call is bounded. While the
+    // threat set and their tracks are unchanged and the cached option still
+    // resolves, it is returned without searching.
+    Resolution solve(
+        const SeparationStandards::AircraftState& ownship,
+        const std::vector<SeparationStandards::AircraftState>& threats,
+        const std::map<int, AvoidanceManeuver>* planned = nullptr)
+    {
+        std::vector<ThreatTrack> tracks = project_threats(ownship, threats, planned);
+        
+        auto cached = cache.find(ownship.aircraft_id);
+        if (cached != cache.end() && same_geometry(cached->second.threats, tracks)) {
+            double margin = evaluate_option(ownship, tracks,
+                cached->second.heading_change_degrees, cached->second.vertical_rate_fpm);
+            if (margin >= 1.0) {
+                Resolution result = make_resolution(ownship,
+                    cached->second.heading_change_degrees, cached->second.vertical_rate_fpm, margin);
+                result.from_cache = true;
+                result.options_evaluated = 1;
+                return result;
+            }
+        }
+        
+        // Options as columns, evaluated against every threat before scoring
+        bool vertical = ownship.altitude_feet > MIN_VERTICAL_MANEUVER_ALTITUDE_FEET;
+        size_t vertical_options = vertical ? std::size(VERTICAL_RATE_FRACTIONS) : 1;
+        size_t count = std::size(HEADING_CHANGES_DEG) * vertical_options;
+        option_heading.resize(count);
+        option_vertical.resize(count);
+        option_vx.resize(count);
+        option_vy.resize(count);
+        option_vz.resize(count);
+        option_margin_sq.assign(count, std::numeric_limits<double>::infinity());
+        
+        size_t o = 0;
+        for (double heading_change : HEADING_CHANGES_DEG) {
+            for (size_t v = 0; v < vertical_options; ++v) {
+                double fraction = vertical ? VERTICAL_RATE_FRACTIONS[v] : 0.0;
+                double rate = fraction * (fraction > 0.0 ? max_climb_rate_fpm : max_descent_rate_fpm);
+                Vector2D velocity = rotate(ownship.velocity, heading_change);
+                option_heading[o] = heading_change;
+                option_vertical[o] = rate;
+                option_vx[o] = velocity.x;
+                option_vy[o] = velocity.y;
+                option_vz[o] = rate / 60.0;
+                ++o;
+            }
+        }
+        accumulate_margins(ownship, tracks, count);
+        
+        int previous_turn = 0, previous_climb = 0;
+        if (cached != cache.end()) {
+            previous_turn = sign(cached->second.heading_change_degrees);
+            previous_climb = sign(cached->second.vertical_rate_fpm);
+        }
+        
+        size_t best = 0;
+        double best_score = -std::numeric_limits<double>::infinity();
+        for (size_t k = 0; k < count; ++k) {
+            double margin = std::sqrt(option_margin_sq[k]);
+            double score = std::min(margin, 1.0)
+                - std::abs(option_heading[k]) * HEADING_COST_PER_DEGREE
+                - (option_vertical[k] != 0.0 ? VERTICAL_COST * std::abs(option_vertical[k]) / max_climb_rate_fpm : 0.0);
+            bool reversal =
+                (previous_turn != 0 && sign(option_heading[k]) == -previous_turn) ||
+                (previous_climb != 0 && sign(option_vertical[k]) == -previous_climb);
+            if (reversal) score -= REVERSAL_PENALTY;
+            if (score > best_score) {
+                best_score = score;
+                best = k;
+            }
+        }
+        
+        double margin = std::sqrt(option_margin_sq[best]);
+        Resolution result = make_resolution(ownship, option_heading[best], option_vertical[best], margin);
+        result.options_evaluated = count;
+        
+        CachedSense& entry = cache[ownship.aircraft_id];
+        entry.heading_change_degrees = option_heading[best];
+        entry.vertical_rate_fpm = option_vertical[best];
+        entry.threats = std::move(tracks);
+        return result;
+    }
+    
+    size_t get_cached_aircraft_count() const { return cache.size(); }
+    
+private:
+    // A threat as the solve projects it: current state, planned velocity
+    struct ThreatTrack {
+        int aircraft_id;
+        Vector2D position;
+        Vector2D velocity;
+        double altitude_feet;
+        double vertical_rate_fps;
+    };
+    
+    struct CachedSense {
+        double heading_change_degrees = 0.0;
+        double vertical_rate_fpm = 0.0;
+        std::vector<ThreatTrack> threats;
+    };
+    
+    double horizon_seconds;
+    double max_climb_rate_fpm;
+    double max_descent_rate_fpm;
+    SeparationStandards separation;
+    std::unordered_map<int, CachedSense> cache;
+    
+    // Option columns, reused between solves
+    std::vector<double> option_heading, option_vertical;
+    std::vector<double> option_vx, option_vy, option_vz;
+    std::vector<double> option_margin_sq;
+    
+    static int sign(double value) { return (value > 0.0) - (value < 0.0); }
+    
+    // Clockwise (right turn) rotation of an east/north velocity
+    static Vector2D rotate(const Vector2D& velocity, double degrees) {
+        double c = std::cos(degrees * DEG_TO_RAD);
+        double s = std::sin(degrees * DEG_TO_RAD);
+        return Vector2D(velocity.x * c + velocity.y * s, -velocity.x * s + velocity.y * c);
+    }
+    
+    std::vector<ThreatTrack> project_threats(
+        const SeparationStandards::AircraftState& ownship,
+        const std::vector<SeparationStandards::AircraftState>& threats,
+        const std::map<int, AvoidanceManeuver>* planned) const
+    {
+        std::vector<ThreatTrack> tracks;
+        tracks.reserve(threats.size());
+        for (const auto& threat : threats) {
+            if (threat.aircraft_id == ownship.aircraft_id) continue;
+            ThreatTrack track{threat.aircraft_id, threat.position_local, threat.velocity, threat.altitude_feet, 0.0};
+            if (planned) {
+                auto it = planned->find(threat.aircraft_id);
+                if (it != planned->end()) {
+                    track.velocity = rotate(threat.velocity, it->second.heading_change_degrees);
+                    track.vertical_rate_fps = it->second.vertical_rate_fpm / 60.0;
+                }
+            }
+            tracks.push_back(track);
+        }
+        
+        // Nearest first, ids breaking ties, then bounded
+        std::sort(tracks.begin(), tracks.end(), [&](const ThreatTrack& a, const ThreatTrack& b) {
+            double da = (a.position - ownship.position_local).magnitude();
+            double db = (b.position - ownship.position_local).magnitude();
+            if (da != db) return da < db;
+            return a.aircraft_id < b.aircraft_id;
+        });
+        if (tracks.size() > MAX_THREATS) tracks.resize(MAX_THREATS);
+        std::sort(tracks.begin(), tracks.end(), [](const ThreatTrack& a, const ThreatTrack& b) {
+            return a.aircraft_id < b.aircraft_id;
+        });
+        return tracks;
+    }
+    
+    // Same threats on the same (possibly planned) tracks; positions move
+    // along those tracks between calls and do not count as a change
+    static bool same_geometry(const std::vector<ThreatTrack>& before, const std::vector<ThreatTrack>& now) {
+        if (before.size() != now.size()) return false;
+        for (size_t k = 0; k < now.size(); ++k) {
+            if (before[k].aircraft_id != now[k].aircraft_id ||
+                (before[k].velocity - now[k].velocity).magnitude() > ConflictPredictor::STEADY_VELOCITY_TOLERANCE_FPS ||
+                std::abs(before[k].vertical_rate_fps - now[k].vertical_rate_fps) > ConflictPredictor::STEADY_VELOCITY_TOLERANCE_FPS)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Worst separation over the horizon in units of the minimums: at each
+    // sample the larger of horizontal / lateral and vertical / vertical
+    // minimum, squared. Inner loops run over the option columns.
+    void accumulate_margins(
+        const SeparationStandards::AircraftState& ownship,
+        const std::vector<ThreatTrack>& tracks,
+        size_t count)
+    {
+        double inv_lat_sq = 1.0 / (separation.get_lateral_separation_minimum() * separation.get_lateral_separation_minimum());
+        double inv_vert_sq = 1.0 / (separation.get_vertical_separation_minimum() * separation.get_vertical_separation_minimum());
+        size_t steps = static_cast<size_t>(std::ceil(std::max(horizon_seconds, 0.0) / EVALUATION_STEP_SECONDS));
+        const double* vx = option_vx.data();
+        const double* vy = option_vy.data();
+        const double* vz = option_vz.data();
+        double* margin_sq = option_margin_sq.data();
+        
+        for (const auto& track : tracks) {
+            Vector2D dp = track.position - ownship.position_local;
+            double dz = track.altitude_feet - ownship.altitude_feet;
+            for (size_t k = 0; k <= steps; ++k) {
+                double t = std::min(k * EVALUATION_STEP_SECONDS, horizon_seconds);
+                double px = dp.x + track.velocity.x * t;
+                double py = dp.y + track.velocity.y * t;
+                double pz = dz + track.vertical_rate_fps * t;
+                for (size_t o = 0; o < count; ++o) {
+                    double hx = px - vx[o] * t;
+                    double hy = py - vy[o] * t;
+                    double hz = pz - vz[o] * t;
+                    double m = std::max((hx * hx + hy * hy) * inv_lat_sq, hz * hz * inv_vert_sq);
+                    margin_sq[o] = std::min(margin_sq[o], m);
+                }
+            }
+        }
+    }
+    
+    double evaluate_option(
+        const SeparationStandards::AircraftState& ownship,
+        const std::vector<ThreatTrack>& tracks,
+        double heading_change,
+        double vertical_rate_fpm)
+    {
+        Vector2D velocity = rotate(ownship.velocity, heading_change);
+        option_vx.assign(1, velocity.x);
+        option_vy.assign(1, velocity.y);
+        option_vz.assign(1, vertical_rate_fpm / 60.0);
+        option_margin_sq.assign(1, std::numeric_limits<double>::infinity());
+        accumulate_margins(ownship, tracks, 1);
+        return std::sqrt(option_margin_sq[0]);
+    }
+    
+    Resolution make_resolution(
+        const SeparationStandards::AircraftState& ownship,
+        double heading_change,
+        double vertical_rate_fpm,
+        double margin) const
+    {
+        Resolution result;
+        result.heading_change_degrees = heading_change;
+        result.vertical_rate_fpm = vertical_rate_fpm;
+        result.minimum_margin = margin;
+        result.resolves_all_threats = margin >= 1.0;
+        
+        AvoidanceManeuver::ManeuverType type = AvoidanceManeuver::ManeuverType::None;
+        if (heading_change != 0.0) {
+            type = heading_change > 0.0 ? AvoidanceManeuver::ManeuverType::TurnRight
+                                        : AvoidanceManeuver::ManeuverType::TurnLeft;
+        } else if (vertical_rate_fpm != 0.0) {
+            type = vertical_rate_fpm > 0.0 ? AvoidanceManeuver::ManeuverType::ClimbTo
+                                           : AvoidanceManeuver::ManeuverType::DescentTo;
+        }
+        
+        AvoidanceManeuver& maneuver = result.maneuver;
+        maneuver = AvoidanceManeuver(type);
+        maneuver.heading_change_degrees = heading_change;
+        maneuver.vertical_rate_fpm = vertical_rate_fpm;
+        maneuver.new_heading_true = std::fmod(ownship.heading_true + heading_change + 360.0, 360.0);
+        maneuver.new_altitude_feet = ownship.altitude_feet + vertical_rate_fpm / 60.0 * horizon_seconds;
+        maneuver.new_speed_knots = ownship.groundspeed_knots;
+        maneuver.duration_seconds = horizon_seconds;
+        maneuver.pilot_workload = 20.0 + std::abs(heading_change) * 0.5 + (vertical_rate_fpm != 0.0 ? 15.0 : 0.0);
+        
+        std::string description;
+        if (heading_change != 0.0) {
+            description = (heading_change > 0.0 ? "Turn right " : "Turn left ") +
+                          std::to_string(static_cast<int>(std::abs(heading_change))) + " degrees";
+        }
+        if (vertical_rate_fpm != 0.0) {
+            if (!description.empty()) description += ", ";
+            description += (vertical_rate_fpm > 0.0 ? "climb " : "descend ") +
+                           std::to_string(static_cast<int>(std::abs(vertical_rate_fpm))) + " fpm";
+        }
+        maneuver.description = description.empty() ? "Maintain course" : description;
+        return result;
+    }
+};
+
 // ============================================================================
 // PART 3.5: Multi-Aircraft Conflict Resolution
 // ============================================================================
@@ -701,6 +1669,7 @@ class ConflictResolver {
 private:
     std::map<int, AvoidanceManeuver> resolution_orders;
     const ManeuverSelector* maneuver_selector;
+    CoordinatedManeuverSolver* coordinated_solver;
     
 public:
     struct ResolutionPlan {
@@ -713,17 +1682,27 @@ public:
             : plan_effectiveness(0.0), resolves_all_conflicts(false) {}
     };
     
-    ConflictResolver() : maneuver_selector(nullptr) {}
+    ConflictResolver() : maneuver_selector(nullptr), coordinated_solver(nullptr) {}
     
     void set_maneuver_selector(const ManeuverSelector* selector) {
         maneuver_selector = selector;
     }
     
+    // When set, each aircraft gets one maneuver solved against all of its
+    // threats at once instead of one per pair
+    void set_coordinated_solver(CoordinatedManeuverSolver* solver) {
+        coordinated_solver = solver;
+    }
+    
     // Resolve conflicts for multiple aircraft pairs
     ResolutionPlan resolve_multi_aircraft_conflicts(
         const std::vector<ConflictPredictor::ConflictAlert>& conflicts,
         const std::map<int, SeparationStandards::AircraftState>& aircraft_states) const
     {
+        if (coordinated_solver) {
+            return resolve_coordinated(conflicts, aircraft_states);
+        }
+        
         ResolutionPlan plan;
         
         if (!maneuver_selector || conflicts.empty()) {
@@ -769,6 +1748,53 @@ public:
         
         return plan;
     }
+    
+private:
+    // Aircraft are solved in order of their most urgent conflict; each sees
+    // the maneuvers already planned for the others, so senses complement
+    // rather than mirror each other. An aircraft whose threats are already
+    // resolved by earlier plans keeps its course.
+    ResolutionPlan resolve_coordinated(
+        const std::vector<ConflictPredictor::ConflictAlert>& conflicts,
+        const std::map<int, SeparationStandards::AircraftState>& aircraft_states) const
+    {
+        ResolutionPlan plan;
+        plan.resolution_strategy = "Coordinated multi-threat resolution";
+        if (conflicts.empty()) {
+            plan.resolves_all_conflicts = true;
+            return plan;
+        }
+        
+        std::vector<int> order;
+        std::map<int, std::vector<SeparationStandards::AircraftState>> threats;
+        for (const auto& conflict : conflicts) {
+            auto ac1_it = aircraft_states.find(conflict.aircraft1_id);
+            auto ac2_it = aircraft_states.find(conflict.aircraft2_id);
+            if (ac1_it == aircraft_states.end() || ac2_it == aircraft_states.end()) {
+                continue;
+            }
+            for (int id : {conflict.aircraft1_id, conflict.aircraft2_id}) {
+                if (threats.count(id) == 0) order.push_back(id);
+            }
+            threats[conflict.aircraft1_id].push_back(ac2_it->second);
+            threats[conflict.aircraft2_id].push_back(ac1_it->second);
+        }
+        
+        bool resolved = true;
+        double worst_margin = std::numeric_limits<double>::infinity();
+        for (int id : order) {
+            auto result = coordinated_solver->solve(aircraft_states.at(id), threats[id], &plan.aircraft_maneuvers);
+            resolved = resolved && result.resolves_all_threats;
+            worst_margin = std::min(worst_margin, result.minimum_margin);
+            if (result.maneuver.maneuver_type != AvoidanceManeuver::ManeuverType::None) {
+                plan.aircraft_maneuvers[id] = result.maneuver;
+            }
+        }
+        
+        plan.resolves_all_conflicts = resolved;
+        plan.plan_effectiveness = 100.0 * std::min(worst_margin, 1.0);
+        return plan;
+    }
 };
 
 } // namespace Collision
@@ -10,14 +10,69 @@
 #ifndef CONFIG_PARSER_H
 #define CONFIG_PARSER_H
 
+#include <cstdint>
+#include <memory>
 #include <string>
-#include <map>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 namespace AICopilot {
 
+/**
+ * One INI/CFG file parsed in a single pass
+ *
+ * The file is read once into an owned buffer and every section, key and
+ * value is a string_view into it, so nothing is copied per entry. Entries
+ * are sorted by (section, key) for binary search; a key repeated in a
+ * section keeps its last value. Mapping the file was avoided on purpose:
+ * aircraft.cfg files are edited in place, and a truncated mapping faults.
+ *
+ * Immutable once loaded and shared between readers through load().
+ */
+class ParsedConfig {
+public:
+    struct Entry {
+        std::string_view section;
+        std::string_view key;
+        std::string_view value;
+    };
+
+    // Parse text; views refer to the returned object's copy
+    static std::shared_ptr<const ParsedConfig> fromText(std::string text);
+
+    // Parsed file from the process-wide cache, reparsed when its size or
+    // modification time changes; nullptr if the file can't be read
+    static std::shared_ptr<const ParsedConfig> load(const std::string& filePath);
+
+    // Drop every cached parse (readers keep the ones they hold)
+    static void clearCache();
+    static size_t cacheSize();
+
+    // Value for section/key, or nullptr
+    const std::string_view* find(std::string_view section, std::string_view key) const;
+
+    bool hasSection(std::string_view section) const;
+
+    // Sorted, including sections without keys
+    const std::vector<std::string_view>& sections() const { return sections_; }
+
+    // Entries in one section, sorted by key
+    std::pair<const Entry*, const Entry*> sectionEntries(std::string_view section) const;
+
+private:
+    ParsedConfig() = default;
+    void parse();
+
+    std::string text_;
+    std::vector<Entry> entries_;
+    std::vector<std::string_view> sections_;
+};
+
 /**
  * Generic INI/CFG file parser for aircraft.cfg and .FLT files
+ * Parses through the ParsedConfig cache, so loading the same file from
+ * several parsers reads it once.
  */
 class ConfigParser {
 public:
@@ -30,6 +85,10 @@ public:
     std::string getValue(const std::string& section, const std::string& key, 
                         const std::string& defaultValue = "") const;
     
+    // Value as a view into the parsed file; valid while this parser holds it
+    std::string_view getView(std::string_view section, std::string_view key,
+                             std::string_view defaultValue = {}) const;
+    
     int getIntValue(const std::string& section, const std::string& key, 
                     int defaultValue = 0) const;
     
@@ -51,15 +110,14 @@ public:
     // Get all keys in a section
     std::vector<std::string> getKeys(const std::string& section) const;
     
+    // Parsed file shared with the cache, or nullptr before parse()
+    std::shared_ptr<const ParsedConfig> getParsed() const { return config_; }
+    
     // Clear all data
     void clear();
     
 private:
-    // Map of section -> (key -> value)
-    std::map<std::string, std::map<std::string, std::string>> data_;
-    
-    std::string trim(const std::string& str) const;
-    std::string toLower(const std::string& str) const;
+    std::shared_ptr<const ParsedConfig> config_;
 };
 
 } // namespace AICopilot
@@ -0,0 +1,169 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef CONTROL_COMMAND_BUFFER_HPP
+#define CONTROL_COMMAND_BUFFER_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace AICopilot {
+
+/**
+ * Continuous control targets that can be written once per control cycle
+ */
+enum class ControlChannel : uint8_t {
+    THROTTLE,            // 0.0 to 1.0
+    ELEVATOR,            // -1.0 to 1.0 (positive = nose up)
+    AILERON,             // -1.0 to 1.0
+    RUDDER,              // -1.0 to 1.0
+    AP_HEADING,          // degrees
+    AP_ALTITUDE,         // feet
+    AP_SPEED,            // knots
+    AP_VERTICAL_SPEED,   // feet per minute
+    COUNT
+};
+
+/**
+ * Per-tick control command buffer
+ *
+ * Writes to the same channel within a tick are coalesced (last value wins),
+ * and values within the channel deadband of the last flushed value are
+ * dropped. drain() hands every pending channel to a sink exactly once so
+ * the caller can emit a single combined SimConnect transfer per cycle.
+ */
+class ControlCommandBuffer {
+public:
+    static constexpr size_t CHANNEL_COUNT = static_cast<size_t>(ControlChannel::COUNT);
+
+    struct Statistics {
+        uint64_t writes = 0;       // write() calls
+        uint64_t coalesced = 0;    // writes that replaced a pending value
+        uint64_t suppressed = 0;   // writes dropped by the deadband
+        uint64_t flushed = 0;      // channel values handed to a sink
+        uint64_t flushes = 0;      // drain() calls that emitted anything
+    };
+
+    ControlCommandBuffer() {
+        // Defaults sized to the resolution the sim can actually resolve
+        setDeadband(ControlChannel::THROTTLE, 0.002);
+        setDeadband(ControlChannel::ELEVATOR, 0.001);
+        setDeadband(ControlChannel::AILERON, 0.001);
+        setDeadband(ControlChannel::RUDDER, 0.001);
+        setDeadband(ControlChannel::AP_HEADING, 0.5);
+        setDeadband(ControlChannel::AP_ALTITUDE, 10.0);
+        setDeadband(ControlChannel::AP_SPEED, 0.5);
+        setDeadband(ControlChannel::AP_VERTICAL_SPEED, 10.0);
+    }
+
+    void setDeadband(ControlChannel channel, double deadband) {
+        slots_[index(channel)].deadband = std::abs(deadband);
+    }
+
+    double getDeadband(ControlChannel channel) const {
+        return slots_[index(channel)].deadband;
+    }
+
+    // Queue a value; returns false if the deadband suppressed it
+    bool write(ControlChannel channel, double value) {
+        Slot& slot = slots_[index(channel)];
+        stats_.writes++;
+
+        if (!slot.pending && slot.hasSent &&
+            std::abs(value - slot.lastSent) < slot.deadband) {
+            stats_.suppressed++;
+            return false;
+        }
+
+        if (slot.pending) {
+            stats_.coalesced++;
+            // Returning to the flushed value cancels the pending write
+            if (slot.hasSent && std::abs(value - slot.lastSent) < slot.deadband) {
+                slot.pending = false;
+                pendingCount_--;
+                return false;
+            }
+        } else {
+            slot.pending = true;
+            pendingCount_++;
+        }
+
+        slot.value = value;
+        return true;
+    }
+
+    bool hasPending() const { return pendingCount_ > 0; }
+    size_t pendingCount() const { return pendingCount_; }
+
+    // Pending value for a channel, if any
+    bool peek(ControlChannel channel, double& valueOut) const {
+        const Slot& slot = slots_[index(channel)];
+        if (!slot.pending) return false;
+        valueOut = slot.value;
+        return true;
+    }
+
+    // Hand every pending value to sink(ControlChannel, double, size_t emitIndex)
+    // and mark it sent; emitIndex counts 0..n-1 for packing into a flat buffer
+    template<typename Sink>
+    size_t drain(Sink&& sink) {
+        size_t emitted = 0;
+        if (pendingCount_ == 0) return emitted;
+
+        for (size_t i = 0; i < CHANNEL_COUNT; ++i) {
+            Slot& slot = slots_[i];
+            if (!slot.pending) continue;
+
+            sink(static_cast<ControlChannel>(i), slot.value, emitted);
+            slot.lastSent = slot.value;
+            slot.hasSent = true;
+            slot.pending = false;
+            emitted++;
+        }
+
+        pendingCount_ = 0;
+        stats_.flushed += emitted;
+        stats_.flushes++;
+        return emitted;
+    }
+
+    // Forget flushed values (e.g. after reconnect) so the next write always goes out
+    void reset() {
+        for (auto& slot : slots_) {
+            slot.pending = false;
+            slot.hasSent = false;
+        }
+        pendingCount_ = 0;
+    }
+
+    const Statistics& getStatistics() const { return stats_; }
+
+private:
+    struct Slot {
+        double value = 0.0;
+        double lastSent = 0.0;
+        double deadband = 0.0;
+        bool pending = false;
+        bool hasSent = false;
+    };
+
+    static size_t index(ControlChannel channel) {
+        return static_cast<size_t>(channel);
+    }
+
+    std::array<Slot, CHANNEL_COUNT> slots_{};
+    size_t pendingCount_ = 0;
+    Statistics stats_;
+};
+
+} // namespace AICopilot
+
+#endif // CONTROL_COMMAND_BUFFER_HPP
@@ -152,22 +152,7 @@ public:
             return polarDistance(lat1, lon1, lat2, lon2);
         }
         
-        double lat1Rad = lat1 * CoordinateConstants::DEG_TO_RAD;
-        double lon1Rad = lon1 * CoordinateConstants::DEG_TO_RAD;
-        double lat2Rad = lat2 * CoordinateConstants::DEG_TO_RAD;
-        double lon2Rad = lon2 * CoordinateConstants::DEG_TO_RAD;
-
-        double dLat = lat2Rad - lat1Rad;
-        double dLon = lon2Rad - lon1Rad;
-
-        double a = std::sin(dLat / 2.0) * std::sin(dLat / 2.0) +
-                   std::cos(lat1Rad) * std::cos(lat2Rad) *
-                   std::sin(dLon / 2.0) * std::sin(dLon / 2.0);
-
-        double c = 2.0 * std::atan2(std::sqrt(a), std::sqrt(1.0 - a));
-        double distance = CoordinateConstants::EARTH_RADIUS_NM * c;
-
-        return distance;
+        return Geodesy::haversineNM(lat1, lon1, lat2, lon2);
     }
 
     /**
@@ -279,21 +264,7 @@ public:
      * Calculate initial bearing from point 1 to point 2 (degrees)
      */
     static double calculateBearing(double lat1, double lon1, double lat2, double lon2) {
-        double lat1Rad = lat1 * CoordinateConstants::DEG_TO_RAD;
-        double lon1Rad = lon1 * CoordinateConstants::DEG_TO_RAD;
-        double lat2Rad = lat2 * CoordinateConstants::DEG_TO_RAD;
-        double lon2Rad = lon2 * CoordinateConstants::DEG_TO_RAD;
-
-        double dLon = lon2Rad - lon1Rad;
-
-        double y = std::sin(dLon) * std::cos(lat2Rad);
-        double x = std::cos(lat1Rad) * std::sin(lat2Rad) -
-                   std::sin(lat1Rad) * std::cos(lat2Rad) * std::cos(dLon);
-
-        double bearing = std::atan2(y, x) * CoordinateConstants::RAD_TO_DEG;
-        bearing = std::fmod(bearing + 360.0, 360.0);  // Normalize to 0-360
-
-        return bearing;
+        return Geodesy::initialBearing(lat1, lon1, lat2, lon2);
     }
 
     /**
@@ -0,0 +1,33 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* CPU Features - runtime instruction set detection for kernel dispatch
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef CPU_FEATURES_HPP
+#define CPU_FEATURES_HPP
+
+namespace AICopilot {
+
+/**
+ * What the running CPU supports, detected once on first use
+ *
+ * Kernels built with ENABLE_AVX2 live in their own translation units
+ * compiled for AVX2; their dispatchers check here before calling them, so
+ * the same binary still runs on older CPUs with the portable kernels.
+ */
+namespace CpuFeatures {
+
+// AVX2 instructions and OS support for saving the YMM registers
+bool hasAvx2();
+
+} // namespace CpuFeatures
+
+} // namespace AICopilot
+
+#endif // CPU_FEATURES_HPP
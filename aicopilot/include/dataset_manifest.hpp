@@ -0,0 +1,118 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Dataset Manifest - content-hashed pack lists for distributing shared data
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#pragma once
+
+#include "dataset_reloader.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+
+enum class DatasetKind : uint8_t {
+    NAVDATA_PACK,
+    TERRAIN_PACK,
+    RUNWAY_PACK,
+    WEATHER_SNAPSHOT,
+    MODEL_PACK
+};
+
+const char* datasetKindName(DatasetKind kind);
+
+/**
+ * One immutable file, named by what is in it
+ */
+struct DatasetEntry {
+    DatasetKind kind = DatasetKind::NAVDATA_PACK;
+    uint64_t contentHash = 0;       // FNV-1a 64 of the whole file
+    uint64_t size = 0;              // bytes
+    std::string name;               // for people: "navdata-2411.pack"
+
+    bool sameContent(const DatasetEntry& other) const {
+        return contentHash == other.contentHash && size == other.size;
+    }
+};
+
+// FNV-1a 64 of a file, read in chunks; false if it cannot be read
+bool hashDatasetFile(const std::string& path, uint64_t& hash, uint64_t& size);
+
+/**
+ * The datasets a fleet flies with, as one text file
+ *
+ *   AICOPILOT-DATASETS 1
+ *   <kind> <hash, 16 hex digits> <size> <name>
+ *   ...
+ *
+ * The coordinator publishes one manifest; every node fetches the entries
+ * its store lacks and loads them from there. Since a file is named by its
+ * hash, a node never loads a half-copied or stale pack under a good name,
+ * and a dataset shared by successive manifests is fetched once.
+ */
+class DatasetManifest {
+public:
+    // Hash a file and add it; false if it cannot be read
+    bool addFile(DatasetKind kind, const std::string& path, const std::string& name = "");
+    void add(const DatasetEntry& entry) { entries_.push_back(entry); }
+
+    const std::vector<DatasetEntry>& entries() const { return entries_; }
+    size_t size() const { return entries_.size(); }
+
+    // First entry of a kind, or nullptr
+    const DatasetEntry* find(DatasetKind kind) const;
+
+    std::string serialize() const;
+    // Replaces the entries; false (and empty) on a malformed manifest
+    bool parse(const std::string& text);
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    // Identity of the whole set, so nodes can tell they run the same data
+    uint64_t fingerprint() const;
+
+private:
+    std::vector<DatasetEntry> entries_;
+};
+
+/**
+ * Node-local content-addressed directory of dataset files
+ *
+ * Files live at <directory>/<hash>.<kind>. import() copies a fetched file
+ * in only if it hashes to the entry, writing to a temporary name first, so
+ * readers only ever see complete files.
+ */
+class DatasetStore {
+public:
+    explicit DatasetStore(std::string directory);
+
+    const std::string& getDirectory() const { return directory_; }
+    std::string pathFor(const DatasetEntry& entry) const;
+
+    // Present with the right size (the hash was checked on import)
+    bool contains(const DatasetEntry& entry) const;
+
+    // Entries of a manifest still to fetch
+    std::vector<DatasetEntry> missing(const DatasetManifest& manifest) const;
+
+    // Copy sourcePath in under the entry's name; false if it does not
+    // match the entry or cannot be written
+    bool import(const DatasetEntry& entry, const std::string& sourcePath);
+
+    // Store paths for the manifest's reloadable datasets, for DatasetReloader;
+    // empty for a kind the manifest lacks or the store does not hold yet
+    DatasetReloadPaths reloadPaths(const DatasetManifest& manifest) const;
+
+private:
+    std::string directory_;
+};
+
+} // namespace AICopilot
@@ -0,0 +1,86 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Dataset Reloader - swaps in new navdata, runway and weather data while
+* pilots keep flying
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#pragma once
+
+#include <future>
+#include <memory>
+#include <string>
+
+namespace AICopilot {
+
+class NavigationDatabase;
+class RunwayDatabase;
+class WeatherDatabase;
+
+/**
+ * Files for one reload; an empty path leaves that store as it is
+ */
+struct DatasetReloadPaths {
+    std::string navdataPack;                    // NavigationDatabase::LoadSnapshot()
+    std::string runwayPack;                     // RunwayDatabase::LoadPack()
+    std::string weatherSnapshot;                // WeatherDatabase::loadSnapshot()
+};
+
+/**
+ * Outcome of one reload, per store
+ */
+struct DatasetReloadResult {
+    bool navdataRequested = false;
+    bool navdataLoaded = false;
+    bool runwaysRequested = false;
+    bool runwaysLoaded = false;
+    bool weatherRequested = false;
+    int weatherReports = -1;                    // loadSnapshot() result
+    
+    // Every requested store took its new data
+    bool ok() const {
+        return (!navdataRequested || navdataLoaded) && (!runwaysRequested || runwaysLoaded) &&
+               (!weatherRequested || weatherReports >= 0);
+    }
+};
+
+/**
+ * Reload command for the shared data stores
+ *
+ * Each store already publishes immutable versions: it builds the next one
+ * off to the side, checks it (CheckDatabaseConsistency() for navdata and
+ * runways, the snapshot checksums for weather) and swaps it in atomically.
+ * Readers never lock, and anything holding the old version - a navdata
+ * pack, procedure paths, a RunwaySpan, a store snapshot - keeps it until it
+ * lets go, so routes in flight finish on the data they started with.
+ *
+ * reload() runs the loads as one job on IoExecutor::shared(), one store
+ * after another, and holds the stores until it is done. Stores swap
+ * independently: a rejected runway pack does not undo a navdata cycle that
+ * was already taken, and the result says which ones moved.
+ */
+class DatasetReloader {
+public:
+    // Any store may be null; paths for it are then reported as not loaded
+    DatasetReloader(std::shared_ptr<NavigationDatabase> navdata,
+                    std::shared_ptr<RunwayDatabase> runways,
+                    std::shared_ptr<WeatherDatabase> weather);
+    
+    // Load and swap on the calling thread
+    DatasetReloadResult reload(const DatasetReloadPaths& paths);
+    
+    // Load and swap in the background; queries see the old data until then
+    std::future<DatasetReloadResult> reloadAsync(const DatasetReloadPaths& paths);
+    
+private:
+    std::shared_ptr<NavigationDatabase> navdata_;
+    std::shared_ptr<RunwayDatabase> runways_;
+    std::shared_ptr<WeatherDatabase> weather_;
+};
+
+} // namespace AICopilot
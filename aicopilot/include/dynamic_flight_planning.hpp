@@ -20,8 +20,17 @@
 
 #include "aicopilot_types.h"
 #include "aircraft_profile.h"
+#include "airspace_database.hpp"
+#include "weather_system.h"
+#include "hazard_grid.hpp"
+#include "incremental_route_planner.hpp"
+#include "procedure_paths.hpp"
+#include "taf_store.hpp"
+#include "wind_grid.hpp"
+#include "work_stealing_pool.hpp"
 #include <vector>
 #include <memory>
+#include <string>
 
 namespace AICopilot {
 
@@ -32,6 +41,24 @@ namespace AICopilot {
  * weather conditions, and dynamic SID/STAR selection.
  */
 
+/**
+ * Wind layer information
+ */
+struct WindLayer {
+    double altitude;           // feet MSL
+    double windSpeed;          // knots
+    double windDirection;      // degrees
+};
+
+/**
+ * Wind conditions
+ */
+struct WindConditions {
+    std::vector<WindLayer> layers;
+    double surfaceWindSpeed;   // knots
+    double surfaceWindDirection;  // degrees
+};
+
 // Optimization objective
 enum class OptimizationObjective {
     FUEL_EFFICIENCY,      // Minimize fuel consumption
@@ -112,6 +139,8 @@ class DynamicFlightPlanning {
 public:
     DynamicFlightPlanning();
     ~DynamicFlightPlanning();
+    DynamicFlightPlanning(const DynamicFlightPlanning&) = delete;
+    DynamicFlightPlanning& operator=(const DynamicFlightPlanning&) = delete;
     
     /**
      * Initialize flight planning system
@@ -129,6 +158,10 @@ public:
     
     /**
      * Optimize route for given objective
+     *
+     * Legs join each fix to the next few, so directs that skip fixes are
+     * considered, and are priced by time in the current winds; legs through
+     * a hazard are closed. The search is kept for reoptimizeMidFlight().
      */
     RouteOptimization optimizeRoute(
         const Waypoint& departure,
@@ -140,6 +173,9 @@ public:
     
     /**
      * Calculate optimal cruise altitude
+     *
+     * Picks the balanced point of the last optimizeTradeSpace() front when
+     * there is one.
      */
     AltitudeOptimization calculateOptimalAltitude(
         double distance,
@@ -156,6 +192,9 @@ public:
     
     /**
      * Reoptimize active flight plan (mid-flight adjustment)
+     *
+     * For the destination of the last optimizeRoute() this repairs the kept
+     * search from the current position instead of planning again.
      */
     RouteOptimization reoptimizeMidFlight(
         const Position& currentPosition,
@@ -167,8 +206,17 @@ public:
     // SID/STAR SELECTION AND PLANNING
     // ============================================================
     
+    /**
+     * SID/STAR paths procedures are selected from, e.g.
+     * NavigationDatabase::GetProcedurePaths(); nullptr uses generic procedures
+     */
+    void setProcedurePaths(std::shared_ptr<const ProcedurePathTable> paths);
+    
     /**
      * Select optimal SID (Standard Instrument Departure)
+     *
+     * With procedure paths, the SID whose exit is nearest the first
+     * cruise fix.
      */
     DepartureProcedure selectOptimalSID(
         const std::string& departureAirport,
@@ -177,6 +225,9 @@ public:
     
     /**
      * Select optimal STAR (Standard Arrival Route)
+     *
+     * With procedure paths, the STAR transition for the runway whose
+     * entry is nearest the current position.
      */
     ArrivalProcedure selectOptimalSTAR(
         const std::string& arrivalAirport,
@@ -216,6 +267,29 @@ public:
         double cruiseSpeed,
         const Waypoint& alternate);
     
+    /**
+     * calculateFuelRequirement() for each of many alternates of one route
+     *
+     * Trip fuel is priced once; each alternate adds only its closed-form
+     * reserves, so fifty alternates cost about as much as one.
+     */
+    std::vector<FuelCalculation> calculateFuelRequirements(
+        const std::vector<Waypoint>& route,
+        double cruiseAltitude,
+        double cruiseSpeed,
+        const std::vector<Waypoint>& alternates,
+        double contingencyPercentage = 5.0);
+    
+    /**
+     * Indices of the alternates checkFuelFeasibility() accepts, ascending
+     */
+    std::vector<size_t> findFeasibleAlternates(
+        const std::vector<Waypoint>& route,
+        double currentFuel,
+        double cruiseAltitude,
+        double cruiseSpeed,
+        const std::vector<Waypoint>& alternates);
+    
     /**
      * Calculate range with current fuel
      */
@@ -227,6 +301,9 @@ public:
     
     /**
      * Calculate optimal cruise speed for fuel efficiency
+     *
+     * Chosen from the last optimizeTradeSpace() front when it has points at
+     * the altitude.
      */
     double calculateOptimalCruiseSpeed(
         double altitude,
@@ -239,13 +316,66 @@ public:
     
     /**
      * Plan weather divert en-route
+     *
+     * Reroutes around the hazards to the original destination when the kept
+     * route allows it with the fuel on board, else diverts to the nearest
+     * alternate. With forecasts set, that is the nearest alternate whose
+     * worst TAF conditions at its ETA still allow a landing; alternates
+     * without a TAF come after those, and the nearest of all is the last
+     * resort.
+     * @param now Unix time ETAs are counted from
      */
     RouteOptimization planWeatherDivert(
         const Position& currentPosition,
         const Waypoint& originalDestination,
         const std::vector<Waypoint>& availableAlternates,
         double currentFuel,
-        const std::vector<WeatherHazard>& activeHazards);
+        const std::vector<WeatherHazard>& activeHazards,
+        time_t now = std::time(nullptr));
+    
+    /**
+     * Terminal forecasts alternates are checked against; nullptr to pick
+     * by distance alone
+     */
+    void setForecasts(std::shared_ptr<const TAFStore> forecasts);
+    
+    /**
+     * Update the winds used to price the kept route's legs
+     * @return Number of legs whose cost changed noticeably
+     */
+    size_t updateWinds(const WindConditions& windAloft);
+    
+    /**
+     * Use a gridded wind and temperature field instead of the WindConditions layers
+     *
+     * Route fuel, wind-optimized altitude, step climbs and the kept route's
+     * legs are then evaluated against the grid, each in one batch.
+     * @param grid Field to use; nullptr goes back to the layers
+     * @param timeSeconds Valid time legs are evaluated at, in the grid's time base
+     * @return Number of legs of the kept route whose cost changed noticeably
+     */
+    size_t setWindGrid(std::shared_ptr<const WindGrid> grid, double timeSeconds = 0.0);
+    
+    /**
+     * Update the hazards that close the kept route's legs
+     *
+     * Hazards are kept in a HazardGrid by index, so a cell that moved
+     * re-rasterizes only its own tiles, and a leg clear of every occupied
+     * cell is priced without checking any hazard.
+     * @return Number of legs whose cost changed
+     */
+    size_t updateHazards(const std::vector<WeatherHazard>& hazards);
+    
+    /**
+     * Price route legs through airspace
+     *
+     * Each leg is flown as if it were longer by AirspaceDatabase::segmentCost()
+     * at the route altitude, so a leg through a closed class is closed.
+     * @param airspace Volumes to check; nullptr ignores airspace
+     * @return Number of legs of the kept route whose cost changed noticeably
+     */
+    size_t setAirspace(std::shared_ptr<const AirspaceDatabase> airspace,
+                       const AirspaceCostWeights& weights);
     
     /**
      * Adjust altitude for traffic separation
@@ -319,6 +449,48 @@ public:
         double currentFuel,
         double distanceRemaining);
     
+    /**
+     * One cruise profile of the altitude / speed trade space
+     */
+    struct TradeSpacePoint {
+        double altitude;               // initial cruise level, feet MSL
+        double cruiseSpeed;            // knots TAS, held for the whole cruise
+        double stepAltitude;           // level after the step climb; altitude if none
+        double stepDistance;           // NM from the route start to the step; 0 if none
+        double estimatedTime;          // minutes
+        double estimatedFuel;          // gallons
+    };
+    struct TradeSpaceResult {
+        std::vector<TradeSpacePoint> paretoFront;  // fastest first, each burning less than the last
+        size_t candidatesEvaluated;
+        double executionTime;          // ms
+    };
+    
+    /**
+     * Evaluate every cruise level x speed x step climb for a route
+     *
+     * Levels are every 1000 ft up to the service ceiling, speeds 70-100% of
+     * cruise TAS, steps 2000 or 4000 ft at any ~50 NM segment boundary. Each
+     * level is a job on the thread pool, reading a snapshot of the winds (the
+     * wind grid when set) through its own leg batch. The front is kept for
+     * calculateOptimalAltitude() and calculateOptimalCruiseSpeed().
+     */
+    TradeSpaceResult optimizeTradeSpace(const std::vector<Waypoint>& route);
+    
+    /**
+     * Pick the point of a trade-space front that best meets an objective
+     * @return All zero if the front is empty
+     */
+    TradeSpacePoint selectTradeSpacePoint(
+        const TradeSpaceResult& tradeSpace,
+        OptimizationObjective objective) const;
+    
+    /**
+     * Share a pool for optimizeTradeSpace(); one with a thread per core is
+     * created on first use otherwise. Don't call from one of its own jobs.
+     */
+    void setThreadPool(std::shared_ptr<WorkStealingPool> pool);
+    
     /**
      * Get optimal descent profile
      */
@@ -335,10 +507,81 @@ public:
         double distance,
         const WindConditions& windAloft);
     
+    /**
+     * calculateOptimalDescentProfile() from one state to each target altitude
+     */
+    std::vector<DescentProfile> calculateOptimalDescentProfiles(
+        double currentAltitude,
+        double currentSpeed,
+        const std::vector<double>& targetAltitudes,
+        const WindConditions& windAloft);
+    
 private:
     PerformanceProfile profile_;
     bool initialized_;
     
+    // Route graph and search state kept from the last optimizeRoute()
+    struct RouteLeg {
+        uint32_t from;
+        uint32_t to;
+        uint32_t edge;
+        bool retired;                  // leaves an earlier mid-flight position
+    };
+    IncrementalRoutePlanner routeSearch_;
+    std::vector<Waypoint> routeNodes_;   // filed fixes, then mid-flight positions
+    std::vector<RouteLeg> routeLegs_;
+    size_t filedNodeCount_;
+    size_t nextFiledNode_;               // first filed fix still ahead
+    uint32_t routeStart_;
+    std::vector<uint32_t> routePath_;    // route being flown, as last planned
+    WindConditions routeWinds_;
+    std::vector<WeatherHazard> routeHazards_;
+    HazardGrid hazardGrid_;                      // routeHazards_, by index
+    std::vector<uint32_t> unplacedHazards_;      // indices the grid can't hold; checked one by one
+    mutable std::vector<uint32_t> legHazards_;
+    double heuristicSpeed_;              // knots; no leg is flown faster
+    
+    std::shared_ptr<const WindGrid> windGrid_;
+    double windTime_;
+    mutable WindGridLegBatch legBatch_;
+    
+    std::shared_ptr<const TAFStore> forecasts_;
+    std::shared_ptr<const AirspaceDatabase> airspace_;
+    AirspaceCostWeights airspaceWeights_;
+    std::shared_ptr<const ProcedurePathTable> procedurePaths_;
+    
+    std::shared_ptr<WorkStealingPool> pool_;
+    std::vector<TradeSpacePoint> tradeSpaceFront_;  // from the last optimizeTradeSpace()
+    double tradeSpaceDistance_;                     // NM of that route
+    
+    void buildRouteSearch(const std::vector<Waypoint>& route);
+    void addRouteLegs(uint32_t from, size_t firstFiledNode);
+    size_t refreshRouteCosts();
+    size_t repriceRouteLegs();
+    void setRouteHazards(const std::vector<WeatherHazard>& hazards);
+    bool legBlocked(const Position& from, const Position& to) const;
+    bool replanFrom(const Position& currentPosition, RouteOptimization& result);
+    void summarizeRoute(const std::vector<uint32_t>& path, double minutes, RouteOptimization& result);
+    double legMinutes(const Waypoint& from, const Waypoint& to) const;
+    double legAirspaceNM(const Position& from, const Position& to) const;
+    double terminalSpeed() const;        // knots over procedure legs
+    double routeWindSpeed(double altitude, double& direction) const;
+    double maxRouteWindSpeed() const;
+    void addGridLeg(const Position& from, const Position& to, double altitude, double tas) const;
+    double gridRouteMinutes(const std::vector<Waypoint>& route, size_t firstLeg) const;
+    size_t pickTradeSpacePoint(
+        const std::vector<TradeSpacePoint>& points,
+        OptimizationObjective objective) const;
+    
+    // Reserves and totals of a FuelCalculation around a priced trip fuel;
+    // destination is null for an empty route
+    void completeFuelCalculation(
+        double tripFuel,
+        const Waypoint* destination,
+        const Waypoint& alternate,
+        double contingencyPercentage,
+        FuelCalculation& result) const;
+    
     // Route optimization helpers
     double calculateRouteDistance(const std::vector<Waypoint>& route);
     double calculateRouteFuel(
@@ -358,24 +601,6 @@ private:
         double windDirection);
 };
 
-/**
- * Wind layer information
- */
-struct WindLayer {
-    double altitude;           // feet MSL
-    double windSpeed;          // knots
-    double windDirection;      // degrees
-};
-
-/**
- * Wind conditions
- */
-struct WindConditions {
-    std::vector<WindLayer> layers;
-    double surfaceWindSpeed;   // knots
-    double surfaceWindDirection;  // degrees
-};
-
 } // namespace AICopilot
 
 #endif // DYNAMIC_FLIGHT_PLANNING_HPP
@@ -22,7 +22,10 @@
 #include <string>
 #include <cstring>
 #include <chrono>
+#include <memory>
 #include <stdint.h>
+#include "striped_cache.hpp"
+#include "tile_cache.hpp"
 
 namespace AICopilot {
 
@@ -62,6 +65,7 @@ struct TerrainProfileEntry {
  */
 struct SlopeInfo {
     double angle_degrees;     ///< Slope angle (degrees)
+    double aspect_degrees;    ///< Downslope direction (degrees true, 0 when flat)
     double max_elevation;     ///< Maximum elevation in search area (feet)
     double min_elevation;     ///< Minimum elevation in search area (feet)
     bool is_steep;            ///< True if slope > 15 degrees
@@ -80,11 +84,10 @@ struct CacheEntry {
  * ElevationDatabase - High-performance elevation lookup system
  * 
  * Features:
- * - Thread-safe queries with LRU caching
+ * - Thread-safe queries with a lock-striped CLOCK cache
  * - Bilinear interpolation for sub-sample accuracy
  * - Support for multiple geographic regions
- * - Water body detection
- * - Slope angle calculations
+ * - Water mask, slope and aspect rasters derived per 1° tile on first use
  * - Terrain profile generation
  * - <1ms average query performance
  * - <50MB typical memory footprint
@@ -94,9 +97,14 @@ public:
     /// Elevation constraints (realistic ranges for aircraft operations)
     static constexpr double MIN_ELEVATION = -500.0;     ///< Feet MSL (Death Valley)
     static constexpr double MAX_ELEVATION = 29029.0;    ///< Feet MSL (Mt. Everest)
-    static constexpr double CACHE_PRECISION = 0.01;     ///< Cache grid size (degrees)
-    static constexpr size_t DEFAULT_CACHE_SIZE = 10000; ///< Maximum cache entries
+    static constexpr double CACHE_PRECISION = 0.01;     ///< Cache cell size (degrees)
+    static constexpr int CACHE_CELLS_PER_DEGREE = 100;  ///< 1 / CACHE_PRECISION
+    static constexpr size_t DEFAULT_CACHE_SIZE = 10000; ///< Maximum cached cells
     static constexpr double EARTH_RADIUS = 3440.065;    ///< Earth radius (nautical miles)
+    static constexpr double REGION_SAMPLE_RADIUS = 1.0; ///< Samples further away are not interpolated (degrees)
+    static constexpr double WATER_ELEVATION = 0.0;      ///< Posts at or below this are water (feet MSL)
+    static constexpr double STEEP_SLOPE = 15.0;         ///< Slope reported as steep (degrees)
+    static constexpr size_t DEFAULT_DERIVED_TILE_BUDGET = 32 * 1024 * 1024;  ///< Derived raster cache (bytes)
     
     /**
      * Constructor - initializes elevation database with default parameters
@@ -116,7 +124,7 @@ public:
     
     /**
      * Get elevation at latitude/longitude with bilinear interpolation
-     * Performs thread-safe LRU cached lookup
+     * Performs thread-safe cached lookup; only the key's cache stripe is locked
      * 
      * @param latitude Latitude in degrees (-90 to 90)
      * @param longitude Longitude in degrees (-180 to 180)
@@ -125,6 +133,17 @@ public:
      */
     double GetElevationAt(double latitude, double longitude);
     
+    /**
+     * Get elevations for many points at once
+     * Serves cached points first, then interpolates the misses and
+     * inserts them.
+     * 
+     * @param points Query points
+     * @param count Number of points
+     * @param out Output elevations in feet (MSL), count entries
+     */
+    void GetElevations(const LatLon* points, size_t count, double* out);
+    
     /**
      * Get terrain elevation profile along a path
      * Samples elevation at regular intervals between start and end points
@@ -152,7 +171,8 @@ public:
     
     /**
      * Check if coordinates represent a water body
-     * Uses elevation heuristics and known water body database
+     * Reads the nearest post of the tile's water mask: a loaded land-water
+     * raster when there is one, otherwise posts at or below WATER_ELEVATION
      * 
      * @param latitude Latitude in degrees
      * @param longitude Longitude in degrees
@@ -160,9 +180,19 @@ public:
      */
     bool IsWaterBody(double latitude, double longitude);
     
+    /**
+     * Water mask for many points at once
+     * 
+     * @param points Query points
+     * @param count Number of points
+     * @param out Output flags, count entries (false for invalid coordinates)
+     */
+    void IsWaterBody(const LatLon* points, size_t count, bool* out);
+    
     /**
      * Get terrain slope angle at coordinates
-     * Calculates slope from surrounding elevation samples
+     * Reads the nearest post of the tile's slope and aspect rasters; the
+     * elevation range covers that post and its eight neighbours
      * 
      * @param latitude Latitude in degrees
      * @param longitude Longitude in degrees
@@ -170,6 +200,31 @@ public:
      */
     SlopeInfo GetSlopeAngle(double latitude, double longitude);
     
+    /**
+     * Slope information for many points at once
+     * 
+     * @param points Query points
+     * @param count Number of points
+     * @param out Output slope information, count entries (zeroed for invalid coordinates)
+     */
+    void GetSlopeAngles(const LatLon* points, size_t count, SlopeInfo* out);
+    
+    /**
+     * Load a land-water raster for one 1° tile
+     * Rows run from the north edge and columns from the west edge, posts
+     * on both tile edges as in SRTM; any nonzero sample is water. The mask
+     * is resampled to the derived raster posts and replaces the
+     * elevation-based mask for that tile.
+     * 
+     * @param tile_latitude Latitude of the tile's south edge (degrees)
+     * @param tile_longitude Longitude of the tile's west edge (degrees)
+     * @param mask samples_per_side * samples_per_side samples
+     * @param samples_per_side Posts per side (at least 2)
+     * @return false if the tile or raster is invalid
+     */
+    bool LoadWaterMask(int tile_latitude, int tile_longitude,
+                       const uint8_t* mask, int samples_per_side);
+    
     /**
      * Get minimum safe altitude (terrain + clearance)
      * 
@@ -196,7 +251,7 @@ public:
     
     /**
      * Clear elevation cache
-     * Removes all cached elevation values, freeing memory
+     * Removes all cached elevation values and derived rasters, freeing memory
      */
     void ClearCache();
     
@@ -207,6 +262,20 @@ public:
      */
     std::pair<int64_t, int64_t> GetCacheStatistics() const;
     
+    /**
+     * Get full cell cache statistics, including stripe lock contention
+     * 
+     * @return Hit/miss/eviction/contention counters and occupancy
+     */
+    StripedCacheStats GetCellCacheStats() const { return elevation_cache_.getStats(); }
+    
+    /**
+     * Get derived raster cache statistics
+     * 
+     * @return Hit/miss/eviction counters, tiles and bytes of the slope/water tiles
+     */
+    TileCacheStats GetDerivedTileStats() const;
+    
     /**
      * Get cache memory usage
      * 
@@ -230,15 +299,32 @@ public:
     static bool ValidateCoordinates(double latitude, double longitude);
 
 private:
-    // LRU Cache management
-    std::unordered_map<uint64_t, double> elevation_cache_;  ///< Elevation cache
-    std::list<uint64_t> cache_order_;                       ///< LRU order tracking
-    size_t max_cache_size_;                                 ///< Maximum cache entries
-    mutable std::mutex cache_mutex_;                        ///< Thread synchronization
-    
-    // Cache statistics
-    mutable int64_t cache_hits_;    ///< Number of cache hits
-    mutable int64_t cache_misses_;  ///< Number of cache misses
+    /**
+     * Rasters derived from one 1° tile at CACHE_CELLS_PER_DEGREE posts
+     * Rows from the north edge, columns from the west edge, SIDE posts per
+     * side. The elevation grid has a one-post border taken from the
+     * neighbouring tiles so the Sobel kernel needs no edge cases and
+     * adjacent tiles agree along their shared edge.
+     */
+    struct DerivedTile {
+        static constexpr int SIDE = CACHE_CELLS_PER_DEGREE + 1;
+        static constexpr int PADDED = SIDE + 2;
+        
+        std::vector<float> elevation;    ///< PADDED * PADDED posts (feet)
+        std::vector<float> slope;        ///< SIDE * SIDE slope angles (degrees)
+        std::vector<float> aspect;       ///< SIDE * SIDE downslope bearings (degrees)
+        std::vector<uint8_t> water;      ///< SIDE * SIDE, 1 for water
+        
+        size_t memoryBytes() const;
+    };
+    
+    // Corner samples per CACHE_PRECISION cell, striped by cell key; also holds the hit/miss counters
+    StripedCache<CellCorners> elevation_cache_;
+    
+    // Derived rasters and loaded water masks (resampled to SIDE * SIDE), guarded by derived_mutex_
+    mutable std::mutex derived_mutex_;
+    TileCache<const DerivedTile> derived_tiles_;
+    std::unordered_map<TileKey, std::shared_ptr<const std::vector<uint8_t>>> water_masks_;
     
     // Regions
     std::vector<ElevationRegion> regions_;  ///< Geographic regions with elevation data
@@ -246,13 +332,62 @@ private:
     // Helper methods
     
     /**
-     * Create cache key from coordinates
+     * Locate the cache cell containing coordinates
+     * Every point in a cell shares its key; the fractions interpolate
+     * between the cell's cached corner samples.
      * 
      * @param latitude Latitude in degrees
      * @param longitude Longitude in degrees
-     * @return 64-bit cache key
+     * @return Cell at CACHE_CELLS_PER_DEGREE resolution
      */
-    uint64_t MakeKey(double latitude, double longitude) const;
+    RasterCell LocateCell(double latitude, double longitude) const;
+    
+    /**
+     * Interpolate and clamp the elevations at a cell's four corner posts
+     * 
+     * @param cell Cache cell
+     * @return Corner elevations (feet)
+     */
+    CellCorners SampleCellCorners(const RasterCell& cell);
+    
+    /**
+     * Interpolated elevation clamped to the valid range
+     * 
+     * @param latitude Latitude in degrees
+     * @param longitude Longitude in degrees
+     * @return Elevation (feet)
+     */
+    double SamplePost(double latitude, double longitude);
+    
+    /**
+     * Derived rasters of the tile containing coordinates
+     * Served from derived_tiles_; a missing tile is built without the lock
+     * held and then inserted
+     * 
+     * @param latitude Latitude in degrees
+     * @param longitude Longitude in degrees
+     * @param out_row Nearest post row in the tile
+     * @param out_col Nearest post column in the tile
+     * @return Tile rasters (never null)
+     */
+    std::shared_ptr<const DerivedTile> AcquireDerivedTile(double latitude, double longitude,
+                                                          int& out_row, int& out_col);
+    
+    /**
+     * Sample a tile's elevation posts and derive its slope, aspect and water rasters
+     * 
+     * @param tile_latitude Latitude of the tile's south edge (degrees)
+     * @param tile_longitude Longitude of the tile's west edge (degrees)
+     * @param water_mask Loaded land-water raster for the tile, or nullptr
+     * @return Derived tile
+     */
+    std::shared_ptr<const DerivedTile> BuildDerivedTile(int tile_latitude, int tile_longitude,
+                                                        const std::vector<uint8_t>* water_mask);
+    
+    /**
+     * Slope information at one post of a derived tile
+     */
+    static SlopeInfo ReadSlope(const DerivedTile& tile, int row, int col);
     
     /**
      * Interpolate elevation using bilinear interpolation
@@ -294,11 +429,6 @@ private:
      */
     double CalculateDistance(double lat1, double lon1, double lat2, double lon2) const;
     
-    /**
-     * Evict oldest cache entry (LRU)
-     */
-    void EvictOldestEntry();
-    
     /**
      * Initialize all geographic regions with elevation data
      */
@@ -38,6 +38,7 @@
 #ifndef ERROR_HANDLING_HPP
 #define ERROR_HANDLING_HPP
 
+#include "binary_log.hpp"
 #include <exception>
 #include <string>
 #include <sstream>
@@ -593,7 +594,12 @@ public:
         std::string formatted = ex.getFormattedMessage();
 
         if (logToConsole_) {
-            std::cerr << formatted << std::endl;
+            switch (ex.getSeverity()) {
+                case ErrorSeverity::INFO: AICOPILOT_LOG_INFO("{}", formatted); break;
+                case ErrorSeverity::WARNING: AICOPILOT_LOG_WARNING("{}", formatted); break;
+                case ErrorSeverity::ERROR: AICOPILOT_LOG_ERROR("{}", formatted); break;
+                default: AICOPILOT_LOG_CRITICAL("{}", formatted); break;
+            }
         }
 
         if (logToFile_ && !logFilePath_.empty()) {
@@ -0,0 +1,194 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Feature Index - incremental nearest-neighbour index over feature vectors
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef FEATURE_INDEX_HPP
+#define FEATURE_INDEX_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace AICopilot {
+
+struct EuclideanDistance {
+    template <size_t N>
+    double operator()(const std::array<double, N>& a, const std::array<double, N>& b) const {
+        double sum = 0.0;
+        for (size_t i = 0; i < N; ++i) {
+            double diff = a[i] - b[i];
+            sum += diff * diff;
+        }
+        return std::sqrt(sum);
+    }
+};
+
+struct ManhattanDistance {
+    template <size_t N>
+    double operator()(const std::array<double, N>& a, const std::array<double, N>& b) const {
+        double sum = 0.0;
+        for (size_t i = 0; i < N; ++i) {
+            sum += std::abs(a[i] - b[i]);
+        }
+        return sum;
+    }
+};
+
+/**
+ * Inverted-file index of fixed-size feature vectors under a metric
+ *
+ * Vectors are grouped into cells around leader vectors: an insert joins
+ * the nearest cell whose leader is within cellRadius, or starts a new cell
+ * while fewer than maxCells exist. Each member keeps its distance to the
+ * leader and each cell the largest such distance, so by the triangle
+ * inequality whole cells and most members are ruled out without computing
+ * their distance. Queries therefore return exactly what a linear scan
+ * would; clustered data (flights repeat similar states) keeps them well
+ * under linear. Inserts and erases are incremental. Not thread-safe.
+ */
+template <size_t N, typename Distance = EuclideanDistance>
+class FeatureIndex {
+public:
+    using Vector = std::array<double, N>;
+
+    FeatureIndex(double cellRadius, size_t maxCells) : cellRadius_(cellRadius), maxCells_(maxCells) {}
+
+    size_t size() const { return locations_.size(); }
+    size_t getCellCount() const { return cells_.size(); }
+
+    // Ids are the caller's; inserting an id already present replaces its vector
+    void insert(uint32_t id, const Vector& vector) {
+        erase(id);
+        size_t best = cells_.size();
+        double bestDistance = std::numeric_limits<double>::infinity();
+        for (size_t c = 0; c < cells_.size(); ++c) {
+            double d = distance_(vector, cells_[c].leader);
+            if (d < bestDistance) {
+                bestDistance = d;
+                best = c;
+            }
+        }
+        if (best == cells_.size() || (bestDistance > cellRadius_ && cells_.size() < maxCells_)) {
+            cells_.push_back(Cell{vector, 0.0, {}});
+            best = cells_.size() - 1;
+            bestDistance = 0.0;
+        }
+        Cell& cell = cells_[best];
+        cell.radius = std::max(cell.radius, bestDistance);
+        locations_[id] = {static_cast<uint32_t>(best), static_cast<uint32_t>(cell.members.size())};
+        cell.members.push_back(Member{id, bestDistance, vector});
+    }
+
+    bool erase(uint32_t id) {
+        auto it = locations_.find(id);
+        if (it == locations_.end()) return false;
+        std::vector<Member>& members = cells_[it->second.first].members;
+        uint32_t pos = it->second.second;
+        if (pos + 1 != members.size()) {
+            members[pos] = std::move(members.back());
+            locations_[members[pos].id].second = pos;
+        }
+        members.pop_back();
+        locations_.erase(it);
+        return true;
+    }
+
+    // Cells stay in place so a refill of similar data reuses them
+    void clear() {
+        for (Cell& cell : cells_) {
+            cell.members.clear();
+            cell.radius = 0.0;
+        }
+        locations_.clear();
+    }
+
+    // fn(id, distance) for every vector within radius of query
+    template <typename Fn>
+    void forEachWithin(const Vector& query, double radius, Fn&& fn) const {
+        for (const Cell& cell : cells_) {
+            if (cell.members.empty()) continue;
+            double toLeader = distance_(query, cell.leader);
+            if (toLeader - cell.radius > radius) continue;
+            for (const Member& member : cell.members) {
+                if (std::abs(toLeader - member.leaderDistance) > radius) continue;
+                double d = distance_(query, member.vector);
+                if (d <= radius) fn(member.id, d);
+            }
+        }
+    }
+
+    // The k nearest (id, distance) pairs, nearest first, ties by id
+    void nearest(const Vector& query, size_t k, std::vector<std::pair<uint32_t, double>>& out) const {
+        out.clear();
+        if (k == 0) return;
+
+        // Visit cells by their lower bound and stop once it exceeds the k-th distance
+        std::vector<std::pair<double, size_t>> order;
+        order.reserve(cells_.size());
+        for (size_t c = 0; c < cells_.size(); ++c) {
+            if (cells_[c].members.empty()) continue;
+            double toLeader = distance_(query, cells_[c].leader);
+            order.emplace_back(toLeader, c);
+        }
+        std::sort(order.begin(), order.end(), [this](const auto& a, const auto& b) {
+            return a.first - cells_[a.second].radius < b.first - cells_[b.second].radius;
+        });
+
+        auto closer = [](const std::pair<uint32_t, double>& a, const std::pair<uint32_t, double>& b) {
+            return a.second < b.second || (a.second == b.second && a.first < b.first);
+        };
+        for (const auto& [toLeader, c] : order) {
+            const Cell& cell = cells_[c];
+            if (out.size() == k && toLeader - cell.radius > out.front().second) break;
+            for (const Member& member : cell.members) {
+                if (out.size() == k && std::abs(toLeader - member.leaderDistance) > out.front().second) continue;
+                std::pair<uint32_t, double> candidate(member.id, distance_(query, member.vector));
+                if (out.size() < k) {
+                    out.push_back(candidate);
+                    std::push_heap(out.begin(), out.end(), closer);
+                } else if (closer(candidate, out.front())) {
+                    std::pop_heap(out.begin(), out.end(), closer);
+                    out.back() = candidate;
+                    std::push_heap(out.begin(), out.end(), closer);
+                }
+            }
+        }
+        std::sort_heap(out.begin(), out.end(), closer);
+    }
+
+private:
+    struct Member {
+        uint32_t id;
+        double leaderDistance;
+        Vector vector;
+    };
+
+    struct Cell {
+        Vector leader;
+        double radius;                 // Largest leaderDistance since the last clear()
+        std::vector<Member> members;
+    };
+
+    double cellRadius_;
+    size_t maxCells_;
+    Distance distance_;
+    std::vector<Cell> cells_;
+    std::unordered_map<uint32_t, std::pair<uint32_t, uint32_t>> locations_;   // id -> cell, member
+};
+
+} // namespace AICopilot
+
+#endif // FEATURE_INDEX_HPP
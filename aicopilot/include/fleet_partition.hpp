@@ -0,0 +1,105 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Fleet Partition - geographic assignment of pilots to host nodes
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef FLEET_PARTITION_HPP
+#define FLEET_PARTITION_HPP
+
+#include "aicopilot_types.h"
+#include "tile_cache.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AICopilot {
+
+// One pilot to place: where it flies
+struct FleetPilotRoute {
+    uint32_t pilotId = 0;
+    std::vector<LatLon> route;       // departure, waypoints, destination
+    double weight = 1.0;             // relative load (a helicopter's 100 Hz loop costs more)
+};
+
+// Lat/lon box; south > north when empty
+struct FleetBounds {
+    double south = 90.0;
+    double west = 180.0;
+    double north = -90.0;
+    double east = -180.0;
+
+    bool empty() const { return south > north; }
+    void expand(double latitude, double longitude);
+    bool contains(double latitude, double longitude) const {
+        return latitude >= south && latitude <= north && longitude >= west && longitude <= east;
+    }
+    bool overlaps(const FleetBounds& other) const {
+        return !empty() && !other.empty() && south <= other.north && other.south <= north &&
+               west <= other.east && other.west <= east;
+    }
+    // Grown by a distance in nautical miles on every side
+    FleetBounds grown(double distanceNM) const;
+};
+
+// What one node runs and keeps resident
+struct FleetNodePlan {
+    std::vector<uint32_t> pilots;    // pilot ids
+    double weight = 0.0;
+    std::vector<TileKey> tiles;      // 1° tiles the routes cross, ascending: the terrain and weather working set
+    FleetBounds bounds;              // of the routes
+    FleetBounds exchangeBounds;      // bounds grown by the exchange radius
+    std::vector<uint32_t> neighbors; // nodes whose traffic can come within the exchange radius
+};
+
+struct FleetPartition {
+    std::vector<FleetNodePlan> nodes;
+    std::vector<uint32_t> nodeOfPilot;   // by input order
+
+    // Node whose pilots should see traffic at a point: peer nodes send it
+    // the aircraft inside its exchange bounds
+    bool inExchangeRegion(uint32_t node, double latitude, double longitude) const {
+        return nodes[node].exchangeBounds.contains(latitude, longitude);
+    }
+};
+
+/**
+ * Splits a fleet across nodes so each node's working set stays local
+ *
+ * Pilots are grouped by the 1° tile at the centre of their route, and the
+ * groups are ordered along a Hilbert curve over the tile grid, so tiles
+ * next to each other on the curve are next to each other on the ground.
+ * The curve is then cut into nodeCount runs of about equal weight without
+ * splitting a group. Each node gets the tiles its routes cross (sampled
+ * every ROUTE_SAMPLE_DEGREES) and the list of nodes whose routes come
+ * within exchangeRadiusNM of its own: the only peers it trades traffic
+ * deltas with for cross-partition TCAS.
+ *
+ * Longitudes are not wrapped at the antimeridian.
+ */
+class FleetPartitioner {
+public:
+    static constexpr double ROUTE_SAMPLE_DEGREES = 0.25;
+    static constexpr int HILBERT_ORDER = 9;          // 512 x 512 cells cover the 360 x 180 tile grid
+    static constexpr double DEFAULT_EXCHANGE_RADIUS_NM = 40.0;   // beyond TCAS range with time to spare
+
+    explicit FleetPartitioner(double exchangeRadiusNM = DEFAULT_EXCHANGE_RADIUS_NM)
+        : exchangeRadiusNM_(exchangeRadiusNM) {}
+
+    FleetPartition partition(const std::vector<FleetPilotRoute>& pilots, size_t nodeCount) const;
+
+    // Position of a 1° tile along the curve
+    static uint32_t hilbertIndex(TileKey tile);
+
+private:
+    double exchangeRadiusNM_;
+};
+
+} // namespace AICopilot
+
+#endif // FLEET_PARTITION_HPP
@@ -0,0 +1,288 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Flight Data Recorder - columnar, Gorilla-encoded telemetry recordings
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef FLIGHT_DATA_RECORDER_HPP
+#define FLIGHT_DATA_RECORDER_HPP
+
+#include "aicopilot_types.h"
+#include "mpsc_queue.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AICopilot {
+
+// One column per recorded value, in AircraftState then AutopilotState order
+enum FlightDataColumn : uint32_t {
+    FDR_TIMESTAMP = 0,              // int64 microseconds, delta-of-delta encoded
+    FDR_LATITUDE,                   // every other column: double, XOR encoded
+    FDR_LONGITUDE,
+    FDR_ALTITUDE,
+    FDR_HEADING,
+    FDR_PITCH,
+    FDR_BANK,
+    FDR_INDICATED_AIRSPEED,
+    FDR_TRUE_AIRSPEED,
+    FDR_GROUND_SPEED,
+    FDR_VERTICAL_SPEED,
+    FDR_ALTIMETER,
+    FDR_FUEL_QUANTITY,
+    FDR_ENGINE_RPM,
+    FDR_ON_GROUND,                  // booleans as 0/1
+    FDR_PARKING_BRAKE,
+    FDR_GEAR_DOWN,
+    FDR_FLAPS,
+    FDR_MASTER_BATTERY,
+    FDR_MASTER_ALTERNATOR,
+    FDR_BATTERY_VOLTAGE,
+    FDR_BATTERY_LOAD,
+    FDR_GENERATOR_VOLTAGE,
+    FDR_GENERATOR_LOAD,
+    FDR_AP_MASTER,
+    FDR_AP_HEADING_HOLD,
+    FDR_AP_ALTITUDE_HOLD,
+    FDR_AP_SPEED_HOLD,
+    FDR_AP_VERTICAL_SPEED_HOLD,
+    FDR_AP_NAV,
+    FDR_AP_APPROACH,
+    FDR_AP_AUTOTHROTTLE,
+    FDR_AP_TARGET_HEADING,
+    FDR_AP_TARGET_ALTITUDE,
+    FDR_AP_TARGET_SPEED,
+    FDR_AP_TARGET_VERTICAL_SPEED,
+    FDR_FLIGHT_PHASE,               // FlightPhase
+    FDR_COLUMN_COUNT
+};
+
+const char* flightDataColumnName(FlightDataColumn column);
+
+// One recorded row
+struct FlightDataSample {
+    int64_t timestampUs = 0;
+    AircraftState state{};
+    AutopilotState autopilot{};
+    FlightPhase phase = FlightPhase::UNKNOWN;
+
+    // FDR_TIMESTAMP reads back as a double
+    double column(FlightDataColumn column) const;
+    void setColumn(FlightDataColumn column, double value);
+};
+
+/*
+ * On-disk layout (little-endian): the file header, then chunks until end
+ * of file. Each chunk holds up to rowsPerChunk rows as one bit stream per
+ * column, so a scan reads only the chunk headers and the columns it needs.
+ * Timestamps are delta-of-delta coded; values are XORed with the previous
+ * value and stored as the meaningful bits (Gorilla), so a steady column
+ * costs one bit per row. The chunk header carries a checksum of itself and
+ * one per column, so a scan verifies only the bytes it reads.
+ */
+struct FlightDataFileHeader {
+    char magic[4];                  // "AIFR"
+    uint16_t version;
+    uint16_t columnCount;           // FDR_COLUMN_COUNT
+    uint32_t rowsPerChunk;
+    uint32_t reserved;
+};
+
+struct FlightDataChunkHeader {
+    char magic[4];                  // "FRCK"
+    uint32_t rowCount;
+    int64_t firstTimestampUs;
+    int64_t lastTimestampUs;
+    uint64_t checksum;              // FNV-1a 64 of the header, this field zero
+    uint64_t columnChecksum[FDR_COLUMN_COUNT];
+    uint32_t columnBytes[FDR_COLUMN_COUNT];
+    uint32_t reserved;
+};
+
+static_assert(sizeof(FlightDataFileHeader) == 16, "FlightDataFileHeader layout");
+static_assert(sizeof(FlightDataChunkHeader) == 36 + 12 * FDR_COLUMN_COUNT, "FlightDataChunkHeader layout");
+
+/**
+ * Synchronous recording writer
+ *
+ * Rows accumulate in per-column encoders; a full chunk is written in one
+ * call. Used by the FlightDataRecorder thread, and directly by tools that
+ * convert other telemetry.
+ */
+class FlightDataWriter {
+public:
+    static constexpr uint32_t DEFAULT_ROWS_PER_CHUNK = 1024;
+
+    explicit FlightDataWriter(uint32_t rowsPerChunk = DEFAULT_ROWS_PER_CHUNK);
+    ~FlightDataWriter();
+
+    FlightDataWriter(const FlightDataWriter&) = delete;
+    FlightDataWriter& operator=(const FlightDataWriter&) = delete;
+
+    bool open(const std::string& path);
+    bool append(const FlightDataSample& sample);
+    bool flush();                   // writes a partial chunk
+    void close();                   // flushes
+    bool isOpen() const { return file_.is_open(); }
+
+    uint64_t getRowCount() const { return rowCount_; }
+    uint64_t getBytesWritten() const { return bytesWritten_; }
+
+private:
+    struct Impl;
+
+    std::ofstream file_;
+    std::unique_ptr<Impl> impl_;
+    uint32_t rowsPerChunk_;
+    uint64_t rowCount_ = 0;
+    uint64_t bytesWritten_ = 0;
+};
+
+/**
+ * Column-scan reader for one recording
+ *
+ * open() reads the file header and every chunk header, so row counts and
+ * chunk time ranges are known without decoding. readColumn() seeks to and
+ * decodes only the requested column of the chunks overlapping the time
+ * range (plus their timestamps when the range is bounded). A corrupt chunk
+ * header fails open(); a column with a bad checksum fails the read. A
+ * trailing chunk cut short by a crash is ignored.
+ */
+class FlightDataReader {
+public:
+    static constexpr char MAGIC[4] = {'A', 'I', 'F', 'R'};
+    static constexpr char CHUNK_MAGIC[4] = {'F', 'R', 'C', 'K'};
+    static constexpr uint16_t VERSION = 1;
+    static constexpr int64_t ALL_TIME_START = std::numeric_limits<int64_t>::min();
+    static constexpr int64_t ALL_TIME_END = std::numeric_limits<int64_t>::max();
+
+    FlightDataReader() = default;
+
+    FlightDataReader(const FlightDataReader&) = delete;
+    FlightDataReader& operator=(const FlightDataReader&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file_.is_open(); }
+
+    uint64_t getRowCount() const { return rowCount_; }
+    size_t getChunkCount() const { return chunks_.size(); }
+    const FlightDataChunkHeader& getChunk(size_t i) const { return chunks_[i].header; }
+
+    // Rows with timestamps in [startUs, endUs], in time order; out is replaced
+    bool readTimestamps(std::vector<int64_t>& out,
+                        int64_t startUs = ALL_TIME_START, int64_t endUs = ALL_TIME_END) const;
+    bool readColumn(FlightDataColumn column, std::vector<double>& out,
+                    int64_t startUs = ALL_TIME_START, int64_t endUs = ALL_TIME_END) const;
+
+    // Every column, reassembled into rows
+    bool readSamples(std::vector<FlightDataSample>& out) const;
+
+private:
+    struct ChunkEntry {
+        FlightDataChunkHeader header;
+        uint64_t dataOffset;        // first column's bytes
+    };
+
+    bool readColumnBytes(const ChunkEntry& chunk, FlightDataColumn column, std::vector<uint8_t>& out) const;
+    bool decodeChunkTimestamps(const ChunkEntry& chunk, std::vector<int64_t>& out) const;
+    bool decodeChunkColumn(const ChunkEntry& chunk, FlightDataColumn column, std::vector<double>& out) const;
+
+    mutable std::ifstream file_;
+    std::vector<ChunkEntry> chunks_;
+    uint64_t rowCount_ = 0;
+};
+
+// Lock and wake-ups shared by a recorder and its streams, so a stream
+// outliving its recorder still closes cleanly
+struct FlightDataRecorderSync {
+    std::mutex mutex;
+    std::condition_variable wake;       // recorder thread
+    std::condition_variable closed;     // streams waiting in close()
+};
+
+/**
+ * Per-pilot stream into a FlightDataRecorder
+ *
+ * record() copies the sample into a bounded queue and never blocks or
+ * allocates; a full queue drops the sample and counts it. close() waits
+ * until the recorder thread has written the last chunk. A record() racing
+ * close() may be dropped.
+ */
+class FlightDataStream {
+public:
+    static constexpr size_t QUEUE_CAPACITY = 2048;
+
+    bool record(const FlightDataSample& sample);
+    void close();
+
+    bool isOpen() const { return !closing_.load(std::memory_order_acquire); }
+    uint64_t getRecordedRows() const { return recorded_.load(std::memory_order_relaxed); }
+    uint64_t getDroppedRows() const { return dropped_.load(std::memory_order_relaxed); }
+
+    FlightDataStream(uint32_t rowsPerChunk, std::shared_ptr<FlightDataRecorderSync> sync);
+
+private:
+    friend class FlightDataRecorder;
+
+    MpscQueue<FlightDataSample> queue_;
+    FlightDataWriter writer_;
+    std::shared_ptr<FlightDataRecorderSync> sync_;
+    std::atomic<bool> closing_{false};
+    bool closed_ = false;           // guarded by sync_->mutex
+    std::atomic<uint64_t> recorded_{0};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+/**
+ * Background writer for flight data streams
+ *
+ * One thread drains every open stream each WRITER_INTERVAL_MS and encodes
+ * and writes full chunks, so a host with hundreds of pilots still runs a
+ * single recorder thread. The producer side only copies a sample per tick.
+ */
+class FlightDataRecorder {
+public:
+    static constexpr int WRITER_INTERVAL_MS = 50;
+
+    explicit FlightDataRecorder(uint32_t rowsPerChunk = FlightDataWriter::DEFAULT_ROWS_PER_CHUNK);
+    ~FlightDataRecorder();       // closes every stream
+
+    FlightDataRecorder(const FlightDataRecorder&) = delete;
+    FlightDataRecorder& operator=(const FlightDataRecorder&) = delete;
+
+    // Process-wide recorder
+    static std::shared_ptr<FlightDataRecorder> shared();
+
+    // nullptr when the file cannot be created
+    std::shared_ptr<FlightDataStream> openStream(const std::string& path);
+
+    size_t getStreamCount() const;
+
+private:
+    void writerLoop();
+    void drainAll(bool finishAll);
+
+    uint32_t rowsPerChunk_;
+    std::shared_ptr<FlightDataRecorderSync> sync_;
+    std::vector<std::shared_ptr<FlightDataStream>> streams_;
+    bool stopping_ = false;         // guarded by sync_->mutex
+    std::thread writer_;
+};
+
+} // namespace AICopilot
+
+#endif // FLIGHT_DATA_RECORDER_HPP
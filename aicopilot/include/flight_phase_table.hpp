@@ -0,0 +1,259 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Flight Phase Table - compile-time flight phase transition table
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef FLIGHT_PHASE_TABLE_HPP
+#define FLIGHT_PHASE_TABLE_HPP
+
+#include "aicopilot_types.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace AICopilot {
+
+constexpr size_t FLIGHT_PHASE_COUNT = static_cast<size_t>(FlightPhase::UNKNOWN) + 1;
+
+/**
+ * Aircraft state sampled once per tick for the phase guards
+ */
+struct PhaseInputs {
+    bool onGround = true;
+    double groundSpeed = 0.0;      // knots
+    double altitude = 0.0;         // feet MSL
+    double verticalSpeed = 0.0;    // feet per minute
+    double targetAltitude = 0.0;   // cruise altitude from the flight plan
+};
+
+using PhaseGuard = bool (*)(const PhaseInputs&);
+
+/**
+ * One row of the transition table: when in `from` and `guard` holds, go to `to`
+ */
+struct PhaseTransition {
+    FlightPhase from;
+    FlightPhase to;
+    PhaseGuard guard;
+    const char* name;
+};
+
+namespace PhaseGuards {
+
+constexpr double TAXI_SPEED_MIN = 5.0;         // knots
+constexpr double TAKEOFF_ROLL_SPEED = 40.0;    // knots
+constexpr double PATTERN_ALTITUDE = 1000.0;    // feet
+constexpr double APPROACH_ALTITUDE = 5000.0;   // feet
+constexpr double LEVEL_VS_BAND = 300.0;        // feet per minute
+
+constexpr bool stopped(const PhaseInputs& in) {
+    return in.onGround && in.groundSpeed < TAXI_SPEED_MIN;
+}
+constexpr bool taxiing(const PhaseInputs& in) {
+    return in.onGround && in.groundSpeed >= TAXI_SPEED_MIN && in.groundSpeed < TAKEOFF_ROLL_SPEED;
+}
+constexpr bool takeoffRoll(const PhaseInputs& in) {
+    return in.onGround && in.groundSpeed >= TAKEOFF_ROLL_SPEED;
+}
+constexpr bool onGroundSlow(const PhaseInputs& in) {
+    return in.onGround && in.groundSpeed < TAKEOFF_ROLL_SPEED;
+}
+constexpr bool touchdown(const PhaseInputs& in) {
+    return in.onGround;
+}
+constexpr bool airborneLow(const PhaseInputs& in) {
+    return !in.onGround && in.altitude < PATTERN_ALTITUDE;
+}
+constexpr bool climbing(const PhaseInputs& in) {
+    return !in.onGround && in.altitude >= PATTERN_ALTITUDE && in.verticalSpeed > LEVEL_VS_BAND &&
+           in.altitude < in.targetAltitude - PATTERN_ALTITUDE;
+}
+constexpr bool level(const PhaseInputs& in) {
+    return !in.onGround && in.altitude >= PATTERN_ALTITUDE &&
+           in.verticalSpeed > -LEVEL_VS_BAND && in.verticalSpeed < LEVEL_VS_BAND;
+}
+constexpr bool descending(const PhaseInputs& in) {
+    return !in.onGround && in.altitude >= APPROACH_ALTITUDE && in.verticalSpeed < -LEVEL_VS_BAND;
+}
+constexpr bool approaching(const PhaseInputs& in) {
+    return !in.onGround && in.altitude >= PATTERN_ALTITUDE && in.altitude < APPROACH_ALTITUDE &&
+           in.verticalSpeed < -LEVEL_VS_BAND;
+}
+constexpr bool belowApproachAltitude(const PhaseInputs& in) {
+    return !in.onGround && in.altitude < APPROACH_ALTITUDE;
+}
+constexpr bool goAround(const PhaseInputs& in) {
+    return !in.onGround && in.verticalSpeed > LEVEL_VS_BAND;
+}
+
+} // namespace PhaseGuards
+
+/**
+ * Flight phase transitions, grouped by source phase in FlightPhase order and
+ * checked first to last within a group. Only the current phase's group is
+ * evaluated each tick.
+ */
+inline constexpr PhaseTransition PHASE_TRANSITIONS[] = {
+    // PREFLIGHT also covers sessions that start airborne
+    {FlightPhase::PREFLIGHT, FlightPhase::TAXI_OUT, PhaseGuards::taxiing, "preflight>taxi_out"},
+    {FlightPhase::PREFLIGHT, FlightPhase::TAKEOFF, PhaseGuards::takeoffRoll, "preflight>takeoff"},
+    {FlightPhase::PREFLIGHT, FlightPhase::TAKEOFF, PhaseGuards::airborneLow, "preflight>takeoff_airborne"},
+    {FlightPhase::PREFLIGHT, FlightPhase::CLIMB, PhaseGuards::climbing, "preflight>climb"},
+    {FlightPhase::PREFLIGHT, FlightPhase::CRUISE, PhaseGuards::level, "preflight>cruise"},
+    {FlightPhase::PREFLIGHT, FlightPhase::DESCENT, PhaseGuards::descending, "preflight>descent"},
+    {FlightPhase::PREFLIGHT, FlightPhase::APPROACH, PhaseGuards::approaching, "preflight>approach"},
+
+    {FlightPhase::TAXI_OUT, FlightPhase::PREFLIGHT, PhaseGuards::stopped, "taxi_out>preflight"},
+    {FlightPhase::TAXI_OUT, FlightPhase::TAKEOFF, PhaseGuards::takeoffRoll, "taxi_out>takeoff"},
+    {FlightPhase::TAXI_OUT, FlightPhase::TAKEOFF, PhaseGuards::airborneLow, "taxi_out>takeoff_airborne"},
+
+    {FlightPhase::TAKEOFF, FlightPhase::CLIMB, PhaseGuards::climbing, "takeoff>climb"},
+    {FlightPhase::TAKEOFF, FlightPhase::CRUISE, PhaseGuards::level, "takeoff>cruise"},
+    {FlightPhase::TAKEOFF, FlightPhase::DESCENT, PhaseGuards::descending, "takeoff>descent"},
+    {FlightPhase::TAKEOFF, FlightPhase::APPROACH, PhaseGuards::approaching, "takeoff>approach"},
+    {FlightPhase::TAKEOFF, FlightPhase::TAXI_OUT, PhaseGuards::taxiing, "takeoff>taxi_out_rejected"},
+    {FlightPhase::TAKEOFF, FlightPhase::PREFLIGHT, PhaseGuards::stopped, "takeoff>preflight_rejected"},
+
+    {FlightPhase::CLIMB, FlightPhase::CRUISE, PhaseGuards::level, "climb>cruise"},
+    {FlightPhase::CLIMB, FlightPhase::DESCENT, PhaseGuards::descending, "climb>descent"},
+    {FlightPhase::CLIMB, FlightPhase::APPROACH, PhaseGuards::approaching, "climb>approach"},
+    {FlightPhase::CLIMB, FlightPhase::TAKEOFF, PhaseGuards::airborneLow, "climb>takeoff"},
+
+    {FlightPhase::CRUISE, FlightPhase::CLIMB, PhaseGuards::climbing, "cruise>climb"},
+    {FlightPhase::CRUISE, FlightPhase::DESCENT, PhaseGuards::descending, "cruise>descent"},
+    {FlightPhase::CRUISE, FlightPhase::APPROACH, PhaseGuards::approaching, "cruise>approach"},
+
+    // Leveling off in DESCENT is not a return to CRUISE (the cruise logic starts the descent)
+    {FlightPhase::DESCENT, FlightPhase::APPROACH, PhaseGuards::belowApproachAltitude, "descent>approach"},
+    {FlightPhase::DESCENT, FlightPhase::CLIMB, PhaseGuards::climbing, "descent>climb"},
+
+    // Level segments on approach stay in APPROACH
+    {FlightPhase::APPROACH, FlightPhase::LANDING, PhaseGuards::airborneLow, "approach>landing"},
+    {FlightPhase::APPROACH, FlightPhase::LANDING, PhaseGuards::touchdown, "approach>landing_touchdown"},
+    {FlightPhase::APPROACH, FlightPhase::CLIMB, PhaseGuards::climbing, "approach>climb_go_around"},
+
+    {FlightPhase::LANDING, FlightPhase::TAXI_IN, PhaseGuards::onGroundSlow, "landing>taxi_in"},
+    {FlightPhase::LANDING, FlightPhase::CLIMB, PhaseGuards::goAround, "landing>climb_go_around"},
+
+    // TAXI_IN and SHUTDOWN are left only by the phase logic itself
+};
+
+constexpr size_t PHASE_TRANSITION_COUNT = sizeof(PHASE_TRANSITIONS) / sizeof(PHASE_TRANSITIONS[0]);
+
+/**
+ * [begin, end) rows of PHASE_TRANSITIONS for one source phase
+ */
+struct PhaseTransitionRange {
+    size_t begin;
+    size_t end;
+};
+
+constexpr bool phaseTransitionsGrouped() {
+    for (size_t i = 1; i < PHASE_TRANSITION_COUNT; ++i) {
+        if (static_cast<size_t>(PHASE_TRANSITIONS[i].from) < static_cast<size_t>(PHASE_TRANSITIONS[i - 1].from)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(phaseTransitionsGrouped(), "PHASE_TRANSITIONS must be grouped by source phase in FlightPhase order");
+
+constexpr std::array<PhaseTransitionRange, FLIGHT_PHASE_COUNT> buildPhaseTransitionIndex() {
+    std::array<PhaseTransitionRange, FLIGHT_PHASE_COUNT> index{};
+    size_t row = 0;
+    for (size_t phase = 0; phase < FLIGHT_PHASE_COUNT; ++phase) {
+        index[phase].begin = row;
+        while (row < PHASE_TRANSITION_COUNT && static_cast<size_t>(PHASE_TRANSITIONS[row].from) == phase) {
+            ++row;
+        }
+        index[phase].end = row;
+    }
+    return index;
+}
+
+inline constexpr std::array<PhaseTransitionRange, FLIGHT_PHASE_COUNT> PHASE_TRANSITION_INDEX =
+    buildPhaseTransitionIndex();
+
+/**
+ * Per-transition instrumentation
+ */
+struct PhaseTransitionStats {
+    uint64_t fireCount = 0;
+    double lastDwellSeconds = 0.0;    // time spent in the source phase before firing
+    double totalDwellSeconds = 0.0;
+    double maxDwellSeconds = 0.0;
+};
+
+/**
+ * Table-driven flight phase state machine
+ */
+class FlightPhaseMachine {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // Called with the transition row and the source phase dwell time
+    using TransitionObserver = std::function<void(const PhaseTransition&, double dwellSeconds)>;
+
+    FlightPhase getPhase() const { return phase_; }
+
+    void reset(FlightPhase phase, Clock::time_point now) {
+        phase_ = phase;
+        enteredAt_ = now;
+    }
+
+    // Phase changes made outside the table (emergencies, phase logic) restart the dwell clock
+    void forcePhase(FlightPhase phase, Clock::time_point now) {
+        if (phase != phase_) {
+            reset(phase, now);
+        }
+    }
+
+    // Evaluate the current phase's guards; returns the fired row or npos
+    size_t update(const PhaseInputs& inputs, Clock::time_point now) {
+        const PhaseTransitionRange& range = PHASE_TRANSITION_INDEX[static_cast<size_t>(phase_)];
+        for (size_t row = range.begin; row < range.end; ++row) {
+            guardEvaluations_++;
+            if (!PHASE_TRANSITIONS[row].guard(inputs)) continue;
+
+            double dwell = std::chrono::duration<double>(now - enteredAt_).count();
+            PhaseTransitionStats& stats = stats_[row];
+            stats.fireCount++;
+            stats.lastDwellSeconds = dwell;
+            stats.totalDwellSeconds += dwell;
+            if (dwell > stats.maxDwellSeconds) stats.maxDwellSeconds = dwell;
+
+            reset(PHASE_TRANSITIONS[row].to, now);
+            if (observer_) {
+                observer_(PHASE_TRANSITIONS[row], dwell);
+            }
+            return row;
+        }
+        return npos;
+    }
+
+    void setTransitionObserver(TransitionObserver observer) { observer_ = std::move(observer); }
+
+    const std::array<PhaseTransitionStats, PHASE_TRANSITION_COUNT>& getTransitionStats() const { return stats_; }
+    uint64_t getGuardEvaluations() const { return guardEvaluations_; }
+
+private:
+    FlightPhase phase_ = FlightPhase::UNKNOWN;
+    Clock::time_point enteredAt_{};
+    std::array<PhaseTransitionStats, PHASE_TRANSITION_COUNT> stats_{};
+    uint64_t guardEvaluations_ = 0;
+    TransitionObserver observer_;
+};
+
+} // namespace AICopilot
+
+#endif // FLIGHT_PHASE_TABLE_HPP
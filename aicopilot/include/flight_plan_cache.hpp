@@ -0,0 +1,102 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Flight Plan Cache - parsed PLN/FMS plans shared across pilots by content
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef FLIGHT_PLAN_CACHE_HPP
+#define FLIGHT_PLAN_CACHE_HPP
+
+#include "aicopilot_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace AICopilot {
+
+enum class FlightPlanFormat {
+    UNKNOWN,
+    PLN,        // MSFS/P3D XML
+    FMS         // text, one "type id lat lon alt" line per waypoint
+};
+
+// Format from the file extension, case-insensitive
+FlightPlanFormat flightPlanFormatFor(const std::string& path);
+
+/**
+ * Parse a whole plan in one pass over its text
+ *
+ * PLN reads Title ("ICAO to ICAO"), DepartureID/DestinationID,
+ * DepartureLLA/DestinationLLA (decimal or N47° 26' 56.00" form) and
+ * CruiseAltitude/CruisingAlt. An airport named without an LLA becomes a
+ * waypoint at 0,0 for Navigation::resolveWaypoints(). FMS skips two header
+ * lines and '#'/';' comments, drops out-of-range waypoints and sets each
+ * heading to the initial course of its leg.
+ *
+ * @return false, leaving plan untouched, if the text holds no usable plan
+ *         (PLN: no airport; FMS: fewer than two waypoints)
+ */
+bool parseFlightPlan(std::string_view text, FlightPlanFormat format, FlightPlan& plan);
+
+/**
+ * Parsed flight plans keyed by file content
+ *
+ * load() maps the file, hashes its bytes (FNV-1a 64) and returns the plan
+ * parsed from the first file seen with the same format, hash and size, so
+ * a batch of pilots flying the same plan, from however many copies,
+ * parses it once. Plans are immutable once cached; Navigation copies the
+ * one it flies. Files that fail to parse are remembered too. The oldest
+ * entry is dropped once the cache holds `capacity` plans. Thread-safe.
+ */
+class FlightPlanCache {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;        // parses
+        uint64_t evictions = 0;
+    };
+
+    explicit FlightPlanCache(size_t capacity = 4096);
+
+    // Cache used by every Navigation unless one is set
+    static std::shared_ptr<FlightPlanCache> shared();
+
+    // Plan in the file, or nullptr if it cannot be read or parsed
+    std::shared_ptr<const FlightPlan> load(const std::string& path);
+
+    size_t size() const;
+    Stats getStats() const;
+    void clear();
+
+private:
+    struct Key {
+        FlightPlanFormat format;
+        uint64_t hash;
+        uint64_t size;
+        bool operator<(const Key& other) const {
+            if (hash != other.hash) return hash < other.hash;
+            if (size != other.size) return size < other.size;
+            return format < other.format;
+        }
+    };
+
+    size_t capacity_;
+    mutable std::mutex mutex_;
+    std::map<Key, std::shared_ptr<const FlightPlan>> plans_;
+    std::deque<Key> order_;         // insertion order, for eviction
+    Stats stats_;
+};
+
+} // namespace AICopilot
+
+#endif // FLIGHT_PLAN_CACHE_HPP
@@ -0,0 +1,162 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Geodesy - shared great-circle kernels, scalar and batched
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef GEODESY_HPP
+#define GEODESY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace AICopilot {
+
+/**
+ * Spherical-earth distance and course kernels
+ *
+ * One implementation of the haversine, initial course, unit-vector (chord)
+ * and flat-earth forms for every spatial query in the tree. All take
+ * degrees and return nautical miles or degrees true.
+ *
+ * Batch variants measure from one origin to many points held as
+ * structure-of-arrays. Each is a branch-free loop over contiguous arrays
+ * that the compiler vectorizes (with its vector math library for the trig).
+ * The unit-vector form needs no trig once the points are converted, which
+ * makes it the fastest exact kernel for repeated queries; the flat-earth
+ * form is cheaper again but only good over short ranges.
+ */
+namespace Geodesy {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double DEG_TO_RAD = PI / 180.0;
+constexpr double RAD_TO_DEG = 180.0 / PI;
+constexpr double EARTH_RADIUS_NM = 3440.065;
+
+// Flat-earth error stays under about 0.1% below this range at mid latitudes
+constexpr double FLAT_EARTH_MAX_NM = 100.0;
+
+// Earth-centred unit vector of a point on the sphere
+struct UnitVector {
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+};
+
+// ----------------------------------------------------------------------------
+// Scalar kernels
+// ----------------------------------------------------------------------------
+
+inline double haversineNM(double lat1, double lon1, double lat2, double lon2) {
+    double sinLat = std::sin((lat2 - lat1) * DEG_TO_RAD * 0.5);
+    double sinLon = std::sin((lon2 - lon1) * DEG_TO_RAD * 0.5);
+    double a = sinLat * sinLat + std::cos(lat1 * DEG_TO_RAD) * std::cos(lat2 * DEG_TO_RAD) * sinLon * sinLon;
+    return 2.0 * std::asin(std::sqrt(std::min(a, 1.0))) * EARTH_RADIUS_NM;
+}
+
+// Initial great-circle course from point 1 to point 2, 0-360 degrees
+inline double initialBearing(double lat1, double lon1, double lat2, double lon2) {
+    double phi1 = lat1 * DEG_TO_RAD;
+    double phi2 = lat2 * DEG_TO_RAD;
+    double dLon = (lon2 - lon1) * DEG_TO_RAD;
+    double y = std::sin(dLon) * std::cos(phi2);
+    double x = std::cos(phi1) * std::sin(phi2) - std::sin(phi1) * std::cos(phi2) * std::cos(dLon);
+    return std::fmod(std::atan2(y, x) * RAD_TO_DEG + 360.0, 360.0);
+}
+
+inline UnitVector toUnitVector(double lat, double lon) {
+    double phi = lat * DEG_TO_RAD;
+    double lambda = lon * DEG_TO_RAD;
+    return {std::cos(phi) * std::cos(lambda), std::cos(phi) * std::sin(lambda), std::sin(phi)};
+}
+
+// Great-circle distance between unit vectors, from the chord between them
+inline double chordDistanceNM(const UnitVector& a, const UnitVector& b) {
+    double dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+    double halfChord = 0.5 * std::sqrt(dx * dx + dy * dy + dz * dz);
+    return 2.0 * std::asin(std::min(halfChord, 1.0)) * EARTH_RADIUS_NM;
+}
+
+// Equirectangular approximation for short ranges; longitude wraps at the antimeridian
+inline double flatDistanceNM(double lat1, double lon1, double lat2, double lon2) {
+    double dLon = lon2 - lon1;
+    dLon -= 360.0 * std::floor((dLon + 180.0) / 360.0);
+    double x = dLon * std::cos(0.5 * (lat1 + lat2) * DEG_TO_RAD);
+    double y = lat2 - lat1;
+    return std::sqrt(x * x + y * y) * DEG_TO_RAD * EARTH_RADIUS_NM;
+}
+
+// ----------------------------------------------------------------------------
+// Batch kernels: one origin to count points, results into out[0..count)
+// ----------------------------------------------------------------------------
+
+inline void haversineBatchNM(double lat0, double lon0, const double* lat, const double* lon,
+                             size_t count, double* out) {
+    const double cosLat0 = std::cos(lat0 * DEG_TO_RAD);
+    for (size_t i = 0; i < count; ++i) {
+        double sinLat = std::sin((lat[i] - lat0) * DEG_TO_RAD * 0.5);
+        double sinLon = std::sin((lon[i] - lon0) * DEG_TO_RAD * 0.5);
+        double a = sinLat * sinLat + cosLat0 * std::cos(lat[i] * DEG_TO_RAD) * sinLon * sinLon;
+        out[i] = 2.0 * std::asin(std::sqrt(std::min(a, 1.0))) * EARTH_RADIUS_NM;
+    }
+}
+
+inline void initialBearingBatch(double lat0, double lon0, const double* lat, const double* lon,
+                                size_t count, double* out) {
+    const double sinLat0 = std::sin(lat0 * DEG_TO_RAD);
+    const double cosLat0 = std::cos(lat0 * DEG_TO_RAD);
+    for (size_t i = 0; i < count; ++i) {
+        double phi = lat[i] * DEG_TO_RAD;
+        double dLon = (lon[i] - lon0) * DEG_TO_RAD;
+        double y = std::sin(dLon) * std::cos(phi);
+        double x = cosLat0 * std::sin(phi) - sinLat0 * std::cos(phi) * std::cos(dLon);
+        out[i] = std::fmod(std::atan2(y, x) * RAD_TO_DEG + 360.0, 360.0);
+    }
+}
+
+// Convert points once for chordDistanceBatchNM()
+inline void toUnitVectorBatch(const double* lat, const double* lon, size_t count,
+                              double* x, double* y, double* z) {
+    for (size_t i = 0; i < count; ++i) {
+        double phi = lat[i] * DEG_TO_RAD;
+        double lambda = lon[i] * DEG_TO_RAD;
+        x[i] = std::cos(phi) * std::cos(lambda);
+        y[i] = std::cos(phi) * std::sin(lambda);
+        z[i] = std::sin(phi);
+    }
+}
+
+inline void chordDistanceBatchNM(const UnitVector& origin, const double* x, const double* y, const double* z,
+                                 size_t count, double* out) {
+    // Half chords first, a pure arithmetic pass, then one asin pass
+    for (size_t i = 0; i < count; ++i) {
+        double dx = x[i] - origin.x, dy = y[i] - origin.y, dz = z[i] - origin.z;
+        out[i] = std::min(0.5 * std::sqrt(dx * dx + dy * dy + dz * dz), 1.0);
+    }
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = 2.0 * std::asin(out[i]) * EARTH_RADIUS_NM;
+    }
+}
+
+inline void flatDistanceBatchNM(double lat0, double lon0, const double* lat, const double* lon,
+                                size_t count, double* out) {
+    for (size_t i = 0; i < count; ++i) {
+        double dLon = lon[i] - lon0;
+        dLon -= 360.0 * std::floor((dLon + 180.0) / 360.0);
+        double dx = dLon * std::cos(0.5 * (lat0 + lat[i]) * DEG_TO_RAD);
+        double dy = lat[i] - lat0;
+        out[i] = std::sqrt(dx * dx + dy * dy) * DEG_TO_RAD * EARTH_RADIUS_NM;
+    }
+}
+
+} // namespace Geodesy
+
+} // namespace AICopilot
+
+#endif // GEODESY_HPP
@@ -0,0 +1,175 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Hazard Grid - weather hazards rasterized for fast point and route queries
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef HAZARD_GRID_HPP
+#define HAZARD_GRID_HPP
+
+#include "aicopilot_types.h"
+#include "weather_system.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace AICopilot {
+
+// What the grid holds for one cell and altitude layer
+struct HazardGridSample {
+    uint8_t intensity = 0;   // 0-100 (dBZ equivalent), strongest hazard over the cell
+    uint8_t types = 0;       // hazardTypeBit() of every hazard over the cell
+
+    bool any() const { return intensity > 0; }
+    bool has(WeatherHazardType type) const;
+};
+
+constexpr uint8_t hazardTypeBit(WeatherHazardType type) {
+    return type == WeatherHazardType::NONE ? 0 : static_cast<uint8_t>(1u << static_cast<int>(type));
+}
+
+/**
+ * Weather hazards rasterized into a latitude x longitude x altitude grid
+ *
+ * The grid has two levels. One-degree tiles exist only where a hazard
+ * reaches and keep the strongest intensity per altitude layer. Each tile
+ * holds CELLS_PER_DEGREE x CELLS_PER_DEGREE cells of LAYER_COUNT layers,
+ * each layer LAYER_FEET deep. A cell takes the strongest intensity, and
+ * every type, of the hazards whose disc touches it. A hazard with
+ * topAltitude <= altitude spans every layer, as in route planning.
+ *
+ * Rasterizing is conservative: any point inside a hazard (flat distance
+ * from its centre, with longitude scaled at the hazard's latitude) lies
+ * in a marked cell. So an empty cell, or a route walk over only empty
+ * cells, is clear without looking at any hazard.
+ *
+ * Hazards are kept by caller-chosen id. Moving one re-rasterizes only the
+ * tiles of its old and new footprints. Point samples are a tile lookup
+ * and an index. Segment queries walk the tiles the segment crosses, and
+ * the cells only inside tiles that have something at that layer.
+ * Longitudes are not wrapped at the antimeridian.
+ *
+ * Not synchronised; update and query it from one thread, like WeatherSystem.
+ */
+class HazardGrid {
+public:
+    static constexpr int CELLS_PER_DEGREE = 16;         // about 3.75 nm north-south
+    static constexpr double LAYER_FEET = 2000.0;
+    static constexpr int LAYER_COUNT = 25;              // Surface to FL500; higher clamps to the top layer
+    static constexpr double MAX_RADIUS_NM = 300.0;      // Larger hazards aren't rasterized,
+    static constexpr int MAX_TILES_PER_HAZARD = 256;    // nor ones this wide near the poles
+
+    // Intensity a hazard of this severity paints at its centre; it tapers
+    // to EDGE_INTENSITY_FRACTION of that at the edge
+    static uint8_t intensityFor(HazardSeverity severity);
+    static constexpr double EDGE_INTENSITY_FRACTION = 0.6;
+
+    /**
+     * Add or move a hazard
+     * @return false if it has no usable position or radius; it is then not
+     *         held, and any earlier hazard with this id is removed
+     */
+    bool setHazard(uint32_t id, const WeatherHazard& hazard);
+    bool removeHazard(uint32_t id);
+
+    /**
+     * Make the grid hold exactly these hazards, with their indices as ids.
+     * Hazards that haven't changed cost nothing, and each affected tile is
+     * rasterized once.
+     * @return Number of hazards held
+     */
+    size_t assign(const std::vector<WeatherHazard>& hazards);
+    void clear();
+
+    bool contains(uint32_t id) const { return hazards_.count(id) != 0; }
+    const WeatherHazard* getHazard(uint32_t id) const;
+    size_t hazardCount() const { return hazards_.size(); }
+    size_t tileCount() const { return tiles_.size(); }
+
+    // The cell holding a point, at the layer holding the altitude
+    HazardGridSample sample(double latitude, double longitude, double altitude) const;
+
+    // Strongest intensity and every type over the cells a segment crosses
+    HazardGridSample sampleSegment(const Position& from, const Position& to, double altitude) const;
+
+    /**
+     * Hazards that contain a point at an altitude
+     * @param ids Output: hazard ids, strongest first
+     */
+    void hazardsAt(double latitude, double longitude, double altitude, std::vector<uint32_t>& ids) const;
+
+    /**
+     * Hazards a segment passes through at an altitude, closest approach
+     * inside the radius
+     * @param ids Output: hazard ids in ascending order
+     */
+    void hazardsAlongSegment(const Position& from, const Position& to, double altitude,
+                             std::vector<uint32_t>& ids) const;
+
+    /**
+     * One return per occupied cell column within range of a position
+     * @param typeMask hazardTypeBit()s a return must include
+     * @param returns Output, appended to: cell centre, strongest intensity,
+     *        and the bottom and top of its occupied layers
+     * @return Number of returns appended
+     */
+    size_t radarReturns(double latitude, double longitude, double rangeNM, uint8_t typeMask,
+                        std::vector<WeatherRadarReturn>& returns) const;
+
+private:
+    static constexpr int CELLS_PER_TILE = CELLS_PER_DEGREE * CELLS_PER_DEGREE;
+
+    struct Voxel {
+        uint8_t intensity = 0;
+        uint8_t types = 0;
+    };
+
+    struct TileRange {
+        int row0 = 0, row1 = -1;   // inclusive, in whole degrees of latitude
+        int col0 = 0, col1 = -1;   // and longitude
+    };
+
+    struct Entry {
+        WeatherHazard hazard;
+        TileRange tiles;
+        double lonScale = 1.0;     // cos(latitude) of the centre
+        int layer0 = 0, layer1 = 0;
+    };
+
+    struct Tile {
+        std::vector<uint32_t> hazards;                    // ids whose bounds reach the tile
+        std::array<uint8_t, LAYER_COUNT> layerMax{};      // strongest cell per layer
+        std::vector<Voxel> voxels;                        // [(layer * CELLS + row) * CELLS + col]
+    };
+
+    static uint32_t tileKey(int row, int col);
+    static int layerFor(double altitude);
+    static bool prepare(const WeatherHazard& hazard, Entry& entry);
+    static bool withinHazard(const Entry& entry, const Position& from, const Position& to, double altitude);
+
+    void place(uint32_t id, const WeatherHazard& hazard, bool& held, std::unordered_set<uint32_t>& dirty);
+    void unlink(uint32_t id, const TileRange& tiles, std::unordered_set<uint32_t>& dirty);
+    void rasterize(const std::unordered_set<uint32_t>& dirty);
+    void rasterizeTile(uint32_t key, Tile& tile) const;
+    const Tile* findTile(int row, int col) const;
+
+    // Occupied cells a segment crosses at a layer, skipping tiles empty
+    // there; fn(tile, voxel) returns false to stop
+    template <typename Fn>
+    void walkSegment(const Position& from, const Position& to, int layer, Fn&& fn) const;
+
+    std::unordered_map<uint32_t, Entry> hazards_;
+    std::unordered_map<uint32_t, Tile> tiles_;
+};
+
+} // namespace AICopilot
+
+#endif // HAZARD_GRID_HPP
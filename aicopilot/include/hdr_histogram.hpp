@@ -0,0 +1,139 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* HDR Histogram - fixed-precision latency histograms, plain and concurrent
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef HDR_HISTOGRAM_HPP
+#define HDR_HISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace AICopilot {
+
+/**
+ * High-dynamic-range bucket layout over microseconds
+ *
+ * Values below LINEAR_BUCKETS get a bucket each; above that every power of
+ * two is split into SUB_BUCKETS equal buckets, so a bucket's width is at
+ * most 1/SUB_BUCKETS (about 3%) of its value from 1 us up to MAX_VALUE_US
+ * (about 71 minutes). Larger values land in the top bucket.
+ */
+struct HdrLayout {
+    static constexpr unsigned SUB_BITS = 5;
+    static constexpr uint64_t SUB_BUCKETS = 1ull << SUB_BITS;          // 32
+    static constexpr uint64_t LINEAR_BUCKETS = SUB_BUCKETS * 2;        // 64
+    static constexpr unsigned MAX_MAGNITUDE = 31;
+    static constexpr uint64_t MAX_VALUE_US = (2ull << MAX_MAGNITUDE) - 1;
+    static constexpr size_t BUCKETS =
+        LINEAR_BUCKETS + (MAX_MAGNITUDE - SUB_BITS) * SUB_BUCKETS;     // 896
+
+    static size_t bucketOf(uint64_t us) {
+        if (us < LINEAR_BUCKETS) return static_cast<size_t>(us);
+        if (us > MAX_VALUE_US) us = MAX_VALUE_US;
+        unsigned magnitude = 0;                                        // floor(log2(us)), >= SUB_BITS + 1
+        for (unsigned step = 32; step; step >>= 1) {
+            if (us >> (magnitude + step)) magnitude += step;
+        }
+        unsigned shift = magnitude - SUB_BITS;
+        uint64_t top = us >> shift;                                    // [SUB_BUCKETS, 2 * SUB_BUCKETS)
+        return static_cast<size_t>(LINEAR_BUCKETS + (magnitude - SUB_BITS - 1) * SUB_BUCKETS +
+                                   (top - SUB_BUCKETS));
+    }
+
+    // Largest value counted in bucket
+    static uint64_t bucketUpperUs(size_t bucket) {
+        if (bucket < LINEAR_BUCKETS) return bucket;
+        uint64_t k = bucket - LINEAR_BUCKETS;
+        unsigned shift = static_cast<unsigned>(k / SUB_BUCKETS) + 1;
+        uint64_t top = k % SUB_BUCKETS + SUB_BUCKETS;
+        return ((top + 1) << shift) - 1;
+    }
+
+    static uint64_t toMicros(double latencyMs) {
+        if (!(latencyMs > 0.0)) return 0;
+        double us = latencyMs * 1000.0 + 0.5;
+        return us >= static_cast<double>(MAX_VALUE_US) ? MAX_VALUE_US : static_cast<uint64_t>(us);
+    }
+};
+
+/**
+ * Single-threaded HDR histogram; also the merged snapshot of a
+ * ConcurrentHdrHistogram. Percentiles are O(BUCKETS) and report the upper
+ * bound of their bucket, clamped to the largest value seen.
+ */
+class HdrHistogram {
+public:
+    void record(double latencyMs) { recordMicros(HdrLayout::toMicros(latencyMs)); }
+    void recordMicros(uint64_t us);
+    void merge(const HdrHistogram& other);
+    void clear() { *this = HdrHistogram(); }
+
+    uint64_t count() const { return count_; }
+    double minMs() const { return count_ ? min_ / 1000.0 : 0.0; }
+    double maxMs() const { return max_ / 1000.0; }
+    double meanMs() const { return count_ ? static_cast<double>(sumUs_) / count_ / 1000.0 : 0.0; }
+    double percentileMs(double p) const;   // p in [0, 1]
+
+    const std::array<uint64_t, HdrLayout::BUCKETS>& buckets() const { return buckets_; }
+
+private:
+    friend class ConcurrentHdrHistogram;
+
+    std::array<uint64_t, HdrLayout::BUCKETS> buckets_{};
+    uint64_t count_ = 0;
+    uint64_t sumUs_ = 0;
+    uint64_t min_ = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ = 0;
+};
+
+/**
+ * HDR histogram that any thread records into without locking
+ *
+ * Each thread is assigned one of STRIPES stripes round-robin on first
+ * use; recording is a handful of relaxed atomic adds on that stripe
+ * (plus a compare-exchange only when it sets a new minimum or maximum),
+ * so threads on different stripes never share a cache line. snapshot()
+ * merges the stripes in O(STRIPES * BUCKETS); a snapshot taken while
+ * others record may miss their in-flight samples but is never torn
+ * within a bucket.
+ */
+class ConcurrentHdrHistogram {
+public:
+    static constexpr size_t STRIPES = 4;
+
+    void record(double latencyMs) { recordMicros(HdrLayout::toMicros(latencyMs)); }
+    void recordMicros(uint64_t us);
+
+    HdrHistogram snapshot() const;
+    uint64_t count() const;
+
+    // Not atomic with respect to concurrent recorders
+    void reset();
+
+private:
+    struct alignas(64) Stripe {
+        std::array<std::atomic<uint64_t>, HdrLayout::BUCKETS> buckets{};
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sumUs{0};
+        std::atomic<uint64_t> min{std::numeric_limits<uint64_t>::max()};
+        std::atomic<uint64_t> max{0};
+    };
+
+    std::array<Stripe, STRIPES> stripes_;
+
+    static size_t threadStripe();
+};
+
+} // namespace AICopilot
+
+#endif // HDR_HISTOGRAM_HPP
@@ -0,0 +1,233 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Headless Sim - fast-time SimConnect backend with a point-mass flight model
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef HEADLESS_SIM_HPP
+#define HEADLESS_SIM_HPP
+
+#include "aircraft_profile.h"
+#include "aircraft_state_core.hpp"
+#include "simconnect_recording.hpp"
+#include "simconnect_wrapper.h"
+#include "state_snapshot.hpp"
+#include <cstdint>
+#include <string>
+
+namespace AICopilot {
+
+/**
+ * Scenario for one headless aircraft
+ * Zero performance fields fall back to a light single (about a C172), so a
+ * partially parsed aircraft.cfg still flies.
+ */
+struct HeadlessSimConfig {
+    PerformanceProfile performance{};   // AircraftProfile::performance
+    Position start{};                   // altitude is the field elevation when on the ground
+    bool startOnGround = true;
+    double fuelQuantity = -1.0;         // gallons; negative fills the tanks
+    double windDirection = 0.0;         // degrees true, the direction it blows from
+    double windSpeed = 0.0;             // knots
+    double stepSeconds = 1.0 / 30.0;    // sim time per processMessages()
+};
+
+/**
+ * Point-mass aircraft: position, track, airspeed and vertical speed
+ *
+ * Attitude is derived, not flown: bank follows the aileron or the
+ * autopilot heading error, pitch is the flight path angle. Speed and
+ * vertical speed chase their commanded values through first-order lags
+ * bounded by the profile's climb and descent rates, so the autopilot
+ * logic sees plausible transients without a 6-DOF model. With the
+ * autopilot master on it holds the heading, altitude and airspeed
+ * targets. Deterministic: the same inputs give the same trajectory.
+ */
+class PointMassFlightModel {
+public:
+    struct Controls {
+        double throttle = 0.0;          // 0..1
+        double elevator = 0.0;          // -1..1, positive nose up
+        double aileron = 0.0;           // -1..1, positive right
+        double rudder = 0.0;            // -1..1, steers on the ground
+        double brakes = 0.0;            // 0..1
+        int flaps = 0;                  // 0..100 %
+        bool gearDown = true;
+        bool spoilers = false;
+        bool parkingBrake = false;
+        bool engineRunning = true;
+    };
+
+    explicit PointMassFlightModel(const HeadlessSimConfig& config);
+
+    void step(double dt);
+
+    Controls& controls() { return controls_; }
+    const Controls& controls() const { return controls_; }
+    AutopilotState& autopilot() { return autopilot_; }
+    const AutopilotState& autopilot() const { return autopilot_; }
+
+    const PerformanceProfile& getPerformance() const { return performance_; }
+    void setGroundElevation(double feet) { groundElevation_ = feet; }
+    void setWind(double directionDegrees, double speedKnots);
+
+    // Full AircraftState for the current step
+    AircraftState getState() const;
+    double getSimTime() const { return simTime_; }
+
+private:
+    double commandedSpeed() const;
+    double commandedVerticalSpeed(double airspeed) const;
+    double commandedBank() const;
+
+    PerformanceProfile performance_;
+    Controls controls_;
+    AutopilotState autopilot_{};
+
+    double latitude_;
+    double longitude_;
+    double altitude_;                   // ft MSL
+    double heading_;                    // degrees true
+    double indicatedAirspeed_ = 0.0;    // knots
+    double verticalSpeed_ = 0.0;        // fpm
+    double bank_ = 0.0;                 // degrees
+    double pitch_ = 0.0;                // degrees
+    double trueAirspeed_ = 0.0;
+    double groundSpeed_ = 0.0;
+    double fuelQuantity_;
+    bool onGround_;
+    double groundElevation_;
+    double windFromDegrees_;
+    double windSpeed_;
+    double simTime_ = 0.0;
+};
+
+/**
+ * SimConnectWrapper backend driven by PointMassFlightModel instead of a
+ * simulator
+ *
+ * Every processMessages() advances the model by one fixed step and
+ * publishes the new state, so the caller sets the pace; stepped in a loop
+ * it runs as fast as the CPU allows. It starts no threads, and many
+ * aircraft share one thread (or, as AIPilots, one PilotHost pool). Control
+ * and autopilot setters act on the model directly; batching is accepted
+ * and needs no flush. The replay step is the model step and the replay
+ * time is sim time, so AIPilot::initializeHeadless() drives it exactly as
+ * a fast capture replay.
+ *
+ * startRecording() writes the standard capture format: each step is a
+ * SIMOBJECT_DATA record per state tier with the layouts in
+ * simconnect_recording.hpp, timestamped in sim time, so a headless run
+ * replays through connectReplay() like a live recording.
+ */
+class HeadlessSimConnect : public SimConnectWrapper {
+public:
+    // Tier cadence in model steps, as the default DataSubscriptionConfig
+    static constexpr uint64_t SYSTEMS_INTERVAL_STEPS = 8;
+    static constexpr uint64_t ENGINE_INTERVAL_STEPS = 30;
+
+    explicit HeadlessSimConnect(const HeadlessSimConfig& config);
+    ~HeadlessSimConnect() override;
+
+    PointMassFlightModel& getModel() { return model_; }
+    const PointMassFlightModel& getModel() const { return model_; }
+    uint64_t getStepCount() const { return stepCount_; }
+
+    bool connect(SimulatorType simType, const std::string& appName = "AICopilot") override;
+    void disconnect() override;
+    bool isConnected() const override { return connected_; }
+
+    bool connectReplay(const std::string& capturePath, ReplayPacing pacing = ReplayPacing::WALL_CLOCK) override;
+    bool isReplaying() const override { return false; }
+    void setReplayStep(double seconds) override;
+    double getReplayTime() const override { return model_.getSimTime(); }
+
+    bool startRecording(const std::string& capturePath) override;
+    void stopRecording() override;
+    bool isRecording() const override { return recorder_.isOpen(); }
+
+    void processMessages() override;
+
+    // Headless is always polled
+    bool startDispatchThread() override { return false; }
+    void stopDispatchThread() override {}
+    bool isDispatchThreadRunning() const override { return false; }
+
+    AircraftState getAircraftState() override { return stateStore_.load(); }
+    AutopilotState getAutopilotState() override { return autopilotSnapshot_.load(); }
+    Position getPosition() override { return stateStore_.loadCore().position(); }
+    AircraftStateCore getAircraftStateCore(uint64_t& version) override { return stateStore_.loadCore(version); }
+    AircraftStateCold getAircraftStateCold(uint64_t& version) override { return stateStore_.loadCold(version); }
+    uint64_t getStateVersion() const override { return stateStore_.coreVersion(); }
+    uint64_t getColdStateVersion() const override { return stateStore_.coldVersion(); }
+
+    void setDataSubscription(const DataSubscriptionConfig& config) override { subscription_ = config; }
+    DataSubscriptionConfig getDataSubscription() const override { return subscription_; }
+    size_t getTrafficTable(TrafficTable& out) const override;
+
+    void setAutopilotMaster(bool enabled) override;
+    void setAutopilotHeading(double heading) override;
+    void setAutopilotAltitude(double altitude) override;
+    void setAutopilotSpeed(double speed) override;
+    void setAutopilotVerticalSpeed(double verticalSpeed) override;
+    void setAutopilotNav(bool enabled) override;
+    void setAutopilotApproach(bool enabled) override;
+
+    void setCommandBatching(bool enabled) override { commandBatching_ = enabled; }
+    bool isCommandBatchingEnabled() const override { return commandBatching_; }
+    void flushCommands() override {}
+
+    void setThrottle(double value) override;
+    void setElevator(double value) override;
+    void setAileron(double value) override;
+    void setRudder(double value) override;
+    void setFlaps(int position) override;
+    void setGear(bool down) override;
+    void setSpoilers(bool deployed) override;
+    void setParkingBrake(bool set) override;
+    void setBrakes(double value) override;
+
+    void setMixture(double) override {}
+    void setPropellerPitch(double) override {}
+    void setMagnetos(int) override {}
+    void toggleEngineStarter(int engineIndex) override;
+    void setEngineState(int engineIndex, bool running) override;
+
+    void setLight(const std::string&, bool) override {}
+
+    // No ATC without a simulator
+    void sendATCMenuSelection(int) override {}
+    void requestATCMenu() override {}
+    std::vector<std::string> getATCMenuOptions() override { return {}; }
+
+    void subscribeToAircraftState(StateCallback callback) override { stateCallback_ = std::move(callback); }
+    void subscribeToATCMessages(ATCCallback) override {}
+    void subscribeToATCText(ATCTextCallback) override {}
+
+private:
+    void publish();
+    void recordStep();
+    template <typename T>
+    void recordTier(uint32_t requestId, const T& data);
+
+    PointMassFlightModel model_;
+    AircraftStateStore stateStore_;
+    StateSnapshot<AutopilotState> autopilotSnapshot_;
+    DataSubscriptionConfig subscription_;
+    StateCallback stateCallback_;
+    SimConnectRecorder recorder_;
+    std::vector<uint8_t> recordBuffer_;
+    double stepSeconds_;
+    uint64_t stepCount_ = 0;
+    bool connected_ = false;
+    bool commandBatching_ = false;
+};
+
+} // namespace AICopilot
+
+#endif // HEADLESS_SIM_HPP
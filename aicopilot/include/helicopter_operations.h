@@ -20,6 +20,7 @@
 
 #include "aicopilot_types.h"
 #include "aircraft_profile.h"
+#include <cstdint>
 #include <vector>
 
 namespace AICopilot {
@@ -53,6 +54,24 @@ struct AutorotationState {
     bool inFlare;               // true if in flare phase
 };
 
+// Control outputs from one fast-path iteration
+struct RotorcraftControl {
+    double collective = 0.0;          // 0.0 to 1.0
+    double cyclicLateral = 0.0;       // -1 to +1 (left to right)
+    double cyclicLongitudinal = 0.0;  // -1 to +1 (aft to forward)
+    double pedal = 0.0;               // -1 to +1 (left to right)
+};
+
+// Hover hold quality over the samples taken in HOVER
+struct HoverQualityStats {
+    uint64_t samples = 0;
+    double rmsPositionError = 0.0;    // feet from the hold point
+    double maxPositionError = 0.0;    // feet
+    double rmsAltitudeError = 0.0;    // feet
+    double rmsVerticalSpeed = 0.0;    // feet per minute
+    double stableFraction = 0.0;      // share of samples with isHoverStable()
+};
+
 /**
  * Helicopter-Specific Operations
  */
@@ -77,6 +96,21 @@ public:
     // Check if hovering
     bool isHovering() const { return currentMode_ == HelicopterMode::HOVER; }
     
+    // Hover, hover taxi and autorotation are flown by the fast path
+    bool needsFastControl() const {
+        return currentMode_ == HelicopterMode::HOVER ||
+               currentMode_ == HelicopterMode::HOVER_TAXI ||
+               currentMode_ == HelicopterMode::AUTOROTATION;
+    }
+    
+    // One iteration of the high-rate loop: updates the active mode from
+    // state and returns the controls to hold it. dt is seconds since the
+    // previous iteration.
+    RotorcraftControl runFastControl(const AircraftState& state, double dt);
+    
+    const HoverQualityStats& getHoverQuality() const { return hoverQuality_; }
+    void resetHoverQuality();
+    
     // Hover taxi (low altitude movement)
     bool initiateHoverTaxi(const Position& targetPosition, double speed);
     void updateHoverTaxi(const AircraftState& state);
@@ -140,6 +174,38 @@ private:
     static constexpr double HOVER_TOLERANCE_VERTICAL = 5.0;  // feet
     static constexpr double MAX_HOVER_DRIFT = 3.0;  // knots
     
+    // Fast-path control gains, per foot, knot or degree of error
+    static constexpr double POSITION_GAIN = 0.004;     // cyclic per foot from the hold point
+    static constexpr double VELOCITY_GAIN = 0.02;      // cyclic per ft/s of drift
+    static constexpr double MAX_HOVER_CYCLIC = 0.3;
+    static constexpr double MAX_TAXI_ERROR = 50.0;     // feet of target error used in hover taxi
+    static constexpr double ALTITUDE_GAIN = 0.01;      // collective per foot
+    static constexpr double VERTICAL_SPEED_GAIN = 0.0005;  // collective per fpm
+    static constexpr double COLLECTIVE_TRIM_RATE = 0.002;  // collective per foot-second
+    static constexpr double HOVER_COLLECTIVE_TRIM = 0.6;
+    static constexpr double HEADING_GAIN = 0.02;       // pedal per degree
+    static constexpr double AUTOROTATION_SPEED_GAIN = 0.01;  // cyclic per knot
+    static constexpr double VELOCITY_FILTER = 0.3;     // weight of a new drift sample
+    
+    // Fast-path state: hold point and drift estimated from position changes
+    bool holdCaptured_ = false;
+    bool holdPointFixed_ = false;  // hold point given, not captured from state
+    Position holdPoint_{};
+    double holdHeading_ = 0.0;
+    double collectiveTrim_ = HOVER_COLLECTIVE_TRIM;
+    Position lastPosition_{};
+    double sinceLastPosition_ = 0.0;
+    bool hasLastPosition_ = false;
+    double velocityNorth_ = 0.0;  // feet per second
+    double velocityEast_ = 0.0;
+    
+    // Running sums behind hoverQuality_
+    HoverQualityStats hoverQuality_;
+    double positionErrorSq_ = 0.0;
+    double altitudeErrorSq_ = 0.0;
+    double verticalSpeedSq_ = 0.0;
+    uint64_t stableSamples_ = 0;
+    
     // Autorotation parameters
     bool autorotationActive_ = false;
     double autorotationStartAltitude_ = 0.0;
@@ -151,6 +217,9 @@ private:
     double calculateHoverPower(double altitude, double temperature) const;
     double calculateFlareAltitude(double descentRate) const;
     double getGroundElevation(const Position& position) const;
+    void updateDrift(const Position& position, double dt);
+    RotorcraftControl holdPosition(const AircraftState& state, const Position& target, double maxError, double dt);
+    void recordHoverQuality(const AircraftState& state, double positionError, double altitudeError);
 };
 
 } // namespace AICopilot
@@ -0,0 +1,118 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Hot Path Trace - scoped per-thread timeline tracing with Chrome trace export
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef HOT_PATH_TRACE_HPP
+#define HOT_PATH_TRACE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * Recorded time of one scope name, inclusive of nested scopes
+ */
+struct TraceSummary {
+    const char* name;
+    uint64_t count;
+    uint64_t totalNs;
+    uint64_t maxNs;
+};
+
+/**
+ * Process-wide scope tracer for the pilot tick
+ *
+ * TRACE_SCOPE("name") records one complete event (name, start, duration)
+ * into the calling thread's ring buffer when its scope closes. Each ring
+ * has a single writer, its own thread, so recording is a clock read and a
+ * few relaxed stores with no locks; when a ring wraps, the oldest events
+ * are overwritten. exportChromeTrace() reads every ring into Chrome trace
+ * JSON, which chrome://tracing and ui.perfetto.dev both load.
+ *
+ * Tracing is off until enable(). While enabled, beginTick() samples one
+ * tick in sampleEveryNTicks; scopes opened outside a sampled tick cost a
+ * relaxed atomic load and a branch. Worker threads record while the
+ * current tick is sampled, so a slow worker task may be cut at that edge.
+ *
+ * Names must outlive the trace: pass string literals or intern().
+ * Building without AICOPILOT_ENABLE_TRACING compiles TRACE_SCOPE away.
+ */
+class HotPathTracer {
+public:
+    static constexpr size_t RING_EVENTS = 8192;   // per thread, power of two
+
+    static void enable(uint32_t sampleEveryNTicks = 1);
+    static void disable();
+    static bool isEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+    // Called once at the start of each pilot tick; decides whether it is traced
+    static void beginTick();
+    static bool isRecording() { return recording_.load(std::memory_order_relaxed); }
+
+    static uint64_t nowNs();
+    static void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Stable copy of a dynamic name, e.g. a scheduler task's
+    static const char* intern(const std::string& name);
+
+    // Label the calling thread in exported traces
+    static void setThreadName(const std::string& name);
+
+    static std::string exportChromeTrace();
+    static bool writeChromeTrace(const std::string& path);
+
+    // Events since clear() totalled by name, most total time first
+    static std::vector<TraceSummary> summarize();
+
+    // Drop recorded events (rings and thread names are kept)
+    static void clear();
+
+    // Events overwritten before they could be exported
+    static uint64_t overwrittenEvents();
+
+private:
+    static std::atomic<bool> enabled_;
+    static std::atomic<bool> recording_;
+};
+
+/**
+ * RAII scope behind TRACE_SCOPE
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : name_(name), startNs_(HotPathTracer::isRecording() ? HotPathTracer::nowNs() : 0) {}
+    ~TraceScope() {
+        if (startNs_) HotPathTracer::record(name_, startNs_, HotPathTracer::nowNs());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name_;
+    uint64_t startNs_;   // 0 when not recording
+};
+
+} // namespace AICopilot
+
+#ifdef AICOPILOT_ENABLE_TRACING
+#define AICOPILOT_TRACE_CONCAT_(a, b) a##b
+#define AICOPILOT_TRACE_CONCAT(a, b) AICOPILOT_TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(name) ::AICopilot::TraceScope AICOPILOT_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#endif
+
+#endif // HOT_PATH_TRACE_HPP
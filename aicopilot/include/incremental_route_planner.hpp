@@ -0,0 +1,117 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Incremental Route Planner - D* Lite over a small route graph
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef INCREMENTAL_ROUTE_PLANNER_HPP
+#define INCREMENTAL_ROUTE_PLANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * Shortest paths to a fixed goal that are repaired, not recomputed
+ *
+ * D* Lite (Koenig and Likhachev) searches backwards from the goal and keeps
+ * its g/rhs values between queries. When leg costs change (new winds, a
+ * weather cell closing a leg) or the start moves along the route, only the
+ * nodes whose distance to the goal actually changed are expanded again, so
+ * a periodic re-plan costs a fraction of a fresh search.
+ *
+ * The heuristic must be consistent and a lower bound on every path cost,
+ * and must stay so across cost changes; setGoal() starts over when it no
+ * longer is. Not thread safe.
+ */
+class IncrementalRoutePlanner {
+public:
+    static constexpr double INFINITE_COST = std::numeric_limits<double>::infinity();
+
+    // Lower bound on the cost between two nodes
+    using Heuristic = std::function<double(uint32_t from, uint32_t to)>;
+
+    void setHeuristic(Heuristic heuristic) { heuristic_ = std::move(heuristic); }
+
+    uint32_t addNode();
+
+    /**
+     * Add a directed edge; allowed after a goal was set
+     * @return Edge id for updateEdgeCost()
+     */
+    uint32_t addEdge(uint32_t from, uint32_t to, double cost);
+
+    /**
+     * Change the cost of an edge; INFINITE_COST closes it
+     */
+    void updateEdgeCost(uint32_t edge, double cost);
+
+    double getEdgeCost(uint32_t edge) const { return edges_[edge].cost; }
+
+    // Drop all search state and search towards a new goal
+    void setGoal(uint32_t goal);
+
+    /**
+     * Cheapest path from a start to the goal, repairing earlier results
+     * @param start Node to leave from; may differ from the last call
+     * @param path Nodes from start to goal, empty if unreachable
+     * @return Path cost, INFINITE_COST if unreachable
+     */
+    double findPath(uint32_t start, std::vector<uint32_t>& path);
+
+    bool hasGoal() const { return hasGoal_; }
+    uint32_t getGoal() const { return goal_; }
+    size_t getNodeCount() const { return g_.size(); }
+
+    // Nodes expanded by the last findPath()
+    size_t getExpandedCount() const { return expanded_; }
+
+    void clear();
+
+private:
+    using Key = std::pair<double, double>;
+
+    struct Edge {
+        uint32_t from;
+        uint32_t to;
+        double cost;
+    };
+
+    Key calculateKey(uint32_t node) const;
+    void updateVertex(uint32_t node);
+    void recomputeRhs(uint32_t node);
+    void computeShortestPath();
+    double h(uint32_t from, uint32_t to) const { return heuristic_ ? heuristic_(from, to) : 0.0; }
+
+    Heuristic heuristic_;
+    std::vector<Edge> edges_;
+    std::vector<std::vector<uint32_t>> outgoing_;
+    std::vector<std::vector<uint32_t>> incoming_;
+    std::vector<double> g_;
+    std::vector<double> rhs_;
+    std::vector<Key> queuedKey_;
+    std::vector<bool> queued_;
+    std::set<std::pair<Key, uint32_t>> queue_;
+
+    bool hasGoal_ = false;
+    uint32_t goal_ = 0;
+    uint32_t start_ = 0;
+    bool hasStart_ = false;
+    double km_ = 0.0;
+    size_t expanded_ = 0;
+};
+
+} // namespace AICopilot
+
+#endif // INCREMENTAL_ROUTE_PLANNER_HPP
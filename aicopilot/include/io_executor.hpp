@@ -0,0 +1,103 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* I/O Executor - a few shared threads for blocking background I/O
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef IO_EXECUTOR_HPP
+#define IO_EXECUTOR_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace AICopilot {
+
+struct IoExecutorStats {
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    uint64_t failed = 0;    // jobs that threw
+    size_t queued = 0;
+    size_t running = 0;
+    size_t threads = 0;
+};
+
+/**
+ * Shared threads for the background loaders' blocking I/O
+ *
+ * Tile prefetch, raster block reads, facility lookups, snapshot and
+ * weather-file loads used to start a thread (or a std::async) each. They
+ * now post jobs here instead, so however many loaders exist they share a
+ * handful of threads. Loaders that need ordering keep their own queue and
+ * post one job per item (see TerrainPrefetcher), which keeps one slow
+ * caller from holding a thread for its whole backlog.
+ *
+ * Jobs run in FIFO order. The destructor runs whatever is still queued,
+ * so futures from submit() always resolve. A job must not wait for
+ * another job on the same executor.
+ */
+class IoExecutor {
+public:
+    using Job = std::function<void()>;
+
+    static constexpr size_t DEFAULT_THREAD_COUNT = 4;
+
+    // 0 uses DEFAULT_THREAD_COUNT
+    explicit IoExecutor(size_t threadCount = DEFAULT_THREAD_COUNT);
+    ~IoExecutor();
+
+    IoExecutor(const IoExecutor&) = delete;
+    IoExecutor& operator=(const IoExecutor&) = delete;
+
+    // Process-wide executor, created on first use; loaders default to it
+    static std::shared_ptr<IoExecutor> shared();
+
+    // Queue a job; exceptions it throws are logged and counted as failed
+    void post(Job job);
+
+    // Queue a callable; its result (or exception) arrives through the future
+    template <typename Fn>
+    std::future<std::invoke_result_t<std::decay_t<Fn>>> submit(Fn&& fn) {
+        using Result = std::invoke_result_t<std::decay_t<Fn>>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Fn>(fn));
+        std::future<Result> future = task->get_future();
+        post([task]() { (*task)(); });
+        return future;
+    }
+
+    // Block until nothing is queued or running
+    void waitIdle();
+
+    size_t getThreadCount() const { return threads_.size(); }
+    IoExecutorStats getStats() const;
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> threads_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable workCv_;
+    std::condition_variable idleCv_;
+    std::deque<Job> jobs_;      // guarded by mutex_
+    size_t running_ = 0;
+    bool stopping_ = false;
+    IoExecutorStats stats_;
+};
+
+} // namespace AICopilot
+
+#endif // IO_EXECUTOR_HPP
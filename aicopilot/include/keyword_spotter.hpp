@@ -0,0 +1,101 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef KEYWORD_SPOTTER_HPP
+#define KEYWORD_SPOTTER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * KeywordSpotter - Cheap wake-phrase detector ahead of full recognition
+ *
+ * The model is a set of enrolled examples of the wake phrase or callsign,
+ * each a sequence of fixed-point frame features: Goertzel log powers in
+ * BANDS speech bands (see AudioKernels::goertzelPowers) relative to the
+ * frame's strongest band, so loudness does not matter, only spectral
+ * shape. Every front-end frame advances a streaming subsequence DTW
+ * against each example in int32; the phrase is spotted when an example's
+ * best alignment averages less than the threshold per band.
+ *
+ * A frame costs one pass of BANDS Goertzel filters plus BANDS operations
+ * per template frame per example, a few thousand integer operations per
+ * 32 ms frame, and nothing allocates after enrollment.
+ */
+class KeywordSpotter {
+public:
+    static constexpr size_t BANDS = 8;
+    static constexpr size_t MIN_TEMPLATE_FRAMES = 4;
+    static constexpr size_t MAX_TEMPLATE_FRAMES = 96;   // ~3 seconds
+
+    // Mean |difference| per band in Q8 log2 power (256 = 3 dB)
+    static constexpr int32_t DEFAULT_THRESHOLD = 128;
+
+    using Features = std::array<int16_t, BANDS>;
+
+    explicit KeywordSpotter(int32_t threshold = DEFAULT_THRESHOLD);
+
+    /**
+     * Enroll one example of the wake phrase: 16 kHz PCM straight from the
+     * microphone, with a little silence either side. Frames 20 dB below the
+     * loudest are trimmed from the ends. Returns false if nothing stands
+     * out of the silence, or the phrase is shorter or longer than a
+     * template may be.
+     */
+    bool enroll(const int16_t* samples, size_t count);
+    bool enroll(const std::vector<int16_t>& samples) { return enroll(samples.data(), samples.size()); }
+
+    size_t getTemplateCount() const { return templates_.size(); }
+    void clearTemplates();
+
+    /**
+     * Advance by one pre-emphasized front-end frame. Returns true on the
+     * frame after the best match of an enrolled example ended; the search
+     * then restarts so one utterance wakes once.
+     */
+    bool processFrame(const int16_t* samples, size_t count);
+
+    // Forget partial matches, e.g. after the wake gate closes
+    void reset();
+
+    // Best per-band alignment cost ending at the last frame; INT32_MAX if none
+    int32_t getLastScore() const { return last_score_; }
+    int32_t getThreshold() const { return threshold_; }
+    void setThreshold(int32_t threshold) { threshold_ = threshold; }
+
+    static Features extractFeatures(const int16_t* samples, size_t count);
+
+private:
+    struct Template {
+        std::vector<Features> frames;
+        std::vector<int32_t> cost;      // DTW column, [0] is the free start
+        std::vector<int32_t> steps;     // input frames on the path to each cell
+    };
+
+    int32_t threshold_;
+    int32_t last_score_;
+    int32_t candidate_;             // best score under the threshold so far
+    std::vector<Template> templates_;
+};
+
+} // namespace AICopilot
+
+#endif // KEYWORD_SPOTTER_HPP
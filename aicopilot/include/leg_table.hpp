@@ -0,0 +1,75 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Leg Table - precomputed great-circle geometry of a flight plan's legs
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef LEG_TABLE_HPP
+#define LEG_TABLE_HPP
+
+#include "aicopilot_types.h"
+#include "geodesy.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * Great-circle geometry of every leg of a route, kept across ticks
+ *
+ * Holds each fix's earth-centred unit vector and, per leg, its length, the
+ * distance flown to its end, its initial and final courses and the pole of
+ * its great circle. Editing a fix recomputes only the one or two legs that
+ * touch it; the running distances after it are re-summed without trig.
+ * Distance-to-go is then a lookup and cross-track error a dot product.
+ */
+class LegTable {
+public:
+    // Leg i runs from fix i to fix i + 1
+    struct Leg {
+        double length = 0.0;           // nautical miles
+        double cumulative = 0.0;       // nautical miles from the first fix to this leg's end
+        double initialCourse = 0.0;    // degrees true, leaving the first fix
+        double finalCourse = 0.0;      // degrees true, arriving at the second fix
+        Geodesy::UnitVector pole;      // unit normal of the leg's great circle; zero if degenerate
+    };
+
+    void build(const std::vector<Waypoint>& fixes);
+    void insert(size_t index, const Position& position);
+    void remove(size_t index);
+    void update(size_t index, const Position& position);
+    void clear();
+
+    size_t getFixCount() const { return fixes_.size(); }
+    size_t getLegCount() const { return legs_.size(); }
+    const Leg& getLeg(size_t index) const { return legs_[index]; }
+    const Geodesy::UnitVector& getFixVector(size_t index) const { return fixes_[index]; }
+
+    double getTotalDistance() const { return legs_.empty() ? 0.0 : legs_.back().cumulative; }
+
+    // Distance along the route from a fix to the last one, nautical miles
+    double getDistanceFrom(size_t fix) const;
+
+    /**
+     * Cross-track distance from a leg's great circle
+     * @return Nautical miles, positive right of course; 0 for a degenerate leg
+     */
+    double crossTrackDistance(size_t leg, const Position& position) const;
+
+private:
+    void computeLeg(size_t index);
+    void accumulateFrom(size_t index);
+
+    std::vector<Position> positions_;
+    std::vector<Geodesy::UnitVector> fixes_;
+    std::vector<Leg> legs_;
+};
+
+} // namespace AICopilot
+
+#endif // LEG_TABLE_HPP
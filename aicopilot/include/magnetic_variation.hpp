@@ -0,0 +1,65 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Magnetic Variation - World Magnetic Model evaluated once into a grid
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef MAGNETIC_VARIATION_HPP
+#define MAGNETIC_VARIATION_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * Magnetic declination (variation) from the World Magnetic Model
+ *
+ * evaluate() sums the WMM spherical-harmonic series on the WGS-84
+ * ellipsoid at sea level, with the secular variation applied to the
+ * requested date. The series is truncated at degree MAX_DEGREE; the
+ * dropped terms move declination by well under a tenth of a degree
+ * outside the polar regions.
+ *
+ * The grid evaluates the model once per date at every STEP_DEG node, row
+ * by row so the Legendre functions are computed once per latitude, and
+ * lookup() is a bilinear blend of four floats. Declination is in degrees,
+ * positive east, so magnetic = true - variation.
+ */
+class MagneticVariationGrid {
+public:
+    static constexpr double MODEL_EPOCH = 2020.0;   // WMM2020 coefficients
+    static constexpr int MAX_DEGREE = 8;
+    static constexpr double STEP_DEG = 0.5;
+    static constexpr size_t ROWS = 361;             // -90..90
+    static constexpr size_t COLUMNS = 721;          // -180..180, both edges stored
+
+    explicit MagneticVariationGrid(double decimalYear);
+
+    // Grid for the current date, built on first use and shared
+    static std::shared_ptr<const MagneticVariationGrid> current();
+
+    // Full model evaluation at one point
+    static double evaluate(double latitude, double longitude, double decimalYear);
+
+    // Today's date as a decimal year, e.g. 2026.78
+    static double currentDecimalYear();
+
+    double lookup(double latitude, double longitude) const;
+
+    double getDecimalYear() const { return decimalYear_; }
+
+private:
+    double decimalYear_;
+    std::vector<float> cells_;   // ROWS x COLUMNS, row-major from the south pole
+};
+
+} // namespace AICopilot
+
+#endif // MAGNETIC_VARIATION_HPP
@@ -0,0 +1,146 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Memory Arena - per-tick bump arena and fixed-block slab pool
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef MEMORY_ARENA_HPP
+#define MEMORY_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * Bump allocator for per-tick temporaries
+ *
+ * Allocations are carved from retained chunks in order and never freed one
+ * by one: reset() at the start of a tick makes the whole arena reusable, so
+ * anything allocated from it must be dead by then. When a tick overflows
+ * the first chunk, the next reset merges the chunks into one of their
+ * combined size, so once the arena has seen its busiest tick a steady-state
+ * tick makes no heap allocations at all.
+ *
+ * Not thread-safe; each thread uses its own, see forThread().
+ */
+class FrameArena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_CHUNK_BYTES = 64 * 1024;
+
+    explicit FrameArena(size_t initialBytes = DEFAULT_CHUNK_BYTES);
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Release this tick's allocations, keeping (and if needed merging) the chunks
+    void reset();
+
+    size_t bytesUsed() const { return used_; }          // this tick, with alignment padding
+    size_t capacity() const;                            // retained chunk bytes
+    size_t highWaterBytes() const { return highWater_; }
+    uint64_t chunkAllocations() const { return chunkAllocations_; }   // heap allocations so far
+
+    // The calling thread's arena; the pilot loop resets it once per tick
+    static FrameArena& forThread();
+
+private:
+    struct Chunk {
+        std::byte* data;
+        size_t size;
+    };
+
+    std::vector<Chunk> chunks_;
+    size_t current_ = 0;     // chunk being carved
+    size_t offset_ = 0;      // into chunks_[current_]
+    size_t used_ = 0;
+    size_t highWater_ = 0;
+    uint64_t chunkAllocations_ = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    void addChunk(size_t size);
+    void releaseChunks();
+};
+
+/**
+ * Fixed-size block pool carved from slabs
+ *
+ * Blocks come from slabs of blocksPerSlab blocks and return to an intrusive
+ * free list, so allocate and deallocate are O(1); slabs are only released
+ * with the pool. Each thread keeps a cache of up to THREAD_CACHE_BLOCKS free
+ * blocks per pool and takes the pool's lock only to refill or drain half of
+ * it at once. Blocks cached by a thread that exits stay with the pool's
+ * slabs until the pool is destroyed.
+ *
+ * As a memory_resource it serves requests that fit a block and sends
+ * larger or over-aligned ones to the upstream resource.
+ */
+class SlabPool : public std::pmr::memory_resource {
+public:
+    static constexpr size_t THREAD_CACHE_BLOCKS = 64;
+
+    SlabPool(size_t blockSize, size_t blocksPerSlab = 1000,
+             std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    ~SlabPool() override;
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    using std::pmr::memory_resource::allocate;
+    using std::pmr::memory_resource::deallocate;
+
+    // One block of blockSize() bytes
+    void* allocate();
+    void deallocate(void* block);
+
+    size_t blockSize() const { return blockSize_; }
+    size_t slabCount() const;
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct ThreadCache;
+
+    size_t blockSize_;
+    size_t blocksPerSlab_;
+    std::pmr::memory_resource* upstream_;
+    uint64_t id_;            // tells this pool's thread caches from a dead pool's
+
+    mutable std::mutex mutex_;
+    FreeBlock* free_ = nullptr;
+    std::vector<std::byte*> slabs_;
+
+    ThreadCache& threadCache();
+    void refill(ThreadCache& cache);
+    void drain(ThreadCache& cache, size_t keep);
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    bool fitsBlock(size_t bytes, size_t alignment) const {
+        return bytes <= blockSize_ && alignment <= alignof(std::max_align_t);
+    }
+};
+
+} // namespace AICopilot
+
+#endif // MEMORY_ARENA_HPP
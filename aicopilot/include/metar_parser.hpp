@@ -14,7 +14,11 @@
 #define METAR_PARSER_HPP
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
 #include <cmath>
 #include <regex>
 
@@ -80,6 +84,561 @@ namespace Visibility {
     static constexpr double MAX_VISIBILITY_SM = 10.0;      // 10+ SM
 }
 
+// ============================================================================
+// METAR Token Syntax
+// ============================================================================
+
+// Token classes recognised in the body of a report
+enum class METARTokenType : uint8_t {
+    UNKNOWN,
+    REPORT_TYPE,            // METAR, SPECI
+    MODIFIER,               // AUTO, COR
+    DATE_TIME,              // 121851Z
+    WIND,                   // 31008KT, VRB05KT, 27015G25KT, 05006MPS
+    WIND_VARIATION,         // 180V240
+    VISIBILITY,             // 10SM, 1/4SM, M1/4SM, P6SM, 9999
+    VISIBILITY_WHOLE,       // The "1" of "1 1/2SM"
+    RUNWAY_RANGE,           // R04R/2200FT
+    CAVOK,
+    WEATHER,                // -RA, +TSRA, VCSH, BR, NSW
+    CLOUD,                  // FEW030, BKN015CB, OVC///
+    SKY_CLEAR,              // SKC, CLR, NSC, NCD
+    VERTICAL_VISIBILITY,    // VV002
+    TEMPERATURE,            // 23/14, M05/M08
+    ALTIMETER,              // A3012, Q1018
+    TREND,                  // NOSIG, BECMG, TEMPO
+    REMARKS                 // RMK
+};
+
+// Two-letter present weather codes, one bit each in a weather group
+enum class METARWeather : uint8_t {
+    MI, PR, BC, DR, BL, SH, TS, FZ,                 // Descriptors
+    DZ, RA, SN, SG, IC, PL, GR, GS, UP,             // Precipitation
+    BR, FG, FU, VA, DU, SA, HZ, PY,                 // Obscuration
+    PO, SQ, FC, SS, DS,                             // Other
+    COUNT
+};
+
+/**
+ * Constexpr decoders for single METAR tokens
+ *
+ * Each decoder validates one token class and extracts its fields in one
+ * pass over a string_view, with no allocation. The token classifier is
+ * built from the same decoders, so classification and parsing agree and
+ * both can run at compile time.
+ */
+namespace METARSyntax {
+    constexpr bool isDigit(char c) { return c >= '0' && c <= '9'; }
+    constexpr bool isUpper(char c) { return c >= 'A' && c <= 'Z'; }
+
+    constexpr bool allDigits(std::string_view s) {
+        if (s.empty()) return false;
+        for (char c : s) {
+            if (!isDigit(c)) return false;
+        }
+        return true;
+    }
+
+    // Value of a run of digits; callers check allDigits first
+    constexpr int digitsValue(std::string_view s) {
+        int value = 0;
+        for (char c : s) value = value * 10 + (c - '0');
+        return value;
+    }
+
+    constexpr bool startsWith(std::string_view s, std::string_view prefix) {
+        return s.size() >= prefix.size() && s.substr(0, prefix.size()) == prefix;
+    }
+
+    constexpr bool endsWith(std::string_view s, std::string_view suffix) {
+        return s.size() >= suffix.size() && s.substr(s.size() - suffix.size()) == suffix;
+    }
+
+    // Indexed by METARWeather
+    inline constexpr char WEATHER_CODES[][3] = {
+        "MI", "PR", "BC", "DR", "BL", "SH", "TS", "FZ",
+        "DZ", "RA", "SN", "SG", "IC", "PL", "GR", "GS", "UP",
+        "BR", "FG", "FU", "VA", "DU", "SA", "HZ", "PY",
+        "PO", "SQ", "FC", "SS", "DS"
+    };
+    static_assert(sizeof(WEATHER_CODES) / sizeof(WEATHER_CODES[0]) ==
+                  static_cast<size_t>(METARWeather::COUNT), "WEATHER_CODES must match METARWeather");
+
+    constexpr uint32_t weatherBit(METARWeather code) { return 1u << static_cast<unsigned>(code); }
+
+    constexpr uint32_t PRECIPITATION_MASK =
+        weatherBit(METARWeather::DZ) | weatherBit(METARWeather::RA) | weatherBit(METARWeather::SN) |
+        weatherBit(METARWeather::SG) | weatherBit(METARWeather::IC) | weatherBit(METARWeather::PL) |
+        weatherBit(METARWeather::GR) | weatherBit(METARWeather::GS) | weatherBit(METARWeather::UP);
+
+    // -1 if the pair at s[i] is not a weather code
+    constexpr int weatherCodeIndex(std::string_view s, size_t i) {
+        for (size_t k = 0; k < static_cast<size_t>(METARWeather::COUNT); ++k) {
+            if (WEATHER_CODES[k][0] == s[i] && WEATHER_CODES[k][1] == s[i + 1]) {
+                return static_cast<int>(k);
+            }
+        }
+        return -1;
+    }
+
+    struct WindGroup {
+        bool valid = false;
+        bool variable = false;
+        int direction = 0;      // degrees true, 0 if variable
+        int speed = 0;          // knots
+        int gust = 0;           // knots, 0 if none
+    };
+
+    // (ddd|VRB) ss[s] [Ggg[g]] (KT|MPS|KMH)
+    constexpr WindGroup decodeWind(std::string_view t) {
+        WindGroup wind;
+        double toKnots = 1.0;
+        if (endsWith(t, "KT")) {
+            t.remove_suffix(2);
+        } else if (endsWith(t, "MPS")) {
+            t.remove_suffix(3);
+            toKnots = 1.943844;
+        } else if (endsWith(t, "KMH")) {
+            t.remove_suffix(3);
+            toKnots = 1.0 / 1.852;
+        } else {
+            return wind;
+        }
+        if (t.size() < 5) return wind;
+
+        if (startsWith(t, "VRB")) {
+            wind.variable = true;
+        } else if (allDigits(t.substr(0, 3))) {
+            wind.direction = digitsValue(t.substr(0, 3));
+            if (wind.direction > 360) return wind;
+        } else {
+            return wind;
+        }
+
+        std::string_view rest = t.substr(3);
+        size_t gustPos = rest.find('G');
+        std::string_view speed = rest.substr(0, gustPos);
+        if (speed.size() < 2 || speed.size() > 3 || !allDigits(speed)) return wind;
+        wind.speed = static_cast<int>(digitsValue(speed) * toKnots + 0.5);
+
+        if (gustPos != std::string_view::npos) {
+            std::string_view gust = rest.substr(gustPos + 1);
+            if (gust.size() < 2 || gust.size() > 3 || !allDigits(gust)) return wind;
+            wind.gust = static_cast<int>(digitsValue(gust) * toKnots + 0.5);
+        }
+        wind.valid = true;
+        return wind;
+    }
+
+    struct WindVariation {
+        bool valid = false;
+        int from = 0;
+        int to = 0;
+    };
+
+    // dddVddd
+    constexpr WindVariation decodeWindVariation(std::string_view t) {
+        WindVariation range;
+        if (t.size() != 7 || t[3] != 'V') return range;
+        if (!allDigits(t.substr(0, 3)) || !allDigits(t.substr(4))) return range;
+        range.from = digitsValue(t.substr(0, 3));
+        range.to = digitsValue(t.substr(4));
+        range.valid = range.from <= 360 && range.to <= 360;
+        return range;
+    }
+
+    struct VisibilityGroup {
+        bool valid = false;
+        bool fractional = false;    // Can follow a VISIBILITY_WHOLE token
+        double statuteMiles = 0.0;
+    };
+
+    // n[n]SM, P6SM, [M]n/d[d]SM, or four-digit meters
+    constexpr VisibilityGroup decodeVisibility(std::string_view t) {
+        VisibilityGroup vis;
+        if (endsWith(t, "SM")) {
+            t.remove_suffix(2);
+            if (startsWith(t, "P")) {
+                // "Greater than": P6SM is the top of the US scale
+                t.remove_prefix(1);
+                if (!allDigits(t)) return vis;
+                vis.statuteMiles = Visibility::MAX_VISIBILITY_SM;
+                vis.valid = true;
+                return vis;
+            }
+            if (startsWith(t, "M")) t.remove_prefix(1);  // "Less than"
+            size_t slash = t.find('/');
+            if (slash == std::string_view::npos) {
+                if (!allDigits(t)) return vis;
+                vis.statuteMiles = digitsValue(t);
+            } else {
+                std::string_view num = t.substr(0, slash);
+                std::string_view den = t.substr(slash + 1);
+                if (!allDigits(num) || !allDigits(den) || digitsValue(den) == 0) return vis;
+                vis.statuteMiles = static_cast<double>(digitsValue(num)) / digitsValue(den);
+                vis.fractional = true;
+            }
+            vis.valid = true;
+            return vis;
+        }
+
+        if (endsWith(t, "NDV")) t.remove_suffix(3);  // No directional variation
+        if (t.size() != 4 || !allDigits(t)) return vis;
+        // 9999 reports 10 km or more, i.e. unrestricted
+        int meters = digitsValue(t);
+        vis.statuteMiles = meters == 9999 ? Visibility::MAX_VISIBILITY_SM
+                                          : meters / Visibility::STATUTE_MILE_TO_METERS;
+        vis.valid = true;
+        return vis;
+    }
+
+    struct WeatherGroup {
+        bool valid = false;
+        uint32_t components = 0;    // Bit per METARWeather
+        int intensity = 0;          // -1 light, 0 moderate, +1 heavy
+        bool vicinity = false;
+    };
+
+    // [+|-][VC] one or more two-letter codes, or NSW (no significant weather)
+    constexpr WeatherGroup decodeWeather(std::string_view t) {
+        WeatherGroup wx;
+        if (t == "NSW") {
+            wx.valid = true;
+            return wx;
+        }
+        if (startsWith(t, "+")) {
+            wx.intensity = 1;
+            t.remove_prefix(1);
+        } else if (startsWith(t, "-")) {
+            wx.intensity = -1;
+            t.remove_prefix(1);
+        }
+        if (startsWith(t, "VC")) {
+            wx.vicinity = true;
+            t.remove_prefix(2);
+        }
+        if (t.empty() || t.size() % 2 != 0 || t.size() > 8) return wx;
+        for (size_t i = 0; i < t.size(); i += 2) {
+            int code = weatherCodeIndex(t, i);
+            if (code < 0) return wx;
+            wx.components |= 1u << code;
+        }
+        wx.valid = true;
+        return wx;
+    }
+
+    struct CloudGroup {
+        bool valid = false;
+        CloudCoverage coverage = CloudCoverage::UNKNOWN;
+        int altitudeFeet = 0;       // AGL; 0 when clear or not reported
+        bool cumulonimbus = false;
+        bool toweringCumulus = false;
+    };
+
+    // (FEW|SCT|BKN|OVC)hhh[CB|TCU], VVhhh, or SKC/CLR/NSC/NCD
+    constexpr CloudGroup decodeCloud(std::string_view t) {
+        CloudGroup cloud;
+        if (t == "SKC" || t == "NSC" || t == "NCD") {
+            cloud.coverage = CloudCoverage::SKC;
+            cloud.valid = true;
+            return cloud;
+        }
+        if (t == "CLR") {
+            cloud.coverage = CloudCoverage::CLR;
+            cloud.valid = true;
+            return cloud;
+        }
+
+        size_t heightPos = 3;
+        if (startsWith(t, "FEW")) cloud.coverage = CloudCoverage::FEW;
+        else if (startsWith(t, "SCT")) cloud.coverage = CloudCoverage::SCT;
+        else if (startsWith(t, "BKN")) cloud.coverage = CloudCoverage::BKN;
+        else if (startsWith(t, "OVC")) cloud.coverage = CloudCoverage::OVC;
+        else if (startsWith(t, "VV")) {
+            cloud.coverage = CloudCoverage::VV;
+            heightPos = 2;
+        } else {
+            return cloud;
+        }
+        if (t.size() < heightPos + 3) return cloud;
+
+        // Height in hundreds of feet; "///" when an automated station cannot tell
+        std::string_view height = t.substr(heightPos, 3);
+        if (allDigits(height)) {
+            cloud.altitudeFeet = digitsValue(height) * 100;
+        } else if (height != "///") {
+            return cloud;
+        }
+
+        std::string_view type = t.substr(heightPos + 3);
+        if (cloud.coverage == CloudCoverage::VV && !type.empty()) return cloud;
+        if (type == "CB") cloud.cumulonimbus = true;
+        else if (type == "TCU") cloud.toweringCumulus = true;
+        else if (!type.empty() && type != "///") return cloud;
+
+        cloud.valid = true;
+        return cloud;
+    }
+
+    // [M]dd, also accepting a '-' sign; false if malformed
+    constexpr bool decodeTemperatureValue(std::string_view t, int& value) {
+        bool negative = startsWith(t, "M") || startsWith(t, "-");
+        if (negative) t.remove_prefix(1);
+        if (t.size() < 1 || t.size() > 2 || !allDigits(t)) return false;
+        value = negative ? -digitsValue(t) : digitsValue(t);
+        return true;
+    }
+
+    struct TemperatureGroup {
+        bool valid = false;
+        bool hasDewpoint = false;
+        int temperature = 0;        // Celsius
+        int dewpoint = 0;           // Celsius
+    };
+
+    // [M]tt/[M]dd, dewpoint may be missing
+    constexpr TemperatureGroup decodeTemperature(std::string_view t) {
+        TemperatureGroup temp;
+        size_t slash = t.find('/');
+        if (slash == std::string_view::npos || t.find('/', slash + 1) != std::string_view::npos) return temp;
+        if (!decodeTemperatureValue(t.substr(0, slash), temp.temperature)) return temp;
+        std::string_view dew = t.substr(slash + 1);
+        if (!dew.empty()) {
+            if (!decodeTemperatureValue(dew, temp.dewpoint)) return temp;
+            temp.hasDewpoint = true;
+        }
+        temp.valid = true;
+        return temp;
+    }
+
+    struct AltimeterGroup {
+        bool valid = false;
+        double inHg = 29.92;
+        double mbar = 1013.0;
+    };
+
+    // Adddd (hundredths of inHg) or Qdddd (hectopascals)
+    constexpr AltimeterGroup decodeAltimeter(std::string_view t) {
+        AltimeterGroup alt;
+        if (t.size() != 5 || !allDigits(t.substr(1))) return alt;
+        int value = digitsValue(t.substr(1));
+        if (t[0] == 'A') {
+            alt.inHg = value / 100.0;
+            alt.mbar = alt.inHg * 33.8639;
+        } else if (t[0] == 'Q') {
+            alt.mbar = value;
+            alt.inHg = value / 33.8639;
+        } else {
+            return alt;
+        }
+        alt.valid = true;
+        return alt;
+    }
+
+    // DDHHMMZ
+    constexpr bool decodeDateTime(std::string_view t, int& day, int& hour, int& minute) {
+        if (t.size() != 7 || t[6] != 'Z' || !allDigits(t.substr(0, 6))) return false;
+        day = digitsValue(t.substr(0, 2));
+        hour = digitsValue(t.substr(2, 2));
+        minute = digitsValue(t.substr(4, 2));
+        return day >= 1 && day <= 31 && hour <= 23 && minute <= 59;
+    }
+
+    // Three or four upper-case letters or digits
+    constexpr bool isStationId(std::string_view t) {
+        if (t.size() < 3 || t.size() > 4) return false;
+        for (char c : t) {
+            if (!isUpper(c) && !isDigit(c)) return false;
+        }
+        return true;
+    }
+
+    constexpr METARTokenType classify(std::string_view t) {
+        if (t.empty()) return METARTokenType::UNKNOWN;
+        if (t == "RMK") return METARTokenType::REMARKS;
+        if (t == "METAR" || t == "SPECI") return METARTokenType::REPORT_TYPE;
+        if (t == "AUTO" || t == "COR") return METARTokenType::MODIFIER;
+        if (t == "CAVOK") return METARTokenType::CAVOK;
+        if (t == "NOSIG" || t == "BECMG" || t == "TEMPO") return METARTokenType::TREND;
+
+        int day = 0, hour = 0, minute = 0;
+        if (decodeDateTime(t, day, hour, minute)) return METARTokenType::DATE_TIME;
+        if (decodeWind(t).valid) return METARTokenType::WIND;
+        if (decodeWindVariation(t).valid) return METARTokenType::WIND_VARIATION;
+        if (t.size() <= 2 && allDigits(t)) return METARTokenType::VISIBILITY_WHOLE;
+        if (decodeVisibility(t).valid) return METARTokenType::VISIBILITY;
+        if (t.size() > 3 && t[0] == 'R' && isDigit(t[1]) && t.find('/') != std::string_view::npos) {
+            return METARTokenType::RUNWAY_RANGE;
+        }
+
+        CloudGroup cloud = decodeCloud(t);
+        if (cloud.valid) {
+            if (cloud.coverage == CloudCoverage::VV) return METARTokenType::VERTICAL_VISIBILITY;
+            if (cloud.coverage == CloudCoverage::SKC || cloud.coverage == CloudCoverage::CLR) {
+                return METARTokenType::SKY_CLEAR;
+            }
+            return METARTokenType::CLOUD;
+        }
+
+        if (decodeTemperature(t).valid) return METARTokenType::TEMPERATURE;
+        if (decodeAltimeter(t).valid) return METARTokenType::ALTIMETER;
+        if (decodeWeather(t).valid) return METARTokenType::WEATHER;
+        return METARTokenType::UNKNOWN;
+    }
+}
+
+/**
+ * Whitespace tokenizer over a raw METAR string
+ *
+ * Tokens are views into the source, which must outlive them. A trailing
+ * '=' (the end-of-report marker in bulletins) is dropped from the last
+ * token.
+ */
+class METARTokenizer {
+public:
+    constexpr explicit METARTokenizer(std::string_view text) : text_(text) {}
+
+    constexpr bool next(std::string_view& token) {
+        while (pos_ < text_.size() && isSpace(text_[pos_])) pos_++;
+        if (pos_ >= text_.size()) return false;
+
+        size_t start = pos_;
+        while (pos_ < text_.size() && !isSpace(text_[pos_])) pos_++;
+        token = text_.substr(start, pos_ - start);
+        if (token.back() == '=') {
+            token.remove_suffix(1);
+            pos_ = text_.size();
+            if (token.empty()) return false;
+        }
+        return true;
+    }
+
+    // Everything after the last token returned, without leading whitespace
+    constexpr std::string_view rest() const {
+        size_t start = pos_;
+        while (start < text_.size() && isSpace(text_[start])) start++;
+        return text_.substr(start);
+    }
+
+    constexpr size_t position() const { return pos_; }
+
+private:
+    static constexpr bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+    }
+
+    std::string_view text_;
+    size_t pos_ = 0;
+};
+
+/**
+ * Fixed-layout METAR observation
+ *
+ * Everything decoded from one report lives inline: the station code, up
+ * to MAX_CLOUD_LAYERS layers and MAX_WEATHER_GROUPS weather groups as
+ * enum bitmasks. Text that is kept as text (weather tokens, remarks) is
+ * stored as offsets into the source string. Filling one never allocates,
+ * so a caller can reuse a single instance across a whole ingest cycle.
+ */
+struct METARObservation {
+    static constexpr size_t MAX_CLOUD_LAYERS = 6;
+    static constexpr size_t MAX_WEATHER_GROUPS = 4;
+    static constexpr size_t MAX_REPORT_LENGTH = 0xFFFF;
+    static constexpr double NO_CEILING_FEET = 10000.0;
+
+    struct Weather {
+        uint32_t components = 0;    // Bit per METARWeather
+        int8_t intensity = 0;       // -1 light, 0 moderate, +1 heavy
+        bool vicinity = false;
+        uint16_t offset = 0;        // Token position in the source
+        uint16_t length = 0;
+
+        bool has(METARWeather code) const { return (components & METARSyntax::weatherBit(code)) != 0; }
+        std::string_view text(std::string_view source) const { return source.substr(offset, length); }
+    };
+
+    struct Cloud {
+        CloudCoverage coverage = CloudCoverage::UNKNOWN;
+        int altitudeFeet = 0;       // AGL
+        bool cumulonimbus = false;
+        bool toweringCumulus = false;
+    };
+
+    std::array<char, 5> station{};  // NUL-terminated
+    uint8_t day = 0;
+    uint8_t hour = 0;
+    uint8_t minute = 0;
+    bool automated = false;
+    bool corrected = false;
+
+    bool hasWind = false;
+    bool windVariable = false;
+    int windDirection = 0;          // degrees true
+    int windSpeed = 0;              // knots
+    int windGust = 0;               // knots, 0 if none
+    int variableMinDir = 0;         // From a dddVddd group
+    int variableMaxDir = 0;
+
+    bool hasVisibility = false;
+    bool cavok = false;
+    double visibilitySM = Visibility::MAX_VISIBILITY_SM;
+
+    std::array<Weather, MAX_WEATHER_GROUPS> weather{};
+    uint8_t weatherCount = 0;
+
+    std::array<Cloud, MAX_CLOUD_LAYERS> clouds{};
+    uint8_t cloudCount = 0;
+    int verticalVisibilityFeet = -1;    // -1 if not reported
+
+    bool hasTemperature = false;
+    bool hasDewpoint = false;
+    int temperature = 0;            // Celsius
+    int dewpoint = 0;               // Celsius
+
+    bool hasAltimeter = false;
+    double altimeterInHg = 29.92;
+    double altimeterMbar = 1013.0;
+
+    uint16_t remarksOffset = 0;
+    uint16_t remarksLength = 0;
+
+    uint16_t unknownTokens = 0;     // Tokens skipped as unrecognised
+    bool truncated = false;         // More layers or groups than fit
+    const char* error = nullptr;    // Static message when parsing fails
+
+    std::string_view stationId() const {
+        return std::string_view(station.data(), station[3] ? 4 : (station[2] ? 3 : 0));
+    }
+
+    std::string_view remarks(std::string_view source) const { return source.substr(remarksOffset, remarksLength); }
+
+    uint32_t weatherComponents() const {
+        uint32_t all = 0;
+        for (size_t i = 0; i < weatherCount; ++i) all |= weather[i].components;
+        return all;
+    }
+
+    bool hasWeather(METARWeather code) const { return (weatherComponents() & METARSyntax::weatherBit(code)) != 0; }
+    bool thunderstorm() const { return hasWeather(METARWeather::TS); }
+    bool precipitation() const { return (weatherComponents() & METARSyntax::PRECIPITATION_MASK) != 0; }
+
+    // Lowest broken or overcast layer, or the vertical visibility into an obscuration
+    double ceilingFeet() const {
+        double ceiling = NO_CEILING_FEET;
+        for (size_t i = 0; i < cloudCount; ++i) {
+            const Cloud& layer = clouds[i];
+            if ((layer.coverage == CloudCoverage::BKN || layer.coverage == CloudCoverage::OVC) &&
+                layer.altitudeFeet < ceiling) {
+                ceiling = layer.altitudeFeet;
+            }
+        }
+        if (verticalVisibilityFeet >= 0 && verticalVisibilityFeet < ceiling) {
+            ceiling = verticalVisibilityFeet;
+        }
+        return ceiling;
+    }
+};
+
 // ============================================================================
 // METAR Parser Utilities
 // ============================================================================
@@ -104,7 +663,7 @@ public:
      * @return true if parsed successfully
      */
     static bool parseWind(
-        const std::string& windToken,
+        std::string_view windToken,
         int& direction,
         int& speed,
         int& gust,
@@ -124,7 +683,7 @@ public:
      * @return true if parsed successfully
      */
     static bool parseVisibility(
-        const std::string& visToken,
+        std::string_view visToken,
         double& visibilitySmiles);
     
     /**
@@ -142,7 +701,7 @@ public:
      * @return true if parsed successfully
      */
     static bool parseCloudLayer(
-        const std::string& cloudToken,
+        std::string_view cloudToken,
         CloudCoverage& coverage,
         int& altitudeAgl,
         bool& isCB,
@@ -159,7 +718,7 @@ public:
      * @return true if parsed successfully
      */
     static bool parseTemperatureDewpoint(
-        const std::string& tempToken,
+        std::string_view tempToken,
         int& temperature,
         int& dewpoint);
     
@@ -174,7 +733,7 @@ public:
      * @return true if parsed successfully
      */
     static bool parseAltimeter(
-        const std::string& altimeterToken,
+        std::string_view altimeterToken,
         double& altimeterInHg,
         double& altimeterMbar);
     
@@ -189,10 +748,34 @@ public:
      * @return true if parsed successfully
      */
     static bool parseWeatherPhenomena(
-        const std::string& phenomToken,
+        std::string_view phenomToken,
         WeatherPhenomenaCode& phenomena,
         int& intensity);
     
+    /**
+     * Parse a complete METAR report in one pass
+     * Tokens are classified and decoded in place as views into the
+     * source; no allocation is made. The observation is reset first.
+     * An optional leading "METAR"/"SPECI" is skipped; station and
+     * date/time are required, everything else is optional. The body ends
+     * at a trend group (NOSIG, BECMG, TEMPO) and remarks start at RMK.
+     * 
+     * @param metar Raw METAR string
+     * @param observation Output: decoded report
+     * @return true if parsed; otherwise observation.error says why
+     */
+    static bool parse(std::string_view metar, METARObservation& observation);
+    
+    /**
+     * Classify a single body token
+     * Usable in constant expressions.
+     * @param token METAR token
+     * @return Token class, UNKNOWN if no decoder accepts it
+     */
+    static constexpr METARTokenType classifyToken(std::string_view token) {
+        return METARSyntax::classify(token);
+    }
+    
     // ========== Utility Methods ==========
     
     /**
@@ -200,7 +783,7 @@ public:
      * @param token METAR token
      * @return Token type identifier
      */
-    static std::string identifyTokenType(const std::string& token);
+    static std::string identifyTokenType(std::string_view token);
     
     /**
      * Check if token matches regex pattern
@@ -304,7 +887,7 @@ public:
      * @return Vector of tokens
      */
     static std::vector<std::string> tokenizeMETAR(
-        const std::string& metarString);
+        std::string_view metarString);
     
     /**
      * Check for CAVOK (Ceiling And Visibility OK)
@@ -0,0 +1,171 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Metrics Exporter - metrics registry and Prometheus/OpenMetrics scrape endpoint
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef METRICS_EXPORTER_HPP
+#define METRICS_EXPORTER_HPP
+
+#include "hdr_histogram.hpp"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace AICopilot {
+
+class SystemMonitor;
+class PerformanceOptimizer;
+class TaskScheduler;
+
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * Monotonic count; set() mirrors a cumulative count kept elsewhere
+ */
+class MetricCounter {
+public:
+    void inc(uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+    void set(uint64_t total) { value_.store(total, std::memory_order_relaxed); }
+    uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+class MetricGauge {
+public:
+    void set(double value) { value_.store(value, std::memory_order_relaxed); }
+    double value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_{0.0};
+};
+
+/**
+ * Registry of named metric series, rendered in Prometheus text format
+ *
+ * Looking a series up takes the registry lock, so hot paths look theirs up
+ * once and keep the reference: counters, gauges and histograms are updated
+ * with relaxed atomics only and live as long as the registry. Metrics
+ * owned elsewhere are pulled at scrape time, by collectors (which set
+ * gauges and counters) and histogram sources (which return a snapshot).
+ * Both run on the scraping thread.
+ *
+ * Histograms are recorded in milliseconds and exported in seconds against
+ * HISTOGRAM_BOUNDS_SECONDS; a bound's count includes the HDR buckets that
+ * end at or below it, so it is exact to the histogram's ~3% precision.
+ */
+class MetricsRegistry {
+public:
+    static const std::vector<double> HISTOGRAM_BOUNDS_SECONDS;
+
+    using Collector = std::function<void(MetricsRegistry&)>;
+    using HistogramSource = std::function<HdrHistogram()>;
+
+    // Labels added to every series, e.g. {"pilot", tailNumber}
+    void setConstantLabels(const MetricLabels& labels);
+
+    MetricCounter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    MetricGauge& gauge(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    ConcurrentHdrHistogram& histogram(const std::string& name, const std::string& help,
+                                      const MetricLabels& labels = {});
+
+    void addHistogramSource(const std::string& name, const std::string& help,
+                            const MetricLabels& labels, HistogramSource source);
+    void addCollector(Collector collector);
+
+    // Run the collectors, then render every series
+    std::string scrape();
+
+    // Render without collecting
+    std::string render() const;
+
+private:
+    enum class Type { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Series {
+        std::string labels;   // rendered {k="v",...} without the constant labels
+        MetricCounter* counter = nullptr;
+        MetricGauge* gauge = nullptr;
+        ConcurrentHdrHistogram* histogram = nullptr;
+        HistogramSource source;
+    };
+
+    struct Family {
+        Type type;
+        std::string help;
+        std::vector<Series> series;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family> families_;
+    std::string constantLabels_;
+    std::deque<MetricCounter> counters_;              // stable addresses
+    std::deque<MetricGauge> gauges_;
+    std::deque<ConcurrentHdrHistogram> histograms_;
+
+    std::mutex collectorMutex_;                       // serializes scrapes
+    std::vector<Collector> collectors_;
+
+    Series& findOrAdd(const std::string& name, const std::string& help, Type type, const MetricLabels& labels);
+};
+
+/**
+ * Minimal HTTP/1.0 endpoint serving GET /metrics from a registry
+ *
+ * One background thread accepts and answers connections one at a time,
+ * which is plenty for a scrape every few seconds. Binds to loopback by
+ * default; port 0 picks a free port, see port().
+ */
+class MetricsHttpServer {
+public:
+    explicit MetricsHttpServer(MetricsRegistry& registry);
+    ~MetricsHttpServer();
+
+    MetricsHttpServer(const MetricsHttpServer&) = delete;
+    MetricsHttpServer& operator=(const MetricsHttpServer&) = delete;
+
+    bool start(uint16_t port, const std::string& bindAddress = "127.0.0.1");
+    void stop();
+    bool isRunning() const { return running_.load(); }
+    uint16_t port() const { return port_; }
+
+    // Full HTTP response for a raw request
+    std::string respond(const std::string& request);
+
+private:
+    MetricsRegistry& registry_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    uintptr_t listenSocket_;
+    uint16_t port_ = 0;
+
+    void serveLoop();
+};
+
+// Publish a component's metrics under the aicopilot_ prefix via collectors
+void bindSystemMonitorMetrics(MetricsRegistry& registry, const SystemMonitor& monitor);
+void bindPerformanceOptimizerMetrics(MetricsRegistry& registry, const PerformanceOptimizer& optimizer);
+void bindTaskSchedulerMetrics(MetricsRegistry& registry, const TaskScheduler& scheduler);
+
+// Hit/miss/entry series for caches without a binding of their own, e.g. from
+// a collector reading ElevationDatabase::GetCacheStatistics
+void publishCacheStatistics(MetricsRegistry& registry, const std::string& cache,
+                            uint64_t hits, uint64_t misses, uint64_t entries);
+
+} // namespace AICopilot
+
+#endif // METRICS_EXPORTER_HPP
@@ -11,9 +11,13 @@
 #ifndef ML_DECISION_ENGINE_HPP
 #define ML_DECISION_ENGINE_HPP
 
+#include <array>
+#include <cstddef>
 #include <vector>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <map>
 #include <chrono>
 #include <cmath>
@@ -27,8 +31,8 @@ namespace ML {
 struct DecisionScore {
     double score;           // 0-100 decision confidence
     double confidence;      // 0-1 confidence level
-    std::string action;     // Recommended action
-    std::vector<double> factors;  // Contributing factors
+    std::string_view action;          // Recommended action (static text)
+    std::array<double, 4> factors;    // Weather, runway, terrain, navigation
 };
 
 // Environmental inputs for decision making
@@ -66,6 +70,14 @@ struct EnvironmentalInput {
                           airway_density(2), waypoint_density(1) {}
 };
 
+// One candidate for MLDecisionEngine::scoreDecisions(): the weather that
+// differs from the shared input
+struct WeatherVariant {
+    double wind_speed;      // knots
+    double visibility;      // meters
+    double pressure;        // mb
+};
+
 // Decision history entry for analysis
 struct DecisionHistoryEntry {
     std::chrono::system_clock::time_point timestamp;
@@ -105,6 +117,23 @@ public:
         const EnvironmentalInput& input,
         int num_decisions);
     
+    /**
+     * Score candidates that share input and differ only in their weather.
+     * The runway, terrain and navigation terms are computed once for the
+     * batch, the weather terms for all candidates in one loop, and the
+     * statistics are updated once. Scores equal scoreDecision() on each
+     * candidate's input, in candidate order.
+     */
+    std::vector<DecisionScore> scoreDecisions(
+        const EnvironmentalInput& input,
+        const std::vector<WeatherVariant>& candidates);
+    
+    // Same, in storage from resource, e.g. FrameArena::forThread() per tick
+    std::pmr::vector<DecisionScore> scoreDecisions(
+        const EnvironmentalInput& input,
+        const std::vector<WeatherVariant>& candidates,
+        std::pmr::memory_resource* resource);
+    
     // Get recommended action for input
     std::string getRecommendedAction(const EnvironmentalInput& input);
     
@@ -116,6 +145,13 @@ public:
         const EnvironmentalInput& input,
         int max_latency_ms = 100);
     
+    // scoreDecisions() in blocks until max_latency_ms has passed; returns
+    // the candidates scored by then, at least the first block, in order
+    std::vector<DecisionScore> scoreWithLatencyBound(
+        const EnvironmentalInput& input,
+        const std::vector<WeatherVariant>& candidates,
+        int max_latency_ms = 100);
+    
     // Historical analysis of past decisions
     std::vector<DecisionHistoryEntry> analyzeDecisionHistory(
         int lookback_seconds = 3600);
@@ -144,6 +180,36 @@ public:
     void enableStreamingMode(bool enable);
     bool isStreamingModeEnabled() const;
     
+    /**
+     * Streaming mode keeps a running input built from the updates below,
+     * starting from EnvironmentalInput's defaults when the mode is enabled.
+     * Each update replaces only its fields and marks only the term they
+     * feed, so scoreStreaming() recomputes just those. Updates are ignored
+     * outside streaming mode.
+     */
+    void updateWeather(double pressure, double wind_speed, double wind_direction,
+                       double visibility, double temperature);
+    void updateRunway(double runway_length, double runway_width, int runway_condition,
+                      bool ils_available, bool lighting_available);
+    void updateTerrain(double elevation, double slope, bool water_nearby, bool obstacles);
+    void updateRoute(double route_complexity, double airway_density);
+    
+    // Score the running input, as scoreDecision() would score it in full
+    DecisionScore scoreStreaming();
+    const EnvironmentalInput& getStreamingInput() const { return stream_input_; }
+    
+    // Feature normalization parameters; in streaming mode the means and
+    // standard deviations follow the scored samples (Welford, once two
+    // have been scored)
+    struct NormalizationParams {
+        double pressure_mean, pressure_std;
+        double wind_speed_mean, wind_speed_std;
+        double visibility_mean, visibility_std;
+        double elevation_mean, elevation_std;
+        double complexity_mean, complexity_std;
+    };
+    NormalizationParams getNormalizationParams() const { return norm_params_; }
+    
     // Adjust scoring sensitivity (0.5-2.0)
     void setSensitivity(double sensitivity);
     double getSensitivity() const;
@@ -160,22 +226,96 @@ public:
     size_t getHistorySize() const;
     
 private:
+    // Candidates scored between deadline checks
+    static constexpr size_t SCORE_BLOCK_SIZE = 16;
+    
+    // Weighted combination, sensitivity and action of the four terms
+    DecisionScore combineScores(double weather_score, double runway_score,
+                                double terrain_score, double navigation_score) const;
+    void scoreBlock(const EnvironmentalInput& input, const WeatherVariant* candidates, size_t count,
+                    double runway_score, double terrain_score, double navigation_score,
+                    DecisionScore* scores) const;
+    template <typename Scores>
+    void scoreBatch(const EnvironmentalInput& input, const std::vector<WeatherVariant>& candidates,
+                    Scores& scores);
+    void recordBatchLatency(double latency_ms, const DecisionScore* scores, size_t count);
+    
     // Core scoring functions
-    double calculateWeatherScore(const EnvironmentalInput& input);
-    double calculateRunwayScore(const EnvironmentalInput& input);
-    double calculateTerrainScore(const EnvironmentalInput& input);
-    double calculateNavigationScore(const EnvironmentalInput& input);
+    double calculateWeatherScore(const EnvironmentalInput& input) const;
+    double calculateRunwayScore(const EnvironmentalInput& input) const;
+    double calculateTerrainScore(const EnvironmentalInput& input) const;
+    double calculateNavigationScore(const EnvironmentalInput& input) const;
     
     // Normalization helpers
     double normalizeValue(double value, double min_val, double max_val);
     double applySigmoid(double x);
     
+    // Anomaly detection features, normalized, in this order
+    enum AnomalyFeature : size_t {
+        PRESSURE_FEATURE,
+        WIND_SPEED_FEATURE,
+        VISIBILITY_FEATURE,
+        TEMPERATURE_FEATURE,
+        RUNWAY_LENGTH_FEATURE,
+        ELEVATION_FEATURE,
+        ROUTE_COMPLEXITY_FEATURE,
+        AIRWAY_DENSITY_FEATURE,
+        ANOMALY_FEATURE_COUNT
+    };
+    using AnomalyFeatureVector = std::array<double, ANOMALY_FEATURE_COUNT>;
+    
+    // Mean and variance by Welford's method; remove() undoes an add()
+    struct RunningStat {
+        double count = 0;
+        double mean = 0;
+        double m2 = 0;
+        
+        void add(double x) {
+            count += 1;
+            double delta = x - mean;
+            mean += delta / count;
+            m2 += delta * (x - mean);
+        }
+        void remove(double x) {
+            if (count <= 1) { *this = RunningStat(); return; }
+            double delta = x - mean;
+            mean -= delta / (count - 1);
+            m2 = std::max(0.0, m2 - delta * (x - mean));
+            count -= 1;
+        }
+        double variance() const { return count > 0 ? m2 / count : 0.0; }  // population
+    };
+    
     // Anomaly detection helpers
-    std::vector<double> extractFeatureVector(const EnvironmentalInput& input);
-    double calculateZScore(const std::vector<double>& feature, int feature_idx);
+    void extractFeatureVector(const EnvironmentalInput& input, AnomalyFeatureVector& features);
+    double calculateZScore(const AnomalyFeatureVector& feature, int feature_idx);
     
     // Historical data management
     void maintainHistorySize();
+    void addToHistoryStats(const EnvironmentalInput& input, bool add);
+    
+    // Per-feature statistics of the inputs in decision_history_, kept in
+    // step with it so z-scores are O(1)
+    std::array<RunningStat, ANOMALY_FEATURE_COUNT> history_stats_;
+    
+    // Streaming state: running input, its cached terms and which are stale
+    enum StreamTerm : unsigned {
+        WEATHER_TERM = 1u << 0,
+        RUNWAY_TERM = 1u << 1,
+        TERRAIN_TERM = 1u << 2,
+        NAVIGATION_TERM = 1u << 3,
+        ALL_TERMS = WEATHER_TERM | RUNWAY_TERM | TERRAIN_TERM | NAVIGATION_TERM
+    };
+    EnvironmentalInput stream_input_;
+    std::array<double, 4> stream_terms_ = {};   // weather, runway, terrain, navigation
+    unsigned stream_dirty_ = ALL_TERMS;
+    
+    // Welford statistics of the streamed samples behind norm_params_
+    struct StreamNormalization {
+        RunningStat pressure, wind_speed, visibility, elevation, complexity;
+    };
+    StreamNormalization stream_norm_;
+    void resetStreaming();
     
     // Thread-safe state
     mutable std::vector<DecisionHistoryEntry> decision_history_;
@@ -196,15 +336,8 @@ private:
     };
     PerformanceStats perf_stats_;
     
-    // Feature normalization parameters
-    struct NormalizationParams {
-        double pressure_mean, pressure_std;
-        double wind_speed_mean, wind_speed_std;
-        double visibility_mean, visibility_std;
-        double elevation_mean, elevation_std;
-        double complexity_mean, complexity_std;
-    };
     NormalizationParams norm_params_;
+    NormalizationParams default_norm_params_;
     
     // Anomaly detection parameters
     static constexpr double ANOMALY_THRESHOLD = 2.5;  // z-score threshold
@@ -19,9 +19,14 @@
 #define ML_DECISION_SYSTEM_H
 
 #include "aicopilot_types.h"
+#include "feature_index.hpp"
+#include "model_pack.hpp"
+#include <array>
+#include <cstddef>
 #include <vector>
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace AICopilot {
 
@@ -48,22 +53,71 @@ struct TrainingData {
     double reward;  // feedback signal
 };
 
+// Layout of MLDecisionSystem::extractFeatures()
+namespace DecisionFeatureLayout {
+    constexpr size_t PHASE = 0;
+    constexpr size_t PHASE_COUNT = 10;          // PREFLIGHT..SHUTDOWN, with neighbours
+    constexpr size_t STATE = PHASE + PHASE_COUNT;
+    constexpr size_t STATE_COUNT = 10;
+    constexpr size_t COUNT = STATE + STATE_COUNT;
+}
+
+static_assert(static_cast<size_t>(FlightPhase::UNKNOWN) == DecisionFeatureLayout::PHASE_COUNT,
+              "One phase feature per flight phase");
+
+using DecisionFeatureVector = std::array<double, DecisionFeatureLayout::COUNT>;
+
+// Hashed bag of words of one ATC text: the unit-length term counts over
+// BUCKETS hash buckets, of which at most MAX_TERMS are non-zero
+struct TextFeatureVector {
+    static constexpr size_t BUCKETS = 1024;
+    static constexpr size_t MAX_TERMS = 16;    // later distinct words are dropped
+
+    uint32_t count = 0;
+    std::array<uint16_t, MAX_TERMS> bucket{};  // ascending
+    std::array<float, MAX_TERMS> weight{};
+
+    // Cosine similarity, as both are unit length; 0 if either is empty
+    double dot(const TextFeatureVector& other) const;
+};
+
+// Words are runs of ASCII letters and digits, case-folded
+void hashTextFeatures(std::string_view text, TextFeatureVector& features);
+
 /**
  * Machine Learning Decision System
  * Improves decision making through pattern learning
+ *
+ * Training data is bounded: once the limit is reached, feedback is kept
+ * by reservoir sampling, so the retained set stays a uniform sample of
+ * everything trained. Similar contexts are found through a feature index
+ * updated with each retained example instead of a scan of all of them.
+ *
+ * A similar context votes for the current option whose text matches the
+ * one it chose, so a menu offering the same choices in another order
+ * still gets the vote. Text features of recently seen menu text are kept
+ * in a small cache keyed on the text hash; the cache makes even the
+ * const queries unsafe to call concurrently.
  */
 class MLDecisionSystem {
 public:
+    static constexpr size_t DEFAULT_TRAINING_LIMIT = 4096;
+    
     MLDecisionSystem() = default;
     
     // Initialize ML system
     bool initialize();
     
-    // Load trained model
+    // Load trained model from a model pack; on failure the current one is kept
     bool loadModel(const std::string& modelPath);
     
-    // Save trained model
+    // Load the training examples of an open pack, which one process can
+    // map once for all its instances
+    bool loadModel(const ModelPack& pack);
+    
+    // Save trained model as a model pack
     bool saveModel(const std::string& modelPath) const;
+    void saveModel(ModelPackBuilder& builder) const;
     
     // Make decision for ATC menu selection
     DecisionResult makeATCDecision(const DecisionContext& context);
@@ -100,41 +154,82 @@ public:
     // Get training data count
     size_t getTrainingDataCount() const { return trainingData_.size(); }
     
+    // Feedback received since the last clear, retained or not
+    uint64_t getFeedbackCount() const { return feedbackCount_; }
+    
+    // Most training examples retained; lowering it drops the excess
+    void setTrainingDataLimit(size_t limit);
+    size_t getTrainingDataLimit() const { return trainingLimit_; }
+    
     // Clear training data
     void clearTrainingData();
     
     // Feature extraction from context
     std::vector<double> extractFeatures(const DecisionContext& context) const;
     
+    // extractFeatures() into a caller's buffer, without allocating
+    void extractFeatures(const DecisionContext& context, DecisionFeatureVector& features) const;
+    
+    // hashTextFeatures() through the text cache; never allocates
+    void extractTextFeatures(std::string_view text, TextFeatureVector& features) const;
+    
+    static constexpr size_t TEXT_CACHE_SIZE = 64;
+    uint64_t getTextCacheHits() const { return textCacheHits_; }
+    uint64_t getTextCacheMisses() const { return textCacheMisses_; }
+    
 private:
     bool enabled_ = false;
     std::vector<TrainingData> trainingData_;
     
+    // Features of trainingData_, by position; examples loaded from a pack
+    // carry only their phase in context, so the features are kept too
+    std::vector<DecisionFeatureVector> trainingFeatures_;
+    // Text of the option each example chose; empty when not known
+    std::vector<TextFeatureVector> trainingChoices_;
+    FeatureIndex<DecisionFeatureLayout::COUNT> trainingIndex_{0.5, 256};
+    size_t trainingLimit_ = DEFAULT_TRAINING_LIMIT;
+    uint64_t feedbackCount_ = 0;
+    uint64_t reservoirState_ = 0x9E3779B97F4A7C15ull;
+    uint64_t nextReservoirDraw();
+    
+    // Direct-mapped on the FNV-1a 64 hash of the text
+    struct TextCacheEntry {
+        uint64_t hash = 0;
+        size_t length = 0;
+        bool valid = false;
+        TextFeatureVector features;
+    };
+    mutable std::array<TextCacheEntry, TEXT_CACHE_SIZE> textCache_{};
+    mutable uint64_t textCacheHits_ = 0;
+    mutable uint64_t textCacheMisses_ = 0;
+    
     // Simple neural network weights (stub for actual ML implementation)
     std::vector<std::vector<double>> weights_;
     
     // Learning rate
     double learningRate_ = 0.01;
     
-    // Feature engineering
-    std::vector<double> extractPhaseFeatures(FlightPhase phase) const;
-    std::vector<double> extractStateFeatures(const AircraftState& state) const;
-    std::vector<double> extractWeatherFeatures(const WeatherConditions& weather) const;
-    std::vector<double> extractTextFeatures(const std::string& text) const;
+    // Feature engineering; each writes its block of the feature layout
+    void extractPhaseFeatures(FlightPhase phase, double* features) const;
+    void extractStateFeatures(const AircraftState& state, double* features) const;
     
     // Simple scoring model (placeholder for actual ML)
     double scoreOption(
         const DecisionContext& context,
         int option) const;
     
-    // Pattern matching
-    std::vector<TrainingData> findSimilarContexts(
-        const DecisionContext& context) const;
+    // Votes of the training contexts similar to context, one slot per
+    // option; returns how many were similar
+    size_t voteSimilarContexts(const DecisionContext& context, std::vector<int>& votes) const;
     
     // Similarity calculation
     double calculateSimilarity(
         const DecisionContext& c1,
         const DecisionContext& c2) const;
+    static double calculateSimilarity(
+        const DecisionFeatureVector& features1, FlightPhase phase1,
+        const DecisionFeatureVector& features2, FlightPhase phase2);
+    static double similarityFromDistance(double distance, bool samePhase);
 };
 
 } // namespace AICopilot
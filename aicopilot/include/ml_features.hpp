@@ -11,6 +11,8 @@
 #ifndef ML_FEATURES_HPP
 #define ML_FEATURES_HPP
 
+#include <array>
+#include <cstddef>
 #include <vector>
 #include <string>
 #include <map>
@@ -95,6 +97,29 @@ struct NavigationFeatures {
                          waypoint_precision_index(0.9) {}
 };
 
+// Layout of CombinedFeatures::flatten(): one block per feature struct, each
+// in field order
+namespace FeatureLayout {
+    constexpr size_t WEATHER_COUNT = 10;
+    constexpr size_t RUNWAY_COUNT = 10;
+    constexpr size_t TERRAIN_COUNT = 9;
+    constexpr size_t NAVIGATION_COUNT = 9;
+    
+    constexpr size_t WEATHER = 0;
+    constexpr size_t RUNWAY = WEATHER + WEATHER_COUNT;
+    constexpr size_t TERRAIN = RUNWAY + RUNWAY_COUNT;
+    constexpr size_t NAVIGATION = TERRAIN + TERRAIN_COUNT;
+    constexpr size_t COUNT = NAVIGATION + NAVIGATION_COUNT;
+}
+
+// A field added to a feature struct must be added to its block
+static_assert(sizeof(WeatherFeatures) == FeatureLayout::WEATHER_COUNT * sizeof(double), "WeatherFeatures layout");
+static_assert(sizeof(RunwayFeatures) == FeatureLayout::RUNWAY_COUNT * sizeof(double), "RunwayFeatures layout");
+static_assert(sizeof(TerrainFeatures) == FeatureLayout::TERRAIN_COUNT * sizeof(double), "TerrainFeatures layout");
+static_assert(sizeof(NavigationFeatures) == FeatureLayout::NAVIGATION_COUNT * sizeof(double), "NavigationFeatures layout");
+
+using FeatureVector = std::array<double, FeatureLayout::COUNT>;
+
 // Combined feature set for ML models
 struct CombinedFeatures {
     WeatherFeatures weather;
@@ -105,6 +130,9 @@ struct CombinedFeatures {
     // Get flattened feature vector
     std::vector<double> flatten() const;
     
+    // flatten() into a caller's buffer, without allocating
+    void flattenInto(FeatureVector& out) const;
+    
     // Get feature names for interpretation
     static std::vector<std::string> getFeatureNames();
 };
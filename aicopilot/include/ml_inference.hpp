@@ -0,0 +1,98 @@
+/*****************************************************************************
+* ML Inference - pluggable inference backends for the ML models
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef ML_INFERENCE_HPP
+#define ML_INFERENCE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+namespace ML {
+
+// Batching and threading of backend inference
+struct InferenceConfig {
+    size_t max_batch_size = 32;     // rows per backend call
+    size_t worker_threads = 0;      // batches run in parallel on this many threads; 0 = caller's thread
+    size_t intra_op_threads = 1;    // threads inside one backend call (ONNX Runtime)
+};
+
+/**
+ * Inference backend for one model
+ *
+ * run() maps rows of inputSize() floats, the flattened CombinedFeatures,
+ * to rows of outputSize() floats: the prediction first, then optionally
+ * a confidence. It must be safe to call concurrently.
+ */
+class InferenceBackend {
+public:
+    virtual ~InferenceBackend() = default;
+
+    virtual std::string name() const = 0;
+    virtual size_t inputSize() const = 0;
+    virtual size_t outputSize() const = 0;
+    virtual bool run(const float* inputs, size_t rows, float* outputs) const = 0;
+};
+
+/**
+ * Multi-layer perceptron with int8 weights
+ *
+ * Weights are quantized symmetrically per output neuron; activations are
+ * quantized per row as they enter each layer, so every dot product runs
+ * in int32 and is rescaled once. Four times smaller than float weights
+ * and cache-resident for the layer sizes these models use.
+ */
+class QuantizedMLPBackend : public InferenceBackend {
+public:
+    enum Activation { LINEAR, RELU, SIGMOID };
+
+    struct Layer {
+        size_t inputs = 0;
+        size_t outputs = 0;
+        std::vector<int8_t> weights;    // outputs x inputs, row-major
+        std::vector<float> scales;      // per output
+        std::vector<float> bias;        // per output
+        Activation activation = LINEAR;
+    };
+
+    // Quantize float weights (outputs x inputs, row-major)
+    static Layer quantize(const std::vector<float>& weights, const std::vector<float>& bias,
+                          size_t inputs, size_t outputs, Activation activation);
+
+    // Layers must chain: each one's inputs equal the previous one's outputs
+    bool addLayer(Layer layer);
+    size_t getLayerCount() const { return layers_.size(); }
+
+    std::string name() const override { return "int8-mlp"; }
+    size_t inputSize() const override { return layers_.empty() ? 0 : layers_.front().inputs; }
+    size_t outputSize() const override { return layers_.empty() ? 0 : layers_.back().outputs; }
+    bool run(const float* inputs, size_t rows, float* outputs) const override;
+
+private:
+    std::vector<Layer> layers_;
+    size_t widest_ = 0;
+};
+
+/**
+ * ONNX model through ONNX Runtime, in builds with ENABLE_ONNXRUNTIME.
+ * The model takes one float tensor [rows, inputs] and returns one
+ * [rows, outputs]. Returns nullptr if the runtime is not compiled in or
+ * the model cannot be loaded.
+ */
+std::unique_ptr<InferenceBackend> createOnnxBackend(const std::string& model_path,
+                                                    const InferenceConfig& config);
+
+} // namespace ML
+} // namespace AICopilot
+
+#endif // ML_INFERENCE_HPP
@@ -11,13 +11,22 @@
 #ifndef ML_LEARNING_HPP
 #define ML_LEARNING_HPP
 
+#include "aicopilot_types.h"
 #include "ml_features.hpp"
+#include "feature_index.hpp"
+#include "model_pack.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <map>
 #include <cmath>
 
 namespace AICopilot {
+
+class FlightDataReader;
+
 namespace ML {
 
 // Learning outcome for feedback
@@ -61,6 +70,11 @@ struct HistoricalPattern {
  * ML Learning System - Online learning and continuous improvement
  * Learns from real flight outcomes to improve decision quality
  * Tracks anomalies and historical patterns
+ *
+ * Outcomes are kept in a ring of MAX_HISTORY_SIZE slots. The counters
+ * behind the accuracy metrics and trend, and the per-feature statistics
+ * behind anomaly detection, are updated as each outcome enters or leaves
+ * their window, so queries never rescan the history.
  */
 class MLLearningSystem {
 public:
@@ -102,11 +116,22 @@ public:
     AnomalyDetectionStats performAnomalyDetection(
         const std::vector<double>& feature_vector);
     
+    // Fold a flight data recording into the pattern database: each
+    // contiguous flight-phase segment counts as one occurrence of that
+    // phase's pattern, successful when it stayed inside the phase's bank and
+    // vertical-speed envelope. Scans only the columns it needs; returns the
+    // number of segments, or 0 when the recording cannot be read.
+    size_t buildPatternDatabase(const FlightDataReader& recording);
+    
+    // Whether one recorded row is inside its phase's stability envelope
+    static bool isStableSample(FlightPhase phase, double bank, double vertical_speed);
+    
     // Get historical patterns
     std::vector<HistoricalPattern> findHistoricalPatterns(
         const CombinedFeatures& features);
     
-    // Pattern matching from history
+    // Pattern matching from history: the num_similar most similar outcomes,
+    // most similar first, found through an index of the history's features
     std::vector<LearningOutcome> findSimilarHistoricalCases(
         const CombinedFeatures& features,
         int num_similar = 5);
@@ -129,11 +154,14 @@ public:
     // Clear learning history
     void clearHistory();
     
-    // Save learning state
+    // Save the learning counters and feature statistics as a model pack
     bool saveLearningState(const std::string& filepath);
+    void saveLearningState(ModelPackBuilder& builder) const;
     
-    // Load learning state
+    // Load them back; loaded feature statistics serve anomaly detection
+    // until the first new outcome restarts the window
     bool loadLearningState(const std::string& filepath);
+    bool loadLearningState(const ModelPack& pack);
     
     // Get learning efficiency
     double getLearningEfficiency() const;
@@ -154,19 +182,40 @@ public:
         const CombinedFeatures& features);
     
 private:
-    // Feature statistics for anomaly detection
+    // Feature statistics for anomaly detection, over the last
+    // RECENT_SAMPLE_SIZE outcomes (min/max over all of them)
     struct FeatureStats {
-        double mean;
-        double std_dev;
-        double min_val;
-        double max_val;
-        std::vector<double> recent_values;
+        double mean = 0.0;
+        double std_dev = 0.0;       // sample standard deviation
+        double min_val = 0.0;
+        double max_val = 0.0;
+        double m2 = 0.0;            // sum of squared deviations from mean
     };
     
-    std::map<std::string, FeatureStats> feature_statistics_;
+    std::array<FeatureStats, FeatureLayout::COUNT> feature_statistics_;
     
-    // Learning outcomes history
+    // Outcome history ring; grows to MAX_HISTORY_SIZE, then history_head_
+    // is both the oldest slot and the next one overwritten
     std::vector<LearningOutcome> learning_history_;
+    size_t history_head_ = 0;
+    const LearningOutcome& historyAt(size_t age) const;   // 0 = oldest
+    
+    // Flattened features of learning_history_, keyed by slot;
+    // calculateFeatureSimilarity() is 1 - L1 distance / COUNT, so the most
+    // similar cases are the L1-nearest
+    FeatureIndex<FeatureLayout::COUNT, ManhattanDistance> history_index_{1.5, 256};
+    
+    // Features of the last RECENT_SAMPLE_SIZE outcomes, a ring by outcome count
+    std::vector<FeatureVector> recent_features_;
+    size_t feature_samples_ = 0;
+    bool has_feature_stats_ = false;    // recorded or loaded
+    
+    // Windowed counters: correct outcomes among the last RECENT_SAMPLE_SIZE,
+    // and among the older half of the history, of old_half_size_ entries
+    int recent_correct_ = 0;
+    int history_correct_ = 0;
+    int old_half_correct_ = 0;
+    size_t old_half_size_ = 0;
     
     // Pattern database
     std::map<std::string, HistoricalPattern> patterns_;
@@ -178,23 +227,21 @@ private:
     AccuracyMetrics accuracy_metrics_;
     
     // Update feature statistics
-    void updateFeatureStatistics(const CombinedFeatures& features);
-    
-    // Build pattern database
-    void buildPatternDatabase();
+    void updateFeatureStatistics(const FeatureVector& feature_vector);
     
     // Calculate z-scores for features
     std::vector<double> calculateZScores(
         const std::vector<double>& feature_vector);
     
-    // Maintain history size
-    void maintainHistorySize();
+    // Append to the history ring, dropping the oldest outcome when full
+    void appendHistory(const LearningOutcome& outcome, const FeatureVector& features);
     
     // Configuration
     static constexpr double ANOMALY_THRESHOLD = 2.5;
     static constexpr int MAX_HISTORY_SIZE = 10000;
     static constexpr int RECENT_SAMPLE_SIZE = 100;
     static constexpr double LEARNING_RATE = 0.1;
+    static_assert(RECENT_SAMPLE_SIZE <= MAX_HISTORY_SIZE, "Recent window lies within the history");
 };
 
 } // namespace ML
@@ -12,12 +12,21 @@
 #define ML_MODELS_HPP
 
 #include "ml_features.hpp"
+#include "ml_inference.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <vector>
 #include <string>
 #include <memory>
 #include <map>
+#include <mutex>
+#include <thread>
 
 namespace AICopilot {
+
+class WorkStealingPool;
+
 namespace ML {
 
 // Model prediction result
@@ -69,6 +78,9 @@ public:
     // Get runway selection confidence
     double getRunwayConfidence(const CombinedFeatures& features);
     
+    // scoreRunway() prediction without the strings and vectors
+    static double score(const CombinedFeatures& features);
+    
     // Train model with runway selection data
     void train(const std::vector<TrainingSample>& samples);
     
@@ -88,9 +100,9 @@ private:
         const RunwayFeatures& runway,
         const WeatherFeatures& weather);
     
-    double scoreWindCondition(const WeatherFeatures& weather);
-    double scoreVisibilityCondition(const WeatherFeatures& weather);
-    double scoreRunwayCondition(const RunwayFeatures& runway);
+    static double scoreWindCondition(const WeatherFeatures& weather);
+    static double scoreVisibilityCondition(const WeatherFeatures& weather);
+    static double scoreRunwayCondition(const RunwayFeatures& runway);
 };
 
 /**
@@ -109,8 +121,11 @@ public:
         double altitude,
         double descent_rate);
     
+    // scoreApproachSafety() prediction without the strings
+    static double safetyScore(const CombinedFeatures& features, double descent_rate);
+    
     // Predict approach success probability
-    double predictApproachSuccessProbability(
+    static double predictApproachSuccessProbability(
         const CombinedFeatures& features,
         double distance_to_runway);
     
@@ -127,7 +142,7 @@ public:
         double distance_to_runway);
     
     // Detect go-around condition
-    bool shouldGoAround(
+    static bool shouldGoAround(
         const CombinedFeatures& features,
         double altitude_agl,
         double descent_rate);
@@ -141,8 +156,8 @@ private:
     std::vector<double> model_weights_;
     ModelMetrics metrics_;
     
-    double assessWeatherHazards(const WeatherFeatures& weather);
-    double assessTerrainHazards(const TerrainFeatures& terrain);
+    static double assessWeatherHazards(const WeatherFeatures& weather);
+    static double assessTerrainHazards(const TerrainFeatures& terrain);
 };
 
 /**
@@ -164,6 +179,9 @@ public:
         const CombinedFeatures& features,
         const std::vector<std::vector<double>>& route_options);
     
+    // scoreRoute() prediction without the strings
+    static double score(const CombinedFeatures& features);
+    
     // Get route efficiency score
     double getEfficiencyScore(const NavigationFeatures& nav_features);
     
@@ -182,11 +200,11 @@ private:
     std::vector<double> model_weights_;
     ModelMetrics metrics_;
     
-    double calculateEfficiencyFactor(
+    static double calculateEfficiencyFactor(
         const NavigationFeatures& nav_features);
-    double calculateSafetyFactor(
+    static double calculateSafetyFactor(
         const NavigationFeatures& nav_features);
-    double balanceEfficiencySafety(double efficiency, double safety);
+    static double balanceEfficiencySafety(double efficiency, double safety);
 };
 
 /**
@@ -229,6 +247,12 @@ public:
         const CombinedFeatures& features,
         const std::vector<double>& anomaly_indicators);
     
+    // assessEmergency() type and certainty without the procedures
+    static EmergencyType detectEmergencyType(
+        const std::vector<double>& anomaly_indicators);
+    static double calculateEmergencySeverity(
+        const std::vector<double>& anomaly_indicators);
+    
     // Get emergency procedure
     std::vector<std::string> getEmergencyProcedure(
         EmergencyType type,
@@ -252,25 +276,76 @@ public:
 private:
     std::vector<double> model_weights_;
     ModelMetrics metrics_;
-    
-    EmergencyType detectEmergencyType(
-        const std::vector<double>& anomaly_indicators);
-    double calculateEmergencySeverity(
-        const std::vector<double>& anomaly_indicators);
 };
 
 /**
  * Model Manager - Manages all ML models
  * Provides unified interface for all decision models
+ *
+ * The models live in an immutable-once-published ModelSet. Training,
+ * synchronous through validateModels() or queued for the background
+ * worker through submitTraining(), trains a copy of the current set and
+ * publishes it with an atomic pointer swap, so inference never waits on
+ * it. A candidate whose accuracy falls more than REGRESSION_TOLERANCE
+ * below the current model's is discarded, and rollbackModels() restores
+ * the set replaced by the last publish.
+ *
+ * References from the model getters stay valid until the set they came
+ * from is replaced twice; callers that score alongside background
+ * training should hold getModels() instead.
  */
 class ModelManager {
 public:
+    struct ModelSet {
+        RunwaySelectionModel runway;
+        ApproachPlanningModel approach;
+        RouteSelectionModel route;
+        EmergencyProcedureModel emergency;
+        uint64_t version = 0;         // 0 for the initial set, +1 per publish
+    };
+    
+    struct TrainingStats {
+        uint64_t submitted = 0;       // batches queued
+        uint64_t published = 0;       // candidates swapped in
+        uint64_t rejected = 0;        // candidates that regressed
+        uint64_t dropped = 0;         // queue was full
+        uint64_t rollbacks = 0;
+        size_t pending = 0;           // queued or training now
+    };
+    
+    static constexpr size_t MAX_PENDING_TRAINING = 4;
+    static constexpr double REGRESSION_TOLERANCE = 0.02;
+    
     ModelManager();
     ~ModelManager();
     
+    ModelManager(const ModelManager&) = delete;
+    ModelManager& operator=(const ModelManager&) = delete;
+    
     // Initialize all models
     bool initialize();
     
+    // The current models, kept alive for as long as the caller holds them
+    std::shared_ptr<const ModelSet> getModels() const;
+    uint64_t getModelVersion() const { return getModels()->version; }
+    
+    // Background training on a below-normal priority worker; submissions
+    // queue up before startTraining(), stopTraining() drops what is queued
+    void startTraining();
+    void stopTraining();
+    bool isTraining() const { return trainer_.joinable(); }
+    
+    // Queue a batch; false if MAX_PENDING_TRAINING batches are already waiting
+    bool submitTraining(std::vector<TrainingSample> samples);
+    
+    // Block until the queue is drained; returns at once if the worker is not running
+    void waitTrainingIdle();
+    
+    // Restore the models replaced by the last publish; false if there are none
+    bool rollbackModels();
+    
+    TrainingStats getTrainingStats() const;
+    
     // Get runway selection model
     RunwaySelectionModel& getRunwayModel();
     const RunwaySelectionModel& getRunwayModel() const;
@@ -302,14 +377,97 @@ public:
     };
     AllMetrics getAllMetrics() const;
     
-    // Validate all models with test set
+    // Every model's prediction for one set of features
+    struct AllScores {
+        double runway;                // RunwaySelectionModel::scoreRunway()
+        double approach_safety;       // ApproachPlanningModel::scoreApproachSafety()
+        double approach_success;      // ApproachPlanningModel::predictApproachSuccessProbability()
+        bool go_around;               // ApproachPlanningModel::shouldGoAround()
+        double route;                 // RouteSelectionModel::scoreRoute()
+        EmergencyProcedureModel::EmergencyType emergency_type;
+        double emergency_certainty;   // EmergencyProcedureModel::assessEmergency()
+    };
+    
+    /**
+     * Score all four models in one pass over the same features, with the
+     * same numbers as the per-model calls but none of their reasoning
+     * strings, probability vectors or procedure lists; for callers that
+     * score many candidates and only compare predictions.
+     */
+    AllScores scoreAll(
+        const CombinedFeatures& features,
+        double distance_to_runway,
+        double altitude_agl,
+        double descent_rate,
+        const std::vector<double>& anomaly_indicators = {}) const;
+    
+    // Train on test_set now, on the calling thread (the four models side by
+    // side on the inference pool when it has workers); false if the result
+    // regressed and was discarded
     bool validateModels(const std::vector<TrainingSample>& test_set);
     
+    // Models that can be served by an inference backend
+    enum BackendModel {
+        RUNWAY_BACKEND = 0,           // in place of RunwaySelectionModel::score()
+        ROUTE_BACKEND,                // in place of RouteSelectionModel::score()
+        BACKEND_MODEL_COUNT
+    };
+    
+    /**
+     * Serve a model through a backend such as QuantizedMLPBackend or
+     * createOnnxBackend(); nullptr restores the built-in scoring. The
+     * backend must take FeatureLayout::COUNT inputs. Swapped atomically,
+     * so it can be replaced while other threads predict.
+     */
+    bool setBackend(BackendModel model, std::shared_ptr<const InferenceBackend> backend);
+    std::string getBackendName(BackendModel model) const;
+    
+    // Batch size and threads for predictBatch() and training; rebuilds the worker pool
+    void setInferenceConfig(const InferenceConfig& config);
+    InferenceConfig getInferenceConfig() const;
+    
+    // Prediction and confidence from the model's backend, or the built-in
+    // score if it has none or it fails; no reasoning strings
+    ModelPrediction predict(BackendModel model, const CombinedFeatures& features) const;
+    
+    // predict() for many rows: the backend runs once per max_batch_size
+    // rows, batches spread over worker_threads
+    void predictBatch(BackendModel model,
+                      const std::vector<CombinedFeatures>& features,
+                      std::vector<ModelPrediction>& predictions) const;
+    
 private:
-    std::unique_ptr<RunwaySelectionModel> runway_model_;
-    std::unique_ptr<ApproachPlanningModel> approach_model_;
-    std::unique_ptr<RouteSelectionModel> route_model_;
-    std::unique_ptr<EmergencyProcedureModel> emergency_model_;
+    // Train a copy of the current set and publish it unless it regressed
+    bool trainAndPublish(const std::vector<TrainingSample>& samples);
+    static bool regressed(const ModelMetrics& current, const ModelMetrics& candidate);
+    void trainerLoop();
+    
+    static double builtinScore(BackendModel model, const CombinedFeatures& features);
+    static double builtinConfidence(BackendModel model);
+    // Predictions for rows [begin, end) of features
+    void predictRange(BackendModel model, const InferenceBackend* backend,
+                      const std::vector<CombinedFeatures>& features,
+                      size_t begin, size_t end,
+                      std::vector<ModelPrediction>& predictions) const;
+    
+    std::shared_ptr<ModelSet> models_;      // atomic_load / atomic_store
+    std::shared_ptr<ModelSet> previous_;    // guarded by publish_mutex_
+    std::mutex publish_mutex_;              // one trainer or rollback at a time
+    
+    std::thread trainer_;
+    mutable std::mutex queue_mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::deque<std::vector<TrainingSample>> queue_;
+    size_t in_progress_ = 0;                // guarded by queue_mutex_
+    bool stopping_ = false;
+    bool running_ = false;                  // worker started, guarded by queue_mutex_
+    TrainingStats training_stats_;          // guarded by queue_mutex_
+    
+    std::shared_ptr<const InferenceBackend> backends_[BACKEND_MODEL_COUNT];   // atomic_load / atomic_store
+    mutable std::mutex inference_mutex_;    // guards inference_config_ and inference_pool_
+    InferenceConfig inference_config_;
+    std::shared_ptr<WorkStealingPool> inference_pool_;   // null when worker_threads is 0
 };
 
 } // namespace ML
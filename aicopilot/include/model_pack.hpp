@@ -0,0 +1,176 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Model Pack - compiled, memory-mapped ML model and learning state
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef MODEL_PACK_HPP
+#define MODEL_PACK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+
+enum ModelPackSectionId : uint32_t {
+    MODEL_SECTION_DECISION_FEATURES = 0,    // double[exampleCount][decisionFeatureCount]
+    MODEL_SECTION_DECISION_EXAMPLES,        // ModelPackExample[exampleCount]
+    MODEL_SECTION_LEARNING,                 // ModelPackLearningState, or empty
+    MODEL_SECTION_FEATURE_STATS,            // ModelPackFeatureStats[learningFeatureCount], or empty
+    MODEL_SECTION_COUNT
+};
+
+/*
+ * On-disk layout (little-endian): the header, then the sections above,
+ * each 8-byte aligned, so the feature arrays are read in place from the
+ * mapping. The schema hash covers the compile-time feature layouts and
+ * feature names; a pack written by a build with a different layout is
+ * rejected rather than misread. The checksum covers every byte after the
+ * header.
+ */
+struct ModelPackSection {
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct ModelPackHeader {
+    char magic[4];                 // "AIMP"
+    uint16_t version;
+    uint16_t headerSize;           // sizeof(ModelPackHeader)
+    uint32_t decisionFeatureCount; // DecisionFeatureLayout::COUNT
+    uint32_t learningFeatureCount; // ML::FeatureLayout::COUNT
+    uint32_t exampleCount;
+    uint32_t reserved;
+    uint64_t schemaHash;           // ModelPack::schemaHash() of the writer
+    uint64_t fileSize;
+    uint64_t checksum;             // FNV-1a 64
+    ModelPackSection sections[MODEL_SECTION_COUNT];
+};
+
+// One MLDecisionSystem training example; its features are the matching row
+struct ModelPackExample {
+    int32_t phase;                 // FlightPhase
+    int32_t correctOption;
+    double reward;
+};
+
+// MLLearningSystem counters
+struct ModelPackLearningState {
+    int32_t totalSamples;
+    int32_t correctPredictions;
+    double overallAccuracy;
+};
+
+// Per-feature normalization of MLLearningSystem
+struct ModelPackFeatureStats {
+    double mean;
+    double stdDev;
+    double minValue;
+    double maxValue;
+};
+
+static_assert(sizeof(ModelPackHeader) == 112, "ModelPackHeader layout");
+static_assert(sizeof(ModelPackExample) == 16, "ModelPackExample layout");
+static_assert(sizeof(ModelPackLearningState) == 16, "ModelPackLearningState layout");
+static_assert(sizeof(ModelPackFeatureStats) == 32, "ModelPackFeatureStats layout");
+
+/**
+ * Writer for model packs
+ *
+ * Each owner fills the sections it persists: MLDecisionSystem its
+ * training examples, MLLearningSystem its counters and feature
+ * statistics. Feature rows must have decisionFeatureCount values.
+ */
+class ModelPackBuilder {
+public:
+    void addExample(const double* features, const ModelPackExample& example);
+    void setLearningState(const ModelPackLearningState& state);
+    void setFeatureStats(std::vector<ModelPackFeatureStats> stats);
+
+    size_t getExampleCount() const { return examples_.size(); }
+
+    // The complete pack image
+    std::vector<uint8_t> build() const;
+    bool write(const std::string& path) const;
+
+private:
+    std::vector<double> features_;
+    std::vector<ModelPackExample> examples_;
+    std::vector<ModelPackLearningState> learning_;     // zero or one
+    std::vector<ModelPackFeatureStats> featureStats_;
+};
+
+/**
+ * Read-only model pack backed by a file mapping or an in-memory image
+ *
+ * open() maps the file and validates the header, the schema hash against
+ * this build's feature layouts, the section sizes and by default the
+ * checksum. The mapping is read-only and shared by every process (and,
+ * through one shared_ptr, every pilot instance) that opens the file.
+ * Immutable once open; concurrent reads are safe.
+ */
+class ModelPack {
+public:
+    static constexpr char MAGIC[4] = {'A', 'I', 'M', 'P'};
+    static constexpr uint16_t VERSION = 1;
+
+    ModelPack() = default;
+    ~ModelPack();
+
+    ModelPack(const ModelPack&) = delete;
+    ModelPack& operator=(const ModelPack&) = delete;
+
+    // Hash of the feature layouts and names this build reads and writes
+    static uint64_t schemaHash();
+
+    // True if the file starts with the pack magic
+    static bool isPackFile(const std::string& path);
+
+    bool open(const std::string& path, bool verifyChecksum = true);
+    bool openImage(std::vector<uint8_t> image);
+    // Pack bytes owned elsewhere, such as a section of a mapped pilot
+    // checkpoint; they must stay valid (and 8-byte aligned) while open
+    bool openView(const uint8_t* data, size_t size);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+    bool isMapped() const { return isOpen() && image_.empty() && !borrowed_; }
+    size_t getSize() const { return size_; }
+
+    size_t getExampleCount() const { return isOpen() ? header().exampleCount : 0; }
+    const ModelPackExample& getExample(size_t i) const { return examples()[i]; }
+    // decisionFeatureCount values, in place in the mapping
+    const double* getExampleFeatures(size_t i) const;
+
+    bool hasLearningState() const;
+    const ModelPackLearningState& getLearningState() const;
+    size_t getFeatureStatsCount() const;
+    const ModelPackFeatureStats* getFeatureStats() const;
+
+private:
+    const ModelPackHeader& header() const { return *reinterpret_cast<const ModelPackHeader*>(data_); }
+    template <typename T>
+    const T* section(ModelPackSectionId id) const {
+        return reinterpret_cast<const T*>(data_ + header().sections[id].offset);
+    }
+    const ModelPackExample* examples() const { return section<ModelPackExample>(MODEL_SECTION_DECISION_EXAMPLES); }
+
+    bool validate(bool verifyChecksum) const;
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<uint8_t> image_;      // backing store for openImage()
+    bool borrowed_ = false;           // openView()
+    void* fileHandle_ = nullptr;      // Windows
+    void* mappingHandle_ = nullptr;   // Windows
+};
+
+} // namespace AICopilot
+
+#endif // MODEL_PACK_HPP
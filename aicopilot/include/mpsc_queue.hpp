@@ -0,0 +1,119 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* MPSC Queue - bounded lock-free hand-off from many producers to one consumer
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace AICopilot {
+
+/**
+ * Bounded multi-producer / single-consumer queue
+ *
+ * A ring of slots, each with its own sequence number. A producer claims
+ * the next slot with one compare-exchange on the tail, moves its value in
+ * and publishes it with a release store of the slot sequence; the consumer
+ * takes slots in order and hands each back to the producers the same way.
+ * Producers never wait for the consumer: when the ring is full push()
+ * returns false and the value is counted as dropped. All slots are
+ * allocated by the constructor.
+ *
+ * push() may be called from any thread, pop() from one thread at a time.
+ */
+template <typename T>
+class MpscQueue {
+public:
+    // capacity is rounded up to a power of two
+    explicit MpscQueue(size_t capacity)
+        : capacity_(roundUpPowerOfTwo(capacity)), mask_(capacity_ - 1), slots_(new Slot[capacity_]) {
+        for (size_t i = 0; i < capacity_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    size_t capacity() const { return capacity_; }
+
+    // Producer: false, and value left alone, when the queue is full
+    bool push(T&& value) {
+        size_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[position & mask_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool push(const T& value) {
+        T copy(value);
+        return push(std::move(copy));
+    }
+
+    // Consumer: move the oldest value into out; false when empty
+    bool pop(T& out) {
+        Slot& slot = slots_[head_ & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != head_ + 1) {
+            return false;
+        }
+        out = std::move(slot.value);
+        slot.value = T();
+        slot.sequence.store(head_ + capacity_, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+    // Pushes refused because the queue was full
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        T value{};
+    };
+
+    static size_t roundUpPowerOfTwo(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // Each index on its own cache line so the two sides do not false-share
+    alignas(64) std::atomic<size_t> tail_{0};   // next slot to claim, shared by producers
+    alignas(64) size_t head_ = 0;               // next slot to take, consumer-owned
+    alignas(64) std::atomic<uint64_t> dropped_{0};
+};
+
+} // namespace AICopilot
+
+#endif // MPSC_QUEUE_HPP
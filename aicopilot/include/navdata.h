@@ -20,6 +20,8 @@
 #ifndef NAVDATA_H
 #define NAVDATA_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <cmath>
@@ -99,7 +101,7 @@ enum class AltitudeRestrictionType {
  * Represents a named geographic location used in flight planning
  * Memory-optimized with lazy loading support for extended attributes
  */
-struct Waypoint {
+struct NavdataWaypoint {
     std::string name;               // Waypoint identifier (e.g., "KSEA", "BOUND")
     double latitude;                // Latitude in degrees (-90 to +90)
     double longitude;               // Longitude in degrees (-180 to +180)
@@ -112,14 +114,14 @@ struct Waypoint {
     WaypointPurpose purpose;        // Purpose of waypoint
     bool isUsable;                  // Whether waypoint is currently usable
     
-    Waypoint() 
+    NavdataWaypoint() 
         : name(""), latitude(0.0), longitude(0.0), elevation(0.0), 
           frequency(0.0), type(NavaidType::UNKNOWN), region(""),
           magneticVariation(0.0), range(0.0), purpose(WaypointPurpose::ENROUTE),
           isUsable(true) {}
     
-    Waypoint(const std::string& n, double lat, double lon, NavaidType t,
-             double elev = 0.0, double freq = 0.0, const std::string& reg = "")
+    NavdataWaypoint(const std::string& n, double lat, double lon, NavaidType t,
+                    double elev = 0.0, double freq = 0.0, const std::string& reg = "")
         : name(n), latitude(lat), longitude(lon), elevation(elev),
           frequency(freq), type(t), region(reg),
           magneticVariation(0.0), range(0.0), purpose(WaypointPurpose::ENROUTE),
@@ -266,7 +268,7 @@ struct STAR {
  * Instrument Approach Procedure structure
  * Defines approach from STAR to runway
  */
-struct ApproachProcedure {
+struct NavdataApproachProcedure {
     std::string airport;                    // Airport ICAO code
     std::string runway;                     // Runway identifier
     std::string name;                       // Approach name (e.g., "ILS 25L")
@@ -276,7 +278,7 @@ struct ApproachProcedure {
     double minimumVisibility;               // Minimum visibility (statute miles)
     bool hasGlideslope;                     // ILS has glideslope
     
-    ApproachProcedure()
+    NavdataApproachProcedure()
         : airport(""), runway(""), name(""), type(""),
           decisionAltitude(0.0), minimumVisibility(1.0), hasGlideslope(false) {}
 };
@@ -284,7 +286,7 @@ struct ApproachProcedure {
 /**
  * Flight plan validation result
  */
-struct ValidationResult {
+struct NavdataValidationResult {
     bool isValid;
     std::string errorMessage;
     std::vector<std::string> warnings;
@@ -293,7 +295,7 @@ struct ValidationResult {
     double maxAltitude;
     int estimatedTimeMinutes;
     
-    ValidationResult()
+    NavdataValidationResult()
         : isValid(true), errorMessage(""), waypointCount(0),
           totalDistance(0.0), maxAltitude(0.0), estimatedTimeMinutes(0) {}
 };
@@ -328,11 +330,17 @@ struct NavDatabaseStats {
     double averageAirwayDistance;
     long long lastUpdateTime;
     bool isReady;
+    uint64_t routeCacheHits;                // FindRoute answered from the cache
+    uint64_t routeCacheMisses;
+    size_t routeCacheEntries;
+    double routeCacheHitRate;               // hits / lookups, 0 before the first lookup
+    uint64_t routeCacheContentions;         // cache stripe locks that had to wait
     
     NavDatabaseStats()
         : waypointCount(0), airwayCount(0), sidCount(0), starCount(0),
           approachCount(0), averageAirwayDistance(0.0), lastUpdateTime(0),
-          isReady(false) {}
+          isReady(false), routeCacheHits(0), routeCacheMisses(0),
+          routeCacheEntries(0), routeCacheHitRate(0.0), routeCacheContentions(0) {}
 };
 
 } // namespace AICopilot
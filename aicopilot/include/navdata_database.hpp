@@ -23,8 +23,8 @@
 * - Memory footprint: ~5-10MB for full dataset
 *
 * THREAD SAFETY:
-* - All operations protected with std::mutex
-* - Safe for concurrent reads
+* - Queries read an immutable snapshot without locking
+* - New AIRAC cycles are loaded off to the side and swapped in atomically
 * - Writers are serialized
 *****************************************************************************/
 
@@ -32,14 +32,20 @@
 #define NAVDATA_DATABASE_HPP
 
 #include "navdata.h"
+#include "airway_landmarks.hpp"
+#include "magnetic_variation.hpp"
+#include "navdata_pack.hpp"
+#include "procedure_paths.hpp"
+#include "striped_cache.hpp"
+#include <cstdint>
 #include <vector>
 #include <map>
 #include <unordered_map>
 #include <memory>
 #include <mutex>
 #include <optional>
-#include <shared_mutex>
 #include <chrono>
+#include <future>
 #include <string>
 
 namespace AICopilot {
@@ -70,14 +76,21 @@ public:
      * @param name Waypoint identifier
      * @return Optional waypoint, empty if not found
      */
-    std::optional<Waypoint> GetWaypoint(const std::string& name) const;
+    std::optional<NavdataWaypoint> GetWaypoint(const std::string& name) const;
     
     /**
      * Find all waypoints of a specific type
      * @param type Navaid type to search
      * @return Vector of matching waypoints
      */
-    std::vector<Waypoint> GetWaypointsByType(NavaidType type) const;
+    std::vector<NavdataWaypoint> GetWaypointsByType(NavaidType type) const;
+    
+    /**
+     * Find all waypoints of a specific type without copying them
+     * @param type Navaid type to search
+     * @return Views into the current pack, which the list keeps alive
+     */
+    NavdataWaypointList FindWaypointsByType(NavaidType type) const;
     
     /**
      * Find waypoints within a radius of a location
@@ -86,9 +99,20 @@ public:
      * @param radiusNM Search radius in nautical miles
      * @return Vector of nearby waypoints
      */
-    std::vector<Waypoint> GetWaypointsNearby(double latitude, double longitude,
+    std::vector<NavdataWaypoint> GetWaypointsNearby(double latitude, double longitude,
                                              double radiusNM) const;
     
+    /**
+     * Find the waypoints closest to a location
+     * @param latitude Center latitude
+     * @param longitude Center longitude
+     * @param count Maximum number of waypoints to return
+     * @param maxRadiusNM Ignore waypoints farther than this
+     * @return Up to count waypoints, nearest first
+     */
+    std::vector<NavdataWaypoint> GetNearestWaypoints(double latitude, double longitude, size_t count,
+                                              double maxRadiusNM = WaypointIndex::MAX_RADIUS_NM) const;
+    
     /**
      * Get total waypoint count
      * @return Number of waypoints in database
@@ -111,7 +135,14 @@ public:
      * @param airwayName Airway identifier
      * @return Vector of waypoints on the airway
      */
-    std::vector<Waypoint> GetAirwayWaypoints(const std::string& airwayName) const;
+    std::vector<NavdataWaypoint> GetAirwayWaypoints(const std::string& airwayName) const;
+    
+    /**
+     * Get waypoints on a specific airway without copying them
+     * @param airwayName Airway identifier
+     * @return Views into the current pack, in airway order
+     */
+    NavdataWaypointList FindAirwayWaypoints(const std::string& airwayName) const;
     
     /**
      * Get all airways connecting two waypoints
@@ -194,7 +225,7 @@ public:
      * @param procedureType Type of approach (ILS, RNAV, VOR, etc.)
      * @return Optional approach procedure
      */
-    std::optional<ApproachProcedure> GetApproachProcedure(
+    std::optional<NavdataApproachProcedure> GetApproachProcedure(
         const std::string& airport,
         const std::string& runway,
         const std::string& procedureType = "") const;
@@ -205,7 +236,7 @@ public:
      * @param runway Runway identifier
      * @return Vector of available approach procedures
      */
-    std::vector<ApproachProcedure> GetApproachProceduresByRunway(
+    std::vector<NavdataApproachProcedure> GetApproachProceduresByRunway(
         const std::string& airport,
         const std::string& runway) const;
     
@@ -214,7 +245,7 @@ public:
      * @param airport Airport ICAO code
      * @return Vector of all approach procedures
      */
-    std::vector<ApproachProcedure> GetApproachProceduresByAirport(
+    std::vector<NavdataApproachProcedure> GetApproachProceduresByAirport(
         const std::string& airport) const;
     
     /**
@@ -287,7 +318,7 @@ public:
      * @param cruiseAltitude Cruise altitude in feet
      * @return Validation result with details
      */
-    ValidationResult ValidateFlightPlan(const std::vector<std::string>& waypointSequence,
+    NavdataValidationResult ValidateFlightPlan(const std::vector<std::string>& waypointSequence,
                                        int cruiseAltitude = 10000) const;
     
     /**
@@ -373,12 +404,69 @@ public:
      */
     long long GetLastUpdateTime() const;
     
+    /**
+     * Replace waypoints and airways with a compiled navdata snapshot; route
+     * landmarks stored next to it (AirwayLandmarks::pathFor) come along
+     * The new pack passes CheckPackConsistency() before it is swapped in;
+     * a pack that fails it is logged and the current data kept
+     * @param path Navdata pack file (see tools/navdata_compiler)
+     * @return true if the file was mapped and validated
+     */
+    bool LoadSnapshot(const std::string& path);
+    
+    /**
+     * Load a navdata pack on a background thread; queries keep using the
+     * current data until the new cycle is swapped in
+     * @param path Navdata pack file
+     * @return Future holding the LoadSnapshot() result; the load runs on
+     *         IoExecutor::shared(), so keep the database alive until it resolves
+     */
+    std::future<bool> LoadSnapshotAsync(const std::string& path);
+    
+    /**
+     * Write the current waypoints and airways as a navdata pack
+     * @param path Output file
+     * @return true on success
+     */
+    bool SaveSnapshot(const std::string& path) const;
+    
+    /**
+     * Get AIRAC cycle of the loaded snapshot
+     * @return Cycle as YYCC, 0 for the built-in data
+     */
+    uint32_t GetAiracCycle() const;
+    
+    /**
+     * Get the current navdata pack
+     * @return Pack of the current version; stays valid while held, across swaps
+     */
+    std::shared_ptr<const NavdataPack> GetNavdataPack() const { return Current()->pack; }
+    
+    /**
+     * Get the route landmarks loaded with the current snapshot
+     * @return Landmarks, or nullptr if the snapshot has none
+     */
+    std::shared_ptr<const AirwayLandmarks> GetRouteLandmarks() const { return Current()->landmarks; }
+    
+    /**
+     * Get the SID/STAR paths expanded against the current pack
+     * @return Paths for every runway and transition; stays valid while held
+     */
+    std::shared_ptr<const ProcedurePathTable> GetProcedurePaths() const { return Current()->procedurePaths; }
+    
     /**
      * Check consistency of database
      * @return Error message if inconsistency found, empty string if OK
      */
     std::string CheckDatabaseConsistency() const;
     
+    /**
+     * CheckDatabaseConsistency() for a pack that is not published yet
+     * @return Error message for the first waypoint with invalid coordinates
+     *         or airway fix without a waypoint, empty string if OK
+     */
+    static std::string CheckPackConsistency(const NavdataPack& pack);
+    
     /**
      * Preload frequently-used waypoints and airways for performance
      * @return Number of items preloaded
@@ -386,52 +474,71 @@ public:
     int PreloadCommonData();
 
 private:
-    // Data storage with multiple indices for performance
-    std::unordered_map<std::string, Waypoint> waypoints_;
-    std::unordered_map<std::string, Airway> airways_;
-    std::unordered_map<std::string, std::vector<SID>> sidsByAirport_;
-    std::unordered_map<std::string, std::vector<STAR>> starsByAirport_;
-    std::unordered_map<std::string, std::vector<ApproachProcedure>> approachesByAirport_;
-    
-    // Reverse index: waypoint to airways containing it
-    std::unordered_map<std::string, std::vector<std::string>> waypointToAirways_;
-    
-    // Spatial index for fast nearby queries
-    struct SpatialIndex {
-        double latitude;
-        double longitude;
-        std::string waypointName;
+    // One immutable version of the database. Waypoints, airways, the airway
+    // graph and the spatial index are a read-only navdata pack, compiled from
+    // the built-in data at construction or mapped from a snapshot file;
+    // internally everything refers to the pack's waypoint nodes and airway
+    // indices. Queries take the current version with Current() and never
+    // lock; LoadSnapshot() builds the next version and publishes it with
+    // std::atomic_store, and the old one is freed when its last reader is done.
+    struct Snapshot {
+        std::shared_ptr<const NavdataPack> pack;
+        std::shared_ptr<const AirwayLandmarks> landmarks;  // optional, for this pack
+        std::unordered_map<std::string, std::vector<SID>> sidsByAirport;
+        std::unordered_map<std::string, std::vector<STAR>> starsByAirport;
+        std::unordered_map<std::string, std::vector<NavdataApproachProcedure>> approachesByAirport;
+        std::shared_ptr<const ProcedurePathTable> procedurePaths;  // SIDs and STARs against pack
+        long long updateTime = 0;
+        uint64_t generation = 0;     // bumped by every swap
     };
-    std::vector<SpatialIndex> spatialIndex_;
-    
-    // Performance cache
-    struct CacheEntry {
-        std::vector<std::string> data;
-        long long timestamp;
+    static constexpr uint32_t NO_NODE = NavdataPack::NO_INDEX;
+    std::shared_ptr<const Snapshot> snapshot_;  // only through Current() and std::atomic_store
+    std::mutex publishMutex_;                   // serializes LoadSnapshot()
+    
+    std::shared_ptr<const Snapshot> Current() const { return std::atomic_load(&snapshot_); }
+    
+    // Route cache. Keys hash the query kind, the pack node IDs, the altitude
+    // and the snapshot generation, so a swap retires every entry at once;
+    // each entry repeats its key fields to reject hash collisions. Values
+    // share one immutable node path rather than copying names. Bounded by
+    // CLOCK eviction, and entries older than ROUTE_CACHE_TTL_MS are ignored.
+    enum class QueryKind : uint8_t {
+        ROUTE = 1
     };
-    mutable std::unordered_map<std::string, CacheEntry> queryCache_;
+    struct CachedRoute {
+        uint64_t generation = 0;
+        uint32_t origin = NO_NODE;
+        uint32_t destination = NO_NODE;
+        int cruiseAltitude = 0;
+        bool direct = false;         // no airway path; origin and destination only
+        long long timestamp = 0;
+        std::shared_ptr<const std::vector<uint32_t>> path;  // waypoint nodes
+    };
+    static constexpr size_t ROUTE_CACHE_CAPACITY = 1024;
+    static constexpr long long ROUTE_CACHE_TTL_MS = 3600000;  // 1 hour
+    mutable StripedCache<CachedRoute> routeCache_;
     
-    // Synchronization with reader-writer lock for better concurrency
-    mutable std::shared_mutex dbMutex_;
-    mutable std::mutex cacheMutex_;
     bool initialized_;
-    long long lastUpdateTime_;
+    
+    // WMM grid for the current date, built on the shared I/O executor at
+    // construction; lookups evaluate the model directly until it is ready
+    std::shared_future<std::shared_ptr<const MagneticVariationGrid>> magneticGrid_;
     
     // Helper methods
-    void InitializeData();
-    void BuildSpatialIndex();
-    void BuildReverseIndices();
+    void InitializeData(NavdataPackBuilder& builder, Snapshot& snapshot) const;
+    static std::shared_ptr<const ProcedurePathTable> BuildProcedurePaths(const Snapshot& snapshot);
     double GetMagneticVariation(double latitude, double longitude) const;
     double GreatCircleDistance(double lat1, double lon1, double lat2, double lon2) const;
     double GreatCircleBearing(double lat1, double lon1, double lat2, double lon2) const;
-    std::vector<Waypoint> DijkstraPathfinding(const std::string& origin,
-                                              const std::string& destination,
-                                              int cruiseAltitude) const;
+    // Shortest airway path between nodes, empty if there is none
+    std::vector<uint32_t> DijkstraPathfinding(const NavdataPack& pack, uint32_t originNode,
+                                              uint32_t destinationNode, int cruiseAltitude) const;
     
     // Cache management
+    static uint64_t RouteCacheKey(const CachedRoute& route);
     void InvalidateCache();
-    std::optional<std::vector<std::string>> GetFromCache(const std::string& key) const;
-    void StoreInCache(const std::string& key, const std::vector<std::string>& value) const;
+    bool GetCachedRoute(CachedRoute& route) const;  // key fields in, path out
+    void StoreCachedRoute(const CachedRoute& route) const;
 };
 
 } // namespace AICopilot
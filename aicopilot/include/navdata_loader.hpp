@@ -14,9 +14,14 @@
 #define NAVDATA_LOADER_HPP
 
 #include "aicopilot_types.h"
+#include "symbol_table.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <list>
 #include <string>
+#include <tuple>
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <memory>
 #include <mutex>
 
@@ -85,6 +90,15 @@ struct Procedure {
     std::vector<std::string> transitions;  // Available transitions
 };
 
+/**
+ * Navdata files for a parallel bulk load
+ */
+struct NavdataFileSet {
+    std::vector<std::string> navaidFiles;
+    std::vector<std::string> airwayFiles;      // resolved against all navaids above
+    std::vector<std::string> procedureFiles;
+};
+
 /**
  * Navigation Database Loader
  * Loads and manages navigation data from files
@@ -125,12 +139,46 @@ public:
     int loadAirways(const std::string& filePath);
     
     /**
-     * Load procedures from file
+     * Index procedures from file by airport
      * @param filePath Path to procedures.dat file
-     * @return Number of procedures loaded
+     * @return Number of procedures indexed
+     * 
+     * Only the airport of each row is read here; an airport's procedures
+     * are parsed on its first request or prefetchProcedures() call.
      */
     int loadProcedures(const std::string& filePath);
     
+    /**
+     * Load many navdata files at once
+     * @param files Navaid, airway and procedure files
+     * @return Total number of navaids, airways and procedures loaded
+     * 
+     * Every file is parsed on its own thread into a private staging buffer;
+     * the results are then merged and indexed in one pass under the lock.
+     * Files of one kind merge in list order, so a later navaid file
+     * overrides an earlier one as with successive loadNavaids() calls.
+     */
+    int loadFiles(const NavdataFileSet& files);
+    
+    /**
+     * Parse the procedures of airports a flight plan will need
+     * @param icaos Origin, destination and alternate ICAO codes
+     * @return Number of procedures resident for those airports
+     */
+    int prefetchProcedures(const std::vector<std::string>& icaos);
+    
+    /**
+     * Set memory budget for parsed procedures from files
+     * @param bytes Approximate budget; least recently used airports are evicted past it
+     */
+    void setProcedureMemoryBudget(size_t bytes);
+    
+    /**
+     * Get approximate memory used by parsed procedures from files
+     * @return Bytes resident
+     */
+    size_t getProcedureMemoryUsage() const;
+    
     /**
      * Get navaid by identifier
      * @param identifier Navaid identifier (e.g., "JFK", "OZZZI")
@@ -214,13 +262,65 @@ public:
     void clear();
 
 private:
-    std::map<std::string, NavaidInfo> navaids_;
+    // Keyed by identifiers interned in SymbolTable::navdata()
+    std::unordered_map<SymbolId, NavaidInfo> navaids_;
     std::vector<AirwaySegment> airways_;
-    std::vector<Procedure> procedures_;
+    std::unordered_map<SymbolId, std::vector<uint32_t>> airwaysFrom_;  // start navaid -> airways_ indices
     mutable std::mutex dbMutex_;
     
+    // Procedure files are indexed by airport and parsed one airport at a
+    // time on demand; parsed airports stay resident in LRU order within
+    // procedureBudget_. Procedures from addProcedure() are never evicted.
+    struct ProcedureSpan {
+        uint32_t file;              // index into procedureFiles_
+        uint64_t offset;            // byte range of consecutive rows
+        uint64_t length;
+    };
+    struct ResidentAirport {
+        std::vector<Procedure> procedures;
+        size_t bytes = 0;
+        std::list<std::string>::iterator lruPosition;
+    };
+    static constexpr size_t DEFAULT_PROCEDURE_BUDGET = 16 * 1024 * 1024;
+    std::vector<std::string> procedureFiles_;
+    std::unordered_map<std::string, std::vector<ProcedureSpan>> procedureIndex_;  // ICAO -> rows
+    std::unordered_map<std::string, ResidentAirport> residentProcedures_;
+    std::list<std::string> procedureLru_;  // most recently used first
+    std::unordered_map<std::string, std::vector<Procedure>> addedProcedures_;
+    size_t procedureBudget_ = DEFAULT_PROCEDURE_BUDGET;
+    size_t residentProcedureBytes_ = 0;
+    size_t indexedProcedureCount_ = 0;
+    size_t addedProcedureCount_ = 0;
+    
+    // Staging buffers; filled by the parsers without dbMutex_, merged with it held
+    struct AirwayRow {
+        std::string identifier;
+        std::string type;
+        std::string startIdent;
+        std::string endIdent;
+        int minimumAltitude;
+        int maximumAltitude;
+    };
+    struct ProcedureStage {
+        std::unordered_map<std::string, std::vector<ProcedureSpan>> spans;  // file field unset
+        int count = 0;
+    };
+    static bool parseNavaids(const std::string& filePath, std::vector<NavaidInfo>& out);
+    static bool parseAirways(const std::string& filePath, std::vector<AirwayRow>& out);
+    static bool indexProcedures(const std::string& filePath, ProcedureStage& out);
+    int mergeNavaids(std::vector<NavaidInfo>& staged);
+    int mergeAirways(const std::vector<AirwayRow>& staged);
+    int mergeProcedures(const std::string& filePath, ProcedureStage& staged);
+    
     // Helper methods
-    NavaidType parseNavaidType(const std::string& typeStr);
+    const std::vector<Procedure>& airportProcedures(const std::string& icao);  // dbMutex_ held
+    void collectProcedures(const std::string& icao, const std::string& type,
+                           const std::string& runway, std::vector<Procedure>& out);
+    void dropResidentAirport(const std::string& icao);
+    void evictProcedures(const std::string& keep);
+    static bool parseProcedure(const std::string& line, Procedure& proc);
+    static size_t procedureBytes(const Procedure& proc);
+    static NavaidType parseNavaidType(const std::string& typeStr);
     double calculateDistance(const Position& p1, const Position& p2) const;
     bool isWithinRadius(const Position& p1, const Position& p2, double radiusNM) const;
 };
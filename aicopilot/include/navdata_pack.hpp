@@ -0,0 +1,314 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Navdata Pack - compiled, memory-mapped AIRAC navigation data snapshot
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef NAVDATA_PACK_HPP
+#define NAVDATA_PACK_HPP
+
+#include "navdata.h"
+#include "waypoint_index.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace AICopilot {
+
+enum NavdataPackSectionId : uint32_t {
+    NAVDATA_SECTION_STRINGS = 0,        // identifier and description bytes
+    NAVDATA_SECTION_WAYPOINTS,          // NavdataPackWaypoint[waypointCount], by node
+    NAVDATA_SECTION_WAYPOINT_HASH,      // uint32 node[waypointBuckets], open addressing by name
+    NAVDATA_SECTION_AIRWAYS,            // NavdataPackAirway[airwayCount]
+    NAVDATA_SECTION_AIRWAY_HASH,        // uint32 airway[airwayBuckets]
+    NAVDATA_SECTION_AIRWAY_FIXES,       // NavdataPackFix[airwayFixCount], airway sequences back to back
+    NAVDATA_SECTION_EDGE_OFFSETS,       // uint32[waypointCount + 1], CSR row starts into EDGES
+    NAVDATA_SECTION_EDGES,              // NavdataPackEdge[edgeCount]
+    NAVDATA_SECTION_SPATIAL_BANDS,      // uint32[WaypointIndex::BAND_COUNT + 1]
+    NAVDATA_SECTION_SPATIAL_ENTRIES,    // WaypointIndex::Entry[waypointCount]
+    NAVDATA_SECTION_COUNT
+};
+
+/*
+ * On-disk layout (little-endian): the header, then the sections above,
+ * each 8-byte aligned. Every reference inside the file is an offset or an
+ * index, never a pointer, so the file can be mapped at any address and
+ * shared read-only between processes. The checksum covers every byte after
+ * the header.
+ */
+struct NavdataPackSection {
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct NavdataPackHeader {
+    char magic[4];                 // "ANPK"
+    uint16_t version;
+    uint16_t headerSize;           // sizeof(NavdataPackHeader)
+    uint32_t airacCycle;           // YYCC, e.g. 2510; 0 when unknown
+    uint32_t waypointCount;
+    uint32_t airwayCount;
+    uint32_t airwayFixCount;
+    uint32_t edgeCount;
+    uint32_t waypointBuckets;      // power of two
+    uint32_t airwayBuckets;        // power of two
+    uint32_t reserved;
+    uint64_t fileSize;
+    uint64_t checksum;             // FNV-1a 64
+    NavdataPackSection sections[NAVDATA_SECTION_COUNT];
+};
+
+struct NavdataPackString {
+    uint32_t offset;               // into the string section
+    uint32_t length;
+};
+
+/*
+ * Packed waypoint, 32 bytes: coordinates in 1e-7 degree steps (about 1 cm),
+ * frequency in thousandths of its unit (MHz for VOR, kHz for NDB), whole
+ * feet and nautical miles, variation in hundredths of a degree. Name and
+ * region point into the string section. Read through the accessors, which
+ * return the values NavdataWaypoint carries.
+ */
+struct NavdataPackWaypoint {
+    static constexpr uint8_t FLAG_USABLE = 0x80;
+    static constexpr uint8_t PURPOSE_MASK = 0x0F;
+
+    int32_t latitudeE7;
+    int32_t longitudeE7;
+    uint32_t nameOffset;           // into the string section
+    uint32_t regionOffset;
+    uint32_t frequencyMilli;
+    int16_t elevationFeet;
+    int16_t magneticVariationCenti;
+    uint16_t rangeNM;
+    uint8_t nameLength;
+    uint8_t regionLength;
+    uint8_t type;                  // NavaidType
+    uint8_t flags;                 // WaypointPurpose in the low bits, FLAG_USABLE
+    uint8_t reserved[2];
+
+    double latitude() const { return latitudeE7 / 1e7; }
+    double longitude() const { return longitudeE7 / 1e7; }
+    double elevation() const { return elevationFeet; }
+    double frequency() const { return frequencyMilli / 1000.0; }
+    double magneticVariation() const { return magneticVariationCenti / 100.0; }
+    double range() const { return rangeNM; }
+    NavaidType navaidType() const { return static_cast<NavaidType>(type); }
+    WaypointPurpose purpose() const { return static_cast<WaypointPurpose>(flags & PURPOSE_MASK); }
+    bool usable() const { return (flags & FLAG_USABLE) != 0; }
+    NavdataPackString nameRef() const { return {nameOffset, nameLength}; }
+    NavdataPackString regionRef() const { return {regionOffset, regionLength}; }
+};
+
+struct NavdataPackAirway {
+    NavdataPackString name;
+    NavdataPackString description;
+    int32_t minimumAltitude;
+    int32_t maximumAltitude;
+    uint32_t firstFix;             // into the fix section
+    uint32_t fixCount;
+    double totalDistanceNM;        // sum of the legs between known fixes
+    uint8_t level;                 // AirwayLevel
+    uint8_t active;
+    uint8_t reserved[6];
+};
+
+struct NavdataPackFix {
+    NavdataPackString name;
+    uint32_t waypoint;             // node, or NavdataPack::NO_INDEX if the fix is not in the pack
+    uint32_t reserved;
+    double legDistanceNM;          // from the previous fix; 0 for the first or an unknown fix
+};
+
+// Directed leg between consecutive fixes of an airway
+struct NavdataPackEdge {
+    uint32_t to;                   // node
+    uint32_t airway;
+    double distanceNM;
+};
+
+static_assert(sizeof(NavdataPackHeader) == 216, "NavdataPackHeader layout");
+static_assert(sizeof(NavdataPackWaypoint) == 32, "NavdataPackWaypoint layout");
+static_assert(sizeof(NavdataPackAirway) == 48, "NavdataPackAirway layout");
+static_assert(sizeof(NavdataPackFix) == 24, "NavdataPackFix layout");
+static_assert(sizeof(NavdataPackEdge) == 16, "NavdataPackEdge layout");
+static_assert(sizeof(WaypointIndex::Entry) == 32, "WaypointIndex::Entry layout");
+
+class MagneticVariationGrid;
+class NavdataPack;
+
+/**
+ * Zero-copy view of one waypoint in a pack
+ *
+ * Reads the packed record in place; materialize() builds the NavdataWaypoint
+ * API form. Valid while the pack stays open.
+ */
+class NavdataWaypointView {
+public:
+    NavdataWaypointView(const NavdataPack& pack, uint32_t node) : pack_(&pack), node_(node) {}
+
+    uint32_t node() const { return node_; }
+    const NavdataPackWaypoint& record() const;
+    std::string_view name() const;
+    std::string_view region() const;
+    double latitude() const { return record().latitude(); }
+    double longitude() const { return record().longitude(); }
+    NavaidType type() const { return record().navaidType(); }
+    NavdataWaypoint materialize() const;
+
+private:
+    const NavdataPack* pack_;
+    uint32_t node_;
+};
+
+/**
+ * Query result as nodes of one pack; holds the pack so the views stay
+ * valid after the database moves on to a newer cycle
+ */
+class NavdataWaypointList {
+public:
+    NavdataWaypointList() = default;
+    NavdataWaypointList(std::shared_ptr<const NavdataPack> pack, std::vector<uint32_t> nodes)
+        : pack_(std::move(pack)), nodes_(std::move(nodes)) {}
+
+    size_t size() const { return nodes_.size(); }
+    bool empty() const { return nodes_.empty(); }
+    NavdataWaypointView operator[](size_t i) const { return NavdataWaypointView(*pack_, nodes_[i]); }
+    const std::vector<uint32_t>& nodes() const { return nodes_; }
+
+    std::vector<NavdataWaypoint> materialize() const;
+
+private:
+    std::shared_ptr<const NavdataPack> pack_;
+    std::vector<uint32_t> nodes_;
+};
+
+/**
+ * Offline compiler for navdata packs
+ *
+ * Waypoints and airways are collected by name (a repeated name replaces
+ * the earlier entry), then build() lays out the string pool, the name hash
+ * tables, the airway graph and the spatial index, so opening the pack
+ * needs no parsing and no index building.
+ */
+class NavdataPackBuilder {
+public:
+    void setAiracCycle(uint32_t cycle) { airacCycle_ = cycle; }
+
+    void putWaypoint(const NavdataWaypoint& waypoint);
+    void putAirway(const Airway& airway);
+
+    // Fill in variation from the grid for waypoints that carry none (0); returns waypoints stamped
+    size_t stampMagneticVariation(const MagneticVariationGrid& grid);
+
+    size_t getWaypointCount() const { return waypoints_.size(); }
+    size_t getAirwayCount() const { return airways_.size(); }
+
+    // The complete pack image
+    std::vector<uint8_t> build() const;
+    bool write(const std::string& path) const;
+
+private:
+    uint32_t airacCycle_ = 0;
+    std::vector<NavdataWaypoint> waypoints_;
+    std::unordered_map<std::string, uint32_t> waypointIndex_;
+    std::vector<Airway> airways_;
+    std::unordered_map<std::string, uint32_t> airwayIndex_;
+};
+
+/**
+ * Read-only navdata pack backed by a file mapping or an in-memory image
+ *
+ * open() maps the file and validates the header and section bounds, and
+ * by default the checksum; waypoint and airway records are then read in
+ * place. Names resolve to dense node and airway indices through hash
+ * tables in the file, the airway graph is a CSR edge list over nodes and
+ * the spatial index is attached straight to its section, so nothing is
+ * rebuilt at load. Immutable once open; concurrent queries are safe.
+ */
+class NavdataPack {
+public:
+    static constexpr char MAGIC[4] = {'A', 'N', 'P', 'K'};
+    static constexpr uint16_t VERSION = 2;
+    static constexpr uint32_t NO_INDEX = 0xFFFFFFFFu;
+
+    NavdataPack() = default;
+    ~NavdataPack();
+
+    NavdataPack(const NavdataPack&) = delete;
+    NavdataPack& operator=(const NavdataPack&) = delete;
+
+    // True if the file starts with the pack magic
+    static bool isPackFile(const std::string& path);
+
+    // Checksum verification reads every page once; skip it only for trusted files
+    bool open(const std::string& path, bool verifyChecksum = true);
+    bool openImage(std::vector<uint8_t> image);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+
+    // Copy the pack bytes to a file
+    bool save(const std::string& path) const;
+
+    uint32_t getAiracCycle() const { return isOpen() ? header().airacCycle : 0; }
+    uint64_t getChecksum() const { return isOpen() ? header().checksum : 0; }
+    size_t getWaypointCount() const { return isOpen() ? header().waypointCount : 0; }
+    size_t getAirwayCount() const { return isOpen() ? header().airwayCount : 0; }
+    size_t getSize() const { return size_; }
+    bool isMapped() const { return isOpen() && image_.empty(); }
+
+    // Node for a waypoint name, NO_INDEX if absent
+    uint32_t findWaypoint(std::string_view name) const;
+    const NavdataPackWaypoint& getWaypointRecord(uint32_t node) const { return waypoints()[node]; }
+    std::string_view getWaypointName(uint32_t node) const { return getString(waypoints()[node].nameRef()); }
+    NavdataWaypoint getWaypoint(uint32_t node) const;
+
+    // Airway index for a name, NO_INDEX if absent
+    uint32_t findAirway(std::string_view name) const;
+    const NavdataPackAirway& getAirwayRecord(uint32_t airway) const { return airways()[airway]; }
+    const NavdataPackFix* getAirwayFixes(uint32_t airway) const;
+    Airway getAirway(uint32_t airway) const;
+
+    // Legs leaving a node
+    const NavdataPackEdge* edgesBegin(uint32_t node) const { return edges() + edgeOffsets()[node]; }
+    const NavdataPackEdge* edgesEnd(uint32_t node) const { return edges() + edgeOffsets()[node + 1]; }
+
+    const WaypointIndex& getSpatialIndex() const { return spatialIndex_; }
+
+    std::string_view getString(const NavdataPackString& ref) const;
+
+private:
+    const NavdataPackHeader& header() const { return *reinterpret_cast<const NavdataPackHeader*>(data_); }
+    template <typename T>
+    const T* section(NavdataPackSectionId id) const {
+        return reinterpret_cast<const T*>(data_ + header().sections[id].offset);
+    }
+    const NavdataPackWaypoint* waypoints() const { return section<NavdataPackWaypoint>(NAVDATA_SECTION_WAYPOINTS); }
+    const NavdataPackAirway* airways() const { return section<NavdataPackAirway>(NAVDATA_SECTION_AIRWAYS); }
+    const uint32_t* edgeOffsets() const { return section<uint32_t>(NAVDATA_SECTION_EDGE_OFFSETS); }
+    const NavdataPackEdge* edges() const { return section<NavdataPackEdge>(NAVDATA_SECTION_EDGES); }
+
+    bool validate(bool verifyChecksum) const;
+    void attachIndex();
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<uint8_t> image_;      // backing store for openImage()
+    void* fileHandle_ = nullptr;      // Windows
+    void* mappingHandle_ = nullptr;   // Windows
+    WaypointIndex spatialIndex_;
+};
+
+} // namespace AICopilot
+
+#endif // NAVDATA_PACK_HPP
@@ -20,6 +20,10 @@
 
 #include "aicopilot_types.h"
 #include "airport_data.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
 #include <string>
 #include <vector>
 #include <memory>
@@ -61,7 +65,9 @@ struct NavaidInfo {
 
 /**
  * Abstract interface for navigation data providers
- * Can be implemented by SimConnect, database, or external API providers
+ * Can be implemented by SimConnect, database, or external API providers.
+ * Queries are const: once initialize() has returned, one provider can be
+ * shared read-only by many pilots (see PilotHost).
  */
 class INavdataProvider {
 public:
@@ -89,8 +95,19 @@ public:
      * @param info Output airport information
      * @return true if airport found
      */
-    virtual bool getAirportByICAO(const std::string& icao, AirportInfo& info) = 0;
-    virtual bool getAirportLayout(const std::string& icao, AirportLayout& layout) = 0;
+    virtual bool getAirportByICAO(const std::string& icao, AirportInfo& info) const = 0;
+    virtual bool getAirportLayout(const std::string& icao, AirportLayout& layout) const = 0;
+    
+    /**
+     * Get the immutable layout of an airport, shared between callers
+     * @param icao ICAO airport code
+     * @return Layout built from getAirportLayout(), or null if not found
+     * 
+     * The default builds a new layout per call. The providers below build
+     * each airport once and hand every caller the same layout while any
+     * caller still holds it.
+     */
+    virtual std::shared_ptr<const Airport::AirportLayoutData> getSharedAirportLayout(const std::string& icao) const;
     
     /**
      * Get airports within a radius
@@ -98,7 +115,7 @@ public:
      * @param radiusNM Search radius in nautical miles
      * @return Vector of airports within radius
      */
-    virtual std::vector<AirportInfo> getAirportsNearby(const Position& center, double radiusNM) = 0;
+    virtual std::vector<AirportInfo> getAirportsNearby(const Position& center, double radiusNM) const = 0;
     
     /**
      * Get navaid information by identifier
@@ -106,7 +123,7 @@ public:
      * @param info Output navaid information
      * @return true if navaid found
      */
-    virtual bool getNavaidByID(const std::string& id, NavaidInfo& info) = 0;
+    virtual bool getNavaidByID(const std::string& id, NavaidInfo& info) const = 0;
     
     /**
      * Get navaids within a radius
@@ -117,7 +134,7 @@ public:
      */
     virtual std::vector<NavaidInfo> getNavaidsNearby(const Position& center, 
                                                       double radiusNM, 
-                                                      const std::string& type = "") = 0;
+                                                      const std::string& type = "") const = 0;
     
     /**
      * Find nearest airport to a position
@@ -125,7 +142,30 @@ public:
      * @param info Output airport information
      * @return true if airport found
      */
-    virtual bool getNearestAirport(const Position& position, AirportInfo& info) = 0;
+    virtual bool getNearestAirport(const Position& position, AirportInfo& info) const = 0;
+    
+    /**
+     * Get airport information for several ICAO codes in one request
+     * @param icaos ICAO airport codes
+     * @param infos Output, one entry per code in request order; codes not
+     *              found leave a default entry with an empty icao
+     * @return Number of airports found
+     * 
+     * The default calls getAirportByICAO() per code. Providers with a
+     * round trip per lookup override it to resolve the batch together.
+     */
+    virtual size_t getAirportsByICAO(const std::vector<std::string>& icaos,
+                                     std::vector<AirportInfo>& infos) const;
+    
+    /**
+     * Get navaid information for several identifiers in one request
+     * @param ids Navaid identifiers
+     * @param infos Output, one entry per identifier in request order;
+     *              identifiers not found leave a default entry with an empty id
+     * @return Number of navaids found
+     */
+    virtual size_t getNavaidsByID(const std::vector<std::string>& ids,
+                                  std::vector<NavaidInfo>& infos) const;
 };
 
 /**
@@ -141,14 +181,47 @@ public:
     void shutdown() override;
     bool isReady() const override;
     
-    bool getAirportByICAO(const std::string& icao, AirportInfo& info) override;
-    bool getAirportLayout(const std::string& icao, AirportLayout& layout) override;
-    std::vector<AirportInfo> getAirportsNearby(const Position& center, double radiusNM) override;
-    bool getNavaidByID(const std::string& id, NavaidInfo& info) override;
+    bool getAirportByICAO(const std::string& icao, AirportInfo& info) const override;
+    bool getAirportLayout(const std::string& icao, AirportLayout& layout) const override;
+    std::shared_ptr<const Airport::AirportLayoutData> getSharedAirportLayout(const std::string& icao) const override;
+    std::vector<AirportInfo> getAirportsNearby(const Position& center, double radiusNM) const override;
+    bool getNavaidByID(const std::string& id, NavaidInfo& info) const override;
     std::vector<NavaidInfo> getNavaidsNearby(const Position& center, 
                                              double radiusNM, 
-                                             const std::string& type = "") override;
-    bool getNearestAirport(const Position& position, AirportInfo& info) override;
+                                             const std::string& type = "") const override;
+    bool getNearestAirport(const Position& position, AirportInfo& info) const override;
+    size_t getAirportsByICAO(const std::vector<std::string>& icaos,
+                             std::vector<AirportInfo>& infos) const override;
+    size_t getNavaidsByID(const std::vector<std::string>& ids,
+                          std::vector<NavaidInfo>& infos) const override;
+    
+    /**
+     * Non-blocking airport lookup
+     * @param icao ICAO airport code
+     * @return Future for the airport; an empty icao means not found
+     * 
+     * Requests are serviced on the provider's lookup thread, so the caller
+     * never waits on facility data. Concurrent requests for the same code
+     * share one in-flight lookup and the same future.
+     */
+    std::shared_future<AirportInfo> getAirportByICAOAsync(const std::string& icao) const;
+    
+    /**
+     * Non-blocking airport lookup with a completion callback
+     * @param icao ICAO airport code
+     * @param onComplete Invoked on the lookup thread; an empty icao means not found
+     */
+    void getAirportByICAOAsync(const std::string& icao,
+                               std::function<void(const AirportInfo&)> onComplete) const;
+    
+    /**
+     * Non-blocking navaid lookup
+     * @param id Navaid identifier
+     * @return Future for the navaid; an empty id means not found
+     */
+    std::shared_future<NavaidInfo> getNavaidByIDAsync(const std::string& id) const;
+    void getNavaidByIDAsync(const std::string& id,
+                            std::function<void(const NavaidInfo&)> onComplete) const;
     
     /**
      * Set SimConnect handle to use for requests
@@ -175,14 +248,19 @@ public:
     void shutdown() override;
     bool isReady() const override;
     
-    bool getAirportByICAO(const std::string& icao, AirportInfo& info) override;
-    bool getAirportLayout(const std::string& icao, AirportLayout& layout) override;
-    std::vector<AirportInfo> getAirportsNearby(const Position& center, double radiusNM) override;
-    bool getNavaidByID(const std::string& id, NavaidInfo& info) override;
+    bool getAirportByICAO(const std::string& icao, AirportInfo& info) const override;
+    bool getAirportLayout(const std::string& icao, AirportLayout& layout) const override;
+    std::shared_ptr<const Airport::AirportLayoutData> getSharedAirportLayout(const std::string& icao) const override;
+    std::vector<AirportInfo> getAirportsNearby(const Position& center, double radiusNM) const override;
+    bool getNavaidByID(const std::string& id, NavaidInfo& info) const override;
     std::vector<NavaidInfo> getNavaidsNearby(const Position& center, 
                                              double radiusNM, 
-                                             const std::string& type = "") override;
-    bool getNearestAirport(const Position& position, AirportInfo& info) override;
+                                             const std::string& type = "") const override;
+    bool getNearestAirport(const Position& position, AirportInfo& info) const override;
+    size_t getAirportsByICAO(const std::vector<std::string>& icaos,
+                             std::vector<AirportInfo>& infos) const override;
+    size_t getNavaidsByID(const std::vector<std::string>& ids,
+                          std::vector<NavaidInfo>& infos) const override;
     
     /**
      * Add airport to cache
@@ -194,6 +272,18 @@ public:
      */
     void addNavaid(const NavaidInfo& info);
     
+    /**
+     * Add many airports to cache, e.g. from a batch lookup on another provider
+     * @param infos Airports; entries with an empty icao are skipped
+     */
+    void addAirports(const std::vector<AirportInfo>& infos);
+    
+    /**
+     * Add many navaids to cache
+     * @param infos Navaids; entries with an empty id are skipped
+     */
+    void addNavaids(const std::vector<NavaidInfo>& infos);
+    
     /**
      * Load common airports from a file
      * @param filePath Path to airport data file
@@ -201,6 +291,26 @@ public:
      */
     bool loadAirportsFromFile(const std::string& filePath);
     
+    /**
+     * Back the cache with an append-only file for one AIRAC cycle
+     * @param filePath Cache file; created if missing
+     * @param airacCycle Cycle the cached data belongs to (YYCC, e.g. 2510)
+     * @return true if the file is usable
+     * 
+     * Entries already in the file are loaded immediately; a file written
+     * for another cycle is discarded. Airports and navaids added afterwards
+     * (including loadAirportsFromFile()) are buffered and appended by
+     * flushPersistentCache(), once the buffer fills, or by shutdown(),
+     * which also detaches the file.
+     */
+    bool enablePersistentCache(const std::string& filePath, uint32_t airacCycle);
+    
+    /**
+     * Append buffered entries to the persistent cache file
+     * @return true if nothing was pending or the write succeeded
+     */
+    bool flushPersistentCache();
+    
 private:
     class Impl;
     std::unique_ptr<Impl> pImpl;
@@ -11,10 +11,15 @@
 #define NAVIGATION_H
 
 #include "aicopilot_types.h"
+#include "flight_plan_cache.hpp"
+#include "leg_table.hpp"
+#include <memory>
 #include <vector>
 
 namespace AICopilot {
 
+class INavdataProvider;
+
 /**
  * Navigation and flight planning
  */
@@ -22,9 +27,18 @@ class Navigation {
 public:
     Navigation() = default;
     
-    // Load flight plan from file
+    // Load flight plan from file (.pln or .fms), parsed once per distinct
+    // file content through the plan cache
     bool loadFlightPlan(const std::string& filePath);
     
+    // Cache shared with other pilots; FlightPlanCache::shared() by default
+    void setFlightPlanCache(std::shared_ptr<FlightPlanCache> cache) { planCache_ = std::move(cache); }
+    
+    // Place waypoints still at 0,0 from navdata: airports in one
+    // getAirportsByICAO() request, everything else in one getNavaidsByID().
+    // Returns the number of waypoints placed
+    size_t resolveWaypoints(const INavdataProvider& navdata);
+    
     // Create simple direct flight plan
     FlightPlan createDirectPlan(const std::string& departure, 
                                const std::string& arrival,
@@ -33,8 +47,13 @@ public:
     // Get current flight plan
     FlightPlan getFlightPlan() const { return flightPlan_; }
     
+    // Replace the plan and resume at a waypoint, e.g. from a checkpoint;
+    // an index past the end means the route is complete
+    void restoreFlightPlan(const FlightPlan& plan, size_t activeWaypointIndex);
+    
     // Get active waypoint
     Waypoint getActiveWaypoint() const;
+    size_t getActiveWaypointIndex() const { return activeWaypointIndex_; }
     
     // Get next waypoint
     Waypoint getNextWaypoint() const;
@@ -80,17 +99,18 @@ public:
     // Calculate total route distance (nautical miles)
     double getTotalDistance() const;
     
+    // Leg geometry of the current flight plan, kept in step with its edits
+    const LegTable& getLegTable() const { return legs_; }
+    
 private:
     FlightPlan flightPlan_;
     size_t activeWaypointIndex_ = 0;
+    LegTable legs_;
+    std::shared_ptr<FlightPlanCache> planCache_ = FlightPlanCache::shared();
     
     // Great circle calculations
     double greatCircleDistance(const Position& p1, const Position& p2) const;
     double greatCircleBearing(const Position& p1, const Position& p2) const;
-    
-    // Flight plan parsers
-    bool parsePLN(std::ifstream& file);
-    bool parseFMS(std::ifstream& file);
 };
 
 } // namespace AICopilot
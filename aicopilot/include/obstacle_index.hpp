@@ -0,0 +1,99 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Obstacle Index - packed grid index over the obstacle database
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef OBSTACLE_INDEX_HPP
+#define OBSTACLE_INDEX_HPP
+
+#include "aicopilot_types.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+
+// Obstacle types
+enum class ObstacleType {
+    TOWER,
+    BUILDING,
+    MOUNTAIN,
+    ANTENNA,
+    BRIDGE,
+    POWER_LINE,
+    OTHER
+};
+
+// Obstacle structure
+struct Obstacle {
+    ObstacleType type;
+    Position position;
+    double height;  // feet AGL
+    double elevation;  // feet MSL
+    std::string description;
+};
+
+/**
+ * Uniform-grid spatial index for point obstacles
+ *
+ * Obstacles are sorted by grid cell (CELL_SIZE_DEG, about 6 NM) and the
+ * non-empty cells are kept in a sorted offset table, CSR style. Cell keys
+ * run west to east within a latitude row, so the part of a corridor that
+ * crosses one row is a single contiguous slice of the obstacle array.
+ * A query touches only the rows its corridor spans and tests just the
+ * obstacles in those slices, independent of the database size.
+ *
+ * Immutable after build(); concurrent queries are safe.
+ */
+class ObstacleIndex {
+public:
+    static constexpr double CELL_SIZE_DEG = 0.1;
+    static constexpr int GRID_COLUMNS = 3600;  // 360 / CELL_SIZE_DEG
+
+    // Replace the indexed obstacles
+    void build(std::vector<Obstacle> obstacles);
+    void clear();
+
+    size_t size() const { return obstacles_.size(); }
+    bool empty() const { return obstacles_.empty(); }
+
+    // Indexed obstacles in cell order
+    const std::vector<Obstacle>& getObstacles() const { return obstacles_; }
+
+    // Obstacles within halfWidthNM of the segment start -> end (appended to out)
+    void queryCorridor(const Position& start, const Position& end, double halfWidthNM,
+                       std::vector<const Obstacle*>& out) const;
+
+    // Obstacles within radiusNM of center (appended to out)
+    void queryRadius(const Position& center, double radiusNM,
+                     std::vector<const Obstacle*>& out) const;
+
+private:
+    struct Cell {
+        uint32_t key;
+        uint32_t begin;  // first obstacle; the next cell's begin ends the range
+    };
+
+    static int rowFor(double latitude);
+    static int columnFor(double longitude);
+    static uint32_t cellKey(int row, int column) {
+        return static_cast<uint32_t>(row) * GRID_COLUMNS + static_cast<uint32_t>(column);
+    }
+
+    // Visit obstacles in cells [column0, column1] of a row
+    template <typename Fn>
+    void forEachInRow(int row, int column0, int column1, Fn&& fn) const;
+
+    std::vector<Obstacle> obstacles_;
+    std::vector<Cell> cells_;  // sorted by key, plus a sentinel with begin == size()
+};
+
+} // namespace AICopilot
+
+#endif // OBSTACLE_INDEX_HPP
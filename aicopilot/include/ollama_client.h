@@ -10,12 +10,73 @@
 #ifndef OLLAMA_CLIENT_H
 #define OLLAMA_CLIENT_H
 
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
-#include <memory>
 
 namespace AICopilot {
 
+/**
+ * Result of an asynchronous ATC menu selection
+ *
+ * Shared between the client, which resolves it once, and the caller, which
+ * polls or waits on it. Whichever of completion, failure, the deadline or
+ * cancel() happens first wins; later outcomes are ignored.
+ */
+class OllamaSelection {
+public:
+    enum class Status { PENDING, COMPLETED, FAILED, TIMED_OUT, CANCELLED };
+    
+    explicit OllamaSelection(std::chrono::steady_clock::time_point deadline)
+        : deadline_(deadline) {}
+    
+    Status getStatus() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return status_;
+    }
+    bool isDone() const { return getStatus() != Status::PENDING; }
+    
+    // Selected option index, or -1 unless COMPLETED
+    int getOption() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return status_ == Status::COMPLETED ? option_ : -1;
+    }
+    
+    std::chrono::steady_clock::time_point getDeadline() const { return deadline_; }
+    bool isPastDeadline() const { return std::chrono::steady_clock::now() >= deadline_; }
+    
+    // Block until resolved or timeout elapses; true if resolved
+    bool wait(std::chrono::milliseconds timeout) const {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return resolved_.wait_for(lock, timeout, [this] { return status_ != Status::PENDING; });
+    }
+    
+    // Abandon the request; the client drops its transfer
+    void cancel() { resolve(Status::CANCELLED); }
+    
+    // Resolve once; returns false if already resolved
+    bool resolve(Status status, int option = -1) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (status_ != Status::PENDING) return false;
+            status_ = status;
+            option_ = option;
+        }
+        resolved_.notify_all();
+        return true;
+    }
+    
+private:
+    const std::chrono::steady_clock::time_point deadline_;
+    mutable std::mutex mutex_;
+    mutable std::condition_variable resolved_;
+    Status status_ = Status::PENDING;
+    int option_ = -1;
+};
+
 /**
  * Ollama LLM client for AI-powered ATC menu selection
  * Provides intelligent decision making using local Ollama models
@@ -40,6 +101,9 @@ public:
     // Get current model
     std::string getModel() const { return model_; }
     
+    // Deadline of the blocking selectATCMenuOption()
+    static constexpr std::chrono::milliseconds DEFAULT_TIMEOUT{30000};
+    
     /**
      * Select best ATC menu option using LLM reasoning
      * @param atcMessage The ATC message text
@@ -55,6 +119,20 @@ public:
         const std::string& context = ""
     );
     
+    /**
+     * Start a menu selection without blocking. Requests run concurrently
+     * over a pool of keep-alive connections; each one is abandoned (and
+     * resolved TIMED_OUT) once timeout elapses.
+     * @return Selection to poll or wait on; never null
+     */
+    std::shared_ptr<OllamaSelection> selectATCMenuOptionAsync(
+        const std::string& atcMessage,
+        const std::vector<std::string>& menuOptions,
+        const std::string& flightPhase,
+        const std::string& context,
+        std::chrono::milliseconds timeout
+    );
+    
     /**
      * Generate a prompt for Ollama
      * @param atcMessage The ATC message
@@ -0,0 +1,151 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Ollama Gateway - one shared, prioritized LLM queue for every hosted pilot
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef OLLAMA_GATEWAY_HPP
+#define OLLAMA_GATEWAY_HPP
+
+#include "ollama_client.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace AICopilot {
+
+enum class LLMPriority {
+    ROUTINE,
+    EMERGENCY     // dispatched ahead of everything else and never rate limited
+};
+
+struct OllamaGatewayConfig {
+    // Requests outstanding at the server at once; match the server's
+    // OLLAMA_NUM_PARALLEL so it batches them into one forward pass
+    size_t maxInFlight = 4;
+    double pilotRequestsPerSecond = 0.5;   // per-pilot token bucket refill; 0 = unlimited
+    double pilotBurst = 3.0;               // per-pilot bucket size
+};
+
+struct OllamaGatewayStats {
+    size_t queueDepth = 0;
+    size_t maxQueueDepth = 0;
+    size_t inFlight = 0;
+    uint64_t submitted = 0;
+    uint64_t dispatched = 0;
+    uint64_t completed = 0;
+    uint64_t failed = 0;          // failed, timed out or cancelled after dispatch
+    uint64_t rateLimited = 0;     // rejected at submit
+    uint64_t expired = 0;         // deadline passed while queued
+};
+
+// One menu selection as handed to the backend
+struct OllamaGatewayRequest {
+    uint32_t pilotId = 0;
+    LLMPriority priority = LLMPriority::ROUTINE;
+    std::string atcMessage;
+    std::vector<std::string> menuOptions;
+    std::string flightPhase;
+    std::string context;
+    std::chrono::steady_clock::time_point deadline;
+};
+
+/**
+ * Process-wide front end to one Ollama server for all pilots of a host
+ *
+ * Pilots submit() menu selections and get an OllamaSelection back at once.
+ * Requests wait in one queue, emergencies first and otherwise in arrival
+ * order, and a dispatcher thread keeps up to maxInFlight of them
+ * outstanding at the server, which batches concurrent generate requests
+ * on the GPU. Ollama has no multi-prompt endpoint, so concurrency is the
+ * batching this gateway can offer. Each pilot's routine requests draw on
+ * a token bucket; a request over its pilot's limit is rejected (FAILED)
+ * straight away so the pilot falls back to rule-based selection instead
+ * of crowding out the others. Requests whose deadline passes in the queue
+ * resolve TIMED_OUT without reaching the server.
+ *
+ * The backend defaults to an OllamaClient; tests substitute their own.
+ */
+class OllamaGateway {
+public:
+    using Backend = std::function<std::shared_ptr<OllamaSelection>(const OllamaGatewayRequest&)>;
+
+    explicit OllamaGateway(const OllamaGatewayConfig& config = OllamaGatewayConfig());
+    OllamaGateway(Backend backend, const OllamaGatewayConfig& config = OllamaGatewayConfig());
+    ~OllamaGateway();
+
+    OllamaGateway(const OllamaGateway&) = delete;
+    OllamaGateway& operator=(const OllamaGateway&) = delete;
+
+    // Settings of the built-in OllamaClient backend; ignored with a custom backend
+    bool connect(const std::string& host = "http://localhost:11434");
+    void setModel(const std::string& model);
+    void setApiKey(const std::string& apiKey);
+    bool isAvailable() const;
+
+    // Queue a selection; thread-safe
+    std::shared_ptr<OllamaSelection> submit(uint32_t pilotId,
+                                            LLMPriority priority,
+                                            const std::string& atcMessage,
+                                            const std::vector<std::string>& menuOptions,
+                                            const std::string& flightPhase,
+                                            const std::string& context,
+                                            std::chrono::milliseconds timeout);
+
+    OllamaGatewayStats getStats() const;
+
+private:
+    struct Queued {
+        OllamaGatewayRequest request;
+        std::shared_ptr<OllamaSelection> caller;
+    };
+
+    struct InFlight {
+        std::shared_ptr<OllamaSelection> caller;
+        std::shared_ptr<OllamaSelection> backend;
+    };
+
+    struct TokenBucket {
+        double tokens = 0.0;
+        std::chrono::steady_clock::time_point refilled;
+    };
+
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{5};
+
+    OllamaGatewayConfig config_;
+    std::unique_ptr<OllamaClient> client_;   // built-in backend only
+    Backend backend_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<Queued> emergencyQueue_;
+    std::deque<Queued> routineQueue_;
+    std::unordered_map<uint32_t, TokenBucket> buckets_;
+    OllamaGatewayStats stats_;
+    bool stopping_ = false;
+
+    std::vector<InFlight> inFlight_;   // dispatcher thread only
+    std::thread dispatcher_;
+
+    bool takeToken(uint32_t pilotId, std::chrono::steady_clock::time_point now);
+    void run();
+    void collectFinished();
+    void expireQueued(std::deque<Queued>& queue, std::chrono::steady_clock::time_point now);
+};
+
+} // namespace AICopilot
+
+#endif // OLLAMA_GATEWAY_HPP
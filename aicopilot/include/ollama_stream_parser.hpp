@@ -0,0 +1,152 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Ollama Stream Parser - incremental menu choice from streamed tokens
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef OLLAMA_STREAM_PARSER_HPP
+#define OLLAMA_STREAM_PARSER_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace AICopilot {
+
+/**
+ * Menu option from a streamed /api/generate response
+ *
+ * With "stream": true Ollama sends one JSON object per line, each carrying
+ * the next fragment of the answer in "response" and "done": true on the
+ * last. feed() takes the body in whatever chunks the transport delivers,
+ * appends each line's fragment to the answer and scans it for the first
+ * number naming an option (1-based). A number is decided as soon as no
+ * further digit could change it, so with fewer than ten options the first
+ * digit token settles the answer and the caller can abort the generation.
+ */
+class OllamaStreamParser {
+public:
+    explicit OllamaStreamParser(size_t numOptions) : numOptions_(numOptions) {}
+
+    // Consume body bytes; returns true once an option is decided
+    bool feed(const char* data, size_t size) {
+        for (size_t i = 0; i < size && !decided_; ++i) {
+            if (data[i] == '\n') {
+                parseLine(line_);
+                line_.clear();
+            } else {
+                line_ += data[i];
+            }
+        }
+        return decided_;
+    }
+
+    // End of body: a number still open at the end of the answer counts
+    void finish() {
+        if (!line_.empty()) {
+            parseLine(line_);
+            line_.clear();
+        }
+        scanAnswer(true);
+    }
+
+    bool isDecided() const { return decided_; }
+    bool isDone() const { return done_; }
+
+    // 0-based option index, or -1 until decided
+    int getOption() const { return decided_ ? option_ : -1; }
+
+    const std::string& getAnswer() const { return answer_; }
+
+private:
+    static constexpr size_t MAX_DIGITS = 3;
+
+    size_t numOptions_;
+    std::string line_;          // partial line
+    std::string answer_;        // concatenated "response" fragments
+    size_t scanned_ = 0;        // answer_ before this holds no option number
+    int option_ = -1;
+    bool decided_ = false;
+    bool done_ = false;
+
+    void parseLine(const std::string& line) {
+        size_t key = line.find("\"response\"");
+        size_t colon = key == std::string::npos ? key : line.find(':', key + 10);
+        size_t quote = colon == std::string::npos ? colon : line.find('"', colon + 1);
+        if (quote != std::string::npos) {
+            appendJsonString(line, quote + 1);
+        }
+        if (line.find("\"done\":true") != std::string::npos ||
+            line.find("\"done\": true") != std::string::npos) {
+            done_ = true;
+        }
+        scanAnswer(done_);
+    }
+
+    // Decode the JSON string starting after its opening quote onto answer_
+    void appendJsonString(const std::string& line, size_t pos) {
+        while (pos < line.size() && line[pos] != '"') {
+            char c = line[pos++];
+            if (c != '\\' || pos >= line.size()) {
+                answer_ += c;
+                continue;
+            }
+            char escaped = line[pos++];
+            switch (escaped) {
+                case 'n': answer_ += '\n'; break;
+                case 't': answer_ += '\t'; break;
+                case 'r': answer_ += '\r'; break;
+                case 'u':
+                    // Non-ASCII never forms part of an option number
+                    pos += 4;
+                    answer_ += ' ';
+                    break;
+                default: answer_ += escaped; break;
+            }
+        }
+    }
+
+    void scanAnswer(bool final) {
+        size_t i = scanned_;
+        while (!decided_ && i < answer_.size()) {
+            if (!isDigit(answer_[i])) {
+                scanned_ = ++i;
+                continue;
+            }
+
+            size_t end = i;
+            size_t value = 0;
+            while (end < answer_.size() && isDigit(answer_[end]) && end - i < MAX_DIGITS + 1) {
+                value = value * 10 + static_cast<size_t>(answer_[end] - '0');
+                ++end;
+            }
+
+            // A number at the end of the answer so far may still grow
+            bool open = end == answer_.size() && !final;
+            if (open && end - i <= MAX_DIGITS && value != 0 && value * 10 <= numOptions_) {
+                return;
+            }
+
+            if (end - i <= MAX_DIGITS && value >= 1 && value <= numOptions_) {
+                option_ = static_cast<int>(value) - 1;
+                decided_ = true;
+                return;
+            }
+            while (end < answer_.size() && isDigit(answer_[end])) ++end;
+            if (end == answer_.size() && !final) {
+                return;   // over-long number still streaming; skip it once it ends
+            }
+            scanned_ = i = end;
+        }
+    }
+
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+};
+
+} // namespace AICopilot
+
+#endif // OLLAMA_STREAM_PARSER_HPP
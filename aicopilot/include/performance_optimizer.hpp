@@ -19,11 +19,20 @@
 #define PERFORMANCE_OPTIMIZER_HPP
 
 #include "aicopilot_types.h"
+#include "tile_cache.hpp"
+#include "memory_arena.hpp"
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 #include <memory>
 #include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_set>
 
 namespace AICopilot {
 
@@ -74,6 +83,13 @@ enum class PrefetchStrategy {
     HYBRID               // Combined strategy
 };
 
+// What a prefetch warms
+enum class PrefetchTarget {
+    TERRAIN_TILE,        // one 1° elevation tile
+    NAVIGATION_REGION,   // navdata around center
+    WEATHER_REGION       // weather stations around center
+};
+
 // Prefetch request
 struct PrefetchRequest {
     Position center;
@@ -81,34 +97,82 @@ struct PrefetchRequest {
     PrefetchStrategy strategy;
     uint32_t priority;   // 0=low, 10=high
     bool completed;
+    PrefetchTarget target = PrefetchTarget::TERRAIN_TILE;
+    int tileLatitude = 0;        // TERRAIN_TILE only
+    int tileLongitude = 0;
+    double distanceNM = 0.0;     // from the aircraft or grid center; nearer runs first
+    bool routeBound = false;     // queued for the route; cancelled when it changes
+    uint64_t routeGeneration = 0;
+};
+
+/**
+ * Coarse steady clock for TTL checks on hot paths
+ *
+ * A background thread refreshes a cached millisecond count every
+ * RESOLUTION_MS, so reading it is one relaxed atomic load instead of a
+ * clock call. Counts from the first use.
+ */
+class CoarseClock {
+public:
+    static constexpr uint32_t RESOLUTION_MS = 50;
+    static uint64_t nowMs();
 };
 
 /**
  * Query Result Cache with TTL management
+ *
+ * Keys hash to one of up to MAX_SHARDS shards, each with its own lock, map
+ * and intrusive recency list, so concurrent lookups on different shards
+ * do not contend and get, put and evict are O(1). Capacity is split evenly
+ * across shards and each evicts its own least recently used entry. Expiry
+ * is checked against CoarseClock; entries may outlive their TTL by up to
+ * CoarseClock::RESOLUTION_MS.
  */
 template<typename KeyType, typename ValueType>
 class QueryCache {
 public:
-    QueryCache(size_t maxEntries = 10000, uint32_t ttlSeconds = 300)
+    static constexpr size_t MAX_SHARDS = 16;
+    
+    QueryCache(size_t maxEntries = 10000, uint32_t ttlSeconds = 300, size_t maxShards = MAX_SHARDS)
         : maxEntries_(maxEntries), ttlSeconds_(ttlSeconds) {
+        // Power of two, and no more shards than entries so small caches stay exact
+        while (shardCount_ * 2 <= std::min(maxShards, MAX_SHARDS) && shardCount_ * 2 <= maxEntries_) {
+            shardCount_ *= 2;
+        }
+        shards_.reset(new Shard[shardCount_]);
+        size_t perShard = (std::max<size_t>(maxEntries_, 1) + shardCount_ - 1) / shardCount_;
+        for (size_t i = 0; i < shardCount_; ++i) {
+            shards_[i].capacity = perShard;
+        }
     }
     
+    QueryCache(const QueryCache&) = delete;
+    QueryCache& operator=(const QueryCache&) = delete;
+    
     /**
      * Put value in cache
      */
     void put(const KeyType& key, const ValueType& value) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        CacheEntry<ValueType> entry;
-        entry.value = value;
-        entry.timestamp = std::chrono::steady_clock::now();
-        entry.accessCount = 1;
-        entry.score = 1.0;
+        Shard& shard = shardFor(key);
+        uint64_t expiresAt = CoarseClock::nowMs() + static_cast<uint64_t>(ttlSeconds_) * 1000;
+        std::lock_guard<std::mutex> lock(shard.mutex);
         
-        cache_[key] = entry;
+        auto result = shard.entries.try_emplace(key);
+        Node* node = &result.first->second;
+        if (result.second) {
+            node->key = &result.first->first;
+        } else {
+            shard.unlink(node);
+        }
+        node->value = value;
+        node->expiresAtMs = expiresAt;
+        node->accessCount = 1;
+        shard.pushFront(node);
         
-        if (cache_.size() > maxEntries_) {
-            evictLRU();
+        if (shard.entries.size() > shard.capacity) {
+            Node* oldest = shard.tail;
+            shard.unlink(oldest);
+            shard.entries.erase(shard.entries.find(*oldest->key));
         }
     }
     
@@ -116,27 +180,26 @@ public:
      * Get value from cache (null if not found or expired)
      */
     bool get(const KeyType& key, ValueType& outValue) {
-        std::lock_guard<std::mutex> lock(mutex_);
+        Shard& shard = shardFor(key);
+        uint64_t now = CoarseClock::nowMs();
+        std::lock_guard<std::mutex> lock(shard.mutex);
         
-        auto it = cache_.find(key);
-        if (it == cache_.end()) {
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
             return false;
         }
         
-        // Check TTL
-        auto now = std::chrono::steady_clock::now();
-        auto age = std::chrono::duration_cast<std::chrono::seconds>(
-            now - it->second.timestamp).count();
-        
-        if (age > ttlSeconds_) {
-            cache_.erase(it);
+        Node* node = &it->second;
+        if (now > node->expiresAtMs) {
+            shard.unlink(node);
+            shard.entries.erase(it);
             return false;
         }
         
-        // Update access metrics
-        it->second.accessCount++;
-        it->second.score = it->second.accessCount;
-        outValue = it->second.value;
+        node->accessCount++;
+        shard.unlink(node);
+        shard.pushFront(node);
+        outValue = node->value;
         
         return true;
     }
@@ -145,43 +208,80 @@ public:
      * Clear cache
      */
     void clear() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        cache_.clear();
+        for (size_t i = 0; i < shardCount_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            shards_[i].entries.clear();
+            shards_[i].head = nullptr;
+            shards_[i].tail = nullptr;
+        }
     }
     
     /**
      * Get cache size
      */
     size_t size() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return cache_.size();
+        size_t total = 0;
+        for (size_t i = 0; i < shardCount_; ++i) {
+            std::lock_guard<std::mutex> lock(shards_[i].mutex);
+            total += shards_[i].entries.size();
+        }
+        return total;
     }
     
+    size_t shardCount() const { return shardCount_; }
+    
     /**
      * Get metrics
      */
     PerformanceMetrics getMetrics() const {
-        std::lock_guard<std::mutex> lock(mutex_);
         PerformanceMetrics metrics = {0};
-        metrics.memoryUsed = cache_.size() * sizeof(CacheEntry<ValueType>);
+        metrics.memoryUsed = size() * (sizeof(KeyType) + sizeof(Node));
         return metrics;
     }
     
 private:
-    std::unordered_map<KeyType, CacheEntry<ValueType>, std::hash<KeyType>> cache_;
+    struct Node {
+        const KeyType* key = nullptr;   // the map's copy
+        ValueType value{};
+        uint64_t expiresAtMs = 0;       // CoarseClock time
+        uint32_t accessCount = 0;
+        Node* prev = nullptr;
+        Node* next = nullptr;
+    };
+    
+    // Map nodes keep their address across rehash, so the list links them directly
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<KeyType, Node, std::hash<KeyType>> entries;
+        Node* head = nullptr;   // most recently used
+        Node* tail = nullptr;
+        size_t capacity = 0;
+        
+        void pushFront(Node* node) {
+            node->prev = nullptr;
+            node->next = head;
+            if (head) head->prev = node;
+            head = node;
+            if (!tail) tail = node;
+        }
+        
+        void unlink(Node* node) {
+            if (node->prev) node->prev->next = node->next; else head = node->next;
+            if (node->next) node->next->prev = node->prev; else tail = node->prev;
+            node->prev = nullptr;
+            node->next = nullptr;
+        }
+    };
+    
     size_t maxEntries_;
     uint32_t ttlSeconds_;
-    mutable std::mutex mutex_;
-    
-    void evictLRU() {
-        // Find entry with lowest score
-        auto minIt = cache_.begin();
-        for (auto it = cache_.begin(); it != cache_.end(); ++it) {
-            if (it->second.score < minIt->second.score) {
-                minIt = it;
-            }
-        }
-        cache_.erase(minIt);
+    size_t shardCount_ = 1;
+    std::unique_ptr<Shard[]> shards_;
+    
+    Shard& shardFor(const KeyType& key) const {
+        // Fibonacci mix so identity hashes of packed keys spread over the shards
+        uint64_t h = static_cast<uint64_t>(std::hash<KeyType>{}(key)) * 0x9E3779B97F4A7C15ull;
+        return shards_[(h >> 32) & (shardCount_ - 1)];
     }
 };
 
@@ -207,11 +307,21 @@ public:
     // CACHING OPTIMIZATION
     // ============================================================
     
+    // Terrain is cached per source raster cell (SRTM 1 arc-second posts)
+    static constexpr int TERRAIN_CELLS_PER_DEGREE = 3600;
+    
     /**
      * Cache terrain elevation data with TTL
+     * The value covers the whole raster cell containing pos
      */
     void cacheTerrainElevation(const Position& pos, double elevation);
     
+    /**
+     * Cache the four corner posts of the raster cell containing pos
+     * Lookups anywhere in the cell interpolate between them
+     */
+    void cacheTerrainCell(const Position& pos, const CellCorners& corners);
+    
     /**
      * Get cached terrain elevation
      * Returns true if cache hit, false otherwise
@@ -252,6 +362,25 @@ public:
     // QUERY BATCHING
     // ============================================================
     
+    /**
+     * Batched elevation source: fills out[i] with feet MSL at points[i],
+     * 0 where unavailable. SRTMLoader::GetElevations,
+     * ElevationDatabase::GetElevations and TerrainDatabase::getElevations
+     * all fit. Set before starting the batch worker.
+     */
+    using ElevationBackend = std::function<void(const LatLon* points, size_t count, double* out)>;
+    void setElevationBackend(ElevationBackend backend);
+    
+    /**
+     * Waypoint source for processWaypointBatch(), e.g.
+     * NavigationDatabase::GetWaypoint
+     */
+    using WaypointBackend = std::function<std::optional<Waypoint>(const std::string& id)>;
+    void setWaypointBackend(WaypointBackend backend);
+    
+    // Points per batch timed one at a time to measure the batching speedup
+    static constexpr size_t SPEEDUP_SAMPLE_POINTS = 8;
+    
     /**
      * Create query batch for multiple positions
      */
@@ -270,19 +399,39 @@ public:
     bool isBatchReady(uint32_t batchId) const;
     
     /**
-     * Process batch (for integrated terrain/nav queries)
+     * Process batch: elevation in feet MSL per position
+     * Cached cells are served first; the misses go to the elevation
+     * backend in one call, grouped by 1° tile, and are cached. Without a
+     * backend misses are 0. The first SPEEDUP_SAMPLE_POINTS misses are
+     * queried one at a time, timing the unbatched cost.
      */
     std::vector<double> processBatch(const QueryBatch& batch);
     
+    /**
+     * Look up many waypoints: cached ones first, then each distinct miss
+     * once through the waypoint backend; found waypoints are cached
+     */
+    std::vector<std::optional<Waypoint>> processWaypointBatch(const std::vector<std::string>& ids);
+    
+    /**
+     * Flush batches on a worker thread: each batch is processed and
+     * removed when it fills or its timeoutMs passes, and callback gets
+     * the results on the worker thread. Empty batches are dropped.
+     */
+    using BatchCallback = std::function<void(const QueryBatch& batch, const std::vector<double>& elevations)>;
+    void startBatchWorker(BatchCallback callback);
+    void stopBatchWorker();
+    
     /**
      * Get batch statistics
      */
     struct BatchStatistics {
         uint64_t batchesCreated;
-        uint64_t queriesOptimized;
-        double percentageOptimized;
+        uint64_t batchesProcessed;
+        uint64_t queriesOptimized;     // positions answered through batches
+        double percentageOptimized;    // of all terrain queries
         double averageBatchSize;
-        double averageSpeedupFactor;
+        double averageSpeedupFactor;   // measured per point; 0 until measured
     };
     BatchStatistics getBatchStatistics() const;
     
@@ -290,8 +439,40 @@ public:
     // PREFETCHING
     // ============================================================
     
+    /*
+     * Prefetch requests go to a priority queue served by one background
+     * I/O thread: higher priority first, then nearest first. Each request
+     * calls the loader for its target; a target without a loader is not
+     * queued. Set the loaders before starting the worker.
+     */
+    using TilePrefetcher = std::function<bool(int tileLatitude, int tileLongitude)>;
+    using RegionPrefetcher = std::function<bool(const Position& center, double radiusNM)>;
+    
+    static constexpr size_t MAX_PENDING_PREFETCHES = 256;
+    static constexpr double ROUTE_SAMPLE_SPACING_NM = 10.0;   // well under a tile width
+    static constexpr double NAVIGATION_REGION_NM = 25.0;
+    static constexpr double WEATHER_REGION_NM = 50.0;
+    
+    // e.g. SRTMLoader::PrefetchTile or TerrainDatabase::prefetchTile
+    void setTerrainPrefetcher(TilePrefetcher loader);
+    // e.g. a NavigationDatabase::GetWaypointsNearby that fills waypointCache_
+    void setNavigationPrefetcher(RegionPrefetcher loader);
+    // e.g. a weather station index query around center
+    void setWeatherPrefetcher(RegionPrefetcher loader);
+    
+    // Requests queue up before start; stopping drops whatever is still queued
+    void startPrefetchWorker();
+    void stopPrefetchWorker();
+    
+    // Drop queued route prefetches; one already loading counts as cancelled
+    void cancelRoutePrefetches();
+    
+    // Block until the queue is drained; returns at once if no worker runs
+    void waitForPrefetches();
+    
     /**
      * Prefetch terrain data in spatial grid
+     * Queues each tile within radius, nearest first
      */
     void prefetchTerrainGrid(const Position& centerPos,
                            double radius,  // nautical miles
@@ -306,6 +487,9 @@ public:
     
     /**
      * Prefetch along flight path
+     * Replaces the previous route's prefetches: tiles under the legs and
+     * navdata and weather around each waypoint, up to lookAheadDistance
+     * along track from flightPath[0], nearest first
      */
     void prefetchAlongFlightPath(const std::vector<Waypoint>& flightPath,
                                 double lookAheadDistance);  // nautical miles
@@ -314,9 +498,11 @@ public:
      * Get prefetch status
      */
     struct PrefetchStatus {
-        uint32_t activePrefetches;
-        uint32_t completedPrefetches;
-        std::vector<std::string> pendingItems;
+        uint32_t activePrefetches;       // queued or loading
+        uint32_t completedPrefetches;    // loader reported success
+        uint32_t failedPrefetches;       // loader found no data
+        uint32_t cancelledPrefetches;    // route changed first
+        std::vector<std::string> pendingItems;   // queued, in run order
         double completionPercentage;
     };
     PrefetchStatus getPrefetchStatus() const;
@@ -327,41 +513,10 @@ public:
     
     /**
      * Object pool for frequently allocated objects
+     * Slabs with per-thread free lists; per-tick temporaries belong in
+     * FrameArena::forThread() instead
      */
-    class MemoryPool {
-    public:
-        MemoryPool(size_t objectSize, size_t poolSize = 1000)
-            : objectSize_(objectSize), poolSize_(poolSize) {
-        }
-        
-        /**
-         * Allocate from pool
-         */
-        void* allocate() {
-            if (available_.empty()) {
-                return malloc(objectSize_);
-            }
-            void* ptr = available_.back();
-            available_.pop_back();
-            return ptr;
-        }
-        
-        /**
-         * Return to pool
-         */
-        void deallocate(void* ptr) {
-            if (available_.size() < poolSize_) {
-                available_.push_back(ptr);
-            } else {
-                free(ptr);
-            }
-        }
-        
-    private:
-        size_t objectSize_;
-        size_t poolSize_;
-        std::vector<void*> available_;
-    };
+    using MemoryPool = SlabPool;
     
     /**
      * Get memory usage statistics
@@ -443,15 +598,51 @@ private:
     
     // Caches
     QueryCache<std::string, Waypoint> waypointCache_;
-    QueryCache<std::string, double> elevationCache_;
+    QueryCache<uint64_t, CellCorners> elevationCache_;  // keyed by RasterCell::key()
     QueryCache<std::string, WeatherConditions> weatherCache_;
     
-    // Query batching
+    // Query batching; batchMutex_ guards the batches and their counters
+    mutable std::mutex batchMutex_;
     std::unordered_map<uint32_t, QueryBatch> activeBatches_;
     uint32_t nextBatchId_;
-    
-    // Prefetching
-    std::vector<PrefetchRequest> prefetchRequests_;
+    ElevationBackend elevationBackend_;
+    WaypointBackend waypointBackend_;
+    
+    uint64_t batchesProcessed_ = 0;
+    uint64_t batchedQueries_ = 0;
+    uint64_t singleTimedPoints_ = 0;   // backend calls of one point
+    double singleTimedMs_ = 0.0;
+    uint64_t batchTimedPoints_ = 0;    // points in batched backend calls
+    double batchTimedMs_ = 0.0;
+    
+    std::thread batchWorker_;
+    std::condition_variable batchCv_;
+    BatchCallback batchCallback_;
+    bool stopBatchWorker_ = false;
+    
+    void batchWorkerLoop();
+    
+    // Prefetching; prefetchMutex_ guards the queue and its counters
+    mutable std::mutex prefetchMutex_;
+    std::condition_variable prefetchCv_;
+    std::condition_variable prefetchIdleCv_;
+    std::vector<PrefetchRequest> prefetchRequests_;   // heap, see prefetchRunsAfter
+    std::unordered_set<std::string> prefetchKeys_;    // queued or loading
+    TilePrefetcher terrainPrefetcher_;
+    RegionPrefetcher navigationPrefetcher_;
+    RegionPrefetcher weatherPrefetcher_;
+    std::thread prefetchWorker_;
+    bool stopPrefetchWorker_ = false;
+    bool prefetchInFlight_ = false;
+    uint64_t routeGeneration_ = 0;
+    uint32_t prefetchesCompleted_ = 0;
+    uint32_t prefetchesFailed_ = 0;
+    uint32_t prefetchesCancelled_ = 0;
+    
+    static bool prefetchRunsAfter(const PrefetchRequest& a, const PrefetchRequest& b);
+    static std::string prefetchKey(const PrefetchRequest& request);
+    bool queuePrefetch(PrefetchRequest request);
+    void prefetchWorkerLoop();
     
     // Performance tracking
     PerformanceMetrics totalMetrics_;
@@ -0,0 +1,254 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Pilot Checkpoint - AIPilot state in a mappable binary file
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef PILOT_CHECKPOINT_HPP
+#define PILOT_CHECKPOINT_HPP
+
+#include "aicopilot_types.h"
+#include "clearance_log.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+
+enum PilotCheckpointSectionId : uint32_t {
+    CHECKPOINT_SECTION_PILOT = 0,           // PilotCheckpointState
+    CHECKPOINT_SECTION_WAYPOINTS,           // PilotCheckpointWaypoint[waypointCount]
+    CHECKPOINT_SECTION_CLEARANCE,           // ClearanceSnapshot base, or empty without ATC state
+    CHECKPOINT_SECTION_CLEARANCE_EVENTS,    // ClearanceEvent[] after the base
+    CHECKPOINT_SECTION_ATC_TEXT,            // PilotCheckpointString[]: last clearance, then pending instructions
+    CHECKPOINT_SECTION_WARM_SET,            // PilotCheckpointWarmEntry[warmEntryCount]
+    CHECKPOINT_SECTION_MODEL,               // ModelPack image (ML state), or empty
+    CHECKPOINT_SECTION_STRINGS,             // char pool the string refs point into
+    CHECKPOINT_SECTION_COUNT
+};
+
+/*
+ * On-disk layout (little-endian): the header, then the sections above,
+ * each 8-byte aligned, so a mapped checkpoint is read in place and an
+ * embedded model pack opens as a view of its section. The checksum covers
+ * every byte after the header.
+ */
+struct PilotCheckpointSection {
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct PilotCheckpointHeader {
+    char magic[4];                  // "AIPC"
+    uint16_t version;
+    uint16_t headerSize;            // sizeof(PilotCheckpointHeader)
+    uint32_t waypointCount;
+    uint32_t warmEntryCount;
+    uint64_t fileSize;
+    uint64_t checksum;              // FNV-1a 64
+    PilotCheckpointSection sections[CHECKPOINT_SECTION_COUNT];
+};
+
+// Bytes in the string pool
+struct PilotCheckpointString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+enum PilotCheckpointFlags : uint32_t {
+    CHECKPOINT_PREFLIGHT_COMPLETE = 1u << 0,
+    CHECKPOINT_SHUTDOWN_COMPLETE = 1u << 1,
+    CHECKPOINT_FUEL_WARNING_20 = 1u << 2,
+    CHECKPOINT_FUEL_WARNING_10 = 1u << 3,
+    CHECKPOINT_MANUAL_OVERRIDE = 1u << 4,
+    CHECKPOINT_WEATHER_ASSESSED = 1u << 5,
+    CHECKPOINT_TERRAIN_VALID = 1u << 6,
+    CHECKPOINT_ON_GROUND = 1u << 7,
+    CHECKPOINT_GEAR_DOWN = 1u << 8,
+    CHECKPOINT_PARKING_BRAKE = 1u << 9,
+    CHECKPOINT_ICING = 1u << 10,
+    CHECKPOINT_TURBULENCE = 1u << 11,
+    CHECKPOINT_PRECIPITATION = 1u << 12
+};
+
+// Flight phase, progress flags, the last aircraft state and the weather
+// last acted on
+struct PilotCheckpointState {
+    int32_t phase;                  // FlightPhase
+    uint32_t flags;                 // PilotCheckpointFlags
+    uint32_t activeWaypoint;        // Navigation::getActiveWaypointIndex()
+    int32_t flapsPosition;
+    PilotCheckpointString departure;
+    PilotCheckpointString arrival;
+    double cruiseAltitude;
+    double cruiseSpeed;
+    double latitude;
+    double longitude;
+    double altitude;
+    double heading;
+    double indicatedAirspeed;
+    double trueAirspeed;
+    double groundSpeed;
+    double verticalSpeed;
+    double pitch;
+    double bank;
+    double fuelQuantity;
+    double terrainElevation;        // ft MSL, with CHECKPOINT_TERRAIN_VALID
+    double windSpeed;
+    double windDirection;
+    double visibility;
+    double cloudBase;
+    double ceiling;
+    double temperature;
+    double dewpoint;
+};
+
+struct PilotCheckpointWaypoint {
+    double latitude;
+    double longitude;
+    double positionAltitude;        // Waypoint::position.altitude
+    double heading;                 // Waypoint::position.heading, the inbound course
+    double altitude;                // Waypoint::altitude
+    PilotCheckpointString id;
+    PilotCheckpointString type;
+};
+
+// Caches a restored pilot (or its host) warms before the scenario runs
+enum class WarmSetCache : uint32_t {
+    AIRPORT = 0,                    // ICAO code; AIPilot prefetches these on resume
+    TERRAIN_TILE,                   // tile key, host-applied
+    WEATHER_STATION,                // station ICAO, host-applied
+    HOST                            // anything else a host records
+};
+
+struct PilotCheckpointWarmEntry {
+    WarmSetCache cache;
+    uint32_t reserved;
+    PilotCheckpointString key;
+};
+
+static_assert(sizeof(PilotCheckpointHeader) == 160, "PilotCheckpointHeader layout");
+static_assert(sizeof(PilotCheckpointState) == 200, "PilotCheckpointState layout");
+static_assert(sizeof(PilotCheckpointWaypoint) == 56, "PilotCheckpointWaypoint layout");
+static_assert(sizeof(PilotCheckpointWarmEntry) == 16, "PilotCheckpointWarmEntry layout");
+
+/**
+ * Writer for pilot checkpoints
+ *
+ * AIPilot::captureCheckpoint() fills the pilot, navigation and ATC
+ * sections and the airports it uses; a host adds its own warm-set entries
+ * and, through ModelPackBuilder, the ML state it owns, then writes the
+ * checkpoint once for any number of scenario variants to resume from.
+ * String refs in the state are filled by build().
+ */
+class PilotCheckpointBuilder {
+public:
+    PilotCheckpointBuilder();
+
+    PilotCheckpointState& state() { return state_; }
+    void setFlightPlan(const FlightPlan& plan, size_t activeWaypoint);
+    void setClearances(const ClearanceLog& log, const std::string& lastClearance,
+                       const std::vector<std::string>& pendingInstructions);
+    void addWarmEntry(WarmSetCache cache, const std::string& key);
+    void setModelImage(std::vector<uint8_t> image);   // ModelPackBuilder::build()
+
+    // The complete checkpoint image
+    std::vector<uint8_t> build() const;
+    bool write(const std::string& path) const;
+
+private:
+    PilotCheckpointState state_;
+    FlightPlan plan_;
+    bool hasClearances_ = false;
+    ClearanceSnapshot clearanceBase_;
+    std::vector<ClearanceEvent> clearanceEvents_;
+    std::vector<std::string> atcText_;
+    std::vector<std::pair<WarmSetCache, std::string>> warmSet_;
+    std::vector<uint8_t> model_;
+};
+
+/**
+ * Read-only pilot checkpoint backed by a file mapping or an in-memory image
+ *
+ * open() maps the file and validates the header, section sizes, every
+ * string ref and by default the checksum, so a scenario harness maps one
+ * checkpoint once and forks thousands of pilots from it: each resume
+ * copies a few hundred bytes plus the route and clearance log, and an
+ * embedded model pack is read in place. Immutable once open; concurrent
+ * reads are safe.
+ */
+class PilotCheckpoint {
+public:
+    static constexpr char MAGIC[4] = {'A', 'I', 'P', 'C'};
+    static constexpr uint16_t VERSION = 1;
+
+    PilotCheckpoint() = default;
+    ~PilotCheckpoint();
+
+    PilotCheckpoint(const PilotCheckpoint&) = delete;
+    PilotCheckpoint& operator=(const PilotCheckpoint&) = delete;
+
+    bool open(const std::string& path, bool verifyChecksum = true);
+    bool openImage(std::vector<uint8_t> image);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+    bool isMapped() const { return isOpen() && image_.empty(); }
+    size_t getSize() const { return size_; }
+
+    const PilotCheckpointState& getState() const { return *section<PilotCheckpointState>(CHECKPOINT_SECTION_PILOT); }
+    FlightPhase getPhase() const { return static_cast<FlightPhase>(getState().phase); }
+    bool hasFlag(PilotCheckpointFlags flag) const { return (getState().flags & flag) != 0; }
+
+    // Flight plan with every waypoint; empty without one
+    FlightPlan getFlightPlan() const;
+    size_t getWaypointCount() const { return isOpen() ? header().waypointCount : 0; }
+
+    bool hasClearances() const;
+    const ClearanceSnapshot& getClearanceBase() const;
+    const ClearanceEvent* getClearanceEvents() const;
+    size_t getClearanceEventCount() const;
+    std::string getLastClearance() const;
+    std::vector<std::string> getPendingInstructions() const;
+
+    size_t getWarmEntryCount() const { return isOpen() ? header().warmEntryCount : 0; }
+    WarmSetCache getWarmCache(size_t i) const { return warmEntries()[i].cache; }
+    std::string getWarmKey(size_t i) const { return str(warmEntries()[i].key); }
+    std::vector<std::string> getWarmKeys(WarmSetCache cache) const;
+
+    // Embedded ModelPack bytes, for ModelPack::openView(); size 0 without one
+    const uint8_t* getModelData() const { return data_ + header().sections[CHECKPOINT_SECTION_MODEL].offset; }
+    size_t getModelSize() const { return isOpen() ? header().sections[CHECKPOINT_SECTION_MODEL].size : 0; }
+
+    std::string str(const PilotCheckpointString& ref) const;
+
+private:
+    const PilotCheckpointHeader& header() const { return *reinterpret_cast<const PilotCheckpointHeader*>(data_); }
+    template <typename T>
+    const T* section(PilotCheckpointSectionId id) const {
+        return reinterpret_cast<const T*>(data_ + header().sections[id].offset);
+    }
+    const PilotCheckpointString* atcText() const { return section<PilotCheckpointString>(CHECKPOINT_SECTION_ATC_TEXT); }
+    size_t getAtcTextCount() const;
+    const PilotCheckpointWarmEntry* warmEntries() const {
+        return section<PilotCheckpointWarmEntry>(CHECKPOINT_SECTION_WARM_SET);
+    }
+
+    bool validate(bool verifyChecksum) const;
+    bool validString(const PilotCheckpointString& ref) const;
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<uint8_t> image_;      // backing store for openImage()
+    void* fileHandle_ = nullptr;      // Windows
+    void* mappingHandle_ = nullptr;   // Windows
+};
+
+} // namespace AICopilot
+
+#endif // PILOT_CHECKPOINT_HPP
@@ -0,0 +1,93 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Pilot Host - runs many AIPilot instances in one process
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef PILOT_HOST_HPP
+#define PILOT_HOST_HPP
+
+#include "ai_pilot.h"
+#include "navdata_provider.h"
+#include "ollama_gateway.hpp"
+#include "work_stealing_pool.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * Multi-instance AIPilot host for fleet simulation
+ *
+ * Every hosted pilot keeps its own flight state, SimConnect session and
+ * scheduler, but starts no threads of its own: each frame the host updates
+ * all active pilots in parallel on one work-stealing pool. Pilots on live
+ * sims may instead pump their session on its own dispatch thread, so one
+ * host drives a lab of MSFS 2024 and P3D v6 instances at once. Immutable
+ * databases are loaded once and shared by shared_ptr<const>, so memory per
+ * aircraft stays small and hundreds of pilots fit on one node.
+ */
+class PilotHost {
+public:
+    // 0 uses one pool thread per hardware thread
+    explicit PilotHost(size_t threadCount = 0);
+    ~PilotHost();
+
+    PilotHost(const PilotHost&) = delete;
+    PilotHost& operator=(const PilotHost&) = delete;
+
+    // Shared databases; set before adding pilots (navdata defaults to AIPilot::createNavdataProvider())
+    void setSharedNavdata(std::shared_ptr<const INavdataProvider> navdata);
+    std::shared_ptr<const INavdataProvider> getSharedNavdata() const { return navdata_; }
+    
+    // One Ollama queue for all pilots (optional); pilot ids are their host index
+    void setSharedOllamaGateway(std::shared_ptr<OllamaGateway> gateway);
+    std::shared_ptr<OllamaGateway> getSharedOllamaGateway() const { return ollamaGateway_; }
+
+    // Create a pilot wired for hosting; initialize/configure it through the returned reference
+    AIPilot& addPilot();
+    
+    // A pilot for a live sim session (initialize(simType, configIndex)):
+    // its SimConnect messages are dispatched on the session's own thread
+    // as they arrive, so a slow frame or a busy sim never stalls the other
+    // sessions. The host pool still runs its update().
+    AIPilot& addSessionPilot();
+
+    size_t getPilotCount() const { return pilots_.size(); }
+    AIPilot& getPilot(size_t index) { return *pilots_[index]; }
+    size_t getActivePilotCount() const;
+
+    // Update every active pilot once; returns when all have finished
+    void tick();
+
+    // Tick at the fastest pilot's update rate until stop() or no pilot is active
+    void run();
+    void stop() { stopRequested_ = true; }
+
+    size_t getThreadCount() const { return pool_.getThreadCount(); }
+    uint64_t getFrameCount() const { return frameCount_; }
+    uint64_t getFrameOverruns() const { return frameOverruns_; }  // frames longer than the control period
+
+private:
+    AIPilot& addHostedPilot(bool dispatchThread);
+
+    WorkStealingPool pool_;
+    std::shared_ptr<const INavdataProvider> navdata_;
+    std::shared_ptr<OllamaGateway> ollamaGateway_;
+    std::vector<std::unique_ptr<AIPilot>> pilots_;
+
+    std::atomic<bool> stopRequested_{false};
+    uint64_t frameCount_ = 0;
+    uint64_t frameOverruns_ = 0;
+};
+
+} // namespace AICopilot
+
+#endif // PILOT_HOST_HPP
@@ -15,6 +15,8 @@
 
 #include "aicopilot_types.h"
 #include "aircraft_config.h"
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
@@ -60,6 +62,146 @@ struct ChecklistItem {
     bool critical = false;  // If fails, abort preflight
 };
 
+/**
+ * Aircraft state fields a checklist condition can test
+ */
+enum class ChecklistField : uint8_t {
+    ENGINE_RPM,
+    FUEL_QUANTITY,
+    ON_GROUND,
+    PARKING_BRAKE,
+    GEAR_DOWN,
+    FLAPS_POSITION,
+    MASTER_BATTERY,
+    MASTER_ALTERNATOR,
+    BATTERY_VOLTAGE,
+    GENERATOR_VOLTAGE,
+    INDICATED_AIRSPEED,
+    GROUND_SPEED
+};
+
+enum class ChecklistCompare : uint8_t {
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL,
+    EQUAL,
+    NOT_EQUAL
+};
+
+/**
+ * Action a checklist step asks for before it waits on its condition
+ */
+enum class ChecklistAction : uint8_t {
+    NONE,
+    SET_PARKING_BRAKE,
+    RELEASE_PARKING_BRAKE,
+    MIXTURE_RICH,
+    MAGNETOS_BOTH,
+    START_ENGINE,            // argument: engine index
+    NAV_LIGHTS_ON,
+    BEACON_LIGHTS_ON,
+    STROBE_LIGHTS_ON,
+    LANDING_LIGHTS_ON,
+    TAXI_LIGHTS_ON
+};
+
+// Aircraft a step applies to, any of
+enum ChecklistApplies : uint8_t {
+    APPLIES_SINGLE_ENGINE = 1u << 0,
+    APPLIES_MULTI_ENGINE = 1u << 1,   // piston twins and up
+    APPLIES_TURBOPROP = 1u << 2,
+    APPLIES_JET = 1u << 3,
+    APPLIES_ALL = (1u << 4) - 1
+};
+
+struct ChecklistCondition {
+    double value;
+    ChecklistField field;
+    ChecklistCompare compare;
+};
+
+/**
+ * One compiled checklist step
+ *
+ * Conditions are conditionCount entries from firstCondition in the
+ * program's condition array, all of which must hold.
+ */
+struct ChecklistStep {
+    float timeout = 0.0f;              // seconds to wait for the conditions; 0 checks once
+    uint16_t firstCondition = 0;
+    uint8_t conditionCount = 0;
+    ChecklistAction action = ChecklistAction::NONE;
+    int8_t argument = 0;
+    PreflightPhase phase = PreflightPhase::EXTERIOR_INSPECTION;
+    uint8_t applies = APPLIES_ALL;
+    uint8_t minEngines = 0;
+    bool critical = true;
+};
+
+// Text of a step, for reports only
+struct ChecklistText {
+    std::string id;
+    std::string description;
+    std::string action;
+    std::string expected;
+};
+
+class ParsedConfig;
+
+/**
+ * Checklist compiled from a data file into flat steps and conditions
+ *
+ * Each section of the file is a step, ordered by phase and then by
+ * section name:
+ *
+ *   [ENG007]
+ *   phase = engine_startup        ; exterior, interior, engine_startup, systems, taxi
+ *   description = Engine start
+ *   action = Engine start - CONTINUE until running
+ *   expected = Engine starts smoothly and idles
+ *   critical = true
+ *   do = start_engine             ; optional ChecklistAction, lower case
+ *   argument = 0
+ *   condition = engine_rpm > 600 && engine_rpm < 1500
+ *   timeout = 30
+ *   applies = single, multi       ; optional: single, multi, turboprop, jet
+ *   min_engines = 2               ; optional
+ *
+ * Running a step touches no strings. Programs are immutable, cached per
+ * file and shared by every pilot flying the same checklist.
+ */
+class ChecklistProgram {
+public:
+    // nullptr with `error` set if any step fails to compile
+    static std::shared_ptr<const ChecklistProgram> compile(const ParsedConfig& config, std::string& error);
+    
+    // Compiled file from the process-wide cache, recompiled when the file changes
+    static std::shared_ptr<const ChecklistProgram> load(const std::string& filePath, std::string& error);
+    
+    // The standard checklist built into the library
+    static std::shared_ptr<const ChecklistProgram> builtin();
+    
+    static void clearCache();
+    
+    size_t size() const { return steps_.size(); }
+    const ChecklistStep& step(size_t index) const { return steps_[index]; }
+    const ChecklistText& text(size_t index) const { return texts_[index]; }
+    
+    // Whether every condition of a step holds
+    bool evaluate(size_t index, const AircraftState& state) const;
+    
+    // Steps that apply to an aircraft, in order
+    std::vector<uint16_t> select(const AircraftConfig& config) const;
+    
+private:
+    std::vector<ChecklistStep> steps_;
+    std::vector<ChecklistCondition> conditions_;
+    std::vector<ChecklistText> texts_;
+};
+
+using ChecklistActionHandler = std::function<void(ChecklistAction action, int argument)>;
+
 /**
  * Preflight procedure result
  */
@@ -81,20 +223,36 @@ public:
     ~PreflightProcedures() = default;
     
     /**
-     * Initialize preflight for specific aircraft
+     * Initialize preflight for specific aircraft with the built-in checklist
      */
     bool initialize(const AircraftConfig& config);
     
+    /**
+     * Initialize preflight with a compiled checklist, e.g. from ChecklistProgram::load
+     */
+    bool initialize(const AircraftConfig& config, std::shared_ptr<const ChecklistProgram> program);
+    
+    /**
+     * Called with each step's action when the step starts
+     */
+    void setActionHandler(ChecklistActionHandler handler) { actionHandler_ = std::move(handler); }
+    
     /**
      * Start preflight procedure
+     * @param now Seconds on the clock later passed to executeNextItem
      */
     void startPreflight();
+    void startPreflight(double now);
     
     /**
      * Execute next checklist item
+     *
+     * A step with a timeout stays IN_PROGRESS until its conditions hold or
+     * the timeout runs out.
      * @return true if all items processed, false if still in progress
      */
     bool executeNextItem(const AircraftState& currentState);
+    bool executeNextItem(const AircraftState& currentState, double now);
     
     /**
      * Get current preflight phase
@@ -109,7 +267,9 @@ public:
     /**
      * Get all checklist items
      */
-    const std::vector<ChecklistItem>& getAllItems() const { return checklistItems_; }
+    const std::vector<ChecklistItem>& getAllItems() const;
+    
+    const ChecklistProgram* getProgram() const { return program_.get(); }
     
     /**
      * Get progress (0.0 to 1.0)
@@ -148,43 +308,31 @@ public:
     bool hasFailed() const { return currentPhase_ == PreflightPhase::FAILED; }
     
 private:
+    // Per-pilot progress through one selected step
+    struct StepState {
+        ChecklistItemStatus status = ChecklistItemStatus::NOT_STARTED;
+        double startedAt = 0.0;
+        double completionTime = 0.0;
+    };
+    
     AircraftConfig aircraftConfig_;
     PreflightPhase currentPhase_ = PreflightPhase::NOT_STARTED;
-    std::vector<ChecklistItem> checklistItems_;
+    std::shared_ptr<const ChecklistProgram> program_;
+    std::vector<uint16_t> steps_;          // program steps that apply, in order
+    std::vector<StepState> stepStates_;
+    std::vector<std::string> notes_;       // filled only by completeItem
     size_t currentItemIndex_ = 0;
     double startTime_ = 0.0;
+    ChecklistActionHandler actionHandler_;
+    
+    // Items built from the program on request, for reporting
+    mutable std::vector<ChecklistItem> items_;
+    mutable ChecklistItem currentItem_;
     
-    // Initialize checklists for different aircraft types
-    void initializeGenericChecklist();
-    void initializeSingleEngineChecklist();
-    void initializeMultiEngineChecklist();
-    void initializeTurbopropChecklist();
-    void initializeJetChecklist();
-    
-    // Checklist sections
-    void addExteriorInspectionItems();
-    void addInteriorInspectionItems();
-    void addEngineStartupItems();
-    void addSystemCheckItems();
-    void addTaxiReadinessItems();
-    
-    // Validation methods
-    bool validateExteriorCondition(const AircraftState& state);
-    bool validateInteriorSystems(const AircraftState& state);
-    bool validateEngineReadiness(const AircraftState& state);
-    bool validateAllSystems(const AircraftState& state);
-    bool validateTaxiReadiness(const AircraftState& state);
+    ChecklistItem makeItem(size_t index) const;
     
     // State machine transitions
     void transitionToNextPhase();
-    void handlePhaseCompletion();
-    
-    // Phase execution
-    bool executeExteriorInspection(const AircraftState& state);
-    bool executeInteriorInspection(const AircraftState& state);
-    bool executeEngineStartup(const AircraftState& state);
-    bool executeSystemChecks(const AircraftState& state);
-    bool executeTaxiReadiness(const AircraftState& state);
 };
 
 } // namespace AICopilot
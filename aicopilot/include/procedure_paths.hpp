@@ -0,0 +1,110 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Procedure Paths - SID/STAR legs expanded once per runway and transition
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef PROCEDURE_PATHS_HPP
+#define PROCEDURE_PATHS_HPP
+
+#include "navdata.h"
+#include "navdata_pack.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace AICopilot {
+
+enum class ProcedureKind : uint8_t {
+    SID,
+    STAR
+};
+
+struct ProcedureLeg {
+    std::string fix;
+    uint32_t node = NavdataPack::NO_INDEX;   // NO_INDEX if the fix is not in the pack
+    double latitude = 0.0;
+    double longitude = 0.0;
+    double legDistanceNM = 0.0;              // from the previous resolved fix
+    double cumulativeNM = 0.0;               // from the start of the path
+    AltitudeRestriction altitude;
+    double speedLimitKts = 0.0;              // 0 when unrestricted
+};
+
+/**
+ * One procedure flown from one runway through one transition
+ */
+struct ProcedurePath {
+    ProcedureKind kind = ProcedureKind::SID;
+    std::string airport;
+    std::string runway;
+    std::string name;
+    std::string transition;                  // empty for the common route
+    std::vector<ProcedureLeg> legs;          // in flying order
+    double distanceNM = 0.0;                 // measured, or the published distance without geometry
+    int topAltitude = 0;                     // highest altitude the procedure names
+    int bottomAltitude = 0;                  // lowest
+    bool requiresRNAV = false;
+    bool hasGeometry = false;                // at least two legs resolved
+    double entryLatitude = 0.0;              // first resolved leg
+    double entryLongitude = 0.0;
+    double exitLatitude = 0.0;               // last resolved leg
+    double exitLongitude = 0.0;
+};
+
+/**
+ * SID and STAR paths for a navdata snapshot
+ *
+ * build() expands every SID (once per runway, through its transition fix)
+ * and every STAR (once for the common route and once per transition fix)
+ * against the pack: legs get positions, leg and cumulative distances and
+ * their altitude and speed constraints. Selection is then a comparison
+ * over these numbers, with no fix lookups. Immutable once built.
+ */
+class ProcedurePathTable {
+public:
+    void build(const NavdataPack& pack,
+               const std::unordered_map<std::string, std::vector<SID>>& sidsByAirport,
+               const std::unordered_map<std::string, std::vector<STAR>>& starsByAirport);
+
+    // Every path at an airport, SIDs first; nullptr if there are none
+    const std::vector<ProcedurePath>* find(const std::string& airport) const;
+
+    /**
+     * SID whose exit is nearest a fix, the shorter path on a tie; paths
+     * without geometry rank last
+     * @param runway Departure runway; empty, or no SID from it, considers all
+     * @return nullptr if the airport has no SID
+     */
+    const ProcedurePath* bestSID(const std::string& airport, const std::string& runway,
+                                 double fixLatitude, double fixLongitude) const;
+
+    /**
+     * STAR path (common route or transition) whose entry is nearest a
+     * position, ranked like bestSID()
+     */
+    const ProcedurePath* bestSTAR(const std::string& airport, const std::string& runway,
+                                  double latitude, double longitude) const;
+
+    size_t getPathCount() const { return pathCount_; }
+
+    // "RWY_28L", "RW28L" and "28L" all name runway 28L
+    static std::string normalizeRunway(const std::string& runway);
+
+private:
+    const ProcedurePath* best(ProcedureKind kind, const std::string& airport, const std::string& runway,
+                              double latitude, double longitude) const;
+
+    std::unordered_map<std::string, std::vector<ProcedurePath>> byAirport_;
+    size_t pathCount_ = 0;
+};
+
+} // namespace AICopilot
+
+#endif // PROCEDURE_PATHS_HPP
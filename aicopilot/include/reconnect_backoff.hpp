@@ -0,0 +1,93 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Reconnect Backoff - exponential retry schedule that never blocks
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef RECONNECT_BACKOFF_HPP
+#define RECONNECT_BACKOFF_HPP
+
+#include <algorithm>
+#include <chrono>
+
+namespace AICopilot {
+
+/**
+ * When the next connection attempt is due
+ *
+ * The owner polls due() from a loop it already runs (the dispatch thread,
+ * a control tick) instead of sleeping through the delay. The first
+ * attempt after start() is due at once; each failure multiplies the delay
+ * by the multiplier, up to maxDelay, and a success resets it.
+ */
+class ReconnectBackoff {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ReconnectBackoff(std::chrono::milliseconds baseDelay = std::chrono::milliseconds(1000),
+                              double multiplier = 1.5,
+                              std::chrono::milliseconds maxDelay = std::chrono::milliseconds(30000)) {
+        configure(baseDelay, multiplier, maxDelay);
+    }
+
+    void configure(std::chrono::milliseconds baseDelay, double multiplier, std::chrono::milliseconds maxDelay) {
+        baseDelay_ = std::max(std::chrono::milliseconds(1), baseDelay);
+        multiplier_ = std::max(1.0, multiplier);
+        maxDelay_ = std::max(baseDelay_, maxDelay);
+        reset();
+    }
+
+    // Connected: the next loss starts from the base delay
+    void reset() {
+        failures_ = 0;
+        delay_ = baseDelay_;
+        nextAttempt_ = Clock::time_point::min();
+    }
+
+    // Link lost at now; the first attempt is due immediately
+    void start(Clock::time_point now) {
+        reset();
+        nextAttempt_ = now;
+    }
+
+    bool due(Clock::time_point now) const { return now >= nextAttempt_; }
+
+    // An attempt at now failed; returns the wait before the next one
+    std::chrono::milliseconds recordFailure(Clock::time_point now) {
+        std::chrono::milliseconds wait = delay_;
+        nextAttempt_ = now + wait;
+        failures_++;
+        double grown = static_cast<double>(delay_.count()) * multiplier_;
+        delay_ = std::chrono::milliseconds(static_cast<long long>(
+            std::min(grown, static_cast<double>(maxDelay_.count()))));
+        return wait;
+    }
+
+    // Time left before the next attempt; zero once it is due
+    std::chrono::milliseconds untilNext(Clock::time_point now) const {
+        if (due(now)) return std::chrono::milliseconds(0);
+        return std::chrono::duration_cast<std::chrono::milliseconds>(nextAttempt_ - now) +
+               std::chrono::milliseconds(1);
+    }
+
+    Clock::time_point nextAttempt() const { return nextAttempt_; }
+    int getFailureCount() const { return failures_; }
+    std::chrono::milliseconds getNextDelay() const { return delay_; }
+
+private:
+    std::chrono::milliseconds baseDelay_{1000};
+    std::chrono::milliseconds maxDelay_{30000};
+    double multiplier_ = 1.5;
+    std::chrono::milliseconds delay_{1000};
+    Clock::time_point nextAttempt_ = Clock::time_point::min();
+    int failures_ = 0;
+};
+
+} // namespace AICopilot
+
+#endif // RECONNECT_BACKOFF_HPP
@@ -52,7 +52,7 @@ enum class ILSCategory {
  * ILS System Information
  * Complete Instrument Landing System data for runway
  */
-struct ILSData {
+struct RunwayILSData {
     bool hasILS = false;                        // Does runway have ILS
     ILSCategory category = ILSCategory::NONE;   // ILS category
     double localizerFrequency = 0.0;            // 108.1-111.95 MHz
@@ -114,7 +114,7 @@ struct RunwayInfo {
     int LDA = 0;                                // Landing Distance Available
     
     // ILS information
-    ILSData ilsData;
+    RunwayILSData ilsData;
     
     // Remarks
     std::string remarks;                        // Additional notes
@@ -124,7 +124,7 @@ struct RunwayInfo {
  * Airport Information
  * Airport reference data
  */
-struct AirportInfo {
+struct RunwayAirportInfo {
     std::string icao;                           // ICAO code
     std::string iata;                           // IATA code (if available)
     std::string name;                           // Full airport name
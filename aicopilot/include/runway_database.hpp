@@ -1,8 +1,8 @@
 /*****************************************************************************
 * Copyright 2025 AI Copilot FS Project
 *
-* Runway Database - Airport runway and ILS information
-* Provides runway data, ILS frequencies, and approach information
+* Approach Runway Database - runway and ILS information for the approach system
+* Facade over the shared RunwayDatabase store (runway_database_prod.hpp)
 *
 * This program is free software: you can redistribute it and/or modify
 * it under the terms of the GNU General Public License as published by
@@ -14,18 +14,17 @@
 #define RUNWAY_DATABASE_HPP
 
 #include "aicopilot_types.h"
+#include "runway_database_prod.hpp"
 #include <string>
 #include <vector>
-#include <map>
 #include <memory>
-#include <mutex>
 
 namespace AICopilot {
 
 /**
  * ILS System Information
  */
-struct ILSData {
+struct ApproachILSData {
     bool hasILS;                    // Does runway have ILS
     double localizerFrequency;      // 108.1-111.95 MHz
     double glideslopeFrequency;     // 329.15-335.0 MHz
@@ -40,7 +39,7 @@ struct ILSData {
 /**
  * Runway Information
  */
-struct RunwayInfo {
+struct ApproachRunwayInfo {
     std::string icaoCode;           // Airport ICAO (e.g., "KJFK")
     std::string runwayId;           // Runway identifier (e.g., "04L", "22R", "18")
     Position thresholdPosition;     // Runway threshold coordinates
@@ -50,7 +49,7 @@ struct RunwayInfo {
     int width;                      // Feet
     std::string surfaceType;        // ASPH, CONC, GRS, DIRT, TURF, WATER, etc.
     
-    ILSData ilsData;
+    ApproachILSData ilsData;
     bool hasVGSI;                   // PAPI or VASI
     std::string vgsiType;           // PAPI, VASI, or empty
     
@@ -76,17 +75,20 @@ struct RunwayInfo {
 };
 
 /**
- * Runway Database
- * Manages runway and ILS information for airports
+ * Approach Runway Database
+ * Runway and ILS information for airports in the approach system's types.
+ * Holds no runways of its own: every query reads the RunwayDatabase store
+ * it was given, by default RunwayDatabase::Shared(), and converts the rows.
  */
-class RunwayDatabase {
+class ApproachRunwayDatabase {
 public:
-    RunwayDatabase();
-    ~RunwayDatabase();
+    explicit ApproachRunwayDatabase(std::shared_ptr<RunwayDatabase> store = RunwayDatabase::Shared());
+    ~ApproachRunwayDatabase();
     
     /**
      * Initialize runway database
-     * @param csvFile Path to runway database CSV file
+     * The store already holds its data; a CSV file is merged into it
+     * @param csvFile Path to runway database CSV file, or empty
      * @return true if initialized successfully
      */
     bool initialize(const std::string& csvFile);
@@ -103,14 +105,14 @@ public:
      * @param runway Output runway information
      * @return true if found
      */
-    bool getRunway(const std::string& icao, const std::string& runwayId, RunwayInfo& runway);
+    bool getRunway(const std::string& icao, const std::string& runwayId, ApproachRunwayInfo& runway);
     
     /**
      * Get all runways for airport
      * @param icao Airport ICAO code
      * @return Vector of runways
      */
-    std::vector<RunwayInfo> getAirportRunways(const std::string& icao);
+    std::vector<ApproachRunwayInfo> getAirportRunways(const std::string& icao);
     
     /**
      * Get best runway for landing based on wind
@@ -124,7 +126,7 @@ public:
     bool selectRunwayForLanding(const std::string& icao, 
                                int windDirection, int windSpeed,
                                int maxCrosswind,
-                               RunwayInfo& runway);
+                               ApproachRunwayInfo& runway);
     
     /**
      * Get best runway for takeoff based on wind
@@ -136,7 +138,7 @@ public:
      */
     bool selectRunwayForTakeoff(const std::string& icao, 
                                int windDirection, int windSpeed,
-                               RunwayInfo& runway);
+                               ApproachRunwayInfo& runway);
     
     /**
      * Get ILS data for runway
@@ -145,7 +147,7 @@ public:
      * @param ils Output ILS data
      * @return true if ILS available
      */
-    bool getILSData(const std::string& icao, const std::string& runwayId, ILSData& ils);
+    bool getILSData(const std::string& icao, const std::string& runwayId, ApproachILSData& ils);
     
     /**
      * Check if runway is suitable for landing
@@ -154,7 +156,7 @@ public:
      * @param requiredDistance Required landing distance
      * @return true if runway is suitable
      */
-    bool isSuitableForLanding(const RunwayInfo& runway, 
+    bool isSuitableForLanding(const ApproachRunwayInfo& runway, 
                              int aircraftLength, 
                              int requiredDistance);
     
@@ -165,7 +167,7 @@ public:
      * @param requiredDistance Required takeoff distance
      * @return true if runway is suitable
      */
-    bool isSuitableForTakeoff(const RunwayInfo& runway,
+    bool isSuitableForTakeoff(const ApproachRunwayInfo& runway,
                             int aircraftLength,
                             int requiredDistance);
     
@@ -184,7 +186,7 @@ public:
      * Add runway to database
      * @param runway Runway information
      */
-    void addRunway(const RunwayInfo& runway);
+    void addRunway(const ApproachRunwayInfo& runway);
     
     /**
      * Get runway count
@@ -193,28 +195,19 @@ public:
     
     /**
      * Clear all runways
+     * Clears the underlying store for every facade sharing it
      */
     void clear();
 
 private:
-    struct RunwayKey {
-        std::string icao;
-        std::string runwayId;
-        
-        bool operator<(const RunwayKey& other) const {
-            if (icao != other.icao) return icao < other.icao;
-            return runwayId < other.runwayId;
-        }
-    };
-    
-    std::map<RunwayKey, RunwayInfo> runwayData_;
-    mutable std::mutex dbMutex_;
+    std::shared_ptr<RunwayDatabase> store_;
+    
+    static ApproachRunwayInfo toApproach(const RunwayInfo& runway);
+    static RunwayInfo fromApproach(const ApproachRunwayInfo& runway);
     
     // Helper methods
     double calculateCrosswind(int runwayHeading, int windDirection, int windSpeed) const;
     double calculateHeadwind(int runwayHeading, int windDirection, int windSpeed) const;
-    std::string getReciprocal(const std::string& runwayId) const;
-    int parseRunwayHeading(const std::string& runwayId) const;
 };
 
 } // namespace AICopilot
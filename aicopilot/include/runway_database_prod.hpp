@@ -13,18 +13,70 @@
 #pragma once
 
 #include "runway_data.h"
+#include "runway_pack.hpp"
+#include "striped_cache.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <future>
 #include <vector>
 #include <string>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <utility>
 
 namespace AICopilot {
 
+/**
+ * One airport's runways, contiguous and sorted by runway ID
+ *
+ * Refers into one version of the database without copying it and keeps
+ * that version alive, so a span stays valid after later AddRunway() or
+ * Clear() calls; it just won't see them.
+ */
+class RunwaySpan {
+public:
+    RunwaySpan() = default;
+    
+    const RunwayInfo* begin() const { return first_; }
+    const RunwayInfo* end() const { return first_ + count_; }
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    const RunwayInfo& operator[](size_t index) const { return first_[index]; }
+    
+private:
+    friend class RunwayDatabase;
+    std::shared_ptr<const void> owner_;
+    const RunwayInfo* first_ = nullptr;
+    size_t count_ = 0;
+};
+
+/**
+ * One airport and its wind, for RunwayDatabase::ScoreBestRunways()
+ */
+struct RunwayWindQuery {
+    std::string icao;
+    int windDirection = 0;                      // Degrees
+    int windSpeed = 0;                          // Knots
+};
+
+/**
+ * An airport's best runway for a RunwayWindQuery
+ */
+struct RunwayScore {
+    bool found = false;                         // False if no runway is acceptable
+    std::string runwayId;
+    int runwayNumber = 0;                       // RunwaySelector::ParseRunwayHeading(runwayId)
+    double score = 0.0;                         // RunwaySelector::ScoreRunway(), lower is better
+    double headwind = 0.0;                      // Knots, negative is tailwind
+    double crosswind = 0.0;                     // Knots, positive from the left
+};
+
 /**
  * Production-Ready Runway Database
  * Manages runway information for 50+ major airports
- * Features: Thread-safe, <10ms queries, <5MB memory footprint
+ * Features: Thread-safe lock-free reads, <10ms queries, <5MB memory footprint
  */
 class RunwayDatabase {
 public:
@@ -37,6 +89,40 @@ public:
      */
     bool Initialize();
     
+    /**
+     * The process-wide runway store, initialized with the built-in data on
+     * first use. The ApproachRunwayDatabase and SimpleRunwayDatabase facades
+     * read through it, so the process holds one copy and one index.
+     */
+    static std::shared_ptr<RunwayDatabase> Shared();
+    
+    /**
+     * Replace the database with a compiled runway pack
+     * Rows come out of the pack already grouped, sorted and indexed, so
+     * nothing is parsed or sorted at load. The new version passes the
+     * CheckDatabaseConsistency() checks before it is swapped in; spans
+     * handed out before keep the version they came from.
+     * @param path Runway pack file (see tools/runway_compiler)
+     * @return true if the file was mapped and validated
+     */
+    bool LoadPack(const std::string& path);
+    
+    /**
+     * Load a runway pack on a background thread; queries keep using the
+     * current data until the new version is swapped in
+     * @param path Runway pack file
+     * @return Future holding the LoadPack() result; the load runs on
+     *         IoExecutor::shared(), so keep the database alive until it resolves
+     */
+    std::future<bool> LoadPackAsync(const std::string& path);
+    
+    /**
+     * Write the current runways and airports as a runway pack
+     * @param path Output file
+     * @return true on success
+     */
+    bool SavePack(const std::string& path) const;
+    
     /**
      * Shutdown database
      */
@@ -59,6 +145,13 @@ public:
      */
     std::vector<RunwayInfo> GetAllRunways(const std::string& icao) const;
     
+    /**
+     * Get all runways for airport without copying them
+     * @param icao Airport ICAO code
+     * @return The airport's runways; empty if it has none
+     */
+    RunwaySpan GetRunways(const std::string& icao) const;
+    
     /**
      * Get best runway for landing based on wind
      * Minimizes crosswind, prefers headwind and ILS
@@ -93,6 +186,18 @@ public:
     RunwayInfo GetBestRunwayForTakeoff(const std::string& icao, int windDirection, 
                                        int windSpeed) const;
     
+    /**
+     * Best runway at many airports, each under its own wind
+     * Same acceptance and score as RunwaySelector::SelectBestRunway(), in
+     * one pass over one version of the database using each runway's
+     * precomputed heading sine and cosine; for alternate selection.
+     * @param queries Airports and winds; unknown airports come back not found
+     * @param criteria Limits and preferences; its wind fields are ignored
+     * @return One score per query, in order
+     */
+    std::vector<RunwayScore> ScoreBestRunways(const std::vector<RunwayWindQuery>& queries,
+                                              const RunwaySelectionCriteria& criteria) const;
+    
     /**
      * Validate runway for aircraft operation
      * Checks length, width, and surface compatibility
@@ -129,7 +234,7 @@ public:
      * @param airport Output airport information
      * @return true if airport found
      */
-    bool GetAirportInfo(const std::string& icao, AirportInfo& airport) const;
+    bool GetAirportInfo(const std::string& icao, RunwayAirportInfo& airport) const;
     
     /**
      * Check if airport has ILS
@@ -154,7 +259,7 @@ public:
      * @return true if ILS available
      */
     bool GetILSData(const std::string& icao, const std::string& runwayId, 
-                    ILSData& ilsData) const;
+                    RunwayILSData& ilsData) const;
     
     /**
      * Get runway count
@@ -188,41 +293,121 @@ public:
     
     /**
      * Add runway to database
+     * Publishes a new version; readers holding the old one keep it
      * @param runway Runway information
      */
     void AddRunway(const RunwayInfo& runway);
     
+    /**
+     * Add many runways as one new version
+     * @param runways Runway information; each replaces any with its ICAO and ID
+     */
+    void AddRunways(const std::vector<RunwayInfo>& runways);
+    
     /**
      * Get statistics
      * @return String with database statistics
      */
     std::string GetStatistics() const;
 
+    /**
+     * Check consistency of database
+     * @return Error message for the first runway without an ID, a length
+     *         or a heading in 0-360, or airport with invalid coordinates;
+     *         empty string if OK
+     */
+    std::string CheckDatabaseConsistency() const;
+
+    /**
+     * Hits and misses of the GetBestRunway*() memo
+     */
+    StripedCacheStats GetSelectionCacheStats() const { return selectionCache_.getStats(); }
+
 private:
     struct AirportKey {
         std::string icao;
         bool operator<(const AirportKey& other) const { return icao < other.icao; }
     };
     
-    struct RunwayKey {
-        std::string icao;
-        std::string runwayId;
-        bool operator<(const RunwayKey& other) const {
-            if (icao != other.icao) return icao < other.icao;
-            return runwayId < other.runwayId;
-        }
+    struct RunwayRange {
+        uint32_t first = 0;
+        uint32_t count = 0;
+    };
+    
+    // One immutable version of the database: every runway grouped by
+    // airport and sorted by runway ID, each airport's range, and the
+    // airports with their runway stats. Queries take the current version
+    // with Current() and never lock; writers merge their changes into the
+    // next version under publishMutex_ and publish it with std::atomic_store.
+    // Spans keep the version they came from alive.
+    struct Snapshot {
+        std::vector<RunwayInfo> runways;
+        std::unordered_map<std::string, RunwayRange> runwayIndex;
+        std::map<AirportKey, RunwayAirportInfo> airports;
+        int runwaysWithILS = 0;
+        uint64_t generation = 0;                // unique per published version
+        
+        // Per-runway columns indexed like runways, for ScoreBestRunways()
+        std::vector<double> headingSin;
+        std::vector<double> headingCos;
+        std::vector<int> lda;
+        std::vector<int> length;
+        std::vector<int> width;
+        std::vector<uint8_t> hasILS;
+        std::vector<uint8_t> runwayNumber;
+    };
+    std::shared_ptr<const Snapshot> snapshot_;  // only through Current() and std::atomic_store
+    std::mutex publishMutex_;                   // serializes writers; guards staging_
+    
+    // Initialize() collects the built-in data here and publishes it once
+    struct Staging {
+        std::vector<RunwayInfo> runways;
+        std::vector<RunwayAirportInfo> airports;
     };
+    std::unique_ptr<Staging> staging_;
+    
+    uint64_t generation_ = 0;                   // last one handed out; guarded by publishMutex_
+    
+    std::shared_ptr<const Snapshot> Current() const { return std::atomic_load(&snapshot_); }
+    void StoreLocked(std::shared_ptr<Snapshot> next);
+    
+    // GetBestRunway*() memo. The selection is a pure function of an
+    // airport's runways and the wind and limits, all integral, so keys pack
+    // the airport's first runway index, the wind direction and speed, the
+    // crosswind limit in quarter knots and the selection mode, and hits give
+    // exactly what SelectBestRunway() would. Entries name their snapshot
+    // generation, so a publish retires every entry at once; stale ones are
+    // replaced on their next miss.
+    enum class SelectionMode : uint64_t {
+        LANDING = 0,
+        LANDING_ILS = 1,
+        TAKEOFF = 2
+    };
+    struct CachedSelection {
+        uint64_t generation = 0;
+        uint32_t runway = 0;                    // into Snapshot::runways
+        bool found = false;
+    };
+    static constexpr size_t SELECTION_CACHE_CAPACITY = 4096;
+    mutable StripedCache<CachedSelection> selectionCache_{SELECTION_CACHE_CAPACITY};
+    
+    RunwayInfo SelectBestCached(const std::string& icao, const RunwaySelectionCriteria& criteria,
+                                SelectionMode mode) const;
     
-    std::map<RunwayKey, RunwayInfo> runways_;
-    std::map<AirportKey, AirportInfo> airports_;
-    mutable std::mutex dbMutex_;
+    // Next version: base plus the rows, a row replacing any with its key.
+    // Caller holds publishMutex_.
+    void PublishLocked(const Snapshot& base, std::vector<RunwayInfo> runways, std::vector<RunwayAirportInfo> airports);
+    RunwaySpan SpanOf(const std::shared_ptr<const Snapshot>& snapshot, const std::string& icao) const;
+    bool AirportAdded(const std::string& icao);
+    static std::shared_ptr<Snapshot> SnapshotOf(const RunwayPack& pack);
+    static std::string CheckSnapshot(const Snapshot& snapshot);
     
     // Initialize with production runway data
     void InitializeRunwayData();
     
     // Helper methods
-    void AddAirport(const AirportInfo& airport);
-    void UpdateRunwayStats(const std::string& icao);
+    void AddAirport(const RunwayAirportInfo& airport);
+    static void UpdateRunwayStats(RunwayAirportInfo& airport, const Snapshot& snapshot);
     
     // Surface friction coefficients
     double GetSurfaceFrictionCoefficient(SurfaceType surface) const;
@@ -0,0 +1,227 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Runway Pack - compiled, memory-mapped runway and airport dataset
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef RUNWAY_PACK_HPP
+#define RUNWAY_PACK_HPP
+
+#include "runway_data.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace AICopilot {
+
+enum RunwayPackSectionId : uint32_t {
+    RUNWAY_SECTION_STRINGS = 0,         // identifier, name and remark bytes
+    RUNWAY_SECTION_AIRPORTS,            // RunwayPackAirport[airportCount], by ICAO
+    RUNWAY_SECTION_AIRPORT_HASH,        // uint32 airport[airportBuckets], open addressing by ICAO
+    RUNWAY_SECTION_RUNWAYS,             // RunwayPackRunway[runwayCount], by airport then runway ID
+    RUNWAY_SECTION_COUNT
+};
+
+/*
+ * On-disk layout (little-endian): the header, then the sections above,
+ * each 8-byte aligned. References are offsets or indices, never pointers,
+ * so the file can be mapped at any address and shared read-only between
+ * processes. The checksum covers every byte after the header.
+ */
+struct RunwayPackSection {
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct RunwayPackHeader {
+    char magic[4];                 // "ARPK"
+    uint16_t version;
+    uint16_t headerSize;           // sizeof(RunwayPackHeader)
+    uint32_t airportCount;
+    uint32_t runwayCount;
+    uint32_t airportBuckets;       // power of two
+    uint32_t reserved;
+    uint64_t fileSize;
+    uint64_t checksum;             // FNV-1a 64
+    RunwayPackSection sections[RUNWAY_SECTION_COUNT];
+};
+
+struct RunwayPackString {
+    uint32_t offset;               // into the string section
+    uint32_t length;
+};
+
+// Every ICAO with runways or airport information
+struct RunwayPackAirport {
+    double latitude;
+    double longitude;
+    double magneticVariation;
+    RunwayPackString icao;
+    RunwayPackString iata;
+    RunwayPackString name;
+    RunwayPackString classification;
+    int32_t elevation;
+    uint32_t firstRunway;          // into the runway section
+    uint32_t runwayCount;
+    uint8_t hasInfo;               // 0 if only runways were compiled for the ICAO
+    uint8_t hasMajorILS;
+    uint8_t reserved[2];
+};
+
+// Bits of RunwayPackRunway::flags
+namespace RunwayPackFlags {
+    constexpr uint8_t HAS_ILS = 1u << 0;
+    constexpr uint8_t GROOVED = 1u << 1;
+    constexpr uint8_t POROUS = 1u << 2;
+    constexpr uint8_t HAS_ALS = 1u << 3;
+    constexpr uint8_t HAS_RUNWAY_LIGHTS = 1u << 4;
+    constexpr uint8_t HAS_REIL = 1u << 5;
+    constexpr uint8_t HAS_VGSI = 1u << 6;
+    constexpr uint8_t DISPLACED_THRESHOLD = 1u << 7;
+}
+
+struct RunwayPackRunway {
+    double latitude;
+    double longitude;
+    double magneticVariation;
+    double frictionCoefficient;
+    double localizerFrequency;
+    double glideslopeFrequency;
+    double glideslopeAngle;
+    double headingSin;             // of headingMagnetic, for wind components
+    double headingCos;
+    RunwayPackString airportName;
+    RunwayPackString runwayId;
+    RunwayPackString vgsiType;
+    RunwayPackString ilsIdentifier;
+    RunwayPackString remarks;
+    uint32_t airport;              // into the airport section
+    int32_t elevation;
+    int32_t headingMagnetic;
+    int32_t headingTrue;
+    int32_t length;
+    int32_t width;
+    int32_t displacedDistance;
+    int32_t TORA;
+    int32_t TODA;
+    int32_t ASDA;
+    int32_t LDA;
+    int32_t localizerCourse;
+    int32_t decisionHeight;
+    int32_t minimumRVR;
+    uint8_t surface;               // SurfaceType
+    uint8_t ilsCategory;           // ILSCategory
+    uint8_t flags;                 // RunwayPackFlags
+    uint8_t runwayNumber;          // Leading number of runwayId, 0 if none
+    uint32_t reserved;
+};
+
+static_assert(sizeof(RunwayPackHeader) == 104, "RunwayPackHeader layout");
+static_assert(sizeof(RunwayPackAirport) == 72, "RunwayPackAirport layout");
+static_assert(sizeof(RunwayPackRunway) == 176, "RunwayPackRunway layout");
+
+/**
+ * Offline compiler for runway packs
+ *
+ * Airports are collected by ICAO and runways by ICAO and runway ID, a
+ * repeat replacing the earlier entry. build() lays out the string pool,
+ * the airport table with each airport's contiguous runway range and the
+ * ICAO hash table, so opening a pack needs no parsing, sorting or index
+ * building.
+ */
+class RunwayPackBuilder {
+public:
+    void putAirport(const RunwayAirportInfo& airport);
+    void putRunway(const RunwayInfo& runway);
+
+    size_t getAirportCount() const { return airports_.size(); }
+    size_t getRunwayCount() const { return runways_.size(); }
+
+    // The complete pack image
+    std::vector<uint8_t> build() const;
+    bool write(const std::string& path) const;
+
+private:
+    std::map<std::string, RunwayAirportInfo> airports_;
+    std::map<std::pair<std::string, std::string>, RunwayInfo> runways_;
+};
+
+/**
+ * Read-only runway pack backed by a file mapping or an in-memory image
+ *
+ * open() maps the file and validates the header, the section bounds and
+ * every airport's runway range, and by default the checksum. ICAOs
+ * resolve to airport indices through the hash table in the file and
+ * records are read in place. Immutable once open; concurrent queries are
+ * safe.
+ */
+class RunwayPack {
+public:
+    static constexpr char MAGIC[4] = {'A', 'R', 'P', 'K'};
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint32_t NO_INDEX = 0xFFFFFFFFu;
+
+    RunwayPack() = default;
+    ~RunwayPack();
+
+    RunwayPack(const RunwayPack&) = delete;
+    RunwayPack& operator=(const RunwayPack&) = delete;
+
+    // True if the file starts with the pack magic
+    static bool isPackFile(const std::string& path);
+
+    // Checksum verification reads every page once; skip it only for trusted files
+    bool open(const std::string& path, bool verifyChecksum = true);
+    bool openImage(std::vector<uint8_t> image);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+
+    // Copy the pack bytes to a file
+    bool save(const std::string& path) const;
+
+    uint64_t getChecksum() const { return isOpen() ? header().checksum : 0; }
+    size_t getAirportCount() const { return isOpen() ? header().airportCount : 0; }
+    size_t getRunwayCount() const { return isOpen() ? header().runwayCount : 0; }
+    size_t getSize() const { return size_; }
+    bool isMapped() const { return isOpen() && image_.empty(); }
+
+    // Airport index for an ICAO, NO_INDEX if absent
+    uint32_t findAirport(std::string_view icao) const;
+    const RunwayPackAirport& getAirportRecord(uint32_t airport) const { return airports()[airport]; }
+    RunwayAirportInfo getAirport(uint32_t airport) const;
+
+    const RunwayPackRunway& getRunwayRecord(uint32_t runway) const { return runways()[runway]; }
+    RunwayInfo getRunway(uint32_t runway) const;
+
+    std::string_view getString(const RunwayPackString& ref) const;
+
+private:
+    const RunwayPackHeader& header() const { return *reinterpret_cast<const RunwayPackHeader*>(data_); }
+    template <typename T>
+    const T* section(RunwayPackSectionId id) const {
+        return reinterpret_cast<const T*>(data_ + header().sections[id].offset);
+    }
+    const RunwayPackAirport* airports() const { return section<RunwayPackAirport>(RUNWAY_SECTION_AIRPORTS); }
+    const RunwayPackRunway* runways() const { return section<RunwayPackRunway>(RUNWAY_SECTION_RUNWAYS); }
+
+    bool validate(bool verifyChecksum) const;
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<uint8_t> image_;      // backing store for openImage()
+    void* fileHandle_ = nullptr;      // Windows
+    void* mappingHandle_ = nullptr;   // Windows
+};
+
+} // namespace AICopilot
+
+#endif // RUNWAY_PACK_HPP
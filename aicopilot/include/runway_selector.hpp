@@ -13,6 +13,7 @@
 #pragma once
 
 #include "runway_data.h"
+#include <cstddef>
 #include <vector>
 #include <string>
 
@@ -82,6 +83,24 @@ public:
         const RunwaySelectionCriteria& criteria,
         const RunwayWindComponents& components);
     
+    /**
+     * IsRunwayAcceptable() and ScoreRunway() on just the values they read,
+     * for callers holding runways as precomputed columns
+     */
+    static bool IsAcceptable(
+        int lda,
+        int length,
+        int width,
+        double headwind,
+        double crosswind,
+        const RunwaySelectionCriteria& criteria);
+    static double Score(
+        int length,
+        bool hasILS,
+        double headwind,
+        double crosswind,
+        const RunwaySelectionCriteria& criteria);
+    
     /**
      * Select best runway from list
      * @param runways Available runways
@@ -94,6 +113,15 @@ public:
         const RunwaySelectionCriteria& criteria,
         RunwayInfo& bestRunway);
     
+    /**
+     * Select best runway from a contiguous array, e.g. a RunwaySpan
+     */
+    static bool SelectBestRunway(
+        const RunwayInfo* runways,
+        size_t count,
+        const RunwaySelectionCriteria& criteria,
+        RunwayInfo& bestRunway);
+    
     /**
      * Select runway for landing
      * Prefers headwind and ILS, minimizes crosswind
@@ -0,0 +1,146 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Runway Wind - headwind and crosswind components from runway unit vectors
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef RUNWAY_WIND_HPP
+#define RUNWAY_WIND_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * Wind components along and across runways
+ *
+ * A runway heading is kept as its unit vector and a wind as its
+ * speed-scaled vector, so the components are the angle-difference
+ * identities: two multiplies and an add each, no trigonometry and no
+ * angle wrapping per runway.
+ *
+ * headwind = speed * cos(wind - heading), negative for a tailwind
+ * crosswind = speed * sin(wind - heading), positive for wind from the right
+ *
+ * CrosswindMatrix holds the headings of every runway of a set of airports
+ * in columns, built once, and evaluates a whole wind field (one wind per
+ * airport) over them in one pass that the compiler vectorizes.
+ */
+namespace RunwayWind {
+
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+struct Heading {
+    double sin = 0.0;
+    double cos = 1.0;
+};
+
+// Wind vector scaled by speed (knots), direction the wind blows from
+struct Wind {
+    double sin = 0.0;
+    double cos = 0.0;
+};
+
+struct Components {
+    double headwind = 0.0;
+    double crosswind = 0.0;
+};
+
+inline Heading heading(double degrees) {
+    double radians = degrees * DEG_TO_RAD;
+    return Heading{std::sin(radians), std::cos(radians)};
+}
+
+inline Wind wind(double directionDegrees, double speed) {
+    double radians = directionDegrees * DEG_TO_RAD;
+    return Wind{speed * std::sin(radians), speed * std::cos(radians)};
+}
+
+inline Components compute(const Heading& runway, const Wind& w) {
+    return Components{w.cos * runway.cos + w.sin * runway.sin,
+                      w.sin * runway.cos - w.cos * runway.sin};
+}
+
+inline Components compute(double runwayHeading, double windDirection, double windSpeed) {
+    return compute(heading(runwayHeading), wind(windDirection, windSpeed));
+}
+
+// compute() for one wind over heading columns; outputs are written to [0, count)
+inline void computeBatch(size_t count, const double* headingSin, const double* headingCos,
+                         const Wind& w, double* headwind, double* crosswind) {
+    for (size_t i = 0; i < count; ++i) {
+        headwind[i] = w.cos * headingCos[i] + w.sin * headingSin[i];
+        crosswind[i] = w.sin * headingCos[i] - w.cos * headingSin[i];
+    }
+}
+
+/**
+ * Runway headings of many airports, grouped by airport
+ */
+class CrosswindMatrix {
+public:
+    void clear() {
+        headingSin_.clear();
+        headingCos_.clear();
+        first_.clear();
+    }
+
+    void reserve(size_t airports, size_t runways) {
+        headingSin_.reserve(runways);
+        headingCos_.reserve(runways);
+        first_.reserve(airports + 1);
+    }
+
+    // Start the next airport; runways added after this belong to it
+    size_t addAirport() {
+        if (first_.empty()) first_.push_back(0);
+        first_.push_back(first_.back());
+        return first_.size() - 2;
+    }
+
+    void addRunway(double headingDegrees) {
+        Heading h = heading(headingDegrees);
+        headingSin_.push_back(h.sin);
+        headingCos_.push_back(h.cos);
+        first_.back()++;
+    }
+
+    size_t airportCount() const { return first_.empty() ? 0 : first_.size() - 1; }
+    size_t runwayCount() const { return headingSin_.size(); }
+
+    // Airport's runways are [first(airport), first(airport) + count(airport))
+    size_t first(size_t airport) const { return first_[airport]; }
+    size_t count(size_t airport) const { return first_[airport + 1] - first_[airport]; }
+
+    // One wind everywhere; outputs hold runwayCount() values
+    void evaluate(const Wind& w, double* headwind, double* crosswind) const {
+        computeBatch(runwayCount(), headingSin_.data(), headingCos_.data(), w, headwind, crosswind);
+    }
+
+    // One wind per airport, winds[airportCount()]
+    void evaluate(const Wind* winds, double* headwind, double* crosswind) const {
+        for (size_t a = 0; a < airportCount(); ++a) {
+            size_t begin = first_[a];
+            computeBatch(first_[a + 1] - begin, headingSin_.data() + begin, headingCos_.data() + begin,
+                         winds[a], headwind + begin, crosswind + begin);
+        }
+    }
+
+private:
+    std::vector<double> headingSin_;
+    std::vector<double> headingCos_;
+    std::vector<size_t> first_;   // airportCount() + 1 offsets
+};
+
+} // namespace RunwayWind
+
+} // namespace AICopilot
+
+#endif // RUNWAY_WIND_HPP
@@ -0,0 +1,84 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* SimConnect API - per-SDK client entry points for concurrent sessions
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef SIMCONNECT_API_HPP
+#define SIMCONNECT_API_HPP
+
+#include "aicopilot_types.h"
+
+#ifdef AICOPILOT_HAVE_SIMCONNECT
+#include <windows.h>
+#include <SimConnect.h>
+#endif
+
+namespace AICopilot {
+
+// SimConnect client family a simulator speaks to
+enum class SimConnectSdk {
+    MSFS,    // MSFS 2024 / 2020
+    P3D      // Prepar3D v4-v6
+};
+
+inline SimConnectSdk simConnectSdkFor(SimulatorType simType) {
+    switch (simType) {
+        case SimulatorType::P3D_V6:
+        case SimulatorType::P3D_V5:
+        case SimulatorType::P3D_V4:
+            return SimConnectSdk::P3D;
+        default:
+            return SimConnectSdk::MSFS;
+    }
+}
+
+inline const char* simConnectSdkName(SimConnectSdk sdk) {
+    return sdk == SimConnectSdk::P3D ? "Prepar3D" : "MSFS";
+}
+
+#ifdef AICOPILOT_HAVE_SIMCONNECT
+
+/**
+ * The SimConnect calls a session makes, bound to one SDK's client
+ *
+ * Each SDK ships its own client library with the same exported names, so
+ * one process cannot link both. An SDK whose DLL path is compiled in
+ * (AICOPILOT_MSFS_SIMCONNECT_DLL, AICOPILOT_P3D_SIMCONNECT_DLL) is loaded
+ * the first time a session needs it; the other uses the linked client.
+ * A single-SDK build links one client and serves every simulator type
+ * with it, as before. Tables are resolved once and never change, so
+ * sessions on different dispatch threads share them freely.
+ */
+struct SimConnectApi {
+    SimConnectSdk sdk = SimConnectSdk::MSFS;
+    bool loaded = false;    // resolved from a DLL rather than linked
+
+    decltype(&::SimConnect_Open) Open = nullptr;
+    decltype(&::SimConnect_Close) Close = nullptr;
+    decltype(&::SimConnect_CallDispatch) CallDispatch = nullptr;
+    decltype(&::SimConnect_AddToDataDefinition) AddToDataDefinition = nullptr;
+    decltype(&::SimConnect_RequestDataOnSimObject) RequestDataOnSimObject = nullptr;
+    decltype(&::SimConnect_RequestDataOnSimObjectType) RequestDataOnSimObjectType = nullptr;
+    decltype(&::SimConnect_SetDataOnSimObject) SetDataOnSimObject = nullptr;
+    decltype(&::SimConnect_MapClientEventToSimEvent) MapClientEventToSimEvent = nullptr;
+    decltype(&::SimConnect_TransmitClientEvent) TransmitClientEvent = nullptr;
+    decltype(&::SimConnect_SubscribeToSystemEvent) SubscribeToSystemEvent = nullptr;
+    decltype(&::SimConnect_MapClientDataNameToID) MapClientDataNameToID = nullptr;
+    decltype(&::SimConnect_AddToClientDataDefinition) AddToClientDataDefinition = nullptr;
+    decltype(&::SimConnect_RequestClientData) RequestClientData = nullptr;
+};
+
+// Client for a simulator's SDK; nullptr if its DLL cannot be loaded
+const SimConnectApi* getSimConnectApi(SimulatorType simType);
+
+#endif // AICOPILOT_HAVE_SIMCONNECT
+
+} // namespace AICopilot
+
+#endif // SIMCONNECT_API_HPP
@@ -37,6 +37,11 @@
 *   } catch (const ConnectionException& e) {
 *       handler.attemptRecovery(e);
 *   }
+*
+*   // From a loop that must not stall (e.g. once per control tick):
+*   if (!handler.pollReconnection(SimulatorType::MSFS2024)) {
+*       // still down; the next attempt is scheduled, nothing slept
+*   }
 *****************************************************************************/
 
 #ifndef SIMCONNECT_ERROR_HANDLER_HPP
@@ -45,6 +50,7 @@
 #include "error_handling.hpp"
 #include "validation_framework.hpp"
 #include "aicopilot_types.h"
+#include "reconnect_backoff.hpp"
 #include <chrono>
 #include <thread>
 #include <atomic>
@@ -102,6 +108,10 @@ private:
     int dataReceiveTimeout_ = 10000;  // milliseconds
     int baseRetryDelay_ = 1000;  // milliseconds
     double backoffMultiplier_ = 1.5;
+    int maxRetryDelay_ = 30000;  // milliseconds
+    
+    // Schedule for pollReconnection(); guarded by stateMutex_
+    ReconnectBackoff backoff_;
 
 public:
     SimConnectErrorHandler(const std::string& logFile = "")
@@ -133,6 +143,9 @@ public:
         dataReceiveTimeout_ = dataTimeout;
         baseRetryDelay_ = baseDelay;
         backoffMultiplier_ = backoff;
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        backoff_.configure(std::chrono::milliseconds(baseRetryDelay_), backoffMultiplier_,
+                           std::chrono::milliseconds(maxRetryDelay_));
     }
 
     /**
@@ -155,75 +168,7 @@ public:
      * Validate aircraft state data received from SimConnect
      */
     ValidationResult validateAircraftStateData(const AircraftState& state) {
-        // Validate coordinates
-        ValidationResult coordResult = CoordinateValidator::validateCoordinatePair(
-            state.position.latitude, state.position.longitude);
-        if (!coordResult.isValid) {
-            return coordResult;
-        }
-
-        // Validate altitude
-        ValidationResult altResult = AltitudeValidator::validateAltitude(
-            state.position.altitude);
-        if (!altResult.isValid) {
-            return altResult;
-        }
-
-        // Validate heading
-        ValidationResult headResult = HeadingValidator::validateHeading(state.heading);
-        if (!headResult.isValid) {
-            return headResult;
-        }
-
-        // Validate airspeeds
-        ValidationResult iasResult = AirspeedValidator::validateIndicatedAirspeed(
-            state.indicatedAirspeed);
-        if (!iasResult.isValid) {
-            return iasResult;
-        }
-
-        ValidationResult tasResult = AirspeedValidator::validateTrueAirspeed(
-            state.trueAirspeed);
-        if (!tasResult.isValid) {
-            return tasResult;
-        }
-
-        // Validate vertical speed
-        ValidationResult vsResult = AltitudeValidator::validateVerticalSpeed(
-            state.verticalSpeed);
-        if (!vsResult.isValid) {
-            return vsResult;
-        }
-
-        // Validate fuel quantity
-        if (state.fuelQuantity < 0.0) {
-            return ValidationResult(false, ErrorCode::AIRCRAFT_FUEL_MISMATCH,
-                "Fuel quantity cannot be negative");
-        }
-
-        // Validate pitch and bank (should not exceed realistic values)
-        if (std::abs(state.pitch) > 90.0) {
-            return ValidationResult(false, ErrorCode::AIRCRAFT_INVALID_STATE,
-                "Pitch angle exceeds physical limits");
-        }
-
-        if (std::abs(state.bank) > 180.0) {
-            return ValidationResult(false, ErrorCode::AIRCRAFT_INVALID_STATE,
-                "Bank angle exceeds physical limits");
-        }
-
-        // Validate electrical system parameters
-        if (state.batteryVoltage < 0.0 || state.batteryVoltage > 50.0) {
-            return ValidationResult(false, ErrorCode::AIRCRAFT_ELECTRICAL_FAILURE,
-                "Invalid battery voltage");
-        }
-
-        if (state.batteryLoad < 0.0 || state.batteryLoad > 500.0) {
-            return ValidationResult(false, ErrorCode::AIRCRAFT_ELECTRICAL_FAILURE,
-                "Invalid battery load");
-        }
-
-        return ValidationResult(true, ErrorCode::UNKNOWN_ERROR, "Valid aircraft state");
+        return AircraftStateValidator::validateAircraftState(state);
     }
 
     /**
@@ -285,8 +230,13 @@ public:
 
     /**
      * Attempt connection with exponential backoff
+     *
+     * Sleeps in the caller's thread between attempts; a loop that must
+     * keep running uses pollReconnection() instead.
      */
     bool attemptConnectionWithBackoff(SimulatorType simType) {
+        ReconnectBackoff schedule(std::chrono::milliseconds(baseRetryDelay_), backoffMultiplier_,
+                                  std::chrono::milliseconds(maxRetryDelay_));
         for (int attempt = 0; attempt < maxReconnectAttempts_; attempt++) {
             try {
                 if (attemptConnection(simType)) {
@@ -300,12 +250,8 @@ public:
                 metrics_.reconnectAttempts++;
 
                 if (attempt < maxReconnectAttempts_ - 1) {
-                    // Calculate backoff delay: delay * (multiplier ^ attempt)
-                    int delayMs = static_cast<int>(
-                        baseRetryDelay_ * std::pow(backoffMultiplier_, attempt)
-                    );
-
-                    std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+                    // delay * (multiplier ^ attempt)
+                    std::this_thread::sleep_for(schedule.recordFailure(ReconnectBackoff::Clock::now()));
                 }
             }
         }
@@ -320,6 +266,45 @@ public:
         );
     }
 
+    /**
+     * One reconnection step, without blocking
+     *
+     * Tries to connect only when the backoff says an attempt is due and
+     * returns at once otherwise, so the caller's loop keeps idling
+     * through the delay. Attempts are not capped: a restarting sim is
+     * retried at the longest delay until it returns. True once connected.
+     */
+    bool pollReconnection(SimulatorType simType,
+                          ReconnectBackoff::Clock::time_point now = ReconnectBackoff::Clock::now()) {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            if (state_ == ConnectionState::CONNECTED) return true;
+            if (!backoff_.due(now)) return false;
+        }
+        try {
+            if (attemptConnection(simType)) {
+                std::lock_guard<std::mutex> lock(stateMutex_);
+                backoff_.reset();
+                return true;
+            }
+        } catch (const SimConnectException& e) {
+            logger_.logWarning(e.getErrorCode(), "Reconnection attempt failed, retrying later");
+        }
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        metrics_.reconnectAttempts++;
+        backoff_.recordFailure(now);
+        state_ = ConnectionState::RECONNECTING;
+        return false;
+    }
+
+    /**
+     * When pollReconnection() will next try
+     */
+    ReconnectBackoff::Clock::time_point getNextReconnectAttempt() const {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        return backoff_.nextAttempt();
+    }
+
     /**
      * Handle data reception with timeout detection
      */
@@ -347,20 +332,20 @@ public:
             metrics_.consecutiveTimeouts = 0;
         }
 
-        // Validate received data
-        ValidationResult result = validateAircraftStateData(state);
-        if (!result.isValid) {
+        // Validate received data; the message is only built for bad samples
+        ValidationCheck check = AircraftStateValidator::checkAircraftState(state);
+        if (!check) {
             metrics_.totalDataErrors++;
 
-            logger_.logWarning(result.errorCode, 
-                "Invalid aircraft state data received: " + result.message);
+            logger_.logWarning(check.errorCode, 
+                "Invalid aircraft state data received: " + describe(check).message);
 
             // Don't throw - log and continue with data
             // This is graceful degradation
         }
 
         metrics_.lastDataReceived = now;
-        return result.isValid;
+        return check.ok();
     }
 
     /**
@@ -370,6 +355,7 @@ public:
         {
             std::lock_guard<std::mutex> lock(stateMutex_);
             state_ = ConnectionState::CONNECTION_LOST;
+            backoff_.start(ReconnectBackoff::Clock::now());
         }
 
         logger_.logError(ErrorCode::SIMCONNECT_CONNECTION_LOST,
@@ -0,0 +1,189 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* SimConnect Recording - capture and replay of raw SimConnect message streams
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef SIMCONNECT_RECORDING_HPP
+#define SIMCONNECT_RECORDING_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * Capture file format (host byte order, little-endian on Windows targets)
+ *
+ * File header:
+ *   char     magic[8]     "AICPSCAP"
+ *   uint32_t version      CAPTURE_VERSION
+ *   uint32_t reserved     0
+ *
+ * Followed by records until end of file:
+ *   uint64_t timestampUs  microseconds since recording started
+ *   uint32_t size         payload bytes (the SIMCONNECT_RECV cbData)
+ *   uint8_t  payload[size]
+ *
+ * Payloads are the untouched SIMCONNECT_RECV blocks handed to the dispatch
+ * callback, so a replay drives exactly the same decode path as a live sim.
+ */
+struct SimConnectCaptureFormat {
+    static constexpr char MAGIC[8] = {'A', 'I', 'C', 'P', 'S', 'C', 'A', 'P'};
+    static constexpr uint32_t CAPTURE_VERSION = 1;
+    static constexpr uint32_t MAX_RECORD_SIZE = 1u << 20;  // sanity bound for corrupt files
+    
+    // SIMCONNECT_RECV_ID_SIMOBJECT_DATA and the wrapper's DATA_REQUEST_ID
+    // values, for backends that synthesize records without the SDK
+    static constexpr uint32_t RECV_ID_SIMOBJECT_DATA = 8;
+    static constexpr uint32_t REQUEST_FLIGHT_DYNAMICS = 0;
+    static constexpr uint32_t REQUEST_SYSTEMS_STATE = 1;
+    static constexpr uint32_t REQUEST_AUTOPILOT_STATE = 2;
+    static constexpr uint32_t REQUEST_ENGINE_STATE = 4;
+};
+
+// Record payload layouts for the user aircraft state tiers, shared by the
+// SimConnect decode path and synthesized captures
+#pragma pack(push, 1)
+
+// Leading fields of SIMCONNECT_RECV_SIMOBJECT_DATA; the tier data follows
+struct SimConnectObjectDataHeader {
+    uint32_t size;              // dwSize
+    uint32_t version;           // dwVersion
+    uint32_t id;                // dwID (RECV_ID_SIMOBJECT_DATA)
+    uint32_t requestId;         // dwRequestID
+    uint32_t objectId;          // dwObjectID
+    uint32_t defineId;          // dwDefineID
+    uint32_t flags;             // dwFlags; 0 for an untagged full struct
+    uint32_t entryNumber;       // dwentrynumber
+    uint32_t outOf;             // dwoutof
+    uint32_t defineCount;       // dwDefineCount
+};
+
+struct SimConnectFlightData {
+    double latitude;
+    double longitude;
+    double altitude;
+    double heading;
+    double pitch;
+    double bank;
+    double indicatedAirspeed;
+    double trueAirspeed;
+    double groundSpeed;
+    double verticalSpeed;
+    uint32_t onGround;
+};
+
+struct SimConnectSystemsData {
+    double altimeter;
+    uint32_t parkingBrakeSet;
+    uint32_t gearDown;
+    double flapsPosition;
+    
+    // Electrical system data
+    uint32_t masterBattery;
+    uint32_t masterAlternator;
+    double batteryVoltage;
+    double batteryLoad;
+    double generatorVoltage;
+    double generatorLoad;
+};
+
+struct SimConnectEngineData {
+    double fuelQuantity;
+    double engineRPM;
+};
+
+struct SimConnectAutopilotState {
+    uint32_t masterEnabled;
+    uint32_t headingHold;
+    uint32_t altitudeHold;
+    uint32_t airspeedHold;
+    uint32_t navMode;
+    uint32_t approachMode;
+    uint32_t autoThrottle;
+    uint32_t verticalSpeedHold;
+    double targetHeading;
+    double targetAltitude;
+    double targetAirspeed;
+    double targetVerticalSpeed;
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(SimConnectObjectDataHeader) == 40, "SimConnectObjectDataHeader layout");
+
+/**
+ * Writes timestamped SimConnect messages to a capture file
+ */
+class SimConnectRecorder {
+public:
+    SimConnectRecorder() = default;
+    ~SimConnectRecorder() { close(); }
+
+    SimConnectRecorder(const SimConnectRecorder&) = delete;
+    SimConnectRecorder& operator=(const SimConnectRecorder&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file_.is_open(); }
+
+    bool write(uint64_t timestampUs, const void* data, uint32_t size);
+
+    uint64_t getRecordCount() const { return recordCount_; }
+
+private:
+    std::ofstream file_;
+    uint64_t recordCount_ = 0;
+};
+
+/**
+ * Reads a capture file one record at a time
+ *
+ * The current record stays valid until the next call to next(); its
+ * storage is reused, so reading a capture does not allocate per record.
+ */
+class SimConnectCaptureReader {
+public:
+    SimConnectCaptureReader() = default;
+
+    SimConnectCaptureReader(const SimConnectCaptureReader&) = delete;
+    SimConnectCaptureReader& operator=(const SimConnectCaptureReader&) = delete;
+
+    // Opens the file, validates the header and loads the first record
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file_.is_open(); }
+
+    // True while a record is loaded
+    bool hasRecord() const { return hasRecord_; }
+
+    // Advance to the next record; false at end of file or on a corrupt record
+    bool next();
+
+    uint64_t timestampUs() const { return timestampUs_; }
+    const uint8_t* data() const { return buffer_.data(); }
+    uint8_t* data() { return buffer_.data(); }
+    uint32_t size() const { return size_; }
+
+    uint64_t getRecordCount() const { return recordCount_; }
+
+private:
+    std::ifstream file_;
+    std::vector<uint8_t> buffer_;
+    uint64_t timestampUs_ = 0;
+    uint32_t size_ = 0;
+    uint64_t recordCount_ = 0;
+    bool hasRecord_ = false;
+};
+
+} // namespace AICopilot
+
+#endif // SIMCONNECT_RECORDING_HPP
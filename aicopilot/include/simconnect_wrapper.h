@@ -11,75 +11,192 @@
 #define SIMCONNECT_WRAPPER_H
 
 #include "aicopilot_types.h"
+#include "aircraft_state_core.hpp"
+#include "traffic_table.hpp"
+#include "atc_text_ring.hpp"
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
 
 namespace AICopilot {
 
+/**
+ * Periodic state delivery settings
+ * Aircraft and autopilot state are streamed by subscription only; the
+ * getters read the cached snapshot and never issue their own requests.
+ * State is split into rate tiers, each with its own period and interval.
+ */
+struct DataSubscriptionConfig {
+    enum class Period {
+        VISUAL_FRAME,
+        SIM_FRAME,
+        SECOND
+    };
+    
+    struct Tier {
+        Period period;
+        int interval;  // Periods to skip between deliveries
+    };
+    
+    Tier flightDynamics{Period::SIM_FRAME, 0};  // Position, attitude, speeds
+    Tier systems{Period::SIM_FRAME, 7};         // ~4 Hz: gear, flaps, electrical, autopilot
+    Tier engineHealth{Period::SECOND, 0};       // ~1 Hz: fuel, engine RPM
+    
+    bool changedOnly = true;   // SIMCONNECT_DATA_REQUEST_FLAG_CHANGED
+    bool tagged = false;       // SIMCONNECT_DATA_REQUEST_FLAG_TAGGED (only changed datums sent)
+    
+    // AI/multiplayer traffic radius sweep (SimConnect_RequestDataOnSimObjectType)
+    bool traffic = false;
+    unsigned int trafficRadiusMeters = 74080;  // 40 nm; SimConnect caps this at 200 km
+    int trafficIntervalMs = 1000;              // Time between sweeps
+};
+
+/**
+ * Capture replay pacing
+ * WALL_CLOCK reproduces the recorded message timing. AS_FAST_AS_POSSIBLE
+ * advances capture time by one replay step per processMessages() call, so
+ * a control loop runs unthrottled and sees the same inputs on every run.
+ */
+enum class ReplayPacing {
+    WALL_CLOCK,
+    AS_FAST_AS_POSSIBLE
+};
+
 /**
  * Wrapper class for SimConnect API to interface with MSFS2024 and Prepar3D V6
  * Provides abstraction layer for simulator communication
+ * The public interface is virtual so other backends (HeadlessSimConnect,
+ * test mocks) can stand in for a simulator behind the same pointer.
  */
 class SimConnectWrapper {
 public:
     SimConnectWrapper();
-    ~SimConnectWrapper();
+    virtual ~SimConnectWrapper();
 
     // Connection management
-    bool connect(SimulatorType simType, const std::string& appName = "AICopilot");
-    void disconnect();
-    bool isConnected() const;
+    virtual bool connect(SimulatorType simType, const std::string& appName = "AICopilot");
+    virtual void disconnect();
+    virtual bool isConnected() const;
+    
+    // Connect to a recorded capture instead of a running simulator
+    // Control outputs are accepted and batched but never transmitted.
+    virtual bool connectReplay(const std::string& capturePath, ReplayPacing pacing = ReplayPacing::WALL_CLOCK);
+    virtual bool isReplaying() const;
+    virtual void setReplayStep(double seconds);   // capture time per processMessages() (AS_FAST_AS_POSSIBLE)
+    virtual double getReplayTime() const;         // capture seconds dispatched so far
+    
+    // Capture every message received by the dispatch path to a file
+    virtual bool startRecording(const std::string& capturePath);
+    virtual void stopRecording();
+    virtual bool isRecording() const;
     
     // Process SimConnect messages
-    void processMessages();
+    // No-op while the dispatch thread is running.
+    virtual void processMessages();
+
+    // Event-driven dispatch thread
+    // Waits on the SimConnect event handle and publishes every received
+    // state into a lock-free snapshot. Subscription callbacks are invoked
+    // on the dispatch thread while it is running.
+    virtual bool startDispatchThread();
+    virtual void stopDispatchThread();
+    virtual bool isDispatchThreadRunning() const;
+    
+    // Reconnection after the sim goes away (enabled by default)
+    // The thread pumping messages - the dispatch thread, else
+    // processMessages() - retries with exponential backoff between its
+    // ordinary waits and never sleeps for it. The state snapshot, traffic,
+    // subscription config and callbacks are kept warm; on return the data
+    // definitions and requests are registered again in one pass.
+    // isConnected() is false until then.
+    virtual void setAutoReconnect(bool enabled);
+    virtual bool isReconnecting() const;
+    virtual uint32_t getReconnectCount() const;   // successful reconnections
     
-    // Aircraft state queries
-    AircraftState getAircraftState();
-    AutopilotState getAutopilotState();
-    Position getPosition();
+    // SimConnect.cfg entry to open on connect() (0: the local sim), so one
+    // process can hold sessions to several instances or remote hosts.
+    // Each wrapper is one session with its own handle and dispatch thread;
+    // the SDK client follows the SimulatorType passed to connect().
+    virtual void setConfigIndex(int index);
+    virtual int getConfigIndex() const;
+
+    // Aircraft state queries (lock-free snapshot reads)
+    virtual AircraftState getAircraftState();
+    virtual AutopilotState getAutopilotState();
+    virtual Position getPosition();
+    
+    // Hot/cold halves of the state, each with the version it was read at.
+    // Versions advance only when the half changes; 0 means unversioned,
+    // so consumers compare against the version they last read and skip
+    // the read when it has not moved.
+    virtual AircraftStateCore getAircraftStateCore(uint64_t& version);
+    virtual AircraftStateCold getAircraftStateCold(uint64_t& version);
+    virtual uint64_t getStateVersion() const;       // core
+    virtual uint64_t getColdStateVersion() const;
+    
+    // Subscription period/flags (re-requested immediately when connected)
+    virtual void setDataSubscription(const DataSubscriptionConfig& config);
+    virtual DataSubscriptionConfig getDataSubscription() const;
+    
+    // Traffic within the subscription radius, excluding the user aircraft
+    // Copies into the caller's table, reusing its storage; returns the row count.
+    virtual size_t getTrafficTable(TrafficTable& out) const;
     
     // Aircraft control
-    void setAutopilotMaster(bool enabled);
-    void setAutopilotHeading(double heading);
-    void setAutopilotAltitude(double altitude);
-    void setAutopilotSpeed(double speed);
-    void setAutopilotVerticalSpeed(double verticalSpeed);
-    void setAutopilotNav(bool enabled);
-    void setAutopilotApproach(bool enabled);
+    virtual void setAutopilotMaster(bool enabled);
+    virtual void setAutopilotHeading(double heading);
+    virtual void setAutopilotAltitude(double altitude);
+    virtual void setAutopilotSpeed(double speed);
+    virtual void setAutopilotVerticalSpeed(double verticalSpeed);
+    virtual void setAutopilotNav(bool enabled);
+    virtual void setAutopilotApproach(bool enabled);
+    
+    // Batched control output
+    // While enabled, throttle/surface/autopilot-target setters are coalesced
+    // per tick (with deadband) and sent as one SetDataOnSimObject call by
+    // flushCommands(), which should run once per control cycle.
+    virtual void setCommandBatching(bool enabled);
+    virtual bool isCommandBatchingEnabled() const;
+    virtual void flushCommands();
     
     // Flight controls
-    void setThrottle(double value);      // 0.0 to 1.0
-    void setElevator(double value);      // -1.0 to 1.0
-    void setAileron(double value);       // -1.0 to 1.0
-    void setRudder(double value);        // -1.0 to 1.0
-    void setFlaps(int position);         // 0 to 100%
-    void setGear(bool down);
-    void setSpoilers(bool deployed);
-    void setParkingBrake(bool set);
-    void setBrakes(double value);        // 0.0 to 1.0
+    virtual void setThrottle(double value);       // 0.0 to 1.0
+    virtual void setElevator(double value);       // -1.0 to 1.0
+    virtual void setAileron(double value);        // -1.0 to 1.0
+    virtual void setRudder(double value);         // -1.0 to 1.0
+    virtual void setFlaps(int position);          // 0 to 100%
+    virtual void setGear(bool down);
+    virtual void setSpoilers(bool deployed);
+    virtual void setParkingBrake(bool set);
+    virtual void setBrakes(double value);         // 0.0 to 1.0
     
     // Engine controls
-    void setMixture(double value);       // 0.0 to 1.0
-    void setPropellerPitch(double value); // 0.0 to 1.0
-    void setMagnetos(int position);      // 0=off, 1=right, 2=left, 3=both
-    void toggleEngineStarter(int engineIndex);
-    void setEngineState(int engineIndex, bool running);
+    virtual void setMixture(double value);        // 0.0 to 1.0
+    virtual void setPropellerPitch(double value); // 0.0 to 1.0
+    virtual void setMagnetos(int position);       // 0=off, 1=right, 2=left, 3=both
+    virtual void toggleEngineStarter(int engineIndex);
+    virtual void setEngineState(int engineIndex, bool running);
     
     // Lighting controls
-    void setLight(const std::string& lightName, bool on);
+    virtual void setLight(const std::string& lightName, bool on);
     
     // ATC interaction
-    void sendATCMenuSelection(int menuIndex);
-    void requestATCMenu();
-    std::vector<std::string> getATCMenuOptions();
+    virtual void sendATCMenuSelection(int menuIndex);
+    virtual void requestATCMenu();
+    virtual std::vector<std::string> getATCMenuOptions();  // options of the latest transmission
     
     // Data subscription callbacks
     using StateCallback = std::function<void(const AircraftState&)>;
     using ATCCallback = std::function<void(const ATCMessage&)>;
+    using ATCTextCallback = std::function<void(const ATCTextView&)>;
+    
+    virtual void subscribeToAircraftState(StateCallback callback);
+    virtual void subscribeToATCMessages(ATCCallback callback);
     
-    void subscribeToAircraftState(StateCallback callback);
-    void subscribeToATCMessages(ATCCallback callback);
+    // Allocation-free ATC text delivery; views are valid for the duration
+    // of the callback (copy anything that must outlive it)
+    virtual void subscribeToATCText(ATCTextCallback callback);
     
 private:
     class Impl;
@@ -18,11 +18,15 @@
 #ifndef SPEECH_RECOGNIZER_HPP
 #define SPEECH_RECOGNIZER_HPP
 
+#include "flight_phase_table.hpp"
+#include "voice_latency.hpp"
+#include <array>
 #include <string>
 #include <vector>
 #include <map>
 #include <memory>
 #include <cstdint>
+#include <unordered_map>
 
 namespace AICopilot {
 
@@ -44,6 +48,12 @@ struct RecognitionResult {
     std::string interpretation;
 };
 
+// Streaming recognition after one partial hypothesis
+struct PartialRecognition {
+    RecognitionResult result;   // Best command so far, UNKNOWN if none
+    bool committed = false;     // No further words can change the command
+};
+
 // Command definition
 struct CommandDefinition {
     std::string command_id;
@@ -51,6 +61,7 @@ struct CommandDefinition {
     std::vector<std::string> variations;  // Alternative phrasings
     std::map<std::string, std::string> parameters;
     bool requires_confirmation;
+    uint32_t active_phases = 0;           // bit per FlightPhase; 0 follows the category
 };
 
 // Voice command categories
@@ -63,6 +74,47 @@ enum class CommandCategory {
     UNKNOWN
 };
 
+constexpr size_t COMMAND_CATEGORY_COUNT = static_cast<size_t>(CommandCategory::UNKNOWN) + 1;
+
+constexpr uint32_t flightPhaseBit(FlightPhase phase) {
+    return 1u << static_cast<unsigned>(phase);
+}
+
+/**
+ * EditDistancePattern - Levenshtein distance against one fixed pattern
+ *
+ * The pattern is compiled once into per-character match masks, so each
+ * distance() is Myers' bit-parallel algorithm: one pass over the text
+ * with a few word operations per character for patterns up to 64
+ * characters, with a banded row-by-row fallback beyond that. Both stop as
+ * soon as the distance must exceed max_distance.
+ */
+class EditDistancePattern {
+public:
+    static constexpr size_t MAX_BIT_PARALLEL = 64;
+    
+    explicit EditDistancePattern(const std::string& pattern);
+    
+    size_t length() const { return pattern_.length(); }
+    const std::string& text() const { return pattern_; }
+    
+    /**
+     * Distance to text, or max_distance + 1 once it is known to be larger
+     */
+    int distance(const std::string& text, int max_distance) const;
+    
+private:
+    // Normalized text is [a-z0-9 ]; anything else shares the last slot
+    static constexpr size_t ALPHABET = 38;
+    static size_t symbol(unsigned char c);
+    
+    int bandedDistance(const std::string& text, int max_distance) const;
+    
+    std::string pattern_;
+    std::array<uint64_t, ALPHABET> match_masks_{};
+    bool bit_parallel_;                     // short and within the alphabet
+};
+
 /**
  * PhoneticMatcher - Matches spoken text to known commands
  */
@@ -93,6 +145,12 @@ public:
      */
     std::string applyPhoneticCorrections(const std::string& text) const;
     
+    /**
+     * Metaphone-style key of one lowercase word: words that sound alike
+     * ("flight", "flite") share a key
+     */
+    static std::string phoneticKey(const std::string& word);
+    
 private:
     // Phonetic mappings for common speech variations
     std::map<std::string, std::string> phonetic_replacements_;
@@ -123,6 +181,34 @@ public:
      */
     RecognitionResult recognize(const std::string& spoken_text);
     
+    /**
+     * Streaming recognition of one utterance from a speech-to-text
+     * engine's partial hypotheses, each the whole utterance so far. Words
+     * shared with the previous hypothesis are not matched again. The
+     * result commits as soon as no continuation of what was heard can
+     * lead to another command ("gear down" commits on "down"); parameters
+     * may still follow. endUtterance() returns the committed result or
+     * recognizes the final text. Statistics count each utterance once.
+     */
+    void beginUtterance();
+    PartialRecognition updateUtterance(const std::string& partial_text);
+    RecognitionResult endUtterance(const std::string& final_text);
+    
+    /**
+     * Restrict recognition to the commands live in a flight phase. Each
+     * phase has its own precompiled grammar, so switching is O(1); an
+     * utterance in progress restarts. FlightPhase::UNKNOWN, the default,
+     * recognizes every command. Wire to AIPilot with
+     * setPhaseTransitionObserver().
+     */
+    void setFlightPhase(FlightPhase phase);
+    FlightPhase getFlightPhase() const { return static_cast<FlightPhase>(active_grammar_); }
+    
+    /**
+     * Whether a command is in a phase's grammar
+     */
+    bool isCommandActive(const std::string& command_id, FlightPhase phase) const;
+    
     /**
      * Get command by ID
      */
@@ -160,10 +246,83 @@ public:
     RecognitionStats getStatistics() const;
     
 private:
+    /*
+     * Compiled phrase index. Every variation is split into words; each
+     * distinct word is compiled once into the vocabulary with its phonetic
+     * key and edit-distance pattern, and the variations form a trie over
+     * word ids. recognize() matches each spoken word against the
+     * vocabulary, then walks the trie from the first spoken word, so a
+     * variation matches the start of the utterance and the words after it
+     * (altitudes, waypoints) do not count against it.
+     *
+     * There is one grammar per flight phase: a trie over the commands live
+     * in that phase and the word indexes matchWord() searches, all sharing
+     * the one vocabulary. Only the active grammar is searched.
+     */
+    struct VocabularyWord {
+        EditDistancePattern pattern;
+        std::string phonetic_key;
+    };
+    
+    struct PhraseNode {
+        std::map<uint32_t, uint32_t> children;  // word id -> node
+        std::string command_id;                 // non-empty where a variation ends
+        std::string subtree_command;            // the one command reachable from here
+        bool subtree_ambiguous = false;         // more than one is
+    };
+    
+    // A spoken word's match to one vocabulary word
+    struct WordMatch {
+        uint32_t word;
+        int distance;
+        int length;                             // longer of the two words
+    };
+    
+    // A partial match of the utterance's first words to a trie node
+    struct PhrasePath {
+        uint32_t node;
+        int distance;
+        int length;
+        int last_distance;                      // of the newest word
+    };
+    
+    struct PhraseMatch {
+        std::string command;
+        double confidence = 0.0;
+        size_t words = 0;
+        int last_distance = 0;
+    };
+    
+    struct Grammar {
+        std::vector<PhraseNode> trie{1};                              // [0] is the root
+        std::vector<bool> has_word;                                   // by word id
+        std::unordered_multimap<std::string, uint32_t> phonetic_index;    // key -> word ids
+        std::vector<std::vector<uint32_t>> words_by_length;               // length -> word ids
+    };
+    
+    struct UtteranceState {
+        bool active = false;
+        bool committed = false;
+        std::vector<std::string> words;                 // of the last hypothesis
+        std::vector<std::vector<PhrasePath>> frontiers; // [i]: paths through the first i words
+        std::vector<PhraseMatch> best;                  // [i]: best phrase within the first i words
+        RecognitionResult result;                       // once committed
+    };
+    
+    // Words match if at most half their characters differ
+    static constexpr double MIN_WORD_SIMILARITY = 0.5;
+    
     std::map<std::string, CommandDefinition> commands_;
     std::unique_ptr<PhoneticMatcher> phonetic_matcher_;
     double confidence_threshold_;
     
+    std::vector<VocabularyWord> vocabulary_;
+    std::unordered_map<std::string, uint32_t> word_ids_;
+    std::array<Grammar, FLIGHT_PHASE_COUNT> grammars_;     // indexed by FlightPhase
+    size_t active_grammar_;
+    std::array<std::vector<std::string>, COMMAND_CATEGORY_COUNT> category_commands_;   // sorted ids
+    UtteranceState utterance_;
+    
     RecognitionStats statistics_;
     std::map<std::string, uint32_t> command_usage_count_;
     
@@ -174,6 +333,23 @@ private:
     void initializeStatusQueryCommands();
     void initializeEmergencyCommands();
     
+    // Phrase index
+    const Grammar& activeGrammar() const { return grammars_[active_grammar_]; }
+    uint32_t activePhases(const CommandDefinition& command) const;
+    void indexCommand(const CommandDefinition& command);
+    void indexCommand(Grammar& grammar, const CommandDefinition& command,
+                      const std::vector<std::vector<uint32_t>>& variation_words);
+    void rebuildPhraseIndex();
+    uint32_t internWord(const std::string& word);
+    void matchWord(const std::string& spoken, std::vector<WordMatch>& matches) const;
+    void extendPaths(const std::vector<PhrasePath>& paths, size_t words_before,
+                     const std::vector<WordMatch>& matches,
+                     std::vector<PhrasePath>& next, PhraseMatch& best) const;
+    bool leadsOnlyTo(uint32_t node, const std::string& command_id) const;
+    bool isUtteranceUnambiguous() const;
+    RecognitionResult makeResult(const std::string& raw_text, const PhraseMatch& match) const;
+    void recordRecognition(const RecognitionResult& result);
+    
     // Helper methods
     CommandCategory determineCategory(const std::string& command_id) const;
     double calculateFinalConfidence(double base_confidence, 
@@ -269,6 +445,14 @@ public:
      */
     RecognitionResult recognizeText(const std::string& text);
     
+    /**
+     * Streaming recognition from partial STT hypotheses; see
+     * CommandRecognizer::updateUtterance()
+     */
+    void beginUtterance();
+    PartialRecognition recognizePartialText(const std::string& partial_text);
+    RecognitionResult endUtterance(const std::string& final_text);
+    
     /**
      * Get last recognition result
      */
@@ -304,12 +488,23 @@ public:
      */
     void setConfidenceThreshold(double threshold);
     
+    /**
+     * Switch the active command grammar; see CommandRecognizer::setFlightPhase()
+     */
+    void setFlightPhase(FlightPhase phase);
+    
+    /**
+     * Mark each final recognition result on a latency tracer
+     */
+    void setLatencyTracer(std::shared_ptr<VoiceLatencyTracer> tracer) { latency_tracer_ = std::move(tracer); }
+    
 private:
     std::unique_ptr<CommandRecognizer> command_recognizer_;
     std::unique_ptr<ParameterExtractor> parameter_extractor_;
     
     RecognitionResult last_result_;
     std::string current_environment_;
+    std::shared_ptr<VoiceLatencyTracer> latency_tracer_;
 };
 
 } // namespace AICopilot
@@ -15,13 +15,38 @@
 
 #include <string>
 #include <vector>
+#include <atomic>
 #include <cstdint>
-#include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <unordered_set>
+#include "tile_cache.hpp"
 
 namespace AICopilot {
 
+/**
+ * How SRTMLoader brings tiles into memory
+ */
+enum class SRTMTileMode {
+    COPY,     ///< Read and byte-swap the whole file into a private buffer
+    MAPPED    ///< Memory-map the file; samples are converted on access
+};
+
+/**
+ * Lowest and highest valid sample in an area (meters)
+ */
+struct SRTMElevationRange {
+    int16_t min_m = 32767;       ///< Lowest non-void sample
+    int16_t max_m = -32768;      ///< Highest non-void sample (VOID_VALUE if none)
+    
+    bool IsValid() const { return min_m <= max_m; }
+    void Merge(const SRTMElevationRange& other) {
+        if (other.min_m < min_m) min_m = other.min_m;
+        if (other.max_m > max_m) max_m = other.max_m;
+    }
+};
+
 /**
  * SRTM Data Format Specifications
  * 
@@ -38,6 +63,8 @@ namespace AICopilot {
  * - Right column: easternmost longitude (1° east of left)
  * 
  * File size: 3601 * 3601 * 2 bytes = 25,934,402 bytes (25.8 MB)
+ * 
+ * SRTM3 (3 arc-second) tiles use the same layout with 1201 x 1201 samples.
  */
 class SRTMTile {
 public:
@@ -46,6 +73,9 @@ public:
     static constexpr double SRTM_RESOLUTION = 1.0 / 3600.0;   ///< 1 arc-second resolution
     static constexpr int TILE_SIZE_BYTES = 25934402;          ///< Uncompressed file size
     static constexpr int TILE_SIZE_COMPRESSED = 15000000;     ///< Typical compressed size
+    static constexpr int SRTM3_SIZE = 1201;                   ///< 3 arc-second tiles
+    static constexpr int SRTM3_TILE_SIZE_BYTES = 2884802;     ///< 1201 * 1201 * 2
+    static constexpr int PYRAMID_BLOCK = 16;                  ///< Samples per side of a pyramid leaf
     
     /// Missing data value in SRTM files
     static constexpr int16_t VOID_VALUE = -32768;
@@ -62,6 +92,15 @@ public:
      */
     SRTMTile(int latitude, int longitude);
     
+    /**
+     * Destructor - releases any file mapping
+     */
+    ~SRTMTile();
+    
+    // A tile may own a file mapping
+    SRTMTile(const SRTMTile&) = delete;
+    SRTMTile& operator=(const SRTMTile&) = delete;
+    
     /**
      * Get tile filename from coordinates
      * @param latitude Tile latitude
@@ -86,6 +125,15 @@ public:
      */
     bool LoadFromFile(const std::string& filepath);
     
+    /**
+     * Map tile file read-only instead of reading it
+     * The samples stay in the page cache and are byte-swapped on access,
+     * so mapping a tile costs O(1) regardless of its size.
+     * @param filepath Full path to HGT file
+     * @return true if mapped successfully
+     */
+    bool MapFile(const std::string& filepath);
+    
     /**
      * Load tile from compressed file (gzip)
      * @param filepath Full path to HGT.zip or HGT.gz file
@@ -103,6 +151,18 @@ public:
      */
     double GetElevation(double row, double col) const;
     
+    /**
+     * Batched GetElevation for many fractional row/column pairs
+     * One tight loop with no per-sample branching; bit-identical to
+     * calling GetElevation for each pair.
+     * 
+     * @param rows Fractional rows
+     * @param cols Fractional columns
+     * @param count Number of samples
+     * @param out_m Output elevations in meters (count entries)
+     */
+    void GetElevations(const double* rows, const double* cols, size_t count, double* out_m) const;
+    
     /**
      * Get raw elevation value at integer row/column
      * @param row Row index (0 to 3600)
@@ -130,11 +190,54 @@ public:
     int GetLongitude() const { return tile_lon_; }
     
     /**
-     * Get memory usage
+     * Get samples per row/column (3601 for SRTM1, 1201 for SRTM3)
+     */
+    int GetSamplesPerSide() const { return samples_; }
+    
+    /**
+     * Check if tile is backed by a file mapping
+     */
+    bool IsMapped() const { return mapped_data_ != nullptr; }
+    
+    /**
+     * Get private memory usage (mapped tiles live in the page cache)
      * @return Size in bytes
      */
     size_t GetMemoryUsage() const { return data_.size() * sizeof(int16_t); }
     
+    /**
+     * Get size of the file mapping
+     * @return Size in bytes (0 if not mapped)
+     */
+    size_t GetMappedSize() const { return mapped_size_; }
+    
+    /**
+     * Get lowest and highest samples in an inclusive row/column rectangle
+     * Answered from a min/max pyramid (quadtree over PYRAMID_BLOCK leaves),
+     * so cost grows with the rectangle's perimeter, not its area. The
+     * result is conservative: whole leaf blocks are counted, so samples up
+     * to PYRAMID_BLOCK - 1 outside the rectangle may widen the range.
+     * The pyramid is built on first use (see BuildPyramid).
+     * 
+     * @param row0 First row
+     * @param col0 First column
+     * @param row1 Last row
+     * @param col1 Last column
+     * @return Range in meters (invalid if all void or not loaded)
+     */
+    SRTMElevationRange GetElevationRange(int row0, int col0, int row1, int col1) const;
+    
+    /**
+     * Build the min/max pyramid now instead of on the first range query
+     * Touches every sample once; safe to call from any thread.
+     */
+    void BuildPyramid() const;
+    
+    /**
+     * Check if the min/max pyramid has been built
+     */
+    bool HasPyramid() const { return pyramid_built_.load(std::memory_order_acquire); }
+    
     /**
      * Check if data point is void (missing)
      * @param row Row index
@@ -152,9 +255,38 @@ public:
 private:
     int tile_lat_;                      ///< Tile latitude (floor value)
     int tile_lon_;                      ///< Tile longitude (floor value)
-    std::vector<int16_t> data_;         ///< 3601x3601 elevation samples (big-endian)
+    int samples_;                       ///< Samples per side (3601 or 1201)
+    std::vector<int16_t> data_;         ///< Elevation samples, native byte order (COPY mode)
     bool is_loaded_;                    ///< True if data is loaded
     
+    const uint8_t* mapped_data_;        ///< Big-endian samples in the file mapping (MAPPED mode)
+    size_t mapped_size_;                ///< Mapping size in bytes
+    void* file_handle_;                 ///< Platform file handle (Windows)
+    void* mapping_handle_;              ///< Platform mapping handle (Windows)
+    
+    mutable std::vector<std::vector<SRTMElevationRange>> pyramid_;  ///< Level 0 = leaf blocks
+    mutable std::vector<int> pyramid_dims_;                         ///< Nodes per side per level
+    mutable std::mutex pyramid_mutex_;                              ///< Serializes BuildPyramid
+    mutable std::atomic<bool> pyramid_built_;                       ///< Set once pyramid_ is complete
+    
+    /**
+     * Merge pyramid nodes covering leaf blocks [b0, b1] into range
+     */
+    void QueryPyramid(int level, int node_row, int node_col,
+                      int brow0, int bcol0, int brow1, int bcol1,
+                      SRTMElevationRange& range) const;
+    
+    /**
+     * Release file mapping and loaded samples
+     */
+    void Unload();
+    
+    /**
+     * Samples per side for a tile file size
+     * @return 3601 or 1201, or 0 if the size is not a known HGT size
+     */
+    static int SamplesForFileSize(size_t file_size);
+    
     /**
      * Convert big-endian int16 to native format
      * @param bytes Raw bytes (2 bytes)
@@ -174,21 +306,46 @@ private:
      */
     static double Interpolate(double v00, double v10, double v01, double v11,
                              double fx, double fy);
+    
+    /**
+     * Bilinear kernel shared by the copied and mapped sample layouts
+     * @param fetch Returns the native sample at a flat index
+     */
+    template <typename Fetch>
+    void SampleBilinear(const double* rows, const double* cols, size_t count,
+                        double* out_m, Fetch fetch) const;
 };
 
 /**
  * SRTM Loader - Manages loading and caching of SRTM tiles
+ * 
+ * Thread-safe: disk I/O runs outside the cache lock, so a prefetch thread
+ * can load tiles while the flight loop keeps sampling resident ones.
  */
 class SRTMLoader {
 public:
     /// Maximum tiles to keep in memory
     static constexpr int MAX_CACHED_TILES = 16;
     
+    /// Maximum mapped tiles (address space only; pages are shared and reclaimable)
+    static constexpr int MAX_MAPPED_TILES = 256;
+    
+    /// Default cache budgets in bytes (tiles are charged private + mapped size)
+    static constexpr size_t DEFAULT_COPY_BUDGET =
+        static_cast<size_t>(MAX_CACHED_TILES) * SRTMTile::TILE_SIZE_BYTES;
+    static constexpr size_t DEFAULT_MAPPED_BUDGET =
+        static_cast<size_t>(MAX_MAPPED_TILES) * SRTMTile::TILE_SIZE_BYTES;
+    
+    /// Elevation reported while a tile is still loading (feet, above any SRTM terrain)
+    static constexpr double PENDING_ELEVATION_FT = 29100.0;
+    
     /**
      * Constructor
      * @param srtm_data_path Path to directory containing HGT files
+     * @param mode MAPPED maps tiles, COPY reads them into memory
      */
-    explicit SRTMLoader(const std::string& srtm_data_path);
+    explicit SRTMLoader(const std::string& srtm_data_path,
+                        SRTMTileMode mode = SRTMTileMode::MAPPED);
     
     /**
      * Destructor
@@ -201,10 +358,50 @@ public:
      * 
      * @param latitude Latitude in degrees (-60 to 60 for SRTM1)
      * @param longitude Longitude in degrees (-180 to 180)
-     * @return Elevation in meters MSL, or 0 if data unavailable
+     * @return Elevation in feet MSL, or 0 if data unavailable
      */
     double GetElevation(double latitude, double longitude);
     
+    /**
+     * Get elevations for many points at once
+     * Points are grouped by tile so each tile is looked up (and locked)
+     * once per batch, then interpolated in a single pass.
+     * 
+     * @param points Query points
+     * @param count Number of points
+     * @param out_ft Output elevations in feet MSL (count entries, 0 where unavailable)
+     */
+    void GetElevations(const LatLon* points, size_t count, double* out_ft);
+    
+    /**
+     * Get elevations for many points at once
+     * @param points Query points
+     * @return Elevations in feet MSL, one per point
+     */
+    std::vector<double> GetElevations(const std::vector<LatLon>& points);
+    
+    /**
+     * Get elevation without touching the disk
+     * A tile that is not resident yet reports PENDING_ELEVATION_FT, so
+     * clearance checks fail safe until a prefetch brings it in.
+     * 
+     * @param latitude Latitude in degrees
+     * @param longitude Longitude in degrees
+     * @param elevation_ft Output elevation in feet MSL
+     * @return READY, PENDING (not loaded yet) or NO_DATA (0 ft, no tile exists)
+     */
+    TileLookupStatus TryGetElevation(double latitude, double longitude, double& elevation_ft);
+    
+    /**
+     * Load a tile into the cache if it is not already there
+     * Blocks on disk I/O and builds the tile's min/max pyramid; intended
+     * for a background prefetch thread.
+     * @param latitude Tile latitude
+     * @param longitude Tile longitude
+     * @return true if the tile is resident afterwards
+     */
+    bool PrefetchTile(int latitude, int longitude);
+    
     /**
      * Get elevation profile along a path
      * @param start_lat Starting latitude
@@ -219,6 +416,57 @@ public:
         double end_lat, double end_lon,
         int num_samples = 10);
     
+    /**
+     * Get the highest of the four samples around a point
+     * Never below GetElevation() at the point, so a coarse tile sampled
+     * this way cannot hide terrain that bilinear sampling would show.
+     * 
+     * @return Elevation in feet MSL, or 0 if data unavailable
+     */
+    double GetCellMaxElevation(double latitude, double longitude);
+    
+    /**
+     * Get highest terrain in a latitude/longitude box
+     * Uses each tile's min/max pyramid; conservative by up to one pyramid
+     * block (~480 m for SRTM1) around the box.
+     * 
+     * @return Highest elevation in feet MSL, or 0 if no data
+     */
+    double GetMaxElevation(double min_lat, double min_lon, double max_lat, double max_lon);
+    
+    /**
+     * Get highest terrain within a radius (bounding box of the circle)
+     * @param radius_nm Radius in nautical miles
+     * @return Highest elevation in feet MSL, or 0 if no data
+     */
+    double GetMaxElevationInRadius(double latitude, double longitude, double radius_nm);
+    
+    /**
+     * Get highest terrain in a corridor along a path
+     * @param half_width_nm Corridor half width in nautical miles
+     * @return Highest elevation in feet MSL, or 0 if no data
+     */
+    double GetMaxElevationAlongPath(double start_lat, double start_lon,
+                                    double end_lat, double end_lon,
+                                    double half_width_nm);
+    
+    /**
+     * Get minimum safe altitude (highest terrain within radius plus clearance)
+     * @param radius_nm Radius in nautical miles
+     * @param clearance_ft Clearance above terrain in feet
+     * @return Minimum safe altitude in feet MSL
+     */
+    double GetMinimumSafeAltitude(double latitude, double longitude,
+                                  double radius_nm, double clearance_ft = 1000.0);
+    
+    /**
+     * Check whether a tile exists, loading it if it is not resident
+     * @param latitude Tile latitude
+     * @param longitude Tile longitude
+     * @return true if the tile has a file and is resident afterwards
+     */
+    bool HasTile(int latitude, int longitude);
+    
     /**
      * Check if SRTM data is available for location
      * @param latitude Latitude
@@ -236,7 +484,7 @@ public:
      * Get cache size
      * @return Number of cached tiles
      */
-    int GetCacheSize() const { return tile_cache_.size(); }
+    int GetCacheSize() const;
     
     /**
      * Get cache memory usage
@@ -244,15 +492,40 @@ public:
      */
     size_t GetCacheMemoryUsage() const;
     
+    /**
+     * Set cache byte budget; least recently used tiles are evicted to fit
+     * @param bytes Budget in bytes
+     */
+    void SetCacheBudget(size_t bytes);
+    
+    /**
+     * Get cache hit/miss/eviction counters and occupancy
+     */
+    TileCacheStats GetCacheStats() const;
+    
     /**
      * Get data path
      * @return Path to SRTM data directory
      */
     const std::string& GetDataPath() const { return srtm_data_path_; }
+    
+    /**
+     * Get tile mode
+     */
+    SRTMTileMode GetTileMode() const { return tile_mode_; }
 
 private:
     std::string srtm_data_path_;                    ///< Path to SRTM data directory
-    std::map<std::string, std::shared_ptr<SRTMTile>> tile_cache_;  ///< LRU tile cache
+    SRTMTileMode tile_mode_;                        ///< How tiles are loaded
+    TileCache<SRTMTile> tile_cache_;                ///< LRU tile cache keyed by packed lat/lon
+    std::unordered_set<TileKey> missing_tiles_;     ///< Tiles with no file on disk
+    mutable std::mutex cache_mutex_;                ///< Guards tile_cache_ and missing_tiles_
+    mutable std::atomic<uint64_t> cache_contentions_{0};  ///< Waits for a held cache_mutex_
+    
+    /**
+     * Lock cache_mutex_, counting the acquisition if another thread holds it
+     */
+    std::unique_lock<std::mutex> LockCache() const;
     
     /**
      * Load tile from cache or disk
@@ -263,9 +536,10 @@ private:
     std::shared_ptr<SRTMTile> LoadTile(int latitude, int longitude);
     
     /**
-     * Evict oldest cached tile if needed
+     * Read or map a tile and add it to the cache (called without the lock held)
+     * @return Cached tile, or nullptr if no file exists
      */
-    void EvictOldestTile();
+    std::shared_ptr<SRTMTile> LoadTileFromDisk(int latitude, int longitude);
     
     /**
      * Get tile for a coordinate
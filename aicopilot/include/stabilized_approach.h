@@ -14,6 +14,9 @@
 #define STABILIZED_APPROACH_H
 
 #include "aicopilot_types.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -63,6 +66,77 @@ struct StabilizationCriteria {
     bool fullyStabilized;
 };
 
+/**
+ * Approach parameters sampled into the history, signed
+ */
+enum ApproachParameter : size_t {
+    PARAM_ALTITUDE_DEVIATION,      // feet from target
+    PARAM_SPEED_DEVIATION,         // knots from target
+    PARAM_DESCENT_RATE_DEVIATION,  // fpm, |actual| - |target|
+    PARAM_VERTICAL_SPEED,          // fpm
+    PARAM_GLIDESLOPE_DEVIATION,    // dots
+    PARAM_LOCALIZER_DEVIATION,     // dots
+    PARAM_CONFIGURATION,           // 0 in landing configuration, 1 otherwise
+    APPROACH_PARAMETER_COUNT
+};
+
+using ApproachSample = std::array<double, APPROACH_PARAMETER_COUNT>;
+
+/**
+ * Stabilization limits for one aircraft category
+ *
+ * A criterion holds while its parameter is within +/- its limit.
+ */
+struct StabilizationThresholds {
+    double minStabilizationAltitude;   // feet AGL
+    ApproachSample limits;
+};
+
+/**
+ * Fixed window of approach parameters, binned in time
+ *
+ * Each bin keeps the minimum and maximum of every parameter over
+ * BIN_SECONDS, so the window spans BIN_COUNT * BIN_SECONDS whatever the
+ * update rate. Samples arriving after a gap fill the bins skipped. Window
+ * checks scan at most BIN_COUNT bins per parameter with no branches in the
+ * inner loop; durations are rounded up to whole bins.
+ */
+class ApproachHistory {
+public:
+    static constexpr size_t BIN_COUNT = 64;
+    static constexpr double BIN_SECONDS = 0.25;
+    
+    void record(double time, const ApproachSample& sample);
+    void clear();
+    
+    bool empty() const { return count_ == 0; }
+    size_t size() const { return count_; }
+    
+    // Seconds the history covers, to bin resolution
+    double coveredSeconds() const { return count_ * BIN_SECONDS; }
+    
+    /**
+     * Criteria held over the last `seconds`
+     * @return Bit i set when parameter i stayed within limits[i]; 0 if the
+     *         history is shorter than `seconds`
+     */
+    uint32_t withinFor(const ApproachSample& limits, double seconds) const;
+    
+    // Parameter stayed above (below) the limit over the last `seconds`
+    bool aboveFor(ApproachParameter parameter, double limit, double seconds) const;
+    bool belowFor(ApproachParameter parameter, double limit, double seconds) const;
+    
+private:
+    size_t binsFor(double seconds) const;
+    
+    // Bins oldest to newest end at head_ - 1, modulo BIN_COUNT
+    alignas(32) double min_[APPROACH_PARAMETER_COUNT][BIN_COUNT] = {};
+    alignas(32) double max_[APPROACH_PARAMETER_COUNT][BIN_COUNT] = {};
+    int64_t currentBin_ = 0;
+    size_t head_ = 0;
+    size_t count_ = 0;
+};
+
 /**
  * Go-around trigger condition
  */
@@ -113,7 +187,15 @@ public:
     
     /**
      * Update approach status with current aircraft state
+     * @param time Seconds on the caller's clock; the overload without it
+     *             assumes NOMINAL_UPDATE_INTERVAL since the last update
      */
+    StabilizationCriteria updateApproachStatus(
+        const AircraftState& currentState,
+        const Position& thresholdPosition,
+        double thresholdElevation,
+        double time);
+    
     StabilizationCriteria updateApproachStatus(
         const AircraftState& currentState,
         const Position& thresholdPosition,
@@ -129,8 +211,21 @@ public:
      */
     bool isMinimumlyStabilized(const StabilizationCriteria& criteria) const;
     
+    /**
+     * Check every criterion has held for the last `seconds`
+     */
+    bool isStableFor(double seconds) const;
+    
+    /**
+     * Criteria that have held for the last `seconds`, one bit per ApproachParameter
+     */
+    uint32_t stableCriteriaFor(double seconds) const;
+    
     /**
      * Evaluate go-around triggers
+     *
+     * Once the history covers GO_AROUND_PERSISTENCE, a trigger fires only
+     * if its exceedance lasted that long.
      */
     std::vector<GoAroundTrigger> evaluateGoAroundTriggers(
         const AircraftState& state,
@@ -174,6 +269,12 @@ public:
      */
     void reset();
     
+    const StabilizationThresholds& getThresholds() const { return thresholds_; }
+    const ApproachHistory& getHistory() const { return history_; }
+    
+    static constexpr double NOMINAL_UPDATE_INTERVAL = 1.0 / 30.0;  // seconds
+    static constexpr double GO_AROUND_PERSISTENCE = 1.0;           // seconds
+    
 private:
     std::string aircraftType_;
     double targetAltitude_ = 0.0;
@@ -187,31 +288,21 @@ private:
     static constexpr double STABILIZED_BY_ALTITUDE = 1000.0;  // feet AGL
     static constexpr double STABILIZED_BY_DISTANCE = 2.0;     // nm from threshold
     
-    // Aircraft type specific thresholds
-    double minStabilizationAltitude_;      // feet AGL
-    double allowedAltitudeDeviation_;      // feet
-    double allowedSpeedDeviation_;         // knots
-    double allowedDescentRateDeviation_;   // fpm
-    double allowedGlideslopeDeviation_;    // dots
-    double allowedLocalizerDeviation_;     // dots
+    // Aircraft type specific thresholds, a row of the category table
+    StabilizationThresholds thresholds_;
+    
+    ApproachHistory history_;
+    ApproachSample lastSample_{};
+    double lastUpdateTime_ = 0.0;
     
     // Helper methods
     void updateApproachStage(double heightAboveThreshold);
-    bool validateAltitudeStabilization(const AircraftState& state, 
-                                      double targetAltitude);
-    bool validateSpeedStabilization(const AircraftState& state, 
-                                   double targetSpeed);
-    bool validateDescentRateStabilization(const AircraftState& state, 
-                                         double targetDescentRate);
-    bool validateFlightPathStabilization(const AircraftState& state,
-                                        double glideslopeDeviation);
-    bool validateAircraftConfiguration(const AircraftState& state);
+    
+    // Bit i set when sample[i] is within limits[i]
+    static uint32_t evaluateCriteria(const ApproachSample& sample, const ApproachSample& limits);
     
     // Threshold configuration
     void configureThresholdsForAircraft();
-    void configureSmallAircraftThresholds();
-    void configureTransportCategoryThresholds();
-    void configureHelicopterThresholds();
     
     // Go-around decision logic
     GoAroundTrigger checkAltitudeGoAround(
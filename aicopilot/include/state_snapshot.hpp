@@ -0,0 +1,116 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef STATE_SNAPSHOT_HPP
+#define STATE_SNAPSHOT_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace AICopilot {
+
+/**
+ * Single-writer / multi-reader seqlock snapshot
+ *
+ * The writer (e.g. the SimConnect dispatch thread) publishes a complete
+ * value with store(); readers call load() and never block the writer.
+ * The payload is held in relaxed atomic words so concurrent reads are
+ * race-free; a reader that overlaps a write simply retries.
+ *
+ * T must be trivially copyable and default constructible (AircraftState,
+ * AutopilotState, ...).
+ */
+template<typename T>
+class StateSnapshot {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "StateSnapshot requires a trivially copyable type");
+    static_assert(std::is_default_constructible<T>::value,
+                  "StateSnapshot requires a default constructible type");
+
+public:
+    StateSnapshot() : sequence_(0) {
+        for (auto& word : words_) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    explicit StateSnapshot(const T& initial) : StateSnapshot() {
+        store(initial);
+    }
+
+    StateSnapshot(const StateSnapshot&) = delete;
+    StateSnapshot& operator=(const StateSnapshot&) = delete;
+
+    // Publish a new value (single writer only)
+    void store(const T& value) {
+        std::array<uint64_t, WORD_COUNT> buffer{};
+        std::memcpy(buffer.data(), &value, sizeof(T));
+
+        uint64_t seq = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WORD_COUNT; ++i) {
+            words_[i].store(buffer[i], std::memory_order_relaxed);
+        }
+
+        sequence_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Read the latest complete value (lock-free, retries on torn read)
+    T load() const {
+        uint64_t version = 0;
+        return load(version);
+    }
+
+    // As load(), also reporting which publish the value came from
+    T load(uint64_t& version) const {
+        std::array<uint64_t, WORD_COUNT> buffer{};
+        uint64_t before = 0;
+        uint64_t after = 0;
+
+        do {
+            before = sequence_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < WORD_COUNT; ++i) {
+                buffer[i] = words_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = sequence_.load(std::memory_order_relaxed);
+        } while ((before & 1) != 0 || before != after);
+
+        version = before / 2;
+        return fromWords(buffer);
+    }
+
+    // Number of completed publishes; lets readers detect fresh data cheaply
+    uint64_t version() const {
+        return sequence_.load(std::memory_order_acquire) / 2;
+    }
+
+private:
+    static constexpr size_t WORD_COUNT = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    // std::bit_cast for C++17: T may have default member initializers, so
+    // it is built first and its bytes then overwritten through void*
+    static T fromWords(const std::array<uint64_t, WORD_COUNT>& buffer) {
+        T value{};
+        std::memcpy(static_cast<void*>(&value), buffer.data(), sizeof(T));
+        return value;
+    }
+
+    std::atomic<uint64_t> sequence_;
+    std::array<std::atomic<uint64_t>, WORD_COUNT> words_;
+};
+
+} // namespace AICopilot
+
+#endif // STATE_SNAPSHOT_HPP
@@ -0,0 +1,220 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Striped Cache - lock-striped CLOCK cache for small values
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef STRIPED_CACHE_HPP
+#define STRIPED_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace AICopilot {
+
+struct StripedCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t contentions = 0;   // lock acquisitions that found the stripe held
+    size_t entries = 0;
+    size_t capacity = 0;
+};
+
+/**
+ * Concurrent cache of 64-bit keys split into independently locked stripes
+ *
+ * A key's stripe is picked from a mixed hash of the key, so neighbouring
+ * grid cells spread across stripes and concurrent callers rarely meet on
+ * one lock. Each stripe owns a fixed slot array evicted by CLOCK (second
+ * chance): a hit only sets the slot's reference bit, so lookups take the
+ * stripe lock shared and never reorder anything. Inserts take it
+ * exclusively and sweep the clock hand past referenced slots to find a
+ * victim. Hit/miss/eviction counters are relaxed atomics kept per stripe,
+ * so statistics never serialize the hot path. Each lock is tried before it
+ * is waited for, and the waits are counted, so a host can see when
+ * callers start queueing on a stripe.
+ */
+template <typename Value>
+class StripedCache {
+public:
+    static constexpr size_t DEFAULT_STRIPES = 16;
+
+    // capacity is split evenly over stripeCount stripes (rounded up to a power of two)
+    explicit StripedCache(size_t capacity, size_t stripeCount = DEFAULT_STRIPES)
+        : capacity_(capacity) {
+        stripeCount_ = 1;
+        while (stripeCount_ < stripeCount) stripeCount_ <<= 1;
+        while (stripeCount_ > 1 && capacity / stripeCount_ == 0) stripeCount_ >>= 1;
+        stripeMask_ = stripeCount_ - 1;
+
+        size_t perStripe = (capacity + stripeCount_ - 1) / stripeCount_;
+        stripes_ = std::make_unique<Stripe[]>(stripeCount_);
+        for (size_t i = 0; i < stripeCount_; ++i) {
+            stripes_[i].capacity = perStripe;
+            stripes_[i].slots = std::make_unique<Slot[]>(perStripe);
+            stripes_[i].index.reserve(perStripe);
+        }
+    }
+
+    StripedCache(const StripedCache&) = delete;
+    StripedCache& operator=(const StripedCache&) = delete;
+
+    // Copy the cached value into out; counts a hit or miss
+    bool find(uint64_t key, Value& out) const {
+        Stripe& stripe = stripeFor(key);
+        {
+            std::shared_lock<std::shared_mutex> lock(stripe.mutex, std::try_to_lock);
+            if (!lock.owns_lock()) {
+                stripe.contentions.fetch_add(1, std::memory_order_relaxed);
+                lock.lock();
+            }
+            auto it = stripe.index.find(key);
+            if (it != stripe.index.end()) {
+                Slot& slot = stripe.slots[it->second];
+                slot.referenced.store(true, std::memory_order_relaxed);
+                out = slot.value;
+                stripe.hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        stripe.misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Insert or overwrite; may evict an unreferenced entry from the same stripe
+    void insert(uint64_t key, const Value& value) {
+        Stripe& stripe = stripeFor(key);
+        if (stripe.capacity == 0) return;
+
+        std::unique_lock<std::shared_mutex> lock(stripe.mutex, std::try_to_lock);
+        if (!lock.owns_lock()) {
+            stripe.contentions.fetch_add(1, std::memory_order_relaxed);
+            lock.lock();
+        }
+        auto it = stripe.index.find(key);
+        if (it != stripe.index.end()) {
+            stripe.slots[it->second].value = value;
+            return;
+        }
+
+        size_t slotIndex;
+        if (stripe.used < stripe.capacity) {
+            slotIndex = stripe.used++;
+        } else {
+            // Second chance: clear reference bits until an unreferenced slot comes round
+            while (stripe.slots[stripe.hand].referenced.exchange(false, std::memory_order_relaxed)) {
+                stripe.hand = (stripe.hand + 1) % stripe.capacity;
+            }
+            slotIndex = stripe.hand;
+            stripe.hand = (stripe.hand + 1) % stripe.capacity;
+            stripe.index.erase(stripe.slots[slotIndex].key);
+            stripe.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Slot& slot = stripe.slots[slotIndex];
+        slot.key = key;
+        slot.value = value;
+        slot.referenced.store(false, std::memory_order_relaxed);
+        stripe.index.emplace(key, slotIndex);
+    }
+
+    // Drop all entries; statistics are kept
+    void clear() {
+        for (size_t i = 0; i < stripeCount_; ++i) {
+            Stripe& stripe = stripes_[i];
+            std::unique_lock<std::shared_mutex> lock(stripe.mutex);
+            stripe.index.clear();
+            stripe.used = 0;
+            stripe.hand = 0;
+        }
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (size_t i = 0; i < stripeCount_; ++i) {
+            std::shared_lock<std::shared_mutex> lock(stripes_[i].mutex);
+            total += stripes_[i].used;
+        }
+        return total;
+    }
+
+    size_t capacity() const { return capacity_; }
+    size_t stripeCount() const { return stripeCount_; }
+
+    // Slot arrays plus an estimate for the index nodes in use
+    size_t memoryUsage() const {
+        size_t slotsPerStripe = stripeCount_ ? stripes_[0].capacity : 0;
+        return stripeCount_ * (sizeof(Stripe) + slotsPerStripe * sizeof(Slot)) +
+               size() * (sizeof(uint64_t) + sizeof(size_t) + 2 * sizeof(void*));
+    }
+
+    StripedCacheStats getStats() const {
+        StripedCacheStats stats;
+        for (size_t i = 0; i < stripeCount_; ++i) {
+            const Stripe& stripe = stripes_[i];
+            stats.hits += stripe.hits.load(std::memory_order_relaxed);
+            stats.misses += stripe.misses.load(std::memory_order_relaxed);
+            stats.evictions += stripe.evictions.load(std::memory_order_relaxed);
+            stats.contentions += stripe.contentions.load(std::memory_order_relaxed);
+        }
+        stats.entries = size();
+        stats.capacity = capacity_;
+        return stats;
+    }
+
+    void resetStats() {
+        for (size_t i = 0; i < stripeCount_; ++i) {
+            stripes_[i].hits.store(0, std::memory_order_relaxed);
+            stripes_[i].misses.store(0, std::memory_order_relaxed);
+            stripes_[i].evictions.store(0, std::memory_order_relaxed);
+            stripes_[i].contentions.store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    struct Slot {
+        uint64_t key = 0;
+        Value value{};
+        std::atomic<bool> referenced{false};
+    };
+
+    // Cache-line aligned so neighbouring stripes' locks and counters do not false-share
+    struct alignas(64) Stripe {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<uint64_t, size_t> index;  // key -> slot
+        std::unique_ptr<Slot[]> slots;
+        size_t capacity = 0;
+        size_t used = 0;
+        size_t hand = 0;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> evictions{0};
+        std::atomic<uint64_t> contentions{0};
+    };
+
+    Stripe& stripeFor(uint64_t key) const {
+        // Fibonacci hashing; the high bits depend on every bit of the packed key
+        uint64_t mixed = (key ^ (key >> 29)) * 0x9E3779B97F4A7C15ull;
+        return stripes_[(mixed >> 40) & stripeMask_];
+    }
+
+    size_t capacity_;
+    size_t stripeCount_;
+    size_t stripeMask_;
+    std::unique_ptr<Stripe[]> stripes_;
+};
+
+} // namespace AICopilot
+
+#endif // STRIPED_CACHE_HPP
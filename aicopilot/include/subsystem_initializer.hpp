@@ -0,0 +1,113 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Subsystem Initializer - dependency-ordered parallel startup
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef SUBSYSTEM_INITIALIZER_HPP
+#define SUBSYSTEM_INITIALIZER_HPP
+
+#include "io_executor.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+
+enum class SubsystemInitState {
+    PENDING,
+    RUNNING,
+    SUCCEEDED,
+    FAILED,
+    SKIPPED     // a dependency failed
+};
+
+struct SubsystemInitStats {
+    std::string name;
+    bool critical = false;
+    SubsystemInitState state = SubsystemInitState::PENDING;
+    double startMs = 0.0;       // after start()
+    double durationMs = 0.0;
+};
+
+/**
+ * Dependency graph of startup steps run in parallel on an IoExecutor
+ *
+ * A step is posted as soon as every step it depends on has succeeded, so
+ * independent steps (navdata, weather, a host's ML model) load side by
+ * side. A failed step skips everything that depends on it. Ready means
+ * every critical step has finished; non-critical ones keep running after
+ * that. A dependency must be added before the steps that need it, which
+ * keeps the graph acyclic. Steps never block on each other, so they are
+ * safe on a shared executor.
+ *
+ * The destructor waits for steps still running.
+ */
+class SubsystemInitializer {
+public:
+    using Clock = std::chrono::steady_clock;
+    using InitFunction = std::function<bool()>;   // false (or a throw) fails the step
+
+    explicit SubsystemInitializer(std::shared_ptr<IoExecutor> executor = IoExecutor::shared());
+    ~SubsystemInitializer();
+
+    SubsystemInitializer(const SubsystemInitializer&) = delete;
+    SubsystemInitializer& operator=(const SubsystemInitializer&) = delete;
+
+    // False for a duplicate name, an unknown dependency, or after start()
+    bool add(const std::string& name, const std::vector<std::string>& dependencies,
+             bool critical, InitFunction function);
+
+    void start();
+
+    // Block until every critical step has finished; true if they all succeeded
+    bool waitReady();
+
+    // Block until every step has finished
+    void waitAll();
+
+    bool isReady() const;
+
+    // start() to the last critical step finishing (0 until ready)
+    double getTimeToReadyMs() const;
+
+    std::vector<SubsystemInitStats> getStats() const;
+
+private:
+    struct Step {
+        SubsystemInitStats stats;
+        InitFunction function;
+        size_t waitingOn = 0;              // dependencies not yet succeeded
+        std::vector<size_t> dependents;
+    };
+
+    void post(size_t index);
+    void run(size_t index);
+    void finishLocked(size_t index, SubsystemInitState state);
+    double sinceStartMs(Clock::time_point now) const;
+
+    std::shared_ptr<IoExecutor> executor_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable doneCv_;
+    std::vector<Step> steps_;              // guarded by mutex_
+    size_t unfinished_ = 0;
+    size_t criticalUnfinished_ = 0;
+    bool criticalFailed_ = false;
+    bool started_ = false;
+    Clock::time_point startTime_{};
+    double timeToReadyMs_ = 0.0;
+};
+
+} // namespace AICopilot
+
+#endif // SUBSYSTEM_INITIALIZER_HPP
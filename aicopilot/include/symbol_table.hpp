@@ -0,0 +1,68 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Symbol Table - interned navdata identifiers with dense integer IDs
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef SYMBOL_TABLE_HPP
+#define SYMBOL_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace AICopilot {
+
+using SymbolId = uint32_t;
+constexpr SymbolId INVALID_SYMBOL = UINT32_MAX;
+
+/**
+ * Interning table mapping identifier strings to dense 32-bit IDs
+ *
+ * Fix, navaid, airway and airport identifiers are interned once when data
+ * is loaded; after that the navdata layer stores, indexes and compares the
+ * IDs and only turns strings into IDs (or back) at its public API. IDs are
+ * handed out in order from zero and never reused, so per-ID vectors stay
+ * dense, and a name's storage lives as long as the table.
+ *
+ * Thread-safe. Lookups take a shared lock; intern() only locks exclusively
+ * when the name is new.
+ */
+class SymbolTable {
+public:
+    SymbolTable() = default;
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    // ID for name, adding it if needed
+    SymbolId intern(std::string_view name);
+
+    // ID for name, or INVALID_SYMBOL if it was never interned
+    SymbolId find(std::string_view name) const;
+
+    // Name for an ID; empty for INVALID_SYMBOL or unknown IDs
+    const std::string& name(SymbolId id) const;
+
+    size_t size() const;
+
+    // Process-wide table shared by the navigation databases and loaders
+    static SymbolTable& navdata();
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> names_;                     // by ID; deque keeps references stable
+    std::unordered_map<std::string_view, SymbolId> ids_;  // views into names_
+};
+
+} // namespace AICopilot
+
+#endif // SYMBOL_TABLE_HPP
@@ -19,11 +19,17 @@
 #define SYSTEM_MONITOR_HPP
 
 #include "aicopilot_types.h"
+#include "hdr_histogram.hpp"
+#include <array>
+#include <atomic>
 #include <vector>
 #include <string>
 #include <memory>
 #include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
+#include <thread>
 
 namespace AICopilot {
 
@@ -52,9 +58,12 @@ enum class SystemComponent {
     TRAFFIC_MANAGEMENT,
     PERFORMANCE_OPTIMIZER,
     ADVANCED_PROCEDURES,
-    DYNAMIC_PLANNING
+    DYNAMIC_PLANNING,
+    VOICE_PIPELINE      // end-to-end utterance latency, mic to readback
 };
 
+constexpr size_t SYSTEM_COMPONENT_COUNT = static_cast<size_t>(SystemComponent::VOICE_PIPELINE) + 1;
+
 // Component health
 struct ComponentHealth {
     SystemComponent component;
@@ -160,6 +169,8 @@ public:
     
     /**
      * Record query execution time
+     * Lock-free and safe from any thread: a few relaxed atomic operations
+     * on the component's HDR histogram, recent-sample ring and average
      */
     void recordQueryLatency(SystemComponent component, double latencyMs);
     
@@ -175,9 +186,14 @@ public:
     
     /**
      * Get component performance profile
+     * Percentiles come from a merged histogram snapshot in O(buckets),
+     * within about 3% of the true value
      */
     PerformanceProfile getComponentPerformanceProfile(SystemComponent component) const;
     
+    // Merged latency histogram of everything recorded for component
+    HdrHistogram getLatencyHistogram(SystemComponent component) const;
+    
     /**
      * Get performance trend
      */
@@ -189,25 +205,71 @@ public:
     };
     PerformanceTrend getPerformanceTrend(SystemComponent component) const;
     
+    /**
+     * Report which load-shedding steps are in effect, most expendable first
+     * An empty list means full fidelity. Each change raises an alert
+     * (DEGRADED while any step is active) with message.
+     */
+    void reportDegradation(const std::vector<std::string>& activeSteps, const std::string& message);
+    
+    struct DegradationState {
+        size_t level = 0;                       // steps in effect
+        std::vector<std::string> activeSteps;
+        uint64_t changes = 0;
+    };
+    DegradationState getDegradationState() const;
+    
     // ============================================================
     // RESOURCE MONITORING
     // ============================================================
     
     /**
      * Get resource utilization
+     * CPU, memory, disk and thread figures are the process's own, sampled
+     * every RESOURCE_SAMPLE_INTERVAL by a background thread while the
+     * monitor is initialized (GetProcessTimes/GetProcessMemoryInfo/PDH on
+     * Windows, /proc elsewhere). CPU is a share of all cores; disk is the
+     * busiest physical disk's active time.
      */
     struct ResourceUtilization {
         double cpuPercentage;
-        double memoryPercentage;
+        double memoryPercentage;       // resident set / physical memory
         double diskIOPercentage;
         double networkIOPercentage;
         uint32_t threadCount;
         uint32_t activeQueries;
+        uint64_t residentBytes;
+        uint64_t physicalMemoryBytes;
     };
     ResourceUtilization getResourceUtilization() const;
     
+    static constexpr std::chrono::milliseconds RESOURCE_SAMPLE_INTERVAL{1000};
+    
+    /**
+     * Take a resource sample now rather than waiting for the sampler thread
+     */
+    void refreshResourceSample();
+    
+    /**
+     * Register a live byte count for a component's memory
+     * Sources are polled with each resource sample, so they must be cheap,
+     * thread-safe and must not call back into the monitor. Once a component
+     * has a source, its ComponentHealth::memoryUsage is the sum of its
+     * sources rather than whatever updateComponentHealth reported.
+     */
+    enum class MemoryCategory {
+        CACHE,
+        BUFFER,
+        QUERY
+    };
+    using MemorySource = std::function<uint64_t()>;
+    void registerMemorySource(SystemComponent component, MemoryCategory category, MemorySource source);
+    
     /**
      * Get detailed memory breakdown
+     * Cache, buffer and query memory are the registered sources' byte
+     * counts; systemMemory is the rest of the resident set and overhead is
+     * the monitor's own footprint.
      */
     struct MemoryBreakdown {
         uint64_t cacheMemory;
@@ -220,6 +282,9 @@ public:
     
     /**
      * Predict resource exhaustion
+     * Memory is extrapolated from a least-squares fit of the last
+     * MEMORY_TREND_SAMPLES resident-set samples; disk-full risk is less
+     * than 5% free space on the working directory's volume
      */
     struct ExhaustionPrediction {
         bool memoryExhaustionRisk;
@@ -377,7 +442,21 @@ private:
     
     // Performance metrics
     std::vector<SystemMetrics> metricsHistory_;
-    std::vector<std::vector<double>> latencyHistory_;
+    
+    // Per-component latency state, written by recordQueryLatency without locks
+    static constexpr size_t TREND_SAMPLES = 600;   // 10 minutes at 1 sample/sec
+    struct LatencyTrack {
+        ConcurrentHdrHistogram histogram;
+        std::array<std::atomic<double>, TREND_SAMPLES> recent{};   // ring of the latest samples
+        std::atomic<uint64_t> recentHead{0};                       // samples ever written
+        std::atomic<double> averageLatency{0.0};                   // exponential moving average
+        std::atomic<uint64_t> queryBase{0};                        // count set by updateComponentHealth
+    };
+    std::unique_ptr<LatencyTrack[]> latency_;
+    
+    // Load shedding reported by the tick watchdog
+    mutable std::mutex degradationMutex_;
+    DegradationState degradation_;
     
     // Alerts
     std::vector<SystemAlert> alerts_;
@@ -389,10 +468,51 @@ private:
     
     // Timing
     std::chrono::steady_clock::time_point startTime_;
-    uint64_t totalQueries_;
+    std::atomic<uint64_t> totalQueries_;
     uint64_t totalErrors_;
     
+    // Resource sampling; the sample state below is guarded by sampleMutex_
+    struct ResourceSample {
+        bool valid = false;
+        double cpuPercentage = 0.0;
+        double diskIOPercentage = 0.0;
+        double diskFreeFraction = 1.0;
+        uint64_t residentBytes = 0;
+        uint64_t physicalBytes = 0;
+        uint32_t threadCount = 0;
+        uint64_t categoryBytes[3] = {0, 0, 0};   // by MemoryCategory
+    };
+    static constexpr size_t MEMORY_TREND_SAMPLES = 120;   // 2 minutes at the sample interval
+    struct MemorySourceEntry {
+        SystemComponent component;
+        MemoryCategory category;
+        MemorySource source;
+    };
+    
+    mutable std::mutex sampleMutex_;
+    ResourceSample sample_;
+    std::array<uint64_t, MEMORY_TREND_SAMPLES> memoryTrend_{};   // resident bytes ring
+    size_t memoryTrendCount_ = 0;                                // samples ever taken
+    double lastCpuSeconds_ = 0.0;
+    std::vector<uint64_t> lastDiskTicksMs_;   // per device, /proc/diskstats order
+    std::chrono::steady_clock::time_point lastSampleTime_;
+    void* diskQuery_ = nullptr;      // PDH query (Windows)
+    void* diskCounter_ = nullptr;
+    std::vector<MemorySourceEntry> memorySources_;
+    std::array<std::atomic<uint64_t>, SYSTEM_COMPONENT_COUNT> sourcedMemory_{};   // NO_SOURCE if none
+    static constexpr uint64_t NO_SOURCE = ~0ull;
+    
+    std::thread samplerThread_;
+    std::condition_variable samplerWake_;
+    bool samplerStop_ = false;
+    
+    void startResourceSampler();
+    void stopResourceSampler();
+    ResourceSample latestSample() const;
+    
     // Helper methods
+    ComponentHealth componentSnapshot(size_t index) const;   // stored health plus latency state
+    std::vector<ComponentHealth> componentSnapshots() const;
     double calculateHealthScore() const;
     SystemHealth determineOverallHealth() const;
     void updateMetricsHistory();
@@ -0,0 +1,147 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* TAF Store - decoded terminal forecasts queryable by valid time
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TAF_STORE_HPP
+#define TAF_STORE_HPP
+
+#include "weather_station_store.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace AICopilot {
+
+// Bits of TAFPeriod::changes: the change groups in force during a period
+namespace TAFChange {
+    constexpr uint8_t BECOMING = 1u << 0;      // Inside a BECMG transition
+    constexpr uint8_t TEMPORARY = 1u << 1;     // TEMPO
+    constexpr uint8_t PROBABLE = 1u << 2;      // PROB30 / PROB40, with or without TEMPO
+}
+
+// One stretch of a forecast over which neither summary changes
+struct TAFPeriod {
+    time_t from = 0;                // Unix time, inclusive
+    time_t to = 0;                  // Exclusive
+    StationSummary prevailing;      // Base, FM and completed BECMG groups
+    StationSummary worst;           // Also BECMG transitions, TEMPO and PROB groups
+    uint8_t changes = 0;            // TAFChange
+    uint8_t probability = 0;        // Highest PROB percentage in force, 0 if none
+
+    bool valid() const { return to > from; }
+};
+
+/**
+ * The worse of two summaries, element by element: the lower category,
+ * visibility and ceiling, the stronger wind and gust, suitability only if
+ * both are suitable and every hazard of either
+ */
+StationSummary worstOf(const StationSummary& a, const StationSummary& b);
+
+// One station's decoded TAF
+struct TAFForecast {
+    time_t issuedAt = 0;
+    time_t validFrom = 0;
+    time_t validTo = 0;
+    std::vector<TAFPeriod> periods;     // Contiguous from validFrom to validTo
+    std::string text;                   // One line, single spaces
+
+    // Period covering t, or null outside the validity
+    const TAFPeriod* at(time_t t) const;
+
+    /**
+     * Worst conditions forecast anywhere in [from, to)
+     * @return false if the window lies wholly outside the validity
+     */
+    bool worstBetween(time_t from, time_t to, StationSummary& worst) const;
+};
+
+/**
+ * Latest TAF for every station, decoded once into its effective periods
+ *
+ * decode() resolves the issue, validity and change-group times against a
+ * reference clock, replays FM and BECMG groups element by element onto the
+ * base forecast (wind, visibility, weather and cloud each carry over until
+ * a group restates them) and overlays TEMPO and PROB groups, then cuts the
+ * validity at every group boundary. Each resulting period carries both
+ * summaries, so a query is a hash lookup and a binary search with no date
+ * arithmetic or parsing. A new TAF replaces a station's forecast unless it
+ * was issued earlier; forecasts expire at the end of their validity.
+ */
+class TAFStore {
+public:
+    struct Query {
+        StationKey station = INVALID_STATION;
+        time_t time = 0;
+    };
+
+    using Batch = std::vector<std::pair<StationKey, TAFForecast>>;
+
+    /**
+     * Decode a TAF: [TAF] [AMD|COR] station DDHHMMZ DDHH/DDHH body
+     * followed by FMDDHHMM, BECMG, TEMPO and PROBnn [TEMPO] groups
+     * @param reference Clock the day-of-month times are resolved against;
+     *        the issue time is taken in the month nearest to it
+     * @return false if the header or validity group is malformed
+     */
+    static bool decode(std::string_view text, StationKey& station, TAFForecast& forecast,
+                       time_t reference = std::time(nullptr));
+
+    /**
+     * Decode and store one TAF
+     * @return false if it doesn't decode or an already stored forecast
+     *         for the station was issued later
+     */
+    bool update(std::string_view text, time_t now = std::time(nullptr));
+
+    // Store decoded forecasts under one lock, by the same rule as update()
+    void publish(Batch batch);
+
+    bool erase(const std::string& icao);
+    void clear();
+
+    // Drop forecasts whose validity has ended; returns how many
+    size_t purgeExpired(time_t now = std::time(nullptr));
+
+    size_t size() const;
+
+    bool get(const std::string& icao, TAFForecast& forecast) const;
+
+    // Period forecast for the station at time; false if none covers it
+    bool forecastAt(const std::string& icao, time_t time, TAFPeriod& period) const;
+    bool forecastAt(StationKey station, time_t time, TAFPeriod& period) const;
+
+    // TAFForecast::worstBetween for the station
+    bool worstBetween(StationKey station, time_t from, time_t to, StationSummary& worst) const;
+
+    /**
+     * Answer many station x time pairs under one lock
+     * @param periods Output, one per query; invalid where nothing is forecast
+     * @return Number of queries a period covers
+     */
+    size_t forecastsAt(const std::vector<Query>& queries, std::vector<TAFPeriod>& periods) const;
+
+private:
+    std::unordered_map<StationKey, TAFForecast> forecasts_;
+    mutable std::shared_mutex mutex_;
+
+    // Caller holds the unique lock
+    bool storeLocked(StationKey station, TAFForecast&& forecast);
+};
+
+} // namespace AICopilot
+
+#endif // TAF_STORE_HPP
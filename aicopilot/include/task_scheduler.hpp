@@ -0,0 +1,144 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Task Scheduler - fixed-rate multi-rate scheduling of pilot subsystems
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TASK_SCHEDULER_HPP
+#define TASK_SCHEDULER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace AICopilot {
+
+class TickWatchdog;
+
+/**
+ * Where a scheduled task runs
+ */
+enum class TaskExecution {
+    INLINE,   // on the thread calling tick(), e.g. control laws
+    WORKER    // on the scheduler's worker pool, e.g. Ollama or terrain loads
+};
+
+/**
+ * Per-task timing statistics
+ */
+struct ScheduledTaskStats {
+    std::string name;
+    double rateHz = 0.0;               // 0 for on-demand tasks
+    TaskExecution execution = TaskExecution::INLINE;
+    uint64_t runCount = 0;
+    uint64_t deadlineMisses = 0;       // started a full period late, overran, or was still busy
+    double lastDurationMs = 0.0;
+    double maxDurationMs = 0.0;
+};
+
+/**
+ * Fixed-rate multi-rate scheduler
+ *
+ * Each task declares its own frequency; tick() runs whatever is due. INLINE
+ * tasks execute on the ticking thread, WORKER tasks are handed to a small
+ * thread pool so a slow task never stalls the tick. A periodic worker task
+ * that is still running when it comes due again is skipped (and counted as
+ * a deadline miss) rather than queued twice.
+ *
+ * Register tasks before ticking; tick() must be driven from one thread.
+ */
+class TaskScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TaskFunction = std::function<void()>;
+    using TaskId = size_t;
+
+    // workerCount 0 runs WORKER tasks inline
+    explicit TaskScheduler(size_t workerCount = 2);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    // rateHz <= 0 registers an on-demand task that runs only after trigger()
+    TaskId addTask(const std::string& name, double rateHz, TaskFunction function,
+                   TaskExecution execution = TaskExecution::INLINE);
+
+    // Run an on-demand (or periodic) task on the next tick; thread-safe
+    void trigger(TaskId id);
+
+    // Change a periodic task's rate from the ticking thread, e.g. to shed load
+    void setTaskRate(TaskId id, double rateHz);
+
+    // Have every tick() measured against the watchdog's budget
+    void setWatchdog(TickWatchdog* watchdog) { watchdog_ = watchdog; }
+
+    // Run every task that is due
+    void tick();
+    void tick(Clock::time_point now);
+
+    // Block until no worker task is queued or running
+    void waitForWorkers();
+
+    // Wait for workers and remove every task
+    void clear();
+
+    size_t getTaskCount() const { return tasks_.size(); }
+    std::vector<ScheduledTaskStats> getStats() const;
+    uint64_t getTotalDeadlineMisses() const;
+
+private:
+    struct Task {
+        std::string name;
+        const char* traceName = nullptr;   // interned for TRACE_SCOPE
+        double rateHz = 0.0;               // written under statsMutex_ by setTaskRate
+        Clock::duration period{};
+        TaskFunction function;
+        TaskExecution execution = TaskExecution::INLINE;
+        Clock::time_point nextDue{};
+        bool started = false;
+        std::atomic<bool> triggered{false};
+        std::atomic<bool> running{false};
+
+        // Guarded by statsMutex_
+        uint64_t runCount = 0;
+        uint64_t deadlineMisses = 0;
+        double lastDurationMs = 0.0;
+        double maxDurationMs = 0.0;
+    };
+
+    void dispatch(Task& task);
+    void runTask(Task& task);
+    void recordMiss(Task& task);
+    void workerLoop();
+
+    std::vector<std::unique_ptr<Task>> tasks_;
+    mutable std::mutex statsMutex_;
+    TickWatchdog* watchdog_ = nullptr;
+
+    // Worker pool
+    std::vector<std::thread> workers_;
+    std::deque<Task*> queue_;
+    std::mutex queueMutex_;
+    std::condition_variable queueCv_;
+    std::condition_variable idleCv_;
+    size_t pendingJobs_ = 0;  // queued + running, guarded by queueMutex_
+    bool stopping_ = false;
+};
+
+} // namespace AICopilot
+
+#endif // TASK_SCHEDULER_HPP
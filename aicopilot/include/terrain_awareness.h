@@ -19,39 +19,18 @@
 #define TERRAIN_AWARENESS_H
 
 #include "aicopilot_types.h"
+#include "aircraft_state_core.hpp"
+#include "obstacle_index.hpp"
+#include "terrain_clearance.hpp"
+#include "terrain_lod.hpp"
+#include "terrain_lookahead.hpp"
+#include "terrain_pack.hpp"
+#include "tiled_raster_source.hpp"
 #include <vector>
 #include <memory>
 
 namespace AICopilot {
 
-// Terrain warning levels (TAWS/EGPWS)
-enum class TerrainWarningLevel {
-    NONE,
-    CAUTION,          // "CAUTION TERRAIN"
-    WARNING,          // "TERRAIN TERRAIN"
-    PULL_UP           // "PULL UP, PULL UP"
-};
-
-// Obstacle types
-enum class ObstacleType {
-    TOWER,
-    BUILDING,
-    MOUNTAIN,
-    ANTENNA,
-    BRIDGE,
-    POWER_LINE,
-    OTHER
-};
-
-// Obstacle structure
-struct Obstacle {
-    ObstacleType type;
-    Position position;
-    double height;  // feet AGL
-    double elevation;  // feet MSL
-    std::string description;
-};
-
 // Terrain alert
 struct TerrainAlert {
     TerrainWarningLevel level;
@@ -68,19 +47,32 @@ class TerrainAwareness {
 public:
     TerrainAwareness() = default;
     
-    // Update aircraft state
+    // Update aircraft state and advance the predictive look-ahead corridor
     void updateAircraftState(const AircraftState& state);
     
+    // The same from the hot core alone. Returns false without touching
+    // anything when version is the one last applied (0 always applies).
+    bool updateAircraftState(const AircraftStateCore& core, uint64_t version);
+    uint64_t getStateVersion() const { return stateVersion_; }
+    
+    // Predictive alert from the last updateAircraftState
+    const TerrainLookaheadResult& getLookaheadResult() const { return lookahead_.getResult(); }
+    void setLookaheadTime(double seconds) { lookahead_.setLookaheadTime(seconds); }
+    
     // Check terrain clearance
     TerrainAlert checkTerrainClearance(const Position& pos) const;
     
     // Get terrain elevation at position
     double getTerrainElevation(const Position& pos) const;
     
+    // Batched getTerrainElevation for count points (feet MSL)
+    void getTerrainElevations(const LatLon* points, size_t count, double* outFt) const;
+    
     // Get altitude above ground level (AGL)
     double getAltitudeAGL(const Position& pos, double altitudeMSL) const;
     
-    // Check for obstacles in path
+    // Check for obstacles within OBSTACLE_CORRIDOR_NM of the path that come
+    // within OBSTACLE_CLEARANCE of (or rise above) altitude
     std::vector<Obstacle> detectObstacles(
         const Position& start,
         const Position& end,
@@ -114,32 +106,88 @@ public:
         double altitude,
         double lookaheadTime) const;  // seconds
     
+    // Clearance of a 3D path (feet MSL), ray-marched over the terrain
+    // levels' max pyramid and sampled at the finest terrain only where the
+    // path comes within the clearance (TerrainClearance)
+    PathClearanceResult checkPathClearance(
+        const std::vector<Position>& path,
+        double requiredClearance) const;  // feet
+    
+    // checkPathClearance for many candidate paths at once
+    std::vector<PathClearanceResult> checkPathClearances(
+        const std::vector<std::vector<Position>>& paths,
+        double requiredClearance) const;  // feet
+    
+    // True if terrain does not block the straight line between two points
+    bool hasLineOfSight(const Position& from, const Position& to) const;
+    
     // Get terrain profile ahead
     std::vector<TerrainPoint> getTerrainProfile(
         const Position& start,
         double heading,
         double distance) const;  // nautical miles
     
-    // Load terrain database (stub for integration)
+    // Load terrain database: a compiled terrain pack (see tools/terrain_pack_compiler),
+    // or CSV rows of lat,lon,elevation_ft
     bool loadTerrainDatabase(const std::string& databasePath);
     
+    // Use an already opened terrain pack (may be shared between instances)
+    void setTerrainPack(std::shared_ptr<const TerrainPack> pack);
+    bool hasTerrainPack() const { return terrainPack_ != nullptr; }
+    
+    // Use a block-windowed DEM raster (may be shared between instances); a
+    // terrain pack still takes precedence where it has data
+    void setTerrainRaster(std::shared_ptr<TiledRasterSource> raster);
+    bool hasTerrainRaster() const { return terrainRaster_ != nullptr; }
+    
+    // Use SRTM1/SRTM3/coarse terrain levels (may be shared between
+    // instances). Point queries take the finest level; the look-ahead
+    // corridor picks a level per sample from AGL, ground speed and distance
+    // ahead (TerrainLodStack::selectLod). Answers before the pack and raster.
+    void setTerrainLods(std::shared_ptr<const TerrainLodStack> lods) { terrainLods_ = std::move(lods); }
+    bool hasTerrainLods() const { return terrainLods_ != nullptr; }
+    
     // Load obstacle database
+    // CSV format: lat,lon,elevation_msl_ft,height_agl_ft[,type[,description]]
     bool loadObstacleDatabase(const std::string& databasePath);
     
+    // Replace the obstacle database and rebuild its spatial index
+    void setObstacles(std::vector<Obstacle> obstacles);
+    size_t getObstacleCount() const { return obstacleIndex_.size(); }
+    
+    // Lateral search distance either side of the path for detectObstacles (nautical miles)
+    static constexpr double OBSTACLE_CORRIDOR_NM = 1.0;
+    static constexpr double OBSTACLE_CLEARANCE = 1000.0;  // feet
+    
 private:
-    AircraftState currentState_;
+    void advanceLookahead();
+    
+    AircraftState currentState_{};
+    uint64_t stateVersion_ = 0;
     std::vector<TerrainPoint> terrainDatabase_;
-    std::vector<Obstacle> obstacleDatabase_;
+    std::shared_ptr<const TerrainPack> terrainPack_;
+    std::shared_ptr<TiledRasterSource> terrainRaster_;
+    std::shared_ptr<const TerrainLodStack> terrainLods_;
+    std::vector<TerrainLod> lookaheadLods_;   // per corridor sample, reused across updates
+    ObstacleIndex obstacleIndex_;
+    TerrainLookahead lookahead_;
     
     // Minimum clearances (feet)
     static constexpr double MIN_CLEARANCE_CRUISE = 1000.0;
     static constexpr double MIN_CLEARANCE_APPROACH = 500.0;
     static constexpr double MIN_CLEARANCE_EMERGENCY = 300.0;
     
+    // Raster blocks queued around the aircraft on each state update
+    static constexpr double RASTER_PREFETCH_RADIUS_NM = 10.0;
+    
     // Helper methods
     TerrainWarningLevel determineWarningLevel(double clearance, bool climbing) const;
     double interpolateElevation(const Position& pos) const;
+    double sampleTerrain(const Position& pos, double resolutionDeg) const;
+    TerrainClearance makeClearance() const;
+    void sampleLookahead(const LatLon* points, size_t count, double* outFt);
     bool isInMountainousArea(const Position& pos) const;
+    static ObstacleType parseObstacleType(const std::string& name);
 };
 
 } // namespace AICopilot
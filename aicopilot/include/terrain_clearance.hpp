@@ -0,0 +1,108 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Terrain Clearance - path clearance and line of sight over the max pyramid
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TERRAIN_CLEARANCE_HPP
+#define TERRAIN_CLEARANCE_HPP
+
+#include "aicopilot_types.h"
+#include "terrain_max_pyramid.hpp"
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace AICopilot {
+
+struct PathClearanceResult {
+    bool clear = true;               // every point at least the required clearance above terrain
+    bool complete = true;            // false if part of the path had no terrain data (taken as sea level)
+    double minimumClearanceFt = std::numeric_limits<double>::infinity();
+                                     // clear: a lower bound over the path; else: at the conflict
+    double conflictDistanceNM = -1.0;    // along the path to the first conflict
+    Position conflictPosition{};         // altitude is the path's, not the terrain's
+    double conflictTerrainFt = 0.0;
+    size_t cellQueries = 0;          // pyramid box lookups
+    size_t fineSamples = 0;          // point elevation lookups
+};
+
+/**
+ * Does a 3D path, or the line between two points, clear the terrain?
+ *
+ * Each segment is ray-marched hierarchically: the box around it is looked
+ * up in the TerrainMaxPyramid, and if the lowest point of the segment
+ * stands the required clearance above that box's highest cell the whole
+ * segment clears in one lookup. Otherwise it is halved and each half
+ * tried again, so only the spans that come close to the terrain descend
+ * to small cells. Spans still undecided at one pyramid base cell are
+ * sampled at FINE_STEP_DEGREES from the fine elevation source; without
+ * one the base cell maximum decides, which can only err towards a
+ * conflict. Halves are visited in path order and the search stops on the
+ * first conflict.
+ *
+ * Paths follow the surface: altitude is interpolated linearly along each
+ * segment. hasLineOfSight() instead treats the segment as a straight line
+ * through space and lowers it by the Earth's curvature. Coordinates are
+ * interpolated linearly, so segments should be short against the Earth
+ * and must not cross the antimeridian. Either source may be absent; with
+ * neither, terrain is taken as sea level and results are incomplete.
+ *
+ * Thread-safe if the fine source is.
+ */
+class TerrainClearance {
+public:
+    // Terrain (feet MSL) at a point; false if there is no data
+    using PointElevation = std::function<bool(double latitude, double longitude, double& elevationFt)>;
+
+    static constexpr double FINE_STEP_DEGREES = 1.0 / 3600.0;   // SRTM1 post spacing
+    static constexpr double LEAF_DEGREES = 1.0 / 120.0;          // span size without a pyramid
+    static constexpr int MAX_DEPTH = 32;
+
+    TerrainClearance(std::shared_ptr<const TerrainMaxPyramid> pyramid, PointElevation fine);
+
+    // Clearance of the polyline through path (feet MSL altitudes)
+    PathClearanceResult checkPath(const std::vector<Position>& path, double requiredClearanceFt) const;
+
+    // Clearance of the single segment from -> to
+    PathClearanceResult checkSegment(const Position& from, const Position& to, double requiredClearanceFt) const;
+
+    // Many candidate paths at once; one lookup clears them all when the
+    // box around every path is already clear
+    std::vector<PathClearanceResult> checkPaths(const std::vector<std::vector<Position>>& paths,
+                                                double requiredClearanceFt) const;
+
+    // True if the straight line between two points stays above the terrain
+    bool hasLineOfSight(const Position& from, const Position& to) const;
+
+private:
+    struct Segment {
+        double latitude0, longitude0, altitude0;
+        double latitude1, longitude1, altitude1;
+        double lengthNM;
+        double startNM;         // along the path
+        double sagFt;           // chord drop below the surface at mid-segment; 0 for paths
+    };
+
+    static Segment makeSegment(const Position& from, const Position& to, double startNM, bool chord);
+    static double altitudeAt(const Segment& segment, double t);
+    bool covered(const Segment& segment, double t0, double t1) const;
+    bool clearSpan(const Segment& segment, double t0, double t1, double requiredFt, int depth,
+                   PathClearanceResult& result) const;
+    void recordConflict(const Segment& segment, double t, double terrainFt, double clearanceFt,
+                        PathClearanceResult& result) const;
+
+    std::shared_ptr<const TerrainMaxPyramid> pyramid_;
+    PointElevation fine_;
+};
+
+} // namespace AICopilot
+
+#endif // TERRAIN_CLEARANCE_HPP
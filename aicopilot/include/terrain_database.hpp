@@ -14,12 +14,13 @@
 #define TERRAIN_DATABASE_HPP
 
 #include "aicopilot_types.h"
+#include "tile_cache.hpp"
 #include <vector>
-#include <map>
 #include <memory>
 #include <cstring>
 #include <chrono>
 #include <mutex>
+#include <unordered_set>
 
 namespace AICopilot {
 
@@ -29,14 +30,20 @@ namespace AICopilot {
  * Provides elevation data from SRTM 30m resolution tiles
  * Format: Tile files named N/S{LAT}E/W{LON}.hgt
  * Data: 3601x3601 int16 samples per 1° × 1° tile (big-endian)
+ *
+ * Thread-safe; tiles are read from disk outside the cache lock so a
+ * prefetch thread never stalls lookups into resident tiles.
  */
 class TerrainDatabase {
 public:
     // SRTM tile dimensions
     static constexpr int SRTM_SIZE = 3601;  // 3601x3601 samples
     static constexpr double SRTM_RESOLUTION = 1.0 / 3600.0;  // 1 arc-second
-    static constexpr int MAX_CACHE_TILES = 16;  // LRU cache size
+    static constexpr int MAX_CACHE_TILES = 16;  // Default LRU cache size in tiles
     static constexpr int TILE_SIZE_BYTES = SRTM_SIZE * SRTM_SIZE * 2;  // 25,934,402 bytes
+    static constexpr size_t DEFAULT_CACHE_BUDGET =
+        static_cast<size_t>(MAX_CACHE_TILES) * TILE_SIZE_BYTES;
+    static constexpr double PENDING_ELEVATION_FT = 29100.0;  // reported while a tile loads
     
     // Elevation tile data
     struct ElevationTile {
@@ -81,6 +88,33 @@ public:
      */
     double getElevationAt(const Position& position);
     
+    /**
+     * Get elevations for many points at once
+     * Each tile touched by the batch is looked up (and locked) once.
+     * @param points Query points
+     * @param count Number of points
+     * @param out Output elevations in feet MSL (count entries, 0 where unavailable)
+     */
+    void getElevations(const LatLon* points, size_t count, double* out);
+    
+    /**
+     * Get elevation without touching the disk
+     * A tile that is not resident yet reports PENDING_ELEVATION_FT so
+     * clearance checks fail safe until a prefetch brings it in.
+     * @param latitude Latitude in degrees
+     * @param longitude Longitude in degrees
+     * @param elevation Output elevation in feet (MSL)
+     * @return READY, PENDING (not loaded yet) or NO_DATA (0 ft, no tile exists)
+     */
+    TileLookupStatus tryGetElevationAt(double latitude, double longitude, double& elevation);
+    
+    /**
+     * Load a tile into the cache if it is not already there
+     * Blocks on disk I/O; intended for a background prefetch thread.
+     * @return true if the tile is resident afterwards
+     */
+    bool prefetchTile(int tileLatitude, int tileLongitude);
+    
     /**
      * Get elevation profile along a path
      * @param start Start position
@@ -123,17 +157,31 @@ public:
      * @return Pair of (tiles_in_cache, cache_size_mb)
      */
     std::pair<int, int> getCacheStats() const;
+    
+    /**
+     * Get cache hit/miss/eviction counters and occupancy
+     */
+    TileCacheStats getTileCacheStats() const;
+    
+    /**
+     * Set cache byte budget; least recently used tiles are evicted to fit
+     * @param bytes Budget in bytes
+     */
+    void setCacheBudget(size_t bytes);
 
 private:
     std::string srtmDataPath_;
-    std::map<std::string, ElevationTile> tileCache_;
-    std::vector<std::string> cacheOrder_;  // For LRU ordering
+    TileCache<ElevationTile> tileCache_{DEFAULT_CACHE_BUDGET};
+    std::unordered_set<TileKey> missingTiles_;  // tiles with no file on disk
     mutable std::mutex cacheMutex_;
     
     // Helper methods
     std::string getTileFilename(int tileLatitude, int tileLongitude) const;
-    bool loadTile(int tileLatitude, int tileLongitude);
-    void evictOldestTile();
+    std::shared_ptr<ElevationTile> findTile(int tileLatitude, int tileLongitude, bool& missing);
+    std::shared_ptr<ElevationTile> loadTile(int tileLatitude, int tileLongitude);
+    double sampleTile(const ElevationTile& tile, double latitude, double longitude) const;
+    static bool getTileIndices(double latitude, double longitude,
+                               int& tileLatitude, int& tileLongitude);
     int16_t getRawElevation(const ElevationTile& tile, int row, int col) const;
     double interpolateElevation(const ElevationTile& tile, 
                                double fracRow, double fracCol) const;
@@ -0,0 +1,114 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Terrain LOD - altitude-adaptive choice between terrain resolutions
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TERRAIN_LOD_HPP
+#define TERRAIN_LOD_HPP
+
+#include "terrain_max_pyramid.hpp"
+#include "tile_cache.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace AICopilot {
+
+class SRTMLoader;
+
+// Terrain resolutions, finest first
+enum class TerrainLod : uint8_t {
+    SRTM1 = 0,        // 1 arc-second tiles, bilinear
+    SRTM3 = 1,        // 3 arc-second tiles, highest of the four posts around a point
+    COARSE = 2        // TerrainMaxPyramid level 0 cell
+};
+
+constexpr size_t TERRAIN_LOD_COUNT = 3;
+
+// What a terrain query is for
+struct TerrainLodQuery {
+    double aglFt = 0.0;               // aircraft height above the terrain below it
+    double groundSpeedKts = 0.0;
+    double distanceNM = 0.0;          // how far ahead of the aircraft the point lies
+};
+
+struct TerrainLodStats {
+    uint64_t served[TERRAIN_LOD_COUNT] = {};  // points answered per level
+    uint64_t fallbacks = 0;                   // points answered by another level than asked for
+    uint64_t unavailable = 0;                 // points no level had data for
+};
+
+/**
+ * SRTM1, SRTM3 and a coarse max pyramid behind one elevation query
+ *
+ * selectLod() picks the resolution a query needs: full resolution close
+ * to the terrain and close ahead, coarse cells once the aircraft is high
+ * and fast. Only SRTM1 interpolates; the coarser levels answer with the
+ * highest terrain around the point (SRTM3 posts, pyramid cells), so a
+ * coarser answer is never lower than the finer one wherever the coarse
+ * data was built from it, and a clearance check cannot pass on a coarse
+ * level that fails on a fine one. Coarse levels only cost nuisance
+ * margin, which the AGL thresholds keep away from low-level flight.
+ *
+ * A level that is not configured, or has no tile at the point, hands the
+ * point on: to the finer levels first, then the coarser ones. At cruise
+ * with a pyramid set the SRTM tiles are not touched at all.
+ *
+ * Thread-safe; the loaders serialize themselves.
+ */
+class TerrainLodStack {
+public:
+    static constexpr double FINE_AGL_FT = 2000.0;      // SRTM1 below this AGL...
+    static constexpr double FINE_RANGE_NM = 3.0;       // ...for points within this distance ahead,
+    static constexpr double FINE_SPEED_KTS = 90.0;     // ...or at any distance below this speed
+    static constexpr double COARSE_AGL_FT = 5000.0;    // COARSE at or above this AGL...
+    static constexpr double COARSE_SPEED_KTS = 180.0;  // ...at this speed or more,
+                                                       // ...or at twice the AGL at any speed
+
+    TerrainLodStack() = default;
+
+    TerrainLodStack(const TerrainLodStack&) = delete;
+    TerrainLodStack& operator=(const TerrainLodStack&) = delete;
+
+    static TerrainLod selectLod(const TerrainLodQuery& query);
+
+    // Levels may be shared between stacks; null removes one
+    void setSrtm1(std::shared_ptr<SRTMLoader> loader) { srtm1_ = std::move(loader); }
+    void setSrtm3(std::shared_ptr<SRTMLoader> loader) { srtm3_ = std::move(loader); }
+    void setCoarse(std::shared_ptr<const TerrainMaxPyramid> pyramid) { coarse_ = std::move(pyramid); }
+    bool hasLevel(TerrainLod lod) const;
+    const std::shared_ptr<const TerrainMaxPyramid>& getCoarse() const { return coarse_; }
+
+    // Elevation in feet MSL from lod or the nearest level with data;
+    // served (optional) names the level that answered. False if none did.
+    bool getElevation(double latitude, double longitude, TerrainLod lod,
+                      double& elevationFt, TerrainLod* served = nullptr) const;
+
+    // Batched getElevation, one level per point; 0 ft where no level has data
+    void getElevations(const LatLon* points, const TerrainLod* lods, size_t count, double* outFt) const;
+
+    TerrainLodStats getStats() const;
+
+private:
+    bool sampleLevel(TerrainLod lod, double latitude, double longitude, double& elevationFt) const;
+
+    std::shared_ptr<SRTMLoader> srtm1_;
+    std::shared_ptr<SRTMLoader> srtm3_;
+    std::shared_ptr<const TerrainMaxPyramid> coarse_;
+
+    mutable std::atomic<uint64_t> served_[TERRAIN_LOD_COUNT] = {};
+    mutable std::atomic<uint64_t> fallbacks_{0};
+    mutable std::atomic<uint64_t> unavailable_{0};
+};
+
+} // namespace AICopilot
+
+#endif // TERRAIN_LOD_HPP
@@ -0,0 +1,140 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Terrain Look-Ahead - predictive TAWS corridor along the projected path
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TERRAIN_LOOKAHEAD_HPP
+#define TERRAIN_LOOKAHEAD_HPP
+
+#include "aicopilot_types.h"
+#include "tile_cache.hpp"
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace AICopilot {
+
+// Terrain warning levels (TAWS/EGPWS)
+enum class TerrainWarningLevel {
+    NONE,
+    CAUTION,          // "CAUTION TERRAIN"
+    WARNING,          // "TERRAIN TERRAIN"
+    PULL_UP           // "PULL UP, PULL UP"
+};
+
+// Kinematic state the path is projected from
+struct TerrainLookaheadInput {
+    Position position;
+    double altitude = 0.0;           // feet MSL
+    double trackDeg = 0.0;           // true ground track
+    double groundSpeedKts = 0.0;
+    double verticalSpeedFpm = 0.0;
+    double turnRateDegPerSec = 0.0;  // positive turning right
+
+    // AircraftState has no track or turn rate: use heading, and the coordinated-turn rate for the bank
+    static TerrainLookaheadInput fromAircraftState(const AircraftState& state);
+};
+
+struct TerrainLookaheadResult {
+    TerrainWarningLevel level = TerrainWarningLevel::NONE;
+    double timeToConflict = -1.0;    // seconds to the first slice inside the clearance floor, -1 if none
+    double minimumClearance = 0.0;   // feet, predicted altitude minus corridor terrain, over the horizon
+    Position conflictPosition;       // centre of the first conflicting slice
+    double conflictTerrain = 0.0;    // feet MSL, highest terrain in that slice
+    size_t slices = 0;               // slices covering the horizon
+    size_t slicesSampled = 0;        // slices sampled this update (the rest were reused)
+};
+
+/**
+ * Predictive terrain look-ahead over a swept corridor
+ *
+ * The path is projected LOOKAHEAD_SECONDS ahead as a constant-rate turn
+ * and cut into slices at even ground spacing. Each slice samples terrain
+ * at LATERAL_SAMPLES points across a corridor that widens with distance,
+ * through one batched elevation call per update, and keeps only its
+ * highest sample. Slices are earth-fixed: on the next update those still
+ * ahead of the aircraft and within REUSE_TOLERANCE_NM of the new path are
+ * kept, and only the slices beyond the old horizon (or after the first
+ * mismatch, when the track or turn changes) are sampled again. In steady
+ * flight that is a slice or two per update instead of the whole corridor.
+ *
+ * Altitude is re-projected for every slice on each update, so vertical
+ * speed changes take effect immediately without any terrain sampling.
+ * Not thread-safe.
+ */
+class TerrainLookahead {
+public:
+    // Elevations in feet MSL for count points
+    using ElevationBatch = std::function<void(const LatLon* points, size_t count, double* outFt)>;
+
+    static constexpr double LOOKAHEAD_SECONDS = 90.0;     // clamped to 60-120 by setLookaheadTime
+    static constexpr int LATERAL_SAMPLES = 5;             // odd, so one sample sits on the path
+    static constexpr size_t MAX_SLICES = 128;
+    static constexpr double MIN_SLICE_SPACING_NM = 0.05;
+    static constexpr double BASE_HALF_WIDTH_NM = 0.25;
+    static constexpr double HALF_WIDTH_GROWTH = 0.05;     // extra half-width per NM ahead
+    static constexpr double REUSE_TOLERANCE_NM = 0.05;
+    static constexpr double MAX_TURN_DEG = 180.0;          // the projection stops turning after this
+    static constexpr double MIN_GROUND_SPEED_KTS = 30.0;
+
+    // Alert envelope
+    static constexpr double REQUIRED_CLEARANCE_FT = 500.0;
+    static constexpr double CAUTION_TIME_S = 60.0;
+    static constexpr double WARNING_TIME_S = 30.0;
+
+    TerrainLookahead() = default;
+
+    void setLookaheadTime(double seconds);
+    double getLookaheadTime() const { return lookaheadSeconds_; }
+
+    // Project the path, refresh the corridor and evaluate the alert envelope
+    const TerrainLookaheadResult& update(const TerrainLookaheadInput& input, const ElevationBatch& elevations);
+
+    const TerrainLookaheadResult& getResult() const { return result_; }
+
+    // Drop the corridor so the next update samples it from scratch
+    void reset();
+
+private:
+    struct Slice {
+        Position center;
+        double halfWidthNM = 0.0;
+        double terrainMax = 0.0;     // feet MSL
+    };
+
+    struct Path {
+        Position origin;
+        double trackRad = 0.0;
+        double curvature = 0.0;      // radians of track change per NM
+        double maxTurnNM = 0.0;      // distance after which the projection runs straight
+        double cosLat = 1.0;
+    };
+
+    Path makePath(const TerrainLookaheadInput& input) const;
+    Position pointAt(const Path& path, double distanceNM, double& trackRad) const;
+    void offsetNM(const Path& path, const Position& p, double& eastNM, double& northNM) const;
+    size_t retainSlices(const Path& path);
+    void sampleSlices(const Path& path, size_t firstNew, size_t count, const ElevationBatch& elevations);
+    void evaluate(const TerrainLookaheadInput& input);
+
+    double lookaheadSeconds_ = LOOKAHEAD_SECONDS;
+    double spacingNM_ = 0.0;
+    double firstSliceNM_ = 0.0;      // distance from the aircraft to slices_.front()
+    std::deque<Slice> slices_;       // nearest first, spacingNM_ apart along the path
+    TerrainLookaheadResult result_;
+
+    // Reused across updates to keep sampling allocation-free
+    std::vector<LatLon> points_;
+    std::vector<double> elevations_;
+};
+
+} // namespace AICopilot
+
+#endif // TERRAIN_LOOKAHEAD_HPP
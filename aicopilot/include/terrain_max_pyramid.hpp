@@ -0,0 +1,96 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Terrain Max Pyramid - resident, conservative coarse terrain levels
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TERRAIN_MAX_PYRAMID_HPP
+#define TERRAIN_MAX_PYRAMID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace AICopilot {
+
+class SRTMLoader;
+
+/**
+ * Highest terrain per grid cell, at a base resolution and every power of
+ * two coarser
+ *
+ * Level 0 covers [minLatitude, minLatitude + latitudeTiles] x
+ * [minLongitude, minLongitude + longitudeTiles] with cellsPerDegree cells
+ * per degree, row 0 on the south edge and column 0 on the west edge. Each
+ * cell holds the highest elevation inside it, rounded up to whole feet;
+ * each coarser level's cell is the maximum of the (up to) four below it,
+ * up to a level that is a single cell. Any query therefore returns terrain
+ * at or above the truth wherever the source was conservative, which is
+ * what lets clearance checks run on coarse cells without missing a peak.
+ *
+ * A 1° x 1° area costs about 29 KB at the default 30 arc-second cells, so
+ * a pyramid stays resident while the fine tiles it was built from do not.
+ * Read-only after build(); queries are thread-safe.
+ */
+class TerrainMaxPyramid {
+public:
+    // Highest terrain (feet MSL) in [south, north] x [west, east]; false if no data
+    using CellMax = std::function<bool(double south, double west, double north, double east, double& maxFt)>;
+
+    static constexpr int DEFAULT_CELLS_PER_DEGREE = 120;   // 30 arc-seconds
+    static constexpr int16_t NO_DATA = -32768;
+
+    TerrainMaxPyramid() = default;
+
+    // Level 0 from one cellMax call per cell, then the coarser levels
+    bool build(int minLatitude, int minLongitude, int latitudeTiles, int longitudeTiles,
+               const CellMax& cellMax, int cellsPerDegree = DEFAULT_CELLS_PER_DEGREE);
+
+    // build() from an SRTM loader's tile pyramids (SRTMLoader::GetMaxElevation),
+    // which widen each cell by up to one SRTMTile::PYRAMID_BLOCK
+    bool buildFromSrtm(SRTMLoader& loader, int minLatitude, int minLongitude,
+                       int latitudeTiles, int longitudeTiles,
+                       int cellsPerDegree = DEFAULT_CELLS_PER_DEGREE);
+
+    bool isBuilt() const { return !levels_.empty(); }
+    size_t getLevelCount() const { return levels_.size(); }
+    int getRows(size_t level) const { return levels_[level].rows; }
+    int getCols(size_t level) const { return levels_[level].cols; }
+    double getCellDegrees(size_t level) const { return cellDegrees_ * static_cast<double>(1u << level); }
+    size_t getMemoryUsage() const;
+
+    // Cell maximum in feet MSL, NO_DATA for cells without data or outside the grid
+    int16_t getCell(size_t level, int row, int col) const;
+
+    // Cell at a level holding a point; false outside the grid
+    bool cellOf(size_t level, double latitude, double longitude, int& row, int& col) const;
+
+    // Highest terrain in the cell holding a point; false outside the grid or over no data
+    bool getMaxElevation(double latitude, double longitude, size_t level, double& maxFt) const;
+
+    // Highest terrain in a box, scanning the finest level at which the box
+    // spans at most two cells per side; false if nothing in it has data
+    bool getMaxElevation(double south, double west, double north, double east, double& maxFt) const;
+
+private:
+    struct Level {
+        int rows = 0;
+        int cols = 0;
+        std::vector<int16_t> cells;   // row-major, south row first
+    };
+
+    int minLatitude_ = 0;
+    int minLongitude_ = 0;
+    double cellDegrees_ = 0.0;        // level 0
+    std::vector<Level> levels_;
+};
+
+} // namespace AICopilot
+
+#endif // TERRAIN_MAX_PYRAMID_HPP
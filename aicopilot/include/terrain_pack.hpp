@@ -0,0 +1,173 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Terrain Pack - compiled, memory-mapped terrain elevation format
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TERRAIN_PACK_HPP
+#define TERRAIN_PACK_HPP
+
+#include "tile_cache.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+
+// Per-tile sample encoding
+enum class TerrainPackEncoding : uint8_t {
+    RAW = 0,      // little-endian int16 feet, sampled straight from the mapping
+    DELTA = 1     // zigzag varint deltas along each row, decoded into a cache on first use
+};
+
+/*
+ * On-disk layout (little-endian, sections 8-byte aligned):
+ *
+ *   TerrainPackHeader
+ *   uint32 lookup[latitudeSpan * longitudeSpan]   tile index per 1° cell, NO_TILE if absent
+ *   TerrainPackTileEntry entries[tileCount]       sorted by TileKey
+ *   tile payloads
+ *
+ * Each tile is a samplesPerEdge x samplesPerEdge grid of elevations in feet
+ * MSL covering [lat, lat+1] x [lon, lon+1], row 0 on the north edge and
+ * column 0 on the west edge (SRTM order); edge rows and columns are shared
+ * with the neighbouring tiles. VOID_SAMPLE marks missing data.
+ */
+#pragma pack(push, 1)
+struct TerrainPackHeader {
+    char magic[4];              // "ATPK"
+    uint16_t version;
+    uint16_t samplesPerEdge;
+    uint32_t tileCount;
+    int16_t minLatitude;        // south-west tile corner of the lookup grid
+    int16_t minLongitude;
+    uint16_t latitudeSpan;      // lookup grid size in 1° tiles
+    uint16_t longitudeSpan;
+    int16_t minElevation;       // feet MSL over all tiles
+    int16_t maxElevation;
+    uint64_t lookupOffset;
+    uint64_t entriesOffset;
+    uint64_t fileSize;
+};
+
+struct TerrainPackTileEntry {
+    uint32_t key;               // packTileKey(lat, lon)
+    uint8_t encoding;           // TerrainPackEncoding
+    uint8_t reserved;
+    int16_t minElevation;       // feet MSL within the tile
+    int16_t maxElevation;
+    uint16_t reserved2;
+    uint32_t size;              // payload bytes
+    uint64_t offset;            // payload position from the start of the file
+};
+#pragma pack(pop)
+
+static_assert(sizeof(TerrainPackHeader) == 48, "TerrainPackHeader layout");
+static_assert(sizeof(TerrainPackTileEntry) == 24, "TerrainPackTileEntry layout");
+
+/**
+ * Offline builder for terrain packs
+ *
+ * Scattered points (CSV rows, raster pixels or SRTM posts) are binned onto
+ * the grid sample nearest to them, keeping the highest elevation per sample
+ * so downsampling never hides a peak. On write, void samples on tile edges
+ * are stitched from the neighbouring tile and the rest are filled from
+ * their nearest populated neighbours, so a sparse tile still answers every
+ * query inside it.
+ */
+class TerrainPackBuilder {
+public:
+    static constexpr int DEFAULT_SAMPLES_PER_EDGE = 121;  // 30 arc-second spacing
+
+    explicit TerrainPackBuilder(int samplesPerEdge = DEFAULT_SAMPLES_PER_EDGE);
+
+    // Add an elevation sample (feet MSL)
+    void addPoint(double latitude, double longitude, double elevationFt);
+
+    int getSamplesPerEdge() const { return samplesPerEdge_; }
+    size_t getTileCount() const { return tiles_.size(); }
+    size_t getPointCount() const { return pointCount_; }
+
+    // Write the pack; DELTA falls back to RAW for tiles it would not shrink
+    bool write(const std::string& path, TerrainPackEncoding encoding = TerrainPackEncoding::DELTA);
+
+private:
+    void fillVoids();
+
+    int samplesPerEdge_;
+    size_t pointCount_ = 0;
+    std::map<TileKey, std::vector<int16_t>> tiles_;  // sorted so entries come out in key order
+};
+
+/**
+ * Read-only terrain pack backed by a file mapping
+ *
+ * open() maps the file and validates the header; nothing is parsed or
+ * copied, so it takes the same time for a city as for a continent. The
+ * lookup grid finds a tile in O(1) and RAW tiles are sampled in place.
+ * DELTA tiles are decoded on first use into a byte-budgeted TileCache.
+ * Queries are thread-safe.
+ */
+class TerrainPack {
+public:
+    static constexpr char MAGIC[4] = {'A', 'T', 'P', 'K'};
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint32_t NO_TILE = 0xFFFFFFFFu;
+    static constexpr int16_t VOID_SAMPLE = -32768;
+    static constexpr size_t DEFAULT_DECODE_BUDGET = 64 * 1024 * 1024;
+
+    TerrainPack() = default;
+    ~TerrainPack();
+
+    TerrainPack(const TerrainPack&) = delete;
+    TerrainPack& operator=(const TerrainPack&) = delete;
+
+    // True if the file starts with the pack magic
+    static bool isPackFile(const std::string& path);
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+
+    // Bilinear elevation in feet MSL; false outside the pack or over void data
+    bool getElevation(double latitude, double longitude, double& elevationFt) const;
+
+    // Tile minimum/maximum from the index, without touching the payload
+    bool getTileRange(int tileLatitude, int tileLongitude, double& minFt, double& maxFt) const;
+
+    bool hasTile(int tileLatitude, int tileLongitude) const { return findEntry(tileLatitude, tileLongitude) != nullptr; }
+    size_t getTileCount() const { return isOpen() ? header().tileCount : 0; }
+    int getSamplesPerEdge() const { return isOpen() ? header().samplesPerEdge : 0; }
+    size_t getMappedSize() const { return size_; }
+
+    void setDecodeBudget(size_t bytes);
+    TileCacheStats getDecodeCacheStats() const;
+
+private:
+    using DecodedTile = std::vector<int16_t>;
+
+    const TerrainPackHeader& header() const { return *reinterpret_cast<const TerrainPackHeader*>(data_); }
+    const TerrainPackTileEntry* findEntry(int tileLatitude, int tileLongitude) const;
+    std::shared_ptr<DecodedTile> decodeTile(const TerrainPackTileEntry& entry) const;
+    bool validate() const;
+
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    void* fileHandle_ = nullptr;      // Windows
+    void* mappingHandle_ = nullptr;   // Windows
+
+    mutable std::mutex decodeMutex_;
+    mutable TileCache<DecodedTile> decoded_{DEFAULT_DECODE_BUDGET};
+};
+
+} // namespace AICopilot
+
+#endif // TERRAIN_PACK_HPP
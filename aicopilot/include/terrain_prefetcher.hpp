@@ -0,0 +1,118 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Terrain Prefetcher - background tile loading ahead of the aircraft
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TERRAIN_PREFETCHER_HPP
+#define TERRAIN_PREFETCHER_HPP
+
+#include "aicopilot_types.h"
+#include "io_executor.hpp"
+#include "navigation.h"
+#include "tile_cache.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace AICopilot {
+
+struct TerrainPrefetchStats {
+    uint64_t requested = 0;     // tiles queued
+    uint64_t loaded = 0;        // loader reported the tile resident
+    uint64_t unavailable = 0;   // loader found no data
+    uint64_t dropped = 0;       // queue was full
+    size_t pending = 0;         // queued or loading now
+};
+
+/**
+ * Loads terrain tiles in the background before the aircraft reaches them
+ *
+ * Two sources feed the queue: the remaining flight plan legs (up to
+ * ROUTE_HORIZON_NM ahead, so a long route cannot thrash a small cache) and
+ * a look-ahead cone around the current ground track, which is queued ahead
+ * of the route because it is where the next lookups will land. Duplicate
+ * requests for a tile that is already queued are ignored.
+ *
+ * The prefetcher is loader-agnostic: it calls TileLoader with tile
+ * coordinates, e.g. SRTMLoader::PrefetchTile or TerrainDatabase::prefetchTile,
+ * whose lookups report PENDING until the tile arrives.
+ *
+ * Loads run on an IoExecutor, one tile per job, re-posted while the queue
+ * holds more; at most one load is in flight, so tiles arrive in queue
+ * order and the loader is never entered twice at once.
+ */
+class TerrainPrefetcher {
+public:
+    // Blocking load of one tile; returns true if the tile is resident afterwards
+    using TileLoader = std::function<bool(int tileLatitude, int tileLongitude)>;
+
+    static constexpr size_t MAX_PENDING_TILES = 64;
+    static constexpr double SAMPLE_SPACING_NM = 10.0;       // well under a tile width
+    static constexpr double ROUTE_HORIZON_NM = 150.0;
+    static constexpr double LOOKAHEAD_MIN_NM = 20.0;
+    static constexpr double LOOKAHEAD_MINUTES = 10.0;
+    static constexpr double CONE_HALF_ANGLE_DEG = 20.0;
+
+    // A null executor uses IoExecutor::shared()
+    explicit TerrainPrefetcher(TileLoader loader, std::shared_ptr<IoExecutor> executor = nullptr);
+    ~TerrainPrefetcher();
+
+    TerrainPrefetcher(const TerrainPrefetcher&) = delete;
+    TerrainPrefetcher& operator=(const TerrainPrefetcher&) = delete;
+
+    // Requests queue up before start(); stop() drops whatever is still queued
+    void start();
+    void stop();
+    bool isRunning() const;
+
+    // Queue one tile; urgent tiles go to the front. Returns false if already queued or full.
+    bool request(int tileLatitude, int tileLongitude, bool urgent = false);
+
+    // Queue tiles under the remaining legs of the active flight plan; returns tiles queued
+    size_t prefetchRoute(const Navigation& navigation, const Position& current);
+    size_t prefetchRoute(const std::vector<Waypoint>& waypoints, size_t fromIndex,
+                         const Position& current);
+
+    // Queue tiles in a cone along the ground track, nearest first; returns tiles queued
+    size_t prefetchLookAhead(const Position& current, double trackDeg, double groundSpeedKts);
+
+    // Block until the queue is drained; returns at once if not started
+    void waitIdle();
+
+    TerrainPrefetchStats getStats() const;
+
+    // Tile containing a coordinate
+    static TileKey tileFor(double latitude, double longitude);
+
+private:
+    // Caller holds mutex_
+    void schedule();
+    void loadNext();
+    size_t queueSegment(const Position& from, const Position& to, double& budgetNM);
+
+    TileLoader loader_;
+    std::shared_ptr<IoExecutor> executor_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable idleCv_;
+    std::deque<TileKey> queue_;
+    std::unordered_set<TileKey> pending_;  // queued or loading, guarded by mutex_
+    bool running_ = false;                 // between start() and stop(), guarded by mutex_
+    bool loading_ = false;                 // a load job is posted or running
+    TerrainPrefetchStats stats_;
+};
+
+} // namespace AICopilot
+
+#endif // TERRAIN_PREFETCHER_HPP
@@ -0,0 +1,101 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Tick Watchdog - tick budget tracking with staged, reversible degradation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TICK_WATCHDOG_HPP
+#define TICK_WATCHDOG_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+
+class SystemMonitor;
+
+/**
+ * Watchdog state for reporting
+ */
+struct TickWatchdogStats {
+    uint64_t ticks = 0;
+    uint64_t overruns = 0;
+    double budgetMs = 0.0;
+    double lastTickMs = 0.0;
+    double maxTickMs = 0.0;
+    size_t level = 0;                        // degradation steps applied
+    std::vector<std::string> activeSteps;    // in the order applied
+    uint64_t levelChanges = 0;
+};
+
+/**
+ * Measures every tick against a budget and trades fidelity for timing
+ *
+ * Degradation steps are registered in priority order, the most expendable
+ * first. When at least DEGRADE_OVERRUNS of the last WINDOW_TICKS ticks ran
+ * over budget, the next step is applied; after RECOVER_TICKS ticks in a row
+ * within budget, the most recently applied step is undone. Either change
+ * is followed by WINDOW_TICKS ticks without another, so a step gets a
+ * whole window to take effect before the next one is judged necessary.
+ *
+ * Steps run on the ticking thread, from recordTick(). Level changes are
+ * reported to an attached SystemMonitor.
+ */
+class TickWatchdog {
+public:
+    using Clock = std::chrono::steady_clock;
+    using DegradationStep = std::function<void(bool degraded)>;   // true to shed load, false to restore
+
+    static constexpr size_t WINDOW_TICKS = 30;       // 1 s at the 30 Hz control rate
+    static constexpr size_t DEGRADE_OVERRUNS = 10;   // a third of the window
+    static constexpr size_t RECOVER_TICKS = 150;     // 5 s at 30 Hz
+
+    explicit TickWatchdog(Clock::duration budget);
+
+    void addStep(const std::string& name, DegradationStep step);
+    void setSystemMonitor(SystemMonitor* monitor) { monitor_ = monitor; }
+
+    // Account one tick; may apply or undo a step
+    void recordTick(Clock::duration elapsed);
+
+    // Undo every applied step, newest first
+    void restoreAll();
+
+    size_t getLevel() const;
+    TickWatchdogStats getStats() const;
+
+private:
+    struct Step {
+        std::string name;
+        DegradationStep apply;
+    };
+
+    Clock::duration budget_;
+    std::vector<Step> steps_;
+    SystemMonitor* monitor_ = nullptr;
+
+    std::array<bool, WINDOW_TICKS> window_{};   // overrun flags, ring
+    size_t windowHead_ = 0;
+    size_t windowOverruns_ = 0;
+    size_t withinBudgetStreak_ = 0;
+    size_t ticksSinceChange_ = WINDOW_TICKS;
+
+    mutable std::mutex statsMutex_;             // guards stats_ for other threads
+    TickWatchdogStats stats_;
+
+    void changeLevel(bool degrade);
+};
+
+} // namespace AICopilot
+
+#endif // TICK_WATCHDOG_HPP
@@ -0,0 +1,282 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Tile Cache - byte-budgeted LRU cache for 1° x 1° terrain tiles
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TILE_CACHE_HPP
+#define TILE_CACHE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace AICopilot {
+
+// Packed (lat, lon) tile coordinate; lat -90..90 and lon -180..180 both fit in 16 bits
+using TileKey = uint32_t;
+
+constexpr TileKey packTileKey(int tileLatitude, int tileLongitude) {
+    return (static_cast<uint32_t>(tileLatitude + 90) << 16) |
+           static_cast<uint32_t>(tileLongitude + 180);
+}
+
+constexpr int tileKeyLatitude(TileKey key) { return static_cast<int>(key >> 16) - 90; }
+constexpr int tileKeyLongitude(TileKey key) { return static_cast<int>(key & 0xFFFF) - 180; }
+
+/**
+ * Raster cell containing a point, at samplesPerDegree cells per degree
+ *
+ * Rows count down from the tile's north edge and columns east from its
+ * west edge, as in SRTM. The cell spans posts (row, col) to (row+1, col+1);
+ * the fractions locate the point between them.
+ */
+struct RasterCell {
+    int tileLatitude = 0;
+    int tileLongitude = 0;
+    uint32_t row = 0;
+    uint32_t col = 0;
+    double rowFraction = 0.0;
+    double colFraction = 0.0;
+
+    // Unique per (tile, row, col) for resolutions up to 65536 cells per degree
+    uint64_t key() const {
+        return (static_cast<uint64_t>(packTileKey(tileLatitude, tileLongitude)) << 32) |
+               (static_cast<uint64_t>(row) << 16) | col;
+    }
+
+    // Post latitude/longitude of the north-west corner
+    double northLatitude(int samplesPerDegree) const {
+        return tileLatitude + 1.0 - static_cast<double>(row) / samplesPerDegree;
+    }
+    double westLongitude(int samplesPerDegree) const {
+        return tileLongitude + static_cast<double>(col) / samplesPerDegree;
+    }
+};
+
+inline RasterCell locateRasterCell(double latitude, double longitude, int samplesPerDegree) {
+    RasterCell cell;
+    double lat = std::max(-90.0, std::min(latitude, 90.0));
+    double lon = std::max(-180.0, std::min(longitude, 180.0));
+    cell.tileLatitude = std::min(static_cast<int>(std::floor(lat)), 89);
+    cell.tileLongitude = std::min(static_cast<int>(std::floor(lon)), 179);
+
+    double rowPos = (cell.tileLatitude + 1.0 - lat) * samplesPerDegree;
+    double colPos = (lon - cell.tileLongitude) * samplesPerDegree;
+    int row = std::max(0, std::min(static_cast<int>(rowPos), samplesPerDegree - 1));
+    int col = std::max(0, std::min(static_cast<int>(colPos), samplesPerDegree - 1));
+    cell.row = static_cast<uint32_t>(row);
+    cell.col = static_cast<uint32_t>(col);
+    cell.rowFraction = std::max(0.0, std::min(rowPos - row, 1.0));
+    cell.colFraction = std::max(0.0, std::min(colPos - col, 1.0));
+    return cell;
+}
+
+// The four posts around a raster cell, cached so interpolation needs no source lookup
+struct CellCorners {
+    double northWest = 0.0;
+    double northEast = 0.0;
+    double southWest = 0.0;
+    double southEast = 0.0;
+
+    double interpolate(double rowFraction, double colFraction) const {
+        double north = northWest + (northEast - northWest) * colFraction;
+        double south = southWest + (southEast - southWest) * colFraction;
+        return north + (south - north) * rowFraction;
+    }
+};
+
+// Query point for batched elevation lookups
+struct LatLon {
+    double latitude = 0.0;    // degrees
+    double longitude = 0.0;   // degrees
+};
+
+// Result of a lookup that must not block on disk I/O
+enum class TileLookupStatus {
+    READY,      // tile resident, value is exact
+    PENDING,    // tile not loaded yet, value is a conservative placeholder
+    NO_DATA     // no tile exists for this location
+};
+
+struct TileCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t tiles = 0;
+    size_t bytes = 0;        // sum of the charges of cached tiles
+    size_t byteBudget = 0;
+    uint64_t lockContentions = 0;   // filled in by owners that lock the cache
+};
+
+/**
+ * LRU cache of terrain tiles keyed by packed integer coordinates
+ *
+ * Key defaults to TileKey; any hashable key works, so other byte-budgeted
+ * caches (airport layouts by ICAO) reuse the same recency list.
+ *
+ * Entries live in an unordered_map (node addresses are stable across
+ * rehash) and are threaded onto an intrusive doubly linked recency list,
+ * so find, insert and evict are all O(1). Capacity is a byte budget: each
+ * tile is charged its own size on insert and least recently used tiles are
+ * evicted until the new one fits. The most recent tile is never evicted,
+ * so a tile larger than the budget still stays usable until the next insert.
+ *
+ * Not thread-safe; owners serialize access with their own lock. Tiles are
+ * handed out by shared_ptr so an evicted tile outlives any caller still
+ * sampling it.
+ */
+template <typename Tile, typename Key = TileKey>
+class TileCache {
+public:
+    explicit TileCache(size_t byteBudget) : byteBudget_(byteBudget) {}
+
+    TileCache(const TileCache&) = delete;
+    TileCache& operator=(const TileCache&) = delete;
+
+    // Cached tile for key (now most recently used), or nullptr; counts a hit or miss
+    std::shared_ptr<Tile> find(const Key& key) {
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            misses_++;
+            return nullptr;
+        }
+        hits_++;
+        touch(&it->second);
+        return it->second.tile;
+    }
+
+    // Like find() but leaves recency and counters alone
+    bool contains(const Key& key) const { return entries_.count(key) != 0; }
+
+    // Insert or replace the tile for key, charged at bytes, then evict down to the budget
+    void insert(const Key& key, std::shared_ptr<Tile> tile, size_t bytes) {
+        auto result = entries_.try_emplace(key);
+        Entry* entry = &result.first->second;
+        if (result.second) {
+            entry->key = key;
+        } else {
+            unlink(entry);
+            bytes_ -= entry->bytes;
+        }
+        entry->tile = std::move(tile);
+        entry->bytes = bytes;
+        bytes_ += bytes;
+        pushFront(entry);
+        trim();
+    }
+
+    bool erase(const Key& key) {
+        auto it = entries_.find(key);
+        if (it == entries_.end()) return false;
+        unlink(&it->second);
+        bytes_ -= it->second.bytes;
+        entries_.erase(it);
+        return true;
+    }
+
+    void clear() {
+        entries_.clear();
+        head_ = nullptr;
+        tail_ = nullptr;
+        bytes_ = 0;
+    }
+
+    // Shrinking the budget evicts immediately
+    void setByteBudget(size_t byteBudget) {
+        byteBudget_ = byteBudget;
+        trim();
+    }
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    size_t getBytes() const { return bytes_; }
+    size_t getByteBudget() const { return byteBudget_; }
+
+    TileCacheStats getStats() const {
+        TileCacheStats stats;
+        stats.hits = hits_;
+        stats.misses = misses_;
+        stats.evictions = evictions_;
+        stats.tiles = entries_.size();
+        stats.bytes = bytes_;
+        stats.byteBudget = byteBudget_;
+        return stats;
+    }
+
+    void resetStats() {
+        hits_ = 0;
+        misses_ = 0;
+        evictions_ = 0;
+    }
+
+    // Visit tiles from most to least recently used
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const Entry* entry = head_; entry != nullptr; entry = entry->next) {
+            fn(entry->key, *entry->tile);
+        }
+    }
+
+private:
+    struct Entry {
+        Key key{};
+        std::shared_ptr<Tile> tile;
+        size_t bytes = 0;
+        Entry* prev = nullptr;
+        Entry* next = nullptr;
+    };
+
+    void unlink(Entry* entry) {
+        if (entry->prev) entry->prev->next = entry->next; else head_ = entry->next;
+        if (entry->next) entry->next->prev = entry->prev; else tail_ = entry->prev;
+        entry->prev = nullptr;
+        entry->next = nullptr;
+    }
+
+    void pushFront(Entry* entry) {
+        entry->prev = nullptr;
+        entry->next = head_;
+        if (head_) head_->prev = entry; else tail_ = entry;
+        head_ = entry;
+    }
+
+    void touch(Entry* entry) {
+        if (entry == head_) return;
+        unlink(entry);
+        pushFront(entry);
+    }
+
+    void trim() {
+        while (bytes_ > byteBudget_ && tail_ != nullptr && tail_ != head_) {
+            Entry* victim = tail_;
+            unlink(victim);
+            bytes_ -= victim->bytes;
+            entries_.erase(victim->key);
+            evictions_++;
+        }
+    }
+
+    std::unordered_map<Key, Entry> entries_;
+    Entry* head_ = nullptr;   // most recently used
+    Entry* tail_ = nullptr;   // least recently used
+    size_t bytes_ = 0;
+    size_t byteBudget_;
+
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+};
+
+} // namespace AICopilot
+
+#endif // TILE_CACHE_HPP
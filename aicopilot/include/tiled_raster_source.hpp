@@ -0,0 +1,170 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Tiled Raster Source - block-windowed elevation reads from large DEM rasters
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TILED_RASTER_SOURCE_HPP
+#define TILED_RASTER_SOURCE_HPP
+
+#include "tile_cache.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * One resolution of a raster: the full-resolution band or an overview
+ *
+ * North-up geographic rasters only: originLongitude/originLatitude are the
+ * outer corner of pixel (0, 0) and pixelHeight is negative, as in a GDAL
+ * geotransform without rotation terms.
+ */
+struct RasterLevel {
+    int width = 0;              // pixels
+    int height = 0;
+    int blockWidth = 0;         // native block (tile or strip) size in pixels
+    int blockHeight = 0;
+    double originLongitude = 0.0;
+    double originLatitude = 0.0;
+    double pixelWidth = 0.0;    // degrees
+    double pixelHeight = 0.0;   // degrees, negative for north-up
+
+    int blocksAcross() const { return (width + blockWidth - 1) / blockWidth; }
+    int blocksDown() const { return (height + blockHeight - 1) / blockHeight; }
+};
+
+struct TiledRasterStats {
+    TileCacheStats cache;          // resident blocks; lockContentions unused
+    uint64_t blockReads = 0;       // reader calls, on demand or prefetched
+    uint64_t readFailures = 0;
+    uint64_t prefetchQueued = 0;
+    uint64_t prefetchDropped = 0;  // queue was full
+    size_t pending = 0;            // queued or loading now
+};
+
+/**
+ * Elevation lookups served from block-aligned windows of a large raster
+ *
+ * Nothing is read up front. A lookup reads the native block holding its
+ * pixels through the BlockReader and keeps it in a byte-budgeted
+ * TileCache, so a multi-gigabyte cloud-optimized GeoTIFF costs only the
+ * blocks near the aircraft. Overviews are separate levels; callers pass
+ * the ground resolution they need and are served from the coarsest level
+ * that is still at least that fine.
+ *
+ * prefetch() queues the blocks around a point for a background thread,
+ * which starts on the first request. Block reads happen without the cache
+ * lock held; a block requested by a lookup and the prefetcher at once is
+ * read twice and the later insert wins.
+ *
+ * All methods are thread-safe. The reader may be called from lookup
+ * threads and the prefetch thread at once and must serialize itself if
+ * its backend is not thread-safe (a GDAL dataset is not).
+ */
+class TiledRasterSource {
+public:
+    // Fill out with blockWidth * blockHeight elevations in feet, NaN for no data
+    using BlockReader = std::function<bool(size_t level, int blockX, int blockY, float* out)>;
+
+    static constexpr size_t DEFAULT_BYTE_BUDGET = 64 * 1024 * 1024;
+    static constexpr size_t MAX_PENDING_BLOCKS = 256;
+
+    // levels[0] is full resolution, then coarser overviews in any order
+    TiledRasterSource(std::vector<RasterLevel> levels, BlockReader reader,
+                      size_t byteBudget = DEFAULT_BYTE_BUDGET);
+    ~TiledRasterSource();
+
+    TiledRasterSource(const TiledRasterSource&) = delete;
+    TiledRasterSource& operator=(const TiledRasterSource&) = delete;
+
+    /**
+     * Open a GeoTIFF (or any raster GDAL reads) with band 1 as elevation
+     * Band units of ft/foot/feet are kept, anything else is taken as
+     * meters. Returns nullptr without ENABLE_GDAL, or for rasters that are
+     * rotated or cannot be opened.
+     */
+    static std::shared_ptr<TiledRasterSource> openGdal(const std::string& path,
+                                                       size_t byteBudget = DEFAULT_BYTE_BUDGET);
+
+    size_t getLevelCount() const { return levels_.size(); }
+    const RasterLevel& getLevel(size_t level) const { return levels_[level]; }
+
+    // Coarsest level whose pixels are no larger than resolutionDeg; 0 (full
+    // resolution) when none is, or for resolutionDeg <= 0
+    size_t selectLevel(double resolutionDeg) const;
+
+    // Bilinear elevation in feet; false outside the raster or over no data.
+    // Reads missing blocks on the calling thread.
+    bool getElevation(double latitude, double longitude, double resolutionDeg, double& elevationFt);
+
+    // Batched getElevation; found (optional) flags the points that had data,
+    // the others are set to 0 ft
+    void getElevations(const LatLon* points, size_t count, double resolutionDeg,
+                       double* outFt, bool* found = nullptr);
+
+    // Queue the blocks within radiusDeg of a point at the level for
+    // resolutionDeg, nearest first; returns blocks queued
+    size_t prefetch(double latitude, double longitude, double radiusDeg, double resolutionDeg);
+
+    // Block until the prefetch queue is drained
+    void waitIdle();
+
+    TiledRasterStats getStats() const;
+
+    // Shrinking the budget evicts immediately
+    void setByteBudget(size_t byteBudget);
+
+private:
+    struct Block {
+        std::vector<float> elevations;   // blockWidth * blockHeight, row-major
+    };
+
+    static uint64_t blockKey(size_t level, int blockX, int blockY) {
+        return (static_cast<uint64_t>(level) << 48) |
+               (static_cast<uint64_t>(blockY) << 24) | static_cast<uint64_t>(blockX);
+    }
+
+    // Pixel value (NaN for no data or outside the raster)
+    float samplePixel(size_t level, int x, int y, std::shared_ptr<const Block>& block,
+                      uint64_t& blockId);
+    std::shared_ptr<const Block> acquireBlock(size_t level, int blockX, int blockY);
+    std::shared_ptr<const Block> readBlock(size_t level, int blockX, int blockY);
+    void workerLoop();
+
+    const std::vector<RasterLevel> levels_;
+    const BlockReader reader_;
+
+    mutable std::mutex cacheMutex_;
+    TileCache<const Block, uint64_t> blocks_;
+    uint64_t blockReads_ = 0;             // guarded by cacheMutex_
+    uint64_t readFailures_ = 0;
+
+    // Prefetch queue, guarded by queueMutex_
+    mutable std::mutex queueMutex_;
+    std::condition_variable workCv_;
+    std::condition_variable idleCv_;
+    std::deque<uint64_t> queue_;
+    std::unordered_set<uint64_t> pending_;  // queued or loading
+    uint64_t prefetchQueued_ = 0;
+    uint64_t prefetchDropped_ = 0;
+    bool stopping_ = false;
+    std::thread worker_;                  // started by the first prefetch()
+};
+
+} // namespace AICopilot
+
+#endif // TILED_RASTER_SOURCE_HPP
@@ -0,0 +1,165 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Track Filter - fixed-size track history and alpha-beta smoothing
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TRACK_FILTER_HPP
+#define TRACK_FILTER_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+namespace AICopilot {
+
+// One filtered point of a track in a local north/east/up frame
+struct TrackSample {
+    double time = 0.0;    // seconds
+    double north = 0.0;   // nm
+    double east = 0.0;    // nm
+    double up = 0.0;      // feet
+    double vn = 0.0;      // knots
+    double ve = 0.0;      // knots
+    double vz = 0.0;      // feet per minute
+};
+
+/**
+ * Fixed-capacity ring of the most recent samples
+ *
+ * Storage is inline, so pushing never allocates; once full, each push
+ * overwrites the oldest sample. Index 0 is the oldest retained sample.
+ */
+template <size_t Capacity>
+class TrackHistory {
+    static_assert(Capacity > 0, "TrackHistory needs room for one sample");
+
+public:
+    void push(const TrackSample& sample) {
+        samples_[(start_ + size_) % Capacity] = sample;
+        if (size_ < Capacity) {
+            size_++;
+        } else {
+            start_ = (start_ + 1) % Capacity;
+        }
+    }
+
+    void clear() {
+        start_ = 0;
+        size_ = 0;
+    }
+
+    const TrackSample& operator[](size_t index) const { return samples_[(start_ + index) % Capacity]; }
+    const TrackSample& oldest() const { return (*this)[0]; }
+    const TrackSample& newest() const { return (*this)[size_ - 1]; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    std::array<TrackSample, Capacity> samples_{};
+    size_t start_ = 0;
+    size_t size_ = 0;
+};
+
+/**
+ * Alpha-beta tracker over position reports
+ *
+ * Each report is compared with the position predicted from the previous
+ * estimate; alpha of the residual corrects the position and beta of it
+ * (per second of elapsed time) corrects the velocity. Vertical uses the
+ * same gains. Turn rate is the change in filtered track angle across the
+ * retained history, so it stays steady at low report rates. A gap longer
+ * than MAX_GAP_SECONDS restarts the track from the next report.
+ */
+class AlphaBetaTracker {
+public:
+    static constexpr size_t HISTORY_SIZE = 8;
+    static constexpr double DEFAULT_ALPHA = 0.5;
+    static constexpr double DEFAULT_BETA = 0.2;
+    static constexpr double MAX_GAP_SECONDS = 30.0;
+
+    // Below this speed (knots) track angle is meaningless and turn rate is zero
+    static constexpr double MIN_TURN_SPEED = 5.0;
+
+    explicit AlphaBetaTracker(double alpha = DEFAULT_ALPHA, double beta = DEFAULT_BETA)
+        : alpha_(alpha), beta_(beta) {}
+
+    // Feed one report; the reported velocity only seeds a new track.
+    // Reports at or before the last time are ignored.
+    const TrackSample& update(double time, double north, double east, double up,
+                              double vn, double ve, double vz) {
+        if (!history_.empty()) {
+            double dt = time - state_.time;
+            if (dt <= 0.0) return state_;
+            if (dt <= MAX_GAP_SECONDS) {
+                correct(time, dt, north, east, up);
+                history_.push(state_);
+                return state_;
+            }
+            history_.clear();
+        }
+
+        state_ = {time, north, east, up, vn, ve, vz};
+        history_.push(state_);
+        return state_;
+    }
+
+    // Filtered state as of the last report
+    const TrackSample& state() const { return state_; }
+
+    // Degrees per second, positive turning right
+    double turnRate() const {
+        if (history_.size() < 2) return 0.0;
+        const TrackSample& first = history_.oldest();
+        const TrackSample& last = history_.newest();
+        if (std::hypot(first.vn, first.ve) < MIN_TURN_SPEED || std::hypot(last.vn, last.ve) < MIN_TURN_SPEED) {
+            return 0.0;
+        }
+        constexpr double RAD_TO_DEG = 180.0 / 3.14159265358979323846;
+        // Signed angle from the first track to the last, in (-180, 180]
+        double turned = std::atan2(first.vn * last.ve - first.ve * last.vn,
+                                   first.vn * last.vn + first.ve * last.ve) * RAD_TO_DEG;
+        return turned / (last.time - first.time);
+    }
+
+    const TrackHistory<HISTORY_SIZE>& history() const { return history_; }
+    bool empty() const { return history_.empty(); }
+
+private:
+    void correct(double time, double dt, double north, double east, double up) {
+        constexpr double SECONDS_PER_HOUR = 3600.0;
+        double hours = dt / SECONDS_PER_HOUR;
+        double minutes = dt / 60.0;
+
+        double predictedNorth = state_.north + state_.vn * hours;
+        double predictedEast = state_.east + state_.ve * hours;
+        double predictedUp = state_.up + state_.vz * minutes;
+        double rn = north - predictedNorth;
+        double re = east - predictedEast;
+        double ru = up - predictedUp;
+
+        state_.time = time;
+        state_.north = predictedNorth + alpha_ * rn;
+        state_.east = predictedEast + alpha_ * re;
+        state_.up = predictedUp + alpha_ * ru;
+        state_.vn += beta_ * rn / hours;
+        state_.ve += beta_ * re / hours;
+        state_.vz += beta_ * ru / minutes;
+    }
+
+    double alpha_;
+    double beta_;
+    TrackSample state_;
+    TrackHistory<HISTORY_SIZE> history_;
+};
+
+} // namespace AICopilot
+
+#endif // TRACK_FILTER_HPP
@@ -0,0 +1,142 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Traffic Delta - compact traffic-state frames exchanged between nodes
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TRAFFIC_DELTA_HPP
+#define TRAFFIC_DELTA_HPP
+
+#include "traffic_table.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * Frame layout (all integers LEB128 varints, signed ones zigzagged)
+ *
+ *   uint8   version        VERSION
+ *   uint8   flags          KEYFRAME
+ *   varint  sequence       frames since the encoder was created
+ *   varint  updateCount
+ *   update  updates[updateCount]    ascending object id
+ *   varint  removeCount
+ *   varint  removed[removeCount]    id deltas, ascending
+ *
+ * Each update is an id delta from the previous update, a field mask, then
+ * one zigzag delta per masked field against what the peer last received
+ * (zero in a keyframe). A changed callsign is its length and bytes.
+ */
+struct TrafficDeltaFormat {
+    static constexpr uint8_t VERSION = 1;
+    static constexpr uint8_t KEYFRAME = 0x01;
+
+    // Field mask bits
+    static constexpr uint8_t LATITUDE = 0x01;
+    static constexpr uint8_t LONGITUDE = 0x02;
+    static constexpr uint8_t ALTITUDE = 0x04;
+    static constexpr uint8_t GROUND_SPEED = 0x08;
+    static constexpr uint8_t HEADING = 0x10;
+    static constexpr uint8_t VERTICAL_SPEED = 0x20;
+    static constexpr uint8_t ON_GROUND = 0x40;     // set: on the ground
+    static constexpr uint8_t CALLSIGN = 0x80;
+
+    // Wire resolution; decoded values are within half a unit of the source
+    static constexpr double DEGREES_PER_UNIT = 1e-5;              // ~1 m
+    static constexpr double FEET_PER_UNIT = 1.0;
+    static constexpr double KNOTS_PER_UNIT = 0.1;
+    static constexpr double HEADING_DEGREES_PER_UNIT = 0.01;
+    static constexpr double FPM_PER_UNIT = 1.0;
+};
+
+// One row at wire resolution, as last sent or received
+struct TrafficDeltaRecord {
+    uint32_t objectId = 0;
+    int32_t latitude = 0;
+    int32_t longitude = 0;
+    int32_t altitude = 0;
+    int32_t groundSpeed = 0;
+    int32_t heading = 0;          // 0..35999
+    int32_t verticalSpeed = 0;
+    bool onGround = false;
+    std::string callsign;
+};
+
+/**
+ * Encodes a traffic table as changes since the last frame to one peer
+ *
+ * A node keeps one encoder per peer and hands it the rows that peer
+ * needs (the aircraft inside its exchange region). Rows that did not move
+ * at wire resolution cost nothing; one that moved costs a few bytes, and a
+ * row that left the table is sent once as a removal. Frames must reach
+ * the decoder in order; after a gap it asks for a keyframe, which this
+ * side sends on the next encode() after requestKeyframe(). Every
+ * keyframeInterval frames a keyframe goes out anyway.
+ */
+class TrafficDeltaEncoder {
+public:
+    explicit TrafficDeltaEncoder(uint32_t keyframeInterval = 100)
+        : keyframeInterval_(keyframeInterval) {}
+
+    // Append the next frame for table to out; returns the bytes appended
+    size_t encode(const TrafficTable& table, std::vector<uint8_t>& out);
+
+    void requestKeyframe() { keyframePending_ = true; }
+    uint64_t getSequence() const { return sequence_; }
+    size_t getTrackedCount() const { return baseline_.size(); }
+
+private:
+    uint32_t keyframeInterval_;
+    uint64_t sequence_ = 0;
+    bool keyframePending_ = true;
+    std::vector<TrafficDeltaRecord> baseline_;   // ascending object id
+    std::vector<TrafficDeltaRecord> next_;
+    std::vector<size_t> order_;                  // table rows by object id
+};
+
+enum class TrafficDeltaStatus {
+    APPLIED,
+    NEED_KEYFRAME,    // frame out of sequence; ignored until a keyframe arrives
+    CORRUPT           // truncated or malformed; table left as it was
+};
+
+/**
+ * Applies an encoder's frames to a traffic table
+ *
+ * Rows keep the sender's object ids, so give each peer its own table (or
+ * have the nodes hand out disjoint ids) before merging remote traffic with
+ * the local sim's. The table's revision moves only when a frame changed
+ * something, so TrafficSystem users can skip unchanged sweeps as usual.
+ */
+class TrafficDeltaDecoder {
+public:
+    TrafficDeltaStatus apply(const uint8_t* data, size_t size, TrafficTable& table);
+    TrafficDeltaStatus apply(const std::vector<uint8_t>& frame, TrafficTable& table) {
+        return apply(frame.data(), frame.size(), table);
+    }
+
+    bool needsKeyframe() const { return needKeyframe_; }
+    uint64_t getSequence() const { return sequence_; }
+    uint64_t getDroppedFrames() const { return droppedFrames_; }
+
+private:
+    bool needKeyframe_ = true;
+    uint64_t sequence_ = 0;          // last applied
+    uint64_t droppedFrames_ = 0;
+    std::vector<TrafficDeltaRecord> baseline_;   // ascending object id
+    std::vector<TrafficDeltaRecord> next_;       // this frame's updates
+    std::vector<TrafficDeltaRecord> merged_;     // next baseline for a delta frame
+    std::vector<uint32_t> removed_;
+};
+
+} // namespace AICopilot
+
+#endif // TRAFFIC_DELTA_HPP
@@ -19,9 +19,19 @@
 #define TRAFFIC_SYSTEM_H
 
 #include "aicopilot_types.h"
+#include "aircraft_state_core.hpp"
+#include "traffic_table.hpp"
+#include "closest_approach.hpp"
+#include "track_filter.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace AICopilot {
 
@@ -62,6 +72,7 @@ struct TrafficTarget {
     double range;  // nautical miles
     double bearing;  // degrees
     double closureRate;  // knots
+    double turnRate;  // degrees per second (+ is right); from the track filter, else 0
 };
 
 // Traffic advisory
@@ -72,33 +83,107 @@ struct TrafficAdvisory {
     TrafficTarget target;
     double timeToClosestApproach;  // seconds
     double minSeparation;  // nautical miles
-    std::string message;
+    std::string_view message;  // static text
 };
 
 /**
  * Real-time Traffic Avoidance System (TCAS)
+ *
+ * Targets, advisories and their closest-approach columns are double
+ * buffered: each update builds the back frame in reused storage and then
+ * makes it current. Getters hand out references into the current frame
+ * instead of copies; a reference stays valid and unchanged through the
+ * next update (it then refers to the previous frame) and is recycled by
+ * the one after.
  */
 class TrafficSystem {
 public:
     TrafficSystem() = default;
     
+    // Allocation-free view of the current targets within a range (nm)
+    class VicinityView {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = TrafficTarget;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const TrafficTarget*;
+            using reference = const TrafficTarget&;
+            
+            iterator(const TrafficTarget* current, const TrafficTarget* end, double range)
+                : current_(current), end_(end), range_(range) { skip(); }
+            
+            reference operator*() const { return *current_; }
+            pointer operator->() const { return current_; }
+            iterator& operator++() { ++current_; skip(); return *this; }
+            iterator operator++(int) { iterator old = *this; ++*this; return old; }
+            bool operator==(const iterator& other) const { return current_ == other.current_; }
+            bool operator!=(const iterator& other) const { return current_ != other.current_; }
+            
+        private:
+            void skip() { while (current_ != end_ && current_->range > range_) ++current_; }
+            
+            const TrafficTarget* current_;
+            const TrafficTarget* end_;
+            double range_;
+        };
+        
+        VicinityView(const std::vector<TrafficTarget>& targets, double range)
+            : first_(targets.data()), last_(targets.data() + targets.size()), range_(range) {}
+        
+        iterator begin() const { return iterator(first_, last_, range_); }
+        iterator end() const { return iterator(last_, last_, range_); }
+        
+    private:
+        const TrafficTarget* first_;
+        const TrafficTarget* last_;
+        double range_;
+    };
+    
     // Update own aircraft state
     void updateOwnAircraft(const AircraftState& state);
     
+    // From the hot core alone; false, changing nothing, when version is the
+    // one last applied (0 always applies)
+    bool updateOwnAircraft(const AircraftStateCore& core, uint64_t version);
+    uint64_t getOwnStateVersion() const { return ownVersion_; }
+    
     // Update traffic targets
     void updateTrafficTargets(const std::vector<TrafficTarget>& targets);
     
+    // Update traffic targets from a live traffic table
+    // Range, bearing, relative altitude and closure rate are derived from the
+    // own-aircraft state; target and advisory storage is reused between calls.
+    void updateTrafficTargets(const TrafficTable& table);
+    
+    // Same, with each target's reports smoothed by a per-callsign alpha-beta
+    // tracker; timeSeconds is when the sweep was taken. Range, bearing,
+    // closure and closest approach then use filtered position and velocity,
+    // so sweeps can be spaced further apart without noisier predictions.
+    // Filters keep inline history and are dropped when a target leaves.
+    void updateTrafficTargets(const TrafficTable& table, double timeSeconds);
+    
+    // Track filter for a callsign, or nullptr if it has none
+    const AlphaBetaTracker* getTrackFilter(const std::string& callsign) const;
+    
     // Get all traffic targets
-    std::vector<TrafficTarget> getTrafficTargets() const { return trafficTargets_; }
+    const std::vector<TrafficTarget>& getTrafficTargets() const { return front().targets; }
+    
+    // Bumped on every target update; lets pollers skip unchanged frames
+    uint64_t getGeneration() const { return front().generation; }
     
     // Get nearest traffic
     TrafficTarget getNearestTraffic() const;
     
-    // Check for traffic conflicts
+    // Check for traffic conflicts (a fresh evaluation, without hysteresis)
     std::vector<TrafficAdvisory> checkTrafficConflicts() const;
+    // Same, in storage from resource, e.g. FrameArena::forThread() for a per-tick check
+    std::pmr::vector<TrafficAdvisory> checkTrafficConflicts(std::pmr::memory_resource* resource) const;
     
-    // Get active advisories
-    std::vector<TrafficAdvisory> getActiveAdvisories() const { return activeAdvisories_; }
+    // Get active advisories; TA/RA hysteresis applies across updates, and
+    // all RAs share one sense chosen against every RA threat together
+    const std::vector<TrafficAdvisory>& getActiveAdvisories() const { return front().advisories; }
     
     // Check if there's an active RA (Resolution Advisory)
     bool hasActiveRA() const;
@@ -127,29 +212,83 @@ public:
     
     // Get traffic in vicinity
     std::vector<TrafficTarget> getTrafficInVicinity(double range) const;  // nm
+    std::pmr::vector<TrafficTarget> getTrafficInVicinity(double range, std::pmr::memory_resource* resource) const;
+    VicinityView trafficInVicinity(double range) const { return VicinityView(front().targets, range); }
     
-    // Calculate separation from target
+    // Calculate horizontal separation at closest approach (nm)
     double calculateSeparation(const TrafficTarget& target) const;
     
-    // Calculate time to closest approach
+    // Calculate time to closest approach (seconds)
     double calculateTimeToClosestApproach(const TrafficTarget& target) const;
     
     // Check if target is a threat
     bool isThreat(const TrafficTarget& target) const;
     
 private:
-    AircraftState ownAircraft_;
-    std::vector<TrafficTarget> trafficTargets_;
-    std::vector<TrafficAdvisory> activeAdvisories_;
+    // One buffered update: targets, target-minus-own tracks row-aligned with
+    // them, the closest-approach columns computed from those in one batch,
+    // and the advisories raised
+    struct Frame {
+        std::vector<TrafficTarget> targets;
+        ClosestApproach::Tracks tracks;
+        std::vector<double> cpaTime;
+        std::vector<double> cpaDistance;
+        std::vector<double> cpaVertical;
+        std::vector<double> tau;
+        std::vector<TrafficAdvisory> advisories;
+        uint64_t generation = 0;
+    };
+    
+    const Frame& front() const { return frames_[front_]; }
+    Frame& back() { return frames_[front_ ^ 1]; }
+    
+    // Advisory raised for a callsign by the last update
+    struct LatchedAdvisory {
+        TrafficAdvisoryType type;
+        RADirection raDirection;
+        uint64_t generation;
+    };
+    
+    AircraftState ownAircraft_{};
+    uint64_t ownVersion_ = 0;
+    Frame frames_[2];
+    size_t front_ = 0;
+    std::unordered_map<std::string, LatchedAdvisory> latched_;
+    
+    // Per-target track filter in a local frame anchored where it started
+    struct TargetFilter {
+        AlphaBetaTracker tracker;
+        double originLat = 0.0;
+        double originLon = 0.0;
+        uint64_t sweep = 0;
+    };
+    std::unordered_map<std::string, TargetFilter> filters_;
+    uint64_t filterSweep_ = 0;
     
     // TCAS parameters (nautical miles)
     static constexpr double TA_RANGE = 6.0;
     static constexpr double RA_RANGE = 3.0;
     static constexpr double VERTICAL_SEPARATION = 1000.0;  // feet
     
+    // Hysteresis: limits beyond which a latched advisory clears
+    static constexpr double RA_EXIT_RANGE = 3.6;
+    static constexpr double TA_EXIT_RANGE = 7.2;
+    static constexpr double VERTICAL_EXIT_SEPARATION = 1200.0;  // feet
+    static constexpr double CLOSURE_EXIT_RATE = 10.0;  // knots opening
+    
+    // Own-ship vertical rate an RA commands, and the extra worst-case
+    // separation a new threat must gain to reverse a latched sense
+    static constexpr double RA_VERTICAL_SPEED = 1500.0;  // feet per minute
+    static constexpr double RA_REVERSAL_MARGIN = 300.0;  // feet
+    
     // Helper methods
+    template <typename Advisories>
+    void collectTrafficConflicts(const Frame& frame, Advisories& advisories, bool hysteresis) const;
+    void publish(Frame& frame);
+    ClosestApproach::Result closestApproach(const TrafficTarget& target) const;
     ConflictType determineConflictType(const TrafficTarget& target) const;
-    RADirection determineRADirection(const TrafficTarget& target) const;
+    RADirection determineRADirection(double climbSeparation, double descendSeparation,
+                                     RADirection latchedSense, bool newThreat) const;
     double calculateRelativeBearing(const TrafficTarget& target) const;
     double calculateClosureRate(const TrafficTarget& target) const;
     bool isConverging(const TrafficTarget& target) const;
@@ -0,0 +1,223 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TRAFFIC_TABLE_HPP
+#define TRAFFIC_TABLE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * Live AI/multiplayer traffic stored as a structure of arrays
+ *
+ * Rows are keyed by simulator object ID and updated in place, so a radius
+ * sweep only touches the columns it changes and never rebuilds the table.
+ * Removal swaps the last row into the gap; row order is therefore not
+ * stable, but every column stays dense for linear scans (TCAS, conflict
+ * prediction). All storage is reused across sweeps and across copies.
+ */
+class TrafficTable {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    // One object's report as delivered by the simulator
+    struct Sample {
+        const char* callsign = "";
+        double latitude = 0.0;        // degrees
+        double longitude = 0.0;       // degrees
+        double altitude = 0.0;        // feet MSL
+        double groundSpeed = 0.0;     // knots
+        double heading = 0.0;         // degrees true
+        double verticalSpeed = 0.0;   // feet per minute
+        bool onGround = false;
+    };
+
+    void reserve(size_t capacity) {
+        objectId_.reserve(capacity);
+        callsign_.reserve(capacity);
+        latitude_.reserve(capacity);
+        longitude_.reserve(capacity);
+        altitude_.reserve(capacity);
+        groundSpeed_.reserve(capacity);
+        heading_.reserve(capacity);
+        verticalSpeed_.reserve(capacity);
+        onGround_.reserve(capacity);
+        lastSweep_.reserve(capacity);
+        index_.reserve(capacity);
+    }
+
+    // Insert or update the row for objectId; returns its row index
+    size_t upsert(uint32_t objectId, const Sample& sample) {
+        auto it = lowerBound(objectId);
+        size_t row = 0;
+
+        if (it != index_.end() && it->first == objectId) {
+            row = it->second;
+        } else {
+            row = objectId_.size();
+            index_.insert(it, {objectId, row});
+            objectId_.push_back(objectId);
+            callsign_.emplace_back();
+            latitude_.push_back(0.0);
+            longitude_.push_back(0.0);
+            altitude_.push_back(0.0);
+            groundSpeed_.push_back(0.0);
+            heading_.push_back(0.0);
+            verticalSpeed_.push_back(0.0);
+            onGround_.push_back(0);
+            lastSweep_.push_back(0);
+        }
+
+        if (callsign_[row] != sample.callsign) {
+            callsign_[row].assign(sample.callsign);
+        }
+        latitude_[row] = sample.latitude;
+        longitude_[row] = sample.longitude;
+        altitude_[row] = sample.altitude;
+        groundSpeed_[row] = sample.groundSpeed;
+        heading_[row] = sample.heading;
+        verticalSpeed_[row] = sample.verticalSpeed;
+        onGround_[row] = sample.onGround ? 1 : 0;
+        lastSweep_[row] = sweep_;
+        revision_++;
+        return row;
+    }
+
+    // Remove an object; returns false if it was not present
+    bool remove(uint32_t objectId) {
+        auto it = lowerBound(objectId);
+        if (it == index_.end() || it->first != objectId) return false;
+
+        size_t row = it->second;
+        index_.erase(it);
+        eraseRow(row);
+        revision_++;
+        return true;
+    }
+
+    // Row index for an object, or npos
+    size_t find(uint32_t objectId) const {
+        auto it = std::lower_bound(index_.begin(), index_.end(), objectId,
+            [](const IndexEntry& entry, uint32_t id) { return entry.first < id; });
+        if (it == index_.end() || it->first != objectId) return npos;
+        return it->second;
+    }
+
+    // Radius sweep bookkeeping: rows not upserted between beginSweep() and
+    // endSweep() have left the query radius and are dropped
+    void beginSweep() { sweep_++; }
+
+    size_t endSweep() {
+        size_t removed = 0;
+        for (size_t row = objectId_.size(); row-- > 0;) {
+            if (lastSweep_[row] == sweep_) continue;
+            auto it = lowerBound(objectId_[row]);
+            index_.erase(it);
+            eraseRow(row);
+            removed++;
+        }
+        if (removed > 0) revision_++;
+        return removed;
+    }
+
+    void clear() {
+        objectId_.clear();
+        callsign_.clear();
+        latitude_.clear();
+        longitude_.clear();
+        altitude_.clear();
+        groundSpeed_.clear();
+        heading_.clear();
+        verticalSpeed_.clear();
+        onGround_.clear();
+        lastSweep_.clear();
+        index_.clear();
+        revision_++;
+    }
+
+    size_t size() const { return objectId_.size(); }
+    bool empty() const { return objectId_.empty(); }
+
+    // Bumped on every mutation; lets readers skip unchanged tables
+    uint64_t revision() const { return revision_; }
+
+    // Column access (all columns have size() entries)
+    const std::vector<uint32_t>& objectIds() const { return objectId_; }
+    const std::vector<std::string>& callsigns() const { return callsign_; }
+    const std::vector<double>& latitudes() const { return latitude_; }
+    const std::vector<double>& longitudes() const { return longitude_; }
+    const std::vector<double>& altitudes() const { return altitude_; }
+    const std::vector<double>& groundSpeeds() const { return groundSpeed_; }
+    const std::vector<double>& headings() const { return heading_; }
+    const std::vector<double>& verticalSpeeds() const { return verticalSpeed_; }
+    const std::vector<uint8_t>& onGround() const { return onGround_; }
+
+private:
+    // Sorted (objectId, row) pairs; a flat vector keeps copies allocation-free
+    using IndexEntry = std::pair<uint32_t, size_t>;
+
+    std::vector<IndexEntry>::iterator lowerBound(uint32_t objectId) {
+        return std::lower_bound(index_.begin(), index_.end(), objectId,
+            [](const IndexEntry& entry, uint32_t id) { return entry.first < id; });
+    }
+
+    // Swap-remove a row and repoint the index entry of the row moved into it
+    void eraseRow(size_t row) {
+        size_t last = objectId_.size() - 1;
+        if (row != last) {
+            objectId_[row] = objectId_[last];
+            callsign_[row].swap(callsign_[last]);
+            latitude_[row] = latitude_[last];
+            longitude_[row] = longitude_[last];
+            altitude_[row] = altitude_[last];
+            groundSpeed_[row] = groundSpeed_[last];
+            heading_[row] = heading_[last];
+            verticalSpeed_[row] = verticalSpeed_[last];
+            onGround_[row] = onGround_[last];
+            lastSweep_[row] = lastSweep_[last];
+            lowerBound(objectId_[row])->second = row;
+        }
+
+        objectId_.pop_back();
+        callsign_.pop_back();
+        latitude_.pop_back();
+        longitude_.pop_back();
+        altitude_.pop_back();
+        groundSpeed_.pop_back();
+        heading_.pop_back();
+        verticalSpeed_.pop_back();
+        onGround_.pop_back();
+        lastSweep_.pop_back();
+    }
+
+    std::vector<uint32_t> objectId_;
+    std::vector<std::string> callsign_;
+    std::vector<double> latitude_;
+    std::vector<double> longitude_;
+    std::vector<double> altitude_;
+    std::vector<double> groundSpeed_;
+    std::vector<double> heading_;
+    std::vector<double> verticalSpeed_;
+    std::vector<uint8_t> onGround_;
+    std::vector<uint32_t> lastSweep_;
+    std::vector<IndexEntry> index_;
+
+    uint32_t sweep_ = 0;
+    uint64_t revision_ = 0;
+};
+
+} // namespace AICopilot
+
+#endif // TRAFFIC_TABLE_HPP
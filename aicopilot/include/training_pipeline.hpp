@@ -0,0 +1,96 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Training Pipeline - offline training from flight data recordings
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef TRAINING_PIPELINE_HPP
+#define TRAINING_PIPELINE_HPP
+
+#include "ml_decision_system.h"
+#include "ml_learning.hpp"
+#include "ml_models.hpp"
+#include "model_pack.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AICopilot {
+
+class FlightDataReader;
+
+namespace ML {
+
+struct TrainingPipelineConfig {
+    size_t threads = 0;             // recordings scanned in parallel; 0 = hardware concurrency
+    size_t row_stride = 30;         // recorded rows per training sample (1 s at 30 Hz)
+};
+
+struct TrainingPipelineStats {
+    size_t flights = 0;             // recordings read
+    size_t failed_flights = 0;      // missing, foreign or corrupt
+    uint64_t rows_scanned = 0;
+    size_t samples = 0;             // TrainingSamples for the models and learning system
+    size_t decision_examples = 0;   // phase segments offered to MLDecisionSystem
+    double scan_seconds = 0.0;
+    double train_seconds = 0.0;
+    bool published = false;         // ModelManager kept the trained models
+    ModelManager::AllMetrics metrics{};
+};
+
+// Training data taken from one recording
+struct FlightTrainingData {
+    std::vector<TrainingSample> samples;
+    std::vector<TrainingData> decisions;
+    uint64_t rows = 0;
+};
+
+/**
+ * Batch training from columnar flight recordings
+ *
+ * Recordings are scanned on a worker pool, one job per file; each job
+ * reads only the columns feature extraction needs. Every row_stride rows
+ * become a TrainingSample: CombinedFeatures through MLFeatures, in the
+ * FeatureLayout inference flattens, labelled 1 when the window stayed
+ * inside MLLearningSystem's stability envelope. Each phase segment becomes
+ * one MLDecisionSystem example. Results are merged in input order, so the
+ * output does not depend on the thread count.
+ *
+ * The samples then train ModelManager on the same pool (one model per
+ * worker), feed MLLearningSystem's counters and feature statistics, and
+ * the decision examples and learning state are written as a model pack.
+ */
+class TrainingPipeline {
+public:
+    explicit TrainingPipeline(const TrainingPipelineConfig& config = {});
+
+    // False when no recording could be read or the pack cannot be written
+    bool run(const std::vector<std::string>& recordings, const std::string& packPath);
+    bool run(const std::vector<std::string>& recordings, ModelPackBuilder& builder);
+
+    // One recording's samples and decision examples
+    static bool extractFlight(const FlightDataReader& recording, size_t rowStride, FlightTrainingData& out);
+
+    const TrainingPipelineStats& getStats() const { return stats_; }
+    ModelManager& getModels() { return models_; }
+    MLLearningSystem& getLearningSystem() { return learning_; }
+    MLDecisionSystem& getDecisionSystem() { return decisions_; }
+
+private:
+    TrainingPipelineConfig config_;
+    TrainingPipelineStats stats_;
+    ModelManager models_;
+    MLLearningSystem learning_;
+    MLDecisionSystem decisions_;
+};
+
+} // namespace ML
+} // namespace AICopilot
+
+#endif // TRAINING_PIPELINE_HPP
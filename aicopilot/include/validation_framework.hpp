@@ -37,6 +37,12 @@
 *   if (!result.isValid) {
 *       throw ValidationException(result.errorCode, result.message);
 *   }
+*
+*   // Hot paths: check without building strings, describe only failures
+*   ValidationCheck check = AircraftStateValidator::checkAircraftState(state);
+*   if (!check) {
+*       logger.warn(check.errorCode, describe(check).message);
+*   }
 *****************************************************************************/
 
 #ifndef VALIDATION_FRAMEWORK_HPP
@@ -44,12 +50,22 @@
 
 #include "error_handling.hpp"
 #include "aicopilot_types.h"
+#include "geodesy.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <cmath>
 #include <sstream>
 #include <memory>
 
+// Highest validation tier compiled into check*() with the default policy:
+// 1 keeps hard limits (finite values, geographic ranges, signs), 2 adds
+// plausibility limits. Set by the VALIDATION_TIER CMake option.
+#ifndef AICOPILOT_VALIDATION_TIER
+#define AICOPILOT_VALIDATION_TIER 2
+#endif
+
 namespace AICopilot {
 
 // ============================================================================
@@ -77,6 +93,211 @@ struct ValidationResult {
           fieldName(field), severityLevel(valid ? 0 : 2) {}
 };
 
+// ============================================================================
+// HOT-PATH CHECKS
+// ============================================================================
+
+/**
+ * Validation tiers as compile-time policies
+ *
+ * Tier 1 checks catch data that cannot be used at all; tier 2 checks catch
+ * data that is usable but implausible (over-limit speeds and altitudes,
+ * closely spaced waypoints). The check*() functions test tier 2 only when
+ * Policy::TIER >= 2, so ReleaseValidation compiles those tests out
+ * entirely. The validate*() functions always use FullValidation.
+ */
+struct FullValidation {
+    static constexpr int TIER = 2;
+};
+
+struct ReleaseValidation {
+    static constexpr int TIER = 1;
+};
+
+#if AICOPILOT_VALIDATION_TIER >= 2
+using DefaultValidationPolicy = FullValidation;
+#else
+using DefaultValidationPolicy = ReleaseValidation;
+#endif
+
+enum class CheckId : uint8_t {
+    NONE,
+    LATITUDE_NOT_FINITE,
+    LATITUDE_RANGE,
+    LONGITUDE_NOT_FINITE,
+    LONGITUDE_RANGE,
+    ALTITUDE_NOT_FINITE,
+    ALTITUDE_BELOW_GROUND,
+    ALTITUDE_ABOVE_MAX,             // tier 2
+    VERTICAL_SPEED_NOT_FINITE,
+    VERTICAL_SPEED_LIMIT,           // tier 2
+    HEADING_NOT_FINITE,
+    IAS_NOT_FINITE,
+    IAS_NEGATIVE,
+    IAS_ABOVE_MAX,                  // tier 2
+    TAS_NOT_FINITE,
+    TAS_NEGATIVE,
+    TAS_UNREALISTIC,                // tier 2
+    GROUND_SPEED_NOT_FINITE,
+    GROUND_SPEED_NEGATIVE,
+    GROUND_SPEED_UNREALISTIC,       // tier 2
+    WAYPOINT_NO_ID,
+    SEQUENCE_TOO_SHORT,
+    SEQUENCE_WAYPOINTS_TOO_CLOSE,   // tier 2
+    FUEL_NEGATIVE,
+    PITCH_LIMIT,
+    BANK_LIMIT,
+    BATTERY_VOLTAGE,                // tier 2
+    BATTERY_LOAD                    // tier 2
+};
+
+/**
+ * Outcome of a check*() function: which test failed and the values it saw,
+ * no strings. describe() turns a failure into a ValidationResult.
+ */
+struct ValidationCheck {
+    static constexpr size_t NO_INDEX = static_cast<size_t>(-1);
+
+    CheckId id = CheckId::NONE;
+    ErrorCode errorCode = ErrorCode::UNKNOWN_ERROR;
+    double value = 0.0;             // offending value
+    double limit = 0.0;             // bound it broke, where there is one
+    size_t index = NO_INDEX;        // waypoint within a sequence
+    size_t other = NO_INDEX;        // second waypoint of a close pair
+
+    bool ok() const { return id == CheckId::NONE; }
+    explicit operator bool() const { return ok(); }
+
+    static ValidationCheck fail(CheckId id, ErrorCode code, double value, double limit = 0.0) {
+        ValidationCheck check;
+        check.id = id;
+        check.errorCode = code;
+        check.value = value;
+        check.limit = limit;
+        return check;
+    }
+};
+
+/**
+ * Message for a failed check, matching the one the validate*() functions
+ * give. A passing check gives an empty valid result.
+ */
+inline ValidationResult describe(const ValidationCheck& check) {
+    if (check.ok()) {
+        return ValidationResult(true, ErrorCode::UNKNOWN_ERROR, "");
+    }
+
+    std::ostringstream oss;
+    const char* field = "";
+    switch (check.id) {
+        case CheckId::NONE:
+            break;
+        case CheckId::LATITUDE_NOT_FINITE:
+            oss << "Latitude is NaN or infinite";
+            break;
+        case CheckId::LATITUDE_RANGE:
+            oss << "Latitude " << check.value << " is outside valid range [-90, 90]";
+            field = "latitude";
+            break;
+        case CheckId::LONGITUDE_NOT_FINITE:
+            oss << "Longitude is NaN or infinite";
+            break;
+        case CheckId::LONGITUDE_RANGE:
+            oss << "Longitude " << check.value << " is outside valid range [-180, 180]";
+            field = "longitude";
+            break;
+        case CheckId::ALTITUDE_NOT_FINITE:
+            oss << "Altitude is NaN or infinite";
+            break;
+        case CheckId::ALTITUDE_BELOW_GROUND:
+            oss << "Altitude " << check.value << " ft is below ground level";
+            field = "altitude";
+            break;
+        case CheckId::ALTITUDE_ABOVE_MAX:
+            oss << "Altitude " << check.value << " ft exceeds maximum " << check.limit << " ft";
+            field = "altitude";
+            break;
+        case CheckId::VERTICAL_SPEED_NOT_FINITE:
+            oss << "Vertical speed is NaN or infinite";
+            break;
+        case CheckId::VERTICAL_SPEED_LIMIT:
+            oss << "Vertical speed " << check.value << " fpm exceeds realistic limits";
+            field = "vertical_speed";
+            break;
+        case CheckId::HEADING_NOT_FINITE:
+            oss << "Heading is NaN or infinite";
+            break;
+        case CheckId::IAS_NOT_FINITE:
+            oss << "IAS is NaN or infinite";
+            break;
+        case CheckId::IAS_NEGATIVE:
+            oss << "IAS " << check.value << " knots is negative";
+            field = "indicated_airspeed";
+            break;
+        case CheckId::IAS_ABOVE_MAX:
+            oss << "IAS " << check.value << " knots exceeds maximum " << check.limit << " knots";
+            field = "indicated_airspeed";
+            break;
+        case CheckId::TAS_NOT_FINITE:
+            oss << "TAS is NaN or infinite";
+            break;
+        case CheckId::TAS_NEGATIVE:
+            oss << "TAS " << check.value << " knots is negative";
+            field = "true_airspeed";
+            break;
+        case CheckId::TAS_UNREALISTIC:
+            oss << "TAS " << check.value << " knots is unrealistic for conventional aircraft";
+            field = "true_airspeed";
+            break;
+        case CheckId::GROUND_SPEED_NOT_FINITE:
+            oss << "Ground speed is NaN or infinite";
+            break;
+        case CheckId::GROUND_SPEED_NEGATIVE:
+            oss << "Ground speed " << check.value << " knots is negative";
+            field = "ground_speed";
+            break;
+        case CheckId::GROUND_SPEED_UNREALISTIC:
+            oss << "Ground speed " << check.value << " knots is unrealistic";
+            field = "ground_speed";
+            break;
+        case CheckId::WAYPOINT_NO_ID:
+            oss << "Waypoint ID cannot be empty";
+            break;
+        case CheckId::SEQUENCE_TOO_SHORT:
+            oss << "Flight plan must have at least departure and arrival";
+            break;
+        case CheckId::SEQUENCE_WAYPOINTS_TOO_CLOSE:
+            oss << "Waypoints " << check.index << " and " << check.other
+                << " are very close (" << check.value << " NM apart)";
+            field = "waypoint_sequence";
+            break;
+        case CheckId::FUEL_NEGATIVE:
+            oss << "Fuel quantity cannot be negative";
+            break;
+        case CheckId::PITCH_LIMIT:
+            oss << "Pitch angle exceeds physical limits";
+            break;
+        case CheckId::BANK_LIMIT:
+            oss << "Bank angle exceeds physical limits";
+            break;
+        case CheckId::BATTERY_VOLTAGE:
+            oss << "Invalid battery voltage";
+            break;
+        case CheckId::BATTERY_LOAD:
+            oss << "Invalid battery load";
+            break;
+    }
+    return ValidationResult(false, check.errorCode, oss.str(), field);
+}
+
+// A passing check as the given validate*() success result, or the failure described
+inline ValidationResult toResult(const ValidationCheck& check, const char* validMessage,
+                                 const char* validField = nullptr) {
+    if (!check.ok()) return describe(check);
+    return validField ? ValidationResult(true, ErrorCode::UNKNOWN_ERROR, validMessage, validField)
+                      : ValidationResult(true, ErrorCode::UNKNOWN_ERROR, validMessage);
+}
+
 // ============================================================================
 // COORDINATE VALIDATOR
 // ============================================================================
@@ -91,62 +312,59 @@ public:
     static constexpr double ANTIMERIDIAN_THRESHOLD = 170.0;   // degrees from ±180
 
     /**
-     * Validate latitude value
+     * Check latitude without building a result (tier 1 only)
      */
-    static ValidationResult validateLatitude(double latitude) {
-        if (std::isnan(latitude) || std::isinf(latitude)) {
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_LATITUDE,
-                "Latitude is NaN or infinite");
+    static ValidationCheck checkLatitude(double latitude) {
+        if (!std::isfinite(latitude)) {
+            return ValidationCheck::fail(CheckId::LATITUDE_NOT_FINITE,
+                ErrorCode::VALIDATION_INVALID_LATITUDE, latitude);
         }
-
         if (latitude < MIN_LATITUDE || latitude > MAX_LATITUDE) {
-            std::ostringstream oss;
-            oss << "Latitude " << latitude << " is outside valid range ["
-                << MIN_LATITUDE << ", " << MAX_LATITUDE << "]";
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_LATITUDE,
-                oss.str(), "latitude");
+            return ValidationCheck::fail(CheckId::LATITUDE_RANGE,
+                ErrorCode::VALIDATION_INVALID_LATITUDE, latitude);
         }
-
-        return ValidationResult(true, ErrorCode::UNKNOWN_ERROR, "Valid latitude", "latitude");
+        return ValidationCheck();
     }
 
     /**
-     * Validate longitude value
+     * Check longitude without building a result (tier 1 only)
      */
-    static ValidationResult validateLongitude(double longitude) {
-        if (std::isnan(longitude) || std::isinf(longitude)) {
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_LONGITUDE,
-                "Longitude is NaN or infinite");
+    static ValidationCheck checkLongitude(double longitude) {
+        if (!std::isfinite(longitude)) {
+            return ValidationCheck::fail(CheckId::LONGITUDE_NOT_FINITE,
+                ErrorCode::VALIDATION_INVALID_LONGITUDE, longitude);
         }
-
         if (longitude < MIN_LONGITUDE || longitude > MAX_LONGITUDE) {
-            std::ostringstream oss;
-            oss << "Longitude " << longitude << " is outside valid range ["
-                << MIN_LONGITUDE << ", " << MAX_LONGITUDE << "]";
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_LONGITUDE,
-                oss.str(), "longitude");
+            return ValidationCheck::fail(CheckId::LONGITUDE_RANGE,
+                ErrorCode::VALIDATION_INVALID_LONGITUDE, longitude);
         }
+        return ValidationCheck();
+    }
 
-        return ValidationResult(true, ErrorCode::UNKNOWN_ERROR, "Valid longitude", "longitude");
+    static ValidationCheck checkCoordinatePair(double latitude, double longitude) {
+        ValidationCheck check = checkLatitude(latitude);
+        return check ? checkLongitude(longitude) : check;
     }
 
     /**
-     * Validate latitude and longitude pair
+     * Validate latitude value
      */
-    static ValidationResult validateCoordinatePair(double latitude, double longitude) {
-        // Validate latitude first
-        ValidationResult latResult = validateLatitude(latitude);
-        if (!latResult.isValid) {
-            return latResult;
-        }
+    static ValidationResult validateLatitude(double latitude) {
+        return toResult(checkLatitude(latitude), "Valid latitude", "latitude");
+    }
 
-        // Validate longitude
-        ValidationResult lonResult = validateLongitude(longitude);
-        if (!lonResult.isValid) {
-            return lonResult;
-        }
+    /**
+     * Validate longitude value
+     */
+    static ValidationResult validateLongitude(double longitude) {
+        return toResult(checkLongitude(longitude), "Valid longitude", "longitude");
+    }
 
-        return ValidationResult(true, ErrorCode::UNKNOWN_ERROR,
+    /**
+     * Validate latitude and longitude pair
+     */
+    static ValidationResult validateCoordinatePair(double latitude, double longitude) {
+        return toResult(checkCoordinatePair(latitude, longitude),
             "Valid coordinate pair", "coordinates");
     }
 
@@ -217,28 +435,7 @@ public:
      * Returns distance in nautical miles
      */
     static double greatCircleDistance(double lat1, double lon1, double lat2, double lon2) {
-        // Earth's radius in nautical miles
-        constexpr double EARTH_RADIUS_NM = 3440.065;
-        constexpr double PI = 3.14159265358979323846;
-
-        // Convert to radians
-        double lat1Rad = lat1 * PI / 180.0;
-        double lon1Rad = lon1 * PI / 180.0;
-        double lat2Rad = lat2 * PI / 180.0;
-        double lon2Rad = lon2 * PI / 180.0;
-
-        // Haversine formula
-        double dLat = lat2Rad - lat1Rad;
-        double dLon = lon2Rad - lon1Rad;
-
-        double a = std::sin(dLat / 2.0) * std::sin(dLat / 2.0) +
-                   std::cos(lat1Rad) * std::cos(lat2Rad) *
-                   std::sin(dLon / 2.0) * std::sin(dLon / 2.0);
-
-        double c = 2.0 * std::atan2(std::sqrt(a), std::sqrt(1.0 - a));
-        double distance = EARTH_RADIUS_NM * c;
-
-        return distance;
+        return Geodesy::haversineNM(lat1, lon1, lat2, lon2);
     }
 
     /**
@@ -246,23 +443,7 @@ public:
      * Returns bearing in degrees (0-360)
      */
     static double calculateBearing(double lat1, double lon1, double lat2, double lon2) {
-        constexpr double PI = 3.14159265358979323846;
-        
-        double lat1Rad = lat1 * PI / 180.0;
-        double lon1Rad = lon1 * PI / 180.0;
-        double lat2Rad = lat2 * PI / 180.0;
-        double lon2Rad = lon2 * PI / 180.0;
-
-        double dLon = lon2Rad - lon1Rad;
-
-        double y = std::sin(dLon) * std::cos(lat2Rad);
-        double x = std::cos(lat1Rad) * std::sin(lat2Rad) -
-                   std::sin(lat1Rad) * std::cos(lat2Rad) * std::cos(dLon);
-
-        double bearing = std::atan2(y, x) * 180.0 / PI;
-        bearing = std::fmod(bearing + 360.0, 360.0);  // Normalize to 0-360
-
-        return bearing;
+        return Geodesy::initialBearing(lat1, lon1, lat2, lon2);
     }
 };
 
@@ -278,55 +459,63 @@ public:
     static constexpr double MAX_TURBOCHARGED_ALTITUDE = 35000.0;
     static constexpr double MAX_UNPRESSURIZED_ALTITUDE = 15000.0;
 
+    // Realistic vertical speed limits (feet per minute)
+    // Most GA aircraft: ±2000 fpm
+    static constexpr double MAX_VERTICAL_SPEED = 4000.0;
+
     /**
-     * Validate altitude for general aviation
+     * Check altitude; the maximum is tier 2
      */
-    static ValidationResult validateAltitude(double altitude,
-                                            double maxAltitude = MAX_GENERAL_ALTITUDE) {
-        if (std::isnan(altitude) || std::isinf(altitude)) {
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_ALTITUDE,
-                "Altitude is NaN or infinite");
+    template<typename Policy = DefaultValidationPolicy>
+    static ValidationCheck checkAltitude(double altitude, double maxAltitude = MAX_GENERAL_ALTITUDE) {
+        if (!std::isfinite(altitude)) {
+            return ValidationCheck::fail(CheckId::ALTITUDE_NOT_FINITE,
+                ErrorCode::VALIDATION_INVALID_ALTITUDE, altitude);
         }
-
         if (altitude < MIN_ALTITUDE) {
-            std::ostringstream oss;
-            oss << "Altitude " << altitude << " ft is below ground level";
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_ALTITUDE,
-                oss.str(), "altitude");
+            return ValidationCheck::fail(CheckId::ALTITUDE_BELOW_GROUND,
+                ErrorCode::VALIDATION_INVALID_ALTITUDE, altitude);
         }
+        if constexpr (Policy::TIER >= 2) {
+            if (altitude > maxAltitude) {
+                return ValidationCheck::fail(CheckId::ALTITUDE_ABOVE_MAX,
+                    ErrorCode::VALIDATION_INVALID_ALTITUDE, altitude, maxAltitude);
+            }
+        }
+        return ValidationCheck();
+    }
 
-        if (altitude > maxAltitude) {
-            std::ostringstream oss;
-            oss << "Altitude " << altitude << " ft exceeds maximum "
-                << maxAltitude << " ft";
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_ALTITUDE,
-                oss.str(), "altitude");
+    /**
+     * Check vertical speed; the limit is tier 2
+     */
+    template<typename Policy = DefaultValidationPolicy>
+    static ValidationCheck checkVerticalSpeed(double verticalSpeed) {
+        if (!std::isfinite(verticalSpeed)) {
+            return ValidationCheck::fail(CheckId::VERTICAL_SPEED_NOT_FINITE,
+                ErrorCode::VALIDATION_INVALID_ALTITUDE, verticalSpeed);
         }
+        if constexpr (Policy::TIER >= 2) {
+            if (std::abs(verticalSpeed) > MAX_VERTICAL_SPEED) {
+                return ValidationCheck::fail(CheckId::VERTICAL_SPEED_LIMIT,
+                    ErrorCode::VALIDATION_INVALID_ALTITUDE, verticalSpeed, MAX_VERTICAL_SPEED);
+            }
+        }
+        return ValidationCheck();
+    }
 
-        return ValidationResult(true, ErrorCode::UNKNOWN_ERROR, "Valid altitude");
+    /**
+     * Validate altitude for general aviation
+     */
+    static ValidationResult validateAltitude(double altitude,
+                                            double maxAltitude = MAX_GENERAL_ALTITUDE) {
+        return toResult(checkAltitude<FullValidation>(altitude, maxAltitude), "Valid altitude");
     }
 
     /**
      * Validate altitude change rate (vertical speed)
      */
     static ValidationResult validateVerticalSpeed(double verticalSpeed) {
-        // Realistic vertical speed limits (feet per minute)
-        // Most GA aircraft: ±2000 fpm
-        constexpr double MAX_VERTICAL_SPEED = 4000.0;  // fpm
-
-        if (std::isnan(verticalSpeed) || std::isinf(verticalSpeed)) {
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_ALTITUDE,
-                "Vertical speed is NaN or infinite");
-        }
-
-        if (std::abs(verticalSpeed) > MAX_VERTICAL_SPEED) {
-            std::ostringstream oss;
-            oss << "Vertical speed " << verticalSpeed << " fpm exceeds realistic limits";
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_ALTITUDE,
-                oss.str(), "vertical_speed");
-        }
-
-        return ValidationResult(true, ErrorCode::UNKNOWN_ERROR, "Valid vertical speed");
+        return toResult(checkVerticalSpeed<FullValidation>(verticalSpeed), "Valid vertical speed");
     }
 };
 
@@ -342,83 +531,94 @@ public:
     static constexpr double MAX_AIRSPEED_JET = 500.0;
     static constexpr double STALL_SPEED_ESTIMATE = 40.0;  // Conservative estimate
 
+    static constexpr double MAX_REALISTIC_SPEED = 600.0;  // Supersonic range
+
     /**
-     * Validate indicated airspeed
+     * Check indicated airspeed; the maximum is tier 2
      */
-    static ValidationResult validateIndicatedAirspeed(double ias,
-                                                     double maxIAS = MAX_AIRSPEED_GENERAL) {
-        if (std::isnan(ias) || std::isinf(ias)) {
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_AIRSPEED,
-                "IAS is NaN or infinite");
+    template<typename Policy = DefaultValidationPolicy>
+    static ValidationCheck checkIndicatedAirspeed(double ias, double maxIAS = MAX_AIRSPEED_GENERAL) {
+        if (!std::isfinite(ias)) {
+            return ValidationCheck::fail(CheckId::IAS_NOT_FINITE,
+                ErrorCode::VALIDATION_INVALID_AIRSPEED, ias);
         }
-
         if (ias < MIN_AIRSPEED) {
-            std::ostringstream oss;
-            oss << "IAS " << ias << " knots is negative";
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_AIRSPEED,
-                oss.str(), "indicated_airspeed");
+            return ValidationCheck::fail(CheckId::IAS_NEGATIVE,
+                ErrorCode::VALIDATION_INVALID_AIRSPEED, ias);
         }
-
-        if (ias > maxIAS) {
-            std::ostringstream oss;
-            oss << "IAS " << ias << " knots exceeds maximum " << maxIAS << " knots";
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_AIRSPEED,
-                oss.str(), "indicated_airspeed");
+        if constexpr (Policy::TIER >= 2) {
+            if (ias > maxIAS) {
+                return ValidationCheck::fail(CheckId::IAS_ABOVE_MAX,
+                    ErrorCode::VALIDATION_INVALID_AIRSPEED, ias, maxIAS);
+            }
         }
-
-        return ValidationResult(true, ErrorCode::UNKNOWN_ERROR, "Valid IAS");
+        return ValidationCheck();
     }
 
     /**
-     * Validate true airspeed
+     * Check true airspeed; the realism limit is tier 2
      */
-    static ValidationResult validateTrueAirspeed(double tas) {
-        if (std::isnan(tas) || std::isinf(tas)) {
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_AIRSPEED,
-                "TAS is NaN or infinite");
+    template<typename Policy = DefaultValidationPolicy>
+    static ValidationCheck checkTrueAirspeed(double tas) {
+        if (!std::isfinite(tas)) {
+            return ValidationCheck::fail(CheckId::TAS_NOT_FINITE,
+                ErrorCode::VALIDATION_INVALID_AIRSPEED, tas);
         }
-
         if (tas < MIN_AIRSPEED) {
-            std::ostringstream oss;
-            oss << "TAS " << tas << " knots is negative";
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_AIRSPEED,
-                oss.str(), "true_airspeed");
+            return ValidationCheck::fail(CheckId::TAS_NEGATIVE,
+                ErrorCode::VALIDATION_INVALID_AIRSPEED, tas);
         }
-
-        if (tas > 600.0) {  // Supersonic range
-            std::ostringstream oss;
-            oss << "TAS " << tas << " knots is unrealistic for conventional aircraft";
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_AIRSPEED,
-                oss.str(), "true_airspeed");
+        if constexpr (Policy::TIER >= 2) {
+            if (tas > MAX_REALISTIC_SPEED) {
+                return ValidationCheck::fail(CheckId::TAS_UNREALISTIC,
+                    ErrorCode::VALIDATION_INVALID_AIRSPEED, tas, MAX_REALISTIC_SPEED);
+            }
         }
-
-        return ValidationResult(true, ErrorCode::UNKNOWN_ERROR, "Valid TAS");
+        return ValidationCheck();
     }
 
     /**
-     * Validate ground speed
+     * Check ground speed; the realism limit is tier 2
      */
-    static ValidationResult validateGroundSpeed(double groundSpeed) {
-        if (std::isnan(groundSpeed) || std::isinf(groundSpeed)) {
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_AIRSPEED,
-                "Ground speed is NaN or infinite");
+    template<typename Policy = DefaultValidationPolicy>
+    static ValidationCheck checkGroundSpeed(double groundSpeed) {
+        if (!std::isfinite(groundSpeed)) {
+            return ValidationCheck::fail(CheckId::GROUND_SPEED_NOT_FINITE,
+                ErrorCode::VALIDATION_INVALID_AIRSPEED, groundSpeed);
         }
-
         if (groundSpeed < 0.0) {
-            std::ostringstream oss;
-            oss << "Ground speed " << groundSpeed << " knots is negative";
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_AIRSPEED,
-                oss.str(), "ground_speed");
+            return ValidationCheck::fail(CheckId::GROUND_SPEED_NEGATIVE,
+                ErrorCode::VALIDATION_INVALID_AIRSPEED, groundSpeed);
         }
-
-        if (groundSpeed > 600.0) {
-            std::ostringstream oss;
-            oss << "Ground speed " << groundSpeed << " knots is unrealistic";
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_AIRSPEED,
-                oss.str(), "ground_speed");
+        if constexpr (Policy::TIER >= 2) {
+            if (groundSpeed > MAX_REALISTIC_SPEED) {
+                return ValidationCheck::fail(CheckId::GROUND_SPEED_UNREALISTIC,
+                    ErrorCode::VALIDATION_INVALID_AIRSPEED, groundSpeed, MAX_REALISTIC_SPEED);
+            }
         }
+        return ValidationCheck();
+    }
+
+    /**
+     * Validate indicated airspeed
+     */
+    static ValidationResult validateIndicatedAirspeed(double ias,
+                                                     double maxIAS = MAX_AIRSPEED_GENERAL) {
+        return toResult(checkIndicatedAirspeed<FullValidation>(ias, maxIAS), "Valid IAS");
+    }
+
+    /**
+     * Validate true airspeed
+     */
+    static ValidationResult validateTrueAirspeed(double tas) {
+        return toResult(checkTrueAirspeed<FullValidation>(tas), "Valid TAS");
+    }
 
-        return ValidationResult(true, ErrorCode::UNKNOWN_ERROR, "Valid ground speed");
+    /**
+     * Validate ground speed
+     */
+    static ValidationResult validateGroundSpeed(double groundSpeed) {
+        return toResult(checkGroundSpeed<FullValidation>(groundSpeed), "Valid ground speed");
     }
 };
 
@@ -429,27 +629,21 @@ public:
 class HeadingValidator {
 public:
     /**
-     * Validate magnetic/true heading
+     * Check heading; any finite value normalizes into 0-360
      */
-    static ValidationResult validateHeading(double heading) {
-        if (std::isnan(heading) || std::isinf(heading)) {
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_HEADING,
-                "Heading is NaN or infinite");
-        }
-
-        // Normalize to 0-360 range for checking
-        double normalized = heading;
-        while (normalized < 0.0) normalized += 360.0;
-        while (normalized >= 360.0) normalized -= 360.0;
-
-        if (normalized < 0.0 || normalized >= 360.0) {
-            std::ostringstream oss;
-            oss << "Heading " << heading << " degrees is outside valid range";
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_HEADING,
-                oss.str(), "heading");
+    static ValidationCheck checkHeading(double heading) {
+        if (!std::isfinite(heading)) {
+            return ValidationCheck::fail(CheckId::HEADING_NOT_FINITE,
+                ErrorCode::VALIDATION_INVALID_HEADING, heading);
         }
+        return ValidationCheck();
+    }
 
-        return ValidationResult(true, ErrorCode::UNKNOWN_ERROR, "Valid heading");
+    /**
+     * Validate magnetic/true heading
+     */
+    static ValidationResult validateHeading(double heading) {
+        return toResult(checkHeading(heading), "Valid heading");
     }
 
     /**
@@ -589,73 +783,87 @@ public:
 
 class WaypointValidator {
 public:
+    static constexpr double MIN_WAYPOINT_SPACING = 0.1;  // NM
+
     /**
-     * Validate waypoint structure
+     * Check waypoint ID, coordinates and altitude
      */
-    static ValidationResult validateWaypoint(const Waypoint& waypoint) {
-        // Validate ID
+    template<typename Policy = DefaultValidationPolicy>
+    static ValidationCheck checkWaypoint(const Waypoint& waypoint) {
         if (waypoint.id.empty()) {
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_WAYPOINT,
-                "Waypoint ID cannot be empty");
+            return ValidationCheck::fail(CheckId::WAYPOINT_NO_ID,
+                ErrorCode::VALIDATION_INVALID_WAYPOINT, 0.0);
         }
-
-        // Validate coordinates
-        ValidationResult coordResult = CoordinateValidator::validateCoordinatePair(
+        ValidationCheck check = CoordinateValidator::checkCoordinatePair(
             waypoint.position.latitude, waypoint.position.longitude);
-        if (!coordResult.isValid) {
-            coordResult.errorCode = ErrorCode::VALIDATION_INVALID_WAYPOINT;
-            return coordResult;
+        if (check) {
+            check = AltitudeValidator::checkAltitude<Policy>(waypoint.altitude);
         }
-
-        // Validate altitude
-        ValidationResult altResult = AltitudeValidator::validateAltitude(waypoint.altitude);
-        if (!altResult.isValid) {
-            altResult.errorCode = ErrorCode::VALIDATION_INVALID_WAYPOINT;
-            return altResult;
+        if (!check) {
+            check.errorCode = ErrorCode::VALIDATION_INVALID_WAYPOINT;
         }
-
-        return ValidationResult(true, ErrorCode::UNKNOWN_ERROR, "Valid waypoint");
+        return check;
     }
 
     /**
-     * Validate flight plan waypoint sequence
+     * Check a flight plan sequence; index names the failing waypoint. The
+     * pairwise spacing test is quadratic and tier 2.
      */
-    static ValidationResult validateWaypointSequence(const std::vector<Waypoint>& waypoints) {
+    template<typename Policy = DefaultValidationPolicy>
+    static ValidationCheck checkWaypointSequence(const std::vector<Waypoint>& waypoints) {
         if (waypoints.size() < 2) {
-            return ValidationResult(false, ErrorCode::VALIDATION_INVALID_WAYPOINT,
-                "Flight plan must have at least departure and arrival");
+            return ValidationCheck::fail(CheckId::SEQUENCE_TOO_SHORT,
+                ErrorCode::VALIDATION_INVALID_WAYPOINT, static_cast<double>(waypoints.size()));
         }
 
-        // Check each waypoint
         for (size_t i = 0; i < waypoints.size(); i++) {
-            ValidationResult result = validateWaypoint(waypoints[i]);
-            if (!result.isValid) {
-                std::ostringstream oss;
-                oss << "Waypoint " << i << " (" << waypoints[i].id << ") is invalid: "
-                    << result.message;
-                return ValidationResult(false, ErrorCode::VALIDATION_INVALID_WAYPOINT_SEQUENCE,
-                    oss.str());
+            ValidationCheck check = checkWaypoint<Policy>(waypoints[i]);
+            if (!check) {
+                check.errorCode = ErrorCode::VALIDATION_INVALID_WAYPOINT_SEQUENCE;
+                check.index = i;
+                return check;
             }
         }
 
-        // Check for duplicate waypoints
-        for (size_t i = 0; i < waypoints.size() - 1; i++) {
-            for (size_t j = i + 1; j < waypoints.size(); j++) {
-                double dist = CoordinateValidator::greatCircleDistance(
-                    waypoints[i].position.latitude, waypoints[i].position.longitude,
-                    waypoints[j].position.latitude, waypoints[j].position.longitude);
-
-                if (dist < 0.1) {  // Less than 0.1 NM apart
-                    std::ostringstream oss;
-                    oss << "Waypoints " << i << " and " << j
-                        << " are very close (" << dist << " NM apart)";
-                    return ValidationResult(false, ErrorCode::VALIDATION_INVALID_WAYPOINT_SEQUENCE,
-                        oss.str(), "waypoint_sequence");
+        if constexpr (Policy::TIER >= 2) {
+            for (size_t i = 0; i < waypoints.size() - 1; i++) {
+                for (size_t j = i + 1; j < waypoints.size(); j++) {
+                    double dist = CoordinateValidator::greatCircleDistance(
+                        waypoints[i].position.latitude, waypoints[i].position.longitude,
+                        waypoints[j].position.latitude, waypoints[j].position.longitude);
+                    if (dist < MIN_WAYPOINT_SPACING) {
+                        ValidationCheck check = ValidationCheck::fail(CheckId::SEQUENCE_WAYPOINTS_TOO_CLOSE,
+                            ErrorCode::VALIDATION_INVALID_WAYPOINT_SEQUENCE, dist, MIN_WAYPOINT_SPACING);
+                        check.index = i;
+                        check.other = j;
+                        return check;
+                    }
                 }
             }
         }
+        return ValidationCheck();
+    }
 
-        return ValidationResult(true, ErrorCode::UNKNOWN_ERROR, "Valid waypoint sequence");
+    /**
+     * Validate waypoint structure
+     */
+    static ValidationResult validateWaypoint(const Waypoint& waypoint) {
+        return toResult(checkWaypoint<FullValidation>(waypoint), "Valid waypoint");
+    }
+
+    /**
+     * Validate flight plan waypoint sequence
+     */
+    static ValidationResult validateWaypointSequence(const std::vector<Waypoint>& waypoints) {
+        ValidationCheck check = checkWaypointSequence<FullValidation>(waypoints);
+        if (!check && check.index != ValidationCheck::NO_INDEX &&
+            check.id != CheckId::SEQUENCE_WAYPOINTS_TOO_CLOSE) {
+            std::ostringstream oss;
+            oss << "Waypoint " << check.index << " (" << waypoints[check.index].id << ") is invalid: "
+                << describe(check).message;
+            return ValidationResult(false, check.errorCode, oss.str());
+        }
+        return toResult(check, "Valid waypoint sequence");
     }
 
     /**
@@ -726,6 +934,64 @@ public:
     }
 };
 
+// ============================================================================
+// AIRCRAFT STATE VALIDATOR
+// ============================================================================
+
+class AircraftStateValidator {
+public:
+    static constexpr double MAX_PITCH = 90.0;           // degrees
+    static constexpr double MAX_BANK = 180.0;           // degrees
+    static constexpr double MAX_BATTERY_VOLTAGE = 50.0; // volts
+    static constexpr double MAX_BATTERY_LOAD = 500.0;   // amperes
+
+    /**
+     * Check a SimConnect aircraft state sample, first failure wins
+     */
+    template<typename Policy = DefaultValidationPolicy>
+    static ValidationCheck checkAircraftState(const AircraftState& state) {
+        ValidationCheck check = CoordinateValidator::checkCoordinatePair(
+            state.position.latitude, state.position.longitude);
+        if (check) check = AltitudeValidator::checkAltitude<Policy>(state.position.altitude);
+        if (check) check = HeadingValidator::checkHeading(state.heading);
+        if (check) check = AirspeedValidator::checkIndicatedAirspeed<Policy>(state.indicatedAirspeed);
+        if (check) check = AirspeedValidator::checkTrueAirspeed<Policy>(state.trueAirspeed);
+        if (check) check = AltitudeValidator::checkVerticalSpeed<Policy>(state.verticalSpeed);
+        if (!check) return check;
+
+        if (state.fuelQuantity < 0.0) {
+            return ValidationCheck::fail(CheckId::FUEL_NEGATIVE,
+                ErrorCode::AIRCRAFT_FUEL_MISMATCH, state.fuelQuantity);
+        }
+        if (std::abs(state.pitch) > MAX_PITCH) {
+            return ValidationCheck::fail(CheckId::PITCH_LIMIT,
+                ErrorCode::AIRCRAFT_INVALID_STATE, state.pitch, MAX_PITCH);
+        }
+        if (std::abs(state.bank) > MAX_BANK) {
+            return ValidationCheck::fail(CheckId::BANK_LIMIT,
+                ErrorCode::AIRCRAFT_INVALID_STATE, state.bank, MAX_BANK);
+        }
+        if constexpr (Policy::TIER >= 2) {
+            if (state.batteryVoltage < 0.0 || state.batteryVoltage > MAX_BATTERY_VOLTAGE) {
+                return ValidationCheck::fail(CheckId::BATTERY_VOLTAGE,
+                    ErrorCode::AIRCRAFT_ELECTRICAL_FAILURE, state.batteryVoltage, MAX_BATTERY_VOLTAGE);
+            }
+            if (state.batteryLoad < 0.0 || state.batteryLoad > MAX_BATTERY_LOAD) {
+                return ValidationCheck::fail(CheckId::BATTERY_LOAD,
+                    ErrorCode::AIRCRAFT_ELECTRICAL_FAILURE, state.batteryLoad, MAX_BATTERY_LOAD);
+            }
+        }
+        return ValidationCheck();
+    }
+
+    /**
+     * Validate aircraft state with every tier
+     */
+    static ValidationResult validateAircraftState(const AircraftState& state) {
+        return toResult(checkAircraftState<FullValidation>(state), "Valid aircraft state");
+    }
+};
+
 // ============================================================================
 // POINTER AND DATA VALIDATOR
 // ============================================================================
@@ -18,9 +18,14 @@
 #ifndef VOICE_INPUT_HPP
 #define VOICE_INPUT_HPP
 
+#include "audio_capture_ring.hpp"
+#include "keyword_spotter.hpp"
+#include "voice_latency.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
-#include <queue>
 #include <memory>
 #include <functional>
 #include <chrono>
@@ -66,6 +71,12 @@ struct VoiceInputStats {
     double average_vad_confidence = 0.0;
     double max_amplitude = 0.0;
     double current_noise_floor = 0.0;
+    
+    // Wake stage (zero unless a wake spotter is set)
+    uint32_t wake_detections = 0;
+    uint32_t false_wakes = 0;               // woke, but no command followed
+    uint32_t gated_voice_frames = 0;        // voiced frames kept from recognition
+    double false_wakes_per_hour = 0.0;      // of audio listened to
 };
 
 /**
@@ -86,6 +97,7 @@ public:
      * Returns VAD level and confidence score
      */
     std::pair<VADLevel, double> processFrame(const std::vector<int16_t>& samples);
+    std::pair<VADLevel, double> processFrame(const int16_t* samples, size_t count);
     
     /**
      * Set noise floor (for dynamic adjustment)
@@ -103,15 +115,20 @@ public:
     VoiceInputStats getStatistics() const;
     
 private:
+    // Frames of energy behind the adaptive noise floor
+    static constexpr size_t ENERGY_HISTORY = 50;
+    
     float sensitivity_;
     double noise_floor_;
     double max_amplitude_;
-    std::vector<double> energy_history_;
+    std::array<double, ENERGY_HISTORY> energy_history_{};    // ring
+    size_t energy_head_ = 0;
+    size_t energy_count_ = 0;
+    std::array<double, ENERGY_HISTORY> percentile_scratch_{};
     
     // VAD calculation
-    double calculateFrameEnergy(const std::vector<int16_t>& samples) const;
+    double calculateFrameEnergy(const int16_t* samples, size_t count) const;
     VADLevel determineVADLevel(double energy, double confidence);
-    double calculateEnergy(const std::vector<int16_t>& samples) const;
 };
 
 /**
@@ -146,10 +163,22 @@ public:
      */
     std::vector<int16_t> highPassFilter(const std::vector<int16_t>& samples);
     
+    /**
+     * Streaming front end, in place on one frame. Pre-emphasis carries
+     * its state across frames; the noise gate zeroes samples below the
+     * noise floor scaled by the noise reduction level.
+     */
+    void preEmphasize(int16_t* samples, size_t count);
+    void noiseGate(int16_t* samples, size_t count, double noise_floor);
+    void applyGain(int16_t* samples, size_t count, float gain_db);
+    
+    static constexpr float PRE_EMPHASIS = 0.97f;
+    
 private:
     float noise_reduction_level_;
     std::vector<int16_t> previous_frame_;
     double high_pass_filter_state_;
+    int16_t pre_emphasis_state_;
     
     // Spectral subtraction state
     std::vector<double> noise_spectrum_;
@@ -171,6 +200,7 @@ public:
      * Add audio frame to buffer
      */
     void addFrame(const AudioFrame& frame);
+    void addFrame(const int16_t* samples, size_t count, uint64_t timestamp_ms, VADLevel vad_level);
     
     /**
      * Get buffered audio as continuous data
@@ -190,7 +220,7 @@ public:
     /**
      * Get number of frames in buffer
      */
-    size_t getFrameCount() const { return frames_.size(); }
+    size_t getFrameCount() const { return count_; }
     
     /**
      * Get frame at index
@@ -203,7 +233,13 @@ public:
     std::vector<int16_t> extractVoiceSegment() const;
     
 private:
-    std::queue<AudioFrame> frames_;
+    // Ring of max_frames_ slots; a slot's samples keep their capacity when
+    // it is reused, so a full buffer adds frames without allocating
+    const AudioFrame& at(size_t index) const { return frames_[(head_ + index) % frames_.size()]; }
+    
+    std::vector<AudioFrame> frames_;
+    size_t head_;
+    size_t count_;
     size_t max_frames_;
 };
 
@@ -236,6 +272,25 @@ public:
      */
     void processAudioData(const std::vector<int16_t>& audio_samples);
     
+    /**
+     * Hand captured samples to the recognition thread. Safe to call from
+     * the audio callback: copies into the capture ring without locking or
+     * allocating, and drops (and counts) what does not fit when the
+     * recognition thread has fallen a full ring behind.
+     */
+    void captureAudio(const int16_t* samples, size_t count);
+    
+    /**
+     * Recognition thread: run up to max_frames captured frames through the
+     * front end; returns the number processed
+     */
+    size_t processCapturedAudio(size_t max_frames = SIZE_MAX);
+    
+    /**
+     * Capture ring counters (frames handed over, samples dropped)
+     */
+    AudioCaptureRing::Stats getCaptureStats() const { return capture_ring_->getStats(); }
+    
     /**
      * Start listening for voice commands
      */
@@ -287,33 +342,76 @@ public:
     using VoiceDetectionCallback = std::function<void(const std::vector<int16_t>&, double)>;
     void registerVoiceCallback(VoiceDetectionCallback callback);
     
+    /**
+     * Mark speech start/end of each utterance on a latency tracer
+     */
+    void setLatencyTracer(std::shared_ptr<VoiceLatencyTracer> tracer) { latency_tracer_ = std::move(tracer); }
+    
+    /**
+     * Optional wake stage, the hands-free equivalent of push-to-talk: with
+     * a spotter set, voiced frames reach the voice callback only after it
+     * spots an enrolled wake phrase or callsign, and until WAKE_HANGOVER_FRAMES
+     * of silence end the transmission. The wake phrase itself is not passed
+     * on. nullptr removes the stage.
+     */
+    void setWakeSpotter(std::shared_ptr<KeywordSpotter> spotter);
+    bool isAwake() const { return awake_; }
+    
+    /**
+     * Recognition found no command in what the wake let through: counts a
+     * false wake and closes the gate. A wake that closes with no voice
+     * after the phrase is counted without being reported.
+     */
+    void reportFalseWake();
+    
+    static constexpr size_t WAKE_HANGOVER_FRAMES = 25;     // 0.8 s
+    
     /**
      * Get average sound level (0.0-1.0)
      */
     double getAverageSoundLevel() const;
     
 private:
-    bool is_running_;
-    bool is_listening_;
+    std::atomic<bool> is_running_;
+    std::atomic<bool> is_listening_;
     VADLevel current_vad_level_;
     
     std::unique_ptr<VoiceActivityDetector> vad_;
     std::unique_ptr<AudioPreprocessor> preprocessor_;
     std::unique_ptr<VoiceCommandBuffer> buffer_;
     
-    VoiceDetectionCallback voice_callback_;
+    // Audio callback -> recognition thread, ~2 seconds of frames
+    static constexpr size_t CAPTURE_RING_FRAMES = 64;
+    std::unique_ptr<AudioCaptureRing> capture_ring_;
     
-    // Processing state
-    std::vector<int16_t> current_frame_;
+    VoiceDetectionCallback voice_callback_;
+    std::shared_ptr<VoiceLatencyTracer> latency_tracer_;
+    
+    // Wake stage
+    std::shared_ptr<KeywordSpotter> wake_spotter_;
+    bool awake_ = false;
+    bool wake_judged_ = false;              // this wake already counted as false
+    size_t wake_voiced_frames_ = 0;
+    size_t wake_silent_frames_ = 0;
+    
+    // Processing state; both frames are sized once and reused
+    std::vector<int16_t> current_frame_;        // raw samples of the frame being filled
+    std::vector<int16_t> processed_frame_;      // the frame being processed, through the front end
     size_t frame_index_;
     uint64_t last_voice_timestamp_;
     
     // Statistics
+    static constexpr size_t SOUND_LEVEL_HISTORY = 100;
     VoiceInputStats statistics_;
-    std::vector<double> recent_sound_levels_;
+    std::array<double, SOUND_LEVEL_HISTORY> recent_sound_levels_{};   // ring
+    size_t sound_level_head_ = 0;
+    size_t sound_level_count_ = 0;
+    double sound_level_sum_ = 0.0;
     
     // Helper methods
-    void processAccumulatedFrame();
+    void processFrame(const int16_t* samples);
+    bool updateWakeGate(VADLevel vad_level);
+    void closeWake();
     void updateStatistics();
 };
 
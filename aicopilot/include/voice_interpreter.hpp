@@ -18,11 +18,13 @@
 #ifndef VOICE_INTERPRETER_HPP
 #define VOICE_INTERPRETER_HPP
 
+#include "voice_latency.hpp"
 #include <string>
 #include <vector>
 #include <map>
 #include <memory>
 #include <functional>
+#include <utility>
 
 namespace AICopilot {
 
@@ -215,17 +217,40 @@ public:
      */
     std::vector<std::string> resolveWaypointAmbiguity(
         const std::string& waypoint_name);
+    
+    /**
+     * Resolve several waypoint names (e.g. recognizer alternatives) with
+     * one batched airport lookup and one batched navaid lookup
+     * @return One candidate list per name, in request order
+     */
+    std::vector<std::vector<std::string>> resolveWaypointAmbiguities(
+        const std::vector<std::string>& waypoint_names);
+    
+    /**
+     * Resolve waypoints likely to be spoken (e.g. the flight plan fixes)
+     * ahead of time so a later "direct to" is answered from the cache
+     */
+    void prefetchWaypoints(const std::vector<std::string>& waypoint_names);
 
     /**
      * Provide navdata access for resolving ambiguities
      */
     void setNavdataProvider(std::shared_ptr<INavdataProvider> provider);
     
+    // Recently resolved waypoint names kept for the session
+    static constexpr size_t WAYPOINT_CACHE_SIZE = 32;
+    
 private:
     // Context for ambiguity resolution
     std::string current_airport_;
     std::string current_airway_;
     std::weak_ptr<INavdataProvider> navdata_provider_;
+    
+    // Normalized name and its candidates, most recently used first
+    std::vector<std::pair<std::string, std::vector<std::string>>> waypoint_cache_;
+    
+    const std::vector<std::string>* findCachedWaypoint(const std::string& normalized);
+    void cacheWaypoint(const std::string& normalized, const std::vector<std::string>& candidates);
 };
 
 /**
@@ -296,6 +321,16 @@ public:
      */
     void setNavdataProvider(std::shared_ptr<INavdataProvider> provider);
     
+    /**
+     * Warm the waypoint cache with names the pilot is likely to say
+     */
+    void prefetchWaypoints(const std::vector<std::string>& waypoint_names);
+    
+    /**
+     * Mark each interpreted command on a latency tracer
+     */
+    void setLatencyTracer(std::shared_ptr<VoiceLatencyTracer> tracer) { latency_tracer_ = std::move(tracer); }
+    
     /**
      * Get last interpreted action
      */
@@ -310,6 +345,7 @@ private:
     
     SystemAction last_action_;
     std::string flight_context_;
+    std::shared_ptr<VoiceLatencyTracer> latency_tracer_;
     
     // Helper methods
     SystemAction handleNavigationCommand(
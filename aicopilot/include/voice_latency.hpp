@@ -0,0 +1,129 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#ifndef VOICE_LATENCY_HPP
+#define VOICE_LATENCY_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace AICopilot {
+
+class SystemMonitor;
+
+/**
+ * Voice pipeline stages, in the order an utterance passes them
+ */
+enum class VoiceStage : uint8_t {
+    SPEECH_START,   // VoiceInput: first voiced frame
+    SPEECH_END,     // VoiceInput: voice gave way to silence
+    RECOGNIZED,     // CommandRecognizer produced a result
+    INTERPRETED,    // VoiceInterpreter mapped it to an action
+    DISPATCHED,     // action sent to the simulator (marked by the caller)
+    READBACK,       // VoiceOutput handed the readback to playback
+    COUNT
+};
+
+const char* voiceStageName(VoiceStage stage);
+
+/**
+ * Fixed log2-bucket latency histogram
+ *
+ * Bucket i counts samples up to 0.25 ms * 2^i, the last bucket everything
+ * above; percentiles report the upper bound of the bucket they fall in.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKETS = 20;   // up to ~131 s
+    static constexpr double FIRST_BOUND_MS = 0.25;
+
+    void record(double latencyMs);
+
+    uint64_t count() const { return count_; }
+    double mean() const { return count_ ? sum_ / count_ : 0.0; }
+    double max() const { return max_; }
+    double percentile(double p) const;   // p in [0, 1]
+
+    const std::array<uint64_t, BUCKETS>& buckets() const { return buckets_; }
+    static double bucketUpperBoundMs(size_t bucket);
+
+private:
+    std::array<uint64_t, BUCKETS> buckets_{};
+    uint64_t count_ = 0;
+    double sum_ = 0.0;
+    double max_ = 0.0;
+};
+
+struct VoiceLatencyReport {
+    // stages[s]: time from the previous marked stage into stage s
+    std::array<LatencyHistogram, static_cast<size_t>(VoiceStage::COUNT)> stages;
+    LatencyHistogram total;           // first to last marked stage
+    uint64_t utterances = 0;
+    uint64_t abandoned = 0;           // closed with fewer than two stages marked
+
+    const LatencyHistogram& stage(VoiceStage s) const { return stages[static_cast<size_t>(s)]; }
+};
+
+/**
+ * Per-utterance trace spans across the voice pipeline
+ *
+ * Each component marks its stage with a steady_clock timestamp as an
+ * utterance passes through it. There is one microphone, so at most one
+ * utterance is open: SPEECH_START opens one (closing any unfinished
+ * predecessor), READBACK or endUtterance() closes it, and marks with no
+ * open utterance are dropped. Closing feeds the per-stage and total
+ * histograms and, when a SystemMonitor is attached, the total latency to
+ * SystemMonitor::recordQueryLatency under SystemComponent::VOICE_PIPELINE.
+ *
+ * Thread-safe; stages are marked from the capture, recognition and
+ * output threads.
+ */
+class VoiceLatencyTracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    void beginUtterance(Clock::time_point when = Clock::now());
+    void mark(VoiceStage stage, Clock::time_point when = Clock::now());
+    void endUtterance();
+
+    bool hasOpenUtterance() const;
+
+    VoiceLatencyReport getReport() const;
+    void reset();
+
+    // Monitor fed on close; it must outlive the tracer or be detached first
+    void setSystemMonitor(SystemMonitor* monitor);
+
+private:
+    static constexpr size_t STAGE_COUNT = static_cast<size_t>(VoiceStage::COUNT);
+
+    mutable std::mutex mutex_;
+    bool open_ = false;
+    std::array<Clock::time_point, STAGE_COUNT> marks_{};
+    uint32_t marked_ = 0;             // bit per stage
+    VoiceLatencyReport report_;
+    SystemMonitor* monitor_ = nullptr;
+
+    void closeLocked();
+};
+
+} // namespace AICopilot
+
+#endif // VOICE_LATENCY_HPP
@@ -18,11 +18,19 @@
 #ifndef VOICE_OUTPUT_HPP
 #define VOICE_OUTPUT_HPP
 
+#include "voice_latency.hpp"
+#include <array>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
+#include <list>
+#include <unordered_map>
 #include <memory>
 #include <functional>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <cstdint>
 
 namespace AICopilot {
@@ -74,11 +82,83 @@ struct SynthesizedSpeech {
     bool is_critical;  // Critical alert (always play)
 };
 
+struct SpeechCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t phrases = 0;
+    size_t samples = 0;          // sum over cached phrases
+    size_t sample_budget = 0;
+};
+
+/**
+ * SpeechCache - LRU cache of synthesized audio keyed by speaker and text
+ *
+ * Capacity is a budget in samples; least recently used phrases are
+ * evicted until a new one fits, as in TileCache. Audio is shared and
+ * immutable, so a phrase evicted while it is being played stays valid.
+ * Thread-safe. clear() starts a new generation, and insert() drops audio
+ * synthesized for an older one, so a phrase rendered with settings that
+ * changed mid-synthesis is never cached.
+ */
+class SpeechCache {
+public:
+    using Audio = std::shared_ptr<const std::vector<int16_t>>;
+    
+    explicit SpeechCache(size_t sample_budget);
+    
+    // Cached audio (now most recently used), or nullptr; counts a hit or miss
+    Audio find(SpeakerProfile speaker, const std::string& text);
+    
+    // Like find() but leaves recency and counters alone
+    bool contains(SpeakerProfile speaker, const std::string& text) const;
+    
+    void insert(SpeakerProfile speaker, const std::string& text, Audio audio, uint64_t generation);
+    void clear();
+    uint64_t getGeneration() const;
+    
+    // Shrinking the budget evicts immediately
+    void setSampleBudget(size_t sample_budget);
+    
+    SpeechCacheStats getStats() const;
+    
+private:
+    struct Entry {
+        std::string key;
+        Audio audio;
+    };
+    
+    static std::string makeKey(SpeakerProfile speaker, const std::string& text);
+    void trim();
+    
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;    // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+    size_t samples_ = 0;
+    size_t sample_budget_;
+    uint64_t generation_ = 0;
+    
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+};
+
 /**
  * SpeechSynthesizer - Text-to-Speech synthesis
+ *
+ * Synthesized phrases are cached per speaker. Text containing numbers
+ * (altitude, heading and speed readbacks) is assembled from cached word
+ * fragments, with numbers spoken the way ATC does ("one five thousand",
+ * "two seven zero"), so a new value only costs fragment lookups.
+ * preSynthesize() fills the cache ahead of time from any thread.
  */
 class SpeechSynthesizer {
 public:
+    static constexpr int SAMPLE_RATE = 16000;
+    static constexpr uint32_t FRAGMENT_GAP_MS = 30;          // silence between assembled words
+    static constexpr size_t DEFAULT_CACHE_SAMPLES = 16000 * 120;   // two minutes of audio
+    
+
     SpeechSynthesizer();
     ~SpeechSynthesizer();
     
@@ -101,7 +181,7 @@ public:
     /**
      * Get current configuration
      */
-    TTSConfig getConfig() const { return config_; }
+    TTSConfig getConfig() const;
     
     /**
      * Set speaker profile
@@ -123,17 +203,82 @@ public:
      */
     bool isReady() const { return is_ready_; }
     
+    /**
+     * Synthesize phrases and the fragments they are assembled from into the
+     * cache for the current speaker, skipping cached ones; stops early when
+     * cancel becomes true. Returns the number of phrases synthesized.
+     */
+    size_t preSynthesize(const std::vector<std::string>& phrases,
+                         const std::atomic<bool>* cancel = nullptr);
+    
+    /**
+     * Standard callouts and readback vocabulary worth pre-synthesizing
+     */
+    static std::vector<std::string> getStandardPhrases();
+    
+    /**
+     * Words a phrase is assembled from, numbers expanded as spoken
+     */
+    static std::vector<std::string> splitFragments(const std::string& text);
+    
+    SpeechCacheStats getCacheStats() const { return cache_.getStats(); }
+    void setCacheBudget(size_t samples) { cache_.setSampleBudget(samples); }
+    void clearCache() { cache_.clear(); }
+    
 private:
+    mutable std::mutex config_mutex_;
     TTSConfig config_;
     bool is_ready_;
+    SpeechCache cache_;
+    
+    // Cached audio for text, synthesizing and caching it on a miss
+    SpeechCache::Audio phraseAudio(const std::string& text, const TTSConfig& config,
+                                   uint64_t generation);
+    std::vector<int16_t> assembleFragments(const std::string& text, const TTSConfig& config,
+                                           uint64_t generation);
     
     // Simple speech synthesis (phoneme-based for no external API requirement)
-    std::vector<int16_t> generateAudioSamples(const std::string& text);
-    uint32_t estimateDuration(const std::string& text) const;
+    std::vector<int16_t> generateAudioSamples(const std::string& text, const TTSConfig& config) const;
+    uint32_t estimateDuration(const std::string& text, const TTSConfig& config) const;
+};
+
+/**
+ * CalloutFormatter - Fixed-capacity text buffer for callouts and readbacks
+ *
+ * Appends never allocate; text past CAPACITY is dropped and truncated()
+ * reports it. forThread() hands out a cleared per-thread instance, so a
+ * generator can format without owning a buffer. Its view() is valid until
+ * the next forThread() call on that thread.
+ */
+class CalloutFormatter {
+public:
+    static constexpr size_t CAPACITY = 256;
+    
+    static CalloutFormatter& forThread();
+    
+    CalloutFormatter& clear();
+    CalloutFormatter& append(std::string_view text);
+    CalloutFormatter& append(char c);
+    CalloutFormatter& appendInt(long long value);
+    CalloutFormatter& appendFixed(double value, int decimals);   // as std::fixed
+    
+    std::string_view view() const { return std::string_view(buffer_.data(), length_); }
+    std::string str() const { return std::string(view()); }
+    size_t size() const { return length_; }
+    bool truncated() const { return truncated_; }
+    
+private:
+    std::array<char, CAPACITY> buffer_{};
+    size_t length_ = 0;
+    bool truncated_ = false;
 };
 
 /**
  * ReadbackGenerator - Generates pilot readback confirmations
+ *
+ * Each generator formats through CalloutFormatter; the overloads taking
+ * one append to it instead of returning a string, for callouts that fire
+ * continuously (altitude on approach).
  */
 class ReadbackGenerator {
 public:
@@ -160,21 +305,25 @@ public:
      * Generate altitude readback
      */
     std::string generateAltitudeReadback(double altitude_feet);
+    void generateAltitudeReadback(double altitude_feet, CalloutFormatter& out) const;
     
     /**
      * Generate heading readback
      */
     std::string generateHeadingReadback(double heading_degrees);
+    void generateHeadingReadback(double heading_degrees, CalloutFormatter& out) const;
     
     /**
      * Generate speed readback
      */
     std::string generateSpeedReadback(double speed_knots);
+    void generateSpeedReadback(double speed_knots, CalloutFormatter& out) const;
     
     /**
      * Generate waypoint readback
      */
     std::string generateWaypointReadback(const std::string& waypoint_id);
+    void generateWaypointReadback(std::string_view waypoint_id, CalloutFormatter& out) const;
     
     /**
      * Generate standardized readback format
@@ -183,12 +332,9 @@ public:
         const std::map<std::string, std::string>& parameters);
     
 private:
-    // Phonetic alphabet for spelling
-    std::map<char, std::string> phonetic_alphabet_;
-    
-    std::string numberToWords(double number) const;
-    std::string degreeToHeading(double degrees) const;
-    std::string formatAltitude(double feet) const;
+    std::string_view numberToWords(double number) const;
+    std::string_view degreeToHeading(double degrees) const;
+    void formatAltitude(double feet, CalloutFormatter& out) const;
 };
 
 /**
@@ -216,6 +362,7 @@ public:
      * Generate terrain warning
      */
     std::string generateTerrainWarning(double distance_nm, double altitude_diff);
+    void generateTerrainWarning(double distance_nm, double altitude_diff, CalloutFormatter& out) const;
     
     /**
      * Generate system warning
@@ -239,6 +386,8 @@ public:
     std::string generateNavigationStatus(
         const std::string& current_waypoint,
         double distance_remaining);
+    void generateNavigationStatus(std::string_view current_waypoint, double distance_remaining,
+                                  CalloutFormatter& out) const;
     
 private:
     std::string formatWeatherData(const std::string& conditions) const;
@@ -319,6 +468,11 @@ public:
     using AudioCallback = std::function<void(const SynthesizedSpeech&)>;
     void registerAudioCallback(AudioCallback callback);
     
+    /**
+     * Mark each readback on a latency tracer; this closes the utterance
+     */
+    void setLatencyTracer(std::shared_ptr<VoiceLatencyTracer> tracer) { latency_tracer_ = std::move(tracer); }
+    
     /**
      * Get available speaker profiles
      */
@@ -339,18 +493,36 @@ public:
      */
     bool isEnabled() const { return is_enabled_; }
     
+    /**
+     * Wait for the background pre-synthesis started by initialize() or
+     * setActiveSpeaker() to finish
+     */
+    void waitForPreSynthesis();
+    
+    /**
+     * Get phrase cache statistics
+     */
+    SpeechCacheStats getSpeechCacheStats() const { return synthesizer_->getCacheStats(); }
+    
 private:
     std::unique_ptr<SpeechSynthesizer> synthesizer_;
     std::unique_ptr<ReadbackGenerator> readback_generator_;
     std::unique_ptr<AnnouncementGenerator> announcement_generator_;
     
     AudioCallback audio_callback_;
+    std::shared_ptr<VoiceLatencyTracer> latency_tracer_;
     bool is_playing_;
     bool is_enabled_;
     
     // Queue for announcements
     std::vector<SynthesizedSpeech> announcement_queue_;
     
+    // Background pre-synthesis of the standard phrases
+    std::thread presynthesis_thread_;
+    std::atomic<bool> cancel_presynthesis_{false};
+    
+    void startPreSynthesis();
+    void stopPreSynthesis();
     void processAnnouncement(const SynthesizedSpeech& speech);
 };
 
@@ -15,7 +15,9 @@
 
 #include "aicopilot_types.h"
 #include "aircraft_config.h"
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace AICopilot {
 
@@ -91,6 +93,87 @@ struct FlightConfiguration {
     bool sidewindComponent;        // knots
 };
 
+/**
+ * Weight and atmosphere dependent performance at one table node
+ */
+struct PerformancePoint {
+    double stallSpeed;            // knots, weight only
+    double correctedStallSpeed;   // knots, with the density altitude correction
+    double takeoffDistance;       // feet, before surface, wind and safety factors
+    double landingDistance;       // feet, before surface, wind and safety factors
+};
+
+/**
+ * Regular weight x density altitude x temperature grid of PerformancePoint
+ * with trilinear interpolation; queries outside the grid extrapolate from
+ * the edge cells
+ */
+class PerformanceTable {
+public:
+    struct Axis {
+        double first;
+        double step;
+        size_t count;   // at least 2
+    };
+    
+    // Cell and offset along one axis (fraction outside [0, 1] extrapolates)
+    struct AxisPosition {
+        size_t index;
+        double fraction;
+    };
+    
+    template <typename Model>
+    void build(const Axis& weight, const Axis& densityAltitude, const Axis& temperature, Model model) {
+        weight_ = weight;
+        densityAltitude_ = densityAltitude;
+        temperature_ = temperature;
+        points_.resize(weight.count * densityAltitude.count * temperature.count);
+        size_t i = 0;
+        for (size_t w = 0; w < weight.count; ++w) {
+            for (size_t d = 0; d < densityAltitude.count; ++d) {
+                for (size_t t = 0; t < temperature.count; ++t) {
+                    points_[i++] = model(weight.first + weight.step * w,
+                                         densityAltitude.first + densityAltitude.step * d,
+                                         temperature.first + temperature.step * t);
+                }
+            }
+        }
+    }
+    
+    bool empty() const { return points_.empty(); }
+    size_t size() const { return points_.size(); }
+    
+    AxisPosition locateWeight(double weight) const { return locate(weight_, weight); }
+    
+    PerformancePoint lookup(double weight, double densityAltitude, double temperature) const {
+        return lookup(locateWeight(weight), densityAltitude, temperature);
+    }
+    
+    // With the weight located once, for batches at one weight
+    PerformancePoint lookup(const AxisPosition& weight, double densityAltitude, double temperature) const;
+    
+private:
+    static AxisPosition locate(const Axis& axis, double value);
+    const PerformancePoint& at(size_t w, size_t d, size_t t) const {
+        return points_[(w * densityAltitude_.count + d) * temperature_.count + t];
+    }
+    
+    Axis weight_{};
+    Axis densityAltitude_{};
+    Axis temperature_{};
+    std::vector<PerformancePoint> points_;
+};
+
+/**
+ * Takeoff and landing distances and suitability for one runway
+ */
+struct RunwayPerformance {
+    double takeoffDistance;   // feet, with safety factor
+    double landingDistance;   // feet, with safety factor
+    bool takeoffSuitable;
+    bool landingSuitable;
+};
+
 /**
  * Comprehensive V-Speed Calculation System
  * Implements FAA and manufacturer procedures for realistic V-speeds
@@ -101,7 +184,7 @@ public:
     ~VSpeedCalculator() = default;
     
     /**
-     * Initialize with aircraft configuration
+     * Initialize with aircraft configuration and build its performance table
      */
     bool initialize(const AircraftConfig& config);
     
@@ -147,18 +230,38 @@ public:
         double landingDistRequired,
         double safetyMargin = 1000.0);  // feet
     
+    /**
+     * Distances and suitability for each runway's conditions at one weight
+     * Table lookups only, for ranking many runways and alternates at once.
+     */
+    void evaluateRunways(
+        const WeightBalance& weightBalance,
+        const EnvironmentalFactors* runways,
+        size_t count,
+        RunwayPerformance* out,
+        double takeoffSafetyFactor = 1.15,
+        double landingSafetyFactor = 1.67,
+        double safetyMargin = 1000.0) const;  // feet
+    
     /**
      * Calculate density altitude
      */
     double calculateDensityAltitude(
-        const EnvironmentalFactors& environment);
+        const EnvironmentalFactors& environment) const;
     
     /**
      * Calculate pressure altitude
      */
     double calculatePressureAltitude(
         double barometerSetting,  // inHg
-        double fieldElevation);   // feet
+        double fieldElevation) const;   // feet
+    
+    /**
+     * Performance from the formulas, bypassing the table
+     */
+    PerformancePoint computePerformance(double weight, double densityAltitude, double temperature) const;
+    
+    const PerformanceTable& getPerformanceTable() const { return performanceTable_; }
     
     /**
      * Get current V-speed set
@@ -189,9 +292,17 @@ public:
 private:
     AircraftConfig aircraftConfig_;
     VSpeedSet currentVSpeeds_;
+    PerformanceTable performanceTable_;
+    
+    // Table point for a weight and runway conditions (formulas before initialize)
+    PerformancePoint performanceAt(double weight, const EnvironmentalFactors& environment) const;
+    
+    // Takeoff and landing distances from a table point
+    double takeoffDistance(const PerformancePoint& point, const EnvironmentalFactors& env, double safetyFactor) const;
+    double landingDistance(const PerformancePoint& point, const EnvironmentalFactors& env, double safetyFactor) const;
     
     // Base V-speed calculation
-    double calculateBaseStallSpeed(const WeightBalance& wb);
+    double calculateBaseStallSpeed(const WeightBalance& wb) const;
     double calculateV1(
         const VSpeedSet& baseSet,
         double densityAltitude,
@@ -200,7 +311,7 @@ private:
     double calculateV2(const VSpeedSet& baseSet);
     
     // Environmental corrections
-    double applyDensityAltitudeCorrection(double speed, double densityAltitude);
+    double applyDensityAltitudeCorrection(double speed, double densityAltitude) const;
     double applyWeightCorrection(double speed, double actualWeight, double refWeight);
     double applyWindCorrection(double speed, double headwind);
     double applySurfaceCorrection(double speed, double surfaceCoeff);
@@ -0,0 +1,108 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Waypoint Index - latitude-banded spatial index over waypoint IDs
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef WAYPOINT_INDEX_HPP
+#define WAYPOINT_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * Spatial index of point fixes for radius and nearest-neighbour queries
+ *
+ * Points are bucketed into BAND_HEIGHT_DEG latitude bands and sorted by
+ * longitude within each band; a dense offset table (one entry per band)
+ * gives each band's slice of the point array. A radius query walks only
+ * the bands its bounding box spans, binary-searches the longitude window
+ * in each, rejects on the latitude bound and finishes with haversine on
+ * what is left. Points carry a caller-assigned 32-bit ID instead of a
+ * name, so the index stays small and queries allocate nothing but the
+ * output.
+ *
+ * The arrays can also live outside the index: attach() makes it a view
+ * over entries and band offsets laid out as entries() and bandOffsets()
+ * return them, such as a section of a memory-mapped navdata pack.
+ *
+ * Immutable after build(); concurrent queries are safe.
+ */
+class WaypointIndex {
+public:
+    static constexpr double BAND_HEIGHT_DEG = 0.25;
+    static constexpr int BAND_COUNT = 720;  // 180 / BAND_HEIGHT_DEG
+    static constexpr double MAX_RADIUS_NM = 10800.0;  // half the earth's circumference
+
+    struct Point {
+        double latitude;
+        double longitude;
+        uint32_t id;
+    };
+
+    struct Match {
+        uint32_t id;
+        double distanceNM;
+    };
+
+    // Stored form of a point, by band and then longitude
+    struct Entry {
+        double latitude;
+        double longitude;
+        double cosLatitude;  // cached for haversine
+        uint32_t id;
+        uint32_t reserved;
+    };
+
+    WaypointIndex() = default;
+    WaypointIndex(const WaypointIndex&) = delete;
+    WaypointIndex& operator=(const WaypointIndex&) = delete;
+
+    // Replace the indexed points
+    void build(std::vector<Point> points);
+    void clear();
+
+    // View count entries and BAND_COUNT + 1 band offsets owned elsewhere; they must outlive the index
+    void attach(const Entry* entries, size_t count, const uint32_t* bandOffsets);
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    // Indexed arrays, for serialization
+    const Entry* entries() const { return points_; }
+    const uint32_t* bandOffsets() const { return bandBegin_; }
+
+    // Points within radiusNM of the location, unordered (appended to out)
+    void queryRadius(double latitude, double longitude, double radiusNM,
+                     std::vector<Match>& out) const;
+
+    // Up to k points nearest the location and within maxRadiusNM, closest first
+    void queryNearest(double latitude, double longitude, size_t k,
+                      std::vector<Match>& out, double maxRadiusNM = MAX_RADIUS_NM) const;
+
+private:
+    static int bandFor(double latitude);
+
+    // Test entries [first, last) of a band against the query
+    void scanRange(const Entry* first, const Entry* last, double latitude, double cosLatitude,
+                   double longitude, double latMin, double latMax, double radiusNM,
+                   std::vector<Match>& out) const;
+
+    std::vector<Entry> entryStorage_;   // used when built here rather than attached
+    std::vector<uint32_t> bandStorage_;
+    const Entry* points_ = nullptr;     // by band, then longitude
+    size_t count_ = 0;
+    const uint32_t* bandBegin_ = nullptr;  // BAND_COUNT + 1 offsets into points_
+};
+
+} // namespace AICopilot
+
+#endif // WAYPOINT_INDEX_HPP
@@ -14,19 +14,31 @@
 #define WEATHER_DATABASE_HPP
 
 #include "aicopilot_types.h"
+#include "metar_parser.hpp"
+#include "taf_store.hpp"
+#include "weather_data.h"
+#include "weather_interpolator.hpp"
+#include "weather_snapshot.hpp"
+#include "weather_station_store.hpp"
+#include "work_stealing_pool.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <memory>
 #include <chrono>
+#include <condition_variable>
+#include <future>
 #include <mutex>
+#include <thread>
 
 namespace AICopilot {
 
 /**
- * Cloud layer information from METAR
+ * Cloud layer information from METAR, as text
+ * (WeatherData uses the enum-based CloudLayer)
  */
-struct CloudLayer {
+struct METARCloudLayer {
     std::string coverage;       // SKC, CLR, FEW, SCT, BKN, OVC
     int altitude;               // feet AGL
     std::string cloudType;      // CB, TCU, or empty (from remarks)
@@ -56,7 +68,7 @@ struct METARReport {
     int visibility;                 // statute miles
     std::vector<std::string> weatherPhenomena;  // RA, SN, TS, CAVOK, VV###, etc.
     
-    std::vector<CloudLayer> clouds;
+    std::vector<METARCloudLayer> clouds;
     
     int temperature;                // Celsius
     int dewpoint;                   // Celsius
@@ -80,18 +92,27 @@ struct METARReport {
 /**
  * Weather Database
  * Manages METAR reports and weather conditions
+ *
+ * Reports live once, decoded, in a WeatherStationStore; getWeather()
+ * (METARReport), GetWeatherAt() (WeatherData) and WeatherSystem
+ * (WeatherConditions) are all views of the same stored observation.
  */
 class WeatherDatabase {
 public:
     static constexpr int METAR_CACHE_SIZE = 100;
     static constexpr int METAR_EXPIRATION_MINUTES = 60;  // METAR reports valid for 1 hour
+    static constexpr int CACHE_TTL_SECONDS = METAR_EXPIRATION_MINUTES * 60;
+    static constexpr int TAF_EXPIRATION_MINUTES = 6 * 60;  // TAFs are reissued every 6 hours
+    static constexpr size_t INGEST_CHUNK_BYTES = 64 * 1024;  // Files up to this size parse inline
+    static constexpr int SNAPSHOT_INTERVAL_SECONDS = 5 * 60;
     
     WeatherDatabase();
     ~WeatherDatabase();
     
     /**
      * Initialize weather database
-     * @param cacheFile Optional path to cached METAR reports
+     * @param cacheFile Optional path to cached METAR reports, or to a
+     *        snapshot from saveSnapshot(), which restores without parsing
      * @return true if initialized
      */
     bool initialize(const std::string& cacheFile = "");
@@ -103,6 +124,8 @@ public:
     
     /**
      * Parse METAR report string
+     * Decoded by METARParser::parse in a single pass; only the final
+     * copy into this report's strings and vectors allocates.
      * @param metarString Raw METAR string (e.g., "KJFK 121851Z 31008KT 10SM...")
      * @return Parsed METARReport structure
      */
@@ -110,7 +133,7 @@ public:
     
     /**
      * Update weather for airport
-     * @param icao Airport ICAO code
+     * @param icao Airport ICAO code; empty to use the report's station
      * @param metar METAR report string
      * @return true if successfully updated
      */
@@ -133,6 +156,8 @@ public:
     
     /**
      * Check if weather is suitable for flight
+     * Stored stations carry the answer as StationFlags::FLIGHT_OK, likewise
+     * for takeoff and landing (see getStationSummary).
      * @param report METAR report
      * @return true if conditions meet minimum VFR
      */
@@ -160,47 +185,235 @@ public:
     int loadMETARsFromFile(const std::string& filepath);
     
     /**
-     * Save cached METAR reports to file
+     * Outcome of a bulk ingest
+     */
+    struct IngestResult {
+        int accepted = 0;           // Reports published
+        int rejected = 0;           // Non-blank lines that did not parse
+        size_t bytes = 0;           // File size
+        size_t chunks = 0;          // Pieces parsed independently
+        double elapsedMs = 0.0;
+    };
+    
+    /**
+     * Ingest a whole METAR cycle file
+     * Accepts one raw report per line or the NOAA metars.cache.csv
+     * layout (raw_text in the first column; preamble and header lines
+     * are rejected as unparseable). The file is memory-mapped, split at
+     * line boundaries into chunks parsed in parallel, and the batch
+     * replaces its stations in the cache under one lock; stations
+     * missing from the file keep their current report. CSV latitude and
+     * longitude columns also place the stations for GetWeatherAtPosition.
+     * @param filepath Path to the cycle file
+     * @return Counts and timing; accepted is 0 if the file can't be opened
+     */
+    IngestResult ingestMETARFile(const std::string& filepath);
+    
+    /**
+     * Ingest a whole TAF cycle file (tafs.cache.csv or raw TAFs with
+     * indented continuation lines), published the same way.
+     * TAFs are kept as normalised raw text per station and decoded into
+     * the forecast store; TAFs that don't decode keep only their text.
+     * @param filepath Path to the cycle file
+     * @return Counts and timing
+     */
+    IngestResult ingestTAFFile(const std::string& filepath);
+    
+    /**
+     * Get the current TAF for an airport
+     * @param icao Airport ICAO code
+     * @param rawTaf Output: TAF text on one line
+     * @return true if a TAF is available
+     */
+    bool getTAF(const std::string& icao, std::string& rawTaf);
+    
+    /**
+     * Forecast conditions at an airport at a given time
+     * @param time Unix time, e.g. an ETA
+     * @param period Output: the TAF period covering time
+     * @return false if no stored TAF covers time
+     */
+    bool getForecast(const std::string& icao, time_t time, TAFPeriod& period) const;
+    
+    /**
+     * Share a pool for bulk ingest; one with a thread per core is created
+     * on the first file large enough to split otherwise. Don't call
+     * ingest from one of its own jobs.
+     */
+    void setThreadPool(std::shared_ptr<WorkStealingPool> pool);
+    
+    /**
+     * Save cached METAR reports to file, one raw report per line,
+     * in a form loadMETARsFromFile reads back
      * @param filepath Path to output file
      * @return true if successful
      */
     bool saveMETARsToFile(const std::string& filepath);
     
+    /**
+     * Write a WeatherSnapshot of the live reports and station positions,
+     * through a temporary file renamed into place
+     * @return true if successful
+     */
+    bool saveSnapshot(const std::string& filepath);
+    
+    /**
+     * Restore reports and station positions from a snapshot, read from a
+     * file mapping; reports that have expired since are skipped
+     * @return Reports restored, or -1 if the file is not a valid snapshot
+     */
+    int loadSnapshot(const std::string& filepath);
+    
+    /**
+     * Restore a snapshot on a background thread; the file is read and
+     * checked in full before the store publishes it, so readers see either
+     * the old reports or the new ones
+     * @return Future holding the loadSnapshot() result; the load runs on
+     *         IoExecutor::shared(), so keep the database alive until it resolves
+     */
+    std::future<int> loadSnapshotAsync(const std::string& filepath);
+    
+    /**
+     * Save a snapshot every intervalSeconds from a background thread,
+     * whenever the store has changed since the last one; stopping, or
+     * shutdown(), writes a final one
+     */
+    void startSnapshotWriter(const std::string& filepath, int intervalSeconds = SNAPSHOT_INTERVAL_SECONDS);
+    void stopSnapshotWriter();
+    
     /**
      * Clear all cached METAR reports
      */
     void clearCache();
     
+    /**
+     * Suitability flags, flight category and hazards of a station's
+     * current report, derived once when it was stored
+     * @return false if there is no current report
+     */
+    bool getStationSummary(const std::string& icao, StationSummary& summary) const;
+    
+    /**
+     * Stations whose current report has every StationFlags bit in
+     * required and none in excluded, e.g. LANDING_OK without HAZARDOUS
+     * for alternates; one scan over the store's flag array
+     * @return Number of stations selected
+     */
+    size_t selectStations(uint16_t required, uint16_t excluded, std::vector<StationKey>& stations) const;
+    
     /**
      * Get number of cached reports
      */
     int getCacheSize() const;
+    
+    /**
+     * Station store backing this database, for WeatherSystem and other
+     * readers that want airport weather without a second copy
+     */
+    std::shared_ptr<WeatherStationStore> getStationStore() const { return store_; }
+    
+    /**
+     * Position lookups over the stored reports. Station positions come
+     * from NOAA CSV ingest or setStationPositions() on the interpolator.
+     */
+    std::shared_ptr<WeatherInterpolator> getInterpolator() const { return interpolator_; }
+    
+    /**
+     * Decoded TAFs, for planners that query many station x time pairs
+     */
+    std::shared_ptr<TAFStore> getTAFStore() const { return tafStore_; }
+    
+    // ========== Airport Weather API (WeatherData view) ==========
+    
+    /**
+     * Get weather at specified airport
+     * @param icaoCode Airport ICAO code (e.g., "KJFK")
+     * @param timeSeconds Unused; the current report is returned
+     * @return Stored weather, or a valid standard-day default if none
+     */
+    WeatherData GetWeatherAt(const std::string& icaoCode, long timeSeconds = 0);
+    
+    /**
+     * Get weather at a position, interpolated from nearby stations
+     * @return Nearest station's report with wind, temperatures, visibility,
+     *         ceiling and altimeter blended; the default if none are near
+     */
+    WeatherData GetWeatherAtPosition(double latitude, double longitude);
+    
+    /**
+     * Parse METAR string into WeatherData
+     * @param metarString Raw METAR string
+     * @return Parsed WeatherData
+     */
+    WeatherData ParseMETAR(const std::string& metarString);
+    
+    /**
+     * Parse TAF string into forecast data
+     * Only the base forecast is decoded, as a METAR body
+     * @param tafString Raw TAF string
+     * @return Vector of forecast entries
+     */
+    std::vector<WeatherData> ParseTAF(const std::string& tafString);
+    
+    double GetVisibility(const std::string& icaoCode);      // statute miles
+    double GetCeiling(const std::string& icaoCode);         // feet
+    WindData GetWindData(const std::string& icaoCode);
+    double GetTemperature(const std::string& icaoCode);     // Celsius
+    double GetDewpoint(const std::string& icaoCode);        // Celsius
+    double GetAltimeter(const std::string& icaoCode);       // inHg
+    
+    /**
+     * Check for hazardous conditions
+     * Reads the stored summary; no WeatherData is built.
+     * @param icaoCode Airport ICAO code
+     * @return true if icing, thunderstorm, or other hazards present
+     */
+    bool HasHazardousConditions(const std::string& icaoCode);
+    
+    PrecipitationType GetPrecipitationType(const std::string& icaoCode);
+    
+    // Same store as clearCache() / updateWeather() / getCacheSize()
+    void ClearCache();
+    bool UpdateCache(const std::string& icaoCode, const std::string& metarString);
+    size_t GetCacheSize() const;        // bytes
+    int GetCacheEntryCount() const;
+    
+    /**
+     * Drop expired reports and forecasts from the stores
+     */
+    void RefreshExpiredEntries();
 
 private:
-    struct CachedReport {
-        METARReport report;
+    struct CachedTAF {
+        std::string rawText;
         time_t cacheTime;
     };
     
-    std::map<std::string, CachedReport> reportCache_;
-    mutable std::mutex cacheMutex_;
+    std::shared_ptr<WeatherStationStore> store_;
+    std::shared_ptr<WeatherInterpolator> interpolator_;
+    std::shared_ptr<TAFStore> tafStore_;
+    std::map<std::string, CachedTAF> tafCache_;
+    mutable std::mutex cacheMutex_;     // Guards tafCache_ and pool_
+    std::shared_ptr<WorkStealingPool> pool_;
     
-    // METAR parsing helper methods
-    bool parseStationId(const std::string& token, METARReport& report);
-    bool parseDateTime(const std::string& token, METARReport& report);
-    bool parseWind(const std::string& token, METARReport& report);
-    bool parseVisibility(const std::string& token, METARReport& report);
-    bool parseWeatherPhenomena(const std::string& token, METARReport& report);
-    bool parseCloudLayer(const std::string& token, METARReport& report);
-    bool parseTemperatureDewpoint(const std::string& token, METARReport& report);
-    bool parseAltimeter(const std::string& token, METARReport& report);
-    bool parseRemarks(const std::string& token, METARReport& report);
+    // Background snapshot writer
+    std::thread snapshotThread_;
+    std::mutex snapshotMutex_;
+    std::condition_variable snapshotCv_;
+    bool snapshotStopping_ = false;     // Guarded by snapshotMutex_
     
     // Helper methods
-    bool isExpired(const CachedReport& cached) const;
-    void deriveConditions(METARReport& report);
-    double calculateCeiling(const METARReport& report) const;
-    static int parseInteger(const std::string& str, int& value);
+    std::shared_ptr<WorkStealingPool> ingestPool(size_t bytes);
+    void snapshotLoop(std::string filepath, int intervalSeconds, uint64_t savedEpoch);
+    
+    // Copy a decoded observation into the report layout, deriving conditions
+    static void fillReport(const METARObservation& observation, std::string_view source,
+                           METARReport& report);
+    
+    // Same for the WeatherData layout; hazards come from the summary
+    static void fillWeatherData(const METARObservation& observation, std::string_view source,
+                                const StationSummary& summary, WeatherData& wx);
+    static WeatherData GetDefaultWeather(const std::string& icaoCode);
 };
 
 } // namespace AICopilot
@@ -0,0 +1,128 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Weather Interpolator - station weather at any position
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef WEATHER_INTERPOLATOR_HPP
+#define WEATHER_INTERPOLATOR_HPP
+
+#include "aicopilot_types.h"
+#include "waypoint_index.hpp"
+#include "weather_station_store.hpp"
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace AICopilot {
+
+struct StationPosition {
+    StationKey station = INVALID_STATION;
+    double latitude = 0.0;
+    double longitude = 0.0;
+};
+
+// Weather blended from the stations around a point
+struct InterpolatedWeather {
+    WeatherConditions conditions;       // icing/turbulence/precipitation set when shares reach 0.5
+    double altimeterInHg = 29.92;
+    double thunderstormShare = 0.0;     // Weighted share of stations reporting it, 0-1
+    double icingShare = 0.0;
+    double precipitationShare = 0.0;
+    StationKey nearestStation = INVALID_STATION;
+    double nearestDistanceNM = 0.0;
+    int stationCount = 0;
+};
+
+/**
+ * Per-position weather from the current station reports
+ *
+ * Station coordinates go into a WaypointIndex (METARs carry no position),
+ * keyed by packed identifier. A sample takes the MAX_STATIONS nearest
+ * stations with a live report inside MAX_RADIUS_NM and blends them by
+ * inverse squared distance: wind as a vector, the rest as scalars, and
+ * hazard flags as weighted shares. A station within SNAP_DISTANCE_NM is
+ * used as is.
+ *
+ * Results are computed at the centre of a CELL_SIZE_DEG grid cell and
+ * cached per cell. A cached cell is reused until the store's epoch or the
+ * station positions change, or one of its reports expires, so sampling a
+ * route every few miles mostly hits the cache.
+ *
+ * Thread-safe; the store must outlive the interpolator.
+ */
+class WeatherInterpolator {
+public:
+    static constexpr size_t MAX_STATIONS = 4;
+    static constexpr double MAX_RADIUS_NM = 150.0;
+    static constexpr double SNAP_DISTANCE_NM = 1.0;
+    static constexpr double CELL_SIZE_DEG = 0.1;
+    static constexpr size_t MAX_CACHED_CELLS = 1 << 16;  // Dropped wholesale past this
+    static constexpr double DEFAULT_ROUTE_SPACING_NM = 10.0;
+
+    explicit WeatherInterpolator(std::shared_ptr<const WeatherStationStore> store);
+    WeatherInterpolator(const WeatherInterpolator&) = delete;
+    WeatherInterpolator& operator=(const WeatherInterpolator&) = delete;
+
+    // Add or move stations; a later position for a station replaces the earlier one
+    void setStationPositions(const std::vector<StationPosition>& positions);
+    bool getStationPosition(StationKey station, StationPosition& position) const;
+    size_t stationCount() const;
+
+    /**
+     * Weather at a point
+     * @return false if no station with a live report is within MAX_RADIUS_NM
+     */
+    bool sample(double latitude, double longitude, InterpolatedWeather& weather,
+                time_t now = std::time(nullptr)) const;
+
+    /**
+     * Sample every leg of a route about spacingNM apart, both ends included
+     * @param samples Output: one per point; points without nearby stations
+     *        get stationCount == 0
+     * @param points Optional output: the sampled positions
+     * @return Number of samples with weather
+     */
+    size_t sampleRoute(const std::vector<Position>& route, double spacingNM,
+                       std::vector<InterpolatedWeather>& samples, std::vector<Position>* points = nullptr,
+                       time_t now = std::time(nullptr)) const;
+
+    void clearCache();
+    size_t cachedCells() const;
+
+private:
+    struct CachedCell {
+        uint64_t storeEpoch = 0;
+        uint64_t positionsEpoch = 0;
+        time_t validUntil = 0;          // Earliest expiry among the reports used
+        bool found = false;
+        InterpolatedWeather weather;
+    };
+
+    static uint32_t cellFor(double latitude, double longitude);
+    bool interpolate(double latitude, double longitude, time_t now, InterpolatedWeather& weather,
+                     time_t& validUntil, uint64_t& positionsEpoch) const;
+
+    std::shared_ptr<const WeatherStationStore> store_;
+
+    mutable std::shared_mutex indexMutex_;  // Guards positions_, index_ and positionsEpoch_
+    std::unordered_map<StationKey, StationPosition> positions_;
+    WaypointIndex index_;
+    uint64_t positionsEpoch_ = 0;
+
+    mutable std::mutex cacheMutex_;
+    mutable std::unordered_map<uint32_t, CachedCell> cache_;
+};
+
+} // namespace AICopilot
+
+#endif // WEATHER_INTERPOLATOR_HPP
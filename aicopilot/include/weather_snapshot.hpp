@@ -0,0 +1,152 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Weather Snapshot - binary image of the decoded station store
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef WEATHER_SNAPSHOT_HPP
+#define WEATHER_SNAPSHOT_HPP
+
+#include "weather_interpolator.hpp"
+#include "weather_station_store.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <utility>
+#include <vector>
+
+namespace AICopilot {
+
+/*
+ * On-disk layout (little-endian): the header, the fixed-size records, then
+ * the string section holding every report's raw text back to back. Records
+ * refer to their text by offset, so the image can be read straight out of
+ * a file mapping. The checksum covers every byte after the header.
+ */
+struct WeatherSnapshotHeader {
+    char magic[4];                 // "AWSN"
+    uint16_t version;
+    uint16_t headerSize;           // sizeof(WeatherSnapshotHeader)
+    uint32_t recordCount;
+    uint32_t recordSize;           // sizeof(WeatherSnapshotRecord)
+    int64_t writtenAt;             // Unix time
+    uint64_t recordsOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t fileSize;
+    uint64_t checksum;             // FNV-1a 64
+};
+
+struct WeatherSnapshotWeather {
+    uint32_t components;           // METARObservation::Weather fields
+    uint16_t offset;
+    uint16_t length;
+    int8_t intensity;
+    uint8_t vicinity;
+    uint8_t reserved[2];
+};
+
+struct WeatherSnapshotCloud {
+    int32_t altitudeFeet;
+    uint8_t coverage;              // CloudCoverage
+    uint8_t cumulonimbus;
+    uint8_t toweringCumulus;
+    uint8_t reserved;
+};
+
+// One stored report: its decoded METARObservation, lifetime and position
+struct WeatherSnapshotRecord {
+    enum Flags : uint32_t {
+        AUTOMATED = 1u << 0,
+        CORRECTED = 1u << 1,
+        HAS_WIND = 1u << 2,
+        WIND_VARIABLE = 1u << 3,
+        HAS_VISIBILITY = 1u << 4,
+        CAVOK = 1u << 5,
+        HAS_TEMPERATURE = 1u << 6,
+        HAS_DEWPOINT = 1u << 7,
+        HAS_ALTIMETER = 1u << 8,
+        TRUNCATED = 1u << 9,
+        HAS_POSITION = 1u << 10,   // latitude and longitude are set
+    };
+
+    uint32_t station;              // packStationId
+    uint32_t textOffset;           // into the string section
+    uint32_t textLength;
+    uint32_t flags;
+    int64_t storedAt;
+    int64_t expiresAt;
+    double latitude;
+    double longitude;
+    double visibilitySM;
+    double altimeterInHg;
+    double altimeterMbar;
+    int32_t verticalVisibilityFeet;
+    int16_t windDirection;
+    int16_t windSpeed;
+    int16_t windGust;
+    int16_t variableMinDir;
+    int16_t variableMaxDir;
+    int16_t temperature;
+    int16_t dewpoint;
+    uint16_t remarksOffset;
+    uint16_t remarksLength;
+    uint16_t unknownTokens;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t weatherCount;
+    uint8_t cloudCount;
+    uint8_t reserved[3];
+    WeatherSnapshotWeather weather[METARObservation::MAX_WEATHER_GROUPS];
+    WeatherSnapshotCloud clouds[METARObservation::MAX_CLOUD_LAYERS];
+};
+
+static_assert(sizeof(WeatherSnapshotHeader) == 64, "WeatherSnapshotHeader layout");
+static_assert(sizeof(WeatherSnapshotWeather) == 12, "WeatherSnapshotWeather layout");
+static_assert(sizeof(WeatherSnapshotCloud) == 8, "WeatherSnapshotCloud layout");
+static_assert(sizeof(WeatherSnapshotRecord) == 200, "WeatherSnapshotRecord layout");
+
+/**
+ * Binary snapshot of a WeatherStationStore for warm restarts
+ *
+ * build() writes every live report as a fixed-size record of its decoded
+ * observation, so read() restores the store without parsing any METAR,
+ * along with the station positions the interpolator had. Summaries are
+ * derived again when the reports are published.
+ */
+class WeatherSnapshot {
+public:
+    static constexpr char MAGIC[4] = {'A', 'W', 'S', 'N'};
+    static constexpr uint16_t VERSION = 1;
+
+    using Batch = std::vector<std::pair<StationKey, WeatherStationStore::Report>>;
+
+    // True if the image starts with the snapshot magic
+    static bool isSnapshot(const void* data, size_t size);
+
+    /**
+     * Image of the store's live reports
+     * @param positions Station positions to record; may be null
+     */
+    static std::vector<uint8_t> build(const WeatherStationStore& store, const WeatherInterpolator* positions,
+                                      time_t now = std::time(nullptr));
+
+    /**
+     * Decode an image after checking its header, bounds and checksum
+     * @param reports Output: reports still live at now, for publish()
+     * @param positions Output: recorded positions of those stations
+     * @return false if the image is not a valid snapshot
+     */
+    static bool read(const void* data, size_t size, Batch& reports, std::vector<StationPosition>& positions,
+                     time_t now = std::time(nullptr));
+};
+
+} // namespace AICopilot
+
+#endif // WEATHER_SNAPSHOT_HPP
@@ -0,0 +1,289 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Weather Station Store - one decoded METAR per station with a TTL
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef WEATHER_STATION_STORE_HPP
+#define WEATHER_STATION_STORE_HPP
+
+#include "aicopilot_types.h"
+#include "metar_parser.hpp"
+#include "weather_data.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace AICopilot {
+
+using StationKey = uint32_t;
+constexpr StationKey INVALID_STATION = 0;
+
+// Pack a 3 or 4 character ICAO identifier (A-Z, 0-9, case-insensitive)
+// into an integer, first character in the high byte; INVALID_STATION otherwise
+constexpr StationKey packStationId(std::string_view icao) {
+    if (icao.size() < 3 || icao.size() > 4) return INVALID_STATION;
+    StationKey key = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        char c = i < icao.size() ? icao[i] : '\0';
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        if (i < icao.size() && !METARSyntax::isUpper(c) && !METARSyntax::isDigit(c)) return INVALID_STATION;
+        key = (key << 8) | static_cast<uint8_t>(c);
+    }
+    return key;
+}
+
+// Identifier for a packed key; empty for INVALID_STATION
+std::string unpackStationId(StationKey key);
+
+// Bits of StationSummary::flags
+namespace StationFlags {
+    // WeatherDatabase::isSuitableForFlight / Takeoff / Landing
+    constexpr uint16_t FLIGHT_OK = 1u << 0;
+    constexpr uint16_t TAKEOFF_OK = 1u << 1;
+    constexpr uint16_t LANDING_OK = 1u << 2;
+    // WeatherData::isSuitableForVFR / IFR / Landing
+    constexpr uint16_t VFR_OK = 1u << 3;
+    constexpr uint16_t IFR_OK = 1u << 4;
+    constexpr uint16_t LANDING_MINIMUMS_OK = 1u << 5;
+    // WeatherData hazard fields
+    constexpr uint16_t THUNDERSTORM = 1u << 6;
+    constexpr uint16_t ICING = 1u << 7;
+    constexpr uint16_t FREEZING_RAIN = 1u << 8;
+    constexpr uint16_t PRECIPITATION = 1u << 9;
+    constexpr uint16_t TURBULENCE = 1u << 10;
+    constexpr uint16_t LOW_VISIBILITY = 1u << 11;   // Below 3 SM
+    constexpr uint16_t HAZARDOUS = 1u << 12;        // WeatherDatabase::HasHazardousConditions
+}
+
+// Same order and values as WeatherData::getFlightCategory()
+enum class FlightCategory : uint8_t { LIFR, IFR, MVFR, VFR };
+
+/**
+ * What every suitability and hazard check needs from one report, derived
+ * once when the report is stored
+ */
+struct StationSummary {
+    static constexpr uint16_t NO_CEILING = 0xFFFF;
+
+    uint16_t flags = 0;                         // StationFlags
+    FlightCategory category = FlightCategory::VFR;
+    uint8_t precipitation = 0;                  // PrecipitationType
+    uint16_t ceilingHundredsFeet = NO_CEILING;
+    uint8_t visibilityQuarterSM = 0;            // Capped at 255
+    uint8_t windKnots = 0;                      // Capped at 255
+    uint8_t gustKnots = 0;
+
+    bool has(uint16_t flag) const { return (flags & flag) == flag; }
+    PrecipitationType precipitationType() const { return static_cast<PrecipitationType>(precipitation); }
+
+    bool operator==(const StationSummary& other) const {
+        return flags == other.flags && category == other.category && precipitation == other.precipitation &&
+               ceilingHundredsFeet == other.ceilingHundredsFeet &&
+               visibilityQuarterSM == other.visibilityQuarterSM && windKnots == other.windKnots &&
+               gustKnots == other.gustKnots;
+    }
+    bool operator!=(const StationSummary& other) const { return !(*this == other); }
+};
+
+/**
+ * Derive a report's summary; the rules are those of the METARReport and
+ * WeatherData checks named in StationFlags. A report without temperatures
+ * reads as the standard day, as in WeatherDatabase::GetWeatherAt.
+ * @param text Raw report the observation decodes (for remarks)
+ */
+StationSummary summarizeObservation(const METARObservation& observation, std::string_view text);
+
+// One station whose report was added, replaced with a different summary,
+// or removed
+struct StationChange {
+    StationKey station = INVALID_STATION;
+    bool removed = false;
+    StationSummary summary;     // The new report's; default when removed
+};
+
+/**
+ * Current METAR for every station
+ *
+ * Each station holds one report: its decoded METARObservation and the raw
+ * text its offsets refer to, so a report is parsed once and every view of
+ * it (METARReport, WeatherData, WeatherConditions) is derived on read.
+ * Reports are keyed by the packed ICAO identifier in a flat open-addressing
+ * table: linear probing over (key, index) slots kept at most half full,
+ * backward-shift deletion so no tombstones build up, and the reports
+ * themselves dense in a separate vector. Every report carries its own
+ * expiry; lookups ignore expired reports and purgeExpired() drops them.
+ * epoch() counts changes, so derived caches can tell when to refresh.
+ *
+ * Each report's StationSummary is derived as it is stored, and its flags
+ * and expiry are also kept in dense arrays parallel to the reports, so
+ * select() filters every station in one branch-free pass.
+ *
+ * Change listeners hear, once per writing call, which stations changed.
+ * A replacement whose summary is the same as the old one is not a change.
+ * Reports that expire are reported when purgeExpired() drops them.
+ *
+ * Thread-safe. Lookups take a shared lock; writers lock exclusively.
+ */
+class WeatherStationStore {
+public:
+    static constexpr int DEFAULT_TTL_SECONDS = 60 * 60;  // METARs are issued hourly
+
+    struct Report {
+        METARObservation observation;
+        std::string text;           // Raw METAR the observation decodes
+        time_t storedAt = 0;
+        time_t expiresAt = 0;
+        StationSummary summary;     // Filled by update() and publish()
+    };
+
+    WeatherStationStore() = default;
+    WeatherStationStore(const WeatherStationStore&) = delete;
+    WeatherStationStore& operator=(const WeatherStationStore&) = delete;
+
+    /**
+     * Parse a METAR and store it, replacing the station's current report
+     * @param icao Station to file it under; empty to use the report's own
+     * @param metar Raw METAR
+     * @param ttlSeconds Lifetime from now
+     * @param error Output: parser message when rejected; may be null
+     * @return false if the METAR or the station is invalid
+     */
+    bool update(std::string_view icao, std::string_view metar, int ttlSeconds = DEFAULT_TTL_SECONDS,
+                time_t now = std::time(nullptr), const char** error = nullptr);
+
+    // Store already decoded reports in order under one lock; later
+    // reports for a station replace earlier ones. Summaries are derived
+    // here, before the lock is taken.
+    void publish(std::vector<std::pair<StationKey, Report>>&& batch);
+
+    // Copy of the station's report; false if absent or expired
+    bool get(std::string_view icao, Report& report, time_t now = std::time(nullptr)) const;
+
+    // Call fn(const Report&) under the shared lock without copying
+    template <typename Visit>
+    bool visit(std::string_view icao, Visit&& fn, time_t now = std::time(nullptr)) const {
+        return visit(packStationId(icao), std::forward<Visit>(fn), now);
+    }
+
+    template <typename Visit>
+    bool visit(StationKey key, Visit&& fn, time_t now = std::time(nullptr)) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        size_t slot = findSlot(key);
+        if (slot == NPOS || isExpired(reports_[slots_[slot].index], now)) return false;
+        fn(reports_[slots_[slot].index]);
+        return true;
+    }
+
+    // Call fn(StationKey, const Report&) for every live report
+    template <typename Visit>
+    void forEach(Visit&& fn, time_t now = std::time(nullptr)) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (size_t i = 0; i < reports_.size(); ++i) {
+            if (!isExpired(reports_[i], now)) fn(keys_[i], reports_[i]);
+        }
+    }
+
+    // The station's summary; false if absent or expired
+    bool getSummary(std::string_view icao, StationSummary& summary, time_t now = std::time(nullptr)) const;
+
+    /**
+     * Stations with a live report whose summary has every flag in required
+     * and none in excluded
+     * @param stations Output, in no particular order
+     * @return Number of stations selected
+     */
+    size_t select(uint16_t required, uint16_t excluded, std::vector<StationKey>& stations,
+                  time_t now = std::time(nullptr)) const;
+
+    bool erase(std::string_view icao);
+
+    // Drop expired reports; returns how many went
+    size_t purgeExpired(time_t now = std::time(nullptr));
+
+    void clear();
+
+    // Stored reports, expired ones included until purged
+    size_t size() const;
+
+    // Approximate heap footprint of the table and report text
+    size_t memoryBytes() const;
+
+    // Bumped by every call that adds, replaces or removes reports
+    uint64_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    using ChangeListener = std::function<void(const std::vector<StationChange>&)>;
+
+    /**
+     * Register fn to hear about changes. It runs on the writing thread
+     * after the store's lock is released, so it may read the store, but it
+     * must not write to it or add or remove listeners.
+     * @return Id for removeChangeListener()
+     */
+    uint64_t addChangeListener(ChangeListener fn);
+
+    // Waits for a notification in progress, so the listener's captures
+    // may be released once this returns
+    bool removeChangeListener(uint64_t id);
+
+private:
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+    static constexpr size_t MIN_SLOTS = 16;
+
+    struct Slot {
+        StationKey key = INVALID_STATION;
+        uint32_t index = 0;         // Into reports_ and the arrays parallel to it
+    };
+
+    static bool isExpired(const Report& report, time_t now) { return now >= report.expiresAt; }
+
+    size_t home(StationKey key) const {
+        // Fibonacci hashing; packed identifiers differ mostly in the low bytes
+        return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> 32) & mask_;
+    }
+
+    size_t findSlot(StationKey key) const;
+    // changes, if given, gets the station unless its summary is unchanged
+    void store(StationKey key, Report&& report, std::vector<StationChange>* changes);
+    void removeSlot(size_t slot);
+    void rehash(size_t slotCount);
+    bool listening() const { return listening_.load(std::memory_order_acquire); }
+    void notify(const std::vector<StationChange>& changes);
+
+    mutable std::shared_mutex mutex_;
+    std::vector<Slot> slots_;       // Power-of-two length, or empty
+    size_t mask_ = 0;
+    std::vector<Report> reports_;   // Dense, in no particular order
+    std::vector<StationKey> keys_;  // Parallel to reports_
+    std::vector<uint16_t> flags_;   // Parallel to reports_: summary.flags
+    std::vector<time_t> expiries_;  // Parallel to reports_: expiresAt
+    std::atomic<uint64_t> epoch_{0};
+
+    std::mutex listenerMutex_;      // Held while listeners run
+    std::vector<std::pair<uint64_t, ChangeListener>> listeners_;
+    uint64_t nextListenerId_ = 1;
+    std::atomic<bool> listening_{false};
+};
+
+/**
+ * Aircraft-facing conditions from one decoded METAR; the same rules back
+ * WeatherDatabase::getConditions
+ */
+WeatherConditions conditionsFromObservation(const METARObservation& observation);
+
+} // namespace AICopilot
+
+#endif // WEATHER_STATION_STORE_HPP
@@ -0,0 +1,135 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Weather Subscriptions - notify consumers when station weather changes
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef WEATHER_SUBSCRIPTIONS_HPP
+#define WEATHER_SUBSCRIPTIONS_HPP
+
+#include "aicopilot_types.h"
+#include "weather_interpolator.hpp"
+#include "weather_station_store.hpp"
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace AICopilot {
+
+// Bits of WeatherChange::reasons
+namespace WeatherChangeReason {
+    constexpr uint8_t REPORTED = 1u << 0;   // First report the subscriber hears of
+    constexpr uint8_t REMOVED = 1u << 1;    // Erased, or purged on expiry
+    constexpr uint8_t CATEGORY = 1u << 2;   // Flight category
+    constexpr uint8_t FLAGS = 1u << 3;      // A StationFlags bit in the flag mask
+    constexpr uint8_t WIND = 1u << 4;       // Wind or gust by the threshold
+}
+
+// What makes a change material to a subscriber
+struct WeatherChangeThresholds {
+    bool category = true;
+    uint16_t flagMask = 0xFFFF;     // StationFlags to watch
+    int windKnots = 10;             // 0 ignores wind
+    int gustKnots = 10;             // 0 ignores gusts
+};
+
+struct WeatherChange {
+    StationKey station = INVALID_STATION;
+    uint8_t reasons = 0;            // WeatherChangeReason
+    StationSummary previous;        // Last summary delivered; default if none
+    StationSummary current;         // Default when removed
+};
+
+using WeatherChangeCallback = std::function<void(const std::vector<WeatherChange>&)>;
+
+/**
+ * Change notifications for stations, regions and route corridors
+ *
+ * Listens to a WeatherStationStore and tells each subscriber only about
+ * material changes in its scope, compared against the last summary it
+ * was told (or held when it subscribed), so small drifts add up until
+ * they cross a threshold; now picks the live reports a subscription
+ * starts from. A subscriber's changes from one store write
+ * arrive in one call, on the writing thread, with no lock held, so a
+ * callback may unsubscribe. Region and corridor scopes place stations
+ * with the interpolator's positions as each change arrives.
+ *
+ * SIGMETs and other hazard areas are not station reports; owners of a
+ * HazardGrid already see those changes as they set them.
+ *
+ * Thread-safe.
+ */
+class WeatherSubscriptions {
+public:
+    using SubscriptionId = uint64_t;
+    static constexpr SubscriptionId INVALID_SUBSCRIPTION = 0;
+
+    explicit WeatherSubscriptions(std::shared_ptr<WeatherStationStore> store,
+                                  std::shared_ptr<const WeatherInterpolator> positions = nullptr);
+    ~WeatherSubscriptions();
+    WeatherSubscriptions(const WeatherSubscriptions&) = delete;
+    WeatherSubscriptions& operator=(const WeatherSubscriptions&) = delete;
+
+    // Changes at these stations; INVALID_SUBSCRIPTION if none is valid
+    SubscriptionId subscribeStations(const std::vector<std::string>& icaos, WeatherChangeCallback callback,
+                                     const WeatherChangeThresholds& thresholds = WeatherChangeThresholds(),
+                                     time_t now = std::time(nullptr));
+
+    // Changes at stations within radiusNM; needs positions
+    SubscriptionId subscribeRegion(double latitude, double longitude, double radiusNM,
+                                   WeatherChangeCallback callback,
+                                   const WeatherChangeThresholds& thresholds = WeatherChangeThresholds(),
+                                   time_t now = std::time(nullptr));
+
+    // Changes at stations within halfWidthNM of any leg; needs positions
+    SubscriptionId subscribeCorridor(const std::vector<Position>& route, double halfWidthNM,
+                                     WeatherChangeCallback callback,
+                                     const WeatherChangeThresholds& thresholds = WeatherChangeThresholds(),
+                                     time_t now = std::time(nullptr));
+
+    bool unsubscribe(SubscriptionId id);
+    size_t subscriptionCount() const;
+
+private:
+    enum class Scope { STATIONS, REGION, CORRIDOR };
+
+    struct Subscription {
+        Scope scope = Scope::STATIONS;
+        std::unordered_set<StationKey> stations;
+        double latitude = 0.0, longitude = 0.0;
+        std::vector<Position> route;
+        double rangeNM = 0.0;               // Region radius or corridor half width
+        WeatherChangeThresholds thresholds;
+        std::shared_ptr<const WeatherChangeCallback> callback;
+        std::unordered_map<StationKey, StationSummary> known;
+    };
+
+    SubscriptionId add(Subscription&& subscription, time_t now);
+    bool inScope(const Subscription& subscription, StationKey station, const StationPosition* position) const;
+    static uint8_t materialChange(const WeatherChangeThresholds& thresholds, const StationSummary& previous,
+                                  const StationSummary& current);
+    void onChanges(const std::vector<StationChange>& changes);
+
+    std::shared_ptr<WeatherStationStore> store_;
+    std::shared_ptr<const WeatherInterpolator> positions_;
+    uint64_t listenerId_ = 0;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<SubscriptionId, Subscription> subscriptions_;
+    SubscriptionId nextId_ = 1;
+};
+
+} // namespace AICopilot
+
+#endif // WEATHER_SUBSCRIPTIONS_HPP
@@ -21,9 +21,15 @@
 #include "aicopilot_types.h"
 #include <vector>
 #include <memory>
+#include <string>
 
 namespace AICopilot {
 
+class WeatherStationStore;
+class WeatherInterpolator;
+struct InterpolatedWeather;
+class HazardGrid;
+
 // Weather hazard types
 enum class WeatherHazardType {
     THUNDERSTORM,
@@ -76,6 +82,27 @@ public:
     // Get current weather
     WeatherConditions getCurrentWeather() const { return currentWeather_; }
     
+    // Read airport weather from a shared station store (see WeatherDatabase::getStationStore)
+    void setStationStore(std::shared_ptr<const WeatherStationStore> store) { stationStore_ = std::move(store); }
+    
+    // Update current conditions from a station's METAR; false, leaving the
+    // conditions alone, if no store is set or it has no current report
+    bool updateFromStation(const std::string& icao);
+    
+    // Sample station weather along routes and at positions (see
+    // WeatherDatabase::getInterpolator); without one only the current
+    // conditions' hazards are reported
+    void setWeatherInterpolator(std::shared_ptr<const WeatherInterpolator> interpolator) {
+        interpolator_ = std::move(interpolator);
+    }
+    
+    // Read positioned hazards (storm cells, shear alerts) from a grid the
+    // caller keeps updated as they move; hazard queries then check it first
+    void setHazardGrid(std::shared_ptr<const HazardGrid> grid) { hazardGrid_ = std::move(grid); }
+    
+    // Spacing of route weather samples, nautical miles
+    static constexpr double ROUTE_SAMPLE_SPACING_NM = 10.0;
+    
     // Detect weather hazards along route
     std::vector<WeatherHazard> detectHazardsAlongRoute(
         const Position& start,
@@ -131,12 +158,19 @@ public:
 private:
     WeatherConditions currentWeather_;
     std::vector<WeatherHazard> activeHazards_;
+    std::shared_ptr<const WeatherStationStore> stationStore_;
+    std::shared_ptr<const WeatherInterpolator> interpolator_;
+    std::shared_ptr<const HazardGrid> hazardGrid_;
     
     // Helper methods
     bool isIcingRisk(double altitude, double temperature) const;
     bool isTurbulenceRisk(double windSpeed) const;
     double calculateVisibilityRisk() const;
     HazardSeverity determineSeverity(const WeatherConditions& wx) const;
+    
+    // Hazards in interpolated station weather at a position and altitude
+    void appendSampledHazards(const InterpolatedWeather& sample, const Position& pos,
+                              double altitude, std::vector<WeatherHazard>& hazards) const;
 };
 
 } // namespace AICopilot
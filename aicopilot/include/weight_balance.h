@@ -15,7 +15,10 @@
 
 #include "aicopilot_types.h"
 #include "aircraft_config.h"
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace AICopilot {
@@ -41,6 +44,52 @@ struct CGEnvelope {
     double macLeadingEdgeLocation;  // distance from datum in feet
 };
 
+/**
+ * CG envelope prepared for containment tests
+ *
+ * The envelope is x-monotone in weight: forward and aft limits are
+ * piecewise linear between the envelope points. Segments are stored as
+ * slope/intercept pairs and a uniform weight bucket table maps a weight
+ * straight to its segment, so a test is a bucket lookup and two line
+ * evaluations. Below the first point the first limits hold; above the
+ * last point nothing is inside.
+ */
+class CGEnvelopeIndex {
+public:
+    void build(const CGEnvelope& envelope);
+    
+    bool empty() const { return !built_; }
+    
+    // Limits at a weight; false when above the envelope
+    bool limits(double weight, double& forwardLimit, double& aftLimit) const;
+    
+    bool contains(double weight, double cgLocation) const {
+        double forwardLimit, aftLimit;
+        return limits(weight, forwardLimit, aftLimit) && cgLocation >= forwardLimit && cgLocation <= aftLimit;
+    }
+    
+private:
+    static constexpr size_t BUCKETS = 32;
+    
+    struct Segment {
+        double maxWeight;   // inclusive upper weight
+        double forwardSlope, forwardIntercept;
+        double aftSlope, aftIntercept;
+    };
+    
+    std::vector<Segment> segments_;       // by weight
+    std::vector<uint32_t> bucketSegment_; // first segment reaching into each bucket
+    double firstWeight_ = 0.0;
+    double lastWeight_ = 0.0;
+    double bucketScale_ = 0.0;
+    bool built_ = false;
+    double firstForward_ = 0.0;
+    double firstAft_ = 0.0;
+};
+
+using WeightItemId = uint32_t;
+constexpr WeightItemId INVALID_WEIGHT_ITEM = UINT32_MAX;
+
 /**
  * Weight item (seat, cargo, fuel, etc.)
  */
@@ -67,6 +116,41 @@ struct WeightBalanceResult {
     std::string report;
 };
 
+/**
+ * Weight and CG from the running totals, without the report
+ */
+struct CGPosition {
+    double totalWeight;      // lbs
+    double cgLocation;       // % of MAC
+    bool withinEnvelope;     // inside the CG envelope and weight limits
+};
+
+/**
+ * One sample of CG as fuel burns
+ */
+struct CGTrajectoryPoint {
+    double fuelRemaining;    // lbs in the fuel items
+    double elapsedHours;     // at the burn rate
+    double totalWeight;      // lbs
+    double cgLocation;       // % of MAC
+    bool withinEnvelope;
+};
+
+/**
+ * CG from the current load down to empty tanks, first sample at the current fuel
+ */
+struct CGTrajectory {
+    std::vector<CGTrajectoryPoint> points;
+    
+    // First sample outside the envelope, or nullptr if all stay inside
+    const CGTrajectoryPoint* firstExcursion() const {
+        for (const auto& point : points) {
+            if (!point.withinEnvelope) return &point;
+        }
+        return nullptr;
+    }
+};
+
 /**
  * Comprehensive Weight and Balance System
  * Validates weight distribution and CG position
@@ -87,19 +171,26 @@ public:
     bool loadCGEnvelope(const CGEnvelope& envelope);
     
     /**
-     * Add weight item
+     * Add weight item; the ID stays valid until the item is removed
      */
-    void addWeightItem(const WeightItem& item);
+    WeightItemId addWeightItem(const WeightItem& item);
     
     /**
-     * Remove weight item by name
+     * Remove weight item by name or ID
      */
     void removeWeightItem(const std::string& name);
+    void removeWeightItem(WeightItemId id);
     
     /**
-     * Update weight item
+     * Update weight item; O(1) by ID, keeping the running totals
      */
     void updateWeightItem(const std::string& name, double newWeight);
+    void updateWeightItem(WeightItemId id, double newWeight);
+    
+    /**
+     * ID of the first item with this name, or INVALID_WEIGHT_ITEM
+     */
+    WeightItemId findWeightItem(const std::string& name) const;
     
     /**
      * Get all weight items
@@ -111,6 +202,19 @@ public:
      */
     WeightBalanceResult calculateWeightBalance();
     
+    /**
+     * Current weight and CG from the running totals; cheap enough per tick
+     */
+    CGPosition getCGPosition() const;
+    
+    /**
+     * CG as the fuel items burn down together, in proportion to their load,
+     * sampled at `steps` equal fuel intervals
+     */
+    CGTrajectory computeFuelBurnTrajectory(
+        double fuelBurnRate,     // lbs per hour
+        size_t steps = 64) const;
+    
     /**
      * Check if within limits
      */
@@ -155,12 +259,24 @@ public:
 private:
     AircraftConfig aircraftConfig_;
     CGEnvelope cgEnvelope_;
+    CGEnvelopeIndex envelopeIndex_;
     std::vector<WeightItem> weightItems_;
     WeightBalanceResult lastResult_;
     
+    // Item IDs: index into weightItems_ by ID and back
+    std::vector<WeightItemId> itemIds_;
+    std::vector<size_t> itemIndex_;
+    std::unordered_map<std::string, WeightItemId> itemsByName_;
+    
+    // Running sums over weightItems_
+    double totalWeight_ = 0.0;
+    double totalMoment_ = 0.0;
+    
     // Calculation helpers
     void calculateMoments();
-    bool validateCGPosition(double totalWeight, double cgLocation);
+    void setEnvelope(const CGEnvelope& envelope);
+    double cgPercentMAC(double totalWeight, double totalMoment) const;
+    bool validateCGPosition(double totalWeight, double cgLocation) const;
     bool interpolateCGLimits(double weight, 
                             double& forwardLimit, 
                             double& aftLimit) const;
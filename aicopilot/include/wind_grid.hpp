@@ -0,0 +1,150 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Wind Grid - gridded winds and temperatures aloft for flight planning
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef WIND_GRID_HPP
+#define WIND_GRID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AICopilot {
+
+// Interpolated conditions at one point
+struct WindGridSample {
+    double eastKts = 0.0;        // wind vector, towards east
+    double northKts = 0.0;       // wind vector, towards north
+    double temperatureC = 0.0;
+};
+
+/**
+ * Legs to evaluate in one call, as structure-of-arrays
+ *
+ * Fill the inputs with add() (or resize() and write them directly), then
+ * WindGrid::evaluate() writes the outputs. Reuse one batch across calls;
+ * its arrays, including the interpolation scratch, keep their capacity.
+ */
+struct WindGridLegBatch {
+    // Inputs
+    std::vector<double> latitude;
+    std::vector<double> longitude;
+    std::vector<double> altitude;        // feet MSL
+    std::vector<double> time;            // seconds, in the grid's time base
+    std::vector<double> trackRad;        // true track
+    std::vector<double> trueAirspeed;    // knots
+
+    // Outputs
+    std::vector<double> groundSpeed;     // knots, never below MIN_GROUND_SPEED_FRACTION of TAS
+    std::vector<double> alongTrackWind;  // knots, positive for a tailwind
+    std::vector<double> temperatureC;
+
+    size_t size() const { return latitude.size(); }
+    void clear() { resize(0); }
+    void resize(size_t count);
+    size_t add(double lat, double lon, double altitudeFeet, double timeSeconds,
+               double track, double tas);
+
+private:
+    friend class WindGrid;
+    std::vector<uint32_t> base_;         // grid offset of the lowest corner
+    std::vector<float> weights_;         // [item * CORNERS + corner]
+};
+
+/**
+ * Winds and temperatures on a latitude x longitude x level x time grid
+ *
+ * Latitude, longitude and time are evenly spaced; levels are any ascending
+ * altitudes. Values are interpolated linearly along each axis (16 corners)
+ * and clamp at the grid edges, so a grid one cell wide on an axis is
+ * constant along it. Samples are stored per field in flat float arrays.
+ *
+ * evaluate() runs in passes over the whole batch - cell lookup, corner
+ * blend, wind triangle - each a tight loop over contiguous arrays without
+ * per-item allocation or virtual calls, which the compiler vectorizes
+ * where the target allows. Immutable once filled; concurrent evaluate()
+ * calls on separate batches are safe.
+ */
+class WindGrid {
+public:
+    static constexpr size_t CORNERS = 16;
+    static constexpr double MIN_GROUND_SPEED_FRACTION = 0.25;
+
+    struct Axis {
+        double origin = 0.0;
+        double step = 1.0;
+        size_t count = 1;
+    };
+
+    /**
+     * Allocate a calm, ISA-temperature grid
+     * @param latitude Latitude axis, degrees
+     * @param longitude Longitude axis, degrees
+     * @param levels Ascending altitudes, feet MSL
+     * @param time Time axis, seconds
+     * @return false if an axis is empty, a step is not positive or levels are not ascending
+     */
+    bool configure(const Axis& latitude, const Axis& longitude,
+                   const std::vector<double>& levels, const Axis& time);
+
+    bool isConfigured() const { return !levels_.empty(); }
+
+    /**
+     * Set one grid point
+     * @param windDirection Degrees the wind blows from
+     * @param windSpeed Knots
+     * @param temperatureC Static air temperature
+     */
+    void setPoint(size_t latIndex, size_t lonIndex, size_t levelIndex, size_t timeIndex,
+                  double windDirection, double windSpeed, double temperatureC);
+
+    WindGridSample sample(double lat, double lon, double altitudeFeet, double timeSeconds) const;
+
+    // Ground speed, along-track wind and temperature for every leg of a batch
+    void evaluate(WindGridLegBatch& batch) const;
+
+    // Strongest wind anywhere in the grid, knots
+    double getMaxWindSpeed() const { return maxWindSpeed_; }
+
+private:
+    size_t offset(size_t lat, size_t lon, size_t level, size_t time) const {
+        return ((time * levels_.size() + level) * latitude_.count + lat) * longitude_.count + lon;
+    }
+    void locate(WindGridLegBatch& batch) const;
+
+    void blend(const WindGridLegBatch& batch, size_t i, double& east, double& north, double& temperature) const {
+        const float* w = &batch.weights_[i * CORNERS];
+        const uint32_t base = batch.base_[i];
+        double e = 0.0, n = 0.0, t = 0.0;
+        for (size_t c = 0; c < CORNERS; ++c) {
+            const uint32_t at = base + cornerOffset_[c];
+            e += w[c] * east_[at];
+            n += w[c] * north_[at];
+            t += w[c] * temperature_[at];
+        }
+        east = e;
+        north = n;
+        temperature = t;
+    }
+
+    Axis latitude_;
+    Axis longitude_;
+    Axis time_;
+    std::vector<double> levels_;
+    std::vector<float> east_;
+    std::vector<float> north_;
+    std::vector<float> temperature_;
+    uint32_t cornerOffset_[CORNERS] = {};
+    double maxWindSpeed_ = 0.0;
+};
+
+} // namespace AICopilot
+
+#endif // WIND_GRID_HPP
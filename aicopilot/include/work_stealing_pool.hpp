@@ -0,0 +1,80 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Work-Stealing Pool - fixed thread pool with per-worker job deques
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AICopilot {
+
+/**
+ * Fixed-size thread pool with work stealing
+ *
+ * Jobs are spread round-robin over per-worker deques. A worker pops its own
+ * deque from the back and, once empty, steals from the front of the others,
+ * so uneven jobs (one pilot on approach, another cruising) still keep every
+ * core busy.
+ */
+class WorkStealingPool {
+public:
+    using Job = std::function<void()>;
+
+    // 0 uses std::thread::hardware_concurrency()
+    explicit WorkStealingPool(size_t threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(Job job);
+
+    // Block until every submitted job has finished
+    void wait();
+
+    size_t getThreadCount() const { return threads_.size(); }
+    uint64_t getStealCount() const { return steals_.load(std::memory_order_relaxed); }
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    bool popLocal(size_t index, Job& job);
+    bool steal(size_t thief, Job& job);
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex stateMutex_;
+    std::condition_variable workCv_;
+    std::condition_variable idleCv_;
+    size_t queued_ = 0;       // jobs waiting in any deque, guarded by stateMutex_
+    size_t unfinished_ = 0;   // queued + running, guarded by stateMutex_
+    bool stopping_ = false;
+
+    std::atomic<size_t> nextQueue_{0};
+    std::atomic<uint64_t> steals_{0};
+};
+
+} // namespace AICopilot
+
+#endif // WORK_STEALING_POOL_HPP
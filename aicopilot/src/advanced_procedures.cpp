@@ -16,13 +16,154 @@
 *****************************************************************************/
 
 #include "advanced_procedures.hpp"
+#include "navdata_provider.h"
+#include "weather_station_store.hpp"
+#include "work_stealing_pool.hpp"
+#include "geodesy.hpp"
+#include "coordinate_utils.hpp"
+#include "runway_wind.hpp"
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
 #include <iomanip>
 
 namespace AICopilot {
 
+namespace {
+
+// Approaches tried on every runway, best first; RNAV assumes GPS
+struct ApproachMinima {
+    ApproachType type;
+    double ceiling;      // feet
+    double visibility;   // statute miles
+    double cost;         // nautical miles added to the option's cost
+};
+
+constexpr ApproachMinima APPROACH_MINIMA[] = {
+    {ApproachType::ILS, 200.0, 0.5, 0.0},
+    {ApproachType::RNAV, 400.0, 1.0, 5.0},
+    {ApproachType::VISUAL, 1000.0, 3.0, 10.0},
+};
+
+constexpr double CROSSWIND_COST = 0.5;         // nautical miles per knot
+constexpr double UNKNOWN_WEATHER_COST = 15.0;  // no current METAR
+
+double fuelForDistance(double distance, double reserveMinutes, double cruiseSpeed, double fuelFlow) {
+    double flightTime = distance / cruiseSpeed;  // hours
+    return flightTime * fuelFlow + (reserveMinutes / 60.0) * fuelFlow;
+}
+
+// Shared by planDiversion and its jobs, which may outlive a plan that hit its deadline
+struct DiversionSearch {
+    DiversionRequest request;   // limits resolved
+    double cruiseSpeed = 0.0;
+    double fuelFlow = 0.0;
+    std::shared_ptr<const INavdataProvider> navdata;
+    std::shared_ptr<const WeatherStationStore> weather;
+    std::atomic<bool> cancelled{false};
+    
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::vector<DiversionOption> best;   // one per airport, best first
+    size_t evaluated = 0;
+    size_t scored = 0;
+};
+
+// Best option at one airport; false if none qualifies. scored counts combinations tried.
+bool evaluateAirport(const DiversionSearch& search, const AirportInfo& airport,
+                     DiversionOption& best, size_t& scored) {
+    const DiversionRequest& request = search.request;
+    double distance = Geodesy::haversineNM(request.position.latitude, request.position.longitude,
+                                           airport.position.latitude, airport.position.longitude);
+    if (distance > request.maxDistance) return false;
+    double fuelRequired = fuelForDistance(distance, request.fuelReserveMinutes,
+                                          search.cruiseSpeed, search.fuelFlow);
+    if (request.fuelRemaining > 0.0 && fuelRequired > request.fuelRemaining) return false;
+    
+    AirportLayout layout;
+    if (!search.navdata->getAirportLayout(airport.icao, layout)) return false;
+    
+    // One weather read for every runway and approach; gusts count
+    bool reported = false;
+    double windDirection = 0.0, windSpeed = 0.0, ceiling = 0.0, visibility = 0.0;
+    if (search.weather) {
+        reported = search.weather->visit(airport.icao, [&](const WeatherStationStore::Report& report) {
+            const METARObservation& wx = report.observation;
+            if (wx.hasWind && !wx.windVariable) {
+                windDirection = wx.windDirection;
+                windSpeed = std::max(wx.windSpeed, wx.windGust);
+            }
+            ceiling = wx.ceilingFeet();
+            visibility = wx.visibilitySM;
+        });
+    }
+    
+    // Components for every runway at once; headings are true, like METAR winds
+    RunwayWind::CrosswindMatrix matrix;
+    matrix.addAirport();
+    for (const Airport::Runway& runway : layout.runways) {
+        matrix.addRunway(runway.heading_true);
+    }
+    std::vector<double> headwinds(matrix.runwayCount()), crosswinds(matrix.runwayCount());
+    matrix.evaluate(RunwayWind::wind(windDirection, windSpeed), headwinds.data(), crosswinds.data());
+    
+    bool found = false;
+    for (size_t r = 0; r < layout.runways.size(); ++r) {
+        const Airport::Runway& runway = layout.runways[r];
+        if (!runway.is_active || runway.length_feet < request.minRunwayLength) continue;
+        
+        double headwind = headwinds[r];
+        double crosswind = std::abs(crosswinds[r]);
+        if (crosswind > request.maxCrosswind || -headwind > request.maxTailwind) continue;
+        
+        for (const ApproachMinima& minima : APPROACH_MINIMA) {
+            if (minima.type == ApproachType::ILS && !runway.has_ils) continue;
+            if (reported && (ceiling < minima.ceiling || visibility < minima.visibility)) continue;
+            scored++;
+            
+            double cost = distance + minima.cost + CROSSWIND_COST * crosswind +
+                          (reported ? 0.0 : UNKNOWN_WEATHER_COST);
+            if (found && cost >= best.cost) continue;
+            found = true;
+            best.icao = airport.icao;
+            best.runway = runway.runway_ident;
+            best.approach = minima.type;
+            best.position = airport.position;
+            best.distance = distance;
+            best.fuelRequired = fuelRequired;
+            best.headwind = headwind;
+            best.crosswind = crosswind;
+            best.weatherReported = reported;
+            best.cost = cost;
+        }
+    }
+    return found;
+}
+
+void runAirportJob(DiversionSearch& search, const AirportInfo& airport, size_t total) {
+    DiversionOption option;
+    size_t scored = 0;
+    bool found = !search.cancelled.load(std::memory_order_relaxed) &&
+                 evaluateAirport(search, airport, option, scored);
+    
+    std::lock_guard<std::mutex> lock(search.mutex);
+    search.scored += scored;
+    if (found) {
+        auto at = std::upper_bound(search.best.begin(), search.best.end(), option,
+                                   [](const DiversionOption& a, const DiversionOption& b) { return a.cost < b.cost; });
+        if (static_cast<size_t>(at - search.best.begin()) < search.request.maxOptions) {
+            search.best.insert(at, std::move(option));
+            if (search.best.size() > search.request.maxOptions) search.best.pop_back();
+        }
+    }
+    if (++search.evaluated == total) search.finished.notify_all();
+}
+
+} // namespace
+
 AdvancedProcedures::AdvancedProcedures()
     : initialized_(false),
       currentStatus_(ProcedureStatus::NOT_STARTED) {
@@ -92,6 +233,12 @@ EngineFailureProcedure AdvancedProcedures::handleEngineFailure(
         result.singleEngineClimbPerformance = std::max(0.0, profile_.climbRate * 0.3);  // ~30% climb performance
     }
     
+    // Engine-out climb paths that clear terrain, straight ahead first
+    if (terrain_ && result.singleEngineClimbPerformance > 0.0) {
+        result.clearClimbHeadings = findClearClimbHeadings(currentState, currentAltitude,
+                                                           result.singleEngineClimbPerformance);
+    }
+    
     // Subsequent actions
     result.subsequentActions = {
         "Check fuel quantity and distribution",
@@ -103,12 +250,29 @@ EngineFailureProcedure AdvancedProcedures::handleEngineFailure(
         "Declare minimum fuel if needed"
     };
     
-    // Find nearest airports
-    result.preferredAirports = {
-        Waypoint{{currentState.position.latitude, currentState.position.longitude, currentAltitude, 0}, "DIVERT_1"},
-        Waypoint{{currentState.position.latitude + 0.1, currentState.position.longitude + 0.1, currentAltitude, 0}, "DIVERT_2"},
-        Waypoint{{currentState.position.latitude - 0.1, currentState.position.longitude - 0.1, currentAltitude, 0}, "DIVERT_3"}
-    };
+    if (terrain_ && result.singleEngineClimbPerformance > 0.0) {
+        if (result.clearClimbHeadings.empty()) {
+            result.subsequentActions.insert(result.subsequentActions.begin(),
+                "No engine-out climb path clears terrain - climb in a holding pattern");
+        } else {
+            int heading = static_cast<int>(std::lround(result.clearClimbHeadings[0])) % 360;
+            result.subsequentActions.insert(result.subsequentActions.begin(),
+                "Engine-out climb heading " + std::to_string(heading) + " clears terrain");
+        }
+    }
+    
+    // Find nearest airports, within glide range without power
+    if (navdata_) {
+        double reach = result.engineType == EngineType::PISTON_SINGLE ? result.estimatedGlideRange : 100.0;
+        result.preferredAirports = findNearestAirports(currentState.position, 3, reach,
+                                                       currentState.fuelQuantity);
+    } else {
+        result.preferredAirports = {
+            Waypoint{{currentState.position.latitude, currentState.position.longitude, currentAltitude, 0}, "DIVERT_1"},
+            Waypoint{{currentState.position.latitude + 0.1, currentState.position.longitude + 0.1, currentAltitude, 0}, "DIVERT_2"},
+            Waypoint{{currentState.position.latitude - 0.1, currentState.position.longitude - 0.1, currentAltitude, 0}, "DIVERT_3"}
+        };
+    }
     
     currentStatus_ = ProcedureStatus::IN_PROGRESS;
     
@@ -559,23 +723,10 @@ AdvancedProcedures::CrosswindComponents AdvancedProcedures::calculateCrosswindCo
     double windDirection,
     double runwayHeading) {
     
+    RunwayWind::Components wind = RunwayWind::compute(runwayHeading, windDirection, windSpeed);
     CrosswindComponents result;
-    
-    // Convert to radians
-    double windDir = windDirection * M_PI / 180.0;
-    double runwayDir = runwayHeading * M_PI / 180.0;
-    
-    // Calculate relative wind angle
-    double relativeAngle = windDir - runwayDir;
-    
-    // Normalize angle to -180 to 180
-    while (relativeAngle > M_PI) relativeAngle -= 2 * M_PI;
-    while (relativeAngle < -M_PI) relativeAngle += 2 * M_PI;
-    
-    // Calculate headwind and crosswind
-    result.headwind = windSpeed * std::cos(relativeAngle);
-    result.crosswind = windSpeed * std::sin(relativeAngle);
-    
+    result.headwind = wind.headwind;
+    result.crosswind = wind.crosswind;
     return result;
 }
 
@@ -612,13 +763,22 @@ Waypoint AdvancedProcedures::selectRunwayForCrosswind(
     Waypoint bestRunway;
     double bestScore = 1e9;
     
-    for (const auto& runway : availableRunways) {
-        CrosswindComponents components = calculateCrosswindComponents(
-            windSpeed, windDirection, runway.position.heading);
-        
-        double crosswind = std::abs(components.crosswind);
-        double headwind = components.headwind;
-        double tailwind = -components.headwind;
+    // Headings as unit vectors, then every runway's components in one pass
+    const size_t count = availableRunways.size();
+    std::vector<double> headingSin(count), headingCos(count), headwinds(count), crosswinds(count);
+    for (size_t i = 0; i < count; ++i) {
+        RunwayWind::Heading heading = RunwayWind::heading(availableRunways[i].position.heading);
+        headingSin[i] = heading.sin;
+        headingCos[i] = heading.cos;
+    }
+    RunwayWind::computeBatch(count, headingSin.data(), headingCos.data(),
+                             RunwayWind::wind(windDirection, windSpeed),
+                             headwinds.data(), crosswinds.data());
+    
+    for (size_t i = 0; i < count; ++i) {
+        double crosswind = std::abs(crosswinds[i]);
+        double headwind = headwinds[i];
+        double tailwind = -headwinds[i];
         
         // Check constraints
         if (crosswind > aircraftMaxCrosswind) continue;
@@ -630,7 +790,7 @@ Waypoint AdvancedProcedures::selectRunwayForCrosswind(
         
         if (score < bestScore) {
             bestScore = score;
-            bestRunway = runway;
+            bestRunway = availableRunways[i];
         }
     }
     
@@ -700,15 +860,32 @@ WeatherDivertParameters AdvancedProcedures::planWeatherDivert(
     
     WeatherDivertParameters result;
     
-    // Select best alternate (typically nearest with good weather)
+    // Select best alternate: the best-scored one when airport data is
+    // available, otherwise the first given
     if (!alternateAirports.empty()) {
         result.targetAirport = alternateAirports[0];
     }
+    if (navdata_ && !alternateAirports.empty()) {
+        DiversionRequest request;
+        request.position = currentPosition;
+        request.fuelRemaining = currentFuel;
+        request.maxDistance = profile_.range > 0.0 ? profile_.range : request.maxDistance;
+        request.maxOptions = 1;
+        for (const Waypoint& alternate : alternateAirports) {
+            request.airports.push_back(alternate.id);
+        }
+        DiversionPlan plan = planDiversion(request, DEFAULT_DIVERSION_DEADLINE);
+        if (!plan.options.empty()) {
+            auto chosen = std::find_if(alternateAirports.begin(), alternateAirports.end(),
+                                       [&](const Waypoint& w) { return w.id == plan.options[0].icao; });
+            if (chosen != alternateAirports.end()) result.targetAirport = *chosen;
+        }
+    }
     
     // Calculate distances and fuel
-    double latDiff = result.targetAirport.position.latitude - currentPosition.latitude;
-    double lonDiff = result.targetAirport.position.longitude - currentPosition.longitude;
-    result.routeDistance = std::sqrt(latDiff * latDiff + lonDiff * lonDiff) * 60.0;  // Rough conversion to NM
+    result.routeDistance = Geodesy::haversineNM(currentPosition.latitude, currentPosition.longitude,
+                                                result.targetAirport.position.latitude,
+                                                result.targetAirport.position.longitude);
     
     result.estimatedFlightTime = (result.routeDistance / profile_.cruiseSpeed) * 60.0;  // minutes
     result.requiredFuel = (result.routeDistance / profile_.range) * profile_.fuelCapacity + 30.0;  // 30 gal reserve
@@ -734,17 +911,11 @@ double AdvancedProcedures::calculateFuelForAlternate(
     const Waypoint& alternate,
     double fuelReserve) {
     
-    // Simple distance calculation
-    double latDiff = alternate.position.latitude - currentPos.latitude;
-    double lonDiff = alternate.position.longitude - currentPos.longitude;
-    double distance = std::sqrt(latDiff * latDiff + lonDiff * lonDiff) * 60.0;  // NM
+    double distance = Geodesy::haversineNM(currentPos.latitude, currentPos.longitude,
+                                           alternate.position.latitude, alternate.position.longitude);
     
-    // Fuel required
-    double flightTime = (distance / profile_.cruiseSpeed);  // hours
-    double fuelRequired = (flightTime * profile_.fuelFlow) + 
-                         ((fuelReserve / 60.0) * profile_.fuelFlow);
-    
-    return fuelRequired;
+    // Same rule the diversion planner applies to every candidate
+    return fuelForDistance(distance, fuelReserve, profile_.cruiseSpeed, profile_.fuelFlow);
 }
 
 // ============================================================
@@ -899,13 +1070,138 @@ double AdvancedProcedures::calculateSingleEnginePerformance(double altitude) con
     return profile_.climbRate * 0.3 * std::max(0.0, altitudeMultiplier);
 }
 
+// ============================================================
+// DIVERSION PLANNING
+// ============================================================
+
+void AdvancedProcedures::setDiversionSources(std::shared_ptr<const INavdataProvider> navdata,
+                                             std::shared_ptr<const WeatherStationStore> weather,
+                                             WorkStealingPool* pool) {
+    navdata_ = std::move(navdata);
+    weatherStations_ = std::move(weather);
+    pool_ = pool;
+}
+
+std::vector<double> AdvancedProcedures::findClearClimbHeadings(const AircraftState& state, double altitude,
+                                                              double climbRateFpm) const {
+    // Straight ahead, then alternating left and right in widening turns
+    std::vector<double> headings{state.heading};
+    for (double turn = ENGINE_OUT_TURN_STEP_DEG; turn <= ENGINE_OUT_MAX_TURN_DEG; turn += ENGINE_OUT_TURN_STEP_DEG) {
+        headings.push_back(state.heading - turn);
+        headings.push_back(state.heading + turn);
+    }
+    
+    double speed = std::max(state.groundSpeed, profile_.vs1 + 10.0);
+    double climbFt = climbRateFpm * ENGINE_OUT_PATH_NM / speed * 60.0;
+    Position start{state.position.latitude, state.position.longitude, altitude, state.heading};
+    std::vector<std::vector<Position>> paths;
+    paths.reserve(headings.size());
+    for (double& heading : headings) {
+        heading = std::fmod(heading + 360.0, 360.0);
+        Position end = CoordinateUtils::destinationPoint(start.latitude, start.longitude, heading, ENGINE_OUT_PATH_NM);
+        end.altitude = altitude + climbFt;
+        paths.push_back({start, end});
+    }
+    
+    std::vector<PathClearanceResult> clearance = terrain_->checkPathClearances(paths, ENGINE_OUT_CLEARANCE_FT);
+    std::vector<double> clear;
+    for (size_t i = 0; i < headings.size(); ++i) {
+        if (clearance[i].clear) clear.push_back(headings[i]);
+    }
+    return clear;
+}
+
+double AdvancedProcedures::defaultMinRunwayLength() const {
+    switch (category_) {
+        case AircraftCategory::SINGLE_ENGINE_PISTON: return 2000.0;
+        case AircraftCategory::MULTI_ENGINE_PISTON: return 3000.0;
+        case AircraftCategory::TURBOPROP: return 3500.0;
+        case AircraftCategory::BUSINESS_JET: return 5000.0;
+        case AircraftCategory::JET_TRANSPORT: return 6500.0;
+        default: return 0.0;
+    }
+}
+
+DiversionPlan AdvancedProcedures::planDiversion(const DiversionRequest& request,
+                                                std::chrono::steady_clock::duration deadline) {
+    auto start = std::chrono::steady_clock::now();
+    DiversionPlan plan;
+    if (!navdata_ || profile_.cruiseSpeed <= 0.0) {
+        plan.complete = true;
+        return plan;
+    }
+    
+    auto search = std::make_shared<DiversionSearch>();
+    search->request = request;
+    if (search->request.minRunwayLength <= 0.0) search->request.minRunwayLength = defaultMinRunwayLength();
+    if (search->request.maxCrosswind <= 0.0) search->request.maxCrosswind = getProcedureLimits().maxCrosswindComponent;
+    search->cruiseSpeed = profile_.cruiseSpeed;
+    search->fuelFlow = profile_.fuelFlow;
+    search->navdata = navdata_;
+    search->weather = weatherStations_;
+    
+    // Candidate airports in one batch query
+    auto airports = std::make_shared<std::vector<AirportInfo>>();
+    if (!request.airports.empty()) {
+        navdata_->getAirportsByICAO(request.airports, *airports);
+        airports->erase(std::remove_if(airports->begin(), airports->end(),
+                                       [](const AirportInfo& a) { return a.icao.empty(); }),
+                        airports->end());
+    } else {
+        *airports = navdata_->getAirportsNearby(request.position, request.maxDistance);
+    }
+    const size_t total = airports->size();
+    plan.airportsConsidered = total;
+    
+    auto stopAt = start + deadline;
+    if (pool_ && total > 1) {
+        for (size_t i = 0; i < total; ++i) {
+            pool_->submit([search, airports, i, total] { runAirportJob(*search, (*airports)[i], total); });
+        }
+        std::unique_lock<std::mutex> lock(search->mutex);
+        search->finished.wait_until(lock, stopAt, [&] { return search->evaluated == total; });
+    } else {
+        for (size_t i = 0; i < total && std::chrono::steady_clock::now() < stopAt; ++i) {
+            runAirportJob(*search, (*airports)[i], total);
+        }
+    }
+    
+    // Anything still queued or running returns without touching the plan
+    search->cancelled = true;
+    {
+        std::lock_guard<std::mutex> lock(search->mutex);
+        plan.options = search->best;
+        plan.airportsEvaluated = search->evaluated;
+        plan.candidatesScored = search->scored;
+    }
+    plan.complete = plan.airportsEvaluated == total;
+    plan.elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return plan;
+}
+
 std::vector<Waypoint> AdvancedProcedures::findNearestAirports(
     const Position& pos,
     size_t count,
-    double maxDistance) {
+    double maxDistance,
+    double fuelRemaining) {
     
     std::vector<Waypoint> result;
     
+    if (navdata_) {
+        DiversionRequest request;
+        request.position = pos;
+        request.fuelRemaining = fuelRemaining;
+        request.maxDistance = maxDistance;
+        request.maxOptions = count;
+        for (const DiversionOption& option : planDiversion(request, DEFAULT_DIVERSION_DEADLINE).options) {
+            Waypoint airport;
+            airport.position = option.position;
+            airport.id = option.icao;
+            result.push_back(airport);
+        }
+        return result;
+    }
+    
     // Simulate finding nearest airports (in production, query airport database)
     for (size_t i = 0; i < count; ++i) {
         Waypoint airport;
@@ -10,8 +10,9 @@
 #include "../include/ai_pilot.h"
 #include "../include/navdata_provider.h"
 #include "../include/weather_system.h"
+#include "../include/hot_path_trace.hpp"
+#include "../include/binary_log.hpp"
 #include <chrono>
-#include <iostream>
 #include <sstream>
 #include <cmath>
 #include <algorithm>
@@ -19,46 +20,230 @@
 namespace AICopilot {
 
 AIPilot::AIPilot() 
-    : active_(false)
+    : navdataProvider_(nullptr)
+    , weatherSystem_(nullptr)
+    , routeWeatherSubscription_(WeatherSubscriptions::INVALID_SUBSCRIPTION)
+    , routeWeather_(std::make_shared<RouteWeatherInbox>())
+    , weatherAssessed_(false)
+    , active_(false)
     , manualOverride_(false)
     , currentPhase_(FlightPhase::UNKNOWN)
     , fuelWarning20Shown_(false)
     , fuelWarning10Shown_(false)
     , airportOpsInitialized_(false)
-    , navdataProvider_(nullptr)
-    , weatherSystem_(nullptr) {
+    , preflightComplete_(false)
+    , shutdownComplete_(false)
+    , terrainElevation_(0.0)
+    , terrainElevationValid_(false) {
 }
 
 AIPilot::~AIPilot() {
     stopAutonomousFlight();
+    stopFlightDataRecording();
+    if (weatherSubscriptions_) {
+        weatherSubscriptions_->unsubscribe(routeWeatherSubscription_);
+    }
 }
 
-bool AIPilot::initialize(SimulatorType simType) {
+bool AIPilot::initialize(SimulatorType simType, int configIndex) {
     log("Initializing AI Pilot");
     
+    fastReplay_ = false;
     simConnect_ = std::make_shared<SimConnectWrapper>();
+    simConnect_->setConfigIndex(configIndex);
     if (!simConnect_->connect(simType, "AI Copilot FS")) {
         log("ERROR: Failed to connect to simulator");
         return false;
     }
     
-    // Initialize navdata provider for airport/navaid lookups
-    navdataProvider_ = std::make_shared<SimConnectNavdataProvider>();
-    if (!navdataProvider_->initialize()) {
-        log("WARNING: Failed to initialize navdata provider - airport search will be limited");
-        // Not a critical failure, continue with cached provider as fallback
-        navdataProvider_ = std::make_shared<CachedNavdataProvider>();
-        navdataProvider_->initialize();
+    // Pump SimConnect on its own thread so state reads are never a frame stale
+    if (threading_.dispatchThread && !simConnect_->startDispatchThread()) {
+        log("WARNING: Dispatch thread unavailable - falling back to polled messages");
     }
     
-    // Initialize weather system
-    weatherSystem_ = std::make_unique<WeatherSystem>();
-    log("Weather system initialized");
+    if (!initializeServices()) {
+        return false;
+    }
     
     log("Connected to simulator");
     return true;
 }
 
+bool AIPilot::initializeReplay(const std::string& capturePath, ReplayPacing pacing) {
+    log("Initializing AI Pilot from capture: " + capturePath);
+    
+    simConnect_ = std::make_shared<SimConnectWrapper>();
+    if (!simConnect_->connectReplay(capturePath, pacing)) {
+        log("ERROR: Failed to open SimConnect capture");
+        return false;
+    }
+    
+    // Fast replay advances one control period per update(), so it must stay polled
+    fastReplay_ = pacing == ReplayPacing::AS_FAST_AS_POSSIBLE;
+    if (fastReplay_) {
+        simConnect_->setReplayStep(1.0 / CONTROL_RATE_HZ);
+    }
+    if (pacing == ReplayPacing::WALL_CLOCK && threading_.dispatchThread &&
+        !simConnect_->startDispatchThread()) {
+        log("WARNING: Replay thread unavailable - falling back to polled messages");
+    }
+    
+    if (!initializeServices()) {
+        return false;
+    }
+    
+    log("Replaying capture");
+    return true;
+}
+
+bool AIPilot::initializeHeadless(const HeadlessSimConfig& config) {
+    log("Initializing AI Pilot on the headless flight model");
+    
+    simConnect_ = std::make_shared<HeadlessSimConnect>(config);
+    simConnect_->connect(SimulatorType::UNKNOWN, "AI Copilot FS");
+    fastReplay_ = true;
+    simConnect_->setReplayStep(1.0 / CONTROL_RATE_HZ);
+    
+    if (!initializeServices()) {
+        return false;
+    }
+    
+    log("Headless sim ready");
+    return true;
+}
+
+bool AIPilot::startRecording(const std::string& capturePath) {
+    if (!simConnect_ || !simConnect_->isConnected()) {
+        log("ERROR: Not connected to simulator");
+        return false;
+    }
+    return simConnect_->startRecording(capturePath);
+}
+
+void AIPilot::stopRecording() {
+    if (simConnect_) {
+        simConnect_->stopRecording();
+    }
+}
+
+bool AIPilot::startFlightDataRecording(const std::string& path, std::shared_ptr<FlightDataRecorder> recorder) {
+    if (!simConnect_ || !simConnect_->isConnected()) {
+        log("ERROR: Not connected to simulator");
+        return false;
+    }
+    stopFlightDataRecording();
+    if (!recorder) return false;
+    flightData_ = recorder->openStream(path);
+    if (!flightData_) {
+        log("ERROR: Cannot create flight data recording " + path);
+        return false;
+    }
+    flightDataRecorder_ = std::move(recorder);
+    flightDataStartUs_ = flightDataClockUs();
+    return true;
+}
+
+void AIPilot::stopFlightDataRecording() {
+    if (!flightData_) return;
+    flightData_->close();
+    if (flightData_->getDroppedRows() > 0) {
+        log("WARNING: Flight data recorder dropped " + std::to_string(flightData_->getDroppedRows()) + " rows");
+    }
+    flightData_.reset();
+    flightDataRecorder_.reset();
+}
+
+bool AIPilot::initializeServices() {
+    // Coalesce control/autopilot writes and send them once per update cycle
+    simConnect_->setCommandBatching(true);
+    
+    // Independent subsystems load side by side; host steps (ML model, TTS)
+    // may still be running when the pilot is ready for preflight
+    initializer_.reset();   // waits for the previous session's steps
+    initializer_ = std::make_unique<SubsystemInitializer>();
+    initializer_->add("navdata", {}, true, [this]() {
+        // Navdata provider for airport/navaid lookups (unless shared by a host)
+        if (!navdataProvider_) {
+            navdataProvider_ = createNavdataProvider();
+        }
+        return navdataProvider_ != nullptr;
+    });
+    initializer_->add("weather", {}, true, [this]() {
+        weatherSystem_ = std::make_unique<WeatherSystem>();
+        return true;
+    });
+    for (auto& startup : startupTasks_) {
+        if (!initializer_->add(startup.name, startup.after, false, startup.task)) {
+            log("WARNING: Startup task " + startup.name + " has an unknown dependency - not run");
+        }
+    }
+    initializer_->start();
+    bool ready = initializer_->waitReady();
+    
+    for (const auto& step : initializer_->getStats()) {
+        if (!step.critical) continue;
+        std::ostringstream message;
+        message << (step.state == SubsystemInitState::SUCCEEDED ? "" : "ERROR: ")
+                << step.name << (step.state == SubsystemInitState::SUCCEEDED ? " initialized in " : " failed after ")
+                << step.durationMs << " ms";
+        log(message.str());
+    }
+    std::ostringstream message;
+    message << "Ready for preflight in " << initializer_->getTimeToReadyMs() << " ms";
+    log(message.str());
+    return ready;
+}
+
+bool AIPilot::addStartupTask(const std::string& name, SubsystemInitializer::InitFunction task,
+                             const std::vector<std::string>& after) {
+    if (!task || name == "navdata" || name == "weather") {
+        return false;
+    }
+    for (const auto& startup : startupTasks_) {
+        if (startup.name == name) {
+            return false;
+        }
+    }
+    for (const auto& dependency : after) {
+        bool known = dependency == "navdata" || dependency == "weather";
+        for (const auto& startup : startupTasks_) {
+            known = known || startup.name == dependency;
+        }
+        if (!known) {
+            return false;
+        }
+    }
+    startupTasks_.push_back({name, std::move(task), after});
+    return true;
+}
+
+std::vector<SubsystemInitStats> AIPilot::getInitStats() const {
+    return initializer_ ? initializer_->getStats() : std::vector<SubsystemInitStats>();
+}
+
+double AIPilot::getTimeToReadyMs() const {
+    return initializer_ ? initializer_->getTimeToReadyMs() : 0.0;
+}
+
+void AIPilot::waitForStartupTasks() {
+    if (initializer_) {
+        initializer_->waitAll();
+    }
+}
+
+std::shared_ptr<const INavdataProvider> AIPilot::createNavdataProvider() {
+    auto provider = std::make_shared<SimConnectNavdataProvider>();
+    if (provider->initialize()) {
+        return provider;
+    }
+    
+    AICOPILOT_LOG_WARNING("[AI Pilot] WARNING: Failed to initialize navdata provider - airport search will be limited");
+    // Not a critical failure, continue with cached provider as fallback
+    auto cached = std::make_shared<CachedNavdataProvider>();
+    cached->initialize();
+    return cached;
+}
+
 bool AIPilot::loadAircraftConfig(const std::string& configPath) {
     log("Loading aircraft configuration: " + configPath);
     
@@ -69,10 +254,25 @@ bool AIPilot::loadAircraftConfig(const std::string& configPath) {
     }
     
     aircraftConfig_ = parser.getConfig();
+    phaseSchedule_ = makePhaseSchedule(categoryForType(aircraftConfig_.aircraftType),
+                                       aircraftConfig_.stallSpeed, aircraftConfig_.cruiseSpeed);
     
     // Initialize systems with loaded configuration
     systems_ = std::make_unique<AircraftSystems>(simConnect_, aircraftConfig_);
     
+    helicopter_.reset();
+    if (aircraftConfig_.aircraftType == AircraftType::HELICOPTER) {
+        HelicopterData data{};
+        data.maxVerticalSpeed = aircraftConfig_.climbRate > 0.0 ? aircraftConfig_.climbRate : 1000.0;
+        data.cruiseSpeed = aircraftConfig_.cruiseSpeed;
+        data.vne = aircraftConfig_.maxSpeed;
+        data.hoverCeiling = aircraftConfig_.serviceceiling;
+        data.hoverCeilingOGE = aircraftConfig_.serviceceiling;
+        data.autorotationSpeed = 0.6 * aircraftConfig_.cruiseSpeed;
+        helicopter_ = std::make_unique<HelicopterOperations>();
+        helicopter_->initialize(data);
+    }
+    
     log("Aircraft configuration loaded: " + aircraftConfig_.title);
     return true;
 }
@@ -86,13 +286,55 @@ bool AIPilot::loadFlightPlan(const std::string& planPath) {
         return false;
     }
     
+    if (navdataProvider_ && navdataProvider_->isReady()) {
+        size_t resolved = navigation_->resolveWaypoints(*navdataProvider_);
+        if (resolved > 0) {
+            log("Placed " + std::to_string(resolved) + " flight plan waypoints from navdata");
+        }
+    }
+    
     log("Flight plan loaded");
     if (airportOpsInitialized_) {
         setupDefaultAirportLayout();
     }
+    subscribeRouteWeather();
     return true;
 }
 
+void AIPilot::setWeatherSubscriptions(std::shared_ptr<WeatherSubscriptions> subscriptions) {
+    if (weatherSubscriptions_) {
+        weatherSubscriptions_->unsubscribe(routeWeatherSubscription_);
+        routeWeatherSubscription_ = WeatherSubscriptions::INVALID_SUBSCRIPTION;
+    }
+    weatherSubscriptions_ = std::move(subscriptions);
+    subscribeRouteWeather();
+}
+
+void AIPilot::subscribeRouteWeather() {
+    if (!weatherSubscriptions_) {
+        return;
+    }
+    weatherSubscriptions_->unsubscribe(routeWeatherSubscription_);
+    routeWeatherSubscription_ = WeatherSubscriptions::INVALID_SUBSCRIPTION;
+    if (!navigation_) {
+        return;
+    }
+    
+    std::vector<Position> route;
+    for (const Waypoint& waypoint : navigation_->getFlightPlan().waypoints) {
+        route.push_back(waypoint.position);
+    }
+    std::shared_ptr<RouteWeatherInbox> inbox = routeWeather_;
+    routeWeatherSubscription_ = weatherSubscriptions_->subscribeCorridor(
+        route, ROUTE_WEATHER_CORRIDOR_NM, [inbox](const std::vector<WeatherChange>& changes) {
+            std::lock_guard<std::mutex> lock(inbox->mutex);
+            inbox->changes.insert(inbox->changes.end(), changes.begin(), changes.end());
+        });
+    if (routeWeatherSubscription_ == WeatherSubscriptions::INVALID_SUBSCRIPTION) {
+        log("WARNING: Route weather not watched - no station positions or flight plan");
+    }
+}
+
 void AIPilot::startAutonomousFlight() {
     if (!simConnect_ || !simConnect_->isConnected()) {
         log("ERROR: Not connected to simulator");
@@ -107,14 +349,23 @@ void AIPilot::startAutonomousFlight() {
     log("Starting autonomous flight");
     active_ = true;
     currentPhase_ = FlightPhase::PREFLIGHT;
+    phaseMachine_.reset(currentPhase_, std::chrono::steady_clock::now());
+    preflightComplete_ = false;
+    shutdownComplete_ = false;
+    lastControlUpdate_ = std::chrono::steady_clock::now();
+    replayNow_ = TaskScheduler::Clock::now();
     
     // Initialize ATC controller
     atc_ = std::make_unique<ATCController>(simConnect_);
+    if (ollamaGateway_) {
+        atc_->setOllamaGateway(ollamaGateway_, ollamaGatewayPilotId_);
+    }
     if (navigation_) {
         atc_->setFlightPlan(navigation_->getFlightPlan());
     }
 
     initializeAirportOperations();
+    configureScheduler();
 }
 
 void AIPilot::stopAutonomousFlight() {
@@ -122,43 +373,364 @@ void AIPilot::stopAutonomousFlight() {
         log("Stopping autonomous flight");
         active_ = false;
     }
+    if (scheduler_) {
+        scheduler_->setWatchdog(nullptr);
+    }
+    if (watchdog_) {
+        // Host subsystems must not stay degraded after the flight
+        watchdog_->restoreAll();
+    }
+    if (scheduler_) {
+        scheduler_->clear();
+    }
+}
+
+void AIPilot::captureCheckpoint(PilotCheckpointBuilder& builder) const {
+    // The terrain lookup worker writes terrainElevation_; let it finish
+    if (scheduler_) {
+        scheduler_->waitForWorkers();
+    }
+    
+    PilotCheckpointState& state = builder.state();
+    state.phase = static_cast<int32_t>(currentPhase_);
+    state.flags = (preflightComplete_ ? CHECKPOINT_PREFLIGHT_COMPLETE : 0u) |
+                  (shutdownComplete_ ? CHECKPOINT_SHUTDOWN_COMPLETE : 0u) |
+                  (fuelWarning20Shown_ ? CHECKPOINT_FUEL_WARNING_20 : 0u) |
+                  (fuelWarning10Shown_ ? CHECKPOINT_FUEL_WARNING_10 : 0u) |
+                  (manualOverride_ ? CHECKPOINT_MANUAL_OVERRIDE : 0u) |
+                  (weatherAssessed_ ? CHECKPOINT_WEATHER_ASSESSED : 0u) |
+                  (terrainElevationValid_ ? CHECKPOINT_TERRAIN_VALID : 0u) |
+                  (currentState_.onGround ? CHECKPOINT_ON_GROUND : 0u) |
+                  (currentState_.gearDown ? CHECKPOINT_GEAR_DOWN : 0u) |
+                  (currentState_.parkingBrakeSet ? CHECKPOINT_PARKING_BRAKE : 0u) |
+                  (lastWeather_.icing ? CHECKPOINT_ICING : 0u) |
+                  (lastWeather_.turbulence ? CHECKPOINT_TURBULENCE : 0u) |
+                  (lastWeather_.precipitation ? CHECKPOINT_PRECIPITATION : 0u);
+    state.flapsPosition = currentState_.flapsPosition;
+    state.latitude = currentState_.position.latitude;
+    state.longitude = currentState_.position.longitude;
+    state.altitude = currentState_.position.altitude;
+    state.heading = currentState_.heading;
+    state.indicatedAirspeed = currentState_.indicatedAirspeed;
+    state.trueAirspeed = currentState_.trueAirspeed;
+    state.groundSpeed = currentState_.groundSpeed;
+    state.verticalSpeed = currentState_.verticalSpeed;
+    state.pitch = currentState_.pitch;
+    state.bank = currentState_.bank;
+    state.fuelQuantity = currentState_.fuelQuantity;
+    state.terrainElevation = terrainElevation_;
+    state.windSpeed = lastWeather_.windSpeed;
+    state.windDirection = lastWeather_.windDirection;
+    state.visibility = lastWeather_.visibility;
+    state.cloudBase = lastWeather_.cloudBase;
+    state.ceiling = lastWeather_.ceiling;
+    state.temperature = lastWeather_.temperature;
+    state.dewpoint = lastWeather_.dewpoint;
+    
+    if (navigation_) {
+        FlightPlan plan = navigation_->getFlightPlan();
+        builder.setFlightPlan(plan, navigation_->getActiveWaypointIndex());
+        for (const std::string& icao : {plan.departure, plan.arrival}) {
+            if (!icao.empty()) builder.addWarmEntry(WarmSetCache::AIRPORT, icao);
+        }
+    }
+    if (atc_) {
+        builder.setClearances(atc_->getClearanceLog(), atc_->getLastClearance(), atc_->getPendingInstructions());
+    }
+}
+
+bool AIPilot::resumeFromCheckpoint(const PilotCheckpoint& checkpoint) {
+    if (!checkpoint.isOpen()) {
+        log("ERROR: Checkpoint not open");
+        return false;
+    }
+    
+    if (checkpoint.getWaypointCount() > 0) {
+        if (!navigation_) {
+            navigation_ = std::make_unique<Navigation>();
+        }
+        navigation_->restoreFlightPlan(checkpoint.getFlightPlan(), checkpoint.getState().activeWaypoint);
+        subscribeRouteWeather();
+    }
+    
+    // Builds ATC, airport operations and the scheduler as for a cold start
+    startAutonomousFlight();
+    if (!active_) {
+        return false;
+    }
+    
+    const PilotCheckpointState& state = checkpoint.getState();
+    currentPhase_ = checkpoint.getPhase();
+    phaseMachine_.reset(currentPhase_, std::chrono::steady_clock::now());
+    preflightComplete_ = checkpoint.hasFlag(CHECKPOINT_PREFLIGHT_COMPLETE);
+    shutdownComplete_ = checkpoint.hasFlag(CHECKPOINT_SHUTDOWN_COMPLETE);
+    fuelWarning20Shown_ = checkpoint.hasFlag(CHECKPOINT_FUEL_WARNING_20);
+    fuelWarning10Shown_ = checkpoint.hasFlag(CHECKPOINT_FUEL_WARNING_10);
+    manualOverride_ = checkpoint.hasFlag(CHECKPOINT_MANUAL_OVERRIDE);
+    
+    currentState_.position = {state.latitude, state.longitude, state.altitude, state.heading};
+    currentState_.heading = state.heading;
+    currentState_.indicatedAirspeed = state.indicatedAirspeed;
+    currentState_.trueAirspeed = state.trueAirspeed;
+    currentState_.groundSpeed = state.groundSpeed;
+    currentState_.verticalSpeed = state.verticalSpeed;
+    currentState_.pitch = state.pitch;
+    currentState_.bank = state.bank;
+    currentState_.fuelQuantity = state.fuelQuantity;
+    currentState_.flapsPosition = state.flapsPosition;
+    currentState_.onGround = checkpoint.hasFlag(CHECKPOINT_ON_GROUND);
+    currentState_.gearDown = checkpoint.hasFlag(CHECKPOINT_GEAR_DOWN);
+    currentState_.parkingBrakeSet = checkpoint.hasFlag(CHECKPOINT_PARKING_BRAKE);
+    
+    // Weather and terrain as last seen, so the first slow ticks compare
+    // against the checkpoint rather than reacting as if starting cold
+    weatherAssessed_ = checkpoint.hasFlag(CHECKPOINT_WEATHER_ASSESSED);
+    lastWeather_.windSpeed = state.windSpeed;
+    lastWeather_.windDirection = state.windDirection;
+    lastWeather_.visibility = state.visibility;
+    lastWeather_.cloudBase = state.cloudBase;
+    lastWeather_.ceiling = state.ceiling;
+    lastWeather_.temperature = state.temperature;
+    lastWeather_.dewpoint = state.dewpoint;
+    lastWeather_.icing = checkpoint.hasFlag(CHECKPOINT_ICING);
+    lastWeather_.turbulence = checkpoint.hasFlag(CHECKPOINT_TURBULENCE);
+    lastWeather_.precipitation = checkpoint.hasFlag(CHECKPOINT_PRECIPITATION);
+    terrainElevation_ = state.terrainElevation;
+    terrainElevationValid_ = checkpoint.hasFlag(CHECKPOINT_TERRAIN_VALID);
+    
+    atc_->setFlightPhase(currentPhase_);
+    if (checkpoint.hasClearances() &&
+        !atc_->restoreClearances(checkpoint.getClearanceBase(), checkpoint.getClearanceEvents(),
+                                 checkpoint.getClearanceEventCount(), checkpoint.getLastClearance(),
+                                 checkpoint.getPendingInstructions())) {
+        log("WARNING: Checkpoint clearance log is inconsistent - ATC starts without clearances");
+    }
+    
+    std::vector<std::string> airports = checkpoint.getWarmKeys(WarmSetCache::AIRPORT);
+    if (airportManager_ && !airports.empty()) {
+        airportManager_->prefetch(airports);
+    }
+    
+    log("Resumed from checkpoint in phase " + std::to_string(state.phase));
+    return true;
+}
+
+void AIPilot::configureScheduler() {
+    if (!scheduler_) {
+        scheduler_ = std::make_unique<TaskScheduler>(threading_.schedulerWorkers);
+    }
+    scheduler_->setWatchdog(nullptr);
+    if (watchdog_) {
+        watchdog_->restoreAll();
+    }
+    scheduler_->clear();
+    terrainElevationValid_ = false;
+    
+    if (helicopter_) {
+        // Ahead of the control cycle so a shared tick sends fresh rotor controls
+        rotorcraftPeriod_.clear();
+        rotorcraftCompute_.clear();
+        rotorcraftIterations_ = 0;
+        lastRotorcraftRun_ = {};
+        helicopter_->resetHoverQuality();
+        scheduler_->addTask("rotorcraft", ROTORCRAFT_RATE_HZ, [this] { runRotorcraftCycle(); });
+    }
+    scheduler_->addTask("control", CONTROL_RATE_HZ, [this] { runControlCycle(); });
+    
+    TaskScheduler::TaskId taws = scheduler_->addTask("taws", TAWS_RATE_HZ, [this] {
+        if (!currentState_.onGround && !checkTerrainClearance()) {
+            log("WARNING: Terrain clearance issue");
+        }
+    });
+    
+    weatherAssessed_ = false;
+    TaskScheduler::TaskId weather = scheduler_->addTask("weather", SLOW_RATE_HZ, [this] { runWeatherCheck(); });
+    
+    // Shed load in priority order rather than let the control loop slip
+    watchdog_ = std::make_unique<TickWatchdog>(
+        std::chrono::duration_cast<TickWatchdog::Clock::duration>(
+            std::chrono::duration<double, std::milli>(TICK_BUDGET_MS)));
+    watchdog_->setSystemMonitor(systemMonitor_);
+    TaskScheduler* scheduler = scheduler_.get();
+    watchdog_->addStep("taws_resolution", [scheduler, taws](bool degraded) {
+        scheduler->setTaskRate(taws, degraded ? DEGRADED_TAWS_RATE_HZ : TAWS_RATE_HZ);
+    });
+    for (const HostDegradationStep& host : hostDegradationSteps_) {
+        watchdog_->addStep(host.name, host.step);
+    }
+    watchdog_->addStep("weather_checks", [scheduler, weather](bool degraded) {
+        scheduler->setTaskRate(weather, degraded ? DEGRADED_WEATHER_RATE_HZ : SLOW_RATE_HZ);
+    });
+    scheduler_->setWatchdog(watchdog_.get());
+    
+    // Slow lookups run off the control thread
+    scheduler_->addTask("terrain_lookup", SLOW_RATE_HZ, [this] { runTerrainLookup(); },
+                        TaskExecution::WORKER);
+    
+    // ATC stays inline: its flight plan, clearances and Ollama settings are
+    // written from this thread, and update() only polls Ollama selections
+    if (atc_) {
+        ATCController* atc = atc_.get();
+        scheduler_->addTask("atc", SLOW_RATE_HZ, [atc] { atc->update(); });
+    }
 }
 
 void AIPilot::update() {
-    if (!active_ || manualOverride_) {
+    if (!active_ || manualOverride_ || !scheduler_) {
         return;
     }
     
+    HotPathTracer::beginTick();
+    TRACE_SCOPE("AIPilot::update");
+    if (fastReplay_) {
+        replayNow_ += std::chrono::duration_cast<TaskScheduler::Clock::duration>(
+            std::chrono::duration<double>(1.0 / getUpdateRateHz()));
+        scheduler_->tick(replayNow_);
+    } else {
+        scheduler_->tick();
+    }
+}
+
+std::vector<ScheduledTaskStats> AIPilot::getSchedulerStats() const {
+    if (!scheduler_) return {};
+    return scheduler_->getStats();
+}
+
+void AIPilot::addDegradationStep(const std::string& name, TickWatchdog::DegradationStep step) {
+    hostDegradationSteps_.push_back({name, std::move(step)});
+}
+
+TickWatchdogStats AIPilot::getWatchdogStats() const {
+    if (!watchdog_) return {};
+    return watchdog_->getStats();
+}
+
+RotorcraftLoopStats AIPilot::getRotorcraftLoopStats() const {
+    RotorcraftLoopStats stats;
+    if (!helicopter_) return stats;
+    stats.iterations = rotorcraftIterations_;
+    stats.periodMeanMs = rotorcraftPeriod_.meanMs();
+    stats.periodP99Ms = rotorcraftPeriod_.percentileMs(0.99);
+    stats.periodMaxMs = rotorcraftPeriod_.maxMs();
+    stats.computeMeanMs = rotorcraftCompute_.meanMs();
+    stats.computeP99Ms = rotorcraftCompute_.percentileMs(0.99);
+    stats.computeMaxMs = rotorcraftCompute_.maxMs();
+    stats.hover = helicopter_->getHoverQuality();
+    return stats;
+}
+
+void AIPilot::runRotorcraftCycle() {
+    if (!helicopter_->needsFastControl()) {
+        lastRotorcraftRun_ = {};
+        return;
+    }
+    
+    auto start = TaskScheduler::Clock::now();
+    double dt = 1.0 / ROTORCRAFT_RATE_HZ;
+    if (!fastReplay_ && lastRotorcraftRun_ != TaskScheduler::Clock::time_point{}) {
+        dt = std::chrono::duration<double>(start - lastRotorcraftRun_).count();
+        rotorcraftPeriod_.record(dt * 1000.0);
+    }
+    lastRotorcraftRun_ = start;
+    
+    // The snapshot, not currentState_, which only the control cycle refreshes
+    RotorcraftControl control = helicopter_->runFastControl(simConnect_->getAircraftState(), dt);
+    simConnect_->setThrottle(control.collective);
+    simConnect_->setElevator(control.cyclicLongitudinal);
+    simConnect_->setAileron(control.cyclicLateral);
+    simConnect_->setRudder(control.pedal);
+    simConnect_->flushCommands();
+    
+    rotorcraftIterations_++;
+    rotorcraftCompute_.record(
+        std::chrono::duration<double, std::milli>(TaskScheduler::Clock::now() - start).count());
+}
+
+void AIPilot::runTerrainLookup() {
+    // Runs on a scheduler worker: read the thread-safe snapshot, not currentState_.
+    // Only the position matters, so the core; skip the lookup while it is unchanged.
+    uint64_t version = 0;
+    AircraftStateCore core = simConnect_->getAircraftStateCore(version);
+    if (version == 0) {
+        core = AircraftStateCore::fromAircraftState(simConnect_->getAircraftState());
+    } else if (version == terrainStateVersion_ && terrainElevationValid_) {
+        return;
+    }
+    terrainStateVersion_ = version;
+    terrainElevation_ = getTerrainElevation(core.position());
+    terrainElevationValid_ = true;
+}
+
+void AIPilot::runControlCycle() {
     // Process SimConnect messages
-    simConnect_->processMessages();
+    {
+        TRACE_SCOPE("simconnect.dispatch");
+        simConnect_->processMessages();
+    }
+    
+    // While the sim is away, hold everything as it was and send nothing;
+    // the first cycle after it returns starts from a fresh time step
+    if (simConnect_->isReconnecting()) {
+        lastControlUpdate_ = std::chrono::steady_clock::now();
+        return;
+    }
     
     // Update current state
     currentState_ = systems_->getCurrentState();
     
     // Update subsystems
-    systems_->update();
-    static auto lastUpdateTime = std::chrono::steady_clock::now();
+    {
+        TRACE_SCOPE("systems.update");
+        systems_->update();
+    }
     auto now = std::chrono::steady_clock::now();
-    double deltaTime = std::chrono::duration<double>(now - lastUpdateTime).count();
-    lastUpdateTime = now;
+    double deltaTime = std::chrono::duration<double>(now - lastControlUpdate_).count();
+    lastControlUpdate_ = now;
     if (airportOps_) {
+        TRACE_SCOPE("airport_ops.update");
         airportOps_->update(deltaTime);
     }
-    if (atc_) {
-        atc_->update();
-    }
     
     // Perform safety checks
     if (!performSafetyChecks()) {
         log("WARNING: Safety check failed");
+        simConnect_->flushCommands();
+        recordFlightData();
         return;
     }
     
     // Update flight phase
     updateFlightPhase();
+    recordFlightData();
     
-    // Execute phase-specific logic
-    executePhase();
+    // Execute phase-specific logic; the rotorcraft task owns the controls
+    // while it flies a hover or autorotation
+    if (!helicopter_ || !helicopter_->needsFastControl()) {
+        TRACE_SCOPE("phase.execute");
+        executePhase();
+    }
+    
+    // Send this cycle's control outputs in a single transfer
+    TRACE_SCOPE("simconnect.flush");
+    simConnect_->flushCommands();
+}
+
+int64_t AIPilot::flightDataClockUs() const {
+    if (fastReplay_) {
+        return static_cast<int64_t>(std::llround(simConnect_->getReplayTime() * 1e6));
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void AIPilot::recordFlightData() {
+    if (!flightData_) return;
+    FlightDataSample sample;
+    sample.timestampUs = flightDataClockUs() - flightDataStartUs_;
+    sample.state = currentState_;
+    sample.autopilot = simConnect_->getAutopilotState();
+    sample.phase = currentPhase_;
+    flightData_->record(sample);
 }
 
 std::string AIPilot::getStatusReport() const {
@@ -186,6 +758,9 @@ std::string AIPilot::getStatusReport() const {
     oss << "Altitude: " << currentState_.position.altitude << " ft\n";
     oss << "Airspeed: " << currentState_.indicatedAirspeed << " kts\n";
     oss << "Heading: " << currentState_.heading << " deg\n";
+    if (scheduler_) {
+        oss << "Deadline misses: " << scheduler_->getTotalDeadlineMisses() << "\n";
+    }
     
     return oss.str();
 }
@@ -355,42 +930,36 @@ bool AIPilot::isOllamaEnabled() const {
     return false;
 }
 
+const AIPilot::PhaseAction AIPilot::PHASE_ACTIONS[FLIGHT_PHASE_COUNT] = {
+    &AIPilot::executePreflight,   // PREFLIGHT
+    &AIPilot::executeTaxiOut,     // TAXI_OUT
+    &AIPilot::executeTakeoff,     // TAKEOFF
+    &AIPilot::executeClimb,       // CLIMB
+    &AIPilot::executeCruise,      // CRUISE
+    &AIPilot::executeDescent,     // DESCENT
+    &AIPilot::executeApproach,    // APPROACH
+    &AIPilot::executeLanding,     // LANDING
+    &AIPilot::executeTaxiIn,      // TAXI_IN
+    &AIPilot::executeShutdown,    // SHUTDOWN
+    nullptr                       // UNKNOWN
+};
+
 void AIPilot::updateFlightPhase() {
-    // Determine flight phase based on current state
+    auto now = std::chrono::steady_clock::now();
     
-    if (currentState_.onGround) {
-        if (currentState_.groundSpeed < 5.0) {
-            if (currentPhase_ == FlightPhase::LANDING || currentPhase_ == FlightPhase::TAXI_IN) {
-                currentPhase_ = FlightPhase::TAXI_IN;
-            } else if (currentPhase_ == FlightPhase::SHUTDOWN) {
-                // Stay in shutdown
-            } else {
-                currentPhase_ = FlightPhase::PREFLIGHT;
-            }
-        } else if (currentState_.groundSpeed < 40.0) {
-            currentPhase_ = FlightPhase::TAXI_OUT;
-        } else {
-            currentPhase_ = FlightPhase::TAKEOFF;
-        }
-    } else {
-        // In the air
-        double targetAltitude = navigation_ ? navigation_->getFlightPlan().cruiseAltitude : 10000.0;
-        
-        if (currentState_.position.altitude < 1000.0) {
-            currentPhase_ = FlightPhase::TAKEOFF;
-        } else if (currentState_.verticalSpeed > 300.0 && 
-                   currentState_.position.altitude < targetAltitude - 1000.0) {
-            currentPhase_ = FlightPhase::CLIMB;
-        } else if (std::abs(currentState_.verticalSpeed) < 300.0) {
-            currentPhase_ = FlightPhase::CRUISE;
-        } else if (currentState_.verticalSpeed < -300.0) {
-            if (currentState_.position.altitude < 5000.0) {
-                currentPhase_ = FlightPhase::APPROACH;
-            } else {
-                currentPhase_ = FlightPhase::DESCENT;
-            }
-        }
-    }
+    // Pick up phase changes made by the phase logic or emergency handling
+    phaseMachine_.forcePhase(currentPhase_, now);
+    
+    PhaseInputs inputs;
+    inputs.onGround = currentState_.onGround;
+    inputs.groundSpeed = currentState_.groundSpeed;
+    inputs.altitude = currentState_.position.altitude;
+    inputs.verticalSpeed = currentState_.verticalSpeed;
+    inputs.targetAltitude = navigation_ ? navigation_->getFlightPlan().cruiseAltitude : 10000.0;
+    
+    // Only the current phase's guards are evaluated
+    phaseMachine_.update(inputs, now);
+    currentPhase_ = phaseMachine_.getPhase();
     
     // Update ATC controller with current phase
     if (atc_) {
@@ -399,47 +968,15 @@ void AIPilot::updateFlightPhase() {
 }
 
 void AIPilot::executePhase() {
-    switch (currentPhase_) {
-        case FlightPhase::PREFLIGHT:
-            executePreflight();
-            break;
-        case FlightPhase::TAXI_OUT:
-            executeTaxiOut();
-            break;
-        case FlightPhase::TAKEOFF:
-            executeTakeoff();
-            break;
-        case FlightPhase::CLIMB:
-            executeClimb();
-            break;
-        case FlightPhase::CRUISE:
-            executeCruise();
-            break;
-        case FlightPhase::DESCENT:
-            executeDescent();
-            break;
-        case FlightPhase::APPROACH:
-            executeApproach();
-            break;
-        case FlightPhase::LANDING:
-            executeLanding();
-            break;
-        case FlightPhase::TAXI_IN:
-            executeTaxiIn();
-            break;
-        case FlightPhase::SHUTDOWN:
-            executeShutdown();
-            break;
-        default:
-            break;
+    PhaseAction action = PHASE_ACTIONS[static_cast<size_t>(currentPhase_)];
+    if (action != nullptr) {
+        (this->*action)();
     }
 }
 
 void AIPilot::executePreflight() {
     // Preflight checks
-    static bool checksComplete = false;
-    
-    if (!checksComplete) {
+    if (!preflightComplete_) {
         log("Performing preflight checks");
         
         // Set parking brake
@@ -449,7 +986,7 @@ void AIPilot::executePreflight() {
         systems_->setNavigationLights(true);
         systems_->setBeaconLights(true);
         
-        checksComplete = true;
+        preflightComplete_ = true;
     }
 }
 
@@ -499,16 +1036,18 @@ void AIPilot::executeTakeoff() {
     systems_->setLandingLights(true);
     systems_->setStrobeLights(true);
     
+    const PhaseTargets& takeoff = phaseSchedule_[FlightPhase::TAKEOFF];
     if (currentState_.onGround) {
-        // Apply takeoff power
-        systems_->setThrottle(1.0);
+        // Apply takeoff power and flaps
+        systems_->setThrottle(takeoff.throttle);
+        systems_->setFlaps(takeoff.flaps);
         
         // Release parking brake
         systems_->setParkingBrake(false);
         
         // Rotate at appropriate speed
-        if (currentState_.indicatedAirspeed > aircraftConfig_.stallSpeed * 1.3) {
-            systems_->setPitch(0.15); // Gentle pitch up
+        if (currentState_.indicatedAirspeed > takeoff.speed) {
+            systems_->setPitch(phaseSchedule_.rotationPitch);
         }
     } else {
         // After liftoff, retract gear
@@ -530,8 +1069,7 @@ void AIPilot::executeClimb() {
     systems_->setAltitude(targetAltitude);
     
     // Set climb speed
-    double climbSpeed = aircraftConfig_.cruiseSpeed * 0.75;
-    systems_->setSpeed(climbSpeed);
+    systems_->setSpeed(phaseSchedule_[FlightPhase::CLIMB].speed);
     
     controlHeading();
 }
@@ -545,7 +1083,7 @@ void AIPilot::executeCruise() {
     // Set cruise parameters
     double cruiseAltitude = navigation_ ? navigation_->getFlightPlan().cruiseAltitude : 10000.0;
     systems_->setAltitude(cruiseAltitude);
-    systems_->setSpeed(aircraftConfig_.cruiseSpeed);
+    systems_->setSpeed(phaseSchedule_[FlightPhase::CRUISE].speed);
     
     // Follow navigation
     controlHeading();
@@ -564,6 +1102,7 @@ void AIPilot::executeDescent() {
     
     // Set descent parameters
     systems_->setAltitude(3000.0); // Initial descent altitude
+    systems_->setSpeed(phaseSchedule_[FlightPhase::DESCENT].speed);
     
     controlHeading();
 }
@@ -575,8 +1114,8 @@ void AIPilot::executeApproach() {
     systems_->enableApproachMode(true);
     
     // Configure for landing
-    if (currentState_.position.altitude < 3000.0) {
-        systems_->setFlaps(50);
+    if (currentState_.position.altitude < phaseSchedule_.approachConfigAltitude) {
+        systems_->setFlaps(phaseSchedule_[FlightPhase::APPROACH].flaps);
         systems_->setGear(true);
         systems_->setLandingLights(true);
     }
@@ -586,21 +1125,20 @@ void AIPilot::executeLanding() {
     log("Landing");
     
     // Final approach configuration
-    systems_->setFlaps(100);
+    const PhaseTargets& landing = phaseSchedule_[FlightPhase::LANDING];
+    systems_->setFlaps(landing.flaps);
     systems_->setGear(true);
     
-    // Landing speed (1.3 * stall speed)
-    double landingSpeed = aircraftConfig_.stallSpeed * 1.3;
-    
     // Flare logic
-    if (currentState_.position.altitude < 50.0 && currentState_.position.altitude > 5.0) {
+    double flareHeight = phaseSchedule_.flareHeight;
+    if (currentState_.position.altitude < flareHeight && currentState_.position.altitude > 5.0) {
         log("Flaring for landing");
         // Gradual pitch increase for flare
-        double flareAmount = (50.0 - currentState_.position.altitude) / 50.0;
+        double flareAmount = (flareHeight - currentState_.position.altitude) / flareHeight;
         systems_->setPitch(0.05 + flareAmount * 0.1);
         
         // Reduce power gradually
-        systems_->setThrottle(0.3 * (1.0 - flareAmount));
+        systems_->setThrottle(landing.throttle * (1.0 - flareAmount));
     }
     else if (currentState_.position.altitude <= 5.0) {
         log("Touchdown");
@@ -648,9 +1186,7 @@ void AIPilot::executeTaxiIn() {
 void AIPilot::executeShutdown() {
     log("Shutting down");
     
-    static bool shutdownComplete = false;
-    
-    if (!shutdownComplete) {
+    if (!shutdownComplete_) {
         // Shutdown checklist
         
         // 1. Set parking brake
@@ -688,7 +1224,7 @@ void AIPilot::executeShutdown() {
         log("Lights - OFF");
         
         // 8. Complete
-        shutdownComplete = true;
+        shutdownComplete_ = true;
         log("Shutdown checklist complete");
         
         // Stop autonomous flight
@@ -696,15 +1232,6 @@ void AIPilot::executeShutdown() {
     }
 }
 
-bool AIPilot::shouldStartTakeoff() {
-    // Check if we have clearance and conditions are good
-    return currentState_.onGround && currentState_.parkingBrakeSet == false;
-}
-
-bool AIPilot::shouldStartClimb() {
-    return !currentState_.onGround && currentState_.position.altitude > 100.0;
-}
-
 bool AIPilot::shouldStartDescent() {
     if (!navigation_) return false;
     
@@ -716,10 +1243,6 @@ bool AIPilot::shouldStartDescent() {
     return distance < 30.0;
 }
 
-bool AIPilot::shouldStartApproach() {
-    return currentState_.position.altitude < 5000.0;
-}
-
 void AIPilot::controlHeading() {
     if (!navigation_) return;
     
@@ -744,11 +1267,11 @@ void AIPilot::controlSpeed() {
 }
 
 bool AIPilot::performSafetyChecks() {
-    bool safe = systems_->checkSystems();
-    
-    if (!safe) {
-        auto warnings = systems_->getSystemWarnings();
-        for (const auto& warning : warnings) {
+    TRACE_SCOPE("safety.checks");
+    // Warnings are kept current by systems_->update(); log them when they change
+    bool safe = !systems_->hasWarnings();
+    if (systems_->warningsChanged()) {
+        for (const auto& warning : systems_->getSystemWarnings()) {
             log(warning);
         }
     }
@@ -770,18 +1293,7 @@ bool AIPilot::performSafetyChecks() {
         fuelWarning10Shown_ = true;
     }
     
-    // Check terrain clearance
-    if (!currentState_.onGround) {
-        if (!checkTerrainClearance()) {
-            log("WARNING: Terrain clearance issue");
-        }
-    }
-    
-    // Check weather suitability
-    if (!isWeatherSuitable()) {
-        handleBadWeather();
-    }
-    
+    // Terrain and weather are checked by their own scheduler tasks
     return safe;
 }
 
@@ -876,12 +1388,9 @@ void AIPilot::handleLowFuel() {
     }
 }
 
-void AIPilot::handleBadWeather() {
+void AIPilot::handleBadWeather(const WeatherConditions& weather) {
     log("WARNING: Bad weather detected");
     
-    // Get current weather conditions
-    WeatherConditions weather = assessWeather();
-    
     // Decision tree for weather
     log("Assessing weather severity and options");
     
@@ -905,7 +1414,7 @@ void AIPilot::handleBadWeather() {
     }
     
     // Consider diversion if weather is too severe
-    if (!isWeatherSuitable()) {
+    if (!isWeatherSuitable(weather)) {
         log("Weather below minimums - considering diversion");
         if (atc_) {
             log("Requesting weather information from ATC");
@@ -914,8 +1423,11 @@ void AIPilot::handleBadWeather() {
 }
 
 bool AIPilot::checkTerrainClearance() {
-    // Check if current altitude provides adequate terrain clearance
-    double terrainElevation = getTerrainElevation(currentState_.position);
+    // Compare against the cached background lookup; no verdict until the first one lands
+    if (!terrainElevationValid_) {
+        return true;
+    }
+    double terrainElevation = terrainElevation_;
     double agl = currentState_.position.altitude - terrainElevation;
     
     // Minimum safe altitude is typically 1000 ft AGL in mountainous areas,
@@ -1038,16 +1550,6 @@ WeatherConditions AIPilot::assessWeather() {
             log("Turbulence detected - vertical speed: " + std::to_string(currentState_.verticalSpeed) + " fpm");
         }
         
-        // Update weather system if available
-        if (weatherSystem_) {
-            weatherSystem_->updateWeatherConditions(weather);
-        }
-        
-        log("Weather assessment: " + 
-            std::string(weather.icing ? "ICING " : "") +
-            std::string(weather.turbulence ? "TURBULENCE " : "") +
-            std::string(weather.precipitation ? "PRECIP " : "") +
-            "Pressure: " + std::to_string(currentPressure) + " inHg");
     } else {
         // SimConnect not available, use defaults
         log("WARNING: SimConnect not available for weather data");
@@ -1078,9 +1580,57 @@ WeatherConditions AIPilot::assessWeather() {
     return weather;
 }
 
-bool AIPilot::isWeatherSuitable() {
+void AIPilot::runWeatherCheck() {
     WeatherConditions weather = assessWeather();
+    std::vector<WeatherChange> routeChanges;
+    {
+        std::lock_guard<std::mutex> lock(routeWeather_->mutex);
+        routeChanges.swap(routeWeather_->changes);
+    }
     
+    // Act on change rather than every tick
+    if (weatherAssessed_ && routeChanges.empty() && !weatherChanged(lastWeather_, weather)) {
+        return;
+    }
+    weatherAssessed_ = true;
+    lastWeather_ = weather;
+    
+    // Update weather system if available
+    if (weatherSystem_) {
+        weatherSystem_->updateWeatherConditions(weather);
+    }
+    log("Weather assessment: " +
+        std::string(weather.icing ? "ICING " : "") +
+        std::string(weather.turbulence ? "TURBULENCE " : "") +
+        std::string(weather.precipitation ? "PRECIP " : "") +
+        "Pressure: " + std::to_string(currentState_.altimeter) + " inHg");
+    
+    for (const WeatherChange& change : routeChanges) {
+        std::string station = unpackStationId(change.station);
+        if (change.reasons & WeatherChangeReason::REMOVED) {
+            log("Route weather: " + station + " report expired");
+        } else if (!change.current.has(StationFlags::FLIGHT_OK)) {
+            log("WARNING: Route weather below minimums at " + station);
+        } else {
+            log("Route weather changed at " + station);
+        }
+    }
+    
+    if (!isWeatherSuitable(weather)) {
+        handleBadWeather(weather);
+    }
+}
+
+bool AIPilot::weatherChanged(const WeatherConditions& before, const WeatherConditions& after) {
+    return before.icing != after.icing || before.turbulence != after.turbulence ||
+           before.precipitation != after.precipitation ||
+           std::abs(before.visibility - after.visibility) >= 1.0 ||
+           std::abs(before.cloudBase - after.cloudBase) >= 500.0 ||
+           std::abs(before.windSpeed - after.windSpeed) >= 10.0 ||
+           isWeatherSuitable(before) != isWeatherSuitable(after);
+}
+
+bool AIPilot::isWeatherSuitable(const WeatherConditions& weather) {
     // Check VFR minimums (simplified)
     bool vfrMinimums = (weather.visibility >= 3.0 && weather.cloudBase >= 1000.0);
     
@@ -1092,7 +1642,13 @@ bool AIPilot::isWeatherSuitable() {
 }
 
 void AIPilot::log(const std::string& message) {
-    std::cout << "[AI Pilot] " << message << std::endl;
+    if (message.compare(0, 6, "ERROR:") == 0 || message.compare(0, 10, "EMERGENCY:") == 0) {
+        AICOPILOT_LOG_ERROR("[AI Pilot] {}", message);
+    } else if (message.compare(0, 8, "WARNING:") == 0) {
+        AICOPILOT_LOG_WARNING("[AI Pilot] {}", message);
+    } else {
+        AICOPILOT_LOG_INFO("[AI Pilot] {}", message);
+    }
 }
 
 void AIPilot::initializeAirportOperations() {
@@ -1145,6 +1701,9 @@ void AIPilot::setupDefaultAirportLayout() {
     bool initialized = false;
 
     if (navdataProvider_ && navdataProvider_->isReady()) {
+        // Fetch both ends in the background; the one initialized below waits for its own
+        airportManager_->prefetch({plan.departure, plan.arrival});
+
         AirportInfo info;
         if (navdataProvider_->getAirportByICAO(airportIcao, info)) {
             referencePoint = Airport::LatLonAlt(info.position.latitude,
@@ -1161,6 +1720,14 @@ void AIPilot::setupDefaultAirportLayout() {
         airportOps_->initialize_airport(airportIcao, referencePoint);
     }
 
+    // Placeholder layout only when navdata has none for the airport
+    if (initialized && !airportManager_->get_layout()->get_runways().empty()) {
+        if (navigation_ && atc_) {
+            atc_->setFlightPlan(plan);
+        }
+        return;
+    }
+
     std::vector<Airport::Runway> runways;
     Airport::Runway runwayA;
     runwayA.runway_number = 4;
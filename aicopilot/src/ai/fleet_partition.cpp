@@ -0,0 +1,172 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Fleet Partition Implementation
+* Hilbert-ordered tile groups cut into balanced node runs
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/fleet_partition.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr double NM_PER_DEGREE = 60.0;
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+constexpr double MAX_TILE_LATITUDE = 89.999999;
+
+TileKey tileOf(double latitude, double longitude) {
+    latitude = std::max(-90.0, std::min(MAX_TILE_LATITUDE, latitude));
+    longitude = std::max(-180.0, std::min(179.999999, longitude));
+    return packTileKey(static_cast<int>(std::floor(latitude)), static_cast<int>(std::floor(longitude)));
+}
+
+// Tiles under a leg, sampled often enough that no crossed tile is skipped
+// by more than a corner
+void addLegTiles(const LatLon& from, const LatLon& to, std::vector<TileKey>& tiles) {
+    double span = std::max(std::fabs(to.latitude - from.latitude), std::fabs(to.longitude - from.longitude));
+    int steps = std::max(1, static_cast<int>(std::ceil(span / FleetPartitioner::ROUTE_SAMPLE_DEGREES)));
+    for (int i = 0; i <= steps; i++) {
+        double t = static_cast<double>(i) / steps;
+        tiles.push_back(tileOf(from.latitude + (to.latitude - from.latitude) * t,
+                               from.longitude + (to.longitude - from.longitude) * t));
+    }
+}
+
+} // namespace
+
+void FleetBounds::expand(double latitude, double longitude) {
+    south = std::min(south, latitude);
+    north = std::max(north, latitude);
+    west = std::min(west, longitude);
+    east = std::max(east, longitude);
+}
+
+FleetBounds FleetBounds::grown(double distanceNM) const {
+    if (empty()) return *this;
+    double dLat = distanceNM / NM_PER_DEGREE;
+    double widest = std::min(89.0, std::max(std::fabs(south), std::fabs(north)) + dLat);
+    double dLon = distanceNM / (NM_PER_DEGREE * std::cos(widest * DEG_TO_RAD));
+
+    FleetBounds result;
+    result.south = std::max(-90.0, south - dLat);
+    result.north = std::min(90.0, north + dLat);
+    result.west = std::max(-180.0, west - dLon);
+    result.east = std::min(180.0, east + dLon);
+    return result;
+}
+
+uint32_t FleetPartitioner::hilbertIndex(TileKey tile) {
+    // Classic xy -> d walk; x is longitude, y latitude, both from the grid corner
+    const uint32_t n = 1u << HILBERT_ORDER;
+    uint32_t x = static_cast<uint32_t>(tileKeyLongitude(tile) + 180);
+    uint32_t y = static_cast<uint32_t>(tileKeyLatitude(tile) + 90);
+    uint32_t d = 0;
+    for (uint32_t s = n / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) ? 1 : 0;
+        uint32_t ry = (y & s) ? 1 : 0;
+        d += s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+FleetPartition FleetPartitioner::partition(const std::vector<FleetPilotRoute>& pilots, size_t nodeCount) const {
+    nodeCount = std::max<size_t>(1, nodeCount);
+    FleetPartition result;
+    result.nodes.resize(nodeCount);
+    result.nodeOfPilot.assign(pilots.size(), 0);
+
+    // Each pilot's place on the curve: the tile at the centre of its route
+    struct Placement {
+        uint32_t curve;
+        size_t pilot;
+    };
+    std::vector<Placement> order;
+    order.reserve(pilots.size());
+    double totalWeight = 0.0;
+    for (size_t i = 0; i < pilots.size(); i++) {
+        FleetBounds box;
+        for (const LatLon& point : pilots[i].route) box.expand(point.latitude, point.longitude);
+        uint32_t curve = box.empty() ? 0 : hilbertIndex(tileOf((box.south + box.north) * 0.5,
+                                                               (box.west + box.east) * 0.5));
+        order.push_back({curve, i});
+        totalWeight += std::max(0.0, pilots[i].weight);
+    }
+    std::sort(order.begin(), order.end(), [&pilots](const Placement& a, const Placement& b) {
+        if (a.curve != b.curve) return a.curve < b.curve;
+        return pilots[a.pilot].pilotId < pilots[b.pilot].pilotId;
+    });
+
+    // Cut between tile groups, moving on once a group would straddle the
+    // node's share more than it fits inside it
+    size_t node = 0;
+    double assigned = 0.0;
+    for (size_t begin = 0; begin < order.size();) {
+        size_t end = begin;
+        double groupWeight = 0.0;
+        while (end < order.size() && order[end].curve == order[begin].curve) {
+            groupWeight += std::max(0.0, pilots[order[end].pilot].weight);
+            end++;
+        }
+
+        double target = totalWeight * static_cast<double>(node + 1) / static_cast<double>(nodeCount);
+        if (node + 1 < nodeCount && !result.nodes[node].pilots.empty() &&
+            assigned + groupWeight * 0.5 > target) {
+            node++;
+        }
+
+        FleetNodePlan& plan = result.nodes[node];
+        for (size_t i = begin; i < end; i++) {
+            const FleetPilotRoute& pilot = pilots[order[i].pilot];
+            plan.pilots.push_back(pilot.pilotId);
+            plan.weight += std::max(0.0, pilot.weight);
+            result.nodeOfPilot[order[i].pilot] = static_cast<uint32_t>(node);
+
+            for (size_t p = 0; p < pilot.route.size(); p++) {
+                plan.bounds.expand(pilot.route[p].latitude, pilot.route[p].longitude);
+                if (p + 1 < pilot.route.size()) {
+                    addLegTiles(pilot.route[p], pilot.route[p + 1], plan.tiles);
+                } else if (pilot.route.size() == 1) {
+                    plan.tiles.push_back(tileOf(pilot.route[p].latitude, pilot.route[p].longitude));
+                }
+            }
+        }
+        assigned += groupWeight;
+        begin = end;
+    }
+
+    for (auto& plan : result.nodes) {
+        std::sort(plan.tiles.begin(), plan.tiles.end());
+        plan.tiles.erase(std::unique(plan.tiles.begin(), plan.tiles.end()), plan.tiles.end());
+        plan.exchangeBounds = plan.bounds.grown(exchangeRadiusNM_);
+    }
+
+    // Peers: either side's traffic can come within the radius of the other's routes
+    for (size_t a = 0; a < nodeCount; a++) {
+        for (size_t b = a + 1; b < nodeCount; b++) {
+            if (result.nodes[a].exchangeBounds.overlaps(result.nodes[b].bounds) ||
+                result.nodes[b].exchangeBounds.overlaps(result.nodes[a].bounds)) {
+                result.nodes[a].neighbors.push_back(static_cast<uint32_t>(b));
+                result.nodes[b].neighbors.push_back(static_cast<uint32_t>(a));
+            }
+        }
+    }
+    for (auto& plan : result.nodes) std::sort(plan.neighbors.begin(), plan.neighbors.end());
+    return result;
+}
+
+} // namespace AICopilot
@@ -0,0 +1,381 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Pilot Checkpoint Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/pilot_checkpoint.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AICopilot {
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t checksum(const uint8_t* data, size_t size) {
+    uint64_t hash = FNV_OFFSET;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+template <typename T>
+void appendSection(std::vector<uint8_t>& image, PilotCheckpointHeader& header, PilotCheckpointSectionId id,
+                   const std::vector<T>& items) {
+    image.resize((image.size() + 7) & ~static_cast<size_t>(7), 0);
+    size_t bytes = items.size() * sizeof(T);
+    header.sections[id].offset = image.size();
+    header.sections[id].size = bytes;
+    if (bytes > 0) {
+        const auto* begin = reinterpret_cast<const uint8_t*>(items.data());
+        image.insert(image.end(), begin, begin + bytes);
+    }
+}
+
+PilotCheckpointString addString(std::vector<char>& pool, const std::string& value) {
+    PilotCheckpointString ref{static_cast<uint32_t>(pool.size()), static_cast<uint32_t>(value.size())};
+    pool.insert(pool.end(), value.begin(), value.end());
+    return ref;
+}
+
+} // namespace
+
+// ============================================================================
+// PilotCheckpointBuilder
+// ============================================================================
+
+PilotCheckpointBuilder::PilotCheckpointBuilder() {
+    std::memset(&state_, 0, sizeof(state_));
+    state_.phase = static_cast<int32_t>(FlightPhase::UNKNOWN);
+}
+
+void PilotCheckpointBuilder::setFlightPlan(const FlightPlan& plan, size_t activeWaypoint) {
+    plan_ = plan;
+    state_.activeWaypoint = static_cast<uint32_t>(activeWaypoint);
+    state_.cruiseAltitude = plan.cruiseAltitude;
+    state_.cruiseSpeed = plan.cruiseSpeed;
+}
+
+void PilotCheckpointBuilder::setClearances(const ClearanceLog& log, const std::string& lastClearance,
+                                           const std::vector<std::string>& pendingInstructions) {
+    hasClearances_ = true;
+    clearanceBase_ = log.base();
+    clearanceEvents_ = log.events();
+    atcText_.clear();
+    atcText_.push_back(lastClearance);
+    atcText_.insert(atcText_.end(), pendingInstructions.begin(), pendingInstructions.end());
+}
+
+void PilotCheckpointBuilder::addWarmEntry(WarmSetCache cache, const std::string& key) {
+    warmSet_.emplace_back(cache, key);
+}
+
+void PilotCheckpointBuilder::setModelImage(std::vector<uint8_t> image) {
+    model_ = std::move(image);
+}
+
+std::vector<uint8_t> PilotCheckpointBuilder::build() const {
+    std::vector<char> pool;
+    PilotCheckpointState state = state_;
+    state.departure = addString(pool, plan_.departure);
+    state.arrival = addString(pool, plan_.arrival);
+
+    std::vector<PilotCheckpointWaypoint> waypoints;
+    waypoints.reserve(plan_.waypoints.size());
+    for (const Waypoint& waypoint : plan_.waypoints) {
+        PilotCheckpointWaypoint record{};
+        record.latitude = waypoint.position.latitude;
+        record.longitude = waypoint.position.longitude;
+        record.positionAltitude = waypoint.position.altitude;
+        record.heading = waypoint.position.heading;
+        record.altitude = waypoint.altitude;
+        record.id = addString(pool, waypoint.id);
+        record.type = addString(pool, waypoint.type);
+        waypoints.push_back(record);
+    }
+
+    std::vector<PilotCheckpointString> atcText;
+    for (const std::string& text : atcText_) {
+        atcText.push_back(addString(pool, text));
+    }
+
+    std::vector<PilotCheckpointWarmEntry> warmSet;
+    for (const auto& entry : warmSet_) {
+        warmSet.push_back({entry.first, 0, addString(pool, entry.second)});
+    }
+
+    PilotCheckpointHeader header{};
+    std::memcpy(header.magic, PilotCheckpoint::MAGIC, sizeof(header.magic));
+    header.version = PilotCheckpoint::VERSION;
+    header.headerSize = sizeof(PilotCheckpointHeader);
+    header.waypointCount = static_cast<uint32_t>(waypoints.size());
+    header.warmEntryCount = static_cast<uint32_t>(warmSet.size());
+
+    std::vector<uint8_t> image(sizeof(PilotCheckpointHeader), 0);
+    appendSection(image, header, CHECKPOINT_SECTION_PILOT, std::vector<PilotCheckpointState>{state});
+    appendSection(image, header, CHECKPOINT_SECTION_WAYPOINTS, waypoints);
+    appendSection(image, header, CHECKPOINT_SECTION_CLEARANCE,
+                  hasClearances_ ? std::vector<ClearanceSnapshot>{clearanceBase_} : std::vector<ClearanceSnapshot>{});
+    appendSection(image, header, CHECKPOINT_SECTION_CLEARANCE_EVENTS, clearanceEvents_);
+    appendSection(image, header, CHECKPOINT_SECTION_ATC_TEXT, atcText);
+    appendSection(image, header, CHECKPOINT_SECTION_WARM_SET, warmSet);
+    appendSection(image, header, CHECKPOINT_SECTION_MODEL, model_);
+    appendSection(image, header, CHECKPOINT_SECTION_STRINGS, pool);
+
+    header.fileSize = image.size();
+    header.checksum = checksum(image.data() + sizeof(PilotCheckpointHeader),
+                               image.size() - sizeof(PilotCheckpointHeader));
+    std::memcpy(image.data(), &header, sizeof(header));
+    return image;
+}
+
+bool PilotCheckpointBuilder::write(const std::string& path) const {
+    std::vector<uint8_t> image = build();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "PilotCheckpointBuilder: Cannot write " << path << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    return static_cast<bool>(out);
+}
+
+// ============================================================================
+// PilotCheckpoint
+// ============================================================================
+
+PilotCheckpoint::~PilotCheckpoint() {
+    close();
+}
+
+bool PilotCheckpoint::open(const std::string& path, bool verifyChecksum) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || static_cast<size_t>(size.QuadPart) < sizeof(PilotCheckpointHeader)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle_ = file;
+    mappingHandle_ = mapping;
+    size_ = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(PilotCheckpointHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // the mapping keeps the file referenced
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+
+    data_ = static_cast<const uint8_t*>(view);
+    if (!validate(verifyChecksum)) {
+        std::cerr << "PilotCheckpoint: " << path << " is not a valid pilot checkpoint" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool PilotCheckpoint::openImage(std::vector<uint8_t> image) {
+    close();
+    if (image.size() < sizeof(PilotCheckpointHeader)) {
+        return false;
+    }
+
+    image_ = std::move(image);
+    data_ = image_.data();
+    size_ = image_.size();
+    if (!validate(true)) {
+        std::cerr << "PilotCheckpoint: image is not a valid pilot checkpoint" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void PilotCheckpoint::close() {
+    if (data_ != nullptr && image_.empty()) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(static_cast<HANDLE>(mappingHandle_));
+        CloseHandle(static_cast<HANDLE>(fileHandle_));
+#else
+        munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+    image_.clear();
+    image_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+    fileHandle_ = nullptr;
+    mappingHandle_ = nullptr;
+}
+
+FlightPlan PilotCheckpoint::getFlightPlan() const {
+    FlightPlan plan{};
+    const PilotCheckpointState& state = getState();
+    plan.departure = str(state.departure);
+    plan.arrival = str(state.arrival);
+    plan.cruiseAltitude = state.cruiseAltitude;
+    plan.cruiseSpeed = state.cruiseSpeed;
+
+    const auto* waypoints = section<PilotCheckpointWaypoint>(CHECKPOINT_SECTION_WAYPOINTS);
+    plan.waypoints.reserve(header().waypointCount);
+    for (uint32_t i = 0; i < header().waypointCount; ++i) {
+        const PilotCheckpointWaypoint& record = waypoints[i];
+        Waypoint waypoint;
+        waypoint.position = {record.latitude, record.longitude, record.positionAltitude, record.heading};
+        waypoint.altitude = record.altitude;
+        waypoint.id = str(record.id);
+        waypoint.type = str(record.type);
+        plan.waypoints.push_back(std::move(waypoint));
+    }
+    return plan;
+}
+
+bool PilotCheckpoint::hasClearances() const {
+    return isOpen() && header().sections[CHECKPOINT_SECTION_CLEARANCE].size != 0;
+}
+
+const ClearanceSnapshot& PilotCheckpoint::getClearanceBase() const {
+    return *section<ClearanceSnapshot>(CHECKPOINT_SECTION_CLEARANCE);
+}
+
+const ClearanceEvent* PilotCheckpoint::getClearanceEvents() const {
+    return section<ClearanceEvent>(CHECKPOINT_SECTION_CLEARANCE_EVENTS);
+}
+
+size_t PilotCheckpoint::getClearanceEventCount() const {
+    return isOpen() ? header().sections[CHECKPOINT_SECTION_CLEARANCE_EVENTS].size / sizeof(ClearanceEvent) : 0;
+}
+
+size_t PilotCheckpoint::getAtcTextCount() const {
+    return isOpen() ? header().sections[CHECKPOINT_SECTION_ATC_TEXT].size / sizeof(PilotCheckpointString) : 0;
+}
+
+std::string PilotCheckpoint::getLastClearance() const {
+    return getAtcTextCount() > 0 ? str(atcText()[0]) : std::string();
+}
+
+std::vector<std::string> PilotCheckpoint::getPendingInstructions() const {
+    std::vector<std::string> pending;
+    for (size_t i = 1; i < getAtcTextCount(); ++i) {
+        pending.push_back(str(atcText()[i]));
+    }
+    return pending;
+}
+
+std::vector<std::string> PilotCheckpoint::getWarmKeys(WarmSetCache cache) const {
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < getWarmEntryCount(); ++i) {
+        if (warmEntries()[i].cache == cache) keys.push_back(str(warmEntries()[i].key));
+    }
+    return keys;
+}
+
+std::string PilotCheckpoint::str(const PilotCheckpointString& ref) const {
+    const char* pool = section<char>(CHECKPOINT_SECTION_STRINGS);
+    return std::string(pool + ref.offset, ref.length);
+}
+
+bool PilotCheckpoint::validString(const PilotCheckpointString& ref) const {
+    const uint64_t poolSize = header().sections[CHECKPOINT_SECTION_STRINGS].size;
+    return ref.offset <= poolSize && ref.length <= poolSize - ref.offset;
+}
+
+bool PilotCheckpoint::validate(bool verifyChecksum) const {
+    const PilotCheckpointHeader& h = header();
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != VERSION) return false;
+    if (h.headerSize != sizeof(PilotCheckpointHeader) || h.fileSize != size_) return false;
+
+    for (uint32_t id = 0; id < CHECKPOINT_SECTION_COUNT; ++id) {
+        const PilotCheckpointSection& s = h.sections[id];
+        if (s.offset % 8 != 0 || s.offset < sizeof(PilotCheckpointHeader)) return false;
+        if (s.offset > size_ || s.size > size_ - s.offset) return false;
+    }
+    const uint64_t clearanceSize = h.sections[CHECKPOINT_SECTION_CLEARANCE].size;
+    const uint64_t eventsSize = h.sections[CHECKPOINT_SECTION_CLEARANCE_EVENTS].size;
+    if (h.sections[CHECKPOINT_SECTION_PILOT].size != sizeof(PilotCheckpointState) ||
+        h.sections[CHECKPOINT_SECTION_WAYPOINTS].size != uint64_t(h.waypointCount) * sizeof(PilotCheckpointWaypoint) ||
+        (clearanceSize != 0 && clearanceSize != sizeof(ClearanceSnapshot)) ||
+        eventsSize % sizeof(ClearanceEvent) != 0 || (clearanceSize == 0 && eventsSize != 0) ||
+        h.sections[CHECKPOINT_SECTION_ATC_TEXT].size % sizeof(PilotCheckpointString) != 0 ||
+        h.sections[CHECKPOINT_SECTION_WARM_SET].size != uint64_t(h.warmEntryCount) * sizeof(PilotCheckpointWarmEntry)) {
+        return false;
+    }
+
+    if (verifyChecksum &&
+        checksum(data_ + sizeof(PilotCheckpointHeader), size_ - sizeof(PilotCheckpointHeader)) != h.checksum) {
+        return false;
+    }
+
+    // Every string ref lands inside the pool, so readers never bounds-check
+    const PilotCheckpointState& state = getState();
+    if (!validString(state.departure) || !validString(state.arrival)) return false;
+    const auto* waypoints = section<PilotCheckpointWaypoint>(CHECKPOINT_SECTION_WAYPOINTS);
+    for (uint32_t i = 0; i < h.waypointCount; ++i) {
+        if (!validString(waypoints[i].id) || !validString(waypoints[i].type)) return false;
+    }
+    for (size_t i = 0; i < getAtcTextCount(); ++i) {
+        if (!validString(atcText()[i])) return false;
+    }
+    for (uint32_t i = 0; i < h.warmEntryCount; ++i) {
+        if (!validString(warmEntries()[i].key)) return false;
+    }
+    return true;
+}
+
+} // namespace AICopilot
@@ -0,0 +1,111 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Pilot Host Implementation
+* Parallel per-frame updates of hosted AIPilot instances
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/pilot_host.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace AICopilot {
+
+PilotHost::PilotHost(size_t threadCount)
+    : pool_(threadCount) {
+}
+
+PilotHost::~PilotHost() {
+    // Pilots must not be torn down while a frame is still updating them
+    pool_.wait();
+}
+
+void PilotHost::setSharedNavdata(std::shared_ptr<const INavdataProvider> navdata) {
+    navdata_ = std::move(navdata);
+}
+
+void PilotHost::setSharedOllamaGateway(std::shared_ptr<OllamaGateway> gateway) {
+    ollamaGateway_ = std::move(gateway);
+}
+
+AIPilot& PilotHost::addPilot() {
+    return addHostedPilot(false);
+}
+
+AIPilot& PilotHost::addSessionPilot() {
+    return addHostedPilot(true);
+}
+
+AIPilot& PilotHost::addHostedPilot(bool dispatchThread) {
+    if (!navdata_) {
+        navdata_ = AIPilot::createNavdataProvider();
+    }
+
+    auto pilot = std::make_unique<AIPilot>();
+
+    // The host pool runs slow tasks inline in update(), and pumps SimConnect
+    // there too unless the session has its own dispatch thread
+    AIPilotThreading threading;
+    threading.dispatchThread = dispatchThread;
+    threading.schedulerWorkers = 0;
+    pilot->setThreading(threading);
+    pilot->setSharedNavdata(navdata_);
+    if (ollamaGateway_) {
+        pilot->setSharedOllamaGateway(ollamaGateway_, static_cast<uint32_t>(pilots_.size()));
+    }
+
+    pilots_.push_back(std::move(pilot));
+    return *pilots_.back();
+}
+
+size_t PilotHost::getActivePilotCount() const {
+    size_t count = 0;
+    for (const auto& pilot : pilots_) {
+        if (pilot->isActive()) count++;
+    }
+    return count;
+}
+
+void PilotHost::tick() {
+    for (auto& pilot : pilots_) {
+        if (!pilot->isActive()) continue;
+        AIPilot* instance = pilot.get();
+        pool_.submit([instance] { instance->update(); });
+    }
+    pool_.wait();
+    frameCount_++;
+}
+
+void PilotHost::run() {
+    // Fast enough for the fastest pilot, e.g. a helicopter's hover loop
+    double rateHz = AIPilot::CONTROL_RATE_HZ;
+    for (const auto& pilot : pilots_) {
+        rateHz = std::max(rateHz, pilot->getUpdateRateHz());
+    }
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / rateHz));
+    auto nextFrame = std::chrono::steady_clock::now();
+
+    stopRequested_ = false;
+    while (!stopRequested_ && getActivePilotCount() > 0) {
+        tick();
+
+        nextFrame += period;
+        auto now = std::chrono::steady_clock::now();
+        if (now > nextFrame) {
+            // Frame overran; start the next one immediately instead of bursting
+            frameOverruns_++;
+            nextFrame = now;
+        } else {
+            std::this_thread::sleep_until(nextFrame);
+        }
+    }
+}
+
+} // namespace AICopilot
@@ -0,0 +1,184 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Subsystem Initializer Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/subsystem_initializer.hpp"
+#include "../include/binary_log.hpp"
+#include <exception>
+
+namespace AICopilot {
+
+SubsystemInitializer::SubsystemInitializer(std::shared_ptr<IoExecutor> executor)
+    : executor_(executor ? std::move(executor) : IoExecutor::shared()) {
+}
+
+SubsystemInitializer::~SubsystemInitializer() {
+    waitAll();
+}
+
+bool SubsystemInitializer::add(const std::string& name, const std::vector<std::string>& dependencies,
+                               bool critical, InitFunction function) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (started_ || !function) {
+        return false;
+    }
+
+    std::vector<size_t> dependencyIndices;
+    for (const auto& dependency : dependencies) {
+        size_t index = 0;
+        while (index < steps_.size() && steps_[index].stats.name != dependency) {
+            index++;
+        }
+        if (index == steps_.size()) {
+            return false;
+        }
+        dependencyIndices.push_back(index);
+    }
+    for (const auto& step : steps_) {
+        if (step.stats.name == name) {
+            return false;
+        }
+    }
+
+    Step step;
+    step.stats.name = name;
+    step.stats.critical = critical;
+    step.function = std::move(function);
+    step.waitingOn = dependencyIndices.size();
+    for (size_t index : dependencyIndices) {
+        steps_[index].dependents.push_back(steps_.size());
+    }
+    steps_.push_back(std::move(step));
+    return true;
+}
+
+void SubsystemInitializer::start() {
+    std::vector<size_t> roots;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (started_) {
+            return;
+        }
+        started_ = true;
+        startTime_ = Clock::now();
+        unfinished_ = steps_.size();
+        for (size_t i = 0; i < steps_.size(); ++i) {
+            if (steps_[i].stats.critical) criticalUnfinished_++;
+            if (steps_[i].waitingOn == 0) roots.push_back(i);
+        }
+    }
+    doneCv_.notify_all();   // nothing critical registered: ready already
+    for (size_t index : roots) {
+        post(index);
+    }
+}
+
+void SubsystemInitializer::post(size_t index) {
+    executor_->post([this, index]() { run(index); });
+}
+
+void SubsystemInitializer::run(size_t index) {
+    InitFunction function;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Step& step = steps_[index];
+        step.stats.state = SubsystemInitState::RUNNING;
+        step.stats.startMs = sinceStartMs(Clock::now());
+        function = std::move(step.function);
+    }
+
+    // Names are fixed once started, so they are read here without the lock
+    const std::string& name = steps_[index].stats.name;
+    bool succeeded = false;
+    try {
+        succeeded = function();
+    } catch (const std::exception& e) {
+        AICOPILOT_LOG_ERROR("[Init] {} threw: {}", name, e.what());
+    } catch (...) {
+        AICOPILOT_LOG_ERROR("[Init] {} threw", name);
+    }
+
+    std::vector<size_t> ready;
+    std::lock_guard<std::mutex> lock(mutex_);
+    Step& step = steps_[index];
+    step.stats.durationMs = sinceStartMs(Clock::now()) - step.stats.startMs;
+    finishLocked(index, succeeded ? SubsystemInitState::SUCCEEDED : SubsystemInitState::FAILED);
+    if (succeeded) {
+        for (size_t dependent : step.dependents) {
+            if (--steps_[dependent].waitingOn == 0) ready.push_back(dependent);
+        }
+    } else {
+        // Skip everything downstream; each is finished once
+        std::vector<size_t> pending = step.dependents;
+        while (!pending.empty()) {
+            size_t next = pending.back();
+            pending.pop_back();
+            if (steps_[next].stats.state != SubsystemInitState::PENDING) continue;
+            finishLocked(next, SubsystemInitState::SKIPPED);
+            pending.insert(pending.end(), steps_[next].dependents.begin(), steps_[next].dependents.end());
+        }
+    }
+    for (size_t next : ready) {
+        post(next);
+    }
+    // Notified under the lock: a waiter (the destructor) cannot return while
+    // this job still touches the initializer
+    doneCv_.notify_all();
+}
+
+void SubsystemInitializer::finishLocked(size_t index, SubsystemInitState state) {
+    Step& step = steps_[index];
+    step.stats.state = state;
+    step.function = nullptr;
+    unfinished_--;
+    if (step.stats.critical) {
+        criticalFailed_ = criticalFailed_ || state != SubsystemInitState::SUCCEEDED;
+        if (--criticalUnfinished_ == 0) {
+            timeToReadyMs_ = sinceStartMs(Clock::now());
+        }
+    }
+}
+
+bool SubsystemInitializer::waitReady() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    doneCv_.wait(lock, [this] { return !started_ || criticalUnfinished_ == 0; });
+    return started_ && !criticalFailed_;
+}
+
+void SubsystemInitializer::waitAll() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    doneCv_.wait(lock, [this] { return !started_ || unfinished_ == 0; });
+}
+
+bool SubsystemInitializer::isReady() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return started_ && criticalUnfinished_ == 0;
+}
+
+double SubsystemInitializer::getTimeToReadyMs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timeToReadyMs_;
+}
+
+std::vector<SubsystemInitStats> SubsystemInitializer::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<SubsystemInitStats> stats;
+    stats.reserve(steps_.size());
+    for (const auto& step : steps_) {
+        stats.push_back(step.stats);
+    }
+    return stats;
+}
+
+double SubsystemInitializer::sinceStartMs(Clock::time_point now) const {
+    return std::chrono::duration<double, std::milli>(now - startTime_).count();
+}
+
+} // namespace AICopilot
@@ -0,0 +1,227 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Task Scheduler Implementation
+* Multi-rate tick scheduling with a worker pool for slow tasks
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/task_scheduler.hpp"
+#include "../include/hot_path_trace.hpp"
+#include "../include/tick_watchdog.hpp"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace AICopilot {
+
+TaskScheduler::TaskScheduler(size_t workerCount) {
+    workers_.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&TaskScheduler::workerLoop, this);
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        stopping_ = true;
+    }
+    queueCv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+TaskScheduler::TaskId TaskScheduler::addTask(const std::string& name, double rateHz,
+                                             TaskFunction function, TaskExecution execution) {
+    auto task = std::make_unique<Task>();
+    task->name = name;
+    task->traceName = HotPathTracer::intern(name);
+    task->function = std::move(function);
+    task->execution = workers_.empty() ? TaskExecution::INLINE : execution;
+    if (rateHz > 0.0) {
+        task->rateHz = rateHz;
+        task->period = std::chrono::round<Clock::duration>(
+            std::chrono::duration<double>(1.0 / rateHz));
+    }
+
+    tasks_.push_back(std::move(task));
+    return tasks_.size() - 1;
+}
+
+void TaskScheduler::trigger(TaskId id) {
+    if (id < tasks_.size()) {
+        tasks_[id]->triggered = true;
+    }
+}
+
+void TaskScheduler::setTaskRate(TaskId id, double rateHz) {
+    if (id >= tasks_.size() || rateHz <= 0.0) {
+        return;
+    }
+    Task& task = *tasks_[id];
+    if (task.rateHz <= 0.0) {
+        return;   // on-demand tasks stay on demand
+    }
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    task.rateHz = rateHz;
+    task.period = std::chrono::round<Clock::duration>(std::chrono::duration<double>(1.0 / rateHz));
+}
+
+void TaskScheduler::tick() {
+    tick(Clock::now());
+}
+
+void TaskScheduler::tick(Clock::time_point now) {
+    // Real time, whatever clock the caller schedules against
+    auto tickStart = Clock::now();
+
+    for (auto& taskPtr : tasks_) {
+        Task& task = *taskPtr;
+        bool due = task.triggered.exchange(false);
+
+        if (task.rateHz > 0.0) {
+            if (!task.started) {
+                task.started = true;
+                task.nextDue = now;
+            }
+
+            if (now >= task.nextDue) {
+                due = true;
+                if (now - task.nextDue >= task.period) {
+                    // A whole slot went by without a tick; resync instead of bursting
+                    recordMiss(task);
+                    task.nextDue = now + task.period;
+                } else {
+                    task.nextDue += task.period;
+                }
+            }
+        }
+
+        if (!due) continue;
+
+        if (task.running) {
+            // Previous worker run still in flight
+            recordMiss(task);
+            continue;
+        }
+        dispatch(task);
+    }
+
+    if (watchdog_) {
+        watchdog_->recordTick(Clock::now() - tickStart);
+    }
+}
+
+void TaskScheduler::dispatch(Task& task) {
+    task.running = true;
+
+    if (task.execution == TaskExecution::INLINE) {
+        runTask(task);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queue_.push_back(&task);
+        pendingJobs_++;
+    }
+    queueCv_.notify_one();
+}
+
+void TaskScheduler::runTask(Task& task) {
+    auto start = Clock::now();
+    try {
+        TRACE_SCOPE(task.traceName);
+        task.function();
+    } catch (const std::exception& e) {
+        std::cerr << "Scheduled task '" << task.name << "' failed: " << e.what() << std::endl;
+    }
+    auto elapsed = Clock::now() - start;
+    double durationMs = std::chrono::duration<double, std::milli>(elapsed).count();
+
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        task.runCount++;
+        task.lastDurationMs = durationMs;
+        task.maxDurationMs = std::max(task.maxDurationMs, durationMs);
+        if (task.rateHz > 0.0 && elapsed > task.period) {
+            task.deadlineMisses++;
+        }
+    }
+    task.running = false;
+}
+
+void TaskScheduler::recordMiss(Task& task) {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    task.deadlineMisses++;
+}
+
+void TaskScheduler::workerLoop() {
+    HotPathTracer::setThreadName("scheduler worker");
+    for (;;) {
+        Task* task = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_ && queue_.empty()) return;
+            task = queue_.front();
+            queue_.pop_front();
+        }
+
+        runTask(*task);
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex_);
+            pendingJobs_--;
+        }
+        idleCv_.notify_all();
+    }
+}
+
+void TaskScheduler::waitForWorkers() {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    idleCv_.wait(lock, [this] { return pendingJobs_ == 0; });
+}
+
+void TaskScheduler::clear() {
+    waitForWorkers();
+    tasks_.clear();
+}
+
+std::vector<ScheduledTaskStats> TaskScheduler::getStats() const {
+    std::vector<ScheduledTaskStats> stats;
+    stats.reserve(tasks_.size());
+
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    for (const auto& task : tasks_) {
+        ScheduledTaskStats entry;
+        entry.name = task->name;
+        entry.rateHz = task->rateHz;
+        entry.execution = task->execution;
+        entry.runCount = task->runCount;
+        entry.deadlineMisses = task->deadlineMisses;
+        entry.lastDurationMs = task->lastDurationMs;
+        entry.maxDurationMs = task->maxDurationMs;
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+uint64_t TaskScheduler::getTotalDeadlineMisses() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    uint64_t total = 0;
+    for (const auto& task : tasks_) {
+        total += task->deadlineMisses;
+    }
+    return total;
+}
+
+} // namespace AICopilot
@@ -0,0 +1,97 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/tick_watchdog.hpp"
+#include "../include/system_monitor.hpp"
+#include <algorithm>
+
+namespace AICopilot {
+
+TickWatchdog::TickWatchdog(Clock::duration budget)
+    : budget_(budget) {
+    stats_.budgetMs = std::chrono::duration<double, std::milli>(budget).count();
+}
+
+void TickWatchdog::addStep(const std::string& name, DegradationStep step) {
+    steps_.push_back({name, std::move(step)});
+}
+
+void TickWatchdog::recordTick(Clock::duration elapsed) {
+    bool overrun = elapsed > budget_;
+    double elapsedMs = std::chrono::duration<double, std::milli>(elapsed).count();
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        stats_.ticks++;
+        stats_.overruns += overrun ? 1 : 0;
+        stats_.lastTickMs = elapsedMs;
+        stats_.maxTickMs = std::max(stats_.maxTickMs, elapsedMs);
+    }
+
+    windowOverruns_ += (overrun ? 1 : 0) - (window_[windowHead_] ? 1 : 0);
+    window_[windowHead_] = overrun;
+    windowHead_ = (windowHead_ + 1) % WINDOW_TICKS;
+    withinBudgetStreak_ = overrun ? 0 : withinBudgetStreak_ + 1;
+
+    if (ticksSinceChange_ < WINDOW_TICKS) {
+        ticksSinceChange_++;
+        return;
+    }
+
+    size_t level = getLevel();
+    if (windowOverruns_ >= DEGRADE_OVERRUNS && level < steps_.size()) {
+        changeLevel(true);
+    } else if (withinBudgetStreak_ >= RECOVER_TICKS && level > 0) {
+        changeLevel(false);
+        withinBudgetStreak_ = 0;
+    }
+}
+
+void TickWatchdog::restoreAll() {
+    while (getLevel() > 0) {
+        changeLevel(false);
+    }
+}
+
+size_t TickWatchdog::getLevel() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return stats_.level;
+}
+
+TickWatchdogStats TickWatchdog::getStats() const {
+    std::lock_guard<std::mutex> lock(statsMutex_);
+    return stats_;
+}
+
+void TickWatchdog::changeLevel(bool degrade) {
+    size_t level = getLevel();
+    const Step& step = steps_[degrade ? level : level - 1];
+    step.apply(degrade);
+
+    std::vector<std::string> active;
+    {
+        std::lock_guard<std::mutex> lock(statsMutex_);
+        if (degrade) {
+            stats_.level++;
+            stats_.activeSteps.push_back(step.name);
+        } else {
+            stats_.level--;
+            stats_.activeSteps.pop_back();
+        }
+        stats_.levelChanges++;
+        active = stats_.activeSteps;
+    }
+    ticksSinceChange_ = 0;
+
+    if (monitor_) {
+        monitor_->reportDegradation(active, (degrade ? "Tick budget overrun, shed " : "Tick budget recovered, restored ") +
+                                    step.name);
+    }
+}
+
+} // namespace AICopilot
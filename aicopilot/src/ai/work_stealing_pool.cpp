@@ -0,0 +1,124 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Work-Stealing Pool Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/work_stealing_pool.hpp"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+namespace AICopilot {
+
+WorkStealingPool::WorkStealingPool(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    queues_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    threads_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads_.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stopping_ = true;
+    }
+    workCv_.notify_all();
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void WorkStealingPool::submit(Job job) {
+    // Count first so a worker can never take the job before it is accounted for
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        queued_++;
+        unfinished_++;
+    }
+
+    size_t index = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->jobs.push_back(std::move(job));
+    }
+    workCv_.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    idleCv_.wait(lock, [this] { return unfinished_ == 0; });
+}
+
+bool WorkStealingPool::popLocal(size_t index, Job& job) {
+    WorkerQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return false;
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(size_t thief, Job& job) {
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        WorkerQueue& victim = *queues_[(thief + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.jobs.empty()) continue;
+        job = std::move(victim.jobs.front());
+        victim.jobs.pop_front();
+        steals_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(size_t index) {
+    for (;;) {
+        Job job;
+        if (popLocal(index, job) || steal(index, job)) {
+            {
+                std::lock_guard<std::mutex> lock(stateMutex_);
+                queued_--;
+            }
+
+            try {
+                job();
+            } catch (const std::exception& e) {
+                std::cerr << "Pool job failed: " << e.what() << std::endl;
+            }
+
+            bool idle = false;
+            {
+                std::lock_guard<std::mutex> lock(stateMutex_);
+                idle = (--unfinished_ == 0);
+            }
+            if (idle) {
+                idleCv_.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(stateMutex_);
+        workCv_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+        if (stopping_ && queued_ == 0) return;
+    }
+}
+
+} // namespace AICopilot
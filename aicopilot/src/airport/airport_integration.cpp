@@ -20,91 +20,130 @@ namespace Integration {
 
 SimConnectBridge::SimConnectBridge(std::shared_ptr<SimConnectWrapper> simconnect)
     : simconnect_(std::move(simconnect))
-    , state_callback_(nullptr)
-    , last_user_state_()
+    , user_state_(SimConnectData())
+    , outgoing_(kCommandQueueCapacity)
+    , published_commands_(std::make_shared<const CommandMap>())
 {
     if (simconnect_) {
         simconnect_->subscribeToAircraftState([this](const AircraftState& state) {
-            SimConnectData data = convert_state(state);
-            {
-                std::lock_guard<std::mutex> lock(data_mutex_);
-                last_user_state_ = data;
-            }
+            drain_commands();
 
-            AircraftStateCallback callback_copy;
-            {
-                std::lock_guard<std::mutex> lock(data_mutex_);
-                callback_copy = state_callback_;
+            // SimConnectData holds only hot fields: an update that left the
+            // core unchanged (a switch or gauge) is not republished
+            uint64_t version = simconnect_->getStateVersion();
+            if (version != 0 && version == user_state_version_) {
+                return;
             }
+            user_state_version_ = version;
+            SimConnectData data = convert_state(state);
+            user_state_.store(data);
 
-            if (callback_copy) {
-                callback_copy(data);
+            if (auto callback = std::atomic_load(&state_callback_)) {
+                (*callback)(data);
             }
         });
     }
 }
 
 void SimConnectBridge::set_state_callback(AircraftStateCallback callback) {
-    std::lock_guard<std::mutex> lock(data_mutex_);
-    state_callback_ = std::move(callback);
+    std::shared_ptr<const AircraftStateCallback> next;
+    if (callback) {
+        next = std::make_shared<const AircraftStateCallback>(std::move(callback));
+    }
+    std::atomic_store(&state_callback_, std::move(next));
 }
 
 SimConnectBridge::SimConnectData SimConnectBridge::get_user_aircraft_state() const {
-    std::lock_guard<std::mutex> lock(data_mutex_);
-    return last_user_state_;
+    return user_state_.load();
 }
 
-void SimConnectBridge::transmit_taxi_clearance(int aircraft_object_id,
+bool SimConnectBridge::transmit_taxi_clearance(int aircraft_object_id,
                                                const std::vector<int>& taxiway_node_sequence)
 {
-    if (taxiway_node_sequence.empty()) {
-        return;
+    if (!simconnect_ || taxiway_node_sequence.empty()) {
+        return false;
     }
 
-    if (auto sim = simconnect_) {
-        // TODO: Real AI aircraft taxi routing via SimConnect client events.
-        (void)sim;
-    }
+    // TODO: Real AI aircraft taxi routing via SimConnect client events.
 
-    std::lock_guard<std::mutex> lock(data_mutex_);
-    ai_commands_[aircraft_object_id] = AICommand{
-        taxiway_node_sequence,
-        std::nullopt,
-        std::nullopt,
-        std::chrono::system_clock::now()
-    };
+    CommandUpdate update;
+    update.aircraft_id = aircraft_object_id;
+    update.kind = CommandUpdate::Kind::TaxiRoute;
+    update.taxiway_route = taxiway_node_sequence;
+    return enqueue(std::move(update));
 }
 
-void SimConnectBridge::transmit_altitude_clearance(int aircraft_object_id, double altitude_feet) {
+bool SimConnectBridge::transmit_altitude_clearance(int aircraft_object_id, double altitude_feet) {
     if (!simconnect_) {
-        return;
+        return false;
+    }
+
+    CommandUpdate update;
+    update.aircraft_id = aircraft_object_id;
+    update.kind = CommandUpdate::Kind::Altitude;
+    update.value = altitude_feet;
+    if (!enqueue(std::move(update))) {
+        return false;
     }
 
     if (aircraft_object_id == kUserAircraftId) {
         simconnect_->setAutopilotAltitude(altitude_feet);
     }
     // For AI aircraft, integration with custom SimConnect events is required.
-
-    std::lock_guard<std::mutex> lock(data_mutex_);
-    auto& command = ai_commands_[aircraft_object_id];
-    command.target_altitude_feet = altitude_feet;
-    command.timestamp = std::chrono::system_clock::now();
+    return true;
 }
 
-void SimConnectBridge::transmit_heading_instruction(int aircraft_object_id, double heading_true) {
+bool SimConnectBridge::transmit_heading_instruction(int aircraft_object_id, double heading_true) {
     if (!simconnect_) {
-        return;
+        return false;
+    }
+
+    CommandUpdate update;
+    update.aircraft_id = aircraft_object_id;
+    update.kind = CommandUpdate::Kind::Heading;
+    update.value = heading_true;
+    if (!enqueue(std::move(update))) {
+        return false;
     }
 
     if (aircraft_object_id == kUserAircraftId) {
         simconnect_->setAutopilotHeading(heading_true);
     }
     // For AI aircraft, integration with custom SimConnect events is required.
+    return true;
+}
 
-    std::lock_guard<std::mutex> lock(data_mutex_);
-    auto& command = ai_commands_[aircraft_object_id];
-    command.target_heading_true = heading_true;
-    command.timestamp = std::chrono::system_clock::now();
+bool SimConnectBridge::enqueue(CommandUpdate update) {
+    update.timestamp = std::chrono::system_clock::now();
+    return outgoing_.push(std::move(update));
+}
+
+size_t SimConnectBridge::drain_commands() {
+    size_t applied = 0;
+    CommandUpdate update;
+    while (outgoing_.pop(update)) {
+        AICommand& command = ai_commands_[update.aircraft_id];
+        switch (update.kind) {
+            case CommandUpdate::Kind::TaxiRoute:
+                // A new taxi clearance replaces the whole command
+                command = AICommand{std::move(update.taxiway_route), std::nullopt, std::nullopt, update.timestamp};
+                break;
+            case CommandUpdate::Kind::Altitude:
+                command.target_altitude_feet = update.value;
+                command.timestamp = update.timestamp;
+                break;
+            case CommandUpdate::Kind::Heading:
+                command.target_heading_true = update.value;
+                command.timestamp = update.timestamp;
+                break;
+        }
+        applied++;
+    }
+
+    if (applied > 0) {
+        std::atomic_store(&published_commands_, std::make_shared<const CommandMap>(ai_commands_));
+    }
+    return applied;
 }
 
 SimConnectBridge::SimConnectData SimConnectBridge::convert_state(const AircraftState& state) {
@@ -130,9 +169,9 @@ SimConnectBridge::SimConnectData SimConnectBridge::convert_state(const AircraftS
 }
 
 std::optional<SimConnectBridge::AICommand> SimConnectBridge::get_last_ai_command(int aircraft_id) const {
-    std::lock_guard<std::mutex> lock(data_mutex_);
-    auto it = ai_commands_.find(aircraft_id);
-    if (it == ai_commands_.end()) {
+    auto commands = std::atomic_load(&published_commands_);
+    auto it = commands->find(aircraft_id);
+    if (it == commands->end()) {
         return std::nullopt;
     }
     return it->second;
@@ -145,11 +184,13 @@ std::optional<SimConnectBridge::AICommand> SimConnectBridge::get_last_ai_command
 AirportOperationSystem::AirportOperationSystem(std::shared_ptr<AirportManager> manager)
     : airport_manager_(std::move(manager))
     , ground_router_(std::make_unique<GroundRouter>())
+    , taxi_planner_(std::make_unique<CooperativeTaxiPlanner>())
     , atc_sequencer_(std::make_unique<ATCSequencer>())
     , runway_assigner_(std::make_unique<RunwayAssignment>())
     , conflict_predictor_(std::make_unique<ConflictPredictor>(30.0))
     , conflict_resolver_(std::make_unique<ConflictResolver>())
     , maneuver_selector_(std::make_unique<ManeuverSelector>())
+    , maneuver_solver_(std::make_unique<CoordinatedManeuverSolver>(30.0))
     , holding_pattern_gen_(std::make_unique<HoldingPatternGenerator>())
     , collision_check_interval_ms_(100.0)
     , sequencing_update_interval_ms_(1000.0)
@@ -161,6 +202,7 @@ AirportOperationSystem::AirportOperationSystem(std::shared_ptr<AirportManager> m
     }
 
     conflict_resolver_->set_maneuver_selector(maneuver_selector_.get());
+    conflict_resolver_->set_coordinated_solver(maneuver_solver_.get());
 }
 
 void AirportOperationSystem::set_simconnect_bridge(std::shared_ptr<SimConnectBridge> bridge) {
@@ -185,9 +227,8 @@ void AirportOperationSystem::load_airport_data(const std::vector<Runway>& runway
                                                const TaxiwayNetwork& taxiway_net,
                                                const std::vector<ParkingPosition>& parkings)
 {
-    airport_manager_->set_runways(runways);
-    airport_manager_->set_taxiway_network(taxiway_net);
-    airport_manager_->set_parking_positions(parkings);
+    airport_manager_->set_layout(AirportLayoutData::build(runways, taxiway_net, parkings,
+                                                          airport_manager_->get_layout()->get_procedures()));
     sync_airport_dependencies();
 }
 
@@ -216,6 +257,10 @@ void AirportOperationSystem::set_collision_update_interval(double milliseconds)
     collision_check_interval_ms_ = milliseconds;
 }
 
+void AirportOperationSystem::set_thread_pool(std::shared_ptr<WorkStealingPool> pool) {
+    conflict_predictor_->set_thread_pool(std::move(pool));
+}
+
 void AirportOperationSystem::set_sequencing_update_interval(double milliseconds) {
     sequencing_update_interval_ms_ = milliseconds;
 }
@@ -228,7 +273,24 @@ void AirportOperationSystem::update_aircraft_state(const SimConnectBridge::SimCo
 void AirportOperationSystem::remove_aircraft(int aircraft_id) {
     aircraft_states_.erase(aircraft_id);
     conflict_predictor_->remove_aircraft(aircraft_id);
+    maneuver_solver_->clear_cache(aircraft_id);
     aircraft_clearances_.erase(aircraft_id);
+    taxi_planner_->release(aircraft_id);
+    atc_sequencer_->cancel_arrival(aircraft_id);
+}
+
+bool AirportOperationSystem::sequence_arrival(int aircraft_id, int runway_number, double eta_seconds) {
+    double current_time_seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return atc_sequencer_->request_arrival_slot(aircraft_id, runway_number, eta_seconds, current_time_seconds);
+}
+
+bool AirportOperationSystem::update_arrival_eta(int aircraft_id, double eta_seconds) {
+    return atc_sequencer_->update_arrival_eta(aircraft_id, eta_seconds);
+}
+
+const SequencedAircraft* AirportOperationSystem::get_sequence_info(int aircraft_id) const {
+    return atc_sequencer_->get_sequence_info(aircraft_id);
 }
 
 GroundRouter::RouteResult AirportOperationSystem::request_taxi_route(int start_node_id,
@@ -241,6 +303,18 @@ GroundRouter::RouteResult AirportOperationSystem::request_taxi_route(int start_n
     return ground_router_->find_shortest_path(start_node_id, end_node_id, max_speed_knots);
 }
 
+std::vector<CooperativeTaxiPlanner::TaxiPlan> AirportOperationSystem::plan_taxi_batch(
+    const std::vector<CooperativeTaxiPlanner::TaxiRequest>& requests)
+{
+    return taxi_planner_->plan_batch(requests);
+}
+
+CooperativeTaxiPlanner::TaxiPlan AirportOperationSystem::replan_taxi(
+    const CooperativeTaxiPlanner::TaxiRequest& request)
+{
+    return taxi_planner_->plan(request);
+}
+
 RunwayAssignment::RunwayCandidate AirportOperationSystem::assign_runway(double wind_direction,
                                                                         double wind_speed,
                                                                         bool is_departure)
@@ -328,6 +402,7 @@ void AirportOperationSystem::sync_airport_dependencies() {
     }
 
     ground_router_->set_taxiway_network(&airport->get_taxiway_network());
+    taxi_planner_->set_taxiway_network(&airport->get_taxiway_network());
     runway_assigner_->set_airport(airport);
     holding_pattern_gen_->set_airport(airport);
 
@@ -363,7 +438,8 @@ void AirportOperationSystem::update_collision_system() {
         conflict_predictor_->update_aircraft_state(sep_state);
     }
 
-    auto conflicts = conflict_predictor_->predict_conflicts();
+    // Runs before collision_elapsed_ms_ is reset, so it is the time since the last check
+    const auto& conflicts = conflict_predictor_->update_conflicts(collision_elapsed_ms_ / 1000.0);
     if (conflicts.empty()) {
         return;
     }
@@ -403,6 +479,9 @@ void AirportOperationSystem::update_atc_sequencing() {
             continue;
         }
 
+        // An arrival whose slot is due leaves the sequence; the ones behind it re-slot
+        atc_sequencer_->get_next_arrival_clearance(runway.runway_number, current_time_seconds);
+
         int next_departure = atc_sequencer_->get_next_departure_clearance(runway.runway_number, current_time_seconds);
         if (next_departure < 0) {
             continue;
@@ -424,6 +503,7 @@ void AirportOperationSystem::apply_collision_avoidance_maneuver(int aircraft_id,
         return;
     }
 
+    // A refused maneuver is resolved again by the next collision pass
     switch (maneuver.maneuver_type) {
         case AvoidanceManeuver::ManeuverType::TurnLeft:
         case AvoidanceManeuver::ManeuverType::TurnRight:
@@ -1,36 +1,58 @@
 #include "../../include/airport_manager.h"
 #include "../../include/aicopilot_types.h"
+#include "../../include/io_executor.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <utility>
 
 namespace AICopilot {
 namespace Integration {
 
+namespace {
+
+std::string layout_key(const std::string& icao_code) {
+    std::string key = icao_code;
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    return key;
+}
+
+} // namespace
+
 AirportManager::AirportManager()
     : provider_(nullptr)
     , elevation_feet_(0.0)
-    , controlled_(false) {
+    , controlled_(false)
+    , layout_(Airport::AirportLayoutData::empty())
+    , layout_cache_(DEFAULT_LAYOUT_CACHE_BYTES) {
 }
 
-AirportManager::AirportManager(std::shared_ptr<INavdataProvider> provider)
+AirportManager::AirportManager(std::shared_ptr<const INavdataProvider> provider)
     : provider_(std::move(provider))
     , elevation_feet_(0.0)
-    , controlled_(false) {
+    , controlled_(false)
+    , layout_(Airport::AirportLayoutData::empty())
+    , layout_cache_(DEFAULT_LAYOUT_CACHE_BYTES) {
 }
 
-void AirportManager::set_navdata_provider(std::shared_ptr<INavdataProvider> provider) {
+void AirportManager::set_navdata_provider(std::shared_ptr<const INavdataProvider> provider) {
     provider_ = std::move(provider);
+    // Layouts from the old provider do not describe the new one's airports
+    layout_cache_.clear();
+    pending_.clear();
 }
 
 bool AirportManager::initialize(const std::string& icao_code, const Airport::LatLonAlt& reference_point) {
     icao_code_ = icao_code;
     reference_point_ = reference_point;
     airport_.reset();
+    collect_prefetched();
 
-    if (provider_ && provider_->isReady()) {
-        load_from_navdata();
+    // load_from_navdata() builds the airport itself when it finds one
+    if (!load_from_navdata()) {
+        rebuild_airport();
     }
-
-    rebuild_airport();
     return airport_.has_value();
 }
 
@@ -52,48 +74,126 @@ bool AirportManager::load_from_navdata() {
         reference_point_ = Airport::LatLonAlt(info.position.latitude, info.position.longitude, info.elevation);
     }
 
+    if (auto layout = acquire_layout(icao_code_)) {
+        layout_ = std::move(layout);
+    }
+
     rebuild_airport();
     return true;
 }
 
+void AirportManager::prefetch(const std::vector<std::string>& icao_codes) {
+    if (!provider_ || !provider_->isReady()) {
+        return;
+    }
+
+    collect_prefetched();
+    for (const auto& icao_code : icao_codes) {
+        std::string key = layout_key(icao_code);
+        if (key.empty() || layout_cache_.contains(key) || pending_.count(key) != 0) {
+            continue;
+        }
+        // The task holds the provider, not this manager
+        std::shared_ptr<const INavdataProvider> provider = provider_;
+        pending_.emplace(key, IoExecutor::shared()->submit([provider, key]() {
+            return provider->getSharedAirportLayout(key);
+        }).share());
+    }
+}
+
+bool AirportManager::is_layout_ready(const std::string& icao_code) const {
+    std::string key = layout_key(icao_code);
+    if (layout_cache_.contains(key)) {
+        return true;
+    }
+    auto it = pending_.find(key);
+    return it != pending_.end() &&
+           it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+           it->second.get() != nullptr;
+}
+
+void AirportManager::set_layout_cache_budget(size_t bytes) {
+    layout_cache_.setByteBudget(bytes);
+}
+
+AirportManager::LayoutPtr AirportManager::acquire_layout(const std::string& icao_code) {
+    std::string key = layout_key(icao_code);
+    LayoutPtr layout = layout_cache_.find(key);
+    if (!layout) {
+        auto it = pending_.find(key);
+        if (it != pending_.end()) {
+            std::shared_future<LayoutPtr> fetch = std::move(it->second);
+            pending_.erase(it);
+            layout = fetch.get();
+        } else {
+            layout = provider_->getSharedAirportLayout(key);
+        }
+    }
+    if (layout) {
+        // Re-charged on every use: parts loaded since the last insert count now
+        layout_cache_.insert(key, layout, layout->get_memory_bytes());
+    }
+    return layout;
+}
+
+void AirportManager::collect_prefetched() {
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        if (LayoutPtr layout = it->second.get()) {
+            layout_cache_.insert(it->first, layout, layout->get_memory_bytes());
+        }
+        it = pending_.erase(it);
+    }
+}
+
 void AirportManager::set_name(const std::string& name) {
     name_ = name;
-    rebuild_airport();
 }
 
 void AirportManager::set_elevation(double elevation_feet) {
     elevation_feet_ = elevation_feet;
-    rebuild_airport();
+    if (airport_) {
+        airport_->set_elevation(elevation_feet);
+    }
 }
 
 void AirportManager::set_controlled(bool controlled) {
     controlled_ = controlled;
-    rebuild_airport();
+    if (airport_) {
+        airport_->set_controlled(controlled);
+    }
 }
 
 void AirportManager::set_runways(const std::vector<Airport::Runway>& runways) {
-    runways_ = runways;
-    rebuild_airport();
+    set_layout(layout_->with_runways(runways));
 }
 
 void AirportManager::add_runway(const Airport::Runway& runway) {
-    runways_.push_back(runway);
-    rebuild_airport();
+    std::vector<Airport::Runway> runways = layout_->get_runways();
+    runways.push_back(runway);
+    set_runways(runways);
 }
 
 void AirportManager::set_taxiway_network(const Airport::TaxiwayNetwork& network) {
-    taxiway_network_ = network;
-    rebuild_airport();
+    set_layout(layout_->with_taxiway_network(network));
 }
 
 void AirportManager::set_parking_positions(const std::vector<Airport::ParkingPosition>& parking_positions) {
-    parking_positions_ = parking_positions;
-    rebuild_airport();
+    set_layout(layout_->with_parking(parking_positions));
 }
 
 void AirportManager::set_procedures(const std::map<std::string, std::vector<Airport::SIDSTARProcedure>>& procedures) {
-    procedures_ = procedures;
-    rebuild_airport();
+    set_layout(layout_->with_procedures(procedures));
+}
+
+void AirportManager::set_layout(std::shared_ptr<const Airport::AirportLayoutData> layout) {
+    layout_ = layout ? std::move(layout) : Airport::AirportLayoutData::empty();
+    if (airport_) {
+        airport_->set_layout(layout_);
+    }
 }
 
 Airport::AirportMaster* AirportManager::get_airport() {
@@ -114,23 +214,7 @@ void AirportManager::rebuild_airport() {
     master.set_reference_point(reference_point_);
     master.set_elevation(elevation_feet_);
     master.set_controlled(controlled_);
-
-    for (const auto& runway : runways_) {
-        master.add_runway(runway);
-    }
-
-    auto& network = master.get_taxiway_network();
-    network = taxiway_network_;
-
-    for (const auto& parking : parking_positions_) {
-        master.add_parking(parking);
-    }
-
-    for (const auto& [runway_ident, proc_list] : procedures_) {
-        for (const auto& proc : proc_list) {
-            master.add_procedure(proc);
-        }
-    }
+    master.set_layout(layout_);
 
     airport_ = std::move(master);
 }
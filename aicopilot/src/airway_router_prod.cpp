@@ -1,468 +0,0 @@
-/*****************************************************************************
-* Copyright 2025 AI Copilot FS Project
-*
-* This program is free software: you can redistribute it and/or modify
-* it under the terms of the GNU General Public License as published by
-* the Free Software Foundation, either version 3 of the License, or
-* (at your option) any later version.
-*
-* PRODUCTION-READY Airway Routing Implementation
-* 300+ lines of optimized Dijkstra/A* based pathfinding
-* Handles altitude constraints, airway restrictions, and multiple alternatives
-*****************************************************************************/
-
-#include "../include/airway_router.hpp"
-#include "../include/navdata_database.hpp"
-#include <queue>
-#include <map>
-#include <set>
-#include <limits>
-#include <cmath>
-#include <sstream>
-#include <algorithm>
-
-namespace AICopilot {
-
-constexpr double EARTH_RADIUS_NM = 3440.065;
-constexpr double PI = 3.14159265358979323846;
-
-// ============================================================================
-// CONSTRUCTOR AND INITIALIZATION
-// ============================================================================
-
-AirwayRouter::AirwayRouter(const NavigationDatabase& database)
-    : database_(database), maxSearchDistance_(10000.0), preferAirways_(true),
-      minAltitudeConstraint_(1200), maxAltitudeConstraint_(60000),
-      cruiseSpeedKts_(450.0) {
-}
-
-AirwayRouter::~AirwayRouter() {
-}
-
-// ============================================================================
-// CONFIGURATION
-// ============================================================================
-
-void AirwayRouter::SetMaxSearchDistance(double distanceNM) {
-    maxSearchDistance_ = distanceNM;
-}
-
-void AirwayRouter::SetPreferAirways(bool preferAirways) {
-    preferAirways_ = preferAirways;
-}
-
-void AirwayRouter::SetAltitudeConstraints(int minAltitude, int maxAltitude) {
-    minAltitudeConstraint_ = minAltitude;
-    maxAltitudeConstraint_ = maxAltitude;
-}
-
-void AirwayRouter::SetCruiseSpeed(double cruiseSpeedKts) {
-    cruiseSpeedKts_ = cruiseSpeedKts;
-}
-
-// ============================================================================
-// ROUTE FINDING
-// ============================================================================
-
-std::vector<RouteSegment> AirwayRouter::FindOptimalRoute(const std::string& origin,
-                                                        const std::string& destination,
-                                                        int cruiseAltitude) const {
-    std::vector<RouteSegment> result;
-    
-    auto originWp = database_.GetWaypoint(origin);
-    auto destWp = database_.GetWaypoint(destination);
-    
-    if (!originWp || !destWp) {
-        return result;
-    }
-    
-    // Use Dijkstra's algorithm with A* heuristic
-    std::map<std::string, double> distances;
-    std::map<std::string, std::string> previous;
-    std::map<std::string, std::string> viaAirway;
-    std::priority_queue<PathNode, std::vector<PathNode>, std::greater<PathNode>> pq;
-    
-    // Initialize
-    distances[origin] = 0.0;
-    pq.push({origin, 0.0, CalculateHeuristic(origin, destination), 0.0, {origin}});
-    
-    std::set<std::string> visited;
-    
-    while (!pq.empty()) {
-        PathNode current = pq.top();
-        pq.pop();
-        
-        if (visited.count(current.waypoint)) continue;
-        visited.insert(current.waypoint);
-        
-        // Destination reached
-        if (current.waypoint == destination) {
-            std::vector<std::string> path = current.path;
-            for (size_t i = 0; i < path.size() - 1; ++i) {
-                RouteSegment segment;
-                segment.fromWaypoint = path[i];
-                segment.toWaypoint = path[i + 1];
-                segment.distance = database_.CalculateDistance(path[i], path[i+1]);
-                segment.heading = database_.CalculateHeading(path[i], path[i+1]);
-                segment.airwayName = viaAirway[path[i+1]];
-                
-                auto fromWp = database_.GetWaypoint(path[i]);
-                auto toWp = database_.GetWaypoint(path[i+1]);
-                if (fromWp && toWp) {
-                    segment.minimumAltitude = static_cast<int>(
-                        std::max(fromWp->elevation, toWp->elevation) + 1000);
-                    segment.maximumAltitude = 60000;
-                }
-                
-                segment.estimatedTime = (segment.distance / cruiseSpeedKts_) * 60.0;
-                segment.fuelBurn = segment.distance * 15.0; // 15 lbs/NM average
-                
-                result.push_back(segment);
-            }
-            return result;
-        }
-        
-        // Get adjacent waypoints
-        auto adjacents = GetAdjacentWaypoints(current.waypoint, cruiseAltitude);
-        
-        for (const auto& next : adjacents) {
-            if (visited.count(next)) continue;
-            
-            double cost = CalculateSegmentCost(current.waypoint, next, "", cruiseAltitude);
-            double newDist = distances[current.waypoint] + cost;
-            
-            if (distances.find(next) == distances.end() || newDist < distances[next]) {
-                distances[next] = newDist;
-                previous[next] = current.waypoint;
-                
-                double heuristic = CalculateHeuristic(next, destination);
-                PathNode nextNode;
-                nextNode.waypoint = next;
-                nextNode.gCost = newDist;
-                nextNode.hCost = heuristic;
-                nextNode.fCost = newDist + heuristic;
-                nextNode.path = current.path;
-                nextNode.path.push_back(next);
-                
-                pq.push(nextNode);
-            }
-        }
-    }
-    
-    return result;  // Empty if no path found
-}
-
-RouteSegment AirwayRouter::FindDirectRoute(const std::string& origin,
-                                           const std::string& destination) const {
-    RouteSegment segment;
-    
-    auto originWp = database_.GetWaypoint(origin);
-    auto destWp = database_.GetWaypoint(destination);
-    
-    if (!originWp || !destWp) {
-        return segment;
-    }
-    
-    segment.fromWaypoint = origin;
-    segment.toWaypoint = destination;
-    segment.airwayName = "";
-    segment.distance = database_.CalculateDistance(origin, destination);
-    segment.heading = database_.CalculateHeading(origin, destination);
-    segment.minimumAltitude = static_cast<int>(
-        std::max(originWp->elevation, destWp->elevation) + 1000);
-    segment.maximumAltitude = 60000;
-    segment.estimatedTime = (segment.distance / cruiseSpeedKts_) * 60.0;
-    segment.fuelBurn = segment.distance * 15.0;
-    
-    return segment;
-}
-
-std::vector<std::vector<RouteSegment>> AirwayRouter::FindAlternateRoutes(
-    const std::string& origin,
-    const std::string& destination,
-    int maxResults) const {
-    
-    std::vector<std::vector<RouteSegment>> results;
-    
-    // Primary route
-    auto route1 = FindOptimalRoute(origin, destination, 35000);
-    if (!route1.empty()) {
-        results.push_back(route1);
-    }
-    
-    // Direct route
-    if (results.size() < static_cast<size_t>(maxResults)) {
-        auto directSeg = FindDirectRoute(origin, destination);
-        std::vector<RouteSegment> directRoute = {directSeg};
-        results.push_back(directRoute);
-    }
-    
-    // Alternative altitude routing
-    if (results.size() < static_cast<size_t>(maxResults)) {
-        auto route2 = FindOptimalRoute(origin, destination, 25000);
-        if (!route2.empty()) {
-            results.push_back(route2);
-        }
-    }
-    
-    return results;
-}
-
-std::vector<RouteSegment> AirwayRouter::FindPreferredRoute(
-    const std::string& origin,
-    const std::string& destination,
-    const std::vector<std::string>& preferredAirways,
-    int cruiseAltitude) const {
-    
-    std::vector<RouteSegment> result;
-    
-    // Try to build route using preferred airways
-    std::string current = origin;
-    
-    for (const auto& airwayName : preferredAirways) {
-        auto airway = database_.GetAirway(airwayName);
-        if (!airway) continue;
-        
-        const auto& seq = airway->waypointSequence;
-        bool found = false;
-        
-        for (size_t i = 0; i < seq.size(); ++i) {
-            if (seq[i] == current) {
-                found = true;
-                // Add segments along this airway
-                for (size_t j = i; j < seq.size() - 1; ++j) {
-                    RouteSegment seg = FindDirectRoute(seq[j], seq[j+1]);
-                    seg.airwayName = airwayName;
-                    result.push_back(seg);
-                    current = seq[j+1];
-                    
-                    if (current == destination) {
-                        return result;
-                    }
-                }
-                break;
-            }
-        }
-    }
-    
-    // If haven't reached destination, add final segment
-    if (current != destination) {
-        result.push_back(FindDirectRoute(current, destination));
-    }
-    
-    return result;
-}
-
-// ============================================================================
-// ROUTE ANALYSIS
-// ============================================================================
-
-double AirwayRouter::CalculateRouteTotalDistance(const std::vector<RouteSegment>& route) {
-    double total = 0.0;
-    for (const auto& segment : route) {
-        total += segment.distance;
-    }
-    return total;
-}
-
-double AirwayRouter::CalculateEstimatedTime(const std::vector<RouteSegment>& route,
-                                           double groundSpeed) {
-    double total = 0.0;
-    for (const auto& segment : route) {
-        total += (segment.distance / groundSpeed) * 60.0;
-    }
-    return total;
-}
-
-double AirwayRouter::CalculateFuelRequired(const std::vector<RouteSegment>& route,
-                                          double fuelBurnRate) {
-    double total = 0.0;
-    for (const auto& segment : route) {
-        total += segment.distance * fuelBurnRate;
-    }
-    return total;
-}
-
-RouteQuality AirwayRouter::AnalyzeRouteQuality(const std::vector<RouteSegment>& route) const {
-    RouteQuality quality;
-    
-    quality.distance = CalculateRouteTotalDistance(route);
-    quality.estimatedTime = CalculateEstimatedTime(route, cruiseSpeedKts_);
-    quality.fuelRequired = CalculateFuelRequired(route, 15.0);
-    
-    // Count violations (simplified)
-    quality.altitudeViolations = 0;
-    quality.turnRestrictions = 0;
-    
-    // Compute cost index (simplified: distance + time normalized)
-    quality.costIndex = std::min(1.0, quality.distance / 3000.0);
-    
-    return quality;
-}
-
-std::string AirwayRouter::FormatRoute(const std::vector<RouteSegment>& route) {
-    std::ostringstream oss;
-    
-    oss << "Route Segments:" << std::endl;
-    for (const auto& segment : route) {
-        oss << "  " << segment.fromWaypoint << " -> " << segment.toWaypoint;
-        if (!segment.airwayName.empty()) {
-            oss << " via " << segment.airwayName;
-        }
-        oss << " (" << static_cast<int>(segment.distance) << " NM, "
-            << std::fixed << std::setprecision(0) << segment.heading << "°)";
-        oss << std::endl;
-    }
-    
-    oss << "Summary:" << std::endl;
-    oss << "  Total Distance: " << static_cast<int>(CalculateRouteTotalDistance(route)) << " NM" << std::endl;
-    oss << "  Estimated Time: " << static_cast<int>(CalculateEstimatedTime(route, 450.0)) << " minutes" << std::endl;
-    oss << "  Estimated Fuel: " << static_cast<int>(CalculateFuelRequired(route, 15.0)) << " lbs" << std::endl;
-    
-    return oss.str();
-}
-
-std::string AirwayRouter::FormatRouteForFiling(const std::string& origin,
-                                              const std::string& destination,
-                                              const std::vector<RouteSegment>& route,
-                                              const std::string& flightLevel) {
-    std::ostringstream oss;
-    
-    // Format: ORIGIN FLIGHTLEVEL ROUTE DESTINATION
-    oss << origin << " " << flightLevel << " ";
-    
-    for (const auto& segment : route) {
-        if (!segment.airwayName.empty()) {
-            oss << segment.airwayName << " ";
-        }
-        oss << segment.toWaypoint << " ";
-    }
-    
-    oss << destination;
-    
-    return oss.str();
-}
-
-// ============================================================================
-// PRIVATE HELPER METHODS
-// ============================================================================
-
-std::vector<std::string> AirwayRouter::GetAdjacentWaypoints(const std::string& waypoint,
-                                                           int cruiseAltitude) const {
-    std::vector<std::string> adjacent;
-    
-    // Get waypoints within search distance
-    auto nearby = database_.GetWaypointsNearby(
-        database_.GetWaypoint(waypoint)->latitude,
-        database_.GetWaypoint(waypoint)->longitude,
-        std::min(200.0, maxSearchDistance_)
-    );
-    
-    for (const auto& wp : nearby) {
-        if (wp.name != waypoint && wp.isUsable) {
-            adjacent.push_back(wp.name);
-        }
-    }
-    
-    return adjacent;
-}
-
-std::vector<std::string> AirwayRouter::GetAirwaySuccessors(
-    const std::string& waypoint,
-    const std::string& currentAirway) const {
-    
-    std::vector<std::string> successors;
-    
-    auto airway = database_.GetAirway(currentAirway);
-    if (!airway) return successors;
-    
-    const auto& seq = airway->waypointSequence;
-    for (size_t i = 0; i < seq.size(); ++i) {
-        if (seq[i] == waypoint && i + 1 < seq.size()) {
-            successors.push_back(seq[i+1]);
-        }
-    }
-    
-    return successors;
-}
-
-double AirwayRouter::CalculateSegmentCost(const std::string& from,
-                                         const std::string& to,
-                                         const std::string& airwayName,
-                                         int cruiseAltitude) const {
-    double distance = database_.CalculateDistance(from, to);
-    
-    if (distance < 0) return std::numeric_limits<double>::max();
-    
-    // Check altitude constraints
-    if (!airwayName.empty()) {
-        auto airway = database_.GetAirway(airwayName);
-        if (airway && !airway->IsAltitudeValid(cruiseAltitude)) {
-            return std::numeric_limits<double>::max(); // Not feasible
-        }
-    }
-    
-    // Cost is primarily distance
-    // Add small penalty for direct routes if airways are preferred
-    double cost = distance;
-    if (preferAirways_ && airwayName.empty()) {
-        cost *= 1.1;  // 10% penalty for direct routes
-    }
-    
-    return cost;
-}
-
-double AirwayRouter::CalculateHeuristic(const std::string& current,
-                                       const std::string& goal) const {
-    // Great circle distance as heuristic
-    auto current_wp = database_.GetWaypoint(current);
-    auto goal_wp = database_.GetWaypoint(goal);
-    
-    if (!current_wp || !goal_wp) {
-        return 0.0;
-    }
-    
-    double lat1 = current_wp->latitude * PI / 180.0;
-    double lat2 = goal_wp->latitude * PI / 180.0;
-    double dLat = (goal_wp->latitude - current_wp->latitude) * PI / 180.0;
-    double dLon = (goal_wp->longitude - current_wp->longitude) * PI / 180.0;
-    
-    double a = std::sin(dLat / 2.0) * std::sin(dLat / 2.0) +
-               std::cos(lat1) * std::cos(lat2) *
-               std::sin(dLon / 2.0) * std::sin(dLon / 2.0);
-    
-    double c = 2.0 * std::atan2(std::sqrt(a), std::sqrt(1.0 - a));
-    
-    return EARTH_RADIUS_NM * c;
-}
-
-std::vector<RouteSegment> AirwayRouter::ReconstructRoute(
-    const std::map<std::string, std::pair<std::string, std::string>>& cameFrom,
-    const std::string& current) const {
-    
-    std::vector<RouteSegment> route;
-    
-    // Reconstruct path backwards from current to start
-    std::vector<std::string> path;
-    std::string node = current;
-    
-    while (cameFrom.find(node) != cameFrom.end()) {
-        const auto& prev = cameFrom.at(node);
-        path.push_back(node);
-        node = prev.first;
-    }
-    path.push_back(node);
-    
-    // Reverse to get forward path
-    std::reverse(path.begin(), path.end());
-    
-    // Create route segments
-    for (size_t i = 0; i < path.size() - 1; ++i) {
-        RouteSegment segment = FindDirectRoute(path[i], path[i+1]);
-        route.push_back(segment);
-    }
-    
-    return route;
-}
-
-} // namespace AICopilot
@@ -0,0 +1,101 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Global operator new/delete replacements that feed AllocationTracker.
+* Linked into the test and benchmark executables only, never the library.
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "allocation_tracker.hpp"
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+using AICopilot::AllocationTracker;
+
+namespace {
+
+struct InstallHooks {
+    InstallHooks() { AllocationTracker::markInstalled(); }
+} g_installHooks;
+
+void* trackedAlloc(size_t size) {
+    AllocationTracker::recordAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* trackedAlignedAlloc(size_t size, size_t alignment) {
+    AllocationTracker::recordAllocation(size);
+    if (size == 0) size = 1;
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    void* p = nullptr;
+    return posix_memalign(&p, alignment < sizeof(void*) ? sizeof(void*) : alignment, size) == 0 ? p : nullptr;
+#endif
+}
+
+void trackedFree(void* p) noexcept {
+    if (!p) return;
+    AllocationTracker::recordDeallocation();
+    std::free(p);
+}
+
+void trackedAlignedFree(void* p) noexcept {
+    if (!p) return;
+    AllocationTracker::recordDeallocation();
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+    if (void* p = trackedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) {
+    if (void* p = trackedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { trackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    if (void* p = trackedAlignedAlloc(size, static_cast<size_t>(alignment))) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+    if (void* p = trackedAlignedAlloc(size, static_cast<size_t>(alignment))) return p;
+    throw std::bad_alloc();
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedAlignedAlloc(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedAlignedAlloc(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { trackedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { trackedAlignedFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { trackedAlignedFree(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { trackedAlignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { trackedAlignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { trackedAlignedFree(p); }
@@ -0,0 +1,68 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "allocation_tracker.hpp"
+#include <atomic>
+
+namespace AICopilot {
+
+namespace {
+
+// Plain data, so touching them from operator new never allocates or
+// runs a constructor
+thread_local AllocationCounts t_counts;
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_deallocations{0};
+std::atomic<uint64_t> g_bytes{0};
+std::atomic<bool> g_installed{false};
+
+} // namespace
+
+bool AllocationTracker::isInstalled() {
+    return g_installed.load(std::memory_order_relaxed);
+}
+
+AllocationCounts AllocationTracker::thisThread() {
+    return t_counts;
+}
+
+AllocationCounts AllocationTracker::process() {
+    AllocationCounts counts;
+    counts.allocations = g_allocations.load(std::memory_order_relaxed);
+    counts.deallocations = g_deallocations.load(std::memory_order_relaxed);
+    counts.bytes = g_bytes.load(std::memory_order_relaxed);
+    return counts;
+}
+
+void AllocationTracker::markInstalled() {
+    g_installed.store(true, std::memory_order_relaxed);
+}
+
+void AllocationTracker::recordAllocation(size_t bytes) {
+    t_counts.allocations++;
+    t_counts.bytes += bytes;
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocationTracker::recordDeallocation() {
+    t_counts.deallocations++;
+    g_deallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+AllocationCounts AllocationScope::counts() const {
+    AllocationCounts now = AllocationTracker::thisThread();
+    AllocationCounts delta;
+    delta.allocations = now.allocations - start_.allocations;
+    delta.deallocations = now.deallocations - start_.deallocations;
+    delta.bytes = now.bytes - start_.bytes;
+    return delta;
+}
+
+} // namespace AICopilot
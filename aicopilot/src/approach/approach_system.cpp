@@ -3,18 +3,29 @@
 *****************************************************************************/
 
 #include "approach_system.h"
+#include "geodesy.hpp"
 #include <cmath>
 #include <algorithm>
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
 namespace AICopilot {
 
+namespace {
+    constexpr double FEET_PER_NAUTICAL_MILE = 6076.0;
+    constexpr double NM_PER_DEGREE = Geodesy::DEG_TO_RAD * Geodesy::EARTH_RADIUS_NM;
+
+    // Keeps the localizer angle finite over the threshold
+    constexpr double MIN_LOCALIZER_DISTANCE = 0.1;  // nautical miles
+
+    bool isSet(const Position& pos) {
+        return pos.latitude != 0.0 || pos.longitude != 0.0;
+    }
+}
+
 bool ApproachSystem::loadApproach(const ApproachProcedure& approach) {
     currentApproach_ = approach;
     activeWaypointIndex_ = 0;
+    status_ = ApproachStatus{};
+    buildGeometry();
     return true;
 }
 
@@ -30,18 +41,22 @@ void ApproachSystem::deactivateApproach() {
 ApproachStatus ApproachSystem::updateApproachStatus(const AircraftState& state) {
     if (!approachActive_) return status_;
     
-    updatePhase(state.position);
+    FramePoint point = toFrame(state.position);
+    if (currentApproach_.type != ApproachType::ILS) {
+        sequenceWaypoints(point);
+    }
+    double distance = distanceToThreshold(point);
+    updatePhase(distance);
     
     if (currentApproach_.type == ApproachType::ILS) {
-        calculateILSDeviation(state.position, state.heading,
-                            status_.localizerDeviation,
-                            status_.glideslopeDeviation);
+        status_.localizerDeviation = calculateLocalizerDeviation(point, distance);
+        status_.glideslopeDeviation = calculateGlideslopeDeviation(distance, state.position.altitude);
         status_.localizerCaptured = std::abs(status_.localizerDeviation) < 0.5;
         status_.glideslopeCaptured = std::abs(status_.glideslopeDeviation) < 0.5;
     }
     
-    status_.distanceToThreshold = getDistanceToThreshold(state.position);
-    status_.heightAboveThreshold = getHeightAboveThreshold(state.position, state.position.altitude);
+    status_.distanceToThreshold = distance;
+    status_.heightAboveThreshold = state.position.altitude - geometry_.thresholdAltitude;
     status_.onGlidepath = std::abs(status_.glideslopeDeviation) < MAX_GLIDESLOPE_DEVIATION;
     status_.stabilized = isStabilized(state);
     
@@ -68,23 +83,39 @@ bool ApproachSystem::isStabilized(const AircraftState& state) const {
 
 void ApproachSystem::calculateILSDeviation(
     const Position& pos,
-    double heading,
+    double /*heading*/,
     double& localizerDeviation,
     double& glideslopeDeviation) const {
     
-    localizerDeviation = calculateLocalizerDeviation(pos, heading);
-    glideslopeDeviation = calculateGlideslopeDeviation(pos, pos.altitude);
+    FramePoint point = toFrame(pos);
+    double distance = distanceToThreshold(point);
+    localizerDeviation = calculateLocalizerDeviation(point, distance);
+    glideslopeDeviation = calculateGlideslopeDeviation(distance, pos.altitude);
 }
 
 ApproachSystem::RNAVGuidance ApproachSystem::calculateRNAVGuidance(const Position& pos) const {
-    RNAVGuidance guidance;
+    RNAVGuidance guidance{};
     
     if (activeWaypointIndex_ < currentApproach_.waypoints.size()) {
-        auto waypoint = currentApproach_.waypoints[activeWaypointIndex_];
+        const RNAVWaypoint& waypoint = currentApproach_.waypoints[activeWaypointIndex_];
+        const ApproachGeometry::Leg& leg = geometry_.legs[activeWaypointIndex_];
+        FramePoint point = toFrame(pos);
+        
         guidance.targetAltitude = waypoint.altitude;
         guidance.targetSpeed = waypoint.speed;
-        guidance.crossTrackError = 0.0;  // Simplified
-        guidance.verticalDeviation = pos.altitude - waypoint.altitude;
+        if (leg.length > 0.0) {
+            double dEast = point.east - leg.startEast;
+            double dNorth = point.north - leg.startNorth;
+            guidance.targetHeading = leg.course;
+            guidance.crossTrackError = dEast * leg.unitNorth - dNorth * leg.unitEast;
+            double along = dEast * leg.unitEast + dNorth * leg.unitNorth;
+            guidance.verticalDeviation = pos.altitude - (leg.startAltitude + leg.gradient * along);
+        } else {
+            // Direct to the first waypoint: no course to be off
+            guidance.targetHeading = std::fmod(std::atan2(leg.endEast - point.east, leg.endNorth - point.north) *
+                                               Geodesy::RAD_TO_DEG + 360.0, 360.0);
+            guidance.verticalDeviation = pos.altitude - waypoint.altitude;
+        }
     }
     
     return guidance;
@@ -98,7 +129,7 @@ RNAVWaypoint ApproachSystem::getNextWaypoint() const {
 }
 
 void ApproachSystem::advanceWaypoint() {
-    if (activeWaypointIndex_ < currentApproach_.waypoints.size() - 1) {
+    if (activeWaypointIndex_ + 1 < currentApproach_.waypoints.size()) {
         activeWaypointIndex_++;
     }
 }
@@ -108,30 +139,143 @@ void ApproachSystem::executeMissedApproach() {
 }
 
 bool ApproachSystem::shouldExecuteMissedApproach(const AircraftState& state) const {
-    if (!isStabilized(state) && status_.heightAboveThreshold < 1000.0) {
-        return true;
+    if (isStabilized(state)) return false;
+    if (status_.heightAboveThreshold < 1000.0) return true;
+    
+    // Passing the missed approach point unstabilized
+    return geometry_.hasMissedApproachPoint &&
+           status_.distanceToThreshold < geometry_.missedApproachDistance;
+}
+
+double ApproachSystem::calculateVerticalPath(const Position& pos) const {
+    FramePoint point = toFrame(pos);
+    if (currentApproach_.type == ApproachType::ILS || geometry_.legs.empty()) {
+        return geometry_.thresholdAltitude + geometry_.glidepathGradient * distanceToThreshold(point);
     }
-    return false;
+    
+    const ApproachGeometry::Leg& leg = geometry_.legs[activeWaypointIndex_];
+    return leg.startAltitude + leg.gradient * alongTrack(activeWaypointIndex_, point);
 }
 
 double ApproachSystem::getDistanceToThreshold(const Position& pos) const {
-    // Simplified distance calculation
-    return 5.0;  // nautical miles
+    return distanceToThreshold(toFrame(pos));
 }
 
 double ApproachSystem::getHeightAboveThreshold(const Position& pos, double altitude) const {
-    return altitude - currentApproach_.ilsData.thresholdPosition.altitude;
+    return altitude - geometry_.thresholdAltitude;
 }
 
 // Private methods
 
-namespace {
-    constexpr double FEET_PER_NAUTICAL_MILE = 6076.0;
+void ApproachSystem::buildGeometry() {
+    geometry_ = ApproachGeometry{};
+    const auto& waypoints = currentApproach_.waypoints;
+    const ILSData& ils = currentApproach_.ilsData;
+    
+    // The ILS threshold, or the last waypoint of a procedure without one
+    Position threshold = ils.thresholdPosition;
+    if (currentApproach_.type != ApproachType::ILS && !waypoints.empty() && !isSet(threshold)) {
+        threshold = waypoints.back().position;
+        threshold.altitude = waypoints.back().altitude;
+    }
+    geometry_.originLatitude = threshold.latitude;
+    geometry_.originLongitude = threshold.longitude;
+    geometry_.eastPerDegree = NM_PER_DEGREE * std::cos(threshold.latitude * Geodesy::DEG_TO_RAD);
+    geometry_.thresholdAltitude = threshold.altitude;
+    
+    double course = ils.localizerCourse * Geodesy::DEG_TO_RAD;
+    geometry_.courseEast = std::sin(course);
+    geometry_.courseNorth = std::cos(course);
+    geometry_.glidepathGradient = std::tan(ils.glideslopeAngle * Geodesy::DEG_TO_RAD) * FEET_PER_NAUTICAL_MILE;
+    
+    geometry_.legs.resize(waypoints.size());
+    for (size_t i = 0; i < waypoints.size(); ++i) {
+        ApproachGeometry::Leg& leg = geometry_.legs[i];
+        FramePoint end = toFrame(waypoints[i].position);
+        leg.endEast = end.east;
+        leg.endNorth = end.north;
+        leg.startEast = end.east;
+        leg.startNorth = end.north;
+        leg.startAltitude = waypoints[i].altitude;
+        if (i == 0) continue;
+        
+        const ApproachGeometry::Leg& previous = geometry_.legs[i - 1];
+        leg.startEast = previous.endEast;
+        leg.startNorth = previous.endNorth;
+        leg.startAltitude = waypoints[i - 1].altitude;
+        double dEast = leg.endEast - leg.startEast;
+        double dNorth = leg.endNorth - leg.startNorth;
+        leg.length = std::sqrt(dEast * dEast + dNorth * dNorth);
+        if (leg.length > 0.0) {
+            leg.unitEast = dEast / leg.length;
+            leg.unitNorth = dNorth / leg.length;
+            leg.course = std::fmod(std::atan2(dEast, dNorth) * Geodesy::RAD_TO_DEG + 360.0, 360.0);
+            leg.gradient = (waypoints[i].altitude - leg.startAltitude) / leg.length;
+        }
+    }
+    
+    // Route distance left after each leg, summed back from the last waypoint
+    for (size_t i = waypoints.size(); i-- > 0;) {
+        ApproachGeometry::Leg& leg = geometry_.legs[i];
+        if (i + 1 == waypoints.size()) {
+            leg.distanceAfter = std::sqrt(leg.endEast * leg.endEast + leg.endNorth * leg.endNorth);
+        } else {
+            leg.distanceAfter = geometry_.legs[i + 1].distanceAfter + geometry_.legs[i + 1].length;
+        }
+    }
+    
+    for (size_t i = 0; i < waypoints.size(); ++i) {
+        if (waypoints[i].type == "MAP") {
+            geometry_.hasMissedApproachPoint = true;
+            geometry_.missedApproachDistance = geometry_.legs[i].distanceAfter;
+            return;
+        }
+    }
+    if (isSet(currentApproach_.missedApproachPoint)) {
+        FramePoint map = toFrame(currentApproach_.missedApproachPoint);
+        geometry_.hasMissedApproachPoint = true;
+        geometry_.missedApproachDistance = currentApproach_.type == ApproachType::ILS || waypoints.empty()
+            ? -(map.east * geometry_.courseEast + map.north * geometry_.courseNorth)
+            : std::sqrt(map.east * map.east + map.north * map.north);
+    }
+}
+
+ApproachSystem::FramePoint ApproachSystem::toFrame(const Position& pos) const {
+    double dLon = pos.longitude - geometry_.originLongitude;
+    dLon -= 360.0 * std::floor((dLon + 180.0) / 360.0);
+    return {dLon * geometry_.eastPerDegree, (pos.latitude - geometry_.originLatitude) * NM_PER_DEGREE};
 }
 
-void ApproachSystem::updatePhase(const Position& pos) {
-    double distance = getDistanceToThreshold(pos);
+double ApproachSystem::distanceToThreshold(const FramePoint& point) const {
+    // Straight in along the final approach course
+    if (currentApproach_.type == ApproachType::ILS || geometry_.legs.empty()) {
+        return -(point.east * geometry_.courseEast + point.north * geometry_.courseNorth);
+    }
     
+    const ApproachGeometry::Leg& leg = geometry_.legs[activeWaypointIndex_];
+    if (leg.length > 0.0) {
+        return leg.length - alongTrack(activeWaypointIndex_, point) + leg.distanceAfter;
+    }
+    double dEast = leg.endEast - point.east;
+    double dNorth = leg.endNorth - point.north;
+    return std::sqrt(dEast * dEast + dNorth * dNorth) + leg.distanceAfter;
+}
+
+double ApproachSystem::alongTrack(size_t leg, const FramePoint& point) const {
+    const ApproachGeometry::Leg& l = geometry_.legs[leg];
+    return (point.east - l.startEast) * l.unitEast + (point.north - l.startNorth) * l.unitNorth;
+}
+
+void ApproachSystem::sequenceWaypoints(const FramePoint& point) {
+    // A waypoint is passed once the aircraft is abeam it on the next leg
+    while (activeWaypointIndex_ + 1 < geometry_.legs.size() &&
+           geometry_.legs[activeWaypointIndex_ + 1].length > 0.0 &&
+           alongTrack(activeWaypointIndex_ + 1, point) >= 0.0) {
+        activeWaypointIndex_++;
+    }
+}
+
+void ApproachSystem::updatePhase(double distance) {
     if (distance > 10.0) {
         currentPhase_ = ApproachPhase::INITIAL;
     } else if (distance > 5.0) {
@@ -141,16 +285,16 @@ void ApproachSystem::updatePhase(const Position& pos) {
     }
 }
 
-double ApproachSystem::calculateLocalizerDeviation(const Position& pos, double heading) const {
-    double courseDiff = heading - currentApproach_.ilsData.localizerCourse;
-    return courseDiff / 2.5;  // Convert to dots
+double ApproachSystem::calculateLocalizerDeviation(const FramePoint& point, double distance) const {
+    // Small-angle offset from the course line through the threshold
+    double crossTrack = point.east * geometry_.courseNorth - point.north * geometry_.courseEast;
+    double angle = crossTrack / std::max(distance, MIN_LOCALIZER_DISTANCE) * Geodesy::RAD_TO_DEG;
+    return angle / LOCALIZER_DEGREES_PER_DOT;
 }
 
-double ApproachSystem::calculateGlideslopeDeviation(const Position& pos, double altitude) const {
-    double targetAltitude = currentApproach_.ilsData.thresholdPosition.altitude +
-                           getDistanceToThreshold(pos) * FEET_PER_NAUTICAL_MILE * std::tan(currentApproach_.ilsData.glideslopeAngle * M_PI / 180.0);
-    double deviation = (altitude - targetAltitude) / 100.0;
-    return deviation;
+double ApproachSystem::calculateGlideslopeDeviation(double distance, double altitude) const {
+    double targetAltitude = geometry_.thresholdAltitude + geometry_.glidepathGradient * distance;
+    return (altitude - targetAltitude) / GLIDESLOPE_FEET_PER_DOT;
 }
 
 } // namespace AICopilot
@@ -1,7 +1,7 @@
 /*****************************************************************************
 * Copyright 2025 AI Copilot FS Project
 *
-* Runway Database Implementation
+* Approach Runway Database Implementation
 *****************************************************************************/
 
 #include "../include/runway_database.hpp"
@@ -17,67 +17,111 @@
 
 namespace AICopilot {
 
-RunwayDatabase::RunwayDatabase() = default;
+namespace {
 
-RunwayDatabase::~RunwayDatabase() {
-    shutdown();
+const char* surfaceCode(SurfaceType surface) {
+    switch (surface) {
+        case SurfaceType::ASPHALT: return "ASPH";
+        case SurfaceType::CONCRETE: return "CONC";
+        case SurfaceType::GRASS: return "GRS";
+        case SurfaceType::GRAVEL: return "GRVL";
+        case SurfaceType::DIRT: return "DIRT";
+        case SurfaceType::WATER: return "WATER";
+        case SurfaceType::MACADAM: return "MAC";
+        case SurfaceType::BITUMINOUS: return "BIT";
+        case SurfaceType::BRICK: return "BRI";
+        case SurfaceType::ASPHALT_CONCRETE: return "ASPH-CONC";
+        default: return "";
+    }
 }
 
-bool RunwayDatabase::initialize(const std::string& csvFile) {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    runwayData_.clear();
-    
+SurfaceType surfaceFromCode(const std::string& code) {
+    if (code == "ASPH") return SurfaceType::ASPHALT;
+    if (code == "CONC") return SurfaceType::CONCRETE;
+    if (code == "GRS" || code == "TURF" || code == "GRASS") return SurfaceType::GRASS;
+    if (code == "GRVL") return SurfaceType::GRAVEL;
+    if (code == "DIRT") return SurfaceType::DIRT;
+    if (code == "WATER") return SurfaceType::WATER;
+    if (code == "MAC") return SurfaceType::MACADAM;
+    if (code == "BIT") return SurfaceType::BITUMINOUS;
+    if (code == "BRI") return SurfaceType::BRICK;
+    if (code == "ASPH-CONC") return SurfaceType::ASPHALT_CONCRETE;
+    return SurfaceType::UNKNOWN;
+}
+
+const char* categoryName(ILSCategory category) {
+    switch (category) {
+        case ILSCategory::CAT_I: return "CAT I";
+        case ILSCategory::CAT_II: return "CAT II";
+        case ILSCategory::CAT_IIIA: return "CAT IIIA";
+        case ILSCategory::CAT_IIIB: return "CAT IIIB";
+        case ILSCategory::CAT_IIIC: return "CAT IIIC";
+        default: return "";
+    }
+}
+
+// "CAT II" or just "II", as in the CSV files
+ILSCategory categoryFromName(std::string name) {
+    if (name.compare(0, 4, "CAT ") == 0) name.erase(0, 4);
+    if (name == "I") return ILSCategory::CAT_I;
+    if (name == "II") return ILSCategory::CAT_II;
+    if (name == "IIIA" || name == "III") return ILSCategory::CAT_IIIA;
+    if (name == "IIIB") return ILSCategory::CAT_IIIB;
+    if (name == "IIIC") return ILSCategory::CAT_IIIC;
+    return ILSCategory::NONE;
+}
+
+} // namespace
+
+ApproachRunwayDatabase::ApproachRunwayDatabase(std::shared_ptr<RunwayDatabase> store)
+    : store_(std::move(store)) {}
+
+ApproachRunwayDatabase::~ApproachRunwayDatabase() = default;
+
+bool ApproachRunwayDatabase::initialize(const std::string& csvFile) {
     if (!csvFile.empty()) {
         int loaded = loadFromCSV(csvFile);
-        std::cout << "RunwayDatabase: Loaded " << loaded << " runways from " << csvFile << std::endl;
+        std::cout << "ApproachRunwayDatabase: Loaded " << loaded << " runways from " << csvFile << std::endl;
         return loaded > 0;
     }
     
     return true;
 }
 
-void RunwayDatabase::shutdown() {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    runwayData_.clear();
+void ApproachRunwayDatabase::shutdown() {
+    // The shared store outlives its facades
 }
 
-bool RunwayDatabase::getRunway(const std::string& icao, const std::string& runwayId, 
-                              RunwayInfo& runway) {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    
-    RunwayKey key{icao, runwayId};
-    auto it = runwayData_.find(key);
-    
-    if (it != runwayData_.end()) {
-        runway = it->second;
+bool ApproachRunwayDatabase::getRunway(const std::string& icao, const std::string& runwayId, 
+                                      ApproachRunwayInfo& runway) {
+    RunwayInfo stored;
+    if (store_->GetRunwayInfo(icao, runwayId, stored)) {
+        runway = toApproach(stored);
         return true;
     }
     
     return false;
 }
 
-std::vector<RunwayInfo> RunwayDatabase::getAirportRunways(const std::string& icao) {
-    std::vector<RunwayInfo> runways;
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    
-    for (const auto& pair : runwayData_) {
-        if (pair.first.icao == icao) {
-            runways.push_back(pair.second);
-        }
+std::vector<ApproachRunwayInfo> ApproachRunwayDatabase::getAirportRunways(const std::string& icao) {
+    RunwaySpan stored = store_->GetRunways(icao);
+    std::vector<ApproachRunwayInfo> runways;
+    runways.reserve(stored.size());
+    for (const RunwayInfo& rwy : stored) {
+        runways.push_back(toApproach(rwy));
     }
-    
     return runways;
 }
 
-bool RunwayDatabase::selectRunwayForLanding(const std::string& icao,
+bool ApproachRunwayDatabase::selectRunwayForLanding(const std::string& icao,
                                           int windDirection, int windSpeed,
                                           int maxCrosswind,
-                                          RunwayInfo& runway) {
-    std::vector<RunwayInfo> runways = getAirportRunways(icao);
+                                          ApproachRunwayInfo& runway) {
+    std::vector<ApproachRunwayInfo> runways = getAirportRunways(icao);
     
     if (runways.empty()) return false;
     
-    RunwayInfo bestRunway = runways[0];
+    ApproachRunwayInfo bestRunway = runways[0];
     double bestCrosswind = std::abs(calculateCrosswind(
         runways[0].headingMagnetic, windDirection, windSpeed));
     
@@ -105,15 +149,15 @@ bool RunwayDatabase::selectRunwayForLanding(const std::string& icao,
     return true;
 }
 
-bool RunwayDatabase::selectRunwayForTakeoff(const std::string& icao,
+bool ApproachRunwayDatabase::selectRunwayForTakeoff(const std::string& icao,
                                           int windDirection, int windSpeed,
-                                          RunwayInfo& runway) {
-    std::vector<RunwayInfo> runways = getAirportRunways(icao);
+                                          ApproachRunwayInfo& runway) {
+    std::vector<ApproachRunwayInfo> runways = getAirportRunways(icao);
     
     if (runways.empty()) return false;
     
     // For takeoff, prefer strong headwind
-    RunwayInfo bestRunway = runways[0];
+    ApproachRunwayInfo bestRunway = runways[0];
     double bestHeadwind = calculateHeadwind(
         runways[0].headingMagnetic, windDirection, windSpeed);
     
@@ -131,9 +175,9 @@ bool RunwayDatabase::selectRunwayForTakeoff(const std::string& icao,
     return true;
 }
 
-bool RunwayDatabase::getILSData(const std::string& icao, const std::string& runwayId, 
-                               ILSData& ils) {
-    RunwayInfo runway;
+bool ApproachRunwayDatabase::getILSData(const std::string& icao, const std::string& runwayId, 
+                               ApproachILSData& ils) {
+    ApproachRunwayInfo runway;
     if (getRunway(icao, runwayId, runway)) {
         ils = runway.ilsData;
         return ils.hasILS;
@@ -142,7 +186,7 @@ bool RunwayDatabase::getILSData(const std::string& icao, const std::string& runw
     return false;
 }
 
-bool RunwayDatabase::isSuitableForLanding(const RunwayInfo& runway,
+bool ApproachRunwayDatabase::isSuitableForLanding(const ApproachRunwayInfo& runway,
                                         int aircraftLength,
                                         int requiredDistance) {
     // Check runway length
@@ -158,7 +202,7 @@ bool RunwayDatabase::isSuitableForLanding(const RunwayInfo& runway,
     return true;
 }
 
-bool RunwayDatabase::isSuitableForTakeoff(const RunwayInfo& runway,
+bool ApproachRunwayDatabase::isSuitableForTakeoff(const ApproachRunwayInfo& runway,
                                         int aircraftLength,
                                         int requiredDistance) {
     // Check runway length
@@ -174,14 +218,14 @@ bool RunwayDatabase::isSuitableForTakeoff(const RunwayInfo& runway,
     return true;
 }
 
-int RunwayDatabase::loadFromCSV(const std::string& filePath) {
+int ApproachRunwayDatabase::loadFromCSV(const std::string& filePath) {
     std::ifstream file(filePath);
     if (!file.is_open()) {
-        std::cerr << "RunwayDatabase: Cannot open file: " << filePath << std::endl;
+        std::cerr << "ApproachRunwayDatabase: Cannot open file: " << filePath << std::endl;
         return 0;
     }
     
-    int count = 0;
+    std::vector<RunwayInfo> rows;
     std::string line;
     
     // Skip header
@@ -205,25 +249,25 @@ int RunwayDatabase::loadFromCSV(const std::string& filePath) {
         
         try {
             RunwayInfo runway;
-            runway.icaoCode = fields[0];
+            runway.icao = fields[0];
             runway.runwayId = fields[1];
-            runway.thresholdPosition.latitude = std::stod(fields[2]);
-            runway.thresholdPosition.longitude = std::stod(fields[3]);
+            runway.latitude = std::stod(fields[2]);
+            runway.longitude = std::stod(fields[3]);
             runway.headingMagnetic = std::stoi(fields[4]);
+            runway.headingTrue = runway.headingMagnetic;
             runway.length = std::stoi(fields[5]);
             runway.width = std::stoi(fields[6]);
-            runway.surfaceType = fields[7];
+            runway.surface = surfaceFromCode(fields[7]);
             
             runway.ilsData.hasILS = (fields[8] == "1");
             if (runway.ilsData.hasILS) {
                 runway.ilsData.localizerFrequency = std::stod(fields[9]);
                 runway.ilsData.glideslopeFrequency = std::stod(fields[10]);
-                runway.ilsData.localizerCourse = std::stod(fields[11]);
+                runway.ilsData.localizerCourse = std::stoi(fields[11]);
                 runway.ilsData.glideslopeAngle = 3.0;  // Standard
                 runway.ilsData.decisionHeight = std::stoi(fields[12]);
-                runway.ilsData.category = fields[13];
+                runway.ilsData.category = categoryFromName(fields[13]);
                 runway.ilsData.minimumRVR = std::stoi(fields[14]);
-                runway.ilsData.thresholdPosition = runway.thresholdPosition;
             }
             
             runway.TODA = std::stoi(fields[15]);
@@ -231,51 +275,114 @@ int RunwayDatabase::loadFromCSV(const std::string& filePath) {
             runway.LDA = std::stoi(fields[17]);
             runway.ASDA = std::stoi(fields[18]);
             
-            // Set defaults for optional fields
-            runway.headingTrue = runway.headingMagnetic;
-            runway.displaceThreshold = false;
-            runway.displacedThresholdDistance = 0;
-            runway.hasVGSI = false;
-            runway.vgsiType = "";
-            runway.designCode = 0;
-            runway.friction = false;
-            runway.grooving = false;
-            runway.porous = false;
-            runway.hasALS = false;
-            runway.hasRWYLights = false;
-            runway.hasREIL = false;
-            
-            addRunway(runway);
-            count++;
+            rows.push_back(std::move(runway));
             
         } catch (const std::exception& e) {
-            std::cerr << "RunwayDatabase: Error parsing line: " << line << " (" << e.what() << ")" << std::endl;
+            std::cerr << "ApproachRunwayDatabase: Error parsing line: " << line << " (" << e.what() << ")" << std::endl;
         }
     }
     
     file.close();
-    return count;
+    
+    // One new version of the store for the whole file
+    store_->AddRunways(rows);
+    return static_cast<int>(rows.size());
+}
+
+void ApproachRunwayDatabase::addRunway(const ApproachRunwayInfo& runway) {
+    store_->AddRunway(fromApproach(runway));
+}
+
+int ApproachRunwayDatabase::getRunwayCount() const {
+    return store_->GetRunwayCount();
 }
 
-void RunwayDatabase::addRunway(const RunwayInfo& runway) {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    RunwayKey key{runway.icaoCode, runway.runwayId};
-    runwayData_[key] = runway;
+void ApproachRunwayDatabase::clear() {
+    store_->Clear();
 }
 
-int RunwayDatabase::getRunwayCount() const {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    return runwayData_.size();
+ApproachRunwayInfo ApproachRunwayDatabase::toApproach(const RunwayInfo& rwy) {
+    ApproachRunwayInfo runway{};
+    runway.icaoCode = rwy.icao;
+    runway.runwayId = rwy.runwayId;
+    runway.thresholdPosition.latitude = rwy.latitude;
+    runway.thresholdPosition.longitude = rwy.longitude;
+    runway.thresholdPosition.altitude = rwy.elevation;
+    runway.headingMagnetic = rwy.headingMagnetic;
+    runway.headingTrue = rwy.headingTrue;
+    runway.length = rwy.length;
+    runway.width = rwy.width;
+    runway.surfaceType = surfaceCode(rwy.surface);
+    
+    runway.ilsData.hasILS = rwy.ilsData.hasILS;
+    runway.ilsData.localizerFrequency = rwy.ilsData.localizerFrequency;
+    runway.ilsData.glideslopeFrequency = rwy.ilsData.glideslopeFrequency;
+    runway.ilsData.localizerCourse = rwy.ilsData.localizerCourse;
+    runway.ilsData.glideslopeAngle = rwy.ilsData.glideslopeAngle;
+    runway.ilsData.thresholdPosition = runway.thresholdPosition;
+    runway.ilsData.decisionHeight = rwy.ilsData.decisionHeight;
+    runway.ilsData.category = categoryName(rwy.ilsData.category);
+    runway.ilsData.minimumRVR = rwy.ilsData.minimumRVR;
+    
+    runway.hasVGSI = rwy.hasVGSI;
+    runway.vgsiType = rwy.vgsiType;
+    runway.designCode = 0;
+    runway.displaceThreshold = rwy.displaceThreshold;
+    runway.displacedThresholdDistance = rwy.displacedDistance;
+    runway.TODA = rwy.TODA;
+    runway.TORA = rwy.TORA;
+    runway.LDA = rwy.LDA;
+    runway.ASDA = rwy.ASDA;
+    runway.friction = false;
+    runway.grooving = rwy.grooved;
+    runway.porous = rwy.porous;
+    runway.hasALS = rwy.hasALS;
+    runway.hasRWYLights = rwy.hasRunwayLights;
+    runway.hasREIL = rwy.hasREIL;
+    return runway;
 }
 
-void RunwayDatabase::clear() {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    runwayData_.clear();
+RunwayInfo ApproachRunwayDatabase::fromApproach(const ApproachRunwayInfo& runway) {
+    RunwayInfo rwy;
+    rwy.icao = runway.icaoCode;
+    rwy.runwayId = runway.runwayId;
+    rwy.latitude = runway.thresholdPosition.latitude;
+    rwy.longitude = runway.thresholdPosition.longitude;
+    rwy.elevation = static_cast<int>(runway.thresholdPosition.altitude);
+    rwy.headingMagnetic = runway.headingMagnetic;
+    rwy.headingTrue = runway.headingTrue;
+    rwy.length = runway.length;
+    rwy.width = runway.width;
+    rwy.surface = surfaceFromCode(runway.surfaceType);
+    
+    rwy.ilsData.hasILS = runway.ilsData.hasILS;
+    rwy.ilsData.localizerFrequency = runway.ilsData.localizerFrequency;
+    rwy.ilsData.glideslopeFrequency = runway.ilsData.glideslopeFrequency;
+    rwy.ilsData.localizerCourse = static_cast<int>(runway.ilsData.localizerCourse);
+    rwy.ilsData.glideslopeAngle = runway.ilsData.glideslopeAngle;
+    rwy.ilsData.decisionHeight = runway.ilsData.decisionHeight;
+    rwy.ilsData.category = categoryFromName(runway.ilsData.category);
+    rwy.ilsData.minimumRVR = runway.ilsData.minimumRVR;
+    
+    rwy.hasVGSI = runway.hasVGSI;
+    rwy.vgsiType = runway.vgsiType;
+    rwy.displaceThreshold = runway.displaceThreshold;
+    rwy.displacedDistance = runway.displacedThresholdDistance;
+    rwy.TODA = runway.TODA;
+    rwy.TORA = runway.TORA;
+    rwy.LDA = runway.LDA;
+    rwy.ASDA = runway.ASDA;
+    rwy.grooved = runway.grooving;
+    rwy.porous = runway.porous;
+    rwy.hasALS = runway.hasALS;
+    rwy.hasRunwayLights = runway.hasRWYLights;
+    rwy.hasREIL = runway.hasREIL;
+    return rwy;
 }
 
 // Private helper methods
 
-double RunwayDatabase::calculateCrosswind(int runwayHeading, int windDirection, 
+double ApproachRunwayDatabase::calculateCrosswind(int runwayHeading, int windDirection, 
                                         int windSpeed) const {
     double headingRad = runwayHeading * M_PI / 180.0;
     double windDirRad = windDirection * M_PI / 180.0;
@@ -285,7 +392,7 @@ double RunwayDatabase::calculateCrosswind(int runwayHeading, int windDirection,
     return windSpeed * std::sin(diff);
 }
 
-double RunwayDatabase::calculateHeadwind(int runwayHeading, int windDirection,
+double ApproachRunwayDatabase::calculateHeadwind(int runwayHeading, int windDirection,
                                        int windSpeed) const {
     double headingRad = runwayHeading * M_PI / 180.0;
     double windDirRad = windDirection * M_PI / 180.0;
@@ -295,32 +402,4 @@ double RunwayDatabase::calculateHeadwind(int runwayHeading, int windDirection,
     return windSpeed * std::cos(diff);
 }
 
-std::string RunwayDatabase::getReciprocal(const std::string& runwayId) const {
-    // Parse runway heading from ID (e.g., "04L" -> 04, "22R" -> 22)
-    int heading = parseRunwayHeading(runwayId);
-    int reciprocal = (heading + 18) % 36;
-    
-    std::string recId;
-    if (reciprocal < 10) recId += "0";
-    recId += std::to_string(reciprocal);
-    
-    // Add suffix
-    if (runwayId.length() > 2) {
-        char suffix = runwayId[2];
-        if (suffix == 'L') recId += 'R';
-        else if (suffix == 'R') recId += 'L';
-        else if (suffix == 'C') recId += 'C';
-    }
-    
-    return recId;
-}
-
-int RunwayDatabase::parseRunwayHeading(const std::string& runwayId) const {
-    try {
-        return std::stoi(runwayId.substr(0, 2));
-    } catch (...) {
-        return 0;
-    }
-}
-
 } // namespace AICopilot
@@ -11,6 +11,7 @@
 #include "../include/airport_integration.hpp"
 #include "../include/atc_routing.hpp"
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <sstream>
 
@@ -35,25 +36,94 @@ ATCController::~ATCController() = default;
 
 void ATCController::update() {
     // Process queued messages
-    while (!messageQueue_.empty()) {
-        ATCMessage msg = messageQueue_.front();
-        messageQueue_.pop();
+    std::queue<ATCMessage> pending;
+    {
+        std::lock_guard<std::mutex> lock(messageQueueMutex_);
+        pending.swap(messageQueue_);
+    }
+    
+    while (!pending.empty()) {
+        ATCMessage msg = std::move(pending.front());
+        pending.pop();
         
-        // Select best menu option
-        int selectedOption = selectBestMenuOption(msg);
+        if (msg.menuOptions.empty()) {
+            continue;
+        }
         
-        if (selectedOption >= 0) {
-            simConnect_->sendATCMenuSelection(selectedOption);
-            lastClearance_ = msg.menuOptions[selectedOption];
-            parseInstruction(lastClearance_);
-            waitingForResponse_ = false;
+        // Ask Ollama without waiting, unless it already answered this
+        // situation; menus behind one still pending queue up so selections
+        // go out in the order ATC offered them
+        PendingSelection entry;
+        entry.phase = getFlightPhaseString();
+        if (isOllamaEnabled()) {
+            auto cached = decisionCache_.lookup(entry.phase, msg.message, msg.menuOptions);
+            if (cached) {
+                entry.selection = std::make_shared<OllamaSelection>(std::chrono::steady_clock::now());
+                entry.selection->resolve(OllamaSelection::Status::COMPLETED, *cached);
+                entry.fromCache = true;
+            } else {
+                entry.selection = requestOllamaSelection(msg);
+            }
         }
+        entry.message = std::move(msg);
+        pendingSelections_.push_back(std::move(entry));
+    }
+    
+    resolvePendingSelections();
+}
+
+void ATCController::resolvePendingSelections() {
+    while (!pendingSelections_.empty()) {
+        PendingSelection& front = pendingSelections_.front();
+        int selectedOption = -1;
+        
+        if (front.selection) {
+            if (!front.selection->isDone()) {
+                if (!front.selection->isPastDeadline()) {
+                    return;
+                }
+                front.selection->cancel();
+                std::cout << "[ATC] Ollama missed its deadline, falling back to rule-based" << std::endl;
+            }
+            int ollamaChoice = front.selection->getOption();
+            if (ollamaChoice >= 0 && ollamaChoice < static_cast<int>(front.message.menuOptions.size())) {
+                std::cout << "[ATC] Ollama " << (front.fromCache ? "(cached) " : "")
+                         << "selected option " << ollamaChoice << ": " 
+                         << front.message.menuOptions[ollamaChoice] << std::endl;
+                selectedOption = ollamaChoice;
+                if (!front.fromCache) {
+                    decisionCache_.store(front.phase, front.message.message,
+                                         front.message.menuOptions, ollamaChoice);
+                }
+            } else if (front.selection->getStatus() != OllamaSelection::Status::CANCELLED) {
+                std::cout << "[ATC] Ollama failed to select, falling back to rule-based" << std::endl;
+            }
+        }
+        
+        if (selectedOption < 0) {
+            selectedOption = selectBestMenuOptionRuleBased(front.message);
+        }
+        sendMenuSelection(front.message, selectedOption);
+        pendingSelections_.pop_front();
+    }
+}
+
+void ATCController::sendMenuSelection(const ATCMessage& message, int option) {
+    if (option < 0) {
+        return;
     }
+    simConnect_->sendATCMenuSelection(option);
+    lastClearance_ = message.menuOptions[option];
+    parseInstruction(lastClearance_);
+    waitingForResponse_ = false;
 }
 
 void ATCController::processATCMessage(const ATCMessage& message) {
     std::cout << "ATC: " << message.message << std::endl;
-    messageQueue_.push(message);
+    {
+        std::lock_guard<std::mutex> lock(messageQueueMutex_);
+        messageQueue_.push(message);
+    }
     waitingForResponse_ = true;
 }
 
@@ -77,6 +147,21 @@ std::vector<std::string> ATCController::getPendingInstructions() const {
     return pendingInstructions_;
 }
 
+bool ATCController::restoreClearances(const ClearanceSnapshot& base, const ClearanceEvent* events,
+                                      size_t eventCount, const std::string& lastClearance,
+                                      std::vector<std::string> pendingInstructions) {
+    if (!clearanceLog_.restore(base, events, eventCount)) {
+        return false;
+    }
+    // New events continue the restored timeline
+    const ClearanceSnapshot& current = clearanceLog_.current();
+    clearanceLogStart_ = std::chrono::steady_clock::now() - std::chrono::milliseconds(current.timeMs);
+    lastGroundState_ = current.has(ClearanceEventType::GROUND_STATE) ? current.groundState : -1;
+    lastClearance_ = lastClearance;
+    pendingInstructions_ = std::move(pendingInstructions);
+    return true;
+}
+
 bool ATCController::isWaitingForATC() const {
     return waitingForResponse_;
 }
@@ -88,7 +173,8 @@ std::string ATCController::getLastClearance() const {
 void ATCController::enableOllama(bool enable, const std::string& host) {
     if (enable) {
         std::cout << "[ATC] Enabling Ollama AI assistance..." << std::endl;
-        if (ollamaClient_->connect(host)) {
+        bool connected = ollamaGateway_ ? ollamaGateway_->isAvailable() : ollamaClient_->connect(host);
+        if (connected) {
             ollamaEnabled_ = true;
             std::cout << "[ATC] Ollama AI enabled successfully" << std::endl;
         } else {
@@ -102,7 +188,16 @@ void ATCController::enableOllama(bool enable, const std::string& host) {
 }
 
 bool ATCController::isOllamaEnabled() const {
-    return ollamaEnabled_ && ollamaClient_->isAvailable();
+    if (!ollamaEnabled_) {
+        return false;
+    }
+    return ollamaGateway_ ? ollamaGateway_->isAvailable() : ollamaClient_->isAvailable();
+}
+
+void ATCController::setOllamaGateway(std::shared_ptr<OllamaGateway> gateway, uint32_t pilotId) {
+    ollamaGateway_ = std::move(gateway);
+    gatewayPilotId_ = pilotId;
+    ollamaEnabled_ = ollamaGateway_ != nullptr;
 }
 
 void ATCController::setOllamaModel(const std::string& model) {
@@ -133,40 +228,46 @@ std::string ATCController::getFlightPhaseString() const {
     }
 }
 
-int ATCController::selectBestMenuOption(const ATCMessage& message) {
-    if (message.menuOptions.empty()) {
-        return -1;
+std::shared_ptr<OllamaSelection> ATCController::requestOllamaSelection(const ATCMessage& message) {
+    std::cout << "[ATC] Using Ollama AI for menu selection" << std::endl;
+    
+    // Build context string
+    std::ostringstream context;
+    if (!flightPlan_.departure.empty() && !flightPlan_.arrival.empty()) {
+        context << "Flight plan: " << flightPlan_.departure 
+               << " to " << flightPlan_.arrival;
     }
     
-    // Try Ollama AI first if enabled
-    if (isOllamaEnabled()) {
-        std::cout << "[ATC] Using Ollama AI for menu selection" << std::endl;
-        
-        // Build context string
-        std::ostringstream context;
-        if (!flightPlan_.departure.empty() && !flightPlan_.arrival.empty()) {
-            context << "Flight plan: " << flightPlan_.departure 
-                   << " to " << flightPlan_.arrival;
-        }
-        
-        int ollamaChoice = ollamaClient_->selectATCMenuOption(
+    if (ollamaGateway_) {
+        return ollamaGateway_->submit(
+            gatewayPilotId_,
+            selectionPriority(message),
             message.message,
             message.menuOptions,
             getFlightPhaseString(),
-            context.str()
+            context.str(),
+            ollamaDeadline_
         );
-        
-        if (ollamaChoice >= 0 && ollamaChoice < static_cast<int>(message.menuOptions.size())) {
-            std::cout << "[ATC] Ollama selected option " << ollamaChoice << ": " 
-                     << message.menuOptions[ollamaChoice] << std::endl;
-            return ollamaChoice;
-        } else {
-            std::cout << "[ATC] Ollama failed to select, falling back to rule-based" << std::endl;
-        }
     }
     
-    // Fall back to rule-based selection
-    return selectBestMenuOptionRuleBased(message);
+    return ollamaClient_->selectATCMenuOptionAsync(
+        message.message,
+        message.menuOptions,
+        getFlightPhaseString(),
+        context.str(),
+        ollamaDeadline_
+    );
+}
+
+LLMPriority ATCController::selectionPriority(const ATCMessage& message) {
+    std::string text = message.message;
+    std::transform(text.begin(), text.end(), text.begin(), ::tolower);
+    if (text.find("mayday") != std::string::npos ||
+        text.find("emergency") != std::string::npos ||
+        text.find("pan pan") != std::string::npos) {
+        return LLMPriority::EMERGENCY;
+    }
+    return LLMPriority::ROUTINE;
 }
 
 int ATCController::selectBestMenuOptionRuleBased(const ATCMessage& message) {
@@ -193,72 +294,69 @@ int ATCController::selectBestMenuOptionRuleBased(const ATCMessage& message) {
     return bestOption;
 }
 
+ATCController::ParsedInstruction ATCController::analyzeInstruction(const std::string& instruction) {
+    return parseClearance(instruction);
+}
+
 void ATCController::parseInstruction(const std::string& instruction) {
-    // Parse common ATC instructions
-    std::string lower = instruction;
-    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
-    
     handleInstruction(instruction);
 
-    // Extract altitude instructions (with numeric values)
-    if (lower.find("climb") != std::string::npos || 
-        lower.find("descend") != std::string::npos ||
-        lower.find("maintain") != std::string::npos) {
-        
-        // Try to extract altitude number
-        std::string altitudeInstruction = "Altitude: " + instruction;
-        pendingInstructions_.push_back(altitudeInstruction);
+    // Assigned values come from one pass of the phraseology parser
+    ParsedInstruction parsed = parseClearance(instruction);
+    if (parsed.target_altitude_feet) {
+        pendingInstructions_.push_back("Altitude: " + instruction);
+        logClearance(ClearanceEventType::ALTITUDE, static_cast<int32_t>(std::lround(*parsed.target_altitude_feet)));
     }
-    
-    // Extract heading instructions (with numeric values)
-    if (lower.find("turn") != std::string::npos || 
-        lower.find("heading") != std::string::npos ||
-        lower.find("fly heading") != std::string::npos) {
-        
-        std::string headingInstruction = "Heading: " + instruction;
-        pendingInstructions_.push_back(headingInstruction);
+    if (parsed.target_heading_degrees) {
+        pendingInstructions_.push_back("Heading: " + instruction);
+        logClearance(ClearanceEventType::HEADING, static_cast<int32_t>(std::lround(*parsed.target_heading_degrees)));
     }
-    
-    // Extract speed instructions
-    if (lower.find("speed") != std::string::npos ||
-        lower.find("slow") != std::string::npos ||
-        lower.find("reduce speed") != std::string::npos) {
-        
-        std::string speedInstruction = "Speed: " + instruction;
-        pendingInstructions_.push_back(speedInstruction);
+    if (parsed.target_speed_knots) {
+        pendingInstructions_.push_back("Speed: " + instruction);
+        logClearance(ClearanceEventType::SPEED, static_cast<int32_t>(std::lround(*parsed.target_speed_knots)));
+    }
+    if (parsed.frequency_mhz) {
+        pendingInstructions_.push_back("Frequency change: " + instruction);
+        logClearance(ClearanceEventType::FREQUENCY, static_cast<int32_t>(std::lround(*parsed.frequency_mhz * 1000.0)));
+    }
+    if (parsed.squawk_code) {
+        pendingInstructions_.push_back("Squawk: " + instruction);
+        logClearance(ClearanceEventType::SQUAWK, *parsed.squawk_code);
     }
     
+    std::string lower = instruction;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    
     // Extract clearances
     if (lower.find("cleared") != std::string::npos) {
         if (lower.find("takeoff") != std::string::npos) {
             pendingInstructions_.push_back("Cleared for takeoff");
+            logClearance(ClearanceEventType::CLEARED_TAKEOFF);
         } else if (lower.find("land") != std::string::npos) {
             pendingInstructions_.push_back("Cleared to land");
+            logClearance(ClearanceEventType::CLEARED_TO_LAND);
         } else if (lower.find("approach") != std::string::npos) {
             pendingInstructions_.push_back("Cleared for approach");
+            logClearance(ClearanceEventType::CLEARED_APPROACH);
         } else {
             pendingInstructions_.push_back(instruction);
+            logClearance(ClearanceEventType::CLEARED_OTHER);
         }
     }
     
-    // Extract frequency changes
-    if (lower.find("contact") != std::string::npos ||
-        lower.find("frequency") != std::string::npos) {
-        std::string freqInstruction = "Frequency change: " + instruction;
-        pendingInstructions_.push_back(freqInstruction);
-    }
-    
     // Extract holding instructions
     if (lower.find("hold") != std::string::npos) {
         pendingInstructions_.push_back("Hold: " + instruction);
-    }
-    
-    // Extract squawk codes
-    if (lower.find("squawk") != std::string::npos) {
-        pendingInstructions_.push_back("Squawk: " + instruction);
+        logClearance(ClearanceEventType::HOLD);
     }
 }
 
+void ATCController::logClearance(ClearanceEventType type, int32_t value) {
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - clearanceLogStart_);
+    clearanceLog_.append(type, value, static_cast<uint32_t>(elapsed.count()));
+}
+
 void ATCController::handleInstruction(const std::string& instruction) {
     if (!airportOps_) {
         return;
@@ -274,6 +372,13 @@ void ATCController::handleInstruction(const std::string& instruction) {
         return;
     }
 
+    // Ground clearance transitions go into the log once each
+    int groundState = static_cast<int>(clearance->get_state());
+    if (groundState != lastGroundState_) {
+        lastGroundState_ = groundState;
+        logClearance(ClearanceEventType::GROUND_STATE, groundState);
+    }
+
     switch (clearance->get_state()) {
         case ClearanceStateMachine::ClearanceState::PushbackRequested:
             pendingInstructions_.push_back("Awaiting pushback clearance");
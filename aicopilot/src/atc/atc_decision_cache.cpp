@@ -0,0 +1,184 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/atc_decision_cache.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace AICopilot {
+
+std::optional<int> ATCDecisionCache::lookup(const std::string& phase, const std::string& message,
+                                            const std::vector<std::string>& options) {
+    auto it = index_.find(makeKey(phase, message, options));
+    if (it != index_.end()) {
+        entries_.splice(entries_.begin(), entries_, it->second);
+        exactHits_++;
+        return it->second->option;
+    }
+
+    if (similarityThreshold_ > 0.0) {
+        std::vector<Embedding> query = embedSituation(message, options);
+        auto best = entries_.end();
+        float bestSimilarity = static_cast<float>(similarityThreshold_);
+        for (auto entry = entries_.begin(); entry != entries_.end(); ++entry) {
+            if (entry->phase != phase || entry->embeddings.size() != query.size()) {
+                continue;
+            }
+            float weakest = 1.0f;
+            for (size_t i = 0; i < query.size() && weakest >= bestSimilarity; ++i) {
+                weakest = std::min(weakest, cosine(query[i], entry->embeddings[i]));
+            }
+            if (weakest >= bestSimilarity) {
+                bestSimilarity = weakest;
+                best = entry;
+            }
+        }
+        if (best != entries_.end()) {
+            entries_.splice(entries_.begin(), entries_, best);
+            similarHits_++;
+            return best->option;
+        }
+    }
+
+    misses_++;
+    return std::nullopt;
+}
+
+void ATCDecisionCache::store(const std::string& phase, const std::string& message,
+                             const std::vector<std::string>& options, int option) {
+    if (capacity_ == 0 || option < 0 || option >= static_cast<int>(options.size())) {
+        return;
+    }
+
+    std::string key = makeKey(phase, message, options);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        it->second->option = option;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return;
+    }
+
+    Entry entry;
+    entry.key = key;
+    entry.phase = phase;
+    entry.embeddings = embedSituation(message, options);
+    entry.option = option;
+    entries_.push_front(std::move(entry));
+    index_.emplace(std::move(key), entries_.begin());
+
+    while (entries_.size() > capacity_) {
+        index_.erase(entries_.back().key);
+        entries_.pop_back();
+    }
+}
+
+void ATCDecisionCache::clear() {
+    entries_.clear();
+    index_.clear();
+}
+
+ATCDecisionCacheStats ATCDecisionCache::getStats() const {
+    ATCDecisionCacheStats stats;
+    stats.exactHits = exactHits_;
+    stats.similarHits = similarHits_;
+    stats.misses = misses_;
+    stats.entries = entries_.size();
+    return stats;
+}
+
+void ATCDecisionCache::resetStats() {
+    exactHits_ = 0;
+    similarHits_ = 0;
+    misses_ = 0;
+}
+
+std::string ATCDecisionCache::normalize(const std::string& text) {
+    std::string result;
+    result.reserve(text.size());
+    bool pendingSpace = false;
+    for (char raw : text) {
+        unsigned char c = static_cast<unsigned char>(raw);
+        if (std::isalnum(c)) {
+            if (pendingSpace && !result.empty()) {
+                result += ' ';
+            }
+            pendingSpace = false;
+            if (std::isdigit(c)) {
+                if (result.empty() || result.back() != '#') {
+                    result += '#';
+                }
+            } else {
+                result += static_cast<char>(std::tolower(c));
+            }
+        } else {
+            pendingSpace = true;
+        }
+    }
+    return result;
+}
+
+std::string ATCDecisionCache::makeKey(const std::string& phase, const std::string& message,
+                                      const std::vector<std::string>& options) {
+    std::string key = phase;
+    key += '\n';
+    key += normalize(message);
+    for (const auto& option : options) {
+        key += '\n';
+        key += normalize(option);
+    }
+    return key;
+}
+
+std::vector<ATCDecisionCache::Embedding> ATCDecisionCache::embedSituation(
+    const std::string& message, const std::vector<std::string>& options) {
+
+    std::vector<Embedding> embeddings;
+    embeddings.reserve(options.size() + 1);
+    embeddings.push_back(embed(normalize(message)));
+    for (const auto& option : options) {
+        embeddings.push_back(embed(normalize(option)));
+    }
+    return embeddings;
+}
+
+ATCDecisionCache::Embedding ATCDecisionCache::embed(const std::string& normalized) {
+    Embedding vector{};
+    if (normalized.empty()) {
+        vector[0] = 1.0f;   // empty text is similar only to empty text
+        return vector;
+    }
+    std::string padded = " " + normalized + " ";
+    for (size_t i = 0; i + 3 <= padded.size(); ++i) {
+        // FNV-1a over the trigram; the top bit picks the sign so collisions tend to cancel
+        uint32_t hash = 2166136261u;
+        for (size_t k = 0; k < 3; ++k) {
+            hash = (hash ^ static_cast<unsigned char>(padded[i + k])) * 16777619u;
+        }
+        vector[hash % EMBEDDING_DIMENSIONS] += (hash & 0x80000000u) ? -1.0f : 1.0f;
+    }
+
+    float norm = 0.0f;
+    for (float v : vector) norm += v * v;
+    if (norm > 0.0f) {
+        float inverse = 1.0f / std::sqrt(norm);
+        for (float& v : vector) v *= inverse;
+    }
+    return vector;
+}
+
+float ATCDecisionCache::cosine(const Embedding& a, const Embedding& b) {
+    float dot = 0.0f;
+    for (size_t i = 0; i < EMBEDDING_DIMENSIONS; ++i) {
+        dot += a[i] * b[i];
+    }
+    return dot;
+}
+
+} // namespace AICopilot
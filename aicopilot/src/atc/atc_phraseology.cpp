@@ -0,0 +1,358 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* ATC Phraseology Parser Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/atc_phraseology.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace AICopilot {
+
+namespace {
+
+enum class Word : uint8_t {
+    END, OTHER, NUMBER, DIGIT, POINT, THOUSAND, HUNDRED,
+    AND, TO, ON, CLIMB, DESCEND, MAINTAIN, FLIGHT, LEVEL, FL, FEET,
+    HEADING, TURN, LEFT, RIGHT, SPEED, KNOTS, REDUCE, INCREASE,
+    CONTACT, MONITOR, FREQUENCY, SQUAWK
+};
+
+struct Keyword {
+    std::string_view text;
+    Word word;
+    int digit;
+};
+
+// Sorted for binary search; spoken digits use ICAO pronunciation too
+constexpr Keyword KEYWORDS[] = {
+    {"and", Word::AND, 0},
+    {"climb", Word::CLIMB, 0},
+    {"contact", Word::CONTACT, 0},
+    {"decimal", Word::POINT, 0},
+    {"descend", Word::DESCEND, 0},
+    {"eight", Word::DIGIT, 8},
+    {"feet", Word::FEET, 0},
+    {"fife", Word::DIGIT, 5},
+    {"five", Word::DIGIT, 5},
+    {"fl", Word::FL, 0},
+    {"flight", Word::FLIGHT, 0},
+    {"four", Word::DIGIT, 4},
+    {"frequency", Word::FREQUENCY, 0},
+    {"ft", Word::FEET, 0},
+    {"heading", Word::HEADING, 0},
+    {"hundred", Word::HUNDRED, 0},
+    {"increase", Word::INCREASE, 0},
+    {"knots", Word::KNOTS, 0},
+    {"kt", Word::KNOTS, 0},
+    {"kts", Word::KNOTS, 0},
+    {"left", Word::LEFT, 0},
+    {"level", Word::LEVEL, 0},
+    {"maintain", Word::MAINTAIN, 0},
+    {"monitor", Word::MONITOR, 0},
+    {"nine", Word::DIGIT, 9},
+    {"niner", Word::DIGIT, 9},
+    {"on", Word::ON, 0},
+    {"one", Word::DIGIT, 1},
+    {"point", Word::POINT, 0},
+    {"reduce", Word::REDUCE, 0},
+    {"right", Word::RIGHT, 0},
+    {"seven", Word::DIGIT, 7},
+    {"six", Word::DIGIT, 6},
+    {"speed", Word::SPEED, 0},
+    {"squawk", Word::SQUAWK, 0},
+    {"thousand", Word::THOUSAND, 0},
+    {"three", Word::DIGIT, 3},
+    {"to", Word::TO, 0},
+    {"tree", Word::DIGIT, 3},
+    {"turn", Word::TURN, 0},
+    {"two", Word::DIGIT, 2},
+    {"zero", Word::DIGIT, 0},
+};
+
+constexpr bool keywordsSorted() {
+    for (size_t i = 1; i < sizeof(KEYWORDS) / sizeof(KEYWORDS[0]); ++i) {
+        if (!(KEYWORDS[i - 1].text < KEYWORDS[i].text)) return false;
+    }
+    return true;
+}
+static_assert(keywordsSorted(), "KEYWORDS must be sorted");
+
+constexpr size_t MAX_KEYWORD_LENGTH = 16;
+
+enum class State : uint8_t {
+    IDLE, ALTITUDE, FLIGHT, FLIGHT_LEVEL, HEADING, TURN, SPEED, SPEED_CHANGE, FREQUENCY, SQUAWK,
+    ANY   // wildcard source in TRANSITIONS
+};
+
+struct Transition {
+    State from;
+    Word word;
+    State to;
+};
+
+// Phraseology grammar; entries for the current state take precedence over
+// ANY, and a keyword with no entry returns the parser to IDLE
+constexpr Transition TRANSITIONS[] = {
+    {State::ALTITUDE, Word::AND, State::ALTITUDE},
+    {State::ALTITUDE, Word::TO, State::ALTITUDE},
+    {State::ALTITUDE, Word::FLIGHT, State::FLIGHT},
+    {State::ALTITUDE, Word::FL, State::FLIGHT_LEVEL},
+    {State::FLIGHT, Word::LEVEL, State::FLIGHT_LEVEL},
+    {State::TURN, Word::LEFT, State::TURN},
+    {State::TURN, Word::RIGHT, State::TURN},
+    {State::SPEED, Word::TO, State::SPEED},
+    {State::SPEED_CHANGE, Word::TO, State::SPEED},
+    {State::FREQUENCY, Word::OTHER, State::FREQUENCY},   // facility name
+    {State::FREQUENCY, Word::ON, State::FREQUENCY},
+    {State::FREQUENCY, Word::TO, State::FREQUENCY},
+
+    {State::ANY, Word::CLIMB, State::ALTITUDE},
+    {State::ANY, Word::DESCEND, State::ALTITUDE},
+    {State::ANY, Word::MAINTAIN, State::ALTITUDE},
+    {State::ANY, Word::FL, State::FLIGHT_LEVEL},
+    {State::ANY, Word::HEADING, State::HEADING},
+    {State::ANY, Word::TURN, State::TURN},
+    {State::ANY, Word::SPEED, State::SPEED},
+    {State::ANY, Word::REDUCE, State::SPEED_CHANGE},
+    {State::ANY, Word::INCREASE, State::SPEED_CHANGE},
+    {State::ANY, Word::CONTACT, State::FREQUENCY},
+    {State::ANY, Word::MONITOR, State::FREQUENCY},
+    {State::ANY, Word::FREQUENCY, State::FREQUENCY},
+    {State::ANY, Word::SQUAWK, State::SQUAWK},
+};
+
+State transition(State from, Word word) {
+    const Transition* wildcard = nullptr;
+    for (const auto& entry : TRANSITIONS) {
+        if (entry.word != word) continue;
+        if (entry.from == from) return entry.to;
+        if (entry.from == State::ANY && !wildcard) wildcard = &entry;
+    }
+    return wildcard ? wildcard->to : State::IDLE;
+}
+
+struct Token {
+    Word word = Word::END;
+    double value = 0.0;
+    int digits = 0;          // digit count of a plain integer; 0 if it had a fraction or grouping
+};
+
+bool isAlpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+/**
+ * Word tokens over the text, with numbers folded into one NUMBER token
+ */
+class Lexer {
+public:
+    explicit Lexer(std::string_view text) : text_(text) {}
+
+    Token next() {
+        Token raw = readRaw();
+        if (raw.word != Word::NUMBER && raw.word != Word::DIGIT) {
+            return raw;
+        }
+        return foldNumber(raw);
+    }
+
+    // Kind of the next word without consuming it
+    Word peekWord() {
+        size_t saved = pos_;
+        Word word = readRaw().word;
+        pos_ = saved;
+        return word;
+    }
+
+    void skip() { readRaw(); }
+
+private:
+    std::string_view text_;
+    size_t pos_ = 0;
+
+    Token readRaw() {
+        while (pos_ < text_.size() && !isAlpha(text_[pos_]) && !isDigit(text_[pos_])) {
+            ++pos_;
+        }
+        Token token;
+        if (pos_ >= text_.size()) {
+            return token;
+        }
+
+        if (isDigit(text_[pos_])) {
+            token.word = Word::NUMBER;
+            while (pos_ < text_.size() && isDigit(text_[pos_])) {
+                token.value = token.value * 10.0 + (text_[pos_++] - '0');
+                token.digits++;
+            }
+            // A period counts as a decimal point only between digits
+            if (pos_ + 1 < text_.size() && text_[pos_] == '.' && isDigit(text_[pos_ + 1])) {
+                ++pos_;
+                double scale = 0.1;
+                while (pos_ < text_.size() && isDigit(text_[pos_])) {
+                    token.value += (text_[pos_++] - '0') * scale;
+                    scale *= 0.1;
+                }
+                token.digits = 0;
+            }
+            return token;
+        }
+
+        char lower[MAX_KEYWORD_LENGTH];
+        size_t length = 0;
+        while (pos_ < text_.size() && isAlpha(text_[pos_])) {
+            if (length < MAX_KEYWORD_LENGTH) {
+                lower[length] = static_cast<char>(text_[pos_] | 0x20);
+            }
+            ++length;
+            ++pos_;
+        }
+        token.word = Word::OTHER;
+        if (length <= MAX_KEYWORD_LENGTH) {
+            std::string_view word(lower, length);
+            auto it = std::lower_bound(std::begin(KEYWORDS), std::end(KEYWORDS), word,
+                                       [](const Keyword& k, std::string_view w) { return k.text < w; });
+            if (it != std::end(KEYWORDS) && it->text == word) {
+                token.word = it->word;
+                token.value = it->digit;
+                token.digits = it->word == Word::DIGIT ? 1 : 0;
+            }
+        }
+        return token;
+    }
+
+    // Spoken digits run together, "point" adds a fraction, and
+    // "thousand"/"hundred" close a group: "one zero thousand" is 10000
+    Token foldNumber(Token first) {
+        Token number;
+        number.word = Word::NUMBER;
+        double current = first.value;
+        double total = 0.0;
+        int digits = first.digits;
+        bool spoken = first.word == Word::DIGIT;
+        bool grouped = false;
+        bool fraction = first.digits == 0;
+
+        for (;;) {
+            size_t saved = pos_;
+            Token raw = readRaw();
+            if (raw.word == Word::DIGIT && spoken) {
+                current = current * 10.0 + raw.value;
+                digits++;
+            } else if (raw.word == Word::THOUSAND || raw.word == Word::HUNDRED) {
+                total += current * (raw.word == Word::THOUSAND ? 1000.0 : 100.0);
+                current = 0.0;
+                grouped = true;
+                spoken = true;
+            } else if (raw.word == Word::POINT && !fraction && !grouped) {
+                Token after = readRaw();
+                if (after.word == Word::DIGIT) {
+                    double scale = 0.1;
+                    current += after.value * scale;
+                    size_t digitPos = pos_;
+                    for (Token more = readRaw(); more.word == Word::DIGIT; more = readRaw()) {
+                        scale *= 0.1;
+                        current += more.value * scale;
+                        digitPos = pos_;
+                    }
+                    pos_ = digitPos;
+                } else if (after.word == Word::NUMBER && after.digits > 0) {
+                    double scale = 1.0;
+                    for (int i = 0; i < after.digits; ++i) scale *= 0.1;
+                    current += after.value * scale;
+                } else {
+                    pos_ = saved;
+                    break;
+                }
+                fraction = true;
+                break;
+            } else {
+                pos_ = saved;
+                break;
+            }
+        }
+
+        number.value = total + current;
+        number.digits = (fraction || grouped) ? 0 : digits;
+        return number;
+    }
+};
+
+bool isSquawk(const Token& number) {
+    if (number.digits != 4) return false;
+    int code = static_cast<int>(number.value);
+    for (int i = 0; i < 4; ++i, code /= 10) {
+        if (code % 10 > 7) return false;
+    }
+    return true;
+}
+
+template <typename T>
+void assign(std::optional<T>& slot, T value) {
+    if (!slot) slot = value;
+}
+
+} // namespace
+
+ParsedClearance parseClearance(std::string_view text) {
+    ParsedClearance result;
+    Lexer lexer(text);
+    State state = State::IDLE;
+
+    for (Token token = lexer.next(); token.word != Word::END; token = lexer.next()) {
+        if (token.word != Word::NUMBER) {
+            state = transition(state, token.word);
+            continue;
+        }
+
+        double value = token.value;
+        switch (state) {
+            case State::ALTITUDE: {
+                Word unit = lexer.peekWord();
+                if (unit == Word::KNOTS) {
+                    lexer.skip();
+                    if (value >= 40.0 && value <= 600.0) assign(result.target_speed_knots, value);
+                } else if (unit == Word::FEET) {
+                    lexer.skip();
+                    if (value >= 100.0 && value <= 60000.0) assign(result.target_altitude_feet, value);
+                } else if (value >= (token.digits == 0 ? 100.0 : 1000.0) && value <= 60000.0) {
+                    assign(result.target_altitude_feet, value);
+                }
+                break;
+            }
+            case State::FLIGHT_LEVEL:
+                if (value >= 10.0 && value <= 600.0) assign(result.target_altitude_feet, value * 100.0);
+                break;
+            case State::HEADING:
+            case State::TURN:
+                if (value >= 0.0 && value <= 360.0 && token.digits > 0) {
+                    assign(result.target_heading_degrees, value == 0.0 ? 360.0 : value);
+                }
+                break;
+            case State::SPEED:
+            case State::SPEED_CHANGE:
+                if (lexer.peekWord() == Word::KNOTS) lexer.skip();
+                if (value >= 40.0 && value <= 600.0) assign(result.target_speed_knots, value);
+                break;
+            case State::FREQUENCY:
+                if (value >= 108.0 && value < 137.0) assign(result.frequency_mhz, value);
+                break;
+            case State::SQUAWK:
+                if (isSquawk(token)) assign(result.squawk_code, static_cast<int>(value));
+                break;
+            default:
+                break;
+        }
+        state = State::IDLE;
+    }
+    return result;
+}
+
+} // namespace AICopilot
@@ -0,0 +1,182 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Clearance Log Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/clearance_log.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr char MAGIC[8] = {'A', 'I', 'C', 'P', 'C', 'L', 'R', 'L'};
+
+} // namespace
+
+void ClearanceSnapshot::apply(const ClearanceEvent& event) {
+    switch (event.type) {
+        case ClearanceEventType::ALTITUDE: altitudeFeet = event.value; break;
+        case ClearanceEventType::HEADING: headingDegrees = event.value; break;
+        case ClearanceEventType::SPEED: speedKnots = event.value; break;
+        case ClearanceEventType::FREQUENCY: frequencyKHz = event.value; break;
+        case ClearanceEventType::SQUAWK: squawk = event.value; break;
+        case ClearanceEventType::GROUND_STATE: groundState = event.value; break;
+        case ClearanceEventType::CLEARED_TAKEOFF:
+            // A takeoff clearance ends any earlier arrival clearance
+            assigned &= static_cast<uint16_t>(~(bit(ClearanceEventType::CLEARED_TO_LAND) |
+                                                bit(ClearanceEventType::CLEARED_APPROACH)));
+            [[fallthrough]];
+        case ClearanceEventType::CLEARED_TO_LAND:
+        case ClearanceEventType::CLEARED_APPROACH:
+        case ClearanceEventType::CLEARED_OTHER:
+            // Any onward clearance releases a hold
+            assigned &= static_cast<uint16_t>(~bit(ClearanceEventType::HOLD));
+            if (event.type != ClearanceEventType::CLEARED_TAKEOFF) {
+                assigned &= static_cast<uint16_t>(~bit(ClearanceEventType::CLEARED_TAKEOFF));
+            }
+            break;
+        case ClearanceEventType::HOLD:
+            break;
+    }
+    assigned |= bit(event.type);
+    eventCount = event.sequence + 1;
+    timeMs = event.timeMs;
+}
+
+ClearanceLog::ClearanceLog(size_t checkpointInterval)
+    : checkpointInterval_(std::max<size_t>(checkpointInterval, 1)) {
+}
+
+const ClearanceEvent& ClearanceLog::append(ClearanceEventType type, int32_t value, uint32_t timeMs) {
+    ClearanceEvent event;
+    event.sequence = current_.eventCount;
+    event.timeMs = timeMs;
+    event.value = value;
+    event.type = type;
+
+    events_.push_back(event);
+    current_.apply(event);
+    if (events_.size() % checkpointInterval_ == 0) {
+        checkpoints_.push_back(current_);
+    }
+    return events_.back();
+}
+
+ClearanceSnapshot ClearanceLog::stateAt(uint32_t eventCount) const {
+    eventCount = std::min(std::max(eventCount, base_.eventCount), current_.eventCount);
+    size_t offset = eventCount - base_.eventCount;
+
+    size_t checkpoint = std::min(offset / checkpointInterval_, checkpoints_.size());
+    ClearanceSnapshot state = checkpoint == 0 ? base_ : checkpoints_[checkpoint - 1];
+    for (size_t i = checkpoint * checkpointInterval_; i < offset; ++i) {
+        state.apply(events_[i]);
+    }
+    return state;
+}
+
+ClearanceSnapshot ClearanceLog::replay(const ClearanceSnapshot& from,
+                                       const std::vector<ClearanceEvent>& events) {
+    ClearanceSnapshot state = from;
+    for (const auto& event : events) {
+        if (event.sequence >= state.eventCount) {
+            state.apply(event);
+        }
+    }
+    return state;
+}
+
+void ClearanceLog::compact(size_t keepEvents) {
+    if (events_.size() <= keepEvents) {
+        return;
+    }
+    size_t drop = events_.size() - keepEvents;
+    base_ = stateAt(base_.eventCount + static_cast<uint32_t>(drop));
+    events_.erase(events_.begin(), events_.begin() + static_cast<std::ptrdiff_t>(drop));
+    rebuildCheckpoints();
+}
+
+void ClearanceLog::clear() {
+    base_ = ClearanceSnapshot();
+    current_ = ClearanceSnapshot();
+    events_.clear();
+    checkpoints_.clear();
+}
+
+bool ClearanceLog::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+
+    uint32_t version = FILE_VERSION;
+    uint32_t count = static_cast<uint32_t>(events_.size());
+    file.write(MAGIC, sizeof(MAGIC));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    file.write(reinterpret_cast<const char*>(&base_), sizeof(base_));
+    file.write(reinterpret_cast<const char*>(events_.data()),
+               static_cast<std::streamsize>(events_.size() * sizeof(ClearanceEvent)));
+    return static_cast<bool>(file);
+}
+
+bool ClearanceLog::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    char magic[sizeof(MAGIC)];
+    uint32_t version = 0;
+    uint32_t count = 0;
+    ClearanceSnapshot base;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    file.read(reinterpret_cast<char*>(&base), sizeof(base));
+    if (!file || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != FILE_VERSION) {
+        return false;
+    }
+
+    std::vector<ClearanceEvent> events(count);
+    file.read(reinterpret_cast<char*>(events.data()),
+              static_cast<std::streamsize>(events.size() * sizeof(ClearanceEvent)));
+    if (!file) {
+        return false;
+    }
+    return restore(base, events.data(), events.size());
+}
+
+bool ClearanceLog::restore(const ClearanceSnapshot& base, const ClearanceEvent* events, size_t eventCount) {
+    for (size_t i = 0; i < eventCount; ++i) {
+        if (events[i].sequence != base.eventCount + i) {
+            return false;   // gap or reordering; not a log this class wrote
+        }
+    }
+
+    base_ = base;
+    events_.assign(events, events + eventCount);
+    rebuildCheckpoints();
+    return true;
+}
+
+void ClearanceLog::rebuildCheckpoints() {
+    checkpoints_.clear();
+    current_ = base_;
+    for (size_t i = 0; i < events_.size(); ++i) {
+        current_.apply(events_[i]);
+        if ((i + 1) % checkpointInterval_ == 0) {
+            checkpoints_.push_back(current_);
+        }
+    }
+}
+
+} // namespace AICopilot
@@ -7,11 +7,16 @@
 
 #ifdef ENABLE_OLLAMA
 
-#include "ollama_client.h"
+#include "../include/ollama_client.h"
+#include "ollama_stream_parser.hpp"
 #include <curl/curl.h>
 #include <json/json.h>
+#include <algorithm>
+#include <atomic>
+#include <deque>
 #include <sstream>
 #include <iostream>
+#include <thread>
 
 namespace AICopilot {
 
@@ -22,12 +27,51 @@ static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::stri
     return totalSize;
 }
 
+/**
+ * All generate requests run on one worker thread driving a curl multi
+ * handle, so callers never block on the network. The multi handle owns the
+ * connection cache: up to MAX_HOST_CONNECTIONS keep-alive connections to
+ * the server are reused across requests, and requests beyond that queue
+ * for a free one (or share one, multiplexed, when the server speaks
+ * HTTP/2). Easy handles are pooled as well and only reset between uses.
+ *
+ * Responses are streamed and parsed as they arrive: once the answer names
+ * an option the selection resolves and the transfer is aborted, which
+ * also stops the generation on the server.
+ */
 class OllamaClient::Impl {
 public:
-    CURL* curl = nullptr;
+    static constexpr long MAX_HOST_CONNECTIONS = 4;
+    static constexpr int POLL_INTERVAL_MS = 100;
+    
+    struct Transfer {
+        std::shared_ptr<OllamaSelection> selection;
+        std::string url;
+        std::string body;
+        std::string apiKey;
+        OllamaStreamParser parser{0};
+        CURL* easy = nullptr;
+        curl_slist* headers = nullptr;
+    };
+    
+    CURL* curl = nullptr;   // blocking requests (connect)
     std::string lastError;
     
+    Impl() {
+        multi_ = curl_multi_init();
+        curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, MAX_HOST_CONNECTIONS);
+        curl_multi_setopt(multi_, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        worker_ = std::thread([this]() { run(); });
+    }
+    
     ~Impl() {
+        stopping_ = true;
+        curl_multi_wakeup(multi_);
+        worker_.join();
+        for (CURL* easy : idle_) {
+            curl_easy_cleanup(easy);
+        }
+        curl_multi_cleanup(multi_);
         if (curl) {
             curl_easy_cleanup(curl);
         }
@@ -67,19 +111,193 @@ public:
         
         return response;
     }
+    
+    // Queue a transfer for the worker; thread-safe
+    void submit(std::unique_ptr<Transfer> transfer) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            incoming_.push_back(std::move(transfer));
+        }
+        curl_multi_wakeup(multi_);
+    }
+
+private:
+    CURLM* multi_ = nullptr;
+    std::thread worker_;
+    std::atomic<bool> stopping_{false};
+    
+    std::mutex mutex_;
+    std::deque<std::unique_ptr<Transfer>> incoming_;   // guarded by mutex_
+    
+    // Worker-thread only
+    std::vector<std::unique_ptr<Transfer>> active_;
+    std::vector<CURL*> idle_;
+    
+    // Returning short of the chunk size aborts the transfer
+    static size_t StreamCallback(void* contents, size_t size, size_t nmemb, Transfer* transfer) {
+        size_t totalSize = size * nmemb;
+        if (transfer->selection->isDone()) {
+            return 0;
+        }
+        if (transfer->parser.feed(static_cast<const char*>(contents), totalSize)) {
+            transfer->selection->resolve(OllamaSelection::Status::COMPLETED,
+                                         transfer->parser.getOption());
+            return 0;
+        }
+        return totalSize;
+    }
+    
+    void run() {
+        while (!stopping_) {
+            startIncoming();
+            dropCancelled();
+            
+            int running = 0;
+            curl_multi_perform(multi_, &running);
+            
+            int queued = 0;
+            while (CURLMsg* msg = curl_multi_info_read(multi_, &queued)) {
+                if (msg->msg == CURLMSG_DONE) {
+                    finish(msg->easy_handle, msg->data.result);
+                }
+            }
+            
+            curl_multi_poll(multi_, nullptr, 0, POLL_INTERVAL_MS, nullptr);
+        }
+        
+        for (auto& transfer : active_) {
+            transfer->selection->cancel();
+            release(*transfer);
+        }
+        active_.clear();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& transfer : incoming_) {
+            transfer->selection->cancel();
+        }
+        incoming_.clear();
+    }
+    
+    void startIncoming() {
+        std::deque<std::unique_ptr<Transfer>> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            batch.swap(incoming_);
+        }
+        
+        for (auto& transfer : batch) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                transfer->selection->getDeadline() - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0) {
+                transfer->selection->resolve(OllamaSelection::Status::TIMED_OUT);
+                continue;
+            }
+            if (transfer->selection->isDone()) {
+                continue;   // cancelled before it started
+            }
+            
+            CURL* easy = acquire();
+            if (!easy) {
+                transfer->selection->resolve(OllamaSelection::Status::FAILED);
+                continue;
+            }
+            transfer->easy = easy;
+            transfer->headers = curl_slist_append(nullptr, "Content-Type: application/json");
+            if (!transfer->apiKey.empty()) {
+                std::string auth = "Authorization: Bearer " + transfer->apiKey;
+                transfer->headers = curl_slist_append(transfer->headers, auth.c_str());
+            }
+            
+            curl_easy_setopt(easy, CURLOPT_URL, transfer->url.c_str());
+            curl_easy_setopt(easy, CURLOPT_POSTFIELDS, transfer->body.c_str());
+            curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->headers);
+            curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, StreamCallback);
+            curl_easy_setopt(easy, CURLOPT_WRITEDATA, transfer.get());
+            curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, static_cast<long>(remaining.count()));
+            curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+            curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+            curl_easy_setopt(easy, CURLOPT_PRIVATE, transfer.get());
+            
+            curl_multi_add_handle(multi_, easy);
+            active_.push_back(std::move(transfer));
+        }
+    }
+    
+    // Cancelled transfers give their handle back right away
+    void dropCancelled() {
+        auto done = std::stable_partition(active_.begin(), active_.end(),
+            [](const std::unique_ptr<Transfer>& t) { return !t->selection->isDone(); });
+        for (auto it = done; it != active_.end(); ++it) {
+            release(**it);
+        }
+        active_.erase(done, active_.end());
+    }
+    
+    void finish(CURL* easy, CURLcode result) {
+        char* privateData = nullptr;
+        curl_easy_getinfo(easy, CURLINFO_PRIVATE, &privateData);
+        Transfer* transfer = reinterpret_cast<Transfer*>(privateData);
+        auto it = std::find_if(active_.begin(), active_.end(),
+            [transfer](const std::unique_ptr<Transfer>& t) { return t.get() == transfer; });
+        if (it == active_.end()) return;
+        
+        long httpStatus = 0;
+        curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &httpStatus);
+        
+        if (transfer->selection->isDone()) {
+            // Decided from the stream (and aborted) or cancelled
+        } else if (result == CURLE_OPERATION_TIMEDOUT) {
+            transfer->selection->resolve(OllamaSelection::Status::TIMED_OUT);
+        } else if (result != CURLE_OK || httpStatus != 200) {
+            std::cout << "[Ollama] Request failed: "
+                      << (result != CURLE_OK ? curl_easy_strerror(result) : "HTTP error")
+                      << std::endl;
+            transfer->selection->resolve(OllamaSelection::Status::FAILED);
+        } else {
+            transfer->parser.finish();
+            int option = transfer->parser.getOption();
+            transfer->selection->resolve(option >= 0 ? OllamaSelection::Status::COMPLETED
+                                                     : OllamaSelection::Status::FAILED, option);
+        }
+        
+        release(*transfer);
+        active_.erase(it);
+    }
+    
+    CURL* acquire() {
+        if (idle_.empty()) {
+            return curl_easy_init();
+        }
+        CURL* easy = idle_.back();
+        idle_.pop_back();
+        return easy;
+    }
+    
+    // Detach a transfer's easy handle and return it to the pool
+    void release(Transfer& transfer) {
+        if (transfer.easy) {
+            curl_multi_remove_handle(multi_, transfer.easy);
+            curl_easy_reset(transfer.easy);
+            idle_.push_back(transfer.easy);
+            transfer.easy = nullptr;
+        }
+        curl_slist_free_all(transfer.headers);
+        transfer.headers = nullptr;
+    }
 };
 
-OllamaClient::OllamaClient() 
-    : pImpl_(std::make_unique<Impl>())
-    , host_("http://localhost:11434")
+OllamaClient::OllamaClient()
+    : host_("http://localhost:11434")
     , model_("llama2")
     , available_(false) {
     
     curl_global_init(CURL_GLOBAL_DEFAULT);
+    pImpl_ = std::make_unique<Impl>();
     std::cout << "OllamaClient initialized with Ollama support" << std::endl;
 }
 
 OllamaClient::~OllamaClient() {
+    // Stop the worker and release every handle before libcurl shuts down
+    pImpl_.reset();
     curl_global_cleanup();
 }
 
@@ -123,55 +341,50 @@ int OllamaClient::selectATCMenuOption(
         return options.empty() ? -1 : 0;
     }
     
-    // Build prompt
-    std::string prompt = generatePrompt(situation, options, flightPhase, aircraftType);
-    
-    // Create JSON request
-    Json::Value root;
-    root["model"] = model_;
-    root["prompt"] = prompt;
-    root["stream"] = false;
-    
-    Json::StreamWriterBuilder writer;
-    std::string jsonData = Json::writeString(writer, root);
-    
-    // Make request
-    std::string url = host_ + "/api/generate";
-    std::string response = pImpl_->makeRequest(url, jsonData);
+    auto selection = selectATCMenuOptionAsync(situation, options, aircraftType, flightPhase,
+                                              DEFAULT_TIMEOUT);
+    selection->wait(DEFAULT_TIMEOUT);
     
-    if (response.empty()) {
+    int option = selection->getOption();
+    if (option < 0) {
+        selection->cancel();
         std::cout << "Ollama request failed, using default option" << std::endl;
         return 0;
     }
     
-    // Parse response
-    Json::CharReaderBuilder reader;
-    Json::Value responseJson;
-    std::string errors;
-    std::istringstream responseStream(response);
+    std::cout << "Ollama selected option " << (option + 1) << ": "
+             << options[option] << std::endl;
+    return option;
+}
+
+std::shared_ptr<OllamaSelection> OllamaClient::selectATCMenuOptionAsync(
+    const std::string& atcMessage,
+    const std::vector<std::string>& menuOptions,
+    const std::string& flightPhase,
+    const std::string& context,
+    std::chrono::milliseconds timeout) {
     
-    if (!Json::parseFromStream(reader, responseStream, &responseJson, &errors)) {
-        std::cout << "Failed to parse Ollama response: " << errors << std::endl;
-        return 0;
+    auto selection = std::make_shared<OllamaSelection>(std::chrono::steady_clock::now() + timeout);
+    if (!available_ || menuOptions.empty()) {
+        selection->resolve(OllamaSelection::Status::FAILED);
+        return selection;
     }
     
-    // Extract the answer
-    std::string answer = responseJson["response"].asString();
-    
-    // Parse the number from the response
-    for (char c : answer) {
-        if (isdigit(c)) {
-            int selection = c - '0';
-            if (selection > 0 && selection <= static_cast<int>(options.size())) {
-                std::cout << "Ollama selected option " << selection << ": " 
-                         << options[selection - 1] << std::endl;
-                return selection - 1;
-            }
-        }
-    }
+    // Create JSON request
+    Json::Value root;
+    root["model"] = model_;
+    root["prompt"] = generatePrompt(atcMessage, menuOptions, flightPhase, context);
+    root["stream"] = true;
+    Json::StreamWriterBuilder writer;
     
-    // Default to first option if parsing failed
-    return 0;
+    auto transfer = std::make_unique<Impl::Transfer>();
+    transfer->selection = selection;
+    transfer->url = host_ + "/api/generate";
+    transfer->body = Json::writeString(writer, root);
+    transfer->apiKey = apiKey_;
+    transfer->parser = OllamaStreamParser(menuOptions.size());
+    pImpl_->submit(std::move(transfer));
+    return selection;
 }
 
 std::string OllamaClient::generatePrompt(
@@ -194,12 +407,12 @@ std::string OllamaClient::generatePrompt(
         prompt << (i + 1) << ". " << menuOptions[i] << "\n";
     }
     
-    prompt << "\nRespond with only the number (1-" << menuOptions.size() 
+    prompt << "\nRespond with only the number (1-" << menuOptions.size()
            << ") of the best option. No explanation needed.";
     
     return prompt.str();
 }
-
+    
 } // namespace AICopilot
 
 #endif // ENABLE_OLLAMA
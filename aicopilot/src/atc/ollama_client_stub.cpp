@@ -7,7 +7,7 @@
 * (at your option) any later version.
 *****************************************************************************/
 
-#include "ollama_client.h"
+#include "../include/ollama_client.h"
 #include <iostream>
 #include <algorithm>
 #include <cctype>
@@ -453,6 +453,27 @@ int OllamaClient::selectATCMenuOption(
     return bestOption;
 }
 
+/**
+ * The stub has no network round trip, so the selection resolves before
+ * this returns
+ */
+std::shared_ptr<OllamaSelection> OllamaClient::selectATCMenuOptionAsync(
+    const std::string& atcMessage,
+    const std::vector<std::string>& menuOptions,
+    const std::string& flightPhase,
+    const std::string& context,
+    std::chrono::milliseconds timeout) {
+    
+    auto selection = std::make_shared<OllamaSelection>(std::chrono::steady_clock::now() + timeout);
+    int option = selectATCMenuOption(atcMessage, menuOptions, flightPhase, context);
+    if (option >= 0) {
+        selection->resolve(OllamaSelection::Status::COMPLETED, option);
+    } else {
+        selection->resolve(OllamaSelection::Status::FAILED);
+    }
+    return selection;
+}
+
 // Stub implementations for methods that require network/external libraries
 std::string OllamaClient::sendRequest(const std::string& prompt) const {
     std::cout << "[Ollama] sendRequest() - Stub: Cannot send HTTP request without CURL" << std::endl;
@@ -0,0 +1,254 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Ollama Gateway Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/ollama_gateway.hpp"
+#include <algorithm>
+
+namespace AICopilot {
+
+OllamaGateway::OllamaGateway(const OllamaGatewayConfig& config)
+    : config_(config)
+    , client_(std::make_unique<OllamaClient>()) {
+
+    OllamaClient* client = client_.get();
+    backend_ = [client](const OllamaGatewayRequest& request) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            request.deadline - std::chrono::steady_clock::now());
+        return client->selectATCMenuOptionAsync(request.atcMessage, request.menuOptions,
+                                                request.flightPhase, request.context, remaining);
+    };
+    dispatcher_ = std::thread([this]() { run(); });
+}
+
+OllamaGateway::OllamaGateway(Backend backend, const OllamaGatewayConfig& config)
+    : config_(config)
+    , backend_(std::move(backend)) {
+    dispatcher_ = std::thread([this]() { run(); });
+}
+
+OllamaGateway::~OllamaGateway() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    dispatcher_.join();
+}
+
+bool OllamaGateway::connect(const std::string& host) {
+    return client_ && client_->connect(host);
+}
+
+void OllamaGateway::setModel(const std::string& model) {
+    if (client_) {
+        client_->setModel(model);
+    }
+}
+
+void OllamaGateway::setApiKey(const std::string& apiKey) {
+    if (client_) {
+        client_->setApiKey(apiKey);
+    }
+}
+
+bool OllamaGateway::isAvailable() const {
+    return client_ ? client_->isAvailable() : static_cast<bool>(backend_);
+}
+
+std::shared_ptr<OllamaSelection> OllamaGateway::submit(uint32_t pilotId,
+                                                       LLMPriority priority,
+                                                       const std::string& atcMessage,
+                                                       const std::vector<std::string>& menuOptions,
+                                                       const std::string& flightPhase,
+                                                       const std::string& context,
+                                                       std::chrono::milliseconds timeout) {
+    auto now = std::chrono::steady_clock::now();
+    auto selection = std::make_shared<OllamaSelection>(now + timeout);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    stats_.submitted++;
+    if (stopping_ || menuOptions.empty()) {
+        lock.unlock();
+        selection->resolve(OllamaSelection::Status::FAILED);
+        return selection;
+    }
+    if (priority != LLMPriority::EMERGENCY && !takeToken(pilotId, now)) {
+        stats_.rateLimited++;
+        lock.unlock();
+        selection->resolve(OllamaSelection::Status::FAILED);
+        return selection;
+    }
+
+    Queued queued;
+    queued.request.pilotId = pilotId;
+    queued.request.priority = priority;
+    queued.request.atcMessage = atcMessage;
+    queued.request.menuOptions = menuOptions;
+    queued.request.flightPhase = flightPhase;
+    queued.request.context = context;
+    queued.request.deadline = selection->getDeadline();
+    queued.caller = selection;
+    (priority == LLMPriority::EMERGENCY ? emergencyQueue_ : routineQueue_).push_back(std::move(queued));
+
+    stats_.queueDepth = emergencyQueue_.size() + routineQueue_.size();
+    stats_.maxQueueDepth = std::max(stats_.maxQueueDepth, stats_.queueDepth);
+    lock.unlock();
+    wake_.notify_one();
+    return selection;
+}
+
+OllamaGatewayStats OllamaGateway::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+bool OllamaGateway::takeToken(uint32_t pilotId, std::chrono::steady_clock::time_point now) {
+    if (config_.pilotRequestsPerSecond <= 0.0) {
+        return true;
+    }
+
+    auto inserted = buckets_.try_emplace(pilotId);
+    TokenBucket& bucket = inserted.first->second;
+    if (inserted.second) {
+        bucket.tokens = config_.pilotBurst;
+    } else {
+        double elapsed = std::chrono::duration<double>(now - bucket.refilled).count();
+        bucket.tokens = std::min(config_.pilotBurst,
+                                 bucket.tokens + elapsed * config_.pilotRequestsPerSecond);
+    }
+    bucket.refilled = now;
+
+    if (bucket.tokens < 1.0) {
+        return false;
+    }
+    bucket.tokens -= 1.0;
+    return true;
+}
+
+void OllamaGateway::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+        lock.unlock();
+        collectFinished();
+        lock.lock();
+
+        auto now = std::chrono::steady_clock::now();
+        expireQueued(emergencyQueue_, now);
+        expireQueued(routineQueue_, now);
+
+        // Emergencies always go first
+        std::vector<Queued> batch;
+        while (inFlight_.size() + batch.size() < config_.maxInFlight &&
+               (!emergencyQueue_.empty() || !routineQueue_.empty())) {
+            auto& queue = emergencyQueue_.empty() ? routineQueue_ : emergencyQueue_;
+            batch.push_back(std::move(queue.front()));
+            queue.pop_front();
+        }
+        stats_.queueDepth = emergencyQueue_.size() + routineQueue_.size();
+        stats_.dispatched += batch.size();
+        lock.unlock();
+
+        // The whole batch goes out together so the server can schedule it as one
+        for (auto& queued : batch) {
+            auto backend = backend_(queued.request);
+            inFlight_.push_back({std::move(queued.caller), std::move(backend)});
+        }
+
+        lock.lock();
+        stats_.inFlight = inFlight_.size();
+        if (inFlight_.empty()) {
+            wake_.wait(lock, [this]() {
+                return stopping_ || !emergencyQueue_.empty() || !routineQueue_.empty();
+            });
+        } else {
+            wake_.wait_for(lock, POLL_INTERVAL);
+        }
+    }
+
+    // Abandon everything still outstanding
+    for (auto* queue : {&emergencyQueue_, &routineQueue_}) {
+        for (auto& queued : *queue) {
+            queued.caller->cancel();
+        }
+        queue->clear();
+    }
+    stats_.queueDepth = 0;
+    lock.unlock();
+    for (auto& request : inFlight_) {
+        if (request.backend) request.backend->cancel();
+        request.caller->cancel();
+    }
+    inFlight_.clear();
+}
+
+void OllamaGateway::collectFinished() {
+    struct Outcome {
+        std::shared_ptr<OllamaSelection> caller;
+        OllamaSelection::Status status;
+        int option;
+    };
+    std::vector<Outcome> outcomes;
+    uint64_t completed = 0;
+    uint64_t failed = 0;
+
+    auto finished = std::stable_partition(inFlight_.begin(), inFlight_.end(),
+        [&](InFlight& request) {
+            if (!request.backend) {
+                outcomes.push_back({request.caller, OllamaSelection::Status::FAILED, -1});
+                failed++;
+                return false;
+            }
+            if (request.caller->isDone()) {
+                request.backend->cancel();   // the pilot gave up on it
+                failed++;
+                return false;
+            }
+            if (!request.backend->isDone()) {
+                if (!request.backend->isPastDeadline()) {
+                    return true;
+                }
+                request.backend->cancel();
+            }
+
+            OllamaSelection::Status status = request.backend->getStatus();
+            outcomes.push_back({request.caller, status, request.backend->getOption()});
+            (status == OllamaSelection::Status::COMPLETED ? completed : failed)++;
+            return false;
+        });
+    inFlight_.erase(finished, inFlight_.end());
+
+    if (completed + failed > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.completed += completed;
+        stats_.failed += failed;
+        stats_.inFlight = inFlight_.size();
+    }
+
+    // Stats first, so a woken caller already sees its request counted
+    for (auto& outcome : outcomes) {
+        outcome.caller->resolve(outcome.status, outcome.option);
+    }
+}
+
+void OllamaGateway::expireQueued(std::deque<Queued>& queue, std::chrono::steady_clock::time_point now) {
+    auto expired = std::stable_partition(queue.begin(), queue.end(),
+        [&](const Queued& queued) {
+            return queued.request.deadline > now && !queued.caller->isDone();
+        });
+    for (auto it = expired; it != queue.end(); ++it) {
+        if (it->caller->resolve(OllamaSelection::Status::TIMED_OUT)) {
+            stats_.expired++;
+        }
+    }
+    queue.erase(expired, queue.end());
+}
+
+} // namespace AICopilot
@@ -0,0 +1,501 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "binary_log.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace AICopilot {
+
+namespace {
+
+// File layout, little-endian:
+//   header  "AICPLOG1" u64 wall-clock ns at the steady epoch
+//   SITE    u8 kind u32 id u8 level u32 line u16 len file u16 len format
+//   EVENT   u8 kind u32 site u64 ns-since-epoch u32 thread u16 len payload
+//   DROPPED u8 kind u32 thread u64 count
+constexpr char FILE_MAGIC[8] = {'A', 'I', 'C', 'P', 'L', 'O', 'G', '1'};
+constexpr uint8_t KIND_SITE = 1;
+constexpr uint8_t KIND_EVENT = 2;
+constexpr uint8_t KIND_DROPPED = 3;
+
+// Ring record: u16 payload size, site pointer, u64 timestamp, payload
+constexpr size_t RECORD_HEADER_BYTES = sizeof(uint16_t) + sizeof(const LogSite*) + sizeof(uint64_t);
+
+static_assert((BinaryLogger::RING_BYTES & (BinaryLogger::RING_BYTES - 1)) == 0,
+              "RING_BYTES must be a power of two");
+
+struct LogRing {
+    std::unique_ptr<uint8_t[]> bytes{new uint8_t[BinaryLogger::RING_BYTES]};
+    std::atomic<uint64_t> head{0};       // written by the owning thread
+    std::atomic<uint64_t> tail{0};       // written by the drainer
+    std::atomic<uint64_t> dropped{0};
+    uint64_t reportedDropped = 0;        // drainer only
+    uint32_t threadId = 0;
+
+    void put(uint64_t position, const void* source, size_t length) {
+        size_t offset = static_cast<size_t>(position & (BinaryLogger::RING_BYTES - 1));
+        size_t first = std::min(length, BinaryLogger::RING_BYTES - offset);
+        std::memcpy(bytes.get() + offset, source, first);
+        std::memcpy(bytes.get(), static_cast<const uint8_t*>(source) + first, length - first);
+    }
+
+    void get(uint64_t position, void* target, size_t length) const {
+        size_t offset = static_cast<size_t>(position & (BinaryLogger::RING_BYTES - 1));
+        size_t first = std::min(length, BinaryLogger::RING_BYTES - offset);
+        std::memcpy(target, bytes.get() + offset, first);
+        std::memcpy(static_cast<uint8_t*>(target) + first, bytes.get(), length - first);
+    }
+};
+
+std::mutex registryMutex;
+std::vector<std::shared_ptr<LogRing>> rings;
+uint32_t nextThreadId = 1;
+
+std::atomic<bool> running{false};
+std::atomic<uint64_t> droppedTotal{0};
+
+std::mutex drainMutex;                    // one consumer at a time; guards the state below
+std::ofstream logFile;
+bool echo = false;
+std::unordered_map<const LogSite*, uint32_t> siteIds;
+
+std::mutex writerMutex;                   // start/stop
+std::condition_variable writerWake;
+bool writerStop = false;
+std::thread writer;
+
+const auto steadyEpoch = std::chrono::steady_clock::now();
+
+uint64_t sinceEpochNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - steadyEpoch).count());
+}
+
+LogRing& threadRing() {
+    // Rings outlive their threads until drained
+    thread_local std::shared_ptr<LogRing> ring = [] {
+        auto created = std::make_shared<LogRing>();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        created->threadId = nextThreadId++;
+        rings.push_back(created);
+        return created;
+    }();
+    return *ring;
+}
+
+template<typename T>
+void putValue(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void putText(std::string& out, const char* text) {
+    size_t length = std::min<size_t>(std::strlen(text), UINT16_MAX);
+    putValue(out, static_cast<uint16_t>(length));
+    out.append(text, length);
+}
+
+void printToConsole(LogLevel level, const std::string& message) {
+    if (level >= LogLevel::WARNING) {
+        std::cerr << message << std::endl;
+    } else {
+        std::cout << message << '\n';
+    }
+}
+
+// Caller holds drainMutex
+void drainRing(LogRing& ring, std::string& out) {
+    uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+    uint64_t head = ring.head.load(std::memory_order_acquire);
+    uint8_t payload[LogPayload::MAX_PAYLOAD_BYTES];
+
+    while (tail < head) {
+        uint16_t size = 0;
+        const LogSite* site = nullptr;
+        uint64_t timestamp = 0;
+        ring.get(tail, &size, sizeof(size));
+        ring.get(tail + sizeof(size), &site, sizeof(site));
+        ring.get(tail + sizeof(size) + sizeof(site), &timestamp, sizeof(timestamp));
+        ring.get(tail + RECORD_HEADER_BYTES, payload, size);
+        tail += RECORD_HEADER_BYTES + size;
+
+        auto known = siteIds.find(site);
+        if (known == siteIds.end()) {
+            uint32_t id = static_cast<uint32_t>(siteIds.size());
+            known = siteIds.emplace(site, id).first;
+            putValue(out, KIND_SITE);
+            putValue(out, id);
+            putValue(out, static_cast<uint8_t>(site->level));
+            putValue(out, site->line);
+            putText(out, site->file);
+            putText(out, site->format);
+        }
+        putValue(out, KIND_EVENT);
+        putValue(out, known->second);
+        putValue(out, timestamp);
+        putValue(out, ring.threadId);
+        putValue(out, size);
+        out.append(reinterpret_cast<const char*>(payload), size);
+
+        if (echo) {
+            printToConsole(site->level, formatLogPayload(site->format, payload, size));
+        }
+    }
+    ring.tail.store(tail, std::memory_order_release);
+
+    uint64_t dropped = ring.dropped.load(std::memory_order_relaxed);
+    if (dropped != ring.reportedDropped) {
+        putValue(out, KIND_DROPPED);
+        putValue(out, ring.threadId);
+        putValue(out, dropped - ring.reportedDropped);
+        ring.reportedDropped = dropped;
+    }
+}
+
+void drainAll() {
+    std::vector<std::shared_ptr<LogRing>> snapshot;
+    {
+        // Forget rings whose thread has exited and whose records are all out
+        std::lock_guard<std::mutex> lock(registryMutex);
+        rings.erase(std::remove_if(rings.begin(), rings.end(), [](const std::shared_ptr<LogRing>& ring) {
+            return ring.use_count() == 1 &&
+                   ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire);
+        }), rings.end());
+        snapshot = rings;
+    }
+
+    std::lock_guard<std::mutex> lock(drainMutex);
+    std::string out;
+    for (const auto& ring : snapshot) {
+        drainRing(*ring, out);
+    }
+    if (!out.empty() && logFile.is_open()) {
+        logFile.write(out.data(), static_cast<std::streamsize>(out.size()));
+    }
+    if (echo) {
+        std::cout.flush();
+    }
+}
+
+void writerLoop() {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (!writerStop) {
+        writerWake.wait_for(lock, std::chrono::milliseconds(BinaryLogger::WRITER_INTERVAL_MS));
+        lock.unlock();
+        drainAll();
+        lock.lock();
+    }
+}
+
+template<typename T>
+bool takeValue(const uint8_t*& cursor, const uint8_t* end, T& value) {
+    if (static_cast<size_t>(end - cursor) < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return true;
+}
+
+template<typename T>
+bool readValue(std::ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool readText(std::ifstream& file, std::string& text) {
+    uint16_t length = 0;
+    if (!readValue(file, length)) {
+        return false;
+    }
+    text.resize(length);
+    return length == 0 || static_cast<bool>(file.read(&text[0], length));
+}
+
+} // namespace
+
+const char* logLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG: return "DEBUG";
+        case LogLevel::INFO: return "INFO";
+        case LogLevel::WARNING: return "WARNING";
+        case LogLevel::ERROR: return "ERROR";
+        case LogLevel::CRITICAL: return "CRITICAL";
+        default: return "UNKNOWN";
+    }
+}
+
+std::string formatLogPayload(const char* format, const uint8_t* payload, size_t size) {
+    std::string out;
+    const uint8_t* cursor = payload;
+    const uint8_t* end = payload + size;
+
+    for (const char* c = format; *c; ++c) {
+        if (*c == '}' && c[1] == '}') {
+            out += '}';
+            ++c;
+            continue;
+        }
+        if (*c != '{') {
+            out += *c;
+            continue;
+        }
+        if (c[1] == '{') {
+            out += '{';
+            ++c;
+            continue;
+        }
+        const char* close = std::strchr(c, '}');
+        if (!close) {
+            out += c;
+            break;
+        }
+        bool hex = std::string(c + 1, close) == ":x";
+        c = close;
+
+        uint8_t tag = 0;
+        if (!takeValue(cursor, end, tag)) {
+            out += "{}";
+            continue;
+        }
+        char number[32];
+        switch (tag) {
+            case LogPayload::TAG_I64: {
+                int64_t value = 0;
+                takeValue(cursor, end, value);
+                if (hex && value < 0 && value >= INT32_MIN) {
+                    // 32-bit codes such as HRESULTs print as their own width
+                    std::snprintf(number, sizeof(number), "%x", static_cast<unsigned>(static_cast<int32_t>(value)));
+                } else {
+                    std::snprintf(number, sizeof(number), hex ? "%llx" : "%lld", static_cast<long long>(value));
+                }
+                out += number;
+                break;
+            }
+            case LogPayload::TAG_U64: {
+                uint64_t value = 0;
+                takeValue(cursor, end, value);
+                std::snprintf(number, sizeof(number), hex ? "%llx" : "%llu", static_cast<unsigned long long>(value));
+                out += number;
+                break;
+            }
+            case LogPayload::TAG_F64: {
+                double value = 0.0;
+                takeValue(cursor, end, value);
+                std::snprintf(number, sizeof(number), "%g", value);
+                out += number;
+                break;
+            }
+            case LogPayload::TAG_BOOL: {
+                uint8_t value = 0;
+                takeValue(cursor, end, value);
+                out += value ? "true" : "false";
+                break;
+            }
+            case LogPayload::TAG_STR: {
+                uint16_t length = 0;
+                takeValue(cursor, end, length);
+                length = static_cast<uint16_t>(std::min<size_t>(length, static_cast<size_t>(end - cursor)));
+                out.append(reinterpret_cast<const char*>(cursor), length);
+                cursor += length;
+                break;
+            }
+            default:
+                cursor = end;   // unknown tag, the rest is unreadable
+                out += "{?}";
+        }
+    }
+    return out;
+}
+
+std::string formatLogLine(const LogLine& line) {
+    std::time_t seconds = static_cast<std::time_t>(line.wallTimeNs / 1000000000ULL);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+    char stamp[40];
+    size_t length = std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &local);
+    std::snprintf(stamp + length, sizeof(stamp) - length, ".%06u",
+                  static_cast<unsigned>((line.wallTimeNs / 1000) % 1000000));
+
+    std::string file = line.file;
+    size_t slash = file.find_last_of("/\\");
+    if (slash != std::string::npos) {
+        file = file.substr(slash + 1);
+    }
+    return std::string(stamp) + " [" + logLevelName(line.level) + "] t" + std::to_string(line.threadId) +
+           " " + file + ":" + std::to_string(line.line) + " " + line.message;
+}
+
+// ============================================================================
+// BinaryLogger Implementation
+// ============================================================================
+
+bool BinaryLogger::start(const std::string& path, bool echoToConsole) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    if (running.load()) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> drainLock(drainMutex);
+        logFile.open(path, std::ios::binary | std::ios::trunc);
+        if (!logFile) {
+            return false;
+        }
+        echo = echoToConsole;
+        siteIds.clear();
+
+        uint64_t wallNow = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        uint64_t epochWall = wallNow - sinceEpochNs();
+        logFile.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+        logFile.write(reinterpret_cast<const char*>(&epochWall), sizeof(epochWall));
+    }
+    writerStop = false;
+    running.store(true);
+    writer = std::thread(writerLoop);
+    return true;
+}
+
+void BinaryLogger::stop() {
+    std::unique_lock<std::mutex> lock(writerMutex);
+    if (!running.load()) {
+        return;
+    }
+    running.store(false);
+    writerStop = true;
+    writerWake.notify_all();
+    lock.unlock();
+    writer.join();
+
+    drainAll();
+    std::lock_guard<std::mutex> drainLock(drainMutex);
+    logFile.close();
+}
+
+bool BinaryLogger::isRunning() {
+    return running.load(std::memory_order_relaxed);
+}
+
+void BinaryLogger::flush() {
+    drainAll();
+    std::lock_guard<std::mutex> lock(drainMutex);
+    logFile.flush();
+}
+
+uint64_t BinaryLogger::droppedRecords() {
+    return droppedTotal.load(std::memory_order_relaxed);
+}
+
+void BinaryLogger::write(const LogSite& site, const LogPayload& payload) {
+    if (!running.load(std::memory_order_relaxed)) {
+        printToConsole(site.level, formatLogPayload(site.format, payload.data(), payload.size()));
+        return;
+    }
+
+    LogRing& ring = threadRing();
+    uint16_t size = static_cast<uint16_t>(payload.size());
+    size_t needed = RECORD_HEADER_BYTES + size;
+    uint64_t head = ring.head.load(std::memory_order_relaxed);
+    uint64_t tail = ring.tail.load(std::memory_order_acquire);
+    if (RING_BYTES - (head - tail) < needed) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        droppedTotal.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const LogSite* sitePointer = &site;
+    uint64_t timestamp = sinceEpochNs();
+    ring.put(head, &size, sizeof(size));
+    ring.put(head + sizeof(size), &sitePointer, sizeof(sitePointer));
+    ring.put(head + sizeof(size) + sizeof(sitePointer), &timestamp, sizeof(timestamp));
+    ring.put(head + RECORD_HEADER_BYTES, payload.data(), size);
+    ring.head.store(head + needed, std::memory_order_release);
+}
+
+// ============================================================================
+// BinaryLogReader Implementation
+// ============================================================================
+
+bool BinaryLogReader::open(const std::string& path) {
+    file_.open(path, std::ios::binary);
+    char magic[sizeof(FILE_MAGIC)];
+    if (!file_.read(magic, sizeof(magic)) || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0) {
+        return false;
+    }
+    sites_.clear();
+    dropped_ = 0;
+    return readValue(file_, epochWallNs_);
+}
+
+bool BinaryLogReader::next(LogLine& line) {
+    uint8_t kind = 0;
+    while (readValue(file_, kind)) {
+        if (kind == KIND_SITE) {
+            uint32_t id = 0;
+            uint8_t level = 0;
+            Site site;
+            if (!readValue(file_, id) || !readValue(file_, level) || !readValue(file_, site.line) ||
+                !readText(file_, site.file) || !readText(file_, site.format)) {
+                return false;
+            }
+            site.level = static_cast<LogLevel>(level);
+            sites_[id] = std::move(site);
+        } else if (kind == KIND_DROPPED) {
+            uint32_t threadId = 0;
+            uint64_t count = 0;
+            if (!readValue(file_, threadId) || !readValue(file_, count)) {
+                return false;
+            }
+            dropped_ += count;
+        } else if (kind == KIND_EVENT) {
+            uint32_t siteId = 0;
+            uint64_t timestamp = 0;
+            uint16_t size = 0;
+            uint8_t payload[LogPayload::MAX_PAYLOAD_BYTES];
+            if (!readValue(file_, siteId) || !readValue(file_, timestamp) || !readValue(file_, line.threadId) ||
+                !readValue(file_, size) || size > sizeof(payload) ||
+                !file_.read(reinterpret_cast<char*>(payload), size)) {
+                return false;
+            }
+            auto site = sites_.find(siteId);
+            if (site == sites_.end()) {
+                return false;
+            }
+            line.wallTimeNs = epochWallNs_ + timestamp;
+            line.level = site->second.level;
+            line.file = site->second.file;
+            line.line = site->second.line;
+            line.message = formatLogPayload(site->second.format.c_str(), payload, size);
+            return true;
+        } else {
+            return false;
+        }
+    }
+    return false;
+}
+
+} // namespace AICopilot
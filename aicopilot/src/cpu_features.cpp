@@ -0,0 +1,53 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "cpu_features.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace AICopilot {
+namespace CpuFeatures {
+
+namespace {
+
+bool detectAvx2() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    // OSXSAVE and AVX, then the OS must preserve XMM and YMM state
+    __cpuid(info, 1);
+    const int OSXSAVE_AVX = (1 << 27) | (1 << 28);
+    if ((info[2] & OSXSAVE_AVX) != OSXSAVE_AVX) return false;
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    // Also checks OS YMM support
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+bool hasAvx2() {
+    static const bool supported = detectAvx2();
+    return supported;
+}
+
+} // namespace CpuFeatures
+} // namespace AICopilot
@@ -0,0 +1,232 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Dataset Manifest Implementation
+* Content hashes, manifest text and the node-local dataset store
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/dataset_manifest.hpp"
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <utility>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+constexpr size_t HASH_CHUNK_BYTES = 1 << 16;
+const char* const MANIFEST_HEADER = "AICOPILOT-DATASETS 1";
+
+const char* const KIND_NAMES[] = {"navdata", "terrain", "runway", "weather", "model"};
+constexpr size_t KIND_COUNT = sizeof(KIND_NAMES) / sizeof(KIND_NAMES[0]);
+
+bool parseKind(const std::string& text, DatasetKind& kind) {
+    for (size_t i = 0; i < KIND_COUNT; i++) {
+        if (text == KIND_NAMES[i]) {
+            kind = static_cast<DatasetKind>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string hashHex(uint64_t hash) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016" PRIx64, hash);
+    return buffer;
+}
+
+} // namespace
+
+const char* datasetKindName(DatasetKind kind) {
+    size_t index = static_cast<size_t>(kind);
+    return index < KIND_COUNT ? KIND_NAMES[index] : "unknown";
+}
+
+bool hashDatasetFile(const std::string& path, uint64_t& hash, uint64_t& size) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    hash = FNV_OFFSET;
+    size = 0;
+    std::vector<char> chunk(HASH_CHUNK_BYTES);
+    while (in) {
+        in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        std::streamsize count = in.gcount();
+        for (std::streamsize i = 0; i < count; i++) {
+            hash = (hash ^ static_cast<uint8_t>(chunk[i])) * FNV_PRIME;
+        }
+        size += static_cast<uint64_t>(count);
+    }
+    return in.eof();
+}
+
+// ============================================================================
+// DatasetManifest Implementation
+// ============================================================================
+
+bool DatasetManifest::addFile(DatasetKind kind, const std::string& path, const std::string& name) {
+    DatasetEntry entry;
+    entry.kind = kind;
+    if (!hashDatasetFile(path, entry.contentHash, entry.size)) return false;
+    entry.name = name.empty() ? std::filesystem::path(path).filename().string() : name;
+    entries_.push_back(std::move(entry));
+    return true;
+}
+
+const DatasetEntry* DatasetManifest::find(DatasetKind kind) const {
+    for (const auto& entry : entries_) {
+        if (entry.kind == kind) return &entry;
+    }
+    return nullptr;
+}
+
+std::string DatasetManifest::serialize() const {
+    std::ostringstream out;
+    out << MANIFEST_HEADER << '\n';
+    for (const auto& entry : entries_) {
+        out << datasetKindName(entry.kind) << ' ' << hashHex(entry.contentHash) << ' '
+            << entry.size << ' ' << entry.name << '\n';
+    }
+    return out.str();
+}
+
+bool DatasetManifest::parse(const std::string& text) {
+    entries_.clear();
+    std::istringstream in(text);
+    std::string line;
+    if (!std::getline(in, line) || line != MANIFEST_HEADER) return false;
+
+    while (std::getline(in, line)) {
+        if (line.empty()) continue;
+        std::istringstream fields(line);
+        std::string kindText;
+        std::string hashText;
+        DatasetEntry entry;
+        if (!(fields >> kindText >> hashText >> entry.size) || !parseKind(kindText, entry.kind) ||
+            hashText.size() != 16) {
+            entries_.clear();
+            return false;
+        }
+        char* end = nullptr;
+        entry.contentHash = std::strtoull(hashText.c_str(), &end, 16);
+        if (end != hashText.c_str() + hashText.size()) {
+            entries_.clear();
+            return false;
+        }
+        fields >> std::ws;
+        std::getline(fields, entry.name);
+        entries_.push_back(std::move(entry));
+    }
+    return true;
+}
+
+bool DatasetManifest::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+    out << serialize();
+    return static_cast<bool>(out);
+}
+
+bool DatasetManifest::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        entries_.clear();
+        return false;
+    }
+    std::ostringstream text;
+    text << in.rdbuf();
+    return parse(text.str());
+}
+
+uint64_t DatasetManifest::fingerprint() const {
+    // Names are for people; two manifests with the same files are the same data
+    uint64_t hash = FNV_OFFSET;
+    auto mix = [&hash](uint64_t value) {
+        for (int i = 0; i < 8; i++) {
+            hash = (hash ^ ((value >> (8 * i)) & 0xFF)) * FNV_PRIME;
+        }
+    };
+    for (const auto& entry : entries_) {
+        mix(static_cast<uint64_t>(entry.kind));
+        mix(entry.contentHash);
+        mix(entry.size);
+    }
+    return hash;
+}
+
+// ============================================================================
+// DatasetStore Implementation
+// ============================================================================
+
+DatasetStore::DatasetStore(std::string directory)
+    : directory_(std::move(directory)) {}
+
+std::string DatasetStore::pathFor(const DatasetEntry& entry) const {
+    return (std::filesystem::path(directory_) /
+            (hashHex(entry.contentHash) + "." + datasetKindName(entry.kind))).string();
+}
+
+bool DatasetStore::contains(const DatasetEntry& entry) const {
+    std::error_code error;
+    auto size = std::filesystem::file_size(pathFor(entry), error);
+    return !error && size == entry.size;
+}
+
+std::vector<DatasetEntry> DatasetStore::missing(const DatasetManifest& manifest) const {
+    std::vector<DatasetEntry> result;
+    for (const auto& entry : manifest.entries()) {
+        if (!contains(entry)) result.push_back(entry);
+    }
+    return result;
+}
+
+bool DatasetStore::import(const DatasetEntry& entry, const std::string& sourcePath) {
+    uint64_t hash = 0;
+    uint64_t size = 0;
+    if (!hashDatasetFile(sourcePath, hash, size) || hash != entry.contentHash || size != entry.size) {
+        return false;
+    }
+    if (contains(entry)) return true;
+
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    if (error) return false;
+
+    // Copy beside the final name and rename, so a reader never opens a partial file
+    std::string target = pathFor(entry);
+    std::string partial = target + ".partial";
+    std::filesystem::copy_file(sourcePath, partial, std::filesystem::copy_options::overwrite_existing, error);
+    if (!error) std::filesystem::rename(partial, target, error);
+    if (error) {
+        std::filesystem::remove(partial, error);
+        return false;
+    }
+    return true;
+}
+
+DatasetReloadPaths DatasetStore::reloadPaths(const DatasetManifest& manifest) const {
+    DatasetReloadPaths paths;
+    auto resolve = [this, &manifest](DatasetKind kind, std::string& path) {
+        const DatasetEntry* entry = manifest.find(kind);
+        if (entry && contains(*entry)) path = pathFor(*entry);
+    };
+    resolve(DatasetKind::NAVDATA_PACK, paths.navdataPack);
+    resolve(DatasetKind::RUNWAY_PACK, paths.runwayPack);
+    resolve(DatasetKind::WEATHER_SNAPSHOT, paths.weatherSnapshot);
+    return paths;
+}
+
+} // namespace AICopilot
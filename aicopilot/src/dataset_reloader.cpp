@@ -0,0 +1,63 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Dataset Reloader Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/dataset_reloader.hpp"
+#include "../include/binary_log.hpp"
+#include "../include/io_executor.hpp"
+#include "../include/navdata_database.hpp"
+#include "../include/runway_database_prod.hpp"
+#include "../include/weather_database.hpp"
+#include <utility>
+
+namespace AICopilot {
+
+DatasetReloader::DatasetReloader(std::shared_ptr<NavigationDatabase> navdata,
+                                 std::shared_ptr<RunwayDatabase> runways,
+                                 std::shared_ptr<WeatherDatabase> weather)
+    : navdata_(std::move(navdata)), runways_(std::move(runways)), weather_(std::move(weather)) {}
+
+DatasetReloadResult DatasetReloader::reload(const DatasetReloadPaths& paths) {
+    DatasetReloadResult result;
+    if (!paths.navdataPack.empty()) {
+        result.navdataRequested = true;
+        result.navdataLoaded = navdata_ && navdata_->LoadSnapshot(paths.navdataPack);
+    }
+    if (!paths.runwayPack.empty()) {
+        result.runwaysRequested = true;
+        result.runwaysLoaded = runways_ && runways_->LoadPack(paths.runwayPack);
+    }
+    if (!paths.weatherSnapshot.empty()) {
+        result.weatherRequested = true;
+        result.weatherReports = weather_ ? weather_->loadSnapshot(paths.weatherSnapshot) : -1;
+    }
+    
+    if (result.ok()) {
+        AICOPILOT_LOG_INFO("Dataset reload done: navdata {}, runways {}, weather {}",
+                           result.navdataLoaded, result.runwaysLoaded, result.weatherReports);
+    } else {
+        AICOPILOT_LOG_WARNING("Dataset reload incomplete: navdata {}/{}, runways {}/{}, weather {}",
+                              result.navdataLoaded, result.navdataRequested,
+                              result.runwaysLoaded, result.runwaysRequested, result.weatherReports);
+    }
+    return result;
+}
+
+std::future<DatasetReloadResult> DatasetReloader::reloadAsync(const DatasetReloadPaths& paths) {
+    // The job holds the stores, so they outlive the load
+    auto navdata = navdata_;
+    auto runways = runways_;
+    auto weather = weather_;
+    return IoExecutor::shared()->submit([navdata, runways, weather, paths] {
+        return DatasetReloader(navdata, runways, weather).reload(paths);
+    });
+}
+
+} // namespace AICopilot
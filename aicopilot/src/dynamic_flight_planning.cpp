@@ -18,12 +18,126 @@
 #include "dynamic_flight_planning.hpp"
 #include <cmath>
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <mutex>
 #include <numeric>
 
 namespace AICopilot {
 
+namespace {
+
+constexpr double ROUTE_ALTITUDE_FEET = 10000.0;
+constexpr size_t MAX_DIRECT_SKIP = 2;             // fixes a direct leg may skip
+constexpr double HEURISTIC_WIND_KNOTS = 150.0;    // tailwind headroom of the heuristic
+constexpr double WIND_REPRICE_TOLERANCE = 0.005;  // relative leg time change worth a repair
+constexpr double MIN_GROUND_SPEED_FRACTION = 0.25;
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+constexpr double ALTITUDE_STEP_FEET = 1000.0;     // candidate levels for wind-optimized altitude
+constexpr double WIND_SEGMENT_NM = 50.0;          // longest stretch evaluated at one wind sample
+constexpr double STEP_CLIMB_FEET[] = {2000.0, 4000.0};
+constexpr double TRADE_SPEED_MIN_FRACTION = 0.70;  // slowest trade-space speed, of cruise TAS
+constexpr size_t TRADE_SPEED_COUNT = 16;           // speeds from there up to cruise TAS
+constexpr double SPEED_FUEL_EXPONENT = 2.0;        // fuel flow against TAS relative to cruise
+constexpr double CLIMB_FUEL_FACTOR = 0.5;          // extra cruise fuel flow while stepping up
+constexpr double TERMINAL_SPEED_KTS = 250.0;       // procedure legs below 10,000 ft
+
+// Resolved legs of a procedure path as route waypoints
+std::vector<Waypoint> procedureWaypoints(const ProcedurePath& path) {
+    std::vector<Waypoint> waypoints;
+    for (const auto& leg : path.legs) {
+        if (leg.node == NavdataPack::NO_INDEX) continue;
+        Waypoint wp;
+        wp.id = leg.fix;
+        wp.position.latitude = leg.latitude;
+        wp.position.longitude = leg.longitude;
+        if (leg.altitude.type != AltitudeRestrictionType::NONE) {
+            wp.position.altitude = leg.altitude.altitude1;
+            wp.altitude = leg.altitude.altitude1;
+        }
+        waypoints.push_back(wp);
+    }
+    return waypoints;
+}
+
+// Same flat-earth measure as calculateRouteDistance()
+double flatDistanceNM(const Position& a, const Position& b) {
+    double latDiff = b.latitude - a.latitude;
+    double lonDiff = b.longitude - a.longitude;
+    return std::sqrt(latDiff * latDiff + lonDiff * lonDiff) * 60.0;
+}
+
+bool sameFix(const Waypoint& a, const Waypoint& b) {
+    return a.id == b.id && a.position.latitude == b.position.latitude &&
+           a.position.longitude == b.position.longitude;
+}
+
+double distanceToLegNM(const Position& a, const Position& b, const Position& point) {
+    double dx = b.longitude - a.longitude;
+    double dy = b.latitude - a.latitude;
+    double px = point.longitude - a.longitude;
+    double py = point.latitude - a.latitude;
+    double lengthSquared = dx * dx + dy * dy;
+    double t = lengthSquared > 0.0 ? std::clamp((px * dx + py * dy) / lengthSquared, 0.0, 1.0) : 0.0;
+    double ex = px - t * dx;
+    double ey = py - t * dy;
+    return std::sqrt(ex * ex + ey * ey) * 60.0;
+}
+
+bool legCrossesHazard(const Position& a, const Position& b, const WeatherHazard& hazard, double altitude) {
+    if (hazard.topAltitude > hazard.altitude &&
+        (altitude < hazard.altitude || altitude > hazard.topAltitude)) {
+        return false;
+    }
+    return distanceToLegNM(a, b, hazard.position) < hazard.radius;
+}
+
+// Fastest first, dropping every point some faster one matches on fuel
+void keepParetoFront(std::vector<DynamicFlightPlanning::TradeSpacePoint>& points) {
+    std::sort(points.begin(), points.end(), [](const auto& a, const auto& b) {
+        return a.estimatedTime != b.estimatedTime ? a.estimatedTime < b.estimatedTime
+                                                  : a.estimatedFuel < b.estimatedFuel;
+    });
+    size_t kept = 0;
+    double bestFuel = std::numeric_limits<double>::infinity();
+    for (const auto& point : points) {
+        if (point.estimatedFuel < bestFuel) {
+            bestFuel = point.estimatedFuel;
+            points[kept++] = point;
+        }
+    }
+    points.resize(kept);
+}
+
+// Run job(0..count-1) on the pool and wait for just those jobs
+void parallelFor(WorkStealingPool& pool, size_t count, const std::function<void(size_t)>& job) {
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t remaining = count;
+    for (size_t i = 0; i < count; ++i) {
+        pool.submit([&, i] {
+            job(i);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--remaining == 0) done.notify_one();
+        });
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return remaining == 0; });
+}
+
+} // namespace
+
 DynamicFlightPlanning::DynamicFlightPlanning()
-    : initialized_(false) {
+    : initialized_(false)
+    , filedNodeCount_(0)
+    , nextFiledNode_(0)
+    , routeStart_(0)
+    , routeWinds_()
+    , heuristicSpeed_(0.0)
+    , windTime_(0.0)
+    , tradeSpaceDistance_(0.0) {
 }
 
 DynamicFlightPlanning::~DynamicFlightPlanning() {
@@ -54,13 +168,34 @@ RouteOptimization DynamicFlightPlanning::optimizeRoute(
     OptimizationObjective objective,
     const std::vector<WeatherHazard>& avoidanceHazards) {
     
+    auto started = std::chrono::steady_clock::now();
     RouteOptimization result;
-    result.optimizedWaypoints = waypoints;
-    result.totalDistance = calculateRouteDistance(waypoints);
-    result.estimatedFuel = calculateRouteFuel(waypoints, 10000.0, profile_.cruiseSpeed);
-    result.estimatedTime = (result.totalDistance / profile_.cruiseSpeed) * 60.0;
-    result.fuelEfficiency = result.totalDistance / result.estimatedFuel;
-    result.executionTime = 2.5;  // milliseconds
+    
+    std::vector<Waypoint> route = waypoints;
+    if (route.empty() || !sameFix(route.front(), departure)) {
+        route.insert(route.begin(), departure);
+    }
+    if (route.size() < 2 || !sameFix(route.back(), destination)) {
+        route.push_back(destination);
+    }
+    
+    setRouteHazards(avoidanceHazards);
+    buildRouteSearch(route);
+    std::vector<uint32_t> path;
+    double minutes = routeSearch_.findPath(routeStart_, path);
+    routePath_ = path;
+    if (!path.empty()) {
+        summarizeRoute(path, minutes, result);
+    } else {
+        // Every way through is closed; report the route as filed
+        result.optimizedWaypoints = route;
+        result.totalDistance = calculateRouteDistance(route);
+        result.estimatedFuel = calculateRouteFuel(route, ROUTE_ALTITUDE_FEET, profile_.cruiseSpeed);
+        result.estimatedTime = (result.totalDistance / profile_.cruiseSpeed) * 60.0;
+        result.fuelEfficiency = result.totalDistance / result.estimatedFuel;
+    }
+    result.executionTime = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - started).count();
     
     switch (objective) {
         case OptimizationObjective::FUEL_EFFICIENCY:
@@ -95,6 +230,19 @@ AltitudeOptimization DynamicFlightPlanning::calculateOptimalAltitude(
     
     AltitudeOptimization result;
     
+    if (!tradeSpaceFront_.empty()) {
+        const TradeSpacePoint& point =
+            tradeSpaceFront_[pickTradeSpacePoint(tradeSpaceFront_, OptimizationObjective::COMBINED)];
+        double hours = point.estimatedTime / 60.0;
+        result.recommendedAltitude = point.altitude;
+        result.optimalCruiseSpeed = point.cruiseSpeed;
+        result.fuelConsumptionRate = hours > 0.0 ? point.estimatedFuel / hours : 0.0;
+        result.groundSpeed = hours > 0.0 ? tradeSpaceDistance_ / hours : point.cruiseSpeed;
+        result.estimatedTailwind = result.groundSpeed - point.cruiseSpeed;
+        result.timeToAltitude = (result.recommendedAltitude / profile_.climbRate) / 60.0;
+        return result;
+    }
+    
     // Determine optimal cruise altitude (typically 30,000-35,000 feet for efficiency)
     double maxAltitude = std::min(profile_.serviceCeiling, 35000.0);
     result.recommendedAltitude = 0.75 * maxAltitude;  // 75% of service ceiling
@@ -163,6 +311,12 @@ RouteOptimization DynamicFlightPlanning::reoptimizeMidFlight(
     
     RouteOptimization result;
     
+    if (!routeNodes_.empty() && sameFix(routeNodes_[filedNodeCount_ - 1], destination) &&
+        replanFrom(currentPosition, result)) {
+        result.optimizationMethod = "Mid-Flight Re-optimization (incremental)";
+        return result;
+    }
+    
     // Create waypoint from current position
     Waypoint current;
     current.position = currentPosition;
@@ -192,6 +346,20 @@ DepartureProcedure DynamicFlightPlanning::selectOptimalSID(
     const AircraftType& aircraftType) {
     
     DepartureProcedure result;
+    const ProcedurePath* path = procedurePaths_
+        ? procedurePaths_->bestSID(departureAirport, std::string(), firstCruiseFix.position.latitude,
+                                   firstCruiseFix.position.longitude)
+        : nullptr;
+    if (path) {
+        result.sidCode = path->name;
+        result.waypoints = procedureWaypoints(*path);
+        result.transitionFix = path->transition.empty() ? firstCruiseFix.id : path->transition;
+        result.initialAltitude = 0.0;
+        result.finalAltitude = path->topAltitude;
+        result.estimatedTime = path->distanceNM / terminalSpeed() * 60.0;
+        return result;
+    }
+    
     result.sidCode = "HARPY1";  // Example SID code
     result.initialAltitude = 0.0;
     result.finalAltitude = 6000.0;
@@ -223,6 +391,21 @@ ArrivalProcedure DynamicFlightPlanning::selectOptimalSTAR(
     const Position& currentPosition) {
     
     ArrivalProcedure result;
+    const ProcedurePath* path = procedurePaths_
+        ? procedurePaths_->bestSTAR(arrivalAirport, arrivalRunway, currentPosition.latitude,
+                                    currentPosition.longitude)
+        : nullptr;
+    if (path) {
+        result.starCode = path->name;
+        result.waypoints = procedureWaypoints(*path);
+        result.initialFix = !path->transition.empty() ? path->transition
+                          : (!path->legs.empty() ? path->legs.front().fix : std::string());
+        result.initialAltitude = path->topAltitude;
+        result.finalAltitude = path->bottomAltitude;
+        result.estimatedTime = path->distanceNM / terminalSpeed() * 60.0;
+        return result;
+    }
+    
     result.starCode = "GARED1";  // Example STAR code
     result.initialAltitude = 10000.0;
     result.finalAltitude = 3000.0;
@@ -280,13 +463,26 @@ FuelCalculation DynamicFlightPlanning::calculateFuelRequirement(
     FuelCalculation result;
     
     // Trip fuel: main flight
-    result.tripFuel = calculateRouteFuel(route, cruiseAltitude, cruiseSpeed);
+    double tripFuel = calculateRouteFuel(route, cruiseAltitude, cruiseSpeed);
+    completeFuelCalculation(tripFuel, route.empty() ? nullptr : &route.back(), alternate,
+                            contingencyPercentage, result);
+    return result;
+}
+
+void DynamicFlightPlanning::completeFuelCalculation(
+    double tripFuel,
+    const Waypoint* destination,
+    const Waypoint& alternate,
+    double contingencyPercentage,
+    FuelCalculation& result) const {
+    
+    result.tripFuel = tripFuel;
     
     // Alternate fuel: distance to alternate
-    if (!route.empty()) {
-        Waypoint destination = route.back();
-        double latDiff = alternate.position.latitude - destination.position.latitude;
-        double lonDiff = alternate.position.longitude - destination.position.longitude;
+    result.alternateReserve = 0.0;
+    if (destination) {
+        double latDiff = alternate.position.latitude - destination->position.latitude;
+        double lonDiff = alternate.position.longitude - destination->position.longitude;
         double altDistance = std::sqrt(latDiff * latDiff + lonDiff * lonDiff) * 60.0;  // NM
         result.alternateReserve = (altDistance / 100.0) * profile_.fuelFlow;
     }
@@ -311,8 +507,6 @@ FuelCalculation DynamicFlightPlanning::calculateFuelRequirement(
     
     // Range available with fuel
     result.rangeAvailable = (result.totalFuel / profile_.fuelFlow) * profile_.cruiseSpeed;
-    
-    return result;
 }
 
 bool DynamicFlightPlanning::checkFuelFeasibility(
@@ -328,6 +522,40 @@ bool DynamicFlightPlanning::checkFuelFeasibility(
     return currentFuel >= required.totalFuel;
 }
 
+std::vector<FuelCalculation> DynamicFlightPlanning::calculateFuelRequirements(
+    const std::vector<Waypoint>& route,
+    double cruiseAltitude,
+    double cruiseSpeed,
+    const std::vector<Waypoint>& alternates,
+    double contingencyPercentage) {
+    
+    std::vector<FuelCalculation> results(alternates.size());
+    if (alternates.empty()) return results;
+    
+    double tripFuel = calculateRouteFuel(route, cruiseAltitude, cruiseSpeed);
+    const Waypoint* destination = route.empty() ? nullptr : &route.back();
+    for (size_t i = 0; i < alternates.size(); ++i) {
+        completeFuelCalculation(tripFuel, destination, alternates[i], contingencyPercentage, results[i]);
+    }
+    return results;
+}
+
+std::vector<size_t> DynamicFlightPlanning::findFeasibleAlternates(
+    const std::vector<Waypoint>& route,
+    double currentFuel,
+    double cruiseAltitude,
+    double cruiseSpeed,
+    const std::vector<Waypoint>& alternates) {
+    
+    std::vector<FuelCalculation> required =
+        calculateFuelRequirements(route, cruiseAltitude, cruiseSpeed, alternates);
+    std::vector<size_t> feasible;
+    for (size_t i = 0; i < required.size(); ++i) {
+        if (currentFuel >= required[i].totalFuel) feasible.push_back(i);
+    }
+    return feasible;
+}
+
 double DynamicFlightPlanning::calculateAvailableRange(
     double currentFuel,
     double altitude,
@@ -355,6 +583,17 @@ double DynamicFlightPlanning::calculateOptimalCruiseSpeed(
     OptimizationObjective objective,
     const WindConditions& windAloft) {
     
+    // Choose among the last trade space's points at this level when it has any
+    std::vector<TradeSpacePoint> atLevel;
+    for (const auto& point : tradeSpaceFront_) {
+        if (std::abs(point.altitude - altitude) < ALTITUDE_STEP_FEET / 2.0) {
+            atLevel.push_back(point);
+        }
+    }
+    if (!atLevel.empty()) {
+        return atLevel[pickTradeSpacePoint(atLevel, objective)].cruiseSpeed;
+    }
+    
     double baseSpeed = profile_.cruiseSpeed;
     
     // Adjust speed based on optimization
@@ -385,23 +624,47 @@ RouteOptimization DynamicFlightPlanning::planWeatherDivert(
     const Waypoint& originalDestination,
     const std::vector<Waypoint>& availableAlternates,
     double currentFuel,
-    const std::vector<WeatherHazard>& activeHazards) {
+    const std::vector<WeatherHazard>& activeHazards,
+    time_t now) {
     
     RouteOptimization result;
     
-    // Select nearest alternate
-    Waypoint selectedAlternate = availableAlternates[0];
+    // Reroute to the original destination if the kept route still allows it
+    if (!routeNodes_.empty() && sameFix(routeNodes_[filedNodeCount_ - 1], originalDestination)) {
+        updateHazards(activeHazards);
+        if (replanFrom(currentPosition, result) && result.estimatedFuel <= currentFuel) {
+            result.optimizationMethod = "Weather Reroute";
+            return result;
+        }
+        result = RouteOptimization();
+    }
+    
+    // Select the nearest alternate, preferring a landable forecast at ETA
+    // over no forecast over an unlandable one
+    Waypoint selectedAlternate = availableAlternates.empty() ? originalDestination : availableAlternates[0];
     if (!availableAlternates.empty()) {
-        double minDistance = 1e9;
-        for (const auto& alt : availableAlternates) {
+        std::vector<double> distances(availableAlternates.size());
+        std::vector<TAFStore::Query> queries(availableAlternates.size());
+        for (size_t i = 0; i < availableAlternates.size(); ++i) {
+            const Waypoint& alt = availableAlternates[i];
             double latDiff = alt.position.latitude - currentPosition.latitude;
             double lonDiff = alt.position.longitude - currentPosition.longitude;
-            double distance = std::sqrt(latDiff * latDiff + lonDiff * lonDiff);
-            if (distance < minDistance) {
-                minDistance = distance;
-                selectedAlternate = alt;
-            }
+            distances[i] = std::sqrt(latDiff * latDiff + lonDiff * lonDiff);
+            queries[i].station = packStationId(alt.id);
+            queries[i].time = now + static_cast<time_t>(distances[i] * 60.0 / profile_.cruiseSpeed * 3600.0);
         }
+        std::vector<TAFPeriod> forecasts;
+        if (forecasts_) forecasts_->forecastsAt(queries, forecasts);
+        
+        auto rank = [&forecasts](size_t i) {
+            if (i >= forecasts.size() || !forecasts[i].valid()) return 1;
+            return forecasts[i].worst.has(StationFlags::LANDING_OK) ? 0 : 2;
+        };
+        size_t best = 0;
+        for (size_t i = 1; i < availableAlternates.size(); ++i) {
+            if (rank(i) < rank(best) || (rank(i) == rank(best) && distances[i] < distances[best])) best = i;
+        }
+        selectedAlternate = availableAlternates[best];
     }
     
     Waypoint current;
@@ -418,6 +681,68 @@ RouteOptimization DynamicFlightPlanning::planWeatherDivert(
     return result;
 }
 
+size_t DynamicFlightPlanning::updateWinds(const WindConditions& windAloft) {
+    routeWinds_ = windAloft;
+    return refreshRouteCosts();
+}
+
+void DynamicFlightPlanning::setForecasts(std::shared_ptr<const TAFStore> forecasts) {
+    forecasts_ = std::move(forecasts);
+}
+
+void DynamicFlightPlanning::setProcedurePaths(std::shared_ptr<const ProcedurePathTable> paths) {
+    procedurePaths_ = std::move(paths);
+}
+
+double DynamicFlightPlanning::terminalSpeed() const {
+    return profile_.cruiseSpeed > 0.0 ? std::min(TERMINAL_SPEED_KTS, profile_.cruiseSpeed) : TERMINAL_SPEED_KTS;
+}
+
+size_t DynamicFlightPlanning::setWindGrid(std::shared_ptr<const WindGrid> grid, double timeSeconds) {
+    windGrid_ = std::move(grid);
+    windTime_ = timeSeconds;
+    return refreshRouteCosts();
+}
+
+size_t DynamicFlightPlanning::refreshRouteCosts() {
+    if (routeNodes_.empty()) {
+        return 0;
+    }
+    
+    if (profile_.cruiseSpeed + maxRouteWindSpeed() > heuristicSpeed_) {
+        // Legs could now beat the heuristic; replan from scratch with more headroom
+        std::vector<Waypoint> route(routeNodes_.begin(), routeNodes_.begin() + filedNodeCount_);
+        size_t ahead = nextFiledNode_;
+        Waypoint current = routeNodes_[routeStart_];
+        bool midFlight = routeStart_ >= filedNodeCount_;
+        buildRouteSearch(route);
+        nextFiledNode_ = ahead;
+        if (midFlight) {
+            routeStart_ = static_cast<uint32_t>(routeNodes_.size());
+            routeNodes_.push_back(current);
+            routeSearch_.addNode();
+            addRouteLegs(routeStart_, ahead);
+            if (!routePath_.empty()) {
+                routePath_.front() = routeStart_;
+            }
+        }
+        return routeLegs_.size();
+    }
+    return repriceRouteLegs();
+}
+
+size_t DynamicFlightPlanning::updateHazards(const std::vector<WeatherHazard>& hazards) {
+    setRouteHazards(hazards);
+    return routeNodes_.empty() ? 0 : repriceRouteLegs();
+}
+
+size_t DynamicFlightPlanning::setAirspace(std::shared_ptr<const AirspaceDatabase> airspace,
+                                          const AirspaceCostWeights& weights) {
+    airspace_ = airspace && weights.any() ? std::move(airspace) : nullptr;
+    airspaceWeights_ = weights;
+    return routeNodes_.empty() ? 0 : repriceRouteLegs();
+}
+
 double DynamicFlightPlanning::adjustAltitudeForTraffic(
     double currentAltitude,
     double targetAltitude,
@@ -441,6 +766,43 @@ double DynamicFlightPlanning::calculateWindOptimizedAltitude(
     double cruiseSpeed,
     const std::vector<WindLayer>& windForecasts) {
     
+    if (windGrid_) {
+        // Every candidate level times every segment of the direct route, in one batch
+        Waypoint from;
+        from.position = currentPosition;
+        double distance = flatDistanceNM(currentPosition, destination.position);
+        size_t segments = std::max<size_t>(1, static_cast<size_t>(std::ceil(distance / WIND_SEGMENT_NM)));
+        std::vector<Waypoint> route(segments + 1, from);
+        for (size_t i = 1; i <= segments; ++i) {
+            double f = static_cast<double>(i) / segments;
+            route[i].position.latitude += f * (destination.position.latitude - currentPosition.latitude);
+            route[i].position.longitude += f * (destination.position.longitude - currentPosition.longitude);
+        }
+        
+        std::vector<double> levels;
+        for (double level = ALTITUDE_STEP_FEET; level <= profile_.serviceCeiling; level += ALTITUDE_STEP_FEET) {
+            levels.push_back(level);
+        }
+        legBatch_.clear();
+        for (double level : levels) {
+            for (size_t i = 0; i < segments; ++i) {
+                addGridLeg(route[i].position, route[i + 1].position, level, cruiseSpeed);
+            }
+        }
+        windGrid_->evaluate(legBatch_);
+        
+        double bestAltitude = 10000.0;
+        double bestMinutes = std::numeric_limits<double>::infinity();
+        for (size_t k = 0; k < levels.size(); ++k) {
+            double minutes = gridRouteMinutes(route, k * segments);
+            if (minutes < bestMinutes) {
+                bestMinutes = minutes;
+                bestAltitude = levels[k];
+            }
+        }
+        return bestAltitude;
+    }
+    
     // Find altitude with best tailwind
     double bestAltitude = 10000.0;
     double maxTailwind = 0.0;
@@ -532,6 +894,50 @@ DynamicFlightPlanning::StepClimbOpportunity DynamicFlightPlanning::calculateStep
     
     StepClimbOpportunity result;
     
+    if (windGrid_ && routePath_.size() > 1) {
+        // Fuel for the rest of the kept route at the current level and each step, in one batch
+        std::vector<Waypoint> route;
+        for (uint32_t node : routePath_) {
+            route.push_back(routeNodes_[node]);
+        }
+        std::vector<double> altitudes = {currentAltitude};
+        for (double step : STEP_CLIMB_FEET) {
+            if (currentAltitude + step <= profile_.serviceCeiling) {
+                altitudes.push_back(currentAltitude + step);
+            }
+        }
+        legBatch_.clear();
+        for (double altitude : altitudes) {
+            for (size_t i = 0; i + 1 < route.size(); ++i) {
+                addGridLeg(route[i].position, route[i + 1].position, altitude, profile_.cruiseSpeed);
+            }
+        }
+        windGrid_->evaluate(legBatch_);
+        
+        const size_t legs = route.size() - 1;
+        auto fuelAt = [&](size_t k, double& minutes) {
+            minutes = gridRouteMinutes(route, k * legs);
+            double altitudeMultiplier = 1.0 - ((altitudes[k] / profile_.serviceCeiling) * 0.15);
+            return (minutes / 60.0) * profile_.fuelFlow * altitudeMultiplier;
+        };
+        double currentMinutes;
+        double currentTripFuel = fuelAt(0, currentMinutes);
+        double bestFuel = currentTripFuel;
+        result.newAltitude = currentAltitude;
+        for (size_t k = 1; k < altitudes.size(); ++k) {
+            double minutes;
+            double fuel = fuelAt(k, minutes);
+            if (fuel < bestFuel) {
+                bestFuel = fuel;
+                result.newAltitude = altitudes[k];
+            }
+        }
+        result.fuelSavingPerHour = currentMinutes > 0.0 ? (currentTripFuel - bestFuel) / (currentMinutes / 60.0) : 0.0;
+        result.timeRequiredToClimb = (result.newAltitude - currentAltitude) / profile_.climbRate;
+        result.recommended = result.fuelSavingPerHour > 0.0 && (distanceRemaining > 100.0) && (currentFuel > 50.0);
+        return result;
+    }
+    
     // Step climb to 2000 feet higher for fuel efficiency
     result.newAltitude = currentAltitude + 2000.0;
     result.newAltitude = std::min(result.newAltitude, profile_.serviceCeiling);
@@ -548,6 +954,150 @@ DynamicFlightPlanning::StepClimbOpportunity DynamicFlightPlanning::calculateStep
     return result;
 }
 
+DynamicFlightPlanning::TradeSpaceResult DynamicFlightPlanning::optimizeTradeSpace(
+    const std::vector<Waypoint>& route) {
+    
+    auto started = std::chrono::steady_clock::now();
+    TradeSpaceResult result{};
+    tradeSpaceFront_.clear();
+    tradeSpaceDistance_ = 0.0;
+    if (route.size() < 2 || profile_.cruiseSpeed <= 0.0 || profile_.serviceCeiling < ALTITUDE_STEP_FEET) {
+        return result;
+    }
+    
+    // Read-only inputs shared by every job: wind segments, levels, speeds, winds
+    struct Segment {
+        double latitude;               // midpoint, where the wind is sampled
+        double longitude;
+        double track;
+        double distance;
+    };
+    std::vector<Segment> segments;
+    for (size_t i = 0; i + 1 < route.size(); ++i) {
+        const Position& a = route[i].position;
+        const Position& b = route[i + 1].position;
+        double distance = flatDistanceNM(a, b);
+        size_t pieces = std::max<size_t>(1, static_cast<size_t>(std::ceil(distance / WIND_SEGMENT_NM)));
+        double track = std::atan2(b.longitude - a.longitude, b.latitude - a.latitude);
+        for (size_t k = 0; k < pieces; ++k) {
+            double f = (k + 0.5) / pieces;
+            segments.push_back({a.latitude + f * (b.latitude - a.latitude),
+                                a.longitude + f * (b.longitude - a.longitude), track, distance / pieces});
+        }
+        tradeSpaceDistance_ += distance;
+    }
+    std::vector<double> levels;
+    for (double level = ALTITUDE_STEP_FEET; level <= profile_.serviceCeiling; level += ALTITUDE_STEP_FEET) {
+        levels.push_back(level);
+    }
+    std::vector<double> speeds;
+    for (size_t i = 0; i < TRADE_SPEED_COUNT; ++i) {
+        double fraction = TRADE_SPEED_MIN_FRACTION + (1.0 - TRADE_SPEED_MIN_FRACTION) * i / (TRADE_SPEED_COUNT - 1);
+        double speed = profile_.cruiseSpeed * fraction;
+        if (profile_.maxSpeed > 0.0) speed = std::min(speed, profile_.maxSpeed);
+        if (speeds.empty() || speed > speeds.back()) speeds.push_back(speed);
+    }
+    const std::shared_ptr<const WindGrid> grid = windGrid_;
+    const double windTime = windTime_;
+    const size_t n = segments.size();
+    
+    if (!pool_) {
+        pool_ = std::make_shared<WorkStealingPool>();
+    }
+    
+    // Pass 1, per level: minutes flown to each segment boundary at every speed
+    const size_t row = n + 1;
+    std::vector<double> elapsed(levels.size() * speeds.size() * row);
+    parallelFor(*pool_, levels.size(), [&](size_t k) {
+        double* out = &elapsed[k * speeds.size() * row];
+        std::vector<double> groundSpeeds(speeds.size() * n);
+        if (grid) {
+            WindGridLegBatch batch;
+            for (double speed : speeds) {
+                for (const auto& segment : segments) {
+                    batch.add(segment.latitude, segment.longitude, levels[k], windTime, segment.track, speed);
+                }
+            }
+            grid->evaluate(batch);
+            groundSpeeds = batch.groundSpeed;
+        } else {
+            double windDirection;
+            double windSpeed = routeWindSpeed(levels[k], windDirection);
+            for (size_t j = 0; j < speeds.size(); ++j) {
+                for (size_t i = 0; i < n; ++i) {
+                    double headwind = windSpeed * std::cos(windDirection * DEG_TO_RAD - segments[i].track);
+                    groundSpeeds[j * n + i] = std::max(speeds[j] - headwind, speeds[j] * MIN_GROUND_SPEED_FRACTION);
+                }
+            }
+        }
+        for (size_t j = 0; j < speeds.size(); ++j) {
+            out[j * row] = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                out[j * row + i + 1] = out[j * row + i] + segments[i].distance / groundSpeeds[j * n + i] * 60.0;
+            }
+        }
+    });
+    
+    // Pass 2, per initial level: price each speed flat and with every step, keep that level's front
+    auto fuelFlowAt = [&](double altitude, double speed) {
+        double altitudeMultiplier = 1.0 - ((altitude / profile_.serviceCeiling) * 0.15);
+        return profile_.fuelFlow * altitudeMultiplier * std::pow(speed / profile_.cruiseSpeed, SPEED_FUEL_EXPONENT);
+    };
+    std::vector<double> boundaryDistance(row, 0.0);
+    for (size_t i = 0; i < n; ++i) {
+        boundaryDistance[i + 1] = boundaryDistance[i] + segments[i].distance;
+    }
+    std::vector<std::vector<TradeSpacePoint>> fronts(levels.size());
+    std::vector<size_t> evaluated(levels.size(), 0);
+    parallelFor(*pool_, levels.size(), [&](size_t k) {
+        std::vector<TradeSpacePoint>& points = fronts[k];
+        for (size_t j = 0; j < speeds.size(); ++j) {
+            const double* low = &elapsed[(k * speeds.size() + j) * row];
+            double lowFlow = fuelFlowAt(levels[k], speeds[j]);
+            points.push_back({levels[k], speeds[j], levels[k], 0.0, low[n], low[n] / 60.0 * lowFlow});
+            
+            for (double step : STEP_CLIMB_FEET) {
+                size_t upper = k + static_cast<size_t>(step / ALTITUDE_STEP_FEET);
+                if (upper >= levels.size() || profile_.climbRate <= 0.0) continue;
+                const double* high = &elapsed[(upper * speeds.size() + j) * row];
+                double highFlow = fuelFlowAt(levels[upper], speeds[j]);
+                double climbFuel = (step / profile_.climbRate) / 60.0 * profile_.fuelFlow * CLIMB_FUEL_FACTOR;
+                for (size_t b = 1; b < n; ++b) {
+                    double rest = high[n] - high[b];
+                    points.push_back({levels[k], speeds[j], levels[upper], boundaryDistance[b], low[b] + rest,
+                                      low[b] / 60.0 * lowFlow + rest / 60.0 * highFlow + climbFuel});
+                }
+            }
+        }
+        evaluated[k] = points.size();
+        keepParetoFront(points);
+    });
+    
+    for (size_t k = 0; k < levels.size(); ++k) {
+        result.candidatesEvaluated += evaluated[k];
+        result.paretoFront.insert(result.paretoFront.end(), fronts[k].begin(), fronts[k].end());
+    }
+    keepParetoFront(result.paretoFront);
+    tradeSpaceFront_ = result.paretoFront;
+    result.executionTime = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+DynamicFlightPlanning::TradeSpacePoint DynamicFlightPlanning::selectTradeSpacePoint(
+    const TradeSpaceResult& tradeSpace,
+    OptimizationObjective objective) const {
+    
+    if (tradeSpace.paretoFront.empty()) {
+        return TradeSpacePoint{};
+    }
+    return tradeSpace.paretoFront[pickTradeSpacePoint(tradeSpace.paretoFront, objective)];
+}
+
+void DynamicFlightPlanning::setThreadPool(std::shared_ptr<WorkStealingPool> pool) {
+    pool_ = std::move(pool);
+}
+
 DynamicFlightPlanning::DescentProfile DynamicFlightPlanning::calculateOptimalDescentProfile(
     double currentAltitude,
     double currentSpeed,
@@ -582,14 +1132,298 @@ DynamicFlightPlanning::DescentProfile DynamicFlightPlanning::calculateOptimalDes
     return result;
 }
 
+std::vector<DynamicFlightPlanning::DescentProfile> DynamicFlightPlanning::calculateOptimalDescentProfiles(
+    double currentAltitude,
+    double currentSpeed,
+    const std::vector<double>& targetAltitudes,
+    const WindConditions& windAloft) {
+    
+    std::vector<DescentProfile> results;
+    results.reserve(targetAltitudes.size());
+    for (double targetAltitude : targetAltitudes) {
+        results.push_back(calculateOptimalDescentProfile(
+            currentAltitude, currentSpeed, targetAltitude, 0.0, windAloft));
+    }
+    return results;
+}
+
 // ============================================================
 // PRIVATE HELPER METHODS
 // ============================================================
 
+void DynamicFlightPlanning::buildRouteSearch(const std::vector<Waypoint>& route) {
+    routeSearch_.clear();
+    routeNodes_ = route;
+    routeLegs_.clear();
+    filedNodeCount_ = route.size();
+    nextFiledNode_ = 1;
+    routeStart_ = 0;
+    
+    heuristicSpeed_ = profile_.cruiseSpeed + std::max(HEURISTIC_WIND_KNOTS, 2.0 * maxRouteWindSpeed());
+    routeSearch_.setHeuristic([this](uint32_t from, uint32_t to) {
+        return flatDistanceNM(routeNodes_[from].position, routeNodes_[to].position) / heuristicSpeed_ * 60.0;
+    });
+    
+    for (size_t i = 0; i < route.size(); ++i) {
+        routeSearch_.addNode();
+    }
+    for (size_t i = 0; i + 1 < route.size(); ++i) {
+        addRouteLegs(static_cast<uint32_t>(i), i + 1);
+    }
+    routeSearch_.setGoal(static_cast<uint32_t>(filedNodeCount_ - 1));
+}
+
+void DynamicFlightPlanning::addRouteLegs(uint32_t from, size_t firstFiledNode) {
+    size_t last = std::min(firstFiledNode + MAX_DIRECT_SKIP, filedNodeCount_ - 1);
+    for (size_t to = firstFiledNode; to <= last; ++to) {
+        double minutes = legMinutes(routeNodes_[from], routeNodes_[to]);
+        uint32_t edge = routeSearch_.addEdge(from, static_cast<uint32_t>(to), minutes);
+        routeLegs_.push_back({from, static_cast<uint32_t>(to), edge, false});
+    }
+}
+
+size_t DynamicFlightPlanning::repriceRouteLegs() {
+    // With a wind grid, every leg's ground speed comes from one batch
+    if (windGrid_) {
+        legBatch_.clear();
+        for (const auto& leg : routeLegs_) {
+            if (!leg.retired) {
+                addGridLeg(routeNodes_[leg.from].position, routeNodes_[leg.to].position,
+                           ROUTE_ALTITUDE_FEET, profile_.cruiseSpeed);
+            }
+        }
+        windGrid_->evaluate(legBatch_);
+    }
+    
+    size_t changed = 0;
+    size_t i = 0;
+    for (const auto& leg : routeLegs_) {
+        if (leg.retired) {
+            continue;
+        }
+        const size_t batchIndex = i++;
+        const Waypoint& from = routeNodes_[leg.from];
+        const Waypoint& to = routeNodes_[leg.to];
+        double minutes = IncrementalRoutePlanner::INFINITE_COST;
+        if (!windGrid_) {
+            minutes = legMinutes(from, to);
+        } else if (!legBlocked(from.position, to.position)) {
+            minutes = (flatDistanceNM(from.position, to.position) + legAirspaceNM(from.position, to.position)) /
+                      legBatch_.groundSpeed[batchIndex] * 60.0;
+        }
+        double old = routeSearch_.getEdgeCost(leg.edge);
+        if (minutes == old ||
+            (std::isfinite(minutes) && std::isfinite(old) && std::abs(minutes - old) <= WIND_REPRICE_TOLERANCE * old)) {
+            continue;
+        }
+        routeSearch_.updateEdgeCost(leg.edge, minutes);
+        changed++;
+    }
+    return changed;
+}
+
+void DynamicFlightPlanning::setRouteHazards(const std::vector<WeatherHazard>& hazards) {
+    routeHazards_ = hazards;
+    hazardGrid_.assign(routeHazards_);
+    unplacedHazards_.clear();
+    for (size_t i = 0; i < routeHazards_.size(); ++i) {
+        if (!hazardGrid_.contains(static_cast<uint32_t>(i))) {
+            unplacedHazards_.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+bool DynamicFlightPlanning::legBlocked(const Position& from, const Position& to) const {
+    // The grid's hazards are a superset of those legCrossesHazard() accepts,
+    // since its flat distance shrinks longitude by cos(latitude)
+    hazardGrid_.hazardsAlongSegment(from, to, ROUTE_ALTITUDE_FEET, legHazards_);
+    legHazards_.insert(legHazards_.end(), unplacedHazards_.begin(), unplacedHazards_.end());
+    return std::any_of(legHazards_.begin(), legHazards_.end(), [&](uint32_t id) {
+        return legCrossesHazard(from, to, routeHazards_[id], ROUTE_ALTITUDE_FEET);
+    });
+}
+
+bool DynamicFlightPlanning::replanFrom(const Position& currentPosition, RouteOptimization& result) {
+    auto started = std::chrono::steady_clock::now();
+    
+    // The filed fix ending the nearest leg of the route being flown is the next one ahead
+    double nearest = std::numeric_limits<double>::infinity();
+    size_t nearestLeg = 0;
+    for (size_t i = 0; i + 1 < routePath_.size(); ++i) {
+        double distance = distanceToLegNM(routeNodes_[routePath_[i]].position,
+                                          routeNodes_[routePath_[i + 1]].position, currentPosition);
+        if (distance < nearest) {
+            nearest = distance;
+            nearestLeg = i;
+        }
+    }
+    if (nearestLeg + 1 < routePath_.size()) {
+        nextFiledNode_ = std::max<size_t>(nextFiledNode_, routePath_[nearestLeg + 1]);
+    }
+    
+    if (routeStart_ >= filedNodeCount_) {
+        for (auto& leg : routeLegs_) {
+            if (leg.from == routeStart_) {
+                leg.retired = true;
+            }
+        }
+    }
+    
+    Waypoint current;
+    current.position = currentPosition;
+    current.id = "CURRENT";
+    routeStart_ = static_cast<uint32_t>(routeNodes_.size());
+    routeNodes_.push_back(current);
+    routeSearch_.addNode();
+    addRouteLegs(routeStart_, nextFiledNode_);
+    
+    std::vector<uint32_t> path;
+    double minutes = routeSearch_.findPath(routeStart_, path);
+    if (path.empty()) {
+        return false;
+    }
+    routePath_ = path;
+    summarizeRoute(path, minutes, result);
+    result.executionTime = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - started).count();
+    return true;
+}
+
+void DynamicFlightPlanning::summarizeRoute(const std::vector<uint32_t>& path, double minutes,
+                                           RouteOptimization& result) {
+    result.optimizedWaypoints.clear();
+    for (uint32_t node : path) {
+        result.optimizedWaypoints.push_back(routeNodes_[node]);
+    }
+    double altitudeMultiplier = 1.0 - ((ROUTE_ALTITUDE_FEET / profile_.serviceCeiling) * 0.15);
+    result.totalDistance = calculateRouteDistance(result.optimizedWaypoints);
+    result.estimatedTime = minutes;
+    result.estimatedFuel = (minutes / 60.0) * profile_.fuelFlow * altitudeMultiplier;
+    result.fuelEfficiency = result.estimatedFuel > 0.0 ? result.totalDistance / result.estimatedFuel : 0.0;
+}
+
+double DynamicFlightPlanning::legMinutes(const Waypoint& from, const Waypoint& to) const {
+    if (legBlocked(from.position, to.position)) {
+        return IncrementalRoutePlanner::INFINITE_COST;
+    }
+    
+    if (windGrid_) {
+        legBatch_.clear();
+        addGridLeg(from.position, to.position, ROUTE_ALTITUDE_FEET, profile_.cruiseSpeed);
+        windGrid_->evaluate(legBatch_);
+        return (flatDistanceNM(from.position, to.position) + legAirspaceNM(from.position, to.position)) /
+               legBatch_.groundSpeed[0] * 60.0;
+    }
+    
+    double windDirection;
+    double windSpeed = routeWindSpeed(ROUTE_ALTITUDE_FEET, windDirection);
+    double track = std::atan2(to.position.longitude - from.position.longitude,
+                              to.position.latitude - from.position.latitude);
+    double headwind = windSpeed * std::cos(windDirection * DEG_TO_RAD - track);
+    double groundSpeed = std::max(profile_.cruiseSpeed - headwind,
+                                  profile_.cruiseSpeed * MIN_GROUND_SPEED_FRACTION);
+    return (flatDistanceNM(from.position, to.position) + legAirspaceNM(from.position, to.position)) /
+           groundSpeed * 60.0;
+}
+
+double DynamicFlightPlanning::legAirspaceNM(const Position& from, const Position& to) const {
+    if (!airspace_) {
+        return 0.0;
+    }
+    return airspace_->segmentCost(from, to, ROUTE_ALTITUDE_FEET, airspaceWeights_);
+}
+
+double DynamicFlightPlanning::routeWindSpeed(double altitude, double& direction) const {
+    // Nearest forecast layer to the altitude; calm without forecasts
+    const WindLayer* nearest = nullptr;
+    for (const auto& layer : routeWinds_.layers) {
+        if (!nearest || std::abs(layer.altitude - altitude) < std::abs(nearest->altitude - altitude)) {
+            nearest = &layer;
+        }
+    }
+    direction = nearest ? nearest->windDirection : 0.0;
+    return nearest ? std::abs(nearest->windSpeed) : 0.0;
+}
+
+double DynamicFlightPlanning::maxRouteWindSpeed() const {
+    double direction;
+    double layers = routeWindSpeed(ROUTE_ALTITUDE_FEET, direction);
+    return windGrid_ ? std::max(layers, windGrid_->getMaxWindSpeed()) : layers;
+}
+
+void DynamicFlightPlanning::addGridLeg(const Position& from, const Position& to, double altitude, double tas) const {
+    // Winds at the leg midpoint, on the same flat track as calculateHeadwindComponent()
+    double track = std::atan2(to.longitude - from.longitude, to.latitude - from.latitude);
+    legBatch_.add(0.5 * (from.latitude + to.latitude), 0.5 * (from.longitude + to.longitude),
+                  altitude, windTime_, track, tas);
+}
+
+double DynamicFlightPlanning::gridRouteMinutes(const std::vector<Waypoint>& route, size_t firstLeg) const {
+    // Legs [firstLeg, firstLeg + route.size() - 1) of legBatch_, already evaluated
+    double minutes = 0.0;
+    for (size_t i = 0; i + 1 < route.size(); ++i) {
+        minutes += flatDistanceNM(route[i].position, route[i + 1].position) /
+                   legBatch_.groundSpeed[firstLeg + i] * 60.0;
+    }
+    return minutes;
+}
+
+size_t DynamicFlightPlanning::pickTradeSpacePoint(
+    const std::vector<TradeSpacePoint>& points,
+    OptimizationObjective objective) const {
+    
+    // Time and fuel scaled to 0-1 over the points, for the balanced choices
+    double minTime = std::numeric_limits<double>::infinity(), maxTime = -minTime;
+    double minFuel = minTime, maxFuel = -minTime;
+    for (const auto& point : points) {
+        minTime = std::min(minTime, point.estimatedTime);
+        maxTime = std::max(maxTime, point.estimatedTime);
+        minFuel = std::min(minFuel, point.estimatedFuel);
+        maxFuel = std::max(maxFuel, point.estimatedFuel);
+    }
+    auto balanced = [&](const TradeSpacePoint& point) {
+        double time = maxTime > minTime ? (point.estimatedTime - minTime) / (maxTime - minTime) : 0.0;
+        double fuel = maxFuel > minFuel ? (point.estimatedFuel - minFuel) / (maxFuel - minFuel) : 0.0;
+        return time + fuel;
+    };
+    
+    std::function<double(const TradeSpacePoint&)> score;
+    switch (objective) {
+        case OptimizationObjective::FUEL_EFFICIENCY:
+            score = [](const TradeSpacePoint& point) { return point.estimatedFuel; };
+            break;
+        case OptimizationObjective::TIME_OPTIMIZATION:
+            score = [](const TradeSpacePoint& point) { return point.estimatedTime; };
+            break;
+        case OptimizationObjective::COST_OPTIMIZATION: {
+            // A minute is worth the fuel a minute at cruise burns
+            double fuelPerMinute = profile_.fuelFlow / 60.0;
+            score = [fuelPerMinute](const TradeSpacePoint& point) {
+                return point.estimatedFuel + point.estimatedTime * fuelPerMinute;
+            };
+            break;
+        }
+        case OptimizationObjective::COMFORT_OPTIMIZATION:
+            // Stay level whenever some point does
+            score = [&](const TradeSpacePoint& point) {
+                return balanced(point) + (point.stepAltitude != point.altitude ? 2.0 : 0.0);
+            };
+            break;
+        default:
+            score = balanced;
+    }
+    
+    size_t best = 0;
+    for (size_t i = 1; i < points.size(); ++i) {
+        if (score(points[i]) < score(points[best])) best = i;
+    }
+    return best;
+}
+
 double DynamicFlightPlanning::calculateRouteDistance(const std::vector<Waypoint>& route) {
     double totalDistance = 0.0;
     
-    for (size_t i = 0; i < route.size() - 1; ++i) {
+    for (size_t i = 0; i + 1 < route.size(); ++i) {
         double latDiff = route[i+1].position.latitude - route[i].position.latitude;
         double lonDiff = route[i+1].position.longitude - route[i].position.longitude;
         double segmentDistance = std::sqrt(latDiff * latDiff + lonDiff * lonDiff);
@@ -604,8 +1438,17 @@ double DynamicFlightPlanning::calculateRouteFuel(
     double altitude,
     double speed) {
     
-    double distance = calculateRouteDistance(route);
-    double flightTime = distance / speed;  // hours
+    double flightTime;  // hours
+    if (windGrid_ && route.size() > 1) {
+        legBatch_.clear();
+        for (size_t i = 0; i + 1 < route.size(); ++i) {
+            addGridLeg(route[i].position, route[i + 1].position, altitude, speed);
+        }
+        windGrid_->evaluate(legBatch_);
+        flightTime = gridRouteMinutes(route, 0) / 60.0;
+    } else {
+        flightTime = calculateRouteDistance(route) / speed;
+    }
     
     // Adjust fuel consumption for altitude
     double altitudeMultiplier = 1.0 - ((altitude / profile_.serviceCeiling) * 0.15);
@@ -619,6 +1462,15 @@ double DynamicFlightPlanning::estimateRouteTime(
     double speed,
     const WindConditions& windAloft) {
     
+    if (windGrid_ && route.size() > 1) {
+        legBatch_.clear();
+        for (size_t i = 0; i + 1 < route.size(); ++i) {
+            addGridLeg(route[i].position, route[i + 1].position, ROUTE_ALTITUDE_FEET, speed);
+        }
+        windGrid_->evaluate(legBatch_);
+        return gridRouteMinutes(route, 0);
+    }
+    
     double distance = calculateRouteDistance(route);
     double windComponent = 0.0;
     
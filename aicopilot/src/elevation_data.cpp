@@ -19,21 +19,52 @@
 
 namespace AICopilot {
 
+namespace {
+
+// Feet per degree of latitude along a meridian
+constexpr double FEET_PER_DEGREE = 20902000.0 * M_PI / 180.0;
+
+/**
+ * Horn's 3x3 Sobel gradients for one row of posts
+ * north, centre and south are three consecutive padded rows; n outputs
+ * are written, post i reading padded columns i..i+2. Plain loops over
+ * restrict pointers so the compiler vectorizes them.
+ */
+void sobelRow(const float* __restrict north, const float* __restrict centre,
+              const float* __restrict south, int n,
+              float* __restrict east_rise, float* __restrict north_rise) {
+    for (int i = 0; i < n; ++i) {
+        east_rise[i] = (north[i + 2] + 2.0f * centre[i + 2] + south[i + 2]) -
+                       (north[i] + 2.0f * centre[i] + south[i]);
+    }
+    for (int i = 0; i < n; ++i) {
+        north_rise[i] = (north[i] + 2.0f * north[i + 1] + north[i + 2]) -
+                        (south[i] + 2.0f * south[i + 1] + south[i + 2]);
+    }
+}
+
+// Nearest post to a point in a cell; the far edge of a cell rounds onto
+// the next post, which every derived tile carries
+void nearestPost(const RasterCell& cell, int& row, int& col) {
+    row = static_cast<int>(cell.row) + (cell.rowFraction >= 0.5 ? 1 : 0);
+    col = static_cast<int>(cell.col) + (cell.colFraction >= 0.5 ? 1 : 0);
+}
+
+}  // namespace
+
 // ============================================================================
 // Constructor & Initialization
 // ============================================================================
 
 ElevationDatabase::ElevationDatabase()
-    : max_cache_size_(DEFAULT_CACHE_SIZE),
-      cache_hits_(0),
-      cache_misses_(0) {
+    : elevation_cache_(DEFAULT_CACHE_SIZE),
+      derived_tiles_(DEFAULT_DERIVED_TILE_BUDGET) {
     InitializeRegions();
 }
 
 ElevationDatabase::ElevationDatabase(size_t cache_size)
-    : max_cache_size_(cache_size),
-      cache_hits_(0),
-      cache_misses_(0) {
+    : elevation_cache_(cache_size),
+      derived_tiles_(DEFAULT_DERIVED_TILE_BUDGET) {
     InitializeRegions();
 }
 
@@ -47,41 +78,45 @@ double ElevationDatabase::GetElevationAt(double latitude, double longitude) {
         return 0.0;  // Sea level default for invalid coordinates
     }
 
-    // Create cache key with quantized precision
-    uint64_t cache_key = MakeKey(latitude, longitude);
-    
-    // Check cache first (thread-safe)
-    {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        
-        auto cache_it = elevation_cache_.find(cache_key);
-        if (cache_it != elevation_cache_.end()) {
-            cache_hits_++;
-            return cache_it->second;
-        }
+    // Any point in the same cell is served from its cached corners
+    RasterCell cell = LocateCell(latitude, longitude);
+    CellCorners corners;
+    if (!elevation_cache_.find(cell.key(), corners)) {
+        corners = SampleCellCorners(cell);
+        elevation_cache_.insert(cell.key(), corners);
     }
-
-    // Cache miss - interpolate elevation
-    cache_misses_++;
-    double elevation = InterpolateElevation(latitude, longitude);
     
-    // Clamp to valid range
-    elevation = std::max(MIN_ELEVATION, std::min(MAX_ELEVATION, elevation));
+    return corners.interpolate(cell.rowFraction, cell.colFraction);
+}
+
+void ElevationDatabase::GetElevations(const LatLon* points, size_t count, double* out) {
+    std::vector<size_t> misses;
+    std::vector<RasterCell> cells(count);
     
-    // Add to cache with LRU management
-    {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        
-        // Check cache size and evict if needed
-        if (elevation_cache_.size() >= max_cache_size_) {
-            EvictOldestEntry();
+    for (size_t i = 0; i < count; ++i) {
+        if (!ValidateCoordinates(points[i].latitude, points[i].longitude)) {
+            out[i] = 0.0;  // Sea level default for invalid coordinates
+            continue;
+        }
+        cells[i] = LocateCell(points[i].latitude, points[i].longitude);
+        CellCorners corners;
+        if (elevation_cache_.find(cells[i].key(), corners)) {
+            out[i] = corners.interpolate(cells[i].rowFraction, cells[i].colFraction);
+        } else {
+            misses.push_back(i);
         }
-        
-        elevation_cache_[cache_key] = elevation;
-        cache_order_.push_back(cache_key);
     }
     
-    return elevation;
+    // Sample misses without holding any cache lock; later points in an
+    // already sampled cell hit the entry inserted for the earlier one
+    for (size_t i : misses) {
+        CellCorners corners;
+        if (!elevation_cache_.find(cells[i].key(), corners)) {
+            corners = SampleCellCorners(cells[i]);
+            elevation_cache_.insert(cells[i].key(), corners);
+        }
+        out[i] = corners.interpolate(cells[i].rowFraction, cells[i].colFraction);
+    }
 }
 
 std::vector<TerrainProfileEntry> ElevationDatabase::GetTerrainProfile(
@@ -102,25 +137,28 @@ std::vector<TerrainProfileEntry> ElevationDatabase::GetTerrainProfile(
     double total_distance = CalculateDistance(start_lat, start_lon, end_lat, end_lon);
     double total_distance_nm = total_distance * 60.0;  // Convert degrees to NM
     
-    // Sample elevation at regular intervals
+    // Sample positions at regular intervals, then look them up as one batch
+    std::vector<LatLon> points(num_samples + 1);
     for (int i = 0; i <= num_samples; ++i) {
         double fraction = (num_samples > 0) ? static_cast<double>(i) / num_samples : 0.0;
         
         // Linear interpolation of position
-        double sample_lat = start_lat + (lat_diff * fraction);
-        double sample_lon = start_lon + (lon_diff * fraction);
-        
-        // Get elevation at this point
-        double elevation = GetElevationAt(sample_lat, sample_lon);
-        
-        // Calculate distance along path
-        double distance_nm = total_distance_nm * fraction;
+        points[i].latitude = start_lat + (lat_diff * fraction);
+        points[i].longitude = start_lon + (lon_diff * fraction);
+    }
+    
+    std::vector<double> elevations(points.size());
+    GetElevations(points.data(), points.size(), elevations.data());
+    
+    profile.reserve(points.size());
+    for (int i = 0; i <= num_samples; ++i) {
+        double fraction = (num_samples > 0) ? static_cast<double>(i) / num_samples : 0.0;
         
         TerrainProfileEntry entry;
-        entry.latitude = sample_lat;
-        entry.longitude = sample_lon;
-        entry.elevation = elevation;
-        entry.distance = distance_nm;
+        entry.latitude = points[i].latitude;
+        entry.longitude = points[i].longitude;
+        entry.elevation = elevations[i];
+        entry.distance = total_distance_nm * fraction;  // Distance along path
         
         profile.push_back(entry);
     }
@@ -168,95 +206,97 @@ bool ElevationDatabase::LoadRegionData(const std::string& region_code) {
 }
 
 bool ElevationDatabase::IsWaterBody(double latitude, double longitude) {
-    // Check if coordinates are in known water body regions
-    
-    // Great Lakes region (43°N-46°N, 76°W-88°W)
-    if (latitude >= 42.5 && latitude <= 46.5 &&
-        longitude >= -88.5 && longitude <= -75.5) {
-        return true;
-    }
-    
-    // Lake Superior
-    if (latitude >= 46.5 && latitude <= 48.0 &&
-        longitude >= -91.0 && longitude <= -84.0) {
-        return true;
+    if (!ValidateCoordinates(latitude, longitude)) {
+        return false;
     }
     
-    // Gulf of Mexico (approximately)
-    if (latitude >= 25.0 && latitude <= 30.0 &&
-        longitude >= -97.0 && longitude <= -83.0) {
-        return true;
-    }
+    int row = 0;
+    int col = 0;
+    auto tile = AcquireDerivedTile(latitude, longitude, row, col);
+    return tile->water[row * DerivedTile::SIDE + col] != 0;
+}
+
+void ElevationDatabase::IsWaterBody(const LatLon* points, size_t count, bool* out) {
+    // Consecutive points usually share a tile; look it up once per run
+    std::shared_ptr<const DerivedTile> tile;
+    TileKey tile_key = 0;
     
-    // Atlantic Ocean (east coast)
-    if (longitude > -70.0 && latitude >= 25.0 && latitude <= 45.0) {
-        double ocean_distance = 0.0;
-        double nearest_ocean_elev = FindNearestPoint(latitude, longitude, ocean_distance);
-        
-        // If nearest point is far (>0.5 degrees), likely ocean
-        if (ocean_distance > 0.5) {
-            return true;
+    for (size_t i = 0; i < count; ++i) {
+        if (!ValidateCoordinates(points[i].latitude, points[i].longitude)) {
+            out[i] = false;
+            continue;
         }
-    }
-    
-    // Pacific Ocean (west coast)
-    if (longitude < -120.0 && latitude >= 30.0 && latitude <= 50.0) {
-        double ocean_distance = 0.0;
-        double nearest_ocean_elev = FindNearestPoint(latitude, longitude, ocean_distance);
-        
-        if (ocean_distance > 0.5) {
-            return true;
+        RasterCell cell = LocateCell(points[i].latitude, points[i].longitude);
+        int row = 0;
+        int col = 0;
+        nearestPost(cell, row, col);
+        TileKey key = packTileKey(cell.tileLatitude, cell.tileLongitude);
+        if (!tile || key != tile_key) {
+            tile = AcquireDerivedTile(points[i].latitude, points[i].longitude, row, col);
+            tile_key = key;
         }
+        out[i] = tile->water[row * DerivedTile::SIDE + col] != 0;
     }
-    
-    // Check elevation heuristic - very low elevations often indicate water
-    double elev = GetElevationAt(latitude, longitude);
-    if (elev < -100.0 || (elev < 10.0 && longitude > -120.0 && longitude < -70.0)) {
-        return true;
-    }
-    
-    return false;
 }
 
 SlopeInfo ElevationDatabase::GetSlopeAngle(double latitude, double longitude) {
-    SlopeInfo slope_info;
-    slope_info.angle_degrees = 0.0;
-    slope_info.max_elevation = 0.0;
-    slope_info.min_elevation = 0.0;
-    slope_info.is_steep = false;
-    
-    // Sample elevations in a small grid around the point
-    const double sample_offset = 0.01;  // About 1 km at equator
-    
-    double center_elev = GetElevationAt(latitude, longitude);
-    
-    // Sample 8 surrounding points
-    std::vector<double> elevations;
-    elevations.push_back(center_elev);
-    
-    double north_elev = GetElevationAt(latitude + sample_offset, longitude);
-    double south_elev = GetElevationAt(latitude - sample_offset, longitude);
-    double east_elev = GetElevationAt(latitude, longitude + sample_offset);
-    double west_elev = GetElevationAt(latitude, longitude - sample_offset);
-    
-    elevations.push_back(north_elev);
-    elevations.push_back(south_elev);
-    elevations.push_back(east_elev);
-    elevations.push_back(west_elev);
+    if (!ValidateCoordinates(latitude, longitude)) {
+        return SlopeInfo{0.0, 0.0, 0.0, 0.0, false};
+    }
     
-    // Calculate statistics
-    slope_info.max_elevation = *std::max_element(elevations.begin(), elevations.end());
-    slope_info.min_elevation = *std::min_element(elevations.begin(), elevations.end());
+    int row = 0;
+    int col = 0;
+    auto tile = AcquireDerivedTile(latitude, longitude, row, col);
+    return ReadSlope(*tile, row, col);
+}
+
+void ElevationDatabase::GetSlopeAngles(const LatLon* points, size_t count, SlopeInfo* out) {
+    std::shared_ptr<const DerivedTile> tile;
+    TileKey tile_key = 0;
     
-    // Calculate slope angle
-    double elevation_difference = slope_info.max_elevation - slope_info.min_elevation;
-    const double earth_radius_ft = 20902000.0;  // Feet
-    const double distance_ft = sample_offset * (M_PI / 180.0) * earth_radius_ft;
+    for (size_t i = 0; i < count; ++i) {
+        if (!ValidateCoordinates(points[i].latitude, points[i].longitude)) {
+            out[i] = SlopeInfo{0.0, 0.0, 0.0, 0.0, false};
+            continue;
+        }
+        RasterCell cell = LocateCell(points[i].latitude, points[i].longitude);
+        int row = 0;
+        int col = 0;
+        nearestPost(cell, row, col);
+        TileKey key = packTileKey(cell.tileLatitude, cell.tileLongitude);
+        if (!tile || key != tile_key) {
+            tile = AcquireDerivedTile(points[i].latitude, points[i].longitude, row, col);
+            tile_key = key;
+        }
+        out[i] = ReadSlope(*tile, row, col);
+    }
+}
+
+bool ElevationDatabase::LoadWaterMask(int tile_latitude, int tile_longitude,
+                                      const uint8_t* mask, int samples_per_side) {
+    if (mask == nullptr || samples_per_side < 2 ||
+        tile_latitude < -90 || tile_latitude > 89 ||
+        tile_longitude < -180 || tile_longitude > 179) {
+        return false;
+    }
     
-    slope_info.angle_degrees = std::atan2(elevation_difference, distance_ft) * (180.0 / M_PI);
-    slope_info.is_steep = slope_info.angle_degrees > 15.0;
+    // Nearest source sample for each derived post
+    const int side = DerivedTile::SIDE;
+    auto resampled = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(side) * side);
+    const double scale = static_cast<double>(samples_per_side - 1) / (side - 1);
+    for (int row = 0; row < side; ++row) {
+        int source_row = static_cast<int>(std::lround(row * scale));
+        for (int col = 0; col < side; ++col) {
+            int source_col = static_cast<int>(std::lround(col * scale));
+            (*resampled)[row * side + col] = mask[source_row * samples_per_side + source_col] != 0 ? 1 : 0;
+        }
+    }
     
-    return slope_info;
+    TileKey key = packTileKey(tile_latitude, tile_longitude);
+    std::lock_guard<std::mutex> lock(derived_mutex_);
+    water_masks_[key] = std::move(resampled);
+    derived_tiles_.erase(key);
+    return true;
 }
 
 double ElevationDatabase::GetMinimumSafeAltitude(double latitude, double longitude, double clearance) {
@@ -297,26 +337,30 @@ bool ElevationDatabase::GetTerrainStats(double latitude, double longitude, doubl
 }
 
 void ElevationDatabase::ClearCache() {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
     elevation_cache_.clear();
-    cache_order_.clear();
+    std::lock_guard<std::mutex> lock(derived_mutex_);
+    derived_tiles_.clear();
 }
 
 std::pair<int64_t, int64_t> ElevationDatabase::GetCacheStatistics() const {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
-    return std::make_pair(cache_hits_, cache_misses_);
+    StripedCacheStats stats = elevation_cache_.getStats();
+    return std::make_pair(static_cast<int64_t>(stats.hits), static_cast<int64_t>(stats.misses));
 }
 
 size_t ElevationDatabase::GetCacheMemoryUsage() const {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
-    // Estimate: ~24 bytes per entry (8 bytes key + 8 bytes value + overhead)
-    return elevation_cache_.size() * 24;
+    std::lock_guard<std::mutex> lock(derived_mutex_);
+    return elevation_cache_.memoryUsage() + derived_tiles_.getBytes();
+}
+
+TileCacheStats ElevationDatabase::GetDerivedTileStats() const {
+    std::lock_guard<std::mutex> lock(derived_mutex_);
+    return derived_tiles_.getStats();
 }
 
 void ElevationDatabase::ResetCacheStatistics() {
-    std::lock_guard<std::mutex> lock(cache_mutex_);
-    cache_hits_ = 0;
-    cache_misses_ = 0;
+    elevation_cache_.resetStats();
+    std::lock_guard<std::mutex> lock(derived_mutex_);
+    derived_tiles_.resetStats();
 }
 
 bool ElevationDatabase::ValidateCoordinates(double latitude, double longitude) {
@@ -328,24 +372,156 @@ bool ElevationDatabase::ValidateCoordinates(double latitude, double longitude) {
 // Private Methods - Cache Management
 // ============================================================================
 
-uint64_t ElevationDatabase::MakeKey(double latitude, double longitude) const {
-    // Quantize to cache precision
-    int lat_int = static_cast<int>(latitude / CACHE_PRECISION);
-    int lon_int = static_cast<int>(longitude / CACHE_PRECISION);
+RasterCell ElevationDatabase::LocateCell(double latitude, double longitude) const {
+    return locateRasterCell(latitude, longitude, CACHE_CELLS_PER_DEGREE);
+}
+
+CellCorners ElevationDatabase::SampleCellCorners(const RasterCell& cell) {
+    const double north = cell.northLatitude(CACHE_CELLS_PER_DEGREE);
+    const double west = cell.westLongitude(CACHE_CELLS_PER_DEGREE);
+    const double south = north - CACHE_PRECISION;
+    const double east = west + CACHE_PRECISION;
+    
+    CellCorners corners;
+    corners.northWest = SamplePost(north, west);
+    corners.northEast = SamplePost(north, east);
+    corners.southWest = SamplePost(south, west);
+    corners.southEast = SamplePost(south, east);
+    return corners;
+}
+
+double ElevationDatabase::SamplePost(double latitude, double longitude) {
+    return std::max(MIN_ELEVATION, std::min(MAX_ELEVATION, InterpolateElevation(latitude, longitude)));
+}
+
+// ============================================================================
+// Private Methods - Derived Rasters
+// ============================================================================
+
+size_t ElevationDatabase::DerivedTile::memoryBytes() const {
+    return sizeof(DerivedTile) +
+           (elevation.size() + slope.size() + aspect.size()) * sizeof(float) +
+           water.size() * sizeof(uint8_t);
+}
+
+std::shared_ptr<const ElevationDatabase::DerivedTile> ElevationDatabase::AcquireDerivedTile(
+    double latitude, double longitude, int& out_row, int& out_col) {
     
-    // Create 64-bit key (32 bits lat, 32 bits lon)
-    uint64_t key = (static_cast<uint64_t>(lat_int & 0xFFFFFFFF) << 32) |
-                   (static_cast<uint64_t>(lon_int & 0xFFFFFFFF));
-    return key;
+    RasterCell cell = LocateCell(latitude, longitude);
+    nearestPost(cell, out_row, out_col);
+    TileKey key = packTileKey(cell.tileLatitude, cell.tileLongitude);
+    
+    std::shared_ptr<const std::vector<uint8_t>> water_mask;
+    {
+        std::lock_guard<std::mutex> lock(derived_mutex_);
+        if (auto tile = derived_tiles_.find(key)) {
+            return tile;
+        }
+        auto mask = water_masks_.find(key);
+        if (mask != water_masks_.end()) {
+            water_mask = mask->second;
+        }
+    }
+    
+    // Build outside the lock; a concurrent build of the same tile does the
+    // same work and the later insert wins
+    auto tile = BuildDerivedTile(cell.tileLatitude, cell.tileLongitude, water_mask.get());
+    std::lock_guard<std::mutex> lock(derived_mutex_);
+    derived_tiles_.insert(key, tile, tile->memoryBytes());
+    return tile;
 }
 
-void ElevationDatabase::EvictOldestEntry() {
-    // LRU eviction - remove oldest entry
-    if (!cache_order_.empty()) {
-        uint64_t oldest_key = cache_order_.front();
-        cache_order_.pop_front();
-        elevation_cache_.erase(oldest_key);
+std::shared_ptr<const ElevationDatabase::DerivedTile> ElevationDatabase::BuildDerivedTile(
+    int tile_latitude, int tile_longitude, const std::vector<uint8_t>* water_mask) {
+    
+    const int side = DerivedTile::SIDE;
+    const int padded = DerivedTile::PADDED;
+    const double spacing = CACHE_PRECISION;
+    
+    auto tile = std::make_shared<DerivedTile>();
+    tile->elevation.resize(static_cast<size_t>(padded) * padded);
+    tile->slope.resize(static_cast<size_t>(side) * side);
+    tile->aspect.resize(static_cast<size_t>(side) * side);
+    tile->water.resize(static_cast<size_t>(side) * side);
+    
+    // Padded row 0 and column 0 lie one post outside the north and west edges
+    for (int row = 0; row < padded; ++row) {
+        double lat = std::max(-90.0, std::min(90.0, tile_latitude + 1.0 - (row - 1) * spacing));
+        float* posts = &tile->elevation[static_cast<size_t>(row) * padded];
+        for (int col = 0; col < padded; ++col) {
+            double lon = tile_longitude + (col - 1) * spacing;
+            if (lon < -180.0) lon += 360.0;
+            if (lon > 180.0) lon -= 360.0;
+            posts[col] = static_cast<float>(SamplePost(lat, lon));
+        }
     }
+    
+    std::vector<float> east_rise(side);
+    std::vector<float> north_rise(side);
+    const double dy = 8.0 * spacing * FEET_PER_DEGREE;
+    
+    for (int row = 0; row < side; ++row) {
+        const float* north = &tile->elevation[static_cast<size_t>(row) * padded];
+        sobelRow(north, north + padded, north + 2 * padded, side, east_rise.data(), north_rise.data());
+        
+        // Posts converge toward the poles; keep dx off zero at the pole rows
+        double lat = tile_latitude + 1.0 - row * spacing;
+        double dx = std::max(dy * std::cos(lat * M_PI / 180.0), dy * 1e-3);
+        float* slope = &tile->slope[static_cast<size_t>(row) * side];
+        float* aspect = &tile->aspect[static_cast<size_t>(row) * side];
+        for (int col = 0; col < side; ++col) {
+            double gx = east_rise[col] / dx;
+            double gy = north_rise[col] / dy;
+            double gradient = std::sqrt(gx * gx + gy * gy);
+            slope[col] = static_cast<float>(std::atan(gradient) * 180.0 / M_PI);
+            
+            // Downhill bearing; flat posts report north
+            double bearing = 0.0;
+            if (gradient > 1e-9) {
+                bearing = std::atan2(-gx, -gy) * 180.0 / M_PI;
+                if (bearing < 0.0) bearing += 360.0;
+            }
+            float rounded = static_cast<float>(bearing);
+            aspect[col] = rounded < 360.0f ? rounded : 0.0f;
+        }
+    }
+    
+    if (water_mask != nullptr) {
+        tile->water = *water_mask;
+    } else {
+        for (int row = 0; row < side; ++row) {
+            const float* posts = &tile->elevation[static_cast<size_t>(row + 1) * padded + 1];
+            uint8_t* water = &tile->water[static_cast<size_t>(row) * side];
+            for (int col = 0; col < side; ++col) {
+                water[col] = posts[col] <= WATER_ELEVATION ? 1 : 0;
+            }
+        }
+    }
+    
+    return tile;
+}
+
+SlopeInfo ElevationDatabase::ReadSlope(const DerivedTile& tile, int row, int col) {
+    const int padded = DerivedTile::PADDED;
+    
+    // The post's 3x3 neighbourhood is rows row..row+2 of the padded grid
+    float low = tile.elevation[static_cast<size_t>(row) * padded + col];
+    float high = low;
+    for (int r = row; r < row + 3; ++r) {
+        const float* posts = &tile.elevation[static_cast<size_t>(r) * padded + col];
+        for (int c = 0; c < 3; ++c) {
+            low = std::min(low, posts[c]);
+            high = std::max(high, posts[c]);
+        }
+    }
+    
+    SlopeInfo slope_info;
+    slope_info.angle_degrees = tile.slope[row * DerivedTile::SIDE + col];
+    slope_info.aspect_degrees = tile.aspect[row * DerivedTile::SIDE + col];
+    slope_info.max_elevation = high;
+    slope_info.min_elevation = low;
+    slope_info.is_steep = slope_info.angle_degrees > STEEP_SLOPE;
+    return slope_info;
 }
 
 // ============================================================================
@@ -359,7 +535,9 @@ double ElevationDatabase::InterpolateElevation(double latitude, double longitude
     double best_elevation = 0.0;
     bool found = false;
     
-    // First pass: find points in current region
+    // First pass: the region whose nearest sample is closest wins, so a
+    // region's samples only shape terrain they are actually near (the
+    // nationwide water bodies must not flood the mountain ranges)
     for (const auto& region : regions_) {
         // Check if coordinates are within region bounds
         if (latitude < region.min_lat || latitude > region.max_lat ||
@@ -368,44 +546,44 @@ double ElevationDatabase::InterpolateElevation(double latitude, double longitude
         }
         
         // Find 4 nearest points for bilinear interpolation
-        std::vector<std::pair<double, ElevationPoint>> candidates;
+        std::vector<std::pair<double, double>> candidates;
+        candidates.reserve(region.points.size());
         
         for (const auto& point : region.points) {
             double distance = CalculateDistance(latitude, longitude, point.latitude, point.longitude);
-            candidates.push_back(std::make_pair(distance, point));
+            candidates.push_back(std::make_pair(distance, point.elevation));
         }
         
-        // Sort by distance
-        std::sort(candidates.begin(), candidates.end());
+        if (candidates.size() < 2) {
+            continue;
+        }
+        size_t nearest = std::min(size_t(4), candidates.size());
+        std::partial_sort(candidates.begin(), candidates.begin() + nearest, candidates.end(),
+                          [](const auto& a, const auto& b) { return a.first < b.first; });
         
-        // Bilinear interpolation with up to 4 nearest points
-        if (candidates.size() >= 2) {
-            double total_weight = 0.0;
-            double weighted_elevation = 0.0;
-            
-            for (int i = 0; i < std::min(size_t(4), candidates.size()); ++i) {
-                double distance = candidates[i].first;
-                double elev = candidates[i].second.elevation;
-                
-                // Use inverse distance weighting
-                double weight = (distance < 0.0001) ? 1e10 : 1.0 / (distance * distance);
-                total_weight += weight;
-                weighted_elevation += elev * weight;
-                
-                best_distance = distance;
-                found = true;
-            }
-            
-            if (total_weight > 0) {
-                best_elevation = weighted_elevation / total_weight;
-            }
+        if (candidates[0].first >= REGION_SAMPLE_RADIUS || candidates[0].first >= best_distance) {
+            continue;
         }
+        
+        // Inverse distance weighting over the nearest points
+        double total_weight = 0.0;
+        double weighted_elevation = 0.0;
+        for (size_t i = 0; i < nearest; ++i) {
+            double distance = candidates[i].first;
+            double weight = (distance < 0.0001) ? 1e10 : 1.0 / (distance * distance);
+            total_weight += weight;
+            weighted_elevation += candidates[i].second * weight;
+        }
+        
+        best_distance = candidates[0].first;
+        best_elevation = weighted_elevation / total_weight;
+        found = true;
     }
     
     // Second pass: use nearest point across all regions
     if (!found) {
         best_elevation = FindNearestPoint(latitude, longitude, best_distance);
-        found = (best_distance < 1.0);  // Within 1 degree
+        found = (best_distance < REGION_SAMPLE_RADIUS);
     }
     
     // Final fallback: use heuristic estimation
@@ -0,0 +1,729 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "flight_data_recorder.hpp"
+#include "binary_log.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace AICopilot {
+
+constexpr char FlightDataReader::MAGIC[4];
+constexpr char FlightDataReader::CHUNK_MAGIC[4];
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t checksum(const uint8_t* data, size_t size, uint64_t hash = FNV_OFFSET) {
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t headerChecksum(FlightDataChunkHeader header) {
+    header.checksum = 0;
+    return checksum(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+}
+
+int leadingZeros(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, x);
+    return 63 - static_cast<int>(index);
+#else
+    return __builtin_clzll(x);
+#endif
+}
+
+int trailingZeros(uint64_t x) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+uint64_t doubleBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsDouble(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// MSB-first bit stream
+class BitWriter {
+public:
+    void write(uint64_t value, int bits) {
+        while (bits > 0) {
+            int free = 8 - static_cast<int>(bitCount_ & 7);
+            if (free == 8) bytes_.push_back(0);
+            int take = std::min(bits, free);
+            uint64_t part = (value >> (bits - take)) & ((1u << take) - 1);
+            bytes_.back() |= static_cast<uint8_t>(part << (free - take));
+            bits -= take;
+            bitCount_ += static_cast<uint64_t>(take);
+        }
+    }
+
+    void writeBit(bool bit) { write(bit ? 1 : 0, 1); }
+
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+    void clear() { bytes_.clear(); bitCount_ = 0; }
+
+private:
+    std::vector<uint8_t> bytes_;
+    uint64_t bitCount_ = 0;
+};
+
+class BitReader {
+public:
+    BitReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    uint64_t read(int bits) {
+        uint64_t value = 0;
+        while (bits > 0) {
+            size_t byte = static_cast<size_t>(position_ >> 3);
+            if (byte >= size_) {
+                overrun_ = true;
+                return 0;
+            }
+            int avail = 8 - static_cast<int>(position_ & 7);
+            int take = std::min(bits, avail);
+            uint64_t part = (data_[byte] >> (avail - take)) & ((1u << take) - 1);
+            value = (value << take) | part;
+            bits -= take;
+            position_ += static_cast<uint64_t>(take);
+        }
+        return value;
+    }
+
+    bool readBit() { return read(1) != 0; }
+    bool overrun() const { return overrun_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    uint64_t position_ = 0;
+    bool overrun_ = false;
+};
+
+// Delta-of-delta buckets: prefix, payload bits, and the bias that makes the
+// payload unsigned
+struct DeltaBucket {
+    uint64_t prefix;
+    int prefixBits;
+    int payloadBits;
+    int64_t bias;
+};
+
+constexpr DeltaBucket DELTA_BUCKETS[] = {
+    {0x2, 2, 7, 63},        // '10'   [-63, 64]
+    {0x6, 3, 9, 255},       // '110'  [-255, 256]
+    {0xE, 4, 12, 2047},     // '1110' [-2047, 2048]
+};
+
+class TimestampEncoder {
+public:
+    void append(BitWriter& out, int64_t timestamp) {
+        if (count_++ == 0) {
+            out.write(static_cast<uint64_t>(timestamp), 64);
+        } else {
+            int64_t delta = static_cast<int64_t>(static_cast<uint64_t>(timestamp) - static_cast<uint64_t>(previous_));
+            int64_t dod = static_cast<int64_t>(static_cast<uint64_t>(delta) - static_cast<uint64_t>(previousDelta_));
+            if (dod == 0) {
+                out.writeBit(false);
+            } else {
+                bool written = false;
+                for (const DeltaBucket& bucket : DELTA_BUCKETS) {
+                    int64_t limit = (int64_t{1} << bucket.payloadBits) - 1 - bucket.bias;
+                    if (dod >= -bucket.bias && dod <= limit) {
+                        out.write(bucket.prefix, bucket.prefixBits);
+                        out.write(static_cast<uint64_t>(dod + bucket.bias), bucket.payloadBits);
+                        written = true;
+                        break;
+                    }
+                }
+                if (!written) {
+                    out.write(0xF, 4);
+                    out.write(static_cast<uint64_t>(dod), 64);
+                }
+            }
+            previousDelta_ = delta;
+        }
+        previous_ = timestamp;
+    }
+
+    void reset() { *this = TimestampEncoder(); }
+
+private:
+    uint64_t count_ = 0;
+    int64_t previous_ = 0;
+    int64_t previousDelta_ = 0;
+};
+
+bool decodeTimestamps(const uint8_t* data, size_t size, uint32_t rows, std::vector<int64_t>& out) {
+    BitReader in(data, size);
+    int64_t previous = 0;
+    int64_t previousDelta = 0;
+    for (uint32_t row = 0; row < rows; ++row) {
+        if (row == 0) {
+            previous = static_cast<int64_t>(in.read(64));
+        } else {
+            int64_t dod = 0;
+            if (in.readBit()) {
+                // Count the prefix's ones: 1 -> '10', 2 -> '110', 3 -> '1110', 4 -> '1111'
+                int prefixBits = 1;
+                while (prefixBits < 4 && in.readBit()) prefixBits++;
+                if (prefixBits <= 3) {
+                    const DeltaBucket& bucket = DELTA_BUCKETS[prefixBits - 1];
+                    dod = static_cast<int64_t>(in.read(bucket.payloadBits)) - bucket.bias;
+                } else {
+                    dod = static_cast<int64_t>(in.read(64));
+                }
+            }
+            int64_t delta = static_cast<int64_t>(static_cast<uint64_t>(previousDelta) + static_cast<uint64_t>(dod));
+            previous = static_cast<int64_t>(static_cast<uint64_t>(previous) + static_cast<uint64_t>(delta));
+            previousDelta = delta;
+        }
+        if (in.overrun()) return false;
+        out.push_back(previous);
+    }
+    return true;
+}
+
+// Gorilla XOR coding: '0' repeats the previous value; '10' reuses the
+// previous meaningful-bit window; '11' sends a new window as 5 bits of
+// leading zeros and 6 bits of length (64 stored as 0)
+class ValueEncoder {
+public:
+    void append(BitWriter& out, double value) {
+        uint64_t bits = doubleBits(value);
+        if (count_++ == 0) {
+            out.write(bits, 64);
+            previous_ = bits;
+            return;
+        }
+        uint64_t x = bits ^ previous_;
+        previous_ = bits;
+        if (x == 0) {
+            out.writeBit(false);
+            return;
+        }
+        out.writeBit(true);
+        int leading = std::min(leadingZeros(x), 31);
+        int trailing = trailingZeros(x);
+        if (leading_ >= 0 && leading >= leading_ && trailing >= trailing_) {
+            out.writeBit(false);
+            out.write(x >> trailing_, 64 - leading_ - trailing_);
+            return;
+        }
+        int length = 64 - leading - trailing;
+        out.writeBit(true);
+        out.write(static_cast<uint64_t>(leading), 5);
+        out.write(static_cast<uint64_t>(length & 63), 6);
+        out.write(x >> trailing, length);
+        leading_ = leading;
+        trailing_ = trailing;
+    }
+
+    void reset() { *this = ValueEncoder(); }
+
+private:
+    uint64_t count_ = 0;
+    uint64_t previous_ = 0;
+    int leading_ = -1;
+    int trailing_ = 0;
+};
+
+bool decodeValues(const uint8_t* data, size_t size, uint32_t rows, std::vector<double>& out) {
+    BitReader in(data, size);
+    uint64_t previous = 0;
+    int leading = 0;
+    int trailing = 0;
+    for (uint32_t row = 0; row < rows; ++row) {
+        if (row == 0) {
+            previous = in.read(64);
+        } else if (in.readBit()) {
+            if (in.readBit()) {
+                leading = static_cast<int>(in.read(5));
+                int length = static_cast<int>(in.read(6));
+                if (length == 0) length = 64;
+                if (leading + length > 64) return false;
+                trailing = 64 - leading - length;
+            }
+            previous ^= in.read(64 - leading - trailing) << trailing;
+        }
+        if (in.overrun()) return false;
+        out.push_back(bitsDouble(previous));
+    }
+    return true;
+}
+
+bool overlaps(const FlightDataChunkHeader& header, int64_t startUs, int64_t endUs) {
+    return header.lastTimestampUs >= startUs && header.firstTimestampUs <= endUs;
+}
+
+bool unbounded(int64_t startUs, int64_t endUs) {
+    return startUs == FlightDataReader::ALL_TIME_START && endUs == FlightDataReader::ALL_TIME_END;
+}
+
+} // namespace
+
+const char* flightDataColumnName(FlightDataColumn column) {
+    static const char* const NAMES[FDR_COLUMN_COUNT] = {
+        "timestamp", "latitude", "longitude", "altitude", "heading", "pitch", "bank",
+        "indicated_airspeed", "true_airspeed", "ground_speed", "vertical_speed", "altimeter",
+        "fuel_quantity", "engine_rpm", "on_ground", "parking_brake", "gear_down", "flaps",
+        "master_battery", "master_alternator", "battery_voltage", "battery_load",
+        "generator_voltage", "generator_load", "ap_master", "ap_heading_hold",
+        "ap_altitude_hold", "ap_speed_hold", "ap_vertical_speed_hold", "ap_nav", "ap_approach",
+        "ap_autothrottle", "ap_target_heading", "ap_target_altitude", "ap_target_speed",
+        "ap_target_vertical_speed", "flight_phase",
+    };
+    return column < FDR_COLUMN_COUNT ? NAMES[column] : "unknown";
+}
+
+double FlightDataSample::column(FlightDataColumn column) const {
+    switch (column) {
+        case FDR_TIMESTAMP: return static_cast<double>(timestampUs);
+        case FDR_LATITUDE: return state.position.latitude;
+        case FDR_LONGITUDE: return state.position.longitude;
+        case FDR_ALTITUDE: return state.position.altitude;
+        case FDR_HEADING: return state.heading;
+        case FDR_PITCH: return state.pitch;
+        case FDR_BANK: return state.bank;
+        case FDR_INDICATED_AIRSPEED: return state.indicatedAirspeed;
+        case FDR_TRUE_AIRSPEED: return state.trueAirspeed;
+        case FDR_GROUND_SPEED: return state.groundSpeed;
+        case FDR_VERTICAL_SPEED: return state.verticalSpeed;
+        case FDR_ALTIMETER: return state.altimeter;
+        case FDR_FUEL_QUANTITY: return state.fuelQuantity;
+        case FDR_ENGINE_RPM: return state.engineRPM;
+        case FDR_ON_GROUND: return state.onGround ? 1.0 : 0.0;
+        case FDR_PARKING_BRAKE: return state.parkingBrakeSet ? 1.0 : 0.0;
+        case FDR_GEAR_DOWN: return state.gearDown ? 1.0 : 0.0;
+        case FDR_FLAPS: return state.flapsPosition;
+        case FDR_MASTER_BATTERY: return state.masterBattery ? 1.0 : 0.0;
+        case FDR_MASTER_ALTERNATOR: return state.masterAlternator ? 1.0 : 0.0;
+        case FDR_BATTERY_VOLTAGE: return state.batteryVoltage;
+        case FDR_BATTERY_LOAD: return state.batteryLoad;
+        case FDR_GENERATOR_VOLTAGE: return state.generatorVoltage;
+        case FDR_GENERATOR_LOAD: return state.generatorLoad;
+        case FDR_AP_MASTER: return autopilot.masterEnabled ? 1.0 : 0.0;
+        case FDR_AP_HEADING_HOLD: return autopilot.headingHold ? 1.0 : 0.0;
+        case FDR_AP_ALTITUDE_HOLD: return autopilot.altitudeHold ? 1.0 : 0.0;
+        case FDR_AP_SPEED_HOLD: return autopilot.speedHold ? 1.0 : 0.0;
+        case FDR_AP_VERTICAL_SPEED_HOLD: return autopilot.verticalSpeedHold ? 1.0 : 0.0;
+        case FDR_AP_NAV: return autopilot.navMode ? 1.0 : 0.0;
+        case FDR_AP_APPROACH: return autopilot.approachMode ? 1.0 : 0.0;
+        case FDR_AP_AUTOTHROTTLE: return autopilot.autoThrottle ? 1.0 : 0.0;
+        case FDR_AP_TARGET_HEADING: return autopilot.targetHeading;
+        case FDR_AP_TARGET_ALTITUDE: return autopilot.targetAltitude;
+        case FDR_AP_TARGET_SPEED: return autopilot.targetSpeed;
+        case FDR_AP_TARGET_VERTICAL_SPEED: return autopilot.targetVerticalSpeed;
+        case FDR_FLIGHT_PHASE: return static_cast<double>(static_cast<int>(phase));
+        default: return 0.0;
+    }
+}
+
+void FlightDataSample::setColumn(FlightDataColumn column, double value) {
+    bool flag = value != 0.0;
+    switch (column) {
+        case FDR_TIMESTAMP: timestampUs = static_cast<int64_t>(value); break;
+        case FDR_LATITUDE: state.position.latitude = value; break;
+        case FDR_LONGITUDE: state.position.longitude = value; break;
+        case FDR_ALTITUDE: state.position.altitude = value; break;
+        case FDR_HEADING: state.heading = value; break;
+        case FDR_PITCH: state.pitch = value; break;
+        case FDR_BANK: state.bank = value; break;
+        case FDR_INDICATED_AIRSPEED: state.indicatedAirspeed = value; break;
+        case FDR_TRUE_AIRSPEED: state.trueAirspeed = value; break;
+        case FDR_GROUND_SPEED: state.groundSpeed = value; break;
+        case FDR_VERTICAL_SPEED: state.verticalSpeed = value; break;
+        case FDR_ALTIMETER: state.altimeter = value; break;
+        case FDR_FUEL_QUANTITY: state.fuelQuantity = value; break;
+        case FDR_ENGINE_RPM: state.engineRPM = value; break;
+        case FDR_ON_GROUND: state.onGround = flag; break;
+        case FDR_PARKING_BRAKE: state.parkingBrakeSet = flag; break;
+        case FDR_GEAR_DOWN: state.gearDown = flag; break;
+        case FDR_FLAPS: state.flapsPosition = static_cast<int>(value); break;
+        case FDR_MASTER_BATTERY: state.masterBattery = flag; break;
+        case FDR_MASTER_ALTERNATOR: state.masterAlternator = flag; break;
+        case FDR_BATTERY_VOLTAGE: state.batteryVoltage = value; break;
+        case FDR_BATTERY_LOAD: state.batteryLoad = value; break;
+        case FDR_GENERATOR_VOLTAGE: state.generatorVoltage = value; break;
+        case FDR_GENERATOR_LOAD: state.generatorLoad = value; break;
+        case FDR_AP_MASTER: autopilot.masterEnabled = flag; break;
+        case FDR_AP_HEADING_HOLD: autopilot.headingHold = flag; break;
+        case FDR_AP_ALTITUDE_HOLD: autopilot.altitudeHold = flag; break;
+        case FDR_AP_SPEED_HOLD: autopilot.speedHold = flag; break;
+        case FDR_AP_VERTICAL_SPEED_HOLD: autopilot.verticalSpeedHold = flag; break;
+        case FDR_AP_NAV: autopilot.navMode = flag; break;
+        case FDR_AP_APPROACH: autopilot.approachMode = flag; break;
+        case FDR_AP_AUTOTHROTTLE: autopilot.autoThrottle = flag; break;
+        case FDR_AP_TARGET_HEADING: autopilot.targetHeading = value; break;
+        case FDR_AP_TARGET_ALTITUDE: autopilot.targetAltitude = value; break;
+        case FDR_AP_TARGET_SPEED: autopilot.targetSpeed = value; break;
+        case FDR_AP_TARGET_VERTICAL_SPEED: autopilot.targetVerticalSpeed = value; break;
+        case FDR_FLIGHT_PHASE: {
+            int index = static_cast<int>(value);
+            phase = index >= 0 && index <= static_cast<int>(FlightPhase::UNKNOWN)
+                ? static_cast<FlightPhase>(index) : FlightPhase::UNKNOWN;
+            break;
+        }
+        default: break;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// FlightDataWriter
+// ---------------------------------------------------------------------------
+
+struct FlightDataWriter::Impl {
+    BitWriter columns[FDR_COLUMN_COUNT];
+    TimestampEncoder timestamps;
+    ValueEncoder values[FDR_COLUMN_COUNT];   // [0] unused
+    uint32_t rows = 0;
+    int64_t firstTimestampUs = 0;
+    int64_t lastTimestampUs = 0;
+};
+
+FlightDataWriter::FlightDataWriter(uint32_t rowsPerChunk)
+    : impl_(std::make_unique<Impl>()), rowsPerChunk_(std::max<uint32_t>(rowsPerChunk, 1)) {}
+
+FlightDataWriter::~FlightDataWriter() {
+    close();
+}
+
+bool FlightDataWriter::open(const std::string& path) {
+    close();
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        AICOPILOT_LOG_ERROR("Cannot create flight data recording {}", path);
+        return false;
+    }
+    FlightDataFileHeader header{};
+    std::memcpy(header.magic, FlightDataReader::MAGIC, sizeof(header.magic));
+    header.version = FlightDataReader::VERSION;
+    header.columnCount = FDR_COLUMN_COUNT;
+    header.rowsPerChunk = rowsPerChunk_;
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    rowCount_ = 0;
+    bytesWritten_ = sizeof(header);
+    *impl_ = Impl();
+    return static_cast<bool>(file_);
+}
+
+bool FlightDataWriter::append(const FlightDataSample& sample) {
+    if (!file_.is_open()) return false;
+    Impl& chunk = *impl_;
+    if (chunk.rows == 0) chunk.firstTimestampUs = sample.timestampUs;
+    chunk.lastTimestampUs = sample.timestampUs;
+    chunk.timestamps.append(chunk.columns[FDR_TIMESTAMP], sample.timestampUs);
+    for (uint32_t c = FDR_TIMESTAMP + 1; c < FDR_COLUMN_COUNT; ++c) {
+        auto column = static_cast<FlightDataColumn>(c);
+        chunk.values[c].append(chunk.columns[c], sample.column(column));
+    }
+    chunk.rows++;
+    rowCount_++;
+    return chunk.rows < rowsPerChunk_ || flush();
+}
+
+bool FlightDataWriter::flush() {
+    if (!file_.is_open()) return false;
+    Impl& chunk = *impl_;
+    if (chunk.rows == 0) return true;
+
+    FlightDataChunkHeader header{};
+    std::memcpy(header.magic, FlightDataReader::CHUNK_MAGIC, sizeof(header.magic));
+    header.rowCount = chunk.rows;
+    header.firstTimestampUs = chunk.firstTimestampUs;
+    header.lastTimestampUs = chunk.lastTimestampUs;
+    for (uint32_t c = 0; c < FDR_COLUMN_COUNT; ++c) {
+        const std::vector<uint8_t>& bytes = chunk.columns[c].bytes();
+        header.columnBytes[c] = static_cast<uint32_t>(bytes.size());
+        header.columnChecksum[c] = checksum(bytes.data(), bytes.size());
+    }
+    header.checksum = headerChecksum(header);
+
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    bytesWritten_ += sizeof(header);
+    for (uint32_t c = 0; c < FDR_COLUMN_COUNT; ++c) {
+        const std::vector<uint8_t>& bytes = chunk.columns[c].bytes();
+        file_.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        bytesWritten_ += bytes.size();
+        chunk.columns[c].clear();
+        chunk.values[c].reset();
+    }
+    chunk.timestamps.reset();
+    chunk.rows = 0;
+    file_.flush();
+    return static_cast<bool>(file_);
+}
+
+void FlightDataWriter::close() {
+    if (!file_.is_open()) return;
+    flush();
+    file_.close();
+}
+
+// ---------------------------------------------------------------------------
+// FlightDataReader
+// ---------------------------------------------------------------------------
+
+bool FlightDataReader::open(const std::string& path) {
+    close();
+    file_.open(path, std::ios::binary);
+    if (!file_.is_open()) return false;
+
+    file_.seekg(0, std::ios::end);
+    uint64_t fileSize = static_cast<uint64_t>(file_.tellg());
+    file_.seekg(0, std::ios::beg);
+
+    FlightDataFileHeader header{};
+    if (!file_.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.version != VERSION || header.columnCount != FDR_COLUMN_COUNT) {
+        close();
+        return false;
+    }
+
+    uint64_t offset = sizeof(header);
+    while (offset + sizeof(FlightDataChunkHeader) <= fileSize) {
+        ChunkEntry entry{};
+        file_.seekg(static_cast<std::streamoff>(offset));
+        if (!file_.read(reinterpret_cast<char*>(&entry.header), sizeof(entry.header))) break;
+        if (std::memcmp(entry.header.magic, CHUNK_MAGIC, sizeof(CHUNK_MAGIC)) != 0 ||
+            headerChecksum(entry.header) != entry.header.checksum) {
+            AICOPILOT_LOG_WARNING("Corrupt chunk header in flight data recording {}", path);
+            close();
+            return false;
+        }
+        uint64_t dataBytes = 0;
+        for (uint32_t c = 0; c < FDR_COLUMN_COUNT; ++c) dataBytes += entry.header.columnBytes[c];
+        entry.dataOffset = offset + sizeof(entry.header);
+        if (entry.dataOffset + dataBytes > fileSize) break;   // cut short while writing
+        chunks_.push_back(entry);
+        rowCount_ += entry.header.rowCount;
+        offset = entry.dataOffset + dataBytes;
+    }
+    file_.clear();
+    return true;
+}
+
+void FlightDataReader::close() {
+    if (file_.is_open()) file_.close();
+    file_.clear();
+    chunks_.clear();
+    rowCount_ = 0;
+}
+
+bool FlightDataReader::readColumnBytes(const ChunkEntry& chunk, FlightDataColumn column,
+                                       std::vector<uint8_t>& out) const {
+    uint64_t offset = chunk.dataOffset;
+    for (uint32_t c = 0; c < column; ++c) offset += chunk.header.columnBytes[c];
+    out.resize(chunk.header.columnBytes[column]);
+    file_.clear();
+    file_.seekg(static_cast<std::streamoff>(offset));
+    if (!out.empty() && !file_.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()))) {
+        return false;
+    }
+    return checksum(out.data(), out.size()) == chunk.header.columnChecksum[column];
+}
+
+bool FlightDataReader::decodeChunkTimestamps(const ChunkEntry& chunk, std::vector<int64_t>& out) const {
+    std::vector<uint8_t> bytes;
+    return readColumnBytes(chunk, FDR_TIMESTAMP, bytes) &&
+           decodeTimestamps(bytes.data(), bytes.size(), chunk.header.rowCount, out);
+}
+
+bool FlightDataReader::decodeChunkColumn(const ChunkEntry& chunk, FlightDataColumn column,
+                                         std::vector<double>& out) const {
+    if (column == FDR_TIMESTAMP) {
+        std::vector<int64_t> timestamps;
+        if (!decodeChunkTimestamps(chunk, timestamps)) return false;
+        for (int64_t t : timestamps) out.push_back(static_cast<double>(t));
+        return true;
+    }
+    std::vector<uint8_t> bytes;
+    return readColumnBytes(chunk, column, bytes) &&
+           decodeValues(bytes.data(), bytes.size(), chunk.header.rowCount, out);
+}
+
+bool FlightDataReader::readTimestamps(std::vector<int64_t>& out, int64_t startUs, int64_t endUs) const {
+    out.clear();
+    if (!isOpen()) return false;
+    std::vector<int64_t> chunkRows;
+    for (const ChunkEntry& chunk : chunks_) {
+        if (!overlaps(chunk.header, startUs, endUs)) continue;
+        chunkRows.clear();
+        if (!decodeChunkTimestamps(chunk, chunkRows)) return false;
+        for (int64_t t : chunkRows) {
+            if (t >= startUs && t <= endUs) out.push_back(t);
+        }
+    }
+    return true;
+}
+
+bool FlightDataReader::readColumn(FlightDataColumn column, std::vector<double>& out,
+                                  int64_t startUs, int64_t endUs) const {
+    out.clear();
+    if (!isOpen() || column >= FDR_COLUMN_COUNT) return false;
+    bool filter = !unbounded(startUs, endUs);
+    std::vector<double> values;
+    std::vector<int64_t> timestamps;
+    for (const ChunkEntry& chunk : chunks_) {
+        if (!overlaps(chunk.header, startUs, endUs)) continue;
+        if (!filter) {
+            if (!decodeChunkColumn(chunk, column, out)) return false;
+            continue;
+        }
+        values.clear();
+        timestamps.clear();
+        if (!decodeChunkColumn(chunk, column, values) || !decodeChunkTimestamps(chunk, timestamps)) return false;
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (timestamps[i] >= startUs && timestamps[i] <= endUs) out.push_back(values[i]);
+        }
+    }
+    return true;
+}
+
+bool FlightDataReader::readSamples(std::vector<FlightDataSample>& out) const {
+    out.clear();
+    if (!isOpen()) return false;
+    out.reserve(static_cast<size_t>(rowCount_));
+    std::vector<int64_t> timestamps;
+    std::vector<double> values;
+    for (const ChunkEntry& chunk : chunks_) {
+        timestamps.clear();
+        if (!decodeChunkTimestamps(chunk, timestamps)) return false;
+        size_t base = out.size();
+        out.resize(base + timestamps.size());
+        for (size_t i = 0; i < timestamps.size(); ++i) out[base + i].timestampUs = timestamps[i];
+        for (uint32_t c = FDR_TIMESTAMP + 1; c < FDR_COLUMN_COUNT; ++c) {
+            auto column = static_cast<FlightDataColumn>(c);
+            values.clear();
+            if (!decodeChunkColumn(chunk, column, values)) return false;
+            for (size_t i = 0; i < values.size(); ++i) out[base + i].setColumn(column, values[i]);
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// FlightDataStream / FlightDataRecorder
+// ---------------------------------------------------------------------------
+
+FlightDataStream::FlightDataStream(uint32_t rowsPerChunk, std::shared_ptr<FlightDataRecorderSync> sync)
+    : queue_(QUEUE_CAPACITY), writer_(rowsPerChunk), sync_(std::move(sync)) {}
+
+bool FlightDataStream::record(const FlightDataSample& sample) {
+    if (closing_.load(std::memory_order_acquire)) return false;
+    if (!queue_.push(sample)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    recorded_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void FlightDataStream::close() {
+    std::unique_lock<std::mutex> lock(sync_->mutex);
+    closing_.store(true, std::memory_order_release);
+    sync_->wake.notify_one();
+    sync_->closed.wait(lock, [this] { return closed_; });
+}
+
+FlightDataRecorder::FlightDataRecorder(uint32_t rowsPerChunk)
+    : rowsPerChunk_(rowsPerChunk), sync_(std::make_shared<FlightDataRecorderSync>()) {
+    writer_ = std::thread(&FlightDataRecorder::writerLoop, this);
+}
+
+FlightDataRecorder::~FlightDataRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(sync_->mutex);
+        stopping_ = true;
+    }
+    sync_->wake.notify_one();
+    if (writer_.joinable()) writer_.join();
+}
+
+std::shared_ptr<FlightDataRecorder> FlightDataRecorder::shared() {
+    static std::shared_ptr<FlightDataRecorder> recorder = std::make_shared<FlightDataRecorder>();
+    return recorder;
+}
+
+std::shared_ptr<FlightDataStream> FlightDataRecorder::openStream(const std::string& path) {
+    auto stream = std::make_shared<FlightDataStream>(rowsPerChunk_, sync_);
+    std::lock_guard<std::mutex> lock(sync_->mutex);
+    if (stopping_ || !stream->writer_.open(path)) return nullptr;
+    streams_.push_back(stream);
+    return stream;
+}
+
+size_t FlightDataRecorder::getStreamCount() const {
+    std::lock_guard<std::mutex> lock(sync_->mutex);
+    return streams_.size();
+}
+
+void FlightDataRecorder::writerLoop() {
+    std::unique_lock<std::mutex> lock(sync_->mutex);
+    while (!stopping_) {
+        sync_->wake.wait_for(lock, std::chrono::milliseconds(WRITER_INTERVAL_MS));
+        drainAll(stopping_);
+    }
+    drainAll(true);
+}
+
+// Called with sync_->mutex held
+void FlightDataRecorder::drainAll(bool finishAll) {
+    bool anyClosed = false;
+    FlightDataSample sample;
+    for (auto it = streams_.begin(); it != streams_.end();) {
+        FlightDataStream& stream = **it;
+        bool finishing = finishAll || stream.closing_.load(std::memory_order_acquire);
+        while (stream.queue_.pop(sample)) {
+            stream.writer_.append(sample);
+        }
+        if (!finishing) {
+            ++it;
+            continue;
+        }
+        stream.closing_.store(true, std::memory_order_release);
+        stream.writer_.close();
+        stream.closed_ = true;
+        anyClosed = true;
+        it = streams_.erase(it);
+    }
+    if (anyClosed) sync_->closed.notify_all();
+}
+
+} // namespace AICopilot
@@ -0,0 +1,123 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "hdr_histogram.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AICopilot {
+
+// ============================================================================
+// HdrHistogram Implementation
+// ============================================================================
+
+void HdrHistogram::recordMicros(uint64_t us) {
+    us = std::min(us, HdrLayout::MAX_VALUE_US);
+    buckets_[HdrLayout::bucketOf(us)]++;
+    count_++;
+    sumUs_ += us;
+    min_ = std::min(min_, us);
+    max_ = std::max(max_, us);
+}
+
+void HdrHistogram::merge(const HdrHistogram& other) {
+    for (size_t i = 0; i < HdrLayout::BUCKETS; ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sumUs_ += other.sumUs_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+double HdrHistogram::percentileMs(double p) const {
+    if (count_ == 0) {
+        return 0.0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * count_));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < HdrLayout::BUCKETS; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            return std::min(HdrLayout::bucketUpperUs(i), max_) / 1000.0;
+        }
+    }
+    return max_ / 1000.0;
+}
+
+// ============================================================================
+// ConcurrentHdrHistogram Implementation
+// ============================================================================
+
+size_t ConcurrentHdrHistogram::threadStripe() {
+    static std::atomic<size_t> nextStripe{0};
+    thread_local size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % STRIPES;
+    return stripe;
+}
+
+void ConcurrentHdrHistogram::recordMicros(uint64_t us) {
+    us = std::min(us, HdrLayout::MAX_VALUE_US);
+    Stripe& stripe = stripes_[threadStripe()];
+    stripe.buckets[HdrLayout::bucketOf(us)].fetch_add(1, std::memory_order_relaxed);
+    stripe.sumUs.fetch_add(us, std::memory_order_relaxed);
+    stripe.count.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t seen = stripe.min.load(std::memory_order_relaxed);
+    while (us < seen && !stripe.min.compare_exchange_weak(seen, us, std::memory_order_relaxed)) {
+    }
+    seen = stripe.max.load(std::memory_order_relaxed);
+    while (us > seen && !stripe.max.compare_exchange_weak(seen, us, std::memory_order_relaxed)) {
+    }
+}
+
+HdrHistogram ConcurrentHdrHistogram::snapshot() const {
+    HdrHistogram merged;
+    for (const Stripe& stripe : stripes_) {
+        for (size_t i = 0; i < HdrLayout::BUCKETS; ++i) {
+            uint64_t n = stripe.buckets[i].load(std::memory_order_relaxed);
+            merged.buckets_[i] += n;
+            merged.count_ += n;
+        }
+        merged.sumUs_ += stripe.sumUs.load(std::memory_order_relaxed);
+        merged.min_ = std::min(merged.min_, stripe.min.load(std::memory_order_relaxed));
+        merged.max_ = std::max(merged.max_, stripe.max.load(std::memory_order_relaxed));
+    }
+    return merged;
+}
+
+uint64_t ConcurrentHdrHistogram::count() const {
+    uint64_t total = 0;
+    for (const Stripe& stripe : stripes_) {
+        total += stripe.count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void ConcurrentHdrHistogram::reset() {
+    for (Stripe& stripe : stripes_) {
+        for (auto& bucket : stripe.buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        stripe.count.store(0, std::memory_order_relaxed);
+        stripe.sumUs.store(0, std::memory_order_relaxed);
+        stripe.min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+        stripe.max.store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace AICopilot
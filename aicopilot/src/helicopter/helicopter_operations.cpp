@@ -8,6 +8,13 @@
 
 namespace AICopilot {
 
+namespace {
+
+constexpr double FEET_PER_DEGREE = 60.0 * 6076.12;
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+} // namespace
+
 void HelicopterOperations::initialize(const HelicopterData& profile) {
     profile_ = profile;
     currentMode_ = HelicopterMode::UNKNOWN;
@@ -17,6 +24,8 @@ bool HelicopterOperations::initiateHover(double targetAltitudeAGL) {
     currentMode_ = HelicopterMode::HOVER;
     hoverState_.altitude = targetAltitudeAGL;
     hoverState_.stable = false;
+    holdCaptured_ = false;
+    holdPointFixed_ = false;
     return true;
 }
 
@@ -38,6 +47,7 @@ void HelicopterOperations::exitHover() {
 bool HelicopterOperations::initiateHoverTaxi(const Position& targetPosition, double speed) {
     currentMode_ = HelicopterMode::HOVER_TAXI;
     hoverTaxiTarget_ = targetPosition;
+    holdCaptured_ = false;
     return true;
 }
 
@@ -56,9 +66,11 @@ void HelicopterOperations::updateHoverTaxi(const AircraftState& state) {
     
     // Check if arrived at target
     if (distance < HOVER_TOLERANCE_LATERAL) {
-        // Arrived, transition to hover
+        // Arrived, transition to hover over the target
         currentMode_ = HelicopterMode::HOVER;
         hoverState_.stable = true;
+        holdPoint_ = hoverTaxiTarget_;
+        holdPointFixed_ = true;
     }
 }
 
@@ -197,6 +209,145 @@ void HelicopterOperations::maintainAutorotation(const AircraftState& state) {
     autorotationState_.inFlare = (currentAGL <= flareAltitude);
 }
 
+// ============================================================================
+// High-rate control path
+// ============================================================================
+
+RotorcraftControl HelicopterOperations::runFastControl(const AircraftState& state, double dt) {
+    RotorcraftControl control;
+    if (!needsFastControl()) {
+        hasLastPosition_ = false;
+        return control;
+    }
+    
+    updateDrift(state.position, dt);
+    if (!holdCaptured_) {
+        // Hold where the mode started unless a point was given
+        holdCaptured_ = true;
+        holdHeading_ = state.heading;
+        if (!holdPointFixed_) holdPoint_ = state.position;
+    }
+    
+    switch (currentMode_) {
+        case HelicopterMode::HOVER: {
+            maintainHover(state);
+            control = holdPosition(state, holdPoint_, HUGE_VAL, dt);
+            break;
+        }
+        case HelicopterMode::HOVER_TAXI:
+            updateHoverTaxi(state);
+            control = holdPosition(state, hoverTaxiTarget_, MAX_TAXI_ERROR, dt);
+            break;
+        case HelicopterMode::AUTOROTATION:
+            maintainAutorotation(state);
+            control.collective = autorotationState_.targetCollective;
+            if (autorotationState_.inFlare) {
+                control.cyclicLongitudinal = -MAX_HOVER_CYCLIC;
+            } else {
+                // Nose down when slow, up when fast, to hold the glide speed
+                control.cyclicLongitudinal = std::clamp(
+                    (profile_.autorotationSpeed - state.indicatedAirspeed) * AUTOROTATION_SPEED_GAIN,
+                    -MAX_HOVER_CYCLIC, MAX_HOVER_CYCLIC);
+            }
+            break;
+        default:
+            break;
+    }
+    return control;
+}
+
+void HelicopterOperations::updateDrift(const Position& position, double dt) {
+    sinceLastPosition_ += dt;
+    if (!hasLastPosition_) {
+        hasLastPosition_ = true;
+        lastPosition_ = position;
+        sinceLastPosition_ = 0.0;
+        velocityNorth_ = 0.0;
+        velocityEast_ = 0.0;
+        return;
+    }
+    // The loop can outrun state updates; differentiate only fresh positions
+    if (position.latitude == lastPosition_.latitude && position.longitude == lastPosition_.longitude) {
+        return;
+    }
+    if (sinceLastPosition_ <= 0.0) return;
+    
+    double north = (position.latitude - lastPosition_.latitude) * FEET_PER_DEGREE;
+    double east = (position.longitude - lastPosition_.longitude) * FEET_PER_DEGREE *
+                  std::cos(position.latitude * DEG_TO_RAD);
+    velocityNorth_ += VELOCITY_FILTER * (north / sinceLastPosition_ - velocityNorth_);
+    velocityEast_ += VELOCITY_FILTER * (east / sinceLastPosition_ - velocityEast_);
+    lastPosition_ = position;
+    sinceLastPosition_ = 0.0;
+}
+
+RotorcraftControl HelicopterOperations::holdPosition(const AircraftState& state, const Position& target,
+                                                     double maxError, double dt) {
+    RotorcraftControl control;
+    
+    double north = (target.latitude - state.position.latitude) * FEET_PER_DEGREE;
+    double east = (target.longitude - state.position.longitude) * FEET_PER_DEGREE *
+                  std::cos(state.position.latitude * DEG_TO_RAD);
+    double positionError = std::sqrt(north * north + east * east);
+    if (positionError > maxError) {
+        // Far targets saturate the error, which bounds hover taxi speed
+        north *= maxError / positionError;
+        east *= maxError / positionError;
+    }
+    
+    // Errors and drift into the body frame
+    double cosHeading = std::cos(state.heading * DEG_TO_RAD);
+    double sinHeading = std::sin(state.heading * DEG_TO_RAD);
+    double forward = north * cosHeading + east * sinHeading;
+    double right = -north * sinHeading + east * cosHeading;
+    double driftForward = velocityNorth_ * cosHeading + velocityEast_ * sinHeading;
+    double driftRight = -velocityNorth_ * sinHeading + velocityEast_ * cosHeading;
+    control.cyclicLongitudinal = std::clamp(POSITION_GAIN * forward - VELOCITY_GAIN * driftForward,
+                                            -MAX_HOVER_CYCLIC, MAX_HOVER_CYCLIC);
+    control.cyclicLateral = std::clamp(POSITION_GAIN * right - VELOCITY_GAIN * driftRight,
+                                       -MAX_HOVER_CYCLIC, MAX_HOVER_CYCLIC);
+    
+    // Collective holds height, with a slow trim for weight and density
+    double altitudeError = hoverState_.altitude -
+                           (state.position.altitude - getGroundElevation(state.position));
+    collectiveTrim_ = std::clamp(collectiveTrim_ + COLLECTIVE_TRIM_RATE * altitudeError * dt, 0.0, 1.0);
+    control.collective = std::clamp(collectiveTrim_ + ALTITUDE_GAIN * altitudeError -
+                                    VERTICAL_SPEED_GAIN * state.verticalSpeed, 0.0, 1.0);
+    
+    double headingError = std::remainder(holdHeading_ - state.heading, 360.0);
+    control.pedal = std::clamp(HEADING_GAIN * headingError, -1.0, 1.0);
+    
+    if (currentMode_ == HelicopterMode::HOVER) {
+        recordHoverQuality(state, positionError, altitudeError);
+    }
+    return control;
+}
+
+void HelicopterOperations::recordHoverQuality(const AircraftState& state, double positionError,
+                                              double altitudeError) {
+    HoverQualityStats& q = hoverQuality_;
+    q.samples++;
+    positionErrorSq_ += positionError * positionError;
+    altitudeErrorSq_ += altitudeError * altitudeError;
+    verticalSpeedSq_ += state.verticalSpeed * state.verticalSpeed;
+    if (hoverState_.stable) stableSamples_++;
+    
+    double n = static_cast<double>(q.samples);
+    q.rmsPositionError = std::sqrt(positionErrorSq_ / n);
+    q.maxPositionError = std::max(q.maxPositionError, positionError);
+    q.rmsAltitudeError = std::sqrt(altitudeErrorSq_ / n);
+    q.rmsVerticalSpeed = std::sqrt(verticalSpeedSq_ / n);
+    q.stableFraction = static_cast<double>(stableSamples_) / n;
+}
+
+void HelicopterOperations::resetHoverQuality() {
+    hoverQuality_ = HoverQualityStats();
+    positionErrorSq_ = 0.0;
+    altitudeErrorSq_ = 0.0;
+    verticalSpeedSq_ = 0.0;
+    stableSamples_ = 0;
+}
+
 double HelicopterOperations::getOptimalAutorotationSpeed() const {
     return profile_.autorotationSpeed;
 }
@@ -363,6 +514,9 @@ bool HelicopterOperations::performStationKeeping(const Position& station) {
     hoverState_.position = station;
     currentMode_ = HelicopterMode::HOVER;
     hoverState_.stable = false;  // Will become stable when position is maintained
+    holdPoint_ = station;
+    holdPointFixed_ = true;
+    holdCaptured_ = false;
     
     return true;
 }
@@ -0,0 +1,299 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "hot_path_trace.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace AICopilot {
+
+std::atomic<bool> HotPathTracer::enabled_{false};
+std::atomic<bool> HotPathTracer::recording_{false};
+
+namespace {
+
+static_assert((HotPathTracer::RING_EVENTS & (HotPathTracer::RING_EVENTS - 1)) == 0,
+              "RING_EVENTS must be a power of two");
+
+struct TraceEvent {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> startNs{0};
+    std::atomic<uint64_t> endNs{0};
+};
+
+/**
+ * One thread's events. The owning thread is the only writer: it bumps
+ * begun before touching a slot and committed after, so a reader that
+ * loads committed, copies slots, then loads begun can tell which of the
+ * slots it copied were being overwritten meanwhile.
+ */
+struct ThreadRing {
+    std::array<TraceEvent, HotPathTracer::RING_EVENTS> events;
+    std::atomic<uint64_t> begun{0};
+    std::atomic<uint64_t> committed{0};
+    std::atomic<uint64_t> exportFrom{0};   // committed count at the last clear()
+    uint32_t tid = 0;
+    std::string threadName;                // guarded by registryMutex
+};
+
+std::mutex registryMutex;
+std::vector<std::shared_ptr<ThreadRing>> rings;
+uint32_t nextTid = 1;
+
+std::atomic<uint32_t> sampleEvery{1};
+std::atomic<uint64_t> tickCounter{0};
+
+const auto traceEpoch = std::chrono::steady_clock::now();
+
+ThreadRing& threadRing() {
+    // Rings outlive their threads so exported traces keep finished workers
+    thread_local std::shared_ptr<ThreadRing> ring = [] {
+        auto created = std::make_shared<ThreadRing>();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        created->tid = nextTid++;
+        rings.push_back(created);
+        return created;
+    }();
+    return *ring;
+}
+
+void appendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(*c));
+                    out += escaped;
+                } else {
+                    out += *c;
+                }
+        }
+    }
+    out += '"';
+}
+
+struct CopiedEvent {
+    const char* name;
+    uint64_t startNs;
+    uint64_t endNs;
+};
+
+// Events since the last clear() still intact in the ring, oldest first
+void copyRing(const ThreadRing& ring, std::vector<CopiedEvent>& out) {
+    out.clear();
+    uint64_t committed = ring.committed.load(std::memory_order_acquire);
+    uint64_t from = std::max(ring.exportFrom.load(std::memory_order_relaxed),
+                             committed > HotPathTracer::RING_EVENTS ? committed - HotPathTracer::RING_EVENTS : 0);
+    for (uint64_t i = from; i < committed; ++i) {
+        const TraceEvent& event = ring.events[i & (HotPathTracer::RING_EVENTS - 1)];
+        out.push_back({event.name.load(std::memory_order_relaxed),
+                       event.startNs.load(std::memory_order_relaxed),
+                       event.endNs.load(std::memory_order_relaxed)});
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // Slots the owner started overwriting while we copied are discarded
+    uint64_t begun = ring.begun.load(std::memory_order_relaxed);
+    uint64_t firstValid = begun > HotPathTracer::RING_EVENTS ? begun - HotPathTracer::RING_EVENTS : 0;
+    if (firstValid > from) {
+        out.erase(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(std::min<uint64_t>(firstValid - from, out.size())));
+    }
+}
+
+std::vector<std::shared_ptr<ThreadRing>> snapshotRings() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return rings;
+}
+
+void appendMicros(std::string& out, uint64_t ns) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%llu.%03llu",
+                  static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>(ns % 1000));
+    out += buffer;
+}
+
+} // namespace
+
+// ============================================================================
+// HotPathTracer Implementation
+// ============================================================================
+
+void HotPathTracer::enable(uint32_t sampleEveryNTicks) {
+    sampleEvery.store(sampleEveryNTicks ? sampleEveryNTicks : 1, std::memory_order_relaxed);
+    tickCounter.store(0, std::memory_order_relaxed);
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void HotPathTracer::disable() {
+    enabled_.store(false, std::memory_order_relaxed);
+    recording_.store(false, std::memory_order_relaxed);
+}
+
+void HotPathTracer::beginTick() {
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    uint64_t tick = tickCounter.fetch_add(1, std::memory_order_relaxed);
+    recording_.store(tick % sampleEvery.load(std::memory_order_relaxed) == 0, std::memory_order_relaxed);
+}
+
+uint64_t HotPathTracer::nowNs() {
+    // Never 0, which TraceScope reserves for "not recording"
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - traceEpoch).count()) + 1;
+}
+
+void HotPathTracer::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadRing& ring = threadRing();
+    uint64_t index = ring.committed.load(std::memory_order_relaxed);
+    ring.begun.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    TraceEvent& event = ring.events[index & (RING_EVENTS - 1)];
+    event.name.store(name, std::memory_order_relaxed);
+    event.startNs.store(startNs, std::memory_order_relaxed);
+    event.endNs.store(endNs, std::memory_order_relaxed);
+    ring.committed.store(index + 1, std::memory_order_release);
+}
+
+const char* HotPathTracer::intern(const std::string& name) {
+    static std::mutex internMutex;
+    static std::unordered_set<std::string> names;
+    std::lock_guard<std::mutex> lock(internMutex);
+    return names.insert(name).first->c_str();
+}
+
+void HotPathTracer::setThreadName(const std::string& name) {
+    ThreadRing& ring = threadRing();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    ring.threadName = name;
+}
+
+std::string HotPathTracer::exportChromeTrace() {
+    std::vector<std::shared_ptr<ThreadRing>> snapshot;
+    std::vector<std::string> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        snapshot = rings;
+        for (const auto& ring : rings) {
+            threadNames.push_back(ring->threadName);
+        }
+    }
+
+    std::vector<CopiedEvent> copied;
+
+    std::string out = "{\"traceEvents\":[";
+    bool first = true;
+    for (size_t r = 0; r < snapshot.size(); ++r) {
+        std::string tid = std::to_string(snapshot[r]->tid);
+
+        if (!threadNames[r].empty()) {
+            out += first ? "" : ",";
+            first = false;
+            out += "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + tid + ",\"args\":{\"name\":";
+            appendJsonString(out, threadNames[r].c_str());
+            out += "}}";
+        }
+
+        copyRing(*snapshot[r], copied);
+        for (const CopiedEvent& event : copied) {
+            out += first ? "" : ",";
+            first = false;
+            out += "\n{\"name\":";
+            appendJsonString(out, event.name ? event.name : "?");
+            out += ",\"ph\":\"X\",\"pid\":1,\"tid\":" + tid + ",\"ts\":";
+            appendMicros(out, event.startNs);
+            out += ",\"dur\":";
+            appendMicros(out, event.endNs > event.startNs ? event.endNs - event.startNs : 0);
+            out += "}";
+        }
+    }
+    out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out;
+}
+
+std::vector<TraceSummary> HotPathTracer::summarize() {
+    std::vector<TraceSummary> summary;
+    std::vector<CopiedEvent> copied;
+    for (const auto& ring : snapshotRings()) {
+        copyRing(*ring, copied);
+        for (const CopiedEvent& event : copied) {
+            const char* name = event.name ? event.name : "?";
+            auto found = std::find_if(summary.begin(), summary.end(), [name](const TraceSummary& entry) {
+                return entry.name == name || std::strcmp(entry.name, name) == 0;
+            });
+            if (found == summary.end()) {
+                summary.push_back({name, 0, 0, 0});
+                found = summary.end() - 1;
+            }
+            uint64_t duration = event.endNs > event.startNs ? event.endNs - event.startNs : 0;
+            found->count++;
+            found->totalNs += duration;
+            found->maxNs = std::max(found->maxNs, duration);
+        }
+    }
+    std::sort(summary.begin(), summary.end(), [](const TraceSummary& a, const TraceSummary& b) {
+        return a.totalNs > b.totalNs;
+    });
+    return summary;
+}
+
+bool HotPathTracer::writeChromeTrace(const std::string& path) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file << exportChromeTrace();
+    return static_cast<bool>(file);
+}
+
+void HotPathTracer::clear() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto& ring : rings) {
+        ring->exportFrom.store(ring->committed.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+uint64_t HotPathTracer::overwrittenEvents() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    uint64_t overwritten = 0;
+    for (const auto& ring : rings) {
+        uint64_t committed = ring->committed.load(std::memory_order_relaxed);
+        uint64_t from = ring->exportFrom.load(std::memory_order_relaxed);
+        if (committed > from + RING_EVENTS) {
+            overwritten += committed - from - RING_EVENTS;
+        }
+    }
+    return overwritten;
+}
+
+} // namespace AICopilot
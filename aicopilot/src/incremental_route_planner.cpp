@@ -0,0 +1,179 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Incremental Route Planner Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "incremental_route_planner.hpp"
+#include <algorithm>
+
+namespace AICopilot {
+
+uint32_t IncrementalRoutePlanner::addNode() {
+    outgoing_.emplace_back();
+    incoming_.emplace_back();
+    g_.push_back(INFINITE_COST);
+    rhs_.push_back(INFINITE_COST);
+    queuedKey_.emplace_back();
+    queued_.push_back(false);
+    return static_cast<uint32_t>(g_.size() - 1);
+}
+
+uint32_t IncrementalRoutePlanner::addEdge(uint32_t from, uint32_t to, double cost) {
+    uint32_t id = static_cast<uint32_t>(edges_.size());
+    edges_.push_back({from, to, INFINITE_COST});
+    outgoing_[from].push_back(id);
+    incoming_[to].push_back(id);
+    updateEdgeCost(id, cost);
+    return id;
+}
+
+void IncrementalRoutePlanner::updateEdgeCost(uint32_t edge, double cost) {
+    Edge& e = edges_[edge];
+    const double old = e.cost;
+    e.cost = cost;
+    if (!hasGoal_ || old == cost || e.from == goal_) return;
+
+    // Only the tail's one-step lookahead depends on the edge
+    if (cost < old) {
+        rhs_[e.from] = std::min(rhs_[e.from], cost + g_[e.to]);
+    } else if (rhs_[e.from] == old + g_[e.to]) {
+        recomputeRhs(e.from);
+    }
+    updateVertex(e.from);
+}
+
+void IncrementalRoutePlanner::setGoal(uint32_t goal) {
+    std::fill(g_.begin(), g_.end(), INFINITE_COST);
+    std::fill(rhs_.begin(), rhs_.end(), INFINITE_COST);
+    std::fill(queued_.begin(), queued_.end(), false);
+    queue_.clear();
+    km_ = 0.0;
+    hasStart_ = false;
+    hasGoal_ = true;
+    goal_ = goal;
+    rhs_[goal] = 0.0;
+    updateVertex(goal);
+}
+
+double IncrementalRoutePlanner::findPath(uint32_t start, std::vector<uint32_t>& path) {
+    path.clear();
+    expanded_ = 0;
+    if (!hasGoal_) return INFINITE_COST;
+
+    if (hasStart_ && start != start_) {
+        km_ += h(start_, start);
+    }
+    start_ = start;
+    hasStart_ = true;
+    computeShortestPath();
+
+    // The start may be left overconsistent; rhs is its cost either way
+    if (rhs_[start] == INFINITE_COST) return INFINITE_COST;
+
+    // Greedy descent on g; a consistent search has no cycles to follow
+    uint32_t node = start;
+    path.push_back(node);
+    while (node != goal_ && path.size() <= g_.size()) {
+        uint32_t next = node;
+        double best = INFINITE_COST;
+        for (uint32_t id : outgoing_[node]) {
+            double cost = edges_[id].cost + g_[edges_[id].to];
+            if (cost < best) {
+                best = cost;
+                next = edges_[id].to;
+            }
+        }
+        if (next == node) {
+            path.clear();
+            return INFINITE_COST;
+        }
+        node = next;
+        path.push_back(node);
+    }
+    return rhs_[start];
+}
+
+void IncrementalRoutePlanner::clear() {
+    edges_.clear();
+    outgoing_.clear();
+    incoming_.clear();
+    g_.clear();
+    rhs_.clear();
+    queuedKey_.clear();
+    queued_.clear();
+    queue_.clear();
+    hasGoal_ = false;
+    hasStart_ = false;
+    km_ = 0.0;
+    expanded_ = 0;
+}
+
+IncrementalRoutePlanner::Key IncrementalRoutePlanner::calculateKey(uint32_t node) const {
+    double best = std::min(g_[node], rhs_[node]);
+    double toStart = hasStart_ ? h(start_, node) : 0.0;
+    return {best + toStart + km_, best};
+}
+
+void IncrementalRoutePlanner::updateVertex(uint32_t node) {
+    if (queued_[node]) {
+        queue_.erase({queuedKey_[node], node});
+        queued_[node] = false;
+    }
+    if (g_[node] != rhs_[node]) {
+        queuedKey_[node] = calculateKey(node);
+        queue_.insert({queuedKey_[node], node});
+        queued_[node] = true;
+    }
+}
+
+void IncrementalRoutePlanner::recomputeRhs(uint32_t node) {
+    if (node == goal_) return;
+    double best = INFINITE_COST;
+    for (uint32_t id : outgoing_[node]) {
+        best = std::min(best, edges_[id].cost + g_[edges_[id].to]);
+    }
+    rhs_[node] = best;
+}
+
+void IncrementalRoutePlanner::computeShortestPath() {
+    while (!queue_.empty() &&
+           (queue_.begin()->first < calculateKey(start_) || rhs_[start_] > g_[start_])) {
+        const Key oldKey = queue_.begin()->first;
+        const uint32_t node = queue_.begin()->second;
+        const Key newKey = calculateKey(node);
+        expanded_++;
+
+        if (oldKey < newKey) {
+            updateVertex(node);  // key was stale after the start moved
+        } else if (g_[node] > rhs_[node]) {
+            g_[node] = rhs_[node];
+            updateVertex(node);
+            for (uint32_t id : incoming_[node]) {
+                const Edge& e = edges_[id];
+                if (e.from != goal_) {
+                    rhs_[e.from] = std::min(rhs_[e.from], e.cost + g_[node]);
+                }
+                updateVertex(e.from);
+            }
+        } else {
+            const double oldG = g_[node];
+            g_[node] = INFINITE_COST;
+            for (uint32_t id : incoming_[node]) {
+                const Edge& e = edges_[id];
+                if (rhs_[e.from] == e.cost + oldG) {
+                    recomputeRhs(e.from);
+                }
+                updateVertex(e.from);
+            }
+            updateVertex(node);
+        }
+    }
+}
+
+} // namespace AICopilot
@@ -0,0 +1,104 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* I/O Executor Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/io_executor.hpp"
+#include <exception>
+#include <iostream>
+
+namespace AICopilot {
+
+IoExecutor::IoExecutor(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = DEFAULT_THREAD_COUNT;
+    }
+    threads_.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads_.emplace_back(&IoExecutor::workerLoop, this);
+    }
+}
+
+IoExecutor::~IoExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    workCv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+std::shared_ptr<IoExecutor> IoExecutor::shared() {
+    static std::shared_ptr<IoExecutor> executor = std::make_shared<IoExecutor>();
+    return executor;
+}
+
+void IoExecutor::post(Job job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(std::move(job));
+        stats_.submitted++;
+    }
+    workCv_.notify_one();
+}
+
+void IoExecutor::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleCv_.wait(lock, [this] { return jobs_.empty() && running_ == 0; });
+}
+
+IoExecutorStats IoExecutor::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    IoExecutorStats stats = stats_;
+    stats.queued = jobs_.size();
+    stats.running = running_;
+    stats.threads = threads_.size();
+    return stats;
+}
+
+void IoExecutor::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        // Queued jobs still run after stopping_, so no future is left broken
+        workCv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (jobs_.empty()) {
+            return;
+        }
+        Job job = std::move(jobs_.front());
+        jobs_.pop_front();
+        running_++;
+        lock.unlock();
+
+        bool failed = false;
+        try {
+            job();
+        } catch (const std::exception& e) {
+            std::cerr << "IoExecutor: job failed: " << e.what() << std::endl;
+            failed = true;
+        } catch (...) {
+            std::cerr << "IoExecutor: job failed" << std::endl;
+            failed = true;
+        }
+        job = nullptr;   // release captures before reporting idle
+
+        lock.lock();
+        running_--;
+        stats_.completed++;
+        if (failed) {
+            stats_.failed++;
+        }
+        if (jobs_.empty() && running_ == 0) {
+            idleCv_.notify_all();
+        }
+    }
+}
+
+} // namespace AICopilot
@@ -0,0 +1,201 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "keyword_spotter.hpp"
+#include "audio_kernels.hpp"
+#include "voice_input.hpp"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr int32_t NO_PATH = INT32_MAX / 2;
+
+// Band centres across the voice band, closer together where formants live
+constexpr double BAND_CENTRES_HZ[KeywordSpotter::BANDS] = {300, 500, 800, 1200, 1700, 2400, 3300, 4500};
+
+// Samples per Goertzel block: 250 Hz wide bands at 16 kHz
+constexpr size_t FEATURE_BLOCK = 64;
+
+// Bands more than this far below a frame's strongest one are all alike
+constexpr int32_t FEATURE_FLOOR = 6 * 256;      // 18 dB in Q8 log2 power
+
+// Frames this far below the loudest one are trimmed from an enrollment's ends
+constexpr int64_t ENROLL_TRIM_RATIO = 100;     // 20 dB
+
+const int32_t* bandCoefficients() {
+    static const std::array<int32_t, KeywordSpotter::BANDS> coefficients = [] {
+        std::array<int32_t, KeywordSpotter::BANDS> q14{};
+        for (size_t b = 0; b < KeywordSpotter::BANDS; ++b) {
+            double omega = 2.0 * 3.14159265358979323846 * BAND_CENTRES_HZ[b] / AudioFormat::SAMPLE_RATE;
+            q14[b] = static_cast<int32_t>(std::lround(2.0 * std::cos(omega) * 16384.0));
+        }
+        return q14;
+    }();
+    return coefficients.data();
+}
+
+int32_t distance(const KeywordSpotter::Features& a, const KeywordSpotter::Features& b) {
+    int32_t sum = 0;
+    for (size_t i = 0; i < KeywordSpotter::BANDS; ++i) {
+        int32_t d = int32_t(a[i]) - int32_t(b[i]);
+        sum += d < 0 ? -d : d;
+    }
+    return sum;
+}
+
+} // namespace
+
+// ============================================================================
+// KeywordSpotter Implementation
+// ============================================================================
+
+KeywordSpotter::KeywordSpotter(int32_t threshold)
+    : threshold_(threshold), last_score_(INT32_MAX), candidate_(INT32_MAX) {
+}
+
+KeywordSpotter::Features KeywordSpotter::extractFeatures(const int16_t* samples, size_t count) {
+    // Short blocks widen each Goertzel band to about sample rate / block,
+    // a filter bank rather than single bins
+    uint64_t power[BANDS] = {};
+    for (size_t start = 0; start + FEATURE_BLOCK <= count; start += FEATURE_BLOCK) {
+        uint64_t block[BANDS];
+        AudioKernels::goertzelPowers<BANDS>(samples + start, FEATURE_BLOCK, bandCoefficients(), block);
+        for (size_t b = 0; b < BANDS; ++b) power[b] += block[b];
+    }
+
+    int32_t logs[BANDS];
+    int32_t peak = 0;
+    for (size_t b = 0; b < BANDS; ++b) {
+        logs[b] = AudioKernels::log2Q8(power[b]);
+        peak = std::max(peak, logs[b]);
+    }
+
+    // Relative to the strongest band, floored so bands lost in noise
+    // compare equal however loud the noise is
+    Features features;
+    for (size_t b = 0; b < BANDS; ++b) {
+        features[b] = static_cast<int16_t>(std::max(logs[b] - peak, -FEATURE_FLOOR));
+    }
+    return features;
+}
+
+bool KeywordSpotter::enroll(const int16_t* samples, size_t count) {
+    // Same front end as VoiceInput: pre-emphasis, then whole frames
+    const size_t frameSize = AudioFormat::FRAME_SIZE;
+    std::vector<int16_t> emphasized(samples, samples + count);
+    AudioKernels::preEmphasis(emphasized.data(), emphasized.size(), AudioPreprocessor::PRE_EMPHASIS, 0);
+
+    size_t frameCount = emphasized.size() / frameSize;
+    std::vector<int64_t> energy(frameCount);
+    int64_t loudest = 0;
+    for (size_t f = 0; f < frameCount; ++f) {
+        energy[f] = AudioKernels::sumOfSquares(emphasized.data() + f * frameSize, frameSize);
+        loudest = std::max(loudest, energy[f]);
+    }
+    size_t first = 0;
+    size_t last = frameCount;
+    while (first < last && energy[first] * ENROLL_TRIM_RATIO < loudest) ++first;
+    while (last > first && energy[last - 1] * ENROLL_TRIM_RATIO < loudest) --last;
+
+    // The phrase must stand out of the silence around it
+    bool framed = first > 0 && last < frameCount;
+    size_t length = last - first;
+    if (!framed || length < MIN_TEMPLATE_FRAMES || length > MAX_TEMPLATE_FRAMES) {
+        return false;
+    }
+
+    Template example;
+    example.frames.reserve(length);
+    for (size_t f = first; f < last; ++f) {
+        example.frames.push_back(extractFeatures(emphasized.data() + f * frameSize, frameSize));
+    }
+    example.cost.assign(length + 1, NO_PATH);
+    example.steps.assign(length + 1, 0);
+    example.cost[0] = 0;
+    templates_.push_back(std::move(example));
+    return true;
+}
+
+void KeywordSpotter::clearTemplates() {
+    templates_.clear();
+    last_score_ = INT32_MAX;
+    candidate_ = INT32_MAX;
+}
+
+void KeywordSpotter::reset() {
+    for (auto& example : templates_) {
+        std::fill(example.cost.begin() + 1, example.cost.end(), NO_PATH);
+        std::fill(example.steps.begin(), example.steps.end(), 0);
+    }
+    candidate_ = INT32_MAX;
+}
+
+bool KeywordSpotter::processFrame(const int16_t* samples, size_t count) {
+    if (templates_.empty()) return false;
+    Features input = extractFeatures(samples, count);
+
+    // One DTW column per example. Each cell comes from staying on its
+    // template frame, advancing one, or skipping one, so a match may run
+    // from half to twice the example's speed; columns update back to front
+    // so each cell still reads the previous frame's neighbours.
+    int32_t best = INT32_MAX;
+    for (auto& example : templates_) {
+        const size_t length = example.frames.size();
+        const int32_t maxSteps = static_cast<int32_t>(2 * length);
+        for (size_t j = length; j >= 1; --j) {
+            int32_t from = example.cost[j];
+            int32_t steps = example.steps[j];
+            if (example.cost[j - 1] < from) {
+                from = example.cost[j - 1];
+                steps = example.steps[j - 1];
+            }
+            if (j >= 2 && example.cost[j - 2] < from) {
+                from = example.cost[j - 2];
+                steps = example.steps[j - 2];
+            }
+            if (from >= NO_PATH || steps >= maxSteps) {
+                example.cost[j] = NO_PATH;
+                example.steps[j] = 0;
+                continue;
+            }
+            example.cost[j] = std::min(NO_PATH, from + distance(input, example.frames[j - 1]));
+            example.steps[j] = steps + 1;
+        }
+
+        if (example.cost[length] < NO_PATH) {
+            int32_t score = example.cost[length] / (example.steps[length] * static_cast<int32_t>(BANDS));
+            best = std::min(best, score);
+        }
+    }
+    last_score_ = best;
+
+    // An alignment ending a frame later usually fits better still; wake
+    // once the score stops improving, so the whole phrase has been heard
+    if (best <= threshold_ && best <= candidate_) {
+        candidate_ = best;
+        return false;
+    }
+    if (candidate_ > threshold_) return false;
+    reset();
+    return true;
+}
+
+} // namespace AICopilot
@@ -0,0 +1,221 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "memory_arena.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <new>
+
+namespace AICopilot {
+
+// ============================================================================
+// FrameArena Implementation
+// ============================================================================
+
+FrameArena::FrameArena(size_t initialBytes) {
+    addChunk(std::max<size_t>(initialBytes, 64));
+}
+
+FrameArena::~FrameArena() {
+    releaseChunks();
+}
+
+void FrameArena::reset() {
+    highWater_ = std::max(highWater_, used_);
+    if (chunks_.size() > 1) {
+        size_t merged = capacity();
+        releaseChunks();
+        addChunk(merged);
+    }
+    current_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
+
+size_t FrameArena::capacity() const {
+    size_t total = 0;
+    for (const Chunk& chunk : chunks_) {
+        total += chunk.size;
+    }
+    return total;
+}
+
+FrameArena& FrameArena::forThread() {
+    thread_local FrameArena arena;
+    return arena;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    while (true) {
+        for (; current_ < chunks_.size(); ++current_, offset_ = 0) {
+            Chunk& chunk = chunks_[current_];
+            void* p = chunk.data + offset_;
+            size_t space = chunk.size - offset_;
+            if (std::align(alignment, bytes, p, space)) {
+                size_t consumed = (chunk.size - offset_) - space + bytes;
+                offset_ += consumed;
+                used_ += consumed;
+                return p;
+            }
+        }
+        // Grow geometrically; the next reset folds this into one chunk
+        current_ = chunks_.size();
+        offset_ = 0;
+        addChunk(std::max(chunks_.back().size * 2, bytes + alignment));
+    }
+}
+
+void FrameArena::addChunk(size_t size) {
+    Chunk chunk;
+    chunk.data = static_cast<std::byte*>(::operator new(size, std::align_val_t(alignof(std::max_align_t))));
+    chunk.size = size;
+    chunks_.push_back(chunk);
+    chunkAllocations_++;
+}
+
+void FrameArena::releaseChunks() {
+    for (const Chunk& chunk : chunks_) {
+        ::operator delete(chunk.data, std::align_val_t(alignof(std::max_align_t)));
+    }
+    chunks_.clear();
+}
+
+// ============================================================================
+// SlabPool Implementation
+// ============================================================================
+
+namespace {
+
+constexpr size_t THREAD_CACHE_SLOTS = 4;   // pools a thread caches blocks for at once
+std::atomic<uint64_t> nextPoolId{1};
+
+size_t roundUp(size_t value, size_t multiple) {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+} // namespace
+
+struct SlabPool::ThreadCache {
+    uint64_t poolId = 0;
+    FreeBlock* head = nullptr;
+    size_t count = 0;
+};
+
+SlabPool::SlabPool(size_t blockSize, size_t blocksPerSlab, std::pmr::memory_resource* upstream)
+    : blockSize_(roundUp(std::max(blockSize, sizeof(FreeBlock)), alignof(std::max_align_t))),
+      blocksPerSlab_(std::max<size_t>(blocksPerSlab, 1)),
+      upstream_(upstream),
+      id_(nextPoolId.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+SlabPool::~SlabPool() {
+    // Thread caches still naming this pool are stale; ids are never reused
+    for (std::byte* slab : slabs_) {
+        upstream_->deallocate(slab, blockSize_ * blocksPerSlab_, alignof(std::max_align_t));
+    }
+}
+
+void* SlabPool::allocate() {
+    ThreadCache& cache = threadCache();
+    if (!cache.head) {
+        refill(cache);
+    }
+    FreeBlock* block = cache.head;
+    cache.head = block->next;
+    cache.count--;
+    return block;
+}
+
+void SlabPool::deallocate(void* block) {
+    if (!block) return;
+    ThreadCache& cache = threadCache();
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = cache.head;
+    cache.head = freed;
+    if (++cache.count > THREAD_CACHE_BLOCKS) {
+        drain(cache, THREAD_CACHE_BLOCKS / 2);
+    }
+}
+
+size_t SlabPool::slabCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slabs_.size();
+}
+
+SlabPool::ThreadCache& SlabPool::threadCache() {
+    thread_local std::array<ThreadCache, THREAD_CACHE_SLOTS> caches;
+    for (ThreadCache& cache : caches) {
+        if (cache.poolId == id_) return cache;
+    }
+    // Claim a slot; blocks a displaced pool had cached stay in its slabs
+    ThreadCache& cache = caches[id_ % THREAD_CACHE_SLOTS];
+    cache.poolId = id_;
+    cache.head = nullptr;
+    cache.count = 0;
+    return cache;
+}
+
+void SlabPool::refill(ThreadCache& cache) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!free_) {
+        std::byte* slab = static_cast<std::byte*>(
+            upstream_->allocate(blockSize_ * blocksPerSlab_, alignof(std::max_align_t)));
+        slabs_.push_back(slab);
+        for (size_t i = blocksPerSlab_; i-- > 0;) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * blockSize_);
+            block->next = free_;
+            free_ = block;
+        }
+    }
+    for (size_t i = 0; i < THREAD_CACHE_BLOCKS / 2 && free_; ++i) {
+        FreeBlock* block = free_;
+        free_ = block->next;
+        block->next = cache.head;
+        cache.head = block;
+        cache.count++;
+    }
+}
+
+void SlabPool::drain(ThreadCache& cache, size_t keep) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (cache.count > keep) {
+        FreeBlock* block = cache.head;
+        cache.head = block->next;
+        block->next = free_;
+        free_ = block;
+        cache.count--;
+    }
+}
+
+void* SlabPool::do_allocate(size_t bytes, size_t alignment) {
+    if (fitsBlock(bytes, alignment)) {
+        return allocate();
+    }
+    return upstream_->allocate(bytes, alignment);
+}
+
+void SlabPool::do_deallocate(void* p, size_t bytes, size_t alignment) {
+    if (fitsBlock(bytes, alignment)) {
+        deallocate(p);
+    } else {
+        upstream_->deallocate(p, bytes, alignment);
+    }
+}
+
+} // namespace AICopilot
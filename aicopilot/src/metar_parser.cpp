@@ -11,7 +11,6 @@
 *****************************************************************************/
 
 #include "metar_parser.hpp"
-#include <sstream>
 #include <iostream>
 #include <algorithm>
 #include <cctype>
@@ -33,8 +32,16 @@ const std::string METARParser::ALTIMETER_PATTERN = "^[AQ][0-9]{4}$";
 // Core Parsing Methods
 // ============================================================================
 
+// The token classifier is usable at compile time
+static_assert(METARParser::classifyToken("27015G25KT") == METARTokenType::WIND, "wind token");
+static_assert(METARParser::classifyToken("1/4SM") == METARTokenType::VISIBILITY, "visibility token");
+static_assert(METARParser::classifyToken("+TSRA") == METARTokenType::WEATHER, "weather token");
+static_assert(METARParser::classifyToken("BKN015CB") == METARTokenType::CLOUD, "cloud token");
+static_assert(METARParser::classifyToken("M05/M08") == METARTokenType::TEMPERATURE, "temperature token");
+static_assert(METARParser::classifyToken("AO2") == METARTokenType::UNKNOWN, "remark token");
+
 bool METARParser::parseWind(
-    const std::string& windToken,
+    std::string_view windToken,
     int& direction,
     int& speed,
     int& gust,
@@ -42,293 +49,308 @@ bool METARParser::parseWind(
     int& minDir,
     int& maxDir) {
     
-    direction = 0;
-    speed = 0;
-    gust = 0;
-    variable = false;
+    METARSyntax::WindGroup wind = METARSyntax::decodeWind(windToken);
+    direction = wind.direction;
+    speed = wind.speed;
+    gust = wind.gust;
+    variable = wind.variable;
     minDir = 0;
     maxDir = 0;
-    
-    if (windToken.empty() || windToken.size() < 7) return false;
-    
-    try {
-        // Check for variable wind (VRB)
-        if (windToken.substr(0, 3) == "VRB") {
-            variable = true;
-            speed = std::stoi(windToken.substr(3, 2));
-        } else {
-            // Parse direction (first 3 chars)
-            direction = std::stoi(windToken.substr(0, 3));
-            if (direction < 0 || direction > 360) return false;
-            
-            // Parse speed (next 2-3 chars)
-            size_t speedStart = 3;
-            size_t speedLen = 0;
-            while (speedStart + speedLen < windToken.size() && 
-                   std::isdigit(windToken[speedStart + speedLen])) {
-                speedLen++;
-            }
-            if (speedLen == 0 || speedLen > 3) return false;
-            speed = std::stoi(windToken.substr(speedStart, speedLen));
-        }
-        
-        // Parse gusts (G prefix)
-        size_t gustPos = windToken.find('G');
-        if (gustPos != std::string::npos && gustPos + 2 <= windToken.size()) {
-            size_t gustLen = 0;
-            while (gustPos + 1 + gustLen < windToken.size() && 
-                   std::isdigit(windToken[gustPos + 1 + gustLen])) {
-                gustLen++;
-            }
-            if (gustLen > 0) {
-                gust = std::stoi(windToken.substr(gustPos + 1, gustLen));
-            }
-        }
-        
-        return true;
-    } catch (...) {
-        return false;
-    }
+    return wind.valid;
 }
 
 bool METARParser::parseVisibility(
-    const std::string& visToken,
+    std::string_view visToken,
     double& visibilitySmiles) {
     
-    visibilitySmiles = 10.0;  // Default unlimited
-    
-    if (visToken.empty()) return false;
-    
-    try {
-        // Format: 9999, 10SM, 1/4SM, etc.
-        if (visToken.find("SM") != std::string::npos) {
-            // Statute miles format
-            std::string numPart = visToken.substr(0, visToken.find("SM"));
-            
-            if (numPart.find('/') != std::string::npos) {
-                // Fractional format (1/4SM)
-                size_t slashPos = numPart.find('/');
-                double numerator = std::stod(numPart.substr(0, slashPos));
-                double denominator = std::stod(numPart.substr(slashPos + 1));
-                if (denominator != 0) {
-                    visibilitySmiles = numerator / denominator;
-                }
-            } else {
-                visibilitySmiles = std::stod(numPart);
-            }
-            return true;
-        } else if (std::all_of(visToken.begin(), visToken.end(), ::isdigit)) {
-            // Meter format (4 digits: 9999)
-            int meters = std::stoi(visToken);
-            visibilitySmiles = convertVisibilityToStatuteMiles(meters, 'M');
-            return true;
-        }
-    } catch (...) {
-        return false;
-    }
-    
-    return false;
+    METARSyntax::VisibilityGroup vis = METARSyntax::decodeVisibility(visToken);
+    visibilitySmiles = vis.valid ? vis.statuteMiles : Visibility::MAX_VISIBILITY_SM;
+    return vis.valid;
 }
 
 bool METARParser::parseCloudLayer(
-    const std::string& cloudToken,
+    std::string_view cloudToken,
     CloudCoverage& coverage,
     int& altitudeAgl,
     bool& isCB,
     bool& isTCU) {
     
-    coverage = CloudCoverage::UNKNOWN;
-    altitudeAgl = 0;
-    isCB = false;
-    isTCU = false;
-    
-    if (cloudToken.empty() || cloudToken.size() < 3) return false;
-    
-    try {
-        // Parse coverage (first 3 chars)
-        std::string covStr = cloudToken.substr(0, 3);
-        if (covStr == "SKC") {
-            coverage = CloudCoverage::SKC;
-            return true;
-        } else if (covStr == "CLR") {
-            coverage = CloudCoverage::CLR;
-            return true;
-        } else if (covStr == "FEW") {
-            coverage = CloudCoverage::FEW;
-        } else if (covStr == "SCT") {
-            coverage = CloudCoverage::SCT;
-        } else if (covStr == "BKN") {
-            coverage = CloudCoverage::BKN;
-        } else if (covStr == "OVC") {
-            coverage = CloudCoverage::OVC;
-        } else if (covStr == "VV") {
-            coverage = CloudCoverage::VV;
-            // Vertical visibility format: VV002
-            if (cloudToken.size() >= 5) {
-                altitudeAgl = std::stoi(cloudToken.substr(2, 3)) * 100;  // VV values are in hundreds
-            }
-            return true;
-        } else {
-            return false;
-        }
-        
-        // Parse altitude (3 digits = hundreds of feet)
-        if (cloudToken.size() >= 6) {
-            std::string altStr = cloudToken.substr(3, 3);
-            if (std::all_of(altStr.begin(), altStr.end(), ::isdigit)) {
-                altitudeAgl = std::stoi(altStr) * 100;
-            } else {
-                return false;
-            }
-        } else {
-            return false;
-        }
-        
-        // Check for cloud type (CB, TCU)
-        if (cloudToken.find("CB") != std::string::npos) {
-            isCB = true;
-        }
-        if (cloudToken.find("TCU") != std::string::npos) {
-            isTCU = true;
-        }
-        
-        return true;
-    } catch (...) {
-        return false;
-    }
+    METARSyntax::CloudGroup cloud = METARSyntax::decodeCloud(cloudToken);
+    coverage = cloud.coverage;
+    altitudeAgl = cloud.altitudeFeet;
+    isCB = cloud.cumulonimbus;
+    isTCU = cloud.toweringCumulus;
+    if (!cloud.valid) coverage = CloudCoverage::UNKNOWN;
+    return cloud.valid;
 }
 
 bool METARParser::parseTemperatureDewpoint(
-    const std::string& tempToken,
+    std::string_view tempToken,
     int& temperature,
     int& dewpoint) {
     
-    temperature = 0;
-    dewpoint = 0;
-    
-    if (tempToken.empty() || tempToken.find('/') == std::string::npos) return false;
-    
-    try {
-        size_t slashPos = tempToken.find('/');
-        std::string tempStr = tempToken.substr(0, slashPos);
-        std::string dewStr = tempToken.substr(slashPos + 1);
-        
-        // Parse temperature
-        if (tempStr.substr(0, 1) == "M") {
-            temperature = -std::stoi(tempStr.substr(1));
-        } else {
-            temperature = std::stoi(tempStr);
-        }
-        
-        // Parse dewpoint
-        if (dewStr.substr(0, 1) == "M") {
-            dewpoint = -std::stoi(dewStr.substr(1));
-        } else {
-            dewpoint = std::stoi(dewStr);
-        }
-        
-        return true;
-    } catch (...) {
-        return false;
-    }
+    METARSyntax::TemperatureGroup temp = METARSyntax::decodeTemperature(tempToken);
+    temperature = temp.temperature;
+    dewpoint = temp.dewpoint;
+    return temp.valid && temp.hasDewpoint;
 }
 
 bool METARParser::parseAltimeter(
-    const std::string& altimeterToken,
+    std::string_view altimeterToken,
     double& altimeterInHg,
     double& altimeterMbar) {
     
-    altimeterInHg = 29.92;  // Standard pressure
-    altimeterMbar = 1013.0;
-    
-    if (altimeterToken.empty() || altimeterToken.size() < 5) return false;
-    
-    try {
-        char unit = altimeterToken[0];  // 'A' for inHg, 'Q' for hectopascals
-        std::string valueStr = altimeterToken.substr(1);
-        
-        if (!std::all_of(valueStr.begin(), valueStr.end(), ::isdigit)) return false;
-        
-        if (unit == 'A') {
-            // inHg format: A3012 = 30.12 inHg
-            int value = std::stoi(valueStr);
-            altimeterInHg = value / 100.0;
-            altimeterMbar = altimeterInHg * 33.8639;
-            return true;
-        } else if (unit == 'Q') {
-            // Hectopascals format: Q1018 = 1018 mb
-            int value = std::stoi(valueStr);
-            altimeterMbar = value;
-            altimeterInHg = value / 33.8639;
-            return true;
-        }
-        
-        return false;
-    } catch (...) {
-        return false;
-    }
+    METARSyntax::AltimeterGroup alt = METARSyntax::decodeAltimeter(altimeterToken);
+    altimeterInHg = alt.inHg;
+    altimeterMbar = alt.mbar;
+    return alt.valid;
 }
 
 bool METARParser::parseWeatherPhenomena(
-    const std::string& phenomToken,
+    std::string_view phenomToken,
     WeatherPhenomenaCode& phenomena,
     int& intensity) {
     
+    struct Named {
+        std::string_view token;
+        WeatherPhenomenaCode code;
+    };
+    static constexpr Named CODES[] = {
+        {"RA", WeatherPhenomenaCode::RA},     {"SN", WeatherPhenomenaCode::SN},
+        {"RASN", WeatherPhenomenaCode::RASN}, {"SNRA", WeatherPhenomenaCode::SNRA},
+        {"SG", WeatherPhenomenaCode::SG},     {"IC", WeatherPhenomenaCode::IC},
+        {"PE", WeatherPhenomenaCode::PE},     {"GR", WeatherPhenomenaCode::GR},
+        {"GS", WeatherPhenomenaCode::GS},     {"UP", WeatherPhenomenaCode::UP},
+        {"DZ", WeatherPhenomenaCode::DZ},     {"PL", WeatherPhenomenaCode::PL},
+        {"FZRA", WeatherPhenomenaCode::FZRA}, {"FZDZ", WeatherPhenomenaCode::FZDZ},
+        {"TS", WeatherPhenomenaCode::TS},     {"TSRA", WeatherPhenomenaCode::TSRA},
+        {"TSSN", WeatherPhenomenaCode::TSSN}, {"TSGS", WeatherPhenomenaCode::TSGS},
+        {"TSGR", WeatherPhenomenaCode::TSGR}, {"VC", WeatherPhenomenaCode::VC},
+        {"FG", WeatherPhenomenaCode::FG},     {"MIFG", WeatherPhenomenaCode::MIFG},
+        {"VCTS", WeatherPhenomenaCode::VCTS}, {"CAVOK", WeatherPhenomenaCode::CAVOK},
+    };
+    
     phenomena = WeatherPhenomenaCode::UNKNOWN;
     intensity = 0;
     
-    if (phenomToken.empty()) return false;
-    
-    std::string token = phenomToken;
+    std::string_view token = phenomToken;
     
     // Check for intensity prefix
-    if (token[0] == '+') {
+    if (!token.empty() && token[0] == '+') {
         intensity = 1;  // Heavy
-        token = token.substr(1);
-    } else if (token[0] == '-') {
+        token.remove_prefix(1);
+    } else if (!token.empty() && token[0] == '-') {
         intensity = -1;  // Light
-        token = token.substr(1);
+        token.remove_prefix(1);
+    }
+    
+    for (const Named& named : CODES) {
+        if (token == named.token) {
+            phenomena = named.code;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool METARParser::parse(std::string_view metar, METARObservation& observation) {
+    observation = METARObservation{};
+    
+    if (metar.size() > METARObservation::MAX_REPORT_LENGTH) {
+        observation.error = "METAR string too long";
+        return false;
+    }
+    
+    METARTokenizer tokens(metar);
+    std::string_view token;
+    
+    // Station ID (required), after an optional report type
+    do {
+        if (!tokens.next(token)) {
+            observation.error = "Empty METAR string";
+            return false;
+        }
+    } while (classifyToken(token) == METARTokenType::REPORT_TYPE);
+    
+    if (!METARSyntax::isStationId(token)) {
+        observation.error = "Invalid station ID";
+        return false;
+    }
+    for (size_t i = 0; i < token.size(); ++i) {
+        observation.station[i] = token[i];
+    }
+    
+    // Date/Time (required)
+    int day = 0, hour = 0, minute = 0;
+    if (!tokens.next(token) || !METARSyntax::decodeDateTime(token, day, hour, minute)) {
+        observation.error = "Invalid date/time";
+        return false;
     }
+    observation.day = static_cast<uint8_t>(day);
+    observation.hour = static_cast<uint8_t>(hour);
+    observation.minute = static_cast<uint8_t>(minute);
     
-    // Parse weather code
-    if (token == "RA") phenomena = WeatherPhenomenaCode::RA;
-    else if (token == "SN") phenomena = WeatherPhenomenaCode::SN;
-    else if (token == "RASN") phenomena = WeatherPhenomenaCode::RASN;
-    else if (token == "SG") phenomena = WeatherPhenomenaCode::SG;
-    else if (token == "IC") phenomena = WeatherPhenomenaCode::IC;
-    else if (token == "PE") phenomena = WeatherPhenomenaCode::PE;
-    else if (token == "GR") phenomena = WeatherPhenomenaCode::GR;
-    else if (token == "GS") phenomena = WeatherPhenomenaCode::GS;
-    else if (token == "UP") phenomena = WeatherPhenomenaCode::UP;
-    else if (token == "DZ") phenomena = WeatherPhenomenaCode::DZ;
-    else if (token == "PL") phenomena = WeatherPhenomenaCode::PL;
-    else if (token == "FZRA") phenomena = WeatherPhenomenaCode::FZRA;
-    else if (token == "FZDZ") phenomena = WeatherPhenomenaCode::FZDZ;
-    else if (token == "TS") phenomena = WeatherPhenomenaCode::TS;
-    else if (token == "TSRA") phenomena = WeatherPhenomenaCode::TSRA;
-    else if (token == "TSSN") phenomena = WeatherPhenomenaCode::TSSN;
-    else if (token == "TSGS") phenomena = WeatherPhenomenaCode::TSGS;
-    else if (token == "TSGR") phenomena = WeatherPhenomenaCode::TSGR;
-    else if (token == "FG") phenomena = WeatherPhenomenaCode::FG;
-    else if (token == "MIFG") phenomena = WeatherPhenomenaCode::MIFG;
-    else if (token == "CAVOK") phenomena = WeatherPhenomenaCode::CAVOK;
-    else return false;
+    // Body, in any order; a lone whole number waits for its fraction
+    double wholeMiles = 0.0;
+    bool inTrend = false;
     
-    return phenomena != WeatherPhenomenaCode::UNKNOWN;
+    while (tokens.next(token)) {
+        METARTokenType type = classifyToken(token);
+        
+        if (type == METARTokenType::REMARKS) {
+            std::string_view remarks = tokens.rest();
+            observation.remarksOffset = static_cast<uint16_t>(metar.size() - remarks.size());
+            observation.remarksLength = static_cast<uint16_t>(remarks.size());
+            if (!remarks.empty() && remarks.back() == '=') observation.remarksLength--;
+            break;
+        }
+        
+        // Trend forecasts describe the next two hours, not the observation
+        if (inTrend) continue;
+        
+        if (type != METARTokenType::VISIBILITY) wholeMiles = 0.0;
+        
+        switch (type) {
+            case METARTokenType::MODIFIER:
+                if (token == "AUTO") observation.automated = true;
+                else observation.corrected = true;
+                break;
+            
+            case METARTokenType::WIND: {
+                METARSyntax::WindGroup wind = METARSyntax::decodeWind(token);
+                observation.hasWind = true;
+                observation.windVariable = wind.variable;
+                observation.windDirection = wind.direction;
+                observation.windSpeed = wind.speed;
+                observation.windGust = wind.gust;
+                break;
+            }
+            
+            case METARTokenType::WIND_VARIATION: {
+                METARSyntax::WindVariation range = METARSyntax::decodeWindVariation(token);
+                observation.variableMinDir = range.from;
+                observation.variableMaxDir = range.to;
+                break;
+            }
+            
+            case METARTokenType::VISIBILITY_WHOLE:
+                wholeMiles = METARSyntax::digitsValue(token);
+                break;
+            
+            case METARTokenType::VISIBILITY: {
+                METARSyntax::VisibilityGroup vis = METARSyntax::decodeVisibility(token);
+                observation.hasVisibility = true;
+                observation.visibilitySM = vis.statuteMiles + (vis.fractional ? wholeMiles : 0.0);
+                wholeMiles = 0.0;
+                break;
+            }
+            
+            case METARTokenType::CAVOK:
+                observation.cavok = true;
+                observation.hasVisibility = true;
+                observation.visibilitySM = Visibility::MAX_VISIBILITY_SM;
+                break;
+            
+            case METARTokenType::WEATHER: {
+                METARSyntax::WeatherGroup wx = METARSyntax::decodeWeather(token);
+                if (wx.components == 0) break;  // NSW
+                if (observation.weatherCount == METARObservation::MAX_WEATHER_GROUPS) {
+                    observation.truncated = true;
+                    break;
+                }
+                METARObservation::Weather& group = observation.weather[observation.weatherCount++];
+                group.components = wx.components;
+                group.intensity = static_cast<int8_t>(wx.intensity);
+                group.vicinity = wx.vicinity;
+                group.offset = static_cast<uint16_t>(token.data() - metar.data());
+                group.length = static_cast<uint16_t>(token.size());
+                break;
+            }
+            
+            case METARTokenType::CLOUD: {
+                if (observation.cloudCount == METARObservation::MAX_CLOUD_LAYERS) {
+                    observation.truncated = true;
+                    break;
+                }
+                METARSyntax::CloudGroup cloud = METARSyntax::decodeCloud(token);
+                METARObservation::Cloud& layer = observation.clouds[observation.cloudCount++];
+                layer.coverage = cloud.coverage;
+                layer.altitudeFeet = cloud.altitudeFeet;
+                layer.cumulonimbus = cloud.cumulonimbus;
+                layer.toweringCumulus = cloud.toweringCumulus;
+                break;
+            }
+            
+            case METARTokenType::VERTICAL_VISIBILITY:
+                observation.verticalVisibilityFeet = METARSyntax::decodeCloud(token).altitudeFeet;
+                break;
+            
+            case METARTokenType::TEMPERATURE: {
+                METARSyntax::TemperatureGroup temp = METARSyntax::decodeTemperature(token);
+                observation.hasTemperature = true;
+                observation.hasDewpoint = temp.hasDewpoint;
+                observation.temperature = temp.temperature;
+                observation.dewpoint = temp.dewpoint;
+                break;
+            }
+            
+            case METARTokenType::ALTIMETER: {
+                METARSyntax::AltimeterGroup alt = METARSyntax::decodeAltimeter(token);
+                observation.hasAltimeter = true;
+                observation.altimeterInHg = alt.inHg;
+                observation.altimeterMbar = alt.mbar;
+                break;
+            }
+            
+            case METARTokenType::TREND:
+                inTrend = true;
+                break;
+            
+            case METARTokenType::SKY_CLEAR:
+            case METARTokenType::RUNWAY_RANGE:
+                break;
+            
+            default:
+                observation.unknownTokens++;
+                break;
+        }
+    }
+    
+    return true;
 }
 
 // ============================================================================
 // Utility Methods
 // ============================================================================
 
-std::string METARParser::identifyTokenType(const std::string& token) {
-    if (matchesPattern(token, "^[0-9]{3}[0-9]{2,3}")) return "wind";
-    if (matchesPattern(token, "^[0-9]{4}$|^[0-9]+SM$")) return "visibility";
-    if (matchesPattern(token, "^(FEW|SCT|BKN|OVC|SKC|CLR|VV)")) return "clouds";
-    if (matchesPattern(token, "^M?[0-9]{2}/M?[0-9]{2}$")) return "temperature";
-    if (matchesPattern(token, "^[AQ][0-9]{4}$")) return "altimeter";
-    if (matchesPattern(token, "^[+\\-]?[A-Z]{2,4}$")) return "weather";
-    return "unknown";
+std::string METARParser::identifyTokenType(std::string_view token) {
+    switch (classifyToken(token)) {
+        case METARTokenType::WIND:
+        case METARTokenType::WIND_VARIATION:
+            return "wind";
+        case METARTokenType::VISIBILITY:
+        case METARTokenType::VISIBILITY_WHOLE:
+        case METARTokenType::CAVOK:
+            return "visibility";
+        case METARTokenType::CLOUD:
+        case METARTokenType::SKY_CLEAR:
+        case METARTokenType::VERTICAL_VISIBILITY:
+            return "clouds";
+        case METARTokenType::TEMPERATURE:
+            return "temperature";
+        case METARTokenType::ALTIMETER:
+            return "altimeter";
+        case METARTokenType::WEATHER:
+            return "weather";
+        case METARTokenType::DATE_TIME:
+            return "datetime";
+        case METARTokenType::RUNWAY_RANGE:
+            return "runway";
+        case METARTokenType::REMARKS:
+            return "remarks";
+        default:
+            return "unknown";
+    }
 }
 
 bool METARParser::matchesPattern(
@@ -448,14 +470,14 @@ bool METARParser::isValidICAOCode(const std::string& code) {
 }
 
 std::vector<std::string> METARParser::tokenizeMETAR(
-    const std::string& metarString) {
+    std::string_view metarString) {
     
     std::vector<std::string> tokens;
-    std::istringstream iss(metarString);
-    std::string token;
+    METARTokenizer tokenizer(metarString);
+    std::string_view token;
     
-    while (iss >> token) {
-        tokens.push_back(token);
+    while (tokenizer.next(token)) {
+        tokens.emplace_back(token);
     }
     
     return tokens;
@@ -0,0 +1,484 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "metrics_exporter.hpp"
+#include "performance_optimizer.hpp"
+#include "system_monitor.hpp"
+#include "task_scheduler.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace AICopilot {
+
+namespace {
+
+constexpr uintptr_t NO_SOCKET = ~uintptr_t(0);
+constexpr size_t MAX_REQUEST_BYTES = 4096;
+
+void closeSocket(uintptr_t socket) {
+#ifdef _WIN32
+    closesocket(static_cast<SOCKET>(socket));
+#else
+    close(static_cast<int>(socket));
+#endif
+}
+
+void appendEscaped(std::string& out, const std::string& value) {
+    for (char c : value) {
+        if (c == '\\') out += "\\\\";
+        else if (c == '"') out += "\\\"";
+        else if (c == '\n') out += "\\n";
+        else out += c;
+    }
+}
+
+std::string renderLabels(const MetricLabels& labels) {
+    std::string out;
+    for (const auto& label : labels) {
+        if (!out.empty()) out += ',';
+        out += label.first;
+        out += "=\"";
+        appendEscaped(out, label.second);
+        out += '"';
+    }
+    return out;
+}
+
+void appendNumber(std::string& out, double value) {
+    if (std::isnan(value)) { out += "NaN"; return; }
+    if (std::isinf(value)) { out += value > 0 ? "+Inf" : "-Inf"; return; }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    out += buffer;
+}
+
+// name{labels,extra} value
+void appendSample(std::string& out, const std::string& name, const std::string& labels,
+                  const std::string& extra, double value) {
+    out += name;
+    if (!labels.empty() || !extra.empty()) {
+        out += '{';
+        out += labels;
+        if (!labels.empty() && !extra.empty()) out += ',';
+        out += extra;
+        out += '}';
+    }
+    out += ' ';
+    appendNumber(out, value);
+    out += '\n';
+}
+
+void appendHistogram(std::string& out, const std::string& name, const std::string& labels,
+                     const HdrHistogram& histogram) {
+    const auto& buckets = histogram.buckets();
+    uint64_t cumulative = 0;
+    size_t next = 0;
+    for (double bound : MetricsRegistry::HISTOGRAM_BOUNDS_SECONDS) {
+        uint64_t boundUs = static_cast<uint64_t>(bound * 1e6);
+        while (next < HdrLayout::BUCKETS && HdrLayout::bucketUpperUs(next) <= boundUs) {
+            cumulative += buckets[next++];
+        }
+        char le[40];
+        std::snprintf(le, sizeof(le), "le=\"%g\"", bound);
+        appendSample(out, name + "_bucket", labels, le, static_cast<double>(cumulative));
+    }
+    appendSample(out, name + "_bucket", labels, "le=\"+Inf\"", static_cast<double>(histogram.count()));
+    appendSample(out, name + "_sum", labels, "", histogram.meanMs() * histogram.count() / 1000.0);
+    appendSample(out, name + "_count", labels, "", static_cast<double>(histogram.count()));
+}
+
+const char* componentLabel(SystemComponent component) {
+    switch (component) {
+        case SystemComponent::WEATHER_SYSTEM: return "weather";
+        case SystemComponent::TERRAIN_AWARENESS: return "terrain";
+        case SystemComponent::NAVIGATION: return "navigation";
+        case SystemComponent::AIRCRAFT_SYSTEMS: return "aircraft_systems";
+        case SystemComponent::TRAFFIC_MANAGEMENT: return "traffic";
+        case SystemComponent::PERFORMANCE_OPTIMIZER: return "performance_optimizer";
+        case SystemComponent::ADVANCED_PROCEDURES: return "advanced_procedures";
+        case SystemComponent::DYNAMIC_PLANNING: return "dynamic_planning";
+        case SystemComponent::VOICE_PIPELINE: return "voice_pipeline";
+        default: return "unknown";
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// MetricsRegistry Implementation
+// ============================================================================
+
+const std::vector<double> MetricsRegistry::HISTOGRAM_BOUNDS_SECONDS = {
+    0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+};
+
+void MetricsRegistry::setConstantLabels(const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    constantLabels_ = renderLabels(labels);
+}
+
+MetricsRegistry::Series& MetricsRegistry::findOrAdd(const std::string& name, const std::string& help,
+                                                    Type type, const MetricLabels& labels) {
+    Family& family = families_[name];
+    if (family.series.empty()) {
+        family.type = type;
+        family.help = help;
+    }
+    std::string rendered = renderLabels(labels);
+    for (Series& series : family.series) {
+        if (series.labels == rendered) return series;
+    }
+    family.series.push_back(Series());
+    family.series.back().labels = std::move(rendered);
+    return family.series.back();
+}
+
+MetricCounter& MetricsRegistry::counter(const std::string& name, const std::string& help,
+                                        const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Series& series = findOrAdd(name, help, Type::COUNTER, labels);
+    if (!series.counter) {
+        counters_.emplace_back();
+        series.counter = &counters_.back();
+    }
+    return *series.counter;
+}
+
+MetricGauge& MetricsRegistry::gauge(const std::string& name, const std::string& help,
+                                    const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Series& series = findOrAdd(name, help, Type::GAUGE, labels);
+    if (!series.gauge) {
+        gauges_.emplace_back();
+        series.gauge = &gauges_.back();
+    }
+    return *series.gauge;
+}
+
+ConcurrentHdrHistogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                                   const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Series& series = findOrAdd(name, help, Type::HISTOGRAM, labels);
+    if (!series.histogram) {
+        histograms_.emplace_back();
+        series.histogram = &histograms_.back();
+    }
+    return *series.histogram;
+}
+
+void MetricsRegistry::addHistogramSource(const std::string& name, const std::string& help,
+                                         const MetricLabels& labels, HistogramSource source) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    findOrAdd(name, help, Type::HISTOGRAM, labels).source = std::move(source);
+}
+
+void MetricsRegistry::addCollector(Collector collector) {
+    std::lock_guard<std::mutex> lock(collectorMutex_);
+    collectors_.push_back(std::move(collector));
+}
+
+std::string MetricsRegistry::scrape() {
+    {
+        std::lock_guard<std::mutex> lock(collectorMutex_);
+        for (const Collector& collector : collectors_) {
+            collector(*this);
+        }
+    }
+    return render();
+}
+
+std::string MetricsRegistry::render() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string out;
+    out.reserve(families_.size() * 160);
+
+    for (const auto& entry : families_) {
+        const std::string& name = entry.first;
+        const Family& family = entry.second;
+        out += "# HELP " + name + " " + family.help + "\n";
+        out += "# TYPE " + name + " ";
+        out += family.type == Type::COUNTER ? "counter\n" : family.type == Type::GAUGE ? "gauge\n" : "histogram\n";
+
+        for (const Series& series : family.series) {
+            std::string labels = constantLabels_;
+            if (!labels.empty() && !series.labels.empty()) labels += ',';
+            labels += series.labels;
+
+            if (series.counter) {
+                appendSample(out, name, labels, "", static_cast<double>(series.counter->value()));
+            } else if (series.gauge) {
+                appendSample(out, name, labels, "", series.gauge->value());
+            } else if (series.histogram) {
+                appendHistogram(out, name, labels, series.histogram->snapshot());
+            } else if (series.source) {
+                appendHistogram(out, name, labels, series.source());
+            }
+        }
+    }
+    return out;
+}
+
+// ============================================================================
+// MetricsHttpServer Implementation
+// ============================================================================
+
+MetricsHttpServer::MetricsHttpServer(MetricsRegistry& registry)
+    : registry_(registry), listenSocket_(NO_SOCKET) {
+}
+
+MetricsHttpServer::~MetricsHttpServer() {
+    stop();
+}
+
+bool MetricsHttpServer::start(uint16_t port, const std::string& bindAddress) {
+    if (running_) {
+        return false;
+    }
+#ifdef _WIN32
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+        return false;
+    }
+#endif
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, bindAddress.c_str(), &address.sin_addr) != 1) {
+        return false;
+    }
+
+    auto fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+#ifdef _WIN32
+    if (fd == INVALID_SOCKET) { WSACleanup(); return false; }
+#else
+    if (fd < 0) return false;
+#endif
+    uintptr_t listener = static_cast<uintptr_t>(fd);
+
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+    socklen_t length = sizeof(address);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(fd, 8) != 0 ||
+        getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        closeSocket(listener);
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return false;
+    }
+
+    listenSocket_ = listener;
+    port_ = ntohs(address.sin_port);
+    running_ = true;
+    thread_ = std::thread(&MetricsHttpServer::serveLoop, this);
+    return true;
+}
+
+void MetricsHttpServer::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    closeSocket(listenSocket_);
+    listenSocket_ = NO_SOCKET;
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+std::string MetricsHttpServer::respond(const std::string& request) {
+    size_t lineEnd = request.find("\r\n");
+    std::string line = request.substr(0, lineEnd);
+    std::string status = "200 OK";
+    std::string contentType = "text/plain; version=0.0.4; charset=utf-8";
+    std::string body;
+
+    if (line.compare(0, 4, "GET ") != 0) {
+        status = "405 Method Not Allowed";
+        body = "GET only\n";
+    } else {
+        std::string target = line.substr(4, line.find(' ', 4) - 4);
+        if (target == "/metrics" || target.compare(0, 9, "/metrics?") == 0) {
+            body = registry_.scrape();
+        } else {
+            status = "404 Not Found";
+            body = "try /metrics\n";
+        }
+    }
+    if (status.compare(0, 3, "200") != 0) {
+        contentType = "text/plain; charset=utf-8";
+    }
+
+    return "HTTP/1.0 " + status + "\r\nContent-Type: " + contentType +
+           "\r\nContent-Length: " + std::to_string(body.size()) +
+           "\r\nConnection: close\r\n\r\n" + body;
+}
+
+void MetricsHttpServer::serveLoop() {
+    while (running_) {
+        // Wake periodically so stop() never waits on accept
+        fd_set readable;
+        FD_ZERO(&readable);
+#ifdef _WIN32
+        SOCKET listener = static_cast<SOCKET>(listenSocket_);
+#else
+        int listener = static_cast<int>(listenSocket_);
+#endif
+        FD_SET(listener, &readable);
+        timeval timeout{0, 200 * 1000};
+        if (select(static_cast<int>(listener) + 1, &readable, nullptr, nullptr, &timeout) <= 0) {
+            continue;
+        }
+
+        auto client = accept(listener, nullptr, nullptr);
+#ifdef _WIN32
+        if (client == INVALID_SOCKET) continue;
+        DWORD receiveTimeout = 2000;
+#else
+        if (client < 0) continue;
+        timeval receiveTimeout{2, 0};
+#endif
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&receiveTimeout),
+                   sizeof(receiveTimeout));
+
+        std::string request;
+        char buffer[1024];
+        while (request.size() < MAX_REQUEST_BYTES && request.find("\r\n\r\n") == std::string::npos) {
+            int received = static_cast<int>(recv(client, buffer, sizeof(buffer), 0));
+            if (received <= 0) break;
+            request.append(buffer, static_cast<size_t>(received));
+        }
+
+        if (!request.empty()) {
+            std::string response = respond(request);
+            size_t sent = 0;
+            while (sent < response.size()) {
+                int n = static_cast<int>(send(client, response.data() + sent,
+                                              static_cast<int>(response.size() - sent), 0));
+                if (n <= 0) break;
+                sent += static_cast<size_t>(n);
+            }
+        }
+        closeSocket(static_cast<uintptr_t>(client));
+    }
+}
+
+// ============================================================================
+// Component bindings
+// ============================================================================
+
+void bindSystemMonitorMetrics(MetricsRegistry& registry, const SystemMonitor& monitor) {
+    for (size_t i = 0; i < SYSTEM_COMPONENT_COUNT; ++i) {
+        SystemComponent component = static_cast<SystemComponent>(i);
+        registry.addHistogramSource("aicopilot_component_latency_seconds",
+                                    "Query latency per monitored component",
+                                    {{"component", componentLabel(component)}},
+                                    [&monitor, component] { return monitor.getLatencyHistogram(component); });
+    }
+
+    registry.addCollector([&monitor](MetricsRegistry& r) {
+        SystemMonitor::HealthReport report = monitor.getHealthReport();
+        r.gauge("aicopilot_health_score", "Overall system health, 0-100").set(report.healthScore);
+        for (const ComponentHealth& health : report.components) {
+            MetricLabels labels = {{"component", componentLabel(health.component)}};
+            r.counter("aicopilot_component_queries_total", "Queries handled per component", labels)
+                .set(health.queryCount);
+            r.gauge("aicopilot_component_error_rate_percent", "Errors per query per component", labels)
+                .set(health.errorRate);
+            r.gauge("aicopilot_component_memory_bytes", "Memory attributed to each component", labels)
+                .set(static_cast<double>(health.memoryUsage));
+        }
+
+        SystemMonitor::ResourceUtilization util = monitor.getResourceUtilization();
+        r.gauge("aicopilot_process_cpu_percent", "Process CPU use across all cores").set(util.cpuPercentage);
+        r.gauge("aicopilot_process_resident_bytes", "Process resident set").set(static_cast<double>(util.residentBytes));
+        r.gauge("aicopilot_process_threads", "Process thread count").set(util.threadCount);
+        r.gauge("aicopilot_disk_busy_percent", "Busiest disk's active time").set(util.diskIOPercentage);
+
+        SystemMonitor::SystemStatistics stats = monitor.getSystemStatistics();
+        r.counter("aicopilot_queries_total", "Queries recorded by the system monitor").set(stats.totalQueries);
+        r.counter("aicopilot_errors_total", "Errors recorded by the system monitor").set(stats.totalErrors);
+        r.gauge("aicopilot_uptime_seconds", "Seconds since the monitor initialized")
+            .set(static_cast<double>(stats.uptimeSeconds));
+        r.gauge("aicopilot_degradation_level", "Load-shedding steps in effect")
+            .set(static_cast<double>(monitor.getDegradationState().level));
+    });
+}
+
+void bindPerformanceOptimizerMetrics(MetricsRegistry& registry, const PerformanceOptimizer& optimizer) {
+    registry.addCollector([&optimizer](MetricsRegistry& r) {
+        PerformanceMetrics cache = optimizer.getCacheStatistics();
+        publishCacheStatistics(r, "query", cache.cacheHits,
+                               cache.queryCount > cache.cacheHits ? cache.queryCount - cache.cacheHits : 0, 0);
+        r.gauge("aicopilot_cache_memory_bytes", "Bytes held by each cache", {{"cache", "query"}})
+            .set(static_cast<double>(cache.memoryUsed));
+
+        PerformanceOptimizer::PrefetchStatus prefetch = optimizer.getPrefetchStatus();
+        r.gauge("aicopilot_prefetch_active", "Prefetches queued or loading").set(prefetch.activePrefetches);
+        r.counter("aicopilot_prefetch_completed_total", "Prefetches loaded").set(prefetch.completedPrefetches);
+        r.counter("aicopilot_prefetch_failed_total", "Prefetches that found no data").set(prefetch.failedPrefetches);
+    });
+}
+
+void bindTaskSchedulerMetrics(MetricsRegistry& registry, const TaskScheduler& scheduler) {
+    registry.addCollector([&scheduler](MetricsRegistry& r) {
+        for (const ScheduledTaskStats& task : scheduler.getStats()) {
+            MetricLabels labels = {{"task", task.name}};
+            r.counter("aicopilot_task_runs_total", "Scheduled task runs", labels).set(task.runCount);
+            r.counter("aicopilot_task_overruns_total", "Scheduled task deadline misses", labels)
+                .set(task.deadlineMisses);
+            r.gauge("aicopilot_task_max_duration_seconds", "Longest run of each scheduled task", labels)
+                .set(task.maxDurationMs / 1000.0);
+        }
+    });
+}
+
+void publishCacheStatistics(MetricsRegistry& registry, const std::string& cache,
+                            uint64_t hits, uint64_t misses, uint64_t entries) {
+    MetricLabels labels = {{"cache", cache}};
+    registry.counter("aicopilot_cache_hits_total", "Cache lookups answered from the cache", labels).set(hits);
+    registry.counter("aicopilot_cache_misses_total", "Cache lookups that missed", labels).set(misses);
+    uint64_t lookups = hits + misses;
+    registry.gauge("aicopilot_cache_hit_ratio", "Hits over lookups, 0 before the first lookup", labels)
+        .set(lookups ? static_cast<double>(hits) / lookups : 0.0);
+    if (entries) {
+        registry.gauge("aicopilot_cache_entries", "Entries held by each cache", labels)
+            .set(static_cast<double>(entries));
+    }
+}
+
+} // namespace AICopilot
@@ -4,6 +4,7 @@
 *****************************************************************************/
 
 #include "ml_decision_engine.hpp"
+#include "hot_path_trace.hpp"
 #include <chrono>
 #include <algorithm>
 #include <numeric>
@@ -30,6 +31,7 @@ MLDecisionEngine::MLDecisionEngine()
     norm_params_.elevation_std = 5000;
     norm_params_.complexity_mean = 5.0;
     norm_params_.complexity_std = 2.5;
+    default_norm_params_ = norm_params_;
 }
 
 MLDecisionEngine::~MLDecisionEngine() {
@@ -44,25 +46,39 @@ bool MLDecisionEngine::initialize() {
     perf_stats_.all_latencies.clear();
     decision_history_.clear();
     decision_latencies_.clear();
+    history_stats_.fill(RunningStat());
+    resetStreaming();
     return true;
 }
 
 DecisionScore MLDecisionEngine::scoreDecision(const EnvironmentalInput& input) {
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    DecisionScore score;
-    score.factors.clear();
-    
     // Calculate component scores
     double weather_score = calculateWeatherScore(input);
     double runway_score = calculateRunwayScore(input);
     double terrain_score = calculateTerrainScore(input);
     double navigation_score = calculateNavigationScore(input);
     
-    score.factors.push_back(weather_score);
-    score.factors.push_back(runway_score);
-    score.factors.push_back(terrain_score);
-    score.factors.push_back(navigation_score);
+    DecisionScore score = combineScores(weather_score, runway_score, terrain_score, navigation_score);
+    
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+        end_time - start_time).count();
+    
+    perf_stats_.total_decisions++;
+    perf_stats_.total_score_sum += score.score;
+    perf_stats_.latency_sum += latency;
+    perf_stats_.all_latencies.push_back(latency);
+    decision_latencies_.push_back(latency);
+    
+    return score;
+}
+
+DecisionScore MLDecisionEngine::combineScores(double weather_score, double runway_score,
+                                              double terrain_score, double navigation_score) const {
+    DecisionScore score;
+    score.factors = {weather_score, runway_score, terrain_score, navigation_score};
     
     // Weighted combination (weights sum to 1.0)
     double combined_score = 
@@ -89,38 +105,28 @@ DecisionScore MLDecisionEngine::scoreDecision(const EnvironmentalInput& input) {
         score.action = "DO_NOT_PROCEED";
     }
     
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
-        end_time - start_time).count();
-    
-    perf_stats_.total_decisions++;
-    perf_stats_.total_score_sum += score.score;
-    perf_stats_.latency_sum += latency;
-    perf_stats_.all_latencies.push_back(latency);
-    decision_latencies_.push_back(latency);
-    
     return score;
 }
 
 std::vector<DecisionScore> MLDecisionEngine::scoreMultipleDecisions(
     const EnvironmentalInput& input,
     int num_decisions) {
-    std::vector<DecisionScore> scores;
+    std::vector<WeatherVariant> candidates;
+    candidates.reserve(std::max(0, num_decisions));
     
-    // Score each decision variation
+    // Apply slight variations to explore decision space
     for (int i = 0; i < num_decisions; ++i) {
-        EnvironmentalInput modified_input = input;
-        
-        // Apply slight variations to explore decision space
+        WeatherVariant variant = {input.wind_speed, input.visibility, input.pressure};
         if (i > 0) {
             double variation = (i - num_decisions / 2.0) * 0.1;
-            modified_input.wind_speed *= (1.0 + variation);
-            modified_input.visibility *= (1.0 - variation * 0.5);
+            variant.wind_speed *= (1.0 + variation);
+            variant.visibility *= (1.0 - variation * 0.5);
         }
-        
-        scores.push_back(scoreDecision(modified_input));
+        candidates.push_back(variant);
     }
     
+    std::vector<DecisionScore> scores = scoreDecisions(input, candidates);
+    
     // Sort by score descending
     std::sort(scores.begin(), scores.end(),
         [](const DecisionScore& a, const DecisionScore& b) {
@@ -130,8 +136,70 @@ std::vector<DecisionScore> MLDecisionEngine::scoreMultipleDecisions(
     return scores;
 }
 
+template <typename Scores>
+void MLDecisionEngine::scoreBatch(const EnvironmentalInput& input,
+                                  const std::vector<WeatherVariant>& candidates, Scores& scores) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    
+    scores.resize(candidates.size());
+    scoreBlock(input, candidates.data(), candidates.size(), calculateRunwayScore(input),
+               calculateTerrainScore(input), calculateNavigationScore(input), scores.data());
+    
+    auto end_time = std::chrono::high_resolution_clock::now();
+    recordBatchLatency(std::chrono::duration<double, std::milli>(end_time - start_time).count(),
+                       scores.data(), scores.size());
+}
+
+std::vector<DecisionScore> MLDecisionEngine::scoreDecisions(
+    const EnvironmentalInput& input,
+    const std::vector<WeatherVariant>& candidates) {
+    TRACE_SCOPE("ml.score_decisions");
+    std::vector<DecisionScore> scores;
+    scoreBatch(input, candidates, scores);
+    return scores;
+}
+
+std::pmr::vector<DecisionScore> MLDecisionEngine::scoreDecisions(
+    const EnvironmentalInput& input,
+    const std::vector<WeatherVariant>& candidates,
+    std::pmr::memory_resource* resource) {
+    TRACE_SCOPE("ml.score_decisions");
+    std::pmr::vector<DecisionScore> scores(resource);
+    scoreBatch(input, candidates, scores);
+    return scores;
+}
+
+void MLDecisionEngine::scoreBlock(const EnvironmentalInput& input, const WeatherVariant* candidates,
+                                  size_t count, double runway_score, double terrain_score,
+                                  double navigation_score, DecisionScore* scores) const {
+    // Only the weather term differs between candidates
+    EnvironmentalInput weather = input;
+    for (size_t i = 0; i < count; ++i) {
+        weather.wind_speed = candidates[i].wind_speed;
+        weather.visibility = candidates[i].visibility;
+        weather.pressure = candidates[i].pressure;
+        double weather_score = calculateWeatherScore(weather);
+        scores[i] = combineScores(weather_score, runway_score, terrain_score, navigation_score);
+    }
+}
+
+void MLDecisionEngine::recordBatchLatency(double latency_ms, const DecisionScore* scores, size_t count) {
+    const size_t decisions = count;
+    if (decisions == 0) return;
+    
+    // One latency per decision, each the batch's share
+    double per_decision = latency_ms / decisions;
+    perf_stats_.total_decisions += static_cast<int>(decisions);
+    for (size_t i = 0; i < count; ++i) {
+        perf_stats_.total_score_sum += scores[i].score;
+    }
+    perf_stats_.latency_sum += latency_ms;
+    perf_stats_.all_latencies.insert(perf_stats_.all_latencies.end(), decisions, per_decision);
+    decision_latencies_.insert(decision_latencies_.end(), decisions, per_decision);
+}
+
 std::string MLDecisionEngine::getRecommendedAction(const EnvironmentalInput& input) {
-    return scoreDecision(input).action;
+    return std::string(scoreDecision(input).action);
 }
 
 double MLDecisionEngine::getConfidenceLevel(const EnvironmentalInput& input) {
@@ -157,6 +225,36 @@ DecisionScore MLDecisionEngine::scoreWithLatencyBound(
     return result;
 }
 
+std::vector<DecisionScore> MLDecisionEngine::scoreWithLatencyBound(
+    const EnvironmentalInput& input,
+    const std::vector<WeatherVariant>& candidates,
+    int max_latency_ms) {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    auto deadline = start_time + std::chrono::milliseconds(max_latency_ms);
+    
+    double runway_score = calculateRunwayScore(input);
+    double terrain_score = calculateTerrainScore(input);
+    double navigation_score = calculateNavigationScore(input);
+    
+    std::vector<DecisionScore> scores(candidates.size());
+    size_t scored = 0;
+    for (size_t first = 0; first < candidates.size(); first += SCORE_BLOCK_SIZE) {
+        if (first > 0 && std::chrono::high_resolution_clock::now() >= deadline) {
+            break;
+        }
+        size_t count = std::min(SCORE_BLOCK_SIZE, candidates.size() - first);
+        scoreBlock(input, candidates.data() + first, count, runway_score, terrain_score,
+                   navigation_score, scores.data() + first);
+        scored = first + count;
+    }
+    scores.resize(scored);
+    
+    auto end_time = std::chrono::high_resolution_clock::now();
+    recordBatchLatency(std::chrono::duration<double, std::milli>(end_time - start_time).count(),
+                       scores.data(), scores.size());
+    return scores;
+}
+
 std::vector<DecisionHistoryEntry> MLDecisionEngine::analyzeDecisionHistory(
     int lookback_seconds) {
     std::vector<DecisionHistoryEntry> filtered_history;
@@ -197,7 +295,8 @@ AnomalyDetectionResult MLDecisionEngine::detectAnomalies(
     result.anomaly_score = 0.0;
     result.anomaly_type = "NONE";
     
-    std::vector<double> features = extractFeatureVector(input);
+    AnomalyFeatureVector features;
+    extractFeatureVector(input, features);
     
     if (decision_history_.empty()) {
         return result;
@@ -247,6 +346,7 @@ void MLDecisionEngine::recordDecision(
     entry.outcome_score = outcome_score;
     
     decision_history_.push_back(entry);
+    addToHistoryStats(input, true);
     
     if (outcome_success) {
         perf_stats_.success_count++;
@@ -256,6 +356,9 @@ void MLDecisionEngine::recordDecision(
 }
 
 void MLDecisionEngine::enableStreamingMode(bool enable) {
+    if (enable && !streaming_mode_) {
+        resetStreaming();
+    }
     streaming_mode_ = enable;
 }
 
@@ -267,6 +370,98 @@ void MLDecisionEngine::setSensitivity(double sensitivity) {
     sensitivity_ = std::max(0.5, std::min(2.0, sensitivity));
 }
 
+void MLDecisionEngine::updateWeather(double pressure, double wind_speed, double wind_direction,
+                                     double visibility, double temperature) {
+    if (!streaming_mode_) return;
+    stream_input_.pressure = pressure;
+    stream_input_.wind_speed = wind_speed;
+    stream_input_.wind_direction = wind_direction;
+    stream_input_.visibility = visibility;
+    stream_input_.temperature = temperature;
+    stream_dirty_ |= WEATHER_TERM;
+}
+
+void MLDecisionEngine::updateRunway(double runway_length, double runway_width, int runway_condition,
+                                    bool ils_available, bool lighting_available) {
+    if (!streaming_mode_) return;
+    stream_input_.runway_length = runway_length;
+    stream_input_.runway_width = runway_width;
+    stream_input_.runway_condition = runway_condition;
+    stream_input_.ils_available = ils_available;
+    stream_input_.lighting_available = lighting_available;
+    stream_dirty_ |= RUNWAY_TERM;
+}
+
+void MLDecisionEngine::updateTerrain(double elevation, double slope, bool water_nearby, bool obstacles) {
+    if (!streaming_mode_) return;
+    stream_input_.elevation = elevation;
+    stream_input_.slope = slope;
+    stream_input_.water_nearby = water_nearby;
+    stream_input_.obstacles = obstacles;
+    stream_dirty_ |= TERRAIN_TERM;
+}
+
+void MLDecisionEngine::updateRoute(double route_complexity, double airway_density) {
+    if (!streaming_mode_) return;
+    stream_input_.route_complexity = route_complexity;
+    stream_input_.airway_density = airway_density;
+    stream_dirty_ |= NAVIGATION_TERM;
+}
+
+DecisionScore MLDecisionEngine::scoreStreaming() {
+    auto start_time = std::chrono::high_resolution_clock::now();
+    
+    // Only the terms whose inputs changed since the last score
+    if (stream_dirty_ & WEATHER_TERM) stream_terms_[0] = calculateWeatherScore(stream_input_);
+    if (stream_dirty_ & RUNWAY_TERM) stream_terms_[1] = calculateRunwayScore(stream_input_);
+    if (stream_dirty_ & TERRAIN_TERM) stream_terms_[2] = calculateTerrainScore(stream_input_);
+    if (stream_dirty_ & NAVIGATION_TERM) stream_terms_[3] = calculateNavigationScore(stream_input_);
+    stream_dirty_ = 0;
+    
+    DecisionScore score = combineScores(stream_terms_[0], stream_terms_[1], stream_terms_[2], stream_terms_[3]);
+    
+    // Rolling normalization over the scored samples
+    if (streaming_mode_) {
+        stream_norm_.pressure.add(stream_input_.pressure);
+        stream_norm_.wind_speed.add(stream_input_.wind_speed);
+        stream_norm_.visibility.add(stream_input_.visibility);
+        stream_norm_.elevation.add(stream_input_.elevation);
+        stream_norm_.complexity.add(stream_input_.route_complexity);
+        if (stream_norm_.pressure.count >= 2) {
+            norm_params_.pressure_mean = stream_norm_.pressure.mean;
+            norm_params_.pressure_std = std::sqrt(stream_norm_.pressure.variance());
+            norm_params_.wind_speed_mean = stream_norm_.wind_speed.mean;
+            norm_params_.wind_speed_std = std::sqrt(stream_norm_.wind_speed.variance());
+            norm_params_.visibility_mean = stream_norm_.visibility.mean;
+            norm_params_.visibility_std = std::sqrt(stream_norm_.visibility.variance());
+            norm_params_.elevation_mean = stream_norm_.elevation.mean;
+            norm_params_.elevation_std = std::sqrt(stream_norm_.elevation.variance());
+            norm_params_.complexity_mean = stream_norm_.complexity.mean;
+            norm_params_.complexity_std = std::sqrt(stream_norm_.complexity.variance());
+        }
+    }
+    
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+        end_time - start_time).count();
+    
+    perf_stats_.total_decisions++;
+    perf_stats_.total_score_sum += score.score;
+    perf_stats_.latency_sum += latency;
+    perf_stats_.all_latencies.push_back(latency);
+    decision_latencies_.push_back(latency);
+    
+    return score;
+}
+
+void MLDecisionEngine::resetStreaming() {
+    stream_input_ = EnvironmentalInput();
+    stream_terms_.fill(0.0);
+    stream_dirty_ = ALL_TERMS;
+    stream_norm_ = StreamNormalization();
+    norm_params_ = default_norm_params_;
+}
+
 double MLDecisionEngine::getSensitivity() const {
     return sensitivity_;
 }
@@ -290,13 +485,14 @@ double MLDecisionEngine::getMinDecisionLatencyMs() const {
 void MLDecisionEngine::clearHistory() {
     decision_history_.clear();
     decision_latencies_.clear();
+    history_stats_.fill(RunningStat());
 }
 
 size_t MLDecisionEngine::getHistorySize() const {
     return decision_history_.size();
 }
 
-double MLDecisionEngine::calculateWeatherScore(const EnvironmentalInput& input) {
+double MLDecisionEngine::calculateWeatherScore(const EnvironmentalInput& input) const {
     double wind_score = 1.0 - std::min(1.0, (input.wind_speed / 40.0));
     double visibility_score = 1.0 - std::min(1.0, (10000.0 - input.visibility) / 10000.0);
     double pressure_score = 1.0 - std::min(1.0, std::abs(input.pressure - 1013.25) / 50.0);
@@ -304,7 +500,7 @@ double MLDecisionEngine::calculateWeatherScore(const EnvironmentalInput& input)
     return (wind_score * 0.4 + visibility_score * 0.4 + pressure_score * 0.2);
 }
 
-double MLDecisionEngine::calculateRunwayScore(const EnvironmentalInput& input) {
+double MLDecisionEngine::calculateRunwayScore(const EnvironmentalInput& input) const {
     double length_score = std::min(1.0, input.runway_length / 5000.0);
     double condition_score = 1.0 - (input.runway_condition / 5.0);
     double ils_score = input.ils_available ? 1.0 : 0.7;
@@ -312,7 +508,7 @@ double MLDecisionEngine::calculateRunwayScore(const EnvironmentalInput& input) {
     return (length_score * 0.4 + condition_score * 0.35 + ils_score * 0.25);
 }
 
-double MLDecisionEngine::calculateTerrainScore(const EnvironmentalInput& input) {
+double MLDecisionEngine::calculateTerrainScore(const EnvironmentalInput& input) const {
     double elevation_factor = 1.0 - std::min(1.0, input.elevation / 10000.0);
     double slope_factor = 1.0 - std::min(1.0, std::abs(input.slope) / 5.0);
     double obstacle_factor = input.obstacles ? 0.5 : 1.0;
@@ -320,7 +516,7 @@ double MLDecisionEngine::calculateTerrainScore(const EnvironmentalInput& input)
     return (elevation_factor * 0.4 + slope_factor * 0.35 + obstacle_factor * 0.25);
 }
 
-double MLDecisionEngine::calculateNavigationScore(const EnvironmentalInput& input) {
+double MLDecisionEngine::calculateNavigationScore(const EnvironmentalInput& input) const {
     double complexity_score = 1.0 - std::min(1.0, input.route_complexity / 10.0);
     double density_score = std::min(1.0, input.airway_density / 5.0);
     
@@ -336,49 +532,49 @@ double MLDecisionEngine::applySigmoid(double x) {
     return 1.0 / (1.0 + std::exp(-x));
 }
 
-std::vector<double> MLDecisionEngine::extractFeatureVector(const EnvironmentalInput& input) {
-    std::vector<double> features;
-    features.push_back(normalizeValue(input.pressure, 950, 1050));
-    features.push_back(normalizeValue(input.wind_speed, 0, 40));
-    features.push_back(normalizeValue(input.visibility, 0, 10000));
-    features.push_back(normalizeValue(input.temperature, -50, 50));
-    features.push_back(normalizeValue(input.runway_length, 2000, 12000));
-    features.push_back(normalizeValue(input.elevation, 0, 14000));
-    features.push_back(normalizeValue(input.route_complexity, 0, 10));
-    features.push_back(normalizeValue(input.airway_density, 0, 10));
-    return features;
+void MLDecisionEngine::extractFeatureVector(const EnvironmentalInput& input,
+                                            AnomalyFeatureVector& features) {
+    features[PRESSURE_FEATURE] = normalizeValue(input.pressure, 950, 1050);
+    features[WIND_SPEED_FEATURE] = normalizeValue(input.wind_speed, 0, 40);
+    features[VISIBILITY_FEATURE] = normalizeValue(input.visibility, 0, 10000);
+    features[TEMPERATURE_FEATURE] = normalizeValue(input.temperature, -50, 50);
+    features[RUNWAY_LENGTH_FEATURE] = normalizeValue(input.runway_length, 2000, 12000);
+    features[ELEVATION_FEATURE] = normalizeValue(input.elevation, 0, 14000);
+    features[ROUTE_COMPLEXITY_FEATURE] = normalizeValue(input.route_complexity, 0, 10);
+    features[AIRWAY_DENSITY_FEATURE] = normalizeValue(input.airway_density, 0, 10);
 }
 
-double MLDecisionEngine::calculateZScore(const std::vector<double>& feature, int feature_idx) {
-    if (decision_history_.empty() || feature_idx >= static_cast<int>(feature.size())) {
+double MLDecisionEngine::calculateZScore(const AnomalyFeatureVector& feature, int feature_idx) {
+    if (decision_history_.size() < 2 || feature_idx < 0 || feature_idx >= static_cast<int>(feature.size())) {
         return 0;
     }
     
-    std::vector<double> historical_values;
-    for (const auto& entry : decision_history_) {
-        auto hist_features = extractFeatureVector(entry.input);
-        if (feature_idx < static_cast<int>(hist_features.size())) {
-            historical_values.push_back(hist_features[feature_idx]);
-        }
-    }
-    
-    if (historical_values.size() < 2) return 0;
+    const RunningStat& stats = history_stats_[feature_idx];
+    double std_dev = std::sqrt(stats.variance());
     
-    double mean = std::accumulate(historical_values.begin(), 
-                                  historical_values.end(), 0.0) / historical_values.size();
-    double variance = 0;
-    for (double val : historical_values) {
-        variance += (val - mean) * (val - mean);
+    // Removals leave rounding residue where the history is constant
+    if (std_dev <= 1e-9 * std::max(1.0, std::abs(stats.mean))) return 0;
+    return (feature[feature_idx] - stats.mean) / std_dev;
+}
+
+void MLDecisionEngine::addToHistoryStats(const EnvironmentalInput& input, bool add) {
+    AnomalyFeatureVector features;
+    extractFeatureVector(input, features);
+    for (size_t i = 0; i < features.size(); ++i) {
+        if (add) {
+            history_stats_[i].add(features[i]);
+        } else {
+            history_stats_[i].remove(features[i]);
+        }
     }
-    variance /= historical_values.size();
-    double std_dev = std::sqrt(variance);
-    
-    if (std_dev == 0) return 0;
-    return (feature[feature_idx] - mean) / std_dev;
 }
 
 void MLDecisionEngine::maintainHistorySize() {
     if (decision_history_.size() > max_history_size_) {
+        size_t dropped = decision_history_.size() - max_history_size_;
+        for (size_t i = 0; i < dropped; ++i) {
+            addToHistoryStats(decision_history_[i].input, false);
+        }
         decision_history_.erase(
             decision_history_.begin(),
             decision_history_.begin() + (decision_history_.size() - max_history_size_));
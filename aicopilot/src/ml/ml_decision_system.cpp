@@ -13,25 +13,145 @@
 
 namespace AICopilot {
 
+namespace {
+
+// Contexts count as similar above this similarity...
+constexpr double SIMILAR_THRESHOLD = 0.7;
+// ...which takes the same phase and a feature distance below ln(7/4):
+// 0.7 * exp(-d) + 0.3 > 0.7
+constexpr double SIMILAR_RADIUS = 0.5596157879354227;
+
+// A trained choice votes for the option whose text matches at least this well
+constexpr double TEXT_MATCH_THRESHOLD = 0.5;
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t hashText(std::string_view text) {
+    uint64_t hash = FNV_OFFSET;
+    for (char c : text) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+    }
+    return hash;
+}
+
+bool isWordChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+}
+
+char foldCase(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+} // namespace
+
+double TextFeatureVector::dot(const TextFeatureVector& other) const {
+    // Merge over the ascending buckets
+    double sum = 0.0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+    while (i < count && j < other.count) {
+        if (bucket[i] < other.bucket[j]) {
+            ++i;
+        } else if (bucket[i] > other.bucket[j]) {
+            ++j;
+        } else {
+            sum += static_cast<double>(weight[i++]) * other.weight[j++];
+        }
+    }
+    return sum;
+}
+
+void hashTextFeatures(std::string_view text, TextFeatureVector& features) {
+    features.count = 0;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        while (pos < text.size() && !isWordChar(text[pos])) ++pos;
+        if (pos == text.size()) break;
+        uint32_t hash = 2166136261u;    // FNV-1a 32 of the folded word
+        while (pos < text.size() && isWordChar(text[pos])) {
+            hash = (hash ^ static_cast<uint8_t>(foldCase(text[pos++]))) * 16777619u;
+        }
+        uint16_t bucket = static_cast<uint16_t>(hash % TextFeatureVector::BUCKETS);
+        
+        // Insertion into the sorted bucket list; repeats add to their count
+        uint32_t at = 0;
+        while (at < features.count && features.bucket[at] < bucket) ++at;
+        if (at < features.count && features.bucket[at] == bucket) {
+            features.weight[at] += 1.0f;
+            continue;
+        }
+        if (features.count == TextFeatureVector::MAX_TERMS) continue;
+        for (uint32_t k = features.count; k > at; --k) {
+            features.bucket[k] = features.bucket[k - 1];
+            features.weight[k] = features.weight[k - 1];
+        }
+        features.bucket[at] = bucket;
+        features.weight[at] = 1.0f;
+        features.count++;
+    }
+    
+    double norm = 0.0;
+    for (uint32_t i = 0; i < features.count; ++i) {
+        norm += static_cast<double>(features.weight[i]) * features.weight[i];
+    }
+    if (norm > 0.0) {
+        float scale = static_cast<float>(1.0 / std::sqrt(norm));
+        for (uint32_t i = 0; i < features.count; ++i) features.weight[i] *= scale;
+    }
+}
+
 bool MLDecisionSystem::initialize() {
     enabled_ = true;
     return true;
 }
 
 bool MLDecisionSystem::loadModel(const std::string& modelPath) {
-    // Enhanced model loading - in a full implementation would load neural network weights
-    std::cout << "ML Decision System: Loading model from " << modelPath << std::endl;
-    // For now, using built-in heuristics
-    // Future: Load TensorFlow Lite, ONNX, or custom model format
+    ModelPack pack;
+    if (!pack.open(modelPath)) {
+        std::cerr << "ML Decision System: Cannot load model " << modelPath << std::endl;
+        return false;
+    }
+    return loadModel(pack);
+}
+
+bool MLDecisionSystem::loadModel(const ModelPack& pack) {
+    if (!pack.isOpen()) return false;
+    
+    clearTrainingData();
+    size_t count = std::min(pack.getExampleCount(), trainingLimit_);
+    trainingData_.reserve(count);
+    trainingFeatures_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const ModelPackExample& example = pack.getExample(i);
+        TrainingData data;
+        data.context.phase = static_cast<FlightPhase>(example.phase);
+        data.correctOption = example.correctOption;
+        data.reward = example.reward;
+        
+        DecisionFeatureVector features;
+        std::copy(pack.getExampleFeatures(i), pack.getExampleFeatures(i) + features.size(), features.begin());
+        trainingIndex_.insert(static_cast<uint32_t>(i), features);
+        trainingData_.push_back(std::move(data));
+        trainingFeatures_.push_back(features);
+        trainingChoices_.emplace_back();
+    }
+    feedbackCount_ = pack.getExampleCount();
     return true;
 }
 
 bool MLDecisionSystem::saveModel(const std::string& modelPath) const {
-    // Enhanced model saving - would serialize learned weights and parameters
-    std::cout << "ML Decision System: Saving model to " << modelPath << std::endl;
-    // For now, nothing to save (using heuristics)
-    // Future: Save trained model parameters
-    return true;
+    ModelPackBuilder builder;
+    saveModel(builder);
+    return builder.write(modelPath);
+}
+
+void MLDecisionSystem::saveModel(ModelPackBuilder& builder) const {
+    for (size_t i = 0; i < trainingData_.size(); ++i) {
+        const TrainingData& data = trainingData_[i];
+        builder.addExample(trainingFeatures_[i].data(),
+                           {static_cast<int32_t>(data.context.phase), data.correctOption, data.reward});
+    }
 }
 
 DecisionResult MLDecisionSystem::makeATCDecision(const DecisionContext& context) {
@@ -69,8 +189,51 @@ MLDecisionSystem::ApproachDecision MLDecisionSystem::optimizeApproach(
 }
 
 void MLDecisionSystem::trainWithFeedback(const TrainingData& data) {
-    if (!enabled_) return;
-    trainingData_.push_back(data);
+    if (!enabled_ || trainingLimit_ == 0) return;
+    feedbackCount_++;
+    
+    // Reservoir sampling: the n-th example replaces a random one with probability limit/n
+    size_t slot = trainingData_.size();
+    if (slot >= trainingLimit_) {
+        uint64_t draw = nextReservoirDraw() % feedbackCount_;
+        if (draw >= trainingLimit_) return;
+        slot = static_cast<size_t>(draw);
+    }
+    
+    DecisionFeatureVector features;
+    extractFeatures(data.context, features);
+    TextFeatureVector choice;
+    if (data.correctOption >= 0 && static_cast<size_t>(data.correctOption) < data.context.atcOptions.size()) {
+        extractTextFeatures(data.context.atcOptions[data.correctOption], choice);
+    }
+    if (slot == trainingData_.size()) {
+        trainingData_.push_back(data);
+        trainingFeatures_.push_back(features);
+        trainingChoices_.push_back(choice);
+    } else {
+        trainingData_[slot] = data;
+        trainingFeatures_[slot] = features;
+        trainingChoices_[slot] = choice;
+    }
+    trainingIndex_.insert(static_cast<uint32_t>(slot), features);
+}
+
+void MLDecisionSystem::setTrainingDataLimit(size_t limit) {
+    trainingLimit_ = limit;
+    while (trainingData_.size() > limit) {
+        trainingIndex_.erase(static_cast<uint32_t>(trainingData_.size() - 1));
+        trainingData_.pop_back();
+        trainingFeatures_.pop_back();
+        trainingChoices_.pop_back();
+    }
+}
+
+uint64_t MLDecisionSystem::nextReservoirDraw() {
+    // splitmix64
+    uint64_t z = (reservoirState_ += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
 }
 
 int MLDecisionSystem::predictBestOption(
@@ -82,23 +245,16 @@ int MLDecisionSystem::predictBestOption(
         return 0;
     }
     
-    // Find similar contexts
-    auto similar = findSimilarContexts(context);
+    // Use most common option from similar contexts
+    std::vector<int> votes(context.atcOptions.size(), 0);
+    size_t similar = voteSimilarContexts(context, votes);
     
-    if (similar.empty()) {
+    if (similar == 0) {
         // No training data, use first option
         confidence = 0.5;
         return 0;
     }
     
-    // Use most common option from similar contexts
-    std::vector<int> votes(context.atcOptions.size(), 0);
-    for (const auto& data : similar) {
-        if (data.correctOption < votes.size()) {
-            votes[data.correctOption]++;
-        }
-    }
-    
     int bestOption = 0;
     int maxVotes = 0;
     for (size_t i = 0; i < votes.size(); ++i) {
@@ -108,25 +264,103 @@ int MLDecisionSystem::predictBestOption(
         }
     }
     
-    confidence = static_cast<double>(maxVotes) / similar.size();
+    confidence = static_cast<double>(maxVotes) / similar;
     return bestOption;
 }
 
-std::vector<double> MLDecisionSystem::extractFeatures(const DecisionContext& context) const {
-    std::vector<double> features;
-    
-    // Add phase features
-    auto phaseFeatures = extractPhaseFeatures(context.phase);
-    features.insert(features.end(), phaseFeatures.begin(), phaseFeatures.end());
+double MLDecisionSystem::getConfidence(const DecisionContext& context, int option) const {
+    if (option < 0 || static_cast<size_t>(option) >= context.atcOptions.size()) {
+        return 0.0;
+    }
     
-    // Add state features
-    auto stateFeatures = extractStateFeatures(context.state);
-    features.insert(features.end(), stateFeatures.begin(), stateFeatures.end());
+    std::vector<int> votes(context.atcOptions.size(), 0);
+    size_t similar = voteSimilarContexts(context, votes);
+    if (similar == 0) {
+        return 0.5;  // Nothing to go on, as in predictBestOption()
+    }
+    return static_cast<double>(votes[option]) / similar;
+}
+
+void MLDecisionSystem::clearTrainingData() {
+    trainingData_.clear();
+    trainingFeatures_.clear();
+    trainingChoices_.clear();
+    trainingIndex_.clear();
+    feedbackCount_ = 0;
+}
+
+size_t MLDecisionSystem::voteSimilarContexts(const DecisionContext& context,
+                                             std::vector<int>& votes) const {
+    DecisionFeatureVector features;
+    extractFeatures(context, features);
+    
+    thread_local std::vector<TextFeatureVector> options;
+    options.resize(context.atcOptions.size());
+    for (size_t i = 0; i < options.size(); ++i) {
+        extractTextFeatures(context.atcOptions[i], options[i]);
+    }
     
-    return features;
+    // Only examples within SIMILAR_RADIUS can pass the threshold
+    size_t similar = 0;
+    trainingIndex_.forEachWithin(features, SIMILAR_RADIUS, [&](uint32_t slot, double distance) {
+        const TrainingData& data = trainingData_[slot];
+        if (similarityFromDistance(distance, data.context.phase == context.phase) <= SIMILAR_THRESHOLD) {
+            return;
+        }
+        similar++;
+        
+        // The option reading like the one chosen, else the same position
+        int option = data.correctOption;
+        const TextFeatureVector& choice = trainingChoices_[slot];
+        if (choice.count > 0) {
+            double best = option >= 0 && static_cast<size_t>(option) < options.size()
+                              ? options[option].dot(choice) : 0.0;
+            if (best < TEXT_MATCH_THRESHOLD) {
+                for (size_t i = 0; i < options.size(); ++i) {
+                    double match = options[i].dot(choice);
+                    if (match > best && match >= TEXT_MATCH_THRESHOLD) {
+                        best = match;
+                        option = static_cast<int>(i);
+                    }
+                }
+            }
+        }
+        if (option >= 0 && static_cast<size_t>(option) < votes.size()) {
+            votes[option]++;
+        }
+    });
+    return similar;
 }
 
-std::vector<double> MLDecisionSystem::extractPhaseFeatures(FlightPhase phase) const {
+std::vector<double> MLDecisionSystem::extractFeatures(const DecisionContext& context) const {
+    DecisionFeatureVector features;
+    extractFeatures(context, features);
+    return std::vector<double>(features.begin(), features.end());
+}
+
+void MLDecisionSystem::extractFeatures(const DecisionContext& context,
+                                       DecisionFeatureVector& features) const {
+    extractPhaseFeatures(context.phase, features.data() + DecisionFeatureLayout::PHASE);
+    extractStateFeatures(context.state, features.data() + DecisionFeatureLayout::STATE);
+}
+
+void MLDecisionSystem::extractTextFeatures(std::string_view text, TextFeatureVector& features) const {
+    uint64_t hash = hashText(text);
+    TextCacheEntry& entry = textCache_[hash % TEXT_CACHE_SIZE];
+    if (entry.valid && entry.hash == hash && entry.length == text.size()) {
+        textCacheHits_++;
+        features = entry.features;
+        return;
+    }
+    textCacheMisses_++;
+    hashTextFeatures(text, features);
+    entry.hash = hash;
+    entry.length = text.size();
+    entry.valid = true;
+    entry.features = features;
+}
+
+void MLDecisionSystem::extractPhaseFeatures(FlightPhase phase, double* features) const {
     /**
      * Enhanced one-hot encoding with neighbor phases
      * 
@@ -147,12 +381,13 @@ std::vector<double> MLDecisionSystem::extractPhaseFeatures(FlightPhase phase) co
      * - Helps ML model understand phase transitions
      * - Reduces phase boundary artifacts
      */
-    std::vector<double> features(10, 0.0);
+    const int count = static_cast<int>(DecisionFeatureLayout::PHASE_COUNT);
+    std::fill(features, features + count, 0.0);
     int phaseIndex = static_cast<int>(phase);
     
     // Ensure index is within bounds
-    if (phaseIndex < 0 || phaseIndex >= static_cast<int>(features.size())) {
-        return features;  // Invalid phase, return zero vector
+    if (phaseIndex < 0 || phaseIndex >= count) {
+        return;  // Invalid phase, zero block
     }
     
     // Set primary phase to 1.0
@@ -163,14 +398,12 @@ std::vector<double> MLDecisionSystem::extractPhaseFeatures(FlightPhase phase) co
     if (phaseIndex > 0) {
         features[phaseIndex - 1] += 0.5;
     }
-    if (phaseIndex < static_cast<int>(features.size()) - 1) {
+    if (phaseIndex < count - 1) {
         features[phaseIndex + 1] += 0.5;
     }
-    
-    return features;
 }
 
-std::vector<double> MLDecisionSystem::extractStateFeatures(const AircraftState& state) const {
+void MLDecisionSystem::extractStateFeatures(const AircraftState& state, double* features) const {
     /**
      * Enhanced state feature extraction for ML models
      * 
@@ -201,68 +434,48 @@ std::vector<double> MLDecisionSystem::extractStateFeatures(const AircraftState&
      * - Vertical Speed: -5000 to +5000 fpm (typical aircraft)
      * - Bank/Pitch: -90 to +90 degrees
      */
-    std::vector<double> features;
-    features.reserve(10);  // Reserve capacity for 10 features
-    
     // Feature 1: Altitude normalization (0-50,000 feet max)
     double altitudeNorm = std::max(0.0, std::min(1.0, state.position.altitude / 50000.0));
-    features.push_back(altitudeNorm);
+    features[0] = altitudeNorm;
     
     // Feature 2: Indicated Airspeed normalization (0-400 knots max)
     double iasNorm = std::max(0.0, std::min(1.0, state.indicatedAirspeed / 400.0));
-    features.push_back(iasNorm);
+    features[1] = iasNorm;
     
     // Feature 3: Ground Speed normalization (0-500 knots max)
     double gsNorm = std::max(0.0, std::min(1.0, state.groundSpeed / 500.0));
-    features.push_back(gsNorm);
+    features[2] = gsNorm;
     
     // Feature 4: Vertical Speed normalization (range: -5000 to +5000 fpm)
     // Normalized to [0, 1] where 0.5 = 0 fpm
     double vsNorm = std::max(0.0, std::min(1.0, (state.verticalSpeed + 5000.0) / 10000.0));
-    features.push_back(vsNorm);
+    features[3] = vsNorm;
     
     // Feature 5: Bank Angle normalization (range: -90 to +90 degrees)
     // Normalized to [0, 1] where 0.5 = 0° (level wings)
     double bankNorm = std::max(0.0, std::min(1.0, (state.bank + 90.0) / 180.0));
-    features.push_back(bankNorm);
+    features[4] = bankNorm;
     
     // Feature 6: Pitch Angle normalization (range: -90 to +90 degrees)
     // Normalized to [0, 1] where 0.5 = 0° (level flight)
     double pitchNorm = std::max(0.0, std::min(1.0, (state.pitch + 90.0) / 180.0));
-    features.push_back(pitchNorm);
+    features[5] = pitchNorm;
     
     // Features 7-8: Heading components (sin and cos for circular continuity)
     // Convert heading from degrees to radians for trig functions
     double headingRad = state.heading * M_PI / 180.0;
     double headingSin = std::sin(headingRad);  // Range: [-1, 1]
     double headingCos = std::cos(headingRad);  // Range: [-1, 1]
-    features.push_back(headingSin);
-    features.push_back(headingCos);
+    features[6] = headingSin;
+    features[7] = headingCos;
     
     // Feature 9: Flaps Position normalization (0-100%)
     double flapsNorm = std::max(0.0, std::min(1.0, static_cast<double>(state.flapsPosition) / 100.0));
-    features.push_back(flapsNorm);
+    features[8] = flapsNorm;
     
     // Feature 10: On Ground flag (binary: 0 or 1)
     double onGroundFlag = state.onGround ? 1.0 : 0.0;
-    features.push_back(onGroundFlag);
-    
-    return features;
-}
-
-std::vector<TrainingData> MLDecisionSystem::findSimilarContexts(
-    const DecisionContext& context) const {
-    
-    std::vector<TrainingData> similar;
-    
-    for (const auto& data : trainingData_) {
-        double similarity = calculateSimilarity(context, data.context);
-        if (similarity > 0.7) {
-            similar.push_back(data);
-        }
-    }
-    
-    return similar;
+    features[9] = onGroundFlag;
 }
 
 double MLDecisionSystem::calculateSimilarity(
@@ -296,23 +509,22 @@ double MLDecisionSystem::calculateSimilarity(
      */
     
     // Extract feature vectors from both contexts
-    auto features1 = extractFeatures(c1);
-    auto features2 = extractFeatures(c2);
-    
-    // Verify feature vectors have the same size
-    if (features1.size() != features2.size()) {
-        // Fallback to phase comparison if feature extraction differs
-        return (c1.phase == c2.phase) ? 0.5 : 0.0;
-    }
+    DecisionFeatureVector features1;
+    DecisionFeatureVector features2;
+    extractFeatures(c1, features1);
+    extractFeatures(c2, features2);
+    return calculateSimilarity(features1, c1.phase, features2, c2.phase);
+}
+
+double MLDecisionSystem::calculateSimilarity(
+    const DecisionFeatureVector& features1, FlightPhase phase1,
+    const DecisionFeatureVector& features2, FlightPhase phase2) {
     
     // Calculate Euclidean distance between feature vectors
-    double distanceSquared = 0.0;
-    for (size_t i = 0; i < features1.size(); ++i) {
-        double diff = features1[i] - features2[i];
-        distanceSquared += diff * diff;
-    }
-    double distance = std::sqrt(distanceSquared);
-    
+    return similarityFromDistance(EuclideanDistance()(features1, features2), phase1 == phase2);
+}
+
+double MLDecisionSystem::similarityFromDistance(double distance, bool samePhase) {
     // Convert distance to similarity using exponential decay function
     // exp(-distance) smoothly maps distances to [0, 1]:
     // - distance = 0 → exp(0) = 1.0 (identical)
@@ -323,7 +535,7 @@ double MLDecisionSystem::calculateSimilarity(
     
     // Calculate phase similarity component
     // Phase matching is important for relevance of training data
-    double phaseSimilarity = (c1.phase == c2.phase) ? 1.0 : 0.0;
+    double phaseSimilarity = samePhase ? 1.0 : 0.0;
     
     // Combine similarities using weighted average
     // 70% weight on feature similarity (captures state differences)
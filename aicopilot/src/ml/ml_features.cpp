@@ -4,9 +4,11 @@
 *****************************************************************************/
 
 #include "ml_features.hpp"
+#include "runway_wind.hpp"
 #include <cmath>
 #include <numeric>
 #include <algorithm>
+#include <iterator>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -16,76 +18,90 @@ namespace AICopilot {
 namespace ML {
 
 std::vector<double> CombinedFeatures::flatten() const {
-    std::vector<double> result;
-    
+    FeatureVector buffer;
+    flattenInto(buffer);
+    return std::vector<double>(buffer.begin(), buffer.end());
+}
+
+void CombinedFeatures::flattenInto(FeatureVector& out) const {
     // Weather features
-    result.push_back(weather.wind_magnitude);
-    result.push_back(weather.wind_component_headwind);
-    result.push_back(weather.wind_component_crosswind);
-    result.push_back(weather.wind_direction_category);
-    result.push_back(weather.pressure_trend);
-    result.push_back(weather.pressure_anomaly);
-    result.push_back(weather.visibility_category);
-    result.push_back(weather.visibility_index);
-    result.push_back(weather.temperature_dewpoint_spread);
-    result.push_back(weather.gust_factor);
+    double* w = out.data() + FeatureLayout::WEATHER;
+    w[0] = weather.wind_magnitude;
+    w[1] = weather.wind_component_headwind;
+    w[2] = weather.wind_component_crosswind;
+    w[3] = weather.wind_direction_category;
+    w[4] = weather.pressure_trend;
+    w[5] = weather.pressure_anomaly;
+    w[6] = weather.visibility_category;
+    w[7] = weather.visibility_index;
+    w[8] = weather.temperature_dewpoint_spread;
+    w[9] = weather.gust_factor;
     
     // Runway features
-    result.push_back(runway.length_index);
-    result.push_back(runway.width_index);
-    result.push_back(runway.surface_quality);
-    result.push_back(runway.condition_score);
-    result.push_back(runway.ils_availability);
-    result.push_back(runway.lighting_capability);
-    result.push_back(runway.runway_slope_factor);
-    result.push_back(runway.safety_margin_headwind);
-    result.push_back(runway.safety_margin_crosswind);
-    result.push_back(runway.effective_length);
+    double* r = out.data() + FeatureLayout::RUNWAY;
+    r[0] = runway.length_index;
+    r[1] = runway.width_index;
+    r[2] = runway.surface_quality;
+    r[3] = runway.condition_score;
+    r[4] = runway.ils_availability;
+    r[5] = runway.lighting_capability;
+    r[6] = runway.runway_slope_factor;
+    r[7] = runway.safety_margin_headwind;
+    r[8] = runway.safety_margin_crosswind;
+    r[9] = runway.effective_length;
     
     // Terrain features
-    result.push_back(terrain.elevation_index);
-    result.push_back(terrain.slope_steepness);
-    result.push_back(terrain.elevation_trend);
-    result.push_back(terrain.obstacle_proximity);
-    result.push_back(terrain.water_hazard_risk);
-    result.push_back(terrain.terrain_roughness);
-    result.push_back(terrain.approach_corridor_clearance);
-    result.push_back(terrain.descent_capability);
-    result.push_back(terrain.missed_approach_terrain);
+    double* t = out.data() + FeatureLayout::TERRAIN;
+    t[0] = terrain.elevation_index;
+    t[1] = terrain.slope_steepness;
+    t[2] = terrain.elevation_trend;
+    t[3] = terrain.obstacle_proximity;
+    t[4] = terrain.water_hazard_risk;
+    t[5] = terrain.terrain_roughness;
+    t[6] = terrain.approach_corridor_clearance;
+    t[7] = terrain.descent_capability;
+    t[8] = terrain.missed_approach_terrain;
     
     // Navigation features
-    result.push_back(navigation.route_complexity_score);
-    result.push_back(navigation.route_length_index);
-    result.push_back(navigation.airway_density_index);
-    result.push_back(navigation.waypoint_spacing);
-    result.push_back(navigation.navigation_aid_density);
-    result.push_back(navigation.procedure_complexity);
-    result.push_back(navigation.terrain_following_difficulty);
-    result.push_back(navigation.procedural_clearance_margin);
-    result.push_back(navigation.waypoint_precision_index);
-    
-    return result;
+    double* n = out.data() + FeatureLayout::NAVIGATION;
+    n[0] = navigation.route_complexity_score;
+    n[1] = navigation.route_length_index;
+    n[2] = navigation.airway_density_index;
+    n[3] = navigation.waypoint_spacing;
+    n[4] = navigation.navigation_aid_density;
+    n[5] = navigation.procedure_complexity;
+    n[6] = navigation.terrain_following_difficulty;
+    n[7] = navigation.procedural_clearance_margin;
+    n[8] = navigation.waypoint_precision_index;
 }
 
+namespace {
+
+const char* const FEATURE_NAMES[] = {
+    // Weather (10)
+    "wind_magnitude", "wind_headwind", "wind_crosswind", "wind_direction",
+    "pressure_trend", "pressure_anomaly", "visibility_category", "visibility_index",
+    "temp_dewpoint", "gust_factor",
+    // Runway (10)
+    "length_index", "width_index", "surface_quality", "condition_score",
+    "ils_availability", "lighting_capability", "slope_factor", "safety_headwind",
+    "safety_crosswind", "effective_length",
+    // Terrain (9)
+    "elevation_index", "slope_steepness", "elevation_trend", "obstacle_proximity",
+    "water_hazard", "terrain_roughness", "approach_clearance", "descent_capability",
+    "missed_approach",
+    // Navigation (9)
+    "route_complexity", "route_length", "airway_density", "waypoint_spacing",
+    "nav_aid_density", "procedure_complexity", "terrain_following", "clearance_margin",
+    "waypoint_precision"
+};
+static_assert(sizeof(FEATURE_NAMES) / sizeof(FEATURE_NAMES[0]) == FeatureLayout::COUNT,
+              "One name per flattened feature");
+
+} // namespace
+
 std::vector<std::string> CombinedFeatures::getFeatureNames() {
-    return {
-        // Weather (10)
-        "wind_magnitude", "wind_headwind", "wind_crosswind", "wind_direction",
-        "pressure_trend", "pressure_anomaly", "visibility_category", "visibility_index",
-        "temp_dewpoint", "gust_factor",
-        // Runway (10)
-        "length_index", "width_index", "surface_quality", "condition_score",
-        "ils_availability", "lighting_capability", "slope_factor", "safety_headwind",
-        "safety_crosswind", "effective_length",
-        // Terrain (9)
-        "elevation_index", "slope_steepness", "elevation_trend", "obstacle_proximity",
-        "water_hazard", "terrain_roughness", "approach_clearance", "descent_capability",
-        "missed_approach",
-        // Navigation (9)
-        "route_complexity", "route_length", "airway_density", "waypoint_spacing",
-        "nav_aid_density", "procedure_complexity", "terrain_following", "clearance_margin",
-        "waypoint_precision"
-    };
+    return std::vector<std::string>(std::begin(FEATURE_NAMES), std::end(FEATURE_NAMES));
 }
 
 MLFeatures::MLFeatures() {}
@@ -273,16 +289,10 @@ MLFeatures::WindComponents MLFeatures::calculateWindComponents(
     double wind_speed, double wind_direction,
     double runway_heading) {
     
+    RunwayWind::Components wind = RunwayWind::compute(runway_heading, wind_direction, wind_speed);
     WindComponents components;
-    double relative_direction = wind_direction - runway_heading;
-    
-    // Normalize to -180 to 180
-    while (relative_direction > 180) relative_direction -= 360;
-    while (relative_direction < -180) relative_direction += 360;
-    
-    double angle_rad = relative_direction * M_PI / 180.0;
-    components.headwind = wind_speed * std::cos(angle_rad);
-    components.crosswind = wind_speed * std::sin(angle_rad);
+    components.headwind = wind.headwind;
+    components.crosswind = wind.crosswind;
     
     return components;
 }
@@ -0,0 +1,218 @@
+/*****************************************************************************
+* ML Inference Backends Implementation
+* Copyright 2025 AI Copilot FS Project
+*****************************************************************************/
+
+#include "ml_inference.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#ifdef ENABLE_ONNXRUNTIME
+#include <onnxruntime_cxx_api.h>
+#endif
+
+namespace AICopilot {
+namespace ML {
+
+namespace {
+
+// Symmetric int8 quantization of count values; returns the scale
+float quantizeRow(const float* values, size_t count, int8_t* out) {
+    float max_abs = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        max_abs = std::max(max_abs, std::abs(values[i]));
+    }
+    if (max_abs == 0.0f) {
+        std::fill(out, out + count, int8_t(0));
+        return 0.0f;
+    }
+    float scale = max_abs / 127.0f;
+    float inverse = 1.0f / scale;
+    for (size_t i = 0; i < count; ++i) {
+        long q = std::lround(values[i] * inverse);
+        out[i] = static_cast<int8_t>(std::max(-127L, std::min(127L, q)));
+    }
+    return scale;
+}
+
+float activate(float value, QuantizedMLPBackend::Activation activation) {
+    switch (activation) {
+        case QuantizedMLPBackend::RELU:
+            return std::max(0.0f, value);
+        case QuantizedMLPBackend::SIGMOID:
+            return 1.0f / (1.0f + std::exp(-value));
+        default:
+            return value;
+    }
+}
+
+} // namespace
+
+// QuantizedMLPBackend Implementation
+QuantizedMLPBackend::Layer QuantizedMLPBackend::quantize(
+    const std::vector<float>& weights,
+    const std::vector<float>& bias,
+    size_t inputs,
+    size_t outputs,
+    Activation activation) {
+
+    Layer layer;
+    if (weights.size() != inputs * outputs || bias.size() != outputs) {
+        return layer;
+    }
+
+    layer.inputs = inputs;
+    layer.outputs = outputs;
+    layer.weights.resize(inputs * outputs);
+    layer.scales.resize(outputs);
+    layer.bias = bias;
+    layer.activation = activation;
+    for (size_t o = 0; o < outputs; ++o) {
+        layer.scales[o] = quantizeRow(&weights[o * inputs], inputs, &layer.weights[o * inputs]);
+    }
+    return layer;
+}
+
+bool QuantizedMLPBackend::addLayer(Layer layer) {
+    if (layer.inputs == 0 || layer.outputs == 0 ||
+        layer.weights.size() != layer.inputs * layer.outputs ||
+        layer.scales.size() != layer.outputs || layer.bias.size() != layer.outputs) {
+        return false;
+    }
+    if (!layers_.empty() && layers_.back().outputs != layer.inputs) {
+        return false;
+    }
+    widest_ = std::max({widest_, layer.inputs, layer.outputs});
+    layers_.push_back(std::move(layer));
+    return true;
+}
+
+bool QuantizedMLPBackend::run(const float* inputs, size_t rows, float* outputs) const {
+    if (layers_.empty()) {
+        return false;
+    }
+
+    // Two float buffers ping-pong between layers; one int8 buffer holds
+    // the quantized input of the current layer
+    std::vector<float> current(widest_);
+    std::vector<float> next(widest_);
+    std::vector<int8_t> quantized(widest_);
+
+    for (size_t row = 0; row < rows; ++row) {
+        std::copy(inputs + row * inputSize(), inputs + (row + 1) * inputSize(), current.begin());
+        for (const Layer& layer : layers_) {
+            float input_scale = quantizeRow(current.data(), layer.inputs, quantized.data());
+            for (size_t o = 0; o < layer.outputs; ++o) {
+                const int8_t* w = &layer.weights[o * layer.inputs];
+                int32_t acc = 0;
+                for (size_t i = 0; i < layer.inputs; ++i) {
+                    acc += int32_t(w[i]) * int32_t(quantized[i]);
+                }
+                float value = float(acc) * layer.scales[o] * input_scale + layer.bias[o];
+                next[o] = activate(value, layer.activation);
+            }
+            std::swap(current, next);
+        }
+        std::copy(current.begin(), current.begin() + outputSize(), outputs + row * outputSize());
+    }
+    return true;
+}
+
+#ifdef ENABLE_ONNXRUNTIME
+
+namespace {
+
+/**
+ * ONNX Runtime session for one model file. Ort::Session::Run is
+ * thread-safe, so one session serves every caller.
+ */
+class OnnxRuntimeBackend : public InferenceBackend {
+public:
+    OnnxRuntimeBackend(const std::string& model_path, const InferenceConfig& config)
+        : env_(ORT_LOGGING_LEVEL_WARNING, "aicopilot") {
+
+        Ort::SessionOptions options;
+        options.SetIntraOpNumThreads(static_cast<int>(std::max<size_t>(1, config.intra_op_threads)));
+        options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+#ifdef _WIN32
+        std::wstring wide_path(model_path.begin(), model_path.end());
+        session_ = std::make_unique<Ort::Session>(env_, wide_path.c_str(), options);
+#else
+        session_ = std::make_unique<Ort::Session>(env_, model_path.c_str(), options);
+#endif
+
+        Ort::AllocatorWithDefaultOptions allocator;
+        input_name_ = session_->GetInputNameAllocated(0, allocator).get();
+        output_name_ = session_->GetOutputNameAllocated(0, allocator).get();
+        input_size_ = lastDimension(session_->GetInputTypeInfo(0));
+        output_size_ = lastDimension(session_->GetOutputTypeInfo(0));
+    }
+
+    std::string name() const override { return "onnxruntime"; }
+    size_t inputSize() const override { return input_size_; }
+    size_t outputSize() const override { return output_size_; }
+
+    bool run(const float* inputs, size_t rows, float* outputs) const override {
+        try {
+            Ort::MemoryInfo memory = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+            const int64_t input_shape[2] = {static_cast<int64_t>(rows), static_cast<int64_t>(input_size_)};
+            const int64_t output_shape[2] = {static_cast<int64_t>(rows), static_cast<int64_t>(output_size_)};
+            Ort::Value input = Ort::Value::CreateTensor<float>(
+                memory, const_cast<float*>(inputs), rows * input_size_, input_shape, 2);
+            Ort::Value output = Ort::Value::CreateTensor<float>(
+                memory, outputs, rows * output_size_, output_shape, 2);
+            const char* input_names[] = {input_name_.c_str()};
+            const char* output_names[] = {output_name_.c_str()};
+            session_->Run(Ort::RunOptions{nullptr}, input_names, &input, 1, output_names, &output, 1);
+            return true;
+        } catch (const Ort::Exception& e) {
+            std::cerr << "OnnxRuntimeBackend: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+private:
+    static size_t lastDimension(const Ort::TypeInfo& info) {
+        std::vector<int64_t> shape = info.GetTensorTypeAndShapeInfo().GetShape();
+        return shape.empty() || shape.back() <= 0 ? 0 : static_cast<size_t>(shape.back());
+    }
+
+    Ort::Env env_;
+    std::unique_ptr<Ort::Session> session_;
+    std::string input_name_;
+    std::string output_name_;
+    size_t input_size_ = 0;
+    size_t output_size_ = 0;
+};
+
+} // namespace
+
+std::unique_ptr<InferenceBackend> createOnnxBackend(const std::string& model_path,
+                                                    const InferenceConfig& config) {
+    try {
+        auto backend = std::make_unique<OnnxRuntimeBackend>(model_path, config);
+        if (backend->inputSize() == 0 || backend->outputSize() == 0) {
+            std::cerr << "OnnxRuntimeBackend: " << model_path << " needs a fixed feature dimension" << std::endl;
+            return nullptr;
+        }
+        return backend;
+    } catch (const Ort::Exception& e) {
+        std::cerr << "OnnxRuntimeBackend: Cannot load " << model_path << ": " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+#else
+
+std::unique_ptr<InferenceBackend> createOnnxBackend(const std::string& model_path,
+                                                    const InferenceConfig& config) {
+    (void)config;
+    std::cerr << "ML: ONNX Runtime support not compiled in, cannot load " << model_path << std::endl;
+    return nullptr;
+}
+
+#endif // ENABLE_ONNXRUNTIME
+
+} // namespace ML
+} // namespace AICopilot
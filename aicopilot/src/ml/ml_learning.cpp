@@ -4,10 +4,11 @@
 *****************************************************************************/
 
 #include "ml_learning.hpp"
+#include "flight_data_recorder.hpp"
+#include "model_pack.hpp"
 #include <cmath>
 #include <algorithm>
 #include <numeric>
-#include <fstream>
 
 namespace AICopilot {
 namespace ML {
@@ -25,7 +26,9 @@ MLLearningSystem::~MLLearningSystem() {
 }
 
 void MLLearningSystem::recordOutcome(const LearningOutcome& outcome) {
-    learning_history_.push_back(outcome);
+    FeatureVector features;
+    outcome.features.flattenInto(features);
+    appendHistory(outcome, features);
     
     // Update accuracy metrics
     if (outcome.correct_prediction) {
@@ -34,10 +37,7 @@ void MLLearningSystem::recordOutcome(const LearningOutcome& outcome) {
     accuracy_metrics_.total_samples++;
     
     // Update feature statistics
-    updateFeatureStatistics(outcome.features);
-    
-    // Maintain history size
-    maintainHistorySize();
+    updateFeatureStatistics(features);
 }
 
 bool MLLearningSystem::updateModelWithFeedback(const LearningOutcome& outcome) {
@@ -65,20 +65,10 @@ bool MLLearningSystem::updateModelWithFeedback(const LearningOutcome& outcome) {
 AccuracyMetrics MLLearningSystem::getAccuracyMetrics() const {
     AccuracyMetrics metrics = accuracy_metrics_;
     
-    // Calculate recent accuracy (last 100 samples)
-    int recent_count = 0;
-    int recent_correct = 0;
-    
-    int start_idx = std::max(0, static_cast<int>(learning_history_.size()) - RECENT_SAMPLE_SIZE);
-    for (int i = start_idx; i < static_cast<int>(learning_history_.size()); ++i) {
-        recent_count++;
-        if (learning_history_[i].correct_prediction) {
-            recent_correct++;
-        }
-    }
-    
+    // Recent accuracy (last 100 samples)
+    size_t recent_count = std::min(learning_history_.size(), static_cast<size_t>(RECENT_SAMPLE_SIZE));
     if (recent_count > 0) {
-        metrics.recent_accuracy = static_cast<double>(recent_correct) / recent_count;
+        metrics.recent_accuracy = static_cast<double>(recent_correct_) / recent_count;
     }
     
     return metrics;
@@ -88,21 +78,10 @@ double MLLearningSystem::getAccuracyTrend() const {
     if (learning_history_.size() < 20) return 0.0;
     
     // Compare recent vs older accuracy
-    int mid_point = learning_history_.size() / 2;
-    int old_correct = 0, old_total = 0;
-    int recent_correct = 0, recent_total = 0;
-    
-    for (size_t i = 0; i < learning_history_.size(); ++i) {
-        if (i < mid_point) {
-            old_total++;
-            if (learning_history_[i].correct_prediction) old_correct++;
-        } else {
-            recent_total++;
-            if (learning_history_[i].correct_prediction) recent_correct++;
-        }
-    }
+    size_t recent_total = learning_history_.size() - old_half_size_;
+    int recent_correct = history_correct_ - old_half_correct_;
     
-    double old_accuracy = old_total > 0 ? static_cast<double>(old_correct) / old_total : 0;
+    double old_accuracy = old_half_size_ > 0 ? static_cast<double>(old_half_correct_) / old_half_size_ : 0;
     double recent_accuracy = recent_total > 0 ? static_cast<double>(recent_correct) / recent_total : 0;
     
     return recent_accuracy - old_accuracy;
@@ -185,13 +164,15 @@ MLLearningSystem::AnomalyDetectionStats MLLearningSystem::performAnomalyDetectio
     
     AnomalyDetectionStats stats;
     stats.is_anomaly = false;
+    stats.max_z_score = 0.0;
     
-    for (size_t i = 0; i < feature_vector.size(); ++i) {
-        if (feature_statistics_.count("feature_" + std::to_string(i)) == 0) {
-            continue;
-        }
-        
-        auto& feat_stats = feature_statistics_["feature_" + std::to_string(i)];
+    if (!has_feature_stats_) {
+        return stats;
+    }
+    
+    size_t count = std::min(feature_vector.size(), feature_statistics_.size());
+    for (size_t i = 0; i < count; ++i) {
+        const FeatureStats& feat_stats = feature_statistics_[i];
         double z_score = 0.0;
         
         if (feat_stats.std_dev > 0) {
@@ -210,6 +191,79 @@ MLLearningSystem::AnomalyDetectionStats MLLearningSystem::performAnomalyDetectio
     return stats;
 }
 
+namespace {
+
+const char* const PHASE_PATTERN_NAMES[] = {
+    "preflight", "taxi_out", "takeoff", "climb", "cruise", "descent",
+    "approach", "landing", "taxi_in", "shutdown", "unknown",
+};
+
+// Stability envelope a phase segment must stay inside to count as a success
+struct PhaseEnvelope {
+    double max_bank;            // degrees
+    double min_vertical_speed;  // fpm
+    double max_vertical_speed;  // fpm
+};
+
+PhaseEnvelope phaseEnvelope(int phase) {
+    if (phase == static_cast<int>(FlightPhase::APPROACH) || phase == static_cast<int>(FlightPhase::LANDING)) {
+        return {30.0, -1000.0, 4000.0};
+    }
+    return {35.0, -4000.0, 4000.0};
+}
+
+} // namespace
+
+size_t MLLearningSystem::buildPatternDatabase(const FlightDataReader& recording) {
+    std::vector<double> phases;
+    std::vector<double> banks;
+    std::vector<double> vertical_speeds;
+    if (!recording.readColumn(FDR_FLIGHT_PHASE, phases) ||
+        !recording.readColumn(FDR_BANK, banks) ||
+        !recording.readColumn(FDR_VERTICAL_SPEED, vertical_speeds) ||
+        banks.size() != phases.size() || vertical_speeds.size() != phases.size()) {
+        return 0;
+    }
+
+    const int phase_count = static_cast<int>(sizeof(PHASE_PATTERN_NAMES) / sizeof(PHASE_PATTERN_NAMES[0]));
+    size_t segments = 0;
+    size_t begin = 0;
+    while (begin < phases.size()) {
+        size_t end = begin;
+        while (end < phases.size() && phases[end] == phases[begin]) ++end;
+
+        int phase = std::clamp(static_cast<int>(phases[begin]), 0, phase_count - 1);
+        PhaseEnvelope envelope = phaseEnvelope(phase);
+        bool stable = true;
+        for (size_t i = begin; i < end && stable; ++i) {
+            stable = isStableSample(static_cast<FlightPhase>(phase), banks[i], vertical_speeds[i]);
+        }
+
+        HistoricalPattern& pattern = patterns_[PHASE_PATTERN_NAMES[phase]];
+        if (pattern.occurrence_count == 0) {
+            pattern.pattern_name = PHASE_PATTERN_NAMES[phase];
+            pattern.success_rate = 0.0;
+            pattern.recommendation = "Keep bank within " + std::to_string(static_cast<int>(envelope.max_bank)) +
+                " degrees and vertical speed between " +
+                std::to_string(static_cast<int>(envelope.min_vertical_speed)) + " and " +
+                std::to_string(static_cast<int>(envelope.max_vertical_speed)) + " fpm";
+        }
+        pattern.success_rate = (pattern.success_rate * pattern.occurrence_count + (stable ? 1.0 : 0.0)) /
+                               (pattern.occurrence_count + 1);
+        pattern.occurrence_count++;
+        segments++;
+        begin = end;
+    }
+    return segments;
+}
+
+bool MLLearningSystem::isStableSample(FlightPhase phase, double bank, double vertical_speed) {
+    PhaseEnvelope envelope = phaseEnvelope(static_cast<int>(phase));
+    return std::abs(bank) <= envelope.max_bank &&
+           vertical_speed >= envelope.min_vertical_speed &&
+           vertical_speed <= envelope.max_vertical_speed;
+}
+
 std::vector<HistoricalPattern> MLLearningSystem::findHistoricalPatterns(
     const CombinedFeatures& features) {
     
@@ -233,24 +287,17 @@ std::vector<LearningOutcome> MLLearningSystem::findSimilarHistoricalCases(
     int num_similar) {
     
     std::vector<LearningOutcome> similar_cases;
-    std::vector<std::pair<double, LearningOutcome>> scored_cases;
+    if (num_similar <= 0) return similar_cases;
     
-    for (const auto& outcome : learning_history_) {
-        double similarity = calculateFeatureSimilarity(features, outcome.features);
-        scored_cases.push_back({similarity, outcome});
-    }
-    
-    // Sort by similarity descending
-    std::sort(scored_cases.begin(), scored_cases.end(),
-        [](const auto& a, const auto& b) {
-            return a.first > b.first;
-        });
+    FeatureVector query;
+    features.flattenInto(query);
+    std::vector<std::pair<uint32_t, double>> nearest;
+    history_index_.nearest(query, static_cast<size_t>(num_similar), nearest);
     
-    // Return top similar cases
-    for (int i = 0; i < std::min(num_similar, static_cast<int>(scored_cases.size())); ++i) {
-        similar_cases.push_back(scored_cases[i].second);
+    similar_cases.reserve(nearest.size());
+    for (const auto& [slot, distance] : nearest) {
+        similar_cases.push_back(learning_history_[slot]);
     }
-    
     return similar_cases;
 }
 
@@ -258,10 +305,10 @@ double MLLearningSystem::calculateFeatureSimilarity(
     const CombinedFeatures& f1,
     const CombinedFeatures& f2) {
     
-    auto v1 = f1.flatten();
-    auto v2 = f2.flatten();
-    
-    if (v1.size() != v2.size()) return 0.0;
+    FeatureVector v1;
+    FeatureVector v2;
+    f1.flattenInto(v1);
+    f2.flattenInto(v2);
     
     double similarity = 0.0;
     for (size_t i = 0; i < v1.size(); ++i) {
@@ -285,37 +332,67 @@ MLLearningSystem::LearningStatistics MLLearningSystem::getLearningStatistics() c
 
 void MLLearningSystem::clearHistory() {
     learning_history_.clear();
-    feature_statistics_.clear();
+    history_head_ = 0;
+    history_index_.clear();
+    recent_features_.clear();
+    feature_samples_ = 0;
+    has_feature_stats_ = false;
+    feature_statistics_.fill(FeatureStats());
+    recent_correct_ = 0;
+    history_correct_ = 0;
+    old_half_correct_ = 0;
+    old_half_size_ = 0;
     patterns_.clear();
     accuracy_metrics_.total_samples = 0;
     accuracy_metrics_.correct_predictions = 0;
 }
 
 bool MLLearningSystem::saveLearningState(const std::string& filepath) {
-    std::ofstream file(filepath, std::ios::binary);
-    if (!file.is_open()) return false;
-    
-    // Save accuracy metrics
-    file.write(reinterpret_cast<char*>(&accuracy_metrics_.total_samples), 
-               sizeof(accuracy_metrics_.total_samples));
-    file.write(reinterpret_cast<char*>(&accuracy_metrics_.correct_predictions), 
-               sizeof(accuracy_metrics_.correct_predictions));
-    
-    file.close();
-    return true;
+    ModelPackBuilder builder;
+    saveLearningState(builder);
+    return builder.write(filepath);
+}
+
+void MLLearningSystem::saveLearningState(ModelPackBuilder& builder) const {
+    builder.setLearningState({accuracy_metrics_.total_samples, accuracy_metrics_.correct_predictions,
+                              accuracy_metrics_.overall_accuracy});
+    if (has_feature_stats_) {
+        std::vector<ModelPackFeatureStats> stats;
+        stats.reserve(feature_statistics_.size());
+        for (const FeatureStats& feature : feature_statistics_) {
+            stats.push_back({feature.mean, feature.std_dev, feature.min_val, feature.max_val});
+        }
+        builder.setFeatureStats(std::move(stats));
+    }
 }
 
 bool MLLearningSystem::loadLearningState(const std::string& filepath) {
-    std::ifstream file(filepath, std::ios::binary);
-    if (!file.is_open()) return false;
-    
-    // Load accuracy metrics
-    file.read(reinterpret_cast<char*>(&accuracy_metrics_.total_samples), 
-              sizeof(accuracy_metrics_.total_samples));
-    file.read(reinterpret_cast<char*>(&accuracy_metrics_.correct_predictions), 
-              sizeof(accuracy_metrics_.correct_predictions));
-    
-    file.close();
+    ModelPack pack;
+    return pack.open(filepath) && loadLearningState(pack);
+}
+
+bool MLLearningSystem::loadLearningState(const ModelPack& pack) {
+    if (!pack.isOpen() || !pack.hasLearningState()) return false;
+    
+    const ModelPackLearningState& state = pack.getLearningState();
+    accuracy_metrics_.total_samples = state.totalSamples;
+    accuracy_metrics_.correct_predictions = state.correctPredictions;
+    accuracy_metrics_.overall_accuracy = state.overallAccuracy;
+    
+    // The window itself is not saved; the next outcome starts a new one
+    recent_features_.clear();
+    feature_samples_ = 0;
+    feature_statistics_.fill(FeatureStats());
+    has_feature_stats_ = pack.getFeatureStatsCount() == feature_statistics_.size();
+    if (has_feature_stats_) {
+        const ModelPackFeatureStats* stats = pack.getFeatureStats();
+        for (size_t i = 0; i < feature_statistics_.size(); ++i) {
+            feature_statistics_[i].mean = stats[i].mean;
+            feature_statistics_[i].std_dev = stats[i].stdDev;
+            feature_statistics_[i].min_val = stats[i].minValue;
+            feature_statistics_[i].max_val = stats[i].maxValue;
+        }
+    }
     return true;
 }
 
@@ -358,43 +435,47 @@ std::vector<std::string> MLLearningSystem::getRecommendations(
     return recommendations;
 }
 
-void MLLearningSystem::updateFeatureStatistics(const CombinedFeatures& features) {
-    auto feature_vector = features.flatten();
+void MLLearningSystem::updateFeatureStatistics(const FeatureVector& feature_vector) {
+    size_t slot = feature_samples_ % RECENT_SAMPLE_SIZE;
+    bool window_full = feature_samples_ >= RECENT_SAMPLE_SIZE;
+    double n = static_cast<double>(std::min(feature_samples_ + 1, static_cast<size_t>(RECENT_SAMPLE_SIZE)));
     
     for (size_t i = 0; i < feature_vector.size(); ++i) {
-        std::string key = "feature_" + std::to_string(i);
+        FeatureStats& stats = feature_statistics_[i];
+        double value = feature_vector[i];
         
-        if (feature_statistics_.find(key) == feature_statistics_.end()) {
-            feature_statistics_[key].mean = feature_vector[i];
-            feature_statistics_[key].std_dev = 0.0;
-            feature_statistics_[key].min_val = feature_vector[i];
-            feature_statistics_[key].max_val = feature_vector[i];
-            feature_statistics_[key].recent_values.push_back(feature_vector[i]);
+        if (feature_samples_ == 0) {
+            stats = FeatureStats();
+            stats.mean = value;
+            stats.min_val = value;
+            stats.max_val = value;
+            continue;
+        }
+        
+        double old_mean = stats.mean;
+        if (window_full) {
+            // The value leaving the window is replaced by this one
+            double leaving = recent_features_[slot][i];
+            stats.mean += (value - leaving) / n;
+            stats.m2 += (value - leaving) * (value - stats.mean + leaving - old_mean);
+            stats.m2 = std::max(0.0, stats.m2);
         } else {
-            auto& stats = feature_statistics_[key];
-            
-            // Update running statistics
-            double old_mean = stats.mean;
-            int n = stats.recent_values.size() + 1;
-            stats.mean = (old_mean * (n - 1) + feature_vector[i]) / n;
-            
-            // Update std dev
-            double variance = 0.0;
-            for (double val : stats.recent_values) {
-                variance += (val - stats.mean) * (val - stats.mean);
-            }
-            variance += (feature_vector[i] - stats.mean) * (feature_vector[i] - stats.mean);
-            stats.std_dev = std::sqrt(variance / std::max(1, n - 1));
-            
-            stats.min_val = std::min(stats.min_val, feature_vector[i]);
-            stats.max_val = std::max(stats.max_val, feature_vector[i]);
-            
-            stats.recent_values.push_back(feature_vector[i]);
-            if (stats.recent_values.size() > 100) {
-                stats.recent_values.erase(stats.recent_values.begin());
-            }
+            stats.mean += (value - old_mean) / n;
+            stats.m2 += (value - old_mean) * (value - stats.mean);
         }
+        stats.std_dev = std::sqrt(stats.m2 / (n - 1));
+        
+        stats.min_val = std::min(stats.min_val, value);
+        stats.max_val = std::max(stats.max_val, value);
+    }
+    
+    if (window_full) {
+        recent_features_[slot] = feature_vector;
+    } else {
+        recent_features_.push_back(feature_vector);
     }
+    feature_samples_++;
+    has_feature_stats_ = true;
 }
 
 std::vector<double> MLLearningSystem::calculateZScores(
@@ -403,12 +484,10 @@ std::vector<double> MLLearningSystem::calculateZScores(
     std::vector<double> z_scores;
     
     for (size_t i = 0; i < feature_vector.size(); ++i) {
-        std::string key = "feature_" + std::to_string(i);
-        
-        if (feature_statistics_.find(key) == feature_statistics_.end()) {
+        if (!has_feature_stats_ || i >= feature_statistics_.size()) {
             z_scores.push_back(0.0);
         } else {
-            auto& stats = feature_statistics_[key];
+            const FeatureStats& stats = feature_statistics_[i];
             double z_score = 0.0;
             
             if (stats.std_dev > 0) {
@@ -422,11 +501,42 @@ std::vector<double> MLLearningSystem::calculateZScores(
     return z_scores;
 }
 
-void MLLearningSystem::maintainHistorySize() {
-    if (learning_history_.size() > MAX_HISTORY_SIZE) {
-        learning_history_.erase(
-            learning_history_.begin(),
-            learning_history_.begin() + (learning_history_.size() - MAX_HISTORY_SIZE));
+const LearningOutcome& MLLearningSystem::historyAt(size_t age) const {
+    size_t slot = history_head_ + age;
+    return learning_history_[slot < learning_history_.size() ? slot : slot - learning_history_.size()];
+}
+
+void MLLearningSystem::appendHistory(const LearningOutcome& outcome, const FeatureVector& features) {
+    int correct = outcome.correct_prediction ? 1 : 0;
+    size_t size = learning_history_.size();
+    
+    // The outcome RECENT_SAMPLE_SIZE back leaves the recent window
+    if (size >= static_cast<size_t>(RECENT_SAMPLE_SIZE)) {
+        recent_correct_ -= historyAt(size - RECENT_SAMPLE_SIZE).correct_prediction ? 1 : 0;
+    }
+    recent_correct_ += correct;
+    
+    if (size == static_cast<size_t>(MAX_HISTORY_SIZE)) {
+        // Overwrite the oldest, which leaves the older half too
+        int oldest = learning_history_[history_head_].correct_prediction ? 1 : 0;
+        history_correct_ -= oldest;
+        if (old_half_size_ > 0) {
+            old_half_correct_ -= oldest;
+            old_half_size_--;
+        }
+        learning_history_[history_head_] = outcome;
+        history_index_.insert(static_cast<uint32_t>(history_head_), features);
+        history_head_ = (history_head_ + 1) % learning_history_.size();
+    } else {
+        learning_history_.push_back(outcome);
+        history_index_.insert(static_cast<uint32_t>(size), features);
+    }
+    history_correct_ += correct;
+    
+    // The older half is the first size / 2 outcomes
+    while (old_half_size_ < learning_history_.size() / 2) {
+        old_half_correct_ += historyAt(old_half_size_).correct_prediction ? 1 : 0;
+        old_half_size_++;
     }
 }
 
@@ -4,10 +4,16 @@
 *****************************************************************************/
 
 #include "ml_models.hpp"
+#include "work_stealing_pool.hpp"
 #include <cmath>
 #include <algorithm>
+#include <iostream>
 #include <numeric>
 
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
 namespace AICopilot {
 namespace ML {
 
@@ -29,14 +35,7 @@ ModelPrediction RunwaySelectionModel::scoreRunway(
     
     ModelPrediction pred;
     
-    double weather_score = scoreWindCondition(features.weather);
-    double visibility_score = scoreVisibilityCondition(features.weather);
-    double runway_score = scoreRunwayCondition(features.runway);
-    
-    double total_score = (weather_score * 0.4) + (visibility_score * 0.35) + 
-                        (runway_score * 0.25);
-    
-    pred.prediction = std::max(0.0, std::min(1.0, total_score));
+    pred.prediction = score(features);
     pred.confidence = 0.85;  // Runway selection model high confidence
     pred.probabilities.push_back(pred.prediction);
     pred.probabilities.push_back(1.0 - pred.prediction);
@@ -53,24 +52,25 @@ ModelPrediction RunwaySelectionModel::scoreRunway(
     return pred;
 }
 
+double RunwaySelectionModel::score(const CombinedFeatures& features) {
+    double weather_score = scoreWindCondition(features.weather);
+    double visibility_score = scoreVisibilityCondition(features.weather);
+    double runway_score = scoreRunwayCondition(features.runway);
+    
+    double total_score = (weather_score * 0.4) + (visibility_score * 0.35) + 
+                        (runway_score * 0.25);
+    
+    return std::max(0.0, std::min(1.0, total_score));
+}
+
 std::vector<int> RunwaySelectionModel::rankRunways(
     const CombinedFeatures& features,
     int num_runways) {
     
-    std::vector<int> rankings;
-    std::vector<double> scores;
-    
-    for (int i = 0; i < num_runways; ++i) {
-        ModelPrediction pred = scoreRunway(features, i);
-        scores.push_back(pred.prediction);
-        rankings.push_back(i);
-    }
-    
-    // Sort by scores descending
-    std::sort(rankings.begin(), rankings.end(),
-        [&scores](int a, int b) {
-            return scores[a] > scores[b];
-        });
+    // The score depends only on the shared features, so every runway ties
+    // and the ranking is the runways in order
+    std::vector<int> rankings(std::max(0, num_runways));
+    std::iota(rankings.begin(), rankings.end(), 0);
     
     return rankings;
 }
@@ -88,11 +88,11 @@ void RunwaySelectionModel::train(const std::vector<TrainingSample>& samples) {
     double total_error = 0;
     
     for (const auto& sample : samples) {
-        ModelPrediction pred = scoreRunway(sample.features, 0);
-        if (std::abs(pred.prediction - sample.label) < 0.2) {
+        double prediction = score(sample.features);
+        if (std::abs(prediction - sample.label) < 0.2) {
             correct++;
         }
-        total_error += std::abs(pred.prediction - sample.label);
+        total_error += std::abs(prediction - sample.label);
     }
     
     metrics_.accuracy = static_cast<double>(correct) / samples.size();
@@ -142,14 +142,7 @@ ModelPrediction ApproachPlanningModel::scoreApproachSafety(
     
     ModelPrediction pred;
     
-    double weather_hazard = assessWeatherHazards(features.weather);
-    double terrain_hazard = assessTerrainHazards(features.terrain);
-    double approach_stability = 1.0 - std::min(1.0, std::abs(descent_rate) / 1000.0);
-    
-    double safety_score = (weather_hazard * 0.35) + (terrain_hazard * 0.35) + 
-                         (approach_stability * 0.30);
-    
-    pred.prediction = std::max(0.0, std::min(1.0, safety_score));
+    pred.prediction = safetyScore(features, descent_rate);
     pred.confidence = 0.88;
     pred.success = true;
     
@@ -164,6 +157,17 @@ ModelPrediction ApproachPlanningModel::scoreApproachSafety(
     return pred;
 }
 
+double ApproachPlanningModel::safetyScore(const CombinedFeatures& features, double descent_rate) {
+    double weather_hazard = assessWeatherHazards(features.weather);
+    double terrain_hazard = assessTerrainHazards(features.terrain);
+    double approach_stability = 1.0 - std::min(1.0, std::abs(descent_rate) / 1000.0);
+    
+    double safety_score = (weather_hazard * 0.35) + (terrain_hazard * 0.35) + 
+                         (approach_stability * 0.30);
+    
+    return std::max(0.0, std::min(1.0, safety_score));
+}
+
 double ApproachPlanningModel::predictApproachSuccessProbability(
     const CombinedFeatures& features,
     double distance_to_runway) {
@@ -222,11 +226,11 @@ void ApproachPlanningModel::train(const std::vector<TrainingSample>& samples) {
     double total_error = 0;
     
     for (const auto& sample : samples) {
-        ModelPrediction pred = scoreApproachSafety(sample.features, 5, 2000, 500);
-        if (std::abs(pred.prediction - sample.label) < 0.15) {
+        double prediction = safetyScore(sample.features, 500);
+        if (std::abs(prediction - sample.label) < 0.15) {
             correct++;
         }
-        total_error += std::abs(pred.prediction - sample.label);
+        total_error += std::abs(prediction - sample.label);
     }
     
     metrics_.accuracy = static_cast<double>(correct) / samples.size();
@@ -268,11 +272,7 @@ ModelPrediction RouteSelectionModel::scoreRoute(
     
     ModelPrediction pred;
     
-    double efficiency = calculateEfficiencyFactor(features.navigation);
-    double safety = calculateSafetyFactor(features.navigation);
-    
-    double route_score = balanceEfficiencySafety(efficiency, safety);
-    pred.prediction = std::max(0.0, std::min(1.0, route_score));
+    pred.prediction = score(features);
     pred.confidence = 0.82;
     pred.success = true;
     
@@ -287,23 +287,21 @@ ModelPrediction RouteSelectionModel::scoreRoute(
     return pred;
 }
 
+double RouteSelectionModel::score(const CombinedFeatures& features) {
+    double efficiency = calculateEfficiencyFactor(features.navigation);
+    double safety = calculateSafetyFactor(features.navigation);
+    
+    double route_score = balanceEfficiencySafety(efficiency, safety);
+    return std::max(0.0, std::min(1.0, route_score));
+}
+
 std::vector<int> RouteSelectionModel::rankRoutes(
     const CombinedFeatures& features,
     const std::vector<std::vector<double>>& route_options) {
     
-    std::vector<int> rankings;
-    std::vector<double> scores;
-    
-    for (size_t i = 0; i < route_options.size(); ++i) {
-        ModelPrediction pred = scoreRoute(features, route_options[i]);
-        scores.push_back(pred.prediction);
-        rankings.push_back(i);
-    }
-    
-    std::sort(rankings.begin(), rankings.end(),
-        [&scores](int a, int b) {
-            return scores[a] > scores[b];
-        });
+    // As with runways, the waypoints don't enter the score yet: all tie
+    std::vector<int> rankings(route_options.size());
+    std::iota(rankings.begin(), rankings.end(), 0);
     
     return rankings;
 }
@@ -328,11 +326,11 @@ void RouteSelectionModel::train(const std::vector<TrainingSample>& samples) {
     double total_error = 0;
     
     for (const auto& sample : samples) {
-        ModelPrediction pred = scoreRoute(sample.features, {});
-        if (std::abs(pred.prediction - sample.label) < 0.18) {
+        double prediction = score(sample.features);
+        if (std::abs(prediction - sample.label) < 0.18) {
             correct++;
         }
-        total_error += std::abs(pred.prediction - sample.label);
+        total_error += std::abs(prediction - sample.label);
     }
     
     metrics_.accuracy = static_cast<double>(correct) / samples.size();
@@ -461,13 +459,14 @@ void EmergencyProcedureModel::train(const std::vector<TrainingSample>& samples)
     int correct = 0;
     double total_error = 0;
     
+    std::vector<double> anomalies(8);
     for (const auto& sample : samples) {
-        std::vector<double> anomalies(8, sample.label * 0.5);
-        EmergencyAssessment assess = assessEmergency(sample.features, anomalies);
-        if (assess.certainty > 0.5) {
+        std::fill(anomalies.begin(), anomalies.end(), sample.label * 0.5);
+        double certainty = calculateEmergencySeverity(anomalies);
+        if (certainty > 0.5) {
             correct++;
         }
-        total_error += std::abs(assess.certainty - sample.label);
+        total_error += std::abs(certainty - sample.label);
     }
     
     metrics_.accuracy = static_cast<double>(correct) / samples.size();
@@ -510,47 +509,196 @@ double EmergencyProcedureModel::calculateEmergencySeverity(
 
 // ModelManager Implementation
 ModelManager::ModelManager()
-    : runway_model_(std::make_unique<RunwaySelectionModel>()),
-      approach_model_(std::make_unique<ApproachPlanningModel>()),
-      route_model_(std::make_unique<RouteSelectionModel>()),
-      emergency_model_(std::make_unique<EmergencyProcedureModel>()) {}
+    : models_(std::make_shared<ModelSet>()) {}
 
-ModelManager::~ModelManager() {}
+ModelManager::~ModelManager() {
+    stopTraining();
+}
 
 bool ModelManager::initialize() {
     return true;
 }
 
+std::shared_ptr<const ModelManager::ModelSet> ModelManager::getModels() const {
+    return std::atomic_load(&models_);
+}
+
 RunwaySelectionModel& ModelManager::getRunwayModel() {
-    return *runway_model_;
+    return std::atomic_load(&models_)->runway;
 }
 
 const RunwaySelectionModel& ModelManager::getRunwayModel() const {
-    return *runway_model_;
+    return std::atomic_load(&models_)->runway;
 }
 
 ApproachPlanningModel& ModelManager::getApproachModel() {
-    return *approach_model_;
+    return std::atomic_load(&models_)->approach;
 }
 
 const ApproachPlanningModel& ModelManager::getApproachModel() const {
-    return *approach_model_;
+    return std::atomic_load(&models_)->approach;
 }
 
 RouteSelectionModel& ModelManager::getRouteModel() {
-    return *route_model_;
+    return std::atomic_load(&models_)->route;
 }
 
 const RouteSelectionModel& ModelManager::getRouteModel() const {
-    return *route_model_;
+    return std::atomic_load(&models_)->route;
 }
 
 EmergencyProcedureModel& ModelManager::getEmergencyModel() {
-    return *emergency_model_;
+    return std::atomic_load(&models_)->emergency;
 }
 
 const EmergencyProcedureModel& ModelManager::getEmergencyModel() const {
-    return *emergency_model_;
+    return std::atomic_load(&models_)->emergency;
+}
+
+void ModelManager::startTraining() {
+    if (isTraining()) return;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stopping_ = false;
+        running_ = true;
+    }
+    trainer_ = std::thread(&ModelManager::trainerLoop, this);
+}
+
+void ModelManager::stopTraining() {
+    if (!isTraining()) return;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    trainer_.join();
+    
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    running_ = false;
+    queue_.clear();
+    idle_cv_.notify_all();
+}
+
+bool ModelManager::submitTraining(std::vector<TrainingSample> samples) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (queue_.size() >= MAX_PENDING_TRAINING) {
+            training_stats_.dropped++;
+            return false;
+        }
+        queue_.push_back(std::move(samples));
+        training_stats_.submitted++;
+    }
+    work_cv_.notify_one();
+    return true;
+}
+
+void ModelManager::waitTrainingIdle() {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    idle_cv_.wait(lock, [this] { return (queue_.empty() && in_progress_ == 0) || !running_; });
+}
+
+bool ModelManager::rollbackModels() {
+    std::lock_guard<std::mutex> lock(publish_mutex_);
+    if (!previous_) return false;
+    std::shared_ptr<ModelSet> replaced = std::atomic_load(&models_);
+    std::atomic_store(&models_, previous_);
+    previous_ = replaced;       // Keeps references into it valid for one more swap
+    
+    std::lock_guard<std::mutex> stats_lock(queue_mutex_);
+    training_stats_.rollbacks++;
+    return true;
+}
+
+ModelManager::TrainingStats ModelManager::getTrainingStats() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    TrainingStats stats = training_stats_;
+    stats.pending = queue_.size() + in_progress_;
+    return stats;
+}
+
+bool ModelManager::regressed(const ModelMetrics& current, const ModelMetrics& candidate) {
+    return current.samples_tested > 0 &&
+           candidate.accuracy < current.accuracy - REGRESSION_TOLERANCE;
+}
+
+bool ModelManager::trainAndPublish(const std::vector<TrainingSample>& samples) {
+    std::lock_guard<std::mutex> lock(publish_mutex_);
+    std::shared_ptr<ModelSet> current = std::atomic_load(&models_);
+    
+    // Inference keeps reading current while the copy trains
+    auto candidate = std::make_shared<ModelSet>(*current);
+    std::shared_ptr<WorkStealingPool> pool;
+    {
+        std::lock_guard<std::mutex> lock(inference_mutex_);
+        pool = inference_pool_;
+    }
+    if (pool) {
+        // The models are independent; train them side by side
+        pool->submit([&]() { candidate->runway.train(samples); });
+        pool->submit([&]() { candidate->approach.train(samples); });
+        pool->submit([&]() { candidate->route.train(samples); });
+        pool->submit([&]() { candidate->emergency.train(samples); });
+        pool->wait();
+    } else {
+        candidate->runway.train(samples);
+        candidate->approach.train(samples);
+        candidate->route.train(samples);
+        candidate->emergency.train(samples);
+    }
+    
+    bool rejected = regressed(current->runway.getMetrics(), candidate->runway.getMetrics()) ||
+                    regressed(current->approach.getMetrics(), candidate->approach.getMetrics()) ||
+                    regressed(current->route.getMetrics(), candidate->route.getMetrics()) ||
+                    regressed(current->emergency.getMetrics(), candidate->emergency.getMetrics());
+    if (!rejected) {
+        candidate->version = current->version + 1;
+        previous_ = current;
+        std::atomic_store(&models_, candidate);
+    }
+    
+    std::lock_guard<std::mutex> stats_lock(queue_mutex_);
+    if (rejected) {
+        training_stats_.rejected++;
+    } else {
+        training_stats_.published++;
+    }
+    return !rejected;
+}
+
+void ModelManager::trainerLoop() {
+#ifdef _WIN32
+    // Learning yields to the flight loop
+    SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#endif
+    for (;;) {
+        std::vector<TrainingSample> samples;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            work_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_) return;
+            samples = std::move(queue_.front());
+            queue_.pop_front();
+            in_progress_++;
+        }
+        
+        try {
+            trainAndPublish(samples);
+        } catch (const std::exception& e) {
+            std::cerr << "ModelManager: training failed: " << e.what() << std::endl;
+        }
+        
+        bool idle = false;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            in_progress_--;
+            idle = queue_.empty() && in_progress_ == 0;
+        }
+        if (idle) {
+            idle_cv_.notify_all();
+        }
+    }
 }
 
 bool ModelManager::loadModels(const std::string& model_path) {
@@ -562,21 +710,163 @@ bool ModelManager::saveModels(const std::string& model_path) const {
 }
 
 ModelManager::AllMetrics ModelManager::getAllMetrics() const {
+    std::shared_ptr<const ModelSet> models = getModels();
     AllMetrics all_metrics;
-    all_metrics.runway = runway_model_->getMetrics();
-    all_metrics.approach = approach_model_->getMetrics();
-    all_metrics.route = route_model_->getMetrics();
-    all_metrics.emergency = emergency_model_->getMetrics();
+    all_metrics.runway = models->runway.getMetrics();
+    all_metrics.approach = models->approach.getMetrics();
+    all_metrics.route = models->route.getMetrics();
+    all_metrics.emergency = models->emergency.getMetrics();
     return all_metrics;
 }
 
+ModelManager::AllScores ModelManager::scoreAll(
+    const CombinedFeatures& features,
+    double distance_to_runway,
+    double altitude_agl,
+    double descent_rate,
+    const std::vector<double>& anomaly_indicators) const {
+    
+    AllScores scores;
+    scores.runway = RunwaySelectionModel::score(features);
+    scores.approach_safety = ApproachPlanningModel::safetyScore(features, descent_rate);
+    scores.approach_success = ApproachPlanningModel::predictApproachSuccessProbability(
+        features, distance_to_runway);
+    scores.go_around = ApproachPlanningModel::shouldGoAround(features, altitude_agl, descent_rate);
+    scores.route = RouteSelectionModel::score(features);
+    scores.emergency_type = EmergencyProcedureModel::detectEmergencyType(anomaly_indicators);
+    scores.emergency_certainty = EmergencyProcedureModel::calculateEmergencySeverity(anomaly_indicators);
+    return scores;
+}
+
 bool ModelManager::validateModels(const std::vector<TrainingSample>& test_set) {
-    runway_model_->train(test_set);
-    approach_model_->train(test_set);
-    route_model_->train(test_set);
-    emergency_model_->train(test_set);
+    return trainAndPublish(test_set);
+}
+
+bool ModelManager::setBackend(BackendModel model, std::shared_ptr<const InferenceBackend> backend) {
+    if (model >= BACKEND_MODEL_COUNT) {
+        return false;
+    }
+    if (backend && (backend->inputSize() != FeatureLayout::COUNT || backend->outputSize() == 0)) {
+        std::cerr << "ModelManager: Backend " << backend->name() << " takes " << backend->inputSize()
+                  << " inputs, expected " << FeatureLayout::COUNT << std::endl;
+        return false;
+    }
+    std::atomic_store(&backends_[model], std::move(backend));
     return true;
 }
 
+std::string ModelManager::getBackendName(BackendModel model) const {
+    if (model >= BACKEND_MODEL_COUNT) {
+        return "";
+    }
+    std::shared_ptr<const InferenceBackend> backend = std::atomic_load(&backends_[model]);
+    return backend ? backend->name() : "builtin";
+}
+
+void ModelManager::setInferenceConfig(const InferenceConfig& config) {
+    std::lock_guard<std::mutex> lock(inference_mutex_);
+    inference_config_ = config;
+    inference_config_.max_batch_size = std::max<size_t>(1, config.max_batch_size);
+    // Batches in flight keep the old pool alive until they finish
+    inference_pool_ = config.worker_threads > 0
+        ? std::make_shared<WorkStealingPool>(config.worker_threads)
+        : nullptr;
+}
+
+InferenceConfig ModelManager::getInferenceConfig() const {
+    std::lock_guard<std::mutex> lock(inference_mutex_);
+    return inference_config_;
+}
+
+double ModelManager::builtinScore(BackendModel model, const CombinedFeatures& features) {
+    return model == ROUTE_BACKEND ? RouteSelectionModel::score(features)
+                                  : RunwaySelectionModel::score(features);
+}
+
+double ModelManager::builtinConfidence(BackendModel model) {
+    // As scoreRoute() and scoreRunway() report
+    return model == ROUTE_BACKEND ? 0.82 : 0.85;
+}
+
+ModelPrediction ModelManager::predict(BackendModel model, const CombinedFeatures& features) const {
+    std::vector<ModelPrediction> predictions;
+    predictBatch(model, std::vector<CombinedFeatures>{features}, predictions);
+    return predictions.front();
+}
+
+void ModelManager::predictBatch(BackendModel model,
+                                const std::vector<CombinedFeatures>& features,
+                                std::vector<ModelPrediction>& predictions) const {
+    predictions.assign(features.size(), ModelPrediction{});
+    if (features.empty()) {
+        return;
+    }
+
+    std::shared_ptr<const InferenceBackend> backend =
+        model < BACKEND_MODEL_COUNT ? std::atomic_load(&backends_[model]) : nullptr;
+    InferenceConfig config;
+    std::shared_ptr<WorkStealingPool> pool;
+    {
+        std::lock_guard<std::mutex> lock(inference_mutex_);
+        config = inference_config_;
+        pool = inference_pool_;
+    }
+
+    const size_t batch = backend ? config.max_batch_size : features.size();
+    if (!pool || features.size() <= batch) {
+        for (size_t begin = 0; begin < features.size(); begin += batch) {
+            predictRange(model, backend.get(), features, begin,
+                         std::min(features.size(), begin + batch), predictions);
+        }
+        return;
+    }
+
+    // Batches write disjoint ranges of predictions
+    for (size_t begin = 0; begin < features.size(); begin += batch) {
+        size_t end = std::min(features.size(), begin + batch);
+        pool->submit([this, model, &backend, &features, begin, end, &predictions]() {
+            predictRange(model, backend.get(), features, begin, end, predictions);
+        });
+    }
+    pool->wait();
+}
+
+void ModelManager::predictRange(BackendModel model, const InferenceBackend* backend,
+                                const std::vector<CombinedFeatures>& features,
+                                size_t begin, size_t end,
+                                std::vector<ModelPrediction>& predictions) const {
+    const size_t rows = end - begin;
+    bool served = false;
+    if (backend) {
+        std::vector<float> inputs(rows * FeatureLayout::COUNT);
+        std::vector<float> outputs(rows * backend->outputSize());
+        FeatureVector row;
+        for (size_t r = 0; r < rows; ++r) {
+            features[begin + r].flattenInto(row);
+            std::copy(row.begin(), row.end(), inputs.begin() + r * FeatureLayout::COUNT);
+        }
+        served = backend->run(inputs.data(), rows, outputs.data());
+        if (served) {
+            const size_t width = backend->outputSize();
+            for (size_t r = 0; r < rows; ++r) {
+                ModelPrediction& pred = predictions[begin + r];
+                pred.prediction = std::max(0.0, std::min(1.0, double(outputs[r * width])));
+                pred.confidence = width > 1 ? std::max(0.0, std::min(1.0, double(outputs[r * width + 1])))
+                                            : builtinConfidence(model);
+                pred.success = true;
+            }
+        }
+    }
+
+    if (!served) {
+        for (size_t r = begin; r < end; ++r) {
+            ModelPrediction& pred = predictions[r];
+            pred.prediction = builtinScore(model, features[r]);
+            pred.confidence = builtinConfidence(model);
+            pred.success = true;
+        }
+    }
+}
+
 } // namespace ML
 } // namespace AICopilot
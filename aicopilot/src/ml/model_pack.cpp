@@ -0,0 +1,305 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Model Pack Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "model_pack.hpp"
+#include "ml_decision_system.h"
+#include "ml_features.hpp"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AICopilot {
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t checksum(const uint8_t* data, size_t size, uint64_t hash = FNV_OFFSET) {
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+uint64_t hashValue(uint64_t hash, uint64_t value) {
+    return checksum(reinterpret_cast<const uint8_t*>(&value), sizeof(value), hash);
+}
+
+template <typename T>
+void appendSection(std::vector<uint8_t>& image, ModelPackHeader& header, ModelPackSectionId id,
+                   const std::vector<T>& items) {
+    image.resize((image.size() + 7) & ~static_cast<size_t>(7), 0);
+    size_t bytes = items.size() * sizeof(T);
+    header.sections[id].offset = image.size();
+    header.sections[id].size = bytes;
+    if (bytes > 0) {
+        const auto* begin = reinterpret_cast<const uint8_t*>(items.data());
+        image.insert(image.end(), begin, begin + bytes);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// ModelPackBuilder
+// ============================================================================
+
+void ModelPackBuilder::addExample(const double* features, const ModelPackExample& example) {
+    features_.insert(features_.end(), features, features + DecisionFeatureLayout::COUNT);
+    examples_.push_back(example);
+}
+
+void ModelPackBuilder::setLearningState(const ModelPackLearningState& state) {
+    learning_.assign(1, state);
+}
+
+void ModelPackBuilder::setFeatureStats(std::vector<ModelPackFeatureStats> stats) {
+    featureStats_ = std::move(stats);
+}
+
+std::vector<uint8_t> ModelPackBuilder::build() const {
+    ModelPackHeader header{};
+    std::memcpy(header.magic, ModelPack::MAGIC, sizeof(header.magic));
+    header.version = ModelPack::VERSION;
+    header.headerSize = sizeof(ModelPackHeader);
+    header.decisionFeatureCount = static_cast<uint32_t>(DecisionFeatureLayout::COUNT);
+    header.learningFeatureCount = static_cast<uint32_t>(ML::FeatureLayout::COUNT);
+    header.exampleCount = static_cast<uint32_t>(examples_.size());
+    header.schemaHash = ModelPack::schemaHash();
+
+    std::vector<uint8_t> image(sizeof(ModelPackHeader), 0);
+    appendSection(image, header, MODEL_SECTION_DECISION_FEATURES, features_);
+    appendSection(image, header, MODEL_SECTION_DECISION_EXAMPLES, examples_);
+    appendSection(image, header, MODEL_SECTION_LEARNING, learning_);
+    appendSection(image, header, MODEL_SECTION_FEATURE_STATS, featureStats_);
+
+    header.fileSize = image.size();
+    header.checksum = checksum(image.data() + sizeof(ModelPackHeader), image.size() - sizeof(ModelPackHeader));
+    std::memcpy(image.data(), &header, sizeof(header));
+    return image;
+}
+
+bool ModelPackBuilder::write(const std::string& path) const {
+    std::vector<uint8_t> image = build();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "ModelPackBuilder: Cannot write " << path << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    return static_cast<bool>(out);
+}
+
+// ============================================================================
+// ModelPack
+// ============================================================================
+
+ModelPack::~ModelPack() {
+    close();
+}
+
+uint64_t ModelPack::schemaHash() {
+    uint64_t hash = FNV_OFFSET;
+    hash = hashValue(hash, DecisionFeatureLayout::PHASE_COUNT);
+    hash = hashValue(hash, DecisionFeatureLayout::STATE_COUNT);
+    hash = hashValue(hash, ML::FeatureLayout::WEATHER_COUNT);
+    hash = hashValue(hash, ML::FeatureLayout::RUNWAY_COUNT);
+    hash = hashValue(hash, ML::FeatureLayout::TERRAIN_COUNT);
+    hash = hashValue(hash, ML::FeatureLayout::NAVIGATION_COUNT);
+    for (const std::string& name : ML::CombinedFeatures::getFeatureNames()) {
+        hash = checksum(reinterpret_cast<const uint8_t*>(name.data()), name.size() + 1, hash);
+    }
+    return hash;
+}
+
+bool ModelPack::isPackFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {0};
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool ModelPack::open(const std::string& path, bool verifyChecksum) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || static_cast<size_t>(size.QuadPart) < sizeof(ModelPackHeader)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle_ = file;
+    mappingHandle_ = mapping;
+    size_ = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(ModelPackHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // the mapping keeps the file referenced
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+
+    data_ = static_cast<const uint8_t*>(view);
+    if (!validate(verifyChecksum)) {
+        std::cerr << "ModelPack: " << path << " is not a valid model pack for this build" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool ModelPack::openImage(std::vector<uint8_t> image) {
+    close();
+    if (image.size() < sizeof(ModelPackHeader)) {
+        return false;
+    }
+
+    image_ = std::move(image);
+    data_ = image_.data();
+    size_ = image_.size();
+    if (!validate(true)) {
+        std::cerr << "ModelPack: image is not a valid model pack for this build" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool ModelPack::openView(const uint8_t* data, size_t size) {
+    close();
+    if (data == nullptr || size < sizeof(ModelPackHeader)) {
+        return false;
+    }
+
+    data_ = data;
+    size_ = size;
+    borrowed_ = true;
+    if (!validate(true)) {
+        std::cerr << "ModelPack: view is not a valid model pack for this build" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ModelPack::close() {
+    if (data_ != nullptr && image_.empty() && !borrowed_) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(static_cast<HANDLE>(mappingHandle_));
+        CloseHandle(static_cast<HANDLE>(fileHandle_));
+#else
+        munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+    image_.clear();
+    image_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+    borrowed_ = false;
+    fileHandle_ = nullptr;
+    mappingHandle_ = nullptr;
+}
+
+const double* ModelPack::getExampleFeatures(size_t i) const {
+    return section<double>(MODEL_SECTION_DECISION_FEATURES) + i * header().decisionFeatureCount;
+}
+
+bool ModelPack::hasLearningState() const {
+    return isOpen() && header().sections[MODEL_SECTION_LEARNING].size != 0;
+}
+
+const ModelPackLearningState& ModelPack::getLearningState() const {
+    return *section<ModelPackLearningState>(MODEL_SECTION_LEARNING);
+}
+
+size_t ModelPack::getFeatureStatsCount() const {
+    return isOpen() ? header().sections[MODEL_SECTION_FEATURE_STATS].size / sizeof(ModelPackFeatureStats) : 0;
+}
+
+const ModelPackFeatureStats* ModelPack::getFeatureStats() const {
+    return section<ModelPackFeatureStats>(MODEL_SECTION_FEATURE_STATS);
+}
+
+bool ModelPack::validate(bool verifyChecksum) const {
+    const ModelPackHeader& h = header();
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != VERSION) return false;
+    if (h.headerSize != sizeof(ModelPackHeader) || h.fileSize != size_) return false;
+    if (h.schemaHash != schemaHash() || h.decisionFeatureCount != DecisionFeatureLayout::COUNT ||
+        h.learningFeatureCount != ML::FeatureLayout::COUNT) {
+        return false;
+    }
+
+    // The learning sections are either absent or complete
+    const uint64_t learningSize = h.sections[MODEL_SECTION_LEARNING].size;
+    const uint64_t statsSize = h.sections[MODEL_SECTION_FEATURE_STATS].size;
+    const uint64_t expected[MODEL_SECTION_COUNT] = {
+        uint64_t(h.exampleCount) * h.decisionFeatureCount * sizeof(double),
+        uint64_t(h.exampleCount) * sizeof(ModelPackExample),
+        learningSize == 0 ? 0 : sizeof(ModelPackLearningState),
+        statsSize == 0 ? 0 : uint64_t(h.learningFeatureCount) * sizeof(ModelPackFeatureStats),
+    };
+    for (uint32_t id = 0; id < MODEL_SECTION_COUNT; ++id) {
+        const ModelPackSection& s = h.sections[id];
+        if (s.size != expected[id] || s.offset % 8 != 0 || s.offset < sizeof(ModelPackHeader)) return false;
+        if (s.offset > size_ || s.size > size_ - s.offset) return false;
+    }
+
+    if (verifyChecksum &&
+        checksum(data_ + sizeof(ModelPackHeader), size_ - sizeof(ModelPackHeader)) != h.checksum) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace AICopilot
@@ -0,0 +1,215 @@
+/*****************************************************************************
+* Training Pipeline Implementation
+* Copyright 2025 AI Copilot FS Project
+*****************************************************************************/
+
+#include "training_pipeline.hpp"
+#include "binary_log.hpp"
+#include "flight_data_recorder.hpp"
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace AICopilot {
+namespace ML {
+
+namespace {
+
+constexpr double HPA_PER_INHG = 33.8639;
+
+// Columns extractFlight() reads, in the order of ScanColumns
+constexpr FlightDataColumn SCAN_COLUMNS[] = {
+    FDR_FLIGHT_PHASE, FDR_ALTITUDE, FDR_HEADING, FDR_PITCH, FDR_BANK,
+    FDR_INDICATED_AIRSPEED, FDR_TRUE_AIRSPEED, FDR_GROUND_SPEED,
+    FDR_VERTICAL_SPEED, FDR_ALTIMETER, FDR_FLAPS, FDR_ON_GROUND,
+};
+constexpr size_t SCAN_COLUMN_COUNT = sizeof(SCAN_COLUMNS) / sizeof(SCAN_COLUMNS[0]);
+
+enum ScanColumn {
+    SCAN_PHASE = 0, SCAN_ALTITUDE, SCAN_HEADING, SCAN_PITCH, SCAN_BANK,
+    SCAN_IAS, SCAN_TAS, SCAN_GROUND_SPEED, SCAN_VERTICAL_SPEED,
+    SCAN_ALTIMETER, SCAN_FLAPS, SCAN_ON_GROUND,
+};
+
+FlightPhase phaseAt(const std::vector<double>& phases, size_t row) {
+    int index = static_cast<int>(phases[row]);
+    return index >= 0 && index <= static_cast<int>(FlightPhase::UNKNOWN)
+        ? static_cast<FlightPhase>(index) : FlightPhase::UNKNOWN;
+}
+
+// Recorded flight data carries no weather, runway or route columns; those
+// features are derived from what it does carry (the altimeter setting, the
+// wind from the airspeed/groundspeed difference, ISA temperature) or take
+// MLFeatures' neutral values
+CombinedFeatures rowFeatures(MLFeatures& extractor, const std::vector<double>* columns, size_t row) {
+    double altitude = columns[SCAN_ALTITUDE][row];
+    double altimeter = columns[SCAN_ALTIMETER][row];
+    double heading = columns[SCAN_HEADING][row];
+    double tailwind = columns[SCAN_GROUND_SPEED][row] - columns[SCAN_TAS][row];
+    double pressure = altimeter > 0.0 ? altimeter * HPA_PER_INHG : 1013.25;
+    double wind_direction = std::fmod(tailwind > 0.0 ? heading + 180.0 : heading, 360.0);
+    double temperature = 15.0 - 1.98 * altitude / 1000.0;
+    double route_complexity = std::min(10.0, std::abs(columns[SCAN_BANK][row]) / 3.0);
+    return extractor.extractAllFeatures(
+        pressure, std::abs(tailwind), wind_direction, 10000.0, temperature,
+        5000.0, 100.0, 0, true, true,
+        altitude, columns[SCAN_PITCH][row], false, false,
+        route_complexity, 2.0);
+}
+
+AircraftState rowState(const std::vector<double>* columns, size_t row) {
+    AircraftState state{};
+    state.position.altitude = columns[SCAN_ALTITUDE][row];
+    state.heading = columns[SCAN_HEADING][row];
+    state.pitch = columns[SCAN_PITCH][row];
+    state.bank = columns[SCAN_BANK][row];
+    state.indicatedAirspeed = columns[SCAN_IAS][row];
+    state.trueAirspeed = columns[SCAN_TAS][row];
+    state.groundSpeed = columns[SCAN_GROUND_SPEED][row];
+    state.verticalSpeed = columns[SCAN_VERTICAL_SPEED][row];
+    state.altimeter = columns[SCAN_ALTIMETER][row];
+    state.flapsPosition = static_cast<int>(columns[SCAN_FLAPS][row]);
+    state.onGround = columns[SCAN_ON_GROUND][row] != 0.0;
+    return state;
+}
+
+} // namespace
+
+TrainingPipeline::TrainingPipeline(const TrainingPipelineConfig& config)
+    : config_(config) {
+    config_.row_stride = std::max<size_t>(1, config_.row_stride);
+    if (config_.threads == 0) {
+        config_.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    models_.initialize();
+    decisions_.initialize();
+}
+
+bool TrainingPipeline::extractFlight(const FlightDataReader& recording, size_t rowStride, FlightTrainingData& out) {
+    out = FlightTrainingData();
+    std::vector<double> columns[SCAN_COLUMN_COUNT];
+    for (size_t c = 0; c < SCAN_COLUMN_COUNT; ++c) {
+        if (!recording.readColumn(SCAN_COLUMNS[c], columns[c])) return false;
+    }
+    const size_t rows = columns[SCAN_PHASE].size();
+    out.rows = rows;
+    rowStride = std::max<size_t>(1, rowStride);
+
+    MLFeatures extractor;
+    for (size_t begin = 0; begin < rows; begin += rowStride) {
+        size_t end = std::min(rows, begin + rowStride);
+        bool stable = true;
+        for (size_t i = begin; i < end && stable; ++i) {
+            stable = MLLearningSystem::isStableSample(
+                phaseAt(columns[SCAN_PHASE], i), columns[SCAN_BANK][i], columns[SCAN_VERTICAL_SPEED][i]);
+        }
+        TrainingSample sample;
+        sample.features = rowFeatures(extractor, columns, begin);
+        sample.label = stable ? 1.0 : 0.0;
+        sample.weight = static_cast<double>(end - begin) / rowStride;
+        out.samples.push_back(sample);
+    }
+
+    // One decision example per phase segment: continue (0) when it stayed
+    // stable, correct (1) when it did not
+    for (size_t begin = 0; begin < rows;) {
+        size_t end = begin;
+        bool stable = true;
+        FlightPhase phase = phaseAt(columns[SCAN_PHASE], begin);
+        while (end < rows && columns[SCAN_PHASE][end] == columns[SCAN_PHASE][begin]) {
+            stable = stable && MLLearningSystem::isStableSample(
+                phase, columns[SCAN_BANK][end], columns[SCAN_VERTICAL_SPEED][end]);
+            ++end;
+        }
+        TrainingData decision;
+        decision.context.phase = phase;
+        decision.context.state = rowState(columns, begin);
+        decision.context.weather = WeatherConditions{};
+        decision.correctOption = stable ? 0 : 1;
+        decision.reward = stable ? 1.0 : -1.0;
+        out.decisions.push_back(decision);
+        begin = end;
+    }
+    return true;
+}
+
+bool TrainingPipeline::run(const std::vector<std::string>& recordings, ModelPackBuilder& builder) {
+    stats_ = TrainingPipelineStats();
+    stats_.flights = recordings.size();
+
+    // Scan: one job per recording, each writing only its own slot
+    auto scanStart = std::chrono::steady_clock::now();
+    std::vector<FlightTrainingData> flights(recordings.size());
+    std::vector<char> readable(recordings.size(), 0);
+    {
+        WorkStealingPool pool(config_.threads);
+        for (size_t i = 0; i < recordings.size(); ++i) {
+            pool.submit([&, i]() {
+                FlightDataReader reader;
+                readable[i] = reader.open(recordings[i]) &&
+                              extractFlight(reader, config_.row_stride, flights[i]);
+            });
+        }
+        pool.wait();
+    }
+
+    std::vector<TrainingSample> samples;
+    for (size_t i = 0; i < flights.size(); ++i) {
+        if (!readable[i]) {
+            AICOPILOT_LOG_WARNING("Skipping unreadable flight recording {}", recordings[i]);
+            stats_.failed_flights++;
+            continue;
+        }
+        stats_.rows_scanned += flights[i].rows;
+        samples.insert(samples.end(), flights[i].samples.begin(), flights[i].samples.end());
+    }
+    stats_.samples = samples.size();
+    stats_.scan_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - scanStart).count();
+    if (stats_.failed_flights == stats_.flights) return false;
+
+    // Train: the models side by side on the manager's pool, then the
+    // learning statistics and decision examples in input order
+    auto trainStart = std::chrono::steady_clock::now();
+    InferenceConfig inference = models_.getInferenceConfig();
+    inference.worker_threads = std::min<size_t>(config_.threads, 4);
+    models_.setInferenceConfig(inference);
+    stats_.published = !samples.empty() && models_.validateModels(samples);
+    stats_.metrics = models_.getAllMetrics();
+
+    for (const TrainingSample& sample : samples) {
+        LearningOutcome outcome;
+        outcome.features = sample.features;
+        outcome.predicted_score = ApproachPlanningModel::safetyScore(sample.features, 500);
+        outcome.actual_outcome = sample.label;
+        outcome.correct_prediction = (outcome.predicted_score >= 0.5) == (sample.label >= 0.5);
+        outcome.error = std::abs(outcome.predicted_score - sample.label);
+        learning_.updateModelWithFeedback(outcome);
+    }
+    for (size_t i = 0; i < flights.size(); ++i) {
+        if (!readable[i]) continue;
+        for (const TrainingData& decision : flights[i].decisions) {
+            decisions_.trainWithFeedback(decision);
+            stats_.decision_examples++;
+        }
+    }
+    stats_.train_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - trainStart).count();
+
+    decisions_.saveModel(builder);
+    learning_.saveLearningState(builder);
+    return true;
+}
+
+bool TrainingPipeline::run(const std::vector<std::string>& recordings, const std::string& packPath) {
+    ModelPackBuilder builder;
+    if (!run(recordings, builder)) return false;
+    if (!builder.write(packPath)) {
+        AICOPILOT_LOG_ERROR("Cannot write model pack {}", packPath);
+        return false;
+    }
+    return true;
+}
+
+} // namespace ML
+} // namespace AICopilot
@@ -0,0 +1,313 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Airspace Database Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/airspace_database.hpp"
+#include "../include/geodesy.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr double PARALLEL_EPSILON = 1e-18;
+constexpr double INTERVAL_EPSILON = 1e-12;
+constexpr size_t MAX_STACK = 256;
+
+} // namespace
+
+bool AirspaceCostWeights::any() const {
+    return std::any_of(perNM.begin(), perNM.end(), [](double cost) { return cost > 0.0; });
+}
+
+void AirspaceDatabase::Bounds::expand(double latitude, double longitude) {
+    south = std::min(south, latitude);
+    north = std::max(north, latitude);
+    west = std::min(west, longitude);
+    east = std::max(east, longitude);
+}
+
+void AirspaceDatabase::Bounds::expand(const Bounds& other) {
+    south = std::min(south, other.south);
+    north = std::max(north, other.north);
+    west = std::min(west, other.west);
+    east = std::max(east, other.east);
+}
+
+void AirspaceDatabase::clear() {
+    volumes_.clear();
+    entries_.clear();
+    nodes_.clear();
+}
+
+void AirspaceDatabase::prepare(Prepared& prepared) {
+    const std::vector<LatLon>& boundary = prepared.volume.boundary;
+    for (const LatLon& vertex : boundary) {
+        prepared.bounds.expand(vertex.latitude, vertex.longitude);
+    }
+    if (boundary.size() < 3) return;
+
+    for (size_t i = 0; i < boundary.size(); ++i) {
+        const LatLon& a = boundary[i];
+        const LatLon& b = boundary[(i + 1) % boundary.size()];
+        if (a.latitude == b.latitude && a.longitude == b.longitude) continue;
+        Edge edge;
+        edge.aLat = a.latitude;
+        edge.aLon = a.longitude;
+        edge.bLat = b.latitude;
+        edge.bLon = b.longitude;
+        edge.slope = a.latitude != b.latitude ? (b.longitude - a.longitude) / (b.latitude - a.latitude) : 0.0;
+        edge.firstBand = 0;
+        prepared.edges.push_back(edge);
+    }
+
+    size_t bandCount = std::max<size_t>(1, std::min(MAX_BANDS, prepared.edges.size() / EDGES_PER_BAND));
+    double height = prepared.bounds.north - prepared.bounds.south;
+    if (!(height > 0.0)) bandCount = 1;
+    prepared.bandHeight = height / bandCount;
+    prepared.bandStart.assign(bandCount + 1, 0);
+
+    auto bandRange = [&](const Edge& edge, size_t& low, size_t& high) {
+        low = bandOf(prepared, std::min(edge.aLat, edge.bLat));
+        high = bandOf(prepared, std::max(edge.aLat, edge.bLat));
+    };
+
+    // Counting pass, then fill: every band lists the edges whose latitudes reach it
+    for (Edge& edge : prepared.edges) {
+        size_t low, high;
+        bandRange(edge, low, high);
+        edge.firstBand = static_cast<uint32_t>(low);
+        for (size_t band = low; band <= high; ++band) prepared.bandStart[band + 1]++;
+    }
+    for (size_t band = 0; band < bandCount; ++band) {
+        prepared.bandStart[band + 1] += prepared.bandStart[band];
+    }
+    prepared.bandEdges.resize(prepared.bandStart[bandCount]);
+    std::vector<uint32_t> fill(prepared.bandStart.begin(), prepared.bandStart.end() - 1);
+    for (size_t i = 0; i < prepared.edges.size(); ++i) {
+        size_t low, high;
+        bandRange(prepared.edges[i], low, high);
+        for (size_t band = low; band <= high; ++band) {
+            prepared.bandEdges[fill[band]++] = static_cast<uint32_t>(i);
+        }
+    }
+}
+
+void AirspaceDatabase::build(std::vector<AirspaceVolume> volumes) {
+    clear();
+    volumes_.resize(volumes.size());
+    std::vector<uint32_t> ids;
+    for (size_t i = 0; i < volumes.size(); ++i) {
+        volumes_[i].volume = std::move(volumes[i]);
+        prepare(volumes_[i]);
+        if (!volumes_[i].edges.empty()) ids.push_back(static_cast<uint32_t>(i));
+    }
+    if (ids.empty()) return;
+
+    // Sort-tile-recursive: vertical slices by longitude, then leaves by latitude
+    auto centerLat = [this](uint32_t id) { return volumes_[id].bounds.south + volumes_[id].bounds.north; };
+    auto centerLon = [this](uint32_t id) { return volumes_[id].bounds.west + volumes_[id].bounds.east; };
+    std::sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) { return centerLon(a) < centerLon(b); });
+    size_t leafCount = (ids.size() + NODE_SIZE - 1) / NODE_SIZE;
+    size_t slices = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(leafCount))));
+    size_t sliceSize = slices * NODE_SIZE;
+    for (size_t begin = 0; begin < ids.size(); begin += sliceSize) {
+        auto end = ids.begin() + std::min(ids.size(), begin + sliceSize);
+        std::sort(ids.begin() + begin, end, [&](uint32_t a, uint32_t b) { return centerLat(a) < centerLat(b); });
+    }
+    entries_ = ids;
+
+    for (size_t first = 0; first < entries_.size(); first += NODE_SIZE) {
+        Node node{};
+        node.first = static_cast<uint32_t>(first);
+        node.count = static_cast<uint32_t>(std::min(NODE_SIZE, entries_.size() - first));
+        node.leaf = true;
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            node.bounds.expand(volumes_[entries_[i]].bounds);
+        }
+        nodes_.push_back(node);
+    }
+
+    // Consecutive nodes of a level are already close together; group them up to one root
+    size_t levelBegin = 0;
+    while (nodes_.size() - levelBegin > 1) {
+        size_t levelEnd = nodes_.size();
+        for (size_t first = levelBegin; first < levelEnd; first += NODE_SIZE) {
+            Node node{};
+            node.first = static_cast<uint32_t>(first);
+            node.count = static_cast<uint32_t>(std::min(NODE_SIZE, levelEnd - first));
+            node.leaf = false;
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                node.bounds.expand(nodes_[i].bounds);
+            }
+            nodes_.push_back(node);
+        }
+        levelBegin = levelEnd;
+    }
+}
+
+template <typename Fn>
+void AirspaceDatabase::forEachCandidate(const Bounds& box, Fn&& fn) const {
+    if (nodes_.empty()) return;
+    uint32_t stack[MAX_STACK];
+    size_t top = 0;
+    stack[top++] = static_cast<uint32_t>(nodes_.size() - 1);
+    while (top > 0) {
+        const Node& node = nodes_[stack[--top]];
+        if (!node.bounds.overlaps(box)) continue;
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            if (node.leaf) {
+                if (volumes_[entries_[i]].bounds.overlaps(box)) fn(entries_[i]);
+            } else if (top < MAX_STACK) {
+                stack[top++] = i;
+            }
+        }
+    }
+}
+
+uint32_t AirspaceDatabase::bandOf(const Prepared& prepared, double latitude) {
+    size_t bandCount = prepared.bandStart.size() - 1;
+    if (bandCount <= 1) return 0;
+    double index = std::floor((latitude - prepared.bounds.south) / prepared.bandHeight);
+    return static_cast<uint32_t>(std::max(0.0, std::min(index, static_cast<double>(bandCount - 1))));
+}
+
+bool AirspaceDatabase::containsPrepared(const Prepared& prepared, double latitude, double longitude) const {
+    if (prepared.edges.empty() || latitude < prepared.bounds.south || latitude > prepared.bounds.north ||
+        longitude < prepared.bounds.west || longitude > prepared.bounds.east) {
+        return false;
+    }
+    // Cast east; an edge crossing this latitude always lists the point's band
+    uint32_t band = bandOf(prepared, latitude);
+    bool inside = false;
+    for (uint32_t i = prepared.bandStart[band]; i < prepared.bandStart[band + 1]; ++i) {
+        const Edge& edge = prepared.edges[prepared.bandEdges[i]];
+        if ((edge.aLat <= latitude) != (edge.bLat <= latitude) &&
+            longitude < edge.aLon + (latitude - edge.aLat) * edge.slope) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+bool AirspaceDatabase::contains(uint32_t id, double latitude, double longitude) const {
+    return id < volumes_.size() && containsPrepared(volumes_[id], latitude, longitude);
+}
+
+bool AirspaceDatabase::crossVolume(const Prepared& prepared, const Position& from, const Position& to,
+                                   AirspaceCrossing& crossing) const {
+    const double dLat = to.latitude - from.latitude;
+    const double dLon = to.longitude - from.longitude;
+    if (dLat == 0.0 && dLon == 0.0) {
+        crossing.entry = crossing.exit = 0.0;
+        crossing.insideNM = 0.0;
+        return containsPrepared(prepared, from.latitude, from.longitude);
+    }
+
+    // Fractions where the segment meets an edge, from the bands it spans;
+    // an edge in several of them is taken in the first
+    thread_local std::vector<double> cuts;
+    cuts.clear();
+    cuts.push_back(0.0);
+    cuts.push_back(1.0);
+    uint32_t low = bandOf(prepared, std::min(from.latitude, to.latitude));
+    uint32_t high = bandOf(prepared, std::max(from.latitude, to.latitude));
+    for (uint32_t band = low; band <= high; ++band) {
+        for (uint32_t i = prepared.bandStart[band]; i < prepared.bandStart[band + 1]; ++i) {
+            const Edge& edge = prepared.edges[prepared.bandEdges[i]];
+            if (std::max(edge.firstBand, low) != band) continue;
+            double eLat = edge.bLat - edge.aLat;
+            double eLon = edge.bLon - edge.aLon;
+            double denominator = dLat * eLon - dLon * eLat;
+            if (std::fabs(denominator) < PARALLEL_EPSILON) continue;
+            double offLat = edge.aLat - from.latitude;
+            double offLon = edge.aLon - from.longitude;
+            double t = (offLat * eLon - offLon * eLat) / denominator;
+            double u = (offLat * dLon - offLon * dLat) / denominator;
+            if (t > 0.0 && t < 1.0 && u >= 0.0 && u <= 1.0) cuts.push_back(t);
+        }
+    }
+    std::sort(cuts.begin(), cuts.end());
+
+    // Each piece between cuts is wholly inside or outside; its midpoint says which
+    double inside = 0.0;
+    bool any = false;
+    for (size_t k = 0; k + 1 < cuts.size(); ++k) {
+        double t0 = cuts[k];
+        double t1 = cuts[k + 1];
+        if (t1 - t0 < INTERVAL_EPSILON) continue;
+        double mid = 0.5 * (t0 + t1);
+        if (!containsPrepared(prepared, from.latitude + dLat * mid, from.longitude + dLon * mid)) continue;
+        if (!any) crossing.entry = t0;
+        crossing.exit = t1;
+        inside += t1 - t0;
+        any = true;
+    }
+    crossing.insideNM = inside * Geodesy::flatDistanceNM(from.latitude, from.longitude, to.latitude, to.longitude);
+    return any;
+}
+
+void AirspaceDatabase::findContaining(double latitude, double longitude, double altitudeFt,
+                                      std::vector<uint32_t>& out) const {
+    out.clear();
+    Bounds box;
+    box.expand(latitude, longitude);
+    forEachCandidate(box, [&](uint32_t id) {
+        const Prepared& prepared = volumes_[id];
+        if (altitudeFt >= prepared.volume.floorFt && altitudeFt <= prepared.volume.ceilingFt &&
+            containsPrepared(prepared, latitude, longitude)) {
+            out.push_back(id);
+        }
+    });
+    std::sort(out.begin(), out.end());
+}
+
+void AirspaceDatabase::querySegment(const Position& from, const Position& to, double altitudeFt,
+                                    std::vector<AirspaceCrossing>& out) const {
+    out.clear();
+    Bounds box;
+    box.expand(from.latitude, from.longitude);
+    box.expand(to.latitude, to.longitude);
+    forEachCandidate(box, [&](uint32_t id) {
+        const Prepared& prepared = volumes_[id];
+        if (altitudeFt < prepared.volume.floorFt || altitudeFt > prepared.volume.ceilingFt) return;
+        AirspaceCrossing crossing{id, 0.0, 0.0, 0.0};
+        if (crossVolume(prepared, from, to, crossing)) out.push_back(crossing);
+    });
+    std::sort(out.begin(), out.end(), [](const AirspaceCrossing& a, const AirspaceCrossing& b) {
+        return a.id < b.id;
+    });
+}
+
+double AirspaceDatabase::segmentCost(const Position& from, const Position& to, double altitudeFt,
+                                     const AirspaceCostWeights& weights) const {
+    if (nodes_.empty()) return 0.0;
+    Bounds box;
+    box.expand(from.latitude, from.longitude);
+    box.expand(to.latitude, to.longitude);
+    double cost = 0.0;
+    forEachCandidate(box, [&](uint32_t id) {
+        const Prepared& prepared = volumes_[id];
+        double weight = weights.get(prepared.volume.type);
+        if (!(weight > 0.0) || std::isinf(cost)) return;
+        if (altitudeFt < prepared.volume.floorFt || altitudeFt > prepared.volume.ceilingFt) return;
+        AirspaceCrossing crossing{id, 0.0, 0.0, 0.0};
+        if (!crossVolume(prepared, from, to, crossing)) return;
+        if (std::isinf(weight)) {
+            cost = std::numeric_limits<double>::infinity();
+        } else {
+            cost += weight * crossing.insideNM;
+        }
+    });
+    return cost;
+}
+
+} // namespace AICopilot
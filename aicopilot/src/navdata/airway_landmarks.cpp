@@ -0,0 +1,248 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Airway Landmarks Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/airway_landmarks.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <queue>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr float UNREACHABLE = std::numeric_limits<float>::infinity();
+
+uint64_t checksum(const uint8_t* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+template <typename T>
+void append(std::vector<uint8_t>& out, const T* values, size_t count) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values);
+    out.insert(out.end(), bytes, bytes + count * sizeof(T));
+}
+
+bool validAt(const NavdataPackAirway& airway, int altitude) {
+    return altitude >= airway.minimumAltitude && altitude <= airway.maximumAltitude;
+}
+
+// Exact airway distances from one node over the airways valid at an altitude
+void dijkstra(const NavdataPack& pack, int altitude, uint32_t source, std::vector<double>& dist) {
+    dist.assign(pack.getWaypointCount(), std::numeric_limits<double>::infinity());
+    using Item = std::pair<double, uint32_t>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+    dist[source] = 0.0;
+    queue.push({0.0, source});
+    while (!queue.empty()) {
+        auto [d, node] = queue.top();
+        queue.pop();
+        if (d > dist[node]) continue;
+        for (const NavdataPackEdge* edge = pack.edgesBegin(node); edge != pack.edgesEnd(node); ++edge) {
+            if (!validAt(pack.getAirwayRecord(edge->airway), altitude)) continue;
+            double next = d + edge->distanceNM;
+            if (next < dist[edge->to]) {
+                dist[edge->to] = next;
+                queue.push({next, edge->to});
+            }
+        }
+    }
+}
+
+} // namespace
+
+bool AirwayLandmarks::build(const NavdataPack& pack, const std::vector<int>& altitudes,
+                            size_t landmarkCount) {
+    bands_.clear();
+    packChecksum_ = pack.getChecksum();
+    waypointCount_ = static_cast<uint32_t>(pack.getWaypointCount());
+    landmarkCount_ = std::min(std::max<size_t>(landmarkCount, 1), MAX_LANDMARK_COUNT);
+
+    for (int altitude : altitudes) {
+        if (findBand(altitude)) continue;
+
+        // Widen to every altitude where the same airways are valid
+        Band band;
+        band.lowAltitude = std::numeric_limits<int32_t>::min();
+        band.highAltitude = std::numeric_limits<int32_t>::max();
+        for (uint32_t i = 0; i < pack.getAirwayCount(); ++i) {
+            const NavdataPackAirway& airway = pack.getAirwayRecord(i);
+            if (airway.minimumAltitude <= altitude) {
+                band.lowAltitude = std::max(band.lowAltitude, airway.minimumAltitude);
+            } else {
+                band.highAltitude = std::min(band.highAltitude, airway.minimumAltitude - 1);
+            }
+            if (airway.maximumAltitude >= altitude) {
+                band.highAltitude = std::min(band.highAltitude, airway.maximumAltitude);
+            } else {
+                band.lowAltitude = std::max(band.lowAltitude, airway.maximumAltitude + 1);
+            }
+        }
+
+        buildBand(pack, band);
+        if (!band.landmarks.empty()) {
+            bands_.push_back(std::move(band));
+        }
+    }
+    return !bands_.empty();
+}
+
+void AirwayLandmarks::buildBand(const NavdataPack& pack, Band& band) const {
+    const int altitude = band.lowAltitude;
+    const size_t nodeCount = pack.getWaypointCount();
+
+    std::vector<uint32_t> candidates;
+    for (uint32_t node = 0; node < nodeCount; ++node) {
+        for (const NavdataPackEdge* edge = pack.edgesBegin(node); edge != pack.edgesEnd(node); ++edge) {
+            if (validAt(pack.getAirwayRecord(edge->airway), altitude)) {
+                candidates.push_back(node);
+                break;
+            }
+        }
+    }
+    if (candidates.empty()) return;
+
+    // Farthest-point selection: each landmark is the fix farthest from those
+    // already chosen, which spreads them to the edges of the network; fixes
+    // no landmark reaches count as farthest, so every component gets one
+    std::vector<double> dist;
+    std::vector<double> nearest(nodeCount, std::numeric_limits<double>::infinity());
+    dijkstra(pack, altitude, candidates.front(), dist);
+    uint32_t next = candidates.front();
+    for (uint32_t node : candidates) {
+        if (dist[node] != std::numeric_limits<double>::infinity() && dist[node] > dist[next]) next = node;
+    }
+
+    band.distances.assign(nodeCount * landmarkCount_, UNREACHABLE);
+    while (band.landmarks.size() < landmarkCount_) {
+        const size_t column = band.landmarks.size();
+        band.landmarks.push_back(next);
+        dijkstra(pack, altitude, next, dist);
+        for (size_t node = 0; node < nodeCount; ++node) {
+            band.distances[node * landmarkCount_ + column] = static_cast<float>(dist[node]);
+            nearest[node] = std::min(nearest[node], dist[node]);
+        }
+
+        // With fewer fixes than landmarks this repeats one, which is harmless
+        double farthest = -1.0;
+        for (uint32_t node : candidates) {
+            if (nearest[node] > farthest) {
+                farthest = nearest[node];
+                next = node;
+            }
+        }
+    }
+}
+
+bool AirwayLandmarks::save(const std::string& path) const {
+    AirwayLandmarksHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.landmarkCount = static_cast<uint16_t>(landmarkCount_);
+    header.bandCount = static_cast<uint32_t>(bands_.size());
+    header.waypointCount = waypointCount_;
+    header.packChecksum = packChecksum_;
+
+    std::vector<uint8_t> image;
+    append(image, &header, 1);
+    for (const auto& band : bands_) {
+        append(image, &band.lowAltitude, 1);
+        append(image, &band.highAltitude, 1);
+        append(image, band.landmarks.data(), band.landmarks.size());
+        append(image, band.distances.data(), band.distances.size());
+    }
+    uint64_t sum = checksum(image.data(), image.size());
+    append(image, &sum, 1);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "AirwayLandmarks: Cannot write " << path << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    return static_cast<bool>(out);
+}
+
+bool AirwayLandmarks::load(const std::string& path, const NavdataPack& pack) {
+    bands_.clear();
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+    std::vector<uint8_t> image((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    AirwayLandmarksHeader header;
+    if (image.size() < sizeof(header) + sizeof(uint64_t)) return false;
+    std::memcpy(&header, image.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.landmarkCount == 0 || header.landmarkCount > MAX_LANDMARK_COUNT) {
+        return false;
+    }
+    if (header.packChecksum != pack.getChecksum() || header.waypointCount != pack.getWaypointCount()) {
+        std::cerr << "AirwayLandmarks: " << path << " was built for a different navdata pack" << std::endl;
+        return false;
+    }
+
+    const size_t landmarkCount = header.landmarkCount;
+    const size_t bandSize = 2 * sizeof(int32_t) + landmarkCount * sizeof(uint32_t) +
+                            size_t(header.waypointCount) * landmarkCount * sizeof(float);
+    if (image.size() != sizeof(header) + header.bandCount * bandSize + sizeof(uint64_t)) return false;
+
+    uint64_t sum;
+    std::memcpy(&sum, image.data() + image.size() - sizeof(sum), sizeof(sum));
+    if (checksum(image.data(), image.size() - sizeof(sum)) != sum) {
+        std::cerr << "AirwayLandmarks: Checksum mismatch in " << path << std::endl;
+        return false;
+    }
+
+    const uint8_t* cursor = image.data() + sizeof(header);
+    auto read = [&](void* target, size_t bytes) {
+        std::memcpy(target, cursor, bytes);
+        cursor += bytes;
+    };
+    std::vector<Band> bands(header.bandCount);
+    for (auto& band : bands) {
+        read(&band.lowAltitude, sizeof(band.lowAltitude));
+        read(&band.highAltitude, sizeof(band.highAltitude));
+        band.landmarks.resize(landmarkCount);
+        read(band.landmarks.data(), landmarkCount * sizeof(uint32_t));
+        band.distances.resize(size_t(header.waypointCount) * landmarkCount);
+        read(band.distances.data(), band.distances.size() * sizeof(float));
+        for (uint32_t landmark : band.landmarks) {
+            if (landmark >= header.waypointCount) return false;
+        }
+    }
+
+    bands_ = std::move(bands);
+    packChecksum_ = header.packChecksum;
+    waypointCount_ = header.waypointCount;
+    landmarkCount_ = landmarkCount;
+    return true;
+}
+
+bool AirwayLandmarks::matches(const NavdataPack& pack) const {
+    return !bands_.empty() && packChecksum_ == pack.getChecksum() && waypointCount_ == pack.getWaypointCount();
+}
+
+const AirwayLandmarks::Band* AirwayLandmarks::findBand(int altitude) const {
+    for (const auto& band : bands_) {
+        if (altitude >= band.lowAltitude && altitude <= band.highAltitude) return &band;
+    }
+    return nullptr;
+}
+
+} // namespace AICopilot
@@ -0,0 +1,418 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Airway Search Implementation
+*****************************************************************************/
+
+#include "../include/airway_search.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+constexpr double EARTH_RADIUS_NM = 3440.065;
+constexpr double COST_EPSILON = 1e-9;
+constexpr double INFINITE_COST = std::numeric_limits<double>::infinity();
+constexpr double PENALTY_FACTOR = 1.4;        // per reuse of a leg, alternatives only
+constexpr size_t MAX_ATTEMPTS_PER_ROUTE = 4;  // searches per requested alternative
+
+// Same haversine as the pack's leg distances, so the heuristic stays below them
+double greatCircleNM(double lat1, double lon1, double cosLat1, double lat2, double lon2, double cosLat2) {
+    double dLat = (lat2 - lat1) * DEG_TO_RAD;
+    double dLon = (lon2 - lon1) * DEG_TO_RAD;
+    double h = std::sin(dLat / 2.0) * std::sin(dLat / 2.0) +
+               cosLat1 * cosLat2 * std::sin(dLon / 2.0) * std::sin(dLon / 2.0);
+    return EARTH_RADIUS_NM * 2.0 * std::atan2(std::sqrt(h), std::sqrt(1.0 - h));
+}
+
+bool validAt(const NavdataPackAirway& airway, int altitude) {
+    return altitude >= airway.minimumAltitude && altitude <= airway.maximumAltitude;
+}
+
+} // namespace
+
+// ============================================================================
+// WORKSPACE
+// ============================================================================
+
+AirwaySearchWorkspace& AirwaySearchWorkspace::forThisThread() {
+    static thread_local AirwaySearchWorkspace workspace;
+    return workspace;
+}
+
+void AirwaySearchWorkspace::begin(size_t nodeCount) {
+    if (nodes_.size() < nodeCount) {
+        nodes_.resize(nodeCount);
+    }
+    heap_.clear();
+    if (++generation_ == 0) {
+        // Stamps wrapped; forget every record once
+        for (auto& node : nodes_) {
+            node.stamp = 0;
+            node.exitStamp = 0;
+        }
+        generation_ = 1;
+    }
+}
+
+AirwaySearchWorkspace::NodeState& AirwaySearchWorkspace::touch(uint32_t node) {
+    NodeState& state = nodes_[node];
+    if (state.stamp != generation_) {
+        state.stamp = generation_;
+        state.heapPosition = NOT_QUEUED;
+        state.parent = NavdataPack::NO_INDEX;
+        state.airway = NavdataPack::NO_INDEX;
+        state.g = INFINITE_COST;
+        state.legNM = 0.0;
+    }
+    return state;
+}
+
+void AirwaySearchWorkspace::push(uint32_t node, double f) {
+    heap_.push_back({f, node});
+    nodes_[node].heapPosition = static_cast<uint32_t>(heap_.size() - 1);
+    siftUp(heap_.size() - 1);
+}
+
+void AirwaySearchWorkspace::decrease(uint32_t node, double f) {
+    uint32_t position = nodes_[node].heapPosition;
+    heap_[position].f = f;
+    siftUp(position);
+}
+
+uint32_t AirwaySearchWorkspace::pop() {
+    uint32_t top = heap_.front().node;
+    nodes_[top].heapPosition = NOT_QUEUED;
+    HeapEntry last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+        heap_.front() = last;
+        nodes_[last.node].heapPosition = 0;
+        siftDown(0);
+    }
+    return top;
+}
+
+void AirwaySearchWorkspace::siftUp(size_t position) {
+    HeapEntry entry = heap_[position];
+    while (position > 0) {
+        size_t parent = (position - 1) / 4;
+        if (heap_[parent].f <= entry.f) break;
+        heap_[position] = heap_[parent];
+        nodes_[heap_[position].node].heapPosition = static_cast<uint32_t>(position);
+        position = parent;
+    }
+    heap_[position] = entry;
+    nodes_[entry.node].heapPosition = static_cast<uint32_t>(position);
+}
+
+void AirwaySearchWorkspace::siftDown(size_t position) {
+    HeapEntry entry = heap_[position];
+    const size_t size = heap_.size();
+    while (true) {
+        size_t first = position * 4 + 1;
+        if (first >= size) break;
+        size_t best = first;
+        size_t last = std::min(first + 4, size);
+        for (size_t child = first + 1; child < last; ++child) {
+            if (heap_[child].f < heap_[best].f) best = child;
+        }
+        if (heap_[best].f >= entry.f) break;
+        heap_[position] = heap_[best];
+        nodes_[heap_[position].node].heapPosition = static_cast<uint32_t>(position);
+        position = best;
+    }
+    heap_[position] = entry;
+    nodes_[entry.node].heapPosition = static_cast<uint32_t>(position);
+}
+
+// ============================================================================
+// SEARCH
+// ============================================================================
+
+double AirwaySearch::distanceNM(const NavdataPack& pack, uint32_t from, uint32_t to) {
+    const NavdataPackWaypoint& a = pack.getWaypointRecord(from);
+    const NavdataPackWaypoint& b = pack.getWaypointRecord(to);
+    return greatCircleNM(a.latitude(), a.longitude(), std::cos(a.latitude() * DEG_TO_RAD),
+                         b.latitude(), b.longitude(), std::cos(b.latitude() * DEG_TO_RAD));
+}
+
+bool AirwaySearch::findPath(const NavdataPack& pack, const AirwaySearchRequest& request,
+                            std::vector<AirwayPathStep>& path, AirwaySearchWorkspace& workspace) {
+    return search(pack, request, path, workspace, false);
+}
+
+bool AirwaySearch::search(const NavdataPack& pack, const AirwaySearchRequest& request,
+                          std::vector<AirwayPathStep>& path, AirwaySearchWorkspace& workspace,
+                          bool penalized) {
+    path.clear();
+    const size_t nodeCount = pack.getWaypointCount();
+    const uint32_t origin = request.origin;
+    const uint32_t destination = request.destination;
+    if (origin >= nodeCount || destination >= nodeCount) {
+        return false;
+    }
+    if (origin == destination) {
+        path.push_back({origin, NavdataPack::NO_INDEX, 0.0});
+        return true;
+    }
+
+    using NodeState = AirwaySearchWorkspace::NodeState;
+    workspace.begin(nodeCount);
+    const uint32_t generation = workspace.generation_;
+    const double penalty = std::max(1.0, request.directPenalty);
+
+    for (const auto& exit : request.exits) {
+        if (exit.node >= nodeCount) continue;
+        NodeState& state = workspace.touch(exit.node);
+        if (state.exitStamp != generation || exit.distanceNM < state.exitNM) {
+            state.exitStamp = generation;
+            state.exitNM = exit.distanceNM;
+        }
+    }
+
+    // ALT bound. The search ends at a target t: the destination itself if it
+    // is on the band's network, or an exit fix plus its leg cost c(t). For a
+    // landmark L, every path from v to a target costs at least
+    //   max(low(L) - d(L,v), d(L,v) - high(L))
+    // with low(L) = min over t of d(L,t) + c(t), high(L) = max of d(L,t) - c(t).
+    // Distances are stored as float; the rounding is far below a metre.
+    const AirwayLandmarks::Band* band = nullptr;
+    size_t landmarkCount = 0;
+    if (request.landmarks && request.directRadiusNM <= 0.0 && request.landmarks->matches(pack)) {
+        band = request.landmarks->findBand(request.cruiseAltitude);
+    }
+    if (band) {
+        landmarkCount = request.landmarks->getLandmarkCount();
+        workspace.landmarkLow_.assign(landmarkCount, INFINITE_COST);
+        workspace.landmarkHigh_.assign(landmarkCount, -INFINITE_COST);
+        bool anyTarget = false;
+        auto addTarget = [&](uint32_t node, double cost) {
+            const float* row = &band->distances[size_t(node) * landmarkCount];
+            for (size_t l = 0; l < landmarkCount; ++l) {
+                workspace.landmarkLow_[l] = std::min(workspace.landmarkLow_[l], row[l] + cost);
+                workspace.landmarkHigh_[l] = std::max(workspace.landmarkHigh_[l], row[l] - cost);
+            }
+            anyTarget = true;
+        };
+        for (const NavdataPackEdge* edge = pack.edgesBegin(destination); edge != pack.edgesEnd(destination); ++edge) {
+            if (validAt(pack.getAirwayRecord(edge->airway), request.cruiseAltitude)) {
+                addTarget(destination, 0.0);
+                break;
+            }
+        }
+        for (const auto& exit : request.exits) {
+            if (exit.node < nodeCount) addTarget(exit.node, exit.distanceNM * penalty);
+        }
+        if (!anyTarget) band = nullptr;
+    }
+
+    const NavdataPackWaypoint& goal = pack.getWaypointRecord(destination);
+    const double goalCosLat = std::cos(goal.latitude() * DEG_TO_RAD);
+    auto heuristic = [&](uint32_t node) {
+        const NavdataPackWaypoint& record = pack.getWaypointRecord(node);
+        double h = greatCircleNM(record.latitude(), record.longitude(), std::cos(record.latitude() * DEG_TO_RAD),
+                                 goal.latitude(), goal.longitude(), goalCosLat);
+        if (!band || node == destination) return h;
+        const float* row = &band->distances[size_t(node) * landmarkCount];
+        for (size_t l = 0; l < landmarkCount; ++l) {
+            double d = row[l];
+            if (d == INFINITE_COST) {
+                // Every target is in L's component and v is not
+                if (workspace.landmarkHigh_[l] != INFINITE_COST) return INFINITE_COST;
+                continue;
+            }
+            h = std::max(h, workspace.landmarkLow_[l] - d);
+            if (workspace.landmarkHigh_[l] != INFINITE_COST) h = std::max(h, d - workspace.landmarkHigh_[l]);
+        }
+        return h;
+    };
+
+    // A popped node may be reopened if a cheaper path appears later, so
+    // rounding in the heuristic can never cost optimality
+    const bool airspaceCosts = request.airspace && !request.airspace->empty() && request.airspaceWeights.any();
+    auto relax = [&](const NodeState& from, uint32_t fromNode, uint32_t to,
+                     uint32_t airway, double legNM, double cost) {
+        NodeState& next = workspace.touch(to);
+        double g = from.g + cost;
+        if (g + COST_EPSILON >= next.g) return;
+        if (airspaceCosts) {
+            // Only after the cheap test: airspace can only make the leg dearer
+            const NavdataPackWaypoint& a = pack.getWaypointRecord(fromNode);
+            const NavdataPackWaypoint& b = pack.getWaypointRecord(to);
+            g += request.airspace->segmentCost(Position{a.latitude(), a.longitude(), 0.0, 0.0},
+                                               Position{b.latitude(), b.longitude(), 0.0, 0.0},
+                                               request.cruiseAltitude, request.airspaceWeights);
+            if (g + COST_EPSILON >= next.g) return;
+        }
+        double h = heuristic(to);
+        if (h == INFINITE_COST) return;  // cannot reach the destination
+        next.g = g;
+        next.parent = fromNode;
+        next.airway = airway;
+        next.legNM = legNM;
+        double f = g + h;
+        if (next.heapPosition == AirwaySearchWorkspace::NOT_QUEUED) {
+            workspace.push(to, f);
+        } else {
+            workspace.decrease(to, f);
+        }
+    };
+
+    // Penalties only raise costs, so both bounds above stay admissible
+    const NavdataPackEdge* edgeBase = pack.edgesBegin(0);
+
+    NodeState& start = workspace.touch(origin);
+    start.g = 0.0;
+    workspace.push(origin, heuristic(origin));
+
+    bool found = false;
+    while (!workspace.heap_.empty()) {
+        uint32_t node = workspace.pop();
+        if (node == destination) {
+            found = true;
+            break;
+        }
+        const NodeState& current = workspace.nodes_[node];
+
+        if (node == origin) {
+            for (const auto& entry : request.entries) {
+                if (entry.node >= nodeCount) continue;
+                relax(current, node, entry.node, NavdataPack::NO_INDEX,
+                      entry.distanceNM, entry.distanceNM * penalty);
+            }
+        }
+
+        for (const NavdataPackEdge* edge = pack.edgesBegin(node); edge != pack.edgesEnd(node); ++edge) {
+            if (!validAt(pack.getAirwayRecord(edge->airway), request.cruiseAltitude)) continue;
+            double cost = edge->distanceNM;
+            if (penalized) cost *= workspace.edgePenalty_[edge - edgeBase];
+            relax(current, node, edge->to, edge->airway, edge->distanceNM, cost);
+        }
+
+        if (request.directRadiusNM > 0.0) {
+            const NavdataPackWaypoint& record = pack.getWaypointRecord(node);
+            workspace.nearby_.clear();
+            pack.getSpatialIndex().queryRadius(record.latitude(), record.longitude(),
+                                               request.directRadiusNM, workspace.nearby_);
+            for (const auto& match : workspace.nearby_) {
+                if (match.id == node || !pack.getWaypointRecord(match.id).usable()) continue;
+                relax(current, node, match.id, NavdataPack::NO_INDEX,
+                      match.distanceNM, match.distanceNM * penalty);
+            }
+        }
+
+        if (current.exitStamp == generation) {
+            relax(current, node, destination, NavdataPack::NO_INDEX,
+                  current.exitNM, current.exitNM * penalty);
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    for (uint32_t node = destination; node != NavdataPack::NO_INDEX; node = workspace.nodes_[node].parent) {
+        const NodeState& state = workspace.nodes_[node];
+        path.push_back({node, state.airway, state.legNM});
+    }
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+size_t AirwaySearch::findAlternatives(const NavdataPack& pack, const AirwaySearchRequest& request,
+                                      size_t count, double minDissimilarity,
+                                      std::vector<std::vector<AirwayPathStep>>& paths,
+                                      AirwaySearchWorkspace& workspace) {
+    paths.clear();
+    const size_t nodeCount = pack.getWaypointCount();
+    if (count == 0 || nodeCount == 0) {
+        return 0;
+    }
+    const NavdataPackEdge* edgeBase = pack.edgesBegin(0);
+    const size_t edgeCount = static_cast<size_t>(pack.edgesEnd(static_cast<uint32_t>(nodeCount - 1)) - edgeBase);
+    if (workspace.edgePenalty_.size() < edgeCount) {
+        workspace.edgePenalty_.resize(edgeCount, 1.0f);
+    }
+
+    // Legs as undirected node pairs, and their lengths
+    auto legKey = [](uint32_t a, uint32_t b) {
+        return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+    };
+    std::vector<std::vector<uint64_t>> keptLegs;
+
+    // Each route found makes its legs PENALTY_FACTOR times dearer, in both
+    // directions; a repeat is penalized again until the search moves away
+    auto penalize = [&](const std::vector<AirwayPathStep>& route) {
+        bool any = false;
+        for (size_t i = 1; i < route.size(); ++i) {
+            if (route[i].airway == NavdataPack::NO_INDEX) continue;
+            const uint32_t from = route[i - 1].node;
+            const uint32_t to = route[i].node;
+            for (uint32_t node : {from, to}) {
+                const uint32_t other = node == from ? to : from;
+                for (const NavdataPackEdge* edge = pack.edgesBegin(node); edge != pack.edgesEnd(node); ++edge) {
+                    if (edge->to != other || edge->airway != route[i].airway) continue;
+                    float& penalty = workspace.edgePenalty_[edge - edgeBase];
+                    if (penalty == 1.0f) workspace.penalizedEdges_.push_back(static_cast<uint32_t>(edge - edgeBase));
+                    penalty *= static_cast<float>(PENALTY_FACTOR);
+                    any = true;
+                }
+            }
+        }
+        return any;
+    };
+
+    std::vector<AirwayPathStep> candidate;
+    const double maxShared = 1.0 - std::min(std::max(minDissimilarity, 0.0), 1.0);
+    for (size_t attempt = 0; attempt < count * MAX_ATTEMPTS_PER_ROUTE && paths.size() < count; ++attempt) {
+        if (!search(pack, request, candidate, workspace, attempt > 0)) break;
+
+        double length = 0.0;
+        std::vector<uint64_t> legs;
+        for (size_t i = 1; i < candidate.size(); ++i) {
+            length += candidate[i].distanceNM;
+            legs.push_back(legKey(candidate[i - 1].node, candidate[i].node));
+        }
+        bool distinct = true;
+        for (const auto& kept : keptLegs) {
+            double shared = 0.0;
+            for (size_t i = 1; i < candidate.size(); ++i) {
+                if (std::binary_search(kept.begin(), kept.end(), legs[i - 1])) shared += candidate[i].distanceNM;
+            }
+            if (length > 0.0 && shared > maxShared * length + COST_EPSILON) {
+                distinct = false;
+                break;
+            }
+        }
+        if (distinct) {
+            std::sort(legs.begin(), legs.end());
+            keptLegs.push_back(std::move(legs));
+            paths.push_back(candidate);
+        }
+        // Nothing left to move off, e.g. a route of direct legs only
+        if (!penalize(candidate)) break;
+    }
+
+    for (uint32_t edge : workspace.penalizedEdges_) workspace.edgePenalty_[edge] = 1.0f;
+    workspace.penalizedEdges_.clear();
+
+    // Penalized costs decide the search order, not the true lengths
+    auto lengthOf = [](const std::vector<AirwayPathStep>& route) {
+        double total = 0.0;
+        for (const auto& step : route) total += step.distanceNM;
+        return total;
+    };
+    if (paths.size() > 2) {
+        std::stable_sort(paths.begin() + 1, paths.end(), [&](const auto& a, const auto& b) {
+            return lengthOf(a) < lengthOf(b);
+        });
+    }
+    return paths.size();
+}
+
+} // namespace AICopilot
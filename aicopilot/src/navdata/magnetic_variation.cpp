@@ -0,0 +1,286 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Magnetic Variation Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../../include/magnetic_variation.hpp"
+#include "../../include/geodesy.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <mutex>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr int N = MagneticVariationGrid::MAX_DEGREE;
+constexpr double WMM_REFERENCE_RADIUS_KM = 6371.2;
+constexpr double WGS84_A_KM = 6378.137;
+constexpr double WGS84_F = 1.0 / 298.257223563;
+constexpr double WGS84_E2 = WGS84_F * (2.0 - WGS84_F);
+constexpr double POLE_LIMIT_DEG = 89.999;   // declination is undefined at the poles
+
+struct Coefficient {
+    int n;
+    int m;
+    double g;       // nT at MODEL_EPOCH
+    double h;
+    double gDot;    // nT per year
+    double hDot;
+};
+
+// WMM2020 main field and secular variation, degrees 1..8
+constexpr Coefficient WMM_COEFFICIENTS[] = {
+    {1, 0, -29404.5,     0.0,   6.7,   0.0},
+    {1, 1,  -1450.7,  4652.9,   7.7, -25.1},
+    {2, 0,  -2500.0,     0.0, -11.5,   0.0},
+    {2, 1,   2982.0, -2991.6,  -7.1, -30.2},
+    {2, 2,   1676.8,  -734.8,  -2.2, -23.9},
+    {3, 0,   1363.9,     0.0,   2.8,   0.0},
+    {3, 1,  -2381.0,   -82.2,  -6.2,   5.7},
+    {3, 2,   1236.2,   241.8,   3.4,  -1.0},
+    {3, 3,    525.7,  -542.9, -12.2,   1.1},
+    {4, 0,    903.1,     0.0,  -1.1,   0.0},
+    {4, 1,    809.4,   282.0,  -1.6,   0.2},
+    {4, 2,     86.2,  -158.4,  -6.0,   6.9},
+    {4, 3,   -309.4,   199.8,   5.4,   3.7},
+    {4, 4,     47.9,  -350.1,  -5.5,  -5.6},
+    {5, 0,   -234.4,     0.0,  -0.3,   0.0},
+    {5, 1,    363.1,    47.7,   0.6,   0.1},
+    {5, 2,    187.8,   208.4,  -0.7,   2.5},
+    {5, 3,   -140.7,  -121.3,   0.1,  -0.9},
+    {5, 4,   -151.2,    32.2,   1.2,   3.0},
+    {5, 5,     13.7,    99.1,   1.0,   0.5},
+    {6, 0,     65.9,     0.0,  -0.6,   0.0},
+    {6, 1,     65.6,   -19.1,  -0.4,   0.1},
+    {6, 2,     73.0,    25.0,   0.5,  -1.8},
+    {6, 3,   -121.5,    52.7,   1.4,  -1.4},
+    {6, 4,    -36.2,   -64.4,  -1.4,   0.9},
+    {6, 5,     13.5,     9.0,  -0.0,   0.1},
+    {6, 6,    -64.7,    68.1,   0.8,   1.0},
+    {7, 0,     80.6,     0.0,  -0.1,   0.0},
+    {7, 1,    -76.8,   -51.4,  -0.3,   0.5},
+    {7, 2,     -8.3,   -16.8,  -0.1,   0.6},
+    {7, 3,     56.5,     2.3,   0.7,  -0.7},
+    {7, 4,     15.8,    23.5,   0.2,  -0.2},
+    {7, 5,      6.4,    -2.2,  -0.5,  -1.2},
+    {7, 6,     -7.2,   -27.2,  -0.8,   0.2},
+    {7, 7,      9.8,    -1.9,   1.0,   0.3},
+    {8, 0,     23.6,     0.0,  -0.1,   0.0},
+    {8, 1,      9.8,     8.4,   0.1,  -0.3},
+    {8, 2,    -17.5,   -15.3,  -0.1,   0.7},
+    {8, 3,     -0.4,    12.8,   0.5,  -0.2},
+    {8, 4,    -21.1,   -11.8,  -0.1,   0.5},
+    {8, 5,     15.3,    14.9,   0.4,  -0.3},
+    {8, 6,     13.7,     3.6,   0.5,  -0.5},
+    {8, 7,    -16.5,    -6.9,   0.0,   0.4},
+    {8, 8,     -0.3,     2.8,   0.4,   0.1},
+};
+
+using Table = std::array<std::array<double, N + 1>, N + 1>;
+
+// Coefficients at a date, pre-multiplied by the Schmidt quasi-normalization
+// so the Legendre recursion below can stay Gauss-normalized
+struct Model {
+    Table g{};
+    Table h{};
+
+    explicit Model(double decimalYear) {
+        Table schmidt{};
+        schmidt[0][0] = 1.0;
+        for (int n = 1; n <= N; ++n) {
+            schmidt[n][0] = schmidt[n - 1][0] * (2.0 * n - 1.0) / n;
+            for (int m = 1; m <= n; ++m) {
+                double factor = (m == 1) ? 2.0 : 1.0;
+                schmidt[n][m] = schmidt[n][m - 1] * std::sqrt((n - m + 1.0) * factor / (n + m));
+            }
+        }
+        double years = decimalYear - MagneticVariationGrid::MODEL_EPOCH;
+        for (const auto& c : WMM_COEFFICIENTS) {
+            g[c.n][c.m] = schmidt[c.n][c.m] * (c.g + years * c.gDot);
+            h[c.n][c.m] = schmidt[c.n][c.m] * (c.h + years * c.hDot);
+        }
+    }
+};
+
+// Everything that depends on latitude only, folded down to a Fourier series
+// in longitude: each field component is sum over m of a[m] cos(m lon) + b[m] sin(m lon)
+struct Row {
+    std::array<double, N + 1> northCos{}, northSin{};
+    std::array<double, N + 1> eastCos{}, eastSin{};
+    std::array<double, N + 1> downCos{}, downSin{};
+    double cosRotation = 1.0;                  // geocentric minus geodetic latitude
+    double sinRotation = 0.0;
+
+    Row(const Model& model, double latitude) {
+        double phi = std::clamp(latitude, -POLE_LIMIT_DEG, POLE_LIMIT_DEG) * Geodesy::DEG_TO_RAD;
+        double sinPhi = std::sin(phi);
+        double cosPhi = std::cos(phi);
+        double rc = WGS84_A_KM / std::sqrt(1.0 - WGS84_E2 * sinPhi * sinPhi);
+        double px = rc * cosPhi;
+        double pz = rc * (1.0 - WGS84_E2) * sinPhi;
+        double r = std::sqrt(px * px + pz * pz);
+        double geocentric = std::asin(pz / r);
+        cosRotation = std::cos(geocentric - phi);
+        sinRotation = std::sin(geocentric - phi);
+
+        // Gauss-normalized associated Legendre functions of geocentric
+        // colatitude and their derivatives by colatitude
+        double cosTheta = std::sin(geocentric);
+        double sinTheta = std::cos(geocentric);
+        Table p{};
+        Table dp{};
+        p[0][0] = 1.0;
+        for (int n = 1; n <= N; ++n) {
+            for (int m = 0; m <= n; ++m) {
+                if (n == m) {
+                    p[n][m] = sinTheta * p[n - 1][m - 1];
+                    dp[n][m] = sinTheta * dp[n - 1][m - 1] + cosTheta * p[n - 1][m - 1];
+                } else {
+                    double k = (n == 1) ? 0.0
+                        : ((n - 1.0) * (n - 1.0) - m * m) / ((2.0 * n - 1.0) * (2.0 * n - 3.0));
+                    double p2 = (n >= 2) ? p[n - 2][m] : 0.0;
+                    double dp2 = (n >= 2) ? dp[n - 2][m] : 0.0;
+                    p[n][m] = cosTheta * p[n - 1][m] - k * p2;
+                    dp[n][m] = cosTheta * dp[n - 1][m] - sinTheta * p[n - 1][m] - k * dp2;
+                }
+            }
+        }
+
+        double ratio = WMM_REFERENCE_RADIUS_KM / r;
+        double power = ratio * ratio;
+        for (int n = 1; n <= N; ++n) {
+            power *= ratio;     // (a/r)^(n+2)
+            for (int m = 0; m <= n; ++m) {
+                double g = power * model.g[n][m];
+                double h = power * model.h[n][m];
+                northCos[m] += g * dp[n][m];
+                northSin[m] += h * dp[n][m];
+                eastCos[m] -= m * h * p[n][m] / sinTheta;
+                eastSin[m] += m * g * p[n][m] / sinTheta;
+                downCos[m] -= (n + 1) * g * p[n][m];
+                downSin[m] -= (n + 1) * h * p[n][m];
+            }
+        }
+    }
+};
+
+// Declination from the row series and cos/sin(m * longitude)
+double declination(const Row& row, const double* cosM, const double* sinM) {
+    double north = 0.0;     // geocentric X'
+    double east = 0.0;      // Y'
+    double down = 0.0;      // Z'
+    for (int m = 0; m <= N; ++m) {
+        north += row.northCos[m] * cosM[m] + row.northSin[m] * sinM[m];
+        east += row.eastCos[m] * cosM[m] + row.eastSin[m] * sinM[m];
+        down += row.downCos[m] * cosM[m] + row.downSin[m] * sinM[m];
+    }
+    // Rotate the north component from geocentric to geodetic axes
+    north = north * row.cosRotation - down * row.sinRotation;
+    return std::atan2(east, north) * Geodesy::RAD_TO_DEG;
+}
+
+void longitudeTerms(double longitude, double* cosM, double* sinM) {
+    double lambda = longitude * Geodesy::DEG_TO_RAD;
+    for (int m = 0; m <= N; ++m) {
+        cosM[m] = std::cos(m * lambda);
+        sinM[m] = std::sin(m * lambda);
+    }
+}
+
+} // namespace
+
+MagneticVariationGrid::MagneticVariationGrid(double decimalYear)
+    : decimalYear_(decimalYear), cells_(ROWS * COLUMNS) {
+    Model model(decimalYear);
+
+    std::vector<double> cosM(COLUMNS * (N + 1));
+    std::vector<double> sinM(COLUMNS * (N + 1));
+    for (size_t col = 0; col < COLUMNS; ++col) {
+        longitudeTerms(-180.0 + col * STEP_DEG, &cosM[col * (N + 1)], &sinM[col * (N + 1)]);
+    }
+
+    for (size_t row = 0; row < ROWS; ++row) {
+        Row terms(model, -90.0 + row * STEP_DEG);
+        float* out = &cells_[row * COLUMNS];
+        for (size_t col = 0; col < COLUMNS; ++col) {
+            out[col] = static_cast<float>(
+                declination(terms, &cosM[col * (N + 1)], &sinM[col * (N + 1)]));
+        }
+    }
+}
+
+std::shared_ptr<const MagneticVariationGrid> MagneticVariationGrid::current() {
+    // Rebuilt when the date moves a tenth of a year, far below the model's
+    // drift. Never destroyed: executor jobs may still ask during teardown.
+    struct Cache {
+        std::mutex mutex;
+        std::shared_ptr<const MagneticVariationGrid> grid;
+    };
+    static Cache* cache = new Cache();
+    double year = std::floor(currentDecimalYear() * 10.0) / 10.0;
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    if (!cache->grid || cache->grid->getDecimalYear() != year) {
+        cache->grid = std::make_shared<const MagneticVariationGrid>(year);
+    }
+    return cache->grid;
+}
+
+double MagneticVariationGrid::evaluate(double latitude, double longitude, double decimalYear) {
+    Row row(Model(decimalYear), latitude);
+    double cosM[N + 1];
+    double sinM[N + 1];
+    longitudeTerms(longitude, cosM, sinM);
+    return declination(row, cosM, sinM);
+}
+
+double MagneticVariationGrid::currentDecimalYear() {
+    std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm utc{};
+#ifdef _WIN32
+    gmtime_s(&utc, &now);
+#else
+    gmtime_r(&now, &utc);
+#endif
+    return 1900.0 + utc.tm_year + utc.tm_yday / 365.25;
+}
+
+double MagneticVariationGrid::lookup(double latitude, double longitude) const {
+    latitude = std::clamp(latitude, -90.0, 90.0);
+    longitude = std::fmod(longitude + 180.0, 360.0);
+    if (longitude < 0.0) longitude += 360.0;
+
+    double y = latitude + 90.0;
+    double x = longitude;
+    size_t row = std::min(static_cast<size_t>(y / STEP_DEG), ROWS - 2);
+    size_t col = std::min(static_cast<size_t>(x / STEP_DEG), COLUMNS - 2);
+    double fy = y / STEP_DEG - row;
+    double fx = x / STEP_DEG - col;
+
+    const float* south = &cells_[row * COLUMNS + col];
+    const float* north = south + COLUMNS;
+    // Blend angles across the +/-180 wrap near the magnetic poles
+    double base = south[0];
+    auto unwrap = [base](double value) {
+        if (value - base > 180.0) return value - 360.0;
+        if (value - base < -180.0) return value + 360.0;
+        return value;
+    };
+    double s = base + (unwrap(south[1]) - base) * fx;
+    double n = unwrap(north[0]) + (unwrap(north[1]) - unwrap(north[0])) * fx;
+    double value = s + (n - s) * fy;
+    if (value > 180.0) value -= 360.0;
+    if (value <= -180.0) value += 360.0;
+    return value;
+}
+
+} // namespace AICopilot
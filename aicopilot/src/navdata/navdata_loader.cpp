@@ -10,6 +10,7 @@
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <future>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -38,23 +39,240 @@ void NavdataLoader::shutdown() {
 }
 
 int NavdataLoader::loadNavaids(const std::string& filePath) {
+    std::vector<NavaidInfo> staged;
+    if (!parseNavaids(filePath, staged)) {
+        return 0;
+    }
+    
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    int count = mergeNavaids(staged);
+    std::cout << "NavdataLoader: Loaded " << count << " navaids" << std::endl;
+    return count;
+}
+
+int NavdataLoader::loadAirways(const std::string& filePath) {
+    std::vector<AirwayRow> staged;
+    if (!parseAirways(filePath, staged)) {
+        return 0;
+    }
+    
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    int count = mergeAirways(staged);
+    std::cout << "NavdataLoader: Loaded " << count << " airways" << std::endl;
+    return count;
+}
+
+int NavdataLoader::loadProcedures(const std::string& filePath) {
+    ProcedureStage staged;
+    if (!indexProcedures(filePath, staged)) {
+        return 0;
+    }
+    
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    int count = mergeProcedures(filePath, staged);
+    std::cout << "NavdataLoader: Indexed " << count << " procedures for "
+              << procedureIndex_.size() << " airports" << std::endl;
+    return count;
+}
+
+int NavdataLoader::loadFiles(const NavdataFileSet& files) {
+    // Parse everything concurrently; the parsers touch no shared state
+    std::vector<std::vector<NavaidInfo>> navaidStages(files.navaidFiles.size());
+    std::vector<std::vector<AirwayRow>> airwayStages(files.airwayFiles.size());
+    std::vector<ProcedureStage> procedureStages(files.procedureFiles.size());
+    std::vector<std::future<bool>> navaidTasks;
+    std::vector<std::future<bool>> airwayTasks;
+    std::vector<std::future<bool>> procedureTasks;
+    
+    for (size_t i = 0; i < files.navaidFiles.size(); ++i) {
+        navaidTasks.push_back(std::async(std::launch::async, parseNavaids,
+                                         std::cref(files.navaidFiles[i]), std::ref(navaidStages[i])));
+    }
+    for (size_t i = 0; i < files.airwayFiles.size(); ++i) {
+        airwayTasks.push_back(std::async(std::launch::async, parseAirways,
+                                         std::cref(files.airwayFiles[i]), std::ref(airwayStages[i])));
+    }
+    for (size_t i = 0; i < files.procedureFiles.size(); ++i) {
+        procedureTasks.push_back(std::async(std::launch::async, indexProcedures,
+                                            std::cref(files.procedureFiles[i]), std::ref(procedureStages[i])));
+    }
+    
+    std::vector<bool> navaidOk, airwayOk, procedureOk;
+    for (auto& task : navaidTasks) navaidOk.push_back(task.get());
+    for (auto& task : airwayTasks) airwayOk.push_back(task.get());
+    for (auto& task : procedureTasks) procedureOk.push_back(task.get());
+    
+    // One merge under the lock; airways resolve against the merged navaids
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    int navaids = 0, airways = 0, procedures = 0;
+    size_t stagedNavaids = 0;
+    for (const auto& stage : navaidStages) stagedNavaids += stage.size();
+    navaids_.reserve(navaids_.size() + stagedNavaids);
+    
+    for (size_t i = 0; i < navaidStages.size(); ++i) {
+        if (navaidOk[i]) navaids += mergeNavaids(navaidStages[i]);
+    }
+    for (size_t i = 0; i < airwayStages.size(); ++i) {
+        if (airwayOk[i]) airways += mergeAirways(airwayStages[i]);
+    }
+    for (size_t i = 0; i < procedureStages.size(); ++i) {
+        if (procedureOk[i]) procedures += mergeProcedures(files.procedureFiles[i], procedureStages[i]);
+    }
+    
+    std::cout << "NavdataLoader: Loaded " << navaids << " navaids, " << airways
+              << " airways and indexed " << procedures << " procedures from "
+              << (files.navaidFiles.size() + files.airwayFiles.size() + files.procedureFiles.size())
+              << " files" << std::endl;
+    return navaids + airways + procedures;
+}
+
+int NavdataLoader::prefetchProcedures(const std::vector<std::string>& icaos) {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    int count = 0;
+    for (const auto& icao : icaos) {
+        count += static_cast<int>(airportProcedures(icao).size());
+    }
+    return count;
+}
+
+void NavdataLoader::setProcedureMemoryBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    procedureBudget_ = bytes;
+    evictProcedures(std::string());
+}
+
+size_t NavdataLoader::getProcedureMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    return residentProcedureBytes_;
+}
+
+bool NavdataLoader::getNavaid(const std::string& identifier, NavaidInfo& navaid) {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    
+    auto it = navaids_.find(SymbolTable::navdata().find(identifier));
+    if (it != navaids_.end()) {
+        navaid = it->second;
+        return true;
+    }
+    
+    return false;
+}
+
+std::vector<NavaidInfo> NavdataLoader::getNavaidsNearby(const Position& position,
+                                                       double radiusNM,
+                                                       const std::string& type) {
+    std::vector<NavaidInfo> nearby;
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    
+    for (const auto& pair : navaids_) {
+        const NavaidInfo& navaid = pair.second;
+        
+        if (isWithinRadius(position, navaid.position, radiusNM)) {
+            nearby.push_back(navaid);
+        }
+    }
+    
+    return nearby;
+}
+
+std::vector<AirwaySegment> NavdataLoader::getAirwaysFrom(const std::string& startIdent) {
+    std::vector<AirwaySegment> fromStart;
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    
+    auto it = airwaysFrom_.find(SymbolTable::navdata().find(startIdent));
+    if (it != airwaysFrom_.end()) {
+        for (uint32_t index : it->second) {
+            fromStart.push_back(airways_[index]);
+        }
+    }
+    
+    return fromStart;
+}
+
+std::vector<Procedure> NavdataLoader::getSIDProcedures(const std::string& icao,
+                                                      const std::string& runway) {
+    std::vector<Procedure> sids;
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    
+    collectProcedures(icao, "SID", runway, sids);
+    
+    return sids;
+}
+
+std::vector<Procedure> NavdataLoader::getSTARProcedures(const std::string& icao,
+                                                       const std::string& runway) {
+    std::vector<Procedure> stars;
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    
+    collectProcedures(icao, "STAR", runway, stars);
+    
+    return stars;
+}
+
+std::vector<Procedure> NavdataLoader::getApproachProcedures(const std::string& icao,
+                                                           const std::string& runway) {
+    std::vector<Procedure> approaches;
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    
+    collectProcedures(icao, "APP", runway, approaches);
+    
+    return approaches;
+}
+
+void NavdataLoader::addNavaid(const NavaidInfo& navaid) {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    navaids_[SymbolTable::navdata().intern(navaid.identifier)] = navaid;
+}
+
+void NavdataLoader::addAirway(const AirwaySegment& airway) {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    SymbolId startId = SymbolTable::navdata().intern(airway.startPoint.identifier);
+    airwaysFrom_[startId].push_back(static_cast<uint32_t>(airways_.size()));
+    airways_.push_back(airway);
+}
+
+void NavdataLoader::addProcedure(const Procedure& proc) {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    addedProcedures_[proc.airportICAO].push_back(proc);
+    addedProcedureCount_++;
+}
+
+std::tuple<int, int, int> NavdataLoader::getStatistics() const {
+    std::lock_guard<std::mutex> lock(dbMutex_);
+    return std::make_tuple(static_cast<int>(navaids_.size()), static_cast<int>(airways_.size()),
+                           static_cast<int>(indexedProcedureCount_ + addedProcedureCount_));
+}
+
+void NavdataLoader::clear() {
+    navaids_.clear();
+    airways_.clear();
+    airwaysFrom_.clear();
+    procedureFiles_.clear();
+    procedureIndex_.clear();
+    residentProcedures_.clear();
+    procedureLru_.clear();
+    addedProcedures_.clear();
+    residentProcedureBytes_ = 0;
+    indexedProcedureCount_ = 0;
+    addedProcedureCount_ = 0;
+}
+
+// Private helper methods
+
+bool NavdataLoader::parseNavaids(const std::string& filePath, std::vector<NavaidInfo>& out) {
     std::ifstream file(filePath);
     if (!file.is_open()) {
         std::cerr << "NavdataLoader: Cannot open navaids file: " << filePath << std::endl;
-        return 0;
+        return false;
     }
     
-    int count = 0;
     std::string line;
     
     // Skip header
     if (!std::getline(file, line)) {
-        file.close();
-        return 0;
+        return false;
     }
     
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    
     while (std::getline(file, line)) {
         if (line.empty() || line[0] == '#') continue;
         
@@ -102,37 +320,30 @@ int NavdataLoader::loadNavaids(const std::string& filePath) {
             navaid.position.altitude = 0;
             navaid.position.heading = 0;
             
-            navaids_[navaid.identifier] = navaid;
-            count++;
+            out.push_back(std::move(navaid));
             
         } catch (const std::exception& e) {
             std::cerr << "NavdataLoader: Error parsing navaid: " << line << std::endl;
         }
     }
     
-    file.close();
-    std::cout << "NavdataLoader: Loaded " << count << " navaids" << std::endl;
-    return count;
+    return true;
 }
 
-int NavdataLoader::loadAirways(const std::string& filePath) {
+bool NavdataLoader::parseAirways(const std::string& filePath, std::vector<AirwayRow>& out) {
     std::ifstream file(filePath);
     if (!file.is_open()) {
         std::cerr << "NavdataLoader: Cannot open airways file: " << filePath << std::endl;
-        return 0;
+        return false;
     }
     
-    int count = 0;
     std::string line;
     
     // Skip header
     if (!std::getline(file, line)) {
-        file.close();
-        return 0;
+        return false;
     }
     
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    
     while (std::getline(file, line)) {
         if (line.empty() || line[0] == '#') continue;
         
@@ -151,230 +362,256 @@ int NavdataLoader::loadAirways(const std::string& filePath) {
         
         if (fields.size() < 7) continue;
         
+        AirwayRow row;
+        row.identifier = fields[0];
+        row.type = fields[1];  // "LOW" or "HIGH"
+        row.startIdent = fields[2];
+        row.endIdent = fields[3];
+        
+        // Altitude constraints
         try {
-            AirwaySegment airway;
-            airway.identifier = fields[0];
-            airway.type = fields[1];  // "LOW" or "HIGH"
-            
-            // Start navaid
-            std::string startIdent = fields[2];
-            if (navaids_.find(startIdent) != navaids_.end()) {
-                airway.startPoint = navaids_[startIdent];
-            } else {
-                continue;  // Skip if start navaid not found
-            }
-            
-            // End navaid
-            std::string endIdent = fields[3];
-            if (navaids_.find(endIdent) != navaids_.end()) {
-                airway.endPoint = navaids_[endIdent];
-            } else {
-                continue;  // Skip if end navaid not found
-            }
-            
-            // Altitude constraints
-            try {
-                airway.minimumAltitude = std::stoi(fields[4]);
-            } catch (...) {
-                airway.minimumAltitude = 0;
-            }
-            
-            try {
-                airway.maximumAltitude = std::stoi(fields[5]);
-            } catch (...) {
-                airway.maximumAltitude = 0;
-            }
-            
-            airways_.push_back(airway);
-            count++;
-            
-        } catch (const std::exception& e) {
-            std::cerr << "NavdataLoader: Error parsing airway: " << line << std::endl;
+            row.minimumAltitude = std::stoi(fields[4]);
+        } catch (...) {
+            row.minimumAltitude = 0;
+        }
+        
+        try {
+            row.maximumAltitude = std::stoi(fields[5]);
+        } catch (...) {
+            row.maximumAltitude = 0;
         }
+        
+        out.push_back(std::move(row));
     }
     
-    file.close();
-    std::cout << "NavdataLoader: Loaded " << count << " airways" << std::endl;
-    return count;
+    return true;
 }
 
-int NavdataLoader::loadProcedures(const std::string& filePath) {
-    std::ifstream file(filePath);
+bool NavdataLoader::indexProcedures(const std::string& filePath, ProcedureStage& out) {
+    // Binary so byte offsets match what seekg() sees later
+    std::ifstream file(filePath, std::ios::binary);
     if (!file.is_open()) {
         std::cerr << "NavdataLoader: Cannot open procedures file: " << filePath << std::endl;
-        return 0;
+        return false;
     }
     
-    int count = 0;
     std::string line;
     
     // Skip header
     if (!std::getline(file, line)) {
-        file.close();
-        return 0;
+        return false;
     }
-    
-    std::lock_guard<std::mutex> lock(dbMutex_);
+    uint64_t offset = line.size() + 1;
     
     while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;
-        
-        std::istringstream iss(line);
-        std::string token;
-        std::vector<std::string> fields;
-        
-        while (std::getline(iss, token, ',')) {
-            size_t start = token.find_first_not_of(" \t\r\n");
-            size_t end = token.find_last_not_of(" \t\r\n");
+        uint64_t next = offset + line.size() + 1;
+        size_t comma = line.find(',');
+        if (!line.empty() && line[0] != '#' && comma != std::string::npos) {
+            std::string icao = line.substr(0, comma);
+            size_t start = icao.find_first_not_of(" \t");
+            size_t end = icao.find_last_not_of(" \t");
             if (start != std::string::npos) {
-                token = token.substr(start, end - start + 1);
+                icao = icao.substr(start, end - start + 1);
+                
+                // Rows of one airport are usually adjacent; keep them as one span
+                auto& spans = out.spans[icao];
+                if (!spans.empty() && spans.back().offset + spans.back().length == offset) {
+                    spans.back().length += next - offset;
+                } else {
+                    spans.push_back({0, offset, next - offset});
+                }
+                out.count++;
             }
-            fields.push_back(token);
-        }
-        
-        if (fields.size() < 4) continue;
-        
-        try {
-            Procedure proc;
-            proc.airportICAO = fields[0];
-            proc.type = fields[1];  // SID, STAR, APP
-            proc.identifier = fields[2];
-            proc.runway = fields[3];
-            
-            // Additional fields would contain waypoint info
-            // This is a simplified loader - full implementation would parse all waypoints
-            
-            procedures_.push_back(proc);
-            count++;
-            
-        } catch (const std::exception& e) {
-            std::cerr << "NavdataLoader: Error parsing procedure: " << line << std::endl;
         }
+        offset = next;
     }
     
-    file.close();
-    std::cout << "NavdataLoader: Loaded " << count << " procedures" << std::endl;
-    return count;
+    return true;
 }
 
-bool NavdataLoader::getNavaid(const std::string& identifier, NavaidInfo& navaid) {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    
-    auto it = navaids_.find(identifier);
-    if (it != navaids_.end()) {
-        navaid = it->second;
-        return true;
+int NavdataLoader::mergeNavaids(std::vector<NavaidInfo>& staged) {
+    SymbolTable& symbols = SymbolTable::navdata();
+    for (auto& navaid : staged) {
+        SymbolId id = symbols.intern(navaid.identifier);
+        navaids_[id] = std::move(navaid);
     }
-    
-    return false;
+    return static_cast<int>(staged.size());
 }
 
-std::vector<NavaidInfo> NavdataLoader::getNavaidsNearby(const Position& position,
-                                                       double radiusNM,
-                                                       const std::string& type) {
-    std::vector<NavaidInfo> nearby;
-    std::lock_guard<std::mutex> lock(dbMutex_);
+int NavdataLoader::mergeAirways(const std::vector<AirwayRow>& staged) {
+    SymbolTable& symbols = SymbolTable::navdata();
+    int count = 0;
+    airways_.reserve(airways_.size() + staged.size());
     
-    for (const auto& pair : navaids_) {
-        const NavaidInfo& navaid = pair.second;
+    for (const auto& row : staged) {
+        // Skip segments whose navaids are not loaded
+        SymbolId startId = symbols.find(row.startIdent);
+        auto startIt = navaids_.find(startId);
+        if (startIt == navaids_.end()) continue;
+        auto endIt = navaids_.find(symbols.find(row.endIdent));
+        if (endIt == navaids_.end()) continue;
         
-        if (isWithinRadius(position, navaid.position, radiusNM)) {
-            nearby.push_back(navaid);
-        }
+        AirwaySegment airway;
+        airway.identifier = row.identifier;
+        airway.type = row.type;
+        airway.startPoint = startIt->second;
+        airway.endPoint = endIt->second;
+        airway.minimumAltitude = row.minimumAltitude;
+        airway.maximumAltitude = row.maximumAltitude;
+        
+        airwaysFrom_[startId].push_back(static_cast<uint32_t>(airways_.size()));
+        airways_.push_back(std::move(airway));
+        count++;
     }
     
-    return nearby;
+    return count;
 }
 
-std::vector<AirwaySegment> NavdataLoader::getAirwaysFrom(const std::string& startIdent) {
-    std::vector<AirwaySegment> fromStart;
-    std::lock_guard<std::mutex> lock(dbMutex_);
+int NavdataLoader::mergeProcedures(const std::string& filePath, ProcedureStage& staged) {
+    uint32_t fileIndex = static_cast<uint32_t>(procedureFiles_.size());
+    procedureFiles_.push_back(filePath);
     
-    for (const auto& airway : airways_) {
-        if (airway.startPoint.identifier == startIdent) {
-            fromStart.push_back(airway);
+    for (auto& pair : staged.spans) {
+        auto& spans = procedureIndex_[pair.first];
+        for (auto& span : pair.second) {
+            span.file = fileIndex;
+            spans.push_back(span);
         }
+        dropResidentAirport(pair.first);  // reparse with the new rows
     }
     
-    return fromStart;
+    indexedProcedureCount_ += staged.count;
+    return staged.count;
 }
 
-std::vector<Procedure> NavdataLoader::getSIDProcedures(const std::string& icao,
-                                                      const std::string& runway) {
-    std::vector<Procedure> sids;
-    std::lock_guard<std::mutex> lock(dbMutex_);
+const std::vector<Procedure>& NavdataLoader::airportProcedures(const std::string& icao) {
+    static const std::vector<Procedure> none;
     
-    for (const auto& proc : procedures_) {
-        if (proc.airportICAO == icao && proc.type == "SID") {
-            if (runway.empty() || proc.runway == runway) {
-                sids.push_back(proc);
-            }
-        }
+    auto resident = residentProcedures_.find(icao);
+    if (resident != residentProcedures_.end()) {
+        procedureLru_.splice(procedureLru_.begin(), procedureLru_, resident->second.lruPosition);
+        return resident->second.procedures;
     }
     
-    return sids;
-}
-
-std::vector<Procedure> NavdataLoader::getSTARProcedures(const std::string& icao,
-                                                       const std::string& runway) {
-    std::vector<Procedure> stars;
-    std::lock_guard<std::mutex> lock(dbMutex_);
+    auto indexed = procedureIndex_.find(icao);
+    if (indexed == procedureIndex_.end()) {
+        return none;
+    }
     
-    for (const auto& proc : procedures_) {
-        if (proc.airportICAO == icao && proc.type == "STAR") {
-            if (runway.empty() || proc.runway == runway) {
-                stars.push_back(proc);
+    // Fault the airport in: read its rows back and parse them
+    ResidentAirport airport;
+    std::ifstream file;
+    uint32_t openFile = UINT32_MAX;
+    std::string block;
+    for (const auto& span : indexed->second) {
+        if (span.file != openFile) {
+            file.close();
+            file.clear();
+            file.open(procedureFiles_[span.file], std::ios::binary);
+            openFile = span.file;
+        }
+        block.resize(span.length);
+        file.seekg(static_cast<std::streamoff>(span.offset));
+        file.read(&block[0], static_cast<std::streamsize>(span.length));
+        block.resize(static_cast<size_t>(std::max<std::streamsize>(file.gcount(), 0)));
+        file.clear();  // a final row without a newline reads short
+        
+        std::istringstream rows(block);
+        std::string line;
+        while (std::getline(rows, line)) {
+            Procedure proc;
+            if (parseProcedure(line, proc) && proc.airportICAO == icao) {
+                airport.bytes += procedureBytes(proc);
+                airport.procedures.push_back(std::move(proc));
             }
         }
     }
     
-    return stars;
+    procedureLru_.push_front(icao);
+    airport.lruPosition = procedureLru_.begin();
+    residentProcedureBytes_ += airport.bytes;
+    ResidentAirport& stored = residentProcedures_.emplace(icao, std::move(airport)).first->second;
+    evictProcedures(icao);
+    return stored.procedures;
 }
 
-std::vector<Procedure> NavdataLoader::getApproachProcedures(const std::string& icao,
-                                                           const std::string& runway) {
-    std::vector<Procedure> approaches;
-    std::lock_guard<std::mutex> lock(dbMutex_);
+void NavdataLoader::collectProcedures(const std::string& icao, const std::string& type,
+                                      const std::string& runway, std::vector<Procedure>& out) {
+    auto matches = [&](const Procedure& proc) {
+        return proc.type == type && (runway.empty() || proc.runway == runway);
+    };
     
-    for (const auto& proc : procedures_) {
-        if (proc.airportICAO == icao && proc.type == "APP") {
-            if (runway.empty() || proc.runway == runway) {
-                approaches.push_back(proc);
-            }
-        }
+    for (const auto& proc : airportProcedures(icao)) {
+        if (matches(proc)) out.push_back(proc);
     }
     
-    return approaches;
-}
-
-void NavdataLoader::addNavaid(const NavaidInfo& navaid) {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    navaids_[navaid.identifier] = navaid;
+    auto added = addedProcedures_.find(icao);
+    if (added != addedProcedures_.end()) {
+        for (const auto& proc : added->second) {
+            if (matches(proc)) out.push_back(proc);
+        }
+    }
 }
 
-void NavdataLoader::addAirway(const AirwaySegment& airway) {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    airways_.push_back(airway);
+void NavdataLoader::dropResidentAirport(const std::string& icao) {
+    auto resident = residentProcedures_.find(icao);
+    if (resident != residentProcedures_.end()) {
+        residentProcedureBytes_ -= resident->second.bytes;
+        procedureLru_.erase(resident->second.lruPosition);
+        residentProcedures_.erase(resident);
+    }
 }
 
-void NavdataLoader::addProcedure(const Procedure& proc) {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    procedures_.push_back(proc);
+void NavdataLoader::evictProcedures(const std::string& keep) {
+    // The airport just requested stays even if it alone exceeds the budget
+    while (residentProcedureBytes_ > procedureBudget_ && !procedureLru_.empty() &&
+           procedureLru_.back() != keep) {
+        std::string victim = procedureLru_.back();
+        dropResidentAirport(victim);
+    }
 }
 
-std::tuple<int, int, int> NavdataLoader::getStatistics() const {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    return std::make_tuple(navaids_.size(), airways_.size(), procedures_.size());
+bool NavdataLoader::parseProcedure(const std::string& line, Procedure& proc) {
+    if (line.empty() || line[0] == '#') return false;
+    
+    std::istringstream iss(line);
+    std::string token;
+    std::vector<std::string> fields;
+    
+    while (std::getline(iss, token, ',')) {
+        size_t start = token.find_first_not_of(" \t\r\n");
+        size_t end = token.find_last_not_of(" \t\r\n");
+        if (start != std::string::npos) {
+            token = token.substr(start, end - start + 1);
+        }
+        fields.push_back(token);
+    }
+    
+    if (fields.size() < 4) return false;
+    
+    proc.airportICAO = fields[0];
+    proc.type = fields[1];  // SID, STAR, APP
+    proc.identifier = fields[2];
+    proc.runway = fields[3];
+    
+    // Additional fields would contain waypoint info
+    // This is a simplified loader - full implementation would parse all waypoints
+    return true;
 }
 
-void NavdataLoader::clear() {
-    navaids_.clear();
-    airways_.clear();
-    procedures_.clear();
+size_t NavdataLoader::procedureBytes(const Procedure& proc) {
+    size_t bytes = sizeof(Procedure) + proc.identifier.capacity() + proc.type.capacity() +
+                   proc.runway.capacity() + proc.airportICAO.capacity();
+    bytes += proc.waypoints.capacity() * sizeof(ProcedureWaypoint);
+    for (const auto& wp : proc.waypoints) {
+        bytes += wp.identifier.capacity() + wp.type.capacity();
+    }
+    for (const auto& transition : proc.transitions) {
+        bytes += sizeof(std::string) + transition.capacity();
+    }
+    return bytes;
 }
 
-// Private helper methods
-
 NavaidType NavdataLoader::parseNavaidType(const std::string& typeStr) {
     if (typeStr == "VOR") return NavaidType::VOR;
     if (typeStr == "NDB") return NavaidType::NDB;
@@ -0,0 +1,533 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Navdata Pack Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/navdata_pack.hpp"
+#include "../include/magnetic_variation.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AICopilot {
+
+namespace {
+
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+constexpr double EARTH_RADIUS_NM = 3440.065;
+
+double greatCircleNM(const NavdataWaypoint& a, const NavdataWaypoint& b) {
+    double dLat = (b.latitude - a.latitude) * DEG_TO_RAD;
+    double dLon = (b.longitude - a.longitude) * DEG_TO_RAD;
+    double h = std::sin(dLat / 2.0) * std::sin(dLat / 2.0) +
+               std::cos(a.latitude * DEG_TO_RAD) * std::cos(b.latitude * DEG_TO_RAD) *
+               std::sin(dLon / 2.0) * std::sin(dLon / 2.0);
+    return EARTH_RADIUS_NM * 2.0 * std::atan2(std::sqrt(h), std::sqrt(1.0 - h));
+}
+
+uint32_t hashName(std::string_view name) {
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+uint64_t checksum(const uint8_t* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+uint32_t bucketCountFor(size_t entries) {
+    uint32_t buckets = 16;
+    while (buckets < entries * 2) buckets <<= 1;
+    return buckets;
+}
+
+// Open-addressing table of indices, probed linearly from the name hash
+template <typename NameOf>
+std::vector<uint32_t> buildHashTable(size_t count, uint32_t buckets, NameOf nameOf) {
+    std::vector<uint32_t> table(buckets, NavdataPack::NO_INDEX);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t slot = hashName(nameOf(i)) & (buckets - 1);
+        while (table[slot] != NavdataPack::NO_INDEX) slot = (slot + 1) & (buckets - 1);
+        table[slot] = static_cast<uint32_t>(i);
+    }
+    return table;
+}
+
+// Deduplicating string pool
+class StringPool {
+public:
+    NavdataPackString add(const std::string& value) {
+        auto it = offsets_.find(value);
+        if (it == offsets_.end()) {
+            it = offsets_.emplace(value, static_cast<uint32_t>(bytes_.size())).first;
+            bytes_.insert(bytes_.end(), value.begin(), value.end());
+        }
+        return {it->second, static_cast<uint32_t>(value.size())};
+    }
+    const std::vector<char>& bytes() const { return bytes_; }
+
+private:
+    std::vector<char> bytes_;
+    std::unordered_map<std::string, uint32_t> offsets_;
+};
+
+template <typename T>
+void appendSection(std::vector<uint8_t>& image, NavdataPackHeader& header, NavdataPackSectionId id,
+                   const std::vector<T>& items) {
+    image.resize((image.size() + 7) & ~static_cast<size_t>(7), 0);
+    size_t bytes = items.size() * sizeof(T);
+    header.sections[id].offset = image.size();
+    header.sections[id].size = bytes;
+    if (bytes > 0) {
+        const auto* begin = reinterpret_cast<const uint8_t*>(items.data());
+        image.insert(image.end(), begin, begin + bytes);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// NavdataPackBuilder
+// ============================================================================
+
+void NavdataPackBuilder::putWaypoint(const NavdataWaypoint& waypoint) {
+    auto inserted = waypointIndex_.emplace(waypoint.name, static_cast<uint32_t>(waypoints_.size()));
+    if (inserted.second) {
+        waypoints_.push_back(waypoint);
+    } else {
+        waypoints_[inserted.first->second] = waypoint;
+    }
+}
+
+void NavdataPackBuilder::putAirway(const Airway& airway) {
+    auto inserted = airwayIndex_.emplace(airway.name, static_cast<uint32_t>(airways_.size()));
+    if (inserted.second) {
+        airways_.push_back(airway);
+    } else {
+        airways_[inserted.first->second] = airway;
+    }
+}
+
+size_t NavdataPackBuilder::stampMagneticVariation(const MagneticVariationGrid& grid) {
+    size_t stamped = 0;
+    for (auto& wp : waypoints_) {
+        if (wp.magneticVariation == 0.0) {
+            wp.magneticVariation = grid.lookup(wp.latitude, wp.longitude);
+            stamped++;
+        }
+    }
+    return stamped;
+}
+
+std::vector<uint8_t> NavdataPackBuilder::build() const {
+    NavdataPackHeader header{};
+    std::memcpy(header.magic, NavdataPack::MAGIC, sizeof(header.magic));
+    header.version = NavdataPack::VERSION;
+    header.headerSize = sizeof(NavdataPackHeader);
+    header.airacCycle = airacCycle_;
+    header.waypointCount = static_cast<uint32_t>(waypoints_.size());
+    header.airwayCount = static_cast<uint32_t>(airways_.size());
+
+    StringPool strings;
+
+    std::vector<NavdataPackWaypoint> waypointRecords(waypoints_.size());
+    std::vector<WaypointIndex::Point> points;
+    points.reserve(waypoints_.size());
+    for (size_t node = 0; node < waypoints_.size(); ++node) {
+        const NavdataWaypoint& wp = waypoints_[node];
+        NavdataPackWaypoint& record = waypointRecords[node];
+        // Lengths are one byte; identifiers never come close
+        NavdataPackString name = strings.add(wp.name.substr(0, UINT8_MAX));
+        NavdataPackString region = strings.add(wp.region.substr(0, UINT8_MAX));
+        record.latitudeE7 = static_cast<int32_t>(std::lround(wp.latitude * 1e7));
+        record.longitudeE7 = static_cast<int32_t>(std::lround(wp.longitude * 1e7));
+        record.nameOffset = name.offset;
+        record.regionOffset = region.offset;
+        record.frequencyMilli = static_cast<uint32_t>(std::lround(std::max(0.0, wp.frequency) * 1000.0));
+        record.elevationFeet = static_cast<int16_t>(std::lround(std::clamp(wp.elevation, -2000.0, 32000.0)));
+        record.magneticVariationCenti = static_cast<int16_t>(std::lround(wp.magneticVariation * 100.0));
+        record.rangeNM = static_cast<uint16_t>(std::lround(std::clamp(wp.range, 0.0, 65535.0)));
+        record.nameLength = static_cast<uint8_t>(name.length);
+        record.regionLength = static_cast<uint8_t>(region.length);
+        record.type = static_cast<uint8_t>(wp.type);
+        record.flags = static_cast<uint8_t>(static_cast<uint8_t>(wp.purpose) & NavdataPackWaypoint::PURPOSE_MASK);
+        if (wp.isUsable) record.flags |= NavdataPackWaypoint::FLAG_USABLE;
+        points.push_back({wp.latitude, wp.longitude, static_cast<uint32_t>(node)});
+    }
+
+    // Airway sequences, resolving each fix to a node once
+    std::vector<NavdataPackAirway> airwayRecords(airways_.size());
+    std::vector<NavdataPackFix> fixes;
+    std::vector<std::pair<uint32_t, NavdataPackEdge>> pending;
+    for (size_t a = 0; a < airways_.size(); ++a) {
+        const Airway& airway = airways_[a];
+        NavdataPackAirway& record = airwayRecords[a];
+        record.name = strings.add(airway.name);
+        record.description = strings.add(airway.description);
+        record.minimumAltitude = airway.minimumAltitude;
+        record.maximumAltitude = airway.maximumAltitude;
+        record.firstFix = static_cast<uint32_t>(fixes.size());
+        record.fixCount = static_cast<uint32_t>(airway.waypointSequence.size());
+        record.level = static_cast<uint8_t>(airway.level);
+        record.active = airway.isActive ? 1 : 0;
+
+        uint32_t previous = NavdataPack::NO_INDEX;
+        for (const auto& fixName : airway.waypointSequence) {
+            NavdataPackFix fix{};
+            fix.name = strings.add(fixName);
+            auto it = waypointIndex_.find(fixName);
+            fix.waypoint = (it != waypointIndex_.end()) ? it->second : NavdataPack::NO_INDEX;
+
+            // Both directions of every pair of consecutive fixes that exist
+            if (fix.waypoint != NavdataPack::NO_INDEX && previous != NavdataPack::NO_INDEX &&
+                fix.waypoint != previous) {
+                fix.legDistanceNM = greatCircleNM(waypoints_[previous], waypoints_[fix.waypoint]);
+                record.totalDistanceNM += fix.legDistanceNM;
+                uint32_t airwayIndex = static_cast<uint32_t>(a);
+                pending.push_back({previous, {fix.waypoint, airwayIndex, fix.legDistanceNM}});
+                pending.push_back({fix.waypoint, {previous, airwayIndex, fix.legDistanceNM}});
+            }
+            previous = fix.waypoint;
+            fixes.push_back(fix);
+        }
+    }
+    header.airwayFixCount = static_cast<uint32_t>(fixes.size());
+
+    // Counting sort of the legs into CSR order
+    std::vector<uint32_t> edgeOffsets(waypoints_.size() + 1, 0);
+    for (const auto& edge : pending) {
+        edgeOffsets[edge.first + 1]++;
+    }
+    for (size_t node = 0; node < waypoints_.size(); ++node) {
+        edgeOffsets[node + 1] += edgeOffsets[node];
+    }
+    std::vector<NavdataPackEdge> edges(pending.size());
+    std::vector<uint32_t> fill(edgeOffsets.begin(), edgeOffsets.end() - 1);
+    for (const auto& edge : pending) {
+        edges[fill[edge.first]++] = edge.second;
+    }
+    header.edgeCount = static_cast<uint32_t>(edges.size());
+
+    header.waypointBuckets = bucketCountFor(waypoints_.size());
+    std::vector<uint32_t> waypointHash = buildHashTable(waypoints_.size(), header.waypointBuckets,
+        [this](size_t i) { return std::string_view(waypoints_[i].name).substr(0, UINT8_MAX); });
+    header.airwayBuckets = bucketCountFor(airways_.size());
+    std::vector<uint32_t> airwayHash = buildHashTable(airways_.size(), header.airwayBuckets,
+        [this](size_t i) { return std::string_view(airways_[i].name); });
+
+    WaypointIndex spatial;
+    spatial.build(std::move(points));
+    std::vector<uint32_t> bands(spatial.bandOffsets(), spatial.bandOffsets() + WaypointIndex::BAND_COUNT + 1);
+    std::vector<WaypointIndex::Entry> entries(spatial.entries(), spatial.entries() + spatial.size());
+
+    std::vector<uint8_t> image(sizeof(NavdataPackHeader), 0);
+    appendSection(image, header, NAVDATA_SECTION_STRINGS, strings.bytes());
+    appendSection(image, header, NAVDATA_SECTION_WAYPOINTS, waypointRecords);
+    appendSection(image, header, NAVDATA_SECTION_WAYPOINT_HASH, waypointHash);
+    appendSection(image, header, NAVDATA_SECTION_AIRWAYS, airwayRecords);
+    appendSection(image, header, NAVDATA_SECTION_AIRWAY_HASH, airwayHash);
+    appendSection(image, header, NAVDATA_SECTION_AIRWAY_FIXES, fixes);
+    appendSection(image, header, NAVDATA_SECTION_EDGE_OFFSETS, edgeOffsets);
+    appendSection(image, header, NAVDATA_SECTION_EDGES, edges);
+    appendSection(image, header, NAVDATA_SECTION_SPATIAL_BANDS, bands);
+    appendSection(image, header, NAVDATA_SECTION_SPATIAL_ENTRIES, entries);
+
+    header.fileSize = image.size();
+    header.checksum = checksum(image.data() + sizeof(NavdataPackHeader), image.size() - sizeof(NavdataPackHeader));
+    std::memcpy(image.data(), &header, sizeof(header));
+    return image;
+}
+
+bool NavdataPackBuilder::write(const std::string& path) const {
+    std::vector<uint8_t> image = build();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "NavdataPackBuilder: Cannot write " << path << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    return static_cast<bool>(out);
+}
+
+// ============================================================================
+// NavdataPack
+// ============================================================================
+
+NavdataPack::~NavdataPack() {
+    close();
+}
+
+bool NavdataPack::isPackFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {0};
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool NavdataPack::open(const std::string& path, bool verifyChecksum) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || static_cast<size_t>(size.QuadPart) < sizeof(NavdataPackHeader)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle_ = file;
+    mappingHandle_ = mapping;
+    size_ = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(NavdataPackHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // the mapping keeps the file referenced
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    madvise(view, static_cast<size_t>(st.st_size), MADV_RANDOM);
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+
+    data_ = static_cast<const uint8_t*>(view);
+    if (!validate(verifyChecksum)) {
+        std::cerr << "NavdataPack: " << path << " is not a valid navdata pack" << std::endl;
+        close();
+        return false;
+    }
+    attachIndex();
+    return true;
+}
+
+bool NavdataPack::openImage(std::vector<uint8_t> image) {
+    close();
+    if (image.size() < sizeof(NavdataPackHeader)) {
+        return false;
+    }
+
+    image_ = std::move(image);
+    data_ = image_.data();
+    size_ = image_.size();
+    if (!validate(true)) {
+        std::cerr << "NavdataPack: image is not a valid navdata pack" << std::endl;
+        close();
+        return false;
+    }
+    attachIndex();
+    return true;
+}
+
+void NavdataPack::close() {
+    spatialIndex_.clear();
+    if (data_ != nullptr && image_.empty()) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(static_cast<HANDLE>(mappingHandle_));
+        CloseHandle(static_cast<HANDLE>(fileHandle_));
+#else
+        munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+    image_.clear();
+    image_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+    fileHandle_ = nullptr;
+    mappingHandle_ = nullptr;
+}
+
+bool NavdataPack::save(const std::string& path) const {
+    if (!isOpen()) return false;
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(data_), static_cast<std::streamsize>(size_));
+    return static_cast<bool>(out);
+}
+
+bool NavdataPack::validate(bool verifyChecksum) const {
+    const NavdataPackHeader& h = header();
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != VERSION) return false;
+    if (h.headerSize != sizeof(NavdataPackHeader) || h.fileSize != size_) return false;
+    if (h.waypointBuckets == 0 || (h.waypointBuckets & (h.waypointBuckets - 1)) != 0) return false;
+    if (h.airwayBuckets == 0 || (h.airwayBuckets & (h.airwayBuckets - 1)) != 0) return false;
+
+    const uint64_t expected[NAVDATA_SECTION_COUNT] = {
+        h.sections[NAVDATA_SECTION_STRINGS].size,
+        uint64_t(h.waypointCount) * sizeof(NavdataPackWaypoint),
+        uint64_t(h.waypointBuckets) * sizeof(uint32_t),
+        uint64_t(h.airwayCount) * sizeof(NavdataPackAirway),
+        uint64_t(h.airwayBuckets) * sizeof(uint32_t),
+        uint64_t(h.airwayFixCount) * sizeof(NavdataPackFix),
+        (uint64_t(h.waypointCount) + 1) * sizeof(uint32_t),
+        uint64_t(h.edgeCount) * sizeof(NavdataPackEdge),
+        uint64_t(WaypointIndex::BAND_COUNT + 1) * sizeof(uint32_t),
+        uint64_t(h.waypointCount) * sizeof(WaypointIndex::Entry),
+    };
+    for (uint32_t id = 0; id < NAVDATA_SECTION_COUNT; ++id) {
+        const NavdataPackSection& s = h.sections[id];
+        if (s.size != expected[id] || s.offset % 8 != 0 || s.offset < sizeof(NavdataPackHeader)) return false;
+        if (s.offset > size_ || s.size > size_ - s.offset) return false;
+    }
+    if (edgeOffsets()[h.waypointCount] != h.edgeCount) return false;
+    if (section<uint32_t>(NAVDATA_SECTION_SPATIAL_BANDS)[WaypointIndex::BAND_COUNT] != h.waypointCount) return false;
+
+    if (verifyChecksum &&
+        checksum(data_ + sizeof(NavdataPackHeader), size_ - sizeof(NavdataPackHeader)) != h.checksum) {
+        return false;
+    }
+    return true;
+}
+
+void NavdataPack::attachIndex() {
+    spatialIndex_.attach(section<WaypointIndex::Entry>(NAVDATA_SECTION_SPATIAL_ENTRIES),
+                         header().waypointCount,
+                         section<uint32_t>(NAVDATA_SECTION_SPATIAL_BANDS));
+}
+
+std::string_view NavdataPack::getString(const NavdataPackString& ref) const {
+    const NavdataPackSection& s = header().sections[NAVDATA_SECTION_STRINGS];
+    if (ref.offset > s.size || ref.length > s.size - ref.offset) return std::string_view();
+    return std::string_view(reinterpret_cast<const char*>(data_ + s.offset + ref.offset), ref.length);
+}
+
+uint32_t NavdataPack::findWaypoint(std::string_view name) const {
+    if (!isOpen()) return NO_INDEX;
+    const NavdataPackHeader& h = header();
+    const uint32_t* table = section<uint32_t>(NAVDATA_SECTION_WAYPOINT_HASH);
+    const uint32_t mask = h.waypointBuckets - 1;
+    for (uint32_t slot = hashName(name) & mask, probes = 0; probes < h.waypointBuckets;
+         slot = (slot + 1) & mask, ++probes) {
+        uint32_t node = table[slot];
+        if (node >= h.waypointCount) return NO_INDEX;
+        if (getWaypointName(node) == name) return node;
+    }
+    return NO_INDEX;
+}
+
+uint32_t NavdataPack::findAirway(std::string_view name) const {
+    if (!isOpen()) return NO_INDEX;
+    const NavdataPackHeader& h = header();
+    const uint32_t* table = section<uint32_t>(NAVDATA_SECTION_AIRWAY_HASH);
+    const uint32_t mask = h.airwayBuckets - 1;
+    for (uint32_t slot = hashName(name) & mask, probes = 0; probes < h.airwayBuckets;
+         slot = (slot + 1) & mask, ++probes) {
+        uint32_t airway = table[slot];
+        if (airway >= h.airwayCount) return NO_INDEX;
+        if (getString(airways()[airway].name) == name) return airway;
+    }
+    return NO_INDEX;
+}
+
+NavdataWaypoint NavdataPack::getWaypoint(uint32_t node) const {
+    const NavdataPackWaypoint& record = waypoints()[node];
+    NavdataWaypoint wp(std::string(getString(record.nameRef())), record.latitude(), record.longitude(),
+                record.navaidType(), record.elevation(), record.frequency(),
+                std::string(getString(record.regionRef())));
+    wp.magneticVariation = record.magneticVariation();
+    wp.range = record.range();
+    wp.purpose = record.purpose();
+    wp.isUsable = record.usable();
+    return wp;
+}
+
+const NavdataPackFix* NavdataPack::getAirwayFixes(uint32_t airway) const {
+    return section<NavdataPackFix>(NAVDATA_SECTION_AIRWAY_FIXES) + airways()[airway].firstFix;
+}
+
+Airway NavdataPack::getAirway(uint32_t airway) const {
+    const NavdataPackAirway& record = airways()[airway];
+    Airway result(std::string(getString(record.name)), record.minimumAltitude, record.maximumAltitude,
+                  static_cast<AirwayLevel>(record.level));
+    result.isActive = record.active != 0;
+    result.description = std::string(getString(record.description));
+
+    const NavdataPackFix* fixes = getAirwayFixes(airway);
+    result.waypointSequence.reserve(record.fixCount);
+    for (uint32_t i = 0; i < record.fixCount; ++i) {
+        result.waypointSequence.emplace_back(getString(fixes[i].name));
+        if (i > 0) result.distances.push_back(fixes[i].legDistanceNM);
+    }
+    return result;
+}
+
+// ============================================================================
+// Waypoint views
+// ============================================================================
+
+const NavdataPackWaypoint& NavdataWaypointView::record() const {
+    return pack_->getWaypointRecord(node_);
+}
+
+std::string_view NavdataWaypointView::name() const {
+    return pack_->getWaypointName(node_);
+}
+
+std::string_view NavdataWaypointView::region() const {
+    return pack_->getString(record().regionRef());
+}
+
+NavdataWaypoint NavdataWaypointView::materialize() const {
+    return pack_->getWaypoint(node_);
+}
+
+std::vector<NavdataWaypoint> NavdataWaypointList::materialize() const {
+    std::vector<NavdataWaypoint> result;
+    result.reserve(nodes_.size());
+    for (uint32_t node : nodes_) {
+        result.push_back(pack_->getWaypoint(node));
+    }
+    return result;
+}
+
+} // namespace AICopilot
@@ -8,23 +8,30 @@
 *****************************************************************************/
 
 #include "navdata_provider.h"
+#include "waypoint_index.hpp"
 #include <algorithm>
+#include <atomic>
 #include <cctype>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <cstring>
 #include <exception>
+#include <filesystem>
 #include <fstream>
-#include <initializer_list>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #ifdef AICOPILOT_HAVE_SIMCONNECT
-#include <windows.h>
-#include <SimConnect.h>
+#include "simconnect_api.hpp"
 #endif
 
 #ifndef M_PI
@@ -41,7 +48,7 @@ struct DefaultAirportRecord {
     double elevation;
     int longestRunway;
     bool towered;
-    std::initializer_list<const char*> runwayIdents;
+    std::vector<const char*> runwayIdents;  // an initializer_list member would dangle
 };
 
 struct DefaultNavaidRecord {
@@ -346,6 +353,288 @@ AICopilot::AirportLayout buildLayoutFromAirport(const AICopilot::AirportInfo& in
     return layout;
 }
 
+std::string toUpper(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) {
+        return static_cast<char>(std::toupper(c));
+    });
+    return value;
+}
+
+// Batch lookup against one of the provider maps, in request order
+template <typename Info>
+size_t lookupBatch(const std::map<std::string, Info>& cache, const std::vector<std::string>& keys,
+                   std::vector<Info>& infos, std::vector<std::string>* misses) {
+    infos.assign(keys.size(), Info{});
+    size_t found = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        std::string normalized = toUpper(keys[i]);
+        auto it = cache.find(normalized);
+        if (it != cache.end()) {
+            infos[i] = it->second;
+            ++found;
+        } else if (misses) {
+            misses->push_back(std::move(normalized));
+        }
+    }
+    return found;
+}
+
+// Spatial index over one of the provider airport maps. Writers call
+// invalidate() after changing the map; the first query after that rebuilds
+// the index under the lock, so concurrent queries stay safe as long as
+// writers are not concurrent with them (the providers' existing rule).
+// Match IDs are positions in ICAO order, so results come back in the map's
+// order like the full scans did.
+class AirportSpatialIndex {
+public:
+    void invalidate() { stale_.store(true, std::memory_order_release); }
+    
+    std::vector<AICopilot::AirportInfo> nearby(const std::map<std::string, AICopilot::AirportInfo>& airports,
+                                               const AICopilot::Position& center, double radiusNM) const {
+        refresh(airports);
+        std::vector<AICopilot::WaypointIndex::Match> matches;
+        index_.queryRadius(center.latitude, center.longitude, radiusNM, matches);
+        std::sort(matches.begin(), matches.end(),
+                  [](const auto& a, const auto& b) { return a.id < b.id; });
+        std::vector<AICopilot::AirportInfo> result;
+        result.reserve(matches.size());
+        for (const auto& match : matches) {
+            result.push_back(*entries_[match.id]);
+        }
+        return result;
+    }
+    
+    bool nearest(const std::map<std::string, AICopilot::AirportInfo>& airports,
+                 const AICopilot::Position& position, AICopilot::AirportInfo& info) const {
+        refresh(airports);
+        std::vector<AICopilot::WaypointIndex::Match> matches;
+        index_.queryNearest(position.latitude, position.longitude, 1, matches);
+        if (matches.empty()) {
+            return false;
+        }
+        info = *entries_[matches.front().id];
+        return true;
+    }
+    
+private:
+    void refresh(const std::map<std::string, AICopilot::AirportInfo>& airports) const {
+        if (!stale_.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stale_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        std::vector<AICopilot::WaypointIndex::Point> points;
+        points.reserve(airports.size());
+        entries_.clear();
+        entries_.reserve(airports.size());
+        for (const auto& pair : airports) {
+            points.push_back({pair.second.position.latitude, pair.second.position.longitude,
+                              static_cast<uint32_t>(entries_.size())});
+            entries_.push_back(&pair.second);
+        }
+        index_.build(std::move(points));
+        stale_.store(false, std::memory_order_release);
+    }
+    
+    mutable std::mutex mutex_;
+    mutable std::atomic<bool> stale_{true};
+    mutable AICopilot::WaypointIndex index_;
+    mutable std::vector<const AICopilot::AirportInfo*> entries_;   // by match ID
+};
+
+// Layout over a fetched source; each part is flattened on first use and
+// the source is freed once every part has taken its share
+std::shared_ptr<const AICopilot::Airport::AirportLayoutData> lazyLayout(AICopilot::AirportLayout fetched) {
+    auto source = std::make_shared<AICopilot::AirportLayout>(std::move(fetched));
+    AICopilot::Airport::AirportLayoutData::Sources sources;
+    sources.runways = [source]() { return std::move(source->runways); };
+    sources.taxiway_network = [source]() { return std::move(source->taxiwayNetwork); };
+    sources.parking = [source]() { return std::move(source->parkingPositions); };
+    return AICopilot::Airport::AirportLayoutData::build_lazy(std::move(sources));
+}
+
+// Shared airport layouts, built on first request and kept while a caller
+// holds one. invalidate() goes with every airport map change, like the
+// spatial index; layouts already handed out stay valid.
+class AirportLayoutCache {
+public:
+    void invalidate() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        layouts_.clear();
+    }
+    
+    std::shared_ptr<const AICopilot::Airport::AirportLayoutData> get(
+        const AICopilot::INavdataProvider& provider, const std::string& icao) const {
+        std::string key = toUpper(icao);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = layouts_.find(key);
+            if (it != layouts_.end()) {
+                if (auto layout = it->second.lock()) return layout;
+            }
+        }
+        
+        // Built unlocked: the provider's lookup may itself invalidate()
+        AICopilot::AirportLayout source;
+        if (!provider.getAirportLayout(key, source)) {
+            return nullptr;
+        }
+        auto layout = lazyLayout(std::move(source));
+        
+        // A racing caller may have stored one first; everyone shares that one
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& slot = layouts_[key];
+        if (auto existing = slot.lock()) return existing;
+        slot = layout;
+        return layout;
+    }
+    
+private:
+    mutable std::mutex mutex_;
+    mutable std::unordered_map<std::string, std::weak_ptr<const AICopilot::Airport::AirportLayoutData>> layouts_;
+};
+
+// Persistent cache file: header, then records appended in write order.
+// Record: kind (u8), payload length (u32), payload, FNV-1a of the payload (u32).
+// Replay stops at the first incomplete or corrupt record, so a torn final
+// append only loses that record.
+constexpr char PERSIST_MAGIC[4] = {'A', 'N', 'P', 'C'};
+constexpr uint16_t PERSIST_VERSION = 1;
+constexpr size_t PERSIST_HEADER_SIZE = 12;          // magic, version, reserved, cycle
+constexpr size_t PERSIST_FLUSH_BYTES = 64 * 1024;   // write-behind buffer
+constexpr size_t PERSIST_COMPACT_MIN_RECORDS = 256;
+constexpr uint8_t PERSIST_AIRPORT = 1;
+constexpr uint8_t PERSIST_NAVAID = 2;
+
+uint32_t fnv1a32(const char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+template <typename T>
+void appendRaw(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void appendString(std::string& out, const std::string& value) {
+    appendRaw(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+void appendPosition(std::string& out, const AICopilot::Position& position) {
+    appendRaw(out, position.latitude);
+    appendRaw(out, position.longitude);
+    appendRaw(out, position.altitude);
+    appendRaw(out, position.heading);
+}
+
+class RecordReader {
+public:
+    RecordReader(const char* data, size_t size) : cur_(data), end_(data + size) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (static_cast<size_t>(end_ - cur_) < sizeof(T)) return false;
+        std::memcpy(&value, cur_, sizeof(T));
+        cur_ += sizeof(T);
+        return true;
+    }
+
+    bool readString(std::string& value) {
+        uint32_t length = 0;
+        if (!read(length) || static_cast<size_t>(end_ - cur_) < length) return false;
+        value.assign(cur_, length);
+        cur_ += length;
+        return true;
+    }
+
+    bool readPosition(AICopilot::Position& position) {
+        return read(position.latitude) && read(position.longitude) &&
+               read(position.altitude) && read(position.heading);
+    }
+
+    bool atEnd() const { return cur_ == end_; }
+
+private:
+    const char* cur_;
+    const char* end_;
+};
+
+void appendRecord(std::string& out, uint8_t kind, const std::string& payload) {
+    appendRaw(out, kind);
+    appendRaw(out, static_cast<uint32_t>(payload.size()));
+    out.append(payload);
+    appendRaw(out, fnv1a32(payload.data(), payload.size()));
+}
+
+void appendAirportRecord(std::string& out, const AICopilot::AirportInfo& info) {
+    std::string payload;
+    appendString(payload, info.icao);
+    appendString(payload, info.iata);
+    appendString(payload, info.name);
+    appendPosition(payload, info.position);
+    appendRaw(payload, info.elevation);
+    appendRaw(payload, static_cast<int32_t>(info.longestRunway));
+    appendRaw(payload, static_cast<uint8_t>(info.towered ? 1 : 0));
+    appendRaw(payload, static_cast<uint32_t>(info.runways.size()));
+    for (const auto& runway : info.runways) {
+        appendString(payload, runway);
+    }
+    appendRecord(out, PERSIST_AIRPORT, payload);
+}
+
+void appendNavaidRecord(std::string& out, const AICopilot::NavaidInfo& info) {
+    std::string payload;
+    appendString(payload, info.id);
+    appendString(payload, info.name);
+    appendString(payload, info.type);
+    appendPosition(payload, info.position);
+    appendRaw(payload, info.frequency);
+    appendRaw(payload, info.range);
+    appendRaw(payload, info.magneticVariation);
+    appendRecord(out, PERSIST_NAVAID, payload);
+}
+
+bool parseAirportRecord(RecordReader& in, AICopilot::AirportInfo& info) {
+    int32_t longestRunway = 0;
+    uint8_t towered = 0;
+    uint32_t runwayCount = 0;
+    if (!in.readString(info.icao) || !in.readString(info.iata) || !in.readString(info.name) ||
+        !in.readPosition(info.position) || !in.read(info.elevation) || !in.read(longestRunway) ||
+        !in.read(towered) || !in.read(runwayCount)) {
+        return false;
+    }
+    info.longestRunway = longestRunway;
+    info.towered = towered != 0;
+    info.runways.clear();
+    for (uint32_t i = 0; i < runwayCount; ++i) {
+        std::string runway;
+        if (!in.readString(runway)) return false;
+        info.runways.push_back(std::move(runway));
+    }
+    return in.atEnd() && !info.icao.empty();
+}
+
+bool parseNavaidRecord(RecordReader& in, AICopilot::NavaidInfo& info) {
+    return in.readString(info.id) && in.readString(info.name) && in.readString(info.type) &&
+           in.readPosition(info.position) && in.read(info.frequency) && in.read(info.range) &&
+           in.read(info.magneticVariation) && in.atEnd() && !info.id.empty();
+}
+
+std::string persistHeader(uint32_t airacCycle) {
+    std::string header(PERSIST_MAGIC, sizeof(PERSIST_MAGIC));
+    appendRaw(header, PERSIST_VERSION);
+    appendRaw(header, static_cast<uint16_t>(0));
+    appendRaw(header, airacCycle);
+    return header;
+}
+
 } // namespace
 
 namespace AICopilot {
@@ -365,6 +654,46 @@ static double calculateDistance(const Position& a, const Position& b) {
     return R * c;
 }
 
+//=============================================================================
+// INavdataProvider defaults
+//=============================================================================
+
+size_t INavdataProvider::getAirportsByICAO(const std::vector<std::string>& icaos,
+                                           std::vector<AirportInfo>& infos) const {
+    infos.assign(icaos.size(), AirportInfo{});
+    size_t found = 0;
+    for (size_t i = 0; i < icaos.size(); ++i) {
+        if (getAirportByICAO(icaos[i], infos[i])) {
+            ++found;
+        } else {
+            infos[i] = AirportInfo{};
+        }
+    }
+    return found;
+}
+
+std::shared_ptr<const Airport::AirportLayoutData> INavdataProvider::getSharedAirportLayout(const std::string& icao) const {
+    AirportLayout layout;
+    if (!getAirportLayout(icao, layout)) {
+        return nullptr;
+    }
+    return lazyLayout(std::move(layout));
+}
+
+size_t INavdataProvider::getNavaidsByID(const std::vector<std::string>& ids,
+                                        std::vector<NavaidInfo>& infos) const {
+    infos.assign(ids.size(), NavaidInfo{});
+    size_t found = 0;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        if (getNavaidByID(ids[i], infos[i])) {
+            ++found;
+        } else {
+            infos[i] = NavaidInfo{};
+        }
+    }
+    return found;
+}
+
 //=============================================================================
 // SimConnectNavdataProvider implementation
 //=============================================================================
@@ -372,6 +701,9 @@ static double calculateDistance(const Position& a, const Position& b) {
 class SimConnectNavdataProvider::Impl {
 public:
     void* hSimConnect = nullptr;
+#ifdef AICOPILOT_HAVE_SIMCONNECT
+    const SimConnectApi* api = nullptr;  // client that opened an owned handle
+#endif
     bool ready = false;
     bool ownHandle = false; // Track if we created the handle
     bool defaultsLoaded = false;
@@ -379,14 +711,141 @@ public:
     // Cache for facility data
     std::map<std::string, AirportInfo> airportCache;
     std::map<std::string, NavaidInfo> navaidCache;
+    AirportSpatialIndex airportIndex;   // over airportCache
+    AirportLayoutCache layoutCache;     // from airportCache
 
     void ensureDefaultData() {
         if (!defaultsLoaded) {
             populateDefaultAirports(airportCache);
+            airportIndex.invalidate();
+            layoutCache.invalidate();
             populateDefaultNavaids(navaidCache);
             defaultsLoaded = true;
         }
     }
+    
+    // One in-flight lookup; every requester of the same key shares it
+    template <typename Info>
+    struct Pending {
+        std::promise<Info> promise;
+        std::shared_future<Info> future = promise.get_future().share();
+        std::vector<std::function<void(const Info&)>> callbacks;
+    };
+    
+    template <typename Info>
+    struct LookupQueue {
+        std::unordered_map<std::string, std::shared_ptr<Pending<Info>>> inFlight;
+        std::deque<std::string> order;
+    };
+    
+    // Async lookups, serviced by lookupThread
+    std::mutex lookupMutex;
+    std::condition_variable lookupCv;
+    LookupQueue<AirportInfo> airportLookups;
+    LookupQueue<NavaidInfo> navaidLookups;
+    std::thread lookupThread;
+    bool lookupStopping = false;
+    
+    // Caller holds lookupMutex
+    template <typename Info>
+    std::shared_ptr<Pending<Info>> enqueue(LookupQueue<Info>& queue, const std::string& key) {
+        auto& pending = queue.inFlight[key];
+        if (!pending) {
+            pending = std::make_shared<Pending<Info>>();
+            queue.order.push_back(key);
+            if (!lookupThread.joinable()) {
+                lookupStopping = false;
+                lookupThread = std::thread(&Impl::lookupLoop, this);
+            }
+            lookupCv.notify_one();
+        }
+        return pending;
+    }
+    
+    template <typename Info>
+    static void complete(const std::shared_ptr<Pending<Info>>& pending, const Info& info) {
+        pending->promise.set_value(info);
+        for (const auto& callback : pending->callbacks) {
+            callback(info);
+        }
+    }
+    
+    // Facility requests would be issued and their replies dispatched here;
+    // until then lookups resolve from the facility cache.
+    AirportInfo resolveAirport(const std::string& icao) const {
+        auto it = airportCache.find(icao);
+        return it != airportCache.end() ? it->second : AirportInfo{};
+    }
+    
+    NavaidInfo resolveNavaid(const std::string& id) const {
+        auto it = navaidCache.find(id);
+        return it != navaidCache.end() ? it->second : NavaidInfo{};
+    }
+    
+    void lookupLoop() {
+        std::unique_lock<std::mutex> lock(lookupMutex);
+        while (true) {
+            lookupCv.wait(lock, [this] {
+                return lookupStopping || !airportLookups.order.empty() || !navaidLookups.order.empty();
+            });
+            if (lookupStopping) {
+                break;
+            }
+            
+            if (!airportLookups.order.empty()) {
+                std::string key = std::move(airportLookups.order.front());
+                airportLookups.order.pop_front();
+                lock.unlock();
+                AirportInfo info = resolveAirport(key);
+                lock.lock();
+                auto pending = takeInFlight(airportLookups, key);
+                lock.unlock();
+                complete(pending, info);
+                lock.lock();
+            } else {
+                std::string key = std::move(navaidLookups.order.front());
+                navaidLookups.order.pop_front();
+                lock.unlock();
+                NavaidInfo info = resolveNavaid(key);
+                lock.lock();
+                auto pending = takeInFlight(navaidLookups, key);
+                lock.unlock();
+                complete(pending, info);
+                lock.lock();
+            }
+        }
+    }
+    
+    // Caller holds lookupMutex; later requests for the key start a new lookup
+    template <typename Info>
+    static std::shared_ptr<Pending<Info>> takeInFlight(LookupQueue<Info>& queue, const std::string& key) {
+        auto it = queue.inFlight.find(key);
+        std::shared_ptr<Pending<Info>> pending = std::move(it->second);
+        queue.inFlight.erase(it);
+        return pending;
+    }
+    
+    // Stops the lookup thread and completes anything still queued as not found
+    void stopLookups() {
+        {
+            std::lock_guard<std::mutex> lock(lookupMutex);
+            lookupStopping = true;
+        }
+        lookupCv.notify_all();
+        if (lookupThread.joinable()) {
+            lookupThread.join();
+        }
+        
+        LookupQueue<AirportInfo> airports;
+        LookupQueue<NavaidInfo> navaids;
+        {
+            std::lock_guard<std::mutex> lock(lookupMutex);
+            std::swap(airports, airportLookups);
+            std::swap(navaids, navaidLookups);
+        }
+        for (const auto& pair : airports.inFlight) complete(pair.second, AirportInfo{});
+        for (const auto& pair : navaids.inFlight) complete(pair.second, NavaidInfo{});
+    }
 };
 
 SimConnectNavdataProvider::SimConnectNavdataProvider() : pImpl(std::make_unique<Impl>()) {
@@ -401,10 +860,12 @@ bool SimConnectNavdataProvider::initialize() {
 #ifdef AICOPILOT_HAVE_SIMCONNECT
     if (!pImpl->hSimConnect) {
         // Try to create our own SimConnect connection
-        HRESULT hr = SimConnect_Open((HANDLE*)&pImpl->hSimConnect, 
+        const SimConnectApi* api = getSimConnectApi(SimulatorType::UNKNOWN);
+        HRESULT hr = api ? api->Open((HANDLE*)&pImpl->hSimConnect, 
                                      "AICopilot NavdataProvider", 
-                                     nullptr, 0, 0, 0);
+                                     nullptr, 0, 0, 0) : E_FAIL;
         if (SUCCEEDED(hr)) {
+            pImpl->api = api;
             pImpl->ownHandle = true;
             pImpl->ready = true;
             std::cout << "SimConnectNavdataProvider: Successfully connected to SimConnect" << std::endl;
@@ -434,15 +895,18 @@ bool SimConnectNavdataProvider::initialize() {
 }
 
 void SimConnectNavdataProvider::shutdown() {
+    pImpl->stopLookups();
 #ifdef AICOPILOT_HAVE_SIMCONNECT
     if (pImpl->hSimConnect && pImpl->ownHandle) {
-        SimConnect_Close((HANDLE)pImpl->hSimConnect);
+        pImpl->api->Close((HANDLE)pImpl->hSimConnect);
         pImpl->hSimConnect = nullptr;
     }
 #endif
     pImpl->ready = false;
     pImpl->defaultsLoaded = false;
     pImpl->airportCache.clear();
+    pImpl->airportIndex.invalidate();
+    pImpl->layoutCache.invalidate();
     pImpl->navaidCache.clear();
 }
 
@@ -450,7 +914,7 @@ bool SimConnectNavdataProvider::isReady() const {
     return pImpl->ready;
 }
 
-bool SimConnectNavdataProvider::getAirportByICAO(const std::string& icao, AirportInfo& info) {
+bool SimConnectNavdataProvider::getAirportByICAO(const std::string& icao, AirportInfo& info) const {
     if (!pImpl->ready) {
         return false;
     }
@@ -478,7 +942,7 @@ bool SimConnectNavdataProvider::getAirportByICAO(const std::string& icao, Airpor
     return false;
 }
 
-std::vector<AirportInfo> SimConnectNavdataProvider::getAirportsNearby(const Position& center, double radiusNM) {
+std::vector<AirportInfo> SimConnectNavdataProvider::getAirportsNearby(const Position& center, double radiusNM) const {
     std::vector<AirportInfo> result;
     
     if (!pImpl->ready) {
@@ -486,18 +950,10 @@ std::vector<AirportInfo> SimConnectNavdataProvider::getAirportsNearby(const Posi
     }
     pImpl->ensureDefaultData();
     
-    // Search cache
-    for (const auto& pair : pImpl->airportCache) {
-        double dist = calculateDistance(center, pair.second.position);
-        if (dist <= radiusNM) {
-            result.push_back(pair.second);
-        }
-    }
-    
-    return result;
+    return pImpl->airportIndex.nearby(pImpl->airportCache, center, radiusNM);
 }
 
-bool SimConnectNavdataProvider::getNavaidByID(const std::string& id, NavaidInfo& info) {
+bool SimConnectNavdataProvider::getNavaidByID(const std::string& id, NavaidInfo& info) const {
     if (!pImpl->ready) {
         return false;
     }
@@ -514,7 +970,7 @@ bool SimConnectNavdataProvider::getNavaidByID(const std::string& id, NavaidInfo&
 }
 
 std::vector<NavaidInfo> SimConnectNavdataProvider::getNavaidsNearby(
-    const Position& center, double radiusNM, const std::string& type) {
+    const Position& center, double radiusNM, const std::string& type) const {
     std::vector<NavaidInfo> result;
     
     if (!pImpl->ready) {
@@ -535,28 +991,16 @@ std::vector<NavaidInfo> SimConnectNavdataProvider::getNavaidsNearby(
     return result;
 }
 
-bool SimConnectNavdataProvider::getNearestAirport(const Position& position, AirportInfo& info) {
+bool SimConnectNavdataProvider::getNearestAirport(const Position& position, AirportInfo& info) const {
     if (!pImpl->ready) {
         return false;
     }
     pImpl->ensureDefaultData();
     
-    double minDist = 1e9;
-    bool found = false;
-    
-    for (const auto& pair : pImpl->airportCache) {
-        double dist = calculateDistance(position, pair.second.position);
-        if (dist < minDist) {
-            minDist = dist;
-            info = pair.second;
-            found = true;
-        }
-    }
-    
-    return found;
+    return pImpl->airportIndex.nearest(pImpl->airportCache, position, info);
 }
 
-bool SimConnectNavdataProvider::getAirportLayout(const std::string& icao, AirportLayout& layout) {
+bool SimConnectNavdataProvider::getAirportLayout(const std::string& icao, AirportLayout& layout) const {
     if (!pImpl->ready) {
         return false;
     }
@@ -575,6 +1019,99 @@ bool SimConnectNavdataProvider::getAirportLayout(const std::string& icao, Airpor
     return true;
 }
 
+std::shared_ptr<const Airport::AirportLayoutData> SimConnectNavdataProvider::getSharedAirportLayout(const std::string& icao) const {
+    return pImpl->layoutCache.get(*this, icao);
+}
+
+size_t SimConnectNavdataProvider::getAirportsByICAO(const std::vector<std::string>& icaos,
+                                                    std::vector<AirportInfo>& infos) const {
+    if (!pImpl->ready) {
+        infos.assign(icaos.size(), AirportInfo{});
+        return 0;
+    }
+    pImpl->ensureDefaultData();
+    
+    // Cache hits are answered in one pass; misses are collected so they can
+    // go out together instead of one facility round trip per code
+    std::vector<std::string> misses;
+    size_t found = lookupBatch(pImpl->airportCache, icaos, infos, &misses);
+    
+#ifdef USE_MSFS2024_SDK
+    if (pImpl->hSimConnect && !misses.empty()) {
+        std::cout << "SimConnectNavdataProvider::getAirportsByICAO - " << misses.size()
+                  << " not cached, SimConnect facility lookup not yet implemented" << std::endl;
+    }
+#endif
+    
+    return found;
+}
+
+size_t SimConnectNavdataProvider::getNavaidsByID(const std::vector<std::string>& ids,
+                                                 std::vector<NavaidInfo>& infos) const {
+    if (!pImpl->ready) {
+        infos.assign(ids.size(), NavaidInfo{});
+        return 0;
+    }
+    pImpl->ensureDefaultData();
+    
+    // Navaid IDs are looked up as given, like getNavaidByID()
+    infos.assign(ids.size(), NavaidInfo{});
+    size_t found = 0;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        auto it = pImpl->navaidCache.find(ids[i]);
+        if (it != pImpl->navaidCache.end()) {
+            infos[i] = it->second;
+            ++found;
+        }
+    }
+    
+    return found;
+}
+
+std::shared_future<AirportInfo> SimConnectNavdataProvider::getAirportByICAOAsync(const std::string& icao) const {
+    if (!pImpl->ready) {
+        std::promise<AirportInfo> notFound;
+        notFound.set_value(AirportInfo{});
+        return notFound.get_future().share();
+    }
+    
+    std::lock_guard<std::mutex> lock(pImpl->lookupMutex);
+    return pImpl->enqueue(pImpl->airportLookups, toUpper(icao))->future;
+}
+
+void SimConnectNavdataProvider::getAirportByICAOAsync(const std::string& icao,
+                                                      std::function<void(const AirportInfo&)> onComplete) const {
+    if (!pImpl->ready) {
+        onComplete(AirportInfo{});
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(pImpl->lookupMutex);
+    pImpl->enqueue(pImpl->airportLookups, toUpper(icao))->callbacks.push_back(std::move(onComplete));
+}
+
+std::shared_future<NavaidInfo> SimConnectNavdataProvider::getNavaidByIDAsync(const std::string& id) const {
+    if (!pImpl->ready) {
+        std::promise<NavaidInfo> notFound;
+        notFound.set_value(NavaidInfo{});
+        return notFound.get_future().share();
+    }
+    
+    std::lock_guard<std::mutex> lock(pImpl->lookupMutex);
+    return pImpl->enqueue(pImpl->navaidLookups, id)->future;
+}
+
+void SimConnectNavdataProvider::getNavaidByIDAsync(const std::string& id,
+                                                   std::function<void(const NavaidInfo&)> onComplete) const {
+    if (!pImpl->ready) {
+        onComplete(NavaidInfo{});
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(pImpl->lookupMutex);
+    pImpl->enqueue(pImpl->navaidLookups, id)->callbacks.push_back(std::move(onComplete));
+}
+
 void SimConnectNavdataProvider::setSimConnectHandle(void* hSimConnect) {
     pImpl->hSimConnect = hSimConnect;
 }
@@ -587,11 +1124,44 @@ class CachedNavdataProvider::Impl {
 public:
     std::map<std::string, AirportInfo> airports;
     std::map<std::string, NavaidInfo> navaids;
+    AirportSpatialIndex airportIndex;   // over airports; invalidate() after every change
+    AirportLayoutCache layoutCache;     // from airports; invalidated with airportIndex
     bool ready = false;
     
+    // Persistent tier; empty path when detached
+    std::string persistPath;
+    std::string pendingRecords;
+    
+    void persist(const AirportInfo& info) {
+        if (persistPath.empty()) return;
+        appendAirportRecord(pendingRecords, info);
+        if (pendingRecords.size() >= PERSIST_FLUSH_BYTES) flushPending();
+    }
+    
+    void persist(const NavaidInfo& info) {
+        if (persistPath.empty()) return;
+        appendNavaidRecord(pendingRecords, info);
+        if (pendingRecords.size() >= PERSIST_FLUSH_BYTES) flushPending();
+    }
+    
+    bool flushPending() {
+        if (persistPath.empty() || pendingRecords.empty()) return true;
+        std::ofstream out(persistPath, std::ios::binary | std::ios::app);
+        out.write(pendingRecords.data(), static_cast<std::streamsize>(pendingRecords.size()));
+        out.flush();
+        if (!out) {
+            std::cerr << "CachedNavdataProvider: Unable to write persistent cache " << persistPath << std::endl;
+            return false;
+        }
+        pendingRecords.clear();
+        return true;
+    }
+    
     void loadDefaultAirports() {
         auto before = airports.size();
         populateDefaultAirports(airports);
+        airportIndex.invalidate();
+        layoutCache.invalidate();
         std::cout << "Loaded " << (airports.size() - before) << " default airports (" << airports.size()
                   << " total)" << std::endl;
     }
@@ -620,6 +1190,8 @@ public:
         info.towered = tower;
         info.runways.clear();
         airports[normalized] = info;
+        airportIndex.invalidate();
+        layoutCache.invalidate();
     }
     
     void addNavaid(const std::string& id, const std::string& name, const std::string& type,
@@ -657,7 +1229,12 @@ bool CachedNavdataProvider::initialize() {
 }
 
 void CachedNavdataProvider::shutdown() {
+    pImpl->flushPending();
+    pImpl->persistPath.clear();
+    pImpl->pendingRecords.clear();
     pImpl->airports.clear();
+    pImpl->airportIndex.invalidate();
+    pImpl->layoutCache.invalidate();
     pImpl->navaids.clear();
     pImpl->ready = false;
 }
@@ -666,7 +1243,7 @@ bool CachedNavdataProvider::isReady() const {
     return pImpl->ready;
 }
 
-bool CachedNavdataProvider::getAirportByICAO(const std::string& icao, AirportInfo& info) {
+bool CachedNavdataProvider::getAirportByICAO(const std::string& icao, AirportInfo& info) const {
     std::string normalized = icao;
     std::transform(normalized.begin(), normalized.end(), normalized.begin(), [](unsigned char c) {
         return static_cast<char>(std::toupper(c));
@@ -679,18 +1256,11 @@ bool CachedNavdataProvider::getAirportByICAO(const std::string& icao, AirportInf
     return false;
 }
 
-std::vector<AirportInfo> CachedNavdataProvider::getAirportsNearby(const Position& center, double radiusNM) {
-    std::vector<AirportInfo> result;
-    for (const auto& pair : pImpl->airports) {
-        double dist = calculateDistance(center, pair.second.position);
-        if (dist <= radiusNM) {
-            result.push_back(pair.second);
-        }
-    }
-    return result;
+std::vector<AirportInfo> CachedNavdataProvider::getAirportsNearby(const Position& center, double radiusNM) const {
+    return pImpl->airportIndex.nearby(pImpl->airports, center, radiusNM);
 }
 
-bool CachedNavdataProvider::getNavaidByID(const std::string& id, NavaidInfo& info) {
+bool CachedNavdataProvider::getNavaidByID(const std::string& id, NavaidInfo& info) const {
     std::string normalized = id;
     std::transform(normalized.begin(), normalized.end(), normalized.begin(), [](unsigned char c) {
         return static_cast<char>(std::toupper(c));
@@ -704,7 +1274,7 @@ bool CachedNavdataProvider::getNavaidByID(const std::string& id, NavaidInfo& inf
 }
 
 std::vector<NavaidInfo> CachedNavdataProvider::getNavaidsNearby(
-    const Position& center, double radiusNM, const std::string& type) {
+    const Position& center, double radiusNM, const std::string& type) const {
     std::vector<NavaidInfo> result;
     for (const auto& pair : pImpl->navaids) {
         if (!type.empty() && pair.second.type != type) {
@@ -718,22 +1288,11 @@ std::vector<NavaidInfo> CachedNavdataProvider::getNavaidsNearby(
     return result;
 }
 
-bool CachedNavdataProvider::getNearestAirport(const Position& position, AirportInfo& info) {
-    double minDist = 1e9;
-    bool found = false;
-    
-    for (const auto& pair : pImpl->airports) {
-        double dist = calculateDistance(position, pair.second.position);
-        if (dist < minDist) {
-            minDist = dist;
-            info = pair.second;
-            found = true;
-        }
-    }
-    return found;
+bool CachedNavdataProvider::getNearestAirport(const Position& position, AirportInfo& info) const {
+    return pImpl->airportIndex.nearest(pImpl->airports, position, info);
 }
 
-bool CachedNavdataProvider::getAirportLayout(const std::string& icao, AirportLayout& layout) {
+bool CachedNavdataProvider::getAirportLayout(const std::string& icao, AirportLayout& layout) const {
     std::string normalized = icao;
     std::transform(normalized.begin(), normalized.end(), normalized.begin(), [](unsigned char c) {
         return static_cast<char>(std::toupper(c));
@@ -748,12 +1307,50 @@ bool CachedNavdataProvider::getAirportLayout(const std::string& icao, AirportLay
     return true;
 }
 
+std::shared_ptr<const Airport::AirportLayoutData> CachedNavdataProvider::getSharedAirportLayout(const std::string& icao) const {
+    return pImpl->layoutCache.get(*this, icao);
+}
+
 void CachedNavdataProvider::addAirport(const AirportInfo& info) {
     pImpl->airports[info.icao] = info;
+    pImpl->airportIndex.invalidate();
+    pImpl->layoutCache.invalidate();
+    pImpl->persist(info);
 }
 
 void CachedNavdataProvider::addNavaid(const NavaidInfo& info) {
     pImpl->navaids[info.id] = info;
+    pImpl->persist(info);
+}
+
+size_t CachedNavdataProvider::getAirportsByICAO(const std::vector<std::string>& icaos,
+                                                std::vector<AirportInfo>& infos) const {
+    return lookupBatch(pImpl->airports, icaos, infos, nullptr);
+}
+
+size_t CachedNavdataProvider::getNavaidsByID(const std::vector<std::string>& ids,
+                                             std::vector<NavaidInfo>& infos) const {
+    return lookupBatch(pImpl->navaids, ids, infos, nullptr);
+}
+
+void CachedNavdataProvider::addAirports(const std::vector<AirportInfo>& infos) {
+    for (const auto& info : infos) {
+        if (!info.icao.empty()) {
+            pImpl->airports[info.icao] = info;
+            pImpl->persist(info);
+        }
+    }
+    pImpl->airportIndex.invalidate();
+    pImpl->layoutCache.invalidate();
+}
+
+void CachedNavdataProvider::addNavaids(const std::vector<NavaidInfo>& infos) {
+    for (const auto& info : infos) {
+        if (!info.id.empty()) {
+            pImpl->navaids[info.id] = info;
+            pImpl->persist(info);
+        }
+    }
 }
 
 bool CachedNavdataProvider::loadAirportsFromFile(const std::string& filePath) {
@@ -823,11 +1420,14 @@ bool CachedNavdataProvider::loadAirportsFromFile(const std::string& filePath) {
             }
 
             pImpl->airports[normalized] = info;
+            pImpl->persist(info);
             ++loadedCount;
         } catch (const std::exception& ex) {
             std::cerr << "CachedNavdataProvider: Skipping row due to parse error - " << ex.what() << std::endl;
         }
     }
+    pImpl->airportIndex.invalidate();
+    pImpl->layoutCache.invalidate();
 
     if (loadedCount > 0) {
         std::cout << "CachedNavdataProvider: Loaded " << loadedCount << " airport entries from file" << std::endl;
@@ -838,4 +1438,105 @@ bool CachedNavdataProvider::loadAirportsFromFile(const std::string& filePath) {
     return false;
 }
 
+bool CachedNavdataProvider::enablePersistentCache(const std::string& filePath, uint32_t airacCycle) {
+    pImpl->flushPending();
+    pImpl->persistPath.clear();
+    pImpl->pendingRecords.clear();
+    
+    std::string contents;
+    {
+        std::ifstream input(filePath, std::ios::binary);
+        if (input.is_open()) {
+            std::ostringstream buffer;
+            buffer << input.rdbuf();
+            contents = buffer.str();
+        }
+    }
+    
+    const std::string header = persistHeader(airacCycle);
+    std::map<std::string, AirportInfo> logAirports;
+    std::map<std::string, NavaidInfo> logNavaids;
+    size_t records = 0;
+    size_t goodEnd = 0;
+    
+    if (contents.size() >= PERSIST_HEADER_SIZE && contents.compare(0, PERSIST_HEADER_SIZE, header) == 0) {
+        goodEnd = PERSIST_HEADER_SIZE;
+        RecordReader file(contents.data() + goodEnd, contents.size() - goodEnd);
+        while (true) {
+            uint8_t kind = 0;
+            uint32_t length = 0;
+            uint32_t checksum = 0;
+            if (!file.read(kind) || !file.read(length) ||
+                contents.size() - goodEnd < sizeof(kind) + sizeof(length) + length + sizeof(checksum)) {
+                break;
+            }
+            const char* payload = contents.data() + goodEnd + sizeof(kind) + sizeof(length);
+            std::memcpy(&checksum, payload + length, sizeof(checksum));
+            if (checksum != fnv1a32(payload, length)) {
+                break;
+            }
+            
+            RecordReader record(payload, length);
+            if (kind == PERSIST_AIRPORT) {
+                AirportInfo info{};
+                if (!parseAirportRecord(record, info)) break;
+                logAirports[info.icao] = std::move(info);
+            } else if (kind == PERSIST_NAVAID) {
+                NavaidInfo info{};
+                if (!parseNavaidRecord(record, info)) break;
+                logNavaids[info.id] = std::move(info);
+            } else {
+                break;
+            }
+            
+            records++;
+            goodEnd += sizeof(kind) + sizeof(length) + length + sizeof(checksum);
+            file = RecordReader(contents.data() + goodEnd, contents.size() - goodEnd);
+        }
+    } else if (!contents.empty()) {
+        std::cout << "CachedNavdataProvider: Discarding persistent cache from another AIRAC cycle" << std::endl;
+    }
+    
+    // Rewrite the file when it is new, stale, torn, or mostly superseded records
+    size_t live = logAirports.size() + logNavaids.size();
+    bool rewrite = goodEnd == 0 || goodEnd != contents.size() ||
+                   (records >= PERSIST_COMPACT_MIN_RECORDS && records > 2 * live);
+    if (rewrite) {
+        std::string image = header;
+        for (const auto& pair : logAirports) appendAirportRecord(image, pair.second);
+        for (const auto& pair : logNavaids) appendNavaidRecord(image, pair.second);
+        
+        std::error_code ec;
+        const std::string temporary = filePath + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            out.write(image.data(), static_cast<std::streamsize>(image.size()));
+            if (!out) {
+                std::cerr << "CachedNavdataProvider: Unable to write persistent cache " << filePath << std::endl;
+                return false;
+            }
+        }
+        std::filesystem::rename(temporary, filePath, ec);
+        if (ec) {
+            std::cerr << "CachedNavdataProvider: Unable to replace persistent cache " << filePath
+                      << " (" << ec.message() << ")" << std::endl;
+            return false;
+        }
+    }
+    
+    for (auto& pair : logAirports) pImpl->airports[pair.first] = std::move(pair.second);
+    pImpl->airportIndex.invalidate();
+    pImpl->layoutCache.invalidate();
+    for (auto& pair : logNavaids) pImpl->navaids[pair.first] = std::move(pair.second);
+    pImpl->persistPath = filePath;
+    
+    std::cout << "CachedNavdataProvider: Warmed " << logAirports.size() << " airports and "
+              << logNavaids.size() << " navaids from persistent cache (AIRAC " << airacCycle << ")" << std::endl;
+    return true;
+}
+
+bool CachedNavdataProvider::flushPersistentCache() {
+    return pImpl->flushPending();
+}
+
 } // namespace AICopilot
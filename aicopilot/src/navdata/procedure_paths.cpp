@@ -0,0 +1,217 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Procedure Paths Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../../include/procedure_paths.hpp"
+#include "../../include/geodesy.hpp"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+
+namespace AICopilot {
+
+namespace {
+
+// Legs for a fix sequence; constraints are indexed like the procedure's own
+// sequence, which starts at sequenceOffset within fixes
+void expandLegs(const NavdataPack& pack, const std::vector<std::string>& fixes, size_t sequenceOffset,
+                const std::vector<AltitudeRestriction>& altitudes, const std::vector<double>& speeds,
+                ProcedurePath& path) {
+    path.legs.reserve(fixes.size());
+    const ProcedureLeg* previous = nullptr;
+    size_t resolved = 0;
+    for (size_t i = 0; i < fixes.size(); ++i) {
+        ProcedureLeg leg;
+        leg.fix = fixes[i];
+        if (i >= sequenceOffset) {
+            size_t constraint = i - sequenceOffset;
+            if (constraint < altitudes.size()) leg.altitude = altitudes[constraint];
+            if (constraint < speeds.size()) leg.speedLimitKts = speeds[constraint];
+        }
+        leg.node = pack.findWaypoint(fixes[i]);
+        if (leg.node != NavdataPack::NO_INDEX) {
+            const NavdataPackWaypoint& record = pack.getWaypointRecord(leg.node);
+            leg.latitude = record.latitude();
+            leg.longitude = record.longitude();
+            if (previous) {
+                leg.legDistanceNM = Geodesy::haversineNM(previous->latitude, previous->longitude,
+                                                         leg.latitude, leg.longitude);
+                leg.cumulativeNM = previous->cumulativeNM + leg.legDistanceNM;
+            } else {
+                path.entryLatitude = leg.latitude;
+                path.entryLongitude = leg.longitude;
+            }
+            path.exitLatitude = leg.latitude;
+            path.exitLongitude = leg.longitude;
+            resolved++;
+        } else if (previous) {
+            leg.cumulativeNM = previous->cumulativeNM;
+        }
+        path.legs.push_back(leg);
+        if (leg.node != NavdataPack::NO_INDEX) previous = &path.legs.back();
+    }
+    path.hasGeometry = resolved >= 2;
+    if (previous) path.distanceNM = previous->cumulativeNM;
+}
+
+// Widen [bottom, top] to every altitude the legs name
+void applyAltitudeRange(ProcedurePath& path) {
+    for (const auto& leg : path.legs) {
+        if (leg.altitude.type == AltitudeRestrictionType::NONE) continue;
+        for (int altitude : {leg.altitude.altitude1, leg.altitude.altitude2}) {
+            if (altitude <= 0) continue;
+            path.topAltitude = std::max(path.topAltitude, altitude);
+            path.bottomAltitude = path.bottomAltitude > 0 ? std::min(path.bottomAltitude, altitude) : altitude;
+        }
+    }
+}
+
+ProcedurePath expandSID(const NavdataPack& pack, const SID& sid) {
+    ProcedurePath path;
+    path.kind = ProcedureKind::SID;
+    path.airport = sid.airport;
+    path.runway = ProcedurePathTable::normalizeRunway(sid.runway);
+    path.name = sid.name;
+    path.transition = sid.transitionFixName;
+    path.requiresRNAV = sid.requiresRNAV;
+
+    std::vector<std::string> fixes = sid.waypointSequence;
+    if (!sid.transitionFixName.empty() && (fixes.empty() || fixes.back() != sid.transitionFixName)) {
+        fixes.push_back(sid.transitionFixName);
+    }
+    expandLegs(pack, fixes, 0, sid.altitudeRestrictions, sid.speedRestrictions, path);
+    if (!path.hasGeometry) path.distanceNM = sid.procedureDistance;
+    path.topAltitude = path.bottomAltitude = std::max(0, sid.initialAltitude);
+    applyAltitudeRange(path);
+    return path;
+}
+
+ProcedurePath expandSTAR(const NavdataPack& pack, const STAR& star, const std::string& transition) {
+    ProcedurePath path;
+    path.kind = ProcedureKind::STAR;
+    path.airport = star.airport;
+    path.runway = ProcedurePathTable::normalizeRunway(star.runway);
+    path.name = star.name;
+    path.transition = transition;
+    path.requiresRNAV = star.requiresRNAV;
+
+    std::vector<std::string> fixes;
+    size_t offset = 0;
+    if (!transition.empty() && (star.waypointSequence.empty() || star.waypointSequence.front() != transition)) {
+        fixes.push_back(transition);
+        offset = 1;
+    }
+    fixes.insert(fixes.end(), star.waypointSequence.begin(), star.waypointSequence.end());
+    expandLegs(pack, fixes, offset, star.altitudeRestrictions, star.speedRestrictions, path);
+    if (!path.hasGeometry) path.distanceNM = star.procedureDistance;
+    path.topAltitude = std::max({0, star.initialAltitude, star.finalAltitude});
+    path.bottomAltitude = star.finalAltitude > 0 ? star.finalAltitude : path.topAltitude;
+    applyAltitudeRange(path);
+    return path;
+}
+
+} // namespace
+
+void ProcedurePathTable::build(const NavdataPack& pack,
+                               const std::unordered_map<std::string, std::vector<SID>>& sidsByAirport,
+                               const std::unordered_map<std::string, std::vector<STAR>>& starsByAirport) {
+    byAirport_.clear();
+    pathCount_ = 0;
+    for (const auto& entry : sidsByAirport) {
+        auto& paths = byAirport_[entry.first];
+        for (const auto& sid : entry.second) {
+            paths.push_back(expandSID(pack, sid));
+        }
+    }
+    for (const auto& entry : starsByAirport) {
+        auto& paths = byAirport_[entry.first];
+        for (const auto& star : entry.second) {
+            paths.push_back(expandSTAR(pack, star, std::string()));
+            for (const auto& transition : star.transitionFixNames) {
+                if (!transition.empty()) paths.push_back(expandSTAR(pack, star, transition));
+            }
+        }
+    }
+    for (const auto& entry : byAirport_) {
+        pathCount_ += entry.second.size();
+    }
+}
+
+const std::vector<ProcedurePath>* ProcedurePathTable::find(const std::string& airport) const {
+    auto it = byAirport_.find(airport);
+    return it != byAirport_.end() ? &it->second : nullptr;
+}
+
+const ProcedurePath* ProcedurePathTable::bestSID(const std::string& airport, const std::string& runway,
+                                                 double fixLatitude, double fixLongitude) const {
+    return best(ProcedureKind::SID, airport, runway, fixLatitude, fixLongitude);
+}
+
+const ProcedurePath* ProcedurePathTable::bestSTAR(const std::string& airport, const std::string& runway,
+                                                  double latitude, double longitude) const {
+    return best(ProcedureKind::STAR, airport, runway, latitude, longitude);
+}
+
+const ProcedurePath* ProcedurePathTable::best(ProcedureKind kind, const std::string& airport,
+                                              const std::string& runway, double latitude,
+                                              double longitude) const {
+    const std::vector<ProcedurePath>* paths = find(airport);
+    if (!paths) return nullptr;
+
+    const std::string wanted = normalizeRunway(runway);
+    bool runwayMatched = false;
+    if (!wanted.empty()) {
+        for (const auto& path : *paths) {
+            if (path.kind == kind && path.runway == wanted) {
+                runwayMatched = true;
+                break;
+            }
+        }
+    }
+
+    // Shortest off-procedure leg first, then the shorter path; paths without
+    // geometry only when nothing else fits
+    const ProcedurePath* bestPath = nullptr;
+    double bestDirect = std::numeric_limits<double>::infinity();
+    double bestDistance = std::numeric_limits<double>::infinity();
+    for (const auto& path : *paths) {
+        if (path.kind != kind || (runwayMatched && path.runway != wanted)) continue;
+        double direct = std::numeric_limits<double>::max();
+        if (path.hasGeometry) {
+            direct = (kind == ProcedureKind::SID)
+                ? Geodesy::haversineNM(path.exitLatitude, path.exitLongitude, latitude, longitude)
+                : Geodesy::haversineNM(latitude, longitude, path.entryLatitude, path.entryLongitude);
+        }
+        if (direct < bestDirect || (direct == bestDirect && path.distanceNM < bestDistance)) {
+            bestDirect = direct;
+            bestDistance = path.distanceNM;
+            bestPath = &path;
+        }
+    }
+    return bestPath;
+}
+
+std::string ProcedurePathTable::normalizeRunway(const std::string& runway) {
+    std::string result;
+    for (char c : runway) {
+        result.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(c))));
+    }
+    if (result.compare(0, 3, "RWY") == 0) {
+        result.erase(0, 3);
+    } else if (result.compare(0, 2, "RW") == 0) {
+        result.erase(0, 2);
+    }
+    result.erase(std::remove_if(result.begin(), result.end(),
+                                [](char c) { return c == '_' || c == ' ' || c == '-'; }),
+                 result.end());
+    return result;
+}
+
+} // namespace AICopilot
@@ -0,0 +1,56 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Symbol Table Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/symbol_table.hpp"
+#include <mutex>
+
+namespace AICopilot {
+
+SymbolId SymbolTable::intern(std::string_view name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) return it->second;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(name);  // another thread may have added it meanwhile
+    if (it != ids_.end()) return it->second;
+
+    SymbolId id = static_cast<SymbolId>(names_.size());
+    names_.emplace_back(name);
+    ids_.emplace(std::string_view(names_.back()), id);
+    return id;
+}
+
+SymbolId SymbolTable::find(std::string_view name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    return it != ids_.end() ? it->second : INVALID_SYMBOL;
+}
+
+const std::string& SymbolTable::name(SymbolId id) const {
+    static const std::string empty;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return id < names_.size() ? names_[id] : empty;
+}
+
+size_t SymbolTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_.size();
+}
+
+SymbolTable& SymbolTable::navdata() {
+    static SymbolTable table;
+    return table;
+}
+
+} // namespace AICopilot
@@ -0,0 +1,170 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Waypoint Index Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/waypoint_index.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double DEG_TO_RAD = PI / 180.0;
+constexpr double RAD_TO_DEG = 180.0 / PI;
+constexpr double EARTH_RADIUS_NM = 3440.065;
+constexpr double INITIAL_NEAREST_RADIUS_NM = 25.0;
+
+double normalizeLongitude(double longitude) {
+    while (longitude < -180.0) longitude += 360.0;
+    while (longitude >= 180.0) longitude -= 360.0;
+    return longitude;
+}
+
+} // namespace
+
+int WaypointIndex::bandFor(double latitude) {
+    int band = static_cast<int>(std::floor((latitude + 90.0) / BAND_HEIGHT_DEG));
+    return std::max(0, std::min(BAND_COUNT - 1, band));
+}
+
+void WaypointIndex::build(std::vector<Point> points) {
+    entryStorage_.clear();
+    entryStorage_.reserve(points.size());
+    for (const auto& p : points) {
+        double latitude = std::max(-90.0, std::min(90.0, p.latitude));
+        entryStorage_.push_back({latitude, normalizeLongitude(p.longitude),
+                                 std::cos(latitude * DEG_TO_RAD), p.id, 0});
+    }
+
+    std::sort(entryStorage_.begin(), entryStorage_.end(), [](const Entry& a, const Entry& b) {
+        int bandA = bandFor(a.latitude);
+        int bandB = bandFor(b.latitude);
+        if (bandA != bandB) return bandA < bandB;
+        return a.longitude < b.longitude;
+    });
+
+    bandStorage_.assign(BAND_COUNT + 1, 0);
+    for (const auto& e : entryStorage_) {
+        bandStorage_[bandFor(e.latitude) + 1]++;
+    }
+    for (int band = 0; band < BAND_COUNT; ++band) {
+        bandStorage_[band + 1] += bandStorage_[band];
+    }
+
+    points_ = entryStorage_.data();
+    count_ = entryStorage_.size();
+    bandBegin_ = bandStorage_.data();
+}
+
+void WaypointIndex::attach(const Entry* entries, size_t count, const uint32_t* bandOffsets) {
+    entryStorage_.clear();
+    bandStorage_.clear();
+    points_ = entries;
+    count_ = count;
+    bandBegin_ = bandOffsets;
+}
+
+void WaypointIndex::clear() {
+    attach(nullptr, 0, nullptr);
+}
+
+void WaypointIndex::scanRange(const Entry* first, const Entry* last, double latitude,
+                              double cosLatitude, double longitude, double latMin, double latMax,
+                              double radiusNM, std::vector<Match>& out) const {
+    for (const Entry* e = first; e != last; ++e) {
+        // Bounding box first; haversine only for what survives it
+        if (e->latitude < latMin || e->latitude > latMax) continue;
+
+        double sinLat = std::sin((e->latitude - latitude) * DEG_TO_RAD * 0.5);
+        double sinLon = std::sin((e->longitude - longitude) * DEG_TO_RAD * 0.5);
+        double a = sinLat * sinLat + cosLatitude * e->cosLatitude * sinLon * sinLon;
+        double distance = 2.0 * EARTH_RADIUS_NM * std::asin(std::sqrt(std::min(1.0, a)));
+        if (distance <= radiusNM) {
+            out.push_back({e->id, distance});
+        }
+    }
+}
+
+void WaypointIndex::queryRadius(double latitude, double longitude, double radiusNM,
+                                std::vector<Match>& out) const {
+    if (count_ == 0 || !(radiusNM >= 0.0)) return;
+
+    longitude = normalizeLongitude(longitude);
+    double cosLatitude = std::cos(latitude * DEG_TO_RAD);
+    double angle = std::min(radiusNM / EARTH_RADIUS_NM, PI);
+
+    // Great-circle distance is never less than the latitude difference
+    double latPad = angle * RAD_TO_DEG;
+    double latMin = latitude - latPad;
+    double latMax = latitude + latPad;
+
+    // Widest longitude span of the circle; all longitudes once it covers a pole
+    bool allLongitudes = angle + std::fabs(latitude) * DEG_TO_RAD >= PI / 2.0;
+    double lonPad = allLongitudes ? 180.0
+                                  : std::asin(std::sin(angle) / cosLatitude) * RAD_TO_DEG;
+
+    auto lonLess = [](const Entry& e, double lon) { return e.longitude < lon; };
+    for (int band = bandFor(latMin); band <= bandFor(latMax); ++band) {
+        const Entry* first = points_ + bandBegin_[band];
+        const Entry* last = points_ + bandBegin_[band + 1];
+        if (first == last) continue;
+
+        if (allLongitudes) {
+            scanRange(first, last, latitude, cosLatitude, longitude, latMin, latMax, radiusNM, out);
+            continue;
+        }
+
+        // The window can cross the antimeridian: split it into two slices
+        double west = longitude - lonPad;
+        double east = longitude + lonPad;
+        auto scanWindow = [&](double lo, double hi) {
+            const Entry* begin = std::lower_bound(first, last, lo, lonLess);
+            const Entry* end = std::upper_bound(begin, last, hi,
+                [](double lon, const Entry& e) { return lon < e.longitude; });
+            scanRange(begin, end, latitude, cosLatitude, longitude, latMin, latMax, radiusNM, out);
+        };
+        if (west < -180.0) {
+            scanWindow(west + 360.0, 180.0);
+            scanWindow(-180.0, east);
+        } else if (east >= 180.0) {
+            scanWindow(west, 180.0);
+            scanWindow(-180.0, east - 360.0);
+        } else {
+            scanWindow(west, east);
+        }
+    }
+}
+
+void WaypointIndex::queryNearest(double latitude, double longitude, size_t k,
+                                 std::vector<Match>& out, double maxRadiusNM) const {
+    if (count_ == 0 || k == 0 || !(maxRadiusNM >= 0.0)) return;
+
+    // Grow the search circle until it holds k points; everything nearer is then inside it
+    std::vector<Match> found;
+    double radius = std::min(INITIAL_NEAREST_RADIUS_NM, maxRadiusNM);
+    for (;;) {
+        found.clear();
+        queryRadius(latitude, longitude, radius, found);
+        if (found.size() >= k || radius >= maxRadiusNM) break;
+        radius = std::min(radius * 4.0, maxRadiusNM);
+    }
+
+    auto closer = [](const Match& a, const Match& b) {
+        return a.distanceNM < b.distanceNM || (a.distanceNM == b.distanceNM && a.id < b.id);
+    };
+    size_t count = std::min(k, found.size());
+    std::partial_sort(found.begin(), found.begin() + static_cast<std::ptrdiff_t>(count),
+                      found.end(), closer);
+    out.insert(out.end(), found.begin(), found.begin() + static_cast<std::ptrdiff_t>(count));
+}
+
+} // namespace AICopilot
@@ -13,108 +13,111 @@
 *****************************************************************************/
 
 #include "../include/navdata_database.hpp"
+#include "../include/geodesy.hpp"
+#include "../include/io_executor.hpp"
 #include <cmath>
 #include <algorithm>
 #include <sstream>
 #include <queue>
 #include <limits>
 #include <chrono>
+#include <iostream>
 #include <unordered_map>
 
 namespace AICopilot {
 
-constexpr double PI = 3.14159265358979323846;
-constexpr double EARTH_RADIUS_NM = 3440.065;
-constexpr long long CACHE_TIMEOUT_MS = 3600000; // 1 hour
-
 // ============================================================================
 // CONSTRUCTOR AND INITIALIZATION
 // ============================================================================
 
 NavigationDatabase::NavigationDatabase() 
-    : initialized_(false), lastUpdateTime_(0) {
-    InitializeData();
-    BuildSpatialIndex();
-    BuildReverseIndices();
-    lastUpdateTime_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+    : routeCache_(ROUTE_CACHE_CAPACITY), initialized_(false) {
+    magneticGrid_ = IoExecutor::shared()->submit([] { return MagneticVariationGrid::current(); }).share();
+    
+    NavdataPackBuilder builder;
+    auto snapshot = std::make_shared<Snapshot>();
+    InitializeData(builder, *snapshot);
+    
+    // The built-in data goes through the same compiled layout as a snapshot file
+    auto pack = std::make_shared<NavdataPack>();
+    pack->openImage(builder.build());
+    snapshot->pack = pack;
+    snapshot->procedurePaths = BuildProcedurePaths(*snapshot);
+    snapshot->updateTime = std::chrono::duration_cast<std::chrono::milliseconds>(
                            std::chrono::system_clock::now().time_since_epoch())
                            .count();
+    std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(std::move(snapshot)));
     initialized_ = true;
 }
 
-NavigationDatabase::~NavigationDatabase() {
-    std::unique_lock<std::shared_mutex> lock(dbMutex_);
-    waypoints_.clear();
-    airways_.clear();
-    sidsByAirport_.clear();
-    starsByAirport_.clear();
-    approachesByAirport_.clear();
-    waypointToAirways_.clear();
-    spatialIndex_.clear();
-    InvalidateCache();
+NavigationDatabase::~NavigationDatabase() = default;
+
+std::shared_ptr<const ProcedurePathTable> NavigationDatabase::BuildProcedurePaths(const Snapshot& snapshot) {
+    // Fix positions come from the pack, so every new pack gets its own paths
+    auto paths = std::make_shared<ProcedurePathTable>();
+    paths->build(*snapshot.pack, snapshot.sidsByAirport, snapshot.starsByAirport);
+    return paths;
 }
 
 // ============================================================================
 // DATA INITIALIZATION - 500+ WAYPOINTS
 // ============================================================================
 
-void NavigationDatabase::InitializeData() {
-    std::unique_lock<std::shared_mutex> lock(dbMutex_);
-    
+void NavigationDatabase::InitializeData(NavdataPackBuilder& builder, Snapshot& snapshot) const {
     // ========================================================================
     // MAJOR AIRPORTS
     // ========================================================================
-    waypoints_["KJFK"] = Waypoint("KJFK", 40.6413, -73.7781, NavaidType::AIRPORT, 13, 0, "NORTHEAST");
-    waypoints_["KLGA"] = Waypoint("KLGA", 40.7769, -73.8740, NavaidType::AIRPORT, 21, 0, "NORTHEAST");
-    waypoints_["KEWR"] = Waypoint("KEWR", 40.6895, -74.1745, NavaidType::AIRPORT, 18, 0, "NORTHEAST");
-    waypoints_["KBOS"] = Waypoint("KBOS", 42.3656, -71.0096, NavaidType::AIRPORT, 21, 0, "NORTHEAST");
-    waypoints_["KDFW"] = Waypoint("KDFW", 32.8975, -97.0382, NavaidType::AIRPORT, 607, 0, "SOUTH-CENTRAL");
-    waypoints_["KLAX"] = Waypoint("KLAX", 33.9425, -118.4081, NavaidType::AIRPORT, 125, 0, "WEST");
-    waypoints_["KSFO"] = Waypoint("KSFO", 37.6213, -122.3790, NavaidType::AIRPORT, 13, 0, "WEST");
-    waypoints_["KORD"] = Waypoint("KORD", 41.9742, -87.9073, NavaidType::AIRPORT, 682, 0, "MIDWEST");
-    waypoints_["KATL"] = Waypoint("KATL", 33.6407, -84.4277, NavaidType::AIRPORT, 1026, 0, "SOUTHEAST");
-    waypoints_["KMIA"] = Waypoint("KMIA", 25.7959, -80.2870, NavaidType::AIRPORT, 8, 0, "SOUTHEAST");
-    waypoints_["KDCA"] = Waypoint("KDCA", 38.8521, -77.0377, NavaidType::AIRPORT, 15, 0, "NORTHEAST");
-    waypoints_["KDEN"] = Waypoint("KDEN", 39.8561, -104.6737, NavaidType::AIRPORT, 5431, 0, "MOUNTAIN");
-    waypoints_["KSEA"] = Waypoint("KSEA", 47.4502, -122.3088, NavaidType::AIRPORT, 432, 0, "PACIFIC");
-    waypoints_["KPHX"] = Waypoint("KPHX", 33.4342, -112.0119, NavaidType::AIRPORT, 1105, 0, "SOUTHWEST");
-    waypoints_["KMCO"] = Waypoint("KMCO", 28.4312, -81.3081, NavaidType::AIRPORT, 96, 0, "SOUTHEAST");
-    waypoints_["KLAX"] = Waypoint("KLAX", 33.9425, -118.4081, NavaidType::AIRPORT, 125, 0, "SOUTHWEST");
-    waypoints_["KPDX"] = Waypoint("KPDX", 45.5887, -122.5975, NavaidType::AIRPORT, 429, 0, "PACIFIC");
-    waypoints_["KSAN"] = Waypoint("KSAN", 32.7337, -117.1933, NavaidType::AIRPORT, 17, 0, "SOUTHWEST");
-    waypoints_["KDTW"] = Waypoint("KDTW", 42.2124, -83.3534, NavaidType::AIRPORT, 645, 0, "MIDWEST");
-    waypoints_["KMSP"] = Waypoint("KMSP", 44.8848, -93.2209, NavaidType::AIRPORT, 922, 0, "MIDWEST");
+    builder.putWaypoint(NavdataWaypoint("KJFK", 40.6413, -73.7781, NavaidType::AIRPORT, 13, 0, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("KLGA", 40.7769, -73.8740, NavaidType::AIRPORT, 21, 0, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("KEWR", 40.6895, -74.1745, NavaidType::AIRPORT, 18, 0, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("KBOS", 42.3656, -71.0096, NavaidType::AIRPORT, 21, 0, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("KDFW", 32.8975, -97.0382, NavaidType::AIRPORT, 607, 0, "SOUTH-CENTRAL"));
+    builder.putWaypoint(NavdataWaypoint("KLAX", 33.9425, -118.4081, NavaidType::AIRPORT, 125, 0, "WEST"));
+    builder.putWaypoint(NavdataWaypoint("KSFO", 37.6213, -122.3790, NavaidType::AIRPORT, 13, 0, "WEST"));
+    builder.putWaypoint(NavdataWaypoint("KORD", 41.9742, -87.9073, NavaidType::AIRPORT, 682, 0, "MIDWEST"));
+    builder.putWaypoint(NavdataWaypoint("KATL", 33.6407, -84.4277, NavaidType::AIRPORT, 1026, 0, "SOUTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("KMIA", 25.7959, -80.2870, NavaidType::AIRPORT, 8, 0, "SOUTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("KDCA", 38.8521, -77.0377, NavaidType::AIRPORT, 15, 0, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("KDEN", 39.8561, -104.6737, NavaidType::AIRPORT, 5431, 0, "MOUNTAIN"));
+    builder.putWaypoint(NavdataWaypoint("KSEA", 47.4502, -122.3088, NavaidType::AIRPORT, 432, 0, "PACIFIC"));
+    builder.putWaypoint(NavdataWaypoint("KPHX", 33.4342, -112.0119, NavaidType::AIRPORT, 1105, 0, "SOUTHWEST"));
+    builder.putWaypoint(NavdataWaypoint("KMCO", 28.4312, -81.3081, NavaidType::AIRPORT, 96, 0, "SOUTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("KLAX", 33.9425, -118.4081, NavaidType::AIRPORT, 125, 0, "SOUTHWEST"));
+    builder.putWaypoint(NavdataWaypoint("KPDX", 45.5887, -122.5975, NavaidType::AIRPORT, 429, 0, "PACIFIC"));
+    builder.putWaypoint(NavdataWaypoint("KSAN", 32.7337, -117.1933, NavaidType::AIRPORT, 17, 0, "SOUTHWEST"));
+    builder.putWaypoint(NavdataWaypoint("KDTW", 42.2124, -83.3534, NavaidType::AIRPORT, 645, 0, "MIDWEST"));
+    builder.putWaypoint(NavdataWaypoint("KMSP", 44.8848, -93.2209, NavaidType::AIRPORT, 922, 0, "MIDWEST"));
     
     // ========================================================================
     // NAVIGATION FIXES - NORTHEAST REGION (50 waypoints)
     // ========================================================================
-    waypoints_["KUJOE"] = Waypoint("KUJOE", 40.7920, -73.8917, NavaidType::FIX, 0, 0, "NORTHEAST");
-    waypoints_["CAMRN"] = Waypoint("CAMRN", 40.9347, -74.1722, NavaidType::FIX, 0, 0, "NORTHEAST");
-    waypoints_["BOUND"] = Waypoint("BOUND", 41.1028, -74.3667, NavaidType::FIX, 0, 0, "NORTHEAST");
-    waypoints_["MERIT"] = Waypoint("MERIT", 41.2544, -74.5083, NavaidType::FIX, 0, 0, "NORTHEAST");
-    waypoints_["HUSTR"] = Waypoint("HUSTR", 40.5833, -74.6667, NavaidType::FIX, 0, 0, "NORTHEAST");
-    waypoints_["ELLOS"] = Waypoint("ELLOS", 40.5275, -74.2733, NavaidType::VOR, 0, 110.2, "NORTHEAST");
-    waypoints_["MORRY"] = Waypoint("MORRY", 39.9789, -74.6039, NavaidType::FIX, 0, 0, "MID-ATLANTIC");
-    waypoints_["HAMIL"] = Waypoint("HAMIL", 39.6694, -75.0639, NavaidType::FIX, 0, 0, "MID-ATLANTIC");
-    waypoints_["PEAKE"] = Waypoint("PEAKE", 39.3614, -75.4889, NavaidType::VOR, 0, 111.4, "MID-ATLANTIC");
-    waypoints_["BRAVO"] = Waypoint("BRAVO", 38.5939, -76.8625, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["CORIN"] = Waypoint("CORIN", 38.2344, -77.5411, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["DAVYS"] = Waypoint("DAVYS", 37.9297, -78.3667, NavaidType::VOR, 0, 112.8, "SOUTHEAST");
-    waypoints_["EMMET"] = Waypoint("EMMET", 37.6611, -79.1889, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["FRANK"] = Waypoint("FRANK", 36.6139, -80.7833, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["GRADY"] = Waypoint("GRADY", 36.0711, -81.5333, NavaidType::VOR, 0, 113.2, "SOUTHEAST");
-    waypoints_["HENRY"] = Waypoint("HENRY", 35.2089, -83.0889, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["IGOR"] = Waypoint("IGOR", 34.5678, -84.1167, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["JULEP"] = Waypoint("JULEP", 33.8234, -84.9833, NavaidType::VOR, 0, 114.6, "SOUTHEAST");
-    waypoints_["KEVIN"] = Waypoint("KEVIN", 32.4567, -86.2456, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["LIMA"] = Waypoint("LIMA", 31.2345, -87.6789, NavaidType::FIX, 0, 0, "GULF");
+    builder.putWaypoint(NavdataWaypoint("KUJOE", 40.7920, -73.8917, NavaidType::FIX, 0, 0, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("CAMRN", 40.9347, -74.1722, NavaidType::FIX, 0, 0, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("BOUND", 41.1028, -74.3667, NavaidType::FIX, 0, 0, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("MERIT", 41.2544, -74.5083, NavaidType::FIX, 0, 0, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("HUSTR", 40.5833, -74.6667, NavaidType::FIX, 0, 0, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("ELLOS", 40.5275, -74.2733, NavaidType::VOR, 0, 110.2, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("MORRY", 39.9789, -74.6039, NavaidType::FIX, 0, 0, "MID-ATLANTIC"));
+    builder.putWaypoint(NavdataWaypoint("HAMIL", 39.6694, -75.0639, NavaidType::FIX, 0, 0, "MID-ATLANTIC"));
+    builder.putWaypoint(NavdataWaypoint("PEAKE", 39.3614, -75.4889, NavaidType::VOR, 0, 111.4, "MID-ATLANTIC"));
+    builder.putWaypoint(NavdataWaypoint("BRAVO", 38.5939, -76.8625, NavaidType::FIX, 0, 0, "SOUTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("CORIN", 38.2344, -77.5411, NavaidType::FIX, 0, 0, "SOUTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("DAVYS", 37.9297, -78.3667, NavaidType::VOR, 0, 112.8, "SOUTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("EMMET", 37.6611, -79.1889, NavaidType::FIX, 0, 0, "SOUTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("FRANK", 36.6139, -80.7833, NavaidType::FIX, 0, 0, "SOUTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("GRADY", 36.0711, -81.5333, NavaidType::VOR, 0, 113.2, "SOUTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("HENRY", 35.2089, -83.0889, NavaidType::FIX, 0, 0, "SOUTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("IGOR", 34.5678, -84.1167, NavaidType::FIX, 0, 0, "SOUTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("JULEP", 33.8234, -84.9833, NavaidType::VOR, 0, 114.6, "SOUTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("KEVIN", 32.4567, -86.2456, NavaidType::FIX, 0, 0, "SOUTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("LIMA", 31.2345, -87.6789, NavaidType::FIX, 0, 0, "GULF"));
     
     // Add 430+ procedurally generated waypoints across US regions
     int count = 0;
     for (double lat = 25.0; lat <= 48.0; lat += 1.5) {
         for (double lon = -125.0; lon <= -67.0; lon += 2.5) {
             std::string name = "FIX" + std::to_string(count);
-            waypoints_[name] = Waypoint(name, lat, lon, NavaidType::FIX, 0, 0, "US-ENROUTE");
+            builder.putWaypoint(NavdataWaypoint(name, lat, lon, NavaidType::FIX, 0, 0, "US-ENROUTE"));
             count++;
             if (count > 430) break;
         }
@@ -122,16 +125,16 @@ void NavigationDatabase::InitializeData() {
     }
     
     // International waypoints (20)
-    waypoints_["GEJUP"] = Waypoint("GEJUP", 51.4769, -3.2578, NavaidType::FIX, 0, 0, "ATLANTIC");
-    waypoints_["NOPAC"] = Waypoint("NOPAC", 52.0000, -20.0000, NavaidType::FIX, 0, 0, "ATLANTIC");
-    waypoints_["STATC"] = Waypoint("STATC", 55.0000, -15.0000, NavaidType::FIX, 0, 0, "ATLANTIC");
-    waypoints_["LFPG"] = Waypoint("LFPG", 49.0127, 2.5502, NavaidType::AIRPORT, 382, 0, "EUROPE");
-    waypoints_["EGLL"] = Waypoint("EGLL", 51.4775, -0.4614, NavaidType::AIRPORT, 83, 0, "EUROPE");
-    waypoints_["EDDF"] = Waypoint("EDDF", 50.0260, 8.5591, NavaidType::AIRPORT, 364, 0, "EUROPE");
-    waypoints_["LIRF"] = Waypoint("LIRF", 41.7994, 12.5949, NavaidType::AIRPORT, 77, 0, "EUROPE");
-    waypoints_["ZBAA"] = Waypoint("ZBAA", 39.9042, 116.4074, NavaidType::AIRPORT, 116, 0, "ASIA");
-    waypoints_["RJTT"] = Waypoint("RJTT", 35.5494, 139.7798, NavaidType::AIRPORT, 46, 0, "ASIA");
-    waypoints_["RKSI"] = Waypoint("RKSI", 37.4602, 126.4407, NavaidType::AIRPORT, 69, 0, "ASIA");
+    builder.putWaypoint(NavdataWaypoint("GEJUP", 51.4769, -3.2578, NavaidType::FIX, 0, 0, "ATLANTIC"));
+    builder.putWaypoint(NavdataWaypoint("NOPAC", 52.0000, -20.0000, NavaidType::FIX, 0, 0, "ATLANTIC"));
+    builder.putWaypoint(NavdataWaypoint("STATC", 55.0000, -15.0000, NavaidType::FIX, 0, 0, "ATLANTIC"));
+    builder.putWaypoint(NavdataWaypoint("LFPG", 49.0127, 2.5502, NavaidType::AIRPORT, 382, 0, "EUROPE"));
+    builder.putWaypoint(NavdataWaypoint("EGLL", 51.4775, -0.4614, NavaidType::AIRPORT, 83, 0, "EUROPE"));
+    builder.putWaypoint(NavdataWaypoint("EDDF", 50.0260, 8.5591, NavaidType::AIRPORT, 364, 0, "EUROPE"));
+    builder.putWaypoint(NavdataWaypoint("LIRF", 41.7994, 12.5949, NavaidType::AIRPORT, 77, 0, "EUROPE"));
+    builder.putWaypoint(NavdataWaypoint("ZBAA", 39.9042, 116.4074, NavaidType::AIRPORT, 116, 0, "ASIA"));
+    builder.putWaypoint(NavdataWaypoint("RJTT", 35.5494, 139.7798, NavaidType::AIRPORT, 46, 0, "ASIA"));
+    builder.putWaypoint(NavdataWaypoint("RKSI", 37.4602, 126.4407, NavaidType::AIRPORT, 69, 0, "ASIA"));
     
     // ========================================================================
     // INITIALIZE 200+ AIRWAYS
@@ -142,12 +145,14 @@ void NavigationDatabase::InitializeData() {
         std::string name = "V" + std::to_string(i);
         Airway v_airway(name, 1200, 18000, AirwayLevel::LOW);
         
-        // Create waypoint sequences
-        v_airway.waypointSequence.push_back("FIX" + std::to_string((i-1)*10));
-        v_airway.waypointSequence.push_back("FIX" + std::to_string((i-1)*10+1));
-        v_airway.waypointSequence.push_back("FIX" + std::to_string((i-1)*10+2));
+        // Create waypoint sequences; wrap so the later airways reuse
+        // generated fixes instead of naming ones that do not exist
+        int first = ((i-1)*10) % (count - 2);
+        v_airway.waypointSequence.push_back("FIX" + std::to_string(first));
+        v_airway.waypointSequence.push_back("FIX" + std::to_string(first+1));
+        v_airway.waypointSequence.push_back("FIX" + std::to_string(first+2));
         
-        airways_[name] = v_airway;
+        builder.putAirway(v_airway);
     }
     
     // Jet Routes (High altitude - 100 airways)
@@ -159,25 +164,25 @@ void NavigationDatabase::InitializeData() {
         j_airway.waypointSequence.push_back("FIX" + std::to_string(i*2+1));
         j_airway.waypointSequence.push_back("FIX" + std::to_string((i+1)*2));
         
-        airways_[name] = j_airway;
+        builder.putAirway(j_airway);
     }
     
     // Specific named airways
     Airway V1_named("V1", 1200, 18000, AirwayLevel::LOW);
     V1_named.waypointSequence = {"KJFK", "KUJOE", "ELLOS", "MORRY", "PEAKE"};
-    airways_["V1"] = V1_named;
+    builder.putAirway(V1_named);
     
     Airway V2_named("V2", 1200, 18000, AirwayLevel::LOW);
     V2_named.waypointSequence = {"CAMRN", "BOUND", "MERIT", "HAMIL", "CORIN"};
-    airways_["V2"] = V2_named;
+    builder.putAirway(V2_named);
     
     Airway J500("J500", 18000, 45000, AirwayLevel::HIGH);
     J500.waypointSequence = {"KJFK", "GEJUP", "LFPG"};
-    airways_["J500"] = J500;
+    builder.putAirway(J500);
     
     Airway J501("J501", 18000, 45000, AirwayLevel::HIGH);
     J501.waypointSequence = {"KLAX", "KDEN", "KORD", "KDFW"};
-    airways_["J501"] = J501;
+    builder.putAirway(J501);
     
     // ========================================================================
     // INITIALIZE 100+ SID PROCEDURES
@@ -201,7 +206,7 @@ void NavigationDatabase::InitializeData() {
             sid.requiresRNAV = (runway % 3 == 0);
             sid.procedureDistance = 15 + (runway * 2);
             
-            sidsByAirport_[airport].push_back(sid);
+            snapshot.sidsByAirport[airport].push_back(sid);
         }
     }
     
@@ -226,7 +231,7 @@ void NavigationDatabase::InitializeData() {
             star.requiresRNAV = (runway % 2 == 0);
             star.procedureDistance = 18 + (runway * 3);
             
-            starsByAirport_[airport].push_back(star);
+            snapshot.starsByAirport[airport].push_back(star);
         }
     }
     
@@ -236,7 +241,7 @@ void NavigationDatabase::InitializeData() {
     
     for (const auto& airport : majorAirports) {
         // ILS approaches
-        ApproachProcedure ils;
+        NavdataApproachProcedure ils;
         ils.airport = airport;
         ils.runway = "01L";
         ils.name = "ILS " + airport + " 01L";
@@ -245,10 +250,10 @@ void NavigationDatabase::InitializeData() {
         ils.decisionAltitude = 200.0;
         ils.minimumVisibility = 0.5;
         ils.hasGlideslope = true;
-        approachesByAirport_[airport].push_back(ils);
+        snapshot.approachesByAirport[airport].push_back(ils);
         
         // RNAV approaches
-        ApproachProcedure rnav;
+        NavdataApproachProcedure rnav;
         rnav.airport = airport;
         rnav.runway = "01R";
         rnav.name = "RNAV " + airport + " 01R";
@@ -257,31 +262,7 @@ void NavigationDatabase::InitializeData() {
         rnav.decisionAltitude = 400.0;
         rnav.minimumVisibility = 1.0;
         rnav.hasGlideslope = false;
-        approachesByAirport_[airport].push_back(rnav);
-    }
-}
-
-void NavigationDatabase::BuildSpatialIndex() {
-    std::unique_lock<std::shared_mutex> lock(dbMutex_);
-    spatialIndex_.clear();
-    
-    for (const auto& wp : waypoints_) {
-        SpatialIndex si;
-        si.latitude = wp.second.latitude;
-        si.longitude = wp.second.longitude;
-        si.waypointName = wp.first;
-        spatialIndex_.push_back(si);
-    }
-}
-
-void NavigationDatabase::BuildReverseIndices() {
-    std::unique_lock<std::shared_mutex> lock(dbMutex_);
-    waypointToAirways_.clear();
-    
-    for (const auto& airway : airways_) {
-        for (const auto& wpName : airway.second.waypointSequence) {
-            waypointToAirways_[wpName].push_back(airway.first);
-        }
+        snapshot.approachesByAirport[airport].push_back(rnav);
     }
 }
 
@@ -289,49 +270,74 @@ void NavigationDatabase::BuildReverseIndices() {
 // WAYPOINT OPERATIONS
 // ============================================================================
 
-std::optional<Waypoint> NavigationDatabase::GetWaypoint(const std::string& name) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+std::optional<NavdataWaypoint> NavigationDatabase::GetWaypoint(const std::string& name) const {
+    auto snapshot = Current();
+    const NavdataPack& pack = *snapshot->pack;
     
-    auto it = waypoints_.find(name);
-    if (it != waypoints_.end()) {
-        return it->second;
+    uint32_t node = pack.findWaypoint(name);
+    if (node != NO_NODE) {
+        return pack.getWaypoint(node);
     }
     
     return std::nullopt;
 }
 
-std::vector<Waypoint> NavigationDatabase::GetWaypointsByType(NavaidType type) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+std::vector<NavdataWaypoint> NavigationDatabase::GetWaypointsByType(NavaidType type) const {
+    return FindWaypointsByType(type).materialize();
+}
+
+NavdataWaypointList NavigationDatabase::FindWaypointsByType(NavaidType type) const {
+    auto snapshot = Current();
+    const NavdataPack& pack = *snapshot->pack;
     
-    std::vector<Waypoint> result;
-    for (const auto& wp : waypoints_) {
-        if (wp.second.type == type) {
-            result.push_back(wp.second);
+    std::vector<uint32_t> nodes;
+    for (uint32_t node = 0; node < pack.getWaypointCount(); ++node) {
+        if (pack.getWaypointRecord(node).navaidType() == type) {
+            nodes.push_back(node);
         }
     }
     
-    return result;
+    return NavdataWaypointList(snapshot->pack, std::move(nodes));
 }
 
-std::vector<Waypoint> NavigationDatabase::GetWaypointsNearby(double latitude, double longitude,
+std::vector<NavdataWaypoint> NavigationDatabase::GetWaypointsNearby(double latitude, double longitude,
                                                              double radiusNM) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
+    const NavdataPack& pack = *snapshot->pack;
     
-    std::vector<Waypoint> result;
+    std::vector<WaypointIndex::Match> matches;
+    pack.getSpatialIndex().queryRadius(latitude, longitude, radiusNM, matches);
     
-    for (const auto& si : spatialIndex_) {
-        double distance = GreatCircleDistance(latitude, longitude, si.latitude, si.longitude);
-        if (distance <= radiusNM) {
-            result.push_back(waypoints_.at(si.waypointName));
-        }
+    std::vector<NavdataWaypoint> result;
+    result.reserve(matches.size());
+    for (const auto& match : matches) {
+        result.push_back(pack.getWaypoint(match.id));
+    }
+    
+    return result;
+}
+
+std::vector<NavdataWaypoint> NavigationDatabase::GetNearestWaypoints(double latitude, double longitude,
+                                                              size_t count, double maxRadiusNM) const {
+    auto snapshot = Current();
+    const NavdataPack& pack = *snapshot->pack;
+    
+    std::vector<WaypointIndex::Match> matches;
+    pack.getSpatialIndex().queryNearest(latitude, longitude, count, matches, maxRadiusNM);
+    
+    std::vector<NavdataWaypoint> result;
+    result.reserve(matches.size());
+    for (const auto& match : matches) {
+        result.push_back(pack.getWaypoint(match.id));
     }
     
     return result;
 }
 
 int NavigationDatabase::GetWaypointCount() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    return static_cast<int>(waypoints_.size());
+    auto snapshot = Current();
+    const NavdataPack& pack = *snapshot->pack;
+    return static_cast<int>(pack.getWaypointCount());
 }
 
 // ============================================================================
@@ -339,59 +345,60 @@ int NavigationDatabase::GetWaypointCount() const {
 // ============================================================================
 
 std::optional<Airway> NavigationDatabase::GetAirway(const std::string& name) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
+    const NavdataPack& pack = *snapshot->pack;
     
-    auto it = airways_.find(name);
-    if (it != airways_.end()) {
-        return it->second;
+    uint32_t airway = pack.findAirway(name);
+    if (airway != NavdataPack::NO_INDEX) {
+        return pack.getAirway(airway);
     }
     
     return std::nullopt;
 }
 
-std::vector<Waypoint> NavigationDatabase::GetAirwayWaypoints(const std::string& airwayName) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+std::vector<NavdataWaypoint> NavigationDatabase::GetAirwayWaypoints(const std::string& airwayName) const {
+    return FindAirwayWaypoints(airwayName).materialize();
+}
+
+NavdataWaypointList NavigationDatabase::FindAirwayWaypoints(const std::string& airwayName) const {
+    auto snapshot = Current();
+    const NavdataPack& pack = *snapshot->pack;
     
-    std::vector<Waypoint> result;
+    std::vector<uint32_t> nodes;
     
-    auto it = airways_.find(airwayName);
-    if (it != airways_.end()) {
-        for (const auto& wpName : it->second.waypointSequence) {
-            auto wpIt = waypoints_.find(wpName);
-            if (wpIt != waypoints_.end()) {
-                result.push_back(wpIt->second);
+    uint32_t airway = pack.findAirway(airwayName);
+    if (airway != NavdataPack::NO_INDEX) {
+        // Fixes were resolved to nodes when the pack was compiled
+        const NavdataPackFix* fixes = pack.getAirwayFixes(airway);
+        for (uint32_t i = 0; i < pack.getAirwayRecord(airway).fixCount; ++i) {
+            if (fixes[i].waypoint != NO_NODE) {
+                nodes.push_back(fixes[i].waypoint);
             }
         }
     }
     
-    return result;
+    return NavdataWaypointList(snapshot->pack, std::move(nodes));
 }
 
 std::vector<Airway> NavigationDatabase::GetConnectingAirways(const std::string& waypointA,
                                                             const std::string& waypointB) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
+    const NavdataPack& pack = *snapshot->pack;
     
     std::vector<Airway> result;
     
-    for (const auto& airway : airways_) {
-        const auto& seq = airway.second.waypointSequence;
-        bool hasA = false, hasB = false;
-        int posA = -1, posB = -1;
-        
-        for (size_t i = 0; i < seq.size(); ++i) {
-            if (seq[i] == waypointA) {
-                hasA = true;
-                posA = i;
-            }
-            if (seq[i] == waypointB) {
-                hasB = true;
-                posB = i;
-            }
-        }
-        
-        // Airways should be sequential
-        if (hasA && hasB && (posA + 1 == posB || posB + 1 == posA)) {
-            result.push_back(airway.second);
+    // Airways should be sequential: exactly the graph edges from A to B
+    uint32_t nodeA = pack.findWaypoint(waypointA);
+    uint32_t nodeB = pack.findWaypoint(waypointB);
+    if (nodeA == NO_NODE || nodeB == NO_NODE) {
+        return result;
+    }
+    
+    std::vector<uint32_t> seen;
+    for (const NavdataPackEdge* edge = pack.edgesBegin(nodeA); edge != pack.edgesEnd(nodeA); ++edge) {
+        if (edge->to == nodeB && std::find(seen.begin(), seen.end(), edge->airway) == seen.end()) {
+            seen.push_back(edge->airway);
+            result.push_back(pack.getAirway(edge->airway));
         }
     }
     
@@ -399,14 +406,16 @@ std::vector<Airway> NavigationDatabase::GetConnectingAirways(const std::string&
 }
 
 std::vector<Airway> NavigationDatabase::GetAirwaysByAltitude(int altitudeFeet) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
+    const NavdataPack& pack = *snapshot->pack;
     
     std::vector<Airway> result;
     
-    for (const auto& airway : airways_) {
-        if (altitudeFeet >= airway.second.minimumAltitude &&
-            altitudeFeet <= airway.second.maximumAltitude) {
-            result.push_back(airway.second);
+    for (uint32_t airway = 0; airway < pack.getAirwayCount(); ++airway) {
+        const NavdataPackAirway& record = pack.getAirwayRecord(airway);
+        if (altitudeFeet >= record.minimumAltitude &&
+            altitudeFeet <= record.maximumAltitude) {
+            result.push_back(pack.getAirway(airway));
         }
     }
     
@@ -414,8 +423,9 @@ std::vector<Airway> NavigationDatabase::GetAirwaysByAltitude(int altitudeFeet) c
 }
 
 int NavigationDatabase::GetAirwayCount() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    return static_cast<int>(airways_.size());
+    auto snapshot = Current();
+    const NavdataPack& pack = *snapshot->pack;
+    return static_cast<int>(pack.getAirwayCount());
 }
 
 // ============================================================================
@@ -424,10 +434,10 @@ int NavigationDatabase::GetAirwayCount() const {
 
 std::optional<SID> NavigationDatabase::GetSID(const std::string& airport,
                                                const std::string& runway) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
     
-    auto it = sidsByAirport_.find(airport);
-    if (it != sidsByAirport_.end()) {
+    auto it = snapshot->sidsByAirport.find(airport);
+    if (it != snapshot->sidsByAirport.end()) {
         for (const auto& sid : it->second) {
             if (sid.runway == runway) {
                 return sid;
@@ -439,10 +449,10 @@ std::optional<SID> NavigationDatabase::GetSID(const std::string& airport,
 }
 
 std::vector<SID> NavigationDatabase::GetSIDsByAirport(const std::string& airport) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
     
-    auto it = sidsByAirport_.find(airport);
-    if (it != sidsByAirport_.end()) {
+    auto it = snapshot->sidsByAirport.find(airport);
+    if (it != snapshot->sidsByAirport.end()) {
         return it->second;
     }
     
@@ -451,10 +461,10 @@ std::vector<SID> NavigationDatabase::GetSIDsByAirport(const std::string& airport
 
 std::optional<STAR> NavigationDatabase::GetSTAR(const std::string& airport,
                                                  const std::string& runway) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
     
-    auto it = starsByAirport_.find(airport);
-    if (it != starsByAirport_.end()) {
+    auto it = snapshot->starsByAirport.find(airport);
+    if (it != snapshot->starsByAirport.end()) {
         for (const auto& star : it->second) {
             if (star.runway == runway) {
                 return star;
@@ -466,10 +476,10 @@ std::optional<STAR> NavigationDatabase::GetSTAR(const std::string& airport,
 }
 
 std::vector<STAR> NavigationDatabase::GetSTARsByAirport(const std::string& airport) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
     
-    auto it = starsByAirport_.find(airport);
-    if (it != starsByAirport_.end()) {
+    auto it = snapshot->starsByAirport.find(airport);
+    if (it != snapshot->starsByAirport.end()) {
         return it->second;
     }
     
@@ -477,18 +487,18 @@ std::vector<STAR> NavigationDatabase::GetSTARsByAirport(const std::string& airpo
 }
 
 int NavigationDatabase::GetSIDCount() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
     int count = 0;
-    for (const auto& pair : sidsByAirport_) {
+    for (const auto& pair : snapshot->sidsByAirport) {
         count += pair.second.size();
     }
     return count;
 }
 
 int NavigationDatabase::GetSTARCount() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
     int count = 0;
-    for (const auto& pair : starsByAirport_) {
+    for (const auto& pair : snapshot->starsByAirport) {
         count += pair.second.size();
     }
     return count;
@@ -498,14 +508,14 @@ int NavigationDatabase::GetSTARCount() const {
 // APPROACH PROCEDURE OPERATIONS
 // ============================================================================
 
-std::optional<ApproachProcedure> NavigationDatabase::GetApproachProcedure(
+std::optional<NavdataApproachProcedure> NavigationDatabase::GetApproachProcedure(
     const std::string& airport,
     const std::string& runway,
     const std::string& procedureType) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
     
-    auto it = approachesByAirport_.find(airport);
-    if (it != approachesByAirport_.end()) {
+    auto it = snapshot->approachesByAirport.find(airport);
+    if (it != snapshot->approachesByAirport.end()) {
         for (const auto& app : it->second) {
             if (app.runway == runway && (procedureType.empty() || app.type == procedureType)) {
                 return app;
@@ -516,14 +526,14 @@ std::optional<ApproachProcedure> NavigationDatabase::GetApproachProcedure(
     return std::nullopt;
 }
 
-std::vector<ApproachProcedure> NavigationDatabase::GetApproachProceduresByRunway(
+std::vector<NavdataApproachProcedure> NavigationDatabase::GetApproachProceduresByRunway(
     const std::string& airport,
     const std::string& runway) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
     
-    std::vector<ApproachProcedure> result;
-    auto it = approachesByAirport_.find(airport);
-    if (it != approachesByAirport_.end()) {
+    std::vector<NavdataApproachProcedure> result;
+    auto it = snapshot->approachesByAirport.find(airport);
+    if (it != snapshot->approachesByAirport.end()) {
         for (const auto& app : it->second) {
             if (app.runway == runway) {
                 result.push_back(app);
@@ -534,22 +544,22 @@ std::vector<ApproachProcedure> NavigationDatabase::GetApproachProceduresByRunway
     return result;
 }
 
-std::vector<ApproachProcedure> NavigationDatabase::GetApproachProceduresByAirport(
+std::vector<NavdataApproachProcedure> NavigationDatabase::GetApproachProceduresByAirport(
     const std::string& airport) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
     
-    auto it = approachesByAirport_.find(airport);
-    if (it != approachesByAirport_.end()) {
+    auto it = snapshot->approachesByAirport.find(airport);
+    if (it != snapshot->approachesByAirport.end()) {
         return it->second;
     }
     
-    return std::vector<ApproachProcedure>();
+    return std::vector<NavdataApproachProcedure>();
 }
 
 int NavigationDatabase::GetApproachProcedureCount() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
     int count = 0;
-    for (const auto& pair : approachesByAirport_) {
+    for (const auto& pair : snapshot->approachesByAirport) {
         count += pair.second.size();
     }
     return count;
@@ -618,10 +628,10 @@ double NavigationDatabase::CalculateFlightTime(double distance, double groundSpe
 // FLIGHT PLAN VALIDATION
 // ============================================================================
 
-ValidationResult NavigationDatabase::ValidateFlightPlan(
+NavdataValidationResult NavigationDatabase::ValidateFlightPlan(
     const std::vector<std::string>& waypointSequence, int cruiseAltitude) const {
     
-    ValidationResult result;
+    NavdataValidationResult result;
     
     if (waypointSequence.empty()) {
         result.isValid = false;
@@ -712,102 +722,67 @@ RouteFindingResult NavigationDatabase::FindRoute(const std::string& origin,
                                                  const std::string& destination,
                                                  int cruiseAltitude) const {
     RouteFindingResult result;
-
-    const std::string cacheKey = origin + "|" + destination + "|" + std::to_string(cruiseAltitude);
-    if (auto cached = GetFromCache(cacheKey)) {
-        const auto& cachedSequence = cached.value();
-        if (cachedSequence.size() < 2) {
-            result.success = false;
-            return result;
-        }
-
-        result.success = true;
-        result.waypointSequence = cachedSequence;
-        result.distances.clear();
-
-        double totalDistance = 0.0;
-        for (size_t i = 0; i + 1 < cachedSequence.size(); ++i) {
-            double leg = CalculateDistance(cachedSequence[i], cachedSequence[i + 1]);
-            if (leg < 0) {
-                result.success = false;
-                return result;
-            }
-            result.distances.push_back(leg);
-            totalDistance += leg;
-        }
-
-        result.totalDistance = totalDistance;
-        result.estimatedTimeMinutes = static_cast<int>(CalculateFlightTime(totalDistance, 450.0));
-        result.fuelRequired = totalDistance * 15.0;
-
-        std::ostringstream oss;
-        for (size_t i = 0; i < cachedSequence.size(); ++i) {
-            if (i > 0) oss << " -> ";
-            oss << cachedSequence[i];
-        }
-        oss << " (" << static_cast<int>(totalDistance) << " NM)";
-        result.routeDescription = oss.str();
+    auto snapshot = Current();
+    const NavdataPack& pack = *snapshot->pack;
+
+    CachedRoute route;
+    route.generation = snapshot->generation;
+    route.origin = pack.findWaypoint(origin);
+    route.destination = pack.findWaypoint(destination);
+    route.cruiseAltitude = cruiseAltitude;
+    route.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+    if (route.origin == NO_NODE || route.destination == NO_NODE) {
+        result.success = false;
         return result;
     }
 
-    auto computedPath = DijkstraPathfinding(origin, destination, cruiseAltitude);
-
-    if (computedPath.size() < 2) {
-        auto originWp = GetWaypoint(origin);
-        auto destWp = GetWaypoint(destination);
-        if (!originWp || !destWp) {
-            result.success = false;
-            return result;
+    if (!GetCachedRoute(route)) {
+        std::vector<uint32_t> nodes = DijkstraPathfinding(pack, route.origin, route.destination,
+                                                          cruiseAltitude);
+        route.direct = nodes.size() < 2;
+        if (route.direct) {
+            nodes = {route.origin, route.destination};
         }
-
-        double distance = GreatCircleDistance(originWp->latitude, originWp->longitude,
-                                              destWp->latitude, destWp->longitude);
-        result.success = true;
-        result.waypointSequence = {origin, destination};
-        result.distances = {distance};
-        result.totalDistance = distance;
-        result.estimatedTimeMinutes = static_cast<int>(CalculateFlightTime(distance, 450.0));
-        result.fuelRequired = distance * 15.0;
-        result.routeDescription = origin + " direct to " + destination +
-                                  " (" + std::to_string(static_cast<int>(distance)) + " NM)";
-
-        StoreInCache(cacheKey, result.waypointSequence);
-        return result;
-    }
-
-    std::vector<std::string> pathNames;
-    pathNames.reserve(computedPath.size());
-    for (const auto& wp : computedPath) {
-        pathNames.push_back(wp.name);
+        route.path = std::make_shared<const std::vector<uint32_t>>(std::move(nodes));
+        StoreCachedRoute(route);
     }
 
+    const std::vector<uint32_t>& nodes = *route.path;
     double totalDistance = 0.0;
-    std::vector<double> legDistances;
-    legDistances.reserve(computedPath.size() - 1);
-
-    for (size_t i = 0; i + 1 < computedPath.size(); ++i) {
-        double leg = GreatCircleDistance(computedPath[i].latitude, computedPath[i].longitude,
-                                         computedPath[i + 1].latitude, computedPath[i + 1].longitude);
-        legDistances.push_back(leg);
-        totalDistance += leg;
+    result.waypointSequence.reserve(nodes.size());
+    result.distances.reserve(nodes.size() - 1);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const NavdataPackWaypoint& wp = pack.getWaypointRecord(nodes[i]);
+        result.waypointSequence.emplace_back(pack.getString(wp.nameRef()));
+        if (i > 0) {
+            const NavdataPackWaypoint& previous = pack.getWaypointRecord(nodes[i - 1]);
+            double leg = GreatCircleDistance(previous.latitude(), previous.longitude(),
+                                             wp.latitude(), wp.longitude());
+            result.distances.push_back(leg);
+            totalDistance += leg;
+        }
     }
 
     result.success = true;
-    result.waypointSequence = pathNames;
-    result.distances = legDistances;
     result.totalDistance = totalDistance;
     result.estimatedTimeMinutes = static_cast<int>(CalculateFlightTime(totalDistance, 450.0));
     result.fuelRequired = totalDistance * 15.0;
 
+    if (route.direct) {
+        result.routeDescription = origin + " direct to " + destination +
+                                  " (" + std::to_string(static_cast<int>(totalDistance)) + " NM)";
+        return result;
+    }
+
     std::ostringstream oss;
-    for (size_t i = 0; i < pathNames.size(); ++i) {
+    for (size_t i = 0; i < result.waypointSequence.size(); ++i) {
         if (i > 0) oss << " -> ";
-        oss << pathNames[i];
+        oss << result.waypointSequence[i];
     }
     oss << " (" << static_cast<int>(totalDistance) << " NM)";
     result.routeDescription = oss.str();
-
-    StoreInCache(cacheKey, pathNames);
     return result;
 }
 
@@ -849,19 +824,20 @@ std::vector<std::string> NavigationDatabase::FindRouteViaAirways(
 // ============================================================================
 
 NavDatabaseStats NavigationDatabase::GetStatistics() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+    auto snapshot = Current();
+    const NavdataPack& pack = *snapshot->pack;
     
     NavDatabaseStats stats;
-    stats.waypointCount = waypoints_.size();
-    stats.airwayCount = airways_.size();
+    stats.waypointCount = static_cast<int>(pack.getWaypointCount());
+    stats.airwayCount = static_cast<int>(pack.getAirwayCount());
     stats.approachCount = GetApproachProcedureCount();
     stats.isReady = initialized_;
-    stats.lastUpdateTime = lastUpdateTime_;
+    stats.lastUpdateTime = snapshot->updateTime;
     
     double totalDistance = 0.0;
     int airwayCount = 0;
-    for (const auto& airway : airways_) {
-        totalDistance += airway.second.GetTotalDistance();
+    for (uint32_t airway = 0; airway < pack.getAirwayCount(); ++airway) {
+        totalDistance += pack.getAirwayRecord(airway).totalDistanceNM;
         airwayCount++;
     }
     stats.averageAirwayDistance = airwayCount > 0 ? totalDistance / airwayCount : 0.0;
@@ -869,6 +845,14 @@ NavDatabaseStats NavigationDatabase::GetStatistics() const {
     stats.sidCount = GetSIDCount();
     stats.starCount = GetSTARCount();
     
+    StripedCacheStats cacheStats = routeCache_.getStats();
+    stats.routeCacheHits = cacheStats.hits;
+    stats.routeCacheMisses = cacheStats.misses;
+    stats.routeCacheEntries = cacheStats.entries;
+    stats.routeCacheContentions = cacheStats.contentions;
+    uint64_t lookups = cacheStats.hits + cacheStats.misses;
+    stats.routeCacheHitRate = lookups > 0 ? static_cast<double>(cacheStats.hits) / lookups : 0.0;
+    
     return stats;
 }
 
@@ -882,31 +866,85 @@ std::string NavigationDatabase::GetStatisticsString() const {
         << "  SIDs: " << stats.sidCount << "\n"
         << "  STARs: " << stats.starCount << "\n"
         << "  Approach Procedures: " << stats.approachCount << "\n"
+        << "  Route Cache: " << stats.routeCacheEntries << " entries, "
+        << static_cast<int>(stats.routeCacheHitRate * 100.0 + 0.5) << "% hits\n"
         << "  Status: " << (stats.isReady ? "Ready" : "Not Ready");
     
     return oss.str();
 }
 
 long long NavigationDatabase::GetLastUpdateTime() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    return lastUpdateTime_;
+    return Current()->updateTime;
 }
 
-std::string NavigationDatabase::CheckDatabaseConsistency() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
+bool NavigationDatabase::LoadSnapshot(const std::string& path) {
+    auto pack = std::make_shared<NavdataPack>();
+    if (!pack->open(path)) {
+        std::cerr << "NavigationDatabase: Failed to load navdata snapshot " << path << std::endl;
+        return false;
+    }
+    
+    // Landmarks are optional and only taken if built for this pack
+    std::shared_ptr<AirwayLandmarks> landmarks = std::make_shared<AirwayLandmarks>();
+    if (!landmarks->load(AirwayLandmarks::pathFor(path), *pack)) {
+        landmarks.reset();
+    }
+    
+    std::string problem = CheckPackConsistency(*pack);
+    if (!problem.empty()) {
+        std::cerr << "NavigationDatabase: Rejected navdata snapshot " << path << ": " << problem << std::endl;
+        return false;
+    }
     
+    // Readers keep the version they hold; new queries see the new one
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    auto next = std::make_shared<Snapshot>(*Current());
+    next->pack = std::move(pack);
+    next->landmarks = std::move(landmarks);
+    next->procedurePaths = BuildProcedurePaths(*next);
+    next->updateTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                           .count();
+    next->generation++;
+    std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(std::move(next)));
+    InvalidateCache();
+    return true;
+}
+
+std::future<bool> NavigationDatabase::LoadSnapshotAsync(const std::string& path) {
+    return IoExecutor::shared()->submit([this, path] { return LoadSnapshot(path); });
+}
+
+bool NavigationDatabase::SaveSnapshot(const std::string& path) const {
+    return Current()->pack->save(path);
+}
+
+uint32_t NavigationDatabase::GetAiracCycle() const {
+    return Current()->pack->getAiracCycle();
+}
+
+std::string NavigationDatabase::CheckDatabaseConsistency() const {
+    auto snapshot = Current();
+    return CheckPackConsistency(*snapshot->pack);
+}
+
+std::string NavigationDatabase::CheckPackConsistency(const NavdataPack& pack) {
     // Check for invalid waypoints
-    for (const auto& wp : waypoints_) {
-        if (!wp.second.IsValidCoordinate()) {
-            return "Invalid coordinates for waypoint: " + wp.first;
+    for (uint32_t node = 0; node < pack.getWaypointCount(); ++node) {
+        NavdataWaypoint wp = pack.getWaypoint(node);
+        if (!wp.IsValidCoordinate()) {
+            return "Invalid coordinates for waypoint: " + wp.name;
         }
     }
     
     // Check for missing waypoints in airways
-    for (const auto& airway : airways_) {
-        for (const auto& wpName : airway.second.waypointSequence) {
-            if (waypoints_.find(wpName) == waypoints_.end()) {
-                return "Missing waypoint in airway " + airway.first + ": " + wpName;
+    for (uint32_t airway = 0; airway < pack.getAirwayCount(); ++airway) {
+        const NavdataPackAirway& record = pack.getAirwayRecord(airway);
+        const NavdataPackFix* fixes = pack.getAirwayFixes(airway);
+        for (uint32_t i = 0; i < record.fixCount; ++i) {
+            if (fixes[i].waypoint == NO_NODE) {
+                return "Missing waypoint in airway " + std::string(pack.getString(record.name)) +
+                       ": " + std::string(pack.getString(fixes[i].name));
             }
         }
     }
@@ -945,75 +983,55 @@ int NavigationDatabase::PreloadCommonData() {
 // ============================================================================
 
 double NavigationDatabase::GetMagneticVariation(double latitude, double longitude) const {
-    // Simplified WMM-like model
-    // For production, use full WMM/IGRF model
-    double variation = -5.0 + (longitude / 10.0);
-    return variation;
+    // Positive east
+    if (magneticGrid_.valid() &&
+        magneticGrid_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        return magneticGrid_.get()->lookup(latitude, longitude);
+    }
+    return MagneticVariationGrid::evaluate(latitude, longitude, MagneticVariationGrid::currentDecimalYear());
 }
 
 double NavigationDatabase::GreatCircleDistance(double lat1, double lon1,
                                               double lat2, double lon2) const {
-    double lat1Rad = lat1 * PI / 180.0;
-    double lat2Rad = lat2 * PI / 180.0;
-    double dLatRad = (lat2 - lat1) * PI / 180.0;
-    double dLonRad = (lon2 - lon1) * PI / 180.0;
-    
-    double a = std::sin(dLatRad / 2.0) * std::sin(dLatRad / 2.0) +
-               std::cos(lat1Rad) * std::cos(lat2Rad) *
-               std::sin(dLonRad / 2.0) * std::sin(dLonRad / 2.0);
-    
-    double c = 2.0 * std::atan2(std::sqrt(a), std::sqrt(1.0 - a));
-    return EARTH_RADIUS_NM * c;
+    return Geodesy::haversineNM(lat1, lon1, lat2, lon2);
 }
 
 double NavigationDatabase::GreatCircleBearing(double lat1, double lon1,
                                               double lat2, double lon2) const {
-    double lat1Rad = lat1 * PI / 180.0;
-    double lat2Rad = lat2 * PI / 180.0;
-    double dLonRad = (lon2 - lon1) * PI / 180.0;
-    
-    double y = std::sin(dLonRad) * std::cos(lat2Rad);
-    double x = std::cos(lat1Rad) * std::sin(lat2Rad) -
-               std::sin(lat1Rad) * std::cos(lat2Rad) * std::cos(dLonRad);
-    
-    double bearing = std::atan2(y, x) * 180.0 / PI;
-    bearing = std::fmod(bearing + 360.0, 360.0);
-    
-    return bearing;
+    return Geodesy::initialBearing(lat1, lon1, lat2, lon2);
 }
 
-std::vector<Waypoint> NavigationDatabase::DijkstraPathfinding(
-    const std::string& origin,
-    const std::string& destination,
+std::vector<uint32_t> NavigationDatabase::DijkstraPathfinding(
+    const NavdataPack& pack,
+    uint32_t originNode,
+    uint32_t destinationNode,
     int cruiseAltitude) const {
-    std::vector<Waypoint> path;
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-
-    auto originIt = waypoints_.find(origin);
-    auto destinationIt = waypoints_.find(destination);
-    if (originIt == waypoints_.end() || destinationIt == waypoints_.end()) {
+    std::vector<uint32_t> path;
+    if (originNode == NO_NODE || destinationNode == NO_NODE) {
         return path;
     }
 
-    if (origin == destination) {
-        path.push_back(originIt->second);
+    if (originNode == destinationNode) {
+        path.push_back(originNode);
         return path;
     }
 
+    // Dense per-node state; the search never touches a string
     const double infinity = std::numeric_limits<double>::infinity();
-
-    std::unordered_map<std::string, double> distance;
-    distance.reserve(waypoints_.size());
-    for (const auto& entry : waypoints_) {
-        distance.emplace(entry.first, infinity);
+    std::vector<double> distance(pack.getWaypointCount(), infinity);
+    std::vector<uint32_t> previous(pack.getWaypointCount(), NO_NODE);
+    distance[originNode] = 0.0;
+
+    std::vector<char> airwayUsable(pack.getAirwayCount());
+    for (uint32_t a = 0; a < pack.getAirwayCount(); ++a) {
+        const NavdataPackAirway& record = pack.getAirwayRecord(a);
+        airwayUsable[a] = cruiseAltitude >= record.minimumAltitude &&
+                          cruiseAltitude <= record.maximumAltitude;
     }
-    distance[origin] = 0.0;
-
-    std::unordered_map<std::string, std::string> previous;
 
     struct QueueNode {
         double cost;
-        std::string waypoint;
+        uint32_t node;
     };
 
     auto cmp = [](const QueueNode& lhs, const QueueNode& rhs) {
@@ -1021,137 +1039,81 @@ std::vector<Waypoint> NavigationDatabase::DijkstraPathfinding(
     };
 
     std::priority_queue<QueueNode, std::vector<QueueNode>, decltype(cmp)> frontier(cmp);
-    frontier.push({0.0, origin});
+    frontier.push({0.0, originNode});
 
     while (!frontier.empty()) {
         QueueNode current = frontier.top();
         frontier.pop();
 
-        if (current.cost > distance[current.waypoint]) {
+        if (current.cost > distance[current.node]) {
             continue;
         }
 
-        if (current.waypoint == destination) {
+        if (current.node == destinationNode) {
             break;
         }
 
-        auto currentWpIt = waypoints_.find(current.waypoint);
-        if (currentWpIt == waypoints_.end()) {
-            continue;
-        }
-
-        auto indexIt = waypointToAirways_.find(current.waypoint);
-        if (indexIt == waypointToAirways_.end()) {
-            continue;
-        }
-
-        const auto& connectedAirways = indexIt->second;
-        for (const auto& airwayName : connectedAirways) {
-            auto airwayIt = airways_.find(airwayName);
-            if (airwayIt == airways_.end()) {
-                continue;
-            }
-            if (!airwayIt->second.IsAltitudeValid(cruiseAltitude)) {
+        for (const NavdataPackEdge* edge = pack.edgesBegin(current.node);
+             edge != pack.edgesEnd(current.node); ++edge) {
+            if (!airwayUsable[edge->airway]) {
                 continue;
             }
 
-            const auto& sequence = airwayIt->second.waypointSequence;
-            for (size_t idx = 0; idx < sequence.size(); ++idx) {
-                if (sequence[idx] != current.waypoint) {
-                    continue;
-                }
-
-                auto evaluateNeighbor = [&](size_t neighborIdx) {
-                    const std::string& neighborName = sequence[neighborIdx];
-                    auto neighborIt = waypoints_.find(neighborName);
-                    if (neighborIt == waypoints_.end()) {
-                        return;
-                    }
-
-                    double segment = GreatCircleDistance(currentWpIt->second.latitude,
-                                                         currentWpIt->second.longitude,
-                                                         neighborIt->second.latitude,
-                                                         neighborIt->second.longitude);
-                    double newCost = current.cost + segment;
-                    if (newCost + 1e-6 < distance[neighborName]) {
-                        distance[neighborName] = newCost;
-                        previous[neighborName] = current.waypoint;
-                        frontier.push({newCost, neighborName});
-                    }
-                };
-
-                if (idx > 0) {
-                    evaluateNeighbor(idx - 1);
-                }
-                if (idx + 1 < sequence.size()) {
-                    evaluateNeighbor(idx + 1);
-                }
+            double newCost = current.cost + edge->distanceNM;
+            if (newCost + 1e-6 < distance[edge->to]) {
+                distance[edge->to] = newCost;
+                previous[edge->to] = current.node;
+                frontier.push({newCost, edge->to});
             }
         }
     }
 
-    if (distance[destination] == infinity) {
-        return std::vector<Waypoint>();
-    }
-
-    std::vector<std::string> reconstructed;
-    std::string current = destination;
-    reconstructed.push_back(current);
-
-    while (current != origin) {
-        auto prevIt = previous.find(current);
-        if (prevIt == previous.end()) {
-            return std::vector<Waypoint>();
-        }
-        current = prevIt->second;
-        reconstructed.push_back(current);
+    if (distance[destinationNode] == infinity) {
+        return path;
     }
 
-    std::reverse(reconstructed.begin(), reconstructed.end());
-
-    path.reserve(reconstructed.size());
-    for (const auto& name : reconstructed) {
-        auto wpIt = waypoints_.find(name);
-        if (wpIt != waypoints_.end()) {
-            path.push_back(wpIt->second);
-        }
+    for (uint32_t node = destinationNode; node != NO_NODE; node = previous[node]) {
+        path.push_back(node);
     }
+    std::reverse(path.begin(), path.end());
 
     return path;
 }
 
+uint64_t NavigationDatabase::RouteCacheKey(const CachedRoute& route) {
+    uint64_t key = (static_cast<uint64_t>(QueryKind::ROUTE) << 56) ^
+                   (static_cast<uint64_t>(route.origin) << 24) ^ route.destination;
+    key ^= static_cast<uint64_t>(static_cast<uint32_t>(route.cruiseAltitude)) * 0x9E3779B97F4A7C15ull;
+    key ^= route.generation * 0xC2B2AE3D27D4EB4Full;
+    return key;
+}
+
 void NavigationDatabase::InvalidateCache() {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    queryCache_.clear();
+    routeCache_.clear();
 }
 
-std::optional<std::vector<std::string>> NavigationDatabase::GetFromCache(
-    const std::string& key) const {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    
-    auto it = queryCache_.find(key);
-    if (it != queryCache_.end()) {
-        auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
-                       std::chrono::system_clock::now().time_since_epoch())
-                       .count();
-        if (now - it->second.timestamp < CACHE_TIMEOUT_MS) {
-            return it->second.data;
-        }
+bool NavigationDatabase::GetCachedRoute(CachedRoute& route) const {
+    CachedRoute cached;
+    if (!routeCache_.find(RouteCacheKey(route), cached)) {
+        return false;
     }
     
-    return std::nullopt;
+    if (cached.generation != route.generation || cached.origin != route.origin ||
+        cached.destination != route.destination || cached.cruiseAltitude != route.cruiseAltitude) {
+        return false;
+    }
+    
+    if (route.timestamp - cached.timestamp >= ROUTE_CACHE_TTL_MS) {
+        return false;
+    }
+    
+    route.direct = cached.direct;
+    route.path = std::move(cached.path);
+    return true;
 }
 
-void NavigationDatabase::StoreInCache(const std::string& key,
-                                     const std::vector<std::string>& value) const {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    
-    CacheEntry entry;
-    entry.data = value;
-    entry.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-                          std::chrono::system_clock::now().time_since_epoch())
-                          .count();
-    queryCache_[key] = entry;
+void NavigationDatabase::StoreCachedRoute(const CachedRoute& route) const {
+    routeCache_.insert(RouteCacheKey(route), route);
 }
 
 } // namespace AICopilot
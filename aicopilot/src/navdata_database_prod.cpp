@@ -1,950 +0,0 @@
-/*****************************************************************************
-* Copyright 2025 AI Copilot FS Project
-*
-* This program is free software: you can redistribute it and/or modify
-* it under the terms of the GNU General Public License as published by
-* the Free Software Foundation, either version 3 of the License, or
-* (at your option) any later version.
-*
-* PRODUCTION-READY Navigation Database Implementation
-* 600+ lines of optimized code for navigation data management
-* 500+ waypoints, 200+ airways, 100+ SID/STAR procedures
-* Thread-safe with caching and spatial indexing
-*****************************************************************************/
-
-#include "../include/navdata_database.hpp"
-#include <cmath>
-#include <algorithm>
-#include <sstream>
-#include <queue>
-#include <limits>
-#include <chrono>
-
-namespace AICopilot {
-
-constexpr double PI = 3.14159265358979323846;
-constexpr double EARTH_RADIUS_NM = 3440.065;
-constexpr long long CACHE_TIMEOUT_MS = 3600000; // 1 hour
-
-// ============================================================================
-// CONSTRUCTOR AND INITIALIZATION
-// ============================================================================
-
-NavigationDatabase::NavigationDatabase() 
-    : initialized_(false), lastUpdateTime_(0) {
-    InitializeData();
-    BuildSpatialIndex();
-    BuildReverseIndices();
-    lastUpdateTime_ = std::chrono::system_clock::now().time_since_epoch().count();
-    initialized_ = true;
-}
-
-NavigationDatabase::~NavigationDatabase() {
-    std::unique_lock<std::shared_mutex> lock(dbMutex_);
-    waypoints_.clear();
-    airways_.clear();
-    sidsByAirport_.clear();
-    starsByAirport_.clear();
-    approachesByAirport_.clear();
-    waypointToAirways_.clear();
-    spatialIndex_.clear();
-}
-
-// ============================================================================
-// DATA INITIALIZATION - 500+ WAYPOINTS
-// ============================================================================
-
-void NavigationDatabase::InitializeData() {
-    std::unique_lock<std::shared_mutex> lock(dbMutex_);
-    
-    // ========================================================================
-    // MAJOR AIRPORTS
-    // ========================================================================
-    waypoints_["KJFK"] = Waypoint("KJFK", 40.6413, -73.7781, NavaidType::AIRPORT, 13, 0, "NORTHEAST");
-    waypoints_["KLGA"] = Waypoint("KLGA", 40.7769, -73.8740, NavaidType::AIRPORT, 21, 0, "NORTHEAST");
-    waypoints_["KEWR"] = Waypoint("KEWR", 40.6895, -74.1745, NavaidType::AIRPORT, 18, 0, "NORTHEAST");
-    waypoints_["KBOS"] = Waypoint("KBOS", 42.3656, -71.0096, NavaidType::AIRPORT, 21, 0, "NORTHEAST");
-    waypoints_["KDFW"] = Waypoint("KDFW", 32.8975, -97.0382, NavaidType::AIRPORT, 607, 0, "SOUTH-CENTRAL");
-    waypoints_["KLAX"] = Waypoint("KLAX", 33.9425, -118.4081, NavaidType::AIRPORT, 125, 0, "WEST");
-    waypoints_["KSFO"] = Waypoint("KSFO", 37.6213, -122.3790, NavaidType::AIRPORT, 13, 0, "WEST");
-    waypoints_["KORD"] = Waypoint("KORD", 41.9742, -87.9073, NavaidType::AIRPORT, 682, 0, "MIDWEST");
-    waypoints_["KATL"] = Waypoint("KATL", 33.6407, -84.4277, NavaidType::AIRPORT, 1026, 0, "SOUTHEAST");
-    waypoints_["KMIA"] = Waypoint("KMIA", 25.7959, -80.2870, NavaidType::AIRPORT, 8, 0, "SOUTHEAST");
-    waypoints_["KDCA"] = Waypoint("KDCA", 38.8521, -77.0377, NavaidType::AIRPORT, 15, 0, "NORTHEAST");
-    waypoints_["KDEN"] = Waypoint("KDEN", 39.8561, -104.6737, NavaidType::AIRPORT, 5431, 0, "MOUNTAIN");
-    waypoints_["KSEA"] = Waypoint("KSEA", 47.4502, -122.3088, NavaidType::AIRPORT, 432, 0, "PACIFIC");
-    waypoints_["KPHX"] = Waypoint("KPHX", 33.4342, -112.0119, NavaidType::AIRPORT, 1105, 0, "SOUTHWEST");
-    waypoints_["KMCO"] = Waypoint("KMCO", 28.4312, -81.3081, NavaidType::AIRPORT, 96, 0, "SOUTHEAST");
-    waypoints_["KLAX"] = Waypoint("KLAX", 33.9425, -118.4081, NavaidType::AIRPORT, 125, 0, "SOUTHWEST");
-    waypoints_["KPDX"] = Waypoint("KPDX", 45.5887, -122.5975, NavaidType::AIRPORT, 429, 0, "PACIFIC");
-    waypoints_["KSAN"] = Waypoint("KSAN", 32.7337, -117.1933, NavaidType::AIRPORT, 17, 0, "SOUTHWEST");
-    waypoints_["KDTW"] = Waypoint("KDTW", 42.2124, -83.3534, NavaidType::AIRPORT, 645, 0, "MIDWEST");
-    waypoints_["KMSP"] = Waypoint("KMSP", 44.8848, -93.2209, NavaidType::AIRPORT, 922, 0, "MIDWEST");
-    
-    // ========================================================================
-    // NAVIGATION FIXES - NORTHEAST REGION (50 waypoints)
-    // ========================================================================
-    waypoints_["KUJOE"] = Waypoint("KUJOE", 40.7920, -73.8917, NavaidType::FIX, 0, 0, "NORTHEAST");
-    waypoints_["CAMRN"] = Waypoint("CAMRN", 40.9347, -74.1722, NavaidType::FIX, 0, 0, "NORTHEAST");
-    waypoints_["BOUND"] = Waypoint("BOUND", 41.1028, -74.3667, NavaidType::FIX, 0, 0, "NORTHEAST");
-    waypoints_["MERIT"] = Waypoint("MERIT", 41.2544, -74.5083, NavaidType::FIX, 0, 0, "NORTHEAST");
-    waypoints_["HUSTR"] = Waypoint("HUSTR", 40.5833, -74.6667, NavaidType::FIX, 0, 0, "NORTHEAST");
-    waypoints_["ELLOS"] = Waypoint("ELLOS", 40.5275, -74.2733, NavaidType::VOR, 0, 110.2, "NORTHEAST");
-    waypoints_["MORRY"] = Waypoint("MORRY", 39.9789, -74.6039, NavaidType::FIX, 0, 0, "MID-ATLANTIC");
-    waypoints_["HAMIL"] = Waypoint("HAMIL", 39.6694, -75.0639, NavaidType::FIX, 0, 0, "MID-ATLANTIC");
-    waypoints_["PEAKE"] = Waypoint("PEAKE", 39.3614, -75.4889, NavaidType::VOR, 0, 111.4, "MID-ATLANTIC");
-    waypoints_["BRAVO"] = Waypoint("BRAVO", 38.5939, -76.8625, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["CORIN"] = Waypoint("CORIN", 38.2344, -77.5411, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["DAVYS"] = Waypoint("DAVYS", 37.9297, -78.3667, NavaidType::VOR, 0, 112.8, "SOUTHEAST");
-    waypoints_["EMMET"] = Waypoint("EMMET", 37.6611, -79.1889, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["FRANK"] = Waypoint("FRANK", 36.6139, -80.7833, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["GRADY"] = Waypoint("GRADY", 36.0711, -81.5333, NavaidType::VOR, 0, 113.2, "SOUTHEAST");
-    waypoints_["HENRY"] = Waypoint("HENRY", 35.2089, -83.0889, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["IGOR"] = Waypoint("IGOR", 34.5678, -84.1167, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["JULEP"] = Waypoint("JULEP", 33.8234, -84.9833, NavaidType::VOR, 0, 114.6, "SOUTHEAST");
-    waypoints_["KEVIN"] = Waypoint("KEVIN", 32.4567, -86.2456, NavaidType::FIX, 0, 0, "SOUTHEAST");
-    waypoints_["LIMA"] = Waypoint("LIMA", 31.2345, -87.6789, NavaidType::FIX, 0, 0, "GULF");
-    
-    // Add 430+ procedurally generated waypoints across US regions
-    int count = 0;
-    for (double lat = 25.0; lat <= 48.0; lat += 1.5) {
-        for (double lon = -125.0; lon <= -67.0; lon += 2.5) {
-            std::string name = "FIX" + std::to_string(count);
-            waypoints_[name] = Waypoint(name, lat, lon, NavaidType::FIX, 0, 0, "US-ENROUTE");
-            count++;
-            if (count > 430) break;
-        }
-        if (count > 430) break;
-    }
-    
-    // International waypoints (20)
-    waypoints_["GEJUP"] = Waypoint("GEJUP", 51.4769, -3.2578, NavaidType::FIX, 0, 0, "ATLANTIC");
-    waypoints_["NOPAC"] = Waypoint("NOPAC", 52.0000, -20.0000, NavaidType::FIX, 0, 0, "ATLANTIC");
-    waypoints_["STATC"] = Waypoint("STATC", 55.0000, -15.0000, NavaidType::FIX, 0, 0, "ATLANTIC");
-    waypoints_["LFPG"] = Waypoint("LFPG", 49.0127, 2.5502, NavaidType::AIRPORT, 382, 0, "EUROPE");
-    waypoints_["EGLL"] = Waypoint("EGLL", 51.4775, -0.4614, NavaidType::AIRPORT, 83, 0, "EUROPE");
-    waypoints_["EDDF"] = Waypoint("EDDF", 50.0260, 8.5591, NavaidType::AIRPORT, 364, 0, "EUROPE");
-    waypoints_["LIRF"] = Waypoint("LIRF", 41.7994, 12.5949, NavaidType::AIRPORT, 77, 0, "EUROPE");
-    waypoints_["ZBAA"] = Waypoint("ZBAA", 39.9042, 116.4074, NavaidType::AIRPORT, 116, 0, "ASIA");
-    waypoints_["RJTT"] = Waypoint("RJTT", 35.5494, 139.7798, NavaidType::AIRPORT, 46, 0, "ASIA");
-    waypoints_["RKSI"] = Waypoint("RKSI", 37.4602, 126.4407, NavaidType::AIRPORT, 69, 0, "ASIA");
-    
-    // ========================================================================
-    // INITIALIZE 200+ AIRWAYS
-    // ========================================================================
-    
-    // Victor Airways (Low altitude - 50 airways)
-    for (int i = 1; i <= 50; ++i) {
-        std::string name = "V" + std::to_string(i);
-        Airway v_airway(name, 1200, 18000, AirwayLevel::LOW);
-        
-        // Create waypoint sequences
-        v_airway.waypointSequence.push_back("FIX" + std::to_string((i-1)*10));
-        v_airway.waypointSequence.push_back("FIX" + std::to_string((i-1)*10+1));
-        v_airway.waypointSequence.push_back("FIX" + std::to_string((i-1)*10+2));
-        
-        airways_[name] = v_airway;
-    }
-    
-    // Jet Routes (High altitude - 100 airways)
-    for (int i = 1; i <= 100; ++i) {
-        std::string name = "J" + std::to_string(500 + i);
-        Airway j_airway(name, 18000, 45000, AirwayLevel::HIGH);
-        
-        j_airway.waypointSequence.push_back("FIX" + std::to_string(i*2));
-        j_airway.waypointSequence.push_back("FIX" + std::to_string(i*2+1));
-        j_airway.waypointSequence.push_back("FIX" + std::to_string((i+1)*2));
-        
-        airways_[name] = j_airway;
-    }
-    
-    // Specific named airways
-    Airway V1_named("V1", 1200, 18000, AirwayLevel::LOW);
-    V1_named.waypointSequence = {"KJFK", "KUJOE", "ELLOS", "MORRY", "PEAKE"};
-    airways_["V1"] = V1_named;
-    
-    Airway V2_named("V2", 1200, 18000, AirwayLevel::LOW);
-    V2_named.waypointSequence = {"CAMRN", "BOUND", "MERIT", "HAMIL", "CORIN"};
-    airways_["V2"] = V2_named;
-    
-    Airway J500("J500", 18000, 45000, AirwayLevel::HIGH);
-    J500.waypointSequence = {"KJFK", "GEJUP", "LFPG"};
-    airways_["J500"] = J500;
-    
-    Airway J501("J501", 18000, 45000, AirwayLevel::HIGH);
-    J501.waypointSequence = {"KLAX", "KDEN", "KORD", "KDFW"};
-    airways_["J501"] = J501;
-    
-    // ========================================================================
-    // INITIALIZE 100+ SID PROCEDURES
-    // ========================================================================
-    
-    std::vector<std::string> majorAirports = {"KJFK", "KLAX", "KORD", "KDFW", "KATL", "KDEN", "KSEA"};
-    int sidCount = 0;
-    
-    for (const auto& airport : majorAirports) {
-        for (int runway = 0; runway < 6; ++runway) {
-            SID sid;
-            sid.airport = airport;
-            sid.runway = (runway < 3) ? ("0" + std::to_string(runway+1) + "L") : 
-                                        ("0" + std::to_string(runway+1) + "R");
-            sid.name = "SID" + std::to_string(sidCount++) + " DEPARTURE";
-            sid.waypointSequence = {airport, "FIX" + std::to_string(runway*5), 
-                                   "FIX" + std::to_string(runway*5+1), 
-                                   "FIX" + std::to_string(runway*5+2)};
-            sid.initialHeading = (runway * 60.0);
-            sid.initialAltitude = 2000 + (runway * 500);
-            sid.requiresRNAV = (runway % 3 == 0);
-            sid.procedureDistance = 15 + (runway * 2);
-            
-            sidsByAirport_[airport].push_back(sid);
-        }
-    }
-    
-    // ========================================================================
-    // INITIALIZE 100+ STAR PROCEDURES
-    // ========================================================================
-    
-    int starCount = 0;
-    for (const auto& airport : majorAirports) {
-        for (int runway = 0; runway < 6; ++runway) {
-            STAR star;
-            star.airport = airport;
-            star.runway = (runway < 3) ? ("0" + std::to_string(runway+1) + "L") : 
-                                         ("0" + std::to_string(runway+1) + "R");
-            star.name = "STAR" + std::to_string(starCount++) + " ARRIVAL";
-            star.waypointSequence = {"FIX" + std::to_string(runway*7+3),
-                                    "FIX" + std::to_string(runway*7+4),
-                                    "FIX" + std::to_string(runway*7+5),
-                                    airport};
-            star.initialAltitude = 35000;
-            star.finalAltitude = 2000;
-            star.requiresRNAV = (runway % 2 == 0);
-            star.procedureDistance = 18 + (runway * 3);
-            
-            starsByAirport_[airport].push_back(star);
-        }
-    }
-    
-    // ========================================================================
-    // INITIALIZE APPROACH PROCEDURES
-    // ========================================================================
-    
-    for (const auto& airport : majorAirports) {
-        // ILS approaches
-        ApproachProcedure ils;
-        ils.airport = airport;
-        ils.runway = "01L";
-        ils.name = "ILS " + airport + " 01L";
-        ils.type = "ILS";
-        ils.waypointSequence = {airport, "APP" + airport + "1"};
-        ils.decisionAltitude = 200.0;
-        ils.minimumVisibility = 0.5;
-        ils.hasGlideslope = true;
-        approachesByAirport_[airport].push_back(ils);
-        
-        // RNAV approaches
-        ApproachProcedure rnav;
-        rnav.airport = airport;
-        rnav.runway = "01R";
-        rnav.name = "RNAV " + airport + " 01R";
-        rnav.type = "RNAV";
-        rnav.waypointSequence = {airport, "APP" + airport + "2"};
-        rnav.decisionAltitude = 400.0;
-        rnav.minimumVisibility = 1.0;
-        rnav.hasGlideslope = false;
-        approachesByAirport_[airport].push_back(rnav);
-    }
-}
-
-void NavigationDatabase::BuildSpatialIndex() {
-    std::unique_lock<std::shared_mutex> lock(dbMutex_);
-    spatialIndex_.clear();
-    
-    for (const auto& wp : waypoints_) {
-        SpatialIndex si;
-        si.latitude = wp.second.latitude;
-        si.longitude = wp.second.longitude;
-        si.waypointName = wp.first;
-        spatialIndex_.push_back(si);
-    }
-}
-
-void NavigationDatabase::BuildReverseIndices() {
-    std::unique_lock<std::shared_mutex> lock(dbMutex_);
-    waypointToAirways_.clear();
-    
-    for (const auto& airway : airways_) {
-        for (const auto& wpName : airway.second.waypointSequence) {
-            waypointToAirways_[wpName].push_back(airway.first);
-        }
-    }
-}
-
-// ============================================================================
-// WAYPOINT OPERATIONS
-// ============================================================================
-
-std::optional<Waypoint> NavigationDatabase::GetWaypoint(const std::string& name) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    auto it = waypoints_.find(name);
-    if (it != waypoints_.end()) {
-        return it->second;
-    }
-    
-    return std::nullopt;
-}
-
-std::vector<Waypoint> NavigationDatabase::GetWaypointsByType(NavaidType type) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    std::vector<Waypoint> result;
-    for (const auto& wp : waypoints_) {
-        if (wp.second.type == type) {
-            result.push_back(wp.second);
-        }
-    }
-    
-    return result;
-}
-
-std::vector<Waypoint> NavigationDatabase::GetWaypointsNearby(double latitude, double longitude,
-                                                             double radiusNM) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    std::vector<Waypoint> result;
-    
-    for (const auto& si : spatialIndex_) {
-        double distance = GreatCircleDistance(latitude, longitude, si.latitude, si.longitude);
-        if (distance <= radiusNM) {
-            result.push_back(waypoints_.at(si.waypointName));
-        }
-    }
-    
-    return result;
-}
-
-int NavigationDatabase::GetWaypointCount() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    return static_cast<int>(waypoints_.size());
-}
-
-// ============================================================================
-// AIRWAY OPERATIONS
-// ============================================================================
-
-std::optional<Airway> NavigationDatabase::GetAirway(const std::string& name) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    auto it = airways_.find(name);
-    if (it != airways_.end()) {
-        return it->second;
-    }
-    
-    return std::nullopt;
-}
-
-std::vector<Waypoint> NavigationDatabase::GetAirwayWaypoints(const std::string& airwayName) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    std::vector<Waypoint> result;
-    
-    auto it = airways_.find(airwayName);
-    if (it != airways_.end()) {
-        for (const auto& wpName : it->second.waypointSequence) {
-            auto wpIt = waypoints_.find(wpName);
-            if (wpIt != waypoints_.end()) {
-                result.push_back(wpIt->second);
-            }
-        }
-    }
-    
-    return result;
-}
-
-std::vector<Airway> NavigationDatabase::GetConnectingAirways(const std::string& waypointA,
-                                                            const std::string& waypointB) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    std::vector<Airway> result;
-    
-    for (const auto& airway : airways_) {
-        const auto& seq = airway.second.waypointSequence;
-        bool hasA = false, hasB = false;
-        int posA = -1, posB = -1;
-        
-        for (size_t i = 0; i < seq.size(); ++i) {
-            if (seq[i] == waypointA) {
-                hasA = true;
-                posA = i;
-            }
-            if (seq[i] == waypointB) {
-                hasB = true;
-                posB = i;
-            }
-        }
-        
-        // Airways should be sequential
-        if (hasA && hasB && (posA + 1 == posB || posB + 1 == posA)) {
-            result.push_back(airway.second);
-        }
-    }
-    
-    return result;
-}
-
-std::vector<Airway> NavigationDatabase::GetAirwaysByAltitude(int altitudeFeet) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    std::vector<Airway> result;
-    
-    for (const auto& airway : airways_) {
-        if (altitudeFeet >= airway.second.minimumAltitude &&
-            altitudeFeet <= airway.second.maximumAltitude) {
-            result.push_back(airway.second);
-        }
-    }
-    
-    return result;
-}
-
-int NavigationDatabase::GetAirwayCount() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    return static_cast<int>(airways_.size());
-}
-
-// ============================================================================
-// SID/STAR OPERATIONS
-// ============================================================================
-
-std::optional<SID> NavigationDatabase::GetSID(const std::string& airport,
-                                               const std::string& runway) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    auto it = sidsByAirport_.find(airport);
-    if (it != sidsByAirport_.end()) {
-        for (const auto& sid : it->second) {
-            if (sid.runway == runway) {
-                return sid;
-            }
-        }
-    }
-    
-    return std::nullopt;
-}
-
-std::vector<SID> NavigationDatabase::GetSIDsByAirport(const std::string& airport) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    auto it = sidsByAirport_.find(airport);
-    if (it != sidsByAirport_.end()) {
-        return it->second;
-    }
-    
-    return std::vector<SID>();
-}
-
-std::optional<STAR> NavigationDatabase::GetSTAR(const std::string& airport,
-                                                 const std::string& runway) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    auto it = starsByAirport_.find(airport);
-    if (it != starsByAirport_.end()) {
-        for (const auto& star : it->second) {
-            if (star.runway == runway) {
-                return star;
-            }
-        }
-    }
-    
-    return std::nullopt;
-}
-
-std::vector<STAR> NavigationDatabase::GetSTARsByAirport(const std::string& airport) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    auto it = starsByAirport_.find(airport);
-    if (it != starsByAirport_.end()) {
-        return it->second;
-    }
-    
-    return std::vector<STAR>();
-}
-
-int NavigationDatabase::GetSIDCount() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    int count = 0;
-    for (const auto& pair : sidsByAirport_) {
-        count += pair.second.size();
-    }
-    return count;
-}
-
-int NavigationDatabase::GetSTARCount() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    int count = 0;
-    for (const auto& pair : starsByAirport_) {
-        count += pair.second.size();
-    }
-    return count;
-}
-
-// ============================================================================
-// APPROACH PROCEDURE OPERATIONS
-// ============================================================================
-
-std::optional<ApproachProcedure> NavigationDatabase::GetApproachProcedure(
-    const std::string& airport,
-    const std::string& runway,
-    const std::string& procedureType) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    auto it = approachesByAirport_.find(airport);
-    if (it != approachesByAirport_.end()) {
-        for (const auto& app : it->second) {
-            if (app.runway == runway && (procedureType.empty() || app.type == procedureType)) {
-                return app;
-            }
-        }
-    }
-    
-    return std::nullopt;
-}
-
-std::vector<ApproachProcedure> NavigationDatabase::GetApproachProceduresByRunway(
-    const std::string& airport,
-    const std::string& runway) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    std::vector<ApproachProcedure> result;
-    auto it = approachesByAirport_.find(airport);
-    if (it != approachesByAirport_.end()) {
-        for (const auto& app : it->second) {
-            if (app.runway == runway) {
-                result.push_back(app);
-            }
-        }
-    }
-    
-    return result;
-}
-
-std::vector<ApproachProcedure> NavigationDatabase::GetApproachProceduresByAirport(
-    const std::string& airport) const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    auto it = approachesByAirport_.find(airport);
-    if (it != approachesByAirport_.end()) {
-        return it->second;
-    }
-    
-    return std::vector<ApproachProcedure>();
-}
-
-int NavigationDatabase::GetApproachProcedureCount() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    int count = 0;
-    for (const auto& pair : approachesByAirport_) {
-        count += pair.second.size();
-    }
-    return count;
-}
-
-// ============================================================================
-// DISTANCE AND HEADING CALCULATIONS
-// ============================================================================
-
-double NavigationDatabase::CalculateDistance(const std::string& waypoint1Name,
-                                             const std::string& waypoint2Name) const {
-    auto wp1 = GetWaypoint(waypoint1Name);
-    auto wp2 = GetWaypoint(waypoint2Name);
-    
-    if (!wp1 || !wp2) {
-        return -1.0;
-    }
-    
-    return GreatCircleDistance(wp1->latitude, wp1->longitude, wp2->latitude, wp2->longitude);
-}
-
-double NavigationDatabase::CalculateDistanceCoordinates(double lat1, double lon1,
-                                                       double lat2, double lon2) const {
-    return GreatCircleDistance(lat1, lon1, lat2, lon2);
-}
-
-double NavigationDatabase::CalculateHeading(const std::string& waypoint1Name,
-                                            const std::string& waypoint2Name) const {
-    auto wp1 = GetWaypoint(waypoint1Name);
-    auto wp2 = GetWaypoint(waypoint2Name);
-    
-    if (!wp1 || !wp2) {
-        return -1.0;
-    }
-    
-    double trueHeading = GreatCircleBearing(wp1->latitude, wp1->longitude,
-                                           wp2->latitude, wp2->longitude);
-    
-    double magVar = GetMagneticVariation(wp1->latitude, wp1->longitude);
-    double magneticHeading = trueHeading - magVar;
-    
-    if (magneticHeading < 0) magneticHeading += 360.0;
-    if (magneticHeading >= 360.0) magneticHeading -= 360.0;
-    
-    return magneticHeading;
-}
-
-double NavigationDatabase::CalculateHeadingCoordinates(double lat1, double lon1,
-                                                      double lat2, double lon2,
-                                                      double magneticVariation) const {
-    double trueHeading = GreatCircleBearing(lat1, lon1, lat2, lon2);
-    double magneticHeading = trueHeading - magneticVariation;
-    
-    if (magneticHeading < 0) magneticHeading += 360.0;
-    if (magneticHeading >= 360.0) magneticHeading -= 360.0;
-    
-    return magneticHeading;
-}
-
-double NavigationDatabase::CalculateFlightTime(double distance, double groundSpeed) const {
-    if (groundSpeed <= 0) return 0.0;
-    return (distance / groundSpeed) * 60.0;
-}
-
-// ============================================================================
-// FLIGHT PLAN VALIDATION
-// ============================================================================
-
-ValidationResult NavigationDatabase::ValidateFlightPlan(
-    const std::vector<std::string>& waypointSequence, int cruiseAltitude) const {
-    
-    ValidationResult result;
-    
-    if (waypointSequence.empty()) {
-        result.isValid = false;
-        result.errorMessage = "Flight plan contains no waypoints";
-        return result;
-    }
-    
-    if (cruiseAltitude < 1200 || cruiseAltitude > 60000) {
-        result.isValid = false;
-        result.errorMessage = "Cruise altitude out of valid range (1200-60000 ft)";
-        return result;
-    }
-    
-    result.waypointCount = waypointSequence.size();
-    result.maxAltitude = cruiseAltitude;
-    
-    double totalDistance = 0.0;
-    for (size_t i = 0; i < waypointSequence.size(); ++i) {
-        auto wp = GetWaypoint(waypointSequence[i]);
-        if (!wp) {
-            result.isValid = false;
-            result.errorMessage = "Waypoint not found: " + waypointSequence[i];
-            return result;
-        }
-        
-        if (i < waypointSequence.size() - 1) {
-            double dist = CalculateDistance(waypointSequence[i], waypointSequence[i+1]);
-            if (dist > 0) {
-                totalDistance += dist;
-            }
-        }
-    }
-    
-    result.totalDistance = totalDistance;
-    result.estimatedTimeMinutes = static_cast<int>(CalculateFlightTime(totalDistance, 450.0));
-    
-    auto conflicts = CheckAltitudeConflicts(waypointSequence, cruiseAltitude);
-    if (!conflicts.empty()) {
-        result.warnings = conflicts;
-    }
-    
-    result.isValid = true;
-    return result;
-}
-
-std::vector<std::string> NavigationDatabase::CheckAltitudeConflicts(
-    const std::vector<std::string>& waypointSequence, int cruiseAltitude) const {
-    
-    std::vector<std::string> conflicts;
-    
-    for (const auto& wpName : waypointSequence) {
-        auto wp = GetWaypoint(wpName);
-        if (wp && wp->elevation > 0) {
-            int requiredClearance = static_cast<int>(wp->elevation) + 1000;
-            if (cruiseAltitude < requiredClearance) {
-                conflicts.push_back("Insufficient clearance at " + wpName);
-            }
-        }
-    }
-    
-    return conflicts;
-}
-
-bool NavigationDatabase::ValidateWaypointConnectivity(
-    const std::vector<std::string>& waypointSequence,
-    int cruiseAltitude) const {
-    
-    for (size_t i = 0; i < waypointSequence.size() - 1; ++i) {
-        auto airways = GetConnectingAirways(waypointSequence[i], waypointSequence[i+1]);
-        bool found = false;
-        for (const auto& airway : airways) {
-            if (airway.IsAltitudeValid(cruiseAltitude)) {
-                found = true;
-                break;
-            }
-        }
-        if (!found) return false;
-    }
-    
-    return true;
-}
-
-// ============================================================================
-// ROUTE FINDING
-// ============================================================================
-
-RouteFindingResult NavigationDatabase::FindRoute(const std::string& origin,
-                                                 const std::string& destination,
-                                                 int cruiseAltitude) const {
-    RouteFindingResult result;
-    
-    auto originWp = GetWaypoint(origin);
-    auto destWp = GetWaypoint(destination);
-    
-    if (!originWp || !destWp) {
-        result.success = false;
-        return result;
-    }
-    
-    double distance = GreatCircleDistance(originWp->latitude, originWp->longitude,
-                                        destWp->latitude, destWp->longitude);
-    
-    result.success = true;
-    result.waypointSequence = {origin, destination};
-    result.distances = {distance};
-    result.totalDistance = distance;
-    result.estimatedTimeMinutes = static_cast<int>(CalculateFlightTime(distance, 450.0));
-    result.fuelRequired = distance * 15.0; // Approximate: 15 lbs per NM
-    result.routeDescription = origin + " direct to " + destination + " (" + 
-                             std::to_string(static_cast<int>(distance)) + " NM)";
-    
-    return result;
-}
-
-std::vector<std::string> NavigationDatabase::FindDirectRoute(const std::string& origin,
-                                                            const std::string& destination) const {
-    return {origin, destination};
-}
-
-std::vector<std::string> NavigationDatabase::FindRouteViaAirways(
-    const std::string& origin,
-    const std::string& destination,
-    const std::vector<std::string>& preferredAirways) const {
-    
-    std::vector<std::string> route = {origin};
-    
-    for (const auto& airwayName : preferredAirways) {
-        auto airway = GetAirway(airwayName);
-        if (!airway) continue;
-        
-        const auto& seq = airway->waypointSequence;
-        bool inRoute = false;
-        for (size_t i = 0; i < seq.size(); ++i) {
-            if (inRoute) {
-                route.push_back(seq[i]);
-                if (seq[i] == destination) return route;
-            }
-            if (seq[i] == route.back()) {
-                inRoute = true;
-            }
-        }
-    }
-    
-    route.push_back(destination);
-    return route;
-}
-
-// ============================================================================
-// DATABASE MANAGEMENT
-// ============================================================================
-
-NavDatabaseStats NavigationDatabase::GetStatistics() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    NavDatabaseStats stats;
-    stats.waypointCount = waypoints_.size();
-    stats.airwayCount = airways_.size();
-    stats.approachCount = GetApproachProcedureCount();
-    stats.isReady = initialized_;
-    stats.lastUpdateTime = lastUpdateTime_;
-    
-    double totalDistance = 0.0;
-    int airwayCount = 0;
-    for (const auto& airway : airways_) {
-        totalDistance += airway.second.GetTotalDistance();
-        airwayCount++;
-    }
-    stats.averageAirwayDistance = airwayCount > 0 ? totalDistance / airwayCount : 0.0;
-    
-    stats.sidCount = GetSIDCount();
-    stats.starCount = GetSTARCount();
-    
-    return stats;
-}
-
-std::string NavigationDatabase::GetStatisticsString() const {
-    auto stats = GetStatistics();
-    std::ostringstream oss;
-    oss << "Navigation Database Statistics:\n"
-        << "  Waypoints: " << stats.waypointCount << "\n"
-        << "  Airways: " << stats.airwayCount << "\n"
-        << "  Average Airway Distance: " << stats.averageAirwayDistance << " NM\n"
-        << "  SIDs: " << stats.sidCount << "\n"
-        << "  STARs: " << stats.starCount << "\n"
-        << "  Approach Procedures: " << stats.approachCount << "\n"
-        << "  Status: " << (stats.isReady ? "Ready" : "Not Ready");
-    
-    return oss.str();
-}
-
-long long NavigationDatabase::GetLastUpdateTime() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    return lastUpdateTime_;
-}
-
-std::string NavigationDatabase::CheckDatabaseConsistency() const {
-    std::shared_lock<std::shared_mutex> lock(dbMutex_);
-    
-    // Check for invalid waypoints
-    for (const auto& wp : waypoints_) {
-        if (!wp.second.IsValidCoordinate()) {
-            return "Invalid coordinates for waypoint: " + wp.first;
-        }
-    }
-    
-    // Check for missing waypoints in airways
-    for (const auto& airway : airways_) {
-        for (const auto& wpName : airway.second.waypointSequence) {
-            if (waypoints_.find(wpName) == waypoints_.end()) {
-                return "Missing waypoint in airway " + airway.first + ": " + wpName;
-            }
-        }
-    }
-    
-    return "";  // All OK
-}
-
-int NavigationDatabase::PreloadCommonData() {
-    int count = 0;
-    
-    // Preload major airports
-    std::vector<std::string> majorAirports = {
-        "KJFK", "KLAX", "KORD", "KDFW", "KATL"
-    };
-    
-    for (const auto& airport : majorAirports) {
-        GetWaypoint(airport);
-        GetSIDsByAirport(airport);
-        GetSTARsByAirport(airport);
-        GetApproachProceduresByAirport(airport);
-        count += 4;
-    }
-    
-    // Preload common airways
-    for (int i = 1; i <= 10; ++i) {
-        GetAirway("V" + std::to_string(i));
-        GetAirway("J" + std::to_string(500 + i));
-        count += 2;
-    }
-    
-    return count;
-}
-
-// ============================================================================
-// HELPER METHODS
-// ============================================================================
-
-double NavigationDatabase::GetMagneticVariation(double latitude, double longitude) const {
-    // Simplified WMM-like model
-    // For production, use full WMM/IGRF model
-    double variation = -5.0 + (longitude / 10.0);
-    return variation;
-}
-
-double NavigationDatabase::GreatCircleDistance(double lat1, double lon1,
-                                              double lat2, double lon2) const {
-    double lat1Rad = lat1 * PI / 180.0;
-    double lat2Rad = lat2 * PI / 180.0;
-    double dLatRad = (lat2 - lat1) * PI / 180.0;
-    double dLonRad = (lon2 - lon1) * PI / 180.0;
-    
-    double a = std::sin(dLatRad / 2.0) * std::sin(dLatRad / 2.0) +
-               std::cos(lat1Rad) * std::cos(lat2Rad) *
-               std::sin(dLonRad / 2.0) * std::sin(dLonRad / 2.0);
-    
-    double c = 2.0 * std::atan2(std::sqrt(a), std::sqrt(1.0 - a));
-    return EARTH_RADIUS_NM * c;
-}
-
-double NavigationDatabase::GreatCircleBearing(double lat1, double lon1,
-                                              double lat2, double lon2) const {
-    double lat1Rad = lat1 * PI / 180.0;
-    double lat2Rad = lat2 * PI / 180.0;
-    double dLonRad = (lon2 - lon1) * PI / 180.0;
-    
-    double y = std::sin(dLonRad) * std::cos(lat2Rad);
-    double x = std::cos(lat1Rad) * std::sin(lat2Rad) -
-               std::sin(lat1Rad) * std::cos(lat2Rad) * std::cos(dLonRad);
-    
-    double bearing = std::atan2(y, x) * 180.0 / PI;
-    bearing = std::fmod(bearing + 360.0, 360.0);
-    
-    return bearing;
-}
-
-std::vector<Waypoint> NavigationDatabase::DijkstraPathfinding(
-    const std::string& origin,
-    const std::string& destination,
-    int cruiseAltitude) const {
-    
-    std::vector<Waypoint> result;
-    // Placeholder for Dijkstra implementation
-    auto origin_wp = GetWaypoint(origin);
-    auto dest_wp = GetWaypoint(destination);
-    if (origin_wp) result.push_back(*origin_wp);
-    if (dest_wp) result.push_back(*dest_wp);
-    return result;
-}
-
-void NavigationDatabase::InvalidateCache() {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    queryCache_.clear();
-}
-
-std::optional<std::vector<std::string>> NavigationDatabase::GetFromCache(
-    const std::string& key) const {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    
-    auto it = queryCache_.find(key);
-    if (it != queryCache_.end()) {
-        auto now = std::chrono::system_clock::now().time_since_epoch().count();
-        if (now - it->second.timestamp < CACHE_TIMEOUT_MS) {
-            return it->second.data;
-        }
-    }
-    
-    return std::nullopt;
-}
-
-void NavigationDatabase::StoreInCache(const std::string& key,
-                                     const std::vector<std::string>& value) const {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    
-    CacheEntry entry;
-    entry.data = value;
-    entry.timestamp = std::chrono::system_clock::now().time_since_epoch().count();
-    queryCache_[key] = entry;
-}
-
-} // namespace AICopilot
@@ -0,0 +1,448 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Flight Plan Cache Implementation
+* Single-pass PLN/FMS parsing over a mapped file, cached by content hash
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/flight_plan_cache.hpp"
+#include "../include/leg_table.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AICopilot {
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+constexpr double MAX_PLAN_ALTITUDE = 60000.0;
+constexpr double MIN_PLAN_ALTITUDE = -1000.0;
+constexpr size_t FMS_HEADER_LINES = 2;
+
+// Read-only view of a whole file, memory-mapped for the lifetime of the object
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            return false;
+        }
+        size_ = static_cast<size_t>(size.QuadPart);
+        if (size_ == 0) {
+            CloseHandle(file);
+            return true;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);  // the mapping keeps the file referenced
+        if (mapping == nullptr) {
+            size_ = 0;
+            return false;
+        }
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);  // the view keeps the mapping alive
+        if (view == nullptr) {
+            size_ = 0;
+            return false;
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ == 0) {
+            ::close(fd);
+            return true;
+        }
+        void* view = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);  // the mapping keeps the file referenced
+        if (view == MAP_FAILED) {
+            size_ = 0;
+            return false;
+        }
+        madvise(view, size_, MADV_SEQUENTIAL);
+#endif
+        data_ = static_cast<const char*>(view);
+        return true;
+    }
+
+    std::string_view text() const { return data_ ? std::string_view(data_, size_) : std::string_view(); }
+
+private:
+    void close() {
+        if (data_ != nullptr) {
+#ifdef _WIN32
+            UnmapViewOfFile(data_);
+#else
+            munmap(const_cast<char*>(data_), size_);
+#endif
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && isBlank(text.front())) text.remove_prefix(1);
+    while (!text.empty() && isBlank(text.back())) text.remove_suffix(1);
+    return text;
+}
+
+// Leading number of text; consumed is how many characters it took
+bool parseLeadingNumber(std::string_view text, double& value, size_t& consumed) {
+    char buffer[64];
+    size_t length = std::min(text.size(), sizeof(buffer) - 1);
+    std::memcpy(buffer, text.data(), length);
+    buffer[length] = '\0';
+    char* end = nullptr;
+    value = std::strtod(buffer, &end);
+    consumed = static_cast<size_t>(end - buffer);
+    return consumed > 0;
+}
+
+// The whole token must be the number
+bool parseNumber(std::string_view token, double& value) {
+    size_t consumed = 0;
+    return parseLeadingNumber(token, value, consumed) && consumed == token.size();
+}
+
+// "47.4489" or "N47° 26' 56.00\"": degrees, then optional minutes and
+// seconds separated by anything that is not a digit
+bool parseAngle(std::string_view text, double& degrees) {
+    text = trim(text);
+    if (text.empty()) return false;
+
+    double sign = 1.0;
+    char hemisphere = static_cast<char>(std::toupper(static_cast<unsigned char>(text.front())));
+    bool sexagesimal = hemisphere == 'N' || hemisphere == 'S' || hemisphere == 'E' || hemisphere == 'W';
+    if (!sexagesimal) return parseNumber(text, degrees);
+    if (hemisphere == 'S' || hemisphere == 'W') sign = -1.0;
+    text.remove_prefix(1);
+
+    double parts[3] = {0.0, 0.0, 0.0};
+    for (size_t part = 0; part < 3 && !text.empty(); part++) {
+        size_t consumed = 0;
+        if (!parseLeadingNumber(text, parts[part], consumed)) return false;
+        text.remove_prefix(consumed);
+        while (!text.empty() && !std::isdigit(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+    }
+    degrees = sign * (parts[0] + parts[1] / 60.0 + parts[2] / 3600.0);
+    return true;
+}
+
+// "lat,lon,+altitude"
+bool parseLLA(std::string_view text, Position& position) {
+    size_t first = text.find(',');
+    if (first == std::string_view::npos) return false;
+    size_t second = text.find(',', first + 1);
+    if (second == std::string_view::npos) return false;
+
+    double lat = 0.0;
+    double lon = 0.0;
+    double alt = 0.0;
+    std::string_view altitude = text.substr(second + 1);
+    size_t digits = altitude.find_first_of("+-0123456789");
+    size_t consumed = 0;
+    if (!parseAngle(text.substr(0, first), lat) ||
+        !parseAngle(text.substr(first + 1, second - first - 1), lon) ||
+        digits == std::string_view::npos ||
+        !parseLeadingNumber(altitude.substr(digits), alt, consumed)) {
+        return false;
+    }
+    if (lat < -90.0 || lat > 90.0 || lon < -180.0 || lon > 180.0) return false;
+
+    position.latitude = lat;
+    position.longitude = lon;
+    position.altitude = alt;
+    position.heading = 0.0;
+    return true;
+}
+
+Waypoint airportWaypoint(const std::string& id, const Position& position) {
+    Waypoint wp;
+    wp.id = id;
+    wp.position = position;
+    wp.altitude = position.altitude;
+    wp.type = "AIRPORT";
+    return wp;
+}
+
+bool parsePLN(std::string_view text, FlightPlan& plan) {
+    // Elements are read as they pass; the plan is assembled at the end, so
+    // the order of Title, the IDs and the LLAs in the file does not matter
+    std::string titleDeparture;
+    std::string titleArrival;
+    std::string departureId;
+    std::string arrivalId;
+    Position departure;
+    Position arrival;
+    bool haveDeparture = false;
+    bool haveArrival = false;
+    double cruiseAltitude = 0.0;
+
+    size_t pos = 0;
+    while ((pos = text.find('<', pos)) != std::string_view::npos) {
+        pos++;
+        if (pos >= text.size() || text[pos] == '/' || text[pos] == '?' || text[pos] == '!') continue;
+
+        size_t nameEnd = pos;
+        while (nameEnd < text.size() && text[nameEnd] != '>' && !isBlank(text[nameEnd])) nameEnd++;
+        size_t tagEnd = text.find('>', nameEnd);
+        if (tagEnd == std::string_view::npos) break;
+        std::string_view name = text.substr(pos, nameEnd - pos);
+        size_t contentEnd = text.find('<', tagEnd + 1);
+        if (contentEnd == std::string_view::npos) break;
+        std::string_view content = trim(text.substr(tagEnd + 1, contentEnd - tagEnd - 1));
+        pos = contentEnd;
+
+        if (name == "DepartureLLA") {
+            haveDeparture = parseLLA(content, departure) || haveDeparture;
+        } else if (name == "DestinationLLA") {
+            haveArrival = parseLLA(content, arrival) || haveArrival;
+        } else if (name == "DepartureID") {
+            departureId = std::string(content);
+        } else if (name == "DestinationID") {
+            arrivalId = std::string(content);
+        } else if (name == "CruiseAltitude" || name == "CruisingAlt") {
+            double altitude = 0.0;
+            if (parseNumber(content, altitude) && altitude >= 0.0 && altitude <= MAX_PLAN_ALTITUDE) {
+                cruiseAltitude = altitude;
+            }
+        } else if (name == "Title") {
+            // Format: "ICAO to ICAO"
+            size_t toPos = content.find(" to ");
+            if (toPos != std::string_view::npos) {
+                titleDeparture = std::string(content.substr(0, toPos));
+                titleArrival = std::string(content.substr(toPos + 4));
+            }
+        }
+    }
+
+    FlightPlan parsed{};
+    parsed.departure = departureId.empty() ? titleDeparture : departureId;
+    parsed.arrival = arrivalId.empty() ? titleArrival : arrivalId;
+    parsed.cruiseAltitude = cruiseAltitude;
+
+    // An airport named but not placed is left at 0,0 for navdata to resolve
+    if (haveDeparture || !departureId.empty()) {
+        parsed.waypoints.push_back(airportWaypoint(parsed.departure.empty() ? "DEPARTURE" : parsed.departure,
+                                                   haveDeparture ? departure : Position{}));
+    }
+    if (haveArrival || !arrivalId.empty()) {
+        parsed.waypoints.push_back(airportWaypoint(parsed.arrival.empty() ? "ARRIVAL" : parsed.arrival,
+                                                   haveArrival ? arrival : Position{}));
+    }
+    if (parsed.waypoints.empty()) return false;
+
+    plan = std::move(parsed);
+    return true;
+}
+
+bool parseFMS(std::string_view text, FlightPlan& plan) {
+    FlightPlan parsed{};
+    size_t lineNum = 0;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view line = text.substr(pos, end - pos);
+        pos = end + 1;
+
+        if (++lineNum <= FMS_HEADER_LINES) continue;
+        if (line.empty() || line[0] == '#' || line[0] == ';') continue;
+
+        // "type id lat lon alt"; anything after the fifth token is ignored
+        std::string_view tokens[5];
+        size_t count = 0;
+        size_t at = 0;
+        while (count < 5) {
+            while (at < line.size() && isBlank(line[at])) at++;
+            if (at >= line.size()) break;
+            size_t tokenEnd = at;
+            while (tokenEnd < line.size() && !isBlank(line[tokenEnd])) tokenEnd++;
+            tokens[count++] = line.substr(at, tokenEnd - at);
+            at = tokenEnd;
+        }
+
+        double lat = 0.0;
+        double lon = 0.0;
+        double alt = 0.0;
+        if (count < 5 || !parseNumber(tokens[2], lat) || !parseNumber(tokens[3], lon) ||
+            !parseNumber(tokens[4], alt)) {
+            continue;
+        }
+        if (lat < -90.0 || lat > 90.0 || lon < -180.0 || lon > 180.0) continue;
+        if (alt < MIN_PLAN_ALTITUDE || alt > MAX_PLAN_ALTITUDE) continue;
+
+        Waypoint wp;
+        wp.id = std::string(tokens[1]);
+        wp.type = std::string(tokens[0]);
+        wp.position.latitude = lat;
+        wp.position.longitude = lon;
+        wp.position.altitude = alt;
+        wp.position.heading = 0.0;
+        wp.altitude = alt;
+        parsed.waypoints.push_back(std::move(wp));
+    }
+
+    if (parsed.waypoints.size() < 2) return false;
+
+    parsed.departure = parsed.waypoints.front().id;
+    parsed.arrival = parsed.waypoints.back().id;
+
+    // Cruise altitude is the highest waypoint
+    for (const auto& wp : parsed.waypoints) {
+        parsed.cruiseAltitude = std::max(parsed.cruiseAltitude, wp.altitude);
+    }
+
+    // Heading for each waypoint is the initial course of its leg; the last
+    // keeps the one before it
+    LegTable legs;
+    legs.build(parsed.waypoints);
+    for (size_t i = 0; i + 1 < parsed.waypoints.size(); i++) {
+        parsed.waypoints[i].position.heading = legs.getLeg(i).initialCourse;
+    }
+    parsed.waypoints.back().position.heading = parsed.waypoints[parsed.waypoints.size() - 2].position.heading;
+
+    plan = std::move(parsed);
+    return true;
+}
+
+} // namespace
+
+FlightPlanFormat flightPlanFormatFor(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos) return FlightPlanFormat::UNKNOWN;
+    std::string ext = path.substr(dot + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (ext == "pln") return FlightPlanFormat::PLN;
+    if (ext == "fms") return FlightPlanFormat::FMS;
+    return FlightPlanFormat::UNKNOWN;
+}
+
+bool parseFlightPlan(std::string_view text, FlightPlanFormat format, FlightPlan& plan) {
+    switch (format) {
+        case FlightPlanFormat::PLN: return parsePLN(text, plan);
+        case FlightPlanFormat::FMS: return parseFMS(text, plan);
+        default: return false;
+    }
+}
+
+// ============================================================================
+// FlightPlanCache Implementation
+// ============================================================================
+
+FlightPlanCache::FlightPlanCache(size_t capacity)
+    : capacity_(std::max<size_t>(1, capacity)) {}
+
+std::shared_ptr<FlightPlanCache> FlightPlanCache::shared() {
+    static std::shared_ptr<FlightPlanCache> cache = std::make_shared<FlightPlanCache>();
+    return cache;
+}
+
+std::shared_ptr<const FlightPlan> FlightPlanCache::load(const std::string& path) {
+    FlightPlanFormat format = flightPlanFormatFor(path);
+    if (format == FlightPlanFormat::UNKNOWN) return nullptr;
+
+    MappedFile file;
+    if (!file.open(path)) return nullptr;
+    std::string_view text = file.text();
+
+    Key key{format, FNV_OFFSET, text.size()};
+    for (char c : text) {
+        key.hash = (key.hash ^ static_cast<uint8_t>(c)) * FNV_PRIME;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = plans_.find(key);
+        if (it != plans_.end()) {
+            stats_.hits++;
+            return it->second;
+        }
+    }
+
+    // Parse outside the lock; two pilots racing on a new plan both parse
+    // it and the first to finish is kept
+    std::shared_ptr<const FlightPlan> plan;
+    FlightPlan parsed;
+    if (parseFlightPlan(text, format, parsed)) {
+        plan = std::make_shared<const FlightPlan>(std::move(parsed));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.misses++;
+    auto inserted = plans_.emplace(key, plan);
+    if (!inserted.second) return inserted.first->second;
+
+    order_.push_back(key);
+    while (plans_.size() > capacity_) {
+        plans_.erase(order_.front());
+        order_.pop_front();
+        stats_.evictions++;
+    }
+    return plan;
+}
+
+size_t FlightPlanCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return plans_.size();
+}
+
+FlightPlanCache::Stats FlightPlanCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void FlightPlanCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    plans_.clear();
+    order_.clear();
+}
+
+} // namespace AICopilot
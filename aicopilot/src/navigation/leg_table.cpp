@@ -0,0 +1,132 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Leg Table Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/leg_table.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AICopilot {
+
+namespace {
+
+using Geodesy::UnitVector;
+
+UnitVector cross(const UnitVector& a, const UnitVector& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+double dot(const UnitVector& a, const UnitVector& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+UnitVector toVector(const Position& position) {
+    return Geodesy::toUnitVector(position.latitude, position.longitude);
+}
+
+double course(const Position& from, const Position& to) {
+    return Geodesy::initialBearing(from.latitude, from.longitude, to.latitude, to.longitude);
+}
+
+} // namespace
+
+void LegTable::build(const std::vector<Waypoint>& fixes) {
+    clear();
+    for (const auto& fix : fixes) {
+        positions_.push_back(fix.position);
+        fixes_.push_back(toVector(fix.position));
+    }
+    legs_.resize(fixes_.size() > 1 ? fixes_.size() - 1 : 0);
+    for (size_t i = 0; i < legs_.size(); ++i) {
+        computeLeg(i);
+    }
+    accumulateFrom(0);
+}
+
+void LegTable::insert(size_t index, const Position& position) {
+    if (index > fixes_.size()) return;
+    positions_.insert(positions_.begin() + index, position);
+    fixes_.insert(fixes_.begin() + index, toVector(position));
+    if (fixes_.size() < 2) return;
+
+    // One new leg; the ones either side of the new fix change
+    legs_.insert(legs_.begin() + std::min(index, legs_.size()), Leg{});
+    if (index > 0) computeLeg(index - 1);
+    if (index < legs_.size()) computeLeg(index);
+    accumulateFrom(index > 0 ? index - 1 : 0);
+}
+
+void LegTable::remove(size_t index) {
+    if (index >= fixes_.size()) return;
+    positions_.erase(positions_.begin() + index);
+    fixes_.erase(fixes_.begin() + index);
+    if (fixes_.size() < 2) {
+        legs_.clear();
+        return;
+    }
+
+    // The legs either side merge into one joining the neighbours
+    legs_.erase(legs_.begin() + std::min(index, legs_.size() - 1));
+    if (index > 0 && index - 1 < legs_.size()) computeLeg(index - 1);
+    accumulateFrom(index > 0 ? index - 1 : 0);
+}
+
+void LegTable::update(size_t index, const Position& position) {
+    if (index >= fixes_.size()) return;
+    positions_[index] = position;
+    fixes_[index] = toVector(position);
+    if (index > 0) computeLeg(index - 1);
+    if (index < legs_.size()) computeLeg(index);
+    accumulateFrom(index > 0 ? index - 1 : 0);
+}
+
+void LegTable::clear() {
+    positions_.clear();
+    fixes_.clear();
+    legs_.clear();
+}
+
+double LegTable::getDistanceFrom(size_t fix) const {
+    if (fix == 0) return getTotalDistance();
+    if (fix > legs_.size()) return 0.0;
+    return getTotalDistance() - legs_[fix - 1].cumulative;
+}
+
+double LegTable::crossTrackDistance(size_t leg, const Position& position) const {
+    if (leg >= legs_.size()) return 0.0;
+    const UnitVector& pole = legs_[leg].pole;
+    double side = std::clamp(dot(toVector(position), pole), -1.0, 1.0);
+    // The pole is on the left of the direction of travel
+    return -std::asin(side) * Geodesy::EARTH_RADIUS_NM;
+}
+
+void LegTable::computeLeg(size_t index) {
+    Leg& leg = legs_[index];
+    const UnitVector& a = fixes_[index];
+    const UnitVector& b = fixes_[index + 1];
+    UnitVector normal = cross(a, b);
+    double sine = std::sqrt(dot(normal, normal));
+
+    // atan2 keeps short and near-antipodal legs accurate
+    leg.length = std::atan2(sine, dot(a, b)) * Geodesy::EARTH_RADIUS_NM;
+    leg.pole = sine > 0.0 ? UnitVector{normal.x / sine, normal.y / sine, normal.z / sine} : UnitVector{};
+    leg.initialCourse = course(positions_[index], positions_[index + 1]);
+    leg.finalCourse = std::fmod(course(positions_[index + 1], positions_[index]) + 180.0, 360.0);
+}
+
+void LegTable::accumulateFrom(size_t index) {
+    double distance = index > 0 && index <= legs_.size() ? legs_[index - 1].cumulative : 0.0;
+    for (size_t i = index; i < legs_.size(); ++i) {
+        distance += legs_[i].length;
+        legs_[i].cumulative = distance;
+    }
+}
+
+} // namespace AICopilot
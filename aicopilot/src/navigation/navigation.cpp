@@ -8,250 +8,77 @@
 *****************************************************************************/
 
 #include "../include/navigation.h"
+#include "../include/geodesy.hpp"
+#include "../include/navdata_provider.h"
 #include <cmath>
-#include <fstream>
-#include <sstream>
 #include <algorithm>
 
 namespace AICopilot {
 
-constexpr double PI = 3.14159265358979323846;
-constexpr double EARTH_RADIUS_NM = 3440.065;  // Nautical miles
-
 bool Navigation::loadFlightPlan(const std::string& filePath) {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
+    std::shared_ptr<FlightPlanCache> cache = planCache_ ? planCache_ : FlightPlanCache::shared();
+    std::shared_ptr<const FlightPlan> plan = cache->load(filePath);
+    if (!plan) {
         return false;
     }
     
-    // Detect file format by extension
-    std::string ext = filePath.substr(filePath.find_last_of(".") + 1);
-    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-    
-    if (ext == "pln") {
-        return parsePLN(file);
-    } else if (ext == "fms") {
-        return parseFMS(file);
-    }
-    
-    activeWaypointIndex_ = 0;
-    return false;
-}
-
-bool Navigation::parsePLN(std::ifstream& file) {
-    // Parse MSFS/P3D PLN format (XML-based)
-    std::string line;
-    FlightPlan plan;
-    Waypoint currentWaypoint;
-    bool inATCWaypoint = false;
-    
-    try {
-        while (std::getline(file, line)) {
-            // Simple XML parsing for key elements
-            if (line.find("<DepartureLLA>") != std::string::npos) {
-                // Parse departure coordinates
-                size_t start = line.find(">") + 1;
-                size_t end = line.find("<", start);
-                if (start == std::string::npos || end == std::string::npos) {
-                    continue; // Skip malformed line
-                }
-                
-                std::string coords = line.substr(start, end - start);
-                // Format: "lat,lon,+altitude"
-                std::istringstream iss(coords);
-                std::string token;
-                
-                if (!std::getline(iss, token, ',')) continue;
-                double lat = std::stod(token);
-                
-                if (!std::getline(iss, token, ',')) continue;
-                double lon = std::stod(token);
-                
-                if (!std::getline(iss, token)) continue;
-                // Skip +/- sign if present
-                double alt = std::stod(token.substr(token.find_first_of("+-0123456789")));
-                
-                // Validate coordinates
-                if (lat < -90.0 || lat > 90.0 || lon < -180.0 || lon > 180.0) {
-                    continue; // Skip invalid coordinates
-                }
-                
-                Waypoint wp;
-                wp.id = plan.departure.empty() ? "DEPARTURE" : plan.departure;
-                wp.position.latitude = lat;
-                wp.position.longitude = lon;
-                wp.position.altitude = alt;
-                wp.altitude = alt;
-                wp.position.heading = 0.0;
-                wp.type = "AIRPORT";
-                plan.waypoints.push_back(wp);
-            }
-            else if (line.find("<DestinationLLA>") != std::string::npos) {
-                size_t start = line.find(">") + 1;
-                size_t end = line.find("<", start);
-                if (start == std::string::npos || end == std::string::npos) {
-                    continue;
-                }
-                
-                std::string coords = line.substr(start, end - start);
-                std::istringstream iss(coords);
-                std::string token;
-                
-                if (!std::getline(iss, token, ',')) continue;
-                double lat = std::stod(token);
-                
-                if (!std::getline(iss, token, ',')) continue;
-                double lon = std::stod(token);
-                
-                if (!std::getline(iss, token)) continue;
-                double alt = std::stod(token.substr(token.find_first_of("+-0123456789")));
-                
-                // Validate coordinates
-                if (lat < -90.0 || lat > 90.0 || lon < -180.0 || lon > 180.0) {
-                    continue;
-                }
-                
-                Waypoint wp;
-                wp.id = plan.arrival.empty() ? "ARRIVAL" : plan.arrival;
-                wp.position.latitude = lat;
-                wp.position.longitude = lon;
-                wp.position.altitude = alt;
-                wp.altitude = alt;
-                wp.position.heading = 0.0;
-                wp.type = "AIRPORT";
-                plan.waypoints.push_back(wp);
-            }
-            else if (line.find("<CruiseAltitude>") != std::string::npos) {
-                size_t start = line.find(">") + 1;
-                size_t end = line.find("<", start);
-                if (start != std::string::npos && end != std::string::npos) {
-                    try {
-                        double altitude = std::stod(line.substr(start, end - start));
-                        if (altitude >= 0.0 && altitude <= 60000.0) {
-                            plan.cruiseAltitude = altitude;
-                        }
-                    } catch (...) {
-                        // Ignore invalid altitude
-                    }
-                }
-            }
-            else if (line.find("<Title>") != std::string::npos) {
-                size_t start = line.find(">") + 1;
-                size_t end = line.find("<", start);
-                if (start != std::string::npos && end != std::string::npos) {
-                    std::string title = line.substr(start, end - start);
-                    // Parse title for departure/arrival (format: "ICAO to ICAO")
-                    size_t toPos = title.find(" to ");
-                    if (toPos != std::string::npos) {
-                        plan.departure = title.substr(0, toPos);
-                        plan.arrival = title.substr(toPos + 4);
-                    }
-                }
-            }
-        }
-    } catch (const std::exception&) {
-        // Return false if parsing fails
-        return false;
-    }
-    
-    // Only accept the plan if it has at least one waypoint
-    if (plan.waypoints.empty()) {
-        return false;
-    }
-    
-    flightPlan_ = plan;
+    flightPlan_ = *plan;
+    legs_.build(flightPlan_.waypoints);
     activeWaypointIndex_ = 0;
     return true;
 }
 
-bool Navigation::parseFMS(std::ifstream& file) {
-    // Parse FMS format (text-based)
-    std::string line;
-    FlightPlan plan;
-    int lineNum = 0;
-    
-    try {
-        while (std::getline(file, line)) {
-            lineNum++;
-            
-            // Skip header lines (typically first 2-3 lines)
-            if (lineNum <= 2) continue;
-            
-            // Skip empty lines and comments
-            if (line.empty() || line[0] == '#' || line[0] == ';') {
-                continue;
-            }
-            
-            // Parse waypoint line
-            std::istringstream iss(line);
-            std::string waypointType, id;
-            double lat, lon, alt;
-            
-            if (iss >> waypointType >> id >> lat >> lon >> alt) {
-                // Validate coordinates
-                if (lat < -90.0 || lat > 90.0 || lon < -180.0 || lon > 180.0) {
-                    continue; // Skip invalid coordinates
-                }
-                
-                // Validate altitude
-                if (alt < -1000.0 || alt > 60000.0) {
-                    continue; // Skip invalid altitude
-                }
-                
-                Waypoint wp;
-                wp.id = id;
-                wp.position.latitude = lat;
-                wp.position.longitude = lon;
-                wp.position.altitude = alt;
-                wp.altitude = alt;
-                wp.position.heading = 0.0;
-                wp.type = waypointType;
-                plan.waypoints.push_back(wp);
-                
-                // Set departure from first waypoint
-                if (lineNum == 3 && !plan.waypoints.empty()) {
-                    plan.departure = plan.waypoints[0].id;
-                }
-            }
+size_t Navigation::resolveWaypoints(const INavdataProvider& navdata) {
+    std::vector<size_t> airportIndex;
+    std::vector<std::string> airportCodes;
+    std::vector<size_t> navaidIndex;
+    std::vector<std::string> navaidIds;
+    for (size_t i = 0; i < flightPlan_.waypoints.size(); i++) {
+        const Waypoint& waypoint = flightPlan_.waypoints[i];
+        if (waypoint.position.latitude != 0.0 || waypoint.position.longitude != 0.0 || waypoint.id.empty()) {
+            continue;
+        }
+        if (waypoint.type == "AIRPORT") {
+            airportIndex.push_back(i);
+            airportCodes.push_back(waypoint.id);
+        } else {
+            navaidIndex.push_back(i);
+            navaidIds.push_back(waypoint.id);
         }
-    } catch (const std::exception&) {
-        // Return false if parsing fails
-        return false;
-    }
-    
-    // Validate we have at least 2 waypoints
-    if (plan.waypoints.size() < 2) {
-        return false;
     }
     
-    // Set arrival from last waypoint
-    plan.arrival = plan.waypoints.back().id;
-    
-    // Estimate cruise altitude from waypoints (use maximum altitude)
-    plan.cruiseAltitude = 0;
-    for (const auto& wp : plan.waypoints) {
-        if (wp.altitude > plan.cruiseAltitude) {
-            plan.cruiseAltitude = wp.altitude;
+    size_t resolved = 0;
+    if (!airportCodes.empty()) {
+        std::vector<AirportInfo> airports;
+        navdata.getAirportsByICAO(airportCodes, airports);
+        for (size_t k = 0; k < airportIndex.size() && k < airports.size(); k++) {
+            if (airports[k].icao.empty()) continue;
+            Waypoint& waypoint = flightPlan_.waypoints[airportIndex[k]];
+            waypoint.position.latitude = airports[k].position.latitude;
+            waypoint.position.longitude = airports[k].position.longitude;
+            waypoint.position.altitude = airports[k].elevation;
+            waypoint.altitude = airports[k].elevation;
+            resolved++;
         }
     }
-    
-    // Calculate headings for each waypoint based on next waypoint
-    for (size_t i = 0; i < plan.waypoints.size() - 1; i++) {
-        plan.waypoints[i].position.heading = greatCircleBearing(
-            plan.waypoints[i].position,
-            plan.waypoints[i + 1].position
-        );
+    if (!navaidIds.empty()) {
+        std::vector<NavaidInfo> navaids;
+        navdata.getNavaidsByID(navaidIds, navaids);
+        for (size_t k = 0; k < navaidIndex.size() && k < navaids.size(); k++) {
+            if (navaids[k].id.empty()) continue;
+            // The planned altitude stays; only the fix moves
+            Waypoint& waypoint = flightPlan_.waypoints[navaidIndex[k]];
+            waypoint.position.latitude = navaids[k].position.latitude;
+            waypoint.position.longitude = navaids[k].position.longitude;
+            waypoint.position.altitude = waypoint.altitude;
+            resolved++;
+        }
     }
     
-    // Last waypoint heading is same as second-to-last
-    if (plan.waypoints.size() > 1) {
-        plan.waypoints.back().position.heading = 
-            plan.waypoints[plan.waypoints.size() - 2].position.heading;
+    if (resolved > 0) {
+        legs_.build(flightPlan_.waypoints);
     }
-    
-    flightPlan_ = plan;
-    activeWaypointIndex_ = 0;
-    return true;
+    return resolved;
 }
 
 FlightPlan Navigation::createDirectPlan(const std::string& departure, 
@@ -353,11 +180,18 @@ FlightPlan Navigation::createDirectPlan(const std::string& departure,
     }
     
     flightPlan_ = plan;
+    legs_.build(flightPlan_.waypoints);
     activeWaypointIndex_ = 0;
     
     return plan;
 }
 
+void Navigation::restoreFlightPlan(const FlightPlan& plan, size_t activeWaypointIndex) {
+    flightPlan_ = plan;
+    legs_.build(flightPlan_.waypoints);
+    activeWaypointIndex_ = std::min(activeWaypointIndex, flightPlan_.waypoints.size());
+}
+
 Waypoint Navigation::getActiveWaypoint() const {
     if (activeWaypointIndex_ < flightPlan_.waypoints.size()) {
         return flightPlan_.waypoints[activeWaypointIndex_];
@@ -422,28 +256,8 @@ double Navigation::crossTrackError(const Position& current) const {
         return 0.0;
     }
     
-    // Calculate cross-track error from previous to current waypoint
-    Waypoint prev = flightPlan_.waypoints[activeWaypointIndex_ - 1];
-    Waypoint next = getActiveWaypoint();
-    
-    // Calculate distances and bearings
-    double d13 = greatCircleDistance(prev.position, current);
-    
-    // If we're very close to the previous waypoint, XTE is essentially zero
-    if (d13 < 0.01) {
-        return 0.0;
-    }
-    
-    double brg13 = greatCircleBearing(prev.position, current);
-    double brg12 = greatCircleBearing(prev.position, next.position);
-    
-    // Calculate angular difference
-    double angularDiff = brg13 - brg12;
-    
-    // Calculate cross-track distance
-    double xte = asin(sin(d13 / EARTH_RADIUS_NM) * sin(angularDiff * PI / 180.0)) * EARTH_RADIUS_NM;
-    
-    return xte;
+    // Cross-track error from the leg previous -> active waypoint
+    return legs_.crossTrackDistance(activeWaypointIndex_ - 1, current);
 }
 
 bool Navigation::isWaypointReached(const Position& current, double tolerance) const {
@@ -475,57 +289,31 @@ double Navigation::timeToDestination(double groundSpeed) const {
         return 0.0;
     }
     
-    double totalDistance = 0.0;
-    
-    // Sum distances from active waypoint to destination
-    for (size_t i = activeWaypointIndex_; i < flightPlan_.waypoints.size() - 1; i++) {
-        totalDistance += greatCircleDistance(
-            flightPlan_.waypoints[i].position,
-            flightPlan_.waypoints[i + 1].position
-        );
-    }
+    // Distance from active waypoint to destination
+    double totalDistance = legs_.getDistanceFrom(activeWaypointIndex_);
     
     // Convert to minutes (distance in NM, speed in knots)
     return (totalDistance / groundSpeed) * 60.0;
 }
 
 double Navigation::greatCircleDistance(const Position& p1, const Position& p2) const {
-    double lat1 = p1.latitude * PI / 180.0;
-    double lat2 = p2.latitude * PI / 180.0;
-    double dLat = (p2.latitude - p1.latitude) * PI / 180.0;
-    double dLon = (p2.longitude - p1.longitude) * PI / 180.0;
-    
-    double a = sin(dLat / 2.0) * sin(dLat / 2.0) +
-               cos(lat1) * cos(lat2) *
-               sin(dLon / 2.0) * sin(dLon / 2.0);
-    
-    double c = 2.0 * atan2(sqrt(a), sqrt(1.0 - a));
-    
-    return EARTH_RADIUS_NM * c;
+    return Geodesy::haversineNM(p1.latitude, p1.longitude, p2.latitude, p2.longitude);
 }
 
 double Navigation::greatCircleBearing(const Position& p1, const Position& p2) const {
-    double lat1 = p1.latitude * PI / 180.0;
-    double lat2 = p2.latitude * PI / 180.0;
-    double dLon = (p2.longitude - p1.longitude) * PI / 180.0;
-    
-    double y = sin(dLon) * cos(lat2);
-    double x = cos(lat1) * sin(lat2) - sin(lat1) * cos(lat2) * cos(dLon);
-    
-    double bearing = atan2(y, x) * 180.0 / PI;
-    
-    // Normalize to 0-360
-    return fmod(bearing + 360.0, 360.0);
+    return Geodesy::initialBearing(p1.latitude, p1.longitude, p2.latitude, p2.longitude);
 }
 
 bool Navigation::updateWaypointPosition(const std::string& waypointId, const Position& position) {
     bool updated = false;
     
     // Search through all waypoints and update matching ones
-    for (auto& waypoint : flightPlan_.waypoints) {
+    for (size_t i = 0; i < flightPlan_.waypoints.size(); i++) {
+        Waypoint& waypoint = flightPlan_.waypoints[i];
         if (waypoint.id == waypointId) {
             waypoint.position = position;
             waypoint.altitude = position.altitude;
+            legs_.update(i, position);
             updated = true;
         }
     }
@@ -565,11 +353,13 @@ bool Navigation::validateFlightPlan() const {
 
 void Navigation::addWaypoint(const Waypoint& waypoint) {
     flightPlan_.waypoints.push_back(waypoint);
+    legs_.insert(legs_.getFixCount(), waypoint.position);
 }
 
 void Navigation::insertWaypoint(size_t index, const Waypoint& waypoint) {
     if (index <= flightPlan_.waypoints.size()) {
         flightPlan_.waypoints.insert(flightPlan_.waypoints.begin() + index, waypoint);
+        legs_.insert(index, waypoint.position);
         
         // Adjust active waypoint index if necessary
         if (index <= activeWaypointIndex_) {
@@ -581,6 +371,7 @@ void Navigation::insertWaypoint(size_t index, const Waypoint& waypoint) {
 void Navigation::removeWaypoint(size_t index) {
     if (index < flightPlan_.waypoints.size()) {
         flightPlan_.waypoints.erase(flightPlan_.waypoints.begin() + index);
+        legs_.remove(index);
         
         // Adjust active waypoint index if necessary
         if (index < activeWaypointIndex_ && activeWaypointIndex_ > 0) {
@@ -595,20 +386,7 @@ void Navigation::removeWaypoint(size_t index) {
 }
 
 double Navigation::getTotalDistance() const {
-    if (flightPlan_.waypoints.size() < 2) {
-        return 0.0;
-    }
-    
-    double totalDistance = 0.0;
-    
-    for (size_t i = 0; i < flightPlan_.waypoints.size() - 1; i++) {
-        totalDistance += greatCircleDistance(
-            flightPlan_.waypoints[i].position,
-            flightPlan_.waypoints[i + 1].position
-        );
-    }
-    
-    return totalDistance;
+    return legs_.getTotalDistance();
 }
 
 } // namespace AICopilot
@@ -8,26 +8,79 @@
 *****************************************************************************/
 
 #include "../include/config_parser.h"
-#include <fstream>
-#include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
 
 namespace AICopilot {
 
-bool ConfigParser::parse(const std::string& filePath) {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        return false;
+namespace {
+
+std::string_view trimView(std::string_view str) {
+    size_t first = str.find_first_not_of(" \t\r\n");
+    if (first == std::string_view::npos) {
+        return {};
     }
+    size_t last = str.find_last_not_of(" \t\r\n");
+    return str.substr(first, last - first + 1);
+}
+
+bool entryLess(const ParsedConfig::Entry& a, const ParsedConfig::Entry& b) {
+    return a.section != b.section ? a.section < b.section : a.key < b.key;
+}
+
+// Null-terminated copy for strtol/strtod; false if it doesn't fit
+bool terminated(std::string_view value, char (&buffer)[64]) {
+    if (value.empty() || value.size() >= sizeof(buffer)) return false;
+    value.copy(buffer, value.size());
+    buffer[value.size()] = '\0';
+    return true;
+}
+
+struct CachedConfig {
+    uintmax_t size = 0;
+    std::filesystem::file_time_type modified;
+    std::shared_ptr<const ParsedConfig> config;
+};
+
+std::mutex& cacheMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::unordered_map<std::string, CachedConfig>& cache() {
+    static std::unordered_map<std::string, CachedConfig> entries;
+    return entries;
+}
+
+} // namespace
+
+// ============================================================================
+// ParsedConfig
+// ============================================================================
+
+std::shared_ptr<const ParsedConfig> ParsedConfig::fromText(std::string text) {
+    std::shared_ptr<ParsedConfig> config(new ParsedConfig());
+    config->text_ = std::move(text);
+    config->parse();
+    return config;
+}
+
+void ParsedConfig::parse() {
+    std::string_view rest(text_);
+    std::string_view currentSection;
+    bool inSection = false;
     
-    clear();
-    std::string currentSection = "";
-    std::string line;
-    
-    while (std::getline(file, line)) {
-        // Trim whitespace
-        line = trim(line);
+    while (!rest.empty()) {
+        size_t newline = rest.find('\n');
+        std::string_view line = trimView(rest.substr(0, newline));
+        rest.remove_prefix(newline == std::string_view::npos ? rest.size() : newline + 1);
         
         // Skip empty lines and comments
         if (line.empty() || line[0] == ';' || line[0] == '#') {
@@ -36,135 +89,211 @@ bool ConfigParser::parse(const std::string& filePath) {
         
         // Check for section header
         if (line[0] == '[' && line.back() == ']') {
-            currentSection = line.substr(1, line.length() - 2);
-            currentSection = trim(currentSection);
-            data_[currentSection] = std::map<std::string, std::string>();
+            currentSection = trimView(line.substr(1, line.size() - 2));
+            inSection = true;
+            sections_.push_back(currentSection);
             continue;
         }
         
         // Parse key-value pair
         size_t equalPos = line.find('=');
-        if (equalPos != std::string::npos) {
-            std::string key = trim(line.substr(0, equalPos));
-            std::string value = trim(line.substr(equalPos + 1));
-            
-            // Remove comments from value
-            size_t commentPos = value.find(';');
-            if (commentPos != std::string::npos) {
-                value = trim(value.substr(0, commentPos));
-            }
-            
-            // Remove quotes if present
-            if (value.length() >= 2 && value.front() == '"' && value.back() == '"') {
-                value = value.substr(1, value.length() - 2);
-            }
-            
-            if (!currentSection.empty() && !key.empty()) {
-                data_[currentSection][key] = value;
-            }
+        if (equalPos == std::string_view::npos) {
+            continue;
+        }
+        std::string_view key = trimView(line.substr(0, equalPos));
+        std::string_view value = trimView(line.substr(equalPos + 1));
+        
+        // Remove comments from value
+        size_t commentPos = value.find(';');
+        if (commentPos != std::string_view::npos) {
+            value = trimView(value.substr(0, commentPos));
+        }
+        
+        // Remove quotes if present
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+            value = value.substr(1, value.size() - 2);
+        }
+        
+        if (inSection && !currentSection.empty() && !key.empty()) {
+            entries_.push_back({currentSection, key, value});
         }
     }
     
-    return true;
+    // Later duplicates win: keep the last of each equal run
+    std::stable_sort(entries_.begin(), entries_.end(), entryLess);
+    auto out = entries_.begin();
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        auto next = it + 1;
+        if (next != entries_.end() && !entryLess(*it, *next)) continue;
+        *out++ = *it;
+    }
+    entries_.erase(out, entries_.end());
+    
+    sections_.erase(std::remove(sections_.begin(), sections_.end(), std::string_view()), sections_.end());
+    std::sort(sections_.begin(), sections_.end());
+    sections_.erase(std::unique(sections_.begin(), sections_.end()), sections_.end());
 }
 
-std::string ConfigParser::getValue(const std::string& section, const std::string& key, 
-                                  const std::string& defaultValue) const {
-    auto sectionIt = data_.find(section);
-    if (sectionIt != data_.end()) {
-        auto keyIt = sectionIt->second.find(key);
-        if (keyIt != sectionIt->second.end()) {
-            return keyIt->second;
+std::shared_ptr<const ParsedConfig> ParsedConfig::load(const std::string& filePath) {
+    std::error_code error;
+    uintmax_t size = std::filesystem::file_size(filePath, error);
+    if (error) return nullptr;
+    std::filesystem::file_time_type modified = std::filesystem::last_write_time(filePath, error);
+    if (error) return nullptr;
+    
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex());
+        auto it = cache().find(filePath);
+        if (it != cache().end() && it->second.size == size && it->second.modified == modified) {
+            return it->second.config;
+        }
+    }
+    
+    // Read and parse outside the lock so fleet loads run in parallel
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return nullptr;
+    }
+    std::string text(static_cast<size_t>(size), '\0');
+    file.read(&text[0], static_cast<std::streamsize>(size));
+    text.resize(static_cast<size_t>(file.gcount()));
+    std::shared_ptr<const ParsedConfig> config = fromText(std::move(text));
+    
+    std::lock_guard<std::mutex> lock(cacheMutex());
+    cache()[filePath] = CachedConfig{size, modified, config};
+    return config;
+}
+
+void ParsedConfig::clearCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex());
+    cache().clear();
+}
+
+size_t ParsedConfig::cacheSize() {
+    std::lock_guard<std::mutex> lock(cacheMutex());
+    return cache().size();
+}
+
+const std::string_view* ParsedConfig::find(std::string_view section, std::string_view key) const {
+    Entry probe{section, key, {}};
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), probe, entryLess);
+    if (it != entries_.end() && it->section == section && it->key == key) {
+        return &it->value;
+    }
+    return nullptr;
+}
+
+bool ParsedConfig::hasSection(std::string_view section) const {
+    return std::binary_search(sections_.begin(), sections_.end(), section);
+}
+
+std::pair<const ParsedConfig::Entry*, const ParsedConfig::Entry*>
+ParsedConfig::sectionEntries(std::string_view section) const {
+    auto bySection = [](const Entry& a, const Entry& b) { return a.section < b.section; };
+    auto range = std::equal_range(entries_.begin(), entries_.end(), Entry{section, {}, {}}, bySection);
+    const Entry* base = entries_.data();
+    return {base + (range.first - entries_.begin()), base + (range.second - entries_.begin())};
+}
+
+// ============================================================================
+// ConfigParser
+// ============================================================================
+
+bool ConfigParser::parse(const std::string& filePath) {
+    clear();
+    config_ = ParsedConfig::load(filePath);
+    return config_ != nullptr;
+}
+
+std::string_view ConfigParser::getView(std::string_view section, std::string_view key,
+                                       std::string_view defaultValue) const {
+    if (config_) {
+        if (const std::string_view* value = config_->find(section, key)) {
+            return *value;
         }
     }
     return defaultValue;
 }
 
+std::string ConfigParser::getValue(const std::string& section, const std::string& key, 
+                                  const std::string& defaultValue) const {
+    const std::string_view* value = config_ ? config_->find(section, key) : nullptr;
+    return value ? std::string(*value) : defaultValue;
+}
+
 int ConfigParser::getIntValue(const std::string& section, const std::string& key, 
                               int defaultValue) const {
-    std::string value = getValue(section, key);
-    if (value.empty()) {
+    char buffer[64];
+    if (!terminated(getView(section, key), buffer)) {
         return defaultValue;
     }
-    try {
-        return std::stoi(value);
-    } catch (...) {
+    char* end = nullptr;
+    errno = 0;
+    long value = std::strtol(buffer, &end, 10);
+    if (end == buffer || errno == ERANGE || value < INT_MIN || value > INT_MAX) {
         return defaultValue;
     }
+    return static_cast<int>(value);
 }
 
 double ConfigParser::getDoubleValue(const std::string& section, const std::string& key, 
                                    double defaultValue) const {
-    std::string value = getValue(section, key);
-    if (value.empty()) {
+    char buffer[64];
+    if (!terminated(getView(section, key), buffer)) {
         return defaultValue;
     }
-    try {
-        return std::stod(value);
-    } catch (...) {
+    char* end = nullptr;
+    errno = 0;
+    double value = std::strtod(buffer, &end);
+    if (end == buffer || errno == ERANGE) {
         return defaultValue;
     }
+    return value;
 }
 
 bool ConfigParser::getBoolValue(const std::string& section, const std::string& key, 
                                bool defaultValue) const {
-    std::string value = getValue(section, key);
+    std::string_view value = getView(section, key);
     if (value.empty()) {
         return defaultValue;
     }
-    std::string lowerValue = toLower(value);
-    return (lowerValue == "true" || lowerValue == "1" || lowerValue == "yes" || lowerValue == "on");
+    auto equals = [value](std::string_view word) {
+        return value.size() == word.size() &&
+               std::equal(value.begin(), value.end(), word.begin(),
+                          [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) == b; });
+    };
+    return equals("true") || equals("1") || equals("yes") || equals("on");
 }
 
 bool ConfigParser::hasSection(const std::string& section) const {
-    return data_.find(section) != data_.end();
+    return config_ && config_->hasSection(section);
 }
 
 bool ConfigParser::hasKey(const std::string& section, const std::string& key) const {
-    auto sectionIt = data_.find(section);
-    if (sectionIt != data_.end()) {
-        return sectionIt->second.find(key) != sectionIt->second.end();
-    }
-    return false;
+    return config_ && config_->find(section, key) != nullptr;
 }
 
 std::vector<std::string> ConfigParser::getSections() const {
     std::vector<std::string> sections;
-    for (const auto& pair : data_) {
-        sections.push_back(pair.first);
+    if (config_) {
+        sections.assign(config_->sections().begin(), config_->sections().end());
     }
     return sections;
 }
 
 std::vector<std::string> ConfigParser::getKeys(const std::string& section) const {
     std::vector<std::string> keys;
-    auto sectionIt = data_.find(section);
-    if (sectionIt != data_.end()) {
-        for (const auto& pair : sectionIt->second) {
-            keys.push_back(pair.first);
+    if (config_) {
+        auto range = config_->sectionEntries(section);
+        for (const ParsedConfig::Entry* entry = range.first; entry != range.second; ++entry) {
+            keys.emplace_back(entry->key);
         }
     }
     return keys;
 }
 
 void ConfigParser::clear() {
-    data_.clear();
-}
-
-std::string ConfigParser::trim(const std::string& str) const {
-    size_t first = str.find_first_not_of(" \t\r\n");
-    if (first == std::string::npos) {
-        return "";
-    }
-    size_t last = str.find_last_not_of(" \t\r\n");
-    return str.substr(first, last - first + 1);
-}
-
-std::string ConfigParser::toLower(const std::string& str) const {
-    std::string result = str;
-    std::transform(result.begin(), result.end(), result.begin(),
-                  [](unsigned char c) { return std::tolower(c); });
-    return result;
+    config_.reset();
 }
 
 } // namespace AICopilot
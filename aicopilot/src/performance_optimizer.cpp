@@ -16,11 +16,65 @@
 *****************************************************************************/
 
 #include "performance_optimizer.hpp"
+#include "geodesy.hpp"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 
 namespace AICopilot {
 
+// ============================================================
+// COARSE CLOCK
+// ============================================================
+
+namespace {
+
+class CoarseClockTicker {
+public:
+    CoarseClockTicker() : origin_(std::chrono::steady_clock::now()) {
+        thread_ = std::thread([this] {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!cv_.wait_for(lock, std::chrono::milliseconds(CoarseClock::RESOLUTION_MS),
+                                 [this] { return stop_; })) {
+                nowMs_.store(elapsedMs(), std::memory_order_relaxed);
+            }
+        });
+    }
+    
+    ~CoarseClockTicker() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+    
+    uint64_t nowMs() const { return nowMs_.load(std::memory_order_relaxed); }
+    
+private:
+    std::chrono::steady_clock::time_point origin_;
+    std::atomic<uint64_t> nowMs_{0};
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::thread thread_;
+    
+    uint64_t elapsedMs() const {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - origin_).count());
+    }
+};
+
+} // namespace
+
+uint64_t CoarseClock::nowMs() {
+    static CoarseClockTicker ticker;
+    return ticker.nowMs();
+}
+
 PerformanceOptimizer::PerformanceOptimizer()
     : initialized_(false),
       trackingEnabled_(true),
@@ -46,10 +100,19 @@ bool PerformanceOptimizer::initialize() {
 }
 
 void PerformanceOptimizer::shutdown() {
+    stopBatchWorker();
+    stopPrefetchWorker();
     if (initialized_) {
         clearAllCaches();
-        activeBatches_.clear();
-        prefetchRequests_.clear();
+        {
+            std::lock_guard<std::mutex> lock(batchMutex_);
+            activeBatches_.clear();
+        }
+        {
+            std::lock_guard<std::mutex> lock(prefetchMutex_);
+            prefetchRequests_.clear();
+            prefetchKeys_.clear();
+        }
         initialized_ = false;
     }
 }
@@ -59,15 +122,24 @@ void PerformanceOptimizer::shutdown() {
 // ============================================================
 
 void PerformanceOptimizer::cacheTerrainElevation(const Position& pos, double elevation) {
-    std::string key = std::to_string(pos.latitude) + "," + std::to_string(pos.longitude);
-    elevationCache_.put(key, elevation);
+    CellCorners flat;
+    flat.northWest = flat.northEast = flat.southWest = flat.southEast = elevation;
+    cacheTerrainCell(pos, flat);
+}
+
+void PerformanceOptimizer::cacheTerrainCell(const Position& pos, const CellCorners& corners) {
+    RasterCell cell = locateRasterCell(pos.latitude, pos.longitude, TERRAIN_CELLS_PER_DEGREE);
+    elevationCache_.put(cell.key(), corners);
 }
 
 bool PerformanceOptimizer::getTerrainElevation(const Position& pos, double& elevation) {
     queryCount_++;
     
-    std::string key = std::to_string(pos.latitude) + "," + std::to_string(pos.longitude);
-    if (elevationCache_.get(key, elevation)) {
+    // Nearby positions share a cell and hit the same entry
+    RasterCell cell = locateRasterCell(pos.latitude, pos.longitude, TERRAIN_CELLS_PER_DEGREE);
+    CellCorners corners;
+    if (elevationCache_.get(cell.key(), corners)) {
+        elevation = corners.interpolate(cell.rowFraction, cell.colFraction);
         cacheHits_++;
         return true;
     }
@@ -126,37 +198,58 @@ PerformanceMetrics PerformanceOptimizer::getCacheStatistics() const {
 // QUERY BATCHING
 // ============================================================
 
+void PerformanceOptimizer::setElevationBackend(ElevationBackend backend) {
+    elevationBackend_ = std::move(backend);
+}
+
+void PerformanceOptimizer::setWaypointBackend(WaypointBackend backend) {
+    waypointBackend_ = std::move(backend);
+}
+
 QueryBatch PerformanceOptimizer::createQueryBatch(
     const std::vector<Position>& positions,
     uint32_t timeoutMs,
     size_t maxBatchSize) {
     
     QueryBatch batch;
-    batch.batchId = nextBatchId_++;
     batch.positions = positions;
     batch.createdTime = std::chrono::steady_clock::now();
     batch.maxBatchSize = maxBatchSize;
     batch.timeoutMs = timeoutMs;
     batch.isReady = (positions.size() >= (maxBatchSize / 2));  // 50% of max
     
-    activeBatches_[batch.batchId] = batch;
+    {
+        std::lock_guard<std::mutex> lock(batchMutex_);
+        batch.batchId = nextBatchId_++;
+        activeBatches_[batch.batchId] = batch;
+    }
+    batchCv_.notify_one();
     
     return batch;
 }
 
 void PerformanceOptimizer::addQueryToBatch(uint32_t batchId, const Position& position) {
-    auto it = activeBatches_.find(batchId);
-    if (it != activeBatches_.end()) {
-        it->second.positions.push_back(position);
-        
-        // Check if batch is ready
-        if (it->second.positions.size() >= it->second.maxBatchSize) {
-            it->second.isReady = true;
+    bool ready = false;
+    {
+        std::lock_guard<std::mutex> lock(batchMutex_);
+        auto it = activeBatches_.find(batchId);
+        if (it != activeBatches_.end()) {
+            it->second.positions.push_back(position);
+            
+            // Check if batch is ready
+            if (it->second.positions.size() >= it->second.maxBatchSize) {
+                it->second.isReady = true;
+                ready = true;
+            }
         }
     }
+    if (ready) {
+        batchCv_.notify_one();
+    }
 }
 
 bool PerformanceOptimizer::isBatchReady(uint32_t batchId) const {
+    std::lock_guard<std::mutex> lock(batchMutex_);
     auto it = activeBatches_.find(batchId);
     if (it != activeBatches_.end()) {
         auto now = std::chrono::steady_clock::now();
@@ -170,25 +263,183 @@ bool PerformanceOptimizer::isBatchReady(uint32_t batchId) const {
 }
 
 std::vector<double> PerformanceOptimizer::processBatch(const QueryBatch& batch) {
-    std::vector<double> results;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    const size_t count = batch.positions.size();
+    std::vector<double> results(count, 0.0);
+    
+    std::vector<size_t> misses;
+    for (size_t i = 0; i < count; ++i) {
+        const Position& pos = batch.positions[i];
+        RasterCell cell = locateRasterCell(pos.latitude, pos.longitude, TERRAIN_CELLS_PER_DEGREE);
+        CellCorners corners;
+        if (elevationCache_.get(cell.key(), corners)) {
+            results[i] = corners.interpolate(cell.rowFraction, cell.colFraction);
+        } else {
+            misses.push_back(i);
+        }
+    }
+    
+    uint64_t singlePoints = 0;
+    uint64_t batchPoints = 0;
+    Milliseconds singleTime{0};
+    Milliseconds batchTime{0};
+    if (elevationBackend_ && !misses.empty()) {
+        // Group the misses by 1° tile so the backend walks each tile once
+        auto tileKey = [&batch](size_t i) {
+            const Position& pos = batch.positions[i];
+            return std::make_pair(std::floor(pos.latitude), std::floor(pos.longitude));
+        };
+        std::stable_sort(misses.begin(), misses.end(),
+                         [&tileKey](size_t a, size_t b) { return tileKey(a) < tileKey(b); });
+        
+        std::vector<LatLon> points(misses.size());
+        for (size_t k = 0; k < misses.size(); ++k) {
+            points[k].latitude = batch.positions[misses[k]].latitude;
+            points[k].longitude = batch.positions[misses[k]].longitude;
+        }
+        
+        // A few points go one at a time, pricing the unbatched query
+        std::vector<double> elevations(misses.size(), 0.0);
+        size_t timed = std::min(SPEEDUP_SAMPLE_POINTS, misses.size() - 1);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t k = 0; k < timed; ++k) {
+            elevationBackend_(&points[k], 1, &elevations[k]);
+        }
+        auto split = std::chrono::steady_clock::now();
+        elevationBackend_(points.data() + timed, points.size() - timed, elevations.data() + timed);
+        auto end = std::chrono::steady_clock::now();
+        
+        singlePoints = timed;
+        singleTime = split - start;
+        batchPoints = points.size() - timed;
+        batchTime = end - split;
+        
+        for (size_t k = 0; k < misses.size(); ++k) {
+            results[misses[k]] = elevations[k];
+            cacheTerrainElevation(batch.positions[misses[k]], elevations[k]);
+        }
+    }
     
-    for (const auto& pos : batch.positions) {
-        // Simulate batch processing (in production, would query terrain/nav systems)
-        double elevation = pos.altitude + 100.0;  // Simplified
-        results.push_back(elevation);
+    std::lock_guard<std::mutex> lock(batchMutex_);
+    batchesProcessed_++;
+    batchedQueries_ += count;
+    if (singlePoints > 0) {
+        singleTimedPoints_ += singlePoints;
+        singleTimedMs_ += singleTime.count();
+        batchTimedPoints_ += batchPoints;
+        batchTimedMs_ += batchTime.count();
     }
     
     return results;
 }
 
+std::vector<std::optional<Waypoint>> PerformanceOptimizer::processWaypointBatch(
+    const std::vector<std::string>& ids) {
+    
+    std::vector<std::optional<Waypoint>> results(ids.size());
+    std::vector<size_t> misses;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        Waypoint waypoint;
+        if (waypointCache_.get(ids[i], waypoint)) {
+            results[i] = std::move(waypoint);
+        } else {
+            misses.push_back(i);
+        }
+    }
+    if (!waypointBackend_) {
+        return results;
+    }
+    
+    // Repeated ids are looked up once
+    std::stable_sort(misses.begin(), misses.end(),
+                     [&ids](size_t a, size_t b) { return ids[a] < ids[b]; });
+    for (size_t k = 0; k < misses.size();) {
+        const std::string& id = ids[misses[k]];
+        std::optional<Waypoint> found = waypointBackend_(id);
+        if (found) {
+            cacheWaypoint(id, *found);
+        }
+        for (; k < misses.size() && ids[misses[k]] == id; ++k) {
+            results[misses[k]] = found;
+        }
+    }
+    return results;
+}
+
+void PerformanceOptimizer::startBatchWorker(BatchCallback callback) {
+    stopBatchWorker();
+    
+    std::lock_guard<std::mutex> lock(batchMutex_);
+    batchCallback_ = std::move(callback);
+    stopBatchWorker_ = false;
+    batchWorker_ = std::thread(&PerformanceOptimizer::batchWorkerLoop, this);
+}
+
+void PerformanceOptimizer::stopBatchWorker() {
+    {
+        std::lock_guard<std::mutex> lock(batchMutex_);
+        stopBatchWorker_ = true;
+    }
+    batchCv_.notify_all();
+    if (batchWorker_.joinable()) {
+        batchWorker_.join();
+    }
+}
+
+void PerformanceOptimizer::batchWorkerLoop() {
+    std::unique_lock<std::mutex> lock(batchMutex_);
+    while (!stopBatchWorker_) {
+        auto now = std::chrono::steady_clock::now();
+        auto wake = now + std::chrono::seconds(1);
+        
+        std::vector<QueryBatch> due;
+        for (auto it = activeBatches_.begin(); it != activeBatches_.end();) {
+            auto deadline = it->second.createdTime + std::chrono::milliseconds(it->second.timeoutMs);
+            if (it->second.isReady || deadline <= now) {
+                due.push_back(std::move(it->second));
+                it = activeBatches_.erase(it);
+            } else {
+                wake = std::min(wake, deadline);
+                ++it;
+            }
+        }
+        
+        if (due.empty()) {
+            batchCv_.wait_until(lock, wake);
+            continue;
+        }
+        
+        // Backends and the callback run without the lock so producers never wait on them
+        BatchCallback callback = batchCallback_;
+        lock.unlock();
+        for (const QueryBatch& batch : due) {
+            if (batch.positions.empty()) continue;
+            std::vector<double> results = processBatch(batch);
+            if (callback) {
+                callback(batch, results);
+            }
+        }
+        lock.lock();
+    }
+}
+
 PerformanceOptimizer::BatchStatistics PerformanceOptimizer::getBatchStatistics() const {
     BatchStatistics stats = {0};
     
+    std::lock_guard<std::mutex> lock(batchMutex_);
     stats.batchesCreated = nextBatchId_ - 1;
-    stats.queriesOptimized = stats.batchesCreated * 50;  // Estimated
-    stats.percentageOptimized = 35.0;  // 35% query optimization
-    stats.averageBatchSize = stats.queriesOptimized / std::max(1UL, stats.batchesCreated);
-    stats.averageSpeedupFactor = 2.5;  // 2.5x speedup from batching
+    stats.batchesProcessed = batchesProcessed_;
+    stats.queriesOptimized = batchedQueries_;
+    uint64_t totalQueries = batchedQueries_ + queryCount_;
+    stats.percentageOptimized = totalQueries > 0 ? 100.0 * batchedQueries_ / totalQueries : 0.0;
+    stats.averageBatchSize = batchesProcessed_ > 0
+        ? static_cast<double>(batchedQueries_) / batchesProcessed_ : 0.0;
+    
+    // Per-point cost of a one-point call over that of a batched call
+    if (singleTimedPoints_ > 0 && batchTimedPoints_ > 0 && batchTimedMs_ > 0.0) {
+        stats.averageSpeedupFactor = (singleTimedMs_ / singleTimedPoints_) /
+                                     (batchTimedMs_ / batchTimedPoints_);
+    }
     
     return stats;
 }
@@ -197,6 +448,198 @@ PerformanceOptimizer::BatchStatistics PerformanceOptimizer::getBatchStatistics()
 // PREFETCHING
 // ============================================================
 
+namespace {
+
+uint32_t strategyPriority(PrefetchStrategy strategy) {
+    switch (strategy) {
+        case PrefetchStrategy::REACTIVE: return 8;   // asked for by an active query
+        case PrefetchStrategy::HYBRID: return 6;
+        case PrefetchStrategy::PREDICTIVE: return 5;
+        case PrefetchStrategy::SPATIAL:
+        case PrefetchStrategy::TEMPORAL:
+        default: return 3;
+    }
+}
+
+// Distance from p to the nearest point of the 1° tile at (tileLat, tileLon)
+double distanceToTileNM(const Position& p, int tileLat, int tileLon) {
+    double lat = std::clamp(p.latitude, static_cast<double>(tileLat), tileLat + 1.0);
+    double lon = std::clamp(p.longitude, static_cast<double>(tileLon), tileLon + 1.0);
+    return Geodesy::haversineNM(p.latitude, p.longitude, lat, lon);
+}
+
+Position interpolate(const Position& from, const Position& to, double fraction) {
+    Position p = from;
+    p.latitude = from.latitude + (to.latitude - from.latitude) * fraction;
+    p.longitude = from.longitude + (to.longitude - from.longitude) * fraction;
+    return p;
+}
+
+} // namespace
+
+void PerformanceOptimizer::setTerrainPrefetcher(TilePrefetcher loader) {
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    terrainPrefetcher_ = std::move(loader);
+}
+
+void PerformanceOptimizer::setNavigationPrefetcher(RegionPrefetcher loader) {
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    navigationPrefetcher_ = std::move(loader);
+}
+
+void PerformanceOptimizer::setWeatherPrefetcher(RegionPrefetcher loader) {
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    weatherPrefetcher_ = std::move(loader);
+}
+
+bool PerformanceOptimizer::prefetchRunsAfter(const PrefetchRequest& a, const PrefetchRequest& b) {
+    if (a.priority != b.priority) {
+        return a.priority < b.priority;
+    }
+    return a.distanceNM > b.distanceNM;
+}
+
+std::string PerformanceOptimizer::prefetchKey(const PrefetchRequest& request) {
+    char key[64];
+    switch (request.target) {
+        case PrefetchTarget::TERRAIN_TILE:
+            std::snprintf(key, sizeof(key), "terrain %c%02d%c%03d",
+                          request.tileLatitude < 0 ? 'S' : 'N', std::abs(request.tileLatitude),
+                          request.tileLongitude < 0 ? 'W' : 'E', std::abs(request.tileLongitude));
+            break;
+        case PrefetchTarget::NAVIGATION_REGION:
+        case PrefetchTarget::WEATHER_REGION:
+            std::snprintf(key, sizeof(key), "%s %.2f,%.2f r%.0f",
+                          request.target == PrefetchTarget::WEATHER_REGION ? "weather" : "navdata",
+                          request.center.latitude, request.center.longitude, request.radius);
+            break;
+    }
+    return key;
+}
+
+bool PerformanceOptimizer::queuePrefetch(PrefetchRequest request) {
+    bool hasLoader = false;
+    switch (request.target) {
+        case PrefetchTarget::TERRAIN_TILE: hasLoader = static_cast<bool>(terrainPrefetcher_); break;
+        case PrefetchTarget::NAVIGATION_REGION: hasLoader = static_cast<bool>(navigationPrefetcher_); break;
+        case PrefetchTarget::WEATHER_REGION: hasLoader = static_cast<bool>(weatherPrefetcher_); break;
+    }
+    if (!hasLoader || prefetchRequests_.size() >= MAX_PENDING_PREFETCHES) {
+        return false;
+    }
+    if (!prefetchKeys_.insert(prefetchKey(request)).second) {
+        return false;   // already queued or loading
+    }
+
+    request.completed = false;
+    request.routeGeneration = routeGeneration_;
+    prefetchRequests_.push_back(std::move(request));
+    std::push_heap(prefetchRequests_.begin(), prefetchRequests_.end(), prefetchRunsAfter);
+    prefetchCv_.notify_one();
+    return true;
+}
+
+void PerformanceOptimizer::startPrefetchWorker() {
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    if (prefetchWorker_.joinable()) {
+        return;
+    }
+    stopPrefetchWorker_ = false;
+    prefetchWorker_ = std::thread(&PerformanceOptimizer::prefetchWorkerLoop, this);
+}
+
+void PerformanceOptimizer::stopPrefetchWorker() {
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex_);
+        if (!prefetchWorker_.joinable()) {
+            return;
+        }
+        stopPrefetchWorker_ = true;
+    }
+    prefetchCv_.notify_all();
+    prefetchWorker_.join();
+
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    prefetchRequests_.clear();
+    prefetchKeys_.clear();
+    prefetchIdleCv_.notify_all();
+}
+
+void PerformanceOptimizer::waitForPrefetches() {
+    std::unique_lock<std::mutex> lock(prefetchMutex_);
+    prefetchIdleCv_.wait(lock, [this] {
+        return !prefetchWorker_.joinable() || stopPrefetchWorker_ ||
+               (prefetchRequests_.empty() && !prefetchInFlight_);
+    });
+}
+
+void PerformanceOptimizer::prefetchWorkerLoop() {
+    std::unique_lock<std::mutex> lock(prefetchMutex_);
+    while (true) {
+        prefetchCv_.wait(lock, [this] { return stopPrefetchWorker_ || !prefetchRequests_.empty(); });
+        if (stopPrefetchWorker_) {
+            break;
+        }
+
+        std::pop_heap(prefetchRequests_.begin(), prefetchRequests_.end(), prefetchRunsAfter);
+        PrefetchRequest request = std::move(prefetchRequests_.back());
+        prefetchRequests_.pop_back();
+        prefetchInFlight_ = true;
+
+        // Loaders are only replaced under the lock; copy the one we need
+        TilePrefetcher tileLoader;
+        RegionPrefetcher regionLoader;
+        if (request.target == PrefetchTarget::TERRAIN_TILE) {
+            tileLoader = terrainPrefetcher_;
+        } else {
+            regionLoader = request.target == PrefetchTarget::WEATHER_REGION ?
+                weatherPrefetcher_ : navigationPrefetcher_;
+        }
+
+        lock.unlock();
+        bool loaded = false;
+        if (tileLoader) {
+            loaded = tileLoader(request.tileLatitude, request.tileLongitude);
+        } else if (regionLoader) {
+            loaded = regionLoader(request.center, request.radius);
+        }
+        lock.lock();
+
+        prefetchInFlight_ = false;
+        prefetchKeys_.erase(prefetchKey(request));
+        if (request.routeBound && request.routeGeneration != routeGeneration_) {
+            prefetchesCancelled_++;
+        } else if (loaded) {
+            prefetchesCompleted_++;
+        } else {
+            prefetchesFailed_++;
+        }
+        if (prefetchRequests_.empty()) {
+            prefetchIdleCv_.notify_all();
+        }
+    }
+    prefetchInFlight_ = false;
+}
+
+void PerformanceOptimizer::cancelRoutePrefetches() {
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    routeGeneration_++;
+    auto routeEnd = std::remove_if(prefetchRequests_.begin(), prefetchRequests_.end(),
+        [this](const PrefetchRequest& request) {
+            if (!request.routeBound) {
+                return false;
+            }
+            prefetchKeys_.erase(prefetchKey(request));
+            prefetchesCancelled_++;
+            return true;
+        });
+    prefetchRequests_.erase(routeEnd, prefetchRequests_.end());
+    std::make_heap(prefetchRequests_.begin(), prefetchRequests_.end(), prefetchRunsAfter);
+    if (prefetchRequests_.empty()) {
+        prefetchIdleCv_.notify_all();
+    }
+}
+
 void PerformanceOptimizer::prefetchTerrainGrid(
     const Position& centerPos,
     double radius,
@@ -206,20 +649,31 @@ void PerformanceOptimizer::prefetchTerrainGrid(
     request.center = centerPos;
     request.radius = radius;
     request.strategy = strategy;
-    request.priority = 5;
+    request.priority = strategyPriority(strategy);
     request.completed = false;
-    
-    prefetchRequests_.push_back(request);
-    
-    // Simulate prefetching (in production, would trigger async loading)
-    // Grid size = (radius * 2 / cell_size)^2
-    double cellSize = 10.0;  // NM per cell
-    size_t gridSize = static_cast<size_t>((radius * 2.0) / cellSize);
-    double estimatedItems = gridSize * gridSize * 10.0;  // ~10 items per cell
-    
-    // Simulate completion
-    request.completed = true;
-    prefetchRequests_.back().completed = true;
+    request.target = PrefetchTarget::TERRAIN_TILE;
+    
+    // One request per 1° tile touching the circle
+    double latSpan = radius / 60.0;
+    double lonSpan = radius / (60.0 * std::max(0.01, std::cos(centerPos.latitude * Geodesy::DEG_TO_RAD)));
+    int latMin = static_cast<int>(std::floor(centerPos.latitude - latSpan));
+    int latMax = static_cast<int>(std::floor(centerPos.latitude + latSpan));
+    int lonMin = static_cast<int>(std::floor(centerPos.longitude - lonSpan));
+    int lonMax = static_cast<int>(std::floor(centerPos.longitude + lonSpan));
+    
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    for (int lat = std::max(latMin, -90); lat <= std::min(latMax, 89); ++lat) {
+        for (int lon = lonMin; lon <= lonMax; ++lon) {
+            double distance = distanceToTileNM(centerPos, lat, lon);
+            if (distance > radius) {
+                continue;
+            }
+            request.tileLatitude = lat;
+            request.tileLongitude = lon;
+            request.distanceNM = distance;
+            queuePrefetch(request);
+        }
+    }
 }
 
 void PerformanceOptimizer::prefetchNavigationData(
@@ -231,46 +685,94 @@ void PerformanceOptimizer::prefetchNavigationData(
     request.center = centerPos;
     request.radius = radius;
     request.strategy = strategy;
-    request.priority = 3;
+    request.priority = strategyPriority(strategy);
     request.completed = false;
+    request.target = PrefetchTarget::NAVIGATION_REGION;
     
-    prefetchRequests_.push_back(request);
-    request.completed = true;
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    queuePrefetch(request);
 }
 
 void PerformanceOptimizer::prefetchAlongFlightPath(
     const std::vector<Waypoint>& flightPath,
     double lookAheadDistance) {
     
-    // Prefetch terrain/nav data along flight path
-    for (size_t i = 0; i < flightPath.size() - 1; ++i) {
-        // Calculate prefetch radius for segment
-        double latDiff = flightPath[i+1].position.latitude - flightPath[i].position.latitude;
-        double lonDiff = flightPath[i+1].position.longitude - flightPath[i].position.longitude;
-        double segmentDistance = std::sqrt(latDiff * latDiff + lonDiff * lonDiff) * 60.0;  // NM
-        
-        Position segmentCenter;
-        segmentCenter.latitude = (flightPath[i].position.latitude + flightPath[i+1].position.latitude) / 2.0;
-        segmentCenter.longitude = (flightPath[i].position.longitude + flightPath[i+1].position.longitude) / 2.0;
+    cancelRoutePrefetches();
+    if (flightPath.empty()) {
+        return;
+    }
+    
+    PrefetchRequest tile;
+    tile.radius = 0.0;
+    tile.strategy = PrefetchStrategy::PREDICTIVE;
+    tile.priority = strategyPriority(PrefetchStrategy::PREDICTIVE);
+    tile.completed = false;
+    tile.target = PrefetchTarget::TERRAIN_TILE;
+    tile.routeBound = true;
+    
+    PrefetchRequest region = tile;
+    
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    auto queueWaypoint = [&](const Position& position, double alongTrack) {
+        region.center = position;
+        region.distanceNM = alongTrack;
+        region.target = PrefetchTarget::NAVIGATION_REGION;
+        region.radius = NAVIGATION_REGION_NM;
+        queuePrefetch(region);
+        region.target = PrefetchTarget::WEATHER_REGION;
+        region.radius = WEATHER_REGION_NM;
+        queuePrefetch(region);
+    };
+    auto queueTile = [&](const Position& position, double alongTrack) {
+        tile.center = position;
+        tile.tileLatitude = static_cast<int>(std::floor(position.latitude));
+        tile.tileLongitude = static_cast<int>(std::floor(position.longitude));
+        tile.distanceNM = alongTrack;
+        queuePrefetch(tile);   // repeats within a tile are deduplicated
+    };
+    
+    double alongTrack = 0.0;
+    queueWaypoint(flightPath[0].position, 0.0);
+    for (size_t i = 0; i + 1 < flightPath.size() && alongTrack <= lookAheadDistance; ++i) {
+        const Position& from = flightPath[i].position;
+        const Position& to = flightPath[i + 1].position;
+        double legLength = Geodesy::haversineNM(from.latitude, from.longitude, to.latitude, to.longitude);
         
-        prefetchTerrainGrid(segmentCenter, lookAheadDistance, PrefetchStrategy::PREDICTIVE);
+        for (double s = 0.0; s < legLength && alongTrack + s <= lookAheadDistance;
+             s += ROUTE_SAMPLE_SPACING_NM) {
+            queueTile(interpolate(from, to, s / legLength), alongTrack + s);
+        }
+        alongTrack += legLength;
+        if (alongTrack <= lookAheadDistance) {
+            queueTile(to, alongTrack);
+            queueWaypoint(to, alongTrack);
+        }
+    }
+    if (flightPath.size() == 1) {
+        queueTile(flightPath[0].position, 0.0);
     }
 }
 
 PerformanceOptimizer::PrefetchStatus PerformanceOptimizer::getPrefetchStatus() const {
     PrefetchStatus status = {0};
     
-    uint32_t completed = 0;
-    for (const auto& req : prefetchRequests_) {
-        if (req.completed) {
-            completed++;
-        }
+    std::lock_guard<std::mutex> lock(prefetchMutex_);
+    std::vector<PrefetchRequest> queued = prefetchRequests_;
+    std::sort(queued.begin(), queued.end(), [](const PrefetchRequest& a, const PrefetchRequest& b) {
+        return prefetchRunsAfter(b, a);
+    });
+    status.pendingItems.reserve(queued.size());
+    for (const auto& req : queued) {
+        status.pendingItems.push_back(prefetchKey(req));
     }
     
-    status.activePrefetches = prefetchRequests_.size() - completed;
-    status.completedPrefetches = completed;
-    status.completionPercentage = (prefetchRequests_.size() > 0) ?
-        (static_cast<double>(completed) / prefetchRequests_.size()) * 100.0 : 0.0;
+    status.activePrefetches = static_cast<uint32_t>(queued.size()) + (prefetchInFlight_ ? 1 : 0);
+    status.completedPrefetches = prefetchesCompleted_;
+    status.failedPrefetches = prefetchesFailed_;
+    status.cancelledPrefetches = prefetchesCancelled_;
+    uint32_t total = status.activePrefetches + prefetchesCompleted_ + prefetchesFailed_;
+    status.completionPercentage = (total > 0) ?
+        (static_cast<double>(prefetchesCompleted_ + prefetchesFailed_) / total) * 100.0 : 0.0;
     
     return status;
 }
@@ -294,13 +796,8 @@ void PerformanceOptimizer::optimizeMemory() {
     // Clear expired cache entries
     clearAllCaches();
     
-    // Remove completed prefetch requests
-    prefetchRequests_.erase(
-        std::remove_if(prefetchRequests_.begin(), prefetchRequests_.end(),
-                      [](const PrefetchRequest& req) { return req.completed; }),
-        prefetchRequests_.end());
-    
     // Clean up completed batches
+    std::lock_guard<std::mutex> lock(batchMutex_);
     for (auto it = activeBatches_.begin(); it != activeBatches_.end();) {
         auto now = std::chrono::steady_clock::now();
         auto age = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -425,8 +922,25 @@ PerformanceOptimizer::PerformanceReport PerformanceOptimizer::getPerformanceRepo
 void PerformanceOptimizer::resetPerformanceCounters() {
     queryCount_ = 0;
     cacheHits_ = 0;
-    activeBatches_.clear();
-    prefetchRequests_.clear();
+    {
+        std::lock_guard<std::mutex> lock(batchMutex_);
+        activeBatches_.clear();
+        batchesProcessed_ = 0;
+        batchedQueries_ = 0;
+        singleTimedPoints_ = 0;
+        singleTimedMs_ = 0.0;
+        batchTimedPoints_ = 0;
+        batchTimedMs_ = 0.0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex_);
+        prefetchRequests_.clear();
+        prefetchKeys_.clear();
+        prefetchesCompleted_ = 0;
+        prefetchesFailed_ = 0;
+        prefetchesCancelled_ = 0;
+        prefetchIdleCv_.notify_all();
+    }
     clearAllCaches();
 }
 
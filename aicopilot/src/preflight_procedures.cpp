@@ -4,589 +4,475 @@
 *****************************************************************************/
 
 #include "../include/preflight_procedures.h"
+#include "../include/config_parser.h"
 #include <ctime>
 #include <sstream>
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
 
 namespace AICopilot {
 
-PreflightProcedures::PreflightProcedures() = default;
+// preflight_checklist_data.cpp, generated from data/checklists/preflight.cfg
+const char* builtinPreflightChecklist();
 
-bool PreflightProcedures::initialize(const AircraftConfig& config) {
-    aircraftConfig_ = config;
-    checklistItems_.clear();
-    currentItemIndex_ = 0;
-    currentPhase_ = PreflightPhase::NOT_STARTED;
-    
-    // Initialize checklist based on aircraft type
-    initializeGenericChecklist();
-    
-    if (config.numberOfEngines == 1) {
-        initializeSingleEngineChecklist();
-    } else if (config.numberOfEngines > 1) {
-        if (config.engineType.find("Turboprop") != std::string::npos) {
-            initializeTurbopropChecklist();
-        } else {
-            initializeMultiEngineChecklist();
+// ============================================================================
+// ChecklistProgram
+// ============================================================================
+
+namespace {
+
+struct FieldName {
+    std::string_view name;
+    ChecklistField field;
+};
+
+constexpr FieldName FIELD_NAMES[] = {
+    {"engine_rpm", ChecklistField::ENGINE_RPM},
+    {"fuel_quantity", ChecklistField::FUEL_QUANTITY},
+    {"on_ground", ChecklistField::ON_GROUND},
+    {"parking_brake", ChecklistField::PARKING_BRAKE},
+    {"gear_down", ChecklistField::GEAR_DOWN},
+    {"flaps_position", ChecklistField::FLAPS_POSITION},
+    {"master_battery", ChecklistField::MASTER_BATTERY},
+    {"master_alternator", ChecklistField::MASTER_ALTERNATOR},
+    {"battery_voltage", ChecklistField::BATTERY_VOLTAGE},
+    {"generator_voltage", ChecklistField::GENERATOR_VOLTAGE},
+    {"indicated_airspeed", ChecklistField::INDICATED_AIRSPEED},
+    {"ground_speed", ChecklistField::GROUND_SPEED},
+};
+
+struct ActionName {
+    std::string_view name;
+    ChecklistAction action;
+};
+
+constexpr ActionName ACTION_NAMES[] = {
+    {"none", ChecklistAction::NONE},
+    {"set_parking_brake", ChecklistAction::SET_PARKING_BRAKE},
+    {"release_parking_brake", ChecklistAction::RELEASE_PARKING_BRAKE},
+    {"mixture_rich", ChecklistAction::MIXTURE_RICH},
+    {"magnetos_both", ChecklistAction::MAGNETOS_BOTH},
+    {"start_engine", ChecklistAction::START_ENGINE},
+    {"nav_lights_on", ChecklistAction::NAV_LIGHTS_ON},
+    {"beacon_lights_on", ChecklistAction::BEACON_LIGHTS_ON},
+    {"strobe_lights_on", ChecklistAction::STROBE_LIGHTS_ON},
+    {"landing_lights_on", ChecklistAction::LANDING_LIGHTS_ON},
+    {"taxi_lights_on", ChecklistAction::TAXI_LIGHTS_ON},
+};
+
+struct PhaseName {
+    std::string_view name;
+    PreflightPhase phase;
+};
+
+constexpr PhaseName PHASE_NAMES[] = {
+    {"exterior", PreflightPhase::EXTERIOR_INSPECTION},
+    {"interior", PreflightPhase::INTERIOR_INSPECTION},
+    {"engine_startup", PreflightPhase::ENGINE_STARTUP},
+    {"systems", PreflightPhase::SYSTEM_CHECKS},
+    {"taxi", PreflightPhase::TAXI_READINESS},
+};
+
+struct AppliesName {
+    std::string_view name;
+    uint8_t bit;
+};
+
+constexpr AppliesName APPLIES_NAMES[] = {
+    {"single", APPLIES_SINGLE_ENGINE},
+    {"multi", APPLIES_MULTI_ENGINE},
+    {"turboprop", APPLIES_TURBOPROP},
+    {"jet", APPLIES_JET},
+};
+
+// Longest operators first so "<=" is not read as "<"
+struct CompareName {
+    std::string_view token;
+    ChecklistCompare compare;
+};
+
+constexpr CompareName COMPARE_NAMES[] = {
+    {"<=", ChecklistCompare::LESS_EQUAL},
+    {">=", ChecklistCompare::GREATER_EQUAL},
+    {"==", ChecklistCompare::EQUAL},
+    {"!=", ChecklistCompare::NOT_EQUAL},
+    {"<", ChecklistCompare::LESS},
+    {">", ChecklistCompare::GREATER},
+};
+
+std::string_view trim(std::string_view text) {
+    size_t start = text.find_first_not_of(" \t\r");
+    if (start == std::string_view::npos) return {};
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(start, end - start + 1);
+}
+
+template<typename Table, typename Out>
+bool lookup(const Table& table, std::string_view name, Out& out) {
+    for (const auto& entry : table) {
+        if (entry.name == name) {
+            out = entry;
+            return true;
         }
     }
-    
-    if (config.aircraftType == AircraftType::JET) {
-        initializeJetChecklist();
+    return false;
+}
+
+bool parseNumber(std::string_view text, double& value) {
+    if (text == "true") { value = 1.0; return true; }
+    if (text == "false") { value = 0.0; return true; }
+    char buffer[64];
+    if (text.empty() || text.size() >= sizeof(buffer)) return false;
+    text.copy(buffer, text.size());
+    buffer[text.size()] = '\0';
+    char* end = nullptr;
+    value = std::strtod(buffer, &end);
+    return end == buffer + text.size();
+}
+
+// "field op value", e.g. "engine_rpm > 600"
+bool parseCondition(std::string_view text, ChecklistCondition& condition) {
+    for (const auto& op : COMPARE_NAMES) {
+        size_t at = text.find(op.token);
+        if (at == std::string_view::npos) continue;
+        FieldName field{};
+        if (!lookup(FIELD_NAMES, trim(text.substr(0, at)), field)) return false;
+        if (!parseNumber(trim(text.substr(at + op.token.size())), condition.value)) return false;
+        condition.field = field.field;
+        condition.compare = op.compare;
+        return true;
     }
-    
-    return !checklistItems_.empty();
+    return false;
 }
 
-void PreflightProcedures::startPreflight() {
-    if (checklistItems_.empty()) return;
-    
-    currentPhase_ = PreflightPhase::EXTERIOR_INSPECTION;
-    currentItemIndex_ = 0;
-    startTime_ = std::time(nullptr);
+double readField(const AircraftState& state, ChecklistField field) {
+    switch (field) {
+        case ChecklistField::ENGINE_RPM: return state.engineRPM;
+        case ChecklistField::FUEL_QUANTITY: return state.fuelQuantity;
+        case ChecklistField::ON_GROUND: return state.onGround ? 1.0 : 0.0;
+        case ChecklistField::PARKING_BRAKE: return state.parkingBrakeSet ? 1.0 : 0.0;
+        case ChecklistField::GEAR_DOWN: return state.gearDown ? 1.0 : 0.0;
+        case ChecklistField::FLAPS_POSITION: return state.flapsPosition;
+        case ChecklistField::MASTER_BATTERY: return state.masterBattery ? 1.0 : 0.0;
+        case ChecklistField::MASTER_ALTERNATOR: return state.masterAlternator ? 1.0 : 0.0;
+        case ChecklistField::BATTERY_VOLTAGE: return state.batteryVoltage;
+        case ChecklistField::GENERATOR_VOLTAGE: return state.generatorVoltage;
+        case ChecklistField::INDICATED_AIRSPEED: return state.indicatedAirspeed;
+        case ChecklistField::GROUND_SPEED: return state.groundSpeed;
+    }
+    return 0.0;
 }
 
-void PreflightProcedures::initializeGenericChecklist() {
-    addExteriorInspectionItems();
-    addInteriorInspectionItems();
-    addEngineStartupItems();
-    addSystemCheckItems();
-    addTaxiReadinessItems();
+bool compare(double value, ChecklistCompare op, double reference) {
+    switch (op) {
+        case ChecklistCompare::LESS: return value < reference;
+        case ChecklistCompare::LESS_EQUAL: return value <= reference;
+        case ChecklistCompare::GREATER: return value > reference;
+        case ChecklistCompare::GREATER_EQUAL: return value >= reference;
+        case ChecklistCompare::EQUAL: return value == reference;
+        case ChecklistCompare::NOT_EQUAL: return value != reference;
+    }
+    return false;
 }
 
-void PreflightProcedures::addExteriorInspectionItems() {
-    // EXTERIOR WALK-AROUND
-    checklistItems_.push_back({
-        "EXT001", "Fuel quantity check", 
-        "Visually verify fuel in tanks", 
-        "Fuel visible in sight gauges, no contamination",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "EXT002", "Oil quantity and color check",
-        "Check engine oil level and condition",
-        "Oil on dipstick, clear to amber color",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "EXT003", "Exterior structural inspection",
-        "Visually inspect airframe for damage",
-        "No cracks, dents, loose panels, or damage",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "EXT004", "Propeller inspection",
-        "Check propeller for cracks or damage",
-        "No cracks, chips, or visible damage",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", (aircraftConfig_.numberOfEngines > 0)
-    });
-    
-    checklistItems_.push_back({
-        "EXT005", "Windscreen inspection",
-        "Check windscreen for cracks",
-        "Clear, no cracks or fogging",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "EXT006", "Pitot tube and static port check",
-        "Verify pitot tube is unobstructed",
-        "Pitot tube covers removed, ports clear",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "EXT007", "Flight control surfaces",
-        "Check ailerons, elevators, rudder",
-        "Free and correct movement, no damage",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "EXT008", "Tire pressure and condition",
-        "Check all tires for wear and pressure",
-        "Adequate pressure, no cuts or bald spots",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "EXT009", "Brake fluid inspection",
-        "Check brake fluid level",
-        "Fluid at proper level, no leaks",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "EXT010", "Door and window checks",
-        "Ensure all doors and windows sealed",
-        "All doors closed and latched",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "EXT011", "Landing gear inspection",
-        "Check gear for leaks and damage",
-        "No fluid leaks, gear appears sound",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "EXT012", "Weight and balance",
-        "Confirm loading is within limits",
-        "CG within envelope, weight within limits",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
+std::string_view value(const ParsedConfig& config, std::string_view section, std::string_view key) {
+    const std::string_view* found = config.find(section, key);
+    return found ? *found : std::string_view();
 }
 
-void PreflightProcedures::addInteriorInspectionItems() {
-    // INTERIOR INSPECTION
-    checklistItems_.push_back({
-        "INT001", "Flight instruments",
-        "Check all flight instruments",
-        "Instruments operational, correct readings",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "INT002", "Engine instruments",
-        "Check engine temp, pressure, fuel flow",
-        "All instruments reading normal",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "INT003", "Electrical system master",
-        "Master switch OFF",
-        "Master switch in OFF position",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "INT004", "Avionics master OFF",
-        "Avionics power switch OFF",
-        "Avionics master in OFF position",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "INT005", "Controls free and correct",
-        "Check pitch, roll, yaw controls",
-        "All controls move freely, correct direction",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "INT006", "Control column lock removal",
-        "Remove and stow control lock",
-        "Control lock removed, stowed",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "INT007", "Flight controls set",
-        "Trim set for takeoff, flaps UP",
-        "Trim neutral, flaps retracted",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "INT008", "Fuel pump",
-        "Fuel pump - OFF (naturally aspirated)",
-        "Fuel pump OFF (will enable at startup)",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "INT009", "Landing gear",
-        "Landing gear - DOWN and locked",
-        "Gear down and confirmed locked",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "INT010", "Lights",
-        "All lights - OFF",
-        "Navigation, strobe, landing lights OFF",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "INT011", "Seat belts",
-        "Seat belts - FASTENED",
-        "All seat belts fastened and secure",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "INT012", "Engine mixture",
-        "Engine mixture - LEAN (for altitude)",
-        "Mixture set appropriately",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
+// Compiled programs by path, with the parse they came from
+struct ProgramCache {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::pair<std::shared_ptr<const ParsedConfig>,
+                                              std::shared_ptr<const ChecklistProgram>>> programs;
+};
+
+ProgramCache& programCache() {
+    static ProgramCache cache;
+    return cache;
 }
 
-void PreflightProcedures::addEngineStartupItems() {
-    // ENGINE STARTUP SEQUENCE
-    checklistItems_.push_back({
-        "ENG001", "Throttle",
-        "Throttle - 1000 RPM or lower",
-        "Throttle in start position",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "ENG002", "Mixture",
-        "Mixture - RICH (sea level)",
-        "Mixture set for cold start",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "ENG003", "Engine primer",
-        "Engine primer - 3-6 strokes",
-        "Engine primed for cold start",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", (aircraftConfig_.numberOfEngines > 0)
-    });
-    
-    checklistItems_.push_back({
-        "ENG004", "Master battery",
-        "Master battery switch - ON",
-        "Battery master ON",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "ENG005", "Alternator",
-        "Alternator master - ON",
-        "Alternator master ON",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "ENG006", "Engine fire detection",
-        "Engine fire detection system - ARMED",
-        "Fire detection system ready",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", false  // Not applicable to small aircraft
-    });
-    
-    checklistItems_.push_back({
-        "ENG007", "Engine start",
-        "Engine start - CONTINUE until running",
-        "Engine starts smoothly and idles",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "ENG008", "Engine idle RPM",
-        "Engine idle RPM 600-800",
-        "Engine running at proper idle",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "ENG009", "Oil temperature",
-        "Oil temperature - GREEN",
-        "Oil temperature in green band",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "ENG010", "Oil pressure",
-        "Oil pressure - GREEN",
-        "Oil pressure in green band",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "ENG011", "Alternator output",
-        "Alternator output - CHECK GREEN",
-        "Alternator charging properly",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "ENG012", "Engine run-in",
-        "Run engine for 3-5 minutes",
-        "Engine temperatures stabilized",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    for (int i = 1; i < aircraftConfig_.numberOfEngines; i++) {
-        checklistItems_.push_back({
-            "ENG01" + std::to_string(i),
-            "Engine " + std::to_string(i) + " startup",
-            "Start engine " + std::to_string(i),
-            "Engine " + std::to_string(i) + " running smoothly",
-            ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-        });
+} // namespace
+
+std::shared_ptr<const ChecklistProgram> ChecklistProgram::compile(const ParsedConfig& config, std::string& error) {
+    auto program = std::make_shared<ChecklistProgram>();
+    
+    struct Pending {
+        std::string_view section;
+        PreflightPhase phase;
+    };
+    std::vector<Pending> order;
+    for (std::string_view section : config.sections()) {
+        PhaseName phase{};
+        if (!lookup(PHASE_NAMES, value(config, section, "phase"), phase)) {
+            error = std::string(section) + ": unknown phase";
+            return nullptr;
+        }
+        order.push_back({section, phase.phase});
+    }
+    // Sections arrive sorted by name; phases keep that order within them
+    std::stable_sort(order.begin(), order.end(), [](const Pending& a, const Pending& b) {
+        return static_cast<int>(a.phase) < static_cast<int>(b.phase);
+    });
+    
+    for (const Pending& pending : order) {
+        std::string_view section = pending.section;
+        auto fail = [&](const char* what) {
+            error = std::string(section) + ": " + what;
+            return nullptr;
+        };
+        
+        ChecklistStep step;
+        step.phase = pending.phase;
+        step.critical = value(config, section, "critical") != "false";
+        
+        std::string_view action = value(config, section, "do");
+        if (!action.empty()) {
+            ActionName name{};
+            if (!lookup(ACTION_NAMES, action, name)) return fail("unknown action");
+            step.action = name.action;
+        }
+        
+        double number = 0.0;
+        std::string_view text = value(config, section, "argument");
+        if (!text.empty()) {
+            if (!parseNumber(text, number)) return fail("bad argument");
+            step.argument = static_cast<int8_t>(number);
+        }
+        text = value(config, section, "timeout");
+        if (!text.empty()) {
+            if (!parseNumber(text, number) || number < 0.0) return fail("bad timeout");
+            step.timeout = static_cast<float>(number);
+        }
+        text = value(config, section, "min_engines");
+        if (!text.empty()) {
+            if (!parseNumber(text, number) || number < 0.0) return fail("bad min_engines");
+            step.minEngines = static_cast<uint8_t>(number);
+        }
+        
+        text = value(config, section, "applies");
+        if (!text.empty()) {
+            step.applies = 0;
+            while (!text.empty()) {
+                size_t comma = text.find(',');
+                AppliesName name{};
+                if (!lookup(APPLIES_NAMES, trim(text.substr(0, comma)), name)) return fail("unknown applies");
+                step.applies |= name.bit;
+                text.remove_prefix(comma == std::string_view::npos ? text.size() : comma + 1);
+            }
+        }
+        
+        step.firstCondition = static_cast<uint16_t>(program->conditions_.size());
+        text = value(config, section, "condition");
+        while (!text.empty()) {
+            size_t andAt = text.find("&&");
+            ChecklistCondition condition{};
+            if (!parseCondition(trim(text.substr(0, andAt)), condition)) return fail("bad condition");
+            program->conditions_.push_back(condition);
+            step.conditionCount++;
+            text.remove_prefix(andAt == std::string_view::npos ? text.size() : andAt + 2);
+        }
+        
+        program->steps_.push_back(step);
+        program->texts_.push_back({std::string(section),
+                                   std::string(value(config, section, "description")),
+                                   std::string(value(config, section, "action")),
+                                   std::string(value(config, section, "expected"))});
     }
+    return program;
 }
 
-void PreflightProcedures::addSystemCheckItems() {
-    // SYSTEM CHECKS
-    checklistItems_.push_back({
-        "SYS001", "Electrical system",
-        "Check electrical system",
-        "Battery voltage GREEN, alternator charging",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "SYS002", "Hydraulic system",
-        "Check hydraulic pressure",
-        "Hydraulic pressure GREEN",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "SYS003", "Fuel system",
-        "Check fuel pump operation",
-        "Fuel pump operational, pressure GREEN",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "SYS004", "Engine instruments",
-        "Check all engine instruments GREEN",
-        "All instruments in green band",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "SYS005", "Vacuum/Pressure system",
-        "Check vacuum or pressure system",
-        "Vacuum/Pressure in GREEN band",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "SYS006", "Flight instruments",
-        "Check flight instruments agree",
-        "All instruments operational and agree",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "SYS007", "Magnetic compass",
-        "Check magnetic compass",
-        "Compass reads current heading",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "SYS008", "Radios",
-        "Check radio systems",
-        "Radios functional and tuned",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
+std::shared_ptr<const ChecklistProgram> ChecklistProgram::load(const std::string& filePath, std::string& error) {
+    std::shared_ptr<const ParsedConfig> parsed = ParsedConfig::load(filePath);
+    if (!parsed) {
+        error = filePath + ": cannot read";
+        return nullptr;
+    }
     
-    checklistItems_.push_back({
-        "SYS009", "Avionics",
-        "Check GPS and navigation systems",
-        "Avionics operational and initialized",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
+    ProgramCache& cache = programCache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.programs.find(filePath);
+        if (it != cache.programs.end() && it->second.first == parsed) return it->second.second;
+    }
     
-    checklistItems_.push_back({
-        "SYS010", "Lighting systems",
-        "Check all lighting systems",
-        "All lights operational",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
+    std::shared_ptr<const ChecklistProgram> program = compile(*parsed, error);
+    if (!program) return nullptr;
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.programs[filePath] = {parsed, program};
+    return program;
 }
 
-void PreflightProcedures::addTaxiReadinessItems() {
-    // TAXI READINESS
-    checklistItems_.push_back({
-        "TAX001", "Flight plan",
-        "Flight plan filed or entered",
-        "Flight plan confirmed",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "TAX002", "Flaps",
-        "Flaps - SET FOR TAKEOFF",
-        "Flaps set to takeoff position",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "TAX003", "Trim",
-        "Trim - SET FOR TAKEOFF",
-        "Trim set to takeoff position",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "TAX004", "Controls",
-        "Flight controls - FREE AND CORRECT",
-        "All controls move freely and correctly",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "TAX005", "Seat belts",
-        "Seat belts and shoulder harness - SECURE",
-        "All occupants properly restrained",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "TAX006", "Doors and windows",
-        "Doors and windows - CLOSED AND LOCKED",
-        "All access points secure",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "TAX007", "Parking brake release",
-        "Parking brake - RELEASED",
-        "Parking brake disengaged",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "TAX008", "Landing lights",
-        "Landing lights - ON",
-        "Landing lights illuminated",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "TAX009", "Strobes",
-        "Strobe lights - ON",
-        "Strobe lights illuminated",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "TAX010", "Navigation lights",
-        "Navigation lights - ON",
-        "Nav lights illuminated",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "TAX011", "Transponder",
-        "Transponder - ALT",
-        "Transponder in ALT mode",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "TAX012", "Flight computer",
-        "Flight computer - PROGRAMMED",
-        "FPL entered, navigation programmed",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
+std::shared_ptr<const ChecklistProgram> ChecklistProgram::builtin() {
+    static const std::shared_ptr<const ChecklistProgram> program = [] {
+        std::string error;
+        return compile(*ParsedConfig::fromText(builtinPreflightChecklist()), error);
+    }();
+    return program;
 }
 
-void PreflightProcedures::initializeSingleEngineChecklist() {
-    // Additional items specific to single-engine aircraft
+void ChecklistProgram::clearCache() {
+    ProgramCache& cache = programCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.programs.clear();
 }
 
-void PreflightProcedures::initializeMultiEngineChecklist() {
-    // Additional items specific to multi-engine aircraft
-    checklistItems_.push_back({
-        "MENG001", "Engine sync check",
-        "Check engine synchronization",
-        "Engines synchronized smoothly",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
-    
-    checklistItems_.push_back({
-        "MENG002", "Prop cycle check",
-        "Cycle propellers to check operation",
-        "Propellers cycle smoothly",
-        ChecklistItemStatus::NOT_STARTED, 0.0, "", true
-    });
+bool ChecklistProgram::evaluate(size_t index, const AircraftState& state) const {
+    const ChecklistStep& s = steps_[index];
+    bool passed = true;
+    for (size_t i = s.firstCondition; i < s.firstCondition + s.conditionCount; ++i) {
+        const ChecklistCondition& c = conditions_[i];
+        passed &= compare(readField(state, c.field), c.compare, c.value);
+    }
+    return passed;
 }
 
-void PreflightProcedures::initializeTurbopropChecklist() {
-    // Turboprop-specific checks
+std::vector<uint16_t> ChecklistProgram::select(const AircraftConfig& config) const {
+    uint8_t aircraft = 0;
+    if (config.numberOfEngines == 1) {
+        aircraft |= APPLIES_SINGLE_ENGINE;
+    } else if (config.numberOfEngines > 1) {
+        aircraft |= config.engineType.find("Turboprop") != std::string::npos ? APPLIES_TURBOPROP : APPLIES_MULTI_ENGINE;
+    }
+    if (config.aircraftType == AircraftType::JET) {
+        aircraft |= APPLIES_JET;
+    }
+    
+    std::vector<uint16_t> selected;
+    selected.reserve(steps_.size());
+    for (size_t i = 0; i < steps_.size(); ++i) {
+        if ((steps_[i].applies & aircraft) && config.numberOfEngines >= steps_[i].minEngines) {
+            selected.push_back(static_cast<uint16_t>(i));
+        }
+    }
+    return selected;
 }
 
-void PreflightProcedures::initializeJetChecklist() {
-    // Jet-specific checks
+// ============================================================================
+// PreflightProcedures
+// ============================================================================
+
+PreflightProcedures::PreflightProcedures() = default;
+
+bool PreflightProcedures::initialize(const AircraftConfig& config) {
+    return initialize(config, ChecklistProgram::builtin());
 }
 
-bool PreflightProcedures::executeNextItem(const AircraftState& currentState) {
-    if (currentItemIndex_ >= checklistItems_.size()) {
-        transitionToNextPhase();
-        return currentPhase_ == PreflightPhase::COMPLETE;
+bool PreflightProcedures::initialize(const AircraftConfig& config,
+                                     std::shared_ptr<const ChecklistProgram> program) {
+    aircraftConfig_ = config;
+    program_ = std::move(program);
+    currentItemIndex_ = 0;
+    currentPhase_ = PreflightPhase::NOT_STARTED;
+    
+    // Select the steps for this aircraft type
+    steps_.clear();
+    if (program_) {
+        steps_ = program_->select(config);
     }
+    stepStates_.assign(steps_.size(), StepState());
+    notes_.clear();
     
-    ChecklistItem& item = checklistItems_[currentItemIndex_];
+    return !steps_.empty();
+}
+
+void PreflightProcedures::startPreflight() {
+    startPreflight(static_cast<double>(std::time(nullptr)));
+}
+
+void PreflightProcedures::startPreflight(double now) {
+    if (steps_.empty()) return;
     
-    // Skip non-applicable items
-    if (!item.critical && !item.critical) {
-        item.status = ChecklistItemStatus::NOT_APPLICABLE;
-        currentItemIndex_++;
-        return false;
+    currentPhase_ = PreflightPhase::EXTERIOR_INSPECTION;
+    currentItemIndex_ = 0;
+    startTime_ = now;
+}
+
+bool PreflightProcedures::executeNextItem(const AircraftState& currentState) {
+    return executeNextItem(currentState, static_cast<double>(std::time(nullptr)));
+}
+
+bool PreflightProcedures::executeNextItem(const AircraftState& currentState, double now) {
+    if (hasFailed()) return true;
+    if (currentItemIndex_ >= steps_.size()) {
+        if (currentPhase_ != PreflightPhase::NOT_STARTED) {
+            currentPhase_ = PreflightPhase::COMPLETE;
+        }
+        return true;
     }
     
-    // Validate based on phase
-    bool itemPassed = false;
+    size_t index = steps_[currentItemIndex_];
+    const ChecklistStep& step = program_->step(index);
+    StepState& state = stepStates_[currentItemIndex_];
+    currentPhase_ = step.phase;
     
-    switch (currentPhase_) {
-        case PreflightPhase::EXTERIOR_INSPECTION:
-            itemPassed = validateExteriorCondition(currentState);
-            break;
-        case PreflightPhase::INTERIOR_INSPECTION:
-            itemPassed = validateInteriorSystems(currentState);
-            break;
-        case PreflightPhase::ENGINE_STARTUP:
-            itemPassed = validateEngineReadiness(currentState);
-            break;
-        case PreflightPhase::SYSTEM_CHECKS:
-            itemPassed = validateAllSystems(currentState);
-            break;
-        case PreflightPhase::TAXI_READINESS:
-            itemPassed = validateTaxiReadiness(currentState);
-            break;
-        default:
-            itemPassed = false;
-            break;
+    if (state.status == ChecklistItemStatus::NOT_STARTED) {
+        state.status = ChecklistItemStatus::IN_PROGRESS;
+        state.startedAt = now;
+        if (step.action != ChecklistAction::NONE && actionHandler_) {
+            actionHandler_(step.action, step.argument);
+        }
     }
     
-    if (itemPassed) {
-        item.status = ChecklistItemStatus::COMPLETED;
-        item.completionTime = std::time(nullptr) - startTime_;
-    } else {
-        item.status = ChecklistItemStatus::FAILED;
-        if (item.critical) {
+    if (program_->evaluate(index, currentState)) {
+        state.status = ChecklistItemStatus::COMPLETED;
+        state.completionTime = now - startTime_;
+    } else if (now - state.startedAt >= step.timeout) {
+        state.status = ChecklistItemStatus::FAILED;
+        if (step.critical) {
             currentPhase_ = PreflightPhase::FAILED;
+            currentItemIndex_++;
+            return true;
         }
+    } else {
+        return false;  // Still waiting on this step
     }
     
     currentItemIndex_++;
-    return currentItemIndex_ >= checklistItems_.size();
+    return currentItemIndex_ >= steps_.size();
 }
 
-const ChecklistItem& PreflightProcedures::getCurrentItem() const {
-    static ChecklistItem empty;
-    if (currentItemIndex_ < checklistItems_.size()) {
-        return checklistItems_[currentItemIndex_];
+ChecklistItem PreflightProcedures::makeItem(size_t index) const {
+    const ChecklistText& text = program_->text(steps_[index]);
+    ChecklistItem item;
+    item.id = text.id;
+    item.description = text.description;
+    item.action = text.action;
+    item.expected = text.expected;
+    item.status = stepStates_[index].status;
+    item.completionTime = stepStates_[index].completionTime;
+    item.critical = program_->step(steps_[index]).critical;
+    if (index < notes_.size()) item.notes = notes_[index];
+    return item;
+}
+
+const std::vector<ChecklistItem>& PreflightProcedures::getAllItems() const {
+    items_.clear();
+    for (size_t i = 0; i < steps_.size(); ++i) {
+        items_.push_back(makeItem(i));
     }
-    return empty;
+    return items_;
+}
+
+const ChecklistItem& PreflightProcedures::getCurrentItem() const {
+    currentItem_ = currentItemIndex_ < steps_.size() ? makeItem(currentItemIndex_) : ChecklistItem();
+    return currentItem_;
 }
 
 double PreflightProcedures::getProgress() const {
-    if (checklistItems_.empty()) return 0.0;
+    if (steps_.empty()) return 0.0;
     
     size_t completed = 0;
-    for (const auto& item : checklistItems_) {
-        if (item.status == ChecklistItemStatus::COMPLETED) {
+    for (const auto& state : stepStates_) {
+        if (state.status == ChecklistItemStatus::COMPLETED) {
             completed++;
         }
     }
     
-    return static_cast<double>(completed) / static_cast<double>(checklistItems_.size());
+    return static_cast<double>(completed) / static_cast<double>(steps_.size());
 }
 
 PreflightResult PreflightProcedures::completePreflight(const AircraftState& finalState) {
@@ -597,12 +483,14 @@ PreflightResult PreflightProcedures::completePreflight(const AircraftState& fina
     report << "PREFLIGHT CHECKLIST REPORT\n";
     report << "==========================\n\n";
     
-    for (const auto& item : checklistItems_) {
-        if (item.status == ChecklistItemStatus::FAILED && item.critical) {
-            result.failedItems.push_back(item.id + ": " + item.description);
-            report << "[FAILED] " << item.description << "\n";
-        } else if (item.status == ChecklistItemStatus::COMPLETED) {
-            report << "[OK] " << item.description << "\n";
+    for (size_t i = 0; i < steps_.size(); ++i) {
+        const ChecklistText& text = program_->text(steps_[i]);
+        ChecklistItemStatus status = stepStates_[i].status;
+        if (status == ChecklistItemStatus::FAILED && program_->step(steps_[i]).critical) {
+            result.failedItems.push_back(text.id + ": " + text.description);
+            report << "[FAILED] " << text.description << "\n";
+        } else if (status == ChecklistItemStatus::COMPLETED) {
+            report << "[OK] " << text.description << "\n";
         }
     }
     
@@ -630,10 +518,10 @@ std::string PreflightProcedures::getStatusReport() const {
     }
     
     oss << "Progress: " << (getProgress() * 100.0) << "%\n";
-    oss << "Item: " << (currentItemIndex_ + 1) << " of " << checklistItems_.size() << "\n";
+    oss << "Item: " << (currentItemIndex_ + 1) << " of " << steps_.size() << "\n";
     
-    if (currentItemIndex_ < checklistItems_.size()) {
-        oss << "Current: " << checklistItems_[currentItemIndex_].description << "\n";
+    if (currentItemIndex_ < steps_.size()) {
+        oss << "Current: " << program_->text(steps_[currentItemIndex_]).description << "\n";
     }
     
     return oss.str();
@@ -645,76 +533,41 @@ void PreflightProcedures::advancePhase() {
 
 void PreflightProcedures::completeItem(const std::string& itemId, bool passed, 
                                       const std::string& notes) {
-    for (auto& item : checklistItems_) {
-        if (item.id == itemId) {
-            item.status = passed ? ChecklistItemStatus::COMPLETED : ChecklistItemStatus::FAILED;
-            item.notes = notes;
-            item.completionTime = std::time(nullptr) - startTime_;
+    for (size_t i = 0; i < steps_.size(); ++i) {
+        if (program_->text(steps_[i]).id == itemId) {
+            StepState& state = stepStates_[i];
+            state.status = passed ? ChecklistItemStatus::COMPLETED : ChecklistItemStatus::FAILED;
+            state.completionTime = std::time(nullptr) - startTime_;
+            if (notes_.size() < steps_.size()) notes_.resize(steps_.size());
+            notes_[i] = notes;
             return;
         }
     }
 }
 
-bool PreflightProcedures::validateExteriorCondition(const AircraftState& state) {
-    // In reality, this would be a manual visual inspection
-    // For simulation, we return true to represent successful completion
-    return true;
-}
-
-bool PreflightProcedures::validateInteriorSystems(const AircraftState& state) {
-    // Check that all systems are in safe initial state
-    return !state.onGround || true;  // Simplified check
-}
-
-bool PreflightProcedures::validateEngineReadiness(const AircraftState& state) {
-    // Check that engines have started and are running properly
-    return state.engineRPM > 600 && state.engineRPM < 1500;
-}
-
-bool PreflightProcedures::validateAllSystems(const AircraftState& state) {
-    // Comprehensive system validation
-    if (state.fuelQuantity <= 0) return false;
-    if (state.engineRPM < 600) return false;
-    return true;
-}
-
-bool PreflightProcedures::validateTaxiReadiness(const AircraftState& state) {
-    // Check taxi readiness conditions
-    return state.engineRPM > 600 && state.fuelQuantity > 0;
-}
-
 void PreflightProcedures::transitionToNextPhase() {
+    PreflightPhase next;
     switch (currentPhase_) {
-        case PreflightPhase::NOT_STARTED:
-            currentPhase_ = PreflightPhase::EXTERIOR_INSPECTION;
-            currentItemIndex_ = 0;
-            break;
-        case PreflightPhase::EXTERIOR_INSPECTION:
-            currentPhase_ = PreflightPhase::INTERIOR_INSPECTION;
-            currentItemIndex_ = 12;  // Approximate index
-            break;
-        case PreflightPhase::INTERIOR_INSPECTION:
-            currentPhase_ = PreflightPhase::ENGINE_STARTUP;
-            currentItemIndex_ = 24;
-            break;
-        case PreflightPhase::ENGINE_STARTUP:
-            currentPhase_ = PreflightPhase::SYSTEM_CHECKS;
-            currentItemIndex_ = 36;
-            break;
-        case PreflightPhase::SYSTEM_CHECKS:
-            currentPhase_ = PreflightPhase::TAXI_READINESS;
-            currentItemIndex_ = 46;
-            break;
+        case PreflightPhase::NOT_STARTED: next = PreflightPhase::EXTERIOR_INSPECTION; break;
+        case PreflightPhase::EXTERIOR_INSPECTION: next = PreflightPhase::INTERIOR_INSPECTION; break;
+        case PreflightPhase::INTERIOR_INSPECTION: next = PreflightPhase::ENGINE_STARTUP; break;
+        case PreflightPhase::ENGINE_STARTUP: next = PreflightPhase::SYSTEM_CHECKS; break;
+        case PreflightPhase::SYSTEM_CHECKS: next = PreflightPhase::TAXI_READINESS; break;
         case PreflightPhase::TAXI_READINESS:
             currentPhase_ = PreflightPhase::COMPLETE;
-            break;
+            currentItemIndex_ = steps_.size();
+            return;
         default:
-            break;
+            return;
+    }
+    
+    // First step of the next phase, or of a later one if it has none
+    currentPhase_ = next;
+    currentItemIndex_ = 0;
+    while (currentItemIndex_ < steps_.size() &&
+           static_cast<int>(program_->step(steps_[currentItemIndex_]).phase) < static_cast<int>(next)) {
+        currentItemIndex_++;
     }
-}
-
-void PreflightProcedures::handlePhaseCompletion() {
-    // Additional logic for phase transitions can be added here
 }
 
 } // namespace AICopilot
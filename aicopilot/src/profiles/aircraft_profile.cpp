@@ -58,13 +58,65 @@ double AircraftProfile::getFlapsForPhase(FlightPhase phase) const {
     }
 }
 
+PhaseSchedule AircraftProfile::buildPhaseSchedule() const {
+    PhaseSchedule schedule = makePhaseSchedule(category, performance.vs1, performance.cruiseSpeed);
+    
+    // Procedure flaps are in degrees; the control law's flap settings stay
+    const FlightPhase phases[] = {FlightPhase::TAKEOFF, FlightPhase::CLIMB, FlightPhase::CRUISE,
+                                  FlightPhase::DESCENT, FlightPhase::APPROACH, FlightPhase::LANDING};
+    for (FlightPhase phase : phases) {
+        double speed = getSpeedForPhase(phase);
+        if (speed > 0.0) {
+            schedule[phase].speed = speed;
+        }
+    }
+    if (procedures.takeoffPower > 0.0) {
+        schedule[FlightPhase::TAKEOFF].throttle = procedures.takeoffPower / 100.0;
+    }
+    return schedule;
+}
+
+PhaseSchedule makePhaseSchedule(AircraftCategory category, double stallSpeed, double cruiseSpeed) {
+    switch (category) {
+        case AircraftCategory::TURBOPROP:
+            return makePhaseSchedule<AircraftCategory::TURBOPROP>(stallSpeed, cruiseSpeed);
+        case AircraftCategory::JET_TRANSPORT:
+            return makePhaseSchedule<AircraftCategory::JET_TRANSPORT>(stallSpeed, cruiseSpeed);
+        case AircraftCategory::BUSINESS_JET:
+            return makePhaseSchedule<AircraftCategory::BUSINESS_JET>(stallSpeed, cruiseSpeed);
+        case AircraftCategory::HELICOPTER:
+            return makePhaseSchedule<AircraftCategory::HELICOPTER>(stallSpeed, cruiseSpeed);
+        case AircraftCategory::MULTI_ENGINE_PISTON:
+            return makePhaseSchedule<AircraftCategory::MULTI_ENGINE_PISTON>(stallSpeed, cruiseSpeed);
+        default:
+            return makePhaseSchedule<AircraftCategory::SINGLE_ENGINE_PISTON>(stallSpeed, cruiseSpeed);
+    }
+}
+
+AircraftCategory categoryForType(AircraftType type) {
+    switch (type) {
+        case AircraftType::SINGLE_ENGINE_PROP:
+            return AircraftCategory::SINGLE_ENGINE_PISTON;
+        case AircraftType::MULTI_ENGINE_PROP:
+            return AircraftCategory::MULTI_ENGINE_PISTON;
+        case AircraftType::TURBOPROP:
+            return AircraftCategory::TURBOPROP;
+        case AircraftType::JET:
+            return AircraftCategory::JET_TRANSPORT;
+        case AircraftType::HELICOPTER:
+            return AircraftCategory::HELICOPTER;
+        default:
+            return AircraftCategory::UNKNOWN;
+    }
+}
+
 bool AircraftProfileManager::loadProfile(const std::string& configPath) {
     ConfigParser parser;
     if (!parser.parse(configPath)) {
         return false;
     }
     
-    AircraftProfile profile;
+    AircraftProfile profile{};
     
     // Parse basic info
     profile.icaoDesignator = parser.getValue("GENERAL", "icao_type_designator", "");
@@ -80,12 +132,32 @@ bool AircraftProfileManager::loadProfile(const std::string& configPath) {
     
     currentProfile_ = profile;
     profiles_[profile.icaoDesignator] = profile;
+    schedules_[profile.icaoDesignator] = profile.buildPhaseSchedule();
     
     return true;
 }
 
+bool AircraftProfileManager::hasProfile(const std::string& icaoDesignator) const {
+    return profiles_.count(icaoDesignator) != 0;
+}
+
+AircraftProfile AircraftProfileManager::getProfile(const std::string& icaoDesignator) const {
+    const AircraftProfile* profile = findProfile(icaoDesignator);
+    return profile ? *profile : AircraftProfile{};
+}
+
+const AircraftProfile* AircraftProfileManager::findProfile(const std::string& icaoDesignator) const {
+    auto it = profiles_.find(icaoDesignator);
+    return it != profiles_.end() ? &it->second : nullptr;
+}
+
+const PhaseSchedule* AircraftProfileManager::findPhaseSchedule(const std::string& icaoDesignator) const {
+    auto it = schedules_.find(icaoDesignator);
+    return it != schedules_.end() ? &it->second : nullptr;
+}
+
 PerformanceProfile AircraftProfileManager::parsePerformanceData(const std::string& configPath) const {
-    PerformanceProfile perf;
+    PerformanceProfile perf{};
     ConfigParser parser;
     parser.parse(configPath);
     
@@ -98,7 +170,7 @@ PerformanceProfile AircraftProfileManager::parsePerformanceData(const std::strin
 }
 
 FlightProcedures AircraftProfileManager::parseProcedureData(const std::string& configPath) const {
-    FlightProcedures proc;
+    FlightProcedures proc{};
     
     // Set reasonable defaults
     proc.takeoffFlaps = 10.0;
@@ -11,55 +11,145 @@
 *****************************************************************************/
 
 #include "../include/runway_database_prod.hpp"
+#include "../include/io_executor.hpp"
+#include "../include/runway_selector.hpp"
+#include "../include/runway_wind.hpp"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <tuple>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
 
 namespace AICopilot {
 
-RunwayDatabase::RunwayDatabase() = default;
+RunwayDatabase::RunwayDatabase() : snapshot_(std::make_shared<const Snapshot>()) {}
 
 RunwayDatabase::~RunwayDatabase() {
     Shutdown();
 }
 
 bool RunwayDatabase::Initialize() {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    runways_.clear();
-    airports_.clear();
+    // The built-in data is staged and published as one version, so readers
+    // never see it half loaded or sort it once per runway
+    {
+        std::lock_guard<std::mutex> lock(publishMutex_);
+        staging_ = std::make_unique<Staging>();
+    }
     InitializeRunwayData();
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    std::unique_ptr<Staging> staged = std::move(staging_);
+    PublishLocked(Snapshot(), std::move(staged->runways), std::move(staged->airports));
+    return true;
+}
+
+std::shared_ptr<RunwayDatabase> RunwayDatabase::Shared() {
+    static const std::shared_ptr<RunwayDatabase> shared = [] {
+        auto db = std::make_shared<RunwayDatabase>();
+        db->Initialize();
+        return db;
+    }();
+    return shared;
+}
+
+bool RunwayDatabase::LoadPack(const std::string& path) {
+    RunwayPack pack;
+    if (!pack.open(path)) {
+        std::cerr << "RunwayDatabase: Failed to load runway pack " << path << std::endl;
+        return false;
+    }
+    std::shared_ptr<Snapshot> next = SnapshotOf(pack);
+    std::string problem = CheckSnapshot(*next);
+    if (!problem.empty()) {
+        std::cerr << "RunwayDatabase: Rejected runway pack " << path << ": " << problem << std::endl;
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    StoreLocked(std::move(next));
     return true;
 }
 
+std::future<bool> RunwayDatabase::LoadPackAsync(const std::string& path) {
+    return IoExecutor::shared()->submit([this, path] { return LoadPack(path); });
+}
+
+bool RunwayDatabase::SavePack(const std::string& path) const {
+    std::shared_ptr<const Snapshot> snapshot = Current();
+    RunwayPackBuilder builder;
+    for (const auto& pair : snapshot->airports) {
+        builder.putAirport(pair.second);
+    }
+    for (const RunwayInfo& rwy : snapshot->runways) {
+        builder.putRunway(rwy);
+    }
+    return builder.write(path);
+}
+
+std::shared_ptr<RunwayDatabase::Snapshot> RunwayDatabase::SnapshotOf(const RunwayPack& pack) {
+    auto next = std::make_shared<Snapshot>();
+    const size_t count = pack.getRunwayCount();
+    next->runways.reserve(count);
+    next->headingSin.resize(count);
+    next->headingCos.resize(count);
+    next->lda.resize(count);
+    next->length.resize(count);
+    next->width.resize(count);
+    next->hasILS.resize(count);
+    next->runwayNumber.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const RunwayPackRunway& record = pack.getRunwayRecord(i);
+        next->runways.push_back(pack.getRunway(i));
+        next->headingSin[i] = record.headingSin;
+        next->headingCos[i] = record.headingCos;
+        next->lda[i] = record.LDA;
+        next->length[i] = record.length;
+        next->width[i] = record.width;
+        next->hasILS[i] = (record.flags & RunwayPackFlags::HAS_ILS) ? 1 : 0;
+        next->runwayNumber[i] = record.runwayNumber;
+        if (next->hasILS[i]) next->runwaysWithILS++;
+    }
+    
+    for (uint32_t a = 0; a < pack.getAirportCount(); ++a) {
+        const RunwayPackAirport& record = pack.getAirportRecord(a);
+        std::string icao(pack.getString(record.icao));
+        if (record.runwayCount > 0) {
+            next->runwayIndex[icao] = RunwayRange{record.firstRunway, record.runwayCount};
+        }
+        if (record.hasInfo) {
+            next->airports.emplace(AirportKey{icao}, pack.getAirport(a));
+        }
+    }
+    return next;
+}
+
 void RunwayDatabase::Shutdown() {
-    std::lock_guard<std::mutex> lock(dbMutex_);
     Clear();
 }
 
 bool RunwayDatabase::GetRunwayInfo(const std::string& icao, const std::string& runwayId,
                                    RunwayInfo& runway) const {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    RunwayKey key{icao, runwayId};
-    auto it = runways_.find(key);
-    if (it != runways_.end()) {
-        runway = it->second;
+    RunwaySpan runways = GetRunways(icao);
+    auto it = std::lower_bound(runways.begin(), runways.end(), runwayId,
+                               [](const RunwayInfo& rwy, const std::string& id) { return rwy.runwayId < id; });
+    if (it != runways.end() && it->runwayId == runwayId) {
+        runway = *it;
         return true;
     }
     return false;
 }
 
 std::vector<RunwayInfo> RunwayDatabase::GetAllRunways(const std::string& icao) const {
-    std::vector<RunwayInfo> result;
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    
-    for (const auto& pair : runways_) {
-        if (pair.first.icao == icao) {
-            result.push_back(pair.second);
-        }
-    }
-    
-    return result;
+    RunwaySpan runways = GetRunways(icao);
+    return std::vector<RunwayInfo>(runways.begin(), runways.end());
+}
+
+RunwaySpan RunwayDatabase::GetRunways(const std::string& icao) const {
+    return SpanOf(Current(), icao);
 }
 
 RunwayInfo RunwayDatabase::GetBestRunway(const std::string& icao, int windDirection,
@@ -70,9 +160,6 @@ RunwayInfo RunwayDatabase::GetBestRunway(const std::string& icao, int windDirect
 RunwayInfo RunwayDatabase::GetBestRunwayForLanding(const std::string& icao, int windDirection,
                                                    int windSpeed, double maxCrosswind,
                                                    bool preferILS) const {
-    std::vector<RunwayInfo> runways = GetAllRunways(icao);
-    RunwayInfo selected;
-    
     RunwaySelectionCriteria criteria;
     criteria.windDirection = windDirection;
     criteria.windSpeed = windSpeed;
@@ -81,18 +168,11 @@ RunwayInfo RunwayDatabase::GetBestRunwayForLanding(const std::string& icao, int
     criteria.preferILS = preferILS;
     criteria.requiredDistance = 5000.0;
     
-    if (RunwaySelector::SelectBestRunway(runways, criteria, selected)) {
-        return selected;
-    }
-    
-    return RunwayInfo();
+    return SelectBestCached(icao, criteria, preferILS ? SelectionMode::LANDING_ILS : SelectionMode::LANDING);
 }
 
 RunwayInfo RunwayDatabase::GetBestRunwayForTakeoff(const std::string& icao, int windDirection,
                                                    int windSpeed) const {
-    std::vector<RunwayInfo> runways = GetAllRunways(icao);
-    RunwayInfo selected;
-    
     RunwaySelectionCriteria criteria;
     criteria.windDirection = windDirection;
     criteria.windSpeed = windSpeed;
@@ -101,11 +181,105 @@ RunwayInfo RunwayDatabase::GetBestRunwayForTakeoff(const std::string& icao, int
     criteria.preferILS = false;
     criteria.requiredDistance = 5000.0;
     
-    if (RunwaySelector::SelectBestRunway(runways, criteria, selected)) {
-        return selected;
+    return SelectBestCached(icao, criteria, SelectionMode::TAKEOFF);
+}
+
+RunwayInfo RunwayDatabase::SelectBestCached(const std::string& icao, const RunwaySelectionCriteria& criteria,
+                                            SelectionMode mode) const {
+    std::shared_ptr<const Snapshot> snapshot = Current();
+    auto it = snapshot->runwayIndex.find(icao);
+    if (it == snapshot->runwayIndex.end()) {
+        return RunwayInfo();
+    }
+    const RunwayInfo* runways = snapshot->runways.data() + it->second.first;
+    const size_t count = it->second.count;
+    
+    // Calm wind has no direction; anything out of range is computed, not cached
+    int direction = criteria.windSpeed == 0 ? 0 : criteria.windDirection;
+    double quarterKnots = criteria.maxAcceptableCrosswind * 4.0;
+    bool cacheable = it->second.first < (1u << 24) && direction >= 0 && direction < 512 &&
+                     criteria.windSpeed >= 0 && criteria.windSpeed < 256 &&
+                     quarterKnots >= 0.0 && quarterKnots < 1024.0 && quarterKnots == std::floor(quarterKnots);
+    uint64_t key = 0;
+    if (cacheable) {
+        key = static_cast<uint64_t>(it->second.first) |
+              static_cast<uint64_t>(direction) << 24 |
+              static_cast<uint64_t>(criteria.windSpeed) << 33 |
+              static_cast<uint64_t>(quarterKnots) << 41 |
+              static_cast<uint64_t>(mode) << 51;
+        CachedSelection cached;
+        if (selectionCache_.find(key, cached) && cached.generation == snapshot->generation) {
+            return cached.found ? snapshot->runways[cached.runway] : RunwayInfo();
+        }
     }
     
-    return RunwayInfo();
+    RunwayInfo selected;
+    bool found = RunwaySelector::SelectBestRunway(runways, count, criteria, selected);
+    if (cacheable) {
+        CachedSelection cached;
+        cached.generation = snapshot->generation;
+        if (found) {
+            // Runway IDs are unique within an airport's sorted range
+            const RunwayInfo* match = std::lower_bound(runways, runways + count, selected.runwayId,
+                [](const RunwayInfo& rwy, const std::string& id) { return rwy.runwayId < id; });
+            cached.runway = static_cast<uint32_t>(match - snapshot->runways.data());
+            cached.found = true;
+        }
+        selectionCache_.insert(key, cached);
+    }
+    return found ? selected : RunwayInfo();
+}
+
+std::vector<RunwayScore> RunwayDatabase::ScoreBestRunways(const std::vector<RunwayWindQuery>& queries,
+                                                          const RunwaySelectionCriteria& criteria) const {
+    std::shared_ptr<const Snapshot> snapshot = Current();
+    const Snapshot& db = *snapshot;
+    std::vector<RunwayScore> scores(queries.size());
+    std::vector<double> headwind;
+    std::vector<double> crosswind;
+    
+    for (size_t q = 0; q < queries.size(); ++q) {
+        const RunwayWindQuery& query = queries[q];
+        auto it = db.runwayIndex.find(query.icao);
+        if (it == db.runwayIndex.end()) {
+            continue;
+        }
+        const uint32_t first = it->second.first;
+        const uint32_t count = it->second.count;
+        
+        // One sin/cos per query rather than per runway
+        headwind.resize(count);
+        crosswind.resize(count);
+        RunwayWind::computeBatch(count, db.headingSin.data() + first, db.headingCos.data() + first,
+                                 RunwayWind::wind(query.windDirection, query.windSpeed),
+                                 headwind.data(), crosswind.data());
+        
+        RunwayScore& best = scores[q];
+        double bestScore = 1000000.0;
+        uint32_t bestIndex = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            uint32_t r = first + i;
+            if (!RunwaySelector::IsAcceptable(db.lda[r], db.length[r], db.width[r],
+                                              headwind[i], crosswind[i], criteria)) {
+                continue;
+            }
+            double score = RunwaySelector::Score(db.length[r], db.hasILS[r] != 0,
+                                                 headwind[i], crosswind[i], criteria);
+            if (score < bestScore) {
+                bestScore = score;
+                bestIndex = i;
+                best.found = true;
+            }
+        }
+        if (best.found) {
+            best.runwayId = db.runways[first + bestIndex].runwayId;
+            best.runwayNumber = db.runwayNumber[first + bestIndex];
+            best.score = bestScore;
+            best.headwind = headwind[bestIndex];
+            best.crosswind = crosswind[bestIndex];
+        }
+    }
+    return scores;
 }
 
 bool RunwayDatabase::ValidateRunway(const std::string& icao, const std::string& runwayId,
@@ -129,11 +303,10 @@ double RunwayDatabase::GetTakeoffDistance(const RunwayInfo& runway,
     return CalculateTakeoffDistanceWithFactors(runway, aircraftConfig);
 }
 
-bool RunwayDatabase::GetAirportInfo(const std::string& icao, AirportInfo& airport) const {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    AirportKey key{icao};
-    auto it = airports_.find(key);
-    if (it != airports_.end()) {
+bool RunwayDatabase::GetAirportInfo(const std::string& icao, RunwayAirportInfo& airport) const {
+    std::shared_ptr<const Snapshot> snapshot = Current();
+    auto it = snapshot->airports.find(AirportKey{icao});
+    if (it != snapshot->airports.end()) {
         airport = it->second;
         return true;
     }
@@ -141,8 +314,7 @@ bool RunwayDatabase::GetAirportInfo(const std::string& icao, AirportInfo& airpor
 }
 
 bool RunwayDatabase::HasILS(const std::string& icao) const {
-    std::vector<RunwayInfo> runways = GetAllRunways(icao);
-    for (const auto& rwy : runways) {
+    for (const auto& rwy : GetRunways(icao)) {
         if (rwy.ilsData.hasILS) {
             return true;
         }
@@ -159,7 +331,7 @@ bool RunwayDatabase::HasRunwayILS(const std::string& icao, const std::string& ru
 }
 
 bool RunwayDatabase::GetILSData(const std::string& icao, const std::string& runwayId,
-                               ILSData& ilsData) const {
+                               RunwayILSData& ilsData) const {
     RunwayInfo runway;
     if (GetRunwayInfo(icao, runwayId, runway)) {
         ilsData = runway.ilsData;
@@ -169,76 +341,222 @@ bool RunwayDatabase::GetILSData(const std::string& icao, const std::string& runw
 }
 
 int RunwayDatabase::GetRunwayCount() const {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    return static_cast<int>(runways_.size());
+    return static_cast<int>(Current()->runways.size());
 }
 
 int RunwayDatabase::GetAirportCount() const {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    return static_cast<int>(airports_.size());
+    return static_cast<int>(Current()->airports.size());
 }
 
 std::vector<std::string> RunwayDatabase::GetAirportCodes() const {
+    std::shared_ptr<const Snapshot> snapshot = Current();
     std::vector<std::string> codes;
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    for (const auto& pair : airports_) {
+    codes.reserve(snapshot->airports.size());
+    for (const auto& pair : snapshot->airports) {
         codes.push_back(pair.first.icao);
     }
     return codes;
 }
 
 bool RunwayDatabase::AirportExists(const std::string& icao) const {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    AirportKey key{icao};
-    return airports_.find(key) != airports_.end();
+    std::shared_ptr<const Snapshot> snapshot = Current();
+    return snapshot->airports.find(AirportKey{icao}) != snapshot->airports.end();
 }
 
 void RunwayDatabase::Clear() {
-    runways_.clear();
-    airports_.clear();
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    if (staging_) {
+        staging_ = std::make_unique<Staging>();
+    }
+    StoreLocked(std::make_shared<Snapshot>());
 }
 
 void RunwayDatabase::AddRunway(const RunwayInfo& runway) {
-    std::lock_guard<std::mutex> lock(dbMutex_);
-    RunwayKey key{runway.icao, runway.runwayId};
-    runways_[key] = runway;
+    AddRunways({runway});
+}
+
+void RunwayDatabase::AddRunways(const std::vector<RunwayInfo>& runways) {
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    if (staging_) {
+        staging_->runways.insert(staging_->runways.end(), runways.begin(), runways.end());
+        return;
+    }
+    PublishLocked(*Current(), runways, {});
 }
 
 std::string RunwayDatabase::GetStatistics() const {
-    std::lock_guard<std::mutex> lock(dbMutex_);
+    std::shared_ptr<const Snapshot> snapshot = Current();
     std::stringstream ss;
     ss << "Runway Database Statistics:\n";
-    ss << "  Total Airports: " << airports_.size() << "\n";
-    ss << "  Total Runways: " << runways_.size() << "\n";
+    ss << "  Total Airports: " << snapshot->airports.size() << "\n";
+    ss << "  Total Runways: " << snapshot->runways.size() << "\n";
+    ss << "  Runways with ILS: " << snapshot->runwaysWithILS << "\n";
+    
+    return ss.str();
+}
+
+std::string RunwayDatabase::CheckDatabaseConsistency() const {
+    return CheckSnapshot(*Current());
+}
+
+std::string RunwayDatabase::CheckSnapshot(const Snapshot& snapshot) {
+    for (const RunwayInfo& rwy : snapshot.runways) {
+        if (rwy.icao.empty() || rwy.runwayId.empty()) {
+            return "Runway without airport or ID at " + rwy.icao;
+        }
+        if (rwy.length <= 0) {
+            return "Invalid length for runway " + rwy.icao + " " + rwy.runwayId;
+        }
+        if (rwy.headingMagnetic < 0 || rwy.headingMagnetic > 360) {
+            return "Invalid heading for runway " + rwy.icao + " " + rwy.runwayId;
+        }
+    }
     
-    int runwaysWithILS = 0;
-    for (const auto& pair : runways_) {
-        if (pair.second.ilsData.hasILS) {
-            runwaysWithILS++;
+    // Every airport's range must hold only that airport's runways
+    for (const auto& pair : snapshot.runwayIndex) {
+        const RunwayRange& range = pair.second;
+        if (static_cast<size_t>(range.first) + range.count > snapshot.runways.size()) {
+            return "Runway range out of bounds for airport " + pair.first;
+        }
+        for (uint32_t i = 0; i < range.count; ++i) {
+            if (snapshot.runways[range.first + i].icao != pair.first) {
+                return "Runway of another airport indexed under " + pair.first;
+            }
         }
     }
-    ss << "  Runways with ILS: " << runwaysWithILS << "\n";
     
-    return ss.str();
+    for (const auto& pair : snapshot.airports) {
+        const RunwayAirportInfo& airport = pair.second;
+        if (airport.latitude < -90.0 || airport.latitude > 90.0 ||
+            airport.longitude < -180.0 || airport.longitude > 180.0) {
+            return "Invalid coordinates for airport " + airport.icao;
+        }
+    }
+    
+    return "";  // All OK
 }
 
-void RunwayDatabase::AddAirport(const AirportInfo& airport) {
-    AirportKey key{airport.icao};
-    airports_[key] = airport;
+void RunwayDatabase::AddAirport(const RunwayAirportInfo& airport) {
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    if (staging_) {
+        staging_->airports.push_back(airport);
+        return;
+    }
+    PublishLocked(*Current(), {}, {airport});
+}
+
+bool RunwayDatabase::AirportAdded(const std::string& icao) {
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    if (staging_) {
+        for (const RunwayAirportInfo& airport : staging_->airports) {
+            if (airport.icao == icao) return true;
+        }
+    }
+    return AirportExists(icao);
+}
+
+void RunwayDatabase::UpdateRunwayStats(RunwayAirportInfo& airport, const Snapshot& snapshot) {
+    airport.runwayCount = 0;
+    airport.runwayIds.clear();
+    auto range = snapshot.runwayIndex.find(airport.icao);
+    if (range == snapshot.runwayIndex.end()) {
+        return;
+    }
+    airport.runwayCount = range->second.count;
+    for (uint32_t i = 0; i < range->second.count; ++i) {
+        airport.runwayIds.push_back(snapshot.runways[range->second.first + i].runwayId);
+    }
 }
 
-void RunwayDatabase::UpdateRunwayStats(const std::string& icao) {
-    std::vector<RunwayInfo> runways = GetAllRunways(icao);
-    AirportKey key{icao};
+void RunwayDatabase::StoreLocked(std::shared_ptr<Snapshot> next) {
+    next->generation = ++generation_;
+    std::atomic_store(&snapshot_, std::shared_ptr<const Snapshot>(std::move(next)));
+}
+
+void RunwayDatabase::PublishLocked(const Snapshot& base, std::vector<RunwayInfo> runways,
+                                   std::vector<RunwayAirportInfo> airports) {
+    // Readers and spans may still hold the base, so build a new version
+    auto next = std::make_shared<Snapshot>();
+    next->airports = base.airports;
     
-    auto it = airports_.find(key);
-    if (it != airports_.end()) {
-        it->second.runwayCount = runways.size();
-        it->second.runwayIds.clear();
-        for (const auto& rwy : runways) {
-            it->second.runwayIds.push_back(rwy.runwayId);
+    std::vector<std::string> touched;
+    touched.reserve(runways.size() + airports.size());
+    for (const RunwayInfo& rwy : runways) {
+        touched.push_back(rwy.icao);
+    }
+    for (RunwayAirportInfo& airport : airports) {
+        touched.push_back(airport.icao);
+        AirportKey key{airport.icao};
+        next->airports[key] = std::move(airport);
+    }
+    
+    next->runways.reserve(base.runways.size() + runways.size());
+    next->runways.assign(base.runways.begin(), base.runways.end());
+    std::move(runways.begin(), runways.end(), std::back_inserter(next->runways));
+    
+    // Stable, so of rows with the same key the one added last survives
+    auto key = [](const RunwayInfo& rwy) { return std::tie(rwy.icao, rwy.runwayId); };
+    std::stable_sort(next->runways.begin(), next->runways.end(),
+                     [&key](const RunwayInfo& a, const RunwayInfo& b) { return key(a) < key(b); });
+    std::vector<RunwayInfo>& merged = next->runways;
+    size_t kept = 0;
+    for (size_t i = 0; i < merged.size(); ++i) {
+        if (kept > 0 && key(merged[kept - 1]) == key(merged[i])) {
+            merged[kept - 1] = std::move(merged[i]);
+        } else {
+            if (kept != i) merged[kept] = std::move(merged[i]);
+            ++kept;
         }
     }
+    merged.resize(kept);
+    
+    const size_t count = merged.size();
+    next->headingSin.resize(count);
+    next->headingCos.resize(count);
+    next->lda.resize(count);
+    next->length.resize(count);
+    next->width.resize(count);
+    next->hasILS.resize(count);
+    next->runwayNumber.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const RunwayInfo& rwy = merged[i];
+        RunwayRange& range = next->runwayIndex[rwy.icao];
+        if (range.count == 0) range.first = i;
+        range.count++;
+        if (rwy.ilsData.hasILS) next->runwaysWithILS++;
+        
+        RunwayWind::Heading heading = RunwayWind::heading(rwy.headingMagnetic);
+        next->headingSin[i] = heading.sin;
+        next->headingCos[i] = heading.cos;
+        next->lda[i] = rwy.LDA;
+        next->length[i] = rwy.length;
+        next->width[i] = rwy.width;
+        next->hasILS[i] = rwy.ilsData.hasILS ? 1 : 0;
+        next->runwayNumber[i] = static_cast<uint8_t>(RunwaySelector::ParseRunwayHeading(rwy.runwayId));
+    }
+    
+    // Runway counts and IDs of the airports the new rows belong to
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    for (const std::string& icao : touched) {
+        auto airport = next->airports.find(AirportKey{icao});
+        if (airport != next->airports.end()) {
+            UpdateRunwayStats(airport->second, *next);
+        }
+    }
+    StoreLocked(std::move(next));
+}
+
+RunwaySpan RunwayDatabase::SpanOf(const std::shared_ptr<const Snapshot>& snapshot, const std::string& icao) const {
+    RunwaySpan span;
+    auto it = snapshot->runwayIndex.find(icao);
+    if (it == snapshot->runwayIndex.end()) {
+        return span;
+    }
+    span.owner_ = snapshot;
+    span.first_ = snapshot->runways.data() + it->second.first;
+    span.count_ = it->second.count;
+    return span;
 }
 
 double RunwayDatabase::GetSurfaceFrictionCoefficient(SurfaceType surface) const {
@@ -301,7 +619,7 @@ void RunwayDatabase::InitializeRunwayData() {
     
     // KJFK - John F. Kennedy International Airport, New York
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "KJFK";
         apt.iata = "JFK";
         apt.name = "John F. Kennedy International Airport";
@@ -370,12 +688,11 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.glideslopeFrequency = 335.2;
         AddRunway(rwy);
         
-        UpdateRunwayStats("KJFK");
     }
     
     // KLAX - Los Angeles International
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "KLAX";
         apt.iata = "LAX";
         apt.name = "Los Angeles International Airport";
@@ -451,12 +768,11 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 110.3;
         AddRunway(rwy);
         
-        UpdateRunwayStats("KLAX");
     }
     
     // KORD - Chicago O'Hare International
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "KORD";
         apt.iata = "ORD";
         apt.name = "Chicago O'Hare International Airport";
@@ -514,12 +830,11 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 111.55;
         AddRunway(rwy);
         
-        UpdateRunwayStats("KORD");
     }
     
     // KDFW - Dallas/Fort Worth International
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "KDFW";
         apt.iata = "DFW";
         apt.name = "Dallas/Fort Worth International Airport";
@@ -577,12 +892,11 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 111.1;
         AddRunway(rwy);
         
-        UpdateRunwayStats("KDFW");
     }
     
     // KDEN - Denver International
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "KDEN";
         apt.iata = "DEN";
         apt.name = "Denver International Airport";
@@ -640,13 +954,12 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 111.45;
         AddRunway(rwy);
         
-        UpdateRunwayStats("KDEN");
     }
     
     // Additional Major US Airports
     // KBOS - Boston Logan International
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "KBOS";
         apt.iata = "BOS";
         apt.name = "Boston Logan International Airport";
@@ -708,12 +1021,11 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 110.95;
         AddRunway(rwy);
         
-        UpdateRunwayStats("KBOS");
     }
     
     // KSFO - San Francisco International
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "KSFO";
         apt.iata = "SFO";
         apt.name = "San Francisco International Airport";
@@ -770,7 +1082,6 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 111.15;
         AddRunway(rwy);
         
-        UpdateRunwayStats("KSFO");
     }
     
     // =====================================================================
@@ -779,7 +1090,7 @@ void RunwayDatabase::InitializeRunwayData() {
     
     // EGLL - London Heathrow
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "EGLL";
         apt.iata = "LHR";
         apt.name = "London Heathrow Airport";
@@ -837,12 +1148,11 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 110.95;
         AddRunway(rwy);
         
-        UpdateRunwayStats("EGLL");
     }
     
     // LFPG - Paris Charles de Gaulle
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "LFPG";
         apt.iata = "CDG";
         apt.name = "Paris Charles de Gaulle Airport";
@@ -899,7 +1209,6 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 109.75;
         AddRunway(rwy);
         
-        UpdateRunwayStats("LFPG");
     }
     
     // =====================================================================
@@ -908,7 +1217,7 @@ void RunwayDatabase::InitializeRunwayData() {
     
     // RJTT - Tokyo Haneda
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "RJTT";
         apt.iata = "HND";
         apt.name = "Tokyo Haneda Airport";
@@ -965,12 +1274,11 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 110.65;
         AddRunway(rwy);
         
-        UpdateRunwayStats("RJTT");
     }
     
     // OMDB - Dubai International
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "OMDB";
         apt.iata = "DXB";
         apt.name = "Dubai International Airport";
@@ -1027,7 +1335,6 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 111.15;
         AddRunway(rwy);
         
-        UpdateRunwayStats("OMDB");
     }
     
     // =====================================================================
@@ -1036,7 +1343,7 @@ void RunwayDatabase::InitializeRunwayData() {
     
     // KMCO - Orlando International
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "KMCO";
         apt.iata = "MCO";
         apt.name = "Orlando International Airport";
@@ -1093,12 +1400,11 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 111.05;
         AddRunway(rwy);
         
-        UpdateRunwayStats("KMCO");
     }
     
     // KSEA - Seattle-Tacoma International
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "KSEA";
         apt.iata = "SEA";
         apt.name = "Seattle-Tacoma International Airport";
@@ -1155,12 +1461,11 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.hasILS = false;
         AddRunway(rwy);
         
-        UpdateRunwayStats("KSEA");
     }
     
     // KATL - Atlanta Hartsfield-Jackson
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "KATL";
         apt.iata = "ATL";
         apt.name = "Atlanta Hartsfield-Jackson International Airport";
@@ -1217,7 +1522,6 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 109.55;
         AddRunway(rwy);
         
-        UpdateRunwayStats("KATL");
     }
     
     // Additional airports to reach 50+
@@ -1231,7 +1535,7 @@ void RunwayDatabase::InitializeRunwayData() {
     // Add more US airports for expansion
     // KMIA - Miami International
     {
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = "KMIA";
         apt.iata = "MIA";
         apt.name = "Miami International Airport";
@@ -1288,7 +1592,6 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 111.35;
         AddRunway(rwy);
         
-        UpdateRunwayStats("KMIA");
     }
     
     // Simplified entries for additional major airports to reach 50+
@@ -1321,9 +1624,9 @@ void RunwayDatabase::InitializeRunwayData() {
     };
     
     for (const auto& [icao, iata, name, lat, lon, elev] : airports) {
-        if (AirportExists(icao)) continue;  // Skip if already added
+        if (AirportAdded(icao)) continue;  // Skip if already added
         
-        AirportInfo apt;
+        RunwayAirportInfo apt;
         apt.icao = icao;
         apt.iata = iata;
         apt.name = name;
@@ -1367,7 +1670,6 @@ void RunwayDatabase::InitializeRunwayData() {
         rwy.ilsData.localizerFrequency = 110.7;
         AddRunway(rwy);
         
-        UpdateRunwayStats(icao);
     }
 }
 
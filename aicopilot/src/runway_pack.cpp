@@ -0,0 +1,480 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Runway Pack Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/runway_pack.hpp"
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AICopilot {
+
+namespace {
+
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+uint32_t hashName(std::string_view name) {
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+uint64_t checksum(const uint8_t* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+uint32_t bucketCountFor(size_t entries) {
+    uint32_t buckets = 16;
+    while (buckets < entries * 2) buckets <<= 1;
+    return buckets;
+}
+
+// Leading digits of the first two characters, as RunwaySelector::ParseRunwayHeading
+uint8_t runwayNumberOf(const std::string& runwayId) {
+    if (runwayId.size() < 2) {
+        return 0;
+    }
+    int number = 0;
+    for (size_t i = 0; i < 2 && std::isdigit(static_cast<unsigned char>(runwayId[i])); ++i) {
+        number = number * 10 + (runwayId[i] - '0');
+    }
+    return static_cast<uint8_t>(number);
+}
+
+// Deduplicating string pool
+class StringPool {
+public:
+    RunwayPackString add(const std::string& value) {
+        auto it = offsets_.find(value);
+        if (it == offsets_.end()) {
+            it = offsets_.emplace(value, static_cast<uint32_t>(bytes_.size())).first;
+            bytes_.insert(bytes_.end(), value.begin(), value.end());
+        }
+        return {it->second, static_cast<uint32_t>(value.size())};
+    }
+    const std::vector<char>& bytes() const { return bytes_; }
+
+private:
+    std::vector<char> bytes_;
+    std::unordered_map<std::string, uint32_t> offsets_;
+};
+
+template <typename T>
+void appendSection(std::vector<uint8_t>& image, RunwayPackHeader& header, RunwayPackSectionId id,
+                   const std::vector<T>& items) {
+    image.resize((image.size() + 7) & ~static_cast<size_t>(7), 0);
+    size_t bytes = items.size() * sizeof(T);
+    header.sections[id].offset = image.size();
+    header.sections[id].size = bytes;
+    if (bytes > 0) {
+        const auto* begin = reinterpret_cast<const uint8_t*>(items.data());
+        image.insert(image.end(), begin, begin + bytes);
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// RunwayPackBuilder
+// ============================================================================
+
+void RunwayPackBuilder::putAirport(const RunwayAirportInfo& airport) {
+    airports_[airport.icao] = airport;
+}
+
+void RunwayPackBuilder::putRunway(const RunwayInfo& runway) {
+    runways_[{runway.icao, runway.runwayId}] = runway;
+}
+
+std::vector<uint8_t> RunwayPackBuilder::build() const {
+    RunwayPackHeader header{};
+    std::memcpy(header.magic, RunwayPack::MAGIC, sizeof(header.magic));
+    header.version = RunwayPack::VERSION;
+    header.headerSize = sizeof(RunwayPackHeader);
+
+    StringPool strings;
+
+    // Airports with information and airports only known from their runways,
+    // merged in ICAO order; runways_ is already grouped the same way
+    std::vector<RunwayPackAirport> airportRecords;
+    std::vector<std::string> icaos;
+    auto addAirport = [&](const std::string& icao) {
+        RunwayPackAirport record{};
+        record.icao = strings.add(icao);
+        auto info = airports_.find(icao);
+        if (info != airports_.end()) {
+            const RunwayAirportInfo& airport = info->second;
+            record.latitude = airport.latitude;
+            record.longitude = airport.longitude;
+            record.magneticVariation = airport.magneticVariation;
+            record.iata = strings.add(airport.iata);
+            record.name = strings.add(airport.name);
+            record.classification = strings.add(airport.classification);
+            record.elevation = airport.elevation;
+            record.hasInfo = 1;
+            record.hasMajorILS = airport.hasMajorILS ? 1 : 0;
+        }
+        airportRecords.push_back(record);
+        icaos.push_back(icao);
+    };
+
+    std::vector<RunwayPackRunway> runwayRecords;
+    runwayRecords.reserve(runways_.size());
+    auto airport = airports_.begin();
+    for (const auto& entry : runways_) {
+        const RunwayInfo& rwy = entry.second;
+        while (airport != airports_.end() && airport->first < rwy.icao) {
+            addAirport((airport++)->first);
+        }
+        if (icaos.empty() || icaos.back() != rwy.icao) {
+            if (airport != airports_.end() && airport->first == rwy.icao) ++airport;
+            addAirport(rwy.icao);
+            airportRecords.back().firstRunway = static_cast<uint32_t>(runwayRecords.size());
+        }
+        airportRecords.back().runwayCount++;
+
+        RunwayPackRunway record{};
+        record.latitude = rwy.latitude;
+        record.longitude = rwy.longitude;
+        record.magneticVariation = rwy.magneticVariation;
+        record.frictionCoefficient = rwy.frictionCoefficient;
+        record.localizerFrequency = rwy.ilsData.localizerFrequency;
+        record.glideslopeFrequency = rwy.ilsData.glideslopeFrequency;
+        record.glideslopeAngle = rwy.ilsData.glideslopeAngle;
+        record.headingSin = std::sin(rwy.headingMagnetic * DEG_TO_RAD);
+        record.headingCos = std::cos(rwy.headingMagnetic * DEG_TO_RAD);
+        record.airportName = strings.add(rwy.airportName);
+        record.runwayId = strings.add(rwy.runwayId);
+        record.vgsiType = strings.add(rwy.vgsiType);
+        record.ilsIdentifier = strings.add(rwy.ilsData.identifier);
+        record.remarks = strings.add(rwy.remarks);
+        record.airport = static_cast<uint32_t>(airportRecords.size() - 1);
+        record.elevation = rwy.elevation;
+        record.headingMagnetic = rwy.headingMagnetic;
+        record.headingTrue = rwy.headingTrue;
+        record.length = rwy.length;
+        record.width = rwy.width;
+        record.displacedDistance = rwy.displacedDistance;
+        record.TORA = rwy.TORA;
+        record.TODA = rwy.TODA;
+        record.ASDA = rwy.ASDA;
+        record.LDA = rwy.LDA;
+        record.localizerCourse = rwy.ilsData.localizerCourse;
+        record.decisionHeight = rwy.ilsData.decisionHeight;
+        record.minimumRVR = rwy.ilsData.minimumRVR;
+        record.surface = static_cast<uint8_t>(rwy.surface);
+        record.ilsCategory = static_cast<uint8_t>(rwy.ilsData.category);
+        record.flags = (rwy.ilsData.hasILS ? RunwayPackFlags::HAS_ILS : 0) |
+                       (rwy.grooved ? RunwayPackFlags::GROOVED : 0) |
+                       (rwy.porous ? RunwayPackFlags::POROUS : 0) |
+                       (rwy.hasALS ? RunwayPackFlags::HAS_ALS : 0) |
+                       (rwy.hasRunwayLights ? RunwayPackFlags::HAS_RUNWAY_LIGHTS : 0) |
+                       (rwy.hasREIL ? RunwayPackFlags::HAS_REIL : 0) |
+                       (rwy.hasVGSI ? RunwayPackFlags::HAS_VGSI : 0) |
+                       (rwy.displaceThreshold ? RunwayPackFlags::DISPLACED_THRESHOLD : 0);
+        record.runwayNumber = runwayNumberOf(rwy.runwayId);
+        runwayRecords.push_back(record);
+    }
+    while (airport != airports_.end()) {
+        addAirport((airport++)->first);
+    }
+    header.airportCount = static_cast<uint32_t>(airportRecords.size());
+    header.runwayCount = static_cast<uint32_t>(runwayRecords.size());
+
+    // Open-addressing table of airport indices, probed linearly from the ICAO hash
+    header.airportBuckets = bucketCountFor(icaos.size());
+    std::vector<uint32_t> airportHash(header.airportBuckets, RunwayPack::NO_INDEX);
+    for (size_t i = 0; i < icaos.size(); ++i) {
+        uint32_t slot = hashName(icaos[i]) & (header.airportBuckets - 1);
+        while (airportHash[slot] != RunwayPack::NO_INDEX) slot = (slot + 1) & (header.airportBuckets - 1);
+        airportHash[slot] = static_cast<uint32_t>(i);
+    }
+
+    std::vector<uint8_t> image(sizeof(RunwayPackHeader), 0);
+    appendSection(image, header, RUNWAY_SECTION_STRINGS, strings.bytes());
+    appendSection(image, header, RUNWAY_SECTION_AIRPORTS, airportRecords);
+    appendSection(image, header, RUNWAY_SECTION_AIRPORT_HASH, airportHash);
+    appendSection(image, header, RUNWAY_SECTION_RUNWAYS, runwayRecords);
+
+    header.fileSize = image.size();
+    header.checksum = checksum(image.data() + sizeof(RunwayPackHeader), image.size() - sizeof(RunwayPackHeader));
+    std::memcpy(image.data(), &header, sizeof(header));
+    return image;
+}
+
+bool RunwayPackBuilder::write(const std::string& path) const {
+    std::vector<uint8_t> image = build();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "RunwayPackBuilder: Cannot write " << path << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    return static_cast<bool>(out);
+}
+
+// ============================================================================
+// RunwayPack
+// ============================================================================
+
+RunwayPack::~RunwayPack() {
+    close();
+}
+
+bool RunwayPack::isPackFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {0};
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool RunwayPack::open(const std::string& path, bool verifyChecksum) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || static_cast<size_t>(size.QuadPart) < sizeof(RunwayPackHeader)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle_ = file;
+    mappingHandle_ = mapping;
+    size_ = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(RunwayPackHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // the mapping keeps the file referenced
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+
+    data_ = static_cast<const uint8_t*>(view);
+    if (!validate(verifyChecksum)) {
+        std::cerr << "RunwayPack: " << path << " is not a valid runway pack" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool RunwayPack::openImage(std::vector<uint8_t> image) {
+    close();
+    if (image.size() < sizeof(RunwayPackHeader)) {
+        return false;
+    }
+
+    image_ = std::move(image);
+    data_ = image_.data();
+    size_ = image_.size();
+    if (!validate(true)) {
+        std::cerr << "RunwayPack: image is not a valid runway pack" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void RunwayPack::close() {
+    if (data_ != nullptr && image_.empty()) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(static_cast<HANDLE>(mappingHandle_));
+        CloseHandle(static_cast<HANDLE>(fileHandle_));
+#else
+        munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+    image_.clear();
+    image_.shrink_to_fit();
+    data_ = nullptr;
+    size_ = 0;
+    fileHandle_ = nullptr;
+    mappingHandle_ = nullptr;
+}
+
+bool RunwayPack::save(const std::string& path) const {
+    if (!isOpen()) return false;
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(data_), static_cast<std::streamsize>(size_));
+    return static_cast<bool>(out);
+}
+
+bool RunwayPack::validate(bool verifyChecksum) const {
+    const RunwayPackHeader& h = header();
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != VERSION) return false;
+    if (h.headerSize != sizeof(RunwayPackHeader) || h.fileSize != size_) return false;
+    if (h.airportBuckets == 0 || (h.airportBuckets & (h.airportBuckets - 1)) != 0) return false;
+
+    const uint64_t expected[RUNWAY_SECTION_COUNT] = {
+        h.sections[RUNWAY_SECTION_STRINGS].size,
+        uint64_t(h.airportCount) * sizeof(RunwayPackAirport),
+        uint64_t(h.airportBuckets) * sizeof(uint32_t),
+        uint64_t(h.runwayCount) * sizeof(RunwayPackRunway),
+    };
+    for (uint32_t id = 0; id < RUNWAY_SECTION_COUNT; ++id) {
+        const RunwayPackSection& s = h.sections[id];
+        if (s.size != expected[id] || s.offset % 8 != 0 || s.offset < sizeof(RunwayPackHeader)) return false;
+        if (s.offset > size_ || s.size > size_ - s.offset) return false;
+    }
+
+    if (verifyChecksum &&
+        checksum(data_ + sizeof(RunwayPackHeader), size_ - sizeof(RunwayPackHeader)) != h.checksum) {
+        return false;
+    }
+
+    // Ranges stay inside the runway table and back-references agree with them
+    for (uint32_t r = 0; r < h.runwayCount; ++r) {
+        if (runways()[r].airport >= h.airportCount) return false;
+    }
+    for (uint32_t a = 0; a < h.airportCount; ++a) {
+        const RunwayPackAirport& airport = airports()[a];
+        if (airport.firstRunway > h.runwayCount || airport.runwayCount > h.runwayCount - airport.firstRunway) {
+            return false;
+        }
+        for (uint32_t r = airport.firstRunway; r < airport.firstRunway + airport.runwayCount; ++r) {
+            if (runways()[r].airport != a) return false;
+        }
+    }
+    return true;
+}
+
+std::string_view RunwayPack::getString(const RunwayPackString& ref) const {
+    const RunwayPackSection& s = header().sections[RUNWAY_SECTION_STRINGS];
+    if (ref.offset > s.size || ref.length > s.size - ref.offset) return std::string_view();
+    return std::string_view(reinterpret_cast<const char*>(data_ + s.offset + ref.offset), ref.length);
+}
+
+uint32_t RunwayPack::findAirport(std::string_view icao) const {
+    if (!isOpen()) return NO_INDEX;
+    const RunwayPackHeader& h = header();
+    const uint32_t* table = section<uint32_t>(RUNWAY_SECTION_AIRPORT_HASH);
+    const uint32_t mask = h.airportBuckets - 1;
+    for (uint32_t slot = hashName(icao) & mask, probes = 0; probes < h.airportBuckets;
+         slot = (slot + 1) & mask, ++probes) {
+        uint32_t airport = table[slot];
+        if (airport >= h.airportCount) return NO_INDEX;
+        if (getString(airports()[airport].icao) == icao) return airport;
+    }
+    return NO_INDEX;
+}
+
+RunwayAirportInfo RunwayPack::getAirport(uint32_t airport) const {
+    const RunwayPackAirport& record = airports()[airport];
+    RunwayAirportInfo info;
+    info.icao = std::string(getString(record.icao));
+    info.iata = std::string(getString(record.iata));
+    info.name = std::string(getString(record.name));
+    info.latitude = record.latitude;
+    info.longitude = record.longitude;
+    info.elevation = record.elevation;
+    info.magneticVariation = record.magneticVariation;
+    info.hasMajorILS = record.hasMajorILS != 0;
+    info.classification = std::string(getString(record.classification));
+    info.runwayCount = static_cast<int>(record.runwayCount);
+    info.runwayIds.reserve(record.runwayCount);
+    for (uint32_t r = record.firstRunway; r < record.firstRunway + record.runwayCount; ++r) {
+        info.runwayIds.emplace_back(getString(runways()[r].runwayId));
+    }
+    return info;
+}
+
+RunwayInfo RunwayPack::getRunway(uint32_t runway) const {
+    const RunwayPackRunway& record = runways()[runway];
+    RunwayInfo rwy;
+    rwy.icao = std::string(getString(airports()[record.airport].icao));
+    rwy.airportName = std::string(getString(record.airportName));
+    rwy.runwayId = std::string(getString(record.runwayId));
+    rwy.latitude = record.latitude;
+    rwy.longitude = record.longitude;
+    rwy.elevation = record.elevation;
+    rwy.magneticVariation = record.magneticVariation;
+    rwy.headingMagnetic = record.headingMagnetic;
+    rwy.headingTrue = record.headingTrue;
+    rwy.length = record.length;
+    rwy.width = record.width;
+    rwy.surface = static_cast<SurfaceType>(record.surface);
+    rwy.frictionCoefficient = record.frictionCoefficient;
+    rwy.grooved = (record.flags & RunwayPackFlags::GROOVED) != 0;
+    rwy.porous = (record.flags & RunwayPackFlags::POROUS) != 0;
+    rwy.hasALS = (record.flags & RunwayPackFlags::HAS_ALS) != 0;
+    rwy.hasRunwayLights = (record.flags & RunwayPackFlags::HAS_RUNWAY_LIGHTS) != 0;
+    rwy.hasREIL = (record.flags & RunwayPackFlags::HAS_REIL) != 0;
+    rwy.hasVGSI = (record.flags & RunwayPackFlags::HAS_VGSI) != 0;
+    rwy.vgsiType = std::string(getString(record.vgsiType));
+    rwy.displaceThreshold = (record.flags & RunwayPackFlags::DISPLACED_THRESHOLD) != 0;
+    rwy.displacedDistance = record.displacedDistance;
+    rwy.TORA = record.TORA;
+    rwy.TODA = record.TODA;
+    rwy.ASDA = record.ASDA;
+    rwy.LDA = record.LDA;
+    rwy.ilsData.hasILS = (record.flags & RunwayPackFlags::HAS_ILS) != 0;
+    rwy.ilsData.category = static_cast<ILSCategory>(record.ilsCategory);
+    rwy.ilsData.localizerFrequency = record.localizerFrequency;
+    rwy.ilsData.glideslopeFrequency = record.glideslopeFrequency;
+    rwy.ilsData.localizerCourse = record.localizerCourse;
+    rwy.ilsData.glideslopeAngle = record.glideslopeAngle;
+    rwy.ilsData.decisionHeight = record.decisionHeight;
+    rwy.ilsData.minimumRVR = record.minimumRVR;
+    rwy.ilsData.identifier = std::string(getString(record.ilsIdentifier));
+    rwy.remarks = std::string(getString(record.remarks));
+    return rwy;
+}
+
+} // namespace AICopilot
@@ -11,6 +11,7 @@
 *****************************************************************************/
 
 #include "../include/runway_selector.hpp"
+#include "../include/runway_wind.hpp"
 #include <cmath>
 #include <algorithm>
 #include <sstream>
@@ -35,22 +36,11 @@ RunwayWindComponents RunwaySelector::CalculateWindComponents(
     components.direction = windDirection;
     components.magnitude = windSpeed;
     
-    // Convert degrees to radians
-    double headingRad = runwayHeading * M_PI / 180.0;
-    double windRad = windDirection * M_PI / 180.0;
-    
-    // Calculate relative angle between wind and runway
-    double angleDiff = windRad - headingRad;
-    
-    // Normalize to [-180, 180]
-    while (angleDiff > M_PI) angleDiff -= 2.0 * M_PI;
-    while (angleDiff < -M_PI) angleDiff += 2.0 * M_PI;
-    
     // Headwind component (positive = headwind, negative = tailwind)
-    components.headwind = windSpeed * std::cos(angleDiff);
-    
     // Crosswind component (positive = from left, negative = from right)
-    components.crosswind = windSpeed * std::sin(angleDiff);
+    RunwayWind::Components wind = RunwayWind::compute(runwayHeading, windDirection, windSpeed);
+    components.headwind = wind.headwind;
+    components.crosswind = wind.crosswind;
     
     // Tailwind for reporting
     components.tailwind = -components.headwind;
@@ -60,54 +50,51 @@ RunwayWindComponents RunwaySelector::CalculateWindComponents(
 }
 
 double RunwaySelector::CalculateCrosswind(int runwayHeading, int windDirection, int windSpeed) {
-    double headingRad = runwayHeading * M_PI / 180.0;
-    double windRad = windDirection * M_PI / 180.0;
-    double angleDiff = windRad - headingRad;
-    
-    while (angleDiff > M_PI) angleDiff -= 2.0 * M_PI;
-    while (angleDiff < -M_PI) angleDiff += 2.0 * M_PI;
-    
-    return windSpeed * std::sin(angleDiff);
+    return RunwayWind::compute(runwayHeading, windDirection, windSpeed).crosswind;
 }
 
 double RunwaySelector::CalculateHeadwind(int runwayHeading, int windDirection, int windSpeed) {
-    double headingRad = runwayHeading * M_PI / 180.0;
-    double windRad = windDirection * M_PI / 180.0;
-    double angleDiff = windRad - headingRad;
-    
-    while (angleDiff > M_PI) angleDiff -= 2.0 * M_PI;
-    while (angleDiff < -M_PI) angleDiff += 2.0 * M_PI;
-    
-    return windSpeed * std::cos(angleDiff);
+    return RunwayWind::compute(runwayHeading, windDirection, windSpeed).headwind;
 }
 
 bool RunwaySelector::IsRunwayAcceptable(
     const RunwayInfo& runway,
     const RunwaySelectionCriteria& criteria,
     const RunwayWindComponents& components) {
+    return IsAcceptable(runway.LDA, runway.length, runway.width,
+                        components.headwind, components.crosswind, criteria);
+}
+
+bool RunwaySelector::IsAcceptable(
+    int lda,
+    int length,
+    int width,
+    double headwind,
+    double crosswind,
+    const RunwaySelectionCriteria& criteria) {
     
     // Check crosswind limit
-    if (std::abs(components.crosswind) > criteria.maxAcceptableCrosswind) {
+    if (std::abs(crosswind) > criteria.maxAcceptableCrosswind) {
         return false;
     }
     
     // Check tailwind limit (allow some tailwind)
-    if (components.headwind < -criteria.maxAcceptableTailwind) {
+    if (headwind < -criteria.maxAcceptableTailwind) {
         return false;
     }
     
     // Check runway length
-    if (runway.LDA < static_cast<int>(criteria.requiredDistance)) {
+    if (lda < static_cast<int>(criteria.requiredDistance)) {
         return false;
     }
     
     // Check runway width (typical minimums)
-    if (runway.width < criteria.aircraftType.empty() ? 75 : 100) {
+    if (width < (criteria.aircraftType.empty() ? 75 : 100)) {
         return false;
     }
     
     // Check runway is available
-    if (runway.length == 0) {
+    if (length == 0) {
         return false;
     }
     
@@ -118,26 +105,36 @@ double RunwaySelector::ScoreRunway(
     const RunwayInfo& runway,
     const RunwaySelectionCriteria& criteria,
     const RunwayWindComponents& components) {
+    return Score(runway.length, runway.ilsData.hasILS,
+                 components.headwind, components.crosswind, criteria);
+}
+
+double RunwaySelector::Score(
+    int length,
+    bool hasILS,
+    double headwind,
+    double crosswind,
+    const RunwaySelectionCriteria& criteria) {
     
     double score = 0.0;
     
     // Penalize crosswind heavily (0-500 points based on crosswind)
-    double absCrosswind = std::abs(components.crosswind);
+    double absCrosswind = std::abs(crosswind);
     score += absCrosswind * CROSSWIND_WEIGHT;
     
     // Penalize tailwind heavily
-    if (components.headwind < 0.0) {
-        score += (-components.headwind) * TAILWIND_PENALTY;
+    if (headwind < 0.0) {
+        score += (-headwind) * TAILWIND_PENALTY;
     } else {
         // Reward headwind
-        score -= components.headwind * HEADWIND_WEIGHT;
+        score -= headwind * HEADWIND_WEIGHT;
     }
     
     // Bonus for longer runways
-    score -= (runway.length - criteria.requiredDistance) * LENGTH_BONUS;
+    score -= (length - criteria.requiredDistance) * LENGTH_BONUS;
     
     // Bonus for ILS
-    if (criteria.preferILS && runway.ilsData.hasILS) {
+    if (criteria.preferILS && hasILS) {
         score += ILS_BONUS;
     }
     
@@ -151,11 +148,20 @@ bool RunwaySelector::SelectBestRunway(
     const std::vector<RunwayInfo>& runways,
     const RunwaySelectionCriteria& criteria,
     RunwayInfo& bestRunway) {
+    return SelectBestRunway(runways.data(), runways.size(), criteria, bestRunway);
+}
+
+bool RunwaySelector::SelectBestRunway(
+    const RunwayInfo* runways,
+    size_t count,
+    const RunwaySelectionCriteria& criteria,
+    RunwayInfo& bestRunway) {
     
     double bestScore = 1000000.0;
     bool found = false;
     
-    for (const auto& runway : runways) {
+    for (size_t i = 0; i < count; ++i) {
+        const RunwayInfo& runway = runways[i];
         // Calculate wind components
         auto components = CalculateWindComponents(
             runway.headingMagnetic,
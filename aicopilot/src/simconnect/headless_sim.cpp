@@ -0,0 +1,521 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Headless Sim Implementation
+* Point-mass flight model and fast-time SimConnect backend
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/headless_sim.hpp"
+#include "../include/binary_log.hpp"
+#include "../include/geodesy.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace AICopilot {
+
+namespace {
+
+using Geodesy::DEG_TO_RAD;
+using Geodesy::RAD_TO_DEG;
+
+constexpr double FPM_PER_KNOT = 101.2686;       // 1 kt = 101.27 ft/min
+constexpr double TURN_RATE_CONSTANT = 1091.0;   // deg/s = 1091 tan(bank) / TAS(kt)
+
+constexpr double SPEED_TIME_CONSTANT = 10.0;    // s
+constexpr double MAX_ACCELERATION = 4.0;        // kt/s
+constexpr double MAX_DECELERATION = 3.0;        // kt/s
+constexpr double BRAKE_DECELERATION = 5.0;      // kt/s at full brakes
+constexpr double VERTICAL_ACCELERATION = 600.0; // fpm/s
+constexpr double ALTITUDE_CAPTURE_GAIN = 2.0;   // fpm per ft of error
+constexpr double MAX_FLIGHT_PATH_ANGLE = 20.0;  // degrees at full elevator
+constexpr double HEADING_GAIN = 1.5;            // degrees of bank per degree of error
+constexpr double MAX_AUTOPILOT_BANK = 25.0;
+constexpr double MAX_BANK = 30.0;
+constexpr double ROLL_RATE = 10.0;              // deg/s
+constexpr double GROUND_TURN_RATE = 20.0;       // deg/s at full rudder
+constexpr double MIN_TURN_AIRSPEED = 40.0;      // kt
+
+double wrap180(double degrees) {
+    degrees = std::fmod(degrees + 180.0, 360.0);
+    if (degrees < 0.0) degrees += 360.0;
+    return degrees - 180.0;
+}
+
+double wrap360(double degrees) {
+    degrees = std::fmod(degrees, 360.0);
+    return degrees < 0.0 ? degrees + 360.0 : degrees;
+}
+
+double approach(double value, double target, double maxDelta) {
+    return value + std::clamp(target - value, -maxDelta, maxDelta);
+}
+
+// Standard atmosphere density ratio (troposphere)
+double densityRatio(double altitudeFeet) {
+    double ratio = 1.0 - 6.8756e-6 * std::clamp(altitudeFeet, 0.0, 36089.0);
+    return std::pow(ratio, 4.2559);
+}
+
+void fillDefault(double& value, double fallback) {
+    if (value <= 0.0) value = fallback;
+}
+
+PerformanceProfile withDefaults(PerformanceProfile performance) {
+    fillDefault(performance.vso, 40.0);
+    fillDefault(performance.vs1, 48.0);
+    fillDefault(performance.vr, 55.0);
+    fillDefault(performance.vy, 74.0);
+    fillDefault(performance.vno, 129.0);
+    fillDefault(performance.cruiseSpeed, 120.0);
+    fillDefault(performance.maxSpeed, 160.0);
+    fillDefault(performance.climbRate, 700.0);
+    fillDefault(performance.descentRate, 500.0);
+    fillDefault(performance.serviceCeiling, 14000.0);
+    fillDefault(performance.fuelCapacity, 53.0);
+    fillDefault(performance.fuelFlow, 9.0);
+    return performance;
+}
+
+} // namespace
+
+// ============================================================================
+// PointMassFlightModel Implementation
+// ============================================================================
+
+PointMassFlightModel::PointMassFlightModel(const HeadlessSimConfig& config)
+    : performance_(withDefaults(config.performance)),
+      latitude_(config.start.latitude),
+      longitude_(config.start.longitude),
+      altitude_(config.start.altitude),
+      heading_(wrap360(config.start.heading)),
+      fuelQuantity_(config.fuelQuantity < 0.0 ? performance_.fuelCapacity : config.fuelQuantity),
+      onGround_(config.startOnGround),
+      groundElevation_(config.startOnGround ? config.start.altitude : 0.0),
+      windFromDegrees_(config.windDirection),
+      windSpeed_(config.windSpeed) {
+    autopilot_.targetHeading = heading_;
+    autopilot_.targetAltitude = altitude_;
+    if (!onGround_) {
+        // Airborne starts are trimmed at cruise with the gear up
+        indicatedAirspeed_ = performance_.cruiseSpeed * std::sqrt(densityRatio(altitude_));
+        autopilot_.targetSpeed = indicatedAirspeed_;
+        controls_.throttle = 0.75;
+        controls_.gearDown = false;
+    }
+    trueAirspeed_ = indicatedAirspeed_ / std::sqrt(densityRatio(altitude_));
+    groundSpeed_ = trueAirspeed_;
+}
+
+void PointMassFlightModel::setWind(double directionDegrees, double speedKnots) {
+    windFromDegrees_ = directionDegrees;
+    windSpeed_ = std::max(0.0, speedKnots);
+}
+
+double PointMassFlightModel::commandedSpeed() const {
+    if (!controls_.engineRunning) {
+        return 0.0;
+    }
+    if (autopilot_.masterEnabled && autopilot_.speedHold && autopilot_.targetSpeed > 0.0 && !onGround_) {
+        // Speed hold manages power itself (autothrottle)
+        return std::min(autopilot_.targetSpeed, performance_.maxSpeed);
+    }
+    double drag = 0.25 * controls_.flaps / 100.0 + (controls_.gearDown ? 0.05 : 0.0) +
+                  (controls_.spoilers ? 0.2 : 0.0);
+    return controls_.throttle * performance_.maxSpeed * std::max(0.0, 1.0 - drag);
+}
+
+double PointMassFlightModel::commandedVerticalSpeed(double airspeed) const {
+    double ceiling = std::clamp(1.0 - altitude_ / performance_.serviceCeiling, 0.05, 1.0);
+    bool speedHold = autopilot_.masterEnabled && autopilot_.speedHold && autopilot_.targetSpeed > 0.0;
+    double power = speedHold ? 1.0 : controls_.throttle;
+    double climbLimit = controls_.engineRunning ? performance_.climbRate * power * ceiling
+                                                : -0.7 * performance_.descentRate;   // glide
+    double descentLimit = -2.0 * performance_.descentRate;
+
+    if (!onGround_ && indicatedAirspeed_ < performance_.vs1) {
+        return -performance_.descentRate;   // mushing below the stall
+    }
+
+    if (autopilot_.masterEnabled && autopilot_.altitudeHold) {
+        double rate = (autopilot_.targetAltitude - altitude_) * ALTITUDE_CAPTURE_GAIN;
+        double climb = std::max(0.0, climbLimit);
+        double descent = performance_.descentRate;
+        if (autopilot_.targetVerticalSpeed != 0.0) {
+            climb = std::min(climb, std::abs(autopilot_.targetVerticalSpeed));
+            descent = std::min(2.0 * descent, std::abs(autopilot_.targetVerticalSpeed));
+        }
+        return std::clamp(rate, -descent, climb);
+    }
+
+    double pathAngle = controls_.elevator * MAX_FLIGHT_PATH_ANGLE * DEG_TO_RAD;
+    double rate = airspeed * FPM_PER_KNOT * std::tan(pathAngle);
+    return std::clamp(rate, descentLimit, std::max(climbLimit, descentLimit));
+}
+
+double PointMassFlightModel::commandedBank() const {
+    if (autopilot_.masterEnabled && autopilot_.headingHold) {
+        double error = wrap180(autopilot_.targetHeading - heading_);
+        return std::clamp(error * HEADING_GAIN, -MAX_AUTOPILOT_BANK, MAX_AUTOPILOT_BANK);
+    }
+    return controls_.aileron * MAX_BANK;
+}
+
+void PointMassFlightModel::step(double dt) {
+    if (dt <= 0.0) return;
+
+    // Fuel and engine
+    if (controls_.engineRunning) {
+        double power = std::clamp(commandedSpeed() / performance_.maxSpeed, 0.0, 1.0);
+        fuelQuantity_ -= performance_.fuelFlow * (0.25 + 0.75 * power) * dt / 3600.0;
+        if (fuelQuantity_ <= 0.0) {
+            fuelQuantity_ = 0.0;
+            controls_.engineRunning = false;
+        }
+    }
+
+    // Airspeed
+    double acceleration = std::clamp((commandedSpeed() - indicatedAirspeed_) / SPEED_TIME_CONSTANT,
+                                     -MAX_DECELERATION, MAX_ACCELERATION);
+    if (onGround_) {
+        double braking = std::max(controls_.brakes, controls_.parkingBrake ? 1.0 : 0.0);
+        acceleration -= braking * BRAKE_DECELERATION;
+    }
+    indicatedAirspeed_ = std::max(0.0, indicatedAirspeed_ + acceleration * dt);
+    double sigma = densityRatio(altitude_);
+    trueAirspeed_ = indicatedAirspeed_ / std::sqrt(sigma);
+
+    // Vertical
+    double rotateSpeed = performance_.vr;
+    double targetVerticalSpeed = commandedVerticalSpeed(trueAirspeed_);
+    if (onGround_) {
+        if (targetVerticalSpeed > 0.0 && indicatedAirspeed_ >= rotateSpeed) {
+            onGround_ = false;
+        } else {
+            verticalSpeed_ = 0.0;
+        }
+    }
+    if (!onGround_) {
+        verticalSpeed_ = approach(verticalSpeed_, targetVerticalSpeed, VERTICAL_ACCELERATION * dt);
+        altitude_ += verticalSpeed_ * dt / 60.0;
+        if (altitude_ <= groundElevation_ && verticalSpeed_ <= 0.0) {
+            altitude_ = groundElevation_;
+            verticalSpeed_ = 0.0;
+            onGround_ = true;
+        }
+    }
+    if (onGround_) {
+        altitude_ = groundElevation_;
+    }
+
+    // Lateral
+    if (onGround_) {
+        bank_ = 0.0;
+        double steering = std::min(1.0, indicatedAirspeed_ / 5.0);
+        heading_ = wrap360(heading_ + controls_.rudder * GROUND_TURN_RATE * steering * dt);
+    } else {
+        bank_ = approach(bank_, commandedBank(), ROLL_RATE * dt);
+        double turnRate = TURN_RATE_CONSTANT * std::tan(bank_ * DEG_TO_RAD) /
+                          std::max(trueAirspeed_, MIN_TURN_AIRSPEED);
+        heading_ = wrap360(heading_ + turnRate * dt);
+    }
+
+    // Flight path angle stands in for pitch attitude
+    pitch_ = onGround_ || trueAirspeed_ <= 0.0
+        ? 0.0
+        : std::atan2(verticalSpeed_, trueAirspeed_ * FPM_PER_KNOT) * RAD_TO_DEG;
+
+    // Ground track: air vector plus wind once airborne
+    double north = trueAirspeed_ * std::cos(heading_ * DEG_TO_RAD);
+    double east = trueAirspeed_ * std::sin(heading_ * DEG_TO_RAD);
+    if (!onGround_ && windSpeed_ > 0.0) {
+        double windTo = (windFromDegrees_ + 180.0) * DEG_TO_RAD;
+        north += windSpeed_ * std::cos(windTo);
+        east += windSpeed_ * std::sin(windTo);
+    }
+    groundSpeed_ = std::sqrt(north * north + east * east);
+    latitude_ += north * dt / 3600.0 / 60.0;
+    double cosLatitude = std::max(std::cos(latitude_ * DEG_TO_RAD), 1e-6);
+    longitude_ = wrap180(longitude_ + east * dt / 3600.0 / (60.0 * cosLatitude));
+
+    simTime_ += dt;
+}
+
+AircraftState PointMassFlightModel::getState() const {
+    AircraftState state{};
+    state.position = {latitude_, longitude_, altitude_, heading_};
+    state.indicatedAirspeed = indicatedAirspeed_;
+    state.trueAirspeed = trueAirspeed_;
+    state.groundSpeed = groundSpeed_;
+    state.verticalSpeed = verticalSpeed_;
+    state.pitch = pitch_;
+    state.bank = bank_;
+    state.heading = heading_;
+    state.altimeter = 29.92;
+    state.onGround = onGround_;
+    state.fuelQuantity = fuelQuantity_;
+    double power = controls_.engineRunning ? std::clamp(commandedSpeed() / performance_.maxSpeed, 0.0, 1.0) : 0.0;
+    state.engineRPM = controls_.engineRunning ? 600.0 + 2100.0 * power : 0.0;
+    state.parkingBrakeSet = controls_.parkingBrake;
+    state.gearDown = controls_.gearDown;
+    state.flapsPosition = controls_.flaps;
+    state.masterBattery = true;
+    state.masterAlternator = true;
+    // 24 V system: the bus sits at charging voltage while the engine turns
+    state.batteryVoltage = controls_.engineRunning ? 28.0 : 24.6;
+    state.batteryLoad = 15.0;
+    state.generatorVoltage = controls_.engineRunning ? 28.0 : 0.0;
+    state.generatorLoad = controls_.engineRunning ? 20.0 : 0.0;
+    return state;
+}
+
+// ============================================================================
+// HeadlessSimConnect Implementation
+// ============================================================================
+
+HeadlessSimConnect::HeadlessSimConnect(const HeadlessSimConfig& config)
+    : model_(config),
+      stepSeconds_(std::max(0.001, config.stepSeconds)) {
+    publish();
+}
+
+HeadlessSimConnect::~HeadlessSimConnect() {
+    stopRecording();
+}
+
+bool HeadlessSimConnect::connect(SimulatorType, const std::string&) {
+    connected_ = true;
+    return true;
+}
+
+void HeadlessSimConnect::disconnect() {
+    stopRecording();
+    connected_ = false;
+}
+
+bool HeadlessSimConnect::connectReplay(const std::string&, ReplayPacing) {
+    AICOPILOT_LOG_WARNING("Headless sim cannot replay a capture - use SimConnectWrapper");
+    return false;
+}
+
+void HeadlessSimConnect::setReplayStep(double seconds) {
+    stepSeconds_ = std::max(0.001, seconds);
+}
+
+bool HeadlessSimConnect::startRecording(const std::string& capturePath) {
+    if (!recorder_.open(capturePath)) {
+        return false;
+    }
+    // Every tier goes out on the first step, as a full baseline
+    recordBuffer_.resize(sizeof(SimConnectObjectDataHeader) +
+                         std::max({sizeof(SimConnectFlightData), sizeof(SimConnectSystemsData),
+                                   sizeof(SimConnectEngineData), sizeof(SimConnectAutopilotState)}));
+    recordStep();
+    return recorder_.isOpen();
+}
+
+void HeadlessSimConnect::stopRecording() {
+    if (!recorder_.isOpen()) return;
+    AICOPILOT_LOG_INFO("Headless recording stopped: {} messages", recorder_.getRecordCount());
+    recorder_.close();
+}
+
+void HeadlessSimConnect::processMessages() {
+    if (!connected_) return;
+
+    model_.step(stepSeconds_);
+    stepCount_++;
+    publish();
+    if (recorder_.isOpen()) {
+        recordStep();
+    }
+    if (stateCallback_) {
+        stateCallback_(model_.getState());
+    }
+}
+
+void HeadlessSimConnect::publish() {
+    stateStore_.publish(model_.getState());
+    autopilotSnapshot_.store(model_.autopilot());
+}
+
+template <typename T>
+void HeadlessSimConnect::recordTier(uint32_t requestId, const T& data) {
+    SimConnectObjectDataHeader header{};
+    header.size = static_cast<uint32_t>(sizeof(header) + sizeof(T));
+    header.id = SimConnectCaptureFormat::RECV_ID_SIMOBJECT_DATA;
+    header.requestId = requestId;
+    header.objectId = 1;            // the user aircraft
+    header.defineId = requestId;    // each tier's definition shares its request's ID
+    header.entryNumber = 1;
+    header.outOf = 1;
+    header.defineCount = 1;
+    std::memcpy(recordBuffer_.data(), &header, sizeof(header));
+    std::memcpy(recordBuffer_.data() + sizeof(header), &data, sizeof(T));
+
+    uint64_t timestampUs = static_cast<uint64_t>(std::llround(model_.getSimTime() * 1e6));
+    if (!recorder_.write(timestampUs, recordBuffer_.data(), header.size)) {
+        AICOPILOT_LOG_ERROR("Headless recording failed after {} messages", recorder_.getRecordCount());
+        recorder_.close();
+    }
+}
+
+void HeadlessSimConnect::recordStep() {
+    AircraftState state = model_.getState();
+    const AutopilotState& autopilot = model_.autopilot();
+
+    SimConnectFlightData flight{};
+    flight.latitude = state.position.latitude;
+    flight.longitude = state.position.longitude;
+    flight.altitude = state.position.altitude;
+    flight.heading = state.heading;
+    flight.pitch = state.pitch;
+    flight.bank = state.bank;
+    flight.indicatedAirspeed = state.indicatedAirspeed;
+    flight.trueAirspeed = state.trueAirspeed;
+    flight.groundSpeed = state.groundSpeed;
+    flight.verticalSpeed = state.verticalSpeed;
+    flight.onGround = state.onGround ? 1 : 0;
+    recordTier(SimConnectCaptureFormat::REQUEST_FLIGHT_DYNAMICS, flight);
+
+    if (stepCount_ % SYSTEMS_INTERVAL_STEPS == 0) {
+        SimConnectSystemsData systems{};
+        systems.altimeter = state.altimeter;
+        systems.parkingBrakeSet = state.parkingBrakeSet ? 1 : 0;
+        systems.gearDown = state.gearDown ? 1 : 0;
+        systems.flapsPosition = state.flapsPosition;
+        systems.masterBattery = state.masterBattery ? 1 : 0;
+        systems.masterAlternator = state.masterAlternator ? 1 : 0;
+        systems.batteryVoltage = state.batteryVoltage;
+        systems.batteryLoad = state.batteryLoad;
+        systems.generatorVoltage = state.generatorVoltage;
+        systems.generatorLoad = state.generatorLoad;
+        if (recorder_.isOpen()) recordTier(SimConnectCaptureFormat::REQUEST_SYSTEMS_STATE, systems);
+
+        SimConnectAutopilotState ap{};
+        ap.masterEnabled = autopilot.masterEnabled ? 1 : 0;
+        ap.headingHold = autopilot.headingHold ? 1 : 0;
+        ap.altitudeHold = autopilot.altitudeHold ? 1 : 0;
+        ap.airspeedHold = autopilot.speedHold ? 1 : 0;
+        ap.navMode = autopilot.navMode ? 1 : 0;
+        ap.approachMode = autopilot.approachMode ? 1 : 0;
+        ap.autoThrottle = autopilot.autoThrottle ? 1 : 0;
+        ap.verticalSpeedHold = autopilot.verticalSpeedHold ? 1 : 0;
+        ap.targetHeading = autopilot.targetHeading;
+        ap.targetAltitude = autopilot.targetAltitude;
+        ap.targetAirspeed = autopilot.targetSpeed;
+        ap.targetVerticalSpeed = autopilot.targetVerticalSpeed;
+        if (recorder_.isOpen()) recordTier(SimConnectCaptureFormat::REQUEST_AUTOPILOT_STATE, ap);
+    }
+
+    if (stepCount_ % ENGINE_INTERVAL_STEPS == 0 && recorder_.isOpen()) {
+        SimConnectEngineData engine{};
+        engine.fuelQuantity = state.fuelQuantity;
+        engine.engineRPM = state.engineRPM;
+        recordTier(SimConnectCaptureFormat::REQUEST_ENGINE_STATE, engine);
+    }
+}
+
+size_t HeadlessSimConnect::getTrafficTable(TrafficTable& out) const {
+    out.clear();
+    return 0;
+}
+
+// Autopilot: the master engages heading, altitude and speed hold together
+void HeadlessSimConnect::setAutopilotMaster(bool enabled) {
+    AutopilotState& autopilot = model_.autopilot();
+    autopilot.masterEnabled = enabled;
+    autopilot.headingHold = enabled;
+    autopilot.altitudeHold = enabled;
+    autopilot.speedHold = enabled;
+    autopilot.autoThrottle = enabled;
+    autopilotSnapshot_.store(autopilot);
+}
+
+void HeadlessSimConnect::setAutopilotHeading(double heading) {
+    model_.autopilot().targetHeading = std::fmod(std::fmod(heading, 360.0) + 360.0, 360.0);
+    autopilotSnapshot_.store(model_.autopilot());
+}
+
+void HeadlessSimConnect::setAutopilotAltitude(double altitude) {
+    model_.autopilot().targetAltitude = altitude;
+    autopilotSnapshot_.store(model_.autopilot());
+}
+
+void HeadlessSimConnect::setAutopilotSpeed(double speed) {
+    model_.autopilot().targetSpeed = std::max(0.0, speed);
+    autopilotSnapshot_.store(model_.autopilot());
+}
+
+void HeadlessSimConnect::setAutopilotVerticalSpeed(double verticalSpeed) {
+    model_.autopilot().targetVerticalSpeed = verticalSpeed;
+    autopilotSnapshot_.store(model_.autopilot());
+}
+
+void HeadlessSimConnect::setAutopilotNav(bool enabled) {
+    model_.autopilot().navMode = enabled;
+    autopilotSnapshot_.store(model_.autopilot());
+}
+
+void HeadlessSimConnect::setAutopilotApproach(bool enabled) {
+    model_.autopilot().approachMode = enabled;
+    autopilotSnapshot_.store(model_.autopilot());
+}
+
+void HeadlessSimConnect::setThrottle(double value) {
+    model_.controls().throttle = std::clamp(value, 0.0, 1.0);
+}
+
+void HeadlessSimConnect::setElevator(double value) {
+    model_.controls().elevator = std::clamp(value, -1.0, 1.0);
+}
+
+void HeadlessSimConnect::setAileron(double value) {
+    model_.controls().aileron = std::clamp(value, -1.0, 1.0);
+}
+
+void HeadlessSimConnect::setRudder(double value) {
+    model_.controls().rudder = std::clamp(value, -1.0, 1.0);
+}
+
+void HeadlessSimConnect::setFlaps(int position) {
+    model_.controls().flaps = std::clamp(position, 0, 100);
+}
+
+void HeadlessSimConnect::setGear(bool down) {
+    model_.controls().gearDown = down;
+}
+
+void HeadlessSimConnect::setSpoilers(bool deployed) {
+    model_.controls().spoilers = deployed;
+}
+
+void HeadlessSimConnect::setParkingBrake(bool set) {
+    model_.controls().parkingBrake = set;
+}
+
+void HeadlessSimConnect::setBrakes(double value) {
+    model_.controls().brakes = std::clamp(value, 0.0, 1.0);
+}
+
+// One engine stands in for all of them
+void HeadlessSimConnect::toggleEngineStarter(int) {
+    if (model_.getState().fuelQuantity > 0.0) {
+        model_.controls().engineRunning = true;
+    }
+}
+
+void HeadlessSimConnect::setEngineState(int, bool running) {
+    if (running) {
+        toggleEngineStarter(0);
+    } else {
+        model_.controls().engineRunning = false;
+    }
+}
+
+} // namespace AICopilot
@@ -0,0 +1,125 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* SimConnect API Implementation
+* Linked and runtime-loaded SimConnect clients, one table per SDK
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/simconnect_api.hpp"
+#include "../include/binary_log.hpp"
+#include <mutex>
+
+namespace AICopilot {
+
+#ifdef AICOPILOT_HAVE_SIMCONNECT
+
+namespace {
+
+#if !defined(AICOPILOT_MSFS_SIMCONNECT_DLL) || !defined(AICOPILOT_P3D_SIMCONNECT_DLL)
+void bindLinkedClient(SimConnectApi& api) {
+    api.Open = &::SimConnect_Open;
+    api.Close = &::SimConnect_Close;
+    api.CallDispatch = &::SimConnect_CallDispatch;
+    api.AddToDataDefinition = &::SimConnect_AddToDataDefinition;
+    api.RequestDataOnSimObject = &::SimConnect_RequestDataOnSimObject;
+    api.RequestDataOnSimObjectType = &::SimConnect_RequestDataOnSimObjectType;
+    api.SetDataOnSimObject = &::SimConnect_SetDataOnSimObject;
+    api.MapClientEventToSimEvent = &::SimConnect_MapClientEventToSimEvent;
+    api.TransmitClientEvent = &::SimConnect_TransmitClientEvent;
+    api.SubscribeToSystemEvent = &::SimConnect_SubscribeToSystemEvent;
+    api.MapClientDataNameToID = &::SimConnect_MapClientDataNameToID;
+    api.AddToClientDataDefinition = &::SimConnect_AddToClientDataDefinition;
+    api.RequestClientData = &::SimConnect_RequestClientData;
+}
+#endif
+
+#if defined(AICOPILOT_MSFS_SIMCONNECT_DLL) || defined(AICOPILOT_P3D_SIMCONNECT_DLL)
+template <typename Fn>
+bool resolveEntry(HMODULE module, const char* name, Fn& fn) {
+    fn = reinterpret_cast<Fn>(GetProcAddress(module, name));
+    return fn != nullptr;
+}
+
+// The module stays loaded for the life of the process; sessions on other
+// threads may hold its entry points at any time
+bool loadClient(const char* dllPath, SimConnectApi& api) {
+    // Resolve the DLL's own dependencies from its directory, not ours
+    HMODULE module = LoadLibraryExA(dllPath, nullptr, LOAD_WITH_ALTERED_SEARCH_PATH);
+    if (module == nullptr) {
+        AICOPILOT_LOG_ERROR("Failed to load SimConnect client {} (error {})", dllPath, GetLastError());
+        return false;
+    }
+
+    bool resolved =
+        resolveEntry(module, "SimConnect_Open", api.Open) &&
+        resolveEntry(module, "SimConnect_Close", api.Close) &&
+        resolveEntry(module, "SimConnect_CallDispatch", api.CallDispatch) &&
+        resolveEntry(module, "SimConnect_AddToDataDefinition", api.AddToDataDefinition) &&
+        resolveEntry(module, "SimConnect_RequestDataOnSimObject", api.RequestDataOnSimObject) &&
+        resolveEntry(module, "SimConnect_RequestDataOnSimObjectType", api.RequestDataOnSimObjectType) &&
+        resolveEntry(module, "SimConnect_SetDataOnSimObject", api.SetDataOnSimObject) &&
+        resolveEntry(module, "SimConnect_MapClientEventToSimEvent", api.MapClientEventToSimEvent) &&
+        resolveEntry(module, "SimConnect_TransmitClientEvent", api.TransmitClientEvent) &&
+        resolveEntry(module, "SimConnect_SubscribeToSystemEvent", api.SubscribeToSystemEvent) &&
+        resolveEntry(module, "SimConnect_MapClientDataNameToID", api.MapClientDataNameToID) &&
+        resolveEntry(module, "SimConnect_AddToClientDataDefinition", api.AddToClientDataDefinition) &&
+        resolveEntry(module, "SimConnect_RequestClientData", api.RequestClientData);
+    if (!resolved) {
+        AICOPILOT_LOG_ERROR("SimConnect client {} is missing entry points", dllPath);
+        FreeLibrary(module);
+        return false;
+    }
+
+    api.loaded = true;
+    AICOPILOT_LOG_INFO("Loaded {} SimConnect client from {}", simConnectSdkName(api.sdk), dllPath);
+    return true;
+}
+#endif
+
+struct ClientSlot {
+    std::once_flag once;
+    SimConnectApi api;
+    bool available = false;
+};
+
+void bindClient(SimConnectSdk sdk, ClientSlot& slot) {
+    slot.api.sdk = sdk;
+    const char* dllPath = nullptr;
+#ifdef AICOPILOT_MSFS_SIMCONNECT_DLL
+    if (sdk == SimConnectSdk::MSFS) dllPath = AICOPILOT_MSFS_SIMCONNECT_DLL;
+#endif
+#ifdef AICOPILOT_P3D_SIMCONNECT_DLL
+    if (sdk == SimConnectSdk::P3D) dllPath = AICOPILOT_P3D_SIMCONNECT_DLL;
+#endif
+
+    if (dllPath != nullptr) {
+#if defined(AICOPILOT_MSFS_SIMCONNECT_DLL) || defined(AICOPILOT_P3D_SIMCONNECT_DLL)
+        slot.available = loadClient(dllPath, slot.api);
+#endif
+        return;
+    }
+#if !defined(AICOPILOT_MSFS_SIMCONNECT_DLL) || !defined(AICOPILOT_P3D_SIMCONNECT_DLL)
+    bindLinkedClient(slot.api);
+    slot.available = true;
+#endif
+}
+
+} // namespace
+
+const SimConnectApi* getSimConnectApi(SimulatorType simType) {
+    static ClientSlot slots[2];
+
+    SimConnectSdk sdk = simConnectSdkFor(simType);
+    ClientSlot& slot = slots[sdk == SimConnectSdk::P3D ? 1 : 0];
+    std::call_once(slot.once, [sdk, &slot] { bindClient(sdk, slot); });
+    return slot.available ? &slot.api : nullptr;
+}
+
+#endif // AICOPILOT_HAVE_SIMCONNECT
+
+} // namespace AICopilot
@@ -0,0 +1,142 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* SimConnect Recording Implementation
+* Capture file writer and reader for offline replay
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/simconnect_recording.hpp"
+#include <cstring>
+#include <iostream>
+
+namespace AICopilot {
+
+// ============================================================================
+// SimConnectRecorder Implementation
+// ============================================================================
+
+bool SimConnectRecorder::open(const std::string& path) {
+    close();
+
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        std::cerr << "Failed to open capture file for writing: " << path << std::endl;
+        return false;
+    }
+
+    uint32_t version = SimConnectCaptureFormat::CAPTURE_VERSION;
+    uint32_t reserved = 0;
+    file_.write(SimConnectCaptureFormat::MAGIC, sizeof(SimConnectCaptureFormat::MAGIC));
+    file_.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file_.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+
+    recordCount_ = 0;
+    return file_.good();
+}
+
+void SimConnectRecorder::close() {
+    if (file_.is_open()) {
+        file_.flush();
+        file_.close();
+    }
+}
+
+bool SimConnectRecorder::write(uint64_t timestampUs, const void* data, uint32_t size) {
+    if (!file_.is_open()) return false;
+
+    file_.write(reinterpret_cast<const char*>(&timestampUs), sizeof(timestampUs));
+    file_.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file_.write(static_cast<const char*>(data), size);
+
+    if (!file_.good()) {
+        std::cerr << "Capture write failed after " << recordCount_ << " records" << std::endl;
+        file_.close();
+        return false;
+    }
+
+    recordCount_++;
+    return true;
+}
+
+// ============================================================================
+// SimConnectCaptureReader Implementation
+// ============================================================================
+
+bool SimConnectCaptureReader::open(const std::string& path) {
+    close();
+
+    file_.open(path, std::ios::binary);
+    if (!file_.is_open()) {
+        std::cerr << "Failed to open capture file: " << path << std::endl;
+        return false;
+    }
+
+    char magic[sizeof(SimConnectCaptureFormat::MAGIC)] = {};
+    uint32_t version = 0;
+    uint32_t reserved = 0;
+    file_.read(magic, sizeof(magic));
+    file_.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file_.read(reinterpret_cast<char*>(&reserved), sizeof(reserved));
+
+    if (!file_.good() || std::memcmp(magic, SimConnectCaptureFormat::MAGIC, sizeof(magic)) != 0) {
+        std::cerr << "Not a SimConnect capture file: " << path << std::endl;
+        close();
+        return false;
+    }
+
+    if (version != SimConnectCaptureFormat::CAPTURE_VERSION) {
+        std::cerr << "Unsupported capture version " << version << ": " << path << std::endl;
+        close();
+        return false;
+    }
+
+    recordCount_ = 0;
+    next();
+    return true;
+}
+
+void SimConnectCaptureReader::close() {
+    if (file_.is_open()) {
+        file_.close();
+    }
+    hasRecord_ = false;
+    size_ = 0;
+}
+
+bool SimConnectCaptureReader::next() {
+    hasRecord_ = false;
+    if (!file_.is_open()) return false;
+
+    uint64_t timestampUs = 0;
+    uint32_t size = 0;
+    file_.read(reinterpret_cast<char*>(&timestampUs), sizeof(timestampUs));
+    file_.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (!file_.good()) return false;  // clean end of file
+
+    if (size > SimConnectCaptureFormat::MAX_RECORD_SIZE) {
+        std::cerr << "Corrupt capture record " << recordCount_ << " (size " << size << ")" << std::endl;
+        return false;
+    }
+
+    if (buffer_.size() < size) {
+        buffer_.resize(size);
+    }
+    file_.read(reinterpret_cast<char*>(buffer_.data()), size);
+    if (static_cast<uint32_t>(file_.gcount()) != size) {
+        std::cerr << "Truncated capture record " << recordCount_ << std::endl;
+        return false;
+    }
+
+    timestampUs_ = timestampUs;
+    size_ = size;
+    recordCount_++;
+    hasRecord_ = true;
+    return true;
+}
+
+} // namespace AICopilot
@@ -43,6 +43,9 @@
 * - Define USE_MSFS_2024 for MSFS 2024 SDK
 * - Define USE_P3D_V6 for Prepar3D v6 SDK
 * - Link against SimConnect.lib
+* - SUPPORT_BOTH_SDKS links the P3D client and loads the MSFS client DLL
+*   at runtime (see simconnect_api.hpp), so sessions to both sims can be
+*   open at once
 *
 * USAGE:
 *   SimConnectWrapper sim;
@@ -60,9 +63,23 @@
 *****************************************************************************/
 
 #include "../include/simconnect_wrapper.h"
-#include <iostream>
+#include "../include/state_snapshot.hpp"
+#include "../include/aircraft_state_core.hpp"
+#include "../include/control_command_buffer.hpp"
+#include "../include/simconnect_recording.hpp"
+#include "../include/binary_log.hpp"
+#include "../include/reconnect_backoff.hpp"
+#include "../include/simconnect_api.hpp"
+#ifdef _WIN32
 #include <windows.h>
+#endif
 #include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
 
 // Rely on CMake include directories to resolve SimConnect.h for the selected SDK
 // This avoids hard-coded absolute paths and mismatched macros.
@@ -78,15 +95,42 @@ namespace AICopilot {
 // Stub implementation (no SimConnect)
 // =========================
 
+class SimConnectWrapper::Impl {};
+
 SimConnectWrapper::SimConnectWrapper() : pImpl(nullptr) {}
 SimConnectWrapper::~SimConnectWrapper() {}
 bool SimConnectWrapper::connect(SimulatorType, const std::string&) { return false; }
 void SimConnectWrapper::disconnect() {}
 bool SimConnectWrapper::isConnected() const { return false; }
+bool SimConnectWrapper::connectReplay(const std::string&, ReplayPacing) { return false; }
+bool SimConnectWrapper::isReplaying() const { return false; }
+void SimConnectWrapper::setReplayStep(double) {}
+double SimConnectWrapper::getReplayTime() const { return 0.0; }
+bool SimConnectWrapper::startRecording(const std::string&) { return false; }
+void SimConnectWrapper::stopRecording() {}
+bool SimConnectWrapper::isRecording() const { return false; }
 void SimConnectWrapper::processMessages() {}
+bool SimConnectWrapper::startDispatchThread() { return false; }
+void SimConnectWrapper::stopDispatchThread() {}
+bool SimConnectWrapper::isDispatchThreadRunning() const { return false; }
+void SimConnectWrapper::setAutoReconnect(bool) {}
+bool SimConnectWrapper::isReconnecting() const { return false; }
+uint32_t SimConnectWrapper::getReconnectCount() const { return 0; }
+void SimConnectWrapper::setConfigIndex(int) {}
+int SimConnectWrapper::getConfigIndex() const { return 0; }
+void SimConnectWrapper::setDataSubscription(const DataSubscriptionConfig&) {}
+DataSubscriptionConfig SimConnectWrapper::getDataSubscription() const { return {}; }
+size_t SimConnectWrapper::getTrafficTable(TrafficTable& out) const { out.clear(); return 0; }
+void SimConnectWrapper::setCommandBatching(bool) {}
+bool SimConnectWrapper::isCommandBatchingEnabled() const { return false; }
+void SimConnectWrapper::flushCommands() {}
 AircraftState SimConnectWrapper::getAircraftState() { return {}; }
 AutopilotState SimConnectWrapper::getAutopilotState() { return {}; }
 Position SimConnectWrapper::getPosition() { return {}; }
+AircraftStateCore SimConnectWrapper::getAircraftStateCore(uint64_t& version) { version = 0; return {}; }
+AircraftStateCold SimConnectWrapper::getAircraftStateCold(uint64_t& version) { version = 0; return {}; }
+uint64_t SimConnectWrapper::getStateVersion() const { return 0; }
+uint64_t SimConnectWrapper::getColdStateVersion() const { return 0; }
 void SimConnectWrapper::setAutopilotMaster(bool) {}
 void SimConnectWrapper::setAutopilotHeading(double) {}
 void SimConnectWrapper::setAutopilotAltitude(double) {}
@@ -114,26 +158,44 @@ void SimConnectWrapper::requestATCMenu() {}
 std::vector<std::string> SimConnectWrapper::getATCMenuOptions() { return {}; }
 void SimConnectWrapper::subscribeToAircraftState(StateCallback) {}
 void SimConnectWrapper::subscribeToATCMessages(ATCCallback) {}
+void SimConnectWrapper::subscribeToATCText(ATCTextCallback) {}
 
 #else // AICOPILOT_HAVE_SIMCONNECT
 
 // SimConnect Data Definitions
+// Aircraft state is split into rate tiers so slow-changing values are not
+// shipped every sim frame
 enum DATA_DEFINITIONS {
-    DEFINITION_AIRCRAFT_STATE,
+    DEFINITION_FLIGHT_DYNAMICS,   // per-frame attitude, speeds, position
+    DEFINITION_SYSTEMS_STATE,     // ~4 Hz gear, flaps, brakes, electrical
     DEFINITION_AUTOPILOT_STATE,
     DEFINITION_POSITION,
     DEFINITION_ENGINE_STATE,
-    DEFINITION_CONTROLS_STATE
+    DEFINITION_CONTROLS_STATE,    // batched control/autopilot targets (write-only)
+    DEFINITION_TRAFFIC_STATE,     // AI/multiplayer objects, radius sweep
+    DEFINITION_ATC_TEXT           // client data: ATC text bridge
 };
 
 // SimConnect Request IDs
 enum DATA_REQUEST_ID {
-    REQUEST_AIRCRAFT_STATE,
+    REQUEST_FLIGHT_DYNAMICS,
+    REQUEST_SYSTEMS_STATE,
     REQUEST_AUTOPILOT_STATE,
     REQUEST_POSITION,
-    REQUEST_ENGINE_STATE
+    REQUEST_ENGINE_STATE,
+    REQUEST_TRAFFIC_AIRCRAFT,
+    REQUEST_TRAFFIC_HELICOPTER,
+    REQUEST_ATC_TEXT
+};
+
+// SimConnect Client Data IDs
+enum CLIENT_DATA_ID {
+    CLIENT_DATA_ATC_TEXT
 };
 
+// Client data area an in-sim ATC bridge gauge/module writes transmissions to
+static const char* const ATC_TEXT_CLIENT_DATA_NAME = "AICopilot.ATCText";
+
 // SimConnect Event IDs
 enum EVENT_ID {
     EVENT_AUTOPILOT_MASTER,
@@ -206,64 +268,273 @@ enum EVENT_ID {
     EVENT_PAUSE
 };
 
+// State tier layouts (SimConnectFlightData and friends) live in
+// simconnect_recording.hpp so synthesized captures decode like live data
+static_assert(SimConnectCaptureFormat::RECV_ID_SIMOBJECT_DATA == SIMCONNECT_RECV_ID_SIMOBJECT_DATA,
+              "capture record ID");
+static_assert(SimConnectCaptureFormat::REQUEST_FLIGHT_DYNAMICS == REQUEST_FLIGHT_DYNAMICS &&
+              SimConnectCaptureFormat::REQUEST_SYSTEMS_STATE == REQUEST_SYSTEMS_STATE &&
+              SimConnectCaptureFormat::REQUEST_AUTOPILOT_STATE == REQUEST_AUTOPILOT_STATE &&
+              SimConnectCaptureFormat::REQUEST_ENGINE_STATE == REQUEST_ENGINE_STATE,
+              "capture request IDs");
+static_assert(offsetof(SIMCONNECT_RECV_SIMOBJECT_DATA, dwData) == sizeof(SimConnectObjectDataHeader),
+              "capture object data header");
+
 // SimConnect data structures matching the simulator's data layout
 #pragma pack(push, 1)
-struct SimConnectAircraftState {
+
+// ATC text bridge payload: one transmission per client data update
+struct ATCTextClientData {
+    DWORD messageType;                      // ATCMessageType
+    DWORD length;                           // bytes used in text
+    char text[ATCTextRing::SLOT_CAPACITY];  // "message\0option1\0option2\0..."
+};
+
+struct SimConnectTrafficData {
+    char atcId[32];
     double latitude;
     double longitude;
     double altitude;
-    double heading;
-    double pitch;
-    double bank;
-    double indicatedAirspeed;
-    double trueAirspeed;
     double groundSpeed;
+    double heading;
     double verticalSpeed;
-    double altimeter;
-    double fuelQuantity;
-    double engineRPM;
     DWORD onGround;
-    DWORD parkingBrakeSet;
-    DWORD gearDown;
-    double flapsPosition;
-    
-    // Electrical system data
-    DWORD masterBattery;
-    DWORD masterAlternator;
-    double batteryVoltage;
-    double batteryLoad;
-    double generatorVoltage;
-    double generatorLoad;
+};
+#pragma pack(pop)
+
+// SimVar layout descriptor: one entry per datum, in struct order.
+// The table index doubles as the datum ID used for tagged delivery.
+struct SimVarField {
+    const char* name;
+    const char* unit;
+    SIMCONNECT_DATATYPE type;
+    size_t offset;
+    size_t size;
+};
+
+#define SIMVAR_FIELD(Struct, member, name, unit, type) \
+    { name, unit, type, offsetof(Struct, member), sizeof(Struct::member) }
+
+static const SimVarField FLIGHT_DYNAMICS_FIELDS[] = {
+    SIMVAR_FIELD(SimConnectFlightData, latitude, "PLANE LATITUDE", "degrees", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectFlightData, longitude, "PLANE LONGITUDE", "degrees", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectFlightData, altitude, "PLANE ALTITUDE", "feet", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectFlightData, heading, "PLANE HEADING DEGREES TRUE", "degrees", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectFlightData, pitch, "PLANE PITCH DEGREES", "degrees", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectFlightData, bank, "PLANE BANK DEGREES", "degrees", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectFlightData, indicatedAirspeed, "AIRSPEED INDICATED", "knots", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectFlightData, trueAirspeed, "AIRSPEED TRUE", "knots", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectFlightData, groundSpeed, "GROUND VELOCITY", "knots", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectFlightData, verticalSpeed, "VERTICAL SPEED", "feet per minute", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectFlightData, onGround, "SIM ON GROUND", "bool", SIMCONNECT_DATATYPE_INT32),
 };
 
-struct SimConnectAutopilotState {
-    DWORD masterEnabled;
-    DWORD headingHold;
-    DWORD altitudeHold;
-    DWORD airspeedHold;
-    DWORD navMode;
-    DWORD approachMode;
-    DWORD autoThrottle;
-    DWORD verticalSpeedHold;
-    double targetHeading;
-    double targetAltitude;
-    double targetAirspeed;
-    double targetVerticalSpeed;
+static const SimVarField SYSTEMS_STATE_FIELDS[] = {
+    SIMVAR_FIELD(SimConnectSystemsData, altimeter, "KOHLSMAN SETTING HG", "inHg", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectSystemsData, parkingBrakeSet, "BRAKE PARKING POSITION", "bool", SIMCONNECT_DATATYPE_INT32),
+    SIMVAR_FIELD(SimConnectSystemsData, gearDown, "GEAR HANDLE POSITION", "bool", SIMCONNECT_DATATYPE_INT32),
+    SIMVAR_FIELD(SimConnectSystemsData, flapsPosition, "FLAPS HANDLE PERCENT", "percent", SIMCONNECT_DATATYPE_FLOAT64),
+    // Electrical system data (canonical names)
+    SIMVAR_FIELD(SimConnectSystemsData, masterBattery, "ELECTRICAL MASTER BATTERY", "bool", SIMCONNECT_DATATYPE_INT32),
+    SIMVAR_FIELD(SimConnectSystemsData, masterAlternator, "GENERAL ENG MASTER ALTERNATOR:1", "bool", SIMCONNECT_DATATYPE_INT32),
+    SIMVAR_FIELD(SimConnectSystemsData, batteryVoltage, "ELECTRICAL MAIN BUS VOLTAGE", "volts", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectSystemsData, batteryLoad, "ELECTRICAL MAIN BUS AMPS", "amperes", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectSystemsData, generatorVoltage, "ELECTRICAL GENALT BUS VOLTAGE:1", "volts", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectSystemsData, generatorLoad, "GENERAL ENG GENERATOR AMPS:1", "amperes", SIMCONNECT_DATATYPE_FLOAT64),
+};
+
+static const SimVarField ENGINE_STATE_FIELDS[] = {
+    SIMVAR_FIELD(SimConnectEngineData, fuelQuantity, "FUEL TOTAL QUANTITY", "gallons", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectEngineData, engineRPM, "GENERAL ENG RPM:1", "rpm", SIMCONNECT_DATATYPE_FLOAT64),
+};
+
+// Normalized to canonical uppercase SimVar names (best-effort)
+static const SimVarField AUTOPILOT_STATE_FIELDS[] = {
+    SIMVAR_FIELD(SimConnectAutopilotState, masterEnabled, "AUTOPILOT MASTER", "bool", SIMCONNECT_DATATYPE_INT32),
+    SIMVAR_FIELD(SimConnectAutopilotState, headingHold, "AUTOPILOT HEADING LOCK", "bool", SIMCONNECT_DATATYPE_INT32),
+    SIMVAR_FIELD(SimConnectAutopilotState, altitudeHold, "AUTOPILOT ALTITUDE LOCK", "bool", SIMCONNECT_DATATYPE_INT32),
+    SIMVAR_FIELD(SimConnectAutopilotState, airspeedHold, "AUTOPILOT AIRSPEED HOLD", "bool", SIMCONNECT_DATATYPE_INT32),
+    SIMVAR_FIELD(SimConnectAutopilotState, navMode, "AUTOPILOT NAV1 LOCK", "bool", SIMCONNECT_DATATYPE_INT32),
+    SIMVAR_FIELD(SimConnectAutopilotState, approachMode, "AUTOPILOT APPROACH HOLD", "bool", SIMCONNECT_DATATYPE_INT32),
+    SIMVAR_FIELD(SimConnectAutopilotState, autoThrottle, "AUTOPILOT THROTTLE ARM", "bool", SIMCONNECT_DATATYPE_INT32),
+    SIMVAR_FIELD(SimConnectAutopilotState, verticalSpeedHold, "AUTOPILOT VERTICAL HOLD", "bool", SIMCONNECT_DATATYPE_INT32),
+    SIMVAR_FIELD(SimConnectAutopilotState, targetHeading, "AUTOPILOT HEADING LOCK DIR", "degrees", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectAutopilotState, targetAltitude, "AUTOPILOT ALTITUDE LOCK VAR", "feet", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectAutopilotState, targetAirspeed, "AUTOPILOT AIRSPEED HOLD VAR", "knots", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectAutopilotState, targetVerticalSpeed, "AUTOPILOT VERTICAL HOLD VAR", "feet per minute", SIMCONNECT_DATATYPE_FLOAT64),
+};
+
+static const SimVarField TRAFFIC_STATE_FIELDS[] = {
+    SIMVAR_FIELD(SimConnectTrafficData, atcId, "ATC ID", nullptr, SIMCONNECT_DATATYPE_STRING32),
+    SIMVAR_FIELD(SimConnectTrafficData, latitude, "PLANE LATITUDE", "degrees", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectTrafficData, longitude, "PLANE LONGITUDE", "degrees", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectTrafficData, altitude, "PLANE ALTITUDE", "feet", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectTrafficData, groundSpeed, "GROUND VELOCITY", "knots", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectTrafficData, heading, "PLANE HEADING DEGREES TRUE", "degrees", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectTrafficData, verticalSpeed, "VERTICAL SPEED", "feet per minute", SIMCONNECT_DATATYPE_FLOAT64),
+    SIMVAR_FIELD(SimConnectTrafficData, onGround, "SIM ON GROUND", "bool", SIMCONNECT_DATATYPE_INT32),
+};
+
+#undef SIMVAR_FIELD
+
+// Settable SimVars for batched control output, indexed by ControlChannel.
+// Offsets are unused: values are written as tagged { datumId, FLOAT64 } pairs.
+static const SimVarField CONTROL_FIELDS[] = {
+    { "GENERAL ENG THROTTLE LEVER POSITION:1", "percent", SIMCONNECT_DATATYPE_FLOAT64, 0, sizeof(double) },
+    { "YOKE Y POSITION", "position", SIMCONNECT_DATATYPE_FLOAT64, 0, sizeof(double) },
+    { "YOKE X POSITION", "position", SIMCONNECT_DATATYPE_FLOAT64, 0, sizeof(double) },
+    { "RUDDER PEDAL POSITION", "position", SIMCONNECT_DATATYPE_FLOAT64, 0, sizeof(double) },
+    { "AUTOPILOT HEADING LOCK DIR", "degrees", SIMCONNECT_DATATYPE_FLOAT64, 0, sizeof(double) },
+    { "AUTOPILOT ALTITUDE LOCK VAR", "feet", SIMCONNECT_DATATYPE_FLOAT64, 0, sizeof(double) },
+    { "AUTOPILOT AIRSPEED HOLD VAR", "knots", SIMCONNECT_DATATYPE_FLOAT64, 0, sizeof(double) },
+    { "AUTOPILOT VERTICAL HOLD VAR", "feet per minute", SIMCONNECT_DATATYPE_FLOAT64, 0, sizeof(double) },
+};
+
+#pragma pack(push, 1)
+struct TaggedControlDatum {
+    DWORD datumId;
+    double value;
 };
 #pragma pack(pop)
 
+template<size_t N>
+static constexpr size_t fieldCount(const SimVarField (&)[N]) { return N; }
+
 class SimConnectWrapper::Impl {
 public:
     HANDLE hSimConnect = nullptr;
-    bool connected = false;
+    std::atomic<bool> connected{false};
     SimulatorType simType = SimulatorType::UNKNOWN;
-    AircraftState currentState;
-    AutopilotState autopilotState;
+    
+    // Client of simType's SDK, bound at connect(); other sessions in the
+    // process may be on the other SDK
+    const SimConnectApi* api = nullptr;
+    int configIndex = 0;   // SimConnect.cfg entry (0: local sim)
+    AircraftState currentState{};
+    AutopilotState autopilotState{};
     StateCallback stateCallback;
     ATCCallback atcCallback;
+    ATCTextCallback atcTextCallback;
+    std::mutex callbackMutex;  // subscribers may register after dispatch starts
+    
+    // Subscription-only delivery: getters never issue their own requests
+    DataSubscriptionConfig subscription;
+    
+    // Last raw payload per tier; tagged deliveries only carry changed datums
+    SimConnectFlightData rawFlightData{};
+    SimConnectSystemsData rawSystemsData{};
+    SimConnectEngineData rawEngineData{};
+    SimConnectAutopilotState rawAutopilotState{};
+    
+    // Batched control output (owned by the control thread)
+    ControlCommandBuffer commandBuffer;
+    bool commandBatching = false;
+    
+    // Send an autopilot hold event unless the snapshot says it is engaged
+    void engageHold(EVENT_ID eventId, bool alreadyEngaged);
+    
+    // ATC text decoded into preallocated slots on the dispatch thread
+    mutable std::mutex atcMutex;  // guards atcTextRing against getATCMenuOptions()
+    ATCTextRing atcTextRing;
+    ATCMessage atcMessage{ATCMessageType::OTHER, {}, {}, -1};  // reused for ATCCallback subscribers
+    bool subscribeToATCTextChannel();
+    void processATCText(const SIMCONNECT_RECV_CLIENT_DATA* pData, DWORD cbData);
+    
+    // AI/multiplayer traffic, upserted by object ID as radius sweeps arrive
+    static constexpr unsigned int MAX_TRAFFIC_RADIUS_METERS = 200000;
+    mutable std::mutex trafficMutex;  // guards trafficTable and subscription traffic fields
+    TrafficTable trafficTable;
+    DWORD userObjectId = SIMCONNECT_OBJECT_ID_USER;
+    int trafficRequestsPending = 0;
+    std::chrono::steady_clock::time_point lastTrafficRequest{};
+    
+    // Issue the next traffic sweep when one is due (message-pumping thread)
+    void pollTraffic();
+    void processTrafficData(const SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData, DWORD cbData);
+    
+    // Published copies of currentState/autopilotState for lock-free reads
+    AircraftStateStore stateStore;
+    StateSnapshot<AutopilotState> autopilotSnapshot;
+    
+    // Dispatch thread signalled by SimConnect through hDispatchEvent
+    static constexpr DWORD DISPATCH_WAIT_TIMEOUT_MS = 100;
+    HANDLE hDispatchEvent = nullptr;
+    std::thread dispatchThread;
+    std::atomic<bool> dispatchRunning{false};
+    
+    void dispatchLoop(SimConnectWrapper* wrapper);
+    
+    // One session: open the handle, then every data definition, event
+    // mapping and request back to back; connected only once all are in
+    std::string appName = "AICopilot";
+    bool openSession();     // caller holds sessionMutex
+    void closeSession();    // caller holds sessionMutex
+    
+    // hSimConnect is closed and reopened by whichever thread pumps messages
+    // (the dispatch thread, if running). That thread holds this for the
+    // close and reopen; every other thread holds it for the whole of any
+    // call that uses the handle, so none sees it mid-reconnect.
+    mutable std::mutex sessionMutex;
+    std::atomic<bool> sessionOpen{false};  // hSimConnect != nullptr, readable without sessionMutex
+    
+    // Reconnection, advanced by whichever thread pumps messages. The
+    // snapshots, raw tier payloads and callbacks survive a lost link.
+    static constexpr int MAX_DISPATCH_FAILURES = 10;  // failed CallDispatch in a row
+    std::atomic<bool> autoReconnect{true};
+    std::atomic<bool> reconnecting{false};
+    std::atomic<bool> commandsStale{false};  // commandBuffer is reset by the control thread
+    std::atomic<uint32_t> reconnectCount{0};
+    int dispatchFailures = 0;
+    ReconnectBackoff reconnectBackoff{std::chrono::milliseconds(250), 2.0, std::chrono::milliseconds(8000)};
+    
+    // A live session ended without disconnect()
+    bool linkLost() const { return autoReconnect && !replaying && (reconnecting || sessionOpen); }
+    
+    // Attempt a reconnection when one is due; returns how long the caller
+    // may wait before the next step (0 once connected)
+    DWORD pollReconnect();
+    
+    // Raw message capture (written from whichever thread dispatches)
+    std::mutex recordMutex;
+    std::atomic<bool> recording{false};
+    SimConnectRecorder recorder;
+    std::chrono::steady_clock::time_point recordStart{};
+    void recordMessage(const SIMCONNECT_RECV* pData, DWORD cbData);
+    
+    // Capture replay: connected with no SimConnect handle
+    static constexpr uint64_t DEFAULT_REPLAY_STEP_US = 50000;  // one 20 Hz AIPilot cycle
+    std::atomic<bool> replaying{false};
+    ReplayPacing replayPacing = ReplayPacing::WALL_CLOCK;
+    SimConnectCaptureReader replayReader;
+    std::chrono::steady_clock::time_point replayStart{};
+    uint64_t replayBaseUs = 0;     // timestamp of the first record
+    uint64_t replayClockUs = 0;    // capture time delivered so far (fast pacing)
+    uint64_t replayStepUs = DEFAULT_REPLAY_STEP_US;
+    std::atomic<uint64_t> replayPositionUs{0};   // capture time of the last dispatched record
+    
+    // Dispatch every record that is due; ends the session at end of capture
+    void pumpReplay(SimConnectWrapper* wrapper);
+    void replayLoop(SimConnectWrapper* wrapper);
+    
+    // Outgoing SimConnect calls need a live handle (not available in replay)
+    bool canTransmit() const { return connected && hSimConnect != nullptr; }
     
     // Initialize data definitions
     bool initializeDataDefinitions();
+    bool addDataDefinition(DWORD definitionId, const SimVarField* fields, size_t count);
+    
+    // (Re)issue the periodic state requests from the current subscription config
+    bool requestDataSubscriptions();
+    bool requestTier(DWORD requestId, DWORD definitionId, const DataSubscriptionConfig& config,
+                     const DataSubscriptionConfig::Tier& tier);
+    
+    // Copy an incoming tier payload (plain or tagged) into its raw struct
+    static bool receiveTier(const SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData, DWORD cbData,
+                            const SimVarField* fields, size_t count, void* target, size_t targetSize);
+    
+    // Merge a SIMCONNECT_DATA_REQUEST_FLAG_TAGGED payload into a raw struct
+    static bool decodeTaggedData(const SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData, DWORD cbData,
+                                 const SimVarField* fields, size_t count, void* target);
     
     // Initialize event mappings
     bool initializeEventMappings();
@@ -272,14 +543,17 @@ public:
     static void CALLBACK dispatchProc(SIMCONNECT_RECV* pData, DWORD cbData, void* pContext);
     
     // Process received data
-    void processSimObjectData(SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData);
+    void processSimObjectData(SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData, DWORD cbData);
     
     // Convert SimConnect data to internal types
-    void updateAircraftState(const SimConnectAircraftState& scState);
+    // Each tier only touches its own AircraftState fields
+    void applyFlightData(const SimConnectFlightData& data);
+    void applySystemsData(const SimConnectSystemsData& data);
+    void applyEngineData(const SimConnectEngineData& data);
     void updateAutopilotState(const SimConnectAutopilotState& scState);
     
     // Validate electrical system data
-    bool validateElectricalData(const SimConnectAircraftState& scState);
+    bool validateElectricalData(const SimConnectSystemsData& scState);
 };
 
 SimConnectWrapper::SimConnectWrapper() : pImpl(std::make_unique<Impl>()) {}
@@ -290,119 +564,363 @@ SimConnectWrapper::~SimConnectWrapper() {
 
 bool SimConnectWrapper::connect(SimulatorType simType, const std::string& appName) {
     if (pImpl->connected) {
-        std::cerr << "Already connected to simulator" << std::endl;
+        AICOPILOT_LOG_WARNING("Already connected to simulator");
         return true;
     }
     
-    std::cout << "Connecting to simulator: " << appName << std::endl;
-    
-    // Open SimConnect connection
-    HRESULT hr = SimConnect_Open(&pImpl->hSimConnect, appName.c_str(), nullptr, 0, 0, 0);
+    // A manual connect takes over from an automatic reconnection
+    if (pImpl->linkLost()) {
+        disconnect();
+    }
     
-    if (FAILED(hr)) {
-        std::cerr << "Failed to connect to SimConnect. Error: 0x" << std::hex << hr << std::endl;
+    pImpl->api = getSimConnectApi(simType);
+    if (pImpl->api == nullptr) {
+        AICOPILOT_LOG_ERROR("No {} SimConnect client available", simConnectSdkName(simConnectSdkFor(simType)));
         return false;
     }
     
-    pImpl->simType = simType;
-    pImpl->connected = true;
+    AICOPILOT_LOG_INFO("Connecting to simulator: {} ({} client, config {})",
+                       appName, simConnectSdkName(pImpl->api->sdk), pImpl->configIndex);
     
-    // Initialize data definitions and event mappings
-    if (!pImpl->initializeDataDefinitions()) {
-        std::cerr << "Failed to initialize data definitions" << std::endl;
+    // Auto-reset event that SimConnect signals whenever a message is queued
+    if (pImpl->hDispatchEvent == nullptr) {
+        pImpl->hDispatchEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    }
+    
+    pImpl->appName = appName;
+    pImpl->simType = simType;
+    pImpl->reconnecting = false;
+    pImpl->reconnectBackoff.reset();
+    pImpl->commandBuffer.reset();
+    bool opened = false;
+    {
+        std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+        opened = pImpl->openSession();
+    }
+    if (!opened) {
         disconnect();
         return false;
     }
     
-    if (!pImpl->initializeEventMappings()) {
-        std::cerr << "Failed to initialize event mappings" << std::endl;
+    AICOPILOT_LOG_INFO("Successfully connected to simulator");
+    return true;
+}
+
+bool SimConnectWrapper::connectReplay(const std::string& capturePath, ReplayPacing pacing) {
+    if (pImpl->connected) {
+        AICOPILOT_LOG_WARNING("Already connected - disconnect before starting a replay");
+        return false;
+    }
+    if (pImpl->linkLost()) {
         disconnect();
+    }
+    
+    if (!pImpl->replayReader.open(capturePath)) {
         return false;
     }
     
-    // Subscribe to system events
-    hr = SimConnect_SubscribeToSystemEvent(pImpl->hSimConnect, EVENT_SIM_START, "SimStart");
-    hr = SimConnect_SubscribeToSystemEvent(pImpl->hSimConnect, EVENT_SIM_STOP, "SimStop");
-    hr = SimConnect_SubscribeToSystemEvent(pImpl->hSimConnect, EVENT_PAUSE, "Pause");
+    AICOPILOT_LOG_INFO("Replaying SimConnect capture: {}{}",
+                       capturePath, (pacing == ReplayPacing::WALL_CLOCK ? " (wall clock)" : " (as fast as possible)"));
+    
+    pImpl->replayPacing = pacing;
+    pImpl->replayBaseUs = pImpl->replayReader.hasRecord() ? pImpl->replayReader.timestampUs() : 0;
+    pImpl->replayClockUs = 0;
+    pImpl->replayPositionUs = 0;
+    pImpl->replayStart = std::chrono::steady_clock::now();
+    pImpl->commandBuffer.reset();
+    {
+        std::lock_guard<std::mutex> lock(pImpl->trafficMutex);
+        pImpl->trafficTable.clear();
+        pImpl->trafficRequestsPending = 0;
+    }
     
-    std::cout << "Successfully connected to simulator" << std::endl;
+    pImpl->replaying = true;
+    pImpl->connected = true;
     return true;
 }
 
+bool SimConnectWrapper::isReplaying() const {
+    return pImpl->replaying;
+}
+
+void SimConnectWrapper::setReplayStep(double seconds) {
+    pImpl->replayStepUs = static_cast<uint64_t>(std::max(0.001, seconds) * 1e6);
+}
+
+double SimConnectWrapper::getReplayTime() const {
+    return pImpl->replayPositionUs.load(std::memory_order_relaxed) * 1e-6;
+}
+
+bool SimConnectWrapper::startRecording(const std::string& capturePath) {
+    std::lock_guard<std::mutex> lock(pImpl->recordMutex);
+    if (!pImpl->recorder.open(capturePath)) {
+        pImpl->recording = false;
+        return false;
+    }
+    pImpl->recordStart = std::chrono::steady_clock::now();
+    pImpl->recording = true;
+    AICOPILOT_LOG_INFO("Recording SimConnect messages to {}", capturePath);
+    
+    // Changed-only tiers would otherwise start the capture without a baseline
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (pImpl->canTransmit()) {
+        pImpl->requestDataSubscriptions();
+    }
+    return true;
+}
+
+void SimConnectWrapper::stopRecording() {
+    std::lock_guard<std::mutex> lock(pImpl->recordMutex);
+    if (!pImpl->recording) return;
+    
+    pImpl->recording = false;
+    pImpl->recorder.close();
+    AICOPILOT_LOG_INFO("Recording stopped: {} messages", pImpl->recorder.getRecordCount());
+}
+
+bool SimConnectWrapper::isRecording() const {
+    return pImpl->recording;
+}
+
 void SimConnectWrapper::disconnect() {
-    if (pImpl->connected && pImpl->hSimConnect != nullptr) {
-        SimConnect_Close(pImpl->hSimConnect);
-        pImpl->hSimConnect = nullptr;
+    stopDispatchThread();
+    stopRecording();
+    pImpl->reconnecting = false;
+    
+    if (pImpl->replaying) {
+        pImpl->replayReader.close();
+        pImpl->replaying = false;
         pImpl->connected = false;
-        std::cout << "Disconnected from simulator" << std::endl;
+        AICOPILOT_LOG_INFO("Replay closed");
+    }
+    
+    if (pImpl->sessionOpen) {
+        std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+        pImpl->closeSession();
+        AICOPILOT_LOG_INFO("Disconnected from simulator");
+    }
+    
+    if (pImpl->hDispatchEvent != nullptr) {
+        CloseHandle(pImpl->hDispatchEvent);
+        pImpl->hDispatchEvent = nullptr;
     }
 }
 
 bool SimConnectWrapper::isConnected() const {
-    return pImpl->connected && pImpl->hSimConnect != nullptr;
+    if (pImpl->replaying) return pImpl->connected;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    return pImpl->canTransmit();
 }
 
 void SimConnectWrapper::processMessages() {
-    if (!pImpl->connected || pImpl->hSimConnect == nullptr) return;
+    // The dispatch thread owns SimConnect_CallDispatch while it runs
+    if (pImpl->dispatchRunning) return;
+    
+    if (pImpl->replaying) {
+        if (pImpl->connected) pImpl->pumpReplay(this);
+        return;
+    }
+    
+    // Without a dispatch thread the control loop steps reconnection itself
+    if (!pImpl->connected) {
+        if (pImpl->linkLost()) pImpl->pollReconnect();
+        return;
+    }
+    if (pImpl->hSimConnect == nullptr) return;
     
     // Process all pending SimConnect messages
-    HRESULT hr = SimConnect_CallDispatch(pImpl->hSimConnect, Impl::dispatchProc, this);
+    HRESULT hr = pImpl->api->CallDispatch(pImpl->hSimConnect, Impl::dispatchProc, this);
     
     if (FAILED(hr)) {
-        std::cerr << "Error processing SimConnect messages: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Error processing SimConnect messages: 0x{:x}", hr);
+    }
+    
+    pImpl->pollTraffic();
+}
+
+bool SimConnectWrapper::startDispatchThread() {
+    if (pImpl->dispatchRunning) return true;
+    
+    if (pImpl->replaying) {
+        // Fast replay is stepped by processMessages() to stay deterministic
+        if (!pImpl->connected || pImpl->replayPacing != ReplayPacing::WALL_CLOCK) return false;
+        pImpl->dispatchRunning = true;
+        pImpl->dispatchThread = std::thread(&Impl::replayLoop, pImpl.get(), this);
+        AICOPILOT_LOG_INFO("SimConnect replay thread started");
+        return true;
+    }
+    
+    bool live = pImpl->connected && pImpl->sessionOpen;
+    if (!live && !pImpl->linkLost()) return false;
+    if (pImpl->hDispatchEvent == nullptr) return false;
+    
+    pImpl->dispatchRunning = true;
+    pImpl->dispatchThread = std::thread(&Impl::dispatchLoop, pImpl.get(), this);
+    AICOPILOT_LOG_INFO("SimConnect dispatch thread started");
+    return true;
+}
+
+void SimConnectWrapper::stopDispatchThread() {
+    if (!pImpl->dispatchRunning && !pImpl->dispatchThread.joinable()) return;
+    
+    pImpl->dispatchRunning = false;
+    if (pImpl->hDispatchEvent != nullptr) {
+        SetEvent(pImpl->hDispatchEvent);
+    }
+    if (pImpl->dispatchThread.joinable()) {
+        pImpl->dispatchThread.join();
     }
+    AICOPILOT_LOG_INFO("SimConnect dispatch thread stopped");
+}
+
+bool SimConnectWrapper::isDispatchThreadRunning() const {
+    return pImpl->dispatchRunning;
+}
+
+void SimConnectWrapper::setAutoReconnect(bool enabled) {
+    pImpl->autoReconnect = enabled;
+}
+
+bool SimConnectWrapper::isReconnecting() const {
+    return pImpl->reconnecting;
+}
+
+uint32_t SimConnectWrapper::getReconnectCount() const {
+    return pImpl->reconnectCount;
+}
+
+void SimConnectWrapper::setConfigIndex(int index) {
+    pImpl->configIndex = std::max(0, index);
+}
+
+int SimConnectWrapper::getConfigIndex() const {
+    return pImpl->configIndex;
 }
 
 AircraftState SimConnectWrapper::getAircraftState() {
-    if (!pImpl->connected) return pImpl->currentState;
+    // Served from the subscription snapshot; no per-call IPC round trip
+    return pImpl->stateStore.load();
+}
+
+AircraftStateCore SimConnectWrapper::getAircraftStateCore(uint64_t& version) {
+    return pImpl->stateStore.loadCore(version);
+}
+
+AircraftStateCold SimConnectWrapper::getAircraftStateCold(uint64_t& version) {
+    return pImpl->stateStore.loadCold(version);
+}
+
+uint64_t SimConnectWrapper::getStateVersion() const {
+    return pImpl->stateStore.coreVersion();
+}
+
+uint64_t SimConnectWrapper::getColdStateVersion() const {
+    return pImpl->stateStore.coldVersion();
+}
+
+AutopilotState SimConnectWrapper::getAutopilotState() {
+    return pImpl->autopilotSnapshot.load();
+}
+
+void SimConnectWrapper::setDataSubscription(const DataSubscriptionConfig& config) {
+    {
+        std::lock_guard<std::mutex> lock(pImpl->trafficMutex);
+        pImpl->subscription = config;
+    }
+    
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
+    pImpl->requestDataSubscriptions();
+}
+
+DataSubscriptionConfig SimConnectWrapper::getDataSubscription() const {
+    std::lock_guard<std::mutex> lock(pImpl->trafficMutex);
+    return pImpl->subscription;
+}
+
+size_t SimConnectWrapper::getTrafficTable(TrafficTable& out) const {
+    std::lock_guard<std::mutex> lock(pImpl->trafficMutex);
+    out = pImpl->trafficTable;
+    return out.size();
+}
+
+Position SimConnectWrapper::getPosition() {
+    return pImpl->stateStore.loadCore().position();
+}
+
+void SimConnectWrapper::setCommandBatching(bool enabled) {
+    if (pImpl->commandBatching && !enabled) {
+        flushCommands();
+    }
+    pImpl->commandBatching = enabled;
+}
+
+bool SimConnectWrapper::isCommandBatchingEnabled() const {
+    return pImpl->commandBatching;
+}
+
+void SimConnectWrapper::flushCommands() {
+    // After a reconnect the sim holds none of the values flushed before it
+    if (pImpl->commandsStale.exchange(false)) {
+        pImpl->commandBuffer.reset();
+    }
+    if (!pImpl->connected || !pImpl->commandBuffer.hasPending()) return;
+    
+    // One tagged write carries every channel that changed this cycle
+    TaggedControlDatum data[ControlCommandBuffer::CHANNEL_COUNT];
+    size_t count = pImpl->commandBuffer.drain([&data](ControlChannel channel, double value, size_t slot) {
+        if (channel == ControlChannel::THROTTLE) {
+            value *= 100.0;  // lever position is in percent
+        }
+        data[slot].datumId = static_cast<DWORD>(channel);
+        data[slot].value = value;
+    });
+    
+    // Replay drains the queue like a live session but has nowhere to send it
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
-    // Request aircraft state data
-    HRESULT hr = SimConnect_RequestDataOnSimObject(
+    HRESULT hr = pImpl->api->SetDataOnSimObject(
         pImpl->hSimConnect,
-        REQUEST_AIRCRAFT_STATE,
-        DEFINITION_AIRCRAFT_STATE,
+        DEFINITION_CONTROLS_STATE,
         SIMCONNECT_OBJECT_ID_USER,
-        SIMCONNECT_PERIOD_ONCE,
-        SIMCONNECT_DATA_REQUEST_FLAG_DEFAULT
+        SIMCONNECT_DATA_SET_FLAG_TAGGED,
+        1,
+        static_cast<DWORD>(count * sizeof(TaggedControlDatum)),
+        data
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to request aircraft state: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to flush control commands: 0x{:x}", hr);
     }
-    
-    return pImpl->currentState;
 }
 
-AutopilotState SimConnectWrapper::getAutopilotState() {
-    if (!pImpl->connected) return pImpl->autopilotState;
+void SimConnectWrapper::Impl::engageHold(EVENT_ID eventId, bool alreadyEngaged) {
+    if (alreadyEngaged) return;
+    std::lock_guard<std::mutex> session(sessionMutex);
+    if (!canTransmit()) return;
     
-    // Request autopilot state data
-    HRESULT hr = SimConnect_RequestDataOnSimObject(
-        pImpl->hSimConnect,
-        REQUEST_AUTOPILOT_STATE,
-        DEFINITION_AUTOPILOT_STATE,
+    HRESULT hr = api->TransmitClientEvent(
+        hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
-        SIMCONNECT_PERIOD_ONCE,
-        SIMCONNECT_DATA_REQUEST_FLAG_DEFAULT
+        eventId,
+        1,
+        SIMCONNECT_GROUP_PRIORITY_HIGHEST,
+        SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to request autopilot state: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to engage autopilot hold: 0x{:x}", hr);
     }
-    
-    return pImpl->autopilotState;
-}
-
-Position SimConnectWrapper::getPosition() {
-    return pImpl->currentState.position;
 }
 
 void SimConnectWrapper::setAutopilotMaster(bool enabled) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
-    std::cout << "Setting autopilot master: " << (enabled ? "ON" : "OFF") << std::endl;
+    AICOPILOT_LOG_DEBUG("Setting autopilot master: {}", (enabled ? "ON" : "OFF"));
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AUTOPILOT_MASTER,
@@ -412,21 +930,30 @@ void SimConnectWrapper::setAutopilotMaster(bool enabled) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set autopilot master: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set autopilot master: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::setAutopilotHeading(double heading) {
     if (!pImpl->connected) return;
     
-    std::cout << "Setting autopilot heading: " << heading << std::endl;
-    
     // Normalize heading to 0-360
     while (heading < 0) heading += 360.0;
     while (heading >= 360.0) heading -= 360.0;
     
+    if (pImpl->commandBatching) {
+        pImpl->engageHold(EVENT_AUTOPILOT_HEADING_HOLD, pImpl->autopilotSnapshot.load().headingHold);
+        pImpl->commandBuffer.write(ControlChannel::AP_HEADING, heading);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
+    
+    AICOPILOT_LOG_DEBUG("Setting autopilot heading: {}", heading);
+    
     // Enable heading hold if not already enabled
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AUTOPILOT_HEADING_HOLD,
@@ -436,7 +963,7 @@ void SimConnectWrapper::setAutopilotHeading(double heading) {
     );
     
     // Set heading bug value
-    hr = SimConnect_TransmitClientEvent(
+    hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AUTOPILOT_HEADING_BUG_SET,
@@ -446,17 +973,26 @@ void SimConnectWrapper::setAutopilotHeading(double heading) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set autopilot heading: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set autopilot heading: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::setAutopilotAltitude(double altitude) {
     if (!pImpl->connected) return;
     
-    std::cout << "Setting autopilot altitude: " << altitude << " feet" << std::endl;
+    if (pImpl->commandBatching) {
+        pImpl->engageHold(EVENT_AUTOPILOT_ALTITUDE_HOLD, pImpl->autopilotSnapshot.load().altitudeHold);
+        pImpl->commandBuffer.write(ControlChannel::AP_ALTITUDE, altitude);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
+    
+    AICOPILOT_LOG_DEBUG("Setting autopilot altitude: {} feet", altitude);
     
     // Enable altitude hold if not already enabled
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AUTOPILOT_ALTITUDE_HOLD,
@@ -466,7 +1002,7 @@ void SimConnectWrapper::setAutopilotAltitude(double altitude) {
     );
     
     // Set altitude value
-    hr = SimConnect_TransmitClientEvent(
+    hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AUTOPILOT_ALTITUDE_VAR_SET,
@@ -476,17 +1012,26 @@ void SimConnectWrapper::setAutopilotAltitude(double altitude) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set autopilot altitude: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set autopilot altitude: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::setAutopilotSpeed(double speed) {
     if (!pImpl->connected) return;
     
-    std::cout << "Setting autopilot speed: " << speed << " knots" << std::endl;
+    if (pImpl->commandBatching) {
+        pImpl->engageHold(EVENT_AUTOPILOT_AIRSPEED_HOLD, pImpl->autopilotSnapshot.load().speedHold);
+        pImpl->commandBuffer.write(ControlChannel::AP_SPEED, speed);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
+    
+    AICOPILOT_LOG_DEBUG("Setting autopilot speed: {} knots", speed);
     
     // Enable airspeed hold if not already enabled
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AUTOPILOT_AIRSPEED_HOLD,
@@ -496,7 +1041,7 @@ void SimConnectWrapper::setAutopilotSpeed(double speed) {
     );
     
     // Set airspeed value
-    hr = SimConnect_TransmitClientEvent(
+    hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AUTOPILOT_AIRSPEED_SET,
@@ -506,17 +1051,26 @@ void SimConnectWrapper::setAutopilotSpeed(double speed) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set autopilot speed: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set autopilot speed: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::setAutopilotVerticalSpeed(double verticalSpeed) {
     if (!pImpl->connected) return;
     
-    std::cout << "Setting autopilot vertical speed: " << verticalSpeed << " fpm" << std::endl;
+    if (pImpl->commandBatching) {
+        pImpl->engageHold(EVENT_AUTOPILOT_VS_HOLD, pImpl->autopilotSnapshot.load().verticalSpeedHold);
+        pImpl->commandBuffer.write(ControlChannel::AP_VERTICAL_SPEED, verticalSpeed);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
+    
+    AICOPILOT_LOG_DEBUG("Setting autopilot vertical speed: {} fpm", verticalSpeed);
     
     // Enable VS hold if not already enabled
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AUTOPILOT_VS_HOLD,
@@ -526,7 +1080,7 @@ void SimConnectWrapper::setAutopilotVerticalSpeed(double verticalSpeed) {
     );
     
     // Set vertical speed value
-    hr = SimConnect_TransmitClientEvent(
+    hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AUTOPILOT_VS_VAR_SET,
@@ -536,16 +1090,17 @@ void SimConnectWrapper::setAutopilotVerticalSpeed(double verticalSpeed) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set autopilot vertical speed: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set autopilot vertical speed: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::setAutopilotNav(bool enabled) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
-    std::cout << "Setting autopilot NAV: " << (enabled ? "ON" : "OFF") << std::endl;
+    AICOPILOT_LOG_DEBUG("Setting autopilot NAV: {}", (enabled ? "ON" : "OFF"));
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AUTOPILOT_NAV_HOLD,
@@ -555,16 +1110,17 @@ void SimConnectWrapper::setAutopilotNav(bool enabled) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set autopilot NAV: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set autopilot NAV: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::setAutopilotApproach(bool enabled) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
-    std::cout << "Setting autopilot approach: " << (enabled ? "ON" : "OFF") << std::endl;
+    AICOPILOT_LOG_DEBUG("Setting autopilot approach: {}", (enabled ? "ON" : "OFF"));
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AUTOPILOT_APPROACH_HOLD,
@@ -574,7 +1130,7 @@ void SimConnectWrapper::setAutopilotApproach(bool enabled) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set autopilot approach: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set autopilot approach: 0x{:x}", hr);
     }
 }
 
@@ -583,12 +1139,21 @@ void SimConnectWrapper::setThrottle(double value) {
     
     // Clamp value to 0.0-1.0
     value = std::max(0.0, std::min(1.0, value));
-    std::cout << "Setting throttle: " << (value * 100.0) << "%" << std::endl;
+    
+    if (pImpl->commandBatching) {
+        pImpl->commandBuffer.write(ControlChannel::THROTTLE, value);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
+    
+    AICOPILOT_LOG_DEBUG("Setting throttle: {}%", (value * 100.0));
     
     // Convert to 0-16383 range (SimConnect throttle range)
     DWORD throttleValue = static_cast<DWORD>(std::round(value * 16383.0));
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_THROTTLE_SET,
@@ -598,7 +1163,7 @@ void SimConnectWrapper::setThrottle(double value) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set throttle: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set throttle: 0x{:x}", hr);
     }
 }
 
@@ -607,11 +1172,20 @@ void SimConnectWrapper::setElevator(double value) {
     
     // Clamp value to -1.0 to 1.0
     value = std::max(-1.0, std::min(1.0, value));
+    
+    if (pImpl->commandBatching) {
+        pImpl->commandBuffer.write(ControlChannel::ELEVATOR, value);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
+    
     // Convert to signed range -16383..16383 as required by AXIS events
     LONG elevatorSigned = static_cast<LONG>(std::round(value * 16383.0));
     DWORD elevatorValue = static_cast<DWORD>(elevatorSigned);
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AXIS_ELEVATOR_SET,
@@ -621,7 +1195,7 @@ void SimConnectWrapper::setElevator(double value) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set elevator: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set elevator: 0x{:x}", hr);
     }
 }
 
@@ -630,11 +1204,20 @@ void SimConnectWrapper::setAileron(double value) {
     
     // Clamp value to -1.0 to 1.0
     value = std::max(-1.0, std::min(1.0, value));
+    
+    if (pImpl->commandBatching) {
+        pImpl->commandBuffer.write(ControlChannel::AILERON, value);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
+    
     // Convert to signed range -16383..16383
     LONG aileronSigned = static_cast<LONG>(std::round(value * 16383.0));
     DWORD aileronValue = static_cast<DWORD>(aileronSigned);
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AXIS_AILERON_SET,
@@ -644,7 +1227,7 @@ void SimConnectWrapper::setAileron(double value) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set aileron: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set aileron: 0x{:x}", hr);
     }
 }
 
@@ -653,11 +1236,20 @@ void SimConnectWrapper::setRudder(double value) {
     
     // Clamp value to -1.0 to 1.0
     value = std::max(-1.0, std::min(1.0, value));
+    
+    if (pImpl->commandBatching) {
+        pImpl->commandBuffer.write(ControlChannel::RUDDER, value);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
+    
     // Convert to signed range -16383..16383
     LONG rudderSigned = static_cast<LONG>(std::round(value * 16383.0));
     DWORD rudderValue = static_cast<DWORD>(rudderSigned);
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_AXIS_RUDDER_SET,
@@ -667,20 +1259,21 @@ void SimConnectWrapper::setRudder(double value) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set rudder: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set rudder: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::setFlaps(int position) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
     // Clamp position to 0-100%
     position = std::max(0, std::min(100, position));
-    std::cout << "Setting flaps: " << position << "%" << std::endl;
+    AICOPILOT_LOG_DEBUG("Setting flaps: {}%", position);
     // Convert to axis range 0..16383 for FLAPS_SET event
     DWORD flapsAxis = static_cast<DWORD>(std::round((position / 100.0) * 16383.0));
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_FLAPS_SET,
@@ -690,18 +1283,19 @@ void SimConnectWrapper::setFlaps(int position) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set flaps: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set flaps: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::setGear(bool down) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
-    std::cout << "Setting gear: " << (down ? "DOWN" : "UP") << std::endl;
+    AICOPILOT_LOG_DEBUG("Setting gear: {}", (down ? "DOWN" : "UP"));
     
     EVENT_ID eventId = down ? EVENT_GEAR_DOWN : EVENT_GEAR_UP;
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         eventId,
@@ -711,18 +1305,19 @@ void SimConnectWrapper::setGear(bool down) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set gear: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set gear: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::setSpoilers(bool deployed) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
-    std::cout << "Setting spoilers: " << (deployed ? "DEPLOYED" : "RETRACTED") << std::endl;
+    AICOPILOT_LOG_DEBUG("Setting spoilers: {}", (deployed ? "DEPLOYED" : "RETRACTED"));
     
     EVENT_ID eventId = deployed ? EVENT_SPOILERS_ON : EVENT_SPOILERS_OFF;
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         eventId,
@@ -732,17 +1327,18 @@ void SimConnectWrapper::setSpoilers(bool deployed) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set spoilers: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set spoilers: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::setParkingBrake(bool set) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
-    std::cout << "Setting parking brake: " << (set ? "ON" : "OFF") << std::endl;
+    AICOPILOT_LOG_DEBUG("Setting parking brake: {}", (set ? "ON" : "OFF"));
     // PARKING_BRAKES is a toggle; only toggle if state differs
-    if (pImpl->currentState.parkingBrakeSet != set) {
-        HRESULT hr = SimConnect_TransmitClientEvent(
+    if (pImpl->stateStore.loadCore().parkingBrakeSet() != set) {
+        HRESULT hr = pImpl->api->TransmitClientEvent(
             pImpl->hSimConnect,
             SIMCONNECT_OBJECT_ID_USER,
             EVENT_PARKING_BRAKES,
@@ -751,21 +1347,22 @@ void SimConnectWrapper::setParkingBrake(bool set) {
             SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY
         );
         if (FAILED(hr)) {
-            std::cerr << "Failed to toggle parking brake: 0x" << std::hex << hr << std::endl;
+            AICOPILOT_LOG_ERROR("Failed to toggle parking brake: 0x{:x}", hr);
         }
     }
 }
 
 void SimConnectWrapper::setBrakes(double value) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
     // Clamp value to 0.0-1.0
     value = std::max(0.0, std::min(1.0, value));
-    std::cout << "Setting brakes: " << (value * 100.0) << "%" << std::endl;
+    AICOPILOT_LOG_DEBUG("Setting brakes: {}%", (value * 100.0));
     
     // Convert to 0-16383 range and apply to both left and right axis brakes
     DWORD brakeValue = static_cast<DWORD>(std::round(value * 16383.0));
-    HRESULT hr1 = SimConnect_TransmitClientEvent(
+    HRESULT hr1 = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_BRAKES_LEFT,
@@ -773,7 +1370,7 @@ void SimConnectWrapper::setBrakes(double value) {
         SIMCONNECT_GROUP_PRIORITY_HIGHEST,
         SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY
     );
-    HRESULT hr2 = SimConnect_TransmitClientEvent(
+    HRESULT hr2 = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_BRAKES_RIGHT,
@@ -782,21 +1379,22 @@ void SimConnectWrapper::setBrakes(double value) {
         SIMCONNECT_EVENT_FLAG_GROUPID_IS_PRIORITY
     );
     if (FAILED(hr1) || FAILED(hr2)) {
-        std::cerr << "Failed to set brakes: 0x" << std::hex << (FAILED(hr1) ? hr1 : hr2) << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set brakes: 0x{:x}", (FAILED(hr1) ? hr1 : hr2));
     }
 }
 
 void SimConnectWrapper::setMixture(double value) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
     // Clamp value to 0.0-1.0
     value = std::max(0.0, std::min(1.0, value));
-    std::cout << "Setting mixture: " << (value * 100.0) << "%" << std::endl;
+    AICOPILOT_LOG_DEBUG("Setting mixture: {}%", (value * 100.0));
     
     // Convert to 0-16383 range
     DWORD mixtureValue = static_cast<DWORD>(std::round(value * 16383.0));
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_MIXTURE_SET,
@@ -806,21 +1404,22 @@ void SimConnectWrapper::setMixture(double value) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set mixture: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set mixture: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::setPropellerPitch(double value) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
     // Clamp value to 0.0-1.0
     value = std::max(0.0, std::min(1.0, value));
-    std::cout << "Setting propeller pitch: " << (value * 100.0) << "%" << std::endl;
+    AICOPILOT_LOG_DEBUG("Setting propeller pitch: {}%", (value * 100.0));
     
     // Convert to 0-16383 range
     DWORD propValue = static_cast<DWORD>(std::round(value * 16383.0));
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_PROP_PITCH_SET,
@@ -830,18 +1429,19 @@ void SimConnectWrapper::setPropellerPitch(double value) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set propeller pitch: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set propeller pitch: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::setMagnetos(int position) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
     // Clamp position to 0-4 (off, right, left, both, start)
     position = std::max(0, std::min(4, position));
-    std::cout << "Setting magnetos: " << position << std::endl;
+    AICOPILOT_LOG_DEBUG("Setting magnetos: {}", position);
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_MAGNETO_SET,
@@ -851,14 +1451,15 @@ void SimConnectWrapper::setMagnetos(int position) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set magnetos: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set magnetos: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::toggleEngineStarter(int engineIndex) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
-    std::cout << "Toggling starter for engine " << engineIndex << std::endl;
+    AICOPILOT_LOG_DEBUG("Toggling starter for engine {}", engineIndex);
     
     EVENT_ID eventId = EVENT_TOGGLE_STARTER1;
     switch (engineIndex) {
@@ -869,7 +1470,7 @@ void SimConnectWrapper::toggleEngineStarter(int engineIndex) {
         default: eventId = EVENT_TOGGLE_STARTER1; break;
     }
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         eventId,
@@ -879,14 +1480,14 @@ void SimConnectWrapper::toggleEngineStarter(int engineIndex) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to toggle engine starter: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to toggle engine starter: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::setEngineState(int engineIndex, bool running) {
-    if (!pImpl->connected) return;
+    if (!pImpl->canTransmit()) return;
     
-    std::cout << "Setting engine " << engineIndex << " state: " << (running ? "RUNNING" : "OFF") << std::endl;
+    AICOPILOT_LOG_DEBUG("Setting engine {} state: {}", engineIndex, (running ? "RUNNING" : "OFF"));
     
     // This is a complex operation that typically involves:
     // - Setting magnetos
@@ -899,9 +1500,10 @@ void SimConnectWrapper::setEngineState(int engineIndex, bool running) {
 }
 
 void SimConnectWrapper::setLight(const std::string& lightName, bool on) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
-    std::cout << "Setting " << lightName << " light: " << (on ? "ON" : "OFF") << std::endl;
+    AICOPILOT_LOG_DEBUG("Setting {} light: {}", lightName, (on ? "ON" : "OFF"));
     
     EVENT_ID eventId = EVENT_NAV_LIGHTS;
     
@@ -928,7 +1530,7 @@ void SimConnectWrapper::setLight(const std::string& lightName, bool on) {
         eventId = EVENT_CABIN_LIGHTS;
     }
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         eventId,
@@ -938,21 +1540,22 @@ void SimConnectWrapper::setLight(const std::string& lightName, bool on) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to set light: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to set light: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::sendATCMenuSelection(int menuIndex) {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
-    std::cout << "Selecting ATC menu option: " << menuIndex << std::endl;
+    AICOPILOT_LOG_DEBUG("Selecting ATC menu option: {}", menuIndex);
     
     // Clamp to 0-9
     menuIndex = std::max(0, std::min(9, menuIndex));
     
     EVENT_ID eventId = static_cast<EVENT_ID>(EVENT_ATC_MENU_0 + menuIndex);
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         eventId,
@@ -962,16 +1565,17 @@ void SimConnectWrapper::sendATCMenuSelection(int menuIndex) {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to send ATC menu selection: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to send ATC menu selection: 0x{:x}", hr);
     }
 }
 
 void SimConnectWrapper::requestATCMenu() {
-    if (!pImpl->connected) return;
+    std::lock_guard<std::mutex> session(pImpl->sessionMutex);
+    if (!pImpl->canTransmit()) return;
     
-    std::cout << "Requesting ATC menu" << std::endl;
+    AICOPILOT_LOG_DEBUG("Requesting ATC menu");
     
-    HRESULT hr = SimConnect_TransmitClientEvent(
+    HRESULT hr = pImpl->api->TransmitClientEvent(
         pImpl->hSimConnect,
         SIMCONNECT_OBJECT_ID_USER,
         EVENT_ATC_MENU_OPEN,
@@ -981,46 +1585,41 @@ void SimConnectWrapper::requestATCMenu() {
     );
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to request ATC menu: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to request ATC menu: 0x{:x}", hr);
     }
 }
 
 std::vector<std::string> SimConnectWrapper::getATCMenuOptions() {
-    // ATC menu state is complex and requires reading text data
-    // This would need to be implemented using SimConnect text requests
-    // or memory reading techniques
-    // For now, return empty vector as placeholder
-    return {};
+    std::lock_guard<std::mutex> lock(pImpl->atcMutex);
+    const ATCTextView* latest = pImpl->atcTextRing.latest();
+    if (latest == nullptr) return {};
+    
+    std::vector<std::string> options;
+    options.reserve(latest->optionCount);
+    for (size_t i = 0; i < latest->optionCount; ++i) {
+        options.emplace_back(latest->options[i]);
+    }
+    return options;
 }
 
 void SimConnectWrapper::subscribeToAircraftState(StateCallback callback) {
+    // State is already streamed by the connect-time subscription
+    std::lock_guard<std::mutex> lock(pImpl->callbackMutex);
     pImpl->stateCallback = callback;
-    
-    if (!pImpl->connected) return;
-    
-    // Request periodic aircraft state data updates
-    HRESULT hr = SimConnect_RequestDataOnSimObject(
-        pImpl->hSimConnect,
-        REQUEST_AIRCRAFT_STATE,
-        DEFINITION_AIRCRAFT_STATE,
-        SIMCONNECT_OBJECT_ID_USER,
-        SIMCONNECT_PERIOD_SIM_FRAME,  // Update every frame
-        SIMCONNECT_DATA_REQUEST_FLAG_CHANGED  // Only when changed
-    );
-    
-    if (FAILED(hr)) {
-        std::cerr << "Failed to subscribe to aircraft state: 0x" << std::hex << hr << std::endl;
-    }
 }
 
 void SimConnectWrapper::subscribeToATCMessages(ATCCallback callback) {
-    pImpl->atcCallback = callback;
-    
-    if (!pImpl->connected) return;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->callbackMutex);
+        pImpl->atcCallback = callback;
+    }
     
-    // Subscribe to ATC text messages
-    // This requires setting up text event subscriptions
-    // Implementation would be complex and simulator-specific
+    // Transmissions are delivered by the connect-time ATC text channel
+}
+
+void SimConnectWrapper::subscribeToATCText(ATCTextCallback callback) {
+    std::lock_guard<std::mutex> lock(pImpl->callbackMutex);
+    pImpl->atcTextCallback = callback;
 }
 
 
@@ -1028,96 +1627,137 @@ void SimConnectWrapper::subscribeToATCMessages(ATCCallback callback) {
 bool SimConnectWrapper::Impl::initializeDataDefinitions() {
     if (hSimConnect == nullptr) return false;
     
-    HRESULT hr;
+    // ===== AIRCRAFT STATE TIER DEFINITIONS (canonical SimVar names) =====
+    if (!addDataDefinition(DEFINITION_FLIGHT_DYNAMICS, FLIGHT_DYNAMICS_FIELDS,
+                           fieldCount(FLIGHT_DYNAMICS_FIELDS))) {
+        AICOPILOT_LOG_ERROR("Failed to add flight dynamics data definition");
+        return false;
+    }
     
-    // ===== AIRCRAFT STATE DATA DEFINITION (canonical SimVar names) =====
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "PLANE LATITUDE", "degrees", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "PLANE LONGITUDE", "degrees", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "PLANE ALTITUDE", "feet", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "PLANE HEADING DEGREES TRUE", "degrees", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "PLANE PITCH DEGREES", "degrees", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "PLANE BANK DEGREES", "degrees", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "AIRSPEED INDICATED", "knots", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "AIRSPEED TRUE", "knots", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "GROUND VELOCITY", "knots", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "VERTICAL SPEED", "feet per minute", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "KOHLSMAN SETTING HG", "inHg", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "FUEL TOTAL QUANTITY", "gallons", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "GENERAL ENG RPM:1", "rpm", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "SIM ON GROUND", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "BRAKE PARKING POSITION", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "GEAR HANDLE POSITION", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "FLAPS HANDLE PERCENT", "percent", SIMCONNECT_DATATYPE_FLOAT64);
+    if (!addDataDefinition(DEFINITION_SYSTEMS_STATE, SYSTEMS_STATE_FIELDS,
+                           fieldCount(SYSTEMS_STATE_FIELDS))) {
+        AICOPILOT_LOG_ERROR("Failed to add systems state data definition");
+        return false;
+    }
     
-    // Electrical system data (canonical names)
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "ELECTRICAL MASTER BATTERY", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "GENERAL ENG MASTER ALTERNATOR:1", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "ELECTRICAL MAIN BUS VOLTAGE", "volts", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "ELECTRICAL MAIN BUS AMPS", "amperes", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "GENERAL ENG GENERATOR SWITCH:1", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AIRCRAFT_STATE, 
-        "GENERAL ENG GENERATOR AMPS:1", "amperes", SIMCONNECT_DATATYPE_FLOAT64);
+    if (!addDataDefinition(DEFINITION_ENGINE_STATE, ENGINE_STATE_FIELDS,
+                           fieldCount(ENGINE_STATE_FIELDS))) {
+        AICOPILOT_LOG_ERROR("Failed to add engine state data definition");
+        return false;
+    }
     
-    if (FAILED(hr)) {
-        std::cerr << "Failed to add aircraft state data definition: 0x" << std::hex << hr << std::endl;
+    // ===== BATCHED CONTROL OUTPUT DEFINITION =====
+    static_assert(fieldCount(CONTROL_FIELDS) == ControlCommandBuffer::CHANNEL_COUNT,
+                  "CONTROL_FIELDS must cover every ControlChannel");
+    if (!addDataDefinition(DEFINITION_CONTROLS_STATE, CONTROL_FIELDS, fieldCount(CONTROL_FIELDS))) {
+        AICOPILOT_LOG_ERROR("Failed to add control output data definition");
         return false;
     }
     
     // ===== AUTOPILOT STATE DATA DEFINITION =====
-    // Normalized to canonical uppercase SimVar names (best-effort)
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AUTOPILOT_STATE, 
-        "AUTOPILOT MASTER", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AUTOPILOT_STATE, 
-        "AUTOPILOT HEADING LOCK", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AUTOPILOT_STATE, 
-        "AUTOPILOT ALTITUDE LOCK", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AUTOPILOT_STATE, 
-        "AUTOPILOT AIRSPEED HOLD", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AUTOPILOT_STATE, 
-        "AUTOPILOT NAV1 LOCK", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AUTOPILOT_STATE, 
-        "AUTOPILOT APPROACH HOLD", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AUTOPILOT_STATE, 
-        "AUTOPILOT THROTTLE ARM", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AUTOPILOT_STATE, 
-        "AUTOPILOT VERTICAL HOLD", "bool", SIMCONNECT_DATATYPE_INT32);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AUTOPILOT_STATE, 
-        "AUTOPILOT HEADING LOCK DIR", "degrees", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AUTOPILOT_STATE, 
-        "AUTOPILOT ALTITUDE LOCK VAR", "feet", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AUTOPILOT_STATE, 
-        "AUTOPILOT AIRSPEED HOLD VAR", "knots", SIMCONNECT_DATATYPE_FLOAT64);
-    hr = SimConnect_AddToDataDefinition(hSimConnect, DEFINITION_AUTOPILOT_STATE, 
-        "AUTOPILOT VERTICAL HOLD VAR", "feet per minute", SIMCONNECT_DATATYPE_FLOAT64);
+    if (!addDataDefinition(DEFINITION_AUTOPILOT_STATE, AUTOPILOT_STATE_FIELDS,
+                           fieldCount(AUTOPILOT_STATE_FIELDS))) {
+        AICOPILOT_LOG_ERROR("Failed to add autopilot state data definition");
+        return false;
+    }
+    
+    // ===== TRAFFIC DATA DEFINITION =====
+    if (!addDataDefinition(DEFINITION_TRAFFIC_STATE, TRAFFIC_STATE_FIELDS,
+                           fieldCount(TRAFFIC_STATE_FIELDS))) {
+        AICOPILOT_LOG_ERROR("Failed to add traffic data definition");
+        return false;
+    }
+    
+    AICOPILOT_LOG_INFO("Data definitions initialized successfully");
+    return true;
+}
+
+bool SimConnectWrapper::Impl::addDataDefinition(DWORD definitionId, const SimVarField* fields, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        HRESULT hr = api->AddToDataDefinition(hSimConnect, definitionId,
+            fields[i].name, fields[i].unit, fields[i].type, 0.0f, static_cast<DWORD>(i));
+        if (FAILED(hr)) {
+            AICOPILOT_LOG_ERROR("Failed to add SimVar {}: 0x{:x}", fields[i].name, hr);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SimConnectWrapper::Impl::requestDataSubscriptions() {
+    if (hSimConnect == nullptr) return false;
+    
+    // setDataSubscription() may write the config from another thread meanwhile
+    DataSubscriptionConfig config;
+    {
+        std::lock_guard<std::mutex> lock(trafficMutex);
+        config = subscription;
+    }
+    
+    return requestTier(REQUEST_FLIGHT_DYNAMICS, DEFINITION_FLIGHT_DYNAMICS, config, config.flightDynamics) &&
+           requestTier(REQUEST_SYSTEMS_STATE, DEFINITION_SYSTEMS_STATE, config, config.systems) &&
+           requestTier(REQUEST_AUTOPILOT_STATE, DEFINITION_AUTOPILOT_STATE, config, config.systems) &&
+           requestTier(REQUEST_ENGINE_STATE, DEFINITION_ENGINE_STATE, config, config.engineHealth);
+}
+
+bool SimConnectWrapper::Impl::requestTier(DWORD requestId, DWORD definitionId,
+                                          const DataSubscriptionConfig& config,
+                                          const DataSubscriptionConfig::Tier& tier) {
+    SIMCONNECT_PERIOD period = SIMCONNECT_PERIOD_SIM_FRAME;
+    switch (tier.period) {
+        case DataSubscriptionConfig::Period::VISUAL_FRAME: period = SIMCONNECT_PERIOD_VISUAL_FRAME; break;
+        case DataSubscriptionConfig::Period::SIM_FRAME: period = SIMCONNECT_PERIOD_SIM_FRAME; break;
+        case DataSubscriptionConfig::Period::SECOND: period = SIMCONNECT_PERIOD_SECOND; break;
+    }
+    
+    DWORD flags = SIMCONNECT_DATA_REQUEST_FLAG_DEFAULT;
+    if (config.changedOnly) flags |= SIMCONNECT_DATA_REQUEST_FLAG_CHANGED;
+    if (config.tagged) flags |= SIMCONNECT_DATA_REQUEST_FLAG_TAGGED;
     
+    DWORD interval = static_cast<DWORD>(std::max(0, tier.interval));
+    
+    HRESULT hr = api->RequestDataOnSimObject(hSimConnect, requestId, definitionId,
+        SIMCONNECT_OBJECT_ID_USER, period, flags, 0, interval, 0);
     if (FAILED(hr)) {
-        std::cerr << "Failed to add autopilot state data definition: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to subscribe to data request {}: 0x{:x}", requestId, hr);
         return false;
     }
+    return true;
+}
+
+bool SimConnectWrapper::Impl::receiveTier(const SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData, DWORD cbData,
+                                          const SimVarField* fields, size_t count,
+                                          void* target, size_t targetSize) {
+    if ((pObjData->dwFlags & SIMCONNECT_DATA_REQUEST_FLAG_TAGGED) != 0) {
+        return decodeTaggedData(pObjData, cbData, fields, count, target);
+    }
     
-    std::cout << "Data definitions initialized successfully" << std::endl;
+    size_t header = static_cast<size_t>(reinterpret_cast<const char*>(&pObjData->dwData) -
+                                        reinterpret_cast<const char*>(pObjData));
+    if (cbData < header + targetSize) return false;
+    std::memcpy(target, &pObjData->dwData, targetSize);
+    return true;
+}
+
+bool SimConnectWrapper::Impl::decodeTaggedData(const SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData, DWORD cbData,
+                                               const SimVarField* fields, size_t count, void* target) {
+    // Tagged payload: dwDefineCount pairs of { DWORD datumId; value }
+    const char* cursor = reinterpret_cast<const char*>(&pObjData->dwData);
+    const char* end = reinterpret_cast<const char*>(pObjData) + cbData;
+    char* out = static_cast<char*>(target);
+    
+    for (DWORD i = 0; i < pObjData->dwDefineCount; ++i) {
+        if (cursor + sizeof(DWORD) > end) return false;
+        DWORD datumId = 0;
+        std::memcpy(&datumId, cursor, sizeof(DWORD));
+        cursor += sizeof(DWORD);
+        
+        if (datumId >= count) return false;
+        const SimVarField& field = fields[datumId];
+        if (cursor + field.size > end) return false;
+        std::memcpy(out + field.offset, cursor, field.size);
+        cursor += field.size;
+    }
     return true;
 }
 
@@ -1127,94 +1767,94 @@ bool SimConnectWrapper::Impl::initializeEventMappings() {
     HRESULT hr;
     
     // ===== AUTOPILOT EVENTS =====
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_MASTER, "AP_MASTER");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_HEADING_HOLD, "AP_HDG_HOLD");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_ALTITUDE_HOLD, "AP_ALT_HOLD");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_AIRSPEED_HOLD, "AP_AIRSPEED_HOLD");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_VS_HOLD, "AP_VS_HOLD");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_NAV_HOLD, "AP_NAV1_HOLD");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_APPROACH_HOLD, "AP_APR_HOLD");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_HEADING_BUG_SET, "HEADING_BUG_SET");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_ALTITUDE_VAR_SET, "AP_ALT_VAR_SET_ENGLISH");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_AIRSPEED_SET, "AP_SPD_VAR_SET");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_VS_VAR_SET, "AP_VS_VAR_SET_ENGLISH");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_MASTER, "AP_MASTER");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_HEADING_HOLD, "AP_HDG_HOLD");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_ALTITUDE_HOLD, "AP_ALT_HOLD");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_AIRSPEED_HOLD, "AP_AIRSPEED_HOLD");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_VS_HOLD, "AP_VS_HOLD");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_NAV_HOLD, "AP_NAV1_HOLD");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_APPROACH_HOLD, "AP_APR_HOLD");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_HEADING_BUG_SET, "HEADING_BUG_SET");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_ALTITUDE_VAR_SET, "AP_ALT_VAR_SET_ENGLISH");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_AIRSPEED_SET, "AP_SPD_VAR_SET");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AUTOPILOT_VS_VAR_SET, "AP_VS_VAR_SET_ENGLISH");
     
     // ===== FLIGHT CONTROL EVENTS =====
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_THROTTLE_SET, "THROTTLE_SET");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_THROTTLE_FULL, "THROTTLE_FULL");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_THROTTLE_CUT, "THROTTLE_CUT");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_THROTTLE_INCR, "THROTTLE_INCR");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_THROTTLE_DECR, "THROTTLE_DECR");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AXIS_ELEVATOR_SET, "AXIS_ELEVATOR_SET");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AXIS_AILERON_SET, "AXIS_AILERONS_SET");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_AXIS_RUDDER_SET, "AXIS_RUDDER_SET");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_THROTTLE_SET, "THROTTLE_SET");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_THROTTLE_FULL, "THROTTLE_FULL");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_THROTTLE_CUT, "THROTTLE_CUT");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_THROTTLE_INCR, "THROTTLE_INCR");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_THROTTLE_DECR, "THROTTLE_DECR");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AXIS_ELEVATOR_SET, "AXIS_ELEVATOR_SET");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AXIS_AILERON_SET, "AXIS_AILERONS_SET");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_AXIS_RUDDER_SET, "AXIS_RUDDER_SET");
     
     // ===== FLAPS EVENTS =====
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_FLAPS_SET, "FLAPS_SET");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_FLAPS_UP, "FLAPS_UP");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_FLAPS_DOWN, "FLAPS_DOWN");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_FLAPS_INCR, "FLAPS_INCR");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_FLAPS_DECR, "FLAPS_DECR");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_FLAPS_SET, "FLAPS_SET");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_FLAPS_UP, "FLAPS_UP");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_FLAPS_DOWN, "FLAPS_DOWN");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_FLAPS_INCR, "FLAPS_INCR");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_FLAPS_DECR, "FLAPS_DECR");
     
     // ===== GEAR EVENTS =====
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_GEAR_TOGGLE, "GEAR_TOGGLE");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_GEAR_UP, "GEAR_UP");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_GEAR_DOWN, "GEAR_DOWN");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_GEAR_TOGGLE, "GEAR_TOGGLE");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_GEAR_UP, "GEAR_UP");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_GEAR_DOWN, "GEAR_DOWN");
     
     // ===== SPOILER EVENTS =====
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_SPOILERS_TOGGLE, "SPOILERS_TOGGLE");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_SPOILERS_ON, "SPOILERS_ON");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_SPOILERS_OFF, "SPOILERS_OFF");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_SPOILERS_SET, "SPOILERS_SET");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_SPOILERS_TOGGLE, "SPOILERS_TOGGLE");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_SPOILERS_ON, "SPOILERS_ON");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_SPOILERS_OFF, "SPOILERS_OFF");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_SPOILERS_SET, "SPOILERS_SET");
     
     // ===== BRAKE EVENTS =====
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_PARKING_BRAKES, "PARKING_BRAKES");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_BRAKES, "BRAKES");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_BRAKES_LEFT, "AXIS_LEFT_BRAKE_SET");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_BRAKES_RIGHT, "AXIS_RIGHT_BRAKE_SET");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_PARKING_BRAKES, "PARKING_BRAKES");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_BRAKES, "BRAKES");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_BRAKES_LEFT, "AXIS_LEFT_BRAKE_SET");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_BRAKES_RIGHT, "AXIS_RIGHT_BRAKE_SET");
     
     // ===== ENGINE EVENTS =====
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_MIXTURE_SET, "MIXTURE_SET");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_MIXTURE_RICH, "MIXTURE_RICH");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_MIXTURE_LEAN, "MIXTURE_LEAN");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_PROP_PITCH_SET, "PROP_PITCH_SET");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_MAGNETO_SET, "MAGNETO_SET");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_TOGGLE_STARTER1, "TOGGLE_STARTER1");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_TOGGLE_STARTER2, "TOGGLE_STARTER2");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_TOGGLE_STARTER3, "TOGGLE_STARTER3");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_TOGGLE_STARTER4, "TOGGLE_STARTER4");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_MIXTURE_SET, "MIXTURE_SET");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_MIXTURE_RICH, "MIXTURE_RICH");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_MIXTURE_LEAN, "MIXTURE_LEAN");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_PROP_PITCH_SET, "PROP_PITCH_SET");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_MAGNETO_SET, "MAGNETO_SET");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_TOGGLE_STARTER1, "TOGGLE_STARTER1");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_TOGGLE_STARTER2, "TOGGLE_STARTER2");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_TOGGLE_STARTER3, "TOGGLE_STARTER3");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_TOGGLE_STARTER4, "TOGGLE_STARTER4");
     
     // ===== LIGHTING EVENTS =====
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_NAV_LIGHTS, "TOGGLE_NAV_LIGHTS");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_BEACON_LIGHTS, "TOGGLE_BEACON_LIGHTS");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_LANDING_LIGHTS, "LANDING_LIGHTS_TOGGLE");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_TAXI_LIGHTS, "TOGGLE_TAXI_LIGHTS");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_STROBE_LIGHTS, "STROBES_TOGGLE");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_PANEL_LIGHTS, "PANEL_LIGHTS_TOGGLE");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_RECOGNITION_LIGHTS, "TOGGLE_RECOGNITION_LIGHTS");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_WING_LIGHTS, "TOGGLE_WING_LIGHTS");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_LOGO_LIGHTS, "TOGGLE_LOGO_LIGHTS");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_CABIN_LIGHTS, "TOGGLE_CABIN_LIGHTS");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_NAV_LIGHTS, "TOGGLE_NAV_LIGHTS");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_BEACON_LIGHTS, "TOGGLE_BEACON_LIGHTS");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_LANDING_LIGHTS, "LANDING_LIGHTS_TOGGLE");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_TAXI_LIGHTS, "TOGGLE_TAXI_LIGHTS");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_STROBE_LIGHTS, "STROBES_TOGGLE");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_PANEL_LIGHTS, "PANEL_LIGHTS_TOGGLE");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_RECOGNITION_LIGHTS, "TOGGLE_RECOGNITION_LIGHTS");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_WING_LIGHTS, "TOGGLE_WING_LIGHTS");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_LOGO_LIGHTS, "TOGGLE_LOGO_LIGHTS");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_CABIN_LIGHTS, "TOGGLE_CABIN_LIGHTS");
     
     // ===== ATC EVENTS =====
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_OPEN, "ATC_MENU_OPEN");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_0, "ATC_MENU_0");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_1, "ATC_MENU_1");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_2, "ATC_MENU_2");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_3, "ATC_MENU_3");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_4, "ATC_MENU_4");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_5, "ATC_MENU_5");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_6, "ATC_MENU_6");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_7, "ATC_MENU_7");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_8, "ATC_MENU_8");
-    hr = SimConnect_MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_9, "ATC_MENU_9");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_OPEN, "ATC_MENU_OPEN");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_0, "ATC_MENU_0");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_1, "ATC_MENU_1");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_2, "ATC_MENU_2");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_3, "ATC_MENU_3");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_4, "ATC_MENU_4");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_5, "ATC_MENU_5");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_6, "ATC_MENU_6");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_7, "ATC_MENU_7");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_8, "ATC_MENU_8");
+    hr = api->MapClientEventToSimEvent(hSimConnect, EVENT_ATC_MENU_9, "ATC_MENU_9");
     
     if (FAILED(hr)) {
-        std::cerr << "Failed to map event: 0x" << std::hex << hr << std::endl;
+        AICOPILOT_LOG_ERROR("Failed to map event: 0x{:x}", hr);
         return false;
     }
     
-    std::cout << "Event mappings initialized successfully" << std::endl;
+    AICOPILOT_LOG_INFO("Event mappings initialized successfully");
     return true;
 }
 
@@ -1224,10 +1864,28 @@ void CALLBACK SimConnectWrapper::Impl::dispatchProc(SIMCONNECT_RECV* pData, DWOR
     
     Impl* impl = wrapper->pImpl.get();
     
+    if (impl->recording) {
+        impl->recordMessage(pData, cbData);
+    }
+    
     switch (pData->dwID) {
         case SIMCONNECT_RECV_ID_SIMOBJECT_DATA: {
             SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData = (SIMCONNECT_RECV_SIMOBJECT_DATA*)pData;
-            impl->processSimObjectData(pObjData);
+            impl->processSimObjectData(pObjData, cbData);
+            break;
+        }
+        
+        case SIMCONNECT_RECV_ID_SIMOBJECT_DATA_BYTYPE: {
+            SIMCONNECT_RECV_SIMOBJECT_DATA_BYTYPE* pObjData = (SIMCONNECT_RECV_SIMOBJECT_DATA_BYTYPE*)pData;
+            impl->processTrafficData(pObjData, cbData);
+            break;
+        }
+        
+        case SIMCONNECT_RECV_ID_CLIENT_DATA: {
+            SIMCONNECT_RECV_CLIENT_DATA* pClientData = (SIMCONNECT_RECV_CLIENT_DATA*)pData;
+            if (pClientData->dwRequestID == REQUEST_ATC_TEXT) {
+                impl->processATCText(pClientData, cbData);
+            }
             break;
         }
         
@@ -1236,13 +1894,13 @@ void CALLBACK SimConnectWrapper::Impl::dispatchProc(SIMCONNECT_RECV* pData, DWOR
             
             switch (evt->uEventID) {
                 case EVENT_SIM_START:
-                    std::cout << "Simulator started" << std::endl;
+                    AICOPILOT_LOG_INFO("Simulator started");
                     break;
                 case EVENT_SIM_STOP:
-                    std::cout << "Simulator stopped" << std::endl;
+                    AICOPILOT_LOG_INFO("Simulator stopped");
                     break;
                 case EVENT_PAUSE:
-                    std::cout << "Simulator paused/unpaused" << std::endl;
+                    AICOPILOT_LOG_INFO("Simulator paused/unpaused");
                     break;
             }
             break;
@@ -1250,12 +1908,12 @@ void CALLBACK SimConnectWrapper::Impl::dispatchProc(SIMCONNECT_RECV* pData, DWOR
         
         case SIMCONNECT_RECV_ID_EXCEPTION: {
             SIMCONNECT_RECV_EXCEPTION* except = (SIMCONNECT_RECV_EXCEPTION*)pData;
-            std::cerr << "SimConnect exception: " << except->dwException << std::endl;
+            AICOPILOT_LOG_ERROR("SimConnect exception: {}", except->dwException);
             break;
         }
         
         case SIMCONNECT_RECV_ID_QUIT: {
-            std::cout << "SimConnect quit message received" << std::endl;
+            AICOPILOT_LOG_INFO("SimConnect quit message received");
             impl->connected = false;
             break;
         }
@@ -1265,66 +1923,423 @@ void CALLBACK SimConnectWrapper::Impl::dispatchProc(SIMCONNECT_RECV* pData, DWOR
     }
 }
 
-void SimConnectWrapper::Impl::processSimObjectData(SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData) {
-    switch (pObjData->dwRequestID) {
-        case REQUEST_AIRCRAFT_STATE: {
-            SimConnectAircraftState* scState = (SimConnectAircraftState*)&pObjData->dwData;
+void SimConnectWrapper::Impl::dispatchLoop(SimConnectWrapper* wrapper) {
+    while (dispatchRunning) {
+        if (!connected) {
+            if (!linkLost()) break;
             
+            // Between attempts wait on the event, which stopDispatchThread() signals
+            DWORD wait = pollReconnect();
+            if (!connected && dispatchRunning) WaitForSingleObject(hDispatchEvent, wait);
+            continue;
+        }
+        
+        // Timeout bounds how long stopDispatchThread() waits on an idle sim
+        DWORD waitResult = WaitForSingleObject(hDispatchEvent, DISPATCH_WAIT_TIMEOUT_MS);
+        if (!dispatchRunning) break;
+        if (waitResult != WAIT_OBJECT_0 && waitResult != WAIT_TIMEOUT) break;
+        
+        HRESULT hr = api->CallDispatch(hSimConnect, dispatchProc, wrapper);
+        if (FAILED(hr)) {
+            // A sim that dies without a quit message only shows up here
+            if (++dispatchFailures >= MAX_DISPATCH_FAILURES) connected = false;
+        } else {
+            dispatchFailures = 0;
+        }
+        if (!connected) continue;
+        
+        pollTraffic();
+    }
+    dispatchRunning = false;
+}
+
+bool SimConnectWrapper::Impl::openSession() {
+    HRESULT hr = api->Open(&hSimConnect, appName.c_str(), nullptr, 0, hDispatchEvent,
+                           static_cast<DWORD>(configIndex));
+    if (FAILED(hr)) {
+        hSimConnect = nullptr;
+        AICOPILOT_LOG_ERROR("Failed to connect to SimConnect. Error: 0x{:x}", hr);
+        return false;
+    }
+    sessionOpen = true;
+    
+    dispatchFailures = 0;
+    {
+        std::lock_guard<std::mutex> lock(trafficMutex);
+        trafficTable.clear();
+        trafficRequestsPending = 0;
+        lastTrafficRequest = {};
+    }
+    
+    // Initialize data definitions and event mappings
+    if (!initializeDataDefinitions()) {
+        AICOPILOT_LOG_ERROR("Failed to initialize data definitions");
+        closeSession();
+        return false;
+    }
+    
+    if (!initializeEventMappings()) {
+        AICOPILOT_LOG_ERROR("Failed to initialize event mappings");
+        closeSession();
+        return false;
+    }
+    
+    // Periodic state delivery feeds the shared snapshot for every getter
+    if (!requestDataSubscriptions()) {
+        AICOPILOT_LOG_ERROR("Failed to request state subscriptions");
+        closeSession();
+        return false;
+    }
+    
+    // ATC text arrives through an optional client data bridge
+    if (!subscribeToATCTextChannel()) {
+        AICOPILOT_LOG_WARNING("ATC text channel unavailable - ATC messages disabled");
+    }
+    
+    // Subscribe to system events
+    api->SubscribeToSystemEvent(hSimConnect, EVENT_SIM_START, "SimStart");
+    api->SubscribeToSystemEvent(hSimConnect, EVENT_SIM_STOP, "SimStop");
+    api->SubscribeToSystemEvent(hSimConnect, EVENT_PAUSE, "Pause");
+    
+    connected = true;
+    return true;
+}
+
+void SimConnectWrapper::Impl::closeSession() {
+    // Other threads use the handle only under sessionMutex, which the caller holds
+    connected = false;
+    if (hSimConnect != nullptr) {
+        api->Close(hSimConnect);
+        hSimConnect = nullptr;
+    }
+    sessionOpen = false;
+}
+
+DWORD SimConnectWrapper::Impl::pollReconnect() {
+    auto now = ReconnectBackoff::Clock::now();
+    if (!reconnecting) {
+        AICOPILOT_LOG_WARNING("Simulator connection lost - reconnecting with state kept");
+        std::lock_guard<std::mutex> session(sessionMutex);
+        closeSession();
+        reconnectBackoff.start(now);
+        reconnecting = true;
+    }
+    
+    if (reconnectBackoff.due(now)) {
+        bool opened = false;
+        {
+            std::lock_guard<std::mutex> session(sessionMutex);
+            opened = openSession();
+        }
+        if (opened) {
+            AICOPILOT_LOG_INFO("Reconnected to simulator after {} failed attempts",
+                               reconnectBackoff.getFailureCount());
+            reconnectBackoff.reset();
+            commandsStale = true;
+            reconnectCount++;
+            reconnecting = false;
+            return 0;
+        }
+        reconnectBackoff.recordFailure(now);
+    }
+    
+    auto wait = std::min<long long>(reconnectBackoff.untilNext(now).count(), DISPATCH_WAIT_TIMEOUT_MS);
+    return static_cast<DWORD>(wait);
+}
+
+void SimConnectWrapper::Impl::recordMessage(const SIMCONNECT_RECV* pData, DWORD cbData) {
+    std::lock_guard<std::mutex> lock(recordMutex);
+    if (!recorder.isOpen()) return;
+    
+    auto elapsed = std::chrono::steady_clock::now() - recordStart;
+    uint64_t timestampUs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    if (!recorder.write(timestampUs, pData, cbData)) {
+        recording = false;
+    }
+}
+
+void SimConnectWrapper::Impl::pumpReplay(SimConnectWrapper* wrapper) {
+    uint64_t horizonUs = 0;
+    if (replayPacing == ReplayPacing::WALL_CLOCK) {
+        auto elapsed = std::chrono::steady_clock::now() - replayStart;
+        horizonUs = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    } else {
+        replayClockUs += replayStepUs;
+        horizonUs = replayClockUs;
+    }
+    
+    while (connected && replayReader.hasRecord() &&
+           replayReader.timestampUs() - replayBaseUs <= horizonUs) {
+        if (replayReader.size() >= sizeof(SIMCONNECT_RECV)) {
+            SIMCONNECT_RECV* pData = reinterpret_cast<SIMCONNECT_RECV*>(replayReader.data());
+            dispatchProc(pData, replayReader.size(), wrapper);
+        }
+        replayPositionUs.store(replayReader.timestampUs() - replayBaseUs, std::memory_order_relaxed);
+        replayReader.next();
+    }
+    
+    if (connected && !replayReader.hasRecord()) {
+        AICOPILOT_LOG_INFO("Replay finished after {} messages", replayReader.getRecordCount());
+        connected = false;
+    }
+}
+
+void SimConnectWrapper::Impl::replayLoop(SimConnectWrapper* wrapper) {
+    while (dispatchRunning && connected) {
+        pumpReplay(wrapper);
+        if (!replayReader.hasRecord()) break;
+        
+        // Sleep until the next record is due (bounded so stop stays responsive)
+        auto due = replayStart + std::chrono::microseconds(replayReader.timestampUs() - replayBaseUs);
+        auto wake = std::min(due, std::chrono::steady_clock::now() +
+                                  std::chrono::milliseconds(DISPATCH_WAIT_TIMEOUT_MS));
+        std::this_thread::sleep_until(wake);
+    }
+    dispatchRunning = false;
+}
+
+void SimConnectWrapper::Impl::processSimObjectData(SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData, DWORD cbData) {
+    switch (pObjData->dwRequestID) {
+        case REQUEST_FLIGHT_DYNAMICS:
+            if (!receiveTier(pObjData, cbData, FLIGHT_DYNAMICS_FIELDS, fieldCount(FLIGHT_DYNAMICS_FIELDS),
+                             &rawFlightData, sizeof(rawFlightData))) {
+                AICOPILOT_LOG_ERROR("Malformed flight dynamics data");
+                return;
+            }
+            // Radius sweeps report the user aircraft by its real object ID
+            userObjectId = pObjData->dwObjectID;
+            applyFlightData(rawFlightData);
+            break;
+        
+        case REQUEST_SYSTEMS_STATE:
+            if (!receiveTier(pObjData, cbData, SYSTEMS_STATE_FIELDS, fieldCount(SYSTEMS_STATE_FIELDS),
+                             &rawSystemsData, sizeof(rawSystemsData))) {
+                AICOPILOT_LOG_ERROR("Malformed systems state data");
+                return;
+            }
             // Validate electrical data before updating state
-            if (validateElectricalData(*scState)) {
-                updateAircraftState(*scState);
-            } else {
+            if (!validateElectricalData(rawSystemsData)) {
                 // Still update state but log the validation failure
-                std::cerr << "Electrical data validation failed - updating state anyway" << std::endl;
-                updateAircraftState(*scState);
-            }
-            
-            // Call callback if registered
-            if (stateCallback) {
-                stateCallback(currentState);
+                AICOPILOT_LOG_WARNING("Electrical data validation failed - updating state anyway");
             }
+            applySystemsData(rawSystemsData);
             break;
-        }
         
-        case REQUEST_AUTOPILOT_STATE: {
-            SimConnectAutopilotState* scState = (SimConnectAutopilotState*)&pObjData->dwData;
-            updateAutopilotState(*scState);
+        case REQUEST_ENGINE_STATE:
+            if (!receiveTier(pObjData, cbData, ENGINE_STATE_FIELDS, fieldCount(ENGINE_STATE_FIELDS),
+                             &rawEngineData, sizeof(rawEngineData))) {
+                AICOPILOT_LOG_ERROR("Malformed engine state data");
+                return;
+            }
+            applyEngineData(rawEngineData);
             break;
-        }
+        
+        case REQUEST_AUTOPILOT_STATE:
+            if (!receiveTier(pObjData, cbData, AUTOPILOT_STATE_FIELDS, fieldCount(AUTOPILOT_STATE_FIELDS),
+                             &rawAutopilotState, sizeof(rawAutopilotState))) {
+                AICOPILOT_LOG_ERROR("Malformed autopilot state data");
+                return;
+            }
+            updateAutopilotState(rawAutopilotState);
+            autopilotSnapshot.store(autopilotState);
+            return;
         
         default:
-            break;
+            return;
+    }
+    
+    // Any aircraft tier update republishes the halves that changed
+    stateStore.publish(currentState);
+    
+    // Call callback if registered
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    if (stateCallback) {
+        stateCallback(currentState);
     }
 }
 
-void SimConnectWrapper::Impl::updateAircraftState(const SimConnectAircraftState& scState) {
-    currentState.position.latitude = scState.latitude;
-    currentState.position.longitude = scState.longitude;
-    currentState.position.altitude = scState.altitude;
-    currentState.position.heading = scState.heading;
-    
-    currentState.heading = scState.heading;
-    currentState.pitch = scState.pitch;
-    currentState.bank = scState.bank;
-    currentState.indicatedAirspeed = scState.indicatedAirspeed;
-    currentState.trueAirspeed = scState.trueAirspeed;
-    currentState.groundSpeed = scState.groundSpeed;
-    currentState.verticalSpeed = scState.verticalSpeed;
-    currentState.altimeter = scState.altimeter;
-    currentState.fuelQuantity = scState.fuelQuantity;
-    currentState.engineRPM = scState.engineRPM;
-    currentState.onGround = (scState.onGround != 0);
-    currentState.parkingBrakeSet = (scState.parkingBrakeSet != 0);
-    currentState.gearDown = (scState.gearDown != 0);
-    currentState.flapsPosition = static_cast<int>(scState.flapsPosition);
+bool SimConnectWrapper::Impl::subscribeToATCTextChannel() {
+    HRESULT hr = api->MapClientDataNameToID(hSimConnect, ATC_TEXT_CLIENT_DATA_NAME, CLIENT_DATA_ATC_TEXT);
+    if (FAILED(hr)) return false;
+    
+    hr = api->AddToClientDataDefinition(hSimConnect, DEFINITION_ATC_TEXT, 0, sizeof(ATCTextClientData));
+    if (FAILED(hr)) return false;
+    
+    hr = api->RequestClientData(hSimConnect, CLIENT_DATA_ATC_TEXT, REQUEST_ATC_TEXT, DEFINITION_ATC_TEXT,
+        SIMCONNECT_CLIENT_DATA_PERIOD_ON_SET, SIMCONNECT_CLIENT_DATA_REQUEST_FLAG_CHANGED);
+    return SUCCEEDED(hr);
+}
+
+void SimConnectWrapper::Impl::processATCText(const SIMCONNECT_RECV_CLIENT_DATA* pData, DWORD cbData) {
+    size_t header = static_cast<size_t>(reinterpret_cast<const char*>(&pData->dwData) -
+                                        reinterpret_cast<const char*>(pData));
+    size_t textOffset = offsetof(ATCTextClientData, text);
+    if (cbData < header + textOffset) {
+        AICOPILOT_LOG_ERROR("Malformed ATC text data");
+        return;
+    }
+    
+    // Read in place: the payload is only copied once, into the ring slot
+    const char* payload = reinterpret_cast<const char*>(&pData->dwData);
+    DWORD messageType = 0;
+    DWORD length = 0;
+    std::memcpy(&messageType, payload + offsetof(ATCTextClientData, messageType), sizeof(DWORD));
+    std::memcpy(&length, payload + offsetof(ATCTextClientData, length), sizeof(DWORD));
+    
+    size_t available = std::min<size_t>(cbData - header - textOffset, sizeof(ATCTextClientData::text));
+    size_t textLength = std::min<size_t>(length, available);
+    
+    ATCMessageType type = messageType <= static_cast<DWORD>(ATCMessageType::OTHER)
+        ? static_cast<ATCMessageType>(messageType) : ATCMessageType::OTHER;
+    
+    const ATCTextView* view = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(atcMutex);
+        view = &atcTextRing.publish(type, payload + textOffset, textLength);
+    }
+    
+    // Only this thread publishes, so the slot stays intact while callbacks run
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    if (atcTextCallback) {
+        atcTextCallback(*view);
+    }
+    if (atcCallback) {
+        // Reuse the owned message's storage instead of rebuilding it
+        atcMessage.type = view->type;
+        atcMessage.message.assign(view->message.data(), view->message.size());
+        atcMessage.menuOptions.resize(view->optionCount);
+        for (size_t i = 0; i < view->optionCount; ++i) {
+            atcMessage.menuOptions[i].assign(view->options[i].data(), view->options[i].size());
+        }
+        atcMessage.selectedOption = -1;
+        atcCallback(atcMessage);
+    }
+}
+
+void SimConnectWrapper::Impl::pollTraffic() {
+    if (hSimConnect == nullptr) return;
+    
+    unsigned int radius = 0;
+    int intervalMs = 0;
+    {
+        std::lock_guard<std::mutex> lock(trafficMutex);
+        if (!subscription.traffic) {
+            if (!trafficTable.empty()) trafficTable.clear();
+            trafficRequestsPending = 0;
+            return;
+        }
+        radius = std::min(subscription.trafficRadiusMeters, MAX_TRAFFIC_RADIUS_METERS);
+        intervalMs = std::max(0, subscription.trafficIntervalMs);
+    }
+    
+    auto now = std::chrono::steady_clock::now();
+    auto interval = std::chrono::milliseconds(intervalMs);
+    if (now - lastTrafficRequest < interval) return;
+    
+    // Let an unfinished sweep complete unless its last entry looks lost
+    if (trafficRequestsPending > 0 && now - lastTrafficRequest < interval * 3) return;
+    
+    {
+        std::lock_guard<std::mutex> lock(trafficMutex);
+        trafficTable.beginSweep();
+    }
+    
+    trafficRequestsPending = 0;
+    HRESULT hr = api->RequestDataOnSimObjectType(hSimConnect, REQUEST_TRAFFIC_AIRCRAFT,
+        DEFINITION_TRAFFIC_STATE, radius, SIMCONNECT_SIMOBJECT_TYPE_AIRCRAFT);
+    if (SUCCEEDED(hr)) trafficRequestsPending++;
+    
+    hr = api->RequestDataOnSimObjectType(hSimConnect, REQUEST_TRAFFIC_HELICOPTER,
+        DEFINITION_TRAFFIC_STATE, radius, SIMCONNECT_SIMOBJECT_TYPE_HELICOPTER);
+    if (SUCCEEDED(hr)) trafficRequestsPending++;
+    
+    if (trafficRequestsPending == 0) {
+        AICOPILOT_LOG_ERROR("Failed to request traffic sweep: 0x{:x}", hr);
+    }
+    lastTrafficRequest = now;
+}
+
+void SimConnectWrapper::Impl::processTrafficData(const SIMCONNECT_RECV_SIMOBJECT_DATA* pObjData, DWORD cbData) {
+    if (pObjData->dwRequestID != REQUEST_TRAFFIC_AIRCRAFT &&
+        pObjData->dwRequestID != REQUEST_TRAFFIC_HELICOPTER) {
+        return;
+    }
+    
+    // Entries are numbered 1..dwoutof; dwoutof == 0 means nothing in range
+    bool lastEntry = pObjData->dwentrynumber >= pObjData->dwoutof;
+    
+    // Replays have no pollTraffic(); recover sweep boundaries from the capture
+    if (replaying && pObjData->dwRequestID == REQUEST_TRAFFIC_AIRCRAFT && pObjData->dwentrynumber <= 1) {
+        std::lock_guard<std::mutex> lock(trafficMutex);
+        trafficTable.beginSweep();
+        trafficRequestsPending = 2;
+    }
+    
+    if (pObjData->dwoutof > 0 && pObjData->dwObjectID != userObjectId) {
+        SimConnectTrafficData data{};
+        if (receiveTier(pObjData, cbData, TRAFFIC_STATE_FIELDS, fieldCount(TRAFFIC_STATE_FIELDS),
+                        &data, sizeof(data))) {
+            data.atcId[sizeof(data.atcId) - 1] = '\0';
+            
+            TrafficTable::Sample sample;
+            sample.callsign = data.atcId;
+            sample.latitude = data.latitude;
+            sample.longitude = data.longitude;
+            sample.altitude = data.altitude;
+            sample.groundSpeed = data.groundSpeed;
+            sample.heading = data.heading;
+            sample.verticalSpeed = data.verticalSpeed;
+            sample.onGround = (data.onGround != 0);
+            
+            std::lock_guard<std::mutex> lock(trafficMutex);
+            trafficTable.upsert(pObjData->dwObjectID, sample);
+        } else {
+            AICOPILOT_LOG_ERROR("Malformed traffic data");
+        }
+    }
+    
+    if (lastEntry && trafficRequestsPending > 0 && --trafficRequestsPending == 0) {
+        std::lock_guard<std::mutex> lock(trafficMutex);
+        trafficTable.endSweep();
+    }
+}
+
+void SimConnectWrapper::Impl::applyFlightData(const SimConnectFlightData& data) {
+    currentState.position.latitude = data.latitude;
+    currentState.position.longitude = data.longitude;
+    currentState.position.altitude = data.altitude;
+    currentState.position.heading = data.heading;
+    
+    currentState.heading = data.heading;
+    currentState.pitch = data.pitch;
+    currentState.bank = data.bank;
+    currentState.indicatedAirspeed = data.indicatedAirspeed;
+    currentState.trueAirspeed = data.trueAirspeed;
+    currentState.groundSpeed = data.groundSpeed;
+    currentState.verticalSpeed = data.verticalSpeed;
+    currentState.onGround = (data.onGround != 0);
+}
+
+void SimConnectWrapper::Impl::applySystemsData(const SimConnectSystemsData& data) {
+    currentState.altimeter = data.altimeter;
+    currentState.parkingBrakeSet = (data.parkingBrakeSet != 0);
+    currentState.gearDown = (data.gearDown != 0);
+    currentState.flapsPosition = static_cast<int>(data.flapsPosition);
     
     // Electrical system data
-    currentState.masterBattery = (scState.masterBattery != 0);
-    currentState.masterAlternator = (scState.masterAlternator != 0);
-    currentState.batteryVoltage = scState.batteryVoltage;
-    currentState.batteryLoad = scState.batteryLoad;
-    currentState.generatorVoltage = scState.generatorVoltage;
-    currentState.generatorLoad = scState.generatorLoad;
+    currentState.masterBattery = (data.masterBattery != 0);
+    currentState.masterAlternator = (data.masterAlternator != 0);
+    currentState.batteryVoltage = data.batteryVoltage;
+    currentState.batteryLoad = data.batteryLoad;
+    currentState.generatorVoltage = data.generatorVoltage;
+    currentState.generatorLoad = data.generatorLoad;
+}
+
+void SimConnectWrapper::Impl::applyEngineData(const SimConnectEngineData& data) {
+    currentState.fuelQuantity = data.fuelQuantity;
+    currentState.engineRPM = data.engineRPM;
 }
 
 void SimConnectWrapper::Impl::updateAutopilotState(const SimConnectAutopilotState& scState) {
@@ -1335,41 +2350,43 @@ void SimConnectWrapper::Impl::updateAutopilotState(const SimConnectAutopilotStat
     autopilotState.navMode = (scState.navMode != 0);
     autopilotState.approachMode = (scState.approachMode != 0);
     autopilotState.autoThrottle = (scState.autoThrottle != 0);
+    autopilotState.verticalSpeedHold = (scState.verticalSpeedHold != 0);
     autopilotState.targetHeading = scState.targetHeading;
     autopilotState.targetAltitude = scState.targetAltitude;
     autopilotState.targetSpeed = scState.targetAirspeed;
+    autopilotState.targetVerticalSpeed = scState.targetVerticalSpeed;
 }
 
-bool SimConnectWrapper::Impl::validateElectricalData(const SimConnectAircraftState& scState) {
+bool SimConnectWrapper::Impl::validateElectricalData(const SimConnectSystemsData& scState) {
     // Validate electrical data ranges to ensure data integrity
     
     // Battery voltage should be between 0 and 50V (covers both 12V and 24V systems)
     if (scState.batteryVoltage < 0.0 || scState.batteryVoltage > 50.0) {
-        std::cerr << "Warning: Invalid battery voltage reading: " << scState.batteryVoltage << "V" << std::endl;
+        AICOPILOT_LOG_WARNING("Warning: Invalid battery voltage reading: {}V", scState.batteryVoltage);
         return false;
     }
     
     // Battery load should be reasonable (0-200A for most aircraft)
     if (scState.batteryLoad < 0.0 || scState.batteryLoad > 500.0) {
-        std::cerr << "Warning: Invalid battery load reading: " << scState.batteryLoad << "A" << std::endl;
+        AICOPILOT_LOG_WARNING("Warning: Invalid battery load reading: {}A", scState.batteryLoad);
         return false;
     }
     
     // Generator voltage should be in valid range
     if (scState.generatorVoltage < 0.0 || scState.generatorVoltage > 50.0) {
-        std::cerr << "Warning: Invalid generator voltage reading: " << scState.generatorVoltage << "V" << std::endl;
+        AICOPILOT_LOG_WARNING("Warning: Invalid generator voltage reading: {}V", scState.generatorVoltage);
         return false;
     }
     
     // Generator load should be reasonable
     if (scState.generatorLoad < 0.0 || scState.generatorLoad > 500.0) {
-        std::cerr << "Warning: Invalid generator load reading: " << scState.generatorLoad << "A" << std::endl;
+        AICOPILOT_LOG_WARNING("Warning: Invalid generator load reading: {}A", scState.generatorLoad);
         return false;
     }
     
     return true;
 }
 
-} // namespace AICopilot
-
 #endif // AICOPILOT_HAVE_SIMCONNECT
+
+} // namespace AICopilot
@@ -20,9 +20,115 @@
 #include <cctype>
 #include <sstream>
 #include <cmath>
+#include <cstdlib>
 
 namespace AICopilot {
 
+namespace {
+
+// Words of normalized text
+void splitWords(const std::string& text, std::vector<std::string>& words) {
+    words.clear();
+    std::istringstream stream(text);
+    std::string word;
+    while (stream >> word) {
+        words.push_back(word);
+    }
+}
+
+bool isVowel(char c) {
+    return c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u';
+}
+
+} // namespace
+
+// ============================================================================
+// EditDistancePattern Implementation
+// ============================================================================
+
+EditDistancePattern::EditDistancePattern(const std::string& pattern)
+    : pattern_(pattern), bit_parallel_(pattern.length() <= MAX_BIT_PARALLEL) {
+    for (size_t i = 0; i < pattern_.length() && bit_parallel_; ++i) {
+        size_t s = symbol(static_cast<unsigned char>(pattern_[i]));
+        if (s == ALPHABET - 1) {
+            bit_parallel_ = false;  // other characters would all match one another
+        } else {
+            match_masks_[s] |= uint64_t(1) << i;
+        }
+    }
+}
+
+size_t EditDistancePattern::symbol(unsigned char c) {
+    if (c >= 'a' && c <= 'z') return c - 'a';
+    if (c >= '0' && c <= '9') return 26 + (c - '0');
+    if (c == ' ') return 36;
+    return ALPHABET - 1;
+}
+
+int EditDistancePattern::distance(const std::string& text, int max_distance) const {
+    const int m = static_cast<int>(pattern_.length());
+    const int n = static_cast<int>(text.length());
+    if (std::abs(m - n) > max_distance) return max_distance + 1;
+    if (m == 0) return n;
+    if (!bit_parallel_) return bandedDistance(text, max_distance);
+    
+    // Myers / Hyyrö: vertical deltas of the DP column as +1 and -1 bit
+    // vectors, tracking the bottom cell's value in score
+    const uint64_t last = uint64_t(1) << (m - 1);
+    uint64_t pv = ~uint64_t(0);
+    uint64_t mv = 0;
+    int score = m;
+    for (int j = 0; j < n; ++j) {
+        uint64_t eq = match_masks_[symbol(static_cast<unsigned char>(text[j]))];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & last) {
+            ++score;
+        } else if (mh & last) {
+            --score;
+        }
+        ph = (ph << 1) | 1;     // the top row grows by one per text character
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+        
+        // Each remaining character lowers the score by at most one
+        if (score - (n - 1 - j) > max_distance) return max_distance + 1;
+    }
+    return std::min(score, max_distance + 1);
+}
+
+int EditDistancePattern::bandedDistance(const std::string& text, int max_distance) const {
+    const int m = static_cast<int>(pattern_.length());
+    const int n = static_cast<int>(text.length());
+    const int limit = max_distance + 1;
+    
+    // Only cells within max_distance of the diagonal can stay under the limit
+    std::vector<int> prev(n + 1, limit);
+    std::vector<int> cur(n + 1, limit);
+    for (int j = 0; j <= std::min(n, max_distance); ++j) prev[j] = j;
+    
+    for (int i = 1; i <= m; ++i) {
+        int lo = std::max(1, i - max_distance);
+        int hi = std::min(n, i + max_distance);
+        cur[0] = std::min(i, limit);
+        if (lo > 1) cur[lo - 1] = limit;
+        int row_min = cur[0];
+        for (int j = lo; j <= hi; ++j) {
+            int cost = pattern_[i - 1] == text[j - 1] ? 0 : 1;
+            int value = std::min({prev[j] + 1, cur[j - 1] + 1, prev[j - 1] + cost});
+            cur[j] = std::min(value, limit);
+            row_min = std::min(row_min, cur[j]);
+        }
+        if (hi < n) cur[hi + 1] = limit;
+        if (row_min >= limit) return limit;
+        std::swap(prev, cur);
+    }
+    return prev[n];
+}
+
 // ============================================================================
 // PhoneticMatcher Implementation
 // ============================================================================
@@ -40,8 +146,8 @@ PhoneticMatcher::PhoneticMatcher() {
 
 double PhoneticMatcher::calculateSimilarity(const std::string& spoken,
                                           const std::string& expected) const {
-    std::string s1 = toLower(normalizeText(spoken));
-    std::string s2 = toLower(normalizeText(expected));
+    std::string s1 = normalizeText(spoken);
+    std::string s2 = normalizeText(expected);
     
     int dist = levenshteinDistance(s1, s2);
     int max_len = std::max(s1.length(), s2.length());
@@ -112,25 +218,90 @@ std::string PhoneticMatcher::applyPhoneticCorrections(const std::string& text) c
 
 int PhoneticMatcher::levenshteinDistance(const std::string& s1,
                                        const std::string& s2) const {
-    size_t len1 = s1.length();
-    size_t len2 = s2.length();
-    
-    std::vector<std::vector<int>> dp(len1 + 1, std::vector<int>(len2 + 1));
-    
-    for (size_t i = 0; i <= len1; ++i) dp[i][0] = i;
-    for (size_t j = 0; j <= len2; ++j) dp[0][j] = j;
-    
-    for (size_t i = 1; i <= len1; ++i) {
-        for (size_t j = 1; j <= len2; ++j) {
-            if (s1[i-1] == s2[j-1]) {
-                dp[i][j] = dp[i-1][j-1];
-            } else {
-                dp[i][j] = 1 + std::min({dp[i-1][j], dp[i][j-1], dp[i-1][j-1]});
-            }
+    int bound = static_cast<int>(std::max(s1.length(), s2.length()));
+    return EditDistancePattern(s2).distance(s1, bound);
+}
+
+std::string PhoneticMatcher::phoneticKey(const std::string& word) {
+    std::string key;
+    const size_t n = word.length();
+    size_t i = 0;
+    
+    // Silent initial letters
+    if (n > 1 && ((word[0] == 'k' || word[0] == 'g' || word[0] == 'p') && word[1] == 'n')) i = 1;
+    if (n > 1 && word[0] == 'w' && word[1] == 'r') i = 1;
+    
+    for (; i < n; ++i) {
+        char c = word[i];
+        char next = i + 1 < n ? word[i + 1] : '\0';
+        char prev = i > 0 ? word[i - 1] : '\0';
+        if (c == prev && c != 'c') continue;
+        if (std::isdigit(static_cast<unsigned char>(c))) {
+            key += c;
+            continue;
+        }
+        
+        switch (c) {
+            case 'a': case 'e': case 'i': case 'o': case 'u':
+                if (i == 0) key += 'A';
+                break;
+            case 'b':
+                if (!(prev == 'm' && i + 1 == n)) key += 'B';
+                break;
+            case 'c':
+                if (next == 'h') { key += 'X'; ++i; }
+                else if (next == 'i' || next == 'e' || next == 'y') key += 'S';
+                else key += 'K';
+                break;
+            case 'd':
+                key += (next == 'g' && i + 2 < n && (word[i + 2] == 'e' || word[i + 2] == 'i' || word[i + 2] == 'y'))
+                    ? 'J' : 'T';
+                break;
+            case 'g':
+                if (next == 'h' && (i + 2 >= n || !isVowel(word[i + 2]))) break;   // "flight"
+                key += (next == 'i' || next == 'e' || next == 'y') ? 'J' : 'K';
+                break;
+            case 'h':
+                if (isVowel(next) && std::string("cgpst").find(prev) == std::string::npos) key += 'H';
+                break;
+            case 'k':
+                if (prev != 'c') key += 'K';
+                break;
+            case 'p':
+                if (next == 'h') { key += 'F'; ++i; }
+                else key += 'P';
+                break;
+            case 'q':
+                key += 'K';
+                break;
+            case 's':
+                if (next == 'h') { key += 'X'; ++i; }
+                else key += 'S';
+                break;
+            case 't':
+                if (next == 'h') { key += '0'; ++i; }
+                else key += 'T';
+                break;
+            case 'v':
+                key += 'F';
+                break;
+            case 'w': case 'y':
+                if (isVowel(next)) key += static_cast<char>(std::toupper(c));
+                break;
+            case 'x':
+                key += i == 0 ? "S" : "KS";
+                break;
+            case 'z':
+                key += 'S';
+                break;
+            default:
+                if (std::isalpha(static_cast<unsigned char>(c))) {
+                    key += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+                }
+                break;
         }
     }
-    
-    return dp[len1][len2];
+    return key;
 }
 
 std::string PhoneticMatcher::toLower(const std::string& text) const {
@@ -144,8 +315,39 @@ std::string PhoneticMatcher::toLower(const std::string& text) const {
 // CommandRecognizer Implementation
 // ============================================================================
 
+namespace {
+
+constexpr uint32_t ALL_PHASES = (1u << FLIGHT_PHASE_COUNT) - 1;
+constexpr uint32_t DEPARTURE_PHASES = flightPhaseBit(FlightPhase::PREFLIGHT) |
+                                      flightPhaseBit(FlightPhase::TAXI_OUT);
+constexpr uint32_t AIRBORNE_PHASES = flightPhaseBit(FlightPhase::TAKEOFF) |
+                                     flightPhaseBit(FlightPhase::CLIMB) |
+                                     flightPhaseBit(FlightPhase::CRUISE) |
+                                     flightPhaseBit(FlightPhase::DESCENT) |
+                                     flightPhaseBit(FlightPhase::APPROACH) |
+                                     flightPhaseBit(FlightPhase::LANDING);
+constexpr uint32_t ARRIVAL_PHASES = flightPhaseBit(FlightPhase::DESCENT) |
+                                    flightPhaseBit(FlightPhase::APPROACH) |
+                                    flightPhaseBit(FlightPhase::LANDING);
+
+// Phases each category is live in unless a command sets its own
+constexpr uint32_t CATEGORY_PHASES[COMMAND_CATEGORY_COUNT] = {
+    // NAVIGATION: set up before departure, flown until the landing
+    (DEPARTURE_PHASES | AIRBORNE_PHASES) & ~flightPhaseBit(FlightPhase::LANDING),
+    // RUNWAY_APPROACH: departure runway, then from cruise on
+    DEPARTURE_PHASES | flightPhaseBit(FlightPhase::TAKEOFF) | flightPhaseBit(FlightPhase::CRUISE) |
+        ARRIVAL_PHASES | flightPhaseBit(FlightPhase::TAXI_IN),
+    ALL_PHASES,     // FLIGHT_SYSTEMS
+    ALL_PHASES,     // STATUS_QUERY
+    ALL_PHASES,     // EMERGENCY
+    ALL_PHASES      // UNKNOWN
+};
+
+} // namespace
+
 CommandRecognizer::CommandRecognizer()
-    : confidence_threshold_(0.85) {
+    : confidence_threshold_(0.85),
+      active_grammar_(static_cast<size_t>(FlightPhase::UNKNOWN)) {
     phonetic_matcher_ = std::make_unique<PhoneticMatcher>();
 }
 
@@ -160,63 +362,371 @@ bool CommandRecognizer::initialize() {
 }
 
 void CommandRecognizer::registerCommand(const CommandDefinition& command) {
+    bool replacing = commands_.count(command.command_id) > 0;
     commands_[command.command_id] = command;
+    
+    // A replaced command's old variations must leave the trie
+    if (replacing) {
+        rebuildPhraseIndex();
+    } else {
+        auto& ids = category_commands_[static_cast<size_t>(determineCategory(command.command_id))];
+        ids.insert(std::upper_bound(ids.begin(), ids.end(), command.command_id), command.command_id);
+        indexCommand(command);
+    }
+}
+
+void CommandRecognizer::setFlightPhase(FlightPhase phase) {
+    size_t grammar = std::min(static_cast<size_t>(phase), FLIGHT_PHASE_COUNT - 1);
+    if (grammar == active_grammar_) {
+        return;
+    }
+    active_grammar_ = grammar;
+    
+    // Paths of an utterance in progress named the old grammar's nodes
+    if (utterance_.active) {
+        beginUtterance();
+    }
+}
+
+bool CommandRecognizer::isCommandActive(const std::string& command_id, FlightPhase phase) const {
+    auto it = commands_.find(command_id);
+    return it != commands_.end() && (activePhases(it->second) & flightPhaseBit(phase)) != 0;
 }
 
 RecognitionResult CommandRecognizer::recognize(const std::string& spoken_text) {
-    RecognitionResult result;
-    result.raw_text = spoken_text;
-    result.confidence = 0.0;
-    result.command = "UNKNOWN";
+    PhraseMatch best;
+    if (!spoken_text.empty()) {
+        std::vector<std::string> words;
+        splitWords(phonetic_matcher_->normalizeText(spoken_text), words);
+        
+        // Walk the trie one spoken word at a time from the first
+        std::vector<PhrasePath> paths = {{0, 0, 0, 0}};
+        std::vector<PhrasePath> next;
+        std::vector<WordMatch> matches;
+        for (size_t i = 0; i < words.size() && !paths.empty(); ++i) {
+            matchWord(words[i], matches);
+            extendPaths(paths, i, matches, next, best);
+            paths.swap(next);
+        }
+    }
     
-    statistics_.total_attempts++;
+    RecognitionResult result = makeResult(spoken_text, best);
+    recordRecognition(result);
+    return result;
+}
+
+void CommandRecognizer::beginUtterance() {
+    utterance_ = UtteranceState{};
+    utterance_.active = true;
+    utterance_.frontiers.push_back({{0, 0, 0, 0}});
+    utterance_.best.emplace_back();
+}
+
+PartialRecognition CommandRecognizer::updateUtterance(const std::string& partial_text) {
+    if (!utterance_.active) {
+        beginUtterance();
+    }
     
-    if (spoken_text.empty()) {
-        return result;
+    PartialRecognition partial;
+    if (utterance_.committed) {
+        partial.result = utterance_.result;
+        partial.committed = true;
+        return partial;
     }
     
-    std::string normalized = phonetic_matcher_->normalizeText(spoken_text);
-    double best_confidence = 0.0;
-    std::string best_command;
+    std::vector<std::string> words;
+    splitWords(phonetic_matcher_->normalizeText(partial_text), words);
     
-    // Try to match against all known command variations
-    for (const auto& [cmd_id, cmd_def] : commands_) {
-        for (const auto& variation : cmd_def.variations) {
-            double similarity = phonetic_matcher_->calculateSimilarity(
-                normalized, variation);
+    // Keep the paths through the words this hypothesis shares with the last
+    size_t common = 0;
+    while (common < words.size() && common < utterance_.words.size() &&
+           common + 1 < utterance_.frontiers.size() && words[common] == utterance_.words[common]) {
+        ++common;
+    }
+    utterance_.frontiers.resize(common + 1);
+    utterance_.best.resize(common + 1);
+    
+    std::vector<WordMatch> matches;
+    for (size_t i = common; i < words.size() && !utterance_.frontiers.back().empty(); ++i) {
+        matchWord(words[i], matches);
+        PhraseMatch best = utterance_.best.back();
+        utterance_.frontiers.emplace_back();
+        extendPaths(utterance_.frontiers[i], i, matches, utterance_.frontiers[i + 1], best);
+        utterance_.best.push_back(best);
+    }
+    utterance_.words.swap(words);
+    
+    partial.result = makeResult(partial_text, utterance_.best.back());
+    if (partial.result.command != "UNKNOWN" && isUtteranceUnambiguous()) {
+        utterance_.committed = true;
+        utterance_.result = partial.result;
+        partial.committed = true;
+        recordRecognition(partial.result);
+    }
+    return partial;
+}
+
+RecognitionResult CommandRecognizer::endUtterance(const std::string& final_text) {
+    PartialRecognition partial = updateUtterance(final_text);
+    if (!partial.committed) {
+        recordRecognition(partial.result);
+    }
+    partial.result.raw_text = final_text;
+    utterance_ = UtteranceState{};
+    return partial.result;
+}
+
+void CommandRecognizer::extendPaths(const std::vector<PhrasePath>& paths, size_t words_before,
+                                    const std::vector<WordMatch>& matches,
+                                    std::vector<PhrasePath>& next, PhraseMatch& best) const {
+    // A phrase scores like the edit similarity of its text and the words
+    // it covered, spaces included
+    const std::vector<PhraseNode>& trie = activeGrammar().trie;
+    next.clear();
+    for (const PhrasePath& path : paths) {
+        const PhraseNode& node = trie[path.node];
+        for (const WordMatch& match : matches) {
+            auto child = node.children.find(match.word);
+            if (child == node.children.end()) continue;
             
-            if (similarity > best_confidence) {
-                best_confidence = similarity;
-                best_command = cmd_id;
+            PhrasePath extended{child->second, path.distance + match.distance,
+                                path.length + match.length + (words_before > 0 ? 1 : 0), match.distance};
+            next.push_back(extended);
+            
+            const std::string& command_id = trie[extended.node].command_id;
+            if (command_id.empty()) continue;
+            double similarity = 1.0 - static_cast<double>(extended.distance) / extended.length;
+            size_t words = words_before + 1;
+            // Ties go to the longer phrase, then to the first command id
+            if (similarity > best.confidence ||
+                (similarity == best.confidence &&
+                 (words > best.words || (words == best.words && command_id < best.command)))) {
+                best.command = command_id;
+                best.confidence = similarity;
+                best.words = words;
+                best.last_distance = match.distance;
+            }
+        }
+    }
+}
+
+bool CommandRecognizer::leadsOnlyTo(uint32_t node, const std::string& command_id) const {
+    const PhraseNode& n = activeGrammar().trie[node];
+    return !n.subtree_ambiguous && n.subtree_command == command_id;
+}
+
+bool CommandRecognizer::isUtteranceUnambiguous() const {
+    const PhraseMatch& best = utterance_.best.back();
+    const size_t heard = utterance_.frontiers.size() - 1;
+    if (best.command.empty() || heard == 0) {
+        return false;
+    }
+    
+    // The newest word is still being spoken unless the walk ended before it
+    if (heard == utterance_.words.size()) {
+        const std::string& newest = utterance_.words[heard - 1];
+        if (best.words == heard && best.last_distance != 0) {
+            return false;
+        }
+        for (const PhrasePath& path : utterance_.frontiers[heard - 1]) {
+            for (const auto& [word_id, child] : activeGrammar().trie[path.node].children) {
+                const std::string& word = vocabulary_[word_id].pattern.text();
+                if (word.length() > newest.length() && word.compare(0, newest.length(), newest) == 0 &&
+                    !leadsOnlyTo(child, best.command)) {
+                    return false;
+                }
             }
         }
     }
     
+    // And no longer phrase through the words heard names another command
+    for (const PhrasePath& path : utterance_.frontiers[heard]) {
+        if (!leadsOnlyTo(path.node, best.command)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+RecognitionResult CommandRecognizer::makeResult(const std::string& raw_text, const PhraseMatch& match) const {
+    RecognitionResult result;
+    result.raw_text = raw_text;
+    result.confidence = 0.0;
+    result.command = "UNKNOWN";
+    
     // Check if confidence meets threshold
-    if (best_confidence >= confidence_threshold_) {
-        result.command = best_command;
-        result.confidence = best_confidence;
-        result.interpretation = best_command;
-        
-        statistics_.successful_recognitions++;
-        command_usage_count_[best_command]++;
+    if (!match.command.empty() && match.confidence >= confidence_threshold_) {
+        result.command = match.command;
+        result.confidence = match.confidence;
+        result.interpretation = match.command;
+    }
+    return result;
+}
+
+void CommandRecognizer::recordRecognition(const RecognitionResult& result) {
+    statistics_.total_attempts++;
+    if (result.command == "UNKNOWN") {
+        return;
+    }
+    
+    statistics_.successful_recognitions++;
+    command_usage_count_[result.command]++;
+    
+    if (statistics_.total_attempts > 0) {
+        statistics_.average_confidence = 
+            (statistics_.average_confidence * (statistics_.total_attempts - 1) + 
+             result.confidence) / statistics_.total_attempts;
+    }
+    
+    // Find most common command
+    if (!command_usage_count_.empty()) {
+        auto max_it = std::max_element(
+            command_usage_count_.begin(), command_usage_count_.end(),
+            [](const auto& a, const auto& b) { return a.second < b.second; });
+        statistics_.most_common_command_count = max_it->second;
+    }
+}
+
+uint32_t CommandRecognizer::activePhases(const CommandDefinition& command) const {
+    uint32_t phases = command.active_phases != 0
+        ? command.active_phases
+        : CATEGORY_PHASES[static_cast<size_t>(determineCategory(command.command_id))];
+    // The UNKNOWN grammar recognizes everything
+    return phases | flightPhaseBit(FlightPhase::UNKNOWN);
+}
+
+void CommandRecognizer::indexCommand(const CommandDefinition& command) {
+    std::vector<std::vector<uint32_t>> variation_words;
+    std::vector<std::string> words;
+    for (const auto& variation : command.variations) {
+        splitWords(phonetic_matcher_->normalizeText(variation), words);
+        if (words.empty()) continue;
         
-        if (statistics_.total_attempts > 0) {
-            statistics_.average_confidence = 
-                (statistics_.average_confidence * (statistics_.total_attempts - 1) + 
-                 best_confidence) / statistics_.total_attempts;
+        variation_words.emplace_back();
+        for (const std::string& word : words) {
+            variation_words.back().push_back(internWord(word));
+        }
+    }
+    
+    uint32_t phases = activePhases(command);
+    for (size_t phase = 0; phase < FLIGHT_PHASE_COUNT; ++phase) {
+        if (phases & (1u << phase)) {
+            indexCommand(grammars_[phase], command, variation_words);
+        }
+    }
+}
+
+void CommandRecognizer::indexCommand(Grammar& grammar, const CommandDefinition& command,
+                                     const std::vector<std::vector<uint32_t>>& variation_words) {
+    std::vector<PhraseNode>& trie = grammar.trie;
+    
+    // Every node on a variation's path can now reach this command
+    auto reach = [&trie, &command](uint32_t node) {
+        PhraseNode& n = trie[node];
+        if (n.subtree_command.empty()) {
+            n.subtree_command = command.command_id;
+        } else if (n.subtree_command != command.command_id) {
+            n.subtree_ambiguous = true;
+        }
+    };
+    
+    for (const auto& words : variation_words) {
+        uint32_t node = 0;
+        reach(node);
+        for (uint32_t id : words) {
+            // Only this grammar's words are matched against speech
+            if (grammar.has_word.size() <= id) {
+                grammar.has_word.resize(vocabulary_.size());
+            }
+            if (!grammar.has_word[id]) {
+                grammar.has_word[id] = true;
+                const VocabularyWord& word = vocabulary_[id];
+                grammar.phonetic_index.emplace(word.phonetic_key, id);
+                size_t length = word.pattern.length();
+                if (grammar.words_by_length.size() <= length) {
+                    grammar.words_by_length.resize(length + 1);
+                }
+                grammar.words_by_length[length].push_back(id);
+            }
+            
+            auto child = trie[node].children.find(id);
+            if (child != trie[node].children.end()) {
+                node = child->second;
+            } else {
+                uint32_t created = static_cast<uint32_t>(trie.size());
+                trie.emplace_back();
+                trie[node].children[id] = created;
+                node = created;
+            }
+            reach(node);
         }
         
-        // Find most common command
-        if (!command_usage_count_.empty()) {
-            auto max_it = std::max_element(
-                command_usage_count_.begin(), command_usage_count_.end(),
-                [](const auto& a, const auto& b) { return a.second < b.second; });
-            statistics_.most_common_command_count = max_it->second;
+        // Several commands sharing a phrase resolve to the first id
+        std::string& owner = trie[node].command_id;
+        if (owner.empty() || command.command_id < owner) {
+            owner = command.command_id;
         }
     }
+}
+
+void CommandRecognizer::rebuildPhraseIndex() {
+    grammars_.fill(Grammar{});
+    for (const auto& [cmd_id, cmd_def] : commands_) {
+        indexCommand(cmd_def);
+    }
     
-    return result;
+    // Paths of an utterance in progress named the old nodes
+    if (utterance_.active) {
+        beginUtterance();
+    }
+}
+
+uint32_t CommandRecognizer::internWord(const std::string& word) {
+    auto it = word_ids_.find(word);
+    if (it != word_ids_.end()) {
+        return it->second;
+    }
+    
+    uint32_t id = static_cast<uint32_t>(vocabulary_.size());
+    vocabulary_.push_back({EditDistancePattern(word), PhoneticMatcher::phoneticKey(word)});
+    word_ids_.emplace(word, id);
+    return id;
+}
+
+void CommandRecognizer::matchWord(const std::string& spoken, std::vector<WordMatch>& matches) const {
+    matches.clear();
+    const Grammar& grammar = activeGrammar();
+    const int spoken_length = static_cast<int>(spoken.length());
+    
+    // Words that sound alike count as one edit apart at most
+    std::string key = PhoneticMatcher::phoneticKey(spoken);
+    auto sounds_alike = key.empty() ? std::make_pair(grammar.phonetic_index.end(), grammar.phonetic_index.end())
+                                    : grammar.phonetic_index.equal_range(key);
+    for (auto it = sounds_alike.first; it != sounds_alike.second; ++it) {
+        const EditDistancePattern& word = vocabulary_[it->second].pattern;
+        int length = std::max(spoken_length, static_cast<int>(word.length()));
+        matches.push_back({it->second, word.text() == spoken ? 0 : 1, length});
+    }
+    size_t phonetic_count = matches.size();
+    
+    // Then every word whose length leaves room for a close enough spelling
+    for (size_t length = 1; length < grammar.words_by_length.size(); ++length) {
+        int longer = std::max(spoken_length, static_cast<int>(length));
+        int max_distance = static_cast<int>(longer * (1.0 - MIN_WORD_SIMILARITY));
+        if (std::abs(spoken_length - static_cast<int>(length)) > max_distance) continue;
+        
+        for (uint32_t id : grammar.words_by_length[length]) {
+            auto end = matches.begin() + phonetic_count;
+            if (std::find_if(matches.begin(), end,
+                             [id](const WordMatch& m) { return m.word == id; }) != end) {
+                continue;
+            }
+            int distance = vocabulary_[id].pattern.distance(spoken, max_distance);
+            if (distance <= max_distance) {
+                matches.push_back({id, distance, longer});
+            }
+        }
+    }
 }
 
 CommandDefinition CommandRecognizer::getCommand(const std::string& command_id) const {
@@ -231,13 +741,9 @@ std::vector<CommandDefinition> CommandRecognizer::getCommandsInCategory(
     CommandCategory category) const {
     
     std::vector<CommandDefinition> result;
-    
-    for (const auto& [cmd_id, cmd_def] : commands_) {
-        if (determineCategory(cmd_id) == category) {
-            result.push_back(cmd_def);
-        }
+    for (const std::string& cmd_id : category_commands_[static_cast<size_t>(category)]) {
+        result.push_back(commands_.at(cmd_id));
     }
-    
     return result;
 }
 
@@ -317,7 +823,8 @@ void CommandRecognizer::initializeRunwayCommands() {
         "Approach from Direction",
         {"approach from", "land from", "come in from"},
         {{"direction", "bearing"}},
-        false
+        false,
+        flightPhaseBit(FlightPhase::CRUISE) | ARRIVAL_PHASES
     });
     
     registerCommand({
@@ -335,7 +842,8 @@ void CommandRecognizer::initializeFlightSystemCommands() {
         "Preflight Checklist",
         {"preflight checklist", "start preflight", "run preflight"},
         {},
-        true
+        true,
+        DEPARTURE_PHASES
     });
     
     registerCommand({
@@ -343,7 +851,8 @@ void CommandRecognizer::initializeFlightSystemCommands() {
         "Weight and Balance Check",
         {"weight and balance", "check weight", "cg check"},
         {},
-        false
+        false,
+        DEPARTURE_PHASES
     });
     
     registerCommand({
@@ -351,7 +860,8 @@ void CommandRecognizer::initializeFlightSystemCommands() {
         "Calculate V-Speeds",
         {"calculate v speeds", "compute v speeds", "v one"},
         {},
-        false
+        false,
+        DEPARTURE_PHASES | flightPhaseBit(FlightPhase::TAKEOFF)
     });
     
     registerCommand({
@@ -359,7 +869,8 @@ void CommandRecognizer::initializeFlightSystemCommands() {
         "Stabilized Approach Check",
         {"stabilized approach", "approach check", "stable approach"},
         {},
-        false
+        false,
+        ARRIVAL_PHASES
     });
 }
 
@@ -434,9 +945,16 @@ void CommandRecognizer::initializeEmergencyCommands() {
 CommandCategory CommandRecognizer::determineCategory(
     const std::string& command_id) const {
     
+    // Before the others, so EMERGENCY_LANDING is not a runway command
+    if (command_id.find("EMERGENCY") != std::string::npos ||
+        command_id.find("MAYDAY") != std::string::npos ||
+        command_id.find("DIVERT") != std::string::npos) {
+        return CommandCategory::EMERGENCY;
+    }
+    
     if (command_id.find("SET_") != std::string::npos ||
         command_id.find("NAVIGATE") != std::string::npos ||
-        command_id.find("DIRECT") != std::string::npos) {
+        command_id.find("DIRECT_") != std::string::npos) {
         return CommandCategory::NAVIGATION;
     }
     
@@ -459,11 +977,6 @@ CommandCategory CommandRecognizer::determineCategory(
         return CommandCategory::STATUS_QUERY;
     }
     
-    if (command_id.find("EMERGENCY") != std::string::npos ||
-        command_id.find("MAYDAY") != std::string::npos) {
-        return CommandCategory::EMERGENCY;
-    }
-    
     return CommandCategory::UNKNOWN;
 }
 
@@ -694,9 +1207,35 @@ RecognitionResult SpeechRecognizer::recognizeSpeech(
 RecognitionResult SpeechRecognizer::recognizeText(const std::string& text) {
     RecognitionResult result = command_recognizer_->recognize(text);
     last_result_ = result;
+    if (latency_tracer_) {
+        latency_tracer_->mark(VoiceStage::RECOGNIZED);
+    }
     return result;
 }
 
+void SpeechRecognizer::beginUtterance() {
+    command_recognizer_->beginUtterance();
+}
+
+PartialRecognition SpeechRecognizer::recognizePartialText(const std::string& partial_text) {
+    PartialRecognition partial = command_recognizer_->updateUtterance(partial_text);
+    if (partial.committed) {
+        last_result_ = partial.result;
+        if (latency_tracer_) {
+            latency_tracer_->mark(VoiceStage::RECOGNIZED);
+        }
+    }
+    return partial;
+}
+
+RecognitionResult SpeechRecognizer::endUtterance(const std::string& final_text) {
+    last_result_ = command_recognizer_->endUtterance(final_text);
+    if (latency_tracer_) {
+        latency_tracer_->mark(VoiceStage::RECOGNIZED);   // no-op if a partial already committed
+    }
+    return last_result_;
+}
+
 bool SpeechRecognizer::requiresConfirmation(const std::string& command_id) const {
     auto cmd = command_recognizer_->getCommand(command_id);
     return cmd.requires_confirmation;
@@ -741,6 +1280,10 @@ CommandRecognizer::RecognitionStats SpeechRecognizer::getStatistics() const {
     return command_recognizer_->getStatistics();
 }
 
+void SpeechRecognizer::setFlightPhase(FlightPhase phase) {
+    command_recognizer_->setFlightPhase(phase);
+}
+
 void SpeechRecognizer::setConfidenceThreshold(double threshold) {
     command_recognizer_->setConfidenceThreshold(threshold);
 }
@@ -16,6 +16,16 @@
 #include <cmath>
 #include <algorithm>
 #include <iomanip>
+#include <limits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace AICopilot {
 
@@ -24,11 +34,48 @@ namespace AICopilot {
 // ============================================================================
 
 SRTMTile::SRTMTile()
-    : tile_lat_(0), tile_lon_(0), is_loaded_(false) {
+    : SRTMTile(0, 0) {
 }
 
 SRTMTile::SRTMTile(int latitude, int longitude)
-    : tile_lat_(latitude), tile_lon_(longitude), is_loaded_(false) {
+    : tile_lat_(latitude), tile_lon_(longitude), samples_(SRTM_SIZE), is_loaded_(false),
+      mapped_data_(nullptr), mapped_size_(0), file_handle_(nullptr), mapping_handle_(nullptr),
+      pyramid_built_(false) {
+}
+
+SRTMTile::~SRTMTile() {
+    Unload();
+}
+
+void SRTMTile::Unload() {
+    if (mapped_data_ != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(mapped_data_);
+        CloseHandle(static_cast<HANDLE>(mapping_handle_));
+        CloseHandle(static_cast<HANDLE>(file_handle_));
+#else
+        munmap(const_cast<uint8_t*>(mapped_data_), mapped_size_);
+#endif
+    }
+    mapped_data_ = nullptr;
+    mapped_size_ = 0;
+    file_handle_ = nullptr;
+    mapping_handle_ = nullptr;
+    
+    data_.clear();
+    data_.shrink_to_fit();
+    is_loaded_ = false;
+    
+    std::lock_guard<std::mutex> lock(pyramid_mutex_);
+    pyramid_.clear();
+    pyramid_dims_.clear();
+    pyramid_built_.store(false, std::memory_order_release);
+}
+
+int SRTMTile::SamplesForFileSize(size_t file_size) {
+    if (file_size == static_cast<size_t>(TILE_SIZE_BYTES)) return SRTM_SIZE;
+    if (file_size == static_cast<size_t>(SRTM3_TILE_SIZE_BYTES)) return SRTM3_SIZE;
+    return 0;
 }
 
 std::string SRTMTile::GetFileName(int latitude, int longitude) {
@@ -89,23 +136,90 @@ bool SRTMTile::LoadFromFile(const std::string& filepath) {
     size_t file_size = file.tellg();
     file.seekg(0, std::ios::beg);
     
-    if (file_size != TILE_SIZE_BYTES) {
+    int samples = SamplesForFileSize(file_size);
+    if (samples == 0) {
         return false;  // Invalid file size
     }
     
-    // Read all data
-    data_.resize(SRTM_SIZE * SRTM_SIZE);
-    std::vector<uint8_t> buffer(file_size);
+    Unload();
+    
+    // Read straight into the sample buffer, no staging copy
+    std::vector<int16_t> data(static_cast<size_t>(samples) * samples);
+    if (!file.read(reinterpret_cast<char*>(data.data()), file_size)) {
+        return false;
+    }
+    
+    // Convert big-endian to native format in place (simple enough to auto-vectorize)
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.data());
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = BytesToInt16BE(bytes + i * 2);
+    }
+    
+    data_ = std::move(data);
+    samples_ = samples;
+    is_loaded_ = true;
+    return true;
+}
+
+bool SRTMTile::MapFile(const std::string& filepath) {
+    Unload();
+    
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    
+    LARGE_INTEGER size;
+    int samples = GetFileSizeEx(file, &size) ? SamplesForFileSize(static_cast<size_t>(size.QuadPart)) : 0;
+    if (samples == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+    
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    
+    file_handle_ = file;
+    mapping_handle_ = mapping;
+    mapped_size_ = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
     
-    if (!file.read(reinterpret_cast<char*>(buffer.data()), file_size)) {
+    struct stat st;
+    int samples = (fstat(fd, &st) == 0) ? SamplesForFileSize(static_cast<size_t>(st.st_size)) : 0;
+    if (samples == 0) {
+        close(fd);
         return false;
     }
     
-    // Convert big-endian to native format
-    for (int i = 0; i < SRTM_SIZE * SRTM_SIZE; ++i) {
-        data_[i] = BytesToInt16BE(&buffer[i * 2]);
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // the mapping keeps the file referenced
+    if (view == MAP_FAILED) {
+        return false;
     }
     
+    // Terrain lookups hop around the tile
+    madvise(view, static_cast<size_t>(st.st_size), MADV_RANDOM);
+    mapped_size_ = static_cast<size_t>(st.st_size);
+#endif
+    
+    mapped_data_ = static_cast<const uint8_t*>(view);
+    samples_ = samples;
     is_loaded_ = true;
     return true;
 }
@@ -117,46 +231,170 @@ bool SRTMTile::LoadFromCompressed(const std::string& filepath) {
 }
 
 double SRTMTile::GetElevation(double row, double col) const {
+    double elevation = 0.0;
+    GetElevations(&row, &col, 1, &elevation);
+    return elevation;
+}
+
+void SRTMTile::GetElevations(const double* rows, const double* cols, size_t count,
+                             double* out_m) const {
     if (!is_loaded_) {
-        return 0.0;
+        std::fill(out_m, out_m + count, 0.0);
+        return;
     }
     
-    // Clamp to valid range
-    row = std::max(0.0, std::min(static_cast<double>(SRTM_SIZE - 1), row));
-    col = std::max(0.0, std::min(static_cast<double>(SRTM_SIZE - 1), col));
+    if (mapped_data_ != nullptr) {
+        const uint8_t* bytes = mapped_data_;
+        SampleBilinear(rows, cols, count, out_m,
+                       [bytes](size_t index) { return BytesToInt16BE(bytes + index * 2); });
+    } else {
+        const int16_t* samples = data_.data();
+        SampleBilinear(rows, cols, count, out_m,
+                       [samples](size_t index) { return samples[index]; });
+    }
+}
+
+template <typename Fetch>
+void SRTMTile::SampleBilinear(const double* rows, const double* cols, size_t count,
+                              double* out_m, Fetch fetch) const {
+    const double max_index = static_cast<double>(samples_ - 1);
+    const int max_base = samples_ - 2;
+    const size_t stride = static_cast<size_t>(samples_);
+    
+    for (size_t i = 0; i < count; ++i) {
+        // Clamp to valid range, then pick the cell so the far edge stays inside it
+        double row = std::max(0.0, std::min(max_index, rows[i]));
+        double col = std::max(0.0, std::min(max_index, cols[i]));
+        int row_int = std::min(static_cast<int>(row), max_base);
+        int col_int = std::min(static_cast<int>(col), max_base);
+        double row_frac = row - row_int;
+        double col_frac = col - col_int;
+        
+        // Get 4 surrounding values; voids count as sea level
+        size_t base = static_cast<size_t>(row_int) * stride + col_int;
+        int16_t r0c0 = fetch(base);
+        int16_t r0c1 = fetch(base + 1);
+        int16_t r1c0 = fetch(base + stride);
+        int16_t r1c1 = fetch(base + stride + 1);
+        double v00 = (r0c0 == VOID_VALUE) ? 0.0 : r0c0;
+        double v10 = (r0c1 == VOID_VALUE) ? 0.0 : r0c1;
+        double v01 = (r1c0 == VOID_VALUE) ? 0.0 : r1c0;
+        double v11 = (r1c1 == VOID_VALUE) ? 0.0 : r1c1;
+        
+        // x runs along columns, y along rows
+        out_m[i] = Interpolate(v00, v10, v01, v11, col_frac, row_frac);
+    }
+}
+
+int16_t SRTMTile::GetRawElevation(int row, int col) const {
+    if (!is_loaded_ || row < 0 || row >= samples_ || col < 0 || col >= samples_) {
+        return VOID_VALUE;
+    }
     
-    // Get integer and fractional parts
-    int row_int = static_cast<int>(row);
-    int col_int = static_cast<int>(col);
-    double row_frac = row - row_int;
-    double col_frac = col - col_int;
+    size_t index = static_cast<size_t>(row) * samples_ + col;
+    if (mapped_data_ != nullptr) {
+        return BytesToInt16BE(mapped_data_ + index * 2);
+    }
+    return data_[index];
+}
+
+void SRTMTile::BuildPyramid() const {
+    if (pyramid_built_.load(std::memory_order_acquire)) {
+        return;
+    }
     
-    // Ensure we don't access out of bounds
-    row_int = std::min(row_int, SRTM_SIZE - 2);
-    col_int = std::min(col_int, SRTM_SIZE - 2);
+    std::lock_guard<std::mutex> lock(pyramid_mutex_);
+    if (pyramid_built_.load(std::memory_order_relaxed) || !is_loaded_) {
+        return;
+    }
     
-    // Get 4 surrounding values
-    int16_t v00 = GetRawElevation(row_int, col_int);
-    int16_t v10 = GetRawElevation(row_int + 1, col_int);
-    int16_t v01 = GetRawElevation(row_int, col_int + 1);
-    int16_t v11 = GetRawElevation(row_int + 1, col_int + 1);
+    // Leaf level: one range per PYRAMID_BLOCK x PYRAMID_BLOCK block of samples
+    int dim = (samples_ + PYRAMID_BLOCK - 1) / PYRAMID_BLOCK;
+    std::vector<SRTMElevationRange> leaves(static_cast<size_t>(dim) * dim);
+    for (int row = 0; row < samples_; ++row) {
+        SRTMElevationRange* block_row = &leaves[static_cast<size_t>(row / PYRAMID_BLOCK) * dim];
+        size_t row_base = static_cast<size_t>(row) * samples_;
+        for (int col = 0; col < samples_; ++col) {
+            int16_t value = (mapped_data_ != nullptr) ? BytesToInt16BE(mapped_data_ + (row_base + col) * 2)
+                                                      : data_[row_base + col];
+            if (value == VOID_VALUE) continue;
+            SRTMElevationRange& block = block_row[col / PYRAMID_BLOCK];
+            if (value < block.min_m) block.min_m = value;
+            if (value > block.max_m) block.max_m = value;
+        }
+    }
     
-    // Handle void values
-    if (v00 == VOID_VALUE) v00 = 0;
-    if (v10 == VOID_VALUE) v10 = 0;
-    if (v01 == VOID_VALUE) v01 = 0;
-    if (v11 == VOID_VALUE) v11 = 0;
+    std::vector<std::vector<SRTMElevationRange>> levels;
+    std::vector<int> dims;
+    levels.push_back(std::move(leaves));
+    dims.push_back(dim);
+    
+    // Each level above merges 2x2 nodes of the one below, up to a single root
+    while (dim > 1) {
+        int parent_dim = (dim + 1) / 2;
+        const std::vector<SRTMElevationRange>& child = levels.back();
+        std::vector<SRTMElevationRange> parent(static_cast<size_t>(parent_dim) * parent_dim);
+        for (int r = 0; r < dim; ++r) {
+            for (int c = 0; c < dim; ++c) {
+                parent[static_cast<size_t>(r / 2) * parent_dim + c / 2].Merge(
+                    child[static_cast<size_t>(r) * dim + c]);
+            }
+        }
+        levels.push_back(std::move(parent));
+        dims.push_back(parent_dim);
+        dim = parent_dim;
+    }
     
-    // Bilinear interpolation
-    return Interpolate(v00, v10, v01, v11, col_frac, row_frac);
+    pyramid_ = std::move(levels);
+    pyramid_dims_ = std::move(dims);
+    pyramid_built_.store(true, std::memory_order_release);
 }
 
-int16_t SRTMTile::GetRawElevation(int row, int col) const {
-    if (!is_loaded_ || row < 0 || row >= SRTM_SIZE || col < 0 || col >= SRTM_SIZE) {
-        return VOID_VALUE;
+SRTMElevationRange SRTMTile::GetElevationRange(int row0, int col0, int row1, int col1) const {
+    SRTMElevationRange range;
+    if (!is_loaded_) {
+        return range;
+    }
+    BuildPyramid();
+    
+    row0 = std::max(row0, 0);
+    col0 = std::max(col0, 0);
+    row1 = std::min(row1, samples_ - 1);
+    col1 = std::min(col1, samples_ - 1);
+    if (row0 > row1 || col0 > col1) {
+        return range;
     }
     
-    return data_[row * SRTM_SIZE + col];
+    int top = static_cast<int>(pyramid_.size()) - 1;
+    QueryPyramid(top, 0, 0, row0 / PYRAMID_BLOCK, col0 / PYRAMID_BLOCK,
+                 row1 / PYRAMID_BLOCK, col1 / PYRAMID_BLOCK, range);
+    return range;
+}
+
+void SRTMTile::QueryPyramid(int level, int node_row, int node_col,
+                            int brow0, int bcol0, int brow1, int bcol1,
+                            SRTMElevationRange& range) const {
+    // Leaf blocks covered by this node
+    int first_row = node_row << level;
+    int first_col = node_col << level;
+    int last_row = ((node_row + 1) << level) - 1;
+    int last_col = ((node_col + 1) << level) - 1;
+    
+    if (last_row < brow0 || first_row > brow1 || last_col < bcol0 || first_col > bcol1) {
+        return;  // Disjoint
+    }
+    if (level == 0 ||
+        (first_row >= brow0 && last_row <= brow1 && first_col >= bcol0 && last_col <= bcol1)) {
+        range.Merge(pyramid_[level][static_cast<size_t>(node_row) * pyramid_dims_[level] + node_col]);
+        return;
+    }
+    
+    int child_dim = pyramid_dims_[level - 1];
+    for (int r = node_row * 2; r <= node_row * 2 + 1 && r < child_dim; ++r) {
+        for (int c = node_col * 2; c <= node_col * 2 + 1 && c < child_dim; ++c) {
+            QueryPyramid(level - 1, r, c, brow0, bcol0, brow1, bcol1, range);
+        }
+    }
 }
 
 bool SRTMTile::IsVoid(int row, int col) const {
@@ -164,18 +402,27 @@ bool SRTMTile::IsVoid(int row, int col) const {
 }
 
 double SRTMTile::GetFillPercentage() const {
-    if (!is_loaded_ || data_.empty()) {
+    if (!is_loaded_) {
         return 0.0;
     }
     
-    int void_count = 0;
-    for (int16_t value : data_) {
-        if (value == VOID_VALUE) {
-            void_count++;
+    size_t count = static_cast<size_t>(samples_) * samples_;
+    size_t void_count = 0;
+    if (mapped_data_ != nullptr) {
+        for (size_t i = 0; i < count; ++i) {
+            if (BytesToInt16BE(mapped_data_ + i * 2) == VOID_VALUE) {
+                void_count++;
+            }
+        }
+    } else {
+        for (int16_t value : data_) {
+            if (value == VOID_VALUE) {
+                void_count++;
+            }
         }
     }
     
-    double fill = static_cast<double>(data_.size() - void_count) / data_.size();
+    double fill = static_cast<double>(count - void_count) / count;
     return fill * 100.0;
 }
 
@@ -204,14 +451,31 @@ double SRTMTile::Interpolate(double v00, double v10, double v01, double v11,
 // SRTMLoader Implementation
 // ============================================================================
 
-SRTMLoader::SRTMLoader(const std::string& srtm_data_path)
-    : srtm_data_path_(srtm_data_path) {
+SRTMLoader::SRTMLoader(const std::string& srtm_data_path, SRTMTileMode mode)
+    : srtm_data_path_(srtm_data_path), tile_mode_(mode),
+      tile_cache_(mode == SRTMTileMode::MAPPED ? DEFAULT_MAPPED_BUDGET : DEFAULT_COPY_BUDGET) {
 }
 
 SRTMLoader::~SRTMLoader() {
     ClearCache();
 }
 
+namespace {
+
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+// Elevation in feet at a coordinate inside a loaded tile
+double SampleTileFeet(const SRTMTile& tile, double latitude, double longitude) {
+    // Convert lat/lon to row/col within tile
+    double row = (tile.GetLatitude() + 1.0 - latitude) * (tile.GetSamplesPerSide() - 1);
+    double col = (longitude - tile.GetLongitude()) * (tile.GetSamplesPerSide() - 1);
+    
+    // Convert meters to feet (1 meter = 3.28084 feet)
+    return tile.GetElevation(row, col) * 3.28084;
+}
+
+}  // namespace
+
 double SRTMLoader::GetElevation(double latitude, double longitude) {
     // Get tile
     auto tile = GetTile(latitude, longitude);
@@ -219,18 +483,197 @@ double SRTMLoader::GetElevation(double latitude, double longitude) {
         return 0.0;
     }
     
-    // Convert lat/lon to row/col within tile
+    return SampleTileFeet(*tile, latitude, longitude);
+}
+
+void SRTMLoader::GetElevations(const LatLon* points, size_t count, double* out_ft) {
+    // Tiles resolved so far in this batch; a profile or area touches only a few
+    std::vector<std::pair<TileKey, std::shared_ptr<SRTMTile>>> tiles;
+    
+    constexpr size_t CHUNK = 256;
+    double rows[CHUNK];
+    double cols[CHUNK];
+    
+    size_t begin = 0;
+    while (begin < count) {
+        int tile_lat = static_cast<int>(std::floor(points[begin].latitude));
+        int tile_lon = static_cast<int>(std::floor(points[begin].longitude));
+        TileKey key = packTileKey(tile_lat, tile_lon);
+        
+        // Extend the run of consecutive points in the same tile
+        size_t end = begin + 1;
+        while (end < count && end - begin < CHUNK &&
+               static_cast<int>(std::floor(points[end].latitude)) == tile_lat &&
+               static_cast<int>(std::floor(points[end].longitude)) == tile_lon) {
+            ++end;
+        }
+        
+        auto found = std::find_if(tiles.begin(), tiles.end(),
+                                  [key](const auto& entry) { return entry.first == key; });
+        if (found == tiles.end()) {
+            tiles.emplace_back(key, LoadTile(tile_lat, tile_lon));
+            found = tiles.end() - 1;
+        }
+        
+        const SRTMTile* tile = found->second.get();
+        size_t run = end - begin;
+        if (tile == nullptr || !tile->IsLoaded()) {
+            std::fill(out_ft + begin, out_ft + end, 0.0);
+        } else {
+            double scale = tile->GetSamplesPerSide() - 1;
+            for (size_t i = 0; i < run; ++i) {
+                rows[i] = (tile_lat + 1.0 - points[begin + i].latitude) * scale;
+                cols[i] = (points[begin + i].longitude - tile_lon) * scale;
+            }
+            tile->GetElevations(rows, cols, run, out_ft + begin);
+            for (size_t i = 0; i < run; ++i) {
+                out_ft[begin + i] *= 3.28084;
+            }
+        }
+        begin = end;
+    }
+}
+
+std::vector<double> SRTMLoader::GetElevations(const std::vector<LatLon>& points) {
+    std::vector<double> elevations(points.size());
+    GetElevations(points.data(), points.size(), elevations.data());
+    return elevations;
+}
+
+TileLookupStatus SRTMLoader::TryGetElevation(double latitude, double longitude, double& elevation_ft) {
     int tile_lat = static_cast<int>(std::floor(latitude));
     int tile_lon = static_cast<int>(std::floor(longitude));
+    TileKey key = packTileKey(tile_lat, tile_lon);
+    
+    std::shared_ptr<SRTMTile> tile;
+    {
+        auto lock = LockCache();
+        if (missing_tiles_.count(key) != 0) {
+            elevation_ft = 0.0;
+            return TileLookupStatus::NO_DATA;
+        }
+        tile = tile_cache_.find(key);
+    }
     
-    double row = (tile_lat + 1.0 - latitude) * (SRTMTile::SRTM_SIZE - 1);
-    double col = (longitude - tile_lon) * (SRTMTile::SRTM_SIZE - 1);
+    if (!tile) {
+        elevation_ft = PENDING_ELEVATION_FT;
+        return TileLookupStatus::PENDING;
+    }
+    
+    elevation_ft = SampleTileFeet(*tile, latitude, longitude);
+    return TileLookupStatus::READY;
+}
+
+bool SRTMLoader::PrefetchTile(int latitude, int longitude) {
+    TileKey key = packTileKey(latitude, longitude);
+    {
+        auto lock = LockCache();
+        if (tile_cache_.contains(key)) return true;
+        if (missing_tiles_.count(key) != 0) return false;
+    }
     
-    // Get elevation (meters)
-    double elevation_m = tile->GetElevation(row, col);
+    auto tile = LoadTileFromDisk(latitude, longitude);
+    if (!tile) {
+        return false;
+    }
     
-    // Convert meters to feet (1 meter = 3.28084 feet)
-    return elevation_m * 3.28084;
+    // Area queries over this tile should not pay for the pyramid on the flight loop
+    tile->BuildPyramid();
+    return true;
+}
+
+double SRTMLoader::GetCellMaxElevation(double latitude, double longitude) {
+    auto tile = GetTile(latitude, longitude);
+    if (!tile || !tile->IsLoaded()) {
+        return 0.0;
+    }
+    
+    int last = tile->GetSamplesPerSide() - 1;
+    double row = (tile->GetLatitude() + 1.0 - latitude) * last;
+    double col = (longitude - tile->GetLongitude()) * last;
+    int row0 = std::max(0, std::min(static_cast<int>(std::floor(row)), last));
+    int col0 = std::max(0, std::min(static_cast<int>(std::floor(col)), last));
+    int row1 = std::min(row0 + 1, last);
+    int col1 = std::min(col0 + 1, last);
+    
+    // Voids count as sea level, as in GetElevation()
+    int highest = std::numeric_limits<int>::min();
+    for (int r : {row0, row1}) {
+        for (int c : {col0, col1}) {
+            int16_t sample = tile->GetRawElevation(r, c);
+            highest = std::max(highest, sample == SRTMTile::VOID_VALUE ? 0 : static_cast<int>(sample));
+        }
+    }
+    return highest * 3.28084;
+}
+
+double SRTMLoader::GetMaxElevation(double min_lat, double min_lon, double max_lat, double max_lon) {
+    if (min_lat > max_lat) std::swap(min_lat, max_lat);
+    if (min_lon > max_lon) std::swap(min_lon, max_lon);
+    min_lat = std::max(min_lat, -90.0);
+    max_lat = std::min(max_lat, 90.0);
+    
+    SRTMElevationRange range;
+    for (int tile_lat = static_cast<int>(std::floor(min_lat));
+         tile_lat <= static_cast<int>(std::floor(max_lat)); ++tile_lat) {
+        for (int tile_lon = static_cast<int>(std::floor(min_lon));
+             tile_lon <= static_cast<int>(std::floor(max_lon)); ++tile_lon) {
+            auto tile = LoadTile(tile_lat, tile_lon);
+            if (!tile || !tile->IsLoaded()) {
+                continue;
+            }
+            
+            // Row 0 is the northern edge; widen to whole samples so the box is covered
+            double scale = tile->GetSamplesPerSide() - 1;
+            int row0 = static_cast<int>(std::floor((tile_lat + 1.0 - std::min(max_lat, tile_lat + 1.0)) * scale));
+            int row1 = static_cast<int>(std::ceil((tile_lat + 1.0 - std::max(min_lat, static_cast<double>(tile_lat))) * scale));
+            int col0 = static_cast<int>(std::floor((std::max(min_lon, static_cast<double>(tile_lon)) - tile_lon) * scale));
+            int col1 = static_cast<int>(std::ceil((std::min(max_lon, tile_lon + 1.0) - tile_lon) * scale));
+            range.Merge(tile->GetElevationRange(row0, col0, row1, col1));
+        }
+    }
+    
+    return range.IsValid() ? range.max_m * 3.28084 : 0.0;
+}
+
+double SRTMLoader::GetMaxElevationInRadius(double latitude, double longitude, double radius_nm) {
+    double lat_deg = radius_nm / 60.0;
+    double lon_deg = radius_nm / (60.0 * std::max(0.01, std::cos(latitude * DEG_TO_RAD)));
+    return GetMaxElevation(latitude - lat_deg, longitude - lon_deg,
+                           latitude + lat_deg, longitude + lon_deg);
+}
+
+double SRTMLoader::GetMaxElevationAlongPath(double start_lat, double start_lon,
+                                            double end_lat, double end_lon,
+                                            double half_width_nm) {
+    // Cover the corridor with boxes no longer than they are wide
+    double cos_lat = std::max(0.01, std::cos((start_lat + end_lat) * 0.5 * DEG_TO_RAD));
+    double length_nm = std::hypot((end_lat - start_lat) * 60.0, (end_lon - start_lon) * 60.0 * cos_lat);
+    int segments = static_cast<int>(std::ceil(length_nm / std::max(0.1, 2.0 * half_width_nm)));
+    segments = std::max(1, std::min(segments, 64));
+    
+    double lat_pad = half_width_nm / 60.0;
+    double lon_pad = half_width_nm / (60.0 * cos_lat);
+    double highest = 0.0;
+    bool found = false;
+    for (int i = 0; i < segments; ++i) {
+        double f0 = static_cast<double>(i) / segments;
+        double f1 = static_cast<double>(i + 1) / segments;
+        double lat0 = start_lat + (end_lat - start_lat) * f0;
+        double lat1 = start_lat + (end_lat - start_lat) * f1;
+        double lon0 = start_lon + (end_lon - start_lon) * f0;
+        double lon1 = start_lon + (end_lon - start_lon) * f1;
+        double elevation = GetMaxElevation(std::min(lat0, lat1) - lat_pad, std::min(lon0, lon1) - lon_pad,
+                                           std::max(lat0, lat1) + lat_pad, std::max(lon0, lon1) + lon_pad);
+        highest = found ? std::max(highest, elevation) : elevation;
+        found = true;
+    }
+    return highest;
+}
+
+double SRTMLoader::GetMinimumSafeAltitude(double latitude, double longitude,
+                                          double radius_nm, double clearance_ft) {
+    return GetMaxElevationInRadius(latitude, longitude, radius_nm) + clearance_ft;
 }
 
 std::vector<double> SRTMLoader::GetElevationProfile(
@@ -238,22 +681,24 @@ std::vector<double> SRTMLoader::GetElevationProfile(
     double end_lat, double end_lon,
     int num_samples) {
     
-    std::vector<double> profile;
-    
     if (num_samples < 2) {
         num_samples = 10;
     }
     
+    std::vector<LatLon> points(num_samples + 1);
     for (int i = 0; i <= num_samples; ++i) {
         double fraction = static_cast<double>(i) / num_samples;
         
-        double lat = start_lat + (end_lat - start_lat) * fraction;
-        double lon = start_lon + (end_lon - start_lon) * fraction;
-        
-        profile.push_back(GetElevation(lat, lon));
+        points[i].latitude = start_lat + (end_lat - start_lat) * fraction;
+        points[i].longitude = start_lon + (end_lon - start_lon) * fraction;
     }
     
-    return profile;
+    return GetElevations(points);
+}
+
+bool SRTMLoader::HasTile(int latitude, int longitude) {
+    auto tile = LoadTile(latitude, longitude);
+    return tile && tile->IsLoaded();
 }
 
 bool SRTMLoader::IsDataAvailable(double latitude, double longitude) const {
@@ -270,60 +715,94 @@ bool SRTMLoader::IsDataAvailable(double latitude, double longitude) const {
 }
 
 void SRTMLoader::ClearCache() {
+    auto lock = LockCache();
     tile_cache_.clear();
+    missing_tiles_.clear();
+}
+
+int SRTMLoader::GetCacheSize() const {
+    auto lock = LockCache();
+    return static_cast<int>(tile_cache_.size());
+}
+
+void SRTMLoader::SetCacheBudget(size_t bytes) {
+    auto lock = LockCache();
+    tile_cache_.setByteBudget(bytes);
+}
+
+TileCacheStats SRTMLoader::GetCacheStats() const {
+    auto lock = LockCache();
+    TileCacheStats stats = tile_cache_.getStats();
+    stats.lockContentions = cache_contentions_.load(std::memory_order_relaxed);
+    return stats;
 }
 
 size_t SRTMLoader::GetCacheMemoryUsage() const {
+    auto lock = LockCache();
     size_t total = 0;
-    for (const auto& entry : tile_cache_) {
-        if (entry.second) {
-            total += entry.second->GetMemoryUsage();
-        }
-    }
+    tile_cache_.forEach([&total](TileKey, const SRTMTile& tile) {
+        total += tile.GetMemoryUsage();
+    });
     return total;
 }
 
+std::unique_lock<std::mutex> SRTMLoader::LockCache() const {
+    std::unique_lock<std::mutex> lock(cache_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        cache_contentions_.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+    return lock;
+}
+
 std::shared_ptr<SRTMTile> SRTMLoader::LoadTile(int latitude, int longitude) {
-    // Create tile filename
-    std::string filename = SRTMTile::GetFileName(latitude, longitude);
-    
-    // Check cache first
-    auto cache_key = filename;
-    auto cache_it = tile_cache_.find(cache_key);
-    if (cache_it != tile_cache_.end()) {
-        return cache_it->second;
+    // Check cache first; only a miss pays for building the filename
+    TileKey key = packTileKey(latitude, longitude);
+    {
+        auto lock = LockCache();
+        if (auto cached = tile_cache_.find(key)) {
+            return cached;
+        }
+        if (missing_tiles_.count(key) != 0) {
+            return nullptr;
+        }
     }
     
+    return LoadTileFromDisk(latitude, longitude);
+}
+
+std::shared_ptr<SRTMTile> SRTMLoader::LoadTileFromDisk(int latitude, int longitude) {
+    TileKey key = packTileKey(latitude, longitude);
+    
     // Try to load from disk
-    std::string filepath = srtm_data_path_ + "/" + filename;
+    std::string filepath = srtm_data_path_ + "/" + SRTMTile::GetFileName(latitude, longitude);
     auto tile = std::make_shared<SRTMTile>(latitude, longitude);
     
-    if (!tile->LoadFromFile(filepath)) {
+    bool loaded = (tile_mode_ == SRTMTileMode::MAPPED) ? tile->MapFile(filepath)
+                                                        : tile->LoadFromFile(filepath);
+    if (!loaded) {
         // Try compressed version
         if (!tile->LoadFromCompressed(filepath + ".zip")) {
             if (!tile->LoadFromCompressed(filepath + ".gz")) {
-                // Create empty tile
-                return tile;
+                // Remember the hole so later lookups skip the disk
+                auto lock = LockCache();
+                missing_tiles_.insert(key);
+                return nullptr;
             }
         }
     }
     
-    // Check cache size and evict if needed
-    if (tile_cache_.size() >= MAX_CACHED_TILES) {
-        EvictOldestTile();
+    // Add to cache; least recently used tiles are evicted to stay within budget.
+    // Another thread may have loaded the same tile meanwhile; keep the first one.
+    auto lock = LockCache();
+    if (tile_cache_.contains(key)) {
+        return tile_cache_.find(key);
     }
-    
-    // Add to cache
-    tile_cache_[cache_key] = tile;
+    size_t charge = tile->GetMemoryUsage() + tile->GetMappedSize();
+    tile_cache_.insert(key, tile, charge);
     return tile;
 }
 
-void SRTMLoader::EvictOldestTile() {
-    if (!tile_cache_.empty()) {
-        tile_cache_.erase(tile_cache_.begin());
-    }
-}
-
 std::shared_ptr<SRTMTile> SRTMLoader::GetTile(double latitude, double longitude) {
     int tile_lat = static_cast<int>(std::floor(latitude));
     int tile_lon = static_cast<int>(std::floor(longitude));
@@ -4,17 +4,134 @@
 *****************************************************************************/
 
 #include "../include/stabilized_approach.h"
+#include "../include/geodesy.hpp"
 #include <cmath>
 #include <sstream>
 #include <algorithm>
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
 namespace AICopilot {
 
-StabilizedApproachSystem::StabilizedApproachSystem() = default;
+namespace {
+
+enum ApproachCategory : size_t {
+    CATEGORY_SMALL,
+    CATEGORY_TRANSPORT,
+    CATEGORY_HELICOPTER,
+    CATEGORY_COUNT
+};
+
+// Limits per category, in ApproachParameter order: altitude, speed, descent
+// rate and vertical speed deviations, glideslope, localizer, configuration
+constexpr StabilizationThresholds THRESHOLD_TABLE[CATEGORY_COUNT] = {
+    {500.0, {50.0, 10.0, 200.0, StabilizationCriteria::MAX_DESCENT_RATE, 1.0, 1.0, 0.5}},
+    {1000.0, {100.0, 15.0, 300.0, StabilizationCriteria::MAX_DESCENT_RATE, 1.0, 1.0, 0.5}},
+    {100.0, {20.0, 5.0, 100.0, StabilizationCriteria::MAX_DESCENT_RATE, 0.5, 0.5, 0.5}},
+};
+
+constexpr uint32_t ALL_CRITERIA = (1u << APPROACH_PARAMETER_COUNT) - 1;
+
+// 3 degree glidepath
+const double GLIDEPATH_FEET_PER_NM = std::tan(3.0 * Geodesy::DEG_TO_RAD) * 6076.0;
+
+double spanMin(const double* values, size_t count, double low) {
+    for (size_t i = 0; i < count; ++i) low = values[i] < low ? values[i] : low;
+    return low;
+}
+
+double spanMax(const double* values, size_t count, double high) {
+    for (size_t i = 0; i < count; ++i) high = values[i] > high ? values[i] : high;
+    return high;
+}
+
+bool hasCriterion(uint32_t mask, ApproachParameter parameter) {
+    return (mask >> parameter) & 1u;
+}
+
+} // namespace
+
+// ============================================================================
+// ApproachHistory
+// ============================================================================
+
+void ApproachHistory::record(double time, const ApproachSample& sample) {
+    int64_t bin = static_cast<int64_t>(std::floor(time / BIN_SECONDS));
+    if (count_ > 0 && bin <= currentBin_) {
+        // Same bin, or the clock stepped back: widen the newest one
+        size_t newest = (head_ + BIN_COUNT - 1) % BIN_COUNT;
+        for (size_t p = 0; p < APPROACH_PARAMETER_COUNT; ++p) {
+            min_[p][newest] = std::min(min_[p][newest], sample[p]);
+            max_[p][newest] = std::max(max_[p][newest], sample[p]);
+        }
+        return;
+    }
+    
+    // A new bin, plus any skipped since the last sample
+    size_t fresh = count_ == 0 ? 1 : static_cast<size_t>(std::min<int64_t>(bin - currentBin_, BIN_COUNT));
+    for (size_t i = 0; i < fresh; ++i) {
+        for (size_t p = 0; p < APPROACH_PARAMETER_COUNT; ++p) {
+            min_[p][head_] = sample[p];
+            max_[p][head_] = sample[p];
+        }
+        head_ = (head_ + 1) % BIN_COUNT;
+    }
+    count_ = std::min(count_ + fresh, BIN_COUNT);
+    currentBin_ = bin;
+}
+
+void ApproachHistory::clear() {
+    head_ = 0;
+    count_ = 0;
+    currentBin_ = 0;
+}
+
+size_t ApproachHistory::binsFor(double seconds) const {
+    double bins = std::ceil(seconds / BIN_SECONDS - 1e-9);
+    if (bins > static_cast<double>(count_)) return 0;
+    return std::max<size_t>(1, static_cast<size_t>(std::max(bins, 0.0)));
+}
+
+uint32_t ApproachHistory::withinFor(const ApproachSample& limits, double seconds) const {
+    size_t bins = binsFor(seconds);
+    if (bins == 0) return 0;
+    
+    // The last bins are at most two contiguous runs of the ring
+    size_t start = (head_ + BIN_COUNT - bins) % BIN_COUNT;
+    size_t first = std::min(bins, BIN_COUNT - start);
+    size_t second = bins - first;
+    
+    uint32_t mask = 0;
+    for (size_t p = 0; p < APPROACH_PARAMETER_COUNT; ++p) {
+        double low = spanMin(min_[p], second, spanMin(min_[p] + start, first, HUGE_VAL));
+        double high = spanMax(max_[p], second, spanMax(max_[p] + start, first, -HUGE_VAL));
+        mask |= static_cast<uint32_t>(high <= limits[p] && low >= -limits[p]) << p;
+    }
+    return mask;
+}
+
+bool ApproachHistory::aboveFor(ApproachParameter parameter, double limit, double seconds) const {
+    size_t bins = binsFor(seconds);
+    if (bins == 0) return false;
+    size_t start = (head_ + BIN_COUNT - bins) % BIN_COUNT;
+    size_t first = std::min(bins, BIN_COUNT - start);
+    const double* values = min_[parameter];
+    return spanMin(values, bins - first, spanMin(values + start, first, HUGE_VAL)) > limit;
+}
+
+bool ApproachHistory::belowFor(ApproachParameter parameter, double limit, double seconds) const {
+    size_t bins = binsFor(seconds);
+    if (bins == 0) return false;
+    size_t start = (head_ + BIN_COUNT - bins) % BIN_COUNT;
+    size_t first = std::min(bins, BIN_COUNT - start);
+    const double* values = max_[parameter];
+    return spanMax(values, bins - first, spanMax(values + start, first, -HUGE_VAL)) < limit;
+}
+
+// ============================================================================
+// StabilizedApproachSystem
+// ============================================================================
+
+StabilizedApproachSystem::StabilizedApproachSystem()
+    : thresholds_(THRESHOLD_TABLE[CATEGORY_SMALL]) {}
 
 bool StabilizedApproachSystem::initialize(const std::string& aircraftType) {
     aircraftType_ = aircraftType;
@@ -33,6 +150,7 @@ void StabilizedApproachSystem::startApproachMonitoring(
     monitoringActive_ = true;
     currentStage_ = ApproachStage::INITIAL_DESCENT;
     approachProgress_ = 0.0;
+    history_.clear();
 }
 
 StabilizationCriteria StabilizedApproachSystem::updateApproachStatus(
@@ -40,7 +158,17 @@ StabilizationCriteria StabilizedApproachSystem::updateApproachStatus(
     const Position& thresholdPosition,
     double thresholdElevation) {
     
-    StabilizationCriteria criteria;
+    return updateApproachStatus(currentState, thresholdPosition, thresholdElevation,
+                                lastUpdateTime_ + NOMINAL_UPDATE_INTERVAL);
+}
+
+StabilizationCriteria StabilizedApproachSystem::updateApproachStatus(
+    const AircraftState& currentState,
+    const Position& thresholdPosition,
+    double thresholdElevation,
+    double time) {
+    
+    StabilizationCriteria criteria{};
     
     // Calculate height above threshold
     double heightAboveThreshold = currentState.position.altitude - thresholdElevation;
@@ -53,45 +181,52 @@ StabilizationCriteria StabilizedApproachSystem::updateApproachStatus(
     approachProgress_ = 1.0 - (heightAboveThreshold / startHeight);
     approachProgress_ = std::max(0.0, std::min(1.0, approachProgress_));
     
-    // ALTITUDE CRITERIA
-    criteria.altitudeStabilized = validateAltitudeStabilization(currentState, targetAltitude_);
-    criteria.altitudeDeviation = currentState.position.altitude - targetAltitude_;
-    
-    // SPEED CRITERIA
-    criteria.speedStabilized = validateSpeedStabilization(currentState, targetSpeed_);
-    criteria.speedDeviation = currentState.indicatedAirspeed - targetSpeed_;
-    
-    // VERTICAL SPEED CRITERIA
-    criteria.verticalSpeedActual = currentState.verticalSpeed;
-    criteria.verticalSpeedStable = validateDescentRateStabilization(currentState, targetDescentRate_);
-    criteria.descentRateDeviation = std::abs(currentState.verticalSpeed) - std::abs(targetDescentRate_);
-    criteria.descentRateAcceptable = std::abs(currentState.verticalSpeed) <= StabilizationCriteria::MAX_DESCENT_RATE;
-    
-    // GLIDESLOPE CRITERIA
-    // Simplified glideslope calculation (3 degree path is standard)
-    double distanceToThreshold = std::sqrt(
-        std::pow(thresholdPosition.latitude - currentState.position.latitude, 2) +
-        std::pow(thresholdPosition.longitude - currentState.position.longitude, 2)) * 60.0;  // nm
+    ApproachSample sample;
+    sample[PARAM_ALTITUDE_DEVIATION] = currentState.position.altitude - targetAltitude_;
+    sample[PARAM_SPEED_DEVIATION] = currentState.indicatedAirspeed - targetSpeed_;
+    sample[PARAM_DESCENT_RATE_DEVIATION] = std::abs(currentState.verticalSpeed) - std::abs(targetDescentRate_);
+    sample[PARAM_VERTICAL_SPEED] = currentState.verticalSpeed;
     
-    double expectedAltitude = thresholdElevation + (distanceToThreshold * 6076.0 * std::tan(3.0 * M_PI / 180.0));
-    criteria.glideslopeDeviation = (currentState.position.altitude - expectedAltitude) / 100.0;  // Convert to dots
-    criteria.glideslopeEstablished = std::abs(criteria.glideslopeDeviation) <= StabilizationCriteria::MAX_GLIDESLOPE_DEVIATION;
+    // Glideslope from the 3 degree path
+    double distanceToThreshold = Geodesy::flatDistanceNM(
+        thresholdPosition.latitude, thresholdPosition.longitude,
+        currentState.position.latitude, currentState.position.longitude);
+    double expectedAltitude = thresholdElevation + distanceToThreshold * GLIDEPATH_FEET_PER_NM;
+    sample[PARAM_GLIDESLOPE_DEVIATION] = (currentState.position.altitude - expectedAltitude) / 100.0;  // Convert to dots
     
-    // LOCALIZER CRITERIA (if ILS available)
+    // Localizer (if ILS available)
     double courseDiff = currentState.heading - thresholdPosition.heading;
     if (courseDiff > 180.0) courseDiff -= 360.0;
     if (courseDiff < -180.0) courseDiff += 360.0;
-    criteria.localizerDeviation = courseDiff / 2.5;  // Convert to dots
-    criteria.localizerEstablished = std::abs(criteria.localizerDeviation) <= StabilizationCriteria::MAX_LOCALIZER_DEVIATION;
+    sample[PARAM_LOCALIZER_DEVIATION] = courseDiff / 2.5;  // Convert to dots
     
-    // CONFIGURATION CRITERIA
+    // Configuration: approach flaps are > 50%
     criteria.gearDown = currentState.gearDown;
-    criteria.flapsCorrect = currentState.flapsPosition > 50;  // Assume approach flaps are > 50%
+    criteria.flapsCorrect = currentState.flapsPosition > 50;
     criteria.lightsOn = true;  // Simplified - would check actual light status
-    criteria.configurationCorrect = criteria.gearDown && criteria.flapsCorrect && criteria.lightsOn;
+    sample[PARAM_CONFIGURATION] = criteria.gearDown && criteria.flapsCorrect && criteria.lightsOn ? 0.0 : 1.0;
     
-    // OVERALL STABILIZATION
-    criteria.fullyStabilized = isFullyStabilized(criteria);
+    // Every criterion in one pass over the limits
+    uint32_t met = evaluateCriteria(sample, thresholds_.limits);
+    
+    criteria.altitudeDeviation = sample[PARAM_ALTITUDE_DEVIATION];
+    criteria.altitudeStabilized = hasCriterion(met, PARAM_ALTITUDE_DEVIATION);
+    criteria.speedDeviation = sample[PARAM_SPEED_DEVIATION];
+    criteria.speedStabilized = hasCriterion(met, PARAM_SPEED_DEVIATION);
+    criteria.verticalSpeedActual = currentState.verticalSpeed;
+    criteria.verticalSpeedStable = hasCriterion(met, PARAM_DESCENT_RATE_DEVIATION);
+    criteria.descentRateDeviation = sample[PARAM_DESCENT_RATE_DEVIATION];
+    criteria.descentRateAcceptable = hasCriterion(met, PARAM_VERTICAL_SPEED);
+    criteria.glideslopeDeviation = sample[PARAM_GLIDESLOPE_DEVIATION];
+    criteria.glideslopeEstablished = hasCriterion(met, PARAM_GLIDESLOPE_DEVIATION);
+    criteria.localizerDeviation = sample[PARAM_LOCALIZER_DEVIATION];
+    criteria.localizerEstablished = hasCriterion(met, PARAM_LOCALIZER_DEVIATION);
+    criteria.configurationCorrect = hasCriterion(met, PARAM_CONFIGURATION);
+    criteria.fullyStabilized = met == ALL_CRITERIA;
+    
+    history_.record(time, sample);
+    lastSample_ = sample;
+    lastUpdateTime_ = time;
     
     return criteria;
 }
@@ -115,31 +250,61 @@ bool StabilizedApproachSystem::isMinimumlyStabilized(const StabilizationCriteria
            criteria.configurationCorrect;
 }
 
+bool StabilizedApproachSystem::isStableFor(double seconds) const {
+    return stableCriteriaFor(seconds) == ALL_CRITERIA;
+}
+
+uint32_t StabilizedApproachSystem::stableCriteriaFor(double seconds) const {
+    return history_.withinFor(thresholds_.limits, seconds);
+}
+
 std::vector<GoAroundTrigger> StabilizedApproachSystem::evaluateGoAroundTriggers(
     const AircraftState& state,
     double thresholdElevation) {
     
     std::vector<GoAroundTrigger> triggers;
+    triggers.reserve(5);
     double heightAboveThreshold = state.position.altitude - thresholdElevation;
     
+    // With enough history a trigger must have held for the persistence time
+    bool persistent = history_.coveredSeconds() >= GO_AROUND_PERSISTENCE;
+    auto confirm = [persistent](GoAroundTrigger trigger, const char* pending, bool held) {
+        if (trigger.triggered && persistent && !held) {
+            trigger.triggered = false;
+            trigger.reason = pending;
+        }
+        return trigger;
+    };
+    const double window = GO_AROUND_PERSISTENCE;
+    
     // Altitude trigger
-    triggers.push_back(checkAltitudeGoAround(heightAboveThreshold, targetAltitude_, state.position.altitude));
+    triggers.push_back(confirm(checkAltitudeGoAround(heightAboveThreshold, targetAltitude_, state.position.altitude),
+                               "Altitude go-around", history_.aboveFor(PARAM_ALTITUDE_DEVIATION, 100.0, window)));
     
     // Speed trigger
-    triggers.push_back(checkSpeedGoAround(state, targetSpeed_));
+    triggers.push_back(confirm(checkSpeedGoAround(state, targetSpeed_),
+                               "Speed go-around", history_.aboveFor(PARAM_SPEED_DEVIATION, 20.0, window)));
     
     // Descent rate trigger
-    triggers.push_back(checkDescentRateGoAround(state.verticalSpeed, targetDescentRate_));
-    
-    // Glideslope trigger
-    // Calculate glideslope deviation
-    double expectedAltitude = thresholdElevation + heightAboveThreshold * std::tan(3.0 * M_PI / 180.0);
-    double glideslopeDeviation = (state.position.altitude - expectedAltitude) / 100.0;
-    triggers.push_back(checkGlideslopeGoAround(glideslopeDeviation, heightAboveThreshold));
-    
-    // Localizer trigger
-    double localizerDeviation = 0.0;  // Would calculate from actual heading vs required
-    triggers.push_back(checkLocalizerGoAround(localizerDeviation, heightAboveThreshold));
+    triggers.push_back(confirm(checkDescentRateGoAround(state.verticalSpeed, targetDescentRate_),
+                               "Descent rate go-around",
+                               history_.belowFor(PARAM_VERTICAL_SPEED, -StabilizationCriteria::MAX_DESCENT_RATE, window) ||
+                               history_.aboveFor(PARAM_VERTICAL_SPEED, StabilizationCriteria::MAX_DESCENT_RATE, window)));
+    
+    // Glideslope and localizer from the last status update, once there is one
+    double glideslopeDeviation = lastSample_[PARAM_GLIDESLOPE_DEVIATION];
+    double localizerDeviation = lastSample_[PARAM_LOCALIZER_DEVIATION];
+    if (history_.empty()) {
+        double expectedAltitude = thresholdElevation + heightAboveThreshold * std::tan(3.0 * Geodesy::DEG_TO_RAD);
+        glideslopeDeviation = (state.position.altitude - expectedAltitude) / 100.0;
+        localizerDeviation = 0.0;
+    }
+    triggers.push_back(confirm(checkGlideslopeGoAround(glideslopeDeviation, heightAboveThreshold),
+                               "Glideslope go-around", history_.aboveFor(PARAM_GLIDESLOPE_DEVIATION, 1.0, window)));
+    triggers.push_back(confirm(checkLocalizerGoAround(localizerDeviation, heightAboveThreshold),
+                               "Localizer go-around",
+                               history_.aboveFor(PARAM_LOCALIZER_DEVIATION, 1.5, window) ||
+                               history_.belowFor(PARAM_LOCALIZER_DEVIATION, -1.5, window)));
     
     return triggers;
 }
@@ -262,14 +427,9 @@ void StabilizedApproachSystem::reset() {
     targetDescentRate_ = 0.0;
     currentStage_ = ApproachStage::INITIAL_DESCENT;
     approachProgress_ = 0.0;
-}
-
-ApproachStage StabilizedApproachSystem::getCurrentStage() const {
-    return currentStage_;
-}
-
-double StabilizedApproachSystem::getApproachProgress() const {
-    return approachProgress_;
+    history_.clear();
+    lastSample_ = ApproachSample{};
+    lastUpdateTime_ = 0.0;
 }
 
 // PRIVATE METHODS
@@ -290,73 +450,29 @@ void StabilizedApproachSystem::updateApproachStage(double heightAboveThreshold)
     }
 }
 
-bool StabilizedApproachSystem::validateAltitudeStabilization(const AircraftState& state,
-                                                           double targetAltitude) {
-    return std::abs(state.position.altitude - targetAltitude) <= allowedAltitudeDeviation_;
-}
-
-bool StabilizedApproachSystem::validateSpeedStabilization(const AircraftState& state,
-                                                        double targetSpeed) {
-    return std::abs(state.indicatedAirspeed - targetSpeed) <= allowedSpeedDeviation_;
-}
-
-bool StabilizedApproachSystem::validateDescentRateStabilization(const AircraftState& state,
-                                                              double targetDescentRate) {
-    return std::abs(std::abs(state.verticalSpeed) - std::abs(targetDescentRate)) <= allowedDescentRateDeviation_;
-}
-
-bool StabilizedApproachSystem::validateFlightPathStabilization(const AircraftState& state,
-                                                             double glideslopeDeviation) {
-    return std::abs(glideslopeDeviation) <= allowedGlideslopeDeviation_;
-}
-
-bool StabilizedApproachSystem::validateAircraftConfiguration(const AircraftState& state) {
-    return state.gearDown && state.flapsPosition > 50;
+uint32_t StabilizedApproachSystem::evaluateCriteria(const ApproachSample& sample, const ApproachSample& limits) {
+    uint32_t mask = 0;
+    for (size_t p = 0; p < APPROACH_PARAMETER_COUNT; ++p) {
+        mask |= static_cast<uint32_t>(std::abs(sample[p]) <= limits[p]) << p;
+    }
+    return mask;
 }
 
 void StabilizedApproachSystem::configureThresholdsForAircraft() {
+    ApproachCategory category = CATEGORY_SMALL;  // Default thresholds
     if (aircraftType_.find("Cessna") != std::string::npos ||
         aircraftType_.find("172") != std::string::npos ||
         aircraftType_.find("208") != std::string::npos) {
-        configureSmallAircraftThresholds();
+        category = CATEGORY_SMALL;
     } else if (aircraftType_.find("737") != std::string::npos ||
                aircraftType_.find("320") != std::string::npos ||
                aircraftType_.find("A380") != std::string::npos) {
-        configureTransportCategoryThresholds();
+        category = CATEGORY_TRANSPORT;
     } else if (aircraftType_.find("helicopter") != std::string::npos ||
                aircraftType_.find("heli") != std::string::npos) {
-        configureHelicopterThresholds();
-    } else {
-        // Default thresholds
-        configureSmallAircraftThresholds();
+        category = CATEGORY_HELICOPTER;
     }
-}
-
-void StabilizedApproachSystem::configureSmallAircraftThresholds() {
-    minStabilizationAltitude_ = 500.0;      // feet AGL
-    allowedAltitudeDeviation_ = 50.0;       // feet
-    allowedSpeedDeviation_ = 10.0;          // knots
-    allowedDescentRateDeviation_ = 200.0;   // fpm
-    allowedGlideslopeDeviation_ = 1.0;      // dots
-    allowedLocalizerDeviation_ = 1.0;       // dots
-}
-
-void StabilizedApproachSystem::configureTransportCategoryThresholds() {
-    minStabilizationAltitude_ = 1000.0;     // feet AGL
-    allowedAltitudeDeviation_ = 100.0;      // feet
-    allowedSpeedDeviation_ = 15.0;          // knots
-    allowedDescentRateDeviation_ = 300.0;   // fpm
-    allowedGlideslopeDeviation_ = 1.0;      // dots
-    allowedLocalizerDeviation_ = 1.0;       // dots
-}
-
-void StabilizedApproachSystem::configureHelicopterThresholds() {
-    minStabilizationAltitude_ = 100.0;      // feet AGL
-    allowedAltitudeDeviation_ = 20.0;       // feet
-    allowedSpeedDeviation_ = 5.0;           // knots
-    allowedDescentRateDeviation_ = 100.0;   // fpm
-    allowedGlideslopeDeviation_ = 0.5;      // dots
-    allowedLocalizerDeviation_ = 0.5;       // dots
+    thresholds_ = THRESHOLD_TABLE[category];
 }
 
 GoAroundTrigger StabilizedApproachSystem::checkAltitudeGoAround(
@@ -364,7 +480,7 @@ GoAroundTrigger StabilizedApproachSystem::checkAltitudeGoAround(
     double targetAltitude,
     double actualAltitude) {
     
-    GoAroundTrigger trigger;
+    GoAroundTrigger trigger{};
     trigger.reason = "Altitude go-around";
     trigger.heightAboveThreshold = heightAboveThreshold;
     trigger.targetAltitude = targetAltitude;
@@ -384,7 +500,7 @@ GoAroundTrigger StabilizedApproachSystem::checkSpeedGoAround(
     const AircraftState& state,
     double targetSpeed) {
     
-    GoAroundTrigger trigger;
+    GoAroundTrigger trigger{};
     trigger.reason = "Speed go-around";
     trigger.speedVsTarget = state.indicatedAirspeed - targetSpeed;
     trigger.triggered = false;
@@ -402,14 +518,14 @@ GoAroundTrigger StabilizedApproachSystem::checkDescentRateGoAround(
     double actualDescentRate,
     double expectedDescentRate) {
     
-    GoAroundTrigger trigger;
+    GoAroundTrigger trigger{};
     trigger.reason = "Descent rate go-around";
     trigger.actualDescentRate = actualDescentRate;
     trigger.expectedDescentRate = expectedDescentRate;
     trigger.triggered = false;
     
     // Go-around if descent rate excessive
-    if (std::abs(actualDescentRate) > MAX_DESCENT_RATE) {
+    if (std::abs(actualDescentRate) > StabilizationCriteria::MAX_DESCENT_RATE) {
         trigger.reason = "Descent rate excessive";
         trigger.triggered = true;
     }
@@ -421,7 +537,7 @@ GoAroundTrigger StabilizedApproachSystem::checkGlideslopeGoAround(
     double glideslopeDeviation,
     double heightAboveThreshold) {
     
-    GoAroundTrigger trigger;
+    GoAroundTrigger trigger{};
     trigger.reason = "Glideslope go-around";
     trigger.triggered = false;
     
@@ -438,7 +554,7 @@ GoAroundTrigger StabilizedApproachSystem::checkLocalizerGoAround(
     double localizerDeviation,
     double heightAboveThreshold) {
     
-    GoAroundTrigger trigger;
+    GoAroundTrigger trigger{};
     trigger.reason = "Localizer go-around";
     trigger.triggered = false;
     
@@ -17,12 +17,134 @@
 
 #include "system_monitor.hpp"
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <numeric>
 #include <sstream>
 #include <cmath>
 
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#include <tlhelp32.h>
+#include <pdh.h>
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
+
 namespace AICopilot {
 
+namespace {
+
+// Cumulative process counters; rates come from differences between reads
+struct ProcessCounters {
+    double cpuSeconds = 0.0;        // user + kernel, all threads
+    uint64_t residentBytes = 0;
+    uint64_t physicalBytes = 0;
+    uint32_t threadCount = 0;
+};
+
+#ifdef _WIN32
+
+double fileTimeSeconds(const FILETIME& ft) {
+    ULARGE_INTEGER ticks;
+    ticks.LowPart = ft.dwLowDateTime;
+    ticks.HighPart = ft.dwHighDateTime;
+    return ticks.QuadPart / 1e7;   // 100 ns units
+}
+
+ProcessCounters readProcessCounters() {
+    ProcessCounters counters;
+    HANDLE process = GetCurrentProcess();
+
+    FILETIME created, exited, kernel, user;
+    if (GetProcessTimes(process, &created, &exited, &kernel, &user)) {
+        counters.cpuSeconds = fileTimeSeconds(kernel) + fileTimeSeconds(user);
+    }
+
+    PROCESS_MEMORY_COUNTERS memory;
+    if (GetProcessMemoryInfo(process, &memory, sizeof(memory))) {
+        counters.residentBytes = memory.WorkingSetSize;
+    }
+
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status)) {
+        counters.physicalBytes = status.ullTotalPhys;
+    }
+
+    HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+    if (snapshot != INVALID_HANDLE_VALUE) {
+        DWORD self = GetCurrentProcessId();
+        THREADENTRY32 entry;
+        entry.dwSize = sizeof(entry);
+        for (BOOL more = Thread32First(snapshot, &entry); more; more = Thread32Next(snapshot, &entry)) {
+            if (entry.th32OwnerProcessID == self) counters.threadCount++;
+        }
+        CloseHandle(snapshot);
+    }
+    return counters;
+}
+
+#else
+
+ProcessCounters readProcessCounters() {
+    ProcessCounters counters;
+
+    timespec cpu;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu) == 0) {
+        counters.cpuSeconds = cpu.tv_sec + cpu.tv_nsec / 1e9;
+    }
+
+    uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    counters.physicalBytes = static_cast<uint64_t>(sysconf(_SC_PHYS_PAGES)) * pageSize;
+
+    std::ifstream statm("/proc/self/statm");
+    uint64_t totalPages = 0, residentPages = 0;
+    if (statm >> totalPages >> residentPages) {
+        counters.residentBytes = residentPages * pageSize;
+    }
+
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 8, "Threads:") == 0) {
+            counters.threadCount = static_cast<uint32_t>(std::strtoul(line.c_str() + 8, nullptr, 10));
+            break;
+        }
+    }
+    return counters;
+}
+
+// Cumulative busy milliseconds (io_ticks, field 13) of each block device
+std::vector<uint64_t> readDiskTicksMs() {
+    std::vector<uint64_t> ticks;
+    std::ifstream diskstats("/proc/diskstats");
+    std::string line;
+    while (std::getline(diskstats, line)) {
+        unsigned major, minor;
+        char name[64];
+        unsigned long long f[10];
+        if (std::sscanf(line.c_str(), "%u %u %63s %llu %llu %llu %llu %llu %llu %llu %llu %llu %llu",
+                        &major, &minor, name, &f[0], &f[1], &f[2], &f[3], &f[4], &f[5],
+                        &f[6], &f[7], &f[8], &f[9]) == 13) {
+            ticks.push_back(f[9]);
+        }
+    }
+    return ticks;
+}
+
+#endif
+
+} // namespace
+
+
 SystemMonitor::SystemMonitor()
     : initialized_(false),
       detailedMonitoring_(false),
@@ -30,9 +152,13 @@ SystemMonitor::SystemMonitor()
       totalQueries_(0),
       totalErrors_(0) {
     startTime_ = std::chrono::steady_clock::now();
+    latency_.reset(new LatencyTrack[SYSTEM_COMPONENT_COUNT]);
+    for (auto& bytes : sourcedMemory_) {
+        bytes.store(NO_SOURCE, std::memory_order_relaxed);
+    }
     
     // Initialize component health tracking
-    componentHealth_.resize(8);
+    componentHealth_.resize(SYSTEM_COMPONENT_COUNT);
     for (size_t i = 0; i < componentHealth_.size(); ++i) {
         componentHealth_[i].component = static_cast<SystemComponent>(i);
         componentHealth_[i].status = SystemHealth::HEALTHY;
@@ -42,24 +168,41 @@ SystemMonitor::SystemMonitor()
         componentHealth_[i].averageLatency = 0.0;
         componentHealth_[i].errorRate = 0.0;
     }
+    
+    // Baseline for the first rates; until the sampler runs, samples are on demand
+    refreshResourceSample();
 }
 
 SystemMonitor::~SystemMonitor() {
     shutdown();
+    stopResourceSampler();
+#ifdef _WIN32
+    if (diskQuery_) {
+        PdhCloseQuery(static_cast<PDH_HQUERY>(diskQuery_));
+    }
+#endif
 }
 
 bool SystemMonitor::initialize() {
     initialized_ = true;
     startTime_ = std::chrono::steady_clock::now();
+    startResourceSampler();
     return true;
 }
 
 void SystemMonitor::shutdown() {
     if (initialized_) {
         initialized_ = false;
+        stopResourceSampler();
         componentHealth_.clear();
         metricsHistory_.clear();
-        latencyHistory_.clear();
+        for (size_t i = 0; i < SYSTEM_COMPONENT_COUNT; ++i) {
+            LatencyTrack& track = latency_[i];
+            track.histogram.reset();
+            track.recentHead.store(0, std::memory_order_relaxed);
+            track.averageLatency.store(0.0, std::memory_order_relaxed);
+            track.queryBase.store(0, std::memory_order_relaxed);
+        }
         alerts_.clear();
     }
 }
@@ -70,7 +213,13 @@ void SystemMonitor::shutdown() {
 
 void SystemMonitor::updateComponentHealth(const ComponentHealth& health) {
     if (static_cast<size_t>(health.component) < componentHealth_.size()) {
-        componentHealth_[static_cast<size_t>(health.component)] = health;
+        size_t idx = static_cast<size_t>(health.component);
+        componentHealth_[idx] = health;
+        
+        // Reported counts and latency become the base later recordings build on
+        LatencyTrack& track = latency_[idx];
+        track.queryBase.store(health.queryCount - track.histogram.count(), std::memory_order_relaxed);
+        track.averageLatency.store(health.averageLatency, std::memory_order_relaxed);
         
         // Check for degradation and generate alert if needed
         if (health.status != SystemHealth::HEALTHY) {
@@ -83,7 +232,7 @@ void SystemMonitor::updateComponentHealth(const ComponentHealth& health) {
 ComponentHealth SystemMonitor::getComponentHealth(SystemComponent component) const {
     size_t idx = static_cast<size_t>(component);
     if (idx < componentHealth_.size()) {
-        return componentHealth_[idx];
+        return componentSnapshot(idx);
     }
     
     ComponentHealth empty;
@@ -106,7 +255,7 @@ SystemMonitor::HealthReport SystemMonitor::getHealthReport() const {
     
     report.overallHealth = determineOverallHealth();
     report.healthScore = calculateHealthScore();
-    report.components = componentHealth_;
+    report.components = componentSnapshots();
     
     if (report.healthScore < 80.0) {
         report.recommendations.push_back("Monitor system performance closely");
@@ -118,6 +267,15 @@ SystemMonitor::HealthReport SystemMonitor::getHealthReport() const {
         report.recommendations.push_back("Review component error logs immediately");
     }
     
+    DegradationState degradation = getDegradationState();
+    if (degradation.level > 0) {
+        std::string steps;
+        for (const std::string& step : degradation.activeSteps) {
+            steps += (steps.empty() ? "" : ", ") + step;
+        }
+        report.recommendations.push_back("Tick budget exceeded; running degraded (" + steps + ")");
+    }
+    
     return report;
 }
 
@@ -126,27 +284,25 @@ SystemMonitor::HealthReport SystemMonitor::getHealthReport() const {
 // ============================================================
 
 void SystemMonitor::recordQueryLatency(SystemComponent component, double latencyMs) {
-    totalQueries_++;
+    totalQueries_.fetch_add(1, std::memory_order_relaxed);
     
     size_t idx = static_cast<size_t>(component);
-    if (idx < componentHealth_.size()) {
-        componentHealth_[idx].queryCount++;
-        
-        // Update average latency (exponential moving average)
-        double alpha = 0.1;  // Weight for new value
-        componentHealth_[idx].averageLatency =
-            (alpha * latencyMs) + ((1 - alpha) * componentHealth_[idx].averageLatency);
+    if (idx >= SYSTEM_COMPONENT_COUNT) {
+        return;
     }
+    LatencyTrack& track = latency_[idx];
+    track.histogram.record(latencyMs);
     
-    // Store in history for trending
-    if (latencyHistory_.size() <= static_cast<size_t>(component)) {
-        latencyHistory_.resize(static_cast<size_t>(component) + 1);
+    // Exponential moving average
+    const double alpha = 0.1;  // Weight for new value
+    double average = track.averageLatency.load(std::memory_order_relaxed);
+    while (!track.averageLatency.compare_exchange_weak(
+               average, alpha * latencyMs + (1 - alpha) * average, std::memory_order_relaxed)) {
     }
     
-    latencyHistory_[idx].push_back(latencyMs);
-    if (latencyHistory_[idx].size() > 600) {  // Keep last 10 minutes at 1 sample/sec
-        latencyHistory_[idx].erase(latencyHistory_[idx].begin());
-    }
+    // Recent samples for trending
+    uint64_t slot = track.recentHead.fetch_add(1, std::memory_order_relaxed);
+    track.recent[slot % TREND_SAMPLES].store(latencyMs, std::memory_order_relaxed);
 }
 
 void SystemMonitor::recordError(SystemComponent component, const std::string& errorMsg) {
@@ -175,7 +331,8 @@ SystemMetrics SystemMonitor::getSystemMetrics() const {
     double totalLatency = 0.0;
     uint32_t componentCount = 0;
     
-    for (const auto& comp : componentHealth_) {
+    std::vector<ComponentHealth> components = componentSnapshots();
+    for (const auto& comp : components) {
         totalCpu += comp.cpuUsage;
         totalMemory += comp.memoryUsage;
         totalQueries += comp.queryCount;
@@ -190,7 +347,7 @@ SystemMetrics SystemMonitor::getSystemMetrics() const {
     metrics.averageLatency = (componentCount > 0) ? totalLatency / componentCount : 0.0;
     metrics.queriesPerSecond = totalQueries;
     metrics.systemHealthScore = calculateHealthScore();
-    metrics.componentMetrics = componentHealth_;
+    metrics.componentMetrics = std::move(components);
     
     return metrics;
 }
@@ -199,38 +356,53 @@ PerformanceProfile SystemMonitor::getComponentPerformanceProfile(SystemComponent
     PerformanceProfile profile = {0};
     
     size_t idx = static_cast<size_t>(component);
-    if (idx >= latencyHistory_.size() || latencyHistory_[idx].empty()) {
+    if (idx >= SYSTEM_COMPONENT_COUNT || idx >= componentHealth_.size()) {
         return profile;
     }
     
-    const auto& latencies = latencyHistory_[idx];
-    
-    profile.minLatency = *std::min_element(latencies.begin(), latencies.end());
-    profile.maxLatency = *std::max_element(latencies.begin(), latencies.end());
-    profile.averageLatency = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
-    
-    // Calculate percentiles
-    std::vector<double> sorted = latencies;
-    std::sort(sorted.begin(), sorted.end());
+    HdrHistogram latencies = latency_[idx].histogram.snapshot();
+    if (latencies.count() == 0) {
+        return profile;
+    }
     
-    profile.p95Latency = sorted[static_cast<size_t>(sorted.size() * 0.95)];
-    profile.p99Latency = sorted[static_cast<size_t>(sorted.size() * 0.99)];
+    profile.minLatency = latencies.minMs();
+    profile.maxLatency = latencies.maxMs();
+    profile.averageLatency = latencies.meanMs();
+    profile.p95Latency = latencies.percentileMs(0.95);
+    profile.p99Latency = latencies.percentileMs(0.99);
     
-    profile.operationsPerSecond = componentHealth_[idx].queryCount;
+    profile.operationsPerSecond = componentSnapshot(idx).queryCount;
     profile.cacheHitRate = 65.0;  // Estimated
     
     return profile;
 }
 
+HdrHistogram SystemMonitor::getLatencyHistogram(SystemComponent component) const {
+    size_t idx = static_cast<size_t>(component);
+    if (idx >= SYSTEM_COMPONENT_COUNT) {
+        return HdrHistogram();
+    }
+    return latency_[idx].histogram.snapshot();
+}
+
 SystemMonitor::PerformanceTrend SystemMonitor::getPerformanceTrend(SystemComponent component) const {
     PerformanceTrend trend;
+    trend.isImproving = false;
+    trend.isDegrading = false;
     
     size_t idx = static_cast<size_t>(component);
-    if (idx >= latencyHistory_.size() || latencyHistory_[idx].empty()) {
+    if (idx >= SYSTEM_COMPONENT_COUNT) {
         return trend;
     }
     
-    trend.latencyOverTime = latencyHistory_[idx];
+    // Oldest retained sample first
+    const LatencyTrack& track = latency_[idx];
+    uint64_t head = track.recentHead.load(std::memory_order_relaxed);
+    uint64_t retained = std::min<uint64_t>(head, TREND_SAMPLES);
+    trend.latencyOverTime.reserve(retained);
+    for (uint64_t i = head - retained; i < head; ++i) {
+        trend.latencyOverTime.push_back(track.recent[i % TREND_SAMPLES].load(std::memory_order_relaxed));
+    }
     
     // Determine if improving or degrading
     if (trend.latencyOverTime.size() >= 2) {
@@ -251,55 +423,199 @@ SystemMonitor::PerformanceTrend SystemMonitor::getPerformanceTrend(SystemCompone
     return trend;
 }
 
+void SystemMonitor::reportDegradation(const std::vector<std::string>& activeSteps, const std::string& message) {
+    {
+        std::lock_guard<std::mutex> lock(degradationMutex_);
+        degradation_.level = activeSteps.size();
+        degradation_.activeSteps = activeSteps;
+        degradation_.changes++;
+    }
+    generateAlert(SystemComponent::PERFORMANCE_OPTIMIZER,
+                  activeSteps.empty() ? SystemHealth::HEALTHY : SystemHealth::DEGRADED, message);
+}
+
+SystemMonitor::DegradationState SystemMonitor::getDegradationState() const {
+    std::lock_guard<std::mutex> lock(degradationMutex_);
+    return degradation_;
+}
+
 // ============================================================
 // RESOURCE MONITORING
 // ============================================================
 
 SystemMonitor::ResourceUtilization SystemMonitor::getResourceUtilization() const {
     ResourceUtilization util = {0};
+    ResourceSample sample = latestSample();
     
-    double totalCpu = 0.0;
-    for (const auto& comp : componentHealth_) {
-        totalCpu += comp.cpuUsage;
-    }
-    
-    util.cpuPercentage = totalCpu;
-    util.memoryPercentage = (100 * 52428800) / (100 * 2000000000);  // Used / Available
-    util.diskIOPercentage = 15.0;  // Estimated
+    util.cpuPercentage = sample.cpuPercentage;
+    util.memoryPercentage = sample.physicalBytes > 0
+        ? 100.0 * sample.residentBytes / sample.physicalBytes : 0.0;
+    util.diskIOPercentage = sample.diskIOPercentage;
     util.networkIOPercentage = 8.0;  // Estimated
-    util.threadCount = 16;
-    util.activeQueries = totalQueries_;
+    util.threadCount = sample.threadCount;
+    util.activeQueries = static_cast<uint32_t>(totalQueries_.load(std::memory_order_relaxed));
+    util.residentBytes = sample.residentBytes;
+    util.physicalMemoryBytes = sample.physicalBytes;
     
     return util;
 }
 
+void SystemMonitor::refreshResourceSample() {
+    std::lock_guard<std::mutex> lock(sampleMutex_);
+    
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - lastSampleTime_).count();
+    bool haveBaseline = sample_.valid && elapsed > 0.0;
+    
+    ProcessCounters counters = readProcessCounters();
+    if (haveBaseline) {
+        unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        double busy = (counters.cpuSeconds - lastCpuSeconds_) / (elapsed * cores);
+        sample_.cpuPercentage = std::clamp(busy * 100.0, 0.0, 100.0);
+    }
+    lastCpuSeconds_ = counters.cpuSeconds;
+    sample_.residentBytes = counters.residentBytes;
+    sample_.physicalBytes = counters.physicalBytes;
+    sample_.threadCount = counters.threadCount;
+    
+#ifdef _WIN32
+    if (!diskQuery_) {
+        PDH_HQUERY query = nullptr;
+        PDH_HCOUNTER counter = nullptr;
+        if (PdhOpenQueryA(nullptr, 0, &query) == ERROR_SUCCESS) {
+            if (PdhAddEnglishCounterA(query, "\\PhysicalDisk(*)\\% Idle Time", 0, &counter) == ERROR_SUCCESS) {
+                PdhCollectQueryData(query);
+                diskQuery_ = query;
+                diskCounter_ = counter;
+            } else {
+                PdhCloseQuery(query);
+            }
+        }
+    } else if (PdhCollectQueryData(static_cast<PDH_HQUERY>(diskQuery_)) == ERROR_SUCCESS) {
+        DWORD bufferBytes = 0, items = 0;
+        PDH_HCOUNTER counter = static_cast<PDH_HCOUNTER>(diskCounter_);
+        if (PdhGetFormattedCounterArrayA(counter, PDH_FMT_DOUBLE, &bufferBytes, &items, nullptr) == PDH_MORE_DATA) {
+            std::vector<char> buffer(bufferBytes);
+            auto* values = reinterpret_cast<PDH_FMT_COUNTERVALUE_ITEM_A*>(buffer.data());
+            if (PdhGetFormattedCounterArrayA(counter, PDH_FMT_DOUBLE, &bufferBytes, &items, values) == ERROR_SUCCESS) {
+                double busiest = 0.0;
+                for (DWORD i = 0; i < items; ++i) {
+                    if (std::strcmp(values[i].szName, "_Total") == 0) continue;
+                    busiest = std::max(busiest, 100.0 - values[i].FmtValue.doubleValue);
+                }
+                sample_.diskIOPercentage = std::clamp(busiest, 0.0, 100.0);
+            }
+        }
+    }
+#else
+    std::vector<uint64_t> ticks = readDiskTicksMs();
+    if (haveBaseline && ticks.size() == lastDiskTicksMs_.size()) {
+        uint64_t busiestMs = 0;
+        for (size_t i = 0; i < ticks.size(); ++i) {
+            busiestMs = std::max(busiestMs, ticks[i] - std::min(ticks[i], lastDiskTicksMs_[i]));
+        }
+        sample_.diskIOPercentage = std::clamp(busiestMs / 10.0 / elapsed, 0.0, 100.0);
+    }
+    lastDiskTicksMs_ = std::move(ticks);
+#endif
+    
+    std::error_code ec;
+    std::filesystem::space_info space = std::filesystem::space(std::filesystem::current_path(ec), ec);
+    if (!ec && space.capacity > 0) {
+        sample_.diskFreeFraction = static_cast<double>(space.available) / space.capacity;
+    }
+    
+    // Registered byte counts, by category and by component
+    std::array<uint64_t, SYSTEM_COMPONENT_COUNT> componentBytes{};
+    std::array<bool, SYSTEM_COMPONENT_COUNT> sourced{};
+    std::fill(std::begin(sample_.categoryBytes), std::end(sample_.categoryBytes), 0);
+    for (const MemorySourceEntry& entry : memorySources_) {
+        uint64_t bytes = entry.source();
+        size_t component = static_cast<size_t>(entry.component);
+        sample_.categoryBytes[static_cast<size_t>(entry.category)] += bytes;
+        componentBytes[component] += bytes;
+        sourced[component] = true;
+    }
+    for (size_t i = 0; i < SYSTEM_COMPONENT_COUNT; ++i) {
+        sourcedMemory_[i].store(sourced[i] ? componentBytes[i] : NO_SOURCE, std::memory_order_relaxed);
+    }
+    
+    memoryTrend_[memoryTrendCount_ % MEMORY_TREND_SAMPLES] = sample_.residentBytes;
+    memoryTrendCount_++;
+    lastSampleTime_ = now;
+    sample_.valid = true;
+}
+
+void SystemMonitor::registerMemorySource(SystemComponent component, MemoryCategory category, MemorySource source) {
+    if (static_cast<size_t>(component) >= SYSTEM_COMPONENT_COUNT || !source) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sampleMutex_);
+        memorySources_.push_back({component, category, std::move(source)});
+    }
+    refreshResourceSample();
+}
+
 SystemMonitor::MemoryBreakdown SystemMonitor::getMemoryBreakdown() const {
     MemoryBreakdown breakdown = {0};
+    ResourceSample sample = latestSample();
     
-    uint64_t totalUsed = 0;
-    for (const auto& comp : componentHealth_) {
-        totalUsed += comp.memoryUsage;
-    }
+    breakdown.cacheMemory = sample.categoryBytes[static_cast<size_t>(MemoryCategory::CACHE)];
+    breakdown.bufferMemory = sample.categoryBytes[static_cast<size_t>(MemoryCategory::BUFFER)];
+    breakdown.queryMemory = sample.categoryBytes[static_cast<size_t>(MemoryCategory::QUERY)];
     
-    breakdown.cacheMemory = (totalUsed * 40) / 100;      // 40% cache
-    breakdown.bufferMemory = (totalUsed * 20) / 100;     // 20% buffers
-    breakdown.queryMemory = (totalUsed * 25) / 100;      // 25% queries
-    breakdown.systemMemory = (totalUsed * 10) / 100;     // 10% system
-    breakdown.overhead = (totalUsed * 5) / 100;          // 5% overhead
+    breakdown.overhead = sizeof(*this) + SYSTEM_COMPONENT_COUNT * sizeof(LatencyTrack) +
+                         alerts_.capacity() * sizeof(SystemAlert);
+    uint64_t accounted = breakdown.cacheMemory + breakdown.bufferMemory +
+                         breakdown.queryMemory + breakdown.overhead;
+    breakdown.systemMemory = sample.residentBytes > accounted ? sample.residentBytes - accounted : 0;
     
     return breakdown;
 }
 
 SystemMonitor::ExhaustionPrediction SystemMonitor::predictResourceExhaustion() const {
     ExhaustionPrediction prediction;
-    
-    // Simple trend analysis
     ResourceUtilization util = getResourceUtilization();
     
-    prediction.memoryExhaustionRisk = util.memoryPercentage > 85.0;
-    prediction.minutesUntilExhaustion = (util.memoryPercentage > 85.0) ? 15.0 : NAN;
+    // Least-squares slope of resident bytes per sample over the trend window
+    double slopeBytes = 0.0;
+    double freeFraction = 1.0;
+    {
+        std::lock_guard<std::mutex> lock(sampleMutex_);
+        size_t n = std::min(memoryTrendCount_, MEMORY_TREND_SAMPLES);
+        if (n >= 2) {
+            size_t first = memoryTrendCount_ - n;
+            double meanX = (n - 1) / 2.0;
+            double meanY = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                meanY += static_cast<double>(memoryTrend_[(first + i) % MEMORY_TREND_SAMPLES]);
+            }
+            meanY /= n;
+            double num = 0.0, den = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                double dx = i - meanX;
+                num += dx * (memoryTrend_[(first + i) % MEMORY_TREND_SAMPLES] - meanY);
+                den += dx * dx;
+            }
+            slopeBytes = num / den;
+        }
+        freeFraction = sample_.diskFreeFraction;
+    }
+    
+    prediction.minutesUntilExhaustion = NAN;
+    if (slopeBytes > 0.0 && util.physicalMemoryBytes > util.residentBytes) {
+        double samples = (util.physicalMemoryBytes - util.residentBytes) / slopeBytes;
+        prediction.minutesUntilExhaustion =
+            samples * std::chrono::duration<double>(RESOURCE_SAMPLE_INTERVAL).count() / 60.0;
+    }
+    prediction.memoryExhaustionRisk = util.memoryPercentage > 85.0 ||
+        (!std::isnan(prediction.minutesUntilExhaustion) && prediction.minutesUntilExhaustion < 15.0);
+    if (!prediction.memoryExhaustionRisk) {
+        prediction.minutesUntilExhaustion = NAN;
+    }
     prediction.cpuThrottleRisk = util.cpuPercentage > 90.0;
-    prediction.diskFullRisk = util.diskIOPercentage > 95.0;
+    prediction.diskFullRisk = freeFraction < 0.05;
     
     return prediction;
 }
@@ -477,7 +793,7 @@ std::vector<std::string> SystemMonitor::getOptimizationRecommendations() const {
     }
     
     double cacheHit = 0.0;
-    for (const auto& comp : componentHealth_) {
+    for (const auto& comp : componentSnapshots()) {
         if (comp.queryCount > 0) {
             cacheHit = comp.queryCount * 0.65;  // Estimated 65% hit rate
         }
@@ -493,7 +809,7 @@ std::vector<std::string> SystemMonitor::getOptimizationRecommendations() const {
 std::vector<SystemMonitor::Bottleneck> SystemMonitor::analyzeBottlenecks() const {
     std::vector<Bottleneck> bottlenecks;
     
-    for (const auto& comp : componentHealth_) {
+    for (const auto& comp : componentSnapshots()) {
         if (comp.averageLatency > 10.0) {
             Bottleneck bn;
             bn.component = comp.component;
@@ -553,13 +869,69 @@ std::string SystemMonitor::exportSystemReport() const {
 // PRIVATE HELPER METHODS
 // ============================================================
 
+ComponentHealth SystemMonitor::componentSnapshot(size_t index) const {
+    ComponentHealth health = componentHealth_[index];
+    if (index < SYSTEM_COMPONENT_COUNT) {
+        const LatencyTrack& track = latency_[index];
+        health.queryCount = static_cast<uint32_t>(
+            track.queryBase.load(std::memory_order_relaxed) + track.histogram.count());
+        health.averageLatency = track.averageLatency.load(std::memory_order_relaxed);
+        uint64_t sourced = sourcedMemory_[index].load(std::memory_order_relaxed);
+        if (sourced != NO_SOURCE) {
+            health.memoryUsage = sourced;
+        }
+    }
+    return health;
+}
+
+std::vector<ComponentHealth> SystemMonitor::componentSnapshots() const {
+    std::vector<ComponentHealth> components;
+    components.reserve(componentHealth_.size());
+    for (size_t i = 0; i < componentHealth_.size(); ++i) {
+        components.push_back(componentSnapshot(i));
+    }
+    return components;
+}
+
+SystemMonitor::ResourceSample SystemMonitor::latestSample() const {
+    std::lock_guard<std::mutex> lock(sampleMutex_);
+    return sample_;
+}
+
+void SystemMonitor::startResourceSampler() {
+    if (samplerThread_.joinable()) {
+        return;
+    }
+    samplerStop_ = false;
+    samplerThread_ = std::thread([this] {
+        std::unique_lock<std::mutex> lock(sampleMutex_);
+        while (!samplerWake_.wait_for(lock, RESOURCE_SAMPLE_INTERVAL, [this] { return samplerStop_; })) {
+            lock.unlock();
+            refreshResourceSample();
+            lock.lock();
+        }
+    });
+}
+
+void SystemMonitor::stopResourceSampler() {
+    if (!samplerThread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sampleMutex_);
+        samplerStop_ = true;
+    }
+    samplerWake_.notify_all();
+    samplerThread_.join();
+}
+
 double SystemMonitor::calculateHealthScore() const {
     if (componentHealth_.empty()) {
         return 100.0;
     }
     
     double score = 0.0;
-    for (const auto& comp : componentHealth_) {
+    for (const auto& comp : componentSnapshots()) {
         double componentScore = 100.0;
         
         // Deduct for errors
@@ -8,10 +8,70 @@
 *****************************************************************************/
 
 #include "../include/aircraft_systems.h"
+#include <cmath>
 #include <iostream>
 
 namespace AICopilot {
 
+// ============================================================================
+// SystemsStateTracker
+// ============================================================================
+
+namespace {
+
+// Takes `value` as the new reference when it moved past the deadband
+bool moved(double& reference, double value, double deadband) {
+    if (std::abs(value - reference) < deadband) return false;
+    reference = value;
+    return true;
+}
+
+template<typename T>
+bool switched(T& reference, T value) {
+    if (value == reference) return false;
+    reference = value;
+    return true;
+}
+
+} // namespace
+
+uint32_t SystemsStateTracker::update(const AircraftState& state) {
+    if (!primed_) {
+        reported_ = state;
+        primed_ = true;
+        return SYSTEMS_ALL;
+    }
+    
+    uint32_t dirty = SYSTEMS_NONE;
+    AircraftState& r = reported_;
+    
+    if (moved(r.fuelQuantity, state.fuelQuantity, deadbands_.fuelQuantity)) dirty |= SYSTEMS_FUEL;
+    
+    // Engine and electrical checks both depend on RPM and being airborne
+    if (moved(r.engineRPM, state.engineRPM, deadbands_.engineRPM)) dirty |= SYSTEMS_ENGINE | SYSTEMS_ELECTRICAL;
+    if (switched(r.onGround, state.onGround)) dirty |= SYSTEMS_ENGINE | SYSTEMS_ELECTRICAL;
+    
+    // Non-short-circuit: every field that moved must become the reference
+    bool electrical = switched(r.masterBattery, state.masterBattery);
+    electrical |= switched(r.masterAlternator, state.masterAlternator);
+    electrical |= moved(r.batteryVoltage, state.batteryVoltage, deadbands_.voltage);
+    electrical |= moved(r.generatorVoltage, state.generatorVoltage, deadbands_.voltage);
+    electrical |= moved(r.batteryLoad, state.batteryLoad, deadbands_.load);
+    electrical |= moved(r.generatorLoad, state.generatorLoad, deadbands_.load);
+    if (electrical) dirty |= SYSTEMS_ELECTRICAL;
+    
+    bool configuration = switched(r.gearDown, state.gearDown);
+    configuration |= switched(r.flapsPosition, state.flapsPosition);
+    configuration |= switched(r.parkingBrakeSet, state.parkingBrakeSet);
+    if (configuration) dirty |= SYSTEMS_CONFIGURATION;
+    
+    return dirty;
+}
+
+// ============================================================================
+// AircraftSystems
+// ============================================================================
+
 AircraftSystems::AircraftSystems(std::shared_ptr<SimConnectWrapper> simConnect,
                                const AircraftConfig& config)
     : simConnect_(simConnect)
@@ -26,7 +86,8 @@ AircraftSystems::~AircraftSystems() = default;
 
 void AircraftSystems::update() {
     updateState();
-    checkSystems();
+    dirtyMask_ = tracker_.update(currentState_);
+    warningsChanged_ = runChecks(dirtyMask_);
 }
 
 void AircraftSystems::enableAutopilot(bool enable) {
@@ -165,19 +226,48 @@ AutopilotState AircraftSystems::getAutopilotState() const {
 }
 
 bool AircraftSystems::checkSystems() {
-    warnings_.clear();
-    checkFuel();
-    checkEngines();
-    checkElectrical();
+    runChecks(SYSTEMS_ALL);
     return warnings_.empty();
 }
 
-std::vector<std::string> AircraftSystems::getSystemWarnings() {
-    return warnings_;
+bool AircraftSystems::runChecks(uint32_t systems) {
+    bool changed = false;
+    auto run = [&](uint32_t system, std::vector<std::string>& list, void (AircraftSystems::*check)()) {
+        if (!(systems & system)) return;
+        std::vector<std::string> previous;
+        previous.swap(list);
+        (this->*check)();
+        changed |= list != previous;
+    };
+    run(SYSTEMS_FUEL, fuelWarnings_, &AircraftSystems::checkFuel);
+    run(SYSTEMS_ENGINE, engineWarnings_, &AircraftSystems::checkEngines);
+    run(SYSTEMS_ELECTRICAL, electricalWarnings_, &AircraftSystems::checkElectrical);
+    
+    if (changed) {
+        warnings_.clear();
+        warnings_.insert(warnings_.end(), fuelWarnings_.begin(), fuelWarnings_.end());
+        warnings_.insert(warnings_.end(), engineWarnings_.begin(), engineWarnings_.end());
+        warnings_.insert(warnings_.end(), electricalWarnings_.begin(), electricalWarnings_.end());
+    }
+    return changed;
 }
 
 void AircraftSystems::updateState() {
-    currentState_ = simConnect_->getAircraftState();
+    // Re-read only the halves whose version moved; unversioned sources whole
+    uint64_t coreVersion = simConnect_->getStateVersion();
+    uint64_t coldVersion = simConnect_->getColdStateVersion();
+    if (coreVersion == 0 || coldVersion == 0) {
+        currentState_ = simConnect_->getAircraftState();
+        coreVersion_ = 0;
+        coldVersion_ = 0;
+    } else {
+        if (coreVersion != coreVersion_) {
+            simConnect_->getAircraftStateCore(coreVersion_).applyTo(currentState_);
+        }
+        if (coldVersion != coldVersion_) {
+            simConnect_->getAircraftStateCold(coldVersion_).applyTo(currentState_);
+        }
+    }
     autopilotState_ = simConnect_->getAutopilotState();
 }
 
@@ -185,39 +275,39 @@ void AircraftSystems::checkFuel() {
     double fuelPercentage = (currentState_.fuelQuantity / config_.fuelCapacity) * 100.0;
     
     if (fuelPercentage < 10.0) {
-        warnings_.push_back("CRITICAL: Fuel below 10%");
+        fuelWarnings_.push_back("CRITICAL: Fuel below 10%");
     } else if (fuelPercentage < 20.0) {
-        warnings_.push_back("WARNING: Fuel below 20%");
+        fuelWarnings_.push_back("WARNING: Fuel below 20%");
     }
 }
 
 void AircraftSystems::checkEngines() {
     if (currentState_.engineRPM < 100 && !currentState_.onGround) {
-        warnings_.push_back("CRITICAL: Engine failure");
+        engineWarnings_.push_back("CRITICAL: Engine failure");
     }
 }
 
 void AircraftSystems::checkElectrical() {
     // Check if battery master is on
     if (!currentState_.masterBattery && !currentState_.onGround) {
-        warnings_.push_back("CRITICAL: Battery master switch is OFF during flight");
+        electricalWarnings_.push_back("CRITICAL: Battery master switch is OFF during flight");
     }
     
     // Check battery voltage - typical aircraft battery is 12V or 24V
     // Low voltage threshold: < 11V for 12V system, < 22V for 24V system
     if (currentState_.masterBattery) {
         if (currentState_.batteryVoltage < 11.0 && currentState_.batteryVoltage > 0.0) {
-            warnings_.push_back("CRITICAL: Battery voltage critically low (" + 
+            electricalWarnings_.push_back("CRITICAL: Battery voltage critically low (" + 
                               std::to_string(static_cast<int>(currentState_.batteryVoltage)) + "V)");
         } else if (currentState_.batteryVoltage < 12.5 && currentState_.batteryVoltage >= 11.0) {
-            warnings_.push_back("WARNING: Battery voltage low (" + 
+            electricalWarnings_.push_back("WARNING: Battery voltage low (" + 
                               std::to_string(static_cast<int>(currentState_.batteryVoltage)) + "V)");
         } else if (currentState_.batteryVoltage < 22.0 && currentState_.batteryVoltage >= 20.0) {
             // For 24V systems
-            warnings_.push_back("CRITICAL: Battery voltage critically low (" + 
+            electricalWarnings_.push_back("CRITICAL: Battery voltage critically low (" + 
                               std::to_string(static_cast<int>(currentState_.batteryVoltage)) + "V)");
         } else if (currentState_.batteryVoltage < 24.5 && currentState_.batteryVoltage >= 22.0) {
-            warnings_.push_back("WARNING: Battery voltage low (" + 
+            electricalWarnings_.push_back("WARNING: Battery voltage low (" + 
                               std::to_string(static_cast<int>(currentState_.batteryVoltage)) + "V)");
         }
     }
@@ -226,29 +316,29 @@ void AircraftSystems::checkElectrical() {
     if (!currentState_.onGround && currentState_.engineRPM > 800) {
         // Engine is running, alternator should be providing power
         if (!currentState_.masterAlternator) {
-            warnings_.push_back("WARNING: Alternator is OFF with engine running");
+            electricalWarnings_.push_back("WARNING: Alternator is OFF with engine running");
         }
         
         // Check generator voltage output
         if (currentState_.masterAlternator && currentState_.generatorVoltage < 13.5) {
             // For 12V system, alternator should output 13.5-14.5V
             if (currentState_.batteryVoltage < 20.0) { // Assume 12V system
-                warnings_.push_back("WARNING: Alternator output low - possible alternator failure");
+                electricalWarnings_.push_back("WARNING: Alternator output low - possible alternator failure");
             }
         } else if (currentState_.masterAlternator && currentState_.generatorVoltage < 27.0) {
             // For 24V system, alternator should output 27-28.5V
             if (currentState_.batteryVoltage >= 20.0) { // Assume 24V system
-                warnings_.push_back("WARNING: Alternator output low - possible alternator failure");
+                electricalWarnings_.push_back("WARNING: Alternator output low - possible alternator failure");
             }
         }
     }
     
     // Check for excessive electrical load
     if (currentState_.batteryLoad > 60.0) {
-        warnings_.push_back("WARNING: High electrical load (" + 
+        electricalWarnings_.push_back("WARNING: High electrical load (" + 
                           std::to_string(static_cast<int>(currentState_.batteryLoad)) + "A)");
     } else if (currentState_.batteryLoad > 80.0) {
-        warnings_.push_back("CRITICAL: Excessive electrical load (" + 
+        electricalWarnings_.push_back("CRITICAL: Excessive electrical load (" + 
                           std::to_string(static_cast<int>(currentState_.batteryLoad)) + "A) - risk of electrical failure");
     }
     
@@ -256,15 +346,15 @@ void AircraftSystems::checkElectrical() {
     if (!currentState_.onGround && currentState_.masterBattery && currentState_.masterAlternator) {
         // If alternator is on but battery voltage is dropping
         if (currentState_.engineRPM > 1000 && currentState_.batteryVoltage < 12.0 && currentState_.batteryVoltage > 0.0) {
-            warnings_.push_back("CRITICAL: Battery discharging despite alternator running - electrical system failure");
+            electricalWarnings_.push_back("CRITICAL: Battery discharging despite alternator running - electrical system failure");
         } else if (currentState_.engineRPM > 1000 && currentState_.batteryVoltage < 22.0 && currentState_.batteryVoltage >= 20.0) {
-            warnings_.push_back("CRITICAL: Battery discharging despite alternator running - electrical system failure");
+            electricalWarnings_.push_back("CRITICAL: Battery discharging despite alternator running - electrical system failure");
         }
     }
     
     // Check for complete electrical failure
     if (currentState_.masterBattery && currentState_.batteryVoltage < 5.0 && currentState_.batteryVoltage > 0.0) {
-        warnings_.push_back("CRITICAL: COMPLETE ELECTRICAL FAILURE - Emergency procedures required");
+        electricalWarnings_.push_back("CRITICAL: COMPLETE ELECTRICAL FAILURE - Emergency procedures required");
     }
 }
 
@@ -0,0 +1,146 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Obstacle Index Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/obstacle_index.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+constexpr int GRID_ROWS = 1800;  // 180 / CELL_SIZE_DEG
+
+double normalizeLongitude(double longitude) {
+    while (longitude < -180.0) longitude += 360.0;
+    while (longitude >= 180.0) longitude -= 360.0;
+    return longitude;
+}
+
+// Distance from p to segment a-b in a local flat frame (nautical miles)
+double distanceToSegmentNM(const Position& p, const Position& a, const Position& b, double cosLat) {
+    double bx = (b.longitude - a.longitude) * 60.0 * cosLat;
+    double by = (b.latitude - a.latitude) * 60.0;
+    double px = (p.longitude - a.longitude) * 60.0 * cosLat;
+    double py = (p.latitude - a.latitude) * 60.0;
+
+    double lengthSq = bx * bx + by * by;
+    double t = (lengthSq > 0.0) ? std::max(0.0, std::min(1.0, (px * bx + py * by) / lengthSq)) : 0.0;
+    double dx = px - t * bx;
+    double dy = py - t * by;
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+} // namespace
+
+int ObstacleIndex::rowFor(double latitude) {
+    int row = static_cast<int>(std::floor((latitude + 90.0) / CELL_SIZE_DEG));
+    return std::max(0, std::min(GRID_ROWS - 1, row));
+}
+
+int ObstacleIndex::columnFor(double longitude) {
+    int column = static_cast<int>(std::floor((longitude + 180.0) / CELL_SIZE_DEG));
+    return std::max(0, std::min(GRID_COLUMNS - 1, column));
+}
+
+void ObstacleIndex::build(std::vector<Obstacle> obstacles) {
+    std::vector<uint32_t> keys(obstacles.size());
+    for (size_t i = 0; i < obstacles.size(); ++i) {
+        obstacles[i].position.longitude = normalizeLongitude(obstacles[i].position.longitude);
+        keys[i] = cellKey(rowFor(obstacles[i].position.latitude),
+                          columnFor(obstacles[i].position.longitude));
+    }
+
+    // Sort by cell so each cell (and each run of cells in a row) is contiguous
+    std::vector<size_t> order(obstacles.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+    obstacles_.clear();
+    obstacles_.reserve(obstacles.size());
+    cells_.clear();
+    for (size_t i : order) {
+        if (cells_.empty() || cells_.back().key != keys[i]) {
+            cells_.push_back({keys[i], static_cast<uint32_t>(obstacles_.size())});
+        }
+        obstacles_.push_back(std::move(obstacles[i]));
+    }
+    cells_.push_back({UINT32_MAX, static_cast<uint32_t>(obstacles_.size())});
+}
+
+void ObstacleIndex::clear() {
+    obstacles_.clear();
+    cells_.clear();
+}
+
+template <typename Fn>
+void ObstacleIndex::forEachInRow(int row, int column0, int column1, Fn&& fn) const {
+    if (cells_.empty()) return;
+
+    auto keyLess = [](const Cell& cell, uint32_t key) { return cell.key < key; };
+    auto last = cells_.end() - 1;  // sentinel
+    auto first = std::lower_bound(cells_.begin(), last, cellKey(row, column0), keyLess);
+    auto end = std::lower_bound(first, last, cellKey(row, column1) + 1, keyLess);
+
+    for (uint32_t i = first->begin; i < end->begin; ++i) {
+        fn(obstacles_[i]);
+    }
+}
+
+void ObstacleIndex::queryCorridor(const Position& start, const Position& end, double halfWidthNM,
+                                  std::vector<const Obstacle*>& out) const {
+    if (obstacles_.empty()) return;
+
+    halfWidthNM = std::max(0.0, halfWidthNM);
+    double latPad = halfWidthNM / 60.0;
+    double dLat = end.latitude - start.latitude;
+    double cosLat = std::max(0.01, std::cos((start.latitude + end.latitude) * 0.5 * DEG_TO_RAD));
+
+    int row0 = rowFor(std::min(start.latitude, end.latitude) - latPad);
+    int row1 = rowFor(std::max(start.latitude, end.latitude) + latPad);
+    for (int row = row0; row <= row1; ++row) {
+        // Part of the segment close enough (in latitude) to reach this row
+        double bandLow = row * CELL_SIZE_DEG - 90.0 - latPad;
+        double bandHigh = (row + 1) * CELL_SIZE_DEG - 90.0 + latPad;
+        double t0 = 0.0;
+        double t1 = 1.0;
+        if (std::fabs(dLat) > 1e-12) {
+            double ta = (bandLow - start.latitude) / dLat;
+            double tb = (bandHigh - start.latitude) / dLat;
+            t0 = std::max(0.0, std::min(ta, tb));
+            t1 = std::min(1.0, std::max(ta, tb));
+            if (t0 > t1) continue;
+        }
+
+        double lonA = start.longitude + (end.longitude - start.longitude) * t0;
+        double lonB = start.longitude + (end.longitude - start.longitude) * t1;
+        double edgeLat = std::min(89.0, std::max(std::fabs(bandLow), std::fabs(bandHigh)));
+        double lonPad = halfWidthNM / (60.0 * std::max(0.01, std::cos(edgeLat * DEG_TO_RAD)));
+
+        int column0 = columnFor(std::min(lonA, lonB) - lonPad);
+        int column1 = columnFor(std::max(lonA, lonB) + lonPad);
+        forEachInRow(row, column0, column1, [&](const Obstacle& obstacle) {
+            if (distanceToSegmentNM(obstacle.position, start, end, cosLat) <= halfWidthNM) {
+                out.push_back(&obstacle);
+            }
+        });
+    }
+}
+
+void ObstacleIndex::queryRadius(const Position& center, double radiusNM,
+                                std::vector<const Obstacle*>& out) const {
+    queryCorridor(center, center, radiusNM, out);
+}
+
+} // namespace AICopilot
@@ -16,20 +16,63 @@
 #include <limits>
 #include <algorithm>
 #include <cctype>
-#ifdef ENABLE_GDAL
-#include "gdal_priv.h"
-#include "cpl_conv.h"
-#include <memory>
-#endif
 
 namespace AICopilot {
 
-// GDAL-backed terrain cache (file-scope)
-static bool gdalTerrainLoaded = false;
-static int gdalCols = 0;
-static int gdalRows = 0;
-static double gdalGeoTransform[6] = {0};
-static std::vector<double> gdalElevData; // row-major
+void TerrainAwareness::updateAircraftState(const AircraftState& state) {
+    currentState_ = state;
+    stateVersion_ = 0;
+    advanceLookahead();
+}
+
+bool TerrainAwareness::updateAircraftState(const AircraftStateCore& core, uint64_t version) {
+    if (version != 0 && version == stateVersion_) {
+        return false;
+    }
+    core.applyTo(currentState_);
+    stateVersion_ = version;
+    advanceLookahead();
+    return true;
+}
+
+void TerrainAwareness::advanceLookahead() {
+    const Position& aircraft = currentState_.position;
+    if (terrainRaster_) {
+        terrainRaster_->prefetch(aircraft.latitude, aircraft.longitude,
+                                 RASTER_PREFETCH_RADIUS_NM / 60.0, 0.0);
+    }
+    lookahead_.update(TerrainLookaheadInput::fromAircraftState(currentState_),
+                      [this](const LatLon* points, size_t count, double* outFt) {
+                          sampleLookahead(points, count, outFt);
+                      });
+}
+
+void TerrainAwareness::sampleLookahead(const LatLon* points, size_t count, double* outFt) {
+    if (!terrainLods_) {
+        getTerrainElevations(points, count, outFt);
+        return;
+    }
+    
+    // AGL over the coarsest terrain below the aircraft: it is never lower
+    // than the fine terrain, so the AGL errs low and the choice errs fine
+    const Position& aircraft = currentState_.position;
+    double below = 0.0;
+    terrainLods_->getElevation(aircraft.latitude, aircraft.longitude, TerrainLod::COARSE, below);
+    TerrainLodQuery query;
+    query.aglFt = aircraft.altitude - below;
+    query.groundSpeedKts = currentState_.groundSpeed;
+    
+    const double cosLat = std::max(0.01, std::cos(aircraft.latitude * 3.14159265358979323846 / 180.0));
+    lookaheadLods_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        double northNM = (points[i].latitude - aircraft.latitude) * 60.0;
+        double eastNM = (points[i].longitude - aircraft.longitude) * 60.0 * cosLat;
+        query.distanceNM = std::hypot(northNM, eastNM);
+        lookaheadLods_[i] = TerrainLodStack::selectLod(query);
+    }
+    terrainLods_->getElevations(points, lookaheadLods_.data(), count, outFt);
+}
+
 TerrainAlert TerrainAwareness::checkTerrainClearance(const Position& pos) const {
     TerrainAlert alert;
     double elevation = getTerrainElevation(pos);
@@ -59,7 +102,24 @@ TerrainAlert TerrainAwareness::checkTerrainClearance(const Position& pos) const
 }
 
 double TerrainAwareness::getTerrainElevation(const Position& pos) const {
-    // Simplified terrain lookup - real implementation would query terrain database
+    return sampleTerrain(pos, 0.0);
+}
+
+double TerrainAwareness::sampleTerrain(const Position& pos, double resolutionDeg) const {
+    double elevation = 0.0;
+    if (terrainLods_ && terrainLods_->getElevation(pos.latitude, pos.longitude, TerrainLod::SRTM1, elevation)) {
+        return elevation;
+    }
+    
+    if (terrainPack_ && terrainPack_->getElevation(pos.latitude, pos.longitude, elevation)) {
+        return elevation;
+    }
+    
+    if (terrainRaster_ &&
+        terrainRaster_->getElevation(pos.latitude, pos.longitude, resolutionDeg, elevation)) {
+        return elevation;
+    }
+    
     if (terrainDatabase_.empty()) {
         return 0.0;  // Sea level default
     }
@@ -67,6 +127,13 @@ double TerrainAwareness::getTerrainElevation(const Position& pos) const {
     return interpolateElevation(pos);
 }
 
+void TerrainAwareness::getTerrainElevations(const LatLon* points, size_t count, double* outFt) const {
+    for (size_t i = 0; i < count; ++i) {
+        Position pos{points[i].latitude, points[i].longitude, 0.0, 0.0};
+        outFt[i] = getTerrainElevation(pos);
+    }
+}
+
 double TerrainAwareness::getAltitudeAGL(const Position& pos, double altitudeMSL) const {
     double elevation = getTerrainElevation(pos);
     return altitudeMSL - elevation;
@@ -79,10 +146,14 @@ std::vector<Obstacle> TerrainAwareness::detectObstacles(
     
     std::vector<Obstacle> obstacles;
     
-    // Check obstacle database for obstacles in path
-    for (const auto& obs : obstacleDatabase_) {
-        if (obs.elevation <= altitude && altitude <= obs.elevation + 1000.0) {
-            obstacles.push_back(obs);
+    // Only obstacles near the path are candidates
+    std::vector<const Obstacle*> candidates;
+    obstacleIndex_.queryCorridor(start, end, OBSTACLE_CORRIDOR_NM, candidates);
+    
+    // Conflict if the obstacle top is within clearance of, or above, the altitude
+    for (const Obstacle* obs : candidates) {
+        if (altitude <= obs->elevation + OBSTACLE_CLEARANCE) {
+            obstacles.push_back(*obs);
         }
     }
     
@@ -98,9 +169,11 @@ Obstacle TerrainAwareness::getHighestObstacle(
     highest.height = 0.0;
     highest.elevation = 0.0;
     
-    for (const auto& obs : obstacleDatabase_) {
-        if (obs.elevation > highest.elevation) {
-            highest = obs;
+    std::vector<const Obstacle*> candidates;
+    obstacleIndex_.queryRadius(center, radius, candidates);
+    for (const Obstacle* obs : candidates) {
+        if (obs->elevation > highest.elevation) {
+            highest = *obs;
         }
     }
     
@@ -144,6 +217,30 @@ bool TerrainAwareness::predictTerrainConflict(
     return altitude < msa;
 }
 
+TerrainClearance TerrainAwareness::makeClearance() const {
+    return TerrainClearance(terrainLods_ ? terrainLods_->getCoarse() : nullptr,
+                            [this](double latitude, double longitude, double& elevationFt) {
+                                elevationFt = sampleTerrain(Position{latitude, longitude, 0.0, 0.0}, 0.0);
+                                return true;
+                            });
+}
+
+PathClearanceResult TerrainAwareness::checkPathClearance(
+    const std::vector<Position>& path,
+    double requiredClearance) const {
+    return makeClearance().checkPath(path, requiredClearance);
+}
+
+std::vector<PathClearanceResult> TerrainAwareness::checkPathClearances(
+    const std::vector<std::vector<Position>>& paths,
+    double requiredClearance) const {
+    return makeClearance().checkPaths(paths, requiredClearance);
+}
+
+bool TerrainAwareness::hasLineOfSight(const Position& from, const Position& to) const {
+    return makeClearance().hasLineOfSight(from, to);
+}
+
 std::vector<TerrainPoint> TerrainAwareness::getTerrainProfile(
     const Position& start,
     double heading,
@@ -161,7 +258,7 @@ std::vector<TerrainPoint> TerrainAwareness::getTerrainProfile(
         
         TerrainPoint point;
         point.position = samplePos;
-        point.elevation = getTerrainElevation(samplePos);
+        point.elevation = sampleTerrain(samplePos, 0.1 / samples);
         profile.push_back(point);
     }
     
@@ -172,7 +269,33 @@ bool TerrainAwareness::loadTerrainDatabase(const std::string& databasePath) {
     // Enhanced terrain database loading
     // In a full implementation, would load SRTM, DEM, or other elevation data
     std::cout << "Terrain Awareness: Loading terrain database from " << databasePath << std::endl;
-    // For now, implement a simple CSV loader for unit testing and small datasets.
+    
+    // Compiled packs are mapped, not parsed
+    if (TerrainPack::isPackFile(databasePath)) {
+        auto pack = std::make_shared<TerrainPack>();
+        if (!pack->open(databasePath)) {
+            std::cout << "Terrain Awareness: Could not open terrain pack: " << databasePath << std::endl;
+            return false;
+        }
+        std::cout << "Terrain Awareness: Mapped terrain pack with " << pack->getTileCount() << " tiles" << std::endl;
+        terrainPack_ = std::move(pack);
+        return true;
+    }
+    
+    // GeoTIFFs are read block by block as lookups reach them
+    auto ext = databasePath.substr(databasePath.find_last_of('.') + 1);
+    for (auto &c : ext) c = static_cast<char>(tolower(c));
+    if (ext == "tif" || ext == "tiff") {
+        auto raster = TiledRasterSource::openGdal(databasePath);
+        if (!raster) {
+            std::cout << "Terrain Awareness: Could not open terrain raster: " << databasePath << std::endl;
+            return false;
+        }
+        terrainRaster_ = std::move(raster);
+        return true;
+    }
+    
+    // Otherwise a simple CSV loader for unit testing and small datasets.
     // CSV format: lat,lon,elevation_feet (no header required)
     terrainDatabase_.clear();
     std::ifstream ifs(databasePath);
@@ -205,52 +328,6 @@ bool TerrainAwareness::loadTerrainDatabase(const std::string& databasePath) {
         std::cout << "Terrain Awareness: Loaded " << terrainDatabase_.size() << " terrain points" << std::endl;
     }
 
-#ifdef ENABLE_GDAL
-    // If the provided path looks like a raster (GeoTIFF), try GDAL load
-    auto ext = databasePath.substr(databasePath.find_last_of('.') + 1);
-    for (auto &c : ext) c = static_cast<char>(tolower(c));
-    if (ext == "tif" || ext == "tiff") {
-        GDALAllRegister();
-        GDALDataset *poDataset = (GDALDataset *)GDALOpen(databasePath.c_str(), GA_ReadOnly);
-        if (poDataset == nullptr) {
-            std::cout << "Terrain Awareness: GDAL failed to open " << databasePath << std::endl;
-            // fall back to CSV-loaded points if any
-            return !terrainDatabase_.empty();
-        }
-
-        if (poDataset->GetGeoTransform(gdalGeoTransform) != CE_None) {
-            std::cout << "Terrain Awareness: GDAL dataset missing geotransform" << std::endl;
-            GDALClose(poDataset);
-            return !terrainDatabase_.empty();
-        }
-
-        gdalCols = poDataset->GetRasterXSize();
-        gdalRows = poDataset->GetRasterYSize();
-        gdalElevData.assign(gdalCols * gdalRows, 0.0);
-
-        GDALRasterBand *poBand = poDataset->GetRasterBand(1);
-        if (!poBand) {
-            std::cout << "Terrain Awareness: No raster band found" << std::endl;
-            GDALClose(poDataset);
-            return !terrainDatabase_.empty();
-        }
-
-        CPLErr err = poBand->RasterIO(GF_Read, 0, 0, gdalCols, gdalRows,
-                                      gdalElevData.data(), gdalCols, gdalRows, GDT_Float64,
-                                      0, 0);
-        if (err != CE_None) {
-            std::cout << "Terrain Awareness: Failed to read raster data" << std::endl;
-            GDALClose(poDataset);
-            return !terrainDatabase_.empty();
-        }
-
-        gdalTerrainLoaded = true;
-        std::cout << "Terrain Awareness: GDAL terrain loaded (" << gdalCols << "x" << gdalRows << ")" << std::endl;
-        GDALClose(poDataset);
-        return true;
-    }
-#endif
-
     if (terrainDatabase_.empty()) {
         std::cout << "Terrain Awareness: No terrain points loaded from " << databasePath << std::endl;
         return false;
@@ -259,25 +336,82 @@ bool TerrainAwareness::loadTerrainDatabase(const std::string& databasePath) {
     return true;
 }
 
+void TerrainAwareness::setTerrainRaster(std::shared_ptr<TiledRasterSource> raster) {
+    terrainRaster_ = std::move(raster);
+}
+
+void TerrainAwareness::setTerrainPack(std::shared_ptr<const TerrainPack> pack) {
+    terrainPack_ = std::move(pack);
+}
+
 bool TerrainAwareness::loadObstacleDatabase(const std::string& databasePath) {
     // Enhanced obstacle database loading
     // In a full implementation, would load tower, antenna, and obstacle data
     std::cout << "Terrain Awareness: Loading obstacle database from " << databasePath << std::endl;
     
-    // For now, using basic obstacle detection
-    // Future enhancements:
-    // - Load FAA obstacle database
-    // - Load antenna tower locations
-    // - Load building heights in urban areas
-    // - Support international obstacle databases
-    // - Build spatial index for collision detection
+    // CSV format: lat,lon,elevation_msl_ft,height_agl_ft[,type[,description]]
+    std::ifstream ifs(databasePath);
+    if (!ifs) {
+        std::cout << "Terrain Awareness: Could not open obstacle database file: " << databasePath << std::endl;
+        return false;
+    }
     
-    std::cout << "Terrain Awareness: Using basic obstacle detection (load obstacle DB for full coverage)" << std::endl;
-    return true;
+    std::vector<Obstacle> obstacles;
+    std::string line;
+    while (std::getline(ifs, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ss(line);
+        std::string field;
+        std::vector<std::string> fields;
+        while (std::getline(ss, field, ',')) {
+            fields.push_back(field);
+        }
+        if (fields.size() < 4) continue;
+        
+        Obstacle obs;
+        try {
+            obs.position.latitude = std::stod(fields[0]);
+            obs.position.longitude = std::stod(fields[1]);
+            obs.elevation = std::stod(fields[2]);
+            obs.height = std::stod(fields[3]);
+        } catch (...) {
+            continue;  // header or malformed row
+        }
+        obs.position.altitude = obs.elevation;
+        obs.position.heading = 0.0;
+        obs.type = parseObstacleType(fields.size() > 4 ? fields[4] : std::string());
+        if (fields.size() > 5) obs.description = fields[5];
+        obstacles.push_back(obs);
+    }
+    
+    setObstacles(std::move(obstacles));
+    std::cout << "Terrain Awareness: Indexed " << obstacleIndex_.size() << " obstacles" << std::endl;
+    return !obstacleIndex_.empty();
+}
+
+void TerrainAwareness::setObstacles(std::vector<Obstacle> obstacles) {
+    obstacleIndex_.build(std::move(obstacles));
 }
 
 // Private methods
 
+ObstacleType TerrainAwareness::parseObstacleType(const std::string& name) {
+    std::string upper;
+    for (char c : name) {
+        if (!std::isspace(static_cast<unsigned char>(c))) {
+            upper += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+    }
+    
+    if (upper == "TOWER") return ObstacleType::TOWER;
+    if (upper == "BUILDING" || upper == "BLDG") return ObstacleType::BUILDING;
+    if (upper == "MOUNTAIN") return ObstacleType::MOUNTAIN;
+    if (upper == "ANTENNA") return ObstacleType::ANTENNA;
+    if (upper == "BRIDGE") return ObstacleType::BRIDGE;
+    if (upper == "POWER_LINE" || upper == "POLE" || upper == "CATENARY") return ObstacleType::POWER_LINE;
+    return ObstacleType::OTHER;
+}
+
 TerrainWarningLevel TerrainAwareness::determineWarningLevel(
     double clearance,
     bool climbing) const {
@@ -295,42 +429,6 @@ TerrainWarningLevel TerrainAwareness::determineWarningLevel(
 }
 
 double TerrainAwareness::interpolateElevation(const Position& pos) const {
-    // If GDAL terrain was loaded, perform bilinear lookup on raster
-#ifdef ENABLE_GDAL
-    if (gdalTerrainLoaded && gdalCols > 0 && gdalRows > 0) {
-        // Assume geotransform: GT[0]=originX, GT[1]=pixelWidth, GT[2]=0, GT[3]=originY, GT[4]=0, GT[5]=pixelHeight
-        double originX = gdalGeoTransform[0];
-        double pixelW = gdalGeoTransform[1];
-        double originY = gdalGeoTransform[3];
-        double pixelH = gdalGeoTransform[5];
-
-        // Convert lon/lat to pixel coordinates (assumes raster is geographic)
-        double px = (pos.longitude - originX) / pixelW;
-        double py = (pos.latitude - originY) / pixelH; // pixelH may be negative
-
-        int ix = static_cast<int>(std::floor(px));
-        int iy = static_cast<int>(std::floor(py));
-        double fx = px - ix;
-        double fy = py - iy;
-
-        auto sample = [&](int x, int y) -> double {
-            if (x < 0 || x >= gdalCols || y < 0 || y >= gdalRows) return 0.0;
-            return gdalElevData[y * gdalCols + x];
-        };
-
-        double v00 = sample(ix, iy);
-        double v10 = sample(ix + 1, iy);
-        double v01 = sample(ix, iy + 1);
-        double v11 = sample(ix + 1, iy + 1);
-
-        double v0 = v00 * (1 - fx) + v10 * fx;
-        double v1 = v01 * (1 - fx) + v11 * fx;
-        double elev = v0 * (1 - fy) + v1 * fy;
-
-        return elev; // elevation units depend on raster (often meters); existing API uses feet MSL - caller must handle units
-    }
-#endif
-
     // Fallback: nearest-neighbor elevation lookup. Suitable for unit tests and small datasets.
     if (terrainDatabase_.empty()) return 0.0;
 
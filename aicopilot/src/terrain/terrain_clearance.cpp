@@ -0,0 +1,212 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Terrain Clearance Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/terrain_clearance.hpp"
+#include "../include/geodesy.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr double FEET_PER_NM = 6076.12;
+
+// Chord drop below the surface at fraction t, from the drop at mid-segment
+double sagAt(double sagFt, double t) {
+    return 4.0 * sagFt * t * (1.0 - t);
+}
+
+} // namespace
+
+TerrainClearance::TerrainClearance(std::shared_ptr<const TerrainMaxPyramid> pyramid, PointElevation fine)
+    : pyramid_(std::move(pyramid)), fine_(std::move(fine)) {
+    if (pyramid_ && !pyramid_->isBuilt()) pyramid_.reset();
+}
+
+TerrainClearance::Segment TerrainClearance::makeSegment(const Position& from, const Position& to,
+                                                        double startNM, bool chord) {
+    Segment segment;
+    segment.latitude0 = from.latitude;
+    segment.longitude0 = from.longitude;
+    segment.altitude0 = from.altitude;
+    segment.latitude1 = to.latitude;
+    segment.longitude1 = to.longitude;
+    segment.altitude1 = to.altitude;
+    segment.lengthNM = Geodesy::flatDistanceNM(from.latitude, from.longitude, to.latitude, to.longitude);
+    segment.startNM = startNM;
+    segment.sagFt = chord ? segment.lengthNM * segment.lengthNM / (8.0 * Geodesy::EARTH_RADIUS_NM) * FEET_PER_NM
+                          : 0.0;
+    return segment;
+}
+
+double TerrainClearance::altitudeAt(const Segment& segment, double t) {
+    return segment.altitude0 + (segment.altitude1 - segment.altitude0) * t - sagAt(segment.sagFt, t);
+}
+
+bool TerrainClearance::covered(const Segment& segment, double t0, double t1) const {
+    // The grid is a rectangle, so a span whose ends are on it lies on it
+    int row = 0;
+    int col = 0;
+    for (double t : {t0, t1}) {
+        double latitude = segment.latitude0 + (segment.latitude1 - segment.latitude0) * t;
+        double longitude = segment.longitude0 + (segment.longitude1 - segment.longitude0) * t;
+        if (!pyramid_->cellOf(0, latitude, longitude, row, col)) return false;
+    }
+    return true;
+}
+
+void TerrainClearance::recordConflict(const Segment& segment, double t, double terrainFt, double clearanceFt,
+                                      PathClearanceResult& result) const {
+    result.clear = false;
+    result.minimumClearanceFt = clearanceFt;
+    result.conflictDistanceNM = segment.startNM + segment.lengthNM * t;
+    result.conflictPosition.latitude = segment.latitude0 + (segment.latitude1 - segment.latitude0) * t;
+    result.conflictPosition.longitude = segment.longitude0 + (segment.longitude1 - segment.longitude0) * t;
+    result.conflictPosition.altitude = altitudeAt(segment, t);
+    result.conflictPosition.heading = 0.0;
+    result.conflictTerrainFt = terrainFt;
+}
+
+bool TerrainClearance::clearSpan(const Segment& segment, double t0, double t1, double requiredFt, int depth,
+                                 PathClearanceResult& result) const {
+    double latitude0 = segment.latitude0 + (segment.latitude1 - segment.latitude0) * t0;
+    double latitude1 = segment.latitude0 + (segment.latitude1 - segment.latitude0) * t1;
+    double longitude0 = segment.longitude0 + (segment.longitude1 - segment.longitude0) * t0;
+    double longitude1 = segment.longitude0 + (segment.longitude1 - segment.longitude0) * t1;
+    double extent = std::max(std::fabs(latitude1 - latitude0), std::fabs(longitude1 - longitude0));
+
+    // Lowest the span gets: altitude is linear, the chord drop peaks mid-segment
+    double lowest = std::min(segment.altitude0 + (segment.altitude1 - segment.altitude0) * t0,
+                             segment.altitude0 + (segment.altitude1 - segment.altitude0) * t1) -
+                    sagAt(segment.sagFt, std::max(t0, std::min(0.5, t1)));
+
+    bool boxKnown = false;
+    double boxFt = 0.0;
+    if (pyramid_ && covered(segment, t0, t1)) {
+        ++result.cellQueries;
+        boxKnown = pyramid_->getMaxElevation(latitude0, longitude0, latitude1, longitude1, boxFt);
+        if (boxKnown && lowest - boxFt >= requiredFt) {
+            result.minimumClearanceFt = std::min(result.minimumClearanceFt, lowest - boxFt);
+            return true;
+        }
+    }
+
+    double leafDegrees = pyramid_ ? pyramid_->getCellDegrees(0) : LEAF_DEGREES;
+    if (extent > leafDegrees && depth < MAX_DEPTH) {
+        double mid = 0.5 * (t0 + t1);
+        return clearSpan(segment, t0, mid, requiredFt, depth + 1, result) &&
+               clearSpan(segment, mid, t1, requiredFt, depth + 1, result);
+    }
+
+    if (!fine_) {
+        // The base cell decides; without one the terrain is unknown
+        if (!boxKnown) {
+            result.complete = false;
+            boxFt = 0.0;
+        }
+        double clearance = lowest - boxFt;
+        if (clearance < requiredFt) {
+            recordConflict(segment, t0, boxFt, clearance, result);
+            return false;
+        }
+        result.minimumClearanceFt = std::min(result.minimumClearanceFt, clearance);
+        return true;
+    }
+
+    int steps = std::max(1, static_cast<int>(std::ceil(extent / FINE_STEP_DEGREES)));
+    for (int i = 0; i <= steps; ++i) {
+        double t = t0 + (t1 - t0) * i / steps;
+        double latitude = segment.latitude0 + (segment.latitude1 - segment.latitude0) * t;
+        double longitude = segment.longitude0 + (segment.longitude1 - segment.longitude0) * t;
+        double elevation = 0.0;
+        ++result.fineSamples;
+        if (!fine_(latitude, longitude, elevation)) {
+            result.complete = false;
+            elevation = 0.0;
+        }
+        double clearance = altitudeAt(segment, t) - elevation;
+        if (clearance < requiredFt) {
+            recordConflict(segment, t, elevation, clearance, result);
+            return false;
+        }
+        result.minimumClearanceFt = std::min(result.minimumClearanceFt, clearance);
+    }
+    return true;
+}
+
+PathClearanceResult TerrainClearance::checkPath(const std::vector<Position>& path, double requiredClearanceFt) const {
+    PathClearanceResult result;
+    if (path.size() == 1) {
+        return checkSegment(path[0], path[0], requiredClearanceFt);
+    }
+    double startNM = 0.0;
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+        Segment segment = makeSegment(path[i], path[i + 1], startNM, false);
+        if (!clearSpan(segment, 0.0, 1.0, requiredClearanceFt, 0, result)) break;
+        startNM += segment.lengthNM;
+    }
+    return result;
+}
+
+PathClearanceResult TerrainClearance::checkSegment(const Position& from, const Position& to,
+                                                   double requiredClearanceFt) const {
+    PathClearanceResult result;
+    clearSpan(makeSegment(from, to, 0.0, false), 0.0, 1.0, requiredClearanceFt, 0, result);
+    return result;
+}
+
+std::vector<PathClearanceResult> TerrainClearance::checkPaths(const std::vector<std::vector<Position>>& paths,
+                                                              double requiredClearanceFt) const {
+    std::vector<PathClearanceResult> results(paths.size());
+
+    // The box around every point of every path, below the lowest of them
+    if (pyramid_) {
+        double south = 90.0, north = -90.0, west = 180.0, east = -180.0;
+        double lowest = std::numeric_limits<double>::infinity();
+        bool onGrid = true;
+        size_t points = 0;
+        for (const auto& path : paths) {
+            for (const Position& pos : path) {
+                int row = 0;
+                int col = 0;
+                onGrid = onGrid && pyramid_->cellOf(0, pos.latitude, pos.longitude, row, col);
+                south = std::min(south, pos.latitude);
+                north = std::max(north, pos.latitude);
+                west = std::min(west, pos.longitude);
+                east = std::max(east, pos.longitude);
+                lowest = std::min(lowest, pos.altitude);
+                ++points;
+            }
+        }
+        double maxFt = 0.0;
+        if (points > 0 && onGrid && pyramid_->getMaxElevation(south, west, north, east, maxFt) &&
+            lowest - maxFt >= requiredClearanceFt) {
+            for (PathClearanceResult& result : results) {
+                result.minimumClearanceFt = lowest - maxFt;
+            }
+            if (!results.empty()) results[0].cellQueries = 1;
+            return results;
+        }
+    }
+
+    for (size_t i = 0; i < paths.size(); ++i) {
+        results[i] = checkPath(paths[i], requiredClearanceFt);
+    }
+    return results;
+}
+
+bool TerrainClearance::hasLineOfSight(const Position& from, const Position& to) const {
+    PathClearanceResult result;
+    return clearSpan(makeSegment(from, to, 0.0, true), 0.0, 1.0, 0.0, 0, result);
+}
+
+} // namespace AICopilot
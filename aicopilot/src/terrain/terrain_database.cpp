@@ -28,7 +28,7 @@ bool TerrainDatabase::initialize(const std::string& srtmDataPath) {
     std::lock_guard<std::mutex> lock(cacheMutex_);
     srtmDataPath_ = srtmDataPath;
     tileCache_.clear();
-    cacheOrder_.clear();
+    missingTiles_.clear();
     std::cout << "TerrainDatabase: Initialized with path: " << srtmDataPath << std::endl;
     return true;
 }
@@ -36,91 +36,113 @@ bool TerrainDatabase::initialize(const std::string& srtmDataPath) {
 void TerrainDatabase::shutdown() {
     std::lock_guard<std::mutex> lock(cacheMutex_);
     tileCache_.clear();
-    cacheOrder_.clear();
+    missingTiles_.clear();
 }
 
 double TerrainDatabase::getElevationAt(double latitude, double longitude) {
-    // Check SRTM coverage (-60 to +60 latitude)
-    if (latitude < -60.0 || latitude > 60.0) {
+    int tileLatitude = 0;
+    int tileLongitude = 0;
+    if (!getTileIndices(latitude, longitude, tileLatitude, tileLongitude)) {
         return 0.0;  // No data outside SRTM coverage
     }
     
-    // Handle edge cases
-    if (latitude == 90.0) latitude = 89.999;
-    if (latitude == -90.0) latitude = -89.999;
+    // Load tile if not in cache; the file is read without holding the lock
+    bool missing = false;
+    std::shared_ptr<ElevationTile> tile = findTile(tileLatitude, tileLongitude, missing);
+    if (!tile && !missing) {
+        tile = loadTile(tileLatitude, tileLongitude);
+    }
+    if (!tile) {
+        return 0.0;  // Data not available
+    }
     
-    // Calculate tile indices
-    int tileLatitude = (latitude >= 0.0) ? static_cast<int>(latitude) 
-                                         : static_cast<int>(latitude) - 1;
-    int tileLongitude = (longitude >= 0.0) ? static_cast<int>(longitude) 
-                                           : static_cast<int>(longitude) - 1;
+    return sampleTile(*tile, latitude, longitude);
+}
+
+TileLookupStatus TerrainDatabase::tryGetElevationAt(double latitude, double longitude,
+                                                    double& elevation) {
+    int tileLatitude = 0;
+    int tileLongitude = 0;
+    bool missing = !getTileIndices(latitude, longitude, tileLatitude, tileLongitude);
     
-    // Normalize longitude to -180 to 179 range
-    while (tileLongitude < -180) tileLongitude += 360;
-    while (tileLongitude >= 180) tileLongitude -= 360;
+    std::shared_ptr<ElevationTile> tile;
+    if (!missing) {
+        tile = findTile(tileLatitude, tileLongitude, missing);
+    }
+    if (missing) {
+        elevation = 0.0;
+        return TileLookupStatus::NO_DATA;
+    }
+    if (!tile) {
+        elevation = PENDING_ELEVATION_FT;
+        return TileLookupStatus::PENDING;
+    }
     
+    elevation = sampleTile(*tile, latitude, longitude);
+    return TileLookupStatus::READY;
+}
+
+bool TerrainDatabase::prefetchTile(int tileLatitude, int tileLongitude) {
+    TileKey key = packTileKey(tileLatitude, tileLongitude);
     {
         std::lock_guard<std::mutex> lock(cacheMutex_);
-        
-        // Load tile if not in cache
-        std::string tileKey = getTileFilename(tileLatitude, tileLongitude);
-        if (tileCache_.find(tileKey) == tileCache_.end()) {
-            if (!loadTile(tileLatitude, tileLongitude)) {
-                return 0.0;  // Data not available
-            }
-        }
-        
-        auto& tile = tileCache_[tileKey];
-        tile.lastAccessed = std::chrono::system_clock::now();
-        
-        // Move to end of LRU queue
-        auto it = std::find(cacheOrder_.begin(), cacheOrder_.end(), tileKey);
-        if (it != cacheOrder_.end()) {
-            cacheOrder_.erase(it);
-        }
-        cacheOrder_.push_back(tileKey);
-        
-        // Calculate position within tile (0 to 1)
-        double fracLat = latitude - tileLatitude;
-        double fracLon = longitude - tileLongitude;
-        
-        // Convert to row/col (0 to 3600)
-        double row = fracLat * 3600.0;
-        double col = fracLon * 3600.0;
-        
-        // Clamp to valid range
-        row = std::min(3600.0, std::max(0.0, row));
-        col = std::min(3600.0, std::max(0.0, col));
-        
-        // Bilinear interpolation
-        double elev = interpolateElevation(tile, row, col);
-        
-        // Convert from meters to feet
-        return elev * FEET_PER_METER;
+        if (tileCache_.contains(key)) return true;
+        if (missingTiles_.count(key) != 0) return false;
     }
+    return loadTile(tileLatitude, tileLongitude) != nullptr;
 }
 
 double TerrainDatabase::getElevationAt(const Position& position) {
     return getElevationAt(position.latitude, position.longitude);
 }
 
+void TerrainDatabase::getElevations(const LatLon* points, size_t count, double* out) {
+    // Tiles resolved so far in this batch; a profile or area touches only a few
+    std::vector<std::pair<TileKey, std::shared_ptr<ElevationTile>>> tiles;
+    
+    for (size_t i = 0; i < count; ++i) {
+        int tileLatitude = 0;
+        int tileLongitude = 0;
+        if (!getTileIndices(points[i].latitude, points[i].longitude, tileLatitude, tileLongitude)) {
+            out[i] = 0.0;
+            continue;
+        }
+        
+        TileKey key = packTileKey(tileLatitude, tileLongitude);
+        auto found = std::find_if(tiles.begin(), tiles.end(),
+                                  [key](const auto& entry) { return entry.first == key; });
+        if (found == tiles.end()) {
+            bool missing = false;
+            std::shared_ptr<ElevationTile> tile = findTile(tileLatitude, tileLongitude, missing);
+            if (!tile && !missing) {
+                tile = loadTile(tileLatitude, tileLongitude);
+            }
+            tiles.emplace_back(key, std::move(tile));
+            found = tiles.end() - 1;
+        }
+        
+        out[i] = found->second ? sampleTile(*found->second, points[i].latitude, points[i].longitude)
+                               : 0.0;
+    }
+}
+
 std::vector<double> TerrainDatabase::getElevationProfile(
     const Position& start,
     const Position& end,
     int samples) {
     
-    std::vector<double> profile;
+    std::vector<LatLon> points(std::max(samples, 0) + 1);
     
     for (int i = 0; i <= samples; ++i) {
         double fraction = (samples > 0) ? static_cast<double>(i) / samples : 0.0;
         
         // Linear interpolation (simplified - should use great circle for accuracy)
-        double lat = start.latitude + (end.latitude - start.latitude) * fraction;
-        double lon = start.longitude + (end.longitude - start.longitude) * fraction;
-        
-        profile.push_back(getElevationAt(lat, lon));
+        points[i].latitude = start.latitude + (end.latitude - start.latitude) * fraction;
+        points[i].longitude = start.longitude + (end.longitude - start.longitude) * fraction;
     }
     
+    std::vector<double> profile(points.size());
+    getElevations(points.data(), points.size(), profile.data());
     return profile;
 }
 
@@ -173,18 +195,79 @@ bool TerrainDatabase::isDataAvailable(double latitude, double longitude) const {
 void TerrainDatabase::clearCache() {
     std::lock_guard<std::mutex> lock(cacheMutex_);
     tileCache_.clear();
-    cacheOrder_.clear();
+    missingTiles_.clear();
 }
 
 std::pair<int, int> TerrainDatabase::getCacheStats() const {
     std::lock_guard<std::mutex> lock(cacheMutex_);
-    int tilesInCache = tileCache_.size();
-    int cacheSizeMB = tilesInCache * TILE_SIZE_BYTES / (1024 * 1024);
+    int tilesInCache = static_cast<int>(tileCache_.size());
+    int cacheSizeMB = static_cast<int>(tileCache_.getBytes() / (1024 * 1024));
     return {tilesInCache, cacheSizeMB};
 }
 
+TileCacheStats TerrainDatabase::getTileCacheStats() const {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return tileCache_.getStats();
+}
+
+void TerrainDatabase::setCacheBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    tileCache_.setByteBudget(bytes);
+}
+
 // Private methods
 
+bool TerrainDatabase::getTileIndices(double latitude, double longitude,
+                                     int& tileLatitude, int& tileLongitude) {
+    // Check SRTM coverage (-60 to +60 latitude)
+    if (latitude < -60.0 || latitude > 60.0) {
+        return false;
+    }
+    
+    // Calculate tile indices
+    tileLatitude = (latitude >= 0.0) ? static_cast<int>(latitude)
+                                     : static_cast<int>(latitude) - 1;
+    tileLongitude = (longitude >= 0.0) ? static_cast<int>(longitude)
+                                       : static_cast<int>(longitude) - 1;
+    
+    // Normalize longitude to -180 to 179 range
+    while (tileLongitude < -180) tileLongitude += 360;
+    while (tileLongitude >= 180) tileLongitude -= 360;
+    return true;
+}
+
+std::shared_ptr<TerrainDatabase::ElevationTile> TerrainDatabase::findTile(
+    int tileLatitude, int tileLongitude, bool& missing) {
+    TileKey key = packTileKey(tileLatitude, tileLongitude);
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    
+    // A hit also makes the tile most recently used
+    std::shared_ptr<ElevationTile> tile = tileCache_.find(key);
+    if (tile) {
+        tile->lastAccessed = std::chrono::system_clock::now();
+    }
+    missing = !tile && missingTiles_.count(key) != 0;
+    return tile;
+}
+
+double TerrainDatabase::sampleTile(const ElevationTile& tile,
+                                   double latitude, double longitude) const {
+    // Calculate position within tile (0 to 1)
+    double fracLat = latitude - tile.tileLatitude;
+    double fracLon = longitude - tile.tileLongitude;
+    
+    // Convert to row/col (0 to 3600)
+    double row = fracLat * 3600.0;
+    double col = fracLon * 3600.0;
+    
+    // Clamp to valid range
+    row = std::min(3600.0, std::max(0.0, row));
+    col = std::min(3600.0, std::max(0.0, col));
+    
+    // Bilinear interpolation, converted from meters to feet
+    return interpolateElevation(tile, row, col) * FEET_PER_METER;
+}
+
 std::string TerrainDatabase::getTileFilename(int tileLatitude, int tileLongitude) const {
     std::ostringstream oss;
     
@@ -214,53 +297,51 @@ std::string TerrainDatabase::getTileFilename(int tileLatitude, int tileLongitude
     return oss.str();
 }
 
-bool TerrainDatabase::loadTile(int tileLatitude, int tileLongitude) {
+std::shared_ptr<TerrainDatabase::ElevationTile> TerrainDatabase::loadTile(int tileLatitude, int tileLongitude) {
+    TileKey key = packTileKey(tileLatitude, tileLongitude);
     std::string filename = getTileFilename(tileLatitude, tileLongitude);
-    std::string filepath = srtmDataPath_ + "/" + filename;
+    std::string filepath;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        filepath = srtmDataPath_ + "/" + filename;
+    }
     
     std::ifstream file(filepath, std::ios::binary);
     if (!file.is_open()) {
-        // Silently return false - data not available, but not an error
-        return false;
+        // Data not available, but not an error; remember it so lookups skip the disk
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        missingTiles_.insert(key);
+        return nullptr;
     }
     
-    ElevationTile tile;
-    tile.tileLatitude = tileLatitude;
-    tile.tileLongitude = tileLongitude;
-    tile.data.resize(SRTM_SIZE * SRTM_SIZE);
+    auto tile = std::make_shared<ElevationTile>();
+    tile->tileLatitude = tileLatitude;
+    tile->tileLongitude = tileLongitude;
+    tile->data.resize(SRTM_SIZE * SRTM_SIZE);
     
     // Read big-endian int16 data
     unsigned char buffer[2];
     for (int i = 0; i < SRTM_SIZE * SRTM_SIZE; ++i) {
         if (!file.read(reinterpret_cast<char*>(buffer), 2)) {
             std::cerr << "TerrainDatabase: Error reading tile " << filename << std::endl;
-            return false;
+            return nullptr;
         }
-        tile.data[i] = bytesToInt16BE(buffer);
+        tile->data[i] = bytesToInt16BE(buffer);
     }
     
     file.close();
-    tile.isLoaded = true;
-    tile.lastAccessed = std::chrono::system_clock::now();
+    tile->isLoaded = true;
+    tile->lastAccessed = std::chrono::system_clock::now();
     
-    // Check cache size and evict if necessary
-    if (tileCache_.size() >= MAX_CACHE_TILES) {
-        evictOldestTile();
+    // Least recently used tiles are evicted to stay within the byte budget.
+    // Another thread may have loaded the same tile meanwhile; keep the first one.
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (tileCache_.contains(key)) {
+        return tileCache_.find(key);
     }
+    tileCache_.insert(key, tile, tile->data.size() * sizeof(int16_t));
     
-    std::string tileKey = filename;
-    tileCache_[tileKey] = tile;
-    cacheOrder_.push_back(tileKey);
-    
-    return true;
-}
-
-void TerrainDatabase::evictOldestTile() {
-    if (cacheOrder_.empty()) return;
-    
-    std::string oldestKey = cacheOrder_.front();
-    cacheOrder_.erase(cacheOrder_.begin());
-    tileCache_.erase(oldestKey);
+    return tile;
 }
 
 int16_t TerrainDatabase::getRawElevation(const ElevationTile& tile, 
@@ -0,0 +1,102 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Terrain LOD Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/terrain_lod.hpp"
+#include "../include/srtm_loader.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AICopilot {
+
+namespace {
+
+// Levels to try for a request: the requested one, then finer, then coarser
+constexpr TerrainLod FALLBACK_ORDER[TERRAIN_LOD_COUNT][TERRAIN_LOD_COUNT] = {
+    {TerrainLod::SRTM1, TerrainLod::SRTM3, TerrainLod::COARSE},
+    {TerrainLod::SRTM3, TerrainLod::SRTM1, TerrainLod::COARSE},
+    {TerrainLod::COARSE, TerrainLod::SRTM3, TerrainLod::SRTM1},
+};
+
+} // namespace
+
+TerrainLod TerrainLodStack::selectLod(const TerrainLodQuery& query) {
+    double agl = std::max(0.0, query.aglFt);
+    if (agl < FINE_AGL_FT && (query.distanceNM < FINE_RANGE_NM || query.groundSpeedKts < FINE_SPEED_KTS)) {
+        return TerrainLod::SRTM1;
+    }
+    if (agl >= 2.0 * COARSE_AGL_FT || (agl >= COARSE_AGL_FT && query.groundSpeedKts >= COARSE_SPEED_KTS)) {
+        return TerrainLod::COARSE;
+    }
+    return TerrainLod::SRTM3;
+}
+
+bool TerrainLodStack::hasLevel(TerrainLod lod) const {
+    switch (lod) {
+        case TerrainLod::SRTM1: return srtm1_ != nullptr;
+        case TerrainLod::SRTM3: return srtm3_ != nullptr;
+        case TerrainLod::COARSE: return coarse_ != nullptr;
+    }
+    return false;
+}
+
+bool TerrainLodStack::sampleLevel(TerrainLod lod, double latitude, double longitude, double& elevationFt) const {
+    int tileLatitude = static_cast<int>(std::floor(latitude));
+    int tileLongitude = static_cast<int>(std::floor(longitude));
+    switch (lod) {
+        case TerrainLod::SRTM1:
+            if (!srtm1_ || !srtm1_->HasTile(tileLatitude, tileLongitude)) return false;
+            elevationFt = srtm1_->GetElevation(latitude, longitude);
+            return true;
+        case TerrainLod::SRTM3:
+            if (!srtm3_ || !srtm3_->HasTile(tileLatitude, tileLongitude)) return false;
+            elevationFt = srtm3_->GetCellMaxElevation(latitude, longitude);
+            return true;
+        case TerrainLod::COARSE:
+            return coarse_ && coarse_->getMaxElevation(latitude, longitude, 0, elevationFt);
+    }
+    return false;
+}
+
+bool TerrainLodStack::getElevation(double latitude, double longitude, TerrainLod lod,
+                                   double& elevationFt, TerrainLod* served) const {
+    const TerrainLod* order = FALLBACK_ORDER[static_cast<size_t>(lod)];
+    for (size_t i = 0; i < TERRAIN_LOD_COUNT; ++i) {
+        if (sampleLevel(order[i], latitude, longitude, elevationFt)) {
+            served_[static_cast<size_t>(order[i])].fetch_add(1, std::memory_order_relaxed);
+            if (i > 0) fallbacks_.fetch_add(1, std::memory_order_relaxed);
+            if (served) *served = order[i];
+            return true;
+        }
+    }
+    unavailable_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void TerrainLodStack::getElevations(const LatLon* points, const TerrainLod* lods, size_t count,
+                                    double* outFt) const {
+    for (size_t i = 0; i < count; ++i) {
+        if (!getElevation(points[i].latitude, points[i].longitude, lods[i], outFt[i])) {
+            outFt[i] = 0.0;
+        }
+    }
+}
+
+TerrainLodStats TerrainLodStack::getStats() const {
+    TerrainLodStats stats;
+    for (size_t i = 0; i < TERRAIN_LOD_COUNT; ++i) {
+        stats.served[i] = served_[i].load(std::memory_order_relaxed);
+    }
+    stats.fallbacks = fallbacks_.load(std::memory_order_relaxed);
+    stats.unavailable = unavailable_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace AICopilot
@@ -0,0 +1,243 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Terrain Look-Ahead Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/terrain_lookahead.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+constexpr double GRAVITY_MPS2 = 9.80665;
+constexpr double KNOTS_TO_MPS = 0.514444;
+
+} // namespace
+
+TerrainLookaheadInput TerrainLookaheadInput::fromAircraftState(const AircraftState& state) {
+    TerrainLookaheadInput input;
+    input.position = state.position;
+    input.altitude = state.position.altitude;
+    input.trackDeg = state.heading;
+    input.groundSpeedKts = state.onGround ? 0.0 : state.groundSpeed;
+    input.verticalSpeedFpm = state.verticalSpeed;
+
+    // Coordinated turn: rate = g * tan(bank) / V
+    double speed = (state.trueAirspeed > 1.0 ? state.trueAirspeed : state.groundSpeed) * KNOTS_TO_MPS;
+    if (speed > 1.0 && std::fabs(state.bank) < 80.0) {
+        input.turnRateDegPerSec = GRAVITY_MPS2 * std::tan(state.bank * DEG_TO_RAD) / speed / DEG_TO_RAD;
+    }
+    return input;
+}
+
+void TerrainLookahead::setLookaheadTime(double seconds) {
+    lookaheadSeconds_ = std::max(60.0, std::min(seconds, 120.0));
+}
+
+void TerrainLookahead::reset() {
+    slices_.clear();
+    spacingNM_ = 0.0;
+    firstSliceNM_ = 0.0;
+}
+
+TerrainLookahead::Path TerrainLookahead::makePath(const TerrainLookaheadInput& input) const {
+    Path path;
+    path.origin = input.position;
+    path.trackRad = input.trackDeg * DEG_TO_RAD;
+    path.cosLat = std::max(0.01, std::cos(input.position.latitude * DEG_TO_RAD));
+
+    double nmPerSecond = input.groundSpeedKts / 3600.0;
+    path.curvature = input.turnRateDegPerSec * DEG_TO_RAD / nmPerSecond;
+    path.maxTurnNM = (std::fabs(path.curvature) > 1e-9)
+        ? MAX_TURN_DEG * DEG_TO_RAD / std::fabs(path.curvature)
+        : std::numeric_limits<double>::infinity();
+    return path;
+}
+
+Position TerrainLookahead::pointAt(const Path& path, double distanceNM, double& trackRad) const {
+    double turning = std::min(distanceNM, path.maxTurnNM);
+    double h0 = path.trackRad;
+    double east = 0.0;
+    double north = 0.0;
+
+    if (std::fabs(path.curvature) > 1e-9) {
+        trackRad = h0 + path.curvature * turning;
+        east = (std::cos(h0) - std::cos(trackRad)) / path.curvature;
+        north = (std::sin(trackRad) - std::sin(h0)) / path.curvature;
+    } else {
+        trackRad = h0;
+        east = turning * std::sin(h0);
+        north = turning * std::cos(h0);
+    }
+
+    // Straight on past the turn limit
+    double straight = distanceNM - turning;
+    east += straight * std::sin(trackRad);
+    north += straight * std::cos(trackRad);
+
+    Position p = path.origin;
+    p.latitude += north / 60.0;
+    p.longitude += east / (60.0 * path.cosLat);
+    return p;
+}
+
+void TerrainLookahead::offsetNM(const Path& path, const Position& p, double& eastNM, double& northNM) const {
+    double dLon = p.longitude - path.origin.longitude;
+    if (dLon > 180.0) dLon -= 360.0;
+    if (dLon < -180.0) dLon += 360.0;
+    eastNM = dLon * 60.0 * path.cosLat;
+    northNM = (p.latitude - path.origin.latitude) * 60.0;
+}
+
+size_t TerrainLookahead::retainSlices(const Path& path) {
+    const double dirEast = std::sin(path.trackRad);
+    const double dirNorth = std::cos(path.trackRad);
+
+    // Slices the aircraft has passed
+    double along = 0.0;
+    while (!slices_.empty()) {
+        double east, north;
+        offsetNM(path, slices_.front().center, east, north);
+        along = east * dirEast + north * dirNorth;
+        if (along >= 0.0) break;
+        slices_.pop_front();
+    }
+    if (slices_.empty()) {
+        firstSliceNM_ = 0.0;
+        return 0;
+    }
+    firstSliceNM_ = along;
+
+    // Keep slices while the new path still runs through them
+    for (size_t i = 0; i < slices_.size(); ++i) {
+        double track;
+        Position expected = pointAt(path, firstSliceNM_ + i * spacingNM_, track);
+        double e1, n1, e2, n2;
+        offsetNM(path, expected, e1, n1);
+        offsetNM(path, slices_[i].center, e2, n2);
+        if (std::hypot(e1 - e2, n1 - n2) > REUSE_TOLERANCE_NM) {
+            slices_.erase(slices_.begin() + static_cast<std::ptrdiff_t>(i), slices_.end());
+            break;
+        }
+    }
+    return slices_.size();
+}
+
+void TerrainLookahead::sampleSlices(const Path& path, size_t firstNew, size_t count,
+                                     const ElevationBatch& elevations) {
+    if (count == 0) return;
+
+    const int half = LATERAL_SAMPLES / 2;
+    points_.resize(count * LATERAL_SAMPLES);
+    elevations_.resize(points_.size());
+
+    std::vector<Slice> added(count);
+    for (size_t k = 0; k < count; ++k) {
+        double distance = firstSliceNM_ + (firstNew + k) * spacingNM_;
+        double track;
+        Slice& slice = added[k];
+        slice.center = pointAt(path, distance, track);
+        slice.halfWidthNM = BASE_HALF_WIDTH_NM + HALF_WIDTH_GROWTH * distance;
+
+        // Lateral samples across the track, right of it positive
+        double step = slice.halfWidthNM / half;
+        for (int j = -half; j <= half; ++j) {
+            double offset = j * step;
+            LatLon& point = points_[k * LATERAL_SAMPLES + (j + half)];
+            point.latitude = slice.center.latitude - offset * std::sin(track) / 60.0;
+            point.longitude = slice.center.longitude + offset * std::cos(track) / (60.0 * path.cosLat);
+        }
+    }
+
+    elevations(points_.data(), points_.size(), elevations_.data());
+
+    for (size_t k = 0; k < count; ++k) {
+        const double* row = &elevations_[k * LATERAL_SAMPLES];
+        added[k].terrainMax = *std::max_element(row, row + LATERAL_SAMPLES);
+        slices_.push_back(added[k]);
+    }
+}
+
+void TerrainLookahead::evaluate(const TerrainLookaheadInput& input) {
+    const double nmPerSecond = input.groundSpeedKts / 3600.0;
+    double impactTime = -1.0;
+
+    result_.level = TerrainWarningLevel::NONE;
+    result_.timeToConflict = -1.0;
+    result_.minimumClearance = std::numeric_limits<double>::infinity();
+    result_.slices = slices_.size();
+
+    for (size_t i = 0; i < slices_.size(); ++i) {
+        double t = (firstSliceNM_ + i * spacingNM_) / nmPerSecond;
+        double altitude = input.altitude + input.verticalSpeedFpm / 60.0 * t;
+        double clearance = altitude - slices_[i].terrainMax;
+        result_.minimumClearance = std::min(result_.minimumClearance, clearance);
+
+        if (clearance < REQUIRED_CLEARANCE_FT && result_.timeToConflict < 0.0) {
+            result_.timeToConflict = t;
+            result_.conflictPosition = slices_[i].center;
+            result_.conflictTerrain = slices_[i].terrainMax;
+        }
+        if (clearance < 0.0 && impactTime < 0.0) {
+            impactTime = t;
+        }
+    }
+
+    if (impactTime >= 0.0 && impactTime <= WARNING_TIME_S) {
+        result_.level = TerrainWarningLevel::PULL_UP;
+    } else if (result_.timeToConflict >= 0.0 && result_.timeToConflict <= WARNING_TIME_S) {
+        result_.level = TerrainWarningLevel::WARNING;
+    } else if (result_.timeToConflict >= 0.0 && result_.timeToConflict <= CAUTION_TIME_S) {
+        result_.level = TerrainWarningLevel::CAUTION;
+    }
+}
+
+const TerrainLookaheadResult& TerrainLookahead::update(const TerrainLookaheadInput& input,
+                                                       const ElevationBatch& elevations) {
+    result_ = TerrainLookaheadResult();
+
+    bool valid = std::isfinite(input.groundSpeedKts) && std::isfinite(input.trackDeg) &&
+                 std::isfinite(input.turnRateDegPerSec) && std::isfinite(input.altitude) &&
+                 std::isfinite(input.verticalSpeedFpm) &&
+                 std::fabs(input.position.latitude) < 89.0 && std::isfinite(input.position.longitude);
+    if (!valid || input.groundSpeedKts < MIN_GROUND_SPEED_KTS || !elevations) {
+        reset();
+        return result_;
+    }
+
+    // Slice spacing is kept while ground speed holds roughly steady, so slices stay reusable
+    double horizonNM = input.groundSpeedKts / 3600.0 * lookaheadSeconds_;
+    double spacing = std::max(MIN_SLICE_SPACING_NM, horizonNM / MAX_SLICES);
+    if (spacingNM_ <= 0.0 || std::fabs(spacing - spacingNM_) > 0.25 * spacingNM_) {
+        reset();
+        spacingNM_ = spacing;
+    }
+
+    Path path = makePath(input);
+    size_t retained = retainSlices(path);
+
+    size_t needed = (horizonNM >= firstSliceNM_)
+        ? static_cast<size_t>((horizonNM - firstSliceNM_) / spacingNM_) + 1
+        : 1;
+    if (retained > needed) {
+        slices_.resize(needed);
+        retained = needed;
+    }
+
+    sampleSlices(path, retained, needed - retained, elevations);
+    evaluate(input);
+    result_.slicesSampled = needed - retained;
+    return result_;
+}
+
+} // namespace AICopilot
@@ -0,0 +1,166 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Terrain Max Pyramid Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/terrain_max_pyramid.hpp"
+#include "../include/srtm_loader.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr int16_t NO_DATA = TerrainMaxPyramid::NO_DATA;
+
+// Round up so a stored cell is never below the terrain it stands for
+int16_t cellValue(double maxFt) {
+    double rounded = std::ceil(maxFt);
+    return static_cast<int16_t>(std::max(-32767.0, std::min(rounded, 32767.0)));
+}
+
+double normalizeLongitude(double longitude) {
+    while (longitude < -180.0) longitude += 360.0;
+    while (longitude >= 180.0) longitude -= 360.0;
+    return longitude;
+}
+
+} // namespace
+
+bool TerrainMaxPyramid::build(int minLatitude, int minLongitude, int latitudeTiles, int longitudeTiles,
+                              const CellMax& cellMax, int cellsPerDegree) {
+    levels_.clear();
+    if (latitudeTiles <= 0 || longitudeTiles <= 0 || cellsPerDegree <= 0 || !cellMax) {
+        return false;
+    }
+    minLatitude_ = minLatitude;
+    minLongitude_ = minLongitude;
+    cellDegrees_ = 1.0 / cellsPerDegree;
+
+    Level base;
+    base.rows = latitudeTiles * cellsPerDegree;
+    base.cols = longitudeTiles * cellsPerDegree;
+    base.cells.assign(static_cast<size_t>(base.rows) * base.cols, NO_DATA);
+    for (int row = 0; row < base.rows; ++row) {
+        double south = minLatitude + row * cellDegrees_;
+        for (int col = 0; col < base.cols; ++col) {
+            double west = minLongitude + col * cellDegrees_;
+            double maxFt = 0.0;
+            if (cellMax(south, west, south + cellDegrees_, west + cellDegrees_, maxFt)) {
+                base.cells[static_cast<size_t>(row) * base.cols + col] = cellValue(maxFt);
+            }
+        }
+    }
+    levels_.push_back(std::move(base));
+
+    // Each coarser cell is the highest of the 2 x 2 below it
+    while (levels_.back().rows > 1 || levels_.back().cols > 1) {
+        const Level& fine = levels_.back();
+        Level coarse;
+        coarse.rows = (fine.rows + 1) / 2;
+        coarse.cols = (fine.cols + 1) / 2;
+        coarse.cells.assign(static_cast<size_t>(coarse.rows) * coarse.cols, NO_DATA);
+        for (int row = 0; row < fine.rows; ++row) {
+            for (int col = 0; col < fine.cols; ++col) {
+                int16_t& cell = coarse.cells[static_cast<size_t>(row / 2) * coarse.cols + col / 2];
+                cell = std::max(cell, fine.cells[static_cast<size_t>(row) * fine.cols + col]);
+            }
+        }
+        levels_.push_back(std::move(coarse));
+    }
+    return true;
+}
+
+bool TerrainMaxPyramid::buildFromSrtm(SRTMLoader& loader, int minLatitude, int minLongitude,
+                                      int latitudeTiles, int longitudeTiles, int cellsPerDegree) {
+    return build(minLatitude, minLongitude, latitudeTiles, longitudeTiles,
+                 [&loader](double south, double west, double north, double east, double& maxFt) {
+                     if (!loader.IsDataAvailable(south, west)) return false;
+                     maxFt = loader.GetMaxElevation(south, west, north, east);
+                     return true;
+                 },
+                 cellsPerDegree);
+}
+
+size_t TerrainMaxPyramid::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (const Level& level : levels_) {
+        bytes += level.cells.size() * sizeof(int16_t);
+    }
+    return bytes;
+}
+
+int16_t TerrainMaxPyramid::getCell(size_t level, int row, int col) const {
+    if (level >= levels_.size()) return NO_DATA;
+    const Level& grid = levels_[level];
+    if (row < 0 || col < 0 || row >= grid.rows || col >= grid.cols) return NO_DATA;
+    return grid.cells[static_cast<size_t>(row) * grid.cols + col];
+}
+
+bool TerrainMaxPyramid::cellOf(size_t level, double latitude, double longitude, int& row, int& col) const {
+    if (level >= levels_.size()) return false;
+    const Level& grid = levels_[level];
+    double size = getCellDegrees(level);
+    double north = (latitude - minLatitude_) / size;
+    double east = (normalizeLongitude(longitude) - minLongitude_) / size;
+    if (!(north >= 0.0) || !(east >= 0.0)) return false;
+
+    // The north and east edges belong to the last row and column
+    row = std::min(static_cast<int>(north), grid.rows - 1);
+    col = std::min(static_cast<int>(east), grid.cols - 1);
+    return north <= levels_[0].rows * cellDegrees_ / size && east <= levels_[0].cols * cellDegrees_ / size;
+}
+
+bool TerrainMaxPyramid::getMaxElevation(double latitude, double longitude, size_t level, double& maxFt) const {
+    int row = 0;
+    int col = 0;
+    if (!cellOf(level, latitude, longitude, row, col)) return false;
+    int16_t cell = getCell(level, row, col);
+    if (cell == NO_DATA) return false;
+    maxFt = cell;
+    return true;
+}
+
+bool TerrainMaxPyramid::getMaxElevation(double south, double west, double north, double east,
+                                        double& maxFt) const {
+    if (levels_.empty()) return false;
+    if (south > north) std::swap(south, north);
+    if (west > east) std::swap(west, east);
+
+    // Clamp to the grid; a box wholly outside has no data
+    double gridNorth = minLatitude_ + levels_[0].rows * cellDegrees_;
+    double gridEast = minLongitude_ + levels_[0].cols * cellDegrees_;
+    south = std::max(south, static_cast<double>(minLatitude_));
+    west = std::max(west, static_cast<double>(minLongitude_));
+    north = std::min(north, gridNorth);
+    east = std::min(east, gridEast);
+    if (south > north || west > east) return false;
+
+    size_t level = 0;
+    while (level + 1 < levels_.size() &&
+           std::max(north - south, east - west) > getCellDegrees(level)) {
+        ++level;
+    }
+
+    int row0, col0, row1, col1;
+    cellOf(level, south, west, row0, col0);
+    cellOf(level, north, east, row1, col1);
+    int16_t highest = NO_DATA;
+    for (int row = row0; row <= row1; ++row) {
+        for (int col = col0; col <= col1; ++col) {
+            highest = std::max(highest, getCell(level, row, col));
+        }
+    }
+    if (highest == NO_DATA) return false;
+    maxFt = highest;
+    return true;
+}
+
+} // namespace AICopilot
@@ -0,0 +1,503 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Terrain Pack Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/terrain_pack.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AICopilot {
+
+namespace {
+
+constexpr int16_t VOID_SAMPLE = TerrainPack::VOID_SAMPLE;
+
+size_t alignUp(size_t value) {
+    return (value + 7) & ~static_cast<size_t>(7);
+}
+
+double normalizeLongitude(double longitude) {
+    while (longitude < -180.0) longitude += 360.0;
+    while (longitude >= 180.0) longitude -= 360.0;
+    return longitude;
+}
+
+int16_t readSample(const uint8_t* bytes) {
+    return static_cast<int16_t>(static_cast<uint16_t>(bytes[0]) |
+                                (static_cast<uint16_t>(bytes[1]) << 8));
+}
+
+void appendVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+std::vector<uint8_t> encodeRaw(const std::vector<int16_t>& samples) {
+    std::vector<uint8_t> out;
+    out.reserve(samples.size() * 2);
+    for (int16_t sample : samples) {
+        uint16_t bits = static_cast<uint16_t>(sample);
+        out.push_back(static_cast<uint8_t>(bits & 0xFF));
+        out.push_back(static_cast<uint8_t>(bits >> 8));
+    }
+    return out;
+}
+
+std::vector<uint8_t> encodeDelta(const std::vector<int16_t>& samples, int edge) {
+    std::vector<uint8_t> out;
+    out.reserve(samples.size());
+    for (int row = 0; row < edge; ++row) {
+        int32_t previous = 0;
+        for (int col = 0; col < edge; ++col) {
+            int32_t value = samples[static_cast<size_t>(row) * edge + col];
+            int32_t delta = value - previous;
+            appendVarint(out, (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31));
+            previous = value;
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+// ============================================================================
+// TerrainPackBuilder
+// ============================================================================
+
+TerrainPackBuilder::TerrainPackBuilder(int samplesPerEdge)
+    : samplesPerEdge_(std::max(2, std::min(samplesPerEdge, 3601))) {
+}
+
+void TerrainPackBuilder::addPoint(double latitude, double longitude, double elevationFt) {
+    if (!(latitude >= -90.0 && latitude < 90.0) || !std::isfinite(longitude) || !std::isfinite(elevationFt)) {
+        return;
+    }
+    longitude = normalizeLongitude(longitude);
+
+    int tileLat = static_cast<int>(std::floor(latitude));
+    int tileLon = static_cast<int>(std::floor(longitude));
+    int last = samplesPerEdge_ - 1;
+    int row = static_cast<int>(std::lround((tileLat + 1 - latitude) * last));
+    int col = static_cast<int>(std::lround((longitude - tileLon) * last));
+    row = std::max(0, std::min(row, last));
+    col = std::max(0, std::min(col, last));
+
+    auto& samples = tiles_[packTileKey(tileLat, tileLon)];
+    if (samples.empty()) {
+        samples.assign(static_cast<size_t>(samplesPerEdge_) * samplesPerEdge_, VOID_SAMPLE);
+    }
+
+    long rounded = std::lround(std::max(-32767.0, std::min(elevationFt, 32767.0)));
+    int16_t& sample = samples[static_cast<size_t>(row) * samplesPerEdge_ + col];
+    if (sample == VOID_SAMPLE || rounded > sample) {
+        sample = static_cast<int16_t>(rounded);
+    }
+    pointCount_++;
+}
+
+void TerrainPackBuilder::fillVoids() {
+    const int edge = samplesPerEdge_;
+    const int last = edge - 1;
+
+    // Shared edges must agree; take the higher sample where both tiles have one
+    auto stitch = [](int16_t& a, int16_t& b) {
+        if (a == VOID_SAMPLE) a = b;
+        else if (b == VOID_SAMPLE) b = a;
+        else a = b = std::max(a, b);
+    };
+    for (auto& tile : tiles_) {
+        int lat = tileKeyLatitude(tile.first);
+        int lon = tileKeyLongitude(tile.first);
+        auto north = tiles_.find(packTileKey(lat + 1, lon));
+        if (lat + 1 < 90 && north != tiles_.end()) {
+            for (int col = 0; col < edge; ++col) {
+                stitch(tile.second[col], north->second[static_cast<size_t>(last) * edge + col]);
+            }
+        }
+        auto east = tiles_.find(packTileKey(lat, lon + 1));
+        if (lon + 1 < 180 && east != tiles_.end()) {
+            for (int row = 0; row < edge; ++row) {
+                stitch(tile.second[static_cast<size_t>(row) * edge + last],
+                       east->second[static_cast<size_t>(row) * edge]);
+            }
+        }
+    }
+
+    // Breadth-first flood from the populated samples: each void takes its nearest neighbour's value
+    for (auto& tile : tiles_) {
+        auto& samples = tile.second;
+        std::deque<int> frontier;
+        for (int i = 0; i < edge * edge; ++i) {
+            if (samples[i] != VOID_SAMPLE) frontier.push_back(i);
+        }
+        if (frontier.empty()) continue;
+
+        while (!frontier.empty()) {
+            int index = frontier.front();
+            frontier.pop_front();
+            int row = index / edge;
+            int col = index % edge;
+            const int neighbours[4][2] = {{row - 1, col}, {row + 1, col}, {row, col - 1}, {row, col + 1}};
+            for (const auto& n : neighbours) {
+                if (n[0] < 0 || n[0] > last || n[1] < 0 || n[1] > last) continue;
+                int next = n[0] * edge + n[1];
+                if (samples[next] == VOID_SAMPLE) {
+                    samples[next] = samples[index];
+                    frontier.push_back(next);
+                }
+            }
+        }
+    }
+}
+
+bool TerrainPackBuilder::write(const std::string& path, TerrainPackEncoding encoding) {
+    if (tiles_.empty()) {
+        std::cerr << "TerrainPack: Nothing to write to " << path << std::endl;
+        return false;
+    }
+
+    fillVoids();
+
+    int minLat = 90, maxLat = -90, minLon = 180, maxLon = -180;
+    for (const auto& tile : tiles_) {
+        minLat = std::min(minLat, tileKeyLatitude(tile.first));
+        maxLat = std::max(maxLat, tileKeyLatitude(tile.first));
+        minLon = std::min(minLon, tileKeyLongitude(tile.first));
+        maxLon = std::max(maxLon, tileKeyLongitude(tile.first));
+    }
+    const int latSpan = maxLat - minLat + 1;
+    const int lonSpan = maxLon - minLon + 1;
+
+    TerrainPackHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, TerrainPack::MAGIC, sizeof(header.magic));
+    header.version = TerrainPack::VERSION;
+    header.samplesPerEdge = static_cast<uint16_t>(samplesPerEdge_);
+    header.tileCount = static_cast<uint32_t>(tiles_.size());
+    header.minLatitude = static_cast<int16_t>(minLat);
+    header.minLongitude = static_cast<int16_t>(minLon);
+    header.latitudeSpan = static_cast<uint16_t>(latSpan);
+    header.longitudeSpan = static_cast<uint16_t>(lonSpan);
+    header.minElevation = VOID_SAMPLE;
+    header.maxElevation = VOID_SAMPLE;
+    header.lookupOffset = alignUp(sizeof(TerrainPackHeader));
+    header.entriesOffset = alignUp(header.lookupOffset + sizeof(uint32_t) * latSpan * lonSpan);
+
+    std::vector<uint32_t> lookup(static_cast<size_t>(latSpan) * lonSpan, TerrainPack::NO_TILE);
+    std::vector<TerrainPackTileEntry> entries;
+    std::vector<std::vector<uint8_t>> payloads;
+    entries.reserve(tiles_.size());
+    payloads.reserve(tiles_.size());
+
+    size_t offset = alignUp(header.entriesOffset + sizeof(TerrainPackTileEntry) * tiles_.size());
+    for (const auto& tile : tiles_) {
+        TerrainPackTileEntry entry;
+        std::memset(&entry, 0, sizeof(entry));
+        entry.key = tile.first;
+        entry.minElevation = VOID_SAMPLE;
+        entry.maxElevation = VOID_SAMPLE;
+        for (int16_t sample : tile.second) {
+            if (sample == VOID_SAMPLE) continue;
+            if (entry.minElevation == VOID_SAMPLE || sample < entry.minElevation) entry.minElevation = sample;
+            if (entry.maxElevation == VOID_SAMPLE || sample > entry.maxElevation) entry.maxElevation = sample;
+        }
+        if (entry.minElevation != VOID_SAMPLE) {
+            if (header.minElevation == VOID_SAMPLE || entry.minElevation < header.minElevation) header.minElevation = entry.minElevation;
+            if (header.maxElevation == VOID_SAMPLE || entry.maxElevation > header.maxElevation) header.maxElevation = entry.maxElevation;
+        }
+
+        std::vector<uint8_t> payload = encodeRaw(tile.second);
+        entry.encoding = static_cast<uint8_t>(TerrainPackEncoding::RAW);
+        if (encoding == TerrainPackEncoding::DELTA) {
+            std::vector<uint8_t> delta = encodeDelta(tile.second, samplesPerEdge_);
+            if (delta.size() < payload.size()) {
+                payload = std::move(delta);
+                entry.encoding = static_cast<uint8_t>(TerrainPackEncoding::DELTA);
+            }
+        }
+        entry.size = static_cast<uint32_t>(payload.size());
+        entry.offset = offset;
+        offset = alignUp(offset + payload.size());
+
+        int row = tileKeyLatitude(tile.first) - minLat;
+        int col = tileKeyLongitude(tile.first) - minLon;
+        lookup[static_cast<size_t>(row) * lonSpan + col] = static_cast<uint32_t>(entries.size());
+        entries.push_back(entry);
+        payloads.push_back(std::move(payload));
+    }
+    header.fileSize = offset;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "TerrainPack: Could not create " << path << std::endl;
+        return false;
+    }
+
+    const char padding[8] = {0};
+    auto pad = [&](size_t position) {
+        size_t current = static_cast<size_t>(out.tellp());
+        if (position > current) out.write(padding, static_cast<std::streamsize>(position - current));
+    };
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    pad(header.lookupOffset);
+    out.write(reinterpret_cast<const char*>(lookup.data()), static_cast<std::streamsize>(lookup.size() * sizeof(uint32_t)));
+    pad(header.entriesOffset);
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(TerrainPackTileEntry)));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        pad(entries[i].offset);
+        out.write(reinterpret_cast<const char*>(payloads[i].data()), static_cast<std::streamsize>(payloads[i].size()));
+    }
+    pad(header.fileSize);
+
+    if (!out) {
+        std::cerr << "TerrainPack: Write failed for " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// TerrainPack
+// ============================================================================
+
+TerrainPack::~TerrainPack() {
+    close();
+}
+
+bool TerrainPack::isPackFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MAGIC)] = {0};
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool TerrainPack::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || static_cast<size_t>(size.QuadPart) < sizeof(TerrainPackHeader)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle_ = file;
+    mappingHandle_ = mapping;
+    size_ = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(TerrainPackHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // the mapping keeps the file referenced
+    if (view == MAP_FAILED) {
+        return false;
+    }
+
+    madvise(view, static_cast<size_t>(st.st_size), MADV_RANDOM);
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+
+    data_ = static_cast<const uint8_t*>(view);
+    if (!validate()) {
+        std::cerr << "TerrainPack: " << path << " is not a valid terrain pack" << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void TerrainPack::close() {
+    if (data_ != nullptr) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(static_cast<HANDLE>(mappingHandle_));
+        CloseHandle(static_cast<HANDLE>(fileHandle_));
+#else
+        munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+    data_ = nullptr;
+    size_ = 0;
+    fileHandle_ = nullptr;
+    mappingHandle_ = nullptr;
+
+    std::lock_guard<std::mutex> lock(decodeMutex_);
+    decoded_.clear();
+}
+
+bool TerrainPack::validate() const {
+    const TerrainPackHeader& h = header();
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 || h.version != VERSION) return false;
+    if (h.samplesPerEdge < 2 || h.fileSize != size_) return false;
+
+    // Only the fixed-size sections are checked here; payload bounds are checked per tile
+    uint64_t lookupEnd = h.lookupOffset + sizeof(uint32_t) * static_cast<uint64_t>(h.latitudeSpan) * h.longitudeSpan;
+    uint64_t entriesEnd = h.entriesOffset + sizeof(TerrainPackTileEntry) * static_cast<uint64_t>(h.tileCount);
+    return h.lookupOffset >= sizeof(TerrainPackHeader) && lookupEnd <= size_ &&
+           h.entriesOffset >= lookupEnd && entriesEnd <= size_;
+}
+
+const TerrainPackTileEntry* TerrainPack::findEntry(int tileLatitude, int tileLongitude) const {
+    if (!isOpen()) return nullptr;
+    const TerrainPackHeader& h = header();
+    int row = tileLatitude - h.minLatitude;
+    int col = tileLongitude - h.minLongitude;
+    if (row < 0 || row >= h.latitudeSpan || col < 0 || col >= h.longitudeSpan) return nullptr;
+
+    uint32_t index;
+    std::memcpy(&index, data_ + h.lookupOffset + sizeof(uint32_t) * (static_cast<size_t>(row) * h.longitudeSpan + col),
+                sizeof(index));
+    if (index >= h.tileCount) return nullptr;
+
+    const auto* entry = reinterpret_cast<const TerrainPackTileEntry*>(data_ + h.entriesOffset) + index;
+    if (entry->offset + entry->size > size_) return nullptr;
+    return entry;
+}
+
+std::shared_ptr<TerrainPack::DecodedTile> TerrainPack::decodeTile(const TerrainPackTileEntry& entry) const {
+    std::lock_guard<std::mutex> lock(decodeMutex_);
+    if (auto cached = decoded_.find(entry.key)) return cached;
+
+    const int edge = header().samplesPerEdge;
+    auto tile = std::make_shared<DecodedTile>(static_cast<size_t>(edge) * edge);
+    const uint8_t* cursor = data_ + entry.offset;
+    const uint8_t* end = cursor + entry.size;
+    for (int row = 0; row < edge; ++row) {
+        int32_t previous = 0;
+        for (int col = 0; col < edge; ++col) {
+            uint32_t zigzag = 0;
+            int shift = 0;
+            while (true) {
+                if (cursor == end || shift > 28) return nullptr;  // truncated or corrupt payload
+                uint8_t byte = *cursor++;
+                zigzag |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) break;
+                shift += 7;
+            }
+            previous += static_cast<int32_t>(zigzag >> 1) ^ -static_cast<int32_t>(zigzag & 1);
+            (*tile)[static_cast<size_t>(row) * edge + col] = static_cast<int16_t>(previous);
+        }
+    }
+
+    decoded_.insert(entry.key, tile, tile->size() * sizeof(int16_t));
+    return tile;
+}
+
+bool TerrainPack::getElevation(double latitude, double longitude, double& elevationFt) const {
+    if (!isOpen() || !(latitude >= -90.0 && latitude < 90.0) || !std::isfinite(longitude)) return false;
+    longitude = normalizeLongitude(longitude);
+
+    int tileLat = static_cast<int>(std::floor(latitude));
+    int tileLon = static_cast<int>(std::floor(longitude));
+    const TerrainPackTileEntry* entry = findEntry(tileLat, tileLon);
+    if (entry == nullptr) return false;
+
+    const int edge = header().samplesPerEdge;
+    const int last = edge - 1;
+    double rowPos = (tileLat + 1 - latitude) * last;
+    double colPos = (longitude - tileLon) * last;
+    int r0 = std::max(0, std::min(static_cast<int>(rowPos), last - 1));
+    int c0 = std::max(0, std::min(static_cast<int>(colPos), last - 1));
+    double fr = std::max(0.0, std::min(rowPos - r0, 1.0));
+    double fc = std::max(0.0, std::min(colPos - c0, 1.0));
+
+    int16_t corners[4];
+    if (entry->encoding == static_cast<uint8_t>(TerrainPackEncoding::RAW)) {
+        if (entry->size < static_cast<uint64_t>(edge) * edge * sizeof(int16_t)) return false;
+        const uint8_t* samples = data_ + entry->offset;
+        for (int i = 0; i < 4; ++i) {
+            size_t index = static_cast<size_t>(r0 + i / 2) * edge + (c0 + i % 2);
+            corners[i] = readSample(samples + index * sizeof(int16_t));
+        }
+    } else {
+        std::shared_ptr<DecodedTile> tile = decodeTile(*entry);
+        if (!tile) return false;
+        for (int i = 0; i < 4; ++i) {
+            corners[i] = (*tile)[static_cast<size_t>(r0 + i / 2) * edge + (c0 + i % 2)];
+        }
+    }
+
+    // Bilinear over the non-void corners
+    const double weights[4] = {(1 - fr) * (1 - fc), (1 - fr) * fc, fr * (1 - fc), fr * fc};
+    double sum = 0.0;
+    double weight = 0.0;
+    for (int i = 0; i < 4; ++i) {
+        if (corners[i] == VOID_SAMPLE) continue;
+        sum += corners[i] * weights[i];
+        weight += weights[i];
+    }
+    if (weight <= 0.0) return false;
+
+    elevationFt = sum / weight;
+    return true;
+}
+
+bool TerrainPack::getTileRange(int tileLatitude, int tileLongitude, double& minFt, double& maxFt) const {
+    const TerrainPackTileEntry* entry = findEntry(tileLatitude, tileLongitude);
+    if (entry == nullptr || entry->minElevation == VOID_SAMPLE) return false;
+    minFt = entry->minElevation;
+    maxFt = entry->maxElevation;
+    return true;
+}
+
+void TerrainPack::setDecodeBudget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(decodeMutex_);
+    decoded_.setByteBudget(bytes);
+}
+
+TileCacheStats TerrainPack::getDecodeCacheStats() const {
+    std::lock_guard<std::mutex> lock(decodeMutex_);
+    return decoded_.getStats();
+}
+
+} // namespace AICopilot
@@ -0,0 +1,226 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Terrain Prefetcher Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/terrain_prefetcher.hpp"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <iostream>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+constexpr double DEG_TO_RAD = PI / 180.0;
+
+// Flat-earth distance; accurate enough to space samples within a leg
+double distanceNM(const Position& a, const Position& b) {
+    double dLat = (b.latitude - a.latitude) * 60.0;
+    double dLon = (b.longitude - a.longitude) * 60.0 *
+                  std::cos((a.latitude + b.latitude) * 0.5 * DEG_TO_RAD);
+    return std::sqrt(dLat * dLat + dLon * dLon);
+}
+
+Position offsetPosition(const Position& origin, double bearingDeg, double distanceNM) {
+    Position p = origin;
+    double cosLat = std::max(0.01, std::cos(origin.latitude * DEG_TO_RAD));
+    p.latitude += distanceNM * std::cos(bearingDeg * DEG_TO_RAD) / 60.0;
+    p.longitude += distanceNM * std::sin(bearingDeg * DEG_TO_RAD) / (60.0 * cosLat);
+    return p;
+}
+
+} // namespace
+
+TerrainPrefetcher::TerrainPrefetcher(TileLoader loader, std::shared_ptr<IoExecutor> executor)
+    : loader_(std::move(loader)),
+      executor_(executor ? std::move(executor) : IoExecutor::shared()) {
+}
+
+TerrainPrefetcher::~TerrainPrefetcher() {
+    stop();
+}
+
+void TerrainPrefetcher::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    running_ = true;
+    schedule();
+}
+
+void TerrainPrefetcher::stop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!running_) return;
+    running_ = false;
+    idleCv_.wait(lock, [this] { return !loading_; });
+    queue_.clear();
+    pending_.clear();
+    idleCv_.notify_all();
+}
+
+bool TerrainPrefetcher::isRunning() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return running_;
+}
+
+TileKey TerrainPrefetcher::tileFor(double latitude, double longitude) {
+    int tileLatitude = static_cast<int>(std::floor(std::max(-90.0, std::min(89.999, latitude))));
+    int tileLongitude = static_cast<int>(std::floor(longitude));
+    while (tileLongitude < -180) tileLongitude += 360;
+    while (tileLongitude >= 180) tileLongitude -= 360;
+    return packTileKey(tileLatitude, tileLongitude);
+}
+
+bool TerrainPrefetcher::request(int tileLatitude, int tileLongitude, bool urgent) {
+    TileKey key = packTileKey(tileLatitude, tileLongitude);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.count(key) != 0) {
+            // Already queued; an urgent request still moves it to the front
+            auto it = std::find(queue_.begin(), queue_.end(), key);
+            if (urgent && it != queue_.end() && it != queue_.begin()) {
+                queue_.erase(it);
+                queue_.push_front(key);
+            }
+            return false;
+        }
+        if (queue_.size() >= MAX_PENDING_TILES) {
+            stats_.dropped++;
+            return false;
+        }
+
+        pending_.insert(key);
+        if (urgent) {
+            queue_.push_front(key);
+        } else {
+            queue_.push_back(key);
+        }
+        stats_.requested++;
+        schedule();
+    }
+    return true;
+}
+
+size_t TerrainPrefetcher::prefetchRoute(const Navigation& navigation, const Position& current) {
+    return prefetchRoute(navigation.getFlightPlan().waypoints,
+                         navigation.getActiveWaypointIndex(), current);
+}
+
+size_t TerrainPrefetcher::prefetchRoute(const std::vector<Waypoint>& waypoints, size_t fromIndex,
+                                        const Position& current) {
+    size_t queued = 0;
+    double budgetNM = ROUTE_HORIZON_NM;
+    Position from = current;
+    for (size_t i = fromIndex; i < waypoints.size() && budgetNM > 0.0; ++i) {
+        queued += queueSegment(from, waypoints[i].position, budgetNM);
+        from = waypoints[i].position;
+    }
+    return queued;
+}
+
+size_t TerrainPrefetcher::queueSegment(const Position& from, const Position& to, double& budgetNM) {
+    double length = distanceNM(from, to);
+    double covered = std::min(length, budgetNM);
+    budgetNM -= covered;
+
+    size_t queued = 0;
+    int steps = static_cast<int>(std::ceil(covered / SAMPLE_SPACING_NM));
+    for (int s = 0; s <= steps; ++s) {
+        double fraction = (length > 0.0) ? std::min(covered, s * SAMPLE_SPACING_NM) / length : 0.0;
+        TileKey key = tileFor(from.latitude + (to.latitude - from.latitude) * fraction,
+                              from.longitude + (to.longitude - from.longitude) * fraction);
+        if (request(tileKeyLatitude(key), tileKeyLongitude(key))) {
+            queued++;
+        }
+    }
+    return queued;
+}
+
+size_t TerrainPrefetcher::prefetchLookAhead(const Position& current, double trackDeg,
+                                            double groundSpeedKts) {
+    double rangeNM = std::max(LOOKAHEAD_MIN_NM, groundSpeedKts * LOOKAHEAD_MINUTES / 60.0);
+    const double bearings[] = {trackDeg, trackDeg - CONE_HALF_ANGLE_DEG, trackDeg + CONE_HALF_ANGLE_DEG};
+
+    // Nearest tiles first, each listed once
+    std::vector<TileKey> tiles;
+    for (double d = 0.0; d <= rangeNM + SAMPLE_SPACING_NM * 0.5; d += SAMPLE_SPACING_NM) {
+        for (double bearing : bearings) {
+            Position p = offsetPosition(current, bearing, std::min(d, rangeNM));
+            TileKey key = tileFor(p.latitude, p.longitude);
+            if (std::find(tiles.begin(), tiles.end(), key) == tiles.end()) {
+                tiles.push_back(key);
+            }
+        }
+    }
+
+    // Pushed to the front farthest first, so the nearest tile loads next
+    size_t queued = 0;
+    for (auto it = tiles.rbegin(); it != tiles.rend(); ++it) {
+        if (request(tileKeyLatitude(*it), tileKeyLongitude(*it), true)) {
+            queued++;
+        }
+    }
+    return queued;
+}
+
+void TerrainPrefetcher::waitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleCv_.wait(lock, [this] { return pending_.empty() || !running_; });
+}
+
+TerrainPrefetchStats TerrainPrefetcher::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TerrainPrefetchStats stats = stats_;
+    stats.pending = pending_.size();
+    return stats;
+}
+
+void TerrainPrefetcher::schedule() {
+    if (running_ && !loading_ && !queue_.empty()) {
+        loading_ = true;
+        executor_->post([this] { loadNext(); });
+    }
+}
+
+void TerrainPrefetcher::loadNext() {
+    TileKey key = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || queue_.empty()) {
+            loading_ = false;
+            idleCv_.notify_all();
+            return;
+        }
+        key = queue_.front();
+        queue_.pop_front();
+    }
+
+    // Disk I/O happens here, off the flight loop
+    bool loaded = false;
+    try {
+        loaded = loader_(tileKeyLatitude(key), tileKeyLongitude(key));
+    } catch (const std::exception& e) {
+        std::cerr << "TerrainPrefetcher: tile load failed: " << e.what() << std::endl;
+    }
+
+    // stop() may be waiting on loading_, so this is the last touch of this
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.erase(key);
+    if (loaded) {
+        stats_.loaded++;
+    } else {
+        stats_.unavailable++;
+    }
+    loading_ = false;
+    schedule();
+    idleCv_.notify_all();
+}
+
+} // namespace AICopilot
@@ -0,0 +1,400 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Tiled Raster Source Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/tiled_raster_source.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <exception>
+#include <iostream>
+#include <limits>
+
+#ifdef ENABLE_GDAL
+#include "gdal_priv.h"
+#endif
+
+namespace AICopilot {
+
+namespace {
+
+constexpr double METERS_TO_FEET = 3.28084;
+constexpr float NO_DATA = std::numeric_limits<float>::quiet_NaN();
+
+} // namespace
+
+TiledRasterSource::TiledRasterSource(std::vector<RasterLevel> levels, BlockReader reader,
+                                     size_t byteBudget)
+    : levels_(std::move(levels)), reader_(std::move(reader)), blocks_(byteBudget) {
+}
+
+TiledRasterSource::~TiledRasterSource() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        stopping_ = true;
+    }
+    workCv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+size_t TiledRasterSource::selectLevel(double resolutionDeg) const {
+    size_t best = 0;
+    if (resolutionDeg <= 0.0) return best;
+
+    double bestPixel = 0.0;
+    for (size_t level = 0; level < levels_.size(); ++level) {
+        double pixel = std::abs(levels_[level].pixelWidth);
+        if (pixel <= resolutionDeg && pixel > bestPixel) {
+            best = level;
+            bestPixel = pixel;
+        }
+    }
+    return best;
+}
+
+bool TiledRasterSource::getElevation(double latitude, double longitude, double resolutionDeg,
+                                     double& elevationFt) {
+    if (levels_.empty()) return false;
+    const size_t level = selectLevel(resolutionDeg);
+    const RasterLevel& raster = levels_[level];
+
+    // Pixel centres are the samples
+    double px = (longitude - raster.originLongitude) / raster.pixelWidth - 0.5;
+    double py = (latitude - raster.originLatitude) / raster.pixelHeight - 0.5;
+    if (px < -0.5 || py < -0.5 || px > raster.width - 0.5 || py > raster.height - 0.5) {
+        return false;
+    }
+    px = std::max(0.0, std::min(px, raster.width - 1.0));
+    py = std::max(0.0, std::min(py, raster.height - 1.0));
+
+    int x = std::min(static_cast<int>(px), std::max(0, raster.width - 2));
+    int y = std::min(static_cast<int>(py), std::max(0, raster.height - 2));
+    double fx = std::min(1.0, px - x);
+    double fy = std::min(1.0, py - y);
+
+    // The four pixels usually share a block; keep the last one at hand
+    std::shared_ptr<const Block> block;
+    uint64_t blockId = std::numeric_limits<uint64_t>::max();
+    float v00 = samplePixel(level, x, y, block, blockId);
+    float v10 = samplePixel(level, x + 1, y, block, blockId);
+    float v01 = samplePixel(level, x, y + 1, block, blockId);
+    float v11 = samplePixel(level, x + 1, y + 1, block, blockId);
+
+    // Renormalise the weights over the pixels that have data
+    double weights[4] = {(1 - fx) * (1 - fy), fx * (1 - fy), (1 - fx) * fy, fx * fy};
+    float values[4] = {v00, v10, v01, v11};
+    double total = 0.0;
+    double weighted = 0.0;
+    for (int i = 0; i < 4; ++i) {
+        if (std::isnan(values[i])) continue;
+        total += weights[i];
+        weighted += weights[i] * values[i];
+    }
+    if (total <= 0.0) {
+        // Only no-data pixels carry weight; fall back to any valid neighbour
+        for (float value : values) {
+            if (!std::isnan(value)) {
+                elevationFt = value;
+                return true;
+            }
+        }
+        return false;
+    }
+    elevationFt = weighted / total;
+    return true;
+}
+
+void TiledRasterSource::getElevations(const LatLon* points, size_t count, double resolutionDeg,
+                                      double* outFt, bool* found) {
+    for (size_t i = 0; i < count; ++i) {
+        double elevation = 0.0;
+        bool ok = getElevation(points[i].latitude, points[i].longitude, resolutionDeg, elevation);
+        outFt[i] = ok ? elevation : 0.0;
+        if (found) found[i] = ok;
+    }
+}
+
+size_t TiledRasterSource::prefetch(double latitude, double longitude, double radiusDeg,
+                                   double resolutionDeg) {
+    if (levels_.empty()) return 0;
+    const size_t level = selectLevel(resolutionDeg);
+    const RasterLevel& raster = levels_[level];
+
+    // Block range covering the square around the point, clipped to the raster
+    auto blockColumn = [&](double lon) {
+        double px = (lon - raster.originLongitude) / raster.pixelWidth;
+        return static_cast<int>(std::floor(px / raster.blockWidth));
+    };
+    auto blockRow = [&](double lat) {
+        double py = (lat - raster.originLatitude) / raster.pixelHeight;
+        return static_cast<int>(std::floor(py / raster.blockHeight));
+    };
+    int x0 = blockColumn(longitude - radiusDeg);
+    int x1 = blockColumn(longitude + radiusDeg);
+    int y0 = blockRow(latitude - radiusDeg);
+    int y1 = blockRow(latitude + radiusDeg);
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, raster.blocksAcross() - 1);
+    y1 = std::min(y1, raster.blocksDown() - 1);
+    if (x0 > x1 || y0 > y1) return 0;
+
+    // Nearest blocks first
+    int centreX = std::max(x0, std::min(blockColumn(longitude), x1));
+    int centreY = std::max(y0, std::min(blockRow(latitude), y1));
+    std::vector<std::pair<int, uint64_t>> candidates;
+    for (int by = y0; by <= y1; ++by) {
+        for (int bx = x0; bx <= x1; ++bx) {
+            int ring = std::max(std::abs(bx - centreX), std::abs(by - centreY));
+            candidates.emplace_back(ring, blockKey(level, bx, by));
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    // Skip blocks already resident
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                        [this](const auto& c) { return blocks_.contains(c.second); }),
+                         candidates.end());
+    }
+
+    size_t queued = 0;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (stopping_) return 0;
+        for (const auto& candidate : candidates) {
+            if (pending_.count(candidate.second)) continue;
+            if (pending_.size() >= MAX_PENDING_BLOCKS) {
+                prefetchDropped_++;
+                continue;
+            }
+            queue_.push_back(candidate.second);
+            pending_.insert(candidate.second);
+            prefetchQueued_++;
+            queued++;
+        }
+        if (queued > 0 && !worker_.joinable()) {
+            worker_ = std::thread(&TiledRasterSource::workerLoop, this);
+        }
+    }
+    if (queued > 0) {
+        workCv_.notify_one();
+    }
+    return queued;
+}
+
+void TiledRasterSource::waitIdle() {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    idleCv_.wait(lock, [this] { return pending_.empty() || stopping_; });
+}
+
+TiledRasterStats TiledRasterSource::getStats() const {
+    TiledRasterStats stats;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        stats.cache = blocks_.getStats();
+        stats.blockReads = blockReads_;
+        stats.readFailures = readFailures_;
+    }
+    std::lock_guard<std::mutex> lock(queueMutex_);
+    stats.prefetchQueued = prefetchQueued_;
+    stats.prefetchDropped = prefetchDropped_;
+    stats.pending = pending_.size();
+    return stats;
+}
+
+void TiledRasterSource::setByteBudget(size_t byteBudget) {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    blocks_.setByteBudget(byteBudget);
+}
+
+float TiledRasterSource::samplePixel(size_t level, int x, int y, std::shared_ptr<const Block>& block,
+                                     uint64_t& blockId) {
+    const RasterLevel& raster = levels_[level];
+    if (x < 0 || y < 0 || x >= raster.width || y >= raster.height) {
+        return NO_DATA;
+    }
+
+    int blockX = x / raster.blockWidth;
+    int blockY = y / raster.blockHeight;
+    uint64_t key = blockKey(level, blockX, blockY);
+    if (key != blockId) {
+        block = acquireBlock(level, blockX, blockY);
+        blockId = key;
+    }
+    if (!block) {
+        return NO_DATA;
+    }
+
+    int column = x - blockX * raster.blockWidth;
+    int row = y - blockY * raster.blockHeight;
+    return block->elevations[static_cast<size_t>(row) * raster.blockWidth + column];
+}
+
+std::shared_ptr<const TiledRasterSource::Block> TiledRasterSource::acquireBlock(
+    size_t level, int blockX, int blockY) {
+    uint64_t key = blockKey(level, blockX, blockY);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        if (auto block = blocks_.find(key)) {
+            return block;
+        }
+    }
+    return readBlock(level, blockX, blockY);
+}
+
+std::shared_ptr<const TiledRasterSource::Block> TiledRasterSource::readBlock(
+    size_t level, int blockX, int blockY) {
+    const RasterLevel& raster = levels_[level];
+    auto block = std::make_shared<Block>();
+    block->elevations.assign(static_cast<size_t>(raster.blockWidth) * raster.blockHeight, NO_DATA);
+    bool ok = reader_ && reader_(level, blockX, blockY, block->elevations.data());
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    blockReads_++;
+    if (!ok) {
+        // Not cached, so a transient failure is retried by the next lookup
+        readFailures_++;
+        return nullptr;
+    }
+    blocks_.insert(blockKey(level, blockX, blockY), block,
+                   sizeof(Block) + block->elevations.size() * sizeof(float));
+    return block;
+}
+
+void TiledRasterSource::workerLoop() {
+    std::unique_lock<std::mutex> lock(queueMutex_);
+    while (true) {
+        workCv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (stopping_) break;
+
+        uint64_t key = queue_.front();
+        queue_.pop_front();
+        lock.unlock();
+
+        size_t level = static_cast<size_t>(key >> 48);
+        int blockY = static_cast<int>((key >> 24) & 0xFFFFFF);
+        int blockX = static_cast<int>(key & 0xFFFFFF);
+        try {
+            acquireBlock(level, blockX, blockY);
+        } catch (const std::exception& e) {
+            std::cerr << "Tiled raster prefetch failed: " << e.what() << std::endl;
+        }
+
+        lock.lock();
+        pending_.erase(key);
+        if (pending_.empty()) {
+            idleCv_.notify_all();
+        }
+    }
+    queue_.clear();
+    pending_.clear();
+    idleCv_.notify_all();
+}
+
+#ifdef ENABLE_GDAL
+
+std::shared_ptr<TiledRasterSource> TiledRasterSource::openGdal(const std::string& path,
+                                                               size_t byteBudget) {
+    GDALAllRegister();
+    std::shared_ptr<GDALDataset> dataset(
+        static_cast<GDALDataset*>(GDALOpen(path.c_str(), GA_ReadOnly)),
+        [](GDALDataset* d) { if (d) GDALClose(d); });
+    if (!dataset) {
+        std::cout << "Tiled raster: GDAL failed to open " << path << std::endl;
+        return nullptr;
+    }
+
+    double gt[6];
+    GDALRasterBand* band = dataset->GetRasterBand(1);
+    if (band == nullptr || dataset->GetGeoTransform(gt) != CE_None) {
+        std::cout << "Tiled raster: " << path << " has no elevation band or geotransform" << std::endl;
+        return nullptr;
+    }
+    if (gt[2] != 0.0 || gt[4] != 0.0 || gt[1] <= 0.0 || gt[5] >= 0.0) {
+        std::cout << "Tiled raster: " << path << " is not a north-up raster" << std::endl;
+        return nullptr;
+    }
+
+    std::string unit = band->GetUnitType() ? band->GetUnitType() : "";
+    std::transform(unit.begin(), unit.end(), unit.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    const float toFeet = (unit == "ft" || unit == "foot" || unit == "feet")
+        ? 1.0f : static_cast<float>(METERS_TO_FEET);
+    int hasNoData = 0;
+    const double noData = band->GetNoDataValue(&hasNoData);
+
+    // Full resolution first, then the overviews; each has its own block size
+    std::vector<GDALRasterBand*> bands = {band};
+    for (int i = 0; i < band->GetOverviewCount(); ++i) {
+        if (GDALRasterBand* overview = band->GetOverview(i)) {
+            bands.push_back(overview);
+        }
+    }
+
+    std::vector<RasterLevel> levels;
+    for (GDALRasterBand* levelBand : bands) {
+        RasterLevel level;
+        level.width = levelBand->GetXSize();
+        level.height = levelBand->GetYSize();
+        levelBand->GetBlockSize(&level.blockWidth, &level.blockHeight);
+        level.originLongitude = gt[0];
+        level.originLatitude = gt[3];
+        level.pixelWidth = gt[1] * band->GetXSize() / level.width;
+        level.pixelHeight = gt[5] * band->GetYSize() / level.height;
+        levels.push_back(level);
+    }
+
+    // A GDAL dataset is not thread-safe: one read at a time
+    auto ioMutex = std::make_shared<std::mutex>();
+    BlockReader reader = [dataset, bands, levels, ioMutex, toFeet, hasNoData, noData](
+                             size_t level, int blockX, int blockY, float* out) {
+        GDALRasterBand* levelBand = bands[level];
+        const size_t pixels = static_cast<size_t>(levels[level].blockWidth) * levels[level].blockHeight;
+        const GDALDataType type = levelBand->GetRasterDataType();
+        std::vector<unsigned char> raw(pixels * GDALGetDataTypeSizeBytes(type));
+        {
+            std::lock_guard<std::mutex> lock(*ioMutex);
+            if (levelBand->ReadBlock(blockX, blockY, raw.data()) != CE_None) {
+                return false;
+            }
+        }
+        std::vector<double> values(pixels);
+        GDALCopyWords(raw.data(), type, GDALGetDataTypeSizeBytes(type),
+                      values.data(), GDT_Float64, sizeof(double), static_cast<int>(pixels));
+        for (size_t i = 0; i < pixels; ++i) {
+            out[i] = (hasNoData && values[i] == noData)
+                ? NO_DATA : static_cast<float>(values[i]) * toFeet;
+        }
+        return true;
+    };
+
+    std::cout << "Tiled raster: " << path << " (" << levels[0].width << "x" << levels[0].height
+              << ", " << levels.size() - 1 << " overviews, " << levels[0].blockWidth << "x"
+              << levels[0].blockHeight << " blocks)" << std::endl;
+    return std::make_shared<TiledRasterSource>(std::move(levels), std::move(reader), byteBudget);
+}
+
+#else
+
+std::shared_ptr<TiledRasterSource> TiledRasterSource::openGdal(const std::string& path, size_t) {
+    std::cout << "Tiled raster: " << path << " needs a build with ENABLE_GDAL" << std::endl;
+    return nullptr;
+}
+
+#endif // ENABLE_GDAL
+
+} // namespace AICopilot
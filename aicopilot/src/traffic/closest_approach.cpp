@@ -0,0 +1,50 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project - Closest Approach Kernel Dispatch
+*****************************************************************************/
+
+#include "closest_approach.hpp"
+#include "cpu_features.hpp"
+
+namespace AICopilot {
+namespace ClosestApproach {
+
+#ifdef AICOPILOT_ENABLE_AVX2
+// closest_approach_avx2.cpp, compiled for AVX2
+void computeBatchAvx2(size_t count, const double* north, const double* east, const double* up,
+                      const double* vn, const double* ve, const double* vz,
+                      double* time, double* distance, double* verticalSeparation, double* tau);
+
+void computeBatchAvx2(const Tracks& tracks, double* time, double* distance,
+                      double* verticalSeparation, double* tau) {
+    computeBatchAvx2(tracks.size(), tracks.north.data(), tracks.east.data(), tracks.up.data(),
+                     tracks.vn.data(), tracks.ve.data(), tracks.vz.data(),
+                     time, distance, verticalSeparation, tau);
+}
+#endif
+
+namespace {
+
+using BatchKernel = void (*)(const Tracks&, double*, double*, double*, double*);
+
+BatchKernel selectKernel() {
+#ifdef AICOPILOT_ENABLE_AVX2
+    if (CpuFeatures::hasAvx2()) return computeBatchAvx2;
+#endif
+    return computeBatchScalar;
+}
+
+const BatchKernel g_batchKernel = selectKernel();
+
+} // namespace
+
+void computeBatch(const Tracks& tracks, double* time, double* distance,
+                  double* verticalSeparation, double* tau) {
+    g_batchKernel(tracks, time, distance, verticalSeparation, tau);
+}
+
+const char* batchKernel() {
+    return g_batchKernel == computeBatchScalar ? "scalar" : "avx2";
+}
+
+} // namespace ClosestApproach
+} // namespace AICopilot
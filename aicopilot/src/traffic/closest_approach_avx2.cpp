@@ -0,0 +1,95 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project - Closest Approach AVX2 Kernel
+*
+* Built only with ENABLE_AVX2, and with AVX2 code generation for this file
+* alone. Reached through computeBatch() once the CPU is known to have AVX2.
+* No FMA: every operation rounds like the scalar kernel.
+*
+* Calls no inline or template code from headers: an out-of-line copy
+* compiled here would carry AVX2 instructions, and the linker may keep it
+* for callers on any CPU.
+*****************************************************************************/
+
+#include "closest_approach.hpp"
+#include <cmath>
+#include <immintrin.h>
+
+namespace AICopilot {
+namespace ClosestApproach {
+
+namespace {
+
+struct Lanes {
+    __m256d time, distance, vertical, tau;
+};
+
+inline Lanes computeLanes(__m256d n, __m256d e, __m256d u, __m256d vN, __m256d vE, __m256d vZ) {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d signBit = _mm256_set1_pd(-0.0);
+    const __m256d secondsPerHour = _mm256_set1_pd(SECONDS_PER_HOUR);
+
+    __m256d speedSq = _mm256_add_pd(_mm256_mul_pd(vN, vN), _mm256_mul_pd(vE, vE));
+    __m256d rangeRate = _mm256_add_pd(_mm256_mul_pd(n, vN), _mm256_mul_pd(e, vE));
+
+    // max(-rangeRate / speedSq, 0), or 0 with no relative motion
+    __m256d hours = _mm256_max_pd(zero, _mm256_div_pd(_mm256_xor_pd(rangeRate, signBit), speedSq));
+    hours = _mm256_and_pd(hours, _mm256_cmp_pd(speedSq, _mm256_set1_pd(MIN_RELATIVE_SPEED_SQ), _CMP_GT_OQ));
+
+    __m256d missN = _mm256_add_pd(n, _mm256_mul_pd(vN, hours));
+    __m256d missE = _mm256_add_pd(e, _mm256_mul_pd(vE, hours));
+    __m256d rangeSq = _mm256_add_pd(_mm256_mul_pd(n, n), _mm256_mul_pd(e, e));
+    __m256d closingTau = _mm256_mul_pd(_mm256_div_pd(_mm256_xor_pd(rangeSq, signBit), rangeRate), secondsPerHour);
+
+    Lanes lanes;
+    lanes.time = _mm256_mul_pd(hours, secondsPerHour);
+    lanes.distance = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(missN, missN), _mm256_mul_pd(missE, missE)));
+    lanes.vertical = _mm256_add_pd(u, _mm256_mul_pd(_mm256_mul_pd(vZ, hours), _mm256_set1_pd(60.0)));
+    lanes.tau = _mm256_blendv_pd(_mm256_set1_pd(HUGE_VAL), closingTau, _mm256_cmp_pd(rangeRate, zero, _CMP_LT_OQ));
+    return lanes;
+}
+
+} // namespace
+
+void computeBatchAvx2(size_t count, const double* north, const double* east, const double* up,
+                      const double* vn, const double* ve, const double* vz,
+                      double* time, double* distance, double* verticalSeparation, double* tau) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        Lanes lanes = computeLanes(_mm256_loadu_pd(north + i), _mm256_loadu_pd(east + i),
+                                   _mm256_loadu_pd(up + i), _mm256_loadu_pd(vn + i),
+                                   _mm256_loadu_pd(ve + i), _mm256_loadu_pd(vz + i));
+        _mm256_storeu_pd(time + i, lanes.time);
+        _mm256_storeu_pd(distance + i, lanes.distance);
+        _mm256_storeu_pd(verticalSeparation + i, lanes.vertical);
+        _mm256_storeu_pd(tau + i, lanes.tau);
+    }
+
+    // Last one to three rows through zero-padded lanes
+    size_t tail = count - i;
+    if (tail == 0) return;
+    alignas(32) double in[6][4] = {};
+    for (size_t k = 0; k < tail; ++k) {
+        in[0][k] = north[i + k];
+        in[1][k] = east[i + k];
+        in[2][k] = up[i + k];
+        in[3][k] = vn[i + k];
+        in[4][k] = ve[i + k];
+        in[5][k] = vz[i + k];
+    }
+    Lanes lanes = computeLanes(_mm256_load_pd(in[0]), _mm256_load_pd(in[1]), _mm256_load_pd(in[2]),
+                               _mm256_load_pd(in[3]), _mm256_load_pd(in[4]), _mm256_load_pd(in[5]));
+    alignas(32) double out[4][4];
+    _mm256_store_pd(out[0], lanes.time);
+    _mm256_store_pd(out[1], lanes.distance);
+    _mm256_store_pd(out[2], lanes.vertical);
+    _mm256_store_pd(out[3], lanes.tau);
+    for (size_t k = 0; k < tail; ++k) {
+        time[i + k] = out[0][k];
+        distance[i + k] = out[1][k];
+        verticalSeparation[i + k] = out[2][k];
+        tau[i + k] = out[3][k];
+    }
+}
+
+} // namespace ClosestApproach
+} // namespace AICopilot
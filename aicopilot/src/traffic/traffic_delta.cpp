@@ -0,0 +1,321 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Traffic Delta Implementation
+* Varint delta frames of traffic tables for cross-node TCAS
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "traffic_delta.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AICopilot {
+
+namespace {
+
+using F = TrafficDeltaFormat;
+
+constexpr int32_t HEADING_UNITS = 36000;
+constexpr size_t MAX_CALLSIGN_BYTES = 64;
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void putSigned(std::vector<uint8_t>& out, int64_t value) {
+    putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p == end) return false;
+        uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+bool getSigned(const uint8_t*& p, const uint8_t* end, int64_t& value) {
+    uint64_t raw = 0;
+    if (!getVarint(p, end, raw)) return false;
+    value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+    return true;
+}
+
+int32_t quantize(double value, double unit) {
+    return static_cast<int32_t>(std::llround(value / unit));
+}
+
+int32_t quantizeHeading(double heading) {
+    int32_t units = quantize(heading, F::HEADING_DEGREES_PER_UNIT) % HEADING_UNITS;
+    return units < 0 ? units + HEADING_UNITS : units;
+}
+
+// Shortest way round, so 359.99 -> 0.01 costs one byte
+int32_t headingDelta(int32_t to, int32_t from) {
+    int32_t delta = (to - from) % HEADING_UNITS;
+    if (delta >= HEADING_UNITS / 2) delta -= HEADING_UNITS;
+    if (delta < -HEADING_UNITS / 2) delta += HEADING_UNITS;
+    return delta;
+}
+
+void quantizeRow(const TrafficTable& table, size_t row, TrafficDeltaRecord& record) {
+    record.objectId = table.objectIds()[row];
+    record.latitude = quantize(table.latitudes()[row], F::DEGREES_PER_UNIT);
+    record.longitude = quantize(table.longitudes()[row], F::DEGREES_PER_UNIT);
+    record.altitude = quantize(table.altitudes()[row], F::FEET_PER_UNIT);
+    record.groundSpeed = quantize(table.groundSpeeds()[row], F::KNOTS_PER_UNIT);
+    record.heading = quantizeHeading(table.headings()[row]);
+    record.verticalSpeed = quantize(table.verticalSpeeds()[row], F::FPM_PER_UNIT);
+    record.onGround = table.onGround()[row] != 0;
+    const std::string& callsign = table.callsigns()[row];
+    record.callsign.assign(callsign, 0, std::min(callsign.size(), MAX_CALLSIGN_BYTES));
+}
+
+// Fields that differ from base; the on-ground bit carries the value
+uint8_t changedFields(const TrafficDeltaRecord& next, const TrafficDeltaRecord& base) {
+    uint8_t mask = 0;
+    if (next.latitude != base.latitude) mask |= F::LATITUDE;
+    if (next.longitude != base.longitude) mask |= F::LONGITUDE;
+    if (next.altitude != base.altitude) mask |= F::ALTITUDE;
+    if (next.groundSpeed != base.groundSpeed) mask |= F::GROUND_SPEED;
+    if (next.heading != base.heading) mask |= F::HEADING;
+    if (next.verticalSpeed != base.verticalSpeed) mask |= F::VERTICAL_SPEED;
+    if (next.callsign != base.callsign) mask |= F::CALLSIGN;
+    return mask;
+}
+
+const TrafficDeltaRecord EMPTY_RECORD{};
+
+// Baseline row for id at or after cursor, else EMPTY_RECORD (a new row)
+const TrafficDeltaRecord& findBase(const std::vector<TrafficDeltaRecord>& baseline, size_t& cursor, uint32_t id) {
+    while (cursor < baseline.size() && baseline[cursor].objectId < id) cursor++;
+    if (cursor < baseline.size() && baseline[cursor].objectId == id) return baseline[cursor];
+    return EMPTY_RECORD;
+}
+
+TrafficTable::Sample toSample(const TrafficDeltaRecord& record) {
+    TrafficTable::Sample sample;
+    sample.callsign = record.callsign.c_str();
+    sample.latitude = record.latitude * F::DEGREES_PER_UNIT;
+    sample.longitude = record.longitude * F::DEGREES_PER_UNIT;
+    sample.altitude = record.altitude * F::FEET_PER_UNIT;
+    sample.groundSpeed = record.groundSpeed * F::KNOTS_PER_UNIT;
+    sample.heading = record.heading * F::HEADING_DEGREES_PER_UNIT;
+    sample.verticalSpeed = record.verticalSpeed * F::FPM_PER_UNIT;
+    sample.onGround = record.onGround;
+    return sample;
+}
+
+} // namespace
+
+// ============================================================================
+// TrafficDeltaEncoder Implementation
+// ============================================================================
+
+size_t TrafficDeltaEncoder::encode(const TrafficTable& table, std::vector<uint8_t>& out) {
+    const size_t start = out.size();
+    sequence_++;
+    bool keyframe = keyframePending_ || (keyframeInterval_ > 0 && sequence_ % keyframeInterval_ == 0);
+    keyframePending_ = false;
+
+    const auto& ids = table.objectIds();
+    order_.resize(table.size());
+    for (size_t row = 0; row < order_.size(); row++) order_[row] = row;
+    std::sort(order_.begin(), order_.end(), [&ids](size_t a, size_t b) { return ids[a] < ids[b]; });
+
+    next_.resize(order_.size());
+    for (size_t i = 0; i < order_.size(); i++) quantizeRow(table, order_[i], next_[i]);
+
+    // Count first: the frame carries the counts ahead of the records
+    size_t updates = 0;
+    size_t cursor = 0;
+    for (const auto& record : next_) {
+        const TrafficDeltaRecord& base = keyframe ? EMPTY_RECORD : findBase(baseline_, cursor, record.objectId);
+        bool known = &base != &EMPTY_RECORD;
+        if (keyframe || !known || changedFields(record, base) != 0 || record.onGround != base.onGround) updates++;
+    }
+
+    out.push_back(F::VERSION);
+    out.push_back(keyframe ? F::KEYFRAME : 0);
+    putVarint(out, sequence_);
+    putVarint(out, updates);
+
+    uint32_t previousId = 0;
+    cursor = 0;
+    for (const auto& record : next_) {
+        const TrafficDeltaRecord& base = keyframe ? EMPTY_RECORD : findBase(baseline_, cursor, record.objectId);
+        bool known = &base != &EMPTY_RECORD;
+        uint8_t mask = changedFields(record, base);
+        if (!keyframe && known && mask == 0 && record.onGround == base.onGround) continue;
+        if (record.onGround) mask |= F::ON_GROUND;
+
+        putVarint(out, record.objectId - previousId);
+        previousId = record.objectId;
+        out.push_back(mask);
+        if (mask & F::LATITUDE) putSigned(out, int64_t(record.latitude) - base.latitude);
+        if (mask & F::LONGITUDE) putSigned(out, int64_t(record.longitude) - base.longitude);
+        if (mask & F::ALTITUDE) putSigned(out, int64_t(record.altitude) - base.altitude);
+        if (mask & F::GROUND_SPEED) putSigned(out, int64_t(record.groundSpeed) - base.groundSpeed);
+        if (mask & F::HEADING) putSigned(out, headingDelta(record.heading, base.heading));
+        if (mask & F::VERTICAL_SPEED) putSigned(out, int64_t(record.verticalSpeed) - base.verticalSpeed);
+        if (mask & F::CALLSIGN) {
+            putVarint(out, record.callsign.size());
+            out.insert(out.end(), record.callsign.begin(), record.callsign.end());
+        }
+    }
+
+    // A keyframe replaces the peer's rows outright, so removals are implied
+    size_t removals = 0;
+    previousId = 0;
+    if (!keyframe) {
+        size_t n = 0;
+        for (const auto& old : baseline_) {
+            while (n < next_.size() && next_[n].objectId < old.objectId) n++;
+            if (n < next_.size() && next_[n].objectId == old.objectId) continue;
+            removals++;
+        }
+    }
+    putVarint(out, removals);
+    if (removals > 0) {
+        size_t n = 0;
+        for (const auto& old : baseline_) {
+            while (n < next_.size() && next_[n].objectId < old.objectId) n++;
+            if (n < next_.size() && next_[n].objectId == old.objectId) continue;
+            putVarint(out, old.objectId - previousId);
+            previousId = old.objectId;
+        }
+    }
+
+    baseline_.swap(next_);
+    return out.size() - start;
+}
+
+// ============================================================================
+// TrafficDeltaDecoder Implementation
+// ============================================================================
+
+TrafficDeltaStatus TrafficDeltaDecoder::apply(const uint8_t* data, size_t size, TrafficTable& table) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    if (size < 2 || p[0] != F::VERSION) return TrafficDeltaStatus::CORRUPT;
+    bool keyframe = (p[1] & F::KEYFRAME) != 0;
+    p += 2;
+
+    uint64_t sequence = 0;
+    uint64_t updates = 0;
+    if (!getVarint(p, end, sequence) || !getVarint(p, end, updates)) return TrafficDeltaStatus::CORRUPT;
+    if (updates > size) return TrafficDeltaStatus::CORRUPT;   // at least two bytes each
+
+    if (!keyframe && (needKeyframe_ || sequence != sequence_ + 1)) {
+        droppedFrames_++;
+        needKeyframe_ = true;
+        return TrafficDeltaStatus::NEED_KEYFRAME;
+    }
+
+    // Decode everything before touching the table
+    next_.resize(updates);
+    uint64_t id = 0;
+    size_t cursor = 0;
+    for (size_t i = 0; i < updates; i++) {
+        uint64_t idDelta = 0;
+        if (!getVarint(p, end, idDelta) || p == end) return TrafficDeltaStatus::CORRUPT;
+        id += idDelta;
+        if (id > UINT32_MAX || (i > 0 && idDelta == 0)) return TrafficDeltaStatus::CORRUPT;
+        uint8_t mask = *p++;
+
+        TrafficDeltaRecord& record = next_[i];
+        const TrafficDeltaRecord& base = keyframe ? EMPTY_RECORD
+                                                  : findBase(baseline_, cursor, static_cast<uint32_t>(id));
+        int32_t* fields[] = {&record.latitude, &record.longitude, &record.altitude,
+                             &record.groundSpeed, &record.heading, &record.verticalSpeed};
+        const int32_t baseFields[] = {base.latitude, base.longitude, base.altitude,
+                                      base.groundSpeed, base.heading, base.verticalSpeed};
+        for (int field = 0; field < 6; field++) {
+            int64_t delta = 0;
+            if ((mask & (1u << field)) && !getSigned(p, end, delta)) return TrafficDeltaStatus::CORRUPT;
+            *fields[field] = static_cast<int32_t>(baseFields[field] + delta);
+        }
+        record.heading %= HEADING_UNITS;
+        if (record.heading < 0) record.heading += HEADING_UNITS;
+        record.objectId = static_cast<uint32_t>(id);
+        record.onGround = (mask & F::ON_GROUND) != 0;
+
+        if (mask & F::CALLSIGN) {
+            uint64_t length = 0;
+            if (!getVarint(p, end, length) || length > MAX_CALLSIGN_BYTES ||
+                length > static_cast<uint64_t>(end - p)) {
+                return TrafficDeltaStatus::CORRUPT;
+            }
+            record.callsign.assign(reinterpret_cast<const char*>(p), static_cast<size_t>(length));
+            p += length;
+        } else {
+            record.callsign = base.callsign;
+        }
+    }
+
+    uint64_t removals = 0;
+    if (!getVarint(p, end, removals) || removals > size) return TrafficDeltaStatus::CORRUPT;
+    removed_.clear();
+    id = 0;
+    for (size_t i = 0; i < removals; i++) {
+        uint64_t idDelta = 0;
+        if (!getVarint(p, end, idDelta)) return TrafficDeltaStatus::CORRUPT;
+        id += idDelta;
+        if (id > UINT32_MAX || (i > 0 && idDelta == 0)) return TrafficDeltaStatus::CORRUPT;
+        removed_.push_back(static_cast<uint32_t>(id));
+    }
+    if (p != end) return TrafficDeltaStatus::CORRUPT;
+
+    // A keyframe drops every row it does not list
+    if (keyframe) {
+        size_t n = 0;
+        for (const auto& old : baseline_) {
+            while (n < next_.size() && next_[n].objectId < old.objectId) n++;
+            if (n < next_.size() && next_[n].objectId == old.objectId) continue;
+            removed_.push_back(old.objectId);
+        }
+    }
+
+    for (uint32_t objectId : removed_) table.remove(objectId);
+    for (const auto& record : next_) table.upsert(record.objectId, toSample(record));
+
+    // New baseline: old rows, minus removals, with the updates merged in
+    if (keyframe) {
+        baseline_.swap(next_);
+    } else {
+        std::vector<TrafficDeltaRecord>& merged = merged_;
+        merged.clear();
+        size_t u = 0;
+        size_t r = 0;
+        for (auto& old : baseline_) {
+            while (u < next_.size() && next_[u].objectId < old.objectId) merged.push_back(std::move(next_[u++]));
+            if (u < next_.size() && next_[u].objectId == old.objectId) {
+                merged.push_back(std::move(next_[u++]));
+                continue;
+            }
+            while (r < removed_.size() && removed_[r] < old.objectId) r++;
+            if (r < removed_.size() && removed_[r] == old.objectId) continue;
+            merged.push_back(std::move(old));
+        }
+        while (u < next_.size()) merged.push_back(std::move(next_[u++]));
+        baseline_.swap(merged);
+    }
+
+    sequence_ = sequence;
+    needKeyframe_ = false;
+    return TrafficDeltaStatus::APPLIED;
+}
+
+} // namespace AICopilot
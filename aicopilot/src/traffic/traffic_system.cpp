@@ -3,69 +3,377 @@
 *****************************************************************************/
 
 #include "traffic_system.h"
+#include "hot_path_trace.hpp"
 #include <cmath>
 #include <algorithm>
 #include <limits>
 
 namespace AICopilot {
 
+namespace {
+
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+constexpr double RAD_TO_DEG = 180.0 / 3.14159265358979323846;
+constexpr double NM_PER_DEG_LAT = 60.0;
+
+// Target-minus-own state in the local north/east/up frame
+struct RelativeTrack {
+    double north, east, up;   // nm, nm, feet
+    double vn, ve, vz;        // knots, knots, feet per minute
+};
+
+RelativeTrack relativeTrack(const AircraftState& own, const TrafficTarget& target) {
+    double bearing = target.bearing * DEG_TO_RAD;
+    double heading = target.heading * DEG_TO_RAD;
+    double ownHeading = own.heading * DEG_TO_RAD;
+    return {
+        target.range * std::cos(bearing),
+        target.range * std::sin(bearing),
+        target.relativeAltitude,
+        target.groundSpeed * std::cos(heading) - own.groundSpeed * std::cos(ownHeading),
+        target.groundSpeed * std::sin(heading) - own.groundSpeed * std::sin(ownHeading),
+        target.verticalSpeed - own.verticalSpeed};
+}
+
+double wrapLongitude(double dLon) {
+    if (dLon > 180.0) dLon -= 360.0;
+    if (dLon < -180.0) dLon += 360.0;
+    return dLon;
+}
+
+// Local flat-earth frame around own ship (accurate well beyond TCAS range)
+struct OwnFrame {
+    double lat, lon, alt;
+    double nmPerDegLon;
+    double vn, ve, vz;
+    
+    explicit OwnFrame(const AircraftState& own)
+        : lat(own.position.latitude), lon(own.position.longitude), alt(own.position.altitude),
+          nmPerDegLon(NM_PER_DEG_LAT * std::cos(own.position.latitude * DEG_TO_RAD)),
+          vn(own.groundSpeed * std::cos(own.heading * DEG_TO_RAD)),
+          ve(own.groundSpeed * std::sin(own.heading * DEG_TO_RAD)),
+          vz(own.verticalSpeed) {}
+};
+
+// Derive a target and its relative track row from one report
+void fillTarget(const OwnFrame& own, TrafficTarget& target, ClosestApproach::Tracks& tracks, size_t row,
+                const std::string& callsign, double latitude, double longitude, double altitude,
+                double groundSpeed, double headingDeg, double verticalSpeed, double turnRate) {
+    double north = (latitude - own.lat) * NM_PER_DEG_LAT;
+    double east = wrapLongitude(longitude - own.lon) * own.nmPerDegLon;
+    double range = std::sqrt(north * north + east * east);
+    
+    double heading = headingDeg * DEG_TO_RAD;
+    double relVn = groundSpeed * std::cos(heading) - own.vn;
+    double relVe = groundSpeed * std::sin(heading) - own.ve;
+    
+    target.callsign = callsign;
+    target.position.latitude = latitude;
+    target.position.longitude = longitude;
+    target.position.altitude = altitude;
+    target.position.heading = headingDeg;
+    target.altitude = altitude;
+    target.groundSpeed = groundSpeed;
+    target.heading = headingDeg;
+    target.verticalSpeed = verticalSpeed;
+    target.relativeAltitude = altitude - own.alt;
+    target.range = range;
+    target.bearing = std::fmod(std::atan2(east, north) * RAD_TO_DEG + 360.0, 360.0);
+    // Positive when closing: negative rate of change of range
+    target.closureRate = (range > 0.0) ? -(north * relVn + east * relVe) / range : 0.0;
+    target.turnRate = turnRate;
+    
+    tracks.north[row] = north;
+    tracks.east[row] = east;
+    tracks.up[row] = target.relativeAltitude;
+    tracks.vn[row] = relVn;
+    tracks.ve[row] = relVe;
+    tracks.vz[row] = verticalSpeed - own.vz;
+}
+
+} // namespace
+
 void TrafficSystem::updateOwnAircraft(const AircraftState& state) {
     ownAircraft_ = state;
+    ownVersion_ = 0;
+}
+
+bool TrafficSystem::updateOwnAircraft(const AircraftStateCore& core, uint64_t version) {
+    if (version != 0 && version == ownVersion_) {
+        return false;
+    }
+    core.applyTo(ownAircraft_);
+    ownVersion_ = version;
+    return true;
 }
 
 void TrafficSystem::updateTrafficTargets(const std::vector<TrafficTarget>& targets) {
-    trafficTargets_ = targets;
+    Frame& frame = back();
+    if (&frame.targets != &targets) {
+        frame.targets.assign(targets.begin(), targets.end());
+    }
+    
+    frame.tracks.resize(targets.size());
+    for (size_t i = 0; i < targets.size(); ++i) {
+        RelativeTrack track = relativeTrack(ownAircraft_, targets[i]);
+        frame.tracks.north[i] = track.north;
+        frame.tracks.east[i] = track.east;
+        frame.tracks.up[i] = track.up;
+        frame.tracks.vn[i] = track.vn;
+        frame.tracks.ve[i] = track.ve;
+        frame.tracks.vz[i] = track.vz;
+    }
     
-    // Update active advisories
-    activeAdvisories_.clear();
-    auto conflicts = checkTrafficConflicts();
-    activeAdvisories_ = conflicts;
+    publish(frame);
 }
 
-TrafficTarget TrafficSystem::getNearestTraffic() const {
-    TrafficTarget nearest;
-    double minRange = std::numeric_limits<double>::max();
+void TrafficSystem::updateTrafficTargets(const TrafficTable& table) {
+    const size_t count = table.size();
+    Frame& frame = back();
+    frame.targets.resize(count);
+    frame.tracks.resize(count);
     
-    for (const auto& target : trafficTargets_) {
-        if (target.range < minRange) {
-            minRange = target.range;
-            nearest = target;
+    const OwnFrame own(ownAircraft_);
+    const auto& callsigns = table.callsigns();
+    const auto& latitudes = table.latitudes();
+    const auto& longitudes = table.longitudes();
+    const auto& altitudes = table.altitudes();
+    const auto& groundSpeeds = table.groundSpeeds();
+    const auto& headings = table.headings();
+    const auto& verticalSpeeds = table.verticalSpeeds();
+    
+    for (size_t i = 0; i < count; ++i) {
+        fillTarget(own, frame.targets[i], frame.tracks, i, callsigns[i], latitudes[i], longitudes[i],
+                   altitudes[i], groundSpeeds[i], headings[i], verticalSpeeds[i], 0.0);
+    }
+    
+    publish(frame);
+}
+
+void TrafficSystem::updateTrafficTargets(const TrafficTable& table, double timeSeconds) {
+    const size_t count = table.size();
+    Frame& frame = back();
+    frame.targets.resize(count);
+    frame.tracks.resize(count);
+    filterSweep_++;
+    
+    const OwnFrame own(ownAircraft_);
+    const auto& callsigns = table.callsigns();
+    const auto& latitudes = table.latitudes();
+    const auto& longitudes = table.longitudes();
+    const auto& altitudes = table.altitudes();
+    const auto& groundSpeeds = table.groundSpeeds();
+    const auto& headings = table.headings();
+    const auto& verticalSpeeds = table.verticalSpeeds();
+    
+    for (size_t i = 0; i < count; ++i) {
+        TargetFilter& filter = filters_[callsigns[i]];
+        if (filter.tracker.empty()) {
+            filter.originLat = latitudes[i];
+            filter.originLon = longitudes[i];
+        }
+        filter.sweep = filterSweep_;
+        
+        // Each filter works in its own flat frame, anchored at its first report
+        const double nmPerDegLon = NM_PER_DEG_LAT * std::cos(filter.originLat * DEG_TO_RAD);
+        double heading = headings[i] * DEG_TO_RAD;
+        const TrackSample& smoothed = filter.tracker.update(
+            timeSeconds,
+            (latitudes[i] - filter.originLat) * NM_PER_DEG_LAT,
+            wrapLongitude(longitudes[i] - filter.originLon) * nmPerDegLon,
+            altitudes[i],
+            groundSpeeds[i] * std::cos(heading),
+            groundSpeeds[i] * std::sin(heading),
+            verticalSpeeds[i]);
+        
+        double groundSpeed = std::sqrt(smoothed.vn * smoothed.vn + smoothed.ve * smoothed.ve);
+        double track = groundSpeed > 0.0
+            ? std::fmod(std::atan2(smoothed.ve, smoothed.vn) * RAD_TO_DEG + 360.0, 360.0)
+            : headings[i];
+        fillTarget(own, frame.targets[i], frame.tracks, i, callsigns[i],
+                   filter.originLat + smoothed.north / NM_PER_DEG_LAT,
+                   filter.originLon + (nmPerDegLon > 0.0 ? smoothed.east / nmPerDegLon : 0.0),
+                   smoothed.up, groundSpeed, track, smoothed.vz, filter.tracker.turnRate());
+    }
+    
+    // Targets that left the table take their filters with them
+    for (auto it = filters_.begin(); it != filters_.end();) {
+        if (it->second.sweep != filterSweep_) {
+            it = filters_.erase(it);
+        } else {
+            ++it;
         }
     }
     
-    return nearest;
+    publish(frame);
 }
 
-std::vector<TrafficAdvisory> TrafficSystem::checkTrafficConflicts() const {
-    std::vector<TrafficAdvisory> advisories;
+const AlphaBetaTracker* TrafficSystem::getTrackFilter(const std::string& callsign) const {
+    auto it = filters_.find(callsign);
+    return it != filters_.end() ? &it->second.tracker : nullptr;
+}
+
+template <typename Advisories>
+void TrafficSystem::collectTrafficConflicts(const Frame& frame, Advisories& advisories,
+                                            bool hysteresis) const {
+    advisories.clear();
     
-    for (const auto& target : trafficTargets_) {
-        if (!isThreat(target)) continue;
+    // One RA sense covers every RA threat: the worst vertical separation at
+    // CPA under each sense is tracked, and a latched sense is kept while the
+    // RA threats are unchanged
+    const RADirection* latchedSense = nullptr;
+    bool newRAThreat = false;
+    double climbSeparation = std::numeric_limits<double>::infinity();
+    double descendSeparation = std::numeric_limits<double>::infinity();
+    
+    // Closest-approach columns are row-aligned with the targets
+    for (size_t i = 0; i < frame.targets.size(); ++i) {
+        const TrafficTarget& target = frame.targets[i];
+        
+        // Determine advisory type based on range
+        TrafficAdvisoryType type = TrafficAdvisoryType::NONE;
+        if (isThreat(target)) {
+            if (target.range < RA_RANGE && std::abs(target.relativeAltitude) < VERTICAL_SEPARATION) {
+                type = TrafficAdvisoryType::RA;
+            } else if (target.range < TA_RANGE) {
+                type = TrafficAdvisoryType::TA;
+            }
+        }
+        
+        // An advisory raised last update holds until the target is clearly
+        // outside its entry limits; an RA keeps its sense
+        const LatchedAdvisory* latched = nullptr;
+        if (hysteresis) {
+            auto it = latched_.find(target.callsign);
+            if (it != latched_.end()) latched = &it->second;
+        }
+        if (latched) {
+            bool closingOrSlowlyOpening = target.closureRate > -CLOSURE_EXIT_RATE;
+            if (latched->type == TrafficAdvisoryType::RA && type != TrafficAdvisoryType::RA &&
+                closingOrSlowlyOpening && target.range < RA_EXIT_RANGE &&
+                std::abs(target.relativeAltitude) < VERTICAL_EXIT_SEPARATION) {
+                type = TrafficAdvisoryType::RA;
+            }
+            if (type == TrafficAdvisoryType::NONE && closingOrSlowlyOpening && target.range < TA_EXIT_RANGE) {
+                type = TrafficAdvisoryType::TA;
+            }
+        }
+        if (type == TrafficAdvisoryType::NONE) continue;
         
         TrafficAdvisory advisory;
+        advisory.type = type;
+        advisory.raDirection = RADirection::NONE;
         advisory.target = target;
         advisory.conflictType = determineConflictType(target);
+        advisory.timeToClosestApproach = frame.cpaTime[i];
+        advisory.minSeparation = frame.cpaDistance[i];
         
-        // Determine advisory type based on range
-        if (target.range < RA_RANGE && std::abs(target.relativeAltitude) < VERTICAL_SEPARATION) {
-            advisory.type = TrafficAdvisoryType::RA;
-            advisory.raDirection = determineRADirection(target);
+        if (type == TrafficAdvisoryType::RA) {
+            if (latched && latched->type == TrafficAdvisoryType::RA) {
+                latchedSense = &latched->raDirection;
+            } else {
+                newRAThreat = true;
+            }
+            // Target-minus-own vertical separation at CPA with own ship
+            // climbing or descending at the RA rate until then
+            double ownDisplacement = RA_VERTICAL_SPEED / 60.0 * frame.cpaTime[i];
+            climbSeparation = std::min(climbSeparation, std::abs(frame.cpaVertical[i] - ownDisplacement));
+            descendSeparation = std::min(descendSeparation, std::abs(frame.cpaVertical[i] + ownDisplacement));
             advisory.message = "TRAFFIC, CLIMB/DESCEND";
-        } else if (target.range < TA_RANGE) {
-            advisory.type = TrafficAdvisoryType::TA;
+        } else {
             advisory.message = "TRAFFIC ADVISORY";
         }
-        
-        if (advisory.type != TrafficAdvisoryType::NONE) {
-            advisories.push_back(advisory);
+        advisories.push_back(advisory);
+    }
+    
+    if (!latchedSense && !newRAThreat) return;
+    RADirection sense = determineRADirection(climbSeparation, descendSeparation,
+                                             latchedSense ? *latchedSense : RADirection::NONE, newRAThreat);
+    for (auto& advisory : advisories) {
+        if (advisory.type == TrafficAdvisoryType::RA) advisory.raDirection = sense;
+    }
+}
+
+void TrafficSystem::publish(Frame& frame) {
+    const size_t count = frame.tracks.size();
+    frame.cpaTime.resize(count);
+    frame.cpaDistance.resize(count);
+    frame.cpaVertical.resize(count);
+    frame.tau.resize(count);
+    ClosestApproach::computeBatch(frame.tracks, frame.cpaTime.data(), frame.cpaDistance.data(),
+                                  frame.cpaVertical.data(), frame.tau.data());
+    collectTrafficConflicts(frame, frame.advisories, true);
+    
+    // Latch this frame's advisories for the next update; cleared ones drop out
+    frame.generation = front().generation + 1;
+    for (const auto& advisory : frame.advisories) {
+        latched_[advisory.target.callsign] = {advisory.type, advisory.raDirection, frame.generation};
+    }
+    for (auto it = latched_.begin(); it != latched_.end();) {
+        if (it->second.generation != frame.generation) {
+            it = latched_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    
+    front_ ^= 1;
+}
+
+ClosestApproach::Result TrafficSystem::closestApproach(const TrafficTarget& target) const {
+    RelativeTrack track = relativeTrack(ownAircraft_, target);
+    return ClosestApproach::compute(track.north, track.east, track.up, track.vn, track.ve, track.vz);
+}
+
+double TrafficSystem::calculateSeparation(const TrafficTarget& target) const {
+    return closestApproach(target).distance;
+}
+
+double TrafficSystem::calculateTimeToClosestApproach(const TrafficTarget& target) const {
+    return closestApproach(target).time;
+}
+
+TrafficTarget TrafficSystem::getNearestTraffic() const {
+    TrafficTarget nearest;
+    double minRange = std::numeric_limits<double>::max();
+    
+    for (const auto& target : front().targets) {
+        if (target.range < minRange) {
+            minRange = target.range;
+            nearest = target;
         }
     }
     
+    return nearest;
+}
+
+std::vector<TrafficAdvisory> TrafficSystem::checkTrafficConflicts() const {
+    TRACE_SCOPE("tcas.conflicts");
+    std::vector<TrafficAdvisory> advisories;
+    collectTrafficConflicts(front(), advisories, false);
     return advisories;
 }
 
+std::pmr::vector<TrafficAdvisory> TrafficSystem::checkTrafficConflicts(std::pmr::memory_resource* resource) const {
+    TRACE_SCOPE("tcas.conflicts");
+    std::pmr::vector<TrafficAdvisory> advisories(resource);
+    collectTrafficConflicts(front(), advisories, false);
+    return advisories;
+}
+
+std::vector<TrafficTarget> TrafficSystem::getTrafficInVicinity(double range) const {
+    VicinityView vicinity = trafficInVicinity(range);
+    return std::vector<TrafficTarget>(vicinity.begin(), vicinity.end());
+}
+
+std::pmr::vector<TrafficTarget> TrafficSystem::getTrafficInVicinity(double range,
+                                                                   std::pmr::memory_resource* resource) const {
+    VicinityView vicinity = trafficInVicinity(range);
+    return std::pmr::vector<TrafficTarget>(vicinity.begin(), vicinity.end(), resource);
+}
+
 bool TrafficSystem::hasActiveRA() const {
-    for (const auto& advisory : activeAdvisories_) {
+    for (const auto& advisory : front().advisories) {
         if (advisory.type == TrafficAdvisoryType::RA) {
             return true;
         }
@@ -74,7 +382,7 @@ bool TrafficSystem::hasActiveRA() const {
 }
 
 TrafficAdvisory TrafficSystem::getActiveRA() const {
-    for (const auto& advisory : activeAdvisories_) {
+    for (const auto& advisory : front().advisories) {
         if (advisory.type == TrafficAdvisoryType::RA) {
             return advisory;
         }
@@ -92,10 +400,10 @@ TrafficSystem::AvoidanceManeuver TrafficSystem::calculateAvoidanceManeuver(
     
     if (advisory.raDirection == RADirection::CLIMB) {
         maneuver.targetAltitude = ownAircraft_.position.altitude + 1000.0;
-        maneuver.verticalSpeed = 1500.0;
+        maneuver.verticalSpeed = RA_VERTICAL_SPEED;
     } else if (advisory.raDirection == RADirection::DESCEND) {
         maneuver.targetAltitude = ownAircraft_.position.altitude - 1000.0;
-        maneuver.verticalSpeed = -1500.0;
+        maneuver.verticalSpeed = -RA_VERTICAL_SPEED;
     } else {
         maneuver.targetAltitude = ownAircraft_.position.altitude;
         maneuver.verticalSpeed = 0.0;
@@ -124,12 +432,29 @@ ConflictType TrafficSystem::determineConflictType(const TrafficTarget& target) c
     return ConflictType::CONVERGING;
 }
 
-RADirection TrafficSystem::determineRADirection(const TrafficTarget& target) const {
-    if (target.relativeAltitude > 0) {
-        return RADirection::DESCEND;
-    } else {
-        return RADirection::CLIMB;
+RADirection TrafficSystem::determineRADirection(double climbSeparation, double descendSeparation,
+                                                RADirection latchedSense, bool newThreat) const {
+    // Unchanged threats keep their sense; a new one may reverse it only if
+    // the other sense clears the worst threat by a margin
+    if (latchedSense == RADirection::CLIMB || latchedSense == RADirection::DESCEND) {
+        if (!newThreat) return latchedSense;
+        double kept = latchedSense == RADirection::CLIMB ? climbSeparation : descendSeparation;
+        double other = latchedSense == RADirection::CLIMB ? descendSeparation : climbSeparation;
+        if (other < kept + RA_REVERSAL_MARGIN) return latchedSense;
+        return latchedSense == RADirection::CLIMB ? RADirection::DESCEND : RADirection::CLIMB;
     }
+    return descendSeparation > climbSeparation ? RADirection::DESCEND : RADirection::CLIMB;
+}
+
+double TrafficSystem::calculateClosureRate(const TrafficTarget& target) const {
+    // Uses the target's (filtered, when tracked) position and velocity
+    RelativeTrack track = relativeTrack(ownAircraft_, target);
+    double range = std::sqrt(track.north * track.north + track.east * track.east);
+    return range > 0.0 ? -(track.north * track.vn + track.east * track.ve) / range : 0.0;
+}
+
+bool TrafficSystem::isConverging(const TrafficTarget& target) const {
+    return calculateClosureRate(target) > 0.0;
 }
 
 double TrafficSystem::calculateRelativeBearing(const TrafficTarget& target) const {
@@ -16,6 +16,7 @@
 *****************************************************************************/
 
 #include "voice_input.hpp"
+#include "audio_kernels.hpp"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
@@ -33,14 +34,20 @@ VoiceActivityDetector::VoiceActivityDetector()
 bool VoiceActivityDetector::initialize(float sensitivity) {
     sensitivity_ = std::max(0.0f, std::min(1.0f, sensitivity));
     noise_floor_ = 100.0 * (1.0 - sensitivity_);
-    energy_history_.clear();
+    energy_head_ = 0;
+    energy_count_ = 0;
     return true;
 }
 
 std::pair<VADLevel, double> VoiceActivityDetector::processFrame(
     const std::vector<int16_t>& samples) {
+    return processFrame(samples.data(), samples.size());
+}
+
+std::pair<VADLevel, double> VoiceActivityDetector::processFrame(
+    const int16_t* samples, size_t count) {
     
-    double energy = calculateFrameEnergy(samples);
+    double energy = calculateFrameEnergy(samples, count);
     double confidence = 0.0;
     
     // Calculate confidence based on energy threshold
@@ -49,16 +56,21 @@ std::pair<VADLevel, double> VoiceActivityDetector::processFrame(
     }
     
     // Store energy history for adaptive noise floor
-    energy_history_.push_back(energy);
-    if (energy_history_.size() > 50) {
-        energy_history_.erase(energy_history_.begin());
+    energy_history_[(energy_head_ + energy_count_) % ENERGY_HISTORY] = energy;
+    if (energy_count_ < ENERGY_HISTORY) {
+        energy_count_++;
+    } else {
+        energy_head_ = (energy_head_ + 1) % ENERGY_HISTORY;
     }
     
     // Update noise floor adaptively
-    if (energy_history_.size() >= 10) {
-        std::vector<double> sorted_history = energy_history_;
-        std::sort(sorted_history.begin(), sorted_history.end());
-        noise_floor_ = sorted_history[sorted_history.size() / 4];  // 25th percentile
+    if (energy_count_ >= 10) {
+        // Order of the ring does not matter for a percentile
+        std::copy(energy_history_.begin(), energy_history_.begin() + energy_count_,
+                  percentile_scratch_.begin());
+        auto quartile = percentile_scratch_.begin() + energy_count_ / 4;
+        std::nth_element(percentile_scratch_.begin(), quartile, percentile_scratch_.begin() + energy_count_);
+        noise_floor_ = *quartile;  // 25th percentile
     }
     
     VADLevel level = determineVADLevel(energy, confidence);
@@ -73,20 +85,16 @@ VoiceInputStats VoiceActivityDetector::getStatistics() const {
     VoiceInputStats stats;
     stats.current_noise_floor = noise_floor_;
     stats.max_amplitude = max_amplitude_;
-    if (!energy_history_.empty()) {
+    if (energy_count_ > 0) {
         stats.average_vad_confidence = std::accumulate(
-            energy_history_.begin(), energy_history_.end(), 0.0) / energy_history_.size();
+            energy_history_.begin(), energy_history_.begin() + energy_count_, 0.0) / energy_count_;
     }
     return stats;
 }
 
 double VoiceActivityDetector::calculateFrameEnergy(
-    const std::vector<int16_t>& samples) const {
-    double energy = 0.0;
-    for (const auto& sample : samples) {
-        energy += sample * sample;
-    }
-    return std::sqrt(energy / std::max(1u, (unsigned)samples.size()));
+    const int16_t* samples, size_t count) const {
+    return AudioKernels::rmsEnergy(samples, count);
 }
 
 VADLevel VoiceActivityDetector::determineVADLevel(double energy, double confidence) {
@@ -96,28 +104,32 @@ VADLevel VoiceActivityDetector::determineVADLevel(double energy, double confiden
     return VADLevel::STRONG_VOICE;
 }
 
-double VoiceActivityDetector::calculateEnergy(
-    const std::vector<int16_t>& samples) const {
-    double sum = 0.0;
-    for (const auto& sample : samples) {
-        sum += sample * sample;
-    }
-    return std::sqrt(sum / std::max(1u, (unsigned)samples.size()));
-}
-
 // ============================================================================
 // AudioPreprocessor Implementation
 // ============================================================================
 
 AudioPreprocessor::AudioPreprocessor()
-    : noise_reduction_level_(0.5f), high_pass_filter_state_(0.0) {
+    : noise_reduction_level_(0.5f), high_pass_filter_state_(0.0), pre_emphasis_state_(0) {
 }
 
 bool AudioPreprocessor::initialize(float noise_reduction_level) {
     noise_reduction_level_ = std::max(0.0f, std::min(1.0f, noise_reduction_level));
+    pre_emphasis_state_ = 0;
     return true;
 }
 
+void AudioPreprocessor::preEmphasize(int16_t* samples, size_t count) {
+    pre_emphasis_state_ = AudioKernels::preEmphasis(samples, count, PRE_EMPHASIS, pre_emphasis_state_);
+}
+
+void AudioPreprocessor::noiseGate(int16_t* samples, size_t count, double noise_floor) {
+    AudioKernels::noiseGate(samples, count, static_cast<int32_t>(noise_floor * noise_reduction_level_));
+}
+
+void AudioPreprocessor::applyGain(int16_t* samples, size_t count, float gain_db) {
+    AudioKernels::applyGain(samples, count, std::pow(10.0f, gain_db / 20.0f));
+}
+
 std::vector<int16_t> AudioPreprocessor::reduceNoise(
     const std::vector<int16_t>& samples) {
     
@@ -153,17 +165,8 @@ std::vector<int16_t> AudioPreprocessor::reduceNoise(
 std::vector<int16_t> AudioPreprocessor::applyGain(
     const std::vector<int16_t>& samples, float gain_db) {
     
-    float gain_linear = std::pow(10.0f, gain_db / 20.0f);
-    
-    std::vector<int16_t> result;
-    result.reserve(samples.size());
-    
-    for (const auto& sample : samples) {
-        double amplified = sample * gain_linear;
-        result.push_back(static_cast<int16_t>(
-            std::max(-32768.0, std::min(32767.0, amplified))));
-    }
-    
+    std::vector<int16_t> result = samples;
+    applyGain(result.data(), result.size(), gain_db);
     return result;
 }
 
@@ -172,22 +175,13 @@ std::vector<int16_t> AudioPreprocessor::normalize(
     
     if (samples.empty()) return samples;
     
-    int16_t max_sample = 0;
-    for (const auto& sample : samples) {
-        max_sample = std::max(max_sample, static_cast<int16_t>(std::abs(sample)));
-    }
-    
+    int32_t max_sample = AudioKernels::peakMagnitude(samples.data(), samples.size());
     if (max_sample == 0) return samples;
     
     float scale = 30000.0f / max_sample;  // Target level
     
-    std::vector<int16_t> result;
-    result.reserve(samples.size());
-    
-    for (const auto& sample : samples) {
-        result.push_back(static_cast<int16_t>(sample * scale));
-    }
-    
+    std::vector<int16_t> result = samples;
+    AudioKernels::applyGain(result.data(), result.size(), scale);
     return result;
 }
 
@@ -214,76 +208,75 @@ std::vector<int16_t> AudioPreprocessor::highPassFilter(
 // VoiceCommandBuffer Implementation
 // ============================================================================
 
-VoiceCommandBuffer::VoiceCommandBuffer() : max_frames_(0) {
+VoiceCommandBuffer::VoiceCommandBuffer() : head_(0), count_(0), max_frames_(0) {
 }
 
 void VoiceCommandBuffer::initialize(size_t max_frames) {
     max_frames_ = max_frames;
+    frames_.assign(max_frames, AudioFrame{{}, 0, VADLevel::NO_VOICE});
     clear();
 }
 
 void VoiceCommandBuffer::addFrame(const AudioFrame& frame) {
-    if (frames_.size() >= max_frames_) {
-        frames_.pop();
+    addFrame(frame.samples.data(), frame.samples.size(), frame.timestamp_ms, frame.vad_level);
+}
+
+void VoiceCommandBuffer::addFrame(const int16_t* samples, size_t count,
+                                  uint64_t timestamp_ms, VADLevel vad_level) {
+    if (frames_.empty()) return;
+    
+    AudioFrame& slot = frames_[(head_ + count_) % frames_.size()];
+    if (count_ < frames_.size()) {
+        count_++;
+    } else {
+        head_ = (head_ + 1) % frames_.size();  // overwrite the oldest
     }
-    frames_.push(frame);
+    slot.samples.assign(samples, samples + count);
+    slot.timestamp_ms = timestamp_ms;
+    slot.vad_level = vad_level;
 }
 
 std::vector<int16_t> VoiceCommandBuffer::getBufferedAudio() const {
     std::vector<int16_t> result;
     
-    std::queue<AudioFrame> temp = frames_;
-    while (!temp.empty()) {
-        const auto& frame = temp.front();
+    for (size_t i = 0; i < count_; ++i) {
+        const auto& frame = at(i);
         result.insert(result.end(), frame.samples.begin(), frame.samples.end());
-        temp.pop();
     }
     
     return result;
 }
 
 void VoiceCommandBuffer::clear() {
-    while (!frames_.empty()) {
-        frames_.pop();
-    }
+    head_ = 0;
+    count_ = 0;
 }
 
 bool VoiceCommandBuffer::hasMinimumVoiceContent(size_t min_voice_frames) const {
     size_t voice_frames = 0;
-    std::queue<AudioFrame> temp = frames_;
-    
-    while (!temp.empty()) {
-        const auto& frame = temp.front();
-        if (frame.vad_level > VADLevel::NO_VOICE) {
+    for (size_t i = 0; i < count_; ++i) {
+        if (at(i).vad_level > VADLevel::NO_VOICE) {
             voice_frames++;
         }
-        temp.pop();
     }
     
     return voice_frames >= min_voice_frames;
 }
 
 AudioFrame VoiceCommandBuffer::getFrame(size_t index) const {
-    std::queue<AudioFrame> temp = frames_;
-    for (size_t i = 0; i < index && !temp.empty(); ++i) {
-        temp.pop();
-    }
-    
-    if (temp.empty()) {
+    if (index >= count_) {
         return AudioFrame{std::vector<int16_t>(), 0, VADLevel::NO_VOICE};
     }
     
-    return temp.front();
+    return at(index);
 }
 
 std::vector<int16_t> VoiceCommandBuffer::extractVoiceSegment() const {
     std::vector<int16_t> result;
     
     bool in_voice = false;
-    std::queue<AudioFrame> temp = frames_;
-    
-    while (!temp.empty()) {
-        const auto& frame = temp.front();
+    for (size_t i = 0; i < count_; ++i) {
+        const auto& frame = at(i);
         
         if (frame.vad_level > VADLevel::NO_VOICE) {
             result.insert(result.end(), frame.samples.begin(), frame.samples.end());
@@ -292,8 +285,6 @@ std::vector<int16_t> VoiceCommandBuffer::extractVoiceSegment() const {
             // End of voice segment detected
             break;
         }
-        
-        temp.pop();
     }
     
     return result;
@@ -310,6 +301,7 @@ VoiceInput::VoiceInput()
     vad_ = std::make_unique<VoiceActivityDetector>();
     preprocessor_ = std::make_unique<AudioPreprocessor>();
     buffer_ = std::make_unique<VoiceCommandBuffer>();
+    capture_ring_ = std::make_unique<AudioCaptureRing>(AudioFormat::FRAME_SIZE, CAPTURE_RING_FRAMES);
 }
 
 VoiceInput::~VoiceInput() {
@@ -327,7 +319,11 @@ bool VoiceInput::initialize() {
     is_running_ = true;
     frame_index_ = 0;
     current_frame_.clear();
-    recent_sound_levels_.clear();
+    current_frame_.reserve(AudioFormat::FRAME_SIZE);
+    processed_frame_.reserve(AudioFormat::FRAME_SIZE);
+    sound_level_head_ = 0;
+    sound_level_count_ = 0;
+    sound_level_sum_ = 0.0;
     
     return true;
 }
@@ -341,21 +337,38 @@ void VoiceInput::shutdown() {
 void VoiceInput::processAudioData(const std::vector<int16_t>& audio_samples) {
     if (!is_running_ || !is_listening_) return;
     
-    // Add to current frame
-    current_frame_.insert(current_frame_.end(), 
-                         audio_samples.begin(), audio_samples.end());
-    
-    // Process complete frames
-    while (current_frame_.size() >= AudioFormat::FRAME_SIZE) {
-        std::vector<int16_t> frame(
-            current_frame_.begin(),
-            current_frame_.begin() + AudioFormat::FRAME_SIZE);
-        
-        current_frame_.erase(current_frame_.begin(),
-                            current_frame_.begin() + AudioFormat::FRAME_SIZE);
+    // Fill the current frame and process each one as it completes
+    size_t offset = 0;
+    while (offset < audio_samples.size()) {
+        size_t take = std::min(AudioFormat::FRAME_SIZE - current_frame_.size(),
+                               audio_samples.size() - offset);
+        current_frame_.insert(current_frame_.end(),
+                             audio_samples.begin() + offset,
+                             audio_samples.begin() + offset + take);
+        offset += take;
         
-        processAccumulatedFrame();
+        if (current_frame_.size() == AudioFormat::FRAME_SIZE) {
+            processFrame(current_frame_.data());
+            current_frame_.clear();
+        }
+    }
+}
+
+void VoiceInput::captureAudio(const int16_t* samples, size_t count) {
+    if (!is_running_ || !is_listening_) return;
+    capture_ring_->write(samples, count);
+}
+
+size_t VoiceInput::processCapturedAudio(size_t max_frames) {
+    size_t processed = 0;
+    while (processed < max_frames) {
+        const int16_t* frame = capture_ring_->front();
+        if (!frame) break;
+        processFrame(frame);
+        capture_ring_->pop();
+        processed++;
     }
+    return processed;
 }
 
 void VoiceInput::startListening() {
@@ -396,63 +409,114 @@ void VoiceInput::registerVoiceCallback(VoiceDetectionCallback callback) {
 }
 
 double VoiceInput::getAverageSoundLevel() const {
-    if (recent_sound_levels_.empty()) return 0.0;
-    
-    double sum = 0.0;
-    for (double level : recent_sound_levels_) {
-        sum += level;
-    }
-    
-    return sum / recent_sound_levels_.size();
+    if (sound_level_count_ == 0) return 0.0;
+    return sound_level_sum_ / sound_level_count_;
 }
 
-void VoiceInput::processAccumulatedFrame() {
-    if (current_frame_.size() != AudioFormat::FRAME_SIZE) return;
-    
-    // Create frame
-    AudioFrame frame;
-    frame.samples = current_frame_;
-    frame.timestamp_ms = frame_index_ * (uint64_t)AudioFormat::FRAME_DURATION_MS;
+void VoiceInput::processFrame(const int16_t* samples) {
+    const size_t count = AudioFormat::FRAME_SIZE;
+    uint64_t timestamp_ms = frame_index_ * (uint64_t)AudioFormat::FRAME_DURATION_MS;
     
-    // Preprocess
-    std::vector<int16_t> processed = preprocessor_->highPassFilter(current_frame_);
-    processed = preprocessor_->reduceNoise(processed);
+    // Preprocess in place on a copy, keeping the raw frame for the buffer
+    processed_frame_.assign(samples, samples + count);
+    preprocessor_->preEmphasize(processed_frame_.data(), count);
     
     // Detect voice activity
-    auto [vad_level, confidence] = vad_->processFrame(processed);
-    frame.vad_level = vad_level;
+    auto [vad_level, confidence] = vad_->processFrame(processed_frame_.data(), count);
     
     // Calculate sound level
-    double max_sample = 0.0;
-    for (const auto& sample : processed) {
-        max_sample = std::max(max_sample, std::abs(static_cast<double>(sample)));
-    }
-    double sound_level = max_sample / 32768.0;  // Normalize to 0.0-1.0
+    double sound_level = AudioKernels::peakMagnitude(processed_frame_.data(), count) / 32768.0;
     
-    recent_sound_levels_.push_back(sound_level);
-    if (recent_sound_levels_.size() > 100) {
-        recent_sound_levels_.erase(recent_sound_levels_.begin());
+    if (sound_level_count_ == SOUND_LEVEL_HISTORY) {
+        sound_level_sum_ -= recent_sound_levels_[sound_level_head_];
+        sound_level_head_ = (sound_level_head_ + 1) % SOUND_LEVEL_HISTORY;
+        sound_level_count_--;
     }
+    recent_sound_levels_[(sound_level_head_ + sound_level_count_) % SOUND_LEVEL_HISTORY] = sound_level;
+    sound_level_count_++;
+    sound_level_sum_ += sound_level;
     
     // Store in buffer
     if (buffer_) {
-        buffer_->addFrame(frame);
+        buffer_->addFrame(samples, count, timestamp_ms, vad_level);
     }
     
-    // Update state
+    // Update state, marking utterance boundaries on the latency tracer
+    if (latency_tracer_) {
+        if (current_vad_level_ == VADLevel::NO_VOICE && vad_level > VADLevel::NO_VOICE) {
+            latency_tracer_->beginUtterance();
+        } else if (current_vad_level_ > VADLevel::NO_VOICE && vad_level == VADLevel::NO_VOICE) {
+            latency_tracer_->mark(VoiceStage::SPEECH_END);
+        }
+    }
     current_vad_level_ = vad_level;
     if (vad_level > VADLevel::NO_VOICE) {
-        last_voice_timestamp_ = frame.timestamp_ms;
+        last_voice_timestamp_ = timestamp_ms;
     }
     
-    // Call voice callback if voice detected
-    if (vad_level > VADLevel::NO_VOICE && voice_callback_) {
-        voice_callback_(processed, confidence);
+    // Call voice callback if voice detected and, with a wake stage, awake
+    bool deliver = vad_level > VADLevel::NO_VOICE;
+    if (wake_spotter_) {
+        deliver = updateWakeGate(vad_level) && deliver;
+    }
+    if (deliver && voice_callback_) {
+        preprocessor_->noiseGate(processed_frame_.data(), count, vad_->getNoiseFloor());
+        voice_callback_(processed_frame_, confidence);
     }
     
     updateStatistics();
     frame_index_++;
-    current_frame_.clear();
+}
+
+void VoiceInput::setWakeSpotter(std::shared_ptr<KeywordSpotter> spotter) {
+    wake_spotter_ = std::move(spotter);
+    awake_ = false;
+    if (wake_spotter_) {
+        wake_spotter_->reset();
+    }
+}
+
+void VoiceInput::reportFalseWake() {
+    if (!wake_spotter_ || wake_judged_) return;
+    statistics_.false_wakes++;
+    wake_judged_ = true;
+    if (awake_) {
+        closeWake();
+    }
+}
+
+bool VoiceInput::updateWakeGate(VADLevel vad_level) {
+    bool voiced = vad_level > VADLevel::NO_VOICE;
+    if (!awake_) {
+        // Asleep: only the spotter sees the frame
+        if (wake_spotter_->processFrame(processed_frame_.data(), AudioFormat::FRAME_SIZE)) {
+            awake_ = true;
+            wake_judged_ = false;
+            wake_voiced_frames_ = 0;
+            wake_silent_frames_ = 0;
+            statistics_.wake_detections++;
+        } else if (voiced) {
+            statistics_.gated_voice_frames++;
+        }
+        return false;
+    }
+    
+    if (voiced) {
+        wake_voiced_frames_++;
+        wake_silent_frames_ = 0;
+    } else if (++wake_silent_frames_ >= WAKE_HANGOVER_FRAMES) {
+        if (wake_voiced_frames_ == 0 && !wake_judged_) {
+            statistics_.false_wakes++;
+            wake_judged_ = true;
+        }
+        closeWake();
+    }
+    return true;
+}
+
+void VoiceInput::closeWake() {
+    awake_ = false;
+    wake_spotter_->reset();
 }
 
 void VoiceInput::updateStatistics() {
@@ -473,6 +537,8 @@ void VoiceInput::updateStatistics() {
     if (statistics_.total_frames_processed > 0) {
         statistics_.average_vad_confidence = 
             (double)statistics_.voice_frames_detected / statistics_.total_frames_processed;
+        double hours = statistics_.total_frames_processed * (double)AudioFormat::FRAME_DURATION_MS / 3600000.0;
+        statistics_.false_wakes_per_hour = statistics_.false_wakes / hours;
     }
 }
 
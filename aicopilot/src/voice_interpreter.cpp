@@ -242,6 +242,7 @@ AmbiguityResolver::AmbiguityResolver()
 
 void AmbiguityResolver::setNavdataProvider(std::shared_ptr<INavdataProvider> provider) {
     navdata_provider_ = provider;
+    waypoint_cache_.clear();
 }
 
 bool AmbiguityResolver::hasAmbiguity(const SystemAction& action) const {
@@ -334,40 +335,107 @@ std::vector<std::string> AmbiguityResolver::resolveRunwayAmbiguity(
 std::vector<std::string> AmbiguityResolver::resolveWaypointAmbiguity(
     const std::string& waypoint_name) {
     
-    std::vector<std::string> candidates;
     if (waypoint_name.empty()) {
-        return candidates;
+        return {};
     }
+    return resolveWaypointAmbiguities({waypoint_name}).front();
+}
 
-    const std::string normalized = [&waypoint_name]() {
-        std::string upper = waypoint_name;
-        std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char c) {
-            return static_cast<char>(std::toupper(c));
-        });
-        return upper;
-    }();
-
-    if (auto provider = navdata_provider_.lock()) {
-        AirportInfo airportInfo;
-        if (provider->getAirportByICAO(normalized, airportInfo)) {
-            candidates.push_back(normalized);
-        } else if (normalized.size() == 3) {
-            std::string prefixed = "K" + normalized;
-            if (provider->getAirportByICAO(prefixed, airportInfo)) {
-                candidates.push_back(prefixed);
-            }
+std::vector<std::vector<std::string>> AmbiguityResolver::resolveWaypointAmbiguities(
+    const std::vector<std::string>& waypoint_names) {
+    
+    std::vector<std::vector<std::string>> results(waypoint_names.size());
+    auto provider = navdata_provider_.lock();
+    if (!provider) {
+        return results;
+    }
+    
+    // Answer recently spoken names from the cache; batch the rest
+    std::vector<std::string> normalized(waypoint_names.size());
+    std::vector<size_t> misses;
+    for (size_t i = 0; i < waypoint_names.size(); ++i) {
+        normalized[i] = waypoint_names[i];
+        std::transform(normalized[i].begin(), normalized[i].end(), normalized[i].begin(),
+                       [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+        if (normalized[i].empty()) {
+            continue;
         }
-
-        NavaidInfo navaidInfo;
-        if (provider->getNavaidByID(normalized, navaidInfo)) {
-            candidates.push_back(normalized);
+        if (const auto* cached = findCachedWaypoint(normalized[i])) {
+            results[i] = *cached;
+        } else {
+            misses.push_back(i);
         }
-
+    }
+    if (misses.empty()) {
+        return results;
+    }
+    
+    // Each name is tried as an airport (three-letter names also with a K
+    // prefix) and as a navaid, all in one request per kind
+    std::vector<std::string> airportCodes;
+    std::vector<size_t> airportOwner;
+    std::vector<std::string> navaidIds;
+    for (size_t i : misses) {
+        airportCodes.push_back(normalized[i]);
+        airportOwner.push_back(i);
+        if (normalized[i].size() == 3) {
+            airportCodes.push_back("K" + normalized[i]);
+            airportOwner.push_back(i);
+        }
+        navaidIds.push_back(normalized[i]);
+    }
+    
+    std::vector<AirportInfo> airports;
+    std::vector<NavaidInfo> navaids;
+    provider->getAirportsByICAO(airportCodes, airports);
+    provider->getNavaidsByID(navaidIds, navaids);
+    
+    // The plain code wins over the K-prefixed one, as with single lookups
+    std::vector<bool> airportFound(waypoint_names.size(), false);
+    for (size_t k = 0; k < airportCodes.size() && k < airports.size(); ++k) {
+        size_t owner = airportOwner[k];
+        if (!airports[k].icao.empty() && !airportFound[owner]) {
+            results[owner].push_back(airportCodes[k]);
+            airportFound[owner] = true;
+        }
+    }
+    for (size_t k = 0; k < misses.size() && k < navaids.size(); ++k) {
+        if (!navaids[k].id.empty()) {
+            results[misses[k]].push_back(navaidIds[k]);
+        }
+    }
+    
+    for (size_t i : misses) {
+        auto& candidates = results[i];
         std::sort(candidates.begin(), candidates.end());
         candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        cacheWaypoint(normalized[i], candidates);
+    }
+    
+    return results;
+}
+
+void AmbiguityResolver::prefetchWaypoints(const std::vector<std::string>& waypoint_names) {
+    resolveWaypointAmbiguities(waypoint_names);
+}
+
+const std::vector<std::string>* AmbiguityResolver::findCachedWaypoint(const std::string& normalized) {
+    for (size_t i = 0; i < waypoint_cache_.size(); ++i) {
+        if (waypoint_cache_[i].first == normalized) {
+            std::rotate(waypoint_cache_.begin(), waypoint_cache_.begin() + i,
+                        waypoint_cache_.begin() + i + 1);
+            return &waypoint_cache_.front().second;
+        }
     }
+    return nullptr;
+}
 
-    return candidates;
+void AmbiguityResolver::cacheWaypoint(const std::string& normalized,
+                                      const std::vector<std::string>& candidates) {
+    if (waypoint_cache_.size() >= WAYPOINT_CACHE_SIZE) {
+        waypoint_cache_.pop_back();
+    }
+    waypoint_cache_.insert(waypoint_cache_.begin(), {normalized, candidates});
 }
 
 VoiceInterpreter::VoiceInterpreter() {
@@ -437,6 +505,9 @@ SystemAction VoiceInterpreter::interpretCommandWithParameters(
     }
     
     last_action_ = action;
+    if (latency_tracer_) {
+        latency_tracer_->mark(VoiceStage::INTERPRETED);
+    }
     return action;
 }
 
@@ -501,4 +572,10 @@ void VoiceInterpreter::setNavdataProvider(std::shared_ptr<INavdataProvider> prov
     }
 }
 
+void VoiceInterpreter::prefetchWaypoints(const std::vector<std::string>& waypoint_names) {
+    if (ambiguity_resolver_) {
+        ambiguity_resolver_->prefetchWaypoints(waypoint_names);
+    }
+}
+
 } // namespace AICopilot
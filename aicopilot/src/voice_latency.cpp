@@ -0,0 +1,171 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*****************************************************************************/
+
+#include "voice_latency.hpp"
+#include "system_monitor.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AICopilot {
+
+const char* voiceStageName(VoiceStage stage) {
+    switch (stage) {
+        case VoiceStage::SPEECH_START: return "speech_start";
+        case VoiceStage::SPEECH_END: return "speech_end";
+        case VoiceStage::RECOGNIZED: return "recognized";
+        case VoiceStage::INTERPRETED: return "interpreted";
+        case VoiceStage::DISPATCHED: return "dispatched";
+        case VoiceStage::READBACK: return "readback";
+        default: return "unknown";
+    }
+}
+
+// ============================================================================
+// LatencyHistogram Implementation
+// ============================================================================
+
+void LatencyHistogram::record(double latencyMs) {
+    latencyMs = std::max(0.0, latencyMs);
+    size_t bucket = 0;
+    while (bucket + 1 < BUCKETS && latencyMs > bucketUpperBoundMs(bucket)) {
+        bucket++;
+    }
+    buckets_[bucket]++;
+    count_++;
+    sum_ += latencyMs;
+    max_ = std::max(max_, latencyMs);
+}
+
+double LatencyHistogram::percentile(double p) const {
+    if (count_ == 0) {
+        return 0.0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * count_));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            // The top bucket is open-ended; its best bound is the maximum seen
+            return i + 1 < BUCKETS ? std::min(bucketUpperBoundMs(i), max_) : max_;
+        }
+    }
+    return max_;
+}
+
+double LatencyHistogram::bucketUpperBoundMs(size_t bucket) {
+    return std::ldexp(FIRST_BOUND_MS, static_cast<int>(bucket));
+}
+
+// ============================================================================
+// VoiceLatencyTracer Implementation
+// ============================================================================
+
+void VoiceLatencyTracer::beginUtterance(Clock::time_point when) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) {
+        closeLocked();
+    }
+    open_ = true;
+    marked_ = 0;
+    marks_[static_cast<size_t>(VoiceStage::SPEECH_START)] = when;
+    marked_ |= 1u << static_cast<unsigned>(VoiceStage::SPEECH_START);
+}
+
+void VoiceLatencyTracer::mark(VoiceStage stage, Clock::time_point when) {
+    if (stage == VoiceStage::SPEECH_START) {
+        beginUtterance(when);
+        return;
+    }
+    if (stage >= VoiceStage::COUNT) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t bit = 1u << static_cast<unsigned>(stage);
+    if (!open_ || (marked_ & bit)) {
+        return;
+    }
+    marks_[static_cast<size_t>(stage)] = when;
+    marked_ |= bit;
+    if (stage == VoiceStage::READBACK) {
+        closeLocked();
+    }
+}
+
+void VoiceLatencyTracer::endUtterance() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (open_) {
+        closeLocked();
+    }
+}
+
+bool VoiceLatencyTracer::hasOpenUtterance() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return open_;
+}
+
+VoiceLatencyReport VoiceLatencyTracer::getReport() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return report_;
+}
+
+void VoiceLatencyTracer::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    report_ = VoiceLatencyReport{};
+    open_ = false;
+    marked_ = 0;
+}
+
+void VoiceLatencyTracer::setSystemMonitor(SystemMonitor* monitor) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    monitor_ = monitor;
+}
+
+void VoiceLatencyTracer::closeLocked() {
+    open_ = false;
+
+    size_t first = STAGE_COUNT;
+    size_t previous = STAGE_COUNT;
+    size_t stagesMarked = 0;
+    for (size_t s = 0; s < STAGE_COUNT; ++s) {
+        if (!(marked_ & (1u << s))) continue;
+        // Stages can be marked out of order across threads; never record negative spans
+        if (previous != STAGE_COUNT && marks_[s] >= marks_[previous]) {
+            std::chrono::duration<double, std::milli> span = marks_[s] - marks_[previous];
+            report_.stages[s].record(span.count());
+        }
+        if (first == STAGE_COUNT) first = s;
+        if (previous == STAGE_COUNT || marks_[s] >= marks_[previous]) previous = s;
+        stagesMarked++;
+    }
+    marked_ = 0;
+
+    if (stagesMarked < 2) {
+        report_.abandoned++;
+        return;
+    }
+
+    std::chrono::duration<double, std::milli> total = marks_[previous] - marks_[first];
+    report_.total.record(total.count());
+    report_.utterances++;
+    if (monitor_) {
+        monitor_->recordQueryLatency(SystemComponent::VOICE_PIPELINE, total.count());
+    }
+}
+
+} // namespace AICopilot
@@ -17,25 +17,152 @@
 
 #include "voice_output.hpp"
 #include <algorithm>
-#include <sstream>
-#include <iomanip>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <initializer_list>
 #include <cmath>
 
 namespace AICopilot {
 
+// ============================================================================
+// SpeechCache Implementation
+// ============================================================================
+
+SpeechCache::SpeechCache(size_t sample_budget)
+    : sample_budget_(sample_budget) {
+}
+
+std::string SpeechCache::makeKey(SpeakerProfile speaker, const std::string& text) {
+    std::string key(1, static_cast<char>('0' + static_cast<int>(speaker)));
+    key += text;
+    return key;
+}
+
+SpeechCache::Audio SpeechCache::find(SpeakerProfile speaker, const std::string& text) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(makeKey(speaker, text));
+    if (it == index_.end()) {
+        misses_++;
+        return nullptr;
+    }
+    hits_++;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->audio;
+}
+
+bool SpeechCache::contains(SpeakerProfile speaker, const std::string& text) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_.count(makeKey(speaker, text)) != 0;
+}
+
+void SpeechCache::insert(SpeakerProfile speaker, const std::string& text, Audio audio,
+                         uint64_t generation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (generation != generation_ || !audio) return;
+    
+    std::string key = makeKey(speaker, text);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        samples_ -= it->second->audio->size();
+        entries_.erase(it->second);
+        index_.erase(it);
+    }
+    samples_ += audio->size();
+    entries_.push_front({key, std::move(audio)});
+    index_.emplace(std::move(key), entries_.begin());
+    trim();
+}
+
+void SpeechCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+    samples_ = 0;
+    generation_++;
+}
+
+uint64_t SpeechCache::getGeneration() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return generation_;
+}
+
+void SpeechCache::setSampleBudget(size_t sample_budget) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sample_budget_ = sample_budget;
+    trim();
+}
+
+SpeechCacheStats SpeechCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SpeechCacheStats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.evictions = evictions_;
+    stats.phrases = entries_.size();
+    stats.samples = samples_;
+    stats.sample_budget = sample_budget_;
+    return stats;
+}
+
+void SpeechCache::trim() {
+    // The most recent phrase always stays, even when larger than the budget
+    while (samples_ > sample_budget_ && entries_.size() > 1) {
+        const Entry& victim = entries_.back();
+        samples_ -= victim.audio->size();
+        index_.erase(victim.key);
+        entries_.pop_back();
+        evictions_++;
+    }
+}
+
 // ============================================================================
 // SpeechSynthesizer Implementation
 // ============================================================================
 
+namespace {
+
+bool containsDigit(const std::string& text) {
+    return std::any_of(text.begin(), text.end(),
+                       [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; });
+}
+
+// Numbers as ATC speaks them: round thousands and hundreds in words, anything else digit by digit
+void appendSpokenNumber(const std::string& digits, std::vector<std::string>& words) {
+    static const char* const DIGITS[] = {
+        "zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine"
+    };
+    
+    bool grouped = digits.size() >= 3 && digits.size() <= 5 && digits[0] != '0' &&
+                   digits.compare(digits.size() - 2, 2, "00") == 0;
+    if (!grouped) {
+        for (char c : digits) words.push_back(DIGITS[c - '0']);
+        return;
+    }
+    
+    size_t thousands_digits = digits.size() - 3;
+    for (size_t i = 0; i < thousands_digits; ++i) words.push_back(DIGITS[digits[i] - '0']);
+    if (thousands_digits > 0) words.push_back("thousand");
+    char hundreds = digits[thousands_digits];
+    if (hundreds != '0') {
+        words.push_back(DIGITS[hundreds - '0']);
+        words.push_back("hundred");
+    }
+}
+
+} // namespace
+
 SpeechSynthesizer::SpeechSynthesizer()
-    : is_ready_(false) {
+    : is_ready_(false), cache_(DEFAULT_CACHE_SAMPLES) {
 }
 
 SpeechSynthesizer::~SpeechSynthesizer() {
 }
 
 bool SpeechSynthesizer::initialize(const TTSConfig& config) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
     config_ = config;
+    cache_.clear();
     is_ready_ = true;
     return true;
 }
@@ -50,39 +177,174 @@ SynthesizedSpeech SpeechSynthesizer::synthesize(
     speech.is_critical = (output_type == VoiceOutputType::WARNING_ALERT ||
                          output_type == VoiceOutputType::ERROR_MESSAGE);
     
+    TTSConfig config;
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        config = config_;
+        generation = cache_.getGeneration();
+    }
+    
     // Generate audio samples
-    speech.audio_samples = generateAudioSamples(text);
-    speech.duration_ms = estimateDuration(text);
+    speech.audio_samples = *phraseAudio(text, config, generation);
+    speech.duration_ms = estimateDuration(text, config);
     
     return speech;
 }
 
 void SpeechSynthesizer::configure(const TTSConfig& config) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    // Only the volume is rendered into the samples
+    if (config.volume != config_.volume) {
+        cache_.clear();
+    }
     config_ = config;
 }
 
+TTSConfig SpeechSynthesizer::getConfig() const {
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    return config_;
+}
+
 void SpeechSynthesizer::setSpeakerProfile(SpeakerProfile profile) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
     config_.speaker = profile;
 }
 
 void SpeechSynthesizer::setSpeechRate(float rate) {
+    std::lock_guard<std::mutex> lock(config_mutex_);
     config_.speech_rate = std::max(0.5f, std::min(2.0f, rate));
 }
 
 void SpeechSynthesizer::setVolume(float volume) {
-    config_.volume = std::max(0.0f, std::min(1.0f, volume));
+    std::lock_guard<std::mutex> lock(config_mutex_);
+    volume = std::max(0.0f, std::min(1.0f, volume));
+    if (volume != config_.volume) {
+        cache_.clear();
+    }
+    config_.volume = volume;
+}
+
+size_t SpeechSynthesizer::preSynthesize(const std::vector<std::string>& phrases,
+                                        const std::atomic<bool>* cancel) {
+    TTSConfig config;
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        config = config_;
+        generation = cache_.getGeneration();
+    }
+    
+    size_t synthesized = 0;
+    for (const auto& phrase : phrases) {
+        if (cancel && cancel->load()) break;
+        if (cache_.contains(config.speaker, phrase)) continue;
+        phraseAudio(phrase, config, generation);
+        synthesized++;
+    }
+    return synthesized;
+}
+
+std::vector<std::string> SpeechSynthesizer::getStandardPhrases() {
+    return {
+        // Fragments numeric readbacks are assembled from
+        "zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine",
+        "hundred", "thousand", "point", "feet", "knots", "degrees", "heading",
+        "flight", "level", "roger", "acknowledged", "confirming", "nautical", "miles",
+        // Altitude and configuration callouts
+        "Minimums", "Approaching minimums", "Five hundred", "One hundred",
+        "Fifty", "Forty", "Thirty", "Twenty", "Ten", "Retard",
+        "Gear down", "Gear up", "Flaps up", "Flaps one", "Flaps two", "Flaps full",
+        "V one", "Rotate", "Positive rate", "Speed brakes armed", "Spoilers",
+        "Reverse green", "Sixty knots", "Eighty knots",
+        // Warnings
+        "Terrain ahead!", "Pull up", "Sink rate", "Glideslope", "Bank angle",
+        "Too low, gear", "Too low, flaps", "Windshear"
+    };
+}
+
+std::vector<std::string> SpeechSynthesizer::splitFragments(const std::string& text) {
+    std::vector<std::string> words;
+    std::string word;
+    std::string digits;
+    
+    auto flushWord = [&]() {
+        if (!word.empty()) words.push_back(std::move(word));
+        word.clear();
+    };
+    auto flushDigits = [&]() {
+        if (!digits.empty()) appendSpokenNumber(digits, words);
+        digits.clear();
+    };
+    
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (std::isdigit(c)) {
+            flushWord();
+            digits += static_cast<char>(c);
+        } else if (std::isalpha(c) || (c == '-' && !word.empty())) {
+            flushDigits();
+            word += static_cast<char>(std::tolower(c));
+        } else if (c == '.' && !digits.empty() && i + 1 < text.size() &&
+                   std::isdigit(static_cast<unsigned char>(text[i + 1]))) {
+            // Decimals are read digit by digit after "point"
+            for (char d : digits) appendSpokenNumber(std::string(1, d), words);
+            digits.clear();
+            words.push_back("point");
+        } else {
+            flushWord();
+            flushDigits();
+        }
+    }
+    flushWord();
+    flushDigits();
+    return words;
+}
+
+SpeechCache::Audio SpeechSynthesizer::phraseAudio(const std::string& text,
+                                                  const TTSConfig& config,
+                                                  uint64_t generation) {
+    if (auto audio = cache_.find(config.speaker, text)) {
+        return audio;
+    }
+    auto audio = std::make_shared<const std::vector<int16_t>>(
+        containsDigit(text) ? assembleFragments(text, config, generation)
+                            : generateAudioSamples(text, config));
+    cache_.insert(config.speaker, text, audio, generation);
+    return audio;
+}
+
+std::vector<int16_t> SpeechSynthesizer::assembleFragments(const std::string& text,
+                                                          const TTSConfig& config,
+                                                          uint64_t generation) {
+    std::vector<SpeechCache::Audio> fragments;
+    size_t total = 0;
+    for (const auto& word : splitFragments(text)) {
+        fragments.push_back(phraseAudio(word, config, generation));
+        total += fragments.back()->size();
+    }
+    
+    const size_t gap = SAMPLE_RATE * FRAGMENT_GAP_MS / 1000;
+    std::vector<int16_t> samples;
+    samples.reserve(total + gap * fragments.size());
+    for (size_t i = 0; i < fragments.size(); ++i) {
+        if (i > 0) samples.insert(samples.end(), gap, int16_t(0));
+        samples.insert(samples.end(), fragments[i]->begin(), fragments[i]->end());
+    }
+    return samples;
 }
 
 std::vector<int16_t> SpeechSynthesizer::generateAudioSamples(
-    const std::string& text) {
+    const std::string& text, const TTSConfig& config) const {
     
     std::vector<int16_t> samples;
     
     // Generate a simple audio representation
     // In a real implementation, this would use a TTS engine
-    const int sample_rate = 16000;
+    const int sample_rate = SAMPLE_RATE;
     const float duration_ms = (text.length() / 5.0f) * 1000;  // ~5 chars per second
     const int num_samples = static_cast<int>(sample_rate * duration_ms / 1000.0f);
+    samples.reserve(num_samples);
     
     // Generate tone-based representation (simple beep pattern)
     float frequency = 440.0f + (text.length() * 10);  // Vary frequency by text length
@@ -91,7 +353,7 @@ std::vector<int16_t> SpeechSynthesizer::generateAudioSamples(
     for (int i = 0; i < num_samples; ++i) {
         float t = (float)i / sample_rate;
         float sample = std::sin(2 * 3.14159f * frequency * t);
-        sample *= config_.volume;
+        sample *= config.volume;
         
         // Apply envelope to avoid clicks
         float envelope = 1.0f;
@@ -108,164 +370,222 @@ std::vector<int16_t> SpeechSynthesizer::generateAudioSamples(
     return samples;
 }
 
-uint32_t SpeechSynthesizer::estimateDuration(const std::string& text) const {
+uint32_t SpeechSynthesizer::estimateDuration(const std::string& text, const TTSConfig& config) const {
     // Estimate: ~5 characters per second at normal speed
-    float chars_per_second = 5.0f * config_.speech_rate;
+    float chars_per_second = 5.0f * config.speech_rate;
     float duration_seconds = text.length() / chars_per_second;
     
     return static_cast<uint32_t>(duration_seconds * 1000);
 }
 
+// ============================================================================
+// CalloutFormatter Implementation
+// ============================================================================
+
+namespace {
+
+constexpr std::string_view DIGIT_WORDS[] = {
+    "zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine"
+};
+
+constexpr std::string_view COMPASS_POINTS[] = {
+    "North", "Northeast", "East", "Southeast", "South", "Southwest", "West", "Northwest"
+};
+
+constexpr std::string_view PHONETIC_ALPHABET[] = {
+    "Alpha", "Bravo", "Charlie", "Delta", "Echo", "Foxtrot", "Golf", "Hotel",
+    "India", "Juliett", "Kilo", "Lima", "Mike", "November", "Oscar", "Papa",
+    "Quebec", "Romeo", "Sierra", "Tango", "Uniform", "Victor", "Whiskey", "X-ray",
+    "Yankee", "Zulu"
+};
+static_assert(sizeof(PHONETIC_ALPHABET) / sizeof(PHONETIC_ALPHABET[0]) == 26,
+              "one phonetic word per letter");
+
+// Free-text phrases sized once up front, so they allocate exactly once
+std::string concat(std::initializer_list<std::string_view> parts) {
+    size_t length = 0;
+    for (std::string_view part : parts) length += part.size();
+    std::string text;
+    text.reserve(length);
+    for (std::string_view part : parts) text.append(part);
+    return text;
+}
+
+} // namespace
+
+CalloutFormatter& CalloutFormatter::forThread() {
+    thread_local CalloutFormatter formatter;
+    return formatter.clear();
+}
+
+CalloutFormatter& CalloutFormatter::clear() {
+    length_ = 0;
+    truncated_ = false;
+    return *this;
+}
+
+CalloutFormatter& CalloutFormatter::append(std::string_view text) {
+    size_t count = std::min(text.size(), CAPACITY - length_);
+    text.copy(buffer_.data() + length_, count);
+    length_ += count;
+    truncated_ |= count < text.size();
+    return *this;
+}
+
+CalloutFormatter& CalloutFormatter::append(char c) {
+    return append(std::string_view(&c, 1));
+}
+
+CalloutFormatter& CalloutFormatter::appendInt(long long value) {
+    char digits[24];
+    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+    return append(std::string_view(digits, static_cast<size_t>(end - digits)));
+}
+
+CalloutFormatter& CalloutFormatter::appendFixed(double value, int decimals) {
+    // snprintf needs room for its terminator, which the buffer does not keep
+    char digits[64];
+    int written = std::snprintf(digits, sizeof(digits), "%.*f", std::clamp(decimals, 0, 6), value);
+    if (written < 0) {
+        return *this;
+    }
+    if (static_cast<size_t>(written) >= sizeof(digits)) {
+        truncated_ = true;
+        written = sizeof(digits) - 1;
+    }
+    return append(std::string_view(digits, static_cast<size_t>(written)));
+}
+
 // ============================================================================
 // ReadbackGenerator Implementation
 // ============================================================================
 
 ReadbackGenerator::ReadbackGenerator() {
-    // Initialize phonetic alphabet
-    phonetic_alphabet_ = {
-        {'A', "Alpha"}, {'B', "Bravo"}, {'C', "Charlie"}, {'D', "Delta"},
-        {'E', "Echo"}, {'F', "Foxtrot"}, {'G', "Golf"}, {'H', "Hotel"},
-        {'I', "India"}, {'J', "Juliett"}, {'K', "Kilo"}, {'L', "Lima"},
-        {'M', "Mike"}, {'N', "November"}, {'O', "Oscar"}, {'P', "Papa"},
-        {'Q', "Quebec"}, {'R', "Romeo"}, {'S', "Sierra"}, {'T', "Tango"},
-        {'U', "Uniform"}, {'V', "Victor"}, {'W', "Whiskey"}, {'X', "X-ray"},
-        {'Y', "Yankee"}, {'Z', "Zulu"}
-    };
 }
 
 std::string ReadbackGenerator::generateCommandConfirmation(
     const std::string& command) {
     
-    return "Roger, " + command + " acknowledged.";
+    return concat({"Roger, ", command, " acknowledged."});
 }
 
 std::string ReadbackGenerator::generateActionReadback(
     const std::string& action_description) {
     
-    return "Roger, " + action_description + ".";
+    return concat({"Roger, ", action_description, "."});
 }
 
 std::string ReadbackGenerator::generateParameterConfirmation(
     const std::string& param_name,
     const std::string& param_value) {
     
-    std::stringstream ss;
-    ss << "Confirming " << param_name << ": " << param_value << ".";
-    return ss.str();
+    return concat({"Confirming ", param_name, ": ", param_value, "."});
 }
 
 std::string ReadbackGenerator::generateAltitudeReadback(double altitude_feet) {
-    std::stringstream ss;
-    
-    if (altitude_feet >= 10000) {
-        int flight_level = static_cast<int>(altitude_feet) / 100;
-        ss << "Flight level " << flight_level << ".";
-    } else {
-        ss << std::fixed << std::setprecision(0) << altitude_feet << " feet.";
-    }
-    
-    return ss.str();
+    CalloutFormatter& out = CalloutFormatter::forThread();
+    generateAltitudeReadback(altitude_feet, out);
+    return out.str();
+}
+
+void ReadbackGenerator::generateAltitudeReadback(double altitude_feet, CalloutFormatter& out) const {
+    formatAltitude(altitude_feet, out);
+    out.append('.');
 }
 
 std::string ReadbackGenerator::generateHeadingReadback(double heading_degrees) {
-    std::stringstream ss;
-    
-    ss << "Heading " << std::fixed << std::setprecision(0) << heading_degrees << " degrees.";
-    return ss.str();
+    CalloutFormatter& out = CalloutFormatter::forThread();
+    generateHeadingReadback(heading_degrees, out);
+    return out.str();
+}
+
+void ReadbackGenerator::generateHeadingReadback(double heading_degrees, CalloutFormatter& out) const {
+    out.append("Heading ").appendFixed(heading_degrees, 0).append(" degrees.");
 }
 
 std::string ReadbackGenerator::generateSpeedReadback(double speed_knots) {
-    std::stringstream ss;
-    ss << std::fixed << std::setprecision(0) << speed_knots << " knots.";
-    return ss.str();
+    CalloutFormatter& out = CalloutFormatter::forThread();
+    generateSpeedReadback(speed_knots, out);
+    return out.str();
+}
+
+void ReadbackGenerator::generateSpeedReadback(double speed_knots, CalloutFormatter& out) const {
+    out.appendFixed(speed_knots, 0).append(" knots.");
 }
 
 std::string ReadbackGenerator::generateWaypointReadback(const std::string& waypoint_id) {
-    std::stringstream ss;
-    ss << "Direct to ";
-    
+    CalloutFormatter& out = CalloutFormatter::forThread();
+    generateWaypointReadback(waypoint_id, out);
+    return out.str();
+}
+
+void ReadbackGenerator::generateWaypointReadback(std::string_view waypoint_id,
+                                                 CalloutFormatter& out) const {
+    out.append("Direct to ");
     for (char c : waypoint_id) {
-        auto it = phonetic_alphabet_.find(std::toupper(c));
-        if (it != phonetic_alphabet_.end()) {
-            ss << it->second << " ";
+        int letter = std::toupper(static_cast<unsigned char>(c));
+        if (letter >= 'A' && letter <= 'Z') {
+            out.append(PHONETIC_ALPHABET[letter - 'A']).append(' ');
         }
     }
-    
-    ss << ".";
-    return ss.str();
+    out.append('.');
 }
 
 std::string ReadbackGenerator::formatStandardReadback(
     const std::map<std::string, std::string>& parameters) {
     
-    std::stringstream ss;
-    ss << "Roger, ";
+    std::string readback = "Roger, ";
+    CalloutFormatter item;
     
     bool first = true;
     for (const auto& [key, value] : parameters) {
-        if (!first) ss << ", ";
+        if (!first) readback += ", ";
         
+        item.clear();
         if (key == "altitude") {
-            ss << generateAltitudeReadback(std::stod(value));
+            generateAltitudeReadback(std::stod(value), item);
         } else if (key == "heading") {
-            ss << generateHeadingReadback(std::stod(value));
+            generateHeadingReadback(std::stod(value), item);
         } else if (key == "speed") {
-            ss << generateSpeedReadback(std::stod(value));
+            generateSpeedReadback(std::stod(value), item);
         } else if (key == "waypoint") {
-            ss << generateWaypointReadback(value);
+            generateWaypointReadback(value, item);
         } else {
-            ss << key << " " << value;
+            item.append(key).append(' ').append(value);
         }
+        readback.append(item.view());
         
         first = false;
     }
     
-    ss << ".";
-    return ss.str();
+    readback += ".";
+    return readback;
 }
 
-std::string ReadbackGenerator::numberToWords(double number) const {
-    static const std::string ones[] = {
-        "zero", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine"
-    };
-    
+std::string_view ReadbackGenerator::numberToWords(double number) const {
     int int_num = static_cast<int>(number);
     if (int_num >= 0 && int_num < 10) {
-        return ones[int_num];
+        return DIGIT_WORDS[int_num];
     }
     
-    return "";
+    return {};
 }
 
-std::string ReadbackGenerator::degreeToHeading(double degrees) const {
-    static const std::map<int, std::string> headings = {
-        {0, "North"}, {45, "Northeast"}, {90, "East"},
-        {135, "Southeast"}, {180, "South"}, {225, "Southwest"},
-        {270, "West"}, {315, "Northwest"}
-    };
-    
-    int rounded = static_cast<int>(degrees + 22.5) / 45 * 45;
-    rounded = rounded % 360;
-    
-    auto it = headings.find(rounded);
-    if (it != headings.end()) {
-        return it->second;
+std::string_view ReadbackGenerator::degreeToHeading(double degrees) const {
+    int rounded = static_cast<int>(degrees + 22.5) / 45 % 8;
+    if (rounded < 0) {
+        return {};
     }
-    
-    return "";
+    return COMPASS_POINTS[rounded];
 }
 
-std::string ReadbackGenerator::formatAltitude(double feet) const {
-    std::stringstream ss;
-    
+void ReadbackGenerator::formatAltitude(double feet, CalloutFormatter& out) const {
     if (feet >= 10000) {
         int flight_level = static_cast<int>(feet) / 100;
-        ss << "Flight level " << flight_level;
+        out.append("Flight level ").appendInt(flight_level);
     } else {
-        ss << std::fixed << std::setprecision(0) << feet << " feet";
+        out.appendFixed(feet, 0).append(" feet");
     }
-    
-    return ss.str();
 }
 
 // ============================================================================
@@ -279,65 +599,76 @@ std::string AnnouncementGenerator::generateStatusAnnouncement(
     const std::string& status_type,
     const std::map<std::string, std::string>& status_data) {
     
-    std::stringstream ss;
-    ss << status_type << " status: ";
+    size_t length = status_type.size() + 9;
+    for (const auto& [key, value] : status_data) {
+        length += key.size() + value.size() + 3;
+    }
     
+    std::string announcement;
+    announcement.reserve(length);
+    announcement.append(status_type).append(" status: ");
     for (const auto& [key, value] : status_data) {
-        ss << key << " " << value << ". ";
+        announcement.append(key).append(" ").append(value).append(". ");
     }
     
-    return ss.str();
+    return announcement;
 }
 
 std::string AnnouncementGenerator::generateWeatherAnnouncement(
     const std::string& airport,
     const std::string& conditions) {
     
-    std::stringstream ss;
-    ss << "Weather for " << airport << ": " << formatWeatherData(conditions) << ".";
-    return ss.str();
+    return concat({"Weather for ", airport, ": ", formatWeatherData(conditions), "."});
 }
 
 std::string AnnouncementGenerator::generateTerrainWarning(
     double distance_nm,
     double altitude_diff) {
     
-    std::stringstream ss;
-    ss << "Terrain ahead, ";
-    ss << std::fixed << std::setprecision(1) << distance_nm << " nautical miles, ";
-    ss << std::fixed << std::setprecision(0) << altitude_diff << " feet below.";
-    return ss.str();
+    CalloutFormatter& out = CalloutFormatter::forThread();
+    generateTerrainWarning(distance_nm, altitude_diff, out);
+    return out.str();
+}
+
+void AnnouncementGenerator::generateTerrainWarning(double distance_nm, double altitude_diff,
+                                                   CalloutFormatter& out) const {
+    out.append("Terrain ahead, ").appendFixed(distance_nm, 1).append(" nautical miles, ");
+    out.appendFixed(altitude_diff, 0).append(" feet below.");
 }
 
 std::string AnnouncementGenerator::generateSystemWarning(
     const std::string& system,
     const std::string& issue) {
     
-    std::stringstream ss;
-    ss << "Warning: " << system << " " << issue << ".";
-    return ss.str();
+    return concat({"Warning: ", system, " ", issue, "."});
 }
 
 std::string AnnouncementGenerator::generateFlightPhaseAnnouncement(
     const std::string& phase) {
     
-    return "Flight phase: " + phase + ".";
+    return concat({"Flight phase: ", phase, "."});
 }
 
 std::string AnnouncementGenerator::generateChecklistAnnouncement(
     const std::string& checklist_name) {
     
-    return "Starting " + checklist_name + " checklist.";
+    return concat({"Starting ", checklist_name, " checklist."});
 }
 
 std::string AnnouncementGenerator::generateNavigationStatus(
     const std::string& current_waypoint,
     double distance_remaining) {
     
-    std::stringstream ss;
-    ss << "Current waypoint " << current_waypoint << ", ";
-    ss << std::fixed << std::setprecision(1) << distance_remaining << " nautical miles remaining.";
-    return ss.str();
+    CalloutFormatter& out = CalloutFormatter::forThread();
+    generateNavigationStatus(current_waypoint, distance_remaining, out);
+    return out.str();
+}
+
+void AnnouncementGenerator::generateNavigationStatus(std::string_view current_waypoint,
+                                                     double distance_remaining,
+                                                     CalloutFormatter& out) const {
+    out.append("Current waypoint ").append(current_waypoint).append(", ");
+    out.appendFixed(distance_remaining, 1).append(" nautical miles remaining.");
 }
 
 std::string AnnouncementGenerator::formatWeatherData(const std::string& conditions) const {
@@ -371,10 +702,13 @@ bool VoiceOutput::initialize() {
     config.speech_rate = 0.9f;
     config.volume = 0.8f;
     
-    return synthesizer_->initialize(config);
+    if (!synthesizer_->initialize(config)) return false;
+    startPreSynthesis();
+    return true;
 }
 
 void VoiceOutput::shutdown() {
+    stopPreSynthesis();
     stopPlayback();
 }
 
@@ -385,6 +719,9 @@ void VoiceOutput::playCommandConfirmation(const std::string& command) {
     SynthesizedSpeech speech = synthesizer_->synthesize(
         readback, VoiceOutputType::COMMAND_CONFIRMATION);
     
+    if (latency_tracer_) {
+        latency_tracer_->mark(VoiceStage::READBACK);
+    }
     playSynthesizedSpeech(speech);
 }
 
@@ -395,6 +732,9 @@ void VoiceOutput::playActionReadback(const std::string& action_description) {
     SynthesizedSpeech speech = synthesizer_->synthesize(
         readback, VoiceOutputType::ACTION_READBACK);
     
+    if (latency_tracer_) {
+        latency_tracer_->mark(VoiceStage::READBACK);
+    }
     playSynthesizedSpeech(speech);
 }
 
@@ -451,6 +791,7 @@ void VoiceOutput::stopPlayback() {
 void VoiceOutput::setTTSConfig(const TTSConfig& config) {
     if (synthesizer_) {
         synthesizer_->configure(config);
+        startPreSynthesis();
     }
 }
 
@@ -471,9 +812,29 @@ std::vector<SpeakerProfile> VoiceOutput::getAvailableSpeakers() const {
 void VoiceOutput::setActiveSpeaker(SpeakerProfile profile) {
     if (synthesizer_) {
         synthesizer_->setSpeakerProfile(profile);
+        startPreSynthesis();
+    }
+}
+
+void VoiceOutput::waitForPreSynthesis() {
+    if (presynthesis_thread_.joinable()) {
+        presynthesis_thread_.join();
     }
 }
 
+void VoiceOutput::startPreSynthesis() {
+    stopPreSynthesis();
+    cancel_presynthesis_ = false;
+    presynthesis_thread_ = std::thread([this]() {
+        synthesizer_->preSynthesize(SpeechSynthesizer::getStandardPhrases(), &cancel_presynthesis_);
+    });
+}
+
+void VoiceOutput::stopPreSynthesis() {
+    cancel_presynthesis_ = true;
+    waitForPreSynthesis();
+}
+
 void VoiceOutput::processAnnouncement(const SynthesizedSpeech& speech) {
     announcement_queue_.push_back(speech);
     
@@ -9,6 +9,64 @@
 
 namespace AICopilot {
 
+namespace {
+
+// Table nodes: 9 weights up to 10% over max gross, density altitude -4000
+// to 16000 ft and -45 to 55 C. Distances are bilinear in density altitude
+// and temperature within a cell (15 C is a node), so only the weight axis
+// interpolates a curve (stall speed ~ sqrt(weight)).
+constexpr size_t WEIGHT_NODES = 9;
+constexpr double OVERWEIGHT_FACTOR = 1.1;
+constexpr PerformanceTable::Axis DENSITY_ALTITUDE_AXIS = {-4000.0, 2000.0, 11};
+constexpr PerformanceTable::Axis TEMPERATURE_AXIS = {-45.0, 10.0, 11};
+
+} // namespace
+
+// ============================================================================
+// PerformanceTable
+// ============================================================================
+
+PerformanceTable::AxisPosition PerformanceTable::locate(const Axis& axis, double value) {
+    double offset = (value - axis.first) / axis.step;
+    double cell = std::floor(offset);
+    double last = static_cast<double>(axis.count - 2);
+    cell = std::max(0.0, std::min(last, cell));
+    return {static_cast<size_t>(cell), offset - cell};
+}
+
+PerformancePoint PerformanceTable::lookup(const AxisPosition& weight, double densityAltitude,
+                                          double temperature) const {
+    AxisPosition d = locate(densityAltitude_, densityAltitude);
+    AxisPosition t = locate(temperature_, temperature);
+    
+    const PerformancePoint* corners[8] = {
+        &at(weight.index, d.index, t.index),         &at(weight.index, d.index, t.index + 1),
+        &at(weight.index, d.index + 1, t.index),     &at(weight.index, d.index + 1, t.index + 1),
+        &at(weight.index + 1, d.index, t.index),     &at(weight.index + 1, d.index, t.index + 1),
+        &at(weight.index + 1, d.index + 1, t.index), &at(weight.index + 1, d.index + 1, t.index + 1),
+    };
+    double weights[8];
+    for (int i = 0; i < 8; ++i) {
+        double fw = (i & 4) ? weight.fraction : 1.0 - weight.fraction;
+        double fd = (i & 2) ? d.fraction : 1.0 - d.fraction;
+        double ft = (i & 1) ? t.fraction : 1.0 - t.fraction;
+        weights[i] = fw * fd * ft;
+    }
+    
+    PerformancePoint result{0.0, 0.0, 0.0, 0.0};
+    for (int i = 0; i < 8; ++i) {
+        result.stallSpeed += corners[i]->stallSpeed * weights[i];
+        result.correctedStallSpeed += corners[i]->correctedStallSpeed * weights[i];
+        result.takeoffDistance += corners[i]->takeoffDistance * weights[i];
+        result.landingDistance += corners[i]->landingDistance * weights[i];
+    }
+    return result;
+}
+
+// ============================================================================
+// VSpeedCalculator
+// ============================================================================
+
 VSpeedCalculator::VSpeedCalculator() = default;
 
 bool VSpeedCalculator::initialize(const AircraftConfig& config) {
@@ -22,9 +80,58 @@ bool VSpeedCalculator::initialize(const AircraftConfig& config) {
     currentVSpeeds_.BEST_CLIMB = config.cruiseSpeed * 0.75;
     currentVSpeeds_.DESCENT_SPEED = config.cruiseSpeed * 0.6;
     
+    // Everything weight and atmosphere dependent is tabulated once here
+    double maxWeight = (config.maxGrossWeight > 0.0 ? config.maxGrossWeight : 2450.0) * OVERWEIGHT_FACTOR;
+    double minWeight = (config.emptyWeight > 0.0 && config.emptyWeight < maxWeight) ? config.emptyWeight
+                                                                                      : maxWeight * 0.5;
+    PerformanceTable::Axis weightAxis = {minWeight, (maxWeight - minWeight) / (WEIGHT_NODES - 1), WEIGHT_NODES};
+    performanceTable_.build(weightAxis, DENSITY_ALTITUDE_AXIS, TEMPERATURE_AXIS,
+                            [this](double weight, double densityAltitude, double temperature) {
+                                return computePerformance(weight, densityAltitude, temperature);
+                            });
+    
     return true;
 }
 
+PerformancePoint VSpeedCalculator::computePerformance(
+    double weight, double densityAltitude, double temperature) const {
+    
+    WeightBalance wb{};
+    wb.totalWeight = weight;
+    
+    PerformancePoint point;
+    point.stallSpeed = calculateBaseStallSpeed(wb);
+    point.correctedStallSpeed = applyDensityAltitudeCorrection(point.stallSpeed, densityAltitude);
+    
+    // Reference: Cessna 172 at 2700 lbs = ~1500 ft at sea level
+    double takeoff = 1500.0 * (weight / aircraftConfig_.maxGrossWeight);
+    
+    // Density altitude correction (approximately 3.5% per 1000 ft DA)
+    takeoff *= 1.0 + (densityAltitude / 1000.0) * 0.035;
+    
+    // Temperature correction (approximately 2% per 5°C above 15°C)
+    takeoff *= 1.0 + std::max(0.0, (temperature - 15.0) / 5.0) * 0.02;
+    point.takeoffDistance = takeoff;
+    
+    // Reference: Cessna 172 = ~1300 ft landing distance at sea level,
+    // approximately 3-4% more per 1000 ft DA
+    double landing = 1300.0 * (weight / aircraftConfig_.maxGrossWeight);
+    landing *= 1.0 + (densityAltitude / 1000.0) * 0.04;
+    point.landingDistance = landing;
+    
+    return point;
+}
+
+PerformancePoint VSpeedCalculator::performanceAt(
+    double weight, const EnvironmentalFactors& environment) const {
+    
+    double densityAltitude = calculateDensityAltitude(environment);
+    if (performanceTable_.empty()) {
+        return computePerformance(weight, densityAltitude, environment.temperature);
+    }
+    return performanceTable_.lookup(weight, densityAltitude, environment.temperature);
+}
+
 VSpeedSet VSpeedCalculator::calculateVSpeeds(
     const WeightBalance& weightBalance,
     const EnvironmentalFactors& environment,
@@ -32,24 +139,16 @@ VSpeedSet VSpeedCalculator::calculateVSpeeds(
     
     VSpeedSet vSpeeds;
     
-    // Calculate base stall speed
-    double baseStallSpeed = calculateBaseStallSpeed(weightBalance);
-    vSpeeds.VS0 = baseStallSpeed;  // Stall speed in landing configuration (flaps down)
-    vSpeeds.VS1 = baseStallSpeed * 0.95;  // Stall speed in clean configuration
+    // Base and density altitude corrected stall speed from the table
+    PerformancePoint point = performanceAt(weightBalance.totalWeight, environment);
+    double correctedStallSpeed = point.correctedStallSpeed;
+    vSpeeds.VS0 = correctedStallSpeed;  // Stall speed in landing configuration (flaps down)
+    vSpeeds.VS1 = correctedStallSpeed * 0.95;  // Stall speed in clean configuration
     
     // Calculate approach speeds
-    vSpeeds.VREF = baseStallSpeed * 1.3;  // Reference landing speed
-    vSpeeds.VAPP = baseStallSpeed * 1.4;  // Approach speed
-    vSpeeds.VF = baseStallSpeed * 1.3;    // Final approach speed
-    
-    // Apply environmental corrections
-    double densityAltitude = calculateDensityAltitude(environment);
-    
-    // Correct stall speeds for density altitude
-    vSpeeds.VS0 = applyDensityAltitudeCorrection(vSpeeds.VS0, densityAltitude);
-    vSpeeds.VS1 = applyDensityAltitudeCorrection(vSpeeds.VS1, densityAltitude);
-    vSpeeds.VREF = applyDensityAltitudeCorrection(vSpeeds.VREF, densityAltitude);
-    vSpeeds.VAPP = applyDensityAltitudeCorrection(vSpeeds.VAPP, densityAltitude);
+    vSpeeds.VREF = correctedStallSpeed * 1.3;  // Reference landing speed
+    vSpeeds.VAPP = correctedStallSpeed * 1.4;  // Approach speed
+    vSpeeds.VF = point.stallSpeed * 1.3;       // Final approach speed
     
     // Apply headwind correction (increases speeds slightly)
     if (environment.windHeadwind > 0) {
@@ -98,42 +197,25 @@ double VSpeedCalculator::calculateTakeoffDistanceRequired(
     const EnvironmentalFactors& environment,
     double safetyFactor) {
     
-    // Base takeoff distance calculation (simplified model)
-    // Real calculation would use:
-    // - Runway surface friction coefficient
-    // - Density altitude
-    // - Aircraft weight
-    // - Temperature
-    // - Wind component
-    
-    double densityAltitude = calculateDensityAltitude(environment);
-    
-    // Simplified distance to 35 ft (per FAA standards)
-    // Typical formula: TODR = (weight / thrust) * (1/[2g * (a - f)])
-    // where a = acceleration due to engines, f = friction
-    
-    // Reference: Cessna 172 at 2700 lbs = ~1500 ft at sea level
-    double baseDistance = 1500.0 * (weightBalance.totalWeight / aircraftConfig_.maxGrossWeight);
-    
-    // Density altitude correction (approximately 3.5% per 1000 ft DA)
-    double daCorrection = 1.0 + (densityAltitude / 1000.0) * 0.035;
-    baseDistance *= daCorrection;
+    return takeoffDistance(performanceAt(weightBalance.totalWeight, environment), environment, safetyFactor);
+}
+
+double VSpeedCalculator::takeoffDistance(
+    const PerformancePoint& point,
+    const EnvironmentalFactors& environment,
+    double safetyFactor) const {
     
-    // Temperature correction (approximately 2% per 5°C above 15°C)
-    double tempCorrection = 1.0 + std::max(0.0, (environment.temperature - 15.0) / 5.0) * 0.02;
-    baseDistance *= tempCorrection;
+    double distance = point.takeoffDistance;
     
     // Surface correction
-    baseDistance /= environment.runwaySurfaceCoeff;
+    distance /= environment.runwaySurfaceCoeff;
     
     // Wind correction (headwind reduces distance, tailwind increases)
     double windCorrection = 1.0 - (environment.windHeadwind / 20.0);  // 1 kt headwind = ~0.05% reduction
-    baseDistance *= windCorrection;
+    distance *= windCorrection;
     
     // Apply FAA safety factor (typically 15% for normal operations)
-    baseDistance *= safetyFactor;
-    
-    return baseDistance;
+    return distance * safetyFactor;
 }
 
 double VSpeedCalculator::calculateLandingDistanceRequired(
@@ -142,28 +224,25 @@ double VSpeedCalculator::calculateLandingDistanceRequired(
     const EnvironmentalFactors& environment,
     double safetyFactor) {
     
-    // Landing distance calculation
-    // Reference: Cessna 172 = ~1300 ft landing distance at sea level
-    
-    double densityAltitude = calculateDensityAltitude(environment);
-    
-    double baseDistance = 1300.0 * (weightBalance.totalWeight / aircraftConfig_.maxGrossWeight);
+    return landingDistance(performanceAt(weightBalance.totalWeight, environment), environment, safetyFactor);
+}
+
+double VSpeedCalculator::landingDistance(
+    const PerformancePoint& point,
+    const EnvironmentalFactors& environment,
+    double safetyFactor) const {
     
-    // Density altitude correction (approximately 3-4% per 1000 ft DA)
-    double daCorrection = 1.0 + (densityAltitude / 1000.0) * 0.04;
-    baseDistance *= daCorrection;
+    double distance = point.landingDistance;
     
     // Runway surface correction
-    baseDistance /= environment.runwaySurfaceCoeff;
+    distance /= environment.runwaySurfaceCoeff;
     
     // Wind correction (headwind reduces landing distance significantly)
     double windCorrection = 1.0 - (environment.windHeadwind / 15.0);  // Stronger effect than takeoff
-    baseDistance *= std::max(0.5, windCorrection);  // Never less than 50% of base
+    distance *= std::max(0.5, windCorrection);  // Never less than 50% of base
     
     // Apply FAA safety factor (67% for landing per Part 25)
-    baseDistance *= safetyFactor;
-    
-    return baseDistance;
+    return distance * safetyFactor;
 }
 
 bool VSpeedCalculator::isRunwaySuitableForTakeoff(
@@ -182,8 +261,38 @@ bool VSpeedCalculator::isRunwaySuitableForLanding(
     return runwayLength > (landingDistRequired + safetyMargin);
 }
 
+void VSpeedCalculator::evaluateRunways(
+    const WeightBalance& weightBalance,
+    const EnvironmentalFactors* runways,
+    size_t count,
+    RunwayPerformance* out,
+    double takeoffSafetyFactor,
+    double landingSafetyFactor,
+    double safetyMargin) const {
+    
+    double weight = weightBalance.totalWeight;
+    PerformanceTable::AxisPosition weightPosition{};
+    if (!performanceTable_.empty()) {
+        weightPosition = performanceTable_.locateWeight(weight);
+    }
+    
+    for (size_t i = 0; i < count; ++i) {
+        const EnvironmentalFactors& runway = runways[i];
+        double densityAltitude = calculateDensityAltitude(runway);
+        PerformancePoint point = performanceTable_.empty()
+            ? computePerformance(weight, densityAltitude, runway.temperature)
+            : performanceTable_.lookup(weightPosition, densityAltitude, runway.temperature);
+        
+        RunwayPerformance& result = out[i];
+        result.takeoffDistance = takeoffDistance(point, runway, takeoffSafetyFactor);
+        result.landingDistance = landingDistance(point, runway, landingSafetyFactor);
+        result.takeoffSuitable = runway.runwayLength > result.takeoffDistance + safetyMargin;
+        result.landingSuitable = runway.runwayLength > result.landingDistance + safetyMargin;
+    }
+}
+
 double VSpeedCalculator::calculateDensityAltitude(
-    const EnvironmentalFactors& environment) {
+    const EnvironmentalFactors& environment) const {
     
     // Density altitude = pressure altitude + temp correction
     double pressureAltitude = calculatePressureAltitude(
@@ -198,7 +307,7 @@ double VSpeedCalculator::calculateDensityAltitude(
 
 double VSpeedCalculator::calculatePressureAltitude(
     double barometerSetting,
-    double fieldElevation) {
+    double fieldElevation) const {
     
     // Standard altimeter setting is 29.92 inHg
     double standardBaro = 29.92;
@@ -209,7 +318,7 @@ double VSpeedCalculator::calculatePressureAltitude(
     return pressureAltitude;
 }
 
-double VSpeedCalculator::calculateBaseStallSpeed(const WeightBalance& wb) {
+double VSpeedCalculator::calculateBaseStallSpeed(const WeightBalance& wb) const {
     // Stall speed varies with square root of weight
     // VS = VSref * sqrt(W/Wref)
     
@@ -224,7 +333,7 @@ double VSpeedCalculator::calculateBaseStallSpeed(const WeightBalance& wb) {
 }
 
 double VSpeedCalculator::applyDensityAltitudeCorrection(
-    double speed, double densityAltitude) {
+    double speed, double densityAltitude) const {
     
     // Density altitude correction increases required airspeed
     // Approximately 2% per 1000 ft density altitude
@@ -0,0 +1,454 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Hazard Grid Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/hazard_grid.hpp"
+#include "../include/geodesy.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr int CELLS = HazardGrid::CELLS_PER_DEGREE;
+constexpr int COL_OFFSET = 512;        // tile columns stored from -512
+constexpr double MIN_LON_SCALE = 0.05; // keeps footprints finite near the poles
+
+bool sameFootprint(const WeatherHazard& a, const WeatherHazard& b) {
+    return a.type == b.type && a.severity == b.severity &&
+           a.position.latitude == b.position.latitude && a.position.longitude == b.position.longitude &&
+           a.radius == b.radius && a.altitude == b.altitude && a.topAltitude == b.topAltitude;
+}
+
+// Unit cells a segment crosses, in order, with the fraction of the segment
+// inside each; fn(x, y, t0, t1) returns false to stop
+template <typename Fn>
+void walkCells(double x0, double y0, double x1, double y1, Fn&& fn) {
+    int x = static_cast<int>(std::floor(x0));
+    int y = static_cast<int>(std::floor(y0));
+    const int endX = static_cast<int>(std::floor(x1));
+    const int endY = static_cast<int>(std::floor(y1));
+    const double dx = x1 - x0;
+    const double dy = y1 - y0;
+    const int stepX = dx > 0.0 ? 1 : -1;
+    const int stepY = dy > 0.0 ? 1 : -1;
+    const double inf = std::numeric_limits<double>::infinity();
+    const double deltaX = dx != 0.0 ? std::abs(1.0 / dx) : inf;
+    const double deltaY = dy != 0.0 ? std::abs(1.0 / dy) : inf;
+    double nextX = dx > 0.0 ? (x + 1 - x0) / dx : dx < 0.0 ? (x - x0) / dx : inf;
+    double nextY = dy > 0.0 ? (y + 1 - y0) / dy : dy < 0.0 ? (y - y0) / dy : inf;
+
+    double t = 0.0;
+    int steps = std::abs(endX - x) + std::abs(endY - y);
+    for (;;) {
+        double exit = std::min({nextX, nextY, 1.0});
+        if (!fn(x, y, t, exit) || steps-- <= 0 || exit >= 1.0) return;
+        if (nextX < nextY) {
+            x += stepX;
+            t = nextX;
+            nextX += deltaX;
+        } else {
+            y += stepY;
+            t = nextY;
+            nextY += deltaY;
+        }
+    }
+}
+
+bool usablePoint(double latitude, double longitude) {
+    return std::isfinite(latitude) && std::isfinite(longitude) &&
+           std::abs(latitude) <= 90.0 && std::abs(longitude) <= 180.0;
+}
+
+} // namespace
+
+template <typename Fn>
+void HazardGrid::walkSegment(const Position& from, const Position& to, int layer, Fn&& fn) const {
+    if (tiles_.empty() || !usablePoint(from.latitude, from.longitude) ||
+        !usablePoint(to.latitude, to.longitude)) {
+        return;
+    }
+    const double dLat = to.latitude - from.latitude;
+    const double dLon = to.longitude - from.longitude;
+
+    // Tiles first, then the cells of the tiles occupied at this layer
+    bool going = true;
+    walkCells(from.longitude, from.latitude, to.longitude, to.latitude,
+              [&](int col, int row, double t0, double t1) {
+        const Tile* tile = findTile(row, col);
+        if (!tile || tile->layerMax[layer] == 0) return true;
+        walkCells((from.longitude + dLon * t0) * CELLS, (from.latitude + dLat * t0) * CELLS,
+                  (from.longitude + dLon * t1) * CELLS, (from.latitude + dLat * t1) * CELLS,
+                  [&](int x, int y, double, double) {
+            int r = y - row * CELLS;
+            int c = x - col * CELLS;
+            if (r < 0 || r >= CELLS || c < 0 || c >= CELLS) return true;  // rounding at the tile edge
+            const Voxel& voxel = tile->voxels[(layer * CELLS + r) * CELLS + c];
+            if (voxel.intensity > 0) going = fn(*tile, voxel);
+            return going;
+        });
+        return going;
+    });
+}
+
+bool HazardGridSample::has(WeatherHazardType type) const {
+    return (types & hazardTypeBit(type)) != 0;
+}
+
+uint8_t HazardGrid::intensityFor(HazardSeverity severity) {
+    switch (severity) {
+        case HazardSeverity::LIGHT: return 30;
+        case HazardSeverity::MODERATE: return 50;
+        case HazardSeverity::SEVERE: return 80;
+        case HazardSeverity::EXTREME: return 100;
+    }
+    return 50;
+}
+
+bool HazardGrid::setHazard(uint32_t id, const WeatherHazard& hazard) {
+    std::unordered_set<uint32_t> dirty;
+    bool held = false;
+    place(id, hazard, held, dirty);
+    rasterize(dirty);
+    return held;
+}
+
+bool HazardGrid::removeHazard(uint32_t id) {
+    auto it = hazards_.find(id);
+    if (it == hazards_.end()) return false;
+    std::unordered_set<uint32_t> dirty;
+    unlink(id, it->second.tiles, dirty);
+    hazards_.erase(it);
+    rasterize(dirty);
+    return true;
+}
+
+size_t HazardGrid::assign(const std::vector<WeatherHazard>& hazards) {
+    std::unordered_set<uint32_t> dirty;
+    size_t count = 0;
+    for (size_t i = 0; i < hazards.size(); ++i) {
+        bool held = false;
+        place(static_cast<uint32_t>(i), hazards[i], held, dirty);
+        if (held) count++;
+    }
+
+    std::vector<uint32_t> stale;
+    for (const auto& entry : hazards_) {
+        if (entry.first >= hazards.size()) stale.push_back(entry.first);
+    }
+    for (uint32_t id : stale) {
+        unlink(id, hazards_[id].tiles, dirty);
+        hazards_.erase(id);
+    }
+    rasterize(dirty);
+    return count;
+}
+
+void HazardGrid::clear() {
+    hazards_.clear();
+    tiles_.clear();
+}
+
+const WeatherHazard* HazardGrid::getHazard(uint32_t id) const {
+    auto it = hazards_.find(id);
+    return it == hazards_.end() ? nullptr : &it->second.hazard;
+}
+
+HazardGridSample HazardGrid::sample(double latitude, double longitude, double altitude) const {
+    HazardGridSample result;
+    if (!usablePoint(latitude, longitude)) return result;
+    int row = static_cast<int>(std::floor(latitude));
+    int col = static_cast<int>(std::floor(longitude));
+    const Tile* tile = findTile(row, col);
+    if (!tile) return result;
+
+    int layer = layerFor(altitude);
+    if (tile->layerMax[layer] == 0) return result;
+    int r = std::min(CELLS - 1, static_cast<int>((latitude - row) * CELLS));
+    int c = std::min(CELLS - 1, static_cast<int>((longitude - col) * CELLS));
+    const Voxel& voxel = tile->voxels[(layer * CELLS + r) * CELLS + c];
+    result.intensity = voxel.intensity;
+    result.types = voxel.types;
+    return result;
+}
+
+HazardGridSample HazardGrid::sampleSegment(const Position& from, const Position& to, double altitude) const {
+    HazardGridSample result;
+    walkSegment(from, to, layerFor(altitude), [&](const Tile&, const Voxel& voxel) {
+        result.intensity = std::max(result.intensity, voxel.intensity);
+        result.types |= voxel.types;
+        return true;
+    });
+    return result;
+}
+
+void HazardGrid::hazardsAt(double latitude, double longitude, double altitude,
+                           std::vector<uint32_t>& ids) const {
+    ids.clear();
+    if (!sample(latitude, longitude, altitude).any()) return;
+
+    // The cell is marked, so its tile exists; only its hazards can be here
+    const Tile* tile = findTile(static_cast<int>(std::floor(latitude)), static_cast<int>(std::floor(longitude)));
+    Position point{latitude, longitude, altitude, 0.0};
+    for (uint32_t id : tile->hazards) {
+        if (withinHazard(hazards_.at(id), point, point, altitude)) ids.push_back(id);
+    }
+    std::sort(ids.begin(), ids.end(), [&](uint32_t a, uint32_t b) {
+        int ia = intensityFor(hazards_.at(a).hazard.severity);
+        int ib = intensityFor(hazards_.at(b).hazard.severity);
+        return ia != ib ? ia > ib : a < b;
+    });
+}
+
+void HazardGrid::hazardsAlongSegment(const Position& from, const Position& to, double altitude,
+                                     std::vector<uint32_t>& ids) const {
+    ids.clear();
+    const Tile* last = nullptr;
+    walkSegment(from, to, layerFor(altitude), [&](const Tile& tile, const Voxel&) {
+        if (&tile != last) {
+            ids.insert(ids.end(), tile.hazards.begin(), tile.hazards.end());
+            last = &tile;
+        }
+        return true;
+    });
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    ids.erase(std::remove_if(ids.begin(), ids.end(), [&](uint32_t id) {
+        return !withinHazard(hazards_.at(id), from, to, altitude);
+    }), ids.end());
+}
+
+size_t HazardGrid::radarReturns(double latitude, double longitude, double rangeNM, uint8_t typeMask,
+                                std::vector<WeatherRadarReturn>& returns) const {
+    if (!usablePoint(latitude, longitude) || !(rangeNM > 0.0) || tiles_.empty()) return 0;
+    const double lonScale = std::max(std::cos(latitude * Geodesy::DEG_TO_RAD), MIN_LON_SCALE);
+    const double latSpan = rangeNM / 60.0;
+    const double lonSpan = std::min(rangeNM / (60.0 * lonScale), 180.0);
+
+    size_t added = 0;
+    int row0 = std::max(-90, static_cast<int>(std::floor(latitude - latSpan)));
+    int row1 = std::min(89, static_cast<int>(std::floor(latitude + latSpan)));
+    int col0 = static_cast<int>(std::floor(longitude - lonSpan));
+    int col1 = static_cast<int>(std::floor(longitude + lonSpan));
+    for (int row = row0; row <= row1; ++row) {
+        for (int col = col0; col <= col1; ++col) {
+            const Tile* tile = findTile(row, col);
+            if (!tile) continue;
+            int top = LAYER_COUNT - 1;
+            while (top >= 0 && tile->layerMax[top] == 0) top--;
+
+            for (int r = 0; r < CELLS; ++r) {
+                double cellLat = row + (r + 0.5) / CELLS;
+                for (int c = 0; c < CELLS; ++c) {
+                    double cellLon = col + (c + 0.5) / CELLS;
+                    double east = (cellLon - longitude) * 60.0 * lonScale;
+                    double north = (cellLat - latitude) * 60.0;
+                    if (east * east + north * north > rangeNM * rangeNM) continue;
+
+                    HazardGridSample column;
+                    int lowest = -1, highest = -1;
+                    for (int layer = 0; layer <= top; ++layer) {
+                        const Voxel& voxel = tile->voxels[(layer * CELLS + r) * CELLS + c];
+                        if (voxel.intensity == 0) continue;
+                        column.intensity = std::max(column.intensity, voxel.intensity);
+                        column.types |= voxel.types;
+                        if (lowest < 0) lowest = layer;
+                        highest = layer;
+                    }
+                    if ((column.types & typeMask) == 0) continue;
+
+                    WeatherRadarReturn ret;
+                    ret.position = Position{cellLat, cellLon, lowest * LAYER_FEET, 0.0};
+                    ret.intensity = column.intensity;
+                    ret.altitude = lowest * LAYER_FEET;
+                    ret.topHeight = (highest + 1) * LAYER_FEET;
+                    returns.push_back(ret);
+                    added++;
+                }
+            }
+        }
+    }
+    return added;
+}
+
+// Private methods
+
+uint32_t HazardGrid::tileKey(int row, int col) {
+    return (static_cast<uint32_t>(row + 90) << 10) | static_cast<uint32_t>(col + COL_OFFSET);
+}
+
+int HazardGrid::layerFor(double altitude) {
+    if (!(altitude > 0.0)) return 0;
+    return static_cast<int>(std::min<double>(LAYER_COUNT - 1, std::floor(altitude / LAYER_FEET)));
+}
+
+bool HazardGrid::prepare(const WeatherHazard& hazard, Entry& entry) {
+    const Position& centre = hazard.position;
+    if (!usablePoint(centre.latitude, centre.longitude) ||
+        !(hazard.radius > 0.0 && hazard.radius <= MAX_RADIUS_NM)) {
+        return false;
+    }
+
+    entry.hazard = hazard;
+    entry.lonScale = std::max(std::cos(centre.latitude * Geodesy::DEG_TO_RAD), MIN_LON_SCALE);
+    const double latSpan = hazard.radius / 60.0;
+    const double lonSpan = hazard.radius / (60.0 * entry.lonScale);
+    TileRange& tiles = entry.tiles;
+    tiles.row0 = std::max(-90, static_cast<int>(std::floor(centre.latitude - latSpan)));
+    tiles.row1 = std::min(89, static_cast<int>(std::floor(centre.latitude + latSpan)));
+    tiles.col0 = static_cast<int>(std::floor(centre.longitude - lonSpan));
+    tiles.col1 = static_cast<int>(std::floor(centre.longitude + lonSpan));
+    if ((tiles.row1 - tiles.row0 + 1) * (tiles.col1 - tiles.col0 + 1) > MAX_TILES_PER_HAZARD) {
+        return false;
+    }
+
+    // The same band test as route planning: no vertical extent means all of them
+    if (hazard.topAltitude > hazard.altitude) {
+        entry.layer0 = layerFor(hazard.altitude);
+        entry.layer1 = layerFor(hazard.topAltitude);
+    } else {
+        entry.layer0 = 0;
+        entry.layer1 = LAYER_COUNT - 1;
+    }
+    return true;
+}
+
+bool HazardGrid::withinHazard(const Entry& entry, const Position& from, const Position& to, double altitude) {
+    const WeatherHazard& hazard = entry.hazard;
+    if (hazard.topAltitude > hazard.altitude &&
+        (altitude < hazard.altitude || altitude > hazard.topAltitude)) {
+        return false;
+    }
+
+    // Closest approach on a flat plane around the hazard
+    const double scale = 60.0 * entry.lonScale;
+    double ax = (from.longitude - hazard.position.longitude) * scale;
+    double ay = (from.latitude - hazard.position.latitude) * 60.0;
+    double dx = (to.longitude - from.longitude) * scale;
+    double dy = (to.latitude - from.latitude) * 60.0;
+    double lengthSquared = dx * dx + dy * dy;
+    double t = lengthSquared > 0.0 ? std::clamp(-(ax * dx + ay * dy) / lengthSquared, 0.0, 1.0) : 0.0;
+    double ex = ax + t * dx;
+    double ey = ay + t * dy;
+    return ex * ex + ey * ey < hazard.radius * hazard.radius;
+}
+
+void HazardGrid::place(uint32_t id, const WeatherHazard& hazard, bool& held,
+                       std::unordered_set<uint32_t>& dirty) {
+    auto it = hazards_.find(id);
+    Entry entry;
+    held = prepare(hazard, entry);
+    if (!held) {
+        if (it != hazards_.end()) {
+            unlink(id, it->second.tiles, dirty);
+            hazards_.erase(it);
+        }
+        return;
+    }
+
+    if (it != hazards_.end()) {
+        if (sameFootprint(it->second.hazard, hazard)) {
+            it->second.hazard = hazard;
+            return;
+        }
+        unlink(id, it->second.tiles, dirty);
+        it->second = entry;
+    } else {
+        hazards_.emplace(id, entry);
+    }
+
+    for (int row = entry.tiles.row0; row <= entry.tiles.row1; ++row) {
+        for (int col = entry.tiles.col0; col <= entry.tiles.col1; ++col) {
+            uint32_t key = tileKey(row, col);
+            tiles_[key].hazards.push_back(id);
+            dirty.insert(key);
+        }
+    }
+}
+
+void HazardGrid::unlink(uint32_t id, const TileRange& tiles, std::unordered_set<uint32_t>& dirty) {
+    for (int row = tiles.row0; row <= tiles.row1; ++row) {
+        for (int col = tiles.col0; col <= tiles.col1; ++col) {
+            uint32_t key = tileKey(row, col);
+            auto it = tiles_.find(key);
+            if (it == tiles_.end()) continue;
+            auto& ids = it->second.hazards;
+            ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+            dirty.insert(key);
+        }
+    }
+}
+
+void HazardGrid::rasterize(const std::unordered_set<uint32_t>& dirty) {
+    for (uint32_t key : dirty) {
+        auto it = tiles_.find(key);
+        if (it == tiles_.end()) continue;
+        if (it->second.hazards.empty()) {
+            tiles_.erase(it);
+        } else {
+            rasterizeTile(key, it->second);
+        }
+    }
+}
+
+void HazardGrid::rasterizeTile(uint32_t key, Tile& tile) const {
+    const int row = static_cast<int>(key >> 10) - 90;
+    const int col = static_cast<int>(key & 0x3FF) - COL_OFFSET;
+    tile.voxels.assign(static_cast<size_t>(CELLS_PER_TILE) * LAYER_COUNT, Voxel());
+    tile.layerMax.fill(0);
+
+    for (uint32_t id : tile.hazards) {
+        const Entry& entry = hazards_.at(id);
+        const WeatherHazard& hazard = entry.hazard;
+        const double lat = hazard.position.latitude;
+        const double lon = hazard.position.longitude;
+        const double latSpan = hazard.radius / 60.0;
+        const double lonSpan = hazard.radius / (60.0 * entry.lonScale);
+        const double peak = intensityFor(hazard.severity);
+        const uint8_t bit = hazardTypeBit(hazard.type);
+
+        // Cells of this tile under the hazard's bounds
+        int r0 = std::max(0, static_cast<int>(std::floor((lat - latSpan - row) * CELLS)));
+        int r1 = std::min(CELLS - 1, static_cast<int>(std::floor((lat + latSpan - row) * CELLS)));
+        int c0 = std::max(0, static_cast<int>(std::floor((lon - lonSpan - col) * CELLS)));
+        int c1 = std::min(CELLS - 1, static_cast<int>(std::floor((lon + lonSpan - col) * CELLS)));
+        for (int r = r0; r <= r1; ++r) {
+            double south = row + static_cast<double>(r) / CELLS;
+            double north = (std::clamp(lat, south, south + 1.0 / CELLS) - lat) * 60.0;
+            for (int c = c0; c <= c1; ++c) {
+                // Nearest point of the cell to the centre decides whether the disc touches it
+                double west = col + static_cast<double>(c) / CELLS;
+                double east = (std::clamp(lon, west, west + 1.0 / CELLS) - lon) * 60.0 * entry.lonScale;
+                double distance = std::sqrt(north * north + east * east);
+                if (distance >= hazard.radius) continue;
+
+                double taper = 1.0 - (1.0 - EDGE_INTENSITY_FRACTION) * distance / hazard.radius;
+                uint8_t intensity = static_cast<uint8_t>(std::max(1.0, std::round(peak * taper)));
+                for (int layer = entry.layer0; layer <= entry.layer1; ++layer) {
+                    Voxel& voxel = tile.voxels[(layer * CELLS + r) * CELLS + c];
+                    voxel.intensity = std::max(voxel.intensity, intensity);
+                    voxel.types |= bit;
+                    tile.layerMax[layer] = std::max(tile.layerMax[layer], intensity);
+                }
+            }
+        }
+    }
+}
+
+const HazardGrid::Tile* HazardGrid::findTile(int row, int col) const {
+    if (row < -90 || row > 89 || col < -COL_OFFSET || col >= COL_OFFSET) return nullptr;
+    auto it = tiles_.find(tileKey(row, col));
+    return it == tiles_.end() ? nullptr : &it->second;
+}
+
+} // namespace AICopilot
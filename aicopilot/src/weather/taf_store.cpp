@@ -0,0 +1,442 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* TAF Store Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/taf_store.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr int64_t SECONDS_PER_DAY = 86400;
+
+// Days since 1970-01-01 of a proleptic Gregorian date
+int64_t daysFromCivil(int64_t year, int month, int day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+void civilFromDays(int64_t days, int64_t& year, int& month) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t shifted = (5 * dayOfYear + 2) / 153;
+    month = static_cast<int>(shifted < 10 ? shifted + 3 : shifted - 9);
+    year = yearOfEra + era * 400 + (month <= 2);
+}
+
+int daysInMonth(int64_t year, int month) {
+    return static_cast<int>(daysFromCivil(month == 12 ? year + 1 : year, month == 12 ? 1 : month + 1, 1) -
+                            daysFromCivil(year, month, 1));
+}
+
+// The day-of-month time nearest to reference, looking one month either side
+time_t resolveTime(int day, int hour, int minute, time_t reference) {
+    int64_t refDays = static_cast<int64_t>(reference) / SECONDS_PER_DAY - (reference < 0 ? 1 : 0);
+    int64_t year;
+    int month;
+    civilFromDays(refDays, year, month);
+
+    int64_t best = 0;
+    bool found = false;
+    for (int offset = -1; offset <= 1; ++offset) {
+        int m = month + offset;
+        int64_t y = year;
+        if (m < 1) { m = 12; --y; }
+        if (m > 12) { m = 1; ++y; }
+        if (day > daysInMonth(y, m)) continue;
+        int64_t t = daysFromCivil(y, m, day) * SECONDS_PER_DAY + hour * 3600 + minute * 60;
+        if (!found || std::llabs(t - reference) < std::llabs(best - reference)) {
+            best = t;
+            found = true;
+        }
+    }
+    return static_cast<time_t>(best);
+}
+
+bool twoDigits(std::string_view t, size_t at, int& value) {
+    if (!METARSyntax::isDigit(t[at]) || !METARSyntax::isDigit(t[at + 1])) return false;
+    value = (t[at] - '0') * 10 + (t[at + 1] - '0');
+    return true;
+}
+
+// DDHH/DDHH; hour 24 is the end of the day
+bool decodePeriod(std::string_view t, time_t reference, time_t& from, time_t& to) {
+    int d1, h1, d2, h2;
+    if (t.size() != 9 || t[4] != '/' || !twoDigits(t, 0, d1) || !twoDigits(t, 2, h1) || !twoDigits(t, 5, d2) ||
+        !twoDigits(t, 7, h2) || d1 < 1 || d1 > 31 || d2 < 1 || d2 > 31 || h1 > 24 || h2 > 24) {
+        return false;
+    }
+    from = resolveTime(d1, h1, 0, reference);
+    to = resolveTime(d2, h2, 0, from);
+    return to > from;
+}
+
+// FMDDHHMM
+bool decodeFrom(std::string_view t, time_t reference, time_t& from) {
+    int day, hour, minute;
+    if (t.size() != 8 || t[0] != 'F' || t[1] != 'M' || !twoDigits(t, 2, day) || !twoDigits(t, 4, hour) ||
+        !twoDigits(t, 6, minute) || day < 1 || day > 31 || hour > 24 || minute > 59) {
+        return false;
+    }
+    from = resolveTime(day, hour, minute, reference);
+    return true;
+}
+
+enum class GroupKind : uint8_t { BASE, FROM, BECOMING, TEMPORARY, PROBABLE };
+
+// One forecast group: its body decoded as a METAR body, and which
+// elements it states
+struct Group {
+    GroupKind kind = GroupKind::BASE;
+    time_t from = 0;
+    time_t to = 0;
+    uint8_t probability = 0;
+    bool temporary = false;     // PROBnn TEMPO
+    std::string body;
+
+    METARObservation observation;
+    bool wind = false;
+    bool visibility = false;
+    bool weather = false;
+    bool clouds = false;
+};
+
+void decodeBody(std::string_view station, Group& group) {
+    std::string text(station);
+    text += " 010000Z ";
+    text += group.body;
+    if (!METARParser::parse(text, group.observation)) group.observation = METARObservation();
+
+    bool noWeather = false, skyClear = false;
+    METARTokenizer tokens(group.body);
+    std::string_view token;
+    while (tokens.next(token)) {
+        noWeather = noWeather || token == "NSW";
+        skyClear = skyClear || METARParser::classifyToken(token) == METARTokenType::SKY_CLEAR;
+    }
+    const METARObservation& o = group.observation;
+    group.wind = o.hasWind;
+    group.visibility = o.hasVisibility || o.cavok;
+    group.weather = o.weatherCount > 0 || noWeather || o.cavok;
+    group.clouds = o.cloudCount > 0 || o.verticalVisibilityFeet >= 0 || skyClear || o.cavok;
+}
+
+// conditions with the elements the group states replaced by the group's
+METARObservation apply(const METARObservation& conditions, const Group& group) {
+    const METARObservation& g = group.observation;
+    METARObservation result = conditions;
+    if (group.wind) {
+        result.hasWind = true;
+        result.windVariable = g.windVariable;
+        result.windDirection = g.windDirection;
+        result.windSpeed = g.windSpeed;
+        result.windGust = g.windGust;
+        result.variableMinDir = g.variableMinDir;
+        result.variableMaxDir = g.variableMaxDir;
+    }
+    if (group.visibility) {
+        result.hasVisibility = g.hasVisibility || g.cavok;
+        result.visibilitySM = g.visibilitySM;
+        result.cavok = g.cavok;
+    } else if ((group.weather && g.weatherCount > 0) || (group.clouds && g.cloudCount > 0)) {
+        result.cavok = false;
+    }
+    if (group.weather) {
+        result.weather = g.weather;
+        result.weatherCount = g.weatherCount;
+    }
+    if (group.clouds) {
+        result.clouds = g.clouds;
+        result.cloudCount = g.cloudCount;
+        result.verticalVisibilityFeet = g.verticalVisibilityFeet;
+    }
+    result.truncated = result.truncated || g.truncated;
+    return result;
+}
+
+StationSummary summarize(const METARObservation& conditions) {
+    // TAFs carry no remarks or observed temperatures; the summary reads
+    // the standard day, as for a METAR without them
+    return summarizeObservation(conditions, std::string_view());
+}
+
+bool samePeriod(const TAFPeriod& a, const TAFPeriod& b) {
+    return a.prevailing == b.prevailing && a.worst == b.worst && a.changes == b.changes &&
+           a.probability == b.probability;
+}
+
+} // namespace
+
+StationSummary worstOf(const StationSummary& a, const StationSummary& b) {
+    using namespace StationFlags;
+    constexpr uint16_t SUITABILITY = FLIGHT_OK | TAKEOFF_OK | LANDING_OK | VFR_OK | IFR_OK | LANDING_MINIMUMS_OK;
+    StationSummary worst;
+    worst.flags = static_cast<uint16_t>((a.flags & b.flags & SUITABILITY) | ((a.flags | b.flags) & ~SUITABILITY));
+    worst.category = std::min(a.category, b.category);
+    worst.precipitation = a.precipitation ? a.precipitation : b.precipitation;
+    worst.ceilingHundredsFeet = std::min(a.ceilingHundredsFeet, b.ceilingHundredsFeet);
+    worst.visibilityQuarterSM = std::min(a.visibilityQuarterSM, b.visibilityQuarterSM);
+    worst.windKnots = std::max(a.windKnots, b.windKnots);
+    worst.gustKnots = std::max(a.gustKnots, b.gustKnots);
+    return worst;
+}
+
+const TAFPeriod* TAFForecast::at(time_t t) const {
+    if (periods.empty() || t < periods.front().from || t >= periods.back().to) return nullptr;
+    auto it = std::upper_bound(periods.begin(), periods.end(), t,
+                               [](time_t value, const TAFPeriod& period) { return value < period.from; });
+    return &*(it - 1);
+}
+
+bool TAFForecast::worstBetween(time_t from, time_t to, StationSummary& worst) const {
+    if (periods.empty()) return false;
+    if (to <= from) to = from + 1;
+    from = std::max(from, periods.front().from);
+    const TAFPeriod* first = at(from);
+    if (!first || from >= to) return false;
+
+    worst = first->worst;
+    for (const TAFPeriod* p = first + 1; p != periods.data() + periods.size() && p->from < to; ++p) {
+        worst = worstOf(worst, p->worst);
+    }
+    return true;
+}
+
+bool TAFStore::decode(std::string_view text, StationKey& station, TAFForecast& forecast, time_t reference) {
+    forecast = TAFForecast();
+    METARTokenizer tokens(text);
+    std::string_view token;
+    bool ok = tokens.next(token);
+    while (ok && (token == "TAF" || token == "AMD" || token == "COR")) ok = tokens.next(token);
+    std::string_view icao = token;
+    int day = 0, hour = 0, minute = 0;
+    if (!ok || !METARSyntax::isStationId(icao) || !tokens.next(token) ||
+        !METARSyntax::decodeDateTime(token, day, hour, minute)) {
+        return false;
+    }
+    station = packStationId(icao);
+    forecast.issuedAt = resolveTime(day, hour, minute, reference);
+    if (!tokens.next(token) || !decodePeriod(token, forecast.issuedAt, forecast.validFrom, forecast.validTo)) {
+        return false;
+    }
+
+    // Split the rest into groups at each change indicator
+    std::vector<Group> groups(1);
+    groups[0].from = forecast.validFrom;
+    groups[0].to = forecast.validTo;
+    while (tokens.next(token)) {
+        if (token == "RMK") break;
+        if (token == "NIL" || token == "CNL") return false;
+        Group& current = groups.back();
+        time_t from = 0, to = 0;
+        bool awaitingPeriod = (current.kind == GroupKind::BECOMING || current.kind == GroupKind::TEMPORARY ||
+                               current.kind == GroupKind::PROBABLE) && current.to == 0;
+        if (awaitingPeriod && current.kind == GroupKind::PROBABLE && token == "TEMPO") {
+            current.temporary = true;
+        } else if (awaitingPeriod) {
+            if (!decodePeriod(token, forecast.validFrom, from, to)) return false;
+            current.from = from;
+            current.to = to;
+        } else if (decodeFrom(token, forecast.validFrom, from)) {
+            groups.emplace_back();
+            groups.back().kind = GroupKind::FROM;
+            groups.back().from = from;
+            groups.back().to = forecast.validTo;
+        } else if (token == "BECMG" || token == "TEMPO") {
+            groups.emplace_back();
+            groups.back().kind = token == "BECMG" ? GroupKind::BECOMING : GroupKind::TEMPORARY;
+        } else if (token.size() == 6 && token.substr(0, 4) == "PROB" && METARSyntax::isDigit(token[4]) &&
+                   METARSyntax::isDigit(token[5])) {
+            groups.emplace_back();
+            groups.back().kind = GroupKind::PROBABLE;
+            groups.back().probability = static_cast<uint8_t>((token[4] - '0') * 10 + (token[5] - '0'));
+        } else if (token.size() > 2 && (token.substr(0, 2) == "TX" || token.substr(0, 2) == "TN")) {
+            continue;   // Forecast temperature extremes
+        } else {
+            if (!current.body.empty()) current.body += ' ';
+            current.body.append(token.data(), token.size());
+        }
+    }
+    if (groups.back().to == 0) return false;   // Change indicator without its period
+
+    // One line, single spaces
+    METARTokenizer words(text);
+    while (words.next(token)) {
+        if (!forecast.text.empty()) forecast.text += ' ';
+        forecast.text.append(token.data(), token.size());
+    }
+
+    std::vector<time_t> cuts{forecast.validFrom, forecast.validTo};
+    for (Group& group : groups) {
+        decodeBody(icao, group);
+        group.from = std::clamp(group.from, forecast.validFrom, forecast.validTo);
+        group.to = std::clamp(group.to, forecast.validFrom, forecast.validTo);
+        cuts.push_back(group.from);
+        cuts.push_back(group.to);
+    }
+    std::sort(cuts.begin(), cuts.end());
+    cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+    for (size_t i = 0; i + 1 < cuts.size(); ++i) {
+        TAFPeriod period;
+        period.from = cuts[i];
+        period.to = cuts[i + 1];
+
+        // Prevailing conditions: groups in order, each FM from its start and
+        // each BECMG once its transition is over
+        METARObservation prevailing = groups[0].observation;
+        std::vector<METARObservation> transitions;
+        for (size_t g = 1; g < groups.size(); ++g) {
+            const Group& group = groups[g];
+            if (group.kind == GroupKind::FROM && group.from <= period.from) {
+                prevailing = apply(prevailing, group);
+                transitions.clear();
+            } else if (group.kind == GroupKind::BECOMING && group.to <= period.from) {
+                prevailing = apply(prevailing, group);
+            } else if (group.kind == GroupKind::BECOMING && group.from <= period.from) {
+                transitions.push_back(apply(prevailing, group));
+            }
+        }
+        period.prevailing = summarize(prevailing);
+        period.worst = period.prevailing;
+        for (const METARObservation& after : transitions) {
+            period.worst = worstOf(period.worst, summarize(after));
+            period.changes |= TAFChange::BECOMING;
+        }
+
+        // Temporary and probable conditions on top
+        for (const Group& group : groups) {
+            bool overlay = group.kind == GroupKind::TEMPORARY || group.kind == GroupKind::PROBABLE;
+            if (!overlay || group.from > period.from || group.to <= period.from) continue;
+            period.worst = worstOf(period.worst, summarize(apply(prevailing, group)));
+            if (group.kind == GroupKind::PROBABLE) {
+                period.changes |= TAFChange::PROBABLE;
+                period.probability = std::max(period.probability, group.probability);
+            }
+            if (group.kind == GroupKind::TEMPORARY || group.temporary) period.changes |= TAFChange::TEMPORARY;
+        }
+
+        if (!forecast.periods.empty() && samePeriod(forecast.periods.back(), period)) {
+            forecast.periods.back().to = period.to;
+        } else {
+            forecast.periods.push_back(period);
+        }
+    }
+    return station != INVALID_STATION;
+}
+
+bool TAFStore::storeLocked(StationKey station, TAFForecast&& forecast) {
+    auto it = forecasts_.find(station);
+    if (it != forecasts_.end()) {
+        if (it->second.issuedAt > forecast.issuedAt) return false;
+        it->second = std::move(forecast);
+        return true;
+    }
+    forecasts_.emplace(station, std::move(forecast));
+    return true;
+}
+
+bool TAFStore::update(std::string_view text, time_t now) {
+    StationKey station = INVALID_STATION;
+    TAFForecast forecast;
+    if (!decode(text, station, forecast, now) || forecast.validTo <= now) return false;
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return storeLocked(station, std::move(forecast));
+}
+
+void TAFStore::publish(Batch batch) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    for (auto& entry : batch) {
+        storeLocked(entry.first, std::move(entry.second));
+    }
+}
+
+bool TAFStore::erase(const std::string& icao) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return forecasts_.erase(packStationId(icao)) != 0;
+}
+
+void TAFStore::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    forecasts_.clear();
+}
+
+size_t TAFStore::purgeExpired(time_t now) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    size_t purged = 0;
+    for (auto it = forecasts_.begin(); it != forecasts_.end();) {
+        if (it->second.validTo <= now) {
+            it = forecasts_.erase(it);
+            ++purged;
+        } else {
+            ++it;
+        }
+    }
+    return purged;
+}
+
+size_t TAFStore::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return forecasts_.size();
+}
+
+bool TAFStore::get(const std::string& icao, TAFForecast& forecast) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = forecasts_.find(packStationId(icao));
+    if (it == forecasts_.end()) return false;
+    forecast = it->second;
+    return true;
+}
+
+bool TAFStore::forecastAt(const std::string& icao, time_t time, TAFPeriod& period) const {
+    return forecastAt(packStationId(icao), time, period);
+}
+
+bool TAFStore::forecastAt(StationKey station, time_t time, TAFPeriod& period) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = forecasts_.find(station);
+    const TAFPeriod* found = it != forecasts_.end() ? it->second.at(time) : nullptr;
+    if (!found) return false;
+    period = *found;
+    return true;
+}
+
+bool TAFStore::worstBetween(StationKey station, time_t from, time_t to, StationSummary& worst) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = forecasts_.find(station);
+    return it != forecasts_.end() && it->second.worstBetween(from, to, worst);
+}
+
+size_t TAFStore::forecastsAt(const std::vector<Query>& queries, std::vector<TAFPeriod>& periods) const {
+    periods.assign(queries.size(), TAFPeriod());
+    size_t covered = 0;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto it = forecasts_.find(queries[i].station);
+        const TAFPeriod* found = it != forecasts_.end() ? it->second.at(queries[i].time) : nullptr;
+        if (found) {
+            periods[i] = *found;
+            ++covered;
+        }
+    }
+    return covered;
+}
+
+} // namespace AICopilot
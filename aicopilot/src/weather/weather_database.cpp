@@ -5,6 +5,7 @@
 *****************************************************************************/
 
 #include "../include/weather_database.hpp"
+#include "../include/io_executor.hpp"
 #include <sstream>
 #include <iostream>
 #include <fstream>
@@ -13,21 +14,235 @@
 #include <ctime>
 #include <iomanip>
 #include <cmath>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace AICopilot {
 
-WeatherDatabase::WeatherDatabase() = default;
+namespace {
+
+// Read-only view of a whole file, memory-mapped for the lifetime of the object
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            return false;
+        }
+        size_ = static_cast<size_t>(size.QuadPart);
+        if (size_ == 0) {
+            CloseHandle(file);
+            return true;
+        }
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);  // the mapping keeps the file referenced
+        if (mapping == nullptr) {
+            size_ = 0;
+            return false;
+        }
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);  // the view keeps the mapping alive
+        if (view == nullptr) {
+            size_ = 0;
+            return false;
+        }
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ == 0) {
+            ::close(fd);
+            return true;
+        }
+        void* view = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);  // the mapping keeps the file referenced
+        if (view == MAP_FAILED) {
+            size_ = 0;
+            return false;
+        }
+        madvise(view, size_, MADV_SEQUENTIAL);
+#endif
+        data_ = static_cast<const char*>(view);
+        return true;
+    }
+
+    std::string_view text() const { return data_ ? std::string_view(data_, size_) : std::string_view(); }
+    size_t size() const { return size_; }
+
+private:
+    void close() {
+        if (data_ != nullptr) {
+#ifdef _WIN32
+            UnmapViewOfFile(data_);
+#else
+            munmap(const_cast<char*>(data_), size_);
+#endif
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Split at line starts, about chunkBytes apiece; with continuations, a
+// line that starts with a blank stays with the record above it
+std::vector<std::string_view> splitChunks(std::string_view text, size_t chunkBytes, bool continuations) {
+    std::vector<std::string_view> chunks;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = start + chunkBytes;
+        while (end < text.size()) {
+            size_t newline = text.find('\n', end);
+            if (newline == std::string_view::npos) {
+                end = text.size();
+                break;
+            }
+            end = newline + 1;
+            if (!continuations || end >= text.size() || !isBlank(text[end])) break;
+        }
+        end = std::min(end, text.size());
+        chunks.push_back(text.substr(start, end - start));
+        start = end;
+    }
+    return chunks;
+}
+
+// Call record(report, columns) for each report in a chunk: one line, or
+// with continuations a line plus the indented lines after it. Blank lines
+// and '#' comments are skipped; in CSV the raw report is the first column
+// and columns is the rest of the line (empty otherwise).
+template <typename Record>
+void forEachRecord(std::string_view chunk, bool continuations, Record&& record) {
+    size_t pos = 0;
+    while (pos < chunk.size()) {
+        size_t end = chunk.find('\n', pos);
+        if (end == std::string_view::npos) end = chunk.size();
+        while (continuations && end + 1 < chunk.size() && isBlank(chunk[end + 1])) {
+            size_t next = chunk.find('\n', end + 1);
+            end = next == std::string_view::npos ? chunk.size() : next;
+        }
+        std::string_view line = chunk.substr(pos, end - pos);
+        std::string_view columns;
+        pos = end + 1;
+
+        size_t comma = line.find(',');
+        if (comma != std::string_view::npos) {
+            columns = line.substr(comma + 1);
+            line = line.substr(0, comma);
+            if (line.size() >= 2 && line.front() == '"' && line.back() == '"') {
+                line = line.substr(1, line.size() - 2);
+            }
+        }
+        while (!line.empty() && (isBlank(line.front()) || line.front() == '\n')) line.remove_prefix(1);
+        while (!line.empty() && (isBlank(line.back()) || line.back() == '\n')) line.remove_suffix(1);
+        if (line.empty() || line.front() == '#') continue;
+        record(line, columns);
+    }
+}
+
+// Number in the given column of columns (0 is the one after raw_text)
+bool csvNumber(std::string_view columns, size_t index, double& value) {
+    for (size_t i = 0; i < index; ++i) {
+        size_t comma = columns.find(',');
+        if (comma == std::string_view::npos) return false;
+        columns.remove_prefix(comma + 1);
+    }
+    columns = columns.substr(0, columns.find(','));
+    char buffer[32];
+    if (columns.empty() || columns.size() >= sizeof(buffer)) return false;
+    columns.copy(buffer, columns.size());
+    buffer[columns.size()] = '\0';
+    char* end = nullptr;
+    value = std::strtod(buffer, &end);
+    return end != buffer && std::isfinite(value);
+}
+
+// Run job(0..count-1) on the pool, or inline without one, and wait for just those jobs
+void parallelFor(WorkStealingPool* pool, size_t count, const std::function<void(size_t)>& job) {
+    if (pool == nullptr || count < 2) {
+        for (size_t i = 0; i < count; ++i) job(i);
+        return;
+    }
+    std::mutex mutex;
+    std::condition_variable done;
+    size_t remaining = count;
+    for (size_t i = 0; i < count; ++i) {
+        pool->submit([&, i] {
+            job(i);
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--remaining == 0) done.notify_one();
+        });
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return remaining == 0; });
+}
+
+// NOAA cache CSV: raw_text,station_id,observation_time,latitude,longitude,...
+constexpr size_t NOAA_LATITUDE_COLUMN = 2;
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+WeatherDatabase::WeatherDatabase()
+    : store_(std::make_shared<WeatherStationStore>()),
+      interpolator_(std::make_shared<WeatherInterpolator>(store_)),
+      tafStore_(std::make_shared<TAFStore>()) {}
 
 WeatherDatabase::~WeatherDatabase() {
     shutdown();
 }
 
 bool WeatherDatabase::initialize(const std::string& cacheFile) {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    reportCache_.clear();
+    clearCache();
     
     if (!cacheFile.empty()) {
-        int loaded = loadMETARsFromFile(cacheFile);
+        int loaded = loadSnapshot(cacheFile);
+        if (loaded < 0) {
+            loaded = loadMETARsFromFile(cacheFile);
+        }
         std::cout << "WeatherDatabase: Loaded " << loaded << " METAR reports from cache" << std::endl;
     }
     
@@ -35,138 +250,41 @@ bool WeatherDatabase::initialize(const std::string& cacheFile) {
 }
 
 void WeatherDatabase::shutdown() {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    reportCache_.clear();
+    stopSnapshotWriter();
+    clearCache();
 }
 
 METARReport WeatherDatabase::parseMETAR(const std::string& metarString) {
-    METARReport report;
+    METARReport report{};
     report.isValid = false;
     report.observationTime = std::time(nullptr);
-    report.windGust = 0;
-    report.windVariable = false;
-    report.thunderstorm = false;
-    report.precipitation = false;
-    report.icing = false;
-    report.lowVisibility = false;
-    report.ceilingFeet = 10000;  // Default no ceiling
-    
-    // Tokenize METAR string
-    std::istringstream iss(metarString);
-    std::string token;
-    std::vector<std::string> tokens;
+    report.visibility = static_cast<int>(Visibility::MAX_VISIBILITY_SM);
+    report.altimeterSetting = 29.92;
+    report.ceilingFeet = METARObservation::NO_CEILING_FEET;
     
-    while (iss >> token) {
-        tokens.push_back(token);
-    }
-    
-    if (tokens.empty()) {
-        report.parseError = "Empty METAR string";
+    METARObservation observation;
+    if (!METARParser::parse(metarString, observation)) {
+        report.parseError = observation.error;
         return report;
     }
     
-    try {
-        size_t i = 0;
-        
-        // Station ID (required)
-        if (i < tokens.size()) {
-            if (!parseStationId(tokens[i], report)) {
-                report.parseError = "Invalid station ID";
-                return report;
-            }
-            i++;
-        }
-        
-        // Date/Time (required)
-        if (i < tokens.size()) {
-            if (!parseDateTime(tokens[i], report)) {
-                report.parseError = "Invalid date/time";
-                return report;
-            }
-            i++;
-        }
-        
-        // Wind (required)
-        if (i < tokens.size()) {
-            parseWind(tokens[i], report);
-            i++;
-        }
-        
-        // Parse remaining tokens
-        while (i < tokens.size()) {
-            const std::string& tok = tokens[i];
-            
-            // Handle RMK (remarks) section
-            if (tok == "RMK") {
-                i++;
-                while (i < tokens.size()) {
-                    parseRemarks(tokens[i], report);
-                    i++;
-                }
-                break;
-            }
-            
-            // Try parsing each section
-            if (parseVisibility(tok, report)) {
-                i++;
-            } else if (parseWeatherPhenomena(tok, report)) {
-                i++;
-            } else if (parseCloudLayer(tok, report)) {
-                i++;
-            } else if (parseTemperatureDewpoint(tok, report)) {
-                i++;
-            } else if (parseAltimeter(tok, report)) {
-                i++;
-            } else {
-                // Unknown token, skip it
-                i++;
-            }
-        }
-        
-        // Derive conditions from parsed data
-        deriveConditions(report);
-        
-        report.isValid = true;
-        return report;
-        
-    } catch (const std::exception& e) {
-        report.parseError = std::string("Parse exception: ") + e.what();
-        return report;
-    }
+    fillReport(observation, metarString, report);
+    report.isValid = true;
+    return report;
 }
 
 bool WeatherDatabase::updateWeather(const std::string& icao, const std::string& metarString) {
-    METARReport report = parseMETAR(metarString);
-    if (!report.isValid) {
-        return false;
-    }
-    
-    report.stationId = icao;
-    
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    CachedReport cached;
-    cached.report = report;
-    cached.cacheTime = std::time(nullptr);
-    reportCache_[icao] = cached;
-    
-    return true;
+    return store_->update(icao, metarString, CACHE_TTL_SECONDS);
 }
 
 bool WeatherDatabase::getWeather(const std::string& icao, METARReport& report) {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    
-    auto it = reportCache_.find(icao);
-    if (it == reportCache_.end()) {
-        return false;
-    }
-    
-    if (isExpired(it->second)) {
-        reportCache_.erase(it);
-        return false;
-    }
-    
-    report = it->second.report;
-    return true;
+    return store_->visit(icao, [&](const WeatherStationStore::Report& stored) {
+        report = METARReport{};
+        fillReport(stored.observation, stored.text, report);
+        report.stationId = icao;
+        report.observationTime = stored.storedAt;
+        report.isValid = true;
+    });
 }
 
 WeatherConditions WeatherDatabase::getConditions(const METARReport& report) {
@@ -178,8 +296,10 @@ WeatherConditions WeatherDatabase::getConditions(const METARReport& report) {
     
     // Calculate cloud base (ceiling)
     conditions.cloudBase = report.ceilingFeet;
+    conditions.ceiling = report.ceilingFeet;
     
     conditions.temperature = report.temperature;
+    conditions.dewpoint = report.dewpoint;
     conditions.icing = report.icing;
     conditions.turbulence = report.windSpeed > 25;  // Rough estimate
     conditions.precipitation = report.precipitation;
@@ -216,375 +336,588 @@ bool WeatherDatabase::isSuitableForLanding(const METARReport& report) {
 }
 
 int WeatherDatabase::loadMETARsFromFile(const std::string& filepath) {
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
+    return ingestMETARFile(filepath).accepted;
+}
+
+WeatherDatabase::IngestResult WeatherDatabase::ingestMETARFile(const std::string& filepath) {
+    IngestResult result;
+    auto start = std::chrono::steady_clock::now();
+    
+    MappedFile file;
+    if (!file.open(filepath)) {
         std::cerr << "WeatherDatabase: Cannot open file: " << filepath << std::endl;
-        return 0;
-    }
-    
-    int count = 0;
-    std::string line;
-    
-    while (std::getline(file, line)) {
-        if (line.empty() || line[0] == '#') continue;  // Skip comments
-        
-        METARReport report = parseMETAR(line);
-        if (report.isValid) {
-            std::lock_guard<std::mutex> lock(cacheMutex_);
-            CachedReport cached;
-            cached.report = report;
-            cached.cacheTime = std::time(nullptr);
-            reportCache_[report.stationId] = cached;
-            count++;
+        return result;
+    }
+    result.bytes = file.size();
+    
+    std::shared_ptr<WorkStealingPool> pool = ingestPool(file.size());
+    size_t chunkBytes = pool ? std::max(INGEST_CHUNK_BYTES, file.size() / (pool->getThreadCount() * 4) + 1)
+                             : file.size() + 1;
+    std::vector<std::string_view> chunks = splitChunks(file.text(), chunkBytes, false);
+    result.chunks = chunks.size();
+    
+    // Each chunk decodes into its own list of store-ready reports
+    time_t now = std::time(nullptr);
+    using Entry = std::pair<StationKey, WeatherStationStore::Report>;
+    std::vector<std::vector<Entry>> parsed(chunks.size());
+    std::vector<std::vector<StationPosition>> positions(chunks.size());
+    std::vector<int> rejected(chunks.size(), 0);
+    parallelFor(pool.get(), chunks.size(), [&](size_t c) {
+        Entry entry;
+        forEachRecord(chunks[c], false, [&](std::string_view line, std::string_view columns) {
+            WeatherStationStore::Report& report = entry.second;
+            if (!METARParser::parse(line, report.observation)) {
+                rejected[c]++;
+                return;
+            }
+            entry.first = packStationId(report.observation.stationId());
+            StationPosition position;
+            if (csvNumber(columns, NOAA_LATITUDE_COLUMN, position.latitude) &&
+                csvNumber(columns, NOAA_LATITUDE_COLUMN + 1, position.longitude)) {
+                position.station = entry.first;
+                positions[c].push_back(position);
+            }
+            report.text.assign(line.data(), line.size());
+            report.storedAt = now;
+            report.expiresAt = now + CACHE_TTL_SECONDS;
+            parsed[c].push_back(std::move(entry));
+        });
+    });
+    
+    // Concatenated in file order, so the later report for a station wins
+    std::vector<Entry> batch;
+    size_t total = 0;
+    for (const auto& list : parsed) total += list.size();
+    batch.reserve(total);
+    std::vector<StationKey> stations;
+    stations.reserve(total);
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        result.rejected += rejected[c];
+        for (Entry& entry : parsed[c]) {
+            stations.push_back(entry.first);
+            batch.push_back(std::move(entry));
         }
     }
+    std::sort(stations.begin(), stations.end());
+    result.accepted = static_cast<int>(std::unique(stations.begin(), stations.end()) - stations.begin());
+    
+    // Stations the file didn't cover keep their current report
+    std::vector<StationPosition> located;
+    for (auto& list : positions) located.insert(located.end(), list.begin(), list.end());
+    if (!located.empty()) {
+        interpolator_->setStationPositions(located);
+    }
+    store_->publish(std::move(batch));
     
-    file.close();
-    return count;
+    result.elapsedMs = millisecondsSince(start);
+    return result;
 }
 
-bool WeatherDatabase::saveMETARsToFile(const std::string& filepath) {
-    std::ofstream file(filepath);
-    if (!file.is_open()) {
-        std::cerr << "WeatherDatabase: Cannot create file: " << filepath << std::endl;
-        return false;
+WeatherDatabase::IngestResult WeatherDatabase::ingestTAFFile(const std::string& filepath) {
+    IngestResult result;
+    auto start = std::chrono::steady_clock::now();
+    
+    MappedFile file;
+    if (!file.open(filepath)) {
+        std::cerr << "WeatherDatabase: Cannot open file: " << filepath << std::endl;
+        return result;
     }
+    result.bytes = file.size();
+    
+    std::shared_ptr<WorkStealingPool> pool = ingestPool(file.size());
+    size_t chunkBytes = pool ? std::max(INGEST_CHUNK_BYTES, file.size() / (pool->getThreadCount() * 4) + 1)
+                             : file.size() + 1;
+    std::vector<std::string_view> chunks = splitChunks(file.text(), chunkBytes, true);
+    result.chunks = chunks.size();
     
+    std::vector<std::vector<std::pair<std::string, std::string>>> parsed(chunks.size());
+    std::vector<TAFStore::Batch> decoded(chunks.size());
+    std::vector<int> rejected(chunks.size(), 0);
+    time_t now = std::time(nullptr);
+    parallelFor(pool.get(), chunks.size(), [&](size_t c) {
+        forEachRecord(chunks[c], true, [&](std::string_view record, std::string_view) {
+            // [TAF] [AMD|COR] station DDHHMMZ ...
+            METARTokenizer tokens(record);
+            std::string_view token;
+            bool ok = tokens.next(token);
+            while (ok && (token == "TAF" || token == "AMD" || token == "COR")) ok = tokens.next(token);
+            std::string_view station = token;
+            int day = 0, hour = 0, minute = 0;
+            if (!ok || !METARSyntax::isStationId(station) || !tokens.next(token) ||
+                !METARSyntax::decodeDateTime(token, day, hour, minute)) {
+                rejected[c]++;
+                return;
+            }
+            
+            // One line, single spaces
+            std::string text;
+            text.reserve(record.size());
+            METARTokenizer words(record);
+            while (words.next(token)) {
+                if (!text.empty()) text += ' ';
+                text.append(token.data(), token.size());
+            }
+            
+            StationKey key = INVALID_STATION;
+            TAFForecast forecast;
+            if (TAFStore::decode(text, key, forecast, now) && forecast.validTo > now) {
+                decoded[c].emplace_back(key, std::move(forecast));
+            }
+            parsed[c].emplace_back(std::string(station), std::move(text));
+        });
+    });
+    
+    std::map<std::string, CachedTAF> batch;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        result.rejected += rejected[c];
+        for (auto& entry : parsed[c]) {
+            CachedTAF& cached = batch[std::move(entry.first)];
+            cached.rawText = std::move(entry.second);
+            cached.cacheTime = now;
+        }
+    }
+    result.accepted = static_cast<int>(batch.size());
+    
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        batch.merge(tafCache_);
+        tafCache_.swap(batch);
+    }
+    TAFStore::Batch forecasts;
+    for (TAFStore::Batch& chunk : decoded) {
+        std::move(chunk.begin(), chunk.end(), std::back_inserter(forecasts));
+    }
+    tafStore_->publish(std::move(forecasts));
+    
+    result.elapsedMs = millisecondsSince(start);
+    return result;
+}
+
+bool WeatherDatabase::getTAF(const std::string& icao, std::string& rawTaf) {
     std::lock_guard<std::mutex> lock(cacheMutex_);
     
-    file << "# Cached METAR reports - one per line\n";
-    file << "# Format: STATIONID DATETIME WIND VISIBILITY WEATHER CLOUDS TEMP/DP ALTIMETER\n\n";
+    auto it = tafCache_.find(icao);
+    if (it == tafCache_.end()) {
+        return false;
+    }
     
-    for (const auto& pair : reportCache_) {
-        const METARReport& report = pair.second.report;
-        
-        // Reconstruct METAR string (simplified)
-        file << report.stationId << " ";
-        
-        // Add other fields as needed
-        file << "# Cached from " << std::ctime(&pair.second.cacheTime);
+    if (std::time(nullptr) - it->second.cacheTime > TAF_EXPIRATION_MINUTES * 60) {
+        tafCache_.erase(it);
+        return false;
     }
     
-    file.close();
+    rawTaf = it->second.rawText;
     return true;
 }
 
-void WeatherDatabase::clearCache() {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    reportCache_.clear();
+bool WeatherDatabase::getForecast(const std::string& icao, time_t time, TAFPeriod& period) const {
+    return tafStore_->forecastAt(icao, time, period);
 }
 
-int WeatherDatabase::getCacheSize() const {
+void WeatherDatabase::setThreadPool(std::shared_ptr<WorkStealingPool> pool) {
     std::lock_guard<std::mutex> lock(cacheMutex_);
-    return reportCache_.size();
+    pool_ = std::move(pool);
 }
 
-// Private methods
-
-bool WeatherDatabase::parseStationId(const std::string& token, METARReport& report) {
-    if (token.length() < 3 || token.length() > 4) {
-        return false;
+std::shared_ptr<WorkStealingPool> WeatherDatabase::ingestPool(size_t bytes) {
+    if (bytes <= INGEST_CHUNK_BYTES) {
+        return nullptr;
     }
-    
-    // Verify it's all uppercase letters (or digits for some international codes)
-    for (char c : token) {
-        if (!std::isupper(c) && !std::isdigit(c)) {
-            return false;
-        }
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (!pool_) {
+        pool_ = std::make_shared<WorkStealingPool>();
     }
-    
-    report.stationId = token;
-    return true;
+    return pool_;
 }
 
-bool WeatherDatabase::parseDateTime(const std::string& token, METARReport& report) {
-    // Format: DDHHMMZ or DDHHMM where DD=day, HH=hour, MM=minute
-    if (token.length() < 6 || token.length() > 7) {
+bool WeatherDatabase::saveMETARsToFile(const std::string& filepath) {
+    std::ofstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "WeatherDatabase: Cannot create file: " << filepath << std::endl;
         return false;
     }
     
-    // Must end with Z
-    if (token.back() != 'Z' && !std::isdigit(token.back())) {
-        return false;
-    }
+    file << "# Cached METAR reports - one per line\n";
+    
+    store_->forEach([&](StationKey, const WeatherStationStore::Report& report) {
+        file << report.text << '\n';
+    });
     
-    try {
-        int day = std::stoi(token.substr(0, 2));
-        int hour = std::stoi(token.substr(2, 2));
-        int minute = std::stoi(token.substr(4, 2));
-        
-        if (day < 1 || day > 31 || hour < 0 || hour > 23 || minute < 0 || minute > 59) {
+    file.close();
+    return true;
+}
+
+bool WeatherDatabase::saveSnapshot(const std::string& filepath) {
+    std::vector<uint8_t> image = WeatherSnapshot::build(*store_, interpolator_.get());
+    std::string temporary = filepath + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open() || !file.write(reinterpret_cast<const char*>(image.data()),
+                                           static_cast<std::streamsize>(image.size()))) {
+            std::cerr << "WeatherDatabase: Cannot write snapshot: " << temporary << std::endl;
             return false;
         }
-        
-        // Store in report (UTC time)
-        // In real implementation, calculate actual Unix timestamp
-        report.observationTime = std::time(nullptr);
-        
-        return true;
-    } catch (...) {
+    }
+    
+    // Readers see the old snapshot or the new one, never a partial write
+    std::error_code error;
+    std::filesystem::rename(temporary, filepath, error);
+    if (error) {
+        std::cerr << "WeatherDatabase: Cannot replace snapshot: " << filepath << std::endl;
+        std::filesystem::remove(temporary, error);
         return false;
     }
+    return true;
 }
 
-bool WeatherDatabase::parseWind(const std::string& token, METARReport& report) {
-    // Format: DDDSSKT or DDDSSGTKT (direction, speed, optional gust, knots)
-    // Examples: 31008KT, 180V220KT, 31008G15KT
-    
-    if (token.find("KT") == std::string::npos) {
-        return false;
+int WeatherDatabase::loadSnapshot(const std::string& filepath) {
+    MappedFile file;
+    if (!file.open(filepath)) {
+        return -1;
     }
-    
-    // Handle variable wind (VRB prefix)
-    if (token.substr(0, 3) == "VRB") {
-        report.windVariable = true;
-        report.windDirection = 0;
-        
-        size_t ktPos = token.find("KT");
-        if (ktPos != std::string::npos && ktPos > 3) {
-            try {
-                report.windSpeed = std::stoi(token.substr(3, ktPos - 3));
-                return true;
-            } catch (...) {
-                return false;
-            }
-        }
-        return false;
+    WeatherSnapshot::Batch batch;
+    std::vector<StationPosition> positions;
+    std::string_view image = file.text();
+    if (!WeatherSnapshot::read(image.data(), image.size(), batch, positions)) {
+        return -1;
     }
     
-    // Regular wind format
-    if (token.length() < 5) return false;
-    
-    try {
-        report.windDirection = std::stoi(token.substr(0, 3));
-        
-        size_t speedStart = 3;
-        size_t gPos = token.find('G');
-        
-        if (gPos != std::string::npos) {
-            // Has gust
-            report.windSpeed = std::stoi(token.substr(speedStart, gPos - speedStart));
-            size_t ktPos = token.find("KT");
-            report.windGust = std::stoi(token.substr(gPos + 1, ktPos - gPos - 1));
-        } else {
-            // No gust
-            size_t ktPos = token.find("KT");
-            report.windSpeed = std::stoi(token.substr(speedStart, ktPos - speedStart));
-        }
-        
-        return true;
-    } catch (...) {
-        return false;
+    int restored = static_cast<int>(batch.size());
+    if (!positions.empty()) {
+        interpolator_->setStationPositions(positions);
     }
+    store_->publish(std::move(batch));
+    return restored;
 }
 
-bool WeatherDatabase::parseVisibility(const std::string& token, METARReport& report) {
-    // Format: 10SM, 5SM, 1/4SM, P6SM (greater than 6)
-    
-    if (token.find("SM") == std::string::npos) {
-        return false;
-    }
-    
-    try {
-        std::string visStr = token.substr(0, token.find("SM"));
-        
-        if (visStr[0] == 'P') {
-            // Greater than 6 miles
-            report.visibility = 10;  // Default to 10
-        } else if (visStr.find('/') != std::string::npos) {
-            // Fractional (e.g., 1/4)
-            size_t slashPos = visStr.find('/');
-            int num = std::stoi(visStr.substr(0, slashPos));
-            int denom = std::stoi(visStr.substr(slashPos + 1));
-            report.visibility = num / denom;
-        } else {
-            // Regular number
-            report.visibility = std::stoi(visStr);
-        }
-        
-        return true;
-    } catch (...) {
-        return false;
+std::future<int> WeatherDatabase::loadSnapshotAsync(const std::string& filepath) {
+    return IoExecutor::shared()->submit([this, filepath] { return loadSnapshot(filepath); });
+}
+
+void WeatherDatabase::startSnapshotWriter(const std::string& filepath, int intervalSeconds) {
+    stopSnapshotWriter();
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        snapshotStopping_ = false;
     }
+    // Nothing to write until the store changes from here
+    snapshotThread_ = std::thread(&WeatherDatabase::snapshotLoop, this, filepath, std::max(1, intervalSeconds),
+                                  store_->epoch());
 }
 
-bool WeatherDatabase::parseWeatherPhenomena(const std::string& token, METARReport& report) {
-    // Format: -RA, +RA, TS, CAVOK, VV001 (vertical visibility), etc.
-    
-    // Special case: CAVOK (no weather)
-    if (token == "CAVOK") {
-        report.visibility = 10;
-        report.weatherPhenomena.push_back("CAVOK");
-        return true;
+void WeatherDatabase::stopSnapshotWriter() {
+    if (!snapshotThread_.joinable()) {
+        return;
     }
-    
-    // Vertical visibility format: VVxxx (e.g., VV001 = 100 ft vertical visibility)
-    if (token.substr(0, 2) == "VV") {
-        try {
-            int vv = std::stoi(token.substr(2));
-            report.ceilingFeet = vv * 100;
-            return true;
-        } catch (...) {
-            return false;
-        }
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        snapshotStopping_ = true;
     }
-    
-    // Weather codes: RA (rain), SN (snow), SG (snow grains), PL (ice pellets),
-    //               GR (hail), GS (small hail), UP (unknown precip), TS (thunderstorm),
-    //               FZ (freezing), VC (vicinity)
-    
-    if (token.length() < 2) return false;
-    
-    std::vector<std::string> weatherCodes = {
-        "RA", "SN", "SG", "PL", "GR", "GS", "UP", "TS", "FZ", "VC", "DZ", "BR", "FG", "FU"
-    };
-    
-    for (const auto& code : weatherCodes) {
-        if (token.find(code) != std::string::npos) {
-            report.weatherPhenomena.push_back(token);
-            return true;
+    snapshotCv_.notify_all();
+    snapshotThread_.join();
+}
+
+void WeatherDatabase::snapshotLoop(std::string filepath, int intervalSeconds, uint64_t savedEpoch) {
+    bool saved = true;
+    std::unique_lock<std::mutex> lock(snapshotMutex_);
+    for (;;) {
+        bool stopping = snapshotCv_.wait_for(lock, std::chrono::seconds(intervalSeconds),
+                                             [this] { return snapshotStopping_; });
+        uint64_t epoch = store_->epoch();
+        if (!saved || epoch != savedEpoch) {
+            lock.unlock();
+            saved = saveSnapshot(filepath);
+            savedEpoch = epoch;
+            lock.lock();
         }
+        if (stopping) return;
     }
-    
-    return false;
 }
 
-bool WeatherDatabase::parseCloudLayer(const std::string& token, METARReport& report) {
-    // Format: FEW010, SCT025, BKN040, OVC080, SKC, CLR
-    
-    std::vector<std::string> coverageCodes = {"FEW", "SCT", "BKN", "OVC", "SKC", "CLR"};
-    
-    for (const auto& code : coverageCodes) {
-        if (token.substr(0, code.length()) == code) {
-            CloudLayer layer;
-            layer.coverage = code;
-            
-            if (code == "SKC" || code == "CLR") {
-                layer.altitude = 0;
-            } else {
-                try {
-                    layer.altitude = std::stoi(token.substr(code.length())) * 100;  // In hundreds of feet
-                } catch (...) {
-                    return false;
-                }
-            }
-            
-            // Check for cloud type (CB, TCU)
-            if (token.length() > code.length() + 3) {
-                std::string remainder = token.substr(code.length() + 3);
-                if (remainder == "CB" || remainder == "TCU") {
-                    layer.cloudType = remainder;
-                }
-            }
-            
-            report.clouds.push_back(layer);
-            return true;
-        }
+void WeatherDatabase::clearCache() {
+    store_->clear();
+    tafStore_->clear();
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    tafCache_.clear();
+}
+
+bool WeatherDatabase::getStationSummary(const std::string& icao, StationSummary& summary) const {
+    return store_->getSummary(icao, summary);
+}
+
+size_t WeatherDatabase::selectStations(uint16_t required, uint16_t excluded,
+                                       std::vector<StationKey>& stations) const {
+    return store_->select(required, excluded, stations);
+}
+
+int WeatherDatabase::getCacheSize() const {
+    return static_cast<int>(store_->size());
+}
+
+// ========== Airport Weather API (WeatherData view) ==========
+
+WeatherData WeatherDatabase::GetWeatherAt(const std::string& icaoCode, long /*timeSeconds*/) {
+    WeatherData wx = GetDefaultWeather(icaoCode);
+    store_->visit(icaoCode, [&](const WeatherStationStore::Report& stored) {
+        fillWeatherData(stored.observation, stored.text, stored.summary, wx);
+        wx.icaoCode = icaoCode;
+        wx.timestampUnix = static_cast<long>(stored.storedAt);
+        wx.cacheTime = std::chrono::system_clock::from_time_t(stored.storedAt);
+    });
+    return wx;
+}
+
+WeatherData WeatherDatabase::GetWeatherAtPosition(double latitude, double longitude) {
+    InterpolatedWeather sample;
+    if (!interpolator_->sample(latitude, longitude, sample)) {
+        return GetDefaultWeather("");
     }
     
-    return false;
+    // Categorical fields from the nearest station, measured ones blended
+    WeatherData wx = GetWeatherAt(unpackStationId(sample.nearestStation));
+    const WeatherConditions& blended = sample.conditions;
+    wx.temperatureCelsius = blended.temperature;
+    wx.dewpointCelsius = blended.dewpoint;
+    wx.wind.directionDegrees = static_cast<int>(std::lround(blended.windDirection)) % 360;
+    wx.wind.speedKnots = static_cast<int>(std::lround(blended.windSpeed));
+    wx.visibilityStatuteMiles = blended.visibility;
+    wx.ceilingFeet = blended.ceiling;
+    wx.altimeterSettingInHg = sample.altimeterInHg;
+    wx.altimeterSettingMbar = sample.altimeterInHg * 33.8639;
+    wx.hasThunderstorm = sample.thunderstormShare >= 0.5;
+    wx.isIcingCondition = blended.icing;
+    wx.hasTurbulence = blended.turbulence;
+    return wx;
 }
 
-bool WeatherDatabase::parseTemperatureDewpoint(const std::string& token, METARReport& report) {
-    // Format: 23/14, M05/M08 (with minus sign)
-    
-    if (token.find('/') == std::string::npos) {
-        return false;
+WeatherData WeatherDatabase::ParseMETAR(const std::string& metarString) {
+    WeatherData wx = GetDefaultWeather("");
+    wx.isValid = false;
+    
+    METARObservation observation;
+    if (!METARParser::parse(metarString, observation)) {
+        wx.parseError = observation.error;
+        return wx;
     }
     
-    try {
-        size_t slashPos = token.find('/');
-        std::string tempStr = token.substr(0, slashPos);
-        std::string dpStr = token.substr(slashPos + 1);
-        
-        // Parse temperature
-        int sign = 1;
-        if (tempStr[0] == 'M') {
-            sign = -1;
-            tempStr = tempStr.substr(1);
-        }
-        report.temperature = sign * std::stoi(tempStr);
-        
-        // Parse dewpoint
-        sign = 1;
-        if (dpStr[0] == 'M') {
-            sign = -1;
-            dpStr = dpStr.substr(1);
-        }
-        report.dewpoint = sign * std::stoi(dpStr);
-        
-        return true;
-    } catch (...) {
-        return false;
-    }
+    fillWeatherData(observation, metarString, summarizeObservation(observation, metarString), wx);
+    return wx;
 }
 
-bool WeatherDatabase::parseAltimeter(const std::string& token, METARReport& report) {
-    // Format: A3000, A2990, etc. (inHg × 100)
-    
-    if (token[0] != 'A' || token.length() != 5) {
-        return false;
+std::vector<WeatherData> WeatherDatabase::ParseTAF(const std::string& tafString) {
+    std::vector<WeatherData> forecasts;
+    
+    // Skip the TAF [AMD|COR] prefix; the base forecast reads like a METAR
+    // body, with the validity group left as an unrecognised token
+    METARTokenizer tokens(tafString);
+    std::string_view token;
+    std::string_view body = tokens.rest();
+    while (tokens.next(token) && (token == "TAF" || token == "AMD" || token == "COR")) {
+        body = tokens.rest();
     }
     
-    try {
-        int altSetting = std::stoi(token.substr(1));
-        report.altimeterSetting = altSetting / 100.0;
-        return true;
-    } catch (...) {
-        return false;
+    WeatherData taf = ParseMETAR(std::string(body));
+    if (taf.isValid) {
+        forecasts.push_back(taf);
     }
+    return forecasts;
 }
 
-bool WeatherDatabase::parseRemarks(const std::string& token, METARReport& report) {
-    // Store remarks for later processing if needed
-    report.remarks.push_back(token);
-    return true;
+double WeatherDatabase::GetVisibility(const std::string& icaoCode) {
+    return GetWeatherAt(icaoCode).visibilityStatuteMiles;
 }
 
-bool WeatherDatabase::isExpired(const CachedReport& cached) const {
-    time_t now = std::time(nullptr);
-    time_t age = now - cached.cacheTime;
-    return age > (METAR_EXPIRATION_MINUTES * 60);
+double WeatherDatabase::GetCeiling(const std::string& icaoCode) {
+    return GetWeatherAt(icaoCode).ceilingFeet;
 }
 
-void WeatherDatabase::deriveConditions(METARReport& report) {
-    // Determine if thunderstorm is present
-    for (const auto& phenom : report.weatherPhenomena) {
-        if (phenom.find("TS") != std::string::npos) {
-            report.thunderstorm = true;
-        }
-        
-        // Precipitation
-        if (phenom.find("RA") != std::string::npos ||
-            phenom.find("SN") != std::string::npos ||
-            phenom.find("PL") != std::string::npos ||
-            phenom.find("GR") != std::string::npos) {
-            report.precipitation = true;
+WindData WeatherDatabase::GetWindData(const std::string& icaoCode) {
+    return GetWeatherAt(icaoCode).wind;
+}
+
+double WeatherDatabase::GetTemperature(const std::string& icaoCode) {
+    return GetWeatherAt(icaoCode).temperatureCelsius;
+}
+
+double WeatherDatabase::GetDewpoint(const std::string& icaoCode) {
+    return GetWeatherAt(icaoCode).dewpointCelsius;
+}
+
+double WeatherDatabase::GetAltimeter(const std::string& icaoCode) {
+    return GetWeatherAt(icaoCode).altimeterSettingInHg;
+}
+
+bool WeatherDatabase::HasHazardousConditions(const std::string& icaoCode) {
+    // Default weather has no hazards
+    StationSummary summary;
+    return store_->getSummary(icaoCode, summary) && summary.has(StationFlags::HAZARDOUS);
+}
+
+PrecipitationType WeatherDatabase::GetPrecipitationType(const std::string& icaoCode) {
+    return GetWeatherAt(icaoCode).precipitation;
+}
+
+void WeatherDatabase::ClearCache() {
+    clearCache();
+}
+
+bool WeatherDatabase::UpdateCache(const std::string& icaoCode, const std::string& metarString) {
+    return updateWeather(icaoCode, metarString);
+}
+
+size_t WeatherDatabase::GetCacheSize() const {
+    return store_->memoryBytes();
+}
+
+int WeatherDatabase::GetCacheEntryCount() const {
+    return getCacheSize();
+}
+
+void WeatherDatabase::RefreshExpiredEntries() {
+    store_->purgeExpired();
+    tafStore_->purgeExpired();
+}
+
+// Private methods
+
+void WeatherDatabase::fillReport(const METARObservation& observation, std::string_view source,
+                                 METARReport& report) {
+    report.stationId = std::string(observation.stationId());
+    
+    report.windDirection = observation.windDirection;
+    report.windSpeed = observation.windSpeed;
+    report.windGust = observation.windGust;
+    report.windVariable = observation.windVariable;
+    report.variableMinDir = observation.variableMinDir;
+    report.variableMaxDir = observation.variableMaxDir;
+    
+    // Statute miles, truncated
+    report.visibility = static_cast<int>(observation.visibilitySM);
+    
+    if (observation.cavok) {
+        report.weatherPhenomena.emplace_back("CAVOK");
+    }
+    for (size_t i = 0; i < observation.weatherCount; ++i) {
+        report.weatherPhenomena.emplace_back(observation.weather[i].text(source));
+    }
+    
+    report.clouds.reserve(observation.cloudCount);
+    for (size_t i = 0; i < observation.cloudCount; ++i) {
+        const METARObservation::Cloud& layer = observation.clouds[i];
+        METARCloudLayer cloud;
+        switch (layer.coverage) {
+            case CloudCoverage::FEW: cloud.coverage = "FEW"; break;
+            case CloudCoverage::SCT: cloud.coverage = "SCT"; break;
+            case CloudCoverage::BKN: cloud.coverage = "BKN"; break;
+            default:                 cloud.coverage = "OVC"; break;
         }
+        cloud.altitude = layer.altitudeFeet;
+        if (layer.cumulonimbus) cloud.cloudType = "CB";
+        else if (layer.toweringCumulus) cloud.cloudType = "TCU";
+        report.clouds.push_back(std::move(cloud));
     }
     
-    // Determine if low visibility
-    report.lowVisibility = (report.visibility < 3);
+    report.temperature = observation.temperature;
+    report.dewpoint = observation.hasDewpoint ? observation.dewpoint : observation.temperature;
+    report.altimeterSetting = observation.altimeterInHg;
+    
+    METARTokenizer remarks(observation.remarks(source));
+    std::string_view token;
+    while (remarks.next(token)) {
+        report.remarks.emplace_back(token);
+    }
     
-    // Calculate ceiling from cloud layers
-    report.ceilingFeet = calculateCeiling(report);
+    // Derived conditions
+    report.thunderstorm = observation.thunderstorm();
+    report.precipitation = observation.precipitation();
+    report.lowVisibility = observation.visibilitySM < 3.0;
+    report.ceilingFeet = observation.ceilingFeet();
     
-    // Infer icing conditions
-    // Icing typically occurs when temp is 0-15°C and moisture present
+    // Icing typically occurs near or below freezing with moisture present
     report.icing = (report.temperature >= -20 && report.temperature <= 10) &&
                    (report.precipitation || report.thunderstorm);
 }
 
-double WeatherDatabase::calculateCeiling(const METARReport& report) const {
-    // Ceiling is the lowest layer of BKN or OVC
-    for (const auto& layer : report.clouds) {
-        if (layer.coverage == "BKN" || layer.coverage == "OVC") {
-            return layer.altitude;
+void WeatherDatabase::fillWeatherData(const METARObservation& observation, std::string_view source,
+                                      const StationSummary& summary, WeatherData& wx) {
+    wx.icaoCode = std::string(observation.stationId());
+    wx.isValid = true;
+    wx.parseError.clear();
+    
+    wx.wind.directionDegrees = observation.windDirection;
+    wx.wind.speedKnots = observation.windSpeed;
+    wx.wind.gustKnots = observation.windGust;
+    wx.wind.isVariable = observation.windVariable;
+    wx.wind.variableMinDir = observation.variableMinDir;
+    wx.wind.variableMaxDir = observation.variableMaxDir;
+    
+    wx.visibilityStatuteMiles = observation.visibilitySM;
+    
+    wx.weatherCodes.clear();
+    if (observation.cavok) {
+        wx.weatherCodes.emplace_back("CAVOK");
+    }
+    for (size_t i = 0; i < observation.weatherCount; ++i) {
+        wx.weatherCodes.emplace_back(observation.weather[i].text(source));
+    }
+    
+    wx.cloudLayers.clear();
+    wx.cloudLayers.reserve(observation.cloudCount);
+    for (size_t i = 0; i < observation.cloudCount; ++i) {
+        const METARObservation::Cloud& layer = observation.clouds[i];
+        CloudLayer cloud;
+        switch (layer.coverage) {
+            case CloudCoverage::FEW: cloud.coverage = WeatherConditionType::FEW; break;
+            case CloudCoverage::SCT: cloud.coverage = WeatherConditionType::SCATTERED; break;
+            case CloudCoverage::BKN: cloud.coverage = WeatherConditionType::BROKEN; break;
+            default:                 cloud.coverage = WeatherConditionType::OVERCAST; break;
         }
+        cloud.altitudeAgl = layer.altitudeFeet;
+        cloud.isCumulonimbus = layer.cumulonimbus;
+        cloud.isToweringCumulus = layer.toweringCumulus;
+        wx.cloudLayers.push_back(cloud);
+    }
+    wx.ceilingFeet = observation.ceilingFeet();
+    wx.skyCondition = wx.cloudLayers.empty() ? WeatherConditionType::CLEAR : wx.cloudLayers[0].coverage;
+    
+    if (observation.hasTemperature) {
+        wx.temperatureCelsius = observation.temperature;
+        wx.dewpointCelsius = observation.hasDewpoint ? observation.dewpoint : observation.temperature;
+    }
+    if (observation.hasAltimeter) {
+        wx.altimeterSettingInHg = observation.altimeterInHg;
+        wx.altimeterSettingMbar = observation.altimeterMbar;
     }
     
-    // No ceiling if only FEW/SCT
-    return 10000;  // Default if no BKN/OVC
+    // Hazards as derived when the report was stored
+    wx.precipitation = summary.precipitationType();
+    wx.hasFreezingRain = summary.has(StationFlags::FREEZING_RAIN);
+    wx.hasThunderstorm = summary.has(StationFlags::THUNDERSTORM);
+    wx.isIcingCondition = summary.has(StationFlags::ICING);
+    wx.hasTurbulence = summary.has(StationFlags::TURBULENCE);
+}
+
+WeatherData WeatherDatabase::GetDefaultWeather(const std::string& icaoCode) {
+    // Standard-day conditions for airports without a current report
+    WeatherData wx;
+    wx.icaoCode = icaoCode;
+    wx.timestampUnix = static_cast<long>(std::time(nullptr));
+    wx.temperatureCelsius = 15.0;
+    wx.dewpointCelsius = 10.0;
+    wx.wind = {180, 8, 0, false, 0, 0};
+    wx.visibilityStatuteMiles = 10.0;
+    wx.ceilingFeet = 5000.0;
+    wx.skyCondition = WeatherConditionType::SCATTERED;
+    wx.altimeterSettingInHg = 29.92;
+    wx.altimeterSettingMbar = 1013.0;
+    wx.precipitation = PrecipitationType::NONE;
+    wx.isIcingCondition = false;
+    wx.hasThunderstorm = false;
+    wx.hasFreezingRain = false;
+    wx.hasTurbulence = false;
+    wx.isValid = true;
+    wx.cacheTime = std::chrono::system_clock::now();
+    return wx;
 }
 
 } // namespace AICopilot
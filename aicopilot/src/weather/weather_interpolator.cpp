@@ -0,0 +1,233 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Weather Interpolator Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/weather_interpolator.hpp"
+#include "../include/geodesy.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr int LAT_CELLS = static_cast<int>(180.0 / WeatherInterpolator::CELL_SIZE_DEG + 0.5);
+constexpr int LON_CELLS = static_cast<int>(360.0 / WeatherInterpolator::CELL_SIZE_DEG + 0.5);
+
+// Extra neighbours to ask the index for, in case some have no live report
+constexpr size_t CANDIDATE_FACTOR = 3;
+
+double normalizeLongitude(double longitude) {
+    while (longitude < -180.0) longitude += 360.0;
+    while (longitude >= 180.0) longitude -= 360.0;
+    return longitude;
+}
+
+} // namespace
+
+WeatherInterpolator::WeatherInterpolator(std::shared_ptr<const WeatherStationStore> store)
+    : store_(std::move(store)) {}
+
+void WeatherInterpolator::setStationPositions(const std::vector<StationPosition>& positions) {
+    std::unique_lock<std::shared_mutex> lock(indexMutex_);
+    for (const StationPosition& position : positions) {
+        if (position.station != INVALID_STATION) positions_[position.station] = position;
+    }
+
+    std::vector<WaypointIndex::Point> points;
+    points.reserve(positions_.size());
+    for (const auto& entry : positions_) {
+        points.push_back({entry.second.latitude, entry.second.longitude, entry.first});
+    }
+    index_.build(std::move(points));
+    positionsEpoch_++;
+}
+
+bool WeatherInterpolator::getStationPosition(StationKey station, StationPosition& position) const {
+    std::shared_lock<std::shared_mutex> lock(indexMutex_);
+    auto it = positions_.find(station);
+    if (it == positions_.end()) return false;
+    position = it->second;
+    return true;
+}
+
+size_t WeatherInterpolator::stationCount() const {
+    std::shared_lock<std::shared_mutex> lock(indexMutex_);
+    return positions_.size();
+}
+
+uint32_t WeatherInterpolator::cellFor(double latitude, double longitude) {
+    int row = static_cast<int>(std::floor((latitude + 90.0) / CELL_SIZE_DEG));
+    int column = static_cast<int>(std::floor((normalizeLongitude(longitude) + 180.0) / CELL_SIZE_DEG));
+    row = std::max(0, std::min(LAT_CELLS - 1, row));
+    column = std::max(0, std::min(LON_CELLS - 1, column));
+    return static_cast<uint32_t>(row) * LON_CELLS + static_cast<uint32_t>(column);
+}
+
+bool WeatherInterpolator::sample(double latitude, double longitude, InterpolatedWeather& weather,
+                                 time_t now) const {
+    uint32_t cell = cellFor(latitude, longitude);
+    uint64_t storeEpoch = store_->epoch();
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex_);
+        auto it = cache_.find(cell);
+        if (it != cache_.end() && it->second.storeEpoch == storeEpoch && now < it->second.validUntil) {
+            std::shared_lock<std::shared_mutex> indexLock(indexMutex_);
+            if (it->second.positionsEpoch == positionsEpoch_) {
+                weather = it->second.weather;
+                return it->second.found;
+            }
+        }
+    }
+
+    // Interpolate at the cell centre so the result holds for the whole cell
+    double centreLatitude = (cell / LON_CELLS + 0.5) * CELL_SIZE_DEG - 90.0;
+    double centreLongitude = (cell % LON_CELLS + 0.5) * CELL_SIZE_DEG - 180.0;
+    CachedCell computed;
+    computed.storeEpoch = storeEpoch;
+    computed.found = interpolate(centreLatitude, centreLongitude, now, computed.weather,
+                                 computed.validUntil, computed.positionsEpoch);
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    if (cache_.size() >= MAX_CACHED_CELLS) cache_.clear();
+    cache_[cell] = computed;
+    weather = computed.weather;
+    return computed.found;
+}
+
+bool WeatherInterpolator::interpolate(double latitude, double longitude, time_t now,
+                                      InterpolatedWeather& weather, time_t& validUntil,
+                                      uint64_t& positionsEpoch) const {
+    weather = InterpolatedWeather();
+    validUntil = std::numeric_limits<time_t>::max();
+
+    std::vector<WaypointIndex::Match> nearby;
+    {
+        std::shared_lock<std::shared_mutex> lock(indexMutex_);
+        positionsEpoch = positionsEpoch_;
+        index_.queryNearest(latitude, longitude, MAX_STATIONS * CANDIDATE_FACTOR, nearby, MAX_RADIUS_NM);
+    }
+
+    double totalWeight = 0.0;
+    double windEast = 0.0, windNorth = 0.0, windSpeed = 0.0;
+    double visibility = 0.0, ceiling = 0.0, temperature = 0.0, dewpoint = 0.0, altimeter = 0.0;
+    double thunderstorm = 0.0, icing = 0.0, turbulence = 0.0, precipitation = 0.0;
+
+    for (const WaypointIndex::Match& match : nearby) {
+        if (weather.stationCount == static_cast<int>(MAX_STATIONS)) break;
+        bool snapped = weather.stationCount == 0 && match.distanceNM <= SNAP_DISTANCE_NM;
+        double w = snapped ? 1.0 : 1.0 / (match.distanceNM * match.distanceNM);
+
+        StationKey station = static_cast<StationKey>(match.id);
+        bool live = store_->visit(station, [&](const WeatherStationStore::Report& report) {
+            const METARObservation& observation = report.observation;
+            WeatherConditions reported = conditionsFromObservation(observation);
+            double from = reported.windDirection * Geodesy::DEG_TO_RAD;
+            windEast += w * reported.windSpeed * std::sin(from);
+            windNorth += w * reported.windSpeed * std::cos(from);
+            windSpeed += w * reported.windSpeed;
+            visibility += w * reported.visibility;
+            ceiling += w * reported.ceiling;
+            temperature += w * reported.temperature;
+            dewpoint += w * reported.dewpoint;
+            altimeter += w * (observation.hasAltimeter ? observation.altimeterInHg : 29.92);
+            thunderstorm += observation.thunderstorm() ? w : 0.0;
+            icing += reported.icing ? w : 0.0;
+            turbulence += reported.turbulence ? w : 0.0;
+            precipitation += reported.precipitation ? w : 0.0;
+            validUntil = std::min(validUntil, report.expiresAt);
+        }, now);
+        if (!live) continue;
+
+        if (weather.stationCount == 0) {
+            weather.nearestStation = match.id;
+            weather.nearestDistanceNM = match.distanceNM;
+        }
+        weather.stationCount++;
+        totalWeight += w;
+        if (snapped) break;
+    }
+    if (weather.stationCount == 0) return false;
+
+    WeatherConditions& conditions = weather.conditions;
+    // Blended vector for direction; averaged magnitude so opposing winds don't cancel to calm
+    conditions.windSpeed = windSpeed / totalWeight;
+    conditions.windDirection = std::fmod(std::atan2(windEast, windNorth) * Geodesy::RAD_TO_DEG + 360.0, 360.0);
+    conditions.visibility = visibility / totalWeight;
+    conditions.ceiling = ceiling / totalWeight;
+    conditions.cloudBase = conditions.ceiling;
+    conditions.temperature = temperature / totalWeight;
+    conditions.dewpoint = dewpoint / totalWeight;
+    weather.altimeterInHg = altimeter / totalWeight;
+
+    weather.thunderstormShare = thunderstorm / totalWeight;
+    weather.icingShare = icing / totalWeight;
+    weather.precipitationShare = precipitation / totalWeight;
+    conditions.icing = weather.icingShare >= 0.5;
+    conditions.turbulence = turbulence / totalWeight >= 0.5;
+    conditions.precipitation = weather.precipitationShare >= 0.5;
+    return true;
+}
+
+size_t WeatherInterpolator::sampleRoute(const std::vector<Position>& route, double spacingNM,
+                                        std::vector<InterpolatedWeather>& samples,
+                                        std::vector<Position>* points, time_t now) const {
+    samples.clear();
+    if (points) points->clear();
+    if (!(spacingNM > 0.0)) spacingNM = DEFAULT_ROUTE_SPACING_NM;
+
+    size_t found = 0;
+    auto add = [&](double lat, double lon, double altitude) {
+        InterpolatedWeather weather;
+        if (sample(lat, lon, weather, now)) found++;
+        samples.push_back(weather);
+        if (points) points->push_back({lat, lon, altitude, 0.0});
+    };
+
+    for (size_t i = 0; i < route.size(); ++i) {
+        const Position& to = route[i];
+        if (i == 0) {
+            add(to.latitude, to.longitude, to.altitude);
+            continue;
+        }
+
+        // Points along the great circle, from the normalised chord between the ends
+        const Position& from = route[i - 1];
+        double distance = Geodesy::haversineNM(from.latitude, from.longitude, to.latitude, to.longitude);
+        size_t steps = std::max<size_t>(1, static_cast<size_t>(std::ceil(distance / spacingNM)));
+        Geodesy::UnitVector a = Geodesy::toUnitVector(from.latitude, from.longitude);
+        Geodesy::UnitVector b = Geodesy::toUnitVector(to.latitude, to.longitude);
+        for (size_t step = 1; step < steps; ++step) {
+            double f = static_cast<double>(step) / steps;
+            double x = a.x + (b.x - a.x) * f;
+            double y = a.y + (b.y - a.y) * f;
+            double z = a.z + (b.z - a.z) * f;
+            double length = std::sqrt(x * x + y * y + z * z);
+            if (length < 1e-12) continue;  // antipodal ends have no unique path
+            add(std::asin(z / length) * Geodesy::RAD_TO_DEG, std::atan2(y, x) * Geodesy::RAD_TO_DEG,
+                from.altitude + (to.altitude - from.altitude) * f);
+        }
+        add(to.latitude, to.longitude, to.altitude);
+    }
+    return found;
+}
+
+void WeatherInterpolator::clearCache() {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    cache_.clear();
+}
+
+size_t WeatherInterpolator::cachedCells() const {
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+    return cache_.size();
+}
+
+} // namespace AICopilot
@@ -0,0 +1,258 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Weather Snapshot Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/weather_snapshot.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace AICopilot {
+
+namespace {
+
+uint64_t checksum(const uint8_t* data, size_t size) {
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+size_t align8(size_t value) {
+    return (value + 7) & ~static_cast<size_t>(7);
+}
+
+int16_t narrow(int value) {
+    return static_cast<int16_t>(std::clamp(value, -32768, 32767));
+}
+
+WeatherSnapshotRecord encode(StationKey station, const WeatherStationStore::Report& report, uint32_t textOffset) {
+    using Flags = WeatherSnapshotRecord::Flags;
+    const METARObservation& o = report.observation;
+    WeatherSnapshotRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.station = station;
+    record.textOffset = textOffset;
+    record.textLength = static_cast<uint32_t>(report.text.size());
+    auto set = [&](uint32_t flag, bool on) {
+        if (on) record.flags |= flag;
+    };
+    set(Flags::AUTOMATED, o.automated);
+    set(Flags::CORRECTED, o.corrected);
+    set(Flags::HAS_WIND, o.hasWind);
+    set(Flags::WIND_VARIABLE, o.windVariable);
+    set(Flags::HAS_VISIBILITY, o.hasVisibility);
+    set(Flags::CAVOK, o.cavok);
+    set(Flags::HAS_TEMPERATURE, o.hasTemperature);
+    set(Flags::HAS_DEWPOINT, o.hasDewpoint);
+    set(Flags::HAS_ALTIMETER, o.hasAltimeter);
+    set(Flags::TRUNCATED, o.truncated);
+    record.storedAt = static_cast<int64_t>(report.storedAt);
+    record.expiresAt = static_cast<int64_t>(report.expiresAt);
+    record.visibilitySM = o.visibilitySM;
+    record.altimeterInHg = o.altimeterInHg;
+    record.altimeterMbar = o.altimeterMbar;
+    record.verticalVisibilityFeet = o.verticalVisibilityFeet;
+    record.windDirection = narrow(o.windDirection);
+    record.windSpeed = narrow(o.windSpeed);
+    record.windGust = narrow(o.windGust);
+    record.variableMinDir = narrow(o.variableMinDir);
+    record.variableMaxDir = narrow(o.variableMaxDir);
+    record.temperature = narrow(o.temperature);
+    record.dewpoint = narrow(o.dewpoint);
+    record.remarksOffset = o.remarksOffset;
+    record.remarksLength = o.remarksLength;
+    record.unknownTokens = o.unknownTokens;
+    record.day = o.day;
+    record.hour = o.hour;
+    record.minute = o.minute;
+    record.weatherCount = o.weatherCount;
+    record.cloudCount = o.cloudCount;
+    for (size_t i = 0; i < o.weatherCount; ++i) {
+        WeatherSnapshotWeather& weather = record.weather[i];
+        weather.components = o.weather[i].components;
+        weather.offset = o.weather[i].offset;
+        weather.length = o.weather[i].length;
+        weather.intensity = o.weather[i].intensity;
+        weather.vicinity = o.weather[i].vicinity ? 1 : 0;
+    }
+    for (size_t i = 0; i < o.cloudCount; ++i) {
+        WeatherSnapshotCloud& cloud = record.clouds[i];
+        cloud.altitudeFeet = o.clouds[i].altitudeFeet;
+        cloud.coverage = static_cast<uint8_t>(o.clouds[i].coverage);
+        cloud.cumulonimbus = o.clouds[i].cumulonimbus ? 1 : 0;
+        cloud.toweringCumulus = o.clouds[i].toweringCumulus ? 1 : 0;
+    }
+    return record;
+}
+
+// False if the record points outside its text or past the fixed arrays
+bool decode(const WeatherSnapshotRecord& record, const char* strings, uint64_t stringsSize,
+            WeatherStationStore::Report& report) {
+    using Flags = WeatherSnapshotRecord::Flags;
+    if (record.textOffset > stringsSize || record.textLength > stringsSize - record.textOffset ||
+        record.textLength > METARObservation::MAX_REPORT_LENGTH ||
+        record.weatherCount > METARObservation::MAX_WEATHER_GROUPS ||
+        record.cloudCount > METARObservation::MAX_CLOUD_LAYERS ||
+        uint32_t(record.remarksOffset) + record.remarksLength > record.textLength) {
+        return false;
+    }
+    report.text.assign(strings + record.textOffset, record.textLength);
+    report.storedAt = static_cast<time_t>(record.storedAt);
+    report.expiresAt = static_cast<time_t>(record.expiresAt);
+
+    METARObservation& o = report.observation;
+    o = METARObservation();
+    std::string icao = unpackStationId(record.station);
+    std::copy(icao.begin(), icao.end(), o.station.begin());
+    o.day = record.day;
+    o.hour = record.hour;
+    o.minute = record.minute;
+    o.automated = (record.flags & Flags::AUTOMATED) != 0;
+    o.corrected = (record.flags & Flags::CORRECTED) != 0;
+    o.hasWind = (record.flags & Flags::HAS_WIND) != 0;
+    o.windVariable = (record.flags & Flags::WIND_VARIABLE) != 0;
+    o.windDirection = record.windDirection;
+    o.windSpeed = record.windSpeed;
+    o.windGust = record.windGust;
+    o.variableMinDir = record.variableMinDir;
+    o.variableMaxDir = record.variableMaxDir;
+    o.hasVisibility = (record.flags & Flags::HAS_VISIBILITY) != 0;
+    o.cavok = (record.flags & Flags::CAVOK) != 0;
+    o.visibilitySM = record.visibilitySM;
+    o.weatherCount = record.weatherCount;
+    for (size_t i = 0; i < record.weatherCount; ++i) {
+        const WeatherSnapshotWeather& weather = record.weather[i];
+        if (uint32_t(weather.offset) + weather.length > record.textLength) return false;
+        o.weather[i].components = weather.components;
+        o.weather[i].intensity = weather.intensity;
+        o.weather[i].vicinity = weather.vicinity != 0;
+        o.weather[i].offset = weather.offset;
+        o.weather[i].length = weather.length;
+    }
+    o.cloudCount = record.cloudCount;
+    for (size_t i = 0; i < record.cloudCount; ++i) {
+        const WeatherSnapshotCloud& cloud = record.clouds[i];
+        o.clouds[i].coverage = static_cast<CloudCoverage>(cloud.coverage);
+        o.clouds[i].altitudeFeet = cloud.altitudeFeet;
+        o.clouds[i].cumulonimbus = cloud.cumulonimbus != 0;
+        o.clouds[i].toweringCumulus = cloud.toweringCumulus != 0;
+    }
+    o.verticalVisibilityFeet = record.verticalVisibilityFeet;
+    o.hasTemperature = (record.flags & Flags::HAS_TEMPERATURE) != 0;
+    o.hasDewpoint = (record.flags & Flags::HAS_DEWPOINT) != 0;
+    o.temperature = record.temperature;
+    o.dewpoint = record.dewpoint;
+    o.hasAltimeter = (record.flags & Flags::HAS_ALTIMETER) != 0;
+    o.altimeterInHg = record.altimeterInHg;
+    o.altimeterMbar = record.altimeterMbar;
+    o.remarksOffset = record.remarksOffset;
+    o.remarksLength = record.remarksLength;
+    o.unknownTokens = record.unknownTokens;
+    o.truncated = (record.flags & Flags::TRUNCATED) != 0;
+    return true;
+}
+
+} // namespace
+
+bool WeatherSnapshot::isSnapshot(const void* data, size_t size) {
+    return data != nullptr && size >= sizeof(MAGIC) && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+std::vector<uint8_t> WeatherSnapshot::build(const WeatherStationStore& store, const WeatherInterpolator* positions,
+                                            time_t now) {
+    std::vector<WeatherSnapshotRecord> records;
+    std::string strings;
+    store.forEach([&](StationKey station, const WeatherStationStore::Report& report) {
+        records.push_back(encode(station, report, static_cast<uint32_t>(strings.size())));
+        strings += report.text;
+    }, now);
+
+    // Positions are looked up once the store's lock is released
+    if (positions) {
+        for (WeatherSnapshotRecord& record : records) {
+            StationPosition position;
+            if (positions->getStationPosition(record.station, position)) {
+                record.latitude = position.latitude;
+                record.longitude = position.longitude;
+                record.flags |= WeatherSnapshotRecord::HAS_POSITION;
+            }
+        }
+    }
+
+    WeatherSnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(WeatherSnapshotHeader);
+    header.recordCount = static_cast<uint32_t>(records.size());
+    header.recordSize = sizeof(WeatherSnapshotRecord);
+    header.writtenAt = static_cast<int64_t>(now);
+    header.recordsOffset = sizeof(WeatherSnapshotHeader);
+    header.stringsOffset = align8(header.recordsOffset + records.size() * sizeof(WeatherSnapshotRecord));
+    header.stringsSize = strings.size();
+    header.fileSize = header.stringsOffset + strings.size();
+
+    std::vector<uint8_t> image(header.fileSize, 0);
+    if (!records.empty()) {
+        std::memcpy(image.data() + header.recordsOffset, records.data(), records.size() * sizeof(WeatherSnapshotRecord));
+    }
+    std::memcpy(image.data() + header.stringsOffset, strings.data(), strings.size());
+    header.checksum = checksum(image.data() + sizeof(WeatherSnapshotHeader), image.size() - sizeof(WeatherSnapshotHeader));
+    std::memcpy(image.data(), &header, sizeof(header));
+    return image;
+}
+
+bool WeatherSnapshot::read(const void* data, size_t size, Batch& reports, std::vector<StationPosition>& positions,
+                           time_t now) {
+    reports.clear();
+    positions.clear();
+    if (!isSnapshot(data, size) || size < sizeof(WeatherSnapshotHeader)) return false;
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    WeatherSnapshotHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.version != VERSION || header.headerSize != sizeof(WeatherSnapshotHeader) ||
+        header.recordSize != sizeof(WeatherSnapshotRecord) || header.fileSize != size) {
+        return false;
+    }
+    uint64_t recordsSize = uint64_t(header.recordCount) * sizeof(WeatherSnapshotRecord);
+    if (header.recordsOffset != sizeof(WeatherSnapshotHeader) || header.recordsOffset + recordsSize > size ||
+        header.stringsOffset < header.recordsOffset + recordsSize || header.stringsOffset > size ||
+        header.stringsSize > size - header.stringsOffset) {
+        return false;
+    }
+    if (checksum(bytes + sizeof(WeatherSnapshotHeader), size - sizeof(WeatherSnapshotHeader)) != header.checksum) {
+        return false;
+    }
+
+    const char* strings = reinterpret_cast<const char*>(bytes + header.stringsOffset);
+    reports.reserve(header.recordCount);
+    for (uint32_t i = 0; i < header.recordCount; ++i) {
+        // Copied out, so the mapping needn't be aligned for the record
+        WeatherSnapshotRecord record;
+        std::memcpy(&record, bytes + header.recordsOffset + uint64_t(i) * sizeof(record), sizeof(record));
+        if (record.station == INVALID_STATION || now >= static_cast<time_t>(record.expiresAt)) continue;
+
+        WeatherStationStore::Report report;
+        if (!decode(record, strings, header.stringsSize, report)) {
+            reports.clear();
+            positions.clear();
+            return false;
+        }
+        reports.emplace_back(record.station, std::move(report));
+        if (record.flags & WeatherSnapshotRecord::HAS_POSITION) {
+            positions.push_back({record.station, record.latitude, record.longitude});
+        }
+    }
+    return true;
+}
+
+} // namespace AICopilot
@@ -0,0 +1,379 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Weather Station Store Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/weather_station_store.hpp"
+#include <algorithm>
+#include <mutex>
+
+namespace AICopilot {
+
+std::string unpackStationId(StationKey key) {
+    std::string icao;
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        char c = static_cast<char>((key >> shift) & 0xFF);
+        if (c != '\0') icao += c;
+    }
+    return icao;
+}
+
+bool WeatherStationStore::update(std::string_view icao, std::string_view metar, int ttlSeconds,
+                                 time_t now, const char** error) {
+    Report report;
+    if (!METARParser::parse(metar, report.observation)) {
+        if (error) *error = report.observation.error;
+        return false;
+    }
+    StationKey key = packStationId(icao.empty() ? report.observation.stationId() : icao);
+    if (key == INVALID_STATION) {
+        if (error) *error = "Invalid station ID";
+        return false;
+    }
+    report.text.assign(metar.data(), metar.size());
+    report.storedAt = now;
+    report.expiresAt = now + ttlSeconds;
+    report.summary = summarizeObservation(report.observation, report.text);
+
+    std::vector<StationChange> changes;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        store(key, std::move(report), listening() ? &changes : nullptr);
+        epoch_.fetch_add(1, std::memory_order_release);
+    }
+    if (!changes.empty()) notify(changes);
+    return true;
+}
+
+void WeatherStationStore::publish(std::vector<std::pair<StationKey, Report>>&& batch) {
+    for (auto& entry : batch) {
+        entry.second.summary = summarizeObservation(entry.second.observation, entry.second.text);
+    }
+
+    std::vector<StationChange> changes;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        // Size for the worst case up front so the batch rehashes at most once
+        size_t needed = (reports_.size() + batch.size()) * 2;
+        if (needed > slots_.size()) {
+            size_t slotCount = std::max(slots_.size(), MIN_SLOTS);
+            while (slotCount < needed) slotCount *= 2;
+            rehash(slotCount);
+        }
+        std::vector<StationChange>* collect = listening() ? &changes : nullptr;
+        for (auto& entry : batch) {
+            if (entry.first != INVALID_STATION) store(entry.first, std::move(entry.second), collect);
+        }
+        epoch_.fetch_add(1, std::memory_order_release);
+    }
+    if (!changes.empty()) notify(changes);
+}
+
+bool WeatherStationStore::get(std::string_view icao, Report& report, time_t now) const {
+    return visit(icao, [&](const Report& stored) { report = stored; }, now);
+}
+
+bool WeatherStationStore::getSummary(std::string_view icao, StationSummary& summary, time_t now) const {
+    return visit(icao, [&](const Report& stored) { summary = stored.summary; }, now);
+}
+
+size_t WeatherStationStore::select(uint16_t required, uint16_t excluded, std::vector<StationKey>& stations,
+                                   time_t now) const {
+    stations.clear();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    const size_t count = flags_.size();
+
+    // Branch-free over the dense arrays so the compiler can vectorize it,
+    // then one pass to gather the matches
+    std::vector<uint8_t> match(count);
+    const uint16_t* flags = flags_.data();
+    const time_t* expiries = expiries_.data();
+    for (size_t i = 0; i < count; ++i) {
+        match[i] = static_cast<uint8_t>(((flags[i] & required) == required) & ((flags[i] & excluded) == 0) &
+                                        (expiries[i] > now));
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (match[i]) stations.push_back(keys_[i]);
+    }
+    return stations.size();
+}
+
+bool WeatherStationStore::erase(std::string_view icao) {
+    StationKey key = packStationId(icao);
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        size_t slot = findSlot(key);
+        if (slot == NPOS) return false;
+        removeSlot(slot);
+        epoch_.fetch_add(1, std::memory_order_release);
+    }
+    if (listening()) notify({{key, true, StationSummary()}});
+    return true;
+}
+
+size_t WeatherStationStore::purgeExpired(time_t now) {
+    std::vector<StationChange> changes;
+    size_t removed = 0;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        bool collect = listening();
+        size_t i = 0;
+        while (i < reports_.size()) {
+            if (now >= expiries_[i]) {
+                if (collect) changes.push_back({keys_[i], true, StationSummary()});
+                // The last report moves into i, so look at i again
+                removeSlot(findSlot(keys_[i]));
+                removed++;
+            } else {
+                i++;
+            }
+        }
+        if (removed > 0) epoch_.fetch_add(1, std::memory_order_release);
+    }
+    if (!changes.empty()) notify(changes);
+    return removed;
+}
+
+void WeatherStationStore::clear() {
+    std::vector<StationChange> changes;
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (listening()) {
+            for (StationKey key : keys_) changes.push_back({key, true, StationSummary()});
+        }
+        slots_.clear();
+        mask_ = 0;
+        reports_.clear();
+        keys_.clear();
+        flags_.clear();
+        expiries_.clear();
+        epoch_.fetch_add(1, std::memory_order_release);
+    }
+    if (!changes.empty()) notify(changes);
+}
+
+uint64_t WeatherStationStore::addChangeListener(ChangeListener fn) {
+    std::lock_guard<std::mutex> lock(listenerMutex_);
+    uint64_t id = nextListenerId_++;
+    listeners_.emplace_back(id, std::move(fn));
+    listening_.store(true, std::memory_order_release);
+    return id;
+}
+
+bool WeatherStationStore::removeChangeListener(uint64_t id) {
+    std::lock_guard<std::mutex> lock(listenerMutex_);
+    auto it = std::find_if(listeners_.begin(), listeners_.end(),
+                           [id](const std::pair<uint64_t, ChangeListener>& entry) { return entry.first == id; });
+    if (it == listeners_.end()) return false;
+    listeners_.erase(it);
+    listening_.store(!listeners_.empty(), std::memory_order_release);
+    return true;
+}
+
+void WeatherStationStore::notify(const std::vector<StationChange>& changes) {
+    std::lock_guard<std::mutex> lock(listenerMutex_);
+    for (const auto& entry : listeners_) {
+        entry.second(changes);
+    }
+}
+
+size_t WeatherStationStore::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return reports_.size();
+}
+
+size_t WeatherStationStore::memoryBytes() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    size_t bytes = slots_.capacity() * sizeof(Slot) + reports_.capacity() * sizeof(Report) +
+                   keys_.capacity() * sizeof(StationKey) + flags_.capacity() * sizeof(uint16_t) +
+                   expiries_.capacity() * sizeof(time_t);
+    for (const Report& report : reports_) {
+        bytes += report.text.capacity();
+    }
+    return bytes;
+}
+
+// Private methods; callers hold the lock
+
+size_t WeatherStationStore::findSlot(StationKey key) const {
+    if (key == INVALID_STATION || slots_.empty()) return NPOS;
+    for (size_t i = home(key);; i = (i + 1) & mask_) {
+        if (slots_[i].key == key) return i;
+        if (slots_[i].key == INVALID_STATION) return NPOS;
+    }
+}
+
+void WeatherStationStore::store(StationKey key, Report&& report, std::vector<StationChange>* changes) {
+    size_t slot = findSlot(key);
+    if (slot != NPOS) {
+        uint32_t index = slots_[slot].index;
+        // An expired report being replaced counts as new
+        if (changes && (reports_[index].summary != report.summary || expiries_[index] <= report.storedAt)) {
+            changes->push_back({key, false, report.summary});
+        }
+        flags_[index] = report.summary.flags;
+        expiries_[index] = report.expiresAt;
+        reports_[index] = std::move(report);
+        return;
+    }
+
+    if ((reports_.size() + 1) * 2 > slots_.size()) {
+        rehash(std::max(slots_.size() * 2, MIN_SLOTS));
+    }
+    if (changes) changes->push_back({key, false, report.summary});
+    size_t i = home(key);
+    while (slots_[i].key != INVALID_STATION) i = (i + 1) & mask_;
+    slots_[i].key = key;
+    slots_[i].index = static_cast<uint32_t>(reports_.size());
+    flags_.push_back(report.summary.flags);
+    expiries_.push_back(report.expiresAt);
+    reports_.push_back(std::move(report));
+    keys_.push_back(key);
+}
+
+void WeatherStationStore::removeSlot(size_t slot) {
+    // Keep reports_ dense: the last report fills the removed one's place
+    uint32_t index = slots_[slot].index;
+    uint32_t last = static_cast<uint32_t>(reports_.size() - 1);
+    if (index != last) {
+        slots_[findSlot(keys_[last])].index = index;
+        reports_[index] = std::move(reports_[last]);
+        keys_[index] = keys_[last];
+        flags_[index] = flags_[last];
+        expiries_[index] = expiries_[last];
+    }
+    reports_.pop_back();
+    keys_.pop_back();
+    flags_.pop_back();
+    expiries_.pop_back();
+
+    // Backward-shift: pull later entries of the probe run into the hole
+    // unless that would move them before their home slot
+    size_t hole = slot;
+    for (size_t i = (slot + 1) & mask_; slots_[i].key != INVALID_STATION; i = (i + 1) & mask_) {
+        size_t probeDistance = (i - home(slots_[i].key)) & mask_;
+        if (probeDistance >= ((i - hole) & mask_)) {
+            slots_[hole] = slots_[i];
+            hole = i;
+        }
+    }
+    slots_[hole] = Slot();
+}
+
+void WeatherStationStore::rehash(size_t slotCount) {
+    slots_.assign(slotCount, Slot());
+    mask_ = slotCount - 1;
+    for (size_t index = 0; index < keys_.size(); ++index) {
+        size_t i = home(keys_[index]);
+        while (slots_[i].key != INVALID_STATION) i = (i + 1) & mask_;
+        slots_[i].key = keys_[index];
+        slots_[i].index = static_cast<uint32_t>(index);
+    }
+    reports_.reserve(slotCount / 2);
+    keys_.reserve(slotCount / 2);
+    flags_.reserve(slotCount / 2);
+    expiries_.reserve(slotCount / 2);
+}
+
+StationSummary summarizeObservation(const METARObservation& observation, std::string_view text) {
+    using namespace StationFlags;
+    StationSummary summary;
+    const double visibility = observation.visibilitySM;
+    const double ceiling = observation.ceilingFeet();
+    const int wind = observation.windSpeed;
+    auto set = [&](uint16_t flag, bool on) {
+        if (on) summary.flags |= flag;
+    };
+
+    // METARReport checks: whole statute miles, as in METARReport::visibility
+    const int wholeMiles = static_cast<int>(visibility);
+    const int temperature = observation.temperature;
+    const bool reportIcing = (temperature >= -20 && temperature <= 10) &&
+                             (observation.precipitation() || observation.thunderstorm());
+    set(FLIGHT_OK, wholeMiles >= 3 && ceiling >= 1000 && wind <= 30 && !(reportIcing && temperature < 5));
+    set(TAKEOFF_OK, wholeMiles >= 1 && ceiling >= 500 && wind <= 35);
+    set(LANDING_OK, wholeMiles >= 1 && ceiling >= 300 && wind <= 40);
+
+    // WeatherData hazards
+    bool rain = observation.hasWeather(METARWeather::RA) || observation.hasWeather(METARWeather::DZ);
+    bool snow = observation.hasWeather(METARWeather::SN) || observation.hasWeather(METARWeather::SG);
+    bool freezingRain = observation.hasWeather(METARWeather::FZ) && rain;
+    PrecipitationType precipitation = PrecipitationType::NONE;
+    if (freezingRain) precipitation = PrecipitationType::FREEZING_RAIN;
+    else if (rain && snow) precipitation = PrecipitationType::MIXED;
+    else if (rain) precipitation = PrecipitationType::RAIN;
+    else if (snow) precipitation = PrecipitationType::SNOW;
+    else if (observation.hasWeather(METARWeather::PL)) precipitation = PrecipitationType::ICE_PELLETS;
+    summary.precipitation = static_cast<uint8_t>(precipitation);
+
+    // Thunderstorms: present weather, CB in a layer, or TS/CB in remarks
+    bool thunderstorm = observation.thunderstorm();
+    for (size_t i = 0; i < observation.cloudCount; ++i) {
+        thunderstorm = thunderstorm || observation.clouds[i].cumulonimbus;
+    }
+    METARTokenizer remarks(observation.remarks(text));
+    std::string_view token;
+    while (!thunderstorm && remarks.next(token)) {
+        thunderstorm = token == "TS" || token.find("CB") != std::string_view::npos;
+    }
+
+    // Icing: between -40 and +10 degrees C with high humidity
+    double temperatureC = observation.hasTemperature ? observation.temperature : 15.0;
+    double dewpointC = !observation.hasTemperature ? 10.0
+                       : observation.hasDewpoint ? observation.dewpoint : observation.temperature;
+    bool icing = temperatureC >= -40.0 && temperatureC <= 10.0 && relativeHumidity(temperatureC, dewpointC) > 70.0;
+
+    set(THUNDERSTORM, thunderstorm);
+    set(ICING, icing);
+    set(FREEZING_RAIN, freezingRain);
+    set(PRECIPITATION, precipitation != PrecipitationType::NONE);
+    set(TURBULENCE, wind > 25);
+    set(LOW_VISIBILITY, visibility < 3.0);
+    set(HAZARDOUS, icing || thunderstorm || freezingRain || precipitation != PrecipitationType::NONE);
+
+    // WeatherData checks
+    set(VFR_OK, visibility >= 5.0 && ceiling >= 3000.0 && !icing && !thunderstorm);
+    set(IFR_OK, visibility >= 1.0 && ceiling >= 500.0 && !thunderstorm);
+    set(LANDING_MINIMUMS_OK, visibility >= 1.0 && ceiling >= 300.0 && !freezingRain && wind < 30);
+    if (visibility < 1.0 || ceiling < 500.0) summary.category = FlightCategory::LIFR;
+    else if (visibility < 3.0 || ceiling < 1000.0) summary.category = FlightCategory::IFR;
+    else if (visibility < 5.0 || ceiling < 3000.0) summary.category = FlightCategory::MVFR;
+    else summary.category = FlightCategory::VFR;
+
+    auto small = [](double value, double limit) {
+        return std::clamp(value, 0.0, limit);
+    };
+    if (ceiling < METARObservation::NO_CEILING_FEET) {
+        summary.ceilingHundredsFeet = static_cast<uint16_t>(small(ceiling / 100.0, StationSummary::NO_CEILING - 1));
+    }
+    summary.visibilityQuarterSM = static_cast<uint8_t>(small(visibility * 4.0, 255.0));
+    summary.windKnots = static_cast<uint8_t>(small(wind, 255.0));
+    summary.gustKnots = static_cast<uint8_t>(small(observation.windGust, 255.0));
+    return summary;
+}
+
+WeatherConditions conditionsFromObservation(const METARObservation& observation) {
+    WeatherConditions conditions;
+    conditions.windSpeed = observation.windSpeed;
+    conditions.windDirection = observation.windDirection;
+    conditions.visibility = observation.visibilitySM;
+    conditions.cloudBase = observation.ceilingFeet();
+    conditions.ceiling = conditions.cloudBase;
+    conditions.temperature = observation.temperature;
+    conditions.dewpoint = observation.hasDewpoint ? observation.dewpoint : observation.temperature;
+    conditions.precipitation = observation.precipitation();
+    conditions.turbulence = observation.windSpeed > 25;  // Rough estimate
+
+    // Icing typically occurs near or below freezing with moisture present
+    conditions.icing = (observation.temperature >= -20 && observation.temperature <= 10) &&
+                       (conditions.precipitation || observation.thunderstorm());
+    return conditions;
+}
+
+} // namespace AICopilot
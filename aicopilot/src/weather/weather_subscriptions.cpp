@@ -0,0 +1,227 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Weather Subscriptions Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/weather_subscriptions.hpp"
+#include "../include/geodesy.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+namespace AICopilot {
+
+namespace {
+
+Geodesy::UnitVector cross(const Geodesy::UnitVector& a, const Geodesy::UnitVector& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+double dot(const Geodesy::UnitVector& a, const Geodesy::UnitVector& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// Great-circle distance from p to the shorter arc between a and b
+double distanceToLegNM(const Geodesy::UnitVector& p, const Geodesy::UnitVector& a, const Geodesy::UnitVector& b) {
+    Geodesy::UnitVector n = cross(a, b);
+    double length = std::sqrt(dot(n, n));
+    double ends = std::min(Geodesy::chordDistanceNM(p, a), Geodesy::chordDistanceNM(p, b));
+    if (length < 1e-12) return ends;
+    n = {n.x / length, n.y / length, n.z / length};
+
+    // p's foot on the leg's great circle lies between the ends when it is
+    // on the inner side of both
+    double offPlane = dot(p, n);
+    Geodesy::UnitVector foot{p.x - offPlane * n.x, p.y - offPlane * n.y, p.z - offPlane * n.z};
+    if (dot(cross(a, foot), n) < 0.0 || dot(cross(foot, b), n) < 0.0) return ends;
+    return std::asin(std::min(1.0, std::abs(offPlane))) * Geodesy::EARTH_RADIUS_NM;
+}
+
+} // namespace
+
+WeatherSubscriptions::WeatherSubscriptions(std::shared_ptr<WeatherStationStore> store,
+                                           std::shared_ptr<const WeatherInterpolator> positions)
+    : store_(std::move(store)), positions_(std::move(positions)) {
+    listenerId_ = store_->addChangeListener([this](const std::vector<StationChange>& changes) {
+        onChanges(changes);
+    });
+}
+
+WeatherSubscriptions::~WeatherSubscriptions() {
+    store_->removeChangeListener(listenerId_);
+}
+
+WeatherSubscriptions::SubscriptionId WeatherSubscriptions::subscribeStations(
+    const std::vector<std::string>& icaos, WeatherChangeCallback callback, const WeatherChangeThresholds& thresholds,
+    time_t now) {
+    Subscription subscription;
+    for (const std::string& icao : icaos) {
+        StationKey key = packStationId(icao);
+        if (key != INVALID_STATION) subscription.stations.insert(key);
+    }
+    if (subscription.stations.empty() || !callback) return INVALID_SUBSCRIPTION;
+    subscription.scope = Scope::STATIONS;
+    subscription.thresholds = thresholds;
+    subscription.callback = std::make_shared<const WeatherChangeCallback>(std::move(callback));
+    return add(std::move(subscription), now);
+}
+
+WeatherSubscriptions::SubscriptionId WeatherSubscriptions::subscribeRegion(
+    double latitude, double longitude, double radiusNM, WeatherChangeCallback callback,
+    const WeatherChangeThresholds& thresholds, time_t now) {
+    if (!positions_ || !callback || !(radiusNM > 0.0) || !std::isfinite(latitude) || !std::isfinite(longitude)) {
+        return INVALID_SUBSCRIPTION;
+    }
+    Subscription subscription;
+    subscription.scope = Scope::REGION;
+    subscription.latitude = latitude;
+    subscription.longitude = longitude;
+    subscription.rangeNM = radiusNM;
+    subscription.thresholds = thresholds;
+    subscription.callback = std::make_shared<const WeatherChangeCallback>(std::move(callback));
+    return add(std::move(subscription), now);
+}
+
+WeatherSubscriptions::SubscriptionId WeatherSubscriptions::subscribeCorridor(
+    const std::vector<Position>& route, double halfWidthNM, WeatherChangeCallback callback,
+    const WeatherChangeThresholds& thresholds, time_t now) {
+    if (!positions_ || !callback || route.empty() || !(halfWidthNM > 0.0)) return INVALID_SUBSCRIPTION;
+    Subscription subscription;
+    subscription.scope = Scope::CORRIDOR;
+    subscription.route = route;
+    subscription.rangeNM = halfWidthNM;
+    subscription.thresholds = thresholds;
+    subscription.callback = std::make_shared<const WeatherChangeCallback>(std::move(callback));
+    return add(std::move(subscription), now);
+}
+
+bool WeatherSubscriptions::unsubscribe(SubscriptionId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscriptions_.erase(id) != 0;
+}
+
+size_t WeatherSubscriptions::subscriptionCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscriptions_.size();
+}
+
+WeatherSubscriptions::SubscriptionId WeatherSubscriptions::add(Subscription&& subscription, time_t now) {
+    // Start from what the store holds now. Stores write before they
+    // notify, so holding the lock across the snapshot and the insert means
+    // no change falls between them.
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::pair<StationKey, StationSummary>> current;
+    store_->forEach([&](StationKey station, const WeatherStationStore::Report& report) {
+        current.emplace_back(station, report.summary);
+    }, now);
+    for (const auto& entry : current) {
+        StationPosition position;
+        const StationPosition* placed =
+            positions_ && positions_->getStationPosition(entry.first, position) ? &position : nullptr;
+        if (inScope(subscription, entry.first, placed)) subscription.known[entry.first] = entry.second;
+    }
+
+    SubscriptionId id = nextId_++;
+    subscriptions_.emplace(id, std::move(subscription));
+    return id;
+}
+
+bool WeatherSubscriptions::inScope(const Subscription& subscription, StationKey station,
+                                   const StationPosition* position) const {
+    switch (subscription.scope) {
+    case Scope::STATIONS:
+        return subscription.stations.count(station) != 0;
+    case Scope::REGION:
+        return position && Geodesy::haversineNM(subscription.latitude, subscription.longitude,
+                                                position->latitude, position->longitude) <= subscription.rangeNM;
+    case Scope::CORRIDOR: {
+        if (!position) return false;
+        Geodesy::UnitVector p = Geodesy::toUnitVector(position->latitude, position->longitude);
+        const std::vector<Position>& route = subscription.route;
+        Geodesy::UnitVector from = Geodesy::toUnitVector(route[0].latitude, route[0].longitude);
+        if (Geodesy::chordDistanceNM(p, from) <= subscription.rangeNM) return true;
+        for (size_t i = 1; i < route.size(); ++i) {
+            Geodesy::UnitVector to = Geodesy::toUnitVector(route[i].latitude, route[i].longitude);
+            if (distanceToLegNM(p, from, to) <= subscription.rangeNM) return true;
+            from = to;
+        }
+        return false;
+    }
+    }
+    return false;
+}
+
+uint8_t WeatherSubscriptions::materialChange(const WeatherChangeThresholds& thresholds,
+                                             const StationSummary& previous, const StationSummary& current) {
+    uint8_t reasons = 0;
+    if (thresholds.category && previous.category != current.category) reasons |= WeatherChangeReason::CATEGORY;
+    if ((previous.flags ^ current.flags) & thresholds.flagMask) reasons |= WeatherChangeReason::FLAGS;
+    int wind = std::abs(static_cast<int>(current.windKnots) - previous.windKnots);
+    int gust = std::abs(static_cast<int>(current.gustKnots) - previous.gustKnots);
+    if ((thresholds.windKnots > 0 && wind >= thresholds.windKnots) ||
+        (thresholds.gustKnots > 0 && gust >= thresholds.gustKnots)) {
+        reasons |= WeatherChangeReason::WIND;
+    }
+    return reasons;
+}
+
+void WeatherSubscriptions::onChanges(const std::vector<StationChange>& changes) {
+    std::vector<std::pair<std::shared_ptr<const WeatherChangeCallback>, std::vector<WeatherChange>>> deliveries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (subscriptions_.empty()) return;
+
+        // Place each changed station once for every spatial scope
+        std::vector<StationPosition> positions(changes.size());
+        std::vector<uint8_t> placed(changes.size(), 0);
+        if (positions_) {
+            for (size_t i = 0; i < changes.size(); ++i) {
+                placed[i] = positions_->getStationPosition(changes[i].station, positions[i]) ? 1 : 0;
+            }
+        }
+
+        for (auto& entry : subscriptions_) {
+            Subscription& subscription = entry.second;
+            std::vector<WeatherChange> material;
+            for (size_t i = 0; i < changes.size(); ++i) {
+                const StationChange& change = changes[i];
+                if (!inScope(subscription, change.station, placed[i] ? &positions[i] : nullptr)) continue;
+
+                WeatherChange out;
+                out.station = change.station;
+                auto known = subscription.known.find(change.station);
+                if (change.removed) {
+                    if (known == subscription.known.end()) continue;
+                    out.reasons = WeatherChangeReason::REMOVED;
+                    out.previous = known->second;
+                    subscription.known.erase(known);
+                } else if (known == subscription.known.end()) {
+                    out.reasons = WeatherChangeReason::REPORTED;
+                    out.current = change.summary;
+                    subscription.known.emplace(change.station, change.summary);
+                } else {
+                    out.reasons = materialChange(subscription.thresholds, known->second, change.summary);
+                    if (out.reasons == 0) continue;
+                    out.previous = known->second;
+                    out.current = change.summary;
+                    known->second = change.summary;
+                }
+                material.push_back(out);
+            }
+            if (!material.empty()) deliveries.emplace_back(subscription.callback, std::move(material));
+        }
+    }
+
+    for (const auto& delivery : deliveries) {
+        (*delivery.first)(delivery.second);
+    }
+}
+
+} // namespace AICopilot
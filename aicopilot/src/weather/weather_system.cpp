@@ -8,6 +8,9 @@
 *****************************************************************************/
 
 #include "weather_system.h"
+#include "hazard_grid.hpp"
+#include "weather_interpolator.hpp"
+#include "weather_station_store.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -51,6 +54,19 @@ void WeatherSystem::updateWeatherConditions(const WeatherConditions& conditions)
     }
 }
 
+bool WeatherSystem::updateFromStation(const std::string& icao) {
+    if (!stationStore_) return false;
+    
+    WeatherConditions conditions;
+    bool found = stationStore_->visit(icao, [&](const WeatherStationStore::Report& report) {
+        conditions = conditionsFromObservation(report.observation);
+    });
+    if (found) {
+        updateWeatherConditions(conditions);
+    }
+    return found;
+}
+
 std::vector<WeatherHazard> WeatherSystem::detectHazardsAlongRoute(
     const Position& start,
     const Position& end,
@@ -58,16 +74,38 @@ std::vector<WeatherHazard> WeatherSystem::detectHazardsAlongRoute(
     
     std::vector<WeatherHazard> hazards;
     
-    // Return active hazards (simplified - real implementation would check spatial proximity)
+    // Hazards in the current conditions
     for (const auto& hazard : activeHazards_) {
         hazards.push_back(hazard);
     }
     
+    // Positioned hazards the leg passes through, from a walk over the grid
+    if (hazardGrid_) {
+        std::vector<uint32_t> ids;
+        hazardGrid_->hazardsAlongSegment(start, end, altitude, ids);
+        for (uint32_t id : ids) {
+            hazards.push_back(*hazardGrid_->getHazard(id));
+        }
+    }
+    
+    // Station weather sampled along the leg; consecutive samples mostly
+    // share interpolator cells, so this stays cheap over long routes
+    if (interpolator_) {
+        std::vector<InterpolatedWeather> samples;
+        std::vector<Position> points;
+        interpolator_->sampleRoute({start, end}, ROUTE_SAMPLE_SPACING_NM, samples, &points);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            if (samples[i].stationCount > 0) {
+                appendSampledHazards(samples[i], points[i], altitude, hazards);
+            }
+        }
+    }
+    
     return hazards;
 }
 
 bool WeatherSystem::hasWeatherHazard(const Position& pos, double altitude) const {
-    return !activeHazards_.empty();
+    return getWeatherHazard(pos, altitude).type != WeatherHazardType::NONE;
 }
 
 WeatherHazard WeatherSystem::getWeatherHazard(const Position& pos, double altitude) const {
@@ -75,6 +113,23 @@ WeatherHazard WeatherSystem::getWeatherHazard(const Position& pos, double altitu
         return activeHazards_[0];
     }
     
+    if (hazardGrid_) {
+        std::vector<uint32_t> ids;
+        hazardGrid_->hazardsAt(pos.latitude, pos.longitude, altitude, ids);
+        if (!ids.empty()) {
+            return *hazardGrid_->getHazard(ids[0]);
+        }
+    }
+    
+    InterpolatedWeather sample;
+    if (interpolator_ && interpolator_->sample(pos.latitude, pos.longitude, sample)) {
+        std::vector<WeatherHazard> hazards;
+        appendSampledHazards(sample, pos, altitude, hazards);
+        if (!hazards.empty()) {
+            return hazards[0];
+        }
+    }
+    
     WeatherHazard noHazard;
     noHazard.type = WeatherHazardType::NONE;
     noHazard.severity = HazardSeverity::LIGHT;
@@ -151,6 +206,14 @@ std::vector<WeatherRadarReturn> WeatherSystem::getRadarReturns(
         }
     }
     
+    // Precipitation the grid holds around the aircraft, one return per cell column
+    if (hazardGrid_) {
+        hazardGrid_->radarReturns(pos.latitude, pos.longitude, range,
+                                  hazardTypeBit(WeatherHazardType::THUNDERSTORM) |
+                                      hazardTypeBit(WeatherHazardType::MICROBURST),
+                                  returns);
+    }
+    
     return returns;
 }
 
@@ -170,6 +233,13 @@ double WeatherSystem::getRecommendedAltitude(
 }
 
 bool WeatherSystem::hasWindShear(const Position& pos, double altitude) const {
+    if (hazardGrid_) {
+        HazardGridSample cell = hazardGrid_->sample(pos.latitude, pos.longitude, altitude);
+        if (cell.has(WeatherHazardType::WIND_SHEAR) || cell.has(WeatherHazardType::MICROBURST)) {
+            return true;
+        }
+    }
+    
     // Simplified wind shear detection
     return currentWeather_.windSpeed > 30.0 && altitude < 1000.0;
 }
@@ -205,6 +275,46 @@ double WeatherSystem::calculateVisibilityRisk() const {
     return 0.0;
 }
 
+void WeatherSystem::appendSampledHazards(const InterpolatedWeather& sample, const Position& pos,
+                                         double altitude, std::vector<WeatherHazard>& hazards) const {
+    const WeatherConditions& wx = sample.conditions;
+    auto add = [&](WeatherHazardType type, HazardSeverity severity, double top, const char* description) {
+        WeatherHazard hazard;
+        hazard.type = type;
+        hazard.severity = severity;
+        hazard.position = pos;
+        hazard.radius = WeatherInterpolator::CELL_SIZE_DEG * 60.0;   // about one cell
+        hazard.altitude = 0.0;
+        hazard.topAltitude = top;
+        hazard.description = description;
+        hazards.push_back(hazard);
+    };
+    
+    if (sample.thunderstormShare >= 0.5) {
+        add(WeatherHazardType::THUNDERSTORM,
+            sample.thunderstormShare >= 0.9 ? HazardSeverity::SEVERE : HazardSeverity::MODERATE,
+            40000.0, "Thunderstorms reported nearby");
+    }
+    
+    // Surface temperatures in the icing band make icing likely in the lower levels
+    const double icingTop = 10000.0;
+    if (wx.icing && altitude < icingTop) {
+        add(WeatherHazardType::SEVERE_ICING, HazardSeverity::MODERATE, icingTop,
+            "Icing conditions reported nearby");
+    }
+    
+    // Surface visibility and winds only matter near the ground
+    const double surfaceTop = 3000.0;
+    if (altitude < surfaceTop && wx.visibility < 1.0) {
+        add(WeatherHazardType::LOW_VISIBILITY, HazardSeverity::SEVERE, surfaceTop,
+            "Low visibility reported nearby");
+    }
+    if (altitude < surfaceTop && wx.windSpeed > 30.0) {
+        add(WeatherHazardType::STRONG_WINDS, HazardSeverity::MODERATE, surfaceTop,
+            "Strong surface winds reported nearby");
+    }
+}
+
 HazardSeverity WeatherSystem::determineSeverity(const WeatherConditions& wx) const {
     int score = 0;
     
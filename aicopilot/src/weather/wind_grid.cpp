@@ -0,0 +1,182 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Wind Grid Implementation
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include "../include/wind_grid.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AICopilot {
+
+namespace {
+
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+
+// ISA static temperature below the tropopause
+double isaTemperature(double altitudeFeet) {
+    return 15.0 - 1.98 * std::min(altitudeFeet, 36089.0) / 1000.0;
+}
+
+// Cell index and fraction along an even axis, clamped to its ends
+void locateOnAxis(const WindGrid::Axis& axis, double value, size_t& index, double& fraction) {
+    if (axis.count < 2) {
+        index = 0;
+        fraction = 0.0;
+        return;
+    }
+    double r = std::clamp((value - axis.origin) / axis.step, 0.0, static_cast<double>(axis.count - 1));
+    index = std::min(static_cast<size_t>(r), axis.count - 2);
+    fraction = r - static_cast<double>(index);
+}
+
+} // namespace
+
+void WindGridLegBatch::resize(size_t count) {
+    latitude.resize(count);
+    longitude.resize(count);
+    altitude.resize(count);
+    time.resize(count);
+    trackRad.resize(count);
+    trueAirspeed.resize(count);
+}
+
+size_t WindGridLegBatch::add(double lat, double lon, double altitudeFeet, double timeSeconds,
+                             double track, double tas) {
+    latitude.push_back(lat);
+    longitude.push_back(lon);
+    altitude.push_back(altitudeFeet);
+    time.push_back(timeSeconds);
+    trackRad.push_back(track);
+    trueAirspeed.push_back(tas);
+    return latitude.size() - 1;
+}
+
+bool WindGrid::configure(const Axis& latitude, const Axis& longitude,
+                         const std::vector<double>& levels, const Axis& time) {
+    for (const Axis* axis : {&latitude, &longitude, &time}) {
+        if (axis->count == 0 || !(axis->step > 0.0)) return false;
+    }
+    if (levels.empty() || !std::is_sorted(levels.begin(), levels.end()) ||
+        std::adjacent_find(levels.begin(), levels.end()) != levels.end()) {
+        return false;
+    }
+
+    latitude_ = latitude;
+    longitude_ = longitude;
+    levels_ = levels;
+    time_ = time;
+
+    const size_t points = latitude.count * longitude.count * levels.size() * time.count;
+    east_.assign(points, 0.0f);
+    north_.assign(points, 0.0f);
+    temperature_.resize(points);
+    for (size_t t = 0; t < time.count; ++t) {
+        for (size_t k = 0; k < levels.size(); ++k) {
+            float isa = static_cast<float>(isaTemperature(levels[k]));
+            std::fill_n(temperature_.begin() + offset(0, 0, k, t), latitude.count * longitude.count, isa);
+        }
+    }
+
+    // Corner c steps +1 along lon (bit 0), lat (bit 1), level (bit 2), time (bit 3);
+    // single-point axes step 0 so the unused corner stays in range
+    const size_t lonStep = longitude.count > 1 ? 1 : 0;
+    const size_t latStep = latitude.count > 1 ? longitude.count : 0;
+    const size_t levelStep = levels.size() > 1 ? latitude.count * longitude.count : 0;
+    const size_t timeStep = time.count > 1 ? levels.size() * latitude.count * longitude.count : 0;
+    for (size_t c = 0; c < CORNERS; ++c) {
+        cornerOffset_[c] = static_cast<uint32_t>((c & 1 ? lonStep : 0) + (c & 2 ? latStep : 0) +
+                                                 (c & 4 ? levelStep : 0) + (c & 8 ? timeStep : 0));
+    }
+    maxWindSpeed_ = 0.0;
+    return true;
+}
+
+void WindGrid::setPoint(size_t latIndex, size_t lonIndex, size_t levelIndex, size_t timeIndex,
+                        double windDirection, double windSpeed, double temperatureC) {
+    const size_t at = offset(latIndex, lonIndex, levelIndex, timeIndex);
+    // Direction is where the wind comes from; store the vector it blows along
+    east_[at] = static_cast<float>(-windSpeed * std::sin(windDirection * DEG_TO_RAD));
+    north_[at] = static_cast<float>(-windSpeed * std::cos(windDirection * DEG_TO_RAD));
+    temperature_[at] = static_cast<float>(temperatureC);
+    maxWindSpeed_ = std::max(maxWindSpeed_, std::abs(windSpeed));
+}
+
+WindGridSample WindGrid::sample(double lat, double lon, double altitudeFeet, double timeSeconds) const {
+    WindGridSample result;
+    if (!isConfigured()) return result;
+    WindGridLegBatch batch;
+    batch.add(lat, lon, altitudeFeet, timeSeconds, 0.0, 0.0);
+    locate(batch);
+    blend(batch, 0, result.eastKts, result.northKts, result.temperatureC);
+    return result;
+}
+
+void WindGrid::locate(WindGridLegBatch& batch) const {
+    const size_t count = batch.size();
+    batch.base_.resize(count);
+    batch.weights_.resize(count * CORNERS);
+
+    for (size_t i = 0; i < count; ++i) {
+        size_t lat, lon, time, level = 0;
+        double fLat, fLon, fTime, fLevel = 0.0;
+        locateOnAxis(latitude_, batch.latitude[i], lat, fLat);
+        locateOnAxis(longitude_, batch.longitude[i], lon, fLon);
+        locateOnAxis(time_, batch.time[i], time, fTime);
+        if (levels_.size() > 1) {
+            double altitude = std::clamp(batch.altitude[i], levels_.front(), levels_.back());
+            level = std::upper_bound(levels_.begin(), levels_.end(), altitude) - levels_.begin();
+            level = std::min(level, levels_.size() - 1) - 1;
+            fLevel = (altitude - levels_[level]) / (levels_[level + 1] - levels_[level]);
+        }
+        batch.base_[i] = static_cast<uint32_t>(offset(lat, lon, level, time));
+
+        float* w = &batch.weights_[i * CORNERS];
+        for (size_t c = 0; c < CORNERS; ++c) {
+            w[c] = static_cast<float>((c & 1 ? fLon : 1.0 - fLon) * (c & 2 ? fLat : 1.0 - fLat) *
+                                      (c & 4 ? fLevel : 1.0 - fLevel) * (c & 8 ? fTime : 1.0 - fTime));
+        }
+    }
+}
+
+void WindGrid::evaluate(WindGridLegBatch& batch) const {
+    const size_t count = batch.size();
+    batch.groundSpeed.resize(count);
+    batch.alongTrackWind.resize(count);
+    batch.temperatureC.resize(count);
+    if (count == 0 || !isConfigured()) {
+        std::fill(batch.alongTrackWind.begin(), batch.alongTrackWind.end(), 0.0);
+        std::fill(batch.temperatureC.begin(), batch.temperatureC.end(), 0.0);
+        std::copy(batch.trueAirspeed.begin(), batch.trueAirspeed.end(), batch.groundSpeed.begin());
+        return;
+    }
+
+    locate(batch);
+
+    // Blend the corners; along-track wind and ground speed use the scratch outputs
+    std::vector<double>& east = batch.groundSpeed;
+    std::vector<double>& north = batch.alongTrackWind;
+    for (size_t i = 0; i < count; ++i) {
+        blend(batch, i, east[i], north[i], batch.temperatureC[i]);
+    }
+
+    // Wind triangle: fly the track with the crosswind corrected out
+    for (size_t i = 0; i < count; ++i) {
+        const double s = std::sin(batch.trackRad[i]);
+        const double c = std::cos(batch.trackRad[i]);
+        const double tas = batch.trueAirspeed[i];
+        const double along = east[i] * s + north[i] * c;
+        const double cross = east[i] * c - north[i] * s;
+        const double groundSpeed = std::sqrt(std::max(tas * tas - cross * cross, 0.0)) + along;
+        batch.alongTrackWind[i] = along;
+        batch.groundSpeed[i] = std::max(groundSpeed, tas * MIN_GROUND_SPEED_FRACTION);
+    }
+}
+
+} // namespace AICopilot
@@ -1,8 +1,7 @@
 /*****************************************************************************
 * Copyright 2025 AI Copilot FS Project
 *
-* Weather Data Implementation - Production-ready METAR/TAF parsing
-* Includes caching, TTL management, and comprehensive error handling
+* Weather Data Implementation - unit conversions and flight categories
 *
 * This program is free software: you can redistribute it and/or modify
 * it under the terms of the GNU General Public License as published by
@@ -11,19 +10,9 @@
 *****************************************************************************/
 
 #include "weather_data.h"
-#include "metar_parser.hpp"
-#include <sstream>
-#include <iostream>
 #include <algorithm>
-#include <cctype>
-#include <ctime>
-#include <iomanip>
 #include <cmath>
 
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
-
 namespace AICopilot {
 
 // ============================================================================
@@ -61,7 +50,7 @@ double WeatherData::getTemperatureFahrenheit() const {
     return (temperatureCelsius * 9.0 / 5.0) + 32.0;
 }
 
-double WeatherData::getRelativeHumidity() const {
+double relativeHumidity(double temperatureCelsius, double dewpointCelsius) {
     // Magnus formula for relative humidity calculation
     double a = 17.27;
     double b = 237.7;
@@ -73,6 +62,10 @@ double WeatherData::getRelativeHumidity() const {
     return std::max(0.0, std::min(100.0, rh));
 }
 
+double WeatherData::getRelativeHumidity() const {
+    return relativeHumidity(temperatureCelsius, dewpointCelsius);
+}
+
 double WeatherData::getVisibilityMeters() const {
     return visibilityStatuteMiles * 1609.34;
 }
@@ -108,459 +101,4 @@ bool WeatherData::isSuitableForLanding() const {
            !hasFreezingRain && wind.speedKnots < 30;
 }
 
-// ============================================================================
-// WeatherDatabase Implementation
-// ============================================================================
-
-WeatherDatabase::WeatherDatabase() : totalCacheSize_(0) {}
-
-WeatherDatabase::~WeatherDatabase() {
-    shutdown();
-}
-
-bool WeatherDatabase::initialize() {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    weatherCache_.clear();
-    totalCacheSize_ = 0;
-    InitializeSampleAirports();
-    return true;
-}
-
-void WeatherDatabase::shutdown() {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    weatherCache_.clear();
-    totalCacheSize_ = 0;
-}
-
-WeatherData WeatherDatabase::GetWeatherAt(const std::string& icaoCode, long timeSeconds) {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    
-    auto it = weatherCache_.find(icaoCode);
-    if (it != weatherCache_.end() && !IsExpired(it->second)) {
-        it->second.accessCount++;
-        return it->second.data;
-    }
-    
-    return GetDefaultWeather(icaoCode);
-}
-
-WeatherData WeatherDatabase::ParseMETAR(const std::string& metarString) {
-    WeatherData wx;
-    wx.isValid = false;
-    wx.timestampUnix = std::time(nullptr);
-    wx.temperatureCelsius = 15.0;
-    wx.dewpointCelsius = 10.0;
-    wx.visibilityStatuteMiles = 10.0;
-    wx.ceilingFeet = 5000.0;
-    wx.altimeterSettingInHg = 29.92;
-    wx.altimeterSettingMbar = 1013.0;
-    wx.precipitation = PrecipitationType::NONE;
-    wx.isIcingCondition = false;
-    wx.hasThunderstorm = false;
-    wx.hasFreezingRain = false;
-    wx.hasTurbulence = false;
-    wx.skyCondition = WeatherConditionType::SCATTERED;
-    
-    // Tokenize METAR
-    std::vector<std::string> tokens = METARParser::tokenizeMETAR(metarString);
-    if (tokens.empty()) {
-        wx.parseError = "Empty METAR string";
-        return wx;
-    }
-    
-    try {
-        size_t i = 0;
-        
-        // Station ID (required)
-        if (i < tokens.size()) {
-            parseStationId(tokens[i], wx);
-            i++;
-        }
-        
-        // Date/Time (required)
-        if (i < tokens.size()) {
-            parseDateTime(tokens[i], wx);
-            i++;
-        }
-        
-        // Wind (required)
-        if (i < tokens.size()) {
-            parseWind(tokens[i], wx);
-            i++;
-        }
-        
-        // Parse remaining tokens
-        while (i < tokens.size()) {
-            const std::string& tok = tokens[i];
-            
-            if (tok == "RMK") {
-                i++;
-                while (i < tokens.size()) {
-                    parseRemark(tokens[i], wx);
-                    i++;
-                }
-                break;
-            }
-            
-            // Visibility
-            if (METARParser::matchesPattern(tok, "^[0-9]{4}$|^[0-9]+SM$")) {
-                parseVisibility(tok, wx);
-            }
-            // Weather phenomena
-            else if (METARParser::matchesPattern(tok, "^[+\\-]?[A-Z]{2,4}$")) {
-                parseWeatherPhenomena(tok, wx);
-            }
-            // Cloud layers
-            else if (METARParser::matchesPattern(tok, "^(SKC|CLR|FEW|SCT|BKN|OVC|VV)")) {
-                parseCloudLayers(tok, wx);
-            }
-            // Temperature/Dewpoint
-            else if (METARParser::matchesPattern(tok, "^M?[0-9]{2}/M?[0-9]{2}$")) {
-                parseTemperatureDewpoint(tok, wx);
-            }
-            // Altimeter
-            else if (METARParser::matchesPattern(tok, "^[AQ][0-9]{4}$")) {
-                parseAltimeter(tok, wx);
-            }
-            
-            i++;
-        }
-        
-        DeriveConditions(wx);
-        wx.isValid = true;
-        
-    } catch (const std::exception& e) {
-        wx.parseError = std::string("Parse exception: ") + e.what();
-        wx.isValid = false;
-    }
-    
-    return wx;
-}
-
-std::vector<WeatherData> WeatherDatabase::ParseTAF(const std::string& tafString) {
-    std::vector<WeatherData> forecasts;
-    // TAF parsing is similar to METAR, simplified for this implementation
-    WeatherData taf = ParseMETAR(tafString);  // Basic implementation
-    if (taf.isValid) {
-        forecasts.push_back(taf);
-    }
-    return forecasts;
-}
-
-// ========== Accessor Methods ==========
-
-double WeatherDatabase::GetVisibility(const std::string& icaoCode) {
-    auto wx = GetWeatherAt(icaoCode);
-    return wx.visibilityStatuteMiles;
-}
-
-double WeatherDatabase::GetCeiling(const std::string& icaoCode) {
-    auto wx = GetWeatherAt(icaoCode);
-    return wx.ceilingFeet;
-}
-
-WindData WeatherDatabase::GetWindData(const std::string& icaoCode) {
-    auto wx = GetWeatherAt(icaoCode);
-    return wx.wind;
-}
-
-double WeatherDatabase::GetTemperature(const std::string& icaoCode) {
-    auto wx = GetWeatherAt(icaoCode);
-    return wx.temperatureCelsius;
-}
-
-double WeatherDatabase::GetDewpoint(const std::string& icaoCode) {
-    auto wx = GetWeatherAt(icaoCode);
-    return wx.dewpointCelsius;
-}
-
-double WeatherDatabase::GetAltimeter(const std::string& icaoCode) {
-    auto wx = GetWeatherAt(icaoCode);
-    return wx.altimeterSettingInHg;
-}
-
-bool WeatherDatabase::HasHazardousConditions(const std::string& icaoCode) {
-    auto wx = GetWeatherAt(icaoCode);
-    return wx.isIcingCondition || wx.hasThunderstorm || 
-           wx.hasFreezingRain || wx.precipitation != PrecipitationType::NONE;
-}
-
-PrecipitationType WeatherDatabase::GetPrecipitationType(const std::string& icaoCode) {
-    auto wx = GetWeatherAt(icaoCode);
-    return wx.precipitation;
-}
-
-// ========== Cache Management ==========
-
-void WeatherDatabase::ClearCache() {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    weatherCache_.clear();
-    totalCacheSize_ = 0;
-}
-
-bool WeatherDatabase::UpdateCache(const std::string& icaoCode, const std::string& metarString) {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    
-    WeatherData wx = ParseMETAR(metarString);
-    if (!wx.isValid) return false;
-    
-    // Check cache size before adding
-    if (weatherCache_.size() >= MAX_CACHE_ENTRIES ||
-        totalCacheSize_ > MAX_CACHE_SIZE_MB * 1024 * 1024) {
-        EvictOldestEntry();
-    }
-    
-    CachedWeather cached;
-    cached.data = wx;
-    cached.cacheTime = std::chrono::system_clock::now();
-    cached.accessCount = 0;
-    cached.estimatedSize = sizeof(WeatherData) + icaoCode.size();
-    
-    totalCacheSize_ += cached.estimatedSize;
-    weatherCache_[icaoCode] = cached;
-    
-    return true;
-}
-
-size_t WeatherDatabase::GetCacheSize() const {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    return totalCacheSize_;
-}
-
-int WeatherDatabase::GetCacheEntryCount() const {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    return weatherCache_.size();
-}
-
-void WeatherDatabase::RefreshExpiredEntries() {
-    std::lock_guard<std::mutex> lock(cacheMutex_);
-    
-    auto it = weatherCache_.begin();
-    while (it != weatherCache_.end()) {
-        if (IsExpired(it->second)) {
-            totalCacheSize_ -= it->second.estimatedSize;
-            it = weatherCache_.erase(it);
-        } else {
-            ++it;
-        }
-    }
-}
-
-// ========== Private Methods ==========
-
-void WeatherDatabase::parseStationId(const std::string& token, WeatherData& wx) {
-    if (token.size() == 4 && METARParser::isValidICAOCode(token)) {
-        wx.icaoCode = token;
-    }
-}
-
-void WeatherDatabase::parseDateTime(const std::string& token, WeatherData& wx) {
-    // Format: "121856Z" (12th day, 18:56 UTC)
-    if (token.size() >= 6 && token.back() == 'Z') {
-        try {
-            int day = std::stoi(token.substr(0, 2));
-            int hour = std::stoi(token.substr(2, 2));
-            int minute = std::stoi(token.substr(4, 2));
-            
-            // Simple timestamp approximation
-            time_t now = std::time(nullptr);
-            struct tm* timeinfo = std::gmtime(&now);
-            timeinfo->tm_mday = day;
-            timeinfo->tm_hour = hour;
-            timeinfo->tm_min = minute;
-            wx.timestampUnix = std::mktime(timeinfo);
-        } catch (...) {
-            wx.timestampUnix = std::time(nullptr);
-        }
-    }
-}
-
-void WeatherDatabase::parseWind(const std::string& token, WeatherData& wx) {
-    int direction, speed, gust;
-    bool variable;
-    int minDir, maxDir;
-    
-    if (METARParser::parseWind(token, direction, speed, gust, variable, minDir, maxDir)) {
-        wx.wind.directionDegrees = direction;
-        wx.wind.speedKnots = speed;
-        wx.wind.gustKnots = gust;
-        wx.wind.isVariable = variable;
-        wx.wind.variableMinDir = minDir;
-        wx.wind.variableMaxDir = maxDir;
-    }
-}
-
-void WeatherDatabase::parseVisibility(const std::string& token, WeatherData& wx) {
-    double visibility;
-    if (METARParser::parseVisibility(token, visibility)) {
-        wx.visibilityStatuteMiles = visibility;
-    }
-}
-
-void WeatherDatabase::parseWeatherPhenomena(const std::string& token, WeatherData& wx) {
-    WeatherPhenomenaCode code;
-    int intensity;
-    
-    if (METARParser::parseWeatherPhenomena(token, code, intensity)) {
-        wx.weatherCodes.push_back(token);
-        
-        if (code == WeatherPhenomenaCode::TS || code == WeatherPhenomenaCode::TSRA ||
-            code == WeatherPhenomenaCode::TSSN) {
-            wx.hasThunderstorm = true;
-        }
-        
-        if (code == WeatherPhenomenaCode::RA) {
-            wx.precipitation = PrecipitationType::RAIN;
-        } else if (code == WeatherPhenomenaCode::SN) {
-            wx.precipitation = PrecipitationType::SNOW;
-        } else if (code == WeatherPhenomenaCode::FZRA) {
-            wx.hasFreezingRain = true;
-            wx.precipitation = PrecipitationType::FREEZING_RAIN;
-        }
-    }
-}
-
-void WeatherDatabase::parseCloudLayers(const std::string& token, WeatherData& wx) {
-    CloudCoverage coverage;
-    int altitudeAgl;
-    bool isCB, isTCU;
-    
-    if (METARParser::parseCloudLayer(token, coverage, altitudeAgl, isCB, isTCU)) {
-        CloudLayer layer;
-        switch (coverage) {
-            case CloudCoverage::FEW: layer.coverage = WeatherConditionType::FEW; break;
-            case CloudCoverage::SCT: layer.coverage = WeatherConditionType::SCATTERED; break;
-            case CloudCoverage::BKN: layer.coverage = WeatherConditionType::BROKEN; break;
-            case CloudCoverage::OVC: layer.coverage = WeatherConditionType::OVERCAST; break;
-            default: return;
-        }
-        layer.altitudeAgl = altitudeAgl;
-        layer.isCumulonimbus = isCB;
-        layer.isToweringCumulus = isTCU;
-        wx.cloudLayers.push_back(layer);
-    }
-}
-
-void WeatherDatabase::parseTemperatureDewpoint(const std::string& token, WeatherData& wx) {
-    int temperature, dewpoint;
-    if (METARParser::parseTemperatureDewpoint(token, temperature, dewpoint)) {
-        wx.temperatureCelsius = temperature;
-        wx.dewpointCelsius = dewpoint;
-    }
-}
-
-void WeatherDatabase::parseAltimeter(const std::string& token, WeatherData& wx) {
-    double inHg, mbar;
-    if (METARParser::parseAltimeter(token, inHg, mbar)) {
-        wx.altimeterSettingInHg = inHg;
-        wx.altimeterSettingMbar = mbar;
-    }
-}
-
-void WeatherDatabase::parseRemark(const std::string& remark, WeatherData& wx) {
-    // Parse remarks (simplified)
-    if (remark.find("CB") != std::string::npos) {
-        wx.hasThunderstorm = true;
-    }
-}
-
-WeatherData WeatherDatabase::GetDefaultWeather(const std::string& icaoCode) {
-    WeatherData wx;
-    wx.icaoCode = icaoCode;
-    wx.timestampUnix = std::time(nullptr);
-    wx.temperatureCelsius = 15.0;
-    wx.dewpointCelsius = 10.0;
-    wx.wind = {180, 8, 0, false, 0, 0};
-    wx.visibilityStatuteMiles = 10.0;
-    wx.ceilingFeet = 5000.0;
-    wx.altimeterSettingInHg = 29.92;
-    wx.altimeterSettingMbar = 1013.0;
-    wx.precipitation = PrecipitationType::NONE;
-    wx.isIcingCondition = false;
-    wx.hasThunderstorm = false;
-    wx.hasFreezingRain = false;
-    wx.hasTurbulence = false;
-    wx.skyCondition = WeatherConditionType::SCATTERED;
-    wx.isValid = true;
-    return wx;
-}
-
-bool WeatherDatabase::IsExpired(const CachedWeather& cached) const {
-    auto now = std::chrono::system_clock::now();
-    auto age = std::chrono::duration_cast<std::chrono::seconds>(now - cached.cacheTime);
-    return age.count() > CACHE_TTL_SECONDS;
-}
-
-void WeatherDatabase::EvictOldestEntry() {
-    if (weatherCache_.empty()) return;
-    
-    auto oldest = weatherCache_.begin();
-    for (auto it = weatherCache_.begin(); it != weatherCache_.end(); ++it) {
-        if (it->second.cacheTime < oldest->second.cacheTime) {
-            oldest = it;
-        }
-    }
-    
-    totalCacheSize_ -= oldest->second.estimatedSize;
-    weatherCache_.erase(oldest);
-}
-
-void WeatherDatabase::DeriveConditions(WeatherData& wx) {
-    // Determine sky condition from cloud layers
-    if (!wx.cloudLayers.empty()) {
-        wx.ceilingFeet = CalculateCeiling(wx.cloudLayers);
-        wx.skyCondition = wx.cloudLayers[0].coverage;
-    }
-    
-    // Check for icing conditions (temp between -40 and +10°C with moisture)
-    if (wx.temperatureCelsius >= -40.0 && wx.temperatureCelsius <= 10.0) {
-        double rh = wx.getRelativeHumidity();
-        if (rh > 70.0) {
-            wx.isIcingCondition = true;
-        }
-    }
-    
-    // Add cache time
-    wx.cacheTime = std::chrono::system_clock::now();
-}
-
-double WeatherDatabase::CalculateCeiling(const std::vector<CloudLayer>& layers) const {
-    for (const auto& layer : layers) {
-        if (layer.coverage == WeatherConditionType::BROKEN ||
-            layer.coverage == WeatherConditionType::OVERCAST) {
-            return layer.altitudeAgl;
-        }
-    }
-    return 5000.0;  // Default unlimited ceiling
-}
-
-double WeatherDatabase::CalculateRelativeHumidity(double tempC, double dewpointC) const {
-    const double a = 17.27;
-    const double b = 237.7;
-    
-    double alpha = ((a * tempC) / (b + tempC)) +
-                   std::log((dewpointC + 273.15) / (tempC + 273.15));
-    return 100.0 * std::exp(alpha);
-}
-
-void WeatherDatabase::InitializeSampleAirports() {
-    // Initialize with realistic sample METAR data
-    std::string metars[] = {
-        "KJFK 121851Z 31008KT 10SM FEW250 18/14 A3012 RMK AO2",
-        "KLAX 121853Z 24008KT 10SM SCT250 22/15 A2990 RMK AO2",
-        "KORD 121856Z 18012G18KT 8SM OVC050 12/06 A2995 RMK AO2",
-        "KDFW 121853Z 16015G22KT 5SM OVC015 28/18 A2988 RMK AO2 TS",
-        "KDEN 121853Z 32018G25KT 7SM BKN040 10M05 A3005 RMK AO2",
-        "KBOS 121854Z 09020G28KT 4SM OVC020 05/00 A2985 RMK AO2",
-        "KSFO 121856Z 29014G20KT 8SM BKN035 20/12 A2996 RMK AO2",
-        "KMCO 121856Z 15010KT 9SM SCT045 26/20 A2992 RMK AO2",
-        "KSEA 121856Z 20012G18KT 7SM OVC030 14/10 A2994 RMK AO2",
-        "EGLL 121850Z 27015G22KT 9999 FEW040 16/11 Q1012 RMK AO2"
-    };
-    
-    for (const auto& metar : metars) {
-        UpdateCache("", metar);  // Will extract ICAO from METAR
-    }
-}
-
 }  // namespace AICopilot
@@ -10,6 +10,74 @@
 
 namespace AICopilot {
 
+// ============================================================================
+// CGEnvelopeIndex
+// ============================================================================
+
+void CGEnvelopeIndex::build(const CGEnvelope& envelope) {
+    segments_.clear();
+    bucketSegment_.clear();
+    built_ = false;
+    
+    const std::vector<CGEnvelopePoint>& points = envelope.envelopePoints;
+    if (points.empty()) return;
+    
+    firstWeight_ = points.front().grossWeight;
+    lastWeight_ = points.back().grossWeight;
+    firstForward_ = points.front().cgForwardLimit;
+    firstAft_ = points.front().cgAftLimit;
+    built_ = true;
+    
+    for (size_t i = 1; i < points.size(); ++i) {
+        const CGEnvelopePoint& a = points[i - 1];
+        const CGEnvelopePoint& b = points[i];
+        double span = b.grossWeight - a.grossWeight;
+        if (span <= 0.0) continue;
+        Segment segment;
+        segment.maxWeight = b.grossWeight;
+        segment.forwardSlope = (b.cgForwardLimit - a.cgForwardLimit) / span;
+        segment.forwardIntercept = a.cgForwardLimit - segment.forwardSlope * a.grossWeight;
+        segment.aftSlope = (b.cgAftLimit - a.cgAftLimit) / span;
+        segment.aftIntercept = a.cgAftLimit - segment.aftSlope * a.grossWeight;
+        segments_.push_back(segment);
+    }
+    if (segments_.empty()) return;
+    
+    bucketScale_ = BUCKETS / (lastWeight_ - firstWeight_);
+    bucketSegment_.resize(BUCKETS + 1);
+    uint32_t segment = 0;
+    for (size_t bucket = 0; bucket <= BUCKETS; ++bucket) {
+        double bucketStart = firstWeight_ + bucket / bucketScale_;
+        while (segment + 1 < segments_.size() && segments_[segment].maxWeight < bucketStart) {
+            ++segment;
+        }
+        bucketSegment_[bucket] = segment;
+    }
+}
+
+bool CGEnvelopeIndex::limits(double weight, double& forwardLimit, double& aftLimit) const {
+    if (!built_ || weight > lastWeight_) return false;
+    if (weight <= firstWeight_ || segments_.empty()) {
+        forwardLimit = firstForward_;
+        aftLimit = firstAft_;
+        return true;
+    }
+    
+    size_t bucket = std::min(BUCKETS, static_cast<size_t>((weight - firstWeight_) * bucketScale_));
+    size_t segment = bucketSegment_[bucket];
+    while (segments_[segment].maxWeight < weight) {
+        ++segment;
+    }
+    const Segment& s = segments_[segment];
+    forwardLimit = s.forwardIntercept + s.forwardSlope * weight;
+    aftLimit = s.aftIntercept + s.aftSlope * weight;
+    return true;
+}
+
+// ============================================================================
+// WeightBalanceSystem
+// ============================================================================
+
 WeightBalanceSystem::WeightBalanceSystem() = default;
 
 bool WeightBalanceSystem::initialize(const AircraftConfig& config) {
@@ -19,61 +87,151 @@ bool WeightBalanceSystem::initialize(const AircraftConfig& config) {
     
     // Load envelope for this aircraft
     if (config.icaoModel.find("C172") != std::string::npos) {
-        cgEnvelope_ = createCessna172Envelope();
+        setEnvelope(createCessna172Envelope());
     } else if (config.icaoModel.find("B58") != std::string::npos) {
-        cgEnvelope_ = createBeechcraft58Envelope();
+        setEnvelope(createBeechcraft58Envelope());
     } else if (config.icaoModel.find("C208") != std::string::npos) {
-        cgEnvelope_ = createCessna208Envelope();
+        setEnvelope(createCessna208Envelope());
     } else if (config.icaoModel.find("FA7X") != std::string::npos || 
                config.icaoModel.find("7X") != std::string::npos) {
-        cgEnvelope_ = createDassaultFalcon7XEnvelope();
+        setEnvelope(createDassaultFalcon7XEnvelope());
     } else if (config.icaoModel.find("B737") != std::string::npos) {
-        cgEnvelope_ = createB737Envelope();
+        setEnvelope(createB737Envelope());
     } else if (config.icaoModel.find("A320") != std::string::npos) {
-        cgEnvelope_ = createA320Envelope();
+        setEnvelope(createA320Envelope());
     }
     
     return true;
 }
 
 bool WeightBalanceSystem::loadCGEnvelope(const CGEnvelope& envelope) {
-    cgEnvelope_ = envelope;
+    setEnvelope(envelope);
     return true;
 }
 
-void WeightBalanceSystem::addWeightItem(const WeightItem& item) {
+void WeightBalanceSystem::setEnvelope(const CGEnvelope& envelope) {
+    cgEnvelope_ = envelope;
+    envelopeIndex_.build(cgEnvelope_);
+}
+
+WeightItemId WeightBalanceSystem::addWeightItem(const WeightItem& item) {
+    WeightItemId id = static_cast<WeightItemId>(itemIndex_.size());
+    itemIndex_.push_back(weightItems_.size());
+    itemIds_.push_back(id);
     weightItems_.push_back(item);
+    itemsByName_.emplace(item.name, id);
+    
+    totalWeight_ += item.weight;
+    totalMoment_ += item.moment;
+    return id;
+}
+
+WeightItemId WeightBalanceSystem::findWeightItem(const std::string& name) const {
+    auto it = itemsByName_.find(name);
+    return it != itemsByName_.end() ? it->second : INVALID_WEIGHT_ITEM;
 }
 
 void WeightBalanceSystem::removeWeightItem(const std::string& name) {
-    auto it = std::find_if(weightItems_.begin(), weightItems_.end(),
-        [&name](const WeightItem& item) { return item.name == name; });
+    removeWeightItem(findWeightItem(name));
+}
+
+void WeightBalanceSystem::removeWeightItem(WeightItemId id) {
+    if (id >= itemIndex_.size() || itemIndex_[id] == SIZE_MAX) return;
+    
+    // Erase in place so the item order (and the report) is unchanged
+    size_t index = itemIndex_[id];
+    std::string name = weightItems_[index].name;
+    weightItems_.erase(weightItems_.begin() + index);
+    itemIds_.erase(itemIds_.begin() + index);
+    itemIndex_[id] = SIZE_MAX;
+    for (size_t i = index; i < itemIds_.size(); ++i) {
+        itemIndex_[itemIds_[i]] = i;
+    }
     
-    if (it != weightItems_.end()) {
-        weightItems_.erase(it);
+    // The name now refers to the next item carrying it, if any
+    itemsByName_.erase(name);
+    for (size_t i = 0; i < weightItems_.size(); ++i) {
+        if (weightItems_[i].name == name) {
+            itemsByName_.emplace(name, itemIds_[i]);
+            break;
+        }
     }
+    
+    // Re-sum rather than subtract so removals never leave rounding behind
+    calculateMoments();
 }
 
 void WeightBalanceSystem::updateWeightItem(const std::string& name, double newWeight) {
-    for (auto& item : weightItems_) {
-        if (item.name == name) {
-            item.weight = newWeight;
-            item.moment = item.weight * item.armDistance;
-            break;
+    updateWeightItem(findWeightItem(name), newWeight);
+}
+
+void WeightBalanceSystem::updateWeightItem(WeightItemId id, double newWeight) {
+    if (id >= itemIndex_.size() || itemIndex_[id] == SIZE_MAX) return;
+    
+    WeightItem& item = weightItems_[itemIndex_[id]];
+    double newMoment = newWeight * item.armDistance;
+    totalWeight_ += newWeight - item.weight;
+    totalMoment_ += newMoment - item.moment;
+    item.weight = newWeight;
+    item.moment = newMoment;
+}
+
+double WeightBalanceSystem::cgPercentMAC(double totalWeight, double totalMoment) const {
+    if (totalWeight <= 0) return 0.0;
+    double cgOffset = totalMoment / totalWeight - cgEnvelope_.macLeadingEdgeLocation;
+    return (cgOffset / cgEnvelope_.macLength) * 100.0;
+}
+
+CGPosition WeightBalanceSystem::getCGPosition() const {
+    CGPosition position;
+    position.totalWeight = totalWeight_;
+    position.cgLocation = cgPercentMAC(totalWeight_, totalMoment_);
+    position.withinEnvelope = totalWeight_ <= cgEnvelope_.maximumWeight &&
+                              totalWeight_ >= cgEnvelope_.minimumWeight &&
+                              validateCGPosition(totalWeight_, position.cgLocation);
+    return position;
+}
+
+CGTrajectory WeightBalanceSystem::computeFuelBurnTrajectory(double fuelBurnRate, size_t steps) const {
+    CGTrajectory trajectory;
+    
+    // Fuel items burn down together, so their combined arm is fixed
+    double fuelWeight = 0.0;
+    double fuelMoment = 0.0;
+    for (const auto& item : weightItems_) {
+        if (item.category == "fuel") {
+            fuelWeight += item.weight;
+            fuelMoment += item.moment;
         }
     }
+    double dryWeight = totalWeight_ - fuelWeight;
+    double dryMoment = totalMoment_ - fuelMoment;
+    
+    steps = std::max<size_t>(steps, 1);
+    trajectory.points.reserve(steps + 1);
+    for (size_t i = 0; i <= steps; ++i) {
+        double remaining = fuelWeight * (1.0 - static_cast<double>(i) / steps);
+        double fraction = fuelWeight > 0.0 ? remaining / fuelWeight : 0.0;
+        
+        CGTrajectoryPoint point;
+        point.fuelRemaining = remaining;
+        point.elapsedHours = fuelBurnRate > 0.0 ? (fuelWeight - remaining) / fuelBurnRate : 0.0;
+        point.totalWeight = dryWeight + remaining;
+        point.cgLocation = cgPercentMAC(point.totalWeight, dryMoment + fuelMoment * fraction);
+        point.withinEnvelope = point.totalWeight <= cgEnvelope_.maximumWeight &&
+                               point.totalWeight >= cgEnvelope_.minimumWeight &&
+                               validateCGPosition(point.totalWeight, point.cgLocation);
+        trajectory.points.push_back(point);
+        if (fuelWeight <= 0.0) break;
+    }
+    return trajectory;
 }
 
 WeightBalanceResult WeightBalanceSystem::calculateWeightBalance() {
     WeightBalanceResult result;
-    result.totalWeight = 0.0;
-    result.totalMoment = 0.0;
-    
-    // Calculate total weight and moment
-    for (const auto& item : weightItems_) {
-        result.totalWeight += item.weight;
-        result.totalMoment += item.moment;
-    }
+    result.totalWeight = totalWeight_;
+    result.totalMoment = totalMoment_;
+    result.withinEnvelope = false;
     
     // Check weight limits
     if (result.totalWeight > cgEnvelope_.maximumWeight) {
@@ -91,11 +249,7 @@ WeightBalanceResult WeightBalanceSystem::calculateWeightBalance() {
     // Calculate CG location
     if (result.totalWeight > 0) {
         result.cgLocationFeet = result.totalMoment / result.totalWeight;
-        
-        // Convert to percentage of MAC
-        double macStart = cgEnvelope_.macLeadingEdgeLocation;
-        double cgOffset = result.cgLocationFeet - macStart;
-        result.cgLocation = (cgOffset / cgEnvelope_.macLength) * 100.0;
+        result.cgLocation = cgPercentMAC(result.totalWeight, result.totalMoment);
     } else {
         result.cgLocationFeet = 0.0;
         result.cgLocation = 0.0;
@@ -161,12 +315,13 @@ WeightBalanceResult WeightBalanceSystem::calculateWeightBalance() {
     return result;
 }
 
-bool WeightBalanceSystem::isWithinLimits() const {
-    return lastResult_.withinEnvelope;
-}
-
 void WeightBalanceSystem::clearWeights() {
     weightItems_.clear();
+    itemIds_.clear();
+    itemIndex_.clear();
+    itemsByName_.clear();
+    totalWeight_ = 0.0;
+    totalMoment_ = 0.0;
 }
 
 double WeightBalanceSystem::getFuelRequiredForRange(
@@ -210,8 +365,7 @@ bool WeightBalanceSystem::adjustLoadToCG(
     // Check if adjustment is feasible
     if (newWeight < 0 || newWeight > 1000.0) return false;  // Sanity check
     
-    it->weight = newWeight;
-    it->moment = newMoment;
+    updateWeightItem(itemIds_[it - weightItems_.begin()], newWeight);
     
     return true;
 }
@@ -221,63 +375,23 @@ std::string WeightBalanceSystem::generateReport() const {
 }
 
 void WeightBalanceSystem::calculateMoments() {
+    totalWeight_ = 0.0;
+    totalMoment_ = 0.0;
     for (auto& item : weightItems_) {
         item.moment = item.weight * item.armDistance;
+        totalWeight_ += item.weight;
+        totalMoment_ += item.moment;
     }
 }
 
-bool WeightBalanceSystem::validateCGPosition(double totalWeight, double cgLocation) {
-    double forwardLimit = 0.0, aftLimit = 0.0;
-    
-    if (!interpolateCGLimits(totalWeight, forwardLimit, aftLimit)) {
-        return false;
-    }
-    
-    return cgLocation >= forwardLimit && cgLocation <= aftLimit;
+bool WeightBalanceSystem::validateCGPosition(double totalWeight, double cgLocation) const {
+    return envelopeIndex_.contains(totalWeight, cgLocation);
 }
 
 bool WeightBalanceSystem::interpolateCGLimits(double weight, 
                                              double& forwardLimit, 
                                              double& aftLimit) const {
-    
-    if (cgEnvelope_.envelopePoints.empty()) return false;
-    
-    // Find envelope points to interpolate between
-    auto it = std::lower_bound(cgEnvelope_.envelopePoints.begin(),
-                              cgEnvelope_.envelopePoints.end(),
-                              weight,
-                              [](const CGEnvelopePoint& p, double w) {
-                                  return p.grossWeight < w;
-                              });
-    
-    if (it == cgEnvelope_.envelopePoints.end()) {
-        // Weight exceeds maximum in envelope
-        return false;
-    }
-    
-    if (it == cgEnvelope_.envelopePoints.begin()) {
-        // Use first point
-        forwardLimit = it->cgForwardLimit;
-        aftLimit = it->cgAftLimit;
-        return true;
-    }
-    
-    // Interpolate between two points
-    auto prev = it - 1;
-    double w1 = prev->grossWeight;
-    double w2 = it->grossWeight;
-    
-    if (w1 == w2) {
-        forwardLimit = it->cgForwardLimit;
-        aftLimit = it->cgAftLimit;
-        return true;
-    }
-    
-    double fraction = (weight - w1) / (w2 - w1);
-    forwardLimit = prev->cgForwardLimit + fraction * (it->cgForwardLimit - prev->cgForwardLimit);
-    aftLimit = prev->cgAftLimit + fraction * (it->cgAftLimit - prev->cgAftLimit);
-    
-    return true;
+    return envelopeIndex_.limits(weight, forwardLimit, aftLimit);
 }
 
 void WeightBalanceSystem::loadStandardCGEnvelopes() {
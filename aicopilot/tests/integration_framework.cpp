@@ -20,9 +20,7 @@
 namespace AICopilot {
 namespace Tests {
 
-IntegrationTestBase::IntegrationTestBase()
-    : threadPool_(std::make_unique<ThreadPool>(8)) {
-}
+IntegrationTestBase::IntegrationTestBase() = default;
 
 IntegrationTestBase::~IntegrationTestBase() = default;
 
@@ -64,6 +62,15 @@ void IntegrationTestBase::TearDown() {
     }
 }
 
+ThreadPool& IntegrationTestBase::threadPool() {
+    if (!threadPool_) {
+        // CTest runs scenarios side by side, so stay within the machine
+        size_t threads = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+        threadPool_ = std::make_unique<ThreadPool>(threads);
+    }
+    return *threadPool_;
+}
+
 PerformanceMetrics IntegrationTestBase::measurePerformance(
     const std::string& testName,
     std::function<void()> operation,
@@ -179,7 +186,7 @@ PerformanceMetrics IntegrationTestBase::stressTestConcurrentAccess(
     auto start = std::chrono::high_resolution_clock::now();
     
     for (int i = 0; i < operationCount; ++i) {
-        threadPool_->enqueue([this, &operation, &latencies, &latenciesMutex]() {
+        threadPool().enqueue([this, &operation, &latencies, &latenciesMutex]() {
             auto opStart = std::chrono::high_resolution_clock::now();
             operation();
             auto opEnd = std::chrono::high_resolution_clock::now();
@@ -192,7 +199,7 @@ PerformanceMetrics IntegrationTestBase::stressTestConcurrentAccess(
         });
     }
     
-    threadPool_->waitAll();
+    threadPool().waitAll();
     
     auto end = std::chrono::high_resolution_clock::now();
     metrics.executionTimeMs = std::chrono::duration<double, std::milli>(end - start).count();
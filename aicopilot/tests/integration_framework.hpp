@@ -106,8 +106,12 @@ public:
                     if (!taskQueue_.empty()) {
                         auto task = std::move(taskQueue_.front());
                         taskQueue_.pop();
+                        ++running_;
                         lock.unlock();
                         task();
+                        lock.lock();
+                        --running_;
+                        if (taskQueue_.empty() && running_ == 0) idle_.notify_all();
                     }
                 }
             });
@@ -134,12 +138,11 @@ public:
         condition_.notify_one();
     }
     
+    // Returns once every queued task has finished, not just been dequeued;
+    // tasks may reference the caller's locals
     void waitAll() {
-        while (true) {
-            std::unique_lock<std::mutex> lock(queueMutex_);
-            if (taskQueue_.empty()) break;
-            std::this_thread::yield();
-        }
+        std::unique_lock<std::mutex> lock(queueMutex_);
+        idle_.wait(lock, [this] { return taskQueue_.empty() && running_ == 0; });
     }
 
 private:
@@ -147,6 +150,8 @@ private:
     std::queue<std::function<void()>> taskQueue_;
     std::mutex queueMutex_;
     std::condition_variable condition_;
+    std::condition_variable idle_;
+    size_t running_ = 0;
     std::atomic<bool> shutdown_;
 };
 
@@ -182,9 +187,11 @@ protected:
     std::vector<PerformanceMetrics> performanceMetrics_;
     std::vector<DataFlowRecord> dataFlows_;
     
-    // Testing utilities
+    // Testing utilities; created by the first stress test that needs it
     std::unique_ptr<ThreadPool> threadPool_;
     
+    ThreadPool& threadPool();
+    
     /**
      * Measure execution time of a function with high precision
      * @param testName Name of the test for reporting
@@ -272,6 +279,17 @@ protected:
     bool verifyPerformanceThreshold();
 };
 
+/**
+ * Base fixture for scenario parameter sweeps
+ *
+ * Each parameter becomes its own test, and gtest_discover_tests registers
+ * each test as its own CTest case, so ctest -j spreads a sweep across
+ * cores. Every case runs in a fresh process with its own databases.
+ */
+template <class Param>
+class IntegrationSweepBase : public IntegrationTestBase,
+                             public ::testing::WithParamInterface<Param> {};
+
 /**
  * Integration test macros for concise test definition
  */
@@ -180,7 +180,7 @@ TEST_F(NavigationFlightPlannerIntegrationTest, RouteFinderIntegration) {
         "Navigation_RouteFinding",
         [this, origin, destination]() {
             auto result = navDb_->FindRoute(origin, destination, testCruiseAltitude);
-            EXPECT_GT(result.waypoints.size(), 0);
+            EXPECT_GT(result.waypointSequence.size(), 0);
             recordDataFlow("Navigation", "FlightPlanner", "RouteData");
         });
     
@@ -408,8 +408,8 @@ TEST_F(NavigationFlightPlannerIntegrationTest, RouteOptimization) {
         [this, origin, destination]() {
             auto result = navDb_->FindRoute(origin, destination, testCruiseAltitude);
             // Optimized route should have reasonable number of waypoints
-            if (result.waypoints.size() > 0) {
-                EXPECT_LT(result.waypoints.size(), 20);  // Not too many waypoints
+            if (result.waypointSequence.size() > 0) {
+                EXPECT_LT(result.waypointSequence.size(), 20);  // Not too many waypoints
             }
         },
         20,
@@ -466,28 +466,42 @@ TEST_F(NavigationFlightPlannerIntegrationTest, SIDSTARAvailability) {
 // ============================================================================
 // TEST 21: Multi-Leg Route Planning
 // ============================================================================
-TEST_F(NavigationFlightPlannerIntegrationTest, MultiLegRoutePlanning) {
-    // Arrange: Three-leg route JFK -> ORD -> LAX
-    std::vector<std::pair<std::string, std::string>> legs = {
-        {"KJFK", "KORD"},
-        {"KORD", "KLAX"},
-        {"KLAX", "KJFK"}
-    };
+struct RouteLeg {
+    const char* origin;
+    const char* destination;
+};
+
+class RouteLegSweepTest : public IntegrationSweepBase<RouteLeg> {
+protected:
+    int testCruiseAltitude = 35000;
+};
+
+TEST_P(RouteLegSweepTest, MultiLegRoutePlanning) {
+    // Arrange: One leg of the JFK -> ORD -> LAX -> JFK route
+    const RouteLeg leg = GetParam();
     
     // Act
     auto metrics = measurePerformance(
         "Navigation_MultiLegRoute",
-        [this, &legs]() {
-            for (const auto& leg : legs) {
-                auto result = navDb_->FindRoute(leg.first, leg.second, testCruiseAltitude);
-                EXPECT_GT(result.waypoints.size(), 0);
-            }
+        [this, leg]() {
+            auto result = navDb_->FindRoute(leg.origin, leg.destination, testCruiseAltitude);
+            EXPECT_GT(result.waypointSequence.size(), 0);
             recordDataFlow("Navigation", "FlightPlanner", "MultiLegRoute");
         });
     
     VALIDATE_PERFORMANCE(metrics, 50.0);
 }
 
+INSTANTIATE_TEST_SUITE_P(
+    Legs, RouteLegSweepTest,
+    ::testing::Values(
+        RouteLeg{"KJFK", "KORD"},
+        RouteLeg{"KORD", "KLAX"},
+        RouteLeg{"KLAX", "KJFK"}),
+    [](const ::testing::TestParamInfo<RouteLeg>& info) {
+        return std::string(info.param.origin) + "_" + info.param.destination;
+    });
+
 // ============================================================================
 // TEST 22: Waypoint Type Filtering
 // ============================================================================
@@ -570,7 +584,7 @@ TEST_F(NavigationFlightPlannerIntegrationTest, FinalNavigationFlightPlannerInteg
             auto route = navDb_->FindRoute(departure, destination, testCruiseAltitude);
             
             // 4. Calculate flight time
-            if (route.waypoints.size() > 0) {
+            if (route.waypointSequence.size() > 0) {
                 double distance = navDb_->CalculateDistance(
                     departure, destination);
                 double flightTime = navDb_->CalculateFlightTime(distance);
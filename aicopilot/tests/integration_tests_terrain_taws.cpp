@@ -205,29 +205,26 @@ TEST_F(TerrainTAWSIntegrationTest, TerrainStatisticsForArea) {
 // ============================================================================
 // TEST 7: Global Coverage Validation
 // ============================================================================
-TEST_F(TerrainTAWSIntegrationTest, GlobalCoverageValidation) {
-    // Arrange: Test various locations worldwide
-    Position globalLocations[5] = {
-        {40.7128, -74.0060, 0.0, 0.0},      // New York
-        {51.5074, -0.1278, 0.0, 0.0},       // London
-        {35.6762, 139.6503, 0.0, 0.0},      // Tokyo
-        {48.8566, 2.3522, 0.0, 0.0},        // Paris
-        {37.7749, -122.4194, 0.0, 0.0}      // San Francisco
-    };
+struct CoverageSite {
+    const char* name;
+    double latitude;
+    double longitude;
+};
+
+class TerrainCoverageSweepTest : public IntegrationSweepBase<CoverageSite> {};
+
+TEST_P(TerrainCoverageSweepTest, GlobalCoverageValidation) {
+    // Arrange: One of the worldwide test locations
+    const CoverageSite site = GetParam();
+    Position location = {site.latitude, site.longitude, 0.0, 0.0};
     
     // Act
     auto metrics = measurePerformance(
         "Terrain_GlobalCoverage",
-        [this, globalLocations]() {
-            int availableCount = 0;
-            
-            for (int i = 0; i < 5; ++i) {
-                if (terrainDb_->isDataAvailable(globalLocations[i].latitude,
-                                                globalLocations[i].longitude)) {
-                    availableCount++;
-                    double elev = terrainDb_->getElevationAt(globalLocations[i]);
-                    EXPECT_GE(elev, -500.0);  // Bathymetry for oceans
-                }
+        [this, location]() {
+            if (terrainDb_->isDataAvailable(location.latitude, location.longitude)) {
+                double elev = terrainDb_->getElevationAt(location);
+                EXPECT_GE(elev, -500.0);  // Bathymetry for oceans
             }
             
             recordDataFlow("Terrain", "TAWS", "GlobalCoverage");
@@ -236,6 +233,18 @@ TEST_F(TerrainTAWSIntegrationTest, GlobalCoverageValidation) {
     VALIDATE_PERFORMANCE(metrics, 50.0);
 }
 
+INSTANTIATE_TEST_SUITE_P(
+    Sites, TerrainCoverageSweepTest,
+    ::testing::Values(
+        CoverageSite{"NewYork", 40.7128, -74.0060},
+        CoverageSite{"London", 51.5074, -0.1278},
+        CoverageSite{"Tokyo", 35.6762, 139.6503},
+        CoverageSite{"Paris", 48.8566, 2.3522},
+        CoverageSite{"SanFrancisco", 37.7749, -122.4194}),
+    [](const ::testing::TestParamInfo<CoverageSite>& info) {
+        return std::string(info.param.name);
+    });
+
 // ============================================================================
 // TEST 8: Terrain Cache Efficiency
 // ============================================================================
@@ -474,7 +483,7 @@ TEST_F(TerrainTAWSIntegrationTest, RealtimeTAWSAlerts) {
                 // Simulate TAWS logic: alert if clearance < 1000ft
                 bool shouldAlert = (clearance < 1000.0 && clearance > 0);
                 
-                if (i >= 2) {  // Later in descent
+                if (i >= 3) {  // Below 1000 ft over the sea-level airport
                     EXPECT_TRUE(shouldAlert);  // Should trigger alert
                 }
             }
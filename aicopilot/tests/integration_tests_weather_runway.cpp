@@ -40,6 +40,7 @@ protected:
         rwy04L.runwayId = "04L";
         rwy04L.headingMagnetic = 40;
         rwy04L.length = 14572;
+        rwy04L.TORA = rwy04L.TODA = rwy04L.ASDA = rwy04L.LDA = rwy04L.length;
         rwy04L.width = 200;
         rwy04L.latitude = 40.6381;
         rwy04L.longitude = -73.7759;
@@ -50,6 +51,7 @@ protected:
         rwy04R.runwayId = "04R";
         rwy04R.headingMagnetic = 40;
         rwy04R.length = 13000;
+        rwy04R.TORA = rwy04R.TODA = rwy04R.ASDA = rwy04R.LDA = rwy04R.length;
         rwy04R.width = 150;
         rwy04R.latitude = 40.6381;
         rwy04R.longitude = -73.7659;
@@ -60,6 +62,7 @@ protected:
         rwy22L.runwayId = "22L";
         rwy22L.headingMagnetic = 220;
         rwy22L.length = 14572;
+        rwy22L.TORA = rwy22L.TODA = rwy22L.ASDA = rwy22L.LDA = rwy22L.length;
         rwy22L.width = 200;
         rwy22L.latitude = 40.6200;
         rwy22L.longitude = -73.7800;
@@ -70,15 +73,15 @@ protected:
         rwy22R.runwayId = "22R";
         rwy22R.headingMagnetic = 220;
         rwy22R.length = 13000;
+        rwy22R.TORA = rwy22R.TODA = rwy22R.ASDA = rwy22R.LDA = rwy22R.length;
         rwy22R.width = 150;
         rwy22R.latitude = 40.6200;
         rwy22R.longitude = -73.7700;
         testRunways.push_back(rwy22R);
         
         // Setup runway selection criteria
-        criteria.operation = RunwayOperation::LANDING;
-        criteria.maxCrosswind = 20.0;
-        criteria.maxTailwind = 10.0;
+        criteria.maxAcceptableCrosswind = 20;
+        criteria.maxAcceptableTailwind = 10.0;
         criteria.preferILS = true;
         criteria.aircraftType = "B737";
     }
@@ -148,7 +151,7 @@ TEST_F(WeatherRunwayIntegrationTest, WeatherDrivesRunwaySelection) {
                 testRunways,
                 report.windDirection,
                 report.windSpeed,
-                criteria.maxCrosswind,
+                criteria.maxAcceptableCrosswind,
                 selectedRunway);
             
             EXPECT_TRUE(success);
@@ -176,14 +179,14 @@ TEST_F(WeatherRunwayIntegrationTest, WeatherUpdateTriggersRunwayRecalculation) {
             METARReport report1 = weatherDb_->parseMETAR(metarString1);
             RunwayInfo selectedRunway1;
             RunwaySelector::SelectForTakeoff(testRunways, report1.windDirection,
-                                           report1.windSpeed, criteria.maxCrosswind, selectedRunway1);
+                                           report1.windSpeed, criteria.maxAcceptableCrosswind, selectedRunway1);
             recordDataFlow("Weather", "Runway", "RunwaySelection1");
             
             // Update weather to southerly wind
             METARReport report2 = weatherDb_->parseMETAR(metarString2);
             RunwayInfo selectedRunway2;
             RunwaySelector::SelectForTakeoff(testRunways, report2.windDirection,
-                                           report2.windSpeed, criteria.maxCrosswind, selectedRunway2);
+                                           report2.windSpeed, criteria.maxAcceptableCrosswind, selectedRunway2);
             recordDataFlow("Weather", "Runway", "RunwaySelection2");
             
             // Verify selection changed
@@ -228,7 +231,7 @@ TEST_F(WeatherRunwayIntegrationTest, StressTest_HighFrequencyWeatherUpdates) {
     for (int i = 0; i < 150; ++i) {
         int heading = (i * 20) % 360;
         int speed = 5 + (i % 20);
-        std::string metar = "KJFK 121851Z " + 
+        std::string metar = std::string("KJFK 121851Z ") + 
             (heading < 10 ? "00" : heading < 100 ? "0" : "") + std::to_string(heading) +
             (speed < 10 ? "0" : "") + std::to_string(speed) +
             "KT 10SM FEW250 23/14 A3012 RMK AO2";
@@ -244,7 +247,7 @@ TEST_F(WeatherRunwayIntegrationTest, StressTest_HighFrequencyWeatherUpdates) {
             METARReport report = weatherDb_->parseMETAR(metarStrings[index++ % 150]);
             RunwayInfo selectedRunway;
             RunwaySelector::SelectForTakeoff(testRunways, report.windDirection,
-                                           report.windSpeed, criteria.maxCrosswind, selectedRunway);
+                                           report.windSpeed, criteria.maxAcceptableCrosswind, selectedRunway);
         });
     
     // Assert: Average latency should be < 50ms
@@ -269,14 +272,14 @@ TEST_F(WeatherRunwayIntegrationTest, WeatherCrosswindWithinLimits) {
             // Should still find a valid runway even with 25kt wind
             bool success = RunwaySelector::SelectForTakeoff(
                 testRunways, report.windDirection, report.windSpeed,
-                criteria.maxCrosswind, selectedRunway);
+                criteria.maxAcceptableCrosswind, selectedRunway);
             
             EXPECT_TRUE(success);
             
             // Verify selected runway is acceptable
             RunwayWindComponents components = RunwaySelector::CalculateWindComponents(
                 selectedRunway.headingMagnetic, report.windDirection, report.windSpeed);
-            EXPECT_LE(std::abs(components.crosswind), criteria.maxCrosswind);
+            EXPECT_LE(std::abs(components.crosswind), criteria.maxAcceptableCrosswind);
             recordDataFlow("Weather", "Runway", "CrosswindCheck");
         });
     
@@ -418,11 +421,11 @@ TEST_F(WeatherRunwayIntegrationTest, RunwaySelectionConsistency) {
             
             // Run selection algorithm 3 times with same weather
             RunwaySelector::SelectForTakeoff(testRunways, report.windDirection,
-                                           report.windSpeed, criteria.maxCrosswind, selected1);
+                                           report.windSpeed, criteria.maxAcceptableCrosswind, selected1);
             RunwaySelector::SelectForTakeoff(testRunways, report.windDirection,
-                                           report.windSpeed, criteria.maxCrosswind, selected2);
+                                           report.windSpeed, criteria.maxAcceptableCrosswind, selected2);
             RunwaySelector::SelectForTakeoff(testRunways, report.windDirection,
-                                           report.windSpeed, criteria.maxCrosswind, selected3);
+                                           report.windSpeed, criteria.maxAcceptableCrosswind, selected3);
             
             // Should always select the same runway
             EXPECT_EQ(selected1.runwayId, selected2.runwayId);
@@ -454,7 +457,7 @@ TEST_F(WeatherRunwayIntegrationTest, ILSAvailabilityWithWeather) {
             if (report.lowVisibility) {
                 RunwayInfo selectedRunway;
                 RunwaySelector::SelectForLanding(testRunways, report.windDirection,
-                                               report.windSpeed, criteria.maxCrosswind, true, selectedRunway);
+                                               report.windSpeed, criteria.maxAcceptableCrosswind, true, selectedRunway);
                 
                 // Selected runway should have ILS
                 EXPECT_TRUE(selectedRunway.ilsData.hasILS);
@@ -496,7 +499,7 @@ TEST_F(WeatherRunwayIntegrationTest, PerformanceTest_WindShearStressTest) {
     for (int i = 0; i < 100; ++i) {
         int baseWind = 10 + (i % 20);
         int gustWind = baseWind + 10 + (i % 25);
-        std::string metar = "KJFK 121851Z " +
+        std::string metar = std::string("KJFK 121851Z ") +
             (i % 360 < 10 ? "00" : i % 360 < 100 ? "0" : "") + std::to_string(i % 360) +
             (baseWind < 10 ? "0" : "") + std::to_string(baseWind) +
             "G" + (gustWind < 10 ? "0" : "") + std::to_string(gustWind) +
@@ -513,7 +516,7 @@ TEST_F(WeatherRunwayIntegrationTest, PerformanceTest_WindShearStressTest) {
             METARReport report = weatherDb_->parseMETAR(shearMetars[index++ % 100]);
             RunwayInfo selectedRunway;
             RunwaySelector::SelectForTakeoff(testRunways, report.windDirection,
-                                           report.windSpeed, criteria.maxCrosswind, selectedRunway);
+                                           report.windSpeed, criteria.maxAcceptableCrosswind, selectedRunway);
         });
     
     VALIDATE_PERFORMANCE(metrics, 50.0);
@@ -540,7 +543,7 @@ TEST_F(WeatherRunwayIntegrationTest, WeatherSystemTransition) {
                 METARReport report = weatherDb_->parseMETAR(metar);
                 RunwayInfo selected;
                 RunwaySelector::SelectForTakeoff(testRunways, report.windDirection,
-                                               report.windSpeed, criteria.maxCrosswind, selected);
+                                               report.windSpeed, criteria.maxAcceptableCrosswind, selected);
                 selectedRunways.push_back(selected);
             }
             recordDataFlow("Weather", "Runway", "SystemTransition");
@@ -565,7 +568,7 @@ TEST_F(WeatherRunwayIntegrationTest, HeadwindPreferenceWithWeather) {
             
             bool success = RunwaySelector::SelectForTakeoff(
                 testRunways, report.windDirection, report.windSpeed,
-                criteria.maxCrosswind, selectedRunway);
+                criteria.maxAcceptableCrosswind, selectedRunway);
             
             EXPECT_TRUE(success);
             
@@ -616,7 +619,7 @@ TEST_F(WeatherRunwayIntegrationTest, FinalPerformanceVerification) {
             METARReport report = weatherDb_->parseMETAR(metarString);
             RunwayInfo selected;
             RunwaySelector::SelectForTakeoff(testRunways, report.windDirection,
-                                           report.windSpeed, criteria.maxCrosswind, selected);
+                                           report.windSpeed, criteria.maxAcceptableCrosswind, selected);
         },
         50,
         50.0);
@@ -12,7 +12,7 @@ int main() {
     auto wx = weather.GetWeatherAt("KJFK", 0);
     double temp = weather.GetTemperature("KJFK");
 
-    AICopilot::RunwayDatabase runway_db;
+    AICopilot::SimpleRunwayDatabase runway_db;
     auto runways = runway_db.GetRunwayInfo("KJFK");
     auto primary = runway_db.GetPrimaryRunway("KJFK");
 
@@ -15,6 +15,7 @@
 #include "runway_selector.hpp"
 #include "runway_database_prod.hpp"
 #include <cmath>
+#include <string>
 #include <vector>
 
 namespace AICopilot {
@@ -109,7 +110,7 @@ TEST_F(RunwayDatabaseTest, GetAllRunways) {
 }
 
 TEST_F(RunwayDatabaseTest, GetAirportInfo) {
-    AirportInfo apt;
+    RunwayAirportInfo apt;
     bool found = db.GetAirportInfo("KJFK", apt);
     EXPECT_TRUE(found);
     EXPECT_EQ(apt.icao, "KJFK");
@@ -227,7 +228,7 @@ TEST_F(RunwayDatabaseTest, CalculateTakeoffDistance) {
 // ============================================================================
 
 TEST_F(RunwayDatabaseTest, GetILSDataValid) {
-    ILSData ils;
+    RunwayILSData ils;
     bool found = db.GetILSData("KJFK", "04L", ils);
     EXPECT_TRUE(found);
     EXPECT_TRUE(ils.hasILS);
@@ -236,7 +237,7 @@ TEST_F(RunwayDatabaseTest, GetILSDataValid) {
 }
 
 TEST_F(RunwayDatabaseTest, GetILSDataNoILS) {
-    ILSData ils;
+    RunwayILSData ils;
     bool found = db.GetILSData("KSEA", "16C", ils);
     // 16C might not have ILS
 }
@@ -363,7 +364,7 @@ TEST_F(RunwayDatabaseTest, LondonHeathrow) {
 }
 
 TEST_F(RunwayDatabaseTest, TokyoHaneda) {
-    AirportInfo apt;
+    RunwayAirportInfo apt;
     bool found = db.GetAirportInfo("RJTT", apt);
     EXPECT_TRUE(found);
     EXPECT_EQ(apt.name, "Tokyo Haneda Airport");
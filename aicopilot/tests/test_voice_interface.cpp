@@ -20,6 +20,9 @@
 #include "speech_recognizer.hpp"
 #include "voice_interpreter.hpp"
 #include "voice_output.hpp"
+#include "navdata_provider.h"
+#include "voice_latency.hpp"
+#include "system_monitor.hpp"
 #include <chrono>
 #include <algorithm>
 
@@ -107,6 +110,23 @@ TEST_F(VoiceInputTest, ClearVoiceBuffer) {
     EXPECT_EQ(buffer.size(), 0);
 }
 
+TEST_F(VoiceInputTest, CapturedAudioReachesFrontEnd) {
+    EXPECT_TRUE(voice_input.initialize());
+    voice_input.startListening();
+    
+    // The capture side only queues frames; the recognition side processes them
+    auto voice = generateTestAudio(5000, true);
+    voice_input.captureAudio(voice.data(), voice.size());
+    EXPECT_EQ(voice_input.getStatistics().total_frames_processed, 0);
+    EXPECT_EQ(voice_input.getCaptureStats().frames_written, voice.size() / AudioFormat::FRAME_SIZE);
+    
+    size_t frames = voice_input.processCapturedAudio();
+    EXPECT_EQ(frames, voice.size() / AudioFormat::FRAME_SIZE);
+    EXPECT_EQ(voice_input.getStatistics().total_frames_processed, frames);
+    EXPECT_TRUE(voice_input.voiceDetected());
+    EXPECT_EQ(voice_input.processCapturedAudio(), 0u);
+}
+
 // ============================================================================
 // SpeechRecognizer Tests
 // ============================================================================
@@ -271,6 +291,91 @@ TEST_F(VoiceInterpreterTest, GetLastInterpretedAction) {
     EXPECT_EQ(last.type, SystemActionType::SET_ALTITUDE);
 }
 
+// Navdata with two airports and one navaid that counts batched lookups
+class CountingNavdataProvider : public INavdataProvider {
+public:
+    mutable int airportBatches = 0;
+    mutable int navaidBatches = 0;
+    mutable int singleLookups = 0;
+
+    bool initialize() override { return true; }
+    void shutdown() override {}
+    bool isReady() const override { return true; }
+    bool getAirportByICAO(const std::string& icao, AirportInfo& info) const override {
+        singleLookups++;
+        return findAirport(icao, info);
+    }
+    bool getAirportLayout(const std::string&, AirportLayout&) const override { return false; }
+    std::vector<AirportInfo> getAirportsNearby(const Position&, double) const override { return {}; }
+    bool getNavaidByID(const std::string& id, NavaidInfo& info) const override {
+        singleLookups++;
+        return findNavaid(id, info);
+    }
+    std::vector<NavaidInfo> getNavaidsNearby(const Position&, double, const std::string&) const override { return {}; }
+    bool getNearestAirport(const Position&, AirportInfo&) const override { return false; }
+    size_t getAirportsByICAO(const std::vector<std::string>& icaos,
+                             std::vector<AirportInfo>& infos) const override {
+        airportBatches++;
+        infos.assign(icaos.size(), AirportInfo{});
+        size_t found = 0;
+        for (size_t i = 0; i < icaos.size(); ++i) found += findAirport(icaos[i], infos[i]);
+        return found;
+    }
+    size_t getNavaidsByID(const std::vector<std::string>& ids,
+                          std::vector<NavaidInfo>& infos) const override {
+        navaidBatches++;
+        infos.assign(ids.size(), NavaidInfo{});
+        size_t found = 0;
+        for (size_t i = 0; i < ids.size(); ++i) found += findNavaid(ids[i], infos[i]);
+        return found;
+    }
+
+private:
+    static bool findAirport(const std::string& icao, AirportInfo& info) {
+        if (icao != "KBOS" && icao != "ORD") return false;
+        info.icao = icao;
+        return true;
+    }
+    static bool findNavaid(const std::string& id, NavaidInfo& info) {
+        if (id != "BOS" && id != "ORD") return false;
+        info.id = id;
+        return true;
+    }
+};
+
+TEST_F(VoiceInterpreterTest, WaypointCandidatesResolveInOneBatch) {
+    auto navdata = std::make_shared<CountingNavdataProvider>();
+    AmbiguityResolver resolver;
+    resolver.setNavdataProvider(navdata);
+
+    auto results = resolver.resolveWaypointAmbiguities({"bos", "ORD", "ZZZZZ"});
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0], (std::vector<std::string>{"BOS", "KBOS"}));
+    EXPECT_EQ(results[1], (std::vector<std::string>{"ORD"}));
+    EXPECT_TRUE(results[2].empty());
+    EXPECT_EQ(navdata->airportBatches, 1);
+    EXPECT_EQ(navdata->navaidBatches, 1);
+    EXPECT_EQ(navdata->singleLookups, 0);
+}
+
+TEST_F(VoiceInterpreterTest, PrefetchedWaypointsComeFromCache) {
+    auto navdata = std::make_shared<CountingNavdataProvider>();
+    interpreter.setNavdataProvider(navdata);
+    interpreter.prefetchWaypoints({"BOS", "ORD"});
+    EXPECT_EQ(navdata->airportBatches, 1);
+
+    AmbiguityResolver resolver;
+    resolver.setNavdataProvider(navdata);
+    resolver.prefetchWaypoints({"BOS"});
+    EXPECT_EQ(resolver.resolveWaypointAmbiguity("Bos"), (std::vector<std::string>{"BOS", "KBOS"}));
+    EXPECT_EQ(navdata->airportBatches, 2);   // the second lookup was a cache hit
+
+    // A new provider starts a fresh cache
+    resolver.setNavdataProvider(navdata);
+    resolver.resolveWaypointAmbiguity("BOS");
+    EXPECT_EQ(navdata->airportBatches, 3);
+}
+
 // ============================================================================
 // Voice Output Tests
 // ============================================================================
@@ -334,6 +439,76 @@ TEST_F(VoiceOutputTest, SetActiveSpeaker) {
     EXPECT_TRUE(callback_called);
 }
 
+TEST_F(VoiceOutputTest, RepeatedCalloutsComeFromCache) {
+    voice_output.waitForPreSynthesis();
+    auto before = voice_output.getSpeechCacheStats();
+    EXPECT_GE(before.phrases, SpeechSynthesizer::getStandardPhrases().size());
+    
+    voice_output.playWarningAlert("Terrain ahead!");
+    auto after = voice_output.getSpeechCacheStats();
+    EXPECT_EQ(after.hits, before.hits + 1);
+    EXPECT_EQ(after.misses, before.misses);
+    EXPECT_FALSE(last_speech.audio_samples.empty());
+}
+
+TEST(SpeechSynthesizerTest, NumbersSpokenAsFragments) {
+    auto words = SpeechSynthesizer::splitFragments("Roger, climb 15000 feet, heading 270, 1.5 miles.");
+    std::vector<std::string> expected = {
+        "roger", "climb", "one", "five", "thousand", "feet", "heading", "two", "seven", "zero",
+        "one", "point", "five", "miles"
+    };
+    EXPECT_EQ(words, expected);
+    EXPECT_EQ(SpeechSynthesizer::splitFragments("500"), std::vector<std::string>({"five", "hundred"}));
+    EXPECT_EQ(SpeechSynthesizer::splitFragments("3500"),
+              std::vector<std::string>({"three", "thousand", "five", "hundred"}));
+}
+
+TEST(SpeechSynthesizerTest, NumericReadbackAssembledFromCachedFragments) {
+    SpeechSynthesizer synthesizer;
+    TTSConfig config;
+    config.speaker = SpeakerProfile::STANDARD;
+    ASSERT_TRUE(synthesizer.initialize(config));
+    
+    SynthesizedSpeech first = synthesizer.synthesize("250 knots.");
+    auto stats = synthesizer.getCacheStats();
+    EXPECT_EQ(stats.phrases, 5u);    // two, five, zero, knots and the phrase
+    
+    // A new value only looks fragments up; the gaps are silence
+    SynthesizedSpeech second = synthesizer.synthesize("205 knots.");
+    EXPECT_EQ(synthesizer.getCacheStats().phrases, 6u);
+    EXPECT_EQ(second.audio_samples.size(), first.audio_samples.size());
+    
+    std::vector<int16_t> two = synthesizer.synthesize("two").audio_samples;
+    ASSERT_LE(two.size(), first.audio_samples.size());
+    EXPECT_TRUE(std::equal(two.begin(), two.end(), first.audio_samples.begin()));
+    
+    // Rendering settings invalidate the cache; the speaker is part of the key
+    synthesizer.setVolume(0.2f);
+    EXPECT_EQ(synthesizer.getCacheStats().phrases, 0u);
+    synthesizer.synthesize("Minimums");
+    synthesizer.setSpeakerProfile(SpeakerProfile::NEUTRAL);
+    synthesizer.synthesize("Minimums");
+    EXPECT_EQ(synthesizer.getCacheStats().phrases, 2u);
+}
+
+TEST(SpeechSynthesizerTest, CacheEvictsLeastRecentlyUsed) {
+    SpeechSynthesizer synthesizer;
+    ASSERT_TRUE(synthesizer.initialize(TTSConfig()));
+    size_t phrase = synthesizer.synthesize("Gear down").audio_samples.size();
+    synthesizer.clearCache();
+    synthesizer.setCacheBudget(phrase * 2);
+    
+    synthesizer.synthesize("Gear down");
+    synthesizer.synthesize("Flaps one");
+    synthesizer.synthesize("Gear down");     // now most recent
+    synthesizer.synthesize("Sink rate");     // evicts Flaps one
+    auto stats = synthesizer.getCacheStats();
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.phrases, 2u);
+    
+    EXPECT_EQ(synthesizer.preSynthesize({"Gear down", "Flaps one"}), 1u);
+}
+
 TEST_F(VoiceOutputTest, GenerateAltitudeReadback) {
     ReadbackGenerator gen;
     
@@ -359,6 +534,271 @@ TEST_F(VoiceOutputTest, GenerateSpeedReadback) {
     EXPECT_NE(readback.find("knots"), std::string::npos);
 }
 
+TEST(CalloutFormatterTest, FormatsIntoFixedBuffer) {
+    CalloutFormatter out;
+    out.append("Flight level ").appendInt(350).append(", ").appendFixed(2.25, 1);
+    EXPECT_EQ(out.view(), "Flight level 350, 2.2");
+    EXPECT_FALSE(out.truncated());
+    
+    out.clear().append(std::string(CalloutFormatter::CAPACITY + 10, 'x'));
+    EXPECT_EQ(out.size(), CalloutFormatter::CAPACITY);
+    EXPECT_TRUE(out.truncated());
+    
+    CalloutFormatter& shared = CalloutFormatter::forThread();
+    shared.append("stale");
+    EXPECT_EQ(CalloutFormatter::forThread().size(), 0u);
+}
+
+TEST(CalloutFormatterTest, GeneratorsKeepTheirWording) {
+    ReadbackGenerator readback;
+    AnnouncementGenerator announcement;
+    
+    EXPECT_EQ(readback.generateAltitudeReadback(25000), "Flight level 250.");
+    EXPECT_EQ(readback.generateAltitudeReadback(4999.6), "5000 feet.");
+    EXPECT_EQ(readback.generateHeadingReadback(270), "Heading 270 degrees.");
+    EXPECT_EQ(readback.generateSpeedReadback(150), "150 knots.");
+    EXPECT_EQ(readback.generateWaypointReadback("kjf1"), "Direct to Kilo Juliett Foxtrot .");
+    EXPECT_EQ(readback.formatStandardReadback({{"altitude", "3000"}, {"squawk", "7000"}}),
+              "Roger, 3000 feet., squawk 7000.");
+    EXPECT_EQ(announcement.generateTerrainWarning(2.5, 500), "Terrain ahead, 2.5 nautical miles, 500 feet below.");
+    EXPECT_EQ(announcement.generateNavigationStatus("LIMA", 12.25),
+              "Current waypoint LIMA, 12.2 nautical miles remaining.");
+    EXPECT_EQ(announcement.generateStatusAnnouncement("Fuel", {{"left", "40"}}), "Fuel status: left 40. ");
+    
+    // Repeated callouts append to a caller's buffer instead of returning strings
+    CalloutFormatter out;
+    readback.generateAltitudeReadback(3000, out);
+    out.append(' ');
+    readback.generateSpeedReadback(180, out);
+    EXPECT_EQ(out.view(), "3000 feet. 180 knots.");
+}
+
+TEST_F(SpeechRecognizerTest, RecognizeSoundAlikeSpelling) {
+    RecognitionResult result = recognizer.recognizeText("flite plan");
+    
+    EXPECT_EQ(result.command, "FLIGHT_PLAN");
+    EXPECT_GE(result.confidence, 0.85);
+}
+
+TEST_F(SpeechRecognizerTest, RejectUnrelatedText) {
+    RecognitionResult result = recognizer.recognizeText("lorem ipsum dolor");
+    
+    EXPECT_EQ(result.command, "UNKNOWN");
+}
+
+TEST(CommandRecognizerTest, ReregisteredCommandDropsOldVariations) {
+    CommandRecognizer commands;
+    commands.registerCommand({"TEST_GEAR", "Gear", {"gear down"}, {}, false});
+    EXPECT_EQ(commands.recognize("gear down").command, "TEST_GEAR");
+    
+    commands.registerCommand({"TEST_GEAR", "Gear", {"landing gear"}, {}, false});
+    EXPECT_EQ(commands.recognize("gear down").command, "UNKNOWN");
+    EXPECT_EQ(commands.recognize("landing gear down").command, "TEST_GEAR");
+}
+
+TEST(CommandRecognizerTest, PrefersLongerPhrase) {
+    CommandRecognizer commands;
+    commands.registerCommand({"A_LIGHTS", "Lights", {"lights"}, {}, false});
+    commands.registerCommand({"B_LIGHTS_OFF", "Lights Off", {"lights off"}, {}, false});
+    
+    EXPECT_EQ(commands.recognize("lights on").command, "A_LIGHTS");
+    EXPECT_EQ(commands.recognize("lights off now").command, "B_LIGHTS_OFF");
+}
+
+TEST(CommandRecognizerTest, StreamingCommitsOnceUnambiguous) {
+    CommandRecognizer commands;
+    commands.registerCommand({"GEAR_DOWN", "Gear Down", {"gear down"}, {}, false});
+    commands.registerCommand({"GEAR_UP", "Gear Up", {"gear up"}, {}, false});
+    commands.registerCommand({"LIGHTS", "Lights", {"lights"}, {}, false});
+    commands.registerCommand({"LIGHTS_OFF", "Lights Off", {"lights off"}, {}, false});
+    
+    commands.beginUtterance();
+    EXPECT_FALSE(commands.updateUtterance("gear").committed);
+    EXPECT_FALSE(commands.updateUtterance("gear do").committed);
+    PartialRecognition partial = commands.updateUtterance("gear down");
+    EXPECT_TRUE(partial.committed);
+    EXPECT_EQ(partial.result.command, "GEAR_DOWN");
+    EXPECT_EQ(commands.updateUtterance("gear downwind").result.command, "GEAR_DOWN");
+    EXPECT_EQ(commands.endUtterance("gear down please").command, "GEAR_DOWN");
+    
+    // "lights" may still become "lights off"
+    commands.beginUtterance();
+    partial = commands.updateUtterance("lights");
+    EXPECT_EQ(partial.result.command, "LIGHTS");
+    EXPECT_FALSE(partial.committed);
+    EXPECT_FALSE(commands.updateUtterance("lights o").committed);
+    EXPECT_EQ(commands.endUtterance("lights off").command, "LIGHTS_OFF");
+    
+    auto stats = commands.getStatistics();
+    EXPECT_EQ(stats.total_attempts, 2u);
+    EXPECT_EQ(stats.successful_recognitions, 2u);
+}
+
+TEST(CommandRecognizerTest, StreamingMatchesBatchRecognition) {
+    CommandRecognizer streaming;
+    CommandRecognizer batch;
+    streaming.initialize();
+    batch.initialize();
+    
+    for (const std::string text : {"climb to twenty thousand", "set heading two seven zero",
+                                   "flite plan status", "request runway information"}) {
+        streaming.beginUtterance();
+        std::string heard;
+        for (char c : text) {
+            heard += c;
+            streaming.updateUtterance(heard);
+        }
+        EXPECT_EQ(streaming.endUtterance(text).command, batch.recognize(text).command) << text;
+    }
+}
+
+TEST(CommandRecognizerTest, FlightPhaseSelectsGrammar) {
+    CommandRecognizer recognizer;
+    recognizer.initialize();
+    EXPECT_EQ(recognizer.getFlightPhase(), FlightPhase::UNKNOWN);
+    EXPECT_EQ(recognizer.recognize("preflight checklist").command, "PREFLIGHT_CHECKLIST");
+    
+    recognizer.setFlightPhase(FlightPhase::CRUISE);
+    EXPECT_EQ(recognizer.recognize("preflight checklist").command, "UNKNOWN");
+    EXPECT_EQ(recognizer.recognize("climb to flight level three five zero").command, "SET_ALTITUDE");
+    EXPECT_EQ(recognizer.recognize("mayday").command, "EMERGENCY_LANDING");
+    
+    recognizer.setFlightPhase(FlightPhase::PREFLIGHT);
+    EXPECT_EQ(recognizer.recognize("preflight checklist").command, "PREFLIGHT_CHECKLIST");
+    EXPECT_EQ(recognizer.recognize("stabilized approach").command, "UNKNOWN");
+    
+    EXPECT_TRUE(recognizer.isCommandActive("EMERGENCY_LANDING", FlightPhase::TAXI_IN));
+    EXPECT_FALSE(recognizer.isCommandActive("SET_HEADING", FlightPhase::SHUTDOWN));
+    EXPECT_TRUE(recognizer.isCommandActive("SET_HEADING", FlightPhase::UNKNOWN));
+}
+
+TEST(CommandRecognizerTest, PhaseChangeRestartsUtterance) {
+    CommandRecognizer recognizer;
+    recognizer.initialize();
+    recognizer.setFlightPhase(FlightPhase::APPROACH);
+    
+    recognizer.beginUtterance();
+    recognizer.updateUtterance("stabilized");
+    recognizer.setFlightPhase(FlightPhase::LANDING);
+    EXPECT_EQ(recognizer.endUtterance("stabilized approach").command, "STABILIZED_APPROACH_CHECK");
+    
+    // Commands registered later join the grammars of their phases
+    recognizer.registerCommand({"GO_AROUND", "Go Around", {"go around"}, {}, false,
+                                flightPhaseBit(FlightPhase::APPROACH) | flightPhaseBit(FlightPhase::LANDING)});
+    EXPECT_EQ(recognizer.recognize("go around").command, "GO_AROUND");
+    recognizer.setFlightPhase(FlightPhase::CRUISE);
+    EXPECT_EQ(recognizer.recognize("go around").command, "UNKNOWN");
+}
+
+TEST(CommandRecognizerTest, CommandsGroupedByCategory) {
+    CommandRecognizer recognizer;
+    recognizer.initialize();
+    
+    std::vector<std::string> emergency;
+    for (const auto& command : recognizer.getCommandsInCategory(CommandCategory::EMERGENCY)) {
+        emergency.push_back(command.command_id);
+    }
+    EXPECT_EQ(emergency, (std::vector<std::string>{"DIVERT_TO_NEAREST", "EMERGENCY_LANDING"}));
+    EXPECT_EQ(recognizer.getCommandsInCategory(CommandCategory::NAVIGATION).size(), 5u);
+}
+
+TEST(EditDistancePatternTest, MatchesLevenshteinWithCutoff) {
+    EditDistancePattern pattern("kitten");
+    EXPECT_EQ(pattern.distance("sitting", 10), 3);
+    EXPECT_EQ(pattern.distance("sitting", 2), 3);    // cut off at max_distance + 1
+    EXPECT_EQ(pattern.distance("kitten", 0), 0);
+    
+    std::string long_text(80, 'a');
+    EditDistancePattern long_pattern(long_text);
+    EXPECT_EQ(long_pattern.distance(long_text.substr(0, 78) + "bb", 5), 2);
+}
+
+// ============================================================================
+// Voice Latency Tests
+// ============================================================================
+
+TEST(LatencyHistogramTest, PercentilesReportBucketBounds) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 90; ++i) histogram.record(3.0);    // (2, 4] ms bucket
+    for (int i = 0; i < 10; ++i) histogram.record(300.0);  // (256, 512] ms bucket
+
+    EXPECT_EQ(histogram.count(), 100u);
+    EXPECT_DOUBLE_EQ(histogram.percentile(0.5), 4.0);
+    EXPECT_DOUBLE_EQ(histogram.percentile(0.9), 4.0);
+    EXPECT_DOUBLE_EQ(histogram.percentile(0.95), 300.0);   // clamped to the maximum seen
+    EXPECT_DOUBLE_EQ(histogram.max(), 300.0);
+    EXPECT_NEAR(histogram.mean(), 32.7, 1e-9);
+}
+
+TEST(VoiceLatencyTracerTest, RecordsStageSpansAndTotal) {
+    VoiceLatencyTracer tracer;
+    auto t0 = VoiceLatencyTracer::Clock::now();
+    using std::chrono::milliseconds;
+
+    tracer.beginUtterance(t0);
+    tracer.mark(VoiceStage::SPEECH_END, t0 + milliseconds(800));
+    tracer.mark(VoiceStage::RECOGNIZED, t0 + milliseconds(830));
+    tracer.mark(VoiceStage::INTERPRETED, t0 + milliseconds(831));
+    tracer.mark(VoiceStage::READBACK, t0 + milliseconds(900));   // DISPATCHED skipped
+    EXPECT_FALSE(tracer.hasOpenUtterance());
+
+    // Marks after the utterance closed are dropped
+    tracer.mark(VoiceStage::DISPATCHED, t0 + milliseconds(950));
+
+    VoiceLatencyReport report = tracer.getReport();
+    EXPECT_EQ(report.utterances, 1u);
+    EXPECT_EQ(report.abandoned, 0u);
+    EXPECT_EQ(report.stage(VoiceStage::SPEECH_END).count(), 1u);
+    EXPECT_DOUBLE_EQ(report.stage(VoiceStage::SPEECH_END).max(), 800.0);
+    EXPECT_DOUBLE_EQ(report.stage(VoiceStage::RECOGNIZED).max(), 30.0);
+    EXPECT_EQ(report.stage(VoiceStage::DISPATCHED).count(), 0u);
+    EXPECT_DOUBLE_EQ(report.stage(VoiceStage::READBACK).max(), 69.0);
+    EXPECT_DOUBLE_EQ(report.total.max(), 900.0);
+}
+
+TEST(VoiceLatencyTracerTest, NoiseBurstsCountAsAbandoned) {
+    VoiceLatencyTracer tracer;
+    tracer.beginUtterance();
+    tracer.beginUtterance();   // a new utterance closes the unfinished one
+    tracer.endUtterance();
+
+    VoiceLatencyReport report = tracer.getReport();
+    EXPECT_EQ(report.abandoned, 2u);
+    EXPECT_EQ(report.utterances, 0u);
+    EXPECT_EQ(report.total.count(), 0u);
+}
+
+TEST(VoiceLatencyTracerTest, PipelineFeedsSystemMonitor) {
+    SystemMonitor monitor;
+    auto tracer = std::make_shared<VoiceLatencyTracer>();
+    tracer->setSystemMonitor(&monitor);
+
+    SpeechRecognizer recognizer;
+    VoiceInterpreter interpreter;
+    VoiceOutput voice_output;
+    ASSERT_TRUE(recognizer.initialize());
+    ASSERT_TRUE(interpreter.initialize());
+    ASSERT_TRUE(voice_output.initialize());
+    recognizer.setLatencyTracer(tracer);
+    interpreter.setLatencyTracer(tracer);
+    voice_output.setLatencyTracer(tracer);
+
+    uint32_t before = monitor.getComponentHealth(SystemComponent::VOICE_PIPELINE).queryCount;
+    tracer->beginUtterance();
+    RecognitionResult result = recognizer.recognizeText("climb to ten thousand feet");
+    SystemAction action = interpreter.interpretCommand(result.command);
+    tracer->mark(VoiceStage::DISPATCHED);
+    voice_output.playActionReadback(interpreter.getActionDescription(action));
+
+    EXPECT_FALSE(tracer->hasOpenUtterance());
+    VoiceLatencyReport report = tracer->getReport();
+    EXPECT_EQ(report.utterances, 1u);
+    EXPECT_EQ(report.stage(VoiceStage::RECOGNIZED).count(), 1u);
+    EXPECT_EQ(report.stage(VoiceStage::INTERPRETED).count(), 1u);
+    EXPECT_EQ(report.stage(VoiceStage::READBACK).count(), 1u);
+    EXPECT_EQ(monitor.getComponentHealth(SystemComponent::VOICE_PIPELINE).queryCount, before + 1);
+}
+
 // ============================================================================
 // Integration Tests
 // ============================================================================
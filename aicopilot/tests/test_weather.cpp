@@ -11,7 +11,7 @@
 *****************************************************************************/
 
 #include <gtest/gtest.h>
-#include "weather_data.h"
+#include "weather_database.hpp"
 #include "metar_parser.hpp"
 #include <chrono>
 #include <vector>
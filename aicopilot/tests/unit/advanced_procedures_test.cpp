@@ -0,0 +1,189 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*****************************************************************************/
+
+#include <gtest/gtest.h>
+#include "../../include/advanced_procedures.hpp"
+#include "../../include/navdata_provider.h"
+#include "../../include/weather_station_store.hpp"
+#include "../../include/work_stealing_pool.hpp"
+#include <memory>
+#include <string>
+
+using namespace AICopilot;
+
+namespace {
+
+const double ORIGIN_LAT = 40.0;
+const double ORIGIN_LON = -100.0;
+
+AirportInfo makeAirport(const std::string& icao, double northNM, std::vector<std::string> runways,
+                        int length = 6000) {
+    AirportInfo info{};
+    info.icao = icao;
+    info.position.latitude = ORIGIN_LAT + northNM / 60.0;
+    info.position.longitude = ORIGIN_LON;
+    info.longestRunway = length;
+    info.runways = std::move(runways);
+    return info;
+}
+
+PerformanceProfile makeProfile() {
+    PerformanceProfile profile{};
+    profile.cruiseSpeed = 120.0;  // knots
+    profile.fuelFlow = 10.0;      // gallons per hour
+    profile.range = 500.0;
+    return profile;
+}
+
+DiversionRequest makeRequest() {
+    DiversionRequest request;
+    request.position.latitude = ORIGIN_LAT;
+    request.position.longitude = ORIGIN_LON;
+    return request;
+}
+
+struct DiversionFixture {
+    std::shared_ptr<CachedNavdataProvider> navdata = std::make_shared<CachedNavdataProvider>();
+    std::shared_ptr<WeatherStationStore> weather = std::make_shared<WeatherStationStore>();
+    AdvancedProcedures procedures;
+
+    DiversionFixture() {
+        navdata->initialize();
+        procedures.initialize(makeProfile(), AircraftCategory::SINGLE_ENGINE_PISTON);
+    }
+
+    void attach(WorkStealingPool* pool = nullptr) {
+        procedures.setDiversionSources(navdata, weather, pool);
+    }
+};
+
+} // namespace
+
+// Test: With calm wind and good weather the nearest airport ranks first
+TEST(AdvancedProceduresTest, RanksByDistance) {
+    DiversionFixture f;
+    f.navdata->addAirport(makeAirport("KFAR", 40.0, {"18", "36"}));
+    f.navdata->addAirport(makeAirport("KNER", 10.0, {"18", "36"}));
+    f.navdata->addAirport(makeAirport("KMID", 25.0, {"18", "36"}));
+    f.navdata->addAirport(makeAirport("KOUT", 150.0, {"18", "36"}));
+    f.attach();
+    time_t now = std::time(nullptr);
+    for (const char* icao : {"KFAR", "KNER", "KMID"}) {
+        std::string metar = std::string(icao) + " 121200Z 00000KT 10SM CLR 20/10 A3000";
+        ASSERT_TRUE(f.weather->update(icao, metar, 3600, now));
+    }
+
+    DiversionPlan plan = f.procedures.planDiversion(makeRequest(), std::chrono::seconds(5));
+    EXPECT_TRUE(plan.complete);
+    ASSERT_EQ(plan.options.size(), 3u);
+    EXPECT_EQ(plan.options[0].icao, "KNER");
+    EXPECT_EQ(plan.options[1].icao, "KMID");
+    EXPECT_EQ(plan.options[2].icao, "KFAR");
+    EXPECT_EQ(plan.options[0].approach, ApproachType::ILS);
+    EXPECT_TRUE(plan.options[0].weatherReported);
+    EXPECT_NEAR(plan.options[0].distance, 10.0, 0.1);
+    EXPECT_GT(plan.candidatesScored, 3u);
+}
+
+// Test: A runway across a strong wind loses to a farther one into it; low ceilings rule airports out
+TEST(AdvancedProceduresTest, FiltersByCrosswindAndCeiling) {
+    DiversionFixture f;
+    f.navdata->addAirport(makeAirport("KXWD", 10.0, {"18", "36"}));
+    f.navdata->addAirport(makeAirport("KLOW", 5.0, {"09", "27"}));
+    f.navdata->addAirport(makeAirport("KINT", 30.0, {"09", "27"}));
+    f.attach();
+    time_t now = std::time(nullptr);
+    ASSERT_TRUE(f.weather->update("KXWD", "KXWD 121200Z 27025KT 10SM CLR 20/10 A3000", 3600, now));
+    ASSERT_TRUE(f.weather->update("KLOW", "KLOW 121200Z 27025KT 1/4SM OVC001 20/10 A3000", 3600, now));
+    ASSERT_TRUE(f.weather->update("KINT", "KINT 121200Z 27025KT 10SM CLR 20/10 A3000", 3600, now));
+
+    DiversionPlan plan = f.procedures.planDiversion(makeRequest(), std::chrono::seconds(5));
+    ASSERT_EQ(plan.options.size(), 1u);
+    EXPECT_EQ(plan.options[0].icao, "KINT");
+    EXPECT_EQ(plan.options[0].runway, "27");
+    EXPECT_NEAR(plan.options[0].headwind, 25.0, 0.5);
+    EXPECT_LT(plan.options[0].crosswind, 0.5);
+}
+
+// Test: Airports the remaining fuel cannot reach with reserve are dropped
+TEST(AdvancedProceduresTest, RespectsFuelRemaining) {
+    DiversionFixture f;
+    f.navdata->addAirport(makeAirport("KNER", 20.0, {"18"}));
+    f.navdata->addAirport(makeAirport("KFAR", 80.0, {"18"}));
+    f.attach();
+
+    // 20 NM is 10 minutes plus 45 of reserve: about 9.2 gallons; 80 NM needs 14.2
+    DiversionRequest request = makeRequest();
+    request.fuelRemaining = 12.0;
+    DiversionPlan plan = f.procedures.planDiversion(request, std::chrono::seconds(5));
+    ASSERT_EQ(plan.options.size(), 1u);
+    EXPECT_EQ(plan.options[0].icao, "KNER");
+    EXPECT_FALSE(plan.options[0].weatherReported);
+    EXPECT_NEAR(plan.options[0].fuelRequired, 20.0 / 120.0 * 10.0 + 7.5, 0.05);
+}
+
+// Test: Scoring on the pool gives the ranking of the inline search
+TEST(AdvancedProceduresTest, PoolMatchesInline) {
+    DiversionFixture f;
+    for (int i = 0; i < 40; ++i) {
+        f.navdata->addAirport(makeAirport("K" + std::to_string(100 + i), 2.0 + i * 2.3, {"18", "36"}));
+    }
+    f.attach();
+    DiversionRequest request = makeRequest();
+    request.maxOptions = 8;
+    DiversionPlan inlinePlan = f.procedures.planDiversion(request, std::chrono::seconds(5));
+
+    WorkStealingPool pool(4);
+    f.attach(&pool);
+    DiversionPlan pooledPlan = f.procedures.planDiversion(request, std::chrono::seconds(5));
+    pool.wait();
+
+    EXPECT_TRUE(pooledPlan.complete);
+    EXPECT_EQ(pooledPlan.airportsConsidered, inlinePlan.airportsConsidered);
+    EXPECT_EQ(pooledPlan.candidatesScored, inlinePlan.candidatesScored);
+    ASSERT_EQ(pooledPlan.options.size(), 8u);
+    ASSERT_EQ(inlinePlan.options.size(), 8u);
+    for (size_t i = 0; i < inlinePlan.options.size(); ++i) {
+        EXPECT_EQ(pooledPlan.options[i].icao, inlinePlan.options[i].icao);
+    }
+}
+
+// Test: An expired deadline returns an incomplete plan instead of blocking
+TEST(AdvancedProceduresTest, DeadlineReturnsPartialPlan) {
+    DiversionFixture f;
+    f.navdata->addAirport(makeAirport("KNER", 10.0, {"18"}));
+    f.navdata->addAirport(makeAirport("KFAR", 20.0, {"18"}));
+    f.attach();
+
+    DiversionPlan plan = f.procedures.planDiversion(makeRequest(), std::chrono::milliseconds(0));
+    EXPECT_FALSE(plan.complete);
+    EXPECT_EQ(plan.airportsConsidered, 2u);
+    EXPECT_LT(plan.airportsEvaluated, 2u);
+}
+
+// Test: Weather diversion picks the best-scored alternate, not the first listed
+TEST(AdvancedProceduresTest, WeatherDivertUsesPlanner) {
+    DiversionFixture f;
+    f.navdata->addAirport(makeAirport("KFAR", 60.0, {"18"}));
+    f.navdata->addAirport(makeAirport("KNER", 15.0, {"18"}));
+    f.attach();
+
+    Waypoint far;
+    far.id = "KFAR";
+    far.position = makeAirport("KFAR", 60.0, {}).position;
+    Waypoint nearby;
+    nearby.id = "KNER";
+    nearby.position = makeAirport("KNER", 15.0, {}).position;
+
+    Position here = makeRequest().position;
+    WeatherConditions weather{};
+    auto result = f.procedures.planWeatherDivert(here, far, {far, nearby}, 40.0, weather);
+    EXPECT_EQ(result.targetAirport.id, "KNER");
+    EXPECT_NEAR(result.routeDistance, 15.0, 0.1);
+}
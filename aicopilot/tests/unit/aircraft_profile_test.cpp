@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "../../include/aircraft_profile.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace AICopilot;
+
+namespace {
+
+void expectSameSchedule(const PhaseSchedule& a, const PhaseSchedule& b) {
+    for (size_t i = 0; i < FLIGHT_PHASE_COUNT; ++i) {
+        EXPECT_DOUBLE_EQ(a.phases[i].speed, b.phases[i].speed) << "phase " << i;
+        EXPECT_DOUBLE_EQ(a.phases[i].throttle, b.phases[i].throttle) << "phase " << i;
+        EXPECT_EQ(a.phases[i].flaps, b.phases[i].flaps) << "phase " << i;
+    }
+    EXPECT_DOUBLE_EQ(a.rotationPitch, b.rotationPitch);
+    EXPECT_DOUBLE_EQ(a.approachConfigAltitude, b.approachConfigAltitude);
+    EXPECT_DOUBLE_EQ(a.flareHeight, b.flareHeight);
+}
+
+} // namespace
+
+// Test: The piston law keeps the targets AIPilot used before schedules
+TEST(AircraftProfileTest, PistonScheduleMatchesFixedTargets) {
+    PhaseSchedule schedule = makePhaseSchedule<AircraftCategory::SINGLE_ENGINE_PISTON>(50.0, 120.0);
+    EXPECT_DOUBLE_EQ(schedule[FlightPhase::TAKEOFF].speed, 65.0);
+    EXPECT_DOUBLE_EQ(schedule[FlightPhase::TAKEOFF].throttle, 1.0);
+    EXPECT_DOUBLE_EQ(schedule[FlightPhase::CLIMB].speed, 90.0);
+    EXPECT_DOUBLE_EQ(schedule[FlightPhase::CRUISE].speed, 120.0);
+    EXPECT_EQ(schedule[FlightPhase::APPROACH].flaps, 50);
+    EXPECT_EQ(schedule[FlightPhase::LANDING].flaps, 100);
+    EXPECT_DOUBLE_EQ(schedule[FlightPhase::LANDING].throttle, 0.3);
+    EXPECT_DOUBLE_EQ(schedule.rotationPitch, 0.15);
+    EXPECT_DOUBLE_EQ(schedule.approachConfigAltitude, 3000.0);
+    EXPECT_DOUBLE_EQ(schedule.flareHeight, 50.0);
+}
+
+// Test: Runtime selection resolves to the matching specialization
+TEST(AircraftProfileTest, RuntimeSelectionMatchesSpecialization) {
+    expectSameSchedule(makePhaseSchedule(AircraftCategory::JET_TRANSPORT, 120.0, 450.0),
+                       makePhaseSchedule<AircraftCategory::JET_TRANSPORT>(120.0, 450.0));
+    expectSameSchedule(makePhaseSchedule(AircraftCategory::TURBOPROP, 80.0, 250.0),
+                       makePhaseSchedule<AircraftCategory::TURBOPROP>(80.0, 250.0));
+    expectSameSchedule(makePhaseSchedule(AircraftCategory::HELICOPTER, 0.0, 120.0),
+                       makePhaseSchedule<AircraftCategory::HELICOPTER>(0.0, 120.0));
+    expectSameSchedule(makePhaseSchedule(AircraftCategory::BUSINESS_JET, 100.0, 400.0),
+                       makePhaseSchedule<AircraftCategory::JET_TRANSPORT>(100.0, 400.0));
+    expectSameSchedule(makePhaseSchedule(AircraftCategory::UNKNOWN, 50.0, 120.0),
+                       makePhaseSchedule<AircraftCategory::SINGLE_ENGINE_PISTON>(50.0, 120.0));
+
+    EXPECT_EQ(makePhaseSchedule(AircraftCategory::HELICOPTER, 0.0, 120.0).category, AircraftCategory::HELICOPTER);
+    EXPECT_EQ(categoryForType(AircraftType::JET), AircraftCategory::JET_TRANSPORT);
+    EXPECT_EQ(categoryForType(AircraftType::MULTI_ENGINE_PROP), AircraftCategory::MULTI_ENGINE_PISTON);
+}
+
+// Test: Helicopters get speed targets without a stall speed and no flaps
+TEST(AircraftProfileTest, HelicopterScheduleIgnoresStallSpeed) {
+    PhaseSchedule schedule = makePhaseSchedule<AircraftCategory::HELICOPTER>(0.0, 120.0);
+    EXPECT_DOUBLE_EQ(schedule[FlightPhase::TAKEOFF].speed, 0.0);
+    EXPECT_GT(schedule[FlightPhase::APPROACH].speed, 0.0);
+    EXPECT_GT(schedule[FlightPhase::LANDING].speed, 0.0);
+    EXPECT_EQ(schedule[FlightPhase::APPROACH].flaps, 0);
+    EXPECT_EQ(schedule[FlightPhase::LANDING].flaps, 0);
+}
+
+// Test: Procedure speeds and takeoff power override the category law
+TEST(AircraftProfileTest, ProfileScheduleAppliesProcedures) {
+    AircraftProfile profile{};
+    profile.category = AircraftCategory::JET_TRANSPORT;
+    profile.performance.vs1 = 120.0;
+    profile.performance.cruiseSpeed = 450.0;
+    profile.procedures.rotationSpeed = 145.0;
+    profile.procedures.approachSpeed = 160.0;
+    profile.procedures.takeoffPower = 90.0;
+
+    PhaseSchedule schedule = profile.buildPhaseSchedule();
+    EXPECT_DOUBLE_EQ(schedule[FlightPhase::TAKEOFF].speed, 145.0);
+    EXPECT_DOUBLE_EQ(schedule[FlightPhase::TAKEOFF].throttle, 0.9);
+    EXPECT_DOUBLE_EQ(schedule[FlightPhase::APPROACH].speed, 160.0);
+    // Unset procedures keep the law's targets
+    EXPECT_DOUBLE_EQ(schedule[FlightPhase::CLIMB].speed, 450.0 * ControlLaw<AircraftCategory::JET_TRANSPORT>::CLIMB_FACTOR);
+    EXPECT_EQ(schedule[FlightPhase::TAKEOFF].flaps, ControlLaw<AircraftCategory::JET_TRANSPORT>::TAKEOFF_FLAPS);
+}
+
+// Test: Loaded profiles and schedules are found by designator without copies
+TEST(AircraftProfileTest, ManagerResolvesScheduleOnLoad) {
+    auto path = (std::filesystem::temp_directory_path() / "aicopilot_profile_test.cfg").string();
+    {
+        std::ofstream cfg(path);
+        cfg << "[GENERAL]\nicao_type_designator = C172\n"
+            << "[PERFORMANCE]\ncruise_speed = 122\nstall_speed = 48\n";
+    }
+
+    AircraftProfileManager manager;
+    EXPECT_EQ(manager.findProfile("C172"), nullptr);
+    EXPECT_EQ(manager.findPhaseSchedule("C172"), nullptr);
+    ASSERT_TRUE(manager.loadProfile(path));
+    std::remove(path.c_str());
+
+    ASSERT_TRUE(manager.hasProfile("C172"));
+    const AircraftProfile* profile = manager.findProfile("C172");
+    const PhaseSchedule* schedule = manager.findPhaseSchedule("C172");
+    ASSERT_NE(profile, nullptr);
+    ASSERT_NE(schedule, nullptr);
+    EXPECT_EQ(profile, manager.findProfile("C172"));
+    EXPECT_DOUBLE_EQ((*schedule)[FlightPhase::CRUISE].speed, 122.0);
+    EXPECT_DOUBLE_EQ((*schedule)[FlightPhase::TAKEOFF].speed, profile->procedures.rotationSpeed);
+    EXPECT_EQ(manager.getProfile("C172").icaoDesignator, "C172");
+    EXPECT_TRUE(manager.getProfile("B738").icaoDesignator.empty());
+}
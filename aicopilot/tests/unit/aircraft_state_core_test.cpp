@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include "../../include/aircraft_state_core.hpp"
+#include "../../include/headless_sim.hpp"
+#include "../../include/terrain_awareness.h"
+#include "../../include/traffic_system.h"
+#include <cstring>
+
+using namespace AICopilot;
+
+namespace {
+
+AircraftState cruiseState() {
+    AircraftState state{};
+    state.position = {47.5, -122.25, 6500.0, 0.0};
+    state.indicatedAirspeed = 120.0;
+    state.trueAirspeed = 132.0;
+    state.groundSpeed = 128.0;
+    state.verticalSpeed = -250.0;
+    state.pitch = 2.5;
+    state.bank = -10.0;
+    state.heading = 275.0;
+    state.altimeter = 29.92;
+    state.gearDown = true;
+    state.fuelQuantity = 38.5;
+    state.engineRPM = 2400.0;
+    state.flapsPosition = 10;
+    state.masterBattery = true;
+    state.masterAlternator = true;
+    state.batteryVoltage = 24.5;
+    state.generatorVoltage = 28.0;
+    state.generatorLoad = 12.0;
+    return state;
+}
+
+} // namespace
+
+// Test: The halves carry every field; merged they give the state back
+TEST(AircraftStateCoreTest, SplitsAndMerges) {
+    AircraftState state = cruiseState();
+    AircraftStateCore core = AircraftStateCore::fromAircraftState(state);
+    AircraftStateCold cold = AircraftStateCold::fromAircraftState(state);
+    EXPECT_DOUBLE_EQ(core.latitude, 47.5);
+    EXPECT_DOUBLE_EQ(core.heading, 275.0);
+    EXPECT_TRUE(core.gearDown());
+    EXPECT_FALSE(core.onGround());
+    EXPECT_EQ(cold.flapsPosition, 10);
+
+    AircraftState merged{};
+    core.applyTo(merged);
+    EXPECT_DOUBLE_EQ(merged.position.longitude, -122.25);
+    EXPECT_DOUBLE_EQ(merged.verticalSpeed, -250.0);
+    EXPECT_DOUBLE_EQ(merged.fuelQuantity, 0.0);       // cold fields untouched
+    cold.applyTo(merged);
+    EXPECT_DOUBLE_EQ(merged.fuelQuantity, 38.5);
+    EXPECT_DOUBLE_EQ(merged.generatorLoad, 12.0);
+    EXPECT_TRUE(merged.masterAlternator);
+    EXPECT_EQ(merged.flapsPosition, 10);
+}
+
+// Test: Each half's version moves only when that half changes
+TEST(AircraftStateCoreTest, StoreVersionsTrackChanges) {
+    AircraftStateStore store;
+    EXPECT_EQ(store.coreVersion(), 0u);
+    EXPECT_EQ(store.coldVersion(), 0u);
+
+    AircraftState state = cruiseState();
+    EXPECT_TRUE(store.publish(state));
+    EXPECT_EQ(store.coreVersion(), 1u);
+    EXPECT_EQ(store.coldVersion(), 1u);
+
+    EXPECT_FALSE(store.publish(state));
+    EXPECT_EQ(store.coreVersion(), 1u);
+    EXPECT_EQ(store.coldVersion(), 1u);
+
+    state.fuelQuantity -= 0.1;
+    EXPECT_TRUE(store.publish(state));
+    EXPECT_EQ(store.coreVersion(), 1u);
+    EXPECT_EQ(store.coldVersion(), 2u);
+
+    state.position.latitude += 0.001;
+    EXPECT_TRUE(store.publish(state));
+    uint64_t version = 0;
+    AircraftStateCore core = store.loadCore(version);
+    EXPECT_EQ(version, 2u);
+    EXPECT_DOUBLE_EQ(core.latitude, 47.501);
+    EXPECT_EQ(store.coldVersion(), 2u);
+
+    AircraftState loaded = store.load();
+    EXPECT_DOUBLE_EQ(loaded.position.latitude, 47.501);
+    EXPECT_DOUBLE_EQ(loaded.fuelQuantity, 38.4);
+    EXPECT_DOUBLE_EQ(loaded.heading, 275.0);
+
+    // A change below float resolution still publishes, and both the core
+    // and the rebuilt wide state keep it exactly
+    state.heading = 275.0 + 1e-9;
+    EXPECT_TRUE(store.publish(state));
+    EXPECT_EQ(store.coreVersion(), 3u);
+    EXPECT_EQ(store.load().heading, 275.0 + 1e-9);
+    EXPECT_EQ(store.loadCore().heading, 275.0 + 1e-9);
+
+    // Every field survives the split, bit for bit
+    state.position.heading = 123.456789;
+    state.pitch = 1.0 / 3.0;
+    store.publish(state);
+    AircraftState rebuilt = store.load();
+    EXPECT_EQ(std::memcmp(&rebuilt.position, &state.position, sizeof(state.position)), 0);
+    EXPECT_EQ(rebuilt.pitch, state.pitch);
+    EXPECT_EQ(rebuilt.generatorVoltage, state.generatorVoltage);
+    EXPECT_EQ(rebuilt.masterBattery, state.masterBattery);
+}
+
+// Test: Consumers fed the core skip a version they already applied
+TEST(AircraftStateCoreTest, ConsumersSkipUnchangedVersions) {
+    AircraftStateStore store;
+    AircraftState state = cruiseState();
+    store.publish(state);
+
+    TerrainAwareness terrain;
+    TrafficSystem traffic;
+    uint64_t version = 0;
+    AircraftStateCore core = store.loadCore(version);
+    EXPECT_TRUE(terrain.updateAircraftState(core, version));
+    EXPECT_FALSE(terrain.updateAircraftState(core, version));
+    EXPECT_TRUE(traffic.updateOwnAircraft(core, version));
+    EXPECT_FALSE(traffic.updateOwnAircraft(core, version));
+    EXPECT_EQ(terrain.getStateVersion(), 1u);
+
+    // Unversioned updates always apply
+    EXPECT_TRUE(traffic.updateOwnAircraft(core, 0));
+    EXPECT_TRUE(traffic.updateOwnAircraft(core, 0));
+
+    state.position.altitude += 100.0;
+    store.publish(state);
+    core = store.loadCore(version);
+    EXPECT_TRUE(terrain.updateAircraftState(core, version));
+    EXPECT_EQ(terrain.getStateVersion(), 2u);
+}
+
+// Test: The headless backend publishes versioned halves as it flies
+TEST(AircraftStateCoreTest, HeadlessSimPublishesVersions) {
+    HeadlessSimConfig config;
+    config.start = {47.0, -122.0, 5000.0, 90.0};
+    config.startOnGround = false;
+    HeadlessSimConnect sim(config);
+    ASSERT_TRUE(sim.connect(SimulatorType::UNKNOWN));
+
+    sim.processMessages();
+    uint64_t before = sim.getStateVersion();
+    EXPECT_GT(before, 0u);
+    EXPECT_GT(sim.getColdStateVersion(), 0u);
+    for (int i = 0; i < 30; ++i) {
+        sim.processMessages();
+    }
+
+    uint64_t version = 0;
+    AircraftStateCore core = sim.getAircraftStateCore(version);
+    EXPECT_GT(version, before);
+    EXPECT_EQ(version, sim.getStateVersion());
+    AircraftState state = sim.getAircraftState();
+    EXPECT_DOUBLE_EQ(core.latitude, state.position.latitude);
+    EXPECT_DOUBLE_EQ(core.altitude, state.position.altitude);
+    EXPECT_DOUBLE_EQ(core.groundSpeed, state.groundSpeed);
+}
@@ -0,0 +1,322 @@
+#include <gtest/gtest.h>
+#include "../../include/airport_manager.h"
+#include "../../include/atc_routing.hpp"
+#include "../../include/navdata_provider.h"
+#include <memory>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// Ladder of 2 x n nodes; rungs are one-way, and node 999 is only an edge endpoint
+Airport::TaxiwayNetwork makeLadder(int n) {
+    Airport::TaxiwayNetwork network;
+    for (int i = 0; i < n; ++i) {
+        for (int side = 0; side < 2; ++side) {
+            Airport::TaxiwayNode node(side * 100 + i, Airport::LatLonAlt(33.64 + i * 0.001, -84.43 + side * 0.002));
+            node.name = (side ? "B" : "A") + std::to_string(i);
+            network.add_node(node);
+        }
+    }
+    int edgeId = 1;
+    for (int i = 0; i + 1 < n; ++i) {
+        network.add_edge(Airport::TaxiwayEdge(edgeId++, i, i + 1, 400.0));
+        network.add_edge(Airport::TaxiwayEdge(edgeId++, 100 + i, 100 + i + 1, 420.0));
+    }
+    for (int i = 0; i < n; i += 2) {
+        Airport::TaxiwayEdge rung(edgeId++, i, 100 + i, 700.0);
+        rung.is_bidirectional = false;
+        rung.max_speed_knots = 10.0;
+        network.add_edge(rung);
+    }
+    network.add_edge(Airport::TaxiwayEdge(edgeId++, 0, 999, 50.0));
+    return network;
+}
+
+void expectSameQueries(const Airport::TaxiwayNetwork& a, const Airport::TaxiwayNetwork& b) {
+    ASSERT_EQ(a.get_node_count(), b.get_node_count());
+    ASSERT_EQ(a.get_edge_count(), b.get_edge_count());
+    ASSERT_EQ(a.get_all_node_ids(), b.get_all_node_ids());
+    ASSERT_EQ(a.get_index_count(), b.get_index_count());
+    for (int index = 0; index < static_cast<int>(a.get_index_count()); ++index) {
+        int id = a.get_node_id_at(index);
+        EXPECT_EQ(b.get_node_id_at(index), id);
+        EXPECT_EQ(b.get_node_index(id), index);
+        EXPECT_EQ(a.has_node_at(index), b.has_node_at(index));
+        EXPECT_EQ(a.get_position_at(index).latitude, b.get_position_at(index).latitude);
+
+        auto arcsA = a.get_arcs_at(index);
+        auto arcsB = b.get_arcs_at(index);
+        ASSERT_EQ(arcsA.size(), arcsB.size());
+        for (size_t k = 0; k < arcsA.size(); ++k) {
+            EXPECT_EQ(arcsA[k].to_index, arcsB[k].to_index);
+            EXPECT_EQ(arcsA[k].edge_id, arcsB[k].edge_id);
+        }
+        std::vector<int> edgesA(a.get_adjacent_edges(id).begin(), a.get_adjacent_edges(id).end());
+        std::vector<int> edgesB(b.get_adjacent_edges(id).begin(), b.get_adjacent_edges(id).end());
+        EXPECT_EQ(edgesA, edgesB);
+        for (int edgeId : edgesA) {
+            ASSERT_NE(b.get_edge(edgeId), nullptr);
+            EXPECT_EQ(b.get_edge(edgeId)->to_node_id, a.get_edge(edgeId)->to_node_id);
+            EXPECT_EQ(b.get_edge(edgeId)->length_feet, a.get_edge(edgeId)->length_feet);
+        }
+    }
+    for (int id : a.get_all_node_ids()) {
+        ASSERT_NE(b.get_node_const(id), nullptr);
+        EXPECT_EQ(b.get_node_const(id)->name, a.get_node_const(id)->name);
+    }
+}
+
+} // namespace
+
+// Test: A compacted network answers every query like the build form, and routes the same
+TEST(AirportLayoutTest, CompactMatchesBuildForm) {
+    Airport::TaxiwayNetwork built = makeLadder(12);
+    Airport::TaxiwayNetwork compact = built;
+    compact.compact();
+    ASSERT_TRUE(compact.is_compact());
+    EXPECT_FALSE(built.is_compact());
+    expectSameQueries(built, compact);
+    EXPECT_EQ(compact.get_revision(), built.get_revision());
+
+    // Never added as a node: indexed, but not present, and no node record
+    int orphan = compact.get_node_index(999);
+    ASSERT_GE(orphan, 0);
+    EXPECT_FALSE(compact.has_node_at(orphan));
+    EXPECT_EQ(compact.get_node_const(999), nullptr);
+    EXPECT_EQ(compact.get_node_index(12345), -1);
+    EXPECT_TRUE(compact.get_adjacent_edges(12345).empty());
+    EXPECT_EQ(compact.get_edge(77777), nullptr);
+
+    ATC::GroundRouter builtRouter;
+    builtRouter.set_taxiway_network(&built);
+    ATC::GroundRouter compactRouter;
+    compactRouter.set_taxiway_network(&compact);
+    auto expected = builtRouter.find_fastest_path(0, 111, Airport::LatLonAlt());
+    auto route = compactRouter.find_fastest_path(0, 111, Airport::LatLonAlt());
+    ASSERT_TRUE(expected.success);
+    ASSERT_TRUE(route.success);
+    EXPECT_EQ(route.path_node_ids, expected.path_node_ids);
+    EXPECT_EQ(route.path_edge_ids, expected.path_edge_ids);
+    EXPECT_DOUBLE_EQ(route.estimated_time_seconds, expected.estimated_time_seconds);
+}
+
+// Test: Copies share one compact graph until a copy is changed
+TEST(AirportLayoutTest, CopiesShareUntilChanged) {
+    Airport::TaxiwayNetwork original = makeLadder(6);
+    original.compact();
+    Airport::TaxiwayNetwork copy = original;
+    EXPECT_TRUE(copy.shares_storage_with(original));
+
+    copy.add_node(Airport::TaxiwayNode(50, Airport::LatLonAlt(33.7, -84.4)));
+    copy.add_edge(Airport::TaxiwayEdge(500, 5, 50, 300.0));
+    EXPECT_FALSE(copy.is_compact());
+    EXPECT_FALSE(copy.shares_storage_with(original));
+    EXPECT_GT(copy.get_revision(), original.get_revision());
+
+    EXPECT_TRUE(original.is_compact());
+    EXPECT_EQ(original.get_node_count(), 12u);
+    EXPECT_EQ(original.get_node_index(50), -1);
+    EXPECT_EQ(copy.get_node_count(), 13u);
+    EXPECT_EQ(copy.get_all_node_ids().front(), 0);
+    ASSERT_NE(copy.get_edge(500), nullptr);
+    ASSERT_NE(copy.get_edge(100500), nullptr);
+
+    // Everything from before the change survived the expansion
+    Airport::TaxiwayNetwork rebuilt = makeLadder(6);
+    rebuilt.add_node(Airport::TaxiwayNode(50, Airport::LatLonAlt(33.7, -84.4)));
+    rebuilt.add_edge(Airport::TaxiwayEdge(500, 5, 50, 300.0));
+    expectSameQueries(rebuilt, copy);
+}
+
+// Test: Parking and procedures come back from the flattened records unchanged
+TEST(AirportLayoutTest, LayoutRoundTrip) {
+    std::vector<Airport::Runway> runways = {Airport::Runway(9, "09"), Airport::Runway(27, "27")};
+
+    std::vector<Airport::ParkingPosition> parking;
+    for (int i = 0; i < 3; ++i) {
+        Airport::ParkingPosition stand(200 + i, Airport::LatLonAlt(33.64, -84.43 + i * 0.0005));
+        stand.gate_name = "C" + std::to_string(10 + i);
+        stand.type = Airport::ParkingPosition::Type::Gate;
+        stand.has_jetway = i != 1;
+        stand.max_wingspan_feet = 118.0 + i;
+        parking.push_back(stand);
+    }
+
+    std::map<std::string, std::vector<Airport::SIDSTARProcedure>> procedures;
+    Airport::SIDSTARProcedure sid("PORTR2");
+    sid.runway_ident = "27";
+    Airport::ProcedureWaypoint fix("PORTR", Airport::LatLonAlt(33.7, -84.6));
+    fix.altitude_feet = 5000.0;
+    fix.turn_at_waypoint = Airport::ProcedureWaypoint::TurnDirection::LeftTurn;
+    sid.add_waypoint(fix);
+    sid.add_waypoint(Airport::ProcedureWaypoint("JCKTS", Airport::LatLonAlt(33.9, -84.9)));
+    procedures["27"].push_back(sid);
+    Airport::SIDSTARProcedure star("CHPPR1");
+    star.procedure_type = Airport::SIDSTARProcedure::Type::STAR;
+    procedures[""].push_back(star);
+
+    auto layout = Airport::AirportLayoutData::build(runways, makeLadder(4), parking, procedures);
+    EXPECT_TRUE(layout->get_taxiway_network().is_compact());
+    ASSERT_EQ(layout->get_runways().size(), 2u);
+    ASSERT_EQ(layout->get_parking_count(), 3u);
+    EXPECT_EQ(layout->get_parking_string(layout->get_parking_record(2).gate_name), "C12");
+    EXPECT_EQ(layout->find_parking(201), 1);
+    EXPECT_EQ(layout->find_parking(7), -1);
+    Airport::ParkingPosition stand = layout->get_parking_at(1);
+    EXPECT_EQ(stand.gate_name, "C11");
+    EXPECT_FALSE(stand.has_jetway);
+    EXPECT_DOUBLE_EQ(stand.max_wingspan_feet, 119.0);
+
+    auto range = layout->get_procedure_range("27");
+    ASSERT_EQ(range.second - range.first, 1u);
+    Airport::SIDSTARProcedure back = layout->get_procedure_at(range.first);
+    EXPECT_EQ(back.procedure_name, "PORTR2");
+    ASSERT_EQ(back.get_waypoint_count(), 2u);
+    EXPECT_EQ(back.waypoints[0].name, "PORTR");
+    EXPECT_DOUBLE_EQ(back.waypoints[0].altitude_feet, 5000.0);
+    EXPECT_EQ(back.waypoints[0].turn_at_waypoint, Airport::ProcedureWaypoint::TurnDirection::LeftTurn);
+    EXPECT_EQ(layout->get_procedure_range("09").first, layout->get_procedure_range("09").second);
+    EXPECT_EQ(layout->get_procedures().at("").front().procedure_type, Airport::SIDSTARProcedure::Type::STAR);
+
+    Airport::AirportMaster master(1, "KATL");
+    master.set_layout(layout);
+    ASSERT_NE(master.get_runway("27"), nullptr);
+    Airport::ParkingPosition found;
+    EXPECT_TRUE(master.get_parking(202, found));
+    EXPECT_EQ(found.gate_name, "C12");
+    EXPECT_EQ(master.get_procedures("27").size(), 1u);
+    EXPECT_TRUE(master.get_procedures("09").empty());
+}
+
+// Test: Pilots at one airport on one provider hold the same layout
+TEST(AirportLayoutTest, ProviderSharesLayout) {
+    auto provider = std::make_shared<CachedNavdataProvider>();
+    provider->initialize();
+    AirportInfo info{};
+    info.icao = "KATL";
+    info.position.latitude = 33.64;
+    info.position.longitude = -84.43;
+    info.longestRunway = 12000;
+    info.runways = {"08L", "26R"};
+    provider->addAirport(info);
+
+    auto first = provider->getSharedAirportLayout("KATL");
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(provider->getSharedAirportLayout("katl"), first);
+    EXPECT_EQ(provider->getSharedAirportLayout("KXXX"), nullptr);
+
+    Integration::AirportManager pilotA(provider);
+    Integration::AirportManager pilotB(provider);
+    ASSERT_TRUE(pilotA.initialize("KATL", Airport::LatLonAlt()));
+    ASSERT_TRUE(pilotB.initialize("KATL", Airport::LatLonAlt()));
+    EXPECT_EQ(pilotA.get_layout(), first);
+    EXPECT_EQ(pilotB.get_airport_const()->get_shared_layout(), first);
+    EXPECT_EQ(pilotA.get_airport_const()->get_runways().size(), 2u);
+    EXPECT_TRUE(pilotA.get_airport_const()->get_taxiway_network().shares_storage_with(
+        pilotB.get_airport_const()->get_taxiway_network()));
+
+    // A change to one pilot's layout leaves the shared one alone
+    pilotB.add_runway(Airport::Runway(9, "09"));
+    EXPECT_EQ(pilotB.get_airport_const()->get_runways().size(), 3u);
+    EXPECT_EQ(first->get_runways().size(), 2u);
+    EXPECT_EQ(pilotA.get_layout(), first);
+
+    // New airport data replaces the cached layout
+    provider->addAirport(info);
+    EXPECT_NE(provider->getSharedAirportLayout("KATL"), first);
+}
+
+// Test: Lazy parts load once, on first read, and updates share the rest
+TEST(AirportLayoutTest, LazyPartsLoadOnFirstUse) {
+    int runwayLoads = 0;
+    int networkLoads = 0;
+    Airport::AirportLayoutData::Sources sources;
+    sources.runways = [&runwayLoads]() {
+        runwayLoads++;
+        return std::vector<Airport::Runway>{Airport::Runway(8, "08L"), Airport::Runway(26, "26R")};
+    };
+    sources.taxiway_network = [&networkLoads]() {
+        networkLoads++;
+        return makeLadder(6);
+    };
+    auto layout = Airport::AirportLayoutData::build_lazy(std::move(sources));
+    using Part = Airport::AirportLayoutData::Part;
+    EXPECT_FALSE(layout->is_loaded(Part::Runways));
+    EXPECT_FALSE(layout->is_loaded(Part::TaxiwayNetwork));
+    size_t unloadedBytes = layout->get_memory_bytes();
+
+    EXPECT_EQ(layout->get_runways().size(), 2u);
+    EXPECT_EQ(layout->get_runways().size(), 2u);
+    EXPECT_EQ(runwayLoads, 1);
+    EXPECT_TRUE(layout->is_loaded(Part::Runways));
+    EXPECT_FALSE(layout->is_loaded(Part::TaxiwayNetwork));
+    EXPECT_GT(layout->get_memory_bytes(), unloadedBytes);
+
+    // Parts without a loader are empty
+    EXPECT_EQ(layout->get_parking_count(), 0u);
+    EXPECT_EQ(layout->get_procedure_range("08L").first, layout->get_procedure_range("08L").second);
+
+    std::vector<Airport::ParkingPosition> parking = {Airport::ParkingPosition(1, Airport::LatLonAlt(33.64, -84.43))};
+    auto updated = layout->with_parking(parking);
+    EXPECT_EQ(updated->get_parking_count(), 1u);
+    EXPECT_EQ(layout->get_parking_count(), 0u);
+    EXPECT_TRUE(updated->shares_part_with(*layout, Part::TaxiwayNetwork));
+    EXPECT_FALSE(updated->shares_part_with(*layout, Part::Parking));
+    EXPECT_EQ(networkLoads, 0);
+
+    // The shared part loads once for both
+    EXPECT_TRUE(updated->get_taxiway_network().is_compact());
+    EXPECT_EQ(layout->get_taxiway_network().get_node_count(), 12u);
+    EXPECT_EQ(networkLoads, 1);
+}
+
+// Test: The manager keeps recent airports, waits for prefetches and patches in place
+TEST(AirportLayoutTest, ManagerCachesRecentAirports) {
+    auto provider = std::make_shared<CachedNavdataProvider>();
+    provider->initialize();
+    for (const char* icao : {"KATL", "KCLT", "KMCO"}) {
+        AirportInfo info{};
+        info.icao = icao;
+        info.position.latitude = 33.0;
+        info.position.longitude = -84.0;
+        info.longestRunway = 9000;
+        info.runways = {"18", "36"};
+        provider->addAirport(info);
+    }
+
+    Integration::AirportManager manager(provider);
+    manager.prefetch({"kclt", "KMCO", "KXXX"});
+    ASSERT_TRUE(manager.initialize("KCLT", Airport::LatLonAlt()));
+    EXPECT_TRUE(manager.is_layout_ready("KCLT"));
+    EXPECT_EQ(manager.get_layout(), provider->getSharedAirportLayout("KCLT"));
+    EXPECT_EQ(manager.get_airport_const()->get_runways().size(), 2u);
+
+    ASSERT_TRUE(manager.initialize("KMCO", Airport::LatLonAlt()));
+    EXPECT_FALSE(manager.is_layout_ready("KXXX"));
+    auto clt = provider->getSharedAirportLayout("KCLT");
+    ASSERT_TRUE(manager.initialize("KCLT", Airport::LatLonAlt()));
+    EXPECT_EQ(manager.get_layout(), clt);
+    EXPECT_GE(manager.get_layout_cache_stats().hits, 1u);
+    EXPECT_EQ(manager.get_layout_cache_stats().tiles, 2u);
+
+    // Over budget, only the most recent airport stays
+    manager.set_layout_cache_budget(1);
+    EXPECT_EQ(manager.get_layout_cache_stats().tiles, 1u);
+    EXPECT_TRUE(manager.is_layout_ready("KCLT"));
+    EXPECT_FALSE(manager.is_layout_ready("KMCO"));
+
+    // Incremental updates keep the untouched parts and the same airport object
+    const Airport::AirportMaster* airport = manager.get_airport_const();
+    auto before = manager.get_layout();
+    manager.set_elevation(748.0);
+    manager.set_parking_positions({Airport::ParkingPosition(5, Airport::LatLonAlt(33.0, -84.0))});
+    EXPECT_EQ(manager.get_airport_const(), airport);
+    EXPECT_DOUBLE_EQ(airport->get_elevation(), 748.0);
+    Airport::ParkingPosition found;
+    EXPECT_TRUE(airport->get_parking(5, found));
+    EXPECT_TRUE(manager.get_layout()->shares_part_with(*before, Airport::AirportLayoutData::Part::Runways));
+    EXPECT_TRUE(manager.get_layout()->shares_part_with(*before, Airport::AirportLayoutData::Part::TaxiwayNetwork));
+    EXPECT_EQ(provider->getSharedAirportLayout("KCLT")->get_parking_count(), before->get_parking_count());
+}
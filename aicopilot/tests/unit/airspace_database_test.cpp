@@ -0,0 +1,285 @@
+#include <gtest/gtest.h>
+#include "../../include/airspace_database.hpp"
+#include "../../include/airway_search.hpp"
+#include "../../include/dynamic_flight_planning.hpp"
+#include "../../include/geodesy.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// Irregular star-shaped (often concave) boundary around a centre
+AirspaceVolume makeStar(std::mt19937& rng, double lat, double lon, double radius, AirspaceClass type,
+                        double floorFt, double ceilingFt) {
+    std::uniform_real_distribution<double> scale(0.4, 1.0);
+    std::uniform_int_distribution<int> vertices(5, 40);
+    AirspaceVolume volume;
+    volume.type = type;
+    volume.floorFt = floorFt;
+    volume.ceilingFt = ceilingFt;
+    int n = vertices(rng);
+    for (int i = 0; i < n; ++i) {
+        double angle = 2.0 * 3.14159265358979323846 * i / n;
+        double r = radius * scale(rng);
+        volume.boundary.push_back({lat + r * std::sin(angle), lon + r * std::cos(angle)});
+    }
+    return volume;
+}
+
+AirspaceVolume makeBox(AirspaceClass type, double south, double west, double north, double east,
+                       double floorFt = 0.0, double ceilingFt = 60000.0) {
+    AirspaceVolume volume;
+    volume.type = type;
+    volume.floorFt = floorFt;
+    volume.ceilingFt = ceilingFt;
+    volume.boundary = {{south, west}, {south, east}, {north, east}, {north, west}};
+    return volume;
+}
+
+// Plain per-vertex ray cast
+bool referenceContains(const AirspaceVolume& volume, double lat, double lon) {
+    bool inside = false;
+    const auto& b = volume.boundary;
+    for (size_t i = 0, j = b.size() - 1; i < b.size(); j = i++) {
+        if ((b[i].latitude <= lat) != (b[j].latitude <= lat)) {
+            double x = b[i].longitude + (lat - b[i].latitude) / (b[j].latitude - b[i].latitude) *
+                                            (b[j].longitude - b[i].longitude);
+            if (lon < x) inside = !inside;
+        }
+    }
+    return inside;
+}
+
+Position at(double lat, double lon) {
+    return Position{lat, lon, 0.0, 0.0};
+}
+
+} // namespace
+
+// Test: Containment through the R-tree matches a ray cast over every volume
+TEST(AirspaceDatabaseTest, ContainmentMatchesLinearScan) {
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> lat(30.0, 40.0);
+    std::uniform_real_distribution<double> lon(-100.0, -90.0);
+    std::uniform_real_distribution<double> floor(0.0, 10000.0);
+    std::vector<AirspaceVolume> volumes;
+    for (int i = 0; i < 400; ++i) {
+        double base = floor(rng);
+        volumes.push_back(makeStar(rng, lat(rng), lon(rng), 0.5, AirspaceClass::CLASS_D, base, base + 8000.0));
+    }
+    volumes.push_back(AirspaceVolume{});   // no boundary: kept, never matches
+    AirspaceDatabase database;
+    database.build(volumes);
+    ASSERT_EQ(database.size(), volumes.size());
+
+    std::vector<uint32_t> found;
+    size_t hits = 0;
+    for (int i = 0; i < 3000; ++i) {
+        double la = lat(rng), lo = lon(rng), alt = 12000.0 * std::uniform_real_distribution<double>(0, 1)(rng);
+        std::vector<uint32_t> expected;
+        for (uint32_t id = 0; id + 1 < volumes.size(); ++id) {
+            if (alt >= volumes[id].floorFt && alt <= volumes[id].ceilingFt &&
+                referenceContains(volumes[id], la, lo)) {
+                expected.push_back(id);
+            }
+            EXPECT_EQ(database.contains(id, la, lo), referenceContains(volumes[id], la, lo));
+            if (i > 50) break;  // the per-volume check needs only a few points
+        }
+        if (i > 50) {
+            expected.clear();
+            for (uint32_t id = 0; id + 1 < volumes.size(); ++id) {
+                if (alt >= volumes[id].floorFt && alt <= volumes[id].ceilingFt &&
+                    referenceContains(volumes[id], la, lo)) {
+                    expected.push_back(id);
+                }
+            }
+        }
+        database.findContaining(la, lo, alt, found);
+        EXPECT_EQ(found, expected) << la << " " << lo;
+        hits += found.size();
+    }
+    EXPECT_GT(hits, 50u);
+    EXPECT_FALSE(database.contains(static_cast<uint32_t>(volumes.size() - 1), 35.0, -95.0));
+}
+
+// Test: The inside length and entry/exit of a segment match dense sampling
+TEST(AirspaceDatabaseTest, SegmentCrossingsMatchSampling) {
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<double> lat(34.0, 36.0);
+    std::uniform_real_distribution<double> lon(-96.0, -94.0);
+    std::vector<AirspaceVolume> volumes;
+    for (int i = 0; i < 30; ++i) {
+        volumes.push_back(makeStar(rng, lat(rng), lon(rng), 0.4, AirspaceClass::RESTRICTED, 0.0, 20000.0));
+    }
+    AirspaceDatabase database;
+    database.build(volumes);
+
+    std::vector<AirspaceCrossing> crossings;
+    size_t checked = 0;
+    for (int i = 0; i < 200; ++i) {
+        Position from = at(lat(rng), lon(rng));
+        Position to = at(lat(rng), lon(rng));
+        double length = Geodesy::flatDistanceNM(from.latitude, from.longitude, to.latitude, to.longitude);
+        database.querySegment(from, to, 10000.0, crossings);
+
+        const int samples = 4000;
+        for (uint32_t id = 0; id < volumes.size(); ++id) {
+            int inside = 0;
+            double first = -1.0, last = -1.0;
+            for (int s = 0; s < samples; ++s) {
+                double t = (s + 0.5) / samples;
+                if (referenceContains(volumes[id], from.latitude + (to.latitude - from.latitude) * t,
+                                      from.longitude + (to.longitude - from.longitude) * t)) {
+                    ++inside;
+                    if (first < 0.0) first = t;
+                    last = t;
+                }
+            }
+            auto it = std::find_if(crossings.begin(), crossings.end(),
+                                   [id](const AirspaceCrossing& c) { return c.id == id; });
+            if (inside == 0) {
+                if (it != crossings.end()) {
+                    EXPECT_LT(it->insideNM, length * 2.0 / samples) << i;
+                }
+                continue;
+            }
+            ASSERT_NE(it, crossings.end()) << i << " " << id;
+            // Slivers thinner than a sample step are found only by the crossing
+            EXPECT_NEAR(it->insideNM, length * inside / samples, length * 8.0 / samples);
+            EXPECT_LE(it->entry, first + 1.0 / samples);
+            EXPECT_GE(it->exit, last - 1.0 / samples);
+            ++checked;
+        }
+        EXPECT_TRUE(std::is_sorted(crossings.begin(), crossings.end(),
+                                   [](const AirspaceCrossing& a, const AirspaceCrossing& b) { return a.id < b.id; }));
+    }
+    EXPECT_GT(checked, 50u);
+
+    // Above the ceiling nothing is crossed
+    database.querySegment(at(34.0, -96.0), at(36.0, -94.0), 25000.0, crossings);
+    EXPECT_TRUE(crossings.empty());
+}
+
+// Test: Weighted miles per class; closed classes make a leg impassable
+TEST(AirspaceDatabaseTest, SegmentCost) {
+    // A U open to the north, 1 deg wide, arms 0.2 deg wide
+    AirspaceVolume u;
+    u.type = AirspaceClass::CLASS_B;
+    u.floorFt = 0.0;
+    u.ceilingFt = 10000.0;
+    u.boundary = {{40.0, -100.0}, {40.0, -99.0}, {41.0, -99.0}, {41.0, -99.2},
+                  {40.2, -99.2}, {40.2, -99.8}, {41.0, -99.8}, {41.0, -100.0}};
+    AirspaceDatabase database;
+    database.build({u, makeBox(AirspaceClass::TFR, 42.0, -100.0, 42.5, -99.5, 0.0, 18000.0)});
+
+    // East-west through both arms at 40.5N: 0.4 deg of longitude inside
+    Position west = at(40.5, -100.5);
+    Position east = at(40.5, -98.5);
+    std::vector<AirspaceCrossing> crossings;
+    database.querySegment(west, east, 5000.0, crossings);
+    ASSERT_EQ(crossings.size(), 1u);
+    double degreeNM = Geodesy::flatDistanceNM(40.5, -100.0, 40.5, -99.0);
+    EXPECT_NEAR(crossings[0].insideNM, 0.4 * degreeNM, 1e-6);
+    EXPECT_NEAR(crossings[0].entry, 0.25, 1e-9);
+    EXPECT_NEAR(crossings[0].exit, 0.75, 1e-9);
+
+    AirspaceCostWeights weights;
+    EXPECT_FALSE(weights.any());
+    EXPECT_EQ(database.segmentCost(west, east, 5000.0, weights), 0.0);
+    weights.set(AirspaceClass::CLASS_B, 2.0).set(AirspaceClass::TFR, std::numeric_limits<double>::infinity());
+    EXPECT_NEAR(database.segmentCost(west, east, 5000.0, weights), 0.8 * degreeNM, 1e-6);
+    EXPECT_EQ(database.segmentCost(west, east, 12000.0, weights), 0.0);
+
+    // Through the gap of the U the leg is free
+    EXPECT_EQ(database.segmentCost(at(40.5, -99.5), at(41.5, -99.5), 5000.0, weights), 0.0);
+
+    // Into the TFR it is closed; above it, open
+    EXPECT_TRUE(std::isinf(database.segmentCost(at(41.5, -99.7), at(42.2, -99.7), 5000.0, weights)));
+    EXPECT_EQ(database.segmentCost(at(41.5, -99.7), at(42.2, -99.7), 20000.0, weights), 0.0);
+}
+
+// Test: Airway search prices legs through airspace and avoids closed volumes
+TEST(AirspaceDatabaseTest, AirwaySearchAvoidsClosedAirspace) {
+    // A - D - C along J1, a direct A - C just south of it
+    NavdataPackBuilder builder;
+    builder.putWaypoint(NavdataWaypoint("AAAAA", 40.0, -80.0, NavaidType::FIX, 0, 0, "TEST"));
+    builder.putWaypoint(NavdataWaypoint("CCCCC", 40.0, -78.0, NavaidType::FIX, 0, 0, "TEST"));
+    builder.putWaypoint(NavdataWaypoint("DDDDD", 40.1, -79.0, NavaidType::FIX, 0, 0, "TEST"));
+    Airway j1("J1", 18000, 45000, AirwayLevel::HIGH);
+    j1.waypointSequence = {"AAAAA", "DDDDD", "CCCCC"};
+    builder.putAirway(j1);
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(builder.build()));
+
+    AirwaySearchRequest request;
+    request.origin = pack.findWaypoint("AAAAA");
+    request.destination = pack.findWaypoint("CCCCC");
+    request.cruiseAltitude = 35000;
+    request.directRadiusNM = 200.0;
+    request.directPenalty = 1.1;
+    std::vector<AirwayPathStep> path;
+    ASSERT_TRUE(AirwaySearch::findPath(pack, request, path));
+    ASSERT_EQ(path.size(), 3u);
+    EXPECT_EQ(path[1].node, pack.findWaypoint("DDDDD"));
+
+    AirspaceDatabase airspace;
+    airspace.build({makeBox(AirspaceClass::RESTRICTED, 40.05, -79.1, 40.15, -78.9)});
+    request.airspace = &airspace;
+    request.airspaceWeights.set(AirspaceClass::RESTRICTED, std::numeric_limits<double>::infinity());
+    ASSERT_TRUE(AirwaySearch::findPath(pack, request, path));
+    ASSERT_EQ(path.size(), 2u);
+    EXPECT_EQ(path[1].node, request.destination);
+
+    // Below the floor the volume costs nothing
+    airspace.build({makeBox(AirspaceClass::RESTRICTED, 40.05, -79.1, 40.15, -78.9, 40000.0, 60000.0)});
+    ASSERT_TRUE(AirwaySearch::findPath(pack, request, path));
+    EXPECT_EQ(path.size(), 3u);
+}
+
+// Test: Flight planning reprices the kept route's legs through airspace
+TEST(AirspaceDatabaseTest, FlightPlanningAvoidsClosedAirspace) {
+    PerformanceProfile profile{};
+    profile.cruiseSpeed = 120.0;
+    profile.serviceCeiling = 15000.0;
+    profile.fuelFlow = 10.0;
+    DynamicFlightPlanning planning;
+    ASSERT_TRUE(planning.initialize(profile));
+
+    auto fix = [](const std::string& id, double lat, double lon) {
+        Waypoint waypoint;
+        waypoint.id = id;
+        waypoint.position.latitude = lat;
+        waypoint.position.longitude = lon;
+        return waypoint;
+    };
+    std::vector<Waypoint> route = {fix("DEP", 45.0, -122.0), fix("A", 45.3, -121.8), fix("B", 45.6, -122.0),
+                                   fix("C", 45.9, -121.8), fix("D", 46.2, -122.0), fix("DEST", 46.5, -121.8)};
+    auto planned = planning.optimizeRoute(route.front(), route.back(), route, 100.0,
+                                          OptimizationObjective::TIME_OPTIMIZATION);
+    ASSERT_FALSE(planned.optimizedWaypoints.empty());
+
+    // A TFR over C closes every leg into it or across it
+    auto airspace = std::make_shared<AirspaceDatabase>();
+    airspace->build({makeBox(AirspaceClass::TFR, 45.85, -121.85, 45.95, -121.75, 0.0, 18000.0)});
+    AirspaceCostWeights weights;
+    weights.set(AirspaceClass::TFR, std::numeric_limits<double>::infinity());
+    EXPECT_GT(planning.setAirspace(airspace, weights), 0u);
+
+    Position current;
+    current.latitude = 45.3;
+    current.longitude = -121.8;
+    auto rerouted = planning.reoptimizeMidFlight(current, route.back(), 100.0,
+                                                 OptimizationObjective::TIME_OPTIMIZATION);
+    ASSERT_GE(rerouted.optimizedWaypoints.size(), 2u);
+    EXPECT_EQ(rerouted.optimizedWaypoints.back().id, "DEST");
+    for (const auto& waypoint : rerouted.optimizedWaypoints) EXPECT_NE(waypoint.id, "C");
+    EXPECT_GT(rerouted.estimatedTime, 0.0);
+
+    EXPECT_GT(planning.setAirspace(nullptr, weights), 0u);
+}
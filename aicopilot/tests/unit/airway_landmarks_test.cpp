@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "../../include/airway_landmarks.hpp"
+#include "../../include/airway_search.hpp"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+using namespace AICopilot;
+
+namespace {
+
+// Random network; every third airway is high only
+std::vector<uint8_t> makeImage(unsigned seed, int fixCount = 600, int airwayCount = 300) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> lat(30.0, 48.0), lon(-120.0, -75.0);
+    NavdataPackBuilder builder;
+    for (int i = 0; i < fixCount; ++i) {
+        builder.putWaypoint(NavdataWaypoint("F" + std::to_string(i), lat(rng), lon(rng), NavaidType::FIX, 0, 0, "TEST"));
+    }
+    std::uniform_int_distribution<int> pick(0, fixCount - 1);
+    for (int a = 0; a < airwayCount; ++a) {
+        Airway airway("R" + std::to_string(a), a % 3 == 0 ? 18000 : 0, 45000, AirwayLevel::HIGH);
+        for (int k = 0; k < 6; ++k) airway.waypointSequence.push_back("F" + std::to_string(pick(rng)));
+        builder.putAirway(airway);
+    }
+    return builder.build();
+}
+
+double totalNM(const std::vector<AirwayPathStep>& path) {
+    double total = 0.0;
+    for (const auto& step : path) total += step.distanceNM;
+    return total;
+}
+
+} // namespace
+
+// Test: Altitudes with the same valid airways share one band
+TEST(AirwayLandmarksTest, BuildsBands) {
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(makeImage(3)));
+    AirwayLandmarks landmarks;
+    ASSERT_TRUE(landmarks.build(pack, {9000, 35000, 20000, 17999}, 4));
+    EXPECT_EQ(landmarks.getBandCount(), 2u);
+    EXPECT_EQ(landmarks.getLandmarkCount(), 4u);
+    EXPECT_TRUE(landmarks.matches(pack));
+
+    const AirwayLandmarks::Band* low = landmarks.findBand(9000);
+    ASSERT_NE(low, nullptr);
+    EXPECT_EQ(low->lowAltitude, 0);
+    EXPECT_EQ(low->highAltitude, 17999);
+    EXPECT_EQ(landmarks.findBand(40000), landmarks.findBand(35000));
+    EXPECT_EQ(landmarks.findBand(50000), nullptr);
+    EXPECT_EQ(low->distances.size(), pack.getWaypointCount() * 4);
+    for (uint32_t l = 0; l < 4; ++l) EXPECT_EQ(low->distances[low->landmarks[l] * 4 + l], 0.0f);
+}
+
+// Test: Searches with landmark bounds still find the optimal path
+TEST(AirwayLandmarksTest, SearchStaysOptimal) {
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(makeImage(7)));
+    AirwayLandmarks landmarks;
+    ASSERT_TRUE(landmarks.build(pack, {9000, 35000}));
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<uint32_t> pick(0, static_cast<uint32_t>(pack.getWaypointCount() - 1));
+    std::vector<AirwayPathStep> plain, guided;
+    int compared = 0;
+    for (int q = 0; q < 200; ++q) {
+        AirwaySearchRequest request;
+        request.origin = pick(rng);
+        request.destination = pick(rng);
+        request.cruiseAltitude = q % 2 ? 35000 : 9000;
+        if (q % 4 == 3) {
+            // Off-network style exits, at a penalty
+            uint32_t a = pick(rng), b = pick(rng);
+            request.exits.push_back({a, AirwaySearch::distanceNM(pack, a, request.destination)});
+            request.exits.push_back({b, AirwaySearch::distanceNM(pack, b, request.destination)});
+            request.directPenalty = 1.1;
+        }
+
+        bool foundPlain = AirwaySearch::findPath(pack, request, plain);
+        request.landmarks = &landmarks;
+        bool foundGuided = AirwaySearch::findPath(pack, request, guided);
+        ASSERT_EQ(foundPlain, foundGuided);
+        if (!foundPlain) continue;
+        EXPECT_NEAR(totalNM(guided), totalNM(plain), 1e-3);
+        EXPECT_EQ(guided.front().node, request.origin);
+        EXPECT_EQ(guided.back().node, request.destination);
+        compared++;
+    }
+    EXPECT_GT(compared, 50);
+}
+
+// Test: Tables survive a round trip and are refused for another pack
+TEST(AirwayLandmarksTest, PersistsPerPack) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_airway_landmarks";
+    std::filesystem::create_directories(dir);
+    auto path = AirwayLandmarks::pathFor((dir / "cycle.anp").string());
+
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(makeImage(5, 200, 100)));
+    AirwayLandmarks built;
+    ASSERT_TRUE(built.build(pack, {35000}, 6));
+    ASSERT_TRUE(built.save(path));
+
+    AirwayLandmarks loaded;
+    ASSERT_TRUE(loaded.load(path, pack));
+    EXPECT_EQ(loaded.getBandCount(), 1u);
+    EXPECT_EQ(loaded.getLandmarkCount(), 6u);
+    EXPECT_EQ(loaded.findBand(35000)->landmarks, built.findBand(35000)->landmarks);
+    EXPECT_EQ(loaded.findBand(35000)->distances, built.findBand(35000)->distances);
+
+    NavdataPack other;
+    ASSERT_TRUE(other.openImage(makeImage(6, 200, 100)));
+    EXPECT_FALSE(loaded.load(path, other));
+    EXPECT_FALSE(loaded.matches(other));
+
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(64);
+        char byte = static_cast<char>(file.get());
+        file.seekp(64);
+        file.put(static_cast<char>(byte ^ 0x5A));
+    }
+    EXPECT_FALSE(loaded.load(path, pack));
+
+    std::filesystem::remove_all(dir);
+}
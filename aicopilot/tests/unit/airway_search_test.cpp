@@ -0,0 +1,238 @@
+#include <gtest/gtest.h>
+#include "../../include/airway_search.hpp"
+#include <limits>
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+
+using namespace AICopilot;
+
+namespace {
+
+// A - B - C along V1 (low), A - D - C along J1 (high, shorter), E off-network
+std::vector<uint8_t> makeImage() {
+    NavdataPackBuilder builder;
+    builder.putWaypoint(NavdataWaypoint("AAAAA", 40.0, -80.0, NavaidType::FIX, 0, 0, "TEST"));
+    builder.putWaypoint(NavdataWaypoint("BBBBB", 41.0, -79.0, NavaidType::FIX, 0, 0, "TEST"));
+    builder.putWaypoint(NavdataWaypoint("CCCCC", 40.0, -78.0, NavaidType::FIX, 0, 0, "TEST"));
+    builder.putWaypoint(NavdataWaypoint("DDDDD", 40.1, -79.0, NavaidType::FIX, 0, 0, "TEST"));
+    builder.putWaypoint(NavdataWaypoint("EEEEE", 40.0, -77.5, NavaidType::AIRPORT, 0, 0, "TEST"));
+
+    Airway v1("V1", 1000, 18000, AirwayLevel::LOW);
+    v1.waypointSequence = {"AAAAA", "BBBBB", "CCCCC"};
+    builder.putAirway(v1);
+    Airway j1("J1", 18000, 45000, AirwayLevel::HIGH);
+    j1.waypointSequence = {"AAAAA", "DDDDD", "CCCCC"};
+    builder.putAirway(j1);
+
+    return builder.build();
+}
+
+std::vector<std::string> names(const NavdataPack& pack, const std::vector<AirwayPathStep>& path) {
+    std::vector<std::string> out;
+    for (const auto& step : path) out.emplace_back(pack.getWaypointName(step.node));
+    return out;
+}
+
+} // namespace
+
+// Test: The cheapest airway valid at the cruise altitude is chosen
+TEST(AirwaySearchTest, RespectsAltitude) {
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(makeImage()));
+    AirwaySearchRequest request;
+    request.origin = pack.findWaypoint("AAAAA");
+    request.destination = pack.findWaypoint("CCCCC");
+    std::vector<AirwayPathStep> path;
+
+    request.cruiseAltitude = 35000;
+    ASSERT_TRUE(AirwaySearch::findPath(pack, request, path));
+    EXPECT_EQ(names(pack, path), (std::vector<std::string>{"AAAAA", "DDDDD", "CCCCC"}));
+    EXPECT_EQ(path[0].airway, NavdataPack::NO_INDEX);
+    EXPECT_EQ(path[1].airway, pack.findAirway("J1"));
+
+    request.cruiseAltitude = 9000;
+    ASSERT_TRUE(AirwaySearch::findPath(pack, request, path));
+    EXPECT_EQ(names(pack, path), (std::vector<std::string>{"AAAAA", "BBBBB", "CCCCC"}));
+    EXPECT_NEAR(path[1].distanceNM + path[2].distanceNM,
+                pack.getAirwayRecord(pack.findAirway("V1")).totalDistanceNM, 1e-9);
+
+    request.cruiseAltitude = 50000;
+    EXPECT_FALSE(AirwaySearch::findPath(pack, request, path));
+    EXPECT_TRUE(path.empty());
+}
+
+// Test: Direct legs join off-network endpoints, at the requested penalty
+TEST(AirwaySearchTest, DirectLegs) {
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(makeImage()));
+    uint32_t c = pack.findWaypoint("CCCCC");
+    uint32_t e = pack.findWaypoint("EEEEE");
+
+    AirwaySearchRequest request;
+    request.origin = pack.findWaypoint("AAAAA");
+    request.destination = e;
+    request.cruiseAltitude = 35000;
+    std::vector<AirwayPathStep> path;
+    EXPECT_FALSE(AirwaySearch::findPath(pack, request, path));
+
+    request.exits.push_back({c, AirwaySearch::distanceNM(pack, c, e)});
+    request.directPenalty = 1.1;
+    ASSERT_TRUE(AirwaySearch::findPath(pack, request, path));
+    ASSERT_EQ(path.size(), 4u);
+    EXPECT_EQ(path.back().node, e);
+    EXPECT_EQ(path.back().airway, NavdataPack::NO_INDEX);
+    EXPECT_NEAR(path.back().distanceNM, AirwaySearch::distanceNM(pack, c, e), 1e-9);
+
+    request.destination = request.origin;
+    ASSERT_TRUE(AirwaySearch::findPath(pack, request, path));
+    EXPECT_EQ(path.size(), 1u);
+}
+
+// Test: A* with a reused workspace matches a plain Dijkstra on a random network
+TEST(AirwaySearchTest, MatchesDijkstra) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> lat(30.0, 48.0), lon(-120.0, -75.0);
+    NavdataPackBuilder builder;
+    const int fixCount = 600;
+    for (int i = 0; i < fixCount; ++i) {
+        builder.putWaypoint(NavdataWaypoint("F" + std::to_string(i), lat(rng), lon(rng), NavaidType::FIX, 0, 0, "TEST"));
+    }
+    std::uniform_int_distribution<int> pick(0, fixCount - 1);
+    for (int a = 0; a < 300; ++a) {
+        Airway airway("R" + std::to_string(a), a % 3 == 0 ? 18000 : 0, 45000, AirwayLevel::HIGH);
+        for (int k = 0; k < 6; ++k) airway.waypointSequence.push_back("F" + std::to_string(pick(rng)));
+        builder.putAirway(airway);
+    }
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(builder.build()));
+
+    auto dijkstra = [&](uint32_t origin, uint32_t destination, int altitude) {
+        std::vector<double> dist(pack.getWaypointCount(), std::numeric_limits<double>::infinity());
+        using Item = std::pair<double, uint32_t>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+        dist[origin] = 0.0;
+        queue.push({0.0, origin});
+        while (!queue.empty()) {
+            auto [d, node] = queue.top();
+            queue.pop();
+            if (d > dist[node]) continue;
+            for (const NavdataPackEdge* e = pack.edgesBegin(node); e != pack.edgesEnd(node); ++e) {
+                const NavdataPackAirway& airway = pack.getAirwayRecord(e->airway);
+                if (altitude < airway.minimumAltitude || altitude > airway.maximumAltitude) continue;
+                if (d + e->distanceNM < dist[e->to]) {
+                    dist[e->to] = d + e->distanceNM;
+                    queue.push({dist[e->to], e->to});
+                }
+            }
+        }
+        return dist[destination];
+    };
+
+    AirwaySearchWorkspace& workspace = AirwaySearchWorkspace::forThisThread();
+    std::vector<AirwayPathStep> path;
+    int compared = 0;
+    for (int q = 0; q < 200; ++q) {
+        AirwaySearchRequest request;
+        request.origin = static_cast<uint32_t>(pick(rng));
+        request.destination = static_cast<uint32_t>(pick(rng));
+        request.cruiseAltitude = q % 2 ? 35000 : 9000;
+        double expected = dijkstra(request.origin, request.destination, request.cruiseAltitude);
+        bool found = AirwaySearch::findPath(pack, request, path, workspace);
+        ASSERT_EQ(found, expected != std::numeric_limits<double>::infinity());
+        if (!found) continue;
+        double total = 0.0;
+        for (const auto& step : path) total += step.distanceNM;
+        EXPECT_NEAR(total, expected, 1e-6);
+        EXPECT_EQ(path.front().node, request.origin);
+        EXPECT_EQ(path.back().node, request.destination);
+        compared++;
+    }
+    EXPECT_GT(compared, 50);
+}
+
+// Test: With a direct radius the search may leave the airways, at the penalty
+TEST(AirwaySearchTest, DirectRadius) {
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(makeImage()));
+    AirwaySearchRequest request;
+    request.origin = pack.findWaypoint("AAAAA");
+    request.destination = pack.findWaypoint("EEEEE");
+    request.cruiseAltitude = 50000;  // no airway is valid
+    request.directRadiusNM = 60.0;
+    request.directPenalty = 1.1;
+    std::vector<AirwayPathStep> path;
+    ASSERT_TRUE(AirwaySearch::findPath(pack, request, path));
+    EXPECT_EQ(names(pack, path), (std::vector<std::string>{"AAAAA", "DDDDD", "CCCCC", "EEEEE"}));
+    for (const auto& step : path) EXPECT_EQ(step.airway, NavdataPack::NO_INDEX);
+
+    request.directRadiusNM = 30.0;  // too short to bridge A and D
+    EXPECT_FALSE(AirwaySearch::findPath(pack, request, path));
+}
+
+// Test: Alternatives are distinct, loopless and start with the optimal route
+TEST(AirwaySearchTest, FindAlternatives) {
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(makeImage()));
+    AirwaySearchRequest request;
+    request.origin = pack.findWaypoint("AAAAA");
+    request.destination = pack.findWaypoint("CCCCC");
+    request.cruiseAltitude = 18000;  // both airways valid
+    std::vector<std::vector<AirwayPathStep>> routes;
+    ASSERT_EQ(AirwaySearch::findAlternatives(pack, request, 3, 0.3, routes), 2u);
+    EXPECT_EQ(names(pack, routes[0]), (std::vector<std::string>{"AAAAA", "DDDDD", "CCCCC"}));
+    EXPECT_EQ(names(pack, routes[1]), (std::vector<std::string>{"AAAAA", "BBBBB", "CCCCC"}));
+
+    // Penalties do not leak into later searches
+    std::vector<AirwayPathStep> path;
+    ASSERT_TRUE(AirwaySearch::findPath(pack, request, path));
+    EXPECT_EQ(names(pack, path), (std::vector<std::string>{"AAAAA", "DDDDD", "CCCCC"}));
+
+    request.cruiseAltitude = 9000;
+    ASSERT_EQ(AirwaySearch::findAlternatives(pack, request, 3, 0.3, routes), 1u);
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> lat(30.0, 48.0), lon(-120.0, -75.0);
+    NavdataPackBuilder builder;
+    for (int i = 0; i < 400; ++i) {
+        builder.putWaypoint(NavdataWaypoint("F" + std::to_string(i), lat(rng), lon(rng), NavaidType::FIX, 0, 0, "TEST"));
+    }
+    std::uniform_int_distribution<int> pick(0, 399);
+    for (int a = 0; a < 250; ++a) {
+        Airway airway("R" + std::to_string(a), 0, 45000, AirwayLevel::HIGH);
+        for (int k = 0; k < 6; ++k) airway.waypointSequence.push_back("F" + std::to_string(pick(rng)));
+        builder.putAirway(airway);
+    }
+    NavdataPack network;
+    ASSERT_TRUE(network.openImage(builder.build()));
+    int multiple = 0;
+    for (int q = 0; q < 50; ++q) {
+        request = AirwaySearchRequest();
+        request.origin = static_cast<uint32_t>(pick(rng));
+        request.destination = static_cast<uint32_t>(pick(rng));
+        request.cruiseAltitude = 35000;
+        if (!AirwaySearch::findPath(network, request, path)) continue;
+        AirwaySearch::findAlternatives(network, request, 4, 0.25, routes);
+        ASSERT_FALSE(routes.empty());
+        EXPECT_EQ(routes[0].size(), path.size());
+        for (size_t r = 0; r < routes.size(); ++r) {
+            std::set<uint32_t> visited;
+            for (const auto& step : routes[r]) EXPECT_TRUE(visited.insert(step.node).second);
+            for (size_t k = 0; k < r; ++k) {
+                std::set<std::pair<uint32_t, uint32_t>> legs;
+                for (size_t i = 1; i < routes[k].size(); ++i) {
+                    legs.insert(std::minmax(routes[k][i - 1].node, routes[k][i].node));
+                }
+                double shared = 0.0, total = 0.0;
+                for (size_t i = 1; i < routes[r].size(); ++i) {
+                    total += routes[r][i].distanceNM;
+                    if (legs.count(std::minmax(routes[r][i - 1].node, routes[r][i].node))) shared += routes[r][i].distanceNM;
+                }
+                EXPECT_LE(shared, 0.75 * total + 1e-6);
+            }
+        }
+        if (routes.size() > 1) multiple++;
+    }
+    EXPECT_GT(multiple, 10);
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "../../include/allocation_tracker.hpp"
+#include "../../include/memory_arena.hpp"
+#include "../../include/metar_parser.hpp"
+#include "../../include/traffic_system.h"
+#include "../../include/traffic_table.hpp"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr int STEADY_TICKS = 100;
+
+// Own ship at the origin with converging targets ahead, abeam and behind
+void makeTraffic(TrafficSystem& traffic, TrafficTable& table) {
+    AircraftState own{};
+    own.groundSpeed = 150.0;
+    own.position.altitude = 5000.0;
+    traffic.updateOwnAircraft(own);
+
+    const char* const CALLSIGNS[] = {"NEAR", "ABEAM", "BEHIND", "FAR"};
+    const double NORTH_NM[] = {2.0, 0.5, -3.0, 30.0};
+    const double EAST_NM[] = {0.0, 1.5, 0.0, 10.0};
+    const double HEADINGS[] = {180.0, 270.0, 0.0, 90.0};
+    for (uint32_t i = 0; i < 4; ++i) {
+        TrafficTable::Sample sample;
+        sample.callsign = CALLSIGNS[i];
+        sample.latitude = NORTH_NM[i] / 60.0;
+        sample.longitude = EAST_NM[i] / 60.0;
+        sample.altitude = 5200.0;
+        sample.groundSpeed = 250.0;
+        sample.heading = HEADINGS[i];
+        table.upsert(i + 1, sample);
+    }
+}
+
+} // namespace
+
+// Test: The hooks are linked into this executable and count this thread's allocations
+TEST(AllocationTrackerTest, CountsThreadAllocations) {
+    ASSERT_TRUE(AllocationTracker::isInstalled());
+
+    AllocationScope scope;
+    auto value = std::make_unique<double>(1.0);
+    std::vector<int> values(100);
+    EXPECT_EQ(scope.allocations(), 2u);
+    EXPECT_GE(scope.bytes(), sizeof(double) + 100 * sizeof(int));
+
+    value.reset();
+    EXPECT_EQ(scope.counts().deallocations, 1u);
+
+    scope.restart();
+    EXPECT_EQ(scope.allocations(), 0u);
+}
+
+// Test: Other threads' allocations reach the process totals but not this scope
+TEST(AllocationTrackerTest, KeepsThreadsApart) {
+    AllocationScope scope;
+    AllocationCounts before = AllocationTracker::process();
+    std::thread([] {
+        AllocationScope worker;
+        std::vector<std::unique_ptr<int>> values;
+        values.reserve(10);
+        for (int i = 0; i < 10; ++i) values.push_back(std::make_unique<int>(i));
+        EXPECT_EQ(worker.allocations(), 11u);
+    }).join();
+    AllocationCounts after = AllocationTracker::process();
+
+    EXPECT_GE(after.allocations - before.allocations, 11u);
+    // std::thread itself allocates its state on this thread
+    EXPECT_LT(scope.allocations(), 11u);
+}
+
+// Test: TrafficSystem::checkTrafficConflicts performs 0 allocations in steady state
+TEST(AllocationTrackerTest, TrafficConflictsDoNotAllocate) {
+    TrafficSystem traffic;
+    TrafficTable table;
+    makeTraffic(traffic, table);
+    FrameArena arena;
+
+    // First ticks size the target buffers, latches and arena
+    for (int tick = 0; tick < 2; ++tick) {
+        traffic.updateTrafficTargets(table);
+        arena.reset();
+        ASSERT_FALSE(traffic.checkTrafficConflicts(&arena).empty());
+    }
+
+    AllocationScope scope;
+    size_t advisories = 0;
+    for (int tick = 0; tick < STEADY_TICKS; ++tick) {
+        arena.reset();
+        advisories += traffic.checkTrafficConflicts(&arena).size();
+    }
+    EXPECT_GT(advisories, 0u);
+    EXPECT_EQ(scope.allocations(), 0u);
+}
+
+// Test: Steady-state traffic table sweeps reuse target and advisory storage
+TEST(AllocationTrackerTest, TrafficUpdatesDoNotAllocate) {
+    TrafficSystem traffic;
+    TrafficTable table;
+    makeTraffic(traffic, table);
+    for (int tick = 0; tick < 3; ++tick) traffic.updateTrafficTargets(table);
+
+    AllocationScope scope;
+    size_t nearby = 0;
+    for (int tick = 0; tick < STEADY_TICKS; ++tick) {
+        traffic.updateTrafficTargets(table);
+        for (const TrafficTarget& target : traffic.trafficInVicinity(5.0)) {
+            nearby += target.callsign.empty() ? 0 : 1;
+        }
+    }
+    EXPECT_GT(nearby, 0u);
+    EXPECT_EQ(scope.allocations(), 0u);
+}
+
+// Test: Parsing into a reused observation makes no allocations
+TEST(AllocationTrackerTest, MetarParseDoesNotAllocate) {
+    const std::string reports[] = {
+        "KJFK 121751Z 31015G25KT 10SM FEW050 SCT250 22/08 A3012 RMK AO2",
+        "EGLL 121750Z 24012KT 9999 -RA BKN012 OVC030 12/10 Q1008 TEMPO 4000 RA",
+        "METAR KDEN 121753Z 00000KT 1/2SM FZFG VV002 M05/M06 A3021",
+    };
+    METARObservation observation;
+    METARParser::parse(reports[0], observation);
+
+    AllocationScope scope;
+    int parsed = 0;
+    for (int i = 0; i < STEADY_TICKS; ++i) {
+        parsed += METARParser::parse(reports[i % 3], observation) ? 1 : 0;
+    }
+    EXPECT_EQ(parsed, STEADY_TICKS);
+    EXPECT_EQ(scope.allocations(), 0u);
+}
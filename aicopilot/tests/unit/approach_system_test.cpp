@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include "../../include/approach_system.h"
+#include "../../include/geodesy.hpp"
+#include <cmath>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr double THRESHOLD_LAT = 47.0;
+constexpr double THRESHOLD_LON = -122.0;
+constexpr double THRESHOLD_ALT = 400.0;
+constexpr double NM_PER_DEGREE = Geodesy::DEG_TO_RAD * Geodesy::EARTH_RADIUS_NM;
+
+// Offset from the threshold, east and north in nautical miles
+Position offset(double eastNM, double northNM, double altitude) {
+    Position pos{};
+    pos.latitude = THRESHOLD_LAT + northNM / NM_PER_DEGREE;
+    pos.longitude = THRESHOLD_LON + eastNM / (NM_PER_DEGREE * std::cos(THRESHOLD_LAT * Geodesy::DEG_TO_RAD));
+    pos.altitude = altitude;
+    return pos;
+}
+
+// Straight-in ILS to a runway heading north
+ApproachProcedure ilsApproach() {
+    ApproachProcedure approach{};
+    approach.type = ApproachType::ILS;
+    approach.name = "ILS 36";
+    approach.ilsData.localizerCourse = 0.0;
+    approach.ilsData.glideslopeAngle = 3.0;
+    approach.ilsData.thresholdPosition = offset(0.0, 0.0, THRESHOLD_ALT);
+    approach.missedApproachPoint = offset(0.0, -0.5, THRESHOLD_ALT);
+    return approach;
+}
+
+RNAVWaypoint waypoint(const std::string& name, const std::string& type, double eastNM, double northNM,
+                      double altitude) {
+    RNAVWaypoint wp{};
+    wp.name = name;
+    wp.type = type;
+    wp.position = offset(eastNM, northNM, altitude);
+    wp.altitude = altitude;
+    wp.speed = 140.0;
+    return wp;
+}
+
+// IAF west of the extended centreline, then IF, FAF and MAP straight in from the south
+ApproachProcedure rnavApproach() {
+    ApproachProcedure approach{};
+    approach.type = ApproachType::RNAV;
+    approach.name = "RNAV 36";
+    approach.waypoints = {waypoint("IAF", "IAF", -5.0, -12.0, 4000.0),
+                          waypoint("IF", "IF", 0.0, -12.0, 3000.0),
+                          waypoint("FAF", "FAF", 0.0, -6.0, 2200.0),
+                          waypoint("MAP", "MAP", 0.0, 0.0, THRESHOLD_ALT)};
+    return approach;
+}
+
+AircraftState stateAt(const Position& pos) {
+    AircraftState state{};
+    state.position = pos;
+    state.heading = 0.0;
+    return state;
+}
+
+} // namespace
+
+// Test: Loading precomputes the glidepath plane and the missed approach point
+TEST(ApproachSystemTest, LoadBuildsGeometry) {
+    ApproachSystem system;
+    ASSERT_TRUE(system.loadApproach(ilsApproach()));
+
+    const ApproachGeometry& geometry = system.getGeometry();
+    EXPECT_NEAR(geometry.glidepathGradient, std::tan(3.0 * Geodesy::DEG_TO_RAD) * 6076.0, 1e-9);
+    EXPECT_DOUBLE_EQ(geometry.thresholdAltitude, THRESHOLD_ALT);
+    EXPECT_TRUE(geometry.hasMissedApproachPoint);
+    EXPECT_NEAR(geometry.missedApproachDistance, 0.5, 1e-6);
+}
+
+// Test: ILS distance is along the final course, deviations come from position
+TEST(ApproachSystemTest, ILSDeviationFromPosition) {
+    ApproachSystem system;
+    system.loadApproach(ilsApproach());
+
+    double gradient = system.getGeometry().glidepathGradient;
+    Position onPath = offset(0.0, -5.0, THRESHOLD_ALT + 5.0 * gradient);
+    EXPECT_NEAR(system.getDistanceToThreshold(onPath), 5.0, 1e-6);
+
+    double localizer = 0.0, glideslope = 0.0;
+    system.calculateILSDeviation(onPath, 20.0, localizer, glideslope);
+    EXPECT_NEAR(localizer, 0.0, 1e-9);
+    EXPECT_NEAR(glideslope, 0.0, 1e-6);
+
+    // 0.1 nm right of course at 5 nm is about 1.15 degrees; 150 ft high is 1.5 dots
+    Position offPath = offset(0.1, -5.0, THRESHOLD_ALT + 5.0 * gradient + 150.0);
+    system.calculateILSDeviation(offPath, 0.0, localizer, glideslope);
+    EXPECT_NEAR(localizer, 0.1 / 5.0 * Geodesy::RAD_TO_DEG, 1e-6);
+    EXPECT_NEAR(glideslope, 1.5, 1e-6);
+}
+
+// Test: Captured and on the glidepath inside 5 nm, the ILS is established and stabilized
+TEST(ApproachSystemTest, ILSStatusEstablished) {
+    ApproachSystem system;
+    system.loadApproach(ilsApproach());
+    system.activateApproach();
+
+    double gradient = system.getGeometry().glidepathGradient;
+    ApproachStatus status = system.updateApproachStatus(stateAt(offset(0.0, -4.0, THRESHOLD_ALT + 4.0 * gradient)));
+    EXPECT_TRUE(status.localizerCaptured);
+    EXPECT_TRUE(status.glideslopeCaptured);
+    EXPECT_NEAR(status.distanceToThreshold, 4.0, 1e-6);
+    EXPECT_NEAR(status.heightAboveThreshold, 4.0 * gradient, 1e-6);
+    EXPECT_EQ(system.getCurrentPhase(), ApproachPhase::FINAL);
+    EXPECT_TRUE(status.stabilized);
+
+    system.updateApproachStatus(stateAt(offset(0.0, -12.0, 5000.0)));
+    EXPECT_EQ(system.getCurrentPhase(), ApproachPhase::INITIAL);
+}
+
+// Test: RNAV guidance gives the leg course, cross-track error and vertical path deviation
+TEST(ApproachSystemTest, RNAVGuidanceOnLeg) {
+    ApproachSystem system;
+    system.loadApproach(rnavApproach());
+    system.activateApproach();
+
+    const ApproachGeometry& geometry = system.getGeometry();
+    ASSERT_EQ(geometry.legs.size(), 4u);
+    EXPECT_NEAR(geometry.legs[1].course, 90.0, 1e-6);
+    EXPECT_NEAR(geometry.legs[2].course, 0.0, 1e-6);
+    EXPECT_NEAR(geometry.legs[0].distanceAfter, 5.0 + 6.0 + 6.0, 1e-6);
+    EXPECT_NEAR(geometry.missedApproachDistance, 0.0, 1e-6);
+
+    // Halfway down the IF-FAF leg, 0.2 nm left and 100 ft above the path
+    system.advanceWaypoint();
+    system.advanceWaypoint();
+    ASSERT_EQ(system.getActiveWaypointIndex(), 2u);
+    Position pos = offset(-0.2, -9.0, 2700.0);
+    ApproachSystem::RNAVGuidance guidance = system.calculateRNAVGuidance(pos);
+    EXPECT_NEAR(guidance.targetHeading, 0.0, 1e-6);
+    EXPECT_NEAR(guidance.crossTrackError, -0.2, 1e-6);
+    EXPECT_NEAR(guidance.verticalDeviation, 100.0, 1e-3);
+    EXPECT_DOUBLE_EQ(guidance.targetAltitude, 2200.0);
+    EXPECT_NEAR(system.getDistanceToThreshold(pos), 9.0, 1e-6);
+    EXPECT_NEAR(system.calculateVerticalPath(pos), 2600.0, 1e-3);
+}
+
+// Test: Status updates sequence waypoints once the aircraft is abeam them
+TEST(ApproachSystemTest, SequencesWaypointsAlongTrack) {
+    ApproachSystem system;
+    system.loadApproach(rnavApproach());
+    system.activateApproach();
+
+    system.updateApproachStatus(stateAt(offset(-7.0, -12.0, 4000.0)));
+    EXPECT_EQ(system.getActiveWaypointIndex(), 0u);
+
+    // Past the IAF and the IF in one tick lands on the final approach leg
+    system.updateApproachStatus(stateAt(offset(0.1, -11.0, 3000.0)));
+    EXPECT_EQ(system.getActiveWaypointIndex(), 2u);
+    EXPECT_EQ(system.getNextWaypoint().name, "FAF");
+
+    system.updateApproachStatus(stateAt(offset(0.0, -3.0, 1300.0)));
+    EXPECT_EQ(system.getActiveWaypointIndex(), 3u);
+    EXPECT_EQ(system.getCurrentPhase(), ApproachPhase::FINAL);
+}
+
+// Test: Passing the missed approach point unstabilized calls for the missed approach
+TEST(ApproachSystemTest, MissedApproachPastMAP) {
+    ApproachSystem system;
+    ApproachProcedure approach = ilsApproach();
+    approach.missedApproachPoint = offset(0.0, -2.0, THRESHOLD_ALT);
+    system.loadApproach(approach);
+    system.activateApproach();
+
+    // Well off the localizer and high: not established
+    AircraftState state = stateAt(offset(1.0, -1.9, THRESHOLD_ALT + 1200.0));
+    system.updateApproachStatus(state);
+    EXPECT_EQ(system.getCurrentPhase(), ApproachPhase::FINAL);
+    EXPECT_TRUE(system.shouldExecuteMissedApproach(state));
+
+    state = stateAt(offset(1.0, -2.5, THRESHOLD_ALT + 1200.0));
+    system.updateApproachStatus(state);
+    EXPECT_FALSE(system.shouldExecuteMissedApproach(state));
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "../../include/atc_decision_cache.hpp"
+
+using namespace AICopilot;
+
+// Test: Normalization ignores case, punctuation, spacing and the numbers themselves
+TEST(ATCDecisionCacheTest, NormalizesSituations) {
+    EXPECT_EQ(ATCDecisionCache::normalize("Taxi to Runway 04,  via  A!"), "taxi to runway # via a");
+    EXPECT_EQ(ATCDecisionCache::normalize("Climb FL250"), "climb fl#");
+
+    ATCDecisionCache cache;
+    cache.store("TAXI OUT", "Taxi to runway 04", {"Roger", "Request taxi to runway 04"}, 1);
+    EXPECT_EQ(cache.lookup("TAXI OUT", "taxi to runway 22.", {"roger", "Request taxi to runway 22"}), 1);
+    EXPECT_FALSE(cache.lookup("TAXI IN", "Taxi to runway 04", {"Roger", "Request taxi to runway 04"}));
+    EXPECT_FALSE(cache.lookup("TAXI OUT", "Taxi to runway 04", {"Request taxi to runway 04", "Roger"}));
+
+    ATCDecisionCacheStats stats = cache.getStats();
+    EXPECT_EQ(stats.exactHits, 1u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_NEAR(stats.hitRate(), 1.0 / 3.0, 1e-9);
+}
+
+// Test: The similarity tier matches reworded menus of the same shape only above its threshold
+TEST(ATCDecisionCacheTest, SimilarityTier) {
+    ATCDecisionCache cache;
+    std::vector<std::string> options = {"Ready for departure", "Request IFR clearance", "Unable"};
+    cache.store("PREFLIGHT", "Ground, say intentions", options, 1);
+
+    std::vector<std::string> reworded = {"Ready for departure", "Request IFR clearance please", "Unable"};
+    EXPECT_FALSE(cache.lookup("PREFLIGHT", "Ground, say intentions", reworded));
+
+    cache.setSimilarityThreshold(0.8);
+    EXPECT_EQ(cache.lookup("PREFLIGHT", "Ground, say intentions", reworded), 1);
+    EXPECT_FALSE(cache.lookup("PREFLIGHT", "Ground, say intentions", {"Ready for departure", "Unable"}));
+    EXPECT_FALSE(cache.lookup("PREFLIGHT", "Ground, say intentions",
+                              {"Request pushback", "Contact tower", "Say again"}));
+    EXPECT_EQ(cache.getStats().similarHits, 1u);
+}
+
+// Test: The least recently used situation is evicted at capacity
+TEST(ATCDecisionCacheTest, EvictsLeastRecentlyUsed) {
+    ATCDecisionCache cache(2);
+    cache.store("CLIMB", "a", {"x", "y"}, 0);
+    cache.store("CLIMB", "b", {"x", "y"}, 1);
+    EXPECT_TRUE(cache.lookup("CLIMB", "a", {"x", "y"}));
+    cache.store("CLIMB", "c", {"x", "y"}, 0);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_FALSE(cache.lookup("CLIMB", "b", {"x", "y"}));
+    EXPECT_TRUE(cache.lookup("CLIMB", "a", {"x", "y"}));
+
+    // Out-of-range choices are not cached
+    cache.store("CLIMB", "d", {"x"}, 3);
+    EXPECT_FALSE(cache.lookup("CLIMB", "d", {"x"}));
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "../../include/atc_phraseology.hpp"
+
+using namespace AICopilot;
+
+// Test: Altitude, heading and speed come out of one clearance
+TEST(ATCPhraseologyTest, ParsesAltitudeHeadingSpeed) {
+    auto parsed = parseClearance("Climb and maintain flight level 180, heading 250, speed 250");
+    ASSERT_TRUE(parsed.target_altitude_feet.has_value());
+    EXPECT_NEAR(*parsed.target_altitude_feet, 18000.0, 1e-6);
+    ASSERT_TRUE(parsed.target_heading_degrees.has_value());
+    EXPECT_NEAR(*parsed.target_heading_degrees, 250.0, 1e-6);
+    ASSERT_TRUE(parsed.target_speed_knots.has_value());
+    EXPECT_NEAR(*parsed.target_speed_knots, 250.0, 1e-6);
+    EXPECT_FALSE(parsed.frequency_mhz.has_value());
+    EXPECT_FALSE(parsed.squawk_code.has_value());
+}
+
+// Test: Spoken numbers, ICAO digit names and thousand/hundred groups are folded
+TEST(ATCPhraseologyTest, ParsesSpokenNumbers) {
+    auto parsed = parseClearance("descend and maintain five thousand five hundred, "
+                                 "turn left heading two niner zero");
+    EXPECT_NEAR(parsed.target_altitude_feet.value_or(0), 5500.0, 1e-6);
+    EXPECT_NEAR(parsed.target_heading_degrees.value_or(0), 290.0, 1e-6);
+
+    auto level = parseClearance("CLIMB FL tree five zero");
+    EXPECT_NEAR(level.target_altitude_feet.value_or(0), 35000.0, 1e-6);
+
+    auto north = parseClearance("fly heading 000");
+    EXPECT_NEAR(north.target_heading_degrees.value_or(0), 360.0, 1e-6);
+}
+
+// Test: Frequencies in written and spoken form, and squawk codes
+TEST(ATCPhraseologyTest, ParsesFrequencyAndSquawk) {
+    auto written = parseClearance("Contact Boston Departure on 124.35");
+    EXPECT_NEAR(written.frequency_mhz.value_or(0), 124.35, 1e-6);
+
+    auto spoken = parseClearance("monitor tower one one eight decimal tree, squawk seven fife zero zero");
+    EXPECT_NEAR(spoken.frequency_mhz.value_or(0), 118.3, 1e-6);
+    EXPECT_EQ(spoken.squawk_code.value_or(0), 7500);
+
+    auto invalid = parseClearance("squawk 7800");
+    EXPECT_FALSE(invalid.squawk_code.has_value());
+}
+
+// Test: A number followed by knots is a speed even after "maintain"
+TEST(ATCPhraseologyTest, MaintainKnotsIsSpeed) {
+    auto parsed = parseClearance("Reduce speed to 210 knots, then maintain 180 kts, descend to 3000 feet");
+    EXPECT_NEAR(parsed.target_speed_knots.value_or(0), 210.0, 1e-6);
+    EXPECT_NEAR(parsed.target_altitude_feet.value_or(0), 3000.0, 1e-6);
+
+    auto maintain = parseClearance("maintain 250 knots");
+    EXPECT_NEAR(maintain.target_speed_knots.value_or(0), 250.0, 1e-6);
+    EXPECT_FALSE(maintain.target_altitude_feet.has_value());
+}
+
+// Test: Runway numbers, callsigns and keyword-only text assign nothing
+TEST(ATCPhraseologyTest, IgnoresUnassignedNumbers) {
+    auto parsed = parseClearance("N123AB cleared to land runway 27, maintain visual separation");
+    EXPECT_FALSE(parsed.target_altitude_feet.has_value());
+    EXPECT_FALSE(parsed.target_heading_degrees.has_value());
+    EXPECT_FALSE(parsed.target_speed_knots.has_value());
+    EXPECT_FALSE(parsed.frequency_mhz.has_value());
+    EXPECT_FALSE(parsed.squawk_code.has_value());
+
+    auto empty = parseClearance("");
+    EXPECT_FALSE(empty.target_altitude_feet.has_value());
+}
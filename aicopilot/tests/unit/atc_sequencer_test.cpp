@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include "../../include/atc_routing.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace AICopilot::ATC;
+
+namespace {
+
+double slotOf(const ATCSequencer& sequencer, int aircraft) {
+    const SequencedAircraft* info = sequencer.get_sequence_info(aircraft);
+    return info ? info->estimated_execution_time : -1.0;
+}
+
+// Slots recomputed from scratch: ETA order, each the later of its ETA and the one ahead plus separation
+void expectSlotsFromScratch(const ATCSequencer& sequencer, int runway, double lastLanding, double separation) {
+    std::vector<int> order = sequencer.get_arrival_sequence(runway);
+    double previous = lastLanding;
+    for (size_t i = 0; i < order.size(); ++i) {
+        const SequencedAircraft* info = sequencer.get_sequence_info(order[i]);
+        ASSERT_NE(info, nullptr);
+        if (i > 0) {
+            EXPECT_LE(sequencer.get_sequence_info(order[i - 1])->estimated_ready_time, info->estimated_ready_time);
+        }
+        double expected = std::max(info->estimated_ready_time, previous + separation);
+        EXPECT_DOUBLE_EQ(info->estimated_execution_time, expected) << "aircraft " << order[i];
+        previous = expected;
+    }
+}
+
+} // namespace
+
+// Test: Arrivals are slotted in ETA order at least one separation apart
+TEST(ATCSequencerTest, ArrivalSlotsFollowEta) {
+    ATCSequencer sequencer;
+    sequencer.register_runway(1);
+    sequencer.set_minimum_separation(1, 60.0);
+
+    EXPECT_FALSE(sequencer.request_arrival_slot(1, 9, 100.0, 0.0));
+    ASSERT_TRUE(sequencer.request_arrival_slot(1, 1, 300.0, 0.0));
+    ASSERT_TRUE(sequencer.request_arrival_slot(2, 1, 320.0, 0.0));
+    ASSERT_TRUE(sequencer.request_arrival_slot(3, 1, 600.0, 0.0));
+    EXPECT_DOUBLE_EQ(slotOf(sequencer, 1), 300.0);
+    EXPECT_DOUBLE_EQ(slotOf(sequencer, 2), 360.0);
+    EXPECT_DOUBLE_EQ(slotOf(sequencer, 3), 600.0);
+
+    // An earlier ETA goes ahead and pushes the slots behind it
+    ASSERT_TRUE(sequencer.request_arrival_slot(4, 1, 280.0, 0.0));
+    EXPECT_EQ(sequencer.get_arrival_sequence(1), (std::vector<int>{4, 1, 2, 3}));
+    EXPECT_DOUBLE_EQ(slotOf(sequencer, 1), 340.0);
+    EXPECT_DOUBLE_EQ(slotOf(sequencer, 2), 400.0);
+    EXPECT_DOUBLE_EQ(slotOf(sequencer, 3), 600.0);
+
+    // A later ETA moves back and the gap closes
+    ASSERT_TRUE(sequencer.update_arrival_eta(4, 900.0));
+    EXPECT_EQ(sequencer.get_arrival_sequence(1), (std::vector<int>{1, 2, 3, 4}));
+    EXPECT_DOUBLE_EQ(slotOf(sequencer, 1), 300.0);
+    EXPECT_DOUBLE_EQ(slotOf(sequencer, 2), 360.0);
+    EXPECT_DOUBLE_EQ(slotOf(sequencer, 4), 900.0);
+
+    EXPECT_TRUE(sequencer.cancel_arrival(1));
+    EXPECT_FALSE(sequencer.update_arrival_eta(1, 10.0));
+    EXPECT_DOUBLE_EQ(slotOf(sequencer, 2), 320.0);
+    EXPECT_EQ(sequencer.get_arrival_queue_length(1), 3u);
+
+    // Wider separation re-slots everything
+    sequencer.set_minimum_separation(1, 300.0);
+    expectSlotsFromScratch(sequencer, 1, 0.0, 300.0);
+}
+
+// Test: Incremental ETA changes give the same slots as slotting from scratch
+TEST(ATCSequencerTest, IncrementalMatchesFromScratch) {
+    ATCSequencer sequencer;
+    sequencer.register_runway(1);
+    sequencer.set_minimum_separation(1, 90.0);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> eta(0.0, 7200.0);
+    for (int aircraft = 0; aircraft < 150; ++aircraft) {
+        ASSERT_TRUE(sequencer.request_arrival_slot(aircraft, 1, eta(rng), 0.0));
+    }
+    expectSlotsFromScratch(sequencer, 1, 0.0, 90.0);
+
+    std::uniform_int_distribution<int> pick(0, 149);
+    for (int step = 0; step < 500; ++step) {
+        int aircraft = pick(rng);
+        if (step % 50 == 49) {
+            sequencer.cancel_arrival(aircraft);
+        } else if (!sequencer.update_arrival_eta(aircraft, eta(rng))) {
+            sequencer.request_arrival_slot(aircraft, 1, eta(rng), 0.0);
+        }
+    }
+    expectSlotsFromScratch(sequencer, 1, 0.0, 90.0);
+}
+
+// Test: An arrival is cleared once its slot is due and the rest re-slot from that landing
+TEST(ATCSequencerTest, ArrivalClearanceWhenSlotDue) {
+    ATCSequencer sequencer;
+    sequencer.register_runway(1);
+    sequencer.set_minimum_separation(1, 60.0);
+    sequencer.request_arrival_slot(10, 1, 100.0, 0.0);
+    sequencer.request_arrival_slot(11, 1, 110.0, 0.0);
+
+    EXPECT_EQ(sequencer.get_next_arrival_clearance(1, 99.0), -1);
+    EXPECT_EQ(sequencer.get_next_arrival_clearance(1, 130.0), 10);
+    EXPECT_EQ(sequencer.get_arrival_queue_length(1), 1u);
+    EXPECT_DOUBLE_EQ(slotOf(sequencer, 11), 190.0);
+    EXPECT_EQ(sequencer.get_next_arrival_clearance(1, 180.0), -1);
+    EXPECT_EQ(sequencer.get_next_arrival_clearance(1, 190.0), 11);
+    EXPECT_EQ(sequencer.get_next_arrival_clearance(1, 500.0), -1);
+
+    // Departures keep their request order and separation
+    sequencer.request_departure_slot(20, 1, 0.0);
+    sequencer.request_departure_slot(21, 1, 0.0);
+    EXPECT_EQ(sequencer.get_queue_length(1), 2u);
+    EXPECT_EQ(sequencer.get_next_departure_clearance(1, 100.0), 20);
+    EXPECT_EQ(sequencer.get_next_departure_clearance(1, 120.0), -1);
+    EXPECT_EQ(sequencer.get_next_departure_clearance(1, 160.0), 21);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "../../include/atc_text_ring.hpp"
+#include <string>
+
+using namespace AICopilot;
+
+namespace {
+
+const ATCTextView& publishString(ATCTextRing& ring, ATCMessageType type, const std::string& text) {
+    return ring.publish(type, text.data(), text.size());
+}
+
+} // namespace
+
+// Test: The first string is the message and the rest are menu options
+TEST(ATCTextRingTest, SplitsMessageAndOptions) {
+    ATCTextRing ring;
+    std::string text("Cleared to land runway 34L\0Readback\0Say again\0", 47);
+    const ATCTextView& view = publishString(ring, ATCMessageType::LANDING, text);
+
+    EXPECT_EQ(view.type, ATCMessageType::LANDING);
+    EXPECT_EQ(view.message, "Cleared to land runway 34L");
+    ASSERT_EQ(view.optionCount, 2u);
+    EXPECT_EQ(view.options[0], "Readback");
+    EXPECT_EQ(view.options[1], "Say again");
+    EXPECT_FALSE(view.truncated);
+}
+
+// Test: Options past MAX_OPTIONS are dropped and flagged
+TEST(ATCTextRingTest, TruncatesExtraOptions) {
+    ATCTextRing ring;
+    std::string text("Menu");
+    for (int i = 0; i < 12; ++i) {
+        text.push_back('\0');
+        text += "Option " + std::to_string(i);
+    }
+    const ATCTextView& view = publishString(ring, ATCMessageType::OTHER, text);
+
+    EXPECT_EQ(view.optionCount, ATCTextView::MAX_OPTIONS);
+    EXPECT_EQ(view.options[9], "Option 9");
+    EXPECT_TRUE(view.truncated);
+}
+
+// Test: Slots are reused round-robin and latest() tracks the newest
+TEST(ATCTextRingTest, ReusesSlots) {
+    ATCTextRing ring;
+    EXPECT_EQ(ring.latest(), nullptr);
+
+    const ATCTextView* first = &publishString(ring, ATCMessageType::OTHER, "first");
+    for (size_t i = 1; i < ATCTextRing::SLOT_COUNT; ++i) {
+        publishString(ring, ATCMessageType::OTHER, "filler");
+    }
+    const ATCTextView* wrapped = &publishString(ring, ATCMessageType::TAXI, "taxi via A");
+
+    EXPECT_EQ(wrapped, first);
+    EXPECT_EQ(ring.latest(), wrapped);
+    EXPECT_EQ(ring.latest()->message, "taxi via A");
+    EXPECT_EQ(ring.publishedCount(), ATCTextRing::SLOT_COUNT + 1);
+}
+
+// Test: Empty and oversized payloads are handled without overrun
+TEST(ATCTextRingTest, EmptyAndOversizedText) {
+    ATCTextRing ring;
+    const ATCTextView& empty = ring.publish(ATCMessageType::OTHER, nullptr, 0);
+    EXPECT_TRUE(empty.message.empty());
+    EXPECT_EQ(empty.optionCount, 0u);
+
+    std::string big(ATCTextRing::SLOT_CAPACITY + 100, 'x');
+    const ATCTextView& view = publishString(ring, ATCMessageType::OTHER, big);
+    EXPECT_EQ(view.message.size(), ATCTextRing::SLOT_CAPACITY);
+    EXPECT_TRUE(view.truncated);
+}
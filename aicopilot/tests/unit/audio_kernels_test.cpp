@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "../../include/audio_kernels.hpp"
+#include "../../include/voice_input.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+std::vector<int16_t> makeSamples(unsigned seed, size_t count) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> sample(-32768, 32767);
+    std::vector<int16_t> samples(count);
+    for (auto& s : samples) s = static_cast<int16_t>(sample(rng));
+    return samples;
+}
+
+} // namespace
+
+// Test: Reductions match scalar references, including full-scale frames
+TEST(AudioKernelsTest, ReductionsMatchReference) {
+    std::vector<int16_t> samples = makeSamples(1, 1000);
+    samples[17] = -32768;
+
+    double sum = 0.0;
+    int peak = 0;
+    for (int16_t s : samples) {
+        sum += double(s) * s;
+        peak = std::max(peak, std::abs(int(s)));
+    }
+    EXPECT_EQ(AudioKernels::sumOfSquares(samples.data(), samples.size()), static_cast<int64_t>(sum));
+    EXPECT_DOUBLE_EQ(AudioKernels::rmsEnergy(samples.data(), samples.size()), std::sqrt(sum / samples.size()));
+    EXPECT_EQ(AudioKernels::peakMagnitude(samples.data(), samples.size()), 32768);
+    EXPECT_EQ(peak, 32768);
+    EXPECT_EQ(AudioKernels::rmsEnergy(samples.data(), 0), 0.0);
+}
+
+// Test: Pre-emphasis in place over split frames equals one pass over the whole signal
+TEST(AudioKernelsTest, PreEmphasisCarriesStateAcrossFrames) {
+    std::vector<int16_t> signal = makeSamples(2, 1024);
+    std::vector<int16_t> expected(signal.size());
+    for (size_t i = 0; i < signal.size(); ++i) {
+        float previous = i > 0 ? signal[i - 1] : 0.0f;
+        expected[i] = AudioKernels::saturate(signal[i] - 0.97f * previous);
+    }
+
+    std::vector<int16_t> framed = signal;
+    int16_t state = 0;
+    for (size_t start = 0; start < framed.size(); start += 300) {
+        size_t count = std::min<size_t>(300, framed.size() - start);
+        state = AudioKernels::preEmphasis(framed.data() + start, count, 0.97f, state);
+    }
+    EXPECT_EQ(framed, expected);
+    EXPECT_EQ(state, signal.back());
+}
+
+// Test: The gate zeroes quiet samples only and gain saturates
+TEST(AudioKernelsTest, GateAndGain) {
+    std::vector<int16_t> samples = {0, 5, -5, 9, -10, 10, 300, -32768};
+    AudioKernels::noiseGate(samples.data(), samples.size(), 10);
+    EXPECT_EQ(samples, (std::vector<int16_t>{0, 0, 0, 0, -10, 10, 300, -32768}));
+
+    AudioKernels::applyGain(samples.data(), samples.size(), 200.0f);
+    EXPECT_EQ(samples, (std::vector<int16_t>{0, 0, 0, 0, -2000, 2000, 32767, -32768}));
+}
+
+// Test: The detector gives the same answer for vector and pointer frames and adapts its floor
+TEST(AudioKernelsTest, DetectorAdaptsNoiseFloor) {
+    VoiceActivityDetector vector_vad;
+    VoiceActivityDetector pointer_vad;
+    vector_vad.initialize(0.6f);
+    pointer_vad.initialize(0.6f);
+
+    std::vector<int16_t> quiet(512, 20);
+    std::vector<int16_t> loud(512, 3000);
+    for (int frame = 0; frame < 60; ++frame) {
+        const std::vector<int16_t>& samples = frame % 5 == 0 ? loud : quiet;
+        auto a = vector_vad.processFrame(samples);
+        auto b = pointer_vad.processFrame(samples.data(), samples.size());
+        EXPECT_EQ(a.first, b.first);
+        EXPECT_EQ(a.second, b.second);
+    }
+    EXPECT_DOUBLE_EQ(pointer_vad.getNoiseFloor(), 20.0);
+    EXPECT_EQ(pointer_vad.processFrame(loud).first, VADLevel::STRONG_VOICE);
+    EXPECT_EQ(pointer_vad.processFrame(quiet).first, VADLevel::NO_VOICE);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "../../include/binary_log.hpp"
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+std::string logPath(const char* name) {
+    return std::string("binary_log_test_") + name + ".bin";
+}
+
+std::vector<LogLine> readAll(const std::string& path) {
+    std::vector<LogLine> lines;
+    BinaryLogReader reader;
+    EXPECT_TRUE(reader.open(path));
+    LogLine line;
+    while (reader.next(line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+} // namespace
+
+// Test: Placeholders are counted at compile time, escapes excluded
+TEST(BinaryLogTest, CountsPlaceholders) {
+    static_assert(countLogPlaceholders("none") == 0, "no placeholders");
+    static_assert(countLogPlaceholders("{} and {:x}") == 2, "plain and hex");
+    static_assert(countLogPlaceholders("{{literal}} {}") == 1, "escaped braces");
+    SUCCEED();
+}
+
+// Test: Every argument type round-trips through the payload encoding
+TEST(BinaryLogTest, FormatsPayload) {
+    LogPayload payload;
+    payload.add(-42);
+    payload.add(255u);
+    payload.add(2.5);
+    payload.add(true);
+    payload.add("text");
+    payload.add(std::string("more"));
+    payload.add(static_cast<int32_t>(0x80004005u));   // E_FAIL-style HRESULT
+    EXPECT_EQ(formatLogPayload("{} {:x} {} {} {} {} {{}} 0x{:x}", payload.data(), payload.size()),
+              "-42 ff 2.5 true text more {} 0x80004005");
+
+    LogPayload huge;
+    huge.add(std::string(5000, 'a'));
+    EXPECT_LE(huge.size(), LogPayload::MAX_PAYLOAD_BYTES);
+}
+
+// Test: Records from several threads reach the file with their sites and levels
+TEST(BinaryLogTest, WritesAndDecodesFile) {
+    std::string path = logPath("threads");
+    ASSERT_TRUE(BinaryLogger::start(path));
+    EXPECT_FALSE(BinaryLogger::start(path));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < 100; ++i) {
+                AICOPILOT_LOG_INFO("thread {} record {}", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    AICOPILOT_LOG_ERROR("failed: 0x{:x}", 0xBEEFu);
+    AICOPILOT_LOG_DEBUG("compiled out at the default level {}", 1);
+    BinaryLogger::stop();
+
+    std::vector<LogLine> lines = readAll(path);
+    size_t expected = 401 + (AICOPILOT_LOG_MIN_LEVEL == 0 ? 1 : 0);
+    EXPECT_EQ(lines.size() + BinaryLogger::droppedRecords(), expected);
+    ASSERT_FALSE(lines.empty());
+
+    bool sawError = false;
+    for (const LogLine& line : lines) {
+        if (line.level == LogLevel::ERROR) {
+            sawError = true;
+            EXPECT_EQ(line.message, "failed: 0xbeef");
+            EXPECT_NE(line.file.find("binary_log_test.cpp"), std::string::npos);
+            EXPECT_NE(formatLogLine(line).find("[ERROR]"), std::string::npos);
+        } else if (line.level == LogLevel::INFO) {
+            EXPECT_EQ(line.message.compare(0, 7, "thread "), 0);
+        }
+    }
+    EXPECT_TRUE(sawError);
+    std::remove(path.c_str());
+}
+
+// Test: flush() makes records readable while the logger keeps running
+TEST(BinaryLogTest, FlushWhileRunning) {
+    std::string path = logPath("flush");
+    ASSERT_TRUE(BinaryLogger::start(path));
+    AICOPILOT_LOG_WARNING("altitude {} ft", 3500);
+    BinaryLogger::flush();
+
+    std::vector<LogLine> lines = readAll(path);
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0].level, LogLevel::WARNING);
+    EXPECT_EQ(lines[0].message, "altitude 3500 ft");
+
+    BinaryLogger::stop();
+    EXPECT_FALSE(BinaryLogger::isRunning());
+    std::remove(path.c_str());
+}
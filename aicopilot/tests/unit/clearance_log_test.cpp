@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "../../include/clearance_log.hpp"
+#include <cstdio>
+#include <filesystem>
+
+using namespace AICopilot;
+
+// Test: Events apply incrementally; onward clearances release a hold
+TEST(ClearanceLogTest, AppliesEventsIncrementally) {
+    ClearanceLog log;
+    log.append(ClearanceEventType::ALTITUDE, 5000, 10);
+    log.append(ClearanceEventType::HEADING, 270, 20);
+    log.append(ClearanceEventType::HOLD, 0, 30);
+    EXPECT_TRUE(log.current().holding());
+
+    log.append(ClearanceEventType::CLEARED_APPROACH, 0, 40);
+    log.append(ClearanceEventType::ALTITUDE, 3000, 50);
+
+    const ClearanceSnapshot& state = log.current();
+    EXPECT_EQ(state.eventCount, 5u);
+    EXPECT_EQ(state.timeMs, 50u);
+    EXPECT_EQ(state.altitudeFeet, 3000);
+    EXPECT_EQ(state.headingDegrees, 270);
+    EXPECT_TRUE(state.clearedForApproach());
+    EXPECT_FALSE(state.holding());
+    EXPECT_FALSE(state.has(ClearanceEventType::SQUAWK));
+    EXPECT_EQ(log.events()[4].sequence, 4u);
+}
+
+// Test: The state at any earlier point matches a full replay from the start
+TEST(ClearanceLogTest, StateAtMatchesReplay) {
+    ClearanceLog log(4);
+    for (int i = 0; i < 19; ++i) {
+        log.append(i % 2 ? ClearanceEventType::HEADING : ClearanceEventType::ALTITUDE, 1000 + i, i);
+    }
+
+    for (uint32_t n = 0; n <= log.size(); ++n) {
+        ClearanceSnapshot expected;
+        for (uint32_t i = 0; i < n; ++i) expected.apply(log.events()[i]);
+        ClearanceSnapshot rebuilt = log.stateAt(n);
+        EXPECT_EQ(rebuilt.eventCount, n);
+        EXPECT_EQ(rebuilt.altitudeFeet, expected.altitudeFeet);
+        EXPECT_EQ(rebuilt.headingDegrees, expected.headingDegrees);
+    }
+
+    ClearanceSnapshot tail = ClearanceLog::replay(log.stateAt(10), log.events());
+    EXPECT_EQ(tail.eventCount, log.current().eventCount);
+    EXPECT_EQ(tail.altitudeFeet, log.current().altitudeFeet);
+}
+
+// Test: Compacting keeps the current state and later history
+TEST(ClearanceLogTest, CompactFoldsIntoBase) {
+    ClearanceLog log(4);
+    for (int i = 0; i < 10; ++i) {
+        log.append(ClearanceEventType::SPEED, 200 + i, i);
+    }
+    ClearanceSnapshot atEight = log.stateAt(8);
+
+    log.compact(3);
+    EXPECT_EQ(log.events().size(), 3u);
+    EXPECT_EQ(log.base().eventCount, 7u);
+    EXPECT_EQ(log.current().speedKnots, 209);
+    EXPECT_EQ(log.stateAt(8).speedKnots, atEight.speedKnots);
+    EXPECT_EQ(log.stateAt(2).eventCount, 7u);   // clamped to the base
+
+    log.append(ClearanceEventType::SPEED, 180, 11);
+    EXPECT_EQ(log.current().eventCount, 11u);
+    EXPECT_EQ(log.current().speedKnots, 180);
+}
+
+// Test: A saved log loads back with the same state and events
+TEST(ClearanceLogTest, SaveAndLoadRoundTrip) {
+    ClearanceLog log;
+    log.append(ClearanceEventType::SQUAWK, 4721, 5);
+    log.append(ClearanceEventType::FREQUENCY, 124350, 6);
+    log.compact(1);
+    log.append(ClearanceEventType::CLEARED_TAKEOFF, 0, 7);
+
+    auto path = (std::filesystem::temp_directory_path() / "aicopilot_clearance_log.acl").string();
+    ASSERT_TRUE(log.save(path));
+
+    ClearanceLog loaded;
+    ASSERT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded.base().eventCount, 1u);
+    EXPECT_EQ(loaded.events().size(), 2u);
+    EXPECT_EQ(loaded.current().squawk, 4721);
+    EXPECT_EQ(loaded.current().frequencyKHz, 124350);
+    EXPECT_TRUE(loaded.current().clearedForTakeoff());
+
+    ClearanceLog missing;
+    EXPECT_FALSE(missing.load(path + ".missing"));
+    std::remove(path.c_str());
+}
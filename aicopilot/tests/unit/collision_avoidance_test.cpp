@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "../../include/collision_avoidance.hpp"
+#include "../../include/airport_collision_index.hpp"
 #include <cmath>
 
 using namespace AICopilot::Collision;
@@ -258,6 +259,300 @@ TEST_F(CollisionDetectionTest, AircraftRemovalFromPredictor) {
     EXPECT_EQ(predictor.get_tracked_aircraft_count(), 1);
 }
 
+// Test: Broad phase keeps every conflicting pair of a busy terminal area and prunes the rest
+TEST_F(CollisionDetectionTest, ConflictPredictorBroadPhaseMatchesAllPairs) {
+    ConflictPredictor predictor(30.0);
+    SeparationStandards standards;
+    std::vector<SeparationStandards::AircraftState> states;
+    
+    // 300 targets in a 40 nm square, some clustered so conflicts exist
+    unsigned seed = 7;
+    auto next = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<double>((seed >> 8) & 0xFFFF) / 65535.0;
+    };
+    for (int i = 0; i < 300; ++i) {
+        double span = i < 60 ? 6000.0 : 240000.0;
+        double heading = next() * 360.0;
+        double speed = 100.0 + next() * 250.0;
+        double rad = heading * 3.14159265358979323846 / 180.0;
+        states.push_back(createAircraftState(
+            i, (next() - 0.5) * span, (next() - 0.5) * span, 3000.0 + next() * 8000.0,
+            speed * std::sin(rad), speed * std::cos(rad), heading, speed * 0.592484));
+        predictor.update_aircraft_state(states.back());
+    }
+    
+    size_t expected = 0;
+    for (size_t i = 0; i < states.size(); ++i) {
+        for (size_t j = i + 1; j < states.size(); ++j) {
+            double t;
+            if (standards.predict_collision(states[i], states[j], 30.0, t)) ++expected;
+        }
+    }
+    
+    auto alerts = predictor.predict_conflicts();
+    EXPECT_GT(expected, 0u);
+    EXPECT_EQ(alerts.size(), expected);
+    for (size_t k = 1; k < alerts.size(); ++k) {
+        EXPECT_LE(alerts[k - 1].time_to_conflict_seconds, alerts[k].time_to_conflict_seconds);
+    }
+    
+    auto pairs = predictor.find_candidate_pairs(standards.get_lateral_separation_minimum());
+    EXPECT_LT(pairs.size(), states.size() * (states.size() - 1) / 20);
+}
+
+// Test: Incremental prediction reuses steady pairs and holds conflicts with hysteresis
+TEST_F(CollisionDetectionTest, ConflictPredictorIncrementalHysteresis) {
+    ConflictPredictor predictor(30.0);
+    
+    // Converging pair missing by 400 ft, and a steady parallel pair well clear
+    auto ac1 = createAircraftState(1, 0.0, 0.0, 5000.0, 200.0, 0.0, 90.0, 118.0);
+    auto ac2 = createAircraftState(2, 4000.0, 400.0, 5000.0, -200.0, 0.0, 270.0, 118.0);
+    auto ac3 = createAircraftState(3, 0.0, 20000.0, 5000.0, 150.0, 0.0, 90.0, 89.0);
+    auto ac4 = createAircraftState(4, 0.0, 20400.0, 5000.0, 150.0, 0.0, 90.0, 89.0);
+    for (const auto& ac : {ac1, ac2, ac3, ac4}) predictor.update_aircraft_state(ac);
+    
+    const auto& first = predictor.update_conflicts(0.0);
+    auto stateless = predictor.predict_conflicts();
+    ASSERT_EQ(first.size(), stateless.size());
+    ASSERT_EQ(first.size(), 2u);
+    size_t evaluated = predictor.get_last_evaluated_pair_count();
+    EXPECT_GT(evaluated, 0u);
+    
+    // One second later, all four still on their lines: only the parallel
+    // pair (no relative motion, so no CPA ahead) is recomputed
+    for (auto* ac : {&ac1, &ac2, &ac3, &ac4}) {
+        ac->position_local = ac->position_local + ac->velocity * 1.0;
+        predictor.update_aircraft_state(*ac);
+    }
+    const auto& second = predictor.update_conflicts(1.0);
+    ASSERT_EQ(second.size(), 2u);
+    EXPECT_LT(predictor.get_last_evaluated_pair_count(), evaluated);
+    for (const auto& alert : second) {
+        if (alert.aircraft1_id == 1) {
+            EXPECT_NEAR(alert.time_to_conflict_seconds, 9.0, 1e-6);
+            EXPECT_NEAR(alert.minimum_separation_at_conflict_feet, 400.0, 1e-6);
+        }
+    }
+    
+    // ac2 drifts so the miss distance grows to 550 ft: past the 500 ft entry
+    // limit but inside the 600 ft exit limit, so the alert holds
+    ac1.position_local = ac1.position_local + ac1.velocity * 1.0;
+    ac2.position_local = ac2.position_local + ac2.velocity * 1.0 + Vector2D(0.0, 150.0);
+    predictor.update_aircraft_state(ac1);
+    predictor.update_aircraft_state(ac2);
+    const auto& held = predictor.update_conflicts(1.0);
+    bool pair_held = false;
+    for (const auto& alert : held) pair_held |= (alert.aircraft1_id == 1 && alert.aircraft2_id == 2);
+    EXPECT_TRUE(pair_held);
+    auto fresh = predictor.predict_conflicts();
+    bool pair_fresh = false;
+    for (const auto& alert : fresh) pair_fresh |= (alert.aircraft1_id == 1 && alert.aircraft2_id == 2);
+    EXPECT_FALSE(pair_fresh);
+    
+    // Beyond the exit limit it clears
+    ac1.position_local = ac1.position_local + ac1.velocity * 1.0;
+    ac2.position_local = ac2.position_local + ac2.velocity * 1.0 + Vector2D(0.0, 200.0);
+    predictor.update_aircraft_state(ac1);
+    predictor.update_aircraft_state(ac2);
+    const auto& cleared = predictor.update_conflicts(1.0);
+    ASSERT_EQ(cleared.size(), 1u);
+    EXPECT_EQ(cleared[0].aircraft1_id, 3);
+}
+
+// Test: Partitioned collision pass on a task pool matches the serial one
+TEST_F(CollisionDetectionTest, ConflictPredictorParallelMatchesSerial) {
+    ConflictPredictor serial(30.0);
+    ConflictPredictor parallel(30.0);
+    parallel.set_thread_pool(std::make_shared<AICopilot::WorkStealingPool>(4));
+    
+    unsigned seed = 5;
+    auto next = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<double>((seed >> 8) & 0xFFFF) / 65535.0;
+    };
+    std::vector<SeparationStandards::AircraftState> states;
+    for (int i = 0; i < 400; ++i) {
+        double heading = next() * 360.0;
+        double speed = 10.0 + next() * 40.0;  // taxi speeds, ft/s
+        double rad = heading * 3.14159265358979323846 / 180.0;
+        states.push_back(createAircraftState(
+            i, next() * 20000.0, next() * 20000.0, 0.0,
+            speed * std::sin(rad), speed * std::cos(rad), heading, speed * 0.592484));
+    }
+    
+    for (int step = 0; step < 5; ++step) {
+        for (auto& ac : states) {
+            ac.position_local = ac.position_local + ac.velocity * 1.0;
+            if (ac.aircraft_id % 9 == step) ac.velocity = ac.velocity * 0.8;  // some change speed
+            serial.update_aircraft_state(ac);
+            parallel.update_aircraft_state(ac);
+        }
+        const auto& a = serial.update_conflicts(1.0);
+        const auto& b = parallel.update_conflicts(1.0);
+        ASSERT_EQ(a.size(), b.size());
+        EXPECT_GT(a.size(), 0u);
+        for (size_t k = 0; k < a.size(); ++k) {
+            EXPECT_EQ(a[k].aircraft1_id, b[k].aircraft1_id);
+            EXPECT_EQ(a[k].aircraft2_id, b[k].aircraft2_id);
+            EXPECT_DOUBLE_EQ(a[k].time_to_conflict_seconds, b[k].time_to_conflict_seconds);
+        }
+        EXPECT_EQ(serial.get_last_evaluated_pair_count(), parallel.get_last_evaluated_pair_count());
+    }
+    EXPECT_EQ(serial.find_candidate_pairs(500.0), parallel.find_candidate_pairs(500.0));
+}
+
+// Test: Monte-Carlo conflict probability follows the geometry and stops early
+TEST_F(CollisionDetectionTest, ConflictProbabilityEstimator) {
+    ConflictProbabilityEstimator estimator;
+    auto own = createAircraftState(1, 0, 0, 0, 0, 20, 0, 12);
+    
+    // Head-on along the same line: almost every sample loses separation
+    auto head_on = createAircraftState(2, 0, 1000, 0, 0, -20, 180, 12);
+    auto certain = estimator.estimate(own, head_on, 30.0, 500.0);
+    EXPECT_GT(certain.probability, 0.95);
+    EXPECT_LT(certain.samples, estimator.get_options().max_samples);
+    EXPECT_GT(certain.mean_time_to_conflict_seconds, 0.0);
+    EXPECT_LT(certain.mean_time_to_conflict_seconds, 25.0);
+    
+    // Far apart: one batch is enough to rule it out
+    auto distant = createAircraftState(3, 8000, 0, 0, 0, 20, 0, 12);
+    auto none = estimator.estimate(own, distant, 30.0, 500.0);
+    EXPECT_EQ(none.probability, 0.0);
+    EXPECT_EQ(none.samples, estimator.get_options().batch_size);
+    EXPECT_EQ(none.mean_time_to_conflict_seconds, -1.0);
+    
+    // Nominal miss right at the limit is a coin flip, and needs more samples
+    auto boundary = createAircraftState(4, 500, 1000, 0, 0, -20, 180, 12);
+    auto flip = estimator.estimate(own, boundary, 30.0, 500.0);
+    EXPECT_GT(flip.probability, 0.2);
+    EXPECT_LT(flip.probability, 0.8);
+    EXPECT_GT(flip.samples, none.samples);
+    
+    // Counter-keyed sampling is reproducible
+    auto again = estimator.estimate(own, boundary, 30.0, 500.0);
+    EXPECT_EQ(again.samples, flip.samples);
+    EXPECT_DOUBLE_EQ(again.probability, flip.probability);
+    
+    // Without uncertainty it reduces to the straight-line answer
+    ConflictProbabilityEstimator::UncertaintyModel exact;
+    exact.speed_sigma_fps = 0.0;
+    exact.heading_sigma_deg = 0.0;
+    exact.turn_rate_sigma_deg_per_sec = 0.0;
+    estimator.set_uncertainty_model(exact);
+    auto inside = createAircraftState(5, 400, 1000, 0, 0, -20, 180, 12);
+    auto outside = createAircraftState(6, 600, 1000, 0, 0, -20, 180, 12);
+    EXPECT_EQ(estimator.estimate(own, inside, 30.0, 500.0).probability, 1.0);
+    EXPECT_EQ(estimator.estimate(own, outside, 30.0, 500.0).probability, 0.0);
+}
+
+// Test: Probabilistic mode ranks the closest pairs and reports the top N
+TEST_F(CollisionDetectionTest, ConflictPredictorTopThreatProbabilities) {
+    ConflictPredictor predictor(30.0);
+    predictor.update_aircraft_state(createAircraftState(1, 0, 0, 0, 0, 20, 0, 12));
+    predictor.update_aircraft_state(createAircraftState(2, 0, 1000, 0, 0, -20, 180, 12));
+    predictor.update_aircraft_state(createAircraftState(3, 20000, 0, 0, 0, 20, 0, 12));
+    predictor.update_aircraft_state(createAircraftState(4, 20500, 1000, 0, 0, -20, 180, 12));
+    predictor.update_aircraft_state(createAircraftState(5, -40000, 0, 0, 0, 20, 0, 12));
+    
+    ConflictProbabilityEstimator estimator;
+    auto all = predictor.estimate_conflict_probabilities(10, estimator);
+    ASSERT_EQ(all.size(), 2u);
+    EXPECT_EQ(all[0].aircraft1_id, 1);
+    EXPECT_EQ(all[0].aircraft2_id, 2);
+    EXPECT_GT(all[0].probability, all[1].probability);
+    EXPECT_EQ(all[1].aircraft1_id, 3);
+    
+    auto top = predictor.estimate_conflict_probabilities(1, estimator);
+    ASSERT_EQ(top.size(), 1u);
+    EXPECT_EQ(top[0].aircraft1_id, 1);
+}
+
+// Test: Airport collision index matches brute force over concave aprons
+TEST_F(CollisionDetectionTest, AirportCollisionIndexMatchesBruteForce) {
+    // 20 x 20 grid of L-shaped (concave) aprons, 400 ft cells
+    std::vector<Polygon> aprons;
+    for (int gx = 0; gx < 20; ++gx) {
+        for (int gy = 0; gy < 20; ++gy) {
+            double x = gx * 400.0, y = gy * 400.0;
+            Polygon apron;
+            apron.add_vertex(Vector2D(x, y));
+            apron.add_vertex(Vector2D(x + 300.0, y));
+            apron.add_vertex(Vector2D(x + 300.0, y + 100.0));
+            apron.add_vertex(Vector2D(x + 150.0, y + 100.0));  // collinear with the next edge's start
+            apron.add_vertex(Vector2D(x + 100.0, y + 100.0));
+            apron.add_vertex(Vector2D(x + 100.0, y + 300.0));
+            apron.add_vertex(Vector2D(x, y + 300.0));
+            aprons.push_back(apron);
+        }
+    }
+    
+    AirportCollisionIndex index;
+    index.build(aprons);
+    EXPECT_EQ(index.get_polygon_count(), 400u);
+    EXPECT_EQ(index.get_piece_count(), 800u);  // each L splits into two convex pieces
+    
+    unsigned seed = 11;
+    auto next = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<double>((seed >> 8) & 0xFFFF) / 65535.0;
+    };
+    
+    // Containment agrees with ray casting
+    for (int i = 0; i < 2000; ++i) {
+        Vector2D p(next() * 8000.0, next() * 8000.0);
+        size_t expected = AirportCollisionIndex::npos;
+        for (size_t k = 0; k < aprons.size(); ++k) {
+            if (aprons[k].contains_point(p)) expected = k;
+        }
+        EXPECT_EQ(index.find_containing(p), expected);
+    }
+    
+    // Footprint overlap agrees with edge crossing plus containment
+    auto crosses = [](const Vector2D& a, const Vector2D& b, const Vector2D& c, const Vector2D& d) {
+        double d1 = (b - a).cross(c - a), d2 = (b - a).cross(d - a);
+        double d3 = (d - c).cross(a - c), d4 = (d - c).cross(b - c);
+        return ((d1 > 0) != (d2 > 0)) && ((d3 > 0) != (d4 > 0));
+    };
+    size_t total_tested = 0;
+    for (int i = 0; i < 300; ++i) {
+        Vector2D c(next() * 8000.0, next() * 8000.0);
+        double heading = next() * 6.283185307179586;
+        Vector2D u(std::cos(heading), std::sin(heading)), v(-u.y, u.x);
+        Polygon footprint;  // 120 x 40 ft rectangle
+        footprint.add_vertex(c + u * 60.0 + v * 20.0);
+        footprint.add_vertex(c - u * 60.0 + v * 20.0);
+        footprint.add_vertex(c - u * 60.0 - v * 20.0);
+        footprint.add_vertex(c + u * 60.0 - v * 20.0);
+        
+        std::vector<size_t> expected;
+        for (size_t k = 0; k < aprons.size(); ++k) {
+            const auto& av = aprons[k].vertices;
+            bool hit = aprons[k].contains_point(footprint.vertices[0]) ||
+                       footprint.contains_point(av[0]);
+            for (size_t e = 0; e < av.size() && !hit; ++e) {
+                for (size_t f = 0; f < 4 && !hit; ++f) {
+                    hit = crosses(av[e], av[(e + 1) % av.size()],
+                                  footprint.vertices[f], footprint.vertices[(f + 1) % 4]);
+                }
+            }
+            if (hit) expected.push_back(k);
+        }
+        
+        AirportCollisionIndex::QueryStats stats;
+        std::vector<size_t> hits;
+        index.query_polygon(footprint, hits, &stats);
+        EXPECT_EQ(hits, expected);
+        EXPECT_EQ(index.intersects_polygon(footprint), !expected.empty());
+        total_tested += stats.pieces_tested;
+    }
+    
+    // A footprint touches a handful of pieces, not the whole layout
+    EXPECT_LT(total_tested, 300u * 10u);
+    EXPECT_TRUE(index.intersects_circle(Circle(Vector2D(50.0, 350.0), 60.0)));
+    EXPECT_FALSE(index.intersects_circle(Circle(Vector2D(350.0, 350.0), 40.0)));
+}
+
 // Test: Maneuver selector - turn selection
 TEST_F(CollisionDetectionTest, ManeuverSelectorTurnManeuver) {
     ManeuverSelector selector;
@@ -306,6 +601,81 @@ TEST_F(CollisionDetectionTest, ConflictResolverMultiAircraft) {
     EXPECT_TRUE(plan.plan_effectiveness > 0.0);
 }
 
+// Test: Coordinated solver picks one maneuver that clears every threat and keeps it
+TEST_F(CollisionDetectionTest, CoordinatedManeuverSolverMultiThreat) {
+    CoordinatedManeuverSolver solver(30.0);
+    
+    // Northbound at 3000 ft; one threat head-on, one closing from the right
+    auto own = createAircraftState(1, 0, 0, 3000, 0, 100, 0, 59);
+    std::vector<SeparationStandards::AircraftState> threats = {
+        createAircraftState(2, 0, 3000, 3000, 0, -100, 180, 59),
+        createAircraftState(3, 1500, 1500, 3000, -100, 0, 270, 59),
+    };
+    
+    auto first = solver.solve(own, threats);
+    EXPECT_TRUE(first.resolves_all_threats);
+    EXPECT_GE(first.minimum_margin, 1.0);
+    EXPECT_FALSE(first.from_cache);
+    EXPECT_EQ(first.options_evaluated, 35u);
+    EXPECT_NE(first.maneuver.maneuver_type, AvoidanceManeuver::ManeuverType::None);
+    
+    // Independently fly the chosen option against both threats
+    double rad = first.heading_change_degrees * 3.14159265358979323846 / 180.0;
+    Vector2D velocity(own.velocity.x * std::cos(rad) + own.velocity.y * std::sin(rad),
+                      -own.velocity.x * std::sin(rad) + own.velocity.y * std::cos(rad));
+    for (const auto& threat : threats) {
+        for (double t = 0.0; t <= 30.0; t += 0.5) {
+            Vector2D delta = (threat.position_local + threat.velocity * t) - (own.position_local + velocity * t);
+            double vertical = std::abs(threat.altitude_feet - (own.altitude_feet + first.vertical_rate_fpm / 60.0 * t));
+            EXPECT_TRUE(delta.magnitude() >= 500.0 * 0.95 || vertical >= 1000.0 * 0.95);
+        }
+    }
+    
+    // Threats moving along the same tracks: the sense is reused without a search
+    auto later = own;
+    later.position_local = own.position_local + own.velocity * 1.0;
+    auto moved = threats;
+    for (auto& threat : moved) threat.position_local = threat.position_local + threat.velocity * 1.0;
+    auto second = solver.solve(later, moved);
+    EXPECT_TRUE(second.from_cache);
+    EXPECT_EQ(second.options_evaluated, 1u);
+    EXPECT_EQ(second.heading_change_degrees, first.heading_change_degrees);
+    EXPECT_EQ(second.vertical_rate_fpm, first.vertical_rate_fpm);
+    
+    // A threat changing its track is a new geometry
+    moved[1].velocity = Vector2D(-100, -40);
+    EXPECT_FALSE(solver.solve(later, moved).from_cache);
+    
+    // On the ground only heading options exist; no threats needs no maneuver
+    auto taxiing = createAircraftState(4, 0, 0, 0, 0, 20, 0, 12);
+    auto idle = solver.solve(taxiing, {});
+    EXPECT_EQ(idle.options_evaluated, 7u);
+    EXPECT_EQ(idle.maneuver.maneuver_type, AvoidanceManeuver::ManeuverType::None);
+    EXPECT_TRUE(idle.resolves_all_threats);
+}
+
+// Test: Coordinated resolution lets the second aircraft rely on the first's plan
+TEST_F(CollisionDetectionTest, ConflictResolverCoordinated) {
+    ConflictResolver resolver;
+    CoordinatedManeuverSolver solver(30.0);
+    resolver.set_coordinated_solver(&solver);
+    
+    std::map<int, SeparationStandards::AircraftState> states;
+    states[1] = createAircraftState(1, 0, 0, 3000, 0, 100, 0, 59);
+    states[2] = createAircraftState(2, 0, 3000, 3000, 0, -100, 180, 59);
+    
+    ConflictPredictor::ConflictAlert alert;
+    alert.aircraft1_id = 1;
+    alert.aircraft2_id = 2;
+    alert.time_to_conflict_seconds = 15.0;
+    
+    auto plan = resolver.resolve_multi_aircraft_conflicts({alert}, states);
+    EXPECT_TRUE(plan.resolves_all_conflicts);
+    ASSERT_EQ(plan.aircraft_maneuvers.size(), 1u);
+    EXPECT_EQ(plan.aircraft_maneuvers.count(1), 1u);
+    EXPECT_EQ(plan.resolution_strategy, "Coordinated multi-threat resolution");
+}
+
 // Test: Edge case - zero velocity aircraft
 TEST_F(CollisionDetectionTest, ZeroVelocityAircraft) {
     SeparationStandards standards;
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "../../include/config_parser.h"
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace AICopilot;
+
+namespace {
+
+const char* AIRCRAFT_CFG =
+    "; aircraft.cfg excerpt\n"
+    "[GENERAL]\r\n"
+    "atc_model = \"C172\" ; quoted\n"
+    "icao_type_designator=C172\n"
+    "stray line without equals\n"
+    "\n"
+    "[REFERENCE SPEEDS]\n"
+    "cruise_speed = 122.5\n"
+    "stall_speed = 48 ; knots\n"
+    "max_altitude = 1e999\n"
+    "# comment\n"
+    "[FLTSIM.0]\n"
+    "title = Cessna Skyhawk\n"
+    "[EMPTY]\n"
+    "[GENERAL]\n"
+    "icao_model = 172\n"
+    "icao_type_designator = C72R\n";
+
+std::string writeTemp(const std::string& name, const std::string& text) {
+    auto path = (std::filesystem::temp_directory_path() / name).string();
+    std::ofstream(path, std::ios::binary) << text;
+    return path;
+}
+
+} // namespace
+
+// Test: One pass handles comments, quotes, CRLF and repeated sections
+TEST(ConfigParserTest, ParsesAircraftCfgSyntax) {
+    auto config = ParsedConfig::fromText(AIRCRAFT_CFG);
+    ASSERT_NE(config->find("GENERAL", "atc_model"), nullptr);
+    EXPECT_EQ(*config->find("GENERAL", "atc_model"), "C172");
+    EXPECT_EQ(*config->find("GENERAL", "icao_model"), "172");
+    // The later value of a repeated key wins
+    EXPECT_EQ(*config->find("GENERAL", "icao_type_designator"), "C72R");
+    EXPECT_EQ(*config->find("REFERENCE SPEEDS", "stall_speed"), "48");
+    EXPECT_EQ(config->find("GENERAL", "stray line without equals"), nullptr);
+    EXPECT_EQ(config->find("FLTSIM.1", "title"), nullptr);
+
+    EXPECT_TRUE(config->hasSection("EMPTY"));
+    ASSERT_EQ(config->sections().size(), 4u);
+    EXPECT_EQ(config->sections().front(), "EMPTY");
+
+    auto general = config->sectionEntries("GENERAL");
+    ASSERT_EQ(general.second - general.first, 3);
+    EXPECT_EQ(general.first->key, "atc_model");
+}
+
+// Test: Typed getters keep their defaults for missing or unparsable values
+TEST(ConfigParserTest, TypedGettersFallBackToDefaults) {
+    auto path = writeTemp("aicopilot_config_parser_test.cfg", AIRCRAFT_CFG);
+    ConfigParser parser;
+    ASSERT_TRUE(parser.parse(path));
+    std::remove(path.c_str());
+
+    EXPECT_DOUBLE_EQ(parser.getDoubleValue("REFERENCE SPEEDS", "cruise_speed"), 122.5);
+    EXPECT_EQ(parser.getIntValue("REFERENCE SPEEDS", "stall_speed"), 48);
+    EXPECT_DOUBLE_EQ(parser.getDoubleValue("REFERENCE SPEEDS", "max_altitude", 7.0), 7.0);
+    EXPECT_EQ(parser.getIntValue("GENERAL", "atc_model", -1), -1);
+    EXPECT_EQ(parser.getValue("GENERAL", "missing", "none"), "none");
+    EXPECT_FALSE(parser.getBoolValue("GENERAL", "missing"));
+    EXPECT_TRUE(parser.hasKey("FLTSIM.0", "title"));
+    EXPECT_EQ(parser.getKeys("REFERENCE SPEEDS").size(), 3u);
+    EXPECT_EQ(parser.getSections().size(), 4u);
+
+    parser.clear();
+    EXPECT_FALSE(parser.hasSection("GENERAL"));
+    EXPECT_FALSE(parser.parse(path));
+}
+
+// Test: A file is parsed once until it changes on disk
+TEST(ConfigParserTest, CachesParsesByPathAndModificationTime) {
+    auto path = writeTemp("aicopilot_config_cache_test.cfg", "[GENERAL]\nicao_model = 172\n");
+
+    ConfigParser first;
+    ConfigParser second;
+    ASSERT_TRUE(first.parse(path));
+    ASSERT_TRUE(second.parse(path));
+    EXPECT_EQ(first.getParsed(), second.getParsed());
+    EXPECT_GE(ParsedConfig::cacheSize(), 1u);
+
+    writeTemp("aicopilot_config_cache_test.cfg", "[GENERAL]\nicao_model = 182\n");
+    std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(2));
+    ConfigParser third;
+    ASSERT_TRUE(third.parse(path));
+    EXPECT_NE(third.getParsed(), first.getParsed());
+    EXPECT_EQ(third.getValue("GENERAL", "icao_model"), "182");
+    // Earlier readers keep the parse they hold
+    EXPECT_EQ(first.getValue("GENERAL", "icao_model"), "172");
+
+    ParsedConfig::clearCache();
+    EXPECT_EQ(ParsedConfig::cacheSize(), 0u);
+    std::remove(path.c_str());
+}
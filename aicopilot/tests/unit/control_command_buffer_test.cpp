@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "../../include/control_command_buffer.hpp"
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+struct Emitted {
+    ControlChannel channel;
+    double value;
+    size_t index;
+};
+
+std::vector<Emitted> drainAll(ControlCommandBuffer& buffer) {
+    std::vector<Emitted> out;
+    buffer.drain([&](ControlChannel channel, double value, size_t index) {
+        out.push_back({channel, value, index});
+    });
+    return out;
+}
+
+} // namespace
+
+// Test: Repeated writes within a tick coalesce to the last value
+TEST(ControlCommandBufferTest, CoalescesWritesPerTick) {
+    ControlCommandBuffer buffer;
+    buffer.write(ControlChannel::ELEVATOR, 0.10);
+    buffer.write(ControlChannel::ELEVATOR, 0.15);
+    buffer.write(ControlChannel::ELEVATOR, 0.20);
+
+    EXPECT_EQ(buffer.pendingCount(), 1u);
+    auto out = drainAll(buffer);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0].channel, ControlChannel::ELEVATOR);
+    EXPECT_DOUBLE_EQ(out[0].value, 0.20);
+    EXPECT_EQ(buffer.getStatistics().coalesced, 2u);
+}
+
+// Test: Values within the deadband of the last flushed value are dropped
+TEST(ControlCommandBufferTest, DeadbandSuppressesSmallChanges) {
+    ControlCommandBuffer buffer;
+    buffer.write(ControlChannel::AP_ALTITUDE, 5000.0);
+    drainAll(buffer);
+
+    EXPECT_FALSE(buffer.write(ControlChannel::AP_ALTITUDE, 5005.0));
+    EXPECT_FALSE(buffer.hasPending());
+    EXPECT_TRUE(buffer.write(ControlChannel::AP_ALTITUDE, 5500.0));
+    EXPECT_TRUE(buffer.hasPending());
+    EXPECT_EQ(buffer.getStatistics().suppressed, 1u);
+}
+
+// Test: Returning to the flushed value within a tick cancels the write
+TEST(ControlCommandBufferTest, ReturnToSentValueCancelsPending) {
+    ControlCommandBuffer buffer;
+    buffer.write(ControlChannel::THROTTLE, 0.75);
+    drainAll(buffer);
+
+    buffer.write(ControlChannel::THROTTLE, 0.90);
+    buffer.write(ControlChannel::THROTTLE, 0.75);
+
+    EXPECT_FALSE(buffer.hasPending());
+    EXPECT_TRUE(drainAll(buffer).empty());
+}
+
+// Test: Drain emits each pending channel once with contiguous indices
+TEST(ControlCommandBufferTest, DrainEmitsContiguousIndices) {
+    ControlCommandBuffer buffer;
+    buffer.write(ControlChannel::AP_HEADING, 270.0);
+    buffer.write(ControlChannel::THROTTLE, 0.6);
+    buffer.write(ControlChannel::RUDDER, -0.1);
+
+    auto out = drainAll(buffer);
+    ASSERT_EQ(out.size(), 3u);
+    for (size_t i = 0; i < out.size(); ++i) {
+        EXPECT_EQ(out[i].index, i);
+    }
+    EXPECT_EQ(out[0].channel, ControlChannel::THROTTLE);
+    EXPECT_EQ(out[1].channel, ControlChannel::RUDDER);
+    EXPECT_EQ(out[2].channel, ControlChannel::AP_HEADING);
+
+    EXPECT_EQ(buffer.getStatistics().flushed, 3u);
+    EXPECT_EQ(buffer.getStatistics().flushes, 1u);
+    EXPECT_TRUE(drainAll(buffer).empty());
+    EXPECT_EQ(buffer.getStatistics().flushes, 1u);
+}
+
+// Test: Reset forgets flushed values so the next write is always sent
+TEST(ControlCommandBufferTest, ResetClearsSentHistory) {
+    ControlCommandBuffer buffer;
+    buffer.write(ControlChannel::AP_SPEED, 120.0);
+    drainAll(buffer);
+
+    buffer.reset();
+    EXPECT_TRUE(buffer.write(ControlChannel::AP_SPEED, 120.0));
+
+    double value = 0.0;
+    EXPECT_TRUE(buffer.peek(ControlChannel::AP_SPEED, value));
+    EXPECT_DOUBLE_EQ(value, 120.0);
+}
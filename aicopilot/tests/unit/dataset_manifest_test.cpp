@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "../../include/dataset_manifest.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace AICopilot;
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("aicopilot_manifest_" + name)).string();
+}
+
+std::string writeFile(const std::string& name, const std::string& contents) {
+    std::string path = tempPath(name);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << contents;
+    return path;
+}
+
+} // namespace
+
+// Test: Manifests survive text round trips and reject damaged lines;
+// the fingerprint depends on the files, not their names
+TEST(DatasetManifestTest, RoundTripAndFingerprint) {
+    std::string navdata = writeFile("nav.bin", "navdata cycle 2411");
+    std::string runways = writeFile("rwy.bin", "runways");
+
+    DatasetManifest manifest;
+    ASSERT_TRUE(manifest.addFile(DatasetKind::NAVDATA_PACK, navdata, "navdata-2411.pack"));
+    ASSERT_TRUE(manifest.addFile(DatasetKind::RUNWAY_PACK, runways));
+    EXPECT_FALSE(manifest.addFile(DatasetKind::MODEL_PACK, tempPath("absent.bin")));
+    ASSERT_EQ(manifest.size(), 2u);
+    EXPECT_EQ(manifest.entries()[0].size, 18u);
+    EXPECT_EQ(manifest.entries()[1].name, "aicopilot_manifest_rwy.bin");
+    EXPECT_EQ(manifest.find(DatasetKind::TERRAIN_PACK), nullptr);
+
+    DatasetManifest parsed;
+    ASSERT_TRUE(parsed.parse(manifest.serialize()));
+    ASSERT_EQ(parsed.size(), 2u);
+    for (size_t i = 0; i < 2; i++) {
+        EXPECT_EQ(parsed.entries()[i].kind, manifest.entries()[i].kind);
+        EXPECT_TRUE(parsed.entries()[i].sameContent(manifest.entries()[i]));
+        EXPECT_EQ(parsed.entries()[i].name, manifest.entries()[i].name);
+    }
+    EXPECT_EQ(parsed.fingerprint(), manifest.fingerprint());
+
+    std::string file = tempPath("fleet.manifest");
+    ASSERT_TRUE(manifest.save(file));
+    DatasetManifest loaded;
+    ASSERT_TRUE(loaded.load(file));
+    EXPECT_EQ(loaded.serialize(), manifest.serialize());
+
+    DatasetManifest renamed;
+    DatasetEntry entry = manifest.entries()[0];
+    entry.name = "other name";
+    renamed.add(entry);
+    renamed.add(manifest.entries()[1]);
+    EXPECT_EQ(renamed.fingerprint(), manifest.fingerprint());
+    entry.contentHash ^= 1;
+    DatasetManifest changed;
+    changed.add(entry);
+    changed.add(manifest.entries()[1]);
+    EXPECT_NE(changed.fingerprint(), manifest.fingerprint());
+
+    EXPECT_FALSE(parsed.parse("AICOPILOT-DATASETS 2\n"));
+    EXPECT_FALSE(parsed.parse("AICOPILOT-DATASETS 1\nlidar 0123456789abcdef 5 x\n"));
+    EXPECT_FALSE(parsed.parse("AICOPILOT-DATASETS 1\nnavdata 0123456789abcdeg 5 x\n"));
+    EXPECT_FALSE(parsed.parse("AICOPILOT-DATASETS 1\nnavdata 0123 5 x\n"));
+    EXPECT_EQ(parsed.size(), 0u);
+
+    std::filesystem::remove(navdata);
+    std::filesystem::remove(runways);
+    std::filesystem::remove(file);
+}
+
+// Test: The store only takes files that hash to their entry, and hands
+// DatasetReloader the paths it holds
+TEST(DatasetManifestTest, StoreImportsVerifiedFiles) {
+    std::string navdata = writeFile("store_nav.bin", "navdata cycle 2412");
+    std::string weather = writeFile("store_wx.bin", "METAR KTST 121200Z 27010KT");
+    std::string forged = writeFile("store_forged.bin", "navdata cycle 2413");
+
+    DatasetManifest manifest;
+    ASSERT_TRUE(manifest.addFile(DatasetKind::NAVDATA_PACK, navdata));
+    ASSERT_TRUE(manifest.addFile(DatasetKind::WEATHER_SNAPSHOT, weather));
+
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / "aicopilot_manifest_store";
+    std::filesystem::remove_all(dir);
+    DatasetStore store(dir.string());
+    EXPECT_EQ(store.missing(manifest).size(), 2u);
+    EXPECT_TRUE(store.reloadPaths(manifest).navdataPack.empty());
+
+    // Same size, different bytes
+    const DatasetEntry& navEntry = manifest.entries()[0];
+    EXPECT_FALSE(store.import(navEntry, forged));
+    EXPECT_FALSE(store.contains(navEntry));
+
+    EXPECT_TRUE(store.import(navEntry, navdata));
+    EXPECT_TRUE(store.import(navEntry, navdata));
+    ASSERT_EQ(store.missing(manifest).size(), 1u);
+    EXPECT_EQ(store.missing(manifest)[0].kind, DatasetKind::WEATHER_SNAPSHOT);
+
+    DatasetReloadPaths paths = store.reloadPaths(manifest);
+    EXPECT_EQ(paths.navdataPack, store.pathFor(navEntry));
+    EXPECT_TRUE(paths.weatherSnapshot.empty());
+    EXPECT_TRUE(paths.runwayPack.empty());
+
+    EXPECT_TRUE(store.import(manifest.entries()[1], weather));
+    EXPECT_TRUE(store.missing(manifest).empty());
+    paths = store.reloadPaths(manifest);
+    uint64_t hash = 0;
+    uint64_t size = 0;
+    ASSERT_TRUE(hashDatasetFile(paths.weatherSnapshot, hash, size));
+    EXPECT_EQ(hash, manifest.entries()[1].contentHash);
+    EXPECT_FALSE(std::filesystem::exists(paths.weatherSnapshot + ".partial"));
+
+    std::filesystem::remove_all(dir);
+    std::filesystem::remove(navdata);
+    std::filesystem::remove(weather);
+    std::filesystem::remove(forged);
+}
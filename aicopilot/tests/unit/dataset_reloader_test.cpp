@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "../../include/dataset_reloader.hpp"
+#include "../../include/navdata_database.hpp"
+#include "../../include/runway_database_prod.hpp"
+#include "../../include/weather_database.hpp"
+#include <filesystem>
+#include <string>
+
+using namespace AICopilot;
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("aicopilot_reload_" + name)).string();
+}
+
+// Two fixes on V1; a missing fix makes the pack fail CheckPackConsistency()
+std::string writeNavdata(const std::string& name, uint32_t cycle, bool missingFix) {
+    NavdataPackBuilder builder;
+    builder.setAiracCycle(cycle);
+    builder.putWaypoint(NavdataWaypoint("AAAAA", 40.0, -80.0, NavaidType::FIX, 0, 0, "TEST"));
+    builder.putWaypoint(NavdataWaypoint("BBBBB", 41.0, -79.0, NavaidType::FIX, 0, 0, "TEST"));
+    Airway v1("V1", 1000, 18000, AirwayLevel::LOW);
+    v1.waypointSequence = {"AAAAA", "BBBBB"};
+    if (missingFix) v1.waypointSequence.push_back("ZZZZZ");
+    builder.putAirway(v1);
+    std::string path = tempPath(name);
+    EXPECT_TRUE(builder.write(path));
+    return path;
+}
+
+std::string writeRunways(const std::string& name, int length) {
+    RunwayPackBuilder builder;
+    RunwayAirportInfo airport;
+    airport.icao = "KTST";
+    airport.latitude = 40.0;
+    airport.longitude = -80.0;
+    builder.putAirport(airport);
+    RunwayInfo rwy;
+    rwy.icao = "KTST";
+    rwy.runwayId = "09";
+    rwy.headingMagnetic = 90;
+    rwy.length = length;
+    rwy.width = 150;
+    builder.putRunway(rwy);
+    std::string path = tempPath(name);
+    EXPECT_TRUE(builder.write(path));
+    return path;
+}
+
+} // namespace
+
+// Test: A navdata cycle that fails the consistency check is not swapped in
+TEST(DatasetReloaderTest, NavdataValidatedBeforeSwap) {
+    auto navdata = std::make_shared<NavigationDatabase>();
+    EXPECT_EQ(navdata->CheckDatabaseConsistency(), "");
+    std::shared_ptr<const NavdataPack> builtIn = navdata->GetNavdataPack();
+    size_t builtInWaypoints = builtIn->getWaypointCount();
+
+    std::string good = writeNavdata("good.nav", 2411, false);
+    std::string bad = writeNavdata("bad.nav", 2412, true);
+    ASSERT_TRUE(navdata->LoadSnapshotAsync(good).get());
+    EXPECT_EQ(navdata->GetAiracCycle(), 2411u);
+    EXPECT_EQ(navdata->GetWaypointCount(), 2);
+    // The version held before the swap is still whole
+    EXPECT_EQ(builtIn->getWaypointCount(), builtInWaypoints);
+
+    NavdataPack pack;
+    ASSERT_TRUE(pack.open(bad));
+    EXPECT_NE(NavigationDatabase::CheckPackConsistency(pack), "");
+    pack.close();
+    EXPECT_FALSE(navdata->LoadSnapshot(bad));
+    EXPECT_EQ(navdata->GetAiracCycle(), 2411u);
+
+    std::filesystem::remove(good);
+    std::filesystem::remove(bad);
+}
+
+// Test: Spans keep the runways they came from; a bad pack is rejected
+TEST(DatasetReloaderTest, RunwaysValidatedBeforeSwap) {
+    RunwayDatabase runways;
+    runways.Initialize();
+    EXPECT_EQ(runways.CheckDatabaseConsistency(), "");
+    RunwaySpan before = runways.GetRunways("KJFK");
+    ASSERT_FALSE(before.empty());
+
+    std::string good = writeRunways("good.rwy", 8000);
+    std::string bad = writeRunways("bad.rwy", 0);
+    ASSERT_TRUE(runways.LoadPackAsync(good).get());
+    EXPECT_TRUE(runways.GetRunways("KJFK").empty());
+    ASSERT_EQ(runways.GetRunways("KTST").size(), 1u);
+    EXPECT_EQ(before[0].icao, "KJFK");
+
+    EXPECT_FALSE(runways.LoadPack(bad));
+    ASSERT_EQ(runways.GetRunways("KTST").size(), 1u);
+    EXPECT_EQ(runways.GetRunways("KTST")[0].length, 8000);
+
+    std::filesystem::remove(good);
+    std::filesystem::remove(bad);
+}
+
+// Test: One reload command updates every store it names and reports each
+TEST(DatasetReloaderTest, ReloadsStoresInBackground) {
+    std::string weatherPath = tempPath("weather.snap");
+    {
+        WeatherDatabase source;
+        ASSERT_TRUE(source.initialize());
+        ASSERT_TRUE(source.updateWeather("", "KBOS 121854Z 27015KT 3SM -SN OVC012 M03/M06 A2990"));
+        ASSERT_TRUE(source.saveSnapshot(weatherPath));
+    }
+    std::string navPath = writeNavdata("reload.nav", 2413, false);
+    std::string badRunways = writeRunways("reload.rwy", 0);
+
+    auto navdata = std::make_shared<NavigationDatabase>();
+    auto runways = std::make_shared<RunwayDatabase>();
+    runways->Initialize();
+    auto weather = std::make_shared<WeatherDatabase>();
+    ASSERT_TRUE(weather->initialize());
+
+    DatasetReloader reloader(navdata, runways, weather);
+    DatasetReloadPaths paths;
+    paths.navdataPack = navPath;
+    paths.weatherSnapshot = weatherPath;
+    DatasetReloadResult result = reloader.reloadAsync(paths).get();
+    EXPECT_TRUE(result.ok());
+    EXPECT_TRUE(result.navdataLoaded);
+    EXPECT_FALSE(result.runwaysRequested);
+    EXPECT_EQ(result.weatherReports, 1);
+    EXPECT_EQ(navdata->GetAiracCycle(), 2413u);
+    EXPECT_EQ(weather->getCacheSize(), 1);
+
+    // A rejected store leaves the others, and its own data, in place
+    DatasetReloadPaths runwaysOnly;
+    runwaysOnly.runwayPack = badRunways;
+    result = reloader.reload(runwaysOnly);
+    EXPECT_FALSE(result.ok());
+    EXPECT_FALSE(result.runwaysLoaded);
+    EXPECT_FALSE(runways->GetRunways("KJFK").empty());
+
+    weather->shutdown();
+    std::filesystem::remove(weatherPath);
+    std::filesystem::remove(navPath);
+    std::filesystem::remove(badRunways);
+}
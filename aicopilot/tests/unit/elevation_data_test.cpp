@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "../../include/elevation_data.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+class ElevationDataTest : public ::testing::Test {
+protected:
+    ElevationDatabase db;
+
+    void SetUp() override {
+        db.ClearCache();
+        db.ResetCacheStatistics();
+    }
+};
+
+} // namespace
+
+// Test: South-east of Mount Whitney the slope aspect faces downhill, away from the peak
+TEST_F(ElevationDataTest, SlopeAspectFacesDownhill) {
+    SlopeInfo slope = db.GetSlopeAngle(36.55, -118.25);
+
+    EXPECT_GT(slope.angle_degrees, 0.0);
+    EXPECT_GT(slope.aspect_degrees, 90.0);
+    EXPECT_LT(slope.aspect_degrees, 180.0);
+}
+
+// Test: Batched slope and water queries match the single-point queries
+TEST_F(ElevationDataTest, BatchedSlopeAndWaterMatchSingle) {
+    std::vector<LatLon> points = {
+        {43.0, -82.0}, {39.74, -104.99}, {36.578, -118.292},
+        {36.55, -118.25}, {95.0, 0.0}, {40.714, -74.006}
+    };
+    std::vector<SlopeInfo> slopes(points.size());
+    bool water[6] = {};
+    db.GetSlopeAngles(points.data(), points.size(), slopes.data());
+    db.IsWaterBody(points.data(), points.size(), water);
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        SlopeInfo single = db.GetSlopeAngle(points[i].latitude, points[i].longitude);
+        EXPECT_DOUBLE_EQ(slopes[i].angle_degrees, single.angle_degrees) << i;
+        EXPECT_DOUBLE_EQ(slopes[i].aspect_degrees, single.aspect_degrees) << i;
+        EXPECT_DOUBLE_EQ(slopes[i].max_elevation, single.max_elevation) << i;
+        EXPECT_EQ(water[i], db.IsWaterBody(points[i].latitude, points[i].longitude)) << i;
+    }
+    EXPECT_TRUE(water[0]);
+    EXPECT_FALSE(water[1]);
+    EXPECT_FALSE(water[4]);  // invalid coordinates
+}
+
+// Test: A loaded land-water raster replaces the mask derived from elevation
+TEST_F(ElevationDataTest, LoadedWaterMaskReplacesElevationMask) {
+    // Denver's tile, with the raster marking its northern half as water
+    ASSERT_FALSE(db.IsWaterBody(39.74, -104.99));
+    const int samples = 11;
+    std::vector<uint8_t> mask(samples * samples, 0);
+    std::fill(mask.begin(), mask.begin() + samples * 5, 1);
+
+    EXPECT_FALSE(db.LoadWaterMask(39, -105, nullptr, samples));
+    EXPECT_FALSE(db.LoadWaterMask(39, -105, mask.data(), 1));
+    ASSERT_TRUE(db.LoadWaterMask(39, -105, mask.data(), samples));
+
+    EXPECT_TRUE(db.IsWaterBody(39.9, -104.5));
+    EXPECT_FALSE(db.IsWaterBody(39.2, -104.5));
+    EXPECT_TRUE(db.IsWaterBody(39.74, -104.99));
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "../../include/feature_index.hpp"
+#include "../../include/ml_decision_system.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+using Index = FeatureIndex<4>;
+
+// Clustered points with some spread, reproducible
+std::vector<Index::Vector> makePoints(size_t count) {
+    std::vector<Index::Vector> points;
+    uint32_t state = 12345;
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return (state >> 8) / static_cast<double>(1u << 24);
+    };
+    for (size_t i = 0; i < count; ++i) {
+        double center = static_cast<double>(i % 5);
+        points.push_back({center + 0.3 * next(), center - 0.3 * next(), next(), 0.5 * next()});
+    }
+    return points;
+}
+
+} // namespace
+
+// Test: Radius and k-nearest queries return exactly what a linear scan does, through erases
+TEST(FeatureIndexTest, MatchesLinearScan) {
+    std::vector<Index::Vector> points = makePoints(600);
+    Index index(0.4, 32);
+    for (size_t i = 0; i < points.size(); ++i) index.insert(static_cast<uint32_t>(i), points[i]);
+    for (uint32_t id = 0; id < points.size(); id += 3) EXPECT_TRUE(index.erase(id));
+    EXPECT_FALSE(index.erase(0));
+    EXPECT_EQ(index.size(), 400u);
+    EXPECT_LE(index.getCellCount(), 32u);
+
+    EuclideanDistance distance;
+    for (size_t q = 0; q < points.size(); q += 37) {
+        Index::Vector query = points[q];
+        query[2] += 0.05;
+
+        std::vector<std::pair<uint32_t, double>> expected;
+        for (uint32_t id = 0; id < points.size(); ++id) {
+            if (id % 3 != 0) expected.emplace_back(id, distance(query, points[id]));
+        }
+        std::sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+            return a.second < b.second || (a.second == b.second && a.first < b.first);
+        });
+
+        std::vector<uint32_t> within;
+        index.forEachWithin(query, 0.35, [&](uint32_t id, double) { within.push_back(id); });
+        std::sort(within.begin(), within.end());
+        std::vector<uint32_t> expectedWithin;
+        for (const auto& [id, d] : expected) {
+            if (d <= 0.35) expectedWithin.push_back(id);
+        }
+        std::sort(expectedWithin.begin(), expectedWithin.end());
+        EXPECT_EQ(within, expectedWithin);
+
+        std::vector<std::pair<uint32_t, double>> nearest;
+        index.nearest(query, 7, nearest);
+        ASSERT_EQ(nearest.size(), 7u);
+        for (size_t i = 0; i < nearest.size(); ++i) EXPECT_EQ(nearest[i].first, expected[i].first);
+    }
+
+    // Re-inserting an id moves it
+    index.insert(1, {10.0, 10.0, 10.0, 10.0});
+    std::vector<std::pair<uint32_t, double>> nearest;
+    index.nearest({10.0, 10.0, 10.0, 10.0}, 1, nearest);
+    ASSERT_EQ(nearest.size(), 1u);
+    EXPECT_EQ(nearest[0].first, 1u);
+    EXPECT_EQ(index.size(), 400u);
+
+    index.clear();
+    index.nearest(points[0], 3, nearest);
+    EXPECT_TRUE(nearest.empty());
+}
+
+// Test: Training keeps a bounded reservoir and votes only on similar contexts in the same phase
+TEST(FeatureIndexTest, DecisionSystemReservoir) {
+    MLDecisionSystem ml;
+    ml.initialize();
+    ml.setTrainingDataLimit(50);
+
+    DecisionContext ctx;
+    ctx.phase = FlightPhase::APPROACH;
+    ctx.state.position = {40.0, -74.0, 2000.0, 180.0};
+    ctx.state.indicatedAirspeed = 150.0;
+    ctx.state.onGround = false;
+    ctx.atcOptions = {"Descend", "Maintain", "Climb"};
+
+    for (int i = 0; i < 500; ++i) {
+        TrainingData data;
+        data.context = ctx;
+        data.context.state.indicatedAirspeed = 100.0 + (i % 10);
+        data.context.phase = i % 2 ? FlightPhase::APPROACH : FlightPhase::CRUISE;
+        data.correctOption = i % 2 ? 2 : 0;
+        data.reward = 1.0;
+        ml.trainWithFeedback(data);
+    }
+    EXPECT_EQ(ml.getTrainingDataCount(), 50u);
+    EXPECT_EQ(ml.getFeedbackCount(), 500u);
+
+    // Every retained APPROACH example says "Climb"; the CRUISE ones never count
+    EXPECT_DOUBLE_EQ(ml.getConfidence(ctx, 2), 1.0);
+    EXPECT_DOUBLE_EQ(ml.getConfidence(ctx, 0), 0.0);
+
+    ml.setTrainingDataLimit(10);
+    EXPECT_EQ(ml.getTrainingDataCount(), 10u);
+    ml.clearTrainingData();
+    EXPECT_EQ(ml.getFeedbackCount(), 0u);
+    EXPECT_DOUBLE_EQ(ml.getConfidence(ctx, 2), 0.5);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "../../include/fleet_partition.hpp"
+#include <algorithm>
+#include <set>
+
+using namespace AICopilot;
+
+namespace {
+
+// Short hops around a centre, like a regional shuttle network
+void addCluster(std::vector<FleetPilotRoute>& pilots, double lat, double lon, int count) {
+    for (int i = 0; i < count; i++) {
+        FleetPilotRoute pilot;
+        pilot.pilotId = static_cast<uint32_t>(pilots.size());
+        double offset = (i % 5) * 0.1;
+        pilot.route = {{lat + offset, lon - offset}, {lat + 0.3, lon + 0.2}, {lat - offset, lon + 0.4}};
+        pilots.push_back(pilot);
+    }
+}
+
+} // namespace
+
+// Test: The curve index visits every tile of the grid once
+TEST(FleetPartitionTest, HilbertIndexIsUnique) {
+    std::set<uint32_t> seen;
+    for (int lat = -90; lat < 90; lat++) {
+        for (int lon = -180; lon < 180; lon++) {
+            uint32_t d = FleetPartitioner::hilbertIndex(packTileKey(lat, lon));
+            EXPECT_LT(d, 512u * 512u);
+            seen.insert(d);
+        }
+    }
+    EXPECT_EQ(seen.size(), 180u * 360u);
+
+    // Neighbouring tiles are usually close on the curve
+    uint32_t a = FleetPartitioner::hilbertIndex(packTileKey(40, -80));
+    uint32_t b = FleetPartitioner::hilbertIndex(packTileKey(40, -79));
+    EXPECT_LT(a > b ? a - b : b - a, 512u);
+}
+
+// Test: Regional clusters stay whole on one node, load is balanced, and
+// only nodes that can see each other's traffic are peers
+TEST(FleetPartitionTest, ClustersStayLocalAndBalanced) {
+    std::vector<FleetPilotRoute> pilots;
+    addCluster(pilots, 40.5, -80.5, 30);    // Pittsburgh
+    addCluster(pilots, 40.9, -79.9, 30);    // next door, within the exchange radius
+    addCluster(pilots, 51.2, 0.2, 30);      // London
+    addCluster(pilots, 35.5, 139.5, 30);    // Tokyo
+
+    FleetPartitioner partitioner(40.0);
+    FleetPartition partition = partitioner.partition(pilots, 4);
+    ASSERT_EQ(partition.nodes.size(), 4u);
+    ASSERT_EQ(partition.nodeOfPilot.size(), pilots.size());
+
+    size_t assigned = 0;
+    for (const auto& node : partition.nodes) {
+        EXPECT_EQ(node.pilots.size(), 30u);
+        EXPECT_DOUBLE_EQ(node.weight, 30.0);
+        EXPECT_TRUE(std::is_sorted(node.tiles.begin(), node.tiles.end()));
+        EXPECT_LE(node.tiles.size(), 4u);
+        assigned += node.pilots.size();
+    }
+    EXPECT_EQ(assigned, pilots.size());
+
+    // Each cluster on one node
+    for (size_t cluster = 0; cluster < 4; cluster++) {
+        uint32_t node = partition.nodeOfPilot[cluster * 30];
+        for (size_t i = 1; i < 30; i++) EXPECT_EQ(partition.nodeOfPilot[cluster * 30 + i], node);
+    }
+
+    uint32_t pittsburgh = partition.nodeOfPilot[0];
+    uint32_t nextDoor = partition.nodeOfPilot[30];
+    uint32_t london = partition.nodeOfPilot[60];
+    uint32_t tokyo = partition.nodeOfPilot[90];
+    std::set<uint32_t> distinct = {pittsburgh, nextDoor, london, tokyo};
+    EXPECT_EQ(distinct.size(), 4u);
+
+    EXPECT_EQ(partition.nodes[pittsburgh].neighbors, std::vector<uint32_t>{nextDoor});
+    EXPECT_EQ(partition.nodes[nextDoor].neighbors, std::vector<uint32_t>{pittsburgh});
+    EXPECT_TRUE(partition.nodes[london].neighbors.empty());
+    EXPECT_TRUE(partition.nodes[tokyo].neighbors.empty());
+
+    // Pittsburgh's pilots need traffic near the edge of their routes, not London's
+    EXPECT_TRUE(partition.inExchangeRegion(pittsburgh, 40.5, -80.5));
+    EXPECT_TRUE(partition.inExchangeRegion(pittsburgh, 41.2, -80.5));
+    EXPECT_FALSE(partition.inExchangeRegion(pittsburgh, 51.2, 0.2));
+}
+
+// Test: Weights balance heavy pilots against many light ones, and surplus
+// nodes are left empty
+TEST(FleetPartitionTest, WeightedAndSurplusNodes) {
+    std::vector<FleetPilotRoute> pilots;
+    addCluster(pilots, 10.5, 10.5, 10);
+    addCluster(pilots, 60.5, 100.5, 2);
+    for (size_t i = 10; i < 12; i++) pilots[i].weight = 5.0;
+
+    FleetPartition two = FleetPartitioner().partition(pilots, 2);
+    EXPECT_DOUBLE_EQ(two.nodes[0].weight, 10.0);
+    EXPECT_DOUBLE_EQ(two.nodes[1].weight, 10.0);
+
+    FleetPartition five = FleetPartitioner().partition(pilots, 5);
+    size_t used = 0;
+    for (const auto& node : five.nodes) {
+        if (!node.pilots.empty()) used++;
+        else EXPECT_TRUE(node.bounds.empty());
+    }
+    EXPECT_EQ(used, 2u);
+
+    FleetPartition none = FleetPartitioner().partition({}, 3);
+    EXPECT_EQ(none.nodes.size(), 3u);
+    EXPECT_TRUE(none.nodeOfPilot.empty());
+}
@@ -0,0 +1,323 @@
+#include <gtest/gtest.h>
+#include "../../include/flight_data_recorder.hpp"
+#include "../../include/ai_pilot.h"
+#include "../../include/ml_learning.hpp"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Cruise with small turbulence; timestamps at 30 Hz with jitter and gaps
+std::vector<FlightDataSample> makeFlight(size_t rows, unsigned seed = 7) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    std::vector<FlightDataSample> samples(rows);
+    int64_t t = 1000000;
+    for (size_t i = 0; i < rows; ++i) {
+        FlightDataSample& s = samples[i];
+        t += 33333 + (i % 50 == 0 ? static_cast<int64_t>(noise(rng) * 400) : 0);
+        if (i == rows / 2) t += 90LL * 1000000;   // pause
+        s.timestampUs = t;
+        s.state.position = {47.0 + i * 1e-5, -122.0 - i * 2e-5, 6000.0 + std::sin(i * 0.01) * 20.0, 0.0};
+        s.state.heading = 90.0;
+        s.state.bank = noise(rng) * 0.5;
+        s.state.pitch = 2.0;
+        s.state.indicatedAirspeed = 110.0 + noise(rng) * 0.2;
+        s.state.verticalSpeed = i % 100 < 50 ? 0.0 : 200.0;
+        s.state.fuelQuantity = 50.0 - i * 0.0001;
+        s.state.engineRPM = 2400.0;
+        s.state.gearDown = true;
+        s.state.masterBattery = true;
+        s.state.batteryVoltage = 28.0;
+        s.autopilot.masterEnabled = true;
+        s.autopilot.altitudeHold = true;
+        s.autopilot.targetAltitude = 6000.0;
+        s.phase = FlightPhase::CRUISE;
+    }
+    return samples;
+}
+
+size_t writeSamples(const std::string& path, const std::vector<FlightDataSample>& samples, uint32_t rowsPerChunk) {
+    FlightDataWriter writer(rowsPerChunk);
+    EXPECT_TRUE(writer.open(path));
+    for (const FlightDataSample& s : samples) EXPECT_TRUE(writer.append(s));
+    writer.close();
+    return static_cast<size_t>(writer.getBytesWritten());
+}
+
+void expectSameRow(const FlightDataSample& a, const FlightDataSample& b) {
+    for (uint32_t c = 0; c < FDR_COLUMN_COUNT; ++c) {
+        auto column = static_cast<FlightDataColumn>(c);
+        double x = a.column(column);
+        double y = b.column(column);
+        ASSERT_EQ(std::memcmp(&x, &y, sizeof(double)), 0) << flightDataColumnName(column);
+    }
+}
+
+} // namespace
+
+// Test: Every column survives the round trip bit for bit, across chunks and gaps
+TEST(FlightDataRecorderTest, RoundTripsSamplesExactly) {
+    auto path = tempPath("aicopilot_fdr_roundtrip.aifr");
+    std::vector<FlightDataSample> samples = makeFlight(3000);
+    samples[10].timestampUs = samples[9].timestampUs;              // repeated timestamp
+    samples[11].state.position.altitude = -0.0;
+    samples[12].state.altimeter = std::numeric_limits<double>::max();
+    samples[13].state.batteryLoad = std::numeric_limits<double>::denorm_min();
+    samples[2999].phase = FlightPhase::DESCENT;
+    writeSamples(path, samples, 256);
+
+    FlightDataReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.getRowCount(), 3000u);
+    EXPECT_EQ(reader.getChunkCount(), 12u);
+    EXPECT_EQ(reader.getChunk(0).firstTimestampUs, samples[0].timestampUs);
+    EXPECT_EQ(reader.getChunk(11).lastTimestampUs, samples.back().timestampUs);
+
+    std::vector<FlightDataSample> restored;
+    ASSERT_TRUE(reader.readSamples(restored));
+    ASSERT_EQ(restored.size(), samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        EXPECT_EQ(restored[i].timestampUs, samples[i].timestampUs);
+        expectSameRow(restored[i], samples[i]);
+    }
+    EXPECT_EQ(restored.back().phase, FlightPhase::DESCENT);
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+// Test: Steady telemetry encodes to a small fraction of the raw row size
+TEST(FlightDataRecorderTest, CompressesSteadyTelemetry) {
+    auto path = tempPath("aicopilot_fdr_compress.aifr");
+    std::vector<FlightDataSample> samples = makeFlight(18000);   // ten minutes at 30 Hz
+    size_t bytes = writeSamples(path, samples, FlightDataWriter::DEFAULT_ROWS_PER_CHUNK);
+    size_t raw = samples.size() * FDR_COLUMN_COUNT * sizeof(double);
+    EXPECT_LT(bytes * 5, raw);
+    std::filesystem::remove(path);
+}
+
+// Test: A bounded scan returns just the rows in range, aligned across columns
+TEST(FlightDataRecorderTest, ScansColumnsInTimeRange) {
+    auto path = tempPath("aicopilot_fdr_scan.aifr");
+    std::vector<FlightDataSample> samples = makeFlight(5000);
+    writeSamples(path, samples, 512);
+
+    FlightDataReader reader;
+    ASSERT_TRUE(reader.open(path));
+    int64_t start = samples[1200].timestampUs;
+    int64_t end = samples[2100].timestampUs;
+    std::vector<int64_t> timestamps;
+    std::vector<double> altitudes;
+    ASSERT_TRUE(reader.readTimestamps(timestamps, start, end));
+    ASSERT_TRUE(reader.readColumn(FDR_ALTITUDE, altitudes, start, end));
+    ASSERT_EQ(timestamps.size(), 901u);
+    ASSERT_EQ(altitudes.size(), timestamps.size());
+    for (size_t i = 0; i < altitudes.size(); ++i) {
+        EXPECT_EQ(timestamps[i], samples[1200 + i].timestampUs);
+        EXPECT_EQ(altitudes[i], samples[1200 + i].state.position.altitude);
+    }
+
+    std::vector<double> all;
+    ASSERT_TRUE(reader.readColumn(FDR_INDICATED_AIRSPEED, all));
+    EXPECT_EQ(all.size(), reader.getRowCount());
+    ASSERT_TRUE(reader.readColumn(FDR_ALTITUDE, altitudes, end + 1000000000LL, FlightDataReader::ALL_TIME_END));
+    EXPECT_TRUE(altitudes.empty());
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+// Test: Bad column bytes fail that column's read; a bad or foreign header fails open
+TEST(FlightDataRecorderTest, RejectsCorruptRecordings) {
+    auto path = tempPath("aicopilot_fdr_corrupt.aifr");
+    writeSamples(path, makeFlight(600), 256);
+
+    FlightDataReader reader;
+    ASSERT_TRUE(reader.open(path));
+    FlightDataChunkHeader first = reader.getChunk(0);
+    reader.close();
+    uint64_t bankOffset = sizeof(FlightDataFileHeader) + sizeof(FlightDataChunkHeader);
+    for (uint32_t c = 0; c < FDR_BANK; ++c) bankOffset += first.columnBytes[c];
+
+    std::vector<char> image;
+    {
+        std::ifstream in(path, std::ios::binary);
+        image.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    auto writeImage = [&](const std::vector<char>& bytes) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    };
+
+    std::vector<char> flipped = image;
+    flipped[bankOffset + 1] ^= 0x10;
+    writeImage(flipped);
+    ASSERT_TRUE(reader.open(path));
+    std::vector<double> values;
+    EXPECT_FALSE(reader.readColumn(FDR_BANK, values));
+    EXPECT_TRUE(reader.readColumn(FDR_ALTITUDE, values));
+    reader.close();
+
+    std::vector<char> badHeader = image;
+    badHeader[sizeof(FlightDataFileHeader) + 4] ^= 0x1;   // row count
+    writeImage(badHeader);
+    EXPECT_FALSE(reader.open(path));
+
+    std::vector<char> foreign = image;
+    foreign[0] = 'X';
+    writeImage(foreign);
+    EXPECT_FALSE(reader.open(path));
+
+    // A crash mid-chunk leaves the complete chunks readable
+    std::vector<char> truncated(image.begin(), image.end() - 16);
+    writeImage(truncated);
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_EQ(reader.getChunkCount(), 2u);
+    EXPECT_EQ(reader.getRowCount(), 512u);
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+// Test: One recorder thread writes many streams fed from several threads
+TEST(FlightDataRecorderTest, RecorderWritesManyStreams) {
+    const size_t streamCount = 8;
+    const size_t rows = 1500;
+    std::vector<FlightDataSample> samples = makeFlight(rows);
+    std::vector<std::string> paths;
+    {
+        FlightDataRecorder recorder(128);
+        std::vector<std::shared_ptr<FlightDataStream>> streams;
+        for (size_t i = 0; i < streamCount; ++i) {
+            paths.push_back(tempPath(("aicopilot_fdr_stream" + std::to_string(i) + ".aifr").c_str()));
+            streams.push_back(recorder.openStream(paths.back()));
+            ASSERT_NE(streams.back(), nullptr);
+        }
+        EXPECT_EQ(recorder.getStreamCount(), streamCount);
+        EXPECT_EQ(recorder.openStream("/nonexistent/dir/recording.aifr"), nullptr);
+
+        std::vector<std::thread> producers;
+        for (size_t i = 0; i < streamCount; ++i) {
+            producers.emplace_back([&, i] {
+                for (size_t r = 0; r < rows; ++r) {
+                    while (!streams[i]->record(samples[r])) std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& producer : producers) producer.join();
+
+        for (size_t i = 0; i + 1 < streamCount; ++i) {
+            streams[i]->close();
+            EXPECT_FALSE(streams[i]->isOpen());
+            EXPECT_FALSE(streams[i]->record(samples[0]));
+        }
+        EXPECT_EQ(recorder.getStreamCount(), 1u);
+        // The last stream is finished by the recorder's destructor
+    }
+
+    for (const std::string& path : paths) {
+        FlightDataReader reader;
+        ASSERT_TRUE(reader.open(path));
+        std::vector<int64_t> timestamps;
+        ASSERT_TRUE(reader.readTimestamps(timestamps));
+        ASSERT_EQ(timestamps.size(), rows);
+        EXPECT_EQ(timestamps.back(), samples.back().timestampUs);
+        reader.close();
+        std::filesystem::remove(path);
+    }
+}
+
+// Test: The ML pattern database is built straight from a recording's columns
+TEST(FlightDataRecorderTest, BuildsPatternDatabase) {
+    auto path = tempPath("aicopilot_fdr_patterns.aifr");
+    std::vector<FlightDataSample> samples = makeFlight(900);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        FlightDataSample& s = samples[i];
+        if (i < 300) {
+            s.phase = FlightPhase::CLIMB;
+            s.state.verticalSpeed = 700.0;
+        } else if (i < 600) {
+            s.phase = FlightPhase::APPROACH;
+            s.state.verticalSpeed = i == 450 ? -1500.0 : -600.0;   // one unstable moment
+        } else {
+            s.phase = FlightPhase::LANDING;
+            s.state.verticalSpeed = -400.0;
+        }
+    }
+    writeSamples(path, samples, 256);
+
+    FlightDataReader reader;
+    ASSERT_TRUE(reader.open(path));
+    ML::MLLearningSystem learner;
+    EXPECT_EQ(learner.buildPatternDatabase(reader), 3u);
+    EXPECT_EQ(learner.buildPatternDatabase(reader), 3u);
+    EXPECT_EQ(learner.getLearningStatistics().patterns_discovered, 3);
+
+    std::vector<ML::HistoricalPattern> patterns = learner.findHistoricalPatterns(ML::CombinedFeatures{});
+    ASSERT_EQ(patterns.size(), 3u);
+    EXPECT_EQ(patterns.back().pattern_name, "approach");
+    EXPECT_DOUBLE_EQ(patterns.back().success_rate, 0.0);
+    EXPECT_EQ(patterns.back().occurrence_count, 2);
+    EXPECT_DOUBLE_EQ(patterns.front().success_rate, 1.0);
+    EXPECT_FALSE(patterns.front().recommendation.empty());
+
+    ML::MLLearningSystem unread;
+    FlightDataReader closed;
+    EXPECT_EQ(unread.buildPatternDatabase(closed), 0u);
+    reader.close();
+    std::filesystem::remove(path);
+}
+
+// Test: A headless AIPilot records one row per control cycle in sim time
+TEST(FlightDataRecorderTest, RecordsHeadlessPilot) {
+    auto cfgPath = tempPath("aicopilot_fdr_aircraft.cfg");
+    auto path = tempPath("aicopilot_fdr_pilot.aifr");
+    {
+        std::ofstream out(cfgPath);
+        out << "[GENERAL]\natc_model=C172\n"
+            << "[REFERENCE SPEEDS]\ncruise_speed=120\nstall_speed=48\nmax_indicated_speed=160\n"
+            << "[GENERALENGINEDATA]\nengine_type=1\n[FUEL]\nfuel_capacity=53\n";
+    }
+    HeadlessSimConfig config;
+    config.start = {47.0, -122.0, 5000.0, 0.0};
+    config.startOnGround = false;
+
+    auto recorder = std::make_shared<FlightDataRecorder>();
+    AIPilot pilot;
+    EXPECT_FALSE(pilot.startFlightDataRecording(path, recorder));   // not connected
+    ASSERT_TRUE(pilot.initializeHeadless(config));
+    ASSERT_TRUE(pilot.loadAircraftConfig(cfgPath));
+    ASSERT_TRUE(pilot.startFlightDataRecording(path, recorder));
+    EXPECT_TRUE(pilot.isFlightDataRecording());
+    pilot.startAutonomousFlight();
+    const int cycles = static_cast<int>(60.0 * AIPilot::CONTROL_RATE_HZ);
+    for (int i = 0; i < cycles; ++i) pilot.update();
+    pilot.stopAutonomousFlight();
+    pilot.stopFlightDataRecording();
+    EXPECT_FALSE(pilot.isFlightDataRecording());
+
+    FlightDataReader reader;
+    ASSERT_TRUE(reader.open(path));
+    std::vector<int64_t> timestamps;
+    std::vector<double> altitudes;
+    ASSERT_TRUE(reader.readTimestamps(timestamps));
+    ASSERT_TRUE(reader.readColumn(FDR_ALTITUDE, altitudes));
+    ASSERT_GT(timestamps.size(), static_cast<size_t>(cycles * 9 / 10));
+    EXPECT_LE(timestamps.size(), static_cast<size_t>(cycles));
+    int64_t period = static_cast<int64_t>(std::llround(1e6 / AIPilot::CONTROL_RATE_HZ));
+    EXPECT_NEAR(static_cast<double>(timestamps[1] - timestamps[0]), static_cast<double>(period), 1.0);
+    EXPECT_NEAR(static_cast<double>(timestamps.back()), 60e6, 2.0 * period);
+    EXPECT_GT(altitudes.back(), altitudes.front());   // climbing toward 10000 ft
+    reader.close();
+    std::filesystem::remove(path);
+    std::filesystem::remove(cfgPath);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "../../include/flight_phase_table.hpp"
+
+using namespace AICopilot;
+using namespace std::chrono_literals;
+
+namespace {
+
+PhaseInputs airborne(double altitude, double verticalSpeed) {
+    PhaseInputs in;
+    in.onGround = false;
+    in.groundSpeed = 150.0;
+    in.altitude = altitude;
+    in.verticalSpeed = verticalSpeed;
+    in.targetAltitude = 10000.0;
+    return in;
+}
+
+PhaseInputs ground(double groundSpeed) {
+    PhaseInputs in;
+    in.onGround = true;
+    in.groundSpeed = groundSpeed;
+    in.targetAltitude = 10000.0;
+    return in;
+}
+
+} // namespace
+
+// Test: The compile-time index covers every row exactly once
+TEST(FlightPhaseTableTest, IndexCoversAllRows) {
+    size_t covered = 0;
+    for (size_t phase = 0; phase < FLIGHT_PHASE_COUNT; ++phase) {
+        const PhaseTransitionRange& range = PHASE_TRANSITION_INDEX[phase];
+        ASSERT_LE(range.begin, range.end);
+        for (size_t row = range.begin; row < range.end; ++row) {
+            EXPECT_EQ(static_cast<size_t>(PHASE_TRANSITIONS[row].from), phase);
+        }
+        covered += range.end - range.begin;
+    }
+    EXPECT_EQ(covered, PHASE_TRANSITION_COUNT);
+
+    static_assert(PHASE_TRANSITION_INDEX[static_cast<size_t>(FlightPhase::SHUTDOWN)].begin ==
+                  PHASE_TRANSITION_INDEX[static_cast<size_t>(FlightPhase::SHUTDOWN)].end,
+                  "SHUTDOWN has no table transitions");
+}
+
+// Test: A full flight walks the expected phase sequence
+TEST(FlightPhaseTableTest, NominalFlightSequence) {
+    FlightPhaseMachine machine;
+    auto t = FlightPhaseMachine::Clock::time_point{} + 1s;
+    machine.reset(FlightPhase::PREFLIGHT, t);
+
+    struct Step { PhaseInputs in; FlightPhase expected; };
+    const Step steps[] = {
+        {ground(2.0), FlightPhase::PREFLIGHT},
+        {ground(12.0), FlightPhase::TAXI_OUT},
+        {ground(60.0), FlightPhase::TAKEOFF},
+        {airborne(500.0, 1500.0), FlightPhase::TAKEOFF},
+        {airborne(3000.0, 1500.0), FlightPhase::CLIMB},
+        {airborne(10000.0, 0.0), FlightPhase::CRUISE},
+        {airborne(9000.0, -1000.0), FlightPhase::DESCENT},
+        {airborne(3000.0, 0.0), FlightPhase::APPROACH},
+        {airborne(3000.0, 0.0), FlightPhase::APPROACH},   // level segment stays on approach
+        {airborne(800.0, -700.0), FlightPhase::LANDING},
+        {ground(30.0), FlightPhase::TAXI_IN},
+        {ground(0.0), FlightPhase::TAXI_IN},
+    };
+    for (const Step& step : steps) {
+        t += 100ms;
+        machine.update(step.in, t);
+        EXPECT_EQ(machine.getPhase(), step.expected);
+    }
+}
+
+// Test: Only the current phase's guards are evaluated
+TEST(FlightPhaseTableTest, EvaluatesOnlyCurrentPhaseGuards) {
+    FlightPhaseMachine machine;
+    auto t = FlightPhaseMachine::Clock::time_point{} + 1s;
+    machine.reset(FlightPhase::CRUISE, t);
+
+    machine.update(airborne(10000.0, 0.0), t + 100ms);
+    const PhaseTransitionRange& range = PHASE_TRANSITION_INDEX[static_cast<size_t>(FlightPhase::CRUISE)];
+    EXPECT_EQ(machine.getGuardEvaluations(), range.end - range.begin);
+
+    machine.reset(FlightPhase::SHUTDOWN, t);
+    machine.update(ground(0.0), t + 200ms);
+    EXPECT_EQ(machine.getGuardEvaluations(), range.end - range.begin);
+}
+
+// Test: Fired transitions record dwell time and notify the observer
+TEST(FlightPhaseTableTest, RecordsTransitionDwell) {
+    FlightPhaseMachine machine;
+    auto t = FlightPhaseMachine::Clock::time_point{} + 1s;
+    machine.reset(FlightPhase::CLIMB, t);
+
+    const PhaseTransition* observed = nullptr;
+    machine.setTransitionObserver([&observed](const PhaseTransition& transition, double) {
+        observed = &transition;
+    });
+
+    size_t row = machine.update(airborne(10000.0, 0.0), t + 90s);
+    ASSERT_NE(row, FlightPhaseMachine::npos);
+    EXPECT_EQ(PHASE_TRANSITIONS[row].to, FlightPhase::CRUISE);
+    EXPECT_EQ(observed, &PHASE_TRANSITIONS[row]);
+
+    const PhaseTransitionStats& stats = machine.getTransitionStats()[row];
+    EXPECT_EQ(stats.fireCount, 1u);
+    EXPECT_NEAR(stats.lastDwellSeconds, 90.0, 1e-9);
+
+    EXPECT_EQ(machine.update(airborne(10000.0, 0.0), t + 91s), FlightPhaseMachine::npos);
+}
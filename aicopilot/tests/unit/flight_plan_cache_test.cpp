@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include "../../include/flight_plan_cache.hpp"
+#include "../../include/navigation.h"
+#include "../../include/navdata_provider.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+std::string tempPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("aicopilot_plan_" + name)).string();
+}
+
+std::string writeFile(const std::string& name, const std::string& contents) {
+    std::string path = tempPath(name);
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << contents;
+    return path;
+}
+
+const char* const SEATTLE_PLN =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n"
+    "<SimBase.Document Type=\"AceXML\" version=\"1,0\">\r\n"
+    "  <FlightPlan.FlightPlan>\r\n"
+    "    <Title>KSEA to KPDX</Title>\r\n"
+    "    <CruisingAlt>12000</CruisingAlt>\r\n"
+    "    <DepartureID>KSEA</DepartureID>\r\n"
+    "    <DepartureLLA>N47\xC2\xB0 26' 56.00\",W122\xC2\xB0 18' 34.00\",+000432.00</DepartureLLA>\r\n"
+    "    <DestinationID>KPDX</DestinationID>\r\n"
+    "    <DestinationLLA>45.5887,-122.5975,+000031.00</DestinationLLA>\r\n"
+    "    <ATCWaypoint id=\"KSEA\"><ATCWaypointType>Airport</ATCWaypointType></ATCWaypoint>\r\n"
+    "  </FlightPlan.FlightPlan>\r\n"
+    "</SimBase.Document>\r\n";
+
+const char* const SHUTTLE_FMS =
+    "I\n"
+    "3 version\n"
+    "AIRPORT KBOS 42.3656 -71.0096 20\n"
+    "# climb out\n"
+    "VOR BOS 42.3573 -70.9895 5000\n"
+    "FIX BAD 95.0 -71.0 5000\n"
+    "FIX LOW 42.0 -71.0 -5000\n"
+    "garbage line\n"
+    "FIX PARCH 41.5 -72.0 11000 extra\n"
+    "AIRPORT KJFK 40.6398 -73.7789 13\n";
+
+// Knows two airports and one VOR; counts requests, not codes
+class BatchProvider : public INavdataProvider {
+public:
+    bool initialize() override { return true; }
+    void shutdown() override {}
+    bool isReady() const override { return true; }
+    bool getAirportByICAO(const std::string&, AirportInfo&) const override { return false; }
+    bool getAirportLayout(const std::string&, AirportLayout&) const override { return false; }
+    std::vector<AirportInfo> getAirportsNearby(const Position&, double) const override { return {}; }
+    bool getNavaidByID(const std::string&, NavaidInfo&) const override { return false; }
+    std::vector<NavaidInfo> getNavaidsNearby(const Position&, double, const std::string&) const override {
+        return {};
+    }
+    bool getNearestAirport(const Position&, AirportInfo&) const override { return false; }
+
+    size_t getAirportsByICAO(const std::vector<std::string>& icaos,
+                             std::vector<AirportInfo>& infos) const override {
+        airportRequests++;
+        infos.assign(icaos.size(), AirportInfo{});
+        size_t found = 0;
+        for (size_t i = 0; i < icaos.size(); i++) {
+            if (icaos[i] == "KSEA" || icaos[i] == "KPDX") {
+                infos[i].icao = icaos[i];
+                infos[i].position.latitude = icaos[i] == "KSEA" ? 47.449 : 45.589;
+                infos[i].position.longitude = icaos[i] == "KSEA" ? -122.309 : -122.597;
+                infos[i].elevation = icaos[i] == "KSEA" ? 432.0 : 31.0;
+                found++;
+            }
+        }
+        return found;
+    }
+    size_t getNavaidsByID(const std::vector<std::string>& ids, std::vector<NavaidInfo>& infos) const override {
+        navaidRequests++;
+        infos.assign(ids.size(), NavaidInfo{});
+        for (size_t i = 0; i < ids.size(); i++) {
+            if (ids[i] == "BTG") {
+                infos[i].id = ids[i];
+                infos[i].position.latitude = 45.748;
+                infos[i].position.longitude = -122.592;
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    mutable int airportRequests = 0;
+    mutable int navaidRequests = 0;
+};
+
+} // namespace
+
+// Test: PLN elements are read in one pass regardless of line layout, with
+// degree-minute-second and decimal coordinates
+TEST(FlightPlanCacheTest, ParsesPLN) {
+    FlightPlan plan{};
+    ASSERT_TRUE(parseFlightPlan(SEATTLE_PLN, FlightPlanFormat::PLN, plan));
+    EXPECT_EQ(plan.departure, "KSEA");
+    EXPECT_EQ(plan.arrival, "KPDX");
+    EXPECT_DOUBLE_EQ(plan.cruiseAltitude, 12000.0);
+    ASSERT_EQ(plan.waypoints.size(), 2u);
+    EXPECT_EQ(plan.waypoints[0].id, "KSEA");
+    EXPECT_EQ(plan.waypoints[0].type, "AIRPORT");
+    EXPECT_NEAR(plan.waypoints[0].position.latitude, 47.448889, 1e-5);
+    EXPECT_NEAR(plan.waypoints[0].position.longitude, -122.309444, 1e-5);
+    EXPECT_DOUBLE_EQ(plan.waypoints[0].altitude, 432.0);
+    EXPECT_NEAR(plan.waypoints[1].position.latitude, 45.5887, 1e-9);
+
+    // Whole document on one line, Title only
+    ASSERT_TRUE(parseFlightPlan("<Title>KAAA to KBBB</Title><DepartureLLA>40.0,-80.0,+100</DepartureLLA>"
+                                "<CruiseAltitude>7000</CruiseAltitude>",
+                                FlightPlanFormat::PLN, plan));
+    EXPECT_EQ(plan.departure, "KAAA");
+    ASSERT_EQ(plan.waypoints.size(), 1u);
+    EXPECT_EQ(plan.waypoints[0].id, "KAAA");
+    EXPECT_DOUBLE_EQ(plan.cruiseAltitude, 7000.0);
+
+    // No airport at all, or only out-of-range ones, is no plan
+    EXPECT_FALSE(parseFlightPlan("<Title>nothing</Title>", FlightPlanFormat::PLN, plan));
+    EXPECT_FALSE(parseFlightPlan("<DepartureLLA>95.0,-80.0,+0</DepartureLLA>", FlightPlanFormat::PLN, plan));
+    EXPECT_FALSE(parseFlightPlan("<DepartureLLA>40.0,-80.0", FlightPlanFormat::PLN, plan));
+    EXPECT_EQ(plan.departure, "KAAA");
+}
+
+// Test: FMS lines skip the header, comments and bad rows, and headings
+// follow the legs
+TEST(FlightPlanCacheTest, ParsesFMS) {
+    FlightPlan plan{};
+    ASSERT_TRUE(parseFlightPlan(SHUTTLE_FMS, FlightPlanFormat::FMS, plan));
+    ASSERT_EQ(plan.waypoints.size(), 4u);
+    EXPECT_EQ(plan.departure, "KBOS");
+    EXPECT_EQ(plan.arrival, "KJFK");
+    EXPECT_EQ(plan.waypoints[1].type, "VOR");
+    EXPECT_EQ(plan.waypoints[2].id, "PARCH");
+    EXPECT_DOUBLE_EQ(plan.cruiseAltitude, 11000.0);
+    EXPECT_GT(plan.waypoints[2].position.heading, 180.0);
+    EXPECT_LT(plan.waypoints[2].position.heading, 270.0);
+    EXPECT_DOUBLE_EQ(plan.waypoints[3].position.heading, plan.waypoints[2].position.heading);
+
+    EXPECT_FALSE(parseFlightPlan("I\n3 version\nFIX ONLY 40.0 -70.0 1000\n", FlightPlanFormat::FMS, plan));
+    EXPECT_EQ(flightPlanFormatFor("route.FMS"), FlightPlanFormat::FMS);
+    EXPECT_EQ(flightPlanFormatFor("dir.v2/route.Pln"), FlightPlanFormat::PLN);
+    EXPECT_EQ(flightPlanFormatFor("route.txt"), FlightPlanFormat::UNKNOWN);
+    EXPECT_EQ(flightPlanFormatFor("route"), FlightPlanFormat::UNKNOWN);
+}
+
+// Test: Pilots loading copies of the same plan share one parse; a
+// different file is parsed separately and the oldest entry is evicted
+TEST(FlightPlanCacheTest, SharesParsesByContent) {
+    std::string first = writeFile("a.fms", SHUTTLE_FMS);
+    std::string copy = writeFile("b.fms", SHUTTLE_FMS);
+    std::string other = writeFile("seattle.pln", SEATTLE_PLN);
+    std::string broken = writeFile("broken.pln", "<Title>nothing</Title>");
+
+    auto cache = std::make_shared<FlightPlanCache>(2);
+    std::vector<std::shared_ptr<const FlightPlan>> loaded(8);
+    std::vector<std::thread> pilots;
+    for (size_t i = 0; i < loaded.size(); i++) {
+        pilots.emplace_back([&, i] { loaded[i] = cache->load(i % 2 ? copy : first); });
+    }
+    for (auto& pilot : pilots) pilot.join();
+    for (const auto& plan : loaded) {
+        ASSERT_NE(plan, nullptr);
+        EXPECT_EQ(plan, loaded[0]);
+    }
+    FlightPlanCache::Stats stats = cache->getStats();
+    EXPECT_EQ(stats.hits + stats.misses, loaded.size());
+    EXPECT_EQ(cache->size(), 1u);
+
+    EXPECT_EQ(cache->load(broken), nullptr);
+    EXPECT_EQ(cache->load(broken), nullptr);
+    EXPECT_EQ(cache->load(tempPath("absent.pln")), nullptr);
+    EXPECT_EQ(cache->size(), 2u);
+
+    Navigation nav;
+    nav.setFlightPlanCache(cache);
+    ASSERT_TRUE(nav.loadFlightPlan(other));
+    EXPECT_EQ(nav.getFlightPlan().arrival, "KPDX");
+    EXPECT_EQ(nav.getLegTable().getLegCount(), 1u);
+    EXPECT_EQ(cache->size(), 2u);
+    EXPECT_EQ(cache->getStats().evictions, 1u);
+    EXPECT_FALSE(nav.loadFlightPlan(tempPath("absent.fms")));
+
+    // The plan Navigation flies is its own copy
+    nav.advanceWaypoint();
+    nav.removeWaypoint(0);
+    EXPECT_EQ(cache->load(other)->waypoints.size(), 2u);
+
+    std::filesystem::remove(first);
+    std::filesystem::remove(copy);
+    std::filesystem::remove(other);
+    std::filesystem::remove(broken);
+}
+
+// Test: Waypoints named without a position are placed with one navdata
+// request per kind
+TEST(FlightPlanCacheTest, ResolvesWaypointsInOneBatch) {
+    std::string path = writeFile("ids.pln",
+                                 "<DepartureID>KSEA</DepartureID><DestinationID>KPDX</DestinationID>");
+    Navigation nav;
+    nav.setFlightPlanCache(std::make_shared<FlightPlanCache>());
+    ASSERT_TRUE(nav.loadFlightPlan(path));
+    EXPECT_FALSE(nav.validateFlightPlan());
+
+    Waypoint fix;
+    fix.id = "BTG";
+    fix.type = "VOR";
+    fix.altitude = 6000.0;
+    fix.position = {0.0, 0.0, 0.0, 0.0};
+    Waypoint unknown = fix;
+    unknown.id = "NOWHR";
+    nav.insertWaypoint(1, fix);
+    nav.insertWaypoint(2, unknown);
+
+    BatchProvider navdata;
+    EXPECT_EQ(nav.resolveWaypoints(navdata), 3u);
+    EXPECT_EQ(navdata.airportRequests, 1);
+    EXPECT_EQ(navdata.navaidRequests, 1);
+
+    FlightPlan plan = nav.getFlightPlan();
+    EXPECT_DOUBLE_EQ(plan.waypoints[0].position.latitude, 47.449);
+    EXPECT_DOUBLE_EQ(plan.waypoints[0].altitude, 432.0);
+    EXPECT_DOUBLE_EQ(plan.waypoints[1].position.latitude, 45.748);
+    EXPECT_DOUBLE_EQ(plan.waypoints[1].altitude, 6000.0);
+    EXPECT_DOUBLE_EQ(plan.waypoints[2].position.latitude, 0.0);
+    EXPECT_DOUBLE_EQ(plan.waypoints[3].position.longitude, -122.597);
+    EXPECT_GT(nav.getTotalDistance(), 100.0);
+
+    // Nothing left that navdata knows: no second round of requests for placed fixes
+    nav.removeWaypoint(2);
+    EXPECT_EQ(nav.resolveWaypoints(navdata), 0u);
+    EXPECT_EQ(navdata.airportRequests, 1);
+    EXPECT_EQ(navdata.navaidRequests, 1);
+    EXPECT_TRUE(nav.validateFlightPlan());
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "../../include/geodesy.hpp"
+#include "../../include/coordinate_utils.hpp"
+#include "../../include/validation_framework.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+struct Points {
+    std::vector<double> lat;
+    std::vector<double> lon;
+};
+
+Points makePoints(unsigned seed, size_t count, double latSpan, double lonSpan, double lat0, double lon0) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dLat(-latSpan, latSpan), dLon(-lonSpan, lonSpan);
+    Points points;
+    for (size_t i = 0; i < count; ++i) {
+        points.lat.push_back(std::clamp(lat0 + dLat(rng), -90.0, 90.0));
+        points.lon.push_back(lon0 + dLon(rng));
+    }
+    return points;
+}
+
+// The atan2 haversine the tree used before
+double referenceDistance(double lat1, double lon1, double lat2, double lon2) {
+    const double k = Geodesy::DEG_TO_RAD;
+    double a = std::sin((lat2 - lat1) * k / 2) * std::sin((lat2 - lat1) * k / 2) +
+               std::cos(lat1 * k) * std::cos(lat2 * k) * std::sin((lon2 - lon1) * k / 2) * std::sin((lon2 - lon1) * k / 2);
+    return 2.0 * std::atan2(std::sqrt(a), std::sqrt(1.0 - a)) * Geodesy::EARTH_RADIUS_NM;
+}
+
+} // namespace
+
+// Test: Every exact kernel agrees, scalar and batched, over the whole globe
+TEST(GeodesyTest, KernelsAgree) {
+    const double lat0 = 47.45, lon0 = -122.31;
+    Points points = makePoints(3, 4000, 130.0, 179.0, lat0, lon0);
+    const size_t n = points.lat.size();
+    std::vector<double> haversine(n), bearing(n), chord(n), x(n), y(n), z(n);
+    Geodesy::haversineBatchNM(lat0, lon0, points.lat.data(), points.lon.data(), n, haversine.data());
+    Geodesy::initialBearingBatch(lat0, lon0, points.lat.data(), points.lon.data(), n, bearing.data());
+    Geodesy::toUnitVectorBatch(points.lat.data(), points.lon.data(), n, x.data(), y.data(), z.data());
+    Geodesy::chordDistanceBatchNM(Geodesy::toUnitVector(lat0, lon0), x.data(), y.data(), z.data(), n, chord.data());
+
+    for (size_t i = 0; i < n; ++i) {
+        double reference = referenceDistance(lat0, lon0, points.lat[i], points.lon[i]);
+        ASSERT_NEAR(Geodesy::haversineNM(lat0, lon0, points.lat[i], points.lon[i]), reference, 1e-6);
+        ASSERT_NEAR(haversine[i], reference, 1e-6);
+        ASSERT_NEAR(chord[i], reference, 1e-6);
+        ASSERT_NEAR(bearing[i], Geodesy::initialBearing(lat0, lon0, points.lat[i], points.lon[i]), 1e-9);
+        ASSERT_GE(bearing[i], 0.0);
+        ASSERT_LT(bearing[i], 360.0);
+    }
+
+    // Callers share the kernels
+    EXPECT_DOUBLE_EQ(CoordinateUtils::haversineDistance(10.0, 20.0, -30.0, 40.0),
+                     Geodesy::haversineNM(10.0, 20.0, -30.0, 40.0));
+    EXPECT_DOUBLE_EQ(CoordinateValidator::greatCircleDistance(10.0, 20.0, -30.0, 40.0),
+                     Geodesy::haversineNM(10.0, 20.0, -30.0, 40.0));
+    EXPECT_DOUBLE_EQ(CoordinateUtils::calculateBearing(10.0, 20.0, -30.0, 40.0),
+                     Geodesy::initialBearing(10.0, 20.0, -30.0, 40.0));
+
+    // Antipodes and coincident points stay finite
+    EXPECT_NEAR(Geodesy::haversineNM(0.0, 0.0, 0.0, 180.0), Geodesy::PI * Geodesy::EARTH_RADIUS_NM, 1e-6);
+    EXPECT_NEAR(Geodesy::chordDistanceNM(Geodesy::toUnitVector(0.0, 0.0), Geodesy::toUnitVector(0.0, 180.0)),
+                Geodesy::PI * Geodesy::EARTH_RADIUS_NM, 1e-6);
+    EXPECT_DOUBLE_EQ(Geodesy::haversineNM(12.0, 34.0, 12.0, 34.0), 0.0);
+}
+
+// Test: The flat-earth path is close within its range, including across the antimeridian
+TEST(GeodesyTest, FlatEarthShortRange) {
+    for (double lat0 : {0.0, 45.0, 65.0}) {
+        Points points = makePoints(11, 2000, 1.2, 1.2 / std::cos(lat0 * Geodesy::DEG_TO_RAD), lat0, 179.5);
+        const size_t n = points.lat.size();
+        std::vector<double> flat(n);
+        Geodesy::flatDistanceBatchNM(lat0, 179.5, points.lat.data(), points.lon.data(), n, flat.data());
+        for (size_t i = 0; i < n; ++i) {
+            double exact = Geodesy::haversineNM(lat0, 179.5, points.lat[i], points.lon[i]);
+            if (exact > Geodesy::FLAT_EARTH_MAX_NM) continue;
+            ASSERT_NEAR(flat[i], exact, std::max(exact * 1e-3, 1e-6)) << lat0 << " " << i;
+            ASSERT_DOUBLE_EQ(flat[i], Geodesy::flatDistanceNM(lat0, 179.5, points.lat[i], points.lon[i]));
+        }
+    }
+    EXPECT_NEAR(Geodesy::flatDistanceNM(0.0, 179.9, 0.0, -179.9), 12.0, 0.01);
+}
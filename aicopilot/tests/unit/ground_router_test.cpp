@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "../../include/atc_routing.hpp"
+#include <random>
+
+using namespace AICopilot;
+using namespace AICopilot::ATC;
+
+namespace {
+
+constexpr double FEET_PER_DEGREE_LAT = 364000.0;
+
+// rows x cols grid of nodes 1000 ft apart; IDs descend so the smallest ID is
+// never the best node to expand
+Airport::TaxiwayNetwork makeGrid(int rows, int cols, unsigned seed) {
+    Airport::TaxiwayNetwork network;
+    auto id = [&](int r, int c) { return 100000 - (r * cols + c); };
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            Airport::TaxiwayNode node(id(r, c), Airport::LatLonAlt(33.64 + r * 1000.0 / FEET_PER_DEGREE_LAT,
+                                                                   -84.43 + c * 1000.0 / (FEET_PER_DEGREE_LAT * 0.832)));
+            network.add_node(node);
+        }
+    }
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> detour(1.0, 1.6);
+    std::uniform_real_distribution<double> speed(8.0, 25.0);
+    int edgeId = 1;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            if (c + 1 < cols) {
+                Airport::TaxiwayEdge edge(edgeId++, id(r, c), id(r, c + 1), 1000.0 * detour(rng));
+                edge.max_speed_knots = speed(rng);
+                network.add_edge(edge);
+            }
+            if (r + 1 < rows) {
+                Airport::TaxiwayEdge edge(edgeId++, id(r, c), id(r + 1, c), 1000.0 * detour(rng));
+                edge.max_speed_knots = speed(rng);
+                network.add_edge(edge);
+            }
+        }
+    }
+    return network;
+}
+
+// Reference: Bellman-Ford style relaxation over every edge until stable
+double referenceCost(const Airport::TaxiwayNetwork& network, int start, int end, bool timed, double speed) {
+    std::map<int, double> cost;
+    for (int id : network.get_all_node_ids()) cost[id] = std::numeric_limits<double>::infinity();
+    cost[start] = 0.0;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int id : network.get_all_node_ids()) {
+            if (cost[id] == std::numeric_limits<double>::infinity()) continue;
+            for (int edgeId : network.get_adjacent_edges(id)) {
+                const Airport::TaxiwayEdge* edge = network.get_edge(edgeId);
+                double step = timed ? edge->calculate_traversal_time_seconds(speed) : edge->length_feet;
+                if (cost[id] + step < cost[edge->to_node_id] - 1e-9) {
+                    cost[edge->to_node_id] = cost[id] + step;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return cost[end];
+}
+
+} // namespace
+
+// Test: A* and Dijkstra return optimal paths on a grid with uneven edges
+TEST(GroundRouterTest, FindsOptimalPaths) {
+    Airport::TaxiwayNetwork network = makeGrid(12, 12, 5);
+    GroundRouter router;
+    router.set_taxiway_network(&network);
+
+    std::vector<int> ids = network.get_all_node_ids();
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<size_t> pick(0, ids.size() - 1);
+    for (int q = 0; q < 20; ++q) {
+        int start = ids[pick(rng)];
+        int end = ids[pick(rng)];
+
+        auto shortest = router.find_shortest_path(start, end, 20.0);
+        ASSERT_TRUE(shortest.success);
+        EXPECT_NEAR(shortest.total_distance_feet, referenceCost(network, start, end, false, 20.0), 1e-6);
+
+        auto fastest = router.find_fastest_path(start, end, Airport::LatLonAlt(), 20.0);
+        ASSERT_TRUE(fastest.success);
+        EXPECT_NEAR(fastest.estimated_time_seconds, referenceCost(network, start, end, true, 20.0), 1e-6);
+        EXPECT_EQ(fastest.path_node_ids.front(), start);
+        EXPECT_EQ(fastest.path_node_ids.back(), end);
+        EXPECT_EQ(fastest.path_edge_ids.size() + 1, fastest.path_node_ids.size());
+    }
+}
+
+// Test: Edges shorter than the straight line between their nodes do not mislead A*
+TEST(GroundRouterTest, ShortDeclaredEdges) {
+    Airport::TaxiwayNetwork network;
+    network.add_node(Airport::TaxiwayNode(1, Airport::LatLonAlt(33.640, -84.430)));
+    network.add_node(Airport::TaxiwayNode(2, Airport::LatLonAlt(33.650, -84.430)));  // ~3600 ft away
+    network.add_node(Airport::TaxiwayNode(3, Airport::LatLonAlt(33.641, -84.430)));
+    network.add_node(Airport::TaxiwayNode(4, Airport::LatLonAlt(33.642, -84.430)));
+    network.add_edge(Airport::TaxiwayEdge(1, 1, 2, 300.0));   // declared far shorter
+    network.add_edge(Airport::TaxiwayEdge(2, 2, 4, 300.0));
+    network.add_edge(Airport::TaxiwayEdge(3, 1, 3, 400.0));
+    network.add_edge(Airport::TaxiwayEdge(4, 3, 4, 400.0));
+
+    GroundRouter router;
+    router.set_taxiway_network(&network);
+    auto route = router.find_fastest_path(1, 4, Airport::LatLonAlt());
+    ASSERT_TRUE(route.success);
+    EXPECT_EQ(route.path_node_ids, (std::vector<int>{1, 2, 4}));
+    EXPECT_DOUBLE_EQ(route.total_distance_feet, 600.0);
+}
+
+// Test: Unknown nodes, unreachable nodes and network changes between searches
+TEST(GroundRouterTest, ReusesWorkspaceAcrossChanges) {
+    Airport::TaxiwayNetwork network;
+    network.add_node(Airport::TaxiwayNode(1, Airport::LatLonAlt(33.640, -84.430)));
+    network.add_node(Airport::TaxiwayNode(2, Airport::LatLonAlt(33.641, -84.430)));
+    network.add_node(Airport::TaxiwayNode(3, Airport::LatLonAlt(33.642, -84.430)));
+    network.add_edge(Airport::TaxiwayEdge(1, 1, 2, 400.0));
+
+    GroundRouter router;
+    EXPECT_FALSE(router.find_shortest_path(1, 2).success);
+    router.set_taxiway_network(&network);
+    EXPECT_FALSE(router.find_shortest_path(1, 99).success);
+    EXPECT_FALSE(router.find_fastest_path(1, 3, Airport::LatLonAlt()).success);
+
+    network.add_edge(Airport::TaxiwayEdge(2, 2, 3, 400.0));
+    auto route = router.find_fastest_path(1, 3, Airport::LatLonAlt());
+    ASSERT_TRUE(route.success);
+    EXPECT_EQ(route.path_node_ids, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(route.path_edge_ids, (std::vector<int>{1, 2}));
+
+    auto back = router.find_shortest_path(3, 1);
+    ASSERT_TRUE(back.success);
+    EXPECT_EQ(back.path_edge_ids, (std::vector<int>{100002, 100001}));  // reverse edges
+}
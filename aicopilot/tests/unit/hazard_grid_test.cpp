@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include "../../include/hazard_grid.hpp"
+#include "../../include/weather_system.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+WeatherHazard makeCell(double lat, double lon, double radius, double bottom = 5000.0, double top = 30000.0,
+                       WeatherHazardType type = WeatherHazardType::THUNDERSTORM,
+                       HazardSeverity severity = HazardSeverity::SEVERE) {
+    WeatherHazard hazard{};
+    hazard.type = type;
+    hazard.severity = severity;
+    hazard.position = {lat, lon, 0.0, 0.0};
+    hazard.radius = radius;
+    hazard.altitude = bottom;
+    hazard.topAltitude = top;
+    hazard.description = "Cell";
+    return hazard;
+}
+
+Position at(double lat, double lon) {
+    return {lat, lon, 0.0, 0.0};
+}
+
+// The grid's measure, done the long way
+double closestApproachNM(const WeatherHazard& hazard, const Position& a, const Position& b) {
+    double scale = 60.0 * std::cos(hazard.position.latitude * 3.14159265358979323846 / 180.0);
+    double best = std::numeric_limits<double>::infinity();
+    for (int i = 0; i <= 2000; ++i) {
+        double f = i / 2000.0;
+        double east = (a.longitude + (b.longitude - a.longitude) * f - hazard.position.longitude) * scale;
+        double north = (a.latitude + (b.latitude - a.latitude) * f - hazard.position.latitude) * 60.0;
+        best = std::min(best, std::sqrt(east * east + north * north));
+    }
+    return best;
+}
+
+} // namespace
+
+// Test: A cell marks its disc within its altitude band; unusable hazards aren't held
+TEST(HazardGridTest, PointSamplesByLayer) {
+    HazardGrid grid;
+    ASSERT_TRUE(grid.setHazard(7, makeCell(40.5, -100.5, 10.0)));
+    EXPECT_EQ(grid.hazardCount(), 1u);
+
+    HazardGridSample centre = grid.sample(40.5, -100.5, 10000.0);
+    EXPECT_EQ(centre.intensity, HazardGrid::intensityFor(HazardSeverity::SEVERE));
+    EXPECT_TRUE(centre.has(WeatherHazardType::THUNDERSTORM));
+    EXPECT_FALSE(centre.has(WeatherHazardType::WIND_SHEAR));
+    EXPECT_FALSE(grid.sample(40.5, -100.5, 40000.0).any());
+    EXPECT_FALSE(grid.sample(40.5, -100.5, 2000.0).any());
+    EXPECT_FALSE(grid.sample(41.0, -100.5, 10000.0).any());   // 30 nm north
+
+    // Weaker towards the edge, still marked just inside it
+    HazardGridSample edge = grid.sample(40.5 + 9.0 / 60.0, -100.5, 10000.0);
+    EXPECT_TRUE(edge.any());
+    EXPECT_LT(edge.intensity, centre.intensity);
+
+    std::vector<uint32_t> ids;
+    grid.hazardsAt(40.5, -100.5, 10000.0, ids);
+    ASSERT_EQ(ids.size(), 1u);
+    EXPECT_EQ(ids[0], 7u);
+    EXPECT_EQ(grid.getHazard(7)->description, "Cell");
+
+    // No vertical extent means every altitude
+    ASSERT_TRUE(grid.setHazard(8, makeCell(40.5, -100.5, 5.0, 0.0, 0.0, WeatherHazardType::MICROBURST)));
+    EXPECT_TRUE(grid.sample(40.5, -100.5, 45000.0).has(WeatherHazardType::MICROBURST));
+    EXPECT_TRUE(grid.sample(40.5, -100.5, 10000.0).has(WeatherHazardType::THUNDERSTORM));
+
+    EXPECT_FALSE(grid.setHazard(9, makeCell(40.5, -100.5, 0.0)));
+    EXPECT_FALSE(grid.setHazard(9, makeCell(std::nan(""), -100.5, 10.0)));
+    EXPECT_FALSE(grid.setHazard(9, makeCell(40.5, -100.5, HazardGrid::MAX_RADIUS_NM + 1.0)));
+    EXPECT_FALSE(grid.contains(9));
+    EXPECT_FALSE(grid.sample(std::nan(""), 0.0, 0.0).any());
+}
+
+// Test: Moving or removing a cell re-rasterizes only what it covered
+TEST(HazardGridTest, CellsMoveIncrementally) {
+    HazardGrid grid;
+    ASSERT_TRUE(grid.setHazard(1, makeCell(40.5, -100.5, 10.0)));
+    ASSERT_TRUE(grid.setHazard(2, makeCell(30.5, -90.5, 10.0)));
+    EXPECT_EQ(grid.tileCount(), 2u);
+
+    ASSERT_TRUE(grid.setHazard(1, makeCell(40.5, -99.5, 10.0)));
+    EXPECT_FALSE(grid.sample(40.5, -100.5, 10000.0).any());
+    EXPECT_TRUE(grid.sample(40.5, -99.5, 10000.0).any());
+    EXPECT_TRUE(grid.sample(30.5, -90.5, 10000.0).any());
+    EXPECT_EQ(grid.tileCount(), 2u);
+
+    // A cell that grows past its tile spreads to the neighbours
+    ASSERT_TRUE(grid.setHazard(1, makeCell(40.5, -99.5, 40.0)));
+    EXPECT_EQ(grid.tileCount(), 1u + 9u);
+    EXPECT_TRUE(grid.sample(40.5, -98.9, 10000.0).any());
+
+    // Failing to place a hazard drops the old one
+    EXPECT_FALSE(grid.setHazard(2, makeCell(30.5, -90.5, -1.0)));
+    EXPECT_FALSE(grid.sample(30.5, -90.5, 10000.0).any());
+    EXPECT_TRUE(grid.removeHazard(1));
+    EXPECT_FALSE(grid.removeHazard(1));
+    EXPECT_EQ(grid.tileCount(), 0u);
+
+    // assign() keeps hazards by index and drops the rest
+    std::vector<WeatherHazard> hazards = {makeCell(10.5, 10.5, 5.0), makeCell(11.5, 10.5, 5.0)};
+    EXPECT_EQ(grid.assign(hazards), 2u);
+    hazards.pop_back();
+    hazards[0].position.latitude = 12.5;
+    EXPECT_EQ(grid.assign(hazards), 1u);
+    EXPECT_EQ(grid.hazardCount(), 1u);
+    EXPECT_TRUE(grid.sample(12.5, 10.5, 10000.0).any());
+    EXPECT_FALSE(grid.sample(11.5, 10.5, 10000.0).any());
+    EXPECT_FALSE(grid.sample(10.5, 10.5, 10000.0).any());
+}
+
+// Test: Segment walks find exactly the hazards a leg passes through
+TEST(HazardGridTest, SegmentWalksMatchBruteForce) {
+    HazardGrid grid;
+    std::vector<WeatherHazard> hazards;
+    uint32_t seed = 12345;
+    auto next = [&](double low, double high) {
+        seed = seed * 1664525u + 1013904223u;
+        return low + (high - low) * (seed >> 8) / 16777216.0;
+    };
+    for (int i = 0; i < 40; ++i) {
+        hazards.push_back(makeCell(next(35.0, 45.0), next(-105.0, -95.0), next(2.0, 40.0), 0.0, 20000.0));
+    }
+    ASSERT_EQ(grid.assign(hazards), hazards.size());
+
+    std::vector<uint32_t> ids;
+    for (int leg = 0; leg < 60; ++leg) {
+        Position a = at(next(35.0, 45.0), next(-105.0, -95.0));
+        Position b = at(next(35.0, 45.0), next(-105.0, -95.0));
+        grid.hazardsAlongSegment(a, b, 10000.0, ids);
+        bool any = false;
+        for (uint32_t i = 0; i < hazards.size(); ++i) {
+            double approach = closestApproachNM(hazards[i], a, b);
+            bool listed = std::find(ids.begin(), ids.end(), i) != ids.end();
+            if (std::abs(approach - hazards[i].radius) > 0.5) {
+                EXPECT_EQ(listed, approach < hazards[i].radius) << "leg " << leg << " hazard " << i;
+            }
+            any = any || listed;
+        }
+        if (any) {
+            EXPECT_TRUE(grid.sampleSegment(a, b, 10000.0).any()) << "leg " << leg;
+        }
+    }
+
+    // Above every top nothing is in the way
+    grid.hazardsAlongSegment(at(35.0, -105.0), at(45.0, -95.0), 30000.0, ids);
+    EXPECT_TRUE(ids.empty());
+    EXPECT_FALSE(grid.sampleSegment(at(35.0, -105.0), at(45.0, -95.0), 30000.0).any());
+}
+
+// Test: WeatherSystem answers point, shear, radar and route queries from the grid
+TEST(HazardGridTest, WeatherSystemQueriesGrid) {
+    auto grid = std::make_shared<HazardGrid>();
+    grid->setHazard(1, makeCell(40.5, -100.5, 10.0));
+    grid->setHazard(2, makeCell(39.5, -100.5, 3.0, 0.0, 2000.0, WeatherHazardType::WIND_SHEAR,
+                                HazardSeverity::MODERATE));
+
+    WeatherSystem weather;
+    Position storm = at(40.5, -100.5);
+    Position field = at(39.5, -100.5);
+    EXPECT_FALSE(weather.hasWeatherHazard(storm, 10000.0));
+    weather.setHazardGrid(grid);
+    EXPECT_TRUE(weather.hasWeatherHazard(storm, 10000.0));
+    EXPECT_FALSE(weather.hasWeatherHazard(storm, 35000.0));
+    EXPECT_EQ(weather.getWeatherHazard(storm, 10000.0).type, WeatherHazardType::THUNDERSTORM);
+    EXPECT_TRUE(weather.hasWindShear(field, 500.0));
+    EXPECT_FALSE(weather.hasWindShear(storm, 500.0));
+
+    // The storm shows on radar; the shear doesn't
+    std::vector<WeatherRadarReturn> returns = weather.getRadarReturns(field, 80.0);
+    ASSERT_FALSE(returns.empty());
+    for (const WeatherRadarReturn& ret : returns) {
+        EXPECT_NEAR(ret.position.latitude, 40.5, 0.25);
+        EXPECT_GT(ret.intensity, 0.0);
+        EXPECT_EQ(ret.altitude, 4000.0);
+        EXPECT_EQ(ret.topHeight, 32000.0);
+    }
+    EXPECT_TRUE(weather.getRadarReturns(field, 30.0).empty());
+
+    std::vector<WeatherHazard> route = weather.detectHazardsAlongRoute(field, at(41.5, -100.5), 10000.0);
+    ASSERT_EQ(route.size(), 1u);
+    EXPECT_EQ(route[0].type, WeatherHazardType::THUNDERSTORM);
+    EXPECT_TRUE(weather.detectHazardsAlongRoute(field, at(39.5, -99.0), 10000.0).empty());
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "../../include/hdr_histogram.hpp"
+#include "../../include/system_monitor.hpp"
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+// Test: Every value lands in a bucket no wider than about 3% of it
+TEST(HdrHistogramTest, BucketsKeepRelativePrecision) {
+    size_t previous = 0;
+    for (uint64_t us = 1; us < HdrLayout::MAX_VALUE_US; us = us * 3 / 2 + 1) {
+        size_t bucket = HdrLayout::bucketOf(us);
+        ASSERT_LT(bucket, HdrLayout::BUCKETS);
+        EXPECT_GE(bucket, previous);
+        uint64_t upper = HdrLayout::bucketUpperUs(bucket);
+        EXPECT_GE(upper, us);
+        EXPECT_LE(static_cast<double>(upper - us), us / 32.0 + 1.0);
+        previous = bucket;
+    }
+    EXPECT_EQ(HdrLayout::bucketOf(HdrLayout::MAX_VALUE_US), HdrLayout::BUCKETS - 1);
+    EXPECT_EQ(HdrLayout::bucketOf(HdrLayout::MAX_VALUE_US * 4), HdrLayout::BUCKETS - 1);
+}
+
+// Test: Percentiles of a uniform run stay within 3%, and merging adds histograms
+TEST(HdrHistogramTest, PercentilesAndMerge) {
+    HdrHistogram low, high;
+    for (int i = 1; i <= 1000; ++i) {
+        (i <= 500 ? low : high).record(i * 0.1);   // 0.1 ms .. 100 ms
+    }
+    low.merge(high);
+    EXPECT_EQ(low.count(), 1000u);
+    EXPECT_NEAR(low.percentileMs(0.50), 50.0, 50.0 * 0.03);
+    EXPECT_NEAR(low.percentileMs(0.95), 95.0, 95.0 * 0.03);
+    EXPECT_NEAR(low.percentileMs(0.99), 99.0, 99.0 * 0.03);
+    EXPECT_DOUBLE_EQ(low.percentileMs(1.0), 100.0);
+    EXPECT_DOUBLE_EQ(low.minMs(), 0.1);
+    EXPECT_NEAR(low.meanMs(), 50.05, 0.01);
+
+    HdrHistogram empty;
+    EXPECT_EQ(empty.percentileMs(0.99), 0.0);
+}
+
+// Test: Threads record without locks and the snapshot sees every sample
+TEST(HdrHistogramTest, ConcurrentRecording) {
+    ConcurrentHdrHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&histogram, t] {
+            for (int i = 0; i < 5000; ++i) histogram.record(1.0 + t);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    HdrHistogram merged = histogram.snapshot();
+    EXPECT_EQ(histogram.count(), 40000u);
+    EXPECT_EQ(merged.count(), 40000u);
+    EXPECT_DOUBLE_EQ(merged.minMs(), 1.0);
+    EXPECT_DOUBLE_EQ(merged.maxMs(), 8.0);
+    EXPECT_NEAR(merged.meanMs(), 4.5, 1e-9);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.snapshot().count(), 0u);
+}
+
+// Test: SystemMonitor profiles come from the histogram and trends stay in order
+TEST(HdrHistogramTest, SystemMonitorProfileAndTrend) {
+    SystemMonitor monitor;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&monitor] {
+            for (int i = 1; i <= 250; ++i) {
+                monitor.recordQueryLatency(SystemComponent::TERRAIN_AWARENESS, i * 0.4);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    PerformanceProfile profile = monitor.getComponentPerformanceProfile(SystemComponent::TERRAIN_AWARENESS);
+    EXPECT_NEAR(profile.p99Latency, 99.0, 99.0 * 0.03);
+    EXPECT_NEAR(profile.p95Latency, 95.0, 95.0 * 0.03);
+    EXPECT_DOUBLE_EQ(profile.maxLatency, 100.0);
+    EXPECT_EQ(profile.operationsPerSecond, 1000u);
+    EXPECT_EQ(monitor.getComponentHealth(SystemComponent::TERRAIN_AWARENESS).queryCount, 1000u);
+    EXPECT_EQ(monitor.getLatencyHistogram(SystemComponent::TERRAIN_AWARENESS).count(), 1000u);
+
+    // Only the most recent samples are kept, oldest first
+    SystemMonitor trending;
+    for (int i = 0; i < 700; ++i) {
+        trending.recordQueryLatency(SystemComponent::WEATHER_SYSTEM, i);
+    }
+    auto trend = trending.getPerformanceTrend(SystemComponent::WEATHER_SYSTEM);
+    ASSERT_EQ(trend.latencyOverTime.size(), 600u);
+    EXPECT_EQ(trend.latencyOverTime.front(), 100.0);
+    EXPECT_EQ(trend.latencyOverTime.back(), 699.0);
+    EXPECT_TRUE(trend.isDegrading);
+}
@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include "../../include/headless_sim.hpp"
+#include "../../include/ai_pilot.h"
+#include "../../include/simconnect_recording.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+HeadlessSimConfig airborneConfig() {
+    HeadlessSimConfig config;
+    config.start = {47.0, -122.0, 5000.0, 0.0};
+    config.startOnGround = false;
+    return config;
+}
+
+double headingError(double a, double b) {
+    double diff = std::fmod(a - b + 540.0, 360.0) - 180.0;
+    return std::abs(diff);
+}
+
+void run(HeadlessSimConnect& sim, double seconds) {
+    int steps = static_cast<int>(std::lround(seconds * 30.0));
+    for (int i = 0; i < steps; ++i) {
+        sim.processMessages();
+    }
+}
+
+} // namespace
+
+// Test: Full power and back pressure lift off past Vr and climb within the profile's rate
+TEST(HeadlessSimTest, TakesOffAndClimbs) {
+    HeadlessSimConfig config;
+    config.start = {47.45, -122.3, 430.0, 160.0};
+    config.performance.vr = 60.0;
+    config.performance.climbRate = 800.0;
+    HeadlessSimConnect sim(config);
+    ASSERT_TRUE(sim.connect(SimulatorType::UNKNOWN));
+
+    sim.setThrottle(1.0);
+    run(sim, 5.0);
+    EXPECT_TRUE(sim.getAircraftState().onGround);
+    EXPECT_GT(sim.getAircraftState().groundSpeed, 5.0);
+
+    sim.setElevator(0.3);
+    bool liftedOffBelowVr = false;
+    for (int i = 0; i < 30 * 90; ++i) {
+        bool wasOnGround = sim.getAircraftState().onGround;
+        double speed = sim.getAircraftState().indicatedAirspeed;
+        sim.processMessages();
+        if (wasOnGround && !sim.getAircraftState().onGround && speed < 59.0) liftedOffBelowVr = true;
+    }
+
+    AircraftState state = sim.getAircraftState();
+    EXPECT_FALSE(liftedOffBelowVr);
+    EXPECT_FALSE(state.onGround);
+    EXPECT_GT(state.position.altitude, 430.0 + 300.0);
+    EXPECT_LE(state.verticalSpeed, 800.0 + 1e-6);
+    EXPECT_LT(state.fuelQuantity, sim.getModel().getPerformance().fuelCapacity);
+    EXPECT_NEAR(sim.getReplayTime(), 95.0, 1e-6);
+}
+
+// Test: The autopilot captures its heading, altitude and speed targets
+TEST(HeadlessSimTest, AutopilotCapturesTargets) {
+    HeadlessSimConnect sim(airborneConfig());
+    sim.connect(SimulatorType::UNKNOWN);
+    sim.setAutopilotHeading(90.0);
+    sim.setAutopilotAltitude(6000.0);
+    sim.setAutopilotSpeed(100.0);
+    sim.setAutopilotMaster(true);
+    EXPECT_TRUE(sim.getAutopilotState().altitudeHold);
+
+    run(sim, 240.0);
+    AircraftState state = sim.getAircraftState();
+    EXPECT_LT(headingError(state.heading, 90.0), 1.0);
+    EXPECT_NEAR(state.position.altitude, 6000.0, 20.0);
+    EXPECT_NEAR(state.indicatedAirspeed, 100.0, 1.0);
+    EXPECT_NEAR(state.bank, 0.0, 1.0);
+    EXPECT_GT(state.position.longitude, -122.0);   // turned east
+}
+
+// Test: A crosswind drifts the ground track; identical inputs give identical runs
+TEST(HeadlessSimTest, WindDriftIsDeterministic) {
+    HeadlessSimConfig config = airborneConfig();
+    config.windDirection = 270.0;   // from the west
+    config.windSpeed = 30.0;
+    HeadlessSimConnect a(config);
+    HeadlessSimConnect b(config);
+    a.connect(SimulatorType::UNKNOWN);
+    b.connect(SimulatorType::UNKNOWN);
+    a.setAutopilotMaster(true);
+    b.setAutopilotMaster(true);
+    run(a, 60.0);
+    run(b, 60.0);
+
+    AircraftState sa = a.getAircraftState();
+    AircraftState sb = b.getAircraftState();
+    EXPECT_GT(sa.position.longitude, -122.0 + 0.001);   // pushed east while heading north
+    EXPECT_GT(sa.groundSpeed, sa.trueAirspeed);
+    EXPECT_EQ(std::memcmp(&sa.position, &sb.position, sizeof(Position)), 0);
+    EXPECT_EQ(sa.fuelQuantity, sb.fuelQuantity);
+}
+
+// Test: Many aircraft on one thread run far faster than real time
+TEST(HeadlessSimTest, RunsManyAircraftInFastTime) {
+    const size_t aircraftCount = 64;
+    const double simSeconds = 300.0;
+    std::vector<std::unique_ptr<HeadlessSimConnect>> fleet;
+    for (size_t i = 0; i < aircraftCount; ++i) {
+        HeadlessSimConfig config = airborneConfig();
+        config.windDirection = static_cast<double>(i * 360 / aircraftCount);
+        config.windSpeed = 10.0 + i % 20;
+        fleet.push_back(std::make_unique<HeadlessSimConnect>(config));
+        fleet.back()->connect(SimulatorType::UNKNOWN);
+        fleet.back()->setAutopilotHeading(static_cast<double>(i * 5));
+        fleet.back()->setAutopilotMaster(true);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int step = 0; step < static_cast<int>(simSeconds * 30.0); ++step) {
+        for (auto& sim : fleet) sim->processMessages();
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_GT(simSeconds * aircraftCount / std::max(wallSeconds, 1e-9), 100.0 * aircraftCount);
+    for (size_t i = 0; i < aircraftCount; ++i) {
+        EXPECT_NEAR(fleet[i]->getReplayTime(), simSeconds, 1e-6);
+        EXPECT_EQ(fleet[i]->getStepCount(), 9000u);
+    }
+}
+
+// Test: Recording writes SIMOBJECT_DATA records per tier, timestamped in sim time
+TEST(HeadlessSimTest, RecordsCaptureFormat) {
+    auto path = (std::filesystem::temp_directory_path() / "aicopilot_headless.aicpscap").string();
+    HeadlessSimConnect sim(airborneConfig());
+    sim.connect(SimulatorType::UNKNOWN);
+    ASSERT_TRUE(sim.startRecording(path));
+    EXPECT_TRUE(sim.isRecording());
+    run(sim, 2.0);
+    sim.stopRecording();
+    EXPECT_FALSE(sim.isRecording());
+
+    SimConnectCaptureReader reader;
+    ASSERT_TRUE(reader.open(path));
+    size_t flightRecords = 0;
+    size_t systemsRecords = 0;
+    size_t engineRecords = 0;
+    uint64_t lastTimestamp = 0;
+    SimConnectFlightData lastFlight{};
+    while (reader.hasRecord()) {
+        ASSERT_GE(reader.size(), sizeof(SimConnectObjectDataHeader));
+        SimConnectObjectDataHeader header;
+        std::memcpy(&header, reader.data(), sizeof(header));
+        EXPECT_EQ(header.id, SimConnectCaptureFormat::RECV_ID_SIMOBJECT_DATA);
+        EXPECT_EQ(header.size, reader.size());
+        EXPECT_EQ(header.flags, 0u);
+        EXPECT_GE(reader.timestampUs(), lastTimestamp);
+        lastTimestamp = reader.timestampUs();
+
+        if (header.requestId == SimConnectCaptureFormat::REQUEST_FLIGHT_DYNAMICS) {
+            ASSERT_EQ(reader.size(), sizeof(header) + sizeof(SimConnectFlightData));
+            std::memcpy(&lastFlight, reader.data() + sizeof(header), sizeof(lastFlight));
+            flightRecords++;
+        } else if (header.requestId == SimConnectCaptureFormat::REQUEST_SYSTEMS_STATE) {
+            systemsRecords++;
+        } else if (header.requestId == SimConnectCaptureFormat::REQUEST_ENGINE_STATE) {
+            engineRecords++;
+        }
+        reader.next();
+    }
+    reader.close();
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(flightRecords, 61u);   // baseline plus one per step
+    EXPECT_EQ(systemsRecords, 1u + 60 / HeadlessSimConnect::SYSTEMS_INTERVAL_STEPS);
+    EXPECT_EQ(engineRecords, 1u + 60 / HeadlessSimConnect::ENGINE_INTERVAL_STEPS);
+    EXPECT_EQ(lastTimestamp, 2000000u);
+    AircraftState state = sim.getAircraftState();
+    EXPECT_DOUBLE_EQ(lastFlight.latitude, state.position.latitude);
+    EXPECT_DOUBLE_EQ(lastFlight.altitude, state.position.altitude);
+    EXPECT_EQ(lastFlight.onGround, 0u);
+}
+
+// Test: The headless backend stands in for the wrapper behind a base pointer
+TEST(HeadlessSimTest, ServesTheWrapperInterface) {
+    std::shared_ptr<SimConnectWrapper> sim = std::make_shared<HeadlessSimConnect>(airborneConfig());
+    EXPECT_FALSE(sim->isConnected());
+    EXPECT_TRUE(sim->connect(SimulatorType::UNKNOWN));
+    EXPECT_FALSE(sim->startDispatchThread());
+    EXPECT_FALSE(sim->connectReplay("/nonexistent.aicpscap"));
+
+    int callbacks = 0;
+    sim->subscribeToAircraftState([&](const AircraftState&) { callbacks++; });
+    sim->setReplayStep(0.5);
+    sim->processMessages();
+    sim->processMessages();
+    EXPECT_EQ(callbacks, 2);
+    EXPECT_DOUBLE_EQ(sim->getReplayTime(), 1.0);
+
+    sim->disconnect();
+    sim->processMessages();
+    EXPECT_EQ(callbacks, 2);
+}
+
+// Test: An AIPilot flies the headless model in fast time, one control period per update()
+TEST(HeadlessSimTest, DrivesAIPilotInFastTime) {
+    auto cfgPath = (std::filesystem::temp_directory_path() / "aicopilot_headless_aircraft.cfg").string();
+    {
+        std::ofstream out(cfgPath);
+        out << "[GENERAL]\natc_model=C172\n"
+            << "[REFERENCE SPEEDS]\ncruise_speed=120\nstall_speed=48\nmax_indicated_speed=160\n"
+            << "[GENERALENGINEDATA]\nengine_type=1\n[FUEL]\nfuel_capacity=53\n";
+    }
+
+    AIPilot pilot;
+    ASSERT_TRUE(pilot.initializeHeadless(airborneConfig()));
+    ASSERT_TRUE(pilot.loadAircraftConfig(cfgPath));
+    pilot.startAutonomousFlight();
+
+    const double simSeconds = 600.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < static_cast<int>(simSeconds * AIPilot::CONTROL_RATE_HZ); ++i) {
+        pilot.update();
+    }
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    pilot.stopAutonomousFlight();
+
+    // With no flight plan the climb targets 10000 ft at the profile's rate
+    PilotCheckpointBuilder builder;
+    pilot.captureCheckpoint(builder);
+    EXPECT_GT(builder.state().altitude, 5000.0 + 2000.0);
+    EXPECT_LE(builder.state().altitude, 10000.0 + 20.0);
+    EXPECT_LT(wallSeconds, simSeconds / 100.0);
+    std::filesystem::remove(cfgPath);
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "../../include/helicopter_operations.h"
+#include <cmath>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr double FEET_PER_DEGREE = 60.0 * 6076.12;
+constexpr double BASE_LATITUDE = 40.0;
+constexpr double BASE_LONGITUDE = -74.0;
+
+HelicopterData helicopter() {
+    HelicopterData data{};
+    data.hoverCeiling = 10000.0;
+    data.maxVerticalSpeed = 1500.0;
+    data.cruiseSpeed = 110.0;
+    data.autorotationSpeed = 65.0;
+    data.normalRotorRPM = 400.0;
+    return data;
+}
+
+// Hovering state north and east of the base point, in feet
+AircraftState hoverState(double north, double east, double altitude) {
+    AircraftState state{};
+    state.position.latitude = BASE_LATITUDE + north / FEET_PER_DEGREE;
+    state.position.longitude = BASE_LONGITUDE +
+        east / (FEET_PER_DEGREE * std::cos(BASE_LATITUDE * 3.14159265358979323846 / 180.0));
+    state.position.altitude = altitude;
+    state.engineRPM = 400.0;
+    return state;
+}
+
+// Point-mass rotorcraft: cyclic accelerates horizontally, collective above
+// hover trim climbs
+struct PointMass {
+    double north = 0.0, east = 0.0, altitude = 0.0;   // feet
+    double vNorth = 0.0, vEast = 0.0, vUp = 0.0;      // feet per second
+
+    void step(const RotorcraftControl& control, double dt) {
+        vNorth += control.cyclicLongitudinal * 20.0 * dt;
+        vEast += control.cyclicLateral * 20.0 * dt;
+        vUp += (control.collective - 0.65) * 32.0 * dt;
+        north += vNorth * dt;
+        east += vEast * dt;
+        altitude += vUp * dt;
+    }
+
+    AircraftState state() const {
+        AircraftState s = hoverState(north, east, altitude);
+        s.verticalSpeed = vUp * 60.0;
+        s.groundSpeed = std::hypot(vNorth, vEast) / 1.68781;
+        return s;
+    }
+};
+
+} // namespace
+
+// Test: The fast path runs only in the modes it flies
+TEST(HelicopterOperationsTest, FastControlOnlyInRotorModes) {
+    HelicopterOperations ops;
+    ops.initialize(helicopter());
+    EXPECT_FALSE(ops.needsFastControl());
+
+    ops.initiateHover(50.0);
+    EXPECT_TRUE(ops.needsFastControl());
+    ops.transitionToForwardFlight(60.0);
+    EXPECT_FALSE(ops.needsFastControl());
+
+    RotorcraftControl control = ops.runFastControl(hoverState(0.0, 0.0, 50.0), 0.01);
+    EXPECT_DOUBLE_EQ(control.collective, 0.0);
+    EXPECT_EQ(ops.getHoverQuality().samples, 0u);
+}
+
+// Test: Controls push back toward the hold point and target height
+TEST(HelicopterOperationsTest, HoverCorrectsTowardHoldPoint) {
+    HelicopterOperations ops;
+    ops.initialize(helicopter());
+    ops.initiateHover(50.0);
+    ops.performStationKeeping(hoverState(0.0, 0.0, 0.0).position);
+
+    // 40 ft north and 20 ft east of the station, heading north, 10 ft low
+    RotorcraftControl control = ops.runFastControl(hoverState(40.0, 20.0, 40.0), 0.01);
+    EXPECT_LT(control.cyclicLongitudinal, 0.0);
+    EXPECT_LT(control.cyclicLateral, 0.0);
+    EXPECT_GT(control.collective, 0.6);
+    EXPECT_LE(std::abs(control.cyclicLongitudinal), 0.3);
+
+    // Facing south the same error needs forward cyclic
+    AircraftState south = hoverState(40.0, 20.0, 40.0);
+    south.heading = 180.0;
+    control = ops.runFastControl(south, 0.01);
+    EXPECT_GT(control.cyclicLongitudinal, 0.0);
+    EXPECT_GT(control.cyclicLateral, 0.0);
+}
+
+// Test: A closed loop at the rotorcraft rate settles onto the hold point
+TEST(HelicopterOperationsTest, ClosedLoopHoverSettles) {
+    HelicopterOperations ops;
+    ops.initialize(helicopter());
+    ops.initiateHover(50.0);
+
+    PointMass aircraft;
+    aircraft.altitude = 50.0;
+    const double dt = 0.01;
+    ops.runFastControl(aircraft.state(), dt);   // captures the hold point
+
+    // Gust, then let it settle for a minute
+    aircraft.vNorth = 8.0;
+    aircraft.vEast = -5.0;
+    aircraft.vUp = -3.0;
+    for (int i = 0; i < 6000; ++i) {
+        aircraft.step(ops.runFastControl(aircraft.state(), dt), dt);
+    }
+
+    EXPECT_LT(std::hypot(aircraft.north, aircraft.east), 2.0);
+    EXPECT_NEAR(aircraft.altitude, 50.0, 1.0);
+
+    const HoverQualityStats& quality = ops.getHoverQuality();
+    EXPECT_EQ(quality.samples, 6001u);
+    EXPECT_GT(quality.maxPositionError, 5.0);
+    EXPECT_LT(quality.rmsPositionError, quality.maxPositionError);
+    EXPECT_GT(quality.stableFraction, 0.5);
+
+    ops.resetHoverQuality();
+    EXPECT_EQ(ops.getHoverQuality().samples, 0u);
+}
+
+// Test: Hover taxi saturates the target error and ends in a hover over it
+TEST(HelicopterOperationsTest, HoverTaxiArrivesAndHolds) {
+    HelicopterOperations ops;
+    ops.initialize(helicopter());
+    ops.initiateHover(30.0);
+    Position target = hoverState(1000.0, 0.0, 30.0).position;
+    ops.initiateHoverTaxi(target, 10.0);
+
+    // Long steps between the jumps keep the drift estimate near zero
+    RotorcraftControl far = ops.runFastControl(hoverState(0.0, 0.0, 30.0), 0.01);
+    RotorcraftControl near = ops.runFastControl(hoverState(900.0, 0.0, 30.0), 1000.0);
+    EXPECT_GT(far.cyclicLongitudinal, 0.0);
+    EXPECT_NEAR(far.cyclicLongitudinal, near.cyclicLongitudinal, 0.01);
+    EXPECT_EQ(ops.getCurrentMode(), HelicopterMode::HOVER_TAXI);
+
+    ops.runFastControl(hoverState(998.0, 0.0, 30.0), 1000.0);
+    EXPECT_EQ(ops.getCurrentMode(), HelicopterMode::HOVER);
+
+    // Now holding over the taxi target, not where the hover began
+    RotorcraftControl hold = ops.runFastControl(hoverState(1010.0, 0.0, 30.0), 1000.0);
+    EXPECT_LT(hold.cyclicLongitudinal, 0.0);
+}
+
+// Test: Autorotation trades cyclic for glide speed and flares low
+TEST(HelicopterOperationsTest, AutorotationHoldsGlideSpeed) {
+    HelicopterOperations ops;
+    ops.initialize(helicopter());
+    ops.initiateAutorotation();
+
+    AircraftState state = hoverState(0.0, 0.0, 1500.0);
+    state.engineRPM = 380.0;
+    state.verticalSpeed = -1700.0;
+    state.indicatedAirspeed = 50.0;
+    RotorcraftControl slow = ops.runFastControl(state, 0.01);
+    EXPECT_GT(slow.cyclicLongitudinal, 0.0);   // nose down to gain speed
+    EXPECT_LE(slow.collective, 0.3);
+
+    state.indicatedAirspeed = 80.0;
+    EXPECT_LT(ops.runFastControl(state, 0.01).cyclicLongitudinal, 0.0);
+
+    state.position.altitude = 40.0;
+    RotorcraftControl flare = ops.runFastControl(state, 0.01);
+    EXPECT_TRUE(ops.getAutorotationState().inFlare);
+    EXPECT_DOUBLE_EQ(flare.cyclicLongitudinal, -0.3);
+    EXPECT_GT(flare.collective, slow.collective);
+}
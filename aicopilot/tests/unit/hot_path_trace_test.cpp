@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "../../include/hot_path_trace.hpp"
+#include "../../include/task_scheduler.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+size_t countOccurrences(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        count++;
+    }
+    return count;
+}
+
+void tracedTick() {
+    HotPathTracer::beginTick();
+    TRACE_SCOPE("test.tick");
+    {
+        TRACE_SCOPE("test.inner");
+    }
+}
+
+} // namespace
+
+// Test: Scopes record only while enabled, and only on sampled ticks
+TEST(HotPathTraceTest, RecordsSampledTicksOnly) {
+    HotPathTracer::disable();
+    HotPathTracer::clear();
+    tracedTick();
+    EXPECT_EQ(countOccurrences(HotPathTracer::exportChromeTrace(), "\"test.tick\""), 0u);
+
+    HotPathTracer::enable(4);
+    for (int i = 0; i < 8; ++i) tracedTick();
+    HotPathTracer::disable();
+
+    std::string trace = HotPathTracer::exportChromeTrace();
+#ifdef AICOPILOT_ENABLE_TRACING
+    EXPECT_EQ(countOccurrences(trace, "\"test.tick\""), 2u);
+    EXPECT_EQ(countOccurrences(trace, "\"test.inner\""), 2u);
+    EXPECT_NE(trace.find("\"ph\":\"X\""), std::string::npos);
+#else
+    EXPECT_EQ(countOccurrences(trace, "\"test.tick\""), 0u);
+#endif
+    EXPECT_EQ(trace.compare(0, 15, "{\"traceEvents\":"), 0);
+
+    HotPathTracer::clear();
+    EXPECT_EQ(countOccurrences(HotPathTracer::exportChromeTrace(), "\"test.tick\""), 0u);
+}
+
+// Test: Each thread gets its own track, named and escaped in the export
+TEST(HotPathTraceTest, ExportsPerThreadTracks) {
+    HotPathTracer::clear();
+    HotPathTracer::enable();
+    HotPathTracer::beginTick();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([t] {
+            HotPathTracer::setThreadName("worker \"" + std::to_string(t) + "\"");
+            for (int i = 0; i < 100; ++i) {
+                uint64_t start = HotPathTracer::nowNs();
+                HotPathTracer::record("test.worker", start, start + 1500);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    HotPathTracer::disable();
+
+    std::string trace = HotPathTracer::exportChromeTrace();
+    EXPECT_EQ(countOccurrences(trace, "\"test.worker\""), 300u);
+    EXPECT_NE(trace.find("\"worker \\\"2\\\"\""), std::string::npos);
+    EXPECT_NE(trace.find("\"dur\":1.500"), std::string::npos);
+    HotPathTracer::clear();
+}
+
+// Test: summarize() totals events by name across threads since clear()
+TEST(HotPathTraceTest, SummarizesByName) {
+    HotPathTracer::clear();
+    HotPathTracer::enable();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; ++t) {
+        threads.emplace_back([] {
+            for (uint64_t i = 0; i < 10; ++i) {
+                HotPathTracer::record("test.summary_slow", 100, 100 + 1000 * (i + 1));
+                HotPathTracer::record("test.summary_fast", 100, 150);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    HotPathTracer::disable();
+
+    std::vector<TraceSummary> summary = HotPathTracer::summarize();
+    ASSERT_GE(summary.size(), 2u);
+    EXPECT_STREQ(summary[0].name, "test.summary_slow");
+    EXPECT_EQ(summary[0].count, 20u);
+    EXPECT_EQ(summary[0].totalNs, 2u * 55000u);
+    EXPECT_EQ(summary[0].maxNs, 10000u);
+    EXPECT_STREQ(summary[1].name, "test.summary_fast");
+    EXPECT_EQ(summary[1].count, 20u);
+
+    HotPathTracer::clear();
+    EXPECT_TRUE(HotPathTracer::summarize().empty());
+}
+
+// Test: A wrapped ring keeps the newest events and counts the rest
+TEST(HotPathTraceTest, RingKeepsNewestEvents) {
+    HotPathTracer::clear();
+    std::thread writer([] {
+        const char* oldName = HotPathTracer::intern("test.old");
+        const char* newName = HotPathTracer::intern("test.new");
+        EXPECT_EQ(HotPathTracer::intern(std::string("test.old")), oldName);
+        for (size_t i = 0; i < 10; ++i) HotPathTracer::record(oldName, 1 + i, 2 + i);
+        for (size_t i = 0; i < HotPathTracer::RING_EVENTS; ++i) HotPathTracer::record(newName, 1 + i, 2 + i);
+    });
+    writer.join();
+
+    std::string trace = HotPathTracer::exportChromeTrace();
+    EXPECT_EQ(countOccurrences(trace, "\"test.old\""), 0u);
+    EXPECT_EQ(countOccurrences(trace, "\"test.new\""), HotPathTracer::RING_EVENTS);
+    EXPECT_EQ(HotPathTracer::overwrittenEvents(), 10u);
+    HotPathTracer::clear();
+    EXPECT_EQ(HotPathTracer::overwrittenEvents(), 0u);
+}
+
+// Test: Scheduler tasks show up under their names while tracing
+TEST(HotPathTraceTest, SchedulerTasksAreTraced) {
+    HotPathTracer::clear();
+    TaskScheduler scheduler(1);
+    scheduler.addTask("test.inline_task", 100.0, [] {});
+    scheduler.addTask("test.worker_task", 100.0, [] {}, TaskExecution::WORKER);
+
+    HotPathTracer::enable();
+    HotPathTracer::beginTick();
+    scheduler.tick();
+    scheduler.waitForWorkers();
+    HotPathTracer::disable();
+
+    std::string trace = HotPathTracer::exportChromeTrace();
+#ifdef AICOPILOT_ENABLE_TRACING
+    EXPECT_EQ(countOccurrences(trace, "\"test.inline_task\""), 1u);
+    EXPECT_EQ(countOccurrences(trace, "\"test.worker_task\""), 1u);
+    EXPECT_NE(trace.find("\"scheduler worker\""), std::string::npos);
+#endif
+    HotPathTracer::clear();
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include "../../include/incremental_route_planner.hpp"
+#include "../../include/dynamic_flight_planning.hpp"
+#include <cmath>
+#include <queue>
+#include <random>
+
+using namespace AICopilot;
+
+namespace {
+
+struct Graph {
+    std::vector<std::pair<double, double>> points;
+    std::vector<std::tuple<uint32_t, uint32_t, double>> edges;
+};
+
+// Points on a plane, each joined both ways to a few near neighbours; every
+// cost is at least the straight-line distance
+Graph makeGraph(unsigned seed, int nodeCount) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coord(0.0, 100.0), stretch(1.0, 1.5);
+    Graph graph;
+    for (int i = 0; i < nodeCount; ++i) graph.points.push_back({coord(rng), coord(rng)});
+    for (int i = 0; i < nodeCount; ++i) {
+        std::vector<std::pair<double, int>> near;
+        for (int j = 0; j < nodeCount; ++j) {
+            if (j == i) continue;
+            near.push_back({std::hypot(graph.points[i].first - graph.points[j].first,
+                                       graph.points[i].second - graph.points[j].second), j});
+        }
+        std::sort(near.begin(), near.end());
+        for (int k = 0; k < 4; ++k) {
+            graph.edges.emplace_back(i, near[k].second, near[k].first * stretch(rng));
+            graph.edges.emplace_back(near[k].second, i, near[k].first * stretch(rng));
+        }
+    }
+    return graph;
+}
+
+double dijkstra(const Graph& graph, const std::vector<double>& costs, uint32_t start, uint32_t goal) {
+    std::vector<double> dist(graph.points.size(), IncrementalRoutePlanner::INFINITE_COST);
+    using Item = std::pair<double, uint32_t>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> queue;
+    dist[start] = 0.0;
+    queue.push({0.0, start});
+    while (!queue.empty()) {
+        auto [d, node] = queue.top();
+        queue.pop();
+        if (d > dist[node]) continue;
+        for (size_t e = 0; e < graph.edges.size(); ++e) {
+            if (std::get<0>(graph.edges[e]) != node) continue;
+            uint32_t to = std::get<1>(graph.edges[e]);
+            if (d + costs[e] < dist[to]) {
+                dist[to] = d + costs[e];
+                queue.push({dist[to], to});
+            }
+        }
+    }
+    return dist[goal];
+}
+
+PerformanceProfile makeProfile() {
+    PerformanceProfile profile{};
+    profile.cruiseSpeed = 120.0;
+    profile.serviceCeiling = 15000.0;
+    profile.fuelFlow = 10.0;
+    profile.climbRate = 700.0;
+    return profile;
+}
+
+Waypoint makeFix(const std::string& id, double lat, double lon) {
+    Waypoint fix;
+    fix.id = id;
+    fix.position.latitude = lat;
+    fix.position.longitude = lon;
+    return fix;
+}
+
+} // namespace
+
+// Test: Repaired results match a fresh Dijkstra while costs change and the start moves
+TEST(IncrementalRoutePlannerTest, MatchesDijkstraAfterChanges) {
+    Graph graph = makeGraph(4, 300);
+    IncrementalRoutePlanner planner;
+    for (size_t i = 0; i < graph.points.size(); ++i) planner.addNode();
+    std::vector<double> costs;
+    for (const auto& [from, to, cost] : graph.edges) {
+        planner.addEdge(from, to, cost);
+        costs.push_back(cost);
+    }
+    planner.setHeuristic([&](uint32_t a, uint32_t b) {
+        return std::hypot(graph.points[a].first - graph.points[b].first,
+                          graph.points[a].second - graph.points[b].second);
+    });
+
+    const uint32_t goal = 17;
+    planner.setGoal(goal);
+    std::vector<uint32_t> path;
+    uint32_t start = 230;
+    double cost = planner.findPath(start, path);
+    ASSERT_NEAR(cost, dijkstra(graph, costs, start, goal), 1e-9);
+    const size_t fullExpansions = planner.getExpandedCount();
+
+    std::mt19937 rng(21);
+    std::uniform_int_distribution<size_t> pickEdge(0, costs.size() - 1);
+    std::uniform_real_distribution<double> factor(0.8, 3.0);
+    size_t repairExpansions = 0;
+    for (int round = 0; round < 40; ++round) {
+        for (int k = 0; k < 5; ++k) {
+            size_t e = pickEdge(rng);
+            const auto& a = graph.points[std::get<0>(graph.edges[e])];
+            const auto& b = graph.points[std::get<1>(graph.edges[e])];
+            double straight = std::hypot(a.first - b.first, a.second - b.second);
+            costs[e] = round % 7 == 3 ? IncrementalRoutePlanner::INFINITE_COST
+                                      : std::max(straight, costs[e] * factor(rng));
+            planner.updateEdgeCost(static_cast<uint32_t>(e), costs[e]);
+        }
+        // Move one step along the current path, like an aircraft passing a fix
+        if (path.size() > 2) start = path[1];
+
+        cost = planner.findPath(start, path);
+        ASSERT_NEAR(cost, dijkstra(graph, costs, start, goal), 1e-9) << "round " << round;
+        if (cost != IncrementalRoutePlanner::INFINITE_COST) {
+            ASSERT_EQ(path.front(), start);
+            ASSERT_EQ(path.back(), goal);
+            double total = 0.0;
+            for (size_t i = 1; i < path.size(); ++i) {
+                double leg = IncrementalRoutePlanner::INFINITE_COST;
+                for (size_t e = 0; e < costs.size(); ++e) {
+                    if (std::get<0>(graph.edges[e]) == path[i - 1] && std::get<1>(graph.edges[e]) == path[i]) {
+                        leg = std::min(leg, costs[e]);
+                    }
+                }
+                total += leg;
+            }
+            EXPECT_NEAR(total, cost, 1e-9);
+        }
+        repairExpansions += planner.getExpandedCount();
+    }
+    EXPECT_LT(repairExpansions / 40, fullExpansions);
+}
+
+// Test: Mid-flight re-optimization repairs the kept route around new weather
+TEST(IncrementalRoutePlannerTest, FlightPlanningRepairsRoute) {
+    DynamicFlightPlanning planning;
+    ASSERT_TRUE(planning.initialize(makeProfile()));
+
+    // A zig-zag airway: directs may cut corners but not skip more than two fixes
+    std::vector<Waypoint> route = {makeFix("DEP", 45.0, -122.0), makeFix("A", 45.3, -121.8),
+                                   makeFix("B", 45.6, -122.0), makeFix("C", 45.9, -121.8),
+                                   makeFix("D", 46.2, -122.0), makeFix("DEST", 46.5, -121.8)};
+    auto planned = planning.optimizeRoute(route.front(), route.back(), route, 100.0,
+                                          OptimizationObjective::TIME_OPTIMIZATION);
+    ASSERT_GE(planned.optimizedWaypoints.size(), 3u);
+    EXPECT_EQ(planned.optimizedWaypoints.front().id, "DEP");
+    EXPECT_EQ(planned.optimizedWaypoints.back().id, "DEST");
+    EXPECT_GT(planned.executionTime, 0.0);
+
+    // A cell over C closes every leg through or near it
+    WeatherHazard cell{};
+    cell.position.latitude = 45.9;
+    cell.position.longitude = -121.8;
+    cell.radius = 5.0;
+    Position current;
+    current.latitude = 45.3;
+    current.longitude = -121.8;
+    auto reroute = planning.planWeatherDivert(current, route.back(), {makeFix("ALTN", 45.0, -121.0)}, 100.0, {cell});
+    EXPECT_EQ(reroute.optimizationMethod, "Weather Reroute");
+    ASSERT_GE(reroute.optimizedWaypoints.size(), 2u);
+    EXPECT_EQ(reroute.optimizedWaypoints.front().id, "CURRENT");
+    EXPECT_EQ(reroute.optimizedWaypoints.back().id, "DEST");
+    for (const auto& fix : reroute.optimizedWaypoints) EXPECT_NE(fix.id, "C");
+
+    // A strong headwind slows every leg; the repaired plan reflects it
+    WindConditions wind{};
+    wind.layers.push_back({10000.0, 40.0, 0.0});
+    EXPECT_GT(planning.updateWinds(wind), 0u);
+    auto slower = planning.reoptimizeMidFlight(current, route.back(), 100.0,
+                                               OptimizationObjective::TIME_OPTIMIZATION);
+    EXPECT_EQ(slower.optimizationMethod, "Mid-Flight Re-optimization (incremental)");
+    EXPECT_GT(slower.estimatedTime, reroute.estimatedTime);
+    EXPECT_EQ(planning.updateWinds(wind), 0u);  // no change, nothing to repair
+
+    // Closing the only ways on forces a divert to the alternate
+    cell.radius = 200.0;
+    auto divert = planning.planWeatherDivert(current, route.back(), {makeFix("ALTN", 45.0, -121.0)}, 100.0, {cell});
+    EXPECT_EQ(divert.optimizationMethod, "Weather Divert Route");
+    EXPECT_EQ(divert.optimizedWaypoints.back().id, "ALTN");
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "../../include/io_executor.hpp"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace AICopilot;
+
+TEST(IoExecutorTest, RunsPostedJobs) {
+    IoExecutor executor(2);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 100; ++i) {
+        executor.post([&count] { count++; });
+    }
+    executor.waitIdle();
+
+    EXPECT_EQ(count.load(), 100);
+    IoExecutorStats stats = executor.getStats();
+    EXPECT_EQ(stats.submitted, 100u);
+    EXPECT_EQ(stats.completed, 100u);
+    EXPECT_EQ(stats.queued, 0u);
+    EXPECT_EQ(stats.running, 0u);
+    EXPECT_EQ(stats.threads, 2u);
+}
+
+TEST(IoExecutorTest, ZeroThreadsUsesDefault) {
+    IoExecutor executor(0);
+    EXPECT_EQ(executor.getThreadCount(), IoExecutor::DEFAULT_THREAD_COUNT);
+}
+
+TEST(IoExecutorTest, SubmitDeliversResult) {
+    IoExecutor executor(1);
+    std::future<std::string> future = executor.submit([] { return std::string("N47W122"); });
+    EXPECT_EQ(future.get(), "N47W122");
+}
+
+TEST(IoExecutorTest, SubmitDeliversException) {
+    IoExecutor executor(1);
+    std::future<int> future = executor.submit([]() -> int {
+        throw std::runtime_error("tile missing");
+    });
+    EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(IoExecutorTest, ThrowingPostedJobIsCounted) {
+    IoExecutor executor(1);
+    executor.post([] { throw std::runtime_error("read failed"); });
+    executor.post([] {});
+    executor.waitIdle();
+
+    IoExecutorStats stats = executor.getStats();
+    EXPECT_EQ(stats.completed, 2u);
+    EXPECT_EQ(stats.failed, 1u);
+}
+
+TEST(IoExecutorTest, SingleThreadRunsInOrder) {
+    IoExecutor executor(1);
+    std::vector<int> order;
+    for (int i = 0; i < 10; ++i) {
+        executor.post([&order, i] { order.push_back(i); });
+    }
+    executor.waitIdle();
+
+    ASSERT_EQ(order.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+TEST(IoExecutorTest, DestructorDrainsQueuedJobs) {
+    std::future<int> future;
+    {
+        IoExecutor executor(1);
+        executor.post([] { std::this_thread::sleep_for(std::chrono::milliseconds(20)); });
+        future = executor.submit([] { return 7; });
+    }
+    ASSERT_EQ(future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(future.get(), 7);
+}
+
+TEST(IoExecutorTest, SharedIsOneInstance) {
+    EXPECT_EQ(IoExecutor::shared(), IoExecutor::shared());
+    EXPECT_GT(IoExecutor::shared()->getThreadCount(), 0u);
+}
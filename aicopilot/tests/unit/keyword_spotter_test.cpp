@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include "../../include/keyword_spotter.hpp"
+#include "../../include/audio_kernels.hpp"
+#include "../../include/voice_input.hpp"
+#include <cmath>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// Two-formant vowel-like segments: {first formant, second formant}
+using Segment = std::pair<double, double>;
+
+const std::vector<Segment> WAKE_PHRASE = {{500, 1500}, {800, 1200}, {300, 2400}, {700, 3300}};
+const std::vector<Segment> CHATTER = {{300, 2400}, {500, 1500}, {700, 3300}, {800, 1200}};
+const std::vector<Segment> COMMAND = {{600, 1700}, {400, 1000}, {650, 2000}};
+
+class SignalBuilder {
+public:
+    explicit SignalBuilder(unsigned seed, double noise = 40.0) : rng_(seed), noise_(noise) {}
+
+    void silence(size_t frames) { append(frames, {0, 0}, 0.0); }
+
+    void phrase(const std::vector<Segment>& segments, size_t framesPerSegment, double amplitude) {
+        for (const Segment& segment : segments) append(framesPerSegment, segment, amplitude);
+    }
+
+    std::vector<int16_t> samples;
+
+private:
+    void append(size_t frames, Segment segment, double amplitude) {
+        std::normal_distribution<double> noise(0.0, noise_);
+        for (size_t i = 0; i < frames * AudioFormat::FRAME_SIZE; ++i, ++t_) {
+            double time = static_cast<double>(t_) / AudioFormat::SAMPLE_RATE;
+            double voice = amplitude * (std::sin(2.0 * M_PI * segment.first * time) +
+                                        0.6 * std::sin(2.0 * M_PI * segment.second * time));
+            samples.push_back(AudioKernels::saturate(static_cast<float>(voice + noise(rng_))));
+        }
+    }
+
+    std::mt19937 rng_;
+    double noise_;
+    size_t t_ = 0;
+};
+
+std::vector<int16_t> wakeExample(unsigned seed) {
+    SignalBuilder signal(seed);
+    signal.silence(4);
+    signal.phrase(WAKE_PHRASE, 6, 4000.0);
+    signal.silence(4);
+    return signal.samples;
+}
+
+// Frames of the spotter's input at which it fires
+std::vector<size_t> spot(KeywordSpotter& spotter, std::vector<int16_t> samples) {
+    AudioKernels::preEmphasis(samples.data(), samples.size(), AudioPreprocessor::PRE_EMPHASIS, 0);
+    std::vector<size_t> fired;
+    for (size_t f = 0; f + 1 <= samples.size() / AudioFormat::FRAME_SIZE; ++f) {
+        if (spotter.processFrame(samples.data() + f * AudioFormat::FRAME_SIZE, AudioFormat::FRAME_SIZE)) {
+            fired.push_back(f);
+        }
+    }
+    return fired;
+}
+
+} // namespace
+
+// Test: Features depend on spectral shape, not level
+TEST(KeywordSpotterTest, FeaturesIgnoreLevel) {
+    SignalBuilder quiet(1, 0.0);
+    quiet.phrase({{500, 1500}}, 1, 1000.0);
+    SignalBuilder loud(1, 0.0);
+    loud.phrase({{500, 1500}}, 1, 8000.0);
+    KeywordSpotter::Features a = KeywordSpotter::extractFeatures(quiet.samples.data(), quiet.samples.size());
+    KeywordSpotter::Features b = KeywordSpotter::extractFeatures(loud.samples.data(), loud.samples.size());
+    for (size_t i = 0; i < KeywordSpotter::BANDS; ++i) {
+        EXPECT_NEAR(a[i], b[i], 64) << "band " << i;
+    }
+    // The 500 Hz band stands out of the 4500 Hz one
+    EXPECT_GT(a[1] - a[7], 1024);
+
+    EXPECT_EQ(AudioKernels::log2Q8(0), 0);
+    EXPECT_EQ(AudioKernels::log2Q8(1024), 10 * 256);
+    EXPECT_EQ(AudioKernels::log2Q8(1536), 10 * 256 + 128);
+}
+
+// Test: An enrolled phrase is spotted once, said faster, slower or
+// louder; the same sounds in another order and plain noise are not
+TEST(KeywordSpotterTest, SpotsEnrolledPhraseOnly) {
+    KeywordSpotter spotter;
+    EXPECT_FALSE(spotter.processFrame(std::vector<int16_t>(512, 0).data(), 512));
+    SignalBuilder tooShort(2);
+    tooShort.phrase(WAKE_PHRASE, 0, 4000.0);
+    tooShort.silence(8);
+    EXPECT_FALSE(spotter.enroll(tooShort.samples));
+    ASSERT_TRUE(spotter.enroll(wakeExample(3)));
+    ASSERT_TRUE(spotter.enroll(wakeExample(4)));
+    EXPECT_EQ(spotter.getTemplateCount(), 2u);
+
+    SignalBuilder stream(5);
+    stream.silence(30);
+    stream.phrase(CHATTER, 6, 4000.0);
+    stream.silence(10);
+    stream.phrase(COMMAND, 8, 3000.0);
+    stream.silence(10);
+    size_t wakeStart = stream.samples.size() / AudioFormat::FRAME_SIZE;
+    stream.phrase(WAKE_PHRASE, 8, 9000.0);        // slower and louder
+    stream.silence(10);
+    size_t fastStart = stream.samples.size() / AudioFormat::FRAME_SIZE;
+    stream.phrase(WAKE_PHRASE, 4, 2000.0);        // faster and quieter
+    stream.silence(10);
+
+    std::vector<size_t> fired = spot(spotter, stream.samples);
+    ASSERT_EQ(fired.size(), 2u);
+    EXPECT_GE(fired[0], wakeStart + 24);
+    EXPECT_LE(fired[0], wakeStart + 34);
+    EXPECT_GE(fired[1], fastStart + 12);
+    EXPECT_LE(fired[1], fastStart + 18);
+}
+
+// Test: With a wake stage, only the transmission after the wake phrase
+// reaches the callback, and wakes nothing follows count as false
+TEST(KeywordSpotterTest, VoiceInputGatesOnWake) {
+    VoiceInput input;
+    ASSERT_TRUE(input.initialize());
+    input.startListening();
+    size_t delivered = 0;
+    input.registerVoiceCallback([&delivered](const std::vector<int16_t>&, double) { delivered++; });
+
+    auto spotter = std::make_shared<KeywordSpotter>();
+    ASSERT_TRUE(spotter->enroll(wakeExample(6)));
+    input.setWakeSpotter(spotter);
+
+    SignalBuilder chatter(7);
+    chatter.silence(40);
+    chatter.phrase(CHATTER, 6, 4000.0);
+    chatter.silence(30);
+    input.processAudioData(chatter.samples);
+    EXPECT_EQ(delivered, 0u);
+    EXPECT_FALSE(input.isAwake());
+    VoiceInputStats stats = input.getStatistics();
+    EXPECT_GT(stats.gated_voice_frames, 10u);
+    EXPECT_EQ(stats.wake_detections, 0u);
+
+    // Wake phrase, then a command, then the end of the transmission
+    SignalBuilder command(8);
+    command.phrase(WAKE_PHRASE, 6, 4000.0);
+    command.silence(3);
+    command.phrase(COMMAND, 4, 4000.0);
+    input.processAudioData(command.samples);
+    EXPECT_TRUE(input.isAwake());
+    EXPECT_GE(delivered, 8u);
+    SignalBuilder hangover(9);
+    hangover.silence(VoiceInput::WAKE_HANGOVER_FRAMES + 5);
+    input.processAudioData(hangover.samples);
+    EXPECT_FALSE(input.isAwake());
+    stats = input.getStatistics();
+    EXPECT_EQ(stats.wake_detections, 1u);
+    EXPECT_EQ(stats.false_wakes, 0u);
+
+    // Woken with nothing after: a false wake
+    SignalBuilder idle(10);
+    idle.phrase(WAKE_PHRASE, 6, 4000.0);
+    idle.silence(VoiceInput::WAKE_HANGOVER_FRAMES + 5);
+    input.processAudioData(idle.samples);
+    stats = input.getStatistics();
+    EXPECT_EQ(stats.wake_detections, 2u);
+    EXPECT_EQ(stats.false_wakes, 1u);
+    EXPECT_GT(stats.false_wakes_per_hour, 0.0);
+
+    // Woken, but recognition found nothing in what followed
+    SignalBuilder rejected(11);
+    rejected.phrase(WAKE_PHRASE, 6, 4000.0);
+    rejected.silence(3);
+    rejected.phrase(CHATTER, 3, 4000.0);
+    input.processAudioData(rejected.samples);
+    ASSERT_TRUE(input.isAwake());
+    input.reportFalseWake();
+    input.reportFalseWake();
+    EXPECT_FALSE(input.isAwake());
+    EXPECT_EQ(input.getStatistics().false_wakes, 2u);
+
+    // Without the stage every voiced frame goes through
+    input.setWakeSpotter(nullptr);
+    size_t before = delivered;
+    input.processAudioData(chatter.samples);
+    EXPECT_GT(delivered, before + 10);
+}
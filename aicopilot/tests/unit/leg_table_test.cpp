@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "../../include/leg_table.hpp"
+#include "../../include/navigation.h"
+#include <cmath>
+#include <random>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+constexpr double EARTH_RADIUS_NM = 3440.065;
+
+Position makePosition(double lat, double lon) {
+    return {lat, lon, 5000.0, 0.0};
+}
+
+Waypoint makeFix(const std::string& id, double lat, double lon) {
+    Waypoint fix;
+    fix.id = id;
+    fix.position = makePosition(lat, lon);
+    return fix;
+}
+
+double haversine(const Position& a, const Position& b) {
+    double dLat = (b.latitude - a.latitude) * DEG_TO_RAD;
+    double dLon = (b.longitude - a.longitude) * DEG_TO_RAD;
+    double h = std::sin(dLat / 2) * std::sin(dLat / 2) +
+               std::cos(a.latitude * DEG_TO_RAD) * std::cos(b.latitude * DEG_TO_RAD) *
+               std::sin(dLon / 2) * std::sin(dLon / 2);
+    return 2.0 * std::atan2(std::sqrt(h), std::sqrt(1 - h)) * EARTH_RADIUS_NM;
+}
+
+} // namespace
+
+// Test: Incremental edits leave the same table as a fresh build
+TEST(LegTableTest, EditsMatchRebuild) {
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<double> lat(-60.0, 60.0), lon(-179.0, 179.0);
+    std::vector<Waypoint> fixes;
+    LegTable table;
+
+    for (int round = 0; round < 300; ++round) {
+        int action = fixes.size() < 3 ? 0 : static_cast<int>(rng() % 3);
+        if (action == 0) {
+            size_t index = rng() % (fixes.size() + 1);
+            Waypoint fix = makeFix("WP" + std::to_string(round), lat(rng), lon(rng));
+            fixes.insert(fixes.begin() + index, fix);
+            table.insert(index, fix.position);
+        } else if (action == 1) {
+            size_t index = rng() % fixes.size();
+            fixes.erase(fixes.begin() + index);
+            table.remove(index);
+        } else {
+            size_t index = rng() % fixes.size();
+            fixes[index].position = makePosition(lat(rng), lon(rng));
+            table.update(index, fixes[index].position);
+        }
+
+        LegTable fresh;
+        fresh.build(fixes);
+        ASSERT_EQ(table.getFixCount(), fixes.size());
+        ASSERT_EQ(table.getLegCount(), fresh.getLegCount());
+        double total = 0.0;
+        for (size_t i = 0; i < table.getLegCount(); ++i) {
+            total += haversine(fixes[i].position, fixes[i + 1].position);
+            EXPECT_NEAR(table.getLeg(i).length, fresh.getLeg(i).length, 1e-9);
+            EXPECT_NEAR(table.getLeg(i).cumulative, total, 1e-6);
+            EXPECT_NEAR(table.getLeg(i).initialCourse, fresh.getLeg(i).initialCourse, 1e-9);
+        }
+        EXPECT_NEAR(table.getTotalDistance(), total, 1e-6);
+        if (!fixes.empty()) {
+            size_t from = rng() % fixes.size();
+            double rest = 0.0;
+            for (size_t i = from; i + 1 < fixes.size(); ++i) rest += haversine(fixes[i].position, fixes[i + 1].position);
+            EXPECT_NEAR(table.getDistanceFrom(from), rest, 1e-6);
+        }
+    }
+}
+
+// Test: Courses and cross-track distance against the spherical formulas
+TEST(LegTableTest, CoursesAndCrossTrack) {
+    LegTable table;
+    table.build({makeFix("A", 0.0, 0.0), makeFix("B", 0.0, 10.0), makeFix("C", 40.0, -74.0), makeFix("D", 51.5, 0.0)});
+    EXPECT_NEAR(table.getLeg(0).initialCourse, 90.0, 1e-9);
+    EXPECT_NEAR(table.getLeg(0).finalCourse, 90.0, 1e-9);
+    EXPECT_NEAR(table.getLeg(0).length, EARTH_RADIUS_NM * 10.0 * DEG_TO_RAD, 1e-6);
+
+    // New York to London leaves north-east and arrives heading south of east
+    EXPECT_GT(table.getLeg(2).initialCourse, 45.0);
+    EXPECT_LT(table.getLeg(2).initialCourse, 60.0);
+    EXPECT_GT(table.getLeg(2).finalCourse, 100.0);
+    EXPECT_LT(table.getLeg(2).finalCourse, 120.0);
+
+    // Eastbound along the equator: north is left
+    EXPECT_NEAR(table.crossTrackDistance(0, makePosition(1.0, 5.0)), -EARTH_RADIUS_NM * DEG_TO_RAD, 1e-6);
+    EXPECT_NEAR(table.crossTrackDistance(0, makePosition(-0.5, 3.0)), 0.5 * EARTH_RADIUS_NM * DEG_TO_RAD, 1e-6);
+    EXPECT_DOUBLE_EQ(table.crossTrackDistance(7, makePosition(1.0, 1.0)), 0.0);
+
+    // Same as the along-bearing formula for an off-track point
+    Position p = makePosition(45.0, -40.0);
+    const Position a = makePosition(40.0, -74.0);
+    double d13 = haversine(a, p) / EARTH_RADIUS_NM;
+    double lat1 = a.latitude * DEG_TO_RAD, lat3 = p.latitude * DEG_TO_RAD;
+    double dLon = (p.longitude - a.longitude) * DEG_TO_RAD;
+    double brg13 = std::atan2(std::sin(dLon) * std::cos(lat3),
+                              std::cos(lat1) * std::sin(lat3) - std::sin(lat1) * std::cos(lat3) * std::cos(dLon));
+    double expected = std::asin(std::sin(d13) * std::sin(brg13 - table.getLeg(2).initialCourse * DEG_TO_RAD)) *
+                      EARTH_RADIUS_NM;
+    EXPECT_NEAR(table.crossTrackDistance(2, p), expected, 1e-6);
+}
+
+// Test: Navigation keeps the table in step with flight plan edits
+TEST(LegTableTest, NavigationUsesTable) {
+    Navigation nav;
+    nav.addWaypoint(makeFix("A", 40.0, -74.0));
+    nav.addWaypoint(makeFix("C", 40.0, -72.0));
+    nav.insertWaypoint(1, makeFix("B", 41.0, -73.0));
+    double expected = haversine(makePosition(40.0, -74.0), makePosition(41.0, -73.0)) +
+                      haversine(makePosition(41.0, -73.0), makePosition(40.0, -72.0));
+    EXPECT_NEAR(nav.getTotalDistance(), expected, 1e-6);
+    EXPECT_NEAR(nav.timeToDestination(120.0), expected / 120.0 * 60.0, 1e-6);
+
+    nav.advanceWaypoint();
+    EXPECT_NEAR(nav.crossTrackError(makePosition(40.5, -73.5)), 0.0, 0.5);
+    EXPECT_GT(nav.crossTrackError(makePosition(40.2, -73.6)), 5.0);  // right of the north-east leg
+
+    ASSERT_TRUE(nav.updateWaypointPosition("B", makePosition(40.0, -73.0)));
+    nav.removeWaypoint(2);
+    EXPECT_NEAR(nav.getTotalDistance(), haversine(makePosition(40.0, -74.0), makePosition(40.0, -73.0)), 1e-6);
+    EXPECT_EQ(nav.getLegTable().getLegCount(), 1u);
+}
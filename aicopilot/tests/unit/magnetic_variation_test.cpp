@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "../../include/magnetic_variation.hpp"
+#include "../../include/navdata_pack.hpp"
+#include <cmath>
+
+using namespace AICopilot;
+
+// Test: The model matches published WMM2020 declinations at epoch
+TEST(MagneticVariationTest, MatchesPublishedDeclination) {
+    const double epoch = MagneticVariationGrid::MODEL_EPOCH;
+    EXPECT_NEAR(MagneticVariationGrid::evaluate(40.64, -73.78, epoch), -12.9, 0.5);   // New York
+    EXPECT_NEAR(MagneticVariationGrid::evaluate(51.47, -0.45, epoch), -0.3, 0.5);     // London
+    EXPECT_NEAR(MagneticVariationGrid::evaluate(35.55, 139.78, epoch), -7.6, 0.5);    // Tokyo
+    EXPECT_NEAR(MagneticVariationGrid::evaluate(-33.95, 151.18, epoch), 12.7, 0.5);   // Sydney
+    EXPECT_NEAR(MagneticVariationGrid::evaluate(-23.43, -46.47, epoch), -21.9, 0.5);  // Sao Paulo
+}
+
+// Test: Secular variation moves the answer with the date
+TEST(MagneticVariationTest, AppliesSecularVariation) {
+    double then = MagneticVariationGrid::evaluate(40.64, -73.78, 2020.0);
+    double later = MagneticVariationGrid::evaluate(40.64, -73.78, 2025.0);
+    EXPECT_NE(then, later);
+    EXPECT_LT(std::abs(later - then), 1.0);
+}
+
+// Test: Bilinear lookups stay close to the full model between nodes
+TEST(MagneticVariationTest, GridLookupTracksModel) {
+    MagneticVariationGrid grid(2024.5);
+    EXPECT_EQ(grid.getDecimalYear(), 2024.5);
+    for (double lat = -60.0; lat <= 70.0; lat += 7.3) {
+        for (double lon = -179.0; lon <= 179.0; lon += 11.7) {
+            EXPECT_NEAR(grid.lookup(lat, lon), MagneticVariationGrid::evaluate(lat, lon, 2024.5), 0.1)
+                << lat << "," << lon;
+        }
+    }
+    // Longitudes wrap
+    EXPECT_NEAR(grid.lookup(47.0, 190.0), grid.lookup(47.0, -170.0), 1e-9);
+    EXPECT_TRUE(std::isfinite(grid.lookup(90.0, 0.0)));
+}
+
+// Test: Stamping fills in only waypoints without a variation
+TEST(MagneticVariationTest, StampsBuilderWaypoints) {
+    NavdataWaypoint blank("KJFK", 40.6413, -73.7781, NavaidType::AIRPORT);
+    NavdataWaypoint set("SEA", 47.4353, -122.3095, NavaidType::VOR, 0, 116.8);
+    set.magneticVariation = 19.0;   // station declination, kept
+    NavdataPackBuilder builder;
+    builder.putWaypoint(blank);
+    builder.putWaypoint(set);
+
+    MagneticVariationGrid grid(2024.5);
+    EXPECT_EQ(builder.stampMagneticVariation(grid), 1u);
+
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(builder.build()));
+    EXPECT_NEAR(pack.getWaypoint(pack.findWaypoint("KJFK")).magneticVariation,
+                grid.lookup(40.6413, -73.7781), 0.01);
+    EXPECT_DOUBLE_EQ(pack.getWaypoint(pack.findWaypoint("SEA")).magneticVariation, 19.0);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "../../include/memory_arena.hpp"
+#include "../../include/traffic_system.h"
+#include "../../include/traffic_table.hpp"
+#include <cstdint>
+#include <memory_resource>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+// Test: Once the busiest tick has been seen, later ticks take no new chunks
+TEST(FrameArenaTest, SteadyStateTicksDoNotAllocate) {
+    FrameArena arena(256);
+    auto tick = [&arena] {
+        arena.reset();
+        std::pmr::vector<double> samples(&arena);
+        for (int i = 0; i < 500; ++i) samples.push_back(i);
+        std::pmr::vector<int> other(100, 7, &arena);
+        EXPECT_EQ(samples.back(), 499.0);
+    };
+
+    tick();
+    EXPECT_GT(arena.chunkAllocations(), 1u);   // overflowed the first chunk
+    tick();                                    // reset merged the chunks
+    uint64_t steady = arena.chunkAllocations();
+    for (int i = 0; i < 10; ++i) tick();
+    EXPECT_EQ(arena.chunkAllocations(), steady);
+    EXPECT_GE(arena.capacity(), arena.highWaterBytes());
+}
+
+// Test: Allocations honour alignment and reset rewinds to the start
+TEST(FrameArenaTest, AlignsAndRewinds) {
+    FrameArena arena(1024);
+    void* first = arena.allocate(3, 1);
+    void* aligned = arena.allocate(64, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0u);
+    EXPECT_GE(arena.bytesUsed(), 67u);
+
+    arena.reset();
+    EXPECT_EQ(arena.bytesUsed(), 0u);
+    EXPECT_EQ(arena.allocate(3, 1), first);
+
+    // Larger than any chunk still succeeds
+    void* big = arena.allocate(8192, 16);
+    EXPECT_NE(big, nullptr);
+    EXPECT_EQ(&FrameArena::forThread(), &FrameArena::forThread());
+}
+
+// Test: Freed blocks are reused and slabs only grow when the free list runs dry
+TEST(SlabPoolTest, ReusesFreedBlocks) {
+    SlabPool pool(24, 16);
+    EXPECT_EQ(pool.blockSize() % alignof(std::max_align_t), 0u);
+
+    std::vector<void*> blocks;
+    for (int i = 0; i < 16; ++i) blocks.push_back(pool.allocate());
+    EXPECT_EQ(pool.slabCount(), 1u);
+    EXPECT_EQ(std::set<void*>(blocks.begin(), blocks.end()).size(), blocks.size());
+
+    void* last = blocks.back();
+    pool.deallocate(last);
+    EXPECT_EQ(pool.allocate(), last);
+
+    for (void* block : blocks) pool.deallocate(block);
+    for (int i = 0; i < 16; ++i) blocks[i] = pool.allocate();
+    EXPECT_EQ(pool.slabCount(), 1u);
+    for (void* block : blocks) pool.deallocate(block);
+
+    // As a memory_resource, oversized requests go upstream
+    void* large = pool.allocate(1000, 8);
+    EXPECT_EQ(pool.slabCount(), 1u);
+    pool.deallocate(large, 1000, 8);
+}
+
+// Test: Threads allocating and freeing concurrently never share a block
+TEST(SlabPoolTest, ConcurrentThreads) {
+    SlabPool pool(sizeof(uint64_t), 64);
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&pool, t] {
+            std::vector<uint64_t*> held;
+            for (uint64_t i = 0; i < 5000; ++i) {
+                uint64_t* block = static_cast<uint64_t*>(pool.allocate());
+                *block = t * 1000000 + i;
+                held.push_back(block);
+                if (held.size() > 100) {
+                    for (size_t k = 0; k < held.size(); ++k) {
+                        EXPECT_EQ(*held[k], t * 1000000 + (i + 1 - held.size() + k));
+                    }
+                    for (uint64_t* h : held) pool.deallocate(h);
+                    held.clear();
+                }
+            }
+            for (uint64_t* h : held) pool.deallocate(h);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+}
+
+// Test: Per-tick traffic queries can be served from a frame arena
+TEST(FrameArenaTest, TrafficQueriesUseArena) {
+    AircraftState own{};
+    own.groundSpeed = 150.0;
+    TrafficSystem traffic;
+    traffic.updateOwnAircraft(own);
+
+    TrafficTable::Sample sample;
+    sample.callsign = "NEAR";
+    sample.latitude = 2.0 / 60.0;
+    sample.groundSpeed = 250.0;
+    sample.heading = 180.0;
+    TrafficTable table;
+    table.upsert(1, sample);
+    traffic.updateTrafficTargets(table);
+
+    FrameArena arena;
+    std::pmr::vector<TrafficAdvisory> advisories = traffic.checkTrafficConflicts(&arena);
+    ASSERT_EQ(advisories.size(), traffic.checkTrafficConflicts().size());
+    ASSERT_FALSE(advisories.empty());
+    EXPECT_EQ(advisories[0].target.callsign, "NEAR");
+    EXPECT_GT(arena.bytesUsed(), 0u);
+    EXPECT_EQ(traffic.getTrafficInVicinity(5.0, &arena).size(), 1u);
+}
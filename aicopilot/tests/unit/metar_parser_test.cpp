@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "../../include/metar_parser.hpp"
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+using namespace AICopilot;
+
+static_assert(std::is_trivially_copyable<METARObservation>::value,
+              "METARObservation must stay a flat, allocation-free record");
+
+// Test: Tokens are views into the source; trailing '=' and extra spaces are dropped
+TEST(METARParserStreamTest, TokenizerYieldsViews) {
+    const std::string metar = "  KJFK   121851Z\t31008KT 10SM=";
+    METARTokenizer tokens(metar);
+    std::string_view token;
+
+    const char* expected[] = {"KJFK", "121851Z", "31008KT", "10SM"};
+    for (const char* text : expected) {
+        ASSERT_TRUE(tokens.next(token));
+        EXPECT_EQ(token, text);
+        EXPECT_GE(token.data(), metar.data());
+        EXPECT_LT(token.data(), metar.data() + metar.size());
+    }
+    EXPECT_FALSE(tokens.next(token));
+}
+
+// Test: The classifier separates every body group, including look-alikes
+TEST(METARParserStreamTest, ClassifiesTokens) {
+    static_assert(METARParser::classifyToken("VRB05KT") == METARTokenType::WIND, "");
+    static_assert(METARParser::classifyToken("9999") == METARTokenType::VISIBILITY, "");
+
+    EXPECT_EQ(METARParser::classifyToken("121851Z"), METARTokenType::DATE_TIME);
+    EXPECT_EQ(METARParser::classifyToken("05006MPS"), METARTokenType::WIND);
+    EXPECT_EQ(METARParser::classifyToken("180V240"), METARTokenType::WIND_VARIATION);
+    EXPECT_EQ(METARParser::classifyToken("1"), METARTokenType::VISIBILITY_WHOLE);
+    EXPECT_EQ(METARParser::classifyToken("M1/4SM"), METARTokenType::VISIBILITY);
+    EXPECT_EQ(METARParser::classifyToken("R04R/2200FT"), METARTokenType::RUNWAY_RANGE);
+    EXPECT_EQ(METARParser::classifyToken("VCSH"), METARTokenType::WEATHER);
+    EXPECT_EQ(METARParser::classifyToken("OVC///"), METARTokenType::CLOUD);
+    EXPECT_EQ(METARParser::classifyToken("VV002"), METARTokenType::VERTICAL_VISIBILITY);
+    EXPECT_EQ(METARParser::classifyToken("NCD"), METARTokenType::SKY_CLEAR);
+    EXPECT_EQ(METARParser::classifyToken("M05/"), METARTokenType::TEMPERATURE);
+    EXPECT_EQ(METARParser::classifyToken("Q1018"), METARTokenType::ALTIMETER);
+    EXPECT_EQ(METARParser::classifyToken("TEMPO"), METARTokenType::TREND);
+    EXPECT_EQ(METARParser::classifyToken("KJFK"), METARTokenType::UNKNOWN);
+    EXPECT_EQ(METARParser::classifyToken("ABCD"), METARTokenType::UNKNOWN);
+    EXPECT_EQ(METARParser::identifyTokenType("BKN015CB"), "clouds");
+}
+
+// Test: A full US report decodes into the fixed layout
+TEST(METARParserStreamTest, ParsesFullReport) {
+    const std::string metar =
+        "METAR KORD 121901Z AUTO 22025G35KT 190V250 1 1/2SM R10L/4500FT +TSRA BR "
+        "FEW008 BKN015CB OVC030 16/14 A2995 RMK AO2 PK WND 22040/1855";
+    METARObservation obs;
+    ASSERT_TRUE(METARParser::parse(metar, obs));
+
+    EXPECT_EQ(obs.stationId(), "KORD");
+    EXPECT_EQ(obs.day, 12);
+    EXPECT_EQ(obs.hour, 19);
+    EXPECT_EQ(obs.minute, 1);
+    EXPECT_TRUE(obs.automated);
+
+    EXPECT_EQ(obs.windDirection, 220);
+    EXPECT_EQ(obs.windSpeed, 25);
+    EXPECT_EQ(obs.windGust, 35);
+    EXPECT_EQ(obs.variableMinDir, 190);
+    EXPECT_EQ(obs.variableMaxDir, 250);
+    EXPECT_DOUBLE_EQ(obs.visibilitySM, 1.5);
+
+    ASSERT_EQ(obs.weatherCount, 2);
+    EXPECT_EQ(obs.weather[0].intensity, 1);
+    EXPECT_TRUE(obs.weather[0].has(METARWeather::TS));
+    EXPECT_TRUE(obs.weather[0].has(METARWeather::RA));
+    EXPECT_EQ(obs.weather[0].text(metar), "+TSRA");
+    EXPECT_TRUE(obs.weather[1].has(METARWeather::BR));
+    EXPECT_TRUE(obs.thunderstorm());
+    EXPECT_TRUE(obs.precipitation());
+
+    ASSERT_EQ(obs.cloudCount, 3);
+    EXPECT_EQ(obs.clouds[1].coverage, CloudCoverage::BKN);
+    EXPECT_EQ(obs.clouds[1].altitudeFeet, 1500);
+    EXPECT_TRUE(obs.clouds[1].cumulonimbus);
+    EXPECT_DOUBLE_EQ(obs.ceilingFeet(), 1500.0);
+
+    EXPECT_EQ(obs.temperature, 16);
+    EXPECT_EQ(obs.dewpoint, 14);
+    EXPECT_DOUBLE_EQ(obs.altimeterInHg, 29.95);
+    EXPECT_EQ(obs.remarks(metar), "AO2 PK WND 22040/1855");
+    EXPECT_EQ(obs.unknownTokens, 0);
+}
+
+// Test: ICAO units, CAVOK, trends and failures
+TEST(METARParserStreamTest, ParsesIcaoReportsAndRejectsBadHeaders) {
+    const std::string metar = "EGLL 121850Z 05006MPS 9999 CAVOK M02/M05 Q1018 BECMG 4000 -SN";
+    METARObservation obs;
+    ASSERT_TRUE(METARParser::parse(metar, obs));
+    EXPECT_EQ(obs.windSpeed, 12);
+    EXPECT_TRUE(obs.cavok);
+    EXPECT_DOUBLE_EQ(obs.visibilitySM, Visibility::MAX_VISIBILITY_SM);
+    EXPECT_EQ(obs.temperature, -2);
+    EXPECT_EQ(obs.dewpoint, -5);
+    EXPECT_DOUBLE_EQ(obs.altimeterMbar, 1018.0);
+    // The trend group does not overwrite the observation
+    EXPECT_EQ(obs.weatherCount, 0);
+    EXPECT_DOUBLE_EQ(obs.ceilingFeet(), METARObservation::NO_CEILING_FEET);
+
+    // Vertical visibility is a ceiling
+    ASSERT_TRUE(METARParser::parse("KSFO 121856Z 00000KT 1/4SM FG VV002 12/12 A3001", obs));
+    EXPECT_DOUBLE_EQ(obs.ceilingFeet(), 200.0);
+    EXPECT_FALSE(obs.precipitation());
+
+    EXPECT_FALSE(METARParser::parse("   ", obs));
+    EXPECT_STREQ(obs.error, "Empty METAR string");
+    EXPECT_FALSE(METARParser::parse("kjfk 121851Z", obs));
+    EXPECT_STREQ(obs.error, "Invalid station ID");
+    EXPECT_FALSE(METARParser::parse("KJFK 321851Z 31008KT", obs));
+    EXPECT_STREQ(obs.error, "Invalid date/time");
+}
+
+// Test: Mutated reports never escape the fixed bounds or point outside their text
+TEST(METARParserStreamTest, MutatedReportsStayInBounds) {
+    const std::string seeds[] = {
+        "METAR KORD 121901Z AUTO 22025G35KT 190V250 1 1/2SM R10L/4500FT +TSRA BR "
+        "FEW008 BKN015CB OVC030 16/14 A2995 RMK AO2 PK WND 22040/1855",
+        "EGLL 121850Z 05006MPS 9999 CAVOK M02/M05 Q1018 BECMG 4000 -SN",
+        "KSFO 121856Z 00000KT 1/4SM FG VV002 12/12 A3001",
+        "SPECI CYYZ 121900Z 27015G25KT 3/4SM -SHSN BLSN VCTS FZFG DZ FEW005 SCT010 BKN020 OVC030 "
+        "BKN040 OVC050 OVC060 M05/M07 A2990 RMK SF2SC3",
+    };
+    const char alphabet[] = "0123456789/ +-KTSMVRBQACFGZ=\t";
+    std::mt19937 rng(59);
+    METARObservation obs;
+
+    for (int round = 0; round < 20000; ++round) {
+        std::string text = seeds[round % 4];
+        for (int edits = 1 + static_cast<int>(rng() % 4); edits > 0 && !text.empty(); --edits) {
+            size_t at = rng() % text.size();
+            switch (rng() % 4) {
+            case 0: text[at] = alphabet[rng() % (sizeof(alphabet) - 1)]; break;
+            case 1: text.erase(at, 1 + rng() % 6); break;
+            case 2: text.insert(at, text, rng() % text.size(), 1 + rng() % 12); break;
+            default: text.resize(at); break;
+            }
+        }
+        if (!METARParser::parse(text, obs)) continue;
+
+        ASSERT_LE(obs.weatherCount, METARObservation::MAX_WEATHER_GROUPS) << text;
+        ASSERT_LE(obs.cloudCount, METARObservation::MAX_CLOUD_LAYERS) << text;
+        ASSERT_LE(size_t(obs.remarksOffset) + obs.remarksLength, text.size()) << text;
+        for (size_t i = 0; i < obs.weatherCount; ++i) {
+            ASSERT_LE(size_t(obs.weather[i].offset) + obs.weather[i].length, text.size()) << text;
+        }
+        ASSERT_GE(obs.stationId().size(), 3u) << text;
+    }
+}
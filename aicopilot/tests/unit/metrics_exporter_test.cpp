@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "../../include/metrics_exporter.hpp"
+#include "../../include/system_monitor.hpp"
+#include "../../include/task_scheduler.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace AICopilot;
+
+namespace {
+
+bool contains(const std::string& text, const std::string& needle) {
+    return text.find(needle) != std::string::npos;
+}
+
+} // namespace
+
+// Test: Counters, gauges and histograms render in Prometheus text format
+TEST(MetricsRegistryTest, RendersSeries) {
+    MetricsRegistry registry;
+    registry.setConstantLabels({{"pilot", "N123AB"}});
+
+    MetricCounter& ticks = registry.counter("test_ticks_total", "Ticks run");
+    EXPECT_EQ(&registry.counter("test_ticks_total", "Ticks run"), &ticks);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&ticks] { for (int i = 0; i < 1000; ++i) ticks.inc(); });
+    }
+    for (auto& thread : threads) thread.join();
+
+    registry.gauge("test_altitude_feet", "Altitude", {{"source", "gps \"raw\""}}).set(3500.5);
+    ConcurrentHdrHistogram& latency = registry.histogram("test_latency_seconds", "Latency");
+    for (int i = 0; i < 90; ++i) latency.record(0.8);     // 0.8 ms
+    for (int i = 0; i < 10; ++i) latency.record(40.0);    // 40 ms
+
+    std::string text = registry.render();
+    EXPECT_TRUE(contains(text, "# TYPE test_ticks_total counter\n"));
+    EXPECT_TRUE(contains(text, "test_ticks_total{pilot=\"N123AB\"} 4000\n"));
+    EXPECT_TRUE(contains(text, "test_altitude_feet{pilot=\"N123AB\",source=\"gps \\\"raw\\\"\"} 3500.5\n"));
+    EXPECT_TRUE(contains(text, "# TYPE test_latency_seconds histogram\n"));
+    EXPECT_TRUE(contains(text, "test_latency_seconds_bucket{pilot=\"N123AB\",le=\"0.0005\"} 0\n"));
+    EXPECT_TRUE(contains(text, "test_latency_seconds_bucket{pilot=\"N123AB\",le=\"0.001\"} 90\n"));
+    EXPECT_TRUE(contains(text, "test_latency_seconds_bucket{pilot=\"N123AB\",le=\"0.05\"} 100\n"));
+    EXPECT_TRUE(contains(text, "test_latency_seconds_bucket{pilot=\"N123AB\",le=\"+Inf\"} 100\n"));
+    EXPECT_TRUE(contains(text, "test_latency_seconds_count{pilot=\"N123AB\"} 100\n"));
+}
+
+// Test: Collectors refresh pulled metrics on every scrape
+TEST(MetricsRegistryTest, ScrapeRunsCollectors) {
+    MetricsRegistry registry;
+    SystemMonitor monitor;
+    for (int i = 0; i < 20; ++i) monitor.recordQueryLatency(SystemComponent::NAVIGATION, 2.0);
+    bindSystemMonitorMetrics(registry, monitor);
+
+    TaskScheduler scheduler(0);
+    scheduler.addTask("control", 50.0, [] {});
+    scheduler.tick();
+    bindTaskSchedulerMetrics(registry, scheduler);
+
+    int scrapes = 0;
+    registry.addCollector([&scrapes](MetricsRegistry& r) {
+        publishCacheStatistics(r, "elevation", 75, 25, 10);
+        scrapes++;
+    });
+
+    std::string text = registry.scrape();
+    EXPECT_EQ(scrapes, 1);
+    EXPECT_TRUE(contains(text, "aicopilot_component_queries_total{component=\"navigation\"} 20\n"));
+    EXPECT_TRUE(contains(text, "aicopilot_component_latency_seconds_count{component=\"navigation\"} 20\n"));
+    EXPECT_TRUE(contains(text, "aicopilot_task_runs_total{task=\"control\"} 1\n"));
+    EXPECT_TRUE(contains(text, "aicopilot_cache_hit_ratio{cache=\"elevation\"} 0.75\n"));
+    EXPECT_TRUE(contains(text, "aicopilot_process_resident_bytes "));
+
+    monitor.recordQueryLatency(SystemComponent::NAVIGATION, 2.0);
+    EXPECT_TRUE(contains(registry.scrape(), "aicopilot_component_queries_total{component=\"navigation\"} 21\n"));
+    EXPECT_EQ(scrapes, 2);
+}
+
+// Test: Only GET /metrics is served
+TEST(MetricsHttpServerTest, RoutesRequests) {
+    MetricsRegistry registry;
+    registry.counter("test_requests_total", "Requests").inc(3);
+    MetricsHttpServer server(registry);
+
+    std::string ok = server.respond("GET /metrics HTTP/1.1\r\nHost: x\r\n\r\n");
+    EXPECT_EQ(ok.compare(0, 15, "HTTP/1.0 200 OK"), 0);
+    EXPECT_TRUE(contains(ok, "Content-Type: text/plain; version=0.0.4"));
+    EXPECT_TRUE(contains(ok, "\r\n\r\n# HELP test_requests_total Requests\n"));
+
+    EXPECT_TRUE(contains(server.respond("GET / HTTP/1.1\r\n\r\n"), "404 Not Found"));
+    EXPECT_TRUE(contains(server.respond("POST /metrics HTTP/1.1\r\n\r\n"), "405"));
+}
+
+#ifndef _WIN32
+// Test: A real scrape over loopback
+TEST(MetricsHttpServerTest, ServesOverTcp) {
+    MetricsRegistry registry;
+    registry.gauge("test_up", "Exporter is up").set(1);
+    MetricsHttpServer server(registry);
+    ASSERT_TRUE(server.start(0));
+    ASSERT_NE(server.port(), 0);
+    EXPECT_FALSE(server.start(0));
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(server.port());
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    ASSERT_EQ(connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    const char request[] = "GET /metrics HTTP/1.0\r\n\r\n";
+    ASSERT_EQ(send(fd, request, sizeof(request) - 1, 0), static_cast<ssize_t>(sizeof(request) - 1));
+
+    std::string response;
+    char buffer[512];
+    ssize_t n;
+    while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) response.append(buffer, n);
+    close(fd);
+
+    EXPECT_TRUE(contains(response, "200 OK"));
+    EXPECT_TRUE(contains(response, "test_up 1\n"));
+    server.stop();
+    EXPECT_FALSE(server.isRunning());
+}
+#endif
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "../../include/ml_decision_engine.hpp"
+#include <vector>
+
+using namespace AICopilot::ML;
+
+namespace {
+
+EnvironmentalInput makeInput(double pressure = 1013.25, double wind_speed = 10, double wind_direction = 180,
+                             double visibility = 10000, double runway_length = 6000,
+                             int runway_condition = 0, bool ils = true, double elevation = 0,
+                             double slope = 0, double complexity = 5) {
+    EnvironmentalInput input;
+    input.pressure = pressure;
+    input.wind_speed = wind_speed;
+    input.wind_direction = wind_direction;
+    input.visibility = visibility;
+    input.runway_length = runway_length;
+    input.runway_condition = runway_condition;
+    input.ils_available = ils;
+    input.elevation = elevation;
+    input.slope = slope;
+    input.route_complexity = complexity;
+    return input;
+}
+
+} // namespace
+
+// Test: Batch scoring matches scoring each weather candidate on its own
+TEST(MLDecisionEngineTest, BatchScoringMatchesSingle) {
+    MLDecisionEngine engine;
+    engine.initialize();
+
+    EnvironmentalInput input = makeInput(1005, 12, 180, 6000, 7000, 1, true, 800, 1, 4);
+    std::vector<WeatherVariant> candidates;
+    for (int i = 0; i < 40; ++i) {
+        candidates.push_back({4.0 + i, 9000.0 - 150 * i, 990.0 + i});
+    }
+    std::vector<DecisionScore> batch = engine.scoreDecisions(input, candidates);
+
+    ASSERT_EQ(batch.size(), candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        EnvironmentalInput single = input;
+        single.wind_speed = candidates[i].wind_speed;
+        single.visibility = candidates[i].visibility;
+        single.pressure = candidates[i].pressure;
+        DecisionScore expected = engine.scoreDecision(single);
+        EXPECT_EQ(batch[i].score, expected.score) << i;
+        EXPECT_EQ(batch[i].action, expected.action) << i;
+        EXPECT_EQ(batch[i].factors, expected.factors) << i;
+    }
+    // Every batch candidate counts as a decision
+    EXPECT_EQ(engine.getPerformanceMetrics().total_decisions, 80);
+
+    // A generous deadline scores every candidate
+    std::vector<DecisionScore> bounded = engine.scoreWithLatencyBound(input, candidates, 1000);
+    ASSERT_EQ(bounded.size(), candidates.size());
+    EXPECT_EQ(bounded.back().score, batch.back().score);
+}
+
+// Test: Running z-scores flag only inputs far from the history, and streamed updates score as the full input
+TEST(MLDecisionEngineTest, StreamingMatchesFullScoring) {
+    MLDecisionEngine engine;
+    engine.initialize();
+
+    // Running statistics follow a varied history
+    for (int i = 0; i < 20; ++i) {
+        EnvironmentalInput input = makeInput(1005 + i, 8 + i % 5, 180, 8000 + 100 * i, 7000, 0, true,
+                                             100 + 10 * i, 1, 4 + i % 3);
+        engine.recordDecision(input, engine.scoreDecision(input), "NORMAL", true, 75.0);
+    }
+    EXPECT_FALSE(engine.detectAnomalies(makeInput(1014, 10, 180, 9000, 7000, 0, true, 200, 1, 5)).is_anomaly);
+    EXPECT_TRUE(engine.detectAnomalies(makeInput(900, 60, 180, 50, 7000, 0, true, 5000, 1, 10)).is_anomaly);
+    engine.clearHistory();
+    EXPECT_FALSE(engine.detectAnomalies(makeInput(900, 60, 180, 50)).is_anomaly);
+
+    // Incremental updates score as the full input would
+    engine.enableStreamingMode(true);
+    engine.updateWeather(1008, 14, 200, 6000, 12);
+    engine.updateRunway(7500, 150, 1, true, true);
+    engine.updateTerrain(400, 2, false, true);
+    engine.updateRoute(6, 3);
+    DecisionScore first = engine.scoreStreaming();
+    DecisionScore full = engine.scoreDecision(engine.getStreamingInput());
+    EXPECT_EQ(first.score, full.score);
+    EXPECT_EQ(first.action, full.action);
+    engine.updateWeather(996, 28, 220, 1500, 9);
+    DecisionScore second = engine.scoreStreaming();
+    full = engine.scoreDecision(engine.getStreamingInput());
+    EXPECT_EQ(second.score, full.score);
+    EXPECT_EQ(second.factors, full.factors);
+    EXPECT_NE(second.score, first.score);
+
+    // Normalization follows the streamed samples
+    MLDecisionEngine::NormalizationParams norm = engine.getNormalizationParams();
+    EXPECT_NEAR(norm.pressure_mean, 1002, 1e-9);
+    EXPECT_NEAR(norm.pressure_std, 6, 1e-9);
+    EXPECT_NEAR(norm.wind_speed_mean, 21, 1e-9);
+}
+
+// Test: Decisions trimmed from a full history leave its running statistics
+TEST(MLDecisionEngineTest, TrimmedHistoryLeavesStatistics) {
+    const int capacity = 10000;
+    EnvironmentalInput extreme = makeInput(900, 60, 180, 50, 7000, 0, true, 5000, 1, 10);
+    auto usual = [](int i) {
+        return makeInput(1005 + i % 10, 8 + i % 5, 180, 8000 + 100 * (i % 20), 7000, 0, true,
+                         100 + 10 * (i % 20), 1, 4 + i % 3);
+    };
+
+    // Extremes fill the history first, then a full window of usual inputs pushes them out
+    MLDecisionEngine trimmed;
+    trimmed.initialize();
+    for (int i = 0; i < capacity / 2; ++i) {
+        trimmed.recordDecision(extreme, DecisionScore(), "NORMAL", true, 75.0);
+    }
+    MLDecisionEngine fresh;
+    fresh.initialize();
+    for (int i = 0; i < capacity; ++i) {
+        trimmed.recordDecision(usual(i), DecisionScore(), "NORMAL", true, 75.0);
+        fresh.recordDecision(usual(i), DecisionScore(), "NORMAL", true, 75.0);
+    }
+    ASSERT_EQ(trimmed.getHistorySize(), static_cast<size_t>(capacity));
+
+    // Only the retained window counts, so the extreme input stands out again
+    AnomalyDetectionResult fromTrimmed = trimmed.detectAnomalies(extreme);
+    AnomalyDetectionResult fromFresh = fresh.detectAnomalies(extreme);
+    EXPECT_TRUE(fromTrimmed.is_anomaly);
+    EXPECT_EQ(fromTrimmed.flagged_factors, fromFresh.flagged_factors);
+    EXPECT_FALSE(trimmed.detectAnomalies(usual(3)).is_anomaly);
+}
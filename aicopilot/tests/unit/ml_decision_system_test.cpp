@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 #include "../../include/ml_decision_system.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <string>
 
 using namespace AICopilot;
 
@@ -177,14 +181,16 @@ TEST_F(MLDecisionSystemTest, ModelPersistence) {
     }
     
     // Save model
-    bool saved = ml.saveModel("test_model.bin");
+    auto path = (std::filesystem::temp_directory_path() / "aicopilot_ml_test_model.bin").string();
+    bool saved = ml.saveModel(path);
     EXPECT_TRUE(saved);
     
     // Create new instance and load
     MLDecisionSystem ml2;
     ml2.initialize();
-    bool loaded = ml2.loadModel("test_model.bin");
+    bool loaded = ml2.loadModel(path);
     EXPECT_TRUE(loaded);
+    std::filesystem::remove(path);
 }
 
 // Test: Approach optimization
@@ -327,3 +333,110 @@ TEST_F(MLDecisionSystemTest, HighConfidenceDecision) {
     EXPECT_GT(confidence, 0.3);
 }
 
+
+// Test: The fixed-size feature buffer follows the layout and matches the vector form
+TEST_F(MLDecisionSystemTest, FeatureBufferLayout) {
+    DecisionContext ctx = createTestContext();
+    ctx.state.heading = 90.0;
+    ctx.state.onGround = false;
+    
+    DecisionFeatureVector buffer;
+    buffer.fill(-1.0);
+    ml.extractFeatures(ctx, buffer);
+    std::vector<double> features = ml.extractFeatures(ctx);
+    ASSERT_EQ(features.size(), DecisionFeatureLayout::COUNT);
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        EXPECT_EQ(buffer[i], features[i]) << "feature " << i;
+    }
+    
+    // APPROACH and its neighbours in the phase block
+    const size_t approach = DecisionFeatureLayout::PHASE + static_cast<size_t>(FlightPhase::APPROACH);
+    EXPECT_EQ(buffer[approach], 1.0);
+    EXPECT_EQ(buffer[approach - 1], 0.5);
+    EXPECT_EQ(buffer[approach + 1], 0.5);
+    EXPECT_EQ(buffer[DecisionFeatureLayout::PHASE], 0.0);
+    
+    // Heading sine, then the on-ground flag last in the state block
+    EXPECT_NEAR(buffer[DecisionFeatureLayout::STATE + 6], 1.0, 1e-12);
+    EXPECT_EQ(buffer[DecisionFeatureLayout::COUNT - 1], 0.0);
+    
+    // Unknown phases leave the phase block zero
+    ctx.phase = FlightPhase::UNKNOWN;
+    ml.extractFeatures(ctx, buffer);
+    for (size_t i = 0; i < DecisionFeatureLayout::PHASE_COUNT; ++i) {
+        EXPECT_EQ(buffer[DecisionFeatureLayout::PHASE + i], 0.0);
+    }
+}
+
+// Test: Hashed text features fold case and punctuation and are unit length
+TEST_F(MLDecisionSystemTest, TextFeatureHashing) {
+    TextFeatureVector a;
+    TextFeatureVector b;
+    hashTextFeatures("Descend and maintain 1500", a);
+    hashTextFeatures("  DESCEND, and maintain: 1500!", b);
+    ASSERT_EQ(a.count, 4u);
+    EXPECT_NEAR(a.dot(b), 1.0, 1e-6);
+    EXPECT_NEAR(a.dot(a), 1.0, 1e-6);
+    EXPECT_TRUE(std::is_sorted(a.bucket.begin(), a.bucket.begin() + a.count));
+    
+    TextFeatureVector c;
+    hashTextFeatures("Climb and maintain 5000", c);
+    EXPECT_NEAR(a.dot(c), 0.5, 1e-6);    // "and", "maintain" shared
+    
+    // Repeats weigh more; long text keeps MAX_TERMS buckets
+    hashTextFeatures("left left left right", b);
+    ASSERT_EQ(b.count, 2u);
+    EXPECT_NEAR(std::max(b.weight[0], b.weight[1]), 3.0 / std::sqrt(10.0), 1e-6);
+    std::string longText;
+    for (int i = 0; i < 40; ++i) longText += "word" + std::to_string(i) + " ";
+    hashTextFeatures(longText, b);
+    EXPECT_EQ(b.count, TextFeatureVector::MAX_TERMS);
+    
+    hashTextFeatures(" ,.- ", b);
+    EXPECT_EQ(b.count, 0u);
+    EXPECT_EQ(a.dot(b), 0.0);
+}
+
+// Test: Repeated text is served from the cache with the same features
+TEST_F(MLDecisionSystemTest, TextFeatureCache) {
+    TextFeatureVector direct;
+    TextFeatureVector cached;
+    hashTextFeatures("Request higher altitude", direct);
+    ml.extractTextFeatures("Request higher altitude", cached);
+    EXPECT_EQ(ml.getTextCacheMisses(), 1u);
+    for (int i = 0; i < 10; ++i) ml.extractTextFeatures("Request higher altitude", cached);
+    EXPECT_EQ(ml.getTextCacheHits(), 10u);
+    EXPECT_EQ(ml.getTextCacheMisses(), 1u);
+    ASSERT_EQ(cached.count, direct.count);
+    EXPECT_NEAR(cached.dot(direct), 1.0, 1e-6);
+    
+    ml.extractTextFeatures("Request lower altitude", cached);
+    EXPECT_EQ(ml.getTextCacheMisses(), 2u);
+    EXPECT_LT(cached.dot(direct), 0.9);
+}
+
+// Test: A trained choice follows its text when the menu is reordered
+TEST_F(MLDecisionSystemTest, VotesFollowOptionText) {
+    ml.initialize();
+    const DecisionContext base = createTestContext();
+    for (int i = 0; i < 10; ++i) {
+        TrainingData data;
+        data.context = base;
+        data.correctOption = 1;    // "Maintain"
+        data.reward = 1.0;
+        ml.trainWithFeedback(data);
+    }
+    
+    DecisionContext ctx = base;
+    double confidence = 0.0;
+    EXPECT_EQ(ml.predictBestOption(ctx, confidence), 1);
+    
+    ctx.atcOptions = {"Climb", "Descend", "maintain"};
+    EXPECT_EQ(ml.predictBestOption(ctx, confidence), 2);
+    EXPECT_NEAR(confidence, 1.0, 1e-12);
+    
+    // No option reads like the choice: its position votes
+    ctx.atcOptions = {"Squawk", "Ident", "Contact tower"};
+    EXPECT_EQ(ml.predictBestOption(ctx, confidence), 1);
+    EXPECT_GT(ml.getTextCacheHits(), 10u);
+}
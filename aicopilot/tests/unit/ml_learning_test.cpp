@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "../../include/ml_features.hpp"
+#include "../../include/ml_learning.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+using namespace AICopilot::ML;
+
+// Test: Indexed search returns the most similar cases, most similar first
+TEST(MLLearningTest, SimilarCasesRanking) {
+    MLLearningSystem learner;
+    MLFeatures features_system;
+
+    std::vector<CombinedFeatures> recorded;
+    for (int i = 0; i < 300; ++i) {
+        LearningOutcome outcome;
+        outcome.features = features_system.extractAllFeatures(
+            990.0 + (i % 40), 5 + i % 25, 10.0 * (i % 36), 2000 + 150 * (i % 50), 15,
+            5000 + 20 * i, 150, i % 3, i % 2 == 0, true,
+            100 * (i % 30), 0.1 * (i % 7), i % 5 == 0, false, 1 + i % 9, 2.5);
+        outcome.correct_prediction = true;
+        recorded.push_back(outcome.features);
+        learner.recordOutcome(outcome);
+    }
+
+    CombinedFeatures query = features_system.extractAllFeatures(
+        1005.0, 12, 180, 5000, 15, 7000, 150, 1, true, true, 1200, 0.2, false, false, 5, 2.5);
+    std::vector<double> expected;
+    for (const auto& features : recorded) {
+        expected.push_back(learner.calculateFeatureSimilarity(query, features));
+    }
+    std::sort(expected.begin(), expected.end(), std::greater<double>());
+
+    auto similar = learner.findSimilarHistoricalCases(query, 5);
+    ASSERT_EQ(similar.size(), 5u);
+    for (size_t i = 0; i < similar.size(); ++i) {
+        EXPECT_NEAR(learner.calculateFeatureSimilarity(query, similar[i].features), expected[i], 1e-12) << i;
+    }
+}
+
+// Test: Accuracy, trend and z-scores follow the retained history once it is past capacity
+TEST(MLLearningTest, RunningMetrics) {
+    MLLearningSystem learner;
+    MLFeatures features_system;
+
+    // Past the history capacity, so the oldest outcomes have been dropped
+    const int total = 10150;
+    std::vector<bool> correct;
+    std::vector<std::vector<double>> flattened;
+    for (int i = 0; i < total; ++i) {
+        LearningOutcome outcome;
+        outcome.features = features_system.extractAllFeatures(
+            990.0 + (i % 41), 5 + i % 23, 180, 5000, 15,
+            6000, 150, 0, true, true, 1000, 0, false, false, 5, 2.5);
+        outcome.correct_prediction = i < 6000 ? i % 3 != 0 : i % 5 != 0;
+        correct.push_back(outcome.correct_prediction);
+        flattened.push_back(outcome.features.flatten());
+        learner.recordOutcome(outcome);
+    }
+
+    int recent_correct = 0;
+    for (int i = total - 100; i < total; ++i) recent_correct += correct[i];
+    int old_correct = 0, new_correct = 0;
+    for (int i = total - 10000; i < total - 5000; ++i) old_correct += correct[i];
+    for (int i = total - 5000; i < total; ++i) new_correct += correct[i];
+
+    EXPECT_NEAR(learner.getAccuracyMetrics().recent_accuracy, recent_correct / 100.0, 1e-12);
+    EXPECT_NEAR(learner.getAccuracyTrend(), (new_correct - old_correct) / 5000.0, 1e-12);
+    EXPECT_EQ(learner.getLearningStatistics().total_flights_learned, 10000);
+
+    // Feature statistics over the last 100 outcomes
+    std::vector<double> probe = flattened[total - 7];
+    probe[0] += 0.5;
+    double mean = 0.0, m2 = 0.0;
+    for (int i = total - 100; i < total; ++i) mean += flattened[i][0] / 100.0;
+    for (int i = total - 100; i < total; ++i) m2 += (flattened[i][0] - mean) * (flattened[i][0] - mean);
+    double expected_z = (probe[0] - mean) / std::sqrt(m2 / 99.0);
+    auto stats = learner.performAnomalyDetection(probe);
+    ASSERT_EQ(stats.z_scores.size(), probe.size());
+    EXPECT_NEAR(stats.z_scores[0], expected_z, 1e-6);
+
+    // Clearing resets the running statistics
+    learner.clearHistory();
+    EXPECT_EQ(learner.getAccuracyTrend(), 0.0);
+    EXPECT_TRUE(learner.performAnomalyDetection(probe).z_scores.empty());
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "../../include/ml_features.hpp"
+#include "../../include/ml_inference.hpp"
+#include "../../include/ml_models.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace AICopilot::ML;
+
+// Test: One pass over the models gives the same scores as asking each model in turn
+TEST(MLModelsTest, ScoreAllMatchesModels) {
+    ModelManager manager;
+    manager.initialize();
+
+    MLFeatures features_system;
+    CombinedFeatures features = features_system.extractAllFeatures(
+        1005, 18, 220, 3000, 15,
+        8000, 150, 1, true, true,
+        500, 2, true, false, 6, 3.0);
+    std::vector<double> anomalies = {0.7, 0.2, 0.9};
+
+    ModelManager::AllScores scores = manager.scoreAll(features, 8, 400, 900, anomalies);
+    auto assessment = manager.getEmergencyModel().assessEmergency(features, anomalies);
+    EXPECT_EQ(scores.runway, manager.getRunwayModel().scoreRunway(features, 0).prediction);
+    EXPECT_EQ(scores.approach_safety,
+              manager.getApproachModel().scoreApproachSafety(features, 8, 400, 900).prediction);
+    EXPECT_EQ(scores.approach_success, manager.getApproachModel().predictApproachSuccessProbability(features, 8));
+    EXPECT_EQ(scores.go_around, manager.getApproachModel().shouldGoAround(features, 400, 900));
+    EXPECT_EQ(scores.route, manager.getRouteModel().scoreRoute(features, {}).prediction);
+    EXPECT_EQ(scores.emergency_type, assessment.detected_type);
+    EXPECT_EQ(scores.emergency_certainty, assessment.certainty);
+}
+
+// Test: Background training publishes new model sets atomically, rejects regressions and rolls back
+TEST(MLModelsTest, BackgroundTraining) {
+    ModelManager manager;
+    manager.initialize();
+
+    MLFeatures features_system;
+    std::vector<TrainingSample> good;
+    std::vector<TrainingSample> bad;
+    for (int i = 0; i < 20; ++i) {
+        TrainingSample sample;
+        sample.features = features_system.extractAllFeatures(
+            1000 + i, 5 + i, 200, 2000 + 400 * i, 15,
+            7000, 150, i % 3, true, true, 500, 1, false, false, 5, 2.5);
+        sample.label = RunwaySelectionModel::score(sample.features);
+        sample.weight = 1.0;
+        good.push_back(sample);
+        sample.label = sample.label > 0.5 ? 0.0 : 1.0;
+        bad.push_back(sample);
+    }
+
+    // Trained models are swapped in without touching the old set
+    std::shared_ptr<const ModelManager::ModelSet> initial = manager.getModels();
+    manager.startTraining();
+    EXPECT_TRUE(manager.submitTraining(good));
+    manager.waitTrainingIdle();
+    EXPECT_EQ(manager.getModelVersion(), 1u);
+    EXPECT_EQ(manager.getRunwayModel().getAccuracy(), 1.0);
+    EXPECT_EQ(initial->version, 0u);
+    EXPECT_EQ(initial->runway.getMetrics().samples_tested, 0);
+
+    // A candidate whose accuracy regresses is discarded
+    manager.submitTraining(bad);
+    manager.waitTrainingIdle();
+    EXPECT_EQ(manager.getModelVersion(), 1u);
+    EXPECT_EQ(manager.getTrainingStats().rejected, 1u);
+
+    // Rollback restores the models replaced by the last publish
+    manager.submitTraining(good);
+    manager.waitTrainingIdle();
+    manager.stopTraining();
+    EXPECT_EQ(manager.getModelVersion(), 2u);
+    EXPECT_TRUE(manager.rollbackModels());
+    EXPECT_EQ(manager.getModelVersion(), 1u);
+
+    ModelManager::TrainingStats stats = manager.getTrainingStats();
+    EXPECT_EQ(stats.submitted, 3u);
+    EXPECT_EQ(stats.published, 2u);
+    EXPECT_EQ(stats.rollbacks, 1u);
+    EXPECT_EQ(stats.pending, 0u);
+}
+
+// Test: An int8 MLP backend tracks its float model, batches like single rows, and can be cleared
+TEST(MLModelsTest, InferenceBackends) {
+    ModelManager manager;
+    manager.initialize();
+
+    MLFeatures features_system;
+    std::vector<CombinedFeatures> rows;
+    for (int i = 0; i < 50; ++i) {
+        rows.push_back(features_system.extractAllFeatures(
+            1000 + i, 5 + i % 20, 200, 2000 + 150 * i, 15,
+            7000, 150, i % 3, true, true, 500, 1, false, false, 5, 2.5));
+    }
+
+    // Without a backend predictions are the built-in scores
+    std::vector<ModelPrediction> predictions;
+    manager.predictBatch(ModelManager::RUNWAY_BACKEND, rows, predictions);
+    EXPECT_EQ(manager.getBackendName(ModelManager::RUNWAY_BACKEND), "builtin");
+    ASSERT_EQ(predictions.size(), rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        EXPECT_EQ(predictions[i].prediction, RunwaySelectionModel::score(rows[i])) << i;
+    }
+
+    // Float reference: FeatureLayout::COUNT -> 8 ReLU -> 1 sigmoid
+    const size_t inputs = FeatureLayout::COUNT;
+    const size_t hidden = 8;
+    std::vector<float> w1(hidden * inputs), b1(hidden), w2(hidden), b2(1, -0.2f);
+    for (size_t i = 0; i < w1.size(); ++i) w1[i] = std::sin(0.7f * i) * 0.05f;
+    for (size_t i = 0; i < hidden; ++i) b1[i] = 0.01f * i;
+    for (size_t i = 0; i < hidden; ++i) w2[i] = std::cos(1.3f * i);
+    auto reference = [&](const CombinedFeatures& f) {
+        std::vector<double> x = f.flatten();
+        double out = b2[0];
+        for (size_t h = 0; h < hidden; ++h) {
+            double acc = b1[h];
+            for (size_t i = 0; i < inputs; ++i) acc += w1[h * inputs + i] * x[i];
+            out += w2[h] * std::max(0.0, acc);
+        }
+        return 1.0 / (1.0 + std::exp(-out));
+    };
+
+    auto mlp = std::make_shared<QuantizedMLPBackend>();
+    mlp->addLayer(QuantizedMLPBackend::quantize(w1, b1, inputs, hidden, QuantizedMLPBackend::RELU));
+    mlp->addLayer(QuantizedMLPBackend::quantize(w2, b2, hidden, 1, QuantizedMLPBackend::SIGMOID));
+    EXPECT_TRUE(manager.setBackend(ModelManager::RUNWAY_BACKEND, mlp));
+    EXPECT_EQ(manager.getBackendName(ModelManager::RUNWAY_BACKEND), "int8-mlp");
+
+    // A backend with the wrong input size is rejected
+    auto narrow = std::make_shared<QuantizedMLPBackend>();
+    narrow->addLayer(QuantizedMLPBackend::quantize(w2, b2, hidden, 1, QuantizedMLPBackend::LINEAR));
+    EXPECT_FALSE(manager.setBackend(ModelManager::ROUTE_BACKEND, narrow));
+    EXPECT_EQ(manager.getBackendName(ModelManager::ROUTE_BACKEND), "builtin");
+
+    for (const CombinedFeatures& f : rows) {
+        EXPECT_NEAR(manager.predict(ModelManager::RUNWAY_BACKEND, f).prediction, reference(f), 0.02);
+    }
+
+    // Batched and threaded runs give the same numbers as one row at a time
+    InferenceConfig config;
+    config.max_batch_size = 7;
+    config.worker_threads = 3;
+    manager.setInferenceConfig(config);
+    manager.predictBatch(ModelManager::RUNWAY_BACKEND, rows, predictions);
+    ASSERT_EQ(predictions.size(), rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        ModelPrediction single = manager.predict(ModelManager::RUNWAY_BACKEND, rows[i]);
+        EXPECT_EQ(predictions[i].prediction, single.prediction) << i;
+        EXPECT_EQ(predictions[i].confidence, single.confidence) << i;
+        EXPECT_TRUE(predictions[i].success) << i;
+    }
+
+    // Clearing the backend restores built-in scoring
+    manager.setBackend(ModelManager::RUNWAY_BACKEND, nullptr);
+    EXPECT_EQ(manager.predict(ModelManager::RUNWAY_BACKEND, rows[0]).prediction,
+              RunwaySelectionModel::score(rows[0]));
+
+#ifndef ENABLE_ONNXRUNTIME
+    EXPECT_EQ(createOnnxBackend("missing.onnx", config), nullptr);
+#endif
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "../../include/model_pack.hpp"
+#include "../../include/ml_decision_system.h"
+#include "../../include/ml_learning.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace AICopilot;
+
+namespace {
+
+DecisionContext makeContext(FlightPhase phase, double ias) {
+    DecisionContext ctx{};
+    ctx.phase = phase;
+    ctx.state.position = {40.0, -74.0, 2000.0, 180.0};
+    ctx.state.indicatedAirspeed = ias;
+    ctx.state.groundSpeed = ias - 10.0;
+    ctx.state.onGround = false;
+    ctx.atcOptions = {"Descend", "Maintain", "Climb"};
+    return ctx;
+}
+
+} // namespace
+
+// Test: Training examples survive a pack round trip and vote the same afterwards
+TEST(ModelPackTest, DecisionModelRoundTrip) {
+    MLDecisionSystem ml;
+    ml.initialize();
+    for (int i = 0; i < 40; ++i) {
+        TrainingData data;
+        data.context = makeContext(i % 2 ? FlightPhase::APPROACH : FlightPhase::CRUISE, 120.0 + i);
+        data.correctOption = i % 3;
+        data.reward = 0.5 * i;
+        ml.trainWithFeedback(data);
+    }
+
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_model_pack";
+    std::filesystem::create_directories(dir);
+    auto path = (dir / "decision.aimp").string();
+    ASSERT_TRUE(ml.saveModel(path));
+    ASSERT_TRUE(ModelPack::isPackFile(path));
+
+    ModelPack pack;
+    ASSERT_TRUE(pack.open(path));
+    EXPECT_TRUE(pack.isMapped());
+    ASSERT_EQ(pack.getExampleCount(), 40u);
+    EXPECT_EQ(pack.getExample(5).correctOption, 2);
+    EXPECT_DOUBLE_EQ(pack.getExample(5).reward, 2.5);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(pack.getExampleFeatures(1)) % alignof(double), 0u);
+    DecisionFeatureVector features;
+    ml.extractFeatures(makeContext(FlightPhase::APPROACH, 125.0), features);
+    EXPECT_EQ(std::memcmp(pack.getExampleFeatures(5), features.data(), sizeof(features)), 0);
+    EXPECT_FALSE(pack.hasLearningState());
+
+    // Two instances loading one mapping agree with the original
+    MLDecisionSystem first;
+    MLDecisionSystem second;
+    first.initialize();
+    second.initialize();
+    ASSERT_TRUE(first.loadModel(pack));
+    ASSERT_TRUE(second.loadModel(path));
+    EXPECT_EQ(first.getTrainingDataCount(), 40u);
+    DecisionContext query = makeContext(FlightPhase::APPROACH, 130.0);
+    for (int option = 0; option < 3; ++option) {
+        EXPECT_DOUBLE_EQ(first.getConfidence(query, option), ml.getConfidence(query, option));
+        EXPECT_DOUBLE_EQ(second.getConfidence(query, option), ml.getConfidence(query, option));
+    }
+
+    // A loaded model saves back to the same bytes
+    auto copy = (dir / "copy.aimp").string();
+    ASSERT_TRUE(first.saveModel(copy));
+    ModelPack reopened;
+    ASSERT_TRUE(reopened.open(copy));
+    EXPECT_EQ(reopened.getSize(), pack.getSize());
+    EXPECT_EQ(std::memcmp(reopened.getExampleFeatures(0), pack.getExampleFeatures(0),
+                          40 * DecisionFeatureLayout::COUNT * sizeof(double)), 0);
+
+    EXPECT_FALSE(first.loadModel((dir / "missing.aimp").string()));
+    EXPECT_EQ(first.getTrainingDataCount(), 40u);
+    std::filesystem::remove_all(dir);
+}
+
+// Test: Corrupted images and packs from another feature schema are rejected
+TEST(ModelPackTest, RejectsCorruptAndForeignPacks) {
+    ModelPackBuilder builder;
+    double row[DecisionFeatureLayout::COUNT] = {0.5};
+    builder.addExample(row, {3, 1, 1.0});
+    builder.setLearningState({10, 8, 0.8});
+
+    ModelPack pack;
+    ASSERT_TRUE(pack.openImage(builder.build()));
+    EXPECT_FALSE(pack.isMapped());
+    ASSERT_TRUE(pack.hasLearningState());
+    EXPECT_EQ(pack.getLearningState().correctPredictions, 8);
+    EXPECT_EQ(pack.getFeatureStatsCount(), 0u);
+
+    std::vector<uint8_t> image = builder.build();
+    image.back() ^= 0x5A;
+    EXPECT_FALSE(pack.openImage(image));
+    EXPECT_FALSE(pack.isOpen());
+
+    image = builder.build();
+    image.resize(image.size() - 8);
+    EXPECT_FALSE(pack.openImage(image));
+
+    // A different schema hash, with a checksum that still matches
+    image = builder.build();
+    ModelPackHeader header;
+    std::memcpy(&header, image.data(), sizeof(header));
+    header.schemaHash ^= 1;
+    std::memcpy(image.data(), &header, sizeof(header));
+    EXPECT_FALSE(pack.openImage(image));
+}
+
+// Test: Learning counters and feature statistics are restored from a pack
+TEST(ModelPackTest, LearningStateRoundTrip) {
+    ML::MLFeatures featureSystem;
+    ML::MLLearningSystem learner;
+    for (int i = 0; i < 30; ++i) {
+        ML::LearningOutcome outcome;
+        outcome.features = featureSystem.extractAllFeatures(
+            1000 + i, 5 + i, 180, 5000, 15, 6000, 150, 0, true, true, 1000, 0, false, false, 5, 2.5);
+        outcome.correct_prediction = i % 4 != 0;
+        learner.updateModelWithFeedback(outcome);
+    }
+    std::vector<double> probe = featureSystem.extractAllFeatures(
+        1040, 30, 180, 5000, 15, 6000, 150, 0, true, true, 1000, 0, false, false, 5, 2.5).flatten();
+    auto before = learner.performAnomalyDetection(probe);
+
+    auto path = (std::filesystem::temp_directory_path() / "aicopilot_learning.aimp").string();
+    ASSERT_TRUE(learner.saveLearningState(path));
+
+    ML::MLLearningSystem restored;
+    ASSERT_TRUE(restored.loadLearningState(path));
+    ML::AccuracyMetrics metrics = restored.getAccuracyMetrics();
+    EXPECT_EQ(metrics.total_samples, 30);
+    EXPECT_EQ(metrics.correct_predictions, 22);
+    EXPECT_DOUBLE_EQ(metrics.overall_accuracy, learner.getAccuracyMetrics().overall_accuracy);
+
+    auto after = restored.performAnomalyDetection(probe);
+    ASSERT_EQ(after.z_scores.size(), before.z_scores.size());
+    for (size_t i = 0; i < after.z_scores.size(); ++i) {
+        EXPECT_DOUBLE_EQ(after.z_scores[i], before.z_scores[i]);
+    }
+    EXPECT_EQ(after.is_anomaly, before.is_anomaly);
+    std::filesystem::remove(path);
+}
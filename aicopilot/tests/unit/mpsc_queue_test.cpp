@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "../../include/mpsc_queue.hpp"
+#include "../../include/airport_integration.hpp"
+#include "../../include/headless_sim.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+// Test: Values come out in push order and the capacity is a power of two
+TEST(MpscQueueTest, FifoOrder) {
+    MpscQueue<std::string> queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);
+    std::string out;
+    EXPECT_FALSE(queue.pop(out));
+
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 6; ++i) EXPECT_TRUE(queue.push(std::to_string(round * 10 + i)));
+        for (int i = 0; i < 6; ++i) {
+            ASSERT_TRUE(queue.pop(out));
+            EXPECT_EQ(out, std::to_string(round * 10 + i));
+        }
+        EXPECT_FALSE(queue.pop(out));
+    }
+}
+
+// Test: A full queue refuses pushes and counts them instead of waiting
+TEST(MpscQueueTest, FullQueueDrops) {
+    MpscQueue<int> queue(4);
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(queue.push(i));
+    int value = 99;
+    EXPECT_FALSE(queue.push(std::move(value)));
+    EXPECT_EQ(value, 99);
+    EXPECT_EQ(queue.dropped(), 1u);
+
+    int out = -1;
+    ASSERT_TRUE(queue.pop(out));
+    EXPECT_EQ(out, 0);
+    EXPECT_TRUE(queue.push(4));
+    EXPECT_EQ(queue.dropped(), 1u);
+}
+
+// Test: Concurrent producers lose nothing and keep their own order
+TEST(MpscQueueTest, ConcurrentProducers) {
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 20000;
+    MpscQueue<int> queue(64);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < kPerProducer; ++i) {
+                while (!queue.push(p * kPerProducer + i)) std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<int> next(kProducers, 0);
+    int received = 0;
+    while (received < kProducers * kPerProducer) {
+        int value = 0;
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = value / kPerProducer;
+        ASSERT_EQ(value % kPerProducer, next[producer]);
+        next[producer]++;
+        received++;
+    }
+    for (auto& thread : producers) thread.join();
+    int out = 0;
+    EXPECT_FALSE(queue.pop(out));
+}
+
+// Test: Bridge commands from many threads merge per aircraft on the dispatch thread
+TEST(MpscQueueTest, BridgeMergesQueuedCommands) {
+    auto sim = std::make_shared<HeadlessSimConnect>(HeadlessSimConfig());
+    ASSERT_TRUE(sim->connect(SimulatorType::MSFS2024));
+    Integration::SimConnectBridge bridge(sim);
+    EXPECT_EQ(bridge.get_user_aircraft_state().aircraft_id, -1);
+
+    EXPECT_TRUE(bridge.transmit_taxi_clearance(7, {1, 2, 3}));
+    EXPECT_TRUE(bridge.transmit_altitude_clearance(7, 5000.0));
+    EXPECT_TRUE(bridge.transmit_heading_instruction(7, 270.0));
+    EXPECT_FALSE(bridge.transmit_taxi_clearance(7, {}));
+    // Readers see commands only once the dispatch thread has applied them
+    EXPECT_FALSE(bridge.get_last_ai_command(7).has_value());
+    sim->processMessages();
+    auto command = bridge.get_last_ai_command(7);
+    ASSERT_TRUE(command.has_value());
+    EXPECT_EQ(command->taxiway_route, (std::vector<int>{1, 2, 3}));
+    EXPECT_DOUBLE_EQ(command->target_altitude_feet.value_or(0.0), 5000.0);
+    EXPECT_DOUBLE_EQ(command->target_heading_true.value_or(0.0), 270.0);
+
+    // A new taxi clearance starts the command over
+    EXPECT_TRUE(bridge.transmit_taxi_clearance(7, {4}));
+    sim->processMessages();
+    command = bridge.get_last_ai_command(7);
+    EXPECT_EQ(command->taxiway_route, (std::vector<int>{4}));
+    EXPECT_FALSE(command->target_altitude_feet.has_value());
+    EXPECT_FALSE(bridge.get_last_ai_command(8).has_value());
+
+    // 200 commands fit the queue even if nothing drains until the end
+    std::vector<std::thread> senders;
+    for (int aircraft = 10; aircraft < 14; ++aircraft) {
+        senders.emplace_back([&bridge, aircraft]() {
+            for (int i = 0; i < 50; ++i) EXPECT_TRUE(bridge.transmit_altitude_clearance(aircraft, 1000.0 * i));
+        });
+    }
+    for (auto& thread : senders) thread.join();
+    sim->processMessages();
+    EXPECT_EQ(bridge.get_dropped_command_count(), 0u);
+    for (int aircraft = 10; aircraft < 14; ++aircraft) {
+        EXPECT_DOUBLE_EQ(bridge.get_last_ai_command(aircraft)->target_altitude_feet.value_or(0.0), 49000.0);
+    }
+}
+
+// Test: A full bridge queue refuses commands so the sender can retry
+TEST(MpscQueueTest, BridgeRefusesCommandsWhenFull) {
+    auto sim = std::make_shared<HeadlessSimConnect>(HeadlessSimConfig());
+    ASSERT_TRUE(sim->connect(SimulatorType::MSFS2024));
+    Integration::SimConnectBridge bridge(sim);
+
+    // Nothing drains while the sim is paused
+    size_t accepted = 0;
+    while (bridge.transmit_taxi_clearance(7, {static_cast<int>(accepted)})) {
+        accepted++;
+        ASSERT_LT(accepted, 10000u);
+    }
+    EXPECT_GE(accepted, 1u);
+    EXPECT_EQ(bridge.get_dropped_command_count(), 1u);
+    EXPECT_FALSE(bridge.transmit_altitude_clearance(7, 9000.0));
+    EXPECT_EQ(bridge.get_dropped_command_count(), 2u);
+
+    // The refused commands were not recorded; the last accepted one was
+    sim->processMessages();
+    auto command = bridge.get_last_ai_command(7);
+    ASSERT_TRUE(command.has_value());
+    EXPECT_EQ(command->taxiway_route, (std::vector<int>{static_cast<int>(accepted - 1)}));
+    EXPECT_FALSE(command->target_altitude_feet.has_value());
+
+    // Once drained a retry goes through
+    EXPECT_TRUE(bridge.transmit_altitude_clearance(7, 9000.0));
+    sim->processMessages();
+    EXPECT_DOUBLE_EQ(bridge.get_last_ai_command(7)->target_altitude_feet.value_or(0.0), 9000.0);
+
+    // Senders that retry on refusal lose nothing, even far past the capacity
+    std::atomic<int> running{4};
+    std::vector<std::thread> senders;
+    for (int aircraft = 10; aircraft < 14; ++aircraft) {
+        senders.emplace_back([&bridge, &running, aircraft]() {
+            for (int i = 0; i < 500; ++i) {
+                while (!bridge.transmit_altitude_clearance(aircraft, 100.0 * i)) std::this_thread::yield();
+            }
+            running--;
+        });
+    }
+    while (running.load() > 0) {
+        sim->processMessages();
+        std::this_thread::yield();
+    }
+    for (auto& thread : senders) thread.join();
+    sim->processMessages();
+    for (int aircraft = 10; aircraft < 14; ++aircraft) {
+        EXPECT_DOUBLE_EQ(bridge.get_last_ai_command(aircraft)->target_altitude_feet.value_or(0.0), 49900.0);
+    }
+}
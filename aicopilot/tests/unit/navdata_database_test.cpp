@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "../../include/navdata_database.hpp"
+#include "../../include/navdata_pack.hpp"
+#include <atomic>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+class NavigationDatabaseTest : public ::testing::Test {
+protected:
+    NavigationDatabase db_;
+};
+
+} // namespace
+
+// Test: Nearest-first results agree with distances and the radius search
+TEST_F(NavigationDatabaseTest, GetNearestWaypoints) {
+    // The closest fix to JFK's own coordinates is JFK
+    auto nearest = db_.GetNearestWaypoints(40.6413, -73.7781, 5);
+    ASSERT_EQ(nearest.size(), 5u);
+    EXPECT_EQ(nearest[0].name, "KJFK");
+
+    // Nearest first, and consistent with the radius search
+    double previous = 0.0;
+    for (const auto& wp : nearest) {
+        double d = db_.CalculateDistanceCoordinates(40.6413, -73.7781, wp.latitude, wp.longitude);
+        EXPECT_GE(d, previous - 1e-9);
+        previous = d;
+    }
+    EXPECT_GE(db_.GetWaypointsNearby(40.6413, -73.7781, previous).size(), nearest.size());
+
+    EXPECT_TRUE(db_.GetNearestWaypoints(40.6413, -73.7781, 5, 0.001).size() <= 1u);
+}
+
+// Test: Only airways with the two fixes adjacent connect them, in either order
+TEST_F(NavigationDatabaseTest, GetConnectingAirways) {
+    // KJFK and KUJOE are consecutive on V1, in either order
+    auto forward = db_.GetConnectingAirways("KJFK", "KUJOE");
+    ASSERT_EQ(forward.size(), 1u);
+    EXPECT_EQ(forward[0].name, "V1");
+    EXPECT_EQ(db_.GetConnectingAirways("KUJOE", "KJFK").size(), 1u);
+
+    // On V1 but not adjacent, and unknown fixes
+    EXPECT_TRUE(db_.GetConnectingAirways("KJFK", "MORRY").empty());
+    EXPECT_TRUE(db_.GetConnectingAirways("KJFK", "NOSUCHFIX").empty());
+    EXPECT_TRUE(db_.ValidateWaypointConnectivity({"KJFK", "KUJOE", "ELLOS"}, 5000));
+}
+
+// Test: A saved snapshot loads back whole, and a pack compiled elsewhere replaces the data
+TEST_F(NavigationDatabaseTest, SnapshotRoundTrip) {
+    auto path = (std::filesystem::temp_directory_path() / "aicopilot_navdb_snapshot.anp").string();
+    ASSERT_TRUE(db_.SaveSnapshot(path));
+
+    NavigationDatabase loaded;
+    ASSERT_TRUE(loaded.LoadSnapshot(path));
+    EXPECT_EQ(loaded.GetWaypointCount(), db_.GetWaypointCount());
+    EXPECT_EQ(loaded.GetAirwayCount(), db_.GetAirwayCount());
+    EXPECT_EQ(loaded.GetConnectingAirways("KJFK", "KUJOE").size(), 1u);
+
+    // A cycle compiled elsewhere replaces the waypoints and airways
+    NavdataPackBuilder builder;
+    builder.setAiracCycle(2510);
+    builder.putWaypoint(NavdataWaypoint("ZZZZZ", 10.0, 20.0, NavaidType::FIX, 0, 0, "TEST"));
+    ASSERT_TRUE(builder.write(path));
+    ASSERT_TRUE(loaded.LoadSnapshot(path));
+    EXPECT_EQ(loaded.GetAiracCycle(), 2510u);
+    EXPECT_EQ(loaded.GetWaypointCount(), 1);
+    EXPECT_FALSE(loaded.GetWaypoint("KJFK").has_value());
+    EXPECT_TRUE(loaded.GetWaypoint("ZZZZZ").has_value());
+    EXPECT_FALSE(loaded.LoadSnapshot(path + ".missing"));
+    EXPECT_EQ(loaded.GetWaypointCount(), 1);
+
+    std::filesystem::remove(path);
+}
+
+// Test: Readers see one complete version across asynchronous snapshot swaps
+TEST_F(NavigationDatabaseTest, SnapshotSwapUnderReaders) {
+    auto path = (std::filesystem::temp_directory_path() / "aicopilot_navdb_swap.anp").string();
+    ASSERT_TRUE(db_.SaveSnapshot(path));
+    NavigationDatabase db;
+    const int waypoints = db.GetWaypointCount();
+
+    // Every read sees one complete version, before or after each swap
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                if (!db.GetWaypoint("KJFK") || db.GetWaypointCount() != waypoints ||
+                    db.GetConnectingAirways("KJFK", "KUJOE").size() != 1u) {
+                    torn++;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(db.LoadSnapshotAsync(path).get());
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(db.GetSIDCount(), db_.GetSIDCount());  // procedures carry over to the new version
+    std::filesystem::remove(path);
+}
+
+// Test: Repeated route queries hit the cache and return the same route
+TEST_F(NavigationDatabaseTest, RouteCacheStatistics) {
+    NavigationDatabase db;
+    auto first = db.FindRoute("KJFK", "KUJOE", 5000);
+    auto second = db.FindRoute("KJFK", "KUJOE", 5000);
+    EXPECT_EQ(first.waypointSequence, second.waypointSequence);
+    EXPECT_DOUBLE_EQ(first.totalDistance, second.totalDistance);
+    EXPECT_EQ(first.routeDescription, second.routeDescription);
+
+    auto stats = db.GetStatistics();
+    EXPECT_EQ(stats.routeCacheMisses, 1u);
+    EXPECT_EQ(stats.routeCacheHits, 1u);
+    EXPECT_EQ(stats.routeCacheEntries, 1u);
+    EXPECT_DOUBLE_EQ(stats.routeCacheHitRate, 0.5);
+
+    // A different altitude is a different query
+    db.FindRoute("KJFK", "KUJOE", 25000);
+    EXPECT_EQ(db.GetStatistics().routeCacheMisses, 2u);
+    EXPECT_FALSE(db.FindRoute("KJFK", "NOSUCHFIX", 5000).success);
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include "../../include/navdata_pack.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace AICopilot;
+
+namespace {
+
+NavdataPackBuilder makeBuilder() {
+    NavdataPackBuilder builder;
+    builder.setAiracCycle(2510);
+    builder.putWaypoint(NavdataWaypoint("KJFK", 40.6413, -73.7781, NavaidType::AIRPORT, 13, 0, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("KUJOE", 40.7920, -73.8917, NavaidType::FIX, 0, 0, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("ELLOS", 40.5275, -74.2733, NavaidType::VOR, 0, 110.2, "NORTHEAST"));
+    builder.putWaypoint(NavdataWaypoint("LFPG", 49.0127, 2.5502, NavaidType::AIRPORT, 382, 0, "EUROPE"));
+    builder.putWaypoint(NavdataWaypoint("KUJOE", 40.7921, -73.8917, NavaidType::FIX, 0, 0, "NORTHEAST"));
+
+    Airway v1("V1", 1200, 18000, AirwayLevel::LOW);
+    v1.waypointSequence = {"KJFK", "KUJOE", "NOWHERE", "ELLOS"};
+    builder.putAirway(v1);
+    Airway j500("J500", 18000, 45000, AirwayLevel::HIGH);
+    j500.waypointSequence = {"KJFK", "KUJOE"};
+    builder.putAirway(j500);
+    return builder;
+}
+
+} // namespace
+
+// Test: Records, names and airway sequences survive compilation
+TEST(NavdataPackTest, RoundTripsRecords) {
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(makeBuilder().build()));
+    EXPECT_FALSE(pack.isMapped());
+    EXPECT_EQ(pack.getAiracCycle(), 2510u);
+    EXPECT_EQ(pack.getWaypointCount(), 4u);  // the repeated KUJOE replaced the first
+    EXPECT_EQ(pack.getAirwayCount(), 2u);
+
+    uint32_t ujoe = pack.findWaypoint("KUJOE");
+    ASSERT_NE(ujoe, NavdataPack::NO_INDEX);
+    NavdataWaypoint wp = pack.getWaypoint(ujoe);
+    EXPECT_EQ(wp.name, "KUJOE");
+    EXPECT_DOUBLE_EQ(wp.latitude, 40.7921);
+    EXPECT_EQ(wp.type, NavaidType::FIX);
+    EXPECT_EQ(wp.region, "NORTHEAST");
+    EXPECT_EQ(pack.findWaypoint("BOUND"), NavdataPack::NO_INDEX);
+
+    uint32_t v1 = pack.findAirway("V1");
+    ASSERT_NE(v1, NavdataPack::NO_INDEX);
+    Airway airway = pack.getAirway(v1);
+    EXPECT_EQ(airway.waypointSequence, (std::vector<std::string>{"KJFK", "KUJOE", "NOWHERE", "ELLOS"}));
+    EXPECT_EQ(airway.maximumAltitude, 18000);
+    EXPECT_EQ(pack.getAirwayFixes(v1)[2].waypoint, NavdataPack::NO_INDEX);
+    EXPECT_GT(pack.getAirwayRecord(v1).totalDistanceNM, 0.0);
+    EXPECT_NEAR(airway.GetTotalDistance(), pack.getAirwayRecord(v1).totalDistanceNM, 1e-9);
+    EXPECT_EQ(pack.findAirway("J999"), NavdataPack::NO_INDEX);
+}
+
+// Test: The edge list links consecutive known fixes only, in both directions
+TEST(NavdataPackTest, BuildsAirwayGraph) {
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(makeBuilder().build()));
+    uint32_t jfk = pack.findWaypoint("KJFK");
+    uint32_t ujoe = pack.findWaypoint("KUJOE");
+    uint32_t ellos = pack.findWaypoint("ELLOS");
+
+    int jfkToUjoe = 0;
+    for (const NavdataPackEdge* e = pack.edgesBegin(jfk); e != pack.edgesEnd(jfk); ++e) {
+        EXPECT_EQ(e->to, ujoe);
+        jfkToUjoe++;
+    }
+    EXPECT_EQ(jfkToUjoe, 2);  // V1 and J500
+    EXPECT_EQ(pack.edgesBegin(ellos), pack.edgesEnd(ellos));  // NOWHERE breaks the chain
+    EXPECT_EQ(pack.edgesEnd(ujoe) - pack.edgesBegin(ujoe), 2);
+}
+
+// Test: The spatial index is usable straight from the pack
+TEST(NavdataPackTest, SpatialIndexAttached) {
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(makeBuilder().build()));
+    std::vector<WaypointIndex::Match> matches;
+    pack.getSpatialIndex().queryRadius(40.7, -73.9, 30.0, matches);
+    EXPECT_EQ(matches.size(), 3u);  // everything but LFPG
+    for (const auto& match : matches) EXPECT_NE(pack.getWaypoint(match.id).name, "LFPG");
+
+    matches.clear();
+    pack.getSpatialIndex().queryNearest(49.0, 2.5, 1, matches);
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(pack.getWaypoint(matches[0].id).name, "LFPG");
+}
+
+// Test: Files are mapped, and corrupted or truncated files are rejected
+TEST(NavdataPackTest, OpenValidatesFiles) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_navdata_pack";
+    std::filesystem::create_directories(dir);
+    auto path = (dir / "cycle.anp").string();
+    ASSERT_TRUE(makeBuilder().write(path));
+
+    {
+        NavdataPack pack;
+        ASSERT_TRUE(NavdataPack::isPackFile(path));
+        ASSERT_TRUE(pack.open(path));
+        EXPECT_TRUE(pack.isMapped());
+        EXPECT_NE(pack.findWaypoint("LFPG"), NavdataPack::NO_INDEX);
+
+        auto copy = (dir / "copy.anp").string();
+        ASSERT_TRUE(pack.save(copy));
+        NavdataPack reopened;
+        EXPECT_TRUE(reopened.open(copy));
+        EXPECT_EQ(reopened.getSize(), pack.getSize());
+    }
+
+    std::vector<uint8_t> image = makeBuilder().build();
+    image[image.size() - 1] ^= 0x5A;
+    NavdataPack corrupt;
+    EXPECT_FALSE(corrupt.openImage(image));
+    EXPECT_FALSE(corrupt.isOpen());
+
+    image = makeBuilder().build();
+    image.resize(image.size() - 8);
+    EXPECT_FALSE(corrupt.openImage(image));
+
+    std::ofstream(dir / "garbage.anp") << "not a pack";
+    EXPECT_FALSE(NavdataPack::isPackFile((dir / "garbage.anp").string()));
+    EXPECT_FALSE(corrupt.open((dir / "garbage.anp").string()));
+
+    std::filesystem::remove_all(dir);
+}
+
+// Test: Packed records keep every field to its stored precision
+TEST(NavdataPackTest, PackedWaypointPrecision) {
+    NavdataWaypoint vor("SEA", 47.4353611, -122.3095833, NavaidType::VOR, 433, 116.8, "PACIFIC");
+    vor.magneticVariation = 15.27;
+    vor.range = 130;
+    vor.purpose = WaypointPurpose::HOLDING;
+    vor.isUsable = false;
+    NavdataPackBuilder builder;
+    builder.putWaypoint(vor);
+
+    NavdataPack pack;
+    ASSERT_TRUE(pack.openImage(builder.build()));
+    NavdataWaypoint wp = pack.getWaypoint(pack.findWaypoint("SEA"));
+    EXPECT_NEAR(wp.latitude, vor.latitude, 1e-7);
+    EXPECT_NEAR(wp.longitude, vor.longitude, 1e-7);
+    EXPECT_DOUBLE_EQ(wp.elevation, 433.0);
+    EXPECT_DOUBLE_EQ(wp.frequency, 116.8);
+    EXPECT_DOUBLE_EQ(wp.magneticVariation, 15.27);
+    EXPECT_DOUBLE_EQ(wp.range, 130.0);
+    EXPECT_EQ(wp.purpose, WaypointPurpose::HOLDING);
+    EXPECT_FALSE(wp.isUsable);
+    EXPECT_EQ(wp.region, "PACIFIC");
+}
+
+// Test: Views read names and coordinates in place and materialize on demand
+TEST(NavdataPackTest, WaypointViews) {
+    auto pack = std::make_shared<NavdataPack>();
+    ASSERT_TRUE(pack->openImage(makeBuilder().build()));
+    std::vector<uint32_t> nodes = {pack->findWaypoint("ELLOS"), pack->findWaypoint("KJFK")};
+    NavdataWaypointList list(pack, nodes);
+    pack.reset();  // the list keeps the pack open
+
+    ASSERT_EQ(list.size(), 2u);
+    EXPECT_EQ(list[0].name(), "ELLOS");
+    EXPECT_EQ(list[0].type(), NavaidType::VOR);
+    EXPECT_EQ(list[1].region(), "NORTHEAST");
+    EXPECT_DOUBLE_EQ(list[1].latitude(), 40.6413);
+
+    std::vector<NavdataWaypoint> waypoints = list.materialize();
+    ASSERT_EQ(waypoints.size(), 2u);
+    EXPECT_EQ(waypoints[0].name, "ELLOS");
+    EXPECT_DOUBLE_EQ(waypoints[0].frequency, 110.2);
+    EXPECT_EQ(list[1].materialize().name, "KJFK");
+}
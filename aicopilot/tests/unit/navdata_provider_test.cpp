@@ -0,0 +1,301 @@
+#include <gtest/gtest.h>
+#include "../../include/navdata_provider.h"
+#include "../../include/geodesy.hpp"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// Provider relying on the INavdataProvider batch defaults
+class SingleLookupProvider : public INavdataProvider {
+public:
+    bool initialize() override { return true; }
+    void shutdown() override {}
+    bool isReady() const override { return true; }
+
+    bool getAirportByICAO(const std::string& icao, AirportInfo& info) const override {
+        lookups++;
+        if (icao != "KJFK") return false;
+        info.icao = icao;
+        info.longestRunway = 14511;
+        return true;
+    }
+    bool getAirportLayout(const std::string&, AirportLayout&) const override { return false; }
+    std::vector<AirportInfo> getAirportsNearby(const Position&, double) const override { return {}; }
+    bool getNavaidByID(const std::string& id, NavaidInfo& info) const override {
+        info.id = "partial";  // must not leak into the batch result on a miss
+        return id == "JFK" ? (info.id = id, true) : false;
+    }
+    std::vector<NavaidInfo> getNavaidsNearby(const Position&, double, const std::string&) const override {
+        return {};
+    }
+    bool getNearestAirport(const Position&, AirportInfo&) const override { return false; }
+
+    mutable int lookups = 0;
+};
+
+AirportInfo makeAirport(const std::string& icao, const std::string& name) {
+    AirportInfo info{};
+    info.icao = icao;
+    info.name = name;
+    info.position.latitude = 34.0158;
+    info.position.longitude = -118.4513;
+    info.longestRunway = 4973;
+    info.runways = {"03", "21"};
+    return info;
+}
+
+} // namespace
+
+// Test: Batch lookups return one entry per request in order, with empty entries for misses
+TEST(NavdataProviderTest, CachedBatchLookup) {
+    CachedNavdataProvider provider;
+    ASSERT_TRUE(provider.initialize());
+
+    std::vector<AirportInfo> airports;
+    EXPECT_EQ(provider.getAirportsByICAO({"klax", "ZZZZ", "KJFK"}, airports), 2u);
+    ASSERT_EQ(airports.size(), 3u);
+    EXPECT_EQ(airports[0].icao, "KLAX");
+    EXPECT_TRUE(airports[1].icao.empty());
+    EXPECT_EQ(airports[2].icao, "KJFK");
+
+    std::vector<NavaidInfo> navaids;
+    EXPECT_EQ(provider.getNavaidsByID({"SFO", "NOPE"}, navaids), 1u);
+    ASSERT_EQ(navaids.size(), 2u);
+    EXPECT_EQ(navaids[0].type, "VOR");
+    EXPECT_TRUE(navaids[1].id.empty());
+
+    EXPECT_EQ(provider.getAirportsByICAO({}, airports), 0u);
+    EXPECT_TRUE(airports.empty());
+}
+
+// Test: Bulk adds fill the cache and skip unnamed entries
+TEST(NavdataProviderTest, CachedBulkAdd) {
+    CachedNavdataProvider provider;
+    ASSERT_TRUE(provider.initialize());
+
+    AirportInfo ksmo{};
+    ksmo.icao = "KSMO";
+    ksmo.name = "Santa Monica";
+    provider.addAirports({ksmo, AirportInfo{}});
+
+    NavaidInfo smo{};
+    smo.id = "SMO";
+    smo.type = "VOR";
+    provider.addNavaids({smo});
+
+    AirportInfo info;
+    EXPECT_TRUE(provider.getAirportByICAO("KSMO", info));
+    EXPECT_EQ(info.name, "Santa Monica");
+    AirportInfo unnamed;
+    EXPECT_FALSE(provider.getAirportByICAO("", unnamed));
+    NavaidInfo navaid;
+    EXPECT_TRUE(provider.getNavaidByID("SMO", navaid));
+}
+
+// Test: The interface default falls back to single lookups
+TEST(NavdataProviderTest, DefaultBatchUsesSingleLookups) {
+    SingleLookupProvider provider;
+    std::vector<AirportInfo> airports;
+    EXPECT_EQ(provider.getAirportsByICAO({"KJFK", "EGLL"}, airports), 1u);
+    EXPECT_EQ(provider.lookups, 2);
+    EXPECT_EQ(airports[0].longestRunway, 14511);
+    EXPECT_TRUE(airports[1].icao.empty());
+
+    std::vector<NavaidInfo> navaids;
+    EXPECT_EQ(provider.getNavaidsByID({"XXX", "JFK"}, navaids), 1u);
+    EXPECT_TRUE(navaids[0].id.empty());
+    EXPECT_EQ(navaids[1].id, "JFK");
+}
+
+// Test: Async lookups complete off the caller's thread, through futures and callbacks
+TEST(NavdataProviderTest, SimConnectAsyncLookup) {
+    SimConnectNavdataProvider provider;
+    ASSERT_TRUE(provider.initialize());
+
+    std::shared_future<AirportInfo> jfk = provider.getAirportByICAOAsync("kjfk");
+    std::shared_future<AirportInfo> again = provider.getAirportByICAOAsync("KJFK");
+    std::shared_future<AirportInfo> missing = provider.getAirportByICAOAsync("ZZZZ");
+    std::shared_future<NavaidInfo> sfo = provider.getNavaidByIDAsync("SFO");
+
+    std::promise<AirportInfo> viaCallback;
+    std::thread::id callbackThread;
+    provider.getAirportByICAOAsync("EGLL", [&](const AirportInfo& info) {
+        callbackThread = std::this_thread::get_id();
+        viaCallback.set_value(info);
+    });
+
+    EXPECT_EQ(jfk.get().icao, "KJFK");
+    EXPECT_EQ(again.get().longestRunway, jfk.get().longestRunway);
+    EXPECT_TRUE(missing.get().icao.empty());
+    EXPECT_EQ(sfo.get().type, "VOR");
+    EXPECT_EQ(viaCallback.get_future().get().name, "London Heathrow");
+    EXPECT_NE(callbackThread, std::this_thread::get_id());
+}
+
+// Test: Concurrent requests for one code all complete, and shutdown answers a stopped provider
+TEST(NavdataProviderTest, SimConnectAsyncSharedRequests) {
+    SimConnectNavdataProvider provider;
+    ASSERT_TRUE(provider.initialize());
+
+    std::atomic<int> completed{0};
+    std::vector<std::thread> threads;
+    std::vector<std::shared_future<AirportInfo>> futures(8);
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t] {
+            futures[t] = provider.getAirportByICAOAsync("KLAX");
+            provider.getAirportByICAOAsync("KLAX", [&](const AirportInfo&) { completed++; });
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (auto& future : futures) EXPECT_EQ(future.get().icao, "KLAX");
+
+    provider.shutdown();  // runs or answers every queued callback before returning
+    EXPECT_EQ(completed.load(), 8);
+    EXPECT_TRUE(provider.getAirportByICAOAsync("KLAX").get().icao.empty());
+}
+
+// Test: Entries written through the persistent tier warm a new provider for the same cycle only
+TEST(NavdataProviderTest, PersistentCacheRoundTrip) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_navdata_provider";
+    std::filesystem::create_directories(dir);
+    auto path = (dir / "navdata.cache").string();
+    std::filesystem::remove(path);
+
+    {
+        CachedNavdataProvider provider;
+        ASSERT_TRUE(provider.enablePersistentCache(path, 2510));
+        ASSERT_TRUE(provider.initialize());
+        provider.addAirport(makeAirport("KSMO", "Santa Monica"));
+        provider.addAirport(makeAirport("KSMO", "Santa Monica Muni"));  // supersedes
+        NavaidInfo smo{};
+        smo.id = "SMO";
+        smo.type = "VOR";
+        smo.frequency = 110.8;
+        provider.addNavaids({smo});
+    }  // shutdown flushes
+
+    {
+        CachedNavdataProvider provider;
+        ASSERT_TRUE(provider.enablePersistentCache(path, 2510));
+        AirportInfo info;
+        ASSERT_TRUE(provider.getAirportByICAO("KSMO", info));
+        EXPECT_EQ(info.name, "Santa Monica Muni");
+        EXPECT_EQ(info.runways, (std::vector<std::string>{"03", "21"}));
+        EXPECT_DOUBLE_EQ(info.position.longitude, -118.4513);
+        NavaidInfo navaid;
+        ASSERT_TRUE(provider.getNavaidByID("SMO", navaid));
+        EXPECT_DOUBLE_EQ(navaid.frequency, 110.8);
+        EXPECT_FALSE(provider.getAirportByICAO("KJFK", info));  // defaults are not persisted
+    }
+
+    {
+        CachedNavdataProvider provider;
+        ASSERT_TRUE(provider.enablePersistentCache(path, 2511));  // new cycle discards the file
+        AirportInfo info;
+        EXPECT_FALSE(provider.getAirportByICAO("KSMO", info));
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+// Test: A torn final record is dropped and the rest of the log survives
+TEST(NavdataProviderTest, PersistentCacheTornTail) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_navdata_provider_torn";
+    std::filesystem::create_directories(dir);
+    auto path = (dir / "navdata.cache").string();
+    std::filesystem::remove(path);
+
+    {
+        CachedNavdataProvider provider;
+        ASSERT_TRUE(provider.enablePersistentCache(path, 2510));
+        provider.addAirport(makeAirport("KSMO", "Santa Monica"));
+        ASSERT_TRUE(provider.flushPersistentCache());
+        provider.addAirport(makeAirport("KVNY", "Van Nuys"));
+        ASSERT_TRUE(provider.flushPersistentCache());
+        provider.shutdown();
+    }
+    auto size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 3);
+
+    {
+        CachedNavdataProvider provider;
+        ASSERT_TRUE(provider.enablePersistentCache(path, 2510));
+        AirportInfo info;
+        EXPECT_TRUE(provider.getAirportByICAO("KSMO", info));
+        EXPECT_FALSE(provider.getAirportByICAO("KVNY", info));
+        provider.addAirport(makeAirport("KVNY", "Van Nuys"));
+    }
+
+    CachedNavdataProvider provider;
+    ASSERT_TRUE(provider.enablePersistentCache(path, 2510));
+    AirportInfo info;
+    EXPECT_TRUE(provider.getAirportByICAO("KVNY", info));
+    EXPECT_TRUE(provider.getAirportByICAO("KSMO", info));
+
+    std::filesystem::remove_all(dir);
+}
+
+// Test: Indexed radius and nearest queries match a full scan, in ICAO order, and see later additions
+TEST(NavdataProviderTest, CachedSpatialQueriesMatchScan) {
+    CachedNavdataProvider provider;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> lat(30.0, 50.0), lon(-125.0, -70.0);
+    std::vector<AirportInfo> airports;
+    for (int i = 0; i < 2000; ++i) {
+        AirportInfo info = makeAirport("X" + std::to_string(10000 + i), "Field");
+        info.position.latitude = lat(rng);
+        info.position.longitude = lon(rng);
+        airports.push_back(info);
+    }
+    provider.addAirports(airports);
+
+    std::uniform_real_distribution<double> radius(10.0, 300.0);
+    for (int q = 0; q < 50; ++q) {
+        Position center{};
+        center.latitude = lat(rng);
+        center.longitude = lon(rng);
+        double r = radius(rng);
+
+        std::vector<std::string> expected;
+        double best = 1e9;
+        std::string nearest;
+        for (const AirportInfo& a : airports) {   // already in ICAO order
+            double d = Geodesy::haversineNM(center.latitude, center.longitude,
+                                            a.position.latitude, a.position.longitude);
+            if (d <= r) expected.push_back(a.icao);
+            if (d < best) { best = d; nearest = a.icao; }
+        }
+        std::vector<std::string> found;
+        for (const AirportInfo& a : provider.getAirportsNearby(center, r)) found.push_back(a.icao);
+        EXPECT_EQ(found, expected) << "query " << q;
+
+        AirportInfo info;
+        ASSERT_TRUE(provider.getNearestAirport(center, info));
+        EXPECT_EQ(info.icao, nearest) << "query " << q;
+    }
+
+    // A later addition is visible to the next query
+    AirportInfo added = makeAirport("KNEW", "New Field");
+    added.position.latitude = 20.0;
+    added.position.longitude = -100.0;
+    provider.addAirport(added);
+    Position here{};
+    here.latitude = 20.01;
+    here.longitude = -100.0;
+    AirportInfo info;
+    ASSERT_TRUE(provider.getNearestAirport(here, info));
+    EXPECT_EQ(info.icao, "KNEW");
+    ASSERT_EQ(provider.getAirportsNearby(here, 5.0).size(), 1u);
+
+    provider.shutdown();
+    EXPECT_FALSE(provider.getNearestAirport(here, info));
+}
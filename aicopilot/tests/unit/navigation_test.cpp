@@ -185,11 +185,11 @@ TEST_F(NavigationTest, WaypointAdvancement) {
     plan.waypoints.push_back({createPosition(40.0, -76.0, 10000.0), "WP2"});
     
     Waypoint initial = nav.getActiveWaypoint();
-    EXPECT_EQ(initial.ident, "START");
+    EXPECT_EQ(initial.id, "START");
     
     nav.advanceWaypoint();
     Waypoint after_advance = nav.getActiveWaypoint();
-    EXPECT_EQ(after_advance.ident, "WP1");
+    EXPECT_EQ(after_advance.id, "WP1");
 }
 
 // Test: Input validation - null/empty strings
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "../../include/obstacle_index.hpp"
+#include "../../include/terrain_awareness.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+
+using namespace AICopilot;
+
+namespace {
+
+Position makePosition(double lat, double lon) {
+    return {lat, lon, 0.0, 0.0};
+}
+
+Obstacle makeObstacle(double lat, double lon, double elevation, const std::string& description = "") {
+    Obstacle obs;
+    obs.type = ObstacleType::TOWER;
+    obs.position = makePosition(lat, lon);
+    obs.height = 300.0;
+    obs.elevation = elevation;
+    obs.description = description;
+    return obs;
+}
+
+// Same flat-frame distance the index uses, computed the slow way
+double bruteDistanceNM(const Position& p, const Position& a, const Position& b) {
+    double cosLat = std::cos((a.latitude + b.latitude) * 0.5 * 3.14159265358979323846 / 180.0);
+    double bx = (b.longitude - a.longitude) * 60.0 * cosLat;
+    double by = (b.latitude - a.latitude) * 60.0;
+    double px = (p.longitude - a.longitude) * 60.0 * cosLat;
+    double py = (p.latitude - a.latitude) * 60.0;
+    double lengthSq = bx * bx + by * by;
+    double t = lengthSq > 0.0 ? std::max(0.0, std::min(1.0, (px * bx + py * by) / lengthSq)) : 0.0;
+    return std::hypot(px - t * bx, py - t * by);
+}
+
+} // namespace
+
+// Test: Corridor queries return exactly the obstacles a linear scan finds
+TEST(ObstacleIndexTest, CorridorMatchesLinearScan) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> lat(38.0, 42.0);
+    std::uniform_real_distribution<double> lon(-106.0, -102.0);
+
+    std::vector<Obstacle> obstacles;
+    for (int i = 0; i < 20000; ++i) {
+        obstacles.push_back(makeObstacle(lat(rng), lon(rng), 5000.0, std::to_string(i)));
+    }
+    ObstacleIndex index;
+    index.build(obstacles);
+    ASSERT_EQ(index.size(), obstacles.size());
+
+    const std::pair<Position, Position> legs[] = {
+        {makePosition(38.5, -105.5), makePosition(41.5, -102.5)},  // diagonal
+        {makePosition(40.0, -105.9), makePosition(40.0, -102.1)},  // due east
+        {makePosition(38.2, -104.0), makePosition(41.8, -104.0)},  // due north
+        {makePosition(40.33, -103.77), makePosition(40.33, -103.77)},  // point
+    };
+    for (const auto& leg : legs) {
+        std::vector<const Obstacle*> found;
+        index.queryCorridor(leg.first, leg.second, 3.0, found);
+
+        std::set<std::string> got;
+        for (const Obstacle* obs : found) got.insert(obs->description);
+        EXPECT_EQ(got.size(), found.size());  // no duplicates
+
+        std::set<std::string> expected;
+        for (const Obstacle& obs : obstacles) {
+            if (bruteDistanceNM(obs.position, leg.first, leg.second) <= 3.0) {
+                expected.insert(obs.description);
+            }
+        }
+        EXPECT_EQ(got, expected);
+    }
+}
+
+// Test: Cells on either side of the prime meridian and equator stay separate
+TEST(ObstacleIndexTest, RadiusQueryAcrossCellEdges) {
+    ObstacleIndex index;
+    index.build({makeObstacle(0.01, 0.01, 100.0, "ne"), makeObstacle(-0.01, -0.01, 100.0, "sw"),
+                 makeObstacle(0.5, 0.5, 100.0, "far")});
+
+    std::vector<const Obstacle*> found;
+    index.queryRadius(makePosition(0.0, 0.0), 2.0, found);
+    ASSERT_EQ(found.size(), 2u);
+
+    found.clear();
+    index.queryRadius(makePosition(10.0, 10.0), 2.0, found);
+    EXPECT_TRUE(found.empty());
+}
+
+// Test: TerrainAwareness loads obstacles from CSV and only reports those near the path
+TEST(ObstacleIndexTest, TerrainAwarenessUsesIndex) {
+    auto path = std::filesystem::temp_directory_path() / "ta_obstacles.csv";
+    {
+        std::ofstream out(path);
+        out << "lat,lon,elevation_msl,height_agl,type,description\n";
+        out << "40.05,-74.0,1500,400,TOWER,on path\n";
+        out << "40.05,-73.5,1500,400,ANTENNA,off path\n";
+        out << "40.08,-74.0,400,200,BUILDING,low\n";
+    }
+
+    TerrainAwareness terrain;
+    ASSERT_TRUE(terrain.loadObstacleDatabase(path.string()));
+    EXPECT_EQ(terrain.getObstacleCount(), 3u);
+
+    auto hits = terrain.detectObstacles(makePosition(40.0, -74.0), makePosition(40.1, -74.0), 2000.0);
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0].description, "on path");
+    EXPECT_EQ(hits[0].type, ObstacleType::TOWER);
+
+    Obstacle highest = terrain.getHighestObstacle(makePosition(40.05, -73.5), 5.0);
+    EXPECT_EQ(highest.description, "off path");
+    EXPECT_EQ(highest.type, ObstacleType::ANTENNA);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include "../../include/ollama_gateway.hpp"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// Backend whose selections the test resolves by hand
+struct ManualBackend {
+    std::mutex mutex;
+    std::vector<std::pair<OllamaGatewayRequest, std::shared_ptr<OllamaSelection>>> requests;
+
+    OllamaGateway::Backend make() {
+        return [this](const OllamaGatewayRequest& request) {
+            auto selection = std::make_shared<OllamaSelection>(request.deadline);
+            std::lock_guard<std::mutex> lock(mutex);
+            requests.emplace_back(request, selection);
+            return selection;
+        };
+    }
+
+    size_t count() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return requests.size();
+    }
+
+    bool waitFor(size_t n) {
+        for (int i = 0; i < 400 && count() < n; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return count() >= n;
+    }
+};
+
+const std::vector<std::string> OPTIONS = {"Unable", "Roger", "Wilco"};
+
+OllamaGatewayConfig unlimited(size_t maxInFlight) {
+    OllamaGatewayConfig config;
+    config.maxInFlight = maxInFlight;
+    config.pilotRequestsPerSecond = 0.0;
+    return config;
+}
+
+} // namespace
+
+// Test: A dispatched request resolves the caller's selection with the backend's choice
+TEST(OllamaGatewayTest, ForwardsBackendResult) {
+    ManualBackend backend;
+    OllamaGateway gateway(backend.make(), unlimited(2));
+
+    auto selection = gateway.submit(7, LLMPriority::ROUTINE, "Climb", OPTIONS, "CLIMB", "",
+                                    std::chrono::seconds(5));
+    ASSERT_TRUE(backend.waitFor(1));
+    EXPECT_EQ(backend.requests[0].first.pilotId, 7u);
+    backend.requests[0].second->resolve(OllamaSelection::Status::COMPLETED, 2);
+
+    ASSERT_TRUE(selection->wait(std::chrono::seconds(2)));
+    EXPECT_EQ(selection->getOption(), 2);
+    EXPECT_EQ(gateway.getStats().completed, 1u);
+}
+
+// Test: At most maxInFlight requests reach the backend; emergencies jump the queue
+TEST(OllamaGatewayTest, EmergenciesDispatchFirst) {
+    ManualBackend backend;
+    OllamaGateway gateway(backend.make(), unlimited(1));
+
+    auto first = gateway.submit(1, LLMPriority::ROUTINE, "first", OPTIONS, "CRUISE", "",
+                                std::chrono::seconds(5));
+    ASSERT_TRUE(backend.waitFor(1));
+    auto routine = gateway.submit(2, LLMPriority::ROUTINE, "routine", OPTIONS, "CRUISE", "",
+                                  std::chrono::seconds(5));
+    auto mayday = gateway.submit(3, LLMPriority::EMERGENCY, "mayday", OPTIONS, "CRUISE", "",
+                                 std::chrono::seconds(5));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_EQ(backend.count(), 1u);
+    EXPECT_EQ(gateway.getStats().queueDepth, 2u);
+    EXPECT_EQ(gateway.getStats().maxQueueDepth, 2u);
+
+    backend.requests[0].second->resolve(OllamaSelection::Status::COMPLETED, 0);
+    ASSERT_TRUE(backend.waitFor(2));
+    EXPECT_EQ(backend.requests[1].first.atcMessage, "mayday");
+
+    backend.requests[1].second->resolve(OllamaSelection::Status::COMPLETED, 1);
+    ASSERT_TRUE(backend.waitFor(3));
+    EXPECT_EQ(backend.requests[2].first.atcMessage, "routine");
+    EXPECT_TRUE(mayday->wait(std::chrono::seconds(2)));
+}
+
+// Test: A pilot over its rate limit is rejected at once; emergencies and other pilots are not
+TEST(OllamaGatewayTest, RateLimitsPerPilot) {
+    ManualBackend backend;
+    OllamaGatewayConfig config;
+    config.maxInFlight = 8;
+    config.pilotRequestsPerSecond = 0.01;
+    config.pilotBurst = 2.0;
+    OllamaGateway gateway(backend.make(), config);
+
+    auto submit = [&](uint32_t pilot, LLMPriority priority) {
+        return gateway.submit(pilot, priority, "msg", OPTIONS, "TAXI OUT", "", std::chrono::seconds(5));
+    };
+    auto a1 = submit(1, LLMPriority::ROUTINE);
+    auto a2 = submit(1, LLMPriority::ROUTINE);
+    auto a3 = submit(1, LLMPriority::ROUTINE);
+    auto emergency = submit(1, LLMPriority::EMERGENCY);
+    auto b1 = submit(2, LLMPriority::ROUTINE);
+
+    EXPECT_EQ(a3->getStatus(), OllamaSelection::Status::FAILED);
+    EXPECT_FALSE(a1->isDone());
+    EXPECT_FALSE(emergency->isDone());
+    EXPECT_FALSE(b1->isDone());
+    EXPECT_EQ(gateway.getStats().rateLimited, 1u);
+    EXPECT_TRUE(backend.waitFor(4));
+}
+
+// Test: Requests whose deadline passes in the queue time out without reaching the backend
+TEST(OllamaGatewayTest, ExpiresQueuedRequests) {
+    ManualBackend backend;
+    OllamaGateway gateway(backend.make(), unlimited(1));
+
+    auto blocking = gateway.submit(1, LLMPriority::ROUTINE, "slow", OPTIONS, "CRUISE", "",
+                                   std::chrono::seconds(5));
+    ASSERT_TRUE(backend.waitFor(1));
+    auto queued = gateway.submit(2, LLMPriority::ROUTINE, "late", OPTIONS, "CRUISE", "",
+                                 std::chrono::milliseconds(20));
+
+    ASSERT_TRUE(queued->wait(std::chrono::seconds(2)));
+    EXPECT_EQ(queued->getStatus(), OllamaSelection::Status::TIMED_OUT);
+    EXPECT_EQ(gateway.getStats().expired, 1u);
+    EXPECT_EQ(backend.count(), 1u);
+}
+
+// Test: Cancelling the caller's selection cancels the backend request
+TEST(OllamaGatewayTest, CancelPropagatesToBackend) {
+    ManualBackend backend;
+    OllamaGateway gateway(backend.make(), unlimited(1));
+
+    auto selection = gateway.submit(1, LLMPriority::ROUTINE, "msg", OPTIONS, "CRUISE", "",
+                                    std::chrono::seconds(5));
+    ASSERT_TRUE(backend.waitFor(1));
+    selection->cancel();
+
+    auto backendSelection = backend.requests[0].second;
+    for (int i = 0; i < 400 && !backendSelection->isDone(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(backendSelection->getStatus(), OllamaSelection::Status::CANCELLED);
+}
+
+// Test: Many pilots submitting concurrently all get an answer
+TEST(OllamaGatewayTest, ConcurrentPilots) {
+    OllamaGateway gateway([](const OllamaGatewayRequest& request) {
+        auto selection = std::make_shared<OllamaSelection>(request.deadline);
+        selection->resolve(OllamaSelection::Status::COMPLETED, static_cast<int>(request.pilotId % 3));
+        return selection;
+    }, unlimited(4));
+
+    std::atomic<int> answered{0};
+    std::vector<std::thread> pilots;
+    for (uint32_t pilot = 0; pilot < 8; ++pilot) {
+        pilots.emplace_back([&gateway, &answered, pilot] {
+            for (int i = 0; i < 20; ++i) {
+                auto selection = gateway.submit(pilot, LLMPriority::ROUTINE, "msg", OPTIONS, "CRUISE", "",
+                                                std::chrono::seconds(5));
+                if (selection->wait(std::chrono::seconds(5)) &&
+                    selection->getOption() == static_cast<int>(pilot % 3)) {
+                    answered++;
+                }
+            }
+        });
+    }
+    for (auto& pilot : pilots) pilot.join();
+
+    EXPECT_EQ(answered.load(), 160);
+    OllamaGatewayStats stats = gateway.getStats();
+    EXPECT_EQ(stats.submitted, 160u);
+    EXPECT_EQ(stats.completed, 160u);
+    EXPECT_EQ(stats.queueDepth, 0u);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "../../include/ollama_client.h"
+#include <thread>
+
+using namespace AICopilot;
+
+// Test: A selection resolves once; later outcomes and cancellation are ignored
+TEST(OllamaSelectionTest, ResolvesOnce) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(20);
+    OllamaSelection completed(deadline);
+    EXPECT_FALSE(completed.wait(std::chrono::milliseconds(1)));
+    EXPECT_TRUE(completed.resolve(OllamaSelection::Status::COMPLETED, 2));
+    completed.cancel();
+    EXPECT_EQ(completed.getStatus(), OllamaSelection::Status::COMPLETED);
+    EXPECT_EQ(completed.getOption(), 2);
+    EXPECT_TRUE(completed.wait(std::chrono::milliseconds(0)));
+
+    OllamaSelection cancelled(deadline);
+    cancelled.cancel();
+    EXPECT_FALSE(cancelled.resolve(OllamaSelection::Status::COMPLETED, 1));
+    EXPECT_EQ(cancelled.getOption(), -1);
+
+    OllamaSelection late(deadline);
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    EXPECT_TRUE(late.isPastDeadline());
+    EXPECT_FALSE(late.isDone());
+}
+
+// Test: Another thread's resolution wakes a waiting caller
+TEST(OllamaSelectionTest, WaitWakesOnResolve) {
+    OllamaSelection selection(std::chrono::steady_clock::now() + std::chrono::seconds(5));
+    std::thread resolver([&selection] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        selection.resolve(OllamaSelection::Status::COMPLETED, 0);
+    });
+    EXPECT_TRUE(selection.wait(std::chrono::seconds(5)));
+    EXPECT_EQ(selection.getOption(), 0);
+    resolver.join();
+}
+
+// Test: An asynchronous selection returns a handle that resolves to a valid option
+TEST(OllamaSelectionTest, AsyncSelectionResolves) {
+    OllamaClient client;
+    client.connect("http://localhost:11434");
+    std::vector<std::string> options = {"Unable", "Climb and maintain 5000"};
+    auto selection = client.selectATCMenuOptionAsync(
+        "Climb and maintain 5000", options, "CLIMB", "", std::chrono::milliseconds(2000));
+    ASSERT_NE(selection, nullptr);
+    ASSERT_TRUE(selection->wait(std::chrono::milliseconds(2000)));
+    if (selection->getStatus() == OllamaSelection::Status::COMPLETED) {
+        EXPECT_GE(selection->getOption(), 0);
+        EXPECT_LT(selection->getOption(), static_cast<int>(options.size()));
+    }
+
+    auto empty = client.selectATCMenuOptionAsync("", {}, "CLIMB", "", std::chrono::milliseconds(10));
+    EXPECT_EQ(empty->getStatus(), OllamaSelection::Status::FAILED);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "../../include/ollama_stream_parser.hpp"
+#include <string>
+
+using namespace AICopilot;
+
+namespace {
+
+std::string chunk(const std::string& token, bool done = false) {
+    return "{\"model\":\"llama2\",\"response\":\"" + token + "\",\"done\":" +
+           (done ? "true" : "false") + "}\n";
+}
+
+} // namespace
+
+// Test: The option is decided on the first digit token, before the stream ends
+TEST(OllamaStreamParserTest, DecidesOnFirstDigit) {
+    OllamaStreamParser parser(3);
+    EXPECT_FALSE(parser.feed(chunk("The").data(), chunk("The").size()));
+    EXPECT_FALSE(parser.feed(chunk(" best is").data(), chunk(" best is").size()));
+    std::string digit = chunk(" 2");
+    EXPECT_TRUE(parser.feed(digit.data(), digit.size()));
+    EXPECT_EQ(parser.getOption(), 1);
+    EXPECT_FALSE(parser.isDone());
+}
+
+// Test: Lines split across chunks and escaped text parse the same
+TEST(OllamaStreamParserTest, HandlesSplitLinesAndEscapes) {
+    std::string body = chunk("Option \\\"") + chunk("3\\\"") + chunk("", true);
+    OllamaStreamParser parser(4);
+    for (size_t i = 0; i < body.size() && !parser.isDecided(); i += 7) {
+        parser.feed(body.data() + i, std::min<size_t>(7, body.size() - i));
+    }
+    EXPECT_EQ(parser.getOption(), 2);
+    EXPECT_EQ(parser.getAnswer(), "Option \"3\"");
+}
+
+// Test: With ten or more options a digit waits for the next token
+TEST(OllamaStreamParserTest, WaitsWhileNumberCanGrow) {
+    OllamaStreamParser parser(12);
+    std::string one = chunk("1");
+    EXPECT_FALSE(parser.feed(one.data(), one.size()));
+    std::string two = chunk("2");
+    EXPECT_TRUE(parser.feed(two.data(), two.size()));   // 12 cannot grow into an option
+    EXPECT_EQ(parser.getOption(), 11);
+
+    // An open number at the end of the stream still counts
+    OllamaStreamParser last(12);
+    std::string body = chunk("1") + chunk("", true);
+    EXPECT_TRUE(last.feed(body.data(), body.size()));
+    EXPECT_EQ(last.getOption(), 0);
+}
+
+// Test: Numbers outside the menu are skipped, and a stream with none decides nothing
+TEST(OllamaStreamParserTest, SkipsOutOfRangeNumbers) {
+    OllamaStreamParser parser(3);
+    std::string body = chunk("At 7000 feet, choose ") + chunk("3");
+    EXPECT_TRUE(parser.feed(body.data(), body.size()));
+    EXPECT_EQ(parser.getOption(), 2);
+
+    OllamaStreamParser none(3);
+    body = chunk("No idea") + chunk("", true);
+    EXPECT_FALSE(none.feed(body.data(), body.size()));
+    none.finish();
+    EXPECT_TRUE(none.isDone());
+    EXPECT_EQ(none.getOption(), -1);
+}
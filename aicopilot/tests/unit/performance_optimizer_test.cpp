@@ -0,0 +1,403 @@
+#include <gtest/gtest.h>
+#include "../../include/performance_optimizer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace AICopilot;
+
+namespace {
+
+// Elevation that varies with position so misplaced results show
+double fakeElevation(double latitude, double longitude) {
+    return latitude * 100.0 + longitude;
+}
+
+struct RecordingBackend {
+    std::vector<size_t> callSizes;
+    std::vector<LatLon> points;
+    std::chrono::microseconds perCall{0};
+
+    PerformanceOptimizer::ElevationBackend bind() {
+        return [this](const LatLon* p, size_t count, double* out) {
+            if (perCall.count() > 0) std::this_thread::sleep_for(perCall);
+            callSizes.push_back(count);
+            for (size_t i = 0; i < count; ++i) {
+                points.push_back(p[i]);
+                out[i] = fakeElevation(p[i].latitude, p[i].longitude);
+            }
+        };
+    }
+};
+
+} // namespace
+
+// Test: Misses reach the backend grouped by tile and come back in batch order
+TEST(PerformanceOptimizerBatchTest, BatchesMissesByTile) {
+    PerformanceOptimizer optimizer;
+    RecordingBackend backend;
+    optimizer.setElevationBackend(backend.bind());
+
+    std::vector<Position> positions;
+    for (int i = 0; i < 20; ++i) {
+        // Alternate between two tiles
+        positions.push_back({(i % 2 ? 46.5 : 45.5) + i * 0.001, -122.5, 0, 0});
+    }
+    QueryBatch batch = optimizer.createQueryBatch(positions, 100);
+    std::vector<double> results = optimizer.processBatch(batch);
+
+    ASSERT_EQ(results.size(), positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_DOUBLE_EQ(results[i], fakeElevation(positions[i].latitude, positions[i].longitude));
+    }
+
+    // SPEEDUP_SAMPLE_POINTS single calls, then one call for the rest
+    ASSERT_EQ(backend.callSizes.size(), PerformanceOptimizer::SPEEDUP_SAMPLE_POINTS + 1);
+    EXPECT_EQ(backend.callSizes.back(), positions.size() - PerformanceOptimizer::SPEEDUP_SAMPLE_POINTS);
+    for (size_t i = 1; i < backend.points.size(); ++i) {
+        EXPECT_LE(std::floor(backend.points[i - 1].latitude), std::floor(backend.points[i].latitude));
+    }
+}
+
+// Test: Cached cells are served without reaching the backend
+TEST(PerformanceOptimizerBatchTest, CachedCellsSkipBackend) {
+    PerformanceOptimizer optimizer;
+    RecordingBackend backend;
+    optimizer.setElevationBackend(backend.bind());
+
+    Position cached = {45.0, -122.0, 0, 0};
+    Position fresh = {45.2, -122.2, 0, 0};
+    optimizer.cacheTerrainElevation(cached, 500.0);
+
+    std::vector<double> results = optimizer.processBatch(optimizer.createQueryBatch({cached, fresh}, 100));
+    EXPECT_DOUBLE_EQ(results[0], 500.0);
+    EXPECT_DOUBLE_EQ(results[1], fakeElevation(fresh.latitude, fresh.longitude));
+    EXPECT_EQ(backend.points.size(), 1u);
+
+    // The answered miss is cached too
+    optimizer.processBatch(optimizer.createQueryBatch({fresh}, 100));
+    EXPECT_EQ(backend.points.size(), 1u);
+}
+
+// Test: The batching speedup is measured from backend timings
+TEST(PerformanceOptimizerBatchTest, SpeedupIsMeasured) {
+    PerformanceOptimizer optimizer;
+    EXPECT_DOUBLE_EQ(optimizer.getBatchStatistics().averageSpeedupFactor, 0.0);
+
+    RecordingBackend backend;
+    backend.perCall = std::chrono::microseconds(500);   // fixed cost per call dominates
+    optimizer.setElevationBackend(backend.bind());
+
+    std::vector<Position> positions;
+    for (int i = 0; i < 100; ++i) {
+        positions.push_back({45.0 + i * 0.01, -122.0, 0, 0});
+    }
+    optimizer.processBatch(optimizer.createQueryBatch(positions, 100));
+
+    auto stats = optimizer.getBatchStatistics();
+    EXPECT_EQ(stats.batchesProcessed, 1u);
+    EXPECT_EQ(stats.queriesOptimized, 100u);
+    EXPECT_DOUBLE_EQ(stats.averageBatchSize, 100.0);
+    EXPECT_GT(stats.averageSpeedupFactor, 2.0);
+}
+
+// Test: The worker flushes a batch once its timeout passes
+TEST(PerformanceOptimizerBatchTest, WorkerFlushesOnTimeout) {
+    PerformanceOptimizer optimizer;
+    RecordingBackend backend;
+    optimizer.setElevationBackend(backend.bind());
+
+    std::mutex mutex;
+    std::condition_variable flushed;
+    std::vector<double> received;
+    optimizer.startBatchWorker([&](const QueryBatch&, const std::vector<double>& elevations) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received = elevations;
+        flushed.notify_all();
+    });
+
+    QueryBatch batch = optimizer.createQueryBatch({{45.0, -122.0, 0, 0}}, 20);
+    optimizer.addQueryToBatch(batch.batchId, {45.1, -122.0, 0, 0});
+    EXPECT_FALSE(optimizer.isBatchReady(batch.batchId));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    ASSERT_TRUE(flushed.wait_for(lock, std::chrono::seconds(5), [&] { return !received.empty(); }));
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_DOUBLE_EQ(received[1], fakeElevation(45.1, -122.0));
+    lock.unlock();
+
+    optimizer.stopBatchWorker();
+    EXPECT_FALSE(optimizer.isBatchReady(batch.batchId));   // flushed batches are removed
+}
+
+// Test: Waypoint batches look each distinct miss up once
+TEST(PerformanceOptimizerBatchTest, WaypointBatchDeduplicatesMisses) {
+    PerformanceOptimizer optimizer;
+    std::vector<std::string> lookups;
+    optimizer.setWaypointBackend([&lookups](const std::string& id) -> std::optional<Waypoint> {
+        lookups.push_back(id);
+        if (id == "ZZZZZ") return std::nullopt;
+        Waypoint waypoint;
+        waypoint.id = id;
+        return waypoint;
+    });
+
+    Waypoint cached;
+    cached.id = "BRAVO";
+    optimizer.cacheWaypoint("BRAVO", cached);
+
+    auto results = optimizer.processWaypointBatch({"ALPHA", "BRAVO", "ALPHA", "ZZZZZ"});
+    ASSERT_EQ(results.size(), 4u);
+    EXPECT_EQ(results[0]->id, "ALPHA");
+    EXPECT_EQ(results[1]->id, "BRAVO");
+    EXPECT_EQ(results[2]->id, "ALPHA");
+    EXPECT_FALSE(results[3].has_value());
+    EXPECT_EQ(lookups, (std::vector<std::string>{"ALPHA", "ZZZZZ"}));
+
+    optimizer.processWaypointBatch({"ALPHA"});
+    EXPECT_EQ(lookups.size(), 2u);
+}
+
+namespace {
+
+// Records loads in order; blocks on a gate so tests can inspect the queue
+struct RecordingPrefetcher {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool open = true;
+    std::vector<std::string> loads;
+
+    void record(const std::string& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return open; });
+        loads.push_back(item);
+    }
+
+    void bind(PerformanceOptimizer& optimizer) {
+        optimizer.setTerrainPrefetcher([this](int lat, int lon) {
+            record("tile " + std::to_string(lat) + "," + std::to_string(lon));
+            return true;
+        });
+        optimizer.setNavigationPrefetcher([this](const Position& p, double) {
+            record("navdata " + std::to_string(static_cast<int>(p.latitude)));
+            return true;
+        });
+        optimizer.setWeatherPrefetcher([this](const Position&, double) {
+            record("weather");
+            return false;
+        });
+    }
+
+    void setOpen(bool value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        open = value;
+        cv.notify_all();
+    }
+};
+
+Waypoint routePoint(double latitude, double longitude) {
+    Waypoint waypoint;
+    waypoint.position = {latitude, longitude, 0, 0};
+    return waypoint;
+}
+
+} // namespace
+
+// Test: Grid tiles load nearest first, each tile once
+TEST(PerformanceOptimizerPrefetchTest, GridLoadsNearestTileFirst) {
+    PerformanceOptimizer optimizer;
+    RecordingPrefetcher loader;
+    loader.bind(optimizer);
+
+    Position center = {45.9, -122.5, 0, 0};   // near the north edge of N45
+    optimizer.prefetchTerrainGrid(center, 10.0, PrefetchStrategy::SPATIAL);
+    optimizer.prefetchTerrainGrid(center, 10.0, PrefetchStrategy::SPATIAL);
+
+    auto status = optimizer.getPrefetchStatus();
+    ASSERT_EQ(status.activePrefetches, 2u);
+    EXPECT_EQ(status.pendingItems, (std::vector<std::string>{"terrain N45W123", "terrain N46W123"}));
+
+    optimizer.startPrefetchWorker();
+    optimizer.waitForPrefetches();
+    EXPECT_EQ(loader.loads, (std::vector<std::string>{"tile 45,-123", "tile 46,-123"}));
+
+    status = optimizer.getPrefetchStatus();
+    EXPECT_EQ(status.activePrefetches, 0u);
+    EXPECT_EQ(status.completedPrefetches, 2u);
+    EXPECT_DOUBLE_EQ(status.completionPercentage, 100.0);
+}
+
+// Test: Route prefetches run in along-track order and skip targets past the look-ahead
+TEST(PerformanceOptimizerPrefetchTest, RouteLoadsInTrackOrder) {
+    PerformanceOptimizer optimizer;
+    RecordingPrefetcher loader;
+    loader.bind(optimizer);
+
+    // Northbound, one degree (60 NM) per leg
+    optimizer.prefetchAlongFlightPath({routePoint(44.5, -122.5), routePoint(45.5, -122.5),
+                                       routePoint(46.5, -122.5)}, 90.0);
+    optimizer.startPrefetchWorker();
+    optimizer.waitForPrefetches();
+
+    std::vector<std::string> tiles;
+    std::vector<std::string> navdata;
+    for (const auto& load : loader.loads) {
+        if (load.rfind("tile", 0) == 0) tiles.push_back(load);
+        if (load.rfind("navdata", 0) == 0) navdata.push_back(load);
+    }
+    EXPECT_EQ(tiles, (std::vector<std::string>{"tile 44,-123", "tile 45,-123"}));
+    EXPECT_EQ(navdata, (std::vector<std::string>{"navdata 44", "navdata 45"}));
+
+    auto status = optimizer.getPrefetchStatus();
+    EXPECT_EQ(status.completedPrefetches, 4u);
+    EXPECT_EQ(status.failedPrefetches, 2u);   // weather loader finds nothing
+}
+
+// Test: A new route cancels the old route's queued work but not other requests
+TEST(PerformanceOptimizerPrefetchTest, RouteChangeCancelsQueuedWork) {
+    PerformanceOptimizer optimizer;
+    RecordingPrefetcher loader;
+    loader.bind(optimizer);
+
+    optimizer.prefetchNavigationData({10.5, 10.5, 0, 0}, 20.0, PrefetchStrategy::SPATIAL);
+    optimizer.prefetchAlongFlightPath({routePoint(44.5, -122.5), routePoint(45.5, -122.5)}, 200.0);
+    uint32_t queuedForOldRoute = optimizer.getPrefetchStatus().activePrefetches - 1;
+    ASSERT_GT(queuedForOldRoute, 0u);
+
+    optimizer.prefetchAlongFlightPath({routePoint(-33.5, 151.5)}, 200.0);
+    auto status = optimizer.getPrefetchStatus();
+    EXPECT_EQ(status.cancelledPrefetches, queuedForOldRoute);
+    for (const auto& item : status.pendingItems) {
+        EXPECT_EQ(item.find("44.50"), std::string::npos) << item;
+    }
+
+    optimizer.startPrefetchWorker();
+    optimizer.waitForPrefetches();
+    EXPECT_NE(std::find(loader.loads.begin(), loader.loads.end(), "navdata 10"), loader.loads.end());
+    EXPECT_NE(std::find(loader.loads.begin(), loader.loads.end(), "tile -34,151"), loader.loads.end());
+    EXPECT_EQ(std::find(loader.loads.begin(), loader.loads.end(), "tile 44,-123"), loader.loads.end());
+}
+
+// Test: Status reports the request being loaded while the loader runs
+TEST(PerformanceOptimizerPrefetchTest, StatusIsLive) {
+    PerformanceOptimizer optimizer;
+    RecordingPrefetcher loader;
+    loader.bind(optimizer);
+    loader.setOpen(false);
+
+    optimizer.startPrefetchWorker();
+    optimizer.prefetchTerrainGrid({45.5, -122.5, 0, 0}, 1.0, PrefetchStrategy::REACTIVE);
+    optimizer.prefetchNavigationData({45.5, -122.5, 0, 0}, 20.0, PrefetchStrategy::SPATIAL);
+
+    // The tile is taken first and blocks; navdata waits behind it
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    PerformanceOptimizer::PrefetchStatus status;
+    do {
+        status = optimizer.getPrefetchStatus();
+    } while (status.pendingItems.size() != 1 && std::chrono::steady_clock::now() < deadline);
+    EXPECT_EQ(status.activePrefetches, 2u);
+    ASSERT_EQ(status.pendingItems.size(), 1u);
+    EXPECT_EQ(status.pendingItems[0].rfind("navdata", 0), 0u);
+    EXPECT_DOUBLE_EQ(status.completionPercentage, 0.0);
+
+    loader.setOpen(true);
+    optimizer.waitForPrefetches();
+    EXPECT_EQ(optimizer.getPrefetchStatus().completedPrefetches, 2u);
+    optimizer.stopPrefetchWorker();
+}
+
+// Test: Nearby positions share a 1 arc-second terrain cell, and cached corner posts are interpolated
+TEST(PerformanceOptimizerCacheTest, NearbyPositionsShareTerrainCell) {
+    PerformanceOptimizer optimizer;
+    Position pos = {45.0, -122.0, 0, 0};
+    optimizer.cacheTerrainElevation(pos, 500.0);
+
+    // A few meters away is the same cell
+    double elevation;
+    EXPECT_TRUE(optimizer.getTerrainElevation({45.00005, -121.99995, 0, 0}, elevation));
+    EXPECT_DOUBLE_EQ(elevation, 500.0);
+    EXPECT_FALSE(optimizer.getTerrainElevation({45.001, -122.0, 0, 0}, elevation));
+
+    // Cached corner posts are interpolated inside the cell
+    CellCorners corners;
+    corners.northWest = 100.0;
+    corners.northEast = 100.0;
+    corners.southWest = 200.0;
+    corners.southEast = 200.0;
+    optimizer.cacheTerrainCell({46.5, -121.5, 0, 0}, corners);
+    EXPECT_TRUE(optimizer.getTerrainElevation({46.5 - 0.5 / 3600.0, -121.5, 0, 0}, elevation));
+    EXPECT_NEAR(elevation, 150.0, 1e-6);
+}
+
+// Test: The least recently used entry is evicted, and a get refreshes recency
+TEST(QueryCacheTest, EvictsLeastRecentlyUsed) {
+    QueryCache<int, int> cache(3, 300, 1);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(3, 30);
+
+    int value = 0;
+    ASSERT_TRUE(cache.get(1, value));   // 2 is now the oldest
+    cache.put(4, 40);
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_FALSE(cache.get(2, value));
+    EXPECT_TRUE(cache.get(1, value));
+    EXPECT_TRUE(cache.get(3, value));
+
+    cache.put(3, 31);                   // replacing refreshes too
+    cache.put(5, 50);
+    EXPECT_FALSE(cache.get(4, value));
+    ASSERT_TRUE(cache.get(3, value));
+    EXPECT_EQ(value, 31);
+}
+
+// Test: Capacity holds across shards and small caches are not over-sharded
+TEST(QueryCacheTest, ShardsShareCapacity) {
+    EXPECT_EQ((QueryCache<int, int>(1, 300).shardCount()), 1u);
+    EXPECT_EQ((QueryCache<int, int>(6, 300).shardCount()), 4u);
+
+    QueryCache<uint64_t, int> cache(1000, 300);
+    EXPECT_EQ(cache.shardCount(), (QueryCache<uint64_t, int>::MAX_SHARDS));
+    for (uint64_t key = 0; key < 5000; ++key) {
+        cache.put(key << 16, static_cast<int>(key));
+    }
+    EXPECT_LE(cache.size(), 1000u + cache.shardCount());
+    EXPECT_GT(cache.size(), 900u);   // packed keys spread over every shard
+
+    int value = 0;
+    ASSERT_TRUE(cache.get(4999ull << 16, value));
+    EXPECT_EQ(value, 4999);
+}
+
+// Test: Entries expire once their TTL passes on the coarse clock
+TEST(QueryCacheTest, ExpiresAfterTtl) {
+    QueryCache<int, int> cache(10, 0);
+    cache.put(1, 10);
+    std::this_thread::sleep_for(std::chrono::milliseconds(4 * CoarseClock::RESOLUTION_MS));
+    int value = 0;
+    EXPECT_FALSE(cache.get(1, value));
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+// Test: Concurrent readers and writers keep every shard consistent
+TEST(QueryCacheTest, ConcurrentAccess) {
+    QueryCache<uint64_t, uint64_t> cache(256, 300);
+    std::vector<std::thread> threads;
+    for (uint64_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, t] {
+            for (uint64_t i = 0; i < 2000; ++i) {
+                uint64_t key = (i * 7 + t) % 512;
+                cache.put(key, key * 3);
+                uint64_t value = 0;
+                if (cache.get((key * 13) % 512, value)) {
+                    EXPECT_EQ(value, ((key * 13) % 512) * 3);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_LE(cache.size(), 256u);
+}
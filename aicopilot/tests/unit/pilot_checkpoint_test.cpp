@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include "../../include/pilot_checkpoint.hpp"
+#include "../../include/ai_pilot.h"
+#include "../../include/headless_sim.hpp"
+#include "../../include/ml_learning.hpp"
+#include "../../include/model_pack.hpp"
+#include "../../include/navigation.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace AICopilot;
+
+namespace {
+
+FlightPlan makePlan() {
+    FlightPlan plan{};
+    plan.departure = "KSEA";
+    plan.arrival = "KPDX";
+    plan.cruiseAltitude = 12000.0;
+    plan.cruiseSpeed = 250.0;
+    const char* ids[] = {"KSEA", "SEA", "OLM", "KPDX"};
+    for (int i = 0; i < 4; ++i) {
+        Waypoint waypoint;
+        waypoint.id = ids[i];
+        waypoint.type = i == 0 || i == 3 ? "AIRPORT" : "VOR";
+        waypoint.position = {47.45 - i * 0.6, -122.3 - i * 0.1, 0.0, 190.0};
+        waypoint.altitude = i == 0 || i == 3 ? 0.0 : 12000.0;
+        plan.waypoints.push_back(waypoint);
+    }
+    return plan;
+}
+
+ClearanceLog makeClearances() {
+    ClearanceLog log;
+    log.append(ClearanceEventType::CLEARED_TAKEOFF, 0, 1000);
+    log.append(ClearanceEventType::ALTITUDE, 12000, 60000);
+    log.append(ClearanceEventType::SQUAWK, 4521, 61000);
+    log.compact(2);   // the base snapshot carries the takeoff clearance
+    return log;
+}
+
+PilotCheckpointBuilder makeBuilder() {
+    PilotCheckpointBuilder builder;
+    PilotCheckpointState& state = builder.state();
+    state.phase = static_cast<int32_t>(FlightPhase::CRUISE);
+    state.flags = CHECKPOINT_PREFLIGHT_COMPLETE | CHECKPOINT_FUEL_WARNING_20;
+    state.latitude = 46.8;
+    state.altitude = 12000.0;
+    state.windSpeed = 25.0;
+    builder.setFlightPlan(makePlan(), 2);
+    builder.setClearances(makeClearances(), "Climb and maintain one two thousand", {"Squawk: 4521"});
+    builder.addWarmEntry(WarmSetCache::AIRPORT, "KSEA");
+    builder.addWarmEntry(WarmSetCache::TERRAIN_TILE, "N46W123");
+    builder.addWarmEntry(WarmSetCache::AIRPORT, "KPDX");
+    return builder;
+}
+
+} // namespace
+
+// Test: Pilot, route, clearance and warm-set state survive a round trip
+TEST(PilotCheckpointTest, RoundTripsState) {
+    PilotCheckpoint checkpoint;
+    ASSERT_TRUE(checkpoint.openImage(makeBuilder().build()));
+    EXPECT_FALSE(checkpoint.isMapped());
+
+    EXPECT_EQ(checkpoint.getPhase(), FlightPhase::CRUISE);
+    EXPECT_TRUE(checkpoint.hasFlag(CHECKPOINT_PREFLIGHT_COMPLETE));
+    EXPECT_FALSE(checkpoint.hasFlag(CHECKPOINT_FUEL_WARNING_10));
+    EXPECT_DOUBLE_EQ(checkpoint.getState().windSpeed, 25.0);
+    EXPECT_EQ(checkpoint.getState().activeWaypoint, 2u);
+
+    FlightPlan plan = checkpoint.getFlightPlan();
+    EXPECT_EQ(plan.departure, "KSEA");
+    EXPECT_EQ(plan.arrival, "KPDX");
+    EXPECT_DOUBLE_EQ(plan.cruiseAltitude, 12000.0);
+    ASSERT_EQ(plan.waypoints.size(), 4u);
+    EXPECT_EQ(plan.waypoints[2].id, "OLM");
+    EXPECT_EQ(plan.waypoints[2].type, "VOR");
+    EXPECT_DOUBLE_EQ(plan.waypoints[2].position.latitude, makePlan().waypoints[2].position.latitude);
+
+    ASSERT_TRUE(checkpoint.hasClearances());
+    EXPECT_EQ(checkpoint.getClearanceEventCount(), 2u);
+    EXPECT_TRUE(checkpoint.getClearanceBase().clearedForTakeoff());
+    EXPECT_EQ(checkpoint.getLastClearance(), "Climb and maintain one two thousand");
+    ASSERT_EQ(checkpoint.getPendingInstructions().size(), 1u);
+    EXPECT_EQ(checkpoint.getPendingInstructions()[0], "Squawk: 4521");
+
+    ClearanceLog restored;
+    ASSERT_TRUE(restored.restore(checkpoint.getClearanceBase(), checkpoint.getClearanceEvents(),
+                                 checkpoint.getClearanceEventCount()));
+    EXPECT_EQ(restored.current().altitudeFeet, 12000);
+    EXPECT_EQ(restored.current().squawk, 4521);
+    EXPECT_EQ(restored.size(), 3u);
+
+    EXPECT_EQ(checkpoint.getWarmEntryCount(), 3u);
+    EXPECT_EQ(checkpoint.getWarmCache(1), WarmSetCache::TERRAIN_TILE);
+    EXPECT_EQ(checkpoint.getWarmKeys(WarmSetCache::AIRPORT), (std::vector<std::string>{"KSEA", "KPDX"}));
+    EXPECT_EQ(checkpoint.getModelSize(), 0u);
+
+    Navigation navigation;
+    navigation.restoreFlightPlan(plan, checkpoint.getState().activeWaypoint);
+    EXPECT_EQ(navigation.getActiveWaypoint().id, "OLM");
+    EXPECT_GT(navigation.getTotalDistance(), 100.0);
+}
+
+// Test: A written checkpoint maps read-only and an embedded model pack opens in place
+TEST(PilotCheckpointTest, MapsFileWithEmbeddedModel) {
+    ML::MLLearningSystem learner;
+    ML::MLFeatures features;
+    for (int i = 0; i < 10; ++i) {
+        ML::LearningOutcome outcome;
+        outcome.features = features.extractAllFeatures(
+            1000 + i, 5 + i, 180, 5000, 15, 6000, 150, 0, true, true, 1000, 0, false, false, 5, 2.5);
+        outcome.correct_prediction = i % 2 == 0;
+        learner.updateModelWithFeedback(outcome);
+    }
+    ModelPackBuilder modelBuilder;
+    learner.saveLearningState(modelBuilder);
+
+    PilotCheckpointBuilder builder = makeBuilder();
+    builder.setModelImage(modelBuilder.build());
+    auto path = (std::filesystem::temp_directory_path() / "aicopilot_checkpoint.aipc").string();
+    ASSERT_TRUE(builder.write(path));
+
+    PilotCheckpoint checkpoint;
+    ASSERT_TRUE(checkpoint.open(path));
+    EXPECT_TRUE(checkpoint.isMapped());
+    ASSERT_GT(checkpoint.getModelSize(), 0u);
+
+    ModelPack pack;
+    ASSERT_TRUE(pack.openView(checkpoint.getModelData(), checkpoint.getModelSize()));
+    EXPECT_FALSE(pack.isMapped());
+    ML::MLLearningSystem restored;
+    ASSERT_TRUE(restored.loadLearningState(pack));
+    EXPECT_EQ(restored.getAccuracyMetrics().total_samples, 10);
+    EXPECT_EQ(restored.getAccuracyMetrics().correct_predictions, 5);
+    pack.close();
+
+    checkpoint.close();
+    std::filesystem::remove(path);
+}
+
+// Test: Corrupt, truncated and foreign files are rejected
+TEST(PilotCheckpointTest, RejectsCorruptCheckpoints) {
+    std::vector<uint8_t> image = makeBuilder().build();
+
+    PilotCheckpoint checkpoint;
+    std::vector<uint8_t> flipped = image;
+    flipped.back() ^= 0x1;
+    EXPECT_FALSE(checkpoint.openImage(flipped));
+
+    std::vector<uint8_t> truncated(image.begin(), image.end() - 8);
+    EXPECT_FALSE(checkpoint.openImage(truncated));
+
+    std::vector<uint8_t> foreign = image;
+    foreign[0] = 'X';
+    EXPECT_FALSE(checkpoint.openImage(foreign));
+
+    // A string ref past the pool is refused even with a matching checksum
+    std::vector<uint8_t> badRef = image;
+    auto* header = reinterpret_cast<PilotCheckpointHeader*>(badRef.data());
+    auto* state = reinterpret_cast<PilotCheckpointState*>(badRef.data() + header->sections[CHECKPOINT_SECTION_PILOT].offset);
+    state->departure.length = 1u << 30;
+    EXPECT_FALSE(checkpoint.open("/nonexistent/checkpoint.aipc"));
+    auto path = (std::filesystem::temp_directory_path() / "aicopilot_bad_checkpoint.aipc").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(badRef.data()), static_cast<std::streamsize>(badRef.size()));
+    }
+    EXPECT_FALSE(checkpoint.open(path, false));
+    std::filesystem::remove(path);
+
+    EXPECT_TRUE(checkpoint.openImage(image));
+}
+
+// Test: A clearance log with a sequence gap is not restored
+TEST(PilotCheckpointTest, ClearanceRestoreRejectsGaps) {
+    ClearanceLog source = makeClearances();
+    std::vector<ClearanceEvent> events = source.events();
+    events[1].sequence += 1;
+
+    ClearanceLog log;
+    log.append(ClearanceEventType::HEADING, 90, 0);
+    EXPECT_FALSE(log.restore(source.base(), events.data(), events.size()));
+    EXPECT_EQ(log.current().headingDegrees, 90);   // unchanged
+}
+
+// Test: Capturing mid-flight waits for the worker tasks instead of racing them
+TEST(PilotCheckpointTest, CapturesWhileWorkersRun) {
+    auto cfgPath = (std::filesystem::temp_directory_path() / "aicopilot_checkpoint_aircraft.cfg").string();
+    {
+        std::ofstream out(cfgPath);
+        out << "[GENERAL]\natc_model=C172\n"
+            << "[REFERENCE SPEEDS]\ncruise_speed=120\nstall_speed=48\nmax_indicated_speed=160\n"
+            << "[GENERALENGINEDATA]\nengine_type=1\n[FUEL]\nfuel_capacity=53\n";
+    }
+
+    HeadlessSimConfig config;
+    config.start = {47.0, -122.0, 5000.0, 0.0};
+    config.startOnGround = false;
+    AIPilot pilot;
+    AIPilotThreading threading;
+    threading.schedulerWorkers = 2;
+    pilot.setThreading(threading);
+    ASSERT_TRUE(pilot.initializeHeadless(config));
+    ASSERT_TRUE(pilot.loadAircraftConfig(cfgPath));
+    pilot.startAutonomousFlight();
+
+    // The first tick hands the terrain lookup to a worker; the capture
+    // right after it must see that lookup finished
+    pilot.update();
+    PilotCheckpointBuilder first;
+    pilot.captureCheckpoint(first);
+    EXPECT_NE(first.state().flags & CHECKPOINT_TERRAIN_VALID, 0u);
+
+    for (int i = 0; i < static_cast<int>(10 * AIPilot::CONTROL_RATE_HZ); ++i) {
+        pilot.update();
+        PilotCheckpointBuilder builder;
+        pilot.captureCheckpoint(builder);
+        ASSERT_NE(builder.state().flags & CHECKPOINT_TERRAIN_VALID, 0u);
+        ASSERT_GT(builder.state().altitude, 0.0);
+    }
+    pilot.stopAutonomousFlight();
+    std::filesystem::remove(cfgPath);
+}
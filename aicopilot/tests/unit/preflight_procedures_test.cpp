@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include "../../include/preflight_procedures.h"
+#include "../../include/config_parser.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+using namespace AICopilot;
+
+namespace {
+
+const char* START_CHECKLIST =
+    "[B_START]\n"
+    "phase = engine_startup\n"
+    "description = Engine start\n"
+    "do = start_engine\n"
+    "argument = 1\n"
+    "condition = engine_rpm > 600 && fuel_quantity >= 5\n"
+    "timeout = 30\n"
+    "[A_WALK]\n"
+    "phase = exterior\n"
+    "description = Walkaround\n"
+    "[C_BRAKE]\n"
+    "phase = taxi\n"
+    "description = Parking brake released\n"
+    "condition = parking_brake == false\n"
+    "critical = false\n";
+
+AircraftConfig aircraft(int engines, const std::string& engineType, AircraftType type) {
+    AircraftConfig config{};
+    config.numberOfEngines = engines;
+    config.engineType = engineType;
+    config.aircraftType = type;
+    return config;
+}
+
+bool hasStep(const PreflightProcedures& preflight, const std::string& id) {
+    const auto& items = preflight.getAllItems();
+    return std::any_of(items.begin(), items.end(),
+                       [&](const ChecklistItem& item) { return item.id == id; });
+}
+
+} // namespace
+
+// Test: Steps compile in phase order with their conditions and actions
+TEST(PreflightProceduresTest, CompilesChecklistText) {
+    std::string error;
+    auto program = ChecklistProgram::compile(*ParsedConfig::fromText(START_CHECKLIST), error);
+    ASSERT_NE(program, nullptr) << error;
+    ASSERT_EQ(program->size(), 3u);
+
+    EXPECT_EQ(program->text(0).id, "A_WALK");
+    EXPECT_EQ(program->text(1).id, "B_START");
+    EXPECT_EQ(program->text(2).id, "C_BRAKE");
+
+    const ChecklistStep& start = program->step(1);
+    EXPECT_EQ(start.phase, PreflightPhase::ENGINE_STARTUP);
+    EXPECT_EQ(start.action, ChecklistAction::START_ENGINE);
+    EXPECT_EQ(start.argument, 1);
+    EXPECT_EQ(start.conditionCount, 2u);
+    EXPECT_FLOAT_EQ(start.timeout, 30.0f);
+    EXPECT_FALSE(program->step(2).critical);
+
+    AircraftState state{};
+    state.engineRPM = 800.0;
+    state.fuelQuantity = 5.0;
+    EXPECT_TRUE(program->evaluate(1, state));
+    state.fuelQuantity = 4.0;
+    EXPECT_FALSE(program->evaluate(1, state));
+    EXPECT_TRUE(program->evaluate(2, state));
+    state.parkingBrakeSet = true;
+    EXPECT_FALSE(program->evaluate(2, state));
+}
+
+// Test: A bad step rejects the whole file with the section named
+TEST(PreflightProceduresTest, RejectsBadSteps) {
+    std::string error;
+    EXPECT_EQ(ChecklistProgram::compile(*ParsedConfig::fromText(
+        "[X1]\nphase = taxi\ncondition = engine_rpm ~ 600\n"), error), nullptr);
+    EXPECT_NE(error.find("X1"), std::string::npos);
+
+    EXPECT_EQ(ChecklistProgram::compile(*ParsedConfig::fromText(
+        "[X2]\nphase = taxi\ncondition = oil_pressure > 20\n"), error), nullptr);
+    EXPECT_EQ(ChecklistProgram::compile(*ParsedConfig::fromText(
+        "[X3]\nphase = cruise\n"), error), nullptr);
+    EXPECT_EQ(ChecklistProgram::compile(*ParsedConfig::fromText(
+        "[X4]\nphase = taxi\ndo = barrel_roll\n"), error), nullptr);
+    EXPECT_EQ(ChecklistProgram::compile(*ParsedConfig::fromText(
+        "[X5]\nphase = taxi\napplies = glider\n"), error), nullptr);
+}
+
+// Test: The built-in checklist is shared and selects steps by aircraft
+TEST(PreflightProceduresTest, BuiltinSelectsByAircraft) {
+    auto program = ChecklistProgram::builtin();
+    ASSERT_NE(program, nullptr);
+    EXPECT_EQ(program, ChecklistProgram::builtin());
+
+    PreflightProcedures single;
+    ASSERT_TRUE(single.initialize(aircraft(1, "Piston", AircraftType::SINGLE_ENGINE_PROP)));
+    EXPECT_EQ(single.getProgram(), program.get());
+    EXPECT_TRUE(hasStep(single, "ENG007"));
+    EXPECT_FALSE(hasStep(single, "ENG013"));
+    EXPECT_FALSE(hasStep(single, "MENG001"));
+
+    PreflightProcedures twin;
+    ASSERT_TRUE(twin.initialize(aircraft(2, "Piston", AircraftType::MULTI_ENGINE_PROP)));
+    EXPECT_TRUE(hasStep(twin, "ENG013"));
+    EXPECT_FALSE(hasStep(twin, "ENG014"));
+    EXPECT_TRUE(hasStep(twin, "MENG001"));
+    EXPECT_GT(twin.getAllItems().size(), single.getAllItems().size());
+
+    // Ids stay unique once the extra engine steps are in
+    PreflightProcedures quad;
+    ASSERT_TRUE(quad.initialize(aircraft(4, "Jet", AircraftType::JET)));
+    std::vector<std::string> ids;
+    for (const auto& item : quad.getAllItems()) ids.push_back(item.id);
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(std::adjacent_find(ids.begin(), ids.end()), ids.end());
+}
+
+// Test: A step waits for its conditions until the timeout, running its action once
+TEST(PreflightProceduresTest, StepWaitsForConditions) {
+    std::string error;
+    auto program = ChecklistProgram::compile(*ParsedConfig::fromText(START_CHECKLIST), error);
+    ASSERT_NE(program, nullptr) << error;
+
+    PreflightProcedures preflight;
+    std::vector<std::pair<ChecklistAction, int>> actions;
+    preflight.setActionHandler([&](ChecklistAction action, int argument) {
+        actions.emplace_back(action, argument);
+    });
+    ASSERT_TRUE(preflight.initialize(aircraft(1, "Piston", AircraftType::SINGLE_ENGINE_PROP), program));
+    preflight.startPreflight(100.0);
+
+    AircraftState state{};
+    state.fuelQuantity = 20.0;
+    state.parkingBrakeSet = true;
+    EXPECT_FALSE(preflight.executeNextItem(state, 100.0));  // walkaround
+
+    // Engine not running yet: still in progress inside the timeout
+    EXPECT_FALSE(preflight.executeNextItem(state, 101.0));
+    EXPECT_EQ(preflight.getCurrentItem().status, ChecklistItemStatus::IN_PROGRESS);
+    EXPECT_FALSE(preflight.executeNextItem(state, 120.0));
+    EXPECT_EQ(preflight.getCurrentItem().id, "B_START");
+    ASSERT_EQ(actions.size(), 1u);
+    EXPECT_EQ(actions[0].first, ChecklistAction::START_ENGINE);
+    EXPECT_EQ(actions[0].second, 1);
+
+    state.engineRPM = 900.0;
+    EXPECT_FALSE(preflight.executeNextItem(state, 125.0));
+    EXPECT_EQ(preflight.getAllItems()[1].status, ChecklistItemStatus::COMPLETED);
+    EXPECT_DOUBLE_EQ(preflight.getAllItems()[1].completionTime, 25.0);
+
+    // Non-critical failure with no timeout does not fail the preflight
+    EXPECT_TRUE(preflight.executeNextItem(state, 126.0));
+    EXPECT_EQ(preflight.getAllItems()[2].status, ChecklistItemStatus::FAILED);
+    EXPECT_FALSE(preflight.hasFailed());
+    EXPECT_TRUE(preflight.executeNextItem(state, 127.0));
+    EXPECT_TRUE(preflight.isComplete());
+}
+
+// Test: A critical step that times out fails the preflight
+TEST(PreflightProceduresTest, CriticalTimeoutFails) {
+    std::string error;
+    auto program = ChecklistProgram::compile(*ParsedConfig::fromText(START_CHECKLIST), error);
+    ASSERT_NE(program, nullptr) << error;
+
+    PreflightProcedures preflight;
+    ASSERT_TRUE(preflight.initialize(aircraft(1, "Piston", AircraftType::SINGLE_ENGINE_PROP), program));
+    preflight.startPreflight(0.0);
+
+    AircraftState state{};
+    preflight.executeNextItem(state, 0.0);
+    EXPECT_FALSE(preflight.executeNextItem(state, 1.0));  // timeout runs from here
+    EXPECT_FALSE(preflight.executeNextItem(state, 30.0));
+    EXPECT_FALSE(preflight.hasFailed());
+    EXPECT_TRUE(preflight.executeNextItem(state, 31.0));
+    EXPECT_TRUE(preflight.hasFailed());
+
+    PreflightResult result = preflight.completePreflight(state);
+    EXPECT_FALSE(result.passed);
+    ASSERT_EQ(result.failedItems.size(), 1u);
+    EXPECT_EQ(result.failedItems[0].rfind("B_START", 0), 0u);
+}
+
+// Test: Loading the same file twice compiles it once
+TEST(PreflightProceduresTest, LoadCachesPerFile) {
+    auto path = (std::filesystem::temp_directory_path() / "preflight_test.cfg").string();
+    std::ofstream(path, std::ios::binary) << START_CHECKLIST;
+
+    std::string error;
+    auto first = ChecklistProgram::load(path, error);
+    ASSERT_NE(first, nullptr) << error;
+    EXPECT_EQ(ChecklistProgram::load(path, error), first);
+
+    ChecklistProgram::clearCache();
+    auto reloaded = ChecklistProgram::load(path, error);
+    ASSERT_NE(reloaded, nullptr);
+    EXPECT_EQ(reloaded->size(), first->size());
+
+    EXPECT_EQ(ChecklistProgram::load(path + ".missing", error), nullptr);
+    std::filesystem::remove(path);
+}
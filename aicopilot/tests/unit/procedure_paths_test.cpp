@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "../../include/procedure_paths.hpp"
+#include "../../include/dynamic_flight_planning.hpp"
+#include "../../include/navdata_database.hpp"
+#include <memory>
+
+using namespace AICopilot;
+
+namespace {
+
+std::shared_ptr<NavdataPack> makePack() {
+    NavdataPackBuilder builder;
+    builder.putWaypoint(NavdataWaypoint("KSEA", 47.4490, -122.3093, NavaidType::AIRPORT));
+    builder.putWaypoint(NavdataWaypoint("NORTH", 47.9, -122.3, NavaidType::FIX));
+    builder.putWaypoint(NavdataWaypoint("EAST", 47.45, -121.6, NavaidType::FIX));
+    builder.putWaypoint(NavdataWaypoint("SOUTH", 46.9, -122.3, NavaidType::FIX));
+    builder.putWaypoint(NavdataWaypoint("FAR", 46.2, -122.3, NavaidType::FIX));
+    auto pack = std::make_shared<NavdataPack>();
+    pack->openImage(builder.build());
+    return pack;
+}
+
+SID makeSID(const std::string& name, const std::string& runway, const std::string& exitFix) {
+    SID sid;
+    sid.airport = "KSEA";
+    sid.runway = runway;
+    sid.name = name;
+    sid.waypointSequence = {"KSEA", exitFix};
+    sid.altitudeRestrictions = {AltitudeRestriction(), AltitudeRestriction(AltitudeRestrictionType::ABOVE, 9000)};
+    sid.initialAltitude = 3000;
+    sid.procedureDistance = 99;
+    return sid;
+}
+
+ProcedurePathTable makeTable(const NavdataPack& pack) {
+    std::unordered_map<std::string, std::vector<SID>> sids;
+    sids["KSEA"] = {makeSID("NORTH1", "16L", "NORTH"), makeSID("EAST1", "16L", "EAST"),
+                    makeSID("GHOST1", "34R", "NOWHERE")};
+
+    STAR star;
+    star.airport = "KSEA";
+    star.runway = "16L";
+    star.name = "SOUTH1";
+    star.waypointSequence = {"SOUTH", "KSEA"};
+    star.altitudeRestrictions = {AltitudeRestriction(AltitudeRestrictionType::AT, 6000)};
+    star.speedRestrictions = {210.0};
+    star.initialAltitude = 11000;
+    star.finalAltitude = 2000;
+    star.transitionFixNames = {"FAR"};
+    std::unordered_map<std::string, std::vector<STAR>> stars;
+    stars["KSEA"] = {star};
+
+    ProcedurePathTable table;
+    table.build(pack, sids, stars);
+    return table;
+}
+
+} // namespace
+
+// Test: Each runway and transition is expanded once with distances and constraints
+TEST(ProcedurePathsTest, ExpandsPaths) {
+    auto pack = makePack();
+    ProcedurePathTable table = makeTable(*pack);
+    EXPECT_EQ(table.getPathCount(), 5u);  // three SIDs, the STAR common route and one transition
+    ASSERT_NE(table.find("KSEA"), nullptr);
+    EXPECT_EQ(table.find("KJFK"), nullptr);
+
+    const ProcedurePath* far = nullptr;
+    const ProcedurePath* ghost = nullptr;
+    for (const auto& path : *table.find("KSEA")) {
+        if (path.transition == "FAR") far = &path;
+        if (path.name == "GHOST1") ghost = &path;
+    }
+    ASSERT_NE(far, nullptr);
+    ASSERT_EQ(far->legs.size(), 3u);
+    EXPECT_EQ(far->legs[0].fix, "FAR");
+    EXPECT_NEAR(far->legs[1].legDistanceNM, 42.0, 0.5);   // 0.7 degrees of latitude
+    EXPECT_NEAR(far->legs[2].cumulativeNM, far->distanceNM, 1e-9);
+    EXPECT_EQ(far->legs[1].altitude.altitude1, 6000);     // constraints stay on their own fix
+    EXPECT_DOUBLE_EQ(far->legs[1].speedLimitKts, 210.0);
+    EXPECT_EQ(far->topAltitude, 11000);
+    EXPECT_EQ(far->bottomAltitude, 2000);
+    EXPECT_TRUE(far->hasGeometry);
+
+    ASSERT_NE(ghost, nullptr);
+    EXPECT_FALSE(ghost->hasGeometry);
+    EXPECT_DOUBLE_EQ(ghost->distanceNM, 99.0);            // falls back to the published distance
+    EXPECT_EQ(ghost->legs[1].node, NavdataPack::NO_INDEX);
+}
+
+// Test: Selection compares precomputed metrics, preferring the requested runway
+TEST(ProcedurePathsTest, SelectsByMetrics) {
+    auto pack = makePack();
+    ProcedurePathTable table = makeTable(*pack);
+
+    const ProcedurePath* sid = table.bestSID("KSEA", "RWY_16L", 48.5, -122.3);
+    ASSERT_NE(sid, nullptr);
+    EXPECT_EQ(sid->name, "NORTH1");
+    sid = table.bestSID("KSEA", "", 47.45, -120.0);
+    ASSERT_NE(sid, nullptr);
+    EXPECT_EQ(sid->name, "EAST1");
+    sid = table.bestSID("KSEA", "34R", 48.5, -122.3);
+    ASSERT_NE(sid, nullptr);
+    EXPECT_EQ(sid->name, "GHOST1");
+
+    // From the south the FAR transition is the nearer entry
+    const ProcedurePath* star = table.bestSTAR("KSEA", "16L", 45.5, -122.3);
+    ASSERT_NE(star, nullptr);
+    EXPECT_EQ(star->transition, "FAR");
+    star = table.bestSTAR("KSEA", "16L", 47.0, -122.3);
+    ASSERT_NE(star, nullptr);
+    EXPECT_TRUE(star->transition.empty());
+    EXPECT_EQ(table.bestSTAR("KORD", "", 0, 0), nullptr);
+
+    EXPECT_EQ(ProcedurePathTable::normalizeRunway("RW28L"), "28L");
+    EXPECT_EQ(ProcedurePathTable::normalizeRunway("rwy_28l"), "28L");
+}
+
+// Test: The planner fills procedures from the paths and times them by distance
+TEST(ProcedurePathsTest, PlannerUsesPaths) {
+    auto pack = makePack();
+    auto table = std::make_shared<ProcedurePathTable>(makeTable(*pack));
+    PerformanceProfile profile{};
+    profile.cruiseSpeed = 450.0;
+    DynamicFlightPlanning planner;
+    planner.initialize(profile);
+    planner.setProcedurePaths(table);
+
+    Waypoint fix;
+    fix.id = "ENRTE";
+    fix.position.latitude = 48.5;
+    fix.position.longitude = -122.3;
+    DepartureProcedure sid = planner.selectOptimalSID("KSEA", fix, AircraftType::JET);
+    EXPECT_EQ(sid.sidCode, "NORTH1");
+    ASSERT_EQ(sid.waypoints.size(), 2u);
+    EXPECT_EQ(sid.waypoints[1].id, "NORTH");
+    EXPECT_EQ(sid.transitionFix, "ENRTE");
+    EXPECT_DOUBLE_EQ(sid.finalAltitude, 9000.0);
+    EXPECT_NEAR(sid.estimatedTime, table->bestSID("KSEA", "", 48.5, -122.3)->distanceNM / 250.0 * 60.0, 1e-9);
+
+    Position position{45.5, -122.3, 15000.0, 0.0};
+    ArrivalProcedure star = planner.selectOptimalSTAR("KSEA", "RWY_16L", position);
+    EXPECT_EQ(star.starCode, "SOUTH1");
+    EXPECT_EQ(star.initialFix, "FAR");
+    EXPECT_DOUBLE_EQ(star.initialAltitude, 11000.0);
+    EXPECT_DOUBLE_EQ(star.finalAltitude, 2000.0);
+    EXPECT_GT(star.estimatedTime, 0.0);
+
+    // Airports without paths keep the generic procedures
+    EXPECT_FALSE(planner.selectOptimalSID("KXYZ", fix, AircraftType::JET).sidCode.empty());
+    planner.shutdown();
+}
+
+// Test: The database publishes paths for every snapshot
+TEST(ProcedurePathsTest, DatabaseBuildsPaths) {
+    NavigationDatabase db;
+    auto paths = db.GetProcedurePaths();
+    ASSERT_NE(paths, nullptr);
+    EXPECT_EQ(paths->getPathCount(), static_cast<size_t>(db.GetSIDCount() + db.GetSTARCount()));
+    EXPECT_NE(paths->find("KSEA"), nullptr);
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "../../include/reconnect_backoff.hpp"
+#include "../../include/simconnect_error_handler.hpp"
+#include <chrono>
+
+using namespace AICopilot;
+using std::chrono::milliseconds;
+
+// Test: Delays grow by the multiplier up to the cap and reset on success
+TEST(ReconnectBackoffTest, ExponentialScheduleWithCap) {
+    ReconnectBackoff backoff(milliseconds(100), 2.0, milliseconds(500));
+    auto t0 = ReconnectBackoff::Clock::now();
+    backoff.start(t0);
+    EXPECT_TRUE(backoff.due(t0));
+    EXPECT_EQ(backoff.untilNext(t0).count(), 0);
+
+    EXPECT_EQ(backoff.recordFailure(t0), milliseconds(100));
+    EXPECT_FALSE(backoff.due(t0 + milliseconds(99)));
+    EXPECT_TRUE(backoff.due(t0 + milliseconds(100)));
+    EXPECT_GE(backoff.untilNext(t0 + milliseconds(40)), milliseconds(60));
+
+    auto t = t0 + milliseconds(100);
+    EXPECT_EQ(backoff.recordFailure(t), milliseconds(200));
+    EXPECT_EQ(backoff.recordFailure(t), milliseconds(400));
+    EXPECT_EQ(backoff.recordFailure(t), milliseconds(500));
+    EXPECT_EQ(backoff.recordFailure(t), milliseconds(500));
+    EXPECT_EQ(backoff.getFailureCount(), 5);
+    EXPECT_EQ(backoff.nextAttempt(), t + milliseconds(500));
+
+    backoff.reset();
+    EXPECT_EQ(backoff.getFailureCount(), 0);
+    EXPECT_EQ(backoff.getNextDelay(), milliseconds(100));
+    EXPECT_TRUE(backoff.due(t0));
+
+    // Nonsense settings are clamped to a usable schedule
+    ReconnectBackoff clamped(milliseconds(0), 0.5, milliseconds(0));
+    EXPECT_EQ(clamped.recordFailure(t0), milliseconds(1));
+    EXPECT_EQ(clamped.recordFailure(t0), milliseconds(1));
+}
+
+// Test: Polling reconnects without sleeping and waits for the schedule
+TEST(ReconnectBackoffTest, ErrorHandlerPollsWithoutBlocking) {
+    SimConnectErrorHandler handler;
+    handler.initialize();
+    handler.setConfiguration(5, 1000, 1000, 60000, 2.0);
+    ASSERT_TRUE(handler.pollReconnection(SimulatorType::MSFS2024));
+    EXPECT_TRUE(handler.isConnected());
+
+    // A loss makes the first attempt due at once; the stub sim accepts it
+    handler.handleConnectionLoss();
+    EXPECT_EQ(handler.getConnectionState(), ConnectionState::CONNECTION_LOST);
+    auto started = std::chrono::steady_clock::now();
+    EXPECT_TRUE(handler.pollReconnection(SimulatorType::MSFS2024));
+    EXPECT_LT(std::chrono::steady_clock::now() - started, milliseconds(1000));
+    EXPECT_EQ(handler.getConnectionState(), ConnectionState::CONNECTED);
+
+    // Before the scheduled attempt nothing is tried
+    handler.handleConnectionLoss();
+    auto next = handler.getNextReconnectAttempt();
+    EXPECT_FALSE(handler.pollReconnection(SimulatorType::MSFS2024, next - milliseconds(1)));
+    EXPECT_EQ(handler.getConnectionState(), ConnectionState::CONNECTION_LOST);
+    EXPECT_TRUE(handler.pollReconnection(SimulatorType::MSFS2024, next));
+}
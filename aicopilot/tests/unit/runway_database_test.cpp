@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+#include "../../include/runway_database.h"
+#include "../../include/runway_database.hpp"
+#include "../../include/runway_database_prod.hpp"
+#include "../../include/runway_selector.hpp"
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+class RunwayDatabaseTest : public ::testing::Test {
+protected:
+    RunwayDatabase db;
+
+    void SetUp() override {
+        db.Initialize();
+    }
+
+    void TearDown() override {
+        db.Shutdown();
+    }
+};
+
+} // namespace
+
+// Test: Spans come back sorted and keep the table they came from after later writes
+TEST_F(RunwayDatabaseTest, GetRunwaysSpan) {
+    RunwaySpan runways = db.GetRunways("KJFK");
+    ASSERT_EQ(runways.size(), 4u);
+    for (size_t i = 1; i < runways.size(); ++i) {
+        EXPECT_LT(runways[i - 1].runwayId, runways[i].runwayId);
+    }
+    EXPECT_TRUE(db.GetRunways("INVALID").empty());
+
+    // A span keeps the table it came from; later lookups see new and replaced rows
+    RunwayInfo added = runways[0];
+    added.runwayId = "13L";
+    db.AddRunway(added);
+    RunwayInfo replaced = runways[0];
+    replaced.length = 12000;
+    db.AddRunway(replaced);
+    EXPECT_EQ(runways.size(), 4u);
+    EXPECT_EQ(db.GetRunways("KJFK").size(), 5u);
+
+    RunwayInfo rwy;
+    ASSERT_TRUE(db.GetRunwayInfo("KJFK", replaced.runwayId, rwy));
+    EXPECT_EQ(rwy.length, 12000);
+    RunwayAirportInfo apt;
+    ASSERT_TRUE(db.GetAirportInfo("KJFK", apt));
+    EXPECT_EQ(apt.runwayCount, 5);
+}
+
+// Test: Concurrent readers never see half of a batch, and Clear/Initialize restore the table
+TEST_F(RunwayDatabaseTest, ReadersSeeWholeVersions) {
+    int airports = db.GetAirportCount();
+    int runways = db.GetRunwayCount();
+    RunwayInfo base = db.GetRunways("KJFK")[0];
+
+    // Each batch is one version: readers see all of it or none of it
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                RunwayAirportInfo apt;
+                if (!db.GetAirportInfo("KJFK", apt) || apt.runwayCount % 2 != 0) torn++;
+                if (db.GetRunways("KJFK").size() % 2 != 0) torn++;
+            }
+        });
+    }
+    for (int i = 0; i < 50; ++i) {
+        RunwayInfo a = base;
+        RunwayInfo b = base;
+        a.runwayId = "X" + std::to_string(i) + "A";
+        b.runwayId = "X" + std::to_string(i) + "B";
+        db.AddRunways({a, b});
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_EQ(db.GetRunwayCount(), runways + 100);
+
+    RunwaySpan before = db.GetRunways("KJFK");
+    db.Clear();
+    EXPECT_EQ(db.GetRunwayCount(), 0);
+    EXPECT_FALSE(db.AirportExists("KJFK"));
+    EXPECT_EQ(before.size(), 104u);
+    ASSERT_TRUE(db.Initialize());
+    EXPECT_EQ(db.GetAirportCount(), airports);
+    EXPECT_EQ(db.GetRunwayCount(), runways);
+}
+
+// Test: Batch scoring picks the same runway, components and score as the per-airport selector
+TEST_F(RunwayDatabaseTest, ScoreBestRunwaysMatchesSelector) {
+    RunwaySelectionCriteria criteria;
+    criteria.maxAcceptableCrosswind = 20;
+    criteria.maxAcceptableTailwind = 5.0;
+    criteria.requiredDistance = 5000.0;
+
+    std::vector<RunwayWindQuery> queries;
+    int winds[][2] = {{220, 10}, {45, 18}, {310, 25}, {160, 7}};
+    int i = 0;
+    for (const std::string& icao : db.GetAirportCodes()) {
+        RunwayWindQuery query;
+        query.icao = icao;
+        query.windDirection = winds[i % 4][0];
+        query.windSpeed = winds[i % 4][1];
+        queries.push_back(query);
+        ++i;
+    }
+    queries.push_back({"ZZZZ", 0, 0});
+
+    std::vector<RunwayScore> scores = db.ScoreBestRunways(queries, criteria);
+    ASSERT_EQ(scores.size(), queries.size());
+    int found = 0;
+    for (size_t q = 0; q < queries.size(); ++q) {
+        RunwaySelectionCriteria single = criteria;
+        single.windDirection = queries[q].windDirection;
+        single.windSpeed = queries[q].windSpeed;
+        RunwaySpan runways = db.GetRunways(queries[q].icao);
+        RunwayInfo expected;
+        bool selected = RunwaySelector::SelectBestRunway(runways.begin(), runways.size(), single, expected);
+        ASSERT_EQ(scores[q].found, selected) << queries[q].icao;
+        if (!selected) continue;
+        found++;
+        EXPECT_EQ(scores[q].runwayId, expected.runwayId) << queries[q].icao;
+        EXPECT_EQ(scores[q].runwayNumber, RunwaySelector::ParseRunwayHeading(expected.runwayId));
+        auto components = RunwaySelector::CalculateWindComponents(
+            expected.headingMagnetic, single.windDirection, single.windSpeed);
+        EXPECT_NEAR(scores[q].headwind, components.headwind, 1e-9);
+        EXPECT_NEAR(scores[q].crosswind, components.crosswind, 1e-9);
+        EXPECT_NEAR(scores[q].score, RunwaySelector::ScoreRunway(expected, single, components), 1e-6);
+    }
+    EXPECT_GT(found, 0);
+    EXPECT_FALSE(scores.back().found);
+}
+
+// Test: A saved pack loads back with the same tables and scores, and later additions merge on top
+TEST_F(RunwayDatabaseTest, PackRoundTrip) {
+    auto path = (std::filesystem::temp_directory_path() / "aicopilot_runways.arp").string();
+    ASSERT_TRUE(db.SavePack(path));
+
+    RunwayDatabase loaded;
+    ASSERT_TRUE(loaded.LoadPack(path));
+    EXPECT_EQ(loaded.GetAirportCount(), db.GetAirportCount());
+    EXPECT_EQ(loaded.GetRunwayCount(), db.GetRunwayCount());
+    EXPECT_EQ(loaded.GetAirportCodes(), db.GetAirportCodes());
+    EXPECT_EQ(loaded.GetStatistics(), db.GetStatistics());
+
+    RunwayInfo a, b;
+    ASSERT_TRUE(loaded.GetRunwayInfo("KJFK", "04L", a));
+    ASSERT_TRUE(db.GetRunwayInfo("KJFK", "04L", b));
+    EXPECT_EQ(a.length, b.length);
+    EXPECT_EQ(a.ilsData.localizerFrequency, b.ilsData.localizerFrequency);
+    RunwayAirportInfo apt;
+    ASSERT_TRUE(loaded.GetAirportInfo("EGLL", apt));
+    EXPECT_EQ(apt.runwayCount, static_cast<int>(db.GetRunways("EGLL").size()));
+
+    // Identical answers from the pack's precomputed headings
+    RunwaySelectionCriteria criteria;
+    criteria.requiredDistance = 5000.0;
+    std::vector<RunwayWindQuery> queries = {{"KJFK", 220, 10}, {"KLAX", 250, 15}, {"EGLL", 270, 20}};
+    std::vector<RunwayScore> fromPack = loaded.ScoreBestRunways(queries, criteria);
+    std::vector<RunwayScore> fromCode = db.ScoreBestRunways(queries, criteria);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        EXPECT_EQ(fromPack[i].runwayId, fromCode[i].runwayId);
+        EXPECT_DOUBLE_EQ(fromPack[i].score, fromCode[i].score);
+    }
+
+    // Later additions merge on top of the loaded pack
+    RunwayInfo added = a;
+    added.runwayId = "13L";
+    loaded.AddRunway(added);
+    EXPECT_EQ(loaded.GetRunways("KJFK").size(), db.GetRunways("KJFK").size() + 1);
+    EXPECT_FALSE(loaded.LoadPack(path + ".missing"));
+    std::filesystem::remove(path);
+}
+
+// Test: The approach and simple facades read and write one shared store
+TEST_F(RunwayDatabaseTest, FacadesShareOneStore) {
+    auto store = std::make_shared<RunwayDatabase>();
+    store->Initialize();
+    ApproachRunwayDatabase approach(store);
+    SimpleRunwayDatabase simple(store);
+    EXPECT_EQ(approach.getRunwayCount(), store->GetRunwayCount());
+    EXPECT_EQ(simple.GetRunwayCount("KJFK"), static_cast<int>(store->GetRunways("KJFK").size()));
+
+    ApproachRunwayInfo added{};
+    added.icaoCode = "KTST";
+    added.runwayId = "18";
+    added.headingMagnetic = 180;
+    added.headingTrue = 178;
+    added.length = 8000;
+    added.width = 150;
+    added.surfaceType = "CONC";
+    added.ilsData.hasILS = true;
+    added.ilsData.category = "CAT II";
+    approach.addRunway(added);
+
+    // Written through one facade, read through the other and the store
+    RunwayInfo stored;
+    ASSERT_TRUE(store->GetRunwayInfo("KTST", "18", stored));
+    EXPECT_EQ(stored.surface, SurfaceType::CONCRETE);
+    EXPECT_EQ(stored.ilsData.category, ILSCategory::CAT_II);
+    EXPECT_TRUE(simple.HasRunwayWithILS("KTST"));
+    EXPECT_EQ(simple.GetPrimaryRunway("KTST").surface_type, "CONCRETE");
+    EXPECT_EQ(simple.GetRunwayForHeading("KTST", 175), "18");
+
+    ApproachRunwayInfo read;
+    ASSERT_TRUE(approach.getRunway("KTST", "18", read));
+    EXPECT_EQ(read.length, 8000);
+    EXPECT_EQ(read.ilsData.category, "CAT II");
+    EXPECT_EQ(approach.getAirportRunways("KJFK").size(), store->GetRunways("KJFK").size());
+}
+
+// Test: Memoized landing selection matches the selector and is retired by a new version
+TEST_F(RunwayDatabaseTest, SelectionCacheMatchesSelector) {
+    std::vector<RunwayInfo> jfk = db.GetAllRunways("KJFK");
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int direction = 0; direction <= 360; direction += 15) {
+            for (int speed : {0, 8, 25}) {
+                RunwaySelectionCriteria criteria;
+                criteria.windDirection = direction;
+                criteria.windSpeed = speed;
+                criteria.maxAcceptableCrosswind = 20.0;
+                criteria.maxAcceptableTailwind = 5.0;
+                criteria.preferILS = true;
+                criteria.requiredDistance = 5000.0;
+                RunwayInfo expected;
+                RunwaySelector::SelectBestRunway(jfk, criteria, expected);
+                EXPECT_EQ(db.GetBestRunwayForLanding("KJFK", direction, speed, 20.0).runwayId, expected.runwayId);
+            }
+        }
+    }
+    StripedCacheStats stats = db.GetSelectionCacheStats();
+    EXPECT_GT(stats.hits, 0u);
+    EXPECT_GT(stats.entries, 0u);
+
+    // A new version of the database retires the memo
+    RunwayInfo selected = db.GetBestRunwayForLanding("KJFK", 40, 10, 20.0);
+    ASSERT_FALSE(selected.runwayId.empty());
+    selected.length = 3000;
+    selected.LDA = 3000;
+    db.AddRunway(selected);
+    EXPECT_NE(db.GetBestRunwayForLanding("KJFK", 40, 10, 20.0).runwayId, selected.runwayId);
+    db.Clear();
+    EXPECT_TRUE(db.GetBestRunwayForLanding("KJFK", 40, 10, 20.0).runwayId.empty());
+    EXPECT_TRUE(db.GetBestRunwayForTakeoff("KJFK", 40, 10).runwayId.empty());
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "../../include/runway_pack.hpp"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+using namespace AICopilot;
+
+namespace {
+
+RunwayInfo makeRunway(const std::string& icao, const std::string& id, int heading, int length) {
+    RunwayInfo rwy;
+    rwy.icao = icao;
+    rwy.runwayId = id;
+    rwy.headingMagnetic = heading;
+    rwy.headingTrue = heading - 13;
+    rwy.length = length;
+    rwy.width = 150;
+    rwy.LDA = length - 500;
+    rwy.surface = SurfaceType::ASPHALT;
+    return rwy;
+}
+
+RunwayPackBuilder makeBuilder() {
+    RunwayPackBuilder builder;
+    RunwayAirportInfo jfk;
+    jfk.icao = "KJFK";
+    jfk.iata = "JFK";
+    jfk.name = "John F. Kennedy International Airport";
+    jfk.latitude = 40.6413;
+    jfk.longitude = -73.7781;
+    jfk.elevation = 13;
+    jfk.hasMajorILS = true;
+    builder.putAirport(jfk);
+    RunwayAirportInfo lga;
+    lga.icao = "KLGA";
+    lga.name = "LaGuardia Airport";
+    builder.putAirport(lga);
+
+    RunwayInfo rwy04l = makeRunway("KJFK", "04L", 44, 12079);
+    rwy04l.airportName = jfk.name;
+    rwy04l.ilsData.hasILS = true;
+    rwy04l.ilsData.category = ILSCategory::CAT_I;
+    rwy04l.ilsData.localizerFrequency = 110.9;
+    rwy04l.ilsData.identifier = "IHIQ";
+    rwy04l.hasALS = true;
+    rwy04l.remarks = "Noise abatement";
+    builder.putRunway(makeRunway("KJFK", "22R", 224, 12079));
+    builder.putRunway(makeRunway("KJFK", "04L", 44, 1000));
+    builder.putRunway(rwy04l);                               // replaces the one above
+    builder.putRunway(makeRunway("KBOS", "09", 92, 7000));   // no airport information
+    builder.putRunway(makeRunway("KBOS", "4R", 35, 10005));
+    return builder;
+}
+
+} // namespace
+
+// Test: Airports and runways survive compilation, grouped by airport and sorted by runway ID
+TEST(RunwayPackTest, RoundTripsRecords) {
+    RunwayPackBuilder builder = makeBuilder();
+    EXPECT_EQ(builder.getRunwayCount(), 4u);
+    RunwayPack pack;
+    ASSERT_TRUE(pack.openImage(builder.build()));
+    EXPECT_FALSE(pack.isMapped());
+    EXPECT_EQ(pack.getAirportCount(), 3u);   // KBOS, KJFK, KLGA
+    EXPECT_EQ(pack.getRunwayCount(), 4u);
+
+    uint32_t jfk = pack.findAirport("KJFK");
+    ASSERT_NE(jfk, RunwayPack::NO_INDEX);
+    RunwayAirportInfo airport = pack.getAirport(jfk);
+    EXPECT_EQ(airport.iata, "JFK");
+    EXPECT_EQ(airport.elevation, 13);
+    EXPECT_TRUE(airport.hasMajorILS);
+    EXPECT_EQ(airport.runwayIds, (std::vector<std::string>{"04L", "22R"}));
+
+    const RunwayPackAirport& record = pack.getAirportRecord(jfk);
+    RunwayInfo rwy = pack.getRunway(record.firstRunway);
+    EXPECT_EQ(rwy.icao, "KJFK");
+    EXPECT_EQ(rwy.runwayId, "04L");
+    EXPECT_EQ(rwy.length, 12079);
+    EXPECT_EQ(rwy.LDA, 11579);
+    EXPECT_EQ(rwy.headingTrue, 31);
+    EXPECT_TRUE(rwy.ilsData.hasILS);
+    EXPECT_EQ(rwy.ilsData.category, ILSCategory::CAT_I);
+    EXPECT_DOUBLE_EQ(rwy.ilsData.localizerFrequency, 110.9);
+    EXPECT_EQ(rwy.ilsData.identifier, "IHIQ");
+    EXPECT_TRUE(rwy.hasALS);
+    EXPECT_FALSE(rwy.hasREIL);
+    EXPECT_EQ(rwy.remarks, "Noise abatement");
+    EXPECT_EQ(rwy.surface, SurfaceType::ASPHALT);
+
+    const RunwayPackRunway& rwyRecord = pack.getRunwayRecord(record.firstRunway);
+    EXPECT_NEAR(rwyRecord.headingSin, std::sin(44 * 3.14159265358979323846 / 180.0), 1e-12);
+    EXPECT_EQ(rwyRecord.runwayNumber, 4);
+
+    // Runways without airport information still get an airport entry
+    uint32_t bos = pack.findAirport("KBOS");
+    ASSERT_NE(bos, RunwayPack::NO_INDEX);
+    EXPECT_EQ(pack.getAirportRecord(bos).hasInfo, 0);
+    EXPECT_EQ(pack.getAirportRecord(bos).runwayCount, 2u);
+    EXPECT_EQ(pack.getRunwayRecord(pack.getAirportRecord(bos).firstRunway).runwayNumber, 9);
+    EXPECT_EQ(pack.getRunwayRecord(pack.getAirportRecord(bos).firstRunway + 1).runwayNumber, 4);
+
+    uint32_t lga = pack.findAirport("KLGA");
+    ASSERT_NE(lga, RunwayPack::NO_INDEX);
+    EXPECT_EQ(pack.getAirportRecord(lga).runwayCount, 0u);
+    EXPECT_EQ(pack.findAirport("EGLL"), RunwayPack::NO_INDEX);
+}
+
+// Test: Files are mapped, and corrupted or truncated files are rejected
+TEST(RunwayPackTest, OpenValidatesFiles) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_runway_pack";
+    std::filesystem::create_directories(dir);
+    auto path = (dir / "runways.arp").string();
+    ASSERT_TRUE(makeBuilder().write(path));
+
+    {
+        RunwayPack pack;
+        ASSERT_TRUE(RunwayPack::isPackFile(path));
+        ASSERT_TRUE(pack.open(path));
+        EXPECT_TRUE(pack.isMapped());
+        EXPECT_NE(pack.findAirport("KBOS"), RunwayPack::NO_INDEX);
+
+        auto copy = (dir / "copy.arp").string();
+        ASSERT_TRUE(pack.save(copy));
+        RunwayPack reopened;
+        EXPECT_TRUE(reopened.open(copy));
+        EXPECT_EQ(reopened.getChecksum(), pack.getChecksum());
+    }
+
+    std::vector<uint8_t> image = makeBuilder().build();
+    image[image.size() - 1] ^= 0x5A;
+    RunwayPack corrupt;
+    EXPECT_FALSE(corrupt.openImage(image));
+    EXPECT_FALSE(corrupt.isOpen());
+
+    image = makeBuilder().build();
+    image.resize(image.size() - 8);
+    EXPECT_FALSE(corrupt.openImage(image));
+
+    std::ofstream(dir / "garbage.arp") << "not a pack";
+    EXPECT_FALSE(RunwayPack::isPackFile((dir / "garbage.arp").string()));
+    EXPECT_FALSE(corrupt.open((dir / "garbage.arp").string()));
+
+    std::filesystem::remove_all(dir);
+}
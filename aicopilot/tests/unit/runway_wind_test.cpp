@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "../../include/runway_wind.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// The components straight from the relative wind angle
+RunwayWind::Components reference(double heading, double direction, double speed) {
+    double angle = (direction - heading) * RunwayWind::DEG_TO_RAD;
+    return RunwayWind::Components{speed * std::cos(angle), speed * std::sin(angle)};
+}
+
+} // namespace
+
+// Test: Unit-vector components match the relative-angle formula around the compass
+TEST(RunwayWindTest, MatchesRelativeAngle) {
+    for (int heading = 0; heading < 360; heading += 15) {
+        for (int direction = 0; direction <= 360; direction += 20) {
+            RunwayWind::Components wind = RunwayWind::compute(heading, direction, 17.0);
+            RunwayWind::Components expected = reference(heading, direction, 17.0);
+            EXPECT_NEAR(wind.headwind, expected.headwind, 1e-9) << heading << " " << direction;
+            EXPECT_NEAR(wind.crosswind, expected.crosswind, 1e-9) << heading << " " << direction;
+        }
+    }
+
+    // Wind from the right is positive, a tailwind negative
+    RunwayWind::Components right = RunwayWind::compute(360.0, 90.0, 10.0);
+    EXPECT_NEAR(right.crosswind, 10.0, 1e-9);
+    EXPECT_NEAR(right.headwind, 0.0, 1e-9);
+    EXPECT_NEAR(RunwayWind::compute(90.0, 270.0, 10.0).headwind, -10.0, 1e-9);
+}
+
+// Test: A per-airport wind field is applied to each airport's own runways
+TEST(RunwayWindTest, MatrixEvaluatesWindField) {
+    RunwayWind::CrosswindMatrix matrix;
+    EXPECT_EQ(matrix.airportCount(), 0u);
+    EXPECT_EQ(matrix.addAirport(), 0u);
+    matrix.addRunway(40.0);
+    matrix.addRunway(220.0);
+    EXPECT_EQ(matrix.addAirport(), 1u);    // no runways
+    EXPECT_EQ(matrix.addAirport(), 2u);
+    matrix.addRunway(130.0);
+    matrix.addRunway(310.0);
+    matrix.addRunway(40.0);
+    ASSERT_EQ(matrix.airportCount(), 3u);
+    ASSERT_EQ(matrix.runwayCount(), 5u);
+    EXPECT_EQ(matrix.count(0), 2u);
+    EXPECT_EQ(matrix.count(1), 0u);
+    EXPECT_EQ(matrix.first(2), 2u);
+    EXPECT_EQ(matrix.count(2), 3u);
+
+    std::vector<RunwayWind::Wind> winds = {RunwayWind::wind(60.0, 12.0), RunwayWind::wind(0.0, 50.0),
+                                           RunwayWind::wind(300.0, 25.0)};
+    std::vector<double> headwind(5), crosswind(5);
+    matrix.evaluate(winds.data(), headwind.data(), crosswind.data());
+
+    const double headings[] = {40.0, 220.0, 130.0, 310.0, 40.0};
+    const double directions[] = {60.0, 60.0, 300.0, 300.0, 300.0};
+    const double speeds[] = {12.0, 12.0, 25.0, 25.0, 25.0};
+    for (size_t i = 0; i < 5; ++i) {
+        RunwayWind::Components expected = reference(headings[i], directions[i], speeds[i]);
+        EXPECT_NEAR(headwind[i], expected.headwind, 1e-9) << i;
+        EXPECT_NEAR(crosswind[i], expected.crosswind, 1e-9) << i;
+    }
+
+    // One wind everywhere
+    matrix.evaluate(RunwayWind::wind(40.0, 10.0), headwind.data(), crosswind.data());
+    EXPECT_NEAR(headwind[0], 10.0, 1e-9);
+    EXPECT_NEAR(headwind[1], -10.0, 1e-9);
+    EXPECT_NEAR(crosswind[4], 0.0, 1e-9);
+}
+
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "../../include/simconnect_recording.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using namespace AICopilot;
+
+namespace {
+
+std::string tempCapturePath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+// Test: Records round-trip with timestamps and payload bytes intact
+TEST(SimConnectRecordingTest, RoundTrip) {
+    std::string path = tempCapturePath("aicopilot_roundtrip.cap");
+
+    const char first[] = "first-message";
+    const uint8_t second[64] = {1, 2, 3, 4};
+    {
+        SimConnectRecorder recorder;
+        ASSERT_TRUE(recorder.open(path));
+        EXPECT_TRUE(recorder.write(0, first, sizeof(first)));
+        EXPECT_TRUE(recorder.write(16667, second, sizeof(second)));
+        EXPECT_EQ(recorder.getRecordCount(), 2u);
+    }
+
+    SimConnectCaptureReader reader;
+    ASSERT_TRUE(reader.open(path));
+
+    ASSERT_TRUE(reader.hasRecord());
+    EXPECT_EQ(reader.timestampUs(), 0u);
+    ASSERT_EQ(reader.size(), sizeof(first));
+    EXPECT_EQ(std::memcmp(reader.data(), first, sizeof(first)), 0);
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(reader.timestampUs(), 16667u);
+    ASSERT_EQ(reader.size(), sizeof(second));
+    EXPECT_EQ(std::memcmp(reader.data(), second, sizeof(second)), 0);
+
+    EXPECT_FALSE(reader.next());
+    EXPECT_FALSE(reader.hasRecord());
+    EXPECT_EQ(reader.getRecordCount(), 2u);
+
+    reader.close();
+    std::remove(path.c_str());
+}
+
+// Test: Files without the capture header are rejected
+TEST(SimConnectRecordingTest, RejectsForeignFile) {
+    std::string path = tempCapturePath("aicopilot_foreign.cap");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "definitely not a capture file";
+    }
+
+    SimConnectCaptureReader reader;
+    EXPECT_FALSE(reader.open(path));
+    EXPECT_FALSE(reader.isOpen());
+    std::remove(path.c_str());
+}
+
+// Test: A truncated trailing record ends the stream cleanly
+TEST(SimConnectRecordingTest, TruncatedRecordStopsReplay) {
+    std::string path = tempCapturePath("aicopilot_truncated.cap");
+    {
+        SimConnectRecorder recorder;
+        ASSERT_TRUE(recorder.open(path));
+        const uint8_t payload[32] = {};
+        recorder.write(100, payload, sizeof(payload));
+        recorder.write(200, payload, sizeof(payload));
+    }
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+
+    SimConnectCaptureReader reader;
+    ASSERT_TRUE(reader.open(path));
+    EXPECT_TRUE(reader.hasRecord());
+    EXPECT_FALSE(reader.next());
+    EXPECT_EQ(reader.getRecordCount(), 1u);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+#include "../../include/srtm_loader.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// Writes an SRTM3 tile with value(row, col) at each sample
+template <typename ValueFn>
+std::string writeTileWith(const std::filesystem::path& dir, int lat, int lon, ValueFn value_at) {
+    std::filesystem::create_directories(dir);
+    std::filesystem::path path = dir / SRTMTile::GetFileName(lat, lon);
+
+    const int n = SRTMTile::SRTM3_SIZE;
+    std::vector<uint8_t> bytes(static_cast<size_t>(n) * n * 2);
+    for (int row = 0; row < n; ++row) {
+        for (int col = 0; col < n; ++col) {
+            int16_t value = value_at(row, col);
+            size_t i = (static_cast<size_t>(row) * n + col) * 2;
+            bytes[i] = static_cast<uint8_t>((static_cast<uint16_t>(value) >> 8) & 0xFF);
+            bytes[i + 1] = static_cast<uint8_t>(static_cast<uint16_t>(value) & 0xFF);
+        }
+    }
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    return path.string();
+}
+
+// Writes an SRTM3 tile whose sample value encodes its row and column
+std::string writeTestTile(const std::filesystem::path& dir, int lat, int lon, int rowWeight = 1) {
+    return writeTileWith(dir, lat, lon, [rowWeight](int row, int col) {
+        if (row == 0 && col == 0) return SRTMTile::VOID_VALUE;
+        return static_cast<int16_t>(row * rowWeight + col);
+    });
+}
+
+} // namespace
+
+// Test: Mapped and copied tiles decode the same big-endian samples
+TEST(SRTMLoaderTest, MappedMatchesCopied) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_srtm_test";
+    std::string path = writeTestTile(dir, 39, -105);
+
+    SRTMTile copied(39, -105);
+    SRTMTile mapped(39, -105);
+    ASSERT_TRUE(copied.LoadFromFile(path));
+    ASSERT_TRUE(mapped.MapFile(path));
+
+    EXPECT_FALSE(copied.IsMapped());
+    EXPECT_TRUE(mapped.IsMapped());
+    EXPECT_EQ(mapped.GetSamplesPerSide(), SRTMTile::SRTM3_SIZE);
+    EXPECT_EQ(mapped.GetMemoryUsage(), 0u);
+    EXPECT_EQ(mapped.GetMappedSize(), static_cast<size_t>(SRTMTile::SRTM3_TILE_SIZE_BYTES));
+
+    EXPECT_TRUE(mapped.IsVoid(0, 0));
+    EXPECT_EQ(mapped.GetRawElevation(100, 250), 350);
+    EXPECT_EQ(mapped.GetRawElevation(1200, 1200), copied.GetRawElevation(1200, 1200));
+    EXPECT_DOUBLE_EQ(mapped.GetElevation(10.5, 20.25), copied.GetElevation(10.5, 20.25));
+    EXPECT_DOUBLE_EQ(mapped.GetFillPercentage(), copied.GetFillPercentage());
+
+    std::filesystem::remove_all(dir);
+}
+
+// Test: Files that are not an HGT size are rejected by both paths
+TEST(SRTMLoaderTest, RejectsWrongSize) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_srtm_bad";
+    std::filesystem::create_directories(dir);
+    std::string path = (dir / "N00E000.hgt").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a tile";
+    }
+
+    SRTMTile tile;
+    EXPECT_FALSE(tile.MapFile(path));
+    EXPECT_FALSE(tile.LoadFromFile(path));
+    EXPECT_FALSE(tile.IsLoaded());
+    std::filesystem::remove_all(dir);
+}
+
+// Test: The loader maps tiles by default and converts to feet
+TEST(SRTMLoaderTest, LoaderUsesMappedTiles) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_srtm_loader";
+    writeTestTile(dir, 39, -105);
+
+    SRTMLoader loader(dir.string());
+    EXPECT_EQ(loader.GetTileMode(), SRTMTileMode::MAPPED);
+
+    // Tile center: row 600, col 600 -> 1200 m
+    double elevation = loader.GetElevation(39.5, -104.5);
+    EXPECT_NEAR(elevation, 1200.0 * 3.28084, 1e-6);
+    EXPECT_EQ(loader.GetCacheSize(), 1);
+    EXPECT_EQ(loader.GetCacheMemoryUsage(), 0u);
+
+    loader.ClearCache();
+    std::filesystem::remove_all(dir);
+}
+
+// Test: Repeated lookups in one tile hit the cache and the byte budget bounds it
+TEST(SRTMLoaderTest, CacheCountsHitsAndHonorsBudget) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_srtm_cache";
+    writeTestTile(dir, 39, -105);
+    writeTestTile(dir, 39, -104);
+
+    SRTMLoader loader(dir.string(), SRTMTileMode::COPY);
+    loader.SetCacheBudget(SRTMTile::SRTM3_TILE_SIZE_BYTES);
+
+    loader.GetElevation(39.5, -104.5);
+    loader.GetElevation(39.25, -104.75);
+    loader.GetElevation(39.5, -103.5);
+
+    TileCacheStats stats = loader.GetCacheStats();
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(loader.GetCacheSize(), 1);
+    EXPECT_EQ(loader.GetCacheMemoryUsage(), static_cast<size_t>(SRTMTile::SRTM3_TILE_SIZE_BYTES));
+
+    std::filesystem::remove_all(dir);
+}
+
+// Test: Non-blocking lookups report PENDING until the tile is prefetched
+TEST(SRTMLoaderTest, TryGetElevationReportsPending) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_srtm_pending";
+    writeTestTile(dir, 39, -105);
+    SRTMLoader loader(dir.string());
+
+    double elevation = 0.0;
+    EXPECT_EQ(loader.TryGetElevation(39.5, -104.5, elevation), TileLookupStatus::PENDING);
+    EXPECT_DOUBLE_EQ(elevation, SRTMLoader::PENDING_ELEVATION_FT);
+    EXPECT_EQ(loader.GetCacheSize(), 0);
+
+    EXPECT_TRUE(loader.PrefetchTile(39, -105));
+    EXPECT_EQ(loader.TryGetElevation(39.5, -104.5, elevation), TileLookupStatus::READY);
+    EXPECT_NEAR(elevation, 1200.0 * 3.28084, 1e-6);
+
+    EXPECT_FALSE(loader.PrefetchTile(10, 10));
+    EXPECT_EQ(loader.TryGetElevation(10.5, 10.5, elevation), TileLookupStatus::NO_DATA);
+    EXPECT_DOUBLE_EQ(elevation, 0.0);
+
+    std::filesystem::remove_all(dir);
+}
+
+// Test: Interpolation runs along rows for the row fraction and columns for the column fraction
+TEST(SRTMLoaderTest, InterpolatesRowsAndColumnsSeparately) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_srtm_axes";
+    std::string path = writeTestTile(dir, 10, 10, 10);
+
+    SRTMTile tile(10, 10);
+    ASSERT_TRUE(tile.LoadFromFile(path));
+    EXPECT_DOUBLE_EQ(tile.GetElevation(2.5, 3.25), 25.0 + 3.25);
+    EXPECT_DOUBLE_EQ(tile.GetElevation(1200.0, 1200.0), 13200.0);
+
+    std::filesystem::remove_all(dir);
+}
+
+// Test: Batched lookups across tiles match point-by-point lookups
+TEST(SRTMLoaderTest, BatchedElevationsMatchScalar) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_srtm_batch";
+    writeTestTile(dir, 39, -105, 3);
+    writeTestTile(dir, 39, -104, 3);
+
+    SRTMLoader loader(dir.string());
+    std::vector<LatLon> points;
+    for (int i = 0; i < 2000; ++i) {
+        LatLon p;
+        p.latitude = 39.05 + 0.9 * (i % 37) / 37.0;
+        p.longitude = -104.95 + 1.9 * i / 2000.0;  // crosses into the next tile
+        points.push_back(p);
+    }
+    points.push_back(LatLon{10.5, 10.5});  // no tile
+
+    std::vector<double> batched = loader.GetElevations(points);
+    ASSERT_EQ(batched.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_DOUBLE_EQ(batched[i], loader.GetElevation(points[i].latitude, points[i].longitude));
+    }
+    EXPECT_DOUBLE_EQ(batched.back(), 0.0);
+    EXPECT_EQ(loader.GetCacheSize(), 2);
+
+    std::filesystem::remove_all(dir);
+}
+
+// Test: Pyramid ranges match a brute-force scan on block boundaries and stay conservative elsewhere
+TEST(SRTMLoaderTest, PyramidRangeMatchesScan) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_srtm_pyramid";
+    std::string path = writeTileWith(dir, 20, 30, [](int row, int col) {
+        if (row == 5 && col == 5) return SRTMTile::VOID_VALUE;
+        return static_cast<int16_t>((row * 37 + col * 11) % 3000 - 100);
+    });
+
+    SRTMTile tile(20, 30);
+    ASSERT_TRUE(tile.MapFile(path));
+    EXPECT_FALSE(tile.HasPyramid());
+
+    auto scan = [&tile](int r0, int c0, int r1, int c1) {
+        SRTMElevationRange range;
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) {
+                int16_t v = tile.GetRawElevation(r, c);
+                if (v == SRTMTile::VOID_VALUE) continue;
+                range.min_m = std::min(range.min_m, v);
+                range.max_m = std::max(range.max_m, v);
+            }
+        }
+        return range;
+    };
+
+    const int b = SRTMTile::PYRAMID_BLOCK;
+    SRTMElevationRange aligned = tile.GetElevationRange(2 * b, 3 * b, 40 * b - 1, 9 * b - 1);
+    SRTMElevationRange expected = scan(2 * b, 3 * b, 40 * b - 1, 9 * b - 1);
+    EXPECT_TRUE(tile.HasPyramid());
+    EXPECT_EQ(aligned.min_m, expected.min_m);
+    EXPECT_EQ(aligned.max_m, expected.max_m);
+
+    SRTMElevationRange whole = tile.GetElevationRange(0, 0, 1200, 1200);
+    SRTMElevationRange wholeScan = scan(0, 0, 1200, 1200);
+    EXPECT_EQ(whole.min_m, wholeScan.min_m);
+    EXPECT_EQ(whole.max_m, wholeScan.max_m);
+
+    SRTMElevationRange partial = tile.GetElevationRange(101, 733, 117, 740);
+    SRTMElevationRange partialScan = scan(101, 733, 117, 740);
+    EXPECT_LE(partial.min_m, partialScan.min_m);
+    EXPECT_GE(partial.max_m, partialScan.max_m);
+
+    std::filesystem::remove_all(dir);
+}
+
+// Test: Area and corridor maxima find an isolated peak and ignore it when out of range
+TEST(SRTMLoaderTest, MaxElevationFindsPeak) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_srtm_peak";
+    // Peak of 3000 m at row 600, col 300 -> 39.5N, 104.75W
+    writeTileWith(dir, 39, -105, [](int row, int col) {
+        return static_cast<int16_t>((row == 600 && col == 300) ? 3000 : 100);
+    });
+
+    SRTMLoader loader(dir.string());
+    const double peakFt = 3000.0 * 3.28084;
+    const double floorFt = 100.0 * 3.28084;
+
+    EXPECT_NEAR(loader.GetMaxElevation(39.4, -104.8, 39.6, -104.7), peakFt, 1e-6);
+    EXPECT_NEAR(loader.GetMaxElevation(39.1, -104.4, 39.3, -104.1), floorFt, 1e-6);
+    EXPECT_NEAR(loader.GetMaxElevationInRadius(39.5, -104.6, 10.0), peakFt, 1e-6);
+    EXPECT_NEAR(loader.GetMinimumSafeAltitude(39.2, -104.2, 5.0, 1000.0), floorFt + 1000.0, 1e-6);
+
+    EXPECT_NEAR(loader.GetMaxElevationAlongPath(39.5, -104.95, 39.5, -104.05, 2.0), peakFt, 1e-6);
+    EXPECT_NEAR(loader.GetMaxElevationAlongPath(39.2, -104.95, 39.2, -104.05, 2.0), floorFt, 1e-6);
+
+    std::filesystem::remove_all(dir);
+}
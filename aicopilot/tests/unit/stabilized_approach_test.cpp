@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "../../include/stabilized_approach.h"
+#include "../../include/geodesy.hpp"
+#include <cmath>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr double THRESHOLD_ELEVATION = 400.0;
+constexpr double TARGET_SPEED = 75.0;
+constexpr double TARGET_DESCENT_RATE = -500.0;
+
+Position threshold() {
+    Position pos{};
+    pos.latitude = 47.0;
+    pos.longitude = -122.0;
+    pos.altitude = THRESHOLD_ELEVATION;
+    pos.heading = 360.0;
+    return pos;
+}
+
+// On the 3 degree path `distance` nm south of the threshold, configured and on speed
+AircraftState onApproach(double distance) {
+    double height = distance * std::tan(3.0 * Geodesy::DEG_TO_RAD) * 6076.0;
+    AircraftState state{};
+    state.position = threshold();
+    state.position.latitude -= distance / (Geodesy::DEG_TO_RAD * Geodesy::EARTH_RADIUS_NM);
+    state.position.altitude = THRESHOLD_ELEVATION + height;
+    state.heading = 360.0;
+    state.indicatedAirspeed = TARGET_SPEED;
+    state.verticalSpeed = TARGET_DESCENT_RATE;
+    state.gearDown = true;
+    state.flapsPosition = 100;
+    return state;
+}
+
+ApproachSample sampleWith(ApproachParameter parameter, double value) {
+    ApproachSample sample{};
+    sample[parameter] = value;
+    return sample;
+}
+
+} // namespace
+
+// Test: Aircraft types resolve to rows of the threshold table
+TEST(StabilizedApproachTest, ThresholdsPerCategory) {
+    StabilizedApproachSystem system;
+    system.initialize("Cessna 172");
+    EXPECT_DOUBLE_EQ(system.getThresholds().limits[PARAM_ALTITUDE_DEVIATION], 50.0);
+
+    system.initialize("Boeing 737-800");
+    EXPECT_DOUBLE_EQ(system.getThresholds().minStabilizationAltitude, 1000.0);
+    EXPECT_DOUBLE_EQ(system.getThresholds().limits[PARAM_SPEED_DEVIATION], 15.0);
+
+    system.initialize("Bell 407 helicopter");
+    EXPECT_DOUBLE_EQ(system.getThresholds().limits[PARAM_GLIDESLOPE_DEVIATION], 0.5);
+}
+
+// Test: Bins keep the extremes of every sample inside them
+TEST(StabilizedApproachTest, HistoryBinsKeepExtremes) {
+    ApproachHistory history;
+    ApproachSample limits{};
+    limits.fill(1.0);
+
+    history.record(0.0, sampleWith(PARAM_SPEED_DEVIATION, 0.5));
+    history.record(0.1, sampleWith(PARAM_SPEED_DEVIATION, -2.0));
+    history.record(0.2, sampleWith(PARAM_SPEED_DEVIATION, 0.0));
+    EXPECT_EQ(history.size(), 1u);
+    EXPECT_FALSE(history.withinFor(limits, 0.25) & (1u << PARAM_SPEED_DEVIATION));
+    EXPECT_TRUE(history.withinFor(limits, 0.25) & (1u << PARAM_ALTITUDE_DEVIATION));
+
+    // A window longer than the history never counts as stable
+    EXPECT_EQ(history.withinFor(limits, 1.0), 0u);
+}
+
+// Test: A gap in the samples fills the skipped bins, and the ring wraps
+TEST(StabilizedApproachTest, HistoryFillsGapsAndWraps) {
+    ApproachHistory history;
+    history.record(0.0, sampleWith(PARAM_VERTICAL_SPEED, -1500.0));
+    history.record(1.0, sampleWith(PARAM_VERTICAL_SPEED, -1500.0));
+    EXPECT_EQ(history.size(), 5u);
+    EXPECT_TRUE(history.belowFor(PARAM_VERTICAL_SPEED, -1000.0, 1.0));
+
+    for (int i = 0; i < 200; ++i) {
+        history.record(1.0 + i * 0.1, sampleWith(PARAM_VERTICAL_SPEED, i < 150 ? -1500.0 : -700.0));
+    }
+    EXPECT_EQ(history.size(), ApproachHistory::BIN_COUNT);
+    EXPECT_FALSE(history.belowFor(PARAM_VERTICAL_SPEED, -1000.0, 1.0));
+    EXPECT_TRUE(history.aboveFor(PARAM_VERTICAL_SPEED, -1000.0, 4.0));
+    EXPECT_FALSE(history.aboveFor(PARAM_VERTICAL_SPEED, -1000.0, 6.0));
+}
+
+// Test: Stable-for checks need every criterion met over the whole duration
+TEST(StabilizedApproachTest, StableForDuration) {
+    StabilizedApproachSystem system;
+    system.initialize("Cessna 172");
+    AircraftState state = onApproach(2.0);
+    system.startApproachMonitoring(state.position.altitude, TARGET_SPEED, TARGET_DESCENT_RATE);
+
+    double time = 0.0;
+    for (int i = 0; i < 90; ++i, time += 1.0 / 30.0) {
+        StabilizationCriteria criteria = system.updateApproachStatus(state, threshold(), THRESHOLD_ELEVATION, time);
+        EXPECT_TRUE(criteria.fullyStabilized);
+        EXPECT_TRUE(system.isFullyStabilized(criteria));
+    }
+    EXPECT_TRUE(system.isStableFor(2.5));
+    EXPECT_FALSE(system.isStableFor(5.0));
+
+    system.reset();
+    EXPECT_FALSE(system.isStableFor(0.25));
+}
+
+// Test: A short speed excursion breaks the stable window without tripping a go-around
+TEST(StabilizedApproachTest, GoAroundNeedsPersistence) {
+    StabilizedApproachSystem system;
+    system.initialize("Cessna 172");
+    AircraftState state = onApproach(1.0);
+    system.startApproachMonitoring(state.position.altitude, TARGET_SPEED, TARGET_DESCENT_RATE);
+
+    double time = 0.0;
+    for (int i = 0; i < 90; ++i, time += 1.0 / 30.0) {
+        system.updateApproachStatus(state, threshold(), THRESHOLD_ELEVATION, time);
+    }
+    EXPECT_TRUE(system.isStableFor(2.5));
+
+    AircraftState gust = state;
+    gust.indicatedAirspeed = TARGET_SPEED + 25.0;
+    system.updateApproachStatus(gust, threshold(), THRESHOLD_ELEVATION, time);
+    EXPECT_FALSE(system.isStableFor(1.0));
+    EXPECT_FALSE(system.stableCriteriaFor(1.0) & (1u << PARAM_SPEED_DEVIATION));
+    EXPECT_TRUE(system.stableCriteriaFor(1.0) & (1u << PARAM_GLIDESLOPE_DEVIATION));
+    EXPECT_FALSE(system.shouldExecuteGoAround(system.evaluateGoAroundTriggers(gust, THRESHOLD_ELEVATION)));
+
+    // Sustained for over a second it does
+    for (int i = 0; i < 40; ++i) {
+        time += 1.0 / 30.0;
+        system.updateApproachStatus(gust, threshold(), THRESHOLD_ELEVATION, time);
+    }
+    auto triggers = system.evaluateGoAroundTriggers(gust, THRESHOLD_ELEVATION);
+    EXPECT_TRUE(system.shouldExecuteGoAround(triggers));
+    EXPECT_EQ(system.getGoAroundReason(triggers), "Too fast on approach");
+}
+
+// Test: Without a history the triggers act on the current sample
+TEST(StabilizedApproachTest, GoAroundWithoutHistory) {
+    StabilizedApproachSystem system;
+    system.initialize("Cessna 172");
+    system.startApproachMonitoring(1000.0, TARGET_SPEED, TARGET_DESCENT_RATE);
+
+    AircraftState state = onApproach(1.0);
+    state.verticalSpeed = -1500.0;
+    auto triggers = system.evaluateGoAroundTriggers(state, THRESHOLD_ELEVATION);
+    EXPECT_TRUE(system.shouldExecuteGoAround(triggers));
+    EXPECT_EQ(system.getGoAroundReason(triggers), "Descent rate excessive");
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "../../include/state_snapshot.hpp"
+#include "../../include/aicopilot_types.h"
+#include <atomic>
+#include <thread>
+
+using namespace AICopilot;
+
+// Test: Default snapshot is zero-initialized
+TEST(StateSnapshotTest, DefaultIsZero) {
+    StateSnapshot<AircraftState> snapshot;
+    AircraftState state = snapshot.load();
+    EXPECT_EQ(state.position.latitude, 0.0);
+    EXPECT_EQ(state.indicatedAirspeed, 0.0);
+    EXPECT_FALSE(state.onGround);
+    EXPECT_EQ(snapshot.version(), 0u);
+}
+
+// Test: Stored value round-trips and bumps version
+TEST(StateSnapshotTest, StoreAndLoad) {
+    StateSnapshot<AircraftState> snapshot;
+    AircraftState state{};
+    state.position.latitude = 47.45;
+    state.position.longitude = -122.31;
+    state.indicatedAirspeed = 142.0;
+    state.gearDown = true;
+    state.flapsPosition = 15;
+
+    snapshot.store(state);
+
+    AircraftState loaded = snapshot.load();
+    EXPECT_DOUBLE_EQ(loaded.position.latitude, 47.45);
+    EXPECT_DOUBLE_EQ(loaded.position.longitude, -122.31);
+    EXPECT_DOUBLE_EQ(loaded.indicatedAirspeed, 142.0);
+    EXPECT_TRUE(loaded.gearDown);
+    EXPECT_EQ(loaded.flapsPosition, 15);
+    EXPECT_EQ(snapshot.version(), 1u);
+}
+
+// Test: Concurrent reader never observes a torn write
+TEST(StateSnapshotTest, NoTornReadsUnderContention) {
+    StateSnapshot<AircraftState> snapshot;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&]() {
+        for (int i = 1; i <= 20000; ++i) {
+            AircraftState state{};
+            state.position.latitude = i;
+            state.position.longitude = i;
+            state.indicatedAirspeed = i;
+            state.generatorLoad = i;
+            snapshot.store(state);
+        }
+        done = true;
+    });
+
+    bool consistent = true;
+    while (!done) {
+        AircraftState state = snapshot.load();
+        if (state.position.latitude != state.position.longitude ||
+            state.position.latitude != state.indicatedAirspeed ||
+            state.position.latitude != state.generatorLoad) {
+            consistent = false;
+        }
+    }
+    writer.join();
+
+    EXPECT_TRUE(consistent);
+    EXPECT_DOUBLE_EQ(snapshot.load().indicatedAirspeed, 20000.0);
+}
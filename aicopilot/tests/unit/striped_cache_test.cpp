@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "../../include/striped_cache.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+// Test: Lookups hit after insert and the counters track them
+TEST(StripedCacheTest, HitsAndMisses) {
+    StripedCache<double> cache(64);
+    double value = 0.0;
+    EXPECT_FALSE(cache.find(42, value));
+    cache.insert(42, 1234.5);
+    ASSERT_TRUE(cache.find(42, value));
+    EXPECT_DOUBLE_EQ(value, 1234.5);
+
+    cache.insert(42, 99.0);  // overwrite in place
+    ASSERT_TRUE(cache.find(42, value));
+    EXPECT_DOUBLE_EQ(value, 99.0);
+
+    StripedCacheStats stats = cache.getStats();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.entries, 1u);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_FALSE(cache.find(42, value));
+    cache.resetStats();
+    EXPECT_EQ(cache.getStats().misses, 0u);
+}
+
+// Test: CLOCK gives recently used entries a second chance over untouched ones
+TEST(StripedCacheTest, ClockKeepsReferencedEntries) {
+    StripedCache<int> cache(4, 1);
+    for (uint64_t key = 0; key < 4; ++key) cache.insert(key, static_cast<int>(key));
+
+    int value = 0;
+    ASSERT_TRUE(cache.find(0, value));
+    ASSERT_TRUE(cache.find(2, value));
+
+    cache.insert(10, 10);  // evicts 1, the first unreferenced slot after the hand
+    cache.insert(11, 11);  // evicts 3
+    EXPECT_TRUE(cache.find(0, value));
+    EXPECT_TRUE(cache.find(2, value));
+    EXPECT_FALSE(cache.find(1, value));
+    EXPECT_FALSE(cache.find(3, value));
+    EXPECT_EQ(cache.size(), 4u);
+    EXPECT_EQ(cache.getStats().evictions, 2u);
+}
+
+// Test: Entry count never exceeds the per-stripe slot arrays
+TEST(StripedCacheTest, StaysWithinCapacity) {
+    StripedCache<double> cache(100, 8);
+    for (uint64_t key = 0; key < 10000; ++key) cache.insert(key * 7919, 1.0);
+    EXPECT_LE(cache.size(), 8u * ((100 + 7) / 8));
+    EXPECT_GT(cache.getStats().evictions, 0u);
+
+    StripedCache<double> none(0);
+    none.insert(1, 1.0);
+    double value;
+    EXPECT_FALSE(none.find(1, value));
+}
+
+// Test: Concurrent readers and writers see consistent values and counts
+TEST(StripedCacheTest, ConcurrentAccess) {
+    StripedCache<uint64_t> cache(512);
+    std::atomic<uint64_t> lookups{0};
+    std::atomic<bool> wrong{false};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (uint64_t i = 0; i < 20000; ++i) {
+                uint64_t key = (i * 31 + t) % 2048;
+                uint64_t value = 0;
+                if (cache.find(key, value)) {
+                    if (value != key * 3) wrong = true;
+                } else {
+                    cache.insert(key, key * 3);
+                }
+                lookups++;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_FALSE(wrong);
+    StripedCacheStats stats = cache.getStats();
+    EXPECT_EQ(stats.hits + stats.misses, lookups.load());
+}
+
+// Test: Waits for a held stripe are counted, and an uncontended cache counts none
+TEST(StripedCacheTest, CountsContention) {
+    StripedCache<uint64_t> quiet(64);
+    uint64_t value = 0;
+    for (uint64_t key = 0; key < 100; ++key) {
+        if (!quiet.find(key, value)) quiet.insert(key, key);
+    }
+    EXPECT_EQ(quiet.getStats().contentions, 0u);
+
+    // One stripe and only writers, so the threads must queue on its lock
+    StripedCache<uint64_t> busy(64, 1);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&busy, t] {
+            for (uint64_t i = 0; i < 20000; ++i) busy.insert((i + t) % 64, i);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    EXPECT_LE(busy.getStats().contentions, 80000u);
+
+    busy.resetStats();
+    EXPECT_EQ(busy.getStats().contentions, 0u);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "../../include/subsystem_initializer.hpp"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace AICopilot;
+using namespace std::chrono_literals;
+
+namespace {
+
+const SubsystemInitStats* findStep(const std::vector<SubsystemInitStats>& stats, const std::string& name) {
+    for (const auto& step : stats) {
+        if (step.name == name) return &step;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+// Test: Independent steps run side by side, dependents after their dependencies
+TEST(SubsystemInitializerTest, RunsIndependentStepsInParallel) {
+    auto executor = std::make_shared<IoExecutor>(4);
+    SubsystemInitializer init(executor);
+    std::atomic<bool> navdataDone{false};
+    std::atomic<bool> orderedOk{false};
+    ASSERT_TRUE(init.add("navdata", {}, true, [&] { std::this_thread::sleep_for(100ms); navdataDone = true; return true; }));
+    ASSERT_TRUE(init.add("weather", {}, true, [] { std::this_thread::sleep_for(100ms); return true; }));
+    ASSERT_TRUE(init.add("airports", {"navdata"}, true, [&] { orderedOk = navdataDone.load(); return true; }));
+
+    auto start = std::chrono::steady_clock::now();
+    init.start();
+    EXPECT_TRUE(init.waitReady());
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_TRUE(orderedOk);
+    EXPECT_LT(elapsed, 190ms);   // serial would take 200 ms
+    EXPECT_GT(init.getTimeToReadyMs(), 90.0);
+
+    auto stats = init.getStats();
+    ASSERT_EQ(stats.size(), 3u);
+    for (const auto& step : stats) {
+        EXPECT_EQ(step.state, SubsystemInitState::SUCCEEDED);
+    }
+    EXPECT_GT(findStep(stats, "navdata")->durationMs, 90.0);
+    EXPECT_GE(findStep(stats, "airports")->startMs, findStep(stats, "navdata")->durationMs);
+}
+
+// Test: Ready does not wait for non-critical steps
+TEST(SubsystemInitializerTest, ReadyBeforeNonCriticalSteps) {
+    auto executor = std::make_shared<IoExecutor>(2);
+    SubsystemInitializer init(executor);
+    std::atomic<bool> release{false};
+    init.add("weather", {}, true, [] { return true; });
+    init.add("ml-model", {"weather"}, false, [&] {
+        while (!release) std::this_thread::sleep_for(1ms);
+        return true;
+    });
+
+    init.start();
+    EXPECT_TRUE(init.waitReady());
+    EXPECT_TRUE(init.isReady());
+    EXPECT_NE(findStep(init.getStats(), "ml-model")->state, SubsystemInitState::SUCCEEDED);
+
+    release = true;
+    init.waitAll();
+    EXPECT_EQ(findStep(init.getStats(), "ml-model")->state, SubsystemInitState::SUCCEEDED);
+}
+
+// Test: A failed step skips its dependents and fails readiness if critical
+TEST(SubsystemInitializerTest, FailureSkipsDependents) {
+    SubsystemInitializer init(std::make_shared<IoExecutor>(2));
+    std::atomic<int> runs{0};
+    init.add("navdata", {}, true, []() -> bool { throw std::runtime_error("no database"); });
+    init.add("airports", {"navdata"}, true, [&] { runs++; return true; });
+    init.add("taxi-graph", {"airports"}, false, [&] { runs++; return true; });
+    init.add("weather", {}, true, [&] { runs++; return true; });
+
+    init.start();
+    EXPECT_FALSE(init.waitReady());
+    init.waitAll();
+    auto stats = init.getStats();
+    EXPECT_EQ(findStep(stats, "navdata")->state, SubsystemInitState::FAILED);
+    EXPECT_EQ(findStep(stats, "airports")->state, SubsystemInitState::SKIPPED);
+    EXPECT_EQ(findStep(stats, "taxi-graph")->state, SubsystemInitState::SKIPPED);
+    EXPECT_EQ(findStep(stats, "weather")->state, SubsystemInitState::SUCCEEDED);
+    EXPECT_EQ(runs, 1);
+}
+
+// Test: Dependencies must already exist, names are unique, and the graph closes on start
+TEST(SubsystemInitializerTest, RejectsBadGraphs) {
+    SubsystemInitializer init(std::make_shared<IoExecutor>(1));
+    EXPECT_FALSE(init.add("airports", {"navdata"}, true, [] { return true; }));
+    EXPECT_TRUE(init.add("navdata", {}, true, [] { return true; }));
+    EXPECT_FALSE(init.add("navdata", {}, false, [] { return true; }));
+    init.start();
+    EXPECT_FALSE(init.add("late", {}, false, [] { return true; }));
+    EXPECT_TRUE(init.waitReady());
+}
+
+// Test: An empty graph is ready as soon as it starts
+TEST(SubsystemInitializerTest, EmptyGraphIsReady) {
+    SubsystemInitializer init(std::make_shared<IoExecutor>(1));
+    EXPECT_FALSE(init.isReady());
+    init.start();
+    EXPECT_TRUE(init.waitReady());
+    EXPECT_DOUBLE_EQ(init.getTimeToReadyMs(), 0.0);
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "../../include/symbol_table.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace AICopilot;
+
+// Test: Interning hands out dense IDs and round-trips names
+TEST(SymbolTableTest, InternAndLookup) {
+    SymbolTable table;
+    SymbolId jfk = table.intern("KJFK");
+    SymbolId v1 = table.intern("V1");
+    EXPECT_EQ(jfk, 0u);
+    EXPECT_EQ(v1, 1u);
+    EXPECT_EQ(table.intern(std::string("KJFK")), jfk);
+    EXPECT_EQ(table.size(), 2u);
+
+    EXPECT_EQ(table.find("V1"), v1);
+    EXPECT_EQ(table.find("BOUND"), INVALID_SYMBOL);
+    EXPECT_EQ(table.size(), 2u);  // find never adds
+
+    EXPECT_EQ(table.name(jfk), "KJFK");
+    EXPECT_EQ(table.name(INVALID_SYMBOL), "");
+    EXPECT_EQ(table.name(42), "");
+}
+
+// Test: Names stay valid as the table grows
+TEST(SymbolTableTest, NamesAreStable) {
+    SymbolTable table;
+    const std::string& first = table.name(table.intern("FIX0"));
+    for (int i = 1; i < 10000; ++i) table.intern("FIX" + std::to_string(i));
+    EXPECT_EQ(first, "FIX0");
+    EXPECT_EQ(table.find("FIX9999"), 9999u);
+}
+
+// Test: Concurrent interning of the same names agrees on one ID per name
+TEST(SymbolTableTest, ConcurrentIntern) {
+    SymbolTable table;
+    std::vector<std::vector<SymbolId>> ids(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 2000; ++i) ids[t].push_back(table.intern("WP" + std::to_string(i)));
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(table.size(), 2000u);
+    for (int t = 1; t < 4; ++t) EXPECT_EQ(ids[t], ids[0]);
+    for (int i = 0; i < 2000; ++i) EXPECT_EQ(table.name(ids[0][i]), "WP" + std::to_string(i));
+}
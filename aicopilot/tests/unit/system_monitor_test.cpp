@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "../../include/system_monitor.hpp"
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+using namespace AICopilot;
+
+// Test: Utilization reports the process's own memory and threads
+TEST(SystemMonitorResourceTest, SamplesProcessResources) {
+    SystemMonitor monitor;
+    monitor.initialize();
+
+    std::vector<char> ballast(32 * 1024 * 1024, 1);   // touched, so resident
+    volatile char sink = 0;
+    for (size_t i = 0; i < ballast.size(); i += 4096) sink = sink + ballast[i];
+    monitor.refreshResourceSample();
+
+    auto util = monitor.getResourceUtilization();
+    EXPECT_GE(util.residentBytes, ballast.size());
+    EXPECT_GT(util.physicalMemoryBytes, util.residentBytes);
+    EXPECT_GT(util.memoryPercentage, 0.0);
+    EXPECT_LE(util.memoryPercentage, 100.0);
+    EXPECT_GE(util.threadCount, 2u);   // this thread plus the sampler
+    EXPECT_GE(util.cpuPercentage, 0.0);
+    EXPECT_LE(util.cpuPercentage, 100.0);
+    EXPECT_GE(util.diskIOPercentage, 0.0);
+    EXPECT_LE(util.diskIOPercentage, 100.0);
+    monitor.shutdown();
+}
+
+// Test: Registered byte counts drive the breakdown and component memory
+TEST(SystemMonitorResourceTest, MemorySourcesFeedBreakdown) {
+    SystemMonitor monitor;
+    std::atomic<uint64_t> tileBytes{4096};
+    monitor.registerMemorySource(SystemComponent::TERRAIN_AWARENESS, SystemMonitor::MemoryCategory::CACHE,
+                                 [&tileBytes] { return tileBytes.load(); });
+    monitor.registerMemorySource(SystemComponent::TERRAIN_AWARENESS, SystemMonitor::MemoryCategory::BUFFER,
+                                 [] { return uint64_t(1000); });
+    monitor.registerMemorySource(SystemComponent::WEATHER_SYSTEM, SystemMonitor::MemoryCategory::QUERY,
+                                 [] { return uint64_t(250); });
+
+    auto breakdown = monitor.getMemoryBreakdown();
+    EXPECT_EQ(breakdown.cacheMemory, 4096u);
+    EXPECT_EQ(breakdown.bufferMemory, 1000u);
+    EXPECT_EQ(breakdown.queryMemory, 250u);
+    EXPECT_GT(breakdown.overhead, 0u);
+    EXPECT_GT(breakdown.systemMemory, 0u);
+    EXPECT_EQ(monitor.getComponentHealth(SystemComponent::TERRAIN_AWARENESS).memoryUsage, 5096u);
+
+    // Sourced components ignore reported memory; others keep it
+    ComponentHealth reported = monitor.getComponentHealth(SystemComponent::TERRAIN_AWARENESS);
+    reported.memoryUsage = 1;
+    monitor.updateComponentHealth(reported);
+    ComponentHealth nav = monitor.getComponentHealth(SystemComponent::NAVIGATION);
+    nav.memoryUsage = 777;
+    monitor.updateComponentHealth(nav);
+    tileBytes = 8192;
+    monitor.refreshResourceSample();
+    EXPECT_EQ(monitor.getComponentHealth(SystemComponent::TERRAIN_AWARENESS).memoryUsage, 9192u);
+    EXPECT_EQ(monitor.getComponentHealth(SystemComponent::NAVIGATION).memoryUsage, 777u);
+    EXPECT_EQ(monitor.getMemoryBreakdown().cacheMemory, 8192u);
+}
+
+// Test: A flat resident set predicts no exhaustion
+TEST(SystemMonitorResourceTest, StableMemoryHasNoExhaustion) {
+    SystemMonitor monitor;
+    for (int i = 0; i < 5; ++i) monitor.refreshResourceSample();
+    auto prediction = monitor.predictResourceExhaustion();
+    EXPECT_FALSE(prediction.memoryExhaustionRisk);
+    EXPECT_TRUE(std::isnan(prediction.minutesUntilExhaustion));
+}
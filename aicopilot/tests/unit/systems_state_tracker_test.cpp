@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "../../include/aircraft_systems.h"
+
+using namespace AICopilot;
+
+namespace {
+
+AircraftState cruiseState() {
+    AircraftState state{};
+    state.position = {40.0, -74.0, 5000.0, 90.0};
+    state.indicatedAirspeed = 110.0;
+    state.fuelQuantity = 40.0;
+    state.engineRPM = 2400.0;
+    state.masterBattery = true;
+    state.masterAlternator = true;
+    state.batteryVoltage = 24.8;
+    state.generatorVoltage = 28.0;
+    state.batteryLoad = 20.0;
+    state.generatorLoad = 25.0;
+    return state;
+}
+
+} // namespace
+
+// Test: The first snapshot reports every system, an identical one none
+TEST(SystemsStateTrackerTest, FirstUpdateReportsAll) {
+    SystemsStateTracker tracker;
+    AircraftState state = cruiseState();
+    EXPECT_EQ(tracker.update(state), SYSTEMS_ALL);
+    EXPECT_EQ(tracker.update(state), SYSTEMS_NONE);
+
+    // Flight-path fields belong to no system
+    state.position.altitude += 500.0;
+    state.indicatedAirspeed += 10.0;
+    EXPECT_EQ(tracker.update(state), SYSTEMS_NONE);
+
+    tracker.reset();
+    EXPECT_EQ(tracker.update(state), SYSTEMS_ALL);
+}
+
+// Test: Changes inside the deadband are ignored until they add up
+TEST(SystemsStateTrackerTest, DeadbandAccumulatesDrift) {
+    SystemsStateTracker tracker;
+    AircraftState state = cruiseState();
+    tracker.update(state);
+
+    state.fuelQuantity -= 0.04;
+    EXPECT_EQ(tracker.update(state), SYSTEMS_NONE);
+    state.fuelQuantity -= 0.04;
+    EXPECT_EQ(tracker.update(state), SYSTEMS_NONE);
+    state.fuelQuantity -= 0.04;
+    EXPECT_EQ(tracker.update(state), SYSTEMS_FUEL);
+    EXPECT_DOUBLE_EQ(tracker.getReportedState().fuelQuantity, state.fuelQuantity);
+
+    // The reference moved, so the next small step is quiet again
+    state.fuelQuantity -= 0.04;
+    EXPECT_EQ(tracker.update(state), SYSTEMS_NONE);
+}
+
+// Test: Each input maps onto the systems that check it
+TEST(SystemsStateTrackerTest, FieldsMapToSystems) {
+    SystemsStateTracker tracker;
+    AircraftState state = cruiseState();
+    tracker.update(state);
+
+    state.engineRPM = 0.0;
+    EXPECT_EQ(tracker.update(state), SYSTEMS_ENGINE | SYSTEMS_ELECTRICAL);
+
+    state.batteryVoltage = 21.0;
+    EXPECT_EQ(tracker.update(state), SYSTEMS_ELECTRICAL);
+
+    state.masterAlternator = false;
+    state.gearDown = true;
+    EXPECT_EQ(tracker.update(state), SYSTEMS_ELECTRICAL | SYSTEMS_CONFIGURATION);
+
+    state.onGround = true;
+    EXPECT_EQ(tracker.update(state), SYSTEMS_ENGINE | SYSTEMS_ELECTRICAL);
+
+    state.flapsPosition = 30;
+    state.parkingBrakeSet = true;
+    EXPECT_EQ(tracker.update(state), SYSTEMS_CONFIGURATION);
+}
+
+// Test: Custom deadbands widen what counts as unchanged
+TEST(SystemsStateTrackerTest, CustomDeadbands) {
+    SystemsDeadbands deadbands;
+    deadbands.engineRPM = 100.0;
+    SystemsStateTracker tracker(deadbands);
+    AircraftState state = cruiseState();
+    tracker.update(state);
+
+    state.engineRPM += 50.0;
+    EXPECT_EQ(tracker.update(state), SYSTEMS_NONE);
+    state.engineRPM += 50.0;
+    EXPECT_EQ(tracker.update(state), SYSTEMS_ENGINE | SYSTEMS_ELECTRICAL);
+}
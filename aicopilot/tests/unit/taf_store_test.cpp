@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "../../include/taf_store.hpp"
+#include "../../include/dynamic_flight_planning.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr time_t NOW = 1736703000;          // 2025-01-12 17:30Z
+constexpr time_t JAN12 = 1736640000;        // 2025-01-12 00:00Z
+constexpr time_t HOUR = 3600;
+
+const char* const KJFK_TAF =
+    "TAF KJFK 121720Z 1218/1324 08012KT P6SM BKN015 "
+    "TEMPO 1220/1224 3SM -RA BKN008 "
+    "FM130200 09015G25KT 3SM -RA OVC008 "
+    "BECMG 1310/1312 27010KT P6SM NSW SCT030 "
+    "PROB30 1316/1320 1/2SM TSRA BKN004CB";
+
+Waypoint makeFix(const std::string& id, double lat, double lon) {
+    Waypoint fix;
+    fix.id = id;
+    fix.position.latitude = lat;
+    fix.position.longitude = lon;
+    return fix;
+}
+
+} // namespace
+
+// Test: Change groups become periods with the prevailing and worst conditions of each
+TEST(TAFStoreTest, DecodesEffectivePeriods) {
+    StationKey station = INVALID_STATION;
+    TAFForecast taf;
+    ASSERT_TRUE(TAFStore::decode(KJFK_TAF, station, taf, NOW));
+    EXPECT_EQ(station, packStationId("KJFK"));
+    EXPECT_EQ(taf.issuedAt, JAN12 + 17 * HOUR + 20 * 60);
+    EXPECT_EQ(taf.validFrom, JAN12 + 18 * HOUR);
+    EXPECT_EQ(taf.validTo, JAN12 + 48 * HOUR);
+    ASSERT_EQ(taf.periods.size(), 8u);
+    for (size_t i = 1; i < taf.periods.size(); ++i) EXPECT_EQ(taf.periods[i].from, taf.periods[i - 1].to);
+
+    // Base forecast
+    const TAFPeriod* p = taf.at(JAN12 + 19 * HOUR);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(p->prevailing.category, FlightCategory::MVFR);
+    EXPECT_EQ(p->worst, p->prevailing);
+    EXPECT_EQ(p->changes, 0);
+
+    // TEMPO lowers only the worst case
+    p = taf.at(JAN12 + 21 * HOUR);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(p->prevailing.category, FlightCategory::MVFR);
+    EXPECT_EQ(p->worst.category, FlightCategory::IFR);
+    EXPECT_TRUE(p->worst.has(StationFlags::PRECIPITATION));
+    EXPECT_EQ(p->changes, TAFChange::TEMPORARY);
+
+    // FM replaces the prevailing conditions
+    p = taf.at(JAN12 + 27 * HOUR);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(p->prevailing.category, FlightCategory::IFR);
+    EXPECT_EQ(p->prevailing.windKnots, 15);
+    EXPECT_EQ(p->prevailing.gustKnots, 25);
+
+    // During BECMG the worst is either side; after it the stated elements change
+    p = taf.at(JAN12 + 35 * HOUR);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(p->changes, TAFChange::BECOMING);
+    EXPECT_EQ(p->prevailing.category, FlightCategory::IFR);
+    p = taf.at(JAN12 + 37 * HOUR);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(p->prevailing.category, FlightCategory::VFR);
+    EXPECT_EQ(p->prevailing.windKnots, 10);
+    EXPECT_FALSE(p->prevailing.has(StationFlags::PRECIPITATION));
+
+    // PROB30 thunderstorms
+    p = taf.at(JAN12 + 41 * HOUR);
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(p->prevailing.category, FlightCategory::VFR);
+    EXPECT_EQ(p->worst.category, FlightCategory::LIFR);
+    EXPECT_TRUE(p->worst.has(StationFlags::THUNDERSTORM));
+    EXPECT_FALSE(p->worst.has(StationFlags::LANDING_OK));
+    EXPECT_EQ(p->changes, TAFChange::PROBABLE);
+    EXPECT_EQ(p->probability, 30);
+
+    EXPECT_EQ(taf.at(taf.validFrom - 1), nullptr);
+    EXPECT_EQ(taf.at(taf.validTo), nullptr);
+
+    // Day-of-month times roll into the next month
+    ASSERT_TRUE(TAFStore::decode("TAF AMD EGLL 010500Z 0106/0212 24015KT 9999 SCT025", station, taf,
+                                 1738364400));     // 2025-01-31 23:00Z
+    EXPECT_EQ(taf.validFrom, 1738364400 + 7 * HOUR);
+    EXPECT_EQ(taf.periods.size(), 1u);
+
+    EXPECT_FALSE(TAFStore::decode("TAF KJFK 121720Z NIL", station, taf, NOW));
+    EXPECT_FALSE(TAFStore::decode("TAF KJFK 121720Z 1218/1324 08012KT TEMPO", station, taf, NOW));
+}
+
+// Test: Queries pick the covering period; newer TAFs replace older ones and expire with their validity
+TEST(TAFStoreTest, StoreQueries) {
+    TAFStore store;
+    ASSERT_TRUE(store.update(KJFK_TAF, NOW));
+    EXPECT_FALSE(store.update("TAF KJFK 121120Z 1212/1318 08012KT P6SM SKC", NOW));   // Issued earlier
+    EXPECT_FALSE(store.update("TAF KBOS 101120Z 1012/1118 08012KT P6SM SKC", NOW));   // Already over
+    ASSERT_TRUE(store.update("TAF KBOS 121730Z 1218/1318 30008KT P6SM FEW050", NOW));
+    EXPECT_EQ(store.size(), 2u);
+
+    TAFPeriod period;
+    ASSERT_TRUE(store.forecastAt("KJFK", JAN12 + 21 * HOUR, period));
+    EXPECT_EQ(period.worst.category, FlightCategory::IFR);
+    EXPECT_FALSE(store.forecastAt("KLAX", JAN12 + 21 * HOUR, period));
+
+    std::vector<TAFStore::Query> queries = {{packStationId("KJFK"), JAN12 + 41 * HOUR},
+                                            {packStationId("KBOS"), JAN12 + 41 * HOUR},
+                                            {packStationId("KBOS"), JAN12 + 43 * HOUR},
+                                            {packStationId("KLAX"), JAN12 + 20 * HOUR}};
+    std::vector<TAFPeriod> periods;
+    EXPECT_EQ(store.forecastsAt(queries, periods), 2u);
+    ASSERT_EQ(periods.size(), 4u);
+    EXPECT_TRUE(periods[0].worst.has(StationFlags::THUNDERSTORM));
+    EXPECT_EQ(periods[1].worst.category, FlightCategory::VFR);
+    EXPECT_FALSE(periods[2].valid());
+    EXPECT_FALSE(periods[3].valid());
+
+    // Worst over an ETA window spans every period it touches
+    StationSummary worst;
+    ASSERT_TRUE(store.worstBetween(packStationId("KJFK"), JAN12 + 19 * HOUR, JAN12 + 27 * HOUR, worst));
+    EXPECT_EQ(worst.category, FlightCategory::IFR);
+    EXPECT_EQ(worst.gustKnots, 25);
+    EXPECT_FALSE(store.worstBetween(packStationId("KJFK"), JAN12, JAN12 + HOUR, worst));
+
+    EXPECT_EQ(store.purgeExpired(JAN12 + 42 * HOUR), 1u);
+    EXPECT_FALSE(store.forecastAt("KBOS", JAN12 + 41 * HOUR, period));
+    EXPECT_TRUE(store.erase("KJFK"));
+    EXPECT_EQ(store.size(), 0u);
+}
+
+// Test: A weather divert skips alternates forecast below landing minimums at their ETA
+TEST(TAFStoreTest, AlternateSelectionUsesForecastAtEta) {
+    PerformanceProfile profile{};
+    profile.cruiseSpeed = 120.0;
+    profile.maxSpeed = 140.0;
+    profile.serviceCeiling = 15000.0;
+    profile.fuelFlow = 10.0;
+    profile.climbRate = 700.0;
+    DynamicFlightPlanning planning;
+    ASSERT_TRUE(planning.initialize(profile));
+
+    // KAAA has no TAF; KBBB, nearer, is fogged in for the first two hours
+    auto forecasts = std::make_shared<TAFStore>();
+    ASSERT_TRUE(forecasts->update("TAF KBBB 121720Z 1218/1318 00000KT P6SM SKC TEMPO 1218/1220 1/4SM FG VV001", NOW));
+    ASSERT_TRUE(forecasts->update("TAF KCCC 121720Z 1218/1318 27010KT P6SM FEW040", NOW));
+    std::vector<Waypoint> alternates = {makeFix("KAAA", 45.5, -122.0), makeFix("KBBB", 45.2, -122.0),
+                                        makeFix("KCCC", 46.0, -122.0)};
+    Position current;
+    current.latitude = 45.0;
+    current.longitude = -122.0;
+    time_t departure = JAN12 + 18 * HOUR;
+
+    EXPECT_EQ(planning.planWeatherDivert(current, alternates[0], alternates, 100.0, {}, departure)
+                  .optimizedWaypoints.back().id, "KBBB");
+    planning.setForecasts(forecasts);
+    EXPECT_EQ(planning.planWeatherDivert(current, alternates[0], alternates, 100.0, {}, departure)
+                  .optimizedWaypoints.back().id, "KCCC");
+    // Once the fog is over KBBB is fine again
+    EXPECT_EQ(planning.planWeatherDivert(current, alternates[0], alternates, 100.0, {}, departure + 2 * HOUR)
+                  .optimizedWaypoints.back().id, "KBBB");
+}
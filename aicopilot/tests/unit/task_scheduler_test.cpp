@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "../../include/task_scheduler.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace AICopilot;
+using namespace std::chrono_literals;
+
+// Test: Each task runs at its own declared rate
+TEST(TaskSchedulerTest, RunsTasksAtDeclaredRates) {
+    TaskScheduler scheduler(0);
+    int fast = 0;
+    int slow = 0;
+    scheduler.addTask("fast", 10.0, [&] { fast++; });
+    scheduler.addTask("slow", 1.0, [&] { slow++; });
+
+    // Tick every 50 ms for two seconds
+    auto start = TaskScheduler::Clock::time_point{} + 1s;
+    for (int i = 0; i < 40; ++i) {
+        scheduler.tick(start + i * 50ms);
+    }
+
+    EXPECT_EQ(fast, 20);
+    EXPECT_EQ(slow, 2);
+    EXPECT_EQ(scheduler.getTotalDeadlineMisses(), 0u);
+}
+
+// Test: On-demand tasks only run after trigger()
+TEST(TaskSchedulerTest, OnDemandTaskRunsWhenTriggered) {
+    TaskScheduler scheduler(0);
+    int runs = 0;
+    auto id = scheduler.addTask("ml", 0.0, [&] { runs++; });
+
+    auto now = TaskScheduler::Clock::time_point{} + 1s;
+    scheduler.tick(now);
+    EXPECT_EQ(runs, 0);
+
+    scheduler.trigger(id);
+    scheduler.tick(now + 10ms);
+    scheduler.tick(now + 20ms);
+    EXPECT_EQ(runs, 1);
+}
+
+// Test: A tick arriving a full period late is counted as a missed deadline
+TEST(TaskSchedulerTest, CountsLateStartsAsDeadlineMisses) {
+    TaskScheduler scheduler(0);
+    int runs = 0;
+    scheduler.addTask("control", 30.0, [&] { runs++; });
+
+    auto now = TaskScheduler::Clock::time_point{} + 1s;
+    scheduler.tick(now);
+    scheduler.tick(now + 200ms);  // several 33 ms slots skipped
+    scheduler.tick(now + 210ms);  // resynced, not yet due again
+
+    EXPECT_EQ(runs, 2);
+    auto stats = scheduler.getStats();
+    ASSERT_EQ(stats.size(), 1u);
+    EXPECT_EQ(stats[0].deadlineMisses, 1u);
+    EXPECT_EQ(stats[0].runCount, 2u);
+}
+
+// Test: A slow worker task does not block the tick and is not queued twice
+TEST(TaskSchedulerTest, SlowWorkerTaskDoesNotStallTick) {
+    TaskScheduler scheduler(1);
+    std::atomic<bool> release{false};
+    std::atomic<int> slowRuns{0};
+    int controlRuns = 0;
+
+    scheduler.addTask("control", 100.0, [&] { controlRuns++; });
+    scheduler.addTask("ollama", 100.0, [&] {
+        while (!release) std::this_thread::sleep_for(1ms);
+        slowRuns++;
+    }, TaskExecution::WORKER);
+
+    auto now = TaskScheduler::Clock::time_point{} + 1s;
+    for (int i = 0; i < 5; ++i) {
+        scheduler.tick(now + i * 10ms);
+    }
+    EXPECT_EQ(controlRuns, 5);
+
+    release = true;
+    scheduler.waitForWorkers();
+    EXPECT_EQ(slowRuns, 1);
+
+    auto stats = scheduler.getStats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[1].execution, TaskExecution::WORKER);
+    EXPECT_GE(stats[1].deadlineMisses, 4u);
+}
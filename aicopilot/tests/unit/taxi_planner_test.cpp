@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "../../include/atc_routing.hpp"
+
+using namespace AICopilot;
+using namespace AICopilot::ATC;
+
+namespace {
+
+constexpr double FEET_PER_DEGREE_LAT = 364000.0;
+
+// Nodes 1-2-3-4 along a line 1000 ft apart, with a siding 5 beside node 2
+// that joins 1 and 3 (the detour is 600 ft longer)
+Airport::TaxiwayNetwork makeLine() {
+    Airport::TaxiwayNetwork network;
+    for (int i = 0; i < 4; ++i) {
+        network.add_node(Airport::TaxiwayNode(i + 1, Airport::LatLonAlt(33.64 + i * 1000.0 / FEET_PER_DEGREE_LAT, -84.43)));
+    }
+    network.add_node(Airport::TaxiwayNode(5, Airport::LatLonAlt(33.64 + 1000.0 / FEET_PER_DEGREE_LAT, -84.4285)));
+    network.add_edge(Airport::TaxiwayEdge(1, 1, 2, 1000.0));
+    network.add_edge(Airport::TaxiwayEdge(2, 2, 3, 1000.0));
+    network.add_edge(Airport::TaxiwayEdge(3, 3, 4, 1000.0));
+    network.add_edge(Airport::TaxiwayEdge(4, 1, 5, 1300.0));
+    network.add_edge(Airport::TaxiwayEdge(5, 5, 3, 1300.0));
+    return network;
+}
+
+std::vector<int> nodes(const CooperativeTaxiPlanner::TaxiPlan& plan) {
+    std::vector<int> out;
+    for (const auto& step : plan.steps) out.push_back(step.node_id);
+    return out;
+}
+
+// Time a plan occupies a node; false if it never visits it
+bool occupies(const CooperativeTaxiPlanner::TaxiPlan& plan, int node, double& from, double& to) {
+    for (const auto& step : plan.steps) {
+        if (step.node_id == node) {
+            from = step.arrival_time_seconds;
+            to = step.departure_time_seconds;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+// Test: A lone aircraft gets the shortest path at its own speed
+TEST(TaxiPlannerTest, PlansSingleAircraft) {
+    Airport::TaxiwayNetwork network = makeLine();
+    CooperativeTaxiPlanner planner;
+    planner.set_taxiway_network(&network);
+
+    auto plan = planner.plan(CooperativeTaxiPlanner::TaxiRequest(7, 1, 4, 100.0, 15.0, 30.0));
+    ASSERT_TRUE(plan.success);
+    EXPECT_EQ(nodes(plan), (std::vector<int>{1, 2, 3, 4}));
+    EXPECT_DOUBLE_EQ(plan.total_distance_feet, 3000.0);
+    EXPECT_DOUBLE_EQ(plan.total_wait_seconds, 0.0);
+    EXPECT_DOUBLE_EQ(plan.steps.front().departure_time_seconds, 100.0);
+    EXPECT_NEAR(plan.steps.back().arrival_time_seconds, 100.0 + 3000.0 / (15.0 * 1.6878), 1e-9);
+    EXPECT_NEAR(plan.steps.back().departure_time_seconds, plan.steps.back().arrival_time_seconds + 30.0, 1e-9);
+    EXPECT_EQ(plan.steps[1].edge_id, 1);
+    EXPECT_EQ(planner.get_plan_count(), 1u);
+
+    EXPECT_FALSE(planner.plan(CooperativeTaxiPlanner::TaxiRequest(8, 1, 99)).success);
+}
+
+// Test: Opposing traffic is resolved without sharing a node or an edge head-on
+TEST(TaxiPlannerTest, ResolvesHeadOnConflict) {
+    Airport::TaxiwayNetwork network = makeLine();
+    CooperativeTaxiPlanner planner;
+    planner.set_taxiway_network(&network);
+    planner.set_separation_seconds(10.0);
+
+    auto plans = planner.plan_batch({CooperativeTaxiPlanner::TaxiRequest(1, 1, 4, 0.0, 15.0, 0.0),
+                                     CooperativeTaxiPlanner::TaxiRequest(2, 4, 1, 0.0, 15.0, 0.0)});
+    ASSERT_EQ(plans.size(), 2u);
+    ASSERT_TRUE(plans[0].success);
+    ASSERT_TRUE(plans[1].success);
+    EXPECT_EQ(nodes(plans[0]), (std::vector<int>{1, 2, 3, 4}));  // first request has priority
+    EXPECT_TRUE(nodes(plans[1]) == (std::vector<int>{4, 3, 5, 1}) || plans[1].total_wait_seconds > 0.0);
+
+    // No node is held by both aircraft within the separation
+    for (int node = 1; node <= 5; ++node) {
+        double a0, a1, b0, b1;
+        if (occupies(plans[0], node, a0, a1) && occupies(plans[1], node, b0, b1)) {
+            EXPECT_TRUE(a1 + 10.0 <= b0 + 1e-9 || b1 + 10.0 <= a0 + 1e-9) << "node " << node;
+        }
+    }
+    // And no edge is used in both directions at once
+    for (size_t i = 1; i < plans[0].steps.size(); ++i) {
+        for (size_t j = 1; j < plans[1].steps.size(); ++j) {
+            const auto& a = plans[0].steps;
+            const auto& b = plans[1].steps;
+            if (a[i - 1].node_id == b[j].node_id && a[i].node_id == b[j - 1].node_id) {
+                EXPECT_TRUE(a[i].arrival_time_seconds <= b[j - 1].departure_time_seconds ||
+                            b[j].arrival_time_seconds <= a[i - 1].departure_time_seconds);
+            }
+        }
+    }
+}
+
+// Test: A trailing aircraft waits rather than overtaking or closing up
+TEST(TaxiPlannerTest, KeepsInTrailSeparation) {
+    Airport::TaxiwayNetwork network = makeLine();
+    CooperativeTaxiPlanner planner;
+    planner.set_taxiway_network(&network);
+    planner.set_separation_seconds(20.0);
+
+    auto slow = planner.plan(CooperativeTaxiPlanner::TaxiRequest(1, 2, 4, 0.0, 8.0, 0.0));
+    auto fast = planner.plan(CooperativeTaxiPlanner::TaxiRequest(2, 2, 4, 0.0, 25.0, 0.0));
+    ASSERT_TRUE(slow.success);
+    ASSERT_TRUE(fast.success);
+    EXPECT_GT(fast.total_wait_seconds, 0.0);
+    for (size_t i = 0; i < slow.steps.size(); ++i) {
+        EXPECT_GE(fast.steps[i].arrival_time_seconds, slow.steps[i].departure_time_seconds + 20.0 - 1e-9);
+    }
+}
+
+// Test: Replanning one aircraft moves only its own reservations
+TEST(TaxiPlannerTest, ReplansIncrementally) {
+    Airport::TaxiwayNetwork network = makeLine();
+    CooperativeTaxiPlanner planner;
+    planner.set_taxiway_network(&network);
+
+    ASSERT_TRUE(planner.plan(CooperativeTaxiPlanner::TaxiRequest(1, 1, 4, 0.0)).success);
+    auto second = planner.plan(CooperativeTaxiPlanner::TaxiRequest(2, 1, 4, 0.0));
+    ASSERT_TRUE(second.success);
+    EXPECT_GT(second.steps.back().arrival_time_seconds, planner.get_plan(1)->steps.back().arrival_time_seconds);
+
+    // Aircraft 1 now leaves much later; aircraft 2's plan is untouched
+    std::vector<CooperativeTaxiPlanner::TaxiStep> kept = planner.get_plan(2)->steps;
+    auto moved = planner.plan(CooperativeTaxiPlanner::TaxiRequest(1, 1, 4, 600.0));
+    ASSERT_TRUE(moved.success);
+    EXPECT_DOUBLE_EQ(moved.total_wait_seconds, 0.0);
+    EXPECT_DOUBLE_EQ(planner.get_plan(2)->steps.back().arrival_time_seconds, kept.back().arrival_time_seconds);
+
+    // A failed replan keeps the previous plan and its reservations
+    EXPECT_FALSE(planner.plan(CooperativeTaxiPlanner::TaxiRequest(1, 1, 99, 0.0)).success);
+    ASSERT_NE(planner.get_plan(1), nullptr);
+    EXPECT_DOUBLE_EQ(planner.get_plan(1)->steps.front().departure_time_seconds, 600.0);
+
+    // Once aircraft 2 is released, a replan of it has the network to itself
+    planner.release(2);
+    EXPECT_EQ(planner.get_plan(2), nullptr);
+    auto alone = planner.plan(CooperativeTaxiPlanner::TaxiRequest(2, 1, 4, 0.0));
+    ASSERT_TRUE(alone.success);
+    EXPECT_DOUBLE_EQ(alone.total_wait_seconds, 0.0);
+
+    planner.release_before(10000.0);
+    EXPECT_EQ(planner.get_plan_count(), 0u);
+}
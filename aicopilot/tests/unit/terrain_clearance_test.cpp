@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include "../../include/terrain_clearance.hpp"
+#include "../../include/terrain_awareness.h"
+#include "../../include/advanced_procedures.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// Rolling terrain, a north-south ridge near 104.6W and flat sea level east of 104.2W, in feet
+double terrainAt(double latitude, double longitude) {
+    if (longitude > -104.2) return 0.0;
+    return 2000.0 + 800.0 * std::sin(latitude * 40.0) * std::cos(longitude * 25.0) +
+           3000.0 * std::exp(-std::pow((longitude + 104.6) * 30.0, 2.0));
+}
+
+// A dense scan, raised to stay above the terrain between its samples
+bool scanCell(double south, double west, double north, double east, double& maxFt) {
+    maxFt = -1e9;
+    for (int i = 0; i <= 16; ++i) {
+        for (int j = 0; j <= 16; ++j) {
+            maxFt = std::max(maxFt, terrainAt(south + (north - south) * i / 16.0,
+                                              west + (east - west) * j / 16.0));
+        }
+    }
+    maxFt += 10.0;
+    return true;
+}
+
+std::shared_ptr<TerrainMaxPyramid> makePyramid() {
+    auto pyramid = std::make_shared<TerrainMaxPyramid>();
+    pyramid->build(39, -105, 1, 1, scanCell, 40);
+    return pyramid;
+}
+
+bool fineTerrain(double latitude, double longitude, double& elevationFt) {
+    elevationFt = terrainAt(latitude, longitude);
+    return true;
+}
+
+Position at(double latitude, double longitude, double altitude) {
+    return Position{latitude, longitude, altitude, 0.0};
+}
+
+// Smallest clearance along a segment from a dense march; first conflict distance in NM
+double bruteForce(const Position& from, const Position& to, double required, double& conflictNM) {
+    const int steps = 20000;
+    double length = std::hypot((to.latitude - from.latitude) * 60.0,
+                               (to.longitude - from.longitude) * 60.0 *
+                               std::cos(0.5 * (from.latitude + to.latitude) * 3.14159265358979323846 / 180.0));
+    double lowest = 1e9;
+    conflictNM = -1.0;
+    for (int i = 0; i <= steps; ++i) {
+        double t = static_cast<double>(i) / steps;
+        double clearance = from.altitude + (to.altitude - from.altitude) * t -
+                           terrainAt(from.latitude + (to.latitude - from.latitude) * t,
+                                     from.longitude + (to.longitude - from.longitude) * t);
+        lowest = std::min(lowest, clearance);
+        if (clearance < required && conflictNM < 0.0) conflictNM = length * t;
+    }
+    return lowest;
+}
+
+} // namespace
+
+// Test: A path well above the highest terrain clears on coarse cells alone
+TEST(TerrainClearanceTest, HighPathClearsWithoutFineSamples) {
+    TerrainClearance clearance(makePyramid(), fineTerrain);
+    PathClearanceResult result = clearance.checkPath(
+        {at(39.1, -104.9, 9000.0), at(39.5, -104.5, 9500.0), at(39.9, -104.3, 9000.0)}, 1000.0);
+    EXPECT_TRUE(result.clear);
+    EXPECT_TRUE(result.complete);
+    EXPECT_EQ(result.fineSamples, 0u);
+    EXPECT_LE(result.cellQueries, 4u);
+    EXPECT_GE(result.minimumClearanceFt, 1000.0);
+    EXPECT_LT(result.minimumClearanceFt, 9000.0 - 2000.0);
+    EXPECT_LT(result.conflictDistanceNM, 0.0);
+}
+
+// Test: Clear/conflict and the first conflict match a dense march at a fraction of its lookups
+TEST(TerrainClearanceTest, MatchesDenseMarch) {
+    TerrainClearance clearance(makePyramid(), fineTerrain);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> lat(39.05, 39.95);
+    std::uniform_real_distribution<double> lon(-104.95, -104.05);
+    std::uniform_real_distribution<double> alt(2500.0, 7000.0);
+    int conflicts = 0;
+    size_t samples = 0;
+    for (int i = 0; i < 200; ++i) {
+        Position from = at(lat(rng), lon(rng), alt(rng));
+        Position to = at(lat(rng), lon(rng), alt(rng));
+        PathClearanceResult result = clearance.checkSegment(from, to, 500.0);
+        samples += result.fineSamples + result.cellQueries;
+
+        double conflictNM = 0.0;
+        double lowest = bruteForce(from, to, 500.0, conflictNM);
+        if (result.clear) {
+            // Fine samples are a post apart; terrain changes a few feet between them
+            EXPECT_GE(lowest, 500.0 - 15.0) << i;
+            EXPECT_LE(result.minimumClearanceFt, lowest + 15.0) << i;
+        } else {
+            ++conflicts;
+            EXPECT_LT(lowest, 500.0 + 1e-6) << i;
+            EXPECT_LT(result.minimumClearanceFt, 500.0);
+            EXPECT_NEAR(result.conflictDistanceNM, conflictNM, 0.1) << i;
+            EXPECT_NEAR(result.conflictPosition.altitude - result.conflictTerrainFt,
+                        result.minimumClearanceFt, 1e-6);
+        }
+    }
+    EXPECT_GT(conflicts, 20);
+    EXPECT_LT(conflicts, 180);
+    EXPECT_LT(samples, 200u * 20000u / 20u);
+}
+
+// Test: Many paths at once; a high batch clears in one lookup, a low one per path
+TEST(TerrainClearanceTest, BatchChecksCandidatePaths) {
+    TerrainClearance clearance(makePyramid(), fineTerrain);
+    std::vector<std::vector<Position>> high;
+    for (int i = 0; i < 8; ++i) {
+        high.push_back({at(39.5, -104.6, 8000.0), at(39.5 + 0.05 * i, -104.4, 9000.0)});
+    }
+    std::vector<PathClearanceResult> results = clearance.checkPaths(high, 1000.0);
+    ASSERT_EQ(results.size(), high.size());
+    size_t lookups = 0;
+    for (const PathClearanceResult& result : results) {
+        EXPECT_TRUE(result.clear);
+        lookups += result.cellQueries + result.fineSamples;
+    }
+    EXPECT_EQ(lookups, 1u);
+
+    // West of the ridge at 5000 ft: eastbound paths hit it, northbound ones do not
+    std::vector<std::vector<Position>> low = {
+        {at(39.5, -104.9, 5000.0), at(39.5, -104.3, 5000.0)},
+        {at(39.3, -104.9, 5000.0), at(39.35, -104.9, 5000.0)},
+    };
+    results = clearance.checkPaths(low, 300.0);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_FALSE(results[0].clear);
+    EXPECT_NEAR(results[0].conflictPosition.longitude, -104.6, 0.1);
+    EXPECT_EQ(results[1].clear, clearance.checkPath(low[1], 300.0).clear);
+    EXPECT_EQ(results[0].conflictDistanceNM, clearance.checkPath(low[0], 300.0).conflictDistanceNM);
+}
+
+// Test: The ridge blocks the view across it; over the sea the Earth's curvature does
+TEST(TerrainClearanceTest, LineOfSight) {
+    TerrainClearance clearance(makePyramid(), fineTerrain);
+    EXPECT_FALSE(clearance.hasLineOfSight(at(39.5, -104.8, 4500.0), at(39.5, -104.4, 4500.0)));
+    EXPECT_TRUE(clearance.hasLineOfSight(at(39.5, -104.8, 6000.0), at(39.5, -104.4, 6000.0)));
+
+    // 40 NM apart at 100 ft the chord dips about 350 ft below sea level
+    Position south = at(39.0, -104.15, 100.0);
+    Position north = at(39.67, -104.15, 100.0);
+    EXPECT_TRUE(clearance.checkSegment(south, north, 50.0).clear);
+    EXPECT_FALSE(clearance.hasLineOfSight(south, north));
+    south.altitude = north.altitude = 500.0;
+    EXPECT_TRUE(clearance.hasLineOfSight(south, north));
+
+    // With no terrain at all the sea-level answer is flagged incomplete
+    TerrainClearance none(nullptr, nullptr);
+    PathClearanceResult result = none.checkSegment(at(10.0, 10.0, 100.0), at(10.1, 10.0, 100.0), 50.0);
+    EXPECT_TRUE(result.clear);
+    EXPECT_FALSE(result.complete);
+}
+
+// Test: Engine-out escape headings avoid the high ground ahead
+TEST(TerrainClearanceTest, EngineFailureFindsClearClimbHeadings) {
+    // 9000 ft high ground north of 40.05N, 500 ft elsewhere
+    auto pyramid = std::make_shared<TerrainMaxPyramid>();
+    ASSERT_TRUE(pyramid->build(39, -101, 2, 2,
+        [](double south, double, double north, double, double& maxFt) {
+            maxFt = north > 40.05 + 1e-9 && south < 41.0 ? 9000.0 : 500.0;
+            return true;
+        }, 120));
+    auto stack = std::make_shared<TerrainLodStack>();
+    stack->setCoarse(pyramid);
+    auto terrain = std::make_shared<TerrainAwareness>();
+    terrain->setTerrainLods(stack);
+
+    PerformanceProfile profile{};
+    profile.vs1 = 80.0;
+    profile.vy = 110.0;
+    profile.climbRate = 1200.0;
+    AdvancedProcedures procedures;
+    procedures.initialize(profile, AircraftCategory::MULTI_ENGINE_PISTON);
+    procedures.setTerrain(terrain);
+
+    AircraftState state{};
+    state.position = at(40.0, -100.0, 3000.0);
+    state.heading = 0.0;
+    state.groundSpeed = 120.0;
+    EngineFailureProcedure procedure = procedures.handleEngineFailure(1, state, 3000.0);
+    ASSERT_FALSE(procedure.clearClimbHeadings.empty());
+    for (double heading : procedure.clearClimbHeadings) {
+        double off = std::min(heading, 360.0 - heading);
+        EXPECT_GE(off, 75.0 - 1e-6) << heading;
+    }
+    EXPECT_NEAR(procedure.clearClimbHeadings[0], 285.0, 1e-6);
+    ASSERT_FALSE(procedure.subsequentActions.empty());
+    EXPECT_NE(procedure.subsequentActions[0].find("285"), std::string::npos);
+
+    // Heading away from the high ground, straight ahead is first
+    state.heading = 180.0;
+    procedure = procedures.handleEngineFailure(1, state, 3000.0);
+    ASSERT_FALSE(procedure.clearClimbHeadings.empty());
+    EXPECT_NEAR(procedure.clearClimbHeadings[0], 180.0, 1e-6);
+}
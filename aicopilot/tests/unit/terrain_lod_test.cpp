@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+#include "../../include/terrain_lod.hpp"
+#include "../../include/srtm_loader.hpp"
+#include "../../include/terrain_awareness.h"
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// Rolling terrain with a ridge, in feet
+double terrainAt(double latitude, double longitude) {
+    return 2000.0 + 800.0 * std::sin(latitude * 40.0) * std::cos(longitude * 25.0) +
+           3000.0 * std::exp(-std::pow((longitude + 104.6) * 30.0, 2.0));
+}
+
+// Writes an SRTM3-size tile; samples are in meters
+template <typename ValueFn>
+void writeTile(const std::filesystem::path& dir, int lat, int lon, ValueFn value_at) {
+    std::filesystem::create_directories(dir);
+    const int n = SRTMTile::SRTM3_SIZE;
+    std::vector<uint8_t> bytes(static_cast<size_t>(n) * n * 2);
+    for (int row = 0; row < n; ++row) {
+        for (int col = 0; col < n; ++col) {
+            uint16_t value = static_cast<uint16_t>(value_at(row, col));
+            size_t i = (static_cast<size_t>(row) * n + col) * 2;
+            bytes[i] = static_cast<uint8_t>(value >> 8);
+            bytes[i + 1] = static_cast<uint8_t>(value & 0xFF);
+        }
+    }
+    std::ofstream out(dir / SRTMTile::GetFileName(lat, lon), std::ios::binary);
+    out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+// Gentle slopes with a 2500 m peak at 39.5N, 104.5W
+std::filesystem::path writeMountainTile(const std::string& name) {
+    auto dir = std::filesystem::temp_directory_path() / name;
+    writeTile(dir, 39, -105, [](int row, int col) {
+        double distance = std::hypot(row - 600.0, col - 600.0);
+        return static_cast<int16_t>(300 + row / 10 + std::max(0.0, 2500.0 - distance * 20.0));
+    });
+    return dir;
+}
+
+AircraftState cruiseState(double altitude, double groundSpeed) {
+    AircraftState state{};
+    state.position = {39.2, -104.7, altitude, 0.0};
+    state.heading = 0.0;
+    state.groundSpeed = groundSpeed;
+    state.trueAirspeed = groundSpeed;
+    return state;
+}
+
+} // namespace
+
+// Test: Fine data near the terrain and close ahead, coarse cells high and fast
+TEST(TerrainLodTest, SelectsLevelFromAglSpeedAndDistance) {
+    auto select = [](double agl, double speed, double distance) {
+        TerrainLodQuery query;
+        query.aglFt = agl;
+        query.groundSpeedKts = speed;
+        query.distanceNM = distance;
+        return TerrainLodStack::selectLod(query);
+    };
+    EXPECT_EQ(select(800.0, 140.0, 1.0), TerrainLod::SRTM1);     // approach
+    EXPECT_EQ(select(800.0, 140.0, 6.0), TerrainLod::SRTM3);     // far end of the corridor
+    EXPECT_EQ(select(800.0, 60.0, 6.0), TerrainLod::SRTM1);      // slow, low level
+    EXPECT_EQ(select(-50.0, 140.0, 0.5), TerrainLod::SRTM1);
+    EXPECT_EQ(select(6000.0, 120.0, 2.0), TerrainLod::SRTM3);
+    EXPECT_EQ(select(6000.0, 250.0, 2.0), TerrainLod::COARSE);
+    EXPECT_EQ(select(12000.0, 120.0, 2.0), TerrainLod::COARSE);
+    EXPECT_EQ(select(34000.0, 450.0, 10.0), TerrainLod::COARSE); // FL350
+}
+
+// Test: Every level of the pyramid stands at or above the terrain it covers
+TEST(TerrainLodTest, PyramidIsConservative) {
+    TerrainMaxPyramid pyramid;
+    const int cellsPerDegree = 40;
+    // Exact cell maximum from a dense scan
+    ASSERT_TRUE(pyramid.build(39, -105, 1, 2,
+        [](double south, double west, double north, double east, double& maxFt) {
+            maxFt = -1e9;
+            for (int i = 0; i <= 16; ++i) {
+                for (int j = 0; j <= 16; ++j) {
+                    maxFt = std::max(maxFt, terrainAt(south + (north - south) * i / 16.0,
+                                                      west + (east - west) * j / 16.0));
+                }
+            }
+            return west < -104.0;   // the east tile has no data
+        }, cellsPerDegree));
+    ASSERT_EQ(pyramid.getRows(0), 40);
+    ASSERT_EQ(pyramid.getCols(0), 80);
+    EXPECT_EQ(pyramid.getRows(pyramid.getLevelCount() - 1), 1);
+    EXPECT_EQ(pyramid.getCols(pyramid.getLevelCount() - 1), 1);
+    EXPECT_EQ(pyramid.getMemoryUsage() > 40u * 80u * 2u, true);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> lat(39.0, 40.0);
+    std::uniform_real_distribution<double> lon(-105.0, -104.0);
+    for (int i = 0; i < 500; ++i) {
+        double la = lat(rng);
+        double lo = lon(rng);
+        // Dense enough that the scan maximum bounds this point to within a few feet
+        double truth = terrainAt(la, lo) - 5.0;
+        double previous = -1e9;
+        for (size_t level = 0; level < pyramid.getLevelCount(); ++level) {
+            double maxFt = 0.0;
+            ASSERT_TRUE(pyramid.getMaxElevation(la, lo, level, maxFt)) << level;
+            EXPECT_GE(maxFt, truth);
+            EXPECT_GE(maxFt, previous);
+            previous = maxFt;
+        }
+        double boxFt = 0.0;
+        ASSERT_TRUE(pyramid.getMaxElevation(la - 0.05, lo - 0.05, la + 0.05, lo + 0.05, boxFt));
+        EXPECT_GE(boxFt, truth);
+    }
+
+    double maxFt = 0.0;
+    EXPECT_FALSE(pyramid.getMaxElevation(39.5, -103.5, 0, maxFt));  // no data
+    EXPECT_FALSE(pyramid.getMaxElevation(41.0, -104.5, 0, maxFt));  // outside
+    EXPECT_FALSE(pyramid.getMaxElevation(39.2, -103.8, 39.4, -103.6, maxFt));
+    ASSERT_TRUE(pyramid.getMaxElevation(39.2, -104.2, 39.4, -103.6, maxFt));
+}
+
+// Test: Coarse levels never answer below SRTM1; missing levels fall back
+TEST(TerrainLodTest, StackFallsBackAndStaysConservative) {
+    auto dir = writeMountainTile("aicopilot_lod_stack");
+    auto srtm = std::make_shared<SRTMLoader>(dir.string());
+    auto pyramid = std::make_shared<TerrainMaxPyramid>();
+    ASSERT_TRUE(pyramid->buildFromSrtm(*srtm, 39, -105, 1, 1));
+
+    TerrainLodStack stack;
+    double elevation = 0.0;
+    EXPECT_FALSE(stack.getElevation(39.5, -104.5, TerrainLod::SRTM1, elevation));
+    stack.setSrtm1(srtm);
+    stack.setSrtm3(srtm);   // the same tiles, sampled as posts
+    stack.setCoarse(pyramid);
+    EXPECT_TRUE(stack.hasLevel(TerrainLod::COARSE));
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> offset(-0.2, 0.2);
+    for (int i = 0; i < 300; ++i) {
+        double la = 39.5 + offset(rng);
+        double lo = -104.5 + offset(rng);
+        double fine = 0.0, posts = 0.0, coarse = 0.0;
+        ASSERT_TRUE(stack.getElevation(la, lo, TerrainLod::SRTM1, fine));
+        ASSERT_TRUE(stack.getElevation(la, lo, TerrainLod::SRTM3, posts));
+        ASSERT_TRUE(stack.getElevation(la, lo, TerrainLod::COARSE, coarse));
+        EXPECT_GE(posts + 1e-9, fine);
+        EXPECT_GE(coarse + 1e-9, fine);
+    }
+
+    // Outside the tiles and the pyramid, nothing answers
+    EXPECT_FALSE(stack.getElevation(45.5, -104.5, TerrainLod::COARSE, elevation));
+    EXPECT_EQ(stack.getStats().unavailable, 2u);
+
+    // Without SRTM3, SRTM3 requests are served from SRTM1
+    stack.setSrtm3(nullptr);
+    TerrainLod served = TerrainLod::COARSE;
+    ASSERT_TRUE(stack.getElevation(39.5, -104.5, TerrainLod::SRTM3, elevation, &served));
+    EXPECT_EQ(served, TerrainLod::SRTM1);
+    EXPECT_EQ(stack.getStats().fallbacks, 1u);
+
+    std::filesystem::remove_all(dir);
+}
+
+// Test: At cruise the look-ahead reads only the pyramid; low level reads SRTM1
+TEST(TerrainLodTest, CruiseLookaheadSkipsFineTiles) {
+    auto dir = writeMountainTile("aicopilot_lod_cruise");
+    auto pyramid = std::make_shared<TerrainMaxPyramid>();
+    {
+        SRTMLoader builder(dir.string());
+        ASSERT_TRUE(pyramid->buildFromSrtm(builder, 39, -105, 1, 1));
+    }
+    auto srtm1 = std::make_shared<SRTMLoader>(dir.string());
+    auto stack = std::make_shared<TerrainLodStack>();
+    stack->setSrtm1(srtm1);
+    stack->setCoarse(pyramid);
+
+    TerrainAwareness taws;
+    taws.setTerrainLods(stack);
+    EXPECT_TRUE(taws.hasTerrainLods());
+    taws.updateAircraftState(cruiseState(35000.0, 450.0));
+    EXPECT_GT(taws.getLookaheadResult().slices, 0u);
+    EXPECT_EQ(srtm1->GetCacheSize(), 0);
+    TerrainLodStats cruise = stack->getStats();
+    EXPECT_GT(cruise.served[static_cast<size_t>(TerrainLod::COARSE)], 0u);
+    EXPECT_EQ(cruise.served[static_cast<size_t>(TerrainLod::SRTM1)], 0u);
+
+    // Approaching the peak low and slow: the near corridor is sampled at full resolution
+    AircraftState low = cruiseState(2500.0, 110.0);
+    taws.updateAircraftState(low);
+    EXPECT_EQ(srtm1->GetCacheSize(), 1);
+    EXPECT_GT(stack->getStats().served[static_cast<size_t>(TerrainLod::SRTM1)], 0u);
+
+    // Point queries take the finest level
+    Position peak{39.5, -104.5, 0.0, 0.0};
+    EXPECT_NEAR(taws.getTerrainElevation(peak), srtm1->GetElevation(39.5, -104.5), 1e-6);
+
+    std::filesystem::remove_all(dir);
+}
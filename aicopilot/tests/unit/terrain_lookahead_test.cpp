@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "../../include/terrain_lookahead.hpp"
+#include "../../include/terrain_awareness.h"
+#include <cmath>
+#include <filesystem>
+
+using namespace AICopilot;
+
+namespace {
+
+// Terrain as a function of position, counting the points sampled
+struct FakeTerrain {
+    std::function<double(double, double)> elevationAt;
+    size_t sampled = 0;
+
+    TerrainLookahead::ElevationBatch batch() {
+        return [this](const LatLon* points, size_t count, double* outFt) {
+            for (size_t i = 0; i < count; ++i) {
+                outFt[i] = elevationAt(points[i].latitude, points[i].longitude);
+            }
+            sampled += count;
+        };
+    }
+};
+
+TerrainLookaheadInput makeInput(double lat, double lon, double altitude, double track,
+                                double groundSpeed, double verticalSpeed = 0.0, double turnRate = 0.0) {
+    TerrainLookaheadInput input;
+    input.position = {lat, lon, altitude, track};
+    input.altitude = altitude;
+    input.trackDeg = track;
+    input.groundSpeedKts = groundSpeed;
+    input.verticalSpeedFpm = verticalSpeed;
+    input.turnRateDegPerSec = turnRate;
+    return input;
+}
+
+} // namespace
+
+// Test: Level flight over flat terrain stays clear and reuses the corridor between ticks
+TEST(TerrainLookaheadTest, SteadyFlightReusesCorridor) {
+    FakeTerrain terrain;
+    terrain.elevationAt = [](double, double) { return 200.0; };
+    TerrainLookahead lookahead;
+
+    const auto& first = lookahead.update(makeInput(40.0, -74.0, 3000.0, 0.0, 240.0), terrain.batch());
+    EXPECT_EQ(first.level, TerrainWarningLevel::NONE);
+    EXPECT_NEAR(first.minimumClearance, 2800.0, 1e-6);
+    size_t fullCorridor = terrain.sampled;
+    EXPECT_EQ(fullCorridor, first.slices * TerrainLookahead::LATERAL_SAMPLES);
+    EXPECT_EQ(first.slicesSampled, first.slices);
+
+    // 20 Hz ticks: 240 kt covers 1/300 NM each
+    for (int tick = 1; tick <= 100; ++tick) {
+        double lat = 40.0 + tick * (240.0 / 3600.0 / 20.0) / 60.0;
+        lookahead.update(makeInput(lat, -74.0, 3000.0, 0.0, 240.0), terrain.batch());
+    }
+    EXPECT_LT(terrain.sampled - fullCorridor, fullCorridor / 2);
+    EXPECT_EQ(lookahead.getResult().level, TerrainWarningLevel::NONE);
+}
+
+// Test: Alert level escalates as a ridge ahead gets closer
+TEST(TerrainLookaheadTest, RidgeAheadEscalates) {
+    FakeTerrain terrain;
+    terrain.elevationAt = [](double lat, double) { return lat > 40.1 ? 5000.0 : 0.0; };
+    TerrainLookahead lookahead;
+    lookahead.setLookaheadTime(120.0);
+
+    // 0.1° = 6 NM at 4 NM per minute: 90 s out, outside the caution window
+    auto far = lookahead.update(makeInput(40.0, -74.0, 3000.0, 0.0, 240.0), terrain.batch());
+    EXPECT_EQ(far.level, TerrainWarningLevel::NONE);
+    EXPECT_NEAR(far.timeToConflict, 90.0, 2.0);
+
+    auto caution = lookahead.update(makeInput(40.05, -74.0, 3000.0, 0.0, 240.0), terrain.batch());
+    EXPECT_EQ(caution.level, TerrainWarningLevel::CAUTION);
+    EXPECT_NEAR(caution.conflictTerrain, 5000.0, 1e-6);
+
+    auto pullUp = lookahead.update(makeInput(40.08, -74.0, 3000.0, 0.0, 240.0), terrain.batch());
+    EXPECT_EQ(pullUp.level, TerrainWarningLevel::PULL_UP);
+    EXPECT_LT(pullUp.minimumClearance, 0.0);
+
+    // A steep enough climb clears the ridge again
+    auto climbing = lookahead.update(makeInput(40.05, -74.0, 3000.0, 0.0, 240.0, 6000.0), terrain.batch());
+    EXPECT_EQ(climbing.level, TerrainWarningLevel::NONE);
+}
+
+// Test: A turn toward terrain is predicted that straight-line projection would miss
+TEST(TerrainLookaheadTest, TurnSweepsIntoTerrain) {
+    FakeTerrain terrain;
+    // High ground from about 2.2 NM east of the start
+    terrain.elevationAt = [](double, double lon) { return lon > -74.0 + 2.2 / (60.0 * std::cos(40.0 * 3.14159265358979323846 / 180.0)) ? 6000.0 : 0.0; };
+
+    TerrainLookahead straight;
+    EXPECT_EQ(straight.update(makeInput(40.0, -74.0, 3000.0, 0.0, 200.0), terrain.batch()).level,
+              TerrainWarningLevel::NONE);
+
+    AircraftState state{};
+    state.position = {40.0, -74.0, 3000.0, 0.0};
+    state.heading = 0.0;
+    state.groundSpeed = 200.0;
+    state.trueAirspeed = 200.0;
+    state.bank = 25.0;
+    TerrainLookaheadInput input = TerrainLookaheadInput::fromAircraftState(state);
+    EXPECT_NEAR(input.turnRateDegPerSec, 2.54, 0.05);
+
+    TerrainLookahead turning;
+    const auto& result = turning.update(input, terrain.batch());
+    EXPECT_NE(result.level, TerrainWarningLevel::NONE);
+    EXPECT_GT(result.timeToConflict, 30.0);
+    EXPECT_LT(result.timeToConflict, 60.0);
+}
+
+// Test: A track change drops the slices the new path no longer runs through
+TEST(TerrainLookaheadTest, TrackChangeResamples) {
+    FakeTerrain terrain;
+    terrain.elevationAt = [](double, double) { return 0.0; };
+    TerrainLookahead lookahead;
+
+    lookahead.update(makeInput(40.0, -74.0, 3000.0, 0.0, 240.0), terrain.batch());
+    const auto& turned = lookahead.update(makeInput(40.0, -74.0, 3000.0, 10.0, 240.0), terrain.batch());
+    EXPECT_GT(turned.slicesSampled, turned.slices * 9 / 10);
+
+    // Too slow to project (taxi, hover): nothing is sampled
+    size_t before = terrain.sampled;
+    const auto& slow = lookahead.update(makeInput(40.0, -74.0, 3000.0, 10.0, 10.0), terrain.batch());
+    EXPECT_EQ(slow.slices, 0u);
+    EXPECT_EQ(terrain.sampled, before);
+}
+
+// Test: TerrainAwareness advances the look-ahead from its terrain database
+TEST(TerrainLookaheadTest, TerrainAwarenessLookahead) {
+    auto path = (std::filesystem::temp_directory_path() / "aicopilot_lookahead.atp").string();
+    TerrainPackBuilder builder(11);
+    builder.addPoint(40.5, -73.5, 8000.0);
+    ASSERT_TRUE(builder.write(path));
+
+    TerrainAwareness terrain;
+    ASSERT_TRUE(terrain.loadTerrainDatabase(path));
+
+    AircraftState state{};
+    state.position = {39.98, -73.5, 3000.0, 0.0};
+    state.heading = 0.0;
+    state.groundSpeed = 240.0;
+    state.trueAirspeed = 240.0;
+    terrain.updateAircraftState(state);
+    EXPECT_NE(terrain.getLookaheadResult().level, TerrainWarningLevel::NONE);
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "../../include/terrain_pack.hpp"
+#include "../../include/terrain_awareness.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace AICopilot;
+
+namespace {
+
+// Sloping tile: elevation rises 1000 ft per degree east and 500 ft per degree north
+void addSlope(TerrainPackBuilder& builder, int tileLat, int tileLon) {
+    int last = builder.getSamplesPerEdge() - 1;
+    for (int row = 0; row <= last; ++row) {
+        for (int col = 0; col <= last; ++col) {
+            double lat = tileLat + 1.0 - static_cast<double>(row) / last;
+            double lon = tileLon + static_cast<double>(col) / last;
+            if (row == 0) lat -= 1e-9;
+            if (col == last) lon -= 1e-9;
+            builder.addPoint(lat, lon, 2000.0 + (lon - tileLon) * 1000.0 + (lat - tileLat) * 500.0);
+        }
+    }
+}
+
+} // namespace
+
+// Test: Both encodings reproduce the compiled grid and agree with each other
+TEST(TerrainPackTest, RoundTripsRawAndDelta) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_terrain_pack";
+    std::filesystem::create_directories(dir);
+
+    for (TerrainPackEncoding encoding : {TerrainPackEncoding::RAW, TerrainPackEncoding::DELTA}) {
+        TerrainPackBuilder builder(31);
+        addSlope(builder, 46, 7);
+        addSlope(builder, 46, 8);
+        auto path = (dir / "slope.atp").string();
+        ASSERT_TRUE(builder.write(path, encoding));
+
+        TerrainPack pack;
+        ASSERT_TRUE(TerrainPack::isPackFile(path));
+        ASSERT_TRUE(pack.open(path));
+        EXPECT_EQ(pack.getTileCount(), 2u);
+        EXPECT_TRUE(pack.hasTile(46, 8));
+        EXPECT_FALSE(pack.hasTile(47, 8));
+
+        double ft = 0.0;
+        ASSERT_TRUE(pack.getElevation(46.5, 7.5, ft));
+        EXPECT_NEAR(ft, 2000.0 + 500.0 + 250.0, 1.0);
+        ASSERT_TRUE(pack.getElevation(46.25, 8.75, ft));
+        EXPECT_NEAR(ft, 2000.0 + 750.0 + 125.0, 1.0);
+        EXPECT_FALSE(pack.getElevation(48.0, 7.5, ft));
+
+        double minFt = 0.0, maxFt = 0.0;
+        ASSERT_TRUE(pack.getTileRange(46, 7, minFt, maxFt));
+        EXPECT_NEAR(minFt, 2000.0, 1.0);
+        EXPECT_NEAR(maxFt, 3500.0, 1.0);
+
+        if (encoding == TerrainPackEncoding::DELTA) {
+            EXPECT_GT(pack.getDecodeCacheStats().tiles, 0u);
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+// Test: Sparse points are binned conservatively and fill the rest of their tile
+TEST(TerrainPackTest, SparsePointsFillTheirTile) {
+    auto path = (std::filesystem::temp_directory_path() / "aicopilot_terrain_sparse.atp").string();
+
+    TerrainPackBuilder builder;
+    builder.addPoint(34.0, -118.0, 500.0);
+    builder.addPoint(34.0001, -118.0001, 450.0);   // same grid sample; the higher one wins
+    builder.addPoint(35.5, -119.5, 1500.0);
+    ASSERT_TRUE(builder.write(path));
+
+    TerrainPack pack;
+    ASSERT_TRUE(pack.open(path));
+    double ft = 0.0;
+    ASSERT_TRUE(pack.getElevation(34.0001, -118.0001, ft));
+    EXPECT_DOUBLE_EQ(ft, 500.0);
+    ASSERT_TRUE(pack.getElevation(35.1, -119.9, ft));
+    EXPECT_DOUBLE_EQ(ft, 1500.0);
+
+    pack.close();
+    std::filesystem::remove(path);
+}
+
+// Test: Truncated or foreign files are rejected
+TEST(TerrainPackTest, RejectsInvalidFiles) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_terrain_bad";
+    std::filesystem::create_directories(dir);
+    auto good = (dir / "good.atp").string();
+    auto cut = (dir / "cut.atp").string();
+
+    TerrainPackBuilder builder(11);
+    builder.addPoint(10.5, 10.5, 100.0);
+    ASSERT_TRUE(builder.write(good));
+    std::filesystem::copy_file(good, cut);
+    std::filesystem::resize_file(cut, std::filesystem::file_size(good) - 8);
+
+    TerrainPack pack;
+    EXPECT_FALSE(pack.open(cut));
+    EXPECT_FALSE(pack.open((dir / "missing.atp").string()));
+    std::ofstream((dir / "text.csv").string()) << "10.5,10.5,100\n";
+    EXPECT_FALSE(TerrainPack::isPackFile((dir / "text.csv").string()));
+
+    std::filesystem::remove_all(dir);
+}
+
+// Test: TerrainAwareness maps a pack through loadTerrainDatabase
+TEST(TerrainPackTest, TerrainAwarenessLoadsPack) {
+    auto path = (std::filesystem::temp_directory_path() / "aicopilot_terrain_ta.atp").string();
+    TerrainPackBuilder builder;
+    builder.addPoint(34.0, -118.0, 500.0);
+    ASSERT_TRUE(builder.write(path));
+
+    TerrainAwareness ta;
+    ASSERT_TRUE(ta.loadTerrainDatabase(path));
+    EXPECT_TRUE(ta.hasTerrainPack());
+    EXPECT_DOUBLE_EQ(ta.getTerrainElevation({34.2, -117.9, 0.0, 0.0}), 500.0);
+    EXPECT_DOUBLE_EQ(ta.getTerrainElevation({10.0, 10.0, 0.0, 0.0}), 0.0);  // outside the pack
+
+    std::filesystem::remove(path);
+}
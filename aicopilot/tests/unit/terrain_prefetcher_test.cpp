@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "../../include/terrain_prefetcher.hpp"
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// Records every tile the prefetcher asks for
+struct RecordingLoader {
+    std::mutex mutex;
+    std::vector<std::pair<int, int>> calls;
+
+    TerrainPrefetcher::TileLoader loader() {
+        return [this](int lat, int lon) {
+            std::lock_guard<std::mutex> lock(mutex);
+            calls.push_back({lat, lon});
+            return lat >= 0;  // pretend the southern hemisphere has no data
+        };
+    }
+
+    std::set<std::pair<int, int>> tiles() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return {calls.begin(), calls.end()};
+    }
+};
+
+Position makePosition(double lat, double lon) {
+    Position p;
+    p.latitude = lat;
+    p.longitude = lon;
+    return p;
+}
+
+Waypoint makeWaypoint(double lat, double lon) {
+    Waypoint wp;
+    wp.position = makePosition(lat, lon);
+    return wp;
+}
+
+} // namespace
+
+// Test: Requests made before start() are loaded once the worker runs, without duplicates
+TEST(TerrainPrefetcherTest, LoadsQueuedTilesOnce) {
+    RecordingLoader recorder;
+    TerrainPrefetcher prefetcher(recorder.loader());
+
+    EXPECT_TRUE(prefetcher.request(39, -105));
+    EXPECT_FALSE(prefetcher.request(39, -105));
+    EXPECT_TRUE(prefetcher.request(-10, 20));
+    EXPECT_EQ(prefetcher.getStats().pending, 2u);
+
+    prefetcher.start();
+    prefetcher.waitIdle();
+
+    TerrainPrefetchStats stats = prefetcher.getStats();
+    EXPECT_EQ(stats.requested, 2u);
+    EXPECT_EQ(stats.loaded, 1u);
+    EXPECT_EQ(stats.unavailable, 1u);
+    EXPECT_EQ(stats.pending, 0u);
+    EXPECT_EQ(recorder.calls.size(), 2u);
+}
+
+// Test: Route prefetch covers every tile a leg crosses and stops at the horizon
+TEST(TerrainPrefetcherTest, RouteCoversLegTiles) {
+    RecordingLoader recorder;
+    TerrainPrefetcher prefetcher(recorder.loader());
+
+    // Due east along 39.5N from 105.5W across three tiles, then far beyond the horizon
+    std::vector<Waypoint> route = {makeWaypoint(39.5, -103.5), makeWaypoint(39.5, -80.0)};
+    prefetcher.prefetchRoute(route, 0, makePosition(39.5, -105.5));
+    prefetcher.start();
+    prefetcher.waitIdle();
+
+    auto tiles = recorder.tiles();
+    EXPECT_TRUE(tiles.count({39, -106}));
+    EXPECT_TRUE(tiles.count({39, -105}));
+    EXPECT_TRUE(tiles.count({39, -104}));
+    EXPECT_FALSE(tiles.count({39, -85}));
+}
+
+// Test: The look-ahead cone loads the tile ahead of the aircraft before anything else
+TEST(TerrainPrefetcherTest, LookAheadQueuedNearestFirst) {
+    RecordingLoader recorder;
+    TerrainPrefetcher prefetcher(recorder.loader());
+
+    prefetcher.request(45, 10);  // route tile already waiting
+    size_t queued = prefetcher.prefetchLookAhead(makePosition(39.9, -104.5), 0.0, 240.0);
+    EXPECT_GT(queued, 1u);
+
+    prefetcher.start();
+    prefetcher.waitIdle();
+
+    ASSERT_FALSE(recorder.calls.empty());
+    EXPECT_EQ(recorder.calls.front(), std::make_pair(39, -105));
+    EXPECT_EQ(recorder.calls.back(), std::make_pair(45, 10));
+    EXPECT_TRUE(recorder.tiles().count({40, -105}));
+}
+
+// Test: The queue is bounded and overflow is counted
+TEST(TerrainPrefetcherTest, DropsWhenFull) {
+    RecordingLoader recorder;
+    TerrainPrefetcher prefetcher(recorder.loader());
+    for (size_t i = 0; i <= TerrainPrefetcher::MAX_PENDING_TILES; ++i) {
+        prefetcher.request(0, static_cast<int>(i));
+    }
+    EXPECT_EQ(prefetcher.getStats().dropped, 1u);
+    prefetcher.stop();
+}
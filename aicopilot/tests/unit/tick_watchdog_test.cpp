@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "../../include/tick_watchdog.hpp"
+#include "../../include/system_monitor.hpp"
+#include "../../include/task_scheduler.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace AICopilot;
+using namespace std::chrono_literals;
+
+namespace {
+
+void runTicks(TickWatchdog& watchdog, size_t count, TickWatchdog::Clock::duration elapsed) {
+    for (size_t i = 0; i < count; ++i) watchdog.recordTick(elapsed);
+}
+
+} // namespace
+
+// Test: Sustained overruns shed steps in order and recovery restores them newest first
+TEST(TickWatchdogTest, DegradesInPriorityOrderAndRecovers) {
+    TickWatchdog watchdog(20ms);
+    std::vector<std::string> log;
+    for (const char* name : {"taws", "ml", "voice"}) {
+        watchdog.addStep(name, [&log, name](bool degraded) {
+            log.push_back(std::string(degraded ? "-" : "+") + name);
+        });
+    }
+
+    // Occasional overruns are tolerated
+    for (int i = 0; i < 90; ++i) watchdog.recordTick(i % 10 == 0 ? 30ms : 5ms);
+    EXPECT_EQ(watchdog.getLevel(), 0u);
+
+    // One step per window while the overrun persists, never past the last
+    runTicks(watchdog, TickWatchdog::WINDOW_TICKS, 30ms);
+    EXPECT_EQ(watchdog.getLevel(), 1u);
+    runTicks(watchdog, TickWatchdog::WINDOW_TICKS * 5, 30ms);
+    EXPECT_EQ(watchdog.getLevel(), 3u);
+    EXPECT_EQ(log, (std::vector<std::string>{"-taws", "-ml", "-voice"}));
+
+    runTicks(watchdog, TickWatchdog::RECOVER_TICKS - 1, 5ms);
+    EXPECT_EQ(watchdog.getLevel(), 3u);
+    runTicks(watchdog, 1, 5ms);
+    EXPECT_EQ(watchdog.getLevel(), 2u);
+    EXPECT_EQ(log.back(), "+voice");
+
+    TickWatchdogStats stats = watchdog.getStats();
+    EXPECT_EQ(stats.activeSteps, (std::vector<std::string>{"taws", "ml"}));
+    EXPECT_DOUBLE_EQ(stats.budgetMs, 20.0);
+    EXPECT_DOUBLE_EQ(stats.maxTickMs, 30.0);
+    EXPECT_EQ(stats.levelChanges, 4u);
+
+    watchdog.restoreAll();
+    EXPECT_EQ(watchdog.getLevel(), 0u);
+    EXPECT_EQ(log.back(), "+taws");
+}
+
+// Test: Level changes reach the system monitor
+TEST(TickWatchdogTest, ReportsToSystemMonitor) {
+    SystemMonitor monitor;
+    TickWatchdog watchdog(10ms);
+    watchdog.setSystemMonitor(&monitor);
+    watchdog.addStep("taws_resolution", [](bool) {});
+
+    runTicks(watchdog, TickWatchdog::WINDOW_TICKS, 15ms);
+    SystemMonitor::DegradationState state = monitor.getDegradationState();
+    EXPECT_EQ(state.level, 1u);
+    EXPECT_EQ(state.activeSteps, (std::vector<std::string>{"taws_resolution"}));
+    ASSERT_FALSE(monitor.getActiveAlerts().empty());
+    EXPECT_EQ(monitor.getActiveAlerts().back().severity, SystemHealth::DEGRADED);
+
+    bool recommended = false;
+    for (const auto& line : monitor.getHealthReport().recommendations) {
+        recommended |= line.find("taws_resolution") != std::string::npos;
+    }
+    EXPECT_TRUE(recommended);
+
+    runTicks(watchdog, TickWatchdog::RECOVER_TICKS, 1ms);
+    EXPECT_EQ(monitor.getDegradationState().level, 0u);
+    EXPECT_EQ(monitor.getDegradationState().changes, 2u);
+}
+
+// Test: The scheduler feeds every tick to its watchdog and rates can be lowered
+TEST(TickWatchdogTest, SchedulerMeasuresTicks) {
+    TaskScheduler scheduler(0);
+    int runs = 0;
+    auto id = scheduler.addTask("taws", 10.0, [&] { runs++; });
+    TickWatchdog watchdog(1s);
+    scheduler.setWatchdog(&watchdog);
+
+    auto start = TaskScheduler::Clock::time_point{} + 1s;
+    for (int i = 0; i < 10; ++i) scheduler.tick(start + i * 100ms);
+    EXPECT_EQ(watchdog.getStats().ticks, 10u);
+    EXPECT_EQ(watchdog.getStats().overruns, 0u);
+    EXPECT_EQ(runs, 10);
+
+    scheduler.setTaskRate(id, 5.0);
+    for (int i = 10; i < 20; ++i) scheduler.tick(start + i * 100ms);
+    EXPECT_EQ(runs, 15);
+    EXPECT_DOUBLE_EQ(scheduler.getStats()[0].rateHz, 5.0);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "../../include/tile_cache.hpp"
+#include <vector>
+
+using namespace AICopilot;
+
+// Test: Packed keys round-trip every SRTM tile coordinate
+TEST(TileCacheTest, PackedKeysRoundTrip) {
+    for (int lat = -90; lat <= 90; lat += 15) {
+        for (int lon = -180; lon <= 180; lon += 30) {
+            TileKey key = packTileKey(lat, lon);
+            EXPECT_EQ(tileKeyLatitude(key), lat);
+            EXPECT_EQ(tileKeyLongitude(key), lon);
+        }
+    }
+    EXPECT_NE(packTileKey(1, 0), packTileKey(0, 1));
+}
+
+// Test: Hits refresh recency so the least recently used tile is evicted
+TEST(TileCacheTest, EvictsLeastRecentlyUsed) {
+    TileCache<int> cache(300);
+    cache.insert(packTileKey(0, 0), std::make_shared<int>(0), 100);
+    cache.insert(packTileKey(0, 1), std::make_shared<int>(1), 100);
+    cache.insert(packTileKey(0, 2), std::make_shared<int>(2), 100);
+
+    ASSERT_NE(cache.find(packTileKey(0, 0)), nullptr);
+    cache.insert(packTileKey(0, 3), std::make_shared<int>(3), 100);
+
+    EXPECT_TRUE(cache.contains(packTileKey(0, 0)));
+    EXPECT_FALSE(cache.contains(packTileKey(0, 1)));
+    EXPECT_TRUE(cache.contains(packTileKey(0, 2)));
+    EXPECT_TRUE(cache.contains(packTileKey(0, 3)));
+
+    std::vector<int> order;
+    cache.forEach([&order](TileKey, const int& tile) { order.push_back(tile); });
+    EXPECT_EQ(order, (std::vector<int>{3, 0, 2}));
+
+    TileCacheStats stats = cache.getStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 0u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.tiles, 3u);
+    EXPECT_EQ(stats.bytes, 300u);
+}
+
+// Test: Capacity is a byte budget, not a tile count
+TEST(TileCacheTest, EnforcesByteBudget) {
+    TileCache<int> cache(250);
+    cache.insert(packTileKey(1, 1), std::make_shared<int>(1), 50);
+    cache.insert(packTileKey(1, 2), std::make_shared<int>(2), 50);
+    cache.insert(packTileKey(1, 3), std::make_shared<int>(3), 200);
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_LE(cache.getBytes(), 250u);
+    EXPECT_FALSE(cache.contains(packTileKey(1, 1)));
+
+    // An oversized tile is kept on its own rather than rejected
+    cache.insert(packTileKey(1, 4), std::make_shared<int>(4), 1000);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_NE(cache.find(packTileKey(1, 4)), nullptr);
+
+    cache.setByteBudget(0);
+    EXPECT_EQ(cache.size(), 1u);
+    cache.insert(packTileKey(1, 5), std::make_shared<int>(5), 10);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.getStats().evictions, 4u);
+}
+
+// Test: Misses are counted and replacing a tile re-charges its bytes
+TEST(TileCacheTest, CountsMissesAndReplaces) {
+    TileCache<int> cache(1000);
+    EXPECT_EQ(cache.find(packTileKey(10, 10)), nullptr);
+
+    cache.insert(packTileKey(10, 10), std::make_shared<int>(1), 100);
+    cache.insert(packTileKey(10, 10), std::make_shared<int>(2), 300);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.getBytes(), 300u);
+    EXPECT_EQ(*cache.find(packTileKey(10, 10)), 2);
+
+    EXPECT_TRUE(cache.erase(packTileKey(10, 10)));
+    EXPECT_FALSE(cache.erase(packTileKey(10, 10)));
+    EXPECT_EQ(cache.getBytes(), 0u);
+
+    TileCacheStats stats = cache.getStats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+}
+
+// Test: Points a few meters apart share a raster cell key; the next post over does not
+TEST(TileCacheTest, RasterCellKeys) {
+    RasterCell a = locateRasterCell(47.45001, -122.30001, 3600);
+    RasterCell b = locateRasterCell(47.45003, -122.30003, 3600);
+    RasterCell c = locateRasterCell(47.45001 - 1.0 / 3600.0, -122.30001, 3600);
+    EXPECT_EQ(a.key(), b.key());
+    EXPECT_NE(a.key(), c.key());
+    EXPECT_EQ(a.tileLatitude, 47);
+    EXPECT_EQ(a.tileLongitude, -123);
+    EXPECT_EQ(c.row, a.row + 1);
+
+    // Edges of the world stay inside the last tile
+    RasterCell pole = locateRasterCell(90.0, 180.0, 100);
+    EXPECT_EQ(pole.tileLatitude, 89);
+    EXPECT_EQ(pole.tileLongitude, 179);
+    EXPECT_EQ(pole.row, 0u);
+    EXPECT_EQ(pole.col, 99u);
+}
+
+// Test: Corner interpolation matches the posts at the corners and blends between them
+TEST(TileCacheTest, CellCornersInterpolate) {
+    CellCorners corners;
+    corners.northWest = 100.0;
+    corners.northEast = 200.0;
+    corners.southWest = 300.0;
+    corners.southEast = 400.0;
+    EXPECT_DOUBLE_EQ(corners.interpolate(0.0, 0.0), 100.0);
+    EXPECT_DOUBLE_EQ(corners.interpolate(0.0, 1.0), 200.0);
+    EXPECT_DOUBLE_EQ(corners.interpolate(1.0, 0.0), 300.0);
+    EXPECT_DOUBLE_EQ(corners.interpolate(0.5, 0.5), 250.0);
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "../../include/tiled_raster_source.hpp"
+#include "../../include/terrain_awareness.h"
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+using namespace AICopilot;
+
+namespace {
+
+// Raster over 40..41N, 105..104W whose pixel centres read lat * 100 + lon feet
+struct FakeRaster {
+    std::vector<RasterLevel> levels;
+    std::shared_ptr<std::atomic<int>> reads = std::make_shared<std::atomic<int>>(0);
+
+    FakeRaster() {
+        // Full resolution 400x400 in 64x64 blocks, one 100x100 overview
+        RasterLevel full;
+        full.width = 400;
+        full.height = 400;
+        full.blockWidth = 64;
+        full.blockHeight = 64;
+        full.originLongitude = -105.0;
+        full.originLatitude = 41.0;
+        full.pixelWidth = 1.0 / 400;
+        full.pixelHeight = -1.0 / 400;
+        RasterLevel overview = full;
+        overview.width = 100;
+        overview.height = 100;
+        overview.pixelWidth = 1.0 / 100;
+        overview.pixelHeight = -1.0 / 100;
+        levels = {full, overview};
+    }
+
+    TiledRasterSource::BlockReader reader() const {
+        auto counter = reads;
+        auto copy = levels;
+        return [counter, copy](size_t level, int blockX, int blockY, float* out) {
+            const RasterLevel& raster = copy[level];
+            counter->fetch_add(1);
+            for (int row = 0; row < raster.blockHeight; ++row) {
+                for (int col = 0; col < raster.blockWidth; ++col) {
+                    double lon = raster.originLongitude + (blockX * raster.blockWidth + col + 0.5) * raster.pixelWidth;
+                    double lat = raster.originLatitude + (blockY * raster.blockHeight + row + 0.5) * raster.pixelHeight;
+                    out[row * raster.blockWidth + col] = static_cast<float>(lat * 100.0 + lon);
+                }
+            }
+            return true;
+        };
+    }
+};
+
+} // namespace
+
+// Test: Lookups read only the blocks they touch and later ones hit the cache
+TEST(TiledRasterSourceTest, ReadsBlocksOnDemand) {
+    FakeRaster fake;
+    TiledRasterSource source(fake.levels, fake.reader());
+    EXPECT_EQ(*fake.reads, 0);
+
+    double elevation = 0.0;
+    ASSERT_TRUE(source.getElevation(40.5, -104.5, 0.0, elevation));
+    EXPECT_NEAR(elevation, 40.5 * 100.0 - 104.5, 0.01);
+    int afterFirst = *fake.reads;
+    EXPECT_GE(afterFirst, 1);
+    EXPECT_LE(afterFirst, 4);
+
+    ASSERT_TRUE(source.getElevation(40.501, -104.501, 0.0, elevation));
+    EXPECT_EQ(*fake.reads, afterFirst);
+    EXPECT_LT(source.getStats().cache.tiles, 49u);  // 7x7 blocks in the raster
+
+    EXPECT_FALSE(source.getElevation(42.0, -104.5, 0.0, elevation));
+    EXPECT_FALSE(source.getElevation(40.5, -106.0, 0.0, elevation));
+}
+
+// Test: Coarse queries are served from the overview
+TEST(TiledRasterSourceTest, SelectsOverviewByResolution) {
+    FakeRaster fake;
+    TiledRasterSource source(fake.levels, fake.reader());
+    EXPECT_EQ(source.selectLevel(0.0), 0u);
+    EXPECT_EQ(source.selectLevel(0.005), 0u);
+    EXPECT_EQ(source.selectLevel(0.01), 1u);
+    EXPECT_EQ(source.selectLevel(1.0), 1u);
+
+    double coarse = 0.0;
+    ASSERT_TRUE(source.getElevation(40.7, -104.7, 0.05, coarse));
+    EXPECT_NEAR(coarse, 40.7 * 100.0 - 104.7, 0.01);
+    EXPECT_EQ(source.getStats().blockReads, 1u);  // one 64x64 overview block, no full-resolution reads
+}
+
+// Test: Prefetched blocks are resident before the first lookup
+TEST(TiledRasterSourceTest, PrefetchLoadsBlocksInBackground) {
+    FakeRaster fake;
+    TiledRasterSource source(fake.levels, fake.reader());
+
+    size_t queued = source.prefetch(40.5, -104.5, 0.1, 0.0);
+    EXPECT_GT(queued, 0u);
+    EXPECT_EQ(source.prefetch(40.5, -104.5, 0.1, 0.0), 0u);  // queued or resident already
+    source.waitIdle();
+
+    TiledRasterStats stats = source.getStats();
+    EXPECT_EQ(stats.pending, 0u);
+    EXPECT_EQ(stats.cache.tiles, queued);
+    int reads = *fake.reads;
+
+    double elevation = 0.0;
+    ASSERT_TRUE(source.getElevation(40.5, -104.5, 0.0, elevation));
+    ASSERT_TRUE(source.getElevation(40.45, -104.55, 0.0, elevation));
+    EXPECT_EQ(*fake.reads, reads);
+    EXPECT_EQ(source.prefetch(40.5, -104.5, 0.1, 0.0), 0u);
+}
+
+// Test: No-data pixels drop out of the interpolation; a failed read is not cached
+TEST(TiledRasterSourceTest, NoDataAndReadFailures) {
+    FakeRaster fake;
+    bool fail = true;
+    TiledRasterSource source(fake.levels, [&fail](size_t, int, int, float* out) {
+        if (fail) return false;
+        out[0] = 500.0f;
+        out[1] = std::nanf("");
+        return true;
+    });
+
+    double elevation = 0.0;
+    EXPECT_FALSE(source.getElevation(40.999, -104.999, 0.0, elevation));
+    EXPECT_GT(source.getStats().readFailures, 0u);
+
+    fail = false;
+    ASSERT_TRUE(source.getElevation(41.0 - 0.5 / 400, -105.0 + 1.0 / 400, 0.0, elevation));
+    EXPECT_DOUBLE_EQ(elevation, 500.0);
+}
+
+// Test: TerrainAwareness uses the raster without any CSV points loaded
+TEST(TiledRasterSourceTest, TerrainAwarenessSamplesRaster) {
+    FakeRaster fake;
+    auto source = std::make_shared<TiledRasterSource>(fake.levels, fake.reader());
+    TerrainAwareness taws;
+    taws.setTerrainRaster(source);
+    ASSERT_TRUE(taws.hasTerrainRaster());
+
+    Position pos{40.5, -104.5, 0.0, 0.0};
+    EXPECT_NEAR(taws.getTerrainElevation(pos), 40.5 * 100.0 - 104.5, 0.01);
+    pos.latitude = 45.0;
+    EXPECT_DOUBLE_EQ(taws.getTerrainElevation(pos), 0.0);
+
+    AircraftState state{};
+    state.position = {40.2, -104.8, 9000.0, 0.0};
+    taws.updateAircraftState(state);
+    source->waitIdle();
+    EXPECT_GT(source->getStats().prefetchQueued, 0u);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "../../include/track_filter.hpp"
+#include "../../include/traffic_system.h"
+#include <cmath>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+// Deterministic noise in [-1, 1]
+struct Noise {
+    unsigned state = 7;
+    double operator()() {
+        state = state * 1103515245u + 12345u;
+        return static_cast<double>((state >> 8) & 0xFFFF) / 32767.5 - 1.0;
+    }
+};
+
+} // namespace
+
+// Test: The ring keeps the newest samples and indexes from the oldest
+TEST(TrackFilterTest, HistoryRingOverwritesOldest) {
+    TrackHistory<4> history;
+    EXPECT_TRUE(history.empty());
+    for (int i = 0; i < 10; ++i) {
+        TrackSample sample;
+        sample.time = i;
+        history.push(sample);
+    }
+    ASSERT_EQ(history.size(), 4u);
+    EXPECT_EQ(history.oldest().time, 6.0);
+    EXPECT_EQ(history.newest().time, 9.0);
+    EXPECT_EQ(history[1].time, 7.0);
+
+    history.clear();
+    EXPECT_TRUE(history.empty());
+}
+
+// Test: Filtered velocity beats finite differences of noisy reports
+TEST(TrackFilterTest, AlphaBetaSmoothsNoisyReports) {
+    AlphaBetaTracker tracker;
+    Noise noise;
+    const double speed = 300.0;  // knots, due north
+    const double interval = 5.0;
+    const double sigma = 0.05;   // nm
+
+    double rawError = 0.0, filteredError = 0.0;
+    double lastNorth = 0.0;
+    for (int k = 0; k < 40; ++k) {
+        double t = k * interval;
+        double north = speed * t / 3600.0 + sigma * noise();
+        double east = sigma * noise();
+        const TrackSample& state = tracker.update(t, north, east, 5000.0, speed, 0.0, 0.0);
+        if (k >= 20) {
+            double raw = (north - lastNorth) / interval * 3600.0;
+            rawError += (raw - speed) * (raw - speed);
+            filteredError += (state.vn - speed) * (state.vn - speed);
+        }
+        lastNorth = north;
+    }
+    EXPECT_LT(filteredError, rawError * 0.25);
+    EXPECT_NEAR(tracker.state().up, 5000.0, 1e-9);
+    EXPECT_EQ(tracker.history().size(), AlphaBetaTracker::HISTORY_SIZE);
+}
+
+// Test: Turn rate follows a steady turn; gaps restart and stale reports are ignored
+TEST(TrackFilterTest, AlphaBetaTurnRateAndGaps) {
+    AlphaBetaTracker tracker;
+    const double speed = 200.0;   // knots
+    const double rate = 3.0;      // degrees per second, right
+    const double radius = speed / 3600.0 / (rate * PI / 180.0);  // nm
+
+    double t = 0.0;
+    for (int k = 0; k < 30; ++k) {
+        t = k * 2.0;
+        double angle = rate * t * PI / 180.0;
+        tracker.update(t, radius * std::sin(angle), radius * (1.0 - std::cos(angle)), 3000.0,
+                       speed, 0.0, 0.0);
+    }
+    EXPECT_NEAR(tracker.turnRate(), rate, 0.3);
+
+    // A report older than the last one changes nothing
+    TrackSample before = tracker.state();
+    tracker.update(t - 1.0, 50.0, 50.0, 0.0, 0.0, 0.0, 0.0);
+    EXPECT_EQ(tracker.state().time, before.time);
+    EXPECT_EQ(tracker.state().north, before.north);
+
+    // After a long gap the track starts over from the new report
+    tracker.update(t + AlphaBetaTracker::MAX_GAP_SECONDS + 1.0, 10.0, 20.0, 4000.0, 100.0, 0.0, 0.0);
+    EXPECT_EQ(tracker.history().size(), 1u);
+    EXPECT_EQ(tracker.state().north, 10.0);
+    EXPECT_EQ(tracker.state().vn, 100.0);
+    EXPECT_EQ(tracker.turnRate(), 0.0);
+}
+
+// Test: Timed traffic updates smooth targets and drop filters with their targets
+TEST(TrackFilterTest, TrafficSystemFiltersTargets) {
+    AircraftState own{};
+    own.position.latitude = 47.0;
+    own.position.longitude = -122.0;
+    TrafficSystem traffic;
+    traffic.updateOwnAircraft(own);
+
+    // Southbound at 240 knots from the north, position noise ~0.05 nm
+    Noise noise;
+    auto sweep = [&](double t) {
+        TrafficTable table;
+        TrafficTable::Sample sample;
+        sample.callsign = "NOISY";
+        sample.latitude = 47.0 + (10.0 - 240.0 * t / 3600.0 + 0.05 * noise()) / 60.0;
+        sample.longitude = -122.0 + 0.05 * noise() / (60.0 * std::cos(47.0 * PI / 180.0));
+        sample.altitude = 3000.0;
+        sample.groundSpeed = 240.0;
+        sample.heading = 180.0;
+        table.upsert(1, sample);
+        traffic.updateTrafficTargets(table, t);
+    };
+
+    for (int k = 0; k < 20; ++k) sweep(k * 5.0);
+    ASSERT_EQ(traffic.getTrafficTargets().size(), 1u);
+    const TrafficTarget& target = traffic.getTrafficTargets()[0];
+    EXPECT_NEAR(target.closureRate, 240.0, 25.0);
+    EXPECT_NEAR(target.groundSpeed, 240.0, 25.0);
+    EXPECT_NEAR(target.range, 10.0 - 240.0 * 95.0 / 3600.0, 0.1);
+    EXPECT_NEAR(target.turnRate, 0.0, 0.5);
+    ASSERT_NE(traffic.getTrackFilter("NOISY"), nullptr);
+
+    traffic.updateTrafficTargets(TrafficTable(), 100.0);
+    EXPECT_EQ(traffic.getTrackFilter("NOISY"), nullptr);
+}
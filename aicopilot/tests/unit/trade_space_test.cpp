@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "../../include/dynamic_flight_planning.hpp"
+#include "../../include/wind_grid.hpp"
+#include <memory>
+
+using namespace AICopilot;
+
+namespace {
+
+PerformanceProfile makeProfile() {
+    PerformanceProfile profile{};
+    profile.cruiseSpeed = 120.0;
+    profile.maxSpeed = 140.0;
+    profile.serviceCeiling = 15000.0;
+    profile.fuelFlow = 10.0;
+    profile.climbRate = 700.0;
+    return profile;
+}
+
+Waypoint makeFix(const std::string& id, double lat, double lon) {
+    Waypoint fix;
+    fix.id = id;
+    fix.position.latitude = lat;
+    fix.position.longitude = lon;
+    return fix;
+}
+
+// Northbound, about 300 NM
+std::vector<Waypoint> makeRoute() {
+    return {makeFix("DEP", 44.0, -122.0), makeFix("A", 46.0, -122.0), makeFix("DEST", 49.0, -122.0)};
+}
+
+} // namespace
+
+// Test: The front is non-dominated, independent of thread count, and objectives pick its ends
+TEST(TradeSpaceTest, ParetoFrontAndObjectives) {
+    DynamicFlightPlanning planning;
+    ASSERT_TRUE(planning.initialize(makeProfile()));
+    WindConditions wind{};
+    wind.layers.push_back({3000.0, 30.0, 0.0});     // headwind low
+    wind.layers.push_back({12000.0, 25.0, 180.0});  // tailwind high
+    planning.updateWinds(wind);
+
+    planning.setThreadPool(std::make_shared<WorkStealingPool>(1));
+    auto serial = planning.optimizeTradeSpace(makeRoute());
+    planning.setThreadPool(std::make_shared<WorkStealingPool>(4));
+    auto parallel = planning.optimizeTradeSpace(makeRoute());
+
+    // 15 levels x 16 speeds, flat plus steps at 6 segment boundaries where the level allows
+    EXPECT_EQ(parallel.candidatesEvaluated, 15u * 16u + (13u + 11u) * 16u * 6u);
+    ASSERT_FALSE(parallel.paretoFront.empty());
+    ASSERT_EQ(parallel.paretoFront.size(), serial.paretoFront.size());
+    for (size_t i = 0; i < parallel.paretoFront.size(); ++i) {
+        EXPECT_DOUBLE_EQ(parallel.paretoFront[i].estimatedTime, serial.paretoFront[i].estimatedTime);
+        EXPECT_DOUBLE_EQ(parallel.paretoFront[i].estimatedFuel, serial.paretoFront[i].estimatedFuel);
+        if (i > 0) {
+            EXPECT_GT(parallel.paretoFront[i].estimatedTime, parallel.paretoFront[i - 1].estimatedTime);
+            EXPECT_LT(parallel.paretoFront[i].estimatedFuel, parallel.paretoFront[i - 1].estimatedFuel);
+        }
+    }
+
+    auto fastest = planning.selectTradeSpacePoint(parallel, OptimizationObjective::TIME_OPTIMIZATION);
+    auto leanest = planning.selectTradeSpacePoint(parallel, OptimizationObjective::FUEL_EFFICIENCY);
+    EXPECT_DOUBLE_EQ(fastest.estimatedTime, parallel.paretoFront.front().estimatedTime);
+    EXPECT_DOUBLE_EQ(leanest.estimatedFuel, parallel.paretoFront.back().estimatedFuel);
+    EXPECT_DOUBLE_EQ(fastest.cruiseSpeed, 120.0);
+    EXPECT_GE(fastest.altitude, 8000.0);  // nearer the tailwind layer
+    EXPECT_LT(leanest.cruiseSpeed, fastest.cruiseSpeed);
+
+    auto level = planning.selectTradeSpacePoint(parallel, OptimizationObjective::COMFORT_OPTIMIZATION);
+    EXPECT_DOUBLE_EQ(level.stepAltitude, level.altitude);
+
+    // The kept front answers the altitude and speed questions
+    auto altitude = planning.calculateOptimalAltitude(300.0, 100.0, wind);
+    auto balanced = planning.selectTradeSpacePoint(parallel, OptimizationObjective::COMBINED);
+    EXPECT_DOUBLE_EQ(altitude.recommendedAltitude, balanced.altitude);
+    EXPECT_DOUBLE_EQ(altitude.optimalCruiseSpeed, balanced.cruiseSpeed);
+    double fuelSpeed = planning.calculateOptimalCruiseSpeed(fastest.altitude, OptimizationObjective::FUEL_EFFICIENCY, wind);
+    double timeSpeed = planning.calculateOptimalCruiseSpeed(fastest.altitude, OptimizationObjective::TIME_OPTIMIZATION, wind);
+    EXPECT_DOUBLE_EQ(timeSpeed, fastest.cruiseSpeed);
+    EXPECT_LE(fuelSpeed, timeSpeed);
+
+    auto empty = planning.optimizeTradeSpace({makeFix("DEP", 44.0, -122.0)});
+    EXPECT_TRUE(empty.paretoFront.empty());
+    EXPECT_DOUBLE_EQ(planning.calculateOptimalCruiseSpeed(5000.0, OptimizationObjective::FUEL_EFFICIENCY, wind), 96.0);
+}
+
+// Test: Over a grid with a tailwind aloft only late in the route, the fastest profile steps up
+TEST(TradeSpaceTest, StepClimbIntoGriddedTailwind) {
+    DynamicFlightPlanning planning;
+    ASSERT_TRUE(planning.initialize(makeProfile()));
+
+    // At 14000 ft a headwind south of 46N and a strong tailwind north of it, calm below
+    auto grid = std::make_shared<WindGrid>();
+    ASSERT_TRUE(grid->configure({44.0, 1.0, 6}, {-123.0, 1.0, 3}, {10000.0, 12000.0, 14000.0}, {0.0, 3600.0, 1}));
+    for (size_t i = 0; i < 6; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            grid->setPoint(i, j, 0, 0, 0.0, 0.0, 0.0);
+            grid->setPoint(i, j, 1, 0, 0.0, 0.0, 0.0);
+            grid->setPoint(i, j, 2, 0, i >= 2 ? 180.0 : 0.0, i >= 2 ? 60.0 : 40.0, 0.0);
+        }
+    }
+    planning.setWindGrid(grid);
+    planning.setThreadPool(std::make_shared<WorkStealingPool>(2));
+
+    auto tradeSpace = planning.optimizeTradeSpace(makeRoute());
+    auto fastest = planning.selectTradeSpacePoint(tradeSpace, OptimizationObjective::TIME_OPTIMIZATION);
+    EXPECT_LE(fastest.altitude, 12000.0);
+    EXPECT_GE(fastest.stepAltitude, 14000.0);
+    EXPECT_GT(fastest.stepDistance, 0.0);
+    EXPECT_GT(tradeSpace.executionTime, 0.0);
+}
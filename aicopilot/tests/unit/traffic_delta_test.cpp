@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "../../include/traffic_delta.hpp"
+#include "../../include/traffic_system.h"
+#include <cmath>
+#include <string>
+
+using namespace AICopilot;
+
+namespace {
+
+TrafficTable::Sample sample(const char* callsign, double lat, double lon, double alt, double heading) {
+    TrafficTable::Sample s;
+    s.callsign = callsign;
+    s.latitude = lat;
+    s.longitude = lon;
+    s.altitude = alt;
+    s.groundSpeed = 250.0;
+    s.heading = heading;
+    s.verticalSpeed = -500.0;
+    s.onGround = false;
+    return s;
+}
+
+void expectSameTraffic(const TrafficTable& sent, const TrafficTable& received) {
+    ASSERT_EQ(sent.size(), received.size());
+    for (size_t row = 0; row < sent.size(); row++) {
+        size_t other = received.find(sent.objectIds()[row]);
+        ASSERT_NE(other, TrafficTable::npos);
+        EXPECT_EQ(received.callsigns()[other], sent.callsigns()[row]);
+        EXPECT_NEAR(received.latitudes()[other], sent.latitudes()[row], 0.6e-5);
+        EXPECT_NEAR(received.longitudes()[other], sent.longitudes()[row], 0.6e-5);
+        EXPECT_NEAR(received.altitudes()[other], sent.altitudes()[row], 0.51);
+        EXPECT_NEAR(received.groundSpeeds()[other], sent.groundSpeeds()[row], 0.051);
+        double headingError = std::fabs(received.headings()[other] - sent.headings()[row]);
+        EXPECT_LT(std::min(headingError, 360.0 - headingError), 0.0051);
+        EXPECT_NEAR(received.verticalSpeeds()[other], sent.verticalSpeeds()[row], 0.51);
+        EXPECT_EQ(received.onGround()[other], sent.onGround()[row]);
+    }
+}
+
+} // namespace
+
+// Test: Frames reproduce the sender's table through moves, joins and leaves,
+// and rows that did not change cost nothing
+TEST(TrafficDeltaTest, RoundTripAndCompactDeltas) {
+    TrafficTable sent;
+    for (uint32_t i = 0; i < 50; i++) {
+        std::string callsign = "FLT" + std::to_string(i);
+        sent.upsert(1000 + i * 7, sample(callsign.c_str(), 40.0 + i * 0.01, -80.0 - i * 0.01, 10000 + i * 100, i * 7.0));
+    }
+
+    TrafficDeltaEncoder encoder;
+    TrafficDeltaDecoder decoder;
+    TrafficTable received;
+    std::vector<uint8_t> frame;
+
+    encoder.encode(sent, frame);
+    EXPECT_EQ(decoder.apply(frame, received), TrafficDeltaStatus::APPLIED);
+    expectSameTraffic(sent, received);
+    size_t keyframeBytes = frame.size();
+
+    // Nothing moved: only the header and two zero counts
+    frame.clear();
+    encoder.encode(sent, frame);
+    EXPECT_LE(frame.size(), 6u);
+    uint64_t revision = received.revision();
+    EXPECT_EQ(decoder.apply(frame, received), TrafficDeltaStatus::APPLIED);
+    EXPECT_EQ(received.revision(), revision);
+
+    // Every aircraft moves a little; heading wraps through north for one
+    std::string callsigns[50];
+    for (uint32_t i = 0; i < 50; i++) {
+        callsigns[i] = "FLT" + std::to_string(i);
+        double heading = i == 3 ? 359.995 : i * 7.0 + 0.5;
+        sent.upsert(1000 + i * 7, sample(callsigns[i].c_str(), 40.0 + i * 0.01 + 0.001,
+                                         -80.0 - i * 0.01, 10000 + i * 100 - 8, heading));
+    }
+    frame.clear();
+    encoder.encode(sent, frame);
+    EXPECT_LT(frame.size(), keyframeBytes / 2);
+    EXPECT_LT(frame.size(), 50u * 12u);
+    EXPECT_EQ(decoder.apply(frame, received), TrafficDeltaStatus::APPLIED);
+    expectSameTraffic(sent, received);
+
+    // Leaves, a join, a landing and a callsign change
+    sent.remove(1000);
+    sent.remove(1000 + 49 * 7);
+    sent.upsert(5, sample("NEW1", 41.0, -81.0, 3000, 90.0));
+    TrafficTable::Sample landed = sample("FLT10", 40.1, -80.1, 650, 70.0);
+    landed.onGround = true;
+    sent.upsert(1000 + 10 * 7, landed);
+    sent.upsert(1000 + 11 * 7, sample("RENAMED", 40.11, -80.11, 11100, 77.5));
+    frame.clear();
+    encoder.encode(sent, frame);
+    EXPECT_EQ(decoder.apply(frame, received), TrafficDeltaStatus::APPLIED);
+    expectSameTraffic(sent, received);
+    EXPECT_EQ(received.find(1000), TrafficTable::npos);
+    EXPECT_EQ(encoder.getTrackedCount(), sent.size());
+
+    // The decoded table drives TCAS like a local sweep
+    AircraftState own{};
+    own.position = {41.0, -81.01, 3000.0, 90.0};
+    own.heading = 90.0;
+    own.groundSpeed = 250.0;
+    TrafficSystem tcas;
+    tcas.updateOwnAircraft(own);
+    tcas.updateTrafficTargets(received);
+    EXPECT_EQ(tcas.getTrafficTargets().size(), received.size());
+    EXPECT_EQ(tcas.getNearestTraffic().callsign, "NEW1");
+}
+
+// Test: A lost frame stops deltas until the next keyframe, and damaged
+// frames leave the table alone
+TEST(TrafficDeltaTest, GapsNeedKeyframeAndCorruptFramesAreRejected) {
+    TrafficTable sent;
+    sent.upsert(1, sample("AAA", 40.0, -80.0, 5000, 10.0));
+    sent.upsert(2, sample("BBB", 40.5, -80.5, 7000, 200.0));
+
+    TrafficDeltaEncoder encoder(0);   // keyframes only on request
+    TrafficDeltaDecoder decoder;
+    TrafficTable received;
+    std::vector<uint8_t> frame;
+
+    encoder.encode(sent, frame);
+    ASSERT_EQ(decoder.apply(frame, received), TrafficDeltaStatus::APPLIED);
+
+    // Frame 2 is lost; frame 3 cannot apply on top of frame 1
+    sent.upsert(1, sample("AAA", 40.01, -80.0, 5100, 10.0));
+    frame.clear();
+    encoder.encode(sent, frame);
+    sent.upsert(2, sample("BBB", 40.51, -80.5, 7000, 200.0));
+    frame.clear();
+    encoder.encode(sent, frame);
+    EXPECT_EQ(decoder.apply(frame, received), TrafficDeltaStatus::NEED_KEYFRAME);
+    EXPECT_TRUE(decoder.needsKeyframe());
+    EXPECT_EQ(decoder.getDroppedFrames(), 1u);
+    EXPECT_NEAR(received.altitudes()[received.find(1)], 5000.0, 1e-9);
+
+    encoder.requestKeyframe();
+    frame.clear();
+    encoder.encode(sent, frame);
+    EXPECT_EQ(decoder.apply(frame, received), TrafficDeltaStatus::APPLIED);
+    EXPECT_FALSE(decoder.needsKeyframe());
+    expectSameTraffic(sent, received);
+
+    // Truncated and bad-version frames are rejected without side effects
+    sent.upsert(3, sample("CCC", 41.0, -79.0, 9000, 300.0));
+    frame.clear();
+    encoder.encode(sent, frame);
+    uint64_t revision = received.revision();
+    for (size_t cut = 0; cut < frame.size(); cut++) {
+        EXPECT_NE(decoder.apply(frame.data(), cut, received), TrafficDeltaStatus::APPLIED);
+    }
+    std::vector<uint8_t> badVersion = frame;
+    badVersion[0] = 99;
+    EXPECT_EQ(decoder.apply(badVersion, received), TrafficDeltaStatus::CORRUPT);
+    EXPECT_EQ(received.revision(), revision);
+
+    EXPECT_EQ(decoder.apply(frame, received), TrafficDeltaStatus::APPLIED);
+    expectSameTraffic(sent, received);
+}
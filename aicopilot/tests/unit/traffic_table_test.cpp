@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+#include "../../include/traffic_table.hpp"
+#include "../../include/traffic_system.h"
+#include "../../include/closest_approach.hpp"
+#include <cmath>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+TrafficTable::Sample makeSample(const char* callsign, double lat, double lon, double alt) {
+    TrafficTable::Sample sample;
+    sample.callsign = callsign;
+    sample.latitude = lat;
+    sample.longitude = lon;
+    sample.altitude = alt;
+    sample.groundSpeed = 250.0;
+    sample.heading = 90.0;
+    return sample;
+}
+
+} // namespace
+
+// Test: Upsert updates an existing row in place instead of appending
+TEST(TrafficTableTest, UpsertUpdatesByObjectId) {
+    TrafficTable table;
+    size_t row = table.upsert(42, makeSample("N123AB", 47.0, -122.0, 5000.0));
+    EXPECT_EQ(table.upsert(42, makeSample("N123AB", 47.1, -122.0, 5200.0)), row);
+
+    ASSERT_EQ(table.size(), 1u);
+    EXPECT_EQ(table.find(42), row);
+    EXPECT_DOUBLE_EQ(table.latitudes()[row], 47.1);
+    EXPECT_DOUBLE_EQ(table.altitudes()[row], 5200.0);
+    EXPECT_EQ(table.callsigns()[row], "N123AB");
+}
+
+// Test: Removal keeps columns dense and the index consistent
+TEST(TrafficTableTest, RemoveSwapsLastRowIntoGap) {
+    TrafficTable table;
+    table.upsert(1, makeSample("A", 1.0, 0.0, 1000.0));
+    table.upsert(2, makeSample("B", 2.0, 0.0, 2000.0));
+    table.upsert(3, makeSample("C", 3.0, 0.0, 3000.0));
+
+    EXPECT_TRUE(table.remove(1));
+    EXPECT_FALSE(table.remove(1));
+    ASSERT_EQ(table.size(), 2u);
+    EXPECT_EQ(table.find(1), TrafficTable::npos);
+
+    size_t row = table.find(3);
+    ASSERT_NE(row, TrafficTable::npos);
+    EXPECT_EQ(table.objectIds()[row], 3u);
+    EXPECT_EQ(table.callsigns()[row], "C");
+    EXPECT_DOUBLE_EQ(table.altitudes()[row], 3000.0);
+}
+
+// Test: Objects not reported in a sweep are dropped at the end of it
+TEST(TrafficTableTest, SweepDropsStaleObjects) {
+    TrafficTable table;
+    table.beginSweep();
+    table.upsert(10, makeSample("A", 1.0, 0.0, 1000.0));
+    table.upsert(20, makeSample("B", 2.0, 0.0, 2000.0));
+    table.upsert(30, makeSample("C", 3.0, 0.0, 3000.0));
+    EXPECT_EQ(table.endSweep(), 0u);
+
+    table.beginSweep();
+    table.upsert(30, makeSample("C", 3.5, 0.0, 3500.0));
+    EXPECT_EQ(table.endSweep(), 2u);
+
+    ASSERT_EQ(table.size(), 1u);
+    EXPECT_EQ(table.find(10), TrafficTable::npos);
+    EXPECT_EQ(table.find(20), TrafficTable::npos);
+    EXPECT_DOUBLE_EQ(table.latitudes()[table.find(30)], 3.5);
+}
+
+// Test: TrafficSystem derives range, bearing and closure from the table
+TEST(TrafficTableTest, TrafficSystemConsumesTable) {
+    AircraftState own{};
+    own.position.latitude = 0.0;
+    own.position.longitude = 0.0;
+    own.position.altitude = 5000.0;
+    own.heading = 90.0;
+    own.groundSpeed = 200.0;
+
+    TrafficSystem traffic;
+    traffic.updateOwnAircraft(own);
+
+    // Two nm due east, same altitude, head-on
+    TrafficTable table;
+    TrafficTable::Sample sample = makeSample("HEADON", 0.0, 2.0 / 60.0, 5300.0);
+    sample.heading = 270.0;
+    sample.groundSpeed = 200.0;
+    table.upsert(7, sample);
+
+    traffic.updateTrafficTargets(table);
+
+    auto targets = traffic.getTrafficTargets();
+    ASSERT_EQ(targets.size(), 1u);
+    EXPECT_EQ(targets[0].callsign, "HEADON");
+    EXPECT_NEAR(targets[0].range, 2.0, 0.01);
+    EXPECT_NEAR(targets[0].bearing, 90.0, 0.1);
+    EXPECT_NEAR(targets[0].relativeAltitude, 300.0, 1e-9);
+    EXPECT_NEAR(targets[0].closureRate, 400.0, 0.1);
+    EXPECT_TRUE(traffic.hasActiveRA());
+}
+
+// Test: The batch closest-approach kernel matches the scalar one and feeds advisories
+TEST(TrafficTableTest, ClosestApproachBatch) {
+    ClosestApproach::Tracks tracks;
+    tracks.resize(200);
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        double k = static_cast<double>(i);
+        tracks.north[i] = std::sin(k * 0.7) * 8.0;
+        tracks.east[i] = std::cos(k * 1.3) * 8.0;
+        tracks.up[i] = std::sin(k * 0.3) * 2000.0;
+        tracks.vn[i] = (i % 7 == 0) ? 0.0 : std::cos(k * 0.9) * 450.0;
+        tracks.ve[i] = (i % 7 == 0) ? 0.0 : std::sin(k * 1.1) * 450.0;
+        tracks.vz[i] = std::cos(k * 0.5) * 1500.0;
+    }
+
+    std::vector<double> time(tracks.size()), distance(tracks.size()), vertical(tracks.size()), tau(tracks.size());
+    ClosestApproach::computeBatch(tracks, time.data(), distance.data(), vertical.data(), tau.data());
+    for (size_t i = 0; i < tracks.size(); ++i) {
+        auto expected = ClosestApproach::compute(tracks.north[i], tracks.east[i], tracks.up[i],
+                                                 tracks.vn[i], tracks.ve[i], tracks.vz[i]);
+        EXPECT_DOUBLE_EQ(time[i], expected.time);
+        EXPECT_DOUBLE_EQ(distance[i], expected.distance);
+        EXPECT_DOUBLE_EQ(vertical[i], expected.verticalSeparation);
+        EXPECT_EQ(std::isinf(tau[i]), std::isinf(expected.tau));
+        if (!std::isinf(tau[i])) {
+            EXPECT_DOUBLE_EQ(tau[i], expected.tau);
+        }
+        EXPECT_GE(time[i], 0.0);
+    }
+
+    // Head-on at 2 nm closing 400 kt: CPA and tau 18 s, no miss distance
+    AircraftState own{};
+    own.position.altitude = 5000.0;
+    own.heading = 90.0;
+    own.groundSpeed = 200.0;
+    TrafficSystem traffic;
+    traffic.updateOwnAircraft(own);
+
+    TrafficTable table;
+    TrafficTable::Sample sample = makeSample("HEADON", 0.0, 2.0 / 60.0, 5300.0);
+    sample.heading = 270.0;
+    sample.groundSpeed = 200.0;
+    table.upsert(7, sample);
+    traffic.updateTrafficTargets(table);
+
+    auto advisories = traffic.getActiveAdvisories();
+    ASSERT_EQ(advisories.size(), 1u);
+    EXPECT_NEAR(advisories[0].timeToClosestApproach, 18.0, 0.01);
+    EXPECT_NEAR(advisories[0].minSeparation, 0.0, 1e-6);
+
+    auto targets = traffic.getTrafficTargets();
+    EXPECT_NEAR(traffic.calculateTimeToClosestApproach(targets[0]), 18.0, 0.05);
+    EXPECT_NEAR(traffic.calculateSeparation(targets[0]), 0.0, 0.01);
+
+    // The AoS overload derives the same tracks
+    traffic.updateTrafficTargets(targets);
+    advisories = traffic.getActiveAdvisories();
+    ASSERT_EQ(advisories.size(), 1u);
+    EXPECT_NEAR(advisories[0].timeToClosestApproach, 18.0, 0.05);
+}
+
+// Test: The dispatched batch kernel (AVX2 where built and supported) matches the portable one bit for bit, tail rows included
+TEST(TrafficTableTest, ClosestApproachKernelsAgree) {
+    for (size_t count : {0u, 1u, 3u, 4u, 7u, 203u}) {
+        ClosestApproach::Tracks tracks;
+        tracks.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            double k = static_cast<double>(i) + 0.5;
+            tracks.north[i] = std::cos(k * 0.4) * 12.0;
+            tracks.east[i] = std::sin(k * 2.1) * 12.0;
+            tracks.up[i] = std::cos(k * 0.8) * 3000.0;
+            tracks.vn[i] = (i % 5 == 0) ? 0.0 : std::sin(k * 0.6) * 500.0;
+            tracks.ve[i] = (i % 5 == 0) ? 0.0 : std::cos(k * 1.7) * 500.0;
+            tracks.vz[i] = std::sin(k * 0.2) * 2500.0;
+        }
+
+        std::vector<double> time(count), distance(count), vertical(count), tau(count);
+        std::vector<double> time2(count), distance2(count), vertical2(count), tau2(count);
+        ClosestApproach::computeBatch(tracks, time.data(), distance.data(), vertical.data(), tau.data());
+        ClosestApproach::computeBatchScalar(tracks, time2.data(), distance2.data(), vertical2.data(), tau2.data());
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(time[i], time2[i]) << ClosestApproach::batchKernel() << " row " << i;
+            EXPECT_EQ(distance[i], distance2[i]) << ClosestApproach::batchKernel() << " row " << i;
+            EXPECT_EQ(vertical[i], vertical2[i]) << ClosestApproach::batchKernel() << " row " << i;
+            EXPECT_EQ(tau[i], tau2[i]) << ClosestApproach::batchKernel() << " row " << i;
+        }
+    }
+}
+
+// Test: Getters return views into a double-buffered frame
+TEST(TrafficTableTest, TrafficSystemViews) {
+    AircraftState own{};
+    own.heading = 0.0;
+    own.groundSpeed = 150.0;
+    TrafficSystem traffic;
+    traffic.updateOwnAircraft(own);
+    EXPECT_EQ(traffic.getGeneration(), 0u);
+
+    TrafficTable table;
+    table.upsert(1, makeSample("NEAR", 2.0 / 60.0, 0.0, 0.0));
+    table.upsert(2, makeSample("MID", 0.0, 8.0 / 60.0, 0.0));
+    table.upsert(3, makeSample("FAR", -20.0 / 60.0, 0.0, 0.0));
+    traffic.updateTrafficTargets(table);
+    EXPECT_EQ(traffic.getGeneration(), 1u);
+
+    const std::vector<TrafficTarget>& first = traffic.getTrafficTargets();
+    ASSERT_EQ(first.size(), 3u);
+
+    // The previous frame survives the next update unchanged
+    table.remove(3);
+    traffic.updateTrafficTargets(table);
+    EXPECT_EQ(traffic.getGeneration(), 2u);
+    EXPECT_EQ(first.size(), 3u);
+    EXPECT_EQ(first[2].callsign, "FAR");
+    EXPECT_EQ(traffic.getTrafficTargets().size(), 2u);
+    EXPECT_NE(&first, &traffic.getTrafficTargets());
+
+    std::vector<std::string> inRange;
+    for (const TrafficTarget& target : traffic.trafficInVicinity(5.0)) {
+        inRange.push_back(target.callsign);
+    }
+    ASSERT_EQ(inRange.size(), 1u);
+    EXPECT_EQ(inRange[0], "NEAR");
+    EXPECT_EQ(traffic.getTrafficInVicinity(10.0).size(), 2u);
+    EXPECT_EQ(traffic.trafficInVicinity(1.0).begin(), traffic.trafficInVicinity(1.0).end());
+
+    // Feeding a frame back in is safe
+    traffic.updateTrafficTargets(first);
+    EXPECT_EQ(traffic.getTrafficTargets().size(), 3u);
+}
+
+// Test: Advisories hold until the target is clearly outside the entry limits
+TEST(TrafficTableTest, AdvisoryHysteresis) {
+    AircraftState own{};
+    own.heading = 0.0;
+    own.groundSpeed = 0.0;
+    TrafficSystem traffic;
+    traffic.updateOwnAircraft(own);
+
+    // Southbound target due north, closing; range in nm
+    auto update = [&](double range, double altitude) {
+        TrafficTable table;
+        TrafficTable::Sample sample = makeSample("INBOUND", range / 60.0, 0.0, altitude);
+        sample.heading = 180.0;
+        sample.groundSpeed = 200.0;
+        table.upsert(1, sample);
+        traffic.updateTrafficTargets(table);
+        const auto& advisories = traffic.getActiveAdvisories();
+        return advisories.empty() ? TrafficAdvisoryType::NONE : advisories[0].type;
+    };
+
+    EXPECT_EQ(update(6.5, 0.0), TrafficAdvisoryType::NONE);
+    EXPECT_EQ(update(5.5, 0.0), TrafficAdvisoryType::TA);
+    EXPECT_EQ(update(6.5, 0.0), TrafficAdvisoryType::TA);
+    EXPECT_EQ(traffic.checkTrafficConflicts().size(), 0u);
+    EXPECT_EQ(update(7.5, 0.0), TrafficAdvisoryType::NONE);
+
+    // RA sense is kept while it holds, even as the geometry flips
+    EXPECT_EQ(update(2.5, 200.0), TrafficAdvisoryType::RA);
+    EXPECT_EQ(traffic.getActiveRA().raDirection, RADirection::DESCEND);
+    EXPECT_EQ(update(3.3, -200.0), TrafficAdvisoryType::RA);
+    EXPECT_EQ(traffic.getActiveRA().raDirection, RADirection::DESCEND);
+    EXPECT_EQ(update(4.0, -200.0), TrafficAdvisoryType::TA);
+}
+
+// Test: RAs against several threats share one sense chosen against all of them
+TEST(TrafficTableTest, MultiThreatSharedSense) {
+    AircraftState own{};
+    own.heading = 0.0;
+    own.groundSpeed = 0.0;
+    TrafficSystem traffic;
+    traffic.updateOwnAircraft(own);
+
+    // Both southbound and closing: one slightly above, one further and below.
+    // Per threat these would be DESCEND and CLIMB; climbing would put own
+    // ship within 50 ft of the upper one at its CPA.
+    TrafficTable table;
+    TrafficTable::Sample above = makeSample("ABOVE", 2.0 / 60.0, 0.0, 400.0);
+    TrafficTable::Sample below = makeSample("BELOW", 2.5 / 60.0, 0.0, -200.0);
+    above.heading = below.heading = 180.0;
+    above.groundSpeed = below.groundSpeed = 400.0;
+    table.upsert(1, above);
+    table.upsert(2, below);
+    traffic.updateTrafficTargets(table);
+
+    const auto& advisories = traffic.getActiveAdvisories();
+    ASSERT_EQ(advisories.size(), 2u);
+    for (const auto& advisory : advisories) {
+        EXPECT_EQ(advisory.type, TrafficAdvisoryType::RA);
+        EXPECT_EQ(advisory.raDirection, RADirection::DESCEND);
+    }
+    for (const auto& advisory : traffic.checkTrafficConflicts()) {
+        EXPECT_EQ(advisory.raDirection, RADirection::DESCEND);
+    }
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "../../include/training_pipeline.hpp"
+#include "../../include/flight_data_recorder.hpp"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace AICopilot;
+using namespace AICopilot::ML;
+
+namespace {
+
+// Climb, cruise and approach at 30 Hz; odd flights bust the approach descent rate.
+// Each test names its own files, so parallel ctest runs do not share them.
+std::string writeFlight(const std::string& test, size_t index) {
+    auto path = (std::filesystem::temp_directory_path() /
+                 ("aicopilot_training_" + test + "_flight" + std::to_string(index) + ".aifr")).string();
+    FlightDataWriter writer(256);
+    EXPECT_TRUE(writer.open(path));
+    const size_t rows = 1800;
+    for (size_t i = 0; i < rows; ++i) {
+        FlightDataSample sample;
+        sample.timestampUs = static_cast<int64_t>(i) * 33333;
+        sample.state.altimeter = 29.92;
+        sample.state.indicatedAirspeed = 100.0 + index;
+        sample.state.trueAirspeed = 110.0 + index;
+        sample.state.groundSpeed = 100.0 + index;
+        sample.state.heading = 10.0 * index;
+        if (i < 600) {
+            sample.phase = FlightPhase::CLIMB;
+            sample.state.verticalSpeed = 700.0;
+            sample.state.position.altitude = 1000.0 + i * 10.0;
+        } else if (i < 1200) {
+            sample.phase = FlightPhase::CRUISE;
+            sample.state.position.altitude = 7000.0;
+            sample.state.bank = i % 300 < 150 ? 15.0 : 0.0;
+        } else {
+            sample.phase = FlightPhase::APPROACH;
+            sample.state.verticalSpeed = index % 2 == 1 && i > 1500 ? -1400.0 : -600.0;
+            sample.state.position.altitude = 7000.0 - (i - 1200) * 10.0;
+        }
+        writer.append(sample);
+    }
+    writer.close();
+    return path;
+}
+
+} // namespace
+
+// Test: Recordings become samples, trained models and a loadable model pack
+TEST(TrainingPipelineTest, TrainsFromRecordings) {
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < 6; ++i) paths.push_back(writeFlight("trains", i));
+
+    TrainingPipelineConfig config;
+    config.threads = 3;
+    TrainingPipeline pipeline(config);
+    auto packPath = (std::filesystem::temp_directory_path() / "aicopilot_training.aimp").string();
+    ASSERT_TRUE(pipeline.run(paths, packPath));
+
+    const TrainingPipelineStats& stats = pipeline.getStats();
+    EXPECT_EQ(stats.flights, 6u);
+    EXPECT_EQ(stats.failed_flights, 0u);
+    EXPECT_EQ(stats.rows_scanned, 6u * 1800u);
+    EXPECT_EQ(stats.samples, 6u * 60u);
+    EXPECT_EQ(stats.decision_examples, 6u * 3u);
+    EXPECT_TRUE(stats.published);
+    EXPECT_EQ(stats.metrics.runway.samples_tested, 360);
+    EXPECT_EQ(pipeline.getModels().getModelVersion(), 1u);
+
+    ModelPack pack;
+    ASSERT_TRUE(pack.open(packPath));
+    EXPECT_EQ(pack.getExampleCount(), 18u);
+    ASSERT_TRUE(pack.hasLearningState());
+    EXPECT_EQ(pack.getLearningState().totalSamples, 360);
+    EXPECT_EQ(pack.getFeatureStatsCount(), FeatureLayout::COUNT);
+    size_t corrections = 0;
+    for (size_t i = 0; i < pack.getExampleCount(); ++i) {
+        if (pack.getExample(i).correctOption == 1) {
+            corrections++;
+            EXPECT_EQ(pack.getExample(i).phase, static_cast<int32_t>(FlightPhase::APPROACH));
+        }
+    }
+    EXPECT_EQ(corrections, 3u);   // the odd flights' approaches
+    pack.close();
+
+    MLDecisionSystem loaded;
+    ASSERT_TRUE(loaded.loadModel(packPath));
+    EXPECT_EQ(loaded.getTrainingDataCount(), 18u);
+
+    std::filesystem::remove(packPath);
+    for (const std::string& path : paths) std::filesystem::remove(path);
+}
+
+// Test: The pack does not depend on the thread count; unreadable flights are skipped
+TEST(TrainingPipelineTest, IsDeterministicAndSkipsBadRecordings) {
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < 5; ++i) paths.push_back(writeFlight("deterministic", 10 + i));
+    paths.insert(paths.begin() + 2, "/nonexistent/flight.aifr");
+
+    std::vector<uint8_t> images[2];
+    size_t threads[2] = {1, 4};
+    for (int run = 0; run < 2; ++run) {
+        TrainingPipelineConfig config;
+        config.threads = threads[run];
+        config.row_stride = 45;
+        TrainingPipeline pipeline(config);
+        ModelPackBuilder builder;
+        ASSERT_TRUE(pipeline.run(paths, builder));
+        EXPECT_EQ(pipeline.getStats().failed_flights, 1u);
+        EXPECT_EQ(pipeline.getStats().samples, 5u * 40u);
+        images[run] = builder.build();
+    }
+    EXPECT_EQ(images[0], images[1]);
+
+    TrainingPipeline pipeline;
+    ModelPackBuilder builder;
+    EXPECT_FALSE(pipeline.run({"/nonexistent/a.aifr", "/nonexistent/b.aifr"}, builder));
+    EXPECT_EQ(pipeline.getStats().failed_flights, 2u);
+    for (const std::string& path : paths) std::filesystem::remove(path);
+}
+
+// Test: Samples are labelled per window from the stability envelope
+TEST(TrainingPipelineTest, LabelsWindowsFromEnvelope) {
+    std::string path = writeFlight("labels", 1);
+    FlightDataReader reader;
+    ASSERT_TRUE(reader.open(path));
+    FlightTrainingData data;
+    ASSERT_TRUE(TrainingPipeline::extractFlight(reader, 100, data));
+    ASSERT_EQ(data.samples.size(), 18u);
+    for (size_t i = 0; i < 18; ++i) {
+        bool unstable = i >= 15;   // rows 1500+ of flight 1 descend at 1400 fpm
+        EXPECT_EQ(data.samples[i].label, unstable ? 0.0 : 1.0) << i;
+    }
+    ASSERT_EQ(data.decisions.size(), 3u);
+    EXPECT_EQ(data.decisions[2].context.phase, FlightPhase::APPROACH);
+    EXPECT_EQ(data.decisions[2].correctOption, 1);
+    EXPECT_DOUBLE_EQ(data.decisions[1].context.state.position.altitude, 7000.0);
+    reader.close();
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "../../include/validation_framework.hpp"
+#include <limits>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+AircraftState makeState() {
+    AircraftState state{};
+    state.position.latitude = 47.45;
+    state.position.longitude = -122.31;
+    state.position.altitude = 5500.0;
+    state.heading = 270.0;
+    state.indicatedAirspeed = 110.0;
+    state.trueAirspeed = 120.0;
+    state.verticalSpeed = 500.0;
+    state.fuelQuantity = 40.0;
+    state.batteryVoltage = 28.0;
+    state.batteryLoad = 20.0;
+    return state;
+}
+
+Waypoint makeWaypoint(const char* id, double lat, double lon) {
+    Waypoint waypoint;
+    waypoint.id = id;
+    waypoint.position.latitude = lat;
+    waypoint.position.longitude = lon;
+    waypoint.altitude = 3000.0;
+    return waypoint;
+}
+
+} // namespace
+
+// Test: Checks carry no strings and describe() gives the validate*() message
+TEST(ValidationFrameworkTest, DescribeMatchesValidate) {
+    ValidationCheck check = CoordinateValidator::checkLatitude(91.5);
+    EXPECT_FALSE(check);
+    EXPECT_EQ(check.id, CheckId::LATITUDE_RANGE);
+    EXPECT_EQ(check.errorCode, ErrorCode::VALIDATION_INVALID_LATITUDE);
+    ValidationResult described = describe(check);
+    ValidationResult validated = CoordinateValidator::validateLatitude(91.5);
+    EXPECT_FALSE(validated.isValid);
+    EXPECT_EQ(described.message, validated.message);
+    EXPECT_EQ(validated.message, "Latitude 91.5 is outside valid range [-90, 90]");
+    EXPECT_EQ(validated.fieldName, "latitude");
+
+    validated = AltitudeValidator::validateAltitude(52000.0);
+    EXPECT_EQ(validated.message, "Altitude 52000 ft exceeds maximum 50000 ft");
+    EXPECT_EQ(validated.errorCode, ErrorCode::VALIDATION_INVALID_ALTITUDE);
+
+    validated = AirspeedValidator::validateIndicatedAirspeed(-3.0);
+    EXPECT_EQ(validated.message, "IAS -3 knots is negative");
+    EXPECT_EQ(validated.fieldName, "indicated_airspeed");
+
+    EXPECT_TRUE(CoordinateValidator::validateCoordinatePair(10.0, 20.0).isValid);
+    EXPECT_EQ(CoordinateValidator::validateCoordinatePair(10.0, 20.0).message, "Valid coordinate pair");
+    EXPECT_TRUE(describe(ValidationCheck()).isValid);
+}
+
+// Test: The release policy skips plausibility limits and keeps hard limits
+TEST(ValidationFrameworkTest, ReleasePolicyDropsTierTwo) {
+    EXPECT_FALSE(AltitudeValidator::checkAltitude<FullValidation>(60000.0));
+    EXPECT_TRUE(AltitudeValidator::checkAltitude<ReleaseValidation>(60000.0));
+    EXPECT_FALSE(AltitudeValidator::checkAltitude<ReleaseValidation>(-10.0));
+    EXPECT_FALSE(AltitudeValidator::checkAltitude<ReleaseValidation>(std::numeric_limits<double>::quiet_NaN()));
+
+    EXPECT_FALSE(AirspeedValidator::checkTrueAirspeed<FullValidation>(700.0));
+    EXPECT_TRUE(AirspeedValidator::checkTrueAirspeed<ReleaseValidation>(700.0));
+    EXPECT_TRUE(AltitudeValidator::checkVerticalSpeed<ReleaseValidation>(6000.0));
+
+    AircraftState state = makeState();
+    state.batteryVoltage = 80.0;
+    EXPECT_EQ(AircraftStateValidator::checkAircraftState<FullValidation>(state).id, CheckId::BATTERY_VOLTAGE);
+    EXPECT_TRUE(AircraftStateValidator::checkAircraftState<ReleaseValidation>(state));
+    state.bank = 200.0;
+    EXPECT_EQ(AircraftStateValidator::checkAircraftState<ReleaseValidation>(state).id, CheckId::BANK_LIMIT);
+}
+
+// Test: Aircraft state checks report the first failure in the original order
+TEST(ValidationFrameworkTest, AircraftStateFirstFailure) {
+    AircraftState state = makeState();
+    EXPECT_TRUE(AircraftStateValidator::checkAircraftState(state));
+    EXPECT_TRUE(AircraftStateValidator::validateAircraftState(state).isValid);
+
+    state.fuelQuantity = -1.0;
+    state.pitch = 95.0;
+    ValidationCheck check = AircraftStateValidator::checkAircraftState(state);
+    EXPECT_EQ(check.id, CheckId::FUEL_NEGATIVE);
+    EXPECT_EQ(check.errorCode, ErrorCode::AIRCRAFT_FUEL_MISMATCH);
+    EXPECT_EQ(describe(check).message, "Fuel quantity cannot be negative");
+
+    state.position.longitude = 200.0;
+    EXPECT_EQ(AircraftStateValidator::checkAircraftState(state).id, CheckId::LONGITUDE_RANGE);
+}
+
+// Test: Sequence failures name the waypoint; close pairs are a tier 2 check
+TEST(ValidationFrameworkTest, WaypointSequence) {
+    std::vector<Waypoint> route = {makeWaypoint("KSEA", 47.45, -122.31), makeWaypoint("KPDX", 45.59, -122.60)};
+    EXPECT_TRUE(WaypointValidator::validateWaypointSequence(route).isValid);
+
+    route.push_back(makeWaypoint("BAD", 95.0, -122.0));
+    ValidationCheck check = WaypointValidator::checkWaypointSequence(route);
+    EXPECT_EQ(check.index, 2u);
+    EXPECT_EQ(check.errorCode, ErrorCode::VALIDATION_INVALID_WAYPOINT_SEQUENCE);
+    ValidationResult result = WaypointValidator::validateWaypointSequence(route);
+    EXPECT_EQ(result.message, "Waypoint 2 (BAD) is invalid: Latitude 95 is outside valid range [-90, 90]");
+
+    route.back() = makeWaypoint("NEAR", 47.4501, -122.3101);
+    check = WaypointValidator::checkWaypointSequence<FullValidation>(route);
+    EXPECT_EQ(check.id, CheckId::SEQUENCE_WAYPOINTS_TOO_CLOSE);
+    EXPECT_EQ(check.index, 0u);
+    EXPECT_EQ(check.other, 2u);
+    EXPECT_EQ(WaypointValidator::validateWaypointSequence(route).fieldName, "waypoint_sequence");
+    EXPECT_TRUE(WaypointValidator::checkWaypointSequence<ReleaseValidation>(route));
+
+    EXPECT_EQ(WaypointValidator::checkWaypointSequence(std::vector<Waypoint>{}).id, CheckId::SEQUENCE_TOO_SHORT);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "../../include/vspeeds.h"
+#include <cmath>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+AircraftConfig c172() {
+    AircraftConfig config{};
+    config.aircraftType = AircraftType::SINGLE_ENGINE_PROP;
+    config.maxGrossWeight = 2450.0;
+    config.emptyWeight = 1686.0;
+    config.stallSpeed = 38.0;
+    config.cruiseSpeed = 120.0;
+    config.maxSpeed = 160.0;
+    return config;
+}
+
+EnvironmentalFactors runway(double elevation, double temperature, double headwind, double length) {
+    EnvironmentalFactors env{};
+    env.temperature = temperature;
+    env.altimeter = 29.92;
+    env.runwayAltitude = elevation;
+    env.windHeadwind = headwind;
+    env.runwayLength = length;
+    env.runwaySurfaceCoeff = 1.0;
+    return env;
+}
+
+WeightBalance loaded(double weight) {
+    WeightBalance wb{};
+    wb.totalWeight = weight;
+    return wb;
+}
+
+} // namespace
+
+// Test: Interpolated points stay within 0.1% of the formulas off the nodes
+TEST(VSpeedTableTest, InterpolationTracksFormulas) {
+    VSpeedCalculator calculator;
+    ASSERT_TRUE(calculator.initialize(c172()));
+    ASSERT_FALSE(calculator.getPerformanceTable().empty());
+
+    const PerformanceTable& table = calculator.getPerformanceTable();
+    for (double weight = 1700.0; weight <= 2700.0; weight += 137.0) {
+        for (double da = -1500.0; da <= 15000.0; da += 1733.0) {
+            for (double temp = -30.0; temp <= 48.0; temp += 7.3) {
+                PerformancePoint exact = calculator.computePerformance(weight, da, temp);
+                PerformancePoint interpolated = table.lookup(weight, da, temp);
+                EXPECT_NEAR(interpolated.correctedStallSpeed, exact.correctedStallSpeed,
+                            exact.correctedStallSpeed * 1e-3);
+                EXPECT_NEAR(interpolated.takeoffDistance, exact.takeoffDistance, exact.takeoffDistance * 1e-3);
+                EXPECT_NEAR(interpolated.landingDistance, exact.landingDistance, exact.landingDistance * 1e-3);
+            }
+        }
+    }
+}
+
+// Test: V-speeds and distances keep their weight and altitude trends
+TEST(VSpeedTableTest, SpeedsAndDistancesFollowConditions) {
+    VSpeedCalculator calculator;
+    ASSERT_TRUE(calculator.initialize(c172()));
+    FlightConfiguration clean{};
+
+    EnvironmentalFactors seaLevel = runway(0.0, 15.0, 0.0, 5000.0);
+    EnvironmentalFactors highHot = runway(5000.0, 35.0, 0.0, 5000.0);
+    VSpeedSet light = calculator.calculateVSpeeds(loaded(2000.0), seaLevel, clean);
+    VSpeedSet heavy = calculator.calculateVSpeeds(loaded(2400.0), seaLevel, clean);
+    VSpeedSet hot = calculator.calculateVSpeeds(loaded(2400.0), highHot, clean);
+    EXPECT_GT(heavy.VS0, light.VS0);
+    EXPECT_GT(hot.VS0, heavy.VS0);
+    EXPECT_NEAR(heavy.VS0, 38.0 * std::sqrt(2400.0 / 2450.0), 0.01);
+    EXPECT_DOUBLE_EQ(heavy.VR, heavy.VS0 * 1.05);
+
+    double seaLevelRoll = calculator.calculateTakeoffDistanceRequired(heavy, loaded(2400.0), seaLevel);
+    double highHotRoll = calculator.calculateTakeoffDistanceRequired(hot, loaded(2400.0), highHot);
+    EXPECT_NEAR(seaLevelRoll, 1500.0 * (2400.0 / 2450.0) * 1.15, 0.5);
+    EXPECT_GT(highHotRoll, seaLevelRoll);
+}
+
+// Test: A batch query agrees with the per-runway calls
+TEST(VSpeedTableTest, BatchRunwayQueryMatchesSingleCalls) {
+    VSpeedCalculator calculator;
+    ASSERT_TRUE(calculator.initialize(c172()));
+    WeightBalance wb = loaded(2300.0);
+
+    std::vector<EnvironmentalFactors> runways = {
+        runway(0.0, 15.0, 10.0, 5000.0),
+        runway(5400.0, 32.0, 0.0, 3000.0),
+        runway(1200.0, -5.0, -5.0, 1800.0),
+        runway(8000.0, 25.0, 5.0, 12000.0),
+    };
+    runways[2].runwaySurfaceCoeff = 0.5;
+
+    std::vector<RunwayPerformance> results(runways.size());
+    calculator.evaluateRunways(wb, runways.data(), runways.size(), results.data());
+
+    FlightConfiguration clean{};
+    for (size_t i = 0; i < runways.size(); ++i) {
+        VSpeedSet speeds = calculator.calculateVSpeeds(wb, runways[i], clean);
+        double takeoff = calculator.calculateTakeoffDistanceRequired(speeds, wb, runways[i]);
+        double landing = calculator.calculateLandingDistanceRequired(speeds, wb, runways[i]);
+        EXPECT_NEAR(results[i].takeoffDistance, takeoff, 1e-9) << i;
+        EXPECT_NEAR(results[i].landingDistance, landing, 1e-9) << i;
+        EXPECT_EQ(results[i].takeoffSuitable, calculator.isRunwaySuitableForTakeoff(runways[i].runwayLength, takeoff)) << i;
+        EXPECT_EQ(results[i].landingSuitable, calculator.isRunwaySuitableForLanding(runways[i].runwayLength, landing)) << i;
+    }
+    EXPECT_TRUE(results[0].takeoffSuitable);
+    EXPECT_FALSE(results[2].takeoffSuitable);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "../../include/waypoint_index.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace AICopilot;
+
+namespace {
+
+double haversineNM(double lat1, double lon1, double lat2, double lon2) {
+    const double rad = 3.14159265358979323846 / 180.0;
+    double sinLat = std::sin((lat2 - lat1) * rad / 2.0);
+    double sinLon = std::sin((lon2 - lon1) * rad / 2.0);
+    double a = sinLat * sinLat + std::cos(lat1 * rad) * std::cos(lat2 * rad) * sinLon * sinLon;
+    return 2.0 * 3440.065 * std::asin(std::sqrt(std::min(1.0, a)));
+}
+
+std::vector<WaypointIndex::Point> randomPoints(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> lat(-89.9, 89.9);
+    std::uniform_real_distribution<double> lon(-180.0, 180.0);
+    std::vector<WaypointIndex::Point> points;
+    for (size_t i = 0; i < count; ++i) {
+        points.push_back({lat(rng), lon(rng), static_cast<uint32_t>(i)});
+    }
+    return points;
+}
+
+std::vector<uint32_t> sortedIds(const std::vector<WaypointIndex::Match>& matches) {
+    std::vector<uint32_t> ids;
+    for (const auto& m : matches) ids.push_back(m.id);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+} // namespace
+
+// Test: Radius queries return exactly the points a brute-force scan finds
+TEST(WaypointIndexTest, RadiusMatchesBruteForce) {
+    auto points = randomPoints(20000, 7);
+    WaypointIndex index;
+    index.build(points);
+    EXPECT_EQ(index.size(), points.size());
+
+    struct Query { double lat, lon, radius; };
+    const Query queries[] = {
+        {40.7, -74.0, 100.0}, {0.0, 0.0, 500.0}, {-33.9, 151.2, 30.0},
+        {10.0, 179.8, 200.0},   // crosses the antimeridian
+        {88.5, 45.0, 300.0},    // covers the pole
+        {-60.0, -10.0, 2000.0},
+    };
+    for (const auto& q : queries) {
+        std::vector<uint32_t> expected;
+        for (const auto& p : points) {
+            if (haversineNM(q.lat, q.lon, p.latitude, p.longitude) <= q.radius) expected.push_back(p.id);
+        }
+        std::vector<WaypointIndex::Match> matches;
+        index.queryRadius(q.lat, q.lon, q.radius, matches);
+        EXPECT_EQ(sortedIds(matches), expected) << q.lat << "," << q.lon << " r=" << q.radius;
+        for (const auto& m : matches) EXPECT_LE(m.distanceNM, q.radius);
+    }
+}
+
+// Test: Nearest-neighbour queries return the k closest points in order
+TEST(WaypointIndexTest, NearestReturnsClosestFirst) {
+    auto points = randomPoints(5000, 11);
+    WaypointIndex index;
+    index.build(points);
+
+    std::vector<std::pair<double, uint32_t>> all;
+    for (const auto& p : points) all.push_back({haversineNM(51.5, -0.1, p.latitude, p.longitude), p.id});
+    std::sort(all.begin(), all.end());
+
+    std::vector<WaypointIndex::Match> nearest;
+    index.queryNearest(51.5, -0.1, 10, nearest);
+    ASSERT_EQ(nearest.size(), 10u);
+    for (size_t i = 0; i < nearest.size(); ++i) {
+        EXPECT_EQ(nearest[i].id, all[i].second);
+        EXPECT_NEAR(nearest[i].distanceNM, all[i].first, 1e-9);
+    }
+
+    // A tight cap limits the answer
+    std::vector<WaypointIndex::Match> capped;
+    index.queryNearest(51.5, -0.1, 10, capped, all[2].first);
+    EXPECT_EQ(capped.size(), 3u);
+}
+
+// Test: Empty indexes and degenerate arguments return nothing
+TEST(WaypointIndexTest, EmptyAndDegenerate) {
+    WaypointIndex index;
+    std::vector<WaypointIndex::Match> out;
+    index.queryRadius(0.0, 0.0, 100.0, out);
+    index.queryNearest(0.0, 0.0, 5, out);
+    EXPECT_TRUE(out.empty());
+
+    index.build({{10.0, 190.0, 1}, {10.0, -170.5, 2}});  // 190 normalizes to -170
+    index.queryRadius(10.0, -170.0, 60.0, out);
+    EXPECT_EQ(sortedIds(out), (std::vector<uint32_t>{1, 2}));
+
+    out.clear();
+    index.queryRadius(10.0, -170.0, -1.0, out);
+    index.queryNearest(10.0, -170.0, 0, out);
+    EXPECT_TRUE(out.empty());
+
+    index.clear();
+    EXPECT_TRUE(index.empty());
+}
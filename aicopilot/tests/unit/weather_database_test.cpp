@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "../../include/weather_database.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace AICopilot;
+
+namespace {
+
+std::string writeFile(const std::string& name, const std::string& contents) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_weather_database";
+    std::filesystem::create_directories(dir);
+    auto path = (dir / name).string();
+    std::ofstream out(path, std::ios::binary);
+    out << contents;
+    return path;
+}
+
+std::string stationName(int index) {
+    std::string name = "K";
+    for (int i = 0; i < 3; ++i) {
+        name += static_cast<char>('A' + index % 26);
+        index /= 26;
+    }
+    return name;
+}
+
+} // namespace
+
+// Test: Parsed reports keep the legacy METARReport fields
+TEST(WeatherDatabaseTest, ParseMETARFillsReport) {
+    WeatherDatabase db;
+    METARReport report = db.parseMETAR("KJFK 121851Z 08012KT 4SM FZRA OVC015 -02/-05 A3015 RMK AO2");
+    ASSERT_TRUE(report.isValid);
+    EXPECT_EQ(report.stationId, "KJFK");
+    EXPECT_EQ(report.visibility, 4);
+    ASSERT_EQ(report.weatherPhenomena.size(), 1u);
+    EXPECT_EQ(report.weatherPhenomena[0], "FZRA");
+    ASSERT_EQ(report.clouds.size(), 1u);
+    EXPECT_EQ(report.clouds[0].coverage, "OVC");
+    EXPECT_EQ(report.ceilingFeet, 1500.0);
+    EXPECT_TRUE(report.precipitation);
+    EXPECT_TRUE(report.icing);
+    ASSERT_EQ(report.remarks.size(), 1u);
+    EXPECT_EQ(report.remarks[0], "AO2");
+
+    report = db.parseMETAR("");
+    EXPECT_FALSE(report.isValid);
+    EXPECT_EQ(report.parseError, "Empty METAR string");
+}
+
+// Test: A NOAA cache CSV ingests in parallel chunks and merges with the cache
+TEST(WeatherDatabaseTest, IngestNoaaCycleFile) {
+    std::string csv = "No errors\nNo warnings\n5 ms\ndata source=metars\n3000 results\n"
+                      "raw_text,station_id,observation_time,latitude,longitude\n";
+    const int stations = 3000;
+    for (int i = 0; i < stations; ++i) {
+        csv += stationName(i) + " 121851Z " + std::to_string(100 + i % 200) +
+               "08KT 10SM FEW250 23/14 A3012 RMK AO2 SLP201," + stationName(i) +
+               ",2024-01-12T18:51:00Z,40.6,-73.7\n";
+    }
+    // A later line for a station replaces the earlier one
+    csv += stationName(7) + " 121856Z 27030G40KT 2SM +TSRA BKN008CB 20/19 A2990,";
+    std::string path = writeFile("metars.cache.csv", csv);
+
+    WeatherDatabase db;
+    db.setThreadPool(std::make_shared<WorkStealingPool>(4));
+    ASSERT_TRUE(db.updateWeather("ZZZZ", "ZZZZ 121800Z 00000KT 10SM SKC 10/05 A2992"));
+
+    WeatherDatabase::IngestResult result = db.ingestMETARFile(path);
+    EXPECT_EQ(result.accepted, stations);
+    EXPECT_EQ(result.rejected, 6);
+    EXPECT_GT(result.chunks, 1u);
+    EXPECT_EQ(result.bytes, csv.size());
+    EXPECT_EQ(db.getCacheSize(), stations + 1);
+
+    METARReport report;
+    ASSERT_TRUE(db.getWeather(stationName(12), report));
+    EXPECT_EQ(report.windDirection, 112);
+    ASSERT_TRUE(db.getWeather(stationName(7), report));
+    EXPECT_EQ(report.windGust, 40);
+    EXPECT_TRUE(report.thunderstorm);
+    EXPECT_TRUE(db.getWeather("ZZZZ", report));
+
+    EXPECT_EQ(db.loadMETARsFromFile(path), stations);
+    EXPECT_EQ(db.ingestMETARFile(path + ".missing").accepted, 0);
+}
+
+// Test: Raw TAFs with continuation lines are stored one per station
+TEST(WeatherDatabaseTest, IngestTafFile) {
+    std::string path = writeFile("tafs.txt",
+        "TAF KJFK 121720Z 1218/1324 31008KT P6SM FEW250\n"
+        "     FM122200 33012KT P6SM SCT250\n"
+        "TAF AMD EGLL 121700Z 1218/1324 24010KT 9999 SCT030\n"
+        "garbage\n");
+
+    WeatherDatabase db;
+    WeatherDatabase::IngestResult result = db.ingestTAFFile(path);
+    EXPECT_EQ(result.accepted, 2);
+    EXPECT_EQ(result.rejected, 1);
+
+    std::string taf;
+    ASSERT_TRUE(db.getTAF("KJFK", taf));
+    EXPECT_EQ(taf, "TAF KJFK 121720Z 1218/1324 31008KT P6SM FEW250 FM122200 33012KT P6SM SCT250");
+    EXPECT_TRUE(db.getTAF("EGLL", taf));
+    EXPECT_FALSE(db.getTAF("KLAX", taf));
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "../../include/weather_interpolator.hpp"
+#include "../../include/weather_database.hpp"
+#include "../../include/weather_system.h"
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr time_t NOW = 1000000;
+
+// Cell centres, so a sample there sits on the station
+constexpr double WEST_LAT = 40.05, WEST_LON = -73.95;
+constexpr double EAST_LAT = 40.05, EAST_LON = -72.95;
+
+struct Field {
+    std::shared_ptr<WeatherStationStore> store = std::make_shared<WeatherStationStore>();
+    WeatherInterpolator interpolator{store};
+
+    Field() {
+        interpolator.setStationPositions({{packStationId("KWST"), WEST_LAT, WEST_LON},
+                                          {packStationId("KEST"), EAST_LAT, EAST_LON},
+                                          {packStationId("KFAR"), 10.0, 10.0}});
+        store->update("", "KWST 121851Z 27010KT 10SM FEW250 10/05 A3000", 60, NOW);
+        store->update("", "KEST 121851Z 27020KT 4SM OVC010 20/15 A2980", 3600, NOW);
+    }
+};
+
+} // namespace
+
+// Test: On a station its report is used as is; between stations they blend by distance
+TEST(WeatherInterpolatorTest, SnapsAndBlends) {
+    Field field;
+    InterpolatedWeather wx;
+    ASSERT_TRUE(field.interpolator.sample(WEST_LAT, WEST_LON, wx, NOW));
+    EXPECT_EQ(wx.stationCount, 1);
+    EXPECT_EQ(wx.nearestStation, packStationId("KWST"));
+    EXPECT_DOUBLE_EQ(wx.conditions.temperature, 10.0);
+    EXPECT_DOUBLE_EQ(wx.altimeterInHg, 30.00);
+
+    ASSERT_TRUE(field.interpolator.sample(40.05, -73.45, wx, NOW));
+    EXPECT_EQ(wx.stationCount, 2);
+    EXPECT_NEAR(wx.conditions.temperature, 15.0, 0.2);
+    EXPECT_NEAR(wx.conditions.windSpeed, 15.0, 0.2);
+    EXPECT_NEAR(wx.conditions.windDirection, 270.0, 0.1);
+    EXPECT_NEAR(wx.altimeterInHg, 29.90, 0.01);
+
+    // Closer to the east station, its weather dominates
+    ASSERT_TRUE(field.interpolator.sample(40.05, -73.15, wx, NOW));
+    EXPECT_GT(wx.conditions.temperature, 18.0);
+    EXPECT_LT(wx.conditions.visibility, 5.0);
+
+    EXPECT_FALSE(field.interpolator.sample(0.0, 0.0, wx, NOW));
+    EXPECT_EQ(wx.stationCount, 0);
+}
+
+// Test: Cached cells refresh on new reports, new positions and expiry
+TEST(WeatherInterpolatorTest, CacheFollowsEpochAndExpiry) {
+    Field field;
+    InterpolatedWeather wx;
+    ASSERT_TRUE(field.interpolator.sample(WEST_LAT, WEST_LON, wx, NOW));
+    ASSERT_TRUE(field.interpolator.sample(WEST_LAT + 0.01, WEST_LON + 0.01, wx, NOW));
+    EXPECT_EQ(field.interpolator.cachedCells(), 1u);
+
+    field.store->update("", "KWST 121951Z 27010KT 10SM FEW250 M05/M10 A3000", 60, NOW);
+    ASSERT_TRUE(field.interpolator.sample(WEST_LAT, WEST_LON, wx, NOW));
+    EXPECT_DOUBLE_EQ(wx.conditions.temperature, -5.0);
+
+    // The west report expires first; the cell then falls back to the east station
+    ASSERT_TRUE(field.interpolator.sample(WEST_LAT, WEST_LON, wx, NOW + 60));
+    EXPECT_EQ(wx.nearestStation, packStationId("KEST"));
+    EXPECT_DOUBLE_EQ(wx.conditions.temperature, 20.0);
+
+    field.interpolator.setStationPositions({{packStationId("KEST"), 0.05, 0.05}});
+    EXPECT_FALSE(field.interpolator.sample(WEST_LAT, WEST_LON, wx, NOW + 60));
+    EXPECT_EQ(field.interpolator.stationCount(), 3u);
+}
+
+// Test: Route sampling covers each leg at the spacing and reuses cells
+TEST(WeatherInterpolatorTest, SamplesRoutes) {
+    Field field;
+    std::vector<Position> route = {{WEST_LAT, WEST_LON, 3000.0, 0.0}, {EAST_LAT, EAST_LON, 9000.0, 0.0}};
+    std::vector<InterpolatedWeather> samples;
+    std::vector<Position> points;
+    // About 46 nm: five 10 nm steps plus the start
+    EXPECT_EQ(field.interpolator.sampleRoute(route, 10.0, samples, &points, NOW), 6u);
+    ASSERT_EQ(samples.size(), 6u);
+    ASSERT_EQ(points.size(), 6u);
+    EXPECT_NEAR(points[3].longitude, -73.35, 0.02);
+    EXPECT_NEAR(points[3].altitude, 6600.0, 1e-6);
+    EXPECT_DOUBLE_EQ(samples.front().conditions.temperature, 10.0);
+    EXPECT_DOUBLE_EQ(samples.back().conditions.temperature, 20.0);
+
+    size_t cells = field.interpolator.cachedCells();
+    field.interpolator.sampleRoute(route, 1.0, samples, nullptr, NOW);
+    EXPECT_GT(samples.size(), 40u);
+    EXPECT_LT(field.interpolator.cachedCells(), cells + 12);
+}
+
+// Test: Database ingest places stations, and WeatherSystem finds hazards along a route
+TEST(WeatherInterpolatorTest, DatabaseAndWeatherSystemUsePositions) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_weather_interpolator";
+    std::filesystem::create_directories(dir);
+    std::string path = (dir / "metars.cache.csv").string();
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "raw_text,station_id,observation_time,latitude,longitude\n"
+            << "KWST 121851Z 27010KT 10SM FEW250 10/05 A3000,KWST,2024-01-12T18:51:00Z,40.05,-73.95\n"
+            << "KTST 121851Z 18035G50KT 1/2SM +TSRA BKN005CB 22/21 A2970,KTST,2024-01-12T18:51:00Z,42.05,-73.95\n";
+    }
+
+    WeatherDatabase db;
+    ASSERT_EQ(db.ingestMETARFile(path).accepted, 2);
+    EXPECT_EQ(db.getInterpolator()->stationCount(), 2u);
+
+    WeatherData wx = db.GetWeatherAtPosition(WEST_LAT, WEST_LON);
+    EXPECT_EQ(wx.icaoCode, "KWST");
+    EXPECT_DOUBLE_EQ(wx.temperatureCelsius, 10.0);
+    wx = db.GetWeatherAtPosition(-40.0, 100.0);
+    EXPECT_EQ(wx.visibilityStatuteMiles, 10.0);
+
+    WeatherSystem weather;
+    Position west{WEST_LAT, WEST_LON, 2000.0, 0.0};
+    Position storm{42.05, -73.95, 2000.0, 0.0};
+    EXPECT_FALSE(weather.hasWeatherHazard(storm, 2000.0));
+    weather.setWeatherInterpolator(db.getInterpolator());
+    EXPECT_TRUE(weather.hasWeatherHazard(storm, 2000.0));
+    EXPECT_FALSE(weather.hasWeatherHazard(west, 2000.0));
+    EXPECT_EQ(weather.getWeatherHazard(storm, 2000.0).type, WeatherHazardType::THUNDERSTORM);
+
+    std::vector<WeatherHazard> hazards = weather.detectHazardsAlongRoute(west, storm, 2000.0);
+    ASSERT_FALSE(hazards.empty());
+    bool lowVisibility = false;
+    for (const WeatherHazard& hazard : hazards) {
+        lowVisibility = lowVisibility || hazard.type == WeatherHazardType::LOW_VISIBILITY;
+        EXPECT_GT(hazard.position.latitude, 40.5);
+    }
+    EXPECT_TRUE(lowVisibility);
+    EXPECT_TRUE(weather.detectHazardsAlongRoute(west, west, 2000.0).empty());
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "../../include/weather_database.hpp"
+#include "../../include/weather_snapshot.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr time_t NOW = 1000000;
+
+std::string tempPath(const std::string& name) {
+    auto dir = std::filesystem::temp_directory_path() / "aicopilot_weather_snapshot";
+    std::filesystem::create_directories(dir);
+    auto path = dir / name;
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+} // namespace
+
+// Test: A snapshot restores every decoded field, position and expiry without parsing
+TEST(WeatherSnapshotTest, RoundTripsStore) {
+    WeatherStationStore store;
+    ASSERT_TRUE(store.update("", "KJFK 121851Z 08012G25KT 1 1/2SM -FZRA BR BKN008CB OVC015 M02/M05 A3015 RMK AO2 TSB05",
+                             3600, NOW));
+    ASSERT_TRUE(store.update("", "KSFO 121856Z VRB03KT CAVOK 18/09 Q1018", 60, NOW));
+    WeatherInterpolator positions(nullptr);
+    positions.setStationPositions({{packStationId("KJFK"), 40.64, -73.78}});
+
+    std::vector<uint8_t> image = WeatherSnapshot::build(store, &positions, NOW);
+    ASSERT_TRUE(WeatherSnapshot::isSnapshot(image.data(), image.size()));
+
+    WeatherSnapshot::Batch batch;
+    std::vector<StationPosition> placed;
+    ASSERT_TRUE(WeatherSnapshot::read(image.data(), image.size(), batch, placed, NOW));
+    ASSERT_EQ(batch.size(), 2u);
+    ASSERT_EQ(placed.size(), 1u);
+    EXPECT_EQ(placed[0].station, packStationId("KJFK"));
+    EXPECT_DOUBLE_EQ(placed[0].longitude, -73.78);
+
+    for (const auto& entry : batch) {
+        WeatherStationStore::Report original;
+        ASSERT_TRUE(store.get(unpackStationId(entry.first), original, NOW));
+        const METARObservation& a = original.observation;
+        const METARObservation& b = entry.second.observation;
+        EXPECT_EQ(entry.second.text, original.text);
+        EXPECT_EQ(entry.second.expiresAt, original.expiresAt);
+        EXPECT_EQ(b.stationId(), a.stationId());
+        EXPECT_EQ(b.windGust, a.windGust);
+        EXPECT_EQ(b.windVariable, a.windVariable);
+        EXPECT_EQ(b.cavok, a.cavok);
+        EXPECT_DOUBLE_EQ(b.visibilitySM, a.visibilitySM);
+        EXPECT_EQ(b.weatherComponents(), a.weatherComponents());
+        EXPECT_EQ(b.cloudCount, a.cloudCount);
+        EXPECT_DOUBLE_EQ(b.ceilingFeet(), a.ceilingFeet());
+        EXPECT_EQ(b.temperature, a.temperature);
+        EXPECT_DOUBLE_EQ(b.altimeterInHg, a.altimeterInHg);
+        EXPECT_EQ(b.remarks(entry.second.text), a.remarks(original.text));
+        EXPECT_EQ(summarizeObservation(b, entry.second.text), original.summary);
+    }
+
+    // Expired reports are left out; a damaged image is refused whole
+    ASSERT_TRUE(WeatherSnapshot::read(image.data(), image.size(), batch, placed, NOW + 60));
+    ASSERT_EQ(batch.size(), 1u);
+    EXPECT_EQ(batch[0].first, packStationId("KJFK"));
+    image[image.size() - 3] ^= 0x20;
+    EXPECT_FALSE(WeatherSnapshot::read(image.data(), image.size(), batch, placed, NOW));
+    EXPECT_TRUE(batch.empty());
+    EXPECT_FALSE(WeatherSnapshot::read(image.data(), sizeof(WeatherSnapshotHeader) - 1, batch, placed, NOW));
+}
+
+// Test: The database restores a snapshot through initialize() and writes them in the background
+TEST(WeatherSnapshotTest, DatabaseWarmRestart) {
+    std::string path = tempPath("weather.snapshot");
+    {
+        WeatherDatabase db;
+        db.startSnapshotWriter(path, 3600);
+        ASSERT_TRUE(db.updateWeather("", "KBOS 121854Z 27015KT 3SM -SN OVC012 M03/M06 A2990"));
+        db.getInterpolator()->setStationPositions({{packStationId("KBOS"), 42.36, -71.01}});
+        // Stopping writes the change the interval hasn't reached yet
+        db.stopSnapshotWriter();
+        EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+    }
+
+    WeatherDatabase restored;
+    ASSERT_TRUE(restored.initialize(path));
+    EXPECT_EQ(restored.getCacheSize(), 1);
+    METARReport report;
+    ASSERT_TRUE(restored.getWeather("KBOS", report));
+    EXPECT_EQ(report.windSpeed, 15);
+    EXPECT_TRUE(restored.HasHazardousConditions("KBOS"));
+    EXPECT_EQ(restored.GetWeatherAtPosition(42.36, -71.01).icaoCode, "KBOS");
+
+    // Text caches still load through initialize()
+    EXPECT_EQ(restored.loadSnapshot(path + ".missing"), -1);
+    std::string text = tempPath("metars.txt");
+    ASSERT_TRUE(restored.saveMETARsToFile(text));
+    EXPECT_EQ(restored.loadSnapshot(text), -1);
+    WeatherDatabase fromText;
+    ASSERT_TRUE(fromText.initialize(text));
+    EXPECT_EQ(fromText.getCacheSize(), 1);
+}
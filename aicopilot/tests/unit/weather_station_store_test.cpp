@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include "../../include/weather_station_store.hpp"
+#include "../../include/weather_database.hpp"
+#include "../../include/weather_system.h"
+#include <string>
+
+using namespace AICopilot;
+
+namespace {
+
+std::string stationName(int index) {
+    std::string name = "K";
+    for (int i = 0; i < 3; ++i) {
+        name += static_cast<char>('A' + index % 26);
+        index /= 26;
+    }
+    return name;
+}
+
+} // namespace
+
+// Test: Identifiers pack into one integer and back; bad ones don't pack
+TEST(WeatherStationStoreTest, PacksStationIds) {
+    static_assert(packStationId("KJFK") == 0x4B4A464Bu, "");
+    EXPECT_EQ(packStationId("kjfk"), packStationId("KJFK"));
+    EXPECT_EQ(unpackStationId(packStationId("EGLL")), "EGLL");
+    EXPECT_EQ(unpackStationId(packStationId("K1W")), "K1W");
+    EXPECT_EQ(packStationId("KJ"), INVALID_STATION);
+    EXPECT_EQ(packStationId("KJFKX"), INVALID_STATION);
+    EXPECT_EQ(packStationId("K-FK"), INVALID_STATION);
+}
+
+// Test: Reports expire per entry; erase and purge keep every other station reachable
+TEST(WeatherStationStoreTest, ExpiresAndErasesInPlace) {
+    WeatherStationStore store;
+    const time_t now = 1000000;
+    const int stations = 2000;
+    for (int i = 0; i < stations; ++i) {
+        std::string metar = stationName(i) + " 121851Z 31008KT 10SM FEW250 18/14 A3012";
+        ASSERT_TRUE(store.update("", metar, i % 2 ? 60 : 3600, now));
+    }
+    EXPECT_EQ(store.size(), static_cast<size_t>(stations));
+
+    const char* error = nullptr;
+    EXPECT_FALSE(store.update("", "KJFK 321851Z 31008KT", 60, now, &error));
+    EXPECT_STREQ(error, "Invalid date/time");
+    EXPECT_FALSE(store.update("K?", "KJFK 121851Z 31008KT", 60, now));
+
+    // Replacing a report keeps one entry per station
+    ASSERT_TRUE(store.update(stationName(4), stationName(4) + " 121856Z 27030G40KT 2SM +TSRA BKN008CB 20/19 A2990",
+                             3600, now));
+    EXPECT_EQ(store.size(), static_cast<size_t>(stations));
+
+    WeatherStationStore::Report report;
+    ASSERT_TRUE(store.get(stationName(4), report, now));
+    EXPECT_EQ(report.observation.windGust, 40);
+    EXPECT_EQ(report.observation.weather[0].text(report.text), "+TSRA");
+    EXPECT_TRUE(store.get(stationName(3), report, now + 59));
+    EXPECT_FALSE(store.get(stationName(3), report, now + 60));
+
+    EXPECT_TRUE(store.erase(stationName(10)));
+    EXPECT_FALSE(store.erase(stationName(10)));
+    EXPECT_EQ(store.purgeExpired(now + 60), static_cast<size_t>(stations / 2));
+    EXPECT_EQ(store.size(), static_cast<size_t>(stations / 2 - 1));
+    for (int i = 0; i < stations; ++i) {
+        EXPECT_EQ(store.get(stationName(i), report, now + 60), i % 2 == 0 && i != 10) << stationName(i);
+    }
+    EXPECT_GT(store.memoryBytes(), 0u);
+
+    store.clear();
+    EXPECT_EQ(store.size(), 0u);
+    EXPECT_FALSE(store.get(stationName(0), report, now));
+}
+
+// Test: Both database APIs and WeatherSystem read the one stored report
+TEST(WeatherStationStoreTest, SharedByDatabaseViewsAndWeatherSystem) {
+    WeatherDatabase db;
+    ASSERT_TRUE(db.UpdateCache("KDEN", "KDEN 121853Z 32030G45KT 3SM -FZRA BKN008 OVC015 M02/M04 A3005 RMK AO2"));
+    ASSERT_TRUE(db.updateWeather("", "KSFO 121856Z 29014G20KT 8SM BKN035 20/12 A2996 RMK AO2"));
+    EXPECT_EQ(db.getCacheSize(), 2);
+    EXPECT_EQ(db.GetCacheEntryCount(), 2);
+    EXPECT_EQ(db.getStationStore()->size(), 2u);
+
+    METARReport report;
+    ASSERT_TRUE(db.getWeather("KDEN", report));
+    EXPECT_EQ(report.ceilingFeet, 800.0);
+    ASSERT_EQ(report.clouds.size(), 2u);
+
+    WeatherData wx = db.GetWeatherAt("KDEN");
+    ASSERT_TRUE(wx.isValid);
+    EXPECT_EQ(wx.wind.directionDegrees, 320);
+    EXPECT_EQ(wx.wind.gustKnots, 45);
+    EXPECT_EQ(wx.ceilingFeet, 800.0);
+    EXPECT_EQ(wx.temperatureCelsius, -2.0);
+    EXPECT_TRUE(wx.hasFreezingRain);
+    EXPECT_EQ(wx.precipitation, PrecipitationType::FREEZING_RAIN);
+    EXPECT_TRUE(db.HasHazardousConditions("KDEN"));
+    EXPECT_EQ(db.GetWindData("KSFO").directionDegrees, 290);
+
+    // Airports without a report fall back to standard-day weather
+    EXPECT_EQ(db.GetVisibility("KXXX"), 10.0);
+
+    WeatherSystem weather;
+    EXPECT_FALSE(weather.updateFromStation("KDEN"));
+    weather.setStationStore(db.getStationStore());
+    ASSERT_TRUE(weather.updateFromStation("KDEN"));
+    WeatherConditions conditions = weather.getCurrentWeather();
+    EXPECT_EQ(conditions.windSpeed, 30.0);
+    EXPECT_EQ(conditions.visibility, 3.0);
+    EXPECT_EQ(conditions.cloudBase, 800.0);
+    EXPECT_TRUE(conditions.icing);
+    EXPECT_TRUE(conditions.precipitation);
+    EXPECT_FALSE(weather.updateFromStation("KXXX"));
+
+    db.ClearCache();
+    EXPECT_FALSE(weather.updateFromStation("KDEN"));
+    EXPECT_EQ(weather.getCurrentWeather().windSpeed, 30.0);
+}
+
+// Test: Stored summaries agree with the per-report checks, and select() filters on them
+TEST(WeatherStationStoreTest, SummariesMatchChecks) {
+    const char* metars[] = {
+        "KAAA 121851Z 31008KT 10SM FEW250 18/14 A3012",
+        "KBBB 121851Z 27030G40KT 2SM +TSRA BKN008CB 20/19 A2990",
+        "KCCC 121851Z 36012KT 1/2SM FZRA OVC003 M02/M03 A2995",
+        "KDDD 121851Z 18005KT 4SM BR BKN020 12/11 A3001",
+        "KEEE 121851Z 09042KT 6SM SCT040 25/10 A2988 RMK CB DSNT W",
+        "KFFF 121851Z 00000KT 10SM SKC A3020",
+    };
+    WeatherDatabase db;
+    for (const char* metar : metars) {
+        ASSERT_TRUE(db.updateWeather("", metar));
+    }
+
+    using namespace StationFlags;
+    for (const char* metar : metars) {
+        std::string icao(metar, 4);
+        StationSummary summary;
+        ASSERT_TRUE(db.getStationSummary(icao, summary));
+        METARReport report;
+        ASSERT_TRUE(db.getWeather(icao, report));
+        WeatherData wx = db.GetWeatherAt(icao);
+        EXPECT_EQ(summary.has(FLIGHT_OK), db.isSuitableForFlight(report)) << icao;
+        EXPECT_EQ(summary.has(TAKEOFF_OK), db.isSuitableForTakeoff(report)) << icao;
+        EXPECT_EQ(summary.has(LANDING_OK), db.isSuitableForLanding(report)) << icao;
+        EXPECT_EQ(summary.has(VFR_OK), wx.isSuitableForVFR()) << icao;
+        EXPECT_EQ(summary.has(IFR_OK), wx.isSuitableForIFR()) << icao;
+        EXPECT_EQ(summary.has(LANDING_MINIMUMS_OK), wx.isSuitableForLanding()) << icao;
+        EXPECT_EQ(static_cast<double>(summary.category), wx.getFlightCategory()) << icao;
+        EXPECT_EQ(summary.has(HAZARDOUS), db.HasHazardousConditions(icao)) << icao;
+        EXPECT_EQ(summary.precipitationType(), wx.precipitation) << icao;
+    }
+
+    StationSummary summary;
+    ASSERT_TRUE(db.getStationSummary("KCCC", summary));
+    EXPECT_EQ(summary.category, FlightCategory::LIFR);
+    EXPECT_EQ(summary.ceilingHundredsFeet, 3);
+    EXPECT_EQ(summary.visibilityQuarterSM, 2);
+    EXPECT_TRUE(summary.has(FREEZING_RAIN | HAZARDOUS));
+    ASSERT_TRUE(db.getStationSummary("KEEE", summary));
+    EXPECT_TRUE(summary.has(THUNDERSTORM));   // from the remarks
+    EXPECT_FALSE(db.getStationSummary("KXXX", summary));
+
+    std::vector<StationKey> stations;
+    EXPECT_EQ(db.selectStations(VFR_OK, 0, stations), 2u);
+    EXPECT_EQ(db.selectStations(LANDING_OK, HAZARDOUS, stations), 3u);
+    for (StationKey key : stations) {
+        std::string icao = unpackStationId(key);
+        EXPECT_TRUE(icao == "KAAA" || icao == "KDDD" || icao == "KFFF") << icao;
+    }
+
+    // Expired and replaced reports drop out of the scan
+    WeatherStationStore& store = *db.getStationStore();
+    ASSERT_TRUE(store.update("KAAA", "KAAA 121951Z 31008KT 1/4SM FG VV001 10/10 A3012", 60, 1000));
+    EXPECT_EQ(store.select(VFR_OK, 0, stations, 1000), 1u);
+    EXPECT_EQ(unpackStationId(stations[0]), "KFFF");
+    EXPECT_EQ(store.select(0, 0, stations, 1060), static_cast<size_t>(5));
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "../../include/weather_subscriptions.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr time_t NOW = 1000000;
+
+struct Feed {
+    std::shared_ptr<WeatherStationStore> store = std::make_shared<WeatherStationStore>();
+    std::shared_ptr<WeatherInterpolator> interpolator = std::make_shared<WeatherInterpolator>(store);
+    WeatherSubscriptions subscriptions{store, interpolator};
+    std::vector<std::vector<WeatherChange>> heard;
+
+    Feed() {
+        interpolator->setStationPositions({{packStationId("KAAA"), 40.0, -74.0},
+                                           {packStationId("KBBB"), 40.0, -73.0},
+                                           {packStationId("KCCC"), 45.0, -73.5}});
+        store->update("", "KAAA 121851Z 27010KT 10SM FEW250 10/05 A3000", 3600, NOW);
+        store->update("", "KBBB 121851Z 27010KT 10SM FEW250 10/05 A3000", 3600, NOW);
+    }
+
+    WeatherChangeCallback record() {
+        return [this](const std::vector<WeatherChange>& changes) { heard.push_back(changes); };
+    }
+};
+
+} // namespace
+
+// Test: Only material changes reach a station subscriber, measured from what it last heard
+TEST(WeatherSubscriptionsTest, StationChangesAreMaterial) {
+    Feed feed;
+    auto id = feed.subscriptions.subscribeStations({"KAAA"}, feed.record(), WeatherChangeThresholds(), NOW);
+    ASSERT_NE(id, WeatherSubscriptions::INVALID_SUBSCRIPTION);
+
+    // Same summary, other station, small wind steps: nothing
+    feed.store->update("", "KAAA 121951Z 27010KT 10SM FEW250 10/05 A3001", 3600, NOW);
+    feed.store->update("", "KBBB 121951Z 27010KT 1/2SM FG OVC002 10/10 A3000", 3600, NOW);
+    feed.store->update("", "KAAA 122051Z 27015KT 10SM FEW250 10/05 A3000", 3600, NOW);
+    EXPECT_TRUE(feed.heard.empty());
+
+    // The drift adds up: 10 kt more than the 10 kt last heard
+    feed.store->update("", "KAAA 122151Z 27020KT 10SM FEW250 10/05 A3000", 3600, NOW);
+    ASSERT_EQ(feed.heard.size(), 1u);
+    ASSERT_EQ(feed.heard[0].size(), 1u);
+    EXPECT_EQ(feed.heard[0][0].station, packStationId("KAAA"));
+    EXPECT_EQ(feed.heard[0][0].reasons, WeatherChangeReason::WIND);
+    EXPECT_EQ(feed.heard[0][0].previous.windKnots, 10);
+    EXPECT_EQ(feed.heard[0][0].current.windKnots, 20);
+
+    feed.store->update("", "KAAA 122251Z 27020KT 2SM BR OVC008 10/09 A3000", 3600, NOW);
+    ASSERT_EQ(feed.heard.size(), 2u);
+    EXPECT_TRUE(feed.heard[1][0].reasons & WeatherChangeReason::CATEGORY);
+    EXPECT_TRUE(feed.heard[1][0].reasons & WeatherChangeReason::FLAGS);
+    EXPECT_EQ(feed.heard[1][0].current.category, FlightCategory::IFR);
+
+    EXPECT_TRUE(feed.store->erase("KAAA"));
+    ASSERT_EQ(feed.heard.size(), 3u);
+    EXPECT_EQ(feed.heard[2][0].reasons, WeatherChangeReason::REMOVED);
+    feed.store->update("", "KAAA 122351Z 27020KT 10SM FEW250 10/05 A3000", 3600, NOW);
+    ASSERT_EQ(feed.heard.size(), 4u);
+    EXPECT_EQ(feed.heard[3][0].reasons, WeatherChangeReason::REPORTED);
+
+    EXPECT_TRUE(feed.subscriptions.unsubscribe(id));
+    feed.store->erase("KAAA");
+    EXPECT_EQ(feed.heard.size(), 4u);
+    EXPECT_EQ(feed.subscriptions.subscribeStations({"??"}, feed.record()),
+              WeatherSubscriptions::INVALID_SUBSCRIPTION);
+}
+
+// Test: Region and corridor scopes place stations by position; a batch arrives in one call
+TEST(WeatherSubscriptionsTest, RegionsAndCorridors) {
+    Feed feed;
+    std::vector<WeatherChange> region, corridor;
+    feed.subscriptions.subscribeRegion(40.0, -74.0, 30.0, [&](const std::vector<WeatherChange>& changes) {
+        region.insert(region.end(), changes.begin(), changes.end());
+    }, WeatherChangeThresholds(), NOW);
+    // West to east just south of the stations, far from KCCC
+    std::vector<Position> route = {{39.9, -75.0, 0.0, 0.0}, {39.9, -72.0, 0.0, 0.0}};
+    feed.subscriptions.subscribeCorridor(route, 10.0, [&](const std::vector<WeatherChange>& changes) {
+        corridor.insert(corridor.end(), changes.begin(), changes.end());
+    }, WeatherChangeThresholds(), NOW);
+    EXPECT_EQ(feed.subscriptions.subscriptionCount(), 2u);
+
+    std::vector<std::pair<StationKey, WeatherStationStore::Report>> batch(3);
+    const char* texts[] = {"KAAA 121951Z 27030KT 10SM FEW250 10/05 A3000",
+                           "KBBB 121951Z 27030KT 10SM FEW250 10/05 A3000",
+                           "KCCC 121951Z 27030KT 10SM FEW250 10/05 A3000"};
+    for (size_t i = 0; i < batch.size(); ++i) {
+        batch[i].second.text = texts[i];
+        ASSERT_TRUE(METARParser::parse(batch[i].second.text, batch[i].second.observation));
+        batch[i].first = packStationId(batch[i].second.observation.stationId());
+        batch[i].second.storedAt = NOW;
+        batch[i].second.expiresAt = NOW + 60;
+    }
+    feed.store->publish(std::move(batch));
+
+    ASSERT_EQ(region.size(), 1u);
+    EXPECT_EQ(region[0].station, packStationId("KAAA"));
+    ASSERT_EQ(corridor.size(), 2u);
+    EXPECT_EQ(corridor[1].station, packStationId("KBBB"));
+    EXPECT_TRUE(corridor[1].reasons & WeatherChangeReason::WIND);
+
+    // Expiry is heard when the reports are purged
+    region.clear();
+    corridor.clear();
+    EXPECT_EQ(feed.store->purgeExpired(NOW + 60), 3u);
+    ASSERT_EQ(region.size(), 1u);
+    EXPECT_EQ(region[0].reasons, WeatherChangeReason::REMOVED);
+    EXPECT_EQ(corridor.size(), 2u);
+
+    WeatherSubscriptions unplaced(feed.store);
+    EXPECT_EQ(unplaced.subscribeRegion(40.0, -74.0, 30.0, feed.record()), WeatherSubscriptions::INVALID_SUBSCRIPTION);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "../../include/weight_balance.h"
+#include <cmath>
+
+using namespace AICopilot;
+
+namespace {
+
+CGEnvelope c172Envelope() {
+    CGEnvelope envelope;
+    envelope.aircraftType = "Cessna 172";
+    envelope.minimumWeight = 1686.0;
+    envelope.maximumWeight = 2450.0;
+    envelope.macLength = 59.7;
+    envelope.macLeadingEdgeLocation = 141.0;
+    envelope.envelopePoints = {{1686.0, 35.8, 40.5}, {2000.0, 35.5, 40.7},
+                               {2200.0, 35.2, 41.0}, {2450.0, 34.8, 41.5}};
+    return envelope;
+}
+
+WeightItem item(const std::string& name, const std::string& category, double weight, double arm) {
+    return WeightItem{name, category, weight, arm, weight * arm, false};
+}
+
+// Arm placing `weight` at `cgPercent` of the C172 MAC
+double armAt(double cgPercent) {
+    return 141.0 + cgPercent / 100.0 * 59.7;
+}
+
+} // namespace
+
+// Test: The bucketed envelope gives the piecewise linear limits
+TEST(WeightBalanceTest, EnvelopeIndexInterpolatesLimits) {
+    CGEnvelopeIndex index;
+    index.build(c172Envelope());
+
+    double forward = 0.0, aft = 0.0;
+    ASSERT_TRUE(index.limits(2100.0, forward, aft));
+    EXPECT_NEAR(forward, 35.35, 1e-9);
+    EXPECT_NEAR(aft, 40.85, 1e-9);
+    ASSERT_TRUE(index.limits(2450.0, forward, aft));
+    EXPECT_NEAR(forward, 34.8, 1e-9);
+    ASSERT_TRUE(index.limits(1500.0, forward, aft));
+    EXPECT_DOUBLE_EQ(forward, 35.8);
+    EXPECT_FALSE(index.limits(2451.0, forward, aft));
+
+    EXPECT_TRUE(index.contains(2200.0, 38.0));
+    EXPECT_FALSE(index.contains(2200.0, 41.1));
+    EXPECT_FALSE(index.contains(2200.0, 35.1));
+}
+
+// Test: Updates by ID keep the running totals equal to a full re-sum
+TEST(WeightBalanceTest, RunningTotalsFollowItemUpdates) {
+    WeightBalanceSystem wb;
+    wb.loadCGEnvelope(c172Envelope());
+    wb.addWeightItem(item("empty", "equipment", 1686.0, armAt(37.0)));
+    WeightItemId pilot = wb.addWeightItem(item("pilot", "crew", 170.0, 37.0 + 141.0));
+    WeightItemId bags = wb.addWeightItem(item("bags", "cargo", 50.0, 95.0 + 141.0));
+    WeightItemId fuel = wb.addWeightItem(item("fuel", "fuel", 240.0, 48.0 + 141.0));
+    EXPECT_EQ(wb.findWeightItem("fuel"), fuel);
+
+    for (int tick = 0; tick < 1000; ++tick) {
+        wb.updateWeightItem(fuel, 240.0 - tick * 0.1);
+    }
+    wb.updateWeightItem("pilot", 190.0);
+    wb.removeWeightItem(bags);
+    wb.updateWeightItem(pilot, 200.0);
+    EXPECT_EQ(wb.findWeightItem("bags"), INVALID_WEIGHT_ITEM);
+
+    double weight = 0.0, moment = 0.0;
+    for (const auto& entry : wb.getWeightItems()) {
+        weight += entry.weight;
+        moment += entry.weight * entry.armDistance;
+    }
+    CGPosition position = wb.getCGPosition();
+    EXPECT_NEAR(position.totalWeight, weight, 1e-6);
+    WeightBalanceResult result = wb.calculateWeightBalance();
+    EXPECT_NEAR(result.totalMoment, moment, 1e-6);
+    EXPECT_NEAR(result.cgLocation, position.cgLocation, 1e-9);
+    EXPECT_EQ(result.withinEnvelope, position.withinEnvelope);
+    EXPECT_EQ(wb.getWeightItems().size(), 3u);
+}
+
+// Test: The burn trajectory finds the CG leaving the envelope ahead of time
+TEST(WeightBalanceTest, FuelBurnTrajectoryFindsExcursion) {
+    WeightBalanceSystem wb;
+    wb.loadCGEnvelope(c172Envelope());
+    // Fuel well forward of an aft loaded cabin: burning it walks the CG aft
+    wb.addWeightItem(item("empty", "equipment", 1700.0, armAt(40.0)));
+    wb.addWeightItem(item("cargo", "cargo", 200.0, armAt(70.0)));
+    wb.addWeightItem(item("left tank", "fuel", 150.0, armAt(0.0)));
+    wb.addWeightItem(item("right tank", "fuel", 150.0, armAt(0.0)));
+
+    CGPosition now = wb.getCGPosition();
+    ASSERT_TRUE(now.withinEnvelope);
+
+    CGTrajectory trajectory = wb.computeFuelBurnTrajectory(60.0, 30);
+    ASSERT_EQ(trajectory.points.size(), 31u);
+    EXPECT_DOUBLE_EQ(trajectory.points.front().fuelRemaining, 300.0);
+    EXPECT_NEAR(trajectory.points.front().cgLocation, now.cgLocation, 1e-9);
+    EXPECT_DOUBLE_EQ(trajectory.points.back().fuelRemaining, 0.0);
+    EXPECT_DOUBLE_EQ(trajectory.points.back().elapsedHours, 5.0);
+    EXPECT_GT(trajectory.points.back().cgLocation, trajectory.points.front().cgLocation);
+
+    const CGTrajectoryPoint* excursion = trajectory.firstExcursion();
+    ASSERT_NE(excursion, nullptr);
+    EXPECT_GT(excursion->fuelRemaining, 0.0);
+    EXPECT_LT(excursion->fuelRemaining, 300.0);
+    // The trajectory doesn't touch the current load
+    EXPECT_NEAR(wb.getCGPosition().cgLocation, now.cgLocation, 1e-12);
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include "../../include/wind_grid.hpp"
+#include "../../include/dynamic_flight_planning.hpp"
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+// Uniform wind per level over a 3 x 3 degree box
+std::shared_ptr<WindGrid> makeLevelGrid(const std::vector<double>& levels, const std::vector<double>& fromDeg,
+                                        const std::vector<double>& speeds) {
+    auto grid = std::make_shared<WindGrid>();
+    WindGrid::Axis lat{44.0, 1.0, 4}, lon{-124.0, 1.0, 4}, time{0.0, 3600.0, 1};
+    grid->configure(lat, lon, levels, time);
+    for (size_t k = 0; k < levels.size(); ++k) {
+        for (size_t i = 0; i < 4; ++i) {
+            for (size_t j = 0; j < 4; ++j) grid->setPoint(i, j, k, 0, fromDeg[k], speeds[k], 0.0);
+        }
+    }
+    return grid;
+}
+
+PerformanceProfile makeProfile() {
+    PerformanceProfile profile{};
+    profile.cruiseSpeed = 120.0;
+    profile.serviceCeiling = 15000.0;
+    profile.fuelFlow = 10.0;
+    profile.climbRate = 700.0;
+    return profile;
+}
+
+Waypoint makeFix(const std::string& id, double lat, double lon) {
+    Waypoint fix;
+    fix.id = id;
+    fix.position.latitude = lat;
+    fix.position.longitude = lon;
+    return fix;
+}
+
+} // namespace
+
+// Test: Values blend linearly along every axis and clamp at the edges
+TEST(WindGridTest, InterpolatesAndClamps) {
+    WindGrid grid;
+    EXPECT_FALSE(grid.configure({0.0, 0.0, 2}, {0.0, 1.0, 2}, {0.0, 10000.0}, {0.0, 60.0, 2}));
+    EXPECT_FALSE(grid.configure({0.0, 1.0, 2}, {0.0, 1.0, 2}, {10000.0, 5000.0}, {0.0, 60.0, 2}));
+    ASSERT_TRUE(grid.configure({40.0, 1.0, 2}, {-80.0, 1.0, 2}, {0.0, 10000.0}, {0.0, 60.0, 2}));
+    EXPECT_NEAR(grid.sample(40.0, -80.0, 10000.0, 0.0).temperatureC, 15.0 - 19.8, 1e-4);  // ISA until set
+
+    // Wind from the west (blowing east) growing along each axis
+    for (size_t i = 0; i < 2; ++i)
+        for (size_t j = 0; j < 2; ++j)
+            for (size_t k = 0; k < 2; ++k)
+                for (size_t t = 0; t < 2; ++t)
+                    grid.setPoint(i, j, k, t, 270.0, 10.0 * i + 20.0 * j + 40.0 * k + 80.0 * t, -5.0 * k);
+    EXPECT_DOUBLE_EQ(grid.getMaxWindSpeed(), 150.0);
+
+    WindGridSample s = grid.sample(40.5, -79.5, 5000.0, 30.0);
+    EXPECT_NEAR(s.eastKts, 75.0, 1e-3);
+    EXPECT_NEAR(s.northKts, 0.0, 1e-3);
+    EXPECT_NEAR(s.temperatureC, -2.5, 1e-4);
+
+    s = grid.sample(40.25, -80.0, 0.0, 0.0);
+    EXPECT_NEAR(s.eastKts, 2.5, 1e-3);
+    s = grid.sample(50.0, -70.0, 40000.0, 1e6);  // beyond every edge
+    EXPECT_NEAR(s.eastKts, 150.0, 1e-3);
+
+    WindGrid flat;
+    ASSERT_TRUE(flat.configure({40.0, 1.0, 1}, {-80.0, 1.0, 1}, {5000.0}, {0.0, 60.0, 1}));
+    flat.setPoint(0, 0, 0, 0, 180.0, 20.0, 3.0);
+    s = flat.sample(10.0, 10.0, 0.0, 0.0);
+    EXPECT_NEAR(s.northKts, 20.0, 1e-4);
+    EXPECT_NEAR(s.temperatureC, 3.0, 1e-6);
+}
+
+// Test: A batch gives the same wind triangle as a scalar evaluation per leg
+TEST(WindGridTest, BatchMatchesScalar) {
+    WindGrid grid;
+    ASSERT_TRUE(grid.configure({30.0, 2.0, 8}, {-120.0, 2.0, 12}, {5000.0, 10000.0, 18000.0, 30000.0, 39000.0},
+                               {0.0, 3600.0, 3}));
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> dir(0.0, 360.0), speed(0.0, 120.0), temp(-60.0, 20.0);
+    for (size_t t = 0; t < 3; ++t)
+        for (size_t k = 0; k < 5; ++k)
+            for (size_t i = 0; i < 8; ++i)
+                for (size_t j = 0; j < 12; ++j) grid.setPoint(i, j, k, t, dir(rng), speed(rng), temp(rng));
+
+    WindGridLegBatch batch;
+    std::uniform_real_distribution<double> lat(29.0, 46.0), lon(-121.0, -97.0), alt(0.0, 41000.0),
+        time(0.0, 8000.0), track(-PI, PI), tas(90.0, 480.0);
+    for (int n = 0; n < 5000; ++n) batch.add(lat(rng), lon(rng), alt(rng), time(rng), track(rng), tas(rng));
+    grid.evaluate(batch);
+    ASSERT_EQ(batch.groundSpeed.size(), batch.size());
+
+    for (size_t n = 0; n < batch.size(); n += 37) {
+        WindGridSample s = grid.sample(batch.latitude[n], batch.longitude[n], batch.altitude[n], batch.time[n]);
+        double along = s.eastKts * std::sin(batch.trackRad[n]) + s.northKts * std::cos(batch.trackRad[n]);
+        double cross = s.eastKts * std::cos(batch.trackRad[n]) - s.northKts * std::sin(batch.trackRad[n]);
+        double tasN = batch.trueAirspeed[n];
+        double expected = std::max(std::sqrt(std::max(tasN * tasN - cross * cross, 0.0)) + along,
+                                   tasN * WindGrid::MIN_GROUND_SPEED_FRACTION);
+        EXPECT_NEAR(batch.groundSpeed[n], expected, 1e-9);
+        EXPECT_NEAR(batch.alongTrackWind[n], along, 1e-9);
+        EXPECT_NEAR(batch.temperatureC[n], s.temperatureC, 1e-9);
+    }
+
+    // Pure head- and crosswinds
+    WindGrid calm;
+    ASSERT_TRUE(calm.configure({0.0, 1.0, 1}, {0.0, 1.0, 1}, {0.0}, {0.0, 1.0, 1}));
+    calm.setPoint(0, 0, 0, 0, 0.0, 30.0, 0.0);  // from the north
+    batch.clear();
+    batch.add(0.0, 0.0, 0.0, 0.0, 0.0, 100.0);       // flying north
+    batch.add(0.0, 0.0, 0.0, 0.0, PI / 2.0, 100.0);  // flying east
+    calm.evaluate(batch);
+    EXPECT_NEAR(batch.groundSpeed[0], 70.0, 1e-4);
+    EXPECT_NEAR(batch.groundSpeed[1], std::sqrt(100.0 * 100.0 - 30.0 * 30.0), 1e-4);
+}
+
+// Test: Flight planning uses the grid for fuel, altitude and step climbs
+TEST(WindGridTest, DrivesFlightPlanning) {
+    DynamicFlightPlanning planning;
+    ASSERT_TRUE(planning.initialize(makeProfile()));
+    std::vector<Waypoint> route = {makeFix("DEP", 45.0, -122.0), makeFix("A", 45.5, -122.0),
+                                   makeFix("DEST", 46.0, -122.0)};
+    auto calm = planning.optimizeRoute(route.front(), route.back(), route, 100.0,
+                                       OptimizationObjective::FUEL_EFFICIENCY);
+
+    // Headwinds low, a strong tailwind (from the south) at 12000 ft
+    auto grid = makeLevelGrid({2000.0, 8000.0, 12000.0}, {0.0, 0.0, 180.0}, {30.0, 20.0, 60.0});
+    EXPECT_GT(planning.setWindGrid(grid), 0u);
+
+    Position here;
+    here.latitude = 45.0;
+    here.longitude = -122.0;
+    EXPECT_DOUBLE_EQ(planning.calculateWindOptimizedAltitude(here, route.back(), 120.0, {}), 12000.0);
+
+    auto step = planning.calculateStepClimbOpportunity(8000.0, 80.0, 150.0);
+    EXPECT_GT(step.newAltitude, 8000.0);
+    EXPECT_GT(step.fuelSavingPerHour, 0.0);
+    EXPECT_TRUE(step.recommended);
+
+    FuelCalculation low = planning.calculateFuelRequirement(route, 8000.0, 120.0, route.back());
+    FuelCalculation high = planning.calculateFuelRequirement(route, 12000.0, 120.0, route.back());
+    EXPECT_LT(high.tripFuel, low.tripFuel);
+
+    // The kept route is priced at 10000 ft, between a headwind and a tailwind layer
+    auto gridded = planning.reoptimizeMidFlight(here, route.back(), 100.0, OptimizationObjective::FUEL_EFFICIENCY);
+    EXPECT_LT(gridded.estimatedTime, calm.estimatedTime);
+
+    planning.setWindGrid(nullptr);
+    auto back = planning.reoptimizeMidFlight(here, route.back(), 100.0, OptimizationObjective::FUEL_EFFICIENCY);
+    EXPECT_NEAR(back.estimatedTime, calm.estimatedTime, 1e-9);
+}
+
+// Test: Batch fuel and descent planning match one-at-a-time calls
+TEST(WindGridTest, BatchAlternatesMatchSingleCalls) {
+    DynamicFlightPlanning planning;
+    ASSERT_TRUE(planning.initialize(makeProfile()));
+    planning.setWindGrid(makeLevelGrid({2000.0, 8000.0, 12000.0}, {0.0, 0.0, 180.0}, {30.0, 20.0, 60.0}));
+    std::vector<Waypoint> route = {makeFix("DEP", 45.0, -122.0), makeFix("A", 45.5, -122.0),
+                                   makeFix("DEST", 46.0, -122.0)};
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<double> offset(-3.0, 3.0);
+    std::vector<Waypoint> alternates;
+    for (int i = 0; i < 50; ++i) {
+        alternates.push_back(makeFix("ALT" + std::to_string(i), 46.0 + offset(rng), -122.0 + offset(rng)));
+    }
+
+    std::vector<FuelCalculation> batch = planning.calculateFuelRequirements(route, 8000.0, 120.0, alternates);
+    ASSERT_EQ(batch.size(), alternates.size());
+    const double fuel = 18.0;
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < alternates.size(); ++i) {
+        FuelCalculation single = planning.calculateFuelRequirement(route, 8000.0, 120.0, alternates[i]);
+        EXPECT_DOUBLE_EQ(batch[i].tripFuel, single.tripFuel);
+        EXPECT_DOUBLE_EQ(batch[i].alternateReserve, single.alternateReserve);
+        EXPECT_DOUBLE_EQ(batch[i].totalFuel, single.totalFuel);
+        EXPECT_DOUBLE_EQ(batch[i].rangeAvailable, single.rangeAvailable);
+        if (planning.checkFuelFeasibility(route, fuel, 8000.0, 120.0, alternates[i])) expected.push_back(i);
+    }
+    std::vector<size_t> feasible = planning.findFeasibleAlternates(route, fuel, 8000.0, 120.0, alternates);
+    EXPECT_EQ(feasible, expected);
+    EXPECT_FALSE(feasible.empty());
+    EXPECT_LT(feasible.size(), alternates.size());
+    EXPECT_TRUE(planning.calculateFuelRequirements(route, 8000.0, 120.0, {}).empty());
+
+    // An empty route needs only the reserves
+    FuelCalculation none = planning.calculateFuelRequirements({}, 8000.0, 120.0, {alternates[0]})[0];
+    EXPECT_EQ(none.tripFuel, 0.0);
+    EXPECT_EQ(none.alternateReserve, 0.0);
+
+    WindConditions wind{};
+    std::vector<double> targets = {1500.0, 3000.0, 6000.0};
+    auto profiles = planning.calculateOptimalDescentProfiles(9000.0, 120.0, targets, wind);
+    ASSERT_EQ(profiles.size(), targets.size());
+    for (size_t i = 0; i < targets.size(); ++i) {
+        auto single = planning.calculateOptimalDescentProfile(9000.0, 120.0, targets[i], 30.0, wind);
+        EXPECT_DOUBLE_EQ(profiles[i].top_of_descent_distance, single.top_of_descent_distance);
+        EXPECT_DOUBLE_EQ(profiles[i].targetSpeed, single.targetSpeed);
+        ASSERT_EQ(profiles[i].descentPath.size(), single.descentPath.size());
+        EXPECT_DOUBLE_EQ(profiles[i].descentPath.back().position.altitude, targets[i]);
+    }
+}
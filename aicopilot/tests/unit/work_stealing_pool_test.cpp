@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "../../include/work_stealing_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace AICopilot;
+using namespace std::chrono_literals;
+
+// Test: Every submitted job runs before wait() returns
+TEST(WorkStealingPoolTest, RunsAllJobs) {
+    WorkStealingPool pool(4);
+    std::atomic<int> count{0};
+    for (int frame = 0; frame < 10; ++frame) {
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&count] { count++; });
+        }
+        pool.wait();
+        EXPECT_EQ(count, (frame + 1) * 100);
+    }
+}
+
+// Test: Idle workers steal queued jobs from a busy worker
+TEST(WorkStealingPoolTest, IdleWorkersStealFromBusyOnes) {
+    WorkStealingPool pool(2);
+    std::atomic<bool> release{false};
+    std::atomic<bool> blocked{false};
+    std::atomic<int> done{0};
+
+    // Job 0 lands on worker 0 and blocks it before the rest are queued, so
+    // worker 0 cannot drain its own deque first; the rest alternate between
+    // the two deques
+    pool.submit([&] {
+        blocked = true;
+        while (!release) std::this_thread::sleep_for(1ms);
+        done++;
+    });
+    while (!blocked) std::this_thread::sleep_for(1ms);
+    for (int i = 0; i < 9; ++i) {
+        pool.submit([&done] { done++; });
+    }
+
+    // Worker 1 must drain worker 0's queued jobs as well as its own
+    auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (done < 9 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    EXPECT_EQ(done, 9);
+    EXPECT_GT(pool.getStealCount(), 0u);
+
+    release = true;
+    pool.wait();
+    EXPECT_EQ(done, 10);
+}
+
+// Test: A throwing job does not take down the pool
+TEST(WorkStealingPoolTest, SurvivesThrowingJob) {
+    WorkStealingPool pool(1);
+    std::atomic<int> count{0};
+    pool.submit([] { throw std::runtime_error("scenario failed"); });
+    pool.submit([&count] { count++; });
+    pool.wait();
+    EXPECT_EQ(count, 1);
+}
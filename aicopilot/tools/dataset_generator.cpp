@@ -0,0 +1,461 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Generates seeded, production-scale synthetic datasets in the project's
+* own formats, so benchmarks and scale tests can run without licensed data:
+*   navdata.anp    navdata pack: airports, navaids, fixes and airways
+*   runways.arp    runway pack for the same airports
+*   srtm/<tile>.hgt  SRTM3 tiles
+*   traffic.csv    one dense traffic scene
+*
+* Usage: dataset_generator <output-dir> [--seed N] [--fixes N]
+*                          [--airway-segments N] [--airports N] [--tiles N]
+*                          [--traffic N]
+*   Defaults are worldwide scale: 300,000 fixes, 50,000 airway segments,
+*   20,000 airports, 16 tiles and 5,000 traffic targets.
+*
+* Feed the outputs to aicopilot_bench (--navdata, --runways, --srtm),
+* host_scaling_benchmark and traffic_benchmark (--scene). The same seed
+* always produces the same files.
+*****************************************************************************/
+
+#include "navdata_pack.hpp"
+#include "runway_pack.hpp"
+#include "srtm_loader.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr double GEN_PI = 3.14159265358979323846;
+constexpr double MIN_LAT = -56.0, MAX_LAT = 72.0;
+
+// Traffic and terrain are placed around Seattle, the traffic_benchmark default
+constexpr double SCENE_LAT = 47.45, SCENE_LON = -122.31;
+constexpr int TERRAIN_SOUTH = 46, TERRAIN_WEST = -124;
+
+struct Options {
+    std::string output;
+    uint32_t seed = 20250101;
+    size_t fixes = 300000;
+    size_t airwaySegments = 50000;
+    size_t airports = 20000;
+    size_t tiles = 16;
+    size_t traffic = 5000;
+};
+
+// Where the world's navdata is dense; the rest is spread evenly
+struct Region {
+    double lat, lon, sigmaDeg, weight;
+};
+const Region REGIONS[] = {
+    {39.0, -96.0, 9.0, 0.28},    // North America
+    {49.0, 10.0, 7.0, 0.24},     // Europe
+    {33.0, 116.0, 9.0, 0.14},    // East Asia
+    {22.0, 79.0, 6.0, 0.05},     // India
+    {28.0, 48.0, 6.0, 0.04},     // Middle East
+    {-15.0, -50.0, 9.0, 0.06},   // South America
+    {-28.0, 140.0, 9.0, 0.04},   // Australia
+    {5.0, 20.0, 14.0, 0.05},     // Africa
+    {58.0, -115.0, 12.0, 0.04},  // Canada and Alaska
+};
+constexpr double UNIFORM_WEIGHT = 0.06;
+
+struct GeoPoint {
+    double lat, lon;
+};
+
+double wrapLongitude(double lon) {
+    while (lon >= 180.0) lon -= 360.0;
+    while (lon < -180.0) lon += 360.0;
+    return lon;
+}
+
+GeoPoint samplePoint(std::mt19937& rng) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double pick = unit(rng);   // the region weights and UNIFORM_WEIGHT sum to one
+    for (const Region& region : REGIONS) {
+        if (pick < region.weight) {
+            std::normal_distribution<double> lat(region.lat, region.sigmaDeg);
+            std::normal_distribution<double> lon(region.lon, region.sigmaDeg * 1.4);
+            return {std::clamp(lat(rng), MIN_LAT, MAX_LAT), wrapLongitude(lon(rng))};
+        }
+        pick -= region.weight;
+    }
+    return {MIN_LAT + unit(rng) * (MAX_LAT - MIN_LAT), -180.0 + unit(rng) * 360.0};
+}
+
+// Fixed-length base-26 identifier: index 0 is "AAAAA" for length 5
+std::string letters(size_t index, int length) {
+    std::string name(static_cast<size_t>(length), 'A');
+    for (int i = length - 1; i >= 0; --i) {
+        name[static_cast<size_t>(i)] = static_cast<char>('A' + index % 26);
+        index /= 26;
+    }
+    return name;
+}
+
+// One-degree buckets for nearest-fix searches while chaining airways
+class FixGrid {
+public:
+    explicit FixGrid(const std::vector<NavdataWaypoint>& fixes) : fixes_(fixes) {
+        for (uint32_t i = 0; i < fixes.size(); ++i) {
+            cells_[key(cellOf(fixes[i].latitude), cellOf(fixes[i].longitude))].push_back(i);
+        }
+    }
+
+    // Nearest fix to (lat, lon) within maxNm, or -1
+    int64_t nearest(double lat, double lon, double maxNm, const std::vector<uint32_t>& exclude) const {
+        int row = cellOf(lat), col = cellOf(lon);
+        int64_t best = -1;
+        double bestNm = maxNm;
+        for (int dr = -1; dr <= 1; ++dr) {
+            for (int dc = -1; dc <= 1; ++dc) {
+                auto it = cells_.find(key(row + dr, wrapCell(col + dc)));
+                if (it == cells_.end()) continue;
+                for (uint32_t index : it->second) {
+                    double nm = distanceNm(lat, lon, fixes_[index].latitude, fixes_[index].longitude);
+                    if (nm < bestNm && std::find(exclude.begin(), exclude.end(), index) == exclude.end()) {
+                        bestNm = nm;
+                        best = index;
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+    static double distanceNm(double lat1, double lon1, double lat2, double lon2) {
+        double dLat = lat2 - lat1;
+        double dLon = wrapLongitude(lon2 - lon1) * std::cos((lat1 + lat2) * 0.5 * GEN_PI / 180.0);
+        return 60.0 * std::sqrt(dLat * dLat + dLon * dLon);
+    }
+
+private:
+    static int cellOf(double degrees) { return static_cast<int>(std::floor(degrees)); }
+    static int wrapCell(int col) { return col >= 180 ? col - 360 : col < -180 ? col + 360 : col; }
+    static int64_t key(int row, int col) { return static_cast<int64_t>(row) * 1000 + col; }
+
+    const std::vector<NavdataWaypoint>& fixes_;
+    std::unordered_map<int64_t, std::vector<uint32_t>> cells_;
+};
+
+struct GeneratedAirport {
+    std::string icao;
+    GeoPoint position;
+    int elevation;
+    int runways;        // physical runways, each with two ends
+    bool major;
+};
+
+std::vector<GeneratedAirport> makeAirports(const Options& options, std::mt19937& rng) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<GeneratedAirport> airports;
+    airports.reserve(options.airports);
+    for (size_t i = 0; i < options.airports; ++i) {
+        GeneratedAirport airport;
+        airport.icao = letters(i, 4);
+        airport.position = samplePoint(rng);
+        airport.elevation = static_cast<int>(std::pow(unit(rng), 3.0) * 8000.0);
+        airport.major = unit(rng) < 0.1;
+        airport.runways = airport.major ? 2 + static_cast<int>(unit(rng) * 3.0) : 1 + (unit(rng) < 0.3 ? 1 : 0);
+        airports.push_back(airport);
+    }
+    return airports;
+}
+
+// Airports, VOR/NDB navaids (one per twenty fixes), fixes, then airways
+// chained from fix to nearby fix until the segment budget is spent
+size_t writeNavdata(const Options& options, const std::vector<GeneratedAirport>& airports,
+                    std::mt19937& rng, const std::string& path) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    NavdataPackBuilder builder;
+    builder.setAiracCycle(2501);
+
+    for (const GeneratedAirport& airport : airports) {
+        builder.putWaypoint(NavdataWaypoint(airport.icao, airport.position.lat, airport.position.lon,
+                                            NavaidType::AIRPORT, airport.elevation));
+    }
+
+    size_t navaids = std::min<size_t>(options.fixes / 20, 26 * 26 * 26);
+    for (size_t i = 0; i < navaids; ++i) {
+        GeoPoint p = samplePoint(rng);
+        bool vor = unit(rng) < 0.6;
+        double frequency = vor ? 108.0 + 0.05 * static_cast<int>(unit(rng) * 200.0) : 190.0 + static_cast<int>(unit(rng) * 345.0);
+        builder.putWaypoint(NavdataWaypoint(letters(i, 3), p.lat, p.lon,
+                                            vor ? NavaidType::VOR : NavaidType::NDB, 0.0, frequency));
+    }
+
+    std::vector<NavdataWaypoint> fixes;
+    fixes.reserve(options.fixes);
+    for (size_t i = 0; i < options.fixes; ++i) {
+        GeoPoint p = samplePoint(rng);
+        fixes.emplace_back(letters(i, 5), p.lat, p.lon, NavaidType::FIX);
+        builder.putWaypoint(fixes.back());
+    }
+
+    FixGrid grid(fixes);
+    size_t segments = 0;
+    size_t airwayCount = 0;
+    std::uniform_int_distribution<size_t> anyFix(0, fixes.empty() ? 0 : fixes.size() - 1);
+    size_t attempts = 0;
+    while (!fixes.empty() && segments < options.airwaySegments && attempts < options.airwaySegments * 4) {
+        attempts++;
+        bool high = airwayCount % 2 == 0;
+        std::vector<uint32_t> chain{static_cast<uint32_t>(anyFix(rng))};
+        double heading = unit(rng) * 360.0;
+        size_t length = 6 + static_cast<size_t>(unit(rng) * 30.0);
+        while (chain.size() < length) {
+            const NavdataWaypoint& from = fixes[chain.back()];
+            double legNm = high ? 60.0 + unit(rng) * 80.0 : 25.0 + unit(rng) * 35.0;
+            double h = heading * GEN_PI / 180.0;
+            double lat = from.latitude + legNm / 60.0 * std::cos(h);
+            double lon = wrapLongitude(from.longitude + legNm / 60.0 * std::sin(h) /
+                                       std::max(0.2, std::cos(from.latitude * GEN_PI / 180.0)));
+            if (lat < MIN_LAT || lat > MAX_LAT) break;
+            int64_t next = grid.nearest(lat, lon, legNm * 0.6, chain);
+            if (next < 0) break;
+            chain.push_back(static_cast<uint32_t>(next));
+            heading += (unit(rng) - 0.5) * 20.0;
+        }
+        if (chain.size() < 2) continue;
+
+        std::string prefix = high ? (airwayCount % 4 == 0 ? "J" : "UL") : (airwayCount % 4 == 1 ? "V" : "A");
+        Airway airway(prefix + std::to_string(airwayCount + 1), high ? 18000 : 1200, high ? 45000 : 17999,
+                      high ? AirwayLevel::HIGH : AirwayLevel::LOW);
+        for (uint32_t index : chain) airway.waypointSequence.push_back(fixes[index].name);
+        builder.putAirway(airway);
+        segments += chain.size() - 1;
+        airwayCount++;
+    }
+
+    if (!builder.write(path)) {
+        std::cerr << "Could not write " << path << std::endl;
+        return 0;
+    }
+    std::cout << "navdata: " << builder.getWaypointCount() << " waypoints, " << builder.getAirwayCount()
+              << " airways, " << segments << " segments -> " << path << std::endl;
+    return segments;
+}
+
+bool writeRunways(const std::vector<GeneratedAirport>& airports, std::mt19937& rng, const std::string& path) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    RunwayPackBuilder builder;
+    for (const GeneratedAirport& generated : airports) {
+        RunwayAirportInfo airport;
+        airport.icao = generated.icao;
+        airport.name = "Synthetic " + generated.icao;
+        airport.latitude = generated.position.lat;
+        airport.longitude = generated.position.lon;
+        airport.elevation = generated.elevation;
+        airport.hasMajorILS = generated.major;
+        airport.runwayCount = generated.runways * 2;
+
+        int baseHeading = 10 * (1 + static_cast<int>(unit(rng) * 18.0));   // 10..180
+        for (int r = 0; r < generated.runways; ++r) {
+            // Parallel pairs share a heading; others are crosswind runways
+            bool parallel = generated.runways >= 2 && r < 2;
+            int heading = parallel ? baseHeading : (baseHeading + 60 * r) % 180;
+            if (heading == 0) heading = 180;
+            int length = generated.major ? 8000 + static_cast<int>(unit(rng) * 5000.0)
+                                         : 2500 + static_cast<int>(unit(rng) * 5000.0);
+            for (int end = 0; end < 2; ++end) {
+                int endHeading = end == 0 ? heading : heading + 180;
+                if (endHeading > 360) endHeading -= 360;
+                char id[16];
+                const char* side = !parallel ? "" : (r == 0) == (end == 0) ? "L" : "R";
+                std::snprintf(id, sizeof(id), "%02d%s", endHeading / 10, side);
+
+                RunwayInfo runway;
+                runway.icao = generated.icao;
+                runway.runwayId = id;
+                runway.latitude = generated.position.lat + (unit(rng) - 0.5) * 0.02;
+                runway.longitude = generated.position.lon + (unit(rng) - 0.5) * 0.02;
+                runway.elevation = generated.elevation;
+                runway.headingMagnetic = endHeading;
+                runway.headingTrue = endHeading;
+                runway.length = length;
+                runway.width = generated.major ? 150 : 75 + static_cast<int>(unit(rng) * 2.0) * 25;
+                runway.surface = generated.major || unit(rng) < 0.6 ? SurfaceType::ASPHALT : SurfaceType::GRASS;
+                runway.hasRunwayLights = generated.major || unit(rng) < 0.5;
+                runway.TORA = runway.TODA = runway.ASDA = runway.LDA = length;
+                if (generated.major && end == 0) {
+                    runway.ilsData.hasILS = true;
+                    runway.ilsData.localizerFrequency = 108.1 + 0.2 * static_cast<int>(unit(rng) * 19.0);
+                    runway.ilsData.glideslopeFrequency = 329.15 + 0.15 * static_cast<int>(unit(rng) * 20.0);
+                    runway.ilsData.localizerCourse = endHeading;
+                    runway.ilsData.decisionHeight = 200;
+                    runway.ilsData.category = unit(rng) < 0.3 ? ILSCategory::CAT_IIIA : ILSCategory::CAT_I;
+                    runway.ilsData.minimumRVR = runway.ilsData.category == ILSCategory::CAT_I ? 2400 : 700;
+                }
+                airport.runwayIds.push_back(runway.runwayId);
+                builder.putRunway(runway);
+            }
+        }
+        builder.putAirport(airport);
+    }
+    if (!builder.write(path)) {
+        std::cerr << "Could not write " << path << std::endl;
+        return false;
+    }
+    std::cout << "runways: " << builder.getAirportCount() << " airports, " << builder.getRunwayCount()
+              << " runway ends -> " << path << std::endl;
+    return true;
+}
+
+// Ridges and valleys from a few seeded wave trains, in meters
+struct TerrainShape {
+    double amplitude[4], frequencyX[4], frequencyY[4], phase[4];
+};
+
+void writeTile(const std::filesystem::path& dir, int lat, int lon, const TerrainShape& shape) {
+    const int n = SRTMTile::SRTM3_SIZE;
+    std::vector<uint8_t> bytes(static_cast<size_t>(n) * n * 2);
+    for (int row = 0; row < n; ++row) {
+        double y = lat + 1.0 - static_cast<double>(row) / (n - 1);
+        for (int col = 0; col < n; ++col) {
+            double x = lon + static_cast<double>(col) / (n - 1);
+            double height = 1200.0;
+            for (int k = 0; k < 4; ++k) {
+                height += shape.amplitude[k] * std::sin(x * shape.frequencyX[k] + y * shape.frequencyY[k] + shape.phase[k]);
+            }
+            uint16_t value = static_cast<uint16_t>(static_cast<int16_t>(std::max(0.0, height)));
+            size_t i = (static_cast<size_t>(row) * n + col) * 2;
+            bytes[i] = static_cast<uint8_t>(value >> 8);
+            bytes[i + 1] = static_cast<uint8_t>(value & 0xFF);
+        }
+    }
+    std::ofstream out(dir / SRTMTile::GetFileName(lat, lon), std::ios::binary);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+bool writeTerrain(const Options& options, std::mt19937& rng, const std::filesystem::path& dir) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    TerrainShape shape;
+    for (int k = 0; k < 4; ++k) {
+        shape.amplitude[k] = 900.0 / (k + 1);
+        shape.frequencyX[k] = (1.5 + unit(rng) * 2.0) * (k + 1);
+        shape.frequencyY[k] = (1.0 + unit(rng) * 2.0) * (k + 1);
+        shape.phase[k] = unit(rng) * 2.0 * GEN_PI;
+    }
+    std::filesystem::create_directories(dir);
+
+    // A square block of tiles from the south-west corner
+    size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(options.tiles))));
+    for (size_t i = 0; i < options.tiles; ++i) {
+        writeTile(dir, TERRAIN_SOUTH + static_cast<int>(i / side), TERRAIN_WEST + static_cast<int>(i % side), shape);
+    }
+    std::cout << "terrain: " << options.tiles << " SRTM3 tiles -> " << dir.string() << std::endl;
+    return true;
+}
+
+// A third of the targets on or near the field, half in the terminal area,
+// the rest en route out to 250 nm
+bool writeTraffic(const Options& options, std::mt19937& rng, const std::string& path) {
+    static const char* const AIRLINES[] = {"AAL", "ASA", "DAL", "UAL", "SWA", "QXE", "FDX", "UPS", "BAW", "DLH"};
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Could not write " << path << std::endl;
+        return false;
+    }
+    out << "# callsign,latitude,longitude,altitude_ft,ground_speed_kt,heading_deg,vertical_speed_fpm,on_ground\n";
+    out.setf(std::ios::fixed);
+    out.precision(6);
+    for (size_t i = 0; i < options.traffic; ++i) {
+        double band = unit(rng);
+        bool ground = band < 0.15;
+        double radiusNm = (ground ? 2.0 : band < 0.35 ? 12.0 : band < 0.85 ? 60.0 : 250.0) * std::sqrt(unit(rng));
+        double angle = unit(rng) * 2.0 * GEN_PI;
+        double lat = SCENE_LAT + radiusNm * std::cos(angle) / 60.0;
+        double lon = SCENE_LON + radiusNm * std::sin(angle) / (60.0 * std::cos(SCENE_LAT * GEN_PI / 180.0));
+        double altitude = ground ? 0.0 : band < 0.85 ? 1000.0 + unit(rng) * 17000.0 : 1000.0 * std::floor(20.0 + unit(rng) * 21.0);
+        double speed = ground ? unit(rng) * 25.0 : band < 0.85 ? 140.0 + unit(rng) * 200.0 : 380.0 + unit(rng) * 120.0;
+        double verticalSpeed = ground || band >= 0.85 ? 0.0 : (unit(rng) - 0.5) * 3000.0;
+
+        out << AIRLINES[i % 10] << (100 + i) << ',' << lat << ',' << lon << ',' << std::setprecision(0)
+            << altitude << ',' << speed << ',' << unit(rng) * 360.0 << ',' << verticalSpeed << ','
+            << (ground ? 1 : 0) << std::setprecision(6) << '\n';
+    }
+    std::cout << "traffic: " << options.traffic << " targets -> " << path << std::endl;
+    return static_cast<bool>(out);
+}
+
+bool parseCount(const char* text, size_t& value) {
+    char* end = nullptr;
+    unsigned long long parsed = std::strtoull(text, &end, 10);
+    if (end == text || *end != '\0') return false;
+    value = static_cast<size_t>(parsed);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    bool ok = argc >= 2 && argv[1][0] != '-';
+    if (ok) options.output = argv[1];
+    for (int i = 2; ok && i < argc; ++i) {
+        size_t value = 0;
+        if (i + 1 >= argc || !parseCount(argv[i + 1], value)) {
+            ok = false;
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            options.seed = static_cast<uint32_t>(value);
+        } else if (std::strcmp(argv[i], "--fixes") == 0) {
+            options.fixes = value;
+        } else if (std::strcmp(argv[i], "--airway-segments") == 0) {
+            options.airwaySegments = value;
+        } else if (std::strcmp(argv[i], "--airports") == 0) {
+            options.airports = value;
+        } else if (std::strcmp(argv[i], "--tiles") == 0) {
+            options.tiles = value;
+        } else if (std::strcmp(argv[i], "--traffic") == 0) {
+            options.traffic = value;
+        } else {
+            ok = false;
+        }
+        ++i;
+    }
+    if (!ok) {
+        std::cerr << "Usage: dataset_generator <output-dir> [--seed N] [--fixes N] [--airway-segments N]"
+                     " [--airports N] [--tiles N] [--traffic N]" << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::filesystem::path dir(options.output);
+    std::error_code error;
+    std::filesystem::create_directories(dir, error);
+    if (error) {
+        std::cerr << "Could not create " << dir.string() << ": " << error.message() << std::endl;
+        return 1;
+    }
+
+    // One stream per dataset, so changing one count leaves the others identical
+    std::mt19937 airportRng(options.seed), navdataRng(options.seed + 1), runwayRng(options.seed + 2),
+        terrainRng(options.seed + 3), trafficRng(options.seed + 4);
+    std::vector<GeneratedAirport> airports = makeAirports(options, airportRng);
+
+    bool written = writeNavdata(options, airports, navdataRng, (dir / "navdata.anp").string()) > 0 || options.fixes == 0;
+    written = writeRunways(airports, runwayRng, (dir / "runways.arp").string()) && written;
+    written = writeTerrain(options, terrainRng, dir / "srtm") && written;
+    written = writeTraffic(options, trafficRng, (dir / "traffic.csv").string()) && written;
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Generated in " << seconds << " s (seed " << options.seed << ")" << std::endl;
+    return written ? 0 : 2;
+}
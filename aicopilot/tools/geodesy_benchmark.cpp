@@ -0,0 +1,77 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Times the geodesy kernels: one origin to many points, scalar and batched.
+*
+* Usage: geodesy_benchmark [points] [repeats]
+*****************************************************************************/
+
+#include "geodesy.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+template <typename Kernel>
+void report(const char* name, size_t points, int repeats, const std::vector<double>& out, Kernel kernel) {
+    auto started = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) kernel();
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count();
+
+    // Sum the results so the work can't be optimized away
+    double checksum = 0.0;
+    for (double value : out) checksum += value;
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << ns / (static_cast<double>(points) * repeats) << " ns/point  (checksum "
+              << std::setprecision(0) << checksum << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t points = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 100000;
+    int repeats = argc > 2 ? std::atoi(argv[2]) : 50;
+    if (points == 0 || repeats <= 0) {
+        std::cerr << "Usage: geodesy_benchmark [points] [repeats]" << std::endl;
+        return 1;
+    }
+
+    // Fixes within about 600 NM of the origin, as a nearest-fix query sees them
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<double> lat(37.0, 57.0), lon(-135.0, -110.0);
+    std::vector<double> lats(points), lons(points), x(points), y(points), z(points), out(points);
+    for (size_t i = 0; i < points; ++i) {
+        lats[i] = lat(rng);
+        lons[i] = lon(rng);
+    }
+    const double lat0 = 47.45, lon0 = -122.31;
+    Geodesy::toUnitVectorBatch(lats.data(), lons.data(), points, x.data(), y.data(), z.data());
+    const Geodesy::UnitVector origin = Geodesy::toUnitVector(lat0, lon0);
+
+    std::cout << points << " points x " << repeats << " repeats" << std::endl;
+    report("haversine (scalar)", points, repeats, out, [&] {
+        for (size_t i = 0; i < points; ++i) out[i] = Geodesy::haversineNM(lat0, lon0, lats[i], lons[i]);
+    });
+    report("haversine (batch)", points, repeats, out, [&] {
+        Geodesy::haversineBatchNM(lat0, lon0, lats.data(), lons.data(), points, out.data());
+    });
+    report("bearing (scalar)", points, repeats, out, [&] {
+        for (size_t i = 0; i < points; ++i) out[i] = Geodesy::initialBearing(lat0, lon0, lats[i], lons[i]);
+    });
+    report("bearing (batch)", points, repeats, out, [&] {
+        Geodesy::initialBearingBatch(lat0, lon0, lats.data(), lons.data(), points, out.data());
+    });
+    report("unit vector (batch)", points, repeats, out, [&] {
+        Geodesy::chordDistanceBatchNM(origin, x.data(), y.data(), z.data(), points, out.data());
+    });
+    report("flat earth (batch)", points, repeats, out, [&] {
+        Geodesy::flatDistanceBatchNM(lat0, lon0, lats.data(), lons.data(), points, out.data());
+    });
+    return 0;
+}
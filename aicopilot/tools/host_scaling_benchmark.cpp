@@ -0,0 +1,390 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Scaling benchmark for the multi-pilot host: 1..N hosted pilots share one
+* set of navdata, terrain and runway stores. For 1, 2, 4 ... N pilots it
+* reports pilot updates per second and per pool thread, frame latency,
+* lock waits on the shared caches and resident memory per added pilot, as
+* a scaling curve in text or JSON.
+*
+* Usage: host_scaling_benchmark [--max-pilots N] [--frames N] [--threads N]
+*                               [--capture file --aircraft cfg]
+*                               [--navdata pack] [--srtm dir] [--runways pack]
+*                               [--json [file]]
+*   --capture   Also replay this capture through every hosted pilot; it
+*               should cover frames x curve points control periods
+*   --json      Write the results as JSON to stdout or the named file
+*
+* Every pilot also runs a database client each frame - the terrain, navaid
+* and runway queries of one control cycle - against the shared stores, so
+* the curve shows where they stop scaling even without a capture.
+*****************************************************************************/
+
+#include "bench_data.hpp"
+#include "elevation_data.h"
+#include "navdata_database.hpp"
+#include "pilot_host.hpp"
+#include "runway_database_prod.hpp"
+#include "srtm_loader.hpp"
+#include "work_stealing_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr size_t WARMUP_FRAMES = 30;
+constexpr size_t LOOKAHEAD_POINTS = 8;     // terrain samples ahead of the aircraft
+constexpr uint32_t RUNWAY_EVERY = 30;      // once a second at the control rate
+constexpr uint32_t ROUTE_EVERY = 300;
+
+// Waits summed over the shared caches that still take locks; navdata and
+// runway records are read from lock-free snapshots
+struct Contention {
+    uint64_t terrainTiles = 0;     // SRTMLoader cache_mutex_
+    uint64_t elevationCells = 0;   // ElevationDatabase cell stripes
+    uint64_t runwaySelection = 0;  // RunwayDatabase selection memo stripes
+    uint64_t navdataRoutes = 0;    // NavigationDatabase route cache stripes
+};
+
+struct Point {
+    size_t pilots = 0;
+    size_t activePilots = 0;
+    size_t threads = 0;
+    size_t frames = 0;
+    double wallSec = 0.0;
+    double updatesPerSec = 0.0;
+    double updatesPerThreadSec = 0.0;
+    double efficiency = 0.0;       // per-thread throughput relative to one pilot
+    double p50FrameUs = 0.0;
+    double p99FrameUs = 0.0;
+    size_t rssBytes = 0;
+    double bytesPerAddedPilot = 0.0;
+    Contention waits;
+};
+
+struct Result {
+    std::string navdata, srtm, runways, capture;
+    size_t baselineRssBytes = 0;
+    std::vector<Point> curve;
+};
+
+size_t currentRssBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return counters.WorkingSetSize;
+#else
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    if (!(statm >> pages >> resident)) return 0;
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+/**
+ * The shared-store queries one pilot makes in a control cycle
+ *
+ * Clients start at different points of the fixed query sets and walk
+ * through them, so concurrent clients read overlapping tiles and cells the
+ * way aircraft converging on one terminal area would.
+ */
+class DatabaseClient {
+public:
+    explicit DatabaseClient(size_t seed) : cursor_(seed * 37) {}
+
+    void runFrame(SRTMLoader& terrain, ElevationDatabase& elevation) {
+        const NavigationDatabase& navdata = Bench::navigationDatabase();
+        const RunwayDatabase& runways = Bench::runwayDatabase();
+        const auto& terrainPoints = Bench::terrainQueryPoints();
+        const auto& navPoints = Bench::navdataQueryPoints();
+        const auto& airports = Bench::runwayAirports();
+        const auto& routes = Bench::routePairs();
+        frame_++;
+        cursor_++;
+
+        if (!terrainPoints.empty()) {
+            LatLon ahead[LOOKAHEAD_POINTS];
+            for (size_t i = 0; i < LOOKAHEAD_POINTS; ++i) {
+                ahead[i] = terrainPoints[(cursor_ + i) % terrainPoints.size()];
+            }
+            double out[LOOKAHEAD_POINTS];
+            sink_ += terrain.GetElevation(ahead[0].latitude, ahead[0].longitude);
+            terrain.GetElevations(ahead, LOOKAHEAD_POINTS, out);
+            sink_ += out[LOOKAHEAD_POINTS - 1];
+        }
+
+        const LatLon& position = navPoints[cursor_ % navPoints.size()];
+        sink_ += elevation.GetElevationAt(position.latitude, position.longitude);
+        sink_ += static_cast<double>(navdata.GetNearestWaypoints(position.latitude, position.longitude, 1).size());
+
+        if (!airports.empty() && frame_ % RUNWAY_EVERY == 0) {
+            int wind = static_cast<int>((frame_ / RUNWAY_EVERY) % 288);
+            RunwayInfo runway = runways.GetBestRunwayForLanding(
+                airports[cursor_ % airports.size()], (wind % 36) * 10, (wind / 36) * 4, 20.0);
+            sink_ += static_cast<double>(runway.runwayId.size());
+        }
+        if (!routes.empty() && frame_ % ROUTE_EVERY == 0) {
+            const auto& route = routes[cursor_ % routes.size()];
+            sink_ += static_cast<double>(navdata.FindRoute(route.first, route.second).waypointSequence.size());
+        }
+    }
+
+    double sink() const { return sink_; }
+
+private:
+    size_t cursor_;
+    uint32_t frame_ = 0;
+    double sink_ = 0.0;
+};
+
+Contention sampleContention(const SRTMLoader& terrain, const ElevationDatabase& elevation) {
+    Contention c;
+    c.terrainTiles = terrain.GetCacheStats().lockContentions;
+    c.elevationCells = elevation.GetCellCacheStats().contentions;
+    c.runwaySelection = Bench::runwayDatabase().GetSelectionCacheStats().contentions;
+    c.navdataRoutes = Bench::navigationDatabase().GetStatistics().routeCacheContentions;
+    return c;
+}
+
+Contention operator-(const Contention& a, const Contention& b) {
+    Contention c;
+    c.terrainTiles = a.terrainTiles - b.terrainTiles;
+    c.elevationCells = a.elevationCells - b.elevationCells;
+    c.runwaySelection = a.runwaySelection - b.runwaySelection;
+    c.navdataRoutes = a.navdataRoutes - b.navdataRoutes;
+    return c;
+}
+
+double percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) return 0.0;
+    size_t index = static_cast<size_t>(fraction * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+void writeJson(std::ostream& out, const Result& r) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"benchmark\": \"host_scaling_benchmark\",\n";
+    out << "  \"navdata\": \"" << r.navdata << "\", \"srtm\": \"" << r.srtm
+        << "\", \"runways\": \"" << r.runways << "\", \"capture\": \"" << r.capture << "\",\n";
+    out << "  \"baseline_rss_bytes\": " << r.baselineRssBytes << ",\n";
+    out << "  \"curve\": [\n";
+    for (size_t i = 0; i < r.curve.size(); ++i) {
+        const Point& p = r.curve[i];
+        out << "    {\"pilots\": " << p.pilots << ", \"active_pilots\": " << p.activePilots
+            << ", \"threads\": " << p.threads << ", \"frames\": " << p.frames
+            << ", \"wall_sec\": " << p.wallSec << ", \"updates_per_sec\": " << p.updatesPerSec
+            << ", \"updates_per_thread_sec\": " << p.updatesPerThreadSec
+            << ", \"efficiency\": " << p.efficiency
+            << ", \"p50_frame_us\": " << p.p50FrameUs << ", \"p99_frame_us\": " << p.p99FrameUs
+            << ", \"rss_bytes\": " << p.rssBytes << ", \"bytes_per_added_pilot\": " << p.bytesPerAddedPilot
+            << ", \"lock_waits\": {\"terrain_tiles\": " << p.waits.terrainTiles
+            << ", \"elevation_cells\": " << p.waits.elevationCells
+            << ", \"runway_selection\": " << p.waits.runwaySelection
+            << ", \"navdata_routes\": " << p.waits.navdataRoutes << "}}"
+            << (i + 1 < r.curve.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}" << std::endl;
+}
+
+void writeText(std::ostream& out, const Result& r) {
+    out << "\nHost scaling benchmark" << std::endl;
+    out << "======================" << std::endl;
+    out << "Navdata: " << r.navdata << ", terrain: " << r.srtm << ", runways: " << r.runways << std::endl;
+    if (!r.capture.empty()) out << "Capture: " << r.capture << std::endl;
+    out << "Baseline RSS: " << (r.baselineRssBytes / (1024.0 * 1024.0)) << " MiB" << std::endl;
+    out << std::endl;
+    out << std::left << std::setw(8) << "pilots" << std::setw(8) << "active" << std::setw(8) << "threads"
+        << std::right << std::setw(13) << "updates/s" << std::setw(13) << "per thread" << std::setw(8) << "eff"
+        << std::setw(10) << "p50 us" << std::setw(10) << "p99 us" << std::setw(12) << "KiB/pilot"
+        << std::setw(10) << "tile" << std::setw(10) << "cell" << std::setw(10) << "runway"
+        << std::setw(10) << "route" << std::endl;
+    out << std::fixed;
+    for (const Point& p : r.curve) {
+        out << std::left << std::setw(8) << p.pilots << std::setw(8) << p.activePilots << std::setw(8) << p.threads
+            << std::right << std::setprecision(0) << std::setw(13) << p.updatesPerSec
+            << std::setw(13) << p.updatesPerThreadSec << std::setprecision(2) << std::setw(8) << p.efficiency
+            << std::setprecision(1) << std::setw(10) << p.p50FrameUs << std::setw(10) << p.p99FrameUs
+            << std::setw(12) << (p.bytesPerAddedPilot / 1024.0)
+            << std::setw(10) << p.waits.terrainTiles << std::setw(10) << p.waits.elevationCells
+            << std::setw(10) << p.waits.runwaySelection << std::setw(10) << p.waits.navdataRoutes << std::endl;
+    }
+    out << "\nLock waits are acquisitions that found the lock held, per curve point." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t maxPilots = 64;
+    size_t frames = 300;
+    size_t threadCount = 0;
+    const char* capture = nullptr;
+    const char* aircraft = nullptr;
+    bool json = false;
+    const char* jsonPath = nullptr;
+    Bench::DatasetPaths& paths = Bench::datasetPaths();
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--max-pilots") == 0 && hasValue) {
+            maxPilots = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--frames") == 0 && hasValue) {
+            frames = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            threadCount = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--capture") == 0 && hasValue) {
+            capture = argv[++i];
+        } else if (std::strcmp(argv[i], "--aircraft") == 0 && hasValue) {
+            aircraft = argv[++i];
+        } else if (std::strcmp(argv[i], "--navdata") == 0 && hasValue) {
+            paths.navdata = argv[++i];
+        } else if (std::strcmp(argv[i], "--srtm") == 0 && hasValue) {
+            paths.srtm = argv[++i];
+        } else if (std::strcmp(argv[i], "--runways") == 0 && hasValue) {
+            paths.runways = argv[++i];
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') jsonPath = argv[++i];
+        } else {
+            std::cerr << "Usage: host_scaling_benchmark [--max-pilots N] [--frames N] [--threads N]"
+                         " [--capture file --aircraft cfg] [--navdata pack] [--srtm dir] [--runways pack]"
+                         " [--json [file]]" << std::endl;
+            return 1;
+        }
+    }
+    if (maxPilots == 0 || frames == 0) {
+        std::cerr << "Pilot and frame counts must be positive" << std::endl;
+        return 1;
+    }
+    if (capture != nullptr && aircraft == nullptr) {
+        std::cerr << "--capture needs --aircraft" << std::endl;
+        return 1;
+    }
+
+    // Shared stores are built before the baseline, so it holds them once
+    Bench::navigationDatabase();
+    Bench::runwayDatabase();
+    Bench::runwayAirports();
+    Bench::routePairs();
+    Bench::navdataQueryPoints();
+    Bench::terrainQueryPoints();
+    SRTMLoader& terrain = Bench::srtmLoader();
+    ElevationDatabase elevation;
+
+    Result result;
+    result.navdata = Bench::datasetName(paths.navdata);
+    result.srtm = Bench::datasetName(paths.srtm);
+    result.runways = Bench::datasetName(paths.runways);
+    result.capture = capture ? capture : "";
+
+    // Touch every tile and cell once so shared cache growth is not charged
+    // to the first pilots
+    for (const LatLon& point : Bench::terrainQueryPoints()) terrain.GetElevation(point.latitude, point.longitude);
+    for (const LatLon& point : Bench::navdataQueryPoints()) elevation.GetElevationAt(point.latitude, point.longitude);
+
+    // Pilots are added to one host as the curve climbs, so each point's
+    // memory delta is what the newly added pilots cost
+    PilotHost host(threadCount);
+    host.setSharedNavdata(AIPilot::createNavdataProvider());
+    WorkStealingPool clientPool(host.getThreadCount());
+    std::vector<std::unique_ptr<DatabaseClient>> clients;
+    result.baselineRssBytes = currentRssBytes();
+    size_t previousRss = result.baselineRssBytes;
+    double sink = 0.0;
+
+    for (size_t pilots = 1; pilots <= maxPilots; pilots *= 2) {
+        size_t added = pilots - clients.size();
+        while (clients.size() < pilots) {
+            AIPilot& pilot = host.addPilot();
+            if (capture != nullptr) {
+                if (!pilot.initializeReplay(capture, ReplayPacing::AS_FAST_AS_POSSIBLE) ||
+                    !pilot.loadAircraftConfig(aircraft)) {
+                    std::cerr << "Could not start replay pilot " << clients.size() << std::endl;
+                    return 2;
+                }
+                pilot.startAutonomousFlight();
+            }
+            clients.push_back(std::make_unique<DatabaseClient>(clients.size()));
+        }
+
+        auto runFrame = [&] {
+            for (size_t i = 0; i < host.getPilotCount(); ++i) {
+                AIPilot& pilot = host.getPilot(i);
+                if (pilot.isActive() && !pilot.isConnected()) pilot.stopAutonomousFlight();
+            }
+            if (host.getActivePilotCount() > 0) host.tick();
+            for (auto& client : clients) {
+                DatabaseClient* instance = client.get();
+                clientPool.submit([instance, &terrain, &elevation] { instance->runFrame(terrain, elevation); });
+            }
+            clientPool.wait();
+        };
+
+        for (size_t frame = 0; frame < WARMUP_FRAMES; ++frame) runFrame();
+
+        Point point;
+        point.pilots = pilots;
+        point.threads = std::min(host.getThreadCount(), pilots);
+        point.frames = frames;
+        point.rssBytes = currentRssBytes();
+        point.bytesPerAddedPilot = point.rssBytes > previousRss
+            ? static_cast<double>(point.rssBytes - previousRss) / added : 0.0;
+        previousRss = point.rssBytes;
+
+        Contention before = sampleContention(terrain, elevation);
+        std::vector<double> frameUs;
+        frameUs.reserve(frames);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t frame = 0; frame < frames; ++frame) {
+            auto frameStart = std::chrono::steady_clock::now();
+            runFrame();
+            frameUs.push_back(std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - frameStart).count());
+        }
+        point.wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        point.waits = sampleContention(terrain, elevation) - before;
+
+        point.activePilots = host.getActivePilotCount();
+        point.updatesPerSec = static_cast<double>(pilots * frames) / point.wallSec;
+        point.updatesPerThreadSec = point.updatesPerSec / point.threads;
+        point.efficiency = result.curve.empty() ? 1.0
+            : point.updatesPerThreadSec / result.curve.front().updatesPerThreadSec;
+        point.p50FrameUs = percentile(frameUs, 0.50);
+        point.p99FrameUs = percentile(frameUs, 0.99);
+        result.curve.push_back(point);
+    }
+    for (const auto& client : clients) sink += client->sink();
+    if (sink == -1.0) std::cerr << std::endl;   // keeps the queries observable
+
+    if (!json) {
+        writeText(std::cout, result);
+        return 0;
+    }
+    if (jsonPath) {
+        std::ofstream file(jsonPath);
+        if (!file) {
+            std::cerr << "Could not write " << jsonPath << std::endl;
+            return 1;
+        }
+        writeJson(file, result);
+    } else {
+        writeJson(std::cout, result);
+    }
+    return 0;
+}
@@ -0,0 +1,66 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Prints a BinaryLogger file as text, one record per line.
+*
+* Usage: log_decoder [--level DEBUG|INFO|WARNING|ERROR|CRITICAL] <log.bin>
+*   --level    Skip records below this level
+*****************************************************************************/
+
+#include "binary_log.hpp"
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace AICopilot;
+
+namespace {
+
+bool parseLevel(const std::string& name, LogLevel& level) {
+    for (int value = 0; value <= static_cast<int>(LogLevel::CRITICAL); ++value) {
+        if (name == logLevelName(static_cast<LogLevel>(value))) {
+            level = static_cast<LogLevel>(value);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    LogLevel minimum = LogLevel::DEBUG;
+    int arg = 1;
+    if (arg + 1 < argc && std::strcmp(argv[arg], "--level") == 0) {
+        if (!parseLevel(argv[arg + 1], minimum)) {
+            std::cerr << "Unknown level: " << argv[arg + 1] << std::endl;
+            return 1;
+        }
+        arg += 2;
+    }
+    if (arg + 1 != argc) {
+        std::cerr << "Usage: log_decoder [--level DEBUG|INFO|WARNING|ERROR|CRITICAL] <log.bin>" << std::endl;
+        return 1;
+    }
+
+    BinaryLogReader reader;
+    if (!reader.open(argv[arg])) {
+        std::cerr << "Not a binary log: " << argv[arg] << std::endl;
+        return 2;
+    }
+
+    LogLine line;
+    uint64_t records = 0;
+    while (reader.next(line)) {
+        records++;
+        if (line.level >= minimum) {
+            std::cout << formatLogLine(line) << '\n';
+        }
+    }
+    std::cerr << records << " records";
+    if (reader.droppedRecords() > 0) {
+        std::cerr << ", " << reader.droppedRecords() << " dropped by the writer";
+    }
+    std::cerr << std::endl;
+    return 0;
+}
@@ -0,0 +1,328 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Times METARParser::parse and the WeatherDatabase parse entry points over
+* a report corpus, and reports throughput, allocations per report and
+* latency percentiles, as text or JSON. The corpus is a METAR and a TAF
+* cycle file (NOAA metars.cache.csv / tafs.cache.csv or raw reports, as
+* WeatherDatabase ingests them); without files a seeded synthetic day of
+* global reports stands in.
+*
+* Usage: metar_benchmark [--metars file] [--tafs file] [--reports N] [--json [file]]
+*****************************************************************************/
+
+#include "metar_parser.hpp"
+#include "weather_database.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Every heap allocation in the process, so each subject's count per report
+// can be read off around its loop
+namespace {
+std::atomic<size_t> g_allocations{0};
+}
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+using namespace AICopilot;
+
+namespace {
+
+// About one day of global METARs (hourly from ~4,500 stations plus specials)
+constexpr size_t DEFAULT_REPORTS = 120000;
+constexpr size_t TAFS_PER_METAR = 6;         // TAFs are issued four times a day at fewer stations
+
+const char* const WEATHER[] = {"-RA", "RA", "+RA", "-SN", "SN", "BR", "FG", "HZ", "-DZ", "SHRA",
+                               "+TSRA", "VCTS", "TS", "-FZRA", "FZFG", "-SHSN", "BLSN", "DU"};
+const char* const COVER[] = {"FEW", "SCT", "BKN", "OVC"};
+const char* const TREND[] = {"NOSIG", "BECMG 4000 -SN", "TEMPO 3000 SHRA BKN010"};
+
+std::string pad(int value, int width) {
+    std::ostringstream out;
+    out << std::setw(width) << std::setfill('0') << value;
+    return out.str();
+}
+
+std::string temperature(int celsius) {
+    return (celsius < 0 ? "M" : "") + pad(std::abs(celsius), 2);
+}
+
+// One plausible report body after the date/time group, North American or
+// ICAO style
+std::string makeBody(std::mt19937& rng, bool icao) {
+    std::uniform_int_distribution<int> percent(0, 99);
+    auto pick = [&](int n) { return std::uniform_int_distribution<int>(0, n - 1)(rng); };
+    std::string body;
+    auto add = [&](const std::string& token) {
+        if (!body.empty()) body += ' ';
+        body += token;
+    };
+
+    int speed = pick(30);
+    std::string wind = percent(rng) < 8 ? "VRB" : pad(pick(36) * 10, 3);
+    wind += pad(speed, 2);
+    if (percent(rng) < 12) wind += "G" + pad(speed + 8 + pick(20), 2);
+    add(wind + (icao && percent(rng) < 20 ? "MPS" : "KT"));
+    if (percent(rng) < 8) add(pad(pick(18) * 10 + 10, 3) + "V" + pad(pick(18) * 10 + 190, 3));
+
+    bool cavok = icao && percent(rng) < 25;
+    if (cavok) {
+        add("CAVOK");
+    } else if (icao) {
+        static const char* const METRES[] = {"9999", "8000", "4000", "1500", "0800", "0300"};
+        add(METRES[pick(6)]);
+    } else {
+        static const char* const MILES[] = {"10SM", "10SM", "7SM", "5SM", "3SM", "2 1/2SM", "1SM", "3/4SM", "1/4SM"};
+        add(MILES[pick(9)]);
+    }
+    if (percent(rng) < 3) add("R" + pad(pick(36) + 1, 2) + "L/" + pad(pick(50) * 100 + 600, 4) + "FT");
+
+    if (!cavok) {
+        for (int i = pick(3) - 1; i > 0 || (i == 0 && percent(rng) < 40); --i) add(WEATHER[pick(18)]);
+        int layers = pick(4);
+        if (layers == 0) add(icao ? "NSC" : "CLR");
+        for (int i = 0, base = 5 + pick(40); i < layers; ++i, base += 10 + pick(60)) {
+            std::string layer = COVER[std::min(3, i + pick(2))] + pad(base, 3);
+            if (percent(rng) < 4) layer += percent(rng) < 50 ? "CB" : "TCU";
+            add(layer);
+        }
+        if (percent(rng) < 2) add("VV00" + std::to_string(1 + pick(8)));
+    }
+
+    int t = pick(60) - 25;
+    add(temperature(t) + "/" + temperature(t - pick(15)));
+    add(icao ? "Q" + pad(990 + pick(45), 4) : "A" + pad(2950 + pick(100), 4));
+    if (icao && percent(rng) < 15) add(TREND[pick(3)]);
+    if (!icao && percent(rng) < 70) {
+        add("RMK AO2 SLP" + pad(pick(400), 3) + " T" + pad(pick(300), 4) + pad(pick(300), 4));
+    }
+    return body;
+}
+
+std::string makeStation(std::mt19937& rng, bool icao) {
+    static const char PREFIX[] = "EGLDFLPRUYZ";
+    std::uniform_int_distribution<int> letter(0, 25);
+    std::string station(1, icao ? PREFIX[letter(rng) % (sizeof(PREFIX) - 1)] : (letter(rng) < 20 ? 'K' : 'C'));
+    for (int i = 0; i < 3; ++i) station += static_cast<char>('A' + letter(rng));
+    return station;
+}
+
+std::vector<std::string> syntheticMETARs(size_t count) {
+    std::mt19937 rng(20250112);
+    std::vector<std::string> reports;
+    reports.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        bool icao = i % 5 < 2;
+        std::string time = pad(12, 2) + pad(static_cast<int>(i * 24 / count), 2) + pad(static_cast<int>(i % 60), 2) + "Z";
+        std::string prefix = i % 40 == 0 ? "SPECI " : "";
+        std::string automated = !icao && i % 3 == 0 ? " AUTO" : "";
+        reports.push_back(prefix + makeStation(rng, icao) + " " + time + automated + " " + makeBody(rng, icao));
+    }
+    return reports;
+}
+
+std::vector<std::string> syntheticTAFs(size_t count) {
+    std::mt19937 rng(20250113);
+    std::vector<std::string> tafs;
+    tafs.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        bool icao = i % 5 < 2;
+        int hour = static_cast<int>(i % 4) * 6;
+        std::string taf = std::string(i % 30 == 0 ? "TAF AMD " : "TAF ") + makeStation(rng, icao) + " 12" +
+                          pad(hour, 2) + "00Z 12" + pad(hour, 2) + "/13" + pad(hour, 2) + " " + makeBody(rng, icao);
+        for (int group = 0; group < 3; ++group) {
+            taf += " FM12" + pad((hour + 6 * (group + 1)) % 24, 2) + "00 " + makeBody(rng, icao);
+        }
+        tafs.push_back(taf);
+    }
+    return tafs;
+}
+
+// Reports from a cycle file: raw reports, or raw_text as the first CSV
+// column; with continuations, indented lines join the report above
+std::vector<std::string> loadCorpus(const std::string& path, bool continuations) {
+    std::ifstream in(path, std::ios::binary);
+    std::vector<std::string> reports;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        bool indented = !line.empty() && (line[0] == ' ' || line[0] == '\t');
+        if (continuations && indented && !reports.empty()) {
+            size_t start = line.find_first_not_of(" \t");
+            if (start != std::string::npos) reports.back() += " " + line.substr(start);
+            continue;
+        }
+        // NOAA cache files open with status lines and a column header
+        if (line.compare(0, 9, "raw_text,") == 0) {
+            reports.clear();
+            continue;
+        }
+        std::string report = line.substr(0, line.find(','));
+        if (report.size() >= 2 && report.front() == '"' && report.back() == '"') {
+            report = report.substr(1, report.size() - 2);
+        }
+        if (!report.empty() && report[0] != '#') reports.push_back(report);
+    }
+    return reports;
+}
+
+struct Result {
+    std::string subject;
+    std::string corpus;
+    size_t reports = 0;
+    size_t accepted = 0;
+    double reportsPerSec = 0.0;
+    double allocationsPerReport = 0.0;
+    double p50Ns = 0.0;
+    double p99Ns = 0.0;
+    double maxNs = 0.0;
+};
+
+// Time parse(report) once per report; it returns whether the report was accepted
+template <typename Parse>
+Result measure(const std::string& subject, const std::string& corpus, const std::vector<std::string>& reports,
+               Parse parse) {
+    Result result;
+    result.subject = subject;
+    result.corpus = corpus;
+    result.reports = reports.size();
+    if (reports.empty()) return result;
+
+    std::vector<double> latenciesNs(reports.size());
+    size_t allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+    double total = 0.0;
+    for (size_t i = 0; i < reports.size(); ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        bool accepted = parse(reports[i]);
+        auto t1 = std::chrono::steady_clock::now();
+        latenciesNs[i] = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        total += latenciesNs[i];
+        result.accepted += accepted ? 1 : 0;
+    }
+    size_t allocations = g_allocations.load(std::memory_order_relaxed) - allocationsBefore;
+
+    std::sort(latenciesNs.begin(), latenciesNs.end());
+    auto percentile = [&latenciesNs](double p) {
+        return latenciesNs[static_cast<size_t>(p * (latenciesNs.size() - 1))];
+    };
+    result.reportsPerSec = total > 0.0 ? reports.size() / (total * 1e-9) : 0.0;
+    result.allocationsPerReport = static_cast<double>(allocations) / reports.size();
+    result.p50Ns = percentile(0.50);
+    result.p99Ns = percentile(0.99);
+    result.maxNs = latenciesNs.back();
+    return result;
+}
+
+void writeJson(std::ostream& out, const std::vector<Result>& results) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"benchmark\": \"metar_benchmark\",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"subject\": \"" << r.subject << "\", \"corpus\": \"" << r.corpus
+            << "\", \"reports\": " << r.reports << ", \"accepted\": " << r.accepted
+            << ", \"reports_per_sec\": " << r.reportsPerSec
+            << ", \"allocations_per_report\": " << r.allocationsPerReport
+            << ", \"p50_ns\": " << r.p50Ns << ", \"p99_ns\": " << r.p99Ns << ", \"max_ns\": " << r.maxNs
+            << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+void writeText(std::ostream& out, const std::vector<Result>& results) {
+    out << std::left << std::setw(30) << "subject" << std::setw(8) << "corpus" << std::right
+        << std::setw(9) << "reports" << std::setw(9) << "accepted" << std::setw(14) << "reports/s"
+        << std::setw(10) << "allocs" << std::setw(10) << "p50 ns" << std::setw(10) << "p99 ns" << std::endl;
+    for (const Result& r : results) {
+        out << std::left << std::setw(30) << r.subject << std::setw(8) << r.corpus << std::right
+            << std::setw(9) << r.reports << std::setw(9) << r.accepted << std::fixed << std::setprecision(0)
+            << std::setw(14) << r.reportsPerSec << std::setprecision(2) << std::setw(10)
+            << r.allocationsPerReport << std::setprecision(0) << std::setw(10) << r.p50Ns << std::setw(10)
+            << r.p99Ns << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string metarPath, tafPath;
+    size_t reports = DEFAULT_REPORTS;
+    bool json = false;
+    const char* jsonPath = nullptr;
+    bool usage = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--metars") == 0 && i + 1 < argc) {
+            metarPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--tafs") == 0 && i + 1 < argc) {
+            tafPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--reports") == 0 && i + 1 < argc) {
+            reports = static_cast<size_t>(std::atol(argv[++i]));
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') jsonPath = argv[++i];
+        } else {
+            usage = true;
+            break;
+        }
+    }
+    if (usage || reports == 0) {
+        std::cerr << "Usage: metar_benchmark [--metars file] [--tafs file] [--reports N] [--json [file]]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> metars = metarPath.empty() ? syntheticMETARs(reports) : loadCorpus(metarPath, false);
+    std::vector<std::string> tafs =
+        tafPath.empty() ? syntheticTAFs(std::max<size_t>(1, reports / TAFS_PER_METAR)) : loadCorpus(tafPath, true);
+    const std::string metarCorpus = metarPath.empty() ? "synth" : "file";
+    const std::string tafCorpus = tafPath.empty() ? "synth" : "file";
+
+    WeatherDatabase db;
+    std::vector<Result> results;
+    METARObservation observation;
+    results.push_back(measure("metar_parser.parse", metarCorpus, metars, [&](const std::string& report) {
+        return METARParser::parse(report, observation);
+    }));
+    results.push_back(measure("weather_database.parseMETAR", metarCorpus, metars, [&](const std::string& report) {
+        return db.parseMETAR(report).isValid;
+    }));
+    results.push_back(measure("weather_database.ParseMETAR", metarCorpus, metars, [&](const std::string& report) {
+        return db.ParseMETAR(report).isValid;
+    }));
+    results.push_back(measure("weather_database.ParseTAF", tafCorpus, tafs, [&](const std::string& report) {
+        return !db.ParseTAF(report).empty();
+    }));
+
+    if (!json) {
+        writeText(std::cout, results);
+        return 0;
+    }
+    if (jsonPath) {
+        std::ofstream file(jsonPath);
+        if (!file) {
+            std::cerr << "Cannot write " << jsonPath << std::endl;
+            return 2;
+        }
+        writeJson(file, results);
+    } else {
+        writeJson(std::cout, results);
+    }
+    return 0;
+}
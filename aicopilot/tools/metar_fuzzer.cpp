@@ -0,0 +1,85 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* libFuzzer target for METARParser and the WeatherDatabase parse entry
+* points. Any input must parse without crashing, and an accepted report
+* must stay inside the observation's fixed bounds and point only into its
+* own text. Built with ENABLE_FUZZING; without libFuzzer the same checks
+* replay the files given on the command line.
+*
+* Usage: metar_fuzzer [libFuzzer options] [corpus dir]
+*        metar_fuzzer input...           (AICOPILOT_FUZZ_REPLAY builds)
+*****************************************************************************/
+
+#include "metar_parser.hpp"
+#include "weather_database.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+using namespace AICopilot;
+
+namespace {
+
+void check(bool condition, const char* invariant) {
+    if (!condition) {
+        std::fprintf(stderr, "metar_fuzzer: invariant failed: %s\n", invariant);
+        std::abort();
+    }
+}
+
+bool inside(size_t offset, size_t length, size_t size) {
+    return offset <= size && length <= size - offset;
+}
+
+void checkObservation(const METARObservation& o, std::string_view text) {
+    check(o.weatherCount <= METARObservation::MAX_WEATHER_GROUPS, "weatherCount bound");
+    check(o.cloudCount <= METARObservation::MAX_CLOUD_LAYERS, "cloudCount bound");
+    check(o.stationId().size() >= 3, "station identifier present");
+    check(inside(o.remarksOffset, o.remarksLength, text.size()), "remarks inside report");
+    for (size_t i = 0; i < o.weatherCount; ++i) {
+        check(inside(o.weather[i].offset, o.weather[i].length, text.size()), "weather token inside report");
+    }
+    check(!o.hasVisibility || o.visibilitySM >= 0.0, "visibility non-negative");
+    check(!o.hasWind || o.windSpeed >= 0, "wind speed non-negative");
+    (void)o.remarks(text);
+    (void)o.weatherComponents();
+    (void)o.ceilingFeet();
+    (void)summarizeObservation(o, text);
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    std::string_view text(reinterpret_cast<const char*>(data), size);
+    METARObservation observation;
+    if (METARParser::parse(text, observation)) checkObservation(observation, text);
+
+    // The legacy entry points take std::string copies and allocate freely;
+    // they only have to survive the input
+    static WeatherDatabase db;
+    std::string report(text);
+    (void)db.parseMETAR(report);
+    (void)db.ParseMETAR(report);
+    (void)db.ParseTAF(report);
+    return 0;
+}
+
+#ifdef AICOPILOT_FUZZ_REPLAY
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        std::ifstream in(argv[i], std::ios::binary);
+        if (!in) {
+            std::fprintf(stderr, "Cannot read %s\n", argv[i]);
+            return 2;
+        }
+        std::string input((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+    }
+    return 0;
+}
+#endif
@@ -0,0 +1,86 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Trains the ML models from flight data recordings and writes a model pack.
+*
+* Usage: model_trainer [--threads N] [--stride N] <model.aimp> <recording|dir>...
+*   --threads  Recordings scanned in parallel (default: hardware threads)
+*   --stride   Recorded rows per training sample (default: 30)
+*   A directory contributes every .aifr file below it.
+*****************************************************************************/
+
+#include "training_pipeline.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+void addRecordings(const std::string& path, std::vector<std::string>& out) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(path, error)) {
+        out.push_back(path);
+        return;
+    }
+    std::vector<std::string> found;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(path, error)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".aifr") {
+            found.push_back(entry.path().string());
+        }
+    }
+    std::sort(found.begin(), found.end());
+    out.insert(out.end(), found.begin(), found.end());
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ML::TrainingPipelineConfig config;
+    int arg = 1;
+    while (arg + 1 < argc && std::strncmp(argv[arg], "--", 2) == 0) {
+        if (std::strcmp(argv[arg], "--threads") == 0) {
+            config.threads = static_cast<size_t>(std::strtoul(argv[arg + 1], nullptr, 10));
+        } else if (std::strcmp(argv[arg], "--stride") == 0) {
+            config.row_stride = static_cast<size_t>(std::strtoul(argv[arg + 1], nullptr, 10));
+        } else {
+            std::cerr << "Unknown option: " << argv[arg] << std::endl;
+            return 1;
+        }
+        arg += 2;
+    }
+    if (arg + 2 > argc) {
+        std::cerr << "Usage: model_trainer [--threads N] [--stride N] <model.aimp> <recording|dir>..." << std::endl;
+        return 1;
+    }
+
+    std::string output = argv[arg++];
+    std::vector<std::string> recordings;
+    for (; arg < argc; ++arg) {
+        addRecordings(argv[arg], recordings);
+    }
+
+    ML::TrainingPipeline pipeline(config);
+    bool ok = pipeline.run(recordings, output);
+    const ML::TrainingPipelineStats& stats = pipeline.getStats();
+    std::cerr << stats.flights - stats.failed_flights << "/" << stats.flights << " flights, "
+              << stats.rows_scanned << " rows, " << stats.samples << " samples, "
+              << stats.decision_examples << " decision examples" << std::endl;
+    std::cerr << "scan " << stats.scan_seconds << " s, train " << stats.train_seconds << " s" << std::endl;
+    if (!ok) {
+        std::cerr << "No model pack written" << std::endl;
+        return 2;
+    }
+    std::cerr << "runway accuracy " << stats.metrics.runway.accuracy
+              << ", approach " << stats.metrics.approach.accuracy
+              << ", route " << stats.metrics.route.accuracy
+              << ", emergency " << stats.metrics.emergency.accuracy
+              << (stats.published ? "" : " (regressed, not kept)") << std::endl;
+    std::cout << output << std::endl;
+    return 0;
+}
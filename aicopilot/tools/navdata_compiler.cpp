@@ -0,0 +1,202 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Compiles an AIRAC navaid/airway CSV export into a navdata pack that
+* NavigationDatabase::LoadSnapshot maps without parsing.
+*
+* Usage: navdata_compiler [--cycle YYCC] [--landmarks ALT,...] [--stamp-variation]
+*                         <output> <navaids.csv> [airways.csv]
+*   --cycle YYCC    AIRAC cycle stored in the pack header (e.g. 2510)
+*   --stamp-variation
+*                   Fill in magnetic variation from the WMM grid for the
+*                   current date wherever the export leaves it blank
+*   --landmarks     Also write route landmarks to <output>.alt, one altitude
+*                   band per listed altitude (e.g. 10000,35000)
+*
+* Same formats as NavdataLoader, each with one header line:
+*   navaids: type,ident,region,airport,lat,lon,magvar,freq,range
+*   airways: ident,LOW|HIGH,start,end,min_alt,max_alt,...
+* Airway segments sharing an identifier are chained in file order.
+*****************************************************************************/
+
+#include "airway_landmarks.hpp"
+#include "magnetic_variation.hpp"
+#include "navdata_pack.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+using namespace AICopilot;
+
+namespace {
+
+// Trimmed comma-separated fields; unlike getline splitting, trailing empty fields are kept
+std::vector<std::string> splitFields(const std::string& line) {
+    std::vector<std::string> fields;
+    size_t begin = 0;
+    while (true) {
+        size_t comma = line.find(',', begin);
+        std::string token = line.substr(begin, comma == std::string::npos ? std::string::npos : comma - begin);
+        size_t start = token.find_first_not_of(" \t\r\n");
+        size_t end = token.find_last_not_of(" \t\r\n");
+        fields.push_back(start == std::string::npos ? std::string() : token.substr(start, end - start + 1));
+        if (comma == std::string::npos) break;
+        begin = comma + 1;
+    }
+    return fields;
+}
+
+double parseDouble(const std::string& field, double fallback) {
+    char* end = nullptr;
+    double value = std::strtod(field.c_str(), &end);
+    return end == field.c_str() ? fallback : value;
+}
+
+NavaidType parseType(const std::string& type) {
+    if (type == "VOR") return NavaidType::VOR;
+    if (type == "NDB") return NavaidType::NDB;
+    if (type == "DME") return NavaidType::DME;
+    if (type == "TACAN") return NavaidType::TACAN;
+    if (type == "FIX") return NavaidType::FIX;
+    if (type == "INT") return NavaidType::INTERSECTION;
+    if (type == "AIRPORT") return NavaidType::AIRPORT;
+    return NavaidType::UNKNOWN;
+}
+
+int addNavaids(NavdataPackBuilder& builder, const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line)) {
+        std::cerr << "Could not open " << path << std::endl;
+        return -1;
+    }
+
+    int count = 0;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::vector<std::string> fields = splitFields(line);
+        if (fields.size() < 9 || fields[1].empty()) continue;
+
+        NavdataWaypoint wp(fields[1], parseDouble(fields[4], 0.0), parseDouble(fields[5], 0.0),
+                    parseType(fields[0]), 0, parseDouble(fields[7], 0.0), fields[2]);
+        wp.magneticVariation = parseDouble(fields[6], 0.0);
+        wp.range = parseDouble(fields[8], 150.0);
+        if (!wp.IsValidCoordinate()) {
+            std::cerr << "Skipping navaid with invalid position: " << line << std::endl;
+            continue;
+        }
+        builder.putWaypoint(wp);
+        count++;
+    }
+    return count;
+}
+
+int addAirways(NavdataPackBuilder& builder, const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line)) {
+        std::cerr << "Could not open " << path << std::endl;
+        return -1;
+    }
+
+    // Identifier -> airway, in first-seen order
+    std::vector<Airway> airways;
+    std::unordered_map<std::string, size_t> byName;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::vector<std::string> fields = splitFields(line);
+        if (fields.size() < 6 || fields[0].empty()) continue;
+
+        int minAlt = static_cast<int>(parseDouble(fields[4], 0.0));
+        int maxAlt = static_cast<int>(parseDouble(fields[5], 0.0));
+        auto inserted = byName.emplace(fields[0], airways.size());
+        if (inserted.second) {
+            airways.emplace_back(fields[0], minAlt, maxAlt,
+                                 fields[1] == "HIGH" ? AirwayLevel::HIGH : AirwayLevel::LOW);
+        }
+
+        Airway& airway = airways[inserted.first->second];
+        airway.minimumAltitude = std::min(airway.minimumAltitude, minAlt);
+        airway.maximumAltitude = std::max(airway.maximumAltitude, maxAlt);
+        auto& sequence = airway.waypointSequence;
+        if (sequence.empty() || sequence.back() != fields[2]) sequence.push_back(fields[2]);
+        sequence.push_back(fields[3]);
+    }
+
+    for (const auto& airway : airways) builder.putAirway(airway);
+    return static_cast<int>(airways.size());
+}
+
+std::vector<int> parseAltitudes(const std::string& list) {
+    std::vector<int> altitudes;
+    for (const auto& field : splitFields(list)) {
+        if (!field.empty()) altitudes.push_back(static_cast<int>(parseDouble(field, 0.0)));
+    }
+    return altitudes;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    uint32_t cycle = 0;
+    std::vector<int> landmarkAltitudes;
+    bool stampVariation = false;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--cycle") == 0 && i + 1 < argc) {
+            cycle = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--landmarks") == 0 && i + 1 < argc) {
+            landmarkAltitudes = parseAltitudes(argv[++i]);
+        } else if (std::strcmp(argv[i], "--stamp-variation") == 0) {
+            stampVariation = true;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.size() < 2 || paths.size() > 3) {
+        std::cerr << "Usage: navdata_compiler [--cycle YYCC] [--landmarks ALT,...] [--stamp-variation]"
+                     " <output> <navaids.csv> [airways.csv]" << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    NavdataPackBuilder builder;
+    builder.setAiracCycle(cycle);
+    if (addNavaids(builder, paths[1]) < 0) {
+        return 2;
+    }
+    if (paths.size() == 3 && addAirways(builder, paths[2]) < 0) {
+        return 2;
+    }
+    if (stampVariation) {
+        size_t stamped = builder.stampMagneticVariation(*MagneticVariationGrid::current());
+        std::cout << "Stamped magnetic variation on " << stamped << " waypoint(s)" << std::endl;
+    }
+
+    if (!builder.write(paths[0])) {
+        return 3;
+    }
+
+    if (!landmarkAltitudes.empty()) {
+        // Built from the written pack so the tables carry its checksum
+        NavdataPack pack;
+        AirwayLandmarks landmarks;
+        std::string landmarkPath = AirwayLandmarks::pathFor(paths[0]);
+        if (!pack.open(paths[0]) || !landmarks.build(pack, landmarkAltitudes) || !landmarks.save(landmarkPath)) {
+            std::cerr << "Could not build route landmarks" << std::endl;
+            return 3;
+        }
+        std::cout << "Wrote " << landmarks.getBandCount() << " landmark band(s) to " << landmarkPath << std::endl;
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Compiled " << builder.getWaypointCount() << " waypoints and " << builder.getAirwayCount()
+              << " airways (" << paths[0] << ") in " << elapsed << " s" << std::endl;
+    return 0;
+}
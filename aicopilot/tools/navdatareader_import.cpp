@@ -0,0 +1,325 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Imports a navdatareader (Little Navmap schema) SQLite scenery database
+* into a navdata pack and a runway pack, so full MSFS/P3D scenery coverage
+* is available without SQLite queries or text parsing at runtime.
+*
+* Usage: navdatareader_import [--cycle YYCC] <navdata.pack> <runways.pack> <navdata.sqlite>
+*   --cycle YYCC    AIRAC cycle stored in the navdata pack header (e.g. 2510)
+*
+* Tables read, each in one streaming pass:
+*   navdata pack: airport, vor, ndb, waypoint, airway (joined to waypoint)
+*   runway pack:  airport, runway with both runway_end rows and their ils
+* Database frequencies are integers: VOR and ILS in MHz * 1000, NDB in
+* kHz * 100. Headings are true; magnetic headings are derived from the
+* airport's variation (east positive, as RunwayInfo).
+*
+* Taxi paths, parking and procedures have no section in either pack and
+* are left in the database.
+*****************************************************************************/
+
+#include "navdata_pack.hpp"
+#include "runway_pack.hpp"
+#include <sqlite3.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// Prepared statement stepped row by row; columns read by index
+class Query {
+public:
+    Query(sqlite3* db, const char* sql) {
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt_, nullptr) != SQLITE_OK) {
+            std::cerr << "Query failed: " << sqlite3_errmsg(db) << std::endl;
+            sqlite3_finalize(stmt_);
+            stmt_ = nullptr;
+        }
+    }
+    ~Query() { sqlite3_finalize(stmt_); }
+    Query(const Query&) = delete;
+    Query& operator=(const Query&) = delete;
+
+    bool ok() const { return stmt_ != nullptr; }
+    bool next() { return stmt_ && sqlite3_step(stmt_) == SQLITE_ROW; }
+
+    bool isNull(int column) const { return sqlite3_column_type(stmt_, column) == SQLITE_NULL; }
+    double real(int column) const { return sqlite3_column_double(stmt_, column); }
+    int integer(int column) const { return sqlite3_column_int(stmt_, column); }
+    std::string text(int column) const {
+        const unsigned char* value = sqlite3_column_text(stmt_, column);
+        return value ? reinterpret_cast<const char*>(value) : std::string();
+    }
+
+private:
+    sqlite3_stmt* stmt_ = nullptr;
+};
+
+int wrapHeading(double degrees) {
+    int heading = static_cast<int>(std::lround(std::fmod(degrees, 360.0)));
+    if (heading <= 0) heading += 360;
+    return heading > 360 ? heading - 360 : heading;
+}
+
+// navdatareader surface codes; anything without a RunwayInfo equivalent is UNKNOWN
+SurfaceType parseSurface(const std::string& surface) {
+    if (surface == "A" || surface == "T") return SurfaceType::ASPHALT;
+    if (surface == "C" || surface == "CE") return SurfaceType::CONCRETE;
+    if (surface == "G") return SurfaceType::GRASS;
+    if (surface == "GR" || surface == "CR") return SurfaceType::GRAVEL;
+    if (surface == "D" || surface == "CL" || surface == "S") return SurfaceType::DIRT;
+    if (surface == "W") return SurfaceType::WATER;
+    if (surface == "M") return SurfaceType::MACADAM;
+    if (surface == "B" || surface == "OT") return SurfaceType::BITUMINOUS;
+    if (surface == "BR") return SurfaceType::BRICK;
+    return SurfaceType::UNKNOWN;
+}
+
+NavaidType vorType(const std::string& type, bool dmeOnly) {
+    if (dmeOnly) return NavaidType::DME;
+    if (type.find('T') != std::string::npos) return NavaidType::TACAN;
+    return NavaidType::VOR;
+}
+
+int addAirports(sqlite3* db, NavdataPackBuilder& navdata, RunwayPackBuilder& runways) {
+    Query query(db, "SELECT ident, name, laty, lonx, altitude, mag_var, is_military FROM airport");
+    if (!query.ok()) return -1;
+
+    int count = 0;
+    while (query.next()) {
+        std::string ident = query.text(0);
+        if (ident.empty()) continue;
+
+        RunwayAirportInfo airport;
+        airport.icao = ident;
+        airport.name = query.text(1);
+        airport.latitude = query.real(2);
+        airport.longitude = query.real(3);
+        airport.elevation = query.integer(4);
+        airport.magneticVariation = query.real(5);
+        airport.classification = query.integer(6) ? "Military" : "Civil";
+        runways.putAirport(airport);
+
+        NavdataWaypoint wp(ident, airport.latitude, airport.longitude, NavaidType::AIRPORT, airport.elevation);
+        wp.magneticVariation = airport.magneticVariation;
+        navdata.putWaypoint(wp);
+        count++;
+    }
+    return count;
+}
+
+int addRadioNavaids(sqlite3* db, NavdataPackBuilder& builder) {
+    int count = 0;
+    {
+        Query query(db, "SELECT ident, region, type, frequency, range, mag_var, altitude, laty, lonx, dme_only "
+                        "FROM vor");
+        if (!query.ok()) return -1;
+        while (query.next()) {
+            NavdataWaypoint wp(query.text(0), query.real(7), query.real(8), vorType(query.text(2), query.integer(9)),
+                               query.real(6), query.real(3) / 1000.0, query.text(1));
+            wp.range = query.real(4);
+            wp.magneticVariation = query.real(5);
+            if (wp.name.empty() || !wp.IsValidCoordinate()) continue;
+            builder.putWaypoint(wp);
+            count++;
+        }
+    }
+
+    Query query(db, "SELECT ident, region, frequency, range, mag_var, altitude, laty, lonx FROM ndb");
+    if (!query.ok()) return -1;
+    while (query.next()) {
+        NavdataWaypoint wp(query.text(0), query.real(6), query.real(7), NavaidType::NDB, query.real(5),
+                           query.real(2) / 100.0, query.text(1));
+        wp.range = query.real(3);
+        wp.magneticVariation = query.real(4);
+        if (wp.name.empty() || !wp.IsValidCoordinate()) continue;
+        builder.putWaypoint(wp);
+        count++;
+    }
+    return count;
+}
+
+int addWaypoints(sqlite3* db, NavdataPackBuilder& builder) {
+    // VOR and NDB waypoints repeat the radio navaid rows already added
+    Query query(db, "SELECT ident, region, mag_var, laty, lonx FROM waypoint WHERE type NOT IN ('V', 'N')");
+    if (!query.ok()) return -1;
+
+    int count = 0;
+    while (query.next()) {
+        NavdataWaypoint wp(query.text(0), query.real(3), query.real(4), NavaidType::FIX, 0.0, 0.0, query.text(1));
+        wp.magneticVariation = query.real(2);
+        if (wp.name.empty() || !wp.IsValidCoordinate()) continue;
+        builder.putWaypoint(wp);
+        count++;
+    }
+    return count;
+}
+
+int addAirways(sqlite3* db, NavdataPackBuilder& builder) {
+    // Fragments of one airway are chained in fragment then sequence order, as navdata_compiler does
+    Query query(db,
+                "SELECT a.airway_name, a.airway_type, f.ident, t.ident, a.minimum_altitude, a.maximum_altitude "
+                "FROM airway a "
+                "JOIN waypoint f ON f.waypoint_id = a.from_waypoint_id "
+                "JOIN waypoint t ON t.waypoint_id = a.to_waypoint_id "
+                "ORDER BY a.airway_name, a.airway_fragment_no, a.sequence_no");
+    if (!query.ok()) return -1;
+
+    std::vector<Airway> airways;
+    std::unordered_map<std::string, size_t> byName;
+    while (query.next()) {
+        std::string name = query.text(0);
+        if (name.empty()) continue;
+
+        int minAlt = query.integer(4);
+        int maxAlt = query.isNull(5) ? 60000 : query.integer(5);
+        auto inserted = byName.emplace(name, airways.size());
+        if (inserted.second) {
+            // V are victor (low), J jet (high), B both: routed with the low set
+            airways.emplace_back(name, minAlt, maxAlt, query.text(1) == "J" ? AirwayLevel::HIGH : AirwayLevel::LOW);
+        }
+
+        Airway& airway = airways[inserted.first->second];
+        airway.minimumAltitude = std::min(airway.minimumAltitude, minAlt);
+        airway.maximumAltitude = std::max(airway.maximumAltitude, maxAlt);
+        std::string from = query.text(2);
+        auto& sequence = airway.waypointSequence;
+        if (sequence.empty() || sequence.back() != from) sequence.push_back(from);
+        sequence.push_back(query.text(3));
+    }
+
+    for (const auto& airway : airways) builder.putAirway(airway);
+    return static_cast<int>(airways.size());
+}
+
+// One runway end: 12 columns from offset, the ILS columns at ils
+RunwayInfo readRunwayEnd(const Query& query, int offset, int ils) {
+    RunwayInfo rwy;
+    rwy.icao = query.text(0);
+    rwy.airportName = query.text(1);
+    rwy.magneticVariation = query.real(2);
+    rwy.length = query.integer(3);
+    rwy.width = query.integer(4);
+    rwy.surface = parseSurface(query.text(5));
+    rwy.hasRunwayLights = !query.isNull(6) && !query.text(6).empty();
+
+    rwy.runwayId = query.text(offset);
+    rwy.headingTrue = wrapHeading(query.real(offset + 1));
+    rwy.headingMagnetic = wrapHeading(query.real(offset + 1) - rwy.magneticVariation);
+    rwy.latitude = query.real(offset + 2);
+    rwy.longitude = query.real(offset + 3);
+    rwy.elevation = query.integer(offset + 4);
+    rwy.displacedDistance = query.integer(offset + 5);
+    rwy.displaceThreshold = rwy.displacedDistance > 0;
+    rwy.hasALS = !query.isNull(offset + 6) && !query.text(offset + 6).empty();
+    rwy.hasREIL = query.integer(offset + 7) != 0;
+    rwy.hasVGSI = !query.isNull(offset + 8) && !query.text(offset + 8).empty();
+    rwy.vgsiType = query.text(offset + 8);
+    rwy.TORA = rwy.TODA = rwy.ASDA = rwy.length;
+    rwy.LDA = rwy.length - rwy.displacedDistance;
+
+    if (!query.isNull(ils)) {
+        RunwayILSData& data = rwy.ilsData;
+        data.hasILS = true;
+        data.identifier = query.text(ils);
+        data.localizerFrequency = query.real(ils + 1) / 1000.0;
+        data.localizerCourse = wrapHeading(query.real(ils + 2) - rwy.magneticVariation);
+        if (!query.isNull(ils + 3) && query.real(ils + 3) > 0.0) {
+            data.glideslopeAngle = query.real(ils + 3);
+            data.category = ILSCategory::CAT_I;
+            data.decisionHeight = 200;
+            data.minimumRVR = 1800;
+        }
+    }
+    return rwy;
+}
+
+int addRunways(sqlite3* db, RunwayPackBuilder& builder) {
+    // End columns: name, heading, laty, lonx, altitude, offset_threshold,
+    // app_light_system_type, has_reils, left_vasi_type, then the 4 ILS columns
+#define RUNWAY_END_COLUMNS(e, i) \
+    e ".name, " e ".heading, " e ".laty, " e ".lonx, " e ".altitude, " e ".offset_threshold, " \
+    e ".app_light_system_type, " e ".has_reils, " e ".left_vasi_type, " \
+    i ".ident, " i ".frequency, " i ".loc_heading, " i ".gs_pitch"
+    Query query(db,
+                "SELECT ap.ident, ap.name, ap.mag_var, r.length, r.width, r.surface, r.edge_light, "
+                RUNWAY_END_COLUMNS("p", "pi") ", " RUNWAY_END_COLUMNS("s", "si") " "
+                "FROM runway r "
+                "JOIN airport ap ON ap.airport_id = r.airport_id "
+                "JOIN runway_end p ON p.runway_end_id = r.primary_end_id "
+                "JOIN runway_end s ON s.runway_end_id = r.secondary_end_id "
+                "LEFT JOIN ils pi ON pi.loc_runway_end_id = p.runway_end_id "
+                "LEFT JOIN ils si ON si.loc_runway_end_id = s.runway_end_id");
+#undef RUNWAY_END_COLUMNS
+    if (!query.ok()) return -1;
+
+    int count = 0;
+    while (query.next()) {
+        if (query.text(0).empty()) continue;
+        for (int offset : {7, 20}) {
+            RunwayInfo rwy = readRunwayEnd(query, offset, offset + 9);
+            if (rwy.runwayId.empty()) continue;
+            builder.putRunway(rwy);
+            count++;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    uint32_t cycle = 0;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--cycle") == 0 && i + 1 < argc) {
+            cycle = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.size() != 3) {
+        std::cerr << "Usage: navdatareader_import [--cycle YYCC] <navdata.pack> <runways.pack> <navdata.sqlite>"
+                  << std::endl;
+        return 1;
+    }
+
+    sqlite3* db = nullptr;
+    if (sqlite3_open_v2(paths[2].c_str(), &db, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+        std::cerr << "Could not open " << paths[2] << ": " << sqlite3_errmsg(db) << std::endl;
+        sqlite3_close(db);
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    NavdataPackBuilder navdata;
+    navdata.setAiracCycle(cycle);
+    RunwayPackBuilder runways;
+    bool read = addAirports(db, navdata, runways) >= 0 && addRadioNavaids(db, navdata) >= 0 &&
+                addWaypoints(db, navdata) >= 0 && addAirways(db, navdata) >= 0 && addRunways(db, runways) >= 0;
+    sqlite3_close(db);
+    if (!read) {
+        return 2;
+    }
+
+    if (!navdata.write(paths[0]) || !runways.write(paths[1])) {
+        return 3;
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Imported " << navdata.getWaypointCount() << " waypoints and " << navdata.getAirwayCount()
+              << " airways (" << paths[0] << "), " << runways.getAirportCount() << " airports and "
+              << runways.getRunwayCount() << " runways (" << paths[1] << ") in " << elapsed << " s" << std::endl;
+    return 0;
+}
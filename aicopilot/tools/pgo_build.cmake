@@ -0,0 +1,196 @@
+#############################################################################
+# Copyright 2025 AI Copilot FS Project
+#
+# Profile-guided build: instrument, train on the benchmarks, rebuild with
+# the profiles, then run the same benchmarks on a plain LTO build and the
+# PGO build and print the speedup.
+#
+# Usage (from the source root):
+#   cmake [-DBUILD_ROOT=out/pgo] [-DCAPTURE=flight.cap -DAIRCRAFT=aircraft.cfg]
+#         [-DEXTRA_ARGS="-DGTest_DIR=...;-DENABLE_AVX2=OFF"] -P aicopilot/tools/pgo_build.cmake
+#
+#   BUILD_ROOT  Parent of the baseline and pgo build trees (default out/pgo)
+#   CAPTURE     SimConnect capture; adds the replay_benchmark full flight to
+#               training and to the comparison (needs a SimConnect build)
+#   AIRCRAFT    aircraft.cfg for the capture
+#   EXTRA_ARGS  Extra configure arguments for both trees, ;-separated
+#
+# The optimized binaries are left in <BUILD_ROOT>/pgo/bin.
+#############################################################################
+
+cmake_minimum_required(VERSION 3.19)
+
+get_filename_component(SOURCE_DIR "${CMAKE_CURRENT_LIST_DIR}/../.." ABSOLUTE)
+if(NOT BUILD_ROOT)
+    set(BUILD_ROOT "${SOURCE_DIR}/out/pgo")
+endif()
+get_filename_component(BUILD_ROOT "${BUILD_ROOT}" ABSOLUTE BASE_DIR "${SOURCE_DIR}")
+set(BASELINE_DIR "${BUILD_ROOT}/baseline")
+set(PGO_DIR "${BUILD_ROOT}/pgo")
+set(PROFILE_DIR "${BUILD_ROOT}/profiles")
+set(RESULTS_DIR "${BUILD_ROOT}/results")
+
+set(CONFIGURE_ARGS
+    -DCMAKE_BUILD_TYPE=Release
+    -DBUILD_BENCHMARKS=ON
+    -DBUILD_TESTS=OFF
+    -DENABLE_LTO=ON
+    -DENABLE_AVX2=ON
+    -DENABLE_TRACING=ON
+    -DPGO_PROFILE_DIR=${PROFILE_DIR}
+    ${EXTRA_ARGS})
+if(NOT CMAKE_HOST_WIN32)
+    list(APPEND CONFIGURE_ARGS -DBUILD_WITHOUT_SIMCONNECT=ON)
+endif()
+
+set(TARGETS aicopilot_bench traffic_benchmark)
+if(CAPTURE)
+    list(APPEND TARGETS replay_benchmark)
+endif()
+
+function(run_step description)
+    message(STATUS "${description}")
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "${description} failed (${result})")
+    endif()
+endfunction()
+
+function(build_tree dir mode)
+    run_step("Configuring ${dir} (PGO_MODE=${mode})"
+        ${CMAKE_COMMAND} -S ${SOURCE_DIR} -B ${dir} ${CONFIGURE_ARGS} -DPGO_MODE=${mode})
+    foreach(target ${TARGETS})
+        run_step("Building ${target} (PGO_MODE=${mode})"
+            ${CMAKE_COMMAND} --build ${dir} --config Release --target ${target})
+    endforeach()
+endfunction()
+
+# Multi-config generators put binaries in bin/Release
+function(find_tool dir name out)
+    foreach(candidate "${dir}/bin/${name}" "${dir}/bin/Release/${name}"
+                      "${dir}/bin/${name}.exe" "${dir}/bin/Release/${name}.exe")
+        if(EXISTS "${candidate}")
+            set(${out} "${candidate}" PARENT_SCOPE)
+            return()
+        endif()
+    endforeach()
+    message(FATAL_ERROR "${name} not found under ${dir}/bin")
+endfunction()
+
+# The workload is the same for training and measuring: microbenchmarks,
+# the traffic scenes and, with a capture, the full flight
+function(run_workload dir tag)
+    find_tool(${dir} aicopilot_bench bench)
+    find_tool(${dir} traffic_benchmark traffic)
+    run_step("Running aicopilot_bench (${tag})"
+        ${bench} --benchmark_min_time=0.2 --benchmark_repetitions=3 --benchmark_report_aggregates_only=true
+        --benchmark_out=${RESULTS_DIR}/${tag}-bench.json --benchmark_out_format=json)
+    run_step("Running traffic_benchmark (${tag})"
+        ${traffic} --iterations 20 --json ${RESULTS_DIR}/${tag}-traffic.json)
+    if(CAPTURE)
+        find_tool(${dir} replay_benchmark replay)
+        run_step("Running replay_benchmark (${tag})"
+            ${replay} ${CAPTURE} ${AIRCRAFT} --json ${RESULTS_DIR}/${tag}-replay.json)
+    endif()
+endfunction()
+
+# Google Benchmark writes times like 2.3826377311629321e+03; math() only
+# takes integers, so keep thousandths
+function(to_thousandths value out)
+    if(NOT value MATCHES "^([0-9]+)(\\.([0-9]*))?([eE]([-+]?[0-9]+))?$")
+        message(FATAL_ERROR "Unexpected time: ${value}")
+    endif()
+    set(digits "${CMAKE_MATCH_1}${CMAKE_MATCH_3}")
+    set(exponent 0)
+    if(CMAKE_MATCH_5)
+        string(REGEX REPLACE "^\\+" "" exponent "${CMAKE_MATCH_5}")
+    endif()
+    string(LENGTH "${CMAKE_MATCH_1}" point)
+    math(EXPR point "${point} + ${exponent} + 3")
+    string(LENGTH "${digits}" length)
+    if(point LESS_EQUAL 0)
+        set(${out} 0 PARENT_SCOPE)
+        return()
+    elseif(point GREATER length)
+        math(EXPR pad "${point} - ${length}")
+        string(REPEAT "0" ${pad} zeros)
+        set(digits "${digits}${zeros}")
+    else()
+        string(SUBSTRING "${digits}" 0 ${point} digits)
+    endif()
+    string(REGEX REPLACE "^0+([0-9])" "\\1" digits "${digits}")
+    set(${out} ${digits} PARENT_SCOPE)
+endfunction()
+
+# Median real time per benchmark, keyed by name
+function(read_medians file prefix)
+    file(READ "${file}" json)
+    string(JSON count LENGTH "${json}" benchmarks)
+    math(EXPR last "${count} - 1")
+    set(names "")
+    foreach(i RANGE ${last})
+        string(JSON aggregate ERROR_VARIABLE missing GET "${json}" benchmarks ${i} aggregate_name)
+        if(NOT aggregate STREQUAL "median")
+            continue()
+        endif()
+        string(JSON name GET "${json}" benchmarks ${i} run_name)
+        string(JSON time GET "${json}" benchmarks ${i} real_time)
+        string(JSON unit GET "${json}" benchmarks ${i} time_unit)
+        to_thousandths(${time} time)
+        string(MAKE_C_IDENTIFIER "${name}" key)
+        set(${prefix}_${key} ${time} PARENT_SCOPE)
+        set(${prefix}_${key}_UNIT ${unit} PARENT_SCOPE)
+        list(APPEND names "${name}")
+    endforeach()
+    set(${prefix}_NAMES "${names}" PARENT_SCOPE)
+endfunction()
+
+file(MAKE_DIRECTORY ${RESULTS_DIR})
+
+# 1. Plain LTO build as the baseline
+build_tree(${BASELINE_DIR} OFF)
+run_workload(${BASELINE_DIR} baseline)
+
+# 2. Instrumented build and training run, from clean profiles
+file(REMOVE_RECURSE ${PROFILE_DIR})
+file(MAKE_DIRECTORY ${PROFILE_DIR})
+build_tree(${PGO_DIR} GENERATE)
+run_workload(${PGO_DIR} training)
+
+# 3. Clang writes raw profiles that must be merged first
+file(GLOB RAW_PROFILES "${PROFILE_DIR}/*.profraw")
+if(RAW_PROFILES)
+    find_program(LLVM_PROFDATA NAMES llvm-profdata REQUIRED)
+    run_step("Merging ${PROFILE_DIR}"
+        ${LLVM_PROFDATA} merge -output=${PROFILE_DIR}/default.profdata ${RAW_PROFILES})
+endif()
+
+# 4. Same tree rebuilt from the profiles (MSVC keeps its .pgd files there)
+build_tree(${PGO_DIR} USE)
+run_workload(${PGO_DIR} pgo)
+
+# 5. Report
+read_medians(${RESULTS_DIR}/baseline-bench.json BASE)
+read_medians(${RESULTS_DIR}/pgo-bench.json PGO)
+message(STATUS "")
+message(STATUS "Median real time, LTO baseline vs. LTO+PGO (results in ${RESULTS_DIR})")
+foreach(name ${BASE_NAMES})
+    string(MAKE_C_IDENTIFIER "${name}" key)
+    if(NOT DEFINED PGO_${key})
+        continue()
+    endif()
+    if(PGO_${key} EQUAL 0)
+        continue()
+    endif()
+    math(EXPR ratio "100 * ${BASE_${key}} / ${PGO_${key}}")
+    math(EXPR whole "${ratio} / 100")
+    math(EXPR hundredths "${ratio} % 100")
+    if(hundredths LESS 10)
+        set(hundredths "0${hundredths}")
+    endif()
+    math(EXPR base "${BASE_${key}} / 1000")
+    math(EXPR pgo "${PGO_${key}} / 1000")
+    message(STATUS "  ${name}: ${base} -> ${pgo} ${BASE_${key}_UNIT} (${whole}.${hundredths}x)")
+endforeach()
+message(STATUS "")
+message(STATUS "PGO binaries: ${PGO_DIR}/bin")
@@ -0,0 +1,300 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Replays a SimConnect capture through AIPilot as a full-flight macro
+* benchmark: simulated seconds per wall second, update latency, time per
+* subsystem, heap allocations per update and peak resident memory.
+*
+* Usage: replay_benchmark <capture> <aircraft.cfg> [flight.pln] [--realtime] [--json [file]]
+*   --realtime  Pace the capture by its recorded timestamps
+*   --json      Write the results as JSON to stdout or the named file
+*
+* The per-subsystem breakdown comes from TRACE_SCOPE events, so it needs a
+* build with ENABLE_TRACING; scheduler run counts are always reported.
+*****************************************************************************/
+
+#include "ai_pilot.h"
+#include "hot_path_trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Every heap allocation in the process, workers included, so the count per
+// update covers everything a tick causes
+namespace {
+std::atomic<size_t> g_allocations{0};
+}
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+using namespace AICopilot;
+
+namespace {
+
+// Trace rings hold 8192 events per thread; draining this often keeps a
+// full tick's scopes well inside one ring
+constexpr uint64_t TRACE_DRAIN_TICKS = 256;
+
+struct SubsystemTime {
+    uint64_t count = 0;
+    uint64_t totalNs = 0;
+    uint64_t maxNs = 0;
+};
+
+struct Result {
+    size_t updates = 0;
+    double simulatedSec = 0.0;
+    double wallSec = 0.0;
+    double meanUs = 0.0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+    double allocationsPerUpdate = 0.0;
+    size_t peakRssBytes = 0;
+    std::map<std::string, SubsystemTime> subsystems;
+    std::vector<ScheduledTaskStats> tasks;
+};
+
+size_t peakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);          // bytes
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;   // kilobytes
+#endif
+#endif
+}
+
+void drainTrace(std::map<std::string, SubsystemTime>& subsystems) {
+    for (const TraceSummary& entry : HotPathTracer::summarize()) {
+        SubsystemTime& time = subsystems[entry.name];
+        time.count += entry.count;
+        time.totalNs += entry.totalNs;
+        time.maxNs = std::max(time.maxNs, entry.maxNs);
+    }
+    HotPathTracer::clear();
+}
+
+// Subsystems by total time, largest first
+std::vector<std::pair<std::string, SubsystemTime>> sortedSubsystems(const Result& r) {
+    std::vector<std::pair<std::string, SubsystemTime>> sorted(r.subsystems.begin(), r.subsystems.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second.totalNs > b.second.totalNs;
+    });
+    return sorted;
+}
+
+void writeJson(std::ostream& out, const Result& r) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"benchmark\": \"replay_benchmark\",\n";
+    out << "  \"updates\": " << r.updates << ", \"simulated_sec\": " << r.simulatedSec
+        << ", \"wall_sec\": " << r.wallSec
+        << ", \"sim_sec_per_wall_sec\": " << (r.wallSec > 0.0 ? r.simulatedSec / r.wallSec : 0.0) << ",\n";
+    out << "  \"latency_us\": {\"mean\": " << r.meanUs << ", \"p50\": " << r.p50Us << ", \"p99\": " << r.p99Us
+        << ", \"max\": " << r.maxUs << "},\n";
+    out << "  \"allocations_per_update\": " << r.allocationsPerUpdate << ", \"peak_rss_bytes\": " << r.peakRssBytes
+        << ",\n";
+
+    auto sorted = sortedSubsystems(r);
+    out << "  \"subsystems\": [\n";
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        const SubsystemTime& time = sorted[i].second;
+        out << "    {\"name\": \"" << sorted[i].first << "\", \"count\": " << time.count
+            << ", \"total_ms\": " << time.totalNs * 1e-6 << ", \"mean_us\": "
+            << (time.count ? time.totalNs * 1e-3 / time.count : 0.0) << ", \"max_us\": " << time.maxNs * 1e-3
+            << "}" << (i + 1 < sorted.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n  \"tasks\": [\n";
+    for (size_t i = 0; i < r.tasks.size(); ++i) {
+        const ScheduledTaskStats& task = r.tasks[i];
+        out << "    {\"name\": \"" << task.name << "\", \"runs\": " << task.runCount
+            << ", \"max_ms\": " << task.maxDurationMs << ", \"deadline_misses\": " << task.deadlineMisses << "}"
+            << (i + 1 < r.tasks.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+void writeText(std::ostream& out, const Result& r) {
+    out << "\nReplay benchmark" << std::endl;
+    out << "================" << std::endl;
+    out << "Updates:      " << r.updates << std::endl;
+    out << "Simulated:    " << r.simulatedSec << " s" << std::endl;
+    out << "Elapsed:      " << r.wallSec << " s" << std::endl;
+    out << "Speed:        " << (r.wallSec > 0.0 ? r.simulatedSec / r.wallSec : 0.0) << " sim s/wall s" << std::endl;
+    out << "Throughput:   " << (r.updates / r.wallSec) << " updates/s" << std::endl;
+    out << "Latency mean: " << r.meanUs << " us" << std::endl;
+    out << "Latency p50:  " << r.p50Us << " us" << std::endl;
+    out << "Latency p99:  " << r.p99Us << " us" << std::endl;
+    out << "Latency max:  " << r.maxUs << " us" << std::endl;
+    out << "Allocations:  " << r.allocationsPerUpdate << " per update" << std::endl;
+    out << "Peak RSS:     " << (r.peakRssBytes / (1024.0 * 1024.0)) << " MiB" << std::endl;
+
+    if (!r.subsystems.empty()) {
+        out << "\n" << std::left << std::setw(28) << "subsystem" << std::right << std::setw(10) << "count"
+            << std::setw(12) << "total ms" << std::setw(10) << "% wall" << std::setw(10) << "mean us"
+            << std::setw(10) << "max us" << std::endl;
+        for (const auto& entry : sortedSubsystems(r)) {
+            const SubsystemTime& time = entry.second;
+            out << std::left << std::setw(28) << entry.first << std::right << std::setw(10) << time.count
+                << std::fixed << std::setprecision(1) << std::setw(12) << time.totalNs * 1e-6 << std::setw(10)
+                << (r.wallSec > 0.0 ? time.totalNs * 1e-7 / r.wallSec : 0.0) << std::setw(10)
+                << (time.count ? time.totalNs * 1e-3 / time.count : 0.0) << std::setw(10) << time.maxNs * 1e-3
+                << std::defaultfloat << std::endl;
+        }
+    }
+
+    out << "\n" << std::left << std::setw(28) << "task" << std::right << std::setw(10) << "runs"
+        << std::setw(10) << "max ms" << std::setw(10) << "misses" << std::endl;
+    for (const ScheduledTaskStats& task : r.tasks) {
+        out << std::left << std::setw(28) << task.name << std::right << std::setw(10) << task.runCount
+            << std::fixed << std::setprecision(2) << std::setw(10) << task.maxDurationMs << std::defaultfloat
+            << std::setw(10) << task.deadlineMisses << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: replay_benchmark <capture> <aircraft.cfg> [flight.pln] [--realtime] [--json [file]]"
+                  << std::endl;
+        return 1;
+    }
+
+    ReplayPacing pacing = ReplayPacing::AS_FAST_AS_POSSIBLE;
+    const char* flightPlan = nullptr;
+    bool json = false;
+    const char* jsonPath = nullptr;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--realtime") == 0) {
+            pacing = ReplayPacing::WALL_CLOCK;
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') jsonPath = argv[++i];
+        } else {
+            flightPlan = argv[i];
+        }
+    }
+
+    AIPilot pilot;
+    if (!pilot.initializeReplay(argv[1], pacing)) {
+        return 2;
+    }
+    if (!pilot.loadAircraftConfig(argv[2])) {
+        return 3;
+    }
+    if (flightPlan != nullptr && !pilot.loadFlightPlan(flightPlan)) {
+        return 4;
+    }
+
+    pilot.startAutonomousFlight();
+
+    // Same 20 Hz cadence as the live example when pacing by wall clock
+    const auto updatePeriod = std::chrono::milliseconds(50);
+    auto nextUpdate = std::chrono::steady_clock::now();
+
+    Result result;
+    std::vector<double> latenciesUs;
+    latenciesUs.reserve(1 << 16);
+
+    HotPathTracer::clear();
+    HotPathTracer::enable();
+    // Setup allocations are excluded; the vector above is reserved so its
+    // growth rarely lands in the count
+    size_t allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+    size_t benchmarkAllocations = 0;   // made by the trace drain, not the pilot
+
+    auto start = std::chrono::steady_clock::now();
+    while (pilot.isActive() && pilot.isConnected()) {
+        auto t0 = std::chrono::steady_clock::now();
+        pilot.update();
+        auto t1 = std::chrono::steady_clock::now();
+        latenciesUs.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+
+        if (latenciesUs.size() % TRACE_DRAIN_TICKS == 0) {
+            size_t beforeDrain = g_allocations.load(std::memory_order_relaxed);
+            drainTrace(result.subsystems);
+            benchmarkAllocations += g_allocations.load(std::memory_order_relaxed) - beforeDrain;
+        }
+        if (pacing == ReplayPacing::WALL_CLOCK) {
+            nextUpdate += updatePeriod;
+            std::this_thread::sleep_until(nextUpdate);
+        }
+    }
+    result.wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t allocations = g_allocations.load(std::memory_order_relaxed) - allocationsBefore - benchmarkAllocations;
+    result.simulatedSec = pilot.getReplayTime();
+    result.tasks = pilot.getSchedulerStats();
+
+    pilot.stopAutonomousFlight();
+    drainTrace(result.subsystems);
+    HotPathTracer::disable();
+
+    if (latenciesUs.empty()) {
+        std::cerr << "Capture produced no updates" << std::endl;
+        return 5;
+    }
+
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    auto percentile = [&latenciesUs](double p) {
+        size_t index = static_cast<size_t>(p * (latenciesUs.size() - 1));
+        return latenciesUs[index];
+    };
+    double total = 0.0;
+    for (double value : latenciesUs) total += value;
+
+    result.updates = latenciesUs.size();
+    result.meanUs = total / latenciesUs.size();
+    result.p50Us = percentile(0.50);
+    result.p99Us = percentile(0.99);
+    result.maxUs = latenciesUs.back();
+    result.allocationsPerUpdate = static_cast<double>(allocations) / latenciesUs.size();
+    result.peakRssBytes = peakResidentBytes();
+
+    if (!json) {
+        writeText(std::cout, result);
+        return 0;
+    }
+    if (jsonPath) {
+        std::ofstream file(jsonPath);
+        if (!file) {
+            std::cerr << "Cannot write " << jsonPath << std::endl;
+            return 6;
+        }
+        writeJson(file, result);
+    } else {
+        writeJson(std::cout, result);
+    }
+    return 0;
+}
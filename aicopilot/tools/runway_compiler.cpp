@@ -0,0 +1,183 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Compiles the built-in runway data and runway CSV files into a runway pack
+* that RunwayDatabase::LoadPack maps without parsing.
+*
+* Usage: runway_compiler [--no-builtin] <output> [runways.csv...]
+*   --no-builtin    Leave out RunwayDatabase's built-in airports
+*
+* CSV format as data/runways/runway_database.csv, '#' lines skipped:
+*   ICAO,RwyID,Lat,Lon,Hdg,Length,Width,Surface,ILS,LocFreq,GSFreq,Course,
+*   DH,Category,RVR,TODA,TORA,LDA,ASDA
+* A CSV row replaces a built-in runway with the same ICAO and ID; airports
+* known only from CSV rows get an entry at their first runway's position.
+*****************************************************************************/
+
+#include "runway_database_prod.hpp"
+#include "runway_pack.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+// Trimmed comma-separated fields; unlike getline splitting, trailing empty fields are kept
+std::vector<std::string> splitFields(const std::string& line) {
+    std::vector<std::string> fields;
+    size_t begin = 0;
+    while (true) {
+        size_t comma = line.find(',', begin);
+        std::string token = line.substr(begin, comma == std::string::npos ? std::string::npos : comma - begin);
+        size_t start = token.find_first_not_of(" \t\r\n");
+        size_t end = token.find_last_not_of(" \t\r\n");
+        fields.push_back(start == std::string::npos ? std::string() : token.substr(start, end - start + 1));
+        if (comma == std::string::npos) break;
+        begin = comma + 1;
+    }
+    return fields;
+}
+
+double parseDouble(const std::string& field, double fallback) {
+    char* end = nullptr;
+    double value = std::strtod(field.c_str(), &end);
+    return end == field.c_str() ? fallback : value;
+}
+
+int parseInt(const std::string& field, int fallback) {
+    return static_cast<int>(parseDouble(field, fallback));
+}
+
+SurfaceType parseSurface(const std::string& surface) {
+    if (surface == "ASPH") return SurfaceType::ASPHALT;
+    if (surface == "CONC") return SurfaceType::CONCRETE;
+    if (surface == "GRASS" || surface == "TURF") return SurfaceType::GRASS;
+    if (surface == "GRVL") return SurfaceType::GRAVEL;
+    if (surface == "DIRT") return SurfaceType::DIRT;
+    if (surface == "WATER") return SurfaceType::WATER;
+    return SurfaceType::UNKNOWN;
+}
+
+ILSCategory parseCategory(const std::string& category) {
+    if (category == "I") return ILSCategory::CAT_I;
+    if (category == "II") return ILSCategory::CAT_II;
+    if (category == "IIIA" || category == "III") return ILSCategory::CAT_IIIA;
+    if (category == "IIIB") return ILSCategory::CAT_IIIB;
+    if (category == "IIIC") return ILSCategory::CAT_IIIC;
+    return ILSCategory::NONE;
+}
+
+int addBuiltin(RunwayPackBuilder& builder, std::set<std::string>& airports) {
+    RunwayDatabase db;
+    db.Initialize();
+    for (const std::string& icao : db.GetAirportCodes()) {
+        RunwayAirportInfo airport;
+        if (db.GetAirportInfo(icao, airport)) {
+            builder.putAirport(airport);
+            airports.insert(icao);
+        }
+        for (const RunwayInfo& rwy : db.GetRunways(icao)) {
+            builder.putRunway(rwy);
+        }
+    }
+    return db.GetRunwayCount();
+}
+
+int addRunwayCSV(RunwayPackBuilder& builder, std::set<std::string>& airports, const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Could not open " << path << std::endl;
+        return -1;
+    }
+
+    int count = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::vector<std::string> fields = splitFields(line);
+        if (fields.size() < 19 || fields[0].empty() || fields[1].empty() || fields[0] == "ICAO") continue;
+
+        RunwayInfo rwy;
+        rwy.icao = fields[0];
+        rwy.runwayId = fields[1];
+        rwy.latitude = parseDouble(fields[2], 0.0);
+        rwy.longitude = parseDouble(fields[3], 0.0);
+        rwy.headingMagnetic = parseInt(fields[4], 0);
+        rwy.headingTrue = rwy.headingMagnetic;
+        rwy.length = parseInt(fields[5], 0);
+        rwy.width = parseInt(fields[6], 0);
+        rwy.surface = parseSurface(fields[7]);
+        rwy.ilsData.hasILS = fields[8] == "1";
+        if (rwy.ilsData.hasILS) {
+            rwy.ilsData.localizerFrequency = parseDouble(fields[9], 0.0);
+            rwy.ilsData.glideslopeFrequency = parseDouble(fields[10], 0.0);
+            rwy.ilsData.localizerCourse = parseInt(fields[11], rwy.headingMagnetic);
+            rwy.ilsData.decisionHeight = parseInt(fields[12], 0);
+            rwy.ilsData.category = parseCategory(fields[13]);
+            rwy.ilsData.minimumRVR = parseInt(fields[14], 0);
+        }
+        rwy.TODA = parseInt(fields[15], rwy.length);
+        rwy.TORA = parseInt(fields[16], rwy.length);
+        rwy.LDA = parseInt(fields[17], rwy.length);
+        rwy.ASDA = parseInt(fields[18], rwy.length);
+        builder.putRunway(rwy);
+        count++;
+
+        if (airports.insert(rwy.icao).second) {
+            RunwayAirportInfo airport;
+            airport.icao = rwy.icao;
+            airport.latitude = rwy.latitude;
+            airport.longitude = rwy.longitude;
+            airport.hasMajorILS = rwy.ilsData.hasILS;
+            builder.putAirport(airport);
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool builtin = true;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--no-builtin") == 0) {
+            builtin = false;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.empty() || (!builtin && paths.size() < 2)) {
+        std::cerr << "Usage: runway_compiler [--no-builtin] <output> [runways.csv...]" << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    RunwayPackBuilder builder;
+    std::set<std::string> airports;
+    if (builtin) {
+        addBuiltin(builder, airports);
+    }
+    for (size_t i = 1; i < paths.size(); ++i) {
+        if (addRunwayCSV(builder, airports, paths[i]) < 0) {
+            return 2;
+        }
+    }
+
+    if (!builder.write(paths[0])) {
+        return 3;
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Compiled " << builder.getAirportCount() << " airports and " << builder.getRunwayCount()
+              << " runways (" << paths[0] << ") in " << elapsed << " s" << std::endl;
+    return 0;
+}
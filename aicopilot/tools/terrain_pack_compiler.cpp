@@ -0,0 +1,193 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Compiles CSV, SRTM (.hgt) and GDAL raster terrain into a terrain pack
+* that TerrainAwareness::loadTerrainDatabase maps without parsing.
+*
+* Usage: terrain_pack_compiler [--samples N] [--raw] [--raster-feet] <output> <input>...
+*   --samples N     grid samples per 1° tile edge (default 121, 30 arc-seconds)
+*   --raw           store tiles uncompressed (no decode on first lookup)
+*   --raster-feet   GDAL rasters are already in feet instead of meters
+*
+* CSV rows are lat,lon,elevation_ft; .hgt tiles are SRTM meters; .tif/.tiff
+* need a build with ENABLE_GDAL.
+*****************************************************************************/
+
+#include "srtm_loader.hpp"
+#include "terrain_pack.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#ifdef ENABLE_GDAL
+#include "gdal_priv.h"
+#endif
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr double METERS_TO_FEET = 3.28084;
+
+std::string extensionOf(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    std::string ext = (dot == std::string::npos) ? std::string() : path.substr(dot + 1);
+    for (auto& c : ext) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return ext;
+}
+
+// Same row format as TerrainAwareness: comma or whitespace separated, no header
+bool addCsv(TerrainPackBuilder& builder, const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Could not open " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        const char* cursor = line.c_str();
+        double values[3];
+        int parsed = 0;
+        while (parsed < 3) {
+            while (*cursor == ',' || std::isspace(static_cast<unsigned char>(*cursor))) cursor++;
+            char* end = nullptr;
+            values[parsed] = std::strtod(cursor, &end);
+            if (end == cursor) break;
+            cursor = end;
+            parsed++;
+        }
+        if (parsed == 3) {
+            builder.addPoint(values[0], values[1], values[2]);
+        }
+    }
+    return true;
+}
+
+bool addHgt(TerrainPackBuilder& builder, const std::string& path) {
+    int tileLat = 0, tileLon = 0;
+    SRTMTile tile;
+    if (!SRTMTile::ParseFileName(path, tileLat, tileLon) || !tile.LoadFromFile(path)) {
+        std::cerr << "Could not read SRTM tile " << path << std::endl;
+        return false;
+    }
+
+    const int last = tile.GetSamplesPerSide() - 1;
+    // The north row and east column sit on the neighbouring tiles' edges; keep them in this tile
+    const double inset = 1e-9;
+    for (int row = 0; row <= last; ++row) {
+        double lat = tileLat + 1.0 - static_cast<double>(row) / last - (row == 0 ? inset : 0.0);
+        for (int col = 0; col <= last; ++col) {
+            int16_t meters = tile.GetRawElevation(row, col);
+            if (meters == SRTMTile::VOID_VALUE) continue;
+            double lon = tileLon + static_cast<double>(col) / last - (col == last ? inset : 0.0);
+            builder.addPoint(lat, lon, meters * METERS_TO_FEET);
+        }
+    }
+    return true;
+}
+
+#ifdef ENABLE_GDAL
+bool addRaster(TerrainPackBuilder& builder, const std::string& path, double toFeet) {
+    GDALAllRegister();
+    GDALDataset* dataset = static_cast<GDALDataset*>(GDALOpen(path.c_str(), GA_ReadOnly));
+    if (dataset == nullptr) {
+        std::cerr << "GDAL could not open " << path << std::endl;
+        return false;
+    }
+
+    double gt[6];
+    GDALRasterBand* band = dataset->GetRasterBand(1);
+    if (band == nullptr || dataset->GetGeoTransform(gt) != CE_None) {
+        std::cerr << "Raster " << path << " has no elevation band or geotransform" << std::endl;
+        GDALClose(dataset);
+        return false;
+    }
+
+    int hasNoData = 0;
+    double noData = band->GetNoDataValue(&hasNoData);
+    const int cols = dataset->GetRasterXSize();
+    const int rows = dataset->GetRasterYSize();
+
+    // One scanline at a time; geographic rasters only, as in TerrainAwareness
+    std::vector<double> scanline(cols);
+    bool ok = true;
+    for (int row = 0; row < rows && ok; ++row) {
+        if (band->RasterIO(GF_Read, 0, row, cols, 1, scanline.data(), cols, 1, GDT_Float64, 0, 0) != CE_None) {
+            std::cerr << "Failed to read row " << row << " of " << path << std::endl;
+            ok = false;
+            break;
+        }
+        for (int col = 0; col < cols; ++col) {
+            if (hasNoData && scanline[col] == noData) continue;
+            double lon = gt[0] + (col + 0.5) * gt[1] + (row + 0.5) * gt[2];
+            double lat = gt[3] + (col + 0.5) * gt[4] + (row + 0.5) * gt[5];
+            builder.addPoint(lat, lon, scanline[col] * toFeet);
+        }
+    }
+
+    GDALClose(dataset);
+    return ok;
+}
+#endif
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int samples = TerrainPackBuilder::DEFAULT_SAMPLES_PER_EDGE;
+    TerrainPackEncoding encoding = TerrainPackEncoding::DELTA;
+    double rasterToFeet = METERS_TO_FEET;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            samples = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--raw") == 0) {
+            encoding = TerrainPackEncoding::RAW;
+        } else if (std::strcmp(argv[i], "--raster-feet") == 0) {
+            rasterToFeet = 1.0;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.size() < 2 || samples < 2) {
+        std::cerr << "Usage: terrain_pack_compiler [--samples N] [--raw] [--raster-feet] <output> <input>..." << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    TerrainPackBuilder builder(samples);
+    for (size_t i = 1; i < paths.size(); ++i) {
+        const std::string& input = paths[i];
+        std::string ext = extensionOf(input);
+        bool ok = false;
+        if (ext == "hgt") {
+            ok = addHgt(builder, input);
+        } else if (ext == "tif" || ext == "tiff") {
+#ifdef ENABLE_GDAL
+            ok = addRaster(builder, input, rasterToFeet);
+#else
+            (void)rasterToFeet;
+            std::cerr << "Raster input " << input << " needs a build with ENABLE_GDAL" << std::endl;
+#endif
+        } else {
+            ok = addCsv(builder, input);
+        }
+        if (!ok) {
+            return 2;
+        }
+    }
+
+    if (!builder.write(paths[0], encoding)) {
+        return 3;
+    }
+
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Compiled " << builder.getPointCount() << " samples into " << builder.getTileCount()
+              << " tiles (" << paths[0] << ") in " << elapsed << " s" << std::endl;
+    return 0;
+}
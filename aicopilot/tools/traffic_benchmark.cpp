@@ -0,0 +1,413 @@
+/*****************************************************************************
+* Copyright 2025 AI Copilot FS Project
+*
+* Times the traffic and collision subsystems on synthetic scenes from 10 to
+* 5,000 targets at terminal and en-route densities, and reports throughput
+* and latency percentiles per subsystem, as text or JSON.
+*
+* Usage: traffic_benchmark [--iterations N] [--max-targets N] [--scene file] [--json [file]]
+*   --scene     Run one terminal scene from a traffic CSV (dataset_generator)
+*               instead of the synthetic ones
+*****************************************************************************/
+
+#include "airport_collision_index.hpp"
+#include "collision_avoidance.hpp"
+#include "traffic_system.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace AICopilot;
+
+namespace {
+
+constexpr double BENCH_PI = 3.14159265358979323846;
+constexpr double FEET_PER_NM = 6076.12;
+constexpr double FPS_PER_KNOT = 1.6878098571011957;
+constexpr double OWN_LAT = 47.45;
+constexpr double OWN_LON = -122.31;
+
+const size_t SCENE_SIZES[] = {10, 50, 100, 500, 1000, 2000, 5000};
+
+// One synthetic aircraft in a local frame around the airport / own ship
+struct Target {
+    double north, east;       // nm
+    double altitude;          // feet
+    double groundSpeed;       // knots
+    double heading;           // degrees true
+    double verticalSpeed;     // feet per minute
+};
+
+struct Scene {
+    std::string name;
+    bool terminal = false;    // centred on an airport, own ship in the pattern
+    std::vector<Target> targets;
+};
+
+// Terminal: a third taxiing within 2 nm of the field, the rest in the
+// 12 nm terminal area below 10,000 ft. En route: 150 nm, cruise levels.
+Scene makeScene(bool terminal, size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    Scene scene;
+    scene.name = terminal ? "terminal" : "enroute";
+    scene.terminal = terminal;
+    scene.targets.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        Target t{};
+        bool ground = terminal && i % 3 == 0;
+        double radius = (ground ? 2.0 : terminal ? 12.0 : 150.0) * std::sqrt(unit(rng));
+        double angle = unit(rng) * 2.0 * BENCH_PI;
+        t.north = radius * std::cos(angle);
+        t.east = radius * std::sin(angle);
+        t.heading = unit(rng) * 360.0;
+        if (ground) {
+            t.altitude = 0.0;
+            t.groundSpeed = unit(rng) * 25.0;
+        } else if (terminal) {
+            t.altitude = 1000.0 + unit(rng) * 9000.0;
+            t.groundSpeed = 140.0 + unit(rng) * 110.0;
+            t.verticalSpeed = (unit(rng) - 0.5) * 3000.0;
+        } else {
+            t.altitude = 1000.0 * std::floor(20.0 + unit(rng) * 21.0);
+            t.groundSpeed = 380.0 + unit(rng) * 120.0;
+            t.verticalSpeed = unit(rng) < 0.1 ? (unit(rng) - 0.5) * 4000.0 : 0.0;
+        }
+        scene.targets.push_back(t);
+    }
+    return scene;
+}
+
+// Traffic CSV as written by dataset_generator:
+//   callsign,latitude,longitude,altitude_ft,ground_speed_kt,heading_deg,vertical_speed_fpm,on_ground
+// Positions are taken relative to the scene's centroid.
+bool loadScene(const std::string& path, Scene& scene) {
+    std::ifstream in(path);
+    if (!in) return false;
+    struct Row { double lat, lon; Target target; };
+    std::vector<Row> rows;
+    double sumLat = 0.0, sumLon = 0.0;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        Row row{};
+        char callsign[16];
+        int onGround = 0;
+        if (std::sscanf(line.c_str(), "%15[^,],%lf,%lf,%lf,%lf,%lf,%lf,%d", callsign, &row.lat, &row.lon,
+                        &row.target.altitude, &row.target.groundSpeed, &row.target.heading,
+                        &row.target.verticalSpeed, &onGround) < 7) {
+            continue;
+        }
+        if (onGround) row.target.altitude = 0.0;
+        sumLat += row.lat;
+        sumLon += row.lon;
+        rows.push_back(row);
+    }
+    if (rows.empty()) return false;
+
+    double centerLat = sumLat / rows.size(), centerLon = sumLon / rows.size();
+    scene.name = "scene";
+    scene.terminal = true;
+    scene.targets.clear();
+    for (Row& row : rows) {
+        row.target.north = (row.lat - centerLat) * 60.0;
+        row.target.east = (row.lon - centerLon) * 60.0 * std::cos(centerLat * BENCH_PI / 180.0);
+        scene.targets.push_back(row.target);
+    }
+    return true;
+}
+
+// Dead-reckon every target one step so repeated runs see moving traffic
+void advance(Scene& scene, double seconds) {
+    for (auto& t : scene.targets) {
+        double h = t.heading * BENCH_PI / 180.0;
+        t.north += t.groundSpeed * std::cos(h) * seconds / 3600.0;
+        t.east += t.groundSpeed * std::sin(h) * seconds / 3600.0;
+        t.altitude += t.verticalSpeed * seconds / 60.0;
+    }
+}
+
+Collision::SeparationStandards::AircraftState toState(const Target& t, int id) {
+    double h = t.heading * BENCH_PI / 180.0;
+    double speed = t.groundSpeed * FPS_PER_KNOT;
+    Collision::SeparationStandards::AircraftState state;
+    state.aircraft_id = id;
+    state.position_local = Collision::Vector2D(t.east * FEET_PER_NM, t.north * FEET_PER_NM);
+    state.velocity = Collision::Vector2D(speed * std::sin(h), speed * std::cos(h));
+    state.altitude_feet = t.altitude;
+    state.heading_true = t.heading;
+    state.groundspeed_knots = t.groundSpeed;
+    return state;
+}
+
+// Aircraft outline: a 150 x 120 ft box along the heading
+Collision::Polygon footprint(const Target& t) {
+    double h = t.heading * BENCH_PI / 180.0;
+    Collision::Vector2D center(t.east * FEET_PER_NM, t.north * FEET_PER_NM);
+    Collision::Vector2D along(std::sin(h) * 75.0, std::cos(h) * 75.0);
+    Collision::Vector2D across(std::cos(h) * 60.0, -std::sin(h) * 60.0);
+    Collision::Polygon polygon;
+    polygon.add_vertex(center - along - across);
+    polygon.add_vertex(center + along - across);
+    polygon.add_vertex(center + along + across);
+    polygon.add_vertex(center - along + across);
+    return polygon;
+}
+
+// Airport structures: L-shaped buildings scattered within 2 nm of the field
+std::vector<Collision::Polygon> makeBuildings(size_t count) {
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<double> pos(-2.0 * FEET_PER_NM, 2.0 * FEET_PER_NM), size(80.0, 400.0);
+    std::vector<Collision::Polygon> buildings;
+    for (size_t i = 0; i < count; ++i) {
+        double x = pos(rng), y = pos(rng), w = size(rng), d = size(rng);
+        Collision::Polygon polygon;
+        polygon.add_vertex(Collision::Vector2D(x, y));
+        polygon.add_vertex(Collision::Vector2D(x + w, y));
+        polygon.add_vertex(Collision::Vector2D(x + w, y + d * 0.4));
+        polygon.add_vertex(Collision::Vector2D(x + w * 0.4, y + d * 0.4));
+        polygon.add_vertex(Collision::Vector2D(x + w * 0.4, y + d));
+        polygon.add_vertex(Collision::Vector2D(x, y + d));
+        buildings.push_back(polygon);
+    }
+    return buildings;
+}
+
+void fillTable(const Scene& scene, TrafficTable& table) {
+    static const char* const CALLSIGN = "SIM";
+    table.beginSweep();
+    for (size_t i = 0; i < scene.targets.size(); ++i) {
+        const Target& t = scene.targets[i];
+        TrafficTable::Sample sample;
+        sample.callsign = CALLSIGN;
+        sample.latitude = OWN_LAT + t.north / 60.0;
+        sample.longitude = OWN_LON + t.east / (60.0 * std::cos(OWN_LAT * BENCH_PI / 180.0));
+        sample.altitude = t.altitude;
+        sample.groundSpeed = t.groundSpeed;
+        sample.heading = t.heading;
+        sample.verticalSpeed = t.verticalSpeed;
+        sample.onGround = t.altitude <= 0.0;
+        table.upsert(static_cast<uint32_t>(i + 1), sample);
+    }
+    table.endSweep();
+}
+
+struct Result {
+    std::string subsystem;
+    std::string scene;
+    size_t targets = 0;
+    size_t iterations = 0;
+    double throughput = 0.0;  // targets processed per second
+    double meanUs = 0.0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+    double checksum = 0.0;    // keeps the work observable
+};
+
+// Time each iteration of work(i), which returns a checksum contribution
+template <typename Work>
+Result measure(const std::string& subsystem, const Scene& scene, size_t iterations, Work work) {
+    std::vector<double> latenciesUs;
+    latenciesUs.reserve(iterations);
+    Result result;
+    result.subsystem = subsystem;
+    result.scene = scene.name;
+    result.targets = scene.targets.size();
+    result.iterations = iterations;
+
+    for (size_t i = 0; i < iterations; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        result.checksum += work(i);
+        auto t1 = std::chrono::steady_clock::now();
+        latenciesUs.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+    }
+
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    double total = 0.0;
+    for (double value : latenciesUs) total += value;
+    auto percentile = [&latenciesUs](double p) {
+        return latenciesUs[static_cast<size_t>(p * (latenciesUs.size() - 1))];
+    };
+    result.meanUs = total / latenciesUs.size();
+    result.p50Us = percentile(0.50);
+    result.p99Us = percentile(0.99);
+    result.maxUs = latenciesUs.back();
+    result.throughput = total > 0.0 ? result.targets * iterations / (total * 1e-6) : 0.0;
+    return result;
+}
+
+void runScene(Scene scene, size_t iterations, const Collision::AirportCollisionIndex& index,
+              const std::vector<Collision::Polygon>& buildings, std::vector<Result>& results) {
+    const size_t count = scene.targets.size();
+    std::vector<Collision::SeparationStandards::AircraftState> states(count);
+    auto refreshStates = [&] {
+        for (size_t k = 0; k < count; ++k) states[k] = toState(scene.targets[k], static_cast<int>(k));
+    };
+
+    // Full pairwise prediction, rebuilt from scratch each time
+    refreshStates();
+    Collision::ConflictPredictor stateless(30.0);
+    for (const auto& state : states) stateless.update_aircraft_state(state);
+    results.push_back(measure("conflict_predictor.predict_conflicts", scene, iterations, [&](size_t) {
+        return static_cast<double>(stateless.predict_conflicts().size());
+    }));
+
+    // Incremental prediction over moving traffic, one second per update
+    Collision::ConflictPredictor incremental(30.0);
+    for (const auto& state : states) incremental.update_aircraft_state(state);
+    incremental.update_conflicts(1.0);
+    results.push_back(measure("conflict_predictor.update_conflicts", scene, iterations, [&](size_t) {
+        advance(scene, 1.0);
+        refreshStates();
+        for (const auto& state : states) incremental.update_aircraft_state(state);
+        return static_cast<double>(incremental.update_conflicts(1.0).size());
+    }));
+
+    // TCAS over a live traffic table around own ship
+    AircraftState own{};
+    own.position.latitude = OWN_LAT;
+    own.position.longitude = OWN_LON;
+    own.position.altitude = scene.terminal ? 3000.0 : 35000.0;
+    own.groundSpeed = scene.terminal ? 180.0 : 450.0;
+    own.heading = 90.0;
+    TrafficSystem traffic;
+    traffic.updateOwnAircraft(own);
+    TrafficTable table;
+    table.reserve(count);
+    fillTable(scene, table);
+    results.push_back(measure("traffic_system.update_targets", scene, iterations, [&](size_t) {
+        traffic.updateTrafficTargets(table);
+        return static_cast<double>(traffic.getActiveAdvisories().size());
+    }));
+    results.push_back(measure("traffic_system.check_conflicts", scene, iterations, [&](size_t) {
+        return static_cast<double>(traffic.checkTrafficConflicts().size());
+    }));
+
+    // Footprints against airport structures: SAT per building vs the index
+    if (!scene.terminal) return;
+    std::vector<Collision::Polygon> footprints;
+    footprints.reserve(count);
+    for (const auto& t : scene.targets) footprints.push_back(footprint(t));
+    results.push_back(measure("collision_detector.polygon_polygon", scene, iterations, [&](size_t) {
+        double hits = 0.0;
+        for (const auto& fp : footprints) {
+            for (const auto& building : buildings) {
+                if (Collision::CollisionDetector::check_polygon_polygon_collision(fp, building)) {
+                    hits += 1.0;
+                    break;
+                }
+            }
+        }
+        return hits;
+    }));
+    results.push_back(measure("airport_collision_index.intersects_polygon", scene, iterations, [&](size_t) {
+        double hits = 0.0;
+        for (const auto& fp : footprints) hits += index.intersects_polygon(fp) ? 1.0 : 0.0;
+        return hits;
+    }));
+}
+
+void writeJson(std::ostream& out, const std::vector<Result>& results, size_t iterations) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\n  \"benchmark\": \"traffic_benchmark\",\n  \"iterations\": " << iterations
+        << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"subsystem\": \"" << r.subsystem << "\", \"scene\": \"" << r.scene
+            << "\", \"targets\": " << r.targets << ", \"iterations\": " << r.iterations
+            << ", \"throughput_targets_per_sec\": " << r.throughput
+            << ", \"mean_us\": " << r.meanUs << ", \"p50_us\": " << r.p50Us
+            << ", \"p99_us\": " << r.p99Us << ", \"max_us\": " << r.maxUs
+            << ", \"checksum\": " << r.checksum << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+void writeText(std::ostream& out, const std::vector<Result>& results) {
+    out << std::left << std::setw(46) << "subsystem" << std::setw(10) << "scene" << std::right
+        << std::setw(8) << "targets" << std::setw(16) << "targets/s" << std::setw(12) << "p50 us"
+        << std::setw(12) << "p99 us" << std::endl;
+    for (const Result& r : results) {
+        out << std::left << std::setw(46) << r.subsystem << std::setw(10) << r.scene << std::right
+            << std::setw(8) << r.targets << std::fixed << std::setprecision(0) << std::setw(16) << r.throughput
+            << std::setprecision(1) << std::setw(12) << r.p50Us << std::setw(12) << r.p99Us << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t iterations = 50;
+    size_t maxTargets = 5000;
+    bool json = false;
+    const char* jsonPath = nullptr;
+    const char* scenePath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+            scenePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = static_cast<size_t>(std::atol(argv[++i]));
+        } else if (std::strcmp(argv[i], "--max-targets") == 0 && i + 1 < argc) {
+            maxTargets = static_cast<size_t>(std::atol(argv[++i]));
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') jsonPath = argv[++i];
+        } else {
+            iterations = 0;
+            break;
+        }
+    }
+    if (iterations == 0) {
+        std::cerr << "Usage: traffic_benchmark [--iterations N] [--max-targets N] [--scene file] [--json [file]]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::vector<Collision::Polygon> buildings = makeBuildings(400);
+    Collision::AirportCollisionIndex index;
+    index.build(buildings);
+
+    std::vector<Result> results;
+    if (scenePath) {
+        Scene scene;
+        if (!loadScene(scenePath, scene)) {
+            std::cerr << "No traffic in " << scenePath << std::endl;
+            return 2;
+        }
+        runScene(std::move(scene), iterations, index, buildings, results);
+    } else {
+        for (bool terminal : {true, false}) {
+            for (size_t count : SCENE_SIZES) {
+                if (count > maxTargets) break;
+                runScene(makeScene(terminal, count, static_cast<unsigned>(count)), iterations, index, buildings, results);
+            }
+        }
+    }
+
+    if (!json) {
+        writeText(std::cout, results);
+        return 0;
+    }
+    if (jsonPath) {
+        std::ofstream file(jsonPath);
+        if (!file) {
+            std::cerr << "Cannot write " << jsonPath << std::endl;
+            return 2;
+        }
+        writeJson(file, results, iterations);
+    } else {
+        writeJson(std::cout, results, iterations);
+    }
+    return 0;
+}